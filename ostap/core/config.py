@@ -46,6 +46,7 @@ config [ 'General'  ] = {
     'Quiet'     : str ( _config.quiet   ) ,
     'Verbose'   : str ( _config.verbose ) ,
     'Parallel'  : 'PATHOS'                ,
+    'Lazy'      : 'False'                 ,
     }
 
 config [ 'Canvas'   ] = { 'Width'       :  '1000' , 'Height'       :  '800' , 
@@ -55,6 +56,11 @@ config [ 'Canvas'   ] = { 'Width'       :  '1000' , 'Height'       :  '800' ,
 config [ 'Fit Draw' ] = {}
 config [ 'Parallel' ] = {}
 
+## NUMA-aware placement for in-process parallel C++ engines:
+#  Affinity : None/Compact/Scatter 
+#  PreMerge : merge the partial results per NUMA node 
+config [ 'Threads'  ] = { 'Affinity' : 'None' , 'PreMerge' : 'True' }
+
 ## the list of processes config files 
 files_read = config.read (
     _config.config_files + 
@@ -75,6 +81,10 @@ canvas  = config [ 'Canvas'    ]
 ## section for fit drawing options 
 fit_draw = config [ 'Fit Draw' ]
 
+# =============================================================================
+## section for the in-process parallel C++ engines 
+threads  = config [ 'Threads'  ]
+
 # =============================================================================
 # logging 
 # =============================================================================
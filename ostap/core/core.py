@@ -749,6 +749,28 @@ def _rtc_iadd_ ( self , item ) :
 
 ROOT.TCollection. __iadd__ = _rtc_iadd_ 
     
+# =============================================================================
+## NUMA-aware placement of threads for the parallel C++ engines
+#  @see ostap/core/config.py
+#  @see Ostap::Utils::Affinity 
+def _setup_affinity_ () :
+    """Configure NUMA-aware placement of threads for the parallel C++ engines
+    - see section [Threads] in ostap/core/config.py 
+    - see Ostap::Utils::Affinity 
+    """
+    import ostap.core.config as _CONFIG
+    _policies = { 'none' : 0 , 'compact' : 1 , 'scatter' : 2 }
+    _policy   = _CONFIG.threads.get ( 'Affinity' , fallback = 'None' ).strip().lower()
+    if not _policy in _policies :
+        logger.warning ( "Invalid thread affinity policy `%s', ignore" % _policy )
+        _policy = 'none'
+    Ostap.Utils.Affinity.setPolicy   ( _policies [ _policy ] ) 
+    Ostap.Utils.Affinity.setPremerge ( _CONFIG.threads.getboolean ( 'PreMerge' , fallback = True ) )
+    if _policies [ _policy ] :
+        logger.debug ( "Thread affinity `%s' for %d NUMA nodes" % ( _policy , Ostap.Utils.Affinity.nNodes () ) )
+        
+_setup_affinity_ () 
+
 # =============================================================================
 _decorated_classes_ = (
     ROOT.TObject        ,
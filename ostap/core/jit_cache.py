@@ -0,0 +1,242 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/core/jit_cache.py
+#  Persistent content-addressed on-disk cache of compiled C++ code
+#  - the code is compiled (ACLiC) into the shared library once,
+#    the key is the hash of the code, ROOT & Ostap versions and the
+#    compiler flags
+#  - for the subsequent runs/jobs the library is loaded directly,
+#    no compilation is needed
+#  - the cache can be shared by several processes on the node:
+#    the compilation is protected by the file lock
+#  The cache directory:
+#  - the environment variable <code>OSTAP_JIT_CACHE</code>
+#  - the configuration file, section [General], field <code>JIT_CACHE</code>
+#  - <code>$OSTAP_DIR/cache/jit</code>
+#  @code
+#  jit_compile  ( 'double my_fun ( double x ) { return x * x ; }' )
+#  print ( ROOT.my_fun ( 2.0 ) )
+#  fname = jit_function ( 'pt>2 && abs(eta)<2' , [ ( 'double' , 'pt' ) , ( 'double' , 'eta' ) ] , 'bool' )
+#  @endcode
+#  @see TSystem::CompileMacro
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Persistent content-addressed on-disk cache of compiled C++ code
+- the code is compiled (ACLiC) into the shared library once,
+  the key is the hash of the code, ROOT & Ostap versions and the
+  compiler flags
+- for the subsequent runs/jobs the library is loaded directly,
+  no compilation is needed
+- the cache can be shared by several processes on the node:
+  the compilation is protected by the file lock
+
+The cache directory:
+- the environment variable `OSTAP_JIT_CACHE`
+- the configuration file, section [General], field `JIT_CACHE`
+- `$OSTAP_DIR/cache/jit`
+
+>>> jit_compile  ( 'double my_fun ( double x ) { return x * x ; }' )
+>>> print ( ROOT.my_fun ( 2.0 ) )
+>>> fname = jit_function ( 'pt>2 && abs(eta)<2' , [ ( 'double' , 'pt' ) , ( 'double' , 'eta' ) ] , 'bool' )
+- see TSystem::CompileMacro
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'jit_cache_dir' , ## the directory for the compiled libraries
+    'jit_key'       , ## the content-addressed key for the code
+    'jit_compile'   , ## compile (or load from the cache) the C++ code
+    'jit_function'  , ## compile (or load from the cache) the function for the expression
+    )
+# =============================================================================
+import ROOT, os, sys, hashlib
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.core.jit_cache' )
+else                       : logger = getLogger ( __name__               )
+# =============================================================================
+## version of the layout of the cache
+_format_version = 1
+## the namespace for the generated functions
+_namespace      = 'ostap_jit'
+## the libraries, loaded in this process: { key : library }
+_loaded         = {}
+## the cache directory
+_cache_dir      = None
+# =============================================================================
+## get the cache directory for the compiled libraries
+#  - the environment variable <code>OSTAP_JIT_CACHE</code>
+#  - the configuration file, section [General], field <code>JIT_CACHE</code>
+#  - <code>$OSTAP_DIR/cache/jit</code>
+def jit_cache_dir () :
+    """Get the cache directory for the compiled libraries
+    - the environment variable `OSTAP_JIT_CACHE`
+    - the configuration file, section [General], field `JIT_CACHE`
+    - `$OSTAP_DIR/cache/jit`
+    """
+    global _cache_dir
+    if _cache_dir : return _cache_dir
+
+    cdir = os.environ.get ( 'OSTAP_JIT_CACHE' , '' )
+    if not cdir :
+        import ostap.core.config as OCC
+        cdir = OCC.general.get ( 'JIT_CACHE' , '' )
+    if not cdir :
+        from ostap.core.workdir import workdir
+        cdir = os.path.join ( workdir , 'cache' , 'jit' )
+
+    cdir = os.path.expandvars ( os.path.expanduser ( cdir ) )
+    try :
+        if not os.path.exists ( cdir ) : os.makedirs ( cdir )
+    except OSError :
+        pass
+    if not os.path.isdir ( cdir ) or not os.access ( cdir , os.W_OK ) :
+        from ostap.utils.cleanup import CleanUp
+        logger.warning ( 'jit_cache_dir: directory %s is not writeable, use temporary one' % cdir )
+        cdir = CleanUp.tempdir ( prefix = 'ostap-jit-' )
+
+    _cache_dir = cdir
+    return _cache_dir
+
+# =============================================================================
+## get the content-addressed key for the code:
+#  the hash of the code, ROOT & Ostap versions, the compiler and flags
+def jit_key ( code , *extra ) :
+    """Get the content-addressed key for the code:
+    the hash of the code, ROOT & Ostap versions, the compiler and flags
+    """
+    from ostap.core.meta_info import ostap_version
+    items = ( _format_version              ,
+              code                         ,
+              ROOT.gROOT.GetVersion     () ,
+              ROOT.gSystem.GetFlagsOpt  () ,
+              ROOT.gSystem.GetIncludePath () ,
+              ostap_version                ,
+              sys.platform                 ) + extra
+    return hashlib.sha1 ( repr ( items ).encode ( 'utf-8' ) ).hexdigest ()
+
+# =============================================================================
+## the file lock for the key (no-op if <code>fcntl</code> is not available)
+class _Lock ( object ) :
+    """The file lock for the key (no-op if `fcntl` is not available)
+    """
+    def __init__  ( self , fname ) :
+        self.__fname = fname
+        self.__file  = None
+    def __enter__ ( self ) :
+        try :
+            import fcntl
+            self.__file = open ( self.__fname , 'a' )
+            fcntl.flock ( self.__file , fcntl.LOCK_EX )
+        except ( ImportError , IOError , OSError ) :
+            self.__file = None
+        return self
+    def __exit__  ( self , *_ ) :
+        if self.__file :
+            import fcntl
+            fcntl.flock ( self.__file , fcntl.LOCK_UN )
+            self.__file.close ()
+            self.__file = None
+
+# =============================================================================
+## compile (or load from the cache) the C++ code
+#  - the key is the hash of the code, ROOT & Ostap versions and the compiler flags
+#  - if the library for the key exists, it is loaded directly
+#  - otherwise the code is compiled (ACLiC) under the file lock,
+#    so the concurrent jobs on the node compile it only once
+#  @code
+#  jit_compile  ( 'double my_fun ( double x ) { return x * x ; }' )
+#  print ( ROOT.my_fun ( 2.0 ) )
+#  @endcode
+#  @param code  the C++ code
+#  @param extra additional items for the key
+#  @return the path to the loaded library (or <code>None</code> in case of failure)
+def jit_compile ( code , *extra ) :
+    """Compile (or load from the cache) the C++ code
+    - the key is the hash of the code, ROOT & Ostap versions and the compiler flags
+    - if the library for the key exists, it is loaded directly
+    - otherwise the code is compiled (ACLiC) under the file lock,
+      so the concurrent jobs on the node compile it only once
+    >>> jit_compile  ( 'double my_fun ( double x ) { return x * x ; }' )
+    >>> print ( ROOT.my_fun ( 2.0 ) )
+    """
+    key = jit_key ( code , *extra )
+    if key in _loaded : return _loaded [ key ]
+
+    kdir    = os.path.join ( jit_cache_dir () , key [ : 2 ] )
+    if not os.path.exists ( kdir ) :
+        try                        : os.makedirs ( kdir )
+        except OSError             : pass
+
+    base    = 'jit_%s' % key
+    source  = os.path.join ( kdir , base + '.C' )
+    library = os.path.join ( kdir , '%s_C.%s' % ( base , ROOT.gSystem.GetSoExt () ) )
+    done    = os.path.join ( kdir , base + '.done' )
+
+    with _Lock ( os.path.join ( kdir , base + '.lock' ) ) :
+
+        ## 1) already compiled (by this or other job): load it
+        if os.path.exists ( done ) and os.path.exists ( library ) :
+            if 0 <= ROOT.gSystem.Load ( library ) :
+                logger.debug ( 'jit_compile: library is loaded from the cache %s' % library )
+                _loaded [ key ] = library
+                return library
+            logger.warning ( "jit_compile: can't load the cached library %s, recompile" % library )
+            try                        : os.remove ( done )
+            except OSError             : pass
+
+        ## 2) compile it
+        with open ( source , 'w' ) as f : f.write ( code )
+        if not ROOT.gSystem.CompileMacro ( source , 'kO' , library , kdir ) :
+            logger.error ( "jit_compile: can't compile the code:\n%s" % code )
+            return None
+        with open ( done , 'w' ) as f : f.write ( key )
+
+    logger.debug ( 'jit_compile: code is compiled into %s' % library )
+    _loaded [ key ] = library
+    return library
+
+# =============================================================================
+## compile (or load from the cache) the function for the expression
+#  @code
+#  fname = jit_function ( 'pt>2 && abs(eta)<2' , [ ( 'double' , 'pt' ) , ( 'double' , 'eta' ) ] , 'bool' )
+#  print ( getattr ( ROOT.ostap_jit , fname.split('::')[-1] ) ( 3.0 , 1.0 ) )
+#  @endcode
+#  @param expression the C++ expression
+#  @param arguments  list of the arguments, (type,name) pairs
+#  @param rtype      the return type
+#  @param includes   the additional headers
+#  @return the fully qualified function name (or <code>None</code> in case of failure)
+def jit_function ( expression , arguments , rtype = 'double' , includes = () ) :
+    """Compile (or load from the cache) the function for the expression
+    >>> fname = jit_function ( 'pt>2 && abs(eta)<2' , [ ( 'double' , 'pt' ) , ( 'double' , 'eta' ) ] , 'bool' )
+    """
+    args  = tuple ( ( str ( t ) , str ( n ) ) for t , n in arguments )
+    fname = 'f_%s' % jit_key ( expression , args , rtype , tuple ( includes ) ) [ : 16 ]
+
+    lines  = [ '#include <cmath>' , '#include "ROOT/RVec.hxx"' ]
+    lines += [ '#include "%s"' % i for i in includes ]
+    lines += [ 'namespace %s' % _namespace ,
+               '{' ,
+               '  %s %s ( %s )' % ( rtype , fname , ' , '.join ( 'const %s& %s' % a for a in args ) ) ,
+               '  {' ,
+               '    using namespace ROOT::VecOps ;' ,
+               '    return ( %s ) ;' % expression ,
+               '  }' ,
+               '}' , '' ]
+
+    if not jit_compile ( '\n'.join ( lines ) ) : return None
+    return '%s::%s' % ( _namespace , fname )
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+    logger.info ( 'JIT cache directory is %s' % jit_cache_dir () )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -0,0 +1,244 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/core/lazy.py
+#  Lazy (deferred) loading of Ostap decorations and timing of the startup
+#
+#  In the lazy mode the heavy decoration modules (e.g. RooFit&Minuit,
+#  histogram parameterisations and comparison) are not imported at startup.
+#  Each group of modules is loaded on the first use:
+#  - on the first access to <code>ROOT.XXX</code> with the registered prefix,
+#    e.g. <code>ROOT.RooRealVar</code> loads the fitting decorations
+#  - on the first access to the unknown attribute of the registered class,
+#    e.g. <code>histo.bernstein</code> loads the histogram decorations
+#  - explicitly via <code>load</code> function
+#
+#  The lazy mode is activated by <code>$OSTAP_LAZY</code> environment variable
+#  or by <code>Lazy</code> key in <code>[General]</code> section of the configuration
+#
+#  @code
+#  from ostap.core.lazy import load, timings
+#  load ( 'fitting' )   ## load the fitting group
+#  load ()              ## load all deferred groups
+#  @endcode
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2023-01-30
+# =============================================================================
+"""Lazy (deferred) loading of Ostap decorations and timing of the startup
+
+In the lazy mode the heavy decoration modules (e.g. RooFit&Minuit,
+histogram parameterisations and comparison) are not imported at startup.
+Each group of modules is loaded on the first use:
+- on the first access to `ROOT.XXX` with the registered prefix,
+  e.g. `ROOT.RooRealVar` loads the fitting decorations
+- on the first access to the unknown attribute of the registered class,
+  e.g. `histo.bernstein` loads the histogram decorations
+- explicitly via `load` function
+
+The lazy mode is activated by `$OSTAP_LAZY` environment variable
+or by `Lazy` key in `[General]` section of the configuration
+
+>>> from ostap.core.lazy import load, timings
+>>> load ( 'fitting' )   ## load the fitting group
+>>> load ()              ## load all deferred groups
+"""
+# =============================================================================
+__version__ = "$Revision$"
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2023-01-30"
+__all__     = (
+    'lazy_mode' , ## is the lazy mode activated?
+    'defer'     , ## register the group of deferred modules
+    'load'      , ## load the deferred group(s)
+    'groups'    , ## get the deferred groups
+    'timing'    , ## context manager to time&record the startup stage
+    'timings'   , ## get the recorded startup timings
+    )
+# =============================================================================
+import os, sys
+from   timeit              import default_timer as _timer
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.core.lazy' )
+else                       : logger = getLogger ( __name__          )
+# =============================================================================
+## recorded startup stages: ( name , time )
+_timings = []
+## registered deferred groups : name -> group
+_groups  = {}
+# =============================================================================
+## is the lazy mode activated?
+def lazy_mode () :
+    """Is the lazy mode activated?
+    - `$OSTAP_LAZY` environment variable
+    - `Lazy` key in `[General]` section of the configuration
+    """
+    env = os.environ.get ( 'OSTAP_LAZY' , '' ).strip().lower()
+    if env : return not env in ( '0' , 'no' , 'false' , 'off' )
+    import ostap.core.config as _CONFIG
+    return _CONFIG.general.getboolean ( 'Lazy' , fallback = False )
+
+# =============================================================================
+## @class timing
+#  Context manager to time and record the startup stage
+#  @code
+#  with timing ( 'ostap.fitting' ) :
+#  ...   import ostap.fitting.roofit
+#  @endcode
+#  @see timings
+class timing(object) :
+    """Context manager to time and record the startup stage
+    >>> with timing ( 'ostap.fitting' ) :
+    ...    import ostap.fitting.roofit
+    - see timings
+    """
+    def __init__  ( self , name ) :
+        self.name  = name
+        self.start = 0
+    def __enter__ ( self ) :
+        self.start = _timer ()
+        return self
+    def __exit__  ( self , *_ ) :
+        _timings.append ( ( self.name , _timer () - self.start ) )
+
+# =============================================================================
+## get the recorded startup timings : sequence of ( name , time ) pairs
+def timings () :
+    """Get the recorded startup timings : sequence of ( name , time ) pairs
+    """
+    return tuple ( _timings )
+
+# =============================================================================
+## @class LazyGroup
+#  The group of deferred modules, loaded on the first use
+class LazyGroup(object) :
+    """The group of deferred modules, loaded on the first use
+    """
+    def __init__ ( self , name , modules , prefixes = () , classes = () ) :
+        self.name     = name
+        self.modules  = tuple ( modules  )
+        self.prefixes = tuple ( prefixes )
+        self.classes  = tuple ( classes  )
+        self.loaded   = False
+        self.hooks    = []
+
+    ## load the modules of the group
+    def load ( self ) :
+        """Load the modules of the group"""
+        if self.loaded : return
+        ## set it in advance to avoid the recursion
+        self.loaded = True
+        self.unhook ()
+        import importlib
+        from ostap.logger.utils import ROOTIgnore
+        with timing ( 'lazy:%s' % self.name ) , ROOTIgnore ( 2001 ) :
+            for m in self.modules : importlib.import_module ( m )
+        logger.debug ( "Deferred group '%s' is loaded: %s" % ( self.name , list ( self.modules ) ) )
+
+    ## install the hooks for the classes
+    def hook ( self ) :
+        """Install the hooks for the classes"""
+        for klass in self.classes :
+            old = klass.__dict__.get ( '__getattr__' , None )
+            def _lazy_getattr_ ( obj , attr , _group = self , _old = old ) :
+                if '__' == attr [ :2 ] :
+                    if _old : return _old ( obj , attr )
+                    raise AttributeError ( attr )
+                _group.load ()
+                return getattr ( obj , attr )
+            klass.__getattr__ = _lazy_getattr_
+            self.hooks.append ( ( klass , old ) )
+
+    ## remove the hooks for the classes
+    def unhook ( self ) :
+        """Remove the hooks for the classes"""
+        while self.hooks :
+            klass , old = self.hooks.pop ()
+            if old : klass.__getattr__ = old
+            else   : del klass.__getattr__
+
+    def __repr__ ( self ) :
+        return "LazyGroup('%s',%s,loaded=%s)" % ( self.name , list ( self.modules ) , self.loaded )
+    __str__ = __repr__
+
+# =============================================================================
+## install the hook for the ROOT facade, if not done yet
+#  the first access to `ROOT.XXX` with the registered prefix loads the group
+_facade_hooked = []
+def _hook_facade_ () :
+    """Install the hook for the ROOT facade, if not done yet
+    """
+    if _facade_hooked : return
+    import ROOT, types
+    facade = type ( ROOT )
+    if issubclass ( facade , types.ModuleType ) :
+        logger.debug ( 'ROOT facade is not available, prefix triggers are disabled' )
+        _facade_hooked.append ( None )
+        return
+    old = getattr ( facade , '__getattr__' , None )
+    if old is None :
+        _facade_hooked.append ( None )
+        return
+    def _lazy_root_getattr_ ( self , name , _old = old ) :
+        for group in _groups.values () :
+            if not group.loaded and group.prefixes and name.startswith ( group.prefixes ) :
+                group.load ()
+        return _old ( self , name )
+    facade.__getattr__ = _lazy_root_getattr_
+    _facade_hooked.append ( old )
+
+# =============================================================================
+## register the group of deferred modules
+#  - in non-lazy mode the modules are loaded immediately
+#  @code
+#  defer ( 'fitting' , [ 'ostap.fitting.roofit' ] , prefixes = ( 'Roo', ) )
+#  defer ( 'histos'  , [ 'ostap.histos.param'   ] , classes  = ( ROOT.TH1 , ) )
+#  @endcode
+#  @param name     the name of the group
+#  @param modules  the modules to be loaded
+#  @param prefixes the first access to <code>ROOT.XXX</code> with these prefixes loads the group
+#  @param classes  the first access to unknown attribute of these classes loads the group
+def defer ( name , modules , prefixes = () , classes = () ) :
+    """Register the group of deferred modules
+    - in non-lazy mode the modules are loaded immediately
+    >>> defer ( 'fitting' , [ 'ostap.fitting.roofit' ] , prefixes = ( 'Roo', ) )
+    >>> defer ( 'histos'  , [ 'ostap.histos.param'   ] , classes  = ( ROOT.TH1 , ) )
+    """
+    assert not name in _groups , "defer: group '%s' is already registered" % name
+    group = LazyGroup ( name , modules , prefixes , classes )
+    _groups [ name ] = group
+    if not lazy_mode () : return group.load ()
+    if prefixes : _hook_facade_ ()
+    group.hook  ()
+    logger.debug ( "Deferred group is registered: %s" % group )
+
+# =============================================================================
+## load the deferred group(s)
+#  @code
+#  load ( 'fitting' )   ## load the fitting group
+#  load ()              ## load all deferred groups
+#  @endcode
+def load ( *names ) :
+    """Load the deferred group(s)
+    >>> load ( 'fitting' )   ## load the fitting group
+    >>> load ()              ## load all deferred groups
+    """
+    names = names if names else tuple ( _groups.keys () )
+    for name in names :
+        assert name in _groups , "load: unknown group '%s'" % name
+        _groups [ name ].load ()
+
+# =============================================================================
+## get the registered deferred groups
+def groups () :
+    """Get the registered deferred groups"""
+    return tuple ( _groups.values () )
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -72,13 +72,15 @@ else                      : logger = getLogger ( __name__             )
 # =============================================================================
 # fixes
 # =============================================================================
-import ostap.fixes.fixes
+from ostap.core.lazy    import timing, defer 
+with timing ( 'ostap.fixes' ) : 
+    import ostap.fixes.fixes
 from ostap.logger.utils import ROOTIgnore
 
 # =============================================================================
 logger.info ( 'Zillions of decorations for ROOT/RooFit objects')
 # =============================================================================
-with ROOTIgnore ( 2001 ) : 
+with ROOTIgnore ( 2001 ) , timing ( 'ostap.core' ) : 
     from ostap.core.core import ( cpp      , Ostap     , 
                                   ROOTCWD  , rootID    , 
                                   funcID   , funID     , fID             ,
@@ -100,7 +102,7 @@ with ROOTIgnore ( 2001 ) :
 # =============================================================================
 ## decorate histograms 
 # =============================================================================    
-with ROOTIgnore( 2001 ) : 
+with ROOTIgnore( 2001 ) , timing ( 'ostap.histos' ) : 
     from ostap.histos.histos import ( binomEff_h1 , binomEff_h2 , binomEff_h3 ,
                                       h1_axis     , h2_axes     , h3_axes     ,
                                       axis_bins   , ve_adjust   , histoGuess  )
@@ -110,37 +112,43 @@ with ROOTIgnore( 2001 ) :
 # Other decorations 
 # =============================================================================
 with ROOTIgnore( 2001 ) : 
-    
-    import ostap.trees.trees
-    import ostap.trees.cuts
-    
-    import ostap.histos.param
-    import ostap.histos.compare
-    
-    import ostap.io.root_file
-    
-    import ostap.math.polynomials
-    import ostap.math.models
-    import ostap.utils.hepdata 
-    import ostap.utils.pdg_format 
-    
-    import ostap.plotting.canvas
-    
-    import ostap.fitting.minuit 
-    import ostap.fitting.roofit 
 
-    import ostap.plotting.draw_attributes 
+    with timing ( 'ostap.trees' ) : 
+        import ostap.trees.trees
+        import ostap.trees.cuts
+        
+    with timing ( 'ostap.io' ) : 
+        import ostap.io.root_file
+        
+    with timing ( 'ostap.math' ) : 
+        import ostap.math.polynomials
+        import ostap.math.models
+            
+    with timing ( 'ostap.plotting' ) : 
+        import ostap.plotting.canvas
+        import ostap.plotting.draw_attributes 
     
+# =============================================================================
+## Heavy decorations: deferred in the lazy mode, loaded on the first use
+#  @see ostap.core.lazy 
+# =============================================================================
+defer ( 'histos'  , ( 'ostap.histos.param'   ,
+                      'ostap.histos.compare' ,
+                      'ostap.utils.hepdata'  ) , classes  = ( ROOT.TH1 , ROOT.TGraph ) ) 
+defer ( 'format'  , ( 'ostap.utils.pdg_format' , ) , classes  = ( VE , ) ) 
+defer ( 'fitting' , ( 'ostap.fitting.minuit' ,
+                      'ostap.fitting.roofit' ) , prefixes = ( 'Roo' , 'TMinuit' , 'TVirtualFitter' ) )
+
 # =============================================================================
 ## graphs 
 # =============================================================================
-with ROOTIgnore( 2001 ) :     
+with ROOTIgnore( 2001 ) , timing ( 'ostap.graphs' ) :     
     from ostap.histos.graphs import ( makeGraph , lw_graph  , 
                                       hToGraph  , hToGraph2 , hToGraph3 )
 
     
 
-del ROOTIgnore 
+del ROOTIgnore, timing, defer  
 # =============================================================================
 if '__main__' == __name__ :
             
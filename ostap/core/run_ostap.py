@@ -164,6 +164,13 @@ def parse_args ( args = [] ) :
         help    = "Do not create canvas", 
         default = True          )
     #
+    parser.add_argument ( 
+        '--lazy'                ,
+        dest    = 'Lazy'        , 
+        action  = 'store_true'  , 
+        help    = "Lazy loading: heavy decorations are loaded on the first use [default: %(default)s]", 
+        default = False         )
+    #
     parser.add_argument ( 
         '--no-color'     ,
         dest    = 'Color'      , 
@@ -275,6 +282,8 @@ else:
     del _keys,_vars,_k,level  
 
 # =============================================================================
+if arguments.Lazy : os.environ [ 'OSTAP_LAZY' ] = '1'
+    
 if arguments.Config :
     cc  = os.environ.get ('OSTAP_CONFIG','').split( os.pathsep )
     cc += arguments.Config
@@ -351,6 +360,8 @@ if arguments.Quiet :
 else :
     from ostap.core.load_ostap import *
 
+ostap.core.startup.startup_report ( printer = logger.info if arguments.Verbose else logger.verbose )
+
     
 # =============================================================================
 ## create default canvas
@@ -144,6 +144,35 @@ def write_history ( fname ) :
     if written and os.path.exists( fname ) and os.path.isfile ( fname ) and not _empty_ ( fname ) : 
         logger.info ( 'Ostap  history file: %s' % __history__ )
     
+# =============================================================================
+## print the timing report for the startup stages
+#  @code
+#  import ostap.core.startup as S
+#  S.startup_report ()
+#  @endcode
+#  @see ostap.core.lazy.timings 
+def startup_report ( prefix = '# ' , printer = None ) :
+    """Print the timing report for the startup stages
+    >>> import ostap.core.startup as S
+    >>> S.startup_report ()
+    - see ostap.core.lazy.timings
+    """
+    from ostap.core.lazy   import timings, groups
+    import ostap.logger.table as T
+    rows  = [ ( 'Stage' , 'time [s]' ) ]
+    total = 0.0 
+    for name , t in timings () :
+        rows.append ( ( name , '%.3f' % t ) )
+        if not name.startswith ( 'lazy:' ) : total += t 
+    rows.append ( ( 'Total (eager)'  , '%.3f' % total ) ) 
+    rows.append ( ( 'Session'        , '%.3f' % ( time.time() - start_time_ ) ) )
+    for g in groups () :
+        if not g.loaded : rows.append ( ( 'deferred:%s' % g.name , '-' ) )
+    title = 'Ostap startup'
+    table = T.table ( rows , title = title , prefix = prefix , alignment = 'lr' )
+    if printer is None : printer = logger.info 
+    printer ( '%s:\n%s' % ( title , table ) )
+    
 # =============================================================================
 import atexit
 atexit.register ( _prnt_ )
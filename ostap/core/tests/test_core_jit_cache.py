@@ -0,0 +1,56 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# @file ostap/core/tests/test_core_jit_cache.py
+# Copyright (c) Ostap developpers.
+# =============================================================================
+""" Test module for the persistent cache of compiled C++ code 
+- see ostap.core.jit_cache 
+"""
+# =============================================================================
+import ROOT, os 
+# =============================================================================
+# logging 
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'test_core_jit_cache' )
+else                       : logger = getLogger ( __name__              )
+# =============================================================================
+import ostap.core.jit_cache as J 
+from   ostap.utils.timing   import timing 
+
+# =============================================================================
+## compile the code and load it from the cache 
+def test_jit_cache () :
+    """Compile the code and load it from the cache 
+    """
+    
+    logger.info ( 'JIT cache directory: %s' % J.jit_cache_dir () ) 
+    
+    args  = [ ( 'double' , 'x' ) , ( 'double' , 'y' ) ]
+    with timing ( 'Compile/load' , logger = logger ) : 
+        fname = J.jit_function ( 'x > 1 && std::abs ( y ) < 2' , args , 'bool' )
+    assert fname , 'Function is not compiled!'
+    
+    fun = getattr ( ROOT.ostap_jit , fname.split ( '::' ) [ -1 ] )
+    assert     fun ( 2.0 ,  1.0 ) , 'Invalid function value!'
+    assert not fun ( 0.5 ,  1.0 ) , 'Invalid function value!'
+    assert not fun ( 2.0 , -3.0 ) , 'Invalid function value!'
+
+    ## the same code: no compilation, the key is the same 
+    with timing ( 'Cached'       , logger = logger ) : 
+        fname2 = J.jit_function ( 'x > 1 && std::abs ( y ) < 2' , args , 'bool' )
+    assert fname == fname2 , 'Invalid cached function!'
+
+    ## the library is in the cache 
+    libs = [ l for l in J._loaded.values () ]
+    assert libs and all ( os.path.exists ( l ) for l in libs ) , 'Library is not in the cache!'
+
+# =============================================================================
+if '__main__' == __name__ :
+    
+    test_jit_cache () 
+
+# =============================================================================
+##                                                                      The END 
+# =============================================================================
@@ -0,0 +1,57 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# @file ostap/core/tests/test_core_lazy.py
+# Copyright (c) Ostap developpers.
+# =============================================================================
+""" Test module for the lazy (deferred) loading of decorations
+- see ostap.core.lazy 
+"""
+# =============================================================================
+import os, sys 
+# =============================================================================
+# logging 
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'test_core_lazy'  )
+else                       : logger = getLogger ( __name__          )
+# =============================================================================
+import ostap.core.lazy as L 
+
+## simple class to be decorated 
+class Decorated(object) : pass
+
+# =============================================================================
+## the first access to the unknown attribute loads the deferred group 
+def test_core_lazy () :
+    """The first access to the unknown attribute loads the deferred group
+    """
+
+    lazy = os.environ.get ( 'OSTAP_LAZY' , None )
+    os.environ [ 'OSTAP_LAZY' ] = '1'
+    try : 
+        L.defer ( 'test-lazy' , ( 'colorsys' , ) , classes = ( Decorated , ) )
+    finally :
+        if lazy is None : del os.environ [ 'OSTAP_LAZY' ]
+        else            : os.environ [ 'OSTAP_LAZY' ] = lazy 
+
+    group = [ g for g in L.groups () if 'test-lazy' == g.name ] [ 0 ]
+    assert not group.loaded , 'Group is loaded too early!'
+
+    obj = Decorated ()
+    assert not hasattr ( obj , 'unknown' ) , 'Unexpected attribute!'
+    assert group.loaded                    , 'Group is not loaded!'
+    assert 'colorsys' in sys.modules       , 'Module is not loaded!'
+    assert not '__getattr__' in Decorated.__dict__ , 'Hook is not removed!'
+
+    for name , t in L.timings () :
+        logger.info ( 'Stage %-25s : %.3f[s]' % ( name , t ) ) 
+    
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_core_lazy () 
+
+# =============================================================================
+##                                                                      The END 
+# =============================================================================
@@ -46,6 +46,8 @@ __all__     = (
     'RooCheb_pdf'       , ## wrapper for RooChebyshev
     'RooKeys1D_pdf'     , ## wrapper for RooNDKeysPdf 
     ##
+    'KDE1D_pdf'         , ## binned (FFT-based) kernel density estimator 
+    ##
     'make_bkg'          , ## helper function to create backgrounds 
     )
 # =============================================================================
@@ -2414,6 +2416,112 @@ class RooKeys1D_pdf(PDF) :
     def nsigma    ( self )  :
         """``nsigma'' : ``nsigma'' parameter for RooNDKeysPdf"""
         return self.__nsigma
+
+# =============================================================================
+## @class KDE1D_pdf
+#  Ostap-native binned (FFT-based) kernel density estimator,
+#  the fast replacement for <code>RooNDKeysPdf</code>/RooKeys1D_pdf:
+#  - the data are binned on the fine grid and the grid is convolved
+#    with the gaussian kernel via FFT
+#  - optionally the adaptive bandwidth (Abramson's square-root law) is used
+#  - the density is interpolated between the grid nodes,
+#    the integrals are analytic
+#  The construction time is linear in the number of events,
+#  the evaluation time does not depend on it.
+#  @code
+#  xvar = ...
+#  pdf  = KDE1D_pdf ( 'KDE' , xvar , data , adaptive = True ) ;
+#  @endcode
+#  @see Ostap::Models::KDE
+#  @see Ostap::Math::KDE
+#  @see RooNDKeysPdf
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date 2026-10-15
+class KDE1D_pdf(PDF) :
+    """Ostap-native binned (FFT-based) kernel density estimator,
+    the fast replacement for RooNDKeysPdf/RooKeys1D_pdf
+    - the data are binned on the fine grid and the grid is convolved
+      with the gaussian kernel via FFT
+    - optionally the adaptive bandwidth (Abramson's square-root law) is used
+    - the density is interpolated between the grid nodes,
+      the integrals are analytic
+    - see Ostap.Models.KDE
+    - see Ostap.Math.KDE 
+    >>> xvar = ...
+    >>> pdf  = KDE1D_pdf ( 'KDE' , xvar , data , adaptive = True )
+    """
+    ## constructor
+    def __init__ ( self             ,
+                   name             ,   ## the name 
+                   xvar             ,   ## the variable
+                   data             ,   ## data set or Ostap.Math.KDE  
+                   nbins    = 1024  ,   ## number of grid bins 
+                   rho      = 1     ,   ## global scale for the bandwidth 
+                   adaptive = False ,   ## adaptive bandwidth ? 
+                   mirror   = True  ) : ## mirror data at the boundaries ?
+        
+        ## initialize the base class 
+        PDF.__init__ (  self , name , xvar )
+
+        self.__data     = data
+        self.__nbins    = nbins 
+        self.__rho      = rho 
+        self.__adaptive = True if adaptive else False 
+        self.__mirror   = True if mirror   else False 
+
+        ## create PDF
+        if isinstance ( data , Ostap.Math.KDE ) :
+            self.pdf = Ostap.Models.KDE (
+                self.roo_name ( 'kde1_' ) , 
+                "KDE 1D %s"  % self.name  ,
+                self.xvar                 ,
+                data                      )
+        else :
+            self.pdf = Ostap.Models.KDE (
+                self.roo_name ( 'kde1_' ) , 
+                "KDE 1D %s"  % self.name  ,
+                self.xvar                 ,
+                self.data                 ,
+                self.nbins                ,
+                self.rho                  ,
+                self.adaptive             ,
+                self.mirror               )
+            
+        ## save configuration
+        self.config = {
+            'name'     : self.name     ,
+            'xvar'     : self.xvar     ,
+            'data'     : self.data     ,            
+            'nbins'    : self.nbins    ,            
+            'rho'      : self.rho      ,            
+            'adaptive' : self.adaptive ,            
+            'mirror'   : self.mirror   ,            
+            }
+
+    @property
+    def data     ( self ) :
+        """``data'' : the actual data set (or Ostap.Math.KDE) for KDE"""
+        return self.__data
+    @property
+    def nbins    ( self ) :
+        """``nbins'' : number of grid bins"""
+        return self.__nbins        
+    @property
+    def rho      ( self )  :
+        """``rho'' : global scale factor for the bandwidth"""
+        return self.__rho 
+    @property
+    def adaptive ( self )  :
+        """``adaptive'' : use the adaptive bandwidth?"""
+        return self.__adaptive
+    @property
+    def mirror   ( self )  :
+        """``mirror'' : mirror the data at the boundaries?"""
+        return self.__mirror 
+    @property
+    def kde      ( self )  :
+        """``kde'' : the underlying density, Ostap.Math.KDE"""
+        return self.pdf.kde () 
     
 # =============================================================================
 ## create popular 1D ``background''  function
@@ -108,6 +108,7 @@ class PDF (FUNC) :
         ## take care about sPlots 
         self.__splots          = []
         self.__histo_data      = None
+        self.__summary         = None ## cached summary: ( key , Ostap::Math::PdfSummary )
         self.__fit_options     = () ## predefined fit options for this PDF
         self.__special         = True if special else False
         
@@ -281,6 +282,15 @@ class PDF (FUNC) :
     #  r,f = model.fitTo ( dataset , ncpu     = 10   )    
     #  r,f = model.fitTo ( dataset , draw = True , nbins = 300 )    
     #  @endcode 
+    #  - the successful fit results can be cached in the persistent database
+    #    (<code>cache</code> argument): the repeated fit of the same model with 
+    #    the same initial parameters to the same data with the same options
+    #    just restores the parameters from the stored result 
+    #  @code
+    #  r,f = model.fitTo ( dataset , cache = True         ) ## default database 
+    #  r,f = model.fitTo ( dataset , cache = 'my_fits.db' ) ## specific database 
+    #  @endcode 
+    #  @see ostap.fitting.fitcache 
     def fitTo ( self           ,
                 dataset        ,
                 draw   = False ,
@@ -295,6 +305,14 @@ class PDF (FUNC) :
         >>> r,f = model.fitTo ( dataset , weighted = True )    
         >>> r,f = model.fitTo ( dataset , ncpu     = 10   )    
         >>> r,f = model.fitTo ( dataset , draw = True , nbins = 300 )    
+
+        - the successful fit results can be cached in the persistent database
+        (``cache'' argument): the repeated fit of the same model with 
+        the same initial parameters to the same data with the same options
+        just restores the parameters from the stored result, see ostap.fitting.fitcache
+        
+        >>> r,f = model.fitTo ( dataset , cache = True         ) ## default database 
+        >>> r,f = model.fitTo ( dataset , cache = 'my_fits.db' ) ## specific database 
         """
         if timer :
             from ostap.utils.timing import timing 
@@ -322,6 +340,7 @@ class PDF (FUNC) :
         #
         ## treat the arguments properly
         #
+        cache    = kwargs.pop ( 'cache' , False ) 
         opts     = self.fit_options + ( ROOT.RooFit.Save () , ) + args 
         opts     = self.parse_args ( dataset , *opts , **kwargs )
         
@@ -367,12 +386,29 @@ class PDF (FUNC) :
                 if not silent : 
                     self    .info ('Set binning cache %s for variable %s in dataset' %  ( nb1 , xv.name )  )
 
+        ## look for the fit result in the cache 
+        result = None 
+        if cache :
+            from ostap.fitting.fitcache import fit_cache, fit_key, lookup, store, restore_params 
+            cache  = fit_cache ( cache )
+            key    = fit_key   ( self.pdf , dataset , *opts )
+            result = lookup    ( cache , key ) 
+            if result :
+                restore_params ( self.pdf , result , dataset )
+                self.fit_result = result 
+                if hasattr ( self.pdf , 'setPars' ) : self.pdf.setPars() 
+                if not silent : self.info ( 'fitTo: the fit result is taken from the cache %s' % cache )
+                
         ## define silent context
-        with roo_silent ( silent ) :
-            self.fit_result = None            
-            result          = self.fit_to ( self.pdf , dataset , *opts ) 
-            self.fit_result = result 
-            if hasattr ( self.pdf , 'setPars' ) : self.pdf.setPars() 
+        if not result : 
+            with roo_silent ( silent ) :
+                self.fit_result = None            
+                result          = self.fit_to ( self.pdf , dataset , *opts ) 
+                self.fit_result = result 
+                if hasattr ( self.pdf , 'setPars' ) : self.pdf.setPars() 
+            ## store the successful fit in the cache
+            if cache and valid_pointer ( result ) and 0 == result.status () :
+                store ( cache , key , result ) 
 
         if not valid_pointer (  result ) :
             self.fatal ( "fitTo: RooFitResult is invalid. Check model&data" )
@@ -482,9 +518,40 @@ class PDF (FUNC) :
                          
         return result, frame 
 
+    # =========================================================================
+    ## make the asynchronous fit: the model and the dataset are cloned and
+    #  the fit is performed in the pool of worker processes
+    #  @code
+    #  futures = [ model.fitTo_async ( ds , silent = True ) for ds in datasets ]
+    #  results = gather ( futures ) 
+    #  r , f   = futures[0].result() 
+    #  model.load_params ( r ) 
+    #  @endcode
+    #  @param dataset the dataset 
+    #  @param pool    the pool of worker processes (default: <code>fit_pool()</code>)
+    #  @param kwargs  the keyword arguments for <code>fitTo</code>
+    #  @return the future for <code>(RooFitResult,frame)</code>
+    #  @attention the model itself is not modified
+    #  @see ostap.fitting.fitasync
+    def fitTo_async ( self , dataset , pool = None , **kwargs ) :
+        """Make the asynchronous fit: the model and the dataset are cloned and
+        the fit is performed in the pool of worker processes
+        - the model itself is not modified
+        - see ostap.fitting.fitasync
+        >>> futures = [ model.fitTo_async ( ds , silent = True ) for ds in datasets ]
+        >>> results = gather ( futures ) 
+        >>> r , f   = futures[0].result() 
+        >>> model.load_params ( r ) 
+        """
+        from ostap.fitting.fitasync import fit_async 
+        return fit_async ( self , dataset , method = 'fitTo' , pool = pool , **kwargs )
+
     ## helper method to draw set of components 
-    def _draw ( self , what , frame , options , style = None , args = () ) :
+    #  @param curves the fast renderer of curves (if any)
+    #  @see ostap.fitting.curves.CurvePlotter
+    def _draw ( self , what , frame , options , style = None , args = () , curves = None ) :
         """ Helper method to draw set of components
+        - curves : the fast renderer of curves (if any), see `ostap.fitting.curves.CurvePlotter`
         """
 
         from ostap.plotting.fit_draw import Styles, Style
@@ -504,6 +571,11 @@ class PDF (FUNC) :
 
             atup = args + tuple ( options ) + tuple ( st ) 
             self.debug   ( 'drawing component %s with options %s' % ( cmp.name , ( component, ) + atup ) )             
+
+            ## use the fast rendering, if possible
+            if curves and curves.add ( cmp.name , atup ) : continue
+            if curves : curves.flush ()
+            
             self.plot_on ( self.pdf , frame , component , *atup  )
             
     # ================================================================================
@@ -529,7 +601,10 @@ class PDF (FUNC) :
     #  @param crossterm1_style      style(s) for ``crossterm-1''   components
     #  @param crossterm2_style      style(s) for ``crossterm-2''   components
     #  @param background2D_style    style(s) for ``background-2D'' components
+    #  @param fast_curves           use the fast (batch-evaluated and cached) rendering of curves 
+    #  @param curve_points          number of grid points for the fast rendering of curves 
     #  @see ostap.plotting.fit_draw
+    #  @see ostap.fitting.curves
     #
     #  Drawing options can be specified as keyword arguments:
     #  @code
@@ -583,6 +658,8 @@ class PDF (FUNC) :
         Other options:
         -  residual               ## make also residual frame
         -  pull                   ## make also residual frame
+        -  fast_curves            ## fast (batch-evaluated and cached) rendering of curves, see ostap.fitting.curves
+        -  curve_points           ## number of grid points for the fast rendering of curves 
         
         For default values see ostap.plotting.fit_draw
         
@@ -634,11 +711,22 @@ class PDF (FUNC) :
                 commands = data_options 
                 commands = data_options + args +  ( ROOT.RooFit.Invisible() , ) 
                 self.plot_on ( dataset , frame , *commands ) 
+
+            ## fast rendering of curves? 
+            curves  = None 
+            fast    = self.draw_option ( 'fast_curves'  , **kwargs )
+            npoints = self.draw_option ( 'curve_points' , **kwargs )
+            used_options.add ( 'fast_curves'  ) 
+            used_options.add ( 'curve_points' ) 
+            if fast and self.pdf.dependsOn ( drawvar ) :
+                from ostap.fitting.curves import CurvePlotter
+                curves = CurvePlotter ( frame , self.pdf , drawvar ,
+                                        projected = self.vars , npoints = npoints )
                 
             ## draw various ``background'' terms
             boptions     = self.draw_option ( 'background_options' , **kwargs ) 
             bbstyle      = self.draw_option (   'background_style' , **kwargs )
-            self._draw( self.backgrounds , frame , boptions , bbstyle )
+            self._draw( self.backgrounds , frame , boptions , bbstyle , curves = curves )
             used_options.add ( 'background_options' ) 
             used_options.add ( 'background_style'   ) 
 
@@ -649,7 +737,7 @@ class PDF (FUNC) :
                 doptions = self.draw_option ( 'combined_background_options' , **kwargs ) 
                 dstyle   = self.draw_option ( 'combined_background_style'   , **kwargs )
                 
-                if drawit : self._draw ( self.combined_backgrounds , frame , doptions , dstyle , args )
+                if drawit : self._draw ( self.combined_backgrounds , frame , doptions , dstyle , args , curves )
                 
             used_options.add ( 'draw_combined_background'    ) 
             used_options.add ( 'combined_background_options' ) 
@@ -659,7 +747,7 @@ class PDF (FUNC) :
             ct1options   = self.draw_option ( 'crossterm1_options' , **kwargs )
             ct1bstyle    = self.draw_option ( 'crossterm1_style'   , **kwargs ) 
             if hasattr ( self , 'crossterms1' ) and self.crossterms1 : 
-                self._draw( self.crossterms1 , frame , ct1options , ct1bstyle , args )
+                self._draw( self.crossterms1 , frame , ct1options , ct1bstyle , args , curves )
                 
             used_options.add ( 'crossterm1_options' ) 
             used_options.add ( 'crossterm1_style'   ) 
@@ -669,7 +757,7 @@ class PDF (FUNC) :
             ct2bstyle    = self.draw_option ( 'crossterm2_style'   , **kwargs )
             
             if hasattr ( self , 'crossterms2' ) and self.crossterms2 :
-                self._draw( self.crossterms2 , frame , ct2options , ct2bstyle , args )
+                self._draw( self.crossterms2 , frame , ct2options , ct2bstyle , args , curves )
                 
             used_options.add ( 'crossterm2_options' ) 
             used_options.add ( 'crossterm2_style'   ) 
@@ -677,7 +765,7 @@ class PDF (FUNC) :
             ## draw ``other'' components
             coptions     = self.draw_option ( 'component_options' , **kwargs )
             cbstyle      = self.draw_option ( 'component_style'   , **kwargs )
-            self._draw( self.components , frame , coptions , cbstyle , args )
+            self._draw( self.components , frame , coptions , cbstyle , args , curves )
 
             used_options.add ( 'component_options' ) 
             used_options.add ( 'component_style'   ) 
@@ -689,7 +777,7 @@ class PDF (FUNC) :
                 doptions = self.draw_option ( 'combined_component_options' , **kwargs ) 
                 dstyle   = self.draw_option ( 'combined_component_style'   , **kwargs )
                 
-                if drawit : self._draw ( self.combined_components , frame , doptions , dstyle , args )
+                if drawit : self._draw ( self.combined_components , frame , doptions , dstyle , args , curves )
                 
             used_options.add ( 'draw_combined_component'    ) 
             used_options.add ( 'combined_component_options' ) 
@@ -698,7 +786,7 @@ class PDF (FUNC) :
             ## draw ``signal'' components
             soptions     = self.draw_option (    'signal_options'  , **kwargs )
             sbstyle      = self.draw_option (      'signal_style'  , **kwargs ) 
-            self._draw( self.signals , frame , soptions , sbstyle , args )
+            self._draw( self.signals , frame , soptions , sbstyle , args , curves )
 
             used_options.add ( 'signal_options' ) 
             used_options.add ( 'signal_style  ' )
@@ -708,7 +796,7 @@ class PDF (FUNC) :
                 drawit    = self.draw_option ( 'draw_combined_signal'     , **kwargs )
                 doptions  = self.draw_option ( 'combined_signal_options'  , **kwargs ) 
                 dstyle    = self.draw_option (   'combined_signal_style'  , **kwargs )
-                if drawit : self._draw ( self.combined_signals , frame , doptions , dstyle , args )
+                if drawit : self._draw ( self.combined_signals , frame , doptions , dstyle , args , curves )
                 
             used_options.add ( 'draw_combined_signal'    ) 
             used_options.add ( 'combined_signal_options' ) 
@@ -718,7 +806,10 @@ class PDF (FUNC) :
             ## the total fit curve
             #
             totoptions   = self.draw_option (  'total_fit_options' , **kwargs )
-            self.plot_on ( self.pdf , frame , *totoptions ) 
+            if curves and curves.add ( '' , totoptions ) : curves.flush () 
+            else :
+                if curves : curves.flush ()
+                self.plot_on ( self.pdf , frame , *totoptions ) 
             used_options.add ( 'total_fit_options'    ) 
 
             #
@@ -818,13 +909,23 @@ class PDF (FUNC) :
                    density = False ,
                    chi2    = False ,
                    nbins   = None  , 
+                   native  = False , 
                    args    = () , **kwargs ) :
         """Fit the histogram (and draw it)
 
         >>> histo = ...
         >>> r,f = model.fitHisto ( histo , draw = True ) 
+
+        - use `native = True` for the native binned likelihood
+        with precomputed bin integrals, see `PDF.bnllfitTo`
+        >>> r,f = model.fitHisto ( histo , native = True ) 
         
         """
+        if native and not chi2 and not density and not args :
+            return self.bnllfitTo ( histo , draw = draw , silent = silent , nbins = nbins , **kwargs )
+        elif native :
+            self.warning ("fitHisto: `native' is ignored for chi2/density/extra arguments") 
+            
         with RangeVar( self.xvar , *(histo.xminmax()) ) : 
 
             hdata = getattr ( self , 'histo_data' , None )
@@ -865,6 +966,213 @@ class PDF (FUNC) :
                                               silent  = silent   ,
                                               args    = args     , **kwargs )
 
+    # =========================================================================
+    ## make binned likelihood fit for 1D-histogram using the native
+    #  binned negative log-likelihood Ostap::MoreRooFit::BinnedNLL
+    #  - the expectations in bins are the integrals of PDF over bins
+    #  (the analytical <code>integral(low,high)</code> for Ostap::Models PDFs)
+    #  - the bin integrals are recalculated only for components with modified parameters 
+    #  @code
+    #  histo = ...
+    #  r,f = model.bnllfitTo ( histo , draw = True ) 
+    #  @endcode
+    #  @see Ostap::MoreRooFit::BinnedNLL
+    #  @attention for weighted histograms the uncertainties are not corrected 
+    def bnllfitTo ( self            ,
+                    histo           ,
+                    draw    = False ,
+                    silent  = False ,
+                    nbins   = None  , **kwargs ) :
+        """ Binned likelihood fit for 1D-histogram using the native
+        binned negative log-likelihood Ostap::MoreRooFit::BinnedNLL
+        - the expectations in bins are the integrals of PDF over bins
+        (the analytical `integral(low,high)` for Ostap::Models PDFs)
+        - the bin integrals are recalculated only for components with modified parameters 
+        >>> histo = ...
+        >>> result , frame  = model.bnllfitTo ( histo , draw = True )
+        - for weighted histograms the uncertainties are not corrected 
+        """
+        assert isinstance ( histo , ROOT.TH1 ) and 1 == histo.GetDimension () , \
+               "bnllfitTo: invalid histogram type %s" % type ( histo )
+
+        extended = 0 < len ( self.alist1 ) and len ( self.alist1 ) == len ( self.alist2 ) 
+        if not extended and self.pdf.mustBeExtended () :
+            self.warning ( "bnllfitTo: cannot deduce yields, use the regular `fitHisto'" ) 
+            return self.fitHisto ( histo , draw = draw , silent = silent , nbins = nbins , **kwargs )
+
+        with RangeVar ( self.xvar , *histo.xminmax () ) , roo_silent ( silent ) :
+
+            if extended :
+                nll = Ostap.MoreRooFit.BinnedNLL ( rootID ( "bnll_" )                ,
+                                                   "binned NLL(%s)" % self.name      ,
+                                                   self.xvar                         ,
+                                                   self.alist1 , self.alist2 , histo )
+            else :
+                nll = Ostap.MoreRooFit.BinnedNLL ( rootID ( "bnll_" )                ,
+                                                   "binned NLL(%s)" % self.name      ,
+                                                   self.xvar , self.pdf , histo      )
+                
+            m = ROOT.RooMinuit ( nll )
+            if silent : m.setPrintLevel ( -1 ) 
+            m.migrad   () 
+            m.hesse    ()
+            result = m.save ()
+            ## save fit results 
+            self.fit_result = result 
+
+            self.debug ( "bnllfitTo: %d recalculations of bin integrals" % nll.recalculations () ) 
+            
+        if not draw :
+            return result, None 
+
+        with RangeVar ( self.xvar , *histo.xminmax () ) :
+            self.histo_data = H1D_dset ( histo = histo , xaxis = self.xvar , silent = silent )
+            hdataset        = self.histo_data.dset 
+
+        from ostap.plotting.fit_draw import draw_options         
+        draw_opts = draw_options ( **kwargs )
+        if isinstance ( draw , dict ) : draw_opts.update( draw )
+
+        return result, self.draw ( hdataset , nbins = nbins , silent = silent , **draw_opts )
+
+    # =========================================================================
+    ## Multi-threaded (in-process) unbinned likelihood fit
+    #  using Ostap::MoreRooFit::ParallelNLL
+    #  - the dataset is split into the categories (for RooSimultaneous)
+    #    and chunks of events, evaluated in the persistent threads
+    #  - each thread uses its own deep copy of PDF
+    #  @code
+    #  dataset = ...
+    #  result , _ = model.mtfitTo ( dataset , nthreads = 8 )
+    #  @endcode
+    #  The compact (single-precision) data can be used instead of dataset
+    #  @code
+    #  data = Ostap.Utils.CompactData ( dataset ) 
+    #  result , _ = model.mtfitTo ( data , nthreads = 8 )
+    #  @endcode
+    #  @attention for weighted datasets the uncertainties are not corrected
+    #  @see Ostap::MoreRooFit::ParallelNLL
+    #  @see Ostap::Utils::CompactData
+    def mtfitTo ( self                ,
+                  dataset             ,
+                  nthreads   = 0      ,
+                  chunk_size = 20000  ,
+                  draw       = False  ,
+                  nbins      = 100    ,
+                  silent     = False  , **kwargs ) :
+        """ Multi-threaded (in-process) unbinned likelihood fit
+        using Ostap::MoreRooFit::ParallelNLL
+        - the dataset is split into the categories (for RooSimultaneous)
+        and chunks of events, evaluated in the persistent threads
+        - each thread uses its own deep copy of PDF
+        >>> dataset = ...
+        >>> result , _ = model.mtfitTo ( dataset , nthreads = 8 )
+        - the compact (single-precision) data can be used instead of dataset
+        >>> data = Ostap.Utils.CompactData ( dataset ) 
+        >>> result , _ = model.mtfitTo ( data , nthreads = 8 )
+        - for weighted datasets the uncertainties are not corrected
+        - see Ostap.Utils.CompactData
+        """
+        compact = isinstance ( dataset , Ostap.Utils.CompactData ) 
+        assert compact or isinstance ( dataset , ROOT.RooAbsData ) , \
+               "mtfitTo: invalid dataset type %s" % type ( dataset )
+
+        extended = self.pdf.canBeExtended ()
+        if ( dataset.weighted () if compact else dataset.isWeighted () ) :
+            self.warning ( "mtfitTo: the uncertainties are not corrected for weighted dataset" )
+
+        with roo_silent ( silent ) :
+
+            nll = Ostap.MoreRooFit.ParallelNLL ( rootID ( "mtnll_" )             ,
+                                                 "parallel NLL(%s)" % self.name  ,
+                                                 self.pdf , dataset , extended   ,
+                                                 nthreads , chunk_size           )
+
+            self.debug ( "mtfitTo: %d threads, %d partitions, %d tasks" % ( nll.nThreads    () ,
+                                                                           nll.nPartitions () ,
+                                                                           nll.nTasks      () ) )
+            m = ROOT.RooMinuit ( nll )
+            if silent : m.setPrintLevel ( -1 )
+            m.migrad   ()
+            m.hesse    ()
+            result = m.save ()
+            ## save fit results
+            self.fit_result = result
+
+        if not draw :
+            return result, None
+        
+        if compact :
+            self.warning ( "mtfitTo: drawing is not supported for compact data" )
+            return result, None
+        
+        from ostap.plotting.fit_draw import draw_options
+        draw_opts = draw_options ( **kwargs )
+        if isinstance ( draw , dict ) : draw_opts.update( draw )
+
+        return result, self.draw ( dataset , nbins = nbins , silent = silent , **draw_opts )
+
+    # =========================================================================
+    ## Unbinned likelihood fit with the analytic gradient
+    #  using Ostap::MoreRooFit::GradientNLL
+    #  - supported shapes: CrystalBall, CrystalBallDS, Apollonios, StudentT,
+    #    PolyPositive and extended sums of them
+    #  - MIGRAD uses the analytic gradient, HESSE is performed by RooMinimizer
+    #  @code
+    #  dataset = ...
+    #  result , _ = model.gradfitTo ( dataset , nthreads = 8 )
+    #  @endcode
+    #  @attention for weighted datasets the uncertainties are not corrected
+    #  @see Ostap::MoreRooFit::GradientNLL
+    def gradfitTo ( self                ,
+                    dataset             ,
+                    nthreads   = 0      ,
+                    draw       = False  ,
+                    nbins      = 100    ,
+                    silent     = False  , **kwargs ) :
+        """ Unbinned likelihood fit with the analytic gradient
+        using Ostap::MoreRooFit::GradientNLL
+        - supported shapes: CrystalBall, CrystalBallDS, Apollonios, StudentT,
+        PolyPositive and extended sums of them
+        - MIGRAD uses the analytic gradient, HESSE is performed by RooMinimizer
+        >>> dataset = ...
+        >>> result , _ = model.gradfitTo ( dataset , nthreads = 8 )
+        - for weighted datasets the uncertainties are not corrected
+        """
+        assert isinstance ( dataset , ROOT.RooAbsData ) , \
+               "gradfitTo: invalid dataset type %s" % type ( dataset )
+        assert Ostap.MoreRooFit.GradientNLL.supported ( self.pdf ) , \
+               "gradfitTo: PDF %s is not supported" % self.pdf.GetName ()
+
+        if dataset.isWeighted () :
+            self.warning ( "gradfitTo: the uncertainties are not corrected for weighted dataset" )
+
+        with roo_silent ( silent ) :
+
+            nll = Ostap.MoreRooFit.GradientNLL ( rootID ( "gradnll_" )              ,
+                                                 "gradient NLL(%s)" % self.name  ,
+                                                 self.pdf , dataset , nthreads    )
+
+            status = nll.migrad ( 1 , 0.1 , -1 if silent else 0 )
+            if 0 != status :
+                self.warning ( "gradfitTo: MIGRAD status %s" % status )
+
+            m = ROOT.RooMinimizer ( nll )
+            if silent : m.setPrintLevel ( -1 )
+            m.hesse    ()
+            result = m.save ()
+            ## save fit results
+            self.fit_result = result
+
+        if not draw :
+            return result, None
+
+        from ostap.plotting.fit_draw import draw_options
+        draw_opts = draw_options ( **kwargs )
+        if isinstance ( draw , dict ) : draw_opts.update( draw )
+
+        return result, self.draw ( dataset , nbins = nbins , silent = silent , **draw_opts )
+
     # =========================================================================
     ## make chi2-fit for binned dataset or histogram
     #  @code
@@ -927,8 +1235,25 @@ class PDF (FUNC) :
 
         return result, self.draw ( hdataset , nbins = nbins , silent = silent , **draw_opts )
 
-
-
+    # =========================================================================
+    ## make the asynchronous chi2-fit: the model and the dataset (histogram)
+    #  are cloned and the fit is performed in the pool of worker processes
+    #  @code
+    #  future = model.chi2fitTo_async ( histo , silent = True )
+    #  r , f  = future.result() 
+    #  @endcode
+    #  @attention the model itself is not modified
+    #  @see ostap.fitting.fitasync
+    def chi2fitTo_async ( self , dataset , pool = None , **kwargs ) :
+        """Make the asynchronous chi2-fit: the model and the dataset (histogram)
+        are cloned and the fit is performed in the pool of worker processes
+        - the model itself is not modified
+        - see ostap.fitting.fitasync
+        >>> future = model.chi2fitTo_async ( histo , silent = True )
+        >>> r , f  = future.result() 
+        """
+        from ostap.fitting.fitasync import fit_async 
+        return fit_async ( self , dataset , method = 'chi2fitTo' , pool = pool , **kwargs )
 
     # =========================================================================
     ## draw/prepare NLL or LL-profiles for selected variable
@@ -1289,6 +1614,47 @@ class PDF (FUNC) :
         if draw : graph.draw ('ap')
         
         return graph 
+
+    # =========================================================================
+    ## get the profile-likelihood graph for the variable using the scan engine:
+    #  - NLL and minimizer are built only once 
+    #  - each point starts from the neighbour solution (warm start)
+    #  - the scan is refined near the minimum and 1&2 sigma crossings
+    #  - the points can be distributed among <code>nsplit</code> processes 
+    #  @code
+    #  pdf    = ...
+    #  graph  = pdf.scan_profile ( 'S' , vrange ( 0 , 100 , 100 ) , dataset , nsplit = 8 )
+    #  spline = graph.spline3 () 
+    #  @endcode
+    #  @see ostap.fitting.scan.profile_scan
+    def scan_profile ( self             ,
+                       variable         ,
+                       values           ,
+                       dataset          ,
+                       refine   = 2     ,
+                       nsplit   = 1     ,
+                       silent   = True  ,
+                       draw     = False ,
+                       subtract = True  , **kwargs ) :
+        """Get the profile-likelihood graph for the variable using the scan engine:
+        - NLL and minimizer are built only once 
+        - each point starts from the neighbour solution (warm start)
+        - the scan is refined near the minimum and 1&2 sigma crossings
+        - the points can be distributed among `nsplit` processes 
+        >>> pdf    = ...
+        >>> graph  = pdf.scan_profile ( 'S' , vrange ( 0 , 100 , 100 ) , dataset , nsplit = 8 )
+        >>> spline = graph.spline3 () 
+        - see ostap.fitting.scan.profile_scan
+        """
+        from ostap.fitting.scan import profile_scan
+        graph = profile_scan ( self                ,
+                               variable , values   , dataset ,
+                               refine   = refine   ,
+                               nsplit   = nsplit   ,
+                               subtract = subtract ,
+                               silent   = silent   , **kwargs )
+        if draw : graph.draw ('apl')
+        return graph 
         
     # ========================================================================
     ## evaluate "significance" using Wilks' theorem via NLL
@@ -1748,6 +2114,63 @@ class PDF (FUNC) :
         self.__splots     = []
         self.__histo_data = None 
         self.__fit_result = None
+        self.__summary    = None
+        
+    # ========================================================================
+    ## Get the "one-shot" summary for the distribution: the (piecewise Chebyshev)
+    #  proxy of PDF is built once in C++, and all moments, quantiles and intervals
+    #  are derived from it. The summary is cached until the parameters
+    #  (or the interval) are changed.
+    #  @code
+    #  pdf = ...
+    #  s   = pdf.summary()
+    #  print ( 'mean/rms/median: %s/%s/%s' % ( s.mean() , s.rms() , s.median() ) ) 
+    #  @endcode
+    #  @see Ostap::Math::PdfSummary
+    def summary ( self , xmin = None , xmax = None , precision = 1.e-10 ) :
+        """Get the "one-shot" summary for the distribution: the (piecewise Chebyshev)
+        proxy of PDF is built once in C++, and all moments, quantiles and intervals
+        are derived from it. The summary is cached until the parameters
+        (or the interval) are changed.
+        >>> pdf = ...
+        >>> s   = pdf.summary()
+        >>> print ( 'mean/rms/median: %s/%s/%s' % ( s.mean() , s.rms() , s.median() ) ) 
+        - see Ostap::Math::PdfSummary
+        """
+        if self.xminmax() :
+            mn , mx = self.xminmax()
+            xmin = mn if xmin is None else max ( xmin , mn )
+            xmax = mx if xmax is None else min ( xmax , mx )
+
+        assert not xmin is None  , 'xmin is not defined!' 
+        assert not xmax is None  , 'xmax is not defined!' 
+
+        xname = self.xvar.name 
+        pars  = tuple ( ( p.name , p.getVal () ) for p in self.params () if p.name != xname )
+        key   = float ( xmin ) , float ( xmax ) , float ( precision ) , pars 
+
+        if self.__summary and key == self.__summary [ 0 ] : return self.__summary [ 1 ]
+        
+        summary        = Ostap.Math.PdfSummary ( self.pdf , self.xvar ,
+                                                 float ( xmin ) , float ( xmax ) , float ( precision ) )
+        self.__summary = key , summary 
+        return summary
+
+    # ========================================================================
+    ## use the cached summary to get the statistics
+    #  @return the result or <code>None</code> if the summary is not applicable 
+    def _summary_stat_ ( self , method , *args , **kwargs ) :
+        """Use the cached summary to get the statistics
+        - return the result or None if the summary is not applicable
+        """
+        if kwargs.pop ( 'err' , False ) : return None
+        xmin = kwargs.pop ( 'xmin' , None )
+        xmax = kwargs.pop ( 'xmax' , None )
+        if kwargs : return None        
+        try :
+            return getattr ( self.summary ( xmin , xmax ) , method ) ( *args )
+        except Exception :
+            return None 
         
     # ========================================================================
     ## get the effective RMS 
@@ -1769,6 +2192,9 @@ class PDF (FUNC) :
             elif hasattr ( ff , 'variance'   ) : return ff.variance   ()**0.5  
             elif hasattr ( ff , 'dispersion' ) : return ff.dispersion ()**0.5 
             
+        result = self._summary_stat_ ( 'rms' , **kwargs )
+        if not result is None : return result
+        
         from ostap.stats.moments import rms as _rms
         return  self._get_stat_ ( _rms , **kwargs )
 
@@ -1780,6 +2206,9 @@ class PDF (FUNC) :
         >>>  pdf.fitTo ( ... )
         >>>  print 'SKEWNESS: %s ' % pdf.skewness()
         """
+        result = self._summary_stat_ ( 'skewness' , **kwargs )
+        if not result is None : return result
+        
         ## use generic machinery 
         from ostap.stats.moments import skewness as _skewness
         return self._get_stat_ ( _skewness , **kwargs )
@@ -1792,6 +2221,9 @@ class PDF (FUNC) :
         >>>  pdf.fitTo ( ... )
         >>>  print 'KURTOSIS: %s ' % pdf.kurtosis()
         """
+        result = self._summary_stat_ ( 'kurtosis' , **kwargs )
+        if not result is None : return result
+        
         ## use generic machinery 
         from ostap.stats.moments import kurtosis as _kurtosis
         return self._get_stat_ ( _kurtosis , **kwargs )
@@ -1804,6 +2236,9 @@ class PDF (FUNC) :
         >>>  pdf.fitTo ( ... )
         >>>  print 'MEDIAN: %s ' % pdf.median()
         """
+        result = self._summary_stat_ ( 'median' , **kwargs )
+        if not result is None : return result
+        
         from ostap.stats.moments import median as _median
         return self._get_stat_ ( _median , **kwargs )
 
@@ -1815,6 +2250,9 @@ class PDF (FUNC) :
         >>>  pdf.fitTo ( ... )
         >>>  print 'MEAN: %s ' % pdf.get_mean()
         """
+        result = self._summary_stat_ ( 'mean' , **kwargs )
+        if not result is None : return result
+        
         from ostap.stats.moments import mean as _mean
         return self._get_stat_ ( _mean , **kwargs )
     
@@ -1826,6 +2264,9 @@ class PDF (FUNC) :
         >>>  pdf.fitTo ( ... )
         >>>  print 'MOMENT: %s ' % pdf.moment( 10 )
         """
+        result = self._summary_stat_ ( 'moment' , N , **kwargs )
+        if not result is None : return result
+        
         ## use generic machinery 
         from ostap.stats.moments import moment as _moment
         return self._get_stat_ ( _moment , N , **kwargs ) 
@@ -1838,6 +2279,9 @@ class PDF (FUNC) :
         >>>  pdf.fitTo ( ... )
         >>>  print 'MOMENT: %s ' % pdf.moment( 10 )
         """
+        result = self._summary_stat_ ( 'central_moment' , N , **kwargs )
+        if not result is None : return result
+        
         from ostap.stats.moments import central_moment as _moment
         return self._get_stat_ ( _moment , N , **kwargs ) 
 
@@ -1849,8 +2293,11 @@ class PDF (FUNC) :
         >>>  pdf.fitTo ( ... )
         >>>  print 'QUANTILE: %s ' % pdf.quantile ( 0.10 )
         """
+        result = self._summary_stat_ ( 'quantile' , prob , **kwargs )
+        if not result is None : return result
+        
         from ostap.stats.moments import quantile as _quantile
-        return self._get_stat_ ( quantile , prob , **kwargs ) 
+        return self._get_stat_ ( _quantile , prob , **kwargs ) 
 
     # =========================================================================
     ## get the symmetric confidence interval 
@@ -1860,6 +2307,13 @@ class PDF (FUNC) :
         >>>  pdf.fitTo ( ... )
         >>>  print 'CL :  ',  pdf.cl_symm ( 0.10 )
         """
+        c0     = float ( x0 ) if isinstance ( x0 , num_types ) else float ( 'nan' )
+        result = self._summary_stat_ ( 'cl_symm' , prob , c0 , **kwargs )
+        if not result is None :
+            if x0 is None : x0 = self.summary ( kwargs.get ( 'xmin' , None ) ,
+                                                kwargs.get ( 'xmax' , None ) ).mean () 
+            return VE ( x0 , result * result ) 
+        
         from ostap.stats.moments import cl_symm as _cl
         return self._get_stat_ ( _cl , prob , x0 , **kwargs ) 
 
@@ -1871,6 +2325,9 @@ class PDF (FUNC) :
         >>>  pdf.fitTo ( ... )
         >>>  print 'CL :  ',  pdf.cl_asymm ( 0.10 )
         """
+        result = self._summary_stat_ ( 'cl_asymm' , prob , **kwargs )
+        if not result is None : return result.first , result.second 
+        
         from ostap.stats.moments import cl_asymm as _cl
         return self._get_stat_ ( _cl , prob , **kwargs )
     
@@ -1902,7 +2359,7 @@ class PDF (FUNC) :
         ## 2) use numerical integration
         from ostap.math.integral import integral as _integral
 
-        extended =  self.pdf.canBeExtended() or isinstance ( self.pdf , ROOT.RooAddPdf )
+        extended =  self.pdf.canBeExtended() or isinstance ( self.pdf , ( ROOT.RooAddPdf , Ostap.MoreRooFit.AddPdf ) )
         
         if   todo and extended : value = _integral ( self , xmin , xmax )
 
@@ -2220,16 +2677,62 @@ class PDF (FUNC) :
         dataset.project ( hdata , self.xvar.name )
         return self.pull_histo ( hdata ) 
         
+    # ==========================================================================
+    ## calculate MINOS errors for several parameters in parallel
+    #  and update the fit result
+    #  @code
+    #  result , _ = pdf.fitTo ( dataset , ... )
+    #  pdf.minos ( dataset , result , 'S' , 'B' ) 
+    #  @endcode
+    #  @see ostap.parallel.parallel_minos.parallel_minos 
+    def minos ( self , dataset , result , *params , **kwargs ) :
+        """Calculate MINOS errors for several parameters in parallel
+        and update the fit result
+        >>> result , _ = pdf.fitTo ( dataset , ... )
+        >>> pdf.minos ( dataset , result , 'S' , 'B' ) 
+        - see ostap.parallel.parallel_minos.parallel_minos 
+        """
+        from ostap.parallel.parallel_minos import parallel_minos
+        pconf = dict ( ( k , kwargs.pop ( k ) ) for k in ( 'ncpus' , 'ppservers' ) if k in kwargs ) 
+        return parallel_minos ( self , dataset , result , params , fit_config = kwargs , **pconf ) 
+
     # ==========================================================================
     ## make 2D-cpontours
+    #  @code
+    #  frame = pdf.contours ( 'S' , 'B' , dataset , levels = ( 1 , 2 ) ) 
+    #  frame = pdf.contours ( 'S' , 'B' , dataset , levels = ( 1 , 2 ) , parallel = True ) 
+    #  @endcode
+    #  For <code>parallel=True</code> the points are calculated independently
+    #  in parallel processes
+    #  @see ostap.parallel.parallel_minos.parallel_contours 
     # ==========================================================================
     def contours ( self              ,
                    var1              ,
                    var2              ,
                    dataset           ,
-                   levels  = ( 1 , ) ,
-                   npoints = 100     ,
+                   levels   = ( 1 , ) ,
+                   npoints  = 100     ,
+                   parallel = False   , 
                    **kwargs          ) :
+        """Make 2D-contours
+        >>> frame = pdf.contours ( 'S' , 'B' , dataset , levels = ( 1 , 2 ) ) 
+        >>> frame = pdf.contours ( 'S' , 'B' , dataset , levels = ( 1 , 2 ) , parallel = True ) 
+        For `parallel=True` the points are calculated independently
+        in parallel processes
+        - see ostap.parallel.parallel_minos.parallel_contours 
+        """
+        
+        if parallel :
+            from ostap.parallel.parallel_minos import parallel_contours
+            pconf = dict ( ( k , kwargs.pop ( k ) ) for k in ( 'ncpus' , 'ppservers' , 'nsplit' ) if k in kwargs ) 
+            mn     = self.minuit ( dataset , **kwargs )
+            import ostap.fitting.roofitresult
+            status = mn.migrad ( tag = 'contours' )
+            result = mn.save   ()
+            return parallel_contours ( self , var1 , var2 , dataset , result ,
+                                       levels     = levels  ,
+                                       npoints    = npoints ,
+                                       fit_config = kwargs  , **pconf ) 
         
         ## create the minuit 
         mn = self.minuit ( dataset , **kwargs )
@@ -3228,12 +3731,22 @@ def make_pdf ( pdf , args , name = '' ) :
 #  @see Ostap::Models:Shape1D
 #  @author Vanya Belyaev Ivan.Belyaev@itep.ru
 #  @date 2020-07-20
+#  The expensive shape can be replaced by its piecewise Chebyshev proxy 
+#  @code
+#  bw  = Ostap.Math.BW ( ... )
+#  pdf = Shape1D_pdf ( 'BW' , bw , xvar = mass , proxy = 1.e-10 ) 
+#  @endcode 
+#  @see Ostap::Math::ChebyshevProxy
 class Shape1D_pdf(PDF) :
     """ Generic 1D-shape from C++ callable
     - see Ostap::Models:Shape1D
+    The expensive shape can be replaced by its piecewise Chebyshev proxy
+    >>> bw  = Ostap.Math.BW ( ... )
+    >>> pdf = Shape1D_pdf ( 'BW' , bw , xvar = mass , proxy = 1.e-10 ) 
+    - see Ostap::Math::ChebyshevProxy
     """
     
-    def __init__ ( self , name , shape , xvar ) :
+    def __init__ ( self , name , shape , xvar , proxy = None ) :
 
         ##  iniialize the base 
         PDF.__init__ ( self , name , xvar ) 
@@ -3242,6 +3755,13 @@ class Shape1D_pdf(PDF) :
             self.histo = shape
             shape      = Ostap.Math.Histo1D ( shape )
 
+        self.__original = shape 
+        if proxy :
+            assert self.xminmax () , 'Shape1D_pdf: the proxy requires the finite range!'
+            precision = 1.e-10 if isinstance ( proxy , bool ) else float ( proxy )
+            xmin , xmax = self.xminmax ()
+            shape = Ostap.Math.ChebyshevProxy ( shape , xmin , xmax , precision )
+            
         self.__shape = shape
         
         ## create the actual pdf
@@ -3253,15 +3773,21 @@ class Shape1D_pdf(PDF) :
 
         ## save the configuration
         self.config = {
-            'name'    : self.name    , 
-            'shape'   : self.shape   , 
-            'xvar'    : self.xvar    , 
+            'name'    : self.name     , 
+            'shape'   : self.original , 
+            'xvar'    : self.xvar     , 
+            'proxy'   : proxy         , 
             }
         
     @property
     def shape  ( self ) :
-        """``shape'': the actual C++ callable shape"""
+        """``shape'': the actual C++ callable shape (or its proxy)"""
         return self.__shape 
+
+    @property
+    def original ( self ) :
+        """``original'': the original C++ callable shape"""
+        return self.__original 
             
 # =============================================================================
 ## simple convertor of 1D-histogram into PDF
@@ -3339,6 +3865,7 @@ class H1D_pdf(H1D_dset,PDF) :
 #  @param recursive_signals     use recursive fractions for compound signal
 #  @param recursive_backgriunds use recursive fractions for compound background
 #  @param recursive_others      use recursive fractions for compound others
+#  @param cached                cache the values of components (Ostap::MoreRooFit::AddPdf)
 #  @param S                     yields of signal components 
 #  @param B                     yields of background components 
 #  @param C                     yields of others components
@@ -3367,6 +3894,8 @@ class Fit1D (PDF) :
     - combine_backgrounds : combine all background components into single BACKGROUND?
     - combine_others      : combine all other components into single COMPONENT?
     - recursive           : use recursive fractions for compound PDF
+    - cached              : cache the values of components (Ostap::MoreRooFit::AddPdf):
+                            only components with modified parameters are recalculated 
     - xvar                : the fitting variable, must be specified if components are given as RooAbsPdf
 
     >>> gauss = Gauss_pdf( ... ) 
@@ -3391,6 +3920,7 @@ class Fit1D (PDF) :
                    recursive_signals     = True    ,    ## recursive fractions for combined signal?
                    recursive_backgrounds = True    ,    ## recursive fractions for combined background?
                    recursive_others      = True    ,    ## recursive fractions for combined other components?
+                   cached                = False   ,    ## cache the component values? (Ostap::MoreRooFit::AddPdf)
                    S                     = ()      ,    ## yields for ``signals''
                    B                     = ()      ,    ## yields for ``background''
                    C                     = ()      ,    ## yields for ``components''
@@ -3413,6 +3943,8 @@ class Fit1D (PDF) :
         self.__recursive_backgrounds = True if recursive_backgrounds else False
         self.__recursive_others      = True if recursive_others      else False
 
+        self.__cached                = True if cached                else False
+
         self.__signal_components     = ()
         self.__background_components = () 
         self.__other_components      = ()
@@ -3632,7 +4164,8 @@ class Fit1D (PDF) :
         if not self.extended :
             pdf_args = pdf_args + ( True if recursive else False , ) ## RECURSIVE ?
             
-        self.pdf = ROOT.RooAddPdf ( *pdf_args )
+        if self.cached : self.pdf = Ostap.MoreRooFit.AddPdf ( *pdf_args )
+        else           : self.pdf = ROOT.RooAddPdf          ( *pdf_args )
 
         ## sanity checks
 
@@ -3666,6 +4199,8 @@ class Fit1D (PDF) :
             'recursive_backgrounds' : self.recursive_backgrounds ,
             'recursive_others'      : self.recursive_others      ,
             ##
+            'cached'                : self.cached                ,
+            ##
             'fS'                    : self.fS                    ,
             'fB'                    : self.fB                    ,
             'fC'                    : self.fC                    ,
@@ -3688,6 +4223,11 @@ class Fit1D (PDF) :
         """``suffix'' : append the names  with the specified suffix"""
         return self.__suffix
 
+    @property
+    def cached   ( self ) :
+        """``cached'' : cache the values of components, see Ostap::MoreRooFit::AddPdf"""
+        return self.__cached
+
     @property
     def combine_signals ( self ) :
         """Combine all ``signal''-components into single ``signal'' componet?"""
@@ -15,10 +15,12 @@ __date__    = "2009-09-12"
 __version__ = ""
 # =============================================================================
 __all__     = (
-    'C2FIT' , ## simple chi2-fit 
+    'C2FIT'    , ## simple chi2-fit 
+    'C2SOLVER' , ## linear least squares solver for batch fits 
     ) 
 # =============================================================================
 import ROOT, cppyy
+from   array import array 
 # =============================================================================
 # logging 
 # =============================================================================
@@ -65,7 +67,8 @@ def _h_Fit_ ( self                              ,
               components                        ,
               draw = False                      ,
               interpolate = True                ,
-              selector    = lambda i,x,y : True ) :
+              selector    = lambda i,x,y : True ,
+              nthreads    = 1                   ) :
     """(Chi_2)-fit the histogram with the set of ``components''
     
     The ``components'' could be histograms, functions and other
@@ -77,6 +80,10 @@ def _h_Fit_ ( self                              ,
     >>> h0 = ...
     >>> h1 = ...
     >>> h .hFit ( [ h0 , h1 ] )
+
+    Large problems can be split between threads:
+    
+    >>> h .hFit ( [ h0 , h1 ] , nthreads = 4 )
     
     """
     DATA =   VE.Vector
@@ -111,7 +118,7 @@ def _h_Fit_ ( self                              ,
             cmps[ j ].push_back ( cp ) 
             
 
-    _c2Fit = Ostap.Math.Chi2Fit ( data , cmps )
+    _c2Fit = Ostap.Math.Chi2Fit ( data , cmps , nthreads )
 
     if draw :
         
@@ -133,6 +140,64 @@ def _h_Fit_ ( self                              ,
 ROOT.TH1F. hFit = _h_Fit_ 
 ROOT.TH1D. hFit = _h_Fit_ 
 
+# =============================================================================
+C2SOLVER = Ostap.Math.Chi2Solver 
+# =============================================================================
+## solve the linear least squares problems for many data vectors at once
+#  @code
+#  solver = C2SOLVER ( cmps , weights )
+#  params , chi2s = solver.solve_array ( data ) ## data: 2D-array nvectors x npoints  
+#  @endcode
+#  @param data  the sequence of data vectors (or 2D numpy array)
+#  @return parameters (per data vector) and chi2s (numpy arrays, if numpy is available) 
+#  @see Ostap::Math::Chi2Solver
+def _cs_solve_array_ ( solver , data ) :
+    """Solve the linear least squares problems for many data vectors at once
+    >>> solver = C2SOLVER ( cmps , weights )
+    >>> params , chi2s = solver.solve_array ( data ) ## data: 2D-array nvectors x npoints  
+    """
+    K , N = solver.size () , solver.points ()
+    try :
+        import numpy 
+        vs = numpy.ascontiguousarray ( data , dtype = float ).reshape ( -1 , N ) 
+        nv = vs.shape [ 0 ] 
+        rs = numpy.zeros ( ( nv , K ) , dtype = float )
+        cs = numpy.zeros (   nv       , dtype = float )
+    except ImportError :
+        vs = array ( 'd' )
+        for d in data :
+            assert len ( d ) == N , 'Invalid size of data vector!'
+            vs.extend ( d )
+        nv = len ( vs ) // N 
+        rs = array ( 'd' , nv * K * [ 0.0 ] )
+        cs = array ( 'd' , nv     * [ 0.0 ] )
+        
+    sc = solver.solve_many ( vs , nv , rs , cs )
+    if sc.isFailure () : logger.error ( 'Chi2Solver: failure in solve_many %s' % sc )
+    
+    if isinstance ( rs , array ) : rs = [ rs [ v * K : ( v + 1 ) * K ] for v in range ( nv ) ]
+    return rs , cs 
+
+C2SOLVER . solve_array = _cs_solve_array_
+C2SOLVER . __len__     = lambda s : s.size ()
+
+# =============================================================================
+_decorated_classes_ = (
+    C2FIT      ,
+    C2SOLVER   ,
+    ROOT.TH1F  , 
+    ROOT.TH1D  , 
+    )
+_new_methods_       = (
+    C2FIT    . Prob        , 
+    C2FIT    . __len__     , 
+    C2FIT    . __getitem__ , 
+    C2SOLVER . solve_array , 
+    C2SOLVER . __len__     , 
+    ROOT.TH1F . hFit       , 
+    ROOT.TH1D . hFit       , 
+    )
+
 # =============================================================================
 if '__main__' == __name__  :
     
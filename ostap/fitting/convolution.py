@@ -18,6 +18,7 @@ __all__     = (
     )
 # =============================================================================
 import ROOT, math
+from   ostap.core.core         import Ostap
 from   ostap.fitting.basic import PDF, Generic1D_pdf
 from   ostap.core.ostap_types    import num_types ,  integer_types 
 # =============================================================================
@@ -36,6 +37,10 @@ else                       : logger = getLogger ( __name__         )
 #  >>> cnv = Convolution ('CNV' , pdf , xvar  =  xvar , resolution = resolution )
 #  >>> cnv_pdf = cnv.pdf 
 #  @endcode
+#  - for <code>native=True</code> the Ostap::Models::FFTConvolution is used
+#    instead of <code>RooFFTConvPdf</code>: the Fourier images of the PDF and
+#    the resolution are cached separately and only the changed one is recalculated
+#  @see Ostap::Models::FFTConvolution
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
 #  @date 2014-07-13
 class Convolution(object):
@@ -48,6 +53,9 @@ class Convolution(object):
     >>> # resolution = ...                                       ## bare ROOT.RooAbsPdf
     >>> cnv = Convolution ('CNV' , pdf , xvar  =  xvar , resolution = resolution )
     >>> cnv_pdf = cnv.pdf 
+    - for `native=True` the Ostap::Models::FFTConvolution is used instead of RooFFTConvPdf:
+    the Fourier images of the PDF and the resolution are cached separately
+    and only the changed one is recalculated
     """
     def __init__ ( self              ,
                    name              ,
@@ -58,13 +66,15 @@ class Convolution(object):
                    nbins    = 10000  ,   ## number of bins for FFT
                    buffer   = 0.25   ,   ## buffer fraction use for setBufferFraction
                    bufstrat = None   ,   ## "Buffer strategy" : (0,1,2)
-                   nsigmas  = 6      ) : ## number of sigmas for setConvolutionWindow
+                   nsigmas  = 6      ,   ## number of sigmas for setConvolutionWindow
+                   native   = False  ) : ## use Ostap::Models::FFTConvolution ?
 
         ## the axis 
         assert isinstance ( xvar , ROOT.RooAbsReal ) , "``xvar'' must be ROOT.RooAbsReal"
         
         self.__xvar   = xvar
         self.__useFFT = True if useFFT else False
+        self.__native = True if native else False
 
         self.__arg_pdf        = pdf
         self.__arg_resolution = resolution
@@ -117,18 +127,31 @@ class Convolution(object):
                     self.__nbins  = nb       
                     logger.info('Convolution: choose #bins %d' % self.__nbins )
 
-            self.__xvar.setBins ( self.nbinsFFT , 'cache' )
-
-            self.__pdf = ROOT.RooFFTConvPdf (
-                PDF.roo_name ( 'fft_' ) ,
-                'FFT convolution: %s (*) %s' %  ( pdf.name , self.resolution.name ) ,
-                self.__xvar              ,
-                self.__old_pdf    .pdf   ,
-                self.__resolution .pdf   )            
-            self.__pdf.setBufferFraction ( self.buffer )
-            
-            if isinstance ( self.bufstrat , int ) and 0 <= self.bufstrat <= 2 : 
-                self.__pdf.setBufferStrategy ( self.bufstrat )
+            if self.native :
+                
+                self.__pdf = Ostap.Models.FFTConvolution (
+                    PDF.roo_name ( 'ostapfft_' ) ,
+                    'FFT convolution: %s (*) %s' %  ( pdf.name , self.resolution.name ) ,
+                    self.__xvar              ,
+                    self.__old_pdf    .pdf   ,
+                    self.__resolution .pdf   ,
+                    self.nbinsFFT            ,
+                    self.buffer              )
+                
+            else :
+                
+                self.__xvar.setBins ( self.nbinsFFT , 'cache' )
+                
+                self.__pdf = ROOT.RooFFTConvPdf (
+                    PDF.roo_name ( 'fft_' ) ,
+                    'FFT convolution: %s (*) %s' %  ( pdf.name , self.resolution.name ) ,
+                    self.__xvar              ,
+                    self.__old_pdf    .pdf   ,
+                    self.__resolution .pdf   )            
+                self.__pdf.setBufferFraction ( self.buffer )
+                
+                if isinstance ( self.bufstrat , int ) and 0 <= self.bufstrat <= 2 : 
+                    self.__pdf.setBufferStrategy ( self.bufstrat )
                 
         else :           ##  Use plain numerical integration (could be slow)
             
@@ -156,6 +179,10 @@ class Convolution(object):
         """``useFFT'' :    use Fast Fourier Transform?"""
         return self.__useFFT
     @property
+    def native  ( self ) :
+        """``native'' : use Ostap::Models::FFTConvolution instead of RooFFTConvPdf?"""
+        return self.__native
+    @property
     def resolution ( self  ) :
         """``resolution'': pdf for resolution function"""
         return self.__resolution 
@@ -217,6 +244,7 @@ class Convolution_pdf(PDF) :
                    buffer   = 0.25  ,   ## buffer fraction ## setBufferFraction
                    bufstrat = None  ,   ## "Buffer strategy" : (0,1,2)
                    nsigmas  = 6     ,   ## number of sigmas for setConvolutionWindow
+                   native   = False ,   ## use Ostap::Models::FFTConvolution?
                    name     = ''    ) : ## the name 
 
         self.__arg_pdf        = pdf
@@ -248,7 +276,8 @@ class Convolution_pdf(PDF) :
                                        nbins      = nbins            ,
                                        buffer     = buffer           ,
                                        bufstrat   = bufstrat         ,
-                                       nsigmas    = nsigmas          )
+                                       nsigmas    = nsigmas          ,
+                                       native     = native           )
 
         name = name if name else self.generate_name ( prefix = 'Cnv_%s@%s_' %  ( pdf.name , self.resolution.name ) ) 
                             
@@ -270,6 +299,7 @@ class Convolution_pdf(PDF) :
             'buffer'     : self.cnv.buffer     ,
             'bufstrat'   : self.cnv.bufstrat   ,
             'nsigmas'    : self.cnv.nsigmas    ,
+            'native'     : self.cnv.native     ,
             }
 
     @property
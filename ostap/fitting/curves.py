@@ -0,0 +1,297 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file  ostap/fitting/curves.py
+#  Fast rendering of the PDF curves:
+#  - the total PDF and all components are evaluated on the shared grid
+#    of the drawing variable in one C++ call
+#  - the normalization integrals are calculated once for the whole grid
+#    and reused for all components
+#  - the projections over other observables use the single integral object,
+#    therefore the analytical integrals are used, if provided
+#  - the normalized curves are cached, the key includes the current
+#    values of all parameters, therefore the repeated drawing of the
+#    same model with the same parameters does not require any evaluation
+#  @code
+#  model.draw ( dataset , fast_curves = True )
+#  model.draw ( dataset , fast_curves = True , curve_points = 1000 )
+#  print ( curves_stat () )
+#  @endcode
+#  The unsupported drawing options (e.g. <code>ProjectionRange</code>,
+#  <code>Normalization</code>, <code>VisualizeError</code>) switch to
+#  the standard <code>plotOn</code> for the given curve
+#  @see Ostap::Utils::PdfCurve
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Fast rendering of the PDF curves:
+- the total PDF and all components are evaluated on the shared grid
+  of the drawing variable in one C++ call
+- the normalization integrals are calculated once for the whole grid
+  and reused for all components
+- the projections over other observables use the single integral object,
+  therefore the analytical integrals are used, if provided
+- the normalized curves are cached, the key includes the current
+  values of all parameters, therefore the repeated drawing of the
+  same model with the same parameters does not require any evaluation
+
+>>> model.draw ( dataset , fast_curves = True )
+>>> model.draw ( dataset , fast_curves = True , curve_points = 1000 )
+>>> print ( curves_stat () )
+
+The unsupported drawing options (e.g. `ProjectionRange`, `Normalization`,
+`VisualizeError`) switch to the standard `plotOn` for the given curve
+- see Ostap::Utils::PdfCurve
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'CurvePlotter' , ## fast rendering of PDF curves at the frame
+    'curve_cache'  , ## the cache of normalized curves
+    'curves_stat'  , ## statistics of the cache
+    )
+# =============================================================================
+import ROOT
+from   ostap.core.core     import Ostap
+from   ostap.math.cache    import LRUCache
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.fitting.curves' )
+else                       : logger = getLogger ( __name__               )
+# =============================================================================
+## the cache of normalized curves
+curve_cache = LRUCache ( 1000 )
+# =============================================================================
+## the drawing options, supported by the fast rendering
+#  (other options are ignored)
+_ignored_options = ( 'Precision' , 'VLines' , 'Components' )
+# =============================================================================
+## parse the drawing options
+#  @return the dictionary of attributes or <code>None</code>
+#  if the options are not supported
+def _parse_options_ ( *options ) :
+    """Parse the drawing options
+    - return the dictionary of attributes or None if the options are not supported
+    """
+    from ostap.fitting.roocmdarg import flat_args
+
+    attrs = {}
+    for o in flat_args ( *options ) :
+        name = o.GetName ()
+        if   name in ( 'LineColor' , 'LineStyle' , 'LineWidth' ,
+                       'FillColor' , 'FillStyle' ) : attrs [ name ] = o.getInt ( 0 )
+        elif name in ( 'DrawOption' , 'Name' )     : attrs [ name ] = str ( o.getString ( 0 ) )
+        elif name in _ignored_options              :
+            if 'VLines' == name : attrs [ name ] = True
+        else                                       : return None
+
+    return attrs
+
+# =============================================================================
+## the key for the current state of the PDF parameters
+def _state_key_ ( pdf , observables ) :
+    """The key for the current state of the PDF parameters
+    """
+    state = []
+    for v in sorted ( pdf.getVariables () , key = lambda a : a.GetName () ) :
+        if observables.contains ( v ) : continue
+        if   isinstance ( v , ROOT.RooAbsCategory ) : state.append ( ( v.GetName () , v.getCurrentIndex () ) )
+        elif isinstance ( v , ROOT.RooAbsReal     ) : state.append ( ( v.GetName () , v.getVal          () ) )
+    return tuple ( state )
+
+# =============================================================================
+## @class CurvePlotter
+#  Fast rendering of the PDF curves at the frame:
+#  the requested curves are collected and evaluated on the shared grid
+#  in one go at <code>flush</code>
+#  @code
+#  frame   = xvar.frame ()
+#  dataset.plotOn ( frame )
+#  plotter = CurvePlotter ( frame , pdf , xvar , projected = [ yvar ] )
+#  plotter.add ( 'signal*' , ( ROOT.RooFit.LineColor ( 2 ) , ) )
+#  plotter.add ( ''        , ( ROOT.RooFit.LineWidth ( 3 ) , ) ) ## total
+#  plotter.flush ()
+#  @endcode
+#  @see Ostap::Utils::PdfCurve
+class CurvePlotter(object) :
+    """Fast rendering of the PDF curves at the frame:
+    the requested curves are collected and evaluated on the shared grid
+    in one go at `flush`
+    >>> frame   = xvar.frame ()
+    >>> dataset.plotOn ( frame )
+    >>> plotter = CurvePlotter ( frame , pdf , xvar , projected = [ yvar ] )
+    >>> plotter.add ( 'signal*' , ( ROOT.RooFit.LineColor ( 2 ) , ) )
+    >>> plotter.add ( ''        , ( ROOT.RooFit.LineWidth ( 3 ) , ) ) ## total
+    >>> plotter.flush ()
+    - see Ostap::Utils::PdfCurve
+    """
+    def __init__ ( self , frame , pdf , drawvar , projected = () , npoints = 500 ) :
+
+        assert isinstance ( npoints , int ) and 2 <= npoints , \
+               "Invalid ``npoints'' %s" % npoints
+
+        self.__frame     = frame
+        self.__pdf       = pdf
+        self.__drawvar   = drawvar
+        self.__projected = ROOT.RooArgSet ()
+        for v in projected :
+            if v is drawvar or v.GetName () == drawvar.GetName () : continue
+            if pdf.dependsOn ( v ) : self.__projected.add ( v )
+        self.__npoints   = npoints
+        self.__pending   = []
+        self.__curve     = None
+
+    @property
+    def frame     ( self ) :
+        """``frame'' : the frame"""
+        return self.__frame
+    @property
+    def pdf       ( self ) :
+        """``pdf'' : the PDF"""
+        return self.__pdf
+    @property
+    def drawvar   ( self ) :
+        """``drawvar'' : the drawing variable"""
+        return self.__drawvar
+    @property
+    def projected ( self ) :
+        """``projected'' : the observables to be projected out"""
+        return self.__projected
+    @property
+    def npoints   ( self ) :
+        """``npoints'' : number of grid points"""
+        return self.__npoints
+
+    # =========================================================================
+    ## add the curve to be drawn
+    #  @param components the components, the empty string is the total PDF
+    #  @param options    the drawing options
+    #  @return <code>False</code> if the options are not supported
+    def add ( self , components , options = () ) :
+        """Add the curve to be drawn
+        - components : the components, the empty string is the total PDF
+        - options    : the drawing options
+        - return False if the options are not supported
+        """
+        if isinstance ( options , ROOT.RooCmdArg ) : options = options ,
+        attrs = _parse_options_ ( *options )
+        if attrs is None : return False
+        self.__pending.append ( ( components , attrs ) )
+        return True
+
+    # =========================================================================
+    ## the key for the normalized curve
+    def __key ( self , components , state ) :
+        xmin , xmax = self.drawvar.getMin () , self.drawvar.getMax ()
+        return ( 'curve' , self.pdf.ClassName () , self.pdf.GetName () ,
+                 self.drawvar.GetName () , xmin , xmax , self.npoints ,
+                 tuple ( sorted ( v.GetName () for v in self.projected ) ) ,
+                 components , state )
+
+    # =========================================================================
+    ## the scale factor: number of events times the bin width
+    def __scale ( self ) :
+        nevents = self.frame.getFitRangeNEvt ()
+        if not nevents :
+            nevents = 1.0
+            if self.pdf.canBeExtended () :
+                normset = ROOT.RooArgSet ( self.drawvar )
+                normset.add ( self.projected )
+                nevents = self.pdf.expectedEvents ( normset )
+        binw = self.frame.getFitRangeBinW ()
+        return nevents * binw if 0 < binw else nevents
+
+    # =========================================================================
+    ## evaluate the pending curves on the shared grid and draw them
+    def flush ( self ) :
+        """Evaluate the pending curves on the shared grid and draw them
+        """
+        if not self.__pending : return
+
+        pending , self.__pending = self.__pending , []
+
+        observables = ROOT.RooArgSet ( self.drawvar )
+        observables.add ( self.projected )
+        state = _state_key_ ( self.pdf , observables )
+
+        ## look into the cache
+        values = {}
+        for components , _ in pending :
+            key = self.__key ( components , state )
+            found , value = curve_cache.lookup ( key )
+            if found : values [ components ] = value
+
+        ## evaluate missing curves on the shared grid
+        missing = []
+        for components , _ in pending :
+            if not components in values and not components in missing :
+                missing.append ( components )
+
+        if missing :
+            if self.__curve is None :
+                self.__curve = Ostap.Utils.PdfCurve ( self.pdf , self.drawvar , self.projected )
+            grid  = self.__curve.grid ( self.npoints )
+            cmps  = ROOT.std.vector('std::string') ()
+            for c in missing : cmps.push_back ( c )
+            ys    = self.__curve.curves ( grid , cmps )
+            xs    = tuple ( grid )
+            for c , y in zip ( missing , ys ) :
+                value = xs , tuple ( y )
+                values [ c ] = value
+                curve_cache.insert ( self.__key ( c , state ) , value )
+
+        ## draw the curves
+        scale = self.__scale ()
+        for components , attrs in pending :
+            xs , ys = values [ components ]
+            self.__draw ( components , attrs , xs , ys , scale )
+
+    # =========================================================================
+    ## create the curve and add it to the frame
+    def __draw ( self , components , attrs , xs , ys , scale ) :
+
+        opt   = attrs.get ( 'DrawOption' , 'L' )
+        fill  = 'F' in opt.upper () or attrs.get ( 'VLines' , False )
+
+        name  = '%s_Norm[%s]' % ( self.pdf.GetName () , self.drawvar.GetName () )
+        if components : name += '_Comp[%s]' % components
+        name  = attrs.get ( 'Name' , name )
+
+        curve = ROOT.RooCurve ()
+        curve.SetName  ( name )
+        curve.SetTitle ( self.pdf.GetTitle () )
+        if fill : curve.addPoint ( xs [  0 ] , 0.0 )
+        for x , y in zip ( xs , ys ) : curve.addPoint ( x , y * scale )
+        if fill : curve.addPoint ( xs [ -1 ] , 0.0 )
+
+        ## default RooFit attributes
+        curve.SetLineColor ( attrs.get ( 'LineColor' , ROOT.kBlue ) )
+        curve.SetLineStyle ( attrs.get ( 'LineStyle' , 1          ) )
+        curve.SetLineWidth ( attrs.get ( 'LineWidth' , 3          ) )
+        curve.SetFillColor ( attrs.get ( 'FillColor' , 0          ) )
+        curve.SetFillStyle ( attrs.get ( 'FillStyle' , 0          ) )
+
+        ROOT.SetOwnership ( curve , False )
+        self.frame.addPlotable ( curve , opt )
+        return curve
+
+# =============================================================================
+## statistics of the cache of curves
+#  @code
+#  print ( 'hits/misses: %(hits)d/%(misses)d' % curves_stat () )
+#  @endcode
+def curves_stat ( reset = False ) :
+    """Statistics of the cache of curves
+    >>> print ( 'hits/misses: %(hits)d/%(misses)d' % curves_stat () )
+    """
+    return curve_cache.stat ( reset = reset )
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
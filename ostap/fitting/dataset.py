@@ -22,6 +22,11 @@ __all__     = (
     'ds_draw'    , ## draw varibales from RooDataSet 
     'ds_project' , ## project variables from RooDataSet to histogram
     'ds_combine' , ## combine two datasets with weights 
+    'ds_to_columns'   , ## columnar snapshot of the dataset 
+    'ds_from_columns' , ## load the dataset from the columnar snapshot 
+    'ds_concatenate'  , ## one-shot concatenation of the partial datasets 
+    'ds_chunks'       , ## chunked view of the partial datasets 
+    'WeightView'      , ## weighted view of the dataset (bootstrap/jackknife without copies) 
     )
 # =============================================================================
 import ROOT, random, math, sys, ctypes  
@@ -1053,6 +1058,11 @@ def _ds_print_ ( dataset ) :
 ROOT.RooDataSet.draw        = ds_draw
 ROOT.RooDataSet.project     = ds_project
 ROOT.RooDataSet.__getattr__ = _ds_getattr_
+
+from ostap.trees.trees import _project_many_ , _bin_stat_ , _bin_replicas_ 
+ROOT.RooAbsData.project_many = _project_many_ 
+ROOT.RooAbsData.bin_stat     = _bin_stat_ 
+ROOT.RooAbsData.bin_replicas = _bin_replicas_ 
 ROOT.RooAbsData.sFactor     = _rad_sFactor_
 
 
@@ -1066,6 +1076,9 @@ for d in ( ROOT.RooAbsData  ,
 _new_methods_ += [
     ROOT.RooDataSet .draw         ,
     ROOT.RooDataSet .project      ,
+    ROOT.RooAbsData .project_many ,
+    ROOT.RooAbsData .bin_stat     ,
+    ROOT.RooAbsData .bin_replicas ,
     ROOT.RooDataSet .__getattr__  ,
     ROOT.RooDataHist.__getattr__  ,
     ROOT.RooDataHist.__len__      ,
@@ -1247,8 +1260,9 @@ def add_reweighting ( data , weighter , name = 'weight' ) :
     
     assert isinstance ( weighter , W.Weight ), "Invalid type of ``weighting''!"
     
-    ## create the weigthting function 
-    wfun = W.W2Data ( weighter  )
+    ## create the weigthting function: use the native C++ reweighter, if possible  
+    rw   = weighter.reweighter
+    wfun = Ostap.Functions.FuncReweight ( rw ) if rw else W.W2Data ( weighter  )
     
     return data.add_new_var ( name , wfun ) 
 
@@ -1328,11 +1342,49 @@ def _rds_unWeighted_ ( dataset , weight = '' ) :
     return ds , w 
 
 # =============================================================================
-ROOT.RooDataSet.unWeighted = _rds_unWeighted_
+## Accept/reject (``hit-or-miss'') unweighting of the weighted dataset:
+#  the entry with weight <code>w</code> is accepted with the probability
+#  <code>w/wmax</code>
+#  @code
+#  wdata = ...
+#  data  = wdata.accept_reject ( seed = 12345 , nthreads = 8 ) 
+#  @endcode
+#  - the result is reproducible and does not depend on number of threads 
+#  - entries with negative weights are rejected 
+#  @param seed     the seed for the counter-based random streams 
+#  @param nthreads number of threads 
+#  @param wmax     the maximal weight (if not specified, it is taken from the data)
+#  @see Ostap::Utils::accept_reject
+def _rds_accept_reject_ ( dataset , seed = 0 , nthreads = 1 , wmax = None , name = '' ) :
+    """Accept/reject (``hit-or-miss'') unweighting of the weighted dataset:
+    the entry with weight `w` is accepted with the probability `w/wmax`
+    >>> wdata = ...
+    >>> data  = wdata.accept_reject ( seed = 12345 , nthreads = 8 ) 
+    - the result is reproducible and does not depend on number of threads 
+    - entries with negative weights are rejected 
+    - see Ostap.Utils.accept_reject
+    """
+    if not dataset.isWeighted() :
+        logger.error ("accept_reject: dataset is not weighted!") 
+        return dataset
+    
+    ds   = ROOT.RooDataSet ( name if name else dsID () , dataset.GetTitle () , dataset.get () )
+    stat = Ostap.Utils.accept_reject ( dataset , ds , seed , nthreads , wmax if wmax else -1 ) 
+    
+    if stat.negative : logger.warning ( 'accept_reject: %d entries with negative weights are rejected'    % stat.negative )
+    if stat.overflow : logger.warning ( 'accept_reject: %d entries with weights above wmax=%g are biased' % ( stat.overflow , stat.wmax ) )
+    logger.debug ( 'accept_reject: %d/%d entries are accepted, wmax=%g' % ( stat.accepted , stat.total , stat.wmax ) )
+    
+    return ds 
+
+# =============================================================================
+ROOT.RooDataSet.unWeighted    = _rds_unWeighted_
+ROOT.RooDataSet.accept_reject = _rds_accept_reject_
 
 _new_methods_ += [
     ROOT.RooDataSet .makeWeighted ,
     ROOT.RooDataSet .unWeighted   ,
+    ROOT.RooDataSet .accept_reject ,
     ]
 # =============================================================================
 
@@ -2296,6 +2348,449 @@ _new_methods_ += [
     ROOT.RooAbsData.slice 
     ]
 
+# =============================================================================
+## Columnar snapshot of the dataset
+#  The snapshot is a directory with 
+#  - <code>columns.npy</code> : 2D-array (variables x entries), each variable is contiguous 
+#  - <code>weights.npy</code> : array of weights (for weighted datasets)
+#  - <code>meta.json</code>   : the description of the variables 
+#  The arrays are memory-mappable, and reload via ds_from_columns 
+#  reads them without additional copies 
+#  @code
+#  data = ...
+#  data.to_columns ( 'snapshot' )
+#  data.to_columns ( 'snapshot' , variables = ( 'a' , 'b' ) , cuts = 'a>0' )
+#  ...
+#  data = ds_from_columns ( 'snapshot' ) 
+#  @endcode
+#  @see ds_from_columns 
+#  @param dataset   the dataset 
+#  @param dirname   the snapshot directory 
+#  @param variables variables to be stored (RooRealVar), all by default
+#  @param cuts      selection criteria 
+#  @param cut_range cut range 
+#  @return number of stored entries 
+def ds_to_columns ( dataset , dirname , variables = () , cuts = '' , cut_range = '' , *args ) :
+    """Columnar snapshot of the dataset
+    The snapshot is a directory with 
+    - `columns.npy` : 2D-array (variables x entries), each variable is contiguous 
+    - `weights.npy` : array of weights (for weighted datasets)
+    - `meta.json`   : the description of the variables 
+    The arrays are memory-mappable, and reload via ds_from_columns 
+    reads them without additional copies
+    >>> data = ...
+    >>> data.to_columns ( 'snapshot' )
+    >>> data.to_columns ( 'snapshot' , variables = ( 'a' , 'b' ) , cuts = 'a>0' )
+    ...
+    >>> data = ds_from_columns ( 'snapshot' ) 
+    """
+    import os, json, numpy
+    from numpy.lib.format import open_memmap
+    
+    wname = _ds_wname_ ( dataset )
+    if isinstance ( variables , string_types ) : variables = split_string ( variables , ' ,;:' )
+    if not variables :
+        variables = [ v.GetName() for v in dataset.get() if isinstance ( v , ROOT.RooRealVar ) and v.GetName() != wname ]
+
+    vset  = dataset.get()
+    vars  = []
+    for name in variables :
+        v = vset.find ( name ) 
+        assert v and isinstance ( v , ROOT.RooRealVar ) , \
+               "to_columns: `%s' is not RooRealVar from dataset!" % name 
+        vars.append ( v )
+        
+    names = strings ( [ v.GetName() for v in vars ] )
+    tab   = Ostap.StatVar.Table  ()
+    col   = Ostap.StatVar.Column ()
+    n     = Ostap.StatVar.get_table ( dataset , names , cuts , tab , col , cut_range , *args )
+
+    if not os.path.exists ( dirname ) : os.makedirs ( dirname )
+    
+    ## each variable is copied directly into the (memory-mapped) output file
+    ## (note: empty file can't be memory-mapped)
+    save    = open_memmap if n else lambda f , mode , dtype , shape : numpy.zeros ( shape , dtype = dtype ) 
+    columns = save ( os.path.join ( dirname , 'columns.npy' ) , mode = 'w+' ,
+                            dtype = numpy.float64 , shape = ( len ( vars ) , n ) )
+    for i , column in enumerate ( tab ) :
+        if n : columns [ i , : ] = numpy.frombuffer ( column.begin().__follow__() , count = n )
+        column.clear()
+    if n : columns.flush()
+    else : numpy.save ( os.path.join ( dirname , 'columns.npy' ) , columns )
+    del columns , tab 
+    
+    weighted = dataset.isWeighted()
+    if weighted :
+        weights = save ( os.path.join ( dirname , 'weights.npy' ) , mode = 'w+' ,
+                                dtype = numpy.float64 , shape = ( n , ) )
+        if n : weights [ : ] = numpy.frombuffer ( col.begin().__follow__() , count = n )
+        if n : weights.flush()
+        else : numpy.save ( os.path.join ( dirname , 'weights.npy' ) , weights )
+        del weights 
+    col.clear()
+    del col 
+
+    meta = { 'version'   : 1                  ,
+             'name'      : dataset.GetName  () ,
+             'title'     : dataset.GetTitle () ,
+             'entries'   : n                  ,
+             'weight'    : wname if weighted else '' , 
+             'variables' : [ { 'name'  : v.GetName  () ,
+                               'title' : v.GetTitle () ,
+                               'min'   : v.getMin   () ,
+                               'max'   : v.getMax   () ,
+                               'unit'  : v.getUnit  () } for v in vars ] }
+    with open ( os.path.join ( dirname , 'meta.json' ) , 'w' ) as f :
+        json.dump ( meta , f , indent = 1 )
+
+    logger.debug ( "Columnar snapshot of `%s' (%d entries, %d variables) is written to `%s'" % (
+        dataset.GetName() , n , len ( vars ) , dirname ) )
+    return n
+
+# =============================================================================
+## Load the dataset from the columnar snapshot
+#  The arrays are memory-mapped and the dataset (with <code>RooVectorDataStore</code>)
+#  is filled directly from them in C++ 
+#  @code
+#  data = ds_from_columns ( 'snapshot' ) 
+#  data = ds_from_columns ( 'snapshot' , variables = ( 'a' , 'b' ) ) 
+#  @endcode
+#  @see ds_to_columns
+#  @see Ostap::Utils::fill_dataset
+#  @param dirname   the snapshot directory 
+#  @param name      the name of new dataset 
+#  @param variables variables to be loaded, all by default
+#  @return the dataset 
+def ds_from_columns ( dirname , name = '' , title = '' , variables = () ) :
+    """Load the dataset from the columnar snapshot
+    The arrays are memory-mapped and the dataset (with RooVectorDataStore)
+    is filled directly from them in C++ 
+    >>> data = ds_from_columns ( 'snapshot' ) 
+    >>> data = ds_from_columns ( 'snapshot' , variables = ( 'a' , 'b' ) ) 
+    - see ds_to_columns
+    - see Ostap.Utils.fill_dataset
+    """
+    import os, json, numpy
+    
+    with open ( os.path.join ( dirname , 'meta.json' ) , 'r' ) as f :
+        meta = json.load ( f )
+
+    ## memory-mapping: no real reading here (empty arrays can't be mapped)
+    n       = meta [ 'entries' ]
+    mmap    = 'r' if n else None 
+    columns = numpy.load ( os.path.join ( dirname , 'columns.npy' ) , mmap_mode = mmap )
+
+    descr   = meta [ 'variables' ]
+    known   = [ d [ 'name' ] for d in descr ]
+    if isinstance ( variables , string_types ) : variables = split_string ( variables , ' ,;:' )
+    if variables :
+        for v in variables :
+            assert v in known , "from_columns: unknown variable `%s'" % v 
+        index   = [ known.index ( v ) for v in variables ]
+        descr   = [ descr [ i ] for i in index ]
+        ## contiguous subset of columns
+        columns = columns [ index , : ] if index != list ( range ( len ( known ) ) ) else columns
+
+    vlist = ROOT.RooArgList ()
+    vset  = ROOT.RooArgSet  ()
+    vars  = []
+    for d in descr :
+        v = ROOT.RooRealVar ( d [ 'name' ] , d [ 'title' ] , d [ 'min' ] , d [ 'max' ] )
+        if d [ 'unit' ] : v.setUnit ( d [ 'unit' ] )
+        vars.append ( v )
+        vlist.add   ( v ) 
+        vset .add   ( v )
+
+    name    = name  if name  else dsID ()
+    title   = title if title else meta [ 'title' ] 
+    weights = None 
+    wname   = meta [ 'weight' ] 
+    with useStorage ( RAD.Vector ) :
+        if wname :
+            weights = numpy.load ( os.path.join ( dirname , 'weights.npy' ) , mmap_mode = mmap )
+            wvar    = ROOT.RooRealVar ( wname , 'weight variable' , 1.0 )
+            vars.append ( wvar )
+            vset.add    ( wvar )
+            dataset = ROOT.RooDataSet ( name , title , vset , ROOT.RooFit.WeightVar ( wname ) )
+        else : 
+            dataset = ROOT.RooDataSet ( name , title , vset )
+
+    if n :
+        Ostap.Utils.fill_dataset ( dataset , vlist , n ,
+                                   numpy.ascontiguousarray ( columns ) ,
+                                   numpy.ascontiguousarray ( weights ) if wname else ROOT.nullptr )
+        
+    logger.debug ( "Dataset `%s' (%d entries) is loaded from columnar snapshot `%s'" % ( name , n , dirname ) )
+    return dataset 
+
+ROOT.RooAbsData.to_columns = ds_to_columns
+
+_new_methods_ += [
+    ROOT.RooAbsData.to_columns 
+    ]
+
+# =============================================================================
+## One-shot concatenation of the (partial) datasets
+#  The final store is preallocated exactly, the partial datasets are
+#  copied once, in contrast to the sequential <code>append</code>
+#  that reallocates the growing store for each partial dataset 
+#  @code
+#  partial = [ ds1 , ds2 , ds3 ]
+#  data    = ds_concatenate ( partial ) 
+#  data    = ds_concatenate ( partial , name = 'data' , title = 'All data' ) 
+#  @endcode
+#  @see Ostap::Utils::concatenate
+#  @see Ostap::Utils::DataChunks
+#  @param datasets the partial datasets (the same variables) 
+#  @param name     the name of new dataset 
+#  @param title    the title of new dataset 
+#  @return the new dataset 
+def ds_concatenate ( datasets , name = '' , title = '' ) :
+    """One-shot concatenation of the (partial) datasets
+    The final store is preallocated exactly, the partial datasets are
+    copied once, in contrast to the sequential `append`
+    that reallocates the growing store for each partial dataset 
+    >>> partial = [ ds1 , ds2 , ds3 ]
+    >>> data    = ds_concatenate ( partial ) 
+    >>> data    = ds_concatenate ( partial , name = 'data' , title = 'All data' ) 
+    - see Ostap.Utils.concatenate
+    - see Ostap.Utils.DataChunks
+    """
+    datasets = [ ds for ds in datasets if not ds is None ] 
+    assert datasets , 'ds_concatenate: no datasets to concatenate'
+
+    chunks = ROOT.std.vector ( 'const RooAbsData*' ) ()
+    chunks.reserve ( len ( datasets ) )
+    for ds in datasets : chunks.push_back ( ds )
+
+    name   = name  if name  else dsID ()
+    title  = title if title else datasets [ 0 ].GetTitle ()
+    result = Ostap.Utils.concatenate ( chunks , name , title )
+    ROOT.SetOwnership ( result , True )
+    return result
+
+# =============================================================================
+## Chunked "view" of the (partial) datasets: the unified index and the
+#  column spans without copying the data
+#  @code
+#  view = ds_chunks ( [ ds1 , ds2 , ds3 ] )
+#  row  = view.get ( 12345 )
+#  w    = view.weight ()
+#  data = view.concatenate ( 'data' )
+#  @endcode
+#  @attention the partial datasets must outlive the view 
+#  @see Ostap::Utils::DataChunks
+def ds_chunks ( datasets ) :
+    """Chunked ``view'' of the (partial) datasets: the unified index and the
+    column spans without copying the data
+    >>> view = ds_chunks ( [ ds1 , ds2 , ds3 ] )
+    >>> row  = view.get ( 12345 )
+    >>> w    = view.weight ()
+    >>> data = view.concatenate ( 'data' )
+    - attention: the partial datasets must outlive the view 
+    - see Ostap.Utils.DataChunks
+    """
+    view = Ostap.Utils.DataChunks ()
+    for ds in datasets :
+        if not ds is None : view.add ( ds )
+    ## keep the partial datasets alive
+    view._chunks = tuple ( datasets ) 
+    return view
+
+# =============================================================================
+## @class WeightView
+#  Weighted "view" of the dataset: the per-event weights (multiplicities) 
+#  are attached to the original data store as the external weight array,
+#  no copies of the data are made
+#  - Poisson bootstrap: each event gets the multiplicity from Poisson(1)
+#  - jackknife: one event is masked with zero weight 
+#  @code
+#  dataset = ...
+#  with WeightView ( dataset ) as view :
+#     view.poisson ()    ## the bootstrap replica 
+#     ... fit dataset ...
+#     view.mask ( 10 )   ## the jackknife sample without event #10 
+#     ... fit dataset ...
+#  @endcode
+#  @attention the weights are seen only by the objects that use the 
+#  original data store, e.g. NLL with <code>CloneData(False)</code>
+#  @see RooAbsDataStore::setExternalWeightArray
+class WeightView(object) :
+    """Weighted ``view'' of the dataset: the per-event weights (multiplicities) 
+    are attached to the original data store as the external weight array,
+    no copies of the data are made
+    - Poisson bootstrap: each event gets the multiplicity from Poisson(1)
+    - jackknife: one event is masked with zero weight 
+    >>> dataset = ...
+    >>> with WeightView ( dataset ) as view :
+    ...    view.poisson ()    ## the bootstrap replica 
+    ...    ... fit dataset ...
+    ...    view.mask ( 10 )   ## the jackknife sample without event #10 
+    ...    ... fit dataset ...
+    - attention: the weights are seen only by the objects that use the 
+    original data store, e.g. NLL with `CloneData(False)`
+    - see RooAbsDataStore.setExternalWeightArray
+    """
+    def __init__ ( self , dataset ) :
+        
+        import numpy
+        
+        self.__dataset = dataset
+        self.__store   = dataset.store ()
+        
+        N = len ( dataset ) 
+        ## original weights (if any)
+        if dataset.isWeighted () :
+            base = numpy.empty ( N , dtype = float )
+            for i in range ( N ) :
+                dataset.get ( i )
+                base [ i ] = dataset.weight () 
+        else :
+            base = None
+            
+        self.__base    = base 
+        self.__weights = numpy.ones ( N , dtype = float ) if base is None else base.copy () 
+        self.__errors  = numpy.sqrt ( numpy.abs ( self.__weights ) ) 
+        self.__sumw2   = self.__weights * self.__weights 
+        self.__masked  = -1 
+        self.__attached = False  
+        ## own generator, seeded from the (parallel-aware) python generator 
+        self.__rng     = numpy.random.RandomState ( random.getrandbits ( 32 ) )
+
+    ## attach the weights to the data store 
+    def attach ( self ) :
+        """Attach the weights to the data store"""
+        if not self.__attached : 
+            self.__store.setExternalWeightArray ( self.__weights , self.__errors , self.__errors , self.__sumw2 )
+            self.__attached = True 
+        return self
+    
+    ## detach the weights from the data store 
+    def detach ( self ) :
+        """Detach the weights from the data store"""
+        if self.__attached : 
+            self.__store.setExternalWeightArray ( ROOT.nullptr , ROOT.nullptr , ROOT.nullptr , ROOT.nullptr )
+            self.__attached = False 
+
+    def __enter__ ( self      ) : return self.attach () 
+    def __exit__  ( self , *_ ) : self.detach () 
+    
+    ## update the derived arrays (in place: the addresses are kept) 
+    def __update ( self ) :
+        import numpy
+        numpy.sqrt     ( numpy.abs ( self.__weights ) , out = self.__errors )
+        numpy.multiply ( self.__weights , self.__weights , out = self.__sumw2 )
+        self.__masked = -1 
+        
+    ## set the multiplicities of events  
+    def set_weights ( self , multiplicities ) :
+        """Set the multiplicities of events"""
+        self.__weights [ : ] = multiplicities
+        if not self.__base is None : self.__weights *= self.__base 
+        self.__update ()
+        
+    ## Poisson bootstrap replica: multiplicities are Poisson(1)
+    def poisson ( self ) :
+        """Poisson bootstrap replica: multiplicities are Poisson(1)"""
+        self.set_weights ( self.__rng.poisson ( 1.0 , len ( self.__weights ) ) )
+        
+    ## (non-Poisson) bootstrap replica: N events, sampled with replacement  
+    def bootstrap ( self ) :
+        """(Non-Poisson) bootstrap replica: N events, sampled with replacement"""
+        import numpy
+        N = len ( self.__weights ) 
+        self.set_weights ( numpy.bincount ( self.__rng.randint ( 0 , N , N ) , minlength = N ) )
+        
+    ## jackknife sample: the event <code>index</code> is masked 
+    def mask ( self , index ) :
+        """Jackknife sample: the event `index` is masked"""
+        N = len ( self.__weights )
+        if index < 0 : index += N 
+        assert 0 <= index < N , 'WeightView: invalid index %s' % index
+        if self.__masked < 0 :
+            self.reset () 
+        else : ## restore only one masked event 
+            j = self.__masked 
+            w = 1.0 if self.__base is None else self.__base [ j ]
+            self.__weights [ j ] = w 
+            self.__errors  [ j ] = abs ( w ) ** 0.5 
+            self.__sumw2   [ j ] = w * w 
+        self.__weights [ index ] = 0
+        self.__errors  [ index ] = 0
+        self.__sumw2   [ index ] = 0
+        self.__masked = index
+        
+    ## reset all multiplicities to 1 
+    def reset ( self ) :
+        """Reset all multiplicities to 1"""
+        self.set_weights ( 1.0 ) 
+
+    @property
+    def dataset ( self ) :
+        """``dataset'' : the underlying dataset"""
+        return self.__dataset
+    @property
+    def weights ( self ) :
+        """``weights'' : the current weights (in-place numpy array)"""
+        return self.__weights 
+    
+# =============================================================================
+## Jackknife generator over the weighted view of the dataset:
+#  the same dataset is yielded with one event masked 
+#  @code
+#  dataset = ...
+#  for ds in ds.jackknife_view() :
+#  ...
+#  @endcode
+#  @see WeightView 
+def _rds_jackknife_view_ ( dataset , low = 0 , high = None ) :
+    """Jackknife generator over the weighted view of the dataset:
+    the same dataset is yielded with one event masked 
+    >>> dataset = ...
+    >>> for ds in ds.jackknife_view() :
+    >>> ...
+    - see WeightView 
+    """
+    N = len ( dataset )
+    if high == None : high = N
+    if 1 < N : 
+        with WeightView ( dataset ) as view :
+            for i in range ( low , high ) :
+                view.mask ( i ) 
+                yield dataset 
+
+# =============================================================================
+## Bootstrap generator over the weighted view of the dataset:
+#  the same dataset is yielded with (Poisson) multiplicities of events 
+#  @code
+#  dataset = ...
+#  for ds in dataset.bootstrap_view ( 100 ) :
+#  ...
+#  @endcode
+#  @see WeightView 
+def _rds_bootstrap_view_ ( dataset , size = 100 , poisson = True ) :
+    """Bootstrap generator over the weighted view of the dataset:
+    the same dataset is yielded with (Poisson) multiplicities of events 
+    >>> dataset = ...
+    >>> for ds in dataset.bootstrap_view ( 100 ) :
+    >>> ...
+    - see WeightView 
+    """
+    with WeightView ( dataset ) as view :
+        for i in range ( size ) :
+            if poisson : view.poisson   ()
+            else       : view.bootstrap ()
+            yield dataset 
+
+ROOT.RooDataSet . jackknife_view = _rds_jackknife_view_
+ROOT.RooDataSet . bootstrap_view = _rds_bootstrap_view_
+
+_new_methods_ += [
+    ROOT.RooDataSet . jackknife_view ,
+    ROOT.RooDataSet . bootstrap_view ,
+    ]
+
+
 # =============================================================================
 ## Combine two datasets with some weights
 #  @code
@@ -16,6 +16,7 @@ __all__     = (
     'Efficiency1D', ## helper utility to get the efficiency (1D-case)
     'Efficiency2D', ## helper utility to get the efficiency (2D-case)
     'Efficiency3D', ## helper utility to get the efficiency (3D-case)
+    'efficiency_fit' , ## fast unbinned fit of 2D/3D polynomial/spline efficiency 
     )
 # =============================================================================
 import ROOT
@@ -809,6 +810,67 @@ class Efficiency3D (Efficiency) :
         logger.error ('Invalid efficiency, return -1 ') 
         return -1 
                         
+# =============================================================================
+## Fast unbinned fit of the 2D/3D efficiency, parameterised as
+#  <code>Ostap::Math::Bernstein2D</code>, <code>Ostap::Math::Bernstein3D</code>
+#  or <code>Ostap::Math::BSpline2D</code>
+#  - the basis functions are calculated once for all events,
+#    the likelihood and its analytic gradient are evaluated in parallel
+#  - the parameters of the shape are updated in place 
+#  @code
+#  shape = Ostap.Math.Bernstein2D ( 3 , 3 , 0 , 10 , 0 , 10 )
+#  dataset = ...  
+#  fit = efficiency_fit ( dataset , shape , ( 'x' , 'y' ) , 'acc==acc::accept' )
+#  print ( shape ( 5 , 5 ) )
+#  @endcode
+#  @param dataset   the dataset 
+#  @param shape     the shape: Bernstein2D, Bernstein3D or BSpline2D 
+#  @param variables the variables 
+#  @param accept    the expression for the accept flag (non-zero for accepted events)
+#  @param cuts      the selection 
+#  @param nthreads  number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+#  @return the fit object <code>Ostap::Math::EfficiencyFit</code>
+#  @see Ostap::Math::EfficiencyFit
+#  @attention for weighted datasets the uncertainties are not corrected 
+def efficiency_fit ( dataset , shape , variables , accept , cuts = '' , nthreads = 0 ) :
+    """ Fast unbinned fit of the 2D/3D efficiency, parameterised as
+    `Ostap.Math.Bernstein2D`, `Ostap.Math.Bernstein3D` or `Ostap.Math.BSpline2D`
+    - the basis functions are calculated once for all events,
+      the likelihood and its analytic gradient are evaluated in parallel
+    - the parameters of the shape are updated in place 
+    >>> shape = Ostap.Math.Bernstein2D ( 3 , 3 , 0 , 10 , 0 , 10 )
+    >>> dataset = ...  
+    >>> fit = efficiency_fit ( dataset , shape , ( 'x' , 'y' ) , 'acc==acc::accept' )
+    >>> print ( shape ( 5 , 5 ) )
+    - attention: for weighted datasets the uncertainties are not corrected 
+    """
+    from ostap.core.core import strings
+    
+    if   isinstance ( accept , ROOT.RooCategory ) :
+        accept = '%s==%s::accept' % ( accept.GetName() , accept.GetName() )
+    elif isinstance ( accept , ROOT.RooAbsArg   ) :
+        accept = accept.GetName() 
+        
+    names = [ v.GetName() if isinstance ( v , ROOT.RooAbsArg ) else str ( v ) for v in variables ]
+    
+    dim = 3 if isinstance ( shape , Ostap.Math.Bernstein3D ) else 2
+    assert len ( names ) == dim , 'efficiency_fit: invalid number of variables %s' % len ( names ) 
+    
+    tab = Ostap.StatVar.Table  ()
+    col = Ostap.StatVar.Column ()
+    n   = Ostap.StatVar.get_table ( dataset , strings ( names + [ accept ] ) , cuts , tab , col )
+    assert 0 < n , 'efficiency_fit: no events are selected!'
+    
+    args = list ( tab ) + [ col , nthreads ] 
+    fit  = Ostap.Math.EfficiencyFit ( shape , *args )
+    
+    status = fit.fit () 
+    if 0 != status : logger.warning ( 'efficiency_fit: fit status is %s' % status )
+    
+    for k , p in enumerate ( fit.pars () ) : shape.setPar ( k , p )
+    
+    return fit 
+
 # =============================================================================
 if '__main__' == __name__ :
     
@@ -571,7 +571,7 @@ class PDF2 (PDF,FUNC2) :
         ## use numerical integration 
         from ostap.math.integral import integral2 as _integral2
 
-        extended =  self.pdf.canBeExtended() or isinstance ( self.pdf , ROOT.RooAddPdf )
+        extended =  self.pdf.canBeExtended() or isinstance ( self.pdf , ( ROOT.RooAddPdf , Ostap.MoreRooFit.AddPdf ) )
 
         if   todo and extended : value   = _integral2 ( self , xmin , xmax , ymin , ymax )
         elif todo  :
@@ -1483,6 +1483,7 @@ class H2D_pdf(H2D_dset,PDF2) :
 #  @param  xvar      the x-variable
 #  @param  yvar      the y-variable
 #  @param  name      the name of PDF 
+#  @param  cached    cache the values of components (Ostap::MoreRooFit::AddPdf)
 #  @code
 #  model   = Models.Fit2D (
 #      signal_1 = Models.Gauss_pdf ( 'Gx' , m_x.getMin () , m_x.getMax () , mass = m_x ) ,
@@ -1566,7 +1567,8 @@ class Fit2D (PDF2) :
                    components = []    ,
                    xvar       = None  ,
                    yvar       = None  ,                   
-                   name       = ''    ) :
+                   name       = ''    ,
+                   cached     = False ) : ## cache the component values? (Ostap::MoreRooFit::AddPdf)
         
         ## collect all the arguments 
         self.__args = {
@@ -1750,7 +1752,8 @@ class Fit2D (PDF2) :
         pdfname  = self.roo_name ( 'fit2d_' ) 
         pdftitle = "Fit2D %s" % self.name
         pdfargs  = pdfname , pdftitle , self.alist1 , self.alist2
-        self.pdf = ROOT.RooAddPdf  ( *pdfargs )
+        if cached : self.pdf = Ostap.MoreRooFit.AddPdf ( *pdfargs )
+        else      : self.pdf = ROOT.RooAddPdf          ( *pdfargs )
 
         self.signals     .add ( self.__ss_cmp.pdf )
         self.backgrounds .add ( self.__bb_cmp.pdf )
@@ -1775,7 +1778,8 @@ class Fit2D (PDF2) :
             'components' : self.more_components ,
             'xvar'       : self.xvar            , 
             'yvar'       : self.yvar            , 
-            'name'       : self.name    
+            'name'       : self.name            ,
+            'cached'     : cached               , 
             }
         
         self.checked_keys.add  ( 'xvar' )
@@ -2025,7 +2029,8 @@ class Fit2DSym (PDF2) :
                    components = []    ,
                    xvar       = None  ,
                    yvar       = None  ,                   
-                   name       = ''    ) :
+                   name       = ''    ,
+                   cached     = False ) : ## cache the component values? (Ostap::MoreRooFit::AddPdf)
         
         ## collect all the arguments 
         self.__args = {
@@ -2213,7 +2218,8 @@ class Fit2DSym (PDF2) :
         pdfname  = self.roo_name ( 'fit2ds_' ) 
         pdftitle = "Fit2Dsym %s" % self.name
         pdfargs  = pdfname , pdftitle , self.alist1 , self.alist2
-        self.pdf = ROOT.RooAddPdf  ( *pdfargs )
+        if cached : self.pdf = Ostap.MoreRooFit.AddPdf ( *pdfargs )
+        else      : self.pdf = ROOT.RooAddPdf          ( *pdfargs )
 
 
         self.signals     .add ( self.__ss_cmp.pdf )
@@ -2237,6 +2243,7 @@ class Fit2DSym (PDF2) :
             'xvar'       : self.xvar            , 
             'yvar'       : self.yvar            , 
             'name'       : self.name            ,
+            'cached'     : cached               , 
             }
 
         self.checked_keys.add ( 'xvar' )
@@ -618,7 +618,7 @@ class PDF3 (PDF2,FUNC3) :
         ## for numerical integration 
         from ostap.math.integral import integral3 as _integral3
         
-        extended = self.pdf.canBeExtended() or isinstance ( self.pdf , ROOT.RooAddPdf )
+        extended = self.pdf.canBeExtended() or isinstance ( self.pdf , ( ROOT.RooAddPdf , Ostap.MoreRooFit.AddPdf ) )
         if todo  and extended  :
             value = _integral3 ( self , xmin , xmax , ymin , ymax , zmin , zmax )
         elif todo : 
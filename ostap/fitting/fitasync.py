@@ -0,0 +1,252 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file  ostap/fitting/fitasync.py
+#  Asynchronous fits: the independent fits are performed concurrently
+#  in the pool of worker processes, and the futures are returned
+#  - the model and the dataset are cloned (pickled) in the calling thread
+#    and the fit is performed in the worker process with its own
+#    (isolated) ROOT/RooFit global state
+#  - the results <code>(RooFitResult,frame)</code> are unpickled in the
+#    thread, that asks for them, the background threads of the pool
+#    never touch ROOT objects
+#  - the original model is not modified: use <code>model.load_params(result)</code>
+#  @code
+#  futures = [ model.fitTo_async ( ds , silent = True ) for ds in datasets ]
+#  for result , frame in gather ( futures ) :
+#      print ( result )
+#  @endcode
+#  @attention the keyword arguments are allowed, but not the <code>RooCmdArg</code> ones
+#  @attention the model must be pickleable, e.g. the classes, defined in
+#             <code>__main__</code> cannot be used with the <code>spawn</code> context
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Asynchronous fits: the independent fits are performed concurrently
+in the pool of worker processes, and the futures are returned
+- the model and the dataset are cloned (pickled) in the calling thread
+  and the fit is performed in the worker process with its own
+  (isolated) ROOT/RooFit global state
+- the results `(RooFitResult,frame)` are unpickled in the
+  thread, that asks for them, the background threads of the pool
+  never touch ROOT objects
+- the original model is not modified: use `model.load_params(result)`
+
+>>> futures = [ model.fitTo_async ( ds , silent = True ) for ds in datasets ]
+>>> for result , frame in gather ( futures ) :
+...     print ( result )
+
+- attention: the keyword arguments are allowed, but not the `RooCmdArg` ones
+- attention: the model must be pickleable, e.g. the classes, defined in
+  `__main__` cannot be used with the `spawn` context
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'fit_pool'          , ## get (create) the pool of worker processes
+    'shutdown_fit_pool' , ## shutdown the pool of worker processes
+    'fit_async'         , ## start the asynchronous fit
+    'FitFuture'         , ## the future for the asynchronous fit
+    'gather'            , ## wait for the futures and get the results
+    )
+# =============================================================================
+import pickle, atexit
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.fitting.fitasync' )
+else                       : logger = getLogger ( __name__                 )
+# =============================================================================
+## the pool of worker processes
+_pool        = None
+## its configuration: (ncpus, context)
+_pool_config = None
+# =============================================================================
+## initialize the worker process
+def _initializer_ () :
+    """Initialize the worker process
+    """
+    import ROOT
+    ROOT.gROOT.SetBatch ( True )
+    import ostap.fitting.roofit ## decorations & pickling
+
+# =============================================================================
+## perform the fit in the worker process
+#  @param method  the fit method, e.g. <code>'fitTo'</code>
+#  @param payload the pickled <code>(model,dataset,kwargs)</code>
+#  @return the pickled <code>(result,frame)</code>
+def _fit_task_ ( method , payload ) :
+    """Perform the fit in the worker process
+    - method  : the fit method, e.g. `fitTo`
+    - payload : the pickled `(model,dataset,kwargs)`
+    - returns the pickled `(result,frame)`
+    """
+    model , dataset , kwargs = pickle.loads ( payload )
+    result , frame = getattr ( model , method ) ( dataset , **kwargs )
+    try :
+        return pickle.dumps ( ( result , frame ) , pickle.HIGHEST_PROTOCOL )
+    except Exception :
+        logger.warning ( "fit_async: the frame can't be pickled, skip it" )
+        return pickle.dumps ( ( result , None  ) , pickle.HIGHEST_PROTOCOL )
+
+# =============================================================================
+## get (create) the pool of worker processes
+#  @code
+#  pool = fit_pool ()                  ## default/existing pool
+#  pool = fit_pool ( ncpus = 4 )       ## (re)create the pool with 4 workers
+#  pool = fit_pool ( context = 'fork' )
+#  @endcode
+#  @param ncpus   number of worker processes (default: number of cores)
+#  @param context the start method: <code>'spawn'</code> (default, safe) or
+#                 <code>'fork'</code> (fast, but the parent must not have the active threads)
+#  @return the pool, <code>concurrent.futures.ProcessPoolExecutor</code>
+def fit_pool ( ncpus = None , context = None ) :
+    """Get (create) the pool of worker processes
+    - ncpus   : number of worker processes (default: number of cores)
+    - context : the start method: `spawn` (default, safe) or
+                `fork` (fast, but the parent must not have the active threads)
+    >>> pool = fit_pool ()                  ## default/existing pool
+    >>> pool = fit_pool ( ncpus = 4 )       ## (re)create the pool with 4 workers
+    """
+    global _pool, _pool_config
+    if _pool and ncpus is None and context is None : return _pool
+
+    import multiprocessing
+    if ncpus   is None : ncpus   = _pool_config [ 0 ] if _pool_config else multiprocessing.cpu_count ()
+    if context is None : context = _pool_config [ 1 ] if _pool_config else 'spawn'
+    ncpus  = max ( 1 , int ( ncpus ) )
+    config = ncpus , context
+
+    if _pool and config == _pool_config : return _pool
+    if _pool : shutdown_fit_pool ()
+
+    from concurrent.futures import ProcessPoolExecutor
+    _pool        = ProcessPoolExecutor ( max_workers = ncpus ,
+                                         mp_context  = multiprocessing.get_context ( context ) ,
+                                         initializer = _initializer_ )
+    _pool_config = config
+    logger.debug ( 'fit_pool: the pool with %d workers (%s) is created' % config )
+    return _pool
+
+# =============================================================================
+## shutdown the pool of worker processes
+def shutdown_fit_pool ( wait = True ) :
+    """Shutdown the pool of worker processes
+    """
+    global _pool
+    if _pool :
+        _pool.shutdown ( wait = wait )
+        _pool = None
+
+atexit.register ( shutdown_fit_pool )
+
+# =============================================================================
+## @class FitFuture
+#  The future for the asynchronous fit:
+#  the result <code>(RooFitResult,frame)</code> is unpickled
+#  in the thread that asks for it
+class FitFuture(object) :
+    """The future for the asynchronous fit:
+    the result `(RooFitResult,frame)` is unpickled
+    in the thread that asks for it
+    """
+    __NONE = object ()
+    def __init__ ( self , future , name = '' ) :
+        self.__future = future
+        self.__name   = name
+        self.__result = self.__NONE
+    @property
+    def future ( self ) :
+        """``future'' : the underlying `concurrent.futures.Future`"""
+        return self.__future
+    @property
+    def name   ( self ) :
+        """``name'' : the name of the model"""
+        return self.__name
+    def done      ( self ) : return self.__future.done      ()
+    def running   ( self ) : return self.__future.running   ()
+    def cancel    ( self ) : return self.__future.cancel    ()
+    def cancelled ( self ) : return self.__future.cancelled ()
+    def exception ( self , timeout = None ) : return self.__future.exception ( timeout )
+    ## get the result <code>(RooFitResult,frame)</code>, waiting if needed
+    def result    ( self , timeout = None ) :
+        """Get the result `(RooFitResult,frame)`, waiting if needed
+        """
+        if self.__result is self.__NONE :
+            self.__result = pickle.loads ( self.__future.result ( timeout ) )
+        return self.__result
+    def __repr__  ( self ) :
+        state = 'done' if self.done () else 'running' if self.running () else 'pending'
+        return 'FitFuture(%s,%s)' % ( self.__name , state )
+
+# =============================================================================
+## start the asynchronous fit
+#  @code
+#  future = fit_async ( model , dataset , silent = True )
+#  result , frame = future.result ()
+#  @endcode
+#  @param model   the model (<code>PDF</code>)
+#  @param dataset the dataset (or histogram)
+#  @param method  the fit method, e.g. <code>'fitTo'</code> or <code>'chi2fitTo'</code>
+#  @param pool    the pool of worker processes (default: <code>fit_pool()</code>)
+#  @param kwargs  the keyword arguments for the fit method
+#  @return the future, <code>FitFuture</code>
+def fit_async ( model , dataset , method = 'fitTo' , pool = None , **kwargs ) :
+    """Start the asynchronous fit
+    - model   : the model (`PDF`)
+    - dataset : the dataset (or histogram)
+    - method  : the fit method, e.g. `fitTo` or `chi2fitTo`
+    - pool    : the pool of worker processes (default: `fit_pool()`)
+    - kwargs  : the keyword arguments for the fit method
+    >>> future = fit_async ( model , dataset , silent = True )
+    >>> result , frame = future.result ()
+    """
+    assert not kwargs.get ( 'args' , () ) , \
+           "fit_async: RooCmdArg arguments are not supported, use keyword arguments"
+    assert callable ( getattr ( model , method , None ) ) , \
+           "fit_async: invalid fit method ``%s''" % method
+
+    ## clone the model and the dataset in the calling thread
+    payload = pickle.dumps ( ( model , dataset , kwargs ) , pickle.HIGHEST_PROTOCOL )
+    if pool is None : pool = fit_pool ()
+    return FitFuture ( pool.submit ( _fit_task_ , method , payload ) ,
+                       getattr ( model , 'name' , '' ) )
+
+# =============================================================================
+## wait for the futures and get the results (in the order of futures)
+#  @code
+#  futures = [ model.fitTo_async ( ds ) for ds in datasets ]
+#  results = gather ( futures )
+#  results = gather ( f1 , f2 , f3 , timeout = 100 )
+#  @endcode
+#  @param futures the futures
+#  @param timeout the timeout (in seconds)
+#  @return the list of results <code>(RooFitResult,frame)</code>
+def gather ( *futures , **kwargs ) :
+    """Wait for the futures and get the results (in the order of futures)
+    >>> futures = [ model.fitTo_async ( ds ) for ds in datasets ]
+    >>> results = gather ( futures )
+    >>> results = gather ( f1 , f2 , f3 , timeout = 100 )
+    """
+    timeout = kwargs.pop ( 'timeout' , None )
+    assert not kwargs , 'gather: unknown arguments %s' % list ( kwargs.keys () )
+
+    if 1 == len ( futures ) and not isinstance ( futures [ 0 ] , FitFuture ) :
+        futures = tuple ( futures [ 0 ] )
+
+    from concurrent.futures import wait
+    done , pending = wait ( [ f.future for f in futures ] , timeout = timeout )
+    if pending :
+        from concurrent.futures import TimeoutError
+        raise TimeoutError ( 'gather: %d fits are not completed' % len ( pending ) )
+
+    return [ f.result () for f in futures ]
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -0,0 +1,287 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file  ostap/fitting/fitcache.py
+#  Content-addressed persistent cache of fit results
+#  - the key is built from the model structure (types and names of
+#    components and their links), the initial values, ranges and errors
+#    of the parameters, the content hash of the dataset and the fit options
+#  - the successful fit results are stored in the persistent shelve,
+#    and the repeated fit of the same model to the same data with
+#    the same options just restores the parameters from the stored result
+#  @code
+#  r1 , f = model.fitTo ( dataset , cache = True )  ## make a fit and store the result
+#  r2 , f = model.fitTo ( dataset , cache = True )  ## taken from the cache
+#  r3 , f = model.fitTo ( dataset , cache = 'my_fits.db' ) ## use the specific database
+#  print ( fit_cache_stat () )
+#  @endcode
+#  @attention the hidden configuration of the C++ components, that is not
+#             visible via their parameters, is not a part of the key
+#             (except for the histograms of <code>RooHistPdf</code>/<code>RooHistFunc</code>)
+#  @see Ostap::Utils::hash_data_content
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Content-addressed persistent cache of fit results
+- the key is built from the model structure (types and names of
+  components and their links), the initial values, ranges and errors
+  of the parameters, the content hash of the dataset and the fit options
+- the successful fit results are stored in the persistent shelve,
+  and the repeated fit of the same model to the same data with
+  the same options just restores the parameters from the stored result
+
+>>> r1 , f = model.fitTo ( dataset , cache = True )  ## make a fit and store the result
+>>> r2 , f = model.fitTo ( dataset , cache = True )  ## taken from the cache
+>>> r3 , f = model.fitTo ( dataset , cache = 'my_fits.db' ) ## use the specific database
+>>> print ( fit_cache_stat () )
+
+- attention: the hidden configuration of the C++ components, that is not
+visible via their parameters, is not a part of the key
+(except for the histograms of `RooHistPdf`/`RooHistFunc`)
+- see Ostap::Utils::hash_data_content
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'data_key'       , ## the content key for the dataset
+    'fit_key'        , ## the content key for the fit
+    'FitCache'       , ## persistent cache of fit results
+    'fit_cache'      , ## get the cache for the ``cache'' argument of fitTo
+    'restore_params' , ## restore parameters from the fit result
+    'fit_cache_stat' , ## statistics of the cache
+    )
+# =============================================================================
+import ROOT, os, hashlib
+from   ostap.core.core     import Ostap
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.fitting.fitcache' )
+else                       : logger = getLogger ( __name__                 )
+# =============================================================================
+## statistics of the cache
+_stat = { 'hits' : 0 , 'misses' : 0 , 'stored' : 0 }
+# =============================================================================
+## the content key for the dataset
+#  @see Ostap::Utils::hash_data_content
+def data_key ( dataset ) :
+    """The content key for the dataset
+    - see Ostap::Utils::hash_data_content
+    """
+    return 'DS' , int ( Ostap.Utils.hash_data_content ( dataset ) )
+
+# =============================================================================
+## the key for the model structure and initial values of parameters
+def _model_key_ ( pdf , dataset ) :
+    """The key for the model structure and initial values of parameters
+    """
+
+    components = []
+    for c in sorted ( pdf.getComponents () , key = lambda a : a.GetName () ) :
+        item = c.ClassName () , c.GetName () , tuple ( sorted ( s.GetName () for s in c.servers () ) )
+        ## the histograms of the histogram-based components
+        if isinstance ( c , ( ROOT.RooHistPdf , ROOT.RooHistFunc ) ) :
+            item = item + data_key ( c.dataHist () )
+        components.append ( item )
+
+    params = []
+    for p in sorted ( pdf.getParameters ( dataset ) , key = lambda a : a.GetName () ) :
+        if   isinstance ( p , ROOT.RooRealVar     ) :
+            params.append ( ( p.GetName () , p.getVal () , p.getMin () , p.getMax () ,
+                              p.getError () , p.isConstant () ) )
+        elif isinstance ( p , ROOT.RooAbsCategory ) :
+            params.append ( ( p.GetName () , p.getCurrentIndex () ) )
+        elif isinstance ( p , ROOT.RooAbsReal     ) :
+            params.append ( ( p.GetName () , p.getVal () ) )
+
+    return tuple ( components ) , tuple ( params )
+
+# =============================================================================
+## the key for the fit options
+def _options_key_ ( *options ) :
+    """The key for the fit options
+    """
+    from ostap.fitting.roocmdarg import flat_args
+
+    def _str_  ( s ) : return str ( s ) if s else ''
+    def _name_ ( o ) : return o.GetName () if o else ''
+
+    items = []
+    for o in flat_args ( *options ) :
+        s1 , s2 = o.getSet ( 0 ) , o.getSet ( 1 )
+        items.append ( ( o.GetName () ,
+                         o.getInt    ( 0 ) , o.getInt    ( 1 ) ,
+                         o.getDouble ( 0 ) , o.getDouble ( 1 ) ,
+                         _str_ ( o.getString ( 0 ) ) ,
+                         _str_ ( o.getString ( 1 ) ) ,
+                         _str_ ( o.getString ( 2 ) ) ,
+                         _name_ ( o.getObject ( 0 ) ) , _name_ ( o.getObject ( 1 ) ) ,
+                         tuple ( sorted ( a.GetName () for a in s1 ) ) if s1 else () ,
+                         tuple ( sorted ( a.GetName () for a in s2 ) ) if s2 else () ) )
+    return tuple ( sorted ( items ) )
+
+# =============================================================================
+## the content key for the fit: the model structure, the initial parameters,
+#  the content of the dataset and the fit options
+#  @code
+#  key = fit_key ( model.pdf , dataset , *options )
+#  @endcode
+#  @return the hexadecimal digest (stable between the sessions)
+def fit_key ( pdf , dataset , *options ) :
+    """The content key for the fit: the model structure, the initial parameters,
+    the content of the dataset and the fit options
+    >>> key = fit_key ( model.pdf , dataset , *options )
+    - return the hexadecimal digest (stable between the sessions)
+    """
+    key = ( 'FIT' ,
+            _model_key_   ( pdf , dataset ) ,
+            data_key      ( dataset       ) ,
+            _options_key_ ( *options      ) )
+    return hashlib.sha1 ( repr ( key ).encode ( 'utf-8' ) ).hexdigest ()
+
+# =============================================================================
+## restore the parameters (values and errors) from the fit result
+#  @param pdf     the model (RooAbsPdf)
+#  @param result  the fit result
+#  @param dataset the dataset
+def restore_params ( pdf , result , dataset ) :
+    """Restore the parameters (values and errors) from the fit result
+    - pdf     : the model (RooAbsPdf)
+    - result  : the fit result
+    - dataset : the dataset
+    """
+    params = pdf.getParameters ( dataset )
+    for f in result.floatParsFinal () :
+        p = params.find ( f.GetName () )
+        if not p or not isinstance ( p , ROOT.RooRealVar ) : continue
+        p.setVal   ( f.getVal   () )
+        p.setError ( f.getError () )
+        if f.hasAsymError () : p.setAsymError ( f.getErrorLo () , f.getErrorHi () )
+        else                 : p.removeAsymError ()
+
+# =============================================================================
+## @class FitCache
+#  Persistent cache of fit results: the database is opened for each operation,
+#  therefore it can be shared between the processes
+#  @code
+#  cache  = FitCache ( 'my_fits.db' )
+#  result = cache.get ( key )
+#  if not result :
+#      result = ...
+#      cache.put ( key , result )
+#  @endcode
+class FitCache(object) :
+    """Persistent cache of fit results: the database is opened for each operation,
+    therefore it can be shared between the processes
+    >>> cache  = FitCache ( 'my_fits.db' )
+    >>> result = cache.get ( key )
+    >>> if not result :
+    ...    result = ...
+    ...    cache.put ( key , result )
+    """
+    def __init__ ( self , dbname ) :
+        self.__dbname = dbname
+
+    @property
+    def dbname ( self ) :
+        """``dbname'' : the name of the database"""
+        return self.__dbname
+
+    ## get the fit result from the cache
+    def get ( self , key ) :
+        """Get the fit result from the cache"""
+        import ostap.io.zipshelve as zipshelve
+        try :
+            with zipshelve.open ( self.dbname , 'r' ) as db :
+                return db.get ( key , None )
+        except Exception :
+            return None
+
+    ## put the fit result into the cache
+    def put ( self , key , result ) :
+        """Put the fit result into the cache"""
+        import ostap.io.zipshelve as zipshelve
+        try :
+            with zipshelve.open ( self.dbname , 'c' ) as db :
+                db [ key ] = result
+            return True
+        except Exception :
+            logger.warning ( "Cannot store the fit result into ``%s''" % self.dbname )
+            return False
+
+    def __repr__ ( self ) : return "FitCache('%s')" % self.dbname
+    __str__ = __repr__
+
+# =============================================================================
+## @class _DictCache
+#  Cache of fit results in the dictionary-like object (e.g. opened shelve)
+class _DictCache(object) :
+    """Cache of fit results in the dictionary-like object (e.g. opened shelve)
+    """
+    def __init__ ( self , db ) : self.__db = db
+    def get      ( self , key          ) : return self.__db.get ( key , None )
+    def put      ( self , key , result ) :
+        self.__db [ key ] = result
+        return True
+
+# =============================================================================
+## get the cache for the <code>cache</code> argument of <code>fitTo</code>:
+#  - <code>True</code>                 : the default database in the ostap working directory
+#  - string                            : the name of the database
+#  - <code>FitCache</code>             : the cache itself
+#  - dictionary-like object            : e.g. opened shelve
+def fit_cache ( cache ) :
+    """Get the cache for the `cache` argument of `fitTo`
+    - True                   : the default database in the ostap working directory
+    - string                 : the name of the database
+    - FitCache               : the cache itself
+    - dictionary-like object : e.g. opened shelve
+    """
+    from ostap.core.ostap_types import string_types
+    if   isinstance ( cache , FitCache     ) : return cache
+    elif isinstance ( cache , string_types ) : return FitCache ( cache )
+    elif hasattr    ( cache , 'get'        ) and hasattr ( cache , '__setitem__' ) :
+        return _DictCache ( cache )
+    from ostap.core.workdir import workdir
+    return FitCache ( os.path.join ( workdir , 'cache' , 'fitresults.zdb' ) )
+
+# =============================================================================
+## look for the fit result in the cache
+#  @return the fit result or None
+def lookup ( cache , key ) :
+    """Look for the fit result in the cache
+    - return the fit result or None
+    """
+    result = cache.get ( key )
+    if result : _stat [ 'hits'   ] += 1
+    else      : _stat [ 'misses' ] += 1
+    return result
+
+# =============================================================================
+## store the fit result in the cache
+def store ( cache , key , result ) :
+    """Store the fit result in the cache"""
+    if cache.put ( key , result ) : _stat [ 'stored' ] += 1
+
+# =============================================================================
+## statistics of the cache
+#  @code
+#  print ( 'hits/misses: %(hits)d/%(misses)d' % fit_cache_stat () )
+#  @endcode
+def fit_cache_stat ( reset = False ) :
+    """Statistics of the cache
+    >>> print ( 'hits/misses: %(hits)d/%(misses)d' % fit_cache_stat () )
+    """
+    result = dict ( _stat )
+    if reset :
+        for k in _stat : _stat [ k ] = 0
+    return result
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -220,6 +220,9 @@ __all__ = (
     'RooKeys1D_pdf'     , ## 1D-wrapper for RooNDKeysPdf 
     'RooKeys2D_pdf'     , ## 2D-wrapper for RooNDKeysPdf 
     'RooKeys3D_pdf'     , ## 3D-wrapper for RooNDKeysPdf 
+    'KDE1D_pdf'         , ## 1D binned (FFT-based) kernel density estimator 
+    'KDE2D_pdf'         , ## 2D binned (FFT-based) kernel density estimator 
+    'KDE3D_pdf'         , ## 3D binned (FFT-based) kernel density estimator 
     #
     ## simultaneous  fit
     'SimFit'            , ##    Simultaneous fit 
@@ -29,6 +29,7 @@ __all__     = (
     'Spline2Dsym_pdf' , ## 2D symmetric positive spline
     #
     'RooKeys2D_pdf'   , ## wrapper for native RooNDKeysPdf
+    'KDE2D_pdf'       , ## binned (FFT-based) kernel density estimator
     #
     'make_B2D'        , ## create           2D "background" function 
     'make_B2Dsym'     , ## create symmetric 2D "background" function 
@@ -1600,6 +1601,104 @@ class RooKeys2D_pdf(PDF2) :
         """``nsigma'' : ``nsigma'' parameter for RooNDKeysPdf"""
         return self.__nsigma 
 
+# =============================================================================
+## @class KDE2D_pdf
+#  Ostap-native binned (FFT-based) kernel density estimator in 2D,
+#  the fast replacement for <code>RooNDKeysPdf</code>/RooKeys2D_pdf
+#  @code
+#  pdf  = KDE2D_pdf ( 'KDE' , xvar , yvar , data , adaptive = True ) ;
+#  @endcode
+#  @see Ostap::Models::KDE
+#  @see Ostap::Math::KDE
+#  @see ostap.fitting.background.KDE1D_pdf
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date 2026-10-15
+class KDE2D_pdf(PDF2) :
+    """Ostap-native binned (FFT-based) kernel density estimator in 2D,
+    the fast replacement for RooNDKeysPdf/RooKeys2D_pdf
+    - see Ostap.Models.KDE
+    - see Ostap.Math.KDE 
+    - see ostap.fitting.background.KDE1D_pdf
+    >>> pdf  = KDE2D_pdf ( 'KDE' , xvar , yvar , data , adaptive = True )
+    """
+    ## constructor
+    def __init__ ( self             ,
+                   name             ,   ## the name 
+                   xvar             ,   ## the variable
+                   yvar             ,   ## the variable
+                   data             ,   ## data set or Ostap.Math.KDE  
+                   nbins    = 128   ,   ## number of grid bins (per axis) 
+                   rho      = 1     ,   ## global scale for the bandwidth 
+                   adaptive = False ,   ## adaptive bandwidth ? 
+                   mirror   = True  ) : ## mirror data at the boundaries ?
+        
+        ## initialize the base class 
+        PDF2.__init__ (  self , name , xvar , yvar )
+
+        self.__data     = data
+        self.__nbins    = nbins 
+        self.__rho      = rho 
+        self.__adaptive = True if adaptive else False 
+        self.__mirror   = True if mirror   else False 
+
+        ## create PDF
+        if isinstance ( data , Ostap.Math.KDE ) :
+            self.pdf = Ostap.Models.KDE (
+                self.roo_name ( 'kde2_' ) , 
+                "KDE 2D %s"  % self.name  ,
+                self.xvar                 ,
+                self.yvar                 ,
+                data                      )
+        else :
+            self.pdf = Ostap.Models.KDE (
+                self.roo_name ( 'kde2_' ) , 
+                "KDE 2D %s"  % self.name  ,
+                self.xvar                 ,
+                self.yvar                 ,
+                self.data                 ,
+                self.nbins                ,
+                self.nbins                ,
+                self.rho                  ,
+                self.adaptive             ,
+                self.mirror               )
+            
+        ## save configuration
+        self.config = {
+            'name'     : self.name     ,
+            'xvar'     : self.xvar     ,
+            'yvar'     : self.yvar     ,
+            'data'     : self.data     ,            
+            'nbins'    : self.nbins    ,            
+            'rho'      : self.rho      ,            
+            'adaptive' : self.adaptive ,            
+            'mirror'   : self.mirror   ,            
+            }
+
+    @property
+    def data     ( self ) :
+        """``data'' : the actual data set (or Ostap.Math.KDE) for KDE"""
+        return self.__data
+    @property
+    def nbins    ( self ) :
+        """``nbins'' : number of grid bins (per axis)"""
+        return self.__nbins        
+    @property
+    def rho      ( self )  :
+        """``rho'' : global scale factor for the bandwidth"""
+        return self.__rho 
+    @property
+    def adaptive ( self )  :
+        """``adaptive'' : use the adaptive bandwidth?"""
+        return self.__adaptive
+    @property
+    def mirror   ( self )  :
+        """``mirror'' : mirror the data at the boundaries?"""
+        return self.__mirror 
+    @property
+    def kde      ( self )  :
+        """``kde'' : the underlying density, Ostap.Math.KDE"""
+        return self.pdf.kde () 
+
 # =============================================================================
 # some tiny decoration of underlying classes 
 # =============================================================================
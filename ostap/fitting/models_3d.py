@@ -20,6 +20,7 @@ __all__     = (
     'PolyPos3DmixXZ_pdf', ## A positive partly symmetric (x<-->z) polynomial in 3D 
     #
     'RooKeys3D_pdf'     , ## wrapper for native RooNDKeysPdf
+    'KDE3D_pdf'         , ## binned (FFT-based) kernel density estimator
     #
 
     'make_B3D'          , ## create                         3D "background" function 
@@ -632,6 +633,109 @@ class RooKeys3D_pdf(PDF3) :
         return self.__nsigma 
 
 
+# =============================================================================
+## @class KDE3D_pdf
+#  Ostap-native binned (FFT-based) kernel density estimator in 3D,
+#  the fast replacement for <code>RooNDKeysPdf</code>/RooKeys3D_pdf
+#  @code
+#  pdf  = KDE3D_pdf ( 'KDE' , xvar , yvar , zvar , data , adaptive = True ) ;
+#  @endcode
+#  @see Ostap::Models::KDE
+#  @see Ostap::Math::KDE
+#  @see ostap.fitting.background.KDE1D_pdf
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date 2026-10-15
+class KDE3D_pdf(PDF3) :
+    """Ostap-native binned (FFT-based) kernel density estimator in 3D,
+    the fast replacement for RooNDKeysPdf/RooKeys3D_pdf
+    - see Ostap.Models.KDE
+    - see Ostap.Math.KDE 
+    - see ostap.fitting.background.KDE1D_pdf
+    >>> pdf  = KDE3D_pdf ( 'KDE' , xvar , yvar , zvar , data , adaptive = True )
+    """
+    ## constructor
+    def __init__ ( self             ,
+                   name             ,   ## the name 
+                   xvar             ,   ## the variable
+                   yvar             ,   ## the variable
+                   zvar             ,   ## the variable
+                   data             ,   ## data set or Ostap.Math.KDE  
+                   nbins    = 64    ,   ## number of grid bins (per axis) 
+                   rho      = 1     ,   ## global scale for the bandwidth 
+                   adaptive = False ,   ## adaptive bandwidth ? 
+                   mirror   = True  ) : ## mirror data at the boundaries ?
+        
+        ## initialize the base class 
+        PDF3.__init__ (  self , name , xvar , yvar , zvar )
+
+        self.__data     = data
+        self.__nbins    = nbins 
+        self.__rho      = rho 
+        self.__adaptive = True if adaptive else False 
+        self.__mirror   = True if mirror   else False 
+
+        ## create PDF
+        if isinstance ( data , Ostap.Math.KDE ) :
+            self.pdf = Ostap.Models.KDE (
+                self.roo_name ( 'kde3_' ) , 
+                "KDE 3D %s"  % self.name  ,
+                self.xvar                 ,
+                self.yvar                 ,
+                self.zvar                 ,
+                data                      )
+        else :
+            self.pdf = Ostap.Models.KDE (
+                self.roo_name ( 'kde3_' ) , 
+                "KDE 3D %s"  % self.name  ,
+                self.xvar                 ,
+                self.yvar                 ,
+                self.zvar                 ,
+                self.data                 ,
+                self.nbins                ,
+                self.nbins                ,
+                self.nbins                ,
+                self.rho                  ,
+                self.adaptive             ,
+                self.mirror               )
+            
+        ## save configuration
+        self.config = {
+            'name'     : self.name     ,
+            'xvar'     : self.xvar     ,
+            'yvar'     : self.yvar     ,
+            'zvar'     : self.zvar     ,
+            'data'     : self.data     ,            
+            'nbins'    : self.nbins    ,            
+            'rho'      : self.rho      ,            
+            'adaptive' : self.adaptive ,            
+            'mirror'   : self.mirror   ,            
+            }
+
+    @property
+    def data     ( self ) :
+        """``data'' : the actual data set (or Ostap.Math.KDE) for KDE"""
+        return self.__data
+    @property
+    def nbins    ( self ) :
+        """``nbins'' : number of grid bins (per axis)"""
+        return self.__nbins        
+    @property
+    def rho      ( self )  :
+        """``rho'' : global scale factor for the bandwidth"""
+        return self.__rho 
+    @property
+    def adaptive ( self )  :
+        """``adaptive'' : use the adaptive bandwidth?"""
+        return self.__adaptive
+    @property
+    def mirror   ( self )  :
+        """``mirror'' : mirror the data at the boundaries?"""
+        return self.__mirror 
+    @property
+    def kde      ( self )  :
+        """``kde'' : the underlying density, Ostap.Math.KDE"""
+        return self.pdf.kde () 
+
 # ==============================================================================
 ## Easy creation of  3D function for background
 #  @code
@@ -21,12 +21,43 @@ __all__     = (
 # =============================================================================
 import ROOT
 # =============================================================================
+from   ostap.core.core         import Ostap
 from   ostap.fitting.basic     import PDF, Generic1D_pdf
 from   ostap.core.ostap_types  import integer_types 
 # =============================================================================
 from   ostap.logger.logger import getLogger
 if '__main__' ==  __name__ : logger = getLogger ( 'ostap.fitting.morphing_pdf' )
 else                       : logger = getLogger ( __name__                     )
+# =============================================================================
+## create the (native) morphing object from the list of PDFs
+#  @see Ostap::Math::Morphing
+#  @see Ostap::Models::Morphing
+def _native_morphing_ ( xvar , pdfs , mus1 , mus2 = () , nbins = 1000 , horizontal = True ) :
+    """Create the (native) morphing object from the list of PDFs
+    - see Ostap.Math.Morphing
+    - see Ostap.Models.Morphing
+    """
+    assert xvar.minmax () , "Morphing: xvar must have the range!"
+    
+    VD = ROOT.std.vector ( 'double' )
+    VT = ROOT.std.vector ( VD )
+    
+    templates = VT ()
+    for p in pdfs :
+        templates.push_back ( Ostap.Models.Morphing.sample ( p , xvar , nbins ) )
+
+    v1 = VD ()
+    for m in mus1 : v1.push_back ( float ( m ) )
+    
+    mode = Ostap.Math.Morphing.Horizontal if horizontal else Ostap.Math.Morphing.Vertical
+    xmin , xmax = xvar.minmax ()
+    
+    if not mus2 : return Ostap.Math.Morphing ( v1 , templates , xmin , xmax , mode )
+    
+    v2 = VD ()
+    for m in mus2 : v2.push_back ( float ( m ) )
+    return Ostap.Math.Morphing ( v1 , v2 , templates , xmin , xmax , mode )
+
 # =============================================================================
 ## @class Morphing1D_pdf
 #  Wrapper for <code>RooMomentMorph</code> PDF
@@ -38,6 +69,12 @@ else                       : logger = getLogger ( __name__                     )
 #       Nuclear Instruments & Methods in Physics Research.
 #       Section A - Accelerators Spectrometers Detectors and Associated Equipment, 771, 39-48.
 #  @see https://doi.org/10.1016/j.nima.2014.10.033
+#  - for <code>native=True</code> Ostap::Models::Morphing is used: 
+#    the templates are sampled once, and the morphing is 
+#    the direct interpolation of the cumulative distributions 
+#    (<code>horizontal=False</code>) or of the quantile functions 
+#    (<code>horizontal=True</code>)
+#  @see Ostap::Models::Morphing
 class Morphing1D_pdf (PDF) :
     """ Wrapper for ROOT.RooMomentMorph PDF
     - 1D morphing/1D PDF
@@ -48,13 +85,19 @@ class Morphing1D_pdf (PDF) :
     Nuclear Instruments & Methods in Physics Research.
     Section A - Accelerators Spectrometers Detectors and Associated Equipment, 771, 39-48.
     - see https://doi.org/10.1016/j.nima.2014.10.033
+    - for `native=True` Ostap.Models.Morphing is used:
+    the templates are sampled once, and the morphing is the direct interpolation
+    of the cumulative distributions (`horizontal=False`) or of the quantile functions (`horizontal=True`)
     """
     def __init__ ( self                ,
                    name                , ## PDF name 
                    pdfs                , ## dictionary {mu1,mu2 -> pdf }
                    setting    = None   , ## morphing setting 
                    morph_var  = None   , ## morphing variable mu 
-                   xvar       = None ) : ## observable (1D) 
+                   xvar       = None   , ## observable (1D) 
+                   native     = False  , ## use Ostap::Models::Morphing ?
+                   nbins      = 1000   , ## number of bins for native templates 
+                   horizontal = True   ) : ## horizontal morphing for native templates 
 
         assert pdfs and 2 <= len ( pdfs ) , \
                "Invalid dictionary of morphing PDFs!"
@@ -117,15 +160,34 @@ class Morphing1D_pdf (PDF) :
         observables = ROOT.RooArgList (  self.xvar )
         self.aux_keep.append  ( observables )
         
-        ## create the PDF  
-        self.pdf = ROOT.RooMomentMorph (
-            self.roo_name ( 'morph_' ) ,
-            "Morphing %s" % self.name  , 
-            self.mu               , ## morphing variable
-            observables           , ## observables 
-            pdflst                , ## ordered list of PDFs  
-            muvct                 , ## values of morhing parameter 
-            self.setting          ) ## morphing setting 
+        self.__native = True if native else False 
+
+        if self.native :
+            
+            self.__morphing = _native_morphing_ ( self.xvar  , 
+                                                  [ p [ 1 ].pdf for p in self.pdflist ] ,
+                                                  [ p [ 0 ]     for p in self.pdflist ] ,
+                                                  nbins      = nbins      ,
+                                                  horizontal = horizontal )
+            ## create the PDF  
+            self.pdf = Ostap.Models.Morphing (
+                self.roo_name ( 'morph_' ) ,
+                "Morphing %s" % self.name  , 
+                self.xvar             , ## observable 
+                self.mu               , ## morphing variable
+                self.__morphing       ) ## morphing object 
+            
+        else :
+            
+            ## create the PDF  
+            self.pdf = ROOT.RooMomentMorph (
+                self.roo_name ( 'morph_' ) ,
+                "Morphing %s" % self.name  , 
+                self.mu               , ## morphing variable
+                observables           , ## observables 
+                pdflst                , ## ordered list of PDFs  
+                muvct                 , ## values of morhing parameter 
+                self.setting          ) ## morphing setting 
 
         #
         self.config = {
@@ -134,6 +196,9 @@ class Morphing1D_pdf (PDF) :
             'xvar'      : self.xvar             ,
             'morph_var' : self.mu               ,
             'pdfs'      : dict ( self.pdflist ) ,
+            'native'    : self.native           ,
+            'nbins'     : nbins                 ,
+            'horizontal': horizontal            ,
             }
         
     @property
@@ -148,6 +213,11 @@ class Morphing1D_pdf (PDF) :
             self.error ( "Morphing parameter %s is outside [%s,%s]" % ( v , mm[0] , mm[1] ) )
         self.__mu.setVal ( v )
 
+    @property
+    def native ( self ) :
+        """``native'' : use Ostap::Models::Morphing?"""
+        return self.__native
+    
     @property
     def pdflist ( self ) :
         """``pdflist'' : (sorted) tuple of (morphing parameter, pdf) pairs"""
@@ -170,6 +240,12 @@ class Morphing1D_pdf (PDF) :
 #       Nuclear Instruments & Methods in Physics Research.
 #       Section A - Accelerators Spectrometers Detectors and Associated Equipment, 771, 39-48.
 #  @see https://doi.org/10.1016/j.nima.2014.10.033
+#  - for <code>native=True</code> Ostap::Models::Morphing is used: 
+#    the templates are sampled once, and the morphing is 
+#    the direct interpolation of the cumulative distributions 
+#    (<code>horizontal=False</code>) or of the quantile functions 
+#    (<code>horizontal=True</code>)
+#  @see Ostap::Models::Morphing
 class Morphing2D_pdf (PDF) :
     """ Wrapper for ROOT.RooMomentMorphND PDF for N = 2 
     - 1D morphing/2D PDF
@@ -180,6 +256,9 @@ class Morphing2D_pdf (PDF) :
     Nuclear Instruments & Methods in Physics Research.
     Section A - Accelerators Spectrometers Detectors and Associated Equipment, 771, 39-48.
     - see https://doi.org/10.1016/j.nima.2014.10.033
+    - for `native=True` Ostap.Models.Morphing is used:
+    the templates are sampled once, and the morphing is the direct interpolation
+    of the cumulative distributions (`horizontal=False`) or of the quantile functions (`horizontal=True`)
     """
     def __init__ ( self                ,
                    name                , ## PDF name 
@@ -187,7 +266,10 @@ class Morphing2D_pdf (PDF) :
                    setting    = None   , ## morphing setting 
                    morph_var1 = None   , ## morphing variable mu1 
                    morph_var2 = None   , ## morphing variable mu1 
-                   xvar       = None ) : ## observable (1D) 
+                   xvar       = None   , ## observable (1D) 
+                   native     = False  , ## use Ostap::Models::Morphing ?
+                   nbins      = 1000   , ## number of bins for native templates 
+                   horizontal = True   ) : ## horizontal morphing for native templates 
 
         assert pdfs and 2 <= len ( pdfs ) , \
                "Invalid dictionary of morphing PDFs!"
@@ -285,14 +367,35 @@ class Morphing2D_pdf (PDF) :
         self.aux_keep.append  ( morph_vars  )
         self.aux_keep.append  ( observables )
         
-        ## create the PDF  
-        self.pdf = ROOT.RooMomentMorphND (
-            self.roo_name ( 'morph2_' )   ,
-            "Morphing 2D %s" % self.name  , 
-            morph_vars              , ## morphing variables 
-            observables             , ## observables 
-            self.grid               , ## morphing grid 
-            self.setting            ) ## morphing setting 
+        self.__native = True if native else False 
+
+        if self.native :
+
+            keys = [ ( v1 , v2 ) for v1 in v1ps for v2 in v2ps ]
+            self.__morphing = _native_morphing_ ( self.xvar  , 
+                                                  [ self.pdfdict [ k ].pdf for k in keys ] ,
+                                                  v1ps , v2ps             , 
+                                                  nbins      = nbins      ,
+                                                  horizontal = horizontal )
+            ## create the PDF  
+            self.pdf = Ostap.Models.Morphing (
+                self.roo_name ( 'morph2_' )   ,
+                "Morphing 2D %s" % self.name  , 
+                self.xvar               , ## observable 
+                self.mu1                , ## the first  morphing variable
+                self.mu2                , ## the second morphing variable
+                self.__morphing         ) ## morphing object 
+
+        else :
+            
+            ## create the PDF  
+            self.pdf = ROOT.RooMomentMorphND (
+                self.roo_name ( 'morph2_' )   ,
+                "Morphing 2D %s" % self.name  , 
+                morph_vars              , ## morphing variables 
+                observables             , ## observables 
+                self.grid               , ## morphing grid 
+                self.setting            ) ## morphing setting 
 
         #
         self.config = {
@@ -302,6 +405,9 @@ class Morphing2D_pdf (PDF) :
             'morph_var1' : self.mu1     ,
             'morph_var2' : self.mu2     ,
             'pdfs'       : self.pdfdict ,
+            'native'     : self.native  ,
+            'nbins'      : nbins        ,
+            'horizontal' : horizontal   ,
             }
         
     @property
@@ -333,6 +439,11 @@ class Morphing2D_pdf (PDF) :
         """``grid'' : morphing grid"""
         return self.__grid
     
+    @property
+    def native ( self ) :
+        """``native'' : use Ostap::Models::Morphing?"""
+        return self.__native
+    
     @property
     def pdfdict ( self ) :
         """``pdfdict'' : Dictionary { morphing parameters : pdf } """
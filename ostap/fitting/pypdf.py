@@ -103,7 +103,8 @@ __author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
 __date__    = "2011-07-25"
 __all__     = (
     ##
-    'PyPDF2' , ## ``pythonic'' PDF for RooFit 
+    'PyPDF2'        , ## ``pythonic'' PDF for RooFit 
+    'BatchFunction' , ## adapter for vectorized functions 
     )
 # =============================================================================
 import ROOT, math
@@ -121,8 +122,9 @@ else                       : logger = getLogger ( __name__              )
 if old_PyROOT :
 
     __all__ = (
-    'PyPDF'  , ## ``pythonic'' PDF for RooFit 
-    'PyPDF2' , ## ``pythonic'' PDF for RooFit 
+    'PyPDF'         , ## ``pythonic'' PDF for RooFit 
+    'PyPDF2'        , ## ``pythonic'' PDF for RooFit 
+    'BatchFunction' , ## adapter for vectorized functions 
         )
     # =========================================================================
     ## @class PyPDF
@@ -410,23 +412,76 @@ if old_PyROOT :
             return KLASS ( **conf )
 
         
+# =============================================================================
+## @class BatchFunction
+#  Helper class to adapt the vectorized (numpy) function for
+#  the batch evaluation protocol of Ostap::Models::PyPdf2:
+#  all variables are presented as (read-only) numpy arrays 
+#  (the length is 1 for scalar parameters), and the result 
+#  is written into the output array 
+#  @code
+#  def gauss ( x , m , s ) : return numpy.exp ( -0.5 * ( ( x - m ) / s ) ** 2 ) / s 
+#  batch = BatchFunction ( gauss ) 
+#  @endcode
+#  @see Ostap::Models::PyPdf2
+class BatchFunction(object) :
+    """Helper class to adapt the vectorized (numpy) function for
+    the batch evaluation protocol of Ostap::Models::PyPdf2:
+    - all variables are presented as (read-only) numpy arrays 
+    (the length is 1 for scalar parameters), and the result 
+    is written into the output array
+    >>> def gauss ( x , m , s ) : return numpy.exp ( -0.5 * ( ( x - m ) / s ) ** 2 ) / s 
+    >>> batch = BatchFunction ( gauss ) 
+    """
+    def __init__ ( self , function ) :
+        assert function and callable ( function ) , "``function'' is not callable!"
+        self.__function = function
+        
+    def __call__ ( self , output , *inputs ) :
+        import numpy
+        out     = numpy.frombuffer ( output , dtype = numpy.float64 )
+        args    = tuple ( numpy.frombuffer ( i , dtype = numpy.float64 ) for i in inputs )  
+        out [:] = self.__function ( *args )
+        
+    @property
+    def function ( self ) :
+        """``function'' : get the actual vectorized function"""
+        return self.__function 
+
 # =============================================================================
 ## @class PyPDF2
 #  ``Light'' version of ``pythonic-Pdf''
 #  
+#  Optionally the batch evaluation is supported:  
+#  - <code>batch=True</code>:  the function itself is vectorized (e.g. numpy/numba) 
+#  - <code>batch=callable</code>: separate vectorized function with the same signature
+#  In this case RooFit batch evaluation invokes python once per batch 
+#  @code
+#  def gauss ( x , m , s ) : return numpy.exp ( -0.5 * ( ( x - m ) / s ) ** 2 ) / s 
+#  pdf = PyPDF2 ( 'G' , gauss , ( mass , mean , sigma ) , batch = True ) 
+#  @endcode
 #  @see Ostap::Models::PyPdf
 #  @see Ostap::Models::PyPdf2
 class PyPDF2(object) :
     """  ``Light'' version of ``pythonic-Pdf''
+    Optionally the batch evaluation is supported:
+    - batch=True: the function itself is vectorized (e.g. numpy/numba) 
+    - batch=callable: separate vectorized function with the same signature
+    In this case RooFit batch evaluation invokes python once per batch 
+    >>> def gauss ( x , m , s ) : return numpy.exp ( -0.5 * ( ( x - m ) / s ) ** 2 ) / s 
+    >>> pdf = PyPDF2 ( 'G' , gauss , ( mass , mean , sigma ) , batch = True ) 
     """
-    def __init__ (  self       ,
-                    name       ,
-                    function   ,
-                    vars       , 
-                    title = '' ) :
+    def __init__ (  self          ,
+                    name          ,
+                    function      ,
+                    vars          , 
+                    title = ''    ,
+                    batch = None  ) :
 
         ## function must be valid function! 
         assert function and callable ( function ) , "``function'' is not callable!"
+        assert batch in ( None , True , False ) or callable ( batch ) , \
+               "``batch'' is not callable!"
 
         if not title : title = 'PyPDF2(%s)' % name
 
@@ -450,6 +505,14 @@ class PyPDF2(object) :
 
         self.__pypdf = pypdf
 
+        ## batch evaluation ?
+        self.__batch = batch 
+        if   batch is True                      : self.__pybatch = BatchFunction ( function )
+        elif isinstance ( batch , BatchFunction ) : self.__pybatch = batch
+        elif batch and callable ( batch )         : self.__pybatch = BatchFunction ( batch )
+        else                                      : self.__pybatch = None
+        if self.__pybatch : self.pypdf.setBatch ( self.__pybatch ) 
+            
 
         ## finally define PDF 
         self.pdf     = self.pypdf
@@ -459,7 +522,8 @@ class PyPDF2(object) :
             'name'     : self.pypdf.GetName  () ,
             'title'    : self.pypdf.GetTitle () ,
             'function' : self.function          ,
-            'vars'     : self.variables                                           
+            'vars'     : self.variables         ,
+            'batch'    : self.batch 
             }
 
     @property
@@ -472,6 +536,11 @@ class PyPDF2(object) :
         """``function'' : get the actual python function/callable"""
         return self.__pyfunction
     
+    @property
+    def batch ( self ) :
+        """``batch'' : batch evaluation: None, True or the vectorized function/callable"""
+        return self.__batch
+    
     @property
     def variables  ( self ) :
         """``variables'' : list(ROOT.RooArgList) of all variables"""
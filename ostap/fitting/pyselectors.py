@@ -111,6 +111,13 @@ from   ostap.core.ostap_types   import num_types, string_types, integer_types
 from   ostap.core.meta_info     import old_PyROOT 
 import ostap.fitting.roofit 
 from   ostap.utils.progress_bar import ProgressBar
+try : 
+    from numpy import frombuffer    as _frombuffer
+    from numpy import ones          as _ones 
+    from numpy import count_nonzero as _count_nonzero
+    from numpy import flatnonzero   as _flatnonzero 
+except ImportError :
+    _frombuffer = None 
 # =============================================================================
 # logging 
 # =============================================================================
@@ -768,6 +775,11 @@ class SelectorWithVars(SelectorWithCuts) :
 
     - Get dataset  from the selector 
     >>> dataset = selector.data   
+
+    - Block mode: if all variables are defined via formulas and no python cuts are 
+    specified, the formulas are evaluated in C++ for the blocks of good entries, 
+    and python is invoked once per block (requires numpy and new PyROOT)
+    >>> selector = SelectorWithVars ( variables , selection = '...' , block = 10000 )
     """
     ## constructor 
     def __init__ ( self                            ,
@@ -779,7 +791,8 @@ class SelectorWithVars(SelectorWithCuts) :
                    fullname      = ''              ,
                    silence       = False           ,
                    tree          = ROOT.nullptr    ,
-                   logger        = logger          ) :
+                   logger        = logger          ,
+                   block         = 0               ) :  ## block size for the block mode 
         
         if not name :
             name = dsID ()
@@ -923,7 +936,18 @@ class SelectorWithVars(SelectorWithCuts) :
         self.__notifier = None
         self.__stat     = SelStat() 
         self.__last     = -1
-        
+
+        ## block mode ?
+        self.__block    = 0 
+        if block and 0 < block and _frombuffer and not old_PyROOT and not cuts \
+               and all ( v.formula for v in self.__variables ) :
+            formulas = ROOT.std.vector ( 'std::string' ) ()
+            for v in self.__variables : formulas.push_back ( v.formula )
+            self.set_block ( formulas , block )
+            self.__block = block 
+        elif block and not self.silence :
+            self.logger.warning ( "Selector(%s): block mode is not possible, use event-by-event mode" % self.name ) 
+            
     @property 
     def name ( self ) :
         """``name''  - the name of selector/dataset"""
@@ -970,6 +994,11 @@ class SelectorWithVars(SelectorWithCuts) :
         """``trivial_vars'' : are all variables ``trivial'' (suitable for fast-processing)?"""
         return self.__variables.trivial_vars
 
+    @property
+    def block ( self ) :
+        """``block'' : the size of the block for the block mode (0 for event-by-event mode)"""
+        return self.__block 
+
     @property
     def really_trivial ( self ) :
         """``really_trivial'' : is a set of variables really trivial (for RooFit)?"""
@@ -1100,6 +1129,44 @@ class SelectorWithVars(SelectorWithCuts) :
             
         return 1 
 
+    # =========================================================================
+    ## process the block of good entries (block mode)
+    #  The formulas for all variables are already evaluated in C++ 
+    #  @see Ostap::SelectorWithCuts::process_block
+    def process_block ( self ) :
+        """Process the block of good entries (block mode)
+        The formulas for all variables are already evaluated in C++
+        - see Ostap::SelectorWithCuts::process_block
+        """
+        n = self.block_rows ()
+        self.stat.processed += n 
+        
+        columns = [ _frombuffer ( self.block_column ( k ).data () , count = n , dtype = float )
+                    for k in range ( len ( self.__variables ) ) ]
+        
+        ## check the ranges
+        good = _ones ( n , dtype = bool )
+        for v , c in zip ( self.__variables , columns ) :
+            vmin , vmax = v.minmax
+            ok   = ( vmin <= c ) & ( c <= vmax )
+            bad  = int ( _count_nonzero ( good & ~ok ) )
+            if bad :
+                self.__skip [ v.name ] += bad  ## SKIP EVENTS 
+                self.stat.skipped      += bad  ## SKIP EVENTS 
+            good &= ok
+
+        ## fill the dataset 
+        vars = [ v.var for v in self.__variables ]
+        for i in _flatnonzero ( good ) :
+            for var , c in zip ( vars , columns ) : var.setVal ( float ( c [ i ] ) ) 
+            if ( not self.__roo_formula ) or self.__roo_formula.getVal() : 
+                self.__data .add ( self.varset )
+
+        if self.__progress and not self.silence :
+            self.__progress.update_amount ( self.event () )
+            
+        return True 
+        
     # =========================================================================
     ## ``callable'' interface 
     def __call__ ( self ,  entry ) :
@@ -1125,6 +1192,7 @@ class SelectorWithVars(SelectorWithCuts) :
         kw [ 'roo_cuts'  ] = self.roo_cuts
         kw [ 'cuts'      ] = self.morecuts
         kw [ 'silence'   ] = self.silence
+        kw [ 'block'     ] = self.block 
 
         kw.update ( kwargs )
         return SelectorWithVars ( **kw ) 
@@ -1380,6 +1448,7 @@ class SelectorWithVars(SelectorWithCuts) :
         #
         result = True 
         if self.formula() : result = self.formula().Notify()
+        if self.block     : self.notify_block () 
         # 
         if self.__progress and not self.silence :
             self.__progress.update_amount ( self.event () )
@@ -1394,6 +1463,9 @@ class SelectorWithVars(SelectorWithCuts) :
         - see Ostap::SelectorWithCuts::SlaveTerminate
         """
         
+        ## process the last (incomplete) block 
+        if self.block : self.flush_block () 
+        
         if self.roo_cuts :
             del self.__roo_formula
             self.__roo_formula = None
@@ -40,6 +40,7 @@ __all__     = (
     'var_gamma'      , ## gamma               function for RooAbsReal objects           
     'var_lgamma'     , ## logarithm of gamma  function for RooAbsReal objects           
     'var_igamma'     , ## 1/gamma             function for RooAbsReal objects
+    'var_fuse'       , ## fuse the arithmetic expression tree into the single node
     'scale_var'      , ## var_mul
     'add_var'        , ## var_sum
     'sum_var'        , ## var_sum
@@ -1360,6 +1361,36 @@ def var_pow ( v1 , v2 , name = '' , title = '' ) :
     #
     return Ostap.MoreRooFit.Power ( v1 , v2 , name , title ) 
 
+# =============================================================================
+## Fuse the arithmetic expression tree of RooAbsReal objects into the single node
+#  The nodes <code>Ostap::MoreRooFit::Addition</code>, <code>Product</code>,
+#  <code>Division</code>, <code>Exp</code>, ... are collapsed into the flat
+#  program, evaluated in one go (also in the batch mode) 
+#  @code
+#  a , b , c = ...
+#  e = var_sum ( var_exp ( a , b ) , c ) 
+#  f = var_fuse ( e )
+#  print ( f.listing() ) 
+#  @endcode
+#  @see Ostap::MoreRooFit::FusedVar
+def var_fuse ( v , name = '' , title = '' ) :
+    """Fuse the arithmetic expression tree of RooAbsReal objects into the single node
+    The nodes `Ostap.MoreRooFit.Addition`, `Product`, `Division`, `Exp`, ...
+    are collapsed into the flat program, evaluated in one go (also in the batch mode) 
+    >>> a , b , c = ...
+    >>> e = var_sum ( var_exp ( a , b ) , c ) 
+    >>> f = var_fuse ( e )
+    >>> print ( f.listing() )
+    - see Ostap.MoreRooFit.FusedVar
+    """
+    if isinstance ( v , num_types ) :
+        return ROOT.RooRealConstant.value ( float ( v ) )         ## RETURN
+    ## 
+    assert isinstance ( v , ROOT.RooAbsReal ) , "var_fuse: invalid type %s" % type ( v )
+    ## 
+    return Ostap.MoreRooFit.FusedVar ( name , title , v ) 
+    
+
 
 scale_var     = var_mul
 add_var       = var_sum
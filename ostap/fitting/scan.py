@@ -0,0 +1,376 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/fitting/scan.py
+#  Profile-likelihood scans with warm starts and adaptive refinement
+#  - NLL and minimizer are built only once
+#  - each scan point starts from the solution at the neighbouring point
+#  - the scan is refined near the minimum and near 1 and 2 sigma crossings
+#  - the scan points can be distributed among several processes
+#  @see ostap.parallel.parallel_scan
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Profile-likelihood scans with warm starts and adaptive refinement
+- NLL and minimizer are built only once
+- each scan point starts from the solution at the neighbouring point
+- the scan is refined near the minimum and near 1 and 2 sigma crossings
+- the scan points can be distributed among several processes
+- see ostap.parallel.parallel_scan
+"""
+# =============================================================================
+__author__  = 'Vanya BELYAEV  Ivan.Belyaev@itep.ru'
+__date__    = "2026-10-15"
+__version__ = '$Revision$'
+__all__     = (
+    "ProfileScan"    , ## engine for profile-likelihood scans
+    "profile_scan"   , ## make profile-likelihood scan
+    "refine_points"  , ## get new points for adaptive refinement of the scan
+    )
+# =============================================================================
+import ROOT
+from   ostap.fitting.variables import FIXVAR
+from   ostap.fitting.utils     import RangeVar
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger( 'ostap.fitting.scan' )
+else                       : logger = getLogger( __name__             )
+# =============================================================================
+## default levels for refinement: 1 and 2 sigma crossings for 1D profile
+refine_levels = ( 0.5 , 2.0 )
+# =============================================================================
+## @class ProfileScan
+#  Engine for profile-likelihood scans:
+#  - the NLL and minimizer are built only once
+#  - the scanned variable is fixed, all other parameters are minimized
+#  - each point starts from the provided (neighbour) solution
+#  @code
+#  engine = ProfileScan ( pdf , 'S' , dataset )
+#  points = engine.scan ( vrange ( 0 , 100 , 50 ) )
+#  @endcode
+class ProfileScan(object) :
+    """Engine for profile-likelihood scans:
+    - the NLL and minimizer are built only once
+    - the scanned variable is fixed, all other parameters are minimized
+    - each point starts from the provided (neighbour) solution
+    >>> engine = ProfileScan ( pdf , 'S' , dataset )
+    >>> points = engine.scan ( vrange ( 0 , 100 , 50 ) )
+    """
+    def __init__ ( self               ,
+                   pdf                , ## the PDF
+                   variable           , ## variable to scan
+                   dataset            , ## dataset
+                   fit_config = {}    , ## configuration for NLL&minimizer
+                   silent     = True  ) :
+
+        ## convert if needed
+        if not isinstance ( dataset , ROOT.RooAbsData ) and hasattr ( dataset , 'dset' ) :
+            dataset = dataset.dset
+
+        self.__pdf     = pdf
+        self.__dataset = dataset
+
+        pars = pdf.params ( dataset )
+        assert variable in pars , "ProfileScan: Variable %s is not a parameter" % variable
+        var  = variable if isinstance ( variable , ROOT.RooAbsReal ) else pars [ variable ]
+        self.__var     = var
+
+        ## floating parameters (except the scanned variable)
+        self.__floating = [ p for p in pars if not p.isConstant () and p.name != var.name ]
+
+        config = dict ( fit_config )
+        minuit_keys = ( 'max_calls' , 'max_iterations' , 'opt_const' ,
+                        'strategy'  , 'print_level'    , 'offset'    )
+        mconf = {}
+        for k in minuit_keys :
+            if k in config : mconf [ k ] = config.pop ( k )
+        mconf [ 'silent' ] = config.pop ( 'silent' , silent )
+        for k in ( 'refit' , 'draw' , 'nbins' , 'timer' , 'ncpu' , 'ncpus' ) : config.pop ( k , None )
+
+        self.__nll , self.__sf = pdf.nll    ( dataset , silent = True , **config )
+        self.__minimizer       = pdf.minuit ( nLL = self.__nll , **mconf )
+
+    # =========================================================================
+    ## get the current values of the floating parameters
+    def snapshot ( self ) :
+        """Get the current values of the floating parameters"""
+        return dict ( ( p.name , p.getVal () ) for p in self.__floating )
+
+    ## load the values of the floating parameters
+    def load ( self , pars ) :
+        """Load the values of the floating parameters"""
+        if not pars : return
+        for p in self.__floating :
+            if p.name in pars : p.setVal ( pars [ p.name ] )
+
+    # =========================================================================
+    ## perform the global minimization
+    #  @return ( value , nll , parameters )
+    def minimum ( self ) :
+        """Perform the global minimization
+        - return ( value , nll , parameters )
+        """
+        if self.__var.isConstant () :
+            return self.__var.getVal () , self.__nll.getVal () , self.snapshot ()
+        self.__minimizer.migrad ()
+        return self.__var.getVal () , self.__nll.getVal () , self.snapshot ()
+
+    # =========================================================================
+    ## minimize for the fixed value of the variable
+    #  @param value the value of the scanned variable
+    #  @param start the starting values for the floating parameters
+    #  @return ( nll , parameters )
+    def point ( self , value , start = None ) :
+        """Minimize for the fixed value of the variable
+        - value : the value of the scanned variable
+        - start : the starting values for the floating parameters
+        - return ( nll , parameters )
+        """
+        var = self.__var
+        self.load ( start )
+        with FIXVAR ( var ) :
+            var.setVal ( value )
+            if self.__floating : self.__minimizer.migrad ()
+            return self.__nll.getVal () , self.snapshot ()
+
+    # =========================================================================
+    ## scan the values with the warm starts:
+    #  the points are ordered by the distance from the <code>origin</code>
+    #  and each point starts from the solution of the previous one
+    #  @param values  the values of the scanned variable
+    #  @param origin  the starting point
+    #  @param start   the starting values for the floating parameters
+    #  @return list of  ( value , nll , parameters )
+    def scan ( self , values , origin = None , start = None , silent = True ) :
+        """Scan the values with the warm starts:
+        the points are ordered by the distance from the `origin`
+        and each point starts from the solution of the previous one
+        - values  : the values of the scanned variable
+        - origin  : the starting point
+        - start   : the starting values for the floating parameters
+        - return list of  ( value , nll , parameters )
+        """
+        values = sorted ( values )
+        if not values : return []
+
+        var  = self.__var
+        if origin is None : origin = var.getVal ()
+
+        ## split into two branches: walk away from the origin in both directions
+        left   = [ v for v in values if v <  origin ][::-1]
+        right  = [ v for v in values if v >= origin ]
+
+        vmin   = min ( values [  0 ] , var.getMin () ) if var.hasMin () else values [  0 ]
+        vmax   = max ( values [ -1 ] , var.getMax () ) if var.hasMax () else values [ -1 ]
+
+        if start is None : start = self.snapshot ()
+
+        results = []
+        from ostap.utils.progress_bar import progress_bar
+        with RangeVar ( var , vmin , vmax ) :
+            for branch in ( right , left ) :
+                pars = start
+                for v in progress_bar ( branch , silent = silent ) :
+                    nll , pars = self.point ( v , pars )
+                    results.append ( ( v , nll , pars ) )
+
+        results.sort ( key = lambda r : r [ 0 ] )
+        return results
+
+    # =========================================================================
+    ## solve the new points: each starts from the closest solved point
+    #  @param values  the values of the scanned variable
+    #  @param points  already solved points: list of ( value , nll , parameters )
+    #  @return list of  ( value , nll , parameters )
+    def solve ( self , values , points ) :
+        """Solve the new points: each starts from the closest solved point
+        - values  : the values of the scanned variable
+        - points  : already solved points: list of ( value , nll , parameters )
+        - return list of  ( value , nll , parameters )
+        """
+        var     = self.__var
+        allv    = list ( values ) + [ p [ 0 ] for p in points ]
+        vmin    = min ( allv )
+        vmax    = max ( allv )
+        if var.hasMin () : vmin = min ( vmin , var.getMin () )
+        if var.hasMax () : vmax = max ( vmax , var.getMax () )
+
+        results = []
+        with RangeVar ( var , vmin , vmax ) :
+            for v in values :
+                closest = min ( points , key = lambda p : abs ( p [ 0 ] - v ) )
+                nll , pars = self.point ( v , closest [ 2 ] )
+                results.append ( ( v , nll , pars ) )
+        return results
+
+    @property
+    def pdf ( self ) :
+        """``pdf'' : the PDF"""
+        return self.__pdf
+    @property
+    def variable ( self ) :
+        """``variable'' : the scanned variable"""
+        return self.__var
+    @property
+    def nll ( self ) :
+        """``nll'' : the (reused) NLL object"""
+        return self.__nll
+    @property
+    def sfactor ( self ) :
+        """``sfactor'' : the scale factor for the weighted datasets"""
+        return self.__sf
+
+# =============================================================================
+## get new points for the adaptive refinement of the scan:
+#  the middle points of the intervals around the minimum
+#  and the intervals, where the profile crosses the specified levels
+#  @param points list of ( value , nll , ... )
+#  @param levels the levels (relative to the minimum)
+#  @return sorted list of new points
+def refine_points ( points , levels = refine_levels ) :
+    """Get new points for the adaptive refinement of the scan:
+    the middle points of the intervals around the minimum
+    and the intervals, where the profile crosses the specified levels
+    - points : list of ( value , nll , ... )
+    - levels : the levels (relative to the minimum)
+    - return sorted list of new points
+    """
+    points = sorted ( points , key = lambda p : p [ 0 ] )
+    N = len ( points )
+    if N < 2 : return []
+
+    ymin = min ( p [ 1 ] for p in points )
+    imin = min ( range ( N ) , key = lambda i : points [ i ] [ 1 ] )
+
+    intervals = set ()
+    for j in ( imin - 1 , imin ) :
+        if 0 <= j < N - 1 : intervals.add ( j )
+
+    for j in range ( N - 1 ) :
+        y1 = points [ j     ] [ 1 ] - ymin
+        y2 = points [ j + 1 ] [ 1 ] - ymin
+        for l in levels :
+            if ( y1 - l ) * ( y2 - l ) < 0 : intervals.add ( j )
+
+    return sorted ( 0.5 * ( points [ j ] [ 0 ] + points [ j + 1 ] [ 0 ] ) for j in intervals )
+
+# =============================================================================
+## make the profile-likelihood scan
+#  @code
+#  pdf   = ...
+#  graph = profile_scan ( pdf , 'S' , vrange ( 0 , 100 , 100 ) , dataset )
+#  graph = profile_scan ( pdf , 'S' , vrange ( 0 , 100 , 100 ) , dataset , nsplit = 8 )
+#  spline = graph.spline3()
+#  @endcode
+#  - the global minimum is found first
+#  - scan points start from the neighbour solution (warm start)
+#  - the scan is refined (<code>refine</code> iterations) near the minimum and
+#    near the levels <code>levels</code> (1 and 2 sigma crossings)
+#  - for <code>nsplit>1</code> the scan points are distributed among the processes
+#  @param pdf        the PDF
+#  @param variable   variable to scan
+#  @param values     the values to scan
+#  @param dataset    the dataset
+#  @param refine     number of refinement iterations
+#  @param levels     levels for refinement
+#  @param nsplit     split the scan into <code>nsplit</code> parallel jobs
+#  @param subtract   subtract the minimum?
+#  @param fit_config configuration for NLL&minimizer
+#  @return the graph, use <code>graph.spline3()</code> for interpolation
+#  @see ProfileScan
+def profile_scan ( pdf                      ,
+                   variable                 ,
+                   values                   ,
+                   dataset                  ,
+                   refine     = 2           ,
+                   levels     = refine_levels ,
+                   nsplit     = 1           ,
+                   subtract   = True        ,
+                   silent     = True        ,
+                   fit_config = {}          , **kwargs ) :
+    """Make the profile-likelihood scan
+    >>> pdf   = ...
+    >>> graph = profile_scan ( pdf , 'S' , vrange ( 0 , 100 , 100 ) , dataset )
+    >>> graph = profile_scan ( pdf , 'S' , vrange ( 0 , 100 , 100 ) , dataset , nsplit = 8 )
+    >>> spline = graph.spline3()
+    - the global minimum is found first
+    - scan points start from the neighbour solution (warm start)
+    - the scan is refined (`refine` iterations) near the minimum and
+    near the levels `levels` (1 and 2 sigma crossings)
+    - for `nsplit>1` the scan points are distributed among the processes
+    - return the graph, use `graph.spline3()` for interpolation
+    - see ProfileScan
+    """
+
+    values = sorted ( set ( float ( v ) for v in values ) )
+    assert values , 'profile_scan: no points are specified!'
+
+    from ostap.fitting.funbasic import SETPARS
+
+    with SETPARS ( pdf , dataset ) :
+
+        engine = ProfileScan ( pdf , variable , dataset , fit_config = fit_config , silent = silent )
+        var    = engine.variable
+
+        ## 1) global minimum
+        x0 , nll0 , pars0 = engine.minimum ()
+
+        ## 2) the initial scan
+        if 1 < nsplit and 1 < len ( values ) :
+            from ostap.parallel.parallel_scan import parallel_scan
+            points = parallel_scan ( pdf        = pdf        ,
+                                     variable   = var.name   ,
+                                     values     = values     ,
+                                     dataset    = dataset    ,
+                                     origin     = x0         ,
+                                     start      = pars0      ,
+                                     nsplit     = nsplit     ,
+                                     fit_config = fit_config ,
+                                     silent     = silent     , **kwargs )
+        else :
+            points = engine.scan ( values , origin = x0 , start = pars0 , silent = silent )
+
+        ## the global minimum is also a point of the profile
+        if values [ 0 ] <= x0 <= values [ -1 ] and not x0 in values :
+            points.append ( ( x0 , nll0 , pars0 ) )
+
+        ## 3) adaptive refinement
+        ninitial = len ( points ) 
+        for i in range ( refine ) :
+            new = [ v for v in refine_points ( points , levels ) if not v in values ]
+            if not new : break
+            points += engine.solve ( new , points )
+            values += new 
+
+    points.sort ( key = lambda p : p [ 0 ] )
+
+    ## 4) create the graph
+    import ostap.histos.graphs
+    graph = ROOT.TGraph ( len ( points ) )
+    ymin  = min ( p [ 1 ] for p in points )
+    for i , p in enumerate ( points ) :
+        graph [ i ] = p [ 0 ] , p [ 1 ]
+
+    if subtract : graph -= ymin
+
+    sf = engine.sfactor
+    if 1 != sf :
+        logger.info ( 'profile_scan: apply scale factor of %.5g due to dataset weights' % sf )
+        graph *= sf
+
+    if not silent :
+        logger.info ( 'profile_scan: %d points (%d from refinement)' % ( len ( points ) , len ( points ) - ninitial ) )
+
+    return graph
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
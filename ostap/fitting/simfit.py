@@ -425,7 +425,9 @@ class Sim1D(PDF) :
     #  r,f = model.fitTo ( dataset , weighted = True )    
     #  r,f = model.fitTo ( dataset , ncpu     = 10   )    
     #  r,f = model.fitTo ( dataset , draw = 'signal' , nbins = 300 )    
+    #  r,f = model.fitTo ( dataset , nthreads = 8   ) ## multi-threaded NLL 
     #  @endcode 
+    #  @see Ostap::MoreRooFit::ParallelNLL 
     def fitTo ( self           ,
                 dataset        ,
                 draw   = False ,
@@ -433,6 +435,7 @@ class Sim1D(PDF) :
                 silent = False ,
                 refit  = False ,
                 timer  = False ,
+                nthreads = 1   , 
                 args   = ()    , **kwargs ) :
         """
         Perform the actual fit (and draw it)
@@ -440,18 +443,28 @@ class Sim1D(PDF) :
         >>> r,f = model.fitTo ( dataset , weighted = True )    
         >>> r,f = model.fitTo ( dataset , ncpu     = 10   )    
         >>> r,f = model.fitTo ( dataset , draw = 'signal' , nbins = 300 )    
+        >>> r,f = model.fitTo ( dataset , nthreads = 8   ) ## multi-threaded NLL 
+        - for `nthreads != 1' the categories and chunks of events are 
+        evaluated in the threads using Ostap::MoreRooFit::ParallelNLL 
         """
         assert self.sample in dataset      ,\
                'Category %s is not in dataset' % self.sample.GetName()
 
-        res , frame = PDF.fitTo ( self ,
-                                  dataset = dataset ,
-                                  draw    = False   , ## ATTENTION! False is here! 
-                                  nbins   = nbins   ,
-                                  silent  = silent  ,
-                                  refit   = refit   ,
-                                  timer   = timer   , 
-                                  args    = args    , **kwargs )
+        if 1 != nthreads :
+            res , frame = PDF.mtfitTo ( self ,
+                                        dataset  = dataset  ,
+                                        nthreads = nthreads ,
+                                        draw     = False    , 
+                                        silent   = silent   )
+        else : 
+            res , frame = PDF.fitTo ( self ,
+                                    dataset = dataset ,
+                                    draw    = False   , ## ATTENTION! False is here! 
+                                    nbins   = nbins   ,
+                                    silent  = silent  ,
+                                    refit   = refit   ,
+                                    timer   = timer   , 
+                                    args    = args    , **kwargs )
         
         if   not draw                 : return res , None 
         elif not draw in self.samples :
@@ -810,7 +823,9 @@ class SimFit ( MakeVar ) :
     #  r,f = model.fitTo ( dataset , weighted = True )    
     #  r,f = model.fitTo ( dataset , ncpu     = 10   )    
     #  r,f = model.fitTo ( dataset , draw = 'signal' , nbins = 300 )    
+    #  r,f = model.fitTo ( dataset , nthreads = 8   ) ## multi-threaded NLL 
     #  @endcode 
+    #  @see Ostap::MoreRooFit::ParallelNLL 
     def fitTo ( self           ,
                 dataset        ,
                 draw   = False ,
@@ -818,6 +833,7 @@ class SimFit ( MakeVar ) :
                 silent = False ,
                 refit  = False ,
                 timer  = False ,
+                nthreads = 1   , 
                 args   = ()    , **kwargs ) :
         """
         Perform the actual fit (and draw it optionally)
@@ -825,6 +841,9 @@ class SimFit ( MakeVar ) :
         >>> r,f = model.fitTo ( dataset , weighted = True )    
         >>> r,f = model.fitTo ( dataset , ncpu     = 10   )    
         >>> r,f = model.fitTo ( dataset , draw = 'signal' , nbins = 300 )    
+        >>> r,f = model.fitTo ( dataset , nthreads = 8   ) ## multi-threaded NLL 
+        - for `nthreads != 1' the categories and chunks of events are 
+        evaluated in the threads using Ostap::MoreRooFit::ParallelNLL 
         """
         assert self.sample in dataset      ,\
                'Category %s is not in dataset' % self.sample.GetName()
@@ -836,6 +855,7 @@ class SimFit ( MakeVar ) :
             silent  = silent  ,
             refit   = refit   ,
             timer   = timer   , 
+            nthreads = nthreads , 
             args    = args    , **kwargs )
         
         if   not draw                  : return res , None
@@ -0,0 +1,103 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+# @file ostap/fitting/tests/test_fitting_async.py
+# Test module for the asynchronous fits
+# - It tests ostap.fitting.fitasync and PDF.fitTo_async
+# =============================================================================
+""" Test module for the asynchronous fits
+- It tests ostap.fitting.fitasync and PDF.fitTo_async
+"""
+# =============================================================================
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# =============================================================================
+import ROOT, random
+import ostap.fitting.roofit
+import ostap.fitting.models    as     Models
+from   ostap.core.core         import VE, dsID
+from   ostap.fitting.fitasync  import gather, fit_pool
+from   ostap.utils.timing      import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ :
+    logger = getLogger ( 'ostap/fitting/tests/test_fitting_async' )
+else :
+    logger = getLogger ( __name__ )
+# =============================================================================
+mass = ROOT.RooRealVar ( 'test_mass_async' , 'Some test mass' , 2.5 , 3.5 )
+mmin , mmax = mass.minmax()
+
+m0      = VE ( 3.100 , 0.015**2 )
+varset  = ROOT.RooArgSet  ( mass )
+datasets = []
+for NS , NB in ( ( 1000 , 2000 ) , ( 500 , 1000 ) , ( 2000 , 500 ) , ( 300 , 3000 ) ) :
+    dataset = ROOT.RooDataSet ( dsID () , 'Test data' , varset )
+    for i in range ( NS ) :
+        mass.setVal ( m0.gauss () )
+        dataset.add ( varset )
+    for i in range ( NB ) :
+        mass.setVal ( random.uniform ( mmin , mmax ) )
+        dataset.add ( varset )
+    datasets.append ( dataset )
+
+signal = Models.Gauss_pdf ( 'G' , xvar = mass , mean = ( 3.1 , 3.0 , 3.2 ) , sigma = ( 0.015 , 0.005 , 0.05 ) )
+model  = Models.Fit1D     ( signal = signal , background = 'e-' , suffix = '_async' )
+
+# =============================================================================
+## asynchronous fits give the same results as the sequential ones
+def test_fit_async () :
+
+    logger = getLogger ( 'test_fit_async' )
+
+    fit_pool ( ncpus = 2 )
+
+    def reset ( ds ) :
+        model.S     = 0.5 * len ( ds )
+        model.B     = 0.5 * len ( ds )
+        signal.mean = 3.1
+        signal.sigma.setVal ( 0.015 )
+
+    ## start the asynchronous fits
+    futures = []
+    with timing ( 'Asynchronous fits (submit)' , logger = logger ) :
+        for ds in datasets :
+            reset ( ds )
+            futures.append ( model.fitTo_async ( ds , silent = True ) )
+
+    ## the sequential fits in the meantime
+    sequential = []
+    with timing ( 'Sequential   fits'          , logger = logger ) :
+        for ds in datasets :
+            reset ( ds )
+            r , _ = model.fitTo ( ds , silent = True )
+            sequential.append ( r )
+
+    with timing ( 'Asynchronous fits (gather)' , logger = logger ) :
+        results = gather ( futures )
+
+    for ( r1 , f ) , r2 in zip ( results , sequential ) :
+        assert 0 == r1.status () , 'Asynchronous fit failed!'
+        S1 = r1.param ( model.S.name ) [ 0 ]
+        S2 = r2.param ( model.S.name ) [ 0 ]
+        logger.info ( 'S: asynchronous %s, sequential %s' % ( S1 , S2 ) )
+        assert abs ( S1.value () - S2.value () ) < 0.01 * S2.error () , 'Asynchronous and sequential fits differ!'
+
+    ## the original model is not modified by the asynchronous fits,
+    #  but the parameters can be loaded
+    model.load_params ( results [ 0 ] [ 0 ] , silent = True )
+    assert abs ( model.S.getVal () - results [ 0 ] [ 0 ].param ( model.S.name ) [ 0 ].value () ) < 1.e-6 , \
+           'Parameters are not loaded!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_fit_async ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+## @file ostap/fitting/tests/test_fitting_batch.py
+# Test module for the batch evaluation of Ostap PDFs in RooFit
+# - the batch (vectorized) NLL must coincide with the scalar one
+# - the batch evaluation of Ostap PDFs must be actually used
+# =============================================================================
+""" Test module for the batch evaluation of Ostap PDFs in RooFit
+- the batch (vectorized) NLL must coincide with the scalar one
+- the batch evaluation of Ostap PDFs must be actually used
+"""
+# =============================================================================
+import ROOT, random
+from   ostap.core.pyrouts     import Ostap
+import ostap.fitting.roofit
+# ============================================================================
+from   ostap.logger.logger    import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.test_fitting_batch' )
+else                       : logger = getLogger ( __name__                   )
+# ============================================================================
+
+# =============================================================================
+## the option to activate the batch evaluation of NLL
+def batch_option () :
+    """The option to activate the batch evaluation of NLL"""
+    if hasattr ( ROOT.RooFit , 'EvalBackend' ) : return ROOT.RooFit.EvalBackend ( 'cpu' )
+    return ROOT.RooFit.BatchMode ( True )
+
+# =============================================================================
+## compare the batch and scalar NLL and check that the batch evaluation is used
+def test_batch_nll () :
+    """Compare the batch and scalar NLL and check that the batch evaluation is used
+    """
+
+    logger = getLogger ( 'test_batch_nll' )
+
+    if not Ostap.Utils.BatchCompute.supported () :
+        logger.warning ( 'Batch evaluation is not supported for ROOT %s' % ROOT.gROOT.GetVersion () )
+        return
+
+    x      = ROOT.RooRealVar ( 'x'      , 'x'       , 0  , 10 )
+    mean   = ROOT.RooRealVar ( 'mean'   , 'mean'    , 5  , 4 , 6 )
+    sigmaL = ROOT.RooRealVar ( 'sigmaL' , 'sigma_L' , 1  , 0.1 , 3 )
+    sigmaR = ROOT.RooRealVar ( 'sigmaR' , 'sigma_R' , 2  , 0.1 , 3 )
+    nu     = ROOT.RooRealVar ( 'nu'     , 'nu'      , 3  , 1 , 10 )
+
+    pdfs = [
+        Ostap.Models.BifurcatedGauss ( 'bg' , 'BifurcatedGauss' , x , mean , sigmaL , sigmaR ) ,
+        Ostap.Models.StudentT        ( 'st' , 'StudentT'        , x , mean , sigmaL , nu     ) ,
+        ]
+
+    N       = 1000
+    varset  = ROOT.RooArgSet ( x )
+    dataset = ROOT.RooDataSet ( 'ds' , 'dataset' , varset )
+    while len ( dataset ) < N :
+        v = random.gauss ( 5 , 1.5 )
+        if 0 < v < 10 :
+            x.setVal ( v )
+            dataset.add ( varset )
+
+    for pdf in pdfs :
+
+        nll_scalar = pdf.createNLL ( dataset )
+        nll_batch  = pdf.createNLL ( dataset , batch_option () )
+
+        Ostap.Utils.BatchCompute.reset ()
+
+        vs = nll_scalar.getVal ()
+        vb = nll_batch .getVal ()
+
+        calls   = Ostap.Utils.BatchCompute.calls   ()
+        entries = Ostap.Utils.BatchCompute.entries ()
+        delta   = abs ( vs - vb ) / max ( 1.0 , abs ( vs ) )
+
+        logger.info ( '%-16s : NLL scalar/batch %.10g/%.10g, batch calls/entries %d/%d' % (
+            pdf.GetTitle () , vs , vb , calls , entries ) )
+
+        assert 0 < calls    , 'Batch evaluation is not used for %s'        % pdf.GetTitle ()
+        assert N <= entries , 'Not all entries are evaluated in batch for %s' % pdf.GetTitle ()
+        assert delta < 1.e-8, 'Batch and scalar NLL differ for %s'          % pdf.GetTitle ()
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_batch_nll ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
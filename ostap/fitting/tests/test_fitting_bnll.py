@@ -0,0 +1,101 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+# @file ostap/fitting/tests/test_fitting_bnll.py
+# Test module for the native binned likelihood fits of histograms
+# - It tests Ostap::MoreRooFit::BinnedNLL and PDF.bnllfitTo
+# =============================================================================
+""" Test module for the native binned likelihood fits of histograms
+- It tests Ostap::MoreRooFit::BinnedNLL and PDF.bnllfitTo
+"""
+# =============================================================================
+from   __future__           import print_function
+# =============================================================================
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# =============================================================================
+import ROOT, random
+import ostap.fitting.roofit
+import ostap.fitting.models as     Models
+from   ostap.core.core      import VE, hID, Ostap
+from   ostap.fitting.utils  import RangeVar
+from   ostap.utils.timing   import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ :
+    logger = getLogger ( 'ostap/fitting/tests/test_fitting_bnll' )
+else :
+    logger = getLogger ( __name__ )
+# =============================================================================
+logger.info ( 'Test for the native binned likelihood fits')
+# =============================================================================
+mass = ROOT.RooRealVar ( 'test_mass_bnll' , 'Some test mass' , 2.5 , 3.5 )
+mmin , mmax = mass.minmax()
+
+m0   = VE ( 3.100 , 0.015**2 )
+NS   = 5000
+NB   = 5000
+
+histo = ROOT.TH1D ( hID() , '' , 100 , mmin , mmax )
+for i in range ( NS ) : histo.Fill ( m0.gauss () )
+for i in range ( NB ) : histo.Fill ( random.uniform ( mmin , mmax ) )
+
+# =============================================================================
+## the native binned likelihood vs the regular fit
+def test_bnll () :
+
+    logger = getLogger ( 'test_bnll' )
+
+    signal = Models.Gauss_pdf ( 'G' , xvar = mass , mean = ( 3.1 , 3.0 , 3.2 ) , sigma = ( 0.015 , 0.005 , 0.05 ) )
+    model  = Models.Fit1D     ( signal = signal , background = 'e-' , suffix = '_bnll' )
+
+    model.S = NS
+    model.B = NB
+    with timing ( 'Regular fit' , logger = logger ) :
+        r1 , _ = model.fitHisto ( histo , silent = True )
+    S1 , B1 = model.S.as_VE () , model.B.as_VE ()
+
+    model.S = NS
+    model.B = NB
+    with timing ( 'Native  fit' , logger = logger ) :
+        r2 , _ = model.fitHisto ( histo , silent = True , native = True )
+    S2 , B2 = model.S.as_VE () , model.B.as_VE ()
+
+    logger.info ( 'Regular fit result:\n%s' % r1.table ( prefix = '# ' ) )
+    logger.info ( 'Native  fit result:\n%s' % r2.table ( prefix = '# ' ) )
+
+    assert 0 == r2.status () , 'Native fit: invalid status %s' % r2.status ()
+    for a , b in ( ( S1 , S2 ) , ( B1 , B2 ) ) :
+        assert abs ( a.value () - b.value () ) <= 0.5 * b.error () , \
+               'Native fit: results differ %s vs %s' % ( a , b )
+        assert abs ( a.error () - b.error () ) <= 0.2 * b.error () , \
+               'Native fit: uncertainties differ %s vs %s' % ( a , b )
+
+    ## the bin integrals are not recalculated for the yields
+    with RangeVar ( mass , *histo.xminmax () ) :
+        nll  = Ostap.MoreRooFit.BinnedNLL ( 'nll' , '' , mass , model.alist1 , model.alist2 , histo )
+        v1   = nll.getVal ()
+        n1   = nll.recalculations ()
+        model.S = 1.1 * model.S.getVal ()
+        v2   = nll.getVal ()
+        assert n1 == nll.recalculations ()          , 'Bin integrals are recalculated for new yields!'
+        assert v1 <  v2                             , 'NLL minimum is not at the fit result!'
+        signal.sigma = 1.1 * signal.sigma.getVal ()
+        nll.getVal ()
+        assert n1 + 1 == nll.recalculations ()      , 'Bin integrals are not recalculated for signal!'
+        s = sum ( nll.expected ( i ) for i in range ( nll.nBins () ) )
+        assert abs ( s - model.S.getVal () - model.B.getVal () ) < 1.e-3 * s , 'Invalid expectations!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    with timing ( "BinnedNLL" , logger ) :
+        test_bnll ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
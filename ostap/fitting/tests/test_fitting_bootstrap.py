@@ -96,10 +96,40 @@ def test_bootstrap  ( ) :
     time.sleep ( 2 ) 
 
 
+# ==============================================================================
+## Perform Poisson boostrap study using the weighted view of the dataset (no copies)
+def test_bootstrap_view  ( ) :
+    """Perform Poisson boostrap study using the weighted view of the dataset (no copies)
+    """
+
+    logger = getLogger ( 'test_bootstrap_view' )
+
+    N = 200 
+    dataset = model.generate ( N , sample = False )
+    
+    res , f = model.fitTo ( dataset , silent = True , refit = 5 )
+
+    with timing ( 'Bootstrap with view' , logger = logger ) : 
+        results , stats = Toys.make_bootstrap (
+            pdf         = model    ,
+            size        = 400      , 
+            data        = dataset  , 
+            fit_pars    = { 'mean_G' : 0.4  , 'sigma_G' : 0.1 } ,
+            view        = True     , 
+            silent      = True     ,
+            progress    = True     ,
+            frequency   = 100      )
+        
+    res , f = model.fitTo ( dataset , silent = True , refit = 5 )
+    Toys.print_bootstrap ( res , stats , logger = logger )
+
+    assert N == len ( dataset ) , 'The original dataset is modified!'
+    
 # =============================================================================
 if '__main__' == __name__ :
 
-    test_bootstrap ( )
+    test_bootstrap      ( )
+    test_bootstrap_view ( )
 
     
 # =============================================================================
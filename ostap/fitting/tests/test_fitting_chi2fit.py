@@ -0,0 +1,131 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+# @file ostap/fitting/tests/test_fitting_chi2fit.py
+# Test module for ostap/fitting/chi2fit.py
+# - It tests the template fits with Ostap::Math::Chi2Fit and Ostap::Math::Chi2Solver
+# =============================================================================
+""" Test module for ostap/fitting/chi2fit.py
+- It tests the template fits with Ostap::Math::Chi2Fit and Ostap::Math::Chi2Solver
+"""
+# =============================================================================
+from   __future__               import print_function
+# =============================================================================
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# =============================================================================
+import ROOT, random, math
+import ostap.fitting.chi2fit
+from   ostap.fitting.chi2fit    import C2FIT, C2SOLVER
+from   ostap.core.core          import VE, hID, Ostap
+from   ostap.utils.timing       import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ :
+    logger = getLogger ( 'ostap/fitting/tests/test_fitting_chi2fit' )
+else :
+    logger = getLogger ( __name__ )
+# =============================================================================
+logger.info ( 'Test for template fits with Chi2Fit/Chi2Solver')
+# =============================================================================
+NB     = 50
+shapes = (
+    lambda x : math.exp ( -0.5 * ( ( x - 0.3 ) / 0.10 ) ** 2 ) ,
+    lambda x : math.exp ( -0.5 * ( ( x - 0.6 ) / 0.15 ) ** 2 ) ,
+    lambda x : 1.0 - 0.5 * x                                   ,
+    )
+yields = 1000 , 500 , 200
+
+# =============================================================================
+## the template fit of the histogram
+def test_chi2fit () :
+
+    logger = getLogger ( 'test_chi2fit' )
+
+    templates = [ ROOT.TH1D ( hID() , '' , NB , 0 , 1 ) for s in shapes ]
+    histo     =   ROOT.TH1D ( hID() , '' , NB , 0 , 1 )
+    for i in range ( 1 , NB + 1 ) :
+        x = histo.GetBinCenter ( i )
+        m = 0
+        for t , s , y in zip ( templates , shapes , yields ) :
+            t.SetBinContent ( i , s ( x ) )
+            t.SetBinError   ( i , 0     )
+            m += y * s ( x )
+        histo.SetBinContent ( i , random.gauss ( m , math.sqrt ( m ) ) )
+        histo.SetBinError   ( i , math.sqrt ( m ) )
+
+    r1 = histo.hFit ( templates , interpolate = False )
+    r2 = histo.hFit ( templates , interpolate = False , nthreads = 2 )
+
+    logger.info ( 'Chi2Fit result:\n%s' % r1 )
+    assert r1.status().isSuccess() , 'Chi2Fit: invalid status %s' % r1.status()
+    assert 0 == r1.niters ()       , 'Chi2Fit: the linear problem is solved directly'
+    for i , y in enumerate ( yields ) :
+        assert abs ( r1 [ i ].value () - r2 [ i ].value () ) <= 1.e-8 * ( 1 + abs ( y ) ) , \
+               'Results depend on the number of threads!'
+        assert abs ( r1 [ i ].value () - y ) <= 5 * r1 [ i ].error () , \
+               'Chi2Fit: invalid yield %s vs %s' % ( r1 [ i ] , y )
+
+    ## the same with the uncertainties of templates
+    for t in templates :
+        for i in range ( 1 , NB + 1 ) : t.SetBinError ( i , 0.02 * t.GetBinContent ( i ) )
+    r3 = histo.hFit ( templates , interpolate = False )
+    logger.info ( 'Chi2Fit result (template errors):\n%s' % r3 )
+    assert r3.status().isSuccess() , 'Chi2Fit: invalid status %s' % r3.status()
+    for i in range ( len ( yields ) ) :
+        assert r1 [ i ].error () <= r3 [ i ].error () , 'Template errors must increase uncertainties!'
+
+# =============================================================================
+## batch fits with the same templates
+def test_chi2solver () :
+
+    logger = getLogger ( 'test_chi2solver' )
+
+    DATA = VE.Vector
+    CMPS = DATA.Vector
+
+    xs   = [ ( i + 0.5 ) / NB for i in range ( NB ) ]
+    cmps = CMPS ()
+    for s in shapes :
+        c = DATA ()
+        for x in xs : c.push_back ( VE ( s ( x ) , 0 ) )
+        cmps.push_back ( c )
+
+    expected = [ sum ( y * s ( x ) for s , y in zip ( shapes , yields ) ) for x in xs ]
+    weights  = Ostap.Math.Chi2Solver.Data ()
+    for m in expected : weights.push_back ( 1.0 / m )
+
+    solver   = C2SOLVER ( cmps , weights , True )
+    assert solver.status().isSuccess() , 'Chi2Solver: invalid status %s' % solver.status()
+
+    vectors  = [ [ random.gauss ( m , math.sqrt ( m ) ) for m in expected ] for n in range ( 100 ) ]
+    with timing ( 'Chi2Solver: %d fits' % len ( vectors ) , logger = logger ) :
+        params , chi2s = solver.solve_array ( vectors )
+
+    for i , y in enumerate ( yields ) :
+        mean = sum ( params [ n ][ i ] for n in range ( len ( vectors ) ) ) / len ( vectors )
+        err  = math.sqrt ( solver.cov2 ( i , i ) / len ( vectors ) )
+        logger.info ( 'Yield %d: %.2f vs %.2f (+-%.2f)' % ( i , mean , y , err ) )
+        assert abs ( mean - y ) <= 5 * err , 'Chi2Solver: invalid mean yield'
+
+    ## single fit with uncertainties
+    data = Ostap.Math.Chi2Solver.Data ()
+    for v in vectors [ 0 ] : data.push_back ( v )
+    for p in solver.solve ( data ) :
+        assert 0 <= p.value () , 'Chi2Solver: negative yield for nonnegative fit!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    with timing ( "Chi2Fit"    , logger ) :
+        test_chi2fit    ()
+    with timing ( "Chi2Solver" , logger ) :
+        test_chi2solver ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
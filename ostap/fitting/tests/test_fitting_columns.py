@@ -0,0 +1,134 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developers.
+# ============================================================================= 
+# @file test_fitting_columns.py
+# Test module for columnar snapshots of datasets 
+# @see ds_to_columns
+# @see ds_from_columns
+# ============================================================================= 
+""" Test module for columnar snapshots of datasets 
+- see ds_to_columns
+- see ds_from_columns
+"""
+# ============================================================================= 
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# ============================================================================= 
+import ROOT, random
+from   builtins                 import range
+import ostap.fitting.roofit
+from   ostap.core.core          import Ostap 
+from   ostap.fitting.dataset    import ds_from_columns 
+from   ostap.utils.timing       import timing 
+import ostap.utils.cleanup      as     CU 
+# =============================================================================
+# logging 
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ : 
+    logger = getLogger ( 'test_fitting_columns' )
+else : 
+    logger = getLogger ( __name__              )
+# =============================================================================
+
+x = ROOT.RooRealVar ( 'x' , 'x-variable' , 0 , 10 )
+y = ROOT.RooRealVar ( 'y' , 'y-variable' , 0 , 10 )
+w = ROOT.RooRealVar ( 'w' , 'weight'     , 0 , 10 )
+N = 10000 
+
+data = ROOT.RooDataSet ( 'data' , 'test data' , ROOT.RooArgSet ( x , y , w ) )
+for i in range ( N ) :
+    x.setVal ( random.uniform ( 0 , 10 ) )
+    y.setVal ( random.gauss   ( 5 ,  1 ) % 10 )
+    w.setVal ( random.uniform ( 0 ,  2 ) )
+    data.add ( ROOT.RooArgSet ( x , y , w ) )
+    
+# =============================================================================
+## store&load non-weighted dataset
+def test_columns1 () :
+
+    logger = getLogger ( 'test_columns1' )
+    
+    dirname = CU.CleanUp.tempdir ()
+    with timing ( 'store' , logger = logger ) : 
+        n = data.to_columns ( dirname )
+    with timing ( 'load'  , logger = logger ) : 
+        ds = ds_from_columns ( dirname )
+
+    assert n == len ( data ) == len ( ds ) , 'Invalid number of entries!'
+    for v in ( 'x' , 'y' , 'w' ) :
+        s1 = data.statVar ( v )
+        s2 = ds  .statVar ( v )
+        assert s1.mean() == s2.mean() and s1.rms() == s2.rms() , \
+               "Invalid statistics for `%s': %s vs %s" % ( v , s1 , s2 ) 
+    logger.info ( 'Dataset is reloaded:\n%s' % ds.table ( prefix = '# ' ) )
+    
+# =============================================================================
+## store&load weighted dataset with cuts and subset of variables 
+def test_columns2 () :
+
+    logger = getLogger ( 'test_columns2' )
+
+    wdata   = data.makeWeighted ( 'w' )
+    dirname = CU.CleanUp.tempdir ()
+    n  = wdata.to_columns ( dirname , variables = 'x,y' , cuts = 'x<5' )
+    ds = ds_from_columns ( dirname , variables = 'x' )
+
+    assert ds.isWeighted ()         , 'Dataset must be weighted!'
+    assert n == len ( ds )          , 'Invalid number of entries!'
+    assert not 'y' in ds            , 'Variable y must not be loaded!'
+    
+    s1 = wdata.statVar ( 'x' , 'x<5' )
+    s2 = ds   .statVar ( 'x' )
+    assert abs ( s1.mean() - s2.mean() ) < 1.e-9 * abs ( s1.mean() ) , \
+           'Invalid statistics: %s vs %s' % ( s1 , s2 ) 
+    logger.info ( 'Weighted dataset is reloaded:\n%s' % ds.table ( prefix = '# ' ) )
+
+# =============================================================================
+## compact (single-precision) storage of dataset 
+def test_columns3 () :
+
+    logger = getLogger ( 'test_columns3' )
+
+    compact = Ostap.Utils.CompactData ( data , [ 'y' ] )
+    
+    assert len ( data ) == compact.size ()            , 'Invalid number of entries!'
+    assert compact.isFloat ( compact.column ( 'x' ) ) , 'Column x must be single precision!'
+    assert not compact.isFloat ( compact.column ( 'y' ) ) , 'Column y must be double precision!'
+    assert compact.memory () < 3 * 8 * len ( data )   , 'Data are not compact!'
+    
+    ix = compact.column ( 'x' )
+    iy = compact.column ( 'y' )
+    for i in range ( 0 , len ( data ) , 100 ) :
+        entry = data.get ( i )
+        vx    = entry.find ( 'x' ).getVal ()
+        vy    = entry.find ( 'y' ).getVal ()
+        assert abs ( compact.value ( ix , i ) - vx ) <= 1.e-6 * abs ( vx ) , 'Invalid float value!'
+        assert       compact.value ( iy , i ) == vy  , 'Invalid double value!'
+
+    ## NLL with the compact data is the same as for dataset
+    mu    = ROOT.RooRealVar  ( 'mu_c'    , 'mean'  , 5 , 0 , 10 )
+    sigma = ROOT.RooRealVar  ( 'sigma_c' , 'sigma' , 1 , 0.1 , 5 )
+    gauss = ROOT.RooGaussian ( 'gauss_c' , 'gauss' , y , mu , sigma )
+    
+    nll1 = Ostap.MoreRooFit.ParallelNLL ( 'nll1' , 'nll' , gauss , data    , False , 2 , 1000 )
+    nll2 = Ostap.MoreRooFit.ParallelNLL ( 'nll2' , 'nll' , gauss , compact , False , 2 , 1000 )
+    
+    v1 = nll1.getVal ()
+    v2 = nll2.getVal ()
+    assert abs ( v1 - v2 ) <= 1.e-9 * abs ( v1 ) , 'Mismatch in NLL: %s vs %s' % ( v1 , v2 ) 
+
+    logger.info ( 'Compact data: %d entries, %d bytes, NLL=%.4f' % ( compact.size () , compact.memory () , v2 ) ) 
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_columns1 ()
+    test_columns2 ()
+    test_columns3 ()
+    
+# =============================================================================
+##                                                                      The END 
+# =============================================================================
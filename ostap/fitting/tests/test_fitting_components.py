@@ -17,7 +17,7 @@ __all__    = () ## nothing to import
 import ROOT, random
 import ostap.fitting.roofit 
 import ostap.fitting.models as     Models 
-from   ostap.core.core      import cpp, VE, dsID
+from   ostap.core.core      import cpp, VE, dsID, Ostap
 from   ostap.logger.utils   import rooSilent
 from   builtins             import range
 from   ostap.utils.timing   import timing 
@@ -238,6 +238,69 @@ def test_nonextended3 () :
         
     logger.info ( 'Model %s Fit result\n%s' % ( model.name , r.table ( prefix = '# ' ) ) ) 
 
+# =============================================================================
+## Test     extended multi-component fit with cached components 
+def test_cached () :
+    
+    logger.info ('Test     extended multi-component fit with cached components')
+
+    def make_model ( name , suffix , cached ) :
+        model = Models.Fit1D (
+            name             = name                    , 
+            signal           = signal_1                , 
+            othersignals     = [ signal_2 , signal_3 ] ,
+            background       = Models.Bkg_pdf ( 'P' + suffix , xvar = mass , power = 0 , tau = 0 ) ,
+            otherbackgrounds = [ wide_1   , wide_2   ] ,
+            others           = [ narrow_1 , narrow_2 ] , 
+            suffix           = suffix                  ,
+            cached           = cached   
+            )
+        model.S = N1 , N1 , N1 
+        model.B = N2 , N3 , N3 
+        model.C = N3 , N3
+        return model 
+
+    model1 = make_model ( 'R1' , '_r' , False )
+    model2 = make_model ( 'C1' , '_c' , True  )
+    
+    with timing ( 'Regular fit' , logger = logger ) :
+        r1 , f = model1.fitTo ( dataset , draw = False , silent = True )
+    with timing ( 'Cached  fit' , logger = logger ) :
+        r2 , f = model2.fitTo ( dataset , draw = True  , silent = True )
+        
+    logger.info ( 'Model %s Fit result\n%s' % ( model2.name , r2.table ( prefix = '# ') ) ) 
+
+    for y1 , y2 in zip ( model1.yields , model2.yields ) :
+        v1 , v2 = y1.as_VE () , y2.as_VE ()
+        assert abs ( v1.value () - v2.value () ) <= 0.01 * v1.error () , \
+               'Cached fit: yields differ %s vs %s' % ( v1 , v2 )
+
+    ## yield-only modification: no evaluation of components 
+    pdf = model2.pdf 
+    assert isinstance ( pdf , Ostap.MoreRooFit.AddPdf ) , 'Invalid PDF type %s' % type ( pdf )
+    
+    obs    = ROOT.RooArgSet ( mass )
+    points = [ mmin + ( i + 0.5 ) * ( mmax - mmin ) / 100 for i in range ( 100 ) ]
+    def scan () :
+        for x in points :
+            mass.setVal ( x )
+            pdf.getVal  ( obs )
+            
+    scan () 
+    n1 = pdf.evaluations ()
+    assert n1 == len ( points ) * len ( model2.alist1 ) , 'Invalid number of evaluations!' 
+
+    model2.S = [ 1.01 * s.getVal () for s in model2.S ]
+    scan () 
+    assert n1 == pdf.evaluations () , 'Components are evaluated for the new yields!'
+
+    ## shape modification: only one component is evaluated 
+    sigma = signal_1.sigma.getVal () 
+    signal_1.sigma = 1.01 * sigma 
+    scan ()
+    assert n1 + len ( points ) == pdf.evaluations () , 'Invalid number of evaluations!'
+    signal_1.sigma = sigma 
+
 # =============================================================================
 if '__main__' == __name__ :
 
@@ -255,6 +318,9 @@ if '__main__' == __name__ :
         
     with timing ( "non-Extended3" , logger ) : 
         test_nonextended3 () 
+
+    with timing ( "Cached"        , logger ) : 
+        test_cached       () 
     
 # =============================================================================
 ##                                                                      The END 
@@ -0,0 +1,128 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developers.
+# =============================================================================
+# @file test_fitting_concatenate.py
+# Test module for the one-shot concatenation and chunked view of datasets
+# @see ds_concatenate
+# @see ds_chunks
+# =============================================================================
+""" Test module for the one-shot concatenation and chunked view of datasets
+- see ds_concatenate
+- see ds_chunks
+"""
+# =============================================================================
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# =============================================================================
+import ROOT, random
+from   builtins                 import range
+import ostap.fitting.roofit
+from   ostap.core.core          import dsID
+from   ostap.fitting.dataset    import ds_concatenate, ds_chunks
+from   ostap.utils.timing       import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ :
+    logger = getLogger ( 'test_fitting_concatenate' )
+else :
+    logger = getLogger ( __name__                  )
+# =============================================================================
+
+x = ROOT.RooRealVar ( 'x' , 'x-variable' , 0 , 10 )
+y = ROOT.RooRealVar ( 'y' , 'y-variable' , 0 , 10 )
+w = ROOT.RooRealVar ( 'w' , 'weight'     , 0 , 10 )
+varset = ROOT.RooArgSet ( x , y , w )
+
+## the partial datasets, e.g. from the parallel workers
+partial = []
+for n in ( 1000 , 0 , 2500 , 700 , 5000 ) :
+    ds = ROOT.RooDataSet ( dsID () , 'partial data' , varset )
+    for i in range ( n ) :
+        x.setVal ( random.uniform ( 0 , 10 ) )
+        y.setVal ( random.gauss   ( 5 ,  1 ) % 10 )
+        w.setVal ( random.uniform ( 0 ,  2 ) )
+        ds.add ( varset )
+    partial.append ( ds )
+
+# =============================================================================
+## one-shot concatenation vs sequential append
+def test_concatenate1 () :
+
+    logger = getLogger ( 'test_concatenate1' )
+
+    with timing ( 'append'      , logger = logger ) :
+        ds1 = partial [ 0 ].emptyClone ( dsID () )
+        for p in partial : ds1.append ( p )
+
+    with timing ( 'concatenate' , logger = logger ) :
+        ds2 = ds_concatenate ( partial , title = 'concatenated' )
+
+    assert len ( ds1 ) == len ( ds2 ) == sum ( len ( p ) for p in partial ) , 'Invalid number of entries!'
+    assert 'concatenated' == ds2.GetTitle ()                                 , 'Invalid title!'
+    for i in range ( 0 , len ( ds1 ) , 97 ) :
+        e1 = ds1.get ( i )
+        e2 = ds2.get ( i )
+        for v in ( 'x' , 'y' , 'w' ) :
+            assert e1.find ( v ).getVal () == e2.find ( v ).getVal () , \
+                   "Mismatch for `%s' at entry %d" % ( v , i )
+    logger.info ( 'Concatenated dataset:\n%s' % ds2.table ( prefix = '# ' ) )
+
+# =============================================================================
+## the chunked view: unified index, spans and weights
+def test_concatenate2 () :
+
+    logger = getLogger ( 'test_concatenate2' )
+
+    wpartial = [ p.makeWeighted ( 'w' ) for p in partial ]
+    view     = ds_chunks ( wpartial )
+
+    assert view.weighted ()                                    , 'View must be weighted!'
+    assert len ( wpartial ) == view.nChunks ()                 , 'Invalid number of chunks!'
+    assert sum ( len ( p ) for p in wpartial ) == view.size () , 'Invalid number of entries!'
+
+    ## materialize the weighted view
+    ds = view.concatenate ( dsID () )
+    ROOT.SetOwnership ( ds , True )
+    assert ds.isWeighted ()           , 'Dataset must be weighted!'
+    assert len ( ds ) == view.size () , 'Invalid number of entries!'
+    s1 = ds.sumVar ( 'x' ).value ()
+    s2 = sum ( p.sumVar ( 'x' ).value () for p in wpartial )
+    assert abs ( s1 - s2 ) <= 1.e-9 * abs ( s2 ) , 'Invalid weighted sum: %s vs %s' % ( s1 , s2 )
+
+    ## the unified index
+    entry = 0
+    for k , p in enumerate ( wpartial ) :
+        assert entry == view.offset ( k ) , 'Invalid offset of chunk #%d' % k
+        for i in range ( 0 , len ( p ) , 51 ) :
+            where = view.locate ( entry + i )
+            assert ( k , i ) == ( where.first , where.second ) , 'Invalid location of entry %d' % ( entry + i )
+            x1 = view.get ( entry + i ).find ( 'x' ).getVal ()
+            w1 = view.weight ()
+            x2 = ds  .get ( entry + i ).find ( 'x' ).getVal ()
+            w2 = ds  .weight ()
+            assert x1 == x2 and w1 == w2 , 'Invalid entry %d' % ( entry + i )
+        entry += len ( p )
+    assert not view.get ( view.size () ) , 'Entry beyond the range must be invalid!'
+
+    ## the spans (vector store only)
+    spans = view.spans ( 'x' )
+    if len ( spans ) :
+        assert len ( wpartial ) == len ( spans ) , 'Invalid number of spans!'
+        for s , p in zip ( spans , wpartial ) :
+            assert len ( p ) == s.second , 'Invalid span size!'
+
+    logger.info ( 'Chunked view: %d chunks, %d entries' % ( view.nChunks () , view.size () ) )
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_concatenate1 ()
+    test_concatenate2 ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
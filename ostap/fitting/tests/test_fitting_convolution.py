@@ -75,6 +75,43 @@ def test_laplace():
     models.add ( laplace_1 )
     models.add ( laplace_2 )
     
+# =============================================================================
+## native FFT convolution with the cached Fourier images
+# =============================================================================
+def test_native(): 
+
+    logger = getLogger ( 'test_native' )
+    
+    logger.info ('Test native FFT convolution' )
+    cb  = Models.CrystalBall_pdf ( name  = 'CB'  , 
+                                   xvar  = x     ,
+                                   mean  = 5     , 
+                                   sigma = 0.3   ,
+                                   alpha = 1.5   ,
+                                   n     = 2     )
+    
+    from ostap.fitting.convolution import  Convolution_pdf
+
+    cb_1 = Convolution_pdf ( name = 'CB1' , pdf = cb , resolution = 0.5 , native = True  )
+    cb_2 = Convolution_pdf ( name = 'CB2' , pdf = cb , resolution = 0.5 , native = False )
+
+    cnv  = cb_1.pdf
+    logger.info ( 'Analytic signal/resolution: %s/%s' % ( cnv.analyticSignal () , cnv.analyticResolution () ) )
+
+    for v in ( 3 , 4.5 , 5 , 5.5 , 7 ) :
+        x.setVal ( v )
+        v1 = cb_1.pdf.getVal ( ROOT.RooArgSet ( x ) )
+        v2 = cb_2.pdf.getVal ( ROOT.RooArgSet ( x ) )
+        logger.info ( 'x=%.2f native:%.5f RooFFTConvPdf:%.5f' % ( v , v1 , v2 ) )
+
+    ## change only the resolution: the signal image is reused 
+    ns = cnv.nSignal ()
+    cb_1.resolution.sigma.setVal ( 0.6 )
+    cb_1.pdf.getVal ( ROOT.RooArgSet ( x ) )
+    assert ns == cnv.nSignal () , 'Signal image is recalculated!'
+
+    models.add ( cb_1 )
+    
 # =============================================================================
 ## check that everything is serializable
 # =============================================================================
@@ -103,6 +140,10 @@ if '__main__' == __name__ :
     with timing('Laplace'    , logger ) :
         test_laplace () 
 
+    ## native FFT convolution 
+    with timing('Native'     , logger ) :
+        test_native  () 
+
     
     ## check finally that everything is serializeable:
     with timing('Save to DB' , logger ) :
@@ -0,0 +1,121 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+# @file ostap/fitting/tests/test_fitting_curves.py
+# Test module for the fast rendering of PDF curves
+# - It tests ostap.fitting.curves and PDF.draw ( ... , fast_curves = True )
+# =============================================================================
+""" Test module for the fast rendering of PDF curves
+- It tests ostap.fitting.curves and PDF.draw ( ... , fast_curves = True )
+"""
+# =============================================================================
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# =============================================================================
+import ROOT, random
+import ostap.fitting.roofit
+import ostap.fitting.models    as     Models
+from   ostap.core.core         import VE, dsID
+from   ostap.fitting.curves    import curves_stat
+from   ostap.utils.timing      import timing
+from   ostap.plotting.canvas   import use_canvas
+from   ostap.utils.utils       import wait
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ :
+    logger = getLogger ( 'ostap/fitting/tests/test_fitting_curves' )
+else :
+    logger = getLogger ( __name__ )
+# =============================================================================
+x = ROOT.RooRealVar ( 'x_curves' , 'x' , 0 , 10 )
+y = ROOT.RooRealVar ( 'y_curves' , 'y' , 0 , 10 )
+
+varset  = ROOT.RooArgSet  ( x , y )
+dataset = ROOT.RooDataSet ( dsID () , 'Test data' , varset )
+
+m = VE ( 5 , 0.5**2 )
+for i in range ( 2000 ) :
+    x.setVal ( m.gauss () )
+    y.setVal ( random.uniform ( 0 , 10 ) )
+    dataset.add ( varset )
+for i in range ( 2000 ) :
+    x.setVal ( random.uniform ( 0 , 10 ) )
+    y.setVal ( m.gauss () )
+    dataset.add ( varset )
+
+# =============================================================================
+## compare the curves from the standard and fast rendering
+def compare ( frame1 , frame2 ) :
+    c1 = frame1.getCurve ()
+    c2 = frame2.getCurve ()
+    ymax = max ( c1.GetY () [ i ] for i in range ( c1.GetN () ) )
+    return max ( abs ( c1.interpolate ( v ) - c2.interpolate ( v ) ) / ymax
+                 for v in ( 0.5 , 2.5 , 4.5 , 5.0 , 5.5 , 7.5 , 9.5 ) )
+
+# =============================================================================
+## 1D model: the fast curves are the same as the standard ones
+def test_curves_1D () :
+
+    logger = getLogger ( 'test_curves_1D' )
+
+    signal = Models.Gauss_pdf ( 'G1' , xvar = x , mean = ( 5 , 4 , 6 ) , sigma = ( 0.5 , 0.1 , 1 ) )
+    model  = Models.Fit1D     ( signal = signal , background = 'e-' , suffix = '_curves1' )
+    r , _  = model.fitTo ( dataset , silent = True )
+
+    curves_stat ( reset = True )
+
+    with timing ( 'Draw: standard' , logger = logger ) , use_canvas ( 'test_curves_1D' ) , wait ( 1 ) :
+        f1 = model.draw ( dataset )
+    with timing ( 'Draw: fast'     , logger = logger ) , use_canvas ( 'test_curves_1D' ) , wait ( 1 ) :
+        f2 = model.draw ( dataset , fast_curves = True )
+    with timing ( 'Draw: cached'   , logger = logger ) , use_canvas ( 'test_curves_1D' ) , wait ( 1 ) :
+        f3 = model.draw ( dataset , fast_curves = True )
+
+    delta = compare ( f1 , f2 )
+    stat  = curves_stat ()
+    logger.info ( 'Max relative difference %.2g, cache statistics: %s' % ( delta , stat ) )
+    assert delta < 1.e-3 , 'Fast curve differs from the standard one!'
+    assert 0 < stat [ 'hits' ] , 'Curves are not taken from the cache!'
+
+    ## other parameters: curves are recalculated
+    signal.sigma = 0.6
+    f4 = model.draw ( dataset , fast_curves = True )
+    assert stat [ 'misses' ] < curves_stat () [ 'misses' ] , 'Other parameters give the same curve!'
+
+# =============================================================================
+## 2D model: the projections use the analytical integrals
+def test_curves_2D () :
+
+    logger = getLogger ( 'test_curves_2D' )
+
+    sx    = Models.Gauss_pdf ( 'GX' , xvar = x , mean = ( 5 , 4 , 6 ) , sigma = ( 0.5 , 0.1 , 1 ) )
+    sy    = Models.Gauss_pdf ( 'GY' , xvar = y , mean = ( 5 , 4 , 6 ) , sigma = ( 0.5 , 0.1 , 1 ) )
+    model = Models.Fit2D     ( signal_x = sx , signal_y = sy , suffix = '_curves2' )
+    r , _ = model.fitTo ( dataset , silent = True )
+
+    with timing ( 'Draw1: standard' , logger = logger ) , use_canvas ( 'test_curves_2D' ) , wait ( 1 ) :
+        f1 = model.draw1 ( dataset )
+    with timing ( 'Draw1: fast'     , logger = logger ) , use_canvas ( 'test_curves_2D' ) , wait ( 1 ) :
+        f2 = model.draw1 ( dataset , fast_curves = True )
+
+    delta = compare ( f1 , f2 )
+    logger.info ( 'Max relative difference %.2g' % delta )
+    assert delta < 1.e-3 , 'Fast projection differs from the standard one!'
+
+    ## in range: the standard rendering is used
+    with use_canvas ( 'test_curves_2D' ) , wait ( 1 ) :
+        f3 = model.draw1 ( dataset , fast_curves = True , in_range = ( 2 , 8 ) )
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_curves_1D ()
+    test_curves_2D ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
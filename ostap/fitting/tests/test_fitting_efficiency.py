@@ -188,6 +188,73 @@ def test_vars3 () :
         f2     = eff2.draw  ( ds , nbins = 25 )
     
     
+# =============================================================================
+# use the fused expression to parameterize efficiciency
+def test_vars4 () :
+
+    logger = getLogger ( 'test_vars4' )
+
+    a  = ROOT.RooRealVar  ( 'A4', 'a' , 0.05  ,   0   , 1   )
+    b  = ROOT.RooRealVar  ( 'B4', 'b' , 0.02  , -0.05 , 0.1 )
+    c  = ROOT.RooRealVar  ( 'C4', 'c' , 0.005 ,   0   , 0.1 )
+
+    import ostap.fitting.roofuncs as     R
+    from   ostap.fitting.funbasic import Fun1D 
+    X   = Fun1D ( x , xvar = x , name = 'X4' )
+    
+    F   = a +  b * X + c * X**2
+    FF  = R.var_fuse ( F.fun , name = 'FF4' )
+
+    logger.info ( "Fused program:\n%s" % FF.listing () ) 
+    for p in points :
+        x.setVal ( p )
+        assert abs ( F.fun.getVal () - FF.getVal () ) <= 1.e-9 * abs ( F.fun.getVal () ) + 1.e-12 , \
+               'Fused expression differs at x=%s' % p 
+    
+    eff2   = Efficiency1D ( 'E6' , FF , cut = acc  , xvar = x )
+    
+    r2     = eff2.fitTo ( ds )
+
+    logger.info ( "Fit result using fused expression \n%s" % r2.table ( prefix = "# ") )
+    logger.info ( "Compare with true efficiency (using fused expression)\n%s" % make_table (
+        eff2 , title = 'fused expression') )
+
+    
+# =============================================================================
+# fast unbinned fit of 2D efficiency with Bernstein polynomial 
+def test_fast2D () :
+
+    logger = getLogger ( 'test_fast2D' )
+
+    from ostap.fitting.efficiency import efficiency_fit
+    
+    y    = ROOT.RooRealVar ( 'y' , 'test' , 0 , 10 )
+    vset = ROOT.RooArgSet  ( x , y , acc )
+    ds2  = ROOT.RooDataSet ( dsID() , 'test data' , vset )
+
+    ## true efficiency: x*y/100 
+    for i in range ( N ) :
+        xv = random.uniform ( xmin , xmax )
+        yv = random.uniform ( xmin , xmax )
+        x.setVal ( xv )
+        y.setVal ( yv )
+        acc.setIndex ( 1 if xv * yv / 100 > random.uniform ( 0 , 1 ) else 0 )
+        ds2.add ( vset )
+
+    shape = Ostap.Math.Bernstein2D ( 1 , 1 , xmin , xmax , xmin , xmax )
+    with timing ( "Fast 2D efficiency fit" , logger ) : 
+        fit = efficiency_fit ( ds2 , shape , ( x , y ) , acc )
+
+    rows = [ ( 'x' , 'y' , 'fitted eff [%]' , 'true eff [%]' ) ]
+    for xv , yv in ( ( 2 , 2 ) , ( 5 , 5 ) , ( 8 , 3 ) , ( 9 , 9 ) ) :
+        e1 = shape ( xv , yv )
+        e2 = xv * yv / 100.0 
+        rows.append ( ( '%.1f' % xv , '%.1f' % yv , '%.2f' % ( 100 * e1 ) , '%.2f' % ( 100 * e2 ) ) )
+        assert abs ( e1 - e2 ) < 0.05 , 'Fast efficiency fit: large deviation at (%s,%s)' % ( xv , yv ) 
+
+    from ostap.logger.table import table
+    logger.info ( "Fast 2D efficiency fit, -logL=%.2f\n%s" % ( fit.minNll () , table ( rows , prefix = '# ' ) ) )
+    
 # =============================================================================
 if '__main__' == __name__ :
 
@@ -204,6 +271,12 @@ if '__main__' == __name__ :
     with timing ("Vars3" , logger ) :        
         test_vars3 ()
 
+    with timing ("Vars4" , logger ) :        
+        test_vars4 ()
+
+    with timing ("Fast2D" , logger ) :        
+        test_fast2D ()
+
 # =============================================================================
 ##                                                                      The END 
 # ============================================================================= 
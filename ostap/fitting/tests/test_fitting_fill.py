@@ -27,6 +27,7 @@ from   ostap.fitting.pyselectors    import Variable, SelectorWithVars
 from   ostap.logger.colorized       import attention
 import ostap.logger.table           as     T
 import ostap.parallel.parallel_fill
+from   ostap.parallel.parallel_fill import fill_mt, mt_suitable 
 # =============================================================================
 # logging 
 # =============================================================================
@@ -241,6 +242,14 @@ def test_fitting_fill_1 () :
     if ds1_3 != ds1p_3  : logger.error ('Datasets ds1_3  and ds1p_3  are different!' )
     if ds1_4 != ds1p_4  : logger.error ('Datasets ds1_4  and ds1p_4  are different!' )
 
+    ## multithreaded C++ filler 
+    with timing ( "Multithreaded C++ filler" , logger = logger ) : 
+        selector = SelectorWithVars ( **config ) 
+        assert mt_suitable ( selector ) , 'Selector must be suitable for C++ filler!'
+        fill_mt ( chain , selector ) 
+        ds1mt = selector.data 
+    if ds1_1 != ds1mt   : logger.error ('Datasets ds1_1  and ds1mt   are different!' )
+
     # =========================================================================
     logger.info ( attention( 'Trivial variables + CUT' ) ) 
     # =========================================================================
@@ -0,0 +1,104 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+# @file ostap/fitting/tests/test_fitting_fitcache.py
+# Test module for the content-addressed cache of fit results
+# - It tests ostap.fitting.fitcache and PDF.fitTo ( ... , cache = ... )
+# =============================================================================
+""" Test module for the content-addressed cache of fit results
+- It tests ostap.fitting.fitcache and PDF.fitTo ( ... , cache = ... )
+"""
+# =============================================================================
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# =============================================================================
+import ROOT, random
+import ostap.fitting.roofit
+import ostap.fitting.models    as     Models
+from   ostap.core.core         import VE, dsID
+from   ostap.fitting.fitcache  import fit_cache_stat, data_key
+from   ostap.utils.cleanup     import CleanUp
+from   ostap.utils.timing      import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ :
+    logger = getLogger ( 'ostap/fitting/tests/test_fitting_fitcache' )
+else :
+    logger = getLogger ( __name__ )
+# =============================================================================
+mass = ROOT.RooRealVar ( 'test_mass_fitcache' , 'Some test mass' , 2.5 , 3.5 )
+mmin , mmax = mass.minmax()
+
+m0   = VE ( 3.100 , 0.015**2 )
+NS   = 1000
+NB   = 2000
+
+varset  = ROOT.RooArgSet  ( mass )
+dataset = ROOT.RooDataSet ( dsID () , 'Test data' , varset )
+for i in range ( NS ) :
+    mass.setVal ( m0.gauss () )
+    dataset.add ( varset )
+for i in range ( NB ) :
+    mass.setVal ( random.uniform ( mmin , mmax ) )
+    dataset.add ( varset )
+
+signal = Models.Gauss_pdf ( 'G' , xvar = mass , mean = ( 3.1 , 3.0 , 3.2 ) , sigma = ( 0.015 , 0.005 , 0.05 ) )
+model  = Models.Fit1D     ( signal = signal , background = 'e-' , suffix = '_fitcache' )
+
+# =============================================================================
+## repeated fit is taken from the cache
+def test_fitcache () :
+
+    logger = getLogger ( 'test_fitcache' )
+
+    dbname = CleanUp.tempfile ( suffix = '.zdb' , prefix = 'ostap-test-fitting-fitcache-' )
+
+    ## the same content gives the same key
+    assert data_key ( dataset ) == data_key ( dataset.Clone () ) , 'Invalid content key for dataset!'
+
+    fit_cache_stat ( reset = True )
+
+    def reset () :
+        model.S     = NS
+        model.B     = NB
+        signal.mean = 3.1
+        signal.sigma.setVal ( 0.015 )
+
+    reset ()
+    with timing ( 'Fit'             , logger = logger ) :
+        r1 , _ = model.fitTo ( dataset , silent = True , cache = dbname )
+    S1 = model.S.as_VE ()
+
+    reset ()
+    with timing ( 'Fit (cached)'    , logger = logger ) :
+        r2 , _ = model.fitTo ( dataset , silent = True , cache = dbname )
+    S2 = model.S.as_VE ()
+
+    stat = fit_cache_stat ()
+    logger.info ( 'Cache statistics: %s' % stat )
+    assert 1 == stat [ 'hits' ] and 1 == stat [ 'stored' ] , 'The fit result is not taken from the cache!'
+    assert S1.value () == S2.value () and S1.error () == S2.error () , 'Parameters are not restored!'
+
+    ## other initial values: new fit
+    reset ()
+    model.S = 0.5 * NS
+    r3 , _ = model.fitTo ( dataset , silent = True , cache = dbname )
+    assert 2 == fit_cache_stat () [ 'misses' ] , 'Other initial values give the same key!'
+
+    ## other options: new fit
+    reset ()
+    r4 , _ = model.fitTo ( dataset , silent = True , cache = dbname , ncpu = 2 )
+    assert 3 == fit_cache_stat () [ 'misses' ] , 'Other fit options give the same key!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_fitcache ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -94,10 +94,38 @@ def test_jackknife ( ) :
     time.sleep ( 2 ) 
 
 
+# ==============================================================================
+## Perform jackknife study using the weighted view of the dataset (no copies)
+def test_jackknife_view ( ) :
+    """Perform jackknife study using the weighted view of the dataset (no copies)
+    """
+
+    logger = getLogger ( 'test_jackknife_view' )
+
+    N = 400 
+    dataset = model.generate ( N , sample = False )
+    
+    res , f = model.fitTo ( dataset , silent = True , refit = 5 )
+
+    with timing ( 'Jackknife with view' , logger = logger ) : 
+        results , stats = Toys.make_jackknife  (
+            pdf         = model      ,
+            data        = dataset    , 
+            fit_pars    = { 'mean_G' : 0.4  , 'sigma_G' : 0.1 } ,
+            view        = True       , 
+            silent      = True       , 
+            progress    = True       )
+        
+    Toys.print_jackknife ( res , stats , logger = logger )
+
+    for n in results [ '#' ] :
+        assert N == n + 1 , 'Invalid size of jackknife sample %s' % n 
+    
 # =============================================================================
 if '__main__' == __name__ :
 
-    test_jackknife ( ) 
+    test_jackknife      ( )
+    test_jackknife_view ( ) 
     
 # =============================================================================
 ##                                                                      The END 
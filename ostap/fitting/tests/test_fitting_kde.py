@@ -0,0 +1,180 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developers.
+# =============================================================================
+# @file test_fitting_kde.py
+# Test module
+# - It tests binned (FFT-based) kernel density estimators in 1, 2 and 3 dimensions
+# @see Ostap::Math::KDE
+# @see Ostap::Models::KDE
+# =============================================================================
+""" Test module
+- It tests binned (FFT-based) kernel density estimators in 1, 2 and 3 dimensions
+- see Ostap.Math.KDE
+- see Ostap.Models.KDE
+"""
+# =============================================================================
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# =============================================================================
+import ROOT, random, math
+import ostap.fitting.roofit
+import ostap.fitting.models        as     Models
+from   ostap.core.core             import Ostap
+from   ostap.utils.timing          import timing
+from   ostap.plotting.canvas       import use_canvas
+from   ostap.utils.utils           import wait
+from   builtins                    import range
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ :
+    logger = getLogger ( 'test_fitting_kde' )
+else :
+    logger = getLogger ( __name__ )
+# =============================================================================
+
+x       = ROOT.RooRealVar ( 'x_kde' , 'x' , 0 , 10 )
+y       = ROOT.RooRealVar ( 'y_kde' , 'y' , 0 , 10 )
+varset  = ROOT.RooArgSet  ( x , y )
+dataset = ROOT.RooDataSet ( 'ds_kde' , 'data for KDE' , varset )
+
+N = 20000
+for i in range ( N ) :
+
+    vx = random.gauss ( 5 , 1 )
+    vy = random.expovariate ( 0.5 )
+    if not 0 < vx < 10 or not 0 < vy < 10 : continue
+
+    x.setVal ( vx )
+    y.setVal ( vy )
+    dataset.add ( varset )
+
+# =============================================================================
+## the true (truncated) densities 
+def gauss_pdf ( v , mu , sigma , low = 0 , high = 10 ) :
+    """The gaussian density, truncated to [low,high]"""
+    norm = 0.5 * ( math.erf ( ( high - mu ) / ( math.sqrt ( 2 ) * sigma ) ) -
+                   math.erf ( ( low  - mu ) / ( math.sqrt ( 2 ) * sigma ) ) )
+    return math.exp ( -0.5 * ( ( v - mu ) / sigma ) ** 2 ) / ( math.sqrt ( 2 * math.pi ) * sigma * norm )
+def expo_pdf  ( v , tau , low = 0 , high = 10 ) :
+    """The exponential density, truncated to [low,high]"""
+    return tau * math.exp ( -tau * v ) / ( math.exp ( -tau * low ) - math.exp ( -tau * high ) )
+
+# ============================================================================
+def test_kde1 () :
+    """Test 1D kernel density estimator
+    """
+    logger = getLogger ('test_kde1')
+
+    with timing ( 'KDE1D: fixed    bandwidth' , logger = logger ) :
+        kde1 = Models.KDE1D_pdf ( 'KDE1' , xvar = x , data = dataset )
+    with timing ( 'KDE1D: adaptive bandwidth' , logger = logger ) :
+        kde2 = Models.KDE1D_pdf ( 'KDE2' , xvar = x , data = dataset , adaptive = True )
+
+    for pdf in ( kde1 , kde2 ) :
+
+        kde = pdf.kde
+        assert abs ( kde.integral ( 0 , 10 ) - 1 ) < 1.e-6 , 'Invalid normalization!'
+
+        ## compare with the true density
+        vmax = max ( abs ( kde ( v ) - math.exp ( -0.5 * ( v - 5 ) ** 2 ) / math.sqrt ( 2 * math.pi ) )
+                     for v in ( 3.0 , 4.0 , 5.0 , 6.0 , 7.0 ) )
+        logger.info ( 'KDE1D(adaptive=%s): h=%.4f, max deviation %.4f' % ( pdf.adaptive ,
+                                                                           kde.bandwidth ( 0 ) , vmax ) )
+        assert vmax < 0.05 , 'Too large deviation from the true density!'
+
+        with wait ( 1 ) , use_canvas ( 'test_kde1' ) :
+            pdf.draw ( dataset , nbins = 100 )
+
+# ============================================================================
+def test_kde2 () :
+    """Test 2D kernel density estimator
+    """
+    logger = getLogger ('test_kde2')
+
+    with timing ( 'KDE2D: fixed    bandwidth' , logger = logger ) :
+        kde1 = Models.KDE2D_pdf ( 'KDE2D1' , xvar = x , yvar = y , data = dataset )
+    with timing ( 'KDE2D: adaptive bandwidth' , logger = logger ) :
+        kde2 = Models.KDE2D_pdf ( 'KDE2D2' , xvar = x , yvar = y , data = dataset , adaptive = True )
+
+    for pdf in ( kde1 , kde2 ) :
+
+        kde = pdf.kde
+        assert abs ( kde.integral ( 0 , 10 , 0 , 10 ) - 1 ) < 1.e-6 , 'Invalid normalization!'
+
+        ## compare with the true density (far from the sharp edge at y=0)
+        points = [ ( vx , vy ) for vx in ( 4.0 , 5.0 , 6.0 ) for vy in ( 1.5 , 2.5 , 4.0 ) ]
+        devs   = [ abs ( kde ( vx , vy ) / ( gauss_pdf ( vx , 5 , 1 ) * expo_pdf ( vy , 0.5 ) ) - 1 )
+                   for vx , vy in points ]
+        logger.info ( 'KDE2D(adaptive=%s): max/mean relative deviation %.4f/%.4f' % ( pdf.adaptive ,
+                                                                                     max ( devs ) , sum ( devs ) / len ( devs ) ) )
+        assert max ( devs )               < 0.25 , 'Too large deviation from the true density!'
+        assert sum ( devs ) / len ( devs ) < 0.10 , 'Too large mean deviation from the true density!'
+
+        with wait ( 1 ) , use_canvas ( 'test_kde2' ) :
+            pdf.draw1 ( dataset , nbins = 100 )
+        with wait ( 1 ) , use_canvas ( 'test_kde2' ) :
+            pdf.draw2 ( dataset , nbins = 100 )
+
+# ============================================================================
+def test_kde3 () :
+    """Test 3D kernel density estimator
+    """
+    logger = getLogger ('test_kde3')
+
+    z       = ROOT.RooRealVar ( 'z_kde' , 'z' , 0 , 10 )
+    varset3 = ROOT.RooArgSet  ( x , y , z )
+    data3   = ROOT.RooDataSet ( 'ds3_kde' , 'data for 3D KDE' , varset3 )
+    while len ( data3 ) < N :
+        vx = random.gauss ( 5 , 1 )
+        vy = random.expovariate ( 0.5 )
+        vz = random.gauss ( 5 , 1.5 )
+        if not 0 < vx < 10 or not 0 < vy < 10 or not 0 < vz < 10 : continue
+        x.setVal ( vx )
+        y.setVal ( vy )
+        z.setVal ( vz )
+        data3.add ( varset3 )
+
+    with timing ( 'KDE3D: fixed    bandwidth' , logger = logger ) :
+        kde1 = Models.KDE3D_pdf ( 'KDE3D1' , xvar = x , yvar = y , zvar = z , data = data3 )
+    with timing ( 'KDE3D: adaptive bandwidth' , logger = logger ) :
+        kde2 = Models.KDE3D_pdf ( 'KDE3D2' , xvar = x , yvar = y , zvar = z , data = data3 , adaptive = True )
+
+    for pdf in ( kde1 , kde2 ) :
+
+        kde = pdf.kde
+        assert abs ( kde.integral ( 0 , 10 , 0 , 10 , 0 , 10 ) - 1 ) < 1.e-6 , 'Invalid normalization!'
+
+        ## independent check of the normalization: midpoint rule
+        M     = 25
+        step  = 10.0 / M
+        nodes = [ ( i + 0.5 ) * step for i in range ( M ) ]
+        total = sum ( kde ( vx , vy , vz ) for vx in nodes for vy in nodes for vz in nodes ) * step ** 3
+        assert abs ( total - 1 ) < 0.01 , 'Invalid normalization (midpoint rule): %s' % total
+
+        ## compare with the true density (far from the sharp edge at y=0)
+        points = [ ( vx , vy , vz ) for vx in ( 4.5 , 5.0 , 5.5 ) for vy in ( 2.0 , 3.0 ) for vz in ( 4.0 , 5.0 , 6.0 ) ]
+        devs   = [ abs ( kde ( vx , vy , vz ) /
+                         ( gauss_pdf ( vx , 5 , 1 ) * expo_pdf ( vy , 0.5 ) * gauss_pdf ( vz , 5 , 1.5 ) ) - 1 )
+                   for vx , vy , vz in points ]
+        logger.info ( 'KDE3D(adaptive=%s): integral %.5f, max/mean relative deviation %.4f/%.4f' % (
+            pdf.adaptive , total , max ( devs ) , sum ( devs ) / len ( devs ) ) )
+        assert max ( devs )               < 0.25 , 'Too large deviation from the true density!'
+        assert sum ( devs ) / len ( devs ) < 0.10 , 'Too large mean deviation from the true density!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    with timing ("KDE-1D"   , logger ) :
+        test_kde1   ()
+    with timing ("KDE-2D"   , logger ) :
+        test_kde2   ()
+    with timing ("KDE-3D"   , logger ) :
+        test_kde3   ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
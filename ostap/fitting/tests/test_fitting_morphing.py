@@ -108,6 +108,25 @@ def test_morphing2 () :
         r , f = pdf.fitHisto ( h1 , draw = True  , nbins = 100 , silent = True )
     ## logger.info ( 'Morphing: \n%s' % r.table ( prefix = "# " ) ) 
     
+# ============================================================================
+def test_morphing3 () :
+    
+    logger = getLogger ('test_morphing3')    
+
+    pdf1 = Models.Gauss_pdf ( 'G1n' , xvar = mass , mean =  9 , sigma = 1 )
+    pdf2 = Models.Gauss_pdf ( 'G2n' , xvar = mass , mean = 10 , sigma = 2 )
+    pdf3 = Models.Gauss_pdf ( 'G3n' , xvar = mass , mean = 11 , sigma = 3 )
+
+    pdf  = Morphing1D_pdf ( 'M3' , { 1.0 : pdf1 ,
+                                     2.0 : pdf2 ,
+                                     3.0 : pdf3 } , xvar =  mass , native = True )
+    
+    with wait ( 1 ) , use_canvas ( 'test_morphing3' ) :
+        r , f = pdf.fitHisto ( h1 , draw = True , nbins = 100 , silent = True )
+        logger.info ( 'Native morphing: \n%s' % r.table ( prefix = "# " ) ) 
+        
+    logger.info ( 'Native morphing: %d recalculations' % pdf.pdf.function().nMorph() )
+    
 # =============================================================================
 if '__main__' == __name__ :
 
@@ -115,6 +134,8 @@ if '__main__' == __name__ :
         test_morphing1   () 
     with timing ("Morphing2"   , logger ) :  
         test_morphing2   () 
+    with timing ("Morphing3"   , logger ) :  
+        test_morphing3   () 
     
 # =============================================================================
 ##                                                                      The END 
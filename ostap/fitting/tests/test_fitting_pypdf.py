@@ -261,7 +261,7 @@ def test_PyPDF2 () :
     logger.info  ("Test pure python PDF: PyPDF2 with python function")
 
         
-    from   ostap.fitting.pypdf  import PyPDF2
+    from   ostap.fitting.pypdf  import PyPDF2, BatchFunction 
     # =============================================================================
     ## @class PyGauss2
     #  local ``pure-python'' PDF 
@@ -312,7 +312,32 @@ def test_PyPDF2 () :
         with wait ( 1 ) , use_canvas ( "test_PyPDF2" ) : 
             r, f = model  .fitTo ( dataset , draw = True  , silent = True , ncpu=1 )
             logger.info  ("Fit result for``pure python'' PDF: PyPDF2 with python function \n%s" % r.table ( prefix = "# " ) )
-    
+
+    try :
+        import numpy
+    except ImportError :
+        logger.warning ("No numpy is available, skip the batch evaluation")
+        return
+
+    ## the vectorized function 
+    def vfunction ( x , m , s ) :
+        dx = ( x - m ) / s        
+        return numpy.exp ( -0.5 * dx * dx ) * NORM / s 
+
+    with timing ("Using-PyPDF2/batch", logger ) :
+        
+        ## construct PDF with batch evaluation 
+        gaussb = PyGauss2 ( name  ='G2b' , function = vfunction ,
+                            xvar = mass , mean = pdf.mean , sigma = pdf.sigma )
+        gaussb.pypdf.setBatch ( BatchFunction ( vfunction ) ) 
+        
+        ## model 
+        modelb = Fit1D ( signal = gaussb , background = 'p0' , name = 'M2b' )
+        
+        ##  fit!
+        rb, _ = modelb.fitTo ( dataset , draw = False , silent = True , ncpu=1 , BatchMode = True )
+        logger.info  ("Fit result for``pure python'' PDF: PyPDF2 with batch evaluation \n%s" % rb.table ( prefix = "# " ) )
+        
 # =============================================================================
 ## Test pure python PDF: <code>PyPdf</code>
 #  @attention For *NEW* PyROOT only!
@@ -0,0 +1,97 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+# @file ostap/fitting/tests/test_fitting_scan.py
+# Test module for the profile-likelihood scans
+# - It tests ostap.fitting.scan and PDF.scan_profile
+# =============================================================================
+""" Test module for the profile-likelihood scans
+- It tests ostap.fitting.scan and PDF.scan_profile
+"""
+# =============================================================================
+from   __future__           import print_function
+# =============================================================================
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# =============================================================================
+import ROOT, random
+import ostap.fitting.roofit
+import ostap.fitting.models as     Models
+from   ostap.core.core      import VE, dsID
+from   ostap.utils.utils    import vrange
+from   ostap.utils.timing   import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ :
+    logger = getLogger ( 'ostap/fitting/tests/test_fitting_scan' )
+else :
+    logger = getLogger ( __name__ )
+# =============================================================================
+mass = ROOT.RooRealVar ( 'test_mass_scan' , 'Some test mass' , 2.5 , 3.5 )
+mmin , mmax = mass.minmax()
+
+m0   = VE ( 3.100 , 0.015**2 )
+NS   = 1000
+NB   = 2000
+
+varset  = ROOT.RooArgSet  ( mass )
+dataset = ROOT.RooDataSet ( dsID () , 'Test data' , varset )
+for i in range ( NS ) :
+    mass.setVal ( m0.gauss () )
+    dataset.add ( varset )
+for i in range ( NB ) :
+    mass.setVal ( random.uniform ( mmin , mmax ) )
+    dataset.add ( varset )
+
+signal = Models.Gauss_pdf ( 'G' , xvar = mass , mean = ( 3.1 , 3.0 , 3.2 ) , sigma = ( 0.015 , 0.005 , 0.05 ) )
+model  = Models.Fit1D     ( signal = signal , background = 'e-' , suffix = '_scan' )
+
+# =============================================================================
+## profile scan with warm starts and refinement vs the plain profile graph
+def test_scan_profile () :
+
+    logger = getLogger ( 'test_scan_profile' )
+
+    model.S = NS
+    model.B = NB
+    r , _ = model.fitTo ( dataset , silent = True )
+    S = model.S.as_VE ()
+    logger.info ( 'Fitted signal: %s' % S )
+
+    values = vrange ( S.value() - 4 * S.error() , S.value() + 4 * S.error() , 20 )
+
+    with timing ( 'graph_profile' , logger = logger ) :
+        g1 = model.graph_profile ( 'S' , values , dataset , silent = True )
+    with timing ( 'scan_profile'  , logger = logger ) :
+        g2 = model.scan_profile  ( 'S' , values , dataset , silent = True , refine = 2 )
+
+    assert len ( g1 ) <= len ( g2 ) , 'Refinement must add points!'
+
+    ## compare at the common points: the same profile
+    ## (up to the constant: g2 contains the exact minimum)
+    s2     = g2.spline3 ()
+    points = [ ( float ( g1 [ i ] [ 0 ] ) , float ( g1 [ i ] [ 1 ] ) ) for i in range ( len ( g1 ) ) ]
+    x0 , _ = min ( points , key = lambda p : p [ 1 ] )
+    for x , y in points :
+        y2 = s2.Eval ( x ) - s2.Eval ( x0 )
+        assert abs ( y2 - y ) < 0.05 + 0.01 * y , \
+               'Profiles are different at %s: %s vs %s' % ( x , y , y2 )
+
+    ## 1-sigma crossing of the profile should be close to the parabolic error
+    xs = [ float ( g2 [ i ] [ 0 ] ) for i in range ( len ( g2 ) ) ]
+    ys = [ float ( g2 [ i ] [ 1 ] ) for i in range ( len ( g2 ) ) ]
+    inside = [ x for x , y in zip ( xs , ys ) if y <= 0.5 ]
+    logger.info ( 'Profile 1-sigma interval: [%.1f,%.1f], parabolic: %s' % ( min ( inside ) , max ( inside ) , S ) )
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_scan_profile ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -360,6 +360,38 @@ def test_selector_with_vars3 ()  :
         
     logger.info ("Data set (selector-with-vars):\n%s"  % dataset.table ( prefix = "# " ) )
 
+
+# =============================================================================
+## Use dedicated selector-with-vars (4) in the block mode to loop
+#  over good entries in  the  chain and fill   dataset 
+def test_selector_with_vars4 ()  :
+    """Use dedicated selector-with-vars (4) in the block mode to loop
+    over good entries in  the  chain and fill   dataset 
+    """
+    
+    logger = getLogger("test_selector_with_vars4")
+
+    from ostap.fitting.pyselectors import SelectorWithVars
+
+    mySel1 = SelectorWithVars ( variables = [ mass , c2dtf , pt ] ,
+                                selection = cuts  ,
+                                silence   = True  , 
+                                logger    = logger )
+    with timing ( "Selector with vars: event-by-event" , logger ) :
+        Ostap.Utils.process ( data.chain , mySel1 )
+
+    mySel2 = SelectorWithVars ( variables = [ mass , c2dtf , pt ] ,
+                                selection = cuts  ,
+                                block     = 1000  , 
+                                logger    = logger )
+    with timing ( "Selector with vars: block mode" , logger ) :
+        Ostap.Utils.process ( data.chain , mySel2 )
+        
+    dataset = mySel2.data
+    logger.info ("Data set (selector-with-vars, block mode):\n%s"  % dataset.table ( prefix = "# " ) )
+
+    assert len ( mySel1.data ) == len ( dataset ) , \
+           'Block mode: mismatch in dataset sizes %d vs %d' % ( len ( mySel1.data ) , len ( dataset ) )
     
 # ==============================================================================================
 if '__main__' == __name__ :
@@ -371,6 +403,7 @@ if '__main__' == __name__ :
     test_selector_with_vars1 ()    
     test_selector_with_vars2 ()
     test_selector_with_vars3 ()
+    test_selector_with_vars4 ()
     
 # ==============================================================================================
 ##                                                                                       The END
@@ -148,7 +148,19 @@ def test_simfit1 () :
 
     title = 'Results of simultaneous fit'
     logger.info ( '%s\n%s' % ( title , r.table ( title = title , prefix = '# ' ) ) )
-    
+
+    ## the same fit with multithreaded NLL
+    S1 , S2 = model1.S.as_VE () , model2.S.as_VE ()
+    with timing ( 'Multithreaded simultaneous fit' , logger = logger ) :
+        rmt , _ = model_sim.fitTo ( dataset , silent = True , nthreads = 2 )
+
+    title = 'Results of multithreaded simultaneous fit'
+    logger.info ( '%s\n%s' % ( title , rmt.table ( title = title , prefix = '# ' ) ) )
+    assert 0 == rmt.status () , 'Multithreaded fit: invalid status %s' % rmt.status ()
+    for a , b in ( ( S1 , model1.S.as_VE () ) , ( S2 , model2.S.as_VE () ) ) :
+        assert abs ( a.value () - b.value () ) <= 0.1 * a.error () , \
+               'Multithreaded fit: results differ %s vs %s' % ( a , b )
+
     with use_canvas ( 'test_simfit1' ) :
         with wait ( 1 ) : 
             fA = model_sim.draw ( 'A' , dataset , nbins = 50 )
@@ -130,12 +130,72 @@ def test_splot () :
     logger.info ( "Tau/signal : %28s vs %s" % ( abs ( 1.0 / rS.tau_TS ) , taus ) ) 
     logger.info ( "Tau/bkg    : %28s vs %s" % ( abs ( 1.0 / rB.tau_TB ) , taub ) ) 
         
+# =============================================================================
+## test the C++ sWeights engine
+def test_splot2 () :
+
+    logger = getLogger ( 'test_splot2' )
+
+    from ostap.tools.splot import sWeights
+    
+    mass    = ROOT.RooRealVar ( 'test_mass2' , 'Some test mass' , 0 , 10 )
+    varset  = ROOT.RooArgSet  ( mass )
+    dataset = ROOT.RooDataSet ( dsID() , 'Test Data set' , varset )  
+
+    mmin, mmax = mass.minmax()
+    m0   = VE(3,0.2**2)
+    NS   = 5000
+    NB   = 5000
+    
+    for i in range(0,NS) :
+        m =  m0.gauss()
+        while not mmin < m < mmax : m =  m0.gauss() 
+        mass.value = m
+        dataset.add ( varset )
+    for i in range(0,NB) :
+        m = random.uniform ( mmin , mmax ) 
+        mass.value = m
+        dataset.add ( varset )
+
+    signal = Models.Gauss_pdf ( 'G2'  , xvar = mass  , mean = ( 3 , 2, 4 ) , sigma = ( 0.2 , 0.1 , 0.5 ) )
+    model  = Models.Fit1D ( signal = signal , background  = 0 , suffix = '_2' )
+    model.S = NS
+    model.B = NB
+
+    model.fitTo ( dataset , silent = True )
+    signal.mean .fix () 
+    signal.sigma.fix ()
+    r , f = model.fitTo ( dataset , silent = True )
+    
+    with timing ( 'sWeights/C++' , logger ) : 
+        sw = sWeights ( model , dataset )
+        sw.add_to_dataset  ( dataset , suffix = '_csw' )
+        
+    with timing ( 'sWeights/RooStats' , logger ) : 
+        model.sPlot ( dataset )
+        
+    logger.info ( "Dataset after sWeights\n%s" % dataset.table ( prefix = '# ' ) )
+
+    for n in sw.names :
+        s1 = dataset.sumVar ( n + '_csw' )
+        s2 = dataset.sumVar ( n + '_sw'  )
+        logger.info ( 'Sum of sWeights for %s: %s/%s, yield: %s' % ( n , s1 , s2 , r ( n ) [ 0 ] ) )
+        assert abs ( s1.value() - r ( n ) [ 0 ].value() ) < 0.01 * NS , \
+               'Invalid sum of sWeights for %s' % n 
+        assert abs ( s1.value() - s2.value() ) < 0.01 * NS , \
+               'sWeights for %s differ from RooStats' % n 
+
+    signal.mean .release() 
+    signal.sigma.release() 
+        
 # =============================================================================
 
 if '__main__' == __name__ :
 
     with timing ( "sPlot" , logger ) :  
         test_splot        () 
+    with timing ( "sWeights" , logger ) :  
+        test_splot2       () 
     
 # =============================================================================
 ##                                                                      The END 
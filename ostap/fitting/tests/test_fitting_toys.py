@@ -87,6 +87,97 @@ def test_toys ( ) :
                 h.draw()
                 logger.info ( "%s  :\n%s"  % ( h.GetTitle() , h.dump ( 30 , 10 ) ) )
 
+# ==============================================================================
+## Perform toy-study using fast toys: NLL&minimizer are built only once 
+def test_toys_fast ( ) :
+    """Perform toy-study using fast toys: NLL&minimizer are built only once 
+    """
+
+    logger = getLogger ( 'test_toys_fast' )
+    
+    with timing ( 'Fast toys' , logger = logger ) : 
+        results , stats = Toys.make_toys_fast (
+            pdf         = gen_gauss ,
+            nToys       = 1000      ,
+            data        = [ mass ]  , 
+            gen_config  = { 'nEvents' : 200  , 'sample'   : True } ,
+            init_pars   = { 'mean_GG' : 0.4  , 'sigma_GG' : 0.1  } ,
+            silent      = True , 
+            progress    = True )
+
+    for p in stats :
+        logger.info (  "Toys: %-20s : %s" % (  p, stats [ p ] ) )
+
+# ==============================================================================
+## Fast multithreaded generation of toys for Ostap shapes 
+def test_toys_generate_fast ( ) :
+    """Fast multithreaded generation of toys for Ostap shapes 
+    """
+
+    logger = getLogger ( 'test_toys_generate_fast' )
+
+    cb = Models.CrystalBall_pdf ( 'CB' , xvar = mass , mean = 0.4 , sigma = 0.1 , alpha = 2 , n = 2 )
+
+    with timing ( 'Standard generation' , logger = logger ) : 
+        ds1 = cb.generate ( 100000 , sample = False )
+    with timing ( 'Fast     generation' , logger = logger ) : 
+        ds2 = Toys.generate_fast ( cb , 100000 , sample = False , seed = 12345 )
+        
+    ds3 = Toys.generate_fast ( cb , 100000 , sample = False , seed = 12345 , nthreads = 1 )
+
+    assert len ( ds2 ) == len ( ds3 ) , 'Invalid size of the dataset!'
+    s2 , s3 = ds2.statVar ( 'mass' ) , ds3.statVar ( 'mass' )
+    assert s2.mean ().value () == s3.mean ().value () and s2.rms () == s3.rms () , \
+           'Result must not depend on number of threads!'
+    
+    m1 = ds1.statVar ( 'mass' ).mean ()
+    m2 = ds2.statVar ( 'mass' ).mean ()
+    logger.info ( 'Mean standard/fast: %s/%s' % ( m1 , m2 ) )
+    assert abs ( m1.value () - m2.value () ) < 5 * m1.error () , 'Large difference in means!'
+
+    ## the same via make_toys 
+    results , stats = Toys.make_toys  (
+        pdf         = gen_gauss ,
+        nToys       = 100       ,
+        data        = [ mass ]  , 
+        gen_config  = { 'nEvents' : 200  , 'sample'  : True , 'fast' : True } ,
+        fit_config  = { 'silent'  : True } ,
+        init_pars   = { 'mean_GG' : 0.4  , 'sigma_GG' : 0.1 } ,
+        silent      = True , 
+        progress    = True )
+
+# =============================================================================
+## Streaming and mergeable statistics for toys: constant memory 
+def test_toys_stats ( ) :
+    """Streaming and mergeable statistics for toys: constant memory 
+    """
+
+    logger = getLogger ( 'test_toys_stats' )
+
+    all_stats = None 
+    for i in range ( 2 ) : 
+        results , stats = Toys.make_toys_fast (
+            pdf         = gen_gauss ,
+            nToys       = 500       ,
+            data        = [ mass ]  , 
+            gen_config  = { 'nEvents' : 200  , 'sample'   : True } ,
+            init_pars   = { 'mean_GG' : 0.4  , 'sigma_GG' : 0.1  } ,
+            store       = False ,
+            silent      = True  , 
+            progress    = False )
+        
+        assert not results , 'Results must not be stored!'
+        all_stats = stats if all_stats is None else all_stats + stats 
+
+    ## serialization 
+    import pickle
+    all_stats = pickle.loads ( pickle.dumps ( all_stats ) ) 
+    
+    all_stats.print_stats ( logger = logger )
+    
+    logger.info ( 'Median of mean_GG  : %+.5f' % all_stats.quantile    ( 'mean_GG' , 0.5 ) ) 
+    logger.info ( 'corr(mean,sigma)   : %+.3f' % all_stats.correlation ( 'mean_GG' , 'sigma_GG' ) ) 
+    
 # =============================================================================
 ## Perform toy-study for possible fit bias and correct uncertainty evaluation
 #  - generate <code>nToys</code> pseudoexperiments with some PDF <code>gen_pdf</code>
@@ -193,6 +284,9 @@ def test_significance_toys ( ) :
 if '__main__' == __name__ :
 
     test_toys  () 
+    test_toys_fast () 
+    test_toys_generate_fast () 
+    test_toys_stats () 
     test_toys2 () 
     test_significance_toys ( ) 
     
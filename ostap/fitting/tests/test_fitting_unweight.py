@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developers.
+# =============================================================================
+# @file test_fitting_unweight.py
+# Test module for accept/reject unweighting of weighted datasets
+# @see Ostap::Utils::accept_reject
+# =============================================================================
+""" Test module for accept/reject unweighting of weighted datasets
+- see Ostap.Utils.accept_reject
+"""
+# =============================================================================
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# =============================================================================
+import ROOT, random
+from   builtins                 import range
+import ostap.fitting.roofit
+from   ostap.utils.timing       import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ :
+    logger = getLogger ( 'test_fitting_unweight' )
+else :
+    logger = getLogger ( __name__              )
+# =============================================================================
+
+x = ROOT.RooRealVar ( 'x' , 'x-variable' , 0 , 10 )
+w = ROOT.RooRealVar ( 'w' , 'weight'     , 0 , 10 )
+N = 200000
+
+data = ROOT.RooDataSet ( 'data' , 'test data' , ROOT.RooArgSet ( x , w ) )
+for i in range ( N ) :
+    x.setVal ( random.uniform ( 0 , 10 ) )
+    w.setVal ( x.getVal () / 10 )
+    data.add ( ROOT.RooArgSet ( x , w ) )
+wdata = data.makeWeighted ( 'w' )
+
+# =============================================================================
+## unweighting: reproducibility and the weighted mean
+def test_accept_reject () :
+
+    logger = getLogger ( 'test_accept_reject' )
+
+    with timing ( 'Sequential    unweighting' , logger = logger ) :
+        ds1 = wdata.accept_reject ( seed = 12345 )
+    with timing ( 'Multithreaded unweighting' , logger = logger ) :
+        ds2 = wdata.accept_reject ( seed = 12345 , nthreads = 4 )
+    ds3 = wdata.accept_reject ( seed = 54321 , nthreads = 4 )
+
+    assert not ds1.isWeighted () , 'Dataset must be non-weighted!'
+    assert len ( ds1 ) == len ( ds2 ) , 'Result depends on the number of threads!'
+    for i in range ( 0 , len ( ds1 ) , 97 ) :
+        assert ds1 [ i ].x.getVal () == ds2 [ i ].x.getVal () , 'Result depends on the number of threads!'
+
+    ## expected number of accepted entries: sum(w)/wmax
+    ds4      = wdata.accept_reject ( seed = 12345 , nthreads = 4 , wmax = 1.0 )
+    expected = wdata.sumEntries () / 1.0
+    logger.info ( 'Accepted %d/%d/%d entries, expected %.1f' % ( len ( ds1 ) , len ( ds3 ) , N , expected ) )
+    assert abs ( len ( ds4 ) - expected ) < 5 * expected ** 0.5 , 'Invalid number of accepted entries!'
+
+    ## the weighted mean is preserved: <x>_w = 20/3
+    s1 = wdata.statVar ( 'x' )
+    s2 = ds1  .statVar ( 'x' )
+    logger.info ( 'Mean: weighted %s, unweighted %s' % ( s1.mean () , s2.mean () ) )
+    assert abs ( s1.mean ().value () - s2.mean ().value () ) < 0.05 , 'Invalid mean value!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_accept_reject ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
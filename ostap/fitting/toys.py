@@ -15,17 +15,23 @@ __version__ = '$Revision$'
 __all__     = (
     "make_toys"        , ## run fitting toys (the same PDF to generate and fit)
     "make_toys2"       , ## run fitting toys (separate models to generate and fit)
+    "make_toys_fast"   , ## run fitting toys with NLL&minimizer built only once 
+    "generate_fast"    , ## fast multithreaded generation of data for Ostap shapes 
+    "ToysEngine"       , ## engine for fast toys: NLL&minimizer are built once 
+    "FitEngine"        , ## engine for repeated fits: NLL&minimizer are built once 
     'make_jackknife'   , ## run Jackknife analysis 
     'make_bootstrap'   , ## run Bootstrapanalysis 
     "vars_transform"   , ## helper fnuction to transform the variables
     "print_stats"      , ## print toys      statistics 
+    "ToyStats"         , ## streaming mergeable statistics of toys 
     "print_jackknife"  , ## print jackknife statistics 
     "print_bootstrap"  , ## print bootstrap statistics 
     )
 # =============================================================================
 import ROOT
 from   builtins          import range
-from   ostap.core.core   import VE
+from   ostap.core.core   import VE, Ostap, dsID 
+from   ostap.core.ostap_types import integer_types 
 # =============================================================================
 # logging 
 # =============================================================================
@@ -124,6 +130,333 @@ def print_stats (  stats , ntoys = '' , logger = logger ) :
     logger.info ( 'Results of %s toys:\n%s' % ( ntoys , table ) ) 
 
 
+# =============================================================================
+## @class ToyStats
+#  Streaming (constant memory) and mergeable statistics of toys/jackknife/bootstrap
+#  - it is a dictionary <code>{ name : SE }</code>, compatible with
+#    <code>make_stats</code> and <code>print_stats</code>
+#  - (approximate) running quantiles via P2-algorithm 
+#  - running covariances for all pairs of parameters 
+#  - pulls with respect to the true values 
+#  @code
+#  stats = ToyStats ( quantiles = ( 0.16 , 0.50 , 0.84 ) )
+#  for i in range ( nToys ) :
+#  ...   r , ds = ...
+#  ...   stats.add_result ( r , true_values = gen_pars ) 
+#  stats.print_stats () 
+#  stats += other_stats                 ## merge results from other workers
+#  q = stats.quantile   ( 'mu' , 0.5 )  ## the median
+#  c = stats.covariance ( 'mu' , 'sigma' )
+#  @endcode
+#  @attention P2-quantiles are not mergeable:
+#  after merging the quantiles are estimated as the averages of (per-worker)
+#  quantiles, weighted with the number of entries
+#  @see Ostap::StatEntity
+#  @see Ostap::Math::GSL::P2Quantile
+#  @see Ostap::Math::Covariance
+class ToyStats(dict) :
+    """Streaming (constant memory) and mergeable statistics of toys/jackknife/bootstrap
+    - it is a dictionary `{ name : SE }`, compatible with `make_stats` and `print_stats`
+    - (approximate) running quantiles via P2-algorithm 
+    - running covariances for all pairs of parameters 
+    - pulls with respect to the true values 
+    >>> stats = ToyStats ( quantiles = ( 0.16 , 0.50 , 0.84 ) )
+    >>> for i in range ( nToys ) :
+    ...   r , ds = ...
+    ...   stats.add_result ( r , true_values = gen_pars ) 
+    >>> stats.print_stats () 
+    >>> stats += other_stats                 ## merge results from other workers
+    >>> q = stats.quantile   ( 'mu' , 0.5 )  ## the median
+    >>> c = stats.covariance ( 'mu' , 'sigma' )
+    - attention: P2-quantiles are not mergeable: after merging the quantiles
+    are estimated as the averages of (per-worker) quantiles, weighted with
+    the number of entries  
+    - see Ostap.StatEntity
+    - see Ostap.Math.GSL.P2Quantile
+    - see Ostap.Math.Covariance
+    """
+    def __init__ ( self , quantiles = ( 0.16 , 0.50 , 0.84 ) , covariance = True ) :
+
+        dict.__init__ ( self )
+        
+        quantiles = tuple ( sorted ( set ( float ( p ) for p in quantiles ) ) )
+        assert all ( 0 < p < 1 for p in quantiles ) , \
+               'ToyStats: invalid quantiles %s' % str ( quantiles )
+        
+        self.__quantiles  = quantiles
+        self.__covariance = True if covariance else False 
+        self.__p2         = {} ## live P2-quantiles   : name -> [ P2Quantile ]
+        self.__merged     = {} ## merged P2-quantiles : name -> [ ( n , sum(n*q) ) ]
+        self.__covs       = {} ## covariances         : ( name1 , name2 ) -> Covariance
+
+    # =========================================================================
+    ## add the values  <code>{ name : value }</code>
+    #  @code
+    #  stats = ...
+    #  stats.add ( { 'mu' : 1.0 , 'sigma' : 0.1 } ) 
+    #  @endcode
+    #  - names, started from <code>'#'</code> and <code>'-'</code> are
+    #    not used for quantiles and covariances 
+    def add ( self , values ) :
+        """Add the values `{ name : value }`
+        >>> stats = ...
+        >>> stats.add ( { 'mu' : 1.0 , 'sigma' : 0.1 } ) 
+        - names, started from `#` and `-` are not used for quantiles and covariances 
+        """
+        from ostap.core.core import SE, Ostap
+
+        main = []
+        for name in values :
+            
+            value = float ( values [ name ] ) 
+            cnt   = self.get ( name , None )
+            if cnt is None :
+                cnt = SE ()
+                self [ name ] = cnt 
+            cnt += value
+
+            if name.startswith ( ( '#' , '-' ) ) : continue
+
+            main.append ( ( name , value ) )
+            
+            qs = self.__p2.get ( name , None )
+            if qs is None :
+                qs = [ Ostap.Math.GSL.P2Quantile ( p ) for p in self.__quantiles ]
+                self.__p2 [ name ] = qs
+            for q in qs : q.add ( value )
+
+        if self.__covariance and 2 <= len ( main ) :
+            main.sort () 
+            for i , ( n1 , v1 ) in enumerate ( main ) :
+                for n2 , v2 in main [ i + 1 : ] :
+                    key = n1 , n2 
+                    cov = self.__covs.get ( key , None )
+                    if cov is None :
+                        cov = Ostap.Math.Covariance ()
+                        self.__covs [ key ] = cov 
+                    cov.add ( v1 , v2 ) 
+                    
+    # =========================================================================
+    ## add the fit result (and the pulls with respect to the true values)
+    #  @code
+    #  stats = ...
+    #  r     = ...
+    #  stats.add_result ( r , true_values = { 'mu' : 1.0 } )
+    #  @endcode 
+    #  @param result      the fit result 
+    #  @param true_values the true values of parameters for pulls 
+    #  @param more        more values <code>{ name : value }</code>
+    def add_result ( self , result , true_values = {} , more = {} ) :
+        """Add the fit result (and the pulls with respect to the true values)
+        >>> stats = ...
+        >>> r     = ...
+        >>> stats.add_result ( r , true_values = { 'mu' : 1.0 } )
+        """
+        values = {}
+        rpf    = result.params ( float_only = True )
+        for p in rpf :
+            v = rpf [ p ] [ 0 ]
+            values [ p ] = v.value ()
+            if p in true_values :
+                e = v.error() 
+                if 0 < e : values [ 'pull:%s' % p ] = ( v.value () - float ( true_values [ p ] ) ) / e 
+        values.update ( more )
+        self.add ( values )
+        
+    # =========================================================================
+    ## add the fit status and the quality of the covariance matrix
+    def add_status ( self , status , covqual ) :
+        """Add the fit status and the quality of the covariance matrix
+        """
+        self.__count ( '- Status  %s' % status  )
+        self.__count ( '- CovQual %s' % covqual )
+        
+    def __count ( self , name ) :
+        from ostap.core.core import SE        
+        cnt = self.get ( name , None )
+        if cnt is None :
+            cnt = SE ()
+            self [ name ] = cnt 
+        cnt += 1
+        
+    # =========================================================================
+    ## summaries of quantiles for the given name: <code>[ ( n , sum(n*q) ) ]</code>
+    def __summary  ( self , name ) :
+        """Summaries of quantiles for the given name: `[ ( n , sum(n*q) ) ]`"""
+        merged = self.__merged.get ( name , [ ( 0 , 0.0 ) for p in self.__quantiles ] )
+        live   = self.__p2    .get ( name , () )
+        result = [] 
+        for i , ( n , s ) in enumerate ( merged ) :
+            if live and 0 < live [ i ].n () :
+                q  = live [ i ]
+                n += q.n ()
+                s += q.n () * q.value ()
+            result.append ( ( n , s ) ) 
+        return result
+                                                        
+    # =========================================================================
+    ## get the (approximate) quantile for the given name 
+    #  @code
+    #  stats  = ...
+    #  median = stats.quantile ( 'mu' , 0.5 ) 
+    #  @endcode 
+    def quantile ( self , name , p ) :
+        """Get the (approximate) quantile for the given name
+        >>> stats  = ...
+        >>> median = stats.quantile ( 'mu' , 0.5 ) 
+        """
+        p = float ( p ) 
+        assert p in self.__quantiles , \
+               "ToyStats: the quantile %s is not in %s" % ( p , str ( self.__quantiles ) ) 
+        n , s = self.__summary ( name ) [ self.__quantiles.index ( p ) ]
+        return s / n if 0 < n else 0.0 
+
+    # =========================================================================
+    ## get the covariance counter for two names
+    #  @see Ostap::Math::Covariance 
+    def counter ( self , name1 , name2 ) :
+        """Get the covariance counter for two names
+        - see Ostap.Math.Covariance 
+        """
+        key = ( name1 , name2 ) if name1 <= name2 else ( name2 , name1 )
+        return self.__covs.get ( key , None ) 
+        
+    # =========================================================================
+    ## get the covariance for two names 
+    def covariance ( self , name1 , name2 ) :
+        """Get the covariance for two names"""
+        if name1 == name2 : return self [ name1 ].mu2 () 
+        cnt = self.counter ( name1 , name2 ) 
+        return cnt.covariance () if cnt else 0.0 
+
+    # =========================================================================
+    ## get the correlation coefficient for two names 
+    def correlation ( self , name1 , name2 ) :
+        """Get the correlation coefficient for two names"""
+        if name1 == name2 : return 1.0 
+        cnt = self.counter ( name1 , name2 ) 
+        return cnt.correlation () if cnt else 0.0 
+
+    # =========================================================================
+    ## merge with other statistics (e.g. from the parallel worker)
+    #  @code
+    #  stats  = ...
+    #  stats += other_stats 
+    #  @endcode
+    def __iadd__ ( self , other ) :
+        """Merge with other statistics (e.g. from the parallel worker)
+        >>> stats  = ...
+        >>> stats += other_stats 
+        """
+        if not isinstance ( other , ToyStats ) : return NotImplemented
+        from ostap.core.core import SE, Ostap
+        assert self.quantiles == other.quantiles , \
+               "ToyStats: can't merge different quantiles %s vs %s" % ( self.quantiles , other.quantiles )
+        
+        for name in other :
+            if name in self : self [ name ] += other [ name ]
+            else            : self [ name ]  = SE ( other [ name ] ) 
+            
+        for name in set ( self.__p2 ) | set ( self.__merged ) | set ( other.__p2 ) | set ( other.__merged ) :
+            s1 = self .__summary ( name )
+            s2 = other.__summary ( name )
+            self.__merged [ name ] = [ ( a [ 0 ] + b [ 0 ] , a [ 1 ] + b [ 1 ] ) for a , b in zip ( s1 , s2 ) ]
+            self.__p2.pop ( name , None )
+            
+        for key in other.__covs :
+            if key in self.__covs : self.__covs [ key ] += other.__covs [ key ]
+            else                  : self.__covs [ key ]  = Ostap.Math.Covariance ( other.__covs [ key ] ) 
+                
+        return self
+
+    # =========================================================================
+    ## merge two statistics
+    def __add__ ( self , other ) :
+        """Merge two statistics"""
+        if not isinstance ( other , ToyStats ) : return NotImplemented
+        result  = ToyStats ( self.quantiles , self.__covariance )
+        result += self
+        result += other
+        return result 
+    
+    # =========================================================================
+    ## Serialization: P2-quantiles are converted to summaries
+    def __getstate__ ( self ) :
+        """Serialization: P2-quantiles are converted to summaries"""
+        names = set ( self.__p2 ) | set ( self.__merged )
+        return { 'quantiles'  : self.__quantiles  ,
+                 'covariance' : self.__covariance ,
+                 'merged'     : dict ( ( n , self.__summary ( n ) ) for n in names ) ,
+                 'covs'       : self.__covs       }
+
+    ## Deserialization
+    def __setstate__ ( self , state ) :
+        """Deserialization"""
+        self.__quantiles  = state [ 'quantiles'  ]
+        self.__covariance = state [ 'covariance' ]
+        self.__merged     = state [ 'merged'     ]
+        self.__covs       = state [ 'covs'       ]
+        self.__p2         = {}
+
+    ## serialization 
+    def __reduce__ ( self ) :
+        """Serialization"""
+        return ToyStats , ( self.__quantiles , self.__covariance ) , self.__getstate__ () , None , iter ( self.items () )
+
+    @property
+    def quantiles ( self ) :
+        """``quantiles'' : quantiles to be estimated"""
+        return self.__quantiles
+
+    @property
+    def ntoys ( self ) :
+        """``ntoys'' : number of processed toys"""
+        n = sum ( self [ k ].nEntries () for k in self if k.startswith ( '- Status' ) )
+        return n if n else max ( [ c.nEntries () for c in self.values () ] + [ 0 ] )
+    
+    # =========================================================================
+    ## make a table with statistics, quantiles and correlations
+    def table ( self , title = '' , prefix = '' ) :
+        """Make a table with statistics, quantiles and correlations
+        """
+        names = sorted ( k for k in self if not k.startswith ( ( '#' , '-' ) ) )
+        names = [ n for n in names if not n.startswith ( 'pull:' ) ] + \
+                [ n for n in names if     n.startswith ( 'pull:' ) ]
+
+        header = ( 'Parameter' , '#', 'mean' , 'rms' ) + tuple ( 'Q(%.3g)' % p for p in self.__quantiles )
+        rows   = [ header ]  
+        for name in names :
+            c    = self [ name ] 
+            mean = c.mean () 
+            row  = name , '%d' % c.nEntries () , \
+                   "%+13.6g +/- %-13.6g" % ( mean.value() , mean.error() ) , \
+                   "%13.6g" % c.rms ()
+            row += tuple ( '%+13.6g' % self.quantile ( name , p ) for p in self.__quantiles ) 
+            rows.append ( row )
+
+        main = [ n for n in names if not n.startswith ( 'pull:' ) ]
+        if self.__covariance and 2 <= len ( main ) :
+            rows.append ( ( 'Correlations' , ) + ( '' , ) * ( len ( header ) - 1 ) )
+            for i , n1 in enumerate ( main ) :
+                for n2 in main [ i + 1 : ] :
+                    cnt = self.counter ( n1 , n2 )
+                    if not cnt : continue 
+                    row = '(%s,%s)' % ( n1 , n2 ) , '%d' % cnt.n () , '%+.3f' % cnt.correlation () 
+                    rows.append ( row + ( '' , ) * ( len ( header ) - len ( row ) ) )
+
+        import ostap.logger.table as Table
+        title = title if title else 'Results of %s toys' % self.ntoys 
+        return Table.table ( rows , title = title , alignment = 'lccc' + 'c' * len ( self.__quantiles ) , prefix = prefix )
+
+    # =========================================================================
+    ## print the summary 
+    def print_stats ( self , ntoys = '' , logger = logger ) :
+        """Print the summary"""
+        ntoys = ntoys if ntoys else self.ntoys
+        title = 'Results of %s toys' % ntoys 
+        logger.info ( '%s:\n%s' % ( title , self.table ( title , prefix = '# ' ) ) ) 
+
+
 # =============================================================================
 ## Jackknife estimator from jackknife statistic
 #  @code
@@ -304,13 +637,109 @@ def print_bootstrap  ( fitresult          ,
     logger.info ( '%s:\n%s' % ( title , table ) )
     
 
+# ==============================================================================
+## Fast generation of the data for PDFs, that provide the underlying
+#  C++ function with the analytic integrals (<code>pdf.pdf.function()</code>)
+#  - 1D case: inversion of the tabulated cumulative distribution
+#  - 2D/3D case: alias-table sampling of the grid cells 
+#  - the events are generated in C++ using several threads 
+#  and the dataset is filled directly from the array
+#  @code
+#  pdf  = ...
+#  data = generate_fast ( pdf , nEvents = 10000 , seed = 12345 ) 
+#  @endcode
+#  For other PDFs it falls back to <code>PDF.generate</code>
+#  @see Ostap::Math::InverseCDF
+#  @see Ostap::Math::GridGenerator
+#  @param pdf      the PDF
+#  @param nEvents  number of events
+#  @param varset   variables for the dataset 
+#  @param sample   sample number of events ?
+#  @param seed     the seed, if not specified it is taken from <code>ROOT.gRandom</code>
+#  @param nthreads number of threads (0: all available) 
+#  @param nbins    number of bins (per axis) to tabulate the distribution
+#  @attention the generated distribution is piecewise linear (1D) or
+#             piecewise constant (2D/3D) approximation of the PDF 
+def generate_fast ( pdf              ,
+                    nEvents          ,
+                    varset   = None  ,
+                    sample   = True  ,
+                    seed     = None  ,
+                    nthreads = 0     ,
+                    nbins    = None  ) :
+    """Fast generation of the data for PDFs, that provide the underlying
+    C++ function with analytic integrals (`pdf.pdf.function()`)
+    - 1D case: inversion of the tabulated cumulative distribution
+    - 2D/3D case: alias-table sampling of the grid cells 
+    - the events are generated in C++ using several threads 
+    and the dataset is filled directly from the array
+    >>> pdf  = ...
+    >>> data = generate_fast ( pdf , nEvents = 10000 , seed = 12345 ) 
+    For other PDFs it falls back to `PDF.generate`
+    - see Ostap.Math.InverseCDF
+    - see Ostap.Math.GridGenerator
+    - attention: the generated distribution is piecewise linear (1D) 
+    or piecewise constant (2D/3D) approximation of the PDF 
+    """
+    
+    observables = [ pdf.xvar ]
+    if hasattr ( pdf , 'yvar' ) : observables.append ( pdf.yvar )
+    if hasattr ( pdf , 'zvar' ) : observables.append ( pdf.zvar )
+
+    ## only the observables are allowed here 
+    extra = [ v for v in varset if not v in observables ] if varset else [] 
+    
+    fun = None 
+    if not extra and hasattr ( pdf.pdf , 'function' ) :
+        if hasattr ( pdf.pdf , 'setPars' ) : pdf.pdf.setPars ()
+        fun = pdf.pdf.function ()
+        
+    if fun is None or not hasattr ( fun , 'integral' ) :
+        logger.debug ( "generate_fast: fall back to ``generate'' for %s" % pdf.name )
+        return pdf.generate ( nEvents = nEvents , varset = varset , sample = sample )
+    
+    ## sample number of events in dataset ?
+    nEvents = pdf.gen_sample ( nEvents ) if sample else nEvents 
+    assert isinstance ( nEvents , integer_types ) and 0 <= nEvents , \
+           'Invalid number of Events %s' % nEvents  
+
+    if seed is None :
+        seed = ROOT.gRandom.Integer ( 2**31 ) * 2**31 + ROOT.gRandom.Integer ( 2**31 )
+        
+    ranges = []
+    for v in observables : ranges += [ v.getMin () , v.getMax () ]
+    
+    dim = len ( observables )
+    if   1 == dim :
+        generator = Ostap.Math.InverseCDF    ( fun , *( ranges + [ nbins if nbins else 4096 ] ) ) 
+    elif 2 == dim :
+        generator = Ostap.Math.GridGenerator ( fun , *( ranges + [ nbins if nbins else 256 ] * 2 ) )
+    else :
+        generator = Ostap.Math.GridGenerator ( fun , *( ranges + [ nbins if nbins else 64  ] * 3 ) )
+
+    vlist = ROOT.RooArgList ()
+    for v in observables : vlist.add ( v )
+    
+    dataset = ROOT.RooDataSet ( dsID () , 'Fast toy data for %s' % pdf.name , ROOT.RooArgSet ( vlist ) )
+    if nEvents :
+        data = generator.generate ( nEvents , seed , nthreads )
+        Ostap.Utils.fill_dataset ( dataset , vlist , nEvents , data.data () )
+        
+    return dataset
+
 # ==============================================================================
 ## Default function to generate the data
 #  - simple call for <code>PDF.generate</code>
+#  - if <code>fast=True</code> is specified, <code>generate_fast</code> is used 
+#  @see generate_fast 
 def generate_data ( pdf , varset , **config ) :
     """Default function to generate the data
     - simple call for `PDF.generate`
+    - if `fast=True` is specified, `generate_fast` is used 
+    - see generate_fast 
     """
+    if config.pop ( 'fast' , False ) :
+        return generate_fast ( pdf , varset = varset , **config )
     return pdf.generate ( varset = varset , **config )
 
 # ==============================================================================
@@ -594,6 +1023,333 @@ def make_toys ( pdf                 ,
     return results, stats 
 
 
+# =============================================================================
+## @class FitEngine
+#  Engine for repeated fits with the same model: the NLL and minimizer 
+#  are built at the first fit and reused for all subsequent fits:
+#  - the NLL (with <code>CloneData(False)</code>) is attached to the new 
+#    dataset via <code>RooAbsReal::setData</code>
+#  - the same <code>RooMinimizer</code> is used for all fits 
+#  @code
+#  engine = FitEngine ( pdf )
+#  for ds in datasets :
+#  ...  result = engine.fit ( ds ) 
+#  @endcode 
+#  @see ostap.fitting.basic.PDF.nll
+#  @see ostap.fitting.basic.PDF.minuit
+class FitEngine(object) :
+    """Engine for repeated fits with the same model: the NLL and minimizer 
+    are built at the first fit and reused for all subsequent fits:
+    - the NLL (with `CloneData(False)`) is attached to the new 
+    dataset via `RooAbsReal.setData`
+    - the same `RooMinimizer` is used for all fits 
+    >>> engine = FitEngine ( pdf )
+    >>> for ds in datasets :
+    ...     result = engine.fit ( ds ) 
+    """
+    def __init__ ( self              ,
+                   fit_pdf           , ## PDF to fit 
+                   fit_config = {}   , ## configuration for NLL&minimizer
+                   hesse      = True , ## run Hesse after Migrad 
+                   silent     = True ) :
+
+        self.__fit_pdf = fit_pdf
+        self.__hesse   = hesse
+        
+        config = dict ( fit_config )
+
+        ## split the configuration into minimizer and NLL parts 
+        minuit_keys = ( 'max_calls' , 'max_iterations' , 'opt_const' ,
+                        'strategy'  , 'print_level'    , 'offset'    )
+        self.__mconf = {}
+        for k in minuit_keys :
+            if k in config : self.__mconf [ k ] = config.pop ( k )
+        self.__mconf [ 'silent' ] = config.pop ( 'silent' , silent  )
+        self.__opt_const = self.__mconf.get ( 'opt_const' , True )
+        
+        ## skip the options, irrelevant for NLL
+        for k in ( 'refit' , 'draw' , 'nbins' , 'timer' , 'ncpu' , 'ncpus' ) : config.pop ( k , None )
+        self.__nconf  = config
+        
+        self.__dataset   = None 
+        self.__nll       = None
+        self.__minimizer = None
+        
+    # =========================================================================
+    ## fit the dataset: NLL and minimizer are created at the first call only 
+    def fit ( self , dataset ) :
+        """Fit the dataset: NLL and minimizer are created at the first call only"""
+        if self.__nll is None :
+            self.__nll , _   = self.__fit_pdf.nll ( dataset , silent = True , **self.__nconf )
+            self.__minimizer = self.__fit_pdf.minuit ( nLL = self.__nll , **self.__mconf )
+        else : 
+            self.__nll.setData ( dataset , False )
+            ## re-cache the constant terms for the new data 
+            if self.__opt_const : self.__minimizer.optimizeConst ( True )
+
+        ## keep the dataset alive while it is attached to NLL
+        self.__dataset = dataset
+        
+        self.__minimizer.migrad ()
+        if self.__hesse : self.__minimizer.hesse () 
+        return self.__minimizer.save ()
+    
+    @property
+    def fit_pdf ( self ) :
+        """``fit_pdf'' : PDF to fit the data"""
+        return self.__fit_pdf
+    @property
+    def nll     ( self ) :
+        """``nll'' : the (reused) NLL object"""
+        return self.__nll
+
+# =============================================================================
+## @class ToysEngine
+#  Engine for fast toys: the generator context, NLL and minimizer 
+#  are built only once and reused for all pseudoexperiments:
+#  - the data are generated using <code>RooAbsPdf::prepareMultiGen</code> 
+#  - the fits are performed with FitEngine 
+#  @code
+#  engine = ToysEngine ( pdf , varset , nEvents = 1000 )
+#  for i in range ( 100 ) :
+#  ...  result , dataset = engine.toy ( fix_pars ) 
+#  @endcode 
+#  @see FitEngine 
+class ToysEngine(FitEngine) :
+    """Engine for fast toys: the generator context, NLL and minimizer 
+    are built only once and reused for all pseudoexperiments:
+    - the data are generated using `RooAbsPdf.prepareMultiGen` 
+    - the fits are performed with FitEngine 
+    >>> engine = ToysEngine ( pdf , varset , nEvents = 1000 )
+    >>> for i in range ( 100 ) :
+    ...     result , dataset = engine.toy ( fix_pars ) 
+    - see FitEngine 
+    """
+    def __init__ ( self              ,
+                   gen_pdf           , ## PDF to generate 
+                   varset            , ## variables to generate 
+                   nEvents           , ## number of events 
+                   sample     = True , ## sample number of events?
+                   fit_pdf    = None , ## PDF to fit (the same by default) 
+                   fit_config = {}   , ## configuration for NLL&minimizer
+                   hesse      = True , ## run Hesse after Migrad 
+                   silent     = True ) :
+
+        FitEngine.__init__ ( self                                 ,
+                             fit_pdf    = fit_pdf if fit_pdf else gen_pdf ,
+                             fit_config = fit_config              ,
+                             hesse      = hesse                   ,
+                             silent     = silent                  )
+        
+        self.__gen_pdf = gen_pdf 
+        self.__varset  = varset
+        
+        ## the prepared generator context 
+        self.__spec    = gen_pdf.pdf.prepareMultiGen ( varset                              ,
+                                                       ROOT.RooFit.NumEvents ( nEvents   ) ,
+                                                       ROOT.RooFit.Extended  ( sample    ) )
+        
+    # =========================================================================
+    ## generate the new dataset
+    def generate ( self ) :
+        """Generate the new dataset"""
+        dataset = self.__gen_pdf.pdf.generate ( self.__spec )
+        ROOT.SetOwnership ( dataset , True )
+        return dataset 
+
+    # =========================================================================
+    ## make one pseudoexperiment
+    #  @param gen_pars parameters to be used for generation
+    #  @param fit_pars parameters to be used as the starting point for the fit 
+    #  @return fit-result and the dataset 
+    def toy ( self , gen_pars = {} , fit_pars = {} ) :
+        """Make one pseudoexperiment
+        - `gen_pars` : parameters to be used for generation
+        - `fit_pars` : parameters to be used as the starting point for the fit 
+        - return fit-result and the dataset 
+        """
+        if gen_pars : self.__gen_pdf.load_params ( params = gen_pars , silent = True )
+        dataset = self.generate ()
+        if fit_pars : self.fit_pdf.load_params ( params = fit_pars , silent = True ) 
+        return self.fit ( dataset ) , dataset
+
+    @property
+    def gen_pdf ( self ) :
+        """``gen_pdf'' : PDF to generate pseudoexperiments"""
+        return self.__gen_pdf
+
+# ==============================================================================
+## make <code>nToys</code> pseudoexperiments using ToysEngine
+#
+#  The same as make_toys, but the generator context, NLL and minimizer 
+#  are built only once, that greatly reduces the overhead per toy.
+#  Only <code>nEvents</code>/<code>sample</code> are allowed for <code>gen_config</code>,
+#  and the fit is the plain Migrad(+Hesse) minimization  
+#  @code
+#  pdf = ...
+#  results , stats = make_toys_fast ( pdf   ,   ## PDF  to use 
+#     nToys      = 1000        ,           ## Number of pseudoexperiments 
+#     data       = [ 'mass' ]  ,           ## variables in dataset 
+#     gen_config = { 'nEvents' : 5000 } ,  ## configuration of generation 
+#     init_pars  = { 'mean' : 0.0 , 'sigma' : 1.0 } ) ## parameters to use for generation 
+#  @endcode 
+#  @param fit_pdf    PDF to be used for fit (the same as <code>pdf</code> by default)
+#  @param fit_pars   the starting point for the fit (if <code>fit_pdf</code> is specified)
+#  @param hesse      run Hesse after Migrad
+#  @param store      store all results? Otherwise only the streaming statistics are kept 
+#  @attention the statistics is ToyStats object with quantiles, correlations and pulls 
+#  @see ToyStats 
+#  @see ToysEngine 
+#  @see make_toys 
+def make_toys_fast ( pdf                 ,
+                     nToys               , 
+                     data                , ## template for dataset/variables 
+                     gen_config          , ## parameters for generation: nEvents&sample 
+                     fit_config = {}     , ## parameters for NLL&minimizer
+                     init_pars  = {}     ,
+                     more_vars  = {}     ,
+                     accept_fun = None   , ## accept    function ( fit-result, pdf, dataset )
+                     fit_pdf    = None   , ## pdf to fit 
+                     fit_pars   = {}     , ## starting point for the fit 
+                     hesse      = True   , ## run Hesse? 
+                     store      = True   , ## store all results? 
+                     silent     = True   ,                
+                     progress   = True   ,
+                     logger     = logger ,
+                     frequency  = 1000   ) : ## 
+    """Make `nToys` pseudoexperiments using ToysEngine
+
+    The same as make_toys, but the generator context, NLL and minimizer 
+    are built only once, that greatly reduces the overhead per toy.
+    Only `nEvents`/`sample` are allowed for `gen_config`,
+    and the fit is the plain Migrad(+Hesse) minimization  
+    
+    >>> pdf = ...
+    ... results, stats = make_toys_fast ( pdf , ## PDF  to use 
+    ...                 1000                 , ## number of toys 
+    ...                 [ 'mass' ]           , ## variables in dataset 
+    ...                 { 'nEvents' : 5000 } , ## configuration of generation 
+    ...                 init_pars = { 'mean' : 0.0 , 'sigma' : 1.0 } ## parameters to use for generation 
+    ...                )
+    - `fit_pdf`  : PDF to be used for fit (the same as `pdf` by default)
+    - `fit_pars` : the starting point for the fit (if `fit_pdf` is specified)
+    - `hesse`    : run Hesse after Migrad
+    - `store`    : store all results? Otherwise only the streaming statistics are kept 
+    - the statistics is `ToyStats` object with quantiles, correlations and pulls 
+    - see ToyStats 
+    - see ToysEngine 
+    - see make_toys 
+    """
+
+    from ostap.core.ostap_types import string_types, integer_types  
+    
+    assert isinstance ( nToys , integer_types ) and 0 < nToys,\
+           'Invalid "nToys" argument %s/%s' % ( nToys , type ( nToys ) )
+    
+    assert gen_config and 'nEvents' in gen_config,\
+           'Number of events per toy must be specified via "gen_config" %s' % gen_config
+    
+    extra = set ( gen_config.keys () ) - set ( ( 'nEvents' , 'sample' ) )
+    assert not extra , 'make_toys_fast: unsupported keys %s for "gen_config", use make_toys' % list ( extra )
+        
+    if accept_fun is None : accept_fun = accept_fit
+    assert accept_fun and callable ( accept_fun ) , 'Invalid accept function!'
+
+    import ostap.fitting.roofit
+    import ostap.fitting.dataset
+    import ostap.fitting.variables
+    import ostap.fitting.roofitresult
+    import ostap.fitting.basic 
+
+    params = pdf.params ()
+    varset = ROOT.RooArgSet() 
+    
+    if isinstance ( data , ROOT.RooAbsData       ) : varset = data.varset() 
+    else :
+        for v in data :
+            if   isinstance ( v , ROOT.RooAbsArg ) :
+                varset.add ( v )
+            elif isinstance ( v , string_types   ) and v in params :
+                varset.add ( params [ v ] )
+            else :
+                raise TypeError('Invalid variable %s/%s' % ( v , type ( v ) ) )
+
+    fix_pars = vars_transform ( params    ) 
+    fix_init = vars_transform ( init_pars ) 
+
+    pdf.load_params ( params = fix_pars , silent = silent )
+    pdf.load_params ( params = fix_init , silent = silent )
+
+    ## the parameters for generation 
+    gen_pars = vars_transform ( pdf.params () )
+
+    ## the starting point for the fit 
+    if fit_pdf and not fit_pdf is pdf :
+        fit_start = vars_transform ( fit_pdf.params () )
+        fit_start.update ( vars_transform ( fit_pars ) )
+    else :
+        fit_pdf   = pdf 
+        fit_start = {}
+        
+    engine = ToysEngine ( gen_pdf    = pdf                                  ,
+                          varset     = varset                               ,
+                          nEvents    = gen_config [ 'nEvents' ]             ,
+                          sample     = gen_config.get ( 'sample' , True )   ,
+                          fit_pdf    = fit_pdf                              ,
+                          fit_config = fit_config                           ,
+                          hesse      = hesse                                ,
+                          silent     = silent                               )
+    
+    from collections import defaultdict 
+    results = defaultdict(list) 
+
+    ## streaming statistics 
+    stats   = ToyStats ()
+    ## true values for pulls 
+    true    = gen_pars if fit_pdf is pdf else {} 
+    
+    ## run pseudoexperiments
+    from ostap.utils.progress_bar import progress_bar 
+    for i in progress_bar ( range ( nToys ) , silent = not progress ) :
+
+        ## generate and fit 
+        r , dataset = engine.toy ( gen_pars , fit_start )
+        
+        stats.add_status ( r.status () , r.covQual () ) 
+              
+        if accept_fun ( r , fit_pdf , dataset ) : 
+
+            more = {} 
+            for v in more_vars :
+                func  = more_vars[v] 
+                more [ v ] = func ( r , fit_pdf )
+                
+            more [ '#'     ] = len ( dataset )
+            more [ '#sumw' ] = dataset.sumVar ( '1' )
+
+            stats.add_result ( r , true_values = true , more = more ) 
+                
+            if store : 
+                rpf = r.params ( float_only = True ) 
+                for p in rpf : results [ p ].append ( rpf [ p ][0] ) 
+                for v in more : results [ v ].append ( more [ v ] ) 
+
+        del r
+        
+        if progress or not silent :
+            if 0 < frequency and 1 <= i and 0 == ( i + 1 ) % frequency : 
+                stats.print_stats ( i + 1 , logger = logger )
+
+    del engine
+    
+    ## restore the parameters 
+    pdf.load_params ( params = gen_pars , silent = True )
+    
+    if progress or not silent :
+        stats.print_stats ( nToys , logger = logger )
+    
+    return results, stats 
+
 # =============================================================================
 ## make <code>nToys</code> pseudoexperiments
 #
@@ -873,6 +1629,7 @@ def make_toys2 ( gen_pdf             , ## pdf to generate toys
 #  @param fit_fun     fitting   function
 #  @param accept_fun  accept    function
 #  @param event_range event range to use for jackknife   
+#  @param view        use the weighted view of the dataset (no copies, see WeightView)
 #  @param silent      silent processing 
 #  @param progress    show progress bar?
 #  @param logger      use this logger
@@ -886,6 +1643,7 @@ def make_jackknife ( pdf                  ,
                      fit_fun     = None   , ## fit       function ( pdf , dataset , **fit_config ) 
                      accept_fun  = None   , ## accept    function ( fit-result, pdf, dataset     )
                      event_range = ()     , ## event range for jackknife                      
+                     view        = False  , ## use the weighted view of the dataset
                      silent      = True   ,
                      progress    = True   ,
                      logger      = logger ,
@@ -910,6 +1668,7 @@ def make_jackknife ( pdf                  ,
     - `fit_fun`     : specific fitting acion (if needed) 
     - `accept_fun`  : specific accept action (if needed)
     - `event_range` : event range to use for jackknife   
+    - `view`        : use the weighted view of the dataset (no copies, see WeightView)
     - `silent`      : silent processing?
     - `progress`    : show progress bar?
     - `logger`      : use this logger 
@@ -929,6 +1688,8 @@ def make_jackknife ( pdf                  ,
     ## adjust the end 
     end   = min ( end   , N )
     
+    assert not view or fit_fun is None , 'make_jackknife: "fit_fun" is not allowed for view' 
+    
     ## 1. fitting function? 
     if fit_fun is None :
         if not silent :  logger.info ( "make_jackknife: use default ``make_fit'' function!")
@@ -975,14 +1736,16 @@ def make_jackknife ( pdf                  ,
     
     from ostap.utils.progress_bar import progress_bar
     ## run jackknife  bootstrapping
-    for i , ds in progress_bar ( enumerate ( data.jackknife ( begin , end ) ) , max_value = end - begin , silent = not progress ) :
+    engine  = FitEngine ( pdf , fitcnf ) if view else None 
+    samples = data.jackknife_view ( begin , end ) if view else data.jackknife ( begin , end )
+    for i , ds in progress_bar ( enumerate ( samples ) , max_value = end - begin , silent = not progress ) :
 
         ## 2. reset parameters of fit_pdf
         pdf.load_params ( params = fix_fit_init , silent = silent )
         pdf.load_params ( params = fix_fit_pars , silent = silent )
  
         ## 3. fit it!  
-        r = fit_fun ( pdf , ds , **fitcnf ) 
+        r = engine.fit ( ds ) if view else fit_fun ( pdf , ds , **fitcnf ) 
 
         ## 4. fit status 
         fits [ r.status  () ] += 1
@@ -1003,10 +1766,10 @@ def make_jackknife ( pdf                  ,
                 func  = more_vars[v] 
                 results [ v ] .append ( func ( r , pdf ) )
                 
-            results [ '#'     ] .append ( len ( ds ) )
+            results [ '#'     ] .append ( ds.sumEntries () if view else len ( ds ) )
             results [ '#sumw' ] .append ( ds.sumVar ( '1' ) ) 
 
-        ds.clear()
+        if not view : ds.clear()
 
         if progress or not silent :
             if 0 < frequency and 1 <= i and 0 == ( i + 1 ) % frequency : 
@@ -1060,6 +1823,7 @@ def make_jackknife ( pdf                  ,
 #  @param more_vars  calculate more variables from the fit-results 
 #  @param fit_fun    specific fitting action (if needed) 
 #  @param accept_fun specific accept action (if needed) 
+#  @param view       use the weighted view of the dataset with Poisson multiplicities (no copies, see WeightView)
 #  @param silent     silent processing 
 #  @param progress   show progress bar?
 #  @param logger     use this logger
@@ -1073,6 +1837,7 @@ def make_bootstrap ( pdf                  ,
                      more_vars   = {}     ,   ## additional  results to be calculated
                      fit_fun     = None   ,   ## fit       function ( pdf , dataset , **fit_config ) 
                      accept_fun  = None   ,   ## accept    function ( fit-result, pdf, dataset     )
+                     view        = False  ,   ## use the weighted view of the dataset 
                      silent      = True   ,   ## silent processing?
                      progress    = True   ,   ## shpow progress bar? 
                      logger      = logger ,    ## use this logger 
@@ -1095,6 +1860,7 @@ def make_bootstrap ( pdf                  ,
     - `more_vars`  : calculate more variables from the fit-results
     - `fit_fun`    : specific fitting acion (if needed) 
     - `accept_fun` : specific accept action (if needed) 
+    - `view`       : use the weighted view of the dataset with Poisson multiplicities (no copies, see WeightView)
     - `silent`     : silent processing?
     - `progress`   : show progress bar?
     - `logger`     : use this logger 
@@ -1108,6 +1874,8 @@ def make_bootstrap ( pdf                  ,
     assert isinstance ( size , integer_types ) and 0 < size, \
            "make_bootstrap: invalid ``size'' parameter %s" % size 
     
+    assert not view or fit_fun is None , 'make_bootstrap: "fit_fun" is not allowed for view' 
+    
     ## 1. fitting function? 
     if fit_fun is None :
         if not silent :  logger.info ( "make_bootstrap: use default ``make_fit'' function!")
@@ -1154,14 +1922,16 @@ def make_bootstrap ( pdf                  ,
 
     from ostap.utils.progress_bar import progress_bar
     ## run jackknife  bootstrapping
-    for i , ds in progress_bar ( enumerate ( data.bootstrap ( size ) ) , max_value = size , silent = not progress ) :
+    engine  = FitEngine ( pdf , fitcnf ) if view else None 
+    samples = data.bootstrap_view ( size ) if view else data.bootstrap ( size )
+    for i , ds in progress_bar ( enumerate ( samples ) , max_value = size , silent = not progress ) :
 
         ## 2. reset parameters of fit_pdf
         pdf.load_params ( params = fix_fit_init , silent = silent )
         pdf.load_params ( params = fix_fit_pars , silent = silent )
  
         ## 3. fit it!  
-        r = fit_fun ( pdf , ds , **fitcnf ) 
+        r = engine.fit ( ds ) if view else fit_fun ( pdf , ds , **fitcnf ) 
 
         ## 4. fit status 
         fits [ r.status  () ] += 1
@@ -1182,10 +1952,10 @@ def make_bootstrap ( pdf                  ,
                 func  = more_vars[v] 
                 results [ v ] .append ( func ( r , pdf ) )
                 
-            results [ '#'     ] .append ( len ( ds ) )
+            results [ '#'     ] .append ( ds.sumEntries () if view else len ( ds ) )
             results [ '#sumw' ] .append ( ds.sumVar ( '1' ) ) 
 
-        ds.clear()
+        if not view : ds.clear()
         
         if progress or not silent :
             if 0 < frequency and 1 <= i and 0 == ( i + 1 )  % frequency : 
@@ -1327,6 +1327,39 @@ def _ra_reduce ( vars ) :
 Ostap.MoreRooFit.Combination.__reduce__  = _rc_reduce
 Ostap.MoreRooFit.Asymmetry.  __reduce__  = _ra_reduce
 
+# =============================================================================
+## factory for unpickling of <code>Ostap::MoreRooFit::FusedVar</code>
+#  @see Ostap::MoreRooFit::FusedVar
+def rfused_factory ( klass , name , title , leaves , program , constants ) :
+    """Factory for unpickling of `Ostap.MoreRooFit.FusedVar`
+    - see Ostap.MoreRooFit.FusedVar
+    """
+    lst = ROOT.RooArgList ()
+    for v in leaves : lst.add ( v )
+    
+    prg = ROOT.std.vector('unsigned int')()
+    for p in program   : prg.push_back ( p )
+    cst = ROOT.std.vector('double')()
+    for c in constants : cst.push_back ( c )
+    
+    return klass ( name , title , lst , prg , cst )
+
+# =============================================================================
+## Reduce <code>Ostap::MoreRooFit::FusedVar</code> objects
+#  @see Ostap::MoreRooFit.FusedVar
+def _rfused_reduce ( var ) :
+    """Reduce `Ostap.MoreRooFit.FusedVar` objects
+    - see Ostap.MoreRooFit.FusedVar
+    """
+    return rfused_factory , ( type  ( var )  ,
+                              var.name , var.title ,
+                              tuple ( l for l in var.leaves    () ) ,
+                              tuple ( p for p in var.program   () ) ,
+                              tuple ( c for c in var.constants () ) )
+
+
+Ostap.MoreRooFit.FusedVar.__reduce__  = _rfused_reduce
+
 
 
 # =============================================================================
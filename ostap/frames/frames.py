@@ -19,9 +19,14 @@ __all__     = (
     'frame_progress'     , ## progress bar for frame 
     'frame_table'        , ## print data frame as table 
     'frame_project'      , ## project data frame to the (1D/2D/3D) histogram 
+    'frame_define'       , ## define new column via compiled Ostap function (no JIT) 
+    'frame_filter'       , ## filter the frame via compiled Ostap function  (no JIT) 
+    'frame_tmva'         , ## add TMVA responses as new columns             (no JIT) 
+    'frame_filter_cached', ## filter the frame via cached compiled expression 
+    'frame_define_cached', ## define new column via cached compiled expression 
     ) 
 # =============================================================================
-import ROOT
+import ROOT, sys
 # =============================================================================
 from   ostap.core.core        import cpp, Ostap, strings, split_string  
 from   ostap.core.ostap_types import integer_types, string_types  
@@ -216,20 +221,17 @@ def _fr_statCov_ ( frame       ,
 
 
 # ==================================================================================
-## get statistics of variable(s)
+## define (if needed) the columns for expressions and cuts
 #  @code
-#  frame = ....
-#  stat  = frame.statVar ( 'pt'           , lazy = True )
-#  stat  = frame.statVar ( 'pt' , 'eta>0' , lazy = True )
+#  frame = ...
+#  current , names , cname = _fr_define_columns_ ( frame , [ 'pt' , 'pt/p' ] , 'eta>0' )
 #  @endcode
-def _fr_statVar_new_ ( frame , expressions , cuts = '' , lazy = False  ) :
-    """Get statistics of variable(s)
+#  @return the (updated) frame, mapping expression -> column name and the column name for cuts 
+def _fr_define_columns_ ( frame , expressions , cuts = '' ) :
+    """Define (if needed) the columns for expressions and cuts
+    >>> frame = ...
+    >>> current , names , cname = _fr_define_columns_ ( frame , [ 'pt' , 'pt/p' ] , 'eta>0' )
     """
-
-    input_string = False 
-    if isinstance ( expressions , string_types ) :
-        input_string = True 
-        expressions = [ expressions ]
     
     ## get the list of currently known names
     vars = tuple ( frame.GetColumnNames () ) 
@@ -255,14 +257,22 @@ def _fr_statVar_new_ ( frame , expressions , cuts = '' , lazy = False  ) :
         current = current.Define ( vn , cuts )
         cname   = vn
 
-    results = {}
-    for e in names :
+    return current , names , cname
 
-        if cname : 
-            results [ e ] = current.Book( Ostap.Actions.WStatVar() , CNT ( [ names [ e ] , cname ] ) ) 
-        else :
-            results [ e ] = current.Book( Ostap.Actions. StatVar() , CNT ( 1 , names[e] ) ) 
+# ==================================================================================
+## book the actions for the expressions and (optionally) get the results 
+def _fr_book_actions_ ( frame , expressions , cuts , lazy , book ) :
+    """Book the actions for the expressions and (optionally) get the results
+    """
+    input_string = False 
+    if isinstance ( expressions , string_types ) :
+        input_string = True 
+        expressions = [ expressions ]
 
+    current , names , cname = _fr_define_columns_ ( frame , expressions , cuts )
+    
+    results = {}
+    for e in names : results [ e ] = book ( current , names [ e ] , cname )
 
     if not lazy :
         for e in results :
@@ -275,6 +285,150 @@ def _fr_statVar_new_ ( frame , expressions , cuts = '' , lazy = False  ) :
     
     return results 
 
+# ==================================================================================
+## get statistics of variable(s)
+#  @code
+#  frame = ....
+#  stat  = frame.statVar ( 'pt'           , lazy = True )
+#  stat  = frame.statVar ( 'pt' , 'eta>0' , lazy = True )
+#  @endcode
+def _fr_statVar_new_ ( frame , expressions , cuts = '' , lazy = False  ) :
+    """Get statistics of variable(s)
+    """
+    def _book_ ( current , name , cname ) :
+        if cname : return current.Book( Ostap.Actions.WStatVar() , CNT ( [ name , cname ] ) ) 
+        return            current.Book( Ostap.Actions. StatVar() , CNT ( 1 , name ) ) 
+        
+    return _fr_book_actions_ ( frame , expressions , cuts , lazy , _book_ ) 
+
+# ==================================================================================
+## get the central moments (up to the given order) of variable(s)
+#  @code
+#  frame = ....
+#  m4    = frame_moment ( frame , 'pt'  , 4 ,         lazy = True )
+#  m4    = frame_moment ( frame , 'pt'  , 4 , 'eta>0' , lazy = True )
+#  @endcode
+#  @see Ostap::Math::Moment_
+#  @see Ostap::Math::WMoment_
+def frame_moment ( frame , expressions , order = 4 , cuts = '' , lazy = False ) :
+    """Get the central moments (up to the given order) of variable(s)
+    >>> frame = ....
+    >>> m4    = frame_moment ( frame , 'pt'  , 4 ,         lazy = True )
+    >>> m4    = frame_moment ( frame , 'pt'  , 4 , 'eta>0' , lazy = True )
+    - see Ostap::Math::Moment_
+    - see Ostap::Math::WMoment_
+    """
+    assert isinstance ( order , integer_types ) and 0 <= order ,\
+           "frame_moment: invalid order %s" % order 
+    
+    def _book_ ( current , name , cname ) :
+        if cname : return current.Book( ROOT.Detail.RDF.WMomentVar ( order ) () , CNT ( [ name , cname ] ) ) 
+        return            current.Book( ROOT.Detail.RDF. MomentVar ( order ) () , CNT ( 1 , name ) ) 
+        
+    return _fr_book_actions_ ( frame , expressions , cuts , lazy , _book_ ) 
+
+# ==================================================================================
+## get the (approximate) quantile of variable(s) using P2-algorithm
+#  @code
+#  frame  = ....
+#  median = frame_p2quantile ( frame , 'pt'  , 0.5 , lazy = True )
+#  @endcode
+#  @attention the cuts are used only as boolean selection (no weights!)
+#  @attention for multithreaded processing the result is the average of per-slot estimates
+#  @see Ostap::Math::GSL::P2Quantile
+def frame_p2quantile ( frame , expressions , p = 0.5 , cuts = '' , lazy = False ) :
+    """Get the (approximate) quantile of variable(s) using P2-algorithm
+    >>> frame  = ....
+    >>> median = frame_p2quantile ( frame , 'pt'  , 0.5 , lazy = True )
+    - attention: the cuts are used only as boolean selection (no weights!)
+    - attention: for multithreaded processing the result is the average of per-slot estimates
+    - see Ostap::Math::GSL::P2Quantile
+    """
+    assert 0 < p < 1 , "frame_p2quantile: invalid p %s" % p
+
+    if cuts : frame = frame.Filter ( str ( cuts ) )
+    
+    def _book_ ( current , name , cname ) :
+        return current.Book( Ostap.Actions.P2QuantileVar ( p ) , CNT ( 1 , name ) ) 
+        
+    return _fr_book_actions_ ( frame , expressions , '' , lazy , _book_ ) 
+
+# ==================================================================================
+## get the mergeable quantile sketch (t-digest) for variable(s)
+#  @code
+#  frame  = ....
+#  digest = frame_digest ( frame , 'pt'  , lazy = True )
+#  print ( digest.quantile ( 0.5 ) ) 
+#  @endcode
+#  @attention the cuts are used only as boolean selection (no weights!)
+#  @see Ostap::Math::TDigest
+def frame_digest ( frame , expressions , cuts = '' , compression = 100 , lazy = False ) :
+    """Get the mergeable quantile sketch (t-digest) for variable(s)
+    >>> frame  = ....
+    >>> digest = frame_digest ( frame , 'pt'  , lazy = True )
+    >>> print ( digest.quantile ( 0.5 ) ) 
+    - attention: the cuts are used only as boolean selection (no weights!)
+    - see Ostap::Math::TDigest
+    """
+    if cuts : frame = frame.Filter ( str ( cuts ) )
+    
+    def _book_ ( current , name , cname ) :
+        return current.Book( Ostap.Actions.TDigestVar ( compression ) , CNT ( 1 , name ) ) 
+        
+    return _fr_book_actions_ ( frame , expressions , '' , lazy , _book_ ) 
+
+# ==================================================================================
+## get the (weighted) covariance for the pair of variables
+#  @code
+#  frame = ....
+#  cov   = frame_covariance ( frame , 'pt'  , 'eta' ,         lazy = True )
+#  cov   = frame_covariance ( frame , 'pt'  , 'eta' , 'w>0' , lazy = True )
+#  print ( cov.covariance() , cov.correlation() ) 
+#  @endcode
+#  @see Ostap::Math::Covariance
+def frame_covariance ( frame , expression1 , expression2 , cuts = '' , lazy = False ) :
+    """Get the (weighted) covariance for the pair of variables
+    >>> frame = ....
+    >>> cov   = frame_covariance ( frame , 'pt'  , 'eta' ,         lazy = True )
+    >>> cov   = frame_covariance ( frame , 'pt'  , 'eta' , 'w>0' , lazy = True )
+    >>> print ( cov.covariance() , cov.correlation() ) 
+    - see Ostap::Math::Covariance
+    """
+    current , names , cname = _fr_define_columns_ ( frame , ( expression1 , expression2 ) , cuts )
+
+    columns = [ names [ expression1 ] , names [ expression2 ] ]
+    if cname : columns.append ( cname ) 
+    result  = current.Book ( Ostap.Actions.CovVar () , CNT ( columns ) )
+    
+    return result if lazy else result.GetValue()
+
+# ==================================================================================
+## get the (weighted) covariances for several variables in one pass
+#  @code
+#  frame = ....
+#  cov   = frame_covariances ( frame , [ 'pt' , 'eta' , 'phi' ] ,         lazy = True )
+#  cov   = frame_covariances ( frame , [ 'pt' , 'eta' , 'phi' ] , 'w>0' , lazy = True )
+#  print ( cov.covariance ( 0 , 1 ) , cov.correlation ( 0 , 2 ) ) 
+#  @endcode
+#  @see Ostap::Math::Covariances
+def frame_covariances ( frame , expressions , cuts = '' , lazy = False ) :
+    """Get the (weighted) covariances for several variables in one pass
+    >>> frame = ....
+    >>> cov   = frame_covariances ( frame , [ 'pt' , 'eta' , 'phi' ] ,         lazy = True )
+    >>> cov   = frame_covariances ( frame , [ 'pt' , 'eta' , 'phi' ] , 'w>0' , lazy = True )
+    >>> print ( cov.covariance ( 0 , 1 ) , cov.correlation ( 0 , 2 ) ) 
+    - see Ostap::Math::Covariances
+    """
+    if isinstance ( expressions , string_types ) : expressions = [ expressions ]
+    expressions = tuple ( expressions ) 
+    current , names , cname = _fr_define_columns_ ( frame , expressions , cuts )
+
+    columns = [ names [ e ] for e in expressions ]
+    if cname : columns.append ( cname ) 
+    result  = current.Book ( Ostap.Actions.CovVars ( len ( expressions ) ) , CNT ( columns ) )
+    
+    return result if lazy else result.GetValue()
+
 
 # =============================================================================
 ## Simplified print out for the  frame 
@@ -728,13 +882,192 @@ _new_methods_       = (
     )
 
 
+# =============================================================================
+## convert the frame into <code>ROOT::RDF::RNode</code> 
+def _as_node_ ( frame ) :
+    """Convert the frame into `ROOT::RDF::RNode`"""
+    return ROOT.RDF.AsRNode ( frame ) 
+
+# =============================================================================
+## Define new column using the compiled Ostap function, no JIT is involved
+#  - Ostap::Functions::Func1D/FuncTH1 & 2D/3D analogues 
+#  - any C++ callable, e.g. Ostap::Math shapes 
+#  - each processing slot gets its own copy of the function 
+#  @code
+#  frame = ...
+#  fun   = Ostap.Functions.FuncTH1 ( histo , '' )
+#  f2    = frame_define ( frame , 'w' , fun , 'pt' )
+#  f3    = frame_define ( f2    , 'g' , Ostap.Math.Gauss ( 3.1 , 0.015 ) , 'mass' ) 
+#  @endcode
+#  @see Ostap::Frames::define 
+def frame_define ( frame , name , fun , *columns ) :
+    """Define new column using the compiled Ostap function, no JIT is involved
+    - Ostap::Functions::Func1D/FuncTH1 & 2D/3D analogues 
+    - any C++ callable, e.g. Ostap::Math shapes 
+    - each processing slot gets its own copy of the function 
+    >>> frame = ...
+    >>> fun   = Ostap.Functions.FuncTH1 ( histo , '' )
+    >>> f2    = frame_define ( frame , 'w' , fun , 'pt' )
+    >>> f3    = frame_define ( f2    , 'g' , Ostap.Math.Gauss ( 3.1 , 0.015 ) , 'mass' ) 
+    - see Ostap::Frames::define 
+    """
+    assert 1 <= len ( columns ) <= 3 , 'frame_define: invalid number of columns %s' % str ( columns )
+    node = _as_node_ ( frame )
+    F    = Ostap.Functions 
+    if isinstance ( fun , ( F.Func1D , F.Func2D , F.Func3D ) ) :
+        return Ostap.Frames.define ( node , name , fun , *columns )
+    if   1 == len ( columns ) : return Ostap.Frames.define1 ( node , name , fun , *columns )
+    elif 2 == len ( columns ) : return Ostap.Frames.define2 ( node , name , fun , *columns )
+    return Ostap.Frames.define3 ( node , name , fun , *columns )
+
+# =============================================================================
+## Filter the frame using the compiled Ostap function: <code>low <= fun(x) < high</code>
+#  @code
+#  frame = ...
+#  fun   = Ostap.Functions.FuncTH2 ( histo , '' , '' )
+#  f2    = frame_filter ( frame , fun , 'x' , 'y' , low = 0.5 )
+#  @endcode
+#  @see Ostap::Frames::filter 
+def frame_filter ( frame , fun , *columns , **kwargs ) :
+    """Filter the frame using the compiled Ostap function: `low <= fun(x) < high`
+    >>> frame = ...
+    >>> fun   = Ostap.Functions.FuncTH2 ( histo , '' , '' )
+    >>> f2    = frame_filter ( frame , fun , 'x' , 'y' , low = 0.5 )
+    - see Ostap::Frames::filter 
+    """
+    low  = kwargs.pop ( 'low'  , 0.5 ) 
+    high = kwargs.pop ( 'high' , sys.float_info.max )
+    name = kwargs.pop ( 'name' , '' )
+    assert not kwargs , 'frame_filter: unknown arguments %s' % kwargs 
+    F    = Ostap.Functions 
+    assert isinstance ( fun , ( F.Func1D , F.Func2D , F.Func3D ) ) , \
+           'frame_filter: invalid function type %s' % type ( fun ) 
+    return Ostap.Frames.filter ( _as_node_ ( frame ) , fun , *( columns + ( low , high , name ) ) )
+
+# =============================================================================
+## Add TMVA responses as new columns <code>prefix+method+suffix</code>
+#  - each processing slot gets its own <code>TMVA::Reader</code>
+#  @code
+#  frame = ...
+#  f2    = frame_tmva ( frame , { 'var1' : 'pt' , 'var2' : 'eta' } , { 'MLP' : 'weights/MLP.xml' } , prefix = 'tmva_' )
+#  @endcode 
+#  @see Ostap::Frames::add_response
+def frame_tmva ( frame , inputs , weights_files , options = '' , prefix = '' , suffix = '' , aux = 0.9 ) :
+    """Add TMVA responses as new columns `prefix+method+suffix`
+    - each processing slot gets its own `TMVA::Reader`
+    >>> frame = ...
+    >>> f2    = frame_tmva ( frame , { 'var1' : 'pt' , 'var2' : 'eta' } , { 'MLP' : 'weights/MLP.xml' } , prefix = 'tmva_' )
+    - see Ostap::Frames::add_response
+    """
+    MAP = ROOT.std.map ( 'std::string' , 'std::string' )
+    _inputs  = MAP ()
+    for k , v in inputs        .items () : _inputs  [ k ] = v
+    _weights = MAP ()
+    for k , v in weights_files .items () : _weights [ k ] = v
+    return Ostap.Frames.add_response ( _as_node_ ( frame ) , _inputs , _weights ,
+                                       options , prefix , suffix , aux )
+
+# =============================================================================
+## get the cached compiled function for the expression (if possible)
+#  - the columns, used in the expression, are identified by names 
+#  - the function is compiled once and cached on disk, 
+#    the key includes the expression and the types of columns 
+#  @return the call string for the expression or <code>None</code>
+#  @see ostap.core.jit_cache.jit_function 
+def _fr_cached_call_ ( frame , expression , rtype ) :
+    """Get the cached compiled function for the expression (if possible)
+    - see ostap.core.jit_cache.jit_function 
+    """
+    import re
+    columns = set ( frame.GetColumnNames () )
+    used    = [] 
+    for token in re.findall ( r'[A-Za-z_][A-Za-z0-9_]*' , expression ) :
+        if token in columns and not token in used : used.append ( token )
+    if not used : return None 
+    
+    from ostap.core.jit_cache import jit_function
+    args  = [ ( frame.GetColumnType ( c ) , c ) for c in used ] 
+    fname = jit_function ( expression , args , rtype )
+    if not fname : return None 
+    return '%s(%s)' % ( fname , ','.join ( used ) ) 
+
+# =============================================================================
+## Filter the frame using the expression, compiled and cached on disk
+#  - the expression is compiled once into the shared library, 
+#    the subsequent jobs load it directly from the cache
+#  - the standard <code>Filter</code> is used if the expression can't be compiled 
+#  @code
+#  frame = ...
+#  f2    = frame_filter_cached ( frame , 'pt>2 && abs(eta)<2' )
+#  @endcode
+#  @see ostap.core.jit_cache
+def frame_filter_cached ( frame , cuts , name = '' ) :
+    """Filter the frame using the expression, compiled and cached on disk
+    - the expression is compiled once into the shared library, 
+    the subsequent jobs load it directly from the cache
+    - the standard `Filter` is used if the expression can't be compiled 
+    >>> frame = ...
+    >>> f2    = frame_filter_cached ( frame , 'pt>2 && abs(eta)<2' )
+    - see ostap.core.jit_cache
+    """
+    cuts = str ( cuts ).strip () 
+    call = _fr_cached_call_ ( frame , cuts , 'bool' )
+    if not name : name = cuts 
+    return frame.Filter ( call if call else cuts , name )
+
+# =============================================================================
+## Define new column using the expression, compiled and cached on disk
+#  - the expression is compiled once into the shared library, 
+#    the subsequent jobs load it directly from the cache
+#  - the standard <code>Define</code> is used if the expression can't be compiled 
+#  @code
+#  frame = ...
+#  f2    = frame_define_cached ( frame , 'pt2' , 'pt*pt' )
+#  @endcode
+#  @see ostap.core.jit_cache
+def frame_define_cached ( frame , name , expression , rtype = 'double' ) :
+    """Define new column using the expression, compiled and cached on disk
+    - the expression is compiled once into the shared library, 
+    the subsequent jobs load it directly from the cache
+    - the standard `Define` is used if the expression can't be compiled 
+    >>> frame = ...
+    >>> f2    = frame_define_cached ( frame , 'pt2' , 'pt*pt' )
+    - see ostap.core.jit_cache
+    """
+    expression = str ( expression ).strip () 
+    call = _fr_cached_call_ ( frame , expression , rtype )
+    return frame.Define ( name , call if call else expression )
+
 # =============================================================================
 if ( 6 , 25 ) <= root_info :
+    DataFrame.define_func    = frame_define
+    DataFrame.filter_cached  = frame_filter_cached 
+    DataFrame.define_cached  = frame_define_cached
+    DataFrame.filter_func    = frame_filter
+    DataFrame.add_tmva       = frame_tmva
+    _new_methods_      = _new_methods_ + ( DataFrame.define_func    ,
+                                           DataFrame.filter_func    ,
+                                           DataFrame.add_tmva       ,
+                                           DataFrame.filter_cached  ,
+                                           DataFrame.define_cached  ) 
     frame_statVar       = _fr_statVar_new_
     frame_statVars      = _fr_statVar_new_
     DataFrame.statVars  = _fr_statVar_new_
-    __all__ = __all__ + ( 'frame_statVar' , 'frame_statVars' ) 
-    _new_methods_      = _new_methods_ + ( DataFrame.statVars , ) 
+    DataFrame.statMoment     = frame_moment
+    DataFrame.p2quantile     = frame_p2quantile
+    DataFrame.digest         = frame_digest
+    DataFrame.statCovariance  = frame_covariance
+    DataFrame.statCovariances = frame_covariances
+    __all__ = __all__ + ( 'frame_statVar'    , 'frame_statVars'   ,
+                          'frame_moment'     , 'frame_p2quantile' ,
+                          'frame_digest'     , 'frame_covariance' ,
+                          'frame_covariances' ) 
+    _new_methods_      = _new_methods_ + ( DataFrame.statVars       ,
+                                           DataFrame.statMoment     ,
+                                           DataFrame.p2quantile     ,
+                                           DataFrame.digest         ,
+                                           DataFrame.statCovariance ,
+                                           DataFrame.statCovariances ) 
     
 # =============================================================================
 if '__main__' == __name__ :
@@ -98,12 +98,137 @@ def test_frame2 ( ) :
     h2 = frame.draw('b1','1/b1')
     
         
+def test_frame3 ( ) :
+    
+    from ostap.core.meta_info import root_info
+    if root_info < ( 6 , 25 ) :
+        logger.warning ( 'test_frame3: skip the test for old ROOT' )
+        return 
+    
+    from ostap.frames.frames import frame_moment, frame_p2quantile, frame_covariance, frame_covariances
+    
+    ## the reference covariance matrix from the explicit loop (b1=i, b2=(1+i)^2, b3=b1*b1)
+    rows = [ ( float ( i ) , ( 1.0 + i ) ** 2 , float ( i * i ) ) for i in range ( len ( tree ) ) ]
+    N    = len ( rows )
+    mean = [ sum ( r [ k ] for r in rows ) / N for k in range ( 3 ) ]
+    ref  = [ [ sum ( ( r [ i ] - mean [ i ] ) * ( r [ j ] - mean [ j ] ) for r in rows ) / N
+               for j in range ( 3 ) ] for i in range ( 3 ) ]
+    close = lambda a , b : abs ( a - b ) <= 1.e-9 * max ( 1.0 , abs ( a ) , abs ( b ) )
+    
+    for mt in  ( False , True ) :
+        with implicitMT ( mt ) :
+            
+            ## all actions are booked lazily and evaluated in the single pass 
+            m4   = frame_moment      ( frame , 'b1' , 4 , lazy = True ) 
+            q5   = frame_p2quantile  ( frame , 'b1' , 0.5 , lazy = True ) 
+            cov  = frame_covariance  ( frame , 'b1' , 'b2' , lazy = True ) 
+            covs = frame_covariances ( frame , ( 'b1' , 'b2' , 'b1*b1' ) , lazy = True ) 
+            
+            logger.info ( "moment  (4,'b1')     : %s vs %s" % ( m4 .GetValue().moment ( 2 ) , tree.central_moment ( 2 , 'b1' ) ) ) 
+            logger.info ( "quantile(0.5,'b1')   : %s vs %s" % ( q5 .GetValue()              , tree.median ( 'b1' )             ) ) 
+            logger.info ( "covariance(b1,b2)    : %s vs %s" % ( cov.GetValue().covariance () , ref [ 0 ][ 1 ]                  ) ) 
+            
+            assert m4.GetValue().size() == len ( tree ) , 'Invalid number of entries!'
+
+            c = cov.GetValue ()
+            assert c.n () == N , 'Invalid number of entries for covariance!'
+            assert close ( c.covariance () , ref [ 0 ][ 1 ] ) , \
+                   'Invalid covariance(b1,b2): %s vs %s' % ( c.covariance () , ref [ 0 ][ 1 ] )
+            rho = ref [ 0 ][ 1 ] / ( ref [ 0 ][ 0 ] * ref [ 1 ][ 1 ] ) ** 0.5 
+            assert close ( c.correlation () , rho ) , \
+                   'Invalid correlation(b1,b2): %s vs %s' % ( c.correlation () , rho )
+
+            cs = covs.GetValue ()
+            assert cs.n () == N , 'Invalid number of entries for covariances!'
+            for i in range ( 3 ) :
+                for j in range ( 3 ) :
+                    assert close ( cs.covariance ( i , j ) , ref [ i ][ j ] ) , \
+                           'Invalid covariance(%d,%d): %s vs %s' % ( i , j , cs.covariance ( i , j ) , ref [ i ][ j ] )
+
+def test_frame4 ( ) :
+
+    from ostap.frames.tree_reduce import ReducePipeline
+    
+    for mt in  ( False , True ) :
+        
+        ## several reductions in the single pass 
+        pipe = ReducePipeline ( tree , selection = 'b1>=100' , new_vars = { 'b3' : 'b1+b2' } , mt = mt , silent = True )
+        pipe.stage ( 'low'   , selection = 'b1<500'  , save_vars = ( 'b1' , ) )
+        pipe.stage ( 'high'  , selection = 'b1>=500' , new_vars  = { 'b4' : 'b1*2' } )
+        pipe.stage ( 'high2' , selection = 'b1>=800' , parent = 'high' , no_vars = ( 'one' , ) )
+        
+        results = pipe.run ()
+        logger.info ( 'Pipeline (MT=%s):\n%s' % ( mt , pipe ) )
+        
+        assert len ( results [ 'low'   ] ) == 400 , 'Invalid stage "low"'
+        assert len ( results [ 'high'  ] ) == 500 , 'Invalid stage "high"'
+        assert len ( results [ 'high2' ] ) == 200 , 'Invalid stage "high2"'
+        assert     'b4'  in results [ 'high2' ].chain.branches () , 'Variable from parent stage is not saved!' 
+        assert not 'one' in results [ 'high2' ].chain.branches () , 'Excluded variable is saved!'
+        assert not 'b2'  in results [ 'low'   ].chain.branches () , 'Variable is not excluded!'
+            
+def test_frame5 ( ) :
+
+    from ostap.core.meta_info import root_info
+    if root_info < ( 6 , 25 ) :
+        logger.warning ( 'test_frame5: skip the test for old ROOT' )
+        return 
+    
+    from ostap.core.core     import Ostap, hID 
+    from ostap.frames.frames import frame_define, frame_filter 
+
+    histo = ROOT.TH1D ( hID() , '' , 10 , 0 , 1000 )
+    for i in range ( 1 , 11 ) : histo.SetBinContent ( i , i ) 
+    fun   = Ostap.Functions.FuncTH1 ( histo , '' , ROOT.nullptr , Ostap.Math.HistoInterpolation.Nearest )
+
+    for mt in  ( False , True ) :
+        with implicitMT ( mt ) :
+
+            ## typed callables, no JIT for the function 
+            f1 = frame_define ( frame , 'h' , fun , 'b1' )
+            f2 = frame_filter ( frame , fun , 'b1' , low = 5.5 )
+            s1 = f1.Sum   ( 'h' )
+            c2 = f2.Count ()
+            
+            ## reference 
+            h  = sum ( histo.GetBinContent ( histo.FindBin ( float ( i ) ) ) for i in range ( 1000 ) )
+            logger.info ( 'Sum/count (MT=%s): %s/%s' % ( mt , s1.GetValue () , c2.GetValue () ) ) 
+            assert abs ( s1.GetValue () - h ) < 1.e-6 , 'Invalid sum of the defined column!'
+            assert c2.GetValue () == 500              , 'Invalid number of filtered entries!'
+        
+def test_frame6 ( ) :
+
+    from ostap.core.meta_info import root_info
+    if root_info < ( 6 , 25 ) :
+        logger.warning ( 'test_frame6: skip the test for old ROOT' )
+        return 
+    
+    from ostap.frames.frames import frame_define_cached, frame_filter_cached
+
+    ## expressions, compiled and cached on disk 
+    f1 = frame_define_cached ( frame , 'b3' , 'b1*b1+one' )
+    f2 = frame_filter_cached ( f1    , 'b3>100 && b2<250000' )
+    
+    ## reference
+    f3 = frame.Define ( 'b3' , 'b1*b1+one' ).Filter ( 'b3>100 && b2<250000' )
+    
+    c2 , c3 = f2.Count () , f3.Count ()
+    s2 , s3 = f2.Sum ( 'b3' ) , f3.Sum ( 'b3' ) 
+    logger.info ( 'Cached/JIT count: %s/%s sum: %s/%s' % ( c2.GetValue () , c3.GetValue () ,
+                                                         s2.GetValue () , s3.GetValue () ) )
+    assert c2.GetValue () == c3.GetValue ()            , 'Invalid number of filtered entries!'
+    assert abs ( s2.GetValue () - s3.GetValue () ) < 1.e-6 , 'Invalid sum of the defined column!'
+        
 # =============================================================================
 if '__main__' == __name__ :
     
     ## test_frame0 () 
     ## test_frame1 ()
     ## test_frame2 ()
+    ## test_frame3 ()
+    ## test_frame4 ()
+    ## test_frame5 ()
+    ## test_frame6 ()
     
     pass
 
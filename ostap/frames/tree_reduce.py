@@ -17,8 +17,10 @@ __version__ = "$Revision$"
 __author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
 __date__    = "2011-06-07"
 __all__     = (
-    'ReduceTree' ,
-    'reduce'     ,    
+    'ReduceTree'       ,
+    'ReducePipeline'   ,
+    'reduce'           ,    
+    'snapshot_options' ,    
     ) 
 # =============================================================================
 import ROOT, os 
@@ -34,6 +36,149 @@ logger.debug ( "``Reduce'' TTree using ROOT::RDataFrame object")
 import ostap.trees.trees
 from   ostap.core.core     import cpp, Ostap 
 from   ostap.utils.cleanup import CleanUp 
+from   ostap.core.ostap_types import  ( string_types   ,
+                                        integer_types  ,
+                                        listlike_types ,
+                                        dictlike_types )
+# =============================================================================
+## predefined compression settings for the output files
+#  (algorithm*100+level, see ROOT::RCompressionSetting)
+#  - 'fast'  : LZ4, fast decompression, e.g. for the repeated reading in fits 
+#  - 'small' : LZMA, the smallest files, e.g. for the storage 
+compressions = {
+    'fast'  : 404 ,
+    'small' : 207 ,
+    }
+# =============================================================================
+## create the options for <code>RDataFrame::Snapshot</code>
+#  @code
+#  opts = snapshot_options ( compression = 'fast' , autoflush = 10000 , lazy = True ) 
+#  @endcode
+#  @param compression compression settings: algorithm*100+level or the
+#                     predefined settings ('fast','small'), None: ROOT default 
+#  @param autoflush   the number of entries per cluster (negative: bytes), None: ROOT default 
+#  @param lazy        book the lazy snapshot?
+#  @return the options (or None, if not available)
+#  @see ROOT::RDF::RSnapshotOptions
+def snapshot_options ( compression = None , autoflush = None , lazy = False ) :
+    """Create the options for `RDataFrame::Snapshot`
+    >>> opts = snapshot_options ( compression = 'fast' , autoflush = 10000 , lazy = True ) 
+    - compression : compression settings: algorithm*100+level or the
+                    predefined settings ('fast','small'), None: ROOT default 
+    - autoflush   : the number of entries per cluster (negative: bytes), None: ROOT default 
+    - lazy        : book the lazy snapshot?
+    - see ROOT.ROOT.RDF.RSnapshotOptions
+    """
+    if compression is None and autoflush is None and not lazy : return None
+    
+    try :
+        opts = ROOT.ROOT.RDF.RSnapshotOptions ()
+    except AttributeError :
+        logger.warning ( 'snapshot_options: RSnapshotOptions are not available' )
+        return None
+    
+    if isinstance ( compression , string_types ) :
+        assert compression in compressions , 'Invalid compression %s' % compression 
+        compression = compressions [ compression ]
+    if compression is not None :
+        assert isinstance ( compression , integer_types ) and 0 <= compression , \
+               'Invalid compression %s' % compression 
+        algo , level = divmod ( compression , 100 )
+        opts.fCompressionAlgorithm = algo
+        opts.fCompressionLevel     = level
+        
+    if autoflush is not None :
+        assert isinstance ( autoflush , integer_types ) , 'Invalid autoflush %s' % autoflush 
+        opts.fAutoFlush = autoflush
+        
+    opts.fLazy = bool ( lazy ) 
+    return opts
+
+# =============================================================================
+## add the filters to the frame
+#  @return the frame and the list of selections 
+def _filters_ ( frame , selection , prefix = 'SELECTION' ) :
+    """Add the filters to the frame
+    - return the frame and the list of selections 
+    """
+    
+    cut_types = string_types + ( ROOT.TCut , )
+    
+    Lmax = 30 
+
+    selections = [] 
+    if    selection and isinstance ( selection , cut_types ) :
+        ss = str ( selection ).strip() 
+        if len ( ss )  < Lmax : filter_name = ss          
+        else                  : filter_name = prefix 
+        frame = frame.Filter ( ss  , filter_name )
+        selections.append ( ss ) 
+    elif selection and isinstance ( selection , dictlike_types  ) :
+        for filter_name in selection :
+            s = selection [ filter_name ]
+            assert isinstance ( s , cut_types ),\
+                   'Invalid selection type %s/%s' % ( s , type ( s ) )
+            ss = str ( s ).strip()
+            frame = frame.Filter ( ss , str ( filter_name ) ) 
+            selections.append ( ss ) 
+    elif selection and isinstance ( selection , listlike_types ) :
+        for i , s in enumerate  ( selection ) :
+            assert isinstance ( s , cut_types ),\
+                   'Invalid selection type %s/%s' % ( s , type ( s ) )
+            ss = str( s ).strip()
+            ##
+            if len ( ss ) < Lmax          : filter_name = ss
+            else                          : filter_name = '%s%d' % ( prefix , i ) 
+            #
+            frame = frame.Filter ( ss , filter_name )
+            selections.append ( ss ) 
+    elif selection :
+        raise TypeError('Invalid  selection type %s/%s' %  ( selection , type ( selection ) ) )
+
+    return frame , selections
+
+# =============================================================================
+## get the list of variables to be saved
+#  @return the list of variable or empty tuple (all variables) 
+def _save_vars_ ( chain , save_vars , no_vars , nvars , selections = () , addselvars = False ) :
+    """Get the list of variables to be saved
+    - return the list of variable or empty tuple (all variables) 
+    """
+    if selections and addselvars :
+        bvars     = chain.the_variables ( selections )
+        save_vars = list  ( bvars ) + [ v for v in save_vars if not v in bvars ]
+        save_vars = tuple ( save_vars ) 
+
+    ## exclude some variables 
+    if no_vars and not save_vars :
+        bvars     = list ( chain.branches () )
+        all_vars  = list ( bvars ) + [ v for v in nvars if not v in bvars ]
+        save_vars = tuple ( [ v for v in all_vars if not v in no_vars ] )
+    elif no_vars :
+        bvars    = chain.the_variables ( *save_vars )
+        all_vars  = list ( bvars ) + [ v for v in nvars if not v in bvars ]
+        save_vars = tuple ( [ v for v in all_vars if not v in no_vars ] ) 
+
+    if not save_vars : return ()
+    
+    bvars    = chain.the_variables ( *save_vars )
+    all_vars = list ( bvars ) + [ v for v in nvars if not v in bvars ]
+    return tuple ( all_vars ) 
+
+# =============================================================================
+## get the size of file as string 
+def _file_size_ ( fname ) :
+    """Get the size of file as string"""
+    fs = os.path.getsize ( fname )        
+    gb , r = divmod ( fs ,  1024 * 1024 * 1024 )
+    mb , r = divmod ( r  ,  1024 * 1024 )
+    kb , r = divmod ( r  ,  1024 )
+    
+    if   gb : return '%.1fGB' % ( float ( fs ) / 1024 / 1024 / 1024 )
+    elif mb : return '%.1fMB' % ( float ( fs ) / 1024 / 1024 )
+    elif kb : return '%.1fkB' % ( float ( fs ) / 1024 ) 
+    return '%sB'    %           fs
+
 # =============================================================================
 ## @class ReduceTree
 #  Reduce TTree object using intermediate (temporary
@@ -59,7 +204,9 @@ class ReduceTree(CleanUp):
                    name       = ''    ,   ## the name 
                    addselvars = False ,   ## add varibles from selections?
                    tmp_keep   = False ,   ## keep the temporary file 
-                   silent     = False ):  ## silent processing 
+                   silent     = False ,   ## silent processing 
+                   compression = None  ,  ## compression settings for the output file
+                   autoflush   = None  ): ## number of entries per cluster in the output
         
         from   ostap.frames.frames import DataFrame
         frame  = DataFrame ( chain )
@@ -74,42 +221,7 @@ class ReduceTree(CleanUp):
             frame = frame.Define ( nv , new_vars [ nv] )
             nvars.append ( nv )
 
-        from ostap.core.ostap_types import  ( string_types   ,
-                                              listlike_types ,
-                                              dictlike_types )
-        
-        cut_types = string_types + ( ROOT.TCut , )
-        
-        Lmax = 30 
-
-        selections = [] 
-        if    selection and isinstance ( selection , cut_types ) :
-            ss = str ( selection ).strip() 
-            if len ( ss )  < Lmax : filter_name = ss          
-            else                  : filter_name = 'SELECTION'
-            frame = frame.Filter ( ss  , filter_name )
-            selections.append ( ss ) 
-        elif selection and isinstance ( selection , dictlike_types  ) :
-            for filter_name in selection :
-                s = selection [ filter_name ]
-                assert isinstance ( s , cut_types ),\
-                       'Invalid selection type %s/%s' % ( s , type ( s ) )
-                ss = str ( s ).strip()
-                frame = frame.Filter ( ss , str ( filter_name ) ) 
-                selections.append ( ss ) 
-        elif selection and isinstance ( selection , listlike_types ) :
-            for i , s in enumerate  ( selection ) :
-                assert isinstance ( s , cut_types ),\
-                       'Invalid selection type %s/%s' % ( s , type ( s ) )
-                ss = str( s ).strip()
-                ##
-                if len ( ss ) < Lmax          : filter_name = ss
-                else                          : filter_name = 'SELECTION%d' % i
-                #
-                frame = frame.Filter ( ss , filter_name )
-                selections.append ( ss ) 
-        elif selection :
-             raise TypeError('Invalid  selection type %s/%s' %  ( selection , type ( selection ) ) )
+        frame , selections = _filters_ ( frame , selection ) 
 
         if not output : 
             output = self.tempfile ( prefix = 'ostap-frame-' , suffix = '.root' )
@@ -118,20 +230,7 @@ class ReduceTree(CleanUp):
 
         if  selections : report = frame.Report()
             
-        if selections and addselvars :
-            bvars     = chain.the_variables ( selections )
-            save_vars = list  ( bvars ) + [ v for v in save_vars if not v in bvars ]
-            save_vars = tuple ( save_vars ) 
-
-        ## exclude some variables 
-        if no_vars and not save_vars :
-            bvars     = list ( chain.branches () )
-            all_vars  = list ( bvars ) + [ v for v in nvars if not v in bvars ]
-            save_vars = tuple ( [ v for v in all_vars if not v in no_vars ] )
-        elif no_vars :
-            bvars    = chain.the_variables ( *save_vars )
-            all_vars  = list ( bvars ) + [ v for v in nvars if not v in bvars ]
-            save_vars = tuple ( [ v for v in all_vars if not v in no_vars ] ) 
+        save_vars = _save_vars_ ( chain , save_vars , no_vars , nvars , selections , addselvars )
             
         nb_ = len ( chain.branches () )
         ne_ = len ( chain             )
@@ -144,14 +243,16 @@ class ReduceTree(CleanUp):
             name = '%s_reduced' % cname 
         self.__name = name
         
-        if not save_vars : 
+        opts = snapshot_options ( compression = compression , autoflush = autoflush )
+        if not save_vars and not opts : 
             snapshot = frame.Snapshot ( name , output )
+        elif not save_vars :
+            snapshot = frame.Snapshot ( name , output , '' , opts )
         else :
-            bvars    = chain.the_variables ( *save_vars )
-            all_vars = list ( bvars ) + [ v for v in nvars if not v in bvars ]
             from ostap.core.core import strings as _strings
-            all_vars = _strings ( all_vars  ) 
-            snapshot = frame.Snapshot ( name , output , all_vars )
+            all_vars = _strings ( save_vars ) 
+            if opts : snapshot = frame.Snapshot ( name , output , all_vars , opts )
+            else    : snapshot = frame.Snapshot ( name , output , all_vars )
 
         assert os.path.exists ( output ) and\
                os.path.isfile ( output ) , 'Invalid file %s' % fname
@@ -168,15 +269,7 @@ class ReduceTree(CleanUp):
             self.__report += '\n%s' % report_print ( report , title , '# ')
             self.__table   = report_as_table ( report )
                 
-        fs = os.path.getsize ( self.__output )        
-        gb , r = divmod ( fs ,  1024 * 1024 * 1024 )
-        mb , r = divmod ( r  ,  1024 * 1024 )
-        kb , r = divmod ( r  ,  1024 )
-        
-        if   gb : fs = '%.1fGB' % ( float ( fs ) / 1024 / 1024 / 1024 )
-        elif mb : fs = '%.1fMB' % ( float ( fs ) / 1024 / 1024 )
-        elif kb : fs = '%.1fkB' % ( float ( fs ) / 1024 ) 
-        else    : fs = '%sB'    %           fs
+        fs = _file_size_ ( self.__output )
         
         nb = len ( self.__chain.branches () )
         ne = len ( self.__chain             )
@@ -218,6 +311,229 @@ class ReduceTree(CleanUp):
         """``report'' : get the statitics report"""
         return self.__report
     
+# =============================================================================
+## @class ReducePipeline
+#  Several reduce stages (filter -> define -> snapshot) fused into one
+#  <code>RDataFrame</code> graph, processed in one (multithreaded) event loop:
+#  the input data are read only once 
+#  @code
+#  tree = ...
+#  pipe = ReducePipeline ( tree , selection = 'pt>1' , new_vars = { 'pt2' : 'pt*pt' } )
+#  pipe.stage ( 'high' , selection = 'pt>5'  , output = 'high.root' )
+#  pipe.stage ( 'low'  , selection = 'pt<=5' , save_vars = ( 'pt' , 'eta' ) )
+#  pipe.stage ( 'tight', selection = 'chi2<2', parent = 'high' )  ## chained stage 
+#  results = pipe.run ()
+#  high    = results [ 'high' ] ## Chain 
+#  @endcode
+#  - stages can be chained: the stage uses filters&variables of the parent stage
+#  - stages with <code>snapshot=False</code> are only nodes for the chained stages 
+#  - the output compression is tuned for the repeated reading (LZ4) by default 
+#  @see ROOT::RDataFrame
+#  @see ROOT::RDF::RSnapshotOptions
+class ReducePipeline(CleanUp) :
+    """Several reduce stages (filter -> define -> snapshot) fused into one
+    `RDataFrame` graph, processed in one (multithreaded) event loop:
+    the input data are read only once 
+    >>> tree = ...
+    >>> pipe = ReducePipeline ( tree , selection = 'pt>1' , new_vars = { 'pt2' : 'pt*pt' } )
+    >>> pipe.stage ( 'high' , selection = 'pt>5'  , output = 'high.root' )
+    >>> pipe.stage ( 'low'  , selection = 'pt<=5' , save_vars = ( 'pt' , 'eta' ) )
+    >>> pipe.stage ( 'tight', selection = 'chi2<2', parent = 'high' )  ## chained stage 
+    >>> results = pipe.run ()
+    >>> high    = results [ 'high' ] ## Chain 
+    - stages can be chained: the stage uses filters&variables of the parent stage
+    - stages with `snapshot=False` are only nodes for the chained stages 
+    - the output compression is tuned for the repeated reading (LZ4) by default 
+    """
+    def __init__ ( self                 ,
+                   chain                ,   ## input TChain/TTree 
+                   selection   = {}     ,   ## common selection/cuts  
+                   new_vars    = {}     ,   ## common new variables
+                   mt          = True   ,   ## use implicit MT ?
+                   compression = 'fast' ,   ## compression settings for the output files
+                   autoflush   = None   ,   ## number of entries per cluster in the output files
+                   silent      = False  ) : ## silent processing 
+
+        self.__chain       = chain
+        self.__selection   = selection
+        self.__new_vars    = new_vars
+        self.__mt          = mt
+        self.__compression = compression
+        self.__autoflush   = autoflush 
+        self.__silent      = silent 
+        self.__stages      = []
+        self.__results     = {}
+        self.__report      = ''
+        
+    # =========================================================================
+    ## add the reduce stage
+    #  @code
+    #  pipe = ...
+    #  pipe.stage ( 'high' , selection = 'pt>5'  , output = 'high.root' )
+    #  @endcode 
+    #  @param name       the stage name (and the name of the output tree)
+    #  @param selection  selection/cuts for the stage 
+    #  @param save_vars  list of variables to save
+    #  @param new_vars   new variables
+    #  @param no_vars    exclude these variables
+    #  @param output     output file name (temporary file, if not specified) 
+    #  @param parent     the parent stage 
+    #  @param snapshot   save the stage? 
+    #  @param addselvars add variables from selections?
+    def stage ( self                ,
+                name                ,   ## the stage name 
+                selection   = {}    ,   ## selection/cuts  
+                save_vars   = ()    ,   ## list of variables to save 
+                new_vars    = {}    ,   ## new variables
+                no_vars     = ()    ,   ## exclude these variables
+                output      = ''    ,   ## output file name
+                parent      = None  ,   ## the parent stage 
+                snapshot    = True  ,   ## save the stage ?
+                addselvars  = False ) : ## add varibles from selections?
+        """Add the reduce stage
+        >>> pipe = ...
+        >>> pipe.stage ( 'high' , selection = 'pt>5'  , output = 'high.root' )
+        - name       : the stage name (and the name of the output tree)
+        - selection  : selection/cuts for the stage 
+        - save_vars  : list of variables to save
+        - new_vars   : new variables
+        - no_vars    : exclude these variables
+        - output     : output file name (temporary file, if not specified) 
+        - parent     : the parent stage 
+        - snapshot   : save the stage? 
+        - addselvars : add variables from selections?
+        """
+        names = [ st [ 'name' ] for st in self.__stages ]
+        assert not name in names , "ReducePipeline: the stage '%s' already exists!" % name
+        assert parent is None or parent in names , "ReducePipeline: unknown parent stage '%s'" % parent
+
+        temporary = snapshot and not output 
+        if temporary : 
+            output = self.tempfile ( prefix = 'ostap-frame-%s-' % name , suffix = '.root' )
+        if snapshot :
+            outputs = [ st [ 'output' ] for st in self.__stages if st [ 'snapshot' ] ]
+            assert not output in outputs , "ReducePipeline: the output '%s' is already used!" % output
+            
+        self.__stages.append ( { 'name'       : name       ,
+                                 'selection'  : selection  ,
+                                 'save_vars'  : save_vars  ,
+                                 'new_vars'   : new_vars   ,
+                                 'no_vars'    : no_vars    ,
+                                 'output'     : output     ,
+                                 'parent'     : parent     ,
+                                 'snapshot'   : snapshot   ,
+                                 'temporary'  : temporary  , 
+                                 'addselvars' : addselvars } )
+        return name 
+
+    # =========================================================================
+    ## build the graph and run the event loop
+    #  @code
+    #  pipe    = ...
+    #  results = pipe.run ()
+    #  @endcode
+    #  @return dictionary { stage_name : Chain } for the saved stages 
+    def run ( self ) :
+        """Build the graph and run the event loop
+        >>> pipe    = ...
+        >>> results = pipe.run ()
+        - return dictionary { stage_name : Chain } for the saved stages 
+        """
+        if self.__results : return self.__results 
+        
+        from ostap.frames.frames import DataFrame, report_print
+        from ostap.utils.utils   import implicitMT
+        from ostap.core.core     import strings as _strings
+        from ostap.trees.trees   import Chain
+        
+        chain = self.__chain 
+        nb_   = len ( chain.branches () )
+        ne_   = len ( chain             )
+
+        opts  = snapshot_options ( compression = self.__compression ,
+                                   autoflush   = self.__autoflush   , lazy = True )
+        assert opts , 'ReducePipeline: lazy snapshots are not available!' 
+        
+        with implicitMT ( self.__mt ) :
+
+            ## the graph is built with the proper MT-mode 
+            frame = DataFrame ( chain , enable = self.__mt )
+            if not self.__silent : pbar = frame.ProgressBar ( ne_ )
+
+            ## common part 
+            nvars = [] 
+            for nv in self.__new_vars :
+                frame = frame.Define ( nv , self.__new_vars [ nv ] )
+                nvars.append ( nv )
+            frame , selections = _filters_ ( frame , self.__selection )
+            
+            nodes     = { None : ( frame , nvars , selections ) }
+            snapshots = []
+            reports   = []
+            
+            for st in self.__stages :
+                
+                node , nvars , selections = nodes [ st [ 'parent' ] ]
+                nvars      = list ( nvars      )
+                new_vars   = st [ 'new_vars' ] 
+                for nv in new_vars :
+                    node = node.Define ( nv , new_vars [ nv ] )
+                    nvars.append ( nv )
+                    
+                node , sels = _filters_ ( node , st [ 'selection' ] , prefix = '%s_SELECTION' % st [ 'name' ] )
+                selections  = list ( selections ) + sels 
+                nodes [ st [ 'name' ] ] = node , nvars , selections 
+                
+                if not st [ 'snapshot' ] : continue
+
+                if sels : reports.append ( ( st [ 'name' ] , node.Report () ) )
+                
+                save_vars = _save_vars_ ( chain            , st [ 'save_vars'  ] ,
+                                          st [ 'no_vars' ] , nvars , selections  ,
+                                          st [ 'addselvars' ] )
+                if save_vars : snap = node.Snapshot ( st [ 'name' ] , st [ 'output' ] , _strings ( save_vars ) , opts )
+                else         : snap = node.Snapshot ( st [ 'name' ] , st [ 'output' ] , ''                     , opts )
+                snapshots.append ( ( st , snap ) )
+
+            ## run the event loop (all snapshots share the same graph) 
+            for st , snap in snapshots : snap.GetValue ()
+
+        self.__report = 'Tree -> Frame -> Trees pipeline %d stages' % len ( self.__stages )
+        for name , report in reports :
+            self.__report += '\n%s' % report_print ( report , 'Stage %s' % name , '# ' ) 
+            
+        for st , snap in snapshots :
+            output = st [ 'output' ] 
+            assert os.path.exists ( output ) and os.path.isfile ( output ) , 'Invalid file %s' % output
+            result = Chain ( name = st [ 'name' ] , files = [ output ] )
+            if st [ 'temporary' ] : result.trash.add ( output ) 
+            self.__results [ st [ 'name' ] ] = result
+            
+            nb = len ( result.chain.branches () )
+            ne = len ( result                   )
+            self.__report += '\n# Stage %s: %d -> %d branches, %d -> %d entries' % ( st [ 'name' ] , nb_ , nb , ne_ , ne ) 
+            self.__report += '\n# Output:%s size:%s' % ( output , _file_size_ ( output ) )
+
+        return self.__results 
+
+    def __str__  ( self ) : return self.__report 
+    def __repr__ ( self ) : return self.__report 
+
+    @property
+    def stages ( self ) :
+        """``stages'' : the names of the stages"""
+        return tuple ( st [ 'name' ] for st in self.__stages )
+    
+    @property
+    def results ( self ) :
+        """``results'' : dictionary { stage_name : Chain } for the saved stages (after run)"""
+        return self.__results
+    
+    @property
+    def report ( self ) :
+        """``report'' : get the statistics report"""
+        return self.__report
+    
 # ===============================================================================
 ## Powerful method to reduce/tranform the tree/chain.
 #  It relies on Ostap.DataFrame ( alias for ROOT.ROOT.DataFrame) and allows
@@ -242,7 +558,8 @@ def reduce  ( tree               ,
               output     = ''    ,
               name       = ''    , 
               addselvars = False ,
-              silent     = False ) :
+              silent     = False ,
+              **kwargs           ) :
     
     """ Powerful method to reduce/tranform the tree/chain.
     It relies on Ostap.DataFrame ( alias for ROOT.ROOT.DataFrame) and allows
@@ -256,7 +573,7 @@ def reduce  ( tree               ,
     >>> reduced3 = tree.reduce  ( 'pt>1' , no_vars = [ 'Q', 'z' ,'x' ] )
     >>> reduced4 = tree.reduce  ( 'pt>1' , new_vars = { 'pt2' : 'pt*pt' } )
     >>> reduced5 = tree.reduce  ( 'pt>1' , new_vars = { 'pt2' : 'pt*pt' } , output = 'OUTPUT.root' )
-    
+    - other keyword arguments (e.g. `compression`, `autoflush`) are passed to `ReduceTree`
     """
     
     nb0 = len ( tree.branches() )
@@ -271,7 +588,7 @@ def reduce  ( tree               ,
                            name       = name       , 
                            addselvars = addselvars ,
                            tmp_keep   = True       , 
-                           silent     = silent     )
+                           silent     = silent     , **kwargs )
 
     from ostap.trees.trees import Chain
     
@@ -13,7 +13,9 @@
 __version__ = "$Revision$"
 __author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
 __date__    = "2011-06-07"
-__all__     = () 
+__all__     = (
+    'compare_many' , ## compare many pairs of histograms (in parallel) 
+    ) 
 # =============================================================================
 import ROOT, math 
 # =============================================================================
@@ -25,12 +27,29 @@ else                       : logger = getLogger( __name__ )
 # =============================================================================
 logger.debug ( 'Some specific comparison of histo-objects')
 # =============================================================================
-from   ostap.core.core        import hID , VE 
+from   ostap.core.core        import hID , VE , Ostap 
 import ostap.histos.histos 
 import ostap.histos.param
 import ostap.fitting.param 
 from   ostap.logger.colorized import allright  
 # =============================================================================
+## C++ bin-by-bin comparison of histograms with the same binning
+#  @see Ostap::Utils::HistoCompare
+_HC = Ostap.Utils.HistoCompare
+# =============================================================================
+## can the C++ bin-by-bin comparison be used for these objects?
+#  - both are histograms with the same dimension and binning
+#  @see Ostap::Utils::HistoCompare::same_binning 
+def _cpp_cmp_ ( h1 , h2 ) :
+    """Can the C++ bin-by-bin comparison be used for these objects?
+    - both are histograms with the same dimension and binning
+    - see Ostap::Utils::HistoCompare
+    """
+    return isinstance ( h1 , ROOT.TH1 ) and isinstance ( h2 , ROOT.TH1 ) and _HC.same_binning ( h1 , h2 )
+# =============================================================================
+## the default difference for cmp_minmax 
+def _b_minus_a_ ( a , b ) : return b - a 
+# =============================================================================
 ## Can 1D-histogram can be considered as ``constant'' ?
 #  @code
 #  histo = ...
@@ -175,6 +194,11 @@ def _h1_cmp_chi2_ ( h1              ,
         if h2_ is not h2 : del h2_
         return cmp
 
+    if _cpp_cmp_ ( h1 , h2 ) :
+        r = _HC.chi2 ( h1 , h2 ) 
+        chi2 , ndf = r.first , r.second 
+        return chi2 / ndf , ROOT.TMath.Prob ( chi2 , ndf )
+    
     chi2  = 0.0
     ndf   = 0  
     for i , x , v1  in h1.items() :        
@@ -219,6 +243,11 @@ def _h2_cmp_chi2_ ( h1              ,
         if h2_ is not h2 : del h2_
         return cmp
 
+    if _cpp_cmp_ ( h1 , h2 ) :
+        r = _HC.chi2 ( h1 , h2 ) 
+        chi2 , ndf = r.first , r.second 
+        return chi2 / ndf , ROOT.TMath.Prob ( chi2 , ndf )
+    
     chi2  = 0.0
     ndf   = 0 
     for ix , iy , x , y , v1  in h1.items() :        
@@ -262,6 +291,11 @@ def _h3_cmp_chi2_ ( h1              ,
         if h2_ is not h2 : del h2_
         return cmp
 
+    if _cpp_cmp_ ( h1 , h2 ) :
+        r = _HC.chi2 ( h1 , h2 ) 
+        chi2 , ndf = r.first , r.second 
+        return chi2 / ndf , ROOT.TMath.Prob ( chi2 , ndf )
+    
     chi2  = 0.0
     ndf   = 0   
     for ix , iy , iz , x , y , z , v1  in h1.items() :        
@@ -518,6 +552,8 @@ def _h1_cmp_dcostheta_ ( h1              ,
         if h2_ is not h2 : del h2_
         return cmp
 
+    if _cpp_cmp_ ( h1 , h2 ) : return _HC.cos_theta ( h1 , h2 ) 
+
     r1 , r2 , r12 = 0.0 , 0.0 , VE () 
     for i ,  x , v1  in h1.items () :
         xv   = x.value ()
@@ -561,6 +597,8 @@ def _h2_cmp_dcostheta_ ( h1              ,
         if h2_ is not h2 : del h2_
         return cmp
 
+    if _cpp_cmp_ ( h1 , h2 ) : return _HC.cos_theta ( h1 , h2 ) 
+
     r1 , r2 , r12 = 0.0 , 0.0 , VE () 
     for ix , iy , x , y , v1 in h1.items () :
         xv   = x.value ()
@@ -606,6 +644,8 @@ def _h3_cmp_dcostheta_ ( h1              ,
         if h2_ is not h2 : del h2_
         return cmp
 
+    if _cpp_cmp_ ( h1 , h2 ) : return _HC.cos_theta ( h1 , h2 ) 
+
     r1 , r2 , r12 = 0.0 , 0.0 , VE () 
     for ix , iy , iz , x , y , z , v1  in h1.items () :
         xv   = x.value ()
@@ -835,6 +875,8 @@ def _h1_cmp_ddist_ ( h1              ,
         if h2_ is not h2 : del h2_
         return cmp
 
+    if _cpp_cmp_ ( h1 , h2 ) : return _HC.distance ( h1 , h2 ) 
+
     r1 , r2 = 0.0 , 0.0
     for i , x , v1  in h1.items () :
         xv  = x.value ()
@@ -901,6 +943,8 @@ def _h2_cmp_ddist_ ( h1              ,
         if h2_ is not h2 : del h2_
         return cmp
 
+    if _cpp_cmp_ ( h1 , h2 ) : return _HC.distance ( h1 , h2 ) 
+
     r1 , r2 = 0.0 , 0.0
     for ix , iy , x , y , v1  in h1.items () :
         xv  = x.value ()
@@ -971,6 +1015,8 @@ def _h3_cmp_ddist_ ( h1              ,
         if h2_ is not h2 : del h2_
         return cmp
 
+    if _cpp_cmp_ ( h1 , h2 ) : return _HC.distance ( h1 , h2 ) 
+
     r1 , r2 = 0.0 , 0.0
     for ix , iy , iz , x , y , z , v1  in h1.items () :
         xv  = x.value ()
@@ -1026,7 +1072,7 @@ ROOT.TH3D.cmp_ddist = _h3_cmp_ddist_
 def _h1_cmp_minmax_ ( h1                         ,
                       h2                         ,                      
                       density = False            ,
-                      diff    = lambda a,b : b-a , **kwargs ) :
+                      diff    = _b_minus_a_      , **kwargs ) :
     """Compare two histograms and find the largest difference
     >>> h1 = ...
     >>> h2 = ...
@@ -1047,6 +1093,11 @@ def _h1_cmp_minmax_ ( h1                         ,
         if h2_ is not h2 : del h2_
         return cmp
 
+    if diff is _b_minus_a_ and not kwargs and _cpp_cmp_ ( h1 , h2 ) :
+        r  = _HC.minmax ( h1 , h2 )
+        xa = h1.GetXaxis () 
+        return ( xa.GetBinCenter ( r.ixmin ) , r.vmin ) , ( xa.GetBinCenter ( r.ixmax ) , r.vmax )
+
     mn_x   = None
     mx_x   = None 
     mn_val = None
@@ -1092,7 +1143,7 @@ ROOT.TH1F.cmp_minmax = _h1_cmp_minmax_
 def _h2_cmp_minmax_ ( h1                         ,
                       h2                         ,
                       density = False            ,
-                      diff    = lambda a,b : b-a , **kwargs ) :
+                      diff    = _b_minus_a_      , **kwargs ) :
     """Compare two historgams and find the largest difference
     >>> h1 = ...
     >>> h2 = ...
@@ -1113,6 +1164,12 @@ def _h2_cmp_minmax_ ( h1                         ,
         if h2_ is not h2 : del h2_
         return r 
 
+    if diff is _b_minus_a_ and not kwargs and _cpp_cmp_ ( h1 , h2 ) :
+        r  = _HC.minmax ( h1 , h2 )
+        xa , ya = h1.GetXaxis () , h1.GetYaxis () 
+        return ( xa.GetBinCenter ( r.ixmin ) , ya.GetBinCenter ( r.iymin ) , r.vmin ) , \
+               ( xa.GetBinCenter ( r.ixmax ) , ya.GetBinCenter ( r.iymax ) , r.vmax )
+
     mn_x   = None
     mx_x   = None
     mn_y   = None 
@@ -1167,7 +1224,7 @@ ROOT.TH2D.cmp_minmax = _h2_cmp_minmax_
 def _h3_cmp_minmax_ ( h1                         ,
                       h2                         ,
                       density = False            ,
-                      diff    = lambda a,b : b-a , **kwargs ) :
+                      diff    = _b_minus_a_      , **kwargs ) :
     """Compare two historgams and find the largest difference
     >>> h1 = ...
     >>> h2 = ...
@@ -1187,6 +1244,12 @@ def _h3_cmp_minmax_ ( h1                         ,
         if h2_ is not h2 : del h2_
         return r 
 
+    if diff is _b_minus_a_ and not kwargs and _cpp_cmp_ ( h1 , h2 ) :
+        r  = _HC.minmax ( h1 , h2 )
+        xa , ya , za = h1.GetXaxis () , h1.GetYaxis () , h1.GetZaxis ()
+        return ( xa.GetBinCenter ( r.ixmin ) , ya.GetBinCenter ( r.iymin ) , za.GetBinCenter ( r.izmin ) , r.vmin ) , \
+               ( xa.GetBinCenter ( r.ixmax ) , ya.GetBinCenter ( r.iymax ) , za.GetBinCenter ( r.izmax ) , r.vmax )
+
     mn_x   = None
     mx_x   = None
     mn_y   = None 
@@ -1882,6 +1945,52 @@ _new_methods_       = (
     ROOT.TH2D.cmp_diff_prnt , 
     )
 # =============================================================================
+## compare many pairs of histograms with the same binning (in parallel)
+#  @code
+#  pairs  = [ ( h1 , h2 ) , ( h3 , h4 ) , ... ]
+#  chi2s  = compare_many ( pairs , 'chi2' )
+#  probs  = compare_many ( pairs , 'prob'  , nthreads = 4 )
+#  @endcode
+#  Known metrics:
+#  - <code>chi2</code>     : chi2/ndf (as <code>cmp_chi2</code>)
+#  - <code>prob</code>     : chi2-probability (as <code>cmp_chi2</code>)
+#  - <code>cos</code>      : the discrete cos(theta) (as <code>cmp_dcos</code>)
+#  - <code>dist</code>     : the discrete distance (as <code>cmp_ddist</code>)
+#  - <code>min</code>      : the minimal difference  (as <code>cmp_minmax</code>)
+#  - <code>max</code>      : the maximal difference  (as <code>cmp_minmax</code>)
+#  @see Ostap::Utils::HistoCompare::compare
+def compare_many ( pairs , metric = 'chi2' , nthreads = 0 ) :
+    """Compare many pairs of histograms with the same binning (in parallel)
+    >>> pairs  = [ ( h1 , h2 ) , ( h3 , h4 ) , ... ]
+    >>> chi2s  = compare_many ( pairs , 'chi2' )
+    >>> probs  = compare_many ( pairs , 'prob'  , nthreads = 4 )
+    Known metrics:
+    - `chi2` : chi2/ndf (as `cmp_chi2`)
+    - `prob` : chi2-probability (as `cmp_chi2`)
+    - `cos`  : the discrete cos(theta) (as `cmp_dcos`)
+    - `dist` : the discrete distance (as `cmp_ddist`)
+    - `min`  : the minimal difference  (as `cmp_minmax`)
+    - `max`  : the maximal difference  (as `cmp_minmax`)
+    - see Ostap::Utils::HistoCompare
+    """
+    metrics = { 'chi2' : _HC.Chi2     , 'prob' : _HC.Prob     ,
+                'cos'  : _HC.CosTheta , 'dist' : _HC.Distance ,
+                'min'  : _HC.MinDiff  , 'max'  : _HC.MaxDiff  }
+    key = metric.lower ()
+    assert key in metrics , "compare_many: unknown metric ``%s''" % metric
+
+    v1 = ROOT.std.vector('const TH1*')()
+    v2 = ROOT.std.vector('const TH1*')()
+    for h1 , h2 in pairs :
+        assert _cpp_cmp_ ( h1 , h2 ) , \
+               "compare_many: invalid/incompatible histograms %s/%s" % ( type ( h1 ) , type ( h2 ) )
+        v1.push_back ( h1 )
+        v2.push_back ( h2 )
+
+    result = _HC.compare ( metrics [ key ] , v1 , v2 , nthreads )
+    return tuple ( float ( r ) for r in result ) 
+
+# =============================================================================
 if '__main__' == __name__ :
     
     from ostap.utils.docme import docme
@@ -30,7 +30,7 @@ __all__     = (
     )
 # =============================================================================
 import ROOT, sys, math, ctypes, array 
-from   ostap.core.core import ( cpp      , Ostap     , 
+from   ostap.core.core import ( cpp      , Ostap     , std             ,
                                 ROOTCWD  , rootID    , 
                                 funcID   , funID     , fID             ,
                                 histoID  , hID       , dsID            ,
@@ -1908,6 +1908,18 @@ two_sigma   = 0.9544997361036415 ## the width of the +-2 sigma confidence interv
 #  the width of the +-3 sigma confidence interval 
 three_sigma = 0.9973002039367398 ## the width of the +-3 sigma confidence interval 
 # =============================================================================
+## interval functions that have the batch counterpart 
+#  @see Ostap::Math::binomial_intervals
+_binomial_intervals_ = {
+    'wald_interval'                    : Ostap.Math.BinomialInterval.Wald                  ,
+    'wilson_score_interval'            : Ostap.Math.BinomialInterval.WilsonScore           ,
+    'wilson_score_continuity_interval' : Ostap.Math.BinomialInterval.WilsonScoreContinuity ,
+    'arcsin_interval'                  : Ostap.Math.BinomialInterval.ArcSin                ,
+    'agresti_coull_interval'           : Ostap.Math.BinomialInterval.AgrestiCoull          ,
+    'jeffreys_interval'                : Ostap.Math.BinomialInterval.Jeffreys              ,
+    'clopper_pearson_interval'         : Ostap.Math.BinomialInterval.ClopperPearson        ,
+    }
+# =============================================================================
 ## calculate the efficiency graph using the binomial intervals 
 #  @code 
 #  >>> accepted   = ...
@@ -1930,7 +1942,7 @@ three_sigma = 0.9973002039367398 ## the width of the +-3 sigma confidence interv
 #  @see https://en.wikipedia.org/wiki/Binomial_proportion_confidence_interval
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
 #  @date   2011-06-07
-def binom_interval_h1 ( accepted , rejected , func , interval = one_sigma ) :
+def binom_interval_h1 ( accepted , rejected , func , interval = one_sigma , nthreads = 0 ) :
     """Calculate the efficiency graph using the binomial errors    
     >>> accepted   = ...
     >>> rejected   = ...
@@ -1949,13 +1961,15 @@ def binom_interval_h1 ( accepted , rejected , func , interval = one_sigma ) :
     - see Ostap::Math::agresti_coull_interval
     - see Ostap::Math::jeffreys_interval
     - see Ostap::Math::clopper_pearson_interval
+    - for the known interval types all intervals are calculated at once
+    - see Ostap::Math::binomial_intervals 
     """
     #
     h1 = accepted
     h2 = rejected 
     if isinstance ( h1 , ROOT.TProfile ) :
         hh = h1.asH1()
-        return binom_interval_h1 ( hh , h2 , func , interval )
+        return binom_interval_h1 ( hh , h2 , func , interval , nthreads )
     
     if not 0 <= interval <= 1 :
         logger.warning ( 'Invalid confidence interval: 0<=%s<==1' % interval )
@@ -1986,19 +2000,36 @@ def binom_interval_h1 ( accepted , rejected , func , interval = one_sigma ) :
         elif 0 == l2             : center = 1.0
         else                     : center = 1./(1.+float(l2)/l1)
         
-        res    = func ( l1 , l2 , interval )
-
-        minv   = res.first
-        maxv   = res.second
-        #
-        xv = x1.value()
-        xe = x1.error()
-
-        points.append ( ( xv , xe , xe , center , abs(center - minv) , abs(maxv - center ) ) ) 
+        points.append ( ( x1 , center , l1 , l2 ) )
 
+    ## the batch (parallel) calculation of all intervals with caching of the quantiles 
+    btype = _binomial_intervals_.get ( getattr ( func , '__name__' , '' ) , None )
+    if btype is None :
+        bounds = []
+        for x1 , center , l1 , l2 in points :
+            res = func ( l1 , l2 , interval ) 
+            bounds.append ( ( res.first , res.second ) ) 
+    else :
+        acc  = std.vector('unsigned long')()
+        rej  = std.vector('unsigned long')()
+        acc.reserve ( len ( points ) ) 
+        rej.reserve ( len ( points ) ) 
+        for x1 , center , l1 , l2 in points :
+            acc.push_back ( l1 )
+            rej.push_back ( l2 )
+        low  = std.vector('double')()
+        high = std.vector('double')()
+        Ostap.Math.binomial_intervals ( btype , acc , rej , interval , low , high , nthreads )
+        bounds = [ ( low [ i ] , high [ i ] ) for i in range ( len ( points ) ) ]
+        
     import ostap.histos.graphs 
     graph = ROOT.TGraphAsymmErrors ( len ( points ) )
-    for p in range( len ( points ) ) : graph[p] = points[p]
+    for p , ( point , bound ) in enumerate ( zip ( points , bounds ) ) :
+        x1 , center , l1 , l2 = point
+        minv , maxv = bound 
+        xv = x1.value()
+        xe = x1.error()
+        graph [ p ] = xv , xe , xe , center , abs ( center - minv ) , abs ( maxv - center ) 
     return graph 
 
 ROOT.TH1F.eff_wald                    = lambda accepted,rejected,interval=one_sigma : binom_interval_h1 ( accepted , rejected , Ostap.Math.wald_interval                    , interval ) 
@@ -4132,6 +4163,237 @@ ROOT.TH1F. smear = _smear_
 ROOT.TH1D. smear = _smear_
 
 
+# =============================================================================
+# Zero-copy numpy views on the histogram storage 
+# =============================================================================
+try :
+    import numpy as np
+except ImportError :
+    np = None
+# =============================================================================
+## get the numpy dtype for the <code>TArray</code>
+def _np_dtype_ ( arr ) :
+    """Get the numpy dtype for the `TArray`"""
+    if not np : return None 
+    for t , d in ( ( ROOT.TArrayD , 'float64' ) , ( ROOT.TArrayF , 'float32' ) ,
+                   ( ROOT.TArrayI , 'int32'   ) , ( ROOT.TArrayS , 'int16'   ) ,
+                   ( ROOT.TArrayC , 'int8'    ) ) :
+        if isinstance ( arr , t ) : return np.dtype ( d )
+    return None
+# =============================================================================
+## zero-copy flat numpy view for <code>TArray</code> 
+def _np_view_ ( arr , size , dtype ) :
+    """Zero-copy flat numpy view for `TArray`"""
+    if size <= 0 : return np.zeros ( 0 , dtype = dtype )
+    buf = arr.GetArray ()
+    buf.reshape ( ( size , ) )
+    return np.frombuffer ( buf , dtype = dtype , count = size )
+# =============================================================================
+## the shape of histogram storage (including under/overflow bins) 
+def _h_shape_ ( h ) :
+    """The shape of histogram storage (including under/overflow bins)"""
+    axes = h.GetXaxis () , h.GetYaxis () , h.GetZaxis () 
+    return tuple ( a.GetNbins () + 2 for a in axes [ : h.GetDimension () ] )
+# =============================================================================
+## reshape the flat view: ROOT global bin = ix + nx * ( iy + ny * iz ) 
+def _h_shaped_ ( flat , shape , flow ) :
+    """Reshape the flat view: ROOT global bin = ix + nx * ( iy + ny * iz )"""
+    view = flat.reshape ( shape [ : : -1 ] ).T
+    if not flow : view = view [ ( slice ( 1 , -1 ) , ) * len ( shape ) ]
+    return view 
+# =============================================================================
+## Zero-copy numpy view for the histogram content
+#  - the view has the shape <code>(nx,ny,nz)</code>, 
+#    <code>(nx+2,ny+2,nz+2)</code> with under/overflow bins: 
+#    <code>view[ix-1,iy-1]</code> (or <code>view[ix,iy]</code> with flow)
+#    is the content of <code>(ix,iy)</code> bin   
+#  - the view is writable: the histogram is modified
+#  @code
+#  histo = ...
+#  view  = histo.content_view () 
+#  print ( view.sum () , view.max () ) 
+#  view *= 2 
+#  @endcode
+#  @attention the view is valid only while the histogram is alive
+#             and the binning is not changed 
+def _h_content_view_ ( h , flow = False ) :
+    """Zero-copy numpy view for the histogram content
+    - the view has the shape `(nx,ny,nz)`, 
+    `(nx+2,ny+2,nz+2)` with under/overflow bins: 
+    `view[ix-1,iy-1]` (or `view[ix,iy]` with flow) is the content of `(ix,iy)` bin   
+    - the view is writable: the histogram is modified
+    >>> histo = ...
+    >>> view  = histo.content_view () 
+    >>> print ( view.sum () , view.max () ) 
+    >>> view *= 2 
+    - attention: the view is valid only while the histogram is alive
+    and the binning is not changed 
+    """
+    dtype = _np_dtype_ ( h )
+    if dtype is None :
+        raise TypeError ( "content_view: numpy is not available or invalid storage for %s" % type ( h ) )  
+    flat  = _np_view_ ( h , h.GetNcells () , dtype )
+    return _h_shaped_ ( flat , _h_shape_ ( h ) , flow )
+# =============================================================================
+## Zero-copy numpy view for the sum of squared weights (<code>fSumw2</code>)
+#  @code
+#  histo = ...
+#  sumw2 = histo.sumw2_view () 
+#  @endcode
+#  @return the view or <code>None</code> for the histogram without <code>Sumw2</code>
+def _h_sumw2_view_ ( h , flow = False ) :
+    """Zero-copy numpy view for the sum of squared weights (`fSumw2`)
+    >>> histo = ...
+    >>> sumw2 = histo.sumw2_view () 
+    - return the view or None for the histogram without `Sumw2`
+    """
+    if not np : raise TypeError ( "sumw2_view: numpy is not available" )
+    n = h.GetNcells () 
+    if h.GetSumw2N () != n : return None 
+    flat = _np_view_ ( h.GetSumw2 () , n , np.float64 ) 
+    return _h_shaped_ ( flat , _h_shape_ ( h ) , flow )
+# =============================================================================
+## numpy array of bin errors (not a view!)
+#  @code
+#  histo  = ...
+#  errors = histo.errors_array () 
+#  @endcode 
+def _h_errors_array_ ( h , flow = False ) :
+    """Numpy array of bin errors (not a view!)
+    >>> histo  = ...
+    >>> errors = histo.errors_array () 
+    """
+    sumw2 = _h_sumw2_view_ ( h , flow )
+    if sumw2 is None : return np.sqrt ( np.abs ( np.asarray ( _h_content_view_ ( h , flow ) , dtype = float ) ) )
+    return np.sqrt ( sumw2 ) 
+# =============================================================================
+## numpy array of bin edges for the axis (the view for non-uniform binning)
+def _axis_edges_ ( axis ) :
+    """Numpy array of bin edges for the axis (the view for non-uniform binning)"""
+    bins = axis.GetXbins ()
+    n    = bins.GetSize  ()
+    if 0 < n : return _np_view_ ( bins , n , np.float64 ) 
+    return np.linspace ( axis.GetXmin () , axis.GetXmax () , axis.GetNbins () + 1 )
+# =============================================================================
+## numpy array of bin edges for the histogram axis
+#  (the zero-copy view for non-uniform binning)
+#  @code
+#  histo  = ...
+#  xedges = histo.edges_view ( 'x' ) 
+#  yedges = histo.edges_view ( 1   ) 
+#  @endcode 
+def _h_edges_view_ ( h , axis = 'x' ) :
+    """Numpy array of bin edges for the histogram axis
+    (the zero-copy view for non-uniform binning)
+    >>> histo  = ...
+    >>> xedges = histo.edges_view ( 'x' ) 
+    >>> yedges = histo.edges_view ( 1   ) 
+    """
+    if not np : raise TypeError ( "edges_view: numpy is not available" )
+    axes = { 'x' : h.GetXaxis , 0 : h.GetXaxis ,
+             'y' : h.GetYaxis , 1 : h.GetYaxis ,
+             'z' : h.GetZaxis , 2 : h.GetZaxis }
+    if not axis in axes : raise IndexError ( "edges_view: invalid axis %s" % axis )
+    return _axis_edges_ ( axes [ axis ] () )
+# =============================================================================
+## can the fast vectorized (numpy) operations be used for this histogram?
+def _h_np_ok_ ( h ) :
+    """Can the fast vectorized (numpy) operations be used for this histogram?"""
+    return ( np is not None ) and \
+           ( _np_dtype_ ( h ) is not None ) and \
+           ( not isinstance ( h , ( ROOT.TProfile , ROOT.TProfile2D , ROOT.TProfile3D ) ) ) and \
+           ( h.GetBinErrorOption () == ROOT.TH1.kNormal )
+
+ROOT.TH1 . content_view = _h_content_view_
+ROOT.TH1 . sumw2_view   = _h_sumw2_view_
+ROOT.TH1 . errors_array = _h_errors_array_
+ROOT.TH1 . edges_view   = _h_edges_view_
+
+# =============================================================================
+## elementary functions and their derivatives for the vectorized transformation  
+_np_transforms_ = {} if not np else {
+    'exp'   : ( np.exp     , np.exp                                      ) ,
+    'expm1' : ( np.expm1   , np.exp                                      ) ,
+    'log'   : ( np.log     , lambda x : 1.0 / x                          ) ,
+    'log10' : ( np.log10   , lambda x : 1.0 / ( x * math.log ( 10 ) )    ) ,
+    'log1p' : ( np.log1p   , lambda x : 1.0 / ( 1 + x )                  ) ,
+    'sqrt'  : ( np.sqrt    , lambda x : 0.5 / np.sqrt ( x )              ) ,
+    'cbrt'  : ( np.cbrt    , lambda x : 1.0 / ( 3 * np.cbrt ( x ) ** 2 ) ) ,
+    'sin'   : ( np.sin     , np.cos                                      ) ,
+    'cos'   : ( np.cos     , lambda x : -np.sin ( x )                    ) ,
+    'tan'   : ( np.tan     , lambda x : 1.0 / np.cos ( x ) ** 2          ) ,
+    'sinh'  : ( np.sinh    , np.cosh                                     ) ,
+    'cosh'  : ( np.cosh    , np.sinh                                     ) ,
+    'tanh'  : ( np.tanh    , lambda x : 1.0 / np.cosh ( x ) ** 2         ) ,
+    'asin'  : ( np.arcsin  , lambda x :  1.0 / np.sqrt ( 1 - x * x )     ) ,
+    'acos'  : ( np.arccos  , lambda x : -1.0 / np.sqrt ( 1 - x * x )     ) ,
+    'atan'  : ( np.arctan  , lambda x :  1.0 / ( 1 + x * x )             ) ,
+    'asinh' : ( np.arcsinh , lambda x :  1.0 / np.sqrt ( x * x + 1 )     ) ,
+    'acosh' : ( np.arccosh , lambda x :  1.0 / np.sqrt ( x * x - 1 )     ) ,
+    'atanh' : ( np.arctanh , lambda x :  1.0 / ( 1 - x * x )             ) ,
+    }
+# =============================================================================
+## vectorized transformation of the histogram content with the 
+#  elementary function, the uncertainties are propagated linearly 
+#  @return the new histogram or <code>None</code> if not applicable
+def _h_transform_np_ ( h , name ) :
+    """Vectorized transformation of the histogram content with the
+    elementary function, the uncertainties are propagated linearly 
+    - return the new histogram or None if not applicable
+    """
+    if not name in _np_transforms_ or not _h_np_ok_ ( h ) : return None
+    fun , deriv = _np_transforms_ [ name ]
+    #
+    if not h.GetSumw2N () : h.Sumw2()
+    result = h.Clone ( hID () )
+    if not result.GetSumw2N () : result.Sumw2()
+    #
+    content = np.asarray ( _h_content_view_ ( h ) , dtype = float )
+    sumw2   = _h_sumw2_view_ ( h )
+    with np.errstate ( all = 'ignore' ) :
+        d = deriv ( content ) 
+        _h_content_view_ ( result ) [ ... ] = fun ( content )
+        _h_sumw2_view_   ( result ) [ ... ] = np.where ( 0 < sumw2 , d * d * sumw2 , 0.0 )
+    #
+    result.ResetStats() 
+    return result
+# =============================================================================
+## create the transformation method: vectorized if possible, 
+#  otherwise bin-by-bin 
+def _h_math_method_ ( name , slow ) :
+    """Create the transformation method: vectorized if possible, otherwise bin-by-bin"""
+    def _method_ ( self ) :
+        result = _h_transform_np_ ( self , name )
+        return result if result is not None else slow ( self )
+    _method_.__doc__ = slow.__doc__ 
+    return _method_
+
+# =============================================================================
+## the vectorized integration (taking into account the bin-width) 
+#  @param h     the histogram
+#  @param lows  low bin indices for axes (inclusive)
+#  @param highs high bin indices for axes (exclusive) 
+#  @param mins  low edges for axes 
+#  @param maxs  high edges for axes 
+#  @return the integral (as VE) or <code>None</code> if not applicable
+def _h_integrate_np_ ( h , lows , highs , mins , maxs ) :
+    """Vectorized integration (taking into account the bin-width) 
+    - return the integral (as VE) or None if not applicable
+    """
+    if not _h_np_ok_ ( h ) : return None
+    content = np.asarray ( _h_content_view_ ( h ) , dtype = float )
+    sumw2   = _h_sumw2_view_ ( h )
+    if sumw2 is None : sumw2 = np.abs ( content )
+    axes    = ( h.GetXaxis () , h.GetYaxis () , h.GetZaxis () ) [ : content.ndim ]
+    volume  = None 
+    for axis , low , high , vmin , vmax in zip ( axes , lows , highs , mins , maxs ) :
+        edges  = _axis_edges_ ( axis )
+        widths = np.clip ( np.minimum ( edges [ 1: ] , vmax ) - np.maximum ( edges [ :-1 ] , vmin ) , 0 , None )
+        ibin   = np.arange ( 1 , len ( widths ) + 1 )
+        widths [ ( ibin < low ) | ( high <= ibin ) ] = 0 
+        volume = widths if volume is None else np.multiply.outer ( volume , widths )
+    return VE ( float ( np.sum ( content * volume ) ) , float ( np.sum ( sumw2 * volume * volume ) ) ) 
+
 # =============================================================================
 ## make transformation of histogram content 
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
@@ -4243,6 +4505,12 @@ for h in ( ROOT.TH2F , ROOT.TH2D ) :
     h. __tgamma__ = lambda s : _h2_transform_ ( s , lambda x,y,z : math_ve.tgamma ( z ) )
     h. __lgamma__ = lambda s : _h2_transform_ ( s , lambda x,y,z : math_ve.lgamma ( z ) )
 
+## the elementary functions: vectorized transformations, if possible 
+for h in ( ROOT.TH1F , ROOT.TH1D , ROOT.TH2F , ROOT.TH2D ) :
+    for _name in _np_transforms_ :
+        _slow = getattr ( h , '__%s__' % _name , None )
+        if _slow : setattr ( h , '__%s__' % _name , _h_math_method_ ( _name , _slow ) )
+
 # =============================================================================
 # Few "specific" transformations
 # =============================================================================
@@ -5240,6 +5508,11 @@ def _h1_rshift_ ( h , ibias ) :
     return _h1_lshift_ ( h , -1 * ibias )
 
 
+# =============================================================================
+## default accumulation for <code>integrate</code> 
+def _h_sum_ ( s , v ) : return s + v
+## default selection for <code>integrate</code> 
+def _h_all_ ( s     ) : return True 
 # =============================================================================
 ## perform some integration(taking into acount the bin-width) for the histogram
 #  @code
@@ -5249,11 +5522,13 @@ def _h1_rshift_ ( h , ibias ) :
 #  sum = h.integrate ( lowx = 1    , highx = 14  ) ## accumulate over    1<= ibin <14
 #  sum = h.interrate ( xmin = 0.14 , xmax = 21.2 ) ## accumulate over xmin<= x    <xmax
 #  @endcode
+#  For the default <code>func</code> and <code>cut</code> the vectorized 
+#  (numpy) integration is used 
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
 #  @date   2011-06-07
 def _h1_integrate_ ( h                         ,
-                     func   = lambda s,v : s + v ,
-                     cut    = lambda s   : True  , 
+                     func   = _h_sum_            ,
+                     cut    = _h_all_            , 
                      init   = VE ()              ,
                      lowx   =  1                 ,
                      highx  = -1                 ,
@@ -5276,6 +5551,10 @@ def _h1_integrate_ ( h                         ,
     ## check
     if highx <= lowx  or xmax <= xmin : return result
     ##
+    if func is _h_sum_ and cut is _h_all_ :
+        r = _h_integrate_np_ ( h , ( lowx , ) , ( highx , ) , ( xmin , ) , ( xmax , ) )
+        if r is not None : return result + r                ## RETURN 
+    ##
     for i in h.items() :
 
         ibinx = i[0]
@@ -5314,8 +5593,8 @@ def _h1_integrate_ ( h                         ,
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
 #  @date   2011-06-07
 def _h2_integrate_ ( h                         ,
-                     func   = lambda s,v : s + v ,
-                     cut    = lambda s   : True  , 
+                     func   = _h_sum_            ,
+                     cut    = _h_all_            , 
                      init   = VE ()              ,
                      lowx   =  1                 ,
                      highx  = -1                 ,
@@ -5346,6 +5625,10 @@ def _h2_integrate_ ( h                         ,
     if highx <= lowx  or xmax <= xmin : return result
     if highy <= lowy  or ymax <= ymin : return result
     ##
+    if func is _h_sum_ and cut is _h_all_ :
+        r = _h_integrate_np_ ( h , ( lowx , lowy ) , ( highx , highy ) , ( xmin , ymin ) , ( xmax , ymax ) )
+        if r is not None : return result + r                ## RETURN 
+    ##
     for i in h.iteritems() :
 
         ibinx = i[0]
@@ -5391,8 +5674,8 @@ def _h2_integrate_ ( h                         ,
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
 #  @date   2011-06-07
 def _h3_integrate_ ( h                         ,
-                     func   = lambda s,v : s + v ,
-                     cut    = lambda s   : True  , 
+                     func   = _h_sum_            ,
+                     cut    = _h_all_            , 
                      init   = VE ()              ,
                      lowx   =  1                 ,
                      highx  = -1                 ,
@@ -5431,6 +5714,11 @@ def _h3_integrate_ ( h                         ,
     if highy <= lowy  or ymax <= ymin : return result
     if highz <= lowz  or zmax <= zmin : return result
     ##
+    if func is _h_sum_ and cut is _h_all_ :
+        r = _h_integrate_np_ ( h , ( lowx , lowy , lowz ) , ( highx , highy , highz ) ,
+                               ( xmin , ymin , zmin ) , ( xmax , ymax , zmax ) )
+        if r is not None : return result + r                ## RETURN 
+    ##
     for i in h.items() :
 
         ibinx = i[0]
@@ -7400,15 +7688,14 @@ for t in  ( ROOT.TH1D             ,
 #  histo = ...
 #  h     = hash ( histo ) 
 #  @endcode
+#  @see Ostap::Utils::hash_histo 
 def _h_hash_ ( histo) :
-    """
+    """Hashing function for the histograms 
     >>> histo = ...
     >>> h     = hash ( histo ) 
+    - see Ostap::Utils::hash_histo
     """
-    hv = hash ( ( histo.GetName  () , histo.GetTitle() , type ( histo ) ) ) 
-    for item in histo.iteritems() :
-        hv = hash ( item + ( hv, ) )
-    return hv
+    return hash ( ( Ostap.Utils.hash_histo ( histo ) , histo.GetTitle () ) ) 
 
 ROOT.TH1.__hash__ = _h_hash_ 
 # =============================================================================
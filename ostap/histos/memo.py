@@ -0,0 +1,132 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file  ostap/histos/memo.py
+#  Content-addressed memoization of the objects, derived from histograms
+#  (parameterizations, interpolation tables, ... )
+#  - the key is built from the content hash of the histogram
+#    (type, binning, bin contents and errors, but not name/title),
+#    the kind of derived object and its configuration
+#  - therefore repeated conversions of unchanged histograms are free
+#  @code
+#  r1 = histo.bernstein ( 5 )   ## make a fit
+#  r2 = histo.bernstein ( 5 )   ## taken from the cache
+#  r3 = histo.bernstein ( 5 , memo = False ) ## no cache
+#  print ( histo_cache_stat () )
+#  @endcode
+#  @attention the cached objects are shared, they should not be modified
+#  @see Ostap::Utils::hash_histo_content
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Content-addressed memoization of the objects, derived from histograms
+(parameterizations, interpolation tables, ... )
+- the key is built from the content hash of the histogram
+  (type, binning, bin contents and errors, but not name/title),
+  the kind of derived object and its configuration
+- therefore repeated conversions of unchanged histograms are free
+
+>>> r1 = histo.bernstein ( 5 )   ## make a fit
+>>> r2 = histo.bernstein ( 5 )   ## taken from the cache
+>>> r3 = histo.bernstein ( 5 , memo = False ) ## no cache
+>>> print ( histo_cache_stat () )
+
+- attention: the cached objects are shared, they should not be modified
+- see Ostap::Utils::hash_histo_content
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'histo_key'        , ## the content key for the histogram
+    'the_histo_cache'  , ## the cache of objects, derived from histograms
+    'memoize'          , ## get the derived object from the cache or create it
+    'memoized'         , ## decorator for the histogram methods
+    'histo_cache_stat' , ## statistics of the cache
+    )
+# =============================================================================
+import ROOT, functools
+from   ostap.core.core     import Ostap
+from   ostap.math.cache    import LRUCache, make_key
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.histos.memo' )
+else                       : logger = getLogger ( __name__            )
+# =============================================================================
+## the cache of objects, derived from histograms
+the_histo_cache = LRUCache ( 1000 )
+
+# =============================================================================
+## the content key for the histogram
+#  @see Ostap::Utils::hash_histo_content
+def histo_key ( histo ) :
+    """The content key for the histogram
+    - see Ostap::Utils::hash_histo_content
+    """
+    return 'TH' , int ( Ostap.Utils.hash_histo_content ( histo ) )
+
+# =============================================================================
+## get the derived object from the cache or create it
+#  @code
+#  table = memoize ( 'table' , histo , lambda : make_table ( histo , 3 ) , 3 )
+#  @endcode
+#  @param what    the kind of the derived object
+#  @param histo   the histogram
+#  @param factory the function to create the object
+#  @param config  the configuration of the object
+def memoize ( what , histo , factory , *config ) :
+    """Get the derived object from the cache or create it
+    >>> table = memoize ( 'table' , histo , lambda : make_table ( histo , 3 ) , 3 )
+    - what    : the kind of the derived object
+    - histo   : the histogram
+    - factory : the function to create the object
+    - config  : the configuration of the object
+    """
+    if not the_histo_cache.enabled : return factory ()
+    key = make_key ( what , histo_key ( histo ) , *config )
+    return the_histo_cache.get ( key , factory )
+
+# =============================================================================
+## decorator for the histogram methods: the result is taken from the cache
+#  for the same content of histogram and the same arguments
+#  - the additional keyword argument <code>memo=False</code> disables the cache
+#  @code
+#  @memoized ( 'bernstein' )
+#  def _h1_bernstein_ ( h1 , degree , ... ) : ...
+#  @endcode
+def memoized ( what ) :
+    """Decorator for the histogram methods: the result is taken from the cache
+    for the same content of histogram and the same arguments
+    - the additional keyword argument `memo=False` disables the cache
+    >>> @memoized ( 'bernstein' )
+    ... def _h1_bernstein_ ( h1 , degree , ... ) : ...
+    """
+    def _decorator_ ( method ) :
+        @functools.wraps ( method )
+        def _memoized_ ( histo , *args , **kwargs ) :
+            if not kwargs.pop ( 'memo' , True ) : return method ( histo , *args , **kwargs )
+            return memoize ( what , histo ,
+                             lambda : method ( histo , *args , **kwargs ) ,
+                             args , kwargs )
+        return _memoized_
+    return _decorator_
+
+# =============================================================================
+## statistics of the cache
+#  @code
+#  print ( 'hits/misses: %(hits)d/%(misses)d' % histo_cache_stat () )
+#  @endcode
+def histo_cache_stat ( reset = False ) :
+    """Statistics of the cache
+    >>> print ( 'hits/misses: %(hits)d/%(misses)d' % histo_cache_stat () )
+    """
+    return the_histo_cache.stat ( reset = reset )
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
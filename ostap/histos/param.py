@@ -131,7 +131,9 @@ Typical usage:
 __version__ = "$Revision$"
 __author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
 __date__    = "2011-06-07"
-__all__     = () ## nothing to import 
+__all__     = (
+    'param_many' , ## linear least-squares parameterization of many histograms (in parallel)
+    )
 # =============================================================================
 import ROOT, math 
 # =============================================================================
@@ -305,6 +307,78 @@ def _h1_param_sum_ ( h1               ,
     h1._param_FIT_info = results 
     return results
 
+# =============================================================================
+## the basis functions, suitable for the linear least-squares parameterization
+#  @see Ostap::Math::HistoParam 
+_lsq_types_ = ( Ostap.Math.LegendreSum  ,
+                Ostap.Math.ChebyshevSum ,
+                Ostap.Math.Polynomial   ,
+                Ostap.Math.Bernstein    ,
+                Ostap.Math.BSpline      )
+# =============================================================================
+## the direct linear least-squares parameterization of 1D-histogram
+#  as the linear combination of basis functions:
+#  all coefficients are obtained with one solution of the normal equations
+#  using the averages of basis functions over bins
+#  @code
+#  histo = ...
+#  func  = histo.param_lsq ( Ostap.Math.Bernstein ( 5 , xmin , xmax ) )
+#  func  = histo.param_lsq ( Ostap.Math.Bernstein ( 5 , xmin , xmax ) , nonnegative = True )
+#  @endcode
+#  @param h1          the histogram
+#  @param func        the function (the basis and the range), it is not modified
+#  @param nonnegative require non-negative coefficients?
+#  @return the new function or <code>None</code> in case of failure
+#  @see Ostap::Math::HistoParam
+def _h1_lsq_ ( h1 , func , nonnegative = False ) :
+    """The direct linear least-squares parameterization of 1D-histogram
+    as the linear combination of basis functions:
+    all coefficients are obtained with one solution of the normal equations
+    using the averages of basis functions over bins
+    >>> histo = ...
+    >>> func  = histo.param_lsq ( Ostap.Math.Bernstein ( 5 , xmin , xmax ) )
+    >>> func  = histo.param_lsq ( Ostap.Math.Bernstein ( 5 , xmin , xmax ) , nonnegative = True )
+    - see Ostap::Math::HistoParam
+    """
+    assert isinstance ( func , _lsq_types_ ) , \
+           "param_lsq: invalid type of function %s" % type ( func )
+    result = type ( func ) ( func )
+    sc     = Ostap.Math.HistoParam.fit ( h1 , result , True if nonnegative else False )
+    if sc.isFailure () :
+        logger.warning ( "param_lsq: linear least-squares fit failed %s" % sc )
+        return None 
+    return result
+
+# =============================================================================
+## the direct linear least-squares parameterization of many 1D-histograms
+#  (in parallel). For the same binning the design matrix is built only once
+#  @code
+#  histos = [ ... ]
+#  funcs  = param_many ( histos , Ostap.Math.LegendreSum ( 5 , xmin , xmax ) )
+#  @endcode
+#  @param histos      the histograms
+#  @param func        the function (the basis and the range), it is not modified
+#  @param nonnegative require non-negative coefficients?
+#  @param nthreads    number of threads, 0 means "all"
+#  @return the list of functions, one per histogram
+#  @see Ostap::Math::HistoParam
+def param_many ( histos , func , nonnegative = False , nthreads = 0 ) :
+    """The direct linear least-squares parameterization of many 1D-histograms
+    (in parallel). For the same binning the design matrix is built only once
+    >>> histos = [ ... ]
+    >>> funcs  = param_many ( histos , Ostap.Math.LegendreSum ( 5 , xmin , xmax ) )
+    - see Ostap::Math::HistoParam
+    """
+    assert isinstance ( func , _lsq_types_ ) , \
+           "param_many: invalid type of function %s" % type ( func )
+    assert isinstance ( nthreads , integer_types ) and 0 <= nthreads , \
+           "param_many: invalid number of threads %s" % nthreads 
+    hs = ROOT.std.vector ( 'const TH1*' ) ()
+    hs.reserve ( len ( histos ) )
+    for h in histos : hs.push_back ( h )
+    result = Ostap.Math.HistoParam.fit_many ( hs , func , True if nonnegative else False , nthreads )
+    return [ f for f in result ]
+
 # =============================================================================
 ## represent 1D-histo as Bernstein polynomial
 #  @code
@@ -348,7 +422,8 @@ def _h1_bernstein_ ( h1               ,
     xmin = max ( xmin , h1.xmin() ) 
     xmax = min ( xmax , h1.xmax() )  
     # make reasonable approximation
-    func  = bezier_sum ( h1   , degree , xmin , xmax )
+    func  = _h1_lsq_ ( h1 , Ostap.Math.Bernstein ( degree , xmin , xmax ) )
+    if not func : func = bezier_sum ( h1 , degree , xmin , xmax )
     ## make a fit 
     if not params : params = tuple ( [ p for p in func.pars() ] ) 
     from ostap.fitting.param import H_fit
@@ -467,7 +542,8 @@ def _h1_chebyshev_ ( h1               ,
     xmin = max ( xmin , h1.xmin() ) 
     xmax = min ( xmax , h1.xmax() )  
     ## make reasonable approximation: 
-    func = chebyshev_sum ( h1 , degree ,  xmin , xmax )
+    func = _h1_lsq_ ( h1 , Ostap.Math.ChebyshevSum ( degree , xmin , xmax ) )
+    if not func : func = chebyshev_sum ( h1 , degree ,  xmin , xmax )
     ## make a fit 
     if not params : params = tuple ( [ p for p in func.pars() ] ) 
     from ostap.fitting.param import H_fit
@@ -522,21 +598,20 @@ def _h1_legendre_ ( h1               ,
     >>> print 'TF1(%s) = %s' % ( x ,        tf1 ( x ) ) 
     >>> print 'FUN(%s) = %s' % ( x , norm * fun ( x ) ) 
     """
-    ## make reasonable approximation:
-    mn,mx  = h1.xminmax()
-    ##
-    if 1 > h1.GetEntries() : sw = 1
-    else :
-        vmn,vmx = h1.minmax()     
-        sw      = max ( abs ( h1.GetSumOfWeights() ) ,
-                        abs ( h1.Integral()        ) , abs ( vmn ) , abs ( vmx ) ) 
-    ##
     xmin = max ( xmin , h1.xmin() ) 
     xmax = min ( xmax , h1.xmax() )  
-    func  = legendre_sum   ( h1 , degree , xmin , xmax , 
-                             epsabs = 1.e-4 * sw    ,
-                             epsrel = 1.e-3         ,
-                             limit  = 3 * h1.bins() ) 
+    ## make reasonable approximation:
+    func = _h1_lsq_ ( h1 , Ostap.Math.LegendreSum ( degree , xmin , xmax ) )
+    if not func :
+        if 1 > h1.GetEntries() : sw = 1
+        else :
+            vmn,vmx = h1.minmax()     
+            sw      = max ( abs ( h1.GetSumOfWeights() ) ,
+                            abs ( h1.Integral()        ) , abs ( vmn ) , abs ( vmx ) ) 
+        func  = legendre_sum   ( h1 , degree , xmin , xmax , 
+                                 epsabs = 1.e-4 * sw    ,
+                                 epsrel = 1.e-3         ,
+                                 limit  = 3 * h1.bins() ) 
     ## make a fit 
     if not params : params = tuple ( [ p for p in func.pars() ] ) 
     from ostap.fitting.param import H_fit
@@ -1536,10 +1611,11 @@ def _h1_concavespline_ ( h1               ,
 
 # =============================================================================
 
-_new_methods_ = []
+_new_methods_ = [ _h1_lsq_ ]
 # =============================================================================
 ## decorate histograms 
 for t in ( ROOT.TH1D , ROOT.TH1F ) :
+    t.param_lsq      = _h1_lsq_
     t.bernstein      = _h1_bernstein_
     t.bezier         = _h1_bernstein_ ## ditto 
     t.bernsteineven  = _h1_bernsteineven_
@@ -2543,6 +2619,35 @@ for h in ( ROOT.TH3F , ROOT.TH3D ) :
 
 _new_methods_ .append ( _h3_legendre_fast_   )
 
+# =============================================================================
+## content-addressed memoization of the parameterizations:
+#  the repeated parameterization of the unchanged histogram is taken from the cache
+#  @see ostap.histos.memo
+from ostap.histos.memo import memoized as _memoized_
+for t in ( ROOT.TH1D , ROOT.TH1F ) :
+    for _name in ( 'bernstein'     , 'bezier'        , 'bernsteineven' , 'beziereven'    ,
+                   'chebyshev'     , 'legendre'      , 'fourier'       , 'cosine'        ,
+                   'polynomial'    , 'positive'      , 'positiveeven'  , 'monotonic'     ,
+                   'convex'        , 'convexpoly'    , 'concavepoly'   ,
+                   'bSpline'       , 'pSpline'       , 'mSpline'       , 'cSpline'       ,
+                   'convexSpline'  , 'concaveSpline' , 'convexspline'  , 'concavespline' ,
+                   'legendre_fast' ,
+                   'pdf_positive'  , 'pdf_positiveeven' , 'pdf_even' , 'pdf_monotonic'   ,
+                   'pdf_increasing'         , 'pdf_decreasing'         ,
+                   'pdf_convex'             , 'pdf_convex_increasing'  , 'pdf_convex_decreasing'  ,
+                   'pdf_concave'            , 'pdf_concave_increasing' , 'pdf_concave_decreasing' ,
+                   'pdf_convexpoly'         , 'pdf_concavepoly'        ,
+                   'pdf_pSpline'  , 'pdf_mSpline' , 'pdf_cSpline' , 'pdf_convexSpline' , 'pdf_concaveSpline' ,
+                   'legendre_sum' , 'chebyshev_sum' , 'fourier_sum'  , 'cosine_sum' ,
+                   'bezier_sum'   , 'bernstein_sum' , 'beziereven_sum' , 'bernsteineven_sum' ) :
+        _method = getattr ( t , _name )
+        setattr ( t , _name , _memoized_ ( _method.__name__ ) ( _method ) )
+        
+for t in ( ROOT.TH2F , ROOT.TH2D , ROOT.TH3F , ROOT.TH3D ) :
+    for _name in ( 'legendre' , 'legendre_fast' ) :
+        _method = getattr ( t , _name )
+        setattr ( t , _name , _memoized_ ( _method.__name__ ) ( _method ) )
+
 # =============================================================================
 _decorated_classes = (
     ROOT.TH1D ,
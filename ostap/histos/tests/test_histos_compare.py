@@ -206,7 +206,41 @@ def test_compare_uniform_vs_exponent () :
         for ie in ( h1e , h2e , h3e , h4e , h5e ) :
             _ie += 1 
             compare ( iu , ie , 'Compare uniform   (%d) and exponent    (%d)' % ( _iu , _ie ) )
+                        
+# =============================================================================
+## compare C++ bin-by-bin metrics with the explicit python loops
+def test_compare_cpp () :
+
+    from ostap.histos.compare import compare_many
+
+    for ha , hb in ( ( h1g , h2g ) , ( h1u , h2u ) , ( h1e , h2e ) , ( h4g , h4e ) ) :
+
+        chi2 , r1 , r2 , r12 = 0.0 , 0.0 , 0.0 , 0.0 
+        for i , x , va in ha.items () :
+            vb    = hb [ i ]
+            chi2 += va.chi2 ( vb )
+            w     = 2 * x.error ()
+            r1   += w * va.value () ** 2 
+            r2   += w * vb.value () ** 2 
+            r12  += w * va.value () * vb.value ()
             
+        c2ndf , prob = ha.cmp_chi2 ( hb )
+        assert abs ( c2ndf - chi2 / len ( ha ) ) < 1.e-8 , 'Invalid C++ chi2/ndf' 
+        cos = ha.cmp_dcos ( hb )
+        assert abs ( cos.value () - r12 / ( r1 * r2 ) ** 0.5 ) < 1.e-8 , 'Invalid C++ cos(theta)' 
+
+        ( xmin , vmin ) , ( xmax , vmax ) = ha.cmp_minmax ( hb )
+        diffs = [ ( hb [ i ] - va ).value () for i , x , va in ha.items () ]
+        assert abs ( vmin.value () - min ( diffs ) ) < 1.e-8 , 'Invalid C++ minimal difference'
+        assert abs ( vmax.value () - max ( diffs ) ) < 1.e-8 , 'Invalid C++ maximal difference'
+
+    pairs = [ ( h1g , h2g ) , ( h1u , h2u ) , ( h1e , h2e ) ] * 10 
+    for metric in ( 'chi2' , 'prob' , 'cos' , 'dist' , 'min' , 'max' ) :
+        r1 = compare_many ( pairs , metric , nthreads = 1 )
+        r4 = compare_many ( pairs , metric , nthreads = 4 )
+        assert r1 == r4 , 'Sequential and parallel results differ for %s' % metric 
+    logger.info ( 'C++ bin-by-bin metrics are OK' ) 
+
 # =============================================================================
 if '__main__' == __name__ :
     
@@ -216,6 +250,7 @@ if '__main__' == __name__ :
     test_compare_gauss_vs_uniform    ()
     test_compare_gauss_vs_exponent   ()
     test_compare_uniform_vs_exponent ()
+    test_compare_cpp                 ()
     
     pass
 
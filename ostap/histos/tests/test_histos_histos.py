@@ -27,8 +27,9 @@ else :
 logger.info ( 'Test for basic operations with histograms')
 # =============================================================================
 from  ostap.math.ve        import VE 
-from  ostap.core.core      import hID 
+from  ostap.core.core      import hID, Ostap, std 
 from  ostap.histos.histos  import h1_axis, h2_axes 
+import ostap.histos.param
 from  builtins             import range
 # =============================================================================
 ## Test for very basic operations with 1D-histograms
@@ -313,8 +314,119 @@ def test_efficiency() :
             logger.info ( "%43s: %s" % ( n , vals ) ) 
             
                     
-            
+# =============================================================================
+## Test for numpy views and vectorized operations 
+def test_numpy_views () :
+
+    logger.info ( 'Test for numpy views and vectorized operations')
+
+    try :
+        import numpy as np
+    except ImportError :
+        logger.warning ( 'numpy is not available, skip the test' )
+        return
+
+    h3 = ROOT.TH3D ( hID() , '' , 10 , 0 , 1 , 8 , 0 , 2 , 5 , -1 , 1 )
+    h3.Sumw2()
+    for i in range ( 10000 ) :
+        h3.Fill ( random.random() , 2 * random.random() , random.uniform ( -1 , 1 ) , random.uniform ( 0.5 , 1.5 ) )
+
+    view = h3.content_view ()
+    assert view.shape == ( 10 , 8 , 5 ) , 'Invalid shape of the content view!'
+    assert view [ 2 , 3 , 4 ] == h3.GetBinContent ( 3 , 4 , 5 ) , 'Invalid content view!'
+    assert h3.sumw2_view () [ 2 , 3 , 4 ] == h3.GetBinError ( 3 , 4 , 5 ) ** 2 , 'Invalid sumw2 view!'
+    assert len ( h3.edges_view ( 'y' ) ) == 9 , 'Invalid edges view!'
+
+    ## the views are writable 
+    h3.content_view ( flow = True ) [ 1 , 1 , 1 ] = 1000 
+    assert 1000 == h3.GetBinContent ( 1 , 1 , 1 ) , 'The view is not writable!'
+
+    h1 = ROOT.TH1D ( hID() , '' , 20 , 0 , 1 )
+    h1.Sumw2()
+    for i in range ( 1000 ) : h1.Fill ( random.random () )
+    
+    fast = h1.integrate ( xmin = 0.13 , xmax = 0.77 )
+    slow = h1.integrate ( xmin = 0.13 , xmax = 0.77 , cut = lambda s : True )
+    logger.info ( 'Integral: vectorized %s, bin-by-bin %s' % ( fast , slow ) )
+    assert abs ( fast.value () - slow.value () ) < 1.e-8 * abs ( slow.value () ) , 'Invalid vectorized integral!'
 
+    hs = h1.__sqrt__ ()
+    for i in h1 :
+        assert abs ( hs [ i ].value () - h1 [ i ].value () ** 0.5 ) < 1.e-8 , 'Invalid vectorized transformation!'
+    
+# =============================================================================
+## Test for content hash and memoization of derived objects
+def test_histo_memo () :
+
+    logger.info ( 'Test for content hash and memoization of derived objects')
+
+    from ostap.histos.memo import histo_key, histo_cache_stat 
+    
+    h1 = ROOT.TH1D ( hID() , '' , 50 , 0 , 1 )
+    h1.Sumw2()
+    for i in range ( 10000 ) : h1.Fill ( random.random () ** 2 )
+
+    h2 = h1.clone ()
+    assert histo_key ( h1 ) == histo_key ( h2 ) , 'Content hash depends on the name!'
+
+    p1 = h1.legendre_fast ( 4 )
+    stat = histo_cache_stat ()
+    p2 = h2.legendre_fast ( 4 )
+    assert p1 is p2 , 'The parameterization is not taken from the cache!'
+    assert histo_cache_stat () [ 'hits' ] == stat [ 'hits' ] + 1 , 'Invalid cache statistics!'
+
+    h2.Fill ( 0.5 )
+    assert histo_key ( h1 ) != histo_key ( h2 ) , 'Content hash does not depend on the content!'
+    assert h2.legendre_fast ( 4 ) is not p1 , 'Modified histogram is taken from the cache!'
+    assert h1.legendre_fast ( 4 , memo = False ) is not p1 , 'The cache is not disabled!'
+
+# =============================================================================
+## batch calculation of the binomial intervals 
+def test_binomial_intervals () :
+
+    logger = getLogger ( 'test_binomial_intervals' )
+
+    accepted = [ 0 , 0 , 1 , 5 , 5 , 10 , 100 , 5 , 0 , 1000 ] 
+    rejected = [ 0 , 3 , 0 , 5 , 5 ,  1 ,  50 , 5 , 7 , 1    ]
+
+    acc  = std.vector('unsigned long')()
+    rej  = std.vector('unsigned long')()
+    for a , r in zip ( accepted , rejected ) :
+        acc.push_back ( a )
+        rej.push_back ( r ) 
+
+    for name , btype , func in [
+            ( 'Wald'            , Ostap.Math.BinomialInterval.Wald           , Ostap.Math.wald_interval            ) , 
+            ( 'Wilson'          , Ostap.Math.BinomialInterval.WilsonScore    , Ostap.Math.wilson_score_interval    ) , 
+            ( 'Jeffreys'        , Ostap.Math.BinomialInterval.Jeffreys       , Ostap.Math.jeffreys_interval        ) , 
+            ( 'Clopper-Pearson' , Ostap.Math.BinomialInterval.ClopperPearson , Ostap.Math.clopper_pearson_interval ) ] : 
+
+        for nthreads in ( 1 , 4 ) : 
+            low  = std.vector('double')()
+            high = std.vector('double')()
+            n    = Ostap.Math.binomial_intervals ( btype , acc , rej , 0.68 , low , high , nthreads )
+            assert n == len ( accepted ) , 'Invalid number of intervals!'
+            for i , ( a , r ) in enumerate ( zip ( accepted , rejected ) ) :
+                res = func ( a , r , 0.68 )
+                assert abs ( low  [ i ] - res.first  ) < 1.e-12 and \
+                       abs ( high [ i ] - res.second ) < 1.e-12 , \
+                       '%s: mismatch in batch interval for (%d,%d)' % ( name , a , r )
+
+        ## weighted data with unit weights reproduce the integer intervals 
+        sa  = std.vector('double')()
+        sr  = std.vector('double')()
+        for a , r in zip ( accepted , rejected ) :
+            sa.push_back ( a )
+            sr.push_back ( r ) 
+        Ostap.Math.binomial_intervals ( btype , sa , sa , sr , sr , 0.68 , low , high )
+        for i , ( a , r ) in enumerate ( zip ( accepted , rejected ) ) :
+            res = func ( a , r , 0.68 )
+            assert abs ( low  [ i ] - res.first  ) < 1.e-8 and \
+                   abs ( high [ i ] - res.second ) < 1.e-8 , \
+                   '%s: mismatch in weighted interval for (%d,%d)' % ( name , a , r )
+            
+        logger.info ( 'Batch %-16s intervals are OK' % name ) 
+    
 # =============================================================================
 if '__main__' == __name__ :
 
@@ -325,6 +437,12 @@ if '__main__' == __name__ :
     ## test_basic_2D   ()
     
     ## test_efficiency () 
+
+    ## test_numpy_views () 
+
+    ## test_histo_memo  () 
+
+    ## test_binomial_intervals () 
     
 # =============================================================================
 ##                                                                      The END 
@@ -164,10 +164,52 @@ def test_3D2() :
                         y = random.uniform ( *h.yminmax() )
                         z = random.uniform ( *h.zminmax() )
 
-                        v = h ( x,y,z, interpolate = itype ) 
-        
+                        v = h ( x,y,z, interpolate = itype )
+
+
+# =============================================================================
+##  compare the compiled interpolation tables with the direct interpolation
+def test_tables () :
+
+    from ostap.core.core import Ostap
+
+    HI    = Ostap.Math.HistoInterpolation
+    types = 0 , 1 , 2 , 3
+
+    cnt   = SE ()
+    for tx in types :
+        for ty in types :
+            for edges in ( False , True ) :
+                for extrapolate in ( False , True ) :
+                    for density in ( False , True ) :
+                        tz = ( tx + ty ) % 4
+                        t1 = Ostap.Math.HistoTable1D ( h1 , tx ,           edges , extrapolate , density )
+                        t2 = Ostap.Math.HistoTable2D ( h2 , tx , ty ,      edges , extrapolate , density )
+                        t3 = Ostap.Math.HistoTable3D ( h3 , tx , ty , tz , edges , extrapolate , density )
+                        for i in range ( 20 ) :
+                            x , y , z = [ random.uniform ( -0.1 , 1.1 ) for k in range ( 3 ) ]
+                            v1 = HI.interpolate_1D ( h1 , x ,         tx ,           edges , extrapolate , density )
+                            v2 = HI.interpolate_2D ( h2 , x , y ,     tx , ty ,      edges , extrapolate , density )
+                            v3 = HI.interpolate_3D ( h3 , x , y , z , tx , ty , tz , edges , extrapolate , density )
+                            for a , b in ( ( t1 ( x ) , v1 ) , ( t2 ( x , y ) , v2 ) , ( t3 ( x , y , z ) , v3 ) ) :
+                                d = abs ( a.value () - b.value () ) + abs ( a.cov2 () - b.cov2 () )
+                                cnt += d
+                                assert d <= 1.e-8 * ( 1 + abs ( b.value () ) + abs ( b.cov2 () ) ) , \
+                                       'Table/interpolation mismatch: %s vs %s' % ( a , b )
+
+    logger.info ( 'Tables vs interpolation, difference: %s' % cnt )
+
+    ## batched evaluation
+    from array import array
+    t2 = Ostap.Math.HistoTable2D ( h2 , 3 , 3 )
+    xs = array ( 'd' , [ random.uniform ( 0 , 1 ) for i in range ( 1000 ) ] )
+    ys = array ( 'd' , [ random.uniform ( 0 , 1 ) for i in range ( 1000 ) ] )
+    rs = array ( 'd' , len ( xs ) * [ 0.0 ] )
+    t2.eval ( xs , ys , len ( xs ) , rs )
+    for x , y , r in zip ( xs , ys , rs ) :
+        assert abs ( r - t2 ( x , y ).value () ) <= 1.e-12 * ( 1 + abs ( r ) ) , 'Batched evaluation mismatch'
+
 
-        
 # =============================================================================
 if '__main__' == __name__ :
 
@@ -175,6 +217,7 @@ if '__main__' == __name__ :
     test_2D  () ## test interpolation for 2D-histograms
     test_3D  () ## test interpolation for 3D-histograms
     test_3D2 () ## test interpolation for 3D-histograms
+    test_tables () ## compare tables with interpolation 
     
 # =============================================================================
 # The END 
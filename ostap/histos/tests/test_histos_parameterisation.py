@@ -220,6 +220,30 @@ def test_cosine_sum() :
             f.draw('same')
             logger.info ( "%-25s : difference %s" %  ( h.title , diff1 ( f , h ) ) )
         
+# =============================================================================
+def test_param_lsq() :
+
+    logger = getLogger("test_param_lsq")
+
+    from ostap.core.core    import Ostap
+    from ostap.histos.param import param_many
+    
+    for basis in ( Ostap.Math.Bernstein    ( 6 , 0 , 1 ) ,
+                   Ostap.Math.LegendreSum  ( 6 , 0 , 1 ) ,
+                   Ostap.Math.ChebyshevSum ( 6 , 0 , 1 ) ) :
+        
+        with timing ( 'LSQ[6]/%s' % type ( basis ).__name__ , logger ) :
+            params  = [ h.param_lsq ( basis ) for h in histos ]
+            
+        with timing ( 'LSQ[6]/%s (many)' % type ( basis ).__name__ , logger ) :
+            many    = param_many ( histos , basis )
+            
+        for h , f , g in zip ( histos , params , many ) :
+            logger.info ( "%-25s : difference %s" %  ( h.title , diff1 ( f , h ) ) )
+            for x in ( 0.1 , 0.5 , 0.9 ) :
+                assert abs ( f ( x ) - g ( x ) ) <= 1.e-6 * max ( 1 , abs ( f ( x ) ) ) , \
+                       'param_lsq/param_many mismatch for %s' % h.title 
+            
 # =============================================================================
 if '__main__' == __name__ :
     
@@ -233,6 +257,7 @@ if '__main__' == __name__ :
     test_chebyshev_sum     ()
     test_fourier_sum       ()
     test_cosine_sum        ()
+    test_param_lsq         ()
     
 # =============================================================================
 ##                                                                      The END 
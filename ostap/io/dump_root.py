@@ -51,6 +51,15 @@
 #  new_db = old_db.clone ( 'new_dbase.db' ) 
 #  @endcode 
 #
+# The (large) pickle-based database can be converted into ROOT file (<code>RootShelf</code>)
+# with the pipelined converter: reader threads decompress and unpickle the items,
+# the single writer streams them into <code>TFile</code>
+# @code
+# import ostap.io.dump_file as DF
+# with zipshelve.open ( 'old_dbase.db' , 'r' ) as db : 
+#    DF.dump_dbase ( db , 'archive.root' , nthreads = 8 , compress = 505 ) 
+# @endcode 
+#
 # @author Vanya BELYAEV Ivan.Belyaev@cern.ch
 # @date   2019-10-04 
 # =============================================================================
@@ -99,6 +108,13 @@ or, more explicit:
 >>> old_db = DBASE.open   ( 'old_dbase.db' , 'r')
 >>> new_db = old_db.clone ( 'new_dbase.db' ) 
 
+The (large) pickle-based database can be converted into ROOT file (`RootShelf`)
+with the pipelined converter: reader threads decompress and unpickle the items,
+the single writer streams them into `TFile`
+
+>>> with zipshelve.open ( 'old_dbase.db' , 'r' ) as db : 
+...    DF.dump_dbase ( db , 'archive.root' , nthreads = 8 , compress = 505 ) 
+
 """
 # =============================================================================
 __author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
@@ -106,8 +122,9 @@ __date__    = "2015-07-31"
 __version__ = "$Revision$" 
 # =============================================================================
 __all__ = (
-    'dump_root' , ## dump  ROOT objects to the file 
-    'read_root' , ## real all ROOT objects from the file 
+    'dump_root'  , ## dump  ROOT objects to the file 
+    'read_root'  , ## real all ROOT objects from the file 
+    'dump_dbase' , ## convert (pickle-based) database into ROOT-file (RootShelf)
     )
 # =============================================================================
 import ROOT
@@ -155,6 +172,132 @@ def read_root ( fname ) :
             obj = f.Get( key )            
             logger.info ( 'Read key/object  %s/%s' % ( key , type  (  obj ) ) )
                    
+# =============================================================================
+## loader of items from the (pickle-based) database, used by reader threads 
+#  - for <code>CompressShelf</code>-based databases only the raw fetch is serialized,
+#    decompression (releases GIL) and unpickling are done in the reader threads
+#  - <code>SQLiteShelf</code> serializes the access itself
+#  - for other databases the whole read is serialized 
+def _loader_ ( db ) :
+    """Loader of items from the (pickle-based) database, used by reader threads 
+    - for `CompressShelf`-based databases only the raw fetch is serialized,
+      decompression (releases GIL) and unpickling are done in the reader threads
+    - `SQLiteShelf` serializes the access itself
+    - for other databases the whole read is serialized 
+    """
+    import threading
+    from   ostap.io.dbase import Item 
+    lock = threading.Lock ()
+    
+    from ostap.io.compress_shelve import CompressShelf
+    from ostap.io.sqliteshelve    import SQLiteShelf
+    
+    if isinstance ( db , CompressShelf ) :
+        def load ( key ) :
+            with lock : raw = db.dict [ key.encode ( db.keyencoding ) ] 
+            value = db.uncompress_item ( raw )
+            return value.payload if isinstance ( value , Item ) else value 
+        return load
+    elif isinstance ( db , SQLiteShelf ) :
+        return db.__getitem__ 
+    
+    def load ( key ) :
+        with lock : return db [ key ]
+    return load 
+
+# =============================================================================
+## Convert the (pickle-based) database into ROOT file (<code>RootShelf</code>)
+#  - readers decompress and unpickle items in the thread pool 
+#  - the single writer streams the objects into <code>TFile</code>
+#  - the number of items in flight is limited by <code>window</code>
+#    (bounded memory), items are written in the order of keys
+#  - the conversion can be resumed: the keys already present
+#    in the output file are skipped 
+#  @code
+#  import ostap.io.zipshelve as DBASE
+#  with DBASE.open ( 'results.zdb' , 'r' ) as db :
+#     dump_dbase ( db , 'results.root' , nthreads = 8 , compress = 505 ) 
+#  @endcode
+#  @param dbase    input database (or dict-like object)
+#  @param rfile    name of output ROOT file
+#  @param keys     keys to convert (all keys if empty)
+#  @param nthreads number of reader threads
+#  @param window   maximal number of items in flight
+#  @param compress ROOT compression settings for output file, e.g. 505 for ZSTD, 404 for LZ4 
+#  @param resume   skip the keys, already present in the output file?
+#  @param flush    flush output file each <code>flush</code> items 
+#  @return number of written items 
+def dump_dbase ( dbase           ,
+                 rfile           ,
+                 keys     = ()   ,
+                 nthreads = 4    ,
+                 window   = 0    , 
+                 compress = 505  ,
+                 resume   = True ,
+                 flush    = 1000 ) :
+    """Convert the (pickle-based) database into ROOT file (`RootShelf`)
+    - readers decompress and unpickle items in the thread pool 
+    - the single writer streams the objects into `TFile`
+    - the number of items in flight is limited by `window`
+      (bounded memory), items are written in the order of keys
+    - the conversion can be resumed: the keys already present
+      in the output file are skipped 
+    >>> import ostap.io.zipshelve as DBASE
+    >>> with DBASE.open ( 'results.zdb' , 'r' ) as db :
+    ...    dump_dbase ( db , 'results.root' , nthreads = 8 , compress = 505 ) 
+    """
+    import collections, os 
+    from   concurrent.futures import ThreadPoolExecutor
+    import ostap.io.rootshelve as rootshelve
+    from   ostap.utils.progress_bar import progress_bar 
+    
+    keys     = list ( keys ) if keys else list ( dbase.keys () ) 
+    nthreads = max ( 1 , nthreads )
+    window   = window if window and 0 < window else 4 * nthreads
+    flush    = max ( 1 , flush ) 
+    
+    resume   = resume and os.path.exists ( rfile ) 
+    mode     = 'c' if resume else 'n'
+    nwritten = 0 
+    with rootshelve.open ( rfile , mode ) as out :
+        
+        rf = out.dict 
+        if compress : rf.SetCompressionSettings ( compress ) 
+        
+        if resume :
+            present = set ( out.keys () )
+            nkeys   = len ( keys ) 
+            keys    = [ k for k in keys if not k in present ]
+            if len ( keys ) < nkeys :
+                logger.info ( 'dump_dbase: resume conversion, %d/%d keys are already in %s' % ( nkeys - len ( keys ) , nkeys , rfile ) )
+                
+        load    = _loader_ ( dbase )
+        pending = collections.deque ()  
+        with ThreadPoolExecutor ( max_workers = nthreads ) as pool :
+            
+            ikeys = iter ( keys )
+            for key in ikeys :
+                pending.append ( ( key , pool.submit ( load , key ) ) )
+                if window <= len ( pending ) : break
+                
+            for _ in progress_bar ( range ( len ( keys ) ) , silent = len ( keys ) < 100 ) :
+                
+                key , future = pending.popleft ()
+                value        = future.result () 
+                
+                ## keep the reading window full 
+                for k in ikeys :
+                    pending.append ( ( k , pool.submit ( load , k ) ) )
+                    break
+                
+                out [ key ] = value
+                del value 
+                nwritten += 1
+                if 0 == nwritten % flush : rf.Flush () 
+                
+    logger.info ( 'dump_dbase: %d items are written into %s' % ( nwritten , rfile ) )
+    return nwritten
+
 # =============================================================================
 if '__main__' == __name__ :
     
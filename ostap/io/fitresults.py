@@ -0,0 +1,400 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/io/fitresults.py
+#  Compact columnar storage for collections of fit results
+#
+#  Thousands of <code>RooFitResult</code> objects (or dictionaries of
+#  <code>VE</code>) stored in shelves are pickled one-by-one through
+#  ROOT streamers, that is slow and bulky. Here the parameter names are
+#  stored once, while values, errors and covariances are kept as typed
+#  arrays. Each result is materialized lazily, and the columns are
+#  available as numpy arrays without creation of per-result objects
+#
+#  @code
+#  results = FitResults ()
+#  for i in range ( 1000 ) :
+#      r , f = model.fitTo ( dataset[i] , silent = True )
+#      results.append ( r )
+#  db [ 'results' ] = results               ## any shelve
+#  ...
+#  results = db [ 'results' ]
+#  print ( results [ 10 ] [ 'S' ] )         ## VE for the 10th result
+#  signal  = results.values ( 'S' )         ## numpy array of values
+#  arrays  = results.arrays ()              ## all columns as numpy arrays
+#  @endcode
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Compact columnar storage for collections of fit results
+
+Thousands of `RooFitResult` objects (or dictionaries of `VE`) stored in
+shelves are pickled one-by-one through ROOT streamers, that is slow and bulky.
+Here the parameter names are stored once, while values, errors and
+covariances are kept as typed arrays. Each result is materialized lazily,
+and the columns are available as numpy arrays without creation of
+per-result objects
+
+>>> results = FitResults ()
+>>> for i in range ( 1000 ) :
+...     r , f = model.fitTo ( dataset[i] , silent = True )
+...     results.append ( r )
+>>> db [ 'results' ] = results               ## any shelve
+...
+>>> results = db [ 'results' ]
+>>> print ( results [ 10 ] [ 'S' ] )         ## VE for the 10th result
+>>> signal  = results.values ( 'S' )         ## numpy array of values
+>>> arrays  = results.arrays ()              ## all columns as numpy arrays
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__version__ = "$Revision$"
+__all__     = (
+    'FitResults' , ## compact columnar collection of fit results
+    'FitRecord'  , ## lazy view of the single fit result from the collection
+    )
+# =============================================================================
+import sys, math, array
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger( 'ostap.io.fitresults' )
+else                       : logger = getLogger( __name__ )
+# =============================================================================
+_nan_ = float ( 'nan' )
+# =============================================================================
+## @class FitRecord
+#  Lazy view of the single fit result from <code>FitResults</code>
+#  - nothing is copied until the parameters are requested
+#  @code
+#  results = ...
+#  r = results [ 5 ]
+#  print ( r [ 'S' ] , r.status , r.minNll )
+#  print ( r.cov ( 'S' , 'B' ) )
+#  @endcode
+class FitRecord(object) :
+    """Lazy view of the single fit result from `FitResults`
+    - nothing is copied until the parameters are requested
+    >>> results = ...
+    >>> r = results [ 5 ]
+    >>> print ( r [ 'S' ] , r.status , r.minNll )
+    >>> print ( r.cov ( 'S' , 'B' ) )
+    """
+    __slots__ = ( '__results' , '__index' )
+    def __init__ ( self , results , index ) :
+        self.__results = results
+        self.__index   = index
+
+    @property
+    def index ( self ) :
+        """``index'' : index of the result in the collection"""
+        return self.__index
+    @property
+    def status ( self ) :
+        """``status'' : status of the fit"""
+        return self.__results._status [ self.__index ]
+    @property
+    def covQual ( self ) :
+        """``covQual'' : quality of the covariance matrix"""
+        return self.__results._covqual [ self.__index ]
+    @property
+    def minNll ( self ) :
+        """``minNll'' : minimal value of the fit function"""
+        return self.__results._minnll [ self.__index ]
+    @property
+    def edm ( self ) :
+        """``edm'' : estimated distance to minimum"""
+        return self.__results._edm [ self.__index ]
+
+    def keys ( self ) :
+        """Parameter names"""
+        return self.__results.names
+
+    def __contains__ ( self , name ) :
+        return name in self.__results.names
+
+    def __getitem__ ( self , name ) :
+        """Get the parameter as VE
+        >>> r = ...
+        >>> s = r [ 'S' ]
+        """
+        return self.__results.ve ( self.__index , name )
+
+    def __iter__ ( self ) :
+        return iter ( self.__results.names )
+
+    ## get all parameters as dictionary { name : VE }
+    def params ( self ) :
+        """Get all parameters as dictionary { name : VE }"""
+        return dict ( ( n , self [ n ] ) for n in self.__results.names )
+
+    ## get the covariance for two parameters
+    def cov ( self , name1 , name2 ) :
+        """Get the covariance for two parameters
+        >>> r = ...
+        >>> c = r.cov ( 'S' , 'B' )
+        """
+        return self.__results.cov ( self.__index , name1 , name2 )
+
+    ## get the correlation coefficient for two parameters
+    def corr ( self , name1 , name2 ) :
+        """Get the correlation coefficient for two parameters"""
+        c  = self.cov ( name1 , name2 )
+        s1 = self.cov ( name1 , name1 )
+        s2 = self.cov ( name2 , name2 )
+        return c / math.sqrt ( s1 * s2 ) if 0 < s1 and 0 < s2 else _nan_
+
+    def __len__  ( self ) : return len ( self.__results.names )
+    def __repr__ ( self ) :
+        return 'FitRecord(#%d,status=%s,%s)' % ( self.__index , self.status , self.params () )
+    __str__ = __repr__
+
+# =============================================================================
+## @class FitResults
+#  Compact columnar collection of fit results
+#  - the parameter names are stored once
+#  - values, errors, covariances, status, minNll, edm and quality
+#    of the covariance matrix are stored as typed arrays
+#  - pickling dumps the raw buffers, therefore it is compact and fast,
+#    and suitable for all shelves
+#  - the columns are available as numpy arrays (views, no copy)
+#  @code
+#  results = FitResults ()
+#  results.append ( r1 )                   ## RooFitResult
+#  results.append ( { 'S' : VE(1,1) } )    ## ... or dictionary of VE
+#  @endcode
+#  @attention All results must have the same (or a subset of) parameters,
+#             missing parameters are stored as NaN
+class FitResults(object) :
+    """Compact columnar collection of fit results
+    - the parameter names are stored once
+    - values, errors, covariances, status, minNll, edm and quality
+      of the covariance matrix are stored as typed arrays
+    - pickling dumps the raw buffers, therefore it is compact and fast,
+      and suitable for all shelves
+    - the columns are available as numpy arrays (views, no copy)
+
+    >>> results = FitResults ()
+    >>> results.append ( r1 )                   ## RooFitResult
+    >>> results.append ( { 'S' : VE(1,1) } )    ## ... or dictionary of VE
+
+    - All results must have the same (or a subset of) parameters,
+      missing parameters are stored as NaN
+    """
+    def __init__ ( self , names = () , covariance = True ) :
+
+        self.__names      = tuple ( names )
+        self.__index      = dict  ( ( n , i ) for i , n in enumerate ( self.__names ) )
+        self.__covariance = True if covariance else False
+
+        self._values      = array.array ( 'd' )
+        self._errors      = array.array ( 'd' )
+        self._covs        = array.array ( 'd' )
+        self._status      = array.array ( 'i' )
+        self._covqual     = array.array ( 'i' )
+        self._minnll      = array.array ( 'd' )
+        self._edm         = array.array ( 'd' )
+
+    @property
+    def names ( self ) :
+        """``names'' : names of the parameters"""
+        return self.__names
+    @property
+    def covariance ( self ) :
+        """``covariance'' : are full covariance matrices stored?"""
+        return self.__covariance
+    @property
+    def npars ( self ) :
+        """``npars'' : number of parameters"""
+        return len ( self.__names )
+
+    def __len__ ( self ) :
+        return len ( self._status )
+
+    def __iter__ ( self ) :
+        for i in range ( len ( self ) ) : yield FitRecord ( self , i )
+
+    def __getitem__ ( self , index ) :
+        """Get the lazy view of the fit result
+        >>> results = ...
+        >>> r = results [ 10 ]
+        """
+        n = len ( self )
+        if index < 0 : index += n
+        if not 0 <= index < n : raise IndexError ( "Invalid index %s" % index )
+        return FitRecord ( self , index )
+
+    # =========================================================================
+    ## add the fit result: RooFitResult or dictionary { name : VE/float }
+    def append ( self , result ) :
+        """Add the fit result: `RooFitResult` or dictionary { name : VE/float }
+        """
+        status = 0
+        qual   = -1
+        minnll = _nan_
+        edm    = _nan_
+        cov    = None
+
+        if hasattr ( result , 'floatParsFinal' ) :
+            ## RooFitResult
+            pars   = result.floatParsFinal ()
+            names  = [ p.GetName  () for p in pars ]
+            values = [ p.getVal   () for p in pars ]
+            errors = [ p.getError () for p in pars ]
+            status = result.status  ()
+            qual   = result.covQual ()
+            minnll = result.minNll  ()
+            edm    = result.edm     ()
+            if self.__covariance :
+                cm  = result.covarianceMatrix ()
+                n   = len ( names )
+                cov = [ [ cm ( i , j ) for j in range ( n ) ] for i in range ( n ) ]
+        else :
+            ## dictionary { name : VE/float }
+            names , values , errors = [] , [] , []
+            for k , v in result.items () :
+                names .append ( k )
+                if hasattr ( v , 'cov2' ) :
+                    values.append ( v.value () )
+                    errors.append ( v.error () )
+                else :
+                    values.append ( float ( v ) )
+                    errors.append ( 0.0 )
+
+        ## the first result defines the parameters
+        if not self.__names :
+            self.__names = tuple ( names )
+            self.__index = dict  ( ( n , i ) for i , n in enumerate ( self.__names ) )
+
+        extra = [ n for n in names if not n in self.__index ]
+        assert not extra , "FitResults.append: unknown parameters %s" % extra
+
+        N   = self.npars
+        pos = [ self.__index [ n ] for n in names ]
+
+        vals = [ _nan_ ] * N
+        errs = [ _nan_ ] * N
+        for k , i in enumerate ( pos ) :
+            vals [ i ] = values [ k ]
+            errs [ i ] = errors [ k ]
+        self._values.extend ( vals )
+        self._errors.extend ( errs )
+
+        if self.__covariance :
+            cc = [ _nan_ ] * ( N * N )
+            for k , i in enumerate ( pos ) :
+                for m , j in enumerate ( pos ) :
+                    if   cov is not None : cc [ i * N + j ] = cov [ k ] [ m ]
+                    elif i == j          : cc [ i * N + j ] = errors [ k ] ** 2
+                    else                 : cc [ i * N + j ] = 0.0
+            self._covs.extend ( cc )
+
+        self._status .append ( status )
+        self._covqual.append ( qual   )
+        self._minnll .append ( minnll )
+        self._edm    .append ( edm    )
+
+    # =========================================================================
+    ## add many fit results
+    def extend ( self , results ) :
+        """Add many fit results"""
+        for r in results : self.append ( r )
+
+    # =========================================================================
+    ## get the parameter as VE
+    def ve ( self , index , name ) :
+        """Get the parameter as VE"""
+        from ostap.math.ve import VE
+        N = self.npars
+        i = self.__index [ name ]
+        v = self._values [ index * N + i ]
+        e = self._errors [ index * N + i ]
+        return VE ( v , e * e )
+
+    # =========================================================================
+    ## get the covariance of two parameters
+    def cov ( self , index , name1 , name2 ) :
+        """Get the covariance of two parameters"""
+        N = self.npars
+        i = self.__index [ name1 ]
+        j = self.__index [ name2 ]
+        if self.__covariance : return self._covs [ ( index * N + i ) * N + j ]
+        if i != j            : return 0.0
+        e = self._errors [ index * N + i ]
+        return e * e
+
+    # =========================================================================
+    ## get all columns as numpy arrays (views, no copy)
+    def arrays ( self ) :
+        """Get all columns as numpy arrays (views, no copy)
+        - values       : shape ( N , npars )
+        - errors       : shape ( N , npars )
+        - covariances  : shape ( N , npars , npars ) (if stored)
+        - status, covQual, minNll, edm : shape ( N , )
+        """
+        import numpy
+        n , N = len ( self ) , self.npars
+        result = {
+            'values'  : numpy.frombuffer ( self._values  , dtype = numpy.float64 ).reshape ( n , N ) ,
+            'errors'  : numpy.frombuffer ( self._errors  , dtype = numpy.float64 ).reshape ( n , N ) ,
+            'status'  : numpy.frombuffer ( self._status  , dtype = numpy.intc    ) ,
+            'covQual' : numpy.frombuffer ( self._covqual , dtype = numpy.intc    ) ,
+            'minNll'  : numpy.frombuffer ( self._minnll  , dtype = numpy.float64 ) ,
+            'edm'     : numpy.frombuffer ( self._edm     , dtype = numpy.float64 ) ,
+            }
+        if self.__covariance :
+            result [ 'covariances' ] = numpy.frombuffer ( self._covs , dtype = numpy.float64 ).reshape ( n , N , N )
+        return result
+
+    # =========================================================================
+    ## get the values of the parameter as numpy array (view, no copy)
+    def values ( self , name ) :
+        """Get the values of the parameter as numpy array (view, no copy)"""
+        return self.arrays () [ 'values' ] [ : , self.__index [ name ] ]
+
+    # =========================================================================
+    ## get the errors of the parameter as numpy array (view, no copy)
+    def errors ( self , name ) :
+        """Get the errors of the parameter as numpy array (view, no copy)"""
+        return self.arrays () [ 'errors' ] [ : , self.__index [ name ] ]
+
+    # =========================================================================
+    ## reduce: raw buffers of typed arrays
+    def __reduce__ ( self ) :
+        """Reduce: raw buffers of typed arrays"""
+        return _fitresults_factory_ , ( self.__names                ,
+                                        self.__covariance           ,
+                                        sys.byteorder               ,
+                                        self._values .tobytes ()    ,
+                                        self._errors .tobytes ()    ,
+                                        self._covs   .tobytes ()    ,
+                                        self._status .tobytes ()    ,
+                                        self._covqual.tobytes ()    ,
+                                        self._minnll .tobytes ()    ,
+                                        self._edm    .tobytes ()    )
+
+    def __repr__ ( self ) :
+        return 'FitResults(#%d,%s)' % ( len ( self ) , ','.join ( self.__names ) )
+    __str__ = __repr__
+
+# =============================================================================
+## factory for unpickling of <code>FitResults</code>
+def _fitresults_factory_ ( names , covariance , byteorder , *buffers ) :
+    """Factory for unpickling of `FitResults`"""
+    result = FitResults ( names , covariance )
+    arrays = ( result._values , result._errors  , result._covs ,
+               result._status , result._covqual , result._minnll , result._edm )
+    for a , b in zip ( arrays , buffers ) :
+        a.frombytes ( b )
+        if byteorder != sys.byteorder : a.byteswap ()
+    return result
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -80,7 +80,7 @@ else                       : logger = getLogger( __name__ )
 logger.debug ( 'Some useful decorations for TFile objects')
 # ==============================================================================
 ## context manager to preserve current directory (rather confusing stuff in ROOT)
-from ostap.core.core import ROOTCWD, valid_pointer 
+from ostap.core.core import ROOTCWD, valid_pointer, Ostap 
 # ===============================================================================
 ## write the (T)object to ROOT-file/directory
 #  @code
@@ -340,40 +340,113 @@ def _rd_delitem_ ( rdir , name , cycle=';*') :
             raise KeyError("TDirectory, can't delete %s" % dirname ) 
         return rdir.Delete( dirname + cycle ) 
 
-# =============================================================================a
+# =============================================================================
+## the cache of key indices for the read-only files
+#  @see Ostap::Utils::KeyIndex
+_key_indices     = {}
+_max_key_indices = 16
+# =============================================================================
+## get the (cached) index of keys for ROOT file/directory
+#  - the index is built by one traversal of the key lists,
+#    no objects are read 
+#  - for read-only files the index is cached
+#  @code
+#  index = rfile.key_index()
+#  for i in range ( len ( index ) ) :
+#     e = index.entry ( i ) 
+#     print ( e.path , e.classname , e.cycle , e.nbytes ) 
+#  @endcode 
+#  @see Ostap::Utils::KeyIndex
+def _rd_key_index_ ( rdir , refresh = False ) :
+    """Get the (cached) index of keys for ROOT file/directory
+    - the index is built by one traversal of the key lists, no objects are read 
+    - for read-only files the index is cached
+    >>> index = rfile.key_index()
+    >>> for i in range ( len ( index ) ) :
+    ...    e = index.entry ( i ) 
+    ...    print ( e.path , e.classname , e.cycle , e.nbytes ) 
+    - see Ostap::Utils::KeyIndex
+    """
+    if not rdir : raise IOError ( "TDirectory is invalid" )
+    ##
+    tag   = None
+    tfile = rdir.GetFile()
+    if tfile and not rdir.IsWritable() :
+        tag = rdir.GetPath() , tfile.GetUUID().AsString() , tfile.GetEND()
+        index = _key_indices.get ( tag , None )
+        if index and not refresh : return index 
+    ##
+    with ROOTCWD() : 
+        index = Ostap.Utils.KeyIndex ( rdir , True )
+    ##
+    if tag :
+        while _max_key_indices <= len ( _key_indices ) :
+            _key_indices.pop ( next ( iter ( _key_indices ) ) ) 
+        _key_indices [ tag ] = index 
+    return index
+
+# =============================================================================
+## get the name of ROOT class for python type
+#  @return the class name or empty string 
+def _class_name_ ( typ ) :
+    """Get the name of ROOT class for python type
+    """
+    if typ is None : return ''
+    name = getattr ( typ , '__cpp_name__' , getattr ( typ , '__name__' , '' ) )
+    tcl  = ROOT.TClass.GetClass ( name ) if name else None 
+    return tcl.GetName() if tcl else ''
+
+# =============================================================================
+## select the paths from the index of keys
+def _index_paths_ ( index , pattern = '' , base = '' , recursive = True , no_dir = True ) :
+    """Select the paths from the index of keys
+    """
+    paths = index.paths ( pattern , base , no_dir )
+    return [ str ( p ) for p in paths if recursive or not '/' in p ]
+
+# =============================================================================
+## find the keys in ROOT file/directory using the (cached) index of keys:
+#  - no objects are read 
+#  @code
+#  keys = rfile.find_keys ( '*pt*' )                ## shell-style pattern 
+#  keys = rfile.find_keys ( 'A/h*' , ROOT.TH1 )     ## pattern and type 
+#  keys = rfile.find_keys ( typ = ROOT.TTree )      ## only type 
+#  @endcode
+#  @see Ostap::Utils::KeyIndex
+def _rd_find_keys_ ( rdir , pattern = '' , typ = None , recursive = True , no_dir = True ) :
+    """Find the keys in ROOT file/directory using the (cached) index of keys:
+    - no objects are read 
+    >>> keys = rfile.find_keys ( '*pt*' )                ## shell-style pattern 
+    >>> keys = rfile.find_keys ( 'A/h*' , ROOT.TH1 )     ## pattern and type 
+    >>> keys = rfile.find_keys ( typ = ROOT.TTree )      ## only type 
+    - see Ostap::Utils::KeyIndex
+    """
+    if not rdir : return []
+    base = _class_name_ ( typ )
+    if typ is not None and not base :
+        ## not a ROOT class: check the objects 
+        return [ k for k in _rd_find_keys_ ( rdir , pattern , None , recursive , no_dir )
+                 if isinstance ( _rd_getitem_ ( rdir , k ) , typ ) ]
+    return _index_paths_ ( _rd_key_index_ ( rdir ) , pattern , base , recursive , no_dir )
+
+# =============================================================================
 ## get all keys from ROOT file/directory
 #  @code
 #  keys = rfile.keys()
 #  keys = rfile.keys( recursive = False )
 #  keys = rfile.keys( no_dir    = False )
-#  @endcode 
+#  @endcode
+#  The keys are taken from the (cached) index of keys
+#  @see Ostap::Utils::KeyIndex
 #  @author Vanya BELYAEV Ivan.Belyaev@iep.ru
 #  @date 2015-07-30
 def _rd_keys_ ( rdir , recursive = True , no_dir = True ) :
     """Get all keys from ROOT file/directory
     >>> keys = rfile.keys() 
+    - the keys are taken from the (cached) index of keys
     """
-    _res = []
-    if not rdir : return _res 
-    ##
-    with ROOTCWD() :
-        ##
-        rdir.cd() 
-        _lst = rdir.GetListOfKeys()
-        if not _lst :  return _res
-        
-        for i in _lst :
-            inam = i.GetName()
-
-            idir = rdir.GetDirectory ( inam )            
-            if not idir or not no_dir : _res.append ( inam )
-            
-            if recursive and idir and not idir is rdir :
-                ikeys = _rd_keys_ ( idir , recursive , no_dir )
-                for k in ikeys : _res.append ( inam + '/' + k )
-                
-        return _res
-
+    if not rdir : return [] 
+    return _index_paths_ ( _rd_key_index_ ( rdir ) , '' , '' , recursive , no_dir )
     
 # =============================================================================a
 ## Iterate over the content of ROOT file/directory 
@@ -395,10 +468,17 @@ def _rd_iteritems_ ( rdir , fun = lambda k,t,o : True , recursive = True , no_di
     >>> for key,obj  in rfile.iteritems()           : print key , obj
     >>> for key,hist in rfile.iteritems( ROOT.TH1 ) : print key , hist
     >>> for key,obj  in rfile.iteritems( lambda name,tkey,obj : name[0]=='M' ) : print key,obj
+    - for the type the keys are selected from the (cached) index of keys,
+      and only the selected objects are read
     """
     ##
     if isinstance ( fun , type ) and issubclass ( fun , ( ROOT.TObject, cpp.TObject) ) : 
         tobj = fun 
+        if _class_name_ ( tobj ) :
+            for key in _rd_find_keys_ ( rdir , '' , tobj , recursive , no_dir ) :
+                obj = _rd_getitem_ ( rdir , key )
+                if isinstance ( obj , tobj ) : yield key , obj
+            return 
         fun  = lambda k,t,o : isinstance ( o , tobj )
     ##
     with ROOTCWD() :
@@ -414,7 +494,7 @@ def _rd_iteritems_ ( rdir , fun = lambda k,t,o : True , recursive = True , no_di
                     if fun ( inam , i , obj ) : yield inam , obj
                 if recursive and idir and not idir is rdir :
                     for k, o in _rd_iteritems_ ( idir , fun , recursive , no_dir ) :
-                        yield k , o
+                        yield inam + '/' + k , o
 
 # =============================================================================a
 ## Iterate over the keys in ROOT file/directory 
@@ -425,29 +505,18 @@ def _rd_iteritems_ ( rdir , fun = lambda k,t,o : True , recursive = True , no_di
 #  @code
 #  for k in rfile.iterkeys ( ROOT.TH1 ) : print k
 #  @endcode 
+#  The keys are taken from the (cached) index of keys
+#  @see Ostap::Utils::KeyIndex
 #  @author Vanya BELYAEV Ivan.Belyaev@iep.ru
 #  @date 2015-07-30
 def _rd_iterkeys_ ( rdir , typ = None , recursive = True , no_dir = True ) :
     """Iterate over the keys in ROOT file/directory 
     >>> for key,obj  in rfile.iteritems()           : print key , obj
     >>> for key,hist in rfile.iteritems( ROOT.TH1 ) : print key , hist
+    - the keys are taken from the (cached) index of keys
     """
     ##
-    with ROOTCWD() :
-        ##
-        rdir.cd() 
-        _lst = rdir.GetListOfKeys()
-        if _lst : 
-            for i in _lst :
-                inam   = i.GetName()
-                idir   = rdir.GetDirectory ( inam ) 
-                if not idir or not no_dir : 
-                    if typ is None  or isinstance ( rdir.Get ( inam ) , typ ) : yield inam 
-                if recursive and idir  and not idir is rdir :
-                    for k in _rd_iterkeys_ ( idir , typ , recursive , no_dir ) :
-                        yield k
-
-
+    for key in _rd_find_keys_ ( rdir , '' , typ , recursive , no_dir ) : yield key 
 
 # =============================================================================a
 ## iterator oiver keyname/keys pairs  from ROOT file/directory
@@ -791,6 +860,8 @@ ROOT.TDirectory.itervalues     = _rd_itervalues_
 ROOT.TDirectory.ikeyskeys      = _rd_ikeyskeys_
 ROOT.TDirectory.get_key        = _rd_key_
 ROOT.TDirectory.get_key_object = _rd_key_object_
+ROOT.TDirectory.key_index      = _rd_key_index_
+ROOT.TDirectory.find_keys      = _rd_find_keys_
 
 # =============================================================================
 ## some extra stuff 
@@ -111,9 +111,12 @@ __all__ = (
     'RootOnlyShelf' , ## "data base" for ROOT-only objects
     'open'          , ## helper function to hide the actual DB
     'tmpdb'         , ## helper function to create TEMPORARY  RootShelve database 
+    'RootMultiShelf', ## read-only union of the parts written by several writers 
+    'open_part'     , ## open the part of multi-writer database for the given writer 
+    'open_multi'    , ## open multi-writer database for reading 
     )
 # =============================================================================
-import ROOT, shelve, zlib, os 
+import ROOT, shelve, zlib, os, sys 
 import ostap.io.root_file
 from   sys import version_info as python_version 
 # =============================================================================
@@ -136,6 +139,16 @@ logger.debug ( "Simple generic ROOT-based shelve-like-database" )
 # =============================================================================
 PROTOCOL = 2
 # =============================================================================
+## the title prefix for BLOBs with numpy arrays 
+_NUMPY_  = 'numpy:'
+# =============================================================================
+## decode dtype and shape of numpy array from the title of BLOB 
+def _array_info_ ( title ) :
+    """Decode dtype and shape of numpy array from the title of BLOB"""
+    dtype , shape = title [ len ( _NUMPY_ ) : ].split ( ':' )
+    shape = tuple ( int ( i ) for i in shape.split ( ',' ) if i )
+    return dtype , shape 
+# =============================================================================
 ## @class RootOnlyShelf
 #  Plain vanilla DBASE for ROOT-object (only)
 #  essentially it is nothing more than just shelve-like interface for ROOT-files
@@ -313,6 +326,9 @@ if python_version.major > 2 :
 #  The actual class for ROOT-based shelve-like data base
 #  it implement shelve-interface with underlying ROOT-file as storage
 #  - ROOT-objects are stored directly in the ROOT-file,
+#  - numpy arrays are stored via Ostap::BLOB directly, without pickling and
+#    intermediate copies, optionally compressed with ROOT compression setting
+#    <code>compress_arrays</code>, e.g. 404 for LZ4 or 505 for ZSTD 
 #  - other objects are pickled and stored via ROOT.TObjString
 #  @code
 #  db = RootShelf( 'mydb.root' , 'c' )
@@ -326,6 +342,9 @@ class RootShelf(RootOnlyShelf):
     """ The actual class for ROOT-based shelve-like data base
     it implement shelve-interface with underlyinog ROOT-fiel storage
     - ROOT-object are store ddirectly in the ROOT-file,
+    - numpy arrays are stored via Ostap::BLOB directly, without pickling and
+      intermediate copies, optionally compressed with ROOT compression setting
+      `compress_arrays`, e.g. 404 for LZ4 or 505 for ZSTD 
     - other objects are pickled and stored in ROOT.TObjString
     
     >>> db = RootShelf( 'mydb.root' , 'c' )
@@ -338,11 +357,13 @@ class RootShelf(RootOnlyShelf):
                   writeback = False                   ,
                   protocol  = PROTOCOL                , ## pickling protocol
                   compress  = zlib.Z_BEST_COMPRESSION , ## compression level 
-                  args      = ()       ):
+                  args      = ()                      ,
+                  compress_arrays = 0                 ) : ## ROOT compression setting for numpy arrays 
         RootOnlyShelf.__init__ ( self , filename , mode , writeback , args = args )
-        self.__protocol      = protocol
-        self.__compresslevel = compress
-        self.__sizes         = {}
+        self.__protocol        = protocol
+        self.__compresslevel   = compress
+        self.__compress_arrays = compress_arrays 
+        self.__sizes           = {}
         
     # =========================================================================
     ## clone the database into new one
@@ -358,7 +379,8 @@ class RootShelf(RootOnlyShelf):
         new_db = RootShelf ( new_name                         ,
                              mode        =  'c'               ,
                              protocol    = self.protocol      ,
-                             compress    = self.compresslevel )
+                             compress    = self.compresslevel ,
+                             compress_arrays = self.compress_arrays )
         
         ## copy the content
         if keys :
@@ -379,6 +401,11 @@ class RootShelf(RootOnlyShelf):
         """``compresslevel'' : zlib compression level
         """
         return self.__compresslevel
+    @property
+    def compress_arrays ( self ) :
+        """``compress_arrays'' : ROOT compression setting for numpy arrays, e.g. 404 for LZ4
+        """
+        return self.__compress_arrays
     
     # =============================================================================
     ##  get object (unpickle if needed)  from dbase
@@ -402,7 +429,14 @@ class RootShelf(RootOnlyShelf):
             
             ## blob ?
             from  ostap.core.core import  Ostap
-            if isinstance ( value , Ostap.BLOB ) :
+            if isinstance ( value , Ostap.BLOB ) and value.GetTitle().startswith ( _NUMPY_ ) :
+                ## numpy array: uncompress directly into the array 
+                dtype , shape = _array_info_ ( value.GetTitle() )
+                import numpy 
+                array = numpy.empty ( shape , dtype = dtype )
+                Ostap.blob_to_buffer ( value , array )
+                value = array 
+            elif isinstance ( value , Ostap.BLOB ) :
                 ## unpack it!
                 z     = Ostap.blob_to_bytes ( value )
                 u     = zlib.decompress ( z )
@@ -429,8 +463,21 @@ class RootShelf(RootOnlyShelf):
         if self.writeback:
             self.cache [ key ] = value
             
+        numpy = sys.modules.get ( 'numpy' , None )
+        
+        ## numpy array? put it into Ostap.BLOB directly 
+        if numpy and isinstance ( value , numpy.ndarray ) and \
+           not value.dtype.hasobject and not value.dtype.fields :
+            from  ostap.core.core import  Ostap
+            value  = numpy.ascontiguousarray ( value ) 
+            title  = '%s%s:%s' % ( _NUMPY_ , value.dtype.str , ','.join ( str ( i ) for i in value.shape ) )
+            blob   = Ostap.BLOB ( key , title ) 
+            status = Ostap.blob_from_buffer ( blob , value , self.compress_arrays )
+            self.__sizes [ key ] = blob.size () 
+            value  = blob
+            
         ## not TObject? pickle it and convert to Ostap.BLOB
-        if not isinstance  ( value , ROOT.TObject ) :
+        elif not isinstance  ( value , ROOT.TObject ) :
             ## (1) pickle it 
             f = BytesIO    ( )
             p = Pickler    ( f , self.protocol )
@@ -611,6 +658,149 @@ def tmpdb ( protocol  = HIGHEST_PROTOCOL           ,
                           keep     = keep     , *args ) 
 
 
+# =============================================================================
+## the name of the part-file for the given writer of the multi-writer database
+#  @code
+#  name = part_name ( 'mydb.root' )  ## mydb.root.parts/<host>-<pid>.root
+#  @endcode 
+def part_name ( dbname , tag = '' ) :
+    """The name of the part-file for the given writer of the multi-writer database
+    >>> name = part_name ( 'mydb.root' )  ## mydb.root.parts/<host>-<pid>.root
+    """
+    if not tag :
+        import socket 
+        tag = '%s-%d' % ( socket.gethostname () , os.getpid () )
+    return os.path.join ( dbname + '.parts' , '%s.root' % tag )
+
+# =============================================================================
+## Open the part of the multi-writer database for the given writer
+#  Several writers (e.g. parallel jobs) can write into the same database
+#  simultaneously: each writer writes into its own part-file,
+#  and no merge is needed afterwards
+#  @code
+#  with open_part ( 'mydb.root' ) as db :    ## e.g. in the parallel job 
+#      db [ 'result-%d' % jobid ] = result
+#  ...
+#  with open_multi ( 'mydb.root' ) as db :   ## union of all parts 
+#      for key in db : print ( key , db [ key ] ) 
+#  @endcode
+#  @param dbname the name of the database
+#  @param tag    the unique tag of the writer, <code><host>-<pid></code> by default 
+#  @see RootMultiShelf 
+def open_part ( dbname                              ,
+                tag       = ''                      ,
+                protocol  = PROTOCOL                ,
+                compress  = zlib.Z_BEST_COMPRESSION ) :
+    """Open the part of the multi-writer database for the given writer
+    Several writers (e.g. parallel jobs) can write into the same database
+    simultaneously: each writer writes into its own part-file,
+    and no merge is needed afterwards
+    >>> with open_part ( 'mydb.root' ) as db :    ## e.g. in the parallel job 
+    ...     db [ 'result-%d' % jobid ] = result
+    >>> with open_multi ( 'mydb.root' ) as db :   ## union of all parts 
+    ...     for key in db : print ( key , db [ key ] ) 
+    - see RootMultiShelf 
+    """
+    fname     = part_name ( dbname , tag )
+    directory = os.path.dirname ( fname )
+    try :
+        os.makedirs ( directory )
+    except OSError :
+        if not os.path.isdir ( directory ) : raise   
+    return RootShelf ( fname , 'c' , protocol = protocol , compress = compress )
+
+# =============================================================================
+## @class RootMultiShelf
+#  Read-only union of the parts of multi-writer database
+#  - the main file (if exists) and all parts from <code>dbname.parts</code> directory
+#  - the index <code>key -> part</code> is built from the lists of keys only,
+#    the objects are read from the corresponding part at the first request
+#  - for duplicated keys the object from the most recent part is used
+#  @code
+#  with RootMultiShelf ( 'mydb.root' ) as db :
+#      for key in db : print ( key , db [ key ] ) 
+#  @endcode
+#  @see open_part 
+class RootMultiShelf(object) :
+    """Read-only union of the parts of multi-writer database
+    - the main file (if exists) and all parts from `dbname.parts` directory
+    - the index `key -> part` is built from the lists of keys only,
+    the objects are read from the corresponding part at the first request
+    - for duplicated keys the object from the most recent part is used
+    >>> with RootMultiShelf ( 'mydb.root' ) as db :
+    ...    for key in db : print ( key , db [ key ] ) 
+    - see open_part 
+    """
+    def __init__ ( self , dbname ) :
+
+        import glob
+        self.__dbname = dbname 
+        files = sorted ( glob.glob ( os.path.join ( dbname + '.parts' , '*.root' ) ) ,
+                         key = os.path.getmtime )
+        if os.path.isfile ( dbname ) : files.insert ( 0 , dbname )
+
+        self.__parts = tuple ( RootShelf ( f , 'r' ) for f in files )
+        self.__index = {}
+        for part in self.__parts :
+            for key in part.keys () : self.__index [ key ] = part
+
+    @property
+    def dbname ( self ) :
+        """``dbname'' : the nominal name of the database"""
+        return self.__dbname
+
+    @property
+    def parts  ( self ) :
+        """``parts'' : the parts of the database"""
+        return self.__parts
+
+    @property
+    def files  ( self ) :
+        """``files'' : the files of the database"""
+        return tuple ( p.filename for p in self.__parts )
+    
+    def keys         ( self )       : return self.__index.keys ()
+    def __iter__     ( self )       : return iter ( self.__index )
+    def __len__      ( self )       : return len  ( self.__index )
+    def __contains__ ( self , key ) : return key in self.__index
+    def __getitem__  ( self , key ) : return self.__index [ key ] [ key ]
+    def get          ( self , key , default = None ) :
+        """Get the item or the default value"""
+        return self [ key ] if key in self.__index else default 
+
+    ## the part that contains the key 
+    def part ( self , key ) :
+        """The part that contains the key"""
+        return self.__index [ key ] 
+    
+    ## close all parts 
+    def close ( self ) :
+        """Close all parts"""
+        for part in self.__parts : part.close ()
+        self.__parts = ()
+        self.__index = {}
+        
+    def __enter__   ( self       ) : return self 
+    def __exit__    ( self , *_  ) : self.close ()
+
+    def __repr__ ( self ) :
+        return "RootMultiShelf('%s'): %d object(s) in %d part(s)" % ( self.dbname , len ( self ) , len ( self.parts ) )
+    __str__ = __repr__
+
+# =============================================================================
+## open multi-writer database for reading: the union of all parts
+#  @code
+#  with open_multi ( 'mydb.root' ) as db :
+#      for key in db : print ( key , db [ key ] ) 
+#  @endcode
+#  @see RootMultiShelf 
+def open_multi ( dbname ) :
+    """Open multi-writer database for reading: the union of all parts
+    >>> with open_multi ( 'mydb.root' ) as db :
+    ...    for key in db : print ( key , db [ key ] ) 
+    - see RootMultiShelf 
+    """
+    return RootMultiShelf ( dbname ) 
 
 # =============================================================================
 if '__main__' == __name__ :
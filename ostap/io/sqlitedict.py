@@ -29,6 +29,14 @@ Pickle is used internally to serialize the values. Keys are strings.
 If you don't use autocommit (default is no autocommit for performance), then
 don't forget to call `mydict.commit()` when done with a transaction.
 
+For many small writes use the batch API: the writes inside the transaction
+are buffered and inserted with `executemany` in large chunks, and committed
+once at the end of the transaction::
+
+>>> with mydict.transaction () :
+...     for i in range ( 100000 ) : mydict [ 'key%d' % i ] = i
+>>> mydict.update_many ( ( 'key%d' % i , i ) for i in range ( 100000 ) )
+
 """
 # =============================================================================
 __all__ = (
@@ -43,6 +51,7 @@ import tempfile
 import random
 import logging
 import traceback
+import time
 
 from threading import Thread
 
@@ -203,7 +212,8 @@ class SqliteDict(DictClass):
                  ## tablename='unnamed',
                  tablename='ostap',
                  flag='c',
-                 autocommit=False, journal_mode="DELETE", encode=encode, decode=decode, timeout = 30 ):
+                 autocommit=False, journal_mode="DELETE", encode=encode, decode=decode, timeout = 30 ,
+                 batch = 0 ):
         """
         Initialize a thread-safe sqlite-backed dictionary. The dictionary will
         be a table `tablename` in database file `filename`. A single file (=database)
@@ -219,6 +229,14 @@ class SqliteDict(DictClass):
         Set `journal_mode` to 'OFF' if you're experiencing sqlite I/O problems
         or if you need performance and don't care about crash-consistency.
 
+        Set `journal_mode` to 'WAL' for several concurrent writers (e.g. parallel jobs):
+        readers do not block writers, and the writes that find the database
+        locked/busy are retried with exponential backoff up to `timeout` seconds.
+
+        If `batch` is positive, the writes are grouped into transactions of
+        (at most) `batch` operations, that are committed automatically
+        (and at `self.close()`). 
+
         The `flag` parameter. Exactly one of:
           'c': default mode, open for read/write, creating the db/table if necessary.
           'w': open for r/w, but drop `tablename` contents first (start with empty table)
@@ -266,6 +284,10 @@ class SqliteDict(DictClass):
         self.encode = encode
         self.decode = decode
         self.timeout = timeout 
+        self.batch = batch if ( batch and 0 < batch and not autocommit ) else 0 
+        ## the buffered writes of the current transaction: list of (key,blob) or None 
+        self._pending      = None
+        self._pending_size = 0 
 
 
         with Connect ( self.filename , self.flag , self.timeout ) :
@@ -283,7 +305,8 @@ class SqliteDict(DictClass):
         return SqliteMultithread(self.filename, self.flag ,
                                  autocommit=self.autocommit,
                                  journal_mode=self.journal_mode,
-                                 timeout = self.timeout )
+                                 timeout = self.timeout ,
+                                 batch   = self.batch   )
 
     def __enter__(self):
         if not hasattr(self, 'conn') or self.conn is None:
@@ -305,12 +328,14 @@ class SqliteDict(DictClass):
         # We could keep the total count of rows ourselves, by means of triggers,
         # but that seems too complicated and would slow down normal operation
         # (insert/delete etc).
+        self._flush()
         GET_LEN = 'SELECT COUNT(*) FROM "%s"' % self.tablename
         rows = self.conn.select_one(GET_LEN)[0]
         return rows if rows is not None else 0
 
     def __bool__(self):
         # No elements is False, otherwise True
+        self._flush()
         GET_MAX = 'SELECT MAX(ROWID) FROM "%s"' % self.tablename
         m = self.conn.select_one(GET_MAX)[0]
         # Explicit better than implicit and bla bla
@@ -325,16 +350,19 @@ class SqliteDict(DictClass):
         return tuple ( tables )
         
     def iterkeys(self):
+        self._flush()
         GET_KEYS = 'SELECT key FROM "%s" ORDER BY rowid' % self.tablename
         for key in self.conn.select(GET_KEYS):
             yield key[0]
 
     def itervalues(self):
+        self._flush()
         GET_VALUES = 'SELECT value FROM "%s" ORDER BY rowid' % self.tablename
         for value in self.conn.select(GET_VALUES):
             yield self.decode(value[0])
 
     def iteritems(self):
+        self._flush()
         GET_ITEMS = 'SELECT key, value FROM "%s" ORDER BY rowid' % self.tablename
         for key, value in self.conn.select(GET_ITEMS):
             yield key, self.decode(value)
@@ -349,10 +377,12 @@ class SqliteDict(DictClass):
         return self.iteritems() if major_version > 2 else list(self.iteritems())
 
     def __contains__(self, key):
+        self._flush()
         HAS_ITEM = 'SELECT 1 FROM "%s" WHERE key = ?' % self.tablename
         return self.conn.select_one(HAS_ITEM, (key,)) is not None
 
     def __getitem__(self, key):
+        self._flush()
         GET_ITEM = 'SELECT value FROM "%s" WHERE key = ?' % self.tablename
         item = self.conn.select_one(GET_ITEM, (key,))
         if item is None:
@@ -363,11 +393,7 @@ class SqliteDict(DictClass):
     def __setitem__(self, key, value):
         if self.flag == 'r':
             raise RuntimeError('Refusing to write to read-only SqliteDict')
-
-        ADD_ITEM = 'REPLACE INTO "%s" (key, value) VALUES (?,?)' % self.tablename
-        
-        self.conn.execute(ADD_ITEM, (key, self.encode(value)))
-        
+        self._write ( [ ( key , self._serialize ( key , value ) ) ] )
 
     def __delitem__(self, key):
         if self.flag == 'r':
@@ -386,13 +412,62 @@ class SqliteDict(DictClass):
             items = items.items()
         except AttributeError:
             pass
-        items = [(k, self.encode(v)) for k, v in items]
-
-        UPDATE_ITEMS = 'REPLACE INTO "%s" (key, value) VALUES (?, ?)' % self.tablename
-        self.conn.executemany(UPDATE_ITEMS, items)
+        self.update_many ( items )
         if kwds:
             self.update(kwds)
 
+    def update_many ( self , items ) :
+        """Write many (key,value) pairs at once:
+        the values are serialized, and the rows are inserted
+        with one `executemany` call
+        >>> db.update_many ( ( 'key%d' % i , i ) for i in range ( 100000 ) )
+        """
+        if self.flag == 'r':
+            raise RuntimeError('Refusing to update read-only SqliteDict')
+        self._write ( [ ( k , self._serialize ( k , v ) ) for k , v in items ] )
+        
+    def transaction ( self , size = 10000 ) :
+        """Context manager for the batched writes:
+        - the writes are buffered and inserted with `executemany`
+          in chunks of (at most) `size` rows
+        - the reads inside the transaction see all previous writes 
+        - the data are committed once at the end of the transaction
+        - the writes are not rolled back in case of exception 
+        >>> with db.transaction () :
+        ...     for i in range ( 100000 ) : db [ 'key%d' % i ] = i
+        """
+        if self.flag == 'r':
+            raise RuntimeError('Refusing to write to read-only SqliteDict')
+        return Transaction ( self , size )
+
+    def _serialize ( self , key , value ) :
+        """Serialize the value (the first stage of the encoding)"""
+        return self.encode ( value )
+
+    def _finalize ( self , rows ) :
+        """Finalize the serialized rows (the second stage of the encoding, e.g. compression)"""
+        return rows 
+
+    def _write ( self , rows ) :
+        """Write (or buffer inside the transaction) the serialized rows"""
+        if self._pending is not None :
+            self._pending.extend ( rows )
+            if self._pending_size <= len ( self._pending ) : self._flush ()
+            return
+        rows = self._finalize ( rows )
+        ADD_ITEMS = 'REPLACE INTO "%s" (key, value) VALUES (?,?)' % self.tablename
+        if 1 == len ( rows ) : self.conn.execute     ( ADD_ITEMS , rows [ 0 ] )
+        elif rows            : self.conn.executemany ( ADD_ITEMS , rows       )
+
+    def _flush ( self ) :
+        """Flush the buffered writes of the transaction"""
+        if not self._pending : return
+        rows , self._pending = self._pending , None
+        try :
+            self._write ( rows )
+        finally :
+            self._pending = []
+
     def __iter__(self):
         return self.iterkeys()
 
@@ -401,6 +476,7 @@ class SqliteDict(DictClass):
             raise RuntimeError('Refusing to clear read-only SqliteDict')
 
         CLEAR_ALL = 'DELETE FROM "%s";' % self.tablename  # avoid VACUUM, as it gives "OperationalError: database schema has changed"
+        self._flush()
         self.conn.commit()
         self.conn.execute(CLEAR_ALL)
         self.conn.commit()
@@ -430,6 +506,7 @@ class SqliteDict(DictClass):
         not guaranteed persisted (default implication when autocommit=True).
         """
         if self.conn is not None:
+            self._flush()
             self.conn.commit(blocking)
     sync = commit
 
@@ -437,7 +514,10 @@ class SqliteDict(DictClass):
         if do_log:
             logger.debug("closing %s" % self)
         if hasattr(self, 'conn') and self.conn is not None:
-            if self.conn.autocommit and not force:
+            if self._pending and not force :
+                self._flush()
+                self.conn.commit(blocking=True)
+            if ( self.conn.autocommit or self.conn.batch ) and not force:
                 # typically calls to commit are non-blocking when autocommit is
                 # used.  However, we need to block on close() to ensure any
                 # awaiting exceptions are handled and that all data is
@@ -485,6 +565,34 @@ if major_version == 2:
 #endclass SqliteDict
 
 
+class Transaction(object):
+    """Context manager for the batched writes to SqliteDict
+    - see SqliteDict.transaction
+    """
+    def __init__ ( self , db , size = 10000 ) :
+        self.db    = db
+        self.size  = max ( 1 , size )
+        self.owner = False
+
+    def __enter__ ( self ) :
+        ## the nested transactions are merged into the outer one 
+        if self.db._pending is None :
+            self.db._pending      = []
+            self.db._pending_size = self.size 
+            self.owner            = True
+        return self.db
+
+    def __exit__ ( self , *_ ) :
+        if not self.owner : return
+        try :
+            self.db._flush ()
+        finally :
+            self.db._pending = None
+            self.owner       = False 
+        self.db.conn.commit ( blocking = True )
+#endclass Transaction
+
+
 class SqliteMultithread(Thread):
     """
     Wrap sqlite connection in a way that allows concurrent requests from multiple threads.
@@ -493,13 +601,14 @@ class SqliteMultithread(Thread):
     in a separate thread (in the same order they arrived).
 
     """
-    def __init__(self, filename, flag , autocommit, journal_mode , timeout = 5 ):
+    def __init__(self, filename, flag , autocommit, journal_mode , timeout = 5 , batch = 0 ):
         super(SqliteMultithread, self).__init__()
         self.filename = filename
         self.flag     = flag 
         self.autocommit = autocommit
         self.journal_mode = journal_mode
         self.timeout = timeout 
+        self.batch   = batch 
         # use request queue of unlimited size
         self.reqs = Queue()
         self.setDaemon(True)  # python2.5-compatible
@@ -519,28 +628,45 @@ class SqliteMultithread(Thread):
 
     def run__( self, conn ):
         if self.autocommit:
-            conn = sqlite3.connect(self.filename, isolation_level=None, check_same_thread=False)
+            conn = sqlite3.connect(self.filename, self.timeout, isolation_level=None, check_same_thread=False)
         else:
-            conn = sqlite3.connect(self.filename, check_same_thread=False)
-        conn.execute('PRAGMA journal_mode = %s' % self.journal_mode)
+            conn = sqlite3.connect(self.filename, self.timeout, check_same_thread=False)
+        self.retry ( conn.execute , 'PRAGMA journal_mode = %s' % self.journal_mode )
         conn.text_factory = str
         cursor = conn.cursor()
         conn.commit()
         cursor.execute('PRAGMA synchronous=OFF')
+        ## the write throughput: larger page cache and in-memory temporary storage 
+        cursor.execute('PRAGMA cache_size=-65536')
+        cursor.execute('PRAGMA temp_store=MEMORY')
 
-        res = None
+        res     = None
+        nwrites = 0 
         while True:
             req, arg, res, outer_stack = self.reqs.get()
             if req == '--close--':
                 assert res, ('--close-- without return queue', res)
                 break
             elif req == '--commit--':
-                conn.commit()
+                try:
+                    self.retry ( conn.commit )
+                    nwrites = 0 
+                except Exception as err:
+                    self.exception = sys.exc_info()
+                    self.log.error('Commit failed: %s' % err )
                 if res:
                     res.put('--no more--')
             else:
                 try:
-                    cursor.execute(req, arg)
+                    if req == '--many--' :
+                        self.retry ( cursor.executemany , *arg )
+                        nwrites += len ( arg [ 1 ] ) 
+                    else : 
+                        self.retry ( cursor.execute , req, arg)
+                        if res is None : nwrites += 1
+                    if self.batch and self.batch <= nwrites :
+                        self.retry ( conn.commit )
+                        nwrites = 0
                 except Exception as err:
                     self.exception = (e_type, e_value, e_tb) = sys.exc_info()
                     inner_stack = traceback.extract_stack()
@@ -580,6 +706,23 @@ class SqliteMultithread(Thread):
         conn.close()
         res.put('--no more--')
 
+    def retry ( self , action , *args ):
+        """
+        Perform the action, retrying it with exponential backoff (and jitter)
+        while the database is locked/busy by other writers, at most `timeout` seconds.
+        """
+        delay = 0.005
+        start = time.time()
+        while True:
+            try:
+                return action ( *args )
+            except sqlite3.OperationalError as err:
+                msg = str ( err ).lower()
+                if not ( 'locked' in msg or 'busy' in msg ) : raise
+                if self.timeout < time.time() - start       : raise
+                time.sleep ( delay * ( 1 + random.random() ) )
+                delay = min ( 2 * delay , 1.0 )
+
     def check_raise_error(self):
         """
         Check for and raise exception for any previous sqlite query.
@@ -622,9 +765,12 @@ class SqliteMultithread(Thread):
         self.reqs.put((req, arg or tuple(), res, stack))
 
     def executemany(self, req, items):
-        for item in items:
-            self.execute(req, item)
+        """
+        `executemany` calls are non-blocking: all items are queued as one request
+        """
         self.check_raise_error()
+        stack = traceback.extract_stack()[:-1]
+        self.reqs.put(('--many--', (req, list(items)), None, stack))
 
     def select(self, req, arg=None):
         """
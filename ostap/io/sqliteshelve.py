@@ -148,6 +148,13 @@ try :
 except ImportError : 
     from cStringIO import StringIO as BytesIO         
 # =============================================================================
+try : 
+    import zstandard as zstd 
+except ImportError :
+    zstd = None
+## the magic number of the zstd frame 
+_ZSTD_MAGIC = b'\x28\xb5\x2f\xfd'
+# =============================================================================
 from ostap.logger.logger import getLogger
 if '__main__' == __name__ : logger = getLogger ( 'ostap.io.sqliteshelve' )
 else                      : logger = getLogger ( __name__ )
@@ -241,7 +248,10 @@ class SQLiteShelf(SqliteDict):
                    compress_level = zlib.Z_BEST_COMPRESSION , 
                    journal_mode   = "DELETE"  ,
                    protocol       = PROTOCOL  ,
-                   timeout        = 30        ) :
+                   timeout        = 30        ,
+                   concurrent     = False     , 
+                   batch          = 0         ,
+                   zstd_dict      = False     ) :
         """Initialize a thread-safe sqlite-backed dictionary.
         The dictionary will be a table ``tablename`` in database file
         ``filename``. A single file (=database) may contain multiple tables.
@@ -259,6 +269,24 @@ class SQLiteShelf(SqliteDict):
         Set ``journal_mode`` to ``OFF``
         if you're experiencing sqlite I/O problems
         or if you need performance and don't care about crash-consistency.
+
+        Set ``concurrent`` to ``True`` for several concurrent writers
+        (e.g. parallel jobs) to the same database: it uses ``WAL`` journal mode,
+        and the locked/busy writes are retried with backoff up to ``timeout`` seconds.
+        
+        If ``batch`` is positive, the writes are grouped into transactions
+        of ``batch`` operations (``writeback/autocommit`` is ignored)
+
+        For many small writes use ``update_many`` or ``transaction``:
+        
+        >>> with db.transaction () :
+        ...    for i in range ( 100000 ) : db [ 'toy%%d' %% i ] = results [ i ] 
+
+        If ``zstd_dict`` is ``True`` (and ``zstandard`` is available),
+        the values are compressed with ``zstd`` using the shared dictionary,
+        trained on the first large chunk of written values (e.g. the first
+        chunk of the transaction). It efficiently compresses the many
+        small similar values.
         
         The `mode` parameter:
         - 'c': default mode, open for read/write, creating the db/table if necessary.
@@ -282,6 +310,12 @@ class SQLiteShelf(SqliteDict):
             filename  = os.path.abspath    ( filename )
             
         self.__filename = filename 
+
+        ## several concurrent writers: WAL-mode 
+        if concurrent : journal_mode = 'WAL'
+        
+        ## batched transactions 
+        if batch and 0 < batch : writeback = False
         
         SqliteDict.__init__ ( self                        ,
                               filename     = filename     ,
@@ -289,11 +323,30 @@ class SQLiteShelf(SqliteDict):
                               flag         = mode         ,
                               autocommit   = writeback    ,
                               journal_mode = journal_mode ,
-                              timeout      = timeout      )
+                              timeout      = timeout      ,
+                              batch        = batch        )
         
         self.__compresslevel = compress_level 
         self.__protocol      = protocol
         self.__sizes         = {}
+        
+        ## values/items are compressed
+        self.decode          = self.__decode 
+
+        ## zstd compression with the shared dictionary 
+        if zstd_dict and zstd is None :
+            logger.warning ( "``zstandard'' is not available, ``zstd_dict'' is ignored" )
+        self.__zstd_dict     = True if ( zstd_dict and zstd ) else False 
+        self.__zdict_table   = '%s_zstd_dict' % self.tablename
+        self.__zdict         = None  ## the dictionary (ZstdCompressionDict)
+        self.__zdict_tried   = False ## training is tried? 
+        self.__compressor    = None 
+        self.__decompressors = {}
+        if self.__zstd_dict and self.flag != 'r' :
+            self.conn.execute ( 'CREATE TABLE IF NOT EXISTS "%s" (id INTEGER PRIMARY KEY, dict BLOB)' % self.__zdict_table )
+            self.conn.commit  ()
+            self.__zdict       = self.__load_dict ()
+            self.__zdict_tried = self.__zdict is not None 
 
         if self.flag in (  'w' , 'n' ) :
             dct  = collections.OrderedDict() 
@@ -330,6 +383,11 @@ class SQLiteShelf(SqliteDict):
     def protocol    ( self ) :
         """The pickling protocol"""
         return self.__protocol
+
+    @property
+    def zstd_dict   ( self ) :
+        """``zstd_dict'' : compress with zstd using the shared dictionary?"""
+        return self.__zstd_dict
     
     # =========================================================================
     ## iterator over good keys 
@@ -465,7 +523,8 @@ class SQLiteShelf(SqliteDict):
                                writeback      = self.writeback    ,                                
                                protocol       = self.protocol     ,
                                compress_level = self.compression  , 
-                               journal_mode   = self.journal_mode )
+                               journal_mode   = self.journal_mode ,
+                               zstd_dict      = self.zstd_dict    )
         
         ## copy the content
         if keys :
@@ -482,16 +541,24 @@ class SQLiteShelf(SqliteDict):
     def __get_raw_item__ ( self, key ):
         """ ``get-and-uncompress-item'' from dbase 
         """
+        self._flush () 
         GET_ITEM = 'SELECT value FROM %s WHERE key = ?' % self.tablename
         item = self.conn.select_one ( GET_ITEM , ( key , ) )
         if item is None: raise KeyError(key)
         
         self.__sizes [ key ] = len ( item[0] ) 
-        f     = BytesIO ( zlib.decompress ( item [ 0 ] ) ) 
+        f     = BytesIO ( self.__decompress ( item [ 0 ] ) ) 
         value = Unpickler ( f ) . load ()
         
         return value
 
+    # =============================================================================
+    ## uncompress and unpickle the value (used for values/items)
+    def __decode ( self , zblob ) :
+        """Uncompress and unpickle the value (used for values/items)"""
+        value = Unpickler ( BytesIO ( self.__decompress ( zblob ) ) ) . load ()
+        return value.payload if isinstance ( value , Item ) else value 
+        
     # =============================================================================
     ## ``get-and-uncompress-item'' from dbase 
     def __getitem__ ( self, key ):
@@ -503,23 +570,85 @@ class SQLiteShelf(SqliteDict):
         return value
 
     # =============================================================================
-    ## ``set-and-compress-item'' to dbase 
-    def __setitem__ ( self , key , value ) :
-        """ ``set-and-compress-item'' to dbase 
+    ## serialize the item: the first stage of ``set-and-compress-item''
+    def _serialize ( self , key , value ) :
+        """Serialize the item: the first stage of ``set-and-compress-item''
         """
-        ADD_ITEM = 'REPLACE INTO %s (key, value) VALUES (?,?)' % self.tablename
-
         item = Item ( datetime.datetime.now ().strftime( '%Y-%m-%d %H:%M:%S' ) , value )
-
-        f     = BytesIO ()
-        p     = Pickler ( f , self.protocol )
+        f    = BytesIO ()
+        p    = Pickler ( f , self.protocol )
         p.dump ( item )
-        blob  = f.getvalue ( ) 
-        zblob = zlib.compress ( blob , self.compression )
-        
-        self.__sizes [ key ] = len ( zblob )
-        self.conn.execute ( ADD_ITEM, ( key , sqlite3.Binary ( zblob ) ) )
+        return f.getvalue ( ) 
+
+    # =============================================================================
+    ## compress the serialized items: the second stage of ``set-and-compress-item''
+    #  - the shared zstd dictionary is trained on the first large chunk 
+    def _finalize ( self , rows ) :
+        """Compress the serialized items: the second stage of ``set-and-compress-item''
+        - the shared zstd dictionary is trained on the first large chunk 
+        """
+        if self.__zstd_dict and not self.__zdict_tried and 64 <= len ( rows ) :
+            self.__train_dict ( [ blob for key , blob in rows ] )
+        result = []
+        for key , blob in rows :
+            zblob = self.__compress ( blob ) 
+            self.__sizes [ key ] = len ( zblob )
+            result.append ( ( key , sqlite3.Binary ( zblob ) ) )
+        return result 
+
+    # =============================================================================
+    ## compress the serialized item
+    def __compress ( self , blob ) :
+        """Compress the serialized item"""
+        if not self.__zstd_dict : return zlib.compress ( blob , self.compression )
+        if self.__compressor is None :
+            level = max ( 1 , self.compression ) 
+            self.__compressor = zstd.ZstdCompressor ( level = level , dict_data = self.__zdict ) if self.__zdict \
+                                else zstd.ZstdCompressor ( level = level )
+        return self.__compressor.compress ( blob )
 
+    # =============================================================================
+    ## uncompress the item (zlib or zstd)
+    def __decompress ( self , zblob ) :
+        """Uncompress the item (zlib or zstd)"""
+        zblob = bytes ( zblob )
+        if zblob [ :4 ] != _ZSTD_MAGIC : return zlib.decompress ( zblob )
+        if zstd is None :
+            raise IOError ( "``zstandard'' is required to read the item from %s" % self.filename )
+        dict_id = zstd.get_frame_parameters ( zblob ).dict_id
+        decompressor = self.__decompressors.get ( dict_id , None )
+        if decompressor is None :
+            zdict = None
+            if dict_id :
+                zdict = self.__zdict if self.__zdict else self.__load_dict ()
+                if zdict is None or zdict.dict_id () != dict_id :
+                    raise IOError ( "No zstd dictionary %s in %s" % ( dict_id , self.filename ) )
+            decompressor = zstd.ZstdDecompressor ( dict_data = zdict ) if zdict else zstd.ZstdDecompressor ()
+            self.__decompressors [ dict_id ] = decompressor
+        return decompressor.decompress ( zblob )
+
+    # =============================================================================
+    ## load the shared zstd dictionary from the database
+    def __load_dict ( self ) :
+        """Load the shared zstd dictionary from the database"""
+        if not self.__zdict_table in [ t [ 0 ] for t in self.tables () ] : return None
+        row = self.conn.select_one ( 'SELECT dict FROM "%s" WHERE id = 1' % self.__zdict_table )
+        return zstd.ZstdCompressionDict ( bytes ( row [ 0 ] ) ) if row else None
+
+    # =============================================================================
+    ## train and store the shared zstd dictionary
+    def __train_dict ( self , samples ) :
+        """Train and store the shared zstd dictionary"""
+        self.__zdict_tried = True
+        try :
+            zdict = zstd.train_dictionary ( 16 * 1024 , samples )
+        except Exception :
+            logger.warning ( "Cannot train zstd dictionary with %d samples, use zstd without dictionary" % len ( samples ) ) 
+            return
+        self.conn.execute ( 'REPLACE INTO "%s" (id, dict) VALUES (?,?)' % self.__zdict_table ,
+                            ( 1 , sqlite3.Binary ( zdict.as_bytes () ) ) )
+        self.__zdict      = zdict
+        self.__compressor = None 
 
     # =========================================================================
     ## close and compress (if needed)
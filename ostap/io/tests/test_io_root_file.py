@@ -0,0 +1,80 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# @file ostap/io/tests/test_io_root_file.py
+# Test module for the decorations of ROOT files
+# @see ostap/io/root_file.py
+# @see Ostap::Utils::KeyIndex
+# Copyright (c) Ostap developpers.
+# =============================================================================
+""" Test module for the decorations of ROOT files
+- see ostap/io/root_file.py
+- see Ostap::Utils::KeyIndex
+"""
+# =============================================================================
+import ROOT
+import ostap.io.root_file
+import ostap.utils.cleanup   as     CU
+from   ostap.utils.timing    import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'test_io_root_file' )
+else                       : logger = getLogger ( __name__            )
+# =============================================================================
+
+# =============================================================================
+## check the index of keys
+def test_key_index () :
+    """Check the index of keys
+    """
+
+    logger   = getLogger ( 'test_key_index' )
+
+    filename = CU.CleanUp.tempfile ( suffix = '.root' )
+    with ROOT.TFile.Open ( filename , 'NEW' ) as rfile :
+        for d in ( 'A' , 'B' , 'A/C' ) :
+            for i in range ( 50 ) :
+                rfile [ '%s/h_pt_%d'  % ( d , i ) ] = ROOT.TH1D ( 'h_pt_%s_%d'  % ( d , i ) , '' , 10 , 0 , 1 )
+                rfile [ '%s/h_eta_%d' % ( d , i ) ] = ROOT.TH2D ( 'h_eta_%s_%d' % ( d , i ) , '' , 5 , 0 , 1 , 5 , 0 , 1 )
+            rfile [ '%s/name' % d ] = ROOT.TNamed ( 'name' , d )
+
+    with ROOT.TFile.Open ( filename , 'READ' ) as rfile :
+
+        with timing ( 'Keys' , logger = logger ) :
+            keys = rfile.keys ()
+        assert 3 * 101 == len ( keys ) , 'Invalid number of keys!'
+        assert 'A/C/h_pt_7' in keys    , 'No key is found!'
+
+        ## the index is cached for read-only files
+        assert rfile.key_index () is rfile.key_index () , 'The index is not cached!'
+
+        index = rfile.key_index ()
+        e     = index.entry ( index.find ( 'A/C/name' ) )
+        assert 'TNamed' == e.classname and 0 < e.nbytes , 'Invalid entry!'
+
+        with timing ( 'Find'  , logger = logger ) :
+            h1 = rfile.find_keys ( '*/h_pt_*'  , ROOT.TH1 )
+            h2 = rfile.find_keys ( typ = ROOT.TH2 )
+            nn = rfile.find_keys ( 'A/*name'   )
+        assert 150 == len ( h1 ) , 'Invalid number of 1D histograms!'
+        assert 150 == len ( h2 ) , 'Invalid number of 2D histograms!'
+        assert [ 'A/name' , 'A/C/name' ] == nn , 'Invalid selection by pattern!'
+
+        ## TH2 inherits from TH1
+        assert 300 == len ( rfile.find_keys ( typ = ROOT.TH1 ) ) , 'Invalid number of histograms!'
+
+        ## only the selected objects are read
+        names = [ k for k , o in rfile.iteritems ( ROOT.TNamed ) if not isinstance ( o , ROOT.TH1 ) ]
+        assert 3 == len ( names ) , 'Invalid number of TNamed!'
+        assert sorted ( rfile.keys ( recursive = False , no_dir = False ) ) == [ 'A' , 'B' ] , 'Invalid top-level keys!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_key_index ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
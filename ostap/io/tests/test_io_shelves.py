@@ -8,6 +8,7 @@
 # @see zipshelve.py
 # @see bz2shelve.py
 # @see lzshelve.py
+# @see zstshelve.py
 # Copyright (c) Ostap developpers.
 # =============================================================================
 """ Test module for data storages, i.e. modules
@@ -16,6 +17,7 @@
   - ostap/io/zipshelve.py
   - ostap/io/bzshelve.py  
   - ostap/io/lzshelve.py  (python3 only)
+  - ostap/io/zstshelve.py (if zstandard is available)
 """
 # =============================================================================
 ## import sys
@@ -46,6 +48,10 @@ if  2 < python_version.major :
     import ostap.io.lzshelve as     lzshelve
 else :
     lzshelve = None 
+try :
+    import ostap.io.zstshelve as  zstshelve
+except ImportError :
+    zstshelve = None 
 import ostap.io.sqliteshelve as     sqliteshelve
 import ostap.io.rootshelve   as     rootshelve
 
@@ -240,10 +246,193 @@ def test_shelves():
                 db [ 'histos'] = data['histos']
                 db.ls()
     
+# =============================================================================
+## per-record compressed database: no whole-file (un)compression 
+def test_zstshelve () :
+
+    if not zstshelve :
+        logger.warning ( 'zstandard module is not available, skip the test' )
+        return
+    
+    db_zst_name = CU.CleanUp.tempfile ( suffix = '.zstdb' )
+
+    with timing ( 'Write/ZST' ) :
+        with zstshelve.open ( db_zst_name , 'c' ) as db :
+            for k in data : db [ k ] = data [ k ]
+            
+    logger.info ( 'ZstShelve    size: %d|%d ' % dbsize ( db_zst_name ) ) 
+
+    with timing ( 'Open&read/ZST' ) :
+        with zstshelve.open ( db_zst_name , 'r' ) as db :
+            h1_zst = db [ 'histo-1D' ]
+            keys   = set ( db.keys () ) 
+
+    if keys != set ( data.keys () ) :
+        logger.error ( 'Invalid keys for ZstShelve!' )
+        
+    for i in h1_zst : 
+        v = h1_zst [i] - h1 [i] 
+        if not iszero ( v.value() ) :
+            logger.error ( 'Large difference for 1D histogram(zst)!' )
+
+    with zstshelve.tmpdb () as db :
+        db [ 'h1'    ] = h1
+        db [ 'h2'    ] = h2
+        db.ls()
+        
+# =============================================================================
+## several simultaneous writers to the same database 
+def test_concurrent () :
+
+    ## (1) SQLite in WAL-mode 
+    db_sql_name = CU.CleanUp.tempfile ( suffix = '.sqldb' )
+    writers = [ sqliteshelve.open ( db_sql_name , 'c' , concurrent = True , batch = 10 ) for i in range ( 3 ) ]
+    for i , db in enumerate ( writers ) :
+        for j in range ( 20 ) : db [ 'h1-%d-%d' % ( i , j ) ] = h1
+    for db in writers : db.close ()
+    
+    with sqliteshelve.open ( db_sql_name , 'r' ) as db :
+        nkeys = len ( [ k for k in db.keys() if k.startswith ( 'h1-' ) ] ) 
+    if 60 != nkeys : logger.error ( 'Invalid number of keys for concurrent SQLiteShelve: %d' % nkeys )
+    
+    ## (2) ROOT: each writer writes its own part 
+    db_root_name = CU.CleanUp.tempfile ( suffix = '.root' )
+    writers = [ rootshelve.open_part ( db_root_name , tag = 'writer%d' % i ) for i in range ( 3 ) ]
+    for i , db in enumerate ( writers ) :
+        db [ 'h1-%d'  % i ] = h1
+        db [ 'obj-%d' % i ] = ( i , 'comment' , h1 )
+    for db in writers : db.close ()
+    
+    with rootshelve.open_multi ( db_root_name ) as db :
+        logger.info ( 'Multi-writer database: %s' % db )
+        if 6 != len ( db ) : logger.error ( 'Invalid number of keys for RootMultiShelf: %d' % len ( db ) )
+        h = db [ 'obj-2' ] [ 2 ]
+        for i in h :
+            v = h [ i ] - h1 [ i ] 
+            if not iszero ( v.value() ) :
+                logger.error ( 'Large difference for 1D histogram(multi)!' )
+        
+# =============================================================================
+## numpy arrays in RootShelf: stored via BLOB directly  
+def test_arrays () :
+
+    try :
+        import numpy
+    except ImportError :
+        logger.warning ( 'numpy is not available, skip the test' )
+        return
+    
+    arrays = { 'a1' : numpy.arange ( 100000 , dtype = numpy.float64 ) ,
+               'a2' : numpy.ones   ( ( 100 , 50 ) , dtype = numpy.int32 ) ,
+               'a3' : numpy.random.normal ( size = 1000 ) [::2] } ## non-contiguous
+    
+    for compress in ( 0 , 404 , 505 ) :
+        db_root_name = CU.CleanUp.tempfile ( suffix = '.root' )
+        with rootshelve.RootShelf ( db_root_name , 'c' , compress_arrays = compress ) as db :
+            for k in arrays : db [ k ] = arrays [ k ]
+        with rootshelve.open ( db_root_name , 'r' ) as db :
+            for k in arrays :
+                a = db [ k ]
+                if a.dtype != arrays [ k ].dtype or a.shape != arrays [ k ].shape or \
+                       not numpy.array_equal ( a , arrays [ k ] ) :
+                    logger.error ( 'Invalid array %s for compression %s' % ( k , compress ) )
+        logger.info ( 'RootShelve with arrays, compression %3d size: %d|%d' % ( ( compress , ) + dbsize ( db_root_name ) ) ) 
+        
+# =============================================================================
+## compact columnar collection of fit results in shelves 
+def test_fitresults () :
+
+    from ostap.io.fitresults import FitResults
+    import pickle
+    
+    results = FitResults ()
+    for i in range ( 1000 ) :
+        results.append ( { 'S' : VE ( 100 + i , 100 + i ) ,
+                           'B' : VE (  50 + i ,  50 + i ) ,
+                           'm' : VE ( 1.0 , 0.01**2 ) } )
+
+    db_zip_name  = CU.CleanUp.tempfile ( suffix = '.zipdb' )
+    db_root_name = CU.CleanUp.tempfile ( suffix = '.root'  )
+    for name , module in ( ( db_zip_name , zipshelve ) , ( db_root_name , rootshelve ) ) :
+        with module.open ( name , 'c' ) as db : db [ 'results' ] = results
+        with module.open ( name , 'r' ) as db : loaded = db [ 'results' ]
+        if len ( loaded ) != len ( results ) or loaded.names != results.names :
+            logger.error ( 'Invalid FitResults from %s' % name )
+            continue
+        for i in ( 0 , 10 , 999 ) :
+            for n in results.names :
+                if loaded [ i ] [ n ].value () != results [ i ] [ n ].value () or \
+                       loaded [ i ] [ n ].cov2  () != results [ i ] [ n ].cov2  () :
+                    logger.error ( 'Invalid parameter %s for result #%d from %s' % ( n , i , name ) )
+        
+    logger.info ( 'FitResults   pickle size: %d' % len ( pickle.dumps ( results ) ) )
+    logger.info ( 'list of dict pickle size: %d' % len ( pickle.dumps ( [ r.params () for r in results ] ) ) )
+    
+    try :
+        import numpy
+    except ImportError :
+        logger.warning ( 'numpy is not available, skip the test' )
+        return
+    
+    s = results.values ( 'S' )
+    if not numpy.array_equal ( s , 100 + numpy.arange ( 1000 , dtype = numpy.float64 ) ) :
+        logger.error ( 'Invalid numpy column for FitResults' )
+        
+# =============================================================================
+## many small writes to SQLiteShelf: transaction and update_many 
+def test_transactions () :
+
+    logger  = getLogger ( 'test_transactions' )
+    N       = 10000 
+    db_name = CU.CleanUp.tempfile ( suffix = '.sqldb' )
+    with sqliteshelve.open ( db_name , 'c' ) as db :
+        with timing ( 'Transaction %d' % N , logger = logger ) :
+            with db.transaction () :
+                for i in range ( N ) : db [ 'toy-%d' % i ] = ( i , 1.0 * i , 'toy' )
+        with timing ( 'Update_many %d' % N , logger = logger ) :
+            db.update_many ( ( 'fit-%d' % i , { 'i' : i } ) for i in range ( N ) )
+            
+    with sqliteshelve.open ( db_name , 'r' ) as db :
+        nkeys = len ( [ k for k in db.keys () if k.startswith ( ( 'toy-' , 'fit-' ) ) ] )
+        if 2 * N != nkeys : logger.error ( 'Invalid number of keys: %d' % nkeys )
+        if ( 7 , 7.0 , 'toy' ) != db [ 'toy-7' ] : logger.error ( 'Invalid item from transaction'  )
+        if { 'i' : 9 } != db [ 'fit-9' ] : logger.error ( 'Invalid item from update_many' ) 
+
+# =============================================================================
+## pipelined conversion of the database into ROOT file 
+def test_dump_dbase () :
+
+    logger   = getLogger ( 'test_dump_dbase' )
+    from ostap.io.dump_root import dump_dbase
+    
+    N        = 1000 
+    zip_name = CU.CleanUp.tempfile ( suffix = '.zipdb' )
+    rfile    = CU.CleanUp.tempfile ( suffix = '.root'  )
+    with zipshelve.open ( zip_name , 'c' ) as db :
+        for i in range ( N ) : db [ 'item-%d' % i ] = ( i , 'item' , h1 )
+            
+    with zipshelve.open ( zip_name , 'r' ) as db :
+        keys = sorted ( db.keys () )
+        with timing ( 'Dump %d items' % N , logger = logger ) :
+            ## the first half, then resume 
+            dump_dbase ( db , rfile , keys = keys [ : N // 2 ] , nthreads = 4 )
+            n = dump_dbase ( db , rfile , keys = keys , nthreads = 4 )
+        if N - N // 2 != n : logger.error ( 'Invalid number of items after resume: %d' % n ) 
+            
+    with rootshelve.open ( rfile , 'r' ) as db :
+        if N != len ( db ) : logger.error ( 'Invalid number of items in ROOT file: %d' % len ( db ) )
+        if 7 != db [ 'item-7' ] [ 0 ] : logger.error ( 'Invalid item in ROOT file' ) 
+        
 # =============================================================================
 if '__main__' == __name__ :
     
-    test_shelves()
+    test_shelves    ()
+    test_zstshelve  ()
+    test_concurrent ()
+    test_arrays     ()
+    test_fitresults ()
+    test_transactions ()
+    test_dump_dbase   ()
 
 # =============================================================================
 ##                                                                      The END
@@ -0,0 +1,417 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# @file zstshelve.py
+# 
+# This is ``Zstandard''-version of shelve database.
+# 
+# Keeping the same interface and functionlity as shelve data base,
+# ZstShelf allows much more compact file size through the on-flight
+# compression of the content with fast ``Zstandard'' algorithm
+#
+# Unlike other compressed shelves, the whole data base is never compressed:
+# each record is compressed individually and stored in the indexed
+# database (Berkeley DB or SQLite), therefore opening the data base
+# and the access to the single key do not depend on the size of data base.
+#
+# Create new DB:
+#
+# @code
+# >>> import zstshelve as DBASE  
+# >>> db = DBASE.open ('a_db', 'n')    ## create new DB
+# ...
+# >>> abcde = ...
+# >>> db['some_key'] =  abcde          ## add information to DB
+# ...
+# >>> db.close()
+# @endcode 
+#
+# Access to DB in read-only mode :
+#
+# @code
+# >>> import zstshelve as DBASE  
+# >>> db = DBASE.open ('a_db' , 'r' ) ## access existing dbase in read-only mode
+# ...
+# >>> for key in db : print(key)
+# ...
+# >>> abcd = db['some_key']
+# @endcode 
+#
+# Convert the existing (whole-file compressed) data base into new format:
+#
+# @code
+# >>> import zipshelve, zstshelve
+# >>> with zipshelve.open ( 'old_db.gz' , 'r' ) as old :
+# ...     with zstshelve.open ( 'new_db' , 'n' ) as new :
+# ...         for key in old : new [ key ] = old [ key ] 
+# @endcode 
+#
+# @attention: It requires <code>zstandard</code> module
+#
+# @attention: When one tries to read the database with pickled ROOT object using newer
+# version of ROOT, one could get a ROOT read error,
+# in case of evoltuion in ROOT streamers for some  classes, e.g. <code>ROOT.TH1D</code>>
+# @code 
+# Error in <TBufferFile::ReadClassBuffer>: Could not find the StreamerInfo for version 2 of the class TH1D, object skipped at offset 19
+# Error in <TBufferFile::CheckByteCount>: object of class TH1D read too few bytes: 2 instead of 878
+# @endcode
+# The solution is simple and described in  file ostap.io.dump_root
+# @see ostap.io.dump_root
+#
+# @author Vanya BELYAEV Ivan.Belyaev@cern.ch
+# @date   2023-01-30
+# =============================================================================
+"""This is ``Zstandard''-version of shelve database.
+
+Keeping the same interface and functionlity as shelve data base,
+ZstShelf allows much more compact file size through the on-flight
+compression of the content with fast ``Zstandard'' algorithm
+
+Unlike other compressed shelves, the whole data base is never compressed:
+each record is compressed individually and stored in the indexed
+database (Berkeley DB or SQLite), therefore opening the data base
+and the access to the single key do not depend on the size of data base.
+
+ Create new DB:
+
+ >>> import zstshelve as DBASE  
+ >>> db = DBASE.open ('a_db', 'n')    ## create new DB
+ ...
+ >>> abcde = ...
+ >>> db['some_key'] =  abcde          ## add information to DB
+ ...
+ >>> db.close()
+
+ Access to DB in read-only mode :
+
+ >>> import zstshelve as DBASE  
+ >>> db = DBASE.open ('a_db' , 'r' ) ## access existing dbase in read-only mode
+ ...
+ >>> for key in db : print(key)
+ ...
+ >>> abcd = db['some_key']
+
+ Convert the existing (whole-file compressed) data base into new format:
+
+ >>> import zipshelve, zstshelve
+ >>> with zipshelve.open ( 'old_db.gz' , 'r' ) as old :
+ ...     with zstshelve.open ( 'new_db' , 'n' ) as new :
+ ...         for key in old : new [ key ] = old [ key ] 
+
+ Attention: It requires `zstandard` module
+ 
+ Attention: When one tries to read the database with pickled ROOT object using newer
+ version of ROOT, one could get a ROOT read error,
+ in case of evoltuion in ROOT streamers for some  classes, e.g. ROOT.TH1D
+ > Error in <TBufferFile::ReadClassBuffer>: Could not find the StreamerInfo for version 2 of the class TH1D, object skipped at offset 19
+ > Error in <TBufferFile::CheckByteCount>: object of class TH1D read too few bytes: 2 instead of 878
+ The solution is simple and described in  file ostap.io.dump_root
+ - see ostap.io.dump_root
+ 
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2023-01-30"
+__version__ = "$Revision$" 
+# =============================================================================
+__all__ = (
+    'ZstShelf' ,   ## The DB-itself
+    'open'     ,   ## helper function to hide the actual DB
+    'tmpdb'    ,   ## create TEMPORARY data base 
+    )
+# =============================================================================
+from sys import version_info as python_version 
+# =============================================================================
+try:
+    from cPickle   import Pickler, Unpickler, HIGHEST_PROTOCOL
+except ImportError:
+    from  pickle   import Pickler, Unpickler, HIGHEST_PROTOCOL 
+# =============================================================================
+## to be compatible between  Python2 and Python3 
+PROTOCOL = 2
+ENCODING = 'utf-8'
+# =============================================================================
+if python_version.major > 2  :
+    from io import BytesIO
+else : 
+    try:
+        from cStringIO import StringIO as BytesIO 
+    except ImportError:
+        from  StringIO import StringIO as BytesIO    
+# ==============================================================================
+import os, sys
+import zstandard   ## use zstandard to compress DB-content 
+import shelve      ## 
+import shutil
+from   ostap.io.compress_shelve import CompressShelf
+from   ostap.io.dbase           import TmpDB 
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__ : logger = getLogger ( 'ostap.io.zstshelve' )
+else                      : logger = getLogger ( __name__             )
+# =============================================================================
+logger.debug ( "Simple generic (c)Pickle-based ``Zstandard''-database" )
+# =============================================================================
+## default compression level 
+ZSTD_LEVEL = 3 
+# =============================================================================
+## @class ZstShelf
+#  ``Zstandard''-version of ``shelve''-database
+#    Modes: 
+#    - 'r' Open existing database for reading only
+#    - 'w' Open existing database for reading and writing
+#    - 'c' Open database for reading and writing, creating if it does not  exist (default)
+#    - 'n' Always create a new, empty database, open for reading and writing
+#  Only the records are compressed, there is no compression of the whole data base
+#  @author Vanya BELYAEV Ivan.Belyaev@cern.ch
+#  @date   2023-01-30
+class ZstShelf(CompressShelf):
+    """Zstandard-version of ``shelve''-database
+    Modes: 
+    - 'r'  Open existing database for reading only
+    - 'w'  Open existing database for reading and writing
+    - 'c'  Open database for reading and writing, creating if it does not exist
+    - 'n'  Always create a new, empty database, open for reading and writing
+    Only the records are compressed, there is no compression of the whole data base
+    """ 
+    ## no compression of the whole data base 
+    extensions = () 
+    ## 
+    def __init__(
+        self                                   ,
+        filename                               ,
+        mode        = 'c'                      , 
+        protocol    = PROTOCOL                 , 
+        compress    = ZSTD_LEVEL               ,
+        writeback   = False                    ,
+        silent      = False                    ,
+        keyencoding = 'utf-8'                  ) :
+
+        ## save arguments for pickling....
+        self.__init_args = ( filename  ,
+                             mode      ,
+                             protocol  ,
+                             compress  ,
+                             writeback ,
+                             silent    )
+
+        ## (de)compressors are reused for all items 
+        self.__compressor   = zstandard.ZstdCompressor   ( level = compress )
+        self.__decompressor = zstandard.ZstdDecompressor ()
+        
+        ## initialize the base class 
+        CompressShelf.__init__ ( self        ,
+                                 filename    ,
+                                 mode        ,
+                                 protocol    ,
+                                 compress    , 
+                                 writeback   ,
+                                 silent      ,
+                                 keyencoding ) 
+        
+    ## needed for proper (un)pickling 
+    def __getinitargs__ ( self ) :
+        """for proper (un_pickling"""
+        return self.__init_args
+
+    ## needed for proper (un)pickling 
+    def __getstate__ ( self ) :
+        """for proper (un)pickling"""
+        self.sync() 
+        return {}
+    
+    ## needed for proper (un)pickling 
+    def __setstate__ ( self , dct ) :
+        """for proper (un)pickling"""
+        pass
+    
+    # =========================================================================
+    ## compress (Zstandard) the files into temporary location, keep original
+    #  - not used for the data base itself, there is no whole-file compression 
+    def compress_files ( self , files ) :
+        """Compress (Zstandard) the files into temporary location, keep original
+        - not used for the data base itself, there is no whole-file compression 
+        """
+        output = self.tempfile()
+        
+        import tarfile, io 
+        with io.open ( output , 'wb' ) as fout :
+            with self.__compressor.stream_writer ( fout ) as zout :
+                with tarfile.open ( fileobj = zout , mode = 'w|' ) as tfile :
+                    for file in files  :
+                        _ , name = os.path.split ( file )
+                        tfile.add ( file , name  )
+        ##
+        return output 
+
+    # =========================================================================
+    ## uncompress (Zstandard) the file into temporary location, keep original
+    #  - not used for the data base itself, there is no whole-file compression 
+    def uncompress_file ( self , filein ) :
+        """Uncompress (Zstandard) the file into temporary location, keep original
+        - not used for the data base itself, there is no whole-file compression 
+        """
+        items  = []
+        tmpdir = self.tempdir ()
+        
+        import tarfile, io 
+        with io.open ( filein , 'rb' ) as fin :
+            with self.__decompressor.stream_reader ( fin ) as zin :
+                with tarfile.open ( fileobj = zin , mode = 'r|' ) as tfile :
+                    for item in tfile  :
+                        tfile.extract ( item , path = tmpdir )
+                        items.append  ( os.path.join ( tmpdir , item.name ) )
+        items.sort() 
+        return tuple ( items )
+
+    # ==========================================================================
+    ## compress (Zstandard)  the item  using <code>zstandard.ZstdCompressor</code>
+    def compress_item ( self , value ) :
+        """Compress (Zstandard) the item using ``zstandard.ZstdCompressor''
+        - see zstandard.ZstdCompressor
+        """
+        f = BytesIO ()
+        p = Pickler ( f , self.protocol )
+        p.dump ( value )
+        return self.__compressor.compress ( f.getvalue() )
+    
+    # =========================================================================
+    ## uncompres (Zstandard) the item using <code>zstandard.ZstdDecompressor</code>
+    def uncompress_item ( self , value ) :
+        """Uncompress (Zstandard) the item using ``zstandard.ZstdDecompressor''
+        -  see zstandard.ZstdDecompressor
+        """        
+        f = BytesIO ( self.__decompressor.decompress ( value ) )
+        return Unpickler ( f ) . load ( )
+
+    # =========================================================================
+    ## clone the database into new one
+    #  @code
+    #  db  = ...
+    #  ndb = db.clone ( 'new_file.db' )
+    #  @endcode
+    def clone ( self , new_name , keys = () ) :
+        """ Clone the database into new one
+        >>> old_db = ...
+        >>> new_db = new_db.clone ( 'new_file.db' )
+        """
+        new_db = ZstShelf ( new_name                         ,
+                            mode        =  'c'               ,
+                            protocol    = self.protocol      ,
+                            compress    = self.compresslevel , 
+                            writeback   = self.writeback     ,
+                            silent      = self.silent        ,
+                            keyencoding = self.keyencoding   )
+        
+        ## copy the content
+        if keys :
+            for key in self.keys() :
+                if key in keys     : new_db [ key ] = self [ key ]
+        else : 
+            for key in self.keys() : new_db [ key ] = self [ key ]
+        
+        new_db.sync ()  
+        return new_db 
+  
+# =============================================================================
+## helper function to access ZstShelve data base
+#  @author Vanya BELYAEV Ivan.Belyaev@cern.ch
+#  @date   2023-01-30
+def open ( filename                   ,
+           mode          = 'c'        ,
+           protocol      = PROTOCOL   ,
+           compresslevel = ZSTD_LEVEL , 
+           writeback     = False      ,
+           silent        = True       ,
+           keyencoding   = ENCODING   ) :
+    
+    """Open a persistent dictionary for reading and writing.
+    
+    The filename parameter is the base filename for the underlying
+    database.  As a side-effect, an extension may be added to the
+    filename and more than one file may be created.  The optional flag
+    parameter has the same interpretation as the flag parameter of
+    anydbm.open(). The optional protocol parameter specifies the
+    version of the pickle protocol (0, 1, or 2).
+    
+    See the module's __doc__ string for an overview of the interface.
+    """
+    
+    return ZstShelf ( filename      ,
+                      mode          ,
+                      protocol      ,
+                      compresslevel ,
+                      writeback     ,
+                      silent        ,
+                      keyencoding   )
+
+# =============================================================================
+## @class TmpZstShelf
+#  TEMPORARY Zstandard-version of ``shelve''-database
+#  @author Vanya BELYAEV Ivan.Belyaev@cern.ch
+#  @date   2023-01-30
+class TmpZstShelf(ZstShelf,TmpDB):
+    """
+    TEMPORARY ``Zstandard''-version of ``shelve''-database     
+    """    
+    def __init__( self                              ,
+                  protocol    = HIGHEST_PROTOCOL    , 
+                  compress    = ZSTD_LEVEL          ,
+                  silent      = False               ,
+                  keyencoding = ENCODING            , 
+                  remove      = True                ,
+                  keep        = False               ) :
+
+        ## initialize the base: generate the name 
+        TmpDB.__init__ ( self , suffix = '.zstdb' , remove = remove , keep = keep ) 
+
+        ## open DB 
+        ZstShelf.__init__ ( self          ,  
+                            self.tmp_name ,
+                            'c'           ,
+                            protocol      ,
+                            compress      , 
+                            False         , ## writeback 
+                            silent        ,
+                            keyencoding   ) 
+        
+    ## close and delete the file 
+    def close ( self )  :
+        ## close the shelve file
+        ZstShelf.close ( self )
+        ## delete the file
+        TmpDB   .clean ( self ) 
+            
+# =============================================================================
+## helper function to open TEMPORARY ZstShelve data base
+#  @author Vanya BELYAEV Ivan.Belyaev@cern.ch
+#  @date   2023-01-30
+def tmpdb ( protocol      = HIGHEST_PROTOCOL ,
+            compresslevel = ZSTD_LEVEL       , 
+            silent        = True             ,
+            keyencoding   = ENCODING         ,
+            remove        = True             ,   ## immediate remove 
+            keep          = False            ) : ## keep it 
+    """Open a TEMPORARY persistent dictionary for reading and writing.
+    
+    The optional protocol parameter specifies the
+    version of the pickle protocol (0, 1, or 2).
+    
+    See the module's __doc__ string for an overview of the interface.
+    """
+    return TmpZstShelf ( protocol      ,
+                         compresslevel ,
+                         silent        ,
+                         keyencoding   ,
+                         remove        ,
+                         keep          ) 
+    
+# =============================================================================
+if '__main__' == __name__ :
+    
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+    
+# =============================================================================
+##                                                                      The END 
+# =============================================================================
@@ -29,6 +29,10 @@ __all__     = (
     'MuteC'              , ## context manager (mute   for C/C++  code) 
     'MutePy'             , ## context manager (mute   for python code) 
     'OutputC'            , ## context manager (output for C/C++  code) 
+    ##
+    'mute_process'       , ## mute the process (e.g. worker) once 
+    'unmute_process'     , ## restore the output for the process 
+    'process_muted'      , ## is the process muted?
     )
 # =============================================================================
 import sys, os ## attention here!!
@@ -91,6 +95,8 @@ class MuteC(object):
     ## class variables: dev-null device & instance counter 
     _devnull = 0
     _cnt     = 0
+    ## class variables: the streams are already muted (by the process or the outer context)
+    _muted   = { 1 : 0 , 2 : 0 }
     
     def __init__( self , out = True , err = False ):
         
@@ -116,29 +122,34 @@ class MuteC(object):
             
     ## context-manager 
     def __enter__(self):
-        
-        ## Save the actual stdout (1) and stderr (2) file descriptors.
-        self.save_fds =  os.dup(1), os.dup(2)  # leak was here !!!
-        
-        ## mute it!
-        if self._out : os.dup2 ( self.__class__._devnull , 1 )  ## C/C++
-        if self._err : os.dup2 ( self.__class__._devnull , 2 )  ## C/C++
+
+        ## redirect only the streams, that are not muted yet:
+        #  no system calls for nested contexts and for the muted process 
+        muted         = self.__class__._muted 
+        self.save_fds = {}
+        for fd , flag in ( ( 1 , self._out ) , ( 2 , self._err ) ) :
+            if flag and not muted [ fd ] :
+                ## Save the actual stdout (1) and stderr (2) file descriptors.
+                self.save_fds [ fd ] = os.dup ( fd ) 
+                os.dup2 ( self.__class__._devnull , fd )  ## C/C++
+            if flag : muted [ fd ] += 1
 
         return self
     
     ## context-manager 
     def __exit__(self, *_):
-        
-        # Re-assign the real stdout/stderr back to (1) and (2)  (C/C++)
-        if self._err : os.dup2 ( self.save_fds[1] , 2 )
-        if self._out : os.dup2 ( self.save_fds[0] , 1 )
-        
-        # fix the  file descriptor leak
-        # (there were no such line in example, and it causes
-        #      the sad:  "IOError: [Errno 24] Too many open files"
-        
-        os.close ( self.save_fds[1] ) 
-        os.close ( self.save_fds[0] )
+
+        muted = self.__class__._muted 
+        for fd , flag in ( ( 2 , self._err ) , ( 1 , self._out ) ) :
+            if flag : muted [ fd ] -= 1
+            saved = self.save_fds.pop ( fd , None )
+            if saved is None : continue 
+            # Re-assign the real stdout/stderr back to (1) and (2)  (C/C++)
+            os.dup2  ( saved , fd ) 
+            # fix the  file descriptor leak
+            # (there were no such line in example, and it causes
+            #      the sad:  "IOError: [Errno 24] Too many open files"
+            os.close ( saved ) 
 
 # =============================================================================
 ## dump all stdout/stderr information (including C/C++) into separate file
@@ -352,6 +363,128 @@ def output ( fname , cout = True , cerr = False ) :
     """
     return OutputC ( fname  , cout , cerr )
 
+# =============================================================================
+## the saved state of the process-level muting 
+_process_state = {}
+# =============================================================================
+## mute the process (e.g. the worker) once:
+#  - set the message levels for RooFit, Minuit, TMVA and ROOT 
+#  - mute <code>std::cout</code>/<code>std::cerr</code> at C++ level
+#  - optionally, redirect the C-level file descriptors to <code>/dev/null</code>
+#  After that the contexts <code>mute</code>, <code>MuteC</code> and 
+#  <code>Ostap::Utils::Mute</code> for the muted streams do nothing, 
+#  and the expensive per-scope redirection of file descriptors 
+#  is used only for the truly uncontrollable output 
+#  @code
+#  mute_process ()  ## e.g. in the worker initialization 
+#  @endcode
+#  @param cout (INPUT) mute stdout?
+#  @param cerr (INPUT) mute stderr?
+#  @param fds  (INPUT) redirect also the C-level file descriptors?
+#  @see unmute_process
+#  @see Ostap::Utils::Mute::setSilent 
+def mute_process ( cout = True , cerr = False , fds = False ) :
+    """Mute the process (e.g. the worker) once:
+    - set the message levels for RooFit, Minuit, TMVA and ROOT 
+    - mute std::cout/std::cerr at C++ level
+    - optionally, redirect the C-level file descriptors to /dev/null
+    After that the contexts `mute`, `MuteC` and `Ostap::Utils::Mute` 
+    for the muted streams do nothing, and the expensive per-scope 
+    redirection of file descriptors is used only for the truly 
+    uncontrollable output 
+    >>> mute_process ()  ## e.g. in the worker initialization 
+    - see unmute_process
+    - see Ostap::Utils::Mute::setSilent 
+    """
+    if _process_state : unmute_process () 
+    
+    import ROOT
+    from ostap.core.core import Ostap
+    
+    state = {}
+    
+    ## (1) RooFit 
+    svc = ROOT.RooMsgService.instance()
+    state [ 'roofit' ] = svc.globalKillBelow () , svc.silentMode ()
+    svc.setGlobalKillBelow ( ROOT.RooFit.FATAL if cerr else ROOT.RooFit.ERROR )
+    svc.setSilentMode      ( True )
+    
+    ## (2) Minuit 
+    state [ 'minuit' ] = ROOT.Math.MinimizerOptions.DefaultPrintLevel () 
+    ROOT.Math.MinimizerOptions.SetDefaultPrintLevel ( -1 )
+    
+    ## (3) ROOT 
+    state [ 'root'   ] = int ( ROOT.gErrorIgnoreLevel )
+    level = ( ROOT.kError + 1 ) if cerr else ROOT.kWarning 
+    ROOT.ROOT.GetROOT().ProcessLine ( "gErrorIgnoreLevel= %d ; " % max ( level , state [ 'root' ] ) )
+    
+    ## (4) TMVA (if available)
+    try : 
+        config = ROOT.TMVA.gConfig ()
+        state [ 'tmva' ] = config.IsSilent () 
+        config.SetSilent ( True )
+    except Exception : 
+        pass
+    
+    ## (5) C++ streams 
+    Ostap.Utils.Mute.setSilent ( cout , cerr ) 
+    
+    ## (6) C-level file descriptors
+    if fds :
+        sys.stdout.flush ()
+        sys.stderr.flush ()
+        devnull = os.open ( os.devnull , os.O_WRONLY )
+        saved   = {}
+        for fd , flag in ( ( 1 , cout ) , ( 2 , cerr ) ) :
+            if not flag : continue
+            saved [ fd ] = os.dup ( fd )
+            os.dup2 ( devnull , fd )
+            MuteC._muted [ fd ] += 1
+        os.close ( devnull )
+        state [ 'fds' ] = saved
+        
+    _process_state.update ( state ) 
+
+# =============================================================================
+## restore the output for the process, muted with <code>mute_process</code>
+#  @see mute_process 
+def unmute_process () :
+    """Restore the output for the process, muted with `mute_process`
+    - see mute_process 
+    """
+    if not _process_state : return 
+    
+    import ROOT
+    from ostap.core.core import Ostap
+    
+    state = dict ( _process_state )
+    _process_state.clear () 
+    
+    for fd , saved in state.get ( 'fds' , {} ).items () :
+        os.dup2  ( saved , fd )
+        os.close ( saved )
+        MuteC._muted [ fd ] -= 1
+        
+    Ostap.Utils.Mute.setSilent ( False , False ) 
+    
+    if 'tmva' in state : ROOT.TMVA.gConfig ().SetSilent ( state [ 'tmva' ] )
+    
+    ROOT.ROOT.GetROOT().ProcessLine ( "gErrorIgnoreLevel= %d ; " % state [ 'root' ] )
+    ROOT.Math.MinimizerOptions.SetDefaultPrintLevel ( state [ 'minuit' ] )
+    
+    svc = ROOT.RooMsgService.instance()
+    svc.setGlobalKillBelow ( state [ 'roofit' ] [ 0 ] )
+    svc.setSilentMode      ( state [ 'roofit' ] [ 1 ] )
+
+# =============================================================================
+## is the process muted with <code>mute_process</code>?
+#  @see mute_process 
+def process_muted () :
+    """Is the process muted with `mute_process`?
+    - see mute_process
+    """
+    return bool ( _process_state ) 
+
 # =============================================================================
 ## simple context manager to suppress C/C++-printout
 #
@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# @file ostap/logger/tests/test_logger_mute.py
+# Test module for muting of the output
+# @see ostap/logger/mute.py
+# @see Ostap::Utils::Mute
+# Copyright (c) Ostap developpers.
+# =============================================================================
+""" Test module for muting of the output
+- see ostap/logger/mute.py
+- see Ostap::Utils::Mute
+"""
+# =============================================================================
+import ROOT
+from   ostap.core.core     import Ostap
+from   ostap.logger.mute   import ( mute , MuteC , mute_process ,
+                                    unmute_process , process_muted )
+from   ostap.utils.timing  import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'test_logger_mute' )
+else                       : logger = getLogger ( __name__           )
+# =============================================================================
+
+# =============================================================================
+## nested contexts and the process-level muted state
+def test_logger_mute () :
+    """Nested contexts and the process-level muted state
+    """
+
+    logger = getLogger ( 'test_logger_mute' )
+
+    with timing ( 'Nested mute' , logger = logger ) :
+        with mute () :
+            for i in range ( 1000 ) :
+                with mute () : pass
+    assert 0 == MuteC._muted [ 1 ] , 'Invalid state of stdout!'
+
+    svc   = ROOT.RooMsgService.instance()
+    level = svc.globalKillBelow ()
+
+    mute_process ()
+    assert process_muted ()                   , 'Process is not muted!'
+    assert Ostap.Utils.Mute.silent ( True )   , 'std::cout is not muted!'
+    assert ROOT.RooFit.ERROR <= svc.globalKillBelow () , 'RooFit is not muted!'
+
+    with timing ( 'Mute in muted process' , logger = logger ) :
+        for i in range ( 1000 ) :
+            with mute () : pass
+
+    unmute_process ()
+    assert not process_muted ()               , 'Process is still muted!'
+    assert not Ostap.Utils.Mute.silent ( True ) , 'std::cout is still muted!'
+    assert level == svc.globalKillBelow ()    , 'RooFit level is not restored!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_logger_mute ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -0,0 +1,275 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file  ostap/math/cache.py
+#  Process-wide, size-bounded (LRU) cache for the results of numerical
+#  integration and differentiation
+#  - the key is built from the function, the limits/point and the configuration
+#  - for C++ functors with <code>tag()</code> method (Ostap functions)
+#    the key is the type and the tag, therefore the results are shared
+#    between different objects with the same parameters
+#  - python callables are identified by the object itself:
+#    they are assumed to be pure functions
+#  @code
+#  from ostap.math.cache import the_cache, cache_stat
+#  the_cache.maxsize = 100000
+#  print ( cache_stat () )
+#  @endcode
+#  @see Ostap::Math::IntegrationCache
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Process-wide, size-bounded (LRU) cache for the results of numerical
+integration and differentiation
+- the key is built from the function, the limits/point and the configuration
+- for C++ functors with `tag()` method (Ostap functions)
+  the key is the type and the tag, therefore the results are shared
+  between different objects with the same parameters
+- python callables are identified by the object itself:
+  they are assumed to be pure functions
+
+>>> from ostap.math.cache import the_cache, cache_stat
+>>> the_cache.maxsize = 100000
+>>> print ( cache_stat () )
+- see Ostap::Math::IntegrationCache
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'LRUCache'     , ## size-bounded LRU cache with statistics
+    'the_cache'    , ## the process-wide cache of numerical results
+    'function_key' , ## the cache key for the function
+    'make_key'     , ## the cache key for the calculation
+    'cache_stat'   , ## statistics of python and C++ caches
+    )
+# =============================================================================
+import threading
+from   collections         import OrderedDict
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.math.cache' )
+else                       : logger = getLogger ( __name__           )
+# =============================================================================
+## @class LRUCache
+#  Simple thread-safe size-bounded cache with "least-recently-used" eviction
+#  and the statistics of hits/misses/evictions
+#  @code
+#  cache = LRUCache ( 1000 )
+#  found , value = cache.lookup ( key )
+#  if not found :
+#      value = ...
+#      cache.insert ( key , value )
+#  @endcode
+class LRUCache(object) :
+    """Simple thread-safe size-bounded cache with `least-recently-used` eviction
+    and the statistics of hits/misses/evictions
+    >>> cache = LRUCache ( 1000 )
+    >>> found , value = cache.lookup ( key )
+    >>> if not found :
+    ...     value = ...
+    ...     cache.insert ( key , value )
+    """
+    def __init__ ( self , maxsize = 10000 ) :
+
+        assert isinstance ( maxsize , int ) and 0 <= maxsize , \
+               "Invalid ``maxsize'' %s" % maxsize
+
+        self.__maxsize   = maxsize
+        self.__data      = OrderedDict ()
+        self.__lock      = threading.Lock ()
+        self.__hits      = 0
+        self.__misses    = 0
+        self.__evictions = 0
+        self.__enabled   = True
+
+    # =========================================================================
+    ## look into the cache
+    #  @return (found,value)
+    def lookup ( self , key ) :
+        """Look into the cache, return (found,value)
+        """
+        if not self.__enabled : return False , None
+        with self.__lock :
+            if key in self.__data :
+                self.__data.move_to_end ( key )
+                self.__hits   += 1
+                return True , self.__data [ key ]
+            self.__misses += 1
+            return False , None
+
+    # =========================================================================
+    ## insert the value into the cache (the oldest entries are evicted)
+    def insert ( self , key , value ) :
+        """Insert the value into the cache (the oldest entries are evicted)
+        """
+        if not self.__enabled or 0 == self.__maxsize : return
+        with self.__lock :
+            self.__data [ key ] = value
+            self.__data.move_to_end ( key )
+            self.__evict ()
+
+    ## evict the oldest entries
+    def __evict ( self ) :
+        while self.__maxsize < len ( self.__data ) :
+            self.__data.popitem ( last = False )
+            self.__evictions += 1
+
+    # =========================================================================
+    ## get the value from the cache, or calculate and cache it
+    #  @code
+    #  value = cache.get ( key , lambda : integral ( ... ) )
+    #  @endcode
+    #  @param key the key, <code>None</code> means "not cacheable"
+    def get ( self , key , calculate ) :
+        """Get the value from the cache or calculate and cache it
+        - key : the key, `None` means `not cacheable`
+        >>> value = cache.get ( key , lambda : integral ( ... ) )
+        """
+        if key is None : return calculate ()
+        found , value = self.lookup ( key )
+        if found       : return value
+        value = calculate ()
+        self.insert ( key , value )
+        return value
+
+    # =========================================================================
+    ## remove all entries
+    def clear ( self ) :
+        """Remove all entries"""
+        with self.__lock : self.__data.clear ()
+
+    ## reset the counters
+    def reset ( self ) :
+        """Reset the counters"""
+        with self.__lock :
+            self.__hits      = 0
+            self.__misses    = 0
+            self.__evictions = 0
+
+    ## get the statistics as dictionary
+    def stat ( self , reset = False ) :
+        """Get the statistics as dictionary"""
+        with self.__lock :
+            result = { 'hits'      : self.__hits      ,
+                       'misses'    : self.__misses    ,
+                       'evictions' : self.__evictions ,
+                       'size'      : len ( self.__data ) ,
+                       'maxsize'   : self.__maxsize   }
+        if reset : self.reset ()
+        return result
+
+    @property
+    def maxsize ( self ) :
+        """``maxsize'' : the maximal number of entries in the cache"""
+        return self.__maxsize
+    @maxsize.setter
+    def maxsize ( self , value ) :
+        assert isinstance ( value , int ) and 0 <= value , \
+               "Invalid ``maxsize'' %s" % value
+        with self.__lock :
+            self.__maxsize = value
+            self.__evict ()
+
+    @property
+    def enabled ( self ) :
+        """``enabled'' : is the cache enabled?"""
+        return self.__enabled
+    @enabled.setter
+    def enabled ( self , value ) :
+        self.__enabled = True if value else False
+
+    @property
+    def hits      ( self ) :
+        """``hits'' : number of cache hits"""
+        return self.__hits
+    @property
+    def misses    ( self ) :
+        """``misses'' : number of cache misses"""
+        return self.__misses
+    @property
+    def evictions ( self ) :
+        """``evictions'' : number of evicted entries"""
+        return self.__evictions
+
+    def __len__      ( self       ) : return len ( self.__data )
+    def __contains__ ( self , key ) : return key in self.__data
+
+# =============================================================================
+## the process-wide cache of numerical results
+the_cache = LRUCache ( 10000 )
+
+# =============================================================================
+## the cache key for the function
+#  - C++ functors with <code>tag()</code>: the type and the tag
+#  - hashable python callables: the object itself
+#  - otherwise <code>None</code> (not cacheable)
+def function_key ( func ) :
+    """The cache key for the function
+    - C++ functors with `tag()`: the type and the tag
+    - hashable python callables: the object itself
+    - otherwise None (not cacheable)
+    """
+    tag = getattr ( func , 'tag' , None )
+    if tag and callable ( tag ) and hasattr ( type ( func ) , '__cpp_name__' ) :
+        try :
+            return type ( func ).__cpp_name__ , int ( tag () )
+        except Exception :
+            return None
+    try :
+        hash ( func )
+    except TypeError :
+        return None
+    return func
+
+# =============================================================================
+## the cache key for the calculation
+#  @code
+#  key = make_key ( 'integral' , func , xmin , xmax , args , kwargs )
+#  @endcode
+#  @return the key or <code>None</code> if the calculation is not cacheable
+def make_key ( what , func , *config ) :
+    """The cache key for the calculation
+    >>> key = make_key ( 'integral' , func , xmin , xmax , args , kwargs )
+    - return the key or None if the calculation is not cacheable
+    """
+    fkey = function_key ( func )
+    if fkey is None : return None
+    items = []
+    for c in config :
+        if isinstance ( c , dict ) : c = tuple ( sorted ( c.items () ) )
+        items.append ( c )
+    key = ( what , fkey ) + tuple ( items )
+    try :
+        hash ( key )
+    except TypeError :
+        return None
+    return key
+
+# =============================================================================
+## statistics of the python and C++ caches
+#  @code
+#  stat = cache_stat ()
+#  print ( 'python hits/misses: %(hits)d/%(misses)d' % stat['python'] )
+#  print ( 'C++    hits/misses: %(hits)d/%(misses)d' % stat['C++'   ] )
+#  @endcode
+#  @see Ostap::Math::IntegrationCache
+def cache_stat ( reset = False ) :
+    """Statistics of the python and C++ caches
+    >>> stat = cache_stat ()
+    >>> print ( 'python hits/misses: %(hits)d/%(misses)d' % stat['python'] )
+    >>> print ( 'C++    hits/misses: %(hits)d/%(misses)d' % stat['C++'   ] )
+    - see Ostap::Math::IntegrationCache
+    """
+    from ostap.math.integral import integration_cache_stat
+    return { 'python' : the_cache.stat ( reset = reset )        ,
+             'C++'    : integration_cache_stat ( reset = reset ) }
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -23,7 +23,7 @@ __all__     = (
     'DPlotRM' , ## vizialize Dalitz density as "rectangular mass plot" 
     )
 # =============================================================================
-import ROOT, math
+import ROOT, math, array 
 from   builtins             import range
 import ostap.math.kinematic
 from   ostap.core.core      import Ostap, fID 
@@ -31,6 +31,11 @@ import ostap.math.base
 import ostap.math.reduce 
 import ostap.histos.graphs  
 # =============================================================================
+try :
+    import numpy as np
+except ImportError :
+    np = None
+# =============================================================================
 # logging 
 # =============================================================================
 from ostap.logger.logger    import getLogger
@@ -322,6 +327,97 @@ Ostap.Kinematics.Dalitz .graph21 = _dp_graph21_
 Ostap.Kinematics.Dalitz .graph31 = _dp_graph31_ 
 Ostap.Kinematics.Dalitz .graph32 = _dp_graph32_
 
+# =============================================================================
+## Evaluate the Dalitz plot quantities for arrays of points in one pass
+#  @code
+#  d   = Dalitz ( 5.279 , 0.493 , 0.139 , 0.139 )
+#  res = d.evaluate_array ( s1 , s2 )
+#  print ( res['inside'] , res['density'] , res['J'] , res['cos_12'] )
+#  @endcode
+#  @see Ostap::Kinematics::Dalitz::evaluate
+#  @return dictionary of numpy arrays (or <code>array.array</code> if numpy is not available)
+def _dp_evaluate_array_ ( dp , s1 , s2 ) :
+    """ Evaluate the Dalitz plot quantities for arrays of points in one pass
+    >>> d   = Dalitz ( 5.279 , 0.493 , 0.139 , 0.139 )
+    >>> res = d.evaluate_array ( s1 , s2 )
+    >>> print ( res['inside'] , res['density'] , res['J'] , res['cos_12'] )
+    - see `Ostap.Kinematics.Dalitz.evaluate`
+    - return dictionary of numpy arrays (or `array.array` if numpy is not available)
+    """
+    if np :
+        x1 = np.ascontiguousarray ( s1 , dtype = np.float64 )
+        x2 = np.ascontiguousarray ( s2 , dtype = np.float64 )
+        assert x1.shape == x2.shape , 'evaluate_array: mismatch in array sizes!'
+        n  = len ( x1 )
+        result = { 'inside' : np.zeros ( n , dtype = bool ) }
+        for key in ( 'density' , 'J' , 'cos_12' , 'cos_23' , 'cos_31' ) :
+            result [ key ] = np.zeros ( n , dtype = np.float64 )
+        inside = result [ 'inside' ]
+    else :
+        x1 = array.array ( 'd' , s1 )
+        x2 = array.array ( 'd' , s2 )
+        assert len ( x1 ) == len ( x2 ) , 'evaluate_array: mismatch in array sizes!'
+        n  = len ( x1 )
+        result = {}
+        for key in ( 'density' , 'J' , 'cos_12' , 'cos_23' , 'cos_31' ) :
+            result [ key ] = array.array ( 'd' , n * [ 0.0 ] )
+        inside = ROOT.nullptr 
+        
+    dp.evaluate ( n , x1 , x2 , inside ,
+                  result [ 'density' ] , result [ 'J'      ] ,
+                  result [ 'cos_12'  ] , result [ 'cos_23' ] , result [ 'cos_31' ] )
+    
+    if not np :
+        ## inside flags from the jacobian (zero outside)
+        result [ 'inside' ] = array.array ( 'b' , [ 0 < j for j in result [ 'J' ] ] ) 
+        
+    return result 
+
+Ostap.Kinematics.Dalitz .evaluate_array = _dp_evaluate_array_
+
+# =============================================================================
+## Dalitz plot boundaries for arrays of points
+#  @code
+#  d0 = Dalitz0 ( 0.493 , 0.139 , 0.139 )
+#  s1min , s1max = d0.s1_minmax_array ( s , s2 ) ## s1-range for given (s,s2)
+#  s2min , s2max = d0.s2_minmax_array ( s , s1 ) ## s2-range for given (s,s1)
+#  @endcode
+#  @see Ostap::Kinematics::Dalitz0::s1_minmax_for_s_s2
+#  @see Ostap::Kinematics::Dalitz0::s2_minmax_for_s_s1
+def _dp0_minmax_array_ ( dp , s , sk , method ) :
+    """Dalitz plot boundaries for arrays of points
+    """
+    if np :
+        x1 = np.ascontiguousarray ( s  , dtype = np.float64 )
+        x2 = np.ascontiguousarray ( sk , dtype = np.float64 )
+        assert x1.shape == x2.shape , 'minmax_array: mismatch in array sizes!'
+        n  = len ( x1 )
+        lo , hi = np.zeros ( n , dtype = np.float64 ) , np.zeros ( n , dtype = np.float64 )
+    else :
+        x1 = array.array ( 'd' , s  )
+        x2 = array.array ( 'd' , sk )
+        assert len ( x1 ) == len ( x2 ) , 'minmax_array: mismatch in array sizes!'
+        n  = len ( x1 )
+        lo , hi = array.array ( 'd' , n * [ 0.0 ] ) , array.array ( 'd' , n * [ 0.0 ] )
+    method ( dp , n , x1 , x2 , lo , hi )
+    return lo , hi 
+
+def _dp0_s1_minmax_array_ ( dp , s , s2 ) :
+    """Boundaries for s1 for arrays of (s,s2)
+    >>> s1min , s1max = d0.s1_minmax_array ( s , s2 )
+    - see Ostap.Kinematics.Dalitz0.s1_minmax_for_s_s2 
+    """
+    return _dp0_minmax_array_ ( dp , s , s2 , Ostap.Kinematics.Dalitz0.s1_minmax_for_s_s2 )
+def _dp0_s2_minmax_array_ ( dp , s , s1 ) :
+    """Boundaries for s2 for arrays of (s,s1)
+    >>> s2min , s2max = d0.s2_minmax_array ( s , s1 )
+    - see Ostap.Kinematics.Dalitz0.s2_minmax_for_s_s1 
+    """
+    return _dp0_minmax_array_ ( dp , s , s1 , Ostap.Kinematics.Dalitz0.s2_minmax_for_s_s1 )
+
+Ostap.Kinematics.Dalitz0.s1_minmax_array = _dp0_s1_minmax_array_
+Ostap.Kinematics.Dalitz0.s2_minmax_array = _dp0_s2_minmax_array_
+
 # =============================================================================
 ## @class DSwap
 #  Swap variables for the Dalitz plot density
@@ -65,6 +65,7 @@ import ROOT, math, abc, array
 from ostap.math.base        import Ostap, iszero , isequal
 from ostap.core.ostap_types import num_types , is_integer
 from ostap.math.ve          import VE 
+from ostap.math.cache       import the_cache, make_key 
 from sys                    import float_info
 from ostap.math.finitediffs import  ( Rule , the_dot , darray ,
                                       Derivative1 , Derivative2 , Derivative3 ,
@@ -123,8 +124,11 @@ class EvalVE(object) :
         >>> sin2 = EvalVE( math.sin )  ## numerical derivative will be used 
         """
         self.__func  = func
+        self.__dkey  = False ## use the process-wide cache for the derivatives?
         if    deriv and callable ( deriv ) : self.__derivative = deriv
-        else                               : self.__derivative = Derivative(func)
+        else                               :
+            self.__derivative = Derivative(func)
+            self.__dkey       = True 
             
         if   name                          : self.__name__ =  name 
         elif hasattr ( func , '__name__' ) and '<lambda>' != func.__name__ :
@@ -141,8 +145,12 @@ class EvalVE(object) :
         return self.__func( float ( x ) , *args , **kwargs )
     ## get a value of derivative
     def derivative_eval  ( self , x , args = () , kwargs = {} ) :
-        """Evalaute the derivative"""
-        return self.__derivative ( float ( x ) , *args , **kwargs )
+        """Evalaute the derivative
+        - numerical derivatives are kept in the process-wide cache (ostap.math.cache)
+        """
+        x   = float ( x ) 
+        key = make_key ( 'derivative' , self.__func , x , args , kwargs ) if self.__dkey else None
+        return the_cache.get ( key , lambda : self.__derivative ( x , *args , **kwargs ) )
     
     # =========================================================================
     ## Evaluate the function taking into account uncertainty in the argument
@@ -222,14 +230,18 @@ class  EvalNVE(object) :
         self.__N    = N
         
         derivatives = []
+        numerical   = [] 
         for i in  range ( N ) :
             
             if i < len ( partial ) and callable ( partial [ i ] ) : d_i = partial [i] 
-            else                                                  : d_i = PartialDerivative ( i , func )
+            else                                                  :
+                d_i = PartialDerivative ( i , func )
+                numerical.append ( i ) 
                 
             derivatives.append ( d_i )
             
-        self.__partial = tuple (  derivatives )
+        self.__partial   = tuple (  derivatives )
+        self.__numerical = frozenset ( numerical ) ## cached in the process-wide cache 
 
         if   name  : self.__name__  =  name 
         elif hasattr ( func , '__name__' ) and '<lambda>' != func.__name__ :
@@ -269,7 +281,18 @@ class  EvalNVE(object) :
 
         xx = tuple ( VE(i).value() for i in x )
 
-        return darray ( self.partial[i](*xx) for i in range ( n ) ) 
+        return darray ( self.partial_eval ( i , *xx ) for i in range ( n ) ) 
+
+    # =========================================================================
+    ## evaluate the partial derivative
+    #  numerical derivatives are kept in the process-wide cache
+    #  @see ostap.math.cache.the_cache 
+    def partial_eval ( self , i , *x ) :
+        """Evaluate the partial derivative
+        - numerical derivatives are kept in the process-wide cache (ostap.math.cache)
+        """
+        key = make_key ( 'partial' , self.__func , i , x ) if i in self.__numerical else None
+        return the_cache.get ( key , lambda : self.partial [ i ] ( *x ) )
         
     # =========================================================================
     ## the main method (assume that all x are independent) 
@@ -295,7 +318,7 @@ class  EvalNVE(object) :
             if c2 <= 0 or iszero ( c2 ) : continue
 
             ## calculate the partical derivative 
-            df = self.partial [ i ] ( *xv ) 
+            df = self.partial_eval ( i , *xv ) 
             if iszero ( df )            : continue 
 
             ## update covariance for result 
@@ -412,8 +435,8 @@ class Eval2VE(EvalNVE) :
         #
         ## here we need to calculate the uncertainties
         # 
-        dx   = self.partial[0] ( xv , yv ) if not x_plain else 0 
-        dy   = self.partial[1] ( xv , yv ) if not y_plain else 0 
+        dx   = self.partial_eval ( 0 , xv , yv ) if not x_plain else 0 
+        dy   = self.partial_eval ( 1 , xv , yv ) if not y_plain else 0 
         #
         
         cov2 = dx * dx * xc2 + dy * dy * yc2
@@ -479,7 +502,7 @@ class EvalNVEcov(EvalNVE) :
         
         for i in range ( n ) :
 
-            di    = self.partial[i] ( *args )
+            di    = self.partial_eval ( i , *args )
             if iszero ( di ) : continue
             
             g [i] = di  
@@ -560,7 +583,7 @@ class EvalNVEcor(EvalNVEcov) :
             ci    = xi.cov2()
             if ci < 0  or iszero ( ci ) : continue
             
-            di    = self.partial[i] ( *args )
+            di    = self.partial_eval ( i , *args )
             if iszero ( di )            : continue
             
             ei    = xi.error() 
@@ -66,13 +66,22 @@ __all__     = (
     'complex_circle_integral'  , ## integrate complex function over the circle arc in complex plance
     'complex_polygon_integral' , ## integrate complex function over the closed polygon in complex plance
     ##
+    'integration_cache_stat'   , ## statistics of the (C++) integration caches 
+    ##
     ) 
 # =============================================================================
 import ROOT, warnings, math 
 from   builtins        import range
 from   ostap.math.ve   import VE
 from   ostap.math.base import isequal, iszero
-from   ostap.core.core import items_loop 
+from   ostap.core.core import items_loop, Ostap 
+from   ostap.math.cache import the_cache, make_key 
+from   ostap.math.native import native_function 
+# =============================================================================
+try :
+    import numpy as np
+except ImportError :
+    np = None
 # =============================================================================
 # logging 
 # =============================================================================
@@ -244,7 +253,11 @@ try :
         
         >>> func = lambda x : x * x 
         >>> v = integral(func,0,1)
+        - for compiled functions (numba.cfunc, ctypes, cffi) the native C++ integration is used 
         """
+        if not args :
+            r = _native_integral_ ( fun , xmin , xmax )
+            if r : return VE ( r [ 0 ] , r [ 1 ] * r [ 1 ] ) if err else r [ 0 ]
         func   = lambda x : float ( fun ( x , *args ) ) 
         import warnings
         with warnings.catch_warnings():
@@ -281,6 +294,147 @@ _l4  = math.sqrt ( 9/10. )
 _l5  = math.sqrt ( 9/19. )
 del _w,_wp
 # =============================================================================
+## nodes (in units of half-widths) and weights of Genz&Malik's basic rule
+#  for N-dimensional cubature: used for the vectorized evaluation
+#  @code
+#  nodes, w7, w5 = _gm_nodes_ ( 2 )  ## nodes.shape = ( 2 , 17 ) 
+#  @endcode 
+def _gm_nodes_ ( N ) :
+    """Nodes (in units of half-widths) and weights of Genz&Malik's basic rule
+    for N-dimensional cubature: used for the vectorized evaluation
+    >>> nodes, w7, w5 = _gm_nodes_ ( 2 )  ## nodes.shape = ( 2 , 17 ) 
+    """
+    import itertools
+    w , wp = ( _w2 , _w2p ) if 2 == N else ( _w3 , _w3p )
+    nodes  = [ ( 0.0 , ) * N ]
+    w7     = [ w  [ 0 ] ]
+    w5     = [ wp [ 0 ] ] 
+    ## s2 & s3: points on axes 
+    for l , q7 , q5 in ( ( _l2 , w [ 1 ] , wp [ 1 ] ) , ( _l3 , w [ 2 ] , wp [ 2 ] ) ) :
+        for k in range ( N ) :
+            for sk in ( 1 , -1 ) :
+                p = [ 0.0 ] * N
+                p [ k ] = sk * l 
+                nodes.append ( p ) ; w7.append ( q7 ) ; w5.append ( q5 ) 
+    ## s4: points on the planes 
+    for i , j in itertools.combinations ( range ( N ) , 2 ) :
+        for si , sj in itertools.product ( ( 1 , -1 ) , repeat = 2 ) :
+            p = [ 0.0 ] * N
+            p [ i ] = si * _l4
+            p [ j ] = sj * _l4
+            nodes.append ( p ) ; w7.append ( w [ 3 ] ) ; w5.append ( wp [ 3 ] )
+    ## s5: corners 
+    for signs in itertools.product ( ( 1 , -1 ) , repeat = N ) :
+        nodes.append ( [ s * _l5 for s in signs ] ) ; w7.append ( w [ 4 ] / 2**N ) ; w5.append ( 0.0 )
+    ## 
+    return np.array ( nodes , dtype = float ).T , np.array ( w7 ) , np.array ( w5 ) 
+
+_gm2_nodes = _gm_nodes_ ( 2 ) if np else None
+_gm3_nodes = _gm_nodes_ ( 3 ) if np else None
+# =============================================================================
+## Genz&Malik's basic rule for several regions with one (vectorized) call
+#  of the integrand: the integrand is called with numpy arrays of the nodes
+#  @code
+#  func    = lambda x,y : x*x + y*y     ## numpy-aware function 
+#  results = _gm_batch_ ( func , [ ( (-1,0) , (-1,1) ) , ( (0,1) , (-1,1) ) ] , _gm2_nodes )
+#  for i7, i5 in results : ...
+#  @endcode
+#  @attention <code>TypeError</code> is raised if the function is not vectorized 
+def _gm_batch_ ( func , regions , nodes , args = () ) :
+    """Genz&Malik's basic rule for several regions with one (vectorized) call
+    of the integrand: the integrand is called with numpy arrays of the nodes
+    >>> func    = lambda x,y : x*x + y*y     ## numpy-aware function 
+    >>> results = _gm_batch_ ( func , [ ( (-1,0) , (-1,1) ) , ( (0,1) , (-1,1) ) ] , _gm2_nodes )
+    >>> for i7, i5 in results : ...
+    - attention: `TypeError` is raised if the function is not vectorized 
+    """
+    units , w7 , w5 = nodes
+    N , K  = units.shape
+    lims   = np.asarray ( regions , dtype = float )                  ## shape: (R,N,2)
+    centre = 0.5 * ( lims [ : , : , 1 ] + lims [ : , : , 0 ] )      ## shape: (R,N)
+    delta  = 0.5 * ( lims [ : , : , 1 ] - lims [ : , : , 0 ] )      ## shape: (R,N)
+    points = centre [ : , : , None ] + delta [ : , : , None ] * units [ None , : , : ] 
+    R      = len ( lims ) 
+    coords = [ points [ : , k , : ].ravel () for k in range ( N ) ] 
+    values = np.asarray ( func ( *( coords + list ( args ) ) ) , dtype = float )
+    if values.shape != ( R * K , ) :
+        raise TypeError ( "The function is not vectorized: shape %s" % str ( values.shape ) )
+    values = values.reshape ( R , K )
+    volume = np.prod ( 2 * delta , axis = 1 )
+    return list ( zip ( volume * values.dot ( w7 ) , volume * values.dot ( w5 ) ) ) 
+
+# =============================================================================
+## cache of the native C++ cubatures for the C++ functor types 
+_cpp_cubatures = {}
+# =============================================================================
+## Native C++ cubature for C++ (Ostap/ROOT) functors
+#  @code
+#  fun = Ostap.Math.Bernstein2D ( ... ) 
+#  r   = _cpp_cubature_ ( 'cubature2' , fun , 0 , 1 , 0 , 1 , 1.e-8 , 1.e-8 )
+#  if r : value, error = r 
+#  @endcode
+#  @return (value,error) or <code>None</code> if the native cubature is not applicable
+#  @see Ostap::Math::Integrator::cubature2 
+#  @see Ostap::Math::Integrator::cubature3 
+def _cpp_cubature_ ( method , func , *limits ) :
+    """Native C++ cubature for C++ (Ostap/ROOT) functors
+    >>> fun = Ostap.Math.Bernstein2D ( ... ) 
+    >>> r   = _cpp_cubature_ ( 'cubature2' , fun , 0 , 1 , 0 , 1 , 1.e-8 , 1.e-8 )
+    >>> if r : value, error = r 
+    - return (value,error) or None if the native cubature is not applicable
+    - see Ostap::Math::Integrator::cubature2 
+    - see Ostap::Math::Integrator::cubature3 
+    - the compiled functions (numba.cfunc, ctypes, cffi) are wrapped into C++ functors
+    """
+    native = native_function ( func )
+    if native : func = native 
+    ftype = type ( func )
+    cname = getattr ( ftype , '__cpp_name__' , None )
+    if not cname : return None
+    key   = method , ftype
+    if not key in _cpp_cubatures :
+        try :
+            _cpp_cubatures [ key ] = getattr ( Ostap.Math.Integrator , method ) [ cname ]
+        except Exception :
+            _cpp_cubatures [ key ] = None
+    cubature = _cpp_cubatures [ key ]
+    if cubature is None : return None
+    try :
+        result = cubature ( func , *limits )
+    except TypeError : ## e.g. functor of the wrong dimension: no instantiation 
+        _cpp_cubatures [ key ] = None
+        return None
+    return result.first , result.second 
+# =============================================================================
+## Native C++ integration of the compiled 1D-function (numba.cfunc, ctypes, cffi)
+#  over the finite interval: no Python calls and no GIL 
+#  @code
+#  @numba.cfunc ( "float64(float64)" )
+#  def fun ( x ) : return x * x 
+#  r   = _native_integral_ ( fun , 0 , 1 )
+#  if r : value, error = r 
+#  @endcode
+#  @return (value,error) or <code>None</code> if the native integration is not applicable
+#  @see Ostap::Functions::NativeFunction1
+#  @see Ostap::Math::Integrator::integrate_
+def _native_integral_ ( func , xmin , xmax ) :
+    """Native C++ integration of the compiled 1D-function (numba.cfunc, ctypes, cffi)
+    over the finite interval: no Python calls and no GIL 
+    >>> @numba.cfunc ( 'float64(float64)' )
+    ... def fun ( x ) : return x * x 
+    >>> r   = _native_integral_ ( fun , 0 , 1 )
+    >>> if r : value, error = r 
+    - return (value,error) or None if the native integration is not applicable
+    - see Ostap::Functions::NativeFunction1
+    - see Ostap::Math::Integrator::integrate_
+    """
+    native = native_function ( func )
+    if not isinstance ( native , Ostap.Functions.NativeFunction1 ) : return None
+    if not math.isfinite ( xmin ) or not math.isfinite ( xmax )   : return None
+    result = Ostap.Math.Integrator.integrate_ ( native.function () , xmin , xmax ,
+                                                Ostap.Math.WorkSpace () , native.tag () )
+    return result.first , result.second 
+# =============================================================================
 ## Genz&Malik's basic rule for N=2 cubature
 #  A.C. Genz, A.A. Malik, ``Remarks on algorithm 006: An adaptive algorithm for
 #  numerical integration over an N-dimensional rectangular region'',
@@ -495,7 +649,8 @@ def _split3_ ( xlims , ylims , zlims ) :
 #  @see https://doi.org/10.1016/0771-050X(80)90039-X.
 #  @see http://www.sciencedirect.com/science/article/pii/0771050X8090039X)
 def _genzmalik_( func , limits , basic_rule , splitter ,
-                 args = () ,  epsabs = 1.5e-7 , epsrel = 1.5e-7 ) :
+                 args = () ,  epsabs = 1.5e-7 , epsrel = 1.5e-7 ,
+                 nodes = None , vectorized = None ) :
     """Driving routine for Adaptive numerical 2D/3D integration using Genz&Malik's basic rule
     
     A.C. Genz, A.A. Malik, ``Remarks on algorithm 006: An adaptive algorithm for
@@ -504,11 +659,22 @@ def _genzmalik_( func , limits , basic_rule , splitter ,
     ISSN 0377-0427
     - see https://doi.org/10.1016/0771-050X(80)90039-X.
     - see http://www.sciencedirect.com/science/article/pii/0771050X8090039X)
+    - nodes      : nodes and weights for the vectorized evaluation, see `_gm_nodes_`
+    - vectorized : call the integrand with arrays of nodes? (None: try it) 
     """
 
-    i7,i5 = basic_rule ( func , *limits , args = args )
+    first = None
+    if nodes is not None and vectorized in ( None , True ) :
+        try :
+            first = _gm_batch_ ( func , ( limits , ) , nodes , args ) [ 0 ]
+        except Exception :
+            if vectorized : raise
+    vectorized = first is not None 
     
-    nfc   = 17
+    i7,i5 = first if vectorized else basic_rule ( func , *limits , args = args )
+
+    nn    = 17 if 2 == len ( limits ) else 33 ## number of nodes 
+    nfc   = nn 
     
     err     =  abs ( i7 -  i5 )
     relerr  =  0.5 *  ( abs(i7) + abs(i5) ) * epsrel 
@@ -552,10 +718,15 @@ def _genzmalik_( func , limits , basic_rule , splitter ,
         if not rmx : break     # BREAK 
         
         rr = splitter ( *rmx )
-        for r in  rr :
-            r7,r5  = basic_rule (  func , *r , args = args )
-            nfc   += 17 
-            stack[ r ] = abs(r7-r5),r7
+        if vectorized : ## all sub-regions with one call 
+            for r , ( r7 , r5 ) in zip ( rr , _gm_batch_ ( func , rr , nodes , args ) ) :
+                nfc   += nn 
+                stack[ r ] = abs(r7-r5),r7
+        else :
+            for r in  rr :
+                r7,r5  = basic_rule (  func , *r , args = args )
+                nfc   += nn 
+                stack[ r ] = abs(r7-r5),r7
         # remove large region from the stack 
         del stack[rmx]            
 
@@ -578,7 +749,7 @@ def _genzmalik_( func , limits , basic_rule , splitter ,
 #  r      = genzmalik2 ( func , xmin=-1 , xmax=2 , ymin=-1 , ymax=2 )
 #  print 'Integral: %s ' % r 
 #  @endcode 
-def genzmalik2 ( func , xmin , xmax , ymin ,  ymax , args = () , err = False , epsabs = 1.5e-7 , epsrel = 1.5e-7 ) :
+def genzmalik2 ( func , xmin , xmax , ymin ,  ymax , args = () , err = False , epsabs = 1.5e-7 , epsrel = 1.5e-7 , vectorized = None ) :
     """ Adaptive numerical 2D integration using Genz&Malik's basic rule
     
     A.C. Genz, A.A. Malik, ``Remarks on algorithm 006: An adaptive algorithm for
@@ -594,11 +765,19 @@ def genzmalik2 ( func , xmin , xmax , ymin ,  ymax , args = () , err = False , e
     >>> func   = lambda x,y : x*x + y*y
     >>> r      = genzmalik2 ( func , xmin=-1 , xmax=2 , ymin=-1 , ymax=2 )
     >>> print 'Integral: %s ' % r 
-    
+
+    - for C++ (Ostap/ROOT) functors the native C++ cubature is used
+    - numpy-aware functions are called once per region with arrays of nodes
+      (`vectorized`: None - try it, True - force, False - point-by-point)
     """
 
+    if not args :
+        r = _cpp_cubature_ ( 'cubature2' , func , xmin , xmax , ymin , ymax , abs(epsabs) , abs(epsrel) )
+        if r : return VE ( r[0] , r[1] * r[1] ) if err else r[0]
+        
     limits  = ( xmin , xmax ) , ( ymin , ymax ) 
-    r,e,n,s = _genzmalik_ ( func , limits , _genzmalik2_ , _split2_ , args , abs(epsabs) , abs(epsrel) )
+    r,e,n,s = _genzmalik_ ( func , limits , _genzmalik2_ , _split2_ , args , abs(epsabs) , abs(epsrel) ,
+                            nodes = _gm2_nodes , vectorized = vectorized )
     
     return VE ( r , e * e )  if err else r 
 
@@ -616,7 +795,7 @@ def genzmalik2 ( func , xmin , xmax , ymin ,  ymax , args = () , err = False , e
 #  r      = genzmalik3 ( func , xmin=-1 , xmax=2 , ymin=-1 , ymax=2 , zmin = -4, zmax = 7)
 #  print 'Integral: %s ' % r 
 #  @endcode 
-def genzmalik3 ( func , xmin , xmax , ymin ,  ymax , zmin ,  zmax , args = () , err = False , epsabs = 1.5e-7 , epsrel = 1.5e-7 ) :
+def genzmalik3 ( func , xmin , xmax , ymin ,  ymax , zmin ,  zmax , args = () , err = False , epsabs = 1.5e-7 , epsrel = 1.5e-7 , vectorized = None ) :
     """ Adaptive numerical 3D integration using Genz&Malik's basic rule
     
     A.C. Genz, A.A. Malik, ``Remarks on algorithm 006: An adaptive algorithm for
@@ -632,11 +811,19 @@ def genzmalik3 ( func , xmin , xmax , ymin ,  ymax , zmin ,  zmax , args = () ,
     >>> func   = lambda x,y : x*x + y*y + z*z 
     >>> r      = genzmalik3 ( func , xmin=-1 , xmax=2 , ymin=-1 , ymax=2 , zmin = -4, zmax = 7)
     >>> print 'Integral: %s ' % r 
-    
+
+    - for C++ (Ostap/ROOT) functors the native C++ cubature is used
+    - numpy-aware functions are called once per region with arrays of nodes
+      (`vectorized`: None - try it, True - force, False - point-by-point)
     """
 
+    if not args :
+        r = _cpp_cubature_ ( 'cubature3' , func , xmin , xmax , ymin , ymax , zmin , zmax , abs(epsabs) , abs(epsrel) )
+        if r : return VE ( r[0] , r[1] * r[1] ) if err else r[0]
+
     limits  = ( xmin , xmax ) , ( ymin , ymax ) , ( zmin , zmax ) 
-    r,e,n,s = _genzmalik_ ( func , limits , _genzmalik3_ , _split3_ , args , abs(epsabs) , abs(epsrel) )
+    r,e,n,s = _genzmalik_ ( func , limits , _genzmalik3_ , _split3_ , args , abs(epsabs) , abs(epsrel) ,
+                            nodes = _gm3_nodes , vectorized = vectorized )
     
     return VE ( r , e * e )  if err else r 
 
@@ -663,7 +850,12 @@ try :
         
         >>> func = lambda x,y : x*x+y*y 
         >>> v = integral2(func,0,1,-2,2)
+        - for C++ (Ostap/ROOT) functors the native C++ cubature is used 
         """
+        if not args :
+            r = _cpp_cubature_ ( 'cubature2' , fun , xmin , xmax , ymin , ymax ,
+                                 kwargs.get ( 'epsabs' , 1.49e-8 ) , kwargs.get ( 'epsrel' , 1.49e-8 ) )
+            if r : return VE ( r[0] , r[1] * r[1] ) if err else r[0]
         func   = lambda x,y : float ( fun ( x , y , *args ) ) 
         import warnings
         with warnings.catch_warnings():
@@ -704,7 +896,12 @@ try :
         
         >>> func = lambda x,y,z : x*x+y*y+z*z
         >>> v = integral3(func,0,1,0,2,0,3)
+        - for C++ (Ostap/ROOT) functors the native C++ cubature is used 
         """
+        if not args :
+            r = _cpp_cubature_ ( 'cubature3' , fun , xmin , xmax , ymin , ymax , zmin , zmax ,
+                                 kwargs.get ( 'epsabs' , 1.49e-8 ) , kwargs.get ( 'epsrel' , 1.49e-8 ) )
+            if r : return VE ( r[0] , r[1] * r[1] ) if err else r[0]
         func   = lambda x,y,z : float ( fun ( x , y , z , *args ) ) 
         import warnings
         with warnings.catch_warnings():
@@ -767,6 +964,21 @@ class IntegralBase(object) :
                            ymn , ymx   ,
                            zmn , zmx   ,
                            args = args , err = self.err , **self.kwargs )
+
+    ## Partial integration of 3D C++ functor via the native C++ cubature
+    #  @return the integral or <code>None</code> if not applicable
+    #  @see Ostap::Math::Integrator::cubature3XY 
+    def _integrate_3D_partial_ ( self , method , value , amn , amx , bmn , bmx , args = () ) :
+        """Partial integration of 3D C++ functor via the native C++ cubature
+        - return the integral or None if not applicable
+        - see Ostap::Math::Integrator::cubature3XY 
+        """
+        if args or self.args : return None
+        r = _cpp_cubature_ ( method , self.func , value , amn , amx , bmn , bmx ,
+                             self.kwargs.get ( 'epsabs' , 1.49e-8 ) ,
+                             self.kwargs.get ( 'epsrel' , 1.49e-8 ) )
+        if not r : return None
+        return VE ( r[0] , r[1] * r[1] ) if self.err else r[0]
     
     @property
     def func ( self ) :
@@ -840,6 +1052,10 @@ class Integral(IntegralBase) :
 #  >>> iint  = IntegralCache(func,0) ## specify x_low 
 #  >>> value = iint  ( 10 )          ## specify x_hgh 
 #  @endcode 
+#  The results are kept in the process-wide size-bounded cache,
+#  shared between all instances, for C++ functors with <code>tag</code> and
+#  <code>integral</code> methods (Ostap functions) the C++ integration cache is used 
+#  @see ostap.math.cache.the_cache 
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
 #  @date   2014-06-06
 class IntegralCache(Integral) :
@@ -847,6 +1063,10 @@ class IntegralCache(Integral) :
     >>> func   = lambda x : x*x 
     >>> iint   = IntegralCache ( func , 0 ) ## specify x_low 
     >>> value  = iint ( 10 )                ## specify x_high
+    The results are kept in the process-wide size-bounded cache,
+    shared between all instances, for C++ functors with `tag` and `integral`
+    methods (Ostap functions) the C++ integration cache is used 
+    - see ostap.math.cache.the_cache 
     """
     ## Calculate the integral for the 1D-function using scipy
     def __init__ ( self , func , xlow = 0 , args = () , err = False , **kwargs ) :
@@ -869,6 +1089,17 @@ class IntegralCache(Integral) :
         x      = float ( x )         
         xmn    = self.xmin
         delta  = 0.0
+
+        ## C++ functor: use C++ integration cache 
+        if not args and not self.args and not self.err and \
+           hasattr ( self.func , 'tag' ) and hasattr ( self.func , 'integral' ) and \
+           hasattr ( type ( self.func ) , '__cpp_name__' ) :
+            return self.func.integral ( xmn , x )
+        
+        ## the process-wide cache 
+        key = make_key ( 'integral' , self.func , xmn , x , args , self.args , self.err , self.kwargs )
+        found , result = the_cache.lookup ( key ) if key else ( False , None )
+        if found : return result 
         
         # Is there a good ``previos'' calculation ?
         if self.__prev :
@@ -891,7 +1122,8 @@ class IntegralCache(Integral) :
         
         # fill the cache 
         self.__prev = args , x , result 
-            
+        if key : the_cache.insert ( key , result )
+        
         return result 
 
     @property
@@ -936,7 +1168,7 @@ class Integral2(Integral) :
         
     ## Calculate the integral for the 2D-function 
     def _integrate_ ( self , xmn , xmx , ymn , ymx , args = () ) :
-        args = args if  args else self._args 
+        args = args if  args else self.args 
         return integral2 ( self.func ,
                            xmn  , xmx ,
                            ymn  , ymx ,
@@ -953,7 +1185,7 @@ class Integral2(Integral) :
         """
         return self._integrate_2D_ ( self.func  ,
                                      self.xmin  , x ,
-                                     self._ymin , y , args = args )
+                                     self.ymin  , y , args = args )
 
     @property 
     def ymin ( self ) :
@@ -1339,6 +1571,11 @@ class Integrate3D_XY(Integrate3D_X) :
         >>> print fz ( 1 )                
 
         """
+        ## C++ functor: native C++ cubature 
+        r = self._integrate_3D_partial_ ( 'cubature3XY' , z ,
+                                          self.xmin , self.xmax ,
+                                          self.ymin , self.ymax , args = args )
+        if r is not None : return r 
         ## create the helper function 
         _funxy_ = lambda x , y , *_ : self.func ( x , y , z , *_ )
         ## make integration 
@@ -1400,6 +1637,11 @@ class Integrate3D_XZ(Integrate3D_X) :
         >>> print fy ( 1 )
 
         """
+        ## C++ functor: native C++ cubature 
+        r = self._integrate_3D_partial_ ( 'cubature3XZ' , y ,
+                                          self.xmin , self.xmax ,
+                                          self.zmin , self.zmax , args = args )
+        if r is not None : return r 
         # create the helper function 
         _funxz_ = lambda x , z , *_ : self.func ( x , y , z , *_ )
         # make integration 
@@ -1460,6 +1702,11 @@ class Integrate3D_YZ(Integrate3D_Y) :
         >>> fx     = Integral3D_YZ( fun3d , ymin = 0 , ymax = 1 , zmin = 0 , zmax = 1 )
         >>> print fx ( 1 )
         """
+        ## C++ functor: native C++ cubature 
+        r = self._integrate_3D_partial_ ( 'cubature3YZ' , x ,
+                                          self.ymin , self.ymax ,
+                                          self.zmin , self.zmax , args = args )
+        if r is not None : return r 
         # create the helper function 
         _funyz_ = lambda y , z , *_ : self.func ( x , y , z , *_ )
         # make integration 
@@ -1661,6 +1908,29 @@ def complex_circle_integral ( func                         ,
         err       = err                                                 ,
         **kwargs                                                        ) 
 
+# =============================================================================
+## get the statistics of the (C++) integration caches
+#  @code
+#  stat = integration_cache_stat ()
+#  print ( 'hits/misses/evictions: %(hits)d/%(misses)d/%(evictions)d' % stat ) 
+#  @endcode
+#  @see Ostap::Math::IntegrationCache
+def integration_cache_stat ( reset = False ) :
+    """Get the statistics of the (C++) integration caches
+    >>> stat = integration_cache_stat ()
+    >>> print ( 'hits/misses/evictions: %(hits)d/%(misses)d/%(evictions)d' % stat ) 
+    - see Ostap::Math::IntegrationCache
+    """
+    from ostap.core.core import Ostap
+    IC     = Ostap.Math.IntegrationCache
+    result = { 'hits'      : int ( IC.hits      () ) ,
+               'misses'    : int ( IC.misses    () ) ,
+               'evictions' : int ( IC.evictions () ) ,
+               'size'      : int ( IC.size      () ) ,
+               'caches'    : int ( IC.caches    () ) }
+    if reset : IC.reset ()
+    return result 
+    
 # =============================================================================
 if '__main__' == __name__ :
     
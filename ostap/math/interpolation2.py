@@ -3,28 +3,113 @@
 # =============================================================================
 ## @file ostap/math/interpolation2.py
 #  Module with some useful scipy-based utilities for dealing with interpolation.
+#  - also the fast C++ interpolation of the scattered 2D/3D data, see scattered 
 #  @author Vanya BELYAEV Ivan.Belyaev@cern.ch
 #  @date   2020-02-28
 # =============================================================================
 """Useful scipy-based utilities for dealing with interpolation.
+- also the fast C++ interpolation of the scattered 2D/3D data, see `scattered`
 """
 # =============================================================================
 __version__ = "$Revision$"
 __author__  = "Vanya BELYAEV Ivan.Belyaev@cern.ch"
 __date__    = "2018-07-22"
 __all__     = (
+    'scattered' , ## C++ interpolation of scattered 2D/3D data 
     )
 # =============================================================================
 from   ostap.logger.logger import getLogger
 if '__main__' ==  __name__ : logger = getLogger ( 'ostap.math.interpolation2' )
 else                       : logger = getLogger ( __name__                    )
 # =============================================================================
+import array 
+from   ostap.core.core     import Ostap
+from   ostap.math.base     import doubles 
+try :
+    import numpy as np
+except ImportError :
+    np = None 
+# =============================================================================
 try :
     from ostap.math.sp_interpolation import SplineInterpolator
-    __all__ =  'SplineInterpolator', 
+    __all__ = __all__ + ( 'SplineInterpolator', ) 
 except  ImportError :
     pass 
 
+# =============================================================================
+## Create the C++ interpolator for the scattered 2D/3D data 
+#  (modified Shepard's method with local linear nodal functions and k-d tree)
+#  @code
+#  calib = scattered ( ( xs , ys ) , values )         ## 2D 
+#  calib = scattered ( ( xs , ys , zs ) , values )    ## 3D 
+#  print ( calib ( 0.1 , 0.2 ) )
+#  res   = calib.evaluate_array ( qx , qy )           ## batched queries 
+#  @endcode
+#  The interpolator can be used as <code>Ostap::IFuncTree</code> e.g. for <code>add_new_branch</code>: 
+#  @code
+#  fun   = Ostap.Functions.Func2D ( calib , 'pt' , 'eta' )
+#  tree.add_new_branch ( 'calib' , fun ) 
+#  @endcode 
+#  @param points coordinates of the data points: ( xs , ys ) or ( xs , ys , zs )
+#  @param values values at the data points
+#  @param nw     number of neighbours for the interpolation (0: default)
+#  @param nq     number of neighbours for the nodal functions (0: default)
+#  @see Ostap::Math::Scattered2D
+#  @see Ostap::Math::Scattered3D
+def scattered ( points , values , nw = 0 , nq = 0 ) :
+    """Create the C++ interpolator for the scattered 2D/3D data 
+    (modified Shepard's method with local linear nodal functions and k-d tree)
+    >>> calib = scattered ( ( xs , ys ) , values )         ## 2D 
+    >>> calib = scattered ( ( xs , ys , zs ) , values )    ## 3D 
+    >>> print ( calib ( 0.1 , 0.2 ) )
+    >>> res   = calib.evaluate_array ( qx , qy )           ## batched queries 
+    
+    The interpolator can be used as `Ostap::IFuncTree` e.g. for `add_new_branch`: 
+    >>> fun   = Ostap.Functions.Func2D ( calib , 'pt' , 'eta' )
+    >>> tree.add_new_branch ( 'calib' , fun ) 
+    - see Ostap.Math.Scattered2D
+    - see Ostap.Math.Scattered3D
+    """
+    coords = [ doubles ( c ) for c in points ]
+    vals   = doubles ( values )
+    for c in coords :
+        assert len ( c ) == len ( vals ) , 'scattered: mismatch in array sizes!'
+    
+    if   2 == len ( coords ) : return Ostap.Math.Scattered2D ( coords [ 0 ] , coords [ 1 ] , vals , nw , nq )
+    elif 3 == len ( coords ) : return Ostap.Math.Scattered3D ( coords [ 0 ] , coords [ 1 ] , coords [ 2 ] , vals , nw , nq )
+    
+    raise TypeError ( 'scattered: invalid dimension %d' % len ( coords ) )
+
+# =============================================================================
+## Evaluate the scattered-data interpolation for arrays of points
+#  @code
+#  calib = scattered ( ( xs , ys ) , values )
+#  res   = calib.evaluate_array ( qx , qy )
+#  @endcode
+#  @return numpy array (or <code>array.array</code> if numpy is not available)
+def _sc_evaluate_array_ ( sc , *coords ) :
+    """Evaluate the scattered-data interpolation for arrays of points
+    >>> calib = scattered ( ( xs , ys ) , values )
+    >>> res   = calib.evaluate_array ( qx , qy )
+    - return numpy array (or `array.array` if numpy is not available)
+    """
+    assert len ( coords ) == sc.dim () , 'evaluate_array: invalid number of coordinates!'
+    if np :
+        xs     = [ np.ascontiguousarray ( c , dtype = np.float64 ) for c in coords ]
+        n      = len ( xs [ 0 ] )
+        result = np.zeros ( n , dtype = np.float64 )
+    else :
+        xs     = [ array.array ( 'd' , c ) for c in coords ]
+        n      = len ( xs [ 0 ] )
+        result = array.array ( 'd' , n * [ 0.0 ] )
+    for x in xs : assert len ( x ) == n , 'evaluate_array: mismatch in array sizes!'
+    
+    sc.evaluate ( n , *( xs + [ result ] ) )
+    return result 
+
+Ostap.Math.Scattered2D.evaluate_array = _sc_evaluate_array_
+Ostap.Math.Scattered3D.evaluate_array = _sc_evaluate_array_
+
 # =============================================================================
 if '__main__' == __name__ :
     
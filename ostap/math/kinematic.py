@@ -32,6 +32,14 @@ __all__     = (
     'kallen'      , ## Kallen ``lambda''/``triangle'' function
     'G'           , ## the basic universal 4-body function ``tetrahedron-function''
     ##
+    'mass_with_error'     , ## batched invariant mass with uncertainty
+    'pt_with_error'       , ## batched transverse momentum with uncertainty
+    'rapidity_with_error' , ## batched rapidity with uncertainty
+    ##
+    'kallen_array'        , ## batched (compensated) Kallen function
+    'q_s_array'           , ## batched two-body momenta
+    'G_array'             , ## batched (compensated) ``tetrahedron-function''
+    ##
     )
 # =============================================================================
 import ROOT, math
@@ -736,6 +744,162 @@ def G ( x , y , z , u , v , w ) :
     ##
     return result 
     
+# =============================================================================
+## helper to prepare the contiguous arrays of doubles for batched kinematics
+def _k_arrays_ ( n , *arrays ) :
+    """Helper to prepare the contiguous arrays of doubles for batched kinematics
+    """
+    try :
+        import numpy
+        result = [ numpy.ascontiguousarray ( a , dtype = float ).ravel() for a in arrays ]
+        output = numpy.zeros ( n , dtype = float ) , numpy.zeros ( n , dtype = float )
+    except ImportError :
+        from array import array 
+        result = [ a if isinstance ( a , array ) and 'd' == a.typecode else array ( 'd' , a ) for a in arrays ]
+        output = array ( 'd' , n * [ 0.0 ] ) , array ( 'd' , n * [ 0.0 ] )
+    assert all ( n <= len ( a ) for a in result [ : -1 ] ) , 'Invalid length of input arrays!'
+    assert 10 * n <= len ( result [ -1 ] )                , 'Invalid length of covariance array!'
+    return result , output 
+    
+# =============================================================================
+## Batched invariant mass with uncertainty for arrays of 4-momenta
+#  @code
+#  px , py , pz , e = ...            ## arrays of momenta components 
+#  cov              = ...            ## packed covariances, 10 elements per candidate
+#  mass , sigma     = mass_with_error ( px , py , pz , e , cov ) 
+#  @endcode
+#  The packed covariances are in the order of <code>ROOT::Math::MatRepSym</code>
+#  (e.g. <code>momCovMatrix().Array()</code>)
+#  @see Ostap::Kinematics::mass_with_error 
+def mass_with_error ( px , py , pz , e , cov ) :
+    """Batched invariant mass with uncertainty for arrays of 4-momenta
+    >>> px , py , pz , e = ...            ## arrays of momenta components 
+    >>> cov              = ...            ## packed covariances, 10 elements per candidate
+    >>> mass , sigma     = mass_with_error ( px , py , pz , e , cov ) 
+    The packed covariances are in the order of `ROOT::Math::MatRepSym`
+    - see Ostap.Kinematics.mass_with_error 
+    """
+    n = len ( px ) 
+    ( px , py , pz , e , cov ) , ( m , s ) = _k_arrays_ ( n , px , py , pz , e , cov )
+    Ostap.Kinematics.mass_with_error ( n , px , py , pz , e , cov , m , s )
+    return m , s 
+
+# =============================================================================
+## Batched transverse momentum with uncertainty for arrays of 4-momenta
+#  @code
+#  pt , sigma = pt_with_error ( px , py , cov ) 
+#  @endcode
+#  @see Ostap::Kinematics::pt_with_error 
+def pt_with_error ( px , py , cov ) :
+    """Batched transverse momentum with uncertainty for arrays of 4-momenta
+    >>> pt , sigma = pt_with_error ( px , py , cov ) 
+    - see Ostap.Kinematics.pt_with_error 
+    """
+    n = len ( px ) 
+    ( px , py , cov ) , ( pt , s ) = _k_arrays_ ( n , px , py , cov )
+    Ostap.Kinematics.pt_with_error ( n , px , py , cov , pt , s )
+    return pt  , s 
+
+# =============================================================================
+## Batched rapidity with uncertainty for arrays of 4-momenta
+#  @code
+#  y , sigma = rapidity_with_error ( pz , e , cov ) 
+#  @endcode
+#  @see Ostap::Kinematics::rapidity_with_error 
+def rapidity_with_error ( pz , e , cov ) :
+    """Batched rapidity with uncertainty for arrays of 4-momenta
+    >>> y , sigma = rapidity_with_error ( pz , e , cov ) 
+    - see Ostap.Kinematics.rapidity_with_error 
+    """
+    n = len ( pz ) 
+    ( pz , e , cov ) , ( y , s ) = _k_arrays_ ( n , pz , e , cov )
+    Ostap.Kinematics.rapidity_with_error ( n , pz , e , cov , y , s )
+    return y  , s 
+    
+# =============================================================================
+## helper to prepare the contiguous arrays of doubles for batched invariants
+#  (scalar arguments are kept as is) 
+def _k_invariants_ ( *args , **kwargs ) :
+    """Helper to prepare the contiguous arrays of doubles for batched invariants
+    (scalar arguments are kept as is, unless `broadcast=True`)
+    """
+    try :
+        import numpy
+        result = [ a if isinstance ( a , num_types ) else numpy.ascontiguousarray ( a , dtype = float ).ravel() for a in args ]
+        make   = lambda n , v = 0.0 : numpy.full ( n , v , dtype = float )
+    except ImportError :
+        from array import array 
+        result = [ a if isinstance ( a , num_types ) or ( isinstance ( a , array ) and 'd' == a.typecode ) else array ( 'd' , a ) for a in args ]
+        make   = lambda n , v = 0.0 : array ( 'd' , n * [ float ( v ) ] )
+    arrays = [ len ( a ) for a in result if not isinstance ( a , num_types ) ]
+    assert arrays , 'At least one argument must be an array!'
+    n = min ( arrays )
+    if kwargs.get ( 'broadcast' , False ) :
+        result = [ make ( n , a ) if isinstance ( a , num_types ) else a for a in result ]
+    return n , result , make ( n ) 
+
+# =============================================================================
+## Batched Kallen (``triangle'') function with the compensated arithmetic
+#  @code
+#  s   = ...                                  ## array of s 
+#  lam = kallen_array ( s , m1 ** 2 , m2 ** 2 ) 
+#  lam = kallen_array ( s , s1 , s2 )         ## all arguments are arrays  
+#  @endcode
+#  It stays accurate near the thresholds, where the naive formula 
+#  suffers from the catastrophic cancellations
+#  @see Ostap::Kinematics::triangle
+def kallen_array ( a , b , c ) :
+    """Batched Kallen (``triangle'') function with the compensated arithmetic
+    >>> s   = ...                                  ## array of s 
+    >>> lam = kallen_array ( s , m1 ** 2 , m2 ** 2 ) 
+    >>> lam = kallen_array ( s , s1 , s2 )         ## all arguments are arrays  
+    It stays accurate near the thresholds, where the naive formula 
+    suffers from the catastrophic cancellations
+    - see Ostap.Kinematics.triangle
+    """
+    scalars = isinstance ( b , num_types ) and isinstance ( c , num_types )
+    if scalars :
+        n , ( a , ) , result = _k_invariants_ ( a )
+        Ostap.Kinematics.triangle ( n , a , float ( b ) , float ( c ) , result )
+    else       :
+        n , ( a , b , c ) , result = _k_invariants_ ( a , b , c , broadcast = True )
+        Ostap.Kinematics.triangle ( n , a , b , c , result )
+    return result
+
+# =============================================================================
+## Batched momenta of two-body decays in the rest frame of the mother
+#  @code
+#  s  = ...                                  ## array of s 
+#  qs = q_s_array ( s , m1 ** 2 , m2 ** 2 )  ## zero below the threshold 
+#  @endcode
+#  @see Ostap::Kinematics::q_s
+def q_s_array ( s , m2_1 , m2_2 ) :
+    """Batched momenta of two-body decays in the rest frame of the mother
+    >>> s  = ...                                  ## array of s 
+    >>> qs = q_s_array ( s , m1 ** 2 , m2 ** 2 )  ## zero below the threshold 
+    - see Ostap.Kinematics.q_s
+    """
+    n , ( s , ) , result = _k_invariants_ ( s )
+    Ostap.Kinematics.q_s ( n , s , float ( m2_1 ) , float ( m2_2 ) , result )
+    return result 
+
+# =============================================================================
+## Batched universal four-particle ``tetrahedron-function'' with the compensated arithmetic
+#  Scalar arguments are broadcasted
+#  @code
+#  g = G_array ( s2 , s1 , m3**2 , m1**2 , s , m2**2 ) ## Dalitz plot: g <= 0 inside 
+#  @endcode
+#  @see Ostap::Kinematics::G
+def G_array ( x , y , z , u , v , w ) :
+    """Batched universal four-particle ``tetrahedron-function'' with the compensated arithmetic
+    Scalar arguments are broadcasted
+    >>> g = G_array ( s2 , s1 , m3**2 , m1**2 , s , m2**2 ) ## Dalitz plot: g <= 0 inside 
+    - see Ostap.Kinematics.G
+    """
+    n , args , result = _k_invariants_ ( x , y , z , u , v , w , broadcast = True )
+    Ostap.Kinematics.G ( n , *( args + [ result ] ) )
+    return result 
+    
 # =============================================================================
 if '__main__' == __name__ :
     
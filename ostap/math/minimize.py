@@ -813,6 +813,16 @@ else :
         >>> x = model.minimum () 
         >>>
         """
+        ## native C++ minimization for C++ functors
+        if not args :
+            from ostap.math.rootfinder import native_solver
+            solver = native_solver ( 'minimum' , fun )
+            if solver :
+                try :
+                    return solver ( fun , float ( xmin ) , float ( xmax ) )
+                except Exception :
+                    pass 
+                
         if x0 == None : x0 = 0.5 * ( xmin + xmax )
         
         import numpy as np
@@ -838,6 +848,16 @@ else :
         >>> x = model.maximum () 
         >>>
         """
+        ## native C++ maximization for C++ functors
+        if not args :
+            from ostap.math.rootfinder import native_solver
+            solver = native_solver ( 'maximum' , fun )
+            if solver :
+                try :
+                    return solver ( fun , float ( xmin ) , float ( xmax ) )
+                except Exception :
+                    pass 
+                
         funmin = lambda x , *a : -1.0 * ( float ( fun ( x , *a ) ) )
         return sp_minimum_1D ( funmin , xmin ,  xmax , x0 , *args )
     
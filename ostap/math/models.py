@@ -26,6 +26,12 @@ from    ostap.core.ostap_types import num_types, integer_types
 import  ostap.math.polynomials 
 import  ostap.math.reduce   
 import  ostap.math.derivative  as     D  
+import  array 
+# =============================================================================
+try :
+    import numpy as np
+except ImportError :
+    np = None
 # =============================================================================
 # logging 
 # =============================================================================
@@ -1056,6 +1062,7 @@ for model in ( Ostap.Math.Chebyshev              ,
                ## Ostap.Functions.PyCallable     , 
                Ostap.Math.Piecewise              , 
                Ostap.Math.ChebyshevApproximation ,
+               Ostap.Math.ChebyshevProxy         ,
                D.Derivative                      ,
                D.Derivative1                     ,
                D.Derivative2                     ,
@@ -1140,6 +1147,65 @@ for model in ( Ostap.Math.Chebyshev              ,
     if sp_solve      and not hasattr ( model , 'solve'   ) : model.solve   = sp_solve
 
 
+# =======================================================================================
+## Evaluate the function for the array of points using its C++ array-evaluation method
+#  @code
+#  fun = Ostap.Math.CrystalBall ( ... )
+#  xx  = numpy.linspace ( 0 , 10 , 1000 )
+#  yy  = fun.evaluate_array ( xx ) 
+#  @endcode
+#  @return numpy array (or <code>array.array('d')</code> if numpy is not available) 
+def _f_evaluate_array_ ( fun , x ) :
+    """Evaluate the function for the array of points using its C++ array-evaluation method
+    >>> fun = Ostap.Math.CrystalBall ( ... )
+    >>> xx  = numpy.linspace ( 0 , 10 , 1000 )
+    >>> yy  = fun.evaluate_array ( xx ) 
+    - return numpy array (or `array.array('d')` if numpy is not available) 
+    """
+    if np :
+        xx = np.ascontiguousarray ( x , dtype = np.float64 )
+        rr = np.zeros_like        ( xx )
+    else  :
+        xx = array.array ( 'd' , x )
+        rr = array.array ( 'd' , len ( xx ) * [ 0.0 ] )
+    fun.evaluate ( len ( xx ) , xx , rr )
+    return rr
+
+for model in ( Ostap.Math.Gauss                  ,
+               Ostap.Math.BifurcatedGauss        ,
+               Ostap.Math.Bukin                  ,
+               Ostap.Math.CrystalBall            ,
+               Ostap.Math.Needham                ,
+               Ostap.Math.CrystalBallRightSide   ,
+               Ostap.Math.CrystalBallDoubleSided ,
+               Ostap.Math.Apollonios             ,
+               Ostap.Math.Apollonios2            ,
+               Ostap.Math.StudentT               ,
+               Ostap.Math.SinhAsinh              ,
+               Ostap.Math.JohnsonSU              ,
+               Ostap.Math.Hyperbolic             ,
+               Ostap.Math.GenHyperbolic          ,
+               Ostap.Math.Voigt                  ,
+               Ostap.Math.PseudoVoigt            ,
+               Ostap.Math.Bernstein              ,
+               Ostap.Math.Positive               ,
+               Ostap.Math.PhaseSpacePol          ,
+               Ostap.Math.Polynomial             ,
+               Ostap.Math.ChebyshevSum           ,
+               Ostap.Math.LegendreSum            ,
+               Ostap.Math.HermiteSum             ,
+               Ostap.Math.BSpline                ,
+               Ostap.Math.Neville                ,
+               Ostap.Math.Lagrange               ,
+               Ostap.Math.Berrut1st              ,
+               Ostap.Math.Berrut2nd              ,
+               Ostap.Math.FloaterHormann         ,
+               Ostap.Math.Barycentric            ,
+               Ostap.Math.Newton                 ,
+               Ostap.Math.ChebyshevProxy         ,
+               Ostap.Math.Piecewise              ) :
+    model.evaluate_array = _f_evaluate_array_ 
+
 # =======================================================================================
 ## Special ``getattr'' for Bernstein dual basis functions: delegate the stuff to
 #  the underlying bernstein polynomial
@@ -2417,6 +2483,7 @@ _decorated_classes_ = set( [
     Ostap.Functions.PyCallable        , 
     Ostap.Math.Piecewise              , 
     Ostap.Math.ChebyshevApproximation ,
+    Ostap.Math.ChebyshevProxy         ,
     D.Derivative                      ,
     
     Ostap.Math.Multiply               ,
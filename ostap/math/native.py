@@ -0,0 +1,168 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file  ostap/math/native.py
+#  Native-call path for the compiled python callables:
+#  <code>numba.cfunc</code>, <code>ctypes</code> and <code>cffi</code>
+#  function pointers with signatures <code>double(double)</code>,
+#  <code>double(double,double)</code> and <code>double(double,double,double)</code>
+#  are wrapped into C++ functors, that call the function directly,
+#  without Python C-API and without GIL
+#  @code
+#  @numba.cfunc ( "float64(float64)" )
+#  def fun ( x ) : return x * x
+#  f = native_function ( fun )        ## Ostap::Functions::NativeFunction1
+#  v = integral ( fun , 0 , 1 )       ## native C++ integration
+#  c = Ostap.Functions.PyCallable ( f ) ## no Python calls
+#  @endcode
+#  @attention the function must be pure and thread-safe
+#  @see Ostap::Functions::NativeFunction1
+#  @see Ostap::Functions::NativeFunction2
+#  @see Ostap::Functions::NativeFunction3
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Native-call path for the compiled python callables:
+`numba.cfunc`, `ctypes` and `cffi` function pointers with signatures
+`double(double)`, `double(double,double)` and `double(double,double,double)`
+are wrapped into C++ functors, that call the function directly,
+without Python C-API and without GIL
+
+>>> @numba.cfunc ( 'float64(float64)' )
+... def fun ( x ) : return x * x
+>>> f = native_function ( fun )        ## Ostap::Functions::NativeFunction1
+>>> v = integral ( fun , 0 , 1 )       ## native C++ integration
+>>> c = Ostap.Functions.PyCallable ( f ) ## no Python calls
+
+- attention: the function must be pure and thread-safe
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'native_address'  , ## the address and the number of arguments of the compiled function
+    'native_function' , ## wrap the compiled function into C++ functor
+    'is_native'       , ## is it the compiled function (or its C++ wrapper)?
+    )
+# =============================================================================
+import ctypes
+from   ostap.core.core        import Ostap
+from   ostap.core.ostap_types import integer_types
+from   ostap.logger.logger    import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.math.native' )
+else                       : logger = getLogger ( __name__            )
+# =============================================================================
+## C++ wrappers for 1,2 and 3 arguments
+_native_types = { 1 : Ostap.Functions.NativeFunction1 ,
+                  2 : Ostap.Functions.NativeFunction2 ,
+                  3 : Ostap.Functions.NativeFunction3 }
+# =============================================================================
+## the address and the number of arguments for ctypes function pointer
+def _ctypes_address_ ( fun ) :
+    """The address and the number of arguments for ctypes function pointer"""
+    ftype    = type ( fun )
+    argtypes = fun.argtypes
+    if argtypes is None : argtypes = getattr ( ftype , '_argtypes_' , None )
+    restype  = getattr ( ftype , '_restype_' , None ) if fun.restype is None else fun.restype
+    if restype is not ctypes.c_double or argtypes is None : return None
+    if any ( a is not ctypes.c_double for a in argtypes ) : return None
+    return ctypes.cast ( fun , ctypes.c_void_p ).value , len ( argtypes )
+
+# =============================================================================
+_ffi = []
+## the address and the number of arguments for cffi function pointer
+def _cffi_address_ ( fun ) :
+    """The address and the number of arguments for cffi function pointer"""
+    if not _ffi :
+        try :
+            import cffi
+            _ffi.append ( cffi.FFI () )
+        except ImportError :
+            _ffi.append ( None )
+    ffi = _ffi [ 0 ]
+    if ffi is None : return None
+    try :
+        ct = ffi.typeof ( fun )
+    except TypeError :
+        return None
+    if 'pointer' == ct.kind : ct = ct.item
+    if 'function' != ct.kind or 'double' != ct.result.cname : return None
+    if any ( 'double' != a.cname for a in ct.args ) : return None
+    return int ( ffi.cast ( 'uintptr_t' , fun ) ) , len ( ct.args )
+
+# =============================================================================
+## get the address and the number of arguments of the compiled function
+#  - <code>numba.cfunc</code>
+#  - <code>ctypes</code> function pointer (with <code>argtypes</code> and <code>restype</code>)
+#  - <code>cffi</code> function pointer
+#  @code
+#  address , nargs = native_address ( fun )
+#  @endcode
+#  @return (address,nargs) or <code>None</code> if the function is not compiled
+#  or has an unsupported signature
+def native_address ( fun ) :
+    """Get the address and the number of arguments of the compiled function
+    - `numba.cfunc`
+    - `ctypes` function pointer (with `argtypes` and `restype`)
+    - `cffi` function pointer
+    >>> address , nargs = native_address ( fun )
+    - return (address,nargs) or None if the function is not compiled
+    or has an unsupported signature
+    """
+    ## numba.cfunc
+    cfun = getattr ( fun , 'ctypes'  , None )
+    addr = getattr ( fun , 'address' , None )
+    if isinstance ( cfun , ctypes._CFuncPtr ) and isinstance ( addr , integer_types ) :
+        r = _ctypes_address_ ( cfun )
+        return ( addr , r [ 1 ] ) if r else None
+    ## ctypes
+    if isinstance ( fun , ctypes._CFuncPtr ) : return _ctypes_address_ ( fun )
+    ## cffi
+    if type ( fun ).__module__ == '_cffi_backend' : return _cffi_address_ ( fun )
+    return None
+
+# =============================================================================
+## wrap the compiled function into C++ functor
+#  @code
+#  @numba.cfunc ( "float64(float64,float64)" )
+#  def fun ( x , y ) : return x * y
+#  f2 = native_function ( fun ) ## Ostap::Functions::NativeFunction2
+#  @endcode
+#  @return C++ functor or <code>None</code> if the function is not compiled
+#  @see Ostap::Functions::NativeFunction1
+#  @see Ostap::Functions::NativeFunction2
+#  @see Ostap::Functions::NativeFunction3
+def native_function ( fun ) :
+    """Wrap the compiled function into C++ functor
+    >>> @numba.cfunc ( 'float64(float64,float64)' )
+    ... def fun ( x , y ) : return x * y
+    >>> f2 = native_function ( fun ) ## Ostap::Functions::NativeFunction2
+    - return C++ functor or None if the function is not compiled
+    """
+    if isinstance ( fun , tuple ( _native_types.values () ) ) : return fun
+    r = native_address ( fun )
+    if not r : return None
+    address , nargs = r
+    if not nargs in _native_types :
+        logger.warning ( "native_function: unsupported number of arguments %d" % nargs )
+        return None
+    result = _native_types [ nargs ] ( address )
+    ## keep the compiled code alive
+    result._owner = fun
+    return result
+
+# =============================================================================
+## is it the compiled function (or its C++ wrapper)?
+def is_native ( fun ) :
+    """Is it the compiled function (or its C++ wrapper)?"""
+    return isinstance ( fun , tuple ( _native_types.values () ) ) or bool ( native_address ( fun ) )
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -8,8 +8,8 @@
 # 
 # - as      Legendre         sum  
 # - as      Chebyshev        sum  
-# - as      Fourier          sum  (relies on numpy.fft.rfft & numpy.linspace)
-# - as      Cosine/Fourier   sum  (relies on scipy.fftpack)
+# - as      Fourier          sum  (FFT via Ostap::Math::FourierSum::fit)
+# - as      Cosine/Fourier   sum  (FFT via Ostap::Math::CosineSum::fit)
 # - as      Bernstein/Bezier sum  
 # - as even Bernstein/Bezier sum  
 # 
@@ -41,8 +41,8 @@
 
 - as      Legendre         sum  
 - as      Chebyshev        sum  
-- as      Fourier          sum  (relies on numpy.fft.rfft & numpy.linspace)
-- as      Cosine/Fourier   sum  (relies on scipy.fftpack)
+- as      Fourier          sum  (FFT via Ostap::Math::FourierSum::fit)
+- as      Cosine/Fourier   sum  (FFT via Ostap::Math::CosineSum::fit)
 - as      Bernstein/Bezier sum  
 - as even Bernstein/Bezier sum  
 
@@ -82,6 +82,7 @@ import ROOT, ctypes
 # =============================================================================
 from   ostap.core.core         import cpp, Ostap
 from   ostap.core.ostap_types  import is_integer, num_types
+from   ostap.math.base         import doubles 
 import ostap.math.models
 # =============================================================================
 # logging 
@@ -264,47 +265,13 @@ def fourier_sum ( func , N , xmin , xmax , fejer = False ) :
 
     xmin,xmax = _get_xminmax_ ( func , xmin , xmax , 'fourier_sum' )
 
-    ## start to play with numpy 
-    import numpy
-    
-    ## 1) vectorize the function
-    vfunc = numpy.vectorize ( func ) 
-    
-    ## prepare sampling 
-    f_sample = 2 * N
-    t, dt    = numpy.linspace ( xmin , xmax , f_sample + 2, endpoint=False , retstep=True )
+    ## 1) prepare sampling (the periodic grid)
+    M      = 2 * N + 2
+    dx     = float ( xmax - xmin ) / M 
+    values = doubles ( [ float ( func ( xmin + i * dx ) ) for i in range ( M ) ] )
 
-    ## make Fast Fourier Transform 
-    y  = numpy.fft.rfft ( vfunc ( t ) ) ## / t.size
-    y *= 2.0 / t.size
-    
-    #
-    ## decode the results:
-    #
-    
-    a0 = y[0].real
-    a  = y[1:-1].real
-    b  = y[1:-1].imag
-
-    #
-    ## prepare the output
-    #
-    fsum = Ostap.Math.FourierSum ( N, xmin , xmax , fejer )
-
-    #
-    ## fill it!
-    #
-    fsum.setPar( 0, a0 )
-    for i in range ( 1 , N + 1 ) :
-        
-        if 0 == i % 2 :
-            fsum.setA ( i ,  a[i-1] )
-            fsum.setB ( i , -b[i-1] )
-        else          :
-            fsum.setA ( i , -a[i-1] )
-            fsum.setB ( i ,  b[i-1] )
-    
-    return fsum
+    ## 2) make Fast Fourier Transform 
+    return Ostap.Math.FourierSum.fit ( values , N , xmin , xmax , fejer )
 
 # =============================================================================
 ## make a function representation in terms of cosine Fourier series
@@ -330,27 +297,13 @@ def cosine_sum ( func , N , xmin , xmax , fejer = False ) :
 
     xmin,xmax = _get_xminmax_ ( func , xmin , xmax , 'cosine_sum' )
 
-    ## start to play with numpy 
-    import numpy
-    
-    ## 1) prepare sampling
-    t     = numpy.linspace ( xmin , xmax , N + 1 , endpoint=True )
-
-    ## 2) vectorize the function
-    vfunc = numpy.vectorize ( lambda x : float ( func ( x ) ) )
+    ## 1) prepare sampling (including both edges)
+    M      = max ( N , 1 ) 
+    dx     = float ( xmax - xmin ) / M 
+    values = doubles ( [ float ( func ( xmin + i * dx ) ) for i in range ( M + 1 ) ] )
 
-    ## make cosine fourier transform 
-    import scipy.fftpack 
-    r = scipy.fftpack.dct ( vfunc ( t ) , 1 ) / N 
-    
-    #
-    ## decode the results & prepare the output
-    #
-    csum = Ostap.Math.CosineSum ( N, xmin , xmax , fejer )
-    for i in range ( 0 , N + 1 ) : csum.setPar ( i , r[i] )
-
-    ##
-    return csum
+    ## 2) make cosine fourier transform (DCT-I)
+    return Ostap.Math.CosineSum.fit ( values , N , xmin , xmax , fejer )
 
 # =============================================================================
 ## BernsteinDualBasis 
@@ -10,6 +10,7 @@
 - bifurcated gaussian
 - gaussian using Ostap.Math.ValueWithError as  argument
 - poisson (missing in python random module)
+- counter-based reproducible streams with array fills 
 """
 # =============================================================================
 __author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
@@ -20,6 +21,7 @@ __all__ = (
     'bifur'    ,  ## bifurcated gaussian
     've_gauss' ,  ## gaussian using ValueWithError construction
     'poisson'  ,  ## poisson (missing in python random module) 
+    'random_stream' , ## counter-based reproducible stream of random numbers 
     )
 # =============================================================================
 import sys
@@ -138,6 +140,45 @@ ve_gauss = random.ve_gauss
 poisson  = random.poisson
 cauchy   = random.cauchy
 
+# =============================================================================
+## Get the counter-based (Philox4x32-10) reproducible stream of random numbers
+#  with the array fills
+#  @code
+#  rs = random_stream ( seed = 12345 , stream = jobid ) 
+#  u  = rs.uniforms ( 1000           ) ## std::vector<double> 
+#  g  = rs.gausses  ( 1000 , 0 , 1   ) 
+#  v  = rs.gausses  ( 1000 , VE(1,4) ) 
+#  b  = rs.bifurs   ( 1000 , 0 , -1 , 2 ) 
+#  p  = rs.poissons ( 1000 , 10.5    ) 
+#  x  = rs.gauss    ()  ## scalar interface 
+#  @endcode
+#  The streams with the same seed and different stream numbers
+#  (e.g. job identifiers) do not overlap 
+#  @param seed    the seed, if not specified, it is taken from <code>random</code>
+#  @param stream  the stream/substream number
+#  @see Ostap::Math::RandomStream
+#  @see Ostap::Math::Philox
+def random_stream ( seed = None , stream = 0 ) :
+    """Get the counter-based (Philox4x32-10) reproducible stream of random numbers
+    with the array fills
+    >>> rs = random_stream ( seed = 12345 , stream = jobid ) 
+    >>> u  = rs.uniforms ( 1000           ) ## std::vector<double> 
+    >>> g  = rs.gausses  ( 1000 , 0 , 1   ) 
+    >>> v  = rs.gausses  ( 1000 , VE(1,4) ) 
+    >>> b  = rs.bifurs   ( 1000 , 0 , -1 , 2 ) 
+    >>> p  = rs.poissons ( 1000 , 10.5    ) 
+    >>> x  = rs.gauss    ()  ## scalar interface 
+    The streams with the same seed and different stream numbers
+    (e.g. job identifiers) do not overlap 
+    - see Ostap.Math.RandomStream
+    - see Ostap.Math.Philox
+    """
+    from ostap.core.core import Ostap 
+    if seed is None : seed = random.getrandbits ( 63 )
+    assert 0 <= seed   , "random_stream: invalid seed %s"   % seed 
+    assert 0 <= stream , "random_stream: invalid stream %s" % stream 
+    return Ostap.Math.RandomStream ( seed , stream )
+
 # =============================================================================
 if '__main__' == __name__  :
     
@@ -79,6 +79,8 @@ __all__     = (
     'secant'             , ## single step of secant/regular falsi/inverse linear
     'bisection'          , ## single step of bisection
     'aitken_delta2'      , ## aitken delta2 acceleration process   
+    ## native C++ solvers 
+    'native_solver'      , ## native C++ solver for C++ functors 
 )
 # =============================================================================
 import sys, collections
@@ -1243,13 +1245,78 @@ def find_root ( f                   , ## the function
     
     return solver.find ( a , b )
 
+# =============================================================================
+## cache of the native C++ solvers for the C++ functor types 
+_cpp_solvers = {}
+# =============================================================================
+## Get the native C++ solver (root finding, minimization, mode, width, quantiles)
+#  for the C++ (Ostap/ROOT) functor: all iterations are performed in C++
+#  @code
+#  fun  = Ostap.Math.Gauss ( ... )
+#  root = native_solver ( 'root' , fun )
+#  if root : x = root ( fun , -1 , 1 ) 
+#  @endcode
+#  @param method the method of Ostap::Math::Solver1D:
+#         'root', 'solve', 'minimum', 'maximum', 'mode', 'width', 'quantile', 'quantiles'
+#  @param func   the C++ functor 
+#  @return the solver or <code>None</code> if the native solver is not applicable 
+#  @see Ostap::Math::Solver1D
+def native_solver ( method , func ) :
+    """Get the native C++ solver (root finding, minimization, mode, width, quantiles)
+    for the C++ (Ostap/ROOT) functor: all iterations are performed in C++
+    >>> fun  = Ostap.Math.Gauss ( ... )
+    >>> root = native_solver ( 'root' , fun )
+    >>> if root : x = root ( fun , -1 , 1 ) 
+    - method : the method of Ostap::Math::Solver1D:
+    'root', 'solve', 'minimum', 'maximum', 'mode', 'width', 'quantile', 'quantiles'
+    - return the solver or None if the native solver is not applicable 
+    - see Ostap::Math::Solver1D
+    """
+    ftype = type ( func )
+    cname = getattr ( ftype , '__cpp_name__' , None )
+    if not cname : return None
+    key   = method , ftype
+    if not key in _cpp_solvers :
+        try :
+            from ostap.math.base import Ostap 
+            _cpp_solvers [ key ] = getattr ( Ostap.Math.Solver1D , method ) [ cname ]
+        except Exception :
+            _cpp_solvers [ key ] = None
+    return _cpp_solvers [ key ]
+
 # =============================================================================
 try :
     import scipy.optimize
-    findroot = scipy.optimize.brentq 
+    _findroot = scipy.optimize.brentq 
 except ImportError :
     logger.warning ("scipy.optimize.brentq is not available, use local ``find_root''-replacement")
-    findroot = find_root
+    _findroot = find_root
+
+# =============================================================================
+## find the root of the function in the interval
+#  - for C++ functors the native Brent's solver is used
+#  - otherwise <code>scipy.optimize.brentq</code> or local <code>find_root</code>
+#  @code
+#  fun = ...
+#  x   = findroot ( fun , 0.0 , 1.0 ) 
+#  @endcode
+#  @see Ostap::Math::Solver1D::root 
+def findroot ( f , a , b , args = () , **kwargs ) :
+    """Find the root of the function in the interval
+    - for C++ functors the native Brent's solver is used
+    - otherwise `scipy.optimize.brentq` or local `find_root`
+    >>> fun = ...
+    >>> x   = findroot ( fun , 0.0 , 1.0 ) 
+    - see Ostap::Math::Solver1D::root 
+    """
+    if not args and not kwargs.get ( 'full_output' , False ) :
+        solver = native_solver ( 'root' , f )
+        if solver :
+            try :
+                return solver ( f , float ( a ) , float ( b ) )
+            except Exception :
+                pass 
+    return _findroot ( f , a , b , args = args , **kwargs ) 
 
 
 # =============================================================================
@@ -1268,6 +1335,14 @@ def sp_solve ( fun , xmin ,  xmax , C = 0 , args = () ) :
     ##
     if iszero ( C ) :
         return findroot ( fun , xmin ,  xmax , args = args )
+    ## 
+    if not args :
+        solver = native_solver ( 'solve' , fun )
+        if solver :
+            try :
+                return solver ( fun , float ( C ) , float ( xmin ) , float ( xmax ) )
+            except Exception :
+                pass 
     ##
     func = lambda x , *a : fun(x,*a)-C
     return findroot ( func , xmin ,  xmax , args = args )
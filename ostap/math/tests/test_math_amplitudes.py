@@ -0,0 +1,107 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+## @file ostap/math/tests/test_math_amplitudes.py
+#  Test module for Ostap::Math::AmplitudeSum
+# =============================================================================
+""" Test module for Ostap::Math::AmplitudeSum
+
+It tests the coherent sum of resonance amplitudes with per-event caching
+"""
+# =============================================================================
+from __future__ import print_function
+# =============================================================================
+import ROOT, random
+from   ostap.core.core        import Ostap
+from   ostap.utils.timing     import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'tests_math_amplitudes' )
+else                       : logger = getLogger ( __name__                )
+# =============================================================================
+
+VD = ROOT.std.vector('double')
+VC = ROOT.std.vector('std::complex<double>')
+
+# =============================================================================
+## cached amplitude sum vs the direct calculation
+def test_amplitude_sum () :
+    """Cached amplitude sum vs the direct calculation
+    """
+
+    m_pi = 0.1396
+    rho  = Ostap.Math.BreitWigner ( 0.770 , 0.150 , m_pi , m_pi , 1 )
+    f0   = Ostap.Math.BreitWigner ( 0.980 , 0.070 , m_pi , m_pi , 0 )
+
+    ND , NN = 2000 , 20000
+    dm1 , dm2 , nm1 , nm2 = VD () , VD () , VD () , VD ()
+    for i in range ( ND ) :
+        dm1.push_back ( random.uniform ( 0.3 , 1.4 ) )
+        dm2.push_back ( random.uniform ( 0.3 , 1.4 ) )
+    for i in range ( NN ) :
+        nm1.push_back ( random.uniform ( 0.3 , 1.4 ) )
+        nm2.push_back ( random.uniform ( 0.3 , 1.4 ) )
+
+    ## angular factors for the second resonance (normalization sample)
+    fn = VC ()
+    for i in range ( NN ) :
+        c = random.uniform ( -1 , 1 )
+        fn.push_back ( complex ( c , 0 ) )
+
+    amp = Ostap.Math.AmplitudeSum ( ND , NN )
+    i1  = amp.add ( rho , dm1 , nm1 )
+    i2  = amp.add ( f0  , dm2 , nm2 , complex ( 0.5 , 0.3 ) , VC () , fn )
+
+    assert 2 == amp.update () , 'All resonances must be calculated!'
+    assert 0 == amp.update () , 'Nothing must be recalculated!'
+
+    def direct () :
+        s  = 0.0
+        c1 , c2 = complex ( amp.coupling ( i1 ) ) , complex ( amp.coupling ( i2 ) )
+        r1 , r2 = amp.resonance ( i1 ) , amp.resonance ( i2 )
+        for e in range ( NN ) :
+            a  = c1 * complex ( r1.amplitude ( nm1 [ e ] ) )
+            a += c2 * complex ( r2.amplitude ( nm2 [ e ] ) ) * complex ( fn [ e ] )
+            s += abs ( a ) ** 2
+        return s / NN
+
+    n1 = amp.normalization ()
+    n2 = direct ()
+    logger.info ( 'Normalization: cached %.6g, direct %.6g' % ( n1 , n2 ) )
+    assert abs ( n1 - n2 ) <= 1.e-8 * abs ( n2 ) , 'Invalid normalization!'
+
+    ## change the coupling: no recalculation
+    amp.setCoupling ( i2 , complex ( -0.2 , 0.7 ) )
+    assert 0 == amp.update () , 'Nothing must be recalculated!'
+    n1 , n2 = amp.normalization () , direct ()
+    assert abs ( n1 - n2 ) <= 1.e-8 * abs ( n2 ) , 'Invalid normalization after coupling change!'
+
+    ## change the mass: only one resonance is recalculated
+    amp.resonance ( i1 ).setM0 ( 0.775 )
+    assert 1 == amp.update () , 'Only one resonance must be recalculated!'
+    n1 , n2 = amp.normalization () , direct ()
+    assert abs ( n1 - n2 ) <= 1.e-8 * abs ( n2 ) , 'Invalid normalization after mass change!'
+
+    values = amp.intensities ()
+    for e in range ( 0 , ND , 100 ) :
+        assert abs ( values [ e ] - amp.intensity ( e ) ) <= 1.e-10 * abs ( values [ e ] ) , \
+               'Invalid intensity!'
+
+    with timing ( 'NLL' , logger = logger ) :
+        for i in range ( 100 ) :
+            amp.setCoupling ( i2 , complex ( -0.2 , 0.7 + 0.001 * i ) )
+            nll = amp.nll ()
+    logger.info ( 'NLL=%.6g, fractions: %.4f %.4f' % ( nll , amp.fraction ( i1 ) , amp.fraction ( i2 ) ) )
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_amplitude_sum ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
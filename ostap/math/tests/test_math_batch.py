@@ -0,0 +1,470 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+## @file ostap/math/tests/test_math_batch.py
+# Test module for the array evaluation of some functions
+# (used for the batch evaluation of RooFit PDFs)
+# =============================================================================
+""" Test module for the array evaluation of some functions
+(used for the batch evaluation of RooFit PDFs)
+"""
+# =============================================================================
+import ROOT, random, math
+from   array                  import array
+from   ostap.core.pyrouts     import Ostap
+import ostap.math.models
+from   ostap.math.base        import doubles
+# ============================================================================
+from   ostap.logger.logger    import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.test_math_batch' )
+else                       : logger = getLogger ( __name__                )
+# ============================================================================
+
+# =============================================================================
+## compare the array and scalar evaluation
+def test_batch () :
+    """Compare the array and scalar evaluation
+    """
+
+    logger = getLogger ( 'test_batch' )
+
+    functions = [
+        ( 'BifurcatedGauss' , Ostap.Math.BifurcatedGauss        ( 5 , 1 , 2 )             ) ,
+        ( 'Bukin'           , Ostap.Math.Bukin                  ( 5 , 1 , 0.2 , 0.1 , 0.1 ) ) ,
+        ( 'CrystalBallDS'   , Ostap.Math.CrystalBallDoubleSided ( 5 , 1 , 1.5 , 2 , 2 , 3 ) ) ,
+        ( 'Apollonios2'     , Ostap.Math.Apollonios2            ( 5 , 1 , 2 , 1 )         ) ,
+        ( 'StudentT'        , Ostap.Math.StudentT               ( 5 , 1 , 3 )             ) ,
+        ( 'JohnsonSU'       , Ostap.Math.JohnsonSU              ( 5 , 1 , 1 , 0.5 )       ) ,
+        ( 'Bernstein'       , Ostap.Math.Bernstein              ( 3 , 0 , 10 )            ) ,
+        ( 'Positive'        , Ostap.Math.Positive               ( 3 , 0 , 10 )            ) ,
+        ( 'PhaseSpacePol'   , Ostap.Math.PhaseSpacePol          ( 1 , 9 , 2 , 3 , 3 )     ) ,
+        ( 'Gauss'           , Ostap.Math.Gauss                  ( 5 , 1 )                 ) ,
+        ( 'CrystalBall'     , Ostap.Math.CrystalBall            ( 5 , 1 , 1.5 , 2 )       ) ,
+        ( 'CrystalBallRS'   , Ostap.Math.CrystalBallRightSide   ( 5 , 1 , 1.5 , 2 )       ) ,
+        ( 'Needham'         , Ostap.Math.Needham                ( 5 , 1 )                 ) ,
+        ( 'Apollonios'      , Ostap.Math.Apollonios             ( 5 , 1 , 1.5 , 2 , 1 )   ) ,
+        ( 'SinhAsinh'       , Ostap.Math.SinhAsinh              ( 5 , 1 , 0.2 , 1.1 )     ) ,
+        ( 'Hyperbolic'      , Ostap.Math.Hyperbolic             ( 5 , 1 , 1 , 0.5 )       ) ,
+        ( 'GenHyperbolic'   , Ostap.Math.GenHyperbolic          ( 5 , 1 , 1 , 0.5 , 1 )   ) ,
+        ( 'Voigt'           , Ostap.Math.Voigt                  ( 5 , 0.5 , 0.4 )         ) ,
+        ( 'Voigt/narrow'    , Ostap.Math.Voigt                  ( 5 , 0.1 , 1.0 )         ) ,
+        ( 'PseudoVoigt'     , Ostap.Math.PseudoVoigt            ( 5 , 0.5 , 0.4 )         ) ,
+        ( 'Polynomial'      , Ostap.Math.Polynomial             ( 5 , 0 , 10 )            ) ,
+        ( 'ChebyshevSum'    , Ostap.Math.ChebyshevSum           ( 9 , 0 , 10 )            ) ,
+        ( 'LegendreSum'     , Ostap.Math.LegendreSum            ( 9 , 0 , 10 )            ) ,
+        ( 'HermiteSum'      , Ostap.Math.HermiteSum             ( 5 , 0 , 10 )            ) ,
+        ( 'BSpline'         , Ostap.Math.BSpline                ( 0 , 10 , 5 , 3 )        ) ,
+        ( 'BSpline/knots'   , Ostap.Math.BSpline                ( doubles ( 0 , 0.5 , 1 , 4 , 4.1 , 10 ) , 3 ) ) ,
+        ]
+
+    N  = 1000
+    xx = array ( 'd' , [ random.uniform ( -1 , 11 ) for i in range ( N ) ] )
+
+    for name , fun in functions :
+
+        for i in range ( 4 ) :
+            try :
+                fun.setPar ( i , random.uniform ( 0 , 1 ) )
+            except AttributeError :
+                pass
+
+        rr     = array ( 'd' , N * [ 0.0 ] )
+        fun.evaluate ( N , xx , rr )
+
+        dmax = max ( abs ( r - fun ( x ) ) / max ( 1.0 , abs ( r ) ) for x , r in zip ( xx , rr ) )
+        if 1.e-12 < dmax : logger.error   ( '%-16s : max difference %.3g' % ( name , dmax ) )
+        else             : logger.info    ( '%-16s : max difference %.3g' % ( name , dmax ) )
+
+        assert dmax < 1.e-12 , 'Array and scalar evaluations differ for %s' % name
+
+        ## python-side evaluation
+        yy   = fun.evaluate_array ( xx )
+        assert all ( a == b for a , b in zip ( yy , rr ) ) , 'evaluate_array differs for %s' % name
+
+# =============================================================================
+## fast Bessel functions for the generalized hyperbolic distribution 
+def test_batch_genhyperbolic () :
+    """Fast Bessel functions for the generalized hyperbolic distribution:
+    - compare the array evaluation (via the Chebyshev proxy or the elementary 
+      expressions for the half-integer orders) with the direct GSL evaluation
+    """
+    
+    logger = getLogger ( 'test_batch_genhyperbolic' )
+
+    N  = 1000
+    xx = array ( 'd' , [ random.uniform ( -5 , 15 ) for i in range ( N ) ] )
+    
+    for lam in ( 1.0 , 2.0 , -1.0 , -0.5 , 0.3 , 1.7 , -2.4 , 4.1 ) :
+        for zeta in ( 0.01 , 0.5 , 3.0 ) :
+            
+            fun = Ostap.Math.GenHyperbolic ( 5 , 1 , zeta , 0.3 , lam )
+            ## the direct evaluation (no proxy yet)
+            ref = [ fun ( x ) for x in xx ]
+            
+            rr  = array ( 'd' , N * [ 0.0 ] )
+            fun.evaluate ( N , xx , rr )
+            
+            dmax = max ( abs ( r - f ) / max ( f , 1.e-300 ) for r , f in zip ( rr , ref ) )
+            logger.info ( 'lambda=%+.1f zeta=%-4s : max relative difference %.3g' % ( lam , zeta , dmax ) )
+            assert dmax < 1.e-10 , 'Fast Bessel function is inaccurate for lambda=%s zeta=%s' % ( lam , zeta )
+
+            ## the same object: the normalization is the same 
+            assert abs ( fun.integral ( -50 , 60 ) - 1 ) < 1.e-6 , 'Invalid normalization!' 
+    
+# =============================================================================
+## compare the array and scalar evaluation for the distributions from Models.h,
+#  and the closed-form integrals for Tsallis and QGSM with the numerical ones 
+def test_batch_models () :
+    """Compare the array and scalar evaluation for the distributions from Models.h,
+    and the closed-form integrals for Tsallis and QGSM with the numerical ones 
+    """
+
+    logger = getLogger ( 'test_batch_models' )
+
+    functions = [
+        ( 'Gumbel'          , Ostap.Math.Gumbel        ( 5 , 1 )                 ) ,
+        ( 'GammaDist'       , Ostap.Math.GammaDist     ( 3 , 1.5 )               ) ,
+        ( 'GenGammaDist'    , Ostap.Math.GenGammaDist  ( 3 , 1.5 , 1.2 , 0.5 )   ) ,
+        ( 'Amoroso'         , Ostap.Math.Amoroso       ( 2 , 2 , 1.5 , 0.5 )     ) ,
+        ( 'LogGamma'        , Ostap.Math.LogGamma      ( 5 , 1 , 2 )             ) ,
+        ( 'BetaPrime'       , Ostap.Math.BetaPrime     ( 3 , 4 , 2 , 0.5 )       ) ,
+        ( 'Landau'          , Ostap.Math.Landau        ( 0.5 , 3 )               ) ,
+        ( 'Weibull'         , Ostap.Math.Weibull       ( 2 , 1.5 , 1 )           ) ,
+        ( 'Argus'           , Ostap.Math.Argus         ( 1.5 , 9 , 1 )           ) ,
+        ( 'Tsallis'         , Ostap.Math.Tsallis       ( 0.5 , 7 , 0.8 )         ) ,
+        ( 'QGSM'            , Ostap.Math.QGSM          ( 0.5 , 1.5 )             ) ,
+        ( 'TwoExpos'        , Ostap.Math.TwoExpos      ( 0.5 , 1 , 1 )           ) ,
+        ( 'Sigmoid'         , Ostap.Math.Sigmoid       ( 3 , 0 , 10 , 1.5 , 5 )  ) ,
+        ( 'CutOffGauss'     , Ostap.Math.CutOffGauss   ( True  , 5 , 1 )         ) ,
+        ( 'CutOffStudent'   , Ostap.Math.CutOffStudent ( False , 5 , 3 , 1 )     ) ,
+        ]
+
+    N  = 1000
+    xx = array ( 'd' , [ random.uniform ( -1 , 11 ) for i in range ( N ) ] )
+
+    for name , fun in functions :
+        rr   = array ( 'd' , N * [ 0.0 ] )
+        fun.evaluate ( N , xx , rr )
+        dmax = max ( abs ( r - fun ( x ) ) / max ( 1.0 , abs ( r ) ) for x , r in zip ( xx , rr ) )
+        logger.info ( '%-16s : max difference %.3g' % ( name , dmax ) )
+        assert dmax < 1.e-12 , 'Array and scalar evaluations differ for %s' % name
+
+    ## closed-form integrals vs the simple Simpson rule 
+    def simpson ( fun , a , b , n = 20000 ) :
+        h = ( b - a ) / n
+        s = fun ( a ) + fun ( b )
+        s += sum ( ( 4 if i % 2 else 2 ) * fun ( a + i * h ) for i in range ( 1 , n ) )
+        return s * h / 3
+
+    for name , fun in ( ( 'Tsallis'   , Ostap.Math.Tsallis ( 0.14 , 7  , 0.2 ) ) ,
+                        ( 'Tsallis/1' , Ostap.Math.Tsallis ( 0.94 , 1  , 0.3 ) ) ,
+                        ( 'Tsallis/2' , Ostap.Math.Tsallis ( 0.50 , 2  , 0.5 ) ) ,
+                        ( 'QGSM'      , Ostap.Math.QGSM    ( 0.14 , 2      ) ) ,
+                        ( 'QGSM/0'    , Ostap.Math.QGSM    ( 0    , 3      ) ) ) :
+        for a , b in ( ( 0 , 1 ) , ( 0.1 , 5 ) , ( 2 , 20 ) ) :
+            i1 = fun.integral ( a , b )
+            i2 = simpson ( fun , a , b )
+            logger.info ( '%-16s : integral(%s,%s) %.10g vs %.10g' % ( name , a , b , i1 , i2 ) )
+            assert abs ( i1 - i2 ) <= 1.e-8 * max ( 1.e-10 , abs ( i2 ) ) , 'Invalid integral for %s' % name
+
+# =============================================================================
+## compare the array and scalar evaluation for 2D and 3D polynomials 
+def test_batch_2D3D () :
+    """Compare the array and scalar evaluation for 2D and 3D polynomials 
+    """
+
+    logger = getLogger ( 'test_batch_2D3D' )
+
+    N  = 1000
+    xx = array ( 'd' , [ random.uniform ( -1 , 11 ) for i in range ( N ) ] )
+    yy = array ( 'd' , [ random.uniform ( -1 , 11 ) for i in range ( N ) ] )
+    zz = array ( 'd' , [ random.uniform ( -1 , 11 ) for i in range ( N ) ] )
+
+    functions2 = [
+        ( 'Bernstein2D' , Ostap.Math.Bernstein2D ( 3 , 4 , 0 , 10 , 0 , 10 ) ) ,
+        ( 'Positive2D'  , Ostap.Math.Positive2D  ( 3 , 4 , 0 , 10 , 0 , 10 ) ) ,
+        ( 'Bernstein2DSym' , Ostap.Math.Bernstein2DSym ( 3 , 0 , 10 ) ) ,
+        ( 'Positive2DSym'  , Ostap.Math.Positive2DSym  ( 3 , 0 , 10 ) ) ,
+        ( 'BSpline2D'   , Ostap.Math.BSpline2D        ( Ostap.Math.BSpline ( 0 , 10 , 3 , 2 ) ,
+                                                        Ostap.Math.BSpline ( 0 , 10 , 2 , 3 ) ) ) ,
+        ( 'PositiveSpline2D' , Ostap.Math.PositiveSpline2D ( Ostap.Math.BSpline ( 0 , 10 , 3 , 2 ) ,
+                                                             Ostap.Math.BSpline ( 0 , 10 , 2 , 3 ) ) ) ,
+        ]
+    
+    for name , fun in functions2 :
+        for i in range ( fun.npars () ) : fun.setPar ( i , random.uniform ( 0 , 1 ) )
+        rr   = array ( 'd' , N * [ 0.0 ] )
+        fun.evaluate ( N , xx , yy , rr )
+        dmax = max ( abs ( r - fun ( x , y ) ) / max ( 1.0 , abs ( r ) ) for x , y , r in zip ( xx , yy , rr ) )
+        logger.info ( '%-16s : max difference %.3g' % ( name , dmax ) )
+        assert dmax < 1.e-12 , 'Array and scalar evaluations differ for %s' % name
+
+    functions3 = [
+        ( 'Bernstein3D' , Ostap.Math.Bernstein3D ( 2 , 3 , 4 , 0 , 10 , 0 , 10 , 0 , 10 ) ) ,
+        ( 'Positive3D'  , Ostap.Math.Positive3D  ( 2 , 3 , 4 , 0 , 10 , 0 , 10 , 0 , 10 ) ) ,
+        ( 'Bernstein3DSym' , Ostap.Math.Bernstein3DSym ( 3 , 0 , 10 ) ) ,
+        ( 'Positive3DSym'  , Ostap.Math.Positive3DSym  ( 3 , 0 , 10 ) ) ,
+        ( 'Bernstein3DMix' , Ostap.Math.Bernstein3DMix ( 3 , 2 , 0 , 10 , 0 , 10 ) ) ,
+        ( 'Positive3DMix'  , Ostap.Math.Positive3DMix  ( 3 , 2 , 0 , 10 , 0 , 10 ) ) ,
+        ]
+
+    for name , fun in functions3 :
+        for i in range ( fun.npars () ) : fun.setPar ( i , random.uniform ( 0 , 1 ) )
+        rr   = array ( 'd' , N * [ 0.0 ] )
+        fun.evaluate ( N , xx , yy , zz , rr )
+        dmax = max ( abs ( r - fun ( x , y , z ) ) / max ( 1.0 , abs ( r ) ) for x , y , z , r in zip ( xx , yy , zz , rr ) )
+        logger.info ( '%-16s : max difference %.3g' % ( name , dmax ) )
+        assert dmax < 1.e-12 , 'Array and scalar evaluations differ for %s' % name
+
+# =============================================================================
+## compare the array and scalar evaluation of values, derivatives and integrals for B-splines 
+def test_batch_bspline () :
+    """Compare the array and scalar evaluation of values, derivatives and integrals for B-splines 
+    """
+
+    logger = getLogger ( 'test_batch_bspline' )
+
+    N  = 1000
+    xx = array ( 'd' , sorted ( random.uniform ( -1 , 11 ) for i in range ( N ) ) )
+
+    splines = [
+        ( 'uniform'     , Ostap.Math.BSpline ( 0 , 10 , 8 , 3 ) ) ,
+        ( 'non-uniform' , Ostap.Math.BSpline ( doubles ( 0 , 0.1 , 0.2 , 5 , 9.9 , 10 ) , 2 ) ) ,
+        ]
+    
+    for name , fun in splines :
+        for i in range ( fun.npars () ) : fun.setPar ( i , random.uniform ( 0 , 1 ) )
+        rr = array ( 'd' , N * [ 0.0 ] )
+        dd = array ( 'd' , N * [ 0.0 ] )
+        ii = array ( 'd' , N * [ 0.0 ] )
+        fun.evaluate ( N , xx , rr , dd , ii )
+        dv = max ( abs ( r - fun ( x )                       ) / max ( 1.0 , abs ( r ) ) for x , r in zip ( xx , rr ) )
+        dr = max ( abs ( d - fun.derivative ( x )            ) / max ( 1.0 , abs ( d ) ) for x , d in zip ( xx , dd ) )
+        di = max ( abs ( i - fun.integral ( fun.xmin () , x ) ) / max ( 1.0 , abs ( i ) ) for x , i in zip ( xx , ii ) )
+        logger.info ( '%-16s : max difference %.3g/%.3g/%.3g' % ( name , dv , dr , di ) )
+        assert max ( dv , dr , di ) < 1.e-12 , 'Array and scalar evaluations differ for %s' % name
+
+# =============================================================================
+## compare the array and scalar evaluation for interpolants 
+def test_batch_interpolants () :
+    """Compare the array and scalar evaluation for interpolants 
+    """
+
+    logger = getLogger ( 'test_batch_interpolants' )
+
+    import math 
+    N  = 1000
+    xx = array ( 'd' , [ random.uniform ( 0 , 3 ) for i in range ( N ) ] )
+    
+    A  = Ostap.Math.Interpolation.Abscissas
+    abscissas = [
+        ( 'uniform'    , A ( 12 , 0 , 3 , A.Uniform    ) ) ,
+        ( 'chebyshev'  , A ( 12 , 0 , 3 , A.Chebyshev  ) ) ,
+        ( 'chebyshev2' , A ( 12 , 0 , 3 , A.Chebyshev2 ) ) ,
+        ( 'generic'    , A ( doubles ( 0 , 0.1 , 0.5 , 0.7 , 1.4 , 2 , 2.2 , 2.9 , 3 ) ) ) ,
+        ]
+    
+    for aname , a in abscissas :
+        
+        ys    = doubles ( [ math.sin ( 2 * x ) + x * x / 5 for x in a.x () ] )
+        table = Ostap.Math.Interpolation.Table ( a , ys )
+        
+        for name , fun in ( ( 'Neville'        , Ostap.Math.Neville        ( table     ) ) ,
+                            ( 'Lagrange'       , Ostap.Math.Lagrange       ( table     ) ) ,
+                            ( 'Berrut1st'      , Ostap.Math.Berrut1st      ( table     ) ) ,
+                            ( 'Berrut2nd'      , Ostap.Math.Berrut2nd      ( table     ) ) ,
+                            ( 'FloaterHormann' , Ostap.Math.FloaterHormann ( table , 3 ) ) ,
+                            ( 'Barycentric'    , Ostap.Math.Barycentric    ( table     ) ) ,
+                            ( 'Newton'         , Ostap.Math.Newton         ( table     ) ) ) :
+            
+            rr   = fun.evaluate_array ( xx )
+            dmax = max ( abs ( r - fun ( x ) ) / max ( 1.0 , abs ( r ) ) for x , r in zip ( xx , rr ) )
+            logger.info ( '%-16s/%-10s : max difference %.3g' % ( name , aname , dmax ) )
+            assert dmax < 1.e-12 , 'Array and scalar evaluations differ for %s/%s' % ( name , aname )
+
+# =============================================================================
+## compare the array and scalar evaluation for 2D, 3D and 4D Legendre sums 
+def test_batch_legendre () :
+    """Compare the array and scalar evaluation for 2D, 3D and 4D Legendre sums 
+    """
+
+    logger = getLogger ( 'test_batch_legendre' )
+
+    N  = 1000
+    xx = array ( 'd' , [ random.uniform ( -1 , 11 ) for i in range ( N ) ] )
+    yy = array ( 'd' , [ random.uniform ( -1 , 11 ) for i in range ( N ) ] )
+    zz = array ( 'd' , [ random.uniform ( -1 , 11 ) for i in range ( N ) ] )
+    uu = array ( 'd' , [ random.uniform ( -1 , 11 ) for i in range ( N ) ] )
+
+    functions = [
+        ( 'LegendreSum2' , Ostap.Math.LegendreSum2 ( 3 , 4 ,         0 , 10 , 0 , 10 )                     , ( xx , yy           ) ) ,
+        ( 'LegendreSum3' , Ostap.Math.LegendreSum3 ( 2 , 3 , 4 ,     0 , 10 , 0 , 10 , 0 , 10 )            , ( xx , yy , zz      ) ) ,
+        ( 'LegendreSum4' , Ostap.Math.LegendreSum4 ( 2 , 3 , 2 , 3 , 0 , 10 , 0 , 10 , 0 , 10 , 0 , 10 )   , ( xx , yy , zz , uu ) ) ,
+        ]
+    
+    for name , fun , args in functions :
+        for i in range ( fun.npars () ) : fun.setPar ( i , random.uniform ( -1 , 1 ) )
+        rr   = array ( 'd' , N * [ 0.0 ] )
+        fun.evaluate ( N , *( args + ( rr , ) ) )
+        dmax = max ( abs ( r - fun ( *p ) ) / max ( 1.0 , abs ( r ) ) for p , r in zip ( zip ( *args ) , rr ) )
+        logger.info ( '%-16s : max difference %.3g' % ( name , dmax ) )
+        assert dmax < 1.e-12 , 'Array and scalar evaluations differ for %s' % name
+
+# =============================================================================
+## compare the batched kinematics with per-object calculations 
+def test_batch_kinematics () :
+    """Compare the batched kinematics with per-object calculations 
+    """
+
+    logger = getLogger ( 'test_batch_kinematics' )
+
+    import ostap.math.linalg
+    from   ostap.math.kinematic import mass_with_error, pt_with_error, rapidity_with_error 
+    
+    N   = 1000
+    vs  = [] 
+    cov = array ( 'd' ) 
+    px , py , pz , ee = [ array ( 'd' ) for i in range ( 4 ) ] 
+    for i in range ( N ) :
+        x , y , z = [ random.gauss ( 0 , 5 ) for k in range ( 3 ) ]
+        e = ( x * x + y * y + z * z + random.uniform ( 1 , 10 ) ) ** 0.5 
+        v = Ostap.LorentzVector ( x , y , z , e )
+        c = Ostap.SymMatrix(4)()
+        for a in range ( 4 ) :
+            c [ a , a ] = random.uniform ( 0.01 , 0.1 )
+            for b in range ( a ) : c [ a , b ] = random.uniform ( -0.005 , 0.005 )
+        vs.append ( ( v , c ) ) 
+        for a , b in zip ( ( px , py , pz , ee ) , ( x , y , z , e ) ) : a.append ( b )
+        for a in range ( 4 ) :
+            for b in range ( a + 1 ) : cov.append ( c [ a , b ] )
+            
+    mass , smass = mass_with_error     ( px , py , pz , ee , cov )
+    pt   , spt   = pt_with_error       ( px , py ,           cov )
+    y    , sy    = rapidity_with_error (           pz , ee , cov ) 
+    
+    K = Ostap.Math.Kinematics
+    for i , ( v , c ) in enumerate ( vs ) :
+        for r , s , ve in ( ( mass , smass , K.mass         ( v , c ) ) ,
+                            ( pt   , spt   , K.transverseMomentum ( v , c ) ) ,
+                            ( y    , sy    , K.rapidity     ( v , c ) ) ) :
+            assert abs ( r [ i ] - ve.value () ) < 1.e-10 * max ( 1 , abs ( r [ i ] ) ) and \
+                   abs ( s [ i ] - ve.error () ) < 1.e-10 * max ( 1 , abs ( s [ i ] ) ) , \
+                   'Batched and per-object kinematics differ: %s/%s vs %s' % ( r [ i ] , s [ i ] , ve ) 
+            
+    logger.info ( 'Batched kinematics agree with per-object calculations' ) 
+
+# =============================================================================
+## compare the batched invariant kinematics with the scalar functions
+def test_batch_invariants () :
+    """Compare the batched invariant kinematics with the scalar functions
+    """
+
+    logger = getLogger ( 'test_batch_invariants' )
+
+    from ostap.math.kinematic import kallen_array, q_s_array, G_array
+    from fractions            import Fraction
+    
+    K  = Ostap.Kinematics
+    N  = 1000
+    m1 , m2 , m3 = 0.493 , 0.139 , 0.938
+    
+    ## close to the threshold: the naive formula suffers from cancellations
+    th = ( m1 + m2 ) ** 2
+    ss = array ( 'd' , [ th * ( 1 + 10 ** random.uniform ( -12 , 0 ) ) for i in range ( N ) ] )
+    
+    lam = kallen_array ( ss , m1 * m1 , m2 * m2 )
+    qs  = q_s_array    ( ss , m1 * m1 , m2 * m2 )
+    for s , l , q in zip ( ss , lam , qs ) :
+        ## exact rational arithmetics 
+        a , b , c = Fraction ( s ) , Fraction ( m1 * m1 ) , Fraction ( m2 * m2 )
+        exact = float ( a * a + b * b + c * c - 2 * a * b - 2 * b * c - 2 * a * c ) 
+        assert abs ( l - exact ) <= 1.e-14 * abs ( exact ) , 'Invalid compensated triangle: %s vs %s' % ( l , exact ) 
+        qe = 0.5 * math.sqrt ( exact / s )
+        assert abs ( q - qe ) <= 1.e-14 * qe , 'Invalid q_s: %s vs %s' % ( q , qe ) 
+    
+    ## G-function for the Dalitz plot: G ( s2 , s1 , m3^2 , m1^2 , s , m2^2 ) 
+    M   = 5.279
+    xs1 = array ( 'd' , [ random.uniform ( ( m1 + m2 ) ** 2 , ( M - m3 ) ** 2 ) for i in range ( N ) ] )
+    xs2 = array ( 'd' , [ random.uniform ( ( m2 + m3 ) ** 2 , ( M - m1 ) ** 2 ) for i in range ( N ) ] )
+    gs  = G_array ( xs2 , xs1 , m3 * m3 , m1 * m1 , M * M , m2 * m2 ) 
+    for s1 , s2 , g in zip ( xs1 , xs2 , gs ) :
+        g0 = K.G ( s2 , s1 , m3 * m3 , m1 * m1 , M * M , m2 * m2 )
+        assert abs ( g - g0 ) <= 1.e-10 * max ( 1 , abs ( g0 ) ) , 'Invalid G: %s vs %s' % ( g , g0 ) 
+
+    ## Dalitz plot boundaries 
+    d0  = Ostap.Kinematics.Dalitz0 ( m1 , m2 , m3 )
+    xs  = array ( 'd' , N * [ M * M ] )
+    lo , hi = d0.s1_minmax_array ( xs , xs2 )
+    for s2 , a , b in zip ( xs2 , lo , hi ) :
+        a0 , b0 = d0.s1_minmax_for_s_s2 ( M * M , s2 )
+        assert abs ( a - a0 ) <= 1.e-8 and abs ( b - b0 ) <= 1.e-8 , 'Invalid s1-boundaries!'
+    lo , hi = d0.s2_minmax_array ( xs , xs1 )
+    for s1 , a , b in zip ( xs1 , lo , hi ) :
+        a0 , b0 = d0.s2_minmax_for_s_s1 ( M * M , s1 )
+        assert abs ( a - a0 ) <= 1.e-8 and abs ( b - b0 ) <= 1.e-8 , 'Invalid s2-boundaries!'
+        
+    logger.info ( 'Batched invariant kinematics agree with the scalar functions' ) 
+
+# =============================================================================
+## compare the array and scalar special functions
+def test_batch_special () :
+    """Compare the array and scalar special functions
+    """
+
+    logger = getLogger ( 'test_batch_special' )
+
+    N   = 1000
+    xx  = array ( 'd' , [ random.uniform ( -10 , 10 ) for i in range ( N ) ] )
+    yy  = array ( 'd' , [ x + random.uniform ( 0 , 2 ) for x in xx ] ) 
+    M   = Ostap.Math
+
+    functions = (
+        ( 'gauss_pdf' , lambda n , x , r : M.gauss_pdf ( n , x , r , 1.0 , 2.0 ) , lambda x : M.gauss_pdf ( x , 1.0 , 2.0 ) ) ,
+        ( 'gauss_cdf' , lambda n , x , r : M.gauss_cdf ( n , x , r , 1.0 , 2.0 ) , lambda x : M.gauss_cdf ( x , 1.0 , 2.0 ) ) ,
+        ( 'erfcx'     , M.erfcx     , M.erfcx  ) , 
+        ( 'exprel'    , M.exprel    , M.exprel ) , 
+        ( 'igamma'    , M.igamma    , M.igamma ) , 
+        ( 'psi'       , M.psi       , M.psi    ) , 
+        ( 'owen'      , lambda n , x , r : M.owen ( n , x , r , 0.5 ) , lambda x : M.owen ( x , 0.5 ) ) ,
+        )
+
+    for name , fa , fs in functions :
+        rr = array ( 'd' , N * [ 0.0 ] )
+        fa ( N , xx , rr )
+        dmax = max ( abs ( r - fs ( x ) ) / max ( 1.0 , abs ( r ) ) for x , r in zip ( xx , rr ) )
+        logger.info ( '%-16s : max difference %.3g' % ( name , dmax ) )
+        assert dmax < 1.e-12 , 'Array and scalar evaluations differ for %s' % name
+
+    rr = array ( 'd' , N * [ 0.0 ] )
+    M.gauss_int ( N , xx , yy , rr , 1.0 , 2.0 )
+    dmax = max ( abs ( r - M.gauss_int ( a , b , 1.0 , 2.0 ) ) for a , b , r in zip ( xx , yy , rr ) )
+    logger.info ( '%-16s : max difference %.3g' % ( 'gauss_int' , dmax ) )
+    assert dmax < 1.e-12 , 'Array and scalar evaluations differ for gauss_int'
+
+    ## some known values
+    euler = 0.57721566490153286
+    assert abs ( M.psi    ( 1.0 ) + euler                      ) < 1.e-15 , 'Invalid psi(1)'
+    assert abs ( M.psi    ( 0.5 ) + euler + 2 * math.log ( 2 ) ) < 1.e-15 , 'Invalid psi(1/2)'
+    assert abs ( M.igamma ( 0.5 ) * math.sqrt ( math.pi ) - 1  ) < 1.e-15 , 'Invalid 1/Gamma(1/2)'
+    assert abs ( M.exprel ( 0.0 ) - 1 ) < 1.e-15 , 'Invalid exprel(0)'
+    assert abs ( M.gauss_cdf ( -30 ) / 4.906713927148187e-198 - 1 ) < 1.e-12 , 'Invalid gauss_cdf tail'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_batch      ()
+    test_batch_genhyperbolic () 
+    test_batch_models     ()
+    test_batch_2D3D ()
+    test_batch_bspline    ()
+    test_batch_interpolants () 
+    test_batch_legendre   ()
+    test_batch_kinematics () 
+    test_batch_invariants () 
+    test_batch_special    () 
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
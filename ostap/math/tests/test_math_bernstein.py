@@ -274,6 +274,44 @@ def test_even () :
 
     functions.add ( b ) 
 
+# ==============================================================================
+## test  for the incremental update of positive polynomials
+def test_positive_update () :
+    """Test for the incremental update of positive polynomials:
+    the polynomial, updated parameter-by-parameter, 
+    must be the same as the one created from scratch
+    """
+    
+    logger = getLogger("test_positive_update")
+
+    for P , args in ( ( Ostap.Math.Positive   , ( 6 ,     0. , 2. ) ) ,
+                      ( Ostap.Math.Positive   , ( 7 ,     0. , 2. ) ) ,
+                      ( Ostap.Math.Positive2D , ( 3 , 4 , 0. , 2. , 0. , 2. ) ) ) :
+        
+        p = P ( *args )
+        for trial in range ( 20 ) :
+            
+            k     = random.randrange ( p.npars () )
+            p.setPar ( k , random.uniform ( -3 , 3 ) )
+            
+            q = P ( *args )
+            for i in range ( p.npars () ) : q.setPar ( i , p.par ( i ) )
+
+            bp = p.bernstein ().pars ()
+            bq = q.bernstein ().pars ()
+            for a , b in zip ( bp , bq ) : 
+                check_equality ( a , b , 'Invalid incremental update for %s' % P.__name__ , 1.e-10 )
+
+            ## batch update of all phases at once 
+            r = P ( *args )
+            if not hasattr ( r , 'setPars' ) : continue 
+            r.setPars ( p.pars () )
+            br = r.bernstein ().pars ()
+            for a , b in zip ( bp , br ) : 
+                check_equality ( a , b , 'Invalid batch update for %s' % P.__name__ , 1.e-10 )
+                
+    logger.info ('Incremental update of positive polynomials is OK' )
+
 # ==============================================================================
 ## test  for monotonic polynomial 
 def test_monotonic () :
@@ -447,6 +485,80 @@ def test_integration () :
 
     logger.info ('Integration     is OK' )
 
+# =============================================================================
+## test the unrolled fixed-degree evaluation 
+def test_fixed_degree () :
+    """Test the unrolled fixed-degree evaluation (N<=8) against
+    the generic de Casteljau algorithm 
+    """
+    
+    logger = getLogger("test_fixed_degree")
+
+    from array import array
+    
+    NP = 1000
+    for n in range ( 0 , 11 ) :
+        
+        b = Ostap.Math.Bernstein ( n , 1 , 3 )
+        for i in b  : b [ i ] = random.uniform ( -10 , 10 ) 
+
+        xx = array ( 'd' , [ random.uniform ( 0.5 , 3.5 ) for i in range ( NP ) ] )
+        rr = array ( 'd' , NP * [ 0.0 ] )
+        b.evaluate ( NP , xx , rr )
+        
+        pars = b.pars()
+        for x , r in zip ( xx , rr ) :
+            
+            v1 = b ( x )
+            v2 = Ostap.Math.casteljau ( pars , b.t ( x ) ) if b.xmin() <= x <= b.xmax() else 0.0
+            
+            if abs ( v1 - v2 ) > 1.e-12 * max ( 1 , abs ( v2 ) ) :
+                raise ValueError ( 'Invalid scalar value for degree %d: %s vs %s' % ( n , v1 , v2 ) )
+            if abs ( r  - v1 ) > 1.e-12 * max ( 1 , abs ( v1 ) ) :
+                raise ValueError ( 'Invalid array  value for degree %d: %s vs %s' % ( n , r  , v1 ) )
+
+    logger.info ('Fixed-degree evaluation is OK' )
+
+# =============================================================================
+## test the product of Bernstein polynomials 
+def test_product () :
+    """Test the product of Bernstein polynomials and 
+    the repeated (cached) basis transformations 
+    """
+    
+    logger = getLogger("test_product")
+
+    for n1 , n2 in ( ( 1 , 1 ) , ( 2 , 5 ) , ( 7 , 3 ) , ( 12 , 17 ) , ( 30 , 25 ) ) : 
+
+        b1 = Ostap.Math.Bernstein ( n1 , 0 , 2 )
+        b2 = Ostap.Math.Bernstein ( n2 , 0 , 2 )
+        for i in b1  : b1 [ i ] = random.uniform ( -1 , 1 ) 
+        for i in b2  : b2 [ i ] = random.uniform ( -1 , 1 ) 
+
+        b3 = b1 * b2
+        assert b3.degree () == n1 + n2 , 'Invalid degree of the product!'
+        
+        for i in range ( 100 ) :
+            x  = random.uniform ( 0 , 2 )
+            v1 = b1 ( x ) * b2 ( x )
+            v2 = b3 ( x ) 
+            if abs ( v1 - v2 ) > 1.e-10 :
+                raise ValueError ( 'Invalid product (%d,%d): %s vs %s' % ( n1 , n2 , v1 , v2 ) )
+
+    for n in range ( 10 ) :
+        for k in range ( 20 ) : 
+            b  = Ostap.Math.Bernstein ( n , -1 , 1 )
+            for i in b  : b [ i ] = random.uniform ( -1 , 1 ) 
+            l  = Ostap.Math.LegendreSum  ( b )
+            c  = Ostap.Math.ChebyshevSum ( b )
+            p  = Ostap.Math.Polynomial   ( b )
+            for f in ( l , c , p , Ostap.Math.Bernstein ( l ) , Ostap.Math.Bernstein ( c ) , Ostap.Math.Bernstein ( p ) ) :
+                x = random.uniform ( -1 , 1 )
+                if abs ( f ( x ) - b ( x ) ) > 1.e-10 :
+                    raise ValueError ( 'Invalid transformation: %s vs %s' % ( f ( x ) , b ( x ) ) )
+
+    logger.info ('Product & transformations are OK' )
+
 # =============================================================================
 ## test transformations
 def test_transformation () :
@@ -508,6 +620,26 @@ def test_transformation () :
             
     logger.info ('Transformation  is OK' )
 
+# =============================================================================
+## high-degree 2D polynomials use the per-thread scratch arena:
+#  no heap allocations in the steady state 
+def test_arena () :
+    logger = getLogger ( 'test_arena' ) 
+    from ostap.utils.instrument import arena_heap_allocations
+
+    b2 = Ostap.Math.Bernstein2D ( 80 , 80 , 0 , 1 , 0 , 1 )
+    for i in range ( b2.npars () ) : b2.setPar ( i , random.uniform ( 0 , 1 ) )
+
+    ## warm-up 
+    for i in range ( 10 ) : b2 ( random.uniform ( 0 , 1 ) , random.uniform ( 0 , 1 ) )
+    n0 = arena_heap_allocations ()
+    for i in range ( 1000 ) :
+        b2 ( random.uniform ( 0 , 1 ) , random.uniform ( 0 , 1 ) )
+        b2.integral ( 0.1 , 0.5 , 0.2 , 0.7 ) 
+    n1 = arena_heap_allocations ()
+    logger.info ( 'Heap allocations by arenas: warm-up %d , steady state %d' % ( n0 , n1 - n0 ) )
+    assert n0 == n1 , 'Heap allocations in the steady state!'
+    
 # =============================================================================
 def test_pickle () :
     logger = getLogger ( 'test_pickle'        ) 
@@ -556,11 +688,15 @@ if '__main__' == __name__ :
     test_elevatereduce  ()
     test_poly           ()
     test_even           ()
+    test_positive_update ()
     test_monotonic      ()
     test_convex         () 
     test_convexonly     ()
     test_integration    ()
+    test_fixed_degree   ()
+    test_product        ()
     test_transformation ()
+    test_arena          ()
 
     ## check finally that everything is serializeable:
     test_pickle () 
@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# ============================================================================= 
+# Copyright (c) Ostap developpers.
+# ============================================================================= 
+## @file ostap/math/tests/test_math_cache.py
+#  Test module for the file ostap/math/cache.py
+# ============================================================================= 
+""" Test module for ostap/math/cache.py
+"""
+# ============================================================================= 
+from   ostap.math.cache    import LRUCache, the_cache, cache_stat 
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'test_math_cache' )
+else                       : logger = getLogger ( __name__          )
+# ============================================================================= 
+
+def test_lru_cache () :
+
+    cache = LRUCache ( 3 )
+    for i in range ( 5 ) : cache.insert ( i , i * i )
+
+    assert 3 == len ( cache )             , 'Invalid cache size!'
+    assert 2 == cache.evictions           , 'Invalid number of evictions!'
+    assert not 0 in cache and 4 in cache  , 'Invalid eviction order!'
+
+    found , value = cache.lookup ( 2 )
+    assert found and 4 == value           , 'Invalid cached value!'
+    cache.insert ( 5 , 25 )               ## 3 is evicted, 2 was used recently 
+    assert 2 in cache and not 3 in cache  , 'Invalid LRU order!'
+    
+    cache.maxsize = 1
+    assert 1 == len ( cache )             , 'Invalid cache size!'
+    logger.info ( 'LRU cache statistics: %s' % cache.stat () )
+    
+def test_integral_cache () :
+
+    from ostap.math.integral import IntegralCache
+    
+    func  = lambda x : x * x 
+    i1    = IntegralCache ( func , 0 )
+    i2    = IntegralCache ( func , 0 )
+    
+    the_cache.reset ()
+    v1 = i1 ( 2 )
+    v2 = i2 ( 2 ) ## the same integral from the different object  
+    assert abs ( v1 - 8/3. ) < 1.e-8 and v1 == v2 , 'Invalid integral!'
+    assert 1 <= the_cache.hits , 'The cache is not used!'
+    
+    logger.info ( 'Cache statistics: %s' % cache_stat () )
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_lru_cache      ()
+    test_integral_cache ()
+    
+# =============================================================================
+##                                                                      The END 
+# =============================================================================
@@ -176,12 +176,54 @@ def test_dalitz3 () :
             gr  = p.graph21 ( masses = False ) 
             gr.draw  ( 'alf' , linecolor = 2, linewidth = 2 , fillcolor=2)
         
+# =============================================================================
+## compare the precomputed integration rule with the adaptive integration 
+def test_dalitz4 () :
+
+    logger = getLogger  ('test_dalitz4' )
+
+    DI   = Ostap.Math.DalitzIntegrator
+    fun  = lambda s1 , s2 : 1.0 + s1 * s2 
+    for i , dd in enumerate ( plots ) :
+
+        rule = Ostap.Math.DalitzRule ( dd , 128 , 128 )
+        r1   = DI.integrate_s1s2 ( fun , dd.s () , dd )
+        r2   = rule.integrate    ( fun )
+        logger.info ( 'Dalitz #%d: adaptive %.8g, rule %.8g [R-1=%+.2g]' % ( i , r1 , r2 , r2 / r1 - 1 ) )
+        
+# =============================================================================
+## compare the batch evaluation with the scalar methods 
+def test_dalitz5 () :
+
+    logger = getLogger  ('test_dalitz5' )
+
+    for i , dd in enumerate ( plots + ( d , ) ) :
+
+        xs1 = [ random.uniform ( dd.s1_min () - 0.1 , dd.s1_max () + 0.1 ) for k in range ( 1000 ) ]
+        xs2 = [ random.uniform ( dd.s2_min () - 0.1 , dd.s2_max () + 0.1 ) for k in range ( 1000 ) ]
+
+        res = dd.evaluate_array ( xs1 , xs2 )
+
+        for k , ( x1 , x2 ) in enumerate ( zip ( xs1 , xs2 ) ) :
+            assert bool ( res [ 'inside' ] [ k ] ) == dd.inside ( x1 , x2 ) , 'Invalid inside flag!'
+            assert abs ( res [ 'density' ] [ k ] - dd.density ( x1 , x2 ) ) <= 1.e-12 * dd.density ( x1 , x2 ) , \
+                   'Invalid density!'
+            if dd.inside ( x1 , x2 ) :
+                for key , fun in ( ( 'cos_12' , dd.cos_12 ) ,
+                                   ( 'cos_23' , dd.cos_23 ) ,
+                                   ( 'cos_31' , dd.cos_31 ) ) :
+                    assert abs ( res [ key ] [ k ] - fun ( x1 , x2 ) ) <= 1.e-6 , 'Invalid %s!' % key
+
+        logger.info ( 'Dalitz #%d: %d points inside' % ( i , sum ( 1 for f in res [ 'inside' ] if f ) ) ) 
+        
 # =============================================================================
 if '__main__' == __name__ :
 
     test_dalitz1 ()
     test_dalitz2 ()
     test_dalitz3 ()
+    test_dalitz4 ()
+    test_dalitz5 ()
 
 # =============================================================================
 ##                                                                      The END 
@@ -0,0 +1,75 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+## @file ostap/math/tests/test_math_frozenbasis.py
+# Test module for the precomputed ("frozen") basis matrix
+# @see Ostap::Math::FrozenBasis
+# =============================================================================
+""" Test module for the precomputed (``frozen'') basis matrix
+- see Ostap::Math::FrozenBasis
+"""
+# =============================================================================
+import ROOT, random
+from   ostap.core.pyrouts     import Ostap
+from   ostap.math.base        import doubles
+import ostap.math.models
+# ============================================================================
+from   ostap.logger.logger    import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.test_math_frozenbasis' )
+else                       : logger = getLogger ( __name__                      )
+# ============================================================================
+
+# =============================================================================
+## compare the frozen basis and the direct evaluation
+def test_frozenbasis () :
+    """Compare the frozen basis and the direct evaluation
+    """
+
+    logger = getLogger ( 'test_frozenbasis' )
+
+    nbins  = 100
+    xmin   = 0.0
+    xmax   = 10.0
+    edges  = [ xmin + ( xmax - xmin ) * i / nbins for i in range ( nbins + 1 ) ]
+    low    = doubles ( edges [ :-1 ] )
+    high   = doubles ( edges [ 1:  ] )
+    centers = doubles ( [ 0.5 * ( a + b ) for a , b in zip ( low , high ) ] )
+
+    functions = [
+        ( 'Bernstein'      , Ostap.Math.Bernstein      ( 5 , xmin , xmax ) ) ,
+        ( 'Positive'       , Ostap.Math.Positive       ( 5 , xmin , xmax ) ) ,
+        ( 'BSpline'        , Ostap.Math.BSpline        ( xmin , xmax , 3 , 3 ) ) ,
+        ( 'PositiveSpline' , Ostap.Math.PositiveSpline ( xmin , xmax , 3 , 3 ) ) ,
+        ]
+
+    for name , fun in functions :
+
+        values    = Ostap.Math.FrozenBasis ( fun , centers     )
+        integrals = Ostap.Math.FrozenBasis ( fun , low  , high )
+
+        for trial in range ( 5 ) :
+
+            for i in range ( fun.npars () ) :
+                fun.setPar ( i , random.uniform ( 0 , 1 ) )
+
+            vv = values   .evaluate ( fun )
+            ii = integrals.evaluate ( fun )
+
+            dv = max ( abs ( v - fun ( x ) ) for v , x in zip ( vv , centers ) )
+            di = max ( abs ( v - fun.integral ( a , b ) ) for v , a , b in zip ( ii , low , high ) )
+
+            logger.info ( '%-16s : max difference %.3g/%.3g' % ( name , dv , di ) )
+            assert dv < 1.e-10 , 'Frozen basis values    differ for %s' % name
+            assert di < 1.e-10 , 'Frozen basis integrals differ for %s' % name
+
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_frozenbasis ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
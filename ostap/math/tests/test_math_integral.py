@@ -98,14 +98,94 @@ def test_integral_3D ():
         logger.info ( '%20s: Delta/E  %-20s %-20s'         % ( entry[0] , (v1-vv)/v1.error() , (v2 - vv)/v2.error() ) ) 
                 
 
+def test_integral_fast ():
+    """Vectorized (numpy) and native C++ cubatures
+    """
 
-        
+    from ostap.core.core     import Ostap
+    from ostap.math.integral import genzmalik2, genzmalik3, integral2
+    
+    try :
+        import numpy as np
+        f2 = lambda x,y   : np.exp ( -x*x - y*y ) * np.cos ( x * y ) 
+        f3 = lambda x,y,z : np.exp ( -x*x - y*y - z * z ) 
+        v1 = genzmalik2 ( f2 , -1 , 2 , -1 , 2 , err = True , vectorized = False )
+        v2 = genzmalik2 ( f2 , -1 , 2 , -1 , 2 , err = True , vectorized = True  )
+        logger.info ( 'Genz&Malik 2D: point-by-point %s, vectorized %s' % ( v1 , v2 ) )
+        assert abs ( v1.value() - v2.value() ) < 1.e-10 , 'Vectorized 2D cubature mismatch!'
+        v1 = genzmalik3 ( f3 , -1 , 1 , -1 , 1 , -1 , 1 , err = True , vectorized = False )
+        v2 = genzmalik3 ( f3 , -1 , 1 , -1 , 1 , -1 , 1 , err = True , vectorized = True  )
+        logger.info ( 'Genz&Malik 3D: point-by-point %s, vectorized %s' % ( v1 , v2 ) )
+        assert abs ( v1.value() - v2.value() ) < 1.e-10 , 'Vectorized 3D cubature mismatch!'
+    except ImportError :
+        logger.warning ( 'numpy is not available, skip vectorized test' )
+
+    b2 = Ostap.Math.Bernstein2D ( 3 , 3 , 0 , 1 , 0 , 2 )
+    for i in range ( b2.npars () ) : b2.setPar ( i , 1.0 + 0.1 * i ) 
+    exact = b2.integral () 
+    v1    = genzmalik2 ( b2 , 0 , 1 , 0 , 2 , err = True )
+    v2    = integral2  ( b2 , 0 , 1 , 0 , 2 , err = True )
+    logger.info ( 'C++ functor: exact %s, genzmalik2 %s, integral2 %s' % ( exact , v1 , v2 ) )
+    assert abs ( v1.value() - exact ) < 1.e-6 * abs ( exact ) , 'Native 2D cubature mismatch!'
+    assert abs ( v2.value() - exact ) < 1.e-6 * abs ( exact ) , 'Native 2D cubature mismatch!'
+
+def test_integral_fast_path ():
+    """Fast non-adaptive 1D integration with adaptive fallback
+    """
+
+    from ostap.core.core        import Ostap
+    from ostap.math.integral    import integral 
+    from ostap.utils.instrument import instrumented, instrument_counters
+    
+    m_pi = 0.13957
+    bw   = Ostap.Math.BreitWigner ( 0.770 , 0.150 , m_pi , m_pi , 1 )
+
+    old = Ostap.Math.Integrator.set_fast_path ( True )
+    try : 
+        ## smooth tails (fast path) and the peak (adaptive & learned subdivisions)
+        ranges = [ ( 1.2 , 1.5 ) , ( 0.3 , 0.4 ) , ( 0.5 , 1.0 ) , ( 0.3 , 2.0 ) ]
+        for low, high in ranges :
+            v1 = bw.integral ( low , high ) 
+            v2 = integral ( bw , low , high , err = True )
+            logger.info ( 'Integral(%.2f,%.2f): C++ %.10g, python %s' % ( low , high , v1 , v2 ) ) 
+            assert abs ( v1 - v2.value() ) < 1.e-6 * abs ( v1 ) + 5 * v2.error () , \
+                   'Fast-path integral mismatch!'
+    finally :
+        Ostap.Math.Integrator.set_fast_path ( old ) 
+
+    if instrumented () :
+        names = set ( name for name , calls , time in instrument_counters () if 0 < calls ) 
+        logger.info ( 'Integration counters: %s' % sorted ( n for n in names if 'Integrator' in n ) )
+
+def test_integral_3D_mt ():
+    """Parallel evaluation of the regions in 3D cubature
+    """
+
+    from ostap.core.core import Ostap
+
+    b3 = Ostap.Math.Bernstein3D ( 4 , 4 , 4 , 0 , 1 , 0 , 2 , 0 , 3 )
+    for i in range ( b3.npars () ) : b3.setPar ( i , 1.0 + 0.1 * ( i % 7 ) ) 
+    exact    = b3.integral () 
+    cubature = Ostap.Math.Integrator.cubature3 [ 'Ostap::Math::Bernstein3D' ]
+
+    results  = [] 
+    for nthreads in ( 1 , 2 , 4 ) :
+        r = cubature ( b3 , 0 , 1 , 0 , 2 , 0 , 3 , 1.e-10 , 1.e-10 , nthreads )
+        logger.info ( 'cubature3: threads %d result %.15g +- %.3g , exact %.15g' % ( nthreads , r.first , r.second , exact ) ) 
+        assert abs ( r.first - exact ) < 1.e-8 * abs ( exact ) , 'Parallel 3D cubature mismatch!'
+        results.append ( r.first )
+
+    assert results[0] == results[1] == results[2] , 'Result depends on number of threads!'
+    
 # =============================================================================
 if '__main__' == __name__ :
 
-    test_integral    ()
-    test_integral_2D ()
-    test_integral_3D ()
+    test_integral      ()
+    test_integral_2D   ()
+    test_integral_3D   ()
+    test_integral_fast ()
+    test_integral_fast_path ()
+    test_integral_3D_mt     ()
     
 # =============================================================================
 # The END 
@@ -221,10 +221,52 @@ def test_linalg2() :
     logger.info ( " -> rho      %s " % r2 )
     
     
+# =============================================================================
+## test the batched eigen-decomposition of symmetric matrices 
+def test_linalg2_eigen () :
+    """Test the batched eigen-decomposition of symmetric matrices
+    """
+    
+    logger.info ( 'Test batched eigen-decomposition')
+
+    import random
+    from   ostap.core.core import std 
+
+    for D in ( 2 , 3 , 5 ) :
+        
+        SM     = Ostap.SymMatrix ( D )
+        SV     = Ostap.Vector    ( D )
+        MM     = Ostap.Matrix    ( D , D ) 
+        
+        mtrx   = std.vector ( SM ) ()
+        for n in range ( 200 ) :
+            m = SM ()
+            for i in range ( D ) :
+                m [ i , i ] = 1 + random.uniform ( 0 , 2 )
+                for j in range ( i ) : m [ i , j ] = random.uniform ( -0.3 , 0.3 )
+            mtrx.push_back ( m )
+
+        vals   = std.vector ( SV ) ()
+        vecs   = std.vector ( MM ) ()
+        eigen  = Ostap.Math.GSL.EigenSystem ()
+        sc     = eigen.eigenVectors ( mtrx , vals , vecs , True , 2 )
+        assert sc.isSuccess () , 'Batched eigenVectors: status %s' % sc 
+
+        for m , v , e in zip ( mtrx , vals , vecs ) :
+            ev = m.eigenValues ( True ) 
+            for i in range ( D ) :
+                assert abs ( ev [ i ] - v [ i ] ) < 1.e-10 , 'Batched eigenvalues differ!'
+                for k in range ( D ) :
+                    mv = sum ( m [ k , j ] * e [ j , i ] for j in range ( D ) )
+                    assert abs ( mv - v [ i ] * e [ k , i ] ) < 1.e-10 , 'Invalid eigenvector!'
+
+        logger.info ( 'Batched eigen-decomposition for %dx%d matrices is OK' % ( D , D ) ) 
+
 # =============================================================================
 if '__main__' == __name__ :
 
-    test_linalg2 ()
+    test_linalg2       ()
+    test_linalg2_eigen ()
     
 # =============================================================================
 ##                                                                      The END 
@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+## @file ostap/math/tests/test_math_native.py
+#  Test module for the file ostap/math/native.py
+# =============================================================================
+""" Test module for ostap/math/native.py
+- native-call path for the compiled (numba.cfunc, ctypes, cffi) functions
+"""
+# =============================================================================
+import ctypes, ctypes.util, math
+from   ostap.core.core     import Ostap
+from   ostap.math.native   import native_function, native_address, is_native
+from   ostap.math.integral import integral, integral2
+from   ostap.utils.timing  import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'test_math_native' )
+else                       : logger = getLogger ( __name__           )
+# =============================================================================
+## compiled functions from libm
+libm = ctypes.CDLL ( ctypes.util.find_library ( 'm' ) )
+cos_ = libm.cos
+cos_.argtypes = [ ctypes.c_double ]
+cos_.restype  = ctypes.c_double
+pow_ = libm.pow
+pow_.argtypes = [ ctypes.c_double , ctypes.c_double ]
+pow_.restype  = ctypes.c_double
+
+# =============================================================================
+## wrap compiled ctypes functions
+def test_native_ctypes () :
+
+    logger = getLogger ( 'test_native_ctypes' )
+
+    assert is_native ( cos_ ) and not is_native ( math.cos ) , 'Invalid detection of compiled functions!'
+    assert 1 == native_address ( cos_ ) [ 1 ] , 'Invalid number of arguments!'
+    assert 2 == native_address ( pow_ ) [ 1 ] , 'Invalid number of arguments!'
+
+    f1 = native_function ( cos_ )
+    f2 = native_function ( pow_ )
+    assert isinstance ( f1 , Ostap.Functions.NativeFunction1 ) , 'Invalid type of the wrapper!'
+    assert isinstance ( f2 , Ostap.Functions.NativeFunction2 ) , 'Invalid type of the wrapper!'
+
+    for x in ( 0.0 , 0.5 , 1.0 , 2.0 ) :
+        assert abs ( f1 ( x ) - math.cos ( x ) ) < 1.e-15 , 'Invalid value!'
+        assert abs ( f2 ( 2.0 , x ) - 2.0 ** x ) < 1.e-15 , 'Invalid value!'
+
+    ## PyCallable with the compiled function: no Python calls
+    pc = Ostap.Functions.PyCallable ( f1 )
+    assert pc.native () and abs ( pc ( 1.0 ) - math.cos ( 1.0 ) ) < 1.e-15 , 'Invalid PyCallable!'
+
+    ## unsupported signature
+    sin_ = libm.sin
+    assert native_function ( sin_ ) is None , 'Function without signature is accepted!'
+
+# =============================================================================
+## native integration
+def test_native_integral () :
+
+    logger = getLogger ( 'test_native_integral' )
+
+    with timing ( 'Integral: python' , logger = logger ) :
+        r1 = integral ( math.cos , 0 , 0.5 * math.pi )
+    with timing ( 'Integral: native' , logger = logger ) :
+        r2 = integral ( cos_     , 0 , 0.5 * math.pi , err = True )
+
+    logger.info ( 'Integrals: python %.12f, native %s' % ( r1 , r2 ) )
+    assert abs ( r2.value () - 1 ) < 1.e-10 , 'Invalid native integral!'
+
+    ## 2D : int_0^1 int_0^1 x^y dx dy = log(2)
+    r3 = integral2 ( pow_ , 0 , 1 , 0 , 1 )
+    logger.info ( 'Integral2: native %.12f, exact %.12f' % ( r3 , math.log ( 2 ) ) )
+    assert abs ( r3 - math.log ( 2 ) ) < 1.e-6 , 'Invalid native 2D-integral!'
+
+# =============================================================================
+## numba-compiled functions (if numba is available)
+def test_native_numba () :
+
+    logger = getLogger ( 'test_native_numba' )
+    try :
+        import numba
+    except ImportError :
+        logger.warning ( 'numba is not available, skip the test' )
+        return
+
+    @numba.cfunc ( 'float64(float64)' )
+    def fun ( x ) : return x * x
+
+    f = native_function ( fun )
+    assert isinstance ( f , Ostap.Functions.NativeFunction1 ) , 'Invalid type of the wrapper!'
+    assert abs ( f ( 3.0 ) - 9.0 ) < 1.e-15 , 'Invalid value!'
+    r = integral ( fun , 0 , 1 )
+    assert abs ( r - 1.0 / 3 ) < 1.e-10 , 'Invalid native integral!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_native_ctypes   ()
+    test_native_integral ()
+    test_native_numba    ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -140,6 +140,46 @@ def test_cosine_sum () :
     with wait ( 3 ) , use_canvas ( 'test_cosine_sum' ) , timing ( logger = logger ) :
         make_test ( func , xmin , xmax , cosine_sum , range ( 1 , 11 ) , logger )
 
+# =============================================================================
+def test_fourier_fft () :
+    """Test FFT-based evaluation/fit of Fourier & Cosine sums
+    """
+
+    logger = getLogger('test_fourier_fft')
+    logger.info ( 'FFT-based evaluation and fit of Fourier/Cosine sums')
+
+    from ostap.math.base  import doubles 
+    from ostap.core.core  import Ostap
+
+    fs = Ostap.Math.FourierSum ( 5 , 0 , 2 * math.pi )
+    for i in range ( fs.npars () ) : fs.setPar ( i , random.uniform ( -1 , 1 ) )
+
+    N  = 16 
+    vs = fs.values ( N )
+    for i , v in enumerate ( vs ) :
+        x = 2 * math.pi * i / N
+        assert abs ( v - fs ( x ) ) < 1.e-10 , 'FourierSum: values mismatch at %s' % x
+
+    ff = Ostap.Math.FourierSum.fit ( vs , fs.degree () , 0 , 2 * math.pi )
+    for i in range ( fs.npars () ) :
+        assert abs ( ff.par ( i ) - fs.par ( i ) ) < 1.e-10 , 'FourierSum: fit mismatch for %d' % i
+
+    cs = Ostap.Math.CosineSum  ( 5 , 0 , 1 )
+    for i in range ( cs.npars () ) : cs.setPar ( i , random.uniform ( -1 , 1 ) )
+    vs = cs.values ( N )
+    for i , v in enumerate ( vs ) :
+        x = float ( i ) / N
+        assert abs ( v - cs ( x ) ) < 1.e-10 , 'CosineSum: values mismatch at %s' % x
+
+    cf = Ostap.Math.CosineSum.fit  ( vs , cs.degree () , 0 , 1 )
+    for i in range ( cs.npars () ) :
+        assert abs ( cf.par ( i ) - cs.par ( i ) ) < 1.e-10 , 'CosineSum: fit mismatch for %d' % i
+
+    ## gaussian smearing preserves the normalization 
+    data = doubles ( [ 1.0 if 40 <= i < 60 else 0.0 for i in range ( 100 ) ] )
+    conv = Ostap.Math.gauss_convolve ( data , 0.02 , 0 , 1 )
+    assert abs ( sum ( conv ) - sum ( data ) ) < 1.e-8 , 'gauss_convolve: normalization is not preserved'
+    
 # =============================================================================
 def test_bernstein_sum () :
     """Test Bernstein sum
@@ -204,6 +244,7 @@ if '__main__' == __name__ :
     test_chebyshev_sum      ()
     test_fourier_sum        ()
     test_cosine_sum         ()
+    test_fourier_fft        ()
     test_bernstein_sum      ()
     test_bernsteineven_sum1 ()
     test_bernsteineven_sum2 ()
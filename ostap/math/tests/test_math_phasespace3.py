@@ -163,7 +163,54 @@ def test_phasespace3_compare () :
             else: 
                 f1_draw ( f , 'same' , line_color = color , linewidth = 2 , xmin = xmin , xmax = 40 )
 
-    
+
+# =============================================================================
+## Test the (lazy) Chebyshev approximations for the phase space functions
+#  @see Ostap::Math::PhaseSpace3
+#  @see Ostap::Math::PhaseSpaceNL
+#  @see Ostap::Math::PhaseSpace23L
+def test_phasespace_approximation () :
+    """Test the (lazy) Chebyshev approximations for the phase space functions
+    - see Ostap.Math.PhaseSpace3
+    - see Ostap.Math.PhaseSpaceNL
+    - see Ostap.Math.PhaseSpace23L
+    """
+    logger = getLogger( 'test_phasespace_approximation')
+
+    from ostap.math.integral import integral as _integral
+
+    ## 3-body phase space: approximation vs direct integration 
+    for masses , l1 , l2 in ( ( ( 0.14 , 0.14 , 0.5 ) , 0 , 0 ) ,
+                              ( ( 0.14 , 0.14 , 0.5 ) , 1 , 0 ) ,
+                              ( ( 0    , 0.14 , 0.5 ) , 0 , 1 ) ,
+                              ( ( 3    , 1    , 0.1 ) , 2 , 1 ) ) :
+        ps   = Ostap.Math.PhaseSpace3 ( masses [ 0 ] , masses [ 1 ] , masses [ 2 ] , l1 , l2 )
+        thr  = ps.threshold ()
+        dmax = 0
+        for i in range ( 1 , 200 ) :
+            x    = thr + i * 0.05 * thr 
+            d    = ps.direct ( x )
+            dmax = max ( dmax , abs ( ps ( x ) - d ) / d )
+        logger.info ( 'PhaseSpace3 %s/(%d,%d) max relative deviation %.2g' % ( masses , l1 , l2 , dmax ) )
+        assert dmax < 1.e-6 , 'PhaseSpace3: invalid approximation!'
+
+    ## N/L-body phase space: integrals 
+    for l , n in ( ( 2 , 3 ) , ( 3 , 5 ) , ( 0 , 3 ) , ( 3 , 0 ) ) :
+        ps = Ostap.Math.PhaseSpaceNL ( 1 , 5 , l , n )
+        assert abs ( ps.integral () - 1 ) < 1.e-8 , 'PhaseSpaceNL: invalid normalization!'
+        i1 = ps.integral ( 2 , 4 )
+        i2 = _integral   ( ps , 2 , 4 )
+        assert abs ( i1 - i2 ) < 1.e-6 , 'PhaseSpaceNL: invalid integral %s vs %s' % ( i1 , i2 )
+
+    ## 2 from 3-body phase space: integrals 
+    for L , l in ( ( 0 , 0 ) , ( 1 , 0 ) , ( 2 , 1 ) ) :
+        ps = Ostap.Math.PhaseSpace23L ( 0.14 , 0.14 , 3.1 , 5.3 , L , l )
+        assert abs ( ps.integral () - 1 ) < 1.e-8 , 'PhaseSpace23L: invalid normalization!'
+        low , high = 0.8 , 1.6 
+        i1 = ps.integral ( low , high )
+        i2 = _integral   ( ps , low , high )
+        assert abs ( i1 - i2 ) < 1.e-6 , 'PhaseSpace23L: invalid integral %s vs %s' % ( i1 , i2 )
+        
 # =============================================================================
 if '__main__' == __name__ :
 
@@ -173,6 +220,7 @@ if '__main__' == __name__ :
     test_phasespace3i_permutations ()
     test_phasespace3a_permutations ()
     test_phasespace3_compare       ()
+    test_phasespace_approximation  ()
 
 
 
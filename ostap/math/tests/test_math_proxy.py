@@ -0,0 +1,120 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+## @file ostap/math/tests/test_math_proxy.py
+# Test module for the piecewise Chebyshev proxy Ostap::Math::ChebyshevProxy
+# =============================================================================
+""" Test module for the piecewise Chebyshev proxy Ostap::Math::ChebyshevProxy
+"""
+# =============================================================================
+import ROOT, random, math
+from   ostap.core.pyrouts     import Ostap
+import ostap.math.models
+from   ostap.utils.timing     import timing
+# ============================================================================
+from   ostap.logger.logger    import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.test_math_proxy' )
+else                       : logger = getLogger ( __name__                )
+# ============================================================================
+
+# =============================================================================
+## compare the proxy with the original functions 
+def test_proxy () :
+    """Compare the proxy with the original functions 
+    """
+
+    logger = getLogger ( 'test_proxy' )
+
+    functions = (
+        ( 'Gauss'       , Ostap.Math.Gauss       ( 1.0 , 0.1  )       , 0.0 , 2.0 ) ,
+        ( 'Voigt'       , Ostap.Math.Voigt       ( 1.0 , 0.05 , 0.1 ) , 0.0 , 2.0 ) ,
+        ( 'CrystalBall' , Ostap.Math.CrystalBall ( 1.0 , 0.1 , 1.5 , 2 ) , 0.0 , 2.0 ) ,
+        )
+
+    precision = 1.e-10 
+    for name , fun , xmin , xmax in functions :
+
+        with timing ( 'Proxy for %s' % name , logger = logger ) : 
+            proxy = Ostap.Math.ChebyshevProxy ( fun , xmin , xmax , precision )
+
+        xs   = [ random.uniform ( xmin , xmax ) for i in range ( 10000 ) ]
+        dmax = max ( abs ( proxy ( x ) - fun ( x ) ) for x in xs ) / proxy.scale () 
+        
+        logger.info ( '%-12s : #pieces %4d, max difference %.3g, estimated error %.3g' % (
+            name , proxy.pieces () , dmax , proxy.error () / proxy.scale () ) )
+        
+        assert dmax < 100 * precision , 'Proxy for %s is inaccurate!' % name
+        
+        i1 = proxy.integral  ( xmin , xmax )
+        i2 = fun  .integral  ( xmin , xmax ) 
+        assert abs ( i1 - i2 ) < 100 * precision * proxy.scale () * ( xmax - xmin ) , \
+               'Invalid integral of the proxy for %s : %s vs %s ' % ( name , i1 , i2 )
+
+        assert 0 == proxy ( xmin - 1 ) and 0 == proxy ( xmax + 1 ) , \
+               'Proxy for %s must be zero outside the range' % name 
+
+# =============================================================================
+## adaptive Chebyshev approximation (DCT and nested Chebyshev-Lobatto points) 
+def test_adaptive () :
+    """Adaptive Chebyshev approximation (DCT and nested Chebyshev-Lobatto points) 
+    """
+
+    logger = getLogger ( 'test_adaptive' )
+
+    fun         = Ostap.Math.Gauss ( 1.0 , 0.02 )
+    xmin , xmax = 0.5 , 1.5 
+    precision   = 1.e-10
+
+    with timing ( 'Adaptive approximation' , logger = logger ) : 
+        cheb = Ostap.Math.ChebyshevApproximation.adaptive ( fun , xmin , xmax , precision ) 
+        
+    xs   = [ random.uniform ( xmin , xmax ) for i in range ( 10000 ) ]
+    fmax = max ( fun ( x ) for x in xs ) 
+    dmax = max ( abs ( cheb ( x ) - fun ( x ) ) for x in xs ) / fmax 
+    logger.info ( 'Adaptive approximation : order %4d, max difference %.3g' % ( cheb.N () , dmax ) )
+    assert dmax < 100 * precision , 'Adaptive approximation is inaccurate!'
+
+# =============================================================================
+## summary statistics for the distribution from the proxy 
+def test_pdf_summary () :
+    """Summary statistics for the distribution from the proxy 
+    """
+
+    logger = getLogger ( 'test_pdf_summary' )
+
+    gauss = Ostap.Math.Gauss ( 1.0 , 0.1 )
+    with timing ( 'Summary for Gauss' , logger = logger ) : 
+        s = Ostap.Math.PdfSummary ( gauss , 0.0 , 2.0 )
+
+    logger.info ( 'mean/rms/median : %.10g/%.10g/%.10g' % ( s.mean () , s.rms () , s.median () ) )
+    logger.info ( 'skewness/kurtosis : %.3g/%.3g'       % ( s.skewness () , s.kurtosis () ) )
+    
+    assert abs ( s.mean     () - 1.0 ) < 1.e-8 , 'Invalid mean     %s' % s.mean     () 
+    assert abs ( s.rms      () - 0.1 ) < 1.e-8 , 'Invalid rms      %s' % s.rms      () 
+    assert abs ( s.median   () - 1.0 ) < 1.e-8 , 'Invalid median   %s' % s.median   () 
+    assert abs ( s.skewness ()       ) < 1.e-6 , 'Invalid skewness %s' % s.skewness () 
+    assert abs ( s.kurtosis ()       ) < 1.e-6 , 'Invalid kurtosis %s' % s.kurtosis () 
+
+    ## 1-sigma quantile and intervals 
+    q = s.quantile ( 0.5 * ( 1 + math.erf ( 1 / math.sqrt ( 2 ) ) ) ) 
+    assert abs ( q - 1.1 ) < 1.e-7 , 'Invalid quantile %s' % q
+    
+    prob = math.erf ( 1 / math.sqrt ( 2 ) )
+    h    = s.cl_symm  ( prob )
+    x1x2 = s.cl_asymm ( prob )
+    assert abs ( h - 0.1 ) < 1.e-7 , 'Invalid symmetric interval %s' % h 
+    assert abs ( x1x2.first  - 0.9 ) < 1.e-6 and abs ( x1x2.second - 1.1 ) < 1.e-6 , \
+           'Invalid asymmetric interval (%s,%s)' % ( x1x2.first , x1x2.second )
+    
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_proxy       () 
+    test_adaptive    () 
+    test_pdf_summary () 
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -0,0 +1,101 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+## @file ostap/math/tests/test_math_random.py
+#  Test module for the file ostap/math/random_ext.py
+# =============================================================================
+""" Test module for ostap/math/random_ext.py
+
+It tests counter-based reproducible streams of random numbers
+"""
+# =============================================================================
+from __future__ import print_function
+# =============================================================================
+from   ostap.core.core        import Ostap, VE, SE
+from   ostap.math.random_ext  import random_stream
+from   ostap.utils.timing     import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'tests_math_random'  )
+else                       : logger = getLogger ( __name__             )
+# =============================================================================
+
+# =============================================================================
+## Philox4x32-10 known-answer test
+def test_random_philox () :
+    """Philox4x32-10 known-answer test
+    """
+
+    C = Ostap.Math.Philox.Counter ()
+    K = Ostap.Math.Philox.Key     ()
+    for i in range ( 4 ) : C [ i ] = 0
+    for i in range ( 2 ) : K [ i ] = 0
+
+    r = Ostap.Math.Philox.block ( C , K )
+    r = tuple ( int ( v ) for v in r )
+    logger.info ( 'Philox4x32-10(0,0) : %s' % str ( tuple ( '%08x' % v for v in r ) ) )
+    assert r == ( 0x6627e8d5 , 0xe169c58d , 0xbc57ac4c , 0x9b00dbd8 ) , \
+           'Philox4x32-10: known-answer test failed!'
+
+# =============================================================================
+## array fills
+def test_random_stream () :
+    """Array fills
+    """
+
+    N  = 100000
+    rs = random_stream ( seed = 12345 , stream = 1 )
+
+    with timing ( 'Array fills' , logger = logger ) :
+        samples = ( ( 'uniform'      , rs.uniforms ( N                 ) , 0.5          , 1.0 / 12 ) ,
+                    ( 'gauss'        , rs.gausses  ( N , 1 , 2         ) , 1.0          , 4.0      ) ,
+                    ( 'gauss(VE)'    , rs.gausses  ( N , VE ( 1 , 4 )  ) , 1.0          , 4.0      ) ,
+                    ( 'poisson(3)'   , rs.poissons ( N , 3             ) , 3.0          , 3.0      ) ,
+                    ( 'poisson(500)' , rs.poissons ( N , 500           ) , 500.0        , 500.0    ) )
+
+    for name , values , mean , var  in samples :
+        cnt = SE ()
+        for v in values : cnt += v
+        logger.info ( '%-12s : %s' % ( name , cnt ) )
+        assert abs ( cnt.mean ().value () - mean ) < 5 * ( var / N ) ** 0.5 , \
+               'Invalid mean for %s' % name
+
+    b = rs.bifurs ( N , 0 , -1 , 2 )
+    assert len ( b ) == N , 'Invalid size of array!'
+
+# =============================================================================
+## reproducibility & substreams
+def test_random_substreams () :
+    """Reproducibility & substreams
+    """
+
+    r1 = random_stream ( seed = 12345 , stream = 7 )
+    r2 = random_stream ( seed = 12345 , stream = 7 )
+    r3 = r1.substream ( 8 )
+
+    a = list ( r1.uniforms ( 100 ) )
+    b = list ( r2.uniforms ( 100 ) )
+    c = list ( r3.uniforms ( 100 ) )
+
+    assert a == b , 'Streams are not reproducible!'
+    assert a != c , 'Substreams are the same!'
+
+    r2.reset ()
+    r2.seek  ( 10 )
+    d = list ( r2.uniforms ( 10 ) )
+    assert a [ 5 : 15 ] == d , 'Invalid seek!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_random_philox     ()
+    test_random_stream     ()
+    test_random_substreams ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -64,12 +64,41 @@ def test_root_mult () :
                                                           full_output = True  ,
                                                           disp        = False ) )
     
+def test_root_native () :
+
+    from ostap.core.core        import Ostap
+    from ostap.math.rootfinder  import native_solver
+    
+    gauss = Ostap.Math.Gauss ( 1.0 , 0.5 )
+
+    ## the root of the function: gauss(x) = 0.5 gauss(mean)  
+    half = 0.5 * gauss ( 1.0 ) 
+    x    = native_solver ( 'solve' , gauss ) ( gauss , half , 1.0 , 5.0 )
+    logger.info ( 'native/Brent   :  %.15g' % x ) 
+    assert abs ( x - 1.0 - 0.5 * math.sqrt ( 2 * math.log ( 2 ) ) ) < 1.e-10 , \
+           'Invalid native root %s' % x
+    
+    ## mode and width 
+    mode  = native_solver ( 'mode'  , gauss ) ( gauss , -5.0 , 5.0 )
+    width = native_solver ( 'width' , gauss ) ( gauss , -5.0 , 5.0 )
+    fwhm  = width.second - width.first
+    logger.info ( 'native/mode    :  %.15g' % mode ) 
+    logger.info ( 'native/FWHM    :  %.15g' % fwhm ) 
+    assert abs ( mode - 1.0 ) < 1.e-6 , 'Invalid native mode %s' % mode 
+    assert abs ( fwhm - 0.5 * 2 * math.sqrt ( 2 * math.log ( 2 ) ) ) < 1.e-8 , \
+           'Invalid native FWHM %s' % fwhm
+
+    ## median 
+    median = native_solver ( 'quantile' , gauss ) ( gauss , 0.5 , -5.0 , 5.0 )
+    logger.info ( 'native/median  :  %.15g' % median ) 
+    assert abs ( median - 1.0 ) < 1.e-6 , 'Invalid native median %s' % median 
 
 # =============================================================================
 if '__main__' == __name__ :
     
-    test_root_sin  () 
-    test_root_mult () 
+    test_root_sin    () 
+    test_root_mult   () 
+    test_root_native () 
     
     
 # =============================================================================
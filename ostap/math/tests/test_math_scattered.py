@@ -0,0 +1,77 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+## @file ostap/math/tests/test_math_scattered.py
+#  Test module for the interpolation of scattered data
+#  @see Ostap::Math::Scattered2D
+#  @see Ostap::Math::Scattered3D
+# =============================================================================
+""" Test module for the interpolation of scattered data
+- see Ostap::Math::Scattered2D
+- see Ostap::Math::Scattered3D
+"""
+# =============================================================================
+import ROOT, random, math
+from   ostap.core.core           import Ostap
+from   ostap.math.interpolation2 import scattered
+from   ostap.utils.timing        import timing
+# =============================================================================
+from   ostap.logger.logger       import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.test_math_scattered' )
+else                       : logger = getLogger ( __name__                    )
+# =============================================================================
+
+# =============================================================================
+## interpolation of scattered 2D and 3D data
+def test_scattered () :
+    """Interpolation of scattered 2D and 3D data
+    """
+
+    logger = getLogger ( 'test_scattered' )
+
+    N  = 2000
+    xs = [ random.uniform ( 0 , 1 ) for i in range ( N ) ]
+    ys = [ random.uniform ( 0 , 1 ) for i in range ( N ) ]
+    zs = [ random.uniform ( 0 , 1 ) for i in range ( N ) ]
+
+    fun2 = lambda x , y     : math.sin ( 3 * x ) * math.cos ( 2 * y )
+    fun3 = lambda x , y , z : x * y + z
+    lin2 = lambda x , y     : 1 + 2 * x - 3 * y
+
+    with timing ( 'Create interpolators' , logger = logger ) :
+        s2 = scattered ( ( xs , ys      ) , [ fun2 ( x , y     ) for x , y     in zip ( xs , ys      ) ] )
+        s3 = scattered ( ( xs , ys , zs ) , [ fun3 ( x , y , z ) for x , y , z in zip ( xs , ys , zs ) ] )
+        sl = scattered ( ( xs , ys      ) , [ lin2 ( x , y     ) for x , y     in zip ( xs , ys      ) ] )
+
+    qx = [ random.uniform ( 0.1 , 0.9 ) for i in range ( 1000 ) ]
+    qy = [ random.uniform ( 0.1 , 0.9 ) for i in range ( 1000 ) ]
+    qz = [ random.uniform ( 0.1 , 0.9 ) for i in range ( 1000 ) ]
+
+    with timing ( 'Batched queries' , logger = logger ) :
+        r2 = s2.evaluate_array ( qx , qy      )
+        r3 = s3.evaluate_array ( qx , qy , qz )
+
+    d2 = max ( abs ( r - fun2 ( x , y     ) ) for r , x , y     in zip ( r2 , qx , qy      ) )
+    d3 = max ( abs ( r - fun3 ( x , y , z ) ) for r , x , y , z in zip ( r3 , qx , qy , qz ) )
+    dl = max ( abs ( sl ( x , y ) - lin2 ( x , y ) ) for x , y in zip ( qx , qy ) )
+    logger.info ( 'Max difference 2D/3D/linear: %.3g/%.3g/%.3g' % ( d2 , d3 , dl ) )
+
+    assert d2 < 1.e-2  , 'Invalid 2D interpolation!'
+    assert d3 < 1.e-2  , 'Invalid 3D interpolation!'
+    assert dl < 1.e-10 , 'Linear function must be reproduced!'
+    assert s2 ( xs [ 7 ] , ys [ 7 ] ) == fun2 ( xs [ 7 ] , ys [ 7 ] ) , 'Data point must be reproduced!'
+
+    ## IFuncTree adapter
+    fun = Ostap.Functions.Func2D ( s2 , 'x' , 'y' )
+    assert abs ( fun.func ( 0.5 , 0.5 ) - s2 ( 0.5 , 0.5 ) ) < 1.e-12 , 'Invalid Func2D adapter!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_scattered ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
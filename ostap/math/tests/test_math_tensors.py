@@ -0,0 +1,94 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+## @file ostap/math/tests/test_math_tensors.py
+# Test module for the batched Levi-Civita and metric contractions
+# @see Ostap::Math::Tensors::Epsilon
+# =============================================================================
+""" Test module for the batched Levi-Civita and metric contractions
+- see Ostap.Math.Tensors.Epsilon
+"""
+# =============================================================================
+import ROOT, random
+from   array                  import array
+from   ostap.core.pyrouts     import Ostap
+import ostap.math.kinematic
+# ============================================================================
+from   ostap.logger.logger    import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.test_math_tensors' )
+else                       : logger = getLogger ( __name__                 )
+# ============================================================================
+
+N = 1000
+## six sets of the 4-vectors in the structure-of-arrays form
+columns = [ [ array ( 'd' , [ random.uniform ( -5 , 5 ) for i in range ( N ) ] ) for c in range ( 4 ) ] for k in range ( 6 ) ]
+
+def vectors ( k ) :
+    return Ostap.Math.Tensors.Vectors ( *columns [ k ] )
+def lorentz ( k , i ) :
+    return Ostap.LorentzVector ( *[ c [ i ] for c in columns [ k ] ] )
+
+# =============================================================================
+## compare the batched and scalar contractions
+def test_tensors () :
+    """Compare the batched and scalar contractions
+    """
+
+    logger = getLogger ( 'test_tensors' )
+
+    E  = Ostap.Math.Tensors.Epsilon
+    G  = Ostap.Math.Tensors.G
+    V  = [ vectors ( k ) for k in range ( 6 ) ]
+    rr = array ( 'd' , N * [ 0.0 ] )
+
+    ## metric
+    G.dot ( N , V [ 0 ] , V [ 1 ] , rr )
+    dmax = max ( abs ( r - lorentz ( 0 , i ).Dot ( lorentz ( 1 , i ) ) ) for i , r in enumerate ( rr ) )
+    logger.info ( '%-16s : max difference %.3g' % ( 'dot' , dmax ) )
+    assert dmax < 1.e-12 , 'Batched and scalar metric contractions differ!'
+
+    ## e(a,b,c,d)
+    E.epsilon ( N , V [ 0 ] , V [ 1 ] , V [ 2 ] , V [ 3 ] , rr )
+    dmax = max ( abs ( r - E.epsilon ( lorentz ( 0 , i ) , lorentz ( 1 , i ) ,
+                                       lorentz ( 2 , i ) , lorentz ( 3 , i ) ) ) / max ( 1.0 , abs ( r ) )
+                 for i , r in enumerate ( rr ) )
+    logger.info ( '%-16s : max difference %.3g' % ( 'epsilon(4)' , dmax ) )
+    assert dmax < 1.e-12 , 'Batched and scalar epsilon(4) differ!'
+
+    ## e(a,b,c,d)*e(e,f,g,d)
+    E.epsilon ( N , V [ 0 ] , V [ 1 ] , V [ 2 ] , V [ 3 ] , V [ 4 ] , V [ 5 ] , rr )
+    dmax = max ( abs ( r - E.epsilon ( lorentz ( 0 , i ) , lorentz ( 1 , i ) , lorentz ( 2 , i ) ,
+                                       lorentz ( 3 , i ) , lorentz ( 4 , i ) , lorentz ( 5 , i ) ) ) / max ( 1.0 , abs ( r ) )
+                 for i , r in enumerate ( rr ) )
+    logger.info ( '%-16s : max difference %.3g' % ( 'epsilon(6)' , dmax ) )
+    assert dmax < 1.e-12 , 'Batched and scalar epsilon(6) differ!'
+
+    ## mag2
+    E.mag2 ( N , V [ 0 ] , V [ 1 ] , V [ 2 ] , rr )
+    dmax = max ( abs ( r - E.mag2 ( lorentz ( 0 , i ) , lorentz ( 1 , i ) , lorentz ( 2 , i ) ) ) / max ( 1.0 , abs ( r ) )
+                 for i , r in enumerate ( rr ) )
+    logger.info ( '%-16s : max difference %.3g' % ( 'mag2' , dmax ) )
+    assert dmax < 1.e-12 , 'Batched and scalar mag2 differ!'
+
+    ## e(a,b,c) as a 4-vector
+    out  = [ array ( 'd' , N * [ 0.0 ] ) for c in range ( 4 ) ]
+    E.epsilon ( N , V [ 0 ] , V [ 1 ] , V [ 2 ] , Ostap.Math.Tensors.OutVectors ( *out ) )
+    dmax = 0
+    for i in range ( N ) :
+        v    = E.epsilon ( lorentz ( 0 , i ) , lorentz ( 1 , i ) , lorentz ( 2 , i ) )
+        dmax = max ( dmax ,
+                     abs ( out [ 0 ] [ i ] - v.Px () ) , abs ( out [ 1 ] [ i ] - v.Py () ) ,
+                     abs ( out [ 2 ] [ i ] - v.Pz () ) , abs ( out [ 3 ] [ i ] - v.E  () ) )
+    logger.info ( '%-16s : max difference %.3g' % ( 'epsilon(3)' , dmax ) )
+    assert dmax < 1.e-10 , 'Batched and scalar epsilon(3) differ!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_tensors ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
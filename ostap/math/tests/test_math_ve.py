@@ -26,11 +26,52 @@ def test_ve():
     assert ( (a+b).value() == 500           )
     assert ( (b-a).value() == 300           )
     assert ( (a+b).error() == (a-b).error() ) 
+
+# =============================================================================
+## element-wise operations with VEArray agree with VE 
+def test_vearray():
+
+    import random
+    from ostap.core.core    import Ostap 
+    from ostap.math.ve      import VE, VVE, VEA
+    
+    va = VVE ()
+    vb = VVE ()
+    for i in range ( 100 ) :
+        va.push_back ( VE ( random.uniform ( 1 , 2 ) , random.uniform ( 0 , 0.01 ) ) )
+        vb.push_back ( VE ( random.uniform ( 1 , 2 ) , random.uniform ( 0 , 0.01 ) ) )
+        
+    a , b = VEA ( va ) , VEA ( vb )
+    c     = VE ( 1.5 , 0.01 )
+    
+    import ostap.math.math_ve as MVE 
+    for r , f in ( ( a + b       , lambda x , y : x + y       ) ,
+                   ( a - b       , lambda x , y : x - y       ) ,
+                   ( a * b       , lambda x , y : x * y       ) ,
+                   ( a / b       , lambda x , y : x / y       ) ,
+                   ( a / c       , lambda x , y : x / c       ) ,
+                   ( 2.0 - a     , lambda x , y : 2.0 - x     ) ,
+                   ( Ostap.Math.exp ( a ) , lambda x , y : MVE.exp ( x ) ) ,
+                   ( Ostap.Math.log ( a ) , lambda x , y : MVE.log ( x ) ) ) :
+        for v , x , y in zip ( r , va , vb ) :
+            e = f ( x , y )
+            assert abs ( v.value () - e.value () ) < 1.e-12 and abs ( v.cov2 () - e.cov2 () ) < 1.e-12 , \
+                   'VEArray/VE mismatch: %s vs %s' % ( v , e )
+            
+    assert abs ( a.sum ().value () - Ostap.Math.sum ( va ).value () ) < 1.e-10 , 'Invalid sum'
+    logger.info ( 'mean/weighted average: %s/%s' % ( a.mean () , a.weighted_average () ) )
+    
+    vals = a.values_array ()
+    assert len ( vals ) == len ( a ) and vals [ 5 ] == a [ 5 ].value () , 'Invalid values'
+    
+    import pickle
+    assert all ( p.value () == q.value () for p , q in zip ( pickle.loads ( pickle.dumps ( a ) ) , a ) ) , 'Invalid pickling'
     
 # =============================================================================
 if '__main__' == __name__ :
 
     test_ve()
+    test_vearray()
     
 # =============================================================================
 # The END 
@@ -23,6 +23,7 @@ r""" Simple `value-with-error' concept
 __all__     = (
     'VE'  ,  # Value with error  
     'VVE' ,  # vector of values with errors
+    'VEA' ,  # array of values with errors (structure-of-arrays) 
     )
 # ============================================================================= 
 import ROOT
@@ -409,11 +410,124 @@ def ve_reduce ( v ) :
 
 Ostap.Math.ValueWithError.__reduce__ = ve_reduce
 
+# =============================================================================
+## Array of values with errors in "structure-of-arrays" layout
+#  @code
+#  a = VEA ( histo1 )
+#  b = VEA ( histo2 )
+#  r = a / b 
+#  r.to_histo ( histo3 )
+#  @endcode 
+#  @see Ostap::Math::VEArray
+VEA = Ostap.Math.VEArray
+
+# =============================================================================
+## get the element of VEArray
+def _vea_getitem_ ( s , index ) :
+    """Get the element of the array 
+    >>> a = VEA ( ... )
+    >>> v = a [ 2 ]
+    """
+    n = len ( s )
+    if index < 0 : index += n
+    if not 0 <= index < n : raise IndexError ( 'Invalid index %s' % index )
+    return s.at ( index )
+
+# =============================================================================
+## iterate over the elements of VEArray
+def _vea_iter_ ( s ) :
+    """Iterate over the elements of the array 
+    >>> a = VEA ( ... )
+    >>> for v in a : print ( v ) 
+    """
+    for i in range ( len ( s ) ) : yield s.at ( i )
+
+# =============================================================================
+## get the values of VEArray as numpy array (no copy) or array.array (copy)
+#  @code
+#  a = VEA ( ... )
+#  v = a.values_array()
+#  @endcode 
+def _vea_values_ ( s ) :
+    """Get the values as numpy-array (no copy) or array.array (copy)
+    >>> a = VEA ( ... )
+    >>> v = a.values_array() 
+    """
+    return _vea_buffer_ ( s.values () ) 
+
+# =============================================================================
+## get the squared uncertainties of VEArray as numpy array (no copy) or array.array (copy)
+#  @code
+#  a = VEA ( ... )
+#  c = a.cov2s_array()
+#  @endcode 
+def _vea_cov2s_ ( s ) :
+    """Get the squared uncertainties as numpy-array (no copy) or array.array (copy)
+    >>> a = VEA ( ... )
+    >>> c = a.cov2s_array() 
+    """
+    return _vea_buffer_ ( s.cov2s () ) 
+
+try : 
+    import numpy as _np
+    def _vea_buffer_ ( vct ) :
+        if not len ( vct ) : return _np.zeros ( 0 , dtype = float ) 
+        return _np.frombuffer ( vct.data () , count = len ( vct ) , dtype = float )
+except ImportError :
+    _np = None 
+    from array import array as _array 
+    def _vea_buffer_ ( vct ) :
+        return _array ( 'd' , vct )
+
+# =============================================================================
+## create VEArray from the sequences (numpy arrays) of values and squared uncertainties
+#  @code
+#  a = vea_from_arrays ( values , cov2s )
+#  @endcode 
+def vea_from_arrays ( values , cov2s = () ) :
+    """Create VEArray from the sequences (e.g. numpy arrays) of values and squared uncertainties
+    >>> a = vea_from_arrays ( values , cov2s )
+    """
+    VD = std.vector ( 'double' )
+    vv = VD () ; vv.reserve ( len ( values ) ) 
+    for v in values : vv.push_back ( float ( v ) )
+    vc = VD () ; vc.reserve ( len ( cov2s  ) ) 
+    for c in cov2s  : vc.push_back ( float ( c ) )
+    return VEA ( vv , vc )
+
+# =============================================================================
+## factory for unpickling of <code>Ostap::Math::VEArray</code>
+def vea_factory ( values , cov2s ) :
+    """Factory for unpickling of <code>Ostap::Math::VEArray</code>
+    """
+    return vea_from_arrays ( values , cov2s )
+
+# =============================================================================
+## reduce <code>Ostap::Math::VEArray</code>
+def vea_reduce ( s ) :
+    """Reduce `Ostap.Math.VEArray`
+    """
+    return vea_factory , ( tuple ( s.values () ) , tuple ( s.cov2s () ) )
+
+VEA.__len__      = lambda s : s.size () 
+VEA.__getitem__  = _vea_getitem_
+VEA.__iter__     = _vea_iter_
+VEA.__str__      = lambda s : str ( [ i for i in s ] )
+VEA.__repr__     = lambda s : str ( [ i for i in s ] )
+VEA.values_array = _vea_values_ 
+VEA.cov2s_array  = _vea_cov2s_
+VEA.from_arrays  = staticmethod ( vea_from_arrays ) 
+VEA.__reduce__   = vea_reduce
+
+## convert the vector of values with errors into VEArray 
+VE.Vector.asarray = lambda s : VEA ( s ) 
+
 # =============================================================================
 ## decorated classes 
 _decorated_classes_  = (
     Ostap.Math.ValueWithError         ,
     Ostap.Math.ValueWithError.Vector  ,
+    Ostap.Math.VEArray                ,
     Ostap.Math.Point3DWithError       ,
     Ostap.Math.Vector3DWithError      ,
     Ostap.Math.LorentzVectorWithError )
@@ -441,6 +555,16 @@ _new_methods_ = (
     VE . gauss            , 
     VE . poisson          ,
     VE . __reduce__       ,
+    VE.Vector . asarray   , 
+    VEA . __len__         , 
+    VEA . __getitem__     , 
+    VEA . __iter__        , 
+    VEA . __str__         , 
+    VEA . __repr__        , 
+    VEA . values_array    , 
+    VEA . cov2s_array     , 
+    VEA . from_arrays     , 
+    VEA . __reduce__      , 
    )
 
 
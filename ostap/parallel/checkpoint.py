@@ -0,0 +1,194 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/parallel/checkpoint.py
+#  Checkpoints for the long <code>TaskManager</code> runs:
+#  the merged partial results and the identifiers of the completed items
+#  are periodically saved into the compressed shelve database,
+#  and the next run with the same checkpoint file resumes the processing,
+#  re-running only the unfinished items
+#
+#  - the partial results are stored in the same format as the results
+#    of the groups merged at the remote hosts (see group_executor),
+#    therefore they are merged with <code>Task.merge_results</code>
+#  - the checkpoint is removed after the successful end of processing
+#  - the checkpoint is saved also when the processing is interrupted
+#
+#  @code
+#  wm = WorkManager ( ... )
+#  wm.process ( task , items , checkpoint = 'my_run.zip' )
+#  wm.process ( task , items , checkpoint = 'my_run.zip' , checkpoint_period = 60 )
+#  @endcode
+#  @attention the items are identified by their positions,
+#             the list of items must be the same for the resumed run
+#  @see ostap.io.zipshelve
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Checkpoints for the long `TaskManager` runs:
+the merged partial results and the identifiers of the completed items
+are periodically saved into the compressed shelve database,
+and the next run with the same checkpoint file resumes the processing,
+re-running only the unfinished items
+
+- the partial results are stored in the same format as the results
+  of the groups merged at the remote hosts (see group_executor),
+  therefore they are merged with `Task.merge_results`
+- the checkpoint is removed after the successful end of processing
+- the checkpoint is saved also when the processing is interrupted
+
+>>> wm = WorkManager ( ... )
+>>> wm.process ( task , items , checkpoint = 'my_run.zip' )
+>>> wm.process ( task , items , checkpoint = 'my_run.zip' , checkpoint_period = 60 )
+
+- attention: the items are identified by their positions,
+  the list of items must be the same for the resumed run
+- see ostap.io.zipshelve
+"""
+# =============================================================================
+__author__  = 'Vanya BELYAEV Ivan.Belyaev@itep.ru'
+__date__    = '2026-10-15'
+__all__     = (
+    'Checkpoint' , ## checkpoint for the long TaskManager runs
+    )
+# =============================================================================
+import os, time
+from   ostap.logger.logger import getLogger
+if '__main__' == __name__ : logger = getLogger ( 'ostap.parallel.checkpoint' )
+else                      : logger = getLogger ( __name__                    )
+# =============================================================================
+## @class Checkpoint
+#  Checkpoint for the long <code>TaskManager</code> runs
+#  @code
+#  cp = Checkpoint ( 'my_run.zip' , signature = ( 'MyTask' , 100 ) , period = 300 )
+#  done , result = cp.load ()
+#  ...
+#  if cp.due () : cp.save ( done , result )
+#  ...
+#  cp.remove ()
+#  @endcode
+class Checkpoint(object) :
+    """Checkpoint for the long `TaskManager` runs
+    >>> cp = Checkpoint ( 'my_run.zip' , signature = ( 'MyTask' , 100 ) , period = 300 )
+    >>> done , result = cp.load ()
+    >>> ...
+    >>> if cp.due () : cp.save ( done , result )
+    >>> ...
+    >>> cp.remove ()
+    """
+    def __init__ ( self , filename , signature , period = 300 ) :
+
+        filename = os.path.abspath ( os.path.expandvars ( os.path.expanduser ( filename ) ) )
+        base , ext = os.path.splitext ( filename )
+        if not ext.lower() in ( '.zip' , '.tgz' , '.gz' ) : filename += '.zip'
+
+        self.__filename  = filename
+        self.__signature = signature
+        self.__period    = max ( 0 , period )
+        self.__last      = time.time ()
+        self.__nsaved    = 0
+
+    @property
+    def filename ( self ) :
+        """``filename'' : the name of the checkpoint file"""
+        return self.__filename
+
+    @property
+    def signature ( self ) :
+        """``signature'' : the signature of the run (e.g. the task type and the number of items)"""
+        return self.__signature
+
+    @property
+    def period ( self ) :
+        """``period'' : the minimal period between the checkpoints (seconds)"""
+        return self.__period
+
+    @property
+    def nsaved ( self ) :
+        """``nsaved'' : number of saved checkpoints"""
+        return self.__nsaved
+
+    # =========================================================================
+    ## load the checkpoint: the set of completed items and the merged partial result
+    #  - the empty set and <code>None</code> are returned if there is no valid checkpoint
+    def load ( self ) :
+        """Load the checkpoint: the set of completed items and the merged partial result
+        - the empty set and `None` are returned if there is no valid checkpoint
+        """
+        if not os.path.exists ( self.filename ) : return set () , None
+
+        import ostap.io.zipshelve as zipshelve
+        try :
+            db = zipshelve.open ( self.filename , 'r' )
+            try :
+                signature = db.get ( 'signature' , None )
+                done      = set ( db.get ( 'done' , () ) )
+                result    = db.get ( 'result' , None )
+            finally :
+                db.close ()
+        except Exception :
+            logger.warning ( "Checkpoint: cannot load ``%s'', start from scratch" % self.filename )
+            return set () , None
+
+        if signature != self.signature :
+            logger.warning ( "Checkpoint: signature mismatch %s vs %s, start from scratch" % ( signature , self.signature ) )
+            return set () , None
+
+        return done , result
+
+    # =========================================================================
+    ## is it time to save the checkpoint?
+    def due ( self ) :
+        """Is it time to save the checkpoint?"""
+        return self.period <= time.time () - self.__last
+
+    # =========================================================================
+    ## save the checkpoint: the set of completed items and the merged partial result
+    #  - the file is replaced atomically
+    def save ( self , done , result ) :
+        """Save the checkpoint: the set of completed items and the merged partial result
+        - the file is replaced atomically
+        """
+        import ostap.io.zipshelve as zipshelve
+        base , ext = os.path.splitext ( self.filename )
+        tmpfile    = '%s.%d.tmp%s' % ( base , os.getpid () , ext )
+        try :
+            db = zipshelve.open ( tmpfile , 'n' )
+            try :
+                db [ 'signature' ] = self.signature
+                db [ 'done'      ] = sorted ( done )
+                db [ 'result'    ] = result
+                db [ 'time'      ] = time.time ()
+            finally :
+                db.close ()
+            if hasattr ( os , 'replace' ) : os.replace ( tmpfile , self.filename )
+            else :
+                if os.path.exists ( self.filename ) : os.remove ( self.filename )
+                os.rename ( tmpfile , self.filename )
+        except Exception :
+            logger.warning ( "Checkpoint: cannot save ``%s''" % self.filename )
+            if os.path.exists ( tmpfile ) : os.remove ( tmpfile )
+            return False
+
+        self.__last    = time.time ()
+        self.__nsaved += 1
+        return True
+
+    # =========================================================================
+    ## remove the checkpoint file
+    def remove ( self ) :
+        """Remove the checkpoint file"""
+        if os.path.exists ( self.filename ) : os.remove ( self.filename )
+
+    def __repr__ ( self ) :
+        return "Checkpoint('%s',period=%s)" % ( self.filename , self.period )
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -0,0 +1,116 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# ==========================================================================================
+## @file ostap/parallel/parallel_catalog.py
+#  Scan ROOT files (entries, branches, cluster boundaries for trees) in parallel
+#  @see ostap.trees.catalog
+#  @date   2023-03-10
+#  @author Vanya  BELYAEV Ivan.Belyaev@itep.ru
+# =============================================================================
+""" Scan ROOT files (entries, branches, cluster boundaries for trees) in parallel
+- see ostap.trees.catalog
+"""
+# =============================================================================
+__author__  = 'Vanya BELYAEV  Ivan.Belyaev@itep.ru'
+__date__    = "2023-03-10"
+__version__ = '$Revision$'
+__all__     = (
+    'scan_files' , ## scan files in parallel
+    )
+# =============================================================================
+# logging 
+# =============================================================================
+from ostap.logger.logger import getLogger 
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.parallel.catalog' )
+else                       : logger = getLogger ( __name__                 )
+# =============================================================================
+import ROOT
+from   ostap.parallel.parallel import Task, WorkManager
+# =============================================================================
+## The simple task object for parallel scan of files 
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2023-03-10
+class  CatalogTask(Task) :
+    """The simple task object for parallel scan of files
+    """
+    ## 
+    def __init__ ( self , trees ) :
+        
+        self.__trees      = tuple ( trees ) 
+        self.__the_output = {} 
+
+    @property
+    def the_output ( self ) :
+        return self.__the_output
+    @the_output.setter 
+    def the_output ( self , value ) :
+        self.__the_output = value 
+    
+    def initialize_local   ( self ) : self.__the_output = {}
+
+    ## get the results 
+    def results ( self ) :
+        return self.__the_output
+    
+    ## the actual processing: (file,cached record) pairs 
+    def process ( self , jobid , items ) :
+
+        from ostap.trees.catalog import file_stat, scan_file, valid 
+        
+        results = {} 
+        for the_file , record in items :
+            stat = file_stat ( the_file )
+            if not valid ( record , stat , self.__trees ) : 
+                record = scan_file ( the_file , self.__trees , stat = stat )
+            results [ the_file ] = record 
+            
+        self.the_output = results 
+        
+        return self.results() 
+
+    ## merge results 
+    def merge_results ( self , result , jobid = -1 ) :
+        """Merge results
+        """
+        self.the_output.update ( result )
+        
+        return self.results () 
+    
+# =============================================================================
+## Scan files in parallel
+#  @code
+#  records = scan_files ( files , ( 'Bc/MyTree' , ) ) 
+#  @endcode 
+#  @param files   list of files
+#  @param trees   names of trees
+#  @param records already known (possibly invalid) records  
+#  @return dictionary { file : record } , see ostap.trees.catalog.scan_file 
+def scan_files ( files , trees , records = {} , progress = True , maxfiles = 10 , **kwargs ) :
+    """Scan files in parallel
+    >>> records = scan_files ( files , ( 'Bc/MyTree' , ) ) 
+    - return dictionary { file : record } , see ostap.trees.catalog.scan_file 
+    """
+
+    task = CatalogTask ( trees = trees )
+    
+    wmgr  = WorkManager ( silent = not progress , **kwargs )
+    
+    if maxfiles < 1 : maxfiles = 1
+    
+    from ostap.utils.utils import chunked
+    items = [ ( f , records.get ( f , None ) ) for f in files ]
+    data  = chunked ( items , maxfiles )
+    
+    wmgr.process( task , data )
+
+    return task.results () 
+
+# =============================================================================
+if '__main__' == __name__ :
+    
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+    
+# =============================================================================
+#                                                                       The END 
+# =============================================================================
@@ -0,0 +1,315 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/parallel/parallel_farm.py
+#  "Fit farm": fit the same model in many kinematic bins in parallel
+#  - the data are split into the bin datasets in a single pass
+#  - the bins are fitted in parallel, each worker fits a contiguous
+#    chain of neighbouring bins using the own copy of the model
+#  - each fit is (optionally) warm-started from the previous (neighbour) bin
+#  @see Ostap::Utils::split_dataset
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""The "fit farm": fit the same model in many kinematic bins in parallel
+- the data are split into the bin datasets in a single pass
+- the bins are fitted in parallel, each worker fits a contiguous
+  chain of neighbouring bins using the own copy of the model
+- each fit is (optionally) warm-started from the previous (neighbour) bin
+- see Ostap::Utils::split_dataset
+"""
+# =============================================================================
+__version__ = "$Revision$"
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'split_bins' , ## split the data into the bin datasets in a single pass
+    'fit_farm'   , ## fit the model in many bins in parallel
+    'farm_histo' , ## fill the histogram with the results of the fit farm
+    )
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.parallel.parallel_farm' )
+else                       : logger = getLogger ( __name__     )
+# =============================================================================
+import ROOT
+from   ostap.core.core         import Ostap, dsID
+from   ostap.parallel.parallel import Task, WorkManager
+# =============================================================================
+## get the bin keys for the binning histogram in the "snake" order:
+#  the consecutive bins are always the neighbours
+def _snake_keys_ ( binning ) :
+    """Get the bin keys for the binning histogram in the "snake" order:
+    the consecutive bins are always the neighbours
+    """
+    dim = binning.GetDimension ()
+    nx  = binning.GetXaxis().GetNbins ()
+    ny  = binning.GetYaxis().GetNbins () if 2 <= dim else 1
+    nz  = binning.GetZaxis().GetNbins () if 3 <= dim else 1
+
+    keys = []
+    for iz in range ( 1 , nz + 1 ) :
+        ys = range ( 1 , ny + 1 ) if 1 == iz % 2 else range ( ny , 0 , -1 )
+        for k , iy in enumerate ( ys ) :
+            xs = range ( 1 , nx + 1 ) if 0 == ( k + iz - 1 ) % 2 else range ( nx , 0 , -1 )
+            for ix in xs :
+                if   3 == dim : keys.append ( ( ix , iy , iz ) )
+                elif 2 == dim : keys.append ( ( ix , iy ) )
+                else          : keys.append ( ( ix , ) )
+    return keys
+
+# =============================================================================
+## split the data into the bin datasets in a single pass
+#  @code
+#  binning = ROOT.TH2D ( ... )  ## pt x eta
+#  bins    = split_bins ( dataset , binning , 'pt' , 'eta' )
+#  for key , ds in bins.items() : ...
+#  @endcode
+#  @param dataset the dataset
+#  @param binning the binning histogram (1D, 2D or 3D)
+#  @param xvar    the name of x-variable
+#  @param yvar    the name of y-variable (for 2D and 3D binning)
+#  @param zvar    the name of z-variable (for 3D binning)
+#  @return dictionary { (ix,iy,...) : dataset } (bin numbers start from 1)
+#  @see Ostap::Utils::split_dataset
+def split_bins ( dataset , binning , xvar , yvar = '' , zvar = '' ) :
+    """Split the data into the bin datasets in a single pass
+    >>> binning = ROOT.TH2D ( ... )  ## pt x eta
+    >>> bins    = split_bins ( dataset , binning , 'pt' , 'eta' )
+    >>> for key , ds in bins.items() : ...
+    - return dictionary { (ix,iy,...) : dataset } (bin numbers start from 1)
+    - see Ostap::Utils::split_dataset
+    """
+    if not isinstance ( dataset , ROOT.RooAbsData ) and hasattr ( dataset , 'dset' ) :
+        dataset = dataset.dset
+
+    names = []
+    for v in ( xvar , yvar , zvar ) :
+        if   not v                 : names.append ( '' )
+        elif hasattr ( v , 'name' ) : names.append ( v.name )
+        else                       : names.append ( str ( v ) )
+
+    dim = binning.GetDimension ()
+    nx  = binning.GetXaxis().GetNbins ()
+    ny  = binning.GetYaxis().GetNbins () if 2 <= dim else 1
+    nz  = binning.GetZaxis().GetNbins () if 3 <= dim else 1
+
+    datasets = [ dataset.emptyClone ( dsID () ) for i in range ( nx * ny * nz ) ]
+    vct      = ROOT.std.vector('RooAbsData*')()
+    vct.reserve ( len ( datasets ) )
+    for ds in datasets : vct.push_back ( ds )
+
+    Ostap.Utils.split_dataset ( dataset , vct , binning , *names )
+
+    result = {}
+    for key in sorted ( _snake_keys_ ( binning ) ) :
+        ix , iy , iz = key + ( 1 , ) * ( 3 - len ( key ) )
+        result [ key ] = datasets [ ( ix - 1 ) + nx * ( ( iy - 1 ) + ny * ( iz - 1 ) ) ]
+
+    return result
+
+# =============================================================================
+## @class FarmTask
+#  The simple task object for the parallel fit farm
+#  - the chain of the neighbouring bins is fitted sequentially,
+#    each fit is warm-started from the previous successful fit
+class FarmTask(Task) :
+    """The simple task object for the parallel fit farm
+    - the chain of the neighbouring bins is fitted sequentially,
+      each fit is warm-started from the previous successful fit
+    """
+    ## partial results can be merged at the remote host
+    mergeable = True
+    ##
+    def __init__ ( self , pdf , start = {} , warm = True , fit_config = {} ) :
+
+        self.pdf        = pdf
+        self.start      = start
+        self.warm       = warm
+        self.fit_config = fit_config
+
+        self.__output   = {}
+
+    def initialize_local ( self ) : self.__output = {}
+
+    ## the actual processing: fit the chain of bins
+    def process ( self , jobid , items ) :
+
+        from ostap.logger.logger import logWarning
+        with logWarning() :
+            import ostap.core.pyrouts
+            import ostap.fitting.roofit
+            import ostap.fitting.dataset
+            import ostap.fitting.variables
+            import ostap.fitting.roofitresult
+
+        output = {}
+        params = self.start
+        for key , dataset in items :
+
+            if not dataset or 0 == len ( dataset ) :
+                output [ key ] = -1 , {}
+                continue
+
+            self.pdf.load_params ( params , dataset , silent = True )
+            result , _ = self.pdf.fitTo ( dataset , silent = True , draw = False , **self.fit_config )
+
+            status = result.status ()
+            values = result.dct_params ()
+            output [ key ] = status , values
+
+            ## warm start for the next (neighbour) bin
+            if self.warm and 0 == status : params = values
+            else                         : params = self.start
+
+        return output
+
+    ## merge results
+    def merge_results ( self , result , jobid = -1 ) :
+        """Merge results of the fit farm"""
+        if result : self.__output.update ( result )
+
+    ## get the results
+    def results ( self ) : return self.__output
+
+# =============================================================================
+## fit the same model in many bins in parallel
+#  @code
+#  binning = ROOT.TH2D ( 'b' , '' , 10 , 0 , 10 , 4 , 2 , 5 )  ## pt x eta
+#  table   = fit_farm ( model , dataset , binning , 'pt' , 'eta' , nsplit = 16 )
+#  for key , ( status , params ) in table.items() :
+#      print ( key , status , params['S'] )
+#  @endcode
+#  The data can be <code>RooAbsData</code> or <code>TTree</code>.
+#  For the tree, the dataset with observables of the model and binning
+#  variables is filled first (in several threads)
+#  @param pdf        the model
+#  @param dataset    the data (<code>RooAbsData</code> or <code>TTree</code>)
+#  @param binning    the binning histogram (1D, 2D or 3D)
+#  @param xvar       the x-variable
+#  @param yvar       the y-variable (for 2D and 3D binning)
+#  @param zvar       the z-variable (for 3D binning)
+#  @param warm       warm start from the previous neighbour bin?
+#  @param nsplit     number of chains of neighbouring bins
+#  @param selection  the selection (only for TTree)
+#  @param nthreads   number of threads to read TTree
+#  @param fit_config configuration for <code>fitTo</code>
+#  @return dictionary { (ix,iy,...) : ( status , { name : VE } ) }
+#  @see Ostap::Utils::split_dataset
+def fit_farm ( pdf               ,
+               dataset           ,
+               binning           ,
+               xvar              ,
+               yvar       = ''   ,
+               zvar       = ''   ,
+               warm       = True ,
+               nsplit     = 0    ,
+               selection  = ''   ,
+               nthreads   = 0    ,
+               fit_config = {}   ,
+               silent     = True , **kwargs ) :
+    """Fit the same model in many bins in parallel
+    >>> binning = ROOT.TH2D ( 'b' , '' , 10 , 0 , 10 , 4 , 2 , 5 )  ## pt x eta
+    >>> table   = fit_farm ( model , dataset , binning , 'pt' , 'eta' , nsplit = 16 )
+    >>> for key , ( status , params ) in table.items() :
+    ...     print ( key , status , params['S'] )
+    The data can be `RooAbsData` or `TTree`.
+    For the tree, the dataset with observables of the model and binning
+    variables is filled first (in several threads)
+    - return dictionary { (ix,iy,...) : ( status , { name : VE } ) }
+    - see Ostap::Utils::split_dataset
+    """
+
+    if isinstance ( dataset , ROOT.TTree ) :
+
+        import ostap.fitting.variables
+        vlist = ROOT.RooArgList ()
+        exprs = []
+        for v in pdf.vars :
+            vlist.add ( v )
+            exprs.append ( v.name )
+
+        axes = binning.GetXaxis () , binning.GetYaxis () , binning.GetZaxis ()
+        for v , axis in zip ( ( xvar , yvar , zvar ) , axes ) :
+            if not v : continue
+            if not isinstance ( v , ROOT.RooAbsReal ) :
+                v = ROOT.RooRealVar ( str ( v ) , str ( v ) , axis.GetXmin () , axis.GetXmax () )
+            if vlist.find ( v.name ) : continue
+            vlist.add ( v )
+            exprs.append ( v.name )
+
+        ds = ROOT.RooDataSet ( dsID () , 'Data for fit farm' , ROOT.RooArgSet ( vlist ) )
+        Ostap.Utils.fill_datasetMT ( dataset , ds , vlist , exprs , selection , nthreads )
+        dataset = ds
+
+    bins  = split_bins ( dataset , binning , xvar , yvar , zvar )
+    keys  = _snake_keys_ ( binning )
+
+    ## contiguous chains of the neighbouring bins
+    if nsplit <= 0 : nsplit = max ( 1 , len ( keys ) // 4 )
+    nsplit = max ( 1 , min ( nsplit , len ( keys ) ) )
+    n , r  = divmod ( len ( keys ) , nsplit )
+    chains , first = [] , 0
+    for i in range ( nsplit ) :
+        last = first + n + ( 1 if i < r else 0 )
+        chains.append ( [ ( k , bins [ k ] ) for k in keys [ first : last ] ] )
+        first = last
+
+    start = {}
+    for p in pdf.params ( dataset ) :
+        if hasattr ( p , 'getVal' ) : start [ p.name ] = float ( p.getVal () )
+
+    task = FarmTask ( pdf , start = start , warm = warm , fit_config = fit_config )
+    wmgr = WorkManager ( silent = silent , **kwargs )
+    wmgr.process ( task , chains )
+
+    results = task.results ()
+    return dict ( ( k , results [ k ] ) for k in sorted ( results ) )
+
+# =============================================================================
+## fill the histogram with the results of the fit farm
+#  @code
+#  table = fit_farm ( model , dataset , binning , 'pt' , 'eta' )
+#  hS    = farm_histo ( table , binning , 'S' )
+#  @endcode
+#  @param table   the results of the fit farm
+#  @param binning the binning histogram
+#  @param param   the name of the parameter
+#  @param status  the required fit status (<code>None</code> : accept all)
+#  @return the histogram (clone of the binning histogram)
+def farm_histo ( table , binning , param , status = 0 ) :
+    """Fill the histogram with the results of the fit farm
+    >>> table = fit_farm ( model , dataset , binning , 'pt' , 'eta' )
+    >>> hS    = farm_histo ( table , binning , 'S' )
+    - return the histogram (clone of the binning histogram)
+    """
+    import ostap.histos.histos
+    from   ostap.core.core import hID
+    histo = binning.Clone ( hID () )
+    histo.Reset ()
+    if not histo.GetSumw2N () : histo.Sumw2 ()
+
+    for key , ( st , params ) in table.items () :
+        if status is not None and st != status : continue
+        if not param in params                 : continue
+        v    = params [ param ]
+        ibin = histo.GetBin ( *key )
+        if hasattr ( v , 'error' ) :
+            histo.SetBinContent ( ibin , v.value () )
+            histo.SetBinError   ( ibin , v.error () )
+        else :
+            histo.SetBinContent ( ibin , v )
+
+    return histo
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -21,6 +21,7 @@ Two main class are defined: Task and WorkManager
 __all__ = (
     'Task'        , ## Base class for Task 
     'WorkManager' , ## Task-manager 
+    'close_pools' , ## close all persistent pools 
     )
 # =============================================================================
 import sys, os, time
@@ -37,16 +38,38 @@ else                              : from collections     import Sized
 import multiprocessing     as MP
 
 # =============================================================================
+## persistent ("warm") pools: ncpus -> pool 
+_persistent_pools = {}
+## generations of the shared inputs, inherited by the persistent pools: ncpus -> generation 
+_persistent_generations = {}
+# =============================================================================
+## close all persistent pools
+def close_pools () :
+    """Close all persistent pools
+    """
+    while _persistent_pools :
+        ncpus , pool = _persistent_pools.popitem ()
+        _persistent_generations.pop ( ncpus , None )
+        pool.close ()
+        pool.join  ()
+        
+import atexit
+atexit.register ( close_pools ) 
+
+# =============================================================================
+#  - the persistent pool is not closed 
 class pool_context :
-    def __init__  ( self , pool ) :
-        self.__pool = pool
+    def __init__  ( self , pool , persistent = False ) :
+        self.__pool       = pool
+        self.__persistent = persistent 
     def __enter__ ( self ) :
         sys.stdout .flush ()
         sys.stderr .flush ()
         return self.__pool
     def __exit__  ( self, *_ ) :
-        self.__pool.close ()
-        self.__pool.join  ()
+        if not self.__persistent : 
+            self.__pool.close ()
+            self.__pool.join  ()
         sys.stdout .flush ()
         sys.stderr .flush ()
  
@@ -73,9 +96,39 @@ class WorkManager(TaskManager) :
             logger.warning ( "WorkManager: option ``ppservers'' is ignored" )
         
         ## initialize the base class 
-        TaskManager.__init__  ( self , ncpus = ncpus , silent = silent , progress = progress )        
-        
-        self.pool   = MP.Pool ( self.ncpus )
+        TaskManager.__init__  ( self , ncpus = ncpus , silent = silent , progress = progress , 
+                                memory_budget = kwargs.pop ( 'memory_budget' , None ) )
+
+        ## persistent pool: kept alive between the calls, the workers are warmed up 
+        self.persistent = kwargs.pop ( 'persistent' , False )
+        ## the shared inputs, inherited by the forked workers 
+        from ostap.parallel.shared import forked_workers, inputs_generation 
+        generation = inputs_generation () if forked_workers ( MP ) else None 
+        if self.persistent :
+            if not self.ncpus in _persistent_pools :
+                from ostap.parallel.utils import warm_up 
+                _persistent_generations [ self.ncpus ] = generation 
+                _persistent_pools       [ self.ncpus ] = MP.Pool ( self.ncpus , initializer = warm_up )
+            self.pool       = _persistent_pools       [ self.ncpus ]
+            self.generation = _persistent_generations [ self.ncpus ]
+        else : 
+            self.pool       = MP.Pool ( self.ncpus )
+            self.generation = generation 
+
+    @property
+    def local_workers ( self ) :
+        """``local_workers'' : are all workers local (same host)?
+        - the results can be transferred via shared memory
+        """
+        return True 
+
+    @property
+    def fork_generation ( self ) :
+        """``fork_generation'' : the generation of the registry of shared inputs,
+        inherited by the forked local workers (None: workers are not forked)
+        - see ostap.parallel.shared.share_input 
+        """
+        return self.generation 
 
     # =========================================================================
     ## process the bare <code>executor</code> function
@@ -108,7 +161,7 @@ class WorkManager(TaskManager) :
         - no merging of results  
         """
                 
-        with pool_context ( self.pool ) as pool :
+        with pool_context ( self.pool , self.persistent ) as pool :
 
             ## create and submit jobs 
             jobs = pool.imap_unordered ( job , jobs_args )
@@ -0,0 +1,334 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/parallel/parallel_minos.py
+#  Run MINOS and 2D-contours in parallel
+#  - MINOS errors for several parameters are calculated concurrently,
+#    each process has its own (persistent) copy of the model and NLL
+#  - 2D-contours are calculated as independent points: for each direction
+#    from the minimum the crossing of the profile with the level is found,
+#    the points are distributed among the processes
+#  - the results are merged into <code>RooFitResult</code> and
+#    <code>RooPlot</code> objects, the same as for the serial case
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Run MINOS and 2D-contours in parallel
+- MINOS errors for several parameters are calculated concurrently,
+each process has its own (persistent) copy of the model and NLL
+- 2D-contours are calculated as independent points: for each direction
+from the minimum the crossing of the profile with the level is found,
+the points are distributed among the processes
+- the results are merged into `RooFitResult` and `RooPlot` objects,
+the same as for the serial case
+"""
+# =============================================================================
+__version__ = "$Revision$"
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'parallel_minos'    , ## run MINOS for several parameters in parallel
+    'parallel_contours' , ## make 2D-contours in parallel
+    )
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.parallel.parallel_minos' )
+else                       : logger = getLogger ( __name__     )
+# =============================================================================
+import ROOT, math
+from   ostap.parallel.parallel import Task, WorkManager
+from   ostap.parallel.shared   import SharedAttribute
+# =============================================================================
+## minimizer-related keys of the fit configuration
+_minuit_keys = ( 'silent' , 'strategy' , 'print_level' , 'offset' , 'opt_const' , 'max_calls' , 'max_iterations' )
+# =============================================================================
+## prepare the model at the remote host: the parameters are loaded
+#  and the NLL and minimizer are created
+#  @return ( nll , minimizer )
+def _prepare_ ( pdf , dataset , params , fit_config ) :
+    """Prepare the model at the remote host: the parameters are loaded
+    and the NLL and minimizer are created
+    - return ( nll , minimizer ) 
+    """
+    from ostap.logger.logger import logWarning
+    with logWarning() :
+        import ostap.core.pyrouts
+        import ostap.fitting.roofit
+        import ostap.fitting.dataset
+        import ostap.fitting.variables
+        import ostap.fitting.roofitresult
+
+    pdf.load_params ( params , dataset , silent = True )
+
+    config = dict ( fit_config )
+    mconf  = dict ( ( k , config.pop ( k ) ) for k in _minuit_keys if k in config )
+    mconf.setdefault ( 'silent' , True )
+    for k in ( 'refit' , 'draw' , 'nbins' , 'timer' , 'ncpu' , 'ncpus' , 'minos' ) : config.pop ( k , None )
+
+    nll , _ = pdf.nll    ( dataset , silent = True , **config )
+    mn      = pdf.minuit ( nLL = nll , **mconf )
+    return nll , mn 
+
+# =============================================================================
+## @class MinosTask
+#  Task for parallel MINOS: each item is the list of parameter names
+class MinosTask(Task) :
+    """Task for parallel MINOS: each item is the list of parameter names
+    """
+    ## partial results can be merged at the remote host
+    mergeable = True
+    ## PDF and dataset are large: they are inherited by the forked local workers
+    pdf       = SharedAttribute ( 'pdf'     )
+    dataset   = SharedAttribute ( 'dataset' )
+    ##
+    def __init__ ( self , pdf , dataset , params , fit_config = {} ) :
+        self.pdf        = pdf
+        self.dataset    = dataset
+        self.params     = params
+        self.fit_config = fit_config
+        self.__output   = {}
+
+    def initialize_local ( self ) : self.__output = {}
+
+    ## the actual processing
+    def process ( self , jobid , names ) :
+
+        nll , mn = _prepare_ ( self.pdf , self.dataset , self.params , self.fit_config )
+        mn.migrad ()
+        output   = {}
+        for name in names :
+            status = mn.minos ( name )
+            res    = mn.save  ()
+            par    = res.floatParsFinal().find ( name )
+            if par : output [ name ] = par.getAsymErrorLo () , par.getAsymErrorHi () , status
+        return output
+
+    ## merge results
+    def merge_results ( self , result , jobid = -1 ) :
+        """Merge results of MINOS"""
+        if result : self.__output.update ( result )
+
+    ## get the results
+    def results ( self ) : return self.__output
+
+# =============================================================================
+## @class ContourTask
+#  Task for parallel 2D-contours: each item is the list
+#  of ( level-index , level , angle-index , angle )
+class ContourTask(Task) :
+    """Task for parallel 2D-contours: each item is the list
+    of ( level-index , level , angle-index , angle )
+    """
+    ## partial results can be merged at the remote host
+    mergeable = True
+    ## PDF and dataset are large: they are inherited by the forked local workers
+    pdf       = SharedAttribute ( 'pdf'     )
+    dataset   = SharedAttribute ( 'dataset' )
+    ##
+    def __init__ ( self , pdf , dataset , params , var1 , var2 , ellipse , fit_config = {} , tolerance = 0.01 ) :
+        self.pdf        = pdf
+        self.dataset    = dataset
+        self.params     = params
+        self.var1       = var1
+        self.var2       = var2
+        self.ellipse    = ellipse ## ( x0 , y0 , sx , sy , rho )
+        self.fit_config = fit_config
+        self.tolerance  = tolerance
+        self.__output   = []
+
+    def initialize_local ( self ) : self.__output = []
+
+    ## the actual processing
+    def process ( self , jobid , items ) :
+
+        nll , mn = _prepare_ ( self.pdf , self.dataset , self.params , self.fit_config )
+
+        pars   = self.pdf.params ( self.dataset )
+        v1     = pars [ self.var1 ]
+        v2     = pars [ self.var2 ]
+        others = [ p for p in pars if not p.isConstant () and not p.name in ( v1.name , v2.name ) ]
+
+        x0 , y0 , sx , sy , rho = self.ellipse
+        best   = dict ( ( p.name , p.getVal () ) for p in others )
+        nll0   = nll.getVal ()
+
+        from ostap.fitting.variables import FIXVAR
+
+        ## profile value for fixed ( x , y )
+        def profile ( x , y , start ) :
+            for p in others :
+                if p.name in start : p.setVal ( start [ p.name ] )
+            v1.setVal ( x )
+            v2.setVal ( y )
+            if others : mn.migrad ()
+            return nll.getVal () - nll0 , dict ( ( p.name , p.getVal () ) for p in others )
+
+        output = []
+        start  = best
+        with FIXVAR ( [ v1 , v2 ] ) :
+            for ilevel , level , iangle , angle in sorted ( items , key = lambda i : ( i [ 0 ] , i [ 3 ] ) ) :
+                ## direction in the normalized coordinates
+                dx , dy = math.cos ( angle ) , math.sin ( angle )
+                ## the gaussian estimate of the radius from the covariance ellipse
+                q  = ( dx * dx - 2 * rho * dx * dy + dy * dy ) / ( 1 - rho * rho )
+                r  = math.sqrt ( 2 * level / q )
+                ## iterations: the profile is close to quadratic in r
+                for i in range ( 20 ) :
+                    delta , sol = profile ( x0 + r * dx * sx , y0 + r * dy * sy , start )
+                    if delta <= 0 : r *= 2 ; continue
+                    if abs ( delta - level ) < self.tolerance * level : break
+                    r *= math.sqrt ( level / delta )
+                start = sol
+                output.append ( ( ilevel , iangle , x0 + r * dx * sx , y0 + r * dy * sy ) )
+
+        return output
+
+    ## merge results
+    def merge_results ( self , result , jobid = -1 ) :
+        """Merge results of contours"""
+        if result : self.__output = self.__output + list ( result )
+
+    ## get the results
+    def results ( self ) : return sorted ( self.__output )
+
+# =============================================================================
+## run MINOS for several parameters in parallel and
+#  update the asymmetric errors in the fit result
+#  @code
+#  result , _ = pdf.fitTo ( dataset , ... )
+#  parallel_minos ( pdf , dataset , result , ( 'S' , 'B' , 'mean' ) )
+#  print ( result )
+#  @endcode
+#  @param pdf        the PDF
+#  @param dataset    the dataset
+#  @param result     the fit result to be updated
+#  @param params     the parameters (all floating parameters if empty)
+#  @param fit_config configuration of the minimizer
+#  @return the updated fit result
+def parallel_minos ( pdf , dataset , result , params = () , fit_config = {} , **kwargs ) :
+    """Run MINOS for several parameters in parallel and
+    update the asymmetric errors in the fit result
+    >>> result , _ = pdf.fitTo ( dataset , ... )
+    >>> parallel_minos ( pdf , dataset , result , ( 'S' , 'B' , 'mean' ) )
+    >>> print ( result )
+    """
+    if not isinstance ( dataset , ROOT.RooAbsData ) and hasattr ( dataset , 'dset' ) :
+        dataset = dataset.dset
+
+    floating = result.floatParsFinal ()
+    names    = [ p if isinstance ( p , str ) else p.name for p in params ] if params else [ p.name for p in floating ]
+    for n in names : assert floating.find ( n ) , "parallel_minos: %s is not a floating parameter" % n
+
+    task = MinosTask ( pdf , dataset , result.dct_params () , fit_config = fit_config )
+    wmgr = WorkManager ( silent = True , **kwargs )
+    wmgr.process ( task , [ [ n ] for n in names ] )
+
+    for name , ( lo , hi , status ) in task.results ().items () :
+        if 0 != status : logger.warning ( "parallel_minos: MINOS status %s for `%s'" % ( status , name ) )
+        par = floating.find ( name )
+        par.setAsymError ( lo , hi )
+
+    return result
+
+# =============================================================================
+## make 2D-contours in parallel
+#  The points of the contour are calculated independently:
+#  for each direction from the minimum (in units of the parabolic errors)
+#  the crossing of the 2D-profile with the level
+#  \f$ \Delta = \frac{1}{2} n^2 \f$ is found
+#  @code
+#  result , _ = pdf.fitTo ( dataset , ... )
+#  frame = parallel_contours ( pdf , 'S' , 'B' , dataset , result , levels = ( 1 , 2 ) , npoints = 50 )
+#  frame.draw()
+#  @endcode
+#  @param pdf        the PDF
+#  @param var1       the first  variable
+#  @param var2       the second variable
+#  @param dataset    the dataset
+#  @param result     the fit result (parameters at the minimum and covariance)
+#  @param levels     the levels in units of sigma
+#  @param npoints    number of points
+#  @param fit_config configuration of the minimizer
+#  @return RooPlot with the contours, like <code>RooMinimizer::contour</code>
+def parallel_contours ( pdf                ,
+                        var1               ,
+                        var2               ,
+                        dataset            ,
+                        result             ,
+                        levels     = ( 1 , ) ,
+                        npoints    = 50    ,
+                        fit_config = {}    ,
+                        nsplit     = 8     , **kwargs ) :
+    """Make 2D-contours in parallel.
+    The points of the contour are calculated independently:
+    for each direction from the minimum (in units of the parabolic errors)
+    the crossing of the 2D-profile with the level Delta=n^2/2 is found
+    >>> result , _ = pdf.fitTo ( dataset , ... )
+    >>> frame = parallel_contours ( pdf , 'S' , 'B' , dataset , result , levels = ( 1 , 2 ) , npoints = 50 )
+    >>> frame.draw()
+    - return RooPlot with the contours, like `RooMinimizer::contour`
+    """
+    if not isinstance ( dataset , ROOT.RooAbsData ) and hasattr ( dataset , 'dset' ) :
+        dataset = dataset.dset
+
+    pars = pdf.params ( dataset )
+    if not isinstance ( var1 , ROOT.RooAbsReal ) : var1 = pars [ var1 ]
+    if not isinstance ( var2 , ROOT.RooAbsReal ) : var2 = pars [ var2 ]
+
+    floating = result.floatParsFinal ()
+    p1  = floating.find ( var1.name )
+    p2  = floating.find ( var2.name )
+    assert p1 and p2 , 'parallel_contours: parameters must be floating!'
+
+    ellipse = ( p1.getVal () , p2.getVal () ,
+                p1.getError () , p2.getError () ,
+                result.corr ( var1.name , var2.name ) )
+
+    items   = []
+    for il , l in enumerate ( levels ) :
+        for ia in range ( npoints ) :
+            items.append ( ( il , 0.5 * l * l , ia , 2 * math.pi * ia / npoints ) )
+
+    ## contiguous chunks: warm starts for the neighbour points
+    nsplit = max ( 1 , min ( nsplit , len ( items ) ) )
+    n , r  = divmod ( len ( items ) , nsplit )
+    chunks , first = [] , 0
+    for i in range ( nsplit ) :
+        last = first + n + ( 1 if i < r else 0 )
+        chunks.append ( items [ first : last ] )
+        first = last
+
+    task = ContourTask ( pdf , dataset , result.dct_params () ,
+                         var1.name , var2.name , ellipse , fit_config = fit_config )
+    wmgr = WorkManager ( silent = True , **kwargs )
+    wmgr.process ( task , chunks )
+    points = task.results ()
+
+    ## the same structure as RooMinimizer::contour
+    frame = ROOT.RooPlot ( var1 , var2 , var1.getMin () , var1.getMax () , var2.getMin () , var2.getMax () )
+    point = ROOT.TMarker ( ellipse [ 0 ] , ellipse [ 1 ] , 8 )
+    frame.addObject ( point )
+
+    import ostap.histos.graphs
+    for il , l in enumerate ( levels ) :
+        pts   = [ p for p in points if p [ 0 ] == il ]
+        graph = ROOT.TGraph ( len ( pts ) + 1 )
+        for i , p in enumerate ( pts ) : graph.SetPoint ( i , p [ 2 ] , p [ 3 ] )
+        if pts : graph.SetPoint ( len ( pts ) , pts [ 0 ] [ 2 ] , pts [ 0 ] [ 3 ] ) ## close it
+        graph.SetLineStyle ( il + 1 )
+        graph.SetName ( 'contour_%s_n%s' % ( result.GetName () , l ) )
+        frame.addObject ( graph , "L" )
+
+    return frame
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -35,6 +35,7 @@ __author__  = 'Vanya BELYAEV Ivan.Belyaev@itep.ru'
 __date__    = '2016-02-23'
 __all__     = (
     'WorkManager' , ## task manager
+    'close_pools' , ## close all persistent pools 
     )
 # =============================================================================
 from ostap.logger.logger        import getLogger
@@ -51,7 +52,7 @@ from   ostap.parallel.task      import ( TaskManager   ,
                                          Statistics    , StatMerger    ,
                                          task_executor , func_executor )
 # =============================================================================
-from   ostap.parallel.utils     import get_local_port  , pool_context  
+from   ostap.parallel.utils     import get_local_port  , pool_context  , warm_up 
 # =============================================================================
 if ( 3 , 3 ) <= sys.version_info  : from collections.abc import Sized
 else                              : from collections     import Sized 
@@ -70,6 +71,29 @@ def get_pps ( pool ) :
     import pathos.parallel
     return pathos.parallel.__STATE.get ( pool._id , None )
 
+# =============================================================================
+## persistent ("warm") pools: configuration -> ( pool , ppservers , locals )
+_persistent_pools = {}
+# =============================================================================
+## close all persistent pools
+#  @code
+#  close_pools ()
+#  @endcode 
+def close_pools () :
+    """Close all persistent pools
+    >>> close_pools ()
+    """
+    while _persistent_pools :
+        key , item = _persistent_pools.popitem ()
+        pool , ppservers , locals , secret , generation = item 
+        pool.close ()
+        pool.join  ()
+        pool.clear ()
+        for p in ppservers : p.end ()
+        
+import atexit
+atexit.register ( close_pools ) 
+
 # =============================================================================
 ## @class WorkManager
 #  Class to in charge of managing the tasks and distributing them to
@@ -80,6 +104,25 @@ def get_pps ( pool ) :
 #  wm2 = WorkManager ( ppservers = ... ) ## use local and remote servers
 #  wm3 = WorkManager ( ncpus = 0 , ppservers = ... ) ## use only remote servers
 #  @endcode 
+#  The persistent ("warm") pool is kept alive between the calls and it is
+#  shared between the managers with the same configuration:
+#  ROOT, RooFit and Ostap are loaded only once per worker 
+#  @code
+#  wm4 = WorkManager ( persistent = True )
+#  @endcode 
+#  The memory budget per node (in MB) for the C++ multithreaded engines
+#  is shared equally between the workers
+#  @code
+#  wm6 = WorkManager ( memory_budget = 16000 )
+#  @endcode 
+#  For the remote servers the jobs can be placed at the hosts
+#  with the local replicas of the input files
+#  @code
+#  wm5 = WorkManager ( ppservers = ... )
+#  wm5.process ( task , chains , affinity = { '/eos/lhcb/data1/' : 'node1' } )
+#  @endcode 
+#  @see close_pools
+#  @see ostap.parallel.task.AffinityScheduler 
 #  @author Pere MATO Pere.Meto@cern.ch
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
 class WorkManager (TaskManager) :
@@ -89,6 +132,19 @@ class WorkManager (TaskManager) :
     >>> wm1 = WorkManager ()                  ## use local
     >>> wm2 = WorkManager ( ppservers = ... ) ## use local and remote servers
     >>> wm3 = WorkManager ( ncpus = 0 , ppservers = ... ) ## use only remote servers
+    The persistent (``warm'') pool is kept alive between the calls and it is
+    shared between the managers with the same configuration:
+    ROOT, RooFit and Ostap are loaded only once per worker 
+    >>> wm4 = WorkManager ( persistent = True )
+    - see close_pools 
+    The memory budget per node (in MB) for the C++ multithreaded engines
+    is shared equally between the workers
+    >>> wm6 = WorkManager ( memory_budget = 16000 )
+    For the remote servers the jobs can be placed at the hosts
+    with the local replicas of the input files
+    >>> wm5 = WorkManager ( ppservers = ... )
+    >>> wm5.process ( task , chains , affinity = { '/eos/lhcb/data1/' : 'node1' } )
+    - see ostap.parallel.task.AffinityScheduler 
     """
     def __init__( self                     ,
                   ncpus     = 'autodetect' ,
@@ -100,16 +156,22 @@ class WorkManager (TaskManager) :
             from pathos.helpers import cpu_count
             ncpus = cpu_count ()
             
-        ## initialize the base class 
-        TaskManager.__init__ ( self, ncpus =  ncpus , silent = silent , progress = progress )
-        
         from ostap.utils.cidict import cidict
         kwa = cidict ( **kwargs ) 
 
+        ## initialize the base class 
+        TaskManager.__init__ ( self, ncpus =  ncpus , silent = silent , progress = progress , 
+                               memory_budget = kwa.pop ( 'memory_budget' , None ) )
+
             
-        self.__ppservers = ()
-        self.__locals    = ()
-        self.__pool      = ()
+        self.__ppservers  = ()
+        self.__locals     = ()
+        self.__pool       = ()
+        self.__persistent = kwa.pop ( 'persistent' , False ) 
+        self.__secret     = None
+        self.__host_pools = {}
+        self.__slots      = kwa.pop ( 'remote_slots' , None ) 
+        self.__generation = None 
         
         import socket
         local_host = socket.getfqdn ().lower()  
@@ -120,8 +182,17 @@ class WorkManager (TaskManager) :
             from ostap.parallel.utils import get_ppservers
             ppservers = get_ppservers ( local_host )
 
+        use_pp = ppservers or kwa.pop ( 'PP' , False ) or kwa.pop ( 'Parallel' , False ) 
+
+        ## the persistent pool with the same configuration is already here? 
+        key = ( self.ncpus , tuple ( ppservers ) if use_pp else None ,
+                kwa.get ( 'environment' , '' ) , kwa.get ( 'script'  , None ) , kwa.get ( 'profile' , None ) )
+        if self.__persistent and key in _persistent_pools :
+            
+            self.__pool , self.__ppservers , self.__locals , self.__secret , self.__generation = _persistent_pools [ key ]
+            
         ## use Paralell python if ppservers are specified or explicit flag
-        if ppservers or kwa.pop ( 'PP' , False ) or kwa.pop ( 'Parallel' , False ) :
+        elif use_pp : 
 
             ## remove duplicates (if any) - do not sort! 
             pps = []
@@ -160,6 +231,7 @@ class WorkManager (TaskManager) :
             if secret is None :
                 from ostap.utils.utils import gen_password 
                 secret = gen_password ( 16 )
+            self.__secret = secret 
 
             from ostap.parallel.pptunnel import ppServer, show_tunnels  
             ppsrvs = [ ppServer ( remote                    ,
@@ -206,8 +278,19 @@ class WorkManager (TaskManager) :
             
             ## from pathos.multiprocessing import ProcessPool 
             from pathos.pools import ProcessPool 
+            ## the shared inputs, inherited by the (persistent) forked workers 
+            import multiprocess
+            from ostap.parallel.shared import forked_workers, inputs_generation 
+            if forked_workers ( multiprocess ) : self.__generation = inputs_generation () 
             self.__pool      = ProcessPool ( self.ncpus )
 
+        if self.__persistent and not key in _persistent_pools :
+            _persistent_pools [ key ] = self.__pool , self.__ppservers , self.__locals , self.__secret , self.__generation 
+            ## warm up the workers: load ROOT&Ostap 
+            nw = max ( 1 , self.ncpus ) * ( 1 + len ( self.locals ) )
+            ws = set ( self.pool.uimap ( warm_up , range ( nw ) ) )
+            if not self.silent : logger.info ( 'WorkManager: %d workers are warmed up' % len ( ws ) )
+            
         ps = '%s' % self.pool
         ps = ps.replace( '<pool ' , '' ).replace  ('>','').replace ('servers','remotes')
         for p in self.ppservers : ps = ps.replace ( p.local , p.remote )
@@ -235,16 +318,47 @@ class WorkManager (TaskManager) :
         """``remotes'' : list of (remote) tunnel ports"""
         return tuple (  ( p.remote for p in self.ppservers ) ) 
 
+    @property
+    def persistent ( self ) :
+        """``persistent'' : is the pool persistent, kept alive between the calls?"""
+        return self.__persistent 
+    
+    @property
+    def local_workers ( self ) :
+        """``local_workers'' : are all workers local (same host)?
+        - the results can be transferred via shared memory
+        """
+        return not self.locals 
+
+    @property
+    def fork_generation ( self ) :
+        """``fork_generation'' : the generation of the registry of shared inputs,
+        inherited by the forked local workers (None: workers are not forked)
+        - the non-persistent pool is restarted (forked) for each execution
+        - see ostap.parallel.shared.share_input 
+        """
+        if self.__generation is None or self.persistent : return self.__generation
+        from ostap.parallel.shared import inputs_generation 
+        return inputs_generation ()
+
     ## context protocol: restart the pool 
     def __enter__  ( self      ) :
         sys.stdout .flush ()
         sys.stderr .flush ()
-        if self.pool : self.pool.restart ( True )                           
+        if self.pool and not self.persistent : self.pool.restart ( True )                           
         return self
     
     ## context protocol: close/join/clear the pool 
+    #  - the persistent pool is kept alive
+    #  @see close_pools 
     def __exit__   ( self , *_ ) :        
-        if  self.pool :
+        while self.__host_pools :
+            host , item = self.__host_pools.popitem ()
+            pool , slots = item 
+            pool.close ()
+            pool.join  ()
+            pool.clear ()
+        if  self.pool and not self.persistent :
             self.pool.close()
             self.pool.join  ()
             self.pool.clear ()
@@ -289,7 +403,7 @@ class WorkManager (TaskManager) :
         - no merging of results  
         """
         
-        with pool_context ( self.pool ) as pool :
+        with pool_context ( self.pool , self.persistent ) as pool :
 
             ## create and submit jobs 
             jobs = pool.uimap ( job , jobs_args )
@@ -305,6 +419,72 @@ class WorkManager (TaskManager) :
                 yield result
             
 
+    # =========================================================================
+    ## get the list of hosts with their numbers of slots, <code>[ ( host , slots ) ]</code>,
+    #  for the host-specific (data-local) placement of the jobs
+    #  - it is available only for the remote servers
+    #  @see ostap.parallel.task.AffinityScheduler 
+    def host_slots ( self ) :
+        """Get the list of hosts with their numbers of slots, `[ ( host , slots ) ]`,
+        for the host-specific (data-local) placement of the jobs
+        - it is available only for the remote servers 
+        - see ostap.parallel.task.AffinityScheduler 
+        """
+        if not self.ppservers : return ()
+        import socket
+        result = []
+        if 0 < self.ncpus : result.append ( ( socket.getfqdn ().lower () , self.ncpus ) ) 
+        for p in self.ppservers :
+            pool , slots = self.__host_pool ( p.remote_host ) 
+            result.append ( ( p.remote_host , slots ) )
+        return tuple ( result ) 
+
+    # =========================================================================
+    ## execute the job at the given host (blocking call)
+    def host_execute ( self , host , job , job_args ) :
+        """Execute the job at the given host (blocking call)"""
+        pool , slots = self.__host_pool ( host )
+        return pool.pipe ( job , job_args ) 
+
+    # =========================================================================
+    ## get (create if needed) the pool for the given host: ( pool , slots ) 
+    def __host_pool ( self , host ) :
+        """Get (create if needed) the pool for the given host: ( pool , slots )"""
+        from ostap.parallel.task import same_host 
+        for h in self.__host_pools :
+            if same_host ( h , host ) : return self.__host_pools [ h ]
+
+        server = None 
+        for p in self.ppservers :
+            if same_host ( p.remote_host , host ) :
+                server = p
+                break
+
+        pool_id = 'ostap-host-%s' % host 
+        if server is None : ## local host 
+            from pathos.pools import ProcessPool 
+            pool  = ProcessPool ( self.ncpus , id = pool_id )
+            slots = self.ncpus 
+        else :
+            ## the trick to setup the password, see the constructor 
+            import pathos.parallel as PP
+            _ds = PP.pp.Server.default_secret
+            if self.__secret : PP.pp.Server.default_secret = self.__secret
+            try : 
+                from pathos.pools import ParallelPool 
+                pool = ParallelPool ( ncpus = 0 , servers = ( server.local , ) , id = pool_id )
+            finally :
+                PP.pp.Server.default_secret = _ds
+            slots = self.__slots
+            if not slots : ## ask the remote server
+                pps   = get_pps ( pool ) 
+                nodes = pps.get_active_nodes () if pps else {}
+                slots = sum ( n for k , n in nodes.items () if k != 'local' ) 
+            slots = max ( 1 , slots if slots else self.ncpus ) 
+            
+        self.__host_pools [ host ] = pool , slots 
+        return pool , slots
+
     # =========================================================================
     ## get the statistics from the paralell python
     def get_pp_stat ( self ) :
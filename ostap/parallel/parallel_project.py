@@ -39,6 +39,8 @@ class ProjectTask(Task) :
     """The simple task  object for the efficient parallel
     projection of looooooong TChains/TTrees into histograms  
     """
+    ## partial results can be merged at the remote host 
+    mergeable = True 
     ## constructor: histogram 
     def __init__ ( self , histo , what , cuts = '' ) :
         """Constructor: the histogram 
@@ -161,7 +163,8 @@ def  cproject ( chain                ,
                 first      =  0      ,
                 chunk_size = -1      ,
                 max_files  =  5      , 
-                silent     = False   , **kwargs ) :
+                silent     = False   ,
+                dynamic    = True    , **kwargs ) :
     """Make a projection of the loooong chain into histogram
     >>> chain = ... ## large chain
     >>> histo = ... ## histogram template 
@@ -176,7 +179,8 @@ def  cproject ( chain                ,
     
     task  = ProjectTask ( histo , what , cuts )
     wmgr  = WorkManager ( silent = silent , **kwargs )    
-    wmgr.process ( task , ch.split ( chunk_size = chunk_size , max_files = max_files ) )
+    wmgr.process ( task , ch.split ( chunk_size = chunk_size , max_files = max_files ) ,
+                   dynamic = dynamic and 0 < chunk_size )
 
     ## unpack results 
     _f , _h    = task.results ()
@@ -218,7 +222,8 @@ def  tproject ( tree                 ,   ## the tree
                 first      =  0      ,   ## the first entry 
                 chunk_size = 1000000 ,   ## chunk size 
                 max_files  = 50      ,   ## not-used .... 
-                silent     = False   , **kwargs ) : ## silent processing 
+                silent     = False   ,   ## silent processing 
+                dynamic    = True    , **kwargs ) : ## dynamic scheduling 
     """Make a projection of the loooong tree into histogram
     >>> tree  = ... ## large chain
     >>> histo = ... ## histogram template 
@@ -241,7 +246,8 @@ def  tproject ( tree                 ,   ## the tree
     
     task  = ProjectTask            ( histo , what , cuts )
     wmgr  = WorkManager            ( silent     = silent , **kwargs )
-    wmgr.process ( task, ch.split  ( chunk_size = chunk_size ) )
+    wmgr.process ( task, ch.split  ( chunk_size = chunk_size ) ,
+                   dynamic = dynamic and 0 < chunk_size )
     
     ## unpack results 
     _f , _h = task.results ()
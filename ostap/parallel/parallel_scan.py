@@ -0,0 +1,149 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/parallel/parallel_scan.py
+#  Run profile-likelihood scans in parallel
+#  - the scan points are split into contiguous segments
+#  - each segment is scanned with warm starts, walking away from the minimum
+#  @see ostap.fitting.scan
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Run profile-likelihood scans in parallel
+- the scan points are split into contiguous segments
+- each segment is scanned with warm starts, walking away from the minimum
+- see ostap.fitting.scan
+"""
+# =============================================================================
+__version__ = "$Revision$"
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'parallel_scan' , ## run profile-likelihood scan in parallel
+    )
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.parallel.parallel_scan' )
+else                       : logger = getLogger ( __name__     )
+# =============================================================================
+import ROOT
+from   ostap.parallel.parallel import Task, WorkManager
+from   ostap.parallel.shared   import SharedAttribute
+# =============================================================================
+## @class ScanTask
+#  The simple task object for parallel profile-likelihood scans
+#  @see ostap.fitting.scan.ProfileScan
+class ScanTask(Task) :
+    """The simple task object for parallel profile-likelihood scans
+    - see ostap.fitting.scan.ProfileScan
+    """
+    ## partial results can be merged at the remote host
+    mergeable = True
+    ## PDF and dataset are large: they are inherited by the forked local workers
+    pdf       = SharedAttribute ( 'pdf'     )
+    dataset   = SharedAttribute ( 'dataset' )
+    ##
+    def __init__ ( self              ,
+                   pdf               ,
+                   variable          ,
+                   dataset           ,
+                   origin            , ## the position of the minimum
+                   start      = {}   , ## the parameters at the minimum
+                   fit_config = {}   ) :
+
+        self.pdf        = pdf
+        self.variable   = variable
+        self.dataset    = dataset
+        self.origin     = origin
+        self.start      = start
+        self.fit_config = fit_config
+
+        self.__output   = []
+
+    def initialize_local  ( self ) : self.__output = []
+
+    ## the actual processing: scan the segment
+    def process ( self , jobid , values ) :
+
+        from ostap.logger.logger import logWarning
+        with logWarning() :
+            import ostap.core.pyrouts
+            import ostap.fitting.roofit
+            import ostap.fitting.dataset
+            import ostap.fitting.variables
+
+        from ostap.fitting.scan     import ProfileScan
+        from ostap.fitting.funbasic import SETPARS 
+        ## the inherited PDF is reused by the next job in this worker: keep its parameters
+        with SETPARS ( self.pdf , self.dataset ) : 
+            engine = ProfileScan ( self.pdf , self.variable , self.dataset , fit_config = self.fit_config )
+            ## start from the segment end closest to the minimum
+            origin = min ( max ( self.origin , values [ 0 ] ) , values [ -1 ] )
+            return engine.scan ( values , origin = origin , start = self.start )
+
+    ## merge results
+    def merge_results ( self , result , jobid = -1 ) :
+        """Merge results of the scan"""
+        if result : self.__output = self.__output + list ( result )
+
+    ## get the results
+    def results ( self ) :
+        return sorted ( self.__output , key = lambda p : p [ 0 ] )
+
+# =============================================================================
+## run profile-likelihood scan in parallel
+#  @code
+#  points = parallel_scan ( pdf , 'S' , values , dataset , origin = x0 , nsplit = 8 )
+#  @endcode
+#  @return sorted list of ( value , nll , parameters )
+#  @see ostap.fitting.scan.profile_scan
+def parallel_scan ( pdf               ,
+                    variable          ,
+                    values            ,
+                    dataset           ,
+                    origin            ,
+                    start      = {}   ,
+                    nsplit     = 4    ,
+                    fit_config = {}   ,
+                    silent     = True , **kwargs ) :
+    """Run profile-likelihood scan in parallel
+    >>> points = parallel_scan ( pdf , 'S' , values , dataset , origin = x0 , nsplit = 8 )
+    - return sorted list of ( value , nll , parameters )
+    - see ostap.fitting.scan.profile_scan
+    """
+
+    values = sorted ( values )
+    nsplit = max ( 1 , min ( nsplit , len ( values ) ) )
+
+    ## contiguous segments: warm starts are efficient inside the segment
+    n , r    = divmod ( len ( values ) , nsplit )
+    segments = []
+    first    = 0
+    for i in range ( nsplit ) :
+        last = first + n + ( 1 if i < r else 0 )
+        segments.append ( values [ first : last ] )
+        first = last
+
+    task = ScanTask ( pdf        = pdf        ,
+                      variable   = variable   ,
+                      dataset    = dataset    ,
+                      origin     = origin     ,
+                      start      = start      ,
+                      fit_config = fit_config )
+
+    wmgr = WorkManager ( silent = silent , **kwargs )
+    wmgr.process ( task , segments )
+
+    return task.results ()
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
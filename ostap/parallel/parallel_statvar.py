@@ -14,6 +14,7 @@ __author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
 __date__    = "2011-06-07"
 __all__     = (
     'pStatVar'   , ## get the statistics from loooong TChain in paralell
+    'pDigest'    , ## get the mergeable quantile sketch from loooong TChain in parallel
     ) 
 # =============================================================================
 # logging 
@@ -35,6 +36,8 @@ n_large = ROOT.TVirtualTreePlayer.kMaxEntries
 class StatVarTask(Task) :
     """The simple task object collect statistics for loooooong chains 
     """
+    ## partial results can be merged at the remote host 
+    mergeable = True 
     ## constructor: histogram 
     def __init__ ( self , what , cuts = '' ) :
         """Constructor        
@@ -105,12 +108,73 @@ class StatVarTask(Task) :
     def results ( self ) : return self.__output 
 
 
+# =============================================================================
+## The simple task object to get the mergeable quantile sketch (t-digest)
+#  for loooooong chains
+#  @see Ostap::Math::TDigest
+#  @see Ostap::StatVar::digest
+class DigestTask(Task) :
+    """The simple task object to get the mergeable quantile sketch (t-digest)
+    for loooooong chains 
+    - see Ostap.Math.TDigest
+    - see Ostap.StatVar.digest
+    """
+    ## partial results can be merged at the remote host 
+    mergeable = True 
+    ## constructor: expression, cuts and compression 
+    def __init__ ( self , what , cuts = '' , compression = 100 ) :
+        """Constructor        
+        >>> task  = DigestTask ( 'mass' , 'pt>0') 
+        """
+        self.what        = str ( what ) 
+        self.cuts        = str ( cuts ) 
+        self.compression = compression 
+        self.__output    = None
+        
+    ## local initialization (executed once in parent process)
+    def initialize_local   ( self ) :
+        """Local initialization (executed once in parent process)
+        """
+        self.__output = None
+            
+    ## the actual processing
+    def process ( self , jobid , item ) :
+        """The actual processing
+        """
+        import ROOT
+        from ostap.logger.utils import logWarning
+        with logWarning() :
+            import ostap.core.pyrouts 
+            import ostap.trees.trees 
+            import ostap.stats.counters 
+
+        chain   = item.chain 
+        first   = item.first
+        last    = min ( n_large , first + item.nevents if 0 < item.nevents else n_large )
+
+        from ostap.core.core import Ostap
+        digest  = Ostap.Math.TDigest ( self.compression )
+        Ostap.StatVar.digest ( chain , digest , self.what , self.cuts , first , last )
+
+        self.__output = digest 
+        return self.__output 
+        
+    ## merge results 
+    def merge_results ( self , result , jobid = -1 ) :
+        if self.__output is None : self.__output  = result
+        else                     : self.__output += result
+
+    ## get the results 
+    def results ( self ) : return self.__output 
+
 # ===================================================================================
 ## parallel processing of loooong chain/tree 
 #  @code
 #  chain          = ...
 #  chain.pStatVar ( .... ) 
 #  @endcode 
+#  @param dynamic use the dynamic scheduling with adaptive splitting
+#  @see ostap.parallel.task.WaveScheduler
 def pStatVar ( chain               ,
                what                ,
                cuts       = ''     ,
@@ -118,10 +182,12 @@ def pStatVar ( chain               ,
                first      =  0     ,
                chunk_size = 250000 ,
                max_files  =  1     ,
-               silent     = True   , **kwargs ) :
+               silent     = True   ,
+               dynamic    = True   , **kwargs ) :
     """ Parallel processing of loooong chain/tree 
     >>> chain    = ...
     >>> chain.pstatVar( 'mass' , 'pt>1') 
+    - dynamic : use the dynamic scheduling with adaptive splitting (see WaveScheduler)
     """
     ## few special/trivial cases
 
@@ -149,7 +215,7 @@ def pStatVar ( chain               ,
     trees  = ch.split ( chunk_size = chunk_size , max_files = max_files )
 
     print ( 'statvar-pprocess', chain.GetName() , len(trees) ) 
-    wmgr.process ( task , trees )
+    wmgr.process ( task , trees , dynamic = dynamic and 0 < chunk_size )
 
     del trees
     del ch    
@@ -163,6 +229,65 @@ ROOT.TTree .pstatVar  = pStatVar
 ROOT.TChain.pstatVars = pStatVar 
 ROOT.TTree .pstatVars = pStatVar
 
+# ===================================================================================
+## get the mergeable quantile sketch (t-digest) for loooong chain/tree in parallel
+#  @code
+#  chain  = ...
+#  digest = chain.pdigest ( 'pt' , 'eta>2' ) 
+#  median = digest.quantile ( 0.5 )
+#  q1, q2 = digest.quantile ( 0.16 ) , digest.quantile ( 0.84 ) 
+#  @endcode 
+#  @see Ostap::Math::TDigest
+#  @see Ostap::StatVar::digest
+def pDigest ( chain                ,
+              what                 ,
+              cuts        = ''     ,
+              nevents     = -1     ,
+              first       =  0     ,
+              chunk_size  = 250000 ,
+              max_files   =  1     ,
+              silent      = True   ,
+              compression = 100    , 
+              dynamic     = True   , **kwargs ) :
+    """ Get the mergeable quantile sketch (t-digest) for loooong chain/tree in parallel
+    >>> chain  = ...
+    >>> digest = chain.pdigest ( 'pt' , 'eta>2' ) 
+    >>> median = digest.quantile ( 0.5 )
+    >>> q1, q2 = digest.quantile ( 0.16 ) , digest.quantile ( 0.84 ) 
+    - see Ostap.Math.TDigest
+    - see Ostap.StatVar.digest
+    """
+    import ostap.stats.counters 
+    from   ostap.core.core import Ostap
+
+    last = min ( n_large , first + nevents if 0 < nevents else n_large )
+
+    ## few special/trivial cases 
+    if ( 0 <= first and 0 < nevents < chunk_size ) or \
+       ( isinstance ( chain , ROOT.TChain ) and 1 == chain.nFiles() and len ( chain ) < chunk_size ) or \
+       ( not isinstance ( chain , ROOT.TChain ) and len ( chain ) < chunk_size ) :
+        digest = Ostap.Math.TDigest ( compression )
+        Ostap.StatVar.digest ( chain , digest , str ( what ) , str ( cuts ) , first , last )
+        return digest 
+    
+    from ostap.trees.trees import Chain
+    ch     = Chain ( chain , first = first , nevents = nevents )
+
+    task   = DigestTask  ( what , cuts , compression )
+    wmgr   = WorkManager ( silent = silent , **kwargs )
+
+    trees  = ch.split ( chunk_size = chunk_size , max_files = max_files )
+
+    wmgr.process ( task , trees , dynamic = dynamic and 0 < chunk_size )
+
+    del trees
+    del ch    
+
+    return task.results()
+
+ROOT.TChain.pdigest   = pDigest 
+ROOT.TTree .pdigest   = pDigest
+
 # =============================================================================
 _decorated_classes_ = (
     ROOT.TTree  ,
@@ -174,6 +299,8 @@ _new_methods_       = (
     ROOT.TChain.pstatVar  ,
     ROOT.TTree .pstatVars ,
     ROOT.TChain.pstatVars ,
+    ROOT.TTree .pdigest   ,
+    ROOT.TChain.pdigest   ,
     )
 
 # =============================================================================
@@ -27,6 +27,7 @@ else                       : logger = getLogger ( __name__              )
 # =============================================================================
 import ROOT
 from   ostap.parallel.parallel import Task, WorkManager
+from   ostap.parallel.shared   import SharedAttribute 
 from   ostap.core.ostap_types  import string_types, integer_types  
 # =============================================================================
 ## merge results of toys 
@@ -53,6 +54,11 @@ def merge_toys ( previous , result , jobid = -1 ) :
     for p in results_ : rset.add ( p )                
     for p in rset     : results_ [ p ] += results [ p ]
     
+    from ostap.fitting.toys import ToyStats
+    if isinstance ( stat_ , ToyStats ) and isinstance ( stat , ToyStats ) :
+        stat_ += stat
+        return results_ , stat_ 
+        
     sset = set ()
     for p in stat     : sset.add ( p )
     for p in stat_    : sset.add ( p )
@@ -72,7 +78,10 @@ class  ToysTask(Task) :
     """The simple task object for parallel fitting toys
     - single PDF to generate and fit
     - see ostap.fitting.toys.make_toys
+    - the PDF is inherited by the forked local workers, see ostap.parallel.shared
     """
+    ## PDF is large: it is inherited by the forked local workers 
+    pdf = SharedAttribute ( 'pdf' )
     ## 
     def __init__ ( self               ,
                    pdf                ,
@@ -85,7 +94,9 @@ class  ToysTask(Task) :
                    fit_fun    = None  , 
                    accept_fun = None  , 
                    silent     = True  ,
-                   progress   = False ) :
+                   progress   = False ,
+                   fast       = False ,
+                   seed       = None  ) :
         
         self.pdf        = pdf
                 
@@ -101,6 +112,8 @@ class  ToysTask(Task) :
         
         self.silent     = silent
         self.progress   = progress 
+        self.fast       = fast 
+        self.seed       = seed 
         
         self.__the_output   = () 
 
@@ -118,9 +131,18 @@ class  ToysTask(Task) :
         """Initialize the remote task, treta the random numbers  
         """
 
-        import random, ROOT
-        from ostap.parallel.utils import random_random
-        random_random ( jobid )
+        if self.seed is None : 
+            from ostap.parallel.utils import random_random
+            random_random ( jobid )
+        else :
+            ## deterministic substream for this job 
+            from ostap.parallel.utils import random_substream 
+            random_substream ( jobid , self.seed )
+
+        ## silent toys: mute the worker once, instead of muting each fit 
+        if self.silent :
+            from ostap.logger.mute import mute_process, process_muted 
+            if not process_muted () : mute_process () 
         
         return self.initialize_local() 
     
@@ -145,7 +167,29 @@ class  ToysTask(Task) :
         assert isinstance ( nToys , integer_types ) and 0 < nToys,\
                'Jobid %s: Invalid "nToys" argument %s/%s' % ( jobid , nToys , type ( nToys ) )
         
+        from   ostap.fitting.funbasic import SETPARS 
+        ## the inherited PDF is reused by the next job in this worker: keep its parameters
+        with SETPARS ( self.pdf ) :
+            return self.__process ( jobid , nToys ) 
+
+    ## the actual processing 
+    def __process ( self , jobid , nToys ) :
+        
         import ostap.fitting.toys as Toys 
+        if self.fast :
+            results , stats = Toys.make_toys_fast ( pdf        = self.pdf        ,
+                                                    nToys      = nToys           ,
+                                                    data       = self.data       ,
+                                                    gen_config = self.gen_config , 
+                                                    fit_config = self.fit_config , 
+                                                    init_pars  = self.init_pars  ,
+                                                    more_vars  = self.more_vars  ,
+                                                    accept_fun = self.accept_fun ,
+                                                    silent     = self.silent     ,
+                                                    progress   = self.progress   )
+            self.the_output = results , stats
+            return self.results() 
+        
         results , stats = Toys.make_toys ( pdf        = self.pdf        ,
                                            nToys      = nToys           ,
                                            data       = self.data       ,
@@ -182,7 +226,11 @@ class  ToysTask2(ToysTask) :
     """The simple task object for parallel fitting toys
     - separate PDFs to generarte and fit 
     - see ostap.fitting.toys.make_toys2 
+    - the PDFs are inherited by the forked local workers, see ostap.parallel.shared
     """
+    ## PDFs are large: they are inherited by the forked local workers 
+    gen_pdf = SharedAttribute ( 'gen_pdf' )
+    fit_pdf = SharedAttribute ( 'fit_pdf' )
     ## 
     def __init__ ( self               ,
                    gen_pdf            ,
@@ -197,7 +245,8 @@ class  ToysTask2(ToysTask) :
                    fit_fun    = None  , 
                    accept_fun = None  , 
                    silent     = True  ,
-                   progress   = False ) :
+                   progress   = False ,
+                   seed       = None  ) :
 
         ToysTask.__init__ ( self                    ,
                             pdf        = gen_pdf    ,
@@ -210,7 +259,8 @@ class  ToysTask2(ToysTask) :
                             fit_fun    = fit_fun    ,
                             accept_fun = accept_fun ,
                             silent     = silent     ,
-                            progress   = progress   )
+                            progress   = progress   ,
+                            seed       = seed       )
                           
         self.gen_pdf    = self.pdf 
         self.fit_pdf    = fit_pdf
@@ -234,20 +284,23 @@ class  ToysTask2(ToysTask) :
                'Jobid %s: Invalid "nToys" argument %s/%s' % ( jobid , nToys , type ( nToys ) )
         
         import ostap.fitting.toys as Toys 
-        results , stats = Toys.make_toys2 ( gen_pdf    = self.gen_pdf    ,
-                                            fit_pdf    = self.fit_pdf    ,
-                                            nToys      = nToys           ,
-                                            data       = self.data       ,
-                                            gen_config = self.gen_config , 
-                                            fit_config = self.fit_config , 
-                                            gen_pars   = self.gen_pars   ,
-                                            fit_pars   = self.fit_pars   ,             
-                                            more_vars  = self.more_vars  ,
-                                            gen_fun    = self.gen_fun    ,
-                                            fit_fun    = self.fit_fun    ,
-                                            accept_fun = self.accept_fun ,
-                                            silent     = self.silent     ,
-                                            progress   = self.progress   )
+        from   ostap.fitting.funbasic import SETPARS 
+        ## the inherited PDFs are reused by the next job in this worker: keep their parameters
+        with SETPARS ( self.gen_pdf ) , SETPARS ( self.fit_pdf ) : 
+            results , stats = Toys.make_toys2 ( gen_pdf    = self.gen_pdf    ,
+                                                fit_pdf    = self.fit_pdf    ,
+                                                nToys      = nToys           ,
+                                                data       = self.data       ,
+                                                gen_config = self.gen_config , 
+                                                fit_config = self.fit_config , 
+                                                gen_pars   = self.gen_pars   ,
+                                                fit_pars   = self.fit_pars   ,             
+                                                more_vars  = self.more_vars  ,
+                                                gen_fun    = self.gen_fun    ,
+                                                fit_fun    = self.fit_fun    ,
+                                                accept_fun = self.accept_fun ,
+                                                silent     = self.silent     ,
+                                                progress   = self.progress   )
                 
         self.the_output = results , stats
         
@@ -310,6 +363,11 @@ class  ToysTask2(ToysTask) :
 # @param fit_fun    fitting   function
 # @param accept_fun accept    function
 # @param silent     silent toys?
+# @param seed       if specified, each job gets the deterministic substream
+#                   of the counter-based generator (reproducible results) 
+# @param fast       use <code>make_toys_fast</code>: NLL&minimizer are built once per subjob
+# @param checkpoint (keyword) checkpoint file to save/resume the long runs
+#                   @see ostap.parallel.checkpoint
 # @return dictionary with fit results for the toys and the dictionary of statistics
 #
 #  - If <code>gen_fun</code>    is not specified <code>generate_data</code> is used 
@@ -327,7 +385,10 @@ def parallel_toys ( pdf                       ,
                     fit_fun    = None         , ## fit       function ( pdf , dataset , **config )
                     accept_fun = None         , ## accept    function ( fit-result, pdf, dataset )
                     silent     = True         ,
-                    progress   = False        , **kwargs ):
+                    progress   = False        ,
+                    fast       = False        , ## use ostap.fitting.toys.make_toys_fast
+                    seed       = None         , ## seed for deterministic per-job substreams 
+                    **kwargs ):
     """Make `ntoys` pseudoexperiments, splitting them into `nSplit` subjobs
     to be executed in parallel
 
@@ -362,6 +423,9 @@ def parallel_toys ( pdf                       ,
     - accept_fun accept    function    
     - silent     silent toys?
     - progress   show progress bar? 
+    - seed       if specified, each job gets the deterministic substream
+    of the counter-based generator (reproducible results) 
+    - fast       use `make_toys_fast`: NLL&minimizer are built once per subjob
     
     It returns a dictionary with fit results for the toys and a dictionary of statistics
     
@@ -401,6 +465,21 @@ def parallel_toys ( pdf                       ,
                'Jobid %s: Invalid "nSplit" argument %s/%s' % ( jobid , nSplit , type ( nSplit ) )
 
     import ostap.fitting.toys as Toys
+    
+    assert not fast or ( gen_fun is None and fit_fun is None ) ,\
+           'parallel_toys: "gen_fun" and "fit_fun" are not allowed for fast toys'
+    
+    if 1 == nSplit and fast :
+        return Toys.make_toys_fast ( pdf        = pdf        ,
+                                     nToys      = nToys      ,
+                                     data       = data       ,
+                                     gen_config = gen_config ,
+                                     fit_config = fit_config ,
+                                     init_pars  = init_pars  ,
+                                     more_vars  = more_vars  ,
+                                     accept_fun = accept_fun ,
+                                     silent     = silent     ,
+                                     progress   = progress   )
     if 1 == nSplit :
         return Toys.make_toys ( pdf        = pdf        ,
                                 nToys      = nToys      ,
@@ -453,17 +532,22 @@ def parallel_toys ( pdf                       ,
                           fit_fun    = fit_fun        ,
                           accept_fun = accept_fun     ,
                           silent     = silent         ,
-                          progress   = progress       )
+                          progress   = progress       ,
+                          fast       = fast           ,
+                          seed       = seed           )
                           
+    ## checkpoint for the long runs (see ostap.parallel.checkpoint)
+    checkpoint = kwargs.pop ( 'checkpoint' , None ) 
     wmgr  = WorkManager ( silent = False , **kwargs )
 
     data  = nSplit * [ nToy ]
     if nRest : data.append ( nRest )
     
-    wmgr.process( task , data )
+    wmgr.process( task , data , checkpoint = checkpoint )
 
     results , stats = task.results () 
-    Toys.print_stats ( stats , nToys ) 
+    if isinstance ( stats , Toys.ToyStats ) : stats.print_stats ( nToys ) 
+    else                                    : Toys.print_stats  ( stats , nToys ) 
         
     return results, stats   
 
@@ -530,6 +614,8 @@ def parallel_toys ( pdf                       ,
 # @param fit_fun    fitting   function
 # @param accept_fun accept    function
 # @param silent     silent toys?
+# @param seed       if specified, each job gets the deterministic substream
+#                   of the counter-based generator (reproducible results) 
 # @return dictionary with fit results for the toys and the dictionary of statistics
 #
 #  - If <code>gen_fun</code>    is not specified <code>generate_data</code> is used 
@@ -550,7 +636,9 @@ def parallel_toys2(
     fit_fun    = None         , ## fit       function ( pdf , dataset , **fit_config ) 
     accept_fun = None         , ## accept    function ( fit-result, pdf, dataset     )
     silent     = True         ,
-    progress   = False        , **kwargs ) :
+    progress   = False        ,
+    seed       = None         , ## seed for deterministic per-job substreams 
+    **kwargs ) :
     """Make `ntoys` pseudoexperiments, splitting them into `nSplit` subjobs
     to be executed in parallel
     
@@ -582,6 +670,8 @@ def parallel_toys2(
     - more_vars  dictionary of functions to define the additional results 
     - silent     silent toys?
     - progress   show progress bar? 
+    - seed       if specified, each job gets the deterministic substream
+    of the counter-based generator (reproducible results) 
     
     It returns a dictionary with fit results for the toys and a dictionary of statistics
     
@@ -680,14 +770,17 @@ def parallel_toys2(
                           fit_fun    = fit_fun        , 
                           accept_fun = accept_fun     , 
                           silent     = silent         ,
-                          progress   = progress       )
+                          progress   = progress       ,
+                          seed       = seed           )
 
+    ## checkpoint for the long runs (see ostap.parallel.checkpoint)
+    checkpoint = kwargs.pop ( 'checkpoint' , None ) 
     wmgr  = WorkManager ( silent = False , **kwargs )
 
     data  = nSplit * [ nToy ]
     if nRest : data.append ( nRest )
     
-    wmgr.process( task , data )
+    wmgr.process( task , data , checkpoint = checkpoint )
 
     results , stats = task.results () 
     Toys.print_stats ( stats , nToys ) 
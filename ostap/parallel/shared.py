@@ -0,0 +1,402 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/parallel/shared.py
+#  Transport of the (large) job results via shared memory for local workers
+#  - the worker writes the result into the file in shared memory
+#    (<code>/dev/shm</code> if available) and returns only the small handle
+#  - the master process reads the result using the handle and removes the file
+#  - numpy arrays are memory-mapped (copy-on-write) without additional copies
+#  It avoids the transfer of large payloads through the pipes of the pool,
+#  and the per-job overhead is mainly defined by the number of results
+#
+#  The large read-only inputs (PDFs, datasets, histograms) are shared
+#  with the forked local workers in the opposite direction:
+#  - the object is registered once in the parent process
+#    (see <code>share_input</code>) and the task keeps only the handle
+#  - the forked workers inherit the registry (copy-on-write), and
+#    the handle is pickled as the bare key 
+#  - for remote (or not forked) workers the object is pickled as usual
+#  @date   2023-01-29
+# =============================================================================
+"""Transport of the (large) job results via shared memory for local workers
+- the worker writes the result into the file in shared memory
+  (/dev/shm if available) and returns only the small handle
+- the master process reads the result using the handle and removes the file
+- numpy arrays are memory-mapped (copy-on-write) without additional copies
+It avoids the transfer of large payloads through the pipes of the pool,
+and the per-job overhead is mainly defined by the number of results
+
+The large read-only inputs (PDFs, datasets, histograms) are shared
+with the forked local workers in the opposite direction:
+- the object is registered once in the parent process
+  (see `share_input`) and the task keeps only the handle
+- the forked workers inherit the registry (copy-on-write), and
+  the handle is pickled as the bare key
+- for remote (or not forked) workers the object is pickled as usual
+"""
+# =============================================================================
+__version__ = '$Revision$'
+__author__  = 'Vanya BELYAEV Ivan.Belyaev@itep.ru'
+__date__    = '2023-01-29'
+__all__     = (
+    'SharedResult'   , ## the handle for the result in shared memory
+    'SharedExecutor' , ## executor wrapper, that puts results into shared memory
+    'SharedStore'    , ## context manager for the directory in shared memory
+    'from_shared'    , ## get the result from the handle
+    'to_shared'      , ## put the result into shared memory
+    'SharedInput'    , ## the handle for the large read-only input
+    'SharedAttribute', ## descriptor for the task attributes, shared with workers
+    'share_input'    , ## register the large read-only input
+    'shared_value'   , ## get the object from the handle
+    'inputs_generation' , ## the current generation of the registry 
+    'inherited_inputs'  , ## context manager: pickle handles as bare keys
+    'forked_workers'    , ## are the workers forked?
+    )
+# =============================================================================
+import os, sys
+from   ostap.logger.logger import getLogger
+if '__main__' == __name__ : logger = getLogger ( 'ostap.parallel.shared' )
+else                      : logger = getLogger ( __name__                )
+# =============================================================================
+try :
+    import cPickle as pickle
+except ImportError :
+    import pickle
+# =============================================================================
+## results with smaller serialized size are sent directly
+MIN_SIZE = 64 * 1024
+# =============================================================================
+## @class SharedResult
+#  The (small) handle for the result, stored in shared memory
+class SharedResult(object) :
+    """The (small) handle for the result, stored in shared memory
+    """
+    __slots__ = ( 'fname' , 'kind' )
+    def __init__ ( self , fname , kind = 'pickle' ) :
+        self.fname = fname
+        self.kind  = kind
+    def __getstate__  ( self ) : return self.fname , self.kind
+    def __setstate__  ( self , state ) : self.fname , self.kind = state
+
+    ## load the result and remove the file
+    def load ( self ) :
+        """Load the result and remove the file"""
+        try :
+            if 'numpy' == self.kind :
+                import numpy
+                ## copy-on-write mapping: no copy, but writable
+                return numpy.load ( self.fname , mmap_mode = 'c' , allow_pickle = False )
+            with open ( self.fname , 'rb' ) as f :
+                return pickle.load ( f )
+        finally :
+            ## the mapping (if any) remains valid after removal
+            try :
+                os.remove ( self.fname )
+            except ( OSError , IOError ) :
+                pass
+
+    def __repr__ ( self ) : return "SharedResult('%s','%s')" % ( self.fname , self.kind )
+    __str__ = __repr__
+
+# =============================================================================
+## put the result into shared memory (if large enough)
+#  @param result    the result
+#  @param directory the directory in shared memory
+#  @param jobid     the job identifier
+#  @return the handle or the result itself
+def to_shared ( result , directory , jobid = 0 ) :
+    """Put the result into shared memory (if large enough)
+    - return the handle or the result itself
+    """
+    import tempfile
+
+    numpy = sys.modules.get ( 'numpy' , None )
+    if numpy and isinstance ( result , numpy.ndarray ) and \
+       MIN_SIZE <= result.nbytes and not result.dtype.hasobject :
+        fd , fname = tempfile.mkstemp ( dir = directory , prefix = 'job%d-' % jobid , suffix = '.npy' )
+        with os.fdopen ( fd , 'wb' ) as f : numpy.save ( f , result , allow_pickle = False )
+        return SharedResult ( fname , 'numpy' )
+
+    data = pickle.dumps ( result , pickle.HIGHEST_PROTOCOL )
+    if len ( data ) < MIN_SIZE : return result
+
+    fd , fname = tempfile.mkstemp ( dir = directory , prefix = 'job%d-' % jobid , suffix = '.pkl' )
+    with os.fdopen ( fd , 'wb' ) as f : f.write ( data )
+    return SharedResult ( fname , 'pickle' )
+
+# =============================================================================
+## get the result from the handle (if needed)
+def from_shared ( result ) :
+    """Get the result from the handle (if needed)
+    """
+    return result.load() if isinstance ( result , SharedResult ) else result
+
+# =============================================================================
+## @class SharedExecutor
+#  Wrapper for the executor function: the result is put into the shared memory
+#  @code
+#  executor = SharedExecutor ( task_executor , directory )
+#  @endcode
+#  @see task_executor
+#  @see func_executor
+#  @see group_executor
+class SharedExecutor(object) :
+    """Wrapper for the executor function: the result is put into the shared memory
+    >>> executor = SharedExecutor ( task_executor , directory )
+    """
+    def __init__ ( self , executor , directory ) :
+        self.executor  = executor
+        self.directory = directory
+
+    def __call__ ( self , item ) :
+        import time 
+        jobid , result , stat = self.executor ( item )
+        start  = time.time ()
+        result = to_shared ( result , self.directory , jobid )
+        stat.span ( 'serialize' , start , time.time () ) 
+        return jobid , result , stat
+
+# =============================================================================
+## @class SharedStore
+#  Context manager for the temporary directory in shared memory
+#  @code
+#  with SharedStore () as store :
+#     executor = store.wrap ( task_executor )
+#     ...
+#  @endcode
+class SharedStore(object) :
+    """Context manager for the temporary directory in shared memory
+    >>> with SharedStore () as store :
+    ...    executor = store.wrap ( task_executor )
+    ...
+    """
+    def __init__ ( self ) :
+        self.__directory = None
+
+    def __enter__ ( self ) :
+        import tempfile
+        base = '/dev/shm'
+        if not ( os.path.isdir ( base ) and os.access ( base , os.W_OK | os.X_OK ) ) :
+            base = tempfile.gettempdir ()
+        self.__directory = tempfile.mkdtemp ( dir = base , prefix = 'ostap-shared-' )
+        logger.debug ( 'Shared directory for the results: %s' % self.__directory )
+        return self
+
+    def __exit__  ( self , *_ ) :
+        if self.__directory and os.path.isdir ( self.__directory ) :
+            import shutil
+            shutil.rmtree ( self.__directory , ignore_errors = True )
+        self.__directory = None
+
+    ## wrap the executor function
+    def wrap ( self , executor ) :
+        """Wrap the executor function"""
+        return SharedExecutor ( executor , self.__directory )
+
+    @property
+    def directory ( self ) :
+        """``directory'' : the directory in shared memory"""
+        return self.__directory
+
+# =============================================================================
+## Registry of the large read-only inputs: key -> [ object , counter ]
+#  - the keys are increasing integers, the key is the "generation"
+#    of the registry at the moment of the registration 
+_inputs     = {}
+## id ( object ) -> key 
+_input_keys = {}
+## the last key (the current generation of the registry)
+_generation = [ 0 ]
+## the generation, inherited by the forked workers (None: no forked workers) 
+_inherited  = [ None ]
+# =============================================================================
+## get the current generation of the registry of the shared inputs
+#  - the workers, forked after this moment, inherit all inputs
+#    with keys not exceeding this generation 
+def inputs_generation () :
+    """Get the current generation of the registry of the shared inputs
+    - the workers, forked after this moment, inherit all inputs
+    with keys not exceeding this generation 
+    """
+    return _generation [ 0 ]
+
+# =============================================================================
+## @class SharedInput
+#  The handle for the large read-only input (PDF, dataset, histogram, ...)
+#  - for the forked local workers, that inherit the registry,
+#    only the key is pickled
+#  - otherwise the object itself is pickled
+#  @code
+#  handle = share_input ( dataset )
+#  ...
+#  dataset = handle.value
+#  @endcode
+#  @attention the object must not be modified after the registration 
+class SharedInput(object) :
+    """The handle for the large read-only input (PDF, dataset, histogram, ...)
+    - for the forked local workers, that inherit the registry,
+    only the key is pickled
+    - otherwise the object itself is pickled
+    >>> handle = share_input ( dataset )
+    >>> ...
+    >>> dataset = handle.value
+    - attention: the object must not be modified after the registration 
+    """
+    __slots__ = ( 'key' , 'payload' , 'owner' )
+    def __init__ ( self , key , payload , owner = False ) :
+        self.key     = key
+        self.payload = payload
+        self.owner   = owner
+
+    ## pickle only the key for the forked workers, that inherit it 
+    def __getstate__  ( self ) :
+        inherited = _inherited [ 0 ]
+        if inherited is not None and self.key <= inherited and self.key in _inputs :
+            return self.key , None 
+        return self.key , self.value 
+    def __setstate__  ( self , state ) :
+        self.key , self.payload = state
+        self.owner = False 
+        
+    @property
+    def value ( self ) :
+        """``value'' : the actual object"""
+        if self.payload is not None : return self.payload
+        item = _inputs.get ( self.key , None )
+        assert item is not None , \
+               'SharedInput: the input #%s is not inherited by this process!' % self.key 
+        return item [ 0 ]
+
+    ## release the input (for the owner handle only)
+    def release ( self ) :
+        """Release the input (for the owner handle only)"""
+        if not self.owner : return
+        self.owner = False
+        item = _inputs.get ( self.key , None )
+        if item is None : return 
+        item [ 1 ] -= 1
+        if item [ 1 ] <= 0 :
+            del _inputs [ self.key ]
+            _input_keys.pop ( id ( item [ 0 ] ) , None )
+            
+    def __del__  ( self ) :
+        try :
+            self.release ()
+        except Exception :
+            pass
+        
+    def __repr__ ( self ) : return "SharedInput(#%s)" % self.key
+    __str__ = __repr__
+
+# =============================================================================
+## register the large read-only input and get the (owner) handle
+#  - the input is released when all owner handles are deleted
+#  - the same object is registered only once 
+#  @code
+#  handle = share_input ( dataset )
+#  @endcode
+#  @attention the object must not be modified after the registration 
+def share_input ( obj ) :
+    """Register the large read-only input and get the (owner) handle
+    - the input is released when all owner handles are deleted
+    - the same object is registered only once 
+    >>> handle = share_input ( dataset )
+    - attention: the object must not be modified after the registration 
+    """
+    if isinstance ( obj , SharedInput ) : obj = obj.value
+    key = _input_keys.get ( id ( obj ) , None )
+    if key is None :
+        _generation [ 0 ] += 1
+        key = _generation [ 0 ]
+        _inputs     [ key       ] = [ obj , 0 ]
+        _input_keys [ id ( obj ) ] = key 
+    _inputs [ key ] [ 1 ] += 1
+    return SharedInput ( key , obj , owner = True )
+
+# =============================================================================
+## get the object from the handle (if needed)
+def shared_value ( obj ) :
+    """Get the object from the handle (if needed)"""
+    return obj.value if isinstance ( obj , SharedInput ) else obj 
+
+# =============================================================================
+## @class SharedAttribute
+#  Descriptor for the large read-only attributes of the task:
+#  the assigned object is registered as the shared input,
+#  and only the handle is kept (and pickled) 
+#  @code
+#  class MyTask(Task) :
+#     dataset = SharedAttribute ( 'dataset' )
+#     def __init__ ( self , dataset ) :
+#         self.dataset = dataset 
+#  @endcode 
+#  @see share_input 
+class SharedAttribute(object) :
+    """Descriptor for the large read-only attributes of the task:
+    the assigned object is registered as the shared input,
+    and only the handle is kept (and pickled) 
+    >>> class MyTask(Task) :
+    ...    dataset = SharedAttribute ( 'dataset' )
+    ...    def __init__ ( self , dataset ) :
+    ...        self.dataset = dataset 
+    - see share_input 
+    """
+    def __init__ ( self , name ) :
+        self.__name = '_shared_' + name
+    def __get__  ( self , obj , objtype = None ) :
+        if obj is None : return self
+        return shared_value ( obj.__dict__.get ( self.__name , None ) )
+    def __set__  ( self , obj , value ) :
+        obj.__dict__ [ self.__name ] = None if value is None else share_input ( value )
+
+# =============================================================================
+## @class inherited_inputs
+#  Context manager to pickle the handles of the inputs, inherited by the
+#  forked workers, as bare keys
+#  @code
+#  with inherited_inputs ( generation ) :
+#     ... submit the jobs 
+#  @endcode
+#  @param generation the generation of the registry at the moment of the
+#   fork of the workers, <code>None</code> for not-forked or remote workers 
+class inherited_inputs(object) :
+    """Context manager to pickle the handles of the inputs, inherited by the
+    forked workers, as bare keys
+    - generation: the generation of the registry at the moment of the
+    fork of the workers, None for not-forked or remote workers 
+    >>> with inherited_inputs ( generation ) :
+    ...    ... submit the jobs 
+    """
+    def __init__  ( self , generation ) :
+        self.__generation = generation
+        self.__previous   = None 
+    def __enter__ ( self ) :
+        self.__previous  = _inherited [ 0 ]
+        _inherited [ 0 ] = self.__generation
+        return self
+    def __exit__  ( self , *_ ) :
+        _inherited [ 0 ] = self.__previous
+
+# =============================================================================
+## are the workers of the pool forked (and inherit the memory of the parent)?
+#  @param mp the multiprocessing module (<code>multiprocessing</code> or <code>multiprocess</code>) 
+def forked_workers ( mp ) :
+    """Are the workers of the pool forked (and inherit the memory of the parent)?
+    - mp : the multiprocessing module (`multiprocessing` or `multiprocess`)
+    """
+    getter = getattr ( mp , 'get_start_method' , None )
+    if getter is None : return 'posix' == os.name
+    method = getter ( allow_none = True )
+    if method is None : method = mp.get_all_start_methods () [ 0 ]
+    return 'fork' == method 
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+#                                                                       The END
+# =============================================================================
@@ -41,7 +41,10 @@ __all__     = (
     'Statistics'    , ## helper class to collect statistics 
     'StatMerger'    , ## helper class to merge   statistics
     'TaskMerger'    , ## simple merger for task results
+    'WaveScheduler' , ## dynamic scheduler for sized (splittable) items 
+    'AffinityScheduler' , ## data-locality aware scheduler with work stealing 
     'task_executor' , ## helper function to execute Task  
+    'group_executor', ## helper function to execute Task for the group of items with local merge 
     'func_executor' , ## helper function to execute callable
     )
 # =============================================================================
@@ -82,8 +85,16 @@ class Task(object) :
     - append_to : append some path-like enviroment varibales 
     - prepend_to : prepend some path-like enviroment varibales 
     - dot_in_path : shoud the '.' be added to sys.path?
+    - mergeable : can the partial results be merged at the remote host?
     """
     __metaclass__ = abc.ABCMeta
+
+    ## Can the partial results be merged at the remote host?
+    #  If true, the (shallow) copy of the task after <code>initialize_local</code>
+    #  can merge the results of <code>process</code>, and its <code>results</code>
+    #  can be merged again at local host by <code>merge_results</code>
+    #  @see group_executor 
+    mergeable = False 
     
     ## @attention ensure that the important attributes are available even before __init__
     def __new__( cls , *args , **kwargs):
@@ -104,6 +115,8 @@ class Task(object) :
         obj.__build_set   = False
         
         obj.__cleanup     = True
+
+        obj.__trace       = False 
         
         return obj
 
@@ -231,6 +244,17 @@ class Task(object) :
     @cleanup.setter
     def cleanup ( self , value ) :
         self.__cleanup     = True if value else False
+
+    @property
+    def trace ( self ) :
+        """``trace'' : collect C++ instrumentation counters for each job?
+        - see ostap.parallel.timeline
+        - see ostap.utils.instrument 
+        """
+        return self.__trace
+    @trace.setter
+    def trace ( self , value ) :
+        self.__trace       = True if value else False
         
 # =============================================================================
 ## @class GenericTask
@@ -425,9 +449,17 @@ class FuncTask(Task) :
 # =============================================================================
 ## @class Statistics
 #  helper class to collect statistics 
+#  - in addition to the time and number of jobs it keeps 
+#    the start/stop timestamps, the process identifier and the 
+#    list of the (named) spans inside the job, used for the timeline
+#  @see ostap.parallel.timeline 
 #  @author Pere MATO Pere.Meto@cern.ch
 class Statistics(object):
     """Helper class to collect statistics
+    - in addition to the time and number of jobs it keeps 
+    the start/stop timestamps, the process identifier and the 
+    list of the (named) spans inside the job, used for the timeline
+    - see ostap.parallel.timeline
     """
     def __init__ ( self , host = None ) :
         import time
@@ -437,14 +469,40 @@ class Statistics(object):
         else :
             self.__host = host 
         self.__start = time.time ( )
-        self.time  = 0.0
-        self.njobs = 0
+        self.__stop  = self.__start 
+        self.__pid   = os.getpid  ( ) 
+        self.time    = 0.0
+        self.njobs   = 0
+        self.spans   = []
+        self.args    = {} 
         
     def stop ( self ) :
         import time
-        self.time   = time.time () - self.__start
+        self.__stop = time.time ()
+        self.time   = self.__stop - self.__start
         self.njobs += 1
 
+    # =========================================================================
+    ## add the named span (wall-clock timestamps) 
+    def span ( self , name , start , stop , **args ) :
+        """Add the named span (wall-clock timestamps)"""
+        self.spans.append ( ( name , start , stop , args ) )
+        
+    @property
+    def start_time ( self ) :
+        """``start_time'' : the start of the job (wall-clock timestamp)"""
+        return self.__start
+    
+    @property
+    def stop_time ( self ) :
+        """``stop_time'' : the end of the job (wall-clock timestamp)"""
+        return self.__stop 
+
+    @property
+    def pid ( self ) :
+        """``pid'' : the process identifier of the worker"""
+        return self.__pid 
+
     def __enter__ ( self      ) : return self
     def __exit__  ( self , *_ ) : self.stop()
     
@@ -773,14 +831,95 @@ def task_executor ( item ) :
     
     ## use clean, build & batch context 
     with clean_context (),  build_context ( task.build ), batch_context ( task.batch ) : 
+
+        import time 
         
-        ## perform remote  inialization (if needed) 
+        ## perform remote  inialization (if needed)
+        start = time.time () 
         task.initialize_remote ( jobid ) 
         
+        if task.trace : 
+            from ostap.utils.instrument import instrument_enable, instrument_reset 
+            instrument_reset  () 
+            instrument_enable () 
+            
         with Statistics ()  as stat :    
-            result = task.process ( jobid , *args ) 
-            return jobid , result , stat
+            result = task.process ( jobid , *args )
+            
+        stat.span ( 'initialize' , start , stat.start_time )
+        if task.trace :
+            from ostap.utils.instrument import instrument_counters 
+            stat.args [ 'counters' ] = dict ( ( n , ( c , t ) ) for n , c , t in instrument_counters () )
+            
+        return jobid , result , stat
+        
+# =============================================================================
+## helper function to execute the task for the group of items and 
+#  merge the results at the remote host: it reduces the number of 
+#  results to be transferred and merged at the local host, and the merging 
+#  is performed in parallel and overlaps with the processing 
+#  @see Task.mergeable 
+#  @see task_executor 
+def group_executor ( item ) :
+    """Helper function to execute the task for the group of items and 
+    merge the results at the remote host: it reduces the number of 
+    results to be transferred and merged at the local host, and the merging 
+    is performed in parallel and overlaps with the processing 
+    - see Task.mergeable
+    - see task_executor 
+    """
+    ## unpack
+    task  = item [ 0 ]
+    jobid = item [ 1 ] 
+    group = item [ 2 ]
+
+    ## local worker and local merger (the task itself is not modified)
+    import copy
+    worker = copy.copy ( task )
+    if 1 == len ( group ) :
+        return task_executor ( ( worker , jobid ) + tuple ( group [ 0 ] ) ) 
         
+    merger = copy.copy ( task )
+    merger.initialize_local ()
+    
+    import time 
+    with Statistics () as stat :
+        for args in group :
+            _ , result , s = task_executor ( ( worker , jobid ) + tuple ( args ) )
+            stat.span ( 'process' , s.start_time , s.stop_time , **s.args )
+            start = time.time () 
+            merger.merge_results ( result , jobid )
+            stat.span ( 'merge'   , start , time.time () ) 
+            del result 
+        return jobid , merger.results () , stat
+
+# =============================================================================
+## group the items for <code>group_executor</code> 
+#  @param items list of ( size , item ) pairs, sorted by size  
+#  @param size  the target size of the group 
+#  @return list of groups 
+#  @see group_executor
+def group_items ( items , size ) :
+    """Group the items for `group_executor`
+    - items : list of ( size , item ) pairs, sorted by size
+    - size  : the target size of the group 
+    - see group_executor
+    """
+    groups  = []
+    current = []
+    ncur    = 0 
+    for n , item in items :
+        if size <= n :
+            groups.append ( ( n , [ ( item , ) ] ) )
+            continue
+        current.append ( ( item , ) )
+        ncur += n
+        if size <= ncur :
+            groups.append ( ( ncur , current ) )
+            current , ncur = [] , 0
+    if current : groups.append ( ( ncur , current ) )
+    return groups 
+
 # =============================================================================
 ## helper function to execute the function and collect statisticc
 #  (unfornately due to limitation of <code>parallel python</code> one cannot
@@ -802,6 +941,329 @@ def func_executor ( item ) :
         with Statistics ()  as stat :
             return jobid , fun ( jobid , *args ) , stat
         
+# ============================================================================
+## @class WaveScheduler
+#  Dynamic scheduler for the sized and splittable items, e.g. Chain/Tree 
+#  - items are processed in ``waves'', each wave covers about a half
+#    of the remaining work (guided self-scheduling),
+#    and the jobs inside the wave are dispatched dynamically by the pool
+#  - large items are split according to the entry count, 
+#    the job size decreases with the remaining work, 
+#    therefore the tail of processing is made of small jobs 
+#  - the observed per-entry cost defines the minimal job size
+#    to keep the per-job overhead small
+#  @code
+#  scheduler = WaveScheduler ( items , ncpus = 16 , splitter = ... )
+#  while scheduler :
+#      for n , item in scheduler.wave () :
+#          ... 
+#          scheduler.update ( n , time ) 
+#  @endcode
+#  @date 2023-01-29
+class WaveScheduler(object) :
+    """Dynamic scheduler for the sized and splittable items, e.g. Chain/Tree
+    - items are processed in ``waves'', each wave covers about a half
+    of the remaining work (guided self-scheduling),
+    and the jobs inside the wave are dispatched dynamically by the pool
+    - large items are split according to the entry count, 
+    the job size decreases with the remaining work, 
+    therefore the tail of processing is made of small jobs 
+    - the observed per-entry cost defines the minimal job size
+    to keep the per-job overhead small
+    >>> scheduler = WaveScheduler ( items , ncpus = 16 , splitter = ... )
+    >>> while scheduler :
+    ...     for n , item in scheduler.wave () :
+    ...         ... 
+    ...         scheduler.update ( n , time ) 
+    """
+    def __init__ ( self               ,
+                   items              ,   ## sized items 
+                   ncpus              ,   ## number of workers 
+                   splitter           ,   ## splitter: splitter ( item , nparts ) -> pieces
+                   min_entries = 1000 ,   ## minimal job size (entries)
+                   min_time    = 1.0  ) : ## minimal job duration (seconds)
+        
+        self.__ncpus       = max ( 1 , ncpus )
+        self.__splitter    = splitter
+        self.__min_entries = max ( 1 , min_entries )
+        self.__min_time    = max ( 0 , min_time    )
+        ## the queue of ( size , item ) pairs, the largest items first 
+        self.__queue       = [ ( len ( item ) , item ) for item in items ]
+        self.__queue.sort ( key = lambda p : p [ 0 ] , reverse = True )
+        self.__total       = sum ( p [ 0 ] for p in self.__queue )
+        ## observed cost 
+        self.__entries     = 0
+        self.__time        = 0.0 
+        ## the last job size 
+        self.__last        = self.__min_entries 
+
+    @property
+    def total ( self ) :
+        """``total'' : total number of entries to be processed"""
+        return self.__total
+    
+    @property
+    def job_size_last ( self ) :
+        """``job_size_last'' : the target job size for the last wave"""
+        return self.__last
+    
+    @property
+    def remaining ( self ) :
+        """``remaining'' : number of entries not yet scheduled"""
+        return sum ( p [ 0 ] for p in self.__queue )
+        
+    @property
+    def cost ( self ) :
+        """``cost'' : observed per-entry cost (seconds), None if not known yet"""
+        if 0 < self.__entries and 0 < self.__time : return self.__time / self.__entries
+        return None 
+
+    ## update the observed cost 
+    def update ( self , nentries , time ) :
+        """Update the observed cost"""
+        self.__entries += nentries
+        self.__time    += time 
+
+    ## the target job size for the next wave 
+    def job_size ( self ) :
+        """The target job size (entries) for the next wave"""
+        remaining = self.remaining 
+        target    = ( remaining + 2 * self.__ncpus - 1 ) // ( 2 * self.__ncpus )
+        min_job   = self.__min_entries
+        cost      = self.cost 
+        if cost : min_job = max ( min_job , int ( self.__min_time / cost ) )
+        return max ( target , min_job )
+
+    ## get the next wave of jobs: list of ( size , item ) pairs 
+    def wave ( self ) :
+        """Get the next wave of jobs: list of ( size , item ) pairs"""
+        
+        target   = self.job_size ()
+        capacity = target * self.__ncpus
+        self.__last = target 
+        
+        jobs  = []
+        taken = 0
+        while self.__queue and taken < capacity :
+            
+            n , item = self.__queue.pop ( 0 )            
+            if 2 * n <= 3 * target : 
+                jobs.append ( ( n , item ) )
+                taken += n
+                continue
+            
+            ## split the large item
+            nparts = ( n + target - 1 ) // target 
+            pieces = [ ( len ( p ) , p ) for p in self.__splitter ( item , nparts ) ]
+            pieces = [ p for p in pieces if 0 < p [ 0 ] ]
+            if len ( pieces ) <= 1 :
+                jobs.append ( ( n , item ) )
+                taken += n
+                continue
+            
+            pieces.sort ( key = lambda p : p [ 0 ] , reverse = True )
+            while pieces and taken < capacity :
+                p = pieces.pop ( 0 )
+                jobs.append ( p )
+                taken += p [ 0 ]
+                
+            ## return the rest to the queue 
+            self.__queue += pieces 
+            self.__queue.sort ( key = lambda p : p [ 0 ] , reverse = True )
+
+        return jobs
+
+    def __len__     ( self ) : return len ( self.__queue )
+    def __bool__    ( self ) : return 0 < len ( self.__queue )
+    def __nonzero__ ( self ) : return 0 < len ( self.__queue )
+
+# =============================================================================
+## split Chain/Tree into (approximately) <code>nparts</code> pieces
+#  @see WaveScheduler
+def split_chain ( chain , nparts ) :
+    """Split Chain/Tree into (approximately) ``nparts'' pieces
+    - see WaveScheduler
+    """
+    n = len ( chain )
+    if nparts <= 1 or n <= 1 : return chain ,
+    return chain.split ( chunk_size = max ( 1 , ( n + nparts - 1 ) // nparts ) )
+
+# =============================================================================
+## normalize the host name: remove user name, port and the case
+#  @code
+#  normal_host ( 'user@LXPLUS901.cern.ch:60000' ) ## 'lxplus901.cern.ch'
+#  @endcode 
+def normal_host ( host ) :
+    """Normalize the host name: remove user name, port and the case
+    >>> normal_host ( 'user@LXPLUS901.cern.ch:60000' ) ## 'lxplus901.cern.ch'
+    """
+    host = str ( host ).strip().lower()
+    if '@' in host : host = host.split ( '@' ) [ -1 ]
+    if ':' in host : host = host.split ( ':' ) [  0 ]
+    return host
+
+# =============================================================================
+## is it the same host? (either the full or the short names are equal)
+def same_host ( h1 , h2 ) :
+    """Is it the same host? (either the full or the short names are equal)"""
+    h1 = normal_host ( h1 )
+    h2 = normal_host ( h2 )
+    if h1 == h2 : return True
+    if '.' in h1 and '.' in h2 : return False
+    return h1.split ( '.' ) [ 0 ] == h2.split ( '.' ) [ 0 ]
+
+# =============================================================================
+## get the files for the job item: Chain/Tree, file name or the tuple of arguments
+def item_files ( item ) :
+    """Get the files for the job item: Chain/Tree, file name or the tuple of arguments"""
+    from ostap.core.ostap_types import string_types
+    if isinstance ( item , string_types ) : return item , 
+    files = getattr ( item , 'files' , None )
+    if files is not None :
+        return tuple ( files ) if isinstance ( files , ( list , tuple ) ) else ( files , )
+    if isinstance ( item , ( list , tuple ) ) :
+        result = ()
+        for i in item : result += item_files ( i )
+        return result 
+    return ()
+
+# =============================================================================
+## get the preferred hosts for the file using the affinity map:
+#  - <code>dict</code> { file (or the file prefix) : host or hosts }
+#  - callable: <code>affinity ( file ) -> host or hosts</code>
+def file_hosts ( the_file , affinity ) :
+    """Get the preferred hosts for the file using the affinity map:
+    - dict { file (or the file prefix) : host or hosts }
+    - callable: affinity ( file ) -> host or hosts
+    """
+    if   affinity is None : return ()
+    elif callable ( affinity ) : hosts = affinity ( the_file )
+    else :
+        hosts = affinity.get ( the_file , None )
+        if hosts is None : ## the longest matching prefix, e.g. the directory 
+            keys = [ k for k in affinity if the_file.startswith ( k ) ]
+            if keys : hosts = affinity [ max ( keys , key = len ) ]
+    if not hosts : return ()
+    from ostap.core.ostap_types import string_types
+    if isinstance ( hosts , string_types ) : return hosts ,
+    return tuple ( hosts )
+
+# =============================================================================
+## get the preferred hosts for the job item,
+#  the hosts that have more files of the item come first
+def item_hosts ( item , affinity ) :
+    """Get the preferred hosts for the job item,
+    the hosts that have more files of the item come first
+    """
+    votes = {}
+    for f in item_files ( item ) :
+        for h in file_hosts ( f , affinity ) :
+            h = normal_host ( h ) 
+            votes [ h ] = votes.get ( h , 0 ) + 1
+    return tuple ( sorted ( votes , key = lambda h : - votes [ h ] ) )
+
+# ============================================================================
+## @class AffinityScheduler
+#  Data-locality aware scheduler with the work stealing 
+#  - each item is queued at the (first available) host that keeps its data 
+#  - the items without the local host go to the common queue 
+#  - the host takes the items from its own queue, then from the common queue,
+#    and then it steals the items from the longest queue of other hosts 
+#  - the scheduler is thread-safe 
+#  @code
+#  scheduler = AffinityScheduler ( items , hosts = [ 'h1' , 'h2' ] , affinity = { 'a.root' : 'h1' } )
+#  while True :
+#      job = scheduler.next ( 'h2' )
+#      if job is None : break
+#      index , item = job 
+#  @endcode
+#  @see item_hosts 
+class AffinityScheduler(object) :
+    """Data-locality aware scheduler with the work stealing 
+    - each item is queued at the (first available) host that keeps its data 
+    - the items without the local host go to the common queue 
+    - the host takes the items from its own queue, then from the common queue,
+    and then it steals the items from the longest queue of other hosts 
+    - the scheduler is thread-safe 
+    >>> scheduler = AffinityScheduler ( items , hosts = [ 'h1' , 'h2' ] , affinity = { 'a.root' : 'h1' } )
+    >>> while True :
+    ...     job = scheduler.next ( 'h2' )
+    ...     if job is None : break
+    ...     index , item = job 
+    """
+    def __init__ ( self , items , hosts , affinity ) :
+
+        import threading 
+        self.__lock   = threading.Lock ()
+        self.__hosts  = tuple ( normal_host ( h ) for h in hosts )
+        self.__queues = dict  ( ( h , [] ) for h in self.__hosts )
+        self.__common = []
+        self.__local  = 0
+        self.__stolen = 0
+        self.__other  = 0
+        
+        for index , item in enumerate ( items ) :
+            queue = self.__common
+            for h in item_hosts ( item , affinity ) :
+                host = self.find ( h )
+                if host is not None :
+                    queue = self.__queues [ host ]
+                    break
+            queue.append ( ( index , item ) )
+
+    ## find the scheduler host that matches the given host name
+    def find ( self , host ) :
+        """Find the scheduler host that matches the given host name"""
+        for h in self.__hosts :
+            if same_host ( h , host ) : return h
+        return None
+    
+    ## get the next job for the host: ( index , item ) pair or None
+    def next ( self , host ) :
+        """Get the next job for the host: ( index , item ) pair or None"""
+        host = self.find ( host ) 
+        with self.__lock :
+            queue = self.__queues.get ( host , None )
+            if queue :
+                self.__local += 1
+                return queue.pop ( 0 )
+            if self.__common :
+                self.__other += 1 
+                return self.__common.pop ( 0 )
+            ## steal from the end of the longest queue 
+            victim = max ( self.__queues.values () , key = len ) if self.__queues else None 
+            if victim :
+                self.__stolen += 1
+                return victim.pop ()
+        return None
+    
+    @property
+    def hosts ( self ) :
+        """``hosts'' : the (normalized) hosts"""
+        return self.__hosts
+
+    @property
+    def local ( self ) :
+        """``local'' : number of jobs, executed at the data-local hosts"""
+        return self.__local
+    
+    @property
+    def stolen ( self ) :
+        """``stolen'' : number of jobs, stolen from other hosts"""
+        return self.__stolen
+
+    @property
+    def other ( self ) :
+        """``other'' : number of jobs without the data-local host"""
+        return self.__other
+
+    def __len__ ( self ) :
+        with self.__lock :
+            return len ( self.__common ) + sum ( len ( q ) for q in self.__queues.values () )
+        
+    def __bool__    ( self ) : return 0 < len ( self ) 
+    def __nonzero__ ( self ) : return 0 < len ( self ) 
+    
 # ============================================================================
 ## @class TaskManager
 #   Abstract base class for the work manager for parallel processing  
@@ -814,11 +1276,15 @@ class TaskManager(object) :
     def __init__  ( self            ,
                     ncpus           ,
                     silent  = False ,
-                    progress = True ) :
+                    progress = True , 
+                    memory_budget = None ) :
         
         self.__ncpus    = ncpus        
         self.__silent   = silent
         self.__progress = True if progress else False
+        assert memory_budget is None or 0 <= memory_budget , \
+               'TaskManager: invalid memory budget %s' % memory_budget 
+        self.__memory_budget = memory_budget 
         
     # =========================================================================
     ## process Task or callable object :
@@ -840,6 +1306,48 @@ class TaskManager(object) :
     #  ## get sum of them 
     #  result2 =  wm.process ( my_fun , items , merger = TaskMerger () )    
     #  @endcode
+    #  - for Chain/Tree items and Task with additive results 
+    #    the dynamic scheduling with adaptive splitting can be used:
+    #  @code
+    #  result = wm.process ( my_task , trees , dynamic = True )
+    #  @endcode
+    #  @see WaveScheduler 
+    #  - for the local workers the results are transferred via shared memory
+    #    (<code>shared</code> argument) 
+    #  @see ostap.parallel.shared 
+    #  - for the forked local workers the large read-only inputs of the task,
+    #    registered via <code>share_input</code>, are inherited (copy-on-write) 
+    #    and are not pickled 
+    #  @see ostap.parallel.shared.share_input 
+    #  - the timeline of the jobs in Chrome-trace format can be
+    #    collected (<code>timeline</code> argument) 
+    #  @code
+    #  result = wm.process ( my_task , items , timeline = 'trace.json' )
+    #  @endcode
+    #  @see ostap.parallel.timeline 
+    #  - the jobs can be placed preferentially at the hosts with the local
+    #    replicas (or warm caches) of the input files (<code>affinity</code> argument),
+    #    the idle hosts steal the jobs from other hosts 
+    #  @code
+    #  result = wm.process ( my_task , chains , affinity = { '/eos/lhcb/data1/' : 'node1' } )
+    #  result = wm.process ( my_task , chains , affinity = lambda fname : ... )
+    #  @endcode
+    #  @see AffinityScheduler 
+    #  - the long runs can be checkpointed (<code>checkpoint</code> argument):
+    #    the merged partial results and the completed items are periodically saved,
+    #    and the next run with the same checkpoint resumes the processing 
+    #  @code
+    #  result = wm.process ( my_task , items , checkpoint = 'my_run.zip' , checkpoint_period = 600 )
+    #  @endcode
+    #  @see ostap.parallel.checkpoint 
+    #  - the memory budget per node (in MB) for the C++ multithreaded engines 
+    #    (<code>memory_budget</code> argument) is shared equally between the workers:
+    #    the per-thread buffers, histogram clones and the prefetch depth are 
+    #    adjusted to fit it 
+    #  @code
+    #  result = wm.process ( my_task , items , memory_budget = 16000 )
+    #  @endcode
+    #  @see ostap.utils.memory.set_memory_budget 
     def process ( self , task , args , **kwargs ) :
         """Process callable object or Task :
         
@@ -858,19 +1366,114 @@ class TaskManager(object) :
         >>> result1 =  wm.process ( my_fun , items , merger = TaskMerger ( lambda  a,b : a+[b] , init = [] ) )
         >>> result2 =  wm.process ( my_fun , items , merger = TaskMerger () )    
         
+        - for Chain/Tree items and Task with additive results 
+        the dynamic scheduling with adaptive splitting can be used:
+        
+        >>> result = wm.process ( my_task , trees , dynamic = True )
+        
+        - see WaveScheduler 
+        
+        - for the local workers the results are transferred via shared memory
+        (``shared'' argument), see ostap.parallel.shared 
+
+        - for the forked local workers the large read-only inputs of the task,
+        registered via `share_input`, are inherited (copy-on-write) and are
+        not pickled, see ostap.parallel.shared.share_input 
+
+        - the timeline of the jobs in Chrome-trace format can be
+        collected (``timeline'' argument), see ostap.parallel.timeline
+        
+        >>> result = wm.process ( my_task , items , timeline = 'trace.json' )
+
+        - the jobs can be placed preferentially at the hosts with the local
+        replicas (or warm caches) of the input files (``affinity'' argument),
+        the idle hosts steal the jobs from other hosts, see AffinityScheduler 
+
+        >>> result = wm.process ( my_task , chains , affinity = { '/eos/lhcb/data1/' : 'node1' } )
+        >>> result = wm.process ( my_task , chains , affinity = lambda fname : ... )
+
+        - the long runs can be checkpointed (``checkpoint'' argument):
+        the merged partial results and the completed items are periodically saved,
+        and the next run with the same checkpoint resumes the processing,
+        see ostap.parallel.checkpoint
+
+        >>> result = wm.process ( my_task , items , checkpoint = 'my_run.zip' , checkpoint_period = 600 )
+
+        - the memory budget per node (in MB) for the C++ multithreaded engines 
+        (``memory_budget'' argument) is shared equally between the workers:
+        the per-thread buffers, histogram clones and the prefetch depth are 
+        adjusted to fit it, see ostap.utils.memory.set_memory_budget
+
+        >>> result = wm.process ( my_task , items , memory_budget = 16000 )
         """
+
+        ## timeline of the jobs 
+        from ostap.parallel.timeline import make_timeline 
+        timeline  = make_timeline ( kwargs.pop ( 'timeline' , None ) )
+        kwargs [ 'timeline' ] = timeline
+        trace     = timeline.cpp and isinstance ( task , Task ) and not task.trace 
+        if trace : task.trace = True 
         
         job_chunk = kwargs.pop ( 'chunk_size', 10000 )
         if job_chunk <= 0 : job_chunk = 10000
 
-        from ostap.utils.utils import chunked 
-        chunks    = list ( chunked ( args , job_chunk ) )
+        ## transport of results via shared memory for local workers 
+        shared    = kwargs.pop ( 'shared' , None )
+        if shared is None : shared = self.local_workers 
 
-        if isinstance ( task , Task ) :
-            result = self.__process_task ( task , chunks , **kwargs )
-        else : 
-            result = self.__process_func ( task , chunks , **kwargs )
+        ## the memory budget per worker for the C++ multithreaded engines
+        budget    = kwargs.pop ( 'memory_budget' , self.memory_budget )
+        memory    = budget and isinstance ( task , Task ) and not 'OSTAP_MEMORY_BUDGET' in task.environment 
+        if memory : 
+            task.environment = { 'OSTAP_MEMORY_BUDGET' : '%.1f' % ( budget / float ( max ( 1 , self.ncpus ) ) ) }
         
+        try : 
+            return self.__process ( task , args , shared , job_chunk , **kwargs )
+        finally :
+            if trace  : task.trace = False
+            if memory : task.environment.pop ( 'OSTAP_MEMORY_BUDGET' , None ) 
+            timeline.write ()
+
+    # ===================================================================================
+    ## Helper internal method for parallel processing 
+    def __process ( self , task , args , shared , job_chunk , **kwargs ) :
+        """Helper internal method for parallel processing 
+        """
+        from ostap.parallel.shared import SharedStore, inherited_inputs
+        from ostap.utils.utils     import NoContext 
+        with ( SharedStore () if shared else NoContext () ) as store , \
+                 inherited_inputs ( self.fork_generation ) :
+            
+            kwargs [ 'store' ] = store if shared else None 
+
+            ## checkpointing and incremental resume 
+            checkpoint = kwargs.pop ( 'checkpoint' , None )
+            if checkpoint :
+                for key in ( 'affinity' , 'dynamic' , 'merge_group' ) : kwargs.pop ( key , None ) 
+                return self.__process_checkpoint ( task , args , checkpoint , **kwargs )
+                
+            ## data-locality aware placement of jobs 
+            affinity  = kwargs.pop ( 'affinity' , None )
+            if affinity is not None :
+                slots = self.host_slots () 
+                if slots : return self.__process_affinity ( task , args , affinity , slots , **kwargs )
+                logger.debug ( "No host-specific pools, ``affinity'' is ignored" )
+            
+            ## dynamic scheduling for the splittable Chain/Tree items 
+            dynamic   = kwargs.pop ( 'dynamic' , False )
+            if dynamic and isinstance ( task , Task ) :
+                from ostap.trees.trees import Chain
+                if all ( isinstance ( a , Chain ) for a in args ) : 
+                    return self.__process_dynamic ( task , args , **kwargs )
+            
+            from ostap.utils.utils import chunked 
+            chunks    = list ( chunked ( args , job_chunk ) )
+            
+            if isinstance ( task , Task ) :
+                result = self.__process_task ( task , chunks , **kwargs )
+            else : 
+                result = self.__process_func ( task , chunks , **kwargs )
+                
         return result 
 
     # ===================================================================================
@@ -889,6 +1492,11 @@ class TaskManager(object) :
         init      = my_args.pop ( 'init'      , None )
         merger    = my_args.pop ( 'merger'    , None )
         collector = my_args.pop ( 'collector' , None )
+        store     = my_args.pop ( 'store'     , None )
+        timeline  = my_args.pop ( 'timeline'  , None )
+
+        from ostap.parallel.shared import from_shared
+        executor  = store.wrap ( func_executor ) if store else func_executor 
         
         ## mergers for statistics & results
         if   not merger and not collector :
@@ -918,15 +1526,19 @@ class TaskManager(object) :
                 jobs_args = zip ( repeat ( task ) , count ( index ) , chunk )
 
                 ## call for the actual jobs handling method 
-                for jobid , result , stat in self.iexecute ( func_executor    ,
+                for jobid , result , stat in self.iexecute ( executor         ,
                                                              jobs_args        ,
                                                              progress = False ) :
                     
                     merged_stat += stat
+                    timeline.job ( jobid , stat ) 
+                    with timeline.local ( 'load' , jobid = jobid ) : 
+                        result   = from_shared ( result ) 
                     
                     ## merge results if merger or collector are provided 
-                    if   merger    : results = merger    ( results , result ) 
-                    elif collector : results = collector ( results , result , jobid )
+                    with timeline.local ( 'merge' , jobid = jobid ) : 
+                        if   merger    : results = merger    ( results , result ) 
+                        elif collector : results = collector ( results , result , jobid )
                     
                     bar += 1 
 
@@ -961,28 +1573,241 @@ class TaskManager(object) :
 
         ## total number of jobs 
         njobs = sum  ( len ( c ) for c in chunks ) 
+
+        ## group the items and merge them at remote host:
+        #  keep at least 8 jobs per CPU for load balancing
+        group = kwargs.pop ( 'merge_group' , None )
+        if group is None : group = njobs // ( 8 * max  ( 1 , self.ncpus ) )
+        group = max ( 1 , group ) if task.mergeable else 1 
+
+        store    = kwargs.pop ( 'store'    , None )
+        timeline = kwargs.pop ( 'timeline' , None )
+        from ostap.parallel.shared import from_shared
+        
         from ostap.utils.progress_bar import ProgressBar
+        from ostap.utils.utils        import chunked 
         with ProgressBar ( max_value = njobs , silent = not self.progress ) as bar :
 
             while chunks :
 
                 chunk = chunks.pop ( 0 ) 
+
+                if 1 < group :
+                    groups    = [ [ ( item , ) for item in g ] for g in chunked ( chunk , group ) ] 
+                    sizes     = [ len ( g ) for g in groups ] 
+                    jobs_args = zip ( repeat ( task ) , count ( index ) , groups )
+                    executor  = group_executor
+                else : 
+                    sizes     = len ( chunk ) * [ 1 ]  
+                    jobs_args = zip ( repeat ( task ) , count ( index ) , chunk )
+                    executor  = task_executor 
+
+                if store : executor = store.wrap ( executor )
                 
-                jobs_args = zip ( repeat ( task ) , count ( index ) , chunk )
-                
-                for jobid , result , stat in self.iexecute ( task_executor    ,
+                for jobid , result , stat in self.iexecute ( executor         ,
                                                              jobs_args        ,
                                                              progress = False ) :
 
                     ## merge statistics 
                     merged_stat += stat
+                    timeline.job ( jobid , stat ) 
+                    with timeline.local ( 'load' , jobid = jobid ) : 
+                        result   = from_shared ( result ) 
+
+                    ## merge/collect resuls
+                    with timeline.local ( 'merge' , jobid = jobid ) : 
+                        task.merge_results ( result , jobid )
+
+                    bar += sizes [ jobid - index ] 
+
+                index           += len ( sizes )
+                
+                pp_stat = self.get_pp_stat() 
+                if pp_stat : merged_stat_pp  += pp_stat 
+
+        ## finalize the task 
+        task.finalize () 
+        self.print_statistics ( merged_stat_pp , merged_stat , _timer() - start )
+        ## 
+        return task.results ()
+    
+    # ===================================================================================
+    ## helper internal method to process the task or callable object
+    #  with the periodic checkpoints and the incremental resume
+    #  - the partial results are merged in the same format as for <code>group_executor</code>
+    #  - the items are identified by their positions, the job identifiers
+    #    are the same as for the uninterrupted run 
+    #  @see Checkpoint 
+    def __process_checkpoint ( self , task , items , checkpoint , **kwargs ) :
+        """Helper internal method to process the task or callable object
+        with the periodic checkpoints and the incremental resume
+        - the partial results are merged in the same format as for `group_executor`
+        - the items are identified by their positions, the job identifiers
+          are the same as for the uninterrupted run
+        - see Checkpoint 
+        """
+        from timeit import  default_timer as _timer
+        start = _timer()
+
+        from ostap.utils.cidict import cidict
+        my_args   = cidict( kwargs )
+        
+        items     = list ( items )
+        is_task   = isinstance ( task , Task )
+        
+        from ostap.parallel.checkpoint import Checkpoint
+        period    = my_args.pop ( 'checkpoint_period' , 300 )
+        ckpt      = Checkpoint ( checkpoint                                   ,
+                                 signature = ( type ( task ).__name__ , len ( items ) ) ,
+                                 period    = period                           )
+        done , saved = ckpt.load () 
+        if done and not self.silent :
+            logger.info ( 'Checkpoint: resume from %s, %d of %d items are processed' % ( ckpt.filename , len ( done ) , len ( items ) ) )
+
+        init      = my_args.pop ( 'init'      , None )
+        merger    = my_args.pop ( 'merger'    , None )
+        collector = my_args.pop ( 'collector' , None )
+        store     = my_args.pop ( 'store'     , None )
+        timeline  = my_args.pop ( 'timeline'  , None )
+
+        if is_task :
+            task.initialize_local ()
+            if done : task.merge_results ( saved , -1 )
+            executor = task_executor 
+        else :
+            results  = saved if done else init 
+            executor = func_executor 
+            
+        if store : executor = store.wrap ( executor )
+        from ostap.parallel.shared import from_shared
+        
+        ## the current partial results 
+        current = lambda : task.results () if is_task else results
+            
+        ## mergers for statistics 
+        merged_stat    = StatMerger ()
+        merged_stat_pp = StatMerger ()
+
+        pending   = [ ( jobid , item ) for jobid , item in enumerate ( items ) if not jobid in done ]
+        jobs_args = [ ( task , jobid , item ) for jobid , item in pending ]
+        
+        from ostap.utils.progress_bar import ProgressBar
+        with ProgressBar ( max_value = len ( items ) , silent = not self.progress ) as bar :
+            
+            bar += len ( done )
+            
+            try :
+                
+                for jobid , result , stat in self.iexecute ( executor         ,
+                                                             jobs_args        ,
+                                                             progress = False ) :
+                    ## merge statistics 
+                    merged_stat += stat
+                    timeline.job ( jobid , stat ) 
+                    with timeline.local ( 'load' , jobid = jobid ) : 
+                        result   = from_shared ( result ) 
 
                     ## merge/collect resuls
-                    task.merge_results ( result , jobid )
+                    with timeline.local ( 'merge' , jobid = jobid ) :
+                        if   is_task   : task.merge_results ( result , jobid )
+                        elif merger    : results = merger    ( results , result ) 
+                        elif collector : results = collector ( results , result , jobid )
 
+                    done.add ( jobid ) 
+                    if ckpt.due () : ckpt.save ( done , current () ) 
+                    
                     bar += 1 
+                    
+            except BaseException :
+                ## save the last state and re-raise 
+                if done : ckpt.save ( done , current () )
+                if not self.silent : 
+                    logger.warning ( 'Checkpoint: processing is interrupted, %d of %d items are saved to %s' % ( len ( done ) , len ( items ) , ckpt.filename ) )
+                raise
+            
+        pp_stat = self.get_pp_stat() 
+        if pp_stat : merged_stat_pp  += pp_stat 
 
-                index           += len ( chunk )
+        ## everything is processed
+        ckpt.remove ()
+        
+        ## finalize the task 
+        if is_task : task.finalize () 
+        self.print_statistics ( merged_stat_pp , merged_stat , _timer() - start )
+        ## 
+        return current () 
+    
+    # ===================================================================================
+    ## helper internal method to process the task with Chain/Tree items
+    #  using the dynamic scheduling 
+    #  @see WaveScheduler 
+    def __process_dynamic ( self , task , items , **kwargs ) :
+        """Helper internal method to process the task with Chain/Tree items
+        using the dynamic scheduling
+        - see WaveScheduler 
+        """
+        
+        from timeit import  default_timer as _timer
+        start = _timer()
+
+        ## inialize the task
+        task.initialize_local ()
+        
+        ## mergers for statistics 
+        merged_stat    = StatMerger ()
+        merged_stat_pp = StatMerger ()
+        
+        scheduler = WaveScheduler ( items        ,
+                                    self.ncpus   ,
+                                    split_chain  ,
+                                    min_entries = kwargs.pop ( 'min_entries' , 1000 ) ,
+                                    min_time    = kwargs.pop ( 'min_time'    , 1.0  ) )
+
+        store    = kwargs.pop ( 'store'    , None )
+        timeline = kwargs.pop ( 'timeline' , None )
+        from ostap.parallel.shared import from_shared
+        
+        ## start index for jobs
+        index = 0 
+        
+        from ostap.utils.progress_bar import ProgressBar
+        with ProgressBar ( max_value = scheduler.total , silent = not self.progress ) as bar :
+            
+            while scheduler :
+                
+                wave      = scheduler.wave ()
+                ## group the small jobs and merge them at remote host
+                if task.mergeable : 
+                    wave     = group_items ( wave , scheduler.job_size_last ) 
+                    executor = group_executor
+                else :
+                    executor = task_executor
+                if store : executor = store.wrap ( executor ) 
+                    
+                sizes     = [ n for n , item in wave ]
+                jobs_args = zip ( repeat ( task ) , count ( index ) , ( item for n , item in wave ) )
+                
+                for jobid , result , stat in self.iexecute ( executor         ,
+                                                             jobs_args        ,
+                                                             progress = False ) :
+                    
+                    ## merge statistics 
+                    merged_stat += stat
+                    timeline.job ( jobid , stat ) 
+                    with timeline.local ( 'load' , jobid = jobid ) : 
+                        result   = from_shared ( result ) 
+                    
+                    ## merge/collect resuls
+                    with timeline.local ( 'merge' , jobid = jobid ) : 
+                        task.merge_results ( result , jobid )
+
+                    ## update the observed cost 
+                    n = sizes [ jobid - index ] 
+                    scheduler.update ( n , stat.time ) 
+                    
+                    bar += n 
+                    
+                index += len ( wave )
                 
                 pp_stat = self.get_pp_stat() 
                 if pp_stat : merged_stat_pp  += pp_stat 
@@ -993,6 +1818,91 @@ class TaskManager(object) :
         ## 
         return task.results ()
     
+    # ===================================================================================
+    ## helper internal method to process the jobs at the data-local hosts 
+    #  @see AffinityScheduler 
+    def __process_affinity ( self , task , items , affinity , slots , **kwargs ) :
+        """Helper internal method to process the jobs at the data-local hosts 
+        - see AffinityScheduler 
+        """
+        from timeit import  default_timer as _timer
+        start = _timer()
+
+        from ostap.utils.cidict import cidict
+        my_args   = cidict ( kwargs )
+        store     = my_args.pop ( 'store'     , None )
+        timeline  = my_args.pop ( 'timeline'  , None )
+        results   = my_args.pop ( 'init'      , None )
+        merger    = my_args.pop ( 'merger'    , None )
+        collector = my_args.pop ( 'collector' , None )
+        
+        is_task   = isinstance ( task , Task )
+        if is_task : task.initialize_local ()
+        executor  = task_executor if is_task else func_executor
+        if store : executor = store.wrap ( executor ) 
+
+        items     = list ( items ) 
+        scheduler = AffinityScheduler ( items , [ h for h , n in slots ] , affinity )
+        
+        import threading
+        try    : import queue as Q
+        except ImportError : import Queue as Q
+        done = Q.Queue         ()
+        stop = threading.Event () 
+        
+        ## the worker: take the jobs for the given host and execute them there 
+        def worker ( host ) :
+            while not stop.is_set () :
+                job = scheduler.next ( host )
+                if job is None : return
+                index , item = job
+                try :
+                    done.put ( ( True  , self.host_execute ( host , executor , ( task , index , item ) ) ) )
+                except Exception as e :
+                    done.put ( ( False , e ) )
+                    return
+
+        threads = [ threading.Thread ( target = worker , args = ( h , ) )
+                    for h , n in slots for i in range ( max ( 1 , n ) ) ]
+        for t in threads :
+            t.daemon = True
+            t.start ()
+
+        from ostap.parallel.shared    import from_shared
+        from ostap.utils.progress_bar import ProgressBar
+        
+        merged_stat = StatMerger ()
+        error       = None 
+        with ProgressBar ( max_value = len ( items ) , silent = not self.progress ) as bar :
+            for i in range ( len ( items ) ) :
+                ok , r = done.get ()
+                if not ok :
+                    error = r
+                    break
+                jobid , result , stat = r
+                merged_stat += stat
+                timeline.job ( jobid , stat ) 
+                with timeline.local ( 'load' , jobid = jobid ) : 
+                    result   = from_shared ( result ) 
+                with timeline.local ( 'merge' , jobid = jobid ) : 
+                    if   is_task   : task.merge_results ( result , jobid )
+                    elif merger    : results = merger    ( results , result ) 
+                    elif collector : results = collector ( results , result , jobid )
+                bar += 1 
+
+        stop.set () 
+        for t in threads : t.join ()
+        if error is not None : raise error
+        
+        if not self.silent :
+            logger.info ( 'Data-locality: %d local, %d stolen and %d other jobs' % ( scheduler.local  ,
+                                                                                    scheduler.stolen ,
+                                                                                    scheduler.other  ) )
+        if is_task : task.finalize () 
+        self.print_statistics ( StatMerger () , merged_stat , _timer() - start )
+        ## 
+        return task.results () if is_task else results 
+    
     @property
     def silent ( self ) :
         """``silent'' : silent processing?"""
@@ -1008,6 +1918,52 @@ class TaskManager(object) :
         """``ncpus'' : number of CPUs"""
         return self.__ncpus
 
+    @property
+    def memory_budget ( self ) :
+        """``memory_budget'' : the memory budget per node (in MB) for the C++ multithreaded engines
+        - it is shared equally between the workers 
+        - see ostap.utils.memory.set_memory_budget 
+        """
+        return self.__memory_budget
+
+    @property
+    def local_workers ( self ) :
+        """``local_workers'' : are all workers local (same host)?
+        - the results can be transferred via shared memory
+        """
+        return False 
+
+    @property
+    def fork_generation ( self ) :
+        """``fork_generation'' : the generation of the registry of shared inputs,
+        inherited by the forked local workers (None: workers are not forked)
+        - the inherited inputs are transferred to the workers as bare keys
+        - see ostap.parallel.shared.share_input 
+        """
+        return None 
+
+    # ===========================================================================
+    ## get the list of hosts with their numbers of slots, <code>[ ( host , slots ) ]</code>,
+    #  for the host-specific placement of the jobs 
+    #  - empty list: the placement of the jobs is not supported 
+    #  @see TaskManager.host_execute
+    def host_slots ( self ) :
+        """Get the list of hosts with their numbers of slots, `[ ( host , slots ) ]`,
+        for the host-specific placement of the jobs 
+        - empty list: the placement of the jobs is not supported 
+        - see TaskManager.host_execute
+        """
+        return ()
+
+    # ===========================================================================
+    ## execute the job at the given host (blocking call)
+    #  @see TaskManager.host_slots 
+    def host_execute ( self , host , job , job_args ) :
+        """Execute the job at the given host (blocking call)
+        - see TaskManager.host_slots 
+        """
+        raise NotImplementedError ( "Host-specific execution is not supported by %s" % type ( self ).__name__ )
+    
     # ===========================================================================
     ## get PP-statistics if/when posssible  
     @abc.abstractmethod
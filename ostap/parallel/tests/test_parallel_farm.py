@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developers.
+# ============================================================================= 
+# @file test_parallel_farm.py
+# Test module for ostap/parallel/parallel_farm.py
+# - fit the same model in many bins 
+# ============================================================================= 
+""" Test module for ostap/parallel/parallel_farm.py
+- fit the same model in many bins 
+"""
+# ============================================================================= 
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# ============================================================================= 
+import ROOT, random
+import ostap.fitting.roofit 
+import ostap.fitting.models         as     Models 
+from   ostap.core.core              import VE, dsID, hID 
+from   ostap.parallel.parallel_farm import split_bins, fit_farm, farm_histo 
+from   ostap.utils.timing           import timing 
+# =============================================================================
+# logging 
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ : 
+    logger = getLogger ( 'test_parallel_farm' )
+else : 
+    logger = getLogger ( __name__ )
+# =============================================================================
+mass = ROOT.RooRealVar ( 'test_mass_farm' , 'Some test mass' , 2.5 , 3.5 )
+pt   = ROOT.RooRealVar ( 'test_pt_farm'   , 'Some test pt'   , 0   , 10  )
+eta  = ROOT.RooRealVar ( 'test_eta_farm'  , 'Some test eta'  , 2   , 5   )
+mmin , mmax = mass.minmax()
+
+varset  = ROOT.RooArgSet  ( mass , pt , eta )
+dataset = ROOT.RooDataSet ( dsID () , 'Test data' , varset )
+
+binning = ROOT.TH2D ( hID () , '' , 4 , 0 , 10 , 3 , 2 , 5 )
+
+NS = 200
+NB = 400
+for ix in range ( 1 , 5 ) :
+    for iy in range ( 1 , 4 ) :
+        x0 , x1 = binning.GetXaxis().GetBinLowEdge ( ix ) , binning.GetXaxis().GetBinUpEdge ( ix )
+        y0 , y1 = binning.GetYaxis().GetBinLowEdge ( iy ) , binning.GetYaxis().GetBinUpEdge ( iy )
+        m0      = VE ( 3.100 , ( 0.010 + 0.002 * ix ) ** 2 ) 
+        for i in range ( NS * ix ) :
+            mass.setVal ( m0.gauss () )
+            pt  .setVal ( random.uniform ( x0 , x1 ) )
+            eta .setVal ( random.uniform ( y0 , y1 ) )
+            dataset.add ( varset )
+        for i in range ( NB ) :
+            mass.setVal ( random.uniform ( mmin , mmax ) )
+            pt  .setVal ( random.uniform ( x0 , x1 ) )
+            eta .setVal ( random.uniform ( y0 , y1 ) )
+            dataset.add ( varset )
+
+signal = Models.Gauss_pdf ( 'GF' , xvar = mass , mean = ( 3.1 , 3.0 , 3.2 ) , sigma = ( 0.015 , 0.005 , 0.05 ) )
+model  = Models.Fit1D     ( signal = signal , background = 'e-' , suffix = '_farm' )
+
+# =============================================================================
+## split the dataset into bins in single pass 
+def test_parallel_farm_split () :
+    """Split the dataset into bins in single pass
+    """
+    logger = getLogger ( 'test_parallel_farm_split' )
+    
+    with timing ( 'Split' , logger = logger ) : 
+        bins = split_bins ( dataset , binning , pt , eta )
+        
+    assert len ( bins ) == 12 , 'Invalid number of bins!'
+    assert sum ( len ( ds ) for ds in bins.values () ) == len ( dataset ) , 'Entries are lost!'
+    
+    for ( ix , iy ) , ds in bins.items () :
+        assert len ( ds ) == NS * ix + NB , 'Invalid number of entries in bin (%d,%d)' % ( ix , iy ) 
+        
+# =============================================================================
+## fit the model in all bins 
+def test_parallel_farm_fit () :
+    """Fit the model in all bins
+    """
+    logger = getLogger ( 'test_parallel_farm_fit' )
+    
+    with timing ( 'Fit farm' , logger = logger ) : 
+        table = fit_farm ( model , dataset , binning , pt , eta , nsplit = 4 )
+
+    assert len ( table ) == 12 , 'Invalid number of results!'
+    for ( ix , iy ) , ( status , params ) in table.items () :
+        S = params [ 'S' ]
+        logger.info ( 'Bin (%d,%d) status %s S=%s' % ( ix , iy , status , S ) ) 
+        assert 0 == status , 'Fit failed in bin (%d,%d)' % ( ix , iy ) 
+        assert abs ( S.value () - NS * ix ) < 5 * S.error () , \
+               'Invalid signal in bin (%d,%d) : %s' % ( ix , iy , S )
+        
+    hS = farm_histo ( table , binning , 'S' )
+    assert abs ( hS.GetBinContent ( 2 , 2 ) - table [ ( 2 , 2 ) ] [ 1 ] [ 'S' ].value () ) < 1.e-6 , \
+           'Invalid content of the histogram!'
+    
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_parallel_farm_split ()
+    test_parallel_farm_fit   ()
+    
+# =============================================================================
+##                                                                      The END
+# =============================================================================
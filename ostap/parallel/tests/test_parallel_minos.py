@@ -0,0 +1,124 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developers.
+# ============================================================================= 
+# @file test_parallel_minos.py
+# Test module for ostap/parallel/parallel_minos.py
+# - parallel MINOS errors and 2D-contours 
+# ============================================================================= 
+""" Test module for ostap/parallel/parallel_minos.py
+- parallel MINOS errors and 2D-contours 
+"""
+# ============================================================================= 
+__author__ = "Ostap developers"
+__all__    = () ## nothing to import
+# ============================================================================= 
+import ROOT, random
+import ostap.fitting.roofit 
+import ostap.fitting.models          as     Models 
+from   ostap.core.core               import VE, dsID
+from   ostap.parallel.parallel_minos import parallel_minos, parallel_contours 
+from   ostap.utils.timing            import timing 
+# =============================================================================
+# logging 
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__' == __name__ : 
+    logger = getLogger ( 'test_parallel_minos' )
+else : 
+    logger = getLogger ( __name__ )
+# =============================================================================
+mass = ROOT.RooRealVar ( 'test_mass_minos' , 'Some test mass' , 2.5 , 3.5 )
+mmin , mmax = mass.minmax()
+
+m0   = VE ( 3.100 , 0.015**2 )
+NS   = 500
+NB   = 1000
+
+varset  = ROOT.RooArgSet  ( mass )
+dataset = ROOT.RooDataSet ( dsID () , 'Test data' , varset )
+for i in range ( NS ) :
+    mass.setVal ( m0.gauss () )
+    dataset.add ( varset )
+for i in range ( NB ) :
+    mass.setVal ( random.uniform ( mmin , mmax ) )
+    dataset.add ( varset )
+
+signal = Models.Gauss_pdf ( 'GM' , xvar = mass , mean = ( 3.1 , 3.0 , 3.2 ) , sigma = ( 0.015 , 0.005 , 0.05 ) )
+model  = Models.Fit1D     ( signal = signal , background = 'e-' , suffix = '_minos' )
+
+# =============================================================================
+## parallel MINOS vs sequential MINOS 
+def test_parallel_minos () :
+    """Parallel MINOS vs sequential MINOS
+    """
+    
+    logger = getLogger ( 'test_parallel_minos' )
+
+    model.S = NS
+    model.B = NB
+    result , _ = model.fitTo ( dataset , silent = True )
+    
+    params = 'S' , 'B' , signal.mean.name , signal.sigma.name 
+    
+    ## sequential MINOS 
+    with timing ( 'Sequential MINOS' , logger = logger ) : 
+        mn = model.minuit ( dataset , silent = True )
+        mn.migrad ( tag = 'test_minos' )
+        for p in params : mn.minos ( p )
+        r1 = mn.save ()
+        
+    ## parallel MINOS
+    model.load_params ( result , dataset , silent = True )
+    with timing ( 'Parallel   MINOS' , logger = logger ) : 
+        r2 = parallel_minos ( model , dataset , result.Clone () , params )
+        
+    for p in params :
+        p1 = r1.floatParsFinal().find ( p )
+        p2 = r2.floatParsFinal().find ( p )
+        lo1 , hi1 = p1.getAsymErrorLo () , p1.getAsymErrorHi ()
+        lo2 , hi2 = p2.getAsymErrorLo () , p2.getAsymErrorHi ()
+        logger.info ( 'MINOS %-16s sequential: (%+.4g,%+.4g) parallel: (%+.4g,%+.4g)' % ( p , lo1 , hi1 , lo2 , hi2 ) )
+        assert abs ( lo1 - lo2 ) <= 0.02 * abs ( lo1 ) and abs ( hi1 - hi2 ) <= 0.02 * abs ( hi1 ) , \
+               'MINOS errors are different for %s' % p 
+
+# =============================================================================
+## parallel 2D-contours 
+def test_parallel_contours () :
+    """Parallel 2D-contours
+    """
+    
+    logger = getLogger ( 'test_parallel_contours' )
+
+    model.S = NS
+    model.B = NB
+    result , _ = model.fitTo ( dataset , silent = True )
+
+    with timing ( 'Parallel contours' , logger = logger ) : 
+        frame = parallel_contours ( model , 'S' , 'B' , dataset , result ,
+                                    levels = ( 1 , 2 ) , npoints = 40 , nsplit = 4 )
+        
+    S = result.S.value () 
+    B = result.B.value () 
+    sS , sB = result.S.error () , result.B.error () 
+    
+    ## 1-sigma contour must be (roughly) within the +-1.2 sigma box  
+    for i in range ( int ( frame.numItems () ) ) :
+        obj = frame.getObject ( i )
+        if isinstance ( obj , ROOT.TGraph ) and obj.GetN () == 41 :
+            for j in range ( obj.GetN () ) :
+                x , y = obj.GetPointX ( j ) , obj.GetPointY ( j )
+                assert abs ( x - S ) < 2.5 * sS and abs ( y - B ) < 2.5 * sB , \
+                       'Contour point is too far (%s,%s)' % ( x , y ) 
+            break 
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_parallel_minos    ()
+    test_parallel_contours ()
+    
+# =============================================================================
+##                                                                      The END
+# =============================================================================
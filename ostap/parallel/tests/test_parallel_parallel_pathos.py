@@ -365,6 +365,36 @@ def test_parallel_pathos_pp_generic ( ) :
     return result
 
 
+# =============================================================================
+## test parallel processing with parallel_pathos (persistent pool)
+def test_parallel_pathos_mp_persistent ( ) :
+    """Test parallel processnig with parallel_pathos (persistent pool)
+    """
+    logger  = getLogger ("ostap.test_parallel_pathos_mp_persistent")
+    if not WorkManager :
+        logger.error ("Failure to import WorkManager")
+        return
+    
+    if DILL_PY3_issue : 
+        logger.warning ("test is disabled (DILL/ROOT/PY3 issue)" )
+        return
+
+    ## the same (warm) pool is reused by the managers 
+    manager1 = WorkManager ( silent = False , persistent = True )
+    result1  = manager1.process ( make_histo , inputs , merger = merge_histos )
+    
+    manager2 = WorkManager ( silent = False , persistent = True )
+    result2  = manager2.process ( make_histo , inputs , merger = merge_histos )
+
+    assert manager1.pool is manager2.pool , 'Persistent pool is not reused!'
+    
+    logger.info ( "Entries  %s/%s" % ( result1.GetEntries() , sum ( inputs ) ) ) 
+    logger.info ( "Entries  %s/%s" % ( result2.GetEntries() , sum ( inputs ) ) ) 
+
+    from ostap.parallel.parallel_pathos import close_pools
+    close_pools ()
+    
+    return result2
 
 
 # =============================================================================
@@ -385,6 +415,9 @@ if '__main__' == __name__ :
     ## use generic task 
     test_parallel_pathos_mp_generic ()
     test_parallel_pathos_pp_generic ()
+
+    ## persistent pool  
+    test_parallel_pathos_mp_persistent ()
             
 # =============================================================================
 ##                                                                      The END 
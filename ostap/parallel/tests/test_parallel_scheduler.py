@@ -0,0 +1,241 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+## @file ostap/parallel/tests/test_parallel_scheduler.py
+# Test module for the dynamic scheduler of sized/splittable items 
+# @see ostap.parallel.task.WaveScheduler
+# @see ostap.parallel.task.group_executor
+# @see ostap.parallel.task.AffinityScheduler
+# @see ostap.parallel.checkpoint
+# =============================================================================
+""" Test module for the dynamic scheduler of sized/splittable items 
+- see ostap.parallel.task.WaveScheduler
+- see ostap.parallel.task.group_executor
+- see ostap.parallel.task.AffinityScheduler
+- see ostap.parallel.checkpoint
+"""
+# =============================================================================
+import random, copy 
+from   ostap.parallel.task    import WaveScheduler, Task, task_executor, group_executor  
+from   ostap.parallel.task    import group_items, AffinityScheduler, TaskManager 
+# ============================================================================
+from   ostap.logger.logger    import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.test_parallel_scheduler' )
+else                       : logger = getLogger ( __name__                        )
+# ============================================================================
+
+# =============================================================================
+## simple splittable range of entries 
+class Range(object) :
+    def __init__ ( self , first , last ) :
+        self.first = first
+        self.last  = last
+    def __len__  ( self ) : return self.last - self.first 
+
+def split_range ( item , nparts ) :
+    n     = len ( item )
+    chunk = max ( 1 , ( n + nparts - 1 ) // nparts )
+    return [ Range ( i , min ( i + chunk , item.last ) ) for i in range ( item.first , item.last , chunk ) ]
+
+# =============================================================================
+## check that all entries are processed exactly once and the tail is made of small jobs 
+def test_scheduler () :
+    """Check that all entries are processed exactly once and the tail is made of small jobs
+    """
+
+    logger = getLogger ( 'test_scheduler' )
+
+    ## very different item sizes 
+    items = []
+    first = 0 
+    for i in range ( 20 ) :
+        n      = random.choice ( [ 100 , 5000 , 100000 , 2000000 ] )
+        items.append ( Range ( first , first + n ) )
+        first += n
+    total = first 
+
+    ncpus     = 16 
+    scheduler = WaveScheduler ( items , ncpus , split_range , min_entries = 1000 , min_time = 0.0 )
+    assert scheduler.total == total , 'Invalid total number of entries'
+
+    processed = []
+    waves     = [] 
+    while scheduler :
+        wave = scheduler.wave ()
+        assert wave , 'Empty wave!'
+        for n , item in wave :
+            assert n == len ( item ) , 'Invalid size of the job'
+            processed.append ( ( item.first , item.last ) )
+            scheduler.update ( n , 1.e-6 * n )
+        waves.append ( max ( n for n , item in wave ) )
+
+    processed.sort ()
+    assert processed [  0 ] [ 0 ] == 0     , 'Invalid first entry'
+    assert processed [ -1 ] [ 1 ] == total , 'Invalid last  entry'
+    for a , b in zip ( processed [ :-1 ] , processed [ 1: ] ) :
+        assert a [ 1 ] == b [ 0 ] , 'Gap/overlap in processed entries'
+
+    logger.info ( 'Waves: %d, the largest jobs: %s' % ( len ( waves ) , waves ) )
+    assert waves [ -1 ] < waves [ 0 ] , 'The tail jobs are not smaller!'
+
+# =============================================================================
+## simple mergeable task: sum of entries 
+class SumTask(Task) :
+    mergeable = True 
+    def __init__          ( self ) : self.__output = 0 
+    def initialize_local  ( self ) : self.__output = 0
+    def process           ( self , jobid , item ) :
+        self.__output = sum ( range ( item.first , item.last ) ) 
+        return self.__output 
+    def merge_results     ( self , result , jobid = -1 ) : self.__output += result 
+    def results           ( self ) : return self.__output 
+
+# =============================================================================
+## check the merge of results at the remote host 
+def test_group_executor () :
+    """Check the merge of results at the remote host
+    """
+    
+    logger = getLogger ( 'test_group_executor' )
+
+    items  = [ Range ( i * 1000 , ( i + 1 ) * 1000 ) for i in range ( 50 ) ]
+    groups = group_items ( [ ( len ( i ) , i ) for i in items ] , 7000 )
+    assert sum ( n for n , g in groups ) == 50000 , 'Invalid grouping!'
+
+    task = SumTask ()
+    task.initialize_local () 
+    for jobid , ( n , group ) in enumerate ( groups ) :
+        _ , result , stat = group_executor ( ( task , jobid , group ) )
+        task.merge_results ( result , jobid )
+
+    logger.info ( 'Merged %d items in %d groups' % ( len ( items ) , len ( groups ) ) )
+    assert task.results () == sum ( range ( 50000 ) ) , 'Invalid merged result!'
+
+# =============================================================================
+## the item with files 
+class Files(object) :
+    def __init__ ( self , *files ) : self.files = files 
+
+# =============================================================================
+## check the data-local placement and the work stealing 
+def test_affinity () :
+
+    affinity = { '/data/a/' : 'node1.cern.ch' , '/data/b/' : [ 'node2' , 'node1' ] }
+    items    = [ Files ( '/data/a/%d.root' % i ) for i in range ( 10 ) ] + \
+               [ Files ( '/data/b/%d.root' % i ) for i in range ( 4  ) ] + \
+               [ Files ( '/data/c/%d.root' % i ) for i in range ( 2  ) ]
+
+    scheduler = AffinityScheduler ( items , [ 'user@NODE1:6000' , 'node2.cern.ch' , 'node3' ] , affinity ) 
+    assert 16 == len ( scheduler ) , 'Invalid number of queued items!'
+
+    ## node3 has no local data: it takes the common items and then steals 
+    taken = [ scheduler.next ( 'node3' ) for i in range ( 3 ) ]
+    assert [ i for i , item in taken [ :2 ] ] == [ 14 , 15 ] , 'Common items are not taken first!'
+    assert taken [ 2 ] [ 0 ] == 9 , 'Item is not stolen from the longest queue!'
+    
+    ## node1 takes its own items 
+    assert all ( scheduler.next ( 'node1' ) [ 0 ] < 10 for i in range ( 9 ) ) , 'Non-local item!'
+    ## node2 takes its own items 
+    assert all ( 10 <= scheduler.next ( 'node2.cern.ch' ) [ 0 ] < 14 for i in range ( 4 ) ) , 'Non-local item!'
+
+    assert not scheduler , 'Scheduler is not empty!'
+    assert scheduler.next ( 'node1' ) is None , 'Scheduler is not empty!' 
+    logger.info ( 'Affinity: %d local, %d stolen and %d other jobs' % ( scheduler.local  ,
+                                                                       scheduler.stolen ,
+                                                                       scheduler.other  ) ) 
+    assert ( 13 , 1 , 2 ) == ( scheduler.local , scheduler.stolen , scheduler.other ) , 'Invalid statistics!'
+
+# =============================================================================
+## fake manager that executes the jobs in threads for the named hosts 
+class HostManager(TaskManager) :
+    def __init__ ( self , hosts ) :
+        TaskManager.__init__ ( self , ncpus = len ( hosts ) , silent = True , progress = False )
+        self.hosts = hosts 
+    def host_slots   ( self ) : return tuple ( ( h , 2 ) for h in self.hosts ) 
+    def host_execute ( self , host , job , job_args ) :
+        jobid , result , stat = job ( job_args )
+        return jobid , [ ( host , result ) ] , stat
+    def get_pp_stat  ( self ) : return None 
+    def iexecute     ( self , job , jobs_args , progress = False ) :
+        for a in jobs_args : yield job ( a ) 
+        
+def count_files ( jobid , item ) : return len ( item.files ) 
+
+# =============================================================================
+## check the processing with the data-local placement 
+def test_affinity_process () :
+
+    affinity = { '/data/a/' : 'node1' , '/data/b/' : 'node2' }
+    items    = [ Files ( '/data/a/%d.root' % i ) for i in range ( 20 ) ] + \
+               [ Files ( '/data/b/%d.root' % i ) for i in range ( 20 ) ]
+    
+    manager  = HostManager ( [ 'node1' , 'node2' ] )
+    result   = manager.process ( count_files , items , affinity = affinity ,
+                                 merger = lambda a , b : a + b , init = [] , shared = False )
+    assert 40 == len ( result ) , 'Not all items are processed!'
+    assert 40 == sum ( n for h , n in result ) , 'Invalid result!'
+    
+# =============================================================================
+## fake manager that executes the jobs in the current process and
+#  is interrupted after <code>nmax</code> jobs 
+class FailingManager(TaskManager) :
+    def __init__ ( self , nmax = -1 ) :
+        TaskManager.__init__ ( self , ncpus = 1 , silent = True , progress = False )
+        self.nmax  = nmax
+        self.jobs  = []
+    def get_pp_stat  ( self ) : return None 
+    def iexecute     ( self , job , jobs_args , progress = False ) :
+        for a in jobs_args :
+            if 0 <= self.nmax <= len ( self.jobs ) : raise KeyboardInterrupt ( 'Interrupted!' ) 
+            self.jobs.append ( a [ 1 ] )
+            ## the remote copy of the task 
+            yield job ( ( copy.deepcopy ( a [ 0 ] ) , ) + tuple ( a [ 1: ] ) ) 
+
+# =============================================================================
+## check the checkpointing and the incremental resume 
+def test_checkpoint () :
+    """Check the checkpointing and the incremental resume
+    """
+    import os 
+    import ostap.utils.cleanup as CU
+    
+    logger = getLogger ( 'test_checkpoint' )
+
+    items  = [ Range ( i * 1000 , ( i + 1 ) * 1000 ) for i in range ( 30 ) ]
+    
+    for n , task in enumerate ( ( SumTask () , lambda jobid , item : sum ( range ( item.first , item.last ) ) ) ) :
+        
+        checkpoint = CU.CleanUp.tempfile ( suffix = '.zip' )
+        config     = dict ( checkpoint = checkpoint , checkpoint_period = 0 , shared = False )
+        if 1 == n : config.update ( merger = lambda a , b : a + b , init = 0 )
+        
+        manager    = FailingManager ( nmax = 12 )
+        try :
+            manager.process ( task , items , **config )
+            assert False , 'The processing is not interrupted!'
+        except KeyboardInterrupt :
+            pass
+        assert os.path.exists ( checkpoint ) , 'Checkpoint is not saved!'
+        
+        manager    = FailingManager ()
+        result     = manager.process ( task , items , **config )
+        
+        logger.info ( 'Resumed: %d jobs, %s' % ( len ( manager.jobs ) , manager.jobs [ :3 ] ) )
+        assert manager.jobs == list ( range ( 12 , 30 ) ) , 'Processed items are not skipped!'
+        assert result == sum ( range ( 30000 ) ) , 'Invalid merged result!'
+        assert not os.path.exists ( checkpoint ) , 'Checkpoint is not removed!'
+        
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_scheduler        ()
+    test_group_executor   ()
+    test_affinity         ()
+    test_affinity_process ()
+    test_checkpoint       ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -0,0 +1,114 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# Copyright (c) Ostap developpers.
+# =============================================================================
+## @file ostap/parallel/tests/test_parallel_shared.py
+# Test module for the transport of results via shared memory 
+# @see ostap.parallel.shared
+# =============================================================================
+""" Test module for the transport of results via shared memory 
+- see ostap.parallel.shared
+"""
+# =============================================================================
+import os, pickle  
+from   ostap.parallel.shared  import ( SharedStore , SharedResult , from_shared ,
+                                       SharedInput , SharedAttribute , share_input , 
+                                       inherited_inputs , inputs_generation ) 
+# ============================================================================
+from   ostap.logger.logger    import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.test_parallel_shared' )
+else                       : logger = getLogger ( __name__                     )
+# ============================================================================
+
+## simple executor with large result 
+def large_executor ( item ) :
+    return item , { 'data' : list ( range ( item ) ) } , None 
+
+# =============================================================================
+## check the transport of small and large results 
+def test_shared () :
+    """Check the transport of small and large results
+    """
+    logger = getLogger ( 'test_shared' )
+
+    with SharedStore () as store :
+
+        directory = store.directory 
+        executor  = store.wrap ( large_executor )
+
+        ## small result is sent directly 
+        jobid , result , stat = executor ( 10 )
+        assert not isinstance ( result , SharedResult ) , 'Small result is not sent directly!'
+        assert result [ 'data' ] == list ( range ( 10 ) ) , 'Invalid small result!'
+
+        ## large result is sent via shared memory 
+        jobid , result , stat = executor ( 100000 )
+        assert isinstance ( result , SharedResult ) , 'Large result is not sent via shared memory!'
+        logger.info ( 'Handle: %s' % result )
+        result = from_shared ( result )
+        assert result [ 'data' ] == list ( range ( 100000 ) ) , 'Invalid large result!'
+        assert not os.listdir ( directory ) , 'Shared file is not removed!'
+
+    assert not os.path.exists ( directory ) , 'Shared directory is not removed!'
+
+# =============================================================================
+## simple task with the large read-only input 
+class LargeTask(object) :
+    data = SharedAttribute ( 'data' )
+    def __init__ ( self , data ) : self.data = data
+
+# =============================================================================
+## check the sharing of the large read-only inputs 
+def test_shared_inputs () :
+    """Check the sharing of the large read-only inputs
+    """
+    logger = getLogger ( 'test_shared_inputs' )
+
+    data = list ( range ( 100000 ) )
+    task = LargeTask ( data )
+    assert task.data is data , 'Invalid shared attribute!'
+    
+    ## the same object is registered only once
+    handle = share_input ( data )
+    assert handle.key == inputs_generation () , 'Invalid key of the shared input!'
+    
+    ## remote workers: the object is pickled 
+    full  = pickle.dumps ( task , pickle.HIGHEST_PROTOCOL )
+    
+    ## workers, forked before the registration: the object is pickled
+    with inherited_inputs ( handle.key - 1 ) :
+        older = pickle.dumps ( task , pickle.HIGHEST_PROTOCOL )
+        
+    ## workers, forked after the registration: only the key is pickled
+    with inherited_inputs ( inputs_generation () ) :
+        local = pickle.dumps ( task , pickle.HIGHEST_PROTOCOL )
+
+    logger.info ( 'Pickled size: full %d, older fork %d, inherited %d bytes' % ( len ( full  ) ,
+                                                                                 len ( older ) ,
+                                                                                 len ( local ) ) ) 
+    assert len ( local ) < 1000 < len ( older ) == len ( full ) , 'Inherited input is pickled!'
+
+    ## (forked) worker resolves the input via the inherited registry
+    assert pickle.loads ( local ).data == data , 'Invalid inherited input!'
+    assert pickle.loads ( full  ).data == data , 'Invalid pickled input!'
+
+    ## release the inputs: the key is not resolved anymore 
+    copy = pickle.loads ( local )
+    handle.release ()
+    del task
+    try :
+        copy.data
+        assert False , 'The input is not released!'
+    except AssertionError as e :
+        assert 'not inherited' in str ( e ) , 'The input is not released!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_shared        ()
+    test_shared_inputs ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -0,0 +1,245 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/parallel/timeline.py
+#  Event timeline of the <code>TaskManager</code> run in Chrome-trace format
+#  (can be inspected with <code>chrome://tracing</code> or https://ui.perfetto.dev)
+#
+#  For each job the timeline contains:
+#  - worker side: <code>initialize</code>, <code>process</code>,
+#    (remote) <code>merge</code> and <code>serialize</code> spans,
+#    the track is defined by the host and the process identifier of the worker
+#  - <code>transfer</code>: from the end of job to the reception of the result
+#    at the local host (it includes serialization, transport and queueing)
+#  - local side: <code>load</code> and <code>merge</code> of the results
+#  - optionally the C++ instrumentation counters for each job
+#    (see ostap.utils.instrument) are attached to <code>process</code> spans
+#
+#  @code
+#  wm = WorkManager ( ... )
+#  wm.process ( task , items , timeline = 'trace.json' )
+#  wm.process ( task , items , timeline = Timeline ( 'trace.json' , cpp = True ) )
+#  @endcode
+#  @attention the wall-clock timestamps are used, for remote hosts
+#             the timeline is affected by the clock skew
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Event timeline of the `TaskManager` run in Chrome-trace format
+(can be inspected with `chrome://tracing` or https://ui.perfetto.dev)
+
+For each job the timeline contains:
+- worker side: `initialize`, `process`, (remote) `merge` and `serialize` spans,
+  the track is defined by the host and the process identifier of the worker
+- `transfer`: from the end of job to the reception of the result
+  at the local host (it includes serialization, transport and queueing)
+- local side: `load` and `merge` of the results
+- optionally the C++ instrumentation counters for each job
+  (see ostap.utils.instrument) are attached to `process` spans
+
+>>> wm = WorkManager ( ... )
+>>> wm.process ( task , items , timeline = 'trace.json' )
+>>> wm.process ( task , items , timeline = Timeline ( 'trace.json' , cpp = True ) )
+
+- attention: the wall-clock timestamps are used, for remote hosts
+the timeline is affected by the clock skew
+"""
+# =============================================================================
+__author__  = 'Vanya BELYAEV Ivan.Belyaev@itep.ru'
+__date__    = '2026-10-15'
+__all__     = (
+    'Timeline'     , ## the timeline of TaskManager run
+    'NoTimeline'   , ## the dummy timeline
+    'make_timeline', ## create the timeline from the argument
+    )
+# =============================================================================
+import os, time, json
+from   ostap.logger.logger import getLogger
+if '__main__' == __name__ : logger = getLogger ( 'ostap.parallel.timeline' )
+else                      : logger = getLogger ( __name__                  )
+# =============================================================================
+## @class Span
+#  Helper context manager to record the local span
+class Span(object) :
+    """Helper context manager to record the local span
+    """
+    def __init__ ( self , timeline , name , args ) :
+        self.timeline = timeline
+        self.name     = name
+        self.args     = args
+    def __enter__ ( self ) :
+        self.start    = time.time ()
+        return self
+    def __exit__  ( self , *_ ) :
+        self.timeline.add ( self.name , self.start , time.time () , cat = 'local' , **self.args )
+
+# =============================================================================
+## @class Timeline
+#  Event timeline of the <code>TaskManager</code> run in Chrome-trace format
+#  @code
+#  timeline = Timeline ( 'trace.json' , cpp = True )
+#  wm.process ( task , items , timeline = timeline )
+#  @endcode
+class Timeline(object) :
+    """Event timeline of the `TaskManager` run in Chrome-trace format
+    >>> timeline = Timeline ( 'trace.json' , cpp = True )
+    >>> wm.process ( task , items , timeline = timeline )
+    """
+    def __init__ ( self , output = '' , cpp = False ) :
+
+        import socket
+        self.__output = output
+        self.__cpp    = True if cpp else False
+        self.__events = []
+        self.__pids   = {}
+        self.__start  = time.time ()
+        self.__local  = self.__pid ( socket.getfqdn () , os.getpid () )
+        self.__events.append ( { 'name' : 'thread_name' , 'ph' : 'M' ,
+                                 'pid'  : self.__local [ 0 ] , 'tid' : self.__local [ 1 ] ,
+                                 'args' : { 'name' : 'TaskManager' } } )
+
+    ## get the track (pid,tid) for the host and process
+    def __pid ( self , host , pid ) :
+        """Get the track (pid,tid) for the host and process"""
+        if not host in self.__pids :
+            index = len ( self.__pids ) + 1
+            self.__pids [ host ] = index
+            self.__events.append ( { 'name' : 'process_name' , 'ph' : 'M' , 'pid' : index ,
+                                     'args' : { 'name' : host } } )
+        return self.__pids [ host ] , pid
+
+    ## microseconds since the start
+    def __us ( self , t ) :
+        return int ( 1.e+6 * ( t - self.__start ) )
+
+    # =========================================================================
+    ## add the span to the timeline
+    #  @param name  the name of the span
+    #  @param start the start (wall-clock timestamp)
+    #  @param stop  the end   (wall-clock timestamp)
+    #  @param track the track (pid,tid), local by default
+    def add ( self , name , start , stop , track = None , cat = 'job' , **args ) :
+        """Add the span to the timeline
+        - name  : the name of the span
+        - start : the start (wall-clock timestamp)
+        - stop  : the end   (wall-clock timestamp)
+        - track : the track (pid,tid), local by default
+        """
+        pid , tid = track if track else self.__local
+        event = { 'name' : name , 'cat' : cat  , 'ph'  : 'X' ,
+                  'ts'   : self.__us ( start ) ,
+                  'dur'  : max ( 0 , int ( 1.e+6 * ( stop - start ) ) ) ,
+                  'pid'  : pid  , 'tid' : tid  }
+        if args : event [ 'args' ] = args
+        self.__events.append ( event )
+
+    # =========================================================================
+    ## record the job (the statistics of the job) at the reception of the result
+    #  @param jobid the job identifier
+    #  @param stat  the job statistics
+    #  @see ostap.parallel.task.Statistics
+    def job ( self , jobid , stat ) :
+        """Record the job (the statistics of the job) at the reception of the result
+        - jobid : the job identifier
+        - stat  : the job statistics (see ostap.parallel.task.Statistics)
+        """
+        received = time.time ()
+        track    = self.__pid ( stat.host , stat.pid )
+
+        args     = dict ( stat.args )
+        args [ 'jobid' ] = jobid
+        self.add ( 'job' , stat.start_time , stat.stop_time , track , **args )
+
+        end = stat.stop_time
+        for span in stat.spans :
+            name , start , stop , sargs = span
+            self.add ( name , start , stop , track , cat = 'worker' , jobid = jobid , **sargs )
+            end = max ( end , stop )
+
+        ## from the end of the job to the reception
+        self.add ( 'transfer' , end , received , track , cat = 'transfer' , jobid = jobid )
+
+    # =========================================================================
+    ## the context manager to record the local span
+    #  @code
+    #  with timeline.local ( 'merge' , jobid = jobid ) : ...
+    #  @endcode
+    def local ( self , name , **args ) :
+        """The context manager to record the local span
+        >>> with timeline.local ( 'merge' , jobid = jobid ) : ...
+        """
+        return Span ( self , name , args )
+
+    # =========================================================================
+    ## write the timeline into the file (Chrome-trace JSON)
+    def write ( self , output = '' ) :
+        """Write the timeline into the file (Chrome-trace JSON)"""
+        output = output if output else self.__output
+        if not output : return None
+        with open ( output , 'w' ) as f :
+            json.dump ( { 'traceEvents'     : self.__events ,
+                          'displayTimeUnit' : 'ms'          ,
+                          'otherData'       : { 'start' : self.__start } } , f )
+        logger.info ( 'Timeline is written into %s' % output )
+        return output
+
+    @property
+    def cpp ( self ) :
+        """``cpp'': collect the C++ instrumentation counters for the jobs?"""
+        return self.__cpp
+
+    @property
+    def output ( self ) :
+        """``output'' : the output file"""
+        return self.__output
+
+    @property
+    def events ( self ) :
+        """``events'' : the list of events"""
+        return tuple ( self.__events )
+
+    def __bool__     ( self ) : return True
+    def __nonzero__  ( self ) : return True
+
+# =============================================================================
+## @class NoTimeline
+#  Dummy timeline: nothing is recorded
+class NoTimeline(object) :
+    """Dummy timeline: nothing is recorded
+    """
+    cpp    = False
+    output = ''
+    def add   ( self , *args , **kwargs ) : pass
+    def job   ( self , jobid , stat     ) : pass
+    def write ( self , output = ''      ) : return None
+    def local ( self , name , **args    ) :
+        from ostap.utils.utils import NoContext
+        return NoContext ()
+    def __bool__     ( self ) : return False
+    def __nonzero__  ( self ) : return False
+
+# =============================================================================
+## create the timeline from the argument
+#  - <code>None</code>/<code>False</code> : no timeline
+#  - string                              : the output file
+#  - <code>Timeline</code>               : as it is
+def make_timeline ( timeline ) :
+    """Create the timeline from the argument
+    - None/False : no timeline
+    - string     : the output file
+    - Timeline   : as it is
+    """
+    if   not timeline                        : return NoTimeline ()
+    elif isinstance ( timeline , Timeline  ) : return timeline
+    elif isinstance ( timeline , str       ) : return Timeline ( timeline )
+    return Timeline ()
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+#                                                                       The END
+# =============================================================================
@@ -41,6 +41,7 @@ __all__     = (
     'good_pings'       , ## get alive hosts
     'get_local_port'   , ## get local port number
     'pool_context'     , ## useful context for the pathos's Pools
+    'warm_up'          , ## load ROOT&Ostap in the (persistent) worker 
     )
 # =============================================================================
 import sys
@@ -258,6 +259,40 @@ def random_random ( *jobid ) :
     state = random.getstate() , ROOT.gRandom.GetSeed() , ROOT.RooRandom.randomGenerator().GetSeed() 
     
 
+# =============================================================================
+## Deterministic random number setting for parallel jobs
+#  - the substream of the counter-based generator is assigned for the job,
+#    and it is used to seed python, ROOT.gRandom and ROOT.RooRandom
+#  - the results are reproducible independently on the scheduling
+#  @code
+#  jobid  = ...
+#  stream = random_substream ( jobid , seed = 12345 ) 
+#  @endcode
+#  @return the stream of random numbers for this job
+#  @see Ostap::Math::RandomStream 
+def random_substream ( jobid , seed ) :
+    """Deterministic random number setting for parallel jobs
+    - the substream of the counter-based generator is assigned for the job,
+    and it is used to seed python, ROOT.gRandom and ROOT.RooRandom
+    - the results are reproducible independently on the scheduling
+    >>> jobid  = ...
+    >>> stream = random_substream ( jobid , seed = 12345 ) 
+    - see Ostap.Math.RandomStream 
+    """
+    import random, ROOT
+    from ostap.math.random_ext import random_stream 
+    
+    stream = random_stream ( seed , max ( jobid , 0 ) )
+    
+    ## python
+    random.seed ( stream.next32 () * 2**32 + stream.next32 () )
+    
+    ## ROOT & RooFit: avoid zero seed (it means "random")
+    ROOT.gRandom.SetSeed ( 1 + stream.next32 () % 0x7FFFFFFE )
+    ROOT.RooRandom.randomGenerator().SetSeed ( 1 + stream.next32 () % 0x7FFFFFFE )
+    
+    return stream
+
 # =============================================================================
 ## ping the remote host 
 def ping ( host ) :
@@ -354,20 +389,23 @@ class PoolContext(object) :
     """Context manager for Pathos pools
     >>> with PoolContext ( pool ) :
     >>> ...   
+    - the persistent pool is neither restarted nor closed 
     """
-    def __init__ ( self , pool ) :
-        self.__pool = pool
+    def __init__ ( self , pool , persistent = False ) :
+        self.__pool       = pool
+        self.__persistent = persistent 
         
     def __enter__ ( self )   :
         sys.stdout .flush ()
         sys.stderr .flush ()
-        self.__pool.restart ( True )
+        if not self.__persistent : self.__pool.restart ( True )
         return self.__pool
     
     def __exit__  ( self , *_) :
-        self.__pool.close ()
-        self.__pool.join  ()
-        self.__pool.clear ()
+        if not self.__persistent : 
+            self.__pool.close ()
+            self.__pool.join  ()
+            self.__pool.clear ()
         sys.stdout .flush ()
         sys.stderr .flush ()
         
@@ -376,6 +414,10 @@ class PoolContext(object) :
         """``pool'' the actual Pathos pool"""
         return self.__pool 
 
+    @property
+    def persistent ( self ) :
+        """``persistent'' : is the pool persistent (kept alive between calls)?"""
+        return self.__persistent 
 
 # =============================================================================
 ## Context manager for Pathos pools
@@ -383,12 +425,41 @@ class PoolContext(object) :
 #  with pool_context ( pool ) :
 #  ...   
 #  @encode
-def pool_context  ( pool ) :
+#  - the persistent pool is neither restarted nor closed 
+def pool_context  ( pool , persistent = False ) :
     """Context manager for Pathos pools
     >>> with pool_context ( pool ) :
     >>> ...   
+    - the persistent pool is neither restarted nor closed 
     """    
-    return  PoolContext ( pool )
+    return  PoolContext ( pool , persistent )
+
+# =============================================================================
+## Load ROOT, RooFit and Ostap (including the dictionaries) in the worker
+#  It is used to "warm up" the workers of the persistent pool:
+#  the price of startup is paid only once per worker
+#  @code
+#  pool = ...
+#  pool.map ( warm_up , range ( ncpus ) ) 
+#  @endcode 
+#  @return (host,pid) pair for the worker 
+def warm_up ( *args ) :
+    """Load ROOT, RooFit and Ostap (including the dictionaries) in the worker
+    It is used to ``warm up'' the workers of the persistent pool:
+    the price of startup is paid only once per worker
+    >>> pool = ...
+    >>> pool.map ( warm_up , range ( ncpus ) ) 
+    - return (host,pid) pair for the worker 
+    """
+    import os, socket 
+    import ROOT
+    import ostap.core.pyrouts
+    import ostap.fitting.roofit
+    import ostap.trees.trees 
+    ## instantiate the dictionaries
+    ROOT.RooFit
+    ROOT.Ostap.Math
+    return socket.getfqdn ().lower () , os.getpid () 
 
 # =============================================================================
 if '__main__' == __name__ :
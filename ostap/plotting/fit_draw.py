@@ -125,6 +125,9 @@ __all__     = (
     'total_fit_options'            , ## draw options for the total fit curve
     'curve_options'                , ## draw options for the curve 
     ##
+    'fast_curves'                  , ## use the fast rendering of curves?
+    'curve_points'                 , ## number of grid points for the fast rendering 
+    ##
     'signal_style'                 , ## style for "signal"        component(s)
     'background_style'             , ## style for "background"    component(s)
     'background2D_style'           , ## style for "background-2D" component(s)
@@ -228,6 +231,8 @@ keys = (
     'draw_combined_background'    ,
     'draw_combined_component'     ,
     ##
+    'fast_curves'                 , ## fast rendering of curves ? 
+    'curve_points'                , ## number of grid points for the fast rendering 
     )
 # =============================================================================
 ## get draw options:
@@ -655,6 +660,16 @@ draw_combined_background        = True
 #  Should one draw the combined components (if any?)
 draw_combined_component        = False 
 # =============================================================================
+## @var fast_curves
+#  Use the fast (batch-evaluated and cached) rendering of curves?
+#  @see ostap.fitting.curves
+fast_curves                    = False
+# =============================================================================
+## @var curve_points
+#  Number of grid points for the fast rendering of curves
+#  @see ostap.fitting.curves
+curve_points                   = 500 
+# =============================================================================
 
 # =============================================================================
 ## get the options from configuration parser 
@@ -140,8 +140,10 @@ class Combine(object) :
             self.__cov2 = self.__cov2 + c1               
             self.__covs.append ( COV2 ( c1 ) )
 
-        self.__covs   = tuple ( self.__covs ) 
-        self.combiner = COMBINER( self.data , self.cov2 )
+        self.__covs    = tuple ( self.__covs ) 
+        self.__scales  = len ( self.__covs ) * [ 1.0 ]
+        self.__factors = {}
+        self.combiner  = COMBINER( self.data , self.cov2 )
 
     @property
     def data ( self )  :
@@ -150,14 +152,70 @@ class Combine(object) :
 
     @property
     def covs ( self )  :
-        """``covs'' : covariance matrices"""
+        """``covs'' : covariance matrices (not scaled)"""
         return self.__covs
     
+    @property
+    def scales ( self )  :
+        """``scales'' : scale factors for the uncertainty components"""
+        return tuple ( self.__scales ) 
+
     @property
     def cov2 ( self )  :
         """``cov2'' : overall covariance matrix"""
         return self.__cov2 
 
+    # =========================================================================
+    ## combine new central values with the same covariance matrix
+    #  The weights do not depend on the central values, and are not recalculated
+    #  @code
+    #  combiner = Combine ( ... ) 
+    #  r = combiner.recombine ( [ 1.0 , 1.1 , 0.9 ] )
+    #  @endcode 
+    def recombine ( self , data ) :
+        """Combine new central values with the same covariance matrix
+        - the weights do not depend on the central values, and are not recalculated
+        >>> combiner = Combine ( ... ) 
+        >>> r = combiner.recombine ( [ 1.0 , 1.1 , 0.9 ] )
+        """
+        N    = len ( self.data )
+        assert len ( data ) == N , 'recombine: invalid size of data!'
+        vals = Ostap.Vector ( N ) () 
+        for i in range ( N ) : vals [ i ] = float ( data [ i ] ) 
+        return self.combiner.result ( vals ) 
+
+    # =========================================================================
+    ## scale the uncertainty component
+    #  The covariance matrix of the component is decomposed into rank-1 terms (once),
+    #  and the Cholesky factor of the overall covariance matrix is updated
+    #  in \f$ O(kN^2) \f$ operations for a rank-\f$k\f$ component
+    #  @code
+    #  combiner = Combine ( data , syst1 , syst2 ) 
+    #  for f in ( 0.5 , 1.0 , 1.5 , 2.0 ) :
+    #      combiner.scale ( 2 , f ) ## scale syst2 (index 0 is statistical component) 
+    #      print ( combiner.result ) 
+    #  @endcode 
+    #  @param index  the index of component (see <code>covs</code>)
+    #  @param factor the new scale factor for the uncertainty (not for variance!)
+    def scale ( self , index , factor ) :
+        """Scale the uncertainty component
+        - the Cholesky factor of the covariance matrix is updated,
+        and the scan over scale factor costs O(k*N^2) per point
+        >>> combiner = Combine ( data , syst1 , syst2 ) 
+        >>> for f in ( 0.5 , 1.0 , 1.5 , 2.0 ) :
+        ...     combiner.scale ( 2 , f ) ## scale syst2 (index 0 is statistical component) 
+        ...     print ( combiner.result ) 
+        """
+        alpha = factor * factor - self.__scales [ index ] ** 2
+        if not alpha : return
+        ##
+        if not index in self.__factors :
+            self.__factors [ index ] = type ( self.combiner ).factors ( self.__covs [ index ] )
+        ##
+        self.combiner.update ( self.__factors [ index ] , alpha )
+        self.__scales [ index ] = factor 
+        self.__cov2 = self.combiner.covariance () 
+
     @property
     def result ( self ) :
         """``result'' : the final  result"""
@@ -181,8 +239,8 @@ class Combine(object) :
         """
         r = []
         w = self.weights
-        for c in self.covs :
-            a = c.sim ( w )
+        for c , f in zip ( self.covs , self.scales ) :
+            a = c.sim ( w ) * f * f 
             r.append  ( a )
             
         return tuple ( r ) 
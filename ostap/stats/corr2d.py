@@ -11,7 +11,7 @@
 __version__ = "$Revision$"
 __author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
 __date__    = "2014-06-08"
-__all__     = ( 'Corr2D', )
+__all__     = ( 'Corr2D' , 'CorrND' )
 # =============================================================================
 import ROOT,math
 # =============================================================================
@@ -20,7 +20,7 @@ import ROOT,math
 from   ostap.logger.logger import getLogger
 if '__main__' ==  __name__ : logger = getLogger( 'Ostap.Corr2D' )
 else                       : logger = getLogger( __name__ )
-from   ostap.core.core import cpp , WSE
+from   ostap.core.core import cpp , WSE , Ostap
 # =============================================================================
 ## get error-function 
 if  not hasattr ( math , 'erf' ) :
@@ -211,6 +211,126 @@ class Corr2D(object) :
     __str__ = __repr__ 
 
 
+# =============================================================================
+## N-dimensional decorrelation transformation, built from the 
+#  single-pass mergeable covariance counter 
+#  @code
+#  tree = ...
+#  c = CorrND ( tree , [ 'x' , 'y' , 'z' ] , 'pt>1' )
+#  print ( c.nvars )  ## decorrelated variables
+#  print ( c.qvars )  ## decorrelated & normalized variables 
+#  cnt  = frame.statCovariances ( [ 'x' , 'y' , 'z' ] ) 
+#  c    = CorrND ( cnt , [ 'x' , 'y' , 'z' ] ) ## directly from the counter
+#  @endcode
+#  The decorrelated variables \f$ \mathbf{y} = D \left( \mathbf{x} - \bar{\mathbf{x}} \right) \f$
+#  are uncorrelated and have unit variances 
+#  @see Ostap::Math::Covariances
+#  @see Ostap::Math::Covariances::decorrelation
+#  @see Ostap::StatVar::statCov
+#  @see Ostap::StatVar::statCovMT
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+class CorrND(object) :
+    """N-dimensional decorrelation transformation, built from the 
+    single-pass mergeable covariance counter
+    >>> tree = ...
+    >>> c = CorrND ( tree , [ 'x' , 'y' , 'z' ] , 'pt>1' )
+    >>> print ( c.nvars )  ## decorrelated variables
+    >>> print ( c.qvars )  ## decorrelated & normalized variables 
+    >>> cnt  = frame.statCovariances ( [ 'x' , 'y' , 'z' ] ) 
+    >>> c    = CorrND ( cnt , [ 'x' , 'y' , 'z' ] ) ## directly from the counter
+    - see Ostap.Math.Covariances
+    """
+    ## constructor
+    #  @param source    (INPUT) tree/chain, dataset, frame or <code>Ostap::Math::Covariances</code>
+    #  @param variables (INPUT) expressions for the variables 
+    #  @param selection (INPUT) cuts, if needed
+    #  @param nthreads  (INPUT) number of threads for datasets 
+    #  @param first     (INPUT) the first event
+    #  @param last      (INPUT) the last event     
+    def __init__  ( self              ,
+                    source            ,
+                    variables         ,
+                    selection = ''    ,
+                    nthreads  = 0     , 
+                    first     = 0     ,
+                    last      = 2**63 ) :
+
+        import ostap.stats.counters 
+
+        self.variables = tuple ( variables )
+        N              = len ( self.variables )
+        selection      = str ( selection ) if selection else ''
+        
+        if isinstance ( source , Ostap.Math.Covariances ) :
+            self.counter = source
+        elif isinstance ( source , ROOT.RooAbsData ) :
+            self.counter = Ostap.Math.Covariances ( N ) 
+            Ostap.StatVar.statCovMT ( source , self.variables , selection , self.counter , nthreads , first , last ) 
+        elif isinstance ( source , ROOT.TTree ) :
+            self.counter = Ostap.Math.Covariances ( N ) 
+            Ostap.StatVar.statCov   ( source , self.variables , selection , self.counter , first , last ) 
+        else :
+            from ostap.frames.frames import frame_covariances
+            self.counter = frame_covariances ( source , self.variables , selection ) 
+            
+        assert N == self.counter.size () , 'CorrND: mismatch in number of variables!'
+        assert 0 <  self.counter.nEff () , 'CorrND: no entries!'
+        
+        self.num   = self.counter.n ()
+        self.means = tuple ( self.counter.mean ( i ) for i in range ( N ) )
+
+        ## the decorrelation matrix (row-wise) 
+        D      = self.counter.decorrelation () 
+        self.D = tuple ( tuple ( D [ k * N + i ] for i in range ( N ) ) for k in range ( N ) )
+
+        def _expr_ ( row , scale = 1.0 ) :
+            return '+'.join ( '(%+g*((%s)%+g))' % ( scale * c , v , -m ) for c , v , m in zip ( row , self.variables , self.means ) )
+        
+        ## decorrelated variables 
+        self.nvars = tuple ( '(%s)' % _expr_ ( row ) for row in self.D )
+        
+        ## decorrelated normalized variables (normalized for 1/sqrt(2), for convinience of erf) 
+        sqr2i      = math.sqrt ( 0.5 ) 
+        self.qvars = tuple ( '0.5+0.5*TMath::Erf(%s)' % _expr_ ( row , sqr2i ) for row in self.D )
+
+        for i , v in enumerate ( self.nvars ) :
+            logger.debug ( 'The decorrelated variable #%d:\n %s ' % ( i , v ) )
+
+    ## transform the point to the decorrelated variables
+    #  @code
+    #  c = CorrND ( ... )
+    #  y = c.transform ( 1.0 , 2.0 , 3.0 ) 
+    #  @endcode 
+    def transform ( self , *values ) :
+        """Transform the point to the decorrelated variables
+        >>> c = CorrND ( ... )
+        >>> y = c.transform ( 1.0 , 2.0 , 3.0 ) 
+        """
+        assert len ( values ) == len ( self.variables ) , 'transform: invalid number of values!'
+        dx = [ v - m for v , m in zip ( values , self.means ) ]
+        return tuple ( sum ( c * d for c , d in zip ( row , dx ) ) for row in self.D )
+        
+    ## transform the point to the decorrelated normalized variables
+    def qtransform ( self , *values ) :
+        """Transform the point to the decorrelated normalized variables
+        """
+        return tuple ( gauss_cdf ( y ) for y in self.transform ( *values ) )
+    
+    def __repr__ ( self ) :
+        
+        N       = len ( self.variables ) 
+        result  =   'Events                       %s' % self.num
+        for i , v in enumerate ( self.variables ) :
+            result += '\nStat(%s) [mean/RMS] %s/%s' % ( v , self.counter.counter ( i ).mean () , self.counter.counter ( i ).rms () )
+        result += '\nCorrelations\n%s' % self.counter.corr_matrix () 
+        for i , v in enumerate ( self.nvars ) :
+            result += '\nThe decorrelated variable #%d:\n %s ' % ( i , v ) 
+        return result
+    
+    __str__ = __repr__ 
+    
+
 # =============================================================================
 if '__main__' == __name__ :
         
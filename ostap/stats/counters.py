@@ -19,12 +19,19 @@ __all__     = (
     'SE'  , ## simple smart counter (1-bi histo)  C++ Ostap::StatEntity 
     'WSE' , ## simple smart counter with weight :     Ostap::WStatEntity 
     'NSE' , ## simple smart running counter     :     Ostap::NStatEntity 
+    'BS'  , ## per-bin statistics               :     Ostap::BinStat 
+    'BR'  , ## Poisson-bootstrap replicas       :     Ostap::BinReplicas 
     ) 
 # =============================================================================
-import ROOT, cppyy
+import ROOT, cppyy, array 
 from   ostap.math.ve   import Ostap, VE
 from   ostap.math.base import isequal, isequalf  
 # =============================================================================
+try :
+    import numpy as np
+except ImportError :
+    np = None
+# =============================================================================
 _new_methods_ = []
 # =============================================================================
 SE    = Ostap.StatEntity 
@@ -216,29 +223,390 @@ _new_methods_ += [
     WSE.__ne__   ,
     ]
 
+# =============================================================================
+## Serialization of counters 
+# =============================================================================
+
+# =============================================================================
+## factory for deserialization of counters
+#  @see Ostap::StatEntity
+#  @see Ostap::WStatEntity
+#  @see Ostap::Math::Covariance 
+def cnt_factory ( klass , *args ) :
+    """Factory for deserialization of counters
+    - see Ostap.StatEntity
+    - see Ostap.WStatEntity
+    - see Ostap.Math.Covariance 
+    """
+    return klass ( *args ) 
+
+# =============================================================================
+## reduce the counter 
+#  @see Ostap::StatEntity
+def _se_reduce_ ( cnt ) :
+    """Reduce the counter
+    - see Ostap.StatEntity
+    """
+    return cnt_factory , ( type ( cnt ) ,
+                           cnt.n   () ,
+                           cnt.mu  () ,
+                           cnt.mu2 () ,
+                           cnt.min () ,
+                           cnt.max () ) 
+
+# =============================================================================
+## reduce the weighted counter 
+#  @see Ostap::WStatEntity
+def _wse_reduce_ ( cnt ) :
+    """Reduce the weighted counter
+    - see Ostap.WStatEntity
+    """
+    return cnt_factory , ( type ( cnt )     ,
+                           cnt.mu      ()   ,
+                           cnt.mu2     ()   ,
+                           cnt.values  ()   ,
+                           cnt.weights ()   ) 
+
+# =============================================================================
+## reduce the covariance counter 
+#  @see Ostap::Math::Covariance
+def _cov_reduce_ ( cnt ) :
+    """Reduce the covariance counter
+    - see Ostap.Math.Covariance
+    """
+    return cnt_factory , ( type ( cnt )        ,
+                           cnt.counter1   ()   ,
+                           cnt.counter2   ()   ,
+                           cnt.covariance ()   ) 
+
+# =============================================================================
+## reduce the mergeable quantile sketch 
+#  @see Ostap::Math::TDigest
+def _td_reduce_ ( digest ) :
+    """Reduce the mergeable quantile sketch 
+    - see Ostap.Math.TDigest
+    """
+    return cnt_factory , ( type ( digest )          ,
+                           digest.compression ()    ,
+                           digest.means       ()    ,
+                           digest.weights     ()    ,
+                           digest.n           ()    ,
+                           digest.min         ()    ,
+                           digest.max         ()    ) 
+
+# =============================================================================
+## factory for deserialization of the multivariate covariance counter
+#  @see Ostap::Math::Covariances
+def covs_factory ( klass , counters , cov2 ) :
+    """Factory for deserialization of the multivariate covariance counter
+    - see Ostap.Math.Covariances
+    """
+    _counters = ROOT.std.vector ( Ostap.WStatEntity ) ()
+    for c in counters : _counters.push_back ( c )
+    _cov2     = ROOT.std.vector ( 'double' ) ()
+    for c in cov2     : _cov2.push_back ( c )
+    return klass ( _counters , _cov2 ) 
+
+# =============================================================================
+## reduce the multivariate covariance counter 
+#  @see Ostap::Math::Covariances
+def _covs_reduce_ ( cnt ) :
+    """Reduce the multivariate covariance counter
+    - see Ostap.Math.Covariances
+    """
+    return covs_factory , ( type ( cnt )                                   ,
+                            tuple ( WSE ( c ) for c in cnt.counters () )   ,
+                            tuple ( float ( c ) for c in cnt.cov2 () )     ) 
+
+# =============================================================================
+## get the covariance (or correlation) matrix from the counter 
+#  @code
+#  cnt  = ...
+#  cov2 = cnt.cov_matrix  ()
+#  corr = cnt.corr_matrix () 
+#  @endcode 
+#  @see Ostap::Math::Covariances
+def _covs_matrix_ ( cnt , correlation = False ) :
+    """Get the covariance (or correlation) matrix from the counter
+    >>> cnt  = ...
+    >>> cov2 = cnt.cov_matrix  ()
+    >>> corr = cnt.corr_matrix () 
+    """
+    import ostap.math.linalg
+    N      = cnt.size () 
+    result = Ostap.Math.SymMatrix ( N ) () 
+    for i in range ( N ) :
+        for j in range ( i + 1 ) :
+            result [ i , j ] = cnt.correlation ( i , j ) if correlation else cnt.covariance ( i , j )
+    return result
+
+COV  = Ostap.Math.Covariance
+COVS = Ostap.Math.Covariances
+TD   = Ostap.Math.TDigest 
+
+SE  .__reduce__ = _se_reduce_
+WSE .__reduce__ = _wse_reduce_
+COV .__reduce__ = _cov_reduce_
+COVS.__reduce__ = _covs_reduce_
+TD  .__reduce__ = _td_reduce_
+
+COVS.cov_matrix  = _covs_matrix_
+COVS.corr_matrix = lambda s : _covs_matrix_ ( s , correlation = True ) 
+COVS.__repr__    = lambda s : 'Covariances(N=%d,n=%d,sumw=%.5g)' % ( s.size () , s.n () , s.sumw () )
+COVS.__str__     = COVS.__repr__
+COVS.__len__     = lambda s : s.n () 
+
+TD  .__repr__   = lambda s : 'TDigest(n=%d,median=%.5g,centroids=%d)' % ( s.n () , s.median () , s.size () )
+TD  .__str__    = TD.__repr__
+TD  .__len__    = lambda s : s.n () 
+
+_new_methods_ += [
+    SE .__reduce__ ,
+    WSE.__reduce__ ,
+    COV.__reduce__ ,
+    COVS.__reduce__  ,
+    COVS.cov_matrix  ,
+    COVS.corr_matrix ,
+    COVS.__repr__    ,
+    COVS.__str__     ,
+    COVS.__len__     ,
+    TD .__reduce__ ,
+    TD .__repr__   ,
+    TD .__str__    ,
+    TD .__len__    ,
+    ]
+
+# =============================================================================
+## get the contiguous array of doubles from the array-like input
+#  (numpy array, <code>array.array</code>), or <code>None</code> for other inputs 
+def _double_array_ ( values ) :
+    """Get the contiguous array of doubles from the array-like input
+    (numpy array, `array.array`), or `None` for other inputs 
+    """
+    if   np and isinstance ( values , np.ndarray ) :
+        return np.ascontiguousarray ( values , dtype = np.float64 ).ravel()
+    elif isinstance ( values , array.array ) :
+        return values if 'd' == values.typecode else array.array ( 'd' , values )
+    return None
+
 # =============================================================================
 ## Count iterable
+#  For array-like inputs (numpy arrays, <code>array.array</code>) the
+#  C++ bulk update is used
 #  @code
 #  c = SE.count ( [1,2,3,4] )  
+#  c = SE.count ( numpy.random.normal ( size = 1000000 ) )  
 #  @endcode
+#  @see Ostap::StatEntity::add 
 def se_count ( values ) :
     """Count iterable
+    - for array-like inputs (numpy arrays, `array.array`) the C++ bulk update is used
     >>> c = SE.count ( [1,2,3,4] )  
+    >>> c = SE.count ( numpy.random.normal ( size = 1000000 ) )  
+    - see `Ostap.StatEntity.add`
     """
     cnt = SE ()
-    for v in values : cnt.add ( v ) 
+    vv  = _double_array_ ( values )
+    if vv is None : 
+        for v in values : cnt.add ( v ) 
+    elif len ( vv ) :
+        cnt.add ( len ( vv ) , vv )
     return cnt
 SE.count = staticmethod ( se_count )
 
+# =============================================================================
+## Count iterable with (optional) weights 
+#  For array-like inputs (numpy arrays, <code>array.array</code>) the
+#  C++ bulk update is used
+#  @code
+#  c = WSE.count ( [1,2,3,4] , [0.1,0.5,1.0,2.0] )  
+#  c = WSE.count ( xarray , warray ) 
+#  @endcode
+#  @see Ostap::WStatEntity::add 
+def wse_count ( values , weights = None ) :
+    """Count iterable with (optional) weights
+    - for array-like inputs (numpy arrays, `array.array`) the C++ bulk update is used
+    >>> c = WSE.count ( [1,2,3,4] , [0.1,0.5,1.0,2.0] )  
+    >>> c = WSE.count ( xarray , warray ) 
+    - see `Ostap.WStatEntity.add`
+    """
+    cnt = WSE ()
+    vv  = _double_array_ ( values )
+    ww  = None if weights is None else _double_array_ ( weights ) 
+    if vv is None or ( ww is None and not weights is None ) :
+        if weights is None : 
+            for v     in values                   : cnt.add ( v     )
+        else :
+            for v , w in zip ( values , weights ) : cnt.add ( v , w ) 
+    elif len ( vv ) :
+        if ww is None : cnt.add ( len ( vv ) , vv , ROOT.nullptr )
+        else :
+            assert len ( vv ) == len ( ww ) , 'count: mismatch in array sizes!'
+            cnt.add ( len ( vv ) , vv , ww )
+    return cnt
+WSE.count = staticmethod ( wse_count )
+
+_new_methods_ += [
+    SE .count ,
+    WSE.count ,
+    ]
+
+# =============================================================================
+## Per-bin statistics 
+# =============================================================================
+BS = Ostap.BinStat 
+
+# =============================================================================
+## get the bin edges of the axis 
+def _bs_edges_ ( axis ) :
+    """Get the bin edges of the axis"""
+    n = axis.GetNbins () 
+    return n , array.array ( 'd' , ( axis.GetBinLowEdge ( i ) for i in range ( 1 , n + 2 ) ) )
+
+# =============================================================================
+## convert the per-bin statistics into the profile histogram
+#  @code
+#  stat = tree.bin_stat ( model , 'pt' , 'mass' ) 
+#  prof = stat.asProfile () 
+#  @endcode
+#  @see Ostap::BinStat::profile 
+def _bs_profile_ ( stat , name = '' , title = '' ) :
+    """Convert the per-bin statistics into the profile histogram
+    >>> stat = tree.bin_stat ( model , 'pt' , 'mass' ) 
+    >>> prof = stat.asProfile () 
+    - see Ostap::BinStat::profile 
+    """
+    from ostap.core.core import hID
+    model = stat.model () 
+    assert model , "asProfile: invalid model histogram!"
+    name  = name  if name  else hID () 
+    title = title if title else model.GetTitle ()
+    edges = _bs_edges_ ( model.GetXaxis () ) 
+    if 2 <= stat.dim () : edges += _bs_edges_ ( model.GetYaxis () )
+    if 3 <= stat.dim () : edges += _bs_edges_ ( model.GetZaxis () )
+    klass = { 1 : ROOT.TProfile , 2 : ROOT.TProfile2D , 3 : ROOT.TProfile3D } [ stat.dim () ]
+    prof  = klass ( name , title , *edges )
+    stat.profile ( prof )
+    return prof
+
+# =============================================================================
+## convert the per-bin statistics into the histogram
+#  @code
+#  stat  = tree.bin_stat ( model , 'pt' , 'mass' ) 
+#  hmean = stat.asH1 ( 'mean' ) ## mean values with uncertainties
+#  hrms  = stat.asH1 ( 'rms'  ) ## r.m.s. 
+#  @endcode
+#  @param what : one of <code>mean, rms, min, max, nEff, sumw</code>
+#  @see Ostap::BinStat
+def _bs_histo_ ( stat , what = 'mean' , name = '' ) :
+    """Convert the per-bin statistics into the histogram
+    >>> stat  = tree.bin_stat ( model , 'pt' , 'mass' ) 
+    >>> hmean = stat.asH1 ( 'mean' ) ## mean values with uncertainties
+    >>> hrms  = stat.asH1 ( 'rms'  ) ## r.m.s. 
+    - `what` : one of `mean, rms, min, max, nEff, sumw`
+    - see Ostap::BinStat
+    """
+    assert what in ( 'mean' , 'rms' , 'min' , 'max' , 'nEff' , 'sumw' ) , \
+           "asH1: invalid quantity ``%s''" % what 
+    from ostap.core.core import hID, ROOTCWD 
+    model = stat.model () 
+    assert model , "asH1: invalid model histogram!"
+    with ROOTCWD () :
+        ROOT.gROOT.cd () 
+        histo = model.Clone ( name if name else hID () )
+    getattr ( stat , what ) ( histo )
+    return histo
+
+BS.asProfile   = _bs_profile_
+BS.asH1        = _bs_histo_ 
+BS.__len__     = lambda s : s.size () 
+BS.__getitem__ = lambda s , i : s.stat ( i ) 
+BS.__iadd__    = lambda s , o : s.add  ( o ) 
+BS.__repr__    = lambda s : 'BinStat(dim=%d,cells=%d)' % ( s.dim () , s.size () )
+BS.__str__     = BS.__repr__
+
+_new_methods_ += [
+    BS.asProfile   ,
+    BS.asH1        ,
+    BS.__len__     , 
+    BS.__getitem__ , 
+    BS.__iadd__    , 
+    BS.__repr__    ,
+    BS.__str__     ,
+    ]
+
+# =============================================================================
+## Poisson-bootstrap replicas 
+# =============================================================================
+BR = Ostap.BinReplicas 
+
+# =============================================================================
+## convert the Poisson-bootstrap replicas into the histogram
+#  @code
+#  reps = tree.bin_replicas ( model , 'pt' , nreplicas = 200 ) 
+#  h    = reps.asH1 ()                 ## nominal with bootstrap uncertainties
+#  hw   = reps.asH1 ( 'sumw' )         ## nominal with sqrt(sumw2) uncertainties
+#  h5   = reps.asH1 ( replica = 5 )    ## the 5th replica 
+#  @endcode
+#  @param what    : one of <code>bootstrap, sumw</code>
+#  @param replica : the replica (if specified, <code>what</code> is ignored)
+#  @see Ostap::BinReplicas
+def _br_histo_ ( reps , what = 'bootstrap' , name = '' , replica = None ) :
+    """Convert the Poisson-bootstrap replicas into the histogram
+    >>> reps = tree.bin_replicas ( model , 'pt' , nreplicas = 200 ) 
+    >>> h    = reps.asH1 ()                 ## nominal with bootstrap uncertainties
+    >>> hw   = reps.asH1 ( 'sumw' )         ## nominal with sqrt(sumw2) uncertainties
+    >>> h5   = reps.asH1 ( replica = 5 )    ## the 5th replica 
+    - `what`    : one of `bootstrap, sumw`
+    - `replica` : the replica (if specified, `what` is ignored)
+    - see Ostap::BinReplicas
+    """
+    assert what in ( 'bootstrap' , 'sumw' ) , "asH1: invalid quantity ``%s''" % what 
+    from ostap.core.core import hID, ROOTCWD 
+    model = reps.model () 
+    assert model , "asH1: invalid model histogram!"
+    with ROOTCWD () :
+        ROOT.gROOT.cd () 
+        histo = model.Clone ( name if name else hID () )
+    if replica is None : getattr ( reps , what ) ( histo )
+    else               : reps.replica ( replica , histo ) 
+    return histo
+
+# =============================================================================
+## iterate over the replicas as histograms 
+#  @code
+#  reps = tree.bin_replicas ( model , 'pt' , nreplicas = 200 ) 
+#  for h in reps.histos () : ... 
+#  @endcode
+def _br_histos_ ( reps ) :
+    """Iterate over the replicas as histograms 
+    >>> reps = tree.bin_replicas ( model , 'pt' , nreplicas = 200 ) 
+    >>> for h in reps.histos () : ... 
+    """
+    for r in range ( reps.nReplicas () ) :
+        yield _br_histo_ ( reps , replica = r )
+
+BR.asH1        = _br_histo_ 
+BR.histos      = _br_histos_ 
+BR.__len__     = lambda s : s.size () 
+BR.__iadd__    = lambda s , o : s.add  ( o ) 
+BR.__repr__    = lambda s : 'BinReplicas(dim=%d,cells=%d,replicas=%d)' % ( s.dim () , s.size () , s.nReplicas () )
+BR.__str__     = BR.__repr__
+
 _new_methods_ += [
-    SE.count ,
+    BR.asH1        ,
+    BR.histos      ,
+    BR.__len__     , 
+    BR.__iadd__    , 
+    BR.__repr__    ,
+    BR.__str__     ,
     ]
 
 _new_methods_ = tuple ( _new_methods_ )
 
 # =============================================================================
 _decorated_classes_ = (
-    SE , WSE , NSE 
+    SE , WSE , NSE , COV , TD , BS , BR 
     )
 # =============================================================================
 if '__main__' == __name__  :
@@ -319,6 +319,61 @@ def _om_table ( obj , title = '' , prefix = '' ) :
     return T.table ( rows  , title = title , prefix = prefix )
 
 
+# =============================================================================
+## add the array of values to the moment-counter 
+#  The values are processed by blocks, that are merged into the counter,
+#  large arrays can be processed in parallel 
+#  @code
+#  m = Ostap.Math.Moment_(6)()
+#  m.add_array ( numpy_array ) 
+#  m.add_array ( numpy_array , nthreads = 4 ) 
+#  @endcode
+#  @param data     the array of values (any sequence, converted to the contiguous array of doubles)
+#  @param nthreads number of threads for large arrays, 0 means hardware concurrency 
+def _om_add_array ( obj , data , nthreads = 1 ) :
+    """Add the array of values to the moment-counter
+    The values are processed by blocks, that are merged into the counter,
+    large arrays can be processed in parallel 
+    >>> m = Ostap.Math.Moment_(6)()
+    >>> m.add_array ( numpy_array ) 
+    >>> m.add_array ( numpy_array , nthreads = 4 ) 
+    """
+    import numpy
+    data = numpy.ascontiguousarray ( data , dtype = numpy.float64 ).ravel()
+    if len ( data ) : obj.add ( data , len ( data ) , nthreads ) 
+    return obj
+
+# =============================================================================
+## add the arrays of values and weights  to the weighted moment-counter 
+#  The values are processed by blocks, that are merged into the counter,
+#  large arrays can be processed in parallel 
+#  @code
+#  m = Ostap.Math.WMoment_(6)()
+#  m.add_array ( values , weights ) 
+#  m.add_array ( values , weights , nthreads = 4 ) 
+#  @endcode
+#  @param data     the array of values (any sequence, converted to the contiguous array of doubles)
+#  @param weights  the array of weights (unit weights if None)
+#  @param nthreads number of threads for large arrays, 0 means hardware concurrency 
+def _wm_add_array ( obj , data , weights = None , nthreads = 1 ) :
+    """Add the arrays of values and weights to the weighted moment-counter
+    The values are processed by blocks, that are merged into the counter,
+    large arrays can be processed in parallel 
+    >>> m = Ostap.Math.WMoment_(6)()
+    >>> m.add_array ( values , weights ) 
+    >>> m.add_array ( values , weights , nthreads = 4 ) 
+    """
+    import numpy
+    data = numpy.ascontiguousarray ( data , dtype = numpy.float64 ).ravel()
+    if not len ( data ) : return obj 
+    if weights is None :
+        obj.add ( data , len ( data ) , ROOT.nullptr , nthreads )
+        return obj 
+    weights = numpy.ascontiguousarray ( weights , dtype = numpy.float64 ).ravel()
+    assert len ( weights ) == len ( data ) , 'add_array: mismatch in lengths of values and weights!'
+    obj.add ( data , len ( data ) , weights , nthreads ) 
+    return obj
+
 Ostap.Math.Moment.unbiased_2nd   = _om_u2nd 
 Ostap.Math.Moment.unbiased_3rd   = _om_u3rd
 Ostap.Math.Moment.unbiased_4th   = _om_u4th 
@@ -332,6 +387,7 @@ Ostap.Math.Moment.kurtosis       = _om_kurtosis
 Ostap.Math.Moment.cmoment        = _om_cm2
 Ostap.Math.Moment.central_moment = _om_cm2
 Ostap.Math.Moment.table          = _om_table
+Ostap.Math.Moment.add_array      = _om_add_array 
 
 Ostap.Math.WMoment.mean           = _om_mean    
 Ostap.Math.WMoment.rms            = _om_rms 
@@ -341,6 +397,7 @@ Ostap.Math.WMoment.kurtosis       = _om_kurtosis
 Ostap.Math.WMoment.cmoment        = _om_cm3
 Ostap.Math.WMoment.central_moment = _om_cm3
 Ostap.Math.WMoment.table          = _om_table
+Ostap.Math.WMoment.add_array      = _wm_add_array 
 
 M0  = Ostap.Math.Moment_(0)
 M1  = Ostap.Math.Moment_(1)
@@ -379,6 +436,7 @@ _new_methods_ = (
     Ostap.Math.Moment.cmoment        ,
     Ostap.Math.Moment.central_moment , 
     Ostap.Math.Moment.table          ,
+    Ostap.Math.Moment.add_array      ,
     ##
     Ostap.Math.WMoment.mean           ,
     Ostap.Math.WMoment.rms            ,
@@ -388,6 +446,7 @@ _new_methods_ = (
     Ostap.Math.WMoment.cmoment        ,
     Ostap.Math.WMoment.central_moment , 
     Ostap.Math.WMoment.table          ,
+    Ostap.Math.WMoment.add_array      ,
     ##
     )
                           
@@ -112,6 +112,28 @@ else                       : logger = getLogger ( __name__              )
 # =============================================================================
 from ostap.core.ostap_types import integer_types, num_types 
 from ostap.core.core import Ostap 
+import math 
+# =============================================================================
+## use the native C++ solver for C++ functors on the finite interval
+#  @return the result or <code>None</code> if the native solver is not applicable 
+#  @see Ostap::Math::Solver1D
+def _native_ ( method , func , xmin , xmax , *args ) :
+    """Use the native C++ solver for C++ functors on the finite interval
+    - return the result or None if the native solver is not applicable 
+    - see Ostap::Math::Solver1D
+    """
+    if not isinstance ( xmin , num_types ) or not math.isfinite ( xmin ) : return None
+    if not isinstance ( xmax , num_types ) or not math.isfinite ( xmax ) : return None
+    from ostap.math.rootfinder import native_solver
+    solver = native_solver ( method , func )
+    if not solver : return None
+    xmin , xmax = float ( xmin ) , float ( xmax ) 
+    try :
+        ## quantile: ( pdf , prob , xmin , xmax ) , others: ( func , xmin , xmax , ... ) 
+        if 'quantile' == method : return solver ( func , args [ 0 ] , xmin , xmax )
+        return solver ( func , xmin , xmax , *args )
+    except Exception :
+        return None
 # =============================================================================
 ## @class Moment
 #  Calculate the N-th moment for the distribution 
@@ -492,6 +514,9 @@ class Median(RMS) :
 
     ## calculate the median 
     def __call__ ( self , func , *args ) :
+        if not args :
+            result = _native_ ( 'quantile' , func , self.xmin , self.xmax , 0.5 )
+            if not result is None : return result 
         return self._median_ ( func , self.xmin , self.xmax ,  *args )
 
     def __str__ ( self ) :
@@ -531,6 +556,10 @@ class Quantile(Median) :
         elif  0.0 == self.Q : return self.xmin
         elif  1.0 == self.Q : return self.xmax
 
+        if not args :
+            result = _native_ ( 'quantile' , func , self.xmin , self.xmax , self.Q )
+            if not result is None : return result 
+
         ## need to know the integral
         from ostap.math.integral import IntegralCache
         iint = IntegralCache ( func, self.xmin, err = False ,  args = args )
@@ -596,6 +625,10 @@ class Mode(Median) :
     ## calculate the mode 
     def __call__ ( self , func , *args ) :
 
+        if not args :
+            result = _native_ ( 'mode' , func , self.xmin , self.xmax )
+            if not result is None : return result 
+            
         ## mean
         _mean     = Mean   .__call__ ( self , func , *args )
         ## median 
@@ -705,6 +738,11 @@ class Width(Mode) :
     def __call__ ( self , func , mode = None , *args ) :
         ##
 
+        if not args :
+            m0     = float ( mode ) if isinstance ( mode , num_types ) else float ( 'nan' ) 
+            result = _native_ ( 'width' , func , self.xmin , self.xmax , m0 , self._hfactor )
+            if not result is None : return result.first , result.second 
+            
         ## mode is specified 
         if isinstance ( mode , float )        and \
            self.xmin < mode < self.xmax       and \
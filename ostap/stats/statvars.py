@@ -24,6 +24,7 @@
 - data_quartiles       - get three quartiles 
 - data_quintiles       - get four  quintiles 
 - data_deciles         - get nine  deciles
+- data_digest          - get the mergeable quantile sketch (t-digest)
 """
 # =============================================================================
 __version__ = "$Revision$"
@@ -47,6 +48,7 @@ __all__     = (
     'data_quartiles'      , ## get three quartiles 
     'data_quintiles'      , ## get four  quintiles 
     'data_deciles'        , ## get nine  deciles
+    'data_digest'         , ## get the mergeable quantile sketch (t-digest) 
     'data_decorate'       , ## technical function to decorate the class
     )
 # =============================================================================
@@ -58,8 +60,10 @@ from ostap.logger.logger import getLogger
 if '__main__' ==  __name__ : logger = getLogger ( 'ostap.stats.statvars' )
 else                       : logger = getLogger ( __name__               )
 # =============================================================================
-from   ostap.core.core import Ostap
+from   ostap.core.core    import Ostap
+from   ostap.core.ostap_types import string_types 
 import ostap.stats.moment 
+import ROOT 
 # =============================================================================
 StatVar = Ostap.StatVar 
 # =============================================================================
@@ -67,6 +71,28 @@ StatVar = Ostap.StatVar
 #  use it as threshold for exact/slow vs approximate/fast quanitle calcualtion 
 QEXACT = 10000
 # =============================================================================
+## @var QDIGEST
+#  use it as ``exact'' argument to get the approximate quantiles
+#  from the mergeable quantile sketch (t-digest)
+#  @see Ostap::Math::TDigest
+QDIGEST = 'digest'
+# =============================================================================
+## @var COMPRESSION
+#  the default compression parameter for t-digest 
+#  @see Ostap::Math::TDigest
+COMPRESSION = 100 
+# =============================================================================
+## use the multithreaded processing?
+#  - only for datasets without the cut-range 
+#  @see Ostap::StatVar::momentMT
+#  @see Ostap::StatVar::quantilesMT
+def _use_mt_ ( data , nthreads , *args ) :
+    """Use the multithreaded processing?
+    - only for datasets without the cut-range 
+    """
+    if nthreads is None or not isinstance ( data , ROOT.RooAbsData ) : return False
+    return not args or not isinstance ( args [ 0 ] , string_types )
+# =============================================================================
 ## get the moment of order 'order' relative to 'center'
 #  @code
 #  data =  ...
@@ -95,15 +121,27 @@ def data_get_moment ( data , order , center , expression , cuts = '' , *args ) :
 #  print data_moment ( data , 3 , 'mass' , 'pt>1' ) 
 #  print data.moment (        3 , 'mass' , 'pt>1' ) ## ditto
 #  @endcode
+#  Use several threads (for datasets):
+#  @code
+#  print data.moment (        3 , 'mass' , 'pt>1' , nthreads = 8 ) 
+#  @endcode
 #  @see Ostap::StatVar::moment
-def  data_moment ( data , order , expression , cuts  = ''  , *args ) :
+#  @see Ostap::StatVar::momentMT
+def  data_moment ( data , order , expression , cuts  = ''  , *args , **kwargs ) :
     """Get the moment of order 'order' relative to 'center'
     >>> data =  ...
     >>> print data_moment ( data ,  3 , 'mass' , 'pt>1' ) 
     >>> print data.moment (         3 , 'mass' , 'pt>1' ) ## ditto
+    Use several threads (for datasets):
+    >>> print data.moment (         3 , 'mass' , 'pt>1' , nthreads = 8 ) 
     - see Ostap::StatVar::moment
+    - see Ostap::StatVar::momentMT
     """
     assert isinstance ( order  , int ) and 0<= order , 'Invalid order  %s'  % order
+    nthreads = kwargs.pop ( 'nthreads' , None )
+    assert not kwargs , 'moment: unknown arguments %s' % list ( kwargs.keys() ) 
+    if _use_mt_ ( data , nthreads , *args ) :
+        return StatVar.momentMT ( data , order , expression , cuts , nthreads , *args )
     return StatVar.moment ( data       ,
                             order      ,
                             expression ,
@@ -170,6 +208,35 @@ def data_kurtosis ( data , expression , cuts  = '' , *args ) :
     """
     return StatVar.kurtosis ( data , expression , cuts , *args )
 
+# =============================================================================
+## get the mergeable quantile sketch (t-digest)
+#  @code
+#  data   = ...
+#  digest = data_digest ( data , 'mass' , 'pt>1' ) 
+#  digest = data.digest (        'mass' , 'pt>1' ) ## ditto
+#  print ( digest.quantile ( 0.5 ) , digest.quantile ( 0.95 ) )
+#  @endcode
+#  - the sketches from different chunks/jobs can be merged:
+#  @code
+#  digest += other_digest 
+#  @endcode
+#  @see Ostap::Math::TDigest
+#  @see Ostap::StatVar::digest
+def data_digest ( data , expression , cuts = '' , compression = COMPRESSION , *args ) :
+    """Get the mergeable quantile sketch (t-digest)
+    >>> data   = ...
+    >>> digest = data_digest ( data , 'mass' , 'pt>1' ) 
+    >>> digest = data.digest (        'mass' , 'pt>1' ) ## ditto
+    >>> print ( digest.quantile ( 0.5 ) , digest.quantile ( 0.95 ) )
+    - the sketches from different chunks/jobs can be merged:
+    >>> digest += other_digest 
+    - see Ostap.Math.TDigest
+    - see Ostap.StatVar.digest
+    """
+    digest = Ostap.Math.TDigest ( compression )
+    StatVar.digest ( data , digest , expression , cuts , *args )
+    return digest
+
 # =============================================================================
 ## get the  quantile 
 #  @code
@@ -179,17 +246,32 @@ def data_kurtosis ( data , expression , cuts  = '' , *args ) :
 #  @endcode
 #  @see Ostap::StatVar::quantile
 #  @see Ostap::StatVar::p2quantile
-def  data_quantile ( data , q , expression , cuts  = '' , exact = QEXACT , *args ) :
+def  data_quantile ( data , q , expression , cuts  = '' , exact = QEXACT , *args , **kwargs ) :
     """Get the quantile
     >>> data =  ...
     >>> print data_quantile ( data , 0.1 , 'mass' , 'pt>1' ) 
     >>> print data.quantile (        0.1 , 'mass' , 'pt>1' ) ## ditto
     - see Ostap.StatVar.quantile
     - see Ostap.StatVar.p2quantile
+    - use exact = 'digest' for the mergeable quantile sketch (t-digest)
+    - use nthreads = N for the exact quantile using several threads (datasets)
     """
     assert isinstance ( q , float ) and 0 < q < 1 , 'Invalid quantile:%s' % q
-
-    if   exact is True  :
+    
+    nthreads = kwargs.pop ( 'nthreads' , None )
+    assert not kwargs , 'quantile: unknown arguments %s' % list ( kwargs.keys() ) 
+    
+    use_mt   = _use_mt_ ( data , nthreads , *args ) 
+    if use_mt and ( exact is True or ( isinstance ( exact , int ) and not isinstance ( exact , bool ) and len ( data ) <= exact ) ) :
+        ## exact algorithm using several threads 
+        qn = StatVar.quantileMT ( data , q , expression , cuts , nthreads , *args )
+        
+    elif QDIGEST == exact :
+        ## mergeable quantile sketch 
+        digest = data_digest ( data , expression , cuts , COMPRESSION , *args )
+        qn     = StatVar.Quantile ( digest.quantile ( q ) , digest.n () ) 
+
+    elif exact is True  :
         ##  exact slow algorithm 
         qn = StatVar.  quantile ( data , q , expression , cuts , *args )
 
@@ -222,13 +304,20 @@ def data_interval ( data , qmin ,  qmax , expression , cuts = '' , exact = QEXAC
     >>> print data_interval ( data , 0.05 , 0.95 , 'mass' , 'pt>1' ) ## get 90% interval
     >>> print data.interval (        0.05 , 0.95 , 'mass' , 'pt>1' ) ## get 90% interval
     - see Ostap::StatVar::interval
+    - use exact = 'digest' for the mergeable quantile sketch (t-digest)
     """
     assert isinstance ( qmin , float ) and 0 < qmin < 1 , 'Invalid quantile-1:%s' % qmin 
     assert isinstance ( qmax , float ) and 0 < qmax < 1 , 'Invalid quantile-2:%s' % qmax
 
     qmin, qmax = min ( qmin ,  qmax ) , max  ( qmin, qmax  )
     
-    if   exact is True  :
+    if   QDIGEST == exact :
+        ## mergeable quantile sketch 
+        digest = data_digest ( data , expression , cuts , COMPRESSION , *args )
+        rn     = StatVar.QInterval ( StatVar.Interval ( digest.quantile ( qmin ) ,
+                                                        digest.quantile ( qmax ) ) , digest.n () ) 
+        
+    elif exact is True  :
         ##  exact slow algorithm 
         rn = StatVar.  interval ( data , qmin , qmax  , expression , cuts , *args )
 
@@ -276,7 +365,7 @@ def data_median ( data , expression , cuts = '' , exact = QEXACT , *args ) :
 #  print data.quantiles (        20    , 'mass' , 'pt>1' ) 
 #  @endcode
 #  @see Ostap::StatVar::quantile
-def data_quantiles ( data , quantiles , expression , cuts  = '' , exact = QEXACT , *args ) :
+def data_quantiles ( data , quantiles , expression , cuts  = '' , exact = QEXACT , *args , **kwargs ) :
     """Get the quantiles
     >>> data =  ...
     >>> print data_quantiles ( data , 0.1       , 'mass' , 'pt>1' ) ## quantile 
@@ -286,7 +375,11 @@ def data_quantiles ( data , quantiles , expression , cuts  = '' , exact = QEXACT
     >>> print data.quantiles (        (0.1,0.5) , 'mass' , 'pt>1' )
     >>> print data.quantiles (        10        , 'mass' , 'pt>1' ) ## deciles!     
     - see Ostap::StatVar::quantile
+    - use nthreads = N for the exact quantiles using several threads (datasets)
     """
+    nthreads = kwargs.pop ( 'nthreads' , None )
+    assert not kwargs , 'quantiles: unknown arguments %s' % list ( kwargs.keys() ) 
+
     if   isinstance ( quantiles , float ) and 0 < quantiles < 1 : 
         quantiles = [ quantiles ]
     elif isinstance ( quantiles , int   ) and 1 < quantiles     :
@@ -302,7 +395,17 @@ def data_quantiles ( data , quantiles , expression , cuts  = '' , exact = QEXACT
     from ostap.math.base import doubles
     qqq = doubles ( qq )
 
-    if   exact is True  :
+    use_mt = _use_mt_ ( data , nthreads , *args )
+    if use_mt and ( exact is True or ( isinstance ( exact , int ) and not isinstance ( exact , bool ) and len ( data ) <= exact ) ) :
+        ## exact algorithm using several threads 
+        qn = StatVar.quantilesMT ( data , qqq , expression , cuts , nthreads , *args )
+        
+    elif QDIGEST == exact :
+        ## mergeable quantile sketch 
+        digest = data_digest ( data , expression , cuts , COMPRESSION , *args )
+        qn     = StatVar.Quantiles ( digest.quantiles ( qqq ) , digest.n () ) 
+
+    elif exact is True  :
         ##  exact slow algorithm 
         qn = StatVar.  quantiles ( data , qqq , expression , cuts , *args )
 
@@ -483,6 +586,7 @@ def data_decorate ( klass ) :
     if hasattr ( klass , 'quartiles'      ) : klass.orig_quartiles      = klass.quartiles
     if hasattr ( klass , 'quintiles'      ) : klass.orig_quintiles      = klass.quintiles
     if hasattr ( klass , 'deciles'        ) : klass.orig_deciles        = klass.deciles
+    if hasattr ( klass , 'digest'         ) : klass.orig_digest         = klass.digest 
 
     klass.get_moment      = data_get_moment
     klass.moment          = data_moment
@@ -502,6 +606,7 @@ def data_decorate ( klass ) :
     klass.quartiles       = data_quartiles
     klass.quintiles       = data_quintiles
     klass.deciles         = data_deciles
+    klass.digest          = data_digest 
 
 
 # =============================================================================
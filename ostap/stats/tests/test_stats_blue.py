@@ -138,11 +138,50 @@ def test_stats_blue2 () :
     logger.info ( 'Weights    : %s' %  cmb.weights ) 
         
 
+# =============================================================================
+## repeated combinations: new central values and scaled systematic components 
+def test_stats_blue3 () :
+
+    COV2 = Ostap.Math.SymMatrix(3)
+
+    ms   = VE ( 1.00 , 0.05**2 ) , VE ( 1.10 , 0.07**2 ) , VE ( 0.95 , 0.06**2 )
+    
+    ## uncorrelated systematic 
+    syst1 = COV2 ()
+    syst1 [0,0] = 0.03**2
+    syst1 [1,1] = 0.04**2
+    syst1 [2,2] = 0.02**2
+    
+    ## 100% correlated systematic 
+    s2    = 0.02 , 0.05 , 0.03 
+    syst2 = COV2 ()
+    for i in range ( 3 ) :
+        for j in range ( i , 3 ) : syst2 [ i , j ] = s2 [ i ] * s2 [ j ]
+
+    cmb = Combine ( ms , syst1 , syst2 )
+
+    ## scan the scale of the correlated systematic 
+    for f in ( 0.5 , 1.0 , 1.5 , 2.0 , 0.1 ) :
+        cmb.scale ( 2 , f )
+        r1  = cmb.result
+        r2  = Combine ( ms , syst1 , syst2 * ( f * f ) ).result
+        logger.info ( 'Scale %.2f: %s vs %s' % ( f , r1 , r2 ) )
+        assert abs ( r1.value () - r2.value () ) < 1.e-10 and abs ( r1.cov2 () - r2.cov2 () ) < 1.e-12 , \
+               'Mismatch for scaled systematic!' 
+
+    ## new central values 
+    vs  = 1.01 , 1.05 , 0.97
+    r1  = cmb.recombine ( vs ) 
+    r2  = Combine ( [ VE ( v , m.cov2 () ) for v , m in zip ( vs , ms ) ] , syst1 , syst2 * 0.01 ).result
+    logger.info ( 'New values: %s vs %s' % ( r1 , r2 ) )
+    assert abs ( r1.value () - r2.value () ) < 1.e-10 , 'Mismatch for new central values!'
+
 # =============================================================================
 if '__main__' == __name__ :
 
     test_stats_blue1 ()
     test_stats_blue2 ()
+    test_stats_blue3 ()
     
 # =============================================================================
 ##                                                                      The END 
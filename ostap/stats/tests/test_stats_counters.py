@@ -16,7 +16,7 @@ __all__    = () ## nothing to import
 # ============================================================================= 
 import ROOT, random
 from   builtins               import range
-from   ostap.stats.counters   import SE, WSE 
+from   ostap.stats.counters   import SE, WSE, TD, COVS 
 import ostap.logger.table     as     T
 # =============================================================================
 # logging 
@@ -158,7 +158,125 @@ def test_stats_counters_4 () :
     else                    : logger.info  ( "RMS for ``mu2'' : %.3g" % rms_mu2 )
 
 
+# =============================================================================
+## the mergeable quantile sketch: merging & serialization 
+def test_stats_counters_5 () :
+    
+    logger = getLogger("tests_stats_counters_5")
+
+    data = [ random.gauss ( 0 , 1 ) for i in range ( 100000 ) ]
+    
+    whole   = TD ()
+    for v in data : whole.add ( v ) 
+
+    ## five pieces 
+    L       = len ( data ) 
+    pieces  = [ TD () for i in range ( 5 ) ]
+    for i , v in enumerate ( data ) : pieces [ i % 5 ].add ( v )
+    merged  = TD ()
+    for p in pieces : merged += p 
+
+    import pickle 
+    restored = pickle.loads ( pickle.dumps ( merged ) )
+    
+    data.sort() 
+    for q in ( 0.01 , 0.05 , 0.16 , 0.5 , 0.84 , 0.95 , 0.99 ) :
+        exact  = data [ int ( q * L ) ]
+        for d in ( whole , merged , restored ) :
+            r = d.cdf ( exact ) 
+            assert abs ( r - q ) < 0.005 , 'Invalid rank for %s: %.4f vs %.4f' % ( d , r , q )
+        assert restored.quantile ( q ) == merged.quantile ( q ) , 'Invalid serialization!'
+        logger.info ( 'Quantile %.2f exact %+.4f whole %+.4f merged %+.4f' % ( q , exact , whole.quantile ( q ) , merged.quantile ( q ) ) ) 
+
+    assert L == merged.n () == restored.n () , 'Invalid number of entries'
+    assert merged.size () <= merged.compression () , 'Too many centroids %s' % merged.size () 
+
+# =============================================================================
+## the multivariate covariance counter: batches, merging, serialization & decorrelation 
+def test_stats_counters_6 () :
+    
+    logger = getLogger("tests_stats_counters_6")
+
+    import array
+    from   ostap.stats.corr2d import CorrND 
+    
+    N    = 3
+    rows = array.array ( 'd' ) 
+    ws   = array.array ( 'd' ) 
+    for i in range ( 20000 ) :
+        x = random.gauss ( 0 , 1 )
+        y = random.gauss ( 0 , 1 )
+        z = random.gauss ( 0 , 1 )
+        rows.extend ( ( 1.e+6 + x , x + 0.5 * y , z - y ) )
+        ws.append   ( random.uniform ( 0.5 , 2.0 ) )
+
+    ## entry-by-entry 
+    single = COVS ( N )
+    for i , w in enumerate ( ws ) : single.add ( rows [ N * i : N * i + N ] , w ) 
+        
+    ## batches & merge 
+    L      = len ( ws ) 
+    first  = COVS ( N )
+    second = COVS ( N )
+    first .add ( L // 2     , rows                                , ws                 )
+    second.add ( L - L // 2 , rows [ N * ( L // 2 ) : ] , ws [ L // 2 : ] )
+    merged = first + second 
+
+    import pickle 
+    restored = pickle.loads ( pickle.dumps ( merged ) )
+
+    for i in range ( N ) :
+        for j in range ( i + 1 ) :
+            c = single.covariance ( i , j )
+            assert abs ( merged  .covariance ( i , j ) - c ) < 1.e-10 , 'Invalid covariance!'
+            assert abs ( restored.covariance ( i , j ) - c ) < 1.e-10 , 'Invalid serialization!'
+    assert single.n () == merged.n () == restored.n () == L , 'Invalid number of entries!'
+    logger.info ( 'Correlations:\n%s' % merged.corr_matrix () )
+
+    ## decorrelation 
+    corr = CorrND ( merged , ( 'x' , 'y' , 'z' ) )
+    test = COVS ( N )
+    for i , w in enumerate ( ws ) : test.add ( corr.transform ( *rows [ N * i : N * i + N ] ) , w )
+    for i in range ( N ) :
+        for j in range ( i + 1 ) :
+            assert abs ( test.covariance ( i , j ) - ( 1 if i == j else 0 ) ) < 1.e-8 , 'Invalid decorrelation!'
+    logger.info ( 'Decorrelated variables:\n%s' % '\n'.join ( corr.nvars ) )
+    
+# =============================================================================
+## the bulk (array) updates for counters 
+def test_stats_counters_7 () :
+    
+    logger = getLogger("tests_stats_counters_7")
 
+    import array
+    from   ostap.utils.timing import timing 
+    
+    xs = array.array ( 'd' , ( random.gauss   ( 1.e+6 , 1 ) for i in range ( 100000 ) ) )
+    ws = array.array ( 'd' , ( random.uniform ( 0     , 2 ) for i in range ( 100000 ) ) )
+    ws [ 0 ] = 0.0 
+
+    with timing ( 'SE : one-by-one' , logger = logger ) : 
+        c1 = SE ()
+        for x in xs : c1.add ( x )
+    with timing ( 'SE : bulk      ' , logger = logger ) : 
+        c2 = SE.count ( xs )
+
+    assert c1.n () == c2.n () and c1.min () == c2.min () and c1.max () == c2.max () , 'Invalid bulk update!'
+    assert abs ( c1.mu  () - c2.mu  () ) < 1.e-8 * abs ( c1.mu () ) , 'Invalid bulk mean!'
+    assert abs ( c1.mu2 () - c2.mu2 () ) < 1.e-6 * c1.mu2 ()         , 'Invalid bulk variance!'
+
+    with timing ( 'WSE: one-by-one' , logger = logger ) : 
+        c3 = WSE ()
+        for x , w in zip ( xs , ws ) : c3.add ( x , w )
+    with timing ( 'WSE: bulk      ' , logger = logger ) : 
+        c4 = WSE.count ( xs , ws )
+
+    assert c3.n () == c4.n () and c3.values ().n () == c4.values ().n () , 'Invalid bulk update!'
+    assert abs ( c3.mu   () - c4.mu   () ) < 1.e-8 * abs ( c3.mu () ) , 'Invalid bulk mean!'
+    assert abs ( c3.mu2  () - c4.mu2  () ) < 1.e-6 * c3.mu2 ()         , 'Invalid bulk variance!'
+    assert abs ( c3.sumw () - c4.sumw () ) < 1.e-8 * c3.sumw ()        , 'Invalid bulk sum of weights!'
+    
+    logger.info ( 'Bulk counters:\n%s\n%s' % ( c2 , c4 ) ) 
 
 # =============================================================================
 if "__main__" == __name__ :
@@ -167,6 +285,9 @@ if "__main__" == __name__ :
     test_stats_counters_2 ()
     test_stats_counters_3 ()
     test_stats_counters_4 ()
+    test_stats_counters_5 ()
+    test_stats_counters_6 ()
+    test_stats_counters_7 ()
     
     
     
@@ -103,11 +103,68 @@ def test_moment2() :
         if 4 <= i.order : logger.info (' %s : kurtosis %s ' % ( t , i.kurtosis () ) )
 
 
+# =============================================================================
+## blocked (and parallel) processing of arrays 
+def test_moment3() :
+
+    if root_version < 61800 :
+        logger.warning ( "does not work for ancient ROOT versions")
+        return
+    
+    try :
+        import numpy
+    except ImportError :
+        logger.warning ( "No numpy is available, skip the test") 
+        return
+
+    ## relative tolerance: the summation order is different 
+    close = lambda a , b : abs ( a - b ) <= 1.e-9 * max ( 1.0 , abs ( a ) , abs ( b ) ) 
+    
+    data    = numpy.random.normal  ( 1.0 , 2.0 , 200000 )
+    weights = numpy.random.uniform ( 0.5 , 1.5 , 200000 )
+
+    m1 = Ostap.Math.Moment_ ( 6 )()
+    m2 = Ostap.Math.Moment_ ( 6 )()
+    m3 = Ostap.Math.Moment_ ( 6 )()
+    for v in data [ : 20000 ] : m1 += v
+    m2.add_array ( data [ : 20000 ] )
+    m3.add_array ( data , nthreads = 0 )
+    
+    for k in range ( 7 ) :
+        assert close ( m1.M ( k ) , m2.M ( k ) ) , \
+               'Mismatch for %d-moment: %s vs %s' % ( k , m1.M ( k ) , m2.M ( k ) ) 
+
+    ## the same data, filled serially 
+    m4 = Ostap.Math.Moment_ ( 6 )()
+    for v in data : m4 += v
+
+    assert m3.size () == m4.size () , \
+           'Mismatch for size: %s vs %s' % ( m3.size () , m4.size () ) 
+    assert close ( m3.mu () , m4.mu () ) , \
+           'Mismatch for mean: %s vs %s' % ( m3.mu () , m4.mu () ) 
+    for k in range ( 2 , 7 ) :
+        assert close ( m3.moment ( k ) , m4.moment ( k ) ) , \
+               'Mismatch for %d-moment (parallel vs serial): %s vs %s' % ( k , m3.moment ( k ) , m4.moment ( k ) ) 
+
+    w1 = Ostap.Math.WMoment_ ( 4 )()
+    w2 = Ostap.Math.WMoment_ ( 4 )()
+    for v , w in zip ( data [ : 20000 ] , weights [ : 20000 ] ) : w1.add ( v , w )  
+    w2.add_array ( data [ : 20000 ] , weights [ : 20000 ] )
+
+    for k in range ( 5 ) :
+        assert close ( w1.M ( k ) , w2.M ( k ) ) , \
+               'Mismatch for %d-weighted moment: %s vs %s' % ( k , w1.M ( k ) , w2.M ( k ) ) 
+
+    t = 'Moment counter-6 (array)'
+    logger.info ( "%s\n%s" % ( t , m3.table ( title = t , prefix = '# ' ) ) )
+
+    
 # =============================================================================
 if '__main__' == __name__ :
 
     test_moment1()
     test_moment2()
+    test_moment3()
         
 # =============================================================================
 ##                                                                      The END 
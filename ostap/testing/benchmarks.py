@@ -0,0 +1,488 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/testing/benchmarks.py
+#  Simple performance regression harness for typical ostap workflows
+#
+#  Each benchmark consists of the (untimed) preparation of the fixed synthetic
+#  input and the (timed) workflow itself:
+#  - <code>data_chain</code>       : building of <code>Data</code> from set of files
+#  - <code>pstatvar</code>         : parallel <code>statVar</code> over the chain
+#  - <code>parallel_project</code> : parallel projection of the chain into histogram
+#  - <code>fit1d</code>            : unbinned <code>Fit1D</code> fit with <code>CB2_pdf</code> + positive polynomial
+#  - <code>toys</code>             : 100 pseudoexperiments with <code>make_toys</code>
+#  - <code>splot</code>            : <code>sPlot</code> for the fitted dataset
+#  - <code>rootshelve</code>       : write/read of histograms with <code>rootshelve</code>
+#
+#  Each benchmark is executed in two modes:
+#  - <i>cold</i> : the single run in the fresh subprocess (includes all imports, JIT-compilation, caches filling)
+#  - <i>warm</i> : several repeated runs in the same process
+#  For both modes the timing (via ostap.utils.timing) and
+#  peak RSS (via ostap.utils.memory) are reported
+#  The results are written into JSON file, that can be compared with the
+#  results obtained for other releases/machines
+#
+#  @code
+#  python -m ostap.testing.benchmarks --output new.json
+#  python -m ostap.testing.benchmarks fit1d toys --warm 5 --output new.json
+#  python -m ostap.testing.benchmarks --compare old.json new.json
+#  @endcode
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Simple performance regression harness for typical ostap workflows
+
+Each benchmark consists of the (untimed) preparation of the fixed synthetic
+input and the (timed) workflow itself:
+- `data_chain`       : building of `Data` from set of files
+- `pstatvar`         : parallel `statVar` over the chain
+- `parallel_project` : parallel projection of the chain into histogram
+- `fit1d`            : unbinned `Fit1D` fit with `CB2_pdf` + positive polynomial
+- `toys`             : 100 pseudoexperiments with `make_toys`
+- `splot`            : `sPlot` for the fitted dataset
+- `rootshelve`       : write/read of histograms with `rootshelve`
+
+Each benchmark is executed in two modes:
+- cold : the single run in the fresh subprocess (includes all imports, JIT-compilation, caches filling)
+- warm : several repeated runs in the same process
+
+>>> python -m ostap.testing.benchmarks --output new.json
+>>> python -m ostap.testing.benchmarks fit1d toys --warm 5 --output new.json
+>>> python -m ostap.testing.benchmarks --compare old.json new.json
+"""
+# =============================================================================
+__version__ = "$Revision$"
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'benchmark'      , ## decorator to register the benchmark
+    'benchmarks'     , ## all known benchmarks
+    'run_benchmark'  , ## run the single benchmark (cold and/or warm)
+    'run_benchmarks' , ## run all/selected benchmarks
+    'compare'        , ## compare two JSON files with results
+    )
+# =============================================================================
+import os, sys, json, random, platform, subprocess
+from   collections        import OrderedDict
+from   ostap.utils.timing import timing
+from   ostap.utils.memory import memory_usage, peak_memory
+# =============================================================================
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger( 'ostap.testing.benchmarks' )
+else                       : logger = getLogger( __name__ )
+# =============================================================================
+## fixed seed for all synthetic inputs
+SEED    = 2718281
+## format version of the output JSON file
+FORMAT  = 1
+# =============================================================================
+## all known benchmarks: name -> ( setup , run , description )
+_benchmarks = OrderedDict()
+# =============================================================================
+## decorator to register the benchmark
+#  - <code>setup</code> prepares the (untimed) input and returns it
+#  - the decorated function gets this input and runs the (timed) workflow
+#  @code
+#  @benchmark ( 'my_workflow' , setup = prepare_my_data )
+#  def run_my_workflow ( data ) : ...
+#  @endcode
+def benchmark ( name , setup = None ) :
+    """Decorator to register the benchmark
+    - `setup` prepares the (untimed) input and returns it
+    - the decorated function gets this input and runs the (timed) workflow
+    >>> @benchmark ( 'my_workflow' , setup = prepare_my_data )
+    >>> def run_my_workflow ( data ) : ...
+    """
+    def _register_ ( fun ) :
+        doc = fun.__doc__.strip().split('\n')[0] if fun.__doc__ else name
+        _benchmarks [ name ] = setup , fun , doc
+        return fun
+    return _register_
+
+# =============================================================================
+## the names of all known benchmarks
+def benchmarks () :
+    """The names of all known benchmarks"""
+    return tuple ( _benchmarks.keys() )
+
+# =============================================================================
+## reset all random generators to the fixed state
+def _reseed_ ( seed = SEED ) :
+    """Reset all random generators to the fixed state"""
+    random.seed ( seed )
+    import ROOT
+    ROOT.gRandom.SetSeed ( seed )
+    ROOT.RooRandom.randomGenerator().SetSeed ( seed )
+
+# =============================================================================
+## (Untimed) preparation of the synthetic input
+# =============================================================================
+
+## directory for the synthetic input
+_tmpdir = None
+def _workdir () :
+    global _tmpdir
+    if _tmpdir is None :
+        from ostap.utils.cleanup import CleanUp
+        _tmpdir = CleanUp.tempdir ( prefix = 'ostap-benchmarks-' )
+    return _tmpdir
+
+# =============================================================================
+## create the set of files with synthetic trees
+def _make_files ( nfiles = 10 , nentries = 20000 ) :
+    """Create the set of files with synthetic trees"""
+    import ROOT
+    import ostap.io.root_file
+    from   array import array
+    _reseed_ ()
+    files = []
+    for i in range ( nfiles ) :
+        fname = os.path.join ( _workdir () , 'bench_tree_%d.root' % i )
+        files.append ( fname )
+        if os.path.exists ( fname ) : continue
+        mass = array ( 'd' , [0] )
+        pt   = array ( 'd' , [0] )
+        with ROOT.TFile.Open ( fname , 'new' ) as rfile :
+            tree = ROOT.TTree ( 'S' , 'tree' )
+            tree.SetDirectory ( rfile )
+            tree.Branch ( 'mass' , mass , 'mass/D' )
+            tree.Branch ( 'pt'   , pt   , 'pt/D'   )
+            for j in range ( nentries ) :
+                mass [ 0 ] = random.gauss   ( 3.1 , 0.015 )
+                pt   [ 0 ] = random.uniform ( 0   , 10    )
+                tree.Fill ()
+            rfile.Write()
+    return files
+
+# =============================================================================
+## create the chain of the synthetic trees
+def _make_chain () :
+    """Create the chain of the synthetic trees"""
+    from ostap.trees.data import Data
+    return Data ( 'S' , _make_files () , silent = True ).chain
+
+# =============================================================================
+## create the model and the synthetic dataset for fit
+def _make_model ( nevents = 10000 ) :
+    """Create the model and the synthetic dataset for fit"""
+    import ROOT
+    import ostap.fitting.models as Models
+    _reseed_ ()
+    mass   = ROOT.RooRealVar  ( 'bench_mass' , 'mass' , 5.0 , 5.6 )
+    signal = Models.CB2_pdf   ( 'BenchS' , xvar = mass ,
+                                mean   = ( 5.28 , 5.20 , 5.35 ) ,
+                                sigma  = ( 0.02 , 0.005 , 0.05 ) ,
+                                alphaL = ( 2.0  , 0.5  , 5.0  ) ,
+                                alphaR = ( 2.0  , 0.5  , 5.0  ) ,
+                                nL     = ( 2.0  , 0.0  , 10.0 ) ,
+                                nR     = ( 5.0  , 0.0  , 10.0 ) )
+    bkg    = Models.PolyPos_pdf ( 'BenchB' , xvar = mass , power = 2 )
+    model  = Models.Fit1D ( signal = signal , background = bkg , suffix = '_bench' )
+    model.S = 0.3 * nevents
+    model.B = 0.7 * nevents
+    dataset = model.generate ( nevents )
+    ## fix the shape parameters to make the fit stable
+    signal.nL.fix ()
+    signal.nR.fix ()
+    return model , dataset
+
+# =============================================================================
+## create the histograms to be stored into database
+def _make_histos ( nhistos = 100 ) :
+    """Create the histograms to be stored into database"""
+    import ROOT
+    import ostap.histos.histos
+    _reseed_ ()
+    histos = []
+    for i in range ( nhistos ) :
+        h = ROOT.TH1D ( 'bench_h%d' % i , '' , 100 , -5 , 5 )
+        h.SetDirectory ( ROOT.nullptr )
+        for j in range ( 1000 ) : h.Fill ( random.gauss ( 0 , 1 ) )
+        histos.append ( h )
+    return histos
+
+# =============================================================================
+## Benchmarks
+# =============================================================================
+
+# =============================================================================
+@benchmark ( 'data_chain' , setup = _make_files )
+def _bench_data_chain ( files ) :
+    """Build `Data` from set of files"""
+    from ostap.trees.data import Data
+    data = Data ( 'S' , files , silent = True , check = True )
+    return len ( data.chain )
+
+# =============================================================================
+@benchmark ( 'pstatvar' , setup = _make_chain )
+def _bench_pstatvar ( chain ) :
+    """Parallel statVar over the chain"""
+    import ostap.parallel.parallel_statvar
+    return chain.pstatVar ( 'mass' , 'pt>1' , silent = True ).nEntries()
+
+# =============================================================================
+@benchmark ( 'parallel_project' , setup = _make_chain )
+def _bench_parallel_project ( chain ) :
+    """Parallel projection of the chain into histogram"""
+    import ROOT
+    import ostap.parallel.parallel_project
+    histo = ROOT.TH1D ( 'bench_hproj' , '' , 200 , 3.0 , 3.2 )
+    chain.pproject ( histo , 'mass' , 'pt>1' , silent = True )
+    return histo.GetEntries ()
+
+# =============================================================================
+@benchmark ( 'fit1d' , setup = _make_model )
+def _bench_fit1d ( inputs ) :
+    """Unbinned Fit1D fit: CB2_pdf + positive polynomial"""
+    model , dataset = inputs
+    result , _ = model.fitTo ( dataset , silent = True , refit = 2 )
+    return result.status ()
+
+# =============================================================================
+@benchmark ( 'toys' , setup = lambda : _make_model ( 1000 ) )
+def _bench_toys ( inputs ) :
+    """100 pseudoexperiments with make_toys"""
+    import ostap.fitting.toys as Toys
+    model , dataset = inputs
+    results , stats = Toys.make_toys (
+        pdf        = model ,
+        nToys      = 100   ,
+        data       = [ model.xvar ] ,
+        gen_config = { 'nEvents' : 1000 , 'sample' : True } ,
+        fit_config = { 'silent'  : True } ,
+        silent     = True  ,
+        progress   = False )
+    return len ( results )
+
+# =============================================================================
+@benchmark ( 'splot' , setup = _make_model )
+def _bench_splot ( inputs ) :
+    """sPlot for the fitted dataset"""
+    model , dataset = inputs
+    model.fitTo ( dataset , silent = True )
+    ds = dataset.emptyClone()
+    ds.append ( dataset )
+    model.sPlot ( ds )
+    return len ( ds )
+
+# =============================================================================
+@benchmark ( 'rootshelve' , setup = _make_histos )
+def _bench_rootshelve ( histos ) :
+    """Write/read histograms with rootshelve"""
+    import ostap.io.rootshelve as DBASE
+    from   ostap.utils.cleanup import CleanUp
+    dbname = CleanUp.tempfile ( suffix = '.root' , prefix = 'ostap-bench-db-' )
+    with DBASE.open ( dbname , 'c' ) as db :
+        for h in histos : db [ h.GetName() ] = h
+    nread = 0
+    with DBASE.open ( dbname , 'r' ) as db :
+        for key in db :
+            obj    = db [ key ]
+            nread += 1
+    return nread
+
+# =============================================================================
+## run the benchmark in the current process
+def _run_warm ( name , repeat = 3 ) :
+    """Run the benchmark in the current process"""
+    setup , fun , _ = _benchmarks [ name ]
+    inputs = setup () if setup else None
+    times  = []
+    rss0   = memory_usage ()
+    for i in range ( repeat ) :
+        _reseed_ ()
+        with timing ( name , logger = None ) as t : fun ( inputs )
+        times.append ( t.delta )
+    return OrderedDict ( [
+        ( 'times'     , times                        ) ,
+        ( 'min'       , min ( times )                ) ,
+        ( 'mean'      , sum ( times ) / len ( times ) ) ,
+        ( 'rss_delta' , memory_usage () - rss0       ) ,
+        ( 'peak_rss'  , peak_memory  ()              ) ] )
+
+# =============================================================================
+## run the benchmark in the fresh subprocess
+def _run_cold ( name ) :
+    """Run the benchmark in the fresh subprocess"""
+    command = [ sys.executable , '-m' , 'ostap.testing.benchmarks' , '--single' , name ]
+    with timing ( name , logger = None ) as t :
+        output = subprocess.check_output ( command )
+    if not isinstance ( output , str ) : output = output.decode ( 'utf-8' )
+    ## the last line of the output is JSON
+    result = json.loads ( output.strip().split('\n')[-1] )
+    result [ 'process' ] = t.delta
+    return result
+
+# =============================================================================
+## Run the single benchmark
+#  @code
+#  result = run_benchmark ( 'fit1d' , cold = True , warm = 5 )
+#  @endcode
+#  @param name the benchmark name
+#  @param cold run the cold (fresh subprocess) mode?
+#  @param warm number of repetitions for the warm mode (0 to switch it off)
+def run_benchmark ( name , cold = True , warm = 3 ) :
+    """Run the single benchmark
+    >>> result = run_benchmark ( 'fit1d' , cold = True , warm = 5 )
+    - name : the benchmark name
+    - cold : run the cold (fresh subprocess) mode?
+    - warm : number of repetitions for the warm mode (0 to switch it off)
+    """
+    assert name in _benchmarks , "Unknown benchmark: `%s'" % name
+    result = OrderedDict ()
+    if cold      : result [ 'cold' ] = _run_cold ( name )
+    if 0 < warm  : result [ 'warm' ] = _run_warm ( name , warm )
+    return result
+
+# =============================================================================
+## information about the running environment
+def _context () :
+    """Information about the running environment"""
+    import datetime, ROOT
+    import ostap
+    return OrderedDict ( [
+        ( 'format'  , FORMAT                                    ) ,
+        ( 'date'    , datetime.datetime.now().isoformat()       ) ,
+        ( 'host'    , platform.node ()                          ) ,
+        ( 'machine' , platform.machine ()                       ) ,
+        ( 'ncpu'    , os.cpu_count () if hasattr ( os , 'cpu_count' ) else -1 ) ,
+        ( 'python'  , platform.python_version ()                ) ,
+        ( 'root'    , ROOT.gROOT.GetVersion ()                  ) ,
+        ( 'ostap'   , getattr ( ostap , '__version__' , '' )    ) ,
+        ( 'seed'    , SEED                                      ) ] )
+
+# =============================================================================
+## Run all/selected benchmarks and (optionally) write results into JSON file
+#  @code
+#  results = run_benchmarks ( output = 'bench.json' )
+#  results = run_benchmarks ( [ 'fit1d' , 'splot' ] , warm = 5 )
+#  @endcode
+def run_benchmarks ( names = () , cold = True , warm = 3 , output = '' ) :
+    """Run all/selected benchmarks and (optionally) write results into JSON file
+    >>> results = run_benchmarks ( output = 'bench.json' )
+    >>> results = run_benchmarks ( [ 'fit1d' , 'splot' ] , warm = 5 )
+    """
+    names   = names if names else benchmarks ()
+    results = OrderedDict ()
+    for name in names :
+        logger.info ( 'Run benchmark %s' % name )
+        results [ name ] = run_benchmark ( name , cold = cold , warm = warm )
+
+    data = OrderedDict ( [ ( 'context' , _context () ) , ( 'benchmarks' , results ) ] )
+    if output :
+        with open ( output , 'w' ) as f : json.dump ( data , f , indent = 2 )
+        logger.info ( 'Results are written into %s' % output )
+
+    logger.info ( 'Benchmark results:\n%s' % _table ( results , prefix = '# ' ) )
+    return data
+
+# =============================================================================
+## format results as table
+def _table ( results , prefix = '' ) :
+    """Format results as table"""
+    rows = [ ( 'Benchmark' , 'cold [s]' , 'cold RSS [MB]' , 'warm min [s]' , 'warm mean [s]' , 'warm RSS [MB]' ) ]
+    for name , r in results.items () :
+        cold = r.get ( 'cold' , {} )
+        warm = r.get ( 'warm' , {} )
+        row  = ( name ,
+                 '%.3f' % cold [ 'time'     ] if cold else '' ,
+                 '%.1f' % cold [ 'peak_rss' ] if cold else '' ,
+                 '%.3f' % warm [ 'min'      ] if warm else '' ,
+                 '%.3f' % warm [ 'mean'     ] if warm else '' ,
+                 '%.1f' % warm [ 'peak_rss' ] if warm else '' )
+        rows.append ( row )
+    import ostap.logger.table as T
+    return T.table ( rows , title = 'Benchmarks' , prefix = prefix , alignment = 'lrrrrr' )
+
+# =============================================================================
+## Compare two JSON files with benchmark results
+#  @code
+#  compare ( 'old.json' , 'new.json' )
+#  @endcode
+#  @param old       reference results
+#  @param new       new results
+#  @param threshold relative slowdown to be marked as regression
+#  @return list of benchmarks with regressions
+def compare ( old , new , threshold = 0.10 ) :
+    """Compare two JSON files with benchmark results
+    >>> compare ( 'old.json' , 'new.json' )
+    - old       : reference results
+    - new       : new results
+    - threshold : relative slowdown to be marked as regression
+    Returns list of benchmarks with regressions
+    """
+    with open ( old ) as f : rold = json.load ( f ) [ 'benchmarks' ]
+    with open ( new ) as f : rnew = json.load ( f ) [ 'benchmarks' ]
+
+    from ostap.logger.colorized import attention
+
+    def _ratio_ ( a , b ) : return b / a if 0 < a else float ( 'inf' )
+
+    rows        = [ ( 'Benchmark' , 'cold old/new [s]' , 'ratio' , 'warm old/new [s]' , 'ratio' ) ]
+    regressions = []
+    for name in rnew :
+        if not name in rold : continue
+        o , n = rold [ name ] , rnew [ name ]
+        row   = [ name ]
+        bad   = False
+        for mode , key in ( ( 'cold' , 'time' ) , ( 'warm' , 'min' ) ) :
+            if mode in o and mode in n :
+                a , b = o [ mode ] [ key ] , n [ mode ] [ key ]
+                r     = _ratio_ ( a , b )
+                rs    = '%.2f' % r
+                if 1 + threshold < r :
+                    rs  = attention ( rs )
+                    bad = True
+                row += [ '%.3f/%.3f' % ( a , b ) , rs ]
+            else :
+                row += [ '' , '' ]
+        if bad : regressions.append ( name )
+        rows.append ( row )
+
+    import ostap.logger.table as T
+    title = 'Benchmarks: %s vs %s' % ( old , new )
+    logger.info ( '%s:\n%s' % ( title , T.table ( rows , title = title , prefix = '# ' , alignment = 'lrrrr' ) ) )
+    if regressions :
+        logger.warning ( 'Regressions (>%.0f%%) : %s' % ( 100 * threshold , ', '.join ( regressions ) ) )
+    return regressions
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    if 1 == len ( sys.argv ) :
+
+        from ostap.utils.docme import docme
+        docme ( __name__ , logger = logger )
+        logger.info ( 'Known benchmarks: %s' % ', '.join ( benchmarks () ) )
+
+    else :
+
+        import argparse
+        parser = argparse.ArgumentParser ( prog = 'python -m ostap.testing.benchmarks' ,
+                                           description = 'Performance regression harness for ostap workflows' )
+        parser.add_argument ( 'names'     , nargs = '*' , metavar = 'NAME' ,
+                              help = 'Benchmarks to run (all by default): %s' % ', '.join ( benchmarks () ) )
+        parser.add_argument ( '--warm'    , type = int , default = 3 , help = 'Number of repetitions for warm runs (0 to skip)' )
+        parser.add_argument ( '--no-cold' , action = 'store_true' , dest = 'nocold' , help = 'Skip cold runs' )
+        parser.add_argument ( '--output'  , default = '' , help = 'Output JSON file' )
+        parser.add_argument ( '--compare' , nargs = 2 , metavar = ( 'OLD' , 'NEW' ) , help = 'Compare two JSON files' )
+        parser.add_argument ( '--single'  , default = '' , help = argparse.SUPPRESS )
+        args = parser.parse_args ()
+        for name in args.names :
+            if not name in _benchmarks : parser.error ( "Unknown benchmark: `%s'" % name )
+
+        if args.single :
+            ## the cold run in the subprocess: the last line of output is JSON
+            setup , fun , _ = _benchmarks [ args.single ]
+            inputs = setup () if setup else None
+            _reseed_ ()
+            with timing ( args.single , logger = None ) as t : fun ( inputs )
+            sys.stdout.write ( '\n' + json.dumps ( { 'time' : t.delta , 'peak_rss' : peak_memory () } ) + '\n' )
+        elif args.compare :
+            sys.exit ( 1 if compare ( *args.compare ) else 0 )
+        else :
+            run_benchmarks ( args.names , cold = not args.nocold , warm = args.warm , output = args.output )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -96,7 +96,7 @@ from   ostap.tools.tmva       import Trainer as TMVATrainer
 from   ostap.tools.tmva       import Reader  as TMVAReader
 from   ostap.tools.tmva       import dir_name 
 from   ostap.core.pyrouts     import hID, h1_axis
-from   ostap.core.ostap_types import integer_types 
+from   ostap.core.ostap_types import integer_types, string_types 
 import ostap.trees.trees 
 import ostap.trees.cuts
 import ostap.utils.utils      as     Utils 
@@ -201,7 +201,7 @@ class Trainer(object) :
                    logging           = True                  ,   # create log-files    ?
                    make_plots        = True                  ,   # make standard plots ?
                    multithread       = False                 ,   # use multithreading  ?
-                   parallel          = True                  ,   # parallel training   ? 
+                   parallel          = True                  ,   # parallel training   ? (True/False/'threads')
                    parallel_conf     = {}                    ) : # parallel configuration ? 
         
         """Create TMVA ``chopping'' trainer
@@ -221,13 +221,19 @@ class Trainer(object) :
         ... background = background_tree  , ## TTree/TChain with ``background'' sample   
         ... name       = 'TMVAChopper'    ,
         ... verbose    = False )
-        
+
+        - `parallel = True`     : categories are trained in separate processes
+        - `parallel = 'threads'`: categories are trained concurrently in threads
+          of this process, using the same input trees
+          (`parallel_conf = { 'nthreads' : n }` limits the number of threads)
         """
         assert isinstance ( N , integer_types ) and 1 < N , "Invalid number of categories"
 
         self.__chop_signal     = True if chop_signal     else False 
         self.__chop_background = True if chop_background else False 
         self.__parallel        = True if parallel        else False 
+        self.__threads         = isinstance ( parallel , string_types ) and \
+                                 parallel.lower() in ( 'thread' , 'threads' ) 
         self.__logging         = True if logging         else False
         
         self.__parallel_conf   = {}
@@ -405,8 +411,12 @@ class Trainer(object) :
         self.__trainer_dirs = [ t.dirname for t in self.trainers ]
         
     ## create the trainer for category "i"
-    def create_trainer ( self , i , verbose = True ) :
+    #  - for <code>threaded=True</code> the trainer gets its own
+    #    TChain objects, built from the same files: no copy of data
+    def create_trainer ( self , i , verbose = True , threaded = False ) :
         """Create the trainer for category ``i''
+        - for `threaded=True` the trainer gets its own TChain objects,
+          built from the same files: no copy of data 
         """
         cat       = '(%s)%%%d' % ( self.category , self.N  )
         nam       =  '%s_%03d' % ( self.name , i )
@@ -418,11 +428,21 @@ class Trainer(object) :
         if self.chop_background :
             bcuts = icategory * bcuts if bcuts else icategory
 
+        signal     = self.__signal
+        background = self.__background
+        if threaded :
+            ## independent chains for the thread: the same files, no copy of data 
+            from ostap.trees.trees import Chain
+            signal     = Chain ( name = signal    .name , files = signal    .files ,
+                                 first = signal    .first , nevents = signal    .nevents )
+            background = Chain ( name = background.name , files = background.files ,
+                                 first = background.first , nevents = background.nevents )
+            
         mp = self.make_plots and ( self.verbose or 0 == i ) 
         t  = TMVATrainer ( methods           = self.methods          ,
                            variables         = self.variables         ,
-                           signal            = self.__signal          ,
-                           background        = self.__background      ,
+                           signal            = signal                 ,
+                           background        = background             ,
                            spectators        = self.spectators        ,
                            bookingoptions    = self.bookingoptions    ,
                            configuration     = self.configuration     ,
@@ -439,7 +459,7 @@ class Trainer(object) :
                            verbose           = self.verbose           ,
                            logging           = self.logging           ,
                            make_plots        = mp                     ,
-                           multithread       = self.multithread       ,
+                           multithread       = self.multithread and not threaded ,
                            category          = i                      )
         
         return t
@@ -474,6 +494,11 @@ class Trainer(object) :
         """``parallel'' : use parallelisation for training"""
         return self.__parallel
 
+    @property
+    def threads ( self ) :
+        """``threads'' : use in-process multithreaded training?"""
+        return self.__threads
+
     @property
     def parallel_conf ( self ) :
         """``parallel_conf'' : configuration for parallel processing"""
@@ -632,7 +657,9 @@ class Trainer(object) :
         >>> output_files  = trainer. output_files ## output ROOT files 
         >>> tar_file      = trainer.    tar_file  ## tar-file (XML&C++)
         """
-        result = self.p_train () if self.parallel else self.s_train ()
+        if   self.threads  : result = self.t_train ()
+        elif self.parallel : result = self.p_train ()
+        else               : result = self.s_train ()
 
         if os.path.exists ( self.dirname ) and os.path.isdir ( self.dirname ) :
             try :
@@ -732,6 +759,64 @@ class Trainer(object) :
 
         return self.tar_file 
 
+    # =========================================================================
+    ## The main method: training of all subsamples concurrently in threads 
+    #  - the input trees are opened once per category from the same files,
+    #    categories are defined by the cuts (entry masks), no copy of data 
+    #  - TMVA factories run concurrently in the threads of this process
+    #  - weights files are written to the same layout as for other modes
+    # @code 
+    # >>> trainer.t_train()
+    # @endcode
+    # @attention ROOT thread-safety is enabled 
+    def t_train ( self ) :
+        """The main method: training of all subsamples concurrently in threads 
+        - the input trees are opened once per category from the same files,
+          categories are defined by the cuts (entry masks), no copy of data 
+        - TMVA factories run concurrently in the threads of this process
+        - weights files are written to the same layout as for other modes
+        >>> trainer.t_train()
+        - ATTENTION: ROOT thread-safety is enabled 
+        """
+        ROOT.ROOT.EnableThreadSafety ()
+        ## release GIL for the heavy parts of TMVA 
+        for m in ( 'BookMethod' , 'TrainAllMethods' , 'TestAllMethods' , 'EvaluateAllMethods' ) :
+            getattr ( ROOT.TMVA.Factory , m ).__release_gil__ = True
+            
+        self.__trainers     = tuple ( self.create_trainer ( i , threaded = True ) for i in range ( self.N ) ) 
+        self.__trainer_dirs = [ t.dirname for t in self.trainers ]
+        
+        assert 1<= self.N and self.N == len ( self.trainers ), 'Invalid trainers!'
+
+        nthreads = self.parallel_conf.get ( 'nthreads' , 0 )
+        if not isinstance ( nthreads , integer_types ) or nthreads <= 0 : nthreads = os.cpu_count ()
+        nthreads = max ( 1 , min ( nthreads , self.N ) ) 
+        
+        logger.info  ( "Trainer(%s): train %d trainers using %d threads" % ( self.name , self.N , nthreads ) ) 
+
+        from concurrent.futures import ThreadPoolExecutor
+        from ostap.logger.utils import MuteC , NoContext
+        with ( NoContext () if self.verbose else MuteC () ) , ThreadPoolExecutor ( max_workers = nthreads ) as pool :
+            ## (re)raise the exceptions from the threads 
+            for r in pool.map ( lambda t : t.train ( threaded = True ) , self.trainers ) : pass 
+
+        ## the plots are made sequentially in the main thread 
+        for t in self.trainers :
+            if t.make_plots : t.makePlots ()
+            
+        self.__weights_files = tuple ( t.weights_files for t in self.trainers ) 
+        self.__class_files   = tuple ( t.  class_files for t in self.trainers )
+        self.__output_files  = tuple ( t. output_file  for t in self.trainers )
+
+        self.make_tarfile ( [ t.tar_file for t in self.trainers ] )
+
+        logger.debug ( "Trainer(%s): Class   files : %s" % ( self.name , self.  class_files ) ) 
+        logger.debug ( "Trainer(%s): Weights files : %s" % ( self.name , self.weights_files ) )
+        logger.info  ( "Trainer(%s): Output  files : %s" % ( self.name , self. output_files ) ) 
+        logger.info  ( "Trainer(%s): Tar     file  : %s" % ( self.name , self.    tar_file  ) )
+
+        return self.tar_file 
+
     # =========================================================================
     ## The main method: training of all subsamples in parallel  
     #  - Use the trainer for parallel training 
@@ -1268,7 +1353,7 @@ class Reader(object) :
 
 
 # =============================================================================
-def _add_response_tree ( tree , *args ) :
+def _add_response_tree ( tree , *args , **kwargs ) :
     """Specific action to ROOT.TTree
     """
     
@@ -1281,9 +1366,15 @@ def _add_response_tree ( tree , *args ) :
         
         tdir.cd()
         
-        sc = Ostap.TMVA.addChoppingResponse ( tree , *args  )
-        if sc.isFailure() :
-            logger.error ( 'Error from Ostap::TMVA::addChoppingResponse %s' % sc )
+        nthreads = kwargs.get ( 'nthreads' , 1 )
+        if 1 == nthreads : 
+            sc = Ostap.TMVA.addChoppingResponse   ( tree , *args  )
+            if sc.isFailure() :
+                logger.error ( 'Error from Ostap::TMVA::addChoppingResponse %s'   % sc )
+        else : 
+            sc = Ostap.TMVA.addChoppingResponseMT ( tree , *( args + ( nthreads , ) ) )
+            if sc.isFailure() :
+                logger.error ( 'Error from Ostap::TMVA::addChoppingResponseMT %s' % sc )
             
         if tfile.IsWritable() :
             tfile.Write( "" , ROOT.TFile.kOverwrite )
@@ -1294,7 +1385,7 @@ def _add_response_tree ( tree , *args ) :
         return sc , tree                               ## RETURN
 
 # =============================================================================
-def _add_response_chain ( chain , *args ) :
+def _add_response_chain ( chain , *args , **kwargs ) :
     """Specific action to ROOT.TChain
     """
     
@@ -1317,7 +1408,7 @@ def _add_response_chain ( chain , *args ) :
             ## get the tree 
             tt      = ff.Get(cname)
             ## treat the tree 
-            sc , nt = _add_response_tree ( tt , *args )
+            sc , nt = _add_response_tree ( tt , *args , **kwargs )
             if status is None or sc.isFailure() : status = sc 
             
     newc = ROOT.TChain ( cname )
@@ -1345,6 +1436,9 @@ def _add_response_chain ( chain , *args ) :
 #  @param options       options to be used in TMVA Reader
 #  @param verbose       verbose operation?
 #  @param aux           obligatory for the cuts method, where it represents the efficiency cutoff 
+#  @param nthreads      number of threads for TTree/TChain (0: default, 1: sequential)
+#  @param compiled      use the compiled BDT forests for TTree/TChain, if possible
+#  @see ostap.tools.tmva_forest
 def addChoppingResponse ( dataset                     , ## input dataset to be updated
                           chopper                     , ## chopping category/formula 
                           N                           , ## number of categrories
@@ -1355,13 +1449,21 @@ def addChoppingResponse ( dataset                     , ## input dataset to be u
                           suffix        = '_response' , ## suffix for TMVA-variable 
                           options       =  ''         , ## TMVA-reader options
                           verbose       = True        , ## verbosity flag 
-                          aux           = 0.9         ) :
+                          aux           = 0.9         , ## for Cuts method : efficiency cut-off
+                          nthreads      = 1           , ## number of threads for TTree/TChain 
+                          compiled      = False       ) : ## use compiled BDT forests for TTree/TChain
     """
     Helper function to add TMVA/chopping  response into dataset
     >>> tar_file = trainer.tar_file
     >>> dataset  = ...
     >>> inputs   = [ 'var1' , 'var2' , 'var2' ] ## input varibales to TMVA 
     >>> dataset.addChoppingResponse ( dataset , chopper ,  inputs , tar_file , prefix = 'tmva_' )
+    - for TTree/TChain the response can be calculated using several threads:
+    >>> dataset.addChoppingResponse ( dataset , chopper ,  inputs , tar_file , prefix = 'tmva_' , nthreads = 4 )
+    - for TTree/TChain the BDTs can be evaluated without TMVA::Reader,
+    using the compiled flattened forests (other methods use TMVA::Reader):
+    >>> dataset.addChoppingResponse ( dataset , chopper ,  inputs , tar_file , prefix = 'tmva_' , compiled = True )
+    - see ostap.tools.tmva_forest
     """
     assert isinstance ( N , int ) and 1 < N < 10000 , 'Invalid "N" %s' % N
 
@@ -1385,6 +1487,21 @@ def addChoppingResponse ( dataset                     , ## input dataset to be u
     _maps = MAPS()
     for m in files_ : _maps.push_back( m ) 
 
+    ## the compiled forests for BDTs
+    if compiled and isinstance ( dataset , ROOT.TTree ) and isinstance ( chopper , str ) :
+        from ostap.tools.tmva_forest import add_forest_response
+        inputs_  = dict ( ( str ( p.first ) , str ( p.second ) ) for p in _inputs )
+        weights_ = [ dict ( ( str ( p.first ) , str ( p.second ) ) for p in m ) for m in files_ ]
+        dataset , others = add_forest_response ( dataset , inputs_ , weights_ , prefix , suffix ,
+                                                 chopping      = chopper       ,
+                                                 category_name = category_name )
+        if not others : return dataset
+        _maps = MAPS()
+        for w in weights_ :
+            m = MAP ()
+            for k in others : m [ k ] = w [ k ]
+            _maps.push_back ( m ) 
+
     options = opts_replace ( options , 'V:'      ,     verbose )
     options = opts_replace ( options , 'Silent:' , not verbose )
     
@@ -1393,12 +1510,14 @@ def addChoppingResponse ( dataset                     , ## input dataset to be u
 
     if   isinstance ( dataset , ROOT.TChain  ) :
         sc , newdata = _add_response_chain ( dataset , chopper ,  category_name , N ,
-                                        _inputs , _maps , options , prefix , suffix , aux )
+                                        _inputs , _maps , options , prefix , suffix , aux ,
+                                        nthreads = nthreads )
         if sc.isFailure() : logger.error ( 'Error from Ostap::TMVA::addChoppingResponse %s' % sc )
         return newdata 
     elif isinstance ( dataset , ROOT.TTree   ) :
         sc , newdata = _add_response_tree  ( dataset , chopper ,  category_name , N ,
-                                        _inputs , _maps , options , prefix , suffix , aux )
+                                        _inputs , _maps , options , prefix , suffix , aux ,
+                                        nthreads = nthreads )
         if sc.isFailure() : logger.error ( 'Error from Ostap::TMVA::addChoppingResponse %s' % sc )
         return newdata 
                                         
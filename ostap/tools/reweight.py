@@ -32,6 +32,7 @@ else                       : logger = getLogger ( __name__               )
 logger.info ( 'Set of utitilities for re-weigthing')
 # =============================================================================
 from   ostap.core.pyrouts     import VE, SE
+from   ostap.core.core        import Ostap, split_string 
 from   ostap.math.base        import iszero
 from   ostap.core.ostap_types import string_types, list_types, num_types  
 from   ostap.math.operations  import Mul as MULT  ## needed for proper abstract multiplication
@@ -122,6 +123,10 @@ class Weight(object) :
         self.__nzeroes = 0 
 
         self.__vars    = [] 
+        ## histograms for the native C++ reweighter: ( expressions , histograms ) 
+        self.__tables  = []
+        self.__native  = True 
+        self.__rw      = None 
         if not factors : return
         self.__dbase = dbase
         
@@ -198,6 +203,14 @@ class Weight(object) :
                 _functions.reverse() 
                 functions = _functions
 
+                ## can it be treated by the native C++ reweighter ?
+                atts = funval.attributes if isinstance ( funval , AttrGetter ) else ()
+                if atts and len ( atts ) <= 3 and \
+                       all ( isinstance ( f , ROOT.TH1 ) and f.GetDimension() == len ( atts ) for f in functions ) :
+                    self.__tables.append ( ( atts , tuple ( functions ) ) )
+                else :
+                    self.__native = False 
+                    
                 row.append  ( '+' if merge else '-' )
                 row.append  ( '%s' % skip           )
                 
@@ -219,8 +232,23 @@ class Weight(object) :
 
                 self.__table.append ( row )
                 
-        self.__vars = tuple ( self.__vars ) 
-
+        self.__vars   = tuple ( self.__vars   ) 
+        self.__tables = tuple ( self.__tables )
+        
+    @property
+    def reweighter ( self ) :
+        """``reweighter'' : the native C++ reweighter, `Ostap.Utils.Reweighter`,
+        it is available only if all weighting factors are histograms
+        and all accessors are the expressions/variable names (otherwise `None`)
+        - see Ostap.Utils.Reweighter
+        """
+        if self.__rw is None and self.__native and self.__tables :
+            rw = Ostap.Utils.Reweighter ()
+            for atts , histos in self.__tables :
+                for h in histos : rw.add ( h , *atts )
+            self.__rw = rw 
+        return self.__rw
+    
     @property
     def dbase ( self ) :
         """``dbase'' : th ename of the database woith reweigting information
@@ -651,7 +679,9 @@ def makeWeights  ( dataset                    ,
                    power      = None          , ## auto-determination
                    debug      = True          , ## save intermediate information in DB
                    make_plots = False         , ## make plots 
-                   tag        = "Reweighting" ) :
+                   tag        = "Reweighting" , 
+                   weighter   = None          , ## the current weighter (for the fused projection)
+                   nthreads   = 1             ) :
     """The main  function: perform one re-weighting iteration 
     and reweight ``MC''-data set to looks as ``data''(reference) dataset
     >>> results = makeWeights (
@@ -677,6 +707,12 @@ def makeWeights  ( dataset                    ,
     ...    hweight = item.weight
     
     If no more rewighting iteratios required, <code>active</code> is an empty tuple 
+
+    If the current `weighter` (`Weight` object) is specified, and it has the 
+    native C++ reweighter, the MC histograms for all plots (with the default projector) 
+    are filled with the current weights in one (multithreaded) pass, 
+    in this case `how` is an additional selection/weight, e.g. `''`: 
+    >>> active = makeWeights ( mctree , plots , ... , weighter = Weight ( ... ) , nthreads = 0 ) 
     """
 
     assert 0 < delta  , "makeWeights(%s): Invalid value for ``delta''  %s" % ( tag , delta  )
@@ -699,6 +735,10 @@ def makeWeights  ( dataset                    ,
     
     rows         = {}
     save_to_db = [] 
+
+    ## fused projection of MC for all plots in one pass 
+    fused = _fused_projection_ ( dataset , plots , weighter , nthreads , tag ) 
+    
     ## number of active plots for reweighting
     for wplot in plots  :
         
@@ -719,7 +759,7 @@ def makeWeights  ( dataset                    ,
         # =====================================================================
         ## make a plot on (MC) data with the weight
         # =====================================================================
-        hmc0 = projector ( dataset , hmc0 , what , how )
+        if not wplot in fused : hmc0 = projector ( dataset , hmc0 , what , how )
         
         st   = hmc0.stat()
         mnmx = st.minmax()
@@ -862,6 +902,50 @@ def makeWeights  ( dataset                    ,
     cmp_plots = tuple ( cmp_plots ) 
     return ( active , cmp_plots ) if make_plots else active
 
+# =============================================================================
+## fill MC histograms for all plots with the current weights in one pass
+#  using the native C++ reweighter
+#  @see Ostap::Utils::Reweighter::project
+#  @return the set of filled plots 
+def _fused_projection_ ( dataset , plots , weighter , nthreads = 1 , tag = 'Reweighting' ) :
+    """Fill MC histograms for all plots with the current weights in one pass
+    using the native C++ reweighter
+    - see Ostap.Utils.Reweighter.project
+    """
+    if not weighter or not isinstance ( weighter , Weight ) : return set()
+    if not isinstance ( dataset , ( ROOT.TTree , ROOT.RooAbsData ) )  : return set()
+    
+    rw = weighter.reweighter
+    if not rw :
+        logger.warning ( "%s: native reweighter is not available, use projectors" % tag )
+        return set()
+    
+    rw.clearPlots ()
+    fused = []
+    for wplot in plots :
+        if not wplot.projector is mc_data_projector : continue
+        what , how = wplot.what , wplot.how
+        if not isinstance ( what , string_types ) : continue 
+        if not isinstance ( how  , string_types ) : continue
+        ## attention! note reversed here! 
+        what = [ w.strip() for w in reversed ( split_string ( what , ',;:' ) ) ]
+        if len ( what ) != wplot.mc_histo.GetDimension() : continue
+        what += [ '' ] * ( 3 - len ( what ) )
+        rw.addPlot ( wplot.mc_histo , what [ 0 ] , what [ 1 ] , what [ 2 ] , how.strip() )
+        fused.append ( wplot )
+        
+    if not fused : return set()
+    
+    if isinstance ( dataset , ROOT.TTree ) : sc = rw.project ( dataset , nthreads )
+    else                                   : sc = rw.project ( dataset )
+    rw.clearPlots ()
+    
+    if sc.isFailure () :
+        logger.error ( "%s: error from Ostap.Utils.Reweighter.project %s, use projectors" % ( tag , sc ) )
+        return set()
+    
+    return set ( fused ) 
+
 # =============================================================================
 ## @class W2Tree
 #  Helper class to add the weight into <code>ROOT.TTree</code>
@@ -77,15 +77,109 @@ class Reweighter(object) :
                                   original_weight = original_weight , 
                                   target_weight   = target_weight   )
             
+    # =========================================================================
+    ## get the weights 
+    #  @param original        2D-array of data that needs to be reweighted ("MC")
+    #  @param original_weight 1D array of input weights for "MC" dataset
+    #  @see hep_ml.reweight.GBReweighter
     def weight ( self                   ,
                  original               ,
                  original_weight = None ) :
-
+        """Get the weights
+        - see hep_ml.reweight.GBReweighter
+        """
         with warnings.catch_warnings():
             warnings.simplefilter("ignore")    
             return self.reweighter.predict_weights (
                 original        = original         ,
                 original_weight = original_weight  ) 
+
+    # =========================================================================
+    ## get the weights for the tree/chain 
+    #  - the columns are read chunk-by-chunk (aligned with clusters) 
+    #    directly into numpy arrays, the next chunk is read in the 
+    #    background thread while the weights for the current one are calculated 
+    #  @code
+    #  rw   = ...
+    #  tree = ...
+    #  w    = rw.weight_tree ( tree , 'x y' , original_weight = 'w0' ) 
+    #  @endcode 
+    #  @param tree            the tree/chain 
+    #  @param variables       the variables/expressions (in the same order as for training) 
+    #  @param original_weight the expression for the input weights (or None)
+    #  @param chunk_size      the chunk size 
+    #  @see ostap.trees.trees._tt_eval_chunks_ 
+    #  @see Ostap::Trees::Getter::eval_range 
+    def weight_tree ( self                     ,
+                      tree                     ,
+                      variables                ,
+                      original_weight = None   ,
+                      chunk_size      = 100000 ,
+                      first           = 0      ,
+                      last            = -1     ) :
+        """Get the weights for the tree/chain
+        - the columns are read chunk-by-chunk (aligned with clusters) 
+        directly into numpy arrays, the next chunk is read in the 
+        background thread while the weights for the current one are calculated
+        >>> rw   = ...
+        >>> tree = ...
+        >>> w    = rw.weight_tree ( tree , 'x y' , original_weight = 'w0' ) 
+        - see Ostap::Trees::Getter::eval_range 
+        """
+        import numpy
+        import ostap.trees.trees 
+        from   ostap.core.core import split_string
+        
+        if isinstance ( variables , str ) : variables = split_string ( variables , ' ,;:' )
+        variables = list ( variables )
+        nvars     = len  ( variables ) 
+        assert not self.__nvars or self.__nvars == nvars , \
+               "Inconsistent number of variables: %d vs %d " % ( nvars , self.__nvars )          
+        
+        if original_weight : variables.append ( original_weight )
+        
+        if last < 0 : last = len ( tree ) 
+        last   = min ( last , len ( tree ) )
+        first  = max ( 0    , first       )
+        result = numpy.empty ( max ( 0 , last - first ) , dtype = float )
+        
+        for chunk , arr in tree.eval_chunks ( variables , chunk_size = chunk_size , first = first , last = last ) :
+            start , stop , _ = chunk.indices ( last )
+            if original_weight : w = self.weight ( arr [ : , : nvars ] , arr [ : , nvars ] )
+            else               : w = self.weight ( arr )
+            result [ start - first : stop - first ] = w
+            
+        return result
+
+    # =========================================================================
+    ## add the weights to the tree/chain as new branch
+    #  - the weights are calculated with <code>weight_tree</code> 
+    #  - the branch is written from the numpy buffer by <code>Ostap::Trees::add_branch</code> 
+    #  @code
+    #  rw   = ...
+    #  tree = ...
+    #  tree = rw.add_weight ( tree , 'w' , 'x y' ) 
+    #  @endcode 
+    #  @see Ostap::Trees::add_branch 
+    def add_weight ( self                     ,
+                     tree                     ,
+                     name                     ,
+                     variables                ,
+                     original_weight = None   ,
+                     chunk_size      = 100000 ,
+                     verbose         = True   ) :
+        """Add the weights to the tree/chain as new branch 
+        - the weights are calculated with `weight_tree` 
+        - the branch is written from the numpy buffer by `Ostap::Trees::add_branch`
+        >>> rw   = ...
+        >>> tree = ...
+        >>> tree = rw.add_weight ( tree , 'w' , 'x y' ) 
+        - see Ostap::Trees::add_branch 
+        """
+        weights = self.weight_tree ( tree , variables ,
+                                     original_weight = original_weight ,
+                                     chunk_size      = chunk_size      )
+        return tree.add_new_branch ( name , weights , verbose = verbose ) 
         
 # =============================================================================
 if '__main__' == __name__ :
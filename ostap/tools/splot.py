@@ -33,6 +33,7 @@ __date__    = "2019-05-14"
 __version__ = '$Revision$'
 __all__     = (
     'sPlot1D'  , ## 1D-splot
+    'sWeights' , ## sWeights for datasets and trees (C++ engine) 
     )
 # =============================================================================
 import ROOT
@@ -48,6 +49,8 @@ import ostap.fitting.roofitresult
 from   ostap.fitting.basic        import PDF,  Generic1D_pdf 
 from   ostap.fitting.variables    import FIXVAR
 from   ostap.histos.histos        import Histo1DFun 
+from   ostap.core.core            import Ostap
+from   ostap.math.base            import doubles 
 # =============================================================================
 #  @class sPlot1D
 #  Helper class to get <code>sWeigts</code> in a form of a historgams  or function objects.
@@ -96,7 +99,7 @@ class sPlot1D(object) :
         assert dataset or fitresult, 'Either dataset or fitresult must be specified!'
         
         assert isinstance ( pdf     , PDF              ) and \
-               isinstance ( pdf.pdf , ROOT.RooAddPdf   ) and \
+               isinstance ( pdf.pdf , ( ROOT.RooAddPdf , Ostap.MoreRooFit.AddPdf ) ) and \
                len ( pdf.alist1 ) ==  len ( pdf.alist2 )     , 'Invalid type of PDF!'
 
         cmps   = pdf.alist2 
@@ -189,6 +192,123 @@ class sPlot1D(object) :
         return self.__hweights
     
 
+# =============================================================================
+## @class sWeights
+#  Calculate sWeights for the dataset or tree using the C++ engine
+#  - the component PDFs are evaluated in one pass over data
+#  (for TTree several threads can be used), and the covariance
+#  matrix is inverted once
+#  - sWeights are attached as new variables/branches via
+#  <code>Ostap::Functions::add_var</code>/<code>Ostap::Trees::add_branch</code>
+#  @code
+#  dataset = ...
+#  pdf     = ...
+#  r , f   = pdf.fitTo ( dataset , ... ) ## fit with only yields floating 
+#  sw      = sWeights ( pdf , dataset )
+#  sw.add_to_dataset ( dataset ) 
+#  tree    = ...
+#  sw      = sWeights ( pdf , tree , nthreads = 0 )
+#  sw.add_to_tree    ( tree    ) 
+#  @endcode
+#  @see Ostap::Utils::SWeights
+#  @see Ostap::Functions::FuncSWeight
+#  @author Vanya  BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2023-03-14
+class sWeights(object) :
+    """ Calculate sWeights for the dataset or tree using the C++ engine
+    - the component PDFs are evaluated in one pass over data
+    (for TTree several threads can be used), and the covariance
+    matrix is inverted once
+    - sWeights are attached as new variables/branches via
+    `Ostap.Functions.add_var`/`Ostap.Trees.add_branch`
+    
+    >>> pdf     = ...
+    >>> r , f   = pdf.fitTo ( dataset , ... ) ## fit with only yields floating 
+    >>> sw      = sWeights ( pdf , dataset )
+    >>> sw.add_to_dataset ( dataset )
+    >>> sw      = sWeights ( pdf , tree , nthreads = 0 )
+    >>> sw.add_to_tree    ( tree    )
+    
+    - see Ostap.Utils.SWeights
+    - see Ostap.Functions.FuncSWeight
+    """
+    def __init__ ( self             ,
+                   pdf              ,
+                   data             ,   ## dataset or tree 
+                   fitresult = None ,   ## fit result to get the yields 
+                   nthreads  = 1    ) : ## number of threads for TTree
+        
+        assert isinstance ( pdf     , PDF              ) and \
+               isinstance ( pdf.pdf , ( ROOT.RooAddPdf , Ostap.MoreRooFit.AddPdf ) ) and \
+               len ( pdf.alist1 ) ==  len ( pdf.alist2 )     , 'Invalid type of PDF!'
+        
+        self.__names  = tuple ( c.name for c in pdf.alist2 ) 
+        if fitresult : yields = [ fitresult ( n ) [ 0 ].value() for n in self.__names ]
+        else         : yields = [ float ( c.getVal() )          for c in pdf.alist2   ]
+        
+        self.__engine = Ostap.Utils.SWeights ( pdf.alist1 , pdf.vars , doubles ( yields ) )
+
+        if   isinstance ( data , ROOT.TTree      ) : sc = self.__engine.fill ( data , nthreads )
+        elif isinstance ( data , ROOT.RooAbsData ) : sc = self.__engine.fill ( data )
+        else : raise TypeError ( "sWeights: invalid type of ``data'' %s" % type ( data ) )
+        
+        if sc.isFailure() or not self.__engine.ok() :
+            raise RuntimeError ( "sWeights: cannot calculate the covariance matrix, status %s" % sc )
+
+        ## the functions 
+        self.__funcs = {}
+        for i , n in enumerate ( self.__names ) :
+            self.__funcs [ n ] = Ostap.Functions.FuncSWeight ( self.__engine , i )
+
+    @property
+    def engine   ( self ) :
+        """``engine'' : the underlying C++ engine, Ostap.Utils.SWeights"""
+        return self.__engine
+    
+    @property
+    def names    ( self ) :
+        """``names'' : the names of components (yields)"""
+        return self.__names
+    
+    @property
+    def weights  ( self ) :
+        """``weights'' : sWeights as functions, Ostap.Functions.FuncSWeight"""
+        return self.__funcs
+    
+    @property
+    def cov      ( self ) :
+        """``cov'' : covariance matrix of yields, as dictionary { (n1,n2) : cov2 } """
+        return dict ( ( ( ni , nj ) , self.__engine.cov2 ( i , j ) )
+                      for i , ni in enumerate ( self.__names )
+                      for j , nj in enumerate ( self.__names ) )
+
+    # =========================================================================
+    ## add sWeights to the dataset as new variables: <code><name><suffix></code>
+    #  @code
+    #  sw.add_to_dataset ( dataset , suffix = '_sw' )
+    #  @endcode 
+    def add_to_dataset ( self , dataset , suffix = '_sw' ) :
+        """ Add sWeights to the dataset as new variables: `<name><suffix>`
+        >>> sw.add_to_dataset ( dataset , suffix = '_sw' )
+        """
+        for n in self.__names :
+            vv = Ostap.Functions.add_var ( dataset , n + suffix , self.__funcs [ n ] )
+            if not vv : logger.error ( 'add_to_dataset: NULLPTR from Ostap.Functions.add_var' )
+        return dataset
+    
+    # =========================================================================
+    ## add sWeights to the tree as new branches: <code><name><suffix></code>
+    #  @code
+    #  sw.add_to_tree ( tree , suffix = '_sw' )
+    #  @endcode 
+    def add_to_tree ( self , tree , suffix = '_sw' , verbose = True ) :
+        """ Add sWeights to the tree as new branches: `<name><suffix>`
+        >>> sw.add_to_tree ( tree , suffix = '_sw' )
+        """
+        import ostap.trees.trees
+        branches = dict ( ( n + suffix , self.__funcs [ n ] ) for n in self.__names )
+        return tree.add_new_branch ( branches , None , verbose = verbose )
+    
 ## =============================================================================
 if '__main__' == __name__ :
     
@@ -257,6 +257,13 @@ if rw :
     
     ## new weights 
     wnew = rw.weight ( original = dmc )
+
+    ## the same weights, reading the tree chunk-by-chunk 
+    with timing ( "Weights from the tree" , logger = logger ) : 
+        wtree = rw.weight_tree ( mc.chain , 'x y' , chunk_size = 10000 )
+    assert len ( wtree ) == len ( wnew ) and \
+           all ( abs ( a - b ) <= 1.e-8 * max ( 1.0 , abs ( a ) ) for a , b in zip ( wtree , wnew ) ) , \
+           'Mismatch in weights from the tree'
     mc.chain.add_new_branch ( 'w' , wnew )
     
     ## reload data 
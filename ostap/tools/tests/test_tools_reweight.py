@@ -156,6 +156,19 @@ for iter in range ( 1 , maxIter + 1  ) :
        ## 3) make MC-histogram 
        mcds .project  ( hmc , 'x' , 'weight'  )
 
+    with timing ( tag + ': fused projection of MC-dataset:' , logger = logger ) : 
+       # ==============================================================================
+       ## 3a) the same MC-histogram from the native reweighter (one pass) 
+       rw = weighter.reweighter
+       if rw : 
+           hmc2 = hmc.clone()
+           rw.addPlot ( hmc2 , 'x' )
+           rw.project ( mcds )
+           rw.clearPlots ()
+           for i in hmc :
+               assert abs ( hmc [ i ].value () - hmc2 [ i ].value () ) <= 1.e-6 * max ( 1.0 , abs ( hmc [ i ].value() ) ) , \
+                      'Mismatch in fused projection of MC for bin %s' % i 
+
     with timing ( tag + ': compare DATA and MC distributions:' , logger = logger ) :  
         # ==============================================================================
         ## 4) compare "Data" and "MC"  after the reweighting on the given iteration    
@@ -0,0 +1,147 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/tools/tests/test_tools_tmva_forest.py
+#  Test for the compiled TMVA BDT forests
+#  @see ostap.tools.tmva_forest
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date 2026-10-15
+# =============================================================================
+"""Test for the compiled TMVA BDT forests
+- see ostap.tools.tmva_forest
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = ()  ## nothing to be imported
+# =============================================================================
+import ROOT, os, random
+import ostap.io.root_file
+import ostap.trees.trees
+from   array                    import array
+from   ostap.core.core          import Ostap
+from   ostap.utils.cleanup      import CleanUp
+from   ostap.utils.timing       import timing
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' == __name__  or '__builtin__'  == __name__ :
+    logger = getLogger ( 'ostap.test_tools_tmva_forest' )
+else :
+    logger = getLogger ( __name__ )
+# =============================================================================
+data_file = CleanUp.tempfile ( suffix = '.root' , prefix = 'ostap-test-tools-tmva-forest-' )
+
+N = 5000
+with ROOT.TFile.Open ( data_file , 'recreate' ) as test_file :
+    test_file.cd()
+    treeSignal = ROOT.TTree ( 'S' , 'signal     tree' )
+    treeBkg    = ROOT.TTree ( 'B' , 'background tree' )
+    treeSignal.SetDirectory ( test_file )
+    treeBkg   .SetDirectory ( test_file )
+
+    var1 = array ( 'd' , [ 0 ] )
+    var2 = array ( 'd' , [ 0 ] )
+    for t in ( treeSignal , treeBkg ) :
+        t.Branch ( 'var1' , var1 , 'var1/D' )
+        t.Branch ( 'var2' , var2 , 'var2/D' )
+
+    for i in range ( N ) :
+        var1 [ 0 ] = random.uniform ( -2 , 2 )
+        var2 [ 0 ] = random.uniform ( -2 , 2 )
+        treeBkg.Fill ()
+        var1 [ 0 ] = random.gauss   (  0 , 0.5 )
+        var2 [ 0 ] = random.gauss   (  0 , 0.5 )
+        treeSignal.Fill ()
+
+    test_file.Write()
+
+# =============================================================================
+## train BDTs
+with ROOT.TFile.Open ( data_file , 'READ' ) as datafile :
+    from ostap.tools.tmva import Trainer
+    trainer = Trainer (
+        name      = 'TestForest' ,
+        methods   = [
+        ( ROOT.TMVA.Types.kBDT , "BDTG" , "H:!V:NTrees=200:MinNodeSize=2.5%:BoostType=Grad:Shrinkage=0.10:nCuts=20:MaxDepth=3" ) ,
+        ( ROOT.TMVA.Types.kBDT , "BDTA" , "H:!V:NTrees=100:MinNodeSize=5%:MaxDepth=3:BoostType=AdaBoost:SeparationType=GiniIndex:nCuts=20" ) ,
+        ( ROOT.TMVA.Types.kBDT , "BDTT" , "H:!V:NTrees=100:MaxDepth=3:BoostType=AdaBoost:VarTransform=D" ) ,
+        ] ,
+        variables  = [ 'var1' , 'var2' ] ,
+        signal     = datafile [ 'S' ]    ,
+        background = datafile [ 'B' ]    ,
+        verbose    = False               )
+    weights_files = trainer.train ()
+    tar_file      = trainer.tar_file
+
+# =============================================================================
+## compare the compiled forests with TMVA::Reader
+def test_forest_values () :
+
+    logger = getLogger ( 'test_forest_values' )
+
+    from ostap.tools.tmva        import Reader, WeightsFiles
+    from ostap.tools.tmva_forest import compile_forest
+
+    reader = Reader ( 'ForestReader' ,
+                      variables     = [ ( 'var1' , lambda s : s.var1 ) ,
+                                        ( 'var2' , lambda s : s.var2 ) ] ,
+                      weights_files = tar_file )
+
+    files = WeightsFiles ( tar_file ).files
+    for method in ( 'BDTG' , 'BDTA' ) :
+        forest = compile_forest ( files [ method ] )
+        assert forest , 'Forest is not compiled for %s' % method
+        logger.info ( 'Method %s: %d trees, %d nodes' % ( method , forest.ntrees () , forest.nnodes () ) )
+        fun = reader [ method ]
+        for i in range ( 1000 ) :
+            x , y = random.uniform ( -2 , 2 ) , random.uniform ( -2 , 2 )
+            r1 = fun    ( x , y )
+            r2 = forest ( [ x , y ] )
+            assert abs ( r1 - r2 ) < 1.e-6 , 'Invalid %s response %s vs %s' % ( method , r1 , r2 )
+
+    ## variable transformations are not supported
+    assert compile_forest ( files [ 'BDTT' ] ) is None , 'Transformed inputs are accepted!'
+
+    del reader
+
+# =============================================================================
+## add the responses to the tree
+def test_forest_response () :
+
+    logger = getLogger ( 'test_forest_response' )
+
+    from ostap.tools.tmva import addTMVAResponse
+
+    tmp1 = CleanUp.tempfile ( suffix = '.root' , prefix = 'ostap-test-tools-tmva-forest-' )
+    tmp2 = CleanUp.tempfile ( suffix = '.root' , prefix = 'ostap-test-tools-tmva-forest-' )
+
+    import shutil
+    shutil.copy ( data_file , tmp1 )
+    shutil.copy ( data_file , tmp2 )
+
+    chain1 = ROOT.TChain ( 'S' ) ; chain1.Add ( tmp1 )
+    chain2 = ROOT.TChain ( 'S' ) ; chain2.Add ( tmp2 )
+
+    with timing ( 'TMVA::Reader'     , logger = logger ) :
+        chain1 = addTMVAResponse ( chain1 , ( 'var1' , 'var2' ) , tar_file )
+    with timing ( 'Compiled forests' , logger = logger ) :
+        chain2 = addTMVAResponse ( chain2 , ( 'var1' , 'var2' ) , tar_file , compiled = True )
+
+    for method in ( 'BDTG' , 'BDTA' , 'BDTT' ) :
+        v = 'tmva_%s_response' % method
+        s1 = chain1.statVar ( v )
+        s2 = chain2.statVar ( v )
+        logger.info ( '%s: Reader %s, compiled %s' % ( method , s1.mean () , s2.mean () ) )
+        assert abs ( s1.mean ().value () - s2.mean ().value () ) < 1.e-6 , 'Invalid compiled response for %s' % method
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_forest_values   ()
+    test_forest_response ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -522,13 +522,19 @@ class Trainer(object):
     #  trainer.train ()
     #  @endcode  
     #  @return the name of output XML file with the weights 
-    def train ( self )  :
+    #  @param threaded the training runs in the worker thread:
+    #         no process-wide redirection of output, no implicit MT, 
+    #         no plots (to be made by the caller)
+    def train ( self , threaded = False )  :
         """ train TMVA 
         >>> trainer.train ()
         return the name of output XML files with the weights 
+        - `threaded` : the training runs in the worker thread:
+        no process-wide redirection of output, no implicit MT, 
+        no plots (to be made by the caller)
         """
 
-        log = self.logging 
+        log = self.logging if not threaded else False 
 
         self.__log_file = None
 
@@ -542,6 +548,11 @@ class Trainer(object):
             from ostap.logger.utils import TeeCpp , OutputC  
             context  = TeeCpp ( log ) if self.verbose and self.category in ( 0 , -1 ) else OutputC ( log , True , True ) 
 
+        elif threaded :
+
+            from ostap.logger.utils  import NoContext
+            context  = NoContext ()
+            
         else    :
 
             from ostap.logger.utils  import MuteC  , NoContext
@@ -552,7 +563,7 @@ class Trainer(object):
         from ostap.logger.utils import NoContext
         from ostap.utils.utils  import ImplicitMT
         
-        context2 = ImplicitMT ( True ) if self.multithread else NoContext () 
+        context2 = ImplicitMT ( True ) if self.multithread and not threaded else NoContext () 
 
         with context , context2 :
             
@@ -592,7 +603,7 @@ class Trainer(object):
                 if self.verbose : 
                     with tarfile.open ( self.tar_file , 'r' ) as tar : tar.list ()
 
-            if  self.make_plots : self.makePlots()
+            if  self.make_plots and not threaded : self.makePlots()
             
             return result
     
@@ -1396,8 +1407,8 @@ def _weights2map_ ( weights ) :
     return _map , weights  
 
 # =============================================================================
-def _add_response_tree  ( tree  , *args ) :
-    """Specific action to ROOT.TChain
+def _add_response_tree  ( tree  , *args , **kwargs ) :
+    """Specific action to ROOT.TTree
     """
             
     import ostap.trees.trees
@@ -1409,8 +1420,13 @@ def _add_response_tree  ( tree  , *args ) :
         
         tdir.cd()
         
-        sc = Ostap.TMVA.addResponse ( tree , *args  )
-        if sc.isFailure() : logger.error ( 'Error from Ostap::TMVA::addResponse %s' % sc )
+        nthreads = kwargs.get ( 'nthreads' , 1 )
+        if 1 == nthreads : 
+            sc = Ostap.TMVA.addResponse   ( tree , *args  )
+            if sc.isFailure() : logger.error ( 'Error from Ostap::TMVA::addResponse %s'   % sc )
+        else :
+            sc = Ostap.TMVA.addResponseMT ( tree , *( args + ( nthreads , ) ) )
+            if sc.isFailure() : logger.error ( 'Error from Ostap::TMVA::addResponseMT %s' % sc )
         
         if tfile.IsWritable() :
             tfile.Write( "" , ROOT.TFile.kOverwrite ) 
@@ -1421,7 +1437,7 @@ def _add_response_tree  ( tree  , *args ) :
         return sc , tree 
 
 # =============================================================================
-def _add_response_chain ( chain , *args ) :
+def _add_response_chain ( chain , *args , **kwargs ) :
     """Specific action to ROOT.TChain
     """
     
@@ -1444,7 +1460,7 @@ def _add_response_chain ( chain , *args ) :
             ## get the tree
             tt =   rfile.Get ( cname )
             ## treat the tree
-            sc , nt = _add_response_tree ( tt  , *args )
+            sc , nt = _add_response_tree ( tt  , *args , **kwargs )
             if status is None or sc.isFailure() : status = sc
             
     newc = ROOT.TChain ( cname )
@@ -1468,6 +1484,9 @@ def _add_response_chain ( chain , *args ) :
 #  @param options  options to be used in TMVA Reader
 #  @param verbose  verbose operation?
 #  @param aux       obligatory for the cuts method, where it represents the efficiency cutoff
+#  @param nthreads  number of threads for TTree/TChain (0: default, 1: sequential)
+#  @param compiled  use the compiled BDT forests for TTree/TChain, if possible
+#  @see ostap.tools.tmva_forest
 def addTMVAResponse ( dataset                ,   ## input dataset to be updated
                       inputs                 ,   ## input variables 
                       weights_files          ,   ## files with TMVA weigths (tar/gz or xml)
@@ -1475,13 +1494,21 @@ def addTMVAResponse ( dataset                ,   ## input dataset to be updated
                       suffix   = '_response' ,   ## suffix for TMVA-variable
                       options  = ''          ,   ## TMVA-reader options
                       verbose  = True        ,   ## verbosity flag 
-                      aux      = 0.9         ) : ## for Cuts method : efficiency cut-off
+                      aux      = 0.9         ,   ## for Cuts method : efficiency cut-off
+                      nthreads = 1           ,   ## number of threads for TTree/TChain 
+                      compiled = False       ) : ## use compiled BDT forests for TTree/TChain
     """
     Helper function to add TMVA  response into dataset
     >>> tar_file = trainer.tar_file
     >>> dataset  = ...
     >>> inputs = [ 'var1' , 'var2' , 'var2' ]
     >>> dataset.addTMVAResponse (  inputs , tar_file , prefix = 'tmva_' )
+    - for TTree/TChain the response can be calculated using several threads:
+    >>> dataset.addTMVAResponse (  inputs , tar_file , prefix = 'tmva_' , nthreads = 4 )
+    - for TTree/TChain the BDTs can be evaluated without TMVA::Reader,
+    using the compiled flattened forests (other methods use TMVA::Reader):
+    >>> dataset.addTMVAResponse (  inputs , tar_file , prefix = 'tmva_' , compiled = True )
+    - see ostap.tools.tmva_forest
     """
     assert dataset and isinstance ( dataset , ( ROOT.TTree , ROOT.RooAbsData ) ),\
            'Invalid dataset type!'
@@ -1493,6 +1520,16 @@ def addTMVAResponse ( dataset                ,   ## input dataset to be updated
     weights_files = WeightsFiles  ( weights_files ) 
     _map , _w     = _weights2map_ ( weights_files )
     
+    ## the compiled forests for BDTs
+    if compiled and isinstance ( dataset , ROOT.TTree ) :
+        from ostap.tools.tmva_forest import add_forest_response
+        inputs_  = dict ( ( str ( p.first ) , str ( p.second ) ) for p in _inputs )
+        weights_ = dict ( ( str ( p.first ) , str ( p.second ) ) for p in _map    )
+        dataset , others = add_forest_response ( dataset , inputs_ , weights_ , prefix , suffix )
+        if not others : return dataset
+        _map = std.map ( 'std::string', 'std::string' ) ()
+        for m in others : _map [ m ] = weights_ [ m ]
+    
     options = opts_replace   ( options , 'V:'      ,     verbose )
     options = opts_replace   ( options , 'Silent:' , not verbose )
     
@@ -1502,10 +1539,10 @@ def addTMVAResponse ( dataset                ,   ## input dataset to be updated
     args = dataset , _inputs, _map, options, prefix , suffix , aux
     
     if   isinstance ( dataset , ROOT.TChain     ) :
-        sc , newdata = _add_response_chain ( *args )
+        sc , newdata = _add_response_chain ( *args , nthreads = nthreads )
         if sc.isFailure() : logger.error ( 'Error from Ostap::TMVA::addResponse %s' % sc )
     elif isinstance ( dataset , ROOT.TTree      ) :
-        sc , newdata = _add_response_tree  ( *args )
+        sc , newdata = _add_response_tree  ( *args , nthreads = nthreads )
         if sc.isFailure() : logger.error ( 'Error from Ostap::TMVA::addResponse %s' % sc )        
     else                                          :
         sc = Ostap.TMVA.addResponse  ( *args )  
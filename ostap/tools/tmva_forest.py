@@ -0,0 +1,372 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file  ostap/tools/tmva_forest.py
+#  Compile the trained TMVA BDT (xml weights file) into the flattened
+#  native forest, that is evaluated without <code>TMVA::Reader</code>
+#  - all nodes of all trees are stored in one contiguous array
+#  - the evaluation is <code>const</code> and thread-safe,
+#    no per-thread clones of readers are needed
+#  - the flattened arrays are cached on disk, the key is the hash
+#    of the weights file, therefore the xml parsing is done only once
+#  @code
+#  forest   = compile_forest ( 'weights/TMVA_BDTG.weights.xml' )
+#  response = forest ( [ 1.0 , 2.0 , 3.0 ] )
+#  func     = forest_response ( 'weights/TMVA_BDTG.weights.xml' , { 'var1' : 'x' , 'var2' : 'y' , 'var3' : 'z' } )
+#  tree.add_new_branch ( 'bdtg' , func )
+#  @endcode
+#  Supported methods: BDT (AdaBoost, RealAdaBoost, Bagging and gradient
+#  boosting) for the classification without variable transformations
+#  and without Fisher cuts. For other methods <code>None</code> is returned
+#  and the standard <code>TMVA::Reader</code> needs to be used.
+#  @see Ostap::TMVA::Forest
+#  @see Ostap::TMVA::ForestResponse
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Compile the trained TMVA BDT (xml weights file) into the flattened
+native forest, that is evaluated without `TMVA::Reader`
+- all nodes of all trees are stored in one contiguous array
+- the evaluation is const and thread-safe,
+  no per-thread clones of readers are needed
+- the flattened arrays are cached on disk, the key is the hash
+  of the weights file, therefore the xml parsing is done only once
+
+>>> forest   = compile_forest ( 'weights/TMVA_BDTG.weights.xml' )
+>>> response = forest ( [ 1.0 , 2.0 , 3.0 ] )
+>>> func     = forest_response ( 'weights/TMVA_BDTG.weights.xml' , { 'var1' : 'x' , 'var2' : 'y' , 'var3' : 'z' } )
+>>> tree.add_new_branch ( 'bdtg' , func )
+
+Supported methods: BDT (AdaBoost, RealAdaBoost, Bagging and gradient
+boosting) for the classification without variable transformations
+and without Fisher cuts. For other methods None is returned
+and the standard `TMVA::Reader` needs to be used.
+- see Ostap::TMVA::Forest
+- see Ostap::TMVA::ForestResponse
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+__all__     = (
+    'parse_forest'        , ## parse xml weights file into the flattened arrays
+    'compile_forest'      , ## compile xml weights file into Ostap::TMVA::Forest
+    'forest_response'     , ## TTree-function for the compiled forest(s)
+    'add_forest_response' , ## add the responses of the compiled forests to TTree/TChain
+    )
+# =============================================================================
+import os, hashlib, pickle
+import xml.etree.ElementTree as ET
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.tools.tmva_forest' )
+else                       : logger = getLogger ( __name__                  )
+# =============================================================================
+## version of the format of the cached arrays
+_format_version = 1
+## the compiled forests in memory: { hash : forest }
+_forests        = {}
+# =============================================================================
+## parse the boolean option
+def _bool_ ( value ) :
+    return str ( value ).strip ().lower () in ( 'true' , '1' , 'yes' , 't' )
+
+# =============================================================================
+## flatten the tree, starting from the given xml-node
+#  @return index of the node
+def _flatten_ ( node , arrays , yesno , gradient ) :
+    """Flatten the tree, starting from the given xml-node
+    - return index of the node
+    """
+    var , cut , left , right , value = arrays
+
+    if 0 < int ( node.get ( 'NCoef' , 0 ) ) :
+        raise ValueError ( 'Fisher cuts are not supported' )
+
+    index = len ( var )
+    var  .append ( -1  )
+    cut  .append ( 0.0 )
+    left .append ( -1  )
+    right.append ( -1  )
+    value.append ( 0.0 )
+
+    ntype = int ( node.get ( 'nType' ) )
+    if 0 != ntype :
+        ## leaf
+        if   gradient : value [ index ] = float ( node.get ( 'res'    ) )
+        elif yesno    : value [ index ] = float ( ntype )
+        else          : value [ index ] = float ( node.get ( 'purity' ) )
+        return index
+
+    daughters = dict ( ( d.get ( 'pos' ) , d ) for d in node.findall ( 'Node' ) )
+    if not 'l' in daughters or not 'r' in daughters :
+        raise ValueError ( 'Invalid intermediate node' )
+
+    l = _flatten_ ( daughters [ 'l' ] , arrays , yesno , gradient )
+    r = _flatten_ ( daughters [ 'r' ] , arrays , yesno , gradient )
+
+    var [ index ] = int   ( node.get ( 'IVar' ) )
+    cut [ index ] = float ( node.get ( 'Cut'  ) )
+    ## TMVA: x>=cut goes right for cType=1, the cut type is inverted otherwise
+    if 1 == int ( node.get ( 'cType' , 1 ) ) : left [ index ] , right [ index ] = l , r
+    else                                     : left [ index ] , right [ index ] = r , l
+
+    return index
+
+# =============================================================================
+## parse the TMVA xml weights file into the flattened arrays
+#  @code
+#  data = parse_forest ( 'weights/TMVA_BDTG.weights.xml' )
+#  @endcode
+#  @return dictionary with flattened arrays or <code>None</code>,
+#  if the method is not supported
+def parse_forest ( xml_file ) :
+    """Parse the TMVA xml weights file into the flattened arrays
+    >>> data = parse_forest ( 'weights/TMVA_BDTG.weights.xml' )
+    - return dictionary with flattened arrays or None, if the method is not supported
+    """
+    root   = ET.parse ( xml_file ).getroot ()
+    method = root.get ( 'Method' , '' )
+    if not method.startswith ( 'BDT::' ) :
+        logger.debug ( 'parse_forest: method %s is not supported' % method )
+        return None
+
+    options  = dict ( ( o.get ( 'name' ) , ( o.text or '' ).strip () ) for o in root.iter ( 'Option' ) )
+    boost    = options.get ( 'BoostType' , 'AdaBoost' )
+    gradient = 'Grad' == boost
+    yesno    = _bool_ ( options.get ( 'UseYesNoLeaf' , True ) ) and not boost in ( 'RealAdaBoost' , 'Grad' )
+
+    transformations = root.find ( 'Transformations' )
+    if transformations is not None and 0 < int ( transformations.get ( 'NTransformations' , 0 ) ) :
+        logger.debug ( 'parse_forest: variable transformations are not supported for %s' % method )
+        return None
+
+    weights = root.find ( 'Weights' )
+    if weights is None or 0 != int ( weights.get ( 'AnalysisType' , 0 ) ) :
+        logger.debug ( 'parse_forest: only classification is supported for %s' % method )
+        return None
+
+    variables = []
+    for v in sorted ( root.find ( 'Variables' ).findall ( 'Variable' ) , key = lambda v : int ( v.get ( 'VarIndex' ) ) ) :
+        variables.append ( ( v.get ( 'Expression' ) , v.get ( 'Label' , v.get ( 'Expression' ) ) ) )
+
+    arrays = [] , [] , [] , [] , []
+    roots , boosts = [] , []
+    try :
+        for tree in weights.findall ( 'BinaryTree' ) :
+            top = tree.find ( 'Node' )
+            roots .append ( _flatten_ ( top , arrays , yesno , gradient ) )
+            boosts.append ( float ( tree.get ( 'boostWeight' , 1.0 ) ) )
+    except ValueError as e :
+        logger.debug ( 'parse_forest: %s for %s' % ( e , method ) )
+        return None
+
+    var , cut , left , right , value = arrays
+    return { 'method'    : method    ,
+             'variables' : tuple ( variables ) ,
+             'gradient'  : gradient  ,
+             'var'       : var       ,
+             'cut'       : cut       ,
+             'left'      : left      ,
+             'right'     : right     ,
+             'value'     : value     ,
+             'roots'     : roots     ,
+             'weights'   : boosts    }
+
+# =============================================================================
+## the hash of the weights file
+def _file_hash_ ( xml_file ) :
+    h = hashlib.sha1 ()
+    with open ( xml_file , 'rb' ) as f :
+        for block in iter ( lambda : f.read ( 1 << 20 ) , b'' ) : h.update ( block )
+    return '%s_v%d' % ( h.hexdigest () , _format_version )
+
+# =============================================================================
+## the directory for the cached flattened arrays
+def _cache_dir_ () :
+    from ostap.core.workdir import workdir
+    return os.path.join ( workdir , 'cache' , 'tmva' )
+
+# =============================================================================
+## get the flattened arrays: from the disk cache or from the xml file
+def _forest_data_ ( xml_file , key ) :
+    cache_file = os.path.join ( _cache_dir_ () , key + '.pkl' )
+    if os.path.exists ( cache_file ) :
+        try :
+            with open ( cache_file , 'rb' ) as f : return pickle.load ( f )
+        except Exception :
+            logger.warning ( "compile_forest: can't read cache file %s" % cache_file )
+
+    data = parse_forest ( xml_file )
+
+    ## store (also None for unsupported methods)
+    try :
+        cache_dir = os.path.dirname ( cache_file )
+        if not os.path.exists ( cache_dir ) : os.makedirs ( cache_dir )
+        tmp_file = '%s.%d' % ( cache_file , os.getpid () )
+        with open ( tmp_file , 'wb' ) as f : pickle.dump ( data , f )
+        os.rename ( tmp_file , cache_file )
+    except Exception :
+        logger.warning ( "compile_forest: can't write cache file %s" % cache_file )
+
+    return data
+
+# =============================================================================
+## compile the TMVA xml weights file into the native forest
+#  @code
+#  forest = compile_forest ( 'weights/TMVA_BDTG.weights.xml' )
+#  print ( forest ( [ 1.0 , 2.0 , 3.0 ] ) )
+#  @endcode
+#  @return <code>Ostap::TMVA::Forest</code> or <code>None</code>,
+#  if the method is not supported
+#  @see Ostap::TMVA::Forest
+def compile_forest ( xml_file ) :
+    """Compile the TMVA xml weights file into the native forest
+    >>> forest = compile_forest ( 'weights/TMVA_BDTG.weights.xml' )
+    >>> print ( forest ( [ 1.0 , 2.0 , 3.0 ] ) )
+    - return Ostap::TMVA::Forest or None, if the method is not supported
+    - see Ostap::TMVA::Forest
+    """
+    key = _file_hash_ ( xml_file )
+    if key in _forests : return _forests [ key ]
+
+    data = _forest_data_ ( xml_file , key )
+    if data is None :
+        _forests [ key ] = None
+        return None
+
+    from ostap.core.core  import Ostap
+    from ostap.math.base  import doubles, ints
+    forest = Ostap.TMVA.Forest ( len ( data [ 'variables' ] ) ,
+                                 ints    ( data [ 'var'     ] ) ,
+                                 doubles ( data [ 'cut'     ] ) ,
+                                 ints    ( data [ 'left'    ] ) ,
+                                 ints    ( data [ 'right'   ] ) ,
+                                 doubles ( data [ 'value'   ] ) ,
+                                 ints    ( data [ 'roots'   ] ) ,
+                                 doubles ( data [ 'weights' ] ) ,
+                                 data [ 'gradient' ] )
+    forest.variables = data [ 'variables' ]
+    _forests [ key ] = forest
+    return forest
+
+# =============================================================================
+## the input formulas in the order of the forest variables
+def _input_formulas_ ( forest , inputs ) :
+    result = []
+    for expression , label in forest.variables :
+        if   expression in inputs : result.append ( inputs [ expression ] )
+        elif label      in inputs : result.append ( inputs [ label      ] )
+        else : return None
+    return result
+
+# =============================================================================
+## create the TTree-function for the compiled forest(s)
+#  @code
+#  func = forest_response ( 'weights/TMVA_BDTG.weights.xml' , { 'var1' : 'x' , 'var2' : 'y' } )
+#  tree.add_new_branch ( 'bdtg' , func )
+#  @endcode
+#  For ``chopping'' the list of weights files (one per category)
+#  and the chopping expression are needed
+#  @code
+#  func = forest_response ( [ xml0 , xml1 , xml2 ] , inputs , chopping = 'evt%3' )
+#  @endcode
+#  @param xml_files the xml weights file or the list of files for chopping
+#  @param inputs    map { variable : formula }
+#  @param chopping  the chopping expression
+#  @return <code>Ostap::TMVA::ForestResponse</code> or <code>None</code>,
+#  if the method is not supported
+#  @see Ostap::TMVA::ForestResponse
+def forest_response ( xml_files , inputs , chopping = '' ) :
+    """Create the TTree-function for the compiled forest(s)
+    >>> func = forest_response ( 'weights/TMVA_BDTG.weights.xml' , { 'var1' : 'x' , 'var2' : 'y' } )
+    >>> tree.add_new_branch ( 'bdtg' , func )
+    For ``chopping'' the list of weights files (one per category)
+    and the chopping expression are needed
+    >>> func = forest_response ( [ xml0 , xml1 , xml2 ] , inputs , chopping = 'evt%3' )
+    - return Ostap::TMVA::ForestResponse or None, if the method is not supported
+    - see Ostap::TMVA::ForestResponse
+    """
+    from ostap.core.ostap_types import string_types
+    from ostap.core.core        import Ostap, std
+    from ostap.math.base        import strings
+
+    if isinstance ( xml_files , string_types ) : xml_files = [ xml_files ]
+    assert xml_files and ( chopping or 1 == len ( xml_files ) ) , \
+           'forest_response: chopping expression is required for several files'
+
+    forests = [ compile_forest ( f ) for f in xml_files ]
+    if any ( f is None for f in forests ) : return None
+
+    formulas = _input_formulas_ ( forests [ 0 ] , inputs )
+    if formulas is None : return None
+    if any ( f.variables != forests [ 0 ].variables for f in forests ) : return None
+
+    if not chopping :
+        result = Ostap.TMVA.ForestResponse ( forests [ 0 ] , strings ( formulas ) )
+    else :
+        VF = std.vector ( Ostap.TMVA.Forest )
+        vf = VF ()
+        for f in forests : vf.push_back ( f )
+        result = Ostap.TMVA.ForestResponse ( vf , chopping , strings ( formulas ) )
+
+    result._forests = forests
+    return result
+
+# =============================================================================
+## add the responses of the compiled forests to TTree/TChain
+#  - the branches <code>prefix+method+suffix</code> are added for
+#    all methods that can be compiled
+#  - for ``chopping'' the weights are the list (one per category)
+#    of the maps <code>{ method : xml }</code>, the category branch is added
+#    only if all methods are compiled
+#  @code
+#  tree , others = add_forest_response ( tree , inputs , { 'BDTG' : xml } , 'tmva_' , '_response' )
+#  @endcode
+#  @return the updated tree and the list of methods, that can't be compiled
+def add_forest_response ( tree , inputs , weights , prefix , suffix ,
+                          chopping = '' , category_name = '' ) :
+    """Add the responses of the compiled forests to TTree/TChain
+    - the branches `prefix+method+suffix` are added for all methods that can be compiled
+    - for ``chopping'' the weights are the list (one per category)
+    of the maps { method : xml }, the category branch is added
+    only if all methods are compiled
+    >>> tree , others = add_forest_response ( tree , inputs , { 'BDTG' : xml } , 'tmva_' , '_response' )
+    - return the updated tree and the list of methods, that can't be compiled
+    """
+    import ROOT
+    import ostap.trees.trees
+    from   ostap.core.core import ROOTCWD
+
+    categories = weights if chopping else [ weights ]
+    methods    = sorted ( categories [ 0 ].keys () )
+
+    branches , others = {} , []
+    for method in methods :
+        files = [ c [ method ] for c in categories ]
+        func  = forest_response ( files if chopping else files [ 0 ] , inputs , chopping )
+        if func is None : others.append ( method )
+        else            : branches [ prefix + method + suffix ] = func
+
+    if not branches : return tree , others
+
+    logger.info ( 'Compiled forests are used for %s' % ', '.join ( m for m in methods if not m in others ) )
+
+    if chopping and not others :
+        branches [ category_name ] = '(%s)%%%d' % ( chopping , len ( categories ) )
+
+    if isinstance ( tree , ROOT.TChain ) :
+        return tree.add_new_branch ( branches , None ) , others
+
+    tfile , tpath = tree.GetDirectory ().GetFile () , tree.path
+    tree.add_new_branch ( branches , None )
+    with ROOTCWD () :
+        return tfile.Get ( tpath ) , others
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -0,0 +1,353 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/trees/catalog.py
+#  Persistent catalog of ROOT files with trees:
+#  the number of entries, branches, leaves, cluster boundaries
+#  and compressed sizes of branches for trees
+#  - the records are keyed by the file name and validated with
+#    the file size and the modification time
+#  - the catalog is stored in <code>$OSTAP_DIR/cache/data_catalog.pkl</code>
+#    (or in the file specified via the <code>OSTAP_DATA_CATALOG</code>
+#     environment variable, empty value or <code>none</code> disables the persistency)
+#  @code
+#  from ostap.trees.catalog import catalog
+#  record = catalog().file_info ( 'a.root' , ( 'Bc/MyTree' , ) )
+#  print ( record [ 'trees' ] [ 'Bc/MyTree' ] [ 'entries' ] )
+#  @endcode
+#  @see ostap.trees.data_utils.Data
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2023-03-10
+# =============================================================================
+""" Persistent catalog of ROOT files with trees:
+the number of entries, branches, leaves, cluster boundaries
+and compressed sizes of branches for trees
+- the records are keyed by the file name and validated with
+  the file size and the modification time
+- the catalog is stored in `$OSTAP_DIR/cache/data_catalog.pkl`
+  (or in the file specified via the `OSTAP_DATA_CATALOG`
+  environment variable, empty value or `none` disables the persistency)
+
+>>> from ostap.trees.catalog import catalog
+>>> record = catalog().file_info ( 'a.root' , ( 'Bc/MyTree' , ) )
+>>> print ( record [ 'trees' ] [ 'Bc/MyTree' ] [ 'entries' ] )
+- see ostap.trees.data_utils.Data
+"""
+# =============================================================================
+__version__ = "$Revision$"
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2023-03-10"
+__all__     = (
+    'file_stat'  , ## get (size,mtime) for the file
+    'scan_file'  , ## open the file and create the record for trees
+    'valid'      , ## is the record valid ?
+    'io_cost'    , ## estimate the I/O cost (compressed bytes) for the range of entries 
+    'Catalog'    , ## persistent catalog of ROOT files
+    'catalog'    , ## default catalog
+    )
+# =============================================================================
+import ROOT, os
+# =============================================================================
+# logging
+# =============================================================================
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.trees.catalog' )
+else                       : logger = getLogger ( __name__              )
+# =============================================================================
+try :
+    import cPickle as pickle
+except ImportError :
+    import pickle
+# =============================================================================
+## protocols for remote (ROOT) files
+protocols = 'root:' , 'xroot:' , 'http:' , 'https:'
+## version of the records: records of other versions are invalid 
+_VERSION  = 2 
+# =============================================================================
+## get (size,mtime) for the file
+#  - for remote files the system helpers from ROOT are used
+#  @return (size,mtime) pair or <code>None</code>
+def file_stat ( the_file ) :
+    """Get (size,mtime) for the file
+    - for remote files the system helpers from ROOT are used
+    - return (size,mtime) pair or None
+    """
+    if not any ( the_file.startswith ( p ) for p in protocols ) :
+        try :
+            st = os.stat ( the_file )
+            return st.st_size , int ( st.st_mtime )
+        except OSError :
+            return None
+    ##
+    st = ROOT.FileStat_t ()
+    if 0 == ROOT.gSystem.GetPathInfo ( the_file , st ) :
+        return int ( st.fSize ) , int ( st.fMtime )
+    return None
+
+# =============================================================================
+## get the cluster boundaries for the tree
+def _clusters_ ( tree ) :
+    """Get the cluster boundaries for the tree
+    """
+    nentries = tree.GetEntries ()
+    result   = []
+    it       = tree.GetClusterIterator ( 0 )
+    start    = it.Next ()
+    while start < nentries :
+        if result and start <= result [ -1 ] : break
+        result.append ( start )
+        start = it.Next ()
+    result.append ( nentries )
+    return tuple ( result )
+
+# =============================================================================
+## open the file and create the record for the trees
+#  @code
+#  record = scan_file ( 'a.root' , ( 'Bc/MyTree' , ) )
+#  @endcode
+#  The record is a dictionary
+#  - <code>'stat'</code>  : (size,mtime) pair for the file
+#  - <code>'trees'</code> : dictionary <code>{ name : info }</code>
+#    where  <code>info</code> is dictionary with keys
+#    <code>'entries'</code>, <code>'branches'</code>,
+#    <code>'leaves'</code>, <code>'clusters'</code> and
+#    <code>'zipbytes'</code> (compressed size for each top-level branch)
+#  For missing/invalid trees the number of entries is zero
+#  @return the record or <code>None</code> if file cannot be opened
+def scan_file ( the_file , trees , stat = None ) :
+    """Open the file and create the record for the trees
+    >>> record = scan_file ( 'a.root' , ( 'Bc/MyTree' , ) )
+    The record is a dictionary
+    - 'stat'  : (size,mtime) pair for the file
+    - 'trees' : dictionary { name : info }, where `info` is dictionary with keys
+      'entries', 'branches', 'leaves', 'clusters' and
+      'zipbytes' (compressed size for each top-level branch)
+    For missing/invalid trees the number of entries is zero
+    - return the record or None if the file cannot be opened
+    """
+
+    ## we will need Ostap machinery for trees&chains here
+    import ostap.trees.trees
+
+    if stat is None : stat = file_stat ( the_file )
+
+    ## suppress Warning/Error messages from ROOT
+    from ostap.logger.utils import rootError
+    with rootError() :
+
+        rfile = ROOT.TFile.Open ( the_file , 'READ' )
+        if not rfile or rfile.IsZombie () : return None
+
+        infos = {}
+        for name in trees :
+
+            tree = rfile.Get ( name )
+            if not tree or not isinstance ( tree , ROOT.TTree ) :
+                infos [ name ] = { 'entries' : 0 , 'branches' : () , 'leaves'   : () ,
+                                   'clusters' : () , 'zipbytes' : {} }
+                continue
+
+            zipbytes = {}
+            for b in tree.GetListOfBranches () :
+                zipbytes [ b.GetName () ] = int ( b.GetZipBytes ( '*' ) )
+                
+            infos [ name ] = { 'entries'  : int   ( tree.GetEntries () ) ,
+                               'branches' : tuple ( tree.branches   () ) ,
+                               'leaves'   : tuple ( tree.leaves     () ) ,
+                               'clusters' : _clusters_ ( tree )          ,
+                               'zipbytes' : zipbytes                     }
+            del tree
+
+        rfile.Close ()
+
+    return { 'stat' : stat , 'trees' : infos , 'version' : _VERSION }
+
+# =============================================================================
+## Is the record valid for the given (size,mtime) pair and trees?
+def valid ( record , stat , trees ) :
+    """Is the record valid for the given (size,mtime) pair and trees?
+    """
+    return bool ( record and stat and record.get ( 'stat' , None ) == stat and \
+                  _VERSION == record.get ( 'version' , 0 ) and \
+                  all ( t in record [ 'trees' ] for t in trees ) )
+
+# =============================================================================
+## estimate the I/O cost (compressed bytes) for the range of entries
+#  @code
+#  info = record [ 'trees' ] [ 'Bc/MyTree' ]
+#  cost = io_cost ( info , 0 , 1000 , branches = ( 'pt' , 'eta' ) ) 
+#  @endcode
+#  @param info     the info for the tree, see scan_file 
+#  @param first    the first entry
+#  @param last     the last entry (not included), negative: till the end 
+#  @param branches the branches to be read (all branches, if not specified) 
+#  @return the estimated number of compressed bytes to be read 
+def io_cost ( info , first = 0 , last = -1 , branches = () ) :
+    """Estimate the I/O cost (compressed bytes) for the range of entries
+    >>> info = record [ 'trees' ] [ 'Bc/MyTree' ]
+    >>> cost = io_cost ( info , 0 , 1000 , branches = ( 'pt' , 'eta' ) ) 
+    - info     : the info for the tree, see scan_file 
+    - first    : the first entry
+    - last     : the last entry (not included), negative: till the end 
+    - branches : the branches to be read (all branches, if not specified) 
+    - return the estimated number of compressed bytes to be read 
+    """
+    nentries = info [ 'entries' ]
+    if not nentries : return 0
+    
+    zipbytes = info.get ( 'zipbytes' , {} )
+    if branches : size = sum ( zipbytes.get ( b , 0 ) for b in branches )
+    else        : size = sum ( zipbytes.values () )
+    
+    if last < 0 or nentries < last : last = nentries
+    first = max ( 0 , first )
+    if last <= first : return 0 
+    
+    ## the baskets are read by clusters 
+    clusters = info.get ( 'clusters' , () ) 
+    if clusters : 
+        first = max ( c for c in clusters if c <= first )
+        last  = min ( c for c in clusters if c >= last  )
+        
+    return size * float ( last - first ) / nentries
+
+# =============================================================================
+## @class Catalog
+#  Persistent catalog of ROOT files with trees
+#  @code
+#  cat    = Catalog ( 'my_catalog.pkl' )
+#  record = cat.file_info ( 'a.root' , ( 'Bc/MyTree' , ) )
+#  cat.save ()
+#  @endcode
+#  @see scan_file
+class Catalog(object) :
+    """Persistent catalog of ROOT files with trees
+    >>> cat    = Catalog ( 'my_catalog.pkl' )
+    >>> record = cat.file_info ( 'a.root' , ( 'Bc/MyTree' , ) )
+    >>> cat.save ()
+    - see scan_file
+    """
+    def __init__ ( self , filename = None ) :
+
+        self.__filename = filename
+        self.__records  = {}
+        self.__updated  = {}
+
+        if self.__filename and os.path.exists ( self.__filename ) :
+            self.__records = self.__load ()
+
+    ## load records from the file
+    def __load ( self ) :
+        try :
+            with open ( self.__filename , 'rb' ) as f :
+                records = pickle.load ( f )
+                return records if isinstance ( records , dict ) else {}
+        except Exception :
+            logger.warning ( "Catalog: cannot load ``%s''" % self.__filename )
+            return {}
+
+    @property
+    def filename ( self ) :
+        """``filename'' : the file name for the persistent catalog"""
+        return self.__filename
+
+    ## get the (unvalidated) record for the file
+    def record ( self , the_file ) :
+        """Get the (unvalidated) record for the file
+        """
+        return self.__records.get ( the_file , None )
+
+    # =========================================================================
+    ## get the valid record for the file: from the catalog or from the file itself
+    #  @code
+    #  cat    = ...
+    #  record = cat.file_info ( 'a.root' , ( 'Bc/MyTree' , ) )
+    #  @endcode
+    def file_info ( self , the_file , trees ) :
+        """Get the valid record for the file: from the catalog or from the file itself
+        >>> cat    = ...
+        >>> record = cat.file_info ( 'a.root' , ( 'Bc/MyTree' , ) )
+        """
+        stat   = file_stat ( the_file )
+        record = self.__records.get ( the_file , None )
+        if valid ( record , stat , trees ) : return record
+        ##
+        if record and record.get ( 'stat' , None ) == stat :
+            ## add missing trees
+            trees = tuple ( set ( trees ) | set ( record [ 'trees' ].keys () ) )
+        record = scan_file ( the_file , trees , stat = stat )
+        self.update ( the_file , record )
+        return record
+
+    # =========================================================================
+    ## update the catalog with the new record
+    def update ( self , the_file , record ) :
+        """Update the catalog with the new record"""
+        if record and record.get ( 'stat' , None ) :
+            self.__records [ the_file ] = record
+            self.__updated [ the_file ] = record
+
+    # =========================================================================
+    ## save the updated records into the persistent file
+    #  - the records, added by other processes in between, are preserved
+    def save ( self ) :
+        """Save the updated records into the persistent file
+        - the records, added by other processes in between, are preserved
+        """
+        if not self.__filename or not self.__updated : return
+
+        records = self.__load () if os.path.exists ( self.__filename ) else {}
+        records.update ( self.__updated )
+
+        tmpfile = '%s.%d.tmp' % ( self.__filename , os.getpid () )
+        try :
+            dirname = os.path.dirname ( self.__filename )
+            if dirname and not os.path.exists ( dirname ) : os.makedirs ( dirname )
+            with open ( tmpfile , 'wb' ) as f :
+                pickle.dump ( records , f , 2 )
+            ## atomic replacement
+            if hasattr ( os , 'replace' ) : os.replace ( tmpfile , self.__filename )
+            else                          : os.rename  ( tmpfile , self.__filename )
+        except Exception :
+            logger.warning ( "Catalog: cannot save ``%s''" % self.__filename )
+            if os.path.exists ( tmpfile ) : os.remove ( tmpfile )
+            return
+
+        self.__records.update ( records )
+        self.__updated = {}
+
+    def __len__      ( self ) : return len ( self.__records )
+    def __contains__ ( self , the_file ) : return the_file in self.__records
+
+# =============================================================================
+## the name of the default persistent catalog
+def _default_filename_ () :
+    """The name of the default persistent catalog"""
+    fname = os.environ.get ( 'OSTAP_DATA_CATALOG' , None )
+    if fname is None :
+        from ostap.core.workdir import workdir
+        return os.path.join ( workdir , 'cache' , 'data_catalog.pkl' )
+    if not fname or fname.lower() in ( 'none' , 'no' , 'false' ) : return None
+    return os.path.abspath ( os.path.expandvars ( os.path.expanduser ( fname ) ) )
+
+_catalog = None
+# =============================================================================
+## get the default catalog
+def catalog () :
+    """Get the default catalog"""
+    global _catalog
+    if _catalog is None :
+        _catalog = Catalog ( _default_filename_ () )
+        import atexit
+        atexit.register ( _catalog.save )
+    return _catalog
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
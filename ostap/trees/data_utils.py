@@ -595,6 +595,9 @@ class Data(Files):
     >>> data  = Data('Bc/MyTree', '*.root' )
     >>> chain = data.chain
     >>> flist = data.files 
+    - with `parallel = True` the files are validated in parallel
+    - with `cache = True` the entries, branches and cluster boundaries
+      are taken from the persistent catalog (and stored there), see `ostap.trees.catalog`
     """
     def __init__( self                 ,
                   chain                ,
@@ -602,7 +605,9 @@ class Data(Files):
                   description  = ''    , 
                   maxfiles     = -1    ,
                   check        = True  , 
-                  silent       = False ) : 
+                  silent       = False ,
+                  parallel     = False ,
+                  cache        = True  ) : 
 
         ## we will need Ostap machinery for trees&chains here
         import ostap.trees.trees 
@@ -610,7 +615,9 @@ class Data(Files):
         ## decorate files 
         if isinstance ( files , str ) : files = [ files ]
 
-        self.__check = True if check else False
+        self.__check    = True if check    else False
+        self.__parallel = True if parallel else False
+        self.__cache    = True if cache    else False
         
         ## chain name 
         self.__chain_name = chain if isinstance ( chain , str ) else chain.name 
@@ -618,6 +625,11 @@ class Data(Files):
         ## list of problematic files 
         self.__bad_files  = set()
 
+        ## records for files: entries, branches, clusters, see ostap.trees.catalog 
+        self.__records    = {}
+        ## reference (the first good file) to check the trees
+        self.__reference  = {}
+
         ## update description
         if not description : description = "ROOT.TChain(%s)" % self.chain_name 
         
@@ -639,10 +651,126 @@ class Data(Files):
     @property
     def chain ( self ) :
         """``chain'' : (re)built and return `TChain` object"""
-        ch = ROOT.TChain( self.chain_name )
-        for f in self.files : ch.Add ( f )
+        return self.make_chain ( self.chain_name , self.files )
+
+    @property
+    def parallel ( self ) :
+        """``parallel'' : validate files in parallel?"""
+        return self.__parallel
+    
+    @property
+    def cache ( self ) :
+        """``cache'' : use the persistent catalog of files?"""
+        return self.__cache
+
+    @property
+    def tree_names ( self ) :
+        """``tree_names'' : names of all trees to be checked in files"""
+        return self.chain_name ,
+    
+    # =========================================================================
+    ## make the chain using the known numbers of entries (no need to open files)
+    def make_chain ( self , name , files ) :
+        """Make the chain using the known numbers of entries (no need to open files)
+        """
+        ch = ROOT.TChain ( name )
+        for f in files :
+            n = self.entries ( f , name )
+            if 0 < n : ch.Add ( f , n )
+            else     : ch.Add ( f     )
         return ch
     
+    # =========================================================================
+    ## get the record for the file: entries, branches, leaves and cluster boundaries
+    #  @code
+    #  data   = ...
+    #  record = data.file_info ( 'a.root' )
+    #  print ( record [ 'trees' ] [ data.chain_name ] [ 'clusters' ] ) 
+    #  @endcode
+    #  @see ostap.trees.catalog.scan_file
+    def file_info ( self , the_file ) :
+        """Get the record for the file: entries, branches, leaves and cluster boundaries
+        >>> data   = ...
+        >>> record = data.file_info ( 'a.root' )
+        >>> print ( record [ 'trees' ] [ data.chain_name ] [ 'clusters' ] ) 
+        - see ostap.trees.catalog.scan_file 
+        """
+        record = self.__records.get ( the_file , None )
+        if record : return record
+        
+        if self.cache :
+            from ostap.trees.catalog import catalog
+            record = catalog().file_info ( the_file , self.tree_names )
+        else :
+            from ostap.trees.catalog import scan_file 
+            record = scan_file ( the_file , self.tree_names )
+            
+        if record : self.__records [ the_file ] = record
+        return record 
+
+    # =========================================================================
+    ## get the number of entries in the tree from the known record (no IO)
+    #  @return number of entries or -1 if not known 
+    def entries ( self , the_file , tree = None ) :
+        """Get the number of entries in the tree from the known record (no IO)
+        - return number of entries or -1 if not known 
+        """
+        record = self.__records.get ( the_file , None )
+        if not record : return -1
+        info   = record [ 'trees' ].get ( tree if tree else self.chain_name , None )
+        return info [ 'entries' ] if info else -1
+
+    # =========================================================================
+    ## get the cluster boundaries for the tree (e.g. for parallel job splitting)
+    #  @code
+    #  data     = ...
+    #  clusters = data.clusters ( 'a.root' )
+    #  @endcode 
+    def clusters ( self , the_file , tree = None ) :
+        """Get the cluster boundaries for the tree (e.g. for parallel job splitting)
+        >>> data     = ...
+        >>> clusters = data.clusters ( 'a.root' )
+        """
+        record = self.file_info ( the_file )
+        if not record : return () 
+        info   = record [ 'trees' ].get ( tree if tree else self.chain_name , None )
+        return info [ 'clusters' ] if info else () 
+
+    # =========================================================================
+    ## add files: validate them in parallel (if required) and update the catalog
+    def add_files ( self , files , max_files = -1 ) :
+        """ Add files/patterns to data collector
+        - validate them in parallel (if required) and update the catalog
+        """
+        if isinstance ( files  , str ) : files  = [ files  ]
+        
+        files = tuple ( sorted ( set ( files ) ) )
+        todo  = tuple ( f for f in files if not f in self.__records ) 
+
+        if self.parallel and 1 < len ( todo ) and max_files < 0 :
+            
+            known = {}
+            if self.cache :
+                from ostap.trees.catalog import catalog
+                cat   = catalog ()
+                for f in todo :
+                    r = cat.record ( f )
+                    if r : known [ f ] = r 
+                    
+            from ostap.parallel.parallel_catalog import scan_files
+            records = scan_files ( todo , self.tree_names , records = known , progress = not self.silent )
+            
+            for f , r in records.items () :
+                if not r : continue
+                self.__records [ f ] = r 
+                if self.cache and not r is known.get ( f , None ) : cat.update ( f , r )
+                    
+        Files.add_files ( self , files , max_files )
+
+        if self.cache :
+            from ostap.trees.catalog import catalog
+            catalog().save()
+    
     @property
     def bad_files ( self ) :
         """``bad_files'' : list of bad files"""
@@ -660,21 +788,55 @@ class Data(Files):
 
         if tree1 and tree2 :
             
-            branches1 = set ( tree1.branches () )                
-            leaves1   = set ( tree1.leaves   () )
+            Data.check_branches ( tree1.GetName ()    ,
+                                  tree1.branches () , tree1.leaves () ,
+                                  tree2.branches () , tree2.leaves () , the_file )
+
+    ## check the content of the two trees, given by their records 
+    @staticmethod 
+    def check_infos ( name , info1 , info2 , the_file = '' ) :
+
+        if info1 and info2 :
             
-            branches2 = set ( tree2.branches () )                
-            leaves2   = set ( tree2.leaves   () )
+            Data.check_branches ( name , 
+                                  info1 [ 'branches' ] , info1 [ 'leaves' ] ,
+                                  info2 [ 'branches' ] , info2 [ 'leaves' ] , the_file )
 
-            if branches1 != branches2 :
-                missing = list ( sorted ( branches1 - branches2 ) ) 
-                extra   = list ( sorted ( branches2 - branches1 ) ) 
-                logger.warning ( "Tree('%s'): missing/extra branches %s/%s in %s" %  ( tree1.GetName() , missing , extra , the_file ) )
-                
-            if ( ( branches1 != leaves1 ) or ( branches2 != leaves2 ) ) and leaves1 != leaves2 :
-                missing = list ( sorted ( leaves1 - leaves2 ) )
-                extra   = list ( sorted ( leaves2 - leaves1 ) ) 
-                logger.warning ( "Tree('%s'): missing/extra leaves   %s/%s in %s" %  ( tree1.GetName() , missing , extra , the_file ) )
+    ## check branches and leaves of two trees 
+    @staticmethod 
+    def check_branches ( name , branches1 , leaves1 , branches2 , leaves2 , the_file = '' ) :
+        
+        branches1 = set ( branches1 )
+        leaves1   = set ( leaves1   )
+        branches2 = set ( branches2 )
+        leaves2   = set ( leaves2   )
+        
+        if branches1 != branches2 :
+            missing = list ( sorted ( branches1 - branches2 ) ) 
+            extra   = list ( sorted ( branches2 - branches1 ) ) 
+            logger.warning ( "Tree('%s'): missing/extra branches %s/%s in %s" %  ( name , missing , extra , the_file ) )
+            
+        if ( ( branches1 != leaves1 ) or ( branches2 != leaves2 ) ) and leaves1 != leaves2 :
+            missing = list ( sorted ( leaves1 - leaves2 ) )
+            extra   = list ( sorted ( leaves2 - leaves1 ) ) 
+            logger.warning ( "Tree('%s'): missing/extra leaves   %s/%s in %s" %  ( name , missing , extra , the_file ) )
+
+    # =========================================================================
+    ## get the info for the tree in the file (and update the reference) 
+    def tree_info ( self , the_file , tree = None ) :
+        """Get the info for the tree in the file (and update the reference)
+        - the reference is the first good file: the same as for `TChain`
+        """
+        tree   = tree if tree else self.chain_name
+        record = self.file_info ( the_file )
+        info   = record [ 'trees' ].get ( tree , None ) if record else None
+        if not info or not info [ 'entries' ] : return None
+        ##
+        ref    = self.__reference.get ( tree , None ) 
+        if   ref is None : self.__reference [ tree ] = info 
+        elif self.check  : self.check_infos ( tree , ref , info , the_file )
+        ##
+        return info 
 
                 
     ## the specific action for each file 
@@ -682,30 +844,15 @@ class Data(Files):
         """Add the file to TChain
         """
 
-        ## suppress Warning/Error messages from ROOT 
-        from ostap.logger.utils import rootError
-        with rootError() :
-
-            ## new temporary chani/tree 
-            tree  = ROOT.TChain ( self.chain_name )
-            tree.Add ( the_file )
-
-            ok = len ( tree ) 
-            if  ok :
-                
-                if self.check and self.files :
-                    chain = self.chain 
-                    self.check_trees ( chain , tree , the_file )
-                    del chain
-                    
-                Files.treatFile  ( self  ,        the_file )
-                
-            else : 
-                self.__bad_files.add ( the_file )
-                if not self.silent : 
-                    logger.warning ( "No/empty chain  '%s' in file '%s'" % ( self.chain_name , the_file ) )
-                    
-            del tree
+        ok = self.tree_info ( the_file , self.chain_name ) 
+        if  ok :
+            
+            Files.treatFile  ( self  ,        the_file )
+            
+        else : 
+            self.__bad_files.add ( the_file )
+            if not self.silent : 
+                logger.warning ( "No/empty chain  '%s' in file '%s'" % ( self.chain_name , the_file ) )
 
             
     ## printout 
@@ -761,7 +908,9 @@ class Data2(Data):
                   description = ''    ,
                   maxfiles    = -1    ,
                   check       = True  , 
-                  silent      = False ) :
+                  silent      = False ,
+                  parallel    = False ,
+                  cache       = True  ) :
 
         ## decorate files 
         if isinstance ( files , str ) : files = [ files ]
@@ -783,7 +932,9 @@ class Data2(Data):
                        description = description ,
                        maxfiles    = maxfiles    ,
                        check       = check       ,
-                       silent      = silent      )
+                       silent      = silent      ,
+                       parallel    = parallel    ,
+                       cache       = cache       )
         
     @property 
     def files1    ( self ) :
@@ -817,9 +968,12 @@ class Data2(Data):
     def chain2 ( self ) :
         """``chain2'' : (re)built and return the second `TChain` object (same as ``chain'')
         """
-        ch = ROOT.TChain( self.chain2_name )
-        for f in self.files2 : ch.Add ( f )
-        return ch
+        return self.make_chain ( self.chain2_name , self.files2 )
+
+    @property
+    def tree_names ( self ) :
+        """``tree_names'' : names of all trees to be checked in files"""
+        return self.chain1_name , self.chain2_name 
     
     @property
     def bad_files1 ( self ) :
@@ -839,54 +993,33 @@ class Data2(Data):
         """Add the file to TChain
         """
         
-        ## suppress Warning/Error messages from ROOT 
-        from ostap.logger.utils import rootError
-        with rootError() :
+        ok1 = self.tree_info ( the_file , self.chain1_name )
+        ok2 = self.tree_info ( the_file , self.chain2_name )
             
-            tree1 = ROOT.TChain ( self.chain1_name  )
-            tree1.Add ( the_file )
+        if  ok1 and ok2      :
             
-            tree2 = ROOT.TChain ( self.chain2_name  )
-            tree2.Add ( the_file )
-
-            ok1 = len ( tree1 )
-            if self.check and self.files1 and ok1 :
-                chain1 = self.chain1 
-                self.check_trees ( tree1 , chain1 , the_file )
-                del chain1
-                
-            ok2 = len ( tree2 )            
-            if self.check and self.files2 and ok2 :
-                chain2 = self.chain2 
-                self.check_trees ( tree2 , chain2 , the_file )
-                del chain2
-                
-            if  ok1 and ok2      :
-                
-                Files.treatFile ( self , the_file ) 
-                
-            elif ok2 :
-                
-                self.bad_files1.add ( the_file  )
-                if not self.silent : 
-                    logger.warning ( "No/empty chain1 '%s'      in file '%s'" % ( self.chain1_name , the_file ) )
+            Files.treatFile ( self , the_file ) 
+            
+        elif ok2 :
+            
+            self.bad_files1.add ( the_file  )
+            if not self.silent : 
+                logger.warning ( "No/empty chain1 '%s'      in file '%s'" % ( self.chain1_name , the_file ) )
 
-            elif ok1 :
-                
-                self.bad_files2.add ( the_file )
-                if not self.silent : 
-                    logger.warning ( "No/empty chain2 '%s'      in file '%s'" % ( self.chain2_name , the_file ) ) 
+        elif ok1 :
+            
+            self.bad_files2.add ( the_file )
+            if not self.silent : 
+                logger.warning ( "No/empty chain2 '%s'      in file '%s'" % ( self.chain2_name , the_file ) ) 
 
-            else :
-                
-                self.bad_files1.add ( the_file )
-                self.bad_files2.add ( the_file )
-                if not self.silent :                 
-                    logger.warning ( "No/empty chains '%s'/'%s' in file '%s'" % ( self.chain1_name ,
-                                                                                  self.chain2_name , the_file ) )
-            del tree1
-            del tree2
+        else :
             
+            self.bad_files1.add ( the_file )
+            self.bad_files2.add ( the_file )
+            if not self.silent :                 
+                logger.warning ( "No/empty chains '%s'/'%s' in file '%s'" % ( self.chain1_name ,
+                                                                              self.chain2_name , the_file ) )
+        
     ## printout 
     def __str__(self):
 
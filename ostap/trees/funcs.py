@@ -17,6 +17,7 @@ __all__     = (
     'PyTreeFunction'    , ## 'TTree-function' that uses python function/callable 
     'PyTreeArray'       , ## 'TTree-function' that uses python function/callable 
     "pyfun_tree"        , ## ditto, but as fnuction 
+    "native_fun_tree"   , ## 'TTree-function' from the compiled (numba/ctypes/cffi) function 
     'PyDataFunction'    , ## 'Data-function' that uses python function/callable
     "pyfun_data"        , ## ditto, but as fnuction 
     'FuncFormula'       , ## simple wrapper over TTreeFormula/Ostap::Formula  
@@ -217,6 +218,54 @@ def pyfun_tree ( function , tree = None ) :
     """
     return PyTreeFunction ( function , tree ) 
     
+# =================================================================================
+## create the Ostap.ITreeFunc object from the compiled function
+#  (<code>numba.cfunc</code>, <code>ctypes</code> or <code>cffi</code>) 
+#  of 1, 2 or 3 variables: the function is called directly from C++,
+#  without Python and GIL
+#  @code
+#  @numba.cfunc ( "float64(float64,float64)" )
+#  def ququ ( pz , pt ) : return pz/pt 
+#  fun = native_fun_tree ( ququ , 'pz' , 'pt' )
+#  tree.add_new_branch ( 'ratio' , fun ) 
+#  @endcode
+#  @see Ostap::Functions::Func1D
+#  @see Ostap::Functions::Func2D
+#  @see Ostap::Functions::Func3D
+#  @see ostap.math.native 
+def native_fun_tree ( function , *expressions , **kwargs ) :
+    """Create the Ostap.ITreeFunc object from the compiled function
+    (`numba.cfunc`, `ctypes` or `cffi`) of 1, 2 or 3 variables:
+    the function is called directly from C++, without Python and GIL
+    >>> @numba.cfunc ( 'float64(float64,float64)' )
+    ... def ququ ( pz , pt ) : return pz/pt 
+    >>> fun = native_fun_tree ( ququ , 'pz' , 'pt' )
+    >>> tree.add_new_branch ( 'ratio' , fun ) 
+    - see Ostap::Functions::Func1D
+    - see Ostap::Functions::Func2D
+    - see Ostap::Functions::Func3D
+    - see ostap.math.native 
+    """
+    from ostap.math.native import native_function
+    native = native_function ( function )
+    assert native , "native_fun_tree: the function is not compiled: %s" % function 
+
+    types = { 1 : ( Ostap.Functions.NativeFunction1 , Ostap.Functions.Func1D ) ,
+              2 : ( Ostap.Functions.NativeFunction2 , Ostap.Functions.Func2D ) ,
+              3 : ( Ostap.Functions.NativeFunction3 , Ostap.Functions.Func3D ) }
+    
+    ntype , ftype = types [ len ( expressions ) ]
+    assert isinstance ( native , ntype ) , \
+           "native_fun_tree: mismatch in number of variables: %s" % list ( expressions )
+
+    tree   = kwargs.pop ( 'tree' , None )
+    assert not kwargs , "native_fun_tree: unknown arguments %s" % list ( kwargs.keys () )
+    if tree is None : tree = ROOT.nullptr
+    
+    result = ftype ( native , *( expressions + ( tree , ) ) )
+    result._native = native ## keep the compiled function alive 
+    return result 
+    
 # =================================================================================
 ## create the Ostap.IDataFunc obejct from python function/callable
 #  @code
@@ -249,6 +298,36 @@ FuncRooFormula = Ostap.Functions.FuncRooFormula
 FuncTH1        = Ostap.Functions.FuncTH1
 FuncTH2        = Ostap.Functions.FuncTH2
 FuncTH3        = Ostap.Functions.FuncTH3
+
+# =================================================================================
+## evaluate the TTree-function for the block of entries [first,last)
+#  @code
+#  fun    = FuncTH2 ( histo , 'pt' , 'eta' , tree ) 
+#  values = fun.eval_range ( tree , 0 , 10000 ) 
+#  @endcode
+#  @see Ostap::IFuncTree::evaluate_range
+def _ft_eval_range_ ( func , tree , first = 0 , last = -1 ) :
+    """Evaluate the TTree-function for the block of entries [first,last)
+    >>> fun    = FuncTH2 ( histo , 'pt' , 'eta' , tree ) 
+    >>> values = fun.eval_range ( tree , 0 , 10000 ) 
+    - see Ostap::IFuncTree::evaluate_range
+    """
+    from array import array 
+    nentries = tree.GetEntries() 
+    if last  < 0 or nentries < last : last = nentries
+    if last <= first : return array ( 'd' )
+    result   = array ( 'd' , ( last - first ) * [ 0.0 ] )
+    n        = func.evaluate_range ( tree , first , last , result )
+    return result [ : n ]
+
+Ostap.IFuncTree.eval_range = _ft_eval_range_
+
+_decorated_classes_ = (
+    Ostap.IFuncTree ,
+    )
+_new_methods_       = (
+    Ostap.IFuncTree.eval_range , 
+    )
          
 # =============================================================================
 if '__main__' == __name__ :
@@ -18,7 +18,7 @@ __all__     = (
   ) 
 # =============================================================================
 import ROOT
-from   ostap.core.core   import Ostap
+from   ostap.core.core   import Ostap, std 
 import ostap.math.models
 # =============================================================================
 # logging 
@@ -29,6 +29,24 @@ else                       : logger = getLogger( __name__ )
 # =============================================================================
 _large = 2**64 -1 
 # =============================================================================
+## one-pass (multithreaded) parameterization with optional covariance matrix 
+#  @see Ostap::DataParam::parameterizeMT
+def _parameterize_mt_ ( func , tree , expressions , cut , nthreads , covariance , first , last ) :
+    """One-pass (multithreaded) parameterization with optional covariance matrix 
+    - see Ostap.DataParam.parameterizeMT
+    """
+    cov2 = std.vector('double')() if covariance else ROOT.nullptr
+    args = ( tree , func ) + tuple ( expressions ) + ( str ( cut ) , nthreads , cov2 , first , last )
+    sumw = Ostap.DataParam.parameterizeMT ( *args )
+    if not covariance : return sumw
+    ## 
+    n   = func.npars ()
+    mtx = ROOT.TMatrixDSym ( n )
+    for i in range ( n ) :
+        for j in range ( n ) :
+            mtx [ i ][ j ] = cov2 [ i * n + j ]
+    return sumw , mtx 
+# =============================================================================
 ## parameterize 1D unbinned ddistribution from TTree in terms of Legendre sum
 #  @code
 #  l = LegendreSum ( 5 , -1.0 , 1.0 )
@@ -40,13 +58,22 @@ _large = 2**64 -1
 def _l1_parameterize_ ( l1   ,
                         tree ,
                         var  ,
-                        cut = '' , first = 0 , last = _large ) :
+                        cut = '' , first = 0 , last = _large ,
+                        nthreads = 1 , covariance = False ) :
     """Parameterize 1D unbinned ddistribution from TTree in terms of Legendre sum
     
     >>> l = LegendreSum ( 5 , -1.0 , 1.0 )
     >>> tree = ...
     >>> l.parameterize ( tree , 'X' , 'Y>0' ) 
+
+    - for `nthreads!=1` or `covariance=True` the one-pass multithreaded
+    accumulation is used, and with `covariance=True` the tuple
+    `(sumw, covariance-matrix)` is returned
+    
+    >>> sumw , cov2 = l.parameterize ( tree , 'X' , 'Y>0' , nthreads = 8 , covariance = True ) 
     """
+    if 1 != nthreads or covariance :
+        return _parameterize_mt_ ( l1 , tree , ( var , ) , cut , nthreads , covariance , first , last )
     return Ostap.DataParam.parameterize ( tree        , l1    ,
                                           var         ,
                                           str ( cut ) , first , last )
@@ -64,13 +91,17 @@ def _l2_parameterize_ ( l2   ,
                         tree ,
                         xvar ,
                         yvar ,
-                        cut = '' , first = 0 , last = _large ) :
+                        cut = '' , first = 0 , last = _large ,
+                        nthreads = 1 , covariance = False ) :
     """Parameterize 2D unbinned ddistribution from TTree in terms of Legendre sum
     
     >>> l = LegendreSum3 ( 5 , 3 , -1.0 , 1.0 , 0.0 , 1.0  )
     >>> tree = ...
     >>> l.parameterize ( tree , 'X' , 'Y' , 'Z>0' ) 
+    - see `_l1_parameterize_` for `nthreads` and `covariance` 
     """
+    if 1 != nthreads or covariance :
+        return _parameterize_mt_ ( l2 , tree , ( xvar , yvar ) , cut , nthreads , covariance , first , last )
     return Ostap.DataParam.parameterize ( tree        , l2    ,
                                           xvar        , yvar  ,
                                           str ( cut ) , first , last )
@@ -89,13 +120,17 @@ def _l3_parameterize_ ( l3   ,
                         xvar ,
                         yvar ,
                         zvar ,
-                        cut = '' , first = 0 , last = _large ) :
+                        cut = '' , first = 0 , last = _large ,
+                        nthreads = 1 , covariance = False ) :
     """Parameterize 3D unbinned ddistribution from TTree in terms of Legendre sum
     
     >>> l = LegendreSum3 ( 5 , 3 , 2 , -1.0 , 1.0 , 0.0 , 1.0  , 0.0 , 5.0 )
     >>> tree = ...
     >>> l.parameterize ( tree , 'X' , 'Y' , 'Z' , 'T>0' ) 
+    - see `_l1_parameterize_` for `nthreads` and `covariance` 
     """
+    if 1 != nthreads or covariance :
+        return _parameterize_mt_ ( l3 , tree , ( xvar , yvar , zvar ) , cut , nthreads , covariance , first , last )
     return Ostap.DataParam.parameterize ( tree        , l3    ,
                                           xvar        , yvar  , zvar ,
                                           str ( cut ) , first , last )
@@ -115,13 +150,17 @@ def _l4_parameterize_ ( l4   ,
                         yvar ,
                         zvar ,
                         uvar ,
-                        cut = '' , first = 0 , last = _large ) :
+                        cut = '' , first = 0 , last = _large ,
+                        nthreads = 1 , covariance = False ) :
     """Parameterize 4D unbinned ddistribuition from TTree in terms of Legendre sum
     
     >>> l = LegendreSum4 ( 5 , 3 , 2 , 2 , -1.0 , 1.0 , 0.0 , 1.0  , 0.0 , 5.0 , 0.0 , 1.0 )
     >>> tree = ...
     >>> l.parameterize ( tree , 'X' , 'Y' , 'Z' , 'U' , 'q>0' ) 
+    - see `_l1_parameterize_` for `nthreads` and `covariance` 
     """
+    if 1 != nthreads or covariance :
+        return _parameterize_mt_ ( l4 , tree , ( xvar , yvar , zvar , uvar ) , cut , nthreads , covariance , first , last )
     return Ostap.DataParam.parameterize ( tree        , l4    ,
                                           xvar        , yvar  , zvar , uvar ,
                                           str ( cut ) , first , last )
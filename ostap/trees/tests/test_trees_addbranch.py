@@ -131,6 +131,48 @@ def test_addbranch() :
     assert 'Et2' in data.chain , "Branch ``Et2'' is  not here!"
     assert 'Et3' in data.chain , "Branch ``Et3'' is  not here!"
 
+    # =========================================================================
+    ## 2'') add float branches and shared formulas 
+    # =========================================================================
+    with timing ('float' , logger = logger ) :          
+        chain = data.chain  
+        chain.add_new_branch ( { 'Ft1/F' : 'sqrt(pt*pt+mass*mass)' ,
+                                 'Ft2'   : 'sqrt(pt*pt+mass*mass)' } , None )
+    ## reload the chain and check: 
+    chain = data.chain 
+    assert 'Ft1' in chain , "Branch ``Ft1'' is  not here!"
+    assert 'Ft2' in chain , "Branch ``Ft2'' is  not here!"
+    for entry in chain :
+        assert abs ( entry.Ft1 - entry.Et1 ) < 1.e-5 * entry.Et1 , "Branch ``Ft1'' differs from ``Et1''!"
+        assert abs ( entry.Ft2 - entry.Et1 ) < 1.e-10            , "Branch ``Ft2'' differs from ``Et1''!"
+
+    # =========================================================================
+    ## 2') add several new branches as TTree-formula using several threads 
+    # =========================================================================
+    with timing ('multithreaded' , logger = logger ) :          
+        chain = data.chain  
+        chain.add_new_branch ( { 'Mt1' : 'sqrt(pt*pt+mass*mass)'   ,
+                                 'Mt2' : 'sqrt(pt*pt+mass*mass)*2' } , None , nthreads = 2 )
+    ## reload the chain and check: 
+    chain = data.chain 
+    assert 'Mt1' in chain , "Branch ``Mt1'' is  not here!"
+    assert 'Mt2' in chain , "Branch ``Mt2'' is  not here!"
+    for entry in chain :
+        assert abs ( entry.Mt1 - entry.Et1 ) < 1.e-10 , "Branch ``Mt1'' differs from ``Et1''!"
+        assert abs ( entry.Mt2 - entry.Et2 ) < 1.e-10 , "Branch ``Mt2'' differs from ``Et2''!"
+
+    # =========================================================================
+    ## 2'') add new branch as TTree-formula, processing files concurrently 
+    # =========================================================================
+    with timing ('concurrent files' , logger = logger ) :          
+        chain = data.chain  
+        chain.add_new_branch ( 'Ct1' , 'sqrt(pt*pt+mass*mass)' , nthreads = 0 )
+    ## reload the chain and check: 
+    chain = data.chain 
+    assert 'Ct1' in chain , "Branch ``Ct1'' is  not here!"
+    for entry in chain :
+        assert abs ( entry.Ct1 - entry.Et1 ) < 1.e-10 , "Branch ``Ct1'' differs from ``Et1''!"
+
     # =========================================================================
     ## 2) add new branch as pure python function 
     # =========================================================================
@@ -156,6 +198,13 @@ def test_addbranch() :
     logger.info ( 'With histogram:\n%s' % data.chain.table ( prefix = '# ' ) )
     assert 'ptw' in data.chain , "Branch ``ptw'' is  not here!"
 
+    ## batched evaluation over the chain agrees with the branch 
+    chain  = data.chain 
+    values = ptw.eval_range ( chain )
+    assert len ( values ) == len ( chain ) , "Invalid length of batched evaluation!"
+    for v , entry in zip ( values , chain ) :
+        assert abs ( v - entry.ptw ) < 1.e-10 , "Batched evaluation differs from ``ptw''!"
+
     # =========================================================================
     ## 4) add the variable sampled from the histogram
     # =========================================================================
@@ -298,10 +347,68 @@ def test_addbranch() :
 
     
         
+# =============================================================================
+## add the polarization angles in a single batched pass 
+def test_addbranch_polarization () :
+    """Add the polarization angles in a single batched pass 
+    """
+    try :
+        import numpy 
+    except ImportError :
+        logger.warning ( 'numpy is not available, skip the test' )
+        return
+    
+    from ostap.core.core     import Ostap, ROOTCWD 
+    from ostap.utils.cleanup import CleanUp    
+    import ostap.io.root_file
+    
+    fname = CleanUp.tempfile ( prefix = 'ostap-test-trees-polarization-' , suffix = '.root' )
+    names = 'mpx' , 'mpy' , 'mpz' , 'me' , 'ppx' , 'ppy' , 'ppz' , 'pe'
+    vars  = dict ( ( n , array.array ( 'd' , [ 0 ] ) ) for n in names )
+
+    N       = 1000
+    vectors = [] 
+    with ROOTCWD() , ROOT.TFile.Open( fname , 'new' ) as root_file:
+        root_file.cd () 
+        tree = ROOT.TTree ( 'P' , 'tree' )
+        tree.SetDirectory ( root_file  ) 
+        for n in names : tree.Branch ( n , vars [ n ] , '%s/D' % n )
+        for i in range ( N ) :
+            m  = Ostap.LorentzVector ( random.gauss ( 0 , 2 ) , random.gauss ( 0 , 2 ) , random.uniform ( 20 , 100 ) , 0 )
+            m.SetE ( ( m.P2 () + 3.1**2 ) ** 0.5 )
+            p  = Ostap.LorentzVector ( random.gauss ( 0 , 1 ) , random.gauss ( 0 , 1 ) , random.uniform ( 5 , 50 ) , 0 )
+            p.SetE ( ( p.P2 () + 0.105**2 ) ** 0.5 )
+            for n , v in zip ( names , ( m.Px() , m.Py() , m.Pz() , m.E() , p.Px() , p.Py() , p.Pz() , p.E() ) ) :
+                vars [ n ] [ 0 ] = v 
+            vectors.append ( ( p , m ) )
+            tree.Fill()
+        root_file.Write()
+
+    beam1 = Ostap.LorentzVector ( 0 , 0 ,  3500 , 3500 )
+    beam2 = Ostap.LorentzVector ( 0 , 0 , -3500 , 3500 )
+
+    data = Data ( 'P' , fname )
+    with timing ( 'Polarization angles' , logger = logger ) :
+        data.chain.add_polarization_angles ( names [ 4 : ] , names [ : 4 ] , beam1 , beam2 ,
+                                             frame = 'CS' , names = ( 'cos_cs' , 'phi_cs' ) )
+        
+    data  = Data ( 'P' , fname )
+    chain = data.chain 
+    assert 'cos_cs' in chain and 'phi_cs' in chain , 'Polarization branches are not here!'
+
+    CS = Ostap.Math.Polarization.Frames.CollinsSoper
+    for i , entry in enumerate ( chain ) :
+        if 0 != i % 50 : continue 
+        p , m = vectors [ i ] 
+        a     = Ostap.Math.Polarization.angles ( p , CS , m , beam1 , beam2 )
+        assert abs ( a.cos_theta - entry.cos_cs ) < 1.e-6 and abs ( math.sin ( a.phi - entry.phi_cs ) ) < 1.e-6 , \
+               'Mismatch in polarization angles for entry %d' % i 
+        
 # =============================================================================
 if '__main__' ==  __name__  :
 
     test_addbranch()
+    test_addbranch_polarization ()
     
 # =============================================================================
 ##                                                                      The END 
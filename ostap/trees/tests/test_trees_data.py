@@ -0,0 +1,97 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# @file ostap/trees/tests/test_trees_data.py
+# Copyright (c) Ostap developers.
+# =============================================================================
+""" Test module for ostap/trees/data_utils.py and ostap/trees/catalog.py
+- validation of files and the persistent catalog
+"""
+# =============================================================================
+# logging
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'test_trees_data' )
+else                       : logger = getLogger ( __name__          )
+# =============================================================================
+import ROOT, random, os 
+import ostap.io.root_file
+from   ostap.utils.cleanup    import CleanUp
+## do not pollute the default persistent catalog with temporary files 
+if not 'OSTAP_DATA_CATALOG' in os.environ :
+    os.environ [ 'OSTAP_DATA_CATALOG' ] = CleanUp.tempfile ( prefix = 'ostap-test-trees-catalog-' , suffix = '.pkl' )
+from   ostap.trees.data_utils import Data
+from   ostap.trees.catalog    import Catalog, scan_file, io_cost
+from   ostap.trees.trees      import Chain, cluster_slices 
+from   array                  import array
+# =============================================================================
+## create the file with a tree
+def create_file ( nentries ) :
+
+    fname = CleanUp.tempfile ( prefix = 'ostap-test-trees-data-' , suffix = '.root' )
+    var   = array ( 'd' , [ 0 ] )
+    with ROOT.TFile.Open ( fname , 'new' ) as root_file :
+        tree = ROOT.TTree ( 'S' , 'tree' )
+        tree.SetDirectory ( root_file )
+        tree.Branch ( 'x' , var , 'x/D' )
+        for i in range ( nentries ) :
+            var [ 0 ] = random.gauss ( 0 , 1 )
+            tree.Fill ()
+        root_file.Write ()
+    return fname
+
+# =============================================================================
+def test_trees_data () :
+
+    logger = getLogger ( 'test_trees_data' )
+
+    sizes = 100 , 200 , 0 , 500
+    files = [ create_file ( n ) for n in sizes ]
+
+    ## record for the file
+    record = scan_file ( files [ 0 ] , ( 'S' , 'Q' ) )
+    info   = record [ 'trees' ] [ 'S' ]
+    assert 100 == info [ 'entries' ]                    , 'Invalid number of entries!'
+    assert 'x' in info [ 'branches' ]                   , 'Invalid list of branches!'
+    assert 100 == info [ 'clusters' ] [ -1 ]            , 'Invalid cluster boundaries!'
+    assert 0   == record [ 'trees' ] [ 'Q' ] [ 'entries' ] , 'Missing tree must have no entries!'
+    assert 0   <  info [ 'zipbytes' ] [ 'x' ]           , 'Invalid compressed size!'
+    assert io_cost ( info ) == info [ 'zipbytes' ] [ 'x' ] , 'Invalid I/O cost!'
+
+    ## persistent catalog
+    catname = CleanUp.tempfile ( prefix = 'ostap-test-trees-catalog-' , suffix = '.pkl' )
+    cat1    = Catalog ( catname )
+    for f in files : cat1.file_info ( f , ( 'S' , ) )
+    cat1.save ()
+
+    cat2    = Catalog ( catname )
+    assert len ( cat2 ) == len ( files ) , 'Catalog is not persistent!'
+    for f , n in zip ( files , sizes ) :
+        assert cat2.record ( f ) [ 'trees' ] [ 'S' ] [ 'entries' ] == n , 'Invalid record in catalog!'
+
+    ## data with/without cache
+    d1 = Data ( 'S' , files , cache = False , silent = True )
+    d2 = Data ( 'S' , files , cache = True  , silent = True )
+
+    for d in ( d1 , d2 ) :
+        logger.info ( 'Data: %s' % d )
+        assert len ( d.files     ) == 3               , 'Invalid number of good files!'
+        assert len ( d.bad_files ) == 1               , 'Invalid number of bad files!'
+        assert len ( d.chain     ) == sum ( sizes )   , 'Invalid number of entries!'
+        assert d.clusters ( files [ -1 ] ) [ -1 ] == 500 , 'Invalid clusters!'
+
+    ## I/O cost and cluster-aligned splitting 
+    chain = Chain ( d2.chain )
+    assert 0 < chain.io_cost ( branches = ( 'x' , ) ) , 'Invalid I/O cost!'
+    slices = list ( cluster_slices ( ( 0 , 100 , 250 , 300 , 1000 ) , 0 , 1000 , 120 ) )
+    assert 100 == slices [ 0 ].stop and 250 == slices [ 1 ].stop and 1000 == slices [ -1 ].stop , \
+           'Slices are not aligned with clusters!'
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_trees_data ()
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -0,0 +1,208 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# @file ostap/trees/tests/test_trees_formula.py
+# Copyright (c) Ostap developers.
+# ============================================================================= 
+""" Test module for compiled and decomposed Ostap::Formula 
+"""
+# ============================================================================= 
+# logging 
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'test_trees_formula' )
+else                       : logger = getLogger ( __name__            )
+# ============================================================================= 
+import ROOT, random 
+from   ostap.core.core import Ostap
+
+# =============================================================================
+## create the tree in memory 
+def make_tree () :
+    
+    tree = ROOT.TTree ( 'ftree' , 'tree for formula test' )
+
+    from array import array 
+    x = array ( 'd' , [ 0 ] )
+    y = array ( 'f' , [ 0 ] )
+    n = array ( 'i' , [ 0 ] )
+    tree.Branch ( 'x' , x , 'x/D' )
+    tree.Branch ( 'y' , y , 'y/F' )
+    tree.Branch ( 'n' , n , 'n/I' )
+    
+    for i in range ( 1000 ) :
+        x [ 0 ] = random.gauss   ( 0 , 1 )
+        y [ 0 ] = random.uniform ( 0 , 5 )
+        n [ 0 ] = random.randint ( 0 , 10 )
+        tree.Fill () 
+
+    ## the local buffers are going out of scope 
+    tree.ResetBranchAddresses () 
+    return tree
+
+# =============================================================================
+## compare interpreted and compiled formulas 
+def test_formula () :
+
+    tree = make_tree ()
+    
+    expressions = ( 'x+y*2'                  ,
+                    'sqrt(y)>1&&n<3'         ,
+                    '1/2*y+n'                ,
+                    'n=5'                    ,
+                    'TMath::Exp(-abs(x))*n'  ,
+                    'min(x,y)-max(x,y)'      ,  
+                    'x**2'                  ) ## not compiled 
+
+    old = Ostap.Formula.jit () 
+    try :
+        formulas = []
+        for e in expressions :
+            Ostap.Formula.setJIT ( False )
+            f1 = Ostap.Formula ( 'i' , e , tree ) 
+            Ostap.Formula.setJIT ( True  )
+            f2 = Ostap.Formula ( 'c' , e , tree )
+            assert not f1.compiled () , "Formula '%s' must not be compiled!" % e 
+            logger.info ( "Formula '%s' is compiled: %s" % ( e , f2.compiled () ) )
+            formulas.append ( ( e , f1 , f2 ) )
+    finally :
+        Ostap.Formula.setJIT ( old )
+            
+    for i in range ( len ( tree ) ) :
+        tree.GetEntry ( i )
+        for e , f1 , f2 in formulas :
+            v1 = f1.evaluate ()
+            v2 = f2.evaluate ()
+            assert abs ( v1 - v2 ) <= 1.e-5 * max ( 1 , abs ( v1 ) ) , \
+                   "Mismatch for '%s' at #%d: %s vs %s" % ( e , i , v1 , v2 )
+            
+    logger.info ( 'Compiled and interpreted formulas agree' ) 
+
+# =============================================================================
+## compare compound and adaptively decomposed selections 
+def test_adaptive () :
+
+    tree = make_tree ()
+
+    ## the last conjunct rejects ~99% of events: it must go first after learning 
+    cuts = ( 'x>-2 && n>=0 && y>4.95' , 'y>1 && x>0 && n<3' , '(y>1)&&((x>0)&&(n<3))' , '(y>1&&x>0)||n<3' , 'x>0' )
+    
+    old = Ostap.Formula.adaptive () 
+    try :
+        formulas = []
+        for c in cuts :
+            Ostap.Formula.setAdaptive ( False )
+            f1 = Ostap.Formula ( 'i' , c , tree ) 
+            Ostap.Formula.setAdaptive ( True  )
+            f2 = Ostap.Formula ( 'a' , c , tree )
+            assert 0 == f1.nTerms () , "Selection '%s' must not be decomposed!" % c 
+            formulas.append ( ( c , f1 , f2 ) )
+    finally :
+        Ostap.Formula.setAdaptive ( old )
+
+    assert 3 == formulas [ 0 ][ 2 ].nTerms () , 'Invalid number of conjuncts!'
+    assert 3 == formulas [ 1 ][ 2 ].nTerms () , 'Invalid number of conjuncts!'
+    assert 3 == formulas [ 2 ][ 2 ].nTerms () , 'Invalid number of conjuncts!'
+    assert 0 == formulas [ 3 ][ 2 ].nTerms () , 'Top-level OR must not be decomposed!'
+    assert 0 == formulas [ 4 ][ 2 ].nTerms () , 'Simple cut must not be decomposed!'
+
+    order = [ str ( t ) for t in formulas [ 0 ][ 2 ].terms () ]
+    assert order == [ 'x>-2' , 'n>=0' , 'y>4.95' ] , 'Invalid initial order %s' % order 
+    
+    ## load the entries the same way as Ostap::StatVar does;
+    ## two passes to complete the learning phase (1024 evaluations)
+    for p in range ( 2 ) :
+        for i in range ( len ( tree ) ) :
+            assert 0 <= tree.LoadTree ( i ) , 'Cannot load entry #%d' % i 
+            for c , f1 , f2 in formulas :
+                v1 = f1.evaluate ()
+                v2 = f2.evaluate ()
+                assert v1 == v2 , "Mismatch for '%s' at #%d: %s vs %s" % ( c , i , v1 , v2 )
+
+    order = [ str ( t ) for t in formulas [ 0 ][ 2 ].terms () ]
+    assert sorted ( order ) == [ 'n>=0' , 'x>-2' , 'y>4.95' ] , 'Invalid conjuncts %s' % order 
+    assert 'y>4.95' == order [  0 ] , 'The most rejecting conjunct must go first: %s' % order 
+    assert 'n>=0'   == order [ -1 ] , 'The never rejecting conjunct must go last: %s'  % order 
+    logger.info ( 'Compound and decomposed selections agree, order: %s' % order ) 
+
+# =============================================================================
+## evaluate the range of entries in one go 
+def test_eval_range () :
+
+    import ostap.trees.trees 
+    tree = make_tree ()
+    
+    vars   = 'x x+y n*y'
+    first , last = 10 , 900 
+    rows   = tree.eval_range ( vars , first , last )
+    cols   = tree.eval_range ( vars , first , last , rowmajor = False )
+    assert rows.shape == ( last - first , 3 ), 'Invalid shape %s' % str ( rows.shape )
+    assert ( rows == cols ).all () , 'Row- and column-major results differ!'
+
+    for i , row in enumerate ( tree.rows ( vars , first = first , last = last ) ) :
+        assert ( row == rows [ i ] ).all () , 'Mismatch at #%d: %s vs %s' % ( i , row , rows [ i ] )
+        
+    logger.info ( 'eval_range and rows agree' ) 
+    
+# =============================================================================
+## single-pass slices with the selection 
+def test_slice () :
+
+    import ostap.trees.trees 
+    import numpy 
+    tree = make_tree ()
+
+    vars = 'x y n x*y n+1 sqrt(y)'
+    cut  = 'n<5'
+    
+    vals , _ = tree.slice ( vars , cut )
+    assert vals.shape [ 0 ] == 6 , 'Invalid shape %s' % str ( vals.shape )
+    
+    rows = numpy.array ( [ r for r in tree.rows ( vars , cuts = cut ) ] ).transpose ()
+    assert numpy.allclose ( vals , rows ) , 'slice and rows differ!'
+    
+    vals32 , w = tree.slice ( vars , cut , weight = 'y' , dtype = numpy.float32 )
+    assert vals32.dtype == numpy.float32 and len ( w ) == vals32.shape [ 1 ] , 'Invalid float32 slice'
+    assert numpy.allclose ( vals32 , vals , rtol = 1.e-5 ) , 'float32 slice differs!'
+    
+    chunks = [ v for v , _ in tree.slice_chunks ( vars , cut , memory = 6 * 8 * 100 ) ]
+    assert numpy.array_equal ( numpy.concatenate ( chunks , axis = 1 ) , vals ) , 'Chunked slices differ!'
+    
+    logger.info ( 'slice, slice_chunks and rows agree' ) 
+    
+# =============================================================================
+## fixed-size record batches 
+def test_batches () :
+
+    import ostap.trees.trees 
+    import numpy 
+    tree = make_tree ()
+
+    vars     = 'x y n*y'
+    cut      = 'n<5'
+    vals , _ = tree.slice ( vars , cut )
+
+    for prefetch in ( False , True ) :
+        batches = list ( tree.batches ( vars , cut , batch_size = 64 , prefetch = prefetch ) )
+        assert all ( 64 == len ( b [ 'x' ] ) for b in batches [ :-1 ] ) , 'Invalid batch size'
+        x = numpy.concatenate ( [ b [ 'x'   ] for b in batches ] )
+        z = numpy.concatenate ( [ b [ 'n*y' ] for b in batches ] )
+        assert numpy.array_equal ( x , vals [ 0 ] ) and numpy.array_equal ( z , vals [ 2 ] ) , 'batches and slice differ!'
+
+    records = numpy.concatenate ( list ( tree.batches ( vars , cut , batch_size = 100 , structured = True ) ) )
+    assert numpy.array_equal ( records [ 'y' ] , vals [ 1 ] ) , 'structured batches and slice differ!'
+    
+    logger.info ( 'batches and slice agree' ) 
+    
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_formula    ()
+    test_adaptive   ()
+    test_eval_range ()
+    test_slice      ()
+    test_batches    ()
+    
+# =============================================================================
+##                                                                      The END 
+# =============================================================================
@@ -321,6 +321,39 @@ def test_parameterize_4D () :
         logger.info ( '4D-(xu)-DIFFERENCES are %s ' % d3 ) 
         
 
+
+# =============================================================================
+## one-pass multithreaded parameterizations 
+# =============================================================================
+def test_parameterize_MT () :
+    
+    with ROOT.TFile.Open(data_file,'READ') as f :
+        
+        tree = f.S
+
+        l1 = Ostap.Math.LegendreSum2 ( 6 , 6 , -2 , 2 , -4 , 6 )
+        l2 = Ostap.Math.LegendreSum2 ( 6 , 6 , -2 , 2 , -4 , 6 )
+        
+        l1.parameterize ( tree , 'x' , 'u' , cuts )
+        sumw , cov2 = l2.parameterize ( tree , 'x' , 'u' , cuts , nthreads = 4 , covariance = True )
+        
+        logger.info ( '2D-MT: sum of weights %s' % sumw ) 
+        assert 0 < sumw , 'Invalid sum of weights!'
+        
+        for k in range ( l1.npars () ) :
+            assert abs ( l1.par ( k ) - l2.par ( k ) ) <= 1.e-8 * max ( 1 , abs ( l1.par ( k ) ) ) , \
+                   'Mismatch of MT coefficient #%d: %s vs %s' % ( k , l1.par ( k ) , l2.par ( k ) )
+            assert 0 <= cov2 [ k ][ k ] , 'Invalid variance for #%d' % k 
+
+        l3 = Ostap.Math.LegendreSum3 ( 4 , 4 , 4 , -2 , 2 , -2 , 2 , -4 , 4 )
+        l4 = Ostap.Math.LegendreSum3 ( 4 , 4 , 4 , -2 , 2 , -2 , 2 , -4 , 4 )
+        l3.parameterize ( tree , 'x' , 'y' , 'z' , cuts )
+        l4.parameterize ( tree , 'x' , 'y' , 'z' , cuts , nthreads = 4 )
+        for k in range ( l3.npars () ) :
+            assert abs ( l3.par ( k ) - l4.par ( k ) ) <= 1.e-8 * max ( 1 , abs ( l3.par ( k ) ) ) , \
+                   'Mismatch of MT coefficient #%d: %s vs %s' % ( k , l3.par ( k ) , l4.par ( k ) )
+            
+        logger.info ( 'One-pass multithreaded parameterization is OK' ) 
     
 # =============================================================================
 if '__main__' == __name__ :
@@ -329,6 +362,7 @@ if '__main__' == __name__ :
     test_parameterize_2D() 
     test_parameterize_3D() 
     test_parameterize_4D() 
+    test_parameterize_MT() 
     
 # =============================================================================
 # The END 
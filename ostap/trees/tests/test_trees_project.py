@@ -0,0 +1,336 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# @file ostap/trees/tests/test_trees_project.py
+# Test for sequential and multithreaded projections of TTree/TChain
+# Copyright (c) Ostap developers.
+# ============================================================================= 
+""" Test for sequential and multithreaded projections of TTree/TChain
+"""
+# ============================================================================= 
+from   __future__               import print_function
+import ROOT, random   
+import ostap.trees.trees
+import ostap.histos.histos
+from   ostap.core.core          import hID
+from   ostap.trees.data         import Data
+from   ostap.utils.timing       import timing 
+from   ostap.utils.progress_bar import progress_bar
+# ============================================================================= 
+# logging 
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'test_trees_project' )
+else                       : logger = getLogger ( __name__              )
+# =============================================================================
+## create a file with tree 
+def create_tree ( fname , nentries = 1000 ) :
+    """Create a file with a tree
+    >>> create_tree ( 'file.root' ,  1000 ) 
+    """
+    
+    import ostap.io.root_file
+    
+    from array import array 
+    var1 = array ( 'd', [ 0 ] )
+    var2 = array ( 'd', [ 0 ] )
+    
+    from ostap.core.core import ROOTCWD
+
+    with ROOTCWD() , ROOT.TFile.Open( fname , 'new' ) as root_file:
+        root_file.cd () 
+        tree = ROOT.TTree ( 'S','tree' )
+        tree.SetDirectory ( root_file  ) 
+        tree.Branch ( 'mass'  , var1 , 'mass/D'  )
+        tree.Branch ( 'pt'    , var2 , 'pt/D'    )
+        
+        for i in range ( nentries ) : 
+            
+            var1[0] = random.gauss   ( 3.1 ,  0.015 )
+            var2[0] = random.uniform ( 0   , 10     )
+            
+            tree.Fill()
+            
+        root_file.Write()
+        
+# =============================================================================
+def prepare_data ( nfiles = 10 ,  nentries = 1000  ) :
+
+    from ostap.utils.cleanup import CleanUp    
+    files = [ CleanUp.tempfile ( prefix = 'ostap-test-trees-project-%d-' % i ,
+                                 suffix = '.root' ) for i in range ( nfiles)  ]
+    
+    for f in progress_bar ( files ) : create_tree ( f , nentries )
+    return files
+
+# =============================================================================
+## compare sequential and multithreaded projections 
+def test_project_mt () :
+    """Compare sequential and multithreaded projections
+    """
+
+    files = prepare_data ( 10 , 1000 )
+    data  = Data ( 'S' , files )
+    chain = data.chain
+
+    h1 = ROOT.TH1D ( hID() , '' , 50 , 3.0 , 3.2 )
+    h2 = h1.clone  ()
+    
+    with timing ( 'Sequential    projection' , logger = logger ) : 
+        chain.project ( h1 , 'mass' , 'pt>2' )
+    with timing ( 'Multithreaded projection' , logger = logger ) : 
+        chain.project ( h2 , 'mass' , 'pt>2' , nthreads = 4 )
+
+    logger.info ( 'sequential    : %s' % h1.stat () )
+    logger.info ( 'multithreaded : %s' % h2.stat () )
+    
+    assert h1.GetEntries() == h2.GetEntries() , 'Mismatch in number of entries!'
+    for i in h1 :
+        assert abs ( h1 [ i ].value() - h2 [ i ].value() ) < 1.e-9 , 'Mismatch in bin content!'
+
+    h3 = ROOT.TH2D ( hID() , '' , 20 , 3.0 , 3.2 , 20 , 0 , 10 )
+    h4 = h3.clone  ()
+    
+    chain.project ( h3 , ( 'mass' , 'pt' ) , 'pt>2' )
+    chain.project ( h4 , ( 'mass' , 'pt' ) , 'pt>2' , nthreads = 4 )
+    
+    assert h3.GetEntries() == h4.GetEntries() , 'Mismatch in number of entries!'
+    
+# =============================================================================
+## compare individual projections with the single-loop projection plan 
+def test_project_many () :
+    """Compare individual projections with the single-loop projection plan
+    """
+
+    files = prepare_data ( 10 , 1000 )
+    data  = Data ( 'S' , files )
+    chain = data.chain
+
+    h1 = ROOT.TH1D ( hID() , '' , 50 , 3.0 , 3.2 )
+    h2 = ROOT.TH1D ( hID() , '' , 50 , 0   , 10  )
+    h3 = ROOT.TH2D ( hID() , '' , 20 , 3.0 , 3.2 , 20 , 0 , 10 )
+    g1 , g2 , g3 = h1.clone() , h2.clone() , h3.clone() 
+    
+    with timing ( 'Individual projections' , logger = logger ) : 
+        chain.project ( h1 , 'mass'            , 'pt>2'               )
+        chain.project ( h2 , 'pt'              , 'pt>2 && mass<3.1'   )
+        chain.project ( h3 , ( 'mass' , 'pt' ) , 'pt>2'               )
+        
+    with timing ( 'Projection plan       ' , logger = logger ) : 
+        chain.project_many ( [ ( g1 , 'mass'            ) ,
+                               ( g2 , 'pt'   , 'mass<3.1' ) ,
+                               ( g3 , 'mass , pt'       ) ] , 'pt>2' )
+        
+    for h , g in ( ( h1 , g1 ) , ( h2 , g2 ) , ( h3 , g3 ) ) :
+        logger.info ( 'individual : %s' % h.stat () )
+        logger.info ( 'plan       : %s' % g.stat () )
+        assert h.GetEntries() == g.GetEntries() , 'Mismatch in number of entries!'
+        
+    for i in h1 :
+        assert abs ( h1 [ i ].value() - g1 [ i ].value() ) < 1.e-9 , 'Mismatch in bin content!'
+        
+# =============================================================================
+## compare dense, sparse and single-precision 3D projections 
+def test_project_sparse () :
+    """Compare dense, sparse and single-precision 3D projections
+    """
+
+    files = prepare_data ( 10 , 1000 )
+    data  = Data ( 'S' , files )
+    chain = data.chain
+
+    what  = 'mass' , 'pt' , 'mass*pt' 
+    h1    = ROOT.TH3D ( hID() , '' , 20 , 3.0 , 3.2 , 20 , 0 , 10 , 20 , 0 , 32 )
+    h2    = ROOT.TH3F ( hID() , '' , 20 , 3.0 , 3.2 , 20 , 0 , 10 , 20 , 0 , 32 )
+    
+    nbins = ROOT.std.vector('int')    ( 3 , 20 )
+    xmin  = ROOT.std.vector('double') ()
+    xmax  = ROOT.std.vector('double') ()
+    for a , b in ( ( 3.0 , 3.2 ) , ( 0 , 10 ) , ( 0 , 32 ) ) :
+        xmin.push_back ( a )
+        xmax.push_back ( b )
+    hs    = ROOT.THnSparseD ( hID() , '' , 3 , nbins.data() , xmin.data() , xmax.data() )
+    
+    with timing ( 'Dense  TH3D projection      ' , logger = logger ) : 
+        chain.project ( h1 , what , 'pt>2' )
+    with timing ( 'Float  TH3F projection (MT) ' , logger = logger ) : 
+        chain.project ( h2 , what , 'pt>2' , nthreads = 4 )
+    with timing ( 'Sparse THnSparse projection ' , logger = logger ) : 
+        chain.project ( hs , what , 'pt>2' , nthreads = 4 )
+
+    assert h1.GetEntries() == h2.GetEntries() , 'Mismatch in number of entries (TH3F)!'
+    assert h1.GetEntries() == hs.GetEntries() , 'Mismatch in number of entries (THnSparse)!'
+    
+    coord = ROOT.std.vector('int') ( 3 ) 
+    for ix in range ( 1 , 21 ) :
+        for iy in range ( 1 , 21 ) :
+            for iz in range ( 1 , 21 ) :
+                c = h1.GetBinContent ( ix , iy , iz )
+                assert abs ( c - h2.GetBinContent ( ix , iy , iz ) ) < 1.e-6 , 'Mismatch in bin content (TH3F)!'
+                coord [ 0 ] , coord [ 1 ] , coord [ 2 ] = ix , iy , iz 
+                assert abs ( c - hs.GetBinContent ( coord.data() ) ) < 1.e-9 , 'Mismatch in bin content (THnSparse)!'
+
+    ## function, based on the sparse histogram 
+    from ostap.core.core import Ostap 
+    fun = Ostap.Functions.FuncTH3 ( hs , 'mass' , 'pt' , 'mass*pt' , ROOT.nullptr ,
+                                    Ostap.Math.HistoInterpolation.Nearest ,
+                                    Ostap.Math.HistoInterpolation.Nearest ,
+                                    Ostap.Math.HistoInterpolation.Nearest )
+    logger.info ( 'Sparse bins: %d/%d' % ( hs.GetNbins () , 22**3 ) )
+    
+# =============================================================================
+## per-bin statistics: sequential vs multithreaded, comparison with TProfile 
+def test_project_binstat () :
+    """Per-bin statistics: sequential vs multithreaded, comparison with TProfile 
+    """
+
+    files = prepare_data ( 10 , 1000 )
+    data  = Data ( 'S' , files )
+    chain = data.chain
+
+    model = ROOT.TH1D ( hID() , '' , 10 , 0 , 10 )
+    
+    with timing ( 'Sequential    bin-statistics' , logger = logger ) : 
+        s1 = chain.bin_stat ( model , 'pt' , 'mass' , 'pt>2' )
+    with timing ( 'Multithreaded bin-statistics' , logger = logger ) : 
+        s2 = chain.bin_stat ( model , 'pt' , 'mass' , 'pt>2' , nthreads = 4 )
+
+    p0 = ROOT.TProfile ( hID() , '' , 10 , 0 , 10 )
+    chain.Project ( p0.GetName() , 'mass:pt' , 'pt>2' )
+    
+    p1 = s1.asProfile ()
+    hm = s2.asH1 ( 'mean' )
+    hr = s2.asH1 ( 'rms'  )
+    
+    for i in range ( 1 , 11 ) :
+        c1 , c2 = s1 [ i ] , s2 [ i ]
+        assert c1.n () == c2.n ()                       , 'Mismatch in number of entries!'
+        assert abs ( c1.mean () - c2.mean () ) < 1.e-9 , 'Mismatch in mean values!'
+        assert abs ( c1.rms  () - c2.rms  () ) < 1.e-9 , 'Mismatch in rms values!'
+        assert abs ( p0.GetBinContent ( i ) - p1.GetBinContent ( i ) ) < 1.e-9 , 'Mismatch in profile!'
+        assert abs ( p0.GetBinError   ( i ) - p1.GetBinError   ( i ) ) < 1.e-9 , 'Mismatch in profile errors!'
+        assert abs ( hm.GetBinContent ( i ) - c1.mean () ) < 1.e-9 , 'Mismatch in mean histogram!'
+        logger.info ( 'bin %2d: %s min/max=%.4f/%.4f rms=%.4f' % ( i , hm [ i ] , c1.values().min() ,
+                                                                 c1.values().max() , hr [ i ].value() ) ) 
+        
+# =============================================================================
+## Poisson-bootstrap replicas in a single pass: sequential vs multithreaded
+def test_project_replicas () :
+    """Poisson-bootstrap replicas in a single pass: sequential vs multithreaded
+    """
+
+    files = prepare_data ( 10 , 1000 )
+    data  = Data ( 'S' , files )
+    chain = data.chain
+
+    model = ROOT.TH1D ( hID() , '' , 10 , 0 , 10 )
+    h0    = model.clone () 
+    chain.Project ( h0.GetName() , 'pt' , 'pt>2' )
+    
+    with timing ( 'Sequential    replicas' , logger = logger ) : 
+        r1 = chain.bin_replicas ( model , 'pt' , 'pt>2' , nreplicas = 200 , seed = 17 )
+    with timing ( 'Multithreaded replicas' , logger = logger ) : 
+        r2 = chain.bin_replicas ( model , 'pt' , 'pt>2' , nreplicas = 200 , seed = 17 , nthreads = 4 )
+
+    hb = r1.asH1 ()
+    h5 = r2.asH1 ( replica = 5 ) 
+    for i in range ( 1 , 11 ) :
+        n = h0.GetBinContent ( i ) 
+        assert abs ( r1.nominal ( i ) - n ) < 1.e-9 , 'Mismatch in nominal content!'
+        for j in range ( r1.nReplicas () ) :
+            assert abs ( r1.value ( i , j ) - r2.value ( i , j ) ) < 1.e-9 , 'Replicas depend on threads!'
+        ## bootstrap uncertainty is close to sqrt(N) 
+        assert abs ( hb [ i ].error () / n ** 0.5 - 1 ) < 0.3 , 'Invalid bootstrap uncertainty!'
+        logger.info ( 'bin %2d: %s vs %.1f, replica#5: %.1f, mean %.1f, corr(i,i+1)=%+.3f' % (
+            i , hb [ i ] , n , h5 [ i ].value () , r1.mean ( i ) , r1.correlation ( i , i + 1 ) ) ) 
+        
+# =============================================================================
+## direct TTree -> RooDataHist: sequential vs multithreaded, comparison with histogram
+def test_project_datahist () :
+    """Direct TTree -> RooDataHist: sequential vs multithreaded, comparison with histogram
+    """
+
+    files = prepare_data ( 10 , 1000 )
+    data  = Data ( 'S' , files )
+    chain = data.chain
+
+    mass  = ROOT.RooRealVar ( 'mass' , 'mass' , 3.0 , 3.2 )
+    pt    = ROOT.RooRealVar ( 'pt'   , 'pt'   , 0   , 10  )
+    mass.setBins ( 20 )
+    pt  .setBins ( 5  )
+    
+    with timing ( 'Sequential    RooDataHist' , logger = logger ) : 
+        d1 = chain.data_hist ( mass , cuts = 'pt>2' )
+    with timing ( 'Multithreaded RooDataHist' , logger = logger ) : 
+        d2 = chain.data_hist ( mass , cuts = 'pt>2' , nthreads = 4 )
+    with timing ( 'Multithreaded RooDataHist 2D' , logger = logger ) : 
+        d3 = chain.data_hist ( [ mass , pt ] , cuts = 'pt>2' , nthreads = 4 )
+        
+    h0 = ROOT.TH1D ( hID() , '' , 20 , 3.0 , 3.2 )
+    chain.Project ( h0.GetName() , 'mass' , 'pt>2' )
+
+    logger.info ( 'RooDataHist: sum of weights %s/%s/%s vs %s' % ( d1.sumEntries () , d2.sumEntries () ,
+                                                                 d3.sumEntries () , h0.Integral  () ) ) 
+    assert abs ( d1.sumEntries () - h0.Integral () ) < 1.e-6 , 'Mismatch in sum of weights!'
+    assert abs ( d2.sumEntries () - h0.Integral () ) < 1.e-6 , 'Mismatch in sum of weights!'
+    assert abs ( d3.sumEntries () - h0.Integral () ) < 1.e-6 , 'Mismatch in sum of weights!'
+    
+    for i in range ( d1.numEntries () ) :
+        d1.get ( i )
+        d2.get ( i )
+        assert abs ( d1.weight () - h0.GetBinContent ( i + 1 ) ) < 1.e-9 , 'Mismatch in bin content!'
+        assert abs ( d2.weight () - h0.GetBinContent ( i + 1 ) ) < 1.e-9 , 'Mismatch in bin content!'
+
+# =============================================================================
+## multithreaded projections within the memory budget:
+#  fewer histogram clones or the shared atomic buffer 
+def test_project_budget () :
+    """Multithreaded projections within the memory budget:
+    fewer histogram clones or the shared atomic buffer 
+    """
+
+    from ostap.core.core        import Ostap
+    from ostap.utils.memory     import MemoryBudget
+    from ostap.utils.instrument import Instrumentation, memory_stages 
+    
+    files = prepare_data ( 10 , 1000 )
+    data  = Data ( 'S' , files )
+    chain = data.chain
+
+    ## each clone is ~16MB 
+    h1 = ROOT.TH2D ( hID() , '' , 1000 , 3.0 , 3.2 , 1000 , 0 , 10 )
+    h2 = h1.clone  ()
+    h3 = h1.clone  ()
+    
+    chain.project ( h1 , ( 'mass' , 'pt' ) , 'pt>2' )
+
+    rss = Ostap.Utils.rss () / float ( 2 ** 20 )
+    ## two clones fit: two threads instead of four 
+    with timing ( 'Projection with fewer clones' , logger = logger ) , MemoryBudget ( rss + 40 ) : 
+        chain.project ( h2 , ( 'mass' , 'pt' ) , 'pt>2' , nthreads = 4 )
+    ## tight budget: the shared atomic buffer 
+    with timing ( 'Projection with atomic buffer' , logger = logger ) , MemoryBudget ( rss + 1  ) , Instrumentation () as I : 
+        chain.project ( h3 , ( 'mass' , 'pt' ) , 'pt>2' , nthreads = 4 )
+        stages = I.memory 
+        
+    logger.info ( 'Memory per stage: %s' % stages ) 
+        
+    assert h1.GetEntries() == h2.GetEntries() , 'Mismatch in number of entries!'
+    assert h1.GetEntries() == h3.GetEntries() , 'Mismatch in number of entries!'
+    assert abs ( h1.Integral () - h2.Integral () ) < 1.e-6 , 'Mismatch in integral!'
+    assert abs ( h1.Integral () - h3.Integral () ) < 1.e-6 , 'Mismatch in integral!'
+    
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_project_mt      ()
+    test_project_many    ()
+    test_project_sparse  ()
+    test_project_binstat ()
+    test_project_replicas ()
+    test_project_datahist ()
+    test_project_budget  ()
+    
+# =============================================================================
+# The END 
+# =============================================================================
@@ -0,0 +1,180 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+# @file ostap/trees/tests/test_trees_statvars.py
+# Test for sequential and multithreaded statistics for TTree/TChain/RooDataSet
+# Copyright (c) Ostap developers.
+# ============================================================================= 
+""" Test for sequential and multithreaded statistics for TTree/TChain/RooDataSet
+"""
+# ============================================================================= 
+from   __future__               import print_function
+import ROOT, random   
+import ostap.trees.trees
+from   ostap.trees.data         import Data
+from   ostap.utils.timing       import timing 
+from   ostap.utils.progress_bar import progress_bar
+# ============================================================================= 
+# logging 
+# =============================================================================
+from ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'test_trees_statvars' )
+else                       : logger = getLogger ( __name__              )
+# =============================================================================
+## create a file with tree 
+def create_tree ( fname , nentries = 1000 ) :
+    """Create a file with a tree
+    >>> create_tree ( 'file.root' ,  1000 ) 
+    """
+    
+    import ostap.io.root_file
+    
+    from array import array 
+    var1 = array ( 'd', [ 0 ] )
+    var2 = array ( 'd', [ 0 ] )
+    
+    from ostap.core.core import ROOTCWD
+
+    with ROOTCWD() , ROOT.TFile.Open( fname , 'new' ) as root_file:
+        root_file.cd () 
+        tree = ROOT.TTree ( 'S','tree' )
+        tree.SetDirectory ( root_file  ) 
+        tree.Branch ( 'mass'  , var1 , 'mass/D'  )
+        tree.Branch ( 'pt'    , var2 , 'pt/D'    )
+        
+        for i in range ( nentries ) : 
+            
+            var1[0] = random.gauss   ( 3.1 ,  0.015 )
+            var2[0] = random.uniform ( 0   , 10     )
+            
+            tree.Fill()
+            
+        root_file.Write()
+        
+# =============================================================================
+def prepare_data ( nfiles = 10 ,  nentries = 1000  ) :
+
+    from ostap.utils.cleanup import CleanUp    
+    files = [ CleanUp.tempfile ( prefix = 'ostap-test-trees-statvars-%d-' % i ,
+                                 suffix = '.root' ) for i in range ( nfiles)  ]
+    
+    for f in progress_bar ( files ) : create_tree ( f , nentries )
+    return files
+
+# =============================================================================
+## compare sequential and multithreaded statistics 
+def test_statvars_mt () :
+    """Compare sequential and multithreaded statistics
+    """
+
+    files = prepare_data ( 10 , 1000 )
+    data  = Data ( 'S' , files )
+    chain = data.chain
+
+    with timing ( 'Sequential   statVar' , logger = logger ) : 
+        s1 = chain.statVar ( 'mass' , 'pt>2' )
+    with timing ( 'Multithreaded statVar' , logger = logger ) : 
+        s2 = chain.statVar ( 'mass' , 'pt>2' , nthreads = 4 )
+        
+    logger.info ( 'sequential    : %s' % s1 )
+    logger.info ( 'multithreaded : %s' % s2 )
+
+    assert s1.nEntries() == s2.nEntries() , 'Mismatch in number of entries!'
+    assert abs ( s1.mean() - s2.mean() ) < 1.e-9 * abs ( s1.mean () ) , 'Mismatch in mean values!'
+    
+    r1 = chain.statVars ( [ 'mass' , 'pt' ] , 'pt>2' ,  100 , 8000 )
+    r2 = chain.statVars ( [ 'mass' , 'pt' ] , 'pt>2' ,  100 , 8000 , nthreads = 4 )
+    
+    for k in r1 :
+        logger.info ( '%-5s sequential    : %s' % ( k , r1 [ k ] ) ) 
+        logger.info ( '%-5s multithreaded : %s' % ( k , r2 [ k ] ) ) 
+        assert r1 [ k ].nEntries() == r2 [ k ].nEntries() , 'Mismatch in number of entries!'
+        
+# =============================================================================
+## single-pass statistics & covariances for several expressions 
+def test_statcovs () :
+    """Single-pass statistics & covariances for several expressions
+    """
+
+    files = prepare_data ( 2 , 1000 )
+    data  = Data ( 'S' , files )
+    chain = data.chain
+
+    s1 , s2 , c2 , l2 = chain.statCov  (   'mass' , 'pt' , 'pt>2' )
+    ss , cn , ln      = chain.statCovs ( [ 'mass' , 'pt' , 'mass*pt' ] , 'pt>2' )
+
+    logger.info ( 'statCov  : %s' % c2 )
+    logger.info ( 'statCovs : %s' % cn )
+
+    assert l2 == ln , 'Mismatch in number of entries!'
+    for i in range ( 2 ) :
+        for j in range ( i + 1 ) :
+            assert abs ( c2 [ i , j ] - cn [ i , j ] ) <= 1.e-6 * abs ( c2 [ i , j ] ) , \
+                   'Mismatch in covariances!'
+            
+# =============================================================================
+## compare sequential and multithreaded statistics for RooDataSet 
+def test_statvars_dataset_mt () :
+    """Compare sequential and multithreaded statistics for RooDataSet
+    """
+    
+    import ostap.fitting.dataset
+    import ostap.stats.statvars 
+    from   ostap.core.core import Ostap 
+    
+    mass = ROOT.RooRealVar ( 'mass' , 'mass' , 3.0 , 3.2 )
+    pt   = ROOT.RooRealVar ( 'pt'   , 'pt'   , 0   , 10  )
+    w    = ROOT.RooRealVar ( 'w'    , 'w'    , 0   , 2   )
+    
+    varset  = ROOT.RooArgSet  ( mass , pt , w  )
+    dataset = ROOT.RooDataSet ( 'ds_statvars' , 'dataset' , varset )
+    for i in range ( 20000 ) :
+        mass.setVal ( random.gauss   ( 3.1 , 0.015 ) )
+        pt  .setVal ( random.uniform ( 0   , 10    ) )
+        w   .setVal ( random.uniform ( 0.5 , 1.5   ) )
+        dataset.add ( varset )
+        
+    weighted = dataset.makeWeighted ( 'w' ) 
+    
+    for ds in ( dataset , weighted ) :
+        
+        with timing ( 'Sequential    statVar' , logger = logger ) : 
+            s1 = ds.statVar ( 'mass*pt' , 'pt>2' )
+        with timing ( 'Multithreaded statVar' , logger = logger ) : 
+            s2 = ds.statVar ( 'mass*pt' , 'pt>2' , nthreads = 4 )
+            
+        logger.info ( 'sequential    : %s' % s1 )
+        logger.info ( 'multithreaded : %s' % s2 )
+        
+        assert s1.nEntries() == s2.nEntries() , 'Mismatch in number of entries!'
+        assert abs ( s1.mean() - s2.mean() ) < 1.e-9 * abs ( s1.mean () ) , 'Mismatch in mean values!'
+        assert abs ( s1.nEff() - s2.nEff() ) < 1.e-9 * abs ( s1.nEff () ) , 'Mismatch in nEff!'
+        
+        c1 = ds.statCov ( 'mass' , 'pt' , 'pt>2' )
+        c2 = ds.statCov ( 'mass' , 'pt' , 'pt>2' , nthreads = 4 )
+        assert c1 [ 3 ] == c2 [ 3 ] , 'Mismatch in number of entries!'
+        assert abs ( c1 [ 2 ] ( 0 , 1 ) - c2 [ 2 ] ( 0 , 1 ) ) <= 1.e-6 * abs ( c1 [ 2 ] ( 0 , 1 ) ) , \
+               'Mismatch in covariances!'
+        
+        m1 = ds.moment ( 2 , 'mass' , 'pt>2' )
+        m2 = ds.moment ( 2 , 'mass' , 'pt>2' , nthreads = 4 )
+        assert abs ( m1.value () - m2.value () ) < 1.e-9 * abs ( m1.value () ) , 'Mismatch in moments!'
+        
+        n1 = Ostap.StatVar.nEff   ( ds , 'pt>2' )
+        n2 = Ostap.StatVar.nEffMT ( ds , 'pt>2' , 4 )
+        assert abs ( n1 - n2 ) < 1.e-9 * n1 , 'Mismatch in nEff!'
+        
+        q1 = ds.quantile ( 0.3 , 'mass' , 'pt>2' , exact = True )
+        q2 = ds.quantile ( 0.3 , 'mass' , 'pt>2' , exact = True , nthreads = 4 )
+        assert q1.nevents == q2.nevents and q1.quantile == q2.quantile , 'Mismatch in quantiles!'
+        
+# =============================================================================
+if '__main__' == __name__ :
+
+    test_statvars_mt         ()
+    test_statcovs            ()
+    test_statvars_dataset_mt ()
+    
+# =============================================================================
+# The END 
+# =============================================================================
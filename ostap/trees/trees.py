@@ -17,6 +17,9 @@ __all__     = (
     'Tree'            , ## helper class , needed for multiprocessing
     'ActiveBranches'  , ## context manager to activate certain branches 
     'active_branches' , ## context manager to activate certain branches 
+    'tree_entries'    , ## (cached) number of entries in the tree from the file 
+    'tree_clusters'   , ## (cached) cluster boundaries for the tree from the file 
+    'cluster_slices'  , ## split the range of entries into slices aligned with clusters 
   ) 
 # =============================================================================
 import ROOT, os, math, array 
@@ -27,7 +30,6 @@ from   ostap.core.ostap_types import ( integer_types  , long_type      ,
                                        string_types   , sequence_types ,
                                        sized_types    , num_types      ,
                                        dictlike_types                  )
-from   ostap.utils.utils      import chunked 
 import ostap.histos.histos
 import ostap.trees.param
 # =============================================================================
@@ -332,6 +334,161 @@ def _tt_rows_ ( tree , variables , cuts = '' , first = 0 , last = -1 ) :
             
 ROOT.TTree .rows  = _tt_rows_ 
 
+# =============================================================================
+##  Get the values of (scalar) expressions for the range of entries as numpy array
+#   (with one C++ call for the whole range) 
+#   @code
+#   tree = ...
+#   arr  = tree.eval_range ( 'a a+b/c sin(d)' , first = 0 , last = 1000 )
+#   arr  = tree.eval_range ( 'a a+b/c sin(d)' , rowmajor = False ) ## column-major 
+#   @endcode 
+#   @see Ostap::Trees::Getter::eval_range 
+def _tt_eval_range_ ( tree , variables , first = 0 , last = -1 , rowmajor = True ) :
+    """Get the values of (scalar) expressions for the range of entries as numpy array
+    (with one C++ call for the whole range) 
+    >>> tree = ...
+    >>> arr  = tree.eval_range ( 'a a+b/c sin(d)' , first = 0 , last = 1000 )
+    >>> arr  = tree.eval_range ( 'a a+b/c sin(d)' , rowmajor = False ) ## column-major 
+    - see Ostap::Trees::Getter::eval_range 
+    """
+    if last < 0 : last = _large
+    last  = min ( last , len ( tree ) )
+    first = max ( 0    , first        ) 
+    
+    if isinstance ( variables , string_types ) : variables = split_string ( variables , ' ,;:' )
+    vars = []
+    for v in variables :
+        vars += split_string ( v , ' ,;:' )
+    vars = strings ( vars ) 
+
+    import numpy 
+    nrows  = max ( 0 , last - first )
+    ncols  = len ( vars ) 
+    result = numpy.empty ( ( nrows , ncols ) , dtype = float , order = 'C' if rowmajor else 'F' )
+    if not nrows or not ncols : return result
+    
+    getter = Ostap.Trees.Getter ( tree , vars ) 
+    sc     = getter.eval_range ( first , last , result , result.size , rowmajor )
+    assert sc.isSuccess () , 'eval_range: error status %s' % sc 
+    
+    del getter 
+    return result 
+
+ROOT.TTree .eval_range = _tt_eval_range_ 
+
+# =============================================================================
+## Get the (global) cluster boundaries for the tree/chain
+#  - for chains the boundaries are taken from the data catalog (file by file) 
+#  @code
+#  tree     = ...
+#  clusters = tree.clusters () 
+#  @endcode 
+#  @see ostap.trees.catalog
+def _tt_clusters_ ( tree ) :
+    """Get the (global) cluster boundaries for the tree/chain
+    - for chains the boundaries are taken from the data catalog (file by file)
+    >>> tree     = ...
+    >>> clusters = tree.clusters () 
+    """
+    if not isinstance ( tree , ROOT.TChain ) :
+        from ostap.trees.catalog import _clusters_
+        return _clusters_ ( tree )
+
+    name   = tree.GetName ()
+    result = [ 0 ]
+    offset = 0
+    for f in tree.files () :
+        clusters = tree_clusters ( name , f )
+        if not clusters : return () 
+        result += [ offset + c for c in clusters if 0 < c ]
+        offset += clusters [ -1 ]
+    return tuple ( result ) 
+
+ROOT.TTree .clusters   = _tt_clusters_ 
+
+# =============================================================================
+##  Iterate over the chunks of entries, aligned with clusters, and get 
+#   the values of (scalar) expressions for each chunk as numpy array
+#   - one C++ call per chunk, the same <code>Ostap::Trees::Getter</code> is used for all chunks 
+#   - with <code>prefetch=True</code> the next chunk is read in the background thread, 
+#     while the current one is processed
+#   @code
+#   tree = ...
+#   for chunk , arr  in tree.eval_chunks ( 'a a+b/c sin(d)' , chunk_size = 100000 ) :
+#       ... 
+#   @endcode 
+#   @see Ostap::Trees::Getter::eval_range 
+def _tt_eval_chunks_ ( tree               ,
+                       variables          ,
+                       chunk_size = 100000 ,
+                       first      = 0      ,
+                       last       = -1     ,
+                       rowmajor   = True   ,
+                       prefetch   = True   ) :
+    """Iterate over the chunks of entries, aligned with clusters, and get 
+    the values of (scalar) expressions for each chunk as numpy array
+    - one C++ call per chunk, the same `Ostap.Trees.Getter` is used for all chunks 
+    - with `prefetch=True` the next chunk is read in the background thread, 
+    while the current one is processed
+    >>> tree = ...
+    >>> for chunk , arr  in tree.eval_chunks ( 'a a+b/c sin(d)' , chunk_size = 100000 ) :
+    ...     ... 
+    - see Ostap::Trees::Getter::eval_range 
+    """
+    if last < 0 : last = _large
+    last  = min ( last , len ( tree ) )
+    first = max ( 0    , first        ) 
+    if last <= first : return
+    
+    if isinstance ( variables , string_types ) : variables = split_string ( variables , ' ,;:' )
+    vars = []
+    for v in variables :
+        vars += split_string ( v , ' ,;:' )
+    vars   = strings ( vars ) 
+    ncols  = len ( vars )
+
+    import numpy 
+    getter = Ostap.Trees.Getter ( tree , vars ) 
+    
+    def _read_ ( chunk ) :
+        start , stop , _ = chunk.indices ( last ) 
+        result = numpy.empty ( ( stop - start , ncols ) , dtype = float , order = 'C' if rowmajor else 'F' )
+        if result.size : 
+            sc = getter.eval_range ( start , stop , result , result.size , rowmajor )
+            assert sc.isSuccess () , 'eval_chunks: error status %s' % sc 
+        return result
+    
+    chunks = cluster_slices ( tree.clusters () , first , last , max ( 1 , chunk_size ) )
+    
+    if not prefetch :
+        for chunk in chunks : yield chunk , _read_ ( chunk )
+        del getter
+        return
+
+    ## the tree is read in the background thread 
+    ROOT.ROOT.EnableThreadSafety () 
+    ## release the GIL for the C++ reading (if possible) 
+    try : 
+        Ostap.Trees.Getter.eval_range.__release_gil__ = True
+    except AttributeError :
+        pass
+    
+    from concurrent.futures import ThreadPoolExecutor
+    with ThreadPoolExecutor ( max_workers = 1 ) as executor :
+        chunks  = iter ( chunks )
+        current = next ( chunks , None )
+        future  = executor.submit ( _read_ , current ) if current else None 
+        while future :
+            result  = future.result ()
+            chunk   = current 
+            current = next ( chunks , None )
+            future  = executor.submit ( _read_ , current ) if current else None 
+            yield chunk , result 
+            
+    del getter
+
+ROOT.TTree .eval_chunks = _tt_eval_chunks_ 
+
 
 
 # =============================================================================
@@ -360,7 +517,9 @@ ROOT.TTree .rows  = _tt_rows_
 #  @param firstentry (INPUT) first entry to process
 #  @param use_frame  (INPUT) use DataFrame for processing?
 #  @param silent     (INPUT) silent processing?
+#  @param nthreads   (INPUT) use multithreaded projection with given number of threads 
 #  @see TTree::Project
+#  @see Ostap::HistoProject::projectMT
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
 #  @date   2013-07-06
 def _tt_project_ ( tree               ,
@@ -371,7 +530,8 @@ def _tt_project_ ( tree               ,
                    nentries   = -1    ,
                    firstentry =  0    ,
                    use_frame  = False , ## use DataFrame ? 
-                   silent     = False ) :
+                   silent     = False ,
+                   nthreads   = None  ) : ## use multithreaded projection? 
     """Helper project method
     
     >>> tree = ...
@@ -388,6 +548,10 @@ def _tt_project_ ( tree               ,
     - histo : the histogram (or histogram name)
     - what  : variable/expression to project. It can be expression or list/tuple of expression or comma (or semicolumn) separated expression
     - cuts  : selection criteria/weights 
+
+    Multithreaded projection:
+    >>> tree.project ( h1 , 'm', 'chi2<10' , nthreads = 8 ) 
+    - see Ostap::HistoProject::projectMT 
     """
     #
 
@@ -398,6 +562,27 @@ def _tt_project_ ( tree               ,
         args = options , nentries , firstentry
 
 
+    ## N-dimensional (sparse) histograms: always use Ostap::HistoProject::projectN
+    if isinstance ( histo , ROOT.THnBase ) :
+        
+        if isinstance ( cuts , ROOT.TCut ) : cuts = str ( cuts )
+        if isinstance ( what , string_types ) :
+            ## attention! note reversed here! 
+            what = [ w.strip() for w in reversed ( split_string ( what , ',;:' ) ) ]
+        what = [ w.strip() for w in what ]
+        assert len ( what ) == histo.GetNdimensions () , \
+               "project: dimension mismatch : ``what''/%d vs ``dim''/%d " % ( len ( what ) , histo.GetNdimensions () ) 
+        
+        exprs = std.vector('std::string')()
+        for w in what : exprs.push_back ( w )
+        
+        first = max ( 0 , firstentry )
+        last  = first + nentries if nentries < _large - first else _large
+        sc    = Ostap.HistoProject.projectN ( tree , histo , exprs , cuts if cuts else '' ,
+                                              nthreads if nthreads else 1 , first , last )
+        if sc.isFailure() : logger.error ( "project: error from Ostap::HistoProject %s" % sc )
+        return int ( histo.GetEntries () ) , histo 
+    
     if   isinstance ( histo , ROOT.TH1     ) : hname = histo.GetName()
     elif isinstance ( histo , string_types ) :
         hname = histo
@@ -434,9 +619,9 @@ def _tt_project_ ( tree               ,
         nr = 0
         hh = histo.clone() 
         for i , w in enumerate ( what ) : 
-            n , h = _tt_project_ ( tree , hh , w , cuts , *args , use_frame = use_frame , silent = silent )
+            n , h = _tt_project_ ( tree , hh , w , cuts , *args , use_frame = use_frame , silent = silent , nthreads = nthreads )
             histo += h
-            br    += n 
+            nr    += n 
         del hh
         return nr , histo 
 
@@ -444,6 +629,23 @@ def _tt_project_ ( tree               ,
     assert len ( what ) == histo.dim(), \
            "project: dimension mismatch : ``what''/%d vs ``dim''/%d " % ( len ( what ) , histo.dim() ) 
 
+    ## use multithreaded projection if requested 
+    if not nthreads is None and not options :
+
+        first = max ( 0 , firstentry )
+        last  = first + nentries if nentries < _large - first else _large
+        if   1 == len ( what ) :
+            sc = Ostap.HistoProject.projectMT  ( tree , histo , what [ 0 ] , cuts ,
+                                                 nthreads , first , last )
+        elif 2 == len ( what ) :
+            sc = Ostap.HistoProject.project2MT ( tree , histo , what [ 0 ] , what [ 1 ] , cuts ,
+                                                 nthreads , first , last )
+        else :
+            sc = Ostap.HistoProject.project3MT ( tree , histo , what [ 0 ] , what [ 1 ] , what [ 2 ] , cuts ,
+                                                 nthreads , first , last )
+        if sc.isFailure() : logger.error ( "project: error from Ostap::HistoProject %s" % sc )
+        return int ( histo.GetEntries () ) , histo 
+    
     ## use frame if requested and if possible 
     if use_frame and isinstance ( tree , ROOT.TTree ) and not args :
         
@@ -508,6 +710,261 @@ def _tt_project_ ( tree               ,
 ROOT.TTree .project = _tt_project_
 ROOT.TChain.project = _tt_project_
 
+# =============================================================================
+## Fill many histograms in a single loop over the tree/dataset
+#  Identical expressions and selections are evaluated only once per entry 
+#  @code
+#  tree = ...
+#  h1, h2, h3 = ...
+#  tree.project_many ( [ ( h1 , 'mass'                  ) ,
+#                        ( h2 , 'mass'       , 'pt>2'   ) , 
+#                        ( h3 , ( 'mass' , 'pt' ) , 'y<3' ) ] , 'chi2<10' )
+#  @endcode
+#  @param source (INPUT) the tree/chain or dataset
+#  @param items  (INPUT) list of ( histo , what [ , cuts ] ) 
+#  @param cuts   (INPUT) the common selection/weight for all histograms
+#  @param args   (INPUT) ( first , last ) for TTree and ( cut_range , first , last ) for RooAbsData 
+#  @return list of histograms 
+#  @see Ostap::ProjectPlan
+def _project_many_ ( source , items , cuts = '' , *args ) :
+    """Fill many histograms in a single loop over the tree/dataset
+    - identical expressions and selections are evaluated only once per entry 
+    >>> tree = ...
+    >>> h1, h2, h3 = ...
+    >>> tree.project_many ( [ ( h1 , 'mass'                  ) ,
+    ...                       ( h2 , 'mass'       , 'pt>2'   ) , 
+    ...                       ( h3 , ( 'mass' , 'pt' ) , 'y<3' ) ] , 'chi2<10' )
+    - see Ostap::ProjectPlan
+    """
+    if isinstance ( cuts , ROOT.TCut ) : cuts = str ( cuts )
+    
+    plan   = Ostap.ProjectPlan ( cuts )
+    histos = [] 
+    for item in items :
+        
+        assert 2 <= len ( item ) <= 3 , "project_many: invalid item %s" % str ( item ) 
+        histo , what = item [ : 2 ]
+        sel  = item [ 2 ] if 3 == len ( item ) else ''
+        if isinstance ( sel , ROOT.TCut ) : sel = str ( sel ) 
+        
+        assert isinstance ( histo , ROOT.TH1 ) , \
+               "project_many: invalid type of ``histo'': %s " % type ( histo )
+        
+        ## comma or semicolumn separated list (natural x,y,z order here!) 
+        if isinstance ( what , string_types ) :
+            what = [ w.strip() for w in split_string ( what , ',;' ) ]
+        what = [ w.strip() for w in what ]
+        
+        assert len ( what ) == histo.dim() , \
+               "project_many: dimension mismatch : ``what''/%d vs ``dim''/%d " % ( len ( what ) , histo.dim() ) 
+        
+        plan.add ( histo , *( what + [ sel ] ) )
+        histos.append ( histo )
+        
+    sc = plan.project ( source , *args )
+    if sc.isFailure() : logger.error ( "project_many: error from Ostap::ProjectPlan %s" % sc )
+    
+    return histos 
+
+ROOT.TTree .project_many = _project_many_
+ROOT.TChain.project_many = _project_many_
+
+# =============================================================================
+## Get the full per-bin statistics of the value in bins of the model histogram
+#  in a single (parallel) pass over the tree/dataset
+#  @code
+#  tree  = ...
+#  model = ROOT.TH1D ( 'm' , '' , 20 , 0 , 10 ) 
+#  stat  = tree.bin_stat ( model , 'pt' , 'mass' , 'w*(chi2<10)' , nthreads = 8 )
+#  prof  = stat.asProfile ()       ## as TProfile 
+#  hmean = stat.asH1 ( 'mean' )    ## mean-values with uncertainties 
+#  hrms  = stat.asH1 ( 'rms'  )    ## r.m.s. 
+#  @endcode
+#  @param source   (INPUT) the tree/chain or dataset
+#  @param model    (INPUT) the model histogram (only binning is used) 
+#  @param what     (INPUT) expressions for the axes of the model histogram 
+#  @param value    (INPUT) expression for the value 
+#  @param cuts     (INPUT) selection/weight 
+#  @param args     (INPUT) ( first , last ) 
+#  @param nthreads (INPUT) number of threads (TTree only) 
+#  @return the per-bin statistics, <code>Ostap::BinStat</code>
+#  @see Ostap::BinStat
+#  @see Ostap::HistoProject::profile 
+def _bin_stat_ ( source , model , what , value , cuts = '' , *args , **kwargs ) :
+    """Get the full per-bin statistics of the value in bins of the model histogram
+    in a single (parallel) pass over the tree/dataset
+    >>> tree  = ...
+    >>> model = ROOT.TH1D ( 'm' , '' , 20 , 0 , 10 ) 
+    >>> stat  = tree.bin_stat ( model , 'pt' , 'mass' , 'w*(chi2<10)' , nthreads = 8 )
+    >>> prof  = stat.asProfile ()       ## as TProfile 
+    >>> hmean = stat.asH1 ( 'mean' )    ## mean-values with uncertainties 
+    >>> hrms  = stat.asH1 ( 'rms'  )    ## r.m.s. 
+    - see Ostap::BinStat
+    - see Ostap::HistoProject::profile 
+    """
+    nthreads = kwargs.pop ( 'nthreads' , None )
+    assert not kwargs , "bin_stat: unknown arguments %s" % list ( kwargs.keys () )
+    
+    if isinstance ( cuts  , ROOT.TCut ) : cuts  = str ( cuts  )
+    if isinstance ( value , ROOT.TCut ) : value = str ( value )
+    
+    assert isinstance ( model , ROOT.TH1 ) and 1 <= model.GetDimension() <= 3 , \
+           "bin_stat: invalid type of ``model'': %s " % type ( model )
+    
+    ## comma or semicolumn separated list (natural x,y,z order here!) 
+    if isinstance ( what , string_types ) :
+        what = [ w.strip() for w in split_string ( what , ',;' ) ]
+    what = [ w.strip() for w in what ]
+    assert len ( what ) == model.GetDimension() , \
+           "bin_stat: dimension mismatch : ``what''/%d vs ``dim''/%d " % ( len ( what ) , model.GetDimension() ) 
+    
+    stat = Ostap.BinStat ( model )
+    if isinstance ( source , ROOT.TTree ) :
+        sc = Ostap.HistoProject.profile ( source , stat , strings ( *what ) , value , cuts ,
+                                          nthreads if nthreads else 1 , *args )
+    else :
+        sc = Ostap.HistoProject.profile ( source , stat , strings ( *what ) , value , cuts , *args )
+    if sc.isFailure() : logger.error ( "bin_stat: error from Ostap::HistoProject::profile %s" % sc )
+    
+    return stat 
+
+ROOT.TTree .bin_stat = _bin_stat_
+ROOT.TChain.bin_stat = _bin_stat_
+
+# =============================================================================
+## Get the Poisson-bootstrap replicas of the histogram in a single (parallel)
+#  pass over the tree/dataset: each entry gets <code>nreplicas</code> Poisson(1)
+#  weights (defined by the seed and the entry number only) and it is
+#  added to all replicas at once 
+#  @code
+#  tree  = ...
+#  model = ROOT.TH1D ( 'm' , '' , 20 , 0 , 10 ) 
+#  reps  = tree.bin_replicas ( model , 'pt' , 'w*(chi2<10)' , nreplicas = 200 , nthreads = 8 )
+#  h     = reps.asH1 ()                 ## nominal with bootstrap uncertainties 
+#  h5    = reps.asH1 ( replica = 5 )    ## the 5th replica 
+#  cov   = reps.covariance ( 3 , 4 )    ## bootstrap covariance of two bins 
+#  @endcode
+#  @param source    (INPUT) the tree/chain or dataset
+#  @param model     (INPUT) the model histogram (only binning is used) 
+#  @param what      (INPUT) expressions for the axes of the model histogram 
+#  @param cuts      (INPUT) selection/weight 
+#  @param args      (INPUT) ( first , last ) 
+#  @param nreplicas (INPUT) number of replicas 
+#  @param seed      (INPUT) the seed for the Poisson weights 
+#  @param nthreads  (INPUT) number of threads (TTree only) 
+#  @return the replicas, <code>Ostap::BinReplicas</code>
+#  @see Ostap::BinReplicas
+#  @see Ostap::HistoProject::replicas 
+def _bin_replicas_ ( source , model , what , cuts = '' , *args , **kwargs ) :
+    """Get the Poisson-bootstrap replicas of the histogram in a single (parallel)
+    pass over the tree/dataset: each entry gets `nreplicas` Poisson(1)
+    weights (defined by the seed and the entry number only) and it is
+    added to all replicas at once 
+    >>> tree  = ...
+    >>> model = ROOT.TH1D ( 'm' , '' , 20 , 0 , 10 ) 
+    >>> reps  = tree.bin_replicas ( model , 'pt' , 'w*(chi2<10)' , nreplicas = 200 , nthreads = 8 )
+    >>> h     = reps.asH1 ()                 ## nominal with bootstrap uncertainties 
+    >>> h5    = reps.asH1 ( replica = 5 )    ## the 5th replica 
+    >>> cov   = reps.covariance ( 3 , 4 )    ## bootstrap covariance of two bins 
+    - see Ostap::BinReplicas
+    - see Ostap::HistoProject::replicas 
+    """
+    nthreads  = kwargs.pop ( 'nthreads'  , None )
+    nreplicas = kwargs.pop ( 'nreplicas' , 100  )
+    seed      = kwargs.pop ( 'seed'      , 0    )
+    assert not kwargs , "bin_replicas: unknown arguments %s" % list ( kwargs.keys () )
+    
+    if isinstance ( cuts  , ROOT.TCut ) : cuts  = str ( cuts  )
+    
+    assert isinstance ( model , ROOT.TH1 ) and 1 <= model.GetDimension() <= 3 , \
+           "bin_replicas: invalid type of ``model'': %s " % type ( model )
+    assert isinstance ( nreplicas , integer_types ) and 2 <= nreplicas < 2**16 , \
+           "bin_replicas: invalid number of replicas: %s" % nreplicas 
+    
+    ## comma or semicolumn separated list (natural x,y,z order here!) 
+    if isinstance ( what , string_types ) :
+        what = [ w.strip() for w in split_string ( what , ',;' ) ]
+    what = [ w.strip() for w in what ]
+    assert len ( what ) == model.GetDimension() , \
+           "bin_replicas: dimension mismatch : ``what''/%d vs ``dim''/%d " % ( len ( what ) , model.GetDimension() ) 
+    
+    reps = Ostap.BinReplicas ( model , nreplicas , seed )
+    if isinstance ( source , ROOT.TTree ) :
+        sc = Ostap.HistoProject.replicas ( source , reps , strings ( *what ) , cuts ,
+                                           nthreads if nthreads else 1 , *args )
+    else :
+        sc = Ostap.HistoProject.replicas ( source , reps , strings ( *what ) , cuts , *args )
+    if sc.isFailure() : logger.error ( "bin_replicas: error from Ostap::HistoProject::replicas %s" % sc )
+    
+    return reps 
+
+ROOT.TTree .bin_replicas = _bin_replicas_
+ROOT.TChain.bin_replicas = _bin_replicas_
+
+# =============================================================================
+## Fill the binned dataset (<code>RooDataHist</code>) directly from the tree
+#  in a single (parallel) pass, without intermediate <code>RooDataSet</code>
+#  @code
+#  tree = ...
+#  mass = ROOT.RooRealVar ( 'mass' , 'mass' , 3.0 , 3.2 )
+#  mass.setBins ( 200 ) 
+#  dh   = tree.data_hist ( mass , cuts = 'pt>2' , nthreads = 8 )
+#  dh   = tree.data_hist ( [ mass , pt ] , what = 'M/1000,PT/1000' , nthreads = 8 )
+#  @endcode
+#  @param tree      (INPUT) the tree/chain 
+#  @param variables (INPUT) observable(s) or the binned dataset to be filled 
+#  @param what      (INPUT) expressions for the observables (default: names of the observables)
+#  @param cuts      (INPUT) selection/weight 
+#  @param args      (INPUT) ( first , last ) 
+#  @param nthreads  (INPUT) number of threads
+#  @return the binned dataset 
+#  @see Ostap::HistoProject::project 
+def _data_hist_ ( tree , variables , what = () , cuts = '' , *args , **kwargs ) :
+    """Fill the binned dataset (RooDataHist) directly from the tree
+    in a single (parallel) pass, without intermediate RooDataSet
+    >>> tree = ...
+    >>> mass = ROOT.RooRealVar ( 'mass' , 'mass' , 3.0 , 3.2 )
+    >>> mass.setBins ( 200 ) 
+    >>> dh   = tree.data_hist ( mass , cuts = 'pt>2' , nthreads = 8 )
+    >>> dh   = tree.data_hist ( [ mass , pt ] , what = 'M/1000,PT/1000' , nthreads = 8 )
+    - the bins are defined by the binnings of the observables
+    - entries outside the ranges of the observables are skipped 
+    - see Ostap::HistoProject::project 
+    """
+    nthreads = kwargs.pop ( 'nthreads' , None )
+    name     = kwargs.pop ( 'name'     , '' )
+    title    = kwargs.pop ( 'title'    , '' )
+    assert not kwargs , "data_hist: unknown arguments %s" % list ( kwargs.keys () )
+    
+    if isinstance ( cuts , ROOT.TCut ) : cuts = str ( cuts )
+
+    if isinstance ( variables , ROOT.RooDataHist ) : dh = variables
+    else :
+        if isinstance ( variables , ROOT.RooAbsRealLValue ) : variables = variables ,
+        vs = ROOT.RooArgSet ()
+        for v in variables :
+            assert isinstance ( v , ROOT.RooAbsRealLValue ) , \
+                   "data_hist: invalid type of observable: %s" % type ( v )
+            vs.add ( v )
+        from ostap.core.core import dsID 
+        name  = name  if name  else dsID () 
+        title = title if title else 'Binned data from %s' % tree.GetName ()
+        dh    = ROOT.RooDataHist ( name , title , vs )
+        
+    ## comma or semicolumn separated list 
+    if isinstance ( what , string_types ) :
+        what = [ w.strip() for w in split_string ( what , ',;' ) ]
+    what = [ w.strip() for w in what ]
+    
+    sc = Ostap.HistoProject.project ( tree , dh , strings ( *what ) , cuts ,
+                                      nthreads if nthreads else 1 , *args )
+    if sc.isFailure() : logger.error ( "data_hist: error from Ostap::HistoProject::project %s" % sc )
+    
+    return dh 
+
+ROOT.TTree .data_hist = _data_hist_
+ROOT.TChain.data_hist = _data_hist_
+
 # =============================================================================
 ## check if object is in tree/chain  :
 #  @code
@@ -539,6 +996,32 @@ def _rt_contains_ ( tree , obj ) :
 ROOT.TTree .__contains__ = _rt_contains_
 ROOT.TChain.__contains__ = _rt_contains_
 
+# =============================================================================
+## helper function to split the optional arguments of <code>statVar(s)</code>
+#  into selection criteria and range of entries  
+def _stat_args_ ( *args ) :
+    """Helper function to split the optional arguments of `statVar(s)`
+    into selection criteria and range of entries 
+    """
+    cuts  = ''
+    if args and isinstance ( args [ 0 ] , string_types + ( ROOT.TCut , ) ) :
+        cuts = str ( args [ 0 ] ).strip ()
+        args = args [ 1 : ]
+    return ( cuts , ) + tuple ( args )
+
+# =============================================================================
+## use the multithreaded processing?
+#  - not for the datasets with the cut-range 
+def _stat_mt_ ( data , nthreads , *args ) :
+    """Use the multithreaded processing?
+    - not for the datasets with the cut-range 
+    """
+    if nthreads is None : return False
+    if isinstance ( data , ROOT.RooAbsData ) :
+        args = _stat_args_ ( *args ) [ 1 : ] 
+        if args and isinstance ( args [ 0 ] , string_types ) : return False 
+    return True 
+
 # =============================================================================
 ## get the statistic for certain expression(s) in Tree/Dataset
 #  @code
@@ -546,28 +1029,43 @@ ROOT.TChain.__contains__ = _rt_contains_
 #  stat1 = tree.statVar ( 'S_sw/effic' )
 #  stat2 = tree.statVar ( 'S_sw/effic' , 'pt>1000' )
 #  @endcode
+#  Use several threads:
+#  @code
+#  stat3 = tree.statVar ( 'S_sw/effic' , 'pt>1000' , nthreads = 8 )
+#  @endcode
+#  @see Ostap::StatVar::statVarMT
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
 #  @date   2013-09-15
-def _stat_var_ ( tree , expression , *cuts ) :
+def _stat_var_ ( tree , expression , *cuts , **kwargs ) :
     """Get a statistic for the  expression in Tree/Dataset
     
     >>> tree  = ... 
     >>> stat1 = tree.statVar ( 'S_sw/effic' )
     >>> stat2 = tree.statVar ( 'S_sw/effic' ,'pt>1000')
-    
+
+    Use several threads:
+    >>> stat3 = tree.statVar ( 'S_sw/effic' ,'pt>1000' , nthreads = 8 )
+    - see Ostap::StatVar::statVarMT     
     """
     
     if isinstance ( expression , string_types ) :
         
         explist = split_string ( expression , ' ,;:' )         
         if 1 != len ( explist ) :
-            return _stat_vars_ ( tree , explist , *cuts )  ## RETURRN
+            return _stat_vars_ ( tree , explist , *cuts , **kwargs )  ## RETURRN
         
     else :
         
-        return _stat_vars_ ( tree ,  expression , *cuts ) ## RETURN 
-    
-    return Ostap.StatVar.statVar ( tree , expression , *cuts )
+        return _stat_vars_ ( tree ,  expression , *cuts , **kwargs ) ## RETURN 
+
+    nthreads = kwargs.pop ( 'nthreads' , None )
+    assert not kwargs , 'statVar: unknown arguments %s' % list ( kwargs.keys() ) 
+        
+    if not _stat_mt_ ( tree , nthreads , *cuts ) :
+        return Ostap.StatVar.statVar ( tree , expression , *cuts )
+
+    args = _stat_args_ ( *cuts ) 
+    return Ostap.StatVar.statVarMT ( tree , expression , args [ 0 ] , nthreads , *args [ 1 : ] )
     
 ROOT.TTree     . statVar = _stat_var_
 ROOT.TChain    . statVar = _stat_var_
@@ -580,30 +1078,45 @@ ROOT.TChain    . statVar = _stat_var_
 #  stat2 = tree.statVars( [ 'S_sw/effic', 'pt1' , 'pt2' ] , 'mass>10') 
 #  @endcode
 #  It is more efficient than getting statistics individually for each expression
+#  Use several threads:
+#  @code
+#  stat3 = tree.statVars( [ 'S_sw/effic', 'pt1' , 'pt2' ] , 'mass>10' , nthreads = 8 ) 
+#  @endcode
 #  @see Ostap::Math::StatVar 
 #  @see Ostap::Math::StatVar::statVars 
+#  @see Ostap::Math::StatVar::statVarsMT 
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
 #  @date   2018-11-03
-def _stat_vars_ ( tree , expressions , *cuts ) :
+def _stat_vars_ ( tree , expressions , *cuts , **kwargs ) :
     """Get the statistic for certain expressions in Tree/Dataset
     >>> tree  = ... 
     >>> stat1 = tree.statVars( [ 'S_sw/effic', 'pt1' , 'pt2' ] ) 
     >>> stat2 = tree.statVars( [ 'S_sw/effic', 'pt1' , 'pt2' ] , 'mass>10') 
     - It is more efficient than getting statistics individually for each expression
+    Use several threads:
+    >>> stat3 = tree.statVars( [ 'S_sw/effic', 'pt1' , 'pt2' ] , 'mass>10' , nthreads = 8 ) 
     - see Ostap::Math::StatVar
     - see Ostap::Math::StatVar::statVars 
+    - see Ostap::Math::StatVar::statVarsMT 
     """
 
     if isinstance ( expressions , string_types ) :
-        return _stat_var_ ( tree , expressions , *cuts ) 
+        return _stat_var_ ( tree , expressions , *cuts , **kwargs ) 
     
     if not expressions : return {}
+
+    nthreads = kwargs.pop ( 'nthreads' , None )
+    assert not kwargs , 'statVars: unknown arguments %s' % list ( kwargs.keys() ) 
     
     vct = strings ( *expressions )
     res = std.vector(WSE)() 
 
-    ll  = Ostap.StatVar.statVars ( tree , res , vct , *cuts )
-
+    if not _stat_mt_ ( tree , nthreads , *cuts ) :
+        ll = Ostap.StatVar.statVars   ( tree , res , vct , *cuts )
+    else :
+        args = _stat_args_ ( *cuts ) 
+        ll   = Ostap.StatVar.statVarsMT ( tree , res , vct , args [ 0 ] , nthreads , *args [ 1 : ] )
+        
     assert res.size() == vct.size(), 'stat_vars: Invalid size of structures!'
 
     N = res.size()
@@ -627,12 +1140,17 @@ ROOT.TChain    . statVars = _stat_vars_
 #  # use only subset of events
 #  stat1 , stat2 , cov2 , len = tree.statCov ( 'x' , 'y' , 'z>0' , 100 , 10000 )
 #  @endcode
+#  Use several threads (for datasets):
+#  @code
+#  stat1 , stat2 , cov2 , len = data.statCov ( 'x' , 'y' , 'z>0' , nthreads = 8 )
+#  @endcode
+#  @see Ostap::StatVar::statCovMT
 #  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
 #  @date   2013-09-15
 def _stat_cov_ ( tree        ,
                  expression1 ,
                  expression2 ,
-                 cuts = ''   , *args  ) :
+                 cuts = ''   , *args , **kwargs ) :
     """Get the statistic for pair of expressions in Tree/Dataset
     
     >>>  tree  = ...
@@ -643,13 +1161,30 @@ def _stat_cov_ ( tree        ,
     
     Use only subset of events
     >>> stat1 , stat2 , cov2 , len = tree.statCov( 'x' , 'y' , 'z>0' , 100 , 10000 )
+
+    Use several threads (for datasets):
+    >>> stat1 , stat2 , cov2 , len = data.statCov( 'x' , 'y' , 'z>0' , nthreads = 8 )
+    - see Ostap::StatVar::statCovMT     
     """
+    nthreads = kwargs.pop ( 'nthreads' , None )
+    assert not kwargs , 'statCov: unknown arguments %s' % list ( kwargs.keys() ) 
+    
     import ostap.math.linalg 
     stat1  = Ostap.WStatEntity       ()
     stat2  = Ostap.WStatEntity       ()
     cov2   = Ostap.Math.SymMatrix(2) ()
 
-    if cuts : 
+    if isinstance ( tree , ROOT.RooAbsData ) and _stat_mt_ ( tree , nthreads , cuts , *args ) :
+        length = Ostap.StatVar.statCovMT ( tree        ,
+                                           expression1 ,
+                                           expression2 ,
+                                           str ( cuts ).strip () , 
+                                           stat1       ,
+                                           stat2       ,
+                                           cov2        ,
+                                           nthreads    , 
+                                           *args       )
+    elif cuts : 
         length = Ostap.StatVar.statCov ( tree        ,
                                          expression1 ,
                                          expression2 ,
@@ -729,7 +1264,7 @@ def _stat_covs_ ( tree        ,
     l = len(_vars)
     if 0 == length : 
         return None , None , 0 
-    elif l != len ( _stats ) or l*(l+1)/2 != len( _cov2 ):
+    elif l != len ( _stats ) or l*(l+1)//2 != len( _cov2 ):
         logger.error("statCovs: unexpected output %d/%s/%s" % ( l           ,
                                                                 len(_stats) ,
                                                                 len(_cov2 ) ) )
@@ -745,7 +1280,7 @@ def _stat_covs_ ( tree        ,
 
     for i in range( l ) :
         for j in range ( i + 1 ) :
-            ij = i * ( i + 1 ) / 2 + j
+            ij = i * ( i + 1 ) // 2 + j
             cov2[i,j] = _cov2[ ij ]
             
     return stats, cov2 , length
@@ -1437,22 +1972,44 @@ def _rc_getitem_ ( self , index ) :
 
 ROOT.TChain.__getitem__ = _rc_getitem_
 
+# =============================================================================
+## read the columns for the range of entries in a single pass
+#  @see Ostap::Utils::read_columns
+def _read_columns_ ( tree , names , cut , first , last , dtype , nthreads ) :
+    """Read the columns for the range of entries in a single pass
+    - see Ostap.Utils.read_columns
+    """
+    import numpy
+    last     = min ( last , len ( tree ) )
+    capacity = max ( 0 , last - first )
+    dtype    = numpy.float32 if numpy.dtype ( dtype ) == numpy.float32 else numpy.float64 
+    result   = numpy.empty ( ( len ( names ) , capacity ) , dtype = dtype ) 
+    if not capacity : return result
+    n = Ostap.Utils.read_columns ( tree , strings ( names ) , cut if cut else '' ,
+                                   result , capacity , first , last , nthreads )
+    return result [ : , : n ]
+
 # =============================================================================
 ## get "slice" from TTree in a form of numpy.array
+#  - all expressions and the selection are evaluated in a single pass 
 #  @code
 #  tree = ...
 #  varr = tree.slice('Pt','eta>3')
+#  varr = tree.slice('Pt eta phi','eta>3' , dtype = numpy.float32 , nthreads = 4 )
 #  print ( varr )  
 #  @endcode 
 #  @see numpy.array 
+#  @see Ostap::Utils::read_columns
 #  @author Albert BURSCHE
 #  @date 2015-07-08
-def _rt_slice_ ( tree , varname , cut = '' , weight = '' , transpose = False , first = 0 , last = _large ) :
+def _rt_slice_ ( tree , varname , cut = '' , weight = '' , transpose = False , first = 0 , last = _large , dtype = float , nthreads = 1 ) :
     """ Get ``slice'' from TTree in a form of numpy.array
-    ##
+    - all expressions and the selection are evaluated in a single pass 
     >>> tree = ...
     >>> varr , _  = tree.slice('Pt','eta>3')
+    >>> varr , _  = tree.slice('Pt eta phi','eta>3' , dtype = numpy.float32 , nthreads = 4 )
     >>> print ( varr )  
+    - see Ostap.Utils.read_columns
     """
 
     if isinstance ( varname , string_types ) : varname = split_string ( varname , ' ,;:' )
@@ -1464,46 +2021,168 @@ def _rt_slice_ ( tree , varname , cut = '' , weight = '' , transpose = False , f
         
     if not names : return () 
     
-    result = []
+    result = _read_columns_ ( tree , names , cut , first , last , dtype , nthreads )
     
-    import numpy    
-    for chunk in chunked ( names , 10 ) : ## blocks up to 10 variables 
-        
-        l    = len ( chunk )
-        vars = ':'.join ( chunk )
-
-        ge   = tree.GetEstimate() 
-        n    = tree.Draw ( vars , cut , "goff" , last , first )
-        n    = tree.GetSelectedRows () 
-        if 0 <= ge <= n + 1 :
-            tree.SetEstimate ( max ( n + 1 , ge ) )
-            n = tree.Draw ( vars , cut , "goff" )
-            n = tree.GetSelectedRows () 
-        
-        for k in range ( l ) :
-            result.append ( numpy.array ( numpy.frombuffer ( tree.GetVal ( k ) , count = n ) , copy = True ) )
-            
-        tree.SetEstimate ( ge ) 
-
-    if not result :
-        return None , None 
-        
     if weight :
-        weights = result[ -1]
-        result  = result[:-1]
+        weights = result [ -1  ]
+        result  = result [ :-1 ]
     else :
         weights = None 
 
-    if not result :
-        return result, weights 
-
-    result = numpy.stack ( result )
+    if not len ( result ) :
+        return (), weights 
 
     if transpose :
         result = result.transpose()
         
     return result, weights
 
+# =============================================================================
+## iterate over the "slices" from TTree in a form of numpy arrays, 
+#  keeping the memory under control (out-of-core processing)
+#  - the chunks of entries are aligned with the tree clusters 
+#  @code
+#  tree = ...
+#  for varr , weights in tree.slice_chunks ( 'pt eta phi' , 'chi2<10' , memory = 2**28 ) :
+#      ...
+#  @endcode 
+#  @param memory the (approximate) maximal size of the buffer in bytes 
+#  @see Ostap::Utils::read_columns
+def _rt_slice_chunks_ ( tree , varname , cut = '' , weight = '' , transpose = False , first = 0 , last = _large , dtype = float , nthreads = 1 , memory = 2**28 ) :
+    """ Iterate over the ``slices'' from TTree in a form of numpy arrays, 
+    keeping the memory under control (out-of-core processing)
+    - the chunks of entries are aligned with the tree clusters
+    - `memory` is the (approximate) maximal size of the buffer in bytes 
+    >>> tree = ...
+    >>> for varr , weights in tree.slice_chunks ( 'pt eta phi' , 'chi2<10' , memory = 2**28 ) :
+    ...     ...
+    - see Ostap.Utils.read_columns
+    """
+    if isinstance ( varname , string_types ) : varname = split_string ( varname , ' ,;:' )
+    names = []
+    for v in varname :
+        names += split_string ( v , ' ,;:' )
+    if weight : names.append ( weight )
+    if not names : return
+    
+    import numpy
+    last  = min ( last , len ( tree ) )
+    first = max ( 0 , first ) 
+    if last <= first : return
+
+    size  = numpy.dtype ( dtype ).itemsize * len ( names )
+    step  = max ( 1 , int ( memory ) // size ) 
+    
+    for chunk in cluster_slices ( tree.clusters () , first , last , step ) :
+        start , stop , _ = chunk.indices ( last ) 
+        result = _read_columns_ ( tree , names , cut , start , stop , dtype , nthreads )
+        if weight : result , weights = result [ :-1 ] , result [ -1 ]
+        else      :          weights = None 
+        yield ( result.transpose() if transpose else result ) , weights 
+
+# =============================================================================
+## iterate over fixed-size record batches from TTree/TChain
+#  - expressions and the selection are evaluated with <code>Ostap::Formula</code>
+#    in C++ (the same engine as for <code>StatVar</code>), see Ostap::Utils::read_columns 
+#  - each batch (except the last one) has exactly <code>batch_size</code> records 
+#  - the batch is a dictionary <code>{ expression : array }</code> 
+#    or numpy structured array (for <code>structured=True</code>)
+#  - with <code>prefetch=True</code> the next block of entries is read in 
+#    the background thread, while the current batch is processed 
+#  @code
+#  tree = ...
+#  for batch in tree.batches ( 'pt eta phi' , 'chi2<10' , batch_size = 4096 ) :
+#      model.train ( batch['pt'] , batch['eta'] , batch['phi'] ) 
+#  @endcode 
+#  @see Ostap::Utils::read_columns
+def _rt_batches_ ( tree               ,
+                   variables          ,
+                   cuts       = ''    ,
+                   batch_size = 10000 ,
+                   first      = 0     ,
+                   last       = _large , 
+                   dtype      = float ,
+                   structured = False ,
+                   prefetch   = True  ,
+                   nthreads   = 1     ) :
+    """Iterate over fixed-size record batches from TTree/TChain
+    - expressions and the selection are evaluated with `Ostap.Formula` in C++
+    (the same engine as for `StatVar`), see `Ostap.Utils.read_columns`
+    - each batch (except the last one) has exactly `batch_size` records 
+    - the batch is a dictionary { expression : array } or numpy structured array
+    (for `structured=True`)
+    - with `prefetch=True` the next block of entries is read in the background thread,
+    while the current batch is processed 
+    >>> tree = ...
+    >>> for batch in tree.batches ( 'pt eta phi' , 'chi2<10' , batch_size = 4096 ) :
+    ...     model.train ( batch['pt'] , batch['eta'] , batch['phi'] ) 
+    """
+    if isinstance ( variables , string_types ) : variables = split_string ( variables , ' ,;:' )
+    names = []
+    for v in variables :
+        names += split_string ( v , ' ,;:' )
+    if not names : return
+    
+    last  = min ( last , len ( tree ) )
+    first = max ( 0 , first ) 
+    if last <= first : return
+    
+    import numpy
+    batch_size = max ( 1 , batch_size ) 
+    dtype      = numpy.float32 if numpy.dtype ( dtype ) == numpy.float32 else numpy.float64
+    
+    def _read_ ( chunk ) :
+        start , stop , _ = chunk.indices ( last ) 
+        return _read_columns_ ( tree , names , cuts , start , stop , dtype , nthreads )
+
+    def _blocks_ () :
+        chunks = cluster_slices ( tree.clusters () , first , last , batch_size )
+        if not prefetch :
+            for chunk in chunks : yield _read_ ( chunk )
+            return
+        ## the tree is read in the background thread 
+        ROOT.ROOT.EnableThreadSafety () 
+        ## release the GIL for the C++ reading (if possible) 
+        try : 
+            Ostap.Utils.read_columns.__release_gil__ = True
+        except AttributeError :
+            pass
+        from concurrent.futures import ThreadPoolExecutor
+        with ThreadPoolExecutor ( max_workers = 1 ) as executor :
+            chunks  = iter ( chunks )
+            current = next ( chunks , None )
+            future  = executor.submit ( _read_ , current ) if current else None 
+            while future :
+                result  = future.result ()
+                current = next ( chunks , None )
+                future  = executor.submit ( _read_ , current ) if current else None 
+                yield result 
+
+    def _batch_ ( data ) :
+        if structured :
+            record = numpy.empty ( data.shape [ 1 ] , dtype = [ ( n , dtype ) for n in names ] )
+            for n , column in zip ( names , data ) : record [ n ] = column
+            return record
+        return dict ( ( n , column ) for n , column in zip ( names , data ) ) 
+
+    pending , npending = [] , 0 
+    for block in _blocks_ () :
+        if not block.shape [ 1 ] : continue 
+        pending .append ( block )
+        npending += block.shape [ 1 ] 
+        if npending < batch_size : continue
+        data = numpy.concatenate ( pending , axis = 1 ) if 1 < len ( pending ) else pending [ 0 ] 
+        nb   = data.shape [ 1 ] // batch_size 
+        for i in range ( nb ) :
+            yield _batch_ ( data [ : , i * batch_size : ( i + 1 ) * batch_size ] )
+        rest = data [ : , nb * batch_size : ]
+        pending , npending = ( [ rest ] if rest.shape [ 1 ] else [] ) , rest.shape [ 1 ] 
+        
+    if npending :
+        yield _batch_ ( numpy.concatenate ( pending , axis = 1 ) )
+
+ROOT.TTree.batches = _rt_batches_ 
+
 # =============================================================================
 ## get "slices" from TTree in a form of numpy.array
 #  @code
@@ -1518,7 +2197,7 @@ def _rt_slice_ ( tree , varname , cut = '' , weight = '' , transpose = False , f
 #  @see numpy.array 
 #  @author Albert BURSCHE
 #  @date 2015-07-08  
-def _rt_slices_ ( tree , varnames , cut = '' , weight = '' , transpose = False  , first = 0 , last = _large ) :
+def _rt_slices_ ( tree , varnames , cut = '' , weight = '' , transpose = False  , first = 0 , last = _large , dtype = float , nthreads = 1 ) :
     """ Get ``slices'' from TTree in a form of numpy.array
     
     >>> tree = ...
@@ -1533,11 +2212,12 @@ def _rt_slices_ ( tree , varnames , cut = '' , weight = '' , transpose = False
     >>> print vars3
     """
     #
-    return tree.slice ( varnames , cut , weight , transpose , first , last )
+    return tree.slice ( varnames , cut , weight , transpose , first , last , dtype , nthreads )
 
 
-ROOT.TTree .slice  = _rt_slice_
-ROOT.TTree .slices = _rt_slices_
+ROOT.TTree .slice        = _rt_slice_
+ROOT.TTree .slices       = _rt_slices_
+ROOT.TTree .slice_chunks = _rt_slice_chunks_
 
 
 # =============================================================================
@@ -1552,8 +2232,9 @@ ROOT.TTree .slices = _rt_slices_
 #  print varrs3
 #  @endcode 
 #  @see numpy.array 
-def _rc_slice_ ( chain , varname , cut = '' , weight = '', transpose = False ) :
+def _rc_slice_ ( chain , varname , cut = '' , weight = '', transpose = False , first = 0 , last = _large , dtype = float , nthreads = 1 ) :
     """Get ``slices'' from TChain in a form of numpy.array
+    - all files are processed in a single pass 
     >>> chain = ...
     >>> varrs1 = chain.slices ( ['Pt','eta'] , 'eta>3' )
     >>> print varrs1 
@@ -1563,33 +2244,7 @@ def _rc_slice_ ( chain , varname , cut = '' , weight = '', transpose = False ) :
     >>> print varrs3
     - see numpy.array 
     """
-
-    files = chain.files()
-    
-    import numpy    
-
-    result , weights = () , () 
-    
-    for  i , f in enumerate ( files ) :
-        
-        t = ROOT.TChain( chain.GetName() )
-        t.Add ( f )
-        
-        r , w = _rt_slice_ ( t , varname , cut , weight , transpose )
-        if 0 == i :
-            result  = r
-            weights = w
-        else :
-            result  = numpy.concatenate ( ( result  , r ) , axis = 0 if transpose else 1 )
-            
-            if    weight is None or 0 == len ( weights ) : weights = w
-            elif  w      is None or 0 == len ( w       ) : pass
-            else :
-                weights = numpy.concatenate ( ( weights , w ) )
-            
-        del t
-        
-    return result , weights
+    return _rt_slice_ ( chain , varname , cut , weight , transpose , first , last , dtype , nthreads )
 
 
 ROOT.TChain .slice  = _rc_slice_
@@ -1702,13 +2357,39 @@ def btypes_array ( obj ) :
     return False
 
     
+# ==============================================================================
+## report the statistics of the chain-wide update and recollect the chain
+#  @see Ostap::Trees::UpdateStat
+def _chain_updated_ ( chain , stat , verbose = True ) :
+    """Report the statistics of the chain-wide update and recollect the chain
+    - see Ostap::Trees::UpdateStat
+    """
+    message = 'add_branch: %d entries in %d files, %.3g entries/s' % ( stat.entries , stat.files , stat.rate () ) 
+    if   stat.failed : logger.error ( '%s, %d files failed!' % ( message , stat.failed ) )
+    elif verbose     : logger.info  ( message )
+    else             : logger.debug ( message )
+    
+    ## recollect the chain 
+    newc = ROOT.TChain ( chain.GetName () )
+    for f in chain.files () : newc.Add ( f  )    
+    return newc
+
 # ==============================================================================
 ## add new branch to the chain
 #  @see Ostap::Trees::add_branch
 #  @see Ostap::IFuncTree   
-def _chain_add_new_branch ( chain , name , function , verbose = True , value = 0 ) :
+#  - formulas, native functions, 1D-histograms and numerical arrays are
+#    treated by Ostap::Trees::add_branch_files: no per-file python loop,
+#    formulas and arrays are processed concurrently for <code>nthreads!=1</code>
+#  @see Ostap::Trees::add_branch_files 
+def _chain_add_new_branch ( chain , name , function , verbose = True , value = 0 , nthreads = 1 , atomic = True ) :
     """ Add new branch to the tree
+    - formulas, native functions, 1D-histograms and numerical arrays are
+      treated by Ostap::Trees::add_branch_files: no per-file python loop,
+      formulas and arrays are processed concurrently for `nthreads!=1`
+    - `atomic` : local files are updated via the temporary copies 
     - see Ostap::Trees::add_branch
+    - see Ostap::Trees::add_branch_files
     - see Ostap::IFuncTree 
     """
     assert isinstance ( chain , ROOT.TChain ), 'Invalid chain!'
@@ -1716,9 +2397,10 @@ def _chain_add_new_branch ( chain , name , function , verbose = True , value = 0
     if len ( chain.files() ) <= 1 :
         return add_new_branch ( chain               ,
                                 name     = name     ,
-                                function = fnuction , 
+                                function = function , 
                                 verbose  = verbose  ,
-                                value    = value    ) 
+                                value    = value    ,
+                                nthreads = nthreads ) 
     
     if isinstance ( function , dictlike_types ) :
         assert name     is None , 'add_branch: when function is dict, name must be None!'
@@ -1739,14 +2421,41 @@ def _chain_add_new_branch ( chain , name , function , verbose = True , value = 0
                                              name      = name     ,
                                              the_array = function ,
                                              verbose   = verbose  ,
-                                             value     = value    ) 
+                                             value     = value    ,
+                                             nthreads  = nthreads ,
+                                             atomic    = atomic   ) 
 
-
-
-    
     files = chain.files   ()
     cname = chain.GetName () 
+
+    ## (1) the native chain-wide update 
+    args = None 
+    if   isinstance ( name , dictlike_types ) and function is None :
+        if   all ( isinstance ( v , string_types    ) for v in name.values () ) :
+            mmap = std.map ( 'std::string' , 'std::string' ) ()
+            for k , v in name.items () : mmap [ k ] = v
+            args = mmap , nthreads , atomic 
+        elif all ( isinstance ( v , Ostap.IFuncTree ) for v in name.values () ) :
+            mmap = Ostap.Trees.FUNCTREEMAP ()
+            for k , v in name.items () : mmap [ k ] = v
+            args = mmap , atomic 
+    elif isinstance ( name , string_types ) :
+        if   isinstance ( function , string_types    ) :
+            mmap = std.map ( 'std::string' , 'std::string' ) ()
+            mmap [ name ] = function 
+            args = mmap , nthreads , atomic 
+        elif isinstance ( function , Ostap.IFuncTree ) :
+            mmap = Ostap.Trees.FUNCTREEMAP ()
+            mmap [ name ] = function 
+            args = mmap , atomic 
+        elif isinstance ( function , ROOT.TH1 ) and 1 == function.GetDimension () :
+            args = name , function , atomic
+            
+    if args :
+        stat = Ostap.Trees.add_branch_files ( strings ( files ) , cname , *args )
+        return _chain_updated_ ( chain , stat , verbose )
     
+    ## (2) generic case: loop over files 
 
     from ostap.utils.progress_bar import progress_bar
 
@@ -1764,7 +2473,8 @@ def _chain_add_new_branch ( chain , name , function , verbose = True , value = 0
                                 name     = name     ,
                                 function = function ,
                                 verbose  = verbose  ,
-                                value    = value    )
+                                value    = value    ,
+                                nthreads = nthreads )
             
     ## recollect the chain 
     newc = ROOT.TChain ( cname )
@@ -1779,10 +2489,15 @@ def _chain_add_new_branch ( chain , name , function , verbose = True , value = 0
 def _chain_add_new_branch_array ( chain           ,
                                   name            ,
                                   the_array       ,
-                                  verbose = True  ,
-                                  value   = 0     ) : 
+                                  verbose  = True ,
+                                  value    = 0    ,
+                                  nthreads = 1    ,
+                                  atomic   = True ) : 
     """ Add new branch to the tree
+    - numerical arrays are split between files and processed
+      by Ostap::Trees::add_branch_files 
     - see Ostap::Trees::add_branch
+    - see Ostap::Trees::add_branch_files
     - see Ostap::IFuncTree 
     """
     assert isinstance ( chain , ROOT.TChain ), 'Invalid chain!'
@@ -1799,7 +2514,25 @@ def _chain_add_new_branch_array ( chain           ,
     
     files = chain.files   ()
     cname = chain.GetName () 
-    
+
+    ## (1) the native chain-wide update for numerical arrays 
+    buff = None 
+    if   isinstance ( name , string_types ) and (6,24) <= root_info :
+        
+        if   isinstance ( the_array , array.array ) and the_array.typecode in ( 'f' , 'd' , 'i' , 'l' ) :
+            buff = the_array
+        elif numpy and isinstance ( the_array , numpy.ndarray ) and 1 == the_array.ndim and \
+             the_array.dtype in ( numpy.float32 , numpy.float64 , numpy.int32 , numpy.int64 ) :
+            data = numpy.ascontiguousarray ( the_array )
+            ct   = numpy.ctypeslib._ctype_from_dtype ( data.dtype )
+            buff = data.ctypes.data_as ( ctypes.POINTER ( ct ) )
+            
+    if not buff is None :
+        stat = Ostap.Trees.add_branch_files ( strings ( files ) , cname , name ,
+                                              buff  , len ( the_array ) , value , nthreads , atomic )
+        return _chain_updated_ ( chain , stat , verbose )
+
+    ## (2) generic case: loop over files 
     from ostap.utils.progress_bar import progress_bar
 
     verbose = verbose and 1 < len ( files )
@@ -1839,9 +2572,28 @@ def _chain_add_new_branch_array ( chain           ,
 # =============================================================================
 try : 
     import numpy, ctypes  
-except ImportErorr :
+except ImportError :
     numpy = None
     
+# =============================================================================
+## get the arguments for <code>Ostap::Trees::add_branch</code> from the array
+#  @return (buffer,size) for numpy/array.array and empty tuple otherwise 
+def _buffer_args_ ( data ) :
+    """Get the arguments for `Ostap.Trees.add_branch` from the array
+    - return (buffer,size) for numpy/array.array and empty tuple otherwise 
+    """
+    if (6,24) <= root_info and isinstance ( data , array.array ) and \
+           data.typecode in ( 'f' , 'd' , 'h' , 'i' , 'l' , 'H' , 'I' , 'L' ) :
+        return data , len ( data )
+    if numpy and (6,24) <= root_info and isinstance ( data , numpy.ndarray ) and \
+           1 == data.ndim and data.dtype in ( numpy.float32 , numpy.float64 ,
+                                              numpy.int16   , numpy.int32   , numpy.int64  ,
+                                              numpy.uint16  , numpy.uint32  , numpy.uint64 ) :
+        data = numpy.ascontiguousarray ( data ) 
+        ct   = numpy.ctypeslib._ctype_from_dtype ( data.dtype )
+        return data.ctypes.data_as ( ctypes.POINTER ( ct ) ) , len ( data ) 
+    return ()
+
 # ==============================================================================
 ## Add new branch to the tree
 # 
@@ -1893,12 +2645,17 @@ except ImportErorr :
 #   >>> tree.add_new_branch ( { 'pt2' : 'pt*pt'  ,
 #   ...                         'et2' : 'pt*pt+mass*mass' } , None ) ## use formulas
 #   @endcode
+#
+#   -  Several arrays can be stored at once:
+#   @code
+#   >>> tree.add_new_branch ( { 'cos_theta' : ct , 'phi' : phi } , None ) ## numpy or array.array
+#   @endcode
 #   @attention it makes a try to reopen the file with tree in UPDATE mode,
 #              and it fails when it is not possible!
 #
 #  @see Ostap::Trees::add_branch
 #  @see Ostap::IFuncTree 
-def add_new_branch ( tree , name , function , verbose = True , value = 0 ) :
+def add_new_branch ( tree , name , function , verbose = True , value = 0 , nthreads = 1 ) :
     """ Add new branch to the tree
 
     - Using formula:
@@ -1941,11 +2698,22 @@ def add_new_branch ( tree , name , function , verbose = True , value = 0 ) :
     >>> tree.add_new_branch ( { 'pt2' : 'pt*pt'  ,
     ...                         'et2' : 'pt*pt+mass*mass' } , None ) ## use formulas
     
+    -  Several arrays can be stored at once:
+    >>> tree.add_new_branch ( { 'cos_theta' : ct , 'phi' : phi } , None ) ## numpy or array.array
     
     - ATTENTION: it makes a try to reopen the file with tree in UPDATE mode,
     and it fails when it is not possible!
+
+    - the branch name with `/F` suffix creates the float branch:
+    >>> tree.add_new_branch ( { 'pt2/F' : 'pt*pt' } , None ) 
+
+    - for formulas several threads can be used
+    (`nthreads=0` : use the size of ROOT MT pool or the hardware concurrency):
+    >>> tree.add_new_branch ( { 'pt2' : 'pt*pt'  ,
+    ...                         'et2' : 'pt*pt+mass*mass' } , None , nthreads = 0 ) 
     
     - see Ostap::Trees::add_branch
+    - see Ostap::Trees::add_branchMT
     - see Ostap::IFuncTree
     
     """
@@ -1957,7 +2725,8 @@ def add_new_branch ( tree , name , function , verbose = True , value = 0 ) :
                                        name                ,
                                        function = function ,
                                        verbose  = verbose  ,
-                                       value    = value    )
+                                       value    = value    ,
+                                       nthreads = nthreads )
     
     if isinstance ( function , dictlike_types ) :
         assert name     is None , 'add_branch: when function is dict, name must be None!'
@@ -1969,12 +2738,26 @@ def add_new_branch ( tree , name , function , verbose = True , value = 0 ) :
     for n in names : 
         assert not n in tree.branches() ,"``Branch'' %s already exists!" % n
 
+    ## use multithreaded version for formulas only 
+    use_mt = False 
+
+    ## several arrays at once: each array is copied into its own branch 
+    arrays = () 
+
 
     assert ( isinstance ( name , dictlike_types ) and function is None ) or btypes ( function ) ,\
            "add_branch: invalid type of ``function'': %s/%s" % ( function , type ( function ) )  
 
 
-    if isinstance ( name  ,  dictlike_types ) and function is None :
+    if isinstance ( name  ,  dictlike_types ) and function is None and \
+           name and all ( _buffer_args_ ( v ) for v in name.values () ) :
+
+        for k in name.keys () : 
+            assert not k in tree.branches() ,'Branch %s already exists!' % k
+        arrays = tuple ( ( k , ) + _buffer_args_ ( v ) + ( value , ) for k , v in name.items () )
+        args   = ()
+        
+    elif isinstance ( name  ,  dictlike_types ) and function is None :
         
         typeformula = False 
         for k in  name.keys() :
@@ -1997,11 +2780,13 @@ def add_new_branch ( tree , name , function , verbose = True , value = 0 ) :
             ## mmap.insert ( PAIR ( k , v ) )
             mmap[ k ] = v 
             
-        args = mmap ,
+        args   = mmap ,
+        use_mt = 1 != nthreads and not typeformula 
         
     elif isinstance ( function , addbranch_types ) :
 
-        args = tuple ( [n  for n in names ] + [ function ] )
+        args   = tuple ( [n  for n in names ] + [ function ] )
+        use_mt = 1 != nthreads and 1 == len ( names ) and isinstance ( function , string_types )
 
 
     ## efficient case with array 
@@ -2060,7 +2845,12 @@ def add_new_branch ( tree , name , function , verbose = True , value = 0 ) :
         
         tfile.cd() 
         ttree = tfile.Get ( tpath )
-        sc    = Ostap.Trees.add_branch ( ttree , *args )
+        if   arrays :
+            for a in arrays :
+                sc = Ostap.Trees.add_branch ( ttree , *a )
+                if sc.isFailure () : break 
+        elif use_mt : sc = Ostap.Trees.add_branchMT ( ttree , *( args + ( nthreads , ) ) )
+        else        : sc = Ostap.Trees.add_branch   ( ttree , *args )
         if   sc.isFailure () :
             logger.error ( "Error from Ostap::Trees::add_branch %s" % sc )
         elif tfile.IsWritable() :
@@ -2096,12 +2886,104 @@ def add_reweighting ( tree , weighter , name = 'weight' ) :
     
     assert isinstance ( weighter , W.Weight ), "Invalid type of ``weighting''!"
     
-    ## create the weigthting function 
-    wfun = W.W2Tree ( weighter )
+    ## create the weigthting function: use the native C++ reweighter, if possible  
+    rw   = weighter.reweighter
+    wfun = Ostap.Functions.FuncReweight ( rw ) if rw else W.W2Tree ( weighter )
     
     return tree.add_new_branch (  name , wfun ) 
 
 ROOT.TTree.add_reweighting = add_reweighting
+
+# =============================================================================
+## the known polarization frames
+_polarization_frames_ = {
+    'helicity'         : 'Recoil'           ,
+    'recoil'           : 'Recoil'           ,
+    'hx'               : 'Recoil'           ,
+    'gottfriedjackson' : 'GottfriedJackson' ,
+    'gj'               : 'GottfriedJackson' ,
+    'target'           : 'Target'           ,
+    'collinssoper'     : 'CollinsSoper'     ,
+    'cs'               : 'CollinsSoper'     ,
+    }
+# =============================================================================
+## Add the polarization angles \f$(\cos\theta,\phi)\f$ as new branches
+#  - the 4-momenta of the particle and the mother are read from the tree
+#    in a single pass
+#  - the angles are calculated for all entries in one batched loop
+#  - both branches are added at once 
+#  @code
+#  tree  = ...
+#  beam1 = Ostap.LorentzVector ( 0 , 0 ,  6500 , 6500 )
+#  beam2 = Ostap.LorentzVector ( 0 , 0 , -6500 , 6500 )
+#  tree.add_polarization_angles ( ( 'mu_PX'   , 'mu_PY'   , 'mu_PZ'   , 'mu_PE'   ) ,
+#                                 ( 'jpsi_PX' , 'jpsi_PY' , 'jpsi_PZ' , 'jpsi_PE' ) ,
+#                                 beam1 , beam2 , frame = 'CS' , names = ( 'cos_cs' , 'phi_cs' ) )
+#  @endcode 
+#  @param particle 4 expressions for (px,py,pz,E) of the particle
+#  @param mother   4 expressions for (px,py,pz,E) of the particle that defines the frame 
+#  @param beam1    4-momentum of the first  beam 
+#  @param beam2    4-momentum of the second beam 
+#  @param frame    the frame: helicity, GJ, target, CS 
+#  @param names    the names of new branches 
+#  @param madison  use Madison convention?
+#  @param nthreads number of threads 
+#  @see Ostap::Math::Polarization::angles
+def add_polarization_angles ( tree                           ,
+                              particle                       ,
+                              mother                         ,
+                              beam1                          ,
+                              beam2                          ,
+                              frame    = 'helicity'          ,
+                              names    = ( 'cos_theta' , 'phi' ) ,
+                              madison  = True                ,
+                              nthreads = 1                   ) :
+    """ Add the polarization angles (cos theta, phi) as new branches
+    - the 4-momenta of the particle and the mother are read from the tree in a single pass
+    - the angles are calculated for all entries in one batched loop
+    - both branches are added at once 
+    >>> tree  = ...
+    >>> beam1 = Ostap.LorentzVector ( 0 , 0 ,  6500 , 6500 )
+    >>> beam2 = Ostap.LorentzVector ( 0 , 0 , -6500 , 6500 )
+    >>> tree.add_polarization_angles ( ( 'mu_PX'   , 'mu_PY'   , 'mu_PZ'   , 'mu_PE'   ) ,
+    ...                                ( 'jpsi_PX' , 'jpsi_PY' , 'jpsi_PZ' , 'jpsi_PE' ) ,
+    ...                                beam1 , beam2 , frame = 'CS' , names = ( 'cos_cs' , 'phi_cs' ) )
+    - see Ostap::Math::Polarization::angles
+    """
+    assert numpy , 'add_polarization_angles: numpy is required!'
+    assert 4 == len ( particle ) and 4 == len ( mother ) , \
+           'add_polarization_angles: four expressions are required for (px,py,pz,E)!'
+    assert 2 == len ( names ) , 'add_polarization_angles: two names are required!'
+
+    Frames = Ostap.Math.Polarization.Frames
+    if isinstance ( frame , string_types ) :
+        key = frame.lower().replace ( '-' , '' ).replace ( '_' , '' ).replace ( ' ' , '' )
+        assert key in _polarization_frames_ , 'add_polarization_angles: unknown frame %s' % frame
+        frame = getattr ( Frames , _polarization_frames_ [ key ] )
+
+    columns = _read_columns_ ( tree , list ( particle ) + list ( mother ) , '' ,
+                               0 , len ( tree ) , float , nthreads )
+    columns = numpy.ascontiguousarray ( columns )
+    n       = columns.shape [ 1 ]
+
+    cos_theta = numpy.empty ( n , dtype = numpy.float64 )
+    phi       = numpy.empty ( n , dtype = numpy.float64 )
+
+    Madison = Ostap.Math.Polarization.UseMadisonConvention
+    good    = Ostap.Math.Polarization.angles ( frame , n , *( [ columns [ i ] for i in range ( 8 ) ] +
+                                                            [ beam1 , beam2 , cos_theta , phi ,
+                                                              Madison ( bool ( madison ) ) , nthreads ] ) )
+    if good < n :
+        logger.warning ( 'add_polarization_angles: %d invalid entries' % ( n - good ) )
+
+    branches = { names [ 0 ] : cos_theta , names [ 1 ] : phi }
+    if isinstance ( tree , ROOT.TChain ) and 1 < len ( tree.files () ) :
+        for k , v in branches.items () : tree = tree.add_new_branch ( k , v , nthreads = nthreads )
+        return tree
+    
+    return tree.add_new_branch ( branches , None )
+
+ROOT.TTree.add_polarization_angles = add_polarization_angles
     
 
 # =============================================================================
@@ -2290,6 +3172,74 @@ def file_info ( fname ) :
         return s.st_mode , s.st_size , s.st_uid, s.st_gid, s.st_atime , s.st_mtime , s.st_ctime
     return 'Invalid'
 # =============================================================================
+## The files, known to this process, e.g. for the (persistent) parallel workers
+#  - number of entries in the trees : ( name , file , size , mtime ) -> entries
+#  - locally copied remote files    : ( remote-name , info )         -> local copy 
+#  Entries are valid as long as size and modification time of the file are the same
+_known_files = { 'entries' : {} , 'copies' : {} }
+# =============================================================================
+## get number of entries in the tree <code>name</code> from the file <code>fname</code>
+#  - the result is cached, the file is not opened for the second time 
+def tree_entries ( name , fname ) :
+    """Get number of entries in the tree `name` from the file `fname`
+    - the result is cached, the file is not opened for the second time 
+    """
+    finfo = file_info ( fname )
+    key   = ( name , fname ) + ( ( finfo [ 1 ] , finfo [ 5 ] ) if isinstance ( finfo , tuple ) else () )
+    cache = _known_files [ 'entries' ]
+    if isinstance ( finfo , tuple ) and key in cache : return cache [ key ]
+    t = ROOT.TChain ( name )
+    t.Add ( fname )
+    entries = t.GetEntries()
+    if isinstance ( finfo , tuple ) : cache [ key ] = entries
+    return entries 
+# =============================================================================
+## get the cluster boundaries for the tree <code>name</code> from the file <code>fname</code>
+#  - the result is taken from the persistent data catalog
+#  @see ostap.trees.catalog 
+def tree_clusters ( name , fname ) :
+    """Get the cluster boundaries for the tree `name` from the file `fname`
+    - the result is taken from the persistent data catalog
+    - see ostap.trees.catalog 
+    """
+    from ostap.trees.catalog import catalog 
+    record = catalog ().file_info ( fname , ( name , ) )
+    if not record : return ()
+    return record [ 'trees' ] [ name ] [ 'clusters' ]
+# =============================================================================
+## split the range of entries [first,last) into slices with approximately 
+#  <code>chunk_size</code> entries, aligned with the cluster boundaries
+#  - each cut is moved to the nearest cluster boundary,
+#  - clusters larger than <code>2*chunk_size</code> are split inside
+#  @code
+#  clusters = tree_clusters ( 'Bc/MyTree' , 'a.root' )
+#  for s in cluster_slices ( clusters , 0 , 1000000 , 100000 ) : ...
+#  @endcode
+def cluster_slices ( clusters , first , last , chunk_size ) :
+    """Split the range of entries [first,last) into slices with approximately
+    `chunk_size` entries, aligned with the cluster boundaries
+    - each cut is moved to the nearest cluster boundary,
+    - clusters larger than `2*chunk_size` are split inside
+    >>> clusters = tree_clusters ( 'Bc/MyTree' , 'a.root' )
+    >>> for s in cluster_slices ( clusters , 0 , 1000000 , 100000 ) : ...
+    """
+    import bisect 
+    bounds = sorted ( set ( [ first , last ] + [ c for c in clusters if first < c < last ] ) )
+    start  = first
+    while start < last :
+        target = start + chunk_size
+        if last <= target : stop = last
+        else :
+            i  = bisect.bisect_left ( bounds , target ) 
+            hi = bounds [ i ]
+            lo = bounds [ i - 1 ] if bounds [ i - 1 ] > start else None 
+            if   hi == target                                      : stop = hi
+            elif hi - start > 2 * chunk_size                       : stop = lo if lo else target 
+            elif lo is not None and target - lo <= hi - target     : stop = lo
+            else                                                   : stop = hi
+        yield slice ( start , stop )
+        start = stop 
+# =============================================================================
 from ostap.utils.cleanup  import CleanUp
 # =============================================================================
 ## @class Chain
@@ -2348,13 +3298,21 @@ class Chain(CleanUp) :
                 else :
                     # =========================================================
                     ## the file need to be copied locally
-                    full_name  = '%s:%s' % ( origin , fname ) 
+                    full_name  = '%s:%s' % ( origin , fname )
+                    ## already copied by this process? 
+                    copies     = _known_files [ 'copies' ]
+                    ckey       = full_name , finfo [:4] 
+                    copied     = copies.get ( ckey , None )
+                    if copied and file_info ( copied ) [:4] == finfo [:4] :
+                        files_.append ( copied )
+                        continue
                     copied , t = scp_copy   ( full_name )
                     if copied :
                         cinfo = file_info ( copied )
                         c = '%s -> %s' % ( full_name , "%s:%s" % ( self.__host , copied ) )
                         if cinfo[:4] == finfo [:4] :
                             files_.append ( copied )
+                            copies [ ckey ] = copied
                             size = cinfo[1]
                             s =  cinfo [ 1 ] / float ( 1024 ) / 1025 ##  MB 
                             v = s / t                  ## MB/s 
@@ -2485,9 +3443,7 @@ class Chain(CleanUp) :
             total  = 0 
             for f in self.__files :
                 
-                t = ROOT.TChain ( self.name )
-                t.Add ( f )
-                clen = t.GetEntries() 
+                clen = tree_entries ( self.name , f )
 
                 if _first < clen :
                     
@@ -2518,13 +3474,7 @@ class Chain(CleanUp) :
         """
         if self.__lens : return self.__lens
 
-        lens = []
-        for f in self.__files :
-            t = ROOT.TChain ( self.name )
-            t.Add ( f )
-            lens.append ( t.GetEntries () )
-            
-        self.__lens = tuple ( lens )
+        self.__lens = tuple ( tree_entries ( self.name , f ) for f in self.__files )
         return self.__lens
         
     ## split the chain for several chains  with at most chunk_size entries
@@ -2615,6 +3565,42 @@ class Chain(CleanUp) :
         
         if self.__chain is None : self.__chain = self.__create_chain () 
         return len ( self.__chain )
+
+    # =========================================================================
+    ## estimate the I/O cost (compressed bytes) to process this chain
+    #  - the compressed sizes of branches are taken from the persistent data catalog
+    #  @code
+    #  chain = ...
+    #  cost  = chain.io_cost ( branches = ( 'pt' , 'eta' ) )
+    #  @endcode
+    #  @see ostap.trees.catalog
+    def io_cost ( self , branches = () ) :
+        """Estimate the I/O cost (compressed bytes) to process this chain
+        - the compressed sizes of branches are taken from the persistent data catalog
+        >>> chain = ...
+        >>> cost  = chain.io_cost ( branches = ( 'pt' , 'eta' ) )
+        - see ostap.trees.catalog
+        """
+        from ostap.trees.catalog import catalog , io_cost
+        cat     = catalog ()
+        first   = self.__first
+        nevents = self.__nevents
+        total   = 0
+        for f in self.__files :
+            record = cat.file_info ( f , ( self.name , ) )
+            if not record : continue
+            info   = record [ 'trees' ] [ self.name ]
+            n      = info [ 'entries' ] 
+            if n <= first :
+                first -= n
+                continue
+            last   = n if nevents < 0 else min ( n , first + nevents ) 
+            total += io_cost ( info , first , last , branches )
+            if 0 <= nevents :
+                nevents -= last - first
+                if nevents <= 0 : break
+            first  = 0 
+        return total 
     
     def __create_chain ( self ) :
         """``chain'' : get the underlying tree/chain"""
@@ -2764,8 +3750,13 @@ class Tree(Chain) :
         ll   = len ( self )
         last = min ( ll , self.first + self.nevents if 0 <= self.nevents else _large ) 
 
+        ## align the slices with the cluster boundaries (if known)
+        clusters = tree_clusters ( self.name , self.file )
+        if 2 < len ( clusters ) : slices = cluster_slices ( clusters , self.first , last , chunk_size )
+        else                    : slices = self.get_slices (          self.first , last , chunk_size )
+        
         result = [] 
-        for s in self.get_slices ( self.first , last , chunk_size ) :
+        for s in slices :
             start , stop , stride = s.indices ( ll )
             if start < stop : 
                 t = Tree ( tree = self.chain , name = self.name , file = self.file , first = start , nevents = stop - start ) 
@@ -2832,12 +3823,23 @@ _new_methods_       = (
     ROOT.TTree. __len__   ,
     #
     ROOT.TTree. rows      ,
+    ROOT.TTree. eval_range,
+    ROOT.TTree. eval_chunks,
+    ROOT.TTree. clusters  ,
     #
     ROOT.TTree .__call__  ,
     ROOT.TChain.__call__  ,
     #
     ROOT.TTree .project   ,
     ROOT.TChain.project   ,
+    ROOT.TTree .project_many ,
+    ROOT.TChain.project_many ,
+    ROOT.TTree .bin_stat     ,
+    ROOT.TChain.bin_stat     ,
+    ROOT.TTree .bin_replicas ,
+    ROOT.TChain.bin_replicas ,
+    ROOT.TTree .data_hist    ,
+    ROOT.TChain.data_hist    ,
     #
     ROOT.TTree .statVar   ,
     ROOT.TChain.statVar   ,
@@ -2864,6 +3866,8 @@ _new_methods_       = (
     #
     ROOT.TTree.slice        ,
     ROOT.TTree.slices       ,
+    ROOT.TTree.slice_chunks ,
+    ROOT.TTree.batches      ,
     #
     ROOT.TTree.nEff             , 
     ROOT.TTree.get_moment       , 
@@ -2884,6 +3888,7 @@ _new_methods_       = (
     ROOT.TTree.the_variables    ,
     ROOT.TTree.add_new_branch   ,
     ROOT.TTree.add_reweighting  ,
+    ROOT.TTree.add_polarization_angles ,
     ##
     ROOT.TLeaf.get_type         ,
     ROOT.TLeaf.get_type_short   ,
@@ -22,6 +22,8 @@ __all__     = (
     'GslError'           , ## context manager to print  GSL errors 
     'GslCount'           , ## context manager to count  GSL errors 
     'GslException'       , ## context manager to turn   GSL errors into C++/Python exceptions
+    'gslNoRecord'        , ## context manager to disable the recording of GSL errors 
+    'gsl_counters'       , ## how often each GSL error has been fired? 
     'setHandler'         , ## use ``global'' GSL handler 
     'useHandler'         , ## ditto 
     )
@@ -162,6 +164,47 @@ def gslException ( force = True ) :
     return GslException ( force )
 
 
+# =============================================================================
+## Simple context manager to disable the recording of GSL errors
+#  for the current thread (e.g. for batch calculations) 
+#  The errors are still counted 
+#  @code
+#  with gslNoRecord() :
+#      ... do something 
+#  @endcode 
+#  @see Ostap::Utils::GslNoRecord
+class gslNoRecord(object) :
+    """Simple context manager to disable the recording of GSL errors
+    for the current thread (e.g. for batch calculations) 
+    The errors are still counted 
+    >>> with gslNoRecord () :
+    >>>    ... do something...
+    """
+    def __enter__ ( self ) :
+        self.previous = Ostap.Utils.GslCount.record ( False )
+        return self
+    def __exit__  ( self , *_ ) :
+        Ostap.Utils.GslCount.record ( self.previous )
+
+# =============================================================================
+## How often each GSL error has been fired?
+#  @code
+#  for code , n in gsl_counters().items() :
+#      ...
+#  @endcode 
+def gsl_counters () :
+    """How often each GSL error has been fired?
+    >>> for code , n in gsl_counters().items() :
+    >>>    ...
+    - returns the dictionary { code : number }
+    """
+    gsl_cnt = Ostap.Utils.GslCount
+    result  = {}
+    for code in range ( -2 , 33 ) :
+        n = gsl_cnt.counter ( code )
+        if n : result [ code ] = n 
+    return result 
+
 # =============================================================================
 _global_gsl_handler = [] 
 def _setHandler ( handler ) :
@@ -300,6 +343,8 @@ if '__main__' == __name__ :
     with gslCount ( force = True ) :
         for i in range ( 20 ) :
             Ostap.Math.psi ( -1 ) 
+            
+    logger.info ( 'GSL error counters %s' % gsl_counters () ) 
         
     logger.info ( 'Active handlers %s' % _global_gsl_handler ) 
     del   _global_gsl_handler[:]
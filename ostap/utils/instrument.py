@@ -0,0 +1,221 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# =============================================================================
+## @file ostap/utils/instrument.py
+#  Access to the (opt-in) instrumentation probes of the C++ hot paths:
+#  call counters and cumulative time for
+#  - <code>Ostap::Models::*::evaluate</code> and <code>analyticalIntegral</code>
+#  - computed/cached numerical integrals (<code>Ostap::Math::Integrator</code>)
+#  - <code>Ostap::Formula</code> evaluations
+#  - <code>Ostap::Utils::Notifier</code> notifications (file switches)
+#  - GSL errors and python callbacks (<code>Ostap::Functions::PyCallable</code>)
+#  - scratch allocations from the per-thread arenas (<code>Ostap::Utils::Arena</code>)
+#  and the memory counters for the pipeline stages of the multithreaded engines:
+#  RSS at the stage exit and the growth of the peak RSS during the stage 
+#
+#  The probes are compiled only for <code>-DOSTAP_INSTRUMENT=ON</code>,
+#  otherwise they have no cost and the counters are empty
+#  @code
+#  with Instrumentation () :
+#      pdf.fitTo ( dataset )
+#  ## at exit the table of counters is printed
+#  @endcode
+#  @see Ostap::Instrument
+#  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+#  @date   2026-10-15
+# =============================================================================
+"""Access to the (opt-in) instrumentation probes of the C++ hot paths:
+call counters and cumulative time for
+- `Ostap::Models::*::evaluate` and `analyticalIntegral`
+- computed/cached numerical integrals (`Ostap::Math::Integrator`)
+- `Ostap::Formula` evaluations
+- `Ostap::Utils::Notifier` notifications (file switches)
+- GSL errors and python callbacks (`Ostap::Functions::PyCallable`)
+- scratch allocations from the per-thread arenas (`Ostap::Utils::Arena`)
+and the memory counters for the pipeline stages of the multithreaded engines:
+RSS at the stage exit and the growth of the peak RSS during the stage 
+
+The probes are compiled only for `-DOSTAP_INSTRUMENT=ON`,
+otherwise they have no cost and the counters are empty
+
+>>> with Instrumentation () :
+...     pdf.fitTo ( dataset )
+## at exit the table of counters is printed
+"""
+# =============================================================================
+__author__  = "Vanya BELYAEV Ivan.Belyaev@itep.ru"
+__date__    = "2026-10-15"
+# =============================================================================
+__all__     = (
+    'instrumented'       , ## are the probes compiled?
+    'instrument_enable'  , ## activate/deactivate the probes
+    'instrument_reset'   , ## reset all counters
+    'instrument_counters', ## get the counters
+    'instrument_table'   , ## format the counters as table
+    'memory_stages'      , ## get the memory counters for the pipeline stages 
+    'memory_table'       , ## format the memory counters as table
+    'Instrumentation'    , ## context manager to collect and print the counters
+    'arena_heap_allocations' , ## number of heap allocations by the scratch arenas 
+    )
+# =============================================================================
+from   ostap.core.core     import Ostap
+from   ostap.logger.logger import getLogger
+if '__main__' ==  __name__ : logger = getLogger ( 'ostap.utils.instrument' )
+else                       : logger = getLogger ( __name__                 )
+# =============================================================================
+## are the instrumentation probes compiled?
+def instrumented () :
+    """Are the instrumentation probes compiled (-DOSTAP_INSTRUMENT=ON)?"""
+    return bool ( Ostap.Instrument.compiled () )
+
+# =============================================================================
+## activate/deactivate the probes, return the previous state
+def instrument_enable ( value = True ) :
+    """Activate/deactivate the probes, return the previous state"""
+    return bool ( Ostap.Instrument.enable ( True if value else False ) )
+
+# =============================================================================
+## reset all counters
+def instrument_reset () :
+    """Reset all counters"""
+    Ostap.Instrument.reset ()
+
+# =============================================================================
+## get the counters as the list of tuples <code>(name,calls,time)</code>,
+#  sorted by the time
+#  @code
+#  for name, calls, time in instrument_counters () : ...
+#  @endcode
+def instrument_counters ( reset = False ) :
+    """Get the counters as the list of tuples `(name,calls,time)`, sorted by the time
+    >>> for name, calls, time in instrument_counters () : ...
+    """
+    result = [ ( str ( e.name ) , int ( e.calls ) , float ( e.time ) ) for e in Ostap.Instrument.counters () ]
+    if reset : instrument_reset ()
+    return result
+
+# =============================================================================
+## total number of heap allocations made by the per-thread scratch arenas
+#  (available also for the non-instrumented build).
+#  In the steady state of the hot loop this number does not grow
+#  @code
+#  n0 = arena_heap_allocations ()
+#  pdf.fitTo ( dataset )
+#  n1 = arena_heap_allocations ()
+#  @endcode
+#  @see Ostap::Utils::Arena
+def arena_heap_allocations () :
+    """Total number of heap allocations made by the per-thread scratch arenas
+    (available also for the non-instrumented build).
+    In the steady state of the hot loop this number does not grow
+    >>> n0 = arena_heap_allocations ()
+    >>> pdf.fitTo ( dataset )
+    >>> n1 = arena_heap_allocations ()
+    - see Ostap::Utils::Arena
+    """
+    return int ( Ostap.Utils.Arena.total_heap_allocations () )
+
+# =============================================================================
+## format the counters as table
+#  @code
+#  print ( instrument_table ( prefix = '# ' ) )
+#  @endcode
+def instrument_table ( title = 'Instrumentation counters' , prefix = '' , reset = False ) :
+    """Format the counters as table
+    >>> print ( instrument_table ( prefix = '# ' ) )
+    """
+    counters = instrument_counters ( reset = reset )
+    total    = sum ( c [ 2 ] for c in counters )
+    rows     = [ ( 'Probe' , '#calls' , 'time [s]' , 'time/call [ns]' , 'fraction [%]' ) ]
+    for name , calls , time in counters :
+        row = ( name ,
+                '%d'   % calls ,
+                '%.4f' % time  ,
+                '%.1f' % ( 1.e+9 * time / calls ) if calls else '' ,
+                '%.1f' % ( 100.0 * time / total ) if 0 < total else '' )
+        rows.append ( row )
+    import ostap.logger.table as T
+    return T.table ( rows , title = title , prefix = prefix , alignment = 'lrrrr' )
+
+# =============================================================================
+## get the memory counters for the pipeline stages as the list of tuples
+#  <code>(name,calls,rss,growth)</code>, where <code>rss</code> is the maximal
+#  RSS at the stage exit and <code>growth</code> is the maximal growth
+#  of the peak RSS during the stage (both in MB)
+#  @code
+#  for name, calls, rss, growth in memory_stages () : ...
+#  @endcode
+def memory_stages ( reset = False ) :
+    """Get the memory counters for the pipeline stages as the list of tuples
+    `(name,calls,rss,growth)`, where `rss` is the maximal RSS at the stage exit 
+    and `growth` is the maximal growth of the peak RSS during the stage (both in MB)
+    >>> for name, calls, rss, growth in memory_stages () : ...
+    """
+    MB     = float ( 2 ** 20 )
+    result = [ ( str ( e.name ) , int ( e.calls ) , e.rss / MB , e.growth / MB ) for e in Ostap.Instrument.memory_counters () ]
+    if reset : instrument_reset ()
+    return result
+
+# =============================================================================
+## format the memory counters for the pipeline stages as table
+#  @code
+#  print ( memory_table ( prefix = '# ' ) )
+#  @endcode
+def memory_table ( title = 'Memory per stage' , prefix = '' , reset = False ) :
+    """Format the memory counters for the pipeline stages as table
+    >>> print ( memory_table ( prefix = '# ' ) )
+    """
+    rows = [ ( 'Stage' , '#calls' , 'RSS [MB]' , 'peak growth [MB]' ) ]
+    for name , calls , rss , growth in memory_stages ( reset = reset ) :
+        rows.append ( ( name , '%d' % calls , '%.1f' % rss , '%.1f' % growth ) )
+    import ostap.logger.table as T
+    return T.table ( rows , title = title , prefix = prefix , alignment = 'lrrr' )
+
+# =============================================================================
+## @class Instrumentation
+#  Context manager to activate the probes and print the counters at exit
+#  @code
+#  with Instrumentation () :
+#      pdf.fitTo ( dataset )
+#  @endcode
+class Instrumentation(object) :
+    """Context manager to activate the probes and print the counters at exit
+    >>> with Instrumentation () :
+    ...     pdf.fitTo ( dataset )
+    """
+    def __init__ ( self , title = 'Instrumentation counters' , logger = logger , reset = True ) :
+        self.__title  = title
+        self.__logger = logger
+        self.__reset  = reset
+        self.__prev   = False
+    def __enter__ ( self ) :
+        if not instrumented () :
+            self.__logger.warning ( 'Instrumentation probes are not compiled, use -DOSTAP_INSTRUMENT=ON' )
+        if self.__reset : instrument_reset ()
+        self.__prev = instrument_enable ( True )
+        return self
+    def __exit__ ( self , *_ ) :
+        instrument_enable ( self.__prev )
+        self.__logger.info ( '%s:\n%s' % ( self.__title , instrument_table ( self.__title , prefix = '# ' ) ) )
+        if memory_stages () :
+            self.__logger.info ( 'Memory per stage:\n%s' % memory_table ( prefix = '# ' ) )
+    @property
+    def counters ( self ) :
+        """`counters` : the current counters"""
+        return instrument_counters ()
+    @property
+    def memory ( self ) :
+        """`memory` : the current memory counters for the pipeline stages"""
+        return memory_stages ()
+
+# =============================================================================
+if '__main__' == __name__ :
+
+    from ostap.utils.docme import docme
+    docme ( __name__ , logger = logger )
+
+    logger.info ( 'Instrumentation probes are compiled: %s' % instrumented () )
+
+# =============================================================================
+##                                                                      The END
+# =============================================================================
@@ -23,6 +23,10 @@ __all__     = (
     'memory'         , # ditto
     'Memory'         , # ditto
     'memory_usage'   , # report current memory usage 
+    'peak_memory'    , # report peak memory usage (max RSS) 
+    'memory_budget'  , # get the memory budget for the C++ multithreaded engines
+    'set_memory_budget' , # set the memory budget for the C++ multithreaded engines
+    'MemoryBudget'   , # context manager to define the memory budget 
     )
 # =============================================================================
 import os  
@@ -79,6 +83,99 @@ except ImportError :
         except:
             return -1 
         
+# =============================================================================
+## report the peak memory usage (maximal resident set size, in MB)
+#  for this process and (optionally) for its terminated children
+#  @code
+#  print ( peak_memory () ) 
+#  @endcode
+def peak_memory ( children = False ) :
+    """Report the peak memory usage (maximal resident set size, in MB)
+    for this process and (optionally) for its terminated children
+    >>> print ( peak_memory () ) 
+    """
+    try :
+        import resource, sys 
+    except ImportError :
+        return -1
+    who   = resource.RUSAGE_CHILDREN if children else resource.RUSAGE_SELF
+    value = resource.getrusage ( who ).ru_maxrss
+    ## it is in bytes for MacOS and in kilobytes otherwise 
+    return value / float ( 2 ** 20 ) if 'darwin' == sys.platform else value / 1024.0 
+
+# =============================================================================
+## get the memory budget (in MB) for the C++ multithreaded engines
+#  (projections, dataset filling, ...), zero means no limit
+#  - the explicitly defined budget, if set
+#  - otherwise the environment variable <code>OSTAP_MEMORY_BUDGET</code> (in MB)
+#  @code
+#  print ( memory_budget () ) 
+#  @endcode
+#  @see Ostap::Utils::memory_budget
+def memory_budget () :
+    """Get the memory budget (in MB) for the C++ multithreaded engines
+    (projections, dataset filling, ...), zero means no limit
+    - the explicitly defined budget, if set
+    - otherwise the environment variable `OSTAP_MEMORY_BUDGET` (in MB)
+    >>> print ( memory_budget () ) 
+    - see Ostap::Utils::memory_budget
+    """
+    from ostap.core.core import Ostap
+    return Ostap.Utils.memory_budget () / float ( 2 ** 20 )
+
+# =============================================================================
+## set the memory budget (in MB) for the C++ multithreaded engines
+#  (projections, dataset filling, ...), zero means no limit.
+#  The number of per-thread buffers, histogram clones and the prefetch depth
+#  are adjusted to fit the budget 
+#  @code
+#  previous = set_memory_budget ( 2000 ) 
+#  @endcode
+#  @return the previous value of the budget (in MB)
+#  @see Ostap::Utils::set_memory_budget
+def set_memory_budget ( budget ) :
+    """Set the memory budget (in MB) for the C++ multithreaded engines
+    (projections, dataset filling, ...), zero means no limit.
+    The number of per-thread buffers, histogram clones and the prefetch depth
+    are adjusted to fit the budget 
+    >>> previous = set_memory_budget ( 2000 ) 
+    - see Ostap::Utils::set_memory_budget
+    """
+    assert 0 <= budget , 'set_memory_budget: invalid budget %s' % budget 
+    previous = memory_budget ()
+    from ostap.core.core import Ostap
+    Ostap.Utils.set_memory_budget ( LONG ( budget * 2 ** 20 ) )
+    return previous
+
+# =============================================================================
+## @class MemoryBudget
+#  Context manager to define the memory budget (in MB)
+#  for the C++ multithreaded engines
+#  @code
+#  with MemoryBudget ( 2000 ) :
+#      tree.project ( histo , 'x' , parallel = 8 ) 
+#  @endcode
+#  @see Ostap::Utils::set_memory_budget
+class MemoryBudget(object) :
+    """Context manager to define the memory budget (in MB)
+    for the C++ multithreaded engines
+    >>> with MemoryBudget ( 2000 ) :
+    ...     tree.project ( histo , 'x' , parallel = 8 ) 
+    """
+    def __init__  ( self , budget ) :
+        assert 0 <= budget , 'MemoryBudget: invalid budget %s' % budget 
+        self.__budget   = budget
+        self.__previous = None 
+    def __enter__ ( self ) :
+        self.__previous = set_memory_budget ( self.__budget )
+        return self
+    def __exit__  ( self , *_ ) :
+        set_memory_budget ( self.__previous )
+    @property
+    def budget ( self ) :
+        """``budget'' : the memory budget (in MB)"""
+        return self.__budget 
+
 # =============================================================================
 ## @class Memory
 #  Simple context manager to measure the virtual memory increase
@@ -62,6 +62,12 @@ __all__     = (
     ##
     'ImplicitMT'         , ## context manager to enable/disable implicit MT in ROOT 
     ##
+    'parallelProgress'   , ## context manager to show progress bar for parallel C++ engines
+    'ParallelProgress'   , ## context manager to show progress bar for parallel C++ engines
+    ##
+    'threadAffinity'     , ## context manager to configure NUMA-aware placement for parallel C++ engines
+    'ThreadAffinity'     , ## context manager to configure NUMA-aware placement for parallel C++ engines
+    ##
     'counted'            , ## decorator to create 'counted'-function
     ##
     'cmd_exists'         , ## check the existence of the certain command/executable
@@ -726,6 +732,119 @@ def implicitMT ( enable = True ) :
     """
     return ImplicitMT ( enable ) 
 
+# =============================================================================
+## Context manager to show (lock-free) progress bar for the
+#  parallel C++ engines (StatVar, HistoProject, add_branch, ...)
+#  @see Ostap::Utils::Progress 
+#  @code
+#  with ParallelProgress () :
+#  ...   < multithreaded processing of TTree/TChain >
+#  @endcode
+class ParallelProgress(object) :
+    """Context manager to show (lock-free) progress bar for the
+    parallel C++ engines (StatVar, HistoProject, add_branch, ...)
+    >>> with ParallelProgress () :
+    ...   < multithreaded processing of TTree/TChain >
+    - see Ostap::Utils::Progress 
+    """
+    def __init__  ( self , enable = True ) :
+        self.__enable = True if enable and isatty () else False 
+
+    @property
+    def enable   ( self ) : return self.__enable
+    
+    ## Context manager: ENTER 
+    def __enter__ ( self ) :
+        import cppyy
+        self.__progress = cppyy.gbl.Ostap.Utils.Progress 
+        self.__initial  = self.__progress.enable ( self.enable )
+        return self
+    
+    ## Context manager: EXIT
+    def __exit__ ( self , *_ ) :
+        self.__progress.enable ( self.__initial )
+
+# =============================================================================
+## Context manager to show (lock-free) progress bar for the
+#  parallel C++ engines (StatVar, HistoProject, add_branch, ...)
+#  @see Ostap::Utils::Progress 
+#  @code
+#  with parallelProgress () :
+#  ...   < multithreaded processing of TTree/TChain >
+#  @endcode
+def parallelProgress ( enable = True ) :
+    """Context manager to show (lock-free) progress bar for the
+    parallel C++ engines (StatVar, HistoProject, add_branch, ...)
+    >>> with parallelProgress () :
+    ...   < multithreaded processing of TTree/TChain >
+    - see Ostap::Utils::Progress 
+    """
+    return ParallelProgress ( enable ) 
+
+# =============================================================================
+## Context manager to configure the NUMA-aware placement of threads for the
+#  parallel C++ engines (StatVar, HistoProject, add_branch, parallel NLL, ...)
+#  - <code>policy</code> : <code>'none'</code>, <code>'compact'</code> or <code>'scatter'</code>
+#  - <code>premerge</code> : merge the partial results per NUMA node 
+#  @see Ostap::Utils::Affinity 
+#  @code
+#  with ThreadAffinity ( 'compact' ) :
+#  ...   < multithreaded processing of TTree/TChain >
+#  @endcode
+class ThreadAffinity(object) :
+    """Context manager to configure the NUMA-aware placement of threads for the
+    parallel C++ engines (StatVar, HistoProject, add_branch, parallel NLL, ...)
+    - `policy'   : `none', `compact' or `scatter'
+    - `premerge' : merge the partial results per NUMA node 
+    >>> with ThreadAffinity ( 'compact' ) :
+    ...   < multithreaded processing of TTree/TChain >
+    - see Ostap::Utils::Affinity 
+    """
+    __policies = { 'none' : 0 , 'compact' : 1 , 'scatter' : 2 }
+    
+    def __init__  ( self , policy = 'compact' , premerge = True ) :
+        if not policy : policy = 'none'
+        key = str ( policy ).strip().lower()
+        assert key in self.__policies , "ThreadAffinity: invalid policy `%s'" % policy
+        self.__policy   = self.__policies [ key ]
+        self.__premerge = True if premerge else False 
+
+    @property
+    def policy   ( self ) : return self.__policy
+
+    @property
+    def premerge ( self ) : return self.__premerge
+    
+    ## Context manager: ENTER 
+    def __enter__ ( self ) :
+        import cppyy
+        self.__affinity = cppyy.gbl.Ostap.Utils.Affinity 
+        self.__initial  = self.__affinity.setPolicy   ( self.policy   ) , \
+                          self.__affinity.setPremerge ( self.premerge )
+        return self
+    
+    ## Context manager: EXIT
+    def __exit__ ( self , *_ ) :
+        self.__affinity.setPolicy   ( self.__initial [ 0 ] )
+        self.__affinity.setPremerge ( self.__initial [ 1 ] )
+
+# =============================================================================
+## Context manager to configure the NUMA-aware placement of threads for the
+#  parallel C++ engines (StatVar, HistoProject, add_branch, parallel NLL, ...)
+#  @see Ostap::Utils::Affinity 
+#  @code
+#  with threadAffinity ( 'scatter' ) :
+#  ...   < multithreaded processing of TTree/TChain >
+#  @endcode
+def threadAffinity ( policy = 'compact' , premerge = True ) :
+    """Context manager to configure the NUMA-aware placement of threads for the
+    parallel C++ engines (StatVar, HistoProject, add_branch, parallel NLL, ...)
+    >>> with threadAffinity ( 'scatter' ) :
+    ...   < multithreaded processing of TTree/TChain >
+    - see Ostap::Utils::Affinity 
+    """
+    return ThreadAffinity ( policy , premerge ) 
+
 # =============================================================================
 ## Return the path to an executable which would be run if the given <code>cmd</code> was called.
 #  If no <code>cmd</code> would be called, return <code>None</code>.
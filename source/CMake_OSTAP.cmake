@@ -3,66 +3,98 @@ add_library(ostap SHARED src/format.cpp
                          src/gauss.cpp
                          src/AddBranch.cpp
                          src/AddVars.cpp
+                         src/Affinity.cpp
+                         src/AmplitudeSum.cpp
+                         src/Arena.cpp
                          src/BLOB.cpp
                          src/BSpline.cpp
+                         src/BatchCompute.cpp
                          src/Bernstein.cpp
                          src/Bernstein1D.cpp
                          src/Bernstein2D.cpp
                          src/Bernstein3D.cpp
+                         src/BinReplicas.cpp
+                         src/BinStat.cpp
+                         src/BinnedNLL.cpp
                          src/Binomial.cpp
                          src/BreitWigner.cpp
                          src/ChebyshevApproximation.cpp
                          src/Choose.cpp
                          src/Combine.cpp
+                         src/CompactData.cpp
                          src/Chi2Fit.cpp
+                         src/Covariance.cpp
                          src/Dalitz.cpp
                          src/DalitzIntegrator.cpp
+                         src/DataChunks.cpp
+                         src/DataColumns.cpp
                          src/DataFrameActions.cpp
+                         src/DataFrameFuncs.cpp
                          src/DataFrameUtils.cpp
+                         src/EfficiencyFit.cpp
                          src/EigenSystem.cpp   
                          src/Error2Exception.cpp   
                          src/Exception.cpp
                          src/Faddeeva.cpp 
+                         src/FFTConvolution.cpp
                          src/Formula.cpp   
                          src/FormulaVar.cpp   
                          src/Fourier.cpp   
+                         src/FrozenBasis.cpp
                          src/Funcs.cpp   
+                         src/FusedVar.cpp
+                         src/GradientNLL.cpp
                          src/GetWeight.cpp 
                          src/GSL_helpers.cpp              
                          src/GSL_sentry.cpp 
                          src/GSL_utils.cpp 
                          src/Hesse.cpp
+                         src/HistoCompare.cpp
                          src/HistoDump.cpp
                          src/HistoHash.cpp
                          src/HistoInterpolation.cpp
                          src/HistoInterpolators.cpp
                          src/HistoMake.cpp
+                         src/HistoParam.cpp
                          src/HistoProject.cpp
                          src/HistoStat.cpp
+                         src/HistoTables.cpp
                          src/IFuncs.cpp
+                         src/Instrument.cpp
+                         src/IntegrationCache.cpp
                          src/Integrator.cpp
                          src/Interpolation.cpp
+                         src/InverseCDF.cpp
                          src/Iterator.cpp
+                         src/KDE.cpp
+                         src/KDEPdf.cpp
+                         src/KeyIndex.cpp
                          src/Kinematics.cpp
                          src/KramersKronig.cpp
                          src/Lomont.cpp
                          src/LorentzVectorWithError.cpp
                          src/Math.cpp
                          src/MatrixUtils.cpp                         
+                         src/MemoryBudget.cpp
                          src/Models.cpp
                          src/Models2D.cpp
                          src/Moments.cpp
                          src/MoreMath.cpp
                          src/MoreRooFit.cpp
                          src/MoreVars.cpp
+                         src/Morphing.cpp
                          src/Mute.cpp
                          src/NStatEntity.cpp
+                         src/NativeFunctions.cpp
                          src/Notifier.cpp
                          src/Ostap.cpp
                          src/OstapDataFrame.cpp
                          src/P2Quantile.cpp
                          src/Parameterization.cpp
+                         src/ParallelNLL.cpp
                          src/Params.cpp
+                         src/PdfCurve.cpp
+                         src/PdfSummary.cpp
                          src/Peaks.cpp
                          src/PDFs.cpp
                          src/PDFs2D.cpp
@@ -74,6 +106,8 @@ add_library(ostap SHARED src/format.cpp
                          src/Polarization.cpp
                          src/Primitives.cpp
                          src/Printable.cpp
+                         src/Progress.cpp
+                         src/ProjectPlan.cpp
                          src/PyBLOB.cpp
                          src/PyCallable.cpp 
                          src/PyFuncs.cpp 
@@ -82,25 +116,38 @@ add_library(ostap SHARED src/format.cpp
                          src/PySelector.cpp
                          src/PySelectorWithCuts.cpp
                          src/PyVar.cpp   
+                         src/RandomStream.cpp
+                         src/Reweighter.cpp
                          src/RootID.cpp
                          src/SFactor.cpp
+                         src/Scattered.cpp
+                         src/Solver1D.cpp
+                         src/SWeights.cpp
                          src/StatEntity.cpp
                          src/StatVar.cpp
                          src/StatusCode.cpp
+                         src/TDigest.cpp
                          src/Tee.cpp
                          src/Tensors.cpp
                          src/Topics.cpp
                          src/Tmva.cpp
+                         src/TmvaForest.cpp
+                         src/TreeCache.cpp
                          src/TreeGetter.cpp
+                         src/UpdateFiles.cpp
                          src/UStat.cpp
                          src/Valid.cpp
                          src/ValueWithError.cpp
+                         src/VEArray.cpp
                          src/Vector3DWithError.cpp
                          src/Voigt.cpp
                          src/Workspace.cpp    
                          src/WStatEntity.cpp    
                          src/nSphere.cpp      
                          src/owens.cpp      
+                         src/local_mt.cpp
+                         src/clencurt.cpp
+                         src/tables.cpp
                          src/hcubature.cpp                         
                          src/pcubature.cpp
                         )
@@ -0,0 +1,241 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "RVersion.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "bench.h"
+// ============================================================================
+/** @file
+ *  The runner for the Ostap C++ benchmarks
+ *
+ *  @code
+ *  ostap_benchmarks [--filter=<substring>] [--min-time=<seconds>] [--json=<file>] [--list]
+ *  @endcode
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-03-24
+ */
+// ============================================================================
+// the registry of benchmarks
+// ============================================================================
+std::vector<Ostap::Bench::Benchmark>& Ostap::Bench::registry ()
+{
+  static std::vector<Ostap::Bench::Benchmark> s_registry {} ;
+  return s_registry ;
+}
+// ============================================================================
+void Ostap::Bench::State::start ()
+{
+  m_real    = 0 ;
+  m_cpu     = 0 ;
+  m_running = false ;
+  resume () ;
+}
+// ============================================================================
+void Ostap::Bench::State::stop () { pause () ; }
+// ============================================================================
+void Ostap::Bench::State::resume ()
+{
+  if ( m_running ) { return ; }
+  m_running = true ;
+  m_cpu0    = std::clock () ;
+  m_real0   = std::chrono::steady_clock::now () ;
+}
+// ============================================================================
+void Ostap::Bench::State::pause ()
+{
+  if ( !m_running ) { return ; }
+  const auto real1 = std::chrono::steady_clock::now () ;
+  const auto cpu1  = std::clock () ;
+  m_real   += std::chrono::duration<double> ( real1 - m_real0 ).count () ;
+  m_cpu    += double ( cpu1 - m_cpu0 ) / CLOCKS_PER_SEC ;
+  m_running = false ;
+}
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// the result of the single benchmark
+  struct Result
+  {
+    std::string name       {} ;
+    std::size_t iterations { 0 } ;
+    double      real_time  { 0 } ; // ns per iteration
+    double      cpu_time   { 0 } ; // ns per iteration
+    double      items      { 0 } ; // items per second
+  } ;
+  // ==========================================================================
+  /// escape the string for JSON
+  std::string _escape_ ( const std::string& s )
+  {
+    std::string r ;
+    for ( const char c : s )
+    {
+      if      ( '"'  == c ) { r += "\\\"" ; }
+      else if ( '\\' == c ) { r += "\\\\" ; }
+      else                  { r += c      ; }
+    }
+    return r ;
+  }
+  // ==========================================================================
+  /** run the benchmark: increase the number of iterations
+   *  until the minimal time is reached
+   */
+  Result _run_ ( const Ostap::Bench::Benchmark& b , const double min_time )
+  {
+    std::size_t iterations = 1 ;
+    while ( true )
+    {
+      Ostap::Bench::State state ( iterations ) ;
+      b.second ( state ) ;
+      //
+      const double t = state.real_time () ;
+      if ( min_time <= t || 1000000000 <= iterations )
+      {
+        Result r ;
+        r.name       = b.first ;
+        r.iterations = iterations ;
+        r.real_time  = 1.e+9 * t                  / iterations ;
+        r.cpu_time   = 1.e+9 * state.cpu_time ()  / iterations ;
+        r.items      = 0 < t ? state.items () * iterations / t : 0.0 ;
+        return r ;
+      }
+      // estimate the required number of iterations (with 40% margin)
+      const double scale = 0 < t ? 1.4 * min_time / t : 10.0 ;
+      iterations = static_cast<std::size_t>
+        ( iterations * std::min ( 10.0 , std::max ( 2.0 , scale ) ) ) ;
+    }
+  }
+  // ==========================================================================
+  /// write the results in the Google Benchmark-compatible JSON format
+  void _json_ ( std::ostream& out , const std::vector<Result>& results )
+  {
+    out << "{\n"
+        << "  \"context\": {\n"
+        << "    \"executable\": \"ostap_benchmarks\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency () << ",\n"
+        << "    \"root_version\": \"" << ROOT_RELEASE << "\",\n"
+        << "    \"library_build_type\": \"" <<
+#ifdef NDEBUG
+      "release"
+#else
+      "debug"
+#endif
+        << "\"\n"
+        << "  },\n"
+        << "  \"benchmarks\": [\n" ;
+    out << std::setprecision ( 10 ) ;
+    for ( std::size_t i = 0 ; i < results.size () ; ++i )
+    {
+      const Result& r = results [ i ] ;
+      out << "    {\n"
+          << "      \"name\": \""           << _escape_ ( r.name ) << "\",\n"
+          << "      \"run_name\": \""       << _escape_ ( r.name ) << "\",\n"
+          << "      \"run_type\": \"iteration\",\n"
+          << "      \"iterations\": "       << r.iterations << ",\n"
+          << "      \"real_time\": "        << r.real_time  << ",\n"
+          << "      \"cpu_time\": "         << r.cpu_time   << ",\n"
+          << "      \"time_unit\": \"ns\",\n"
+          << "      \"items_per_second\": " << r.items      << "\n"
+          << "    }" << ( i + 1 < results.size () ? "," : "" ) << "\n" ;
+    }
+    out << "  ]\n" << "}\n" ;
+  }
+  // ==========================================================================
+  /// get the value of the option --name=value
+  bool _option_ ( const char* arg , const char* name , std::string& value )
+  {
+    const std::size_t n = std::strlen ( name ) ;
+    if ( 0 != std::strncmp ( arg , name , n ) || '=' != arg [ n ] ) { return false ; }
+    value = arg + n + 1 ;
+    return true ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+int main ( int argc , char** argv )
+{
+  std::string filter   {} ;
+  std::string json     {} ;
+  double      min_time { 0.5 } ;
+  bool        list     { false } ;
+  //
+  for ( int i = 1 ; i < argc ; ++i )
+  {
+    std::string value ;
+    if      ( _option_ ( argv [ i ] , "--filter"   , value ) ) { filter   = value ; }
+    else if ( _option_ ( argv [ i ] , "--json"     , value ) ) { json     = value ; }
+    else if ( _option_ ( argv [ i ] , "--min-time" , value ) ) { min_time = std::atof ( value.c_str () ) ; }
+    else if ( 0 == std::strcmp ( argv [ i ] , "--list" ) )     { list     = true  ; }
+    else
+    {
+      std::cerr << "Usage: " << argv [ 0 ]
+                << " [--filter=<substring>] [--min-time=<seconds>] [--json=<file>] [--list]"
+                << std::endl ;
+      return 1 ;
+    }
+  }
+  //
+  std::vector<Ostap::Bench::Benchmark> selected ;
+  for ( const auto& b : Ostap::Bench::registry () )
+  { if ( filter.empty () || std::string::npos != b.first.find ( filter ) ) { selected.push_back ( b ) ; } }
+  std::sort ( selected.begin () , selected.end () ,
+              [] ( const Ostap::Bench::Benchmark& a ,
+                   const Ostap::Bench::Benchmark& b ) { return a.first < b.first ; } ) ;
+  //
+  if ( list )
+  {
+    for ( const auto& b : selected ) { std::cout << b.first << std::endl ; }
+    return 0 ;
+  }
+  //
+  std::size_t width = 10 ;
+  for ( const auto& b : selected ) { width = std::max ( width , b.first.size () ) ; }
+  //
+  std::cout << std::left  << std::setw ( width ) << "Benchmark"  << "  "
+            << std::right << std::setw ( 14 ) << "Time[ns]"      << "  "
+            << std::setw ( 14 ) << "CPU[ns]"                     << "  "
+            << std::setw ( 12 ) << "Iterations"                  << "  "
+            << std::setw ( 12 ) << "Items/s"                     << std::endl ;
+  //
+  std::vector<Result> results ;
+  for ( const auto& b : selected )
+  {
+    const Result r = _run_ ( b , min_time ) ;
+    results.push_back ( r ) ;
+    std::cout << std::left  << std::setw ( width ) << r.name     << "  "
+              << std::right << std::fixed << std::setprecision ( 2 )
+              << std::setw ( 14 ) << r.real_time                 << "  "
+              << std::setw ( 14 ) << r.cpu_time                  << "  "
+              << std::setw ( 12 ) << r.iterations                << "  "
+              << std::scientific  << std::setprecision ( 3 )
+              << std::setw ( 12 ) << r.items                     << std::endl ;
+  }
+  //
+  if ( !json.empty () )
+  {
+    std::ofstream out ( json ) ;
+    if ( !out ) { std::cerr << "Can't open the file " << json << std::endl ; return 2 ; }
+    _json_ ( out , results ) ;
+  }
+  //
+  return 0 ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
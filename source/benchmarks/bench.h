@@ -0,0 +1,142 @@
+// ============================================================================
+#ifndef OSTAP_BENCH_H
+#define OSTAP_BENCH_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <utility>
+// ============================================================================
+/** @file bench.h
+ *  Tiny self-contained harness for the micro/macro benchmarks
+ *  of the Ostap C++ core.
+ *
+ *  The JSON output follows the layout of Google Benchmark
+ *  (<code>context</code> + <code>benchmarks</code> with
+ *  <code>name</code>, <code>iterations</code>, <code>real_time</code>,
+ *  <code>cpu_time</code>, <code>time_unit</code>), therefore the standard
+ *  comparison tools can be used.
+ *
+ *  @code
+ *  OSTAP_BENCHMARK ( "math/Gauss/scalar" )
+ *  {
+ *     const Ostap::Math::Gauss g ( 0 , 1 ) ;
+ *     double x = -1 ;
+ *     while ( state.keep_running () )
+ *     { Ostap::Bench::do_not_optimize ( g ( x ) ) ; x += 1.e-6 ; }
+ *  }
+ *  @endcode
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-03-24
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Bench
+  {
+    // ========================================================================
+    /** @class State
+     *  the state of the running benchmark: it decides how many iterations
+     *  are needed to reach the minimal time
+     */
+    class State
+    {
+    public:
+      // ======================================================================
+      State ( const std::size_t iterations )
+        : m_iterations ( iterations )
+      {}
+      // ======================================================================
+      /// continue the loop ?
+      inline bool keep_running ()
+      {
+        if ( 0 == m_done ) { start () ; }
+        if ( m_done <  m_iterations ) { ++m_done ; return true ; }
+        stop () ;
+        return false ;
+      }
+      // ======================================================================
+      /// pause the timers (e.g. for expensive setup inside the loop)
+      void pause  () ;
+      /// resume the timers
+      void resume () ;
+      // ======================================================================
+      /// number of items processed per iteration (for the throughput)
+      void set_items_per_iteration ( const std::size_t n ) { m_items = n ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      std::size_t iterations () const { return m_iterations ; }
+      std::size_t items      () const { return m_items      ; }
+      /// elapsed real time in seconds
+      double      real_time  () const { return m_real       ; }
+      /// elapsed CPU  time in seconds
+      double      cpu_time   () const { return m_cpu        ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      void start () ;
+      void stop  () ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      std::size_t m_iterations { 1 } ;
+      std::size_t m_done       { 0 } ;
+      std::size_t m_items      { 1 } ;
+      double      m_real       { 0 } ;
+      double      m_cpu        { 0 } ;
+      bool        m_running    { false } ;
+      std::chrono::steady_clock::time_point m_real0 {} ;
+      std::clock_t                          m_cpu0  {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /// the benchmark function
+    typedef std::function<void(State&)>                  Function  ;
+    /// the benchmark: name & function
+    typedef std::pair<std::string,Function>              Benchmark ;
+    // ========================================================================
+    /// the registry of benchmarks
+    std::vector<Benchmark>& registry () ;
+    // ========================================================================
+    /// helper structure to register the benchmark at static initialization
+    struct Register
+    {
+      Register ( const std::string& name , Function f )
+      { registry().emplace_back ( name , f ) ; }
+    } ;
+    // ========================================================================
+    /// prevent the compiler from optimizing away the result
+    template <class TYPE>
+    inline void do_not_optimize ( const TYPE& value )
+    { asm volatile ( "" : : "m" ( value ) : "memory" ) ; }
+    // ========================================================================
+    /// prevent the compiler from caching the memory content in registers
+    inline void clobber_memory () { asm volatile ( "" : : : "memory" ) ; }
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Bench
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#define OSTAP_BENCH_CONCAT_(a,b) a##b
+#define OSTAP_BENCH_CONCAT(a,b)  OSTAP_BENCH_CONCAT_(a,b)
+/// define and register the benchmark
+#define OSTAP_BENCHMARK(NAME)                                                \
+  static void OSTAP_BENCH_CONCAT(ostap_bench_,__LINE__) ( Ostap::Bench::State& ) ; \
+  static const Ostap::Bench::Register                                        \
+  OSTAP_BENCH_CONCAT(ostap_bench_reg_,__LINE__)                              \
+  ( NAME , OSTAP_BENCH_CONCAT(ostap_bench_,__LINE__) ) ;                     \
+  static void OSTAP_BENCH_CONCAT(ostap_bench_,__LINE__) ( Ostap::Bench::State& state )
+// ============================================================================
+#endif // OSTAP_BENCH_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,190 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <memory>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TTree.h"
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TRandom3.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Integrator.h"
+#include "Ostap/HistoInterpolation.h"
+#include "Ostap/StatVar.h"
+#include "Ostap/HistoProject.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "bench.h"
+// ============================================================================
+/** @file
+ *  Benchmarks for the core machinery:
+ *  numerical integration (with and without cache), histogram
+ *  interpolation, and StatVar/HistoProject loops over the synthetic tree
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-03-24
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// the function to integrate
+  inline double _fun_ ( const double x ) { return std::exp ( -0.5 * x * x ) * ( 1 + 0.1 * x ) ; }
+  // ==========================================================================
+  /// number of entries in the synthetic tree
+  const unsigned long s_entries = 100000 ;
+  // ==========================================================================
+  /// the synthetic in-memory tree: (x,y) ~ 2D gaussian, w ~ uniform
+  TTree* _tree_ ()
+  {
+    static std::unique_ptr<TTree> s_tree {} ;
+    if ( s_tree ) { return s_tree.get () ; }
+    //
+    s_tree.reset ( new TTree ( "ostap_bench_tree" , "Synthetic tree for benchmarks" ) ) ;
+    s_tree->SetDirectory ( nullptr ) ;
+    Double_t x = 0 , y = 0 , w = 0 ;
+    s_tree->Branch ( "x" , &x , "x/D" ) ;
+    s_tree->Branch ( "y" , &y , "y/D" ) ;
+    s_tree->Branch ( "w" , &w , "w/D" ) ;
+    TRandom3 rnd ( 12345 ) ;
+    for ( unsigned long i = 0 ; i < s_entries ; ++i )
+    {
+      x = rnd.Gaus ( 0 , 1 ) ;
+      y = rnd.Gaus ( 0 , 2 ) ;
+      w = rnd.Uniform ( 0 , 1 ) ;
+      s_tree->Fill () ;
+    }
+    s_tree->ResetBranchAddresses () ;
+    return s_tree.get () ;
+  }
+  // ==========================================================================
+  /// the histogram for interpolation
+  const TH1D& _histo1_ ()
+  {
+    static std::unique_ptr<TH1D> s_histo {} ;
+    if ( s_histo ) { return *s_histo ; }
+    s_histo.reset ( new TH1D ( "ostap_bench_h1" , "" , 100 , -5 , 5 ) ) ;
+    s_histo->SetDirectory ( nullptr ) ;
+    for ( int i = 1 ; i <= s_histo->GetNbinsX () ; ++i )
+    { s_histo->SetBinContent ( i , 1000 * _fun_ ( s_histo->GetBinCenter ( i ) ) ) ; }
+    return *s_histo ;
+  }
+  // ==========================================================================
+  /// the 2D-histogram for interpolation
+  const TH2D& _histo2_ ()
+  {
+    static std::unique_ptr<TH2D> s_histo {} ;
+    if ( s_histo ) { return *s_histo ; }
+    s_histo.reset ( new TH2D ( "ostap_bench_h2" , "" , 50 , -5 , 5 , 50 , -5 , 5 ) ) ;
+    s_histo->SetDirectory ( nullptr ) ;
+    for ( int i = 1 ; i <= s_histo->GetNbinsX () ; ++i )
+    {
+      for ( int j = 1 ; j <= s_histo->GetNbinsY () ; ++j )
+      {
+        s_histo->SetBinContent
+          ( i , j , 1000 * _fun_ ( s_histo->GetXaxis()->GetBinCenter ( i ) ) *
+            _fun_ ( s_histo->GetYaxis()->GetBinCenter ( j ) ) ) ;
+      }
+    }
+    return *s_histo ;
+  }
+  // ==========================================================================
+  /// 1D-interpolation
+  void _interpolate_1D_ ( Ostap::Bench::State&                          state ,
+                          const Ostap::Math::HistoInterpolation::Type   t     )
+  {
+    const TH1D& h = _histo1_ () ;
+    double x = -4.5 ;
+    while ( state.keep_running () )
+    {
+      Ostap::Bench::do_not_optimize
+        ( Ostap::Math::HistoInterpolation::interpolate_1D ( h , x , t ) ) ;
+      x += 0.001 ; if ( 4.5 < x ) { x = -4.5 ; }
+    }
+  }
+  // ==========================================================================
+  /// 2D-interpolation
+  void _interpolate_2D_ ( Ostap::Bench::State&                          state ,
+                          const Ostap::Math::HistoInterpolation::Type   t     )
+  {
+    const TH2D& h = _histo2_ () ;
+    double x = -4.5 ;
+    double y = -4.0 ;
+    while ( state.keep_running () )
+    {
+      Ostap::Bench::do_not_optimize
+        ( Ostap::Math::HistoInterpolation::interpolate_2D ( h , x , y , t , t ) ) ;
+      x += 0.001 ; if ( 4.5 < x ) { x = -4.5 ; }
+      y += 0.003 ; if ( 4.5 < y ) { y = -4.5 ; }
+    }
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// integration
+// ============================================================================
+OSTAP_BENCHMARK ( "integrator/uncached" )
+{
+  const Ostap::Math::Integrator integrator {} ;
+  while ( state.keep_running () )
+  { Ostap::Bench::do_not_optimize ( integrator.integrate ( &_fun_ , -3.0 , 3.0 ) ) ; }
+}
+// ============================================================================
+OSTAP_BENCHMARK ( "integrator/cached" )
+{
+  const Ostap::Math::Integrator integrator {} ;
+  const std::size_t             tag = 20230324 ;
+  while ( state.keep_running () )
+  { Ostap::Bench::do_not_optimize ( integrator.integrate ( &_fun_ , -3.0 , 3.0 , tag ) ) ; }
+}
+// ============================================================================
+// histogram interpolation
+// ============================================================================
+OSTAP_BENCHMARK ( "histo/interpolate_1D/nearest" )
+{ _interpolate_1D_ ( state , Ostap::Math::HistoInterpolation::Nearest ) ; }
+OSTAP_BENCHMARK ( "histo/interpolate_1D/linear" )
+{ _interpolate_1D_ ( state , Ostap::Math::HistoInterpolation::Linear  ) ; }
+OSTAP_BENCHMARK ( "histo/interpolate_1D/cubic" )
+{ _interpolate_1D_ ( state , Ostap::Math::HistoInterpolation::Cubic   ) ; }
+OSTAP_BENCHMARK ( "histo/interpolate_2D/linear" )
+{ _interpolate_2D_ ( state , Ostap::Math::HistoInterpolation::Linear  ) ; }
+OSTAP_BENCHMARK ( "histo/interpolate_2D/cubic" )
+{ _interpolate_2D_ ( state , Ostap::Math::HistoInterpolation::Cubic   ) ; }
+// ============================================================================
+// loops over the tree
+// ============================================================================
+OSTAP_BENCHMARK ( "tree/statVar" )
+{
+  TTree* tree = _tree_ () ;
+  state.set_items_per_iteration ( s_entries ) ;
+  while ( state.keep_running () )
+  { Ostap::Bench::do_not_optimize ( Ostap::StatVar::statVar ( tree , "x*x+y" ) ) ; }
+}
+// ============================================================================
+OSTAP_BENCHMARK ( "tree/statVar/cuts" )
+{
+  TTree* tree = _tree_ () ;
+  state.set_items_per_iteration ( s_entries ) ;
+  while ( state.keep_running () )
+  { Ostap::Bench::do_not_optimize ( Ostap::StatVar::statVar ( tree , "x*x+y" , "w*(0<y)" ) ) ; }
+}
+// ============================================================================
+OSTAP_BENCHMARK ( "tree/project" )
+{
+  TTree* tree = _tree_ () ;
+  TH1D   histo ( "ostap_bench_project" , "" , 100 , -5 , 5 ) ;
+  histo.SetDirectory ( nullptr ) ;
+  state.set_items_per_iteration ( s_entries ) ;
+  while ( state.keep_running () )
+  { Ostap::Bench::do_not_optimize ( Ostap::HistoProject::project ( tree , &histo , "x+y" , "w*(0<y)" ) ) ; }
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
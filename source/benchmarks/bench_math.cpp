@@ -0,0 +1,189 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Peaks.h"
+#include "Ostap/Models.h"
+#include "Ostap/Bernstein.h"
+#include "Ostap/Bernstein1D.h"
+#include "Ostap/BSpline.h"
+#include "Ostap/ValueWithError.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "bench.h"
+// ============================================================================
+/** @file
+ *  Benchmarks for the basic functions from Ostap::Math:
+ *  peaks, backgrounds, polynomials and splines, ValueWithError arithmetic
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-03-24
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// number of points for the array evaluation
+  const std::size_t s_N = 1024 ;
+  // ==========================================================================
+  /// uniform grid of points in [low,high]
+  std::vector<double> _grid_ ( const double low , const double high )
+  {
+    std::vector<double> x ( s_N ) ;
+    for ( std::size_t i = 0 ; i < s_N ; ++i )
+    { x [ i ] = low + ( high - low ) * ( i + 0.5 ) / s_N ; }
+    return x ;
+  }
+  // ==========================================================================
+  /// scalar evaluation over the grid
+  template <class FUNCTION>
+  void _scalar_ ( Ostap::Bench::State& state  ,
+                  const FUNCTION&      fun    ,
+                  const double         low    ,
+                  const double         high   )
+  {
+    const std::vector<double> x = _grid_ ( low , high ) ;
+    state.set_items_per_iteration ( s_N ) ;
+    while ( state.keep_running () )
+    {
+      double sum = 0 ;
+      for ( const double v : x ) { sum += fun ( v ) ; }
+      Ostap::Bench::do_not_optimize ( sum ) ;
+    }
+  }
+  // ==========================================================================
+  /// array evaluation over the grid
+  template <class FUNCTION>
+  void _array_ ( Ostap::Bench::State& state  ,
+                 const FUNCTION&      fun    ,
+                 const double         low    ,
+                 const double         high   )
+  {
+    const std::vector<double> x = _grid_ ( low , high ) ;
+    std::vector<double>       r ( s_N ) ;
+    state.set_items_per_iteration ( s_N ) ;
+    while ( state.keep_running () )
+    {
+      fun.evaluate ( s_N , x.data () , r.data () ) ;
+      Ostap::Bench::clobber_memory () ;
+    }
+  }
+  // ==========================================================================
+  /// the definite integral over the sliding interval
+  template <class FUNCTION>
+  void _integral_ ( Ostap::Bench::State& state  ,
+                    const FUNCTION&      fun    ,
+                    const double         low    ,
+                    const double         high   )
+  {
+    double x = low ;
+    const double dx = ( high - low ) / s_N ;
+    while ( state.keep_running () )
+    {
+      Ostap::Bench::do_not_optimize ( fun.integral ( x , high ) ) ;
+      x += dx ; if ( high <= x ) { x = low ; }
+    }
+  }
+  // ==========================================================================
+  /// the polynomial with "random" parameters
+  template <class POLY>
+  POLY _poly_ ( POLY p )
+  {
+    for ( unsigned short k = 0 ; k < p.npars () ; ++k )
+    { p.setPar ( k , 0.5 + 0.1 * ( k % 7 ) ) ; }
+    return p ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// peaks
+// ============================================================================
+OSTAP_BENCHMARK ( "math/Gauss/scalar" )
+{ _scalar_   ( state , Ostap::Math::Gauss ( 0 , 1 ) , -5 , 5 ) ; }
+OSTAP_BENCHMARK ( "math/Gauss/array" )
+{ _array_    ( state , Ostap::Math::Gauss ( 0 , 1 ) , -5 , 5 ) ; }
+OSTAP_BENCHMARK ( "math/Gauss/integral" )
+{ _integral_ ( state , Ostap::Math::Gauss ( 0 , 1 ) , -5 , 5 ) ; }
+// ============================================================================
+OSTAP_BENCHMARK ( "math/BifurcatedGauss/scalar" )
+{ _scalar_   ( state , Ostap::Math::BifurcatedGauss ( 0 , 1 , 2 ) , -5 , 5 ) ; }
+OSTAP_BENCHMARK ( "math/BifurcatedGauss/array" )
+{ _array_    ( state , Ostap::Math::BifurcatedGauss ( 0 , 1 , 2 ) , -5 , 5 ) ; }
+OSTAP_BENCHMARK ( "math/BifurcatedGauss/integral" )
+{ _integral_ ( state , Ostap::Math::BifurcatedGauss ( 0 , 1 , 2 ) , -5 , 5 ) ; }
+// ============================================================================
+OSTAP_BENCHMARK ( "math/CrystalBall/scalar" )
+{ _scalar_   ( state , Ostap::Math::CrystalBall ( 0 , 1 , 1.5 , 2 ) , -5 , 5 ) ; }
+OSTAP_BENCHMARK ( "math/CrystalBall/array" )
+{ _array_    ( state , Ostap::Math::CrystalBall ( 0 , 1 , 1.5 , 2 ) , -5 , 5 ) ; }
+OSTAP_BENCHMARK ( "math/CrystalBall/integral" )
+{ _integral_ ( state , Ostap::Math::CrystalBall ( 0 , 1 , 1.5 , 2 ) , -5 , 5 ) ; }
+// ============================================================================
+OSTAP_BENCHMARK ( "math/Bukin/scalar" )
+{ _scalar_   ( state , Ostap::Math::Bukin ( 0 , 1 , 0.1 , -0.1 , 0.1 ) , -5 , 5 ) ; }
+OSTAP_BENCHMARK ( "math/Bukin/array" )
+{ _array_    ( state , Ostap::Math::Bukin ( 0 , 1 , 0.1 , -0.1 , 0.1 ) , -5 , 5 ) ; }
+// ============================================================================
+// backgrounds
+// ============================================================================
+OSTAP_BENCHMARK ( "math/ExpoPositive/scalar" )
+{ _scalar_   ( state , _poly_ ( Ostap::Math::ExpoPositive ( 3 , -1 , 0 , 10 ) ) , 0 , 10 ) ; }
+OSTAP_BENCHMARK ( "math/ExpoPositive/integral" )
+{ _integral_ ( state , _poly_ ( Ostap::Math::ExpoPositive ( 3 , -1 , 0 , 10 ) ) , 0 , 10 ) ; }
+// ============================================================================
+// polynomials & splines
+// ============================================================================
+OSTAP_BENCHMARK ( "poly/Bernstein/scalar" )
+{ _scalar_   ( state , _poly_ ( Ostap::Math::Bernstein ( 10 , 0 , 10 ) ) , 0 , 10 ) ; }
+OSTAP_BENCHMARK ( "poly/Bernstein/array" )
+{ _array_    ( state , _poly_ ( Ostap::Math::Bernstein ( 10 , 0 , 10 ) ) , 0 , 10 ) ; }
+OSTAP_BENCHMARK ( "poly/Bernstein/integral" )
+{ _integral_ ( state , _poly_ ( Ostap::Math::Bernstein ( 10 , 0 , 10 ) ) , 0 , 10 ) ; }
+// ============================================================================
+OSTAP_BENCHMARK ( "poly/Positive/scalar" )
+{ _scalar_   ( state , _poly_ ( Ostap::Math::Positive ( 10 , 0 , 10 ) ) , 0 , 10 ) ; }
+OSTAP_BENCHMARK ( "poly/Positive/array" )
+{ _array_    ( state , _poly_ ( Ostap::Math::Positive ( 10 , 0 , 10 ) ) , 0 , 10 ) ; }
+OSTAP_BENCHMARK ( "poly/Positive/integral" )
+{ _integral_ ( state , _poly_ ( Ostap::Math::Positive ( 10 , 0 , 10 ) ) , 0 , 10 ) ; }
+// ============================================================================
+OSTAP_BENCHMARK ( "poly/BSpline/scalar" )
+{ _scalar_   ( state , _poly_ ( Ostap::Math::BSpline ( 0 , 10 , 5 , 3 ) ) , 0 , 10 ) ; }
+OSTAP_BENCHMARK ( "poly/BSpline/integral" )
+{ _integral_ ( state , _poly_ ( Ostap::Math::BSpline ( 0 , 10 , 5 , 3 ) ) , 0 , 10 ) ; }
+// ============================================================================
+// ValueWithError arithmetic
+// ============================================================================
+OSTAP_BENCHMARK ( "ve/arithmetic" )
+{
+  typedef Ostap::Math::ValueWithError VE ;
+  const VE a ( 10 , 1 ) ;
+  const VE b (  5 , 4 ) ;
+  VE r ( 0 , 0 ) ;
+  while ( state.keep_running () )
+  {
+    r  = a + b ;
+    r *= a - b ;
+    r /= b ;
+    Ostap::Bench::do_not_optimize ( r ) ;
+  }
+}
+// ============================================================================
+OSTAP_BENCHMARK ( "ve/functions" )
+{
+  typedef Ostap::Math::ValueWithError VE ;
+  const VE a ( 2 , 0.1 ) ;
+  while ( state.keep_running () )
+  {
+    const VE r = Ostap::Math::exp ( a ) + Ostap::Math::sqrt ( a ) ;
+    Ostap::Bench::do_not_optimize ( r ) ;
+  }
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
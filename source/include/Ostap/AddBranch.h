@@ -69,6 +69,10 @@ namespace Ostap
     // ========================================================================
     /** add new branches to the tree
      *  the value of the branch each  is taken from <code>branches</code>
+     *  - identical formulas are evaluated once 
+     *  - only the branches, needed for formulas, are read 
+     *  - the name with suffix <code>"/F"</code> (e.g. <code>"pt2/F"</code>) 
+     *    creates the float branch (default is double)
      *  @param tree     input tree 
      *  @param name     the name for new branch 
      *  @param branches the map name->formula use to calculate newbranch
@@ -83,6 +87,11 @@ namespace Ostap
     // ========================================================================
     /** add new branches to the tree
      *  the value of the branch each  is taken from <code>branches</code>
+     *  - the entry is read once (only the needed branches are read,
+     *    if all functions are based on <code>TTreeFormula</code>)
+     *  - all functions are evaluated and all branches are filled together
+     *  - the name with suffix <code>"/F"</code> (e.g. <code>"pt2/F"</code>) 
+     *    creates the float branch (default is double)
      *  @param tree     input tree 
      *  @param name     the name for new branch 
      *  @param branches the map name->function use to calculate new branch
@@ -288,6 +297,45 @@ namespace Ostap
       const std::string&   vname       ,  
       const int            value       ) ;
     // ========================================================================
+    /** add new branches to the tree using several threads 
+     *  - worker threads evaluate the formulas for the chunks 
+     *    of entries (aligned with the tree clusters) into the column buffers, 
+     *    using the independent copies of the tree 
+     *  - the calling thread fills the branches in order 
+     *  - the number of chunks in flight is limited, 
+     *    the memory usage is bounded 
+     *  - the basket size for new branches is tuned to the cluster size
+     *  It falls back to the sequential processing 
+     *  if the tree is not read from files or one thread is requested 
+     *  @param tree     input tree 
+     *  @param branches the map name->formula use to calculate new branch
+     *  @param nthreads number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @return status code 
+     *  @see Ostap::Trees::add_branch 
+     *  @date 2023-01-29
+     */
+    Ostap::StatusCode 
+    add_branchMT
+    ( TTree*                                   tree         ,  
+      const std::map<std::string,std::string>& branches     , 
+      const unsigned int                       nthreads = 0 ) ;
+    // ========================================================================
+    /** add new branch with name <code>name</code> to the tree using several threads 
+     *  @param tree     input tree 
+     *  @param name     the name for new branch 
+     *  @param formula  the fomula use to calculate new  branch
+     *  @param nthreads number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @return status code 
+     *  @see Ostap::Trees::add_branchMT
+     *  @date 2023-01-29
+     */
+    Ostap::StatusCode 
+    add_branchMT
+    ( TTree*                                   tree         ,  
+      const std::string&                       name         , 
+      const std::string&                       formula      , 
+      const unsigned int                       nthreads = 0 ) ;
+    // ========================================================================
   } //                                        The end of namespace Ostap::Trees 
   // ==========================================================================
 } //                                                 The end of namesapce Ostap 
@@ -0,0 +1,129 @@
+// ============================================================================
+#ifndef OSTAP_AFFINITY_H
+#define OSTAP_AFFINITY_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstddef>
+#include <vector>
+// ============================================================================
+/** @file Ostap/Affinity.h
+ *  NUMA-aware placement of the worker threads for the in-process
+ *  parallel engines (StatVar, HistoProject, add_branch, parallel NLL, ...)
+ *  @see Ostap::Utils::Affinity
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class Affinity Ostap/Affinity.h
+     *  NUMA-aware placement of the worker threads
+     *  - the NUMA nodes (sockets) and their CPUs are taken from
+     *    <code>/sys/devices/system/node</code>, restricted to the CPUs
+     *    allowed for the process; elsewhere all CPUs form one node
+     *  - with the policy <code>Compact</code> the threads fill
+     *    the first node, then the next one, etc.;
+     *    with the policy <code>Scatter</code> the threads are
+     *    distributed over the nodes in round-robin
+     *  - the worker thread is pinned to all CPUs of its node
+     *    <em>before</em> it creates its tree copy, buffers and clones,
+     *    therefore the (default) first-touch policy of the kernel
+     *    places them into the local memory of the node
+     *  - the chunks of the work are partitioned per node, proportionally
+     *    to the number of threads at the node, see Affinity::blocks;
+     *    the idle threads steal the chunks from other nodes
+     *  - with <code>premerge</code> the partial results are merged
+     *    per node in parallel, and then the per-node results
+     *    are merged in the calling thread, see Ostap::Utils::premerge
+     *  The placement is disabled by default (policy <code>None</code>)
+     *  @code
+     *  Affinity::setPolicy   ( Affinity::Compact ) ;
+     *  Affinity::setPremerge ( true ) ;
+     *  @endcode
+     *  @see ostap/core/config.py
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2026-10-15
+     */
+    class Affinity
+    {
+    public:
+      // ======================================================================
+      /// placement policy
+      enum Policy
+        {
+          None    = 0 , // no placement
+          Compact = 1 , // fill the nodes one by one
+          Scatter = 2   // round-robin over the nodes
+        } ;
+      // ======================================================================
+    public: // configuration
+      // ======================================================================
+      /// the current placement policy
+      static Policy policy      () ;
+      /** set the placement policy
+       *  @return the previous policy
+       */
+      static Policy setPolicy   ( const Policy value ) ;
+      /// is the placement enabled?
+      static bool   enabled     () { return None != policy () ; }
+      /// merge the partial results per node?
+      static bool   premerge    () ;
+      /** merge the partial results per node?
+       *  @return the previous value
+       */
+      static bool   setPremerge ( const bool   value ) ;
+      // ======================================================================
+    public: // topology
+      // ======================================================================
+      /// number of NUMA nodes (at least one)
+      static unsigned int                     nNodes () ;
+      /// the (allowed) CPUs of the node
+      static const std::vector<unsigned int>& cpus   ( const unsigned int node ) ;
+      // ======================================================================
+    public: // placement
+      // ======================================================================
+      /** the node for the thread according to the current policy
+       *  @param ithread  the index of the thread
+       *  @param nthreads the total number of threads
+       *  @return the node (0 if the placement is disabled)
+       */
+      static unsigned int node
+      ( const unsigned int ithread  ,
+        const unsigned int nthreads ) ;
+      // ======================================================================
+      /** pin the current thread to the CPUs of the node
+       *  @return true if the thread is pinned
+       *  (false if the placement is disabled or not supported)
+       */
+      static bool pin ( const unsigned int node ) ;
+      // ======================================================================
+      /** partition the items <code>[0,nitems)</code> into contiguous
+       *  blocks, one per node, proportionally to the number of threads
+       *  at the node; the block for the node <code>k</code> is
+       *  <code>[result[k],result[k+1])</code>
+       *  @param nitems   the number of items (chunks)
+       *  @param nthreads the total number of threads
+       *  @return the boundaries of blocks
+       *  (one block <code>[0,nitems)</code> if the placement is disabled)
+       */
+      static std::vector<std::size_t> blocks
+      ( const std::size_t  nitems   ,
+        const unsigned int nthreads ) ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_AFFINITY_H
+// ============================================================================
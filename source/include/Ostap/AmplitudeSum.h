@@ -0,0 +1,233 @@
+// ============================================================================
+#ifndef OSTAP_AMPLITUDESUM_H
+#define OSTAP_AMPLITUDESUM_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <complex>
+#include <memory>
+#include <vector>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/BreitWigner.h"
+// ============================================================================
+/** @file Ostap/AmplitudeSum.h
+ *  Coherent sum of the resonance amplitudes with per-event caching
+ *  @see Ostap::Math::AmplitudeSum
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class AmplitudeSum Ostap/AmplitudeSum.h
+     *  Coherent sum of the resonance amplitudes
+     *  \f$ I(e) = \left| \sum_k c_k A_k(m_k(e)) F_k(e) \right|^2 \f$
+     *  for the fixed data sample and the fixed normalization
+     *  (MC/phase-space) sample, where
+     *   - \f$ A_k \f$ is the resonance amplitude (Ostap::Math::BW and derived)
+     *   - \f$ m_k(e) \f$ is the relevant mass for the resonance \f$k\f$ and event \f$e\f$
+     *   - \f$ F_k(e) \f$ is the (optional) complex angular/kinematic factor
+     *     (e.g. from Ostap::Math::Polarization or Ostap::Kinematics)
+     *   - \f$ c_k \f$ is the complex coupling
+     *
+     *  The per-event amplitudes are stored for each resonance as
+     *  contiguous arrays of real and imaginary parts.
+     *  They are recalculated only for the resonances, whose
+     *  parameters (mass, widths, ...) are changed,
+     *  as detected via <code>BW::tag()</code>.
+     *
+     *  The normalization integral is obtained from the interference matrix
+     *  \f$ M_{jk} = \left\langle A_j F_j \left(A_k F_k\right)^* \right\rangle \f$
+     *  over the normalization sample:
+     *  \f$ N = \sum_{jk} c_j c_k^* M_{jk} \f$,
+     *  therefore the change of the couplings costs no loop over
+     *  the normalization sample at all, and the change of the resonance
+     *  parameters requires only the recalculation of one row of the matrix.
+     *
+     *  @code
+     *  Ostap::Math::AmplitudeSum amp ( ndata , nnorm ) ;
+     *  const auto i1 = amp.add ( rho   , m12_data , m12_norm ) ;
+     *  const auto i2 = amp.add ( kstar , m23_data , m23_norm , std::complex<double> ( 0.5 , 0.1 ) ) ;
+     *  ...
+     *  amp.setCoupling ( i2 , std::complex<double> ( 0.4 , 0.2 ) ) ; // cheap
+     *  amp.resonance   ( i1 ).setM0 ( 0.772 ) ; // only one resonance is recomputed
+     *  const double nll = amp.nll () ;
+     *  @endcode
+     *  @attention the class is not thread-safe
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class AmplitudeSum
+    {
+    public:
+      // ======================================================================
+      typedef std::complex<double>              complex_type ;
+      typedef std::vector<double>               Values       ;
+      typedef std::vector<complex_type>         Factors      ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param ndata    size of the data sample
+       *  @param nnorm    size of the normalization sample
+       *  @param weights  (optional) weights for the normalization sample
+       */
+      AmplitudeSum
+      ( const std::size_t ndata        ,
+        const std::size_t nnorm        ,
+        const Values&     weights = {} ) ;
+      /// copy constructor
+      AmplitudeSum ( const AmplitudeSum&  right ) ;
+      /// move constructor
+      AmplitudeSum (       AmplitudeSum&& right ) = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** add the resonance
+       *  @param bw       the resonance amplitude
+       *  @param mdata    the masses for the data sample
+       *  @param mnorm    the masses for the normalization sample
+       *  @param coupling the complex coupling
+       *  @param fdata    (optional) the complex factors for the data sample
+       *  @param fnorm    (optional) the complex factors for the normalization sample
+       *  @return the index of the resonance
+       */
+      std::size_t add
+      ( const BW&          bw              ,
+        const Values&      mdata           ,
+        const Values&      mnorm           ,
+        const complex_type coupling  = 1   ,
+        const Factors&     fdata     = {}  ,
+        const Factors&     fnorm     = {}  ) ;
+      // ======================================================================
+      /// add the resonance (BW with phase space factors)
+      std::size_t add
+      ( const BWPS&        bw              ,
+        const Values&      mdata           ,
+        const Values&      mnorm           ,
+        const complex_type coupling  = 1   ,
+        const Factors&     fdata     = {}  ,
+        const Factors&     fnorm     = {}  )
+      { return add ( bw.breit_wigner () , mdata , mnorm , coupling , fdata , fnorm ) ; }
+      // ======================================================================
+      /// add the resonance (BW from three-body decays)
+      std::size_t add
+      ( const BW3L&        bw              ,
+        const Values&      mdata           ,
+        const Values&      mnorm           ,
+        const complex_type coupling  = 1   ,
+        const Factors&     fdata     = {}  ,
+        const Factors&     fnorm     = {}  )
+      { return add ( bw.breit_wigner () , mdata , mnorm , coupling , fdata , fnorm ) ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of resonances
+      std::size_t size  () const { return m_components.size () ; }
+      /// size of the data sample
+      std::size_t ndata () const { return m_ndata ; }
+      /// size of the normalization sample
+      std::size_t nnorm () const { return m_nnorm ; }
+      // ======================================================================
+      /// get the resonance (parameters can be modified)
+      BW&                resonance  ( const std::size_t i )       ;
+      /// get the resonance
+      const BW&          resonance  ( const std::size_t i ) const ;
+      /// get the coupling
+      const complex_type& coupling  ( const std::size_t i ) const ;
+      /// set the coupling
+      bool            setCoupling   ( const std::size_t i , const complex_type& c ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** refresh the cached amplitudes for the modified resonances
+       *  @return number of recalculated resonances
+       */
+      std::size_t update () const ;
+      // ======================================================================
+      /// the total amplitude for the data event
+      complex_type amplitude   ( const std::size_t event ) const ;
+      /// the intensity for the data event
+      double       intensity   ( const std::size_t event ) const
+      { return std::norm ( amplitude ( event ) ) ; }
+      /// the intensities for all data events
+      Values       intensities () const ;
+      /// the normalization integral (mean intensity over the normalization sample)
+      double       normalization () const ;
+      /** the fit fraction for the resonance
+       *  \f$ f_k = \left| c_k \right|^2 M_{kk} / N \f$
+       */
+      double       fraction    ( const std::size_t i ) const ;
+      /** the interference matrix element \f$ M_{jk} \f$
+       *  (without couplings)
+       */
+      complex_type interference ( const std::size_t j , const std::size_t k ) const ;
+      /** the negative log-likelihood for the data sample
+       *  \f$ -\sum_e \log \frac{I(e)}{N} \f$
+       */
+      double       nll         () const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /** @struct Component
+       *  The resonance with the cached amplitudes
+       */
+      struct Component
+      {
+        // ====================================================================
+        std::unique_ptr<BW> bw       {} ;
+        complex_type        coupling { 1 } ;
+        /// the masses & factors
+        Values              mdata    {} ;
+        Values              mnorm    {} ;
+        Factors             fdata    {} ;
+        Factors             fnorm    {} ;
+        /// the cached amplitudes (SoA)
+        mutable Values      dre      {} ;
+        mutable Values      dim      {} ;
+        mutable Values      nre      {} ;
+        mutable Values      nim      {} ;
+        /// the tag of the cached amplitudes
+        mutable std::size_t tag      { 0 } ;
+        mutable bool        valid    { false } ;
+        // ====================================================================
+      } ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// recalculate the amplitudes for the component
+      void calculate ( const Component& c ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// size of the data sample
+      std::size_t             m_ndata      { 0 } ;
+      /// size of the normalization sample
+      std::size_t             m_nnorm      { 0 } ;
+      /// weights of the normalization sample
+      Values                  m_weights    {} ;
+      /// sum of weights of the normalization sample
+      double                  m_sumw       { 0 } ;
+      /// the resonances
+      std::vector<Component>  m_components {} ;
+      /// the interference matrix (row-major)
+      mutable Factors         m_matrix     {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // OSTAP_AMPLITUDESUM_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,208 @@
+// ============================================================================
+#ifndef OSTAP_ARENA_H
+#define OSTAP_ARENA_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstddef>
+#include <memory>
+#include <vector>
+// ============================================================================
+/** @file Ostap/Arena.h
+ *  Per-thread monotonic (arena) allocator for the temporary scratch
+ *  memory in the hot loops
+ *
+ *  The memory is taken from the large blocks by bumping the pointer,
+ *  it is never released individually: the whole arena (or its part,
+ *  allocated after some mark) is rewound at once. The blocks are kept
+ *  for the next usage, therefore in the steady state the loop
+ *  does not touch the heap at all.
+ *
+ *  @code
+ *  void MyClass::evaluate ( ... ) const
+ *  {
+ *    Ostap::Utils::ArenaScope scope {} ;        // rewind at the end of scope
+ *    double* tmp = scope.allocate<double> ( N ) ;
+ *    ...
+ *  }
+ *  @endcode
+ *  The heap allocations of the arenas are counted by the instrumentation
+ *  probe <code>"Arena::heap"</code>, the arena allocations by the probe
+ *  <code>"Arena::allocate"</code>.
+ *  @see Ostap/Instrument.h
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class Arena Ostap/Arena.h
+     *  Simple monotonic allocator with the mark/rewind semantics
+     *  - not thread-safe: use one arena per thread
+     *  @see Ostap::Utils::Arena::local
+     *  @see Ostap::Utils::ArenaScope
+     */
+    class Arena
+    {
+    public:
+      // ======================================================================
+      /// the position in the arena
+      struct Mark
+      {
+        std::size_t block  { 0 } ;
+        std::size_t offset { 0 } ;
+      } ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// constructor with the (minimal) size of the block (bytes)
+      explicit Arena ( const std::size_t block = 64 * 1024 ) ;
+      // ======================================================================
+      Arena            ( const Arena& ) = delete ;
+      Arena& operator= ( const Arena& ) = delete ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the arena for the current thread
+      static Arena& local () ;
+      /// total number of heap allocations for all arenas
+      static unsigned long long total_heap_allocations () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// allocate the memory
+      void* allocate
+      ( const std::size_t bytes                              ,
+        const std::size_t align = alignof ( std::max_align_t ) ) ;
+      /// allocate the array of trivial objects (not initialized)
+      template <class T>
+      inline T* allocate_n ( const std::size_t n )
+      { return static_cast<T*> ( allocate ( n * sizeof ( T ) , alignof ( T ) ) ) ; }
+      // ======================================================================
+      /// current position
+      inline Mark mark () const { return Mark { m_current , m_offset } ; }
+      /** rewind to the position
+       *  - rewinding to the very beginning merges the blocks into one,
+       *    thus the next cycle needs no more heap allocations
+       */
+      void rewind ( const Mark& m ) ;
+      /// rewind to the very beginning
+      inline void reset () { rewind ( Mark () ) ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of blocks
+      std::size_t        blocks           () const { return m_blocks.size () ; }
+      /// total capacity (bytes)
+      std::size_t        capacity         () const ;
+      /// number of heap allocations for this arena
+      unsigned long long heap_allocations () const { return m_heap ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// allocate from the next (new or existing) block
+      void* allocate_slow ( const std::size_t bytes , const std::size_t align ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      struct Block
+      {
+        std::unique_ptr<char[]> data {}    ;
+        std::size_t             size { 0 } ;
+      } ;
+      // ======================================================================
+      /// the blocks
+      std::vector<Block> m_blocks  {}    ;
+      /// the current block
+      std::size_t        m_current { 0 } ;
+      /// the offset in the current block
+      std::size_t        m_offset  { 0 } ;
+      /// the minimal size of the block
+      std::size_t        m_block   { 0 } ;
+      /// number of heap allocations
+      unsigned long long m_heap    { 0 } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class ArenaScope Ostap/Arena.h
+     *  Rewind the arena at the end of the scope
+     */
+    class ArenaScope
+    {
+    public:
+      // ======================================================================
+      explicit ArenaScope ( Arena& arena = Arena::local () )
+        : m_arena ( arena          )
+        , m_mark  ( arena.mark  () )
+      {}
+      ~ArenaScope () { m_arena.rewind ( m_mark ) ; }
+      // ======================================================================
+      ArenaScope            ( const ArenaScope& ) = delete ;
+      ArenaScope& operator= ( const ArenaScope& ) = delete ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// allocate the array of trivial objects (not initialized)
+      template <class T>
+      inline T* allocate ( const std::size_t n )
+      { return m_arena.allocate_n<T> ( n ) ; }
+      /// the arena
+      Arena& arena () const { return m_arena ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      Arena&      m_arena ;
+      Arena::Mark m_mark  ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class ArenaAllocator Ostap/Arena.h
+     *  STL-compatible allocator on top of the arena:
+     *  deallocation is no-op, the memory is released by the rewind
+     *  @code
+     *  Ostap::Utils::ArenaScope scope {} ;
+     *  std::vector<double,Ostap::Utils::ArenaAllocator<double> > v
+     *     ( n , 0.0 , Ostap::Utils::ArenaAllocator<double> ( scope.arena () ) ) ;
+     *  @endcode
+     */
+    template <class T>
+    class ArenaAllocator
+    {
+    public:
+      // ======================================================================
+      typedef T value_type ;
+      // ======================================================================
+      ArenaAllocator ( Arena& arena = Arena::local () ) noexcept : m_arena ( &arena ) {}
+      template <class U>
+      ArenaAllocator ( const ArenaAllocator<U>& a ) noexcept : m_arena ( &a.arena () ) {}
+      // ======================================================================
+      T*   allocate   ( const std::size_t n ) { return m_arena->allocate_n<T> ( n ) ; }
+      void deallocate ( T* /* p */ , const std::size_t /* n */ ) noexcept {}
+      // ======================================================================
+      Arena& arena () const noexcept { return *m_arena ; }
+      // ======================================================================
+      template <class U>
+      bool operator== ( const ArenaAllocator<U>& a ) const noexcept { return m_arena == &a.arena () ; }
+      template <class U>
+      bool operator!= ( const ArenaAllocator<U>& a ) const noexcept { return m_arena != &a.arena () ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      Arena* m_arena ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // OSTAP_ARENA_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
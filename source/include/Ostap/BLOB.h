@@ -14,6 +14,11 @@ namespace Ostap
   // ==========================================================================
   /** @class  BLOB Blob.h Ostap/Blob.h
    *  Trivial ROOT-based class to store blobs in ROOT file
+   *
+   *  Optionally the content is compressed inside the blob 
+   *  by chunks (ROOT <code>R__zip</code>), using the ROOT compression 
+   *  setting <code>100*algorithm+level</code>, e.g. 404 for LZ4 and 505 for ZSTD
+   *  @see ROOT::RCompressionSetting 
    *  @author Vanya Belyaev
    *  @date   2019-03-27
    */
@@ -21,7 +26,7 @@ namespace Ostap
   {
   public:
     // ========================================================================
-    ClassDefOverride(Ostap::BLOB,1) ;
+    ClassDefOverride(Ostap::BLOB,2) ;
     // ========================================================================
   public: 
     // ========================================================================
@@ -35,21 +40,42 @@ namespace Ostap
     // ========================================================================
   public: // gettters 
     // ========================================================================
-    /// get the size of the buffer 
+    /// get the size of the (stored, possibly compressed) buffer 
     std::size_t size   () const { return m_data.GetSize  () ; }
-    /// ghet teh buffer itself 
+    /// get the (stored, possibly compressed) buffer itself 
     const void* buffer () const { return m_data.GetArray () ; }    
+    /// is the content compressed ?
+    bool        zipped () const { return 0 <= m_raw ; }
+    /// get the size of the uncompressed content 
+    std::size_t raw_size () const 
+    { return zipped () ? static_cast<std::size_t> ( m_raw ) : size () ; }
     // ========================================================================
   public: // setters 
     // ========================================================================
-    /// redefine the buffer 
-    void setBuffer ( const std::size_t size   , 
-                     const void*       buffer ) ;
+    /** redefine the buffer 
+     *  @param size     the size of the buffer 
+     *  @param buffer   the buffer 
+     *  @param compress ROOT compression setting, no compression for non-positive values.
+     *         If the data are not compressible, they are stored as is 
+     */
+    void setBuffer ( const std::size_t size         , 
+                     const void*       buffer       , 
+                     const int         compress = 0 ) ;
+    // ========================================================================
+    /** get the (uncompressed) content into the external buffer 
+     *  @param size   the size of the external buffer, must be equal to raw_size 
+     *  @param buffer the external buffer 
+     *  @return true if the content is extracted 
+     */
+    bool getBuffer ( const std::size_t size   , 
+                     void*             buffer ) const ;
     // ========================================================================
   private:
     // ========================================================================
     // the data itself  
-    TArrayC m_data {} ; /// the data buffer 
+    TArrayC  m_data {    } ; /// the data buffer 
+    /// size of the uncompressed data, negative value for uncompressed buffer 
+    Long64_t m_raw  { -1 } ; 
     // ========================================================================
   };
   // ==========================================================================
@@ -104,6 +104,31 @@ namespace Ostap
       /// get the value
       double operator () ( const double x ) const ;
       // ======================================================================
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
+      // ======================================================================
+      /** evaluate the function, its derivative and its integral from 
+       *  \f$ x_{min}\f$ for the array of points. 
+       *  The non-zero basic splines are calculated once per point 
+       *  and reused for all quantities 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of values 
+       *  @param deriv  (UPDATE) array of derivatives (can be nullptr)
+       *  @param integ  (UPDATE) array of integrals   (can be nullptr)
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result , 
+                           double*           deriv  , 
+                           double*           integ  ) const ;
+      // ======================================================================
     public:
       // ======================================================================
       /// get number of parameters
@@ -144,6 +169,16 @@ namespace Ostap
           index < (int) m_knots.size() ? m_knots[index]  : m_knots.back() ;
       }
       // ======================================================================
+      /** get the index of the knot interval \f$ t_j \le x < t_{j+1} \f$ 
+       *  for \f$ x_{min} \le x < x_{max} \f$ 
+       *  - the hint (e.g. the index for the previous point) is checked first, 
+       *    together with the next interval (sorted/streamed input) 
+       *  - otherwise the lookup table gives O(1) search for (nearly) uniform knots 
+       *  @param x    the point 
+       *  @param hint the guess for the index 
+       */
+      unsigned short span ( const double x , const unsigned short hint = 0 ) const ;
+      // ======================================================================
     public:
       // ======================================================================
       /// Greville's abscissa
@@ -208,6 +243,30 @@ namespace Ostap
       double bspline ( const          short i ,
                        const unsigned short k , const double x )  const ;
       // ======================================================================
+      /** get the values of all non-zero B-splines at point x: 
+       *  \f$ B_{j-k}(x), \ldots , B_j(x) \f$, where \f$ j \f$ is the span 
+       *  and \f$ k \f$ is the order of the spline 
+       *  @param x      (INPUT)  the point, it is adjusted to \f$ [x_{min},x_{max}]\f$ 
+       *  @param values (OUTPUT) array of (at least order+1) values 
+       *  @param hint   (INPUT)  the guess for the span 
+       *  @return the span \f$ j\f$ 
+       */
+      unsigned short bsplines 
+      ( const double         x        , 
+        double*              values   , 
+        const unsigned short hint = 0 ) const ;
+      // ======================================================================
+      /** get the integrals of all B-splines 
+       *  \f$ \int_{low}^{high} B_i(x) dx \f$ 
+       *  @param low    (INPUT)  low  integration edge
+       *  @param high   (INPUT)  high integration edge 
+       *  @param values (OUTPUT) vector of integrals 
+       */
+      void bspline_integrals 
+      ( const double         low    , 
+        const double         high   , 
+        std::vector<double>& values ) const ;
+      // ======================================================================
     public: // M-splines
       // ======================================================================
       /// get the value of the M-spline  i at point x
@@ -295,6 +354,13 @@ namespace Ostap
       mutable  std::vector<double>  m_pars_i  ;     // for integration
       /// extended list of knots for integration
       std::vector<double>  m_knots_i ;              // the list of knots
+      /// lookup table for the fast search of the knot interval 
+      std::vector<unsigned short> m_table ;         // lookup table 
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// (re)build the lookup table for the knot intervals  
+      void updateTable () ;
       // ======================================================================
     };
     // ========================================================================
@@ -763,6 +829,16 @@ namespace Ostap
       { return evaluate  ( x , y ) ; }      
       /// get the value  
       double evaluate    ( const double x , const double y ) const ;
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -911,6 +987,11 @@ namespace Ostap
       // make the calcualtions 
       double calculate ( const std::vector<double>& fx , 
                          const std::vector<double>& fy ) const ;
+      /// get the value using and updating the span hints 
+      double evaluate  ( const double    x  , 
+                         const double    y  , 
+                         unsigned short& hx , 
+                         unsigned short& hy ) const ;
       // ======================================================================
     private:
       // ======================================================================
@@ -1147,6 +1228,17 @@ namespace Ostap
       { return evaluate ( x , y ) ; }
       double evaluate   ( const double x , const double y ) const 
       { return m_spline ( x , y ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          const double*     y      , 
+                          double*           result ) const 
+      { m_spline.evaluate ( n , x , y , result ) ; }
       // ======================================================================
     public:
       // ======================================================================
@@ -0,0 +1,156 @@
+// ============================================================================
+#ifndef OSTAP_BATCHCOMPUTE_H
+#define OSTAP_BATCHCOMPUTE_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstddef>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "RVersion.h"
+// ============================================================================
+/** @file Ostap/BatchCompute.h
+ *  The version-independent batch evaluation of RooFit functions and PDFs.
+ *
+ *  The batch interface of <code>RooAbsReal</code> is different
+ *  for different versions of ROOT:
+ *  - ROOT 6.20-6.23 : <code>evaluateBatch ( begin , size )</code>
+ *  - ROOT 6.24-6.27 : <code>evaluateSpan  ( RunContext& , normSet )</code>
+ *  - ROOT 6.28-6.29 : <code>computeBatch  ( stream , output , size , DataMap )</code>
+ *  - ROOT 6.30-6.31 : <code>computeBatch  ( output , size , DataMap )</code>
+ *  - ROOT 6.32-     : <code>doEval        ( EvalContext& )</code>
+ *
+ *  The class declares the batch evaluation with
+ *  <code>OSTAP_BATCH_DECLARE</code> and implements the single
+ *  version-independent method
+ *  @code
+ *  void computeBatch_ ( Ostap::Utils::BatchData& data    ,
+ *                       double*                  output  ,
+ *                       const std::size_t        nEvents ) const ;
+ *  @endcode
+ *  The version-specific override, forwarding to <code>computeBatch_</code>,
+ *  is generated by <code>OSTAP_BATCH_IMPLEMENT(CLASS,BASE)</code>
+ *  (see local_batch.h).
+ *  If the batch evaluation is not possible for the given call,
+ *  the class declares it with <code>OSTAP_BATCH_DECLARE_FALLBACK</code>,
+ *  <code>computeBatch_</code> returns <code>false</code> and
+ *  the batch evaluation of the base class is used.
+ *
+ *  For ROOT versions before 6.20 (no batch interface)
+ *  <code>OSTAP_BATCH</code> is zero and the macros are empty:
+ *  the scalar <code>evaluate</code> is used
+ *
+ *  @see Ostap::Utils::BatchCompute
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2026-10-15
+ */
+// ============================================================================
+#if   ROOT_VERSION(6,32,0) <= ROOT_VERSION_CODE
+// ============================================================================
+#define OSTAP_BATCH 1
+namespace RooFit { class EvalContext ; }
+#define OSTAP_BATCH_OVERRIDE_                                                 \
+  void doEval ( RooFit::EvalContext& ctx ) const override ;
+// ============================================================================
+#elif ROOT_VERSION(6,30,0) <= ROOT_VERSION_CODE
+// ============================================================================
+#define OSTAP_BATCH 1
+namespace RooFit { namespace Detail { class DataMap ; } }
+#define OSTAP_BATCH_OVERRIDE_                                                 \
+  void computeBatch ( double*                        output  ,                \
+                      std::size_t                    nEvents ,                \
+                      RooFit::Detail::DataMap const& data    ) const override ;
+// ============================================================================
+#elif ROOT_VERSION(6,28,0) <= ROOT_VERSION_CODE
+// ============================================================================
+#define OSTAP_BATCH 1
+namespace RooFit { namespace Detail { class DataMap ; } }
+#define OSTAP_BATCH_OVERRIDE_                                                 \
+  void computeBatch ( cudaStream_t*                  stream  ,                \
+                      double*                        output  ,                \
+                      std::size_t                    nEvents ,                \
+                      RooFit::Detail::DataMap const& data    ) const override ;
+// ============================================================================
+#elif ROOT_VERSION(6,24,0) <= ROOT_VERSION_CODE
+// ============================================================================
+#define OSTAP_BATCH 1
+#define OSTAP_BATCH_OVERRIDE_                                                 \
+  RooSpan<double> evaluateSpan ( RooBatchCompute::RunContext& ctx     ,       \
+                                 const RooArgSet*             normSet ) const override ;
+// ============================================================================
+#elif ROOT_VERSION(6,20,0) <= ROOT_VERSION_CODE
+// ============================================================================
+#define OSTAP_BATCH 1
+#define OSTAP_BATCH_OVERRIDE_                                                 \
+  RooSpan<double> evaluateBatch ( std::size_t begin ,                         \
+                                  std::size_t size  ) const override ;
+// ============================================================================
+#else
+// ============================================================================
+#define OSTAP_BATCH 0
+// ============================================================================
+#endif
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /// the input data for the batch evaluation (see local_batch.h)
+    class BatchData ;
+    // ========================================================================
+    /** @class BatchCompute Ostap/BatchCompute.h
+     *  Monitoring of the batch evaluation of Ostap functions and PDFs
+     *  @see Ostap/BatchCompute.h
+     */
+    class BatchCompute
+    {
+    public:
+      // ======================================================================
+      /// is the batch evaluation supported for this version of ROOT?
+      static bool               supported () { return OSTAP_BATCH ; }
+      /// number of batch evaluations
+      static unsigned long long calls     () ;
+      /// number of evaluated entries
+      static unsigned long long entries   () ;
+      /// reset the counters
+      static void               reset     () ;
+      /// register the batch evaluation (for internal usage)
+      static void               add       ( const std::size_t nEvents ) ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+/// declare the batch evaluation
+#define OSTAP_BATCH_DECLARE                                                   \
+  OSTAP_BATCH_OVERRIDE_                                                       \
+  void computeBatch_ ( Ostap::Utils::BatchData& data    ,                     \
+                       double*                  output  ,                     \
+                       const std::size_t        nEvents ) const ;
+/// declare the batch evaluation with the fallback to the base class
+#define OSTAP_BATCH_DECLARE_FALLBACK                                          \
+  OSTAP_BATCH_OVERRIDE_                                                       \
+  bool computeBatch_ ( Ostap::Utils::BatchData& data    ,                     \
+                       double*                  output  ,                     \
+                       const std::size_t        nEvents ) const ;
+// ============================================================================
+#else
+// ============================================================================
+#define OSTAP_BATCH_DECLARE
+#define OSTAP_BATCH_DECLARE_FALLBACK
+// ============================================================================
+#endif
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_BATCHCOMPUTE_H
+// ============================================================================
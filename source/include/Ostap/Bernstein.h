@@ -286,6 +286,14 @@ namespace Ostap
       /// get the value
       double operator () ( const double x ) const
       { return x < m_xmin ? 0 : x > m_xmax ? 0 : evaluate ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -677,6 +685,99 @@ namespace Ostap
     ( const std::vector<double>& pars ,
       const double               x    ) ;
     // ========================================================================
+    namespace detail 
+    {
+      // ======================================================================
+      /// one (unrolled) step of de Casteljau algorithm: b[i] = t1*b[i]+t0*b[i+1], I<=i<K
+      template <unsigned short I, unsigned short K>
+      struct casteljau_step_
+      {
+        static inline void run
+        ( long double*      b  ,
+          const long double t0 ,
+          const long double t1 ) 
+        {
+          b [ I ] = t1 * b [ I ] + t0 * b [ I + 1 ] ;
+          casteljau_step_<I+1,K>::run ( b , t0 , t1 ) ;
+        }
+      } ;
+      /// end of the step 
+      template <unsigned short K>
+      struct casteljau_step_<K,K>
+      {
+        static inline void run
+        ( long double*      /* b  */ ,
+          const long double /* t0 */ ,
+          const long double /* t1 */ ) {}
+      } ;
+      // ======================================================================
+      /// (unrolled) de Casteljau algorithm for K+1 coefficients 
+      template <unsigned short K>
+      struct casteljau_
+      {
+        static inline long double run
+        ( long double*      b  ,
+          const long double t0 ,
+          const long double t1 ) 
+        {
+          casteljau_step_<0,K>::run ( b , t0 , t1 ) ;
+          return casteljau_<K-1>::run ( b , t0 , t1 ) ;
+        }
+      } ;
+      /// end of recursion 
+      template <>
+      struct casteljau_<0>
+      {
+        static inline long double run
+        ( long double*      b             ,
+          const long double /* t0 */      ,
+          const long double /* t1 */      ) { return b [ 0 ] ; }
+      } ;
+      // ======================================================================
+    } //                                    The end of namespace Ostap::Math::detail
+    // ========================================================================
+    template <unsigned short N> class Bernstein_ ;
+    // ========================================================================
+    /** @class Bernstein_
+     *  Efficient evaluator of the sum of Bernstein polynomials 
+     *  of the fixed degree <code>N</code>
+     *  \f$ f(t) = \sum_{k=0}^{N} p_k B^N_k(t) \f$, \f$ 0 \le t \le 1 \f$ 
+     *  via the fully unrolled de Casteljau algorithm 
+     *  @code
+     *  const double pars [] = { 1 , 2 , 0.5 , 3 } ;
+     *  const double value   = Bernstein_<3>::evaluate ( pars , 0.3 ) ;
+     *  @endcode
+     *  @see Ostap::Math::Bernstein
+     *  @see Ostap::Math::Chebyshev_
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    template <unsigned short N>
+    class Bernstein_
+    {
+    public:
+      // ======================================================================
+      /** evaluate the sum of Bernstein polynomials 
+       *  @param pars (INPUT) N+1 coefficients 
+       *  @param t0   (INPUT) the point \f$ t\f$ 
+       *  @param t1   (INPUT) \f$ 1 - t \f$ 
+       */
+      static inline double evaluate 
+      ( const double*     pars ,
+        const long double t0   ,
+        const long double t1   ) 
+      {
+        long double b [ N + 1 ] ;
+        std::copy ( pars , pars + N + 1 , b ) ;
+        return detail::casteljau_<N>::run ( b , t0 , t1 ) ;
+      }
+      /// evaluate the sum of Bernstein polynomials 
+      static inline double evaluate 
+      ( const double*     pars ,
+        const long double t    ) { return evaluate ( pars , t , 1 - t ) ; }
+      // ======================================================================
+    } ;
+    // ========================================================================
     /** Dual basic Bernstein function
      *  The dual basic functions \f$ d^n_j(x)\f$ are defined as
      *   \f$  \int_{x_{min}}^{x_{max}}   b^n_k(x) d^n_j(x) = \delta_{kj}\f$,
@@ -357,6 +357,14 @@ namespace Ostap
       // ======================================================================
       /// get the value
       double operator () ( const double x ) const { return m_bernstein ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // PAR-interface 
       // ======================================================================
@@ -385,10 +393,11 @@ namespace Ostap
       {
         const unsigned short nA = m_sphereA.npars () ;
         const unsigned short nR = m_sphereR.npars () ;
-        const bool update = 
-          k < nA      ? m_sphereA.setPhase ( k      , value ) :
-          k < nA + nR ? m_sphereR.setPhase ( k - nA , value ) : false ;
-        return update ? updateBernstein () : false ;
+        if      ( k < nA      ) 
+        { return m_sphereA.setPhase ( k      , value ) ? updateBernstein ( false ) : false ; }
+        else if ( k < nA + nR ) 
+        { return m_sphereR.setPhase ( k - nA , value ) ? updateBernstein ( true  ) : false ; }
+        return false ;
       }
       // ======================================================================
       /// set k-parameter
@@ -411,7 +420,7 @@ namespace Ostap
         const unsigned short nA = m_sphereA.npars () ;
         const bool updatedA =           m_sphereA.setPars ( begin      , end ) ;
         const bool updatedR = nA < NN ? m_sphereR.setPars ( begin + nA , end ) : false ;
-        return updatedA || updatedR ? updateBernstein ( ) : false ;
+        return updatedA || updatedR ? updateBernstein ( updatedR ) : false ;
       }
       // ======================================================================
       /** set several/all parameters at once 
@@ -519,8 +528,11 @@ namespace Ostap
       // ======================================================================
     private : 
       // ======================================================================
-      /// update bernstein coefficients
-      bool updateBernstein () ;
+      /** update bernstein coefficients
+       *  @param roots (INPUT) recalculate the products over roots?
+       *  (not needed if only alpha/beta sphere is changed)
+       */
+      bool updateBernstein ( const bool roots = true ) ;
       // ======================================================================
     protected:
       // ======================================================================
@@ -75,6 +75,16 @@ namespace Ostap
       /// get the value
       double operator () ( const double x , const double y ) const 
       { return evaluate ( x , y ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           double*           result ) const ;
       // ======================================================================
     public: // setters
       // ======================================================================
@@ -270,8 +280,8 @@ namespace Ostap
     private: // helper functions to make the calculations
       // ======================================================================
       /// helper function to make calculations
-      double calculate ( const std::vector<double>& fx , 
-                         const std::vector<double>& fy ) const ;
+      double calculate ( const double* fx , 
+                         const double* fy ) const ;
       // ======================================================================
     private:
       // ======================================================================
@@ -362,6 +372,17 @@ namespace Ostap
       /// get the value
       double operator () ( const double x , const double y ) const
       { return evaluate    ( x , y ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           double*           result ) const 
+      { m_bernstein.evaluate ( n , x , y , result ) ; }
       // ======================================================================
     public:
       // ======================================================================
@@ -474,8 +495,11 @@ namespace Ostap
       // ======================================================================
     private:
       // ======================================================================
-      /// update bernstein coefficients
-      bool updateBernstein () ;
+      /** update bernstein coefficients
+       *  @param first (INPUT) the first coefficient to be updated: 
+       *  the phase k affects only the coefficients with index >= k 
+       */
+      bool updateBernstein ( const unsigned int first = 0 ) ;
       // ======================================================================
     private:
       // ======================================================================
@@ -537,6 +561,16 @@ namespace Ostap
       /// get the value
       double operator () ( const double x , const double y ) const 
       { return evaluate ( x , y ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -728,8 +762,8 @@ namespace Ostap
     private: // helper functions to make the calculations
       // ======================================================================
       /// helper function to make calculations
-      double calculate ( const std::vector<double>& fx , 
-                         const std::vector<double>& fy ) const ;
+      double calculate ( const double* fx , 
+                         const double* fy ) const ;
       // ======================================================================
    private:
       // ======================================================================
@@ -809,6 +843,17 @@ namespace Ostap
       /// get the value
       double operator () ( const double x , const double y ) const 
       { return evaluate ( x , y ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           double*           result ) const 
+      { m_bernstein.evaluate ( n , x , y , result ) ; }
       // ======================================================================
     public:
       // ======================================================================
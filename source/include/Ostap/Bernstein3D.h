@@ -81,6 +81,18 @@ namespace Ostap
                            const double y , 
                            const double z ) const 
       { return evaluate ( x ,   y , z ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param z      (INPUT)  array of z-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           const double*     z      , 
+                           double*           result ) const ;
       // ======================================================================
     public: // setters
       // ======================================================================
@@ -383,9 +395,9 @@ namespace Ostap
     private: // helper functions to make calculations
       // ======================================================================
       /// helper function to make calculations
-      double calculate ( const std::vector<double>& fx , 
-                         const std::vector<double>& fy , 
-                         const std::vector<double>& fz ) const ;
+      double calculate ( const double* fx , 
+                         const double* fy , 
+                         const double* fz ) const ;
       // ======================================================================
     private:
       // ======================================================================
@@ -474,6 +486,18 @@ namespace Ostap
                            const double y , 
                            const double z ) const 
       { return evaluate ( x ,   y , z ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param z      (INPUT)  array of z-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           const double*     z      , 
+                           double*           result ) const ;
       // ======================================================================
     public: // setters
       // ======================================================================
@@ -781,9 +805,9 @@ namespace Ostap
     private: // helper functions to make calculations
       // ======================================================================
       /// helper function to make calculations
-      double calculate ( const std::vector<double>& fx , 
-                         const std::vector<double>& fy , 
-                         const std::vector<double>& fz ) const ;
+      double calculate ( const double* fx , 
+                         const double* fy , 
+                         const double* fz ) const ;
       // ======================================================================
     private:
       // ======================================================================
@@ -863,6 +887,18 @@ namespace Ostap
                            const double y , 
                            const double z ) const 
       { return evaluate ( x ,   y , z ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param z      (INPUT)  array of z-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           const double*     z      , 
+                           double*           result ) const ;
       // ======================================================================
     public: // setters
       // ======================================================================
@@ -1162,9 +1198,9 @@ namespace Ostap
     private: // helper functions to make calculations
       // ======================================================================
       /// helper function to make calculations
-      double calculate ( const std::vector<double>& fx , 
-                         const std::vector<double>& fy , 
-                         const std::vector<double>& fz ) const ;
+      double calculate ( const double* fx , 
+                         const double* fy , 
+                         const double* fz ) const ;
       // ======================================================================
     private:
       // ======================================================================
@@ -1254,6 +1290,19 @@ namespace Ostap
                            const double y , 
                            const double z ) const
       { return evaluate  ( x , y , z ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param z      (INPUT)  array of z-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           const double*     z      , 
+                           double*           result ) const 
+      { m_bernstein.evaluate ( n , x , y , z , result ) ; }
       // ======================================================================
     public:
       // ======================================================================
@@ -1520,6 +1569,19 @@ namespace Ostap
                            const double y , 
                            const double z ) const
       { return evaluate  ( x , y , z ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param z      (INPUT)  array of z-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           const double*     z      , 
+                           double*           result ) const 
+      { m_bernstein.evaluate ( n , x , y , z , result ) ; }
       // ======================================================================
     public:
       // ======================================================================
@@ -1790,6 +1852,19 @@ namespace Ostap
                            const double y , 
                            const double z ) const
       { return evaluate  ( x , y , z ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param z      (INPUT)  array of z-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           const double*     z      , 
+                           double*           result ) const 
+      { m_bernstein.evaluate ( n , x , y , z , result ) ; }
       // ======================================================================
     public:
       // ======================================================================
@@ -0,0 +1,177 @@
+// ============================================================================
+#ifndef OSTAP_BINREPLICAS_H
+#define OSTAP_BINREPLICAS_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <memory>
+#include <vector>
+#include <cstdint>
+// ============================================================================
+// Forward declarations
+// =============================================================================
+class TH1        ; // ROOT
+// =============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  /** @class BinReplicas Ostap/BinReplicas.h
+   *  The Poisson-bootstrap replicas of the histogram, filled in a single pass:
+   *  each entry gets N independent Poisson(1) weights and it is added
+   *  to all N replicas at once. The replicas are kept in the compact
+   *  array with the replica axis running fastest, indexed by
+   *  the global bin number of the model 1D, 2D or 3D histogram.
+   *
+   *  The Poisson weights are taken from the counter-based generator
+   *  (Philox4x32-10), keyed by the seed and the entry number only:
+   *  the replicas are reproducible and do not depend on the order
+   *  of processing or on the number of threads
+   *
+   *  @code
+   *  TH1D model ( "m" , "" , 20 , 0 , 10 ) ;
+   *  Ostap::BinReplicas replicas ( model , 200 , 12345 ) ;
+   *  Ostap::HistoProject::replicas ( tree , replicas , { "pt" } , "w" , 0 ) ;
+   *  TH1D h ( "h" , "" , 20 , 0 , 10 ) ;
+   *  replicas.bootstrap ( &h ) ;            // bootstrap uncertainties
+   *  const double c = replicas.covariance ( 3 , 4 ) ;
+   *  @endcode
+   *  @see Ostap::Math::Philox
+   *  @see Ostap::HistoProject::replicas
+   *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+   *  @date   2026-10-15
+   */
+  class BinReplicas
+  {
+  public:
+    // ========================================================================
+    /// the Poisson weights of the entry for all replicas
+    typedef std::vector<unsigned short> Weights ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    /** constructor from the model histogram
+     *  @param model     (INPUT) the model histogram (only binning is used)
+     *  @param nReplicas (INPUT) number of replicas
+     *  @param seed      (INPUT) the seed for the Poisson weights
+     */
+    BinReplicas
+    ( const TH1&           model           ,
+      const unsigned short nReplicas = 100 ,
+      const std::uint64_t  seed      = 0   ) ;
+    /// copy constructor
+    BinReplicas ( const BinReplicas&  right ) ;
+    /// move constructor
+    BinReplicas (       BinReplicas&& right ) = default ;
+    /// default constructor
+    BinReplicas () = default ;
+    /// destructor
+    ~BinReplicas () ;
+    /// copy assignment
+    BinReplicas& operator= ( const BinReplicas&  right ) ;
+    /// move assignment
+    BinReplicas& operator= (       BinReplicas&& right ) = default ;
+    // ========================================================================
+  public: // accessors
+    // ========================================================================
+    /// dimension of the model histogram
+    unsigned short dim       () const { return m_dim       ; }
+    /// number of cells (including underflow and overflow bins)
+    std::size_t    size      () const { return m_nominal.size () ; }
+    /// number of replicas
+    unsigned short nReplicas () const { return m_N         ; }
+    /// the seed
+    std::uint64_t  seed      () const { return m_seed      ; }
+    /// the model histogram
+    const TH1*     model     () const { return m_model.get () ; }
+    // ========================================================================
+    /// get the global bin (1D)
+    int bin ( const double x ) const ;
+    /// get the global bin (2D)
+    int bin ( const double x , const double y ) const ;
+    /// get the global bin (3D)
+    int bin ( const double x , const double y , const double z ) const ;
+    // ========================================================================
+  public: // filling
+    // ========================================================================
+    /** get the Poisson(1) weights of the entry for all replicas
+     *  - the weights depend only on the seed and the entry number
+     */
+    void poisson ( const std::uint64_t entry , Weights& weights ) const ;
+    // ========================================================================
+    /// add the weight to the global bin, the Poisson weights are precomputed
+    void add
+    ( const int      bin     ,
+      const double   weight  ,
+      const Weights& weights ) ;
+    /// add the weight of the entry to the global bin
+    void fill
+    ( const int           bin        ,
+      const std::uint64_t entry      ,
+      const double        weight = 1 ) ;
+    // ========================================================================
+    /** merge with another replicas, the binning, the number of replicas
+     *  and the seed must be the same
+     */
+    BinReplicas& add        ( const BinReplicas& right ) ;
+    /// merge with another replicas
+    BinReplicas& operator+= ( const BinReplicas& right ) { return add ( right ) ; }
+    /// reset all counters
+    void reset () ;
+    // ========================================================================
+  public: // results
+    // ========================================================================
+    /// the nominal sum of weights in the global bin
+    double nominal    ( const int bin ) const { return m_nominal [ bin ] ; }
+    /// the content of the replica in the global bin
+    double value      ( const int bin , const unsigned short replica ) const
+    { return m_sumw [ bin * std::size_t ( m_N ) + replica ] ; }
+    /// the mean over replicas in the global bin
+    double mean       ( const int bin ) const ;
+    /// the bootstrap uncertainty (r.m.s. over replicas) in the global bin
+    double error      ( const int bin ) const ;
+    /// the bootstrap covariance of two global bins
+    double covariance ( const int bin1 , const int bin2 ) const ;
+    /// the bootstrap correlation of two global bins
+    double correlation( const int bin1 , const int bin2 ) const ;
+    // ========================================================================
+  public: // conversion to histograms
+    // ========================================================================
+    /// fill the histogram with the replica
+    void replica   ( const unsigned short replica , TH1* h ) const ;
+    /// fill the histogram with the nominal contents and bootstrap uncertainties
+    void bootstrap ( TH1* h ) const ;
+    /// fill the histogram with the nominal sums of weights and their uncertainties
+    void sumw      ( TH1* h ) const ;
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// check the compatibility of the histogram
+    void check ( const TH1* h ) const ;
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the dimension
+    unsigned short       m_dim      { 0 } ;
+    /// number of replicas
+    unsigned short       m_N        { 0 } ;
+    /// the seed
+    std::uint64_t        m_seed     { 0 } ;
+    /// the model histogram (binning only)
+    std::unique_ptr<TH1> m_model    {}    ; //! the model
+    /// the replicas: [ bin * N + replica ]
+    std::vector<double>  m_sumw     {}    ;
+    /// the nominal sums of weights
+    std::vector<double>  m_nominal  {}    ;
+    /// the nominal sums of squared weights
+    std::vector<double>  m_nominal2 {}    ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+} //                                                     end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_BINREPLICAS_H
+// ============================================================================
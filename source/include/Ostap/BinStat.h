@@ -0,0 +1,172 @@
+// ============================================================================
+#ifndef OSTAP_BINSTAT_H
+#define OSTAP_BINSTAT_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <memory>
+#include <vector>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/WStatEntity.h"
+// ============================================================================
+// Forward declarations
+// =============================================================================
+class TH1        ; // ROOT
+class TProfile   ; // ROOT
+class TProfile2D ; // ROOT
+class TProfile3D ; // ROOT
+// =============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  /** @class BinStat Ostap/BinStat.h
+   *  The full statistics of the value in bins of the model histogram:
+   *  the array of Ostap::WStatEntity counters, indexed by the global
+   *  bin number of the model 1D, 2D or 3D histogram
+   *
+   *  Unlike <code>TProfile</code> it keeps min/max values, the number
+   *  of entries and the effective number of entries for each bin,
+   *  and the statistics are accumulated with numerically stable updates
+   *
+   *  @code
+   *  TH1D model ( "m" , "" , 20 , 0 , 10 ) ;
+   *  Ostap::BinStat stat ( model ) ;
+   *  Ostap::HistoProject::profile ( tree , stat , { "pt" } , "mass" , "w" ) ;
+   *  TProfile p ( "p" , "" , 20 , 0 , 10 ) ;
+   *  stat.profile ( &p ) ;
+   *  @endcode
+   *  @see Ostap::WStatEntity
+   *  @see Ostap::HistoProject::profile
+   *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+   *  @date   2026-10-15
+   */
+  class BinStat
+  {
+  public:
+    // ========================================================================
+    /** constructor from the model histogram
+     *  @param model (INPUT) the model histogram (only binning is used)
+     */
+    BinStat ( const TH1& model ) ;
+    /// copy constructor
+    BinStat ( const BinStat&  right ) ;
+    /// move constructor
+    BinStat (       BinStat&& right ) = default ;
+    /// default constructor
+    BinStat () = default ;
+    /// destructor
+    ~BinStat () ;
+    /// copy assignment
+    BinStat& operator= ( const BinStat&  right ) ;
+    /// move assignment
+    BinStat& operator= (       BinStat&& right ) = default ;
+    // ========================================================================
+  public: // accessors
+    // ========================================================================
+    /// dimension of the model histogram
+    unsigned short dim   () const { return m_dim ; }
+    /// number of cells (including underflow and overflow bins)
+    std::size_t    size  () const { return m_stat.size () ; }
+    /// the model histogram
+    const TH1*     model () const { return m_model.get () ; }
+    /// the counter for the global bin
+    const Ostap::WStatEntity& stat       ( const int bin ) const { return m_stat.at ( bin ) ; }
+    /// the counter for the global bin
+    const Ostap::WStatEntity& operator[] ( const int bin ) const { return m_stat   [ bin ] ; }
+    /// all counters
+    const std::vector<Ostap::WStatEntity>& counters () const { return m_stat ; }
+    // ========================================================================
+    /// get the global bin (1D)
+    int bin ( const double x ) const ;
+    /// get the global bin (2D)
+    int bin ( const double x , const double y ) const ;
+    /// get the global bin (3D)
+    int bin ( const double x , const double y , const double z ) const ;
+    // ========================================================================
+  public: // filling
+    // ========================================================================
+    /// add the value with the weight to the global bin
+    inline void add
+    ( const int    bin        ,
+      const double value      ,
+      const double weight = 1 ) { m_stat [ bin ].add ( value , weight ) ; }
+    /// fill the value with the weight (1D)
+    void fill
+    ( const double x          ,
+      const double value      ,
+      const double weight = 1 ) { add ( bin ( x         ) , value , weight ) ; }
+    /// fill the value with the weight (2D)
+    void fill
+    ( const double x          ,
+      const double y          ,
+      const double value      ,
+      const double weight     ) { add ( bin ( x , y     ) , value , weight ) ; }
+    /// fill the value with the weight (3D)
+    void fill
+    ( const double x          ,
+      const double y          ,
+      const double z          ,
+      const double value      ,
+      const double weight     ) { add ( bin ( x , y , z ) , value , weight ) ; }
+    // ========================================================================
+    /** merge with another statistics, the binning must be the same
+     *  @see Ostap::WStatEntity::add
+     */
+    BinStat& add        ( const BinStat& right ) ;
+    /// merge with another statistics
+    BinStat& operator+= ( const BinStat& right ) { return add ( right ) ; }
+    /// reset all counters
+    void reset () ;
+    // ========================================================================
+  public: // conversion to histograms
+    // ========================================================================
+    /** fill the profile histogram, the binning must be the same
+     *  - bin entries are sums of weights
+     *  - the contents are sums of weighted values and squared values
+     *  - the sums of squared weights are set for weighted data
+     */
+    void profile ( TProfile*   p ) const ;
+    /// fill the 2D-profile histogram, @see Ostap::BinStat::profile
+    void profile ( TProfile2D* p ) const ;
+    /// fill the 3D-profile histogram, @see Ostap::BinStat::profile
+    void profile ( TProfile3D* p ) const ;
+    // ========================================================================
+    /// fill the histogram with the mean values and the uncertainties of the mean
+    void mean    ( TH1* h ) const ;
+    /// fill the histogram with the r.m.s. values
+    void rms     ( TH1* h ) const ;
+    /// fill the histogram with the minimal values
+    void min     ( TH1* h ) const ;
+    /// fill the histogram with the maximal values
+    void max     ( TH1* h ) const ;
+    /// fill the histogram with the effective number of entries
+    void nEff    ( TH1* h ) const ;
+    /// fill the histogram with the sums of weights and their uncertainties
+    void sumw    ( TH1* h ) const ;
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// check the compatibility of the histogram
+    void check ( const TH1* h ) const ;
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the dimension
+    unsigned short                  m_dim   { 0 } ;
+    /// the model histogram (binning only)
+    std::unique_ptr<TH1>            m_model {}    ; //! the model
+    /// the counters
+    std::vector<Ostap::WStatEntity> m_stat  {}    ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+} //                                                     end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_BINSTAT_H
+// ============================================================================
@@ -0,0 +1,182 @@
+// ============================================================================
+#ifndef OSTAP_BINNEDNLL_H
+#define OSTAP_BINNEDNLL_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <memory>
+#include <string>
+#include <vector>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooAbsReal.h"
+#include "RooRealProxy.h"
+#include "RooListProxy.h"
+#include "RooArgSet.h"
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class TH1        ; // ROOT
+class RooRealVar ; // RooFit
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace MoreRooFit
+  {
+    // ========================================================================
+    /** @class BinnedNLL Ostap/BinnedNLL.h
+     *  Native binned negative log-likelihood for 1D histogram
+     *  - the expected number of entries in bin is the integral of PDF over the bin,
+     *    for Ostap::Models PDFs it is the analytical <code>integral(low,high)</code>
+     *    of the underlying Ostap::Math shape
+     *  - all bins of the component are evaluated in one go, and
+     *    the bin integrals are recalculated only for components
+     *    with modified parameters (e.g. the yields are changed)
+     *  - components without analytical integrals use RooFit integration
+     *
+     *  Extended case:
+     *  \f$ -\log L = \sum_b \left( \mu_b - n_b + n_b \log \frac{n_b}{\mu_b} \right) \f$,
+     *  \f$ \mu_b = \sum_k N_k \frac{ \int_b f_k }{ \int f_k } \f$
+     *
+     *  Non-extended case (single PDF):
+     *  \f$ -\log L = \sum_b n_b \log \frac{ n_b }{ N p_b } \f$,
+     *  \f$ p_b = \frac{ \int_b f }{ \sum_c \int_c f } \f$
+     *
+     *  The saturated model is subtracted, \f$ 2 \log L \f$ is close to \f$ \chi^2 \f$
+     *  @attention the bin contents are used as is: for weighted histograms
+     *             the uncertainties are not corrected
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-03-17
+     */
+    class BinnedNLL : public RooAbsReal
+    {
+      // ======================================================================
+      ClassDefOverride(Ostap::MoreRooFit::BinnedNLL , 1 ) ;  // binned NLL
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** constructor for the extended case
+       *  @param name   the name
+       *  @param title  the title
+       *  @param x      the observable
+       *  @param pdfs   the components
+       *  @param yields the yields of components
+       *  @param histo  the histogram
+       */
+      BinnedNLL
+      ( const std::string& name   ,
+        const std::string& title  ,
+        RooRealVar&        x      ,
+        const RooArgList&  pdfs   ,
+        const RooArgList&  yields ,
+        const TH1&         histo  ) ;
+      /** constructor for the non-extended case
+       *  @param name   the name
+       *  @param title  the title
+       *  @param x      the observable
+       *  @param pdf    the PDF
+       *  @param histo  the histogram
+       */
+      BinnedNLL
+      ( const std::string& name   ,
+        const std::string& title  ,
+        RooRealVar&        x      ,
+        RooAbsReal&        pdf    ,
+        const TH1&         histo  ) ;
+      /// copy
+      BinnedNLL ( const BinnedNLL& right       ,
+                  const char*      newname = 0 ) ;
+      /// default constructor, needed for serialization
+      BinnedNLL () = default ;
+      /// destructor
+      virtual ~BinnedNLL () ;
+      /// clone
+      BinnedNLL* clone ( const char* newname ) const override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// error level for the minimizer
+      Double_t defaultErrorLevel () const override { return 0.5 ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// extended likelihood?
+      bool          extended   () const { return m_extended ; }
+      /// number of bins
+      unsigned int  nBins      () const { return m_contents.size () ; }
+      /// number of components
+      unsigned int  nComponents() const { return m_pdfs.getSize () ; }
+      /// sum of bin contents
+      double        sumw       () const { return m_sumw ; }
+      /// number of recalculations of bin integrals (for monitoring)
+      unsigned long recalculations () const { return m_recalculations ; }
+      /** the expected number of entries in the bin
+       *  (the current parameters are used)
+       *  @param bin the bin, 0 <= bin < nBins()
+       */
+      double        expected   ( const unsigned int bin ) const ;
+      // ======================================================================
+    protected:
+      // ======================================================================
+      /// the actual evaluation of the result
+      Double_t evaluate () const override ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// book the bins and the named ranges
+      void book_    ( RooRealVar& x , const TH1& histo ) ;
+      /// (re)calculate the bin integrals for the components, if needed
+      void update_  () const ;
+      /// the parameters of the component are changed?
+      bool changed_ ( const unsigned int component ) const ;
+      /// calculate the bin integrals for the component
+      void calculate_ ( const unsigned int component ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the observable
+      RooRealProxy             m_x        {} ; // the observable
+      /// the components
+      RooListProxy             m_pdfs     {} ; // the components
+      /// the yields
+      RooListProxy             m_yields   {} ; // the yields
+      /// extended likelihood?
+      bool                     m_extended { false } ;
+      /// the bin edges
+      std::vector<double>      m_edges    {} ;
+      /// the bin contents
+      std::vector<double>      m_contents {} ;
+      /// the names of ranges for bins
+      std::vector<std::string> m_ranges   {} ;
+      /// sum of bin contents
+      double                   m_sumw     { 0 } ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the bin fractions for the components: nComponents() * nBins()
+      mutable std::vector<double>                     m_fractions      {} ; //!
+      /// the parameters of components
+      mutable std::vector<std::unique_ptr<RooArgSet> > m_parameters     {} ; //!
+      /// the snapshot of parameter values for the components
+      mutable std::vector<std::vector<double> >       m_snapshots      {} ; //!
+      /// analytical integration codes for the components
+      mutable std::vector<Int_t>                      m_codes          {} ; //!
+      /// numerical integrals for components without analytical integration
+      mutable std::vector<std::vector<std::unique_ptr<RooAbsReal> > > m_integrals {} ; //!
+      /// number of recalculations of bin integrals
+      mutable unsigned long                           m_recalculations { 0 } ; //!
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                   The end of namespace Ostap::MoreRooFit
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_BINNEDNLL_H
+// ============================================================================
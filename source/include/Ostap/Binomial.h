@@ -7,6 +7,7 @@
 // STD & STL
 // ============================================================================
 #include <utility>
+#include <vector>
 // ============================================================================
 /** @file Ostap/Binomial.h
  *  Collection of functions to estimate the confidence intervals for 
@@ -130,6 +131,82 @@ namespace Ostap
       const unsigned long rejected  ,
       const double        conflevel ) ;
     // ========================================================================
+    /** @enum BinomialInterval
+     *  the type of the confidence interval for the binomial proportion
+     *  to be used for the batch calculations 
+     *  @see Ostap::Math::binomial_intervals 
+     *  @author Vanya BELYAEV  Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    enum class BinomialInterval
+      {
+        Wald                  = 0 , // see Ostap::Math::wald_interval 
+        WilsonScore           = 1 , // see Ostap::Math::wilson_score_interval 
+        WilsonScoreContinuity = 2 , // see Ostap::Math::wilson_score_continuity_interval 
+        ArcSin                = 3 , // see Ostap::Math::arcsin_interval 
+        AgrestiCoull          = 4 , // see Ostap::Math::agresti_coull_interval 
+        Jeffreys              = 5 , // see Ostap::Math::jeffreys_interval 
+        ClopperPearson        = 6   // see Ostap::Math::clopper_pearson_interval 
+      } ;
+    // ========================================================================
+    /** batch calculation of the confidence intervals for
+     *  binomial proportions/efficiencies, e.g. for all bins of 
+     *  the efficiency histogram 
+     *  - the beta-quantiles (Jeffreys & Clopper-Pearson) are calculated 
+     *    only once for each distinct pair of <code>(accepted,rejected)</code>
+     *  - the calculations are performed in parallel
+     *  @param  type      the type of the interval 
+     *  @param  accepted  numbers of accepted events
+     *  @param  rejected  numbers of rejected events
+     *  @param  conflevel the confidence level:    0<=CL<=1 
+     *  @param  low       (output) the lower edges of the intervals 
+     *  @param  high      (output) the upper edges of the intervals 
+     *  @param  nthreads  number of threads (0: all, 1: sequential)
+     *  @return number of calculated intervals 
+     *  @author Vanya BELYAEV  Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    std::size_t 
+    binomial_intervals
+    ( const BinomialInterval            type         ,
+      const std::vector<unsigned long>& accepted     ,
+      const std::vector<unsigned long>& rejected     ,
+      const double                      conflevel    ,
+      std::vector<double>&              low          ,
+      std::vector<double>&              high         ,
+      const unsigned int                nthreads = 0 ) ;
+    // ========================================================================
+    /** batch calculation of the confidence intervals for
+     *  binomial proportions/efficiencies for the weighted data.
+     *  The interval is calculated for the efficiency 
+     *  \f$ \varepsilon = \frac{\sum w_a}{\sum w_a + \sum w_r} \f$ 
+     *  using the effective number of entries 
+     *  \f$ n_{\mathrm{eff}} = \frac{\left(\sum w_a + \sum w_r\right)^2}{\sum w_a^2 + \sum w_r^2} \f$
+     *  @param  type      the type of the interval 
+     *  @param  sumwa     sums of weights   for accepted events
+     *  @param  sumw2a    sums of weights^2 for accepted events
+     *  @param  sumwr     sums of weights   for rejected events
+     *  @param  sumw2r    sums of weights^2 for rejected events
+     *  @param  conflevel the confidence level:    0<=CL<=1 
+     *  @param  low       (output) the lower edges of the intervals 
+     *  @param  high      (output) the upper edges of the intervals 
+     *  @param  nthreads  number of threads (0: all, 1: sequential)
+     *  @return number of calculated intervals 
+     *  @author Vanya BELYAEV  Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    std::size_t 
+    binomial_intervals
+    ( const BinomialInterval            type         ,
+      const std::vector<double>&        sumwa        ,
+      const std::vector<double>&        sumw2a       ,
+      const std::vector<double>&        sumwr        ,
+      const std::vector<double>&        sumw2r       ,
+      const double                      conflevel    ,
+      std::vector<double>&              low          ,
+      std::vector<double>&              high         ,
+      const unsigned int                nthreads = 0 ) ;
+    // ========================================================================
   } //                                            end of namespace Ostap::Math
   // ==========================================================================
 } //                                                     end of namespace Ostap
@@ -473,6 +473,28 @@ namespace Ostap
       /// describe the channel 
       std::string describe  () const override { return m_description ; }
       // =======================================================================
+    public: // opt-in approximation for the fast evaluation 
+      // =======================================================================
+      /** approximate the mass-dependent width \f$ w(s) \f$ in the range 
+       *  \f$ s_{min} \le s \le s_{max} \f$ with Chebyshev polynomials. 
+       *  The order of approximation is doubled until the requested 
+       *  precision is reached at the control points. 
+       *  It is useful for the expensive widths, e.g. for the 
+       *  widths, calculated via integration over the phase space. 
+       *  Outside of the range the original function is used. 
+       *  @param smin      (INPUT) low  edge of the range 
+       *  @param smax      (INPUT) high edge of the range 
+       *  @param precision (INPUT) the required relative precision 
+       *  @param nmax      (INPUT) the maximal order of approximation 
+       *  @return the achieved precision; the approximation is 
+       *          used only if the required precision is reached 
+       */
+      double approximate 
+      ( const double         smin              , 
+        const double         smax              , 
+        const double         precision = 1.e-7 , 
+        const unsigned short nmax      = 512   ) ;
+      // =======================================================================
     private :
       // =======================================================================
       /// mass-dependent width 
@@ -586,6 +608,28 @@ namespace Ostap
       /// describe the channel 
       std::string describe  () const override { return m_description ; }
       // =======================================================================
+    public: // opt-in approximation for the fast evaluation 
+      // =======================================================================
+      /** approximate the mass-dependent width \f$ \gamma(s) \f$ in the range 
+       *  \f$ s_{min} \le s \le s_{max} \f$ with Chebyshev polynomials. 
+       *  The order of approximation is doubled until the requested 
+       *  precision is reached at the control points. 
+       *  It is useful for the expensive widths, e.g. for the 
+       *  widths, calculated via integration over the phase space. 
+       *  Outside of the range the original function is used. 
+       *  @param smin      (INPUT) low  edge of the range 
+       *  @param smax      (INPUT) high edge of the range 
+       *  @param precision (INPUT) the required relative precision 
+       *  @param nmax      (INPUT) the maximal order of approximation 
+       *  @return the achieved precision; the approximation is 
+       *          used only if the required precision is reached 
+       */
+      double approximate 
+      ( const double         smin              , 
+        const double         smax              , 
+        const double         precision = 1.e-7 , 
+        const unsigned short nmax      = 512   ) ;
+      // =======================================================================
     private :
       // =======================================================================
       /// mass-dependent width 
@@ -7,6 +7,8 @@
 // STD&STL
 // ============================================================================
 #include <functional>
+#include <vector>
+#include <cstddef>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -38,16 +40,20 @@ namespace Ostap
     public:
       // ======================================================================
       /** constructor from the function, low/high-limits and the approximation order 
-       *  @param func the function 
-       *  @param a the low-limit 
-       *  @param b the high-limit 
-       *  @param N the approximation order 
+       *  The coefficients are calculated via DCT (O(N log N))
+       *  @param func     the function 
+       *  @param a        the low-limit 
+       *  @param b        the high-limit 
+       *  @param N        the approximation order 
+       *  @param nthreads number of threads for the evaluation of the function at 
+       *                  the nodes (the function must be thread-safe for nthreads>1)
        */
       ChebyshevApproximation 
-      ( std::function<double(double)>        func , 
-        const double                         a    , 
-        const double                         b    , 
-        const unsigned short                 N    ) ;
+      ( std::function<double(double)>        func         , 
+        const double                         a            , 
+        const double                         b            , 
+        const unsigned short                 N            , 
+        const unsigned int                   nthreads = 1 ) ;
       // ======================================================================
       /** constructor from the function, low/high-limits and the approximation order 
        *  @param func the function 
@@ -64,11 +70,12 @@ namespace Ostap
       /// templated constructor 
       template <class FUNCTION>
       ChebyshevApproximation 
-      ( FUNCTION             func , 
-        const double         a    , 
-        const double         b    , 
-        const unsigned short N    ) 
-        : ChebyshevApproximation ( std::function<double(double)> ( func ) , a , b , N ) 
+      ( FUNCTION             func         , 
+        const double         a            , 
+        const double         b            , 
+        const unsigned short N            , 
+        const unsigned int   nthreads = 1 ) 
+        : ChebyshevApproximation ( std::function<double(double)> ( func ) , a , b , N , nthreads ) 
       {}
       // ======================================================================
       /// copy constructor 
@@ -177,6 +184,49 @@ namespace Ostap
                const unsigned short N ) 
       { return ChebyshevApproximation ( f ,  a , b , N ) ; }
       // ======================================================================
+      /** Build chebyshev approximation with the adaptive choice of the order
+       *  - the function is evaluated at nested Chebyshev-Lobatto points, 
+       *    the number of points is doubled until the tail of the series is 
+       *    smaller than \f$ \epsilon \max \left| f \right| \f$, 
+       *    the previous evaluations are reused 
+       *  - the coefficients are calculated via DCT-I (O(N log N))
+       *  - the negligible tail of the series is truncated 
+       *  @code
+       *  auto cheb = ChebyshevApproximation::adaptive ( bw , 0.2 , 2.0 , 1.e-12 ) ;
+       *  @endcode 
+       *  @param f         the function 
+       *  @param a         low   edge 
+       *  @param b         high edge 
+       *  @param precision the (relative to max|f|) precision 
+       *  @param Nmax      the maximal order of approximation 
+       *  @param nthreads  number of threads for the evaluation of the function
+       *                   (the function must be thread-safe for nthreads>1)
+       */
+      static ChebyshevApproximation
+      adaptive 
+      ( std::function<double(double)> f                  , 
+        const double                  a                  , 
+        const double                  b                  , 
+        const double                  precision = 1.e-12 , 
+        const unsigned short          Nmax      = 4096   , 
+        const unsigned int            nthreads  = 1      ) ;
+      // ======================================================================
+      /** Build chebyshev approximation with the adaptive choice of the order
+       *  @see ChebyshevApproximation::adaptive 
+       *  @param f         the function 
+       *  @param a         low   edge 
+       *  @param b         high edge 
+       *  @param precision the (relative to max|f|) precision 
+       *  @param Nmax      the maximal order of approximation 
+       */
+      static ChebyshevApproximation
+      adaptive 
+      ( const Ostap::Functions::PyCallable& f                  , 
+        const double                        a                  , 
+        const double                        b                  , 
+        const double                        precision = 1.e-12 , 
+        const unsigned short                Nmax      = 4096   ) ;
+      // ======================================================================
     public:
       // ======================================================================
       /// swap two objects 
@@ -252,6 +302,162 @@ namespace Ostap
     { return Ostap::Math::ChebyshevApproximation 
         ( std::cref ( f ) ,  a , b , N ).polynomial () ; }
     // ========================================================================
+    /** @class ChebyshevProxy Ostap/ChebyshevApproximation.h
+     *  Piecewise Chebyshev approximation ("proxy") for an expensive 1D function
+     *  - the interval is split adaptively (by bisection) 
+     *    until the estimated error in each piece is smaller than 
+     *    \f$ \epsilon \max \left| f \right| \f$ 
+     *  - the error in each piece is estimated from the last two 
+     *    Chebyshev coefficients and from the direct comparison 
+     *    with the function at two control points 
+     *  - the piece is found in O(1) via the lookup table 
+     *  - the function is not used after the construction, 
+     *    the evaluation does not depend on its cost 
+     *  - it is zero outside the interval
+     *  @code 
+     *  const Ostap::Math::BW& bw = ... ; 
+     *  const Ostap::Math::ChebyshevProxy proxy ( bw , 0.2 , 2.0 , 1.e-10 ) ;
+     *  const double value = proxy ( 1.1 ) ;
+     *  @endcode 
+     *  @see Ostap::Math::ChebyshevApproximation
+     *  @see Ostap::Models::Shape1D
+     */
+    class ChebyshevProxy 
+    {
+    public:
+      // ======================================================================
+      /** constructor from the function and the interval 
+       *  @param func      the function 
+       *  @param a         the low-limit 
+       *  @param b         the high-limit 
+       *  @param precision the (relative to max|f|) precision 
+       *  @param N         the approximation order in each piece 
+       *  @param maxdepth  the maximal depth of bisections 
+       */
+      ChebyshevProxy 
+      ( std::function<double(double)>        func               , 
+        const double                         a                  , 
+        const double                         b                  , 
+        const double                         precision = 1.e-10 , 
+        const unsigned short                 N         = 16     , 
+        const unsigned short                 maxdepth  = 12     ) ;
+      // ======================================================================
+      /** constructor from the function and the interval 
+       *  @param func      the function 
+       *  @param a         the low-limit 
+       *  @param b         the high-limit 
+       *  @param precision the (relative to max|f|) precision 
+       *  @param N         the approximation order in each piece 
+       *  @param maxdepth  the maximal depth of bisections 
+       */
+      ChebyshevProxy 
+      ( const Ostap::Functions::PyCallable& func               , 
+        const double                        a                  , 
+        const double                        b                  , 
+        const double                        precision = 1.e-10 , 
+        const unsigned short                N         = 16     , 
+        const unsigned short                maxdepth  = 12     ) ;
+      // ======================================================================
+      /// templated constructor 
+      template <class FUNCTION>
+      ChebyshevProxy 
+      ( FUNCTION             func               , 
+        const double         a                  , 
+        const double         b                  , 
+        const double         precision = 1.e-10 , 
+        const unsigned short N         = 16     , 
+        const unsigned short maxdepth  = 12     ) 
+        : ChebyshevProxy ( std::function<double(double)> ( func ) , 
+                           a , b , precision , N , maxdepth ) 
+      {}
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the main method: evaluate the approximation 
+      double operator () ( const double x ) const { return evaluate ( x ) ; }
+      /// the main method: evaluate the approximation 
+      double evaluate    ( const double x ) const ;
+      // ======================================================================
+      /** evaluate the approximation for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void evaluate 
+      ( const std::size_t n      , 
+        const double*     x      , 
+        double*           result ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// get the integral between low and high 
+      double integral ( const double low , const double high ) const ;
+      /// get the integral over the whole interval 
+      double integral () const 
+      { return m_integrals.empty() ? 0.0 : m_integrals.back() ; }
+      // ======================================================================
+    public: // trivial accessors 
+      // ======================================================================
+      /// get low edge 
+      double         xmin      () const { return m_a ; }
+      /// get high edge 
+      double         xmax      () const { return m_b ; }
+      /// the approximation order in each piece 
+      unsigned short N         () const { return m_N ; }
+      /// number of pieces 
+      std::size_t    pieces    () const { return m_knots.empty() ? 0 : m_knots.size () - 1 ; }
+      /// the requested (relative to max|f|) precision 
+      double         precision () const { return m_precision ; }
+      /// the estimated (absolute) error bound 
+      double         error     () const { return m_error     ; }
+      /// the maximal absolute value of the function (at the sampled points)
+      double         scale     () const { return m_scale     ; }     
+      /// the knots 
+      const std::vector<double>& knots        () const { return m_knots        ; }
+      /// the coefficients: N per piece, the first one is halved 
+      const std::vector<double>& coefficients () const { return m_coefficients ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// find the piece 
+      inline std::size_t piece ( const double x ) const 
+      {
+        const double      u = ( x - m_a ) * m_icell ;
+        const std::size_t c = u <= 0 ? 0 : std::size_t ( u ) ;
+        return m_table [ c < m_table.size() ? c : m_table.size() - 1 ] ;
+      }
+      /// evaluate the piece
+      double _evaluate_ ( const std::size_t p , const double x ) const ;
+      /// indefinite integral for the piece (from its low edge) 
+      double _integral_ ( const std::size_t p , const double x ) const ;
+      // ======================================================================
+    private :
+      // ======================================================================
+      /// low edge 
+      double         m_a         { 0 } ; // low edge 
+      /// high edge 
+      double         m_b         { 1 } ; // high edge 
+      /// approximation order 
+      unsigned short m_N         { 1 } ; // approximation order
+      /// precision 
+      double         m_precision { 0 } ; // precision 
+      /// error estimate 
+      double         m_error     { 0 } ; // error estimate
+      /// scale 
+      double         m_scale     { 0 } ; // scale 
+      /// inverse width of the lookup cell 
+      double         m_icell     { 1 } ; // inverse width of the lookup cell 
+      /// knots 
+      std::vector<double>       m_knots        {} ; // knots 
+      /// coefficients: N per piece, the first one is halved 
+      std::vector<double>       m_coefficients {} ; // coefficients 
+      /// integrals from the low edge up to the knots 
+      std::vector<double>       m_integrals    {} ; // integrals up to the knots 
+      /// lookup table: cell -> piece 
+      std::vector<unsigned int> m_table        {} ; // lookup table 
+      // ======================================================================
+    };
+    // ========================================================================
   } //                                         The end of namespace Ostap::Math
   // ==========================================================================
 } //                                                 The end of namespace Ostap
@@ -4,6 +4,10 @@
 // ============================================================================
 // Include files
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+// ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/ValueWithError.h"
@@ -22,6 +26,22 @@ namespace Ostap
     // ========================================================================
     /** @class Chi2Fit  Ostap/Chi2Fit.h
     *   Trivial chi2-fit 
+     *
+     *  The data are fit with the linear combination of components 
+     *  \f$ d_i = \sum_j a_j c_{ji} \f$, the uncertainties of both data
+     *  and components are taken into account:
+     *  \f$ \chi^2 = \sum_i \frac{ (d_i - \sum_j a_j c_{ji})^2 }
+     *                              { \sigma^2_{d_i} + \sum_j a^2_j \sigma^2_{c_{ji}} } \f$ 
+     *
+     *  The starting point is the direct solution of the normal equations 
+     *  (the uncertainties of components are ignored), that is the exact 
+     *  solution if components have no uncertainties. 
+     *  Otherwise it is refined by Newton iterations with the analytical hessian.
+     *  The gradient and hessian are accumulated by blocks of points, 
+     *  large problems are split between threads.
+     *  - <code>niters</code> is the number of Newton refinements
+     *  - <code>ncalls</code> is the number of passes over data
+     *  @see Ostap::Math::Chi2Solver
      *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
      *  @date   2012-05-26
      */
@@ -39,11 +59,13 @@ namespace Ostap
     public: 
       // ======================================================================
       /// fit with one component 
-      Chi2Fit ( const DATA& data ,    // the data 
-                const DATA& cmp  ) ;  // the component
+      Chi2Fit ( const DATA&        data         ,    // the data 
+                const DATA&        cmp          ,    // the component
+                const unsigned int nthreads = 1 ) ;  // number of threads 
       /// fit with many component 
-      Chi2Fit ( const DATA& data ,    // the data 
-                const CMPS& cmps ) ;  // the components
+      Chi2Fit ( const DATA&        data         ,    // the data 
+                const CMPS&        cmps         ,    // the components
+                const unsigned int nthreads = 1 ) ;  // number of threads 
       /// destructor 
       ~Chi2Fit () ; // destructor 
       // ======================================================================
@@ -109,6 +131,151 @@ namespace Ostap
     inline std::ostream& operator<< ( std::ostream& s , const Chi2Fit& f ) 
     { return f.fillStream ( s ) ; }
     // ========================================================================
+    /** @class Chi2Solver  Ostap/Chi2Fit.h
+     *  Linear least squares fit of data vectors with the fixed 
+     *  set of components and fixed weights:
+     *  \f$ \chi^2 = \sum_i w_i ( d_i - \sum_j a_j c_{ji} )^2 \f$ 
+     *
+     *  The normal matrix \f$ C^T W C \f$ is built (by blocks, in threads) 
+     *  and factorized (Cholesky) only once, in constructor, 
+     *  and each data vector requires only \f$ C^T W d \f$ and two
+     *  triangular solutions, therefore it is suitable for 
+     *  the batch fits of many data vectors with the same components.
+     *  Optionally the non-negative solution is found 
+     *  (Lawson-Hanson active set algorithm, applied to normal equations) 
+     *
+     *  @code
+     *  Chi2Solver solver ( cmps , weights ) ;
+     *  std::vector<double> params ( solver.size () ) ;
+     *  double chi2 = 0 ;
+     *  solver.solve ( data.data() , params.data() , chi2 ) ;
+     *  @endcode
+     *  @see Ostap::Math::Chi2Fit
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2023-02-01
+     */
+    class Chi2Solver 
+    {
+    public: 
+      // ======================================================================
+      typedef std::vector<double>  Data ;
+      typedef Chi2Fit::VE          VE   ;
+      typedef Chi2Fit::DATA        DATA ;
+      typedef Chi2Fit::CMPS        CMPS ;
+      // ======================================================================
+    public: 
+      // ======================================================================
+      /** constructor from the components (values are used)  
+       *  @param cmps        the components 
+       *  @param weights     the weights of points (empty: unit weights) 
+       *  @param nonnegative look for non-negative solutions?
+       *  @param nthreads    number of threads, 0 means all available 
+       */
+      Chi2Solver ( const CMPS&        cmps                , 
+                   const Data&        weights     = Data  () , 
+                   const bool         nonnegative = false , 
+                   const unsigned int nthreads    = 1     ) ;
+      /** constructor from the components 
+       *  @param cmps        the components: <code>ncmps</code> consecutive 
+       *                     arrays of <code>npoints</code> values 
+       *  @param ncmps       number of components 
+       *  @param npoints     number of points 
+       *  @param weights     the weights of points (nullptr: unit weights) 
+       *  @param nonnegative look for non-negative solutions?
+       *  @param nthreads    number of threads, 0 means all available 
+       */
+      Chi2Solver ( const double*      cmps                , 
+                   const std::size_t  ncmps               , 
+                   const std::size_t  npoints             , 
+                   const double*      weights     = nullptr , 
+                   const bool         nonnegative = false , 
+                   const unsigned int nthreads    = 1     ) ;
+      // ======================================================================
+    public: 
+      // ======================================================================
+      /// number of components 
+      std::size_t size        () const { return m_ncmps       ; }
+      /// number of points 
+      std::size_t points      () const { return m_npoints     ; }
+      /// non-negative solutions ?
+      bool        nonnegative () const { return m_nonnegative ; }
+      /// status of factorization 
+      StatusCode  status      () const { return m_code        ; }
+      /// the element of normal matrix \f$ C^T W C \f$ 
+      double      matrix      ( const unsigned int i1 , 
+                                const unsigned int i2 ) const ;
+      /// the element of covariance matrix \f$ (C^T W C)^{-1} \f$ (unconstrained)
+      double      cov2        ( const unsigned int i1 , 
+                                const unsigned int i2 ) const ;
+      // ======================================================================
+    public: 
+      // ======================================================================
+      /** solve for one data vector 
+       *  @param data   (INPUT)  data, <code>points()</code> values 
+       *  @param result (OUTPUT) parameters,  <code>size()</code> values 
+       *  @param chi2   (OUTPUT) chi2 at solution 
+       */
+      StatusCode solve 
+      ( const double* data   , 
+        double*       result , 
+        double&       chi2   ) const ;
+      /** solve for many data vectors
+       *  @param data     (INPUT)  <code>nvectors</code> consecutive data vectors 
+       *  @param nvectors (INPUT)  number of data vectors 
+       *  @param results  (OUTPUT) <code>nvectors</code> consecutive parameter vectors 
+       *  @param chi2s    (OUTPUT) <code>nvectors</code> chi2 values (can be nullptr) 
+       *  @return status code (the first failure, if any) 
+       */
+      StatusCode solve_many 
+      ( const double*     data     , 
+        const std::size_t nvectors , 
+        double*           results  , 
+        double*           chi2s    = nullptr ) const ;
+      /** solve for one data vector 
+       *  The uncertainties of parameters are  
+       *  \f$ \sqrt{ \left(C^T W C\right)^{-1}_{jj} } \f$, 
+       *  for non-negative solutions the matrix is restricted 
+       *  to the non-zero parameters, and zero parameters have no uncertainties 
+       *  @param data (INPUT)  data, <code>points()</code> values 
+       *  @return parameters (empty vector for failure)
+       */
+      DATA       solve 
+      ( const Data&   data   ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// build and factorize the normal matrix 
+      void          build      ( const double* cmps , const double* weights ) ;
+      /// solve for one data vector 
+      StatusCode    solve_     ( const double*      data     , 
+                                 double*            result   , 
+                                 double&            chi2     , 
+                                 const unsigned int nthreads , 
+                                 std::vector<int>*  passive  ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// number of components 
+      std::size_t  m_ncmps       { 0 } ;
+      /// number of points 
+      std::size_t  m_npoints     { 0 } ;
+      /// non-negative ?
+      bool         m_nonnegative { false } ;
+      /// number of threads 
+      unsigned int m_nthreads    { 1 } ;
+      /// components (component-major) 
+      Data         m_cmps        {   } ;
+      /// weights 
+      Data         m_weights     {   } ;
+      /// normal matrix \f$ C^T W C \f$ 
+      Data         m_matrix      {   } ;
+      /// Cholesky factor of the normal matrix 
+      Data         m_factor      {   } ;
+      /// the status of factorization 
+      StatusCode   m_code        { StatusCode::SUCCESS } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
   } //                                             end of namespace Ostap::Math
   // ==========================================================================
 } //                                                     end of namespace Ostap
@@ -7,8 +7,10 @@
 // STD & STL
 // ============================================================================
 #include <cmath>
+#include <cstddef>
 #include <array>
 #include <utility>
+#include <iterator>
 #include <algorithm>
 // ============================================================================
 /** @file Ostap/Clenshaw.h
@@ -589,6 +591,263 @@ namespace Ostap
         return std::fma ( cosx ,  b1c , 0.5 * (*first) - b2c + b1s * sinx ) ;
       }
       // ======================================================================
+      // Array versions: the recurrence runs simultaneously for a block 
+      // of x-values, and the coefficients are streamed once per block 
+      // ======================================================================
+      /// the block size (the number of "lanes") for the array versions 
+      constexpr std::size_t s_BLOCK = 8 ;
+      // ======================================================================
+      /** Clenshaw algorithm for summation of monomial series (aka "Horner's rule")
+       *  for the array of points 
+       *  \f$ f(x) = \sum_{i=0}^{n} a_i x^{n-i} \f$, 
+       *  @see Ostap::Math::Clenshaw::monomial_sum 
+       *  @param first  iterator for start of the sequence 
+       *  @param last   iterator for end   of the sequence 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results (can be the same as <code>x</code>)
+       *  @date 2023-02-01
+       */
+      template <class ITERATOR>
+      inline void 
+      monomial_sum 
+      ( ITERATOR          first  , 
+        ITERATOR          last   , 
+        const std::size_t n      , 
+        const double*     x      , 
+        double*           result ) 
+      {
+        if ( first == last ) { std::fill ( result , result + n , 0.0 ) ; return ; }
+        //
+        for ( std::size_t i0 = 0 ; i0 < n ; i0 += s_BLOCK )
+        {
+          const std::size_t m = std::min ( s_BLOCK , n - i0 ) ;
+          double xx [ s_BLOCK ] = {} ;
+          double p  [ s_BLOCK ] ;
+          std::copy ( x + i0 , x + i0 + m , xx ) ;
+          //
+          ITERATOR it = first ;
+          std::fill ( p , p + s_BLOCK , double ( *it ) ) ;
+          while ( ++it != last ) 
+          {
+            const double a = *it ;
+            for ( std::size_t j = 0 ; j < s_BLOCK ; ++j ) 
+            { p [ j ] = std::fma ( xx [ j ] , p [ j ] , a ) ; }
+          }
+          std::copy ( p , p + m , result + i0 ) ;
+        }
+      }
+      // ======================================================================
+      /** Clenshaw algorithm for summation of Legendre series 
+       *  for the array of points 
+       *  \f$ f(x) = \sum_{i=0}^{n} a_i L_i(x) \f$
+       *  @see Ostap::Math::Clenshaw::legendre_sum 
+       *  @param first  iterator for start of the sequence 
+       *  @param last   iterator for end   of the sequence 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results (can be the same as <code>x</code>)
+       *  @date 2023-02-01
+       */
+      template <class ITERATOR>
+      inline void 
+      legendre_sum 
+      ( ITERATOR          first  , 
+        ITERATOR          last   , 
+        const std::size_t n      , 
+        const double*     x      , 
+        double*           result ) 
+      {
+        if ( first == last ) { std::fill ( result , result + n , 0.0 ) ; return ; }
+        //
+        const std::size_t N = std::distance ( first , last ) ;
+        for ( std::size_t i0 = 0 ; i0 < n ; i0 += s_BLOCK )
+        {
+          const std::size_t m = std::min ( s_BLOCK , n - i0 ) ;
+          double xx [ s_BLOCK ] = {} ;
+          double b1 [ s_BLOCK ] = {} ;
+          double b2 [ s_BLOCK ] = {} ;
+          std::copy ( x + i0 , x + i0 + m , xx ) ;
+          //
+          ITERATOR    it = last ;
+          std::size_t k  = N    ;
+          while ( it != first ) 
+          {
+            --it ; --k ;
+            const double a     = *it ;
+            const double alpha = ( 2.0 * k + 1 ) / ( k + 1 ) ;
+            const double beta  = ( k + 1.0     ) / ( k + 2 ) ;
+            for ( std::size_t j = 0 ; j < s_BLOCK ; ++j ) 
+            {
+              const double b0 = a + alpha * xx [ j ] * b1 [ j ] - beta * b2 [ j ] ;
+              b2 [ j ] = b1 [ j ] ;
+              b1 [ j ] = b0       ;
+            }
+          }
+          std::copy ( b1 , b1 + m , result + i0 ) ;
+        }
+      }
+      // ======================================================================
+      /** Clenshaw algorithm for summation of Chebyshev series 
+       *  for the array of points 
+       *  \f$ f(x) = \sum_{i=0}^{n} a_i C_i(x) \f$
+       *  @see Ostap::Math::Clenshaw::chebyshev_sum 
+       *  @param first  iterator for start of the sequence 
+       *  @param last   iterator for end   of the sequence 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results (can be the same as <code>x</code>)
+       *  @date 2023-02-01
+       */
+      template <class ITERATOR>
+      inline void 
+      chebyshev_sum 
+      ( ITERATOR          first  , 
+        ITERATOR          last   , 
+        const std::size_t n      , 
+        const double*     x      , 
+        double*           result ) 
+      {
+        if ( first == last ) { std::fill ( result , result + n , 0.0 ) ; return ; }
+        //
+        const double a0 = *first ;
+        for ( std::size_t i0 = 0 ; i0 < n ; i0 += s_BLOCK )
+        {
+          const std::size_t m = std::min ( s_BLOCK , n - i0 ) ;
+          double xx [ s_BLOCK ] = {} ;
+          double b1 [ s_BLOCK ] = {} ;
+          double b2 [ s_BLOCK ] = {} ;
+          std::copy ( x + i0 , x + i0 + m , xx ) ;
+          //
+          ITERATOR it = last ;
+          while ( --it != first ) 
+          {
+            const double a = *it ;
+            for ( std::size_t j = 0 ; j < s_BLOCK ; ++j ) 
+            {
+              const double b0 = std::fma ( 2 * xx [ j ] , b1 [ j ] , a - b2 [ j ] ) ;
+              b2 [ j ] = b1 [ j ] ;
+              b1 [ j ] = b0       ;
+            }
+          }
+          for ( std::size_t j = 0 ; j < m ; ++j ) 
+          { result [ i0 + j ] = std::fma ( xx [ j ] , b1 [ j ] , a0 - b2 [ j ] ) ; }
+        }
+      }
+      // ======================================================================
+      /** Clenshaw algorithm for summation of Hermite's series 
+       *  for the array of points 
+       *  \f$ f(x) = \sum_{i=0}^{n} a_i He_i(x) \f$
+       *  @see Ostap::Math::Clenshaw::hermite_sum 
+       *  @param first  iterator for start of the sequence 
+       *  @param last   iterator for end   of the sequence 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results (can be the same as <code>x</code>)
+       *  @date 2023-02-01
+       */
+      template <class ITERATOR>
+      inline void 
+      hermite_sum 
+      ( ITERATOR          first  , 
+        ITERATOR          last   , 
+        const std::size_t n      , 
+        const double*     x      , 
+        double*           result ) 
+      {
+        if ( first == last ) { std::fill ( result , result + n , 0.0 ) ; return ; }
+        //
+        const std::size_t N = std::distance ( first , last ) ;
+        for ( std::size_t i0 = 0 ; i0 < n ; i0 += s_BLOCK )
+        {
+          const std::size_t m = std::min ( s_BLOCK , n - i0 ) ;
+          double xx [ s_BLOCK ] = {} ;
+          double b1 [ s_BLOCK ] = {} ;
+          double b2 [ s_BLOCK ] = {} ;
+          std::copy ( x + i0 , x + i0 + m , xx ) ;
+          //
+          ITERATOR    it = last ;
+          std::size_t k  = N    ;
+          while ( it != first ) 
+          {
+            --it ; 
+            const double a = *it ;
+            const double c = k   ; 
+            for ( std::size_t j = 0 ; j < s_BLOCK ; ++j ) 
+            {
+              const double b0 = std::fma ( xx [ j ] , b1 [ j ] , a - c * b2 [ j ] ) ;
+              b2 [ j ] = b1 [ j ] ;
+              b1 [ j ] = b0       ;
+            }
+            --k ;
+          }
+          std::copy ( b1 , b1 + m , result + i0 ) ;
+        }
+      }
+      // ======================================================================
+      /** Generic form of Clenshaw algorithm for the array of points 
+       *  @see Ostap::Math::Clenshaw::sum 
+       *  The coefficients \f$ a_k\f$ are requested once per block of points,
+       *  while \f$ \alpha_k(x)\f$ and \f$ \beta_k(x)\f$ are evaluated for each point 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results (can be the same as <code>x</code>)
+       *  @param N      (INPUT)  number of terms in the sequence
+       *  @param a      (INPUT)  callable, that returns the coefficient \f$ a_k\f$
+       *  @param alpha  (INPUT)  callable, that returns the value of \f$ \alpha_k(x) \f$
+       *  @param beta   (INPUT)  callable, that returns the value of \f$ \beta_k(x) \f$
+       *  @param phi0   (INPUT)  callable, that returns the value of \f$ \phi_0(x) \f$ 
+       *  @param phi1   (INPUT)  callable, that returns the value of \f$ \phi_1(x) \f$ 
+       *  @date 2023-02-01
+       */
+      template <class COEFF , 
+                class ALPHA , 
+                class BETA  , 
+                class PHI0  , 
+                class PHI1  >
+      inline void 
+      sum ( const std::size_t  n      , 
+            const double*      x      , 
+            double*            result ,  
+            const unsigned int N      ,
+            COEFF              a      , 
+            ALPHA              alpha  , 
+            BETA               beta   , 
+            PHI0               phi0   , 
+            PHI1               phi1   )
+      {
+        //
+        const double a0 = a ( 0 ) ;
+        for ( std::size_t i0 = 0 ; i0 < n ; i0 += s_BLOCK )
+        {
+          const std::size_t m = std::min ( s_BLOCK , n - i0 ) ;
+          double xx [ s_BLOCK ] = {} ;
+          double b1 [ s_BLOCK ] = {} ;
+          double b2 [ s_BLOCK ] = {} ;
+          std::copy ( x + i0 , x + i0 + m , xx ) ;
+          //
+          for ( unsigned int k = N ; 1 <= k ; --k ) 
+          {
+            const double ak = a ( k ) ;
+            for ( std::size_t j = 0 ; j < m ; ++j ) 
+            {
+              const double b0 = ak 
+                + alpha ( k     , xx [ j ] ) * b1 [ j ] 
+                + beta  ( k + 1 , xx [ j ] ) * b2 [ j ] ;
+              b2 [ j ] = b1 [ j ] ;
+              b1 [ j ] = b0       ;
+            }
+          }
+          //
+          for ( std::size_t j = 0 ; j < m ; ++j ) 
+          {
+            const double xj = xx [ j ] ;
+            result [ i0 + j ] = 
+              phi0 ( xj ) * ( a0 + beta ( 1 , xj ) * b2 [ j ] ) + phi1 ( xj ) * b1 [ j ] ;
+          }
+        }
+      }
+      // ======================================================================
     } //                             The end of namespace Ostap::Math::Clenshaw     
     // ========================================================================
     namespace detail
@@ -7,6 +7,8 @@
 // STD&STL 
 // ============================================================================
 #include <array>
+#include <vector>
+#include <cmath>
 // ============================================================================
 // ROOT
 // ============================================================================
@@ -56,6 +58,21 @@ namespace  Ostap
      *        Volume 270, Issue 1, 1 July 1988, Pages 110-117
      *  @see https://doi.org/10.1016/0168-9002(88)90018-6
      *
+     *  The Cholesky factor of the covariance matrix is kept, 
+     *  that allows the efficient repeated combinations: 
+     *  - the weights do not depend on the central values, 
+     *    and new data are combined in \f$ O(D) \f$ (value) and 
+     *    \f$ O(D^2) \f$ (uncertainty) operations
+     *  - low-rank changes of the covariance matrix, e.g. scaling of one 
+     *    systematic component, are handled by rank-1 updates/downdates 
+     *    of the Cholesky factor and require \f$ O(kD^2)\f$ operations
+     *  @code
+     *  Combine<3> cmb ( data , stat + syst1 + syst2 ) ;
+     *  const auto f2 = Combine<3>::factors ( syst2 ) ;
+     *  cmb.update ( f2 , 1.5 * 1.5 - 1 ) ; // scale syst2 by factor 1.5
+     *  auto r = cmb.result () ;
+     *  @endcode
+     *
      *  @author  Vanya BELYAEV Ivan.Belyaev@itep.ru
      *  @date 2015-09-28
      */
@@ -67,6 +84,10 @@ namespace  Ostap
       typedef  ROOT::Math::SVector<T,D>                                 Data          ;
       typedef  ROOT::Math::SMatrix<T,D,D,ROOT::Math::MatRepSym<T,D> >   Covariance    ;
       typedef  Ostap::Math::SVectorWithError<D,T>                       DataWithError ;
+      /// the (lower triangular) Cholesky factor of the covariance matrix 
+      typedef  ROOT::Math::SMatrix<T,D,D>                               Factor        ;
+      /// the rank-1 components of the covariance matrix 
+      typedef  std::vector<Data>                                        Factors       ;
       // ============================================================================
     public:
       // =======================================================================
@@ -76,7 +97,7 @@ namespace  Ostap
         : m_data ( data ) 
         , m_cov2 ( cov2 ) 
         , m_w    () 
-      { m_w = this->getWeights() ; }
+      { this->init () ; }
       // ======================================================================
       // constructor from the vector of data and cov matrices 
       Combine ( const Data&       data , 
@@ -85,7 +106,7 @@ namespace  Ostap
         : m_data ( data ) 
         , m_cov2 ( cov1 + cov2  ) 
         , m_w    () 
-      { m_w = this->getWeights() ; }
+      { this->init () ; }
       // ======================================================================
       // constructor from the vector of data and cov matrices 
       Combine ( const Data&       data , 
@@ -95,7 +116,7 @@ namespace  Ostap
         : m_data ( data ) 
         , m_cov2 ( cov1 + cov2 + cov3 ) 
         , m_w    () 
-      { m_w = this->getWeights() ; }
+      { this->init () ; }
       // ======================================================================
       // constructor from the vector of data and cov matrices 
       Combine ( const Data&       data , 
@@ -106,14 +127,14 @@ namespace  Ostap
         : m_data ( data ) 
         , m_cov2 ( cov1 + cov2 + cov3 + cov4 ) 
         , m_w    () 
-      { m_w = this->getWeights() ; }
+      { this->init () ; }
       // ======================================================================
       // constructor from the data
       Combine ( const DataWithError& data ) 
         : m_data ( data.value() ) 
         , m_cov2 ( data.cov2 () ) 
         , m_w    () 
-      { m_w = this->getWeights() ; }
+      { this->init () ; }
       // ======================================================================
       // constructor from the vector of data and cov matrix 
       Combine ( const std::array<double,D>& data , 
@@ -121,13 +142,20 @@ namespace  Ostap
         : m_data ( data.begin() , data.end ()  ) 
         , m_cov2 ( cov2 ) 
         , m_w    () 
-      { m_w = this->getWeights() ; }
+      { this->init () ; }
       // ======================================================================
     public:
       // ======================================================================
       /// calculate weights
       Data getWeights() const 
       {
+        // use the Cholesky factor: two triangular solutions 
+        if ( m_cholesky ) 
+        {
+          Data u = this->units () ;
+          this->solve ( u ) ;
+          return u / ROOT::Math::Dot ( u , this->units () ) ;
+        }
         // the inverse covariance matrix 
         Covariance vxi ;
         if ( Ostap::Math::inverse ( m_cov2 , vxi ) ) 
@@ -173,6 +201,174 @@ namespace  Ostap
       /// get the calculated weights
       const Data& weights() const { return m_w ; }
       // ======================================================================
+    public: // repeated combinations 
+      // ======================================================================
+      /// combine other data with the same covariance matrix and weights 
+      Ostap::Math::ValueWithError result ( const Data& data ) const 
+      { 
+        const double r  = ROOT::Math::Dot        ( data   , m_w ) ;
+        const double e2 = ROOT::Math::Similarity ( m_cov2 , m_w ) ;
+        return Ostap::Math::ValueWithError ( r , e2 ) ;
+      }
+      /// set new data: the weights do not depend on data and are not recalculated 
+      void setData ( const Data& data ) { m_data = data ; }
+      /// set new covariance matrix: full factorization 
+      void setCovariance ( const Covariance& cov2 ) 
+      { m_cov2 = cov2 ; this->init () ; }
+      // ======================================================================
+      /** rank-1 update of the covariance matrix 
+       *  \f$ V \rightarrow V + \alpha s s^T \f$, 
+       *  the Cholesky factor is updated (\f$\alpha>0\f$) or downdated 
+       *  (\f$\alpha<0\f$), and weights are recalculated in 
+       *  \f$ O(D^2) \f$ operations. If the updated matrix is not positive 
+       *  definite, the combination is redone from the scratch  
+       *  @param s     the vector 
+       *  @param alpha the scale factor 
+       */
+      void update ( const Data& s , const T alpha = 1 ) 
+      {
+        if ( 0 == alpha ) { return ; }
+        for ( unsigned int i = 0 ; i < D ; ++i ) 
+        { for ( unsigned int j = 0 ; j <= i ; ++j ) { m_cov2 ( i , j ) += alpha * s [ i ] * s [ j ] ; } }
+        //
+        if ( m_cholesky && this->update_factor ( s , alpha ) ) { m_w = this->getWeights () ; }
+        else { this->init () ; }
+      }
+      /** rank-k update of the covariance matrix 
+       *  \f$ V \rightarrow V + \alpha \sum_i s_i s^T_i \f$ 
+       *  @see Ostap::Math::Combine::factors 
+       *  @param vs    the vectors
+       *  @param alpha the scale factor 
+       */
+      void update ( const Factors& vs , const T alpha = 1 ) 
+      {
+        if ( 0 == alpha || vs.empty () ) { return ; }
+        bool ok = m_cholesky ;
+        for ( const Data& s : vs ) 
+        {
+          for ( unsigned int i = 0 ; i < D ; ++i ) 
+          { for ( unsigned int j = 0 ; j <= i ; ++j ) { m_cov2 ( i , j ) += alpha * s [ i ] * s [ j ] ; } }
+          ok = ok && this->update_factor ( s , alpha ) ;
+        }
+        if ( ok ) { m_w = this->getWeights () ; }
+        else      { this->init () ; }
+      }
+      // ======================================================================
+      /** decompose the positive semi-definite matrix into the sum 
+       *  of rank-1 terms: \f$ C = \sum_i s_i s^T_i \f$ (Cholesky with 
+       *  diagonal pivoting), e.g. for subsequent rank-k updates:
+       *  the fully correlated component gives just one vector 
+       *  @param c   the covariance matrix 
+       *  @param eps the relative threshold for the residual diagonal elements 
+       */
+      static Factors factors ( const Covariance& c , const T eps = 1.e-12 ) 
+      {
+        Factors result ;
+        Data    d ;
+        T       dmax = 0 ;
+        for ( unsigned int i = 0 ; i < D ; ++i ) 
+        { d [ i ] = c ( i , i ) ; dmax = std::max ( dmax , d [ i ] ) ; }
+        if ( !( 0 < dmax ) ) { return result ; }
+        //
+        for ( unsigned int k = 0 ; k < D ; ++k ) 
+        {
+          unsigned int p = 0 ;
+          for ( unsigned int i = 1 ; i < D ; ++i ) { if ( d [ p ] < d [ i ] ) { p = i ; } }
+          if ( d [ p ] <= eps * dmax ) { break ; }
+          //
+          const T lp = std::sqrt ( d [ p ] ) ;
+          Data    s  ;
+          for ( unsigned int i = 0 ; i < D ; ++i ) 
+          {
+            T v = c ( i , p ) ;
+            for ( const Data& r : result ) { v -= r [ i ] * r [ p ] ; }
+            s [ i ] = v / lp ;
+          }
+          s [ p ] = lp ;
+          for ( unsigned int i = 0 ; i < D ; ++i ) 
+          { d [ i ] = d [ i ] - s [ i ] * s [ i ] ; }
+          d [ p ] = 0 ;
+          result.push_back ( s ) ;
+        }
+        return result ;
+      }
+      // ======================================================================
+    public: 
+      // ======================================================================
+      /// input data 
+      const Data&       data       () const { return m_data     ; }
+      /// overall covariance matrix 
+      const Covariance& covariance () const { return m_cov2     ; }
+      /// the Cholesky factor is used for weights?
+      bool              cholesky   () const { return m_cholesky ; }
+      /// the lower triangular Cholesky factor of the covariance matrix 
+      const Factor&     factor     () const { return m_L        ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// factorize the covariance matrix and calculate the weights  
+      void init () 
+      {
+        m_cholesky = this->decompose () ;
+        m_w        = this->getWeights () ;
+      }
+      /// Cholesky decomposition of the covariance matrix 
+      bool decompose () 
+      {
+        m_L = Factor () ;
+        for ( unsigned int j = 0 ; j < D ; ++j ) 
+        {
+          T d = m_cov2 ( j , j ) ;
+          for ( unsigned int k = 0 ; k < j ; ++k ) { d -= m_L ( j , k ) * m_L ( j , k ) ; }
+          if ( !( 0 < d ) || !std::isfinite ( d ) ) { return false ; }
+          const T l = std::sqrt ( d ) ;
+          m_L ( j , j ) = l ;
+          for ( unsigned int i = j + 1 ; i < D ; ++i ) 
+          {
+            T v = m_cov2 ( i , j ) ;
+            for ( unsigned int k = 0 ; k < j ; ++k ) { v -= m_L ( i , k ) * m_L ( j , k ) ; }
+            m_L ( i , j ) = v / l ;
+          }
+        }
+        return true ;
+      }
+      /// rank-1 update/downdate of the Cholesky factor: L L^T + alpha s s^T 
+      bool update_factor ( const Data& s , const T alpha ) 
+      {
+        const T sign = 0 < alpha ? 1 : -1 ;
+        Data    w    = s * std::sqrt ( std::abs ( alpha ) ) ;
+        for ( unsigned int k = 0 ; k < D ; ++k ) 
+        {
+          const T lkk = m_L ( k , k ) ;
+          const T r2  = lkk * lkk + sign * w [ k ] * w [ k ] ;
+          if ( !( 0 < r2 ) || !std::isfinite ( r2 ) ) { return false ; }
+          const T r   = std::sqrt ( r2 ) ;
+          const T c   = r      / lkk ;
+          const T sn  = w [ k ] / lkk ;
+          m_L ( k , k ) = r ;
+          for ( unsigned int i = k + 1 ; i < D ; ++i ) 
+          {
+            m_L ( i , k ) = ( m_L ( i , k ) + sign * sn * w [ i ] ) / c ;
+            w   [ i ]     = c * w [ i ] - sn * m_L ( i , k ) ;
+          }
+        }
+        return true ;
+      }
+      /// solve \f$ L L^T x = b \f$ in-place 
+      void solve ( Data& x ) const 
+      {
+        for ( unsigned int i = 0 ; i < D ; ++i ) 
+        {
+          for ( unsigned int k = 0 ; k < i ; ++k ) { x [ i ] -= m_L ( i , k ) * x [ k ] ; }
+          x [ i ] /= m_L ( i , i ) ;
+        }
+        for ( unsigned int i = D ; 0 < i-- ; ) 
+        {
+          for ( unsigned int k = i + 1 ; k < D ; ++k ) { x [ i ] -= m_L ( k , i ) * x [ k ] ; }
+          x [ i ] /= m_L ( i , i ) ;
+        }
+      }
+      // ======================================================================
     private:
       // ======================================================================
       /// get vector of units 
@@ -194,6 +390,10 @@ namespace  Ostap
       // ======================================================================
       /// weights 
       Data m_w            ; // weights 
+      /// the Cholesky factor of the covariance matrix 
+      Factor m_L         {       } ; // the Cholesky factor 
+      /// is the Cholesky factor valid? 
+      bool   m_cholesky  { false } ; // is the Cholesky factor valid?
       // ======================================================================
     } ;  
     // ========================================================================
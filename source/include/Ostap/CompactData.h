@@ -0,0 +1,207 @@
+// ============================================================================
+#ifndef OSTAP_COMPACTDATA_H
+#define OSTAP_COMPACTDATA_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <limits>
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class TTree      ; // from ROOT
+class RooAbsData ; // from RooFit
+// ============================================================================
+/** @file Ostap/CompactData.h
+ *  Compact columnar storage of the unbinned data
+ *  @see Ostap::Utils::CompactData
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class CompactData Ostap/CompactData.h
+     *  Compact columnar storage of the unbinned data
+     *  - the real observables are kept in the contiguous arrays,
+     *    in single precision by default (the precision is configurable per column)
+     *  - the categories are kept as bit-packed state numbers
+     *  - the weights (if any) are kept in single precision
+     *  - the batch interface converts the values to double precision on the fly
+     *
+     *  It requires ~2 times less memory than <code>RooVectorDataStore</code>
+     *  for the real observables and no per-event bookkeeping,
+     *  and it can be filled directly from the TTree without
+     *  the intermediate <code>RooDataSet</code>.
+     *
+     *  @code
+     *  TChain* chain = ... ;
+     *  CompactData data ( chain , { "mass" , "pt" } , { "M/1000" , "PT/1000" } , "chi2<10" ) ;
+     *  std::vector<double> buffer ( 10000 ) ;
+     *  data.values ( data.column ( "mass" ) , 0 , buffer.size () , buffer.data () ) ;
+     *  @endcode
+     *  @see Ostap::MoreRooFit::ParallelNLL
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class CompactData
+    {
+    public:
+      // ======================================================================
+      /** constructor from the RooFit dataset
+       *  @param data    the dataset
+       *  @param doubles the names of the columns to be kept in double precision
+       */
+      CompactData
+      ( const RooAbsData&               data         ,
+        const std::vector<std::string>& doubles = {} ) ;
+      // ======================================================================
+      /** constructor from TTree/TChain
+       *  - the columns are read in a single pass (per precision)
+       *  @see Ostap::Utils::read_columns
+       *  @param tree        the tree/chain
+       *  @param names       the names of the columns
+       *  @param expressions the expressions for the columns
+       *  @param selection   the selection
+       *  @param weight      the expression for the weight (if any)
+       *  @param doubles     the names of the columns to be kept in double precision
+       *  @param nthreads    number of threads
+       *  @param first       the first entry to process
+       *  @param last        the last entry to process
+       */
+      CompactData
+      ( TTree*                          tree             ,
+        const std::vector<std::string>& names            ,
+        const std::vector<std::string>& expressions      ,
+        const std::string&              selection   = "" ,
+        const std::string&              weight      = "" ,
+        const std::vector<std::string>& doubles     = {} ,
+        const unsigned int              nthreads    = 1  ,
+        const unsigned long             first       = 0  ,
+        const unsigned long             last        = std::numeric_limits<unsigned long>::max() ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of entries
+      std::size_t size        () const { return m_size             ; }
+      /// number of real columns
+      std::size_t nColumns    () const { return m_columns.size ()  ; }
+      /// number of categories
+      std::size_t nCategories () const { return m_cats.size ()     ; }
+      /// weighted data?
+      bool        weighted    () const { return !m_weights.empty () ; }
+      /// sum of weights
+      double      sumw        () const { return m_sumw             ; }
+      /// memory used by the data (bytes)
+      std::size_t memory      () const ;
+      // ======================================================================
+      /// the name of the real column
+      const std::string& name     ( const std::size_t column ) const ;
+      /// the name of the category
+      const std::string& catName  ( const std::size_t icat   ) const ;
+      /// is the column kept in single precision?
+      bool               isFloat  ( const std::size_t column ) const ;
+      /// the index of real column (or <code>nColumns()</code> if not found)
+      std::size_t        column   ( const std::string& name  ) const ;
+      /// the index of category (or <code>nCategories()</code> if not found)
+      std::size_t        category ( const std::string& name  ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the value for the given column and entry
+      double value  ( const std::size_t column , const std::size_t entry ) const
+      {
+        const Column& c = m_columns [ column ] ;
+        return c.single ? double ( c.floats [ entry ] ) : c.doubles [ entry ] ;
+      }
+      /// the weight for the given entry
+      double weight ( const std::size_t entry ) const
+      { return m_weights.empty () ? 1.0 : double ( m_weights [ entry ] ) ; }
+      // ======================================================================
+      /** get the batch of values (converted to double precision)
+       *  @param column the column
+       *  @param first  the first entry
+       *  @param n      number of entries
+       *  @param result (OUTPUT) the values
+       *  @return number of copied values
+       */
+      std::size_t values
+      ( const std::size_t column ,
+        const std::size_t first  ,
+        const std::size_t n      ,
+        double*           result ) const ;
+      /** get the batch of weights
+       *  @param first  the first entry
+       *  @param n      number of entries
+       *  @param result (OUTPUT) the weights
+       *  @return number of copied values
+       */
+      std::size_t weights
+      ( const std::size_t first  ,
+        const std::size_t n      ,
+        double*           result ) const ;
+      // ======================================================================
+      /// the state number of the category for the given entry
+      unsigned int state ( const std::size_t icat , const std::size_t entry ) const ;
+      /// the category label for the given entry
+      const std::string& label ( const std::size_t icat , const std::size_t entry ) const ;
+      /// the category index for the given entry
+      int                index ( const std::size_t icat , const std::size_t entry ) const ;
+      /// all labels of the category (in the order of states)
+      const std::vector<std::string>& labels ( const std::size_t icat ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the real column
+      struct Column
+      {
+        std::string         name    {}       ;
+        bool                single  { true } ;
+        std::vector<float>  floats  {}       ;
+        std::vector<double> doubles {}       ;
+      } ;
+      /// the bit-packed category
+      struct Category
+      {
+        std::string                name    {}    ;
+        std::vector<std::string>   labels  {}    ;
+        std::vector<int>           indices {}    ;
+        /// number of bits per entry
+        unsigned int               bits    { 1 } ;
+        std::vector<std::uint64_t> packed  {}    ;
+      } ;
+      // ======================================================================
+      /// pack the state numbers of the category
+      static void pack ( Category& cat , const std::vector<unsigned int>& states ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// number of entries
+      std::size_t           m_size    { 0 } ;
+      /// the real columns
+      std::vector<Column>   m_columns {}    ;
+      /// the categories
+      std::vector<Category> m_cats    {}    ;
+      /// the weights
+      std::vector<float>    m_weights {}    ;
+      /// the sum of weights
+      double                m_sumw    { 0 } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // OSTAP_COMPACTDATA_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
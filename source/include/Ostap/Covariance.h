@@ -0,0 +1,297 @@
+// ============================================================================
+#ifndef OSTAP_COVARIANCE_H
+#define OSTAP_COVARIANCE_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <cstddef>
+#include <vector>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/WStatEntity.h"
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class Covariance  Ostap/Covariance.h
+     *  Simple (single-pass) counter for the weighted covariance
+     *  of two variables
+     *  \f[ \mathrm{cov} ( x , y ) \equiv \frac{1}{\sum w_i}
+     *    \sum_i w_i \left( x_i - \bar{x} \right)\left( y_i - \bar{y} \right) \f]
+     *  The counters can be merged, e.g. for parallel processing
+     *  @see  Pebay, P., Terriberry, T.B., Kolla, H. et al.
+     *        "Numerically stable, scalable formulas for parallel and online
+     *        computation of higher-order multivariate central moments with
+     *        arbitrary weights". Comput Stat 31, 1305–1325 (2016).
+     *  @see https://doi.org/10.1007/s00180-015-0637-z
+     *  @see Ostap::WStatEntity
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date   2023-01-23
+     */
+    class Covariance
+    {
+    public:
+      // ======================================================================
+      /// empty constructor
+      Covariance () = default ;
+      /** full constructor (e.g. for serialization)
+       *  @param cnt1 statistic of the first variable
+       *  @param cnt2 statistic of the second variable
+       *  @param cov  the weighted covariance
+       */
+      Covariance
+      ( const Ostap::WStatEntity& cnt1 ,
+        const Ostap::WStatEntity& cnt2 ,
+        const double              cov  ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// total number of entries
+      unsigned long long n           () const { return m_cnt1.n    () ; }
+      /// sum of weights
+      double             sumw        () const { return m_cnt1.sumw () ; }
+      /// statistic for the first variable
+      const Ostap::WStatEntity& counter1 () const { return m_cnt1 ; }
+      /// statistic for the second variable
+      const Ostap::WStatEntity& counter2 () const { return m_cnt2 ; }
+      /// the weighted covariance
+      double             covariance  () const { return m_cov ; }
+      /// the weighted correlation coefficient
+      double             correlation () const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// add the pair of values with the weight
+      Covariance& add ( const double x , const double y , const double w = 1 ) ;
+      /// add other counter
+      Covariance& add ( const Covariance& other ) ;
+      /// add other counter
+      Covariance& operator+= ( const Covariance& other ) { return add ( other ) ; }
+      /// reset the counter
+      void reset () ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// statistic of the first variable
+      Ostap::WStatEntity m_cnt1 {} ; // statistic of the first variable
+      /// statistic of the second variable
+      Ostap::WStatEntity m_cnt2 {} ; // statistic of the second variable
+      /// the weighted covariance
+      double             m_cov  { 0 } ; // the weighted covariance
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /// add two counters
+    inline Covariance operator+ ( Covariance a , const Covariance& b )
+    { a += b ; return a ; }
+    // ========================================================================
+    /** @class Covariances  Ostap/Covariance.h
+     *  Single-pass, mergeable counter for the weighted covariances
+     *  of N variables
+     *  \f[ C_{ij} \equiv \frac{1}{\sum w_k}
+     *    \sum_k w_k \left( x^i_k - \bar{x}^i \right)\left( x^j_k - \bar{x}^j \right) \f]
+     *  - the counters are updated using the numerically stable
+     *    (Welford-like) formulae, the statistic of each variable has
+     *    the semantics of <code>Ostap::WStatEntity</code>
+     *  - the batches of entries are processed in blocks with the
+     *    simple (vectorizable) loops and then merged
+     *  - the counters can be merged, e.g. for parallel processing
+     *  The covariance matrix is stored in packed form for the lower triangle:
+     *  \f$ C_{ij} \f$ for \f$ j\le i \f$ is stored at the index \f$ i(i+1)/2+j\f$
+     *  @code
+     *  Ostap::Math::Covariances cnt ( 3 ) ;
+     *  const double x [] = { 1 , 2 , 3 } ;
+     *  cnt.add ( x , 0.5 ) ;
+     *  ...
+     *  std::vector<double> D = cnt.decorrelation () ;
+     *  @endcode
+     *  @see Ostap::Math::Covariance
+     *  @see Pebay, P., Terriberry, T.B., Kolla, H. et al.
+     *        "Numerically stable, scalable formulas for parallel and online
+     *        computation of higher-order multivariate central moments with
+     *        arbitrary weights". Comput Stat 31, 1305–1325 (2016).
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date   2026-10-15
+     */
+    class Covariances
+    {
+    public:
+      // ======================================================================
+      /// constructor for N variables
+      Covariances ( const unsigned short N = 2 ) ;
+      /** full constructor (e.g. for serialization)
+       *  @param counters statistics of the variables
+       *  @param cov2     the packed weighted covariance matrix
+       */
+      Covariances
+      ( const std::vector<Ostap::WStatEntity>& counters ,
+        const std::vector<double>&             cov2     ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of variables
+      unsigned short     size        () const { return m_cnts.size () ; }
+      /// total number of entries
+      unsigned long long n           () const
+      { return m_cnts.empty () ? 0 : m_cnts.front ().n    () ; }
+      /// sum of weights
+      double             sumw        () const
+      { return m_cnts.empty () ? 0 : m_cnts.front ().sumw () ; }
+      /// effective number of entries
+      double             nEff        () const
+      { return m_cnts.empty () ? 0 : m_cnts.front ().nEff () ; }
+      /// statistic for the i-th variable
+      const Ostap::WStatEntity& counter ( const unsigned short i ) const ;
+      /// statistics for all variables
+      const std::vector<Ostap::WStatEntity>& counters () const { return m_cnts ; }
+      /// the weighted mean of the i-th variable
+      double             mean        ( const unsigned short i ) const
+      { return counter ( i ).mu () ; }
+      /// the weighted covariance
+      double             covariance  ( const unsigned short i ,
+                                       const unsigned short j ) const ;
+      /// the weighted correlation coefficient
+      double             correlation ( const unsigned short i ,
+                                       const unsigned short j ) const ;
+      /// the packed covariance matrix
+      const std::vector<double>& cov2 () const { return m_cov ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// add the entry (N values) with the weight
+      Covariances& add ( const double* x , const double w = 1 ) ;
+      /// add the entry (N values) with the weight
+      Covariances& add ( const std::vector<double>& x , const double w = 1 ) ;
+      /** add the batch of entries
+       *  @param n       (INPUT) number of entries
+       *  @param rows    (INPUT) the values, stored row-wise (n*N values)
+       *  @param weights (INPUT) the weights, nullptr for unit weights
+       */
+      Covariances& add
+      ( const std::size_t n                 ,
+        const double*     rows              ,
+        const double*     weights = nullptr ) ;
+      /// add other counter
+      Covariances& add ( const Covariances& other ) ;
+      /// add other counter
+      Covariances& operator+= ( const Covariances& other ) { return add ( other ) ; }
+      /// reset the counter
+      void reset () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** eigen decomposition of the covariance matrix
+       *  @param values  (OUTPUT) the eigenvalues in ascending order
+       *  @param vectors (OUTPUT) the eigenvectors, stored row-wise
+       */
+      void eigen
+      ( std::vector<double>& values  ,
+        std::vector<double>& vectors ) const ;
+      /** the decorrelation matrix \f$ D \f$ (stored row-wise):
+       *  the variables \f$ \mathbf{y} = D \left( \mathbf{x} - \bar{\mathbf{x}} \right) \f$
+       *  are uncorrelated and have unit variances.
+       *  The rows are the eigenvectors of the covariance matrix,
+       *  normalized to the square root of the eigenvalues
+       *  @see Ostap::Math::Covariances::eigen
+       */
+      std::vector<double> decorrelation () const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// index in the packed matrix
+      static inline std::size_t index
+      ( const unsigned short i ,
+        const unsigned short j )
+      { return i < j ? j * ( j + 1 ) / 2 + i : i * ( i + 1 ) / 2 + j ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /** fill the counter from the block of entries
+       *  @param m      (INPUT)  number of entries
+       *  @param cols   (UPDATE) the values, stored column-wise
+       *  @param stride (INPUT)  the stride between the columns
+       *  @param ws     (INPUT)  the weights
+       *  @return false if the block cannot be processed in this way
+       */
+      bool fill
+      ( const std::size_t m      ,
+        double*           cols   ,
+        const std::size_t stride ,
+        const double*     ws     ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// statistics of the variables
+      std::vector<Ostap::WStatEntity> m_cnts {} ; // statistics of the variables
+      /// the packed weighted covariance matrix
+      std::vector<double>             m_cov  {} ; // the packed covariance matrix
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /// add two counters
+    inline Covariances operator+ ( Covariances a , const Covariances& b )
+    { a += b ; return a ; }
+    // ========================================================================
+    /** @class CovariancesBuffer Ostap/Covariance.h
+     *  Helper class to feed Ostap::Math::Covariances in batches:
+     *  the entries are buffered and added to the counter in blocks,
+     *  e.g. for the per-thread/per-slot accumulation
+     *  @see Ostap::Math::Covariances
+     */
+    class CovariancesBuffer
+    {
+    public:
+      // ======================================================================
+      /// constructor for N variables
+      CovariancesBuffer ( const unsigned short N = 2 )
+        : m_counter ( N )
+      { m_rows.reserve ( N * s_SIZE ) ; m_weights.reserve ( s_SIZE ) ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// add the entry (N values) with the weight
+      void add ( const double* x , const double w = 1 )
+      {
+        m_rows   .insert    ( m_rows.end () , x , x + m_counter.size () ) ;
+        m_weights.push_back ( w ) ;
+        if ( s_SIZE <= m_weights.size () ) { flush () ; }
+      }
+      /// flush the buffer and get the counter
+      const Covariances& flush ()
+      {
+        if ( !m_weights.empty () )
+        {
+          m_counter.add ( m_weights.size () , m_rows.data () , m_weights.data () ) ;
+          m_rows   .clear () ;
+          m_weights.clear () ;
+        }
+        return m_counter ;
+      }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the counter
+      Covariances         m_counter {} ; // the counter
+      /// buffered entries (row-wise)
+      std::vector<double> m_rows    {} ; // buffered entries
+      /// buffered weights
+      std::vector<double> m_weights {} ; // buffered weights
+      /// the buffer size
+      static const std::size_t s_SIZE = 256 ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_COVARIANCE_H
+// ============================================================================
@@ -10,6 +10,7 @@
 #include <array>
 #include <utility>
 #include <functional>
+#include <cstddef>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -390,6 +391,35 @@ namespace Ostap
       ( const double s  ,
         const double s1 ) const ;
       // ======================================================================
+      /** Dalitz plot boundaries \f$ s_1^{min/max} ( s, s_2 ) \f$ for arrays of points
+       *  (the triangle functions are evaluated in the factorized forms
+       *  via the boundaries, free of cancellations near the edges)
+       *  @param n     (INPUT)  number of points
+       *  @param s     (INPUT)  values of \f$ s   \f$
+       *  @param s2    (INPUT)  values of \f$ s_2 \f$
+       *  @param s1min (OUTPUT) lower boundaries for \f$ s_1 \f$
+       *  @param s1max (OUTPUT) upper boundaries for \f$ s_1 \f$
+       *  @return number of points with valid boundaries
+       *  @see Ostap::Kinematics::Dalitz0::s1_minmax_for_s_s2
+       */
+      std::size_t s1_minmax_for_s_s2
+      ( const std::size_t n     ,
+        const double*     s     ,
+        const double*     s2    ,
+        double*           s1min ,
+        double*           s1max ) const ;
+      // ======================================================================
+      /** Dalitz plot boundaries \f$ s_2^{min/max} ( s, s_1 ) \f$ for arrays of points
+       *  @see Ostap::Kinematics::Dalitz0::s2_minmax_for_s_s1
+       *  @see Ostap::Kinematics::Dalitz0::s1_minmax_for_s_s2
+       */
+      std::size_t s2_minmax_for_s_s1
+      ( const std::size_t n     ,
+        const double*     s     ,
+        const double*     s1    ,
+        double*           s2min ,
+        double*           s2max ) const ;
+      // ======================================================================
     public: // some frequent functions 
       // ======================================================================
       /**  get the energies/momenta of particles in the rest-frame 
@@ -915,6 +945,61 @@ namespace Ostap
       std::pair<double,double>  s2_minmax_for_s1 ( const double s1 ) const 
       { return s2_minmax_for_s_s1 ( s () , s1 ) ; }
       // ======================================================================
+    public : // batch evaluation 
+      // ======================================================================
+      /** evaluate the Dalitz plot quantities for arrays of points in one pass 
+       *  - all mass-dependent constants are precalculated 
+       *  - the output arrays can be <code>nullptr</code>, if not needed
+       *  @param n        number of points 
+       *  @param s1       (INPUT)  values of \f$ s_1 \f$  
+       *  @param s2       (INPUT)  values of \f$ s_2 \f$  
+       *  @param inside   (OUTPUT) is the point inside the Dalitz plot? 
+       *  @param density  (OUTPUT) Dalitz plot density, @see Dalitz::density 
+       *  @param jacobian (OUTPUT) jacobian, @see Dalitz0::J 
+       *  @param cos12    (OUTPUT) \f$ \cos \theta^{*}_{12} \f$, @see Dalitz::cos_12 
+       *  @param cos23    (OUTPUT) \f$ \cos \theta^{*}_{23} \f$, @see Dalitz::cos_23 
+       *  @param cos31    (OUTPUT) \f$ \cos \theta^{*}_{31} \f$, @see Dalitz::cos_31 
+       *  @return number of points inside the Dalitz plot 
+       */
+      std::size_t evaluate 
+      ( const std::size_t n                  , 
+        const double*     s1                 , 
+        const double*     s2                 , 
+        bool*             inside             , 
+        double*           density  = nullptr , 
+        double*           jacobian = nullptr , 
+        double*           cos12    = nullptr , 
+        double*           cos23    = nullptr , 
+        double*           cos31    = nullptr ) const ;
+      // ======================================================================
+      /** Are the points \f$ (s_1,s_2)\f$ "inside" the Dalitz plot?
+       *  @param n        number of points 
+       *  @param s1       (INPUT)  values of \f$ s_1 \f$  
+       *  @param s2       (INPUT)  values of \f$ s_2 \f$  
+       *  @param result   (OUTPUT) flags  
+       *  @return number of points inside the Dalitz plot 
+       */
+      std::size_t inside 
+      ( const std::size_t n      , 
+        const double*     s1     , 
+        const double*     s2     , 
+        bool*             result ) const 
+      { return evaluate ( n , s1 , s2 , result ) ; }
+      // ======================================================================
+      /** Dalitz plot density for the arrays of points 
+       *  @param n        number of points 
+       *  @param s1       (INPUT)  values of \f$ s_1 \f$  
+       *  @param s2       (INPUT)  values of \f$ s_2 \f$  
+       *  @param result   (OUTPUT) density 
+       *  @return number of points inside the Dalitz plot 
+       */
+      std::size_t density 
+      ( const std::size_t n      , 
+        const double*     s1     , 
+        const double*     s2     , 
+        double*           result ) const 
+      { return evaluate ( n , s1 , s2 , nullptr , result ) ; }
+      // ======================================================================
     public:
       // ======================================================================
       /// get the tag/hash value  
@@ -927,6 +1012,8 @@ namespace Ostap
       /// the precalcualted quantities 
       // std::array<double,8> m_cache2 ;           // the precalcualted quantities
       double m_cache2 [8] ;                     // the precalcualted quantities
+      /// the precalculated quantities for the batch evaluation 
+      double m_cache3 [9]  ;    // the precalculated quantities for batch evaluation
       /// tag/hash value
       std::size_t          m_tag2   ;                         // tag/hash value
       // ======================================================================      
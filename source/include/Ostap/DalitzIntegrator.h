@@ -7,6 +7,7 @@
 //  STD&STL
 // ============================================================================
 #include  <functional>
+#include  <vector>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -408,6 +409,147 @@ namespace Ostap
       // ======================================================================
     };
     // ========================================================================
+    /** @class DalitzRule DalitzIntegrator.h Ostap/DalitzIntegrator.h
+     *  Precomputed integration rule for the Dalitz plot with fixed 
+     *  \f$ s = M^2 \f$: the tensor product of Gauss-Legendre rules for 
+     *  variables \f$(x_1,x_2)\f$ is mapped (once) onto the 
+     *  \f$ (s_1,s_2)\f$-plane and the jacobian is absorbed into the weights.
+     *  Each subsequent integration is just a weighted sum: 
+     *  \f[ \int\int ds_1 ds_2 f(s_1,s_2) \approx \sum_i w_i f(s_{1,i},s_{2,i}) \f]
+     *  It is useful for the normalization integrals in the (amplitude) fits, 
+     *  where the Dalitz configuration is fixed and only the integrand changes.
+     *  @code
+     *  Dalitz d = ... ;
+     *  DalitzRule rule ( d , 128 , 128 ) ;
+     *  double I1 = rule.integrate      ( f ) ; // f(s1,s2) 
+     *  double I2 = rule.integrate_e2e3 ( g ) ; // g(e2,e3)
+     *  // explicit evaluation at the nodes, e.g. via array interface 
+     *  std::vector<double> v ( rule.size() ) ; 
+     *  fun.evaluate ( rule.size() , rule.s1().data() , rule.s2().data() , v.data() ) ;
+     *  double I3 = rule.sum ( v.data () ) ;
+     *  @endcode
+     *  @see Ostap::Math::DalitzIntegrator::integrate_s1s2
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2023-01-30
+     */
+    class DalitzRule 
+    {
+    public: 
+      // ======================================================================
+      typedef DalitzIntegrator::function2 function2 ;
+      typedef DalitzIntegrator::function3 function3 ;
+      // ======================================================================
+    public: 
+      // ======================================================================
+      /** constructor from Dalitz configuration and \f$ s \f$ 
+       *  @param d  Dalitz configuration 
+       *  @param s  \f$ s = M^2 \f$ 
+       *  @param n1 number of Gauss-Legendre points for \f$ x_1 \f$ 
+       *  @param n2 number of Gauss-Legendre points for \f$ x_2 \f$ 
+       */
+      DalitzRule 
+      ( const Ostap::Kinematics::Dalitz0& d       , 
+        const double                      s       ,
+        const unsigned short              n1 = 64 , 
+        const unsigned short              n2 = 64 ) ;
+      // ======================================================================
+      /** constructor from Dalitz configuration 
+       *  The nodes in variables \f$ (e_2,e_3) \f$ are also precomputed 
+       *  @param d  Dalitz configuration 
+       *  @param n1 number of Gauss-Legendre points for \f$ x_1 \f$ 
+       *  @param n2 number of Gauss-Legendre points for \f$ x_2 \f$ 
+       */
+      DalitzRule 
+      ( const Ostap::Kinematics::Dalitz&  d       , 
+        const unsigned short              n1 = 64 , 
+        const unsigned short              n2 = 64 ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// \f$ s = M^2 \f$ 
+      double             s       () const { return m_s  ; }
+      /// number of Gauss-Legendre points for \f$ x_1 \f$ 
+      unsigned short     n1      () const { return m_n1 ; }
+      /// number of Gauss-Legendre points for \f$ x_2 \f$ 
+      unsigned short     n2      () const { return m_n2 ; }
+      /// number of (non-trivial) nodes
+      std::size_t        size    () const { return m_w.size () ; }
+      /// the nodes: \f$ s_1 \f$ 
+      const std::vector<double>& s1      () const { return m_s1 ; }
+      /// the nodes: \f$ s_2 \f$ 
+      const std::vector<double>& s2      () const { return m_s2 ; }
+      /// the nodes: \f$ e_2 \f$ (only for the rule from Dalitz)
+      const std::vector<double>& e2      () const { return m_e2 ; }
+      /// the nodes: \f$ e_3 \f$ (only for the rule from Dalitz)
+      const std::vector<double>& e3      () const { return m_e3 ; }
+      /// the weights (including the jacobian)
+      const std::vector<double>& weights () const { return m_w  ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** weighted sum of the function values at the nodes 
+       *  @param values array of the function values (length is <code>size()</code>)
+       */
+      double sum ( const double* values ) const ;
+      // ======================================================================
+      /** integrate the function \f$ f(s_1,s_2) \f$ over the Dalitz plot 
+       *  @param f2       the function \f$ f(s_1,s_2) \f$ 
+       *  @param nthreads number of threads (the function must be thread-safe!)
+       */
+      double integrate 
+      ( function2          f2           , 
+        const unsigned int nthreads = 1 ) const ;
+      // ======================================================================
+      /** integrate the function \f$ f(s,s_1,s_2) \f$ over the Dalitz plot 
+       *  @param f3       the function \f$ f(s,s_1,s_2) \f$ 
+       *  @param nthreads number of threads (the function must be thread-safe!)
+       */
+      double integrate 
+      ( function3          f3           , 
+        const unsigned int nthreads = 1 ) const ;
+      // ======================================================================
+      /** integrate the function \f$ f(e_2,e_3) \f$ over the Dalitz plot 
+       *  (only for the rule from Dalitz)
+       *  @param f2       the function \f$ f(e_2,e_3) \f$ 
+       *  @param nthreads number of threads (the function must be thread-safe!)
+       *  @see Ostap::Math::DalitzIntegrator::integrate_e2e3
+       */
+      double integrate_e2e3
+      ( function2          f2           , 
+        const unsigned int nthreads = 1 ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// build the rule 
+      void build ( const Ostap::Kinematics::Dalitz0& d ) ;
+      /// weighted sum of the function values 
+      double wsum 
+      ( const std::vector<double>& x1       , 
+        const std::vector<double>& x2       , 
+        function2                  f2       , 
+        const unsigned int         nthreads ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// \f$ s = M^2 \f$ 
+      double              m_s  { 0  } ;
+      /// number of Gauss-Legendre points for \f$ x_1 \f$ 
+      unsigned short      m_n1 { 64 } ;
+      /// number of Gauss-Legendre points for \f$ x_2 \f$ 
+      unsigned short      m_n2 { 64 } ;
+      /// the nodes: \f$ s_1 \f$ 
+      std::vector<double> m_s1 {} ;
+      /// the nodes: \f$ s_2 \f$ 
+      std::vector<double> m_s2 {} ;
+      /// the nodes: \f$ e_2 \f$ 
+      std::vector<double> m_e2 {} ;
+      /// the nodes: \f$ e_3 \f$ 
+      std::vector<double> m_e3 {} ;
+      /// the weights 
+      std::vector<double> m_w  {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
   } //                                         The end of namespace Ostap::Math 
   // ==========================================================================
 } //                                                 The end of namespace Ostap
@@ -0,0 +1,170 @@
+// ============================================================================
+#ifndef OSTAP_DATACHUNKS_H
+#define OSTAP_DATACHUNKS_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <string>
+#include <vector>
+#include <utility>
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class RooArgSet  ; // from RooFit
+class RooAbsData ; // from RooFit
+class RooDataSet ; // from RooFit
+// ============================================================================
+/** @file Ostap/DataChunks.h
+ *  Composite (chunked) view of the partial datasets, e.g. produced
+ *  by the parallel workers, and the one-shot concatenation
+ *  @see Ostap::Utils::DataChunks
+ *  @see ostap/parallel/parallel_fill.py
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class DataChunks Ostap/DataChunks.h
+     *  Composite (chunked) view of the partial datasets:
+     *  - the partial datasets are referenced, not copied
+     *  - the unified event index over all chunks
+     *  - the batch spans of the column stores (one span per chunk)
+     *  - the one-shot concatenation with the exact preallocation
+     *    of the final store, if the materialization is needed
+     *  @code
+     *  DataChunks chunks ;
+     *  for ( const RooAbsData* ds : partial ) { chunks.add ( ds ) ; }
+     *  const RooArgSet* row  = chunks.get ( 12345 ) ;
+     *  const double     w    = chunks.weight () ;
+     *  RooDataSet*      data = chunks.concatenate ( "data" ) ;
+     *  @endcode
+     *  @attention the partial datasets must outlive the view
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class DataChunks
+    {
+    public:
+      // ======================================================================
+      /// the contiguous batch of values: (pointer, size)
+      typedef std::pair<const double*,std::size_t> Span  ;
+      /// the batch spans, one per chunk
+      typedef std::vector<Span>                    Spans ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// empty view
+      DataChunks () = default ;
+      /// view of the partial datasets
+      DataChunks ( const std::vector<const RooAbsData*>& chunks ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** add the partial dataset (no copy)
+       *  - the variables must be the same as for the first chunk
+       *  @return number of chunks
+       */
+      std::size_t add ( const RooAbsData* chunk ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// total number of entries
+      std::size_t       size      () const { return m_offsets.back ()    ; }
+      /// number of entries (alias)
+      std::size_t       numEntries() const { return size ()              ; }
+      /// number of chunks
+      std::size_t       nChunks   () const { return m_chunks.size ()     ; }
+      /// empty ?
+      bool              empty     () const { return 0 == size ()         ; }
+      /// weighted data?
+      bool              weighted  () const { return m_weighted           ; }
+      /// get the chunk
+      const RooAbsData* chunk     ( const std::size_t index ) const
+      { return index < m_chunks.size () ? m_chunks [ index ] : nullptr ; }
+      /// the first entry of the chunk in the unified index
+      std::size_t       offset    ( const std::size_t index ) const
+      { return m_offsets [ index ] ; }
+      // ======================================================================
+      /** locate the entry
+       *  @return (chunk, local entry), the chunk is
+       *          <code>nChunks()</code> for the invalid entry
+       */
+      std::pair<std::size_t,std::size_t> locate ( const std::size_t entry ) const ;
+      // ======================================================================
+      /** load the entry
+       *  @return the variables of the chunk (nullptr for invalid entry)
+       */
+      const RooArgSet* get    ( const std::size_t entry ) const ;
+      /// the weight of the last loaded entry
+      double           weight () const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** the batch spans for the variable
+       *  @return one span per chunk, the empty vector if the column
+       *          arrays are not available (not the vector store)
+       */
+      Spans spans   ( const std::string& name ) const ;
+      /** the batch spans for the weights
+       *  @return one span per chunk, the empty vector for the
+       *          non-weighted data or if the weights are not available
+       */
+      Spans weights () const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** materialize: the one-shot concatenation of the chunks
+       *  - the final store is preallocated exactly, no reallocations
+       *  @param name  the name of the new dataset
+       *  @param title the title of the new dataset
+       *  @return the new dataset (to be deleted by the caller)
+       */
+      RooDataSet* concatenate
+      ( const std::string& name  = "" ,
+        const std::string& title = "" ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the chunks
+      std::vector<const RooAbsData*> m_chunks   {}      ;
+      /// the offsets of the chunks: the unified index
+      std::vector<std::size_t>       m_offsets  { 0 }   ;
+      /// weighted?
+      bool                           m_weighted { false } ;
+      /// the last loaded chunk
+      mutable std::size_t            m_current  { 0 }   ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** one-shot concatenation of the partial datasets
+     *  - the final store is preallocated exactly, no reallocations
+     *  @code
+     *  std::vector<const RooAbsData*> partial = ... ;
+     *  RooDataSet* data = concatenate ( partial , "data" ) ;
+     *  @endcode
+     *  @param chunks the partial datasets
+     *  @param name   the name of the new dataset
+     *  @param title  the title of the new dataset
+     *  @return the new dataset (to be deleted by the caller)
+     *  @see Ostap::Utils::DataChunks
+     */
+    RooDataSet* concatenate
+    ( const std::vector<const RooAbsData*>& chunks     ,
+      const std::string&                    name  = "" ,
+      const std::string&                    title = "" ) ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_DATACHUNKS_H
+// ============================================================================
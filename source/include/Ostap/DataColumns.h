@@ -0,0 +1,250 @@
+// ============================================================================
+#ifndef OSTAP_DATACOLUMNS_H 
+#define OSTAP_DATACOLUMNS_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <string>
+#include <vector>
+#include <limits>
+#include <cstdint>
+// ============================================================================
+// Forward declarations 
+// ============================================================================
+class TTree      ; // from ROOT 
+class RooDataSet ; // from RooFit 
+class RooArgList ; // from RooFit 
+class RooAbsData ; // from RooFit 
+class TH1        ; // from ROOT 
+// ============================================================================
+/** @file Ostap/DataColumns.h
+ *  Helper functions for the columnar filling of datasets 
+ *  @see ostap/fitting/dataset.py 
+ *  @see ostap/parallel/parallel_fill.py 
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-01-30
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils 
+  {
+    // ========================================================================
+    /** fill the dataset from the contiguous columns 
+     *  - the values of the <code>i</code>-th variable for the entry 
+     *    <code>j</code> is <code>data [ i * n + j ]</code> 
+     *  - the optional weights are <code>weights [ j ]</code>
+     *  The arrays (e.g. memory-mapped numpy arrays) are read directly
+     *  without additional copies 
+     *  @code
+     *  RooDataSet& ds   = ... ;
+     *  RooArgList  vars = ... ;   // variables in the order of columns 
+     *  const double* data  = ... ;  
+     *  fill_dataset ( ds , vars , n , data ) ;
+     *  @endcode 
+     *  @param dataset (UPDATE) dataset to be filled 
+     *  @param vars    (INPUT)  the variables (RooRealVar) in the order of columns
+     *  @param n       (INPUT)  number of entries 
+     *  @param data    (INPUT)  the columns 
+     *  @param weights (INPUT)  the weights (if not null)
+     *  @return number of added entries 
+     */
+    unsigned long fill_dataset 
+    ( RooDataSet&         dataset           , 
+      const RooArgList&   vars              , 
+      const unsigned long n                 , 
+      const double*       data              , 
+      const double*       weights = nullptr ) ;
+    // ========================================================================
+    /** @struct FillStat 
+     *  Statistics of the dataset filling 
+     *  @see Ostap::Utils::fill_datasetMT
+     */
+    struct FillStat 
+    {
+      /// total number of processed entries 
+      unsigned long total     { 0 } ; // total number of entries
+      /// number of entries that pass the selection 
+      unsigned long processed { 0 } ; // number of entries after selection
+      /// number of entries, skipped due to the variable ranges 
+      unsigned long skipped   { 0 } ; // number of skipped entries 
+    } ;
+    // ========================================================================
+    /** fill the dataset from TTree/TChain using several threads
+     *  - the variables are calculated from the tree using <code>Ostap::Formula</code>
+     *  - entries outside the ranges of variables are skipped  
+     *  - the range of entries is split into chunks, aligned with the tree clusters, 
+     *    each chunk is processed by the own copy of the tree into the 
+     *    column buffer, and the buffers are appended to the dataset in the 
+     *    order of chunks (the order of entries is preserved)
+     *  For trees that are not read from files, it falls back to 
+     *  the sequential processing 
+     *  @code
+     *  TChain*     chain = ... ;
+     *  RooDataSet* data  = ... ;
+     *  RooArgList  vars  ( pt , eta ) ;
+     *  FillStat stat = fill_datasetMT ( chain , *data , vars , { "pt/1000" , "eta" } , "chi2<10" ) ;
+     *  @endcode 
+     *  @param tree        (INPUT)  the tree/chain 
+     *  @param dataset     (UPDATE) dataset to be filled 
+     *  @param vars        (INPUT)  the variables (RooRealVar) of the dataset 
+     *  @param expressions (INPUT)  expressions for the variables 
+     *  @param selection   (INPUT)  the selection 
+     *  @param nthreads    (INPUT)  number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @param first       (INPUT)  the first entry to process 
+     *  @param last        (INPUT)  the last entry to process 
+     *  @return statistics of the filling 
+     */
+    FillStat fill_datasetMT
+    ( TTree*                          tree             ,
+      RooDataSet&                     dataset          , 
+      const RooArgList&               vars             , 
+      const std::vector<std::string>& expressions      , 
+      const std::string&              selection   = "" , 
+      const unsigned int              nthreads    = 0  , 
+      const unsigned long             first       = 0  , 
+      const unsigned long             last        = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** read the columns from TTree/TChain in a single pass 
+     *  - any number of expressions are evaluated (using <code>Ostap::Formula</code>)
+     *    together with the selection in one loop over the entries
+     *  - the values are written directly into the preallocated buffer 
+     *    (e.g. numpy array): the value of the <code>i</code>-th expression 
+     *    for the accepted entry <code>j</code> is <code>data [ i * capacity + j ]</code>
+     *  - with several threads the range of entries is split into chunks, 
+     *    aligned with the tree clusters, and the order of entries is preserved 
+     *  @code
+     *  TChain* chain = ... ;
+     *  std::vector<double> data ( 3 * capacity ) ;
+     *  const unsigned long n = read_columns 
+     *    ( chain , { "pt" , "eta" , "phi" } , "chi2<10" , data.data() , capacity ) ;
+     *  @endcode 
+     *  @param tree        (INPUT)  the tree/chain 
+     *  @param expressions (INPUT)  expressions for the columns 
+     *  @param selection   (INPUT)  the selection 
+     *  @param data        (OUTPUT) the buffer of size <code>expressions.size()*capacity</code>
+     *  @param capacity    (INPUT)  maximal number of rows in the buffer 
+     *  @param first       (INPUT)  the first entry to process 
+     *  @param last        (INPUT)  the last entry to process 
+     *  @param nthreads    (INPUT)  number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @return number of rows written to the buffer 
+     *  @attention the exception is thrown if the number of 
+     *             accepted entries exceeds the capacity 
+     */
+    unsigned long read_columns
+    ( TTree*                          tree        ,
+      const std::vector<std::string>& expressions , 
+      const std::string&              selection   , 
+      double*                         data        , 
+      const unsigned long             capacity    , 
+      const unsigned long             first       = 0 , 
+      const unsigned long             last        = std::numeric_limits<unsigned long>::max() , 
+      const unsigned int              nthreads    = 1 ) ;
+    // ========================================================================
+    /** read the columns from TTree/TChain in a single pass 
+     *  (single precision output)
+     *  @see Ostap::Utils::read_columns 
+     */
+    unsigned long read_columns
+    ( TTree*                          tree        ,
+      const std::vector<std::string>& expressions , 
+      const std::string&              selection   , 
+      float*                          data        , 
+      const unsigned long             capacity    , 
+      const unsigned long             first       = 0 , 
+      const unsigned long             last        = std::numeric_limits<unsigned long>::max() , 
+      const unsigned int              nthreads    = 1 ) ;
+    // ========================================================================
+    /** split the data into the bins in a single pass 
+     *  - the bins are defined by the histogram (1D, 2D or 3D)
+     *  - the bin is defined by the values of the variables 
+     *    <code>xvar</code>, <code>yvar</code> and <code>zvar</code> from the data
+     *  - the entry for the bin <code>(ix,iy,iz)</code> 
+     *    (bin numbers start from 1, as in ROOT) is added into 
+     *    <code>bins [ ( ix - 1 ) + nx * ( ( iy - 1 ) + ny * ( iz - 1 ) ) ]</code> 
+     *  - entries in underflow/overflow bins are ignored 
+     *  - the weights and weight errors are propagated 
+     *  @code
+     *  RooDataSet* data = ... ;
+     *  TH2D binning = ... ;  // pt x eta 
+     *  std::vector<RooAbsData*> bins ( nx * ny ) ;
+     *  for ( auto& b : bins ) { b = data->emptyClone () ; }
+     *  split_dataset ( *data , bins , binning , "pt" , "eta" ) ;
+     *  @endcode
+     *  @param data    (INPUT)  the data 
+     *  @param bins    (UPDATE) the (empty) datasets for the bins 
+     *  @param binning (INPUT)  the binning histogram 
+     *  @param xvar    (INPUT)  the name of x-variable 
+     *  @param yvar    (INPUT)  the name of y-variable (for 2D and 3D binning) 
+     *  @param zvar    (INPUT)  the name of z-variable (for 3D binning) 
+     *  @return number of distributed entries 
+     */
+    unsigned long split_dataset 
+    ( const RooAbsData&               data      , 
+      const std::vector<RooAbsData*>& bins      , 
+      const TH1&                      binning   , 
+      const std::string&              xvar      , 
+      const std::string&              yvar = "" , 
+      const std::string&              zvar = "" ) ;
+    // ========================================================================
+    /** @struct UnweightStat 
+     *  Statistics of the accept/reject unweighting 
+     *  @see Ostap::Utils::accept_reject
+     */
+    struct UnweightStat 
+    {
+      /// total number of processed entries 
+      unsigned long total    { 0 } ; // total number of entries
+      /// number of accepted entries 
+      unsigned long accepted { 0 } ; // number of accepted entries 
+      /// number of (rejected) entries with negative weights 
+      unsigned long negative { 0 } ; // number of negative weights 
+      /// number of entries with weights above the maximal weight 
+      unsigned long overflow { 0 } ; // number of weights above maximum 
+      /// the maximal weight used for unweighting 
+      double        wmax     { 0 } ; // the maximal weight 
+    } ;
+    // ========================================================================
+    /** accept/reject (``hit-or-miss'') unweighting of the weighted dataset:
+     *  the entry with weight <code>w</code> is accepted with the 
+     *  probability <code>w/wmax</code> and added to the non-weighted dataset 
+     *  - the weights are taken directly from the column store of the dataset 
+     *    (if possible), the maximal weight is obtained by the single scan 
+     *    over the weight column (if not specified) 
+     *  - the entries are processed in blocks of fixed size, and each block 
+     *    uses its own counter-based random stream <code>(seed,block)</code>,
+     *    therefore the result does not depend on the number of threads 
+     *  - the accepted entries are added in the original order 
+     *  - the entries with negative weights are rejected, the entries 
+     *    with <code>w>wmax</code> are always accepted, both are counted 
+     *  @code
+     *  const RooDataSet* weighted   = ... ;
+     *  RooDataSet        unweighted ( "u" , "" , *weighted->get () ) ;
+     *  UnweightStat stat = accept_reject ( *weighted , unweighted , 12345 , 8 ) ;
+     *  @endcode 
+     *  @param data       (INPUT)  the weighted dataset
+     *  @param unweighted (UPDATE) the non-weighted dataset to be filled 
+     *  @param seed       (INPUT)  the seed for the random streams 
+     *  @param nthreads   (INPUT)  number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @param wmax       (INPUT)  the maximal weight (non-positive: from data)
+     *  @return statistics of the unweighting 
+     *  @see Ostap::Math::RandomStream 
+     */
+    UnweightStat accept_reject 
+    ( const RooAbsData&   data          , 
+      RooDataSet&         unweighted    , 
+      const std::uint64_t seed     = 0  , 
+      const unsigned int  nthreads = 1  , 
+      const double        wmax     = -1 ) ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap 
+// ============================================================================
+#endif // OSTAP_DATACOLUMNS_H
+// ============================================================================
+//                                                                      The END 
+// ============================================================================
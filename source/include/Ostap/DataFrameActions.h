@@ -4,6 +4,12 @@
 // ============================================================================
 // Inclodue files
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+#include <algorithm>
+#include <limits>
+// ============================================================================
 // ROOT 
 // ============================================================================
 #include "RVersion.h"   // ROOT 
@@ -20,10 +26,90 @@
 #include "Ostap/DataFrame.h"
 #include "Ostap/StatEntity.h"
 #include "Ostap/WStatEntity.h"
+#include "Ostap/Moments.h"
+#include "Ostap/P2Quantile.h"
+#include "Ostap/TDigest.h"
+#include "Ostap/Covariance.h"
 // ============================================================================
 /// ONLY starting from ROOT 6.16
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6,16,0)
 // ============================================================================
+namespace Ostap 
+{
+  // ==========================================================================
+  namespace Actions 
+  {
+    // ========================================================================
+    /** @class Slot 
+     *  Per-slot storage, padded to avoid the false sharing 
+     *  of cache lines between the neighbouring slots
+     */
+    template <class ENTITY>
+    class Slot 
+    {
+    public:
+      // ======================================================================
+      /// default constructor 
+      Slot () : entity () {}
+      /// constructor from the prototype counter 
+      Slot ( const ENTITY& prototype ) : entity ( prototype ) {}
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the actual per-slot counter 
+      ENTITY entity           ; // the actual per-slot counter 
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// padding: at least one cache line between neighbouring counters 
+      char   m_pad [ 64 ]  {} ; // padding 
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /// get the number of slots for the actions 
+    unsigned int nSlots () ;
+    // ========================================================================
+    /** get the statistic for the container of values in a single block:
+     *  the sums are accumulated in simple (vectorizable) loops and 
+     *  then converted into the counter 
+     *  @param vs (INPUT) container of values 
+     *  @return the statistic of values 
+     */
+    template <class CONTAINER>
+    inline Ostap::StatEntity bulk_stat ( const CONTAINER& vs ) 
+    {
+      const std::size_t N = vs.size () ;
+      if ( 0 == N ) { return Ostap::StatEntity () ; }               // RETURN 
+      //
+      double sum = 0 ;
+      double vmin =   std::numeric_limits<double>::max () ;
+      double vmax = - std::numeric_limits<double>::max () ;
+      for ( const auto v : vs ) 
+      {
+        const double x = v ;
+        sum  += x ;
+        vmin  = x < vmin ? x : vmin ;
+        vmax  = vmax < x ? x : vmax ;
+      }
+      const double mu = sum / N ;
+      //
+      double sum2 = 0 ;
+      for ( const auto v : vs ) { const double d = v - mu ; sum2 += d * d ; }
+      const double mu2 = sum2 / N ;
+      //
+      if ( vmin <= mu && mu <= vmax && 0 <= mu2 ) 
+      { return Ostap::StatEntity ( N , mu , mu2 , vmin , vmax ) ; }  // RETURN 
+      //
+      // rounding problems or non-finite values: use the regular update 
+      Ostap::StatEntity result {} ;
+      for ( const auto v : vs ) { result += v ; }
+      return result ;
+    }
+    // ========================================================================
+  } //                                       The end of namespace Ostap::Actions 
+  // ==========================================================================
+} //                                                 The end of namespace Ostap 
+// ============================================================================
 namespace ROOT 
 {
   // ==========================================================================
@@ -69,7 +155,7 @@ namespace ROOT
         // ====================================================================
         /// The basic method: increment the counter 
         void Exec ( unsigned int slot , double value ) 
-        { m_slots [ slot % m_N ] += value ; } 
+        { m_slots [ slot % m_N ].entity += value ; } 
         // ====================================================================
         /// The basic method: increment the counter for the vector-like columns       
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
@@ -78,14 +164,14 @@ namespace ROOT
         template <typename T, typename std::enable_if<IsContainer<T>::value, int>::type = 0>
 #endif 
         void Exec ( unsigned int slot , const T &vs )
-        { Ostap::StatEntity& e = m_slots [ slot % m_N ] ; for ( const auto & v : vs ) { e += v ; } }
+        { m_slots [ slot % m_N ].entity += Ostap::Actions::bulk_stat ( vs ) ; }
         // ===============================================================================
       public:
         // ===============================================================================
         /// Get the result 
         std::shared_ptr<Result_t> GetResultPtr () const { return m_result ; }
         /// get partial result for the given slot 
-        Result_t& PartialUpdate ( unsigned int slot ) { return m_slots [ slot % m_N ] ; }
+        Result_t& PartialUpdate ( unsigned int slot ) { return m_slots [ slot % m_N ].entity ; }
         // ===============================================================================
       private:
         // ====================================================================
@@ -93,8 +179,8 @@ namespace ROOT
         const std::shared_ptr<Ostap::StatEntity> m_result {}    ;
         /// size of m_slots 
         unsigned long                            m_N      { 1 } ;
-        /// (current) results per  slot 
-        std::vector<Ostap::StatEntity>           m_slots  {}    ;
+        /// (current) results per  slot (padded)
+        std::vector<Ostap::Actions::Slot<Ostap::StatEntity> > m_slots {} ;
         // ===================================================================
       } ; //                        The end of class ROOT::Detail::RDF::StatVar
 
@@ -135,7 +221,7 @@ namespace ROOT
         // ====================================================================
         /// The basic method: increment the counter 
         void Exec ( unsigned int slot , double value , double weight = 1 ) 
-        { m_slots [ slot % m_N ].add ( value , weight ) ; } 
+        { m_slots [ slot % m_N ].entity.add ( value , weight ) ; } 
         // ====================================================================
         /// The basic method: increment the counter for the vector-like column of values        
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
@@ -144,7 +230,14 @@ namespace ROOT
         template <typename T, typename std::enable_if<IsContainer<T>::value, int>::type = 0>
 #endif 
         void Exec ( unsigned int slot , const T &vs , const double weight = 1 )
-        { Ostap::WStatEntity& e = m_slots [ slot % m_N ] ; for ( const auto & v : vs ) { e.add ( v , weight ) ; } }
+        {
+          Ostap::WStatEntity& e = m_slots [ slot % m_N ].entity ;
+          if ( !weight || vs.empty() ) { for ( const auto & v : vs ) { e.add ( v , weight ) ; } return ; }
+          // all values have the same weight: weighted moments are just moments 
+          const Ostap::StatEntity values  = Ostap::Actions::bulk_stat ( vs ) ;
+          const Ostap::StatEntity weights ( values.n () , weight , 0 , weight , weight ) ;
+          e += Ostap::WStatEntity ( values.mu () , values.mu2 () , values , weights ) ;
+        }
         // ===============================================================================
         /// The basic method: increment the counter for the vector-like coliumn of weight 
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
@@ -153,14 +246,23 @@ namespace ROOT
         template <typename T, typename std::enable_if<IsContainer<T>::value, int>::type = 0>
 #endif
         void Exec ( unsigned int slot , const double value , const T &ws )
-        { Ostap::WStatEntity& e = m_slots [ slot % m_N ] ; for ( const auto & w : ws ) { e.add ( value , w   ) ; } }
+        {
+          Ostap::WStatEntity& e = m_slots [ slot % m_N ].entity ;
+          const Ostap::StatEntity weights = Ostap::Actions::bulk_stat ( ws ) ;
+          if ( !weights.n () || !weights.sum () ) { for ( const auto & w : ws ) { e.add ( value , w ) ; } return ; }
+          // all weights have the same value: no spread 
+          std::size_t nz = 0 ;
+          for ( const auto w : ws ) { nz += ( 0 != w ) ; }
+          const Ostap::StatEntity values ( nz , value , 0 , value , value ) ;
+          e += Ostap::WStatEntity ( value , 0 , values , weights ) ;
+        }
         // ===============================================================================
       public:
         // ===============================================================================
         /// Get the result 
         std::shared_ptr<Result_t> GetResultPtr () const { return m_result ; }
         /// get partial result for the given slot 
-        Result_t& PartialUpdate ( unsigned int slot ) { return m_slots [ slot % m_N ] ; }
+        Result_t& PartialUpdate ( unsigned int slot ) { return m_slots [ slot % m_N ].entity ; }
         // ===============================================================================
       private:
         // ====================================================================
@@ -168,10 +270,416 @@ namespace ROOT
         const std::shared_ptr<Ostap::WStatEntity> m_result {}    ;
         /// size of m_slots 
         unsigned long                             m_N      { 1 } ;
-        /// (current) results per  slot 
-        std::vector<Ostap::WStatEntity>           m_slots  {}    ;
+        /// (current) results per  slot (padded)
+        std::vector<Ostap::Actions::Slot<Ostap::WStatEntity> > m_slots {} ;
         // ===================================================================
-      } ; //                        The end of class ROOT::Detail::RDF::StatVar 
+      } ; //                       The end of class ROOT::Detail::RDF::WStatVar 
+      // ======================================================================
+      /** @class MomentVar
+       *  Helper class to get the central moments for the column in DataFrame 
+       *  @see Ostap::Math::Moment_ 
+       *  @see Ostap::DataFrame 
+       */
+      template <unsigned short N>
+      class MomentVar : public RActionImpl<MomentVar<N> > 
+      {
+      public:
+        // ====================================================================
+        /// define the result type 
+        using Result_t = Ostap::Math::Moment_<N> ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// default constructor 
+        MomentVar () 
+          : m_result ( std::make_shared<Result_t> () ) 
+          , m_N      ( Ostap::Actions::nSlots () ) 
+          , m_slots  ( this->m_N ) 
+        {}
+        /// Move constructor 
+        MomentVar (       MomentVar&& ) = default ;
+        /// Copy constructor is disabled 
+        MomentVar ( const MomentVar&  ) = delete ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// initialize (empty) 
+        void InitTask   ( TTreeReader * , unsigned int ) {} ;
+        /// initialize (empty) 
+        void Initialize () {} ;
+        /// finalize : sum over the slots 
+        void Finalize   () 
+        {
+          Result_t sum { m_slots [ 0 ].entity } ;
+          for ( unsigned int i = 1 ; i < m_N ; ++i ) { sum += m_slots [ i ].entity ; }
+          *m_result = sum ;
+        }
+        /// who am I ?
+        std::string GetActionName() { return "MomentVar" ; }
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// The basic method: increment the counter 
+        void Exec ( unsigned int slot , double value ) 
+        { m_slots [ slot % m_N ].entity += value ; } 
+        // ====================================================================
+        /// The basic method: increment the counter for the vector-like columns       
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
+        template <typename T, typename std::enable_if<ROOT::Internal::RDF::IsDataContainer<T>::value, int>::type = 0>
+#else 
+        template <typename T, typename std::enable_if<IsContainer<T>::value, int>::type = 0>
+#endif
+        void Exec ( unsigned int slot , const T &vs )
+        { Result_t& e = m_slots [ slot % m_N ].entity ; for ( const auto & v : vs ) { e += v ; } }
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// Get the result 
+        std::shared_ptr<Result_t> GetResultPtr () const { return m_result ; }
+        /// get partial result for the given slot 
+        Result_t& PartialUpdate ( unsigned int slot ) { return m_slots [ slot % m_N ].entity ; }
+        // ====================================================================
+      private:
+        // ====================================================================
+        /// the final result 
+        const std::shared_ptr<Result_t>                m_result {}    ;
+        /// size of m_slots 
+        unsigned long                                  m_N      { 1 } ;
+        /// (current) results per  slot (padded)
+        std::vector<Ostap::Actions::Slot<Result_t> >   m_slots  {}    ;
+        // ====================================================================
+      } ; //                      The end of class ROOT::Detail::RDF::MomentVar 
+      // ======================================================================
+      /** @class WMomentVar
+       *  Helper class to get the weighted central moments for the column in DataFrame 
+       *  @see Ostap::Math::WMoment_ 
+       *  @see Ostap::DataFrame 
+       */
+      template <unsigned short N>
+      class WMomentVar : public RActionImpl<WMomentVar<N> > 
+      {
+      public:
+        // ====================================================================
+        /// define the result type 
+        using Result_t = Ostap::Math::WMoment_<N> ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// default constructor 
+        WMomentVar () 
+          : m_result ( std::make_shared<Result_t> () ) 
+          , m_N      ( Ostap::Actions::nSlots () ) 
+          , m_slots  ( this->m_N ) 
+        {}
+        /// Move constructor 
+        WMomentVar (       WMomentVar&& ) = default ;
+        /// Copy constructor is disabled 
+        WMomentVar ( const WMomentVar&  ) = delete ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// initialize (empty) 
+        void InitTask   ( TTreeReader * , unsigned int ) {} ;
+        /// initialize (empty) 
+        void Initialize () {} ;
+        /// finalize : sum over the slots 
+        void Finalize   () 
+        {
+          Result_t sum { m_slots [ 0 ].entity } ;
+          for ( unsigned int i = 1 ; i < m_N ; ++i ) { sum += m_slots [ i ].entity ; }
+          *m_result = sum ;
+        }
+        /// who am I ?
+        std::string GetActionName() { return "WMomentVar" ; }
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// The basic method: increment the counter 
+        void Exec ( unsigned int slot , double value , double weight = 1 ) 
+        { m_slots [ slot % m_N ].entity.add ( value , weight ) ; } 
+        // ====================================================================
+        /// The basic method: increment the counter for the vector-like column of values        
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
+        template <typename T, typename std::enable_if<ROOT::Internal::RDF::IsDataContainer<T>::value, int>::type = 0>
+#else 
+        template <typename T, typename std::enable_if<IsContainer<T>::value, int>::type = 0>
+#endif
+        void Exec ( unsigned int slot , const T &vs , const double weight = 1 )
+        { Result_t& e = m_slots [ slot % m_N ].entity ; for ( const auto & v : vs ) { e.add ( v , weight ) ; } }
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// Get the result 
+        std::shared_ptr<Result_t> GetResultPtr () const { return m_result ; }
+        /// get partial result for the given slot 
+        Result_t& PartialUpdate ( unsigned int slot ) { return m_slots [ slot % m_N ].entity ; }
+        // ====================================================================
+      private:
+        // ====================================================================
+        /// the final result 
+        const std::shared_ptr<Result_t>                m_result {}    ;
+        /// size of m_slots 
+        unsigned long                                  m_N      { 1 } ;
+        /// (current) results per  slot (padded)
+        std::vector<Ostap::Actions::Slot<Result_t> >   m_slots  {}    ;
+        // ====================================================================
+      } ; //                     The end of class ROOT::Detail::RDF::WMomentVar 
+      // ======================================================================
+      /** @class P2QuantileVar
+       *  Helper class to get the (approximate) quantile for the column in DataFrame 
+       *  using P2-algorithm 
+       *  @attention P2-estimators can't be merged: for multithreaded 
+       *             processing the result is the average of the per-slot 
+       *             estimates, weighted with the number of entries 
+       *  @see Ostap::Math::GSL::P2Quantile 
+       *  @see Ostap::DataFrame 
+       */
+      class P2QuantileVar : public RActionImpl<P2QuantileVar> 
+      {
+      public:
+        // ====================================================================
+        /// define the result type 
+        using Result_t = double ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /** constructor 
+         *  @param p quantile  \f$ 0 < p < 1 \f$
+         */
+        P2QuantileVar ( const double p = 0.5 ) ;
+        /// Move constructor 
+        P2QuantileVar (       P2QuantileVar&& ) = default ;
+        /// Copy constructor is disabled 
+        P2QuantileVar ( const P2QuantileVar&  ) = delete ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// initialize (empty) 
+        void InitTask   ( TTreeReader * , unsigned int ) {} ;
+        /// initialize (empty) 
+        void Initialize () {} ;
+        /// finalize : combine the slots 
+        void Finalize   () ;
+        /// who am I ?
+        std::string GetActionName() { return "P2QuantileVar" ; }
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// The basic method: increment the counter 
+        void Exec ( unsigned int slot , double value ) 
+        { m_slots [ slot % m_N ].entity.add ( value ) ; } 
+        // ====================================================================
+        /// The basic method: increment the counter for the vector-like columns       
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
+        template <typename T, typename std::enable_if<ROOT::Internal::RDF::IsDataContainer<T>::value, int>::type = 0>
+#else 
+        template <typename T, typename std::enable_if<IsContainer<T>::value, int>::type = 0>
+#endif
+        void Exec ( unsigned int slot , const T &vs )
+        { m_slots [ slot % m_N ].entity.add ( vs.begin () , vs.end () ) ; }
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// Get the result 
+        std::shared_ptr<Result_t> GetResultPtr () const { return m_result ; }
+        // ====================================================================
+      private:
+        // ====================================================================
+        /// the final result 
+        const std::shared_ptr<double>                  m_result {}    ;
+        /// size of m_slots 
+        unsigned long                                  m_N      { 1 } ;
+        /// (current) results per  slot (padded)
+        std::vector<Ostap::Actions::Slot<Ostap::Math::GSL::P2Quantile> > m_slots {} ;
+        // ====================================================================
+      } ; //                  The end of class ROOT::Detail::RDF::P2QuantileVar 
+      // ======================================================================
+      /** @class TDigestVar
+       *  Helper class to get the mergeable quantile sketch (t-digest)
+       *  for the column in DataFrame 
+       *  - the per-slot sketches are merged at the end 
+       *  @see Ostap::Math::TDigest 
+       *  @see Ostap::DataFrame 
+       */
+      class TDigestVar : public RActionImpl<TDigestVar> 
+      {
+      public:
+        // ====================================================================
+        /// define the result type 
+        using Result_t = Ostap::Math::TDigest ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /** constructor 
+         *  @param compression the compression parameter for t-digest 
+         */
+        TDigestVar ( const unsigned int compression = 100 ) ;
+        /// Move constructor 
+        TDigestVar (       TDigestVar&& ) = default ;
+        /// Copy constructor is disabled 
+        TDigestVar ( const TDigestVar&  ) = delete ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// initialize (empty) 
+        void InitTask   ( TTreeReader * , unsigned int ) {} ;
+        /// initialize (empty) 
+        void Initialize () {} ;
+        /// finalize : merge the slots 
+        void Finalize   () ;
+        /// who am I ?
+        std::string GetActionName() { return "TDigestVar" ; }
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// The basic method: increment the counter 
+        void Exec ( unsigned int slot , double value ) 
+        { m_slots [ slot % m_N ].entity.add ( value ) ; } 
+        // ====================================================================
+        /// The basic method: increment the counter for the vector-like columns       
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
+        template <typename T, typename std::enable_if<ROOT::Internal::RDF::IsDataContainer<T>::value, int>::type = 0>
+#else 
+        template <typename T, typename std::enable_if<IsContainer<T>::value, int>::type = 0>
+#endif
+        void Exec ( unsigned int slot , const T &vs )
+        { m_slots [ slot % m_N ].entity.add ( vs.begin () , vs.end () ) ; }
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// Get the result 
+        std::shared_ptr<Result_t> GetResultPtr () const { return m_result ; }
+        // ====================================================================
+      private:
+        // ====================================================================
+        /// the final result 
+        const std::shared_ptr<Result_t>                m_result {}    ;
+        /// size of m_slots 
+        unsigned long                                  m_N      { 1 } ;
+        /// (current) results per  slot (padded)
+        std::vector<Ostap::Actions::Slot<Result_t> >   m_slots  {}    ;
+        // ====================================================================
+      } ; //                     The end of class ROOT::Detail::RDF::TDigestVar 
+      // ======================================================================
+      /** @class CovVar
+       *  Helper class to get the (weighted) covariance for two columns in DataFrame 
+       *  @see Ostap::Math::Covariance 
+       *  @see Ostap::DataFrame 
+       */
+      class CovVar : public RActionImpl<CovVar> 
+      {
+      public:
+        // ====================================================================
+        /// define the result type 
+        using Result_t = Ostap::Math::Covariance ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// default constructor 
+        CovVar () ;
+        /// Move constructor 
+        CovVar (       CovVar&& ) = default ;
+        /// Copy constructor is disabled 
+        CovVar ( const CovVar&  ) = delete ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// initialize (empty) 
+        void InitTask   ( TTreeReader * , unsigned int ) {} ;
+        /// initialize (empty) 
+        void Initialize () {} ;
+        /// finalize : sum over the slots 
+        void Finalize   () ;
+        /// who am I ?
+        std::string GetActionName() { return "CovVar" ; }
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// The basic method: increment the counter 
+        void Exec ( unsigned int slot , double x , double y , double weight = 1 ) 
+        { m_slots [ slot % m_N ].entity.add ( x , y , weight ) ; } 
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// Get the result 
+        std::shared_ptr<Result_t> GetResultPtr () const { return m_result ; }
+        /// get partial result for the given slot 
+        Result_t& PartialUpdate ( unsigned int slot ) { return m_slots [ slot % m_N ].entity ; }
+        // ====================================================================
+      private:
+        // ====================================================================
+        /// the final result 
+        const std::shared_ptr<Result_t>                m_result {}    ;
+        /// size of m_slots 
+        unsigned long                                  m_N      { 1 } ;
+        /// (current) results per  slot (padded)
+        std::vector<Ostap::Actions::Slot<Result_t> >   m_slots  {}    ;
+        // ====================================================================
+      } ; //                         The end of class ROOT::Detail::RDF::CovVar 
+      // ======================================================================
+      /** @class CovVars
+       *  Helper class to get the (weighted) covariances for N columns in DataFrame. 
+       *  If N+1 columns are specified, the last one is used as the weight.
+       *  The entries are accumulated per slot and added to the counters in batches
+       *  @see Ostap::Math::Covariances 
+       *  @see Ostap::Math::CovariancesBuffer 
+       *  @see Ostap::DataFrame 
+       */
+      class CovVars : public RActionImpl<CovVars> 
+      {
+      public:
+        // ====================================================================
+        /// define the result type 
+        using Result_t = Ostap::Math::Covariances ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// constructor for N variables
+        CovVars ( const unsigned short N = 2 ) ;
+        /// Move constructor 
+        CovVars (       CovVars&& ) = default ;
+        /// Copy constructor is disabled 
+        CovVars ( const CovVars&  ) = delete ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// initialize (empty) 
+        void InitTask   ( TTreeReader * , unsigned int ) {} ;
+        /// initialize (empty) 
+        void Initialize () {} ;
+        /// finalize : flush the buffers and sum over the slots 
+        void Finalize   () ;
+        /// who am I ?
+        std::string GetActionName() { return "CovVars" ; }
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// The basic method: increment the counter 
+        template <typename... ARGS>
+        void Exec ( unsigned int slot , const ARGS&... args ) 
+        {
+          const double values [] = { static_cast<double> ( args ) ... } ;
+          m_slots [ slot % m_N ].entity.add 
+            ( values , m_nvars < sizeof... ( ARGS ) ? values [ m_nvars ] : 1.0 ) ;
+        } 
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// Get the result 
+        std::shared_ptr<Result_t> GetResultPtr () const { return m_result ; }
+        // ====================================================================
+      private:
+        // ====================================================================
+        /// the final result 
+        const std::shared_ptr<Result_t>                                 m_result {}    ;
+        /// number of variables 
+        unsigned short                                                  m_nvars  { 2 } ;
+        /// size of m_slots 
+        unsigned long                                                   m_N      { 1 } ;
+        /// (current) buffered results per slot (padded)
+        std::vector<Ostap::Actions::Slot<Ostap::Math::CovariancesBuffer> > m_slots {} ;
+        // ====================================================================
+      } ; //                        The end of class ROOT::Detail::RDF::CovVars 
       // ======================================================================
     } //                                 The end of namespace ROOT::Detail::RDF
     // ========================================================================
@@ -185,8 +693,12 @@ namespace Ostap
   namespace Actions 
   {
     // ========================================================================
-    using StatVar  = ROOT::Detail::RDF::StatVar  ;
-    using WStatVar = ROOT::Detail::RDF::WStatVar ;
+    using StatVar       = ROOT::Detail::RDF::StatVar       ;
+    using WStatVar      = ROOT::Detail::RDF::WStatVar      ;
+    using P2QuantileVar = ROOT::Detail::RDF::P2QuantileVar ;
+    using TDigestVar    = ROOT::Detail::RDF::TDigestVar    ;
+    using CovVar        = ROOT::Detail::RDF::CovVar        ;
+    using CovVars       = ROOT::Detail::RDF::CovVars       ;
     // ========================================================================
   }
   // ==========================================================================
@@ -0,0 +1,226 @@
+// ============================================================================
+#ifndef OSTAP_DATAFRAMEFUNCS_H
+#define OSTAP_DATAFRAMEFUNCS_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <string>
+#include <vector>
+#include <map>
+#include <limits>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "RVersion.h"   // ROOT
+#include "RtypesCore.h" // ROOT
+// ============================================================================
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,16,0)
+#include "ROOT/RDataFrame.hxx"  // ROOT
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/DataFrame.h"
+#include "Ostap/Funcs.h"
+// ============================================================================
+/** @file Ostap/DataFrameFuncs.h
+ *  Typed (JIT-free) adapters of Ostap functions for <code>RDataFrame</code>
+ *  - <code>Define</code>/<code>Filter</code> are booked with the compiled
+ *    callables, no string expressions are compiled by cling
+ *  - each processing slot gets its own clone of the function,
+ *    therefore the adapters are safe for the implicit multithreading
+ *  - the input columns of any arithmetic type are converted to double
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Frames
+  {
+    // ========================================================================
+    /// the actual type of the node in the frame graph
+    typedef ROOT::RDF::RNode FrameNode ;
+    // ========================================================================
+    /** define the double-precision copy of the arithmetic column
+     *  - no new column is defined for the <code>double</code> columns
+     *  @param frame  (INPUT) the frame
+     *  @param column (INPUT) the column
+     *  @param name   (UPDATE) the name of the double-precision column
+     *  @return the updated frame
+     */
+    FrameNode as_double
+    ( FrameNode          frame  ,
+      const std::string& column ,
+      std::string&       name   ) ;
+    // ========================================================================
+    /** define new column as 1D-function of the column
+     *  @code
+     *  TH1D histo = ... ;
+     *  Ostap::Functions::FuncTH1 fun ( histo , "" ) ;
+     *  auto f2 = Ostap::Frames::define ( frame , "w" , fun , "pt" ) ;
+     *  @endcode
+     *  @param frame  (INPUT) the frame
+     *  @param name   (INPUT) the name of new column
+     *  @param fun    (INPUT) the function (the expressions are ignored)
+     *  @param x      (INPUT) the column for x
+     *  @return the updated frame
+     */
+    FrameNode define
+    ( FrameNode                         frame ,
+      const std::string&                name  ,
+      const Ostap::Functions::Func1D&   fun   ,
+      const std::string&                x     ) ;
+    // ========================================================================
+    /** define new column as 2D-function of the columns
+     *  @param frame  (INPUT) the frame
+     *  @param name   (INPUT) the name of new column
+     *  @param fun    (INPUT) the function (the expressions are ignored)
+     *  @param x      (INPUT) the column for x
+     *  @param y      (INPUT) the column for y
+     *  @return the updated frame
+     */
+    FrameNode define
+    ( FrameNode                         frame ,
+      const std::string&                name  ,
+      const Ostap::Functions::Func2D&   fun   ,
+      const std::string&                x     ,
+      const std::string&                y     ) ;
+    // ========================================================================
+    /** define new column as 3D-function of the columns
+     *  @param frame  (INPUT) the frame
+     *  @param name   (INPUT) the name of new column
+     *  @param fun    (INPUT) the function (the expressions are ignored)
+     *  @param x      (INPUT) the column for x
+     *  @param y      (INPUT) the column for y
+     *  @param z      (INPUT) the column for z
+     *  @return the updated frame
+     */
+    FrameNode define
+    ( FrameNode                         frame ,
+      const std::string&                name  ,
+      const Ostap::Functions::Func3D&   fun   ,
+      const std::string&                x     ,
+      const std::string&                y     ,
+      const std::string&                z     ) ;
+    // ========================================================================
+    /** filter the frame using the 1D-function: <code>low <= fun(x) < high</code>
+     *  @param frame  (INPUT) the frame
+     *  @param fun    (INPUT) the function (the expressions are ignored)
+     *  @param x      (INPUT) the column for x
+     *  @param low    (INPUT) the low  edge of accepted interval
+     *  @param high   (INPUT) the high edge of accepted interval
+     *  @param name   (INPUT) the name of the filter
+     *  @return the filtered frame
+     */
+    FrameNode filter
+    ( FrameNode                         frame ,
+      const Ostap::Functions::Func1D&   fun   ,
+      const std::string&                x     ,
+      const double                      low   ,
+      const double                      high  = std::numeric_limits<double>::max () ,
+      const std::string&                name  = "" ) ;
+    // ========================================================================
+    /** filter the frame using the 2D-function: <code>low <= fun(x,y) < high</code>
+     *  @see Ostap::Frames::filter
+     */
+    FrameNode filter
+    ( FrameNode                         frame ,
+      const Ostap::Functions::Func2D&   fun   ,
+      const std::string&                x     ,
+      const std::string&                y     ,
+      const double                      low   ,
+      const double                      high  = std::numeric_limits<double>::max () ,
+      const std::string&                name  = "" ) ;
+    // ========================================================================
+    /** filter the frame using the 3D-function: <code>low <= fun(x,y,z) < high</code>
+     *  @see Ostap::Frames::filter
+     */
+    FrameNode filter
+    ( FrameNode                         frame ,
+      const Ostap::Functions::Func3D&   fun   ,
+      const std::string&                x     ,
+      const std::string&                y     ,
+      const std::string&                z     ,
+      const double                      low   ,
+      const double                      high  = std::numeric_limits<double>::max () ,
+      const std::string&                name  = "" ) ;
+    // ========================================================================
+    /** define new column as a function of the column
+     *  - the function is copied for each processing slot
+     *  - any callable object <code>double f(double)</code>,
+     *    e.g. <code>Ostap::Math</code> shapes
+     *  @param frame  (INPUT) the frame
+     *  @param name   (INPUT) the name of new column
+     *  @param fun    (INPUT) the function
+     *  @param x      (INPUT) the column for x
+     *  @return the updated frame
+     */
+    template <class FUNCTION>
+    inline FrameNode define1
+    ( FrameNode          frame ,
+      const std::string& name  ,
+      const FUNCTION&    fun   ,
+      const std::string& x     )
+    { return define ( frame , name , Ostap::Functions::Func1D ( fun , "" ) , x ) ; }
+    // ========================================================================
+    /** define new column as a function of the columns
+     *  @see Ostap::Frames::define1
+     */
+    template <class FUNCTION>
+    inline FrameNode define2
+    ( FrameNode          frame ,
+      const std::string& name  ,
+      const FUNCTION&    fun   ,
+      const std::string& x     ,
+      const std::string& y     )
+    { return define ( frame , name , Ostap::Functions::Func2D ( fun , "" , "" ) , x , y ) ; }
+    // ========================================================================
+    /** define new column as a function of the columns
+     *  @see Ostap::Frames::define1
+     */
+    template <class FUNCTION>
+    inline FrameNode define3
+    ( FrameNode          frame ,
+      const std::string& name  ,
+      const FUNCTION&    fun   ,
+      const std::string& x     ,
+      const std::string& y     ,
+      const std::string& z     )
+    { return define ( frame , name , Ostap::Functions::Func3D ( fun , "" , "" , "" ) , x , y , z ) ; }
+    // ========================================================================
+    /** add TMVA responses as new columns <code>prefix+method+suffix</code>
+     *  - each processing slot gets its own <code>TMVA::Reader</code>
+     *  - the TMVA configuration is read from the trained (xml) weight-files
+     *  @param frame        (INPUT) the frame
+     *  @param inputs       (INPUT) map { TMVA variable : column }
+     *  @param weight_files (INPUT) map { method : weight_file }
+     *  @param options      (INPUT) options for <code>TMVA::Reader</code>
+     *  @param prefix       (INPUT) the prefix for new columns
+     *  @param suffix       (INPUT) the suffix for new columns
+     *  @param aux          (INPUT) obligatory for the cuts method
+     *                              where it represents the efficiency cutoff
+     *  @return the updated frame
+     *  @see Ostap::TMVA::addResponse
+     */
+    FrameNode add_response
+    ( FrameNode                                 frame          ,
+      const std::map<std::string,std::string>&  inputs         ,
+      const std::map<std::string,std::string>&  weight_files   ,
+      const std::string&                        options = ""   ,
+      const std::string&                        prefix  = ""   ,
+      const std::string&                        suffix  = ""   ,
+      const double                              aux     = 0.9  ) ;
+    // ========================================================================
+  } //                                       The end of namespace Ostap::Frames
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // ROOT_VERSION_CODE >= ROOT_VERSION(6,16,0)
+// ============================================================================
+#endif // OSTAP_DATAFRAMEFUNCS_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
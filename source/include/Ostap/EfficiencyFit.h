@@ -0,0 +1,213 @@
+// ============================================================================
+#ifndef OSTAP_EFFICIENCYFIT_H
+#define OSTAP_EFFICIENCYFIT_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <memory>
+#include <vector>
+// ============================================================================
+/** @file Ostap/EfficiencyFit.h
+ *  Fast unbinned fit of the efficiency, parameterised as
+ *  (2D/3D) Bernstein polynomial or (2D) B-spline
+ *  @see Ostap::Math::EfficiencyFit
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils { class WorkerPool ; }
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    class Bernstein2D ;
+    class Bernstein3D ;
+    class BSpline2D   ;
+    // ========================================================================
+    /** @class EfficiencyFit Ostap/EfficiencyFit.h
+     *  Fast unbinned fit of the efficiency
+     *  \f$ \varepsilon(x) = \sum_k c_k \phi_k(x) \f$
+     *  to the sample of accepted/rejected events using
+     *  the Bernoulli likelihood:
+     *  \f[ -\log L = - \sum_i w_i \left( a_i \log \varepsilon(x_i)
+     *    + (1-a_i) \log \left( 1 - \varepsilon(x_i) \right) \right) \f]
+     *
+     *  - the basis \f$ \phi_k \f$ is the partition of unity
+     *    (tensor products of Bernstein basis polynomials or of B-splines),
+     *    therefore \f$ 0 \le c_k \le 1 \f$ ensures
+     *    \f$ 0 \le \varepsilon \le 1 \f$
+     *  - the basis functions do not depend on the parameters,
+     *    the matrix \f$ M_{ik} = \phi_k ( x_i ) \f$ is calculated once,
+     *    and the likelihood and its analytic gradient are evaluated
+     *    as dense matrix-vector products, in parallel for blocks of events
+     *    (the partial sums are combined in the fixed order)
+     *  - the fit is performed by <code>Minuit2</code> using the analytic gradient
+     *
+     *  @attention the matrix uses <code>8*N*K</code> bytes of memory
+     *  @attention for weighted events the uncertainties are not corrected
+     *  @see Ostap::Math::FrozenBasis
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class EfficiencyFit
+    {
+    public:
+      // ======================================================================
+      /** constructor from 2D Bernstein polynomial
+       *  @param shape    (INPUT) the shape (defines the degrees and the ranges)
+       *  @param x        (INPUT) x-values
+       *  @param y        (INPUT) y-values
+       *  @param accept   (INPUT) accept flags: non-zero for accepted events
+       *  @param weights  (INPUT) weights (empty: no weights)
+       *  @param nthreads (INPUT) number of threads
+       *                  (0: the size of ROOT MT pool or hardware concurrency)
+       */
+      EfficiencyFit
+      ( const Ostap::Math::Bernstein2D& shape          ,
+        const std::vector<double>&      x              ,
+        const std::vector<double>&      y              ,
+        const std::vector<double>&      accept         ,
+        const std::vector<double>&      weights  = {}  ,
+        const unsigned int              nthreads = 0   ) ;
+      // ======================================================================
+      /** constructor from 3D Bernstein polynomial
+       *  @param shape    (INPUT) the shape (defines the degrees and the ranges)
+       *  @param x        (INPUT) x-values
+       *  @param y        (INPUT) y-values
+       *  @param z        (INPUT) z-values
+       *  @param accept   (INPUT) accept flags: non-zero for accepted events
+       *  @param weights  (INPUT) weights (empty: no weights)
+       *  @param nthreads (INPUT) number of threads
+       */
+      EfficiencyFit
+      ( const Ostap::Math::Bernstein3D& shape          ,
+        const std::vector<double>&      x              ,
+        const std::vector<double>&      y              ,
+        const std::vector<double>&      z              ,
+        const std::vector<double>&      accept         ,
+        const std::vector<double>&      weights  = {}  ,
+        const unsigned int              nthreads = 0   ) ;
+      // ======================================================================
+      /** constructor from 2D B-spline
+       *  @param shape    (INPUT) the shape (defines the knots and the orders)
+       *  @param x        (INPUT) x-values
+       *  @param y        (INPUT) y-values
+       *  @param accept   (INPUT) accept flags: non-zero for accepted events
+       *  @param weights  (INPUT) weights (empty: no weights)
+       *  @param nthreads (INPUT) number of threads
+       */
+      EfficiencyFit
+      ( const Ostap::Math::BSpline2D&   shape          ,
+        const std::vector<double>&      x              ,
+        const std::vector<double>&      y              ,
+        const std::vector<double>&      accept         ,
+        const std::vector<double>&      weights  = {}  ,
+        const unsigned int              nthreads = 0   ) ;
+      // ======================================================================
+      /// destructor
+      ~EfficiencyFit () ;
+      // ======================================================================
+      EfficiencyFit ( const EfficiencyFit& ) = delete ;
+      EfficiencyFit& operator= ( const EfficiencyFit& ) = delete ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** negative log-likelihood and (optionally) its gradient
+       *  @param c        (INPUT)  coefficients, at least nbasis() elements
+       *  @param gradient (OUTPUT) gradient, at least nbasis() elements (or nullptr)
+       *  @return the value of negative log-likelihood
+       */
+      double nll ( const double* c , double* gradient = nullptr ) const ;
+      /// negative log-likelihood
+      double nll ( const std::vector<double>& c ) const ;
+      // ======================================================================
+      /** perform the fit
+       *  @param strategy  Minuit strategy
+       *  @param tolerance the tolerance
+       *  @return status of the minimization (0 for success)
+       */
+      int fit ( const int    strategy  = 1     ,
+                const double tolerance = 0.01  ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of events
+      std::size_t nevents () const { return m_nevents ; }
+      /// number of basis functions
+      std::size_t nbasis  () const { return m_nbasis  ; }
+      /// weighted number of accepted events
+      double      accepted () const { return m_accepted ; }
+      /// weighted number of all events
+      double      total    () const { return m_total    ; }
+      /// the value of negative log-likelihood at minimum
+      double      minNll   () const { return m_minnll   ; }
+      // ======================================================================
+      /// the fitted coefficients of the basis
+      const std::vector<double>& coefficients () const { return m_coeffs ; }
+      /// the uncertainties of the coefficients
+      const std::vector<double>& errors       () const { return m_errors ; }
+      /// the covariance of the coefficients
+      double covariance ( const std::size_t i ,
+                          const std::size_t j ) const
+      { return i < m_nbasis && j < m_nbasis ? m_cov [ i * m_nbasis + j ] : 0.0 ; }
+      // ======================================================================
+      /** the parameters of the shape, that reproduce the fitted efficiency
+       *  (e.g. <code>shape.setPar ( k , pars [ k ] )</code>)
+       */
+      std::vector<double> pars () const ;
+      /// the scale factors for the parameters: \f$ p_k = s_k c_k \f$
+      const std::vector<double>& scales () const { return m_scales ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// fill the common data
+      void setup ( const std::vector<double>& accept   ,
+                   const std::vector<double>& weights  ,
+                   const unsigned int         nthreads ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// number of events
+      std::size_t         m_nevents  { 0 } ;
+      /// number of basis functions
+      std::size_t         m_nbasis   { 0 } ;
+      /// the matrix of basis functions (column-wise)
+      std::vector<double> m_matrix   {}    ;
+      /// accept flags
+      std::vector<char>   m_accept   {}    ;
+      /// the weights
+      std::vector<double> m_weights  {}    ;
+      /// the scale factors for the parameters
+      std::vector<double> m_scales   {}    ;
+      /// weighted number of accepted events
+      double              m_accepted { 0 } ;
+      /// weighted number of all events
+      double              m_total    { 0 } ;
+      /// the fitted coefficients
+      std::vector<double> m_coeffs   {}    ;
+      /// the errors of the coefficients
+      std::vector<double> m_errors   {}    ;
+      /// the covariance matrix
+      std::vector<double> m_cov      {}    ;
+      /// the value of negative log-likelihood at minimum
+      double              m_minnll   { 0 } ;
+      /// the blocks of events
+      std::vector<std::pair<std::size_t,std::size_t> > m_blocks {} ;
+      /// the pool of threads
+      std::unique_ptr<Ostap::Utils::WorkerPool>        m_pool   ; //!
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_EFFICIENCYFIT_H
+// ============================================================================
@@ -7,6 +7,8 @@
 // STD & STL 
 // ============================================================================
 #include <vector>
+#include <cstddef>
+#include <functional>
 // ============================================================================
 // ROOT 
 // ============================================================================
@@ -52,6 +54,7 @@ namespace Ostap
             MatrixAllocationFailure     = 101 , 
             VectorAllocationFailure     = 102 , 
             WorkspaceAllocationFailure  = 103 , 
+            JacobiFailure               = 104 , 
             // the actual return value is ErrorFromGSL + error code )
             ErrorFromGSL                = 199 ///< ErrorFromGSL + error code
           } ;
@@ -195,6 +198,145 @@ namespace Ostap
           std::vector<ROOT::Math::SVector<T,D> >&                       vecs , 
           const bool sorted = true ) const ;
         // ====================================================================
+      public: // batched processing 
+        // ====================================================================
+        /** evaluate the eigenvalues for the array of symmetric matrices
+         *
+         *  @code 
+         * 
+         *  EigenSystem eval ;
+         *  const std::vector<Ostap::SymMatrix3x3> matrices = ... ;
+         *  std::vector<Ostap::Vector3>            values ( matrices.size() ) ;
+         *  StatusCode sc = eval.eigenValues ( matrices.data() , values.data () , 
+         *                                     matrices.size() , true , 4 ) ;
+         * 
+         *  @endcode 
+         *
+         *  - 2x2 and 3x3 matrices are processed with closed-form expressions
+         *  - matrices up to 6x6 are processed with Jacobi sweeps 
+         *  - larger matrices are processed with GSL, 
+         *    using one workspace per thread 
+         *
+         *  @param mtrx     (input)  the array of matrices 
+         *  @param vals     (output) the array of eigenvalues 
+         *  @param N        (input)  the length of arrays 
+         *  @param sorted   (input)  flag to be use for sorting 
+         *  @param nthreads (input)  number of threads, 0 means all available
+         *  @return status code (the first failure)
+         */
+        template <class T,unsigned int D>
+        inline Ostap::StatusCode
+        eigenValues
+        ( const ROOT::Math::SMatrix<T,D,D,ROOT::Math::MatRepSym<T,D> >* mtrx            ,
+          ROOT::Math::SVector<T,D>*                                     vals            , 
+          const std::size_t                                             N               , 
+          const bool                                                    sorted   = true , 
+          const unsigned int                                            nthreads = 1    ) const ;
+        // ====================================================================
+        /** evaluate the eigenvalues and eigenvectors 
+         *  for the array of symmetric matrices
+         *  Eigenvectors are returned as columns for the matrices "vecs".
+         *  @see EigenSystem::eigenValues 
+         *  @param mtrx     (input)  the array of matrices 
+         *  @param vals     (output) the array of eigenvalues 
+         *  @param vecs     (output) the array of matrices with eigenvectors 
+         *  @param N        (input)  the length of arrays 
+         *  @param sorted   (input)  flag to be use for sorting 
+         *  @param nthreads (input)  number of threads, 0 means all available
+         *  @return status code (the first failure)
+         */
+        template <class T,unsigned int D>
+        inline Ostap::StatusCode
+        eigenVectors
+        ( const ROOT::Math::SMatrix<T,D,D,ROOT::Math::MatRepSym<T,D> >* mtrx            ,
+          ROOT::Math::SVector<T,D>*                                     vals            , 
+          ROOT::Math::SMatrix<T,D,D>*                                   vecs            , 
+          const std::size_t                                             N               , 
+          const bool                                                    sorted   = true , 
+          const unsigned int                                            nthreads = 1    ) const ;
+        // ====================================================================
+        /** evaluate the eigenvalues for the vector of symmetric matrices
+         *  @see EigenSystem::eigenValues 
+         *  @param mtrx     (input)  the matrices 
+         *  @param vals     (output) the eigenvalues 
+         *  @param sorted   (input)  flag to be use for sorting 
+         *  @param nthreads (input)  number of threads, 0 means all available
+         *  @return status code (the first failure)
+         */
+        template <class T,unsigned int D>
+        inline Ostap::StatusCode
+        eigenValues
+        ( const std::vector<ROOT::Math::SMatrix<T,D,D,ROOT::Math::MatRepSym<T,D> > >& mtrx            ,
+          std::vector<ROOT::Math::SVector<T,D> >&                                     vals            , 
+          const bool                                                                  sorted   = true , 
+          const unsigned int                                                          nthreads = 1    ) const 
+        {
+          vals.resize ( mtrx.size () ) ;
+          return eigenValues ( mtrx.data () , vals.data () , mtrx.size () , sorted , nthreads ) ;
+        }
+        // ====================================================================
+        /** evaluate the eigenvalues and eigenvectors 
+         *  for the vector of symmetric matrices
+         *  @see EigenSystem::eigenVectors 
+         *  @param mtrx     (input)  the matrices 
+         *  @param vals     (output) the eigenvalues 
+         *  @param vecs     (output) the matrices with eigenvectors 
+         *  @param sorted   (input)  flag to be use for sorting 
+         *  @param nthreads (input)  number of threads, 0 means all available
+         *  @return status code (the first failure)
+         */
+        template <class T,unsigned int D>
+        inline Ostap::StatusCode
+        eigenVectors
+        ( const std::vector<ROOT::Math::SMatrix<T,D,D,ROOT::Math::MatRepSym<T,D> > >& mtrx            ,
+          std::vector<ROOT::Math::SVector<T,D> >&                                     vals            , 
+          std::vector<ROOT::Math::SMatrix<T,D,D> >&                                   vecs            , 
+          const bool                                                                  sorted   = true , 
+          const unsigned int                                                          nthreads = 1    ) const 
+        {
+          vals.resize ( mtrx.size () ) ;
+          vecs.resize ( mtrx.size () ) ;
+          return eigenVectors ( mtrx.data () , vals.data () , vecs.data () , mtrx.size () , sorted , nthreads ) ;
+        }
+        // ====================================================================
+      protected:
+        // ====================================================================
+        /// the task for the batched processing of the range [first,last)
+        typedef std::function<Ostap::StatusCode(std::size_t,std::size_t)> Task ;
+        // ====================================================================
+        /** process the range [0,N) in chunks using several threads 
+         *  @return the status code of the first failed chunk 
+         */
+        static Ostap::StatusCode _process 
+        ( const std::size_t  N        , 
+          const unsigned int nthreads , 
+          const Task&        task     ) ;
+        // ====================================================================
+        /** solve the eigenproblem for the small (D<=6) matrix 
+         *  - closed-form expressions for 2x2 and 3x3 matrices 
+         *  - cyclic Jacobi sweeps for other cases 
+         *  @param a      (UPDATE) the full DxD matrix, destroyed 
+         *  @param vals   (output) the eigenvalues 
+         *  @param vecs   (output) the DxD matrix with eigenvectors as columns (could be null)
+         *  @param D      (input)  the dimension 
+         *  @param sorted (input)  flag to be use for sorting 
+         */
+        static Ostap::StatusCode _small 
+        ( double*            a      , 
+          double*            vals   , 
+          double*            vecs   , 
+          const unsigned int D      , 
+          const bool         sorted ) ;
+        // ====================================================================
+        /// solve the eigenproblem for one matrix of the batch 
+        template <class T,unsigned int D>
+        inline Ostap::StatusCode 
+        _solve 
+        ( const ROOT::Math::SMatrix<T,D,D,ROOT::Math::MatRepSym<T,D> >& mtrx   ,
+          ROOT::Math::SVector<T,D>&                                     vals   , 
+          ROOT::Math::SMatrix<T,D,D>*                                   vecs   , 
+          const bool                                                    sorted ) const ;
+        // ====================================================================
       protected:
         // ====================================================================
         /// find the eigenvalues   (& sort them if needed ) 
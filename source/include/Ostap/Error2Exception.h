@@ -100,6 +100,52 @@ namespace Ostap
       /// get all errors in a form of the  table 
       static Table table () ;
       // ======================================================================      
+    public:
+      // ======================================================================      
+      /** how many times GSL error with the given code has been fired? 
+       *  (the errors are counted for all handlers, 
+       *   also when the recording is disabled)
+       */
+      static unsigned long counter ( const int errcode ) ;
+      /// total number of fired GSL errors 
+      static unsigned long total   () ;
+      // ======================================================================      
+      /** enable/disable the recording of errors for the current thread 
+       *  @return the previous state 
+       *  @see Ostap::Utils::GslNoRecord 
+       */
+      static bool record    ( const bool value ) ;
+      /// is the recording of errors enabled for the current thread? 
+      static bool recording () ;
+      // ======================================================================      
+    };
+    // ========================================================================
+    /** @class GslNoRecord
+     *  helper class to disable the recording of GSL errors 
+     *  (e.g. inside batch kernels) for the current thread in the scope 
+     *  - the errors are still counted 
+     *  @see Ostap::Utils::GslCount::record 
+     */
+    class GslNoRecord
+    {
+      //=======================================================================
+    public:
+      //=======================================================================
+      /// constructor: disable the recording 
+      GslNoRecord  () ;
+      /// destructor: restore the previous state 
+      ~GslNoRecord () ;
+      // ======================================================================
+    private :
+      // ======================================================================
+      GslNoRecord           ( const GslNoRecord& ) = delete ;
+      GslNoRecord& operator=( const GslNoRecord& ) = delete ;
+      // ======================================================================
+    private :
+      // ======================================================================
+      /// previous state 
+      bool m_previous ; // previous state 
+      // ======================================================================      
     };
     // ========================================================================
     /** @class GslException
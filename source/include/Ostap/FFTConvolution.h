@@ -0,0 +1,205 @@
+// ============================================================================
+#ifndef OSTAP_FFTCONVOLUTION_H
+#define OSTAP_FFTCONVOLUTION_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <complex>
+#include <memory>
+#include <vector>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooAbsPdf.h"
+#include "RooRealProxy.h"
+#include "RooListProxy.h"
+// ============================================================================
+// forward declarations
+// ============================================================================
+class RooRealVar ;
+// ============================================================================
+/** @file Ostap/FFTConvolution.h
+ *  FFT-convolution of two PDFs with the separate caches
+ *  for the Fourier images of the signal and the resolution
+ *  @see Ostap::Models::FFTConvolution
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Models
+  {
+    // ========================================================================
+    /** @class FFTConvolution Ostap/FFTConvolution.h
+     *  FFT-convolution of the signal PDF with the resolution PDF
+     *  \f$ f(x) = \int s(y) r(x-y) dy \f$
+     *  on the uniform grid, that covers the observable range
+     *  extended by the buffer zone on both sides.
+     *
+     *  Unlike <code>RooFFTConvPdf</code>, the Fourier images of the signal
+     *  and of the resolution are cached separately, each keyed by the values
+     *  of its own parameters, and only the changed side is resampled and
+     *  transformed (the product and the inverse transform are always redone):
+     *  - for <code>RooGaussian</code> resolution the analytic
+     *    Fourier image \f$ e^{-i\omega\mu-\omega^2\sigma^2/2} \f$ is used
+     *  - for the signal shapes from <code>Ostap::Models</code> with
+     *    the analytic integrals (CrystalBall, Apollonios, StudentT, Voigt, ...)
+     *    the grid contains the bin-integrated values,
+     *  - otherwise the shapes are sampled at the bin centers
+     *
+     *  The convolution is linearly interpolated between the grid nodes,
+     *  the integrals are analytic for the interpolant.
+     *  @see RooFFTConvPdf
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class FFTConvolution : public RooAbsPdf
+    {
+      // ======================================================================
+    public :
+      // ======================================================================
+      ClassDefOverride(Ostap::Models::FFTConvolution, 1) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param name       the name
+       *  @param title      the title
+       *  @param x          the observable
+       *  @param pdf        the signal PDF
+       *  @param resolution the resolution PDF
+       *  @param nbins      number of grid bins
+       *  @param buffer     buffer fraction (of the observable range) on each side
+       */
+      FFTConvolution
+      ( const char*          name              ,
+        const char*          title             ,
+        RooAbsReal&          x                 ,
+        RooAbsPdf&           pdf               ,
+        RooAbsPdf&           resolution        ,
+        const unsigned int   nbins      = 4096 ,
+        const double         buffer     = 0.25 ) ;
+      /// copy
+      FFTConvolution
+      ( const FFTConvolution& right    ,
+        const char*           name = 0 ) ;
+      /// destructor
+      virtual ~FFTConvolution() ;
+      /// clone
+      FFTConvolution* clone ( const char* name ) const override;
+      // ======================================================================
+    public: // some fake functionality
+      // ======================================================================
+      // fake default contructor, needed just for proper (de)serialization
+      FFTConvolution () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      // the actual evaluation of function
+      Double_t evaluate() const override;
+      // ======================================================================
+    public: // integrals
+      // ======================================================================
+      Int_t    getAnalyticalIntegral
+      ( RooArgSet&     allVars      ,
+        RooArgSet&     analVars     ,
+        const char* /* rangename */ ) const override;
+      Double_t analyticalIntegral
+      ( Int_t          code         ,
+        const char*    rangeName    ) const override;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of grid bins
+      unsigned int nbins  () const { return m_nbins  ; }
+      /// buffer fraction
+      double       buffer () const { return m_buffer ; }
+      /// analytic Fourier image of the resolution?
+      bool analyticResolution () const ;
+      /// bin-integrated sampling of the signal?
+      bool analyticSignal     () const ;
+      /// number of recalculations of the signal Fourier image
+      unsigned long nSignal     () const { return m_nsignal     ; }
+      /// number of recalculations of the resolution Fourier image
+      unsigned long nResolution () const { return m_nresolution ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// update the grid, the Fourier images and the convolution (if needed)
+      void   update    () const ;
+      /// sample the signal at the grid
+      void   signal    () const ;
+      /// sample the resolution at the grid
+      void   resolution () const ;
+      /// the integral of the interpolated convolution from the grid start
+      double primitive ( const double x ) const ;
+      /// create the unbounded observable and shallow clones of PDFs
+      void   setup     () const ;
+      // ======================================================================
+    protected :
+      // ======================================================================
+      /// the observable
+      RooRealProxy m_x          ;
+      /// the signal PDF
+      RooRealProxy m_pdf        ;
+      /// the resolution PDF
+      RooRealProxy m_resolution ;
+      /// the parameters of the signal
+      RooListProxy m_spars      ;
+      /// the parameters of the resolution
+      RooListProxy m_rpars      ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// number of grid bins
+      unsigned int m_nbins  { 4096 } ;
+      /// buffer fraction
+      double       m_buffer { 0.25 } ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the key for the signal: the grid and the parameters
+      mutable std::vector<double>                m_skey     {} ; //!
+      /// the key for the resolution: the grid and the parameters
+      mutable std::vector<double>                m_rkey     {} ; //!
+      /// Fourier image of the signal
+      mutable std::vector<std::complex<double> > m_sfft     {} ; //!
+      /// Fourier image of the resolution
+      mutable std::vector<std::complex<double> > m_rfft     {} ; //!
+      /// the convolution at the grid nodes
+      mutable std::vector<double>                m_values   {} ; //!
+      /// the cumulative integrals at the grid nodes
+      mutable std::vector<double>                m_cumul    {} ; //!
+      /// the start of the grid
+      mutable double                             m_x0       { 0 } ; //!
+      /// the grid step
+      mutable double                             m_h        { 1 } ; //!
+      /// unbounded observable for sampling outside of the range
+      mutable std::unique_ptr<RooRealVar>        m_xx       {} ; //!
+      /// shallow clone of the signal, that depends on unbounded observable
+      mutable std::unique_ptr<RooAbsPdf>         m_sclone   {} ; //!
+      /// shallow clone of the resolution, that depends on unbounded observable
+      mutable std::unique_ptr<RooAbsPdf>         m_rclone   {} ; //!
+      /// gaussian resolution: mean and sigma
+      mutable const RooAbsReal*                  m_gmean    { nullptr } ; //!
+      mutable const RooAbsReal*                  m_gsigma   { nullptr } ; //!
+      /// the setup is done?
+      mutable bool                               m_setup    { false } ; //!
+      /// counters of recalculations
+      mutable unsigned long                      m_nsignal     { 0 } ; //!
+      mutable unsigned long                      m_nresolution { 0 } ; //!
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                       The end of namespace Ostap::Models
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // OSTAP_FFTCONVOLUTION_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -8,7 +8,14 @@
 // ============================================================================
 #include "TTreeFormula.h"
 // ============================================================================
-class TCut ; // ROOT 
+// STD&STL
+// ============================================================================
+#include <string>
+#include <vector>
+#include <memory>
+// ============================================================================
+class TCut  ; // ROOT 
+class TLeaf ; // ROOT 
 // ============================================================================
 /** file Ostap/Formula.h
  *  Simple extention of class TTreeFormula 
@@ -20,6 +27,26 @@ namespace Ostap
   // ==========================================================================
   /** @class Formula Ostap/Formula.h
    *  Simple extention of class TTreeFormula for a bit easier usage in python 
+   *
+   *  Optionally (see Ostap::Formula::setJIT) the simple expressions 
+   *  (arithmetics, comparisons, logical operations and standard functions 
+   *  of scalar leaves of basic types) are compiled by cling into 
+   *  the native function, that reads the leaf buffers directly.
+   *  The compiled functions are cached by the expression and leaf types. 
+   *  Other expressions are evaluated by TTreeFormula. 
+   *  For the compiled formula the new tree in chain (see Notify) 
+   *  only re-points the leaf buffers (using the cached positions of leaves), 
+   *  and the update of TTreeFormula itself is postponed till it is needed
+   *
+   *  Optionally (see Ostap::Formula::setAdaptive) the scalar compound 
+   *  selection, e.g. <code>pt>5 && mva>0.9 && chi2<10</code>, is decomposed 
+   *  into the top-level conjuncts, each of them evaluated by its own formula. 
+   *  The conjuncts are evaluated till the first rejection, therefore 
+   *  the branches, needed only for the later conjuncts, are read only for 
+   *  the entries that survive the earlier ones. The rejection rate and the 
+   *  cost of each conjunct are measured for the first entries and 
+   *  (with sampled timing) periodically later, and the conjuncts are ordered 
+   *  by the cost per rejection. The result (1 or 0) does not depend on the order.
    *  @see TTreeFormula
    *  @author Vanya Belyaev
    *  @date   2013-05-06
@@ -63,6 +90,89 @@ namespace Ostap
     // is formula OK?
     bool   ok       () const { return this->GetNdim() ; } // is formula OK ? 
     // ========================================================================    
+  public:
+    // ========================================================================    
+    /// is the formula compiled? 
+    bool compiled   () const { return nullptr != m_jit ; }
+    /// update the leaves (e.g. for the new tree in chain) 
+    Bool_t Notify   () override ;
+    // ========================================================================    
+  public:
+    // ========================================================================    
+    /** compile the new formulas?
+     *  The default is defined by the <code>OSTAP_JIT</code> environment variable
+     */
+    static bool jit    () ;
+    /// compile the new formulas? 
+    static void setJIT ( const bool value ) ;
+    // ========================================================================    
+  public:
+    // ========================================================================    
+    /** decompose the new compound selections into adaptively ordered conjuncts?
+     *  The default is defined by the <code>OSTAP_ADAPTIVE_CUTS</code> 
+     *  environment variable (enabled if not set) 
+     */
+    static bool adaptive    () ;
+    /// decompose the new compound selections into adaptively ordered conjuncts? 
+    static void setAdaptive ( const bool value ) ;
+    // ========================================================================    
+    /// number of the conjuncts (0 if the formula is not decomposed)
+    unsigned short           nTerms () const { return m_terms.size () ; }
+    /// the conjuncts in the current order of evaluation 
+    std::vector<std::string> terms  () const ;
+    // ========================================================================    
+  private:
+    // ========================================================================    
+    /// the compiled function 
+    typedef double (*jit_function) ( const void* const* ) ;
+    // ========================================================================    
+    /// try to compile the expression 
+    void   compile_  () ;
+    /// bind the leaves for the compiled function 
+    bool   bind_     () ;
+    /// evaluate the compiled function 
+    double jit_eval_ () ;
+    /// try to decompose the expression into conjuncts 
+    void   decompose_ () ;
+    /// evaluate the conjuncts in the adaptive order 
+    double terms_eval_ () ;
+    /// reorder the conjuncts according to the collected statistics  
+    void   reorder_    () ;
+    // ========================================================================    
+  private:
+    // ========================================================================    
+    /// the compiled function 
+    jit_function               m_jit    { nullptr } ; //! 
+    /// names of the leaves for the compiled function 
+    std::vector<std::string>   m_names  {} ; //! 
+    /// types of the leaves for the compiled function 
+    std::vector<std::string>   m_types  {} ; //! 
+    /// the leaves for the compiled function 
+    std::vector<TLeaf*>        m_leaves {} ; //! 
+    /// the addresses of leaf buffers for the compiled function 
+    std::vector<const void*>   m_ptrs   {} ; //! 
+    /// positions of the leaves in the list of leaves (for fast rebinding)
+    std::vector<int>           m_index  {} ; //! 
+    /// the last loaded entry 
+    Long64_t                   m_entry  { -1 } ; //! 
+    /// TTreeFormula is not updated for the current tree (not needed for compiled formula)
+    bool                       m_stale  { false } ; //! 
+    // ========================================================================    
+    /// the conjuncts of the compound selection 
+    std::vector<std::unique_ptr<Formula> > m_terms   {} ; //! 
+    /// the current order of evaluation of the conjuncts 
+    std::vector<unsigned short>            m_order   {} ; //! 
+    /// number of evaluations of the conjuncts 
+    std::vector<double>                    m_calls   {} ; //! 
+    /// number of rejections by the conjuncts 
+    std::vector<double>                    m_rejects {} ; //! 
+    /// the measured time of the conjuncts 
+    std::vector<double>                    m_time    {} ; //! 
+    /// number of timed evaluations of the conjuncts 
+    std::vector<double>                    m_timed   {} ; //! 
+    /// number of evaluations of the compound selection 
+    unsigned long long                     m_nevals  { 0 } ; //! 
+    // ========================================================================    
   };
   // ==========================================================================
 } //                                                     End of namespace Ostap 
@@ -181,6 +181,32 @@ namespace Ostap
       double     regularization ( const double sigma     ,
                                   const double delta     ) const ;
       // ======================================================================
+    public: // FFT-based methods 
+      // ======================================================================
+      /** evaluate the sum at N equidistant points using FFT, \f$O(N\log N)\f$
+       *  \f$ x_i = x_{min} + i \frac{x_{max}-x_{min}}{N}\f$, \f$ 0 \le i < N \f$
+       *  @param N number of points 
+       *  @return the values at the points
+       */
+      std::vector<double> values ( const unsigned int N ) const ;
+      // ======================================================================
+      /** create the Fourier sum from the function values sampled at N 
+       *  equidistant points (the trigonometric interpolation) using FFT 
+       *  \f$ x_i = x_{min} + i \frac{x_{max}-x_{min}}{N}\f$, \f$ 0 \le i < N \f$
+       *  @param values the function values at the points 
+       *  @param degree the degree of the sum, \f$ 2 \times degree \le N \f$ 
+       *  @param xmin   low  edge
+       *  @param xmax   high edge
+       *  @param fejer  use fejer summation
+       *  @see Ostap::Math::FourierSum::values
+       */
+      static FourierSum fit
+      ( const std::vector<double>& values         , 
+        const unsigned short       degree         , 
+        const double               xmin   = 0     , 
+        const double               xmax   = 1     , 
+        const bool                 fejer  = false ) ;
+      // ======================================================================
     public:
       // ======================================================================
       /// simple  manipulations with polynoms: scale it!
@@ -413,6 +439,32 @@ namespace Ostap
       double    regularization ( const double sigma     ,
                                  const double delta     ) const ;
       // ======================================================================
+    public: // FFT-based methods 
+      // ======================================================================
+      /** evaluate the sum at N+1 equidistant points using FFT, \f$O(N\log N)\f$
+       *  \f$ x_i = x_{min} + i \frac{x_{max}-x_{min}}{N}\f$, \f$ 0 \le i \le N \f$
+       *  @param N number of intervals 
+       *  @return the values at the points (including both edges)
+       */
+      std::vector<double> values ( const unsigned int N ) const ;
+      // ======================================================================
+      /** create the cosine sum from the function values sampled at N+1
+       *  equidistant points (the cosine interpolation) using FFT (DCT-I)
+       *  \f$ x_i = x_{min} + i \frac{x_{max}-x_{min}}{N}\f$, \f$ 0 \le i \le N \f$
+       *  @param values the function values at the points (including both edges)
+       *  @param degree the degree of the sum, \f$ degree \le N \f$ 
+       *  @param xmin   low  edge
+       *  @param xmax   high edge
+       *  @param fejer  use fejer summation
+       *  @see Ostap::Math::CosineSum::values
+       */
+      static CosineSum fit
+      ( const std::vector<double>& values         , 
+        const unsigned short       degree         , 
+        const double               xmin   = 0     , 
+        const double               xmax   = 1     , 
+        const bool                 fejer  = false ) ;
+      // ======================================================================
     public:
       // ======================================================================
       /// simple  manipulations with polynoms: scale it!
@@ -513,6 +565,28 @@ namespace Ostap
      */
     CosineSum sum ( const CosineSum& s1 , const CosineSum& s2 ) ;
     // ========================================================================
+    /** convolve the function values, sampled at equidistant points 
+     *  \f$ x_i = x_{min} + i h \f$, \f$ h = \frac{x_{max}-x_{min}}{N}\f$,
+     *  with gaussian in the spectral domain using FFT, \f$O(N\log N)\f$
+     *  - for non-periodic data the array is padded with zeroes 
+     *    to avoid the wrap-around
+     *  - the sum of values is preserved 
+     *  @param values   the function values at the points 
+     *  @param sigma    the gaussian resolution 
+     *  @param xmin     low  edge
+     *  @param xmax     high edge
+     *  @param periodic treat the data as periodic? 
+     *  @return the convoluted values at the same points
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-02-01
+     */
+    std::vector<double> gauss_convolve 
+    ( const std::vector<double>& values           , 
+      const double               sigma            , 
+      const double               xmin             , 
+      const double               xmax             , 
+      const bool                 periodic = false ) ;
+    // ========================================================================
   } //                                             end of namespace Ostap::Math
   // ==========================================================================
 } //                                                     end of namespace Ostap
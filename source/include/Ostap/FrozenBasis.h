@@ -0,0 +1,177 @@
+// ============================================================================
+#ifndef OSTAP_FROZENBASIS_H
+#define OSTAP_FROZENBASIS_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+// ============================================================================
+/** @file Ostap/FrozenBasis.h
+ *  Precomputed ("frozen") basis matrix for the fixed set of abscissas
+ *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+ *  @date 2023-01-28
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    class Bernstein      ;
+    class Positive       ;
+    class BSpline        ;
+    class PositiveSpline ;
+    // ========================================================================
+    /** @class FrozenBasis Ostap/FrozenBasis.h
+     *  Precomputed  matrix of the basis functions for the fixed set
+     *  of points (or bins). It is useful e.g. for the binned fits,
+     *  where the function is evaluated many times at the same bin
+     *  centres with different parameters:
+     *  \f[ f(x_i) = \sum_j  M_{ij} p_j \f]
+     *  where \f$ M_{ij} = b_j(x_i) \f$ or
+     *  \f$ M_{ij} = \int_{x^{low}_i}^{x^{high}_i} b_j(x)dx \f$.
+     *
+     *  The evaluation for the whole set of points is the
+     *  dense matrix-vector product: \f$ \mathcal{O}(Nn)\f$
+     *  instead of \f$ \mathcal{O}(Nn^2)\f$.
+     *
+     *  The matrix is stored column-wise, the product is
+     *  made as sequence of "axpy" updates, easily vectorized by compiler
+     *
+     *  @attention the matrix is not updated when the
+     *             range/knots of the original function are changed!
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date 2023-01-28
+     */
+    class FrozenBasis
+    {
+    public:
+      // ======================================================================
+      /** create the basis matrix for Bernstein polynomial
+       *  \f$ M_{ij} = b_j(x_i) \f$
+       *  @param b (INPUT) Bernstein polynomial
+       *  @param x (INPUT) the points
+       */
+      FrozenBasis ( const Ostap::Math::Bernstein&  b    ,
+                    const std::vector<double>&     x    ) ;
+      // ======================================================================
+      /** create the matrix of bin integrals for Bernstein polynomial
+       *  \f$ M_{ij} = \int_{x^{low}_i}^{x^{high}_i} b_j(x)dx \f$
+       *  @param b    (INPUT) Bernstein polynomial
+       *  @param low  (INPUT) low  edges of bins
+       *  @param high (INPUT) high edges of bins
+       */
+      FrozenBasis ( const Ostap::Math::Bernstein&  b    ,
+                    const std::vector<double>&     low  ,
+                    const std::vector<double>&     high ) ;
+      // ======================================================================
+      /** create the basis matrix for positive polynomial
+       *  \f$ M_{ij} = b_j(x_i) \f$
+       *  @param p (INPUT) positive polynomial
+       *  @param x (INPUT) the points
+       */
+      FrozenBasis ( const Ostap::Math::Positive&   p    ,
+                    const std::vector<double>&     x    ) ;
+      // ======================================================================
+      /** create the matrix of bin integrals for positive polynomial
+       *  \f$ M_{ij} = \int_{x^{low}_i}^{x^{high}_i} b_j(x)dx \f$
+       *  @param p    (INPUT) positive polynomial
+       *  @param low  (INPUT) low  edges of bins
+       *  @param high (INPUT) high edges of bins
+       */
+      FrozenBasis ( const Ostap::Math::Positive&   p    ,
+                    const std::vector<double>&     low  ,
+                    const std::vector<double>&     high ) ;
+      // ======================================================================
+      /** create the basis matrix for B-spline
+       *  \f$ M_{ij} = B_j(x_i) \f$
+       *  @param b (INPUT) B-spline
+       *  @param x (INPUT) the points
+       */
+      FrozenBasis ( const Ostap::Math::BSpline&    b    ,
+                    const std::vector<double>&     x    ) ;
+      // ======================================================================
+      /** create the matrix of bin integrals for B-spline
+       *  \f$ M_{ij} = \int_{x^{low}_i}^{x^{high}_i} B_j(x)dx \f$
+       *  @param b    (INPUT) B-spline
+       *  @param low  (INPUT) low  edges of bins
+       *  @param high (INPUT) high edges of bins
+       */
+      FrozenBasis ( const Ostap::Math::BSpline&    b    ,
+                    const std::vector<double>&     low  ,
+                    const std::vector<double>&     high ) ;
+      // ======================================================================
+      /** create the basis matrix for positive spline
+       *  \f$ M_{ij} = B_j(x_i) \f$
+       *  @param p (INPUT) positive spline
+       *  @param x (INPUT) the points
+       */
+      FrozenBasis ( const Ostap::Math::PositiveSpline& p    ,
+                    const std::vector<double>&         x    ) ;
+      // ======================================================================
+      /** create the matrix of bin integrals for positive spline
+       *  \f$ M_{ij} = \int_{x^{low}_i}^{x^{high}_i} B_j(x)dx \f$
+       *  @param p    (INPUT) positive spline
+       *  @param low  (INPUT) low  edges of bins
+       *  @param high (INPUT) high edges of bins
+       */
+      FrozenBasis ( const Ostap::Math::PositiveSpline& p    ,
+                    const std::vector<double>&         low  ,
+                    const std::vector<double>&         high ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of points/bins
+      std::size_t npoints () const { return m_npoints ; }
+      /// number of basis functions
+      std::size_t nbasis  () const { return m_nbasis  ; }
+      /// get the element of the basis matrix
+      double      element ( const std::size_t i ,
+                            const std::size_t j ) const
+      { return i < m_npoints && j < m_nbasis ? m_matrix [ j * m_npoints + i ] : 0.0 ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** evaluate the function at all points
+       *  @param pars   (INPUT)  parameters: at least nbasis() elements
+       *  @param result (UPDATE) result: at least npoints() elements
+       */
+      void evaluate ( const double* pars , double* result ) const ;
+      // ======================================================================
+      /** evaluate the function at all points
+       *  @param pars   (INPUT)  parameters
+       *  @return vector of results
+       */
+      std::vector<double> evaluate ( const std::vector<double>& pars ) const ;
+      // ======================================================================
+      /// evaluate Bernstein polynomial at all points
+      std::vector<double> evaluate ( const Ostap::Math::Bernstein&      b ) const ;
+      /// evaluate positive polynomial  at all points
+      std::vector<double> evaluate ( const Ostap::Math::Positive&       p ) const ;
+      /// evaluate B-spline at all points
+      std::vector<double> evaluate ( const Ostap::Math::BSpline&        b ) const ;
+      /// evaluate positive spline at all points
+      std::vector<double> evaluate ( const Ostap::Math::PositiveSpline& p ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// number of points
+      std::size_t         m_npoints ; // number of points
+      /// number of basis functions
+      std::size_t         m_nbasis  ; // number of basis functions
+      /// the matrix (column-wise)
+      std::vector<double> m_matrix  ; // the matrix (column-wise)
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_FROZENBASIS_H
+// ============================================================================
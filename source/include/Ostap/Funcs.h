@@ -66,6 +66,16 @@ namespace Ostap
       ///  evaluate the formula for  TTree
       double operator() ( const TTree* tree ) const override ;
       // ======================================================================
+      /** evaluate the formula for the block of entries [first,last)
+       *  the tree is checked and the formulas are prepared only once
+       *  @see Ostap::IFuncTree::evaluate_range 
+       */
+      unsigned long evaluate_range 
+      ( const TTree*        tree   ,
+        const unsigned long first  , 
+        const unsigned long last   , 
+        double*             result ) const override ;
+      // ======================================================================
     public:
       // ======================================================================
       Bool_t Notify   () override ; 
@@ -133,6 +143,16 @@ namespace Ostap
       ///  evaluate the function for TTree
       double operator () ( const TTree* tree ) const override ;
       // ======================================================================
+      /** evaluate the function for the block of entries [first,last)
+       *  the tree is checked and the formulas are prepared only once
+       *  @see Ostap::IFuncTree::evaluate_range 
+       */
+      unsigned long evaluate_range 
+      ( const TTree*        tree   ,
+        const unsigned long first  , 
+        const unsigned long last   , 
+        double*             result ) const override ;
+      // ======================================================================
     public:
       // ======================================================================
       Bool_t Notify   () override ; 
@@ -210,6 +230,16 @@ namespace Ostap
       ///  evaluate the function for TTree
       double operator () ( const TTree* tree ) const override ;
       // ======================================================================
+      /** evaluate the function for the block of entries [first,last)
+       *  the tree is checked and the formulas are prepared only once
+       *  @see Ostap::IFuncTree::evaluate_range 
+       */
+      unsigned long evaluate_range 
+      ( const TTree*        tree   ,
+        const unsigned long first  , 
+        const unsigned long last   , 
+        double*             result ) const override ;
+      // ======================================================================
     public:
       // ======================================================================
       Bool_t Notify   () override ; 
@@ -298,6 +328,16 @@ namespace Ostap
       ///  evaluate the function for TTree
       double operator () ( const TTree* tree ) const override ;
       // ======================================================================
+      /** evaluate the function for the block of entries [first,last)
+       *  the tree is checked and the formulas are prepared only once
+       *  @see Ostap::IFuncTree::evaluate_range 
+       */
+      unsigned long evaluate_range 
+      ( const TTree*        tree   ,
+        const unsigned long first  , 
+        const unsigned long last   , 
+        double*             result ) const override ;
+      // ======================================================================
     public:
       // ======================================================================
       Bool_t Notify   () override ; 
@@ -0,0 +1,209 @@
+// ============================================================================
+#ifndef OSTAP_FUSEDVAR_H
+#define OSTAP_FUSEDVAR_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <string>
+#include <vector>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RVersion.h"
+#include "RooAbsReal.h"
+#include "RooListProxy.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/BatchCompute.h"
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace MoreRooFit
+  {
+    // ========================================================================
+    /** @class FusedVar Ostap/FusedVar.h
+     *  "Fused" expression variable: the arithmetic subtree built from
+     *  the small Ostap::MoreRooFit variables is collapsed into the
+     *  single node with the flat stack-based program
+     *
+     *  The following nodes are fused:
+     *   - RooAddition  (and Ostap::MoreRooFit::Addition, Subtraction)
+     *   - RooProduct   (real-valued components only)
+     *   - Ostap::MoreRooFit::Division, Fraction, Asymmetry, Combination,
+     *     Power, Atan2, Id
+     *   - Ostap::MoreRooFit::Abs, Exp, Log, Log10, Erf, Erfc, Gamma, LGamma,
+     *     IGamma, Sin, Cos, Tan, Sinh, Cosh, Tanh, Sech
+     *   - RooConstVar (stored as constant)
+     *  All other nodes (variables, PDFs, formulae, FunOneVar/FunTwoVars, ...)
+     *  are the "leaves" of the program: they are the only servers of the
+     *  fused variable, therefore the dependency tracking is preserved.
+     *  Shared leaves are loaded once.
+     *
+     *  For many evaluations (e.g. in the batch mode) the whole tree is
+     *  evaluated column-wise in one pass without intermediate RooFit nodes
+     *
+     *  @code
+     *  Ostap::MoreRooFit::Exp      e  ( "e" , "" , a , b ) ;
+     *  Ostap::MoreRooFit::Addition s  ( "s" , "" , e , c ) ;
+     *  Ostap::MoreRooFit::FusedVar fs ( "fs" , "" , s ) ; /// servers: a, b, c
+     *  @endcode
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-03-21
+     */
+    class FusedVar : public RooAbsReal
+    {
+      // ========================================================================
+      ClassDefOverride(Ostap::MoreRooFit::FusedVar , 1 ) ;  // fused expression
+      // ========================================================================
+    public:
+      // ========================================================================
+      /// the opcodes of the program
+      enum Operation {
+        LOAD        = 0  , // push the leaf
+        CONST            , // push the constant
+        ADD              , // a + b
+        SUBTRACT         , // a - b
+        MULTIPLY         , // a * b
+        DIVIDE           , // a / b
+        FRACTION         , // a / ( a + b )
+        ASYMMETRY        , // scale * ( a - b ) / ( a + b )
+        COMBINATION      , // alpha * a * ( beta + gamma * b )
+        POWER            , // a ^ b
+        ATAN2            , // atan2 ( a , b )
+        ABS              , // |a|
+        EXP              , // exp   ( a )
+        LOG              , // log   ( a )
+        LOG10            , // log10 ( a )
+        ERF              , // erf   ( a )
+        ERFC             , // erfc  ( a )
+        GAMMA            , // tgamma( a )
+        LGAMMA           , // lgamma( a )
+        IGAMMA           , // 1/tgamma ( a )
+        SIN              , // sin   ( a )
+        COS              , // cos   ( a )
+        TAN              , // tan   ( a )
+        SINH             , // sinh  ( a )
+        COSH             , // cosh  ( a )
+        TANH             , // tanh  ( a )
+        SECH             , // sech  ( a )
+        LAST_OPERATION
+      } ;
+      // ========================================================================
+    public:
+      // ========================================================================
+      /** constructor from the expression tree
+       *  @param name  the name
+       *  @param title the title
+       *  @param root  the root of expression tree
+       */
+      FusedVar ( const std::string& name  ,
+                 const std::string& title ,
+                 const RooAbsReal&  root  ) ;
+      /// constructor from the expression tree
+      FusedVar ( const RooAbsReal&  root         ,
+                 const std::string& name  = ""   ,
+                 const std::string& title = ""   )
+        : FusedVar ( name , title , root )
+      {}
+      /** full constructor (e.g. for deserialization)
+       *  @param name      the name
+       *  @param title     the title
+       *  @param leaves    the leaves
+       *  @param program   the program: pairs (opcode, argument)
+       *  @param constants the constants
+       */
+      FusedVar ( const std::string&                name      ,
+                 const std::string&                title     ,
+                 const RooArgList&                 leaves    ,
+                 const std::vector<unsigned int>&  program   ,
+                 const std::vector<double>&        constants ) ;
+      /// default constructor
+      FusedVar () = default ;
+      /// copy
+      FusedVar ( const FusedVar& right       ,
+                 const char*     newname = 0 ) ;
+      /// destructor
+      virtual ~FusedVar () ;
+      /// clone
+      FusedVar* clone ( const char* newname ) const override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the leaves of the expression
+      const RooArgList&                leaves    () const { return m_leaves    ; }
+      /// the program: pairs (opcode, argument)
+      const std::vector<unsigned int>& program   () const { return m_program   ; }
+      /// the constants
+      const std::vector<double>&       constants () const { return m_constants ; }
+      /// number of instructions
+      inline std::size_t size  () const { return m_program.size () / 2 ; }
+      /// the maximal depth of the stack
+      inline std::size_t depth () const { return m_depth ; }
+      /// the human-readable listing of the program
+      std::string        listing () const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** run the program column-wise
+       *  @param output  (OUTPUT) the output column of size <code>n</code>
+       *  @param n       the number of entries
+       *  @param columns the input columns (one for each leaf)
+       *  @param sizes   the sizes of the input columns: 1 or <code>n</code>
+       */
+      void evaluate_columns
+      ( double*                           output  ,
+        const std::size_t                 n       ,
+        const std::vector<const double*>& columns ,
+        const std::vector<std::size_t>&   sizes   ) const ;
+      // ======================================================================
+      // ======================================================================
+      /// evaluate the batch
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
+      // ======================================================================
+    protected:
+      // ======================================================================
+      /// the actual evaluation of the result
+      Double_t evaluate () const override ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// compile the subtree into the program
+      void compile ( const RooAbsReal& node ) ;
+      /// add the instruction
+      void emit    ( const unsigned int op  , const unsigned int arg = 0 ) ;
+      /// check the program and calculate the depth of the stack
+      void check   () ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the leaves
+      RooListProxy              m_leaves    {} ; // the leaves
+      /// the program: pairs (opcode, argument)
+      std::vector<unsigned int> m_program   {} ; // the program
+      /// the constants
+      std::vector<double>       m_constants {} ; // the constants
+      /// the maximal depth of the stack
+      unsigned int              m_depth     { 0 } ; // the depth
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the stack (transient)
+      mutable std::vector<double>               m_stack   {} ;
+      /// the stack of columns (transient)
+      mutable std::vector<std::vector<double> > m_columns {} ;
+      // ======================================================================
+    }; //
+    // ========================================================================
+  } //                               The end of namespace Ostap::MoreRooFit
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_FUSEDVAR_H
+// ============================================================================
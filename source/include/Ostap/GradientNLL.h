@@ -0,0 +1,180 @@
+// ============================================================================
+#ifndef OSTAP_GRADIENTNLL_H
+#define OSTAP_GRADIENTNLL_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <memory>
+#include <string>
+#include <vector>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooAbsReal.h"
+#include "RooListProxy.h"
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class RooAbsPdf  ; // RooFit
+class RooAbsData ; // RooFit
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace MoreRooFit
+  {
+    // ========================================================================
+    /** @class GradientNLL Ostap/GradientNLL.h
+     *  Unbinned negative log-likelihood with the analytic gradient
+     *  for the commonly used 1D shapes:
+     *  - Ostap::Models::CrystalBall
+     *  - Ostap::Models::CrystalBallDS
+     *  - Ostap::Models::Apollonios
+     *  - Ostap::Models::StudentT
+     *  - Ostap::Models::PolyPositive
+     *  - the extended <code>RooAddPdf</code> of these shapes with yields
+     *
+     *  The derivatives of \f$ \log f \f$ with respect to the parameters
+     *  are calculated analytically event-by-event
+     *  (see e.g. Ostap::Math::CrystalBall::dlogpdf), therefore
+     *  the value and the full gradient are obtained in one pass over data.
+     *  The derivatives of the normalization integrals do not depend on data
+     *  and are calculated via the (analytic) integrals of shapes.
+     *
+     *  - the observable range is the range of the observable
+     *  - the events are processed by blocks in parallel and the partial sums
+     *    are combined in the fixed order
+     *  - the values of observable stay resident for all iterations;
+     *    without the gradient the shapes are evaluated per block with their
+     *    array kernels and the log-sum is reduced block-wise,
+     *    only the scalar NLL is returned
+     *
+     *  @code
+     *  GradientNLL nll ( "nll" , "nll" , pdf , data ) ;
+     *  nll.migrad () ;
+     *  @endcode
+     *  @attention for weighted data the uncertainties are not corrected
+     *  @see Ostap::MoreRooFit::ParallelNLL
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class GradientNLL : public RooAbsReal
+    {
+      // ======================================================================
+      ClassDefOverride(Ostap::MoreRooFit::GradientNLL , 1 ) ;  // NLL with gradient
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param name       the name
+       *  @param title      the title
+       *  @param pdf        the PDF
+       *  @param data       the data
+       *  @param nthreads   the number of threads
+       *                    (0: the size of ROOT MT pool or hardware concurrency)
+       */
+      GradientNLL
+      ( const std::string&  name                ,
+        const std::string&  title               ,
+        const RooAbsPdf&    pdf                 ,
+        const RooAbsData&   data                ,
+        const unsigned int  nthreads   = 0      ) ;
+      /// copy
+      GradientNLL ( const GradientNLL& right       ,
+                    const char*        newname = 0 ) ;
+      /// default constructor, needed for serialization
+      GradientNLL () ;
+      /// destructor
+      virtual ~GradientNLL () ;
+      /// clone
+      GradientNLL* clone ( const char* newname ) const override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// error level for the minimizer
+      Double_t defaultErrorLevel () const override { return 0.5 ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// is the PDF supported?
+      static bool supported ( const RooAbsPdf& pdf ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// extended likelihood?
+      bool              extended   () const { return m_extended   ; }
+      /// number of threads
+      unsigned int      nThreads   () const { return m_nthreads   ; }
+      /// number of events
+      std::size_t       nEvents    () const { return m_values.size () ; }
+      /// the parameters (the order of the gradient components)
+      const RooArgList& parameters () const { return m_parameters ; }
+      // ======================================================================
+      /** get the value and the gradient with respect to parameters
+       *  @param gradient (OUTPUT) the gradient
+       *  @return the value of negative log-likelihood
+       */
+      double nll ( std::vector<double>& gradient ) const ;
+      // ======================================================================
+      /** minimize NLL using Minuit2 with the analytic gradient
+       *  the values and errors of parameters are updated
+       *  @param strategy   Minuit strategy
+       *  @param tolerance  the tolerance
+       *  @param printlevel print level
+       *  @return status of the minimization (0 for success)
+       */
+      int migrad ( const int    strategy   =  1   ,
+                   const double tolerance  =  0.1 ,
+                   const int    printlevel = -1   ) ;
+      // ======================================================================
+    protected:
+      // ======================================================================
+      /// the actual evaluation of the result
+      Double_t evaluate () const override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      class Model ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// get the model
+      Model& model_ () const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the parameters
+      RooListProxy             m_parameters {} ; // the parameters
+      /// extended likelihood?
+      bool                     m_extended   { false } ;
+      /// number of threads
+      unsigned int             m_nthreads   { 1 } ;
+      /// the name of observable
+      std::string              m_observable {} ;
+      /// the observable range
+      double                   m_low        { 0 } ;
+      double                   m_high       { 0 } ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the original PDF (not owned)
+      const RooAbsPdf*         m_pdf        { nullptr } ; //!
+      /// the values of observable
+      std::vector<double>      m_values     {} ; //!
+      /// the event weights
+      std::vector<double>      m_weights    {} ; //!
+      /// the model: shapes, yields and the thread pool
+      mutable std::unique_ptr<Model> m_model {} ; //!
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                   The end of namespace Ostap::MoreRooFit
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_GRADIENTNLL_H
+// ============================================================================
@@ -190,6 +190,35 @@ namespace Ostap
                 const std::string&          zvar             , 
                 const TTree*                tree  =  nullptr ) ;
       // ======================================================================
+      /** constructor from the 3D sparse histogram (e.g. <code>THnSparse</code>)
+       *  @see Ostap::Math::SparseHisto3D 
+       *  @param histo         (INPUT) the historgam 
+       *  @param xvar          (INPUT) the expression/variable 
+       *  @param yvar          (INPUT) the expression/variable 
+       *  @param zvar          (INPUT) the expression/variable 
+       *  @param tree          (INPUT) the tree 
+       *  @param tx            (INPUT) interpolation type 
+       *  @param ty            (INPUT) interpolation type 
+       *  @param tz            (INPUT) interpolation type 
+       *  @param edges         (INPUT) special tretament of edges?
+       *  @param extrapolate   (INPUT) use extrapolation?
+       *  @param density       (INPUT) use  density?
+       */
+      FuncTH3 ( const THnBase&       histo                     , 
+                const std::string&   xvar                      , 
+                const std::string&   yvar                      , 
+                const std::string&   zvar                      , 
+                const TTree*         tree           =  nullptr ,
+                const Ostap::Math::HistoInterpolation::Type tx = 
+                Ostap::Math::HistoInterpolation::Default       ,
+                const Ostap::Math::HistoInterpolation::Type ty = 
+                Ostap::Math::HistoInterpolation::Default       , 
+                const Ostap::Math::HistoInterpolation::Type tz =
+                Ostap::Math::HistoInterpolation::Default       , 
+                const bool           edges          = true     ,
+                const bool           extrapolate    = false    , 
+                const bool           density        = false    );
+      // ======================================================================
       // copy contructor
       // ======================================================================
       FuncTH3 ( const FuncTH3& right ) ;
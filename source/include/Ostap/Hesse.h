@@ -4,6 +4,10 @@
 // ============================================================================
 // Include files
 // ============================================================================
+// STD & STL
+// ============================================================================
+#include <cstddef>
+// ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/StatusCode.h"
@@ -27,6 +31,20 @@ namespace Ostap
       // ======================================================================
       /** @class Hesse Ostap/Hesse.h
        *  evaluate the hessian for the function
+       *
+       *  The second derivatives are evaluated along n(n+1)/2 directions
+       *  (the axes and the diagonals), and these evaluations are independent. 
+       *  For the expensive functions they can be executed in parallel: 
+       *  - each thread gets its own copy of the parameters, 
+       *    created by the user-provided <code>clone</code> function 
+       *    and destroyed by the <code>release</code> function; 
+       *  - without <code>clone</code> all threads share the same parameters, 
+       *    and the function must be thread-safe. 
+       *
+       *  The function values are cached per direction: the central point 
+       *  is evaluated only once, and the step-size refinements use 
+       *  the stencils from the dyadic ladder <code>h*2^k</code>, 
+       *  that reuse the already evaluated points. 
        *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
        *  @date 2012-05-27
        */      
@@ -36,6 +54,10 @@ namespace Ostap
         // ====================================================================
         /// the actual type of function to be used for hessian calculation 
         typedef double (*function) ( const gsl_vector  * x, void* params ) ;
+        /// create the independent copy of parameters for the separate thread  
+        typedef void*  (*clone)    ( void* params ) ;
+        /// destroy the copy of parameters, created by <code>clone</code>
+        typedef void   (*release)  ( void* params ) ;
         // ====================================================================
       public:
         // ====================================================================
@@ -49,6 +71,23 @@ namespace Ostap
                 const gsl_vector* x      ,
                 void*             params , 
                 const double      h      ) ;
+        // ====================================================================
+        /*  constructor with all parameters 
+         *  @param f        the function to be used 
+         *  @param x        the point for hessian to be evaluated 
+         *  @param params   the parameters for the function 
+         *  @param h        the step-size (guess)
+         *  @param nthreads number of threads, 0 means all available 
+         *  @param c        clone parameters for the separate thread 
+         *  @param r        release the cloned parameters 
+         */
+        Hesse ( function           f        ,
+                const gsl_vector*  x        ,
+                void*              params   , 
+                const double       h        , 
+                const unsigned int nthreads , 
+                clone              c = 0    , 
+                release            r = 0    ) ;
         /// destructor 
         ~Hesse() ;                                                // destructor 
         // ====================================================================
@@ -74,6 +113,10 @@ namespace Ostap
         const gsl_matrix* hesse () const { return m_hesse ; }
         /// get the inverse hesse ("covariance") matrix 
         const gsl_matrix* cov2  () const { return m_cov2  ; }
+        /// number of threads 
+        unsigned int      nthreads () const { return m_nthreads ; }
+        /// number of function calls for the last <code>calcHesse</code>
+        unsigned long     ncalls   () const { return m_ncalls   ; }
         // ====================================================================
       private:
         // ====================================================================
@@ -85,6 +128,14 @@ namespace Ostap
         void*             m_params ; // the parameters 
         /// step-size 
         double            m_h      ; // the step-size 
+        /// number of threads 
+        unsigned int      m_nthreads ; // number of threads 
+        /// clone parameters 
+        clone             m_clone    ; // clone parameters 
+        /// release cloned parameters 
+        release           m_release  ; // release cloned parameters  
+        /// number of function calls 
+        unsigned long     m_ncalls   ; // number of function calls 
         // ====================================================================
       private:
         // ====================================================================
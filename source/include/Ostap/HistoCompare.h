@@ -0,0 +1,148 @@
+// ============================================================================
+#ifndef OSTAP_HISTOCOMPARE_H
+#define OSTAP_HISTOCOMPARE_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <utility>
+#include <vector>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/ValueWithError.h"
+// ============================================================================
+// forward declarations
+// ============================================================================
+class TH1    ; // ROOT
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class HistoCompare   Ostap/HistoCompare.h
+     *  Bin-by-bin comparison metrics for the pairs of histograms
+     *  with the same binning (1D, 2D and 3D):
+     *  - \f$\chi^2\f$ and number of degrees of freedom
+     *  - "discrete" \f$ \cos \theta \f$
+     *  - "discrete" distance between the scaled histograms
+     *  - the minimal and maximal bin-by-bin difference
+     *
+     *  The metrics are identical to the python versions from
+     *  <code>ostap.histos.compare</code> (<code>cmp_chi2</code>,
+     *  <code>cmp_dcos</code>, <code>cmp_ddist</code>, <code>cmp_minmax</code>)
+     *  for the histograms with the same binning.
+     *  The list of pairs can be processed in parallel.
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class HistoCompare
+    {
+    public :
+      // ======================================================================
+      /// the metric for the (parallel) comparison of many pairs
+      enum Metric
+        {
+          Chi2     = 0 , ///< chi2/ndf
+          Prob         , ///< chi2-probability
+          CosTheta     , ///< the "discrete" cos(theta)
+          Distance     , ///< the "discrete" distance
+          MinDiff      , ///< the minimal bin-by-bin difference h2-h1
+          MaxDiff        ///< the maximal bin-by-bin difference h2-h1
+        } ;
+      // ======================================================================
+      /** @struct MinMax
+       *  the minimal and the maximal bin-by-bin difference <code>h2-h1</code>
+       *  and the bins where they are reached
+       */
+      struct MinMax
+      {
+        int                          ixmin { 0 } ;
+        int                          iymin { 0 } ;
+        int                          izmin { 0 } ;
+        Ostap::Math::ValueWithError  vmin  {   } ;
+        int                          ixmax { 0 } ;
+        int                          iymax { 0 } ;
+        int                          izmax { 0 } ;
+        Ostap::Math::ValueWithError  vmax  {   } ;
+      } ;
+      // ======================================================================
+    public :
+      // ======================================================================
+      /** do two histograms have the same dimension and the same binning?
+       *  @param h1 the first histogram
+       *  @param h2 the second histogram
+       */
+      static bool same_binning
+      ( const TH1* h1 ,
+        const TH1* h2 ) ;
+      // ======================================================================
+      /** \f$\chi^2\f$-comparison of two histograms
+       *  \f$ \chi^2 = \sum_i \frac{ (v_{1,i}-v_{2,i})^2}{\sigma^2_{1,i}+\sigma^2_{2,i}}\f$
+       *  @param h1 the first histogram
+       *  @param h2 the second histogram (the same binning)
+       *  @return pair \f$ (\chi^2,n_{DoF}) \f$
+       */
+      static std::pair<double,unsigned long> chi2
+      ( const TH1* h1 ,
+        const TH1* h2 ) ;
+      // ======================================================================
+      /** "discrete" \f$\cos\theta\f$ for two histograms:
+       *  \f$ \cos \theta = \frac{ f_1 \cdot f_2 } { \left|f_1\right|\left|f_2\right| }\f$,
+       *  where the scalar product is the sum over bins weighted with the bin volume
+       *  @param h1 the first histogram
+       *  @param h2 the second histogram (the same binning)
+       */
+      static Ostap::Math::ValueWithError cos_theta
+      ( const TH1* h1 ,
+        const TH1* h2 ) ;
+      // ======================================================================
+      /** "discrete" distance for two scaled histograms
+       *  \f$ d = \left| f_1^{*} - f_2^{*} \right|^{1/2} \f$,
+       *  where \f$ f^* \f$-are scaled histograms, such \f$ \left| f^*\right| = 1 \f$
+       *  @param h1 the first histogram
+       *  @param h2 the second histogram (the same binning)
+       */
+      static Ostap::Math::ValueWithError distance
+      ( const TH1* h1 ,
+        const TH1* h2 ) ;
+      // ======================================================================
+      /** the minimal and maximal bin-by-bin difference <code>h2-h1</code>
+       *  @param h1 the first histogram
+       *  @param h2 the second histogram (the same binning)
+       */
+      static MinMax minmax
+      ( const TH1* h1 ,
+        const TH1* h2 ) ;
+      // ======================================================================
+      /** compare many pairs of histograms (in parallel)
+       *  @code
+       *  std::vector<const TH1*> h1 = ... ;
+       *  std::vector<const TH1*> h2 = ... ;
+       *  auto result = HistoCompare::compare ( HistoCompare::Chi2 , h1 , h2 ) ;
+       *  @endcode
+       *  @param metric   the metric
+       *  @param h1       the first histograms
+       *  @param h2       the second histograms
+       *  @param nthreads number of threads, 0 means "all"
+       *  @return the metric for each pair
+       */
+      static std::vector<double> compare
+      ( const Metric                   metric       ,
+        const std::vector<const TH1*>& h1           ,
+        const std::vector<const TH1*>& h2           ,
+        const unsigned int             nthreads = 0 ) ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_HISTOCOMPARE_H
+// ============================================================================
@@ -5,8 +5,9 @@
 // ============================================================================
 // Forward declarations 
 // ============================================================================
-class TH1    ; // ROOT 
-class TGraph ; // ROOT
+class TH1        ; // ROOT 
+class TGraph     ; // ROOT
+class RooAbsData ; // RooFit 
 // ============================================================================
 namespace Ostap
 {
@@ -26,12 +27,36 @@ namespace Ostap
      */
     std::size_t hash_histo ( const TH1* hist      ) ;
     // ========================================================================
+    /** get the content hash for the given histogram: the type, 
+     *  the binning, the bin contents and the errors, 
+     *  but not the name or the title. 
+     *  The raw storage of the histogram is hashed block-by-block, 
+     *  therefore it is cheap even for very large histograms.
+     *  It can be used as key for the content-addressed cache of 
+     *  the objects, derived from the histogram
+     *  @param histo the historgam  
+     *  @return hash value 
+     */
+    std::size_t hash_histo_content ( const TH1* hist ) ;
+    // ========================================================================
     /*  get hash for the given axis 
      *  @param axis the axis 
      *  @return hash value 
      */
     std::size_t hash_axis  ( const TAxis* axis )  ;
     // ========================================================================    
+    /** get the content hash for the given dataset: the names and 
+     *  types of variables, the number of entries, the values and 
+     *  the weights, but not the name or the title of the dataset.
+     *  The values are hashed block-by-block, 
+     *  therefore it is cheap even for large datasets. 
+     *  It can be used as key for the content-addressed cache of 
+     *  the objects, derived from the dataset (e.g. fit results) 
+     *  @param data the dataset 
+     *  @return hash value 
+     */
+    std::size_t hash_data_content ( const RooAbsData* data ) ;
+    // ========================================================================    
   } //                                        The end of namepsace Ostap::Utils 
   // ==========================================================================
 } //                                                 The end of namespace Ostap 
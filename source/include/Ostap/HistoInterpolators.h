@@ -12,9 +12,20 @@
 #include "TH2D.h"
 #include "TH3D.h"
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+// ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/HistoInterpolation.h"
+#include "Ostap/HistoTables.h"
+// ============================================================================
+// Forward declarations 
+// ============================================================================
+class THnBase ; // from ROOT 
 // ============================================================================
 namespace Ostap 
 {
@@ -92,15 +103,12 @@ namespace Ostap
     public:
       // ======================================================================
       inline double operator () ( const double x ) const 
-      {
-        return Ostap::Math::HistoInterpolation::interpolate_1D
-          ( m_h , x , m_t , 
-            edges () , extrapolate () , density () );                    
-      }
+      { return m_table.value ( x ) ; }
       // ======================================================================
     public:
       // ======================================================================
       const TH1D&                           h () const  { return m_h ; }
+      const Ostap::Math::HistoTable1D&      table () const { return m_table ; }
       Ostap::Math::HistoInterpolation::Type t () const  { return m_t ; }      
       // ======================================================================
     private :
@@ -110,6 +118,8 @@ namespace Ostap
       // ======================================================================
       /// interpolation type 
       Ostap::Math::HistoInterpolation::Type m_t { Ostap::Math::HistoInterpolation::Default };
+      /// the compiled interpolation table 
+      Ostap::Math::HistoTable1D             m_table {} ;
       // ======================================================================
     };
     // ========================================================================
@@ -145,15 +155,12 @@ namespace Ostap
       // ======================================================================
       inline double operator () ( const double x , 
                                   const double y ) const 
-      {
-        return Ostap::Math::HistoInterpolation::interpolate_2D
-          ( m_h , x , y , m_tx , m_ty , 
-            edges () , extrapolate () , density () );                    
-      }
+      { return m_table.value ( x , y ) ; }
       // ======================================================================
     public:
       // ======================================================================
       const TH2D&                           h  () const  { return m_h  ; }
+      const Ostap::Math::HistoTable2D&      table () const { return m_table ; }
       Ostap::Math::HistoInterpolation::Type tx () const  { return m_tx ; }      
       Ostap::Math::HistoInterpolation::Type ty () const  { return m_ty ; }      
       // ======================================================================
@@ -166,6 +173,8 @@ namespace Ostap
       Ostap::Math::HistoInterpolation::Type m_tx { Ostap::Math::HistoInterpolation::Default };
       /// interpolation type 
       Ostap::Math::HistoInterpolation::Type m_ty { Ostap::Math::HistoInterpolation::Default };
+      /// the compiled interpolation table 
+      Ostap::Math::HistoTable2D             m_table {} ;
       // ======================================================================
     };
     // ========================================================================
@@ -204,15 +213,12 @@ namespace Ostap
       inline double operator () ( const double x , 
                                   const double y ,
                                   const double z ) const 
-      {
-        return Ostap::Math::HistoInterpolation::interpolate_3D
-          ( m_h ,  x  ,  y  ,  z  , m_tx  ,  m_ty  ,  m_tx , 
-            edges () , extrapolate () , density () );                    
-      }
+      { return m_table.value ( x , y , z ) ; }
       // ======================================================================
     public:
       // ======================================================================
       const TH3D&                           h  () const  { return m_h  ; }
+      const Ostap::Math::HistoTable3D&      table () const { return m_table ; }
       Ostap::Math::HistoInterpolation::Type tx () const  { return m_tx ; }      
       Ostap::Math::HistoInterpolation::Type ty () const  { return m_ty ; }      
       Ostap::Math::HistoInterpolation::Type tz () const  { return m_tz ; }      
@@ -228,6 +234,78 @@ namespace Ostap
       Ostap::Math::HistoInterpolation::Type m_ty { Ostap::Math::HistoInterpolation::Default };
       /// interpolation type 
       Ostap::Math::HistoInterpolation::Type m_tz { Ostap::Math::HistoInterpolation::Default };
+      /// the compiled interpolation table 
+      Ostap::Math::HistoTable3D             m_table {} ;
+      // ======================================================================
+    };
+    // ========================================================================
+    /** @class SparseHisto3D HistoInterpolators.h Ostap/HistoInterpolators.h
+     *  Simple function object/histogram interpolator for 
+     *  the 3D sparse histogram (e.g. <code>THnSparse</code>)
+     *  - only non-empty bins are kept 
+     *  - <code>Nearest</code> and <code>Linear</code> interpolations are supported, 
+     *    higher orders fall back to <code>Linear</code>
+     *  @see Ostap::Math::Histo3D
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2026-10-15
+     */
+    class SparseHisto3D : HistoInterpolator 
+    {
+    public:
+      // ======================================================================
+      /** constructor with full  specification 
+       *  @see Ostap::Math::HistoInterpolation
+       */
+      SparseHisto3D 
+      ( const THnBase& histo , 
+        const Ostap::Math::HistoInterpolation::Type tx = 
+        Ostap::Math::HistoInterpolation::Default ,
+        const Ostap::Math::HistoInterpolation::Type ty = 
+        Ostap::Math::HistoInterpolation::Default ,
+        const Ostap::Math::HistoInterpolation::Type tz = 
+        Ostap::Math::HistoInterpolation::Default ,
+        const bool edges       = true  , 
+        const bool extrapolate = false , 
+        const bool density     = false ) ;
+      // ======================================================================
+      /// default  constructor 
+      SparseHisto3D () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      double operator () ( const double x , 
+                           const double y ,
+                           const double z ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of non-empty bins 
+      std::size_t                           size () const { return m_bins.size () ; }
+      Ostap::Math::HistoInterpolation::Type tx   () const { return m_tx ; }      
+      Ostap::Math::HistoInterpolation::Type ty   () const { return m_ty ; }      
+      Ostap::Math::HistoInterpolation::Type tz   () const { return m_tz ; }      
+      // ======================================================================
+    private :
+      // ======================================================================
+      /// content of the bin (0 for empty/missing bins)
+      double content ( const int ix , const int iy , const int iz ) const ;
+      // ======================================================================
+    private :
+      // ======================================================================
+      /// bin edges 
+      std::vector<double>                   m_x  {} ;
+      /// bin edges 
+      std::vector<double>                   m_y  {} ;
+      /// bin edges 
+      std::vector<double>                   m_z  {} ;
+      /// non-empty bins: (ix,iy,iz) -> content 
+      std::unordered_map<std::uint64_t,double> m_bins {} ;
+      /// interpolation type 
+      Ostap::Math::HistoInterpolation::Type m_tx { Ostap::Math::HistoInterpolation::Default };
+      /// interpolation type 
+      Ostap::Math::HistoInterpolation::Type m_ty { Ostap::Math::HistoInterpolation::Default };
+      /// interpolation type 
+      Ostap::Math::HistoInterpolation::Type m_tz { Ostap::Math::HistoInterpolation::Default };
       // ======================================================================
     };
 
@@ -0,0 +1,125 @@
+// ============================================================================
+#ifndef OSTAP_HISTOPARAM_H
+#define OSTAP_HISTOPARAM_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <vector>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/StatusCode.h"
+// ============================================================================
+// forward declarations
+// ============================================================================
+class TH1 ; // from ROOT
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    class LegendreSum  ;
+    class ChebyshevSum ;
+    class Polynomial   ;
+    class Bernstein    ;
+    class BSpline      ;
+    // ========================================================================
+    /** @class HistoParam Ostap/HistoParam.h
+     *  Parameterization of 1D-histograms as linear combination of basis
+     *  functions (Legendre, Chebyshev, monomial, Bernstein and B-spline)
+     *  with the direct linear least-squares fit:
+     *  \f$ \chi^2 = \sum_i \frac{1}{\sigma_i^2} \left( h_i - \sum_k a_k \bar{B}_{ki} \right)^2 \f$,
+     *  where \f$ \bar{B}_{ki}\f$ is the average of basis function
+     *  \f$ B_k\f$ over the bin \f$ i \f$ (the "frozen" design matrix,
+     *  built from the basis integrals over bins),
+     *  and all coefficients are obtained with one solution of normal equations.
+     *  - only bins with centers in the range of the function and
+     *    non-zero uncertainties are used
+     *  - the non-negative solution can be required:
+     *    for Bernstein polynomials and B-splines it gives non-negative function
+     *  - for many histograms the design matrix is built only once
+     *    (for the same binning) and the histograms are processed in parallel
+     *  @see Ostap::Math::Chi2Solver
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class HistoParam
+    {
+    public:
+      // ======================================================================
+      /** fit the histogram with the linear combination of basis functions
+       *  @param histo       (INPUT)  the histogram
+       *  @param func        (UPDATE) the function, its parameters are updated
+       *  @param nonnegative (INPUT)  non-negative coefficients ?
+       *  @return status code
+       */
+      static StatusCode fit
+      ( const TH1&                 histo               ,
+        Ostap::Math::LegendreSum&  func                ,
+        const bool                 nonnegative = false ) ;
+      static StatusCode fit
+      ( const TH1&                 histo               ,
+        Ostap::Math::ChebyshevSum& func                ,
+        const bool                 nonnegative = false ) ;
+      static StatusCode fit
+      ( const TH1&                 histo               ,
+        Ostap::Math::Polynomial&   func                ,
+        const bool                 nonnegative = false ) ;
+      static StatusCode fit
+      ( const TH1&                 histo               ,
+        Ostap::Math::Bernstein&    func                ,
+        const bool                 nonnegative = false ) ;
+      static StatusCode fit
+      ( const TH1&                 histo               ,
+        Ostap::Math::BSpline&      func                ,
+        const bool                 nonnegative = false ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** fit many histograms (in parallel)
+       *  @param histos      (INPUT) the histograms
+       *  @param func        (INPUT) the function (the basis and the range)
+       *  @param nonnegative (INPUT) non-negative coefficients ?
+       *  @param nthreads    (INPUT) number of threads, 0 means "all"
+       *  @return fitted functions, one per histogram
+       */
+      static std::vector<Ostap::Math::LegendreSum> fit_many
+      ( const std::vector<const TH1*>&   histos              ,
+        const Ostap::Math::LegendreSum&  func                ,
+        const bool                       nonnegative = false ,
+        const unsigned int               nthreads    = 0     ) ;
+      static std::vector<Ostap::Math::ChebyshevSum> fit_many
+      ( const std::vector<const TH1*>&   histos              ,
+        const Ostap::Math::ChebyshevSum& func                ,
+        const bool                       nonnegative = false ,
+        const unsigned int               nthreads    = 0     ) ;
+      static std::vector<Ostap::Math::Polynomial> fit_many
+      ( const std::vector<const TH1*>&   histos              ,
+        const Ostap::Math::Polynomial&   func                ,
+        const bool                       nonnegative = false ,
+        const unsigned int               nthreads    = 0     ) ;
+      static std::vector<Ostap::Math::Bernstein> fit_many
+      ( const std::vector<const TH1*>&   histos              ,
+        const Ostap::Math::Bernstein&    func                ,
+        const bool                       nonnegative = false ,
+        const unsigned int               nthreads    = 0     ) ;
+      static std::vector<Ostap::Math::BSpline> fit_many
+      ( const std::vector<const TH1*>&   histos              ,
+        const Ostap::Math::BSpline&      func                ,
+        const bool                       nonnegative = false ,
+        const unsigned int               nthreads    = 0     ) ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                             end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                     end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_HISTOPARAM_H
+// ============================================================================
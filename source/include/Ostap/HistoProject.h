@@ -7,6 +7,8 @@
 // STD & STL
 // ============================================================================
 #include <limits>
+#include <string>
+#include <vector>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -18,12 +20,18 @@
 class TH1       ;     // ROOT 
 class TH2       ;     // ROOT 
 class TH3       ;     // ROOT 
+class THnBase   ;     // ROOT 
+class TTree     ;     // ROOT 
 // =============================================================================
-class RooAbsData ; // RooFit 
-class RooAbsReal ; // RooFit 
+class RooAbsData  ; // RooFit 
+class RooAbsReal  ; // RooFit 
+class RooDataHist ; // RooFit 
 // =============================================================================
 namespace Ostap
 {  
+  // ==========================================================================
+  class BinStat ;
+  class BinReplicas ;
   // ==========================================================================
   #if ROOT_VERSION_CODE< ROOT_VERSION(6,14,4)
     typedef ROOT::Experimental::TDataFrame DataFrame ;
@@ -150,6 +158,324 @@ namespace Ostap
       const unsigned long first      = 0                                         ,
       const unsigned long last       = std::numeric_limits<unsigned long>::max() ) ;
     // ========================================================================
+  public: // TTree 
+    // ========================================================================
+    /** make a projection of TTree/TChain into the histogram 
+     *  @param tree       (INPUT)  input tree 
+     *  @param histo      (UPDATE) histogram 
+     *  @param expression (INPUT)  expression
+     *  @param selection  (INPUT)  selection criteria/weight 
+     *  @param first      (INPUT)  the first event to process 
+     *  @param last       (INPUT)  the last event to process 
+     */
+    static Ostap::StatusCode project
+    ( TTree*              tree            , 
+      TH1*                histo           ,
+      const std::string&  expression      ,
+      const std::string&  selection  = "" ,
+      const unsigned long first      = 0                                         ,
+      const unsigned long last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** make a projection of TTree/TChain into the 2D-histogram 
+     *  @param tree        (INPUT)  input tree 
+     *  @param histo       (UPDATE) histogram 
+     *  @param xexpression (INPUT)  expression for x-axis 
+     *  @param yexpression (INPUT)  expression for y-axis 
+     *  @param selection   (INPUT)  selection criteria/weight 
+     *  @param first       (INPUT)  the first event to process 
+     *  @param last        (INPUT)  the last event to process 
+     */
+    static Ostap::StatusCode project2
+    ( TTree*              tree            , 
+      TH2*                histo           ,
+      const std::string&  xexpression     ,
+      const std::string&  yexpression     ,
+      const std::string&  selection  = "" ,
+      const unsigned long first      = 0                                         ,
+      const unsigned long last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** make a projection of TTree/TChain into the 3D-histogram 
+     *  @param tree        (INPUT)  input tree 
+     *  @param histo       (UPDATE) histogram 
+     *  @param xexpression (INPUT)  expression for x-axis 
+     *  @param yexpression (INPUT)  expression for y-axis 
+     *  @param zexpression (INPUT)  expression for z-axis 
+     *  @param selection   (INPUT)  selection criteria/weight 
+     *  @param first       (INPUT)  the first event to process 
+     *  @param last        (INPUT)  the last event to process 
+     */
+    static Ostap::StatusCode project3
+    ( TTree*              tree            , 
+      TH3*                histo           ,
+      const std::string&  xexpression     ,
+      const std::string&  yexpression     ,
+      const std::string&  zexpression     ,
+      const std::string&  selection  = "" ,
+      const unsigned long first      = 0                                         ,
+      const unsigned long last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+  public: // TTree, multithreaded 
+    // ========================================================================
+    /** make a multithreaded projection of TTree/TChain into the histogram 
+     *  - the range of entries is split into chunks, aligned with tree clusters
+     *  - each chunk is filled into the private clone of the histogram 
+     *    using the own copy of the tree/chain  
+     *  - the clones are merged with <code>TH1::Add</code> in the order of chunks
+     *  - single-precision histograms (e.g. <code>TH3F</code>) are accumulated 
+     *    into per-thread double-precision buffers instead of clones, 
+     *    and rounded only once at the end 
+     *  For trees that are not read from files, it falls back to 
+     *  the sequential processing 
+     *  @param tree       (INPUT)  input tree 
+     *  @param histo      (UPDATE) histogram 
+     *  @param expression (INPUT)  expression
+     *  @param selection  (INPUT)  selection criteria/weight 
+     *  @param nthreads   (INPUT)  number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @param first      (INPUT)  the first event to process 
+     *  @param last       (INPUT)  the last event to process 
+     */
+    static Ostap::StatusCode projectMT
+    ( TTree*              tree            , 
+      TH1*                histo           ,
+      const std::string&  expression      ,
+      const std::string&  selection  = "" ,
+      const unsigned int  nthreads   = 0  , 
+      const unsigned long first      = 0                                         ,
+      const unsigned long last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** make a multithreaded projection of TTree/TChain into the 2D-histogram 
+     *  @param tree        (INPUT)  input tree 
+     *  @param histo       (UPDATE) histogram 
+     *  @param xexpression (INPUT)  expression for x-axis 
+     *  @param yexpression (INPUT)  expression for y-axis 
+     *  @param selection   (INPUT)  selection criteria/weight 
+     *  @param nthreads    (INPUT)  number of threads 
+     *  @param first       (INPUT)  the first event to process 
+     *  @param last        (INPUT)  the last event to process 
+     *  @see Ostap::HistoProject::projectMT 
+     */
+    static Ostap::StatusCode project2MT
+    ( TTree*              tree            , 
+      TH2*                histo           ,
+      const std::string&  xexpression     ,
+      const std::string&  yexpression     ,
+      const std::string&  selection  = "" ,
+      const unsigned int  nthreads   = 0  , 
+      const unsigned long first      = 0                                         ,
+      const unsigned long last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** make a multithreaded projection of TTree/TChain into the 3D-histogram 
+     *  @param tree        (INPUT)  input tree 
+     *  @param histo       (UPDATE) histogram 
+     *  @param xexpression (INPUT)  expression for x-axis 
+     *  @param yexpression (INPUT)  expression for y-axis 
+     *  @param zexpression (INPUT)  expression for z-axis 
+     *  @param selection   (INPUT)  selection criteria/weight 
+     *  @param nthreads    (INPUT)  number of threads 
+     *  @param first       (INPUT)  the first event to process 
+     *  @param last        (INPUT)  the last event to process 
+     *  @see Ostap::HistoProject::projectMT 
+     */
+    static Ostap::StatusCode project3MT
+    ( TTree*              tree            , 
+      TH3*                histo           ,
+      const std::string&  xexpression     ,
+      const std::string&  yexpression     ,
+      const std::string&  zexpression     ,
+      const std::string&  selection  = "" ,
+      const unsigned int  nthreads   = 0  , 
+      const unsigned long first      = 0                                         ,
+      const unsigned long last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+  public: // TTree, N-dimensional (sparse) histograms 
+    // ========================================================================
+    /** make a (multithreaded) projection of TTree/TChain into 
+     *  N-dimensional histogram, e.g. <code>THnSparse</code>
+     *  - only the non-empty bins are kept for the sparse histograms,
+     *    that is much more economical for the large, mostly empty 
+     *    multidimensional histograms (e.g. resolution maps)
+     *  - each chunk is filled into the private clone of the histogram 
+     *    and the clones are merged in the order of chunks 
+     *  @param tree        (INPUT)  input tree 
+     *  @param histo       (UPDATE) histogram 
+     *  @param expressions (INPUT)  expressions for the axes 
+     *  @param selection   (INPUT)  selection criteria/weight 
+     *  @param nthreads    (INPUT)  number of threads (1: sequential processing)
+     *  @param first       (INPUT)  the first event to process 
+     *  @param last        (INPUT)  the last event to process 
+     */
+    static Ostap::StatusCode projectN
+    ( TTree*                          tree            , 
+      THnBase*                        histo           ,
+      const std::vector<std::string>& expressions     ,
+      const std::string&              selection  = "" ,
+      const unsigned int              nthreads   = 1  , 
+      const unsigned long             first      = 0                                         ,
+      const unsigned long             last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** make a projection of TTree/TChain into the 3D sparse histogram 
+     *  @see Ostap::HistoProject::projectN 
+     */
+    static Ostap::StatusCode project3
+    ( TTree*              tree            , 
+      THnBase*            histo           ,
+      const std::string&  xexpression     ,
+      const std::string&  yexpression     ,
+      const std::string&  zexpression     ,
+      const std::string&  selection  = "" ,
+      const unsigned long first      = 0                                         ,
+      const unsigned long last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** make a multithreaded projection of TTree/TChain into the 3D sparse histogram 
+     *  @see Ostap::HistoProject::projectN 
+     */
+    static Ostap::StatusCode project3MT
+    ( TTree*              tree            , 
+      THnBase*            histo           ,
+      const std::string&  xexpression     ,
+      const std::string&  yexpression     ,
+      const std::string&  zexpression     ,
+      const std::string&  selection  = "" ,
+      const unsigned int  nthreads   = 0  , 
+      const unsigned long first      = 0                                         ,
+      const unsigned long last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+  public: // TTree -> RooDataHist 
+    // ========================================================================
+    /** make a direct (multithreaded) projection of TTree/TChain into 
+     *  the binned dataset, without the intermediate <code>RooDataSet</code>
+     *  or histogram, in a single (parallel) pass
+     *  - the bins are defined by the binnings of the observables of the dataset
+     *  - the entries outside the ranges of the observables are skipped 
+     *    (as for <code>RooDataSet</code>)
+     *  - each chunk is accumulated into the private double-precision buffer 
+     *    of weights and squared weights, the buffers are merged in the order of chunks 
+     *  @code
+     *  RooRealVar  mass ( "mass" , "" , 5.2 , 5.4 ) ; mass.setBins ( 100 ) ;
+     *  RooDataHist data ( "data" , "" , RooArgSet ( mass ) ) ;
+     *  Ostap::HistoProject::project ( tree , &data , {} , "w*(chi2<10)" , 0 ) ;
+     *  @endcode 
+     *  @param tree        (INPUT)  input tree 
+     *  @param data        (UPDATE) binned dataset with real observables 
+     *  @param expressions (INPUT)  expressions for the observables (in the order of 
+     *                              <code>data->get()</code>), empty: names of the observables 
+     *  @param selection   (INPUT)  selection criteria/weight 
+     *  @param nthreads    (INPUT)  number of threads (1: sequential processing)
+     *  @param first       (INPUT)  the first event to process 
+     *  @param last        (INPUT)  the last event to process 
+     */
+    static Ostap::StatusCode project
+    ( TTree*                          tree            , 
+      RooDataHist*                    data            ,
+      const std::vector<std::string>& expressions     ,
+      const std::string&              selection  = "" ,
+      const unsigned int              nthreads   = 1  , 
+      const unsigned long             first      = 0                                         ,
+      const unsigned long             last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+  public: // per-bin statistics
+    // ========================================================================
+    /** project TTree/TChain into the per-bin statistics of the value,
+     *  in bins of the model histogram, in a single (parallel) pass
+     *  - the range of entries is split into chunks, aligned with tree clusters
+     *  - each chunk is accumulated into the private copy of the statistics 
+     *  - the copies are merged in the order of chunks 
+     *  @code
+     *  TH2D model ( "m" , "" , 10 , 0 , 10 , 10 , -5 , 5 ) ;
+     *  Ostap::BinStat stat ( model ) ;
+     *  Ostap::HistoProject::profile ( tree , stat , { "pt" , "eta" } , "mass" , "w" , 0 ) ;
+     *  @endcode 
+     *  @param tree        (INPUT)  input tree 
+     *  @param result      (UPDATE) the per-bin statistics 
+     *  @param expressions (INPUT)  expressions for the axes of the model histogram 
+     *  @param value       (INPUT)  expression for the value 
+     *  @param selection   (INPUT)  selection criteria/weight 
+     *  @param nthreads    (INPUT)  number of threads (1: sequential processing)
+     *  @param first       (INPUT)  the first event to process 
+     *  @param last        (INPUT)  the last event to process 
+     *  @see Ostap::BinStat
+     */
+    static Ostap::StatusCode profile
+    ( TTree*                          tree            , 
+      Ostap::BinStat&                 result          ,
+      const std::vector<std::string>& expressions     ,
+      const std::string&              value           ,
+      const std::string&              selection  = "" ,
+      const unsigned int              nthreads   = 1  , 
+      const unsigned long             first      = 0                                         ,
+      const unsigned long             last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** project RooAbsData into the per-bin statistics of the value,
+     *  in bins of the model histogram 
+     *  @param data        (INPUT)  input data 
+     *  @param result      (UPDATE) the per-bin statistics 
+     *  @param expressions (INPUT)  expressions for the axes of the model histogram 
+     *  @param value       (INPUT)  expression for the value 
+     *  @param selection   (INPUT)  selection criteria/weight 
+     *  @param first       (INPUT)  the first event to process 
+     *  @param last        (INPUT)  the last event to process 
+     *  @see Ostap::BinStat
+     */
+    static Ostap::StatusCode profile
+    ( const RooAbsData*               data            , 
+      Ostap::BinStat&                 result          ,
+      const std::vector<std::string>& expressions     ,
+      const std::string&              value           ,
+      const std::string&              selection  = "" ,
+      const unsigned long             first      = 0                                         ,
+      const unsigned long             last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+  public: // Poisson-bootstrap replicas 
+    // ========================================================================
+    /** project TTree/TChain into the Poisson-bootstrap replicas of the 
+     *  model histogram, in a single (parallel) pass
+     *  - each entry gets N Poisson(1) weights, defined by the seed 
+     *    of the replicas and the entry number only, and it is added 
+     *    to all replicas at once 
+     *  - the range of entries is split into chunks, aligned with tree clusters
+     *  - each chunk is accumulated into the private copy of the replicas 
+     *  - the copies are merged in the order of chunks 
+     *  @code
+     *  TH1D model ( "m" , "" , 20 , 0 , 10 ) ;
+     *  Ostap::BinReplicas reps ( model , 200 , 12345 ) ;
+     *  Ostap::HistoProject::replicas ( tree , reps , { "pt" } , "w" , 0 ) ;
+     *  @endcode 
+     *  @param tree        (INPUT)  input tree 
+     *  @param result      (UPDATE) the replicas 
+     *  @param expressions (INPUT)  expressions for the axes of the model histogram 
+     *  @param selection   (INPUT)  selection criteria/weight 
+     *  @param nthreads    (INPUT)  number of threads (1: sequential processing)
+     *  @param first       (INPUT)  the first event to process 
+     *  @param last        (INPUT)  the last event to process 
+     *  @see Ostap::BinReplicas
+     */
+    static Ostap::StatusCode replicas
+    ( TTree*                          tree            , 
+      Ostap::BinReplicas&             result          ,
+      const std::vector<std::string>& expressions     ,
+      const std::string&              selection  = "" ,
+      const unsigned int              nthreads   = 1  , 
+      const unsigned long             first      = 0                                         ,
+      const unsigned long             last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** project RooAbsData into the Poisson-bootstrap replicas of the 
+     *  model histogram, in a single pass
+     *  @param data        (INPUT)  input data 
+     *  @param result      (UPDATE) the replicas 
+     *  @param expressions (INPUT)  expressions for the axes of the model histogram 
+     *  @param selection   (INPUT)  selection criteria/weight 
+     *  @param first       (INPUT)  the first event to process 
+     *  @param last        (INPUT)  the last event to process 
+     *  @see Ostap::BinReplicas
+     */
+    static Ostap::StatusCode replicas
+    ( const RooAbsData*               data            , 
+      Ostap::BinReplicas&             result          ,
+      const std::vector<std::string>& expressions     ,
+      const std::string&              selection  = "" ,
+      const unsigned long             first      = 0                                         ,
+      const unsigned long             last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
   public:  //   DataFrame 
     // ========================================================================
     /** make a projection of DataFrame into the histogram 
@@ -0,0 +1,368 @@
+// ============================================================================
+#ifndef OSTAP_HISTOTABLES_H
+#define OSTAP_HISTOTABLES_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <vector>
+#include <cstddef>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/ValueWithError.h"
+#include "Ostap/HistoInterpolation.h"
+// ============================================================================
+// forward declarations
+// ============================================================================
+class TAxis ; // from ROOT
+class TH1   ; // from ROOT
+class TH2   ; // from ROOT
+class TH3   ; // from ROOT
+// ============================================================================
+/** @file Ostap/HistoTables.h
+ *  "Compiled" histogram interpolation tables:
+ *  the content of the histogram is copied into the flat array,
+ *  the axes are converted into the lookup tables, and the queries
+ *  are pure arithmetic without (virtual) calls to ROOT,
+ *  but with the same results as
+ *  Ostap::Math::HistoInterpolation::interpolate_1D/2D/3D
+ *  @see Ostap::Math::HistoInterpolation
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2023-01-31
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class HistoAxisTable HistoTables.h Ostap/HistoTables.h
+     *  The lookup table for the histogram axis:
+     *  the bin edges, bin centres and the adjusted interpolation type
+     *  @see TAxis
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2023-01-31
+     */
+    class HistoAxisTable
+    {
+    public:
+      // ======================================================================
+      /** @struct Stencil
+       *  The interpolation stencil along the axis:
+       *  - (0-based) indices of the bins
+       *  - weights for the values
+       *  - weights for the squared uncertainties
+       */
+      struct Stencil
+      {
+        unsigned short n       { 0 } ;
+        std::size_t    i [ 4 ] {   } ;
+        double         w [ 4 ] {   } ;
+        double         e [ 4 ] {   } ;
+      } ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** constructor from the axis
+       *  @param axis the axis
+       *  @param t    interpolation type
+       */
+      HistoAxisTable
+      ( const TAxis&                                axis ,
+        const Ostap::Math::HistoInterpolation::Type t    =
+        Ostap::Math::HistoInterpolation::Default ) ;
+      /// default constructor: empty axis
+      HistoAxisTable () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** get the stencil for the given point
+       *  @param x           the point
+       *  @param s           (OUTPUT) the stencil
+       *  @param edges       special treatment of edges?
+       *  @param extrapolate extrapolation?
+       *  @param closed      is the upper edge of the axis included?
+       *  @return false if the point is outside the axis
+       */
+      bool stencil
+      ( const double x                 ,
+        Stencil&     s                 ,
+        const bool   edges             ,
+        const bool   extrapolate       ,
+        const bool   closed     = true ) const ;
+      // ======================================================================
+      /// find the bin, the same as TAxis::FindFixBin
+      unsigned int find ( const double x ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of bins
+      unsigned int nbins   () const { return m_nbins   ; }
+      /// low edge of the axis
+      double       xmin    () const { return m_xmin    ; }
+      /// high edge of the axis
+      double       xmax    () const { return m_xmax    ; }
+      /// uniform binning?
+      bool         uniform () const { return m_uniform ; }
+      /// the adjusted interpolation type
+      Ostap::Math::HistoInterpolation::Type t () const { return m_t ; }
+      /// the bin width (1-based index, as for TAxis)
+      double width  ( const unsigned int i ) const
+      { return m_edges [ i ] - m_edges [ i - 1 ] ; }
+      /// the bin centre (1-based index, as for TAxis)
+      double centre ( const unsigned int i ) const
+      { return m_centres [ i - 1 ] ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// number of bins
+      unsigned int         m_nbins   { 0     } ;
+      /// low edge
+      double               m_xmin    { 0     } ;
+      /// high edge
+      double               m_xmax    { 0     } ;
+      /// uniform binning ?
+      bool                 m_uniform { true  } ;
+      /// the adjusted interpolation type
+      Ostap::Math::HistoInterpolation::Type m_t { Ostap::Math::HistoInterpolation::Nearest } ;
+      /// bin edges
+      std::vector<double>  m_edges   {       } ;
+      /// bin centres, the same as TAxis::GetBinCenter
+      std::vector<double>  m_centres {       } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class HistoTable1D HistoTables.h Ostap/HistoTables.h
+     *  "Compiled" interpolation table for 1D-histogram
+     *  @see Ostap::Math::HistoInterpolation::interpolate_1D
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2023-01-31
+     */
+    class HistoTable1D
+    {
+    public:
+      // ======================================================================
+      /** constructor with full specification
+       *  @see Ostap::Math::HistoInterpolation::interpolate_1D
+       */
+      HistoTable1D
+      ( const TH1& histo ,
+        const Ostap::Math::HistoInterpolation::Type t =
+        Ostap::Math::HistoInterpolation::Default ,
+        const bool edges       = true  ,
+        const bool extrapolate = false ,
+        const bool density     = false ) ;
+      /// default constructor
+      HistoTable1D () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// interpolated value with uncertainty
+      Ostap::Math::ValueWithError operator() ( const double x ) const ;
+      /// interpolated value
+      double value ( const double x ) const ;
+      // ======================================================================
+      /** batched evaluation of values
+       *  @param x      (INPUT)  the array of points
+       *  @param n      (INPUT)  number of points
+       *  @param result (OUTPUT) the array of results
+       */
+      void eval
+      ( const double*     x      ,
+        const std::size_t n      ,
+        double*           result ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      inline bool  edges       () const { return m_edges       ; }
+      inline bool  extrapolate () const { return m_extrapolate ; }
+      inline bool  density     () const { return m_density     ; }
+      const HistoAxisTable& xaxis () const { return m_xaxis ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// special treatment of edges?
+      bool                m_edges       { true  } ;
+      /// extrapolate?
+      bool                m_extrapolate { false } ;
+      /// density?
+      bool                m_density     { false } ;
+      /// the axis
+      HistoAxisTable      m_xaxis  {} ;
+      /// bin contents
+      std::vector<double> m_values {} ;
+      /// squared uncertainties
+      std::vector<double> m_errors {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class HistoTable2D HistoTables.h Ostap/HistoTables.h
+     *  "Compiled" interpolation table for 2D-histogram
+     *  @see Ostap::Math::HistoInterpolation::interpolate_2D
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2023-01-31
+     */
+    class HistoTable2D
+    {
+    public:
+      // ======================================================================
+      /** constructor with full specification
+       *  @see Ostap::Math::HistoInterpolation::interpolate_2D
+       */
+      HistoTable2D
+      ( const TH2& histo ,
+        const Ostap::Math::HistoInterpolation::Type tx =
+        Ostap::Math::HistoInterpolation::Default ,
+        const Ostap::Math::HistoInterpolation::Type ty =
+        Ostap::Math::HistoInterpolation::Default ,
+        const bool edges       = true  ,
+        const bool extrapolate = false ,
+        const bool density     = false ) ;
+      /// default constructor
+      HistoTable2D () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// interpolated value with uncertainty
+      Ostap::Math::ValueWithError operator()
+        ( const double x ,
+          const double y ) const ;
+      /// interpolated value
+      double value
+      ( const double x ,
+        const double y ) const ;
+      // ======================================================================
+      /** batched evaluation of values
+       *  @param x      (INPUT)  the array of x-values
+       *  @param y      (INPUT)  the array of y-values
+       *  @param n      (INPUT)  number of points
+       *  @param result (OUTPUT) the array of results
+       */
+      void eval
+      ( const double*     x      ,
+        const double*     y      ,
+        const std::size_t n      ,
+        double*           result ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      inline bool  edges       () const { return m_edges       ; }
+      inline bool  extrapolate () const { return m_extrapolate ; }
+      inline bool  density     () const { return m_density     ; }
+      const HistoAxisTable& xaxis () const { return m_xaxis ; }
+      const HistoAxisTable& yaxis () const { return m_yaxis ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// special treatment of edges?
+      bool                m_edges       { true  } ;
+      /// extrapolate?
+      bool                m_extrapolate { false } ;
+      /// density?
+      bool                m_density     { false } ;
+      /// x-axis
+      HistoAxisTable      m_xaxis  {} ;
+      /// y-axis
+      HistoAxisTable      m_yaxis  {} ;
+      /// bin contents, x runs fastest
+      std::vector<double> m_values {} ;
+      /// squared uncertainties, x runs fastest
+      std::vector<double> m_errors {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class HistoTable3D HistoTables.h Ostap/HistoTables.h
+     *  "Compiled" interpolation table for 3D-histogram
+     *  @see Ostap::Math::HistoInterpolation::interpolate_3D
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2023-01-31
+     */
+    class HistoTable3D
+    {
+    public:
+      // ======================================================================
+      /** constructor with full specification
+       *  @see Ostap::Math::HistoInterpolation::interpolate_3D
+       */
+      HistoTable3D
+      ( const TH3& histo ,
+        const Ostap::Math::HistoInterpolation::Type tx =
+        Ostap::Math::HistoInterpolation::Default ,
+        const Ostap::Math::HistoInterpolation::Type ty =
+        Ostap::Math::HistoInterpolation::Default ,
+        const Ostap::Math::HistoInterpolation::Type tz =
+        Ostap::Math::HistoInterpolation::Default ,
+        const bool edges       = true  ,
+        const bool extrapolate = false ,
+        const bool density     = false ) ;
+      /// default constructor
+      HistoTable3D () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// interpolated value with uncertainty
+      Ostap::Math::ValueWithError operator()
+        ( const double x ,
+          const double y ,
+          const double z ) const ;
+      /// interpolated value
+      double value
+      ( const double x ,
+        const double y ,
+        const double z ) const ;
+      // ======================================================================
+      /** batched evaluation of values
+       *  @param x      (INPUT)  the array of x-values
+       *  @param y      (INPUT)  the array of y-values
+       *  @param z      (INPUT)  the array of z-values
+       *  @param n      (INPUT)  number of points
+       *  @param result (OUTPUT) the array of results
+       */
+      void eval
+      ( const double*     x      ,
+        const double*     y      ,
+        const double*     z      ,
+        const std::size_t n      ,
+        double*           result ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      inline bool  edges       () const { return m_edges       ; }
+      inline bool  extrapolate () const { return m_extrapolate ; }
+      inline bool  density     () const { return m_density     ; }
+      const HistoAxisTable& xaxis () const { return m_xaxis ; }
+      const HistoAxisTable& yaxis () const { return m_yaxis ; }
+      const HistoAxisTable& zaxis () const { return m_zaxis ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// special treatment of edges?
+      bool                m_edges       { true  } ;
+      /// extrapolate?
+      bool                m_extrapolate { false } ;
+      /// density?
+      bool                m_density     { false } ;
+      /// x-axis
+      HistoAxisTable      m_xaxis  {} ;
+      /// y-axis
+      HistoAxisTable      m_yaxis  {} ;
+      /// z-axis
+      HistoAxisTable      m_zaxis  {} ;
+      /// bin contents, x runs fastest
+      std::vector<double> m_values {} ;
+      /// squared uncertainties, x runs fastest
+      std::vector<double> m_errors {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                     The END
+// ============================================================================
+#endif // OSTAP_HISTOTABLES_H
+// ============================================================================
@@ -21,6 +21,24 @@ namespace Ostap
     // ========================================================================
     /// evaluate the function from TTree 
     virtual double     operator () ( const TTree* tree ) const = 0 ;
+    // ========================================================================
+    /** evaluate the function for the block of entries [first,last) 
+     *  and fill the output buffer (it must have at least last-first elements)
+     *  @param tree   the tree 
+     *  @param first  the first entry
+     *  @param last   the last entry (exclusive)
+     *  @param result the output buffer 
+     *  @return number of evaluated entries 
+     *  The default implementation reads the entries one-by-one and invokes
+     *  <code>operator()</code>, the concrete classes can (and should) 
+     *  override it with more efficient loop 
+     */
+    virtual unsigned long evaluate_range 
+    ( const TTree*        tree   ,
+      const unsigned long first  , 
+      const unsigned long last   , 
+      double*             result ) const ;
+    // ========================================================================
     /// virtual destructor 
     virtual ~IFuncTree  () ;
     // ========================================================================
@@ -0,0 +1,282 @@
+// ============================================================================
+#ifndef OSTAP_INSTRUMENT_H
+#define OSTAP_INSTRUMENT_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <atomic>
+#include <string>
+#include <vector>
+// ============================================================================
+#if defined ( __x86_64__ ) || defined ( __i386__ )
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+// ============================================================================
+/** @file Ostap/Instrument.h
+ *  Opt-in low-overhead instrumentation of the hot paths:
+ *  per-probe call counters and the cumulative time (in TSC ticks),
+ *  and per-stage memory counters (RSS and the peak RSS growth)
+ *
+ *  The probes are compiled only if <code>OSTAP_INSTRUMENT</code> is defined
+ *  (cmake option <code>-DOSTAP_INSTRUMENT=ON</code>), otherwise
+ *  the macros <code>OSTAP_PROBE</code>, <code>OSTAP_COUNT</code>
+ *  and <code>OSTAP_MEMORY_STAGE</code>
+ *  expand to nothing. Even for the instrumented build the probes are
+ *  inactive until <code>Ostap::Instrument::enable()</code> is invoked,
+ *  the inactive probe costs one relaxed atomic load.
+ *
+ *  @code
+ *  double MyPdf::evaluate () const
+ *  {
+ *    OSTAP_PROBE ( "MyPdf::evaluate" ) ;  // count calls and time of the scope
+ *    ...
+ *  }
+ *  ...
+ *  if ( found ) { OSTAP_COUNT ( "MyCache::hit" ) ; } // count only
+ *  @endcode
+ *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Instrument
+  {
+    // ========================================================================
+    /// the global switch: are the probes active?
+    extern std::atomic<bool> s_active ;
+    // ========================================================================
+    /// are the probes active?
+    inline bool active  () { return s_active.load ( std::memory_order_relaxed ) ; }
+    // ========================================================================
+    /// are the probes compiled?  (built with OSTAP_INSTRUMENT?)
+    bool compiled       () ;
+    /// activate/deactivate the probes, return the previous state
+    bool enable         ( const bool value = true ) ;
+    /// deactivate the probes, return the previous state
+    inline bool disable () { return enable ( false ) ; }
+    /// reset all counters (including the memory counters)
+    void reset          () ;
+    // ========================================================================
+    /// read the time stamp counter (or the monotonic clock, if TSC is not available)
+    inline unsigned long long ticks ()
+    {
+#if defined ( __x86_64__ ) || defined ( __i386__ )
+      return __rdtsc () ;
+#else
+      return std::chrono::duration_cast<std::chrono::nanoseconds>
+        ( std::chrono::steady_clock::now().time_since_epoch() ).count () ;
+#endif
+    }
+    /// number of ticks per second (calibrated once)
+    double ticks_per_second () ;
+    // ========================================================================
+    /** @class Counter Ostap/Instrument.h
+     *  The counter of calls and the cumulative number of ticks for the probe.
+     *  Counters are static objects, they are registered at construction
+     *  and are never destroyed before the end of the job
+     */
+    class Counter
+    {
+    public:
+      // ======================================================================
+      /// constructor with the name, the counter is registered
+      Counter ( const char* name ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// add the call
+      inline void add ( const unsigned long long nticks = 0 )
+      {
+        m_calls.fetch_add ( 1      , std::memory_order_relaxed ) ;
+        m_ticks.fetch_add ( nticks , std::memory_order_relaxed ) ;
+      }
+      /// reset the counter
+      void reset () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      const std::string& name  () const { return m_name ; }
+      unsigned long long calls () const { return m_calls.load ( std::memory_order_relaxed ) ; }
+      unsigned long long ticks () const { return m_ticks.load ( std::memory_order_relaxed ) ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      Counter           ( const Counter& ) = delete ;
+      Counter& operator=( const Counter& ) = delete ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      std::string                     m_name      ;
+      std::atomic<unsigned long long> m_calls { 0 } ;
+      std::atomic<unsigned long long> m_ticks { 0 } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class Probe Ostap/Instrument.h
+     *  Scoped probe: counts the call and the ticks spent in the scope
+     */
+    class Probe
+    {
+    public:
+      // ======================================================================
+      Probe ( Counter& counter )
+        : m_counter ( active () ? &counter : nullptr )
+        , m_start   ( m_counter ? Ostap::Instrument::ticks () : 0 )
+      {}
+      ~Probe ()
+      { if ( m_counter ) { m_counter->add ( Ostap::Instrument::ticks () - m_start ) ; } }
+      // ======================================================================
+    private:
+      // ======================================================================
+      Probe           ( const Probe& ) = delete ;
+      Probe& operator=( const Probe& ) = delete ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      Counter*           m_counter ;
+      unsigned long long m_start   ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class Entry Ostap/Instrument.h
+     *  The snapshot of the counter
+     */
+    struct Entry
+    {
+      std::string        name   {} ;
+      unsigned long long calls  {} ;
+      unsigned long long ticks  {} ;
+      double             time   {} ; // in seconds
+    } ;
+    // ========================================================================
+    /// get the snapshot of all (non-empty) counters, sorted by time
+    std::vector<Entry> counters ( const bool all = false ) ;
+    // ========================================================================
+    /** @class MemoryCounter Ostap/Instrument.h
+     *  The memory counter for the pipeline stage (read, evaluate, fill, merge, ...):
+     *  number of calls, the maximal resident set size at the stage exit and
+     *  the maximal growth of the peak resident set size during the stage.
+     *  Counters are static objects, they are registered at construction
+     *  and are never destroyed before the end of the job
+     *  @see Ostap::Utils::rss
+     *  @see Ostap::Utils::peak_rss
+     */
+    class MemoryCounter
+    {
+    public:
+      // ======================================================================
+      /// constructor with the name, the counter is registered
+      MemoryCounter ( const char* name ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// add the call with the RSS at exit and the growth of the peak RSS
+      void add   ( const unsigned long long rss    ,
+                   const unsigned long long growth ) ;
+      /// reset the counter
+      void reset () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      const std::string& name   () const { return m_name ; }
+      unsigned long long calls  () const { return m_calls .load ( std::memory_order_relaxed ) ; }
+      unsigned long long rss    () const { return m_rss   .load ( std::memory_order_relaxed ) ; }
+      unsigned long long growth () const { return m_growth.load ( std::memory_order_relaxed ) ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      MemoryCounter           ( const MemoryCounter& ) = delete ;
+      MemoryCounter& operator=( const MemoryCounter& ) = delete ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      std::string                     m_name       ;
+      std::atomic<unsigned long long> m_calls  { 0 } ;
+      std::atomic<unsigned long long> m_rss    { 0 } ;
+      std::atomic<unsigned long long> m_growth { 0 } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class MemoryStage Ostap/Instrument.h
+     *  Scoped pipeline stage: records RSS and the peak RSS growth for the scope
+     */
+    class MemoryStage
+    {
+    public:
+      // ======================================================================
+      MemoryStage  ( MemoryCounter& counter ) ;
+      ~MemoryStage () ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      MemoryStage           ( const MemoryStage& ) = delete ;
+      MemoryStage& operator=( const MemoryStage& ) = delete ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      MemoryCounter*     m_counter ;
+      unsigned long long m_peak    ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class MemoryEntry Ostap/Instrument.h
+     *  The snapshot of the memory counter
+     */
+    struct MemoryEntry
+    {
+      std::string        name   {} ;
+      unsigned long long calls  {} ;
+      unsigned long long rss    {} ; // maximal RSS at exit  (bytes)
+      unsigned long long growth {} ; // maximal peak RSS growth (bytes)
+    } ;
+    // ========================================================================
+    /// get the snapshot of all (non-empty) memory counters, in order of registration
+    std::vector<MemoryEntry> memory_counters ( const bool all = false ) ;
+    // ========================================================================
+  } //                                  The end of namespace Ostap::Instrument
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#define OSTAP_INSTRUMENT_CONCAT_( a , b ) a##b
+#define OSTAP_INSTRUMENT_CONCAT( a , b ) OSTAP_INSTRUMENT_CONCAT_( a , b )
+// ============================================================================
+#ifdef OSTAP_INSTRUMENT
+// ============================================================================
+/// count the calls and the time of the current scope
+#define OSTAP_PROBE( NAME )                                               \
+  static Ostap::Instrument::Counter                                       \
+  OSTAP_INSTRUMENT_CONCAT ( s_ostap_counter_ , __LINE__ ) { NAME } ;      \
+  const Ostap::Instrument::Probe                                          \
+  OSTAP_INSTRUMENT_CONCAT ( ostap_probe_ , __LINE__ )                     \
+  { OSTAP_INSTRUMENT_CONCAT ( s_ostap_counter_ , __LINE__ ) }
+/// record the RSS and the peak RSS growth for the current scope (pipeline stage)
+#define OSTAP_MEMORY_STAGE( NAME )                                        \
+  static Ostap::Instrument::MemoryCounter                                 \
+  OSTAP_INSTRUMENT_CONCAT ( s_ostap_memory_ , __LINE__ ) { NAME } ;       \
+  const Ostap::Instrument::MemoryStage                                    \
+  OSTAP_INSTRUMENT_CONCAT ( ostap_stage_ , __LINE__ )                     \
+  { OSTAP_INSTRUMENT_CONCAT ( s_ostap_memory_ , __LINE__ ) }
+/// count the calls only
+#define OSTAP_COUNT( NAME )                                               \
+  do { if ( Ostap::Instrument::active () ) {                              \
+      static Ostap::Instrument::Counter s_ostap_counter { NAME } ;        \
+      s_ostap_counter.add () ; } } while ( false )
+// ============================================================================
+#else
+// ============================================================================
+#define OSTAP_PROBE( NAME ) do {} while ( false )
+#define OSTAP_COUNT( NAME ) do {} while ( false )
+#define OSTAP_MEMORY_STAGE( NAME ) do {} while ( false )
+// ============================================================================
+#endif
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_INSTRUMENT_H
+// ============================================================================
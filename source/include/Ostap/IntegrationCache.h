@@ -0,0 +1,349 @@
+// ============================================================================
+#ifndef OSTAP_INTEGRATIONCACHE_H
+#define OSTAP_INTEGRATIONCACHE_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstddef>
+#include <array>
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class IntegrationCache Ostap/IntegrationCache.h
+     *  Statistics for the (global) caches of numerical integration
+     *  (summed over all caches)
+     *  @code
+     *  std::cout << " hits "      << Ostap::Math::IntegrationCache::hits      ()
+     *            << " misses "    << Ostap::Math::IntegrationCache::misses    ()
+     *            << " evictions " << Ostap::Math::IntegrationCache::evictions () ;
+     *  @endcode
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date 2023-01-25
+     */
+    class IntegrationCache
+    {
+    public:
+      // ======================================================================
+      /// number of cache hits
+      static unsigned long long hits      () ;
+      /// number of cache misses
+      static unsigned long long misses    () ;
+      /// number of evicted entries
+      static unsigned long long evictions () ;
+      /// number of cached entries
+      static std::size_t        size      () ;
+      /// number of registered caches
+      static std::size_t        caches    () ;
+      /// reset all counters
+      static void               reset     () ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class LocalIntegralCache Ostap/IntegrationCache.h
+     *  Very small local cache of integrals, keyed by the tag of the 
+     *  function and the integration range. 
+     *  It is intended to be the (transient) data member of the PDF, 
+     *  to avoid the repeated numerical integration for the same 
+     *  normalization range and the same parameters, 
+     *  without the access to the global (locked) caches
+     *  @code
+     *  const double result = m_icache.integral ( m_fun , low , high ) ;
+     *  @endcode
+     *  @attention the cache is not thread-safe, 
+     *             as well as the owner PDF itself  
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date 2023-01-29
+     */
+    class LocalIntegralCache
+    {
+    public:
+      // ======================================================================
+      enum { SIZE = 8 } ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// default constructor: empty cache 
+      LocalIntegralCache () : m_entries () , m_next ( 0 ) {}
+      /// copy constructor: empty cache 
+      LocalIntegralCache ( const LocalIntegralCache& /* right */ ) 
+        : LocalIntegralCache () {}
+      /// assignement: empty cache 
+      LocalIntegralCache& operator= ( const LocalIntegralCache& /* right */ ) 
+      { clear () ; return *this ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** look into the cache 
+       *  @param tag    (INPUT)  the tag of the function 
+       *  @param low    (INPUT)  low integration edge 
+       *  @param high   (INPUT)  high integration edge 
+       *  @param value  (UPDATE) the integral 
+       *  @return true if the value is found 
+       */
+      inline bool find 
+      ( const std::size_t tag   , 
+        const double      low   , 
+        const double      high  , 
+        double&           value ) const 
+      {
+        for ( const Entry& e : m_entries ) 
+        { 
+          if ( e.valid && tag == e.tag && low == e.low && high == e.high ) 
+          { value = e.value ; return true ; }
+        }
+        return false ;
+      }
+      // ======================================================================
+      /** put the integral into the cache (the oldest entry is replaced) 
+       *  @param tag    (INPUT)  the tag of the function 
+       *  @param low    (INPUT)  low integration edge 
+       *  @param high   (INPUT)  high integration edge 
+       *  @param value  (INPUT)  the integral 
+       */
+      inline void insert 
+      ( const std::size_t tag   , 
+        const double      low   , 
+        const double      high  , 
+        const double      value ) 
+      {
+        Entry& e = m_entries [ m_next ] ;
+        e.tag    = tag   ;
+        e.low    = low   ;
+        e.high   = high  ;
+        e.value  = value ;
+        e.valid  = true  ;
+        m_next   = ( m_next + 1 ) % SIZE ;
+      }
+      // ======================================================================
+      /** get the integral of the function from the cache, 
+       *  or calculate and cache it 
+       *  @param fun  (INPUT) the function, it must provide <code>tag</code>
+       *              and <code>integral(low,high)</code> methods 
+       *  @param low  (INPUT)  low integration edge 
+       *  @param high (INPUT)  high integration edge 
+       */
+      template <class FUNCTION>
+      inline double integral 
+      ( const FUNCTION& fun  , 
+        const double    low  , 
+        const double    high ) 
+      {
+        const std::size_t tag    = fun.tag () ;
+        double            result = 0 ;
+        if ( find ( tag , low , high , result ) ) { return result ; }
+        result = fun.integral ( low , high ) ;
+        insert ( tag , low , high , result ) ;
+        return result ;
+      }
+      // ======================================================================
+      /// clear the cache 
+      inline void clear () 
+      {
+        for ( Entry& e : m_entries ) { e.valid = false ; }
+        m_next = 0 ;
+      }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the cache entry 
+      struct Entry 
+      {
+        std::size_t tag   ;
+        double      low   ;
+        double      high  ;
+        double      value ;
+        bool        valid ;
+      } ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// cache entries 
+      std::array<Entry,SIZE> m_entries ; // cache entries 
+      /// the next entry to be replaced 
+      unsigned int           m_next    ; // the next entry to be replaced 
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class LocalRangeCache Ostap/IntegrationCache.h
+     *  Very small local cache of the integrals over N-dimensional 
+     *  rectangular regions, keyed by the tag of the function and the region.
+     *  @see Ostap::Math::LocalIntegralCache 
+     *  @attention the cache is not thread-safe
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    template <unsigned int N>
+    class LocalRangeCache
+    {
+    public:
+      // ======================================================================
+      enum { SIZE = 8 } ;
+      /// the integration region: ( low , high ) for each dimension 
+      typedef std::array<double,2*N> Range ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// default constructor: empty cache 
+      LocalRangeCache () : m_entries () , m_next ( 0 ) { clear () ; }
+      /// copy constructor: empty cache 
+      LocalRangeCache ( const LocalRangeCache& /* right */ ) 
+        : LocalRangeCache () {}
+      /// assignement: empty cache 
+      LocalRangeCache& operator= ( const LocalRangeCache& /* right */ ) 
+      { clear () ; return *this ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** look into the cache 
+       *  @param tag    (INPUT)  the tag of the function 
+       *  @param range  (INPUT)  the integration region 
+       *  @param value  (UPDATE) the integral 
+       *  @return true if the value is found 
+       */
+      inline bool find 
+      ( const std::size_t tag   , 
+        const Range&      range , 
+        double&           value ) const 
+      {
+        for ( const Entry& e : m_entries ) 
+        { 
+          if ( e.valid && tag == e.tag && range == e.range ) 
+          { value = e.value ; return true ; }
+        }
+        return false ;
+      }
+      // ======================================================================
+      /** put the integral into the cache (the oldest entry is replaced) 
+       *  @param tag    (INPUT)  the tag of the function 
+       *  @param range  (INPUT)  the integration region 
+       *  @param value  (INPUT)  the integral 
+       */
+      inline void insert 
+      ( const std::size_t tag   , 
+        const Range&      range , 
+        const double      value ) 
+      {
+        Entry& e = m_entries [ m_next ] ;
+        e.tag    = tag   ;
+        e.range  = range ;
+        e.value  = value ;
+        e.valid  = true  ;
+        m_next   = ( m_next + 1 ) % SIZE ;
+      }
+      // ======================================================================
+      /// clear the cache 
+      inline void clear () 
+      {
+        for ( Entry& e : m_entries ) { e.valid = false ; }
+        m_next = 0 ;
+      }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the cache entry 
+      struct Entry 
+      {
+        std::size_t tag   ;
+        Range       range ;
+        double      value ;
+        bool        valid ;
+      } ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// cache entries 
+      std::array<Entry,SIZE> m_entries ; // cache entries 
+      /// the next entry to be replaced 
+      unsigned int           m_next    ; // the next entry to be replaced 
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class LocalIntegralCache2D Ostap/IntegrationCache.h
+     *  Local cache of 2D-integrals, keyed by the tag of the 
+     *  function and the integration region
+     *  @code
+     *  const double result = m_icache.integral ( m_fun , xmin , xmax , ymin , ymax ) ;
+     *  @endcode
+     *  @see Ostap::Math::LocalIntegralCache 
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class LocalIntegralCache2D : public LocalRangeCache<2> 
+    {
+    public:
+      // ======================================================================
+      /** get the integral of the function from the cache, 
+       *  or calculate and cache it 
+       *  @param fun  (INPUT) the function, it must provide <code>tag</code>
+       *              and <code>integral(xlow,xhigh,ylow,yhigh)</code> methods 
+       */
+      template <class FUNCTION>
+      inline double integral 
+      ( const FUNCTION& fun   , 
+        const double    xlow  , 
+        const double    xhigh , 
+        const double    ylow  , 
+        const double    yhigh ) 
+      {
+        const std::size_t tag    = fun.tag () ;
+        const Range       range  { { xlow , xhigh , ylow , yhigh } } ;
+        double            result = 0 ;
+        if ( find ( tag , range , result ) ) { return result ; }
+        result = fun.integral ( xlow , xhigh , ylow , yhigh ) ;
+        insert ( tag , range , result ) ;
+        return result ;
+      }
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class LocalIntegralCache3D Ostap/IntegrationCache.h
+     *  Local cache of 3D-integrals, keyed by the tag of the 
+     *  function and the integration region
+     *  @see Ostap::Math::LocalIntegralCache 
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class LocalIntegralCache3D : public LocalRangeCache<3> 
+    {
+    public:
+      // ======================================================================
+      /** get the integral of the function from the cache, 
+       *  or calculate and cache it 
+       *  @param fun  (INPUT) the function, it must provide <code>tag</code>
+       *    and <code>integral(xlow,xhigh,ylow,yhigh,zlow,zhigh)</code> methods 
+       */
+      template <class FUNCTION>
+      inline double integral 
+      ( const FUNCTION& fun   , 
+        const double    xlow  , 
+        const double    xhigh , 
+        const double    ylow  , 
+        const double    yhigh , 
+        const double    zlow  , 
+        const double    zhigh ) 
+      {
+        const std::size_t tag    = fun.tag () ;
+        const Range       range  { { xlow , xhigh , ylow , yhigh , zlow , zhigh } } ;
+        double            result = 0 ;
+        if ( find ( tag , range , result ) ) { return result ; }
+        result = fun.integral ( xlow , xhigh , ylow , yhigh , zlow , zhigh ) ;
+        insert ( tag , range , result ) ;
+        return result ;
+      }
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_INTEGRATIONCACHE_H
+// ============================================================================
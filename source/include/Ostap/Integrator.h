@@ -21,7 +21,7 @@ namespace Ostap
   {
     // ========================================================================
     /** @class Integrator Ostap/Integrator.h 
-     *  simple numerical integrator for 1D&2D-cases 
+     *  simple numerical integrator for 1D,2D&3D-cases 
      */
     class Integrator 
     {
@@ -29,6 +29,7 @@ namespace Ostap
       // ======================================================================
       typedef std::function<double(double)>        function1 ;
       typedef std::function<double(double,double)> function2 ;
+      typedef std::function<double(double,double,double)> function3 ;
       typedef std::pair<double,double>             result    ;
       // ======================================================================
     public:
@@ -36,6 +37,20 @@ namespace Ostap
       /// constructor with integration workspace size 
       Integrator ( const std::size_t size = 0 ) ;
       // ======================================================================
+    public: 
+      // ======================================================================
+      /** use the fast path for 1D-integration over the finite interval? 
+       *  - the non-adaptive 21-point Gauss-Kronrod rule is tried first, 
+       *    the result is accepted if the error estimate is good enough 
+       *  - the subdivisions, learned by the adaptive integration for 
+       *    the given type of the function and the given range, 
+       *    are tried next
+       *  - the adaptive integration is a fallback 
+       */
+      static bool fast_path     () ;
+      /// switch on/off the fast path for 1D-integration, return the previous value 
+      static bool set_fast_path ( const bool value ) ;
+      // ======================================================================
     public:
       // ======================================================================
       /** calculate the integral 
@@ -644,6 +659,116 @@ namespace Ostap
         const unsigned short rescale = 0 ) 
       { return integrateY_ ( std::cref ( f2 ) , x , ymin , ymax , ws , tag , rescale ).first ; }
       // ======================================================================
+    public:
+      // ======================================================================
+      // 2D&3D cubatures with the explicit precision 
+      // ======================================================================
+      /** calculate the integral (adaptive cubature) 
+       *  \f[ r = \int_{x_{min}}^{x_{max}}\int_{y_{min}}^{y_{max}}f_2(x,y) dx dy \f]
+       *  @param f2 the function 
+       *  @param xmin lower integration edge in x 
+       *  @param xmax upper integration edge in x 
+       *  @param ymin lower integration edge in y 
+       *  @param ymax upper integration edge in y 
+       *  @param aprecision absolute precision 
+       *  @param rprecision relative precision 
+       *  @return the value of the integral and the estimate of the error 
+       */
+      template <class FUNCTION2>
+      static inline result cubature2
+      ( const FUNCTION2&  f2         , 
+        const double      xmin       , 
+        const double      xmax       ,
+        const double      ymin       , 
+        const double      ymax       ,
+        const double      aprecision , 
+        const double      rprecision ) 
+      { return cubature2_ ( std::cref ( f2 ) , xmin , xmax , ymin , ymax , aprecision , rprecision ) ; }
+      // ======================================================================
+      /** calculate the integral (adaptive cubature) 
+       *  \f[ r = \int_{x_{min}}^{x_{max}}\int_{y_{min}}^{y_{max}}\int_{z_{min}}^{z_{max}}f_3(x,y,z) dx dy dz \f]
+       *  @param f3 the function 
+       *  @param xmin lower integration edge in x 
+       *  @param xmax upper integration edge in x 
+       *  @param ymin lower integration edge in y 
+       *  @param ymax upper integration edge in y 
+       *  @param zmin lower integration edge in z 
+       *  @param zmax upper integration edge in z 
+       *  @param aprecision absolute precision 
+       *  @param rprecision relative precision 
+       *  @param nthreads   number of threads for evaluation of the regions 
+       *  @return the value of the integral and the estimate of the error 
+       *  @attention for <code>nthreads>1</code> the function must be thread-safe
+       *  - the result does not depend on the number of threads 
+       */
+      template <class FUNCTION3>
+      static inline result cubature3
+      ( const FUNCTION3&   f3           , 
+        const double       xmin         , 
+        const double       xmax         ,
+        const double       ymin         , 
+        const double       ymax         ,
+        const double       zmin         , 
+        const double       zmax         ,
+        const double       aprecision   , 
+        const double       rprecision   , 
+        const unsigned int nthreads = 1 ) 
+      { return cubature3_ ( std::cref ( f3 ) , xmin , xmax , ymin , ymax , zmin , zmax , aprecision , rprecision , nthreads ) ; }
+      // ======================================================================
+      /** partial integration of 3D-function over (x,y) 
+       *  \f[ r(z) = \int_{x_{min}}^{x_{max}}\int_{y_{min}}^{y_{max}}f_3(x,y,z) dx dy \f]
+       */
+      template <class FUNCTION3>
+      static inline result cubature3XY
+      ( const FUNCTION3&  f3         , 
+        const double      z          , 
+        const double      xmin       , 
+        const double      xmax       ,
+        const double      ymin       , 
+        const double      ymax       ,
+        const double      aprecision , 
+        const double      rprecision ) 
+      {
+        auto f2 = [&f3,z] ( const double x , const double y ) -> double { return f3 ( x , y , z ) ; } ;
+        return cubature2_ ( std::cref ( f2 ) , xmin , xmax , ymin , ymax , aprecision , rprecision ) ;
+      }
+      // ======================================================================
+      /** partial integration of 3D-function over (x,z) 
+       *  \f[ r(y) = \int_{x_{min}}^{x_{max}}\int_{z_{min}}^{z_{max}}f_3(x,y,z) dx dz \f]
+       */
+      template <class FUNCTION3>
+      static inline result cubature3XZ
+      ( const FUNCTION3&  f3         , 
+        const double      y          , 
+        const double      xmin       , 
+        const double      xmax       ,
+        const double      zmin       , 
+        const double      zmax       ,
+        const double      aprecision , 
+        const double      rprecision ) 
+      {
+        auto f2 = [&f3,y] ( const double x , const double z ) -> double { return f3 ( x , y , z ) ; } ;
+        return cubature2_ ( std::cref ( f2 ) , xmin , xmax , zmin , zmax , aprecision , rprecision ) ;
+      }
+      // ======================================================================
+      /** partial integration of 3D-function over (y,z) 
+       *  \f[ r(x) = \int_{y_{min}}^{y_{max}}\int_{z_{min}}^{z_{max}}f_3(x,y,z) dy dz \f]
+       */
+      template <class FUNCTION3>
+      static inline result cubature3YZ
+      ( const FUNCTION3&  f3         , 
+        const double      x          , 
+        const double      ymin       , 
+        const double      ymax       ,
+        const double      zmin       , 
+        const double      zmax       ,
+        const double      aprecision , 
+        const double      rprecision ) 
+      {
+        auto f2 = [&f3,x] ( const double y , const double z ) -> double { return f3 ( x , y , z ) ; } ;
+        return cubature2_ ( std::cref ( f2 ) , ymin , ymax , zmin , zmax , aprecision , rprecision ) ;
+      }
+      // ======================================================================
     public:
       // ======================================================================
       // 2D integration 
@@ -726,6 +851,52 @@ namespace Ostap
         const std::size_t    tag     = 0 ,
         const unsigned short rescale = 0 ) ;
       // ======================================================================
+      /** calculate the integral (adaptive cubature) 
+       *  \f[ r = \int_{x_{min}}^{x_{max}}\int_{y_{min}}^{y_{max}}f_2(x,y) dx dy \f]
+       *  @param f2 the function 
+       *  @param xmin lower integration edge in x 
+       *  @param xmax upper integration edge in x 
+       *  @param ymin lower integration edge in y 
+       *  @param ymax upper integration edge in y 
+       *  @param aprecision absolute precision 
+       *  @param rprecision relative precision 
+       *  @return the value of the integral and the estimate of the error 
+       */
+      static result cubature2_
+      ( function2         f2         , 
+        const double      xmin       , 
+        const double      xmax       ,
+        const double      ymin       , 
+        const double      ymax       ,
+        const double      aprecision , 
+        const double      rprecision ) ;
+      // ======================================================================
+      /** calculate the integral (adaptive cubature) 
+       *  \f[ r = \int_{x_{min}}^{x_{max}}\int_{y_{min}}^{y_{max}}\int_{z_{min}}^{z_{max}}f_3(x,y,z) dx dy dz \f]
+       *  @param f3 the function 
+       *  @param xmin lower integration edge in x 
+       *  @param xmax upper integration edge in x 
+       *  @param ymin lower integration edge in y 
+       *  @param ymax upper integration edge in y 
+       *  @param zmin lower integration edge in z 
+       *  @param zmax upper integration edge in z 
+       *  @param aprecision absolute precision 
+       *  @param rprecision relative precision 
+       *  @param nthreads   number of threads for evaluation of the regions 
+       *  @return the value of the integral and the estimate of the error 
+       */
+      static result cubature3_
+      ( function3          f3           , 
+        const double       xmin         , 
+        const double       xmax         ,
+        const double       ymin         , 
+        const double       ymax         ,
+        const double       zmin         , 
+        const double       zmax         ,
+        const double       aprecision   , 
+        const double       rprecision   , 
+        const unsigned int nthreads = 1 ) ;
+      // ======================================================================
     private:
       // ======================================================================
       /// integration workspace 
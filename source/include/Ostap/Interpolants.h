@@ -4,6 +4,10 @@
 // ============================================================================
 // Include files 
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstddef>
+// ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/Math.h"
@@ -49,6 +53,17 @@ namespace Ostap
       /// the main method: get the value of interpolated polynomial 
       double operator () ( const  double x ) const { return evaluate ( x ) ; }
       // ======================================================================
+      /** evaluate the interpolant for the array of points 
+       *  - the barycentric weights are calculated once per call, 
+       *    that gives O(n) evaluation for each point 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
+      // ======================================================================
       /// get the derivative   (dy/dx) at point x 
       double derivative  ( const  double x ) const { return neville2( x ).second  ; }
       // ======================================================================
@@ -97,6 +112,17 @@ namespace Ostap
       /// the main method: get the value of interpolated polynomial 
       double operator () ( const  double x ) const { return evaluate ( x ) ; }
       // ======================================================================
+      /** evaluate the interpolant for the array of points 
+       *  - the barycentric weights are calculated once per call, 
+       *    that gives O(n) evaluation for each point 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
+      // ======================================================================
       /// get the drivative with respect to i-th parameter (dy/d(y_i)) at point x 
       double derivative  ( const double       x , 
                            const unsigned int iy ) const 
@@ -151,6 +177,15 @@ namespace Ostap
       /// the main method: get the value of interpolant 
       double operator () ( const  double x ) const { return evaluate  ( x ) ; }
       // ======================================================================
+      /** evaluate the interpolant for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
+      // ======================================================================
       /// get the weight 
       double weight ( const unsigned short index ) const
       { return size () <= index ? 0 : ( 0 == index % 2 ) ? 1 : -1 ; }
@@ -205,6 +240,15 @@ namespace Ostap
       /// the main method: get the value of interpolant 
       double operator () ( const  double x ) const { return evaluate  ( x ) ; }
       // ======================================================================
+      /** evaluate the interpolant for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
+      // ======================================================================
       /// get the weight 
       double weight ( const unsigned short index ) const
       {
@@ -266,6 +310,15 @@ namespace Ostap
       /// the main method: get the value of interpolant 
       double operator () ( const  double x ) const { return evaluate ( x ) ; }
       // ======================================================================
+      /** evaluate the interpolant for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
+      // ======================================================================
     public:
       // ======================================================================
       /// get the degree for the  Floater-Hormann interpolant 
@@ -348,6 +401,15 @@ namespace Ostap
       /// the main method: get the value of interpolant 
       double operator () ( const  double x ) const { return evaluate ( x ) ; }
       // ======================================================================
+      /** evaluate the interpolant for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
+      // ======================================================================
     public:
       // ======================================================================
       /// get the weights 
@@ -413,6 +475,15 @@ namespace Ostap
       /// the main method: get the value of interpolant 
       double operator () ( const  double x ) const { return evaluate ( x ) ; }
       // ======================================================================
+      /** evaluate the interpolant for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
+      // ======================================================================
     public : 
       // ======================================================================
       /// swap two interpolators 
@@ -204,6 +204,15 @@ namespace Ostap
         /// maximal abscissas 
         double xmax () const { return m_xmax ; }
         // ====================================================================
+        /** get the index of the interval \f$ x_i \le x < x_{i+1} \f$
+         *  - O(1) for <code>Uniform</code>, <code>Chebyshev</code> and 
+         *    <code>Chebyshev2</code> abscissas 
+         *  - O(log n) for the generic case 
+         *  @param x the point 
+         *  @return the index of the interval, adjusted to [0,n-2] 
+         */
+        unsigned int index ( const double x ) const ;
+        // ====================================================================
       public: // expose (const) iterators 
         // ====================================================================
         /// begin-iterator 
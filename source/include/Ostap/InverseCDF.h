@@ -0,0 +1,352 @@
+// ============================================================================
+#ifndef OSTAP_INVERSECDF_H
+#define OSTAP_INVERSECDF_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <algorithm>
+// ============================================================================
+/** @file Ostap/InverseCDF.h
+ *  Fast generation of toy data by the inversion of the tabulated
+ *  cumulative distributions (1D) and by the alias tables on the
+ *  fine grids (2D and 3D)
+ *  @see Ostap::Math::InverseCDF
+ *  @see Ostap::Math::AliasTable
+ *  @see Ostap::Math::GridGenerator
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class InverseCDF Ostap/InverseCDF.h
+     *  Tabulated inverse cumulative distribution for the fast
+     *  generation of the random numbers in 1D.
+     *
+     *  The cumulative distribution is tabulated once at the edges
+     *  of the uniform grid, using the exact integrals
+     *  <code>fun.integral(low,high)</code> of the function
+     *  (or from the bin contents), and is linearly interpolated inside bins.
+     *  The bin is located via the guide table, such that the inversion
+     *  costs O(1) operations.
+     *
+     *  The uniform random numbers are produced by the counter-based
+     *  generator Ostap::Math::Philox: the numbers for the event
+     *  <code>i</code> depend only on the <code>seed</code> and <code>i</code>,
+     *  and the results are reproducible independently on the number of threads.
+     *
+     *  @code
+     *  const Ostap::Math::CrystalBallDoubleSided& cb = ... ;
+     *  Ostap::Math::InverseCDF icdf ( cb , xmin , xmax ) ;
+     *  std::vector<double> x = icdf.generate ( 100000 , 12345 ) ;
+     *  @endcode
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class InverseCDF
+    {
+    public:
+      // ======================================================================
+      /** constructor from the function
+       *  @param fun   the function, it must provide <code>integral(low,high)</code>
+       *  @param xmin  low  edge
+       *  @param xmax  high edge
+       *  @param nbins number of bins
+       */
+      template <class FUNCTION>
+      InverseCDF
+      ( const FUNCTION&    fun          ,
+        const double       xmin         ,
+        const double       xmax         ,
+        const unsigned int nbins = 4096 )
+        : m_xmin ( std::min ( xmin , xmax ) )
+        , m_xmax ( std::max ( xmin , xmax ) )
+      {
+        const unsigned int N = std::max ( 1u , nbins ) ;
+        const double       h = ( m_xmax - m_xmin ) / N ;
+        std::vector<double> bins ( N , 0.0 ) ;
+        for ( unsigned int k = 0 ; k < N ; ++k )
+        { bins [ k ] = fun.integral ( m_xmin + k * h , m_xmin + ( k + 1 ) * h ) ; }
+        setup ( bins ) ;
+      }
+      // ======================================================================
+      /** constructor from the bin contents for the uniform binning
+       *  @param bins  bin contents (non-negative)
+       *  @param xmin  low  edge
+       *  @param xmax  high edge
+       */
+      InverseCDF
+      ( const std::vector<double>& bins ,
+        const double               xmin ,
+        const double               xmax ) ;
+      /// default constructor
+      InverseCDF () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// get the quantile for the given probability
+      double quantile   ( const double u ) const ;
+      /// get the quantile for the given probability
+      double operator() ( const double u ) const { return quantile ( u ) ; }
+      /// the tabulated cumulative distribution
+      double cdf        ( const double x ) const ;
+      /** get quantiles for the array of probabilities
+       *  @param n (INPUT)  number of points
+       *  @param u (INPUT)  the probabilities
+       *  @param x (OUTPUT) the quantiles
+       */
+      void   quantiles
+      ( const std::size_t n ,
+        const double*     u ,
+        double*           x ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** generate the random numbers
+       *  @param n        (INPUT)  number of random numbers
+       *  @param seed     (INPUT)  the seed
+       *  @param out      (OUTPUT) the random numbers
+       *  @param nthreads (INPUT)  number of threads (0: all available)
+       */
+      void generate
+      ( const std::size_t   n            ,
+        const std::uint64_t seed         ,
+        double*             out          ,
+        const unsigned int  nthreads = 0 ) const ;
+      /** generate the random numbers
+       *  @param n        (INPUT)  number of random numbers
+       *  @param seed     (INPUT)  the seed
+       *  @param nthreads (INPUT)  number of threads (0: all available)
+       */
+      std::vector<double> generate
+      ( const std::size_t   n            ,
+        const std::uint64_t seed         ,
+        const unsigned int  nthreads = 0 ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      double       xmin  () const { return m_xmin ; }
+      double       xmax  () const { return m_xmax ; }
+      unsigned int nbins () const { return m_cdf.empty () ? 0 : m_cdf.size () - 1 ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// build the cumulative distribution and the guide table
+      void setup ( const std::vector<double>& bins ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// low edge
+      double                    m_xmin  { 0 } ;
+      /// high edge
+      double                    m_xmax  { 1 } ;
+      /// cumulative distribution at bin edges
+      std::vector<double>       m_cdf   {} ;
+      /// guide table
+      std::vector<unsigned int> m_guide {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class AliasTable Ostap/InverseCDF.h
+     *  Walker's alias table for the fast sampling
+     *  from the discrete distribution with O(1) operations
+     *  @see https://en.wikipedia.org/wiki/Alias_method
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class AliasTable
+    {
+    public:
+      // ======================================================================
+      /// constructor from the (non-negative) weights
+      AliasTable ( const std::vector<double>& weights ) ;
+      /// default constructor
+      AliasTable () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// get the index for the uniform random number in [0,1)
+      inline std::size_t operator() ( const double u ) const
+      {
+        const double      s = u * m_prob.size () ;
+        const std::size_t i = std::min<std::size_t> ( std::size_t ( s ) , m_prob.size () - 1 ) ;
+        return ( s - i ) < m_prob [ i ] ? i : m_alias [ i ] ;
+      }
+      /// the size of the table
+      std::size_t size  () const { return m_prob.size () ; }
+      /// the total weight
+      double      total () const { return m_total ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// probabilities
+      std::vector<double>      m_prob  {} ;
+      /// aliases
+      std::vector<std::size_t> m_alias {} ;
+      /// the total weight
+      double                   m_total { 0 } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class GridGenerator Ostap/InverseCDF.h
+     *  Fast generation of random points in 2D and 3D.
+     *  The cell integrals on the fine uniform grid are calculated once,
+     *  using the exact integrals of the function,
+     *  the cell is sampled with the alias table and the point is
+     *  uniformly distributed inside the cell.
+     *  @see Ostap::Math::AliasTable
+     *  @see Ostap::Math::InverseCDF
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class GridGenerator
+    {
+    public:
+      // ======================================================================
+      /** constructor for 2D function
+       *  @param fun the function, it must provide
+       *             <code>integral(xlow,xhigh,ylow,yhigh)</code>
+       */
+      template <class FUNCTION>
+      GridGenerator
+      ( const FUNCTION&    fun        ,
+        const double       xmin       ,
+        const double       xmax       ,
+        const double       ymin       ,
+        const double       ymax       ,
+        const unsigned int nx   = 256 ,
+        const unsigned int ny   = 256 )
+        : m_min  { { std::min ( xmin , xmax ) , std::min ( ymin , ymax ) , 0 } }
+        , m_max  { { std::max ( xmin , xmax ) , std::max ( ymin , ymax ) , 1 } }
+        , m_bins { { std::max ( 1u , nx ) , std::max ( 1u , ny ) , 1u } }
+        , m_dim  ( 2 )
+      {
+        const double hx = ( m_max [ 0 ] - m_min [ 0 ] ) / m_bins [ 0 ] ;
+        const double hy = ( m_max [ 1 ] - m_min [ 1 ] ) / m_bins [ 1 ] ;
+        std::vector<double> cells ( m_bins [ 0 ] * m_bins [ 1 ] , 0.0 ) ;
+        for ( unsigned int ix = 0 ; ix < m_bins [ 0 ] ; ++ix )
+        {
+          const double xl = m_min [ 0 ] + ix * hx ;
+          for ( unsigned int iy = 0 ; iy < m_bins [ 1 ] ; ++iy )
+          {
+            const double yl = m_min [ 1 ] + iy * hy ;
+            cells [ ix * m_bins [ 1 ] + iy ] = fun.integral ( xl , xl + hx , yl , yl + hy ) ;
+          }
+        }
+        m_table = AliasTable ( cells ) ;
+      }
+      // ======================================================================
+      /** constructor for 3D function
+       *  @param fun the function, it must provide
+       *             <code>integral(xlow,xhigh,ylow,yhigh,zlow,zhigh)</code>
+       *  @attention the numbers of cells must be specified explicitly,
+       *             (e.g. 64 for each axis), to avoid the ambiguity with 2D case
+       */
+      template <class FUNCTION>
+      GridGenerator
+      ( const FUNCTION&    fun  ,
+        const double       xmin ,
+        const double       xmax ,
+        const double       ymin ,
+        const double       ymax ,
+        const double       zmin ,
+        const double       zmax ,
+        const unsigned int nx   ,
+        const unsigned int ny   ,
+        const unsigned int nz   )
+        : m_min  { { std::min ( xmin , xmax ) , std::min ( ymin , ymax ) , std::min ( zmin , zmax ) } }
+        , m_max  { { std::max ( xmin , xmax ) , std::max ( ymin , ymax ) , std::max ( zmin , zmax ) } }
+        , m_bins { { std::max ( 1u , nx ) , std::max ( 1u , ny ) , std::max ( 1u , nz ) } }
+        , m_dim  ( 3 )
+      {
+        const double hx = ( m_max [ 0 ] - m_min [ 0 ] ) / m_bins [ 0 ] ;
+        const double hy = ( m_max [ 1 ] - m_min [ 1 ] ) / m_bins [ 1 ] ;
+        const double hz = ( m_max [ 2 ] - m_min [ 2 ] ) / m_bins [ 2 ] ;
+        std::vector<double> cells ( m_bins [ 0 ] * m_bins [ 1 ] * m_bins [ 2 ] , 0.0 ) ;
+        for ( unsigned int ix = 0 ; ix < m_bins [ 0 ] ; ++ix )
+        {
+          const double xl = m_min [ 0 ] + ix * hx ;
+          for ( unsigned int iy = 0 ; iy < m_bins [ 1 ] ; ++iy )
+          {
+            const double yl = m_min [ 1 ] + iy * hy ;
+            for ( unsigned int iz = 0 ; iz < m_bins [ 2 ] ; ++iz )
+            {
+              const double zl = m_min [ 2 ] + iz * hz ;
+              cells [ ( ix * m_bins [ 1 ] + iy ) * m_bins [ 2 ] + iz ] =
+                fun.integral ( xl , xl + hx , yl , yl + hy , zl , zl + hz ) ;
+            }
+          }
+        }
+        m_table = AliasTable ( cells ) ;
+      }
+      // ======================================================================
+      /// default constructor
+      GridGenerator () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** generate the random points
+       *  @param n        (INPUT)  number of points
+       *  @param seed     (INPUT)  the seed
+       *  @param out      (OUTPUT) the points, column-wise:
+       *                           <code>out[d*n+i]</code> is the coordinate
+       *                           <code>d</code> of the point <code>i</code>
+       *  @param nthreads (INPUT)  number of threads (0: all available)
+       */
+      void generate
+      ( const std::size_t   n            ,
+        const std::uint64_t seed         ,
+        double*             out          ,
+        const unsigned int  nthreads = 0 ) const ;
+      /** generate the random points
+       *  @param n        (INPUT)  number of points
+       *  @param seed     (INPUT)  the seed
+       *  @param nthreads (INPUT)  number of threads (0: all available)
+       *  @return the points column-wise, see above
+       */
+      std::vector<double> generate
+      ( const std::size_t   n            ,
+        const std::uint64_t seed         ,
+        const unsigned int  nthreads = 0 ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// dimension
+      unsigned int dim  () const { return m_dim ; }
+      /// number of cells along the axis
+      unsigned int bins ( const unsigned int d ) const { return d < m_dim ? m_bins [ d ] : 0 ; }
+      /// number of cells
+      std::size_t  size () const { return m_table.size () ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// low edges
+      std::array<double,3>       m_min   {} ;
+      /// high edges
+      std::array<double,3>       m_max   {} ;
+      /// number of cells along the axes
+      std::array<unsigned int,3> m_bins  {} ;
+      /// dimension
+      unsigned int               m_dim   { 0 } ;
+      /// the alias table for cells
+      AliasTable                 m_table {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_INVERSECDF_H
+// ============================================================================
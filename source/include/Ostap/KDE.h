@@ -0,0 +1,279 @@
+// ============================================================================
+#ifndef OSTAP_KDE_H
+#define OSTAP_KDE_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstddef>
+#include <vector>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/WStatEntity.h"
+#include "Ostap/HistoTables.h"
+// ============================================================================
+/** @file Ostap/KDE.h
+ *  Binned (FFT-based) kernel density estimator in 1, 2 and 3 dimensions
+ *
+ *  - the data are linearly binned on the fine uniform grid
+ *  - the grid is convolved with the gaussian product kernel
+ *    via FFT, axis by axis
+ *  - optionally, the adaptive bandwidth (Abramson's square-root law)
+ *    is applied in the second pass, using the fixed-bandwidth estimate
+ *    as the pilot density
+ *  - the density is linearly interpolated between the grid nodes
+ *    using the compiled histogram interpolation tables
+ *  - the integrals of the interpolant are analytic
+ *
+ *  The construction cost is \f$ \mathcal{O}(N) + \mathcal{O}(M\log M) \f$
+ *  and the evaluation cost does not depend on the number of events.
+ *
+ *  @see I.S.Abramson, "On bandwidth variation in kernel estimates - a square
+ *       root law", Ann. Statist. 10 (1982) 1217
+ *  @see M.P.Wand, "Fast computation of multivariate kernel estimators",
+ *       J. Comput. Graph. Stat. 3 (1994) 433
+ *  @see RooNDKeysPdf
+ *  @see Ostap::Math::HistoAxisTable
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class KDE Ostap/KDE.h
+     *  Binned (FFT-based) kernel density estimator in 1, 2 and 3 dimensions
+     *  @code
+     *  Ostap::Math::KDE kde ( 1024 , 0.0 , 10.0 ) ;
+     *  kde.fill ( n , x ) ;
+     *  kde.build ( 1.0 , true ) ; // rho = 1 , adaptive
+     *  double v = kde ( 2.5 ) ;
+     *  @endcode
+     *  The bandwidth is \f$ h_k = \rho \sigma_k \left(\frac{4}{(d+2)n_{eff}}\right)^{1/(d+4)}\f$
+     *  (Scott's/Silverman's rule for the gaussian kernel), unless it is
+     *  specified explicitly
+     */
+    class KDE
+    {
+    public:
+      // ======================================================================
+      /// 1D-estimator
+      KDE
+      ( const unsigned int nx   ,
+        const double       xmin ,
+        const double       xmax ) ;
+      /// 2D-estimator
+      KDE
+      ( const unsigned int nx   ,
+        const double       xmin ,
+        const double       xmax ,
+        const unsigned int ny   ,
+        const double       ymin ,
+        const double       ymax ) ;
+      /// 3D-estimator
+      KDE
+      ( const unsigned int nx   ,
+        const double       xmin ,
+        const double       xmax ,
+        const unsigned int ny   ,
+        const double       ymin ,
+        const double       ymax ,
+        const unsigned int nz   ,
+        const double       zmin ,
+        const double       zmax ) ;
+      /// default constructor
+      KDE () = default ;
+      // ======================================================================
+    public: // filling
+      // ======================================================================
+      /** add the point (linear binning)
+       *  @param point the point, array of <code>dim()</code> coordinates
+       *  @param w     the weight
+       *  @return true if the point is inside the range
+       */
+      bool fill
+      ( const double* point     ,
+        const double  w     = 1 ) ;
+      // ======================================================================
+      /** add the points (linear binning)
+       *  @param n  number of points
+       *  @param x  x-coordinates
+       *  @param y  y-coordinates (2D and 3D)
+       *  @param z  z-coordinates (3D)
+       *  @param w  the weights (null for unit weights)
+       *  @return number of points inside the range
+       */
+      std::size_t fill
+      ( const std::size_t n           ,
+        const double*     x           ,
+        const double*     y = nullptr ,
+        const double*     z = nullptr ,
+        const double*     w = nullptr ) ;
+      // ======================================================================
+    public: // smoothing
+      // ======================================================================
+      /** smooth the binned data using the bandwidth from the rule
+       *  @param rho      the scale factor for the bandwidth
+       *  @param adaptive use the adaptive bandwidth?
+       *  @param mirror   mirror the data at the boundaries?
+       */
+      void build
+      ( const double rho      = 1     ,
+        const bool   adaptive = false ,
+        const bool   mirror   = true  ) ;
+      // ======================================================================
+      /** smooth the binned data using the explicit bandwidth
+       *  @param h        the bandwidth for each axis
+       *  @param adaptive use the adaptive bandwidth?
+       *  @param mirror   mirror the data at the boundaries?
+       */
+      void build
+      ( const std::vector<double>& h                ,
+        const bool                 adaptive = false ,
+        const bool                 mirror   = true  ) ;
+      // ======================================================================
+    public: // evaluation
+      // ======================================================================
+      /// evaluate the density (1D)
+      double operator () ( const double x ) const ;
+      /// evaluate the density (2D)
+      double operator () ( const double x , const double y ) const ;
+      /// evaluate the density (3D)
+      double operator () ( const double x , const double y , const double z ) const ;
+      // ======================================================================
+      /** batch evaluation (1D)
+       *  @param n      (INPUT)  number of points
+       *  @param x      (INPUT)  x-coordinates
+       *  @param result (OUTPUT) the results
+       */
+      void evaluate
+      ( const std::size_t n      ,
+        const double*     x      ,
+        double*           result ) const ;
+      /// batch evaluation (2D)
+      void evaluate
+      ( const std::size_t n      ,
+        const double*     x      ,
+        const double*     y      ,
+        double*           result ) const ;
+      /// batch evaluation (3D)
+      void evaluate
+      ( const std::size_t n      ,
+        const double*     x      ,
+        const double*     y      ,
+        const double*     z      ,
+        double*           result ) const ;
+      // ======================================================================
+    public: // integrals
+      // ======================================================================
+      /// integral over the x-range (1D)
+      double integral
+      ( const double xlow , const double xhigh ) const ;
+      /// integral over the box (2D)
+      double integral
+      ( const double xlow , const double xhigh ,
+        const double ylow , const double yhigh ) const ;
+      /// integral over the box (3D)
+      double integral
+      ( const double xlow , const double xhigh ,
+        const double ylow , const double yhigh ,
+        const double zlow , const double zhigh ) const ;
+      // ======================================================================
+      /** integrate over the chosen axes at the fixed values of others
+       *  @param mask  (INPUT) bit mask of integrated axes (1:x, 2:y, 4:z)
+       *  @param point (INPUT) the point for non-integrated axes
+       *  @param low   (INPUT) the low  edges for integrated axes
+       *  @param high  (INPUT) the high edges for integrated axes
+       */
+      double integrate
+      ( const unsigned short mask  ,
+        const double*        point ,
+        const double*        low   ,
+        const double*        high  ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the dimension
+      unsigned short dim      () const { return m_dim ; }
+      /// number of grid bins along the axis
+      unsigned int   nbins    ( const unsigned short i ) const { return m_n    [ i ] ; }
+      /// low edge of the axis
+      double         xmin     ( const unsigned short i ) const { return m_xmin [ i ] ; }
+      /// high edge of the axis
+      double         xmax     ( const unsigned short i ) const { return m_xmax [ i ] ; }
+      /// the bandwidth along the axis (global one for the adaptive estimator)
+      double         bandwidth ( const unsigned short i ) const { return m_h   [ i ] ; }
+      /// the statistics along the axis
+      const Ostap::WStatEntity& counter ( const unsigned short i ) const { return m_cnt [ i ] ; }
+      /// sum of weights inside the range
+      double         sumw     () const { return m_sumw     ; }
+      /// the effective number of entries inside the range
+      double         nEff     () const ;
+      /// is the density ready?
+      bool           ok       () const { return m_ok       ; }
+      /// adaptive bandwidth?
+      bool           adaptive () const { return m_adaptive ; }
+      /// mirrored at the boundaries?
+      bool           mirror   () const { return m_mirror   ; }
+      /// binned data, x runs fastest
+      const std::vector<double>& counts  () const { return m_counts  ; }
+      /// the density at the grid nodes, x runs fastest
+      const std::vector<double>& density () const { return m_density ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the common part of constructors
+      void setup () ;
+      /// smooth the grid with the per-axis (relative) bandwidths
+      void smooth
+      ( std::vector<double>&       grid   ,
+        const std::vector<double>& s      ) const ;
+      /// the interpolated value at the point
+      double value  ( const double* point ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the dimension
+      unsigned short              m_dim      { 0 }    ;
+      /// number of bins
+      std::vector<unsigned int>   m_n        {}       ;
+      /// low edges
+      std::vector<double>         m_xmin     {}       ;
+      /// high edges
+      std::vector<double>         m_xmax     {}       ;
+      /// the bandwidths
+      std::vector<double>         m_h        {}       ;
+      /// the statistics along the axes
+      std::vector<Ostap::WStatEntity> m_cnt  {}       ;
+      /// the axis lookup tables
+      std::vector<Ostap::Math::HistoAxisTable> m_axes {} ;
+      /// binned data
+      std::vector<double>         m_counts   {}       ;
+      /// the density at the grid nodes
+      std::vector<double>         m_density  {}       ;
+      /// sum of weights inside the range
+      double                      m_sumw     { 0 }    ;
+      /// sum of squared weights inside the range
+      double                      m_sumw2    { 0 }    ;
+      /// is the density ready?
+      bool                        m_ok       { false } ;
+      /// adaptive bandwidth?
+      bool                        m_adaptive { false } ;
+      /// mirrored at the boundaries?
+      bool                        m_mirror   { true  } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // OSTAP_KDE_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
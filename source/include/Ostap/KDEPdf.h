@@ -0,0 +1,179 @@
+// ============================================================================
+#ifndef OSTAP_KDEPDF_H
+#define OSTAP_KDEPDF_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RVersion.h"
+#include "RooAbsPdf.h"
+#include "RooRealProxy.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/KDE.h"
+#include "Ostap/BatchCompute.h"
+// ============================================================================
+// forward declarations
+// ============================================================================
+class RooAbsData ;
+// ============================================================================
+/** @file Ostap/KDEPdf.h
+ *  Binned (FFT-based) kernel density estimator as RooFit PDF,
+ *  the fast replacement for <code>RooNDKeysPdf</code>
+ *  @see Ostap::Math::KDE
+ *  @see Ostap::Models::KDE
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Models
+  {
+    // ========================================================================
+    /** @class KDE Ostap/KDEPdf.h
+     *  Binned (FFT-based) kernel density estimator in 1, 2 and 3 dimensions
+     *  - the data are binned on the fine grid, the grid is convolved with
+     *    the gaussian kernel via FFT, optionally with the adaptive bandwidth
+     *  - the density is linearly interpolated between the grid nodes
+     *  - the integrals (including the projections) are analytic
+     *
+     *  Unlike <code>RooNDKeysPdf</code> the construction cost is linear
+     *  in the number of events and the evaluation cost does not depend on it.
+     *  @see Ostap::Math::KDE
+     *  @see RooNDKeysPdf
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class KDE : public RooAbsPdf
+    {
+      // ======================================================================
+    public :
+      // ======================================================================
+      ClassDefOverride(Ostap::Models::KDE, 1) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// 1D-estimator from the ready density
+      KDE ( const char*             name  ,
+            const char*             title ,
+            RooAbsReal&             x     ,
+            const Ostap::Math::KDE& kde   ) ;
+      /// 2D-estimator from the ready density
+      KDE ( const char*             name  ,
+            const char*             title ,
+            RooAbsReal&             x     ,
+            RooAbsReal&             y     ,
+            const Ostap::Math::KDE& kde   ) ;
+      /// 3D-estimator from the ready density
+      KDE ( const char*             name  ,
+            const char*             title ,
+            RooAbsReal&             x     ,
+            RooAbsReal&             y     ,
+            RooAbsReal&             z     ,
+            const Ostap::Math::KDE& kde   ) ;
+      // ======================================================================
+      /** 1D-estimator from the data
+       *  @param name     the name
+       *  @param title    the title
+       *  @param x        the observable
+       *  @param data     the data
+       *  @param nx       number of grid bins
+       *  @param rho      the scale factor for the bandwidth
+       *  @param adaptive use the adaptive bandwidth?
+       *  @param mirror   mirror the data at the boundaries?
+       */
+      KDE ( const char*             name             ,
+            const char*             title            ,
+            RooAbsReal&             x                ,
+            const RooAbsData&       data             ,
+            const unsigned int      nx       = 1024  ,
+            const double            rho      = 1     ,
+            const bool              adaptive = false ,
+            const bool              mirror   = true  ) ;
+      /// 2D-estimator from the data
+      KDE ( const char*             name             ,
+            const char*             title            ,
+            RooAbsReal&             x                ,
+            RooAbsReal&             y                ,
+            const RooAbsData&       data             ,
+            const unsigned int      nx       = 128   ,
+            const unsigned int      ny       = 128   ,
+            const double            rho      = 1     ,
+            const bool              adaptive = false ,
+            const bool              mirror   = true  ) ;
+      /// 3D-estimator from the data
+      KDE ( const char*             name             ,
+            const char*             title            ,
+            RooAbsReal&             x                ,
+            RooAbsReal&             y                ,
+            RooAbsReal&             z                ,
+            const RooAbsData&       data             ,
+            const unsigned int      nx       = 64    ,
+            const unsigned int      ny       = 64    ,
+            const unsigned int      nz       = 64    ,
+            const double            rho      = 1     ,
+            const bool              adaptive = false ,
+            const bool              mirror   = true  ) ;
+      /// copy
+      KDE ( const KDE&  right     ,
+            const char* name  = 0 ) ;
+      /// destructor
+      virtual ~KDE () ;
+      /// clone
+      KDE* clone ( const char* name ) const override;
+      // ======================================================================
+    public: // some fake functionality
+      // ======================================================================
+      // fake default contructor, needed just for proper (de)serialization
+      KDE () {} ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      // the actual evaluation of function
+      Double_t evaluate() const override;
+      // ======================================================================
+      /// the batch evaluation of function
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
+    public: // integrals
+      // ======================================================================
+      Int_t    getAnalyticalIntegral
+      ( RooArgSet&     allVars      ,
+        RooArgSet&     analVars     ,
+        const char* /* rangename */ ) const override;
+      Double_t analyticalIntegral
+      ( Int_t          code         ,
+        const char*    rangeName    ) const override;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// dimensionality of the PDF
+      unsigned short          dim () const { return m_kde.dim () ; }
+      /// the underlying density
+      const Ostap::Math::KDE& kde () const { return m_kde ; }
+      // ======================================================================
+    protected :
+      // ======================================================================
+      RooRealProxy     m_x   {} ;
+      RooRealProxy     m_y   {} ;
+      RooRealProxy     m_z   {} ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the density
+      Ostap::Math::KDE m_kde {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                       The end of namespace Ostap::Models
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // OSTAP_KDEPDF_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
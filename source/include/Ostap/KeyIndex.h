@@ -0,0 +1,151 @@
+// ============================================================================
+#ifndef OSTAP_KEYINDEX_H
+#define OSTAP_KEYINDEX_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <string>
+#include <vector>
+#include <unordered_map>
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class TDirectory ; // ROOT
+class TClass     ; // ROOT
+// ============================================================================
+/** @file Ostap/KeyIndex.h
+ *  The index of keys in ROOT file/directory
+ *
+ *  The index is built by one traversal of the key lists,
+ *  no objects (except the subdirectories) are read.
+ *  The queries by the name pattern and by the base class are
+ *  answered from the index using the class names stored in the keys.
+ *
+ *  @code
+ *  TFile* file = ... ;
+ *  Ostap::Utils::KeyIndex index ( file ) ;
+ *  auto histos = index.paths ( "*pt*" , "TH1" ) ;
+ *  @endcode
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class KeyIndex Ostap/KeyIndex.h
+     *  The index of keys in ROOT file/directory
+     *  - the paths are relative to the indexed directory
+     *  - the order of entries is the same as the order of the
+     *    (recursive) traversal of the key lists
+     */
+    class KeyIndex
+    {
+    public:
+      // ======================================================================
+      /// the entry in the index
+      struct Entry
+      {
+        /// the path relative to the indexed directory
+        std::string path      {}      ;
+        /// the class name
+        std::string classname {}      ;
+        /// the cycle
+        short       cycle     { 0 }   ;
+        /// the size of the object on disk (bytes)
+        int         nbytes    { 0 }   ;
+        /// the size of the (uncompressed) object (bytes)
+        int         objlen    { 0 }   ;
+        /// is it a directory?
+        bool        directory { false } ;
+      } ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param dir       (INPUT) the directory
+       *  @param recursive (INPUT) traverse the subdirectories?
+       */
+      KeyIndex
+      ( const TDirectory* dir              ,
+        const bool        recursive = true ) ;
+      /// default constructor
+      KeyIndex () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of entries
+      std::size_t  size  () const { return m_entries.size () ; }
+      /// empty index?
+      bool         empty () const { return m_entries.empty () ; }
+      /// get the entry
+      const Entry& entry ( const std::size_t index ) const ;
+      /// all entries
+      const std::vector<Entry>& entries () const { return m_entries ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// is the path in the index?
+      bool        has   ( const std::string& path ) const ;
+      /** get the index of the entry by path (the highest cycle)
+       *  @return the index or <code>size()</code> if the path is not found
+       */
+      std::size_t find  ( const std::string& path ) const ;
+      // ======================================================================
+      /** select the paths
+       *  @param pattern (INPUT) the shell-style (glob) pattern, empty for all
+       *  @param base    (INPUT) the name of the base class, empty for all
+       *  @param no_dir  (INPUT) skip the directories?
+       *  @return the paths in the order of the traversal
+       */
+      std::vector<std::string> paths
+      ( const std::string& pattern = ""   ,
+        const std::string& base    = ""   ,
+        const bool         no_dir  = true ) const ;
+      // ======================================================================
+      /** select the entries
+       *  @see KeyIndex::paths
+       *  @return the indices of the entries
+       */
+      std::vector<std::size_t> select
+      ( const std::string& pattern = ""   ,
+        const std::string& base    = ""   ,
+        const bool         no_dir  = true ) const ;
+      // ======================================================================
+      /// total size of objects on disk (bytes)
+      double nbytes () const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// traverse the directory
+      void traverse
+      ( const TDirectory*  dir       ,
+        const std::string& prefix    ,
+        const bool         recursive ) ;
+      /// does the class inherit from the base?
+      bool inherits
+      ( const std::string& classname ,
+        const TClass*      base      ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the entries
+      std::vector<Entry>                           m_entries {} ;
+      /// path -> index of the entry with the highest cycle
+      std::unordered_map<std::string,std::size_t>  m_map     {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // OSTAP_KEYINDEX_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
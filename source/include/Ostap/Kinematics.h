@@ -7,6 +7,7 @@
 // STD & STL 
 // ============================================================================
 #include <cmath>
+#include <cstddef>
 // ============================================================================
 // ROOT
 // ============================================================================
@@ -18,6 +19,7 @@
 // ============================================================================
 #include "Ostap/Vector3DTypes.h"
 #include "Ostap/Vector4DTypes.h"
+#include "Ostap/MatrixUtils.h"
 // ============================================================================
 /** @file Ostap/Kinematics.h
  *  Collection of useful mathematical utilities related to the kinematics
@@ -66,7 +68,7 @@ namespace Ostap
       dM2dp [2] = -2 * momentum.Pz () ;
       dM2dp [3] =  2 * momentum.E  () ;
       //
-      return ROOT::Math::Similarity ( covariance , dM2dp ) ;
+      return Ostap::Math::similarity ( covariance , dM2dp ) ;
     }
     // ========================================================================
     template <class C, class T, class B , class R>
@@ -231,7 +233,7 @@ namespace Ostap
       dPdP_i [2] = momentum.Pz () / P ;
       dPdP_i [3] = 0.0 ;
       //
-      return ROOT::Math::Similarity ( covariance , dPdP_i ) ;
+      return Ostap::Math::similarity ( covariance , dPdP_i ) ;
     }
     // ========================================================================
     template <class C, class T, class B, class R>
@@ -333,7 +335,7 @@ namespace Ostap
       //
       return 
         covariance ( 0 , 0 ) * _ax * _ax       + 
-        covariance ( 0 , 1 ) * _ay * _ay * 2.0 +
+        covariance ( 0 , 1 ) * _ax * _ay * 2.0 +
         covariance ( 1 , 1 ) * _ay * _ay       ;
     }
     // ========================================================================
@@ -402,7 +404,7 @@ namespace Ostap
       dYdP_i [2] = ePpz + eMpz ;
       dYdP_i [3] = ePpz - eMpz ;
       //
-      return ROOT::Math::Similarity ( covariance , dYdP_i ) ;
+      return Ostap::Math::similarity ( covariance , dYdP_i ) ;
     }
     // ========================================================================
     template <class C, class T, class B, class R>
@@ -1243,6 +1245,144 @@ namespace Ostap
     double phasespace3 
     ( const double x  ) ;
     // ========================================================================
+    /** @name Batched kinematics with errors 
+     *  Evaluate the kinematic quantities and their uncertainties 
+     *  for arrays of 4-momenta. The momenta are given as separate arrays 
+     *  of components, the covariance matrices are packed: 
+     *  10 elements per candidate in the order of 
+     *  <code>ROOT::Math::MatRepSym<double,4></code>, 
+     *  \f$ (C_{00},C_{10},C_{11},C_{20},C_{21},C_{22},C_{30},C_{31},C_{32},C_{33}) \f$, 
+     *  i.e. one can use <code>momCovMatrix().Array()</code> directly.
+     *  The Jacobian products are unrolled, no temporary objects are created.
+     *  @code
+     *  std::vector<double> px , py , pz , e , cov , m , sm ;
+     *  ... 
+     *  mass_with_error ( px.size() , px.data() , py.data() , pz.data() , e.data() , 
+     *                    cov.data() , m.data() , sm.data() ) ;
+     *  @endcode
+     *  @see Ostap::Math::sigma2mass
+     *  @see Ostap::Math::sigma2pt
+     *  @see Ostap::Math::sigma2y
+     */
+    // ========================================================================
+    //@{
+    /** invariant mass and its uncertainty 
+     *  (uncertainty is zero for space-like vectors)
+     *  @param n     (INPUT)  number of candidates 
+     *  @param px    (INPUT)  x-components of momenta 
+     *  @param py    (INPUT)  y-components of momenta 
+     *  @param pz    (INPUT)  z-components of momenta 
+     *  @param e     (INPUT)  energies 
+     *  @param cov   (INPUT)  packed 4x4 covariances, 10 elements per candidate 
+     *  @param mass  (OUTPUT) masses 
+     *  @param sigma (OUTPUT) uncertainties of masses 
+     *  @return number of processed candidates 
+     */
+    std::size_t mass_with_error 
+    ( const std::size_t n     , 
+      const double*     px    , 
+      const double*     py    , 
+      const double*     pz    , 
+      const double*     e     , 
+      const double*     cov   , 
+      double*           mass  , 
+      double*           sigma ) ;
+    // ========================================================================
+    /** transverse momentum and its uncertainty 
+     *  @see Ostap::Kinematics::mass_with_error
+     */
+    std::size_t pt_with_error 
+    ( const std::size_t n     , 
+      const double*     px    , 
+      const double*     py    , 
+      const double*     cov   , 
+      double*           pt    , 
+      double*           sigma ) ;
+    // ========================================================================
+    /** rapidity and its uncertainty 
+     *  @see Ostap::Kinematics::mass_with_error
+     */
+    std::size_t rapidity_with_error 
+    ( const std::size_t n     , 
+      const double*     pz    , 
+      const double*     e     , 
+      const double*     cov   , 
+      double*           y     , 
+      double*           sigma ) ;
+    //@}
+    // ========================================================================
+    /** @name Batched invariant kinematics
+     *  Evaluate the invariant kinematic functions for arrays of
+     *  invariants \f$ (s, s_1, s_2, m_i^2) \f$ with one call.
+     *  Near the kinematic boundaries these functions suffer from
+     *  severe cancellations, therefore the compensated arithmetic
+     *  is used: the products are split into the exact sum of two
+     *  doubles (via <code>std::fma</code>) and the sums are accumulated
+     *  with the error-free transformations. The result is accurate
+     *  to few ulps of the result itself, not of the largest term.
+     *  @code
+     *  std::vector<double> s , lam ( s.size() ) ;
+     *  triangle ( s.size() , s.data() , m1 * m1 , m2 * m2 , lam.data() ) ;
+     *  @endcode
+     */
+    // ========================================================================
+    //@{
+    /** the triangle function for arrays of arguments
+     *  \f$ \lambda ( a_i , b_i , c_i ) \f$
+     *  @param n      (INPUT)  number of points
+     *  @param a      (INPUT)  array of the first arguments
+     *  @param b      (INPUT)  array of the second arguments
+     *  @param c      (INPUT)  array of the third arguments
+     *  @param result (OUTPUT) array of results
+     *  @return number of processed points
+     */
+    std::size_t triangle
+    ( const std::size_t n      ,
+      const double*     a      ,
+      const double*     b      ,
+      const double*     c      ,
+      double*           result ) ;
+    // ========================================================================
+    /** the triangle function for array of the first argument
+     *  and fixed other arguments (e.g. squared masses)
+     *  \f$ \lambda ( a_i , b , c ) \f$
+     *  @see Ostap::Kinematics::triangle
+     */
+    std::size_t triangle
+    ( const std::size_t n      ,
+      const double*     a      ,
+      const double      b      ,
+      const double      c      ,
+      double*           result ) ;
+    // ========================================================================
+    /** momenta of the two-body decays for array of \f$ s \f$
+     *  and the fixed squared masses of daughter particles
+     *  \f$ q_s ( s_i , m_1^2 , m_2^2 ) \f$; zero below the threshold
+     *  @see Ostap::Kinematics::q_s
+     */
+    std::size_t q_s
+    ( const std::size_t n      ,
+      const double*     s      ,
+      const double      m2_1   ,
+      const double      m2_2   ,
+      double*           result ) ;
+    // ========================================================================
+    /** the universal four-particle ``tetrahedron-function''
+     *  for arrays of arguments
+     *  \f$ G ( x_i , y_i , z_i , u_i , v_i , w_i ) \f$
+     *  @see Ostap::Kinematics::G
+     */
+    std::size_t G
+    ( const std::size_t n      ,
+      const double*     x      ,
+      const double*     y      ,
+      const double*     z      ,
+      const double*     u      ,
+      const double*     v      ,
+      const double*     w      ,
+      double*           result ) ;
+    //@}
+    // ========================================================================
   } //                                       end of namespace Ostap::Kinematics 
   // ==========================================================================
   namespace Math 
@@ -7,6 +7,8 @@
 // STD&STL
 // ============================================================================
 #include <functional>
+#include <vector>
+#include <cstddef>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -99,6 +101,56 @@ namespace Ostap
        */
       double operator() ( const double x ) const ;
       // ======================================================================
+      /** the direct calculation via the numerical integration 
+       *  (the grid-based representation is not used)
+       *  @param x value of \f$ \omega \f$
+       */
+      double direct     ( const double x ) const ;
+      // ======================================================================
+    public: // the grid-based (batched) evaluation 
+      // ======================================================================
+      /** prepare the grid-based representation of the transform for 
+       *  \f$ x_{min} \le x \le x_{max} \f$
+       *  - the function \f$ \varrho(\omega)/\omega^n\f$ is approximated 
+       *    by the piecewise Chebyshev proxy on \f$ [\omega_0, W]\f$
+       *    and the principal value integrals for the pieces are calculated 
+       *    analytically (the pieces close to \f$ x\f$) or via 
+       *    Gauss-Legendre quadrature (distant pieces)
+       *  - the contribution from \f$ [W,+\infty) \f$ is smooth in 
+       *    \f$ [x_{min}, x_{max}] \f$ and it is interpolated 
+       *  - when prepared, it is used by <code>operator()</code> and 
+       *    <code>evaluate</code> for the points in the range
+       *  @param xmin      low  edge of the range 
+       *  @param xmax      high edge of the range 
+       *  @param precision the relative (to the \f$ \max \left|\varrho/\omega^n\right| \f$) 
+       *                   precision of the piecewise Chebyshev approximation
+       *  @param N         the order of the Chebyshev approximation in each piece 
+       *  @return number of pieces 
+       *  @see Ostap::Math::ChebyshevProxy 
+       */
+      std::size_t prepare 
+      ( const double         xmin              , 
+        const double         xmax              , 
+        const double         precision = 1.e-9 , 
+        const unsigned short N         = 16    ) ;
+      /// is the grid-based representation prepared?
+      bool prepared () const { return !m_table.knots.empty () ; }
+      /// remove the grid-based representation 
+      void reset    () { m_table = Table () ; }
+      // ======================================================================
+      /** evaluate the transform for the array of points 
+       *  - the grid-based representation (if prepared) is used 
+       *    for the points in its range, 
+       *  - the direct integration is used otherwise  
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void evaluate 
+      ( const std::size_t n      , 
+        const double*     x      , 
+        double*           result ) const ;
+      // ======================================================================
     public:
       // ====================================================================== 
       /// get the value of \f$ \varrho \f$ function  
@@ -127,6 +179,35 @@ namespace Ostap
       /// Integrator
       Ostap::Math::Integrator        m_integrator ; // integrator 
       // ======================================================================
+    private:
+      // ======================================================================
+      /// the grid-based representation 
+      struct Table 
+      {
+        /// low edge of the range 
+        double              xmin         { 0 } ; // low edge of the range 
+        /// high edge of the range 
+        double              xmax         { 0 } ; // high edge of the range 
+        /// order of the Chebyshev approximation in each piece 
+        unsigned short      N            { 0 } ; // order in each piece 
+        /// knots of the pieces 
+        std::vector<double> knots        {}    ; // knots of the pieces 
+        /// Chebyshev coefficients (N per piece) 
+        std::vector<double> coefficients {}    ; // Chebyshev coefficients 
+        /// values at Gauss-Legendre nodes for each piece 
+        std::vector<double> values       {}    ; // values at Gauss-Legendre nodes
+        /// Chebyshev coefficients for the contribution from the tail 
+        std::vector<double> tail         {}    ; // coefficients for the tail 
+      } ;
+      // ======================================================================
+      /// evaluate the transform using the grid-based representation 
+      double _table_ ( const double x ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the grid-based representation 
+      Table                          m_table      {} ; // grid-based representation 
+      // ======================================================================
     };
     // ========================================================================
   } //                                         The end of namespace Ostap::Math
@@ -292,7 +292,7 @@ namespace Ostap
       const ROOT::Math::SMatrix<T,3,3,ROOT::Math::MatRepSym<T,3> > & matrix ) 
     {
       ROOT::Math::SVector<T,3> tmp ;
-      return ROOT::Math::Similarity ( geo2LA ( delta , tmp )  , matrix ) ;
+      return similarity ( matrix , geo2LA ( delta , tmp ) ) ;
     } 
     // ========================================================================
     /** construct similarity("chi2") using 3D-vector 
@@ -361,7 +361,7 @@ namespace Ostap
       const ROOT::Math::SMatrix<T,4,4,ROOT::Math::MatRepSym<T,4> > & matrix ) 
     {
       ROOT::Math::SVector<T,4> tmp ;
-      return ROOT::Math::Similarity ( geo2LA( delta , tmp ) , matrix ) ;
+      return similarity ( matrix , geo2LA ( delta , tmp ) ) ;
     }
     // ========================================================================
     /** construct similarity("chi2") using 4D-vector 
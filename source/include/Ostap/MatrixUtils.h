@@ -11,6 +11,7 @@
 #include <utility>
 #include <cmath>
 #include <array>
+#include <cstddef>
 // ============================================================================
 // ROOT
 // ============================================================================
@@ -44,6 +45,7 @@
  *     - check the presence of diagonal elements which satisfy some criteria
  *     - efficient element-by-element "equality" for matrices 
  *     - few specific "updates" (in the spirit of BLAS)
+ *     - unrolled fixed-size similarity kernels and their batched variants 
  *
  *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
  */
@@ -1317,6 +1319,256 @@ namespace Ostap
     }
     // ========================================================================
     
+    // ========================================================================
+    // FIXED-SIZE KERNELS 
+    // ========================================================================
+    namespace detail 
+    {
+      // ======================================================================
+      /** @struct Unroll 
+       *  compile-time loop <code>f(0), f(1), ... , f(N-1)</code>
+       */
+      template <unsigned int N>
+      struct Unroll 
+      {
+        template <class F>
+        static inline void loop ( F& f ) { Unroll<N-1>::loop ( f ) ; f ( N - 1 ) ; }
+      } ;
+      /// stop the recursion 
+      template <>
+      struct Unroll<0u> 
+      {
+        template <class F>
+        static inline void loop ( F& /* f */ ) {}
+      } ;
+      // ======================================================================
+      /// index in the packed storage of the symmetric matrix 
+      inline constexpr unsigned int sym_index 
+      ( const unsigned int i , 
+        const unsigned int j ) 
+      { return j <= i ? i * ( i + 1 ) / 2 + j : j * ( j + 1 ) / 2 + i ; }
+      // ======================================================================
+      /// use the unrolled kernels for small matrices 
+      template <unsigned int D>
+      struct Small { enum { value = ( D <= 5 ) } ; } ;
+      // ======================================================================
+    } //                                 The end of namespace Ostap::Math::detail 
+    // ========================================================================
+    /** similarity  \f$ v^T M v \f$ for the symmetric matrix 
+     *  - for small dimensions (up to 5) the loops are unrolled 
+     *    at compile time and the symmetry of the matrix is used 
+     *  - for larger dimensions <code>ROOT::Math::Similarity</code> is used 
+     *  @param M (INPUT) the symmetric matrix 
+     *  @param v (INPUT) the vector 
+     *  @return \f$ v^T M v \f$ 
+     *  @see ROOT::Math::Similarity 
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-02-01
+     */
+    template <class T, unsigned int D>
+    inline T similarity 
+    ( const ROOT::Math::SMatrix<T,D,D,ROOT::Math::MatRepSym<T,D> >& M , 
+      const ROOT::Math::SVector<T,D>&                               v ) 
+    {
+      if ( !detail::Small<D>::value ) { return ROOT::Math::Similarity ( M , v ) ; }
+      //
+      const T* m = M.Array () ;
+      T result   = 0 ;
+      auto row = [m,&v,&result] ( const unsigned int i ) 
+        {
+          T s = 0.5 * m [ detail::sym_index ( i , i ) ] * v [ i ] ;
+          auto col = [m,&v,&s,i] ( const unsigned int j ) 
+            { if ( j < i ) { s += m [ detail::sym_index ( i , j ) ] * v [ j ] ; } } ;
+          detail::Unroll<D>::loop ( col ) ;
+          result += v [ i ] * s ;
+        } ;
+      detail::Unroll<D>::loop ( row ) ;
+      return 2 * result ;
+    }
+    // ========================================================================
+    /** similarity  \f$ J C J^T \f$ (covariance propagation) 
+     *  - for small dimensions (up to 5) the loops are unrolled 
+     *    at compile time and only the lower triangle of the result is evaluated 
+     *  - for larger dimensions <code>ROOT::Math::Similarity</code> is used 
+     *  @param J (INPUT) the jacobian 
+     *  @param C (INPUT) the symmetric matrix 
+     *  @return \f$ J C J^T \f$ 
+     *  @see ROOT::Math::Similarity 
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-02-01
+     */
+    template <class T, unsigned int D1, unsigned int D2, class R>
+    inline ROOT::Math::SMatrix<T,D1,D1,ROOT::Math::MatRepSym<T,D1> >
+    similarity 
+    ( const ROOT::Math::SMatrix<T,D1,D2,R>&                           J , 
+      const ROOT::Math::SMatrix<T,D2,D2,ROOT::Math::MatRepSym<T,D2> >& C ) 
+    {
+      if ( !detail::Small<D1>::value || !detail::Small<D2>::value ) 
+      { return ROOT::Math::Similarity ( J , C ) ; }
+      //
+      ROOT::Math::SMatrix<T,D1,D1,ROOT::Math::MatRepSym<T,D1> > result ;
+      T*       r = result.Array () ;
+      const T* c = C     .Array () ;
+      //
+      // tmp = J * C 
+      T tmp [ D1 * D2 ] ;
+      auto jc = [&J,c,&tmp] ( const unsigned int i ) 
+        {
+          auto col = [&J,c,&tmp,i] ( const unsigned int k ) 
+            {
+              T s = 0 ;
+              auto dot = [&J,c,&s,i,k] ( const unsigned int l ) 
+                { s += J ( i , l ) * c [ detail::sym_index ( l , k ) ] ; } ;
+              detail::Unroll<D2>::loop ( dot ) ;
+              tmp [ i * D2 + k ] = s ;
+            } ;
+          detail::Unroll<D2>::loop ( col ) ;
+        } ;
+      detail::Unroll<D1>::loop ( jc ) ;
+      //
+      // result = tmp * J^T (lower triangle only) 
+      auto row = [&J,r,&tmp] ( const unsigned int i ) 
+        {
+          auto col = [&J,r,&tmp,i] ( const unsigned int j ) 
+            {
+              if ( i < j ) { return ; }
+              T s = 0 ;
+              auto dot = [&J,&tmp,&s,i,j] ( const unsigned int k ) 
+                { s += tmp [ i * D2 + k ] * J ( j , k ) ; } ;
+              detail::Unroll<D2>::loop ( dot ) ;
+              r [ detail::sym_index ( i , j ) ] = s ;
+            } ;
+          detail::Unroll<D1>::loop ( col ) ;
+        } ;
+      detail::Unroll<D1>::loop ( row ) ;
+      //
+      return result ;
+    }
+    // ========================================================================
+    /** similarity  \f$ J^T C J \f$ 
+     *  - for small dimensions (up to 5) the loops are unrolled 
+     *    at compile time and only the lower triangle of the result is evaluated 
+     *  - for larger dimensions <code>ROOT::Math::SimilarityT</code> is used 
+     *  @param J (INPUT) the matrix 
+     *  @param C (INPUT) the symmetric matrix 
+     *  @return \f$ J^T C J \f$ 
+     *  @see ROOT::Math::SimilarityT
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-02-01
+     */
+    template <class T, unsigned int D1, unsigned int D2, class R>
+    inline ROOT::Math::SMatrix<T,D2,D2,ROOT::Math::MatRepSym<T,D2> >
+    similarityT 
+    ( const ROOT::Math::SMatrix<T,D1,D2,R>&                           J , 
+      const ROOT::Math::SMatrix<T,D1,D1,ROOT::Math::MatRepSym<T,D1> >& C ) 
+    {
+      if ( !detail::Small<D1>::value || !detail::Small<D2>::value ) 
+      { return ROOT::Math::SimilarityT ( J , C ) ; }
+      //
+      ROOT::Math::SMatrix<T,D2,D2,ROOT::Math::MatRepSym<T,D2> > result ;
+      T*       r = result.Array () ;
+      const T* c = C     .Array () ;
+      //
+      // tmp = C * J 
+      T tmp [ D1 * D2 ] ;
+      auto cj = [&J,c,&tmp] ( const unsigned int l ) 
+        {
+          auto col = [&J,c,&tmp,l] ( const unsigned int k ) 
+            {
+              T s = 0 ;
+              auto dot = [&J,c,&s,l,k] ( const unsigned int i ) 
+                { s += c [ detail::sym_index ( l , i ) ] * J ( i , k ) ; } ;
+              detail::Unroll<D1>::loop ( dot ) ;
+              tmp [ l * D2 + k ] = s ;
+            } ;
+          detail::Unroll<D2>::loop ( col ) ;
+        } ;
+      detail::Unroll<D1>::loop ( cj ) ;
+      //
+      // result = J^T * tmp (lower triangle only) 
+      auto row = [&J,r,&tmp] ( const unsigned int i ) 
+        {
+          auto col = [&J,r,&tmp,i] ( const unsigned int j ) 
+            {
+              if ( i < j ) { return ; }
+              T s = 0 ;
+              auto dot = [&J,&tmp,&s,i,j] ( const unsigned int l ) 
+                { s += J ( l , i ) * tmp [ l * D2 + j ] ; } ;
+              detail::Unroll<D1>::loop ( dot ) ;
+              r [ detail::sym_index ( i , j ) ] = s ;
+            } ;
+          detail::Unroll<D2>::loop ( col ) ;
+        } ;
+      detail::Unroll<D2>::loop ( row ) ;
+      //
+      return result ;
+    }
+    // ========================================================================
+    /** batched similarity \f$ v_n^T M_n v_n \f$ 
+     *  @param M      (INPUT)  the array of symmetric matrices 
+     *  @param v      (INPUT)  the array of vectors 
+     *  @param result (OUTPUT) the array of results 
+     *  @param N      (INPUT)  the length of arrays 
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-02-01
+     */
+    template <class T, unsigned int D>
+    inline void similarity 
+    ( const ROOT::Math::SMatrix<T,D,D,ROOT::Math::MatRepSym<T,D> >* M      , 
+      const ROOT::Math::SVector<T,D>*                               v      , 
+      T*                                                            result , 
+      const std::size_t                                             N      ) 
+    { for ( std::size_t n = 0 ; n < N ; ++n ) { result [ n ] = similarity ( M [ n ] , v [ n ] ) ; } }
+    // ========================================================================
+    /** batched similarity \f$ v_n^T M v_n \f$ with the common matrix 
+     *  @param M      (INPUT)  the symmetric matrix 
+     *  @param v      (INPUT)  the array of vectors 
+     *  @param result (OUTPUT) the array of results 
+     *  @param N      (INPUT)  the length of arrays 
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-02-01
+     */
+    template <class T, unsigned int D>
+    inline void similarity 
+    ( const ROOT::Math::SMatrix<T,D,D,ROOT::Math::MatRepSym<T,D> >& M      , 
+      const ROOT::Math::SVector<T,D>*                               v      , 
+      T*                                                            result , 
+      const std::size_t                                             N      ) 
+    { for ( std::size_t n = 0 ; n < N ; ++n ) { result [ n ] = similarity ( M , v [ n ] ) ; } }
+    // ========================================================================
+    /** batched similarity \f$ J_n C_n J_n^T \f$ 
+     *  @param J      (INPUT)  the array of jacobians 
+     *  @param C      (INPUT)  the array of symmetric matrices 
+     *  @param result (OUTPUT) the array of results 
+     *  @param N      (INPUT)  the length of arrays 
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-02-01
+     */
+    template <class T, unsigned int D1, unsigned int D2, class R>
+    inline void similarity 
+    ( const ROOT::Math::SMatrix<T,D1,D2,R>*                           J      , 
+      const ROOT::Math::SMatrix<T,D2,D2,ROOT::Math::MatRepSym<T,D2> >* C      , 
+      ROOT::Math::SMatrix<T,D1,D1,ROOT::Math::MatRepSym<T,D1> >*       result , 
+      const std::size_t                                               N      ) 
+    { for ( std::size_t n = 0 ; n < N ; ++n ) { result [ n ] = similarity ( J [ n ] , C [ n ] ) ; } }
+    // ========================================================================
+    /** batched similarity \f$ J C_n J^T \f$ with the common jacobian 
+     *  @param J      (INPUT)  the jacobian 
+     *  @param C      (INPUT)  the array of symmetric matrices 
+     *  @param result (OUTPUT) the array of results 
+     *  @param N      (INPUT)  the length of arrays 
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-02-01
+     */
+    template <class T, unsigned int D1, unsigned int D2, class R>
+    inline void similarity 
+    ( const ROOT::Math::SMatrix<T,D1,D2,R>&                           J      , 
+      const ROOT::Math::SMatrix<T,D2,D2,ROOT::Math::MatRepSym<T,D2> >* C      , 
+      ROOT::Math::SMatrix<T,D1,D1,ROOT::Math::MatRepSym<T,D1> >*       result , 
+      const std::size_t                                               N      ) 
+    { for ( std::size_t n = 0 ; n < N ; ++n ) { result [ n ] = similarity ( J , C [ n ] ) ; } }
+    // ========================================================================
+    
     // ========================================================================
     // helper functions to allow proper operations in PyROOT
     // - need to avoid expressions  (no easy way to use them in PyROOT)
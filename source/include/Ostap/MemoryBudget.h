@@ -0,0 +1,72 @@
+// ============================================================================
+#ifndef OSTAP_MEMORYBUDGET_H
+#define OSTAP_MEMORYBUDGET_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstddef>
+// ============================================================================
+/** @file Ostap/MemoryBudget.h
+ *  The memory budget for the multithreaded engines
+ *  (projections, dataset filling, ...):
+ *  the number of per-thread buffers, histogram clones and
+ *  the prefetch depth are adjusted to fit into the budget
+ *
+ *  The budget is defined either explicitly
+ *  via <code>Ostap::Utils::set_memory_budget</code>
+ *  or by the environment variable <code>OSTAP_MEMORY_BUDGET</code> (in MB),
+ *  e.g. the memory limit of the batch slot.
+ *  Zero budget means no limit.
+ *  @code
+ *  Ostap::Utils::set_memory_budget ( 2000ul << 20 ) ; // 2GB
+ *  @endcode
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /// the current resident set size of the process (in bytes)
+    std::size_t rss              () ;
+    /// the peak resident set size of the process (in bytes)
+    std::size_t peak_rss         () ;
+    // ========================================================================
+    /** get the memory budget (in bytes), zero means no limit
+     *  - the explicitly defined budget, if set
+     *  - otherwise the environment variable <code>OSTAP_MEMORY_BUDGET</code> (in MB)
+     */
+    std::size_t memory_budget    () ;
+    /** set the memory budget (in bytes), zero means no limit
+     *  @return the previous (explicitly defined) budget
+     */
+    std::size_t set_memory_budget ( const std::size_t bytes ) ;
+    // ========================================================================
+    /** the memory still available within the budget:
+     *  <code>budget - rss</code> (or the maximal value if no limit is defined)
+     */
+    std::size_t memory_available () ;
+    // ========================================================================
+    /** how many copies of the object of given size
+     *  fit into the available memory?
+     *  @param size  the size of the object (in bytes)
+     *  @param n     the requested number of copies
+     *  @return the number of copies, <code>0<=result<=n</code>
+     */
+    std::size_t copies_in_budget
+    ( const std::size_t size ,
+      const std::size_t n    ) ;
+    // ========================================================================
+  } //                                       The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_MEMORYBUDGET_H
+// ============================================================================
@@ -91,6 +91,14 @@ namespace Ostap
       double operator() ( const double x )  const { return pdf ( x ) ; }
       /// get a value for the function      
       double pdf  ( const double x ) const ;
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:  // integrals
       // ======================================================================
@@ -255,6 +263,14 @@ namespace Ostap
       /// evaluate N/L-body modulated phase space
       double operator () ( const double x ) const  
       { return evaluate ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -503,6 +519,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// calculate gamma distribution shape
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -728,6 +752,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// calculate gamma distribution shape
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // getters
       // ======================================================================
@@ -815,6 +847,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate Amoroso distribtion
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:  // direct getters
       // ======================================================================
@@ -906,6 +946,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// calculate log-gamma shape
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // direct getter s
       // ======================================================================
@@ -980,6 +1028,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate beta'-distributions
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // direct getters
       // ======================================================================
@@ -1055,6 +1111,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate beta'-distributions
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // direct getters
       // ======================================================================
@@ -1110,6 +1174,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate Weibull-distributions
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: //  direct & derived getters 
       // ======================================================================
@@ -1193,6 +1265,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate beta'-distributions
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // direct getters
       // ======================================================================
@@ -1350,6 +1430,14 @@ namespace Ostap
       // ======================================================================
       /// get the value
       double operator () ( const double x ) const ;
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -1437,6 +1525,14 @@ namespace Ostap
       // ======================================================================
       /// get the value
       double operator() ( const double x ) const ;
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -1685,6 +1781,14 @@ namespace Ostap
       double pdf ( const double x ) const ;
       /// get Tsallis PDF
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -1791,6 +1895,14 @@ namespace Ostap
       double pdf ( const double x ) const ;
       /// define QGSM pdf
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -1884,6 +1996,14 @@ namespace Ostap
       // ======================================================================
       /// the main method 
       double operator() ( const double x ) const ;
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // getters 
       // ======================================================================
@@ -1948,6 +2068,14 @@ namespace Ostap
       // ======================================================================
       /// the main method 
       double operator() ( const double x ) const ;
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // getters 
       // ======================================================================
@@ -8,6 +8,10 @@
 // ============================================================================
 #include <cmath>
 #include <array>
+#include <vector>
+#include <thread>
+#include <cstddef>
+#include <algorithm>
 #include <type_traits>
 // ============================================================================
 // Ostap
@@ -20,6 +24,139 @@ namespace  Ostap
   // ==========================================================================
   namespace Math
   {
+    // ========================================================================
+    namespace detail
+    {
+      // ======================================================================
+      /// the size of the block for the blocked accumulation of moments 
+      const std::size_t s_MOMENT_BLOCK = 1024 ;
+      /// the number of independent lanes (accumulators) in the block kernel 
+      const std::size_t s_MOMENT_LANES = 8    ;
+      /// the minimal number of entries per thread for the parallel accumulation 
+      const std::size_t s_MOMENT_CHUNK = 1 << 16 ;
+      // ======================================================================
+      /** the kernel for the block of (weighted) values: 
+       *  the (weighted) mean and the central sums 
+       *  \f$ M_k = \sum_i w_i\left( x_i - \bar{x} \right)^k \f$ for 
+       *  \f$ 2 \le k \le N \f$ are calculated in two passes, 
+       *  using independent lanes, that allows the vectorization 
+       *  @param x    (INPUT)  values 
+       *  @param w    (INPUT)  weights (nullptr for unit weights) 
+       *  @param n    (INPUT)  number of values 
+       *  @param sumw (OUTPUT) sum of weights 
+       *  @param sw2  (OUTPUT) sum of weights squared  
+       *  @param mu   (OUTPUT) the (weighted) mean 
+       *  @param M    (OUTPUT) the central sums (array of length N+1, only 2..N are filled)
+       */
+      template <unsigned short N>
+      inline void moment_block 
+      ( const double*     x    , 
+        const double*     w    , 
+        const std::size_t n    , 
+        long double&      sumw ,
+        long double&      sw2  , 
+        long double&      mu   , 
+        long double*      M    )
+      {
+        const std::size_t L  = s_MOMENT_LANES ;
+        const std::size_t nL = n - n % L ;
+        // the first pass: (weighted) mean 
+        double s0 [ L ] = {} ;
+        double s1 [ L ] = {} ;
+        double s2 [ L ] = {} ;
+        for ( std::size_t i = 0 ; i < nL ; i += L )
+        {
+          for ( std::size_t l = 0 ; l < L ; ++l )
+          {
+            const double wi = w ? w [ i + l ] : 1.0 ;
+            s0 [ l ] += wi ;
+            s1 [ l ] += wi * x [ i + l ] ;
+            s2 [ l ] += wi * wi ;
+          }
+        }
+        long double S0 = 0 , S1 = 0 , S2 = 0 ;
+        for ( std::size_t l = 0 ; l < L ; ++l ) { S0 += s0 [ l ] ; S1 += s1 [ l ] ; S2 += s2 [ l ] ; }
+        for ( std::size_t i = nL ; i < n ; ++i )
+        {
+          const double wi = w ? w [ i ] : 1.0 ;
+          S0 += wi ; S1 += wi * x [ i ] ; S2 += wi * wi ;
+        }
+        sumw = S0 ;
+        sw2  = S2 ;
+        for ( unsigned short k = 0 ; k <= N ; ++k ) { M [ k ] = 0 ; }
+        if ( !S0 ) { mu = 0 ; return ; }
+        const double m = static_cast<double> ( S1 / S0 ) ;
+        // the second pass: the sums of powers of deviations
+        double a [ N + 1 ][ L ] = {} ;
+        for ( std::size_t i = 0 ; i < nL ; i += L )
+        {
+          for ( std::size_t l = 0 ; l < L ; ++l )
+          {
+            const double d = x [ i + l ] - m ;
+            double       p = w ? w [ i + l ] : 1.0 ;
+            for ( unsigned short k = 1 ; k <= N ; ++k ) { p *= d ; a [ k ][ l ] += p ; }
+          }
+        }
+        long double D [ N + 1 ] = {} ;
+        for ( unsigned short k = 1 ; k <= N ; ++k )
+        { for ( std::size_t l = 0 ; l < L ; ++l ) { D [ k ] += a [ k ][ l ] ; } }
+        for ( std::size_t i = nL ; i < n ; ++i )
+        {
+          const double d = x [ i ] - m ;
+          long double  p = w ? w [ i ] : 1.0 ;
+          for ( unsigned short k = 1 ; k <= N ; ++k ) { p *= d ; D [ k ] += p ; }
+        }
+        D [ 0 ] = S0 ;
+        // correct for the rounding of the mean:
+        // M_k = \sum_j C(k,j) D_j (-e)^{k-j}, where e = D_1/S0 
+        const long double e = D [ 1 ] / S0 ;
+        mu = m + e ;
+        for ( unsigned short k = 2 ; k <= N ; ++k )
+        {
+          long double r = 0 ;
+          long double c = 1 ; // C(k,j) (-e)^{k-j} for j = k, k-1, ...
+          for ( int j = k ; 0 <= j ; --j )
+          {
+            r += c * D [ j ] ;
+            c *= -e * j / ( k - j + 1 ) ;
+          }
+          M [ k ] = r ;
+        }
+      }
+      // ======================================================================
+      /** fold the large range <code>[0,n)</code> into the counters in parallel:
+       *  the range is split into contiguous chunks, each chunk is 
+       *  processed by <code>fill(first,last,counter)</code> in its own thread, 
+       *  and the counters are merged in the natural order
+       *  @param counter  (UPDATE) the counter 
+       *  @param n        (INPUT)  the size of the range 
+       *  @param nthreads (INPUT)  number of threads, 0 means hardware concurrency
+       *  @param fill     (INPUT)  the function to fill the counter for the subrange
+       */
+      template <class COUNTER, class FILL>
+      inline void parallel_fold 
+      ( COUNTER&           counter  , 
+        const std::size_t  n        , 
+        const unsigned int nthreads , 
+        FILL               fill     ) 
+      {
+        std::size_t nt = nthreads ? nthreads : std::thread::hardware_concurrency () ;
+        nt = std::max ( std::size_t ( 1 ) , std::min ( nt , n / s_MOMENT_CHUNK ) ) ;
+        if ( 1 == nt ) { fill ( 0 , n , counter ) ; return ; }
+        //
+        std::vector<COUNTER>     parts   ( nt ) ;
+        std::vector<std::thread> threads ; threads.reserve ( nt ) ;
+        for ( std::size_t t = 0 ; t < nt ; ++t )
+        { 
+          const std::size_t first = ( n * t       ) / nt ; 
+          const std::size_t last  = ( n * ( t + 1 ) ) / nt ; 
+          threads.emplace_back ( [first,last,t,&parts,&fill] () { fill ( first , last , parts [ t ] ) ; } ) ;
+        }
+        for ( auto& t : threads ) { t.join () ; }
+        for ( const auto& p : parts ) { counter += p ; }
+      }
+      // ======================================================================
+    } //                                 The end of namespace Ostap::Math::detail 
     // ========================================================================
     /** @struct Moment
      *  Helper (empty) base class for moment-counters 
@@ -61,6 +198,22 @@ namespace  Ostap
       // ======================================================================
       enum _ { order = N } ;
       // ======================================================================
+    public:
+      // ======================================================================
+      /// default constructor 
+      Moment_ () = default ;
+      /** full constructor from the number of entries, mean and central sums 
+       *  @param n  the number of entries 
+       *  @param mu the mean value 
+       *  @param M  the central sums \f$ M_k \f$  for \f$ 2 \le k \le N \f$ (array of length N+1)
+       */
+      Moment_ ( const unsigned long long n  , 
+                const long double        mu , 
+                const long double*       M  ) 
+        : m_prev ( n , mu , M ) 
+        , m_M    ( M [ N ]    ) 
+      {}
+      // ======================================================================
     public:
       // ======================================================================
       /** get the value of the Nth moment 
@@ -94,10 +247,30 @@ namespace  Ostap
       // ======================================================================
       /// add single value 
       void  add ( const double x ){ *this += x ; }
-      /// add sequence of values  
+      /** add sequence of values: the values are processed by blocks, 
+       *  and each block is merged into the counter 
+       */
       template <class ITERATOR>
       void add ( ITERATOR begin , ITERATOR end   )
-      { for ( ; begin != end ; ++begin ) { this->add ( *begin ) ; } }
+      {
+        double buffer [ detail::s_MOMENT_BLOCK ] ;
+        while ( begin != end )
+        {
+          std::size_t n = 0 ;
+          for ( ; begin != end && n < detail::s_MOMENT_BLOCK ; ++begin , ++n ) { buffer [ n ] = *begin ; }
+          this->add_block_ ( buffer , n ) ;
+        }
+      }
+      /** add the array of values: the values are processed by blocks, 
+       *  and each block is merged into the counter 
+       *  @param data     (INPUT) the array of values 
+       *  @param size     (INPUT) the size of array 
+       *  @param nthreads (INPUT) number of threads for large arrays, 0 means hardware concurrency 
+       */
+      inline void add 
+      ( const double*      data         , 
+        const std::size_t  size         , 
+        const unsigned int nthreads = 1 ) ;
       // ======================================================================
     public: // python operations 
       // ======================================================================
@@ -129,6 +302,17 @@ namespace  Ostap
       inline long double M ( const unsigned short k ) const
       { return k >  N ? 0.0L : k == N ? this->m_M : this->m_prev.M( k ) ; }
       // ======================================================================
+    private:
+      // ======================================================================
+      /// add the block of values 
+      void add_block_ ( const double* x , const std::size_t n ) 
+      {
+        if ( !n ) { return ; }
+        long double sumw , sumw2 , mu , M [ N + 1 ] ;
+        detail::moment_block<N> ( x , nullptr , n , sumw , sumw2 , mu , M ) ;
+        *this += Moment_ ( n , mu , M ) ;
+      }
+      // ======================================================================
     private:
       // ======================================================================
       /// counter of (N-1)th order
@@ -171,6 +355,22 @@ namespace  Ostap
       return *this ;
     }
     // ========================================================================
+    /// add the array of values 
+    template <unsigned short N>
+    inline void Moment_<N>::add 
+    ( const double*      data     , 
+      const std::size_t  size     , 
+      const unsigned int nthreads ) 
+    {
+      detail::parallel_fold 
+        ( *this , size , nthreads , 
+          [data] ( const std::size_t first , const std::size_t last , Moment_<N>& cnt ) 
+          {
+            for ( std::size_t i = first ; i < last ; i += detail::s_MOMENT_BLOCK ) 
+            { cnt.add_block_ ( data + i , std::min ( detail::s_MOMENT_BLOCK , last - i ) ) ; } 
+          } ) ;
+    }
+    // ========================================================================
     /// increment with some other counter 
     template <unsigned short N>
     Moment_<N>& Moment_<N>::operator+= ( const Moment_<N>&  x )
@@ -215,6 +415,17 @@ namespace  Ostap
       // ======================================================================
       enum _ { order = 0 } ;
       // ======================================================================
+    public:
+      // ======================================================================
+      /// default constructor 
+      Moment_ () = default ;
+      /// full constructor from the number of entries 
+      Moment_ ( const unsigned long long n                      , 
+                const long double        /* mu */ = 0       , 
+                const long double*       /* M  */ = nullptr ) 
+        : m_size ( n ) 
+      {}
+      // ======================================================================
     public:
       // ======================================================================
       /** get the value of the Nth moment 
@@ -249,6 +460,10 @@ namespace  Ostap
       template <class ITERATOR>
       void add ( ITERATOR begin , ITERATOR end   )
       { m_size += std::distance  ( begin , end ) ; }
+      /// add the array of values  
+      void add ( const double*      /* data */     , 
+                 const std::size_t  size           , 
+                 const unsigned int /* nthreads */ = 1 ) { m_size += size ; }
       // ======================================================================
     public: // python operations 
       // ======================================================================
@@ -277,7 +492,7 @@ namespace  Ostap
       // ======================================================================
     private:
       // ======================================================================
-      unsigned long long m_size ;
+      unsigned long long m_size { 0 } ;
       // ======================================================================
     private:
       // ======================================================================
@@ -295,6 +510,18 @@ namespace  Ostap
       // ======================================================================
       enum _ { order = 1 } ;
       // ======================================================================
+    public :
+      // ======================================================================
+      /// default constructor 
+      Moment_ () = default ;
+      /// full constructor from the number of entries and the mean value 
+      Moment_ ( const unsigned long long n                  , 
+                const long double        mu                 , 
+                const long double*       /* M */ = nullptr  ) 
+        : m_prev ( n  ) 
+        , m_mu   ( mu ) 
+      {}
+      // ======================================================================
     public :
       // ======================================================================
       /** get the value of the Nth moment 
@@ -345,10 +572,35 @@ namespace  Ostap
       // ======================================================================
       /// add single value 
       void add ( const double x ){ (*this) += x ; }
-      /// add sequence of values  
+      /// add sequence of values (by blocks)
       template <class ITERATOR>
       void add ( ITERATOR begin , ITERATOR end   )
-      { for ( ; begin != end ; ++begin ) { this->add ( *begin ) ; } }
+      {
+        double buffer [ detail::s_MOMENT_BLOCK ] ;
+        while ( begin != end )
+        {
+          std::size_t n = 0 ;
+          for ( ; begin != end && n < detail::s_MOMENT_BLOCK ; ++begin , ++n ) { buffer [ n ] = *begin ; }
+          this->add_block_ ( buffer , n ) ;
+        }
+      }
+      /** add the array of values (by blocks)
+       *  @param data     (INPUT) the array of values 
+       *  @param size     (INPUT) the size of array 
+       *  @param nthreads (INPUT) number of threads for large arrays, 0 means hardware concurrency 
+       */
+      void add ( const double*      data         , 
+                 const std::size_t  size         , 
+                 const unsigned int nthreads = 1 ) 
+      {
+        detail::parallel_fold 
+          ( *this , size , nthreads , 
+            [data] ( const std::size_t first , const std::size_t last , Moment_& cnt ) 
+            {
+              for ( std::size_t i = first ; i < last ; i += detail::s_MOMENT_BLOCK ) 
+              { cnt.add_block_ ( data + i , std::min ( detail::s_MOMENT_BLOCK , last - i ) ) ; } 
+            } ) ;
+      }
       // ======================================================================
     public: // python operations 
       // ======================================================================
@@ -375,7 +627,18 @@ namespace  Ostap
       inline long double M ( const unsigned short k ) const
       { return 1 < k  ? 0 : 1 == k ? 0 : this->m_prev. M ( k ) ; }
       // ======================================================================
-    private:    private:
+    private:
+      // ======================================================================
+      /// add the block of values 
+      void add_block_ ( const double* x , const std::size_t n ) 
+      {
+        if ( !n ) { return ; }
+        long double sumw , sumw2 , mu , M [ 2 ] ;
+        detail::moment_block<1> ( x , nullptr , n , sumw , sumw2 , mu , M ) ;
+        *this += Moment_ ( n , mu ) ;
+      }
+      // ======================================================================
+    private:
       // ======================================================================
       Moment_<0>  m_prev { } ;
       /// mean value
@@ -449,6 +712,27 @@ namespace  Ostap
       // ======================================================================
       enum _ { order = N } ;
       // ======================================================================
+    public:
+      // ======================================================================
+      /// default constructor 
+      WMoment_ () = default ;
+      /** full constructor from the number of entries, sums of weights, 
+       *  the weighted mean and the weighted central sums 
+       *  @param n     the number of entries 
+       *  @param sumw  the sum of weights 
+       *  @param sumw2 the sum of weights squared 
+       *  @param mu    the weighted mean value 
+       *  @param M     the central sums \f$ M_k \f$  for \f$ 2 \le k \le N \f$ (array of length N+1)
+       */
+      WMoment_ ( const unsigned long long n     , 
+                 const long double        sumw  , 
+                 const long double        sumw2 , 
+                 const long double        mu    , 
+                 const long double*       M     ) 
+        : m_prev ( n , sumw , sumw2 , mu , M ) 
+        , m_M    ( M [ N ] ) 
+      {}
+      // ======================================================================
     public:
       // ======================================================================
       /** get the value of the Nth weighted  moment 
@@ -486,6 +770,34 @@ namespace  Ostap
       // ======================================================================
       /// add single value 
       inline void add ( const double x , const double w = 1 ) ;
+      /** add sequence of values and weights: the values are processed by blocks, 
+       *  and each block is merged into the counter 
+       */
+      template <class XITERATOR, class WITERATOR>
+      void add ( XITERATOR xbegin , XITERATOR xend , WITERATOR wbegin )
+      {
+        double xbuffer [ detail::s_MOMENT_BLOCK ] ;
+        double wbuffer [ detail::s_MOMENT_BLOCK ] ;
+        while ( xbegin != xend )
+        {
+          std::size_t n = 0 ;
+          for ( ; xbegin != xend && n < detail::s_MOMENT_BLOCK ; ++xbegin , ++wbegin , ++n ) 
+          { xbuffer [ n ] = *xbegin ; wbuffer [ n ] = *wbegin ; }
+          this->add_block_ ( xbuffer , wbuffer , n ) ;
+        }
+      }
+      /** add the arrays of values and weights: the values are processed by blocks, 
+       *  and each block is merged into the counter 
+       *  @param x        (INPUT) the array of values 
+       *  @param size     (INPUT) the size of arrays 
+       *  @param w        (INPUT) the array of weights, nullptr means unit weights 
+       *  @param nthreads (INPUT) number of threads for large arrays, 0 means hardware concurrency 
+       */
+      inline void add 
+      ( const double*      x            , 
+        const std::size_t  size         , 
+        const double*      w            , 
+        const unsigned int nthreads = 1 ) ;
       // ======================================================================
     public: // python operations 
       // ======================================================================
@@ -513,6 +825,17 @@ namespace  Ostap
       inline long double M ( const unsigned short k ) const
       { return k >  N ? 0.0L : k == N ? this->m_M : this->m_prev.M( k ) ; }
       // ======================================================================
+    private:
+      // ======================================================================
+      /// add the block of values 
+      void add_block_ ( const double* x , const double* w , const std::size_t n ) 
+      {
+        if ( !n ) { return ; }
+        long double sumw , sumw2 , mu , M [ N + 1 ] ;
+        detail::moment_block<N> ( x , w , n , sumw , sumw2 , mu , M ) ;
+        *this += WMoment_ ( n , sumw , sumw2 , mu , M ) ;
+      }
+      // ======================================================================
     private:
       // ======================================================================
       /// counter of (N-1)th order
@@ -535,13 +858,15 @@ namespace  Ostap
     template <unsigned short N>
     inline void WMoment_<N>::add ( const double  x , const double w )
     {
-      const auto nA = this->size() ;
+      const long double wA    = this->w() ;
+      const long double W     = wA + w    ;
+      if ( !W ) { this->m_prev.add ( x , w ) ; return ; }
       const long double delta = x - this->mu() ;
-      const long double b_n =      -1.0L / ( nA + 1 ) ;
-      const long double a_n =  nA * 1.0L / ( nA + 1 ) ;
-      const long double d_n = - delta    / ( nA + 1 ) ;
+      const long double b_n   = -1.0L * w / W ;
+      const long double a_n   =        wA / W ;
+      const long double d_n   = b_n * delta ;
       //
-      m_M += ( nA * std::pow ( b_n , N ) + std::pow ( a_n , N ) ) * std::pow ( delta , N ) ;
+      m_M += ( wA * std::pow ( b_n , N ) + w * std::pow ( a_n , N ) ) * std::pow ( delta , N ) ;
       long double d = 1 ;
       for ( unsigned int k = 1 ; k + 2 <= N ; ++k )
       {
@@ -552,6 +877,23 @@ namespace  Ostap
       this->m_prev.add ( x , w ) ; 
     }
     // ========================================================================
+    /// add the arrays of values and weights 
+    template <unsigned short N>
+    inline void WMoment_<N>::add 
+    ( const double*      x        , 
+      const std::size_t  size     , 
+      const double*      w        , 
+      const unsigned int nthreads ) 
+    {
+      detail::parallel_fold 
+        ( *this , size , nthreads , 
+          [x,w] ( const std::size_t first , const std::size_t last , WMoment_<N>& cnt ) 
+          {
+            for ( std::size_t i = first ; i < last ; i += detail::s_MOMENT_BLOCK ) 
+            { cnt.add_block_ ( x + i , w ? w + i : nullptr , std::min ( detail::s_MOMENT_BLOCK , last - i ) ) ; } 
+          } ) ;
+    }
+    // ========================================================================
     /// increment with some other counter 
     template <unsigned short N>
     inline WMoment_<N>& WMoment_<N>::operator+= ( const WMoment_<N>&  x )
@@ -596,6 +938,21 @@ namespace  Ostap
       // ======================================================================
       enum _ { order = 0 } ;
       // ======================================================================
+    public:
+      // ======================================================================
+      /// default constructor 
+      WMoment_ () = default ;
+      /// full constructor from the number of entries and sums of weights 
+      WMoment_ ( const unsigned long long n                    , 
+                 const long double        sumw                 , 
+                 const long double        sumw2                , 
+                 const long double        /* mu */ = 0         , 
+                 const long double*       /* M  */ = nullptr   ) 
+        : m_size ( n     ) 
+        , m_w    ( sumw  ) 
+        , m_w2   ( sumw2 ) 
+      {}
+      // ======================================================================
     public:
       // ======================================================================
       /** get the value of the 0th moment 
@@ -632,6 +989,19 @@ namespace  Ostap
       /// add single value
       inline void add ( const double /* x */ , const double w = 1 )
       { ++m_size ; m_w += w ; m_w2 += w * w ; }
+      /// add sequence of values and weights 
+      template <class XITERATOR, class WITERATOR>
+      void add ( XITERATOR xbegin , XITERATOR xend , WITERATOR wbegin )
+      { for ( ; xbegin != xend ; ++xbegin , ++wbegin ) { this->add ( *xbegin , *wbegin ) ; } }
+      /// add the arrays of values and weights (nullptr means unit weights)
+      void add ( const double*      /* x */        , 
+                 const std::size_t  size           , 
+                 const double*      w              , 
+                 const unsigned int /* nthreads */ = 1 ) 
+      {
+        if ( !w ) { m_size += size ; m_w += size ; m_w2 += size ; return ; }
+        for ( std::size_t i = 0 ; i < size ; ++i ) { this->add ( 0.0 , w [ i ] ) ; }
+      }
       // ======================================================================
     public: // python operations 
       // ======================================================================
@@ -657,11 +1027,11 @@ namespace  Ostap
     private:
       // ======================================================================
       /// number of entries 
-      unsigned long long m_size ; // number of entries
+      unsigned long long m_size { 0 } ; // number of entries
       /// sum of weights \f$  \sum w_i \f$ 
-      long double        m_w    ; // sum of weights
+      long double        m_w    { 0 } ; // sum of weights
       /// sum of weights squared \f$  \sum w_i^2 \f$ 
-      long double        m_w2   ; // sum of weights squared 
+      long double        m_w2   { 0 } ; // sum of weights squared 
       // ======================================================================
     private:
       // ======================================================================
@@ -679,6 +1049,20 @@ namespace  Ostap
       // ======================================================================
       enum _ { order = 1 } ;
       // ======================================================================
+    public :
+      // ======================================================================
+      /// default constructor 
+      WMoment_ () = default ;
+      /// full constructor from the number of entries, sums of weights and the mean  
+      WMoment_ ( const unsigned long long n                  , 
+                 const long double        sumw               , 
+                 const long double        sumw2              , 
+                 const long double        mu                 , 
+                 const long double*       /* M */ = nullptr  ) 
+        : m_prev ( n , sumw , sumw2 ) 
+        , m_mu   ( mu ) 
+      {}
+      // ======================================================================
     public :
       // ======================================================================
       /** get the value of the 1st moment 
@@ -713,9 +1097,9 @@ namespace  Ostap
         if      ( 0 == x     . size () ) {               return (*this) ; }
         else if ( 0 == this -> size () ) { (*this) = x ; return (*this) ; }
         //
-        const long double wA =   m_prev.size() ;
-        const long double wB = x.m_prev.size() ;
-        m_mu = ( wA * m_mu + wB * x.m_mu ) / ( wA + wB ) ; // update mean
+        const long double wA =   m_prev.w () ;
+        const long double wB = x.m_prev.w () ;
+        if ( wA + wB ) { m_mu = ( wA * m_mu + wB * x.m_mu ) / ( wA + wB ) ; } // update mean
         //
         m_prev += x.m_prev ;                               // update previous
         //
@@ -730,10 +1114,43 @@ namespace  Ostap
         const long double wA = this -> w() ;
         const long double wB = w ;
         //
-        m_mu = ( wA * m_mu + wB * x ) / ( wA + wB ) ; // update mean
+        if ( wA + wB ) { m_mu = ( wA * m_mu + wB * x ) / ( wA + wB ) ; } // update mean
         //
         this->m_prev.add ( x , w ) ;
       }
+      /// add sequence of values and weights (by blocks)
+      template <class XITERATOR, class WITERATOR>
+      void add ( XITERATOR xbegin , XITERATOR xend , WITERATOR wbegin )
+      {
+        double xbuffer [ detail::s_MOMENT_BLOCK ] ;
+        double wbuffer [ detail::s_MOMENT_BLOCK ] ;
+        while ( xbegin != xend )
+        {
+          std::size_t n = 0 ;
+          for ( ; xbegin != xend && n < detail::s_MOMENT_BLOCK ; ++xbegin , ++wbegin , ++n ) 
+          { xbuffer [ n ] = *xbegin ; wbuffer [ n ] = *wbegin ; }
+          this->add_block_ ( xbuffer , wbuffer , n ) ;
+        }
+      }
+      /** add the arrays of values and weights (by blocks)
+       *  @param x        (INPUT) the array of values 
+       *  @param size     (INPUT) the size of arrays 
+       *  @param w        (INPUT) the array of weights, nullptr means unit weights 
+       *  @param nthreads (INPUT) number of threads for large arrays, 0 means hardware concurrency 
+       */
+      void add ( const double*      x            , 
+                 const std::size_t  size         , 
+                 const double*      w            , 
+                 const unsigned int nthreads = 1 ) 
+      {
+        detail::parallel_fold 
+          ( *this , size , nthreads , 
+            [x,w] ( const std::size_t first , const std::size_t last , WMoment_& cnt ) 
+            {
+              for ( std::size_t i = first ; i < last ; i += detail::s_MOMENT_BLOCK ) 
+              { cnt.add_block_ ( x + i , w ? w + i : nullptr , std::min ( detail::s_MOMENT_BLOCK , last - i ) ) ; } 
+            } ) ;
+      }
       // ======================================================================
     public: // python operations 
       // ======================================================================
@@ -756,6 +1173,17 @@ namespace  Ostap
       inline long double M ( const unsigned short k ) const
       { return 1 < k  ? 0 : 1 == k ? 0 : this->m_prev. M ( k ) ; }
       // ======================================================================
+    private:
+      // ======================================================================
+      /// add the block of values 
+      void add_block_ ( const double* x , const double* w , const std::size_t n ) 
+      {
+        if ( !n ) { return ; }
+        long double sumw , sumw2 , mu , M [ 2 ] ;
+        detail::moment_block<1> ( x , w , n , sumw , sumw2 , mu , M ) ;
+        *this += WMoment_ ( n , sumw , sumw2 , mu ) ;
+      }
+      // ======================================================================
     private:
       // ======================================================================
       WMoment_<0>  m_prev { } ;
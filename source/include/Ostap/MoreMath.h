@@ -54,6 +54,18 @@ namespace Ostap
      */        
     double exprel ( const double x ) ;
     // ========================================================================
+    /** compute \f$ f(x) = \frac{e^x-1}{x}\f$ for the array of points 
+     *  (relative precision is better than \f$ 10^{-15}\f$)
+     *  @param n      (INPUT)  number of points 
+     *  @param x      (INPUT)  array of arguments 
+     *  @param result (UPDATE) array of results 
+     *  @see Ostap::Math::exprel
+     */
+    void exprel 
+    ( const std::size_t n      , 
+      const double*     x      , 
+      double*           result ) ;
+    // ========================================================================
     /** regularized incomplete gamma function 
      *  \f[ \gamma^{\ast}(a,x) = \frac{x^{-a}}{\Gamma(a)} \gamma(a,x) \f], 
      *  where \f[\gamma(a,x) = \int_0^x e^{-t}t^{a-1}dt\f], 
@@ -142,6 +154,19 @@ namespace Ostap
      */
     double  erfcx ( const double x ) ;
     // ========================================================================
+    /** scaled complementary error function for the array of points 
+     *  \f[ 1 -  \mathrm{erf} (x) = e^{-x^2} \mathrm{erfcx}(x)  \f]
+     *  (relative precision is better than \f$ 10^{-13}\f$)
+     *  @param n      (INPUT)  number of points 
+     *  @param x      (INPUT)  array of arguments 
+     *  @param result (UPDATE) array of results 
+     *  @see Ostap::Math::erfcx 
+     */
+    void    erfcx 
+    ( const std::size_t n      , 
+      const double*     x      , 
+      double*           result ) ;
+    // ========================================================================
     /** complementary error function
      *  @see std::erfc 
      */
@@ -214,6 +239,24 @@ namespace Ostap
      */
     std::complex<double> faddeeva_w ( const std::complex<double>& x ) ;
     // ========================================================================
+    /** compute Faddeeva "w" function for the array of arguments 
+     *  w(z) = exp(-z^2) erfc(-iz) [ Faddeeva / scaled complex error func ]
+     *  - in the central region \f$ 0.5 \le \Im z \le 7, \left| \Re z \right| \le 6 \f$
+     *    the rational approximation by J.A.C.Weideman is used 
+     *    (relative precision is better than \f$ 10^{-12}\f$)
+     *  - elsewhere the scalar function is used 
+     *  @see J.A.C. Weideman, "Computation of the Complex Error Function", 
+     *       SIAM Journal on Numerical Analysis, 31 (1994) 1497
+     *  @see https://doi.org/10.1137/0731077
+     *  @param n      (INPUT)  number of points 
+     *  @param z      (INPUT)  array of arguments 
+     *  @param result (UPDATE) array of results 
+     */
+    void faddeeva_w 
+    ( const std::size_t           n      , 
+      const std::complex<double>* z      , 
+      std::complex<double>*       result ) ;
+    // ========================================================================
     /** Dowson function 
      *  \f[ f(x) =  \frac{\sqrt{\pi}}{2}  *  e^{-z^2} * erfi(z) \f] 
      *  @return the value of Dawson function 
@@ -252,12 +295,37 @@ namespace Ostap
      */
     double igamma ( const double x ) ;    
     // ========================================================================
+    /** Compute inverse Gamma function for the array of points 
+     *  \f[ f(x) = \frac{1}{\Gamma(x)} \f]
+     *  (relative precision is better than \f$ 10^{-15}\f$)
+     *  @param n      (INPUT)  number of points 
+     *  @param x      (INPUT)  array of arguments 
+     *  @param result (UPDATE) array of results 
+     */
+    void igamma 
+    ( const std::size_t n      , 
+      const double*     x      , 
+      double*           result ) ;
+    // ========================================================================
     /** Compute psi function 
      *  \f[ f(x) = \frac{d}{dx}\ln \Gamma(x)\f]
      *  @return the value of psi function 
      */
     double psi ( const double x ) ;    
     // ========================================================================
+    /** Compute psi function for the array of points 
+     *  \f[ f(x) = \frac{d}{dx}\ln \Gamma(x)\f]
+     *  (the precision is better than \f$ 10^{-15}\f$, absolute for 
+     *  \f$ \left|\psi(x)\right| < 1\f$ and relative otherwise)
+     *  @param n      (INPUT)  number of points 
+     *  @param x      (INPUT)  array of arguments 
+     *  @param result (UPDATE) array of results 
+     */
+    void psi 
+    ( const std::size_t n      , 
+      const double*     x      , 
+      double*           result ) ;
+    // ========================================================================
     /** Pochhammer symbol, aka "rising factorial"
      *  \f[ P(x,n) = x ( x + 1) ( x + 1 ) ... ( x + n - 1 ) = \Pi^{k-1}_{k=0} (x + k) \f] 
      *  @see https://en.wikipedia.org/wiki/Falling_and_rising_factorials
@@ -304,6 +372,23 @@ namespace Ostap
       const double mu    = 0 ,
       const double sigma = 1 ) ;
     // ========================================================================
+    /** get the gaussian pdf for the array of points 
+     *  - the exponent is computed with the vectorizable kernel 
+     *    (relative precision is better than \f$ 3\cdot10^{-16}\f$, 
+     *    values below \f$ e^{-708}\f$ are flushed to zero)
+     *  @param n      (INPUT)  number of points 
+     *  @param x      (INPUT)  array of arguments 
+     *  @param result (UPDATE) array of results 
+     *  @param mu     (INPUT)  mu (location)
+     *  @param sigma  (INPUT)  sigma (width)  
+     */
+    void gauss_pdf
+    ( const std::size_t n         ,
+      const double*     x         ,
+      double*           result    , 
+      const double      mu    = 0 ,
+      const double      sigma = 1 ) ;
+    // ========================================================================
     /** get the standard gaussian cdf 
      *  @see https://en.wikipedia.org/wiki/Normal_distribution
      *  \f$ f(x) = \frac{1}{2} \left( 1 + erf ( \frac{x} { \sqrt{2} } ) \right) \f$ 
@@ -317,6 +402,22 @@ namespace Ostap
       const double mu    = 0 ,
       const double sigma = 1 ) ;
     // ========================================================================
+    /** get the gaussian cdf for the array of points 
+     *  (relative precision is better than \f$ 10^{-15}\f$, 
+     *  also in the left tail) 
+     *  @param n      (INPUT)  number of points 
+     *  @param x      (INPUT)  array of arguments 
+     *  @param result (UPDATE) array of results 
+     *  @param mu     (INPUT)  mu (location)
+     *  @param sigma  (INPUT)  sigma (width)  
+     */
+    void gauss_cdf 
+    ( const std::size_t n         ,
+      const double*     x         ,
+      double*           result    , 
+      const double      mu    = 0 ,
+      const double      sigma = 1 ) ;
+    // ========================================================================
     /** get the Gaussian integral 
      *  @see https://en.wikipedia.org/wiki/Normal_distribution
      *  \f$ f(x) = \frac{1}{2} \left( 1 + erf ( \frac{x} { \sqrt{2} } ) \right) \f$ 
@@ -333,6 +434,22 @@ namespace Ostap
       const double mu    = 0 ,
       const double sigma = 1 ) ;
     // ========================================================================
+    /** get the Gaussian integrals for the arrays of integration limits 
+     *  @param n      (INPUT)  number of intervals 
+     *  @param a      (INPUT)  array of low  integration limits 
+     *  @param b      (INPUT)  array of high integration limits 
+     *  @param result (UPDATE) array of results 
+     *  @param mu     (INPUT)  location of Gaussian
+     *  @param sigma  (INPUT)  width of the Gaussian
+     */
+    void gauss_int
+    ( const std::size_t n         ,
+      const double*     a         ,
+      const double*     b         ,
+      double*           result    , 
+      const double      mu    = 0 ,
+      const double      sigma = 1 ) ;
+    // ========================================================================
     /** Student's t-CDF 
      *  \f[ f(t;\nu) = \left\{
      *  \begin{array}{ll}
@@ -360,6 +477,19 @@ namespace Ostap
      */
     double owen  ( const double h , const double a ) ;
     // ========================================================================
+    /** compute Owen's T-function for the array of h-values 
+     *  \f$ f(h,a) = \frac{1}{2\pi}\int_0^a \frac{ e^{ -\frac{1}{2} h^2(1+x^2)}}{1+x^2}dx \f$ 
+     *  @param n      (INPUT)  number of points 
+     *  @param h      (INPUT)  array of h-parameters 
+     *  @param result (UPDATE) array of results 
+     *  @param a      (INPUT)  a-parameter
+     */
+    void   owen  
+    ( const std::size_t n      , 
+      const double*     h      , 
+      double*           result , 
+      const double      a      ) ;
+    // ========================================================================
     /** get the gaussian integral
      *  \f[ f = \int_a^b \exp { -\alpha^2 x^2 + \beta x } \mathrm{d}x \f]
      *  @param alpha the alpha parameter
@@ -6,7 +6,12 @@
 // ============================================================================
 // STD&STL
 // ============================================================================
+#include <array>
 #include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 // ============================================================================
 // ROOT/RooFit 
 // ============================================================================
@@ -15,6 +20,7 @@
 #include "RooProduct.h"
 #include "RooRealConstant.h"
 #include "RooRealProxy.h"
+#include "RooListProxy.h"
 #include "RooAbsPdf.h"
 #include "RooGlobalFunc.h"
 // ============================================================================
@@ -1931,6 +1937,154 @@ namespace Ostap
       // ======================================================================
     } ;
     // ========================================================================    
+    /** @class AddPdf
+     *  Sum of PDFs with caching of the normalized component values 
+     *  \f$ f(x) = \sum_k c_k f_k(x) \f$ 
+     *  - extended case: \f$ c_k = N_k / \sum_j N_j \f$ 
+     *  - non-extended case: \f$ c_k \f$ are (optionally recursive) fractions 
+     *  
+     *  The normalized values of each component are cached per event 
+     *  (keyed by the values of observables), and the cache of the component 
+     *  is invalidated only when the parameters of this component are changed.
+     *  Therefore only the changed components are recalculated, and 
+     *  for modified yields/fractions no components are evaluated at all.
+     *  @attention caching is applied for up to four real observables
+     *  @see RooAddPdf 
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru 
+     *  @date 2023-03-18
+     */
+    class AddPdf : public RooAbsPdf
+    {
+      // ========================================================================
+      ClassDefOverride(Ostap::MoreRooFit::AddPdf , 1 ) ;  // sum of PDFs with cached components
+      // ========================================================================
+    public:
+      // ======================================================================== 
+      /** constructor from name, title, pdfs and coefficients
+       *  @param name      name 
+       *  @param title     name 
+       *  @param pdfs      the components 
+       *  @param coefs     the yields (extended) or fractions (non-extended)
+       *  @param recursive use recursive fractions (non-extended)
+       */
+      AddPdf ( const char*       name              , 
+               const char*       title             , 
+               const RooArgList& pdfs              , 
+               const RooArgList& coefs             , 
+               const bool        recursive = false ) ;
+      /// copy constructor 
+      AddPdf ( const AddPdf&     right    , 
+               const char*       name = 0 ) ;
+      /// default constructor, needed for serialization 
+      AddPdf () = default ;
+      /// destructor 
+      virtual ~AddPdf() ;
+      /// clone 
+      AddPdf* clone ( const char* newname ) const override ;
+      // ========================================================================
+    public:
+      // ========================================================================
+      /// the components are normalized 
+      Bool_t     selfNormalized () const override { return true ; }
+      /// extended PDF ? 
+      ExtendMode extendMode     () const override ;
+      /// expected number of events 
+      Double_t   expectedEvents ( const RooArgSet* nset ) const override ;
+      // ========================================================================
+    public:
+      // ========================================================================
+      /// integrals are delegated to the components 
+      Bool_t   forceAnalyticalInt ( const RooAbsArg& /* dep */ ) const override { return true ; }
+      /// integrals are delegated to the components 
+      Int_t    getAnalyticalIntegralWN 
+      ( RooArgSet&       allVars       , 
+        RooArgSet&       analVars      , 
+        const RooArgSet* normSet       ,
+        const char*      rangeName = 0 ) const override ;
+      /// integrals are delegated to the components 
+      Double_t analyticalIntegralWN 
+      ( Int_t            code          , 
+        const RooArgSet* normSet       , 
+        const char*      rangeName = 0 ) const override ;
+      // ========================================================================
+    public:
+      // ========================================================================
+      /// the components 
+      const RooArgList& pdfList   () const { return m_pdfs  ; }
+      /// the yields/fractions 
+      const RooArgList& coefList  () const { return m_coefs ; }
+      /// extended PDF? 
+      bool              extended  () const { return m_pdfs.getSize () == m_coefs.getSize () ; }
+      /// recursive fractions ?
+      bool              recursive () const { return m_recursive ; }
+      /// number of actual evaluations of components (for monitoring)
+      unsigned long     evaluations () const { return m_evaluations ; }
+      /// clear the cache 
+      void              clearCache  () const ;
+      // ========================================================================
+    public:
+      // ========================================================================
+      /// the maximal number of cached entries per component 
+      static std::size_t maxCache    () ;
+      /// set the maximal number of cached entries per component 
+      static void        setMaxCache ( const std::size_t value ) ;
+      // ========================================================================
+    protected:
+      // ========================================================================
+      /// the main method 
+      Double_t evaluate () const override ;
+      // ========================================================================
+    private:
+      // ========================================================================
+      /// calculate the coefficients 
+      void coefficients_ () const ;
+      /// synchronize the cache with the normalization set 
+      void sync_         ( const RooArgSet* nset ) const ;
+      /// the parameters of the component are changed?
+      bool changed_      ( const unsigned int component ) const ;
+      // ========================================================================
+    private:
+      // ========================================================================
+      /// the components 
+      RooListProxy m_pdfs      {} ; // the components 
+      /// the yields/fractions
+      RooListProxy m_coefs     {} ; // the yields/fractions
+      /// recursive fractions?
+      bool         m_recursive { false } ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the cache key: the values of observables 
+      typedef std::array<double,4> Key ;
+      /// hash for the cache key 
+      struct KeyHash { std::size_t operator() ( const Key& key ) const ; } ;
+      typedef std::unordered_map<Key,double,KeyHash> Cache ;
+      // ======================================================================
+      /// the caches of the component values 
+      mutable std::vector<Cache>                       m_cache        {} ; //!
+      /// the parameters of the components 
+      mutable std::vector<std::unique_ptr<RooArgSet> > m_parameters   {} ; //!
+      /// the snapshots of parameters of components 
+      mutable std::vector<std::vector<double> >        m_snapshots    {} ; //!
+      /// the observables 
+      mutable std::vector<const RooAbsReal*>           m_observables  {} ; //!
+      /// the normalization set for the cache 
+      mutable const RooArgSet*                         m_nset         { nullptr } ; //!
+      /// is the cache synchronized with the normalization set? 
+      mutable bool                                     m_synced       { false   } ; //!
+      /// caching is possible? 
+      mutable bool                                     m_cacheable    { false   } ; //!
+      /// the coefficients 
+      mutable std::vector<double>                      m_coefficients {} ; //!
+      /// the integrals of components: index is the integration code 
+      mutable std::vector<std::vector<std::unique_ptr<RooAbsReal> > > m_integrals {} ; //!
+      /// the keys for the integrals 
+      mutable std::vector<std::string>                 m_keys         {} ; //!
+      /// number of evaluations of components 
+      mutable unsigned long                            m_evaluations  { 0 } ; //!
+      // ======================================================================
+    } ;
+    // ========================================================================    
   } //                                   The end of namespace Ostap::MoreRooFit  
   // ==========================================================================
 } //                                                 The end of namespace Ostap
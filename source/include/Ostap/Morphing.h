@@ -0,0 +1,200 @@
+// ============================================================================
+#ifndef OSTAP_MORPHING_H
+#define OSTAP_MORPHING_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+#include <algorithm>
+// ============================================================================
+/** @file Ostap/Morphing.h
+ *  Fast template morphing with the precomputed cumulative distributions
+ *  and the quantile functions of the templates
+ *  @see Ostap::Math::Morphing
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class Morphing Ostap/Morphing.h
+     *  Fast 1D or 2D morphing between the templates (1D densities),
+     *  defined at the nodes of the rectangular grid of morphing parameters.
+     *  The templates are the (non-negative) bin contents for the
+     *  uniform binning of \f$ [x_{min},x_{max}]\f$.
+     *
+     *  The cumulative distributions and the quantile functions
+     *  of all templates are calculated once, in constructor.
+     *  For the given morphing parameter(s) the (bi)linear weights
+     *  \f$ w_i \f$ of the neighbouring templates are used:
+     *  - <code>Vertical</code>: \f$ F(x) = \sum_i w_i F_i(x) \f$
+     *  - <code>Horizontal</code>: \f$ Q(p) = \sum_i w_i Q_i(p) \f$
+     *    (the quantile/"Read" interpolation, shapes are shifted and stretched)
+     *
+     *  The morphed distribution is calculated only when the morphing
+     *  parameters are changed, the evaluation is the array lookup and
+     *  the density is normalized by construction:
+     *  \f$ \int_{x_{min}}^{x_{max}} f(x) dx = 1 \f$
+     *
+     *  @see A.L. Read, "Linear interpolation of histograms",
+     *       Nucl.Instrum.Meth. A425 (1999) 357-360
+     *  @see https://doi.org/10.1016/S0168-9002(98)01347-3
+     *  @see RooMomentMorph
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class Morphing
+    {
+    public:
+      // ======================================================================
+      /// morphing mode
+      enum Mode
+        {
+          Vertical   = 0 , // interpolate the cumulative distributions
+          Horizontal = 1   // interpolate the quantile functions
+        } ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** constructor for 1D morphing
+       *  @param mu        the values of morphing parameter (increasing)
+       *  @param templates the templates: bin contents for each value of mu
+       *  @param xmin      low  edge of the templates
+       *  @param xmax      high edge of the templates
+       *  @param mode      morphing mode
+       */
+      Morphing
+      ( const std::vector<double>&               mu                     ,
+        const std::vector<std::vector<double> >& templates              ,
+        const double                             xmin                   ,
+        const double                             xmax                   ,
+        const Mode                               mode      = Horizontal ) ;
+      // ======================================================================
+      /** constructor for 2D morphing
+       *  @param mu1       the values of the first  morphing parameter (increasing)
+       *  @param mu2       the values of the second morphing parameter (increasing)
+       *  @param templates the templates: <code>templates[i1*N2+i2]</code>
+       *  @param xmin      low  edge of the templates
+       *  @param xmax      high edge of the templates
+       *  @param mode      morphing mode
+       */
+      Morphing
+      ( const std::vector<double>&               mu1                    ,
+        const std::vector<double>&               mu2                    ,
+        const std::vector<std::vector<double> >& templates              ,
+        const double                             xmin                   ,
+        const double                             xmax                   ,
+        const Mode                               mode      = Horizontal ) ;
+      /// default constructor
+      Morphing () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// evaluate the morphed density
+      double operator() ( const double x ) const { return pdf ( x ) ; }
+      /// evaluate the morphed density
+      double pdf        ( const double x ) const ;
+      /// evaluate the morphed cumulative distribution
+      double cdf        ( const double x ) const ;
+      /** evaluate the morphed density for the array of points
+       *  @param n      (INPUT)  number of points
+       *  @param x      (INPUT)  the points
+       *  @param result (OUTPUT) the values
+       */
+      void   evaluate
+      ( const std::size_t n      ,
+        const double*     x      ,
+        double*           result ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// get the integral (it is one by construction)
+      double integral () const { return 1 ; }
+      /// get the integral between low and high
+      double integral ( const double low  ,
+                        const double high ) const
+      { return cdf ( high ) - cdf ( low ) ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** set the morphing parameters
+       *  @return true if the morphed distribution is recalculated
+       */
+      bool setMu  ( const double mu1 , const double mu2 = 0 ) ;
+      /// set the first morphing parameter
+      bool setMu1 ( const double value ) { return setMu ( value , m_cmu2 ) ; }
+      /// set the second morphing parameter
+      bool setMu2 ( const double value ) { return setMu ( m_cmu1 , value ) ; }
+      // ======================================================================
+      /// the first morphing parameter
+      double mu1 () const { return m_cmu1 ; }
+      /// the second morphing parameter
+      double mu2 () const { return m_cmu2 ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      double       xmin       () const { return m_xmin  ; }
+      double       xmax       () const { return m_xmax  ; }
+      unsigned int nbins      () const { return m_nbins ; }
+      Mode         mode       () const { return m_mode  ; }
+      /// number of templates
+      std::size_t  ntemplates () const { return m_mu1.size () * std::max<std::size_t> ( 1 , m_mu2.size () ) ; }
+      /// the grid of morphing parameters
+      const std::vector<double>& mus1 () const { return m_mu1 ; }
+      const std::vector<double>& mus2 () const { return m_mu2 ; }
+      /// number of recalculations of the morphed distribution
+      unsigned long nMorph () const { return m_nmorph ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// prepare the cumulative distributions and the quantiles
+      void setup ( const std::vector<std::vector<double> >& templates ) ;
+      /// recalculate the morphed distribution
+      void morph () ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the grid of the first morphing parameter
+      std::vector<double> m_mu1       {} ;
+      /// the grid of the second morphing parameter (empty for 1D)
+      std::vector<double> m_mu2       {} ;
+      /// the range
+      double              m_xmin      { 0 } ;
+      double              m_xmax      { 1 } ;
+      /// number of bins
+      unsigned int        m_nbins     { 0 } ;
+      /// number of quantile nodes
+      unsigned int        m_nq        { 0 } ;
+      /// the mode
+      Mode                m_mode      { Horizontal } ;
+      /// the cumulative distributions of templates at bin edges
+      std::vector<double> m_cdfs      {} ;
+      /// the quantile functions of templates
+      std::vector<double> m_quantiles {} ;
+      // ======================================================================
+      /// current values of morphing parameters
+      double              m_cmu1      { 0 } ;
+      double              m_cmu2      { 0 } ;
+      /// the morphed cumulative distribution at bin edges
+      std::vector<double> m_cdf       {} ;
+      /// the morphed density
+      std::vector<double> m_density   {} ;
+      /// number of recalculations
+      unsigned long       m_nmorph    { 0 } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_MORPHING_H
+// ============================================================================
@@ -17,6 +17,10 @@ namespace Ostap
     // ========================================================================
     /** @class Mute Ostap/Mute.h
      *  Helper utility to mute output (or redirect it to the file)
+     *  - the default (muting) constructor uses the shared null stream buffer 
+     *    and does not open any files 
+     *  - the process-level muted state (e.g. for the workers) redirects 
+     *    the streams once, and the subsequent muting objects do nothing 
      *  @see Ostap::Utils::Tee
      *  @author Vanya Belyaev
      *  @date   2013-02-19
@@ -49,6 +53,20 @@ namespace Ostap
       /// helper         function to implement __exit__   
       void exit  () ;
       // ======================================================================
+    public: // process-level muted state 
+      // ======================================================================
+      /** set the process-level muted state: 
+       *  <code>std::cout</code> and/or <code>std::cerr</code> are redirected 
+       *  to the null stream buffer once, the subsequent muting objects 
+       *  for these streams do nothing 
+       *  @param out (INPUT) mute <code>std::cout</code>?
+       *  @param err (INPUT) mute <code>std::cerr</code>?
+       */
+      static void setSilent ( const bool out = true  , 
+                              const bool err = false ) ;
+      /// is the stream (<code>std::cout</code> or <code>std::cerr</code>) muted at the process level?
+      static bool silent    ( const bool out = true  ) ;
+      // ======================================================================
     private: 
       // ======================================================================
       bool            m_cout   ;
@@ -205,6 +205,18 @@ namespace Ostap
       std::vector<double> m_sin_phi ; // vector of sin(phi)
       /// vector of cos(phi)
       std::vector<double> m_cos_phi ; // vector of cos(phi)
+      /// partial products of sin(phi): \f$ \prod_{j<i} \sin \phi_j \f$
+      std::vector<long double> m_prod ; // partial products of sin(phi)
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// update the partial products of sines, starting from the given phase 
+      void update_products ( const unsigned short index = 0 ) ;
+      /** assign the phase and its sin/cos without the update of products 
+       *  @return true if the phase is actually changed 
+       */
+      bool assign_phase    ( const unsigned short index , 
+                             const double         value ) ;
       // ======================================================================
     };
     // ========================================================================
@@ -228,8 +240,7 @@ inline double Ostap::Math::NSphere::x
   //
   const bool last = ( index + 1u == nx ) ;
   //
-  long double xi = 1.0 ;
-  for ( unsigned short j = 0 ; j < index ; ++j ) { xi *= m_sin_phi[j] ; }
+  const long double xi = m_prod [ index ] ;
   //
   return last ? xi : xi * m_cos_phi [ index ] ;
 }
@@ -242,11 +253,16 @@ template <class ITERATOR>
 inline bool Ostap::Math::NSphere::setPars ( ITERATOR begin  , 
                                             ITERATOR end    ) 
 {
-  bool update = false ;
-  const unsigned int   N = nPhi ()  ;
-  for ( unsigned short k ; k < N && begin != end ; ++k, ++begin ) 
-  { update = setPar ( k , *begin ) || update ; }
-  return update ;
+  const unsigned short N     = nPhi ()  ;
+  unsigned short       first = N ;
+  for ( unsigned short k = 0 ; k < N && begin != end ; ++k, ++begin ) 
+  { if ( assign_phase ( k , *begin ) && k < first ) { first = k ; } }
+  //
+  // sines and cosines are recalculated only for the changed phases, 
+  // the products are recalculated once 
+  if ( first < N ) { update_products ( first ) ; }
+  //
+  return first < N ;
 }
 // ============================================================================
 //                                                                      The END 
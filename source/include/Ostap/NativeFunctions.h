@@ -0,0 +1,185 @@
+// ============================================================================
+#ifndef OSTAP_NATIVEFUNCTIONS_H
+#define OSTAP_NATIVEFUNCTIONS_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Functions
+  {
+    // ========================================================================
+    /** @class NativeFunction1 Ostap/NativeFunctions.h
+     *  Simple C++ wrapper for the raw pointer to the compiled function
+     *  with signature <code>double(double)</code>, e.g.
+     *  <code>numba.cfunc</code>, <code>ctypes</code> or <code>cffi</code>
+     *  function pointers. The function is called directly, without
+     *  Python C-API and without GIL, therefore it can be used for the
+     *  (multithreaded) integration, filling of branches, etc.
+     *
+     *  @code
+     *  @numba.cfunc ( "float64(float64)" )
+     *  def fun ( x ) : return x * x
+     *  f = Ostap.Functions.NativeFunction1 ( fun.address )
+     *  @endcode
+     *  @attention the function must be pure and thread-safe,
+     *             and the owner of the code must be kept alive
+     *  @see ostap.math.native
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2026-10-15
+     */
+    class NativeFunction1
+    {
+    public:
+      // ======================================================================
+      /// the raw function type
+      typedef double (*raw_function) ( double ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// constructor from the address of the function
+      NativeFunction1 ( const std::uintptr_t address ) ;
+      /// constructor from the function pointer
+      NativeFunction1 ( raw_function         fun     ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the main method
+      inline double operator () ( const double x ) const { return m_fun ( x ) ; }
+      /// the main method
+      inline double evaluate    ( const double x ) const { return m_fun ( x ) ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the address of the function
+      std::uintptr_t address () const
+      { return reinterpret_cast<std::uintptr_t> ( m_fun ) ; }
+      /// the unique tag (for the integration caches)
+      std::size_t    tag     () const ;
+      /// the function as <code>std::function</code>
+      std::function<double(double)> function () const { return m_fun ; }
+      /// the raw function pointer
+      raw_function   raw     () const { return m_fun ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the function
+      raw_function m_fun { nullptr } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class NativeFunction2 Ostap/NativeFunctions.h
+     *  Simple C++ wrapper for the raw pointer to the compiled function
+     *  with signature <code>double(double,double)</code>
+     *  @see Ostap::Functions::NativeFunction1
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2026-10-15
+     */
+    class NativeFunction2
+    {
+    public:
+      // ======================================================================
+      /// the raw function type
+      typedef double (*raw_function) ( double , double ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// constructor from the address of the function
+      NativeFunction2 ( const std::uintptr_t address ) ;
+      /// constructor from the function pointer
+      NativeFunction2 ( raw_function         fun     ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the main method
+      inline double operator ()
+      ( const double x , const double y ) const { return m_fun ( x , y ) ; }
+      /// the main method
+      inline double evaluate
+      ( const double x , const double y ) const { return m_fun ( x , y ) ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the address of the function
+      std::uintptr_t address () const
+      { return reinterpret_cast<std::uintptr_t> ( m_fun ) ; }
+      /// the unique tag (for the integration caches)
+      std::size_t    tag     () const ;
+      /// the function as <code>std::function</code>
+      std::function<double(double,double)> function () const { return m_fun ; }
+      /// the raw function pointer
+      raw_function   raw     () const { return m_fun ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the function
+      raw_function m_fun { nullptr } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class NativeFunction3 Ostap/NativeFunctions.h
+     *  Simple C++ wrapper for the raw pointer to the compiled function
+     *  with signature <code>double(double,double,double)</code>
+     *  @see Ostap::Functions::NativeFunction1
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2026-10-15
+     */
+    class NativeFunction3
+    {
+    public:
+      // ======================================================================
+      /// the raw function type
+      typedef double (*raw_function) ( double , double , double ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// constructor from the address of the function
+      NativeFunction3 ( const std::uintptr_t address ) ;
+      /// constructor from the function pointer
+      NativeFunction3 ( raw_function         fun     ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the main method
+      inline double operator ()
+      ( const double x , const double y , const double z ) const
+      { return m_fun ( x , y , z ) ; }
+      /// the main method
+      inline double evaluate
+      ( const double x , const double y , const double z ) const
+      { return m_fun ( x , y , z ) ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the address of the function
+      std::uintptr_t address () const
+      { return reinterpret_cast<std::uintptr_t> ( m_fun ) ; }
+      /// the unique tag (for the integration caches)
+      std::size_t    tag     () const ;
+      /// the function as <code>std::function</code>
+      std::function<double(double,double,double)> function () const { return m_fun ; }
+      /// the raw function pointer
+      raw_function   raw     () const { return m_fun ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the function
+      raw_function m_fun { nullptr } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                     The end of namespace Ostap::Functions
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_NATIVEFUNCTIONS_H
+// ============================================================================
@@ -11,6 +11,10 @@
 // ============================================================================
 #include "TObject.h"
 // ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/TreeCache.h"
+// ============================================================================
 // Forward declarationns
 // ============================================================================
 class TTree ;
@@ -23,6 +27,8 @@ namespace  Ostap
     // ========================================================================
     /** @class Notifier Ostap/Notifier.h
      *  Local helper class to keep the proper notifications for TTree
+     *  - <code>TTreeCache</code> is configured for the branches,
+     *    used by the formulas, see Ostap::Utils::TreeCache 
      *  @date 2013-10-13 
      *  @author Vanya BELYAEV Ivan.Brlyaev@itep.ru
      */
@@ -62,6 +68,15 @@ namespace  Ostap
       /// the main method 
       Bool_t  Notify () override ;
       // ======================================================================
+    public:
+      // ======================================================================
+      /// total number of (top-level) notifications 
+      static unsigned long long notifications  () ;
+      /// total time (in seconds) spent in (top-level) notifications 
+      static double             notify_time    () ;
+      /// reset the notification counters 
+      static void               reset_counters () ;
+      // ======================================================================
     public:
       // ======================================================================
       // add object to the notification list 
@@ -80,6 +95,13 @@ namespace  Ostap
       /// is this object known for notifier ? 
       bool known ( const TObject* obj ) const ;
       // ======================================================================
+      /** (re)configure <code>TTreeCache</code> for the branches, 
+       *  used by the formulas, e.g. after the formulas are added 
+       *  @see Ostap::Utils::TreeCache 
+       *  @return true if the cache is configured 
+       */
+      bool cache () ;
+      // ======================================================================
       // exit from  notification context 
       bool exit() ;
       // ======================================================================
@@ -98,6 +120,8 @@ namespace  Ostap
       TObject* m_old  ;                  //! old notifier  
       // list of fobject to be notified 
       std::vector<TObject*> m_objects ;  //! list of objects 
+      /// the cache for the tree 
+      std::unique_ptr<Ostap::Utils::TreeCache> m_cache {} ; //! the cache 
       // ========================================================================
     } ;
     // ========================================================================
@@ -110,6 +134,7 @@ namespace  Ostap
       , m_tree    ( tree    ) 
       , m_old     ( nullptr )
       , m_objects () 
+      , m_cache   () 
     {
       this -> _pre_action  () ;
       for ( ; begin != end ; ++begin ) { this->add ( *begin ) ; }
@@ -125,6 +150,7 @@ namespace  Ostap
       , m_tree    ( tree    ) 
       , m_old     ( nullptr )
       , m_objects () 
+      , m_cache   () 
     {
       this -> _pre_action  () ;
       for ( ; begin != end ; ++begin ) { this->add ( *begin ) ; }
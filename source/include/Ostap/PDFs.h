@@ -15,6 +15,9 @@
 #include "Ostap/Voigt.h"
 #include "Ostap/Models.h"
 #include "Ostap/BSpline.h"
+#include "Ostap/IntegrationCache.h"
+#include "Ostap/Morphing.h"
+#include "Ostap/BatchCompute.h"
 // ============================================================================
 // ROOT
 // ============================================================================
@@ -24,6 +27,10 @@
 #include "RooAbsReal.h"
 #include "RooAbsPdf.h"
 // ============================================================================
+// forward declarations 
+// ============================================================================
+class RooRealVar ; // RooFit
+// ============================================================================
 namespace Ostap
 {
   // ==========================================================================
@@ -624,6 +631,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -698,6 +708,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -1016,6 +1029,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -1217,6 +1233,8 @@ namespace Ostap
       // ======================================================================
       /// the actual function
       mutable Ostap::Math::Apollonios m_apo ;                // the function
+      /// the local cache of integrals 
+      mutable Ostap::Math::LocalIntegralCache m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -1264,6 +1282,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -1296,6 +1317,8 @@ namespace Ostap
       // ======================================================================
       /// the actual function
       mutable Ostap::Math::Apollonios2 m_apo2 ;                // the function
+      /// the local cache of integrals 
+      mutable Ostap::Math::LocalIntegralCache m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -1339,6 +1362,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -1645,6 +1671,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -1678,6 +1707,8 @@ namespace Ostap
       // ======================================================================
       /// the actual function
       mutable Ostap::Math::Bukin m_bukin ;                      // the function
+      /// the local cache of integrals 
+      mutable Ostap::Math::LocalIntegralCache m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -1726,6 +1757,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -2364,6 +2398,9 @@ namespace Ostap
       // ======================================================================
       Double_t evaluate () const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -2646,6 +2683,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -3098,6 +3138,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -3259,6 +3302,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -3341,6 +3387,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -3418,6 +3467,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:
       // ======================================================================
       /// set all parameters
@@ -3650,6 +3702,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -3727,6 +3782,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -3803,6 +3861,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -3991,6 +4052,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -4100,6 +4164,8 @@ namespace Ostap
       // ======================================================================
       /// the actual function
       mutable Ostap::Math::Atlas m_atlas ; // the actual function
+      /// the local cache of integrals 
+      mutable Ostap::Math::LocalIntegralCache m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -4277,6 +4343,8 @@ namespace Ostap
       // ======================================================================
       /// the actual function
       mutable Ostap::Math::Losev m_losev ; // the actual function
+      /// the local cache of integrals 
+      mutable Ostap::Math::LocalIntegralCache m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -4400,6 +4468,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -4634,6 +4705,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -4722,6 +4796,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -4800,6 +4877,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public: // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -4968,6 +5048,9 @@ namespace Ostap
       // =====================================================================
       // the actual evaluation of function 
       Double_t evaluate() const override ;
+      // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
       // =====================================================================
     public:
       // ======================================================================
@@ -5044,6 +5127,9 @@ namespace Ostap
       // =====================================================================
       // the actual evaluation of function 
       Double_t evaluate() const override ;
+      // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
       // =====================================================================
     public:
       // ======================================================================
@@ -5215,6 +5301,8 @@ namespace Ostap
     protected : // the function itself 
       // =====================================================================
       mutable Ostap::Math::QGaussian m_qgauss ;
+      /// the local cache of integrals 
+      mutable Ostap::Math::LocalIntegralCache m_icache ; //!
       // =====================================================================
     } ;
     // ========================================================================
@@ -5353,6 +5441,8 @@ namespace Ostap
     protected : // the function itself 
       // =====================================================================
       mutable Ostap::Math::Hyperbolic m_hyperbolic ;
+      /// the local cache of integrals 
+      mutable Ostap::Math::LocalIntegralCache m_icache ; //!
       // =====================================================================
     } ;
     // ========================================================================
@@ -5481,6 +5571,8 @@ namespace Ostap
     protected : // the function itself 
       // =====================================================================
       mutable Ostap::Math::GenHyperbolic m_hyperbolic ;
+      /// the local cache of integrals 
+      mutable Ostap::Math::LocalIntegralCache m_icache ; //!
       // =====================================================================
     } ;
     // ========================================================================
@@ -5969,6 +6061,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -6054,6 +6149,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -6089,6 +6187,108 @@ namespace Ostap
       // ======================================================================
     };
     // ========================================================================
+    /** @class Morphing
+     *  Fast 1D or 2D morphing between the templates
+     *  with precomputed cumulative distributions and quantile functions
+     *  - the morphed shape is recalculated only when the morphing parameters change
+     *  - the evaluation is the array lookup, the normalization is trivial
+     *  @see Ostap::Math::Morphing
+     *  @see RooMomentMorph
+     *  @see RooMomentMorphND
+     *  @author Vanya BELYAEV  Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class Morphing : public RooAbsPdf
+    {
+      // ======================================================================
+    public :
+      // ======================================================================
+      ClassDefOverride(Ostap::Models::Morphing, 1) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// constructor for 1D morphing
+      Morphing
+      ( const char*                  name     ,
+        const char*                  title    ,
+        RooAbsReal&                  x        ,
+        RooAbsReal&                  mu       ,
+        const Ostap::Math::Morphing& morphing ) ;
+      /// constructor for 2D morphing
+      Morphing
+      ( const char*                  name     ,
+        const char*                  title    ,
+        RooAbsReal&                  x        ,
+        RooAbsReal&                  mu1      ,
+        RooAbsReal&                  mu2      ,
+        const Ostap::Math::Morphing& morphing ) ;
+      /// copy
+      Morphing
+      ( const Morphing&              right    ,
+        const char*                  name = 0 ) ;
+      /// destructor
+      virtual ~Morphing() ;
+      /// clone
+      Morphing* clone ( const char* name ) const override;
+      // ======================================================================
+    public: // some fake functionality
+      // ======================================================================
+      // fake default contructor, needed just for proper (de)serialization
+      Morphing () {} ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      // the actual evaluation of function
+      Double_t evaluate() const override;
+      // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
+    public: // integrals
+      // ======================================================================
+      Int_t    getAnalyticalIntegral
+      ( RooArgSet&     allVars      ,
+        RooArgSet&     analVars     ,
+        const char* /* rangename */ ) const override;
+      Double_t analyticalIntegral
+      ( Int_t          code         ,
+        const char*    rangeName    ) const override;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// set all parameters
+      void setPars () const ; // set all parameters
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** sample the PDF at the bin centers of the uniform binning
+       *  of the observable range (e.g. to prepare the templates)
+       *  @param pdf   the PDF
+       *  @param x     the observable
+       *  @param nbins number of bins
+       */
+      static std::vector<double> sample
+      ( const RooAbsPdf&   pdf   ,
+        RooRealVar&        x     ,
+        const unsigned int nbins ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// access to underlying function
+      const Ostap::Math::Morphing& function () const { return m_morphing ; }
+      // ======================================================================
+    protected :
+      // ======================================================================
+      RooRealProxy m_x   ;
+      RooListProxy m_mus ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the actual function
+      mutable Ostap::Math::Morphing m_morphing ;             // the function
+      // ======================================================================
+    };
+    // ========================================================================
     /** @class Uniform
      *  The trivial model: flat/uniform dsitribution in 1,2,3-dimensions 
      */
@@ -10,11 +10,14 @@
 #include "Ostap/Bernstein2D.h"
 #include "Ostap/BSpline.h"
 #include "Ostap/Peaks.h"
+#include "Ostap/IntegrationCache.h"
+#include "Ostap/BatchCompute.h"
 // ============================================================================
 // ROOT
 // ============================================================================
 using std::size_t ;
 // ============================================================================
+#include "RVersion.h"
 #include "RooAbsPdf.h"
 #include "RooRealProxy.h"
 #include "RooListProxy.h"
@@ -73,6 +76,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -103,6 +109,8 @@ namespace Ostap
       // ======================================================================
       /// the actual function
       mutable Ostap::Math::Positive2D m_positive ;              // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache2D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -148,6 +156,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -178,6 +189,8 @@ namespace Ostap
       // ======================================================================
       /// the actual function
       mutable Ostap::Math::Positive2DSym m_positive ;           // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache2D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -242,6 +255,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -278,6 +294,8 @@ namespace Ostap
       // ======================================================================
       /// the actual functions()
       mutable Ostap::Math::PS2DPol m_function ;              // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache2D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -345,6 +363,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -381,6 +402,8 @@ namespace Ostap
       // ======================================================================
       /// the actual functions()
       mutable Ostap::Math::PS2DPolSym m_function ;              // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache2D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -446,6 +469,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -482,6 +508,8 @@ namespace Ostap
       // ======================================================================
       /// the actual functions()
       mutable Ostap::Math::PS2DPol2 m_function ;                // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache2D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -550,6 +578,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -586,6 +617,8 @@ namespace Ostap
       // ======================================================================
       /// the actual functions()
       mutable Ostap::Math::PS2DPol2Sym m_function ;             // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache2D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -651,6 +684,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -685,6 +721,8 @@ namespace Ostap
       // ======================================================================
       /// the actual functions()
       mutable Ostap::Math::PS2DPol3 m_function ;                // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache2D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -753,6 +791,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -787,6 +828,8 @@ namespace Ostap
       // ======================================================================
       /// the actual functions()
       mutable Ostap::Math::PS2DPol3Sym m_function ;             // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache2D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -846,6 +889,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -881,6 +927,8 @@ namespace Ostap
       // ======================================================================
       /// the actual functions()
       mutable Ostap::Math::ExpoPS2DPol m_function ;             // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache2D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -931,6 +979,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -965,6 +1016,8 @@ namespace Ostap
       // ======================================================================
       /// the actual functions()
       mutable Ostap::Math::Expo2DPol m_function ;               // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache2D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -1013,6 +1066,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -1046,6 +1102,8 @@ namespace Ostap
       // ======================================================================
       /// the actual functions()
       mutable Ostap::Math::Expo2DPolSym m_function ;           // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache2D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -1091,6 +1149,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -1167,6 +1228,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -7,11 +7,14 @@
 // Ostap
 // ============================================================================
 #include "Ostap/Bernstein3D.h"
+#include "Ostap/IntegrationCache.h"
+#include "Ostap/BatchCompute.h"
 // ============================================================================
 // ROOT
 // ============================================================================
 using std::size_t ;
 // ============================================================================
+#include "RVersion.h"
 #include "RooAbsPdf.h"
 #include "RooRealProxy.h"
 #include "RooListProxy.h"
@@ -75,6 +78,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
         public:  // integrals
@@ -108,6 +114,8 @@ namespace Ostap
       // ======================================================================
       /// the actual function
       mutable Ostap::Math::Positive3D m_positive ;              // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache3D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================   
@@ -161,6 +169,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -192,6 +203,8 @@ namespace Ostap
       // ======================================================================
       /// the actual function
       mutable Ostap::Math::Positive3DSym m_positive ;           // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache3D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -248,6 +261,9 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      /// the batch evaluation of function 
+      OSTAP_BATCH_DECLARE
+      // ======================================================================
     public:  // integrals
       // ======================================================================
       Int_t    getAnalyticalIntegral
@@ -279,6 +295,8 @@ namespace Ostap
       // ======================================================================
       /// the actual function
       mutable Ostap::Math::Positive3DMix m_positive ;           // the function
+      /// the integral cache 
+      mutable Ostap::Math::LocalIntegralCache3D m_icache ; //!
       // ======================================================================
     } ;
     // ========================================================================
@@ -0,0 +1,212 @@
+// ============================================================================
+#ifndef OSTAP_PARALLELNLL_H
+#define OSTAP_PARALLELNLL_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <memory>
+#include <string>
+#include <vector>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooAbsReal.h"
+#include "RooSetProxy.h"
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class RooAbsPdf  ; // RooFit
+class RooAbsData ; // RooFit
+namespace Ostap { namespace Utils { class CompactData ; } }
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace MoreRooFit
+  {
+    // ========================================================================
+    /** @class ParallelNLL Ostap/ParallelNLL.h
+     *  Thread-parallel (in-process) negative log-likelihood
+     *  - the data are split into partitions: the categories for
+     *    <code>RooSimultaneous</code>, and into chunks of events
+     *    within the large categories
+     *  - each thread has its own deep copy of PDF, therefore
+     *    the (mutable) internal state of Ostap::Models PDFs is never shared,
+     *    the parameters are synchronized with the parameters of
+     *    the original PDF for each evaluation
+     *  - the threads are persistent, there is no per-iteration cost of
+     *    process creation or interprocess communication
+     *  - the partial sums are combined using compensated (Kahan) summation
+     *    in the fixed order, the result does not depend on number of threads
+     *
+     *  \f$ -\log L = - \sum_c \sum_{i \in c} w_i \log f_c ( x_i ) +
+     *     \sum_c \left( \nu_c - W_c \log \nu_c \right) \f$,
+     *  where the last term is used for the extended likelihood
+     *
+     *  @attention for weighted data the uncertainties are not corrected
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-03-19
+     */
+    class ParallelNLL : public RooAbsReal
+    {
+      // ======================================================================
+      ClassDefOverride(Ostap::MoreRooFit::ParallelNLL , 1 ) ;  // parallel NLL
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param name       the name
+       *  @param title      the title
+       *  @param pdf        the PDF (e.g. <code>RooSimultaneous</code>)
+       *  @param data       the data
+       *  @param extended   use extended likelihood?
+       *  @param nthreads   the number of threads
+       *                    (0: the size of ROOT MT pool or hardware concurrency)
+       *  @param chunk_size the (minimal) number of events per task
+       */
+      ParallelNLL
+      ( const std::string&  name                ,
+        const std::string&  title               ,
+        const RooAbsPdf&    pdf                 ,
+        const RooAbsData&   data                ,
+        const bool          extended   = false  ,
+        const unsigned int  nthreads   = 0      ,
+        const unsigned long chunk_size = 20000  ) ;
+      // ======================================================================
+      /** constructor from the compact (single-precision) data
+       *  - the values are converted to double precision
+       *    for each chunk of events on the fly
+       *  - for <code>RooSimultaneous</code> the data must contain
+       *    the index category of the PDF
+       *  @param name       the name
+       *  @param title      the title
+       *  @param pdf        the PDF (e.g. <code>RooSimultaneous</code>)
+       *  @param data       the data (not owned, must outlive the object)
+       *  @param extended   use extended likelihood?
+       *  @param nthreads   the number of threads
+       *  @param chunk_size the (minimal) number of events per task
+       *  @see Ostap::Utils::CompactData
+       */
+      ParallelNLL
+      ( const std::string&               name                ,
+        const std::string&               title               ,
+        const RooAbsPdf&                 pdf                 ,
+        const Ostap::Utils::CompactData& data                ,
+        const bool                       extended   = false  ,
+        const unsigned int               nthreads   = 0      ,
+        const unsigned long              chunk_size = 20000  ) ;
+      /// copy
+      ParallelNLL ( const ParallelNLL& right       ,
+                    const char*        newname = 0 ) ;
+      /// default constructor, needed for serialization
+      ParallelNLL () ;
+      /// destructor
+      virtual ~ParallelNLL () ;
+      /// clone
+      ParallelNLL* clone ( const char* newname ) const override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// error level for the minimizer
+      Double_t defaultErrorLevel () const override { return 0.5 ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// extended likelihood?
+      bool          extended    () const { return m_extended ; }
+      /// number of threads
+      unsigned int  nThreads    () const { return m_nthreads ; }
+      /// number of partitions (categories)
+      unsigned int  nPartitions () const { return m_partitions.size () ; }
+      /// number of tasks
+      unsigned int  nTasks      () const { return m_tasks.size () ; }
+      /// the parameters
+      const RooArgSet& parameters () const { return m_parameters ; }
+      // ======================================================================
+    protected:
+      // ======================================================================
+      /// the actual evaluation of the result
+      Double_t evaluate () const override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the partition of data (category)
+      struct Partition
+      {
+        /// the name of PDF for this partition
+        std::string              pdf          {} ;
+        /// the names of observables
+        std::vector<std::string> observables  {} ;
+        /// the values of observables (event by event)
+        std::vector<double>      values       {} ;
+        /// the event weights
+        std::vector<double>      weights      {} ;
+        /// the columns of observables in the compact data
+        std::vector<std::size_t> columns      {} ;
+        /// the rows in the compact data (empty: all rows)
+        std::vector<std::size_t> rows         {} ;
+        /// the sum of weights
+        double                   sumw         { 0 } ;
+        /// number of events
+        std::size_t              entries      { 0 } ;
+        /// number of events
+        std::size_t size () const { return entries ; }
+      } ;
+      // ======================================================================
+      /// the task: the range of events in the partition
+      struct Task
+      {
+        unsigned int  partition { 0 } ;
+        unsigned long first     { 0 } ;
+        unsigned long last      { 0 } ;
+      } ;
+      // ======================================================================
+      class Replicas ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// split the data into partitions and tasks
+      void split_ ( const RooAbsData& data , const unsigned long chunk_size ) ;
+      /// split the compact data into partitions and tasks
+      void split_ ( const Ostap::Utils::CompactData& data , const unsigned long chunk_size ) ;
+      /// split the partitions into tasks
+      void tasks_ ( const unsigned long chunk_size ) ;
+      /// create the per-thread replicas of PDF
+      void replicate_ () const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the parameters
+      RooSetProxy              m_parameters {} ; // the parameters
+      /// extended likelihood?
+      bool                     m_extended   { false } ;
+      /// number of threads
+      unsigned int             m_nthreads   { 1 } ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the original PDF (not owned)
+      const RooAbsPdf*         m_pdf        { nullptr } ; //!
+      /// the compact data (not owned)
+      const Ostap::Utils::CompactData* m_compact { nullptr } ; //!
+      /// the partitions
+      std::vector<Partition>   m_partitions {} ; //!
+      /// the tasks
+      std::vector<Task>        m_tasks      {} ; //!
+      /// the per-thread replicas of PDF and the thread pool
+      mutable std::unique_ptr<Replicas> m_replicas {} ; //!
+      /// the results of tasks
+      mutable std::vector<double>       m_results  {} ; //!
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                   The end of namespace Ostap::MoreRooFit
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_PARALLELNLL_H
+// ============================================================================
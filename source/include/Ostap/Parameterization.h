@@ -6,6 +6,7 @@
 // ============================================================================
 // STD/STL
 // ============================================================================
+#include <cstddef>
 #include <vector>
 // ============================================================================
 // Ostap
@@ -67,6 +68,18 @@ namespace Ostap
       { return 
           x < m_xmin || x > m_xmax ? 0 : 
           y < m_ymin || y > m_ymax ? 0 : evaluate ( x , y ) ; }
+      /** evaluate the function for the array of points 
+       *  The per-axis Legendre basis values are computed for a block of 
+       *  points, and the coefficients are streamed once per block 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           double*           result ) const ;
       // =====================================================================
     public: 
       // ======================================================================
@@ -347,6 +360,20 @@ namespace Ostap
           x < m_xmin || x > m_xmax ? 0 : 
           y < m_ymin || y > m_ymax ? 0 : 
           z < m_zmin || z > m_zmax ? 0 : evaluate ( x , y , z ) ; }
+      /** evaluate the function for the array of points 
+       *  The per-axis Legendre basis values are computed for a block of 
+       *  points, and the coefficients are streamed once per block 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param z      (INPUT)  array of z-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           const double*     z      , 
+                           double*           result ) const ;
       // =====================================================================
     public:
       // ======================================================================
@@ -643,6 +670,22 @@ namespace Ostap
           y < m_ymin || y > m_ymax ? 0 : 
           z < m_zmin || z > m_zmax ? 0 : 
           u < m_umin || u > m_umax ? 0 : evaluate ( x , y , z , u ) ; }
+      /** evaluate the function for the array of points 
+       *  The per-axis Legendre basis values are computed for a block of 
+       *  points, and the coefficients are streamed once per block 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of x-values 
+       *  @param y      (INPUT)  array of y-values 
+       *  @param z      (INPUT)  array of z-values 
+       *  @param u      (INPUT)  array of u-values 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           const double*     y      , 
+                           const double*     z      , 
+                           const double*     u      , 
+                           double*           result ) const ;
       // =====================================================================
     public:
       // ======================================================================
@@ -6,6 +6,7 @@
 // ============================================================================
 #include <limits>
 #include <string>
+#include <vector>
 // ============================================================================
 // Forward desclarations 
 // ============================================================================ 
@@ -259,6 +260,93 @@ namespace Ostap
       const unsigned long        first       =  0 ,
       const unsigned long        last        = std::numeric_limits<unsigned long>::max() ) ;
     // ========================================================================
+    // Multithreaded one-pass moments 
+    // ========================================================================
+    /** fill Legendre sum with data from the Tree in one multithreaded pass 
+     *  - the per-event Legendre basis values are obtained from 
+     *    the recurrence (once per axis), and the all moments are 
+     *    updated via the outer product of the per-axis basis values 
+     *  - the partial sums from the chunks are merged in the fixed order
+     *  - optionally the covariance matrix of the coefficients 
+     *    \f$ C_{ab} = \sum_e w_e^2 f_a(e) f_b(e) \f$ is calculated 
+     *  @see Ostap::Math::LegendreSum 
+     *  @see Ostap::Math::LegendreSum::fill
+     *  @param tree       (INPUT)  the input tree 
+     *  @param sum        (UPDATE) the parameterization object 
+     *  @param expression (INPUT)  expression to be parameterized
+     *  @param selection  (INPUT)  selection/weight to be used 
+     *  @param nthreads   (INPUT)  number of threads (1: sequential processing)
+     *  @param cov2       (UPDATE) the covariance matrix of coefficients (row-major)
+     *  @param first      (INPUT)  the first event in Tree 
+     *  @param last       (INPUT)  the last  event in Tree 
+     *  @return  sum of weigths  used in parameterization
+     *  @code
+     *  Tree*  tree = ...
+     *  LegendreSum s ( 5 , -1 , 1 ) ;
+     *  std::vector<double> cov2 ;
+     *  DataParam::parameterizeMT ( tree , s , "x" , "y>10" , 8 , &cov2 ) ;
+     *  @endcode
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2026-10-15
+     */ 
+    static double parameterizeMT
+    ( TTree*                    tree            , 
+      Ostap::Math::LegendreSum& sum             , 
+      const std::string&        expression      , 
+      const std::string&        selection  = "" , 
+      const unsigned int        nthreads   = 0  , 
+      std::vector<double>*      cov2       = nullptr , 
+      const unsigned long       first      = 0  ,
+      const unsigned long       last       = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** fill 2D Legendre sum with data from the Tree in one multithreaded pass 
+     *  @see Ostap::DataParam::parameterizeMT 
+     *  @see Ostap::Math::LegendreSum2::fill
+     */ 
+    static double parameterizeMT
+    ( TTree*                     tree             , 
+      Ostap::Math::LegendreSum2& sum              , 
+      const std::string&         xexpression      , 
+      const std::string&         yexpression      , 
+      const std::string&         selection   = "" , 
+      const unsigned int         nthreads    = 0  , 
+      std::vector<double>*       cov2        = nullptr , 
+      const unsigned long        first       = 0  ,
+      const unsigned long        last        = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** fill 3D Legendre sum with data from the Tree in one multithreaded pass 
+     *  @see Ostap::DataParam::parameterizeMT 
+     *  @see Ostap::Math::LegendreSum3::fill
+     */ 
+    static double parameterizeMT
+    ( TTree*                     tree             , 
+      Ostap::Math::LegendreSum3& sum              , 
+      const std::string&         xexpression      , 
+      const std::string&         yexpression      , 
+      const std::string&         zexpression      , 
+      const std::string&         selection   = "" , 
+      const unsigned int         nthreads    = 0  , 
+      std::vector<double>*       cov2        = nullptr , 
+      const unsigned long        first       = 0  ,
+      const unsigned long        last        = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
+    /** fill 4D Legendre sum with data from the Tree in one multithreaded pass 
+     *  @see Ostap::DataParam::parameterizeMT 
+     *  @see Ostap::Math::LegendreSum4::fill
+     */ 
+    static double parameterizeMT
+    ( TTree*                     tree             , 
+      Ostap::Math::LegendreSum4& sum              , 
+      const std::string&         xexpression      , 
+      const std::string&         yexpression      , 
+      const std::string&         zexpression      , 
+      const std::string&         uexpression      , 
+      const std::string&         selection   = "" , 
+      const unsigned int         nthreads    = 0  , 
+      std::vector<double>*       cov2        = nullptr , 
+      const unsigned long        first       = 0  ,
+      const unsigned long        last        = std::numeric_limits<unsigned long>::max() ) ;
+    // ========================================================================
   } ; //                                      The end of class Ostap::DataParam 
   // ==========================================================================
 } //                                                 The end of namespace Ostap
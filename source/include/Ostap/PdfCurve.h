@@ -0,0 +1,135 @@
+// ============================================================================
+#ifndef OSTAP_PDFCURVE_H
+#define OSTAP_PDFCURVE_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <memory>
+#include <string>
+#include <vector>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooArgSet.h"
+// ============================================================================
+// forward declarations
+// ============================================================================
+class RooAbsReal       ; // from RooFit
+class RooAbsRealLValue ; // from RooFit
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class PdfCurve Ostap/PdfCurve.h
+     *  Evaluate the (projected) curves of PDF and its components
+     *  on the grid of the drawing variable in one go:
+     *  - the normalization set is fixed, therefore the normalization
+     *    integrals are calculated once and reused for all points and
+     *    for all components
+     *  - the projection over other observables is made with the single
+     *    integral object, created by <code>RooAbsReal::createIntegral</code>,
+     *    therefore the analytical integrals of the PDF are used if provided
+     *  - the components are selected in the same way as
+     *    <code>RooFit::Components</code> in <code>RooAbsReal::plotOn</code>
+     *
+     *  @code
+     *  const RooAbsPdf&  pdf   = ... ;
+     *  RooRealVar&       x     = ... ;
+     *  const RooArgSet   proj  ( y ) ; // project over y
+     *  Ostap::Utils::PdfCurve curve ( pdf , x , proj ) ;
+     *  std::vector<double> grid  = curve.grid ( 500 ) ;
+     *  std::vector<double> total = curve.values ( grid ) ;
+     *  std::vector<double> sig   = curve.values ( grid , "signal*" ) ;
+     *  @endcode
+     *  @attention the object is not thread-safe, as well as the PDF itself
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2026-10-15
+     */
+    class PdfCurve
+    {
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param pdf       the PDF (or function)
+       *  @param xvar      the drawing variable
+       *  @param projected the observables to be projected (integrated) out
+       */
+      PdfCurve
+      ( const RooAbsReal&  pdf                     ,
+        RooAbsRealLValue&  xvar                    ,
+        const RooArgSet&   projected = RooArgSet() ) ;
+      /// destructor
+      ~PdfCurve () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the uniform grid of points of the drawing variable (edges included)
+      std::vector<double> grid ( const unsigned int n ) const ;
+      // ======================================================================
+      /** evaluate the curve on the grid
+       *  @param x          the grid of points
+       *  @param components the (comma-separated, wildcards are allowed)
+       *                    list of components, the empty string means
+       *                    "the total PDF"
+       *  @return the (normalized) values of the curve
+       */
+      std::vector<double> values
+      ( const std::vector<double>& x               ,
+        const std::string&         components = "" ) const ;
+      // ======================================================================
+      /** evaluate several curves on the same grid
+       *  @param x          the grid of points
+       *  @param components the list of component selections
+       *  @return the (normalized) values of the curves
+       *  @see Ostap::Utils::PdfCurve::values
+       */
+      std::vector<std::vector<double> > curves
+      ( const std::vector<double>&      x          ,
+        const std::vector<std::string>& components ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the PDF
+      const RooAbsReal&       pdf       () const { return *m_pdf      ; }
+      /// the drawing variable
+      const RooAbsRealLValue& xvar      () const { return *m_xvar     ; }
+      /// the normalization set: the drawing variable and projected observables
+      const RooArgSet&        normset   () const { return  m_normset  ; }
+      /// the projected observables
+      const RooArgSet&        projected () const { return  m_projected ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// evaluate the curve for the current selection of components
+      void eval
+      ( const std::vector<double>& x      ,
+        std::vector<double>&       result ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the PDF
+      const RooAbsReal*           m_pdf       { nullptr } ; // the PDF
+      /// the drawing variable
+      RooAbsRealLValue*           m_xvar      { nullptr } ; // the drawing variable
+      /// the projected observables
+      RooArgSet                   m_projected {} ;
+      /// the normalization set
+      RooArgSet                   m_normset   {} ;
+      /// the projection integral
+      std::unique_ptr<RooAbsReal> m_integral  {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_PDFCURVE_H
+// ============================================================================
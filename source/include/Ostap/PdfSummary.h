@@ -0,0 +1,203 @@
+// ============================================================================
+#ifndef OSTAP_PDFSUMMARY_H
+#define OSTAP_PDFSUMMARY_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <functional>
+#include <utility>
+#include <vector>
+#include <limits>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/ChebyshevApproximation.h"
+// ============================================================================
+// forward declarations
+// ============================================================================
+class RooAbsReal       ; // from RooFit
+class RooAbsRealLValue ; // from RooFit
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class PdfSummary Ostap/PdfSummary.h
+     *  "One-shot" summary statistics for the 1D distribution:
+     *  the (piecewise Chebyshev) proxy of the distribution is built once,
+     *  and all moments, quantiles and intervals are derived from the proxy:
+     *  - moments are calculated with Gauss-Legendre quadratures that are
+     *    exact for the polynomial pieces of the proxy
+     *  - CDF is the exact integral of the proxy
+     *  - quantiles and intervals are obtained by Brent's method
+     *    using the cheap proxy and its integral
+     *
+     *  @code
+     *  const Ostap::Math::BW& bw = ... ;
+     *  const Ostap::Math::PdfSummary s ( bw , 0.2 , 2.0 ) ;
+     *  const double mean   = s.mean     () ;
+     *  const double rms    = s.rms      () ;
+     *  const double median = s.median   () ;
+     *  const double q10    = s.quantile ( 0.1 ) ;
+     *  @endcode
+     *  @see Ostap::Math::ChebyshevProxy
+     *  @see Ostap::Math::Solver1D
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class PdfSummary
+    {
+    public:
+      // ======================================================================
+      /** constructor from the proxy
+       *  @param proxy the proxy of the (unnormalized) distribution
+       *  @param nodes number of Gauss-Legendre nodes per piece,
+       *               0 means "exact for moments up to order 16"
+       */
+      PdfSummary
+      ( const Ostap::Math::ChebyshevProxy& proxy     ,
+        const unsigned short               nodes = 0 ) ;
+      // ======================================================================
+      /** constructor from the function and the interval
+       *  @param pdf       the (unnormalized) distribution
+       *  @param a         the low-limit
+       *  @param b         the high-limit
+       *  @param precision the (relative to max|f|) precision of the proxy
+       *  @param N         the approximation order in each piece
+       *  @param maxdepth  the maximal depth of bisections
+       */
+      PdfSummary
+      ( std::function<double(double)> pdf                ,
+        const double                  a                  ,
+        const double                  b                  ,
+        const double                  precision = 1.e-10 ,
+        const unsigned short          N         = 16     ,
+        const unsigned short          maxdepth  = 12     ) ;
+      // ======================================================================
+      /** constructor from RooFit PDF and the observable
+       *  @param pdf       the PDF
+       *  @param xvar      the observable (its value is restored)
+       *  @param a         the low-limit
+       *  @param b         the high-limit
+       *  @param precision the (relative to max|f|) precision of the proxy
+       *  @param N         the approximation order in each piece
+       *  @param maxdepth  the maximal depth of bisections
+       */
+      PdfSummary
+      ( const RooAbsReal&             pdf                ,
+        RooAbsRealLValue&             xvar               ,
+        const double                  a                  ,
+        const double                  b                  ,
+        const double                  precision = 1.e-10 ,
+        const unsigned short          N         = 16     ,
+        const unsigned short          maxdepth  = 12     ) ;
+      // ======================================================================
+      /// templated constructor
+      template <class FUNCTION>
+      PdfSummary
+      ( FUNCTION                      pdf                ,
+        const double                  a                  ,
+        const double                  b                  ,
+        const double                  precision = 1.e-10 ,
+        const unsigned short          N         = 16     ,
+        const unsigned short          maxdepth  = 12     )
+        : PdfSummary ( std::function<double(double)> ( std::cref ( pdf ) ) ,
+                       a , b , precision , N , maxdepth )
+      {}
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the proxy
+      const Ostap::Math::ChebyshevProxy& proxy () const { return m_proxy ; }
+      /// low edge
+      double xmin () const { return m_proxy.xmin () ; }
+      /// high edge
+      double xmax () const { return m_proxy.xmax () ; }
+      /// the normalization integral of the original distribution
+      double norm () const { return m_norm ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// normalized density (proxy)
+      double pdf ( const double x ) const ;
+      /// cumulative distribution function (proxy)
+      double cdf ( const double x ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the moment \f$ \int (x-x_0)^k f(x) dx \f$
+      double moment         ( const unsigned short k , const double x0 = 0 ) const ;
+      /// the central moment \f$ \int (x-\mu)^k f(x) dx \f$
+      double central_moment ( const unsigned short k ) const
+      { return moment ( k , m_mean ) ; }
+      /// the mean value
+      double mean           () const { return m_mean ; }
+      /// the variance
+      double variance       () const { return central_moment ( 2 ) ; }
+      /// the RMS
+      double rms            () const ;
+      /// the skewness
+      double skewness       () const ;
+      /// the (excess) kurtosis
+      double kurtosis       () const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the quantile
+      double quantile ( const double p ) const ;
+      /// the median
+      double median   () const { return quantile ( 0.5 ) ; }
+      /// the mode
+      double mode     () const ;
+      /** the points \f$ x_1 < x_{mode} < x_2 \f$, where
+       *  \f$ f(x_{1,2}) = \kappa f(x_{mode}) \f$
+       */
+      std::pair<double,double> width ( const double factor = 0.5 ) const ;
+      // ======================================================================
+      /** the half-width of the symmetric interval \f$ [x_0-s,x_0+s]\f$
+       *  with the given probability
+       *  @param prob the probability
+       *  @param x0   the center, the mean value is used if outside the interval
+       *              (or NaN)
+       */
+      double cl_symm
+      ( const double prob ,
+        const double x0   = std::numeric_limits<double>::quiet_NaN () ) const ;
+      /** the asymmetric interval \f$ [x_1,x_2]\f$ with the given probability,
+       *  such as \f$ f(x_1) = f(x_2)\f$ (for the unimodal distribution)
+       *  @param prob the probability
+       */
+      std::pair<double,double> cl_asymm ( const double prob ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// initialize nodes, weights and the mean value
+      void init ( const unsigned short nodes ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the proxy
+      Ostap::Math::ChebyshevProxy m_proxy      ; // the proxy
+      /// the normalization
+      double                      m_norm  { 1 } ; // normalization
+      /// the mean value
+      double                      m_mean  { 0 } ; // the mean value
+      /// quadrature nodes
+      std::vector<double>         m_x     {   } ; // quadrature nodes
+      /// quadrature weights, multiplied by the normalized density
+      std::vector<double>         m_w     {   } ; // quadrature weights
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_PDFSUMMARY_H
+// ============================================================================
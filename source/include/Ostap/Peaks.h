@@ -7,6 +7,7 @@
 // STD & STL 
 // ============================================================================
 #include <cmath>
+#include <memory>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -23,6 +24,8 @@ namespace Ostap
   // ==========================================================================
   namespace Math
   {
+    // ========================================================================
+    class ChebyshevProxy ; // forward declaration
     // ========================================================================
     /** @class BifurcatedGauss
      *  simple representation of bifurcated gaussian function
@@ -55,6 +58,14 @@ namespace Ostap
       double pdf        ( const double x ) const { return evaluate ( x ) ; }
       /// evaluate Bifurcated Gaussian
       double operator() ( const double x ) const { return evaluate ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -229,6 +240,22 @@ namespace Ostap
       double pdf        ( const double x ) const { return evaluate ( x ) ; }
       /// evaluate Bifurcated Gaussian
       double operator() ( const double x ) const { return evaluate ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
+      /** evaluate the function and the derivatives of its logarithm
+       *  with respect to the parameters (peak, sigma)
+       *  @param x    (INPUT)  the point
+       *  @param dlog (OUTPUT) array of derivatives, at least 2 elements
+       *  @return the value of the function
+       */
+      double dlogpdf    ( const double      x      ,
+                          double*           dlog   ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -590,6 +617,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate Bukin's function
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -795,6 +830,22 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate CrystalBall's function
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
+      /** evaluate the function and the derivatives of its logarithm
+       *  with respect to the parameters (m0, sigma, alpha, n)
+       *  @param x    (INPUT)  the point
+       *  @param dlog (OUTPUT) array of derivatives, at least 4 elements
+       *  @return the value of the function
+       */
+      double dlogpdf    ( const double      x      ,
+                          double*           dlog   ) const ;
       // ======================================================================
     public: // trivial accessors
       // ======================================================================
@@ -894,6 +945,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate Needham's function
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // trivial accessors
       // ======================================================================
@@ -971,6 +1030,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate CrystalBall's function
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // trivial accessors
       // ======================================================================
@@ -1043,6 +1110,22 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate CrystalBall's function
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
+      /** evaluate the function and the derivatives of its logarithm
+       *  with respect to the parameters (m0, sigma, alpha_L, n_L, alpha_R, n_R)
+       *  @param x    (INPUT)  the point
+       *  @param dlog (OUTPUT) array of derivatives, at least 6 elements
+       *  @return the value of the function
+       */
+      double dlogpdf    ( const double      x      ,
+                          double*           dlog   ) const ;
       // ======================================================================
     public: // trivial accessors
       // ======================================================================
@@ -1157,6 +1240,22 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate Apollonios's function
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
+      /** evaluate the function and the derivatives of its logarithm
+       *  with respect to the parameters (m0, sigma, alpha, n, b)
+       *  @param x    (INPUT)  the point
+       *  @param dlog (OUTPUT) array of derivatives, at least 5 elements
+       *  @return the value of the function
+       */
+      double dlogpdf    ( const double      x      ,
+                          double*           dlog   ) const ;
       // ======================================================================
     public: // trivial accessors
       // ======================================================================
@@ -1262,6 +1361,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate Apollonios2's function
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // trivial accessors
       // ======================================================================
@@ -1345,6 +1452,22 @@ namespace Ostap
       // ======================================================================
       /// calculate StudentT's shape
       double operator() ( const double x ) const{ return pdf ( x )  ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
+      /** evaluate the function and the derivatives of its logarithm
+       *  with respect to the parameters (M, sigma, nu)
+       *  @param x    (INPUT)  the point
+       *  @param dlog (OUTPUT) array of derivatives, at least 3 elements
+       *  @return the value of the function
+       */
+      double dlogpdf    ( const double      x      ,
+                          double*           dlog   ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -1564,6 +1687,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate sinhasinh-distributions
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // direct getters
       // ======================================================================
@@ -1653,6 +1784,14 @@ namespace Ostap
       double pdf        ( const double x ) const ;
       /// evaluate JohnsonSU-distributions
       double operator() ( const double x ) const { return pdf ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // direct getters
       // ======================================================================
@@ -2459,6 +2598,14 @@ namespace Ostap
       double pdf ( const  double x ) const ;
       /// evaluate  pdf  for Hyperbolic distribution
       double operator() ( const double x ) const { return pdf ( x ) ; }      
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // getters 
       // ======================================================================
@@ -2663,6 +2810,14 @@ namespace Ostap
       double pdf ( const  double x ) const ;
       /// evaluate  pdf  for Generalised Hyperbolic distribution
       inline double operator() ( const double x ) const { return pdf ( x ) ; }      
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public: // accessors
       // ======================================================================
@@ -2797,6 +2952,25 @@ namespace Ostap
        */
       double  m_N  { -1 } ; // normalization      
       // ======================================================================
+    private:
+      // ======================================================================
+      /** \f$ \log K^*_{\lambda-1/2}(x) \f$, 
+       *  where \f$ K^*_{\nu}(x) \f$ is scaled modified Bessel function
+       *  - for the half-integer \f$\nu\f$ the elementary expression is used 
+       *  - otherwise the Chebyshev proxy (if exists) or GSL 
+       */
+      double log_knu   ( const double x ) const ;
+      /// build the Chebyshev proxy for \f$ \log K^*_{\lambda-1/2}(x) \f$
+      void   build_knu () const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /** the Chebyshev proxy for \f$ \log K^*_{\lambda-1/2}(\mathrm{e}^{u}) \f$ 
+       *  - it depends only on \f$ \lambda \f$  and is kept for all other parameters 
+       *  - it is built at the first array evaluation or integration 
+       */
+      mutable std::shared_ptr<const ChebyshevProxy> m_knu {} ;
+      // ======================================================================
     private:
       // ======================================================================
       /// integration workspace
@@ -8,6 +8,7 @@
 // ============================================================================
 #include <complex>
 #include <vector>
+#include <memory>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -24,6 +25,8 @@ namespace Ostap
   // ==========================================================================
   namespace Math
   {
+    // ========================================================================
+    class ChebyshevApproximation ; // forward declaration 
     // ========================================================================
     /** @class PhaseSpace2
      *  Function to represent two-body phase space
@@ -368,6 +371,17 @@ namespace Ostap
     // ========================================================================
     /** @class PhaseSpace3
      *  Function to represent three-body phase space
+     *
+     *  The direct evaluation requires the numerical integration for 
+     *  each mass point. Therefore the function is approximated (lazily) 
+     *  with Chebyshev polynomials in the range
+     *  \f$ x_{thr} < x \le x_{thr} + 100 x_{thr} \f$, 
+     *  that is extended on demand. The ratio of the phase space to 
+     *  its threshold & asymptotic behaviour is approximated, 
+     *  that guarantees the relative precision \f$ \le 10^{-7}\f$ 
+     *  everywhere. If the precision can't be achieved, 
+     *  the direct integration is used. 
+     *  @see Ostap::Math::PhaseSpace3::direct 
      *  @author Vanya BELYAEV Ivan.BElyaev@itep.ru
      *  @date 2011-11-30
      */
@@ -419,6 +433,12 @@ namespace Ostap
        */
       double operator () ( const double x ) const { return evaluate  ( x ) ; }
       // ======================================================================
+      /** evaluate 3-body phase space via the direct numerical integration, 
+       *  (no approximation is used)
+       *  @see Ostap::Math::PhaseSpace3::evaluate 
+       */
+      double direct      ( const double x ) const ;
+      // ======================================================================
     public:
       // ======================================================================
       double m1 () const { return m_m1 ; }
@@ -475,6 +495,13 @@ namespace Ostap
       /// the temporary mass
       mutable double m_tmp { 0 } ; /// the temporary mass
       // ======================================================================
+    private:
+      // ======================================================================
+      /// the approximation of the phase space (built lazily)
+      mutable std::shared_ptr<const ChebyshevApproximation> m_approx {} ; 
+      /// approximation has failed? 
+      mutable bool                                          m_failed { false } ;
+      // ======================================================================
     private:
       // ======================================================================
       /// integration workspace
@@ -557,7 +584,9 @@ namespace Ostap
       // ======================================================================
       /// get the integral
       double integral () const ;
-      /// get the integral between low and high limits
+      /** get the integral between low and high limits
+       *  (incomplete beta-function for the generic case) 
+       */
       double integral ( const double low  ,
                         const double high ) const ;
       // ======================================================================
@@ -578,11 +607,6 @@ namespace Ostap
       /// normalization
       double         m_norm       ; // normalization
       // ======================================================================
-    private:
-      // ======================================================================
-      /// integration workspace
-      Ostap::Math::WorkSpace m_workspace ;    // integration workspace
-      // ======================================================================
     } ;
     // ========================================================================
     /** @class PhaseSpaceLeft
@@ -838,6 +862,12 @@ namespace Ostap
      *    the third particle.
      *   E.g. taking \f$\ell=0, L=1\f$, one can get the S-wave contribution for
      *   \f$\pi^+\pi^-\f$-mass from \f$B^0\rightarrow J/\psi\pi^+\pi^-\f$ decay.
+     *
+     *  The integrals are calculated using the Chebyshev approximation 
+     *  for the density in variable 
+     *  \f$ t = \arccos \left( 1 - 2\frac{x-x_{min}}{x_{max}-x_{min}} \right) \f$, 
+     *  where it is a smooth function at both edges. 
+     *  The approximation is built lazily. 
      *  @author Vanya BELYAEV Ivan.BElyaev@itep.ru
      *  @date 2012-04-01
      */
@@ -939,6 +969,13 @@ namespace Ostap
       /// helper normalization parameter
       double m_norm ; // helper normalization parameter
       // ======================================================================
+    private:
+      // ======================================================================
+      /// the approximation of the cumulative distribution (built lazily)
+      mutable std::shared_ptr<const ChebyshevApproximation> m_cdf    {} ; 
+      /// approximation has failed? 
+      mutable bool                                          m_failed { false } ;
+      // ======================================================================
     private:
       // ======================================================================
       /// integration workspace
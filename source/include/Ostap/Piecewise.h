@@ -8,7 +8,9 @@
 // ============================================================================
 #include <functional>
 #include <algorithm>
+#include <type_traits>
 #include <vector>
+#include <cstddef>
 // ============================================================================
 namespace Ostap
 {
@@ -18,6 +20,9 @@ namespace Ostap
     // ========================================================================
     /** @class Piecewise Ostap/Piecewise.h
      *  Simple Piecewise-function
+     *  - the segment is found via the lookup table for the sorted edges 
+     *  - constant components and plain functions (including lambdas 
+     *    without captures) are called directly, bypassing <code>std::function</code>
      *  @author Vanya Belyaev
      *  @date   2020-06-29
      */
@@ -26,6 +31,8 @@ namespace Ostap
     public:
       // ======================================================================
       typedef std::pair< std::function<double(double)>,double> FPAIR ;
+      /// plain function 
+      typedef double (*FPTR) ( double ) ;
       // ======================================================================
     public: 
       // ======================================================================
@@ -37,9 +44,11 @@ namespace Ostap
       Piecewise
       ( FUNCTION     f1     ,
         const double s1 = 1 ) 
-        : m_edges () 
-        , m_funcs ( 1 , FPAIR ( f1 , s1 ) )
-      {}
+        : m_edges    () 
+        , m_funcs    () 
+        , m_segments () 
+        , m_table    () 
+      { this->push ( f1 , s1 ) ; }
       // =======================================================================
       /// constructor with several functions 
       template <class FUNCTION, typename... ARGS> 
@@ -47,10 +56,13 @@ namespace Ostap
       ( FUNCTION     f1   ,
         const double s1   , 
         ARGS...      args ) 
-        : m_edges () 
-        , m_funcs ( 1 , FPAIR ( f1 , s1 ) )
+        : m_edges    () 
+        , m_funcs    () 
+        , m_segments () 
+        , m_table    () 
       {
-        this->add ( args... ) ;
+        this->push ( f1 , s1 ) ;
+        this->add  ( args... ) ;
       }
       // ======================================================================
       /// default constructor : create a constant function
@@ -63,10 +75,18 @@ namespace Ostap
       // ======================================================================
       /// the main method 
       inline double operator() ( const double x ) const 
-      { 
-        const FPAIR& p = m_funcs [ index( x  ) ] ;
-        return p.first ( x ) * p.second ;
-      }
+      { return this->value ( index ( x ) , x ) ; }
+      // ======================================================================
+      /** evaluate the function for the array of points 
+       *  - the points are grouped by segments 
+       *  @param n      number of points 
+       *  @param x      (INPUT)  the points 
+       *  @param result (OUTPUT) the function values
+       */
+      void evaluate 
+      ( const std::size_t n      , 
+        const double*     x      , 
+        double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -74,12 +94,40 @@ namespace Ostap
       const std::vector<double>& edges    () const 
       { return m_edges ; }
       /// get all (function,scale) pairs 
-      const std::vector<FPAIR> functions() const { return m_funcs ; }
-      /// find the proper interval 
-      std::size_t index (  const double x ) const 
+      const std::vector<FPAIR>& functions() const { return m_funcs ; }
+      /// number of segments
+      std::size_t size      () const { return m_funcs.size () ; }
+      /// find the proper interval: the number of edges that are not larger than x 
+      inline std::size_t index (  const double x ) const 
       {
-        auto found = std::upper_bound ( m_edges.begin () , m_edges.end () , x ) ;
-        return m_edges.end() == found ? m_edges.size () : found - m_edges.begin() ;
+        const std::size_t N = m_edges.size () ;
+        if ( m_table.empty () ) 
+        {
+          auto found = std::upper_bound ( m_edges.begin () , m_edges.end () , x ) ;
+          return found - m_edges.begin() ;
+        }
+        // 1) the lookup table 
+        const double      xmin = m_edges.front () ;
+        const double      xmax = m_edges.back  () ;
+        if      ( !( xmin <= x ) ) { return 0 ; }
+        else if (    xmax <= x   ) { return N ; }
+        const std::size_t M = m_table.size () ;
+        const std::size_t b = std::min ( std::size_t ( ( x - xmin ) / ( xmax - xmin ) * M ) , M - 1 ) ;
+        std::size_t       j = m_table [ b ] ;
+        // 2) local adjustment 
+        while ( j < N && m_edges [ j     ] <= x ) { ++j ; }
+        while ( 0 < j && x < m_edges [ j - 1 ] ) { --j ; }
+        return j ;
+      }
+      /// the value of the j-th component at point x (including the scale)
+      inline double value ( const std::size_t j , const double x ) const 
+      {
+        const FPAIR&   p = m_funcs    [ j ] ;
+        const Segment& s = m_segments [ j ] ;
+        return 
+          Constant == s.kind ? p.second                 :
+          Pointer  == s.kind ? p.second * s.ptr   ( x ) :
+          p.second * p.first ( x ) ;
       }
       // ======================================================================
     protected:
@@ -92,6 +140,70 @@ namespace Ostap
         std::function<double(double)> f     , 
         const double                  s = 1 ) ;
       // ======================================================================
+    private:
+      // ======================================================================
+      /// the kind of the component 
+      enum Kind : unsigned char { Constant , Pointer , Generic } ; 
+      /// the component for the fast dispatch 
+      struct Segment 
+      {
+        Kind kind { Generic } ;
+        FPTR ptr  { nullptr } ;
+      } ;
+      // ======================================================================
+      /// add the component: the edge is checked and the lookup table updated
+      void add_ ( const double x , const FPAIR& p , const Segment& s ) ;
+      /// add the very first component 
+      void push_ (                 const FPAIR& p , const Segment& s ) ;
+      /// (re)build the lookup table 
+      void updateTable () ;
+      // ======================================================================
+      /// make a component from the constant 
+      template <class FUNCTION>
+      static inline FPAIR make_
+      ( const FUNCTION& f , const double s , Segment& seg , std::true_type , std::false_type ) 
+      {
+        seg.kind = Constant ;
+        return FPAIR ( []( const double /* x */ ) -> double { return 1 ; } , f * s ) ;
+      }
+      /// make a component from the plain function (or lambda without captures) 
+      template <class FUNCTION>
+      static inline FPAIR make_
+      ( const FUNCTION& f , const double s , Segment& seg , std::false_type , std::true_type ) 
+      {
+        seg.kind = Pointer ;
+        seg.ptr  = static_cast<FPTR> ( f ) ;
+        return FPAIR ( seg.ptr , s ) ;
+      }
+      /// make a component from the generic callable 
+      template <class FUNCTION>
+      static inline FPAIR make_
+      ( const FUNCTION& f , const double s , Segment& seg , std::false_type , std::false_type ) 
+      {
+        seg.kind = Generic ;
+        return FPAIR ( f , s ) ;
+      }
+      /// make a component 
+      template <class FUNCTION>
+      static inline FPAIR make
+      ( const FUNCTION& f , const double s , Segment& seg )
+      {
+        return make_ 
+          ( f , s , seg , 
+            typename std::is_arithmetic<FUNCTION>::type  () , 
+            typename std::integral_constant<bool,
+            !std::is_arithmetic<FUNCTION>::value && 
+            std::is_convertible<FUNCTION,FPTR>::value>::type () ) ;
+      }
+      /// add the very first component 
+      template <class FUNCTION>
+      void push ( const FUNCTION& f , const double s ) 
+      {
+        Segment seg {} ;
+        const FPAIR p = make ( f , s , seg ) ;
+        this->push_ ( p , seg ) ;
+      }
+      // ======================================================================
     public:
       // ======================================================================
       /// template creator 
@@ -114,7 +226,12 @@ namespace Ostap
       void add
       ( const double  xi       , 
         FUNCTION      fi       , 
-        const double  si = 1.0 ) { this->add_ ( xi , fi , si ) ; }
+        const double  si = 1.0 ) 
+      {
+        Segment seg {} ;
+        const FPAIR p = make ( fi , si , seg ) ;
+        this->add_ ( xi , p , seg ) ;
+      }
       // ======================================================================
       /** add new function, defined for  \f$ x\ge x_i\$ 
        *  @attention xi must be larger than any previosly added ranges!
@@ -129,7 +246,7 @@ namespace Ostap
         const double si   , 
         ARGS...      args )
       {
-        this->add_ ( xi , fi , si ) ;
+        this->add  ( xi , fi , si ) ;
         this->add  ( args...      ) ;
       }
       // ======================================================================
@@ -146,6 +263,10 @@ namespace Ostap
       std::vector<double> m_edges ; // list of edges 
       /// (function,scale) pairs 
       std::vector<FPAIR>  m_funcs ; // (function,scale) pairs 
+      /// components for the fast dispatch 
+      std::vector<Segment>     m_segments ; // components for the fast dispatch
+      /// lookup table for segments 
+      std::vector<std::size_t> m_table    ; // lookup table for segments 
       // ======================================================================
     };
     // ========================================================================
@@ -162,6 +162,65 @@ namespace Ostap
         const Ostap::LorentzVector& beam2                                ,
         const UseMadisonConvention  madison = UseMadisonConvention{true} ) ;
       // =====================================================================      
+    public: // batch processing 
+      // =====================================================================
+      /** get the angles \f$(\cos \theta,\phi)\f$ for the arrays of candidates 
+       *  (structure-of-arrays), e.g. for the columns of the tree.
+       *  For each candidate <code>i</code> the particle 
+       *  <code>(px[i],py[i],pz[i],pe[i])</code> is considered 
+       *  in the rest frame of the particle <code>(mx[i],my[i],mz[i],me[i])</code> 
+       *  and the fixed beam-momenta <code>beam1</code> and <code>beam2</code>.
+       *
+       *  The frame axes are never constructed explicitely: all quantities 
+       *  are expressed via the invariant products of the particle, 
+       *  the mother and the beams (in double precision), that gives 
+       *  a short branch-free loop over candidates.
+       *
+       *  @code
+       *  const std::size_t n = ... ;
+       *  std::vector<double> ct ( n ) , phi ( n ) ;
+       *  Polarization::angles ( Polarization::Frames::Recoil , n ,
+       *                         mu_px , mu_py , mu_pz , mu_e , 
+       *                         jpsi_px , jpsi_py , jpsi_pz , jpsi_e , 
+       *                         beam1 , beam2 , ct.data () , phi.data () ) ;
+       *  @endcode
+       *  @param f         the frame 
+       *  @param n         number of candidates 
+       *  @param px        x-components of the particle momenta 
+       *  @param py        y-components of the particle momenta 
+       *  @param pz        z-components of the particle momenta 
+       *  @param pe        energies of the particle 
+       *  @param mx        x-components of the mother momenta 
+       *  @param my        y-components of the mother momenta 
+       *  @param mz        z-components of the mother momenta 
+       *  @param me        energies of the mother 
+       *  @param beam1     4-momenta of the first colliding particle
+       *  @param beam2     4-momenta of the second colliding particle
+       *  @param cos_theta (OUTPUT) \f$ \cos\theta \f$ 
+       *  @param phi       (OUTPUT) \f$ \phi \f$ 
+       *  @param madison   use Madison convention?
+       *  @param nthreads  number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+       *  @return number of valid candidates (for invalid candidates 
+       *          large negative values are stored)
+       */
+      static std::size_t angles 
+      ( const Frames                f                                     , 
+        const std::size_t           n                                     , 
+        const double*               px                                    , 
+        const double*               py                                    , 
+        const double*               pz                                    , 
+        const double*               pe                                    , 
+        const double*               mx                                    , 
+        const double*               my                                    , 
+        const double*               mz                                    , 
+        const double*               me                                    , 
+        const Ostap::LorentzVector& beam1                                 , 
+        const Ostap::LorentzVector& beam2                                 , 
+        double*                     cos_theta                             , 
+        double*                     phi                                   , 
+        const UseMadisonConvention  madison  = UseMadisonConvention{true} , 
+        const unsigned int          nthreads = 1                          ) ;
+      // =====================================================================      
     } ; //                                The end of Ostap::Math::Polarization
     // =======================================================================
   } //                                        The end of namespace Ostap::Math
@@ -1493,6 +1493,14 @@ namespace Ostap
       /// get the value
       double operator () ( const double x ) const 
       { return x < m_xmin ? 0 : x > m_xmax ? 0 : evaluate ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -1660,6 +1668,14 @@ namespace Ostap
       /// get the value
       double operator () ( const double x ) const 
       { return x < m_xmin ? 0 : x > m_xmax ? 0 : evaluate ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -1830,6 +1846,14 @@ namespace Ostap
       /// get the value
       double operator () ( const double x ) const 
       { return x < m_xmin ? 0 : x > m_xmax ? 0 : evaluate ( x ) ; }
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -2003,6 +2027,14 @@ namespace Ostap
       double evaluate    ( const double x ) const ;
       /// get the value
       double operator () ( const double x ) const ;
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate    ( const std::size_t n      , 
+                           const double*     x      , 
+                           double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
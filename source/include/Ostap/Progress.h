@@ -0,0 +1,157 @@
+// ============================================================================
+#ifndef OSTAP_PROGRESS_H
+#define OSTAP_PROGRESS_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+// ============================================================================
+/** @file Ostap/Progress.h
+ *  Lock-free progress reporting for the multithreaded loops
+ *  - each slot (thread) increments its own atomic counter,
+ *  - the progress bar is rendered by one thread at a time,
+ *    not more often than the given time interval,
+ *    other threads never wait
+ *  @see Ostap::Utils::frame_progress
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class Progress Ostap/Progress.h
+     *  Lock-free progress bar for the multithreaded loops
+     *  @code
+     *  Progress progress ( nentries , nthreads ) ;
+     *  ...
+     *  progress.add ( islot , n ) ; ///  from the thread with index <code>islot</code>
+     *  ...
+     *  progress.finish () ;
+     *  @endcode
+     *  The format of progress bar is:
+     *  <code>left+(%*symbol)+(N-%)*blank+right+percentage</code>
+     */
+    class Progress
+    {
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param total    total number of items to be processed
+       *  @param nslots   number of slots (threads)
+       *  @param width    width of the bar (number of symbols)
+       *  @param symbol   symbol to use as progress
+       *  @param blank    blank symbol
+       *  @param left     prefix
+       *  @param right    suffix
+       *  @param interval minimal time interval (seconds) between renderings
+       */
+      Progress
+      ( const unsigned long long total              ,
+        const unsigned int       nslots   = 1       ,
+        const unsigned short     width    = 50      ,
+        const std::string&       symbol   = "#"     ,
+        const std::string&       blank    = " "     ,
+        const std::string&       left     = "[ "    ,
+        const std::string&       right    = " ]"    ,
+        const double             interval = 0.1     ) ;
+      /// destructor: finish the progress bar
+      ~Progress () ;
+      // ======================================================================
+      Progress ( const Progress& ) = delete ;
+      Progress& operator= ( const Progress& ) = delete ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** add items from the given slot (thread)
+       *  - no locks, the rendering is rate-limited
+       *  @param slot the slot (thread)
+       *  @param n    number of processed items
+       */
+      inline void add
+      ( const unsigned int       slot     ,
+        const unsigned long long n  = 1   )
+      {
+        m_slots [ slot % m_slots.size () ].value.fetch_add ( n , std::memory_order_relaxed ) ;
+        const long long now = ticks () ;
+        long long next = m_next.load ( std::memory_order_relaxed ) ;
+        if ( now < next ) { return ; }                               // RETURN
+        // the only thread that moves the time mark renders the bar
+        if ( m_next.compare_exchange_strong ( next , now + m_interval , std::memory_order_relaxed ) )
+        { render ( false ) ; }
+      }
+      // ======================================================================
+      /// number of processed items (all slots)
+      unsigned long long count () const ;
+      /// total number of items
+      unsigned long long total () const { return m_total ; }
+      // ======================================================================
+      /// show the final bar (once)
+      void finish () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// show the progress bar for parallel engines (StatVar, HistoProject, ...)?
+      static bool enabled () ;
+      /** enable/disable the progress bar for parallel engines
+       *  @return the previous value
+       */
+      static bool enable  ( const bool value ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// current time (ns)
+      static long long ticks ()
+      {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>
+          ( std::chrono::steady_clock::now ().time_since_epoch () ).count () ;
+      }
+      /// render the progress bar
+      void render ( const bool last ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the counter for the slot, each at own cache line
+      struct alignas(64) Counter { std::atomic<unsigned long long> value { 0 } ; } ;
+      // ======================================================================
+      /// the counters
+      std::vector<Counter>      m_slots               ;
+      /// total number of items
+      unsigned long long        m_total    { 0 }      ;
+      /// the width
+      unsigned short            m_width    { 50 }     ;
+      /// symbol to use as progress
+      std::string               m_symbol   { "#"  }   ;
+      /// blank symbol
+      std::string               m_blank    { " "  }   ;
+      /// prefix
+      std::string               m_left     { "[ " }   ;
+      /// suffix
+      std::string               m_right    { " ]" }   ;
+      /// minimal interval between renderings (ns)
+      long long                 m_interval { 0 }      ;
+      /// the time mark for the next rendering (ns)
+      std::atomic<long long>    m_next     { 0 }      ;
+      /// the rendering is in progress
+      std::atomic_flag          m_render   = ATOMIC_FLAG_INIT ;
+      /// the final bar is shown
+      std::atomic<bool>         m_done     { false }  ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // OSTAP_PROGRESS_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
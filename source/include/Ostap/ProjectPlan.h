@@ -0,0 +1,180 @@
+// ============================================================================
+#ifndef OSTAP_PROJECTPLAN_H
+#define OSTAP_PROJECTPLAN_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <limits>
+#include <string>
+#include <vector>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/StatusCode.h"
+// ============================================================================
+// Forward declarations
+// =============================================================================
+class TH1        ; // ROOT
+class TH2        ; // ROOT
+class TH3        ; // ROOT
+class TTree      ; // ROOT
+class RooAbsData ; // RooFit
+// =============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  /** @class ProjectPlan Ostap/ProjectPlan.h
+   *  "Projection plan": fill many histograms in a single loop over
+   *  the TTree/TChain or RooAbsData
+   *
+   *  - each histogram is registered together with its expressions and
+   *    (optional) individual selection/weight
+   *  - the (optional) common selection is applied to all histograms
+   *  - identical expressions and selections are compiled only once and
+   *    evaluated at most once per entry
+   *
+   *  @code
+   *  Ostap::ProjectPlan plan ( "pt>1" ) ;
+   *  plan.add ( h1 , "mass"            ) ;
+   *  plan.add ( h2 , "mass" , "y<3"    ) ;
+   *  plan.add ( h3 , "mass" , "pt" , "y<3" ) ;
+   *  plan.project ( tree ) ;
+   *  @endcode
+   *  @attention for array-like expressions only the first element is used
+   *  @attention the histograms are not owned by the plan
+   *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+   *  @date   2023-01-19
+   */
+  class ProjectPlan
+  {
+  public:
+    // ========================================================================
+    /** constructor with the common selection
+     *  @param selection (INPUT) the common selection/weight for all histograms
+     */
+    ProjectPlan ( const std::string& selection = "" ) ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    /** register the 1D-histogram
+     *  @param histo      (UPDATE) the histogram
+     *  @param expression (INPUT)  the expression
+     *  @param selection  (INPUT)  the selection/weight for this histogram
+     *  @return the number of registered histograms
+     */
+    std::size_t add
+    ( TH1*               histo           ,
+      const std::string& expression      ,
+      const std::string& selection  = "" ) ;
+    // ========================================================================
+    /** register the 2D-histogram
+     *  @param histo       (UPDATE) the histogram
+     *  @param xexpression (INPUT)  the expression for x-axis
+     *  @param yexpression (INPUT)  the expression for y-axis
+     *  @param selection   (INPUT)  the selection/weight for this histogram
+     *  @return the number of registered histograms
+     */
+    std::size_t add
+    ( TH2*               histo            ,
+      const std::string& xexpression      ,
+      const std::string& yexpression      ,
+      const std::string& selection   = "" ) ;
+    // ========================================================================
+    /** register the 3D-histogram
+     *  @param histo       (UPDATE) the histogram
+     *  @param xexpression (INPUT)  the expression for x-axis
+     *  @param yexpression (INPUT)  the expression for y-axis
+     *  @param zexpression (INPUT)  the expression for z-axis
+     *  @param selection   (INPUT)  the selection/weight for this histogram
+     *  @return the number of registered histograms
+     */
+    std::size_t add
+    ( TH3*               histo            ,
+      const std::string& xexpression      ,
+      const std::string& yexpression      ,
+      const std::string& zexpression      ,
+      const std::string& selection   = "" ) ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    /** fill all registered histograms in a single loop over the tree
+     *  @param tree  (INPUT) the tree/chain
+     *  @param first (INPUT) the first entry to process
+     *  @param last  (INPUT) the last entry to process (not including!)
+     *  @return status code
+     *  - 300 : invalid tree
+     *  - 301 : invalid histogram
+     *  - 303+i : invalid i-th distinct expression/selection
+     */
+    Ostap::StatusCode project
+    ( TTree*              tree                                            ,
+      const unsigned long first = 0                                       ,
+      const unsigned long last  = std::numeric_limits<unsigned long>::max () ) ;
+    // ========================================================================
+    /** fill all registered histograms in a single loop over the data
+     *  @param data      (INPUT) the dataset
+     *  @param cut_range (INPUT) the cut-range
+     *  @param first     (INPUT) the first entry to process
+     *  @param last      (INPUT) the last entry to process (not including!)
+     *  @return status code
+     */
+    Ostap::StatusCode project
+    ( const RooAbsData*   data                                            ,
+      const std::string&  cut_range = ""                                  ,
+      const unsigned long first     = 0                                   ,
+      const unsigned long last      = std::numeric_limits<unsigned long>::max () ) ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    /// number of registered histograms
+    std::size_t size        () const { return m_items.size () ; }
+    /// number of distinct expressions/selections
+    std::size_t expressions () const { return m_expressions.size () ; }
+    /// the common selection
+    const std::string& selection () const { return m_selection ; }
+    /// reset all registered histograms
+    void reset () ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    /** @struct Item
+     *  the registered histogram
+     */
+    struct Item
+    {
+      /// the histogram
+      TH1*                  histo     { nullptr } ; // the histogram
+      /// the dimension
+      unsigned short        dim       { 1 }       ; // the dimension
+      /// indices of expressions for x,y,z axes
+      std::size_t           axes  [3] { 0 , 0 , 0 } ; // indices of expressions
+      /// index of the individual selection (or -1)
+      long                  selection { -1 }        ; // index of the selection
+    } ;
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// register the expression and get its index
+    std::size_t index ( const std::string& expression ) ;
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the common selection
+    std::string              m_selection   {} ; // the common selection
+    /// index of the common selection (or -1)
+    long                     m_cut         { -1 } ; // index of the common selection
+    /// distinct expressions
+    std::vector<std::string> m_expressions {} ; // distinct expressions
+    /// registered histograms
+    std::vector<Item>        m_items       {} ; // registered histograms
+    // ========================================================================
+  } ;
+  // ==========================================================================
+} //                                                     end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_PROJECTPLAN_H
+// ============================================================================
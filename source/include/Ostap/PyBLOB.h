@@ -28,6 +28,34 @@ namespace Ostap
    */
   PyObject* blob_from_bytes ( BLOB& blob , PyObject* bytes ) ;
   // ==========================================================================
+  /** fill the blob from any object that supports buffer protocol
+   *  (e.g. numpy array, bytes, bytearray, memoryview) without intermediate copies 
+   *  @see   Ostap::BLOB
+   *  @param blob     the blob to be updated 
+   *  @param obj      (INPUT) C-contiguous buffer object 
+   *  @param compress ROOT compression setting, e.g. 404 for LZ4 and 505 for ZSTD 
+   *  @return True if conversion successul
+   */
+  PyObject* blob_from_buffer ( BLOB& blob , PyObject* obj , const int compress = 0 ) ;
+  // ==========================================================================
+  /** extract (and uncompress) the content of the blob directly 
+   *  into writable buffer object, e.g. preallocated numpy array 
+   *  @see   Ostap::BLOB
+   *  @param blob the blob
+   *  @param obj  (UPDATE) writable C-contiguous buffer object of size <code>blob.raw_size()</code>
+   *  @return True if conversion successul
+   */
+  PyObject* blob_to_buffer   ( const BLOB& blob , PyObject* obj ) ;
+  // ==========================================================================
+  /** read-only memoryview for the content of uncompressed blob (no copy), 
+   *  for compressed blob the uncompressed bytes are returned 
+   *  @attention the view is valid only while the blob is alive 
+   *  @see   Ostap::BLOB
+   *  @param blob the blob
+   *  @return memoryview or bytes 
+   */
+  PyObject* blob_to_memoryview ( const BLOB& blob ) ;
+  // ==========================================================================
 } //                                                 The end of namespace Ostap
 // ============================================================================
 //                                                                     The END 
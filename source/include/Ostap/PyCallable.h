@@ -9,6 +9,10 @@
 struct  _object ;
 typedef _object PyObject ;
 // ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/NativeFunctions.h"
+// ============================================================================
 namespace Ostap
 {
   // ==========================================================================
@@ -17,6 +21,10 @@ namespace Ostap
     // ========================================================================
     /** @class PyCallable Ostap/PyCallable.h
      *  Simple C++   wrapper for the python callable 
+     *  - for the compiled functions (e.g. <code>numba.cfunc</code>,
+     *    <code>ctypes</code> or <code>cffi</code>) the raw function
+     *    pointer is called directly, without Python C-API and GIL
+     *  @see Ostap::Functions::NativeFunction1
      *  @author Vanya Belyaev
      *  @date   2019-09-25
      */
@@ -26,6 +34,8 @@ namespace Ostap
       // ======================================================================
       /// constructor from the callable object 
       PyCallable ( PyObject* callable , const bool ok ) ;
+      /// constructor from the compiled function (no Python, no GIL)
+      PyCallable ( const NativeFunction1& native ) ;
       /// copy constructor 
       PyCallable ( const PyCallable&  right ) ;
       /// Move constructor 
@@ -40,12 +50,17 @@ namespace Ostap
       /// the main method 
       double evaluate    ( const double x ) const ;
       // ======================================================================
+      /// is it the compiled function?
+      bool   native      () const { return nullptr != m_native ; }
+      // ======================================================================
     private :
       // ======================================================================
       // the callable object 
       PyObject* m_callable   { nullptr } ;
       // the tuple of arguments 
       PyObject* m_arguments  { nullptr } ;
+      // the compiled function 
+      NativeFunction1::raw_function m_native { nullptr } ;
       // ======================================================================
     };
     // ========================================================================
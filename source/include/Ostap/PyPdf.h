@@ -4,8 +4,9 @@
 // ============================================================================
 // Include files
 // ============================================================================
-// RooFit 
+// ROOT&RooFit 
 // ============================================================================
+#include "RVersion.h"
 #include "RooAbsPdf.h"
 #include "RooRealProxy.h"
 #include "RooListProxy.h"
@@ -15,6 +16,7 @@
 // ============================================================================
 #include "Ostap/OstapPyROOT.h"
 #include "Ostap/PyCallable.h"
+#include "Ostap/BatchCompute.h"
 // ============================================================================
 namespace Ostap 
 {
@@ -180,6 +182,27 @@ namespace Ostap
       /// helper function to be redefined in python  
       virtual double     analytical_integral () const ;
       // ======================================================================
+    public: // batch evaluation 
+      // ======================================================================
+      // ======================================================================
+      /** the batch evaluation of function:
+       *  the python method <code>evaluate_batch</code> is invoked once 
+       *  for the whole batch, otherwise it falls back to the 
+       *  event-by-event evaluation 
+       */
+      OSTAP_BATCH_DECLARE_FALLBACK
+      // ======================================================================
+      // ======================================================================
+      /** helper function to be redefined in python: batch evaluation 
+       *  @param output (UPDATE) writable <code>memoryview</code> for the results 
+       *  @param inputs (INPUT)  tuple of read-only <code>memoryview</code>s for 
+       *                all variables (the length is 1 for scalar variables) 
+       *  @return true if the batch is evaluated, false for event-by-event fallback 
+       */
+      virtual bool evaluate_batch 
+      ( PyObject* output , 
+        PyObject* inputs ) const ;
+      // ======================================================================
     private:
       // ======================================================================  
 #if defined(OSTAP_OLD_PYROOT) && OSTAP_OLD_PYROOT
@@ -203,6 +226,11 @@ namespace Ostap
     // ========================================================================
     /** @class PyPdf2 Ostap/PyPdf.h
      *  ``Light'' version of PyPdf
+     *  - the function is called with the values of all variables 
+     *  - optional batch callable is invoked once per RooFit batch as 
+     *    <code>batch ( output , x1 , x2 , ... )</code>, where all arguments 
+     *    are <code>memoryview</code>s over the spans of doubles:  
+     *    writable for output and read-only (length 1 for scalars) for variables 
      *  @see Ostap::Models::PyPDF
      *  @see ostap.fitting.pypdf.PyPDF2
      *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
@@ -272,11 +300,27 @@ namespace Ostap
       // the actual evaluation of function
       Double_t evaluate() const override;
       // ======================================================================
+      // ======================================================================
+      /// the batch evaluation of function (one python call per batch)
+      OSTAP_BATCH_DECLARE_FALLBACK
+      // ======================================================================
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// get the batch callable (if any)
+      PyObject* batch    () const { return m_batch ; }
+      /** set the batch callable 
+       *  @param batch <code>batch ( output , x1 , x2 , ... )</code> or nullptr/None 
+       */
+      void      setBatch ( PyObject* batch ) ;
+      // ======================================================================
     private:
       // ======================================================================
       // python partner
       PyObject*    m_function  { nullptr } ; // python partner
       PyObject*    m_arguments { nullptr } ; // argument cache
+      // batch callable 
+      PyObject*    m_batch     { nullptr } ; // batch callable 
       /// all variables as list of variables 
       RooListProxy m_varlist   {} ; // all variables as list of variables 
       // ======================================================================  
@@ -7,6 +7,8 @@
 //  STD & STL 
 // ============================================================================
 #include <memory>
+#include <vector>
+#include <string>
 // ============================================================================
 // ROOT 
 // ============================================================================
@@ -27,6 +29,18 @@ namespace Ostap
   class Formula ;
   // ==========================================================================
   /** @class PySelectorWithCuts Ostap/PySelectorWithCuts.h
+   *  Selector that runs only for "good" entries 
+   *
+   *  Optionally it works in the "block mode": the expressions 
+   *  are evaluated by C++ for good entries and accumulated in the 
+   *  column buffers, and the (python) method <code>process_block</code> 
+   *  is invoked once per block instead of <code>process_entry</code>
+   *  for each entry 
+   *  @code
+   *  ... def process_block ( self ) :
+   *  ...     n = self.block_rows () 
+   *  ...     x = numpy.frombuffer ( self.block_column ( 0 ).data () , count = n ) 
+   *  @endcode 
    *  @author Vanya Belyaev
    *  @date   2013-05-06
    */
@@ -35,7 +49,7 @@ namespace Ostap
     // ========================================================================
   public:
     // ========================================================================
-    ClassDefOverride (Ostap::SelectorWithCuts , 2) ;
+    ClassDefOverride (Ostap::SelectorWithCuts , 3) ;
     // ========================================================================
   public:
     // ========================================================================
@@ -100,6 +114,49 @@ namespace Ostap
     /// process a good entry
     bool process_entry () override ;
     // ========================================================================
+  public: // block mode 
+    // ========================================================================
+    /** switch on the block mode 
+     *  @param expressions the expressions to be evaluated for good entries 
+     *  @param size        the size of the block 
+     */
+    void set_block 
+    ( const std::vector<std::string>& expressions     , 
+      const unsigned long             size    = 10000 ) ;
+    /// switch off the block mode 
+    void reset_block () ;
+    // ========================================================================
+    /// block mode ?
+    bool               block_mode    () const { return 0 < m_block_size ; }
+    /// the (maximal) size of the block
+    unsigned long      block_size    () const { return m_block_size ; }
+    /// number of accumulated rows in the current block 
+    unsigned long      block_rows    () const { return m_block_rows ; }
+    /// number of columns 
+    unsigned short     block_columns () const { return m_block_exprs.size () ; }
+    /// expression for the column 
+    const std::string& block_expression ( const unsigned short index ) const ;
+    /// values of the column for the current block 
+    const std::vector<double>& block_column ( const unsigned short index ) const ;
+    // ========================================================================
+    /** process the accumulated block
+     *  - to be redefined (e.g. in python)
+     *  @see Ostap::SelectorWithCuts::block_rows 
+     *  @see Ostap::SelectorWithCuts::block_column 
+     */
+    virtual bool process_block () ;
+    /// process the accumulated rows (if any) and clear the block 
+    bool flush_block  () ;
+    /// notify the block formulas (e.g. new tree in the chain)
+    bool notify_block () ;
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// create formulas for the block mode 
+    bool make_block   ( TTree* tree ) ;
+    /// add the good entry to the block 
+    bool fill_block   () ;
+    // ========================================================================
   public:
     // ========================================================================    
     /// set new cuts 
@@ -129,6 +186,17 @@ namespace Ostap
     std::unique_ptr<Ostap::Formula>    fMyFormula ;
     /// event counter 
     unsigned long long  m_good  { 0 } ; // event counter: useless for PROOF
+    // ========================================================================
+    /// expressions for the block mode 
+    std::vector<std::string>                     m_block_exprs    {}  ; 
+    /// formulas for the block mode 
+    std::vector<std::unique_ptr<Ostap::Formula> > m_block_formulas {}  ;
+    /// column buffers for the block mode 
+    std::vector<std::vector<double> >            m_block_data     {}  ;
+    /// the (maximal) size of the block 
+    unsigned long                                m_block_size     { 0 } ; 
+    /// number of accumulated rows 
+    unsigned long                                m_block_rows     { 0 } ;
     // ========================================================================    
   };
   // ==========================================================================
@@ -0,0 +1,187 @@
+// ============================================================================
+#ifndef OSTAP_RANDOMSTREAM_H
+#define OSTAP_RANDOMSTREAM_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <array>
+#include <vector>
+#include <cstdint>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/ValueWithError.h"
+// ============================================================================
+/** @file Ostap/RandomStream.h
+ *  Counter-based random number streams (Philox4x32-10)
+ *  @see Ostap::Math::Philox
+ *  @see Ostap::Math::RandomStream
+ *  @see J.K. Salmon, M.A. Moraes, R.O. Dror, D.E. Shaw,
+ *       "Parallel random numbers: as easy as 1, 2, 3",
+ *       SC'11, https://doi.org/10.1145/2063384.2063405
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class Philox Ostap/RandomStream.h
+     *  Philox4x32-10 counter-based bijection:
+     *  the output is the function of the key and the counter only,
+     *  therefore any element of the sequence is accessible directly,
+     *  and independent streams are obtained just by different keys
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class Philox
+    {
+    public:
+      // ======================================================================
+      typedef std::array<std::uint32_t,4> Counter ;
+      typedef std::array<std::uint32_t,2> Key     ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the Philox4x32-10 block function
+      static Counter block ( Counter counter , Key key ) ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class RandomStream Ostap/RandomStream.h
+     *  Reproducible stream of random numbers based on Philox4x32-10.
+     *  The stream is defined by the seed and the stream (substream) number,
+     *  e.g. the job identifier for parallel processing:
+     *  the streams with different numbers do not overlap
+     *  and the sequence does not depend on the scheduling.
+     *
+     *  The numbers are consumed sequentially from the counter,
+     *  the array fills are the preferred interface:
+     *  @code
+     *  RandomStream rs ( 12345 , jobid ) ;
+     *  std::vector<double> v ( 1000 ) ;
+     *  rs.fill_gauss ( v.size() , v.data() , 0 , 1 ) ;
+     *  @endcode
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class RandomStream
+    {
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param seed   the seed
+       *  @param stream the stream/substream number (e.g. jobid)
+       */
+      RandomStream
+      ( const std::uint64_t seed   = 0 ,
+        const std::uint64_t stream = 0 ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// get the independent substream with the same seed
+      RandomStream  substream ( const std::uint64_t stream ) const
+      { return RandomStream ( m_seed , stream ) ; }
+      // ======================================================================
+      std::uint64_t seed     () const { return m_seed     ; }
+      std::uint64_t stream   () const { return m_stream   ; }
+      /// number of consumed 32-bit words
+      std::uint64_t position () const { return 4 * m_counter - ( 4 - m_index ) ; }
+      /// skip the words: set the position to the given value
+      void          seek     ( const std::uint64_t position ) ;
+      /// reset the stream to the beginning
+      void          reset    () { seek ( 0 ) ; }
+      // ======================================================================
+    public: // scalar interface
+      // ======================================================================
+      /// next 32-bit word
+      std::uint32_t next32   () ;
+      /// uniform in (0,1), 53 bits of precision
+      double uniform   () ;
+      /// uniform in (low,high)
+      double uniform   ( const double low , const double high )
+      { return low + ( high - low ) * uniform () ; }
+      /// gaussian
+      double gauss     ( const double mu = 0 , const double sigma = 1 ) ;
+      /// gaussian using the value with error
+      double gauss     ( const Ostap::Math::ValueWithError& value )
+      { return gauss ( value.value () , value.error () ) ; }
+      /// bifurcated gaussian
+      double bifur     ( const double mu , const double sigma1 , const double sigma2 ) ;
+      /// poisson
+      unsigned long poisson ( const double mu ) ;
+      // ======================================================================
+    public: // array interface
+      // ======================================================================
+      void fill_uniform
+      ( const std::size_t n        ,
+        double*           out      ,
+        const double      low  = 0 ,
+        const double      high = 1 ) ;
+      void fill_gauss
+      ( const std::size_t n         ,
+        double*           out       ,
+        const double      mu    = 0 ,
+        const double      sigma = 1 ) ;
+      void fill_gauss
+      ( const std::size_t                  n     ,
+        double*                            out   ,
+        const Ostap::Math::ValueWithError& value )
+      { fill_gauss ( n , out , value.value () , value.error () ) ; }
+      void fill_bifur
+      ( const std::size_t n      ,
+        double*           out    ,
+        const double      mu     ,
+        const double      sigma1 ,
+        const double      sigma2 ) ;
+      void fill_poisson
+      ( const std::size_t n      ,
+        double*           out    ,
+        const double      mu     ) ;
+      // ======================================================================
+    public: // vector interface (e.g. for python)
+      // ======================================================================
+      std::vector<double> uniforms
+      ( const std::size_t n , const double low = 0 , const double high = 1 ) ;
+      std::vector<double> gausses
+      ( const std::size_t n , const double mu  = 0 , const double sigma = 1 ) ;
+      std::vector<double> gausses
+      ( const std::size_t n , const Ostap::Math::ValueWithError& value )
+      { return gausses ( n , value.value () , value.error () ) ; }
+      std::vector<double> bifurs
+      ( const std::size_t n , const double mu , const double sigma1 , const double sigma2 ) ;
+      std::vector<double> poissons
+      ( const std::size_t n , const double mu ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// refill the buffer
+      void refill () ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      std::uint64_t   m_seed    { 0 } ;
+      std::uint64_t   m_stream  { 0 } ;
+      Philox::Key     m_key     {   } ;
+      /// the block counter
+      std::uint64_t   m_counter { 0 } ;
+      /// the current block
+      Philox::Counter m_buffer  {   } ;
+      /// index in the current block
+      unsigned int    m_index   { 4 } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_RANDOMSTREAM_H
+// ============================================================================
@@ -0,0 +1,349 @@
+// ============================================================================
+#ifndef OSTAP_REWEIGHTER_H
+#define OSTAP_REWEIGHTER_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <array>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TObject.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/IFuncs.h"
+#include "Ostap/StatusCode.h"
+#include "Ostap/HistoInterpolation.h"
+#include "Ostap/HistoInterpolators.h"
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class TH1        ; // ROOT
+class TTree      ; // ROOT
+class RooAbsData ; // RooFit
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  class Formula    ;
+  class FormulaVar ;
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class Reweighter Ostap/Reweighter.h
+     *  The native engine for the histogram-based reweighting:
+     *  the event weight is a product of the interpolated histogram values
+     *  \f$ w = \prod_i h_i \left( x_i, y_i, z_i \right) \f$
+     *  - each factor is a 1D,2D or 3D histogram with the expressions
+     *    for its axes and the interpolation types
+     *  - the expressions are shared between factors and plots
+     *  - the "plots" (histograms with expressions and additional
+     *    selection/weight) can be filled with the current weight in
+     *    the same (multithreaded) event loop, see Reweighter::project,
+     *    that makes each reweighting iteration one pass over data
+     *  @code
+     *  Ostap::Utils::Reweighter rw ;
+     *  rw.add     ( hpt  , "pt" ) ;
+     *  rw.add     ( hpe  , "pt" , "eta" ) ;
+     *  rw.addPlot ( &hmc , "pt" ) ;
+     *  rw.project ( tree , 0 ) ; ## fill hmc with the current weights
+     *  @endcode
+     *  @see Ostap::Math::Histo1D
+     *  @see Ostap::Math::Histo2D
+     *  @see Ostap::Math::Histo3D
+     *  @see Ostap::Functions::FuncReweight
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-03-15
+     */
+    class Reweighter
+    {
+    public:
+      // ======================================================================
+      /// the invalid index
+      static const unsigned short s_NONE = std::numeric_limits<unsigned short>::max () ;
+      // ======================================================================
+      /** @struct Plot
+       *  the histogram to be filled with the current weight
+       */
+      struct Plot
+      {
+        /// the histogram (not owned)
+        TH1*                          histo { nullptr } ;
+        /// histogram dimension
+        unsigned short                dim   { 0 } ;
+        /// indices of the expressions for the axes
+        std::array<unsigned short,3>  vars  {{ s_NONE , s_NONE , s_NONE }} ;
+        /// index of the additional selection/weight
+        unsigned short                cuts  { s_NONE } ;
+      } ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// default constructor
+      Reweighter () = default ;
+      // ======================================================================
+    public: // weighting factors
+      // ======================================================================
+      /** add 1D-factor
+       *  @param histo       (INPUT) the histogram
+       *  @param xvar        (INPUT) the expression for x-axis
+       *  @param tx          (INPUT) interpolation type
+       *  @param edges       (INPUT) special treatment of edges?
+       *  @param extrapolate (INPUT) use extrapolation?
+       *  @param density     (INPUT) use density?
+       *  @return number of factors
+       */
+      std::size_t add
+      ( const TH1&         histo                   ,
+        const std::string& xvar                    ,
+        const Ostap::Math::HistoInterpolation::Type tx =
+        Ostap::Math::HistoInterpolation::Default   ,
+        const bool         edges       = true      ,
+        const bool         extrapolate = false     ,
+        const bool         density     = false     ) ;
+      // ======================================================================
+      /** add 2D-factor
+       *  @param histo       (INPUT) the histogram
+       *  @param xvar        (INPUT) the expression for x-axis
+       *  @param yvar        (INPUT) the expression for y-axis
+       *  @param tx          (INPUT) interpolation type for x-axis
+       *  @param ty          (INPUT) interpolation type for y-axis
+       *  @param edges       (INPUT) special treatment of edges?
+       *  @param extrapolate (INPUT) use extrapolation?
+       *  @param density     (INPUT) use density?
+       *  @return number of factors
+       */
+      std::size_t add
+      ( const TH2&         histo                   ,
+        const std::string& xvar                    ,
+        const std::string& yvar                    ,
+        const Ostap::Math::HistoInterpolation::Type tx =
+        Ostap::Math::HistoInterpolation::Default   ,
+        const Ostap::Math::HistoInterpolation::Type ty =
+        Ostap::Math::HistoInterpolation::Default   ,
+        const bool         edges       = true      ,
+        const bool         extrapolate = false     ,
+        const bool         density     = false     ) ;
+      // ======================================================================
+      /** add 3D-factor
+       *  @param histo       (INPUT) the histogram
+       *  @param xvar        (INPUT) the expression for x-axis
+       *  @param yvar        (INPUT) the expression for y-axis
+       *  @param zvar        (INPUT) the expression for z-axis
+       *  @param tx          (INPUT) interpolation type for x-axis
+       *  @param ty          (INPUT) interpolation type for y-axis
+       *  @param tz          (INPUT) interpolation type for z-axis
+       *  @param edges       (INPUT) special treatment of edges?
+       *  @param extrapolate (INPUT) use extrapolation?
+       *  @param density     (INPUT) use density?
+       *  @return number of factors
+       */
+      std::size_t add
+      ( const TH3&         histo                   ,
+        const std::string& xvar                    ,
+        const std::string& yvar                    ,
+        const std::string& zvar                    ,
+        const Ostap::Math::HistoInterpolation::Type tx =
+        Ostap::Math::HistoInterpolation::Default   ,
+        const Ostap::Math::HistoInterpolation::Type ty =
+        Ostap::Math::HistoInterpolation::Default   ,
+        const Ostap::Math::HistoInterpolation::Type tz =
+        Ostap::Math::HistoInterpolation::Default   ,
+        const bool         edges       = true      ,
+        const bool         extrapolate = false     ,
+        const bool         density     = false     ) ;
+      // ======================================================================
+      /// add 1D-factor
+      std::size_t add
+      ( const Ostap::Math::Histo1D& histo ,
+        const std::string&          xvar  ) ;
+      /// add 2D-factor
+      std::size_t add
+      ( const Ostap::Math::Histo2D& histo ,
+        const std::string&          xvar  ,
+        const std::string&          yvar  ) ;
+      /// add 3D-factor
+      std::size_t add
+      ( const Ostap::Math::Histo3D& histo ,
+        const std::string&          xvar  ,
+        const std::string&          yvar  ,
+        const std::string&          zvar  ) ;
+      // ======================================================================
+    public: // plots
+      // ======================================================================
+      /** add the plot to be filled with the current weight, see Reweighter::project
+       *  @param histo     (INPUT) the histogram (not owned!)
+       *  @param xvar      (INPUT) the expression for x-axis
+       *  @param yvar      (INPUT) the expression for y-axis (2D and 3D histograms)
+       *  @param zvar      (INPUT) the expression for z-axis (3D histograms)
+       *  @param selection (INPUT) additional selection/weight
+       *  @return number of plots
+       */
+      std::size_t addPlot
+      ( TH1*               histo          ,
+        const std::string& xvar           ,
+        const std::string& yvar      = "" ,
+        const std::string& zvar      = "" ,
+        const std::string& selection = "" ) ;
+      /// remove all plots
+      void clearPlots () { m_plots.clear () ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** fill all plots with the current weights in one pass over the tree
+       *  - histograms are reset
+       *  - for the multithreaded processing each chunk is filled into
+       *    the private clones of the histograms, that are merged at the end
+       *  @param tree     (INPUT) the tree
+       *  @param nthreads (INPUT) number of threads
+       *                  (0: use the size of ROOT MT pool or hardware concurrency)
+       *  @param first    (INPUT) the first event to process
+       *  @param last     (INPUT) the last event to process
+       */
+      Ostap::StatusCode project
+      ( TTree*              tree         ,
+        const unsigned int  nthreads = 1 ,
+        const unsigned long first    = 0 ,
+        const unsigned long last     = std::numeric_limits<unsigned long>::max() ) const ;
+      // ======================================================================
+      /** fill all plots with the current weights in one pass over the dataset
+       *  (the dataset weight is taken into account)
+       *  @param data  (INPUT) the dataset
+       *  @param first (INPUT) the first event to process
+       *  @param last  (INPUT) the last event to process
+       */
+      Ostap::StatusCode project
+      ( const RooAbsData*   data      ,
+        const unsigned long first = 0 ,
+        const unsigned long last  = std::numeric_limits<unsigned long>::max() ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** get the weight for the values of the expressions
+       *  @param values (INPUT) the values of expressions, <code>expressions().size()</code>
+       */
+      double weight ( const double* values ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the expressions
+      const std::vector<std::string>& expressions () const { return m_expressions ; }
+      /// the plots
+      const std::vector<Plot>&        plots       () const { return m_plots       ; }
+      /// number of weighting factors
+      std::size_t nFactors () const
+      { return m_h1.size () + m_h2.size () + m_h3.size () ; }
+      /// number of plots
+      std::size_t nPlots   () const { return m_plots.size () ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// get the index of the expression (add it, if needed)
+      unsigned short index ( const std::string& expression ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the expressions
+      std::vector<std::string> m_expressions {} ;
+      /// 1D-factors
+      std::vector<std::pair<Ostap::Math::Histo1D,std::array<unsigned short,1> > > m_h1 {} ;
+      /// 2D-factors
+      std::vector<std::pair<Ostap::Math::Histo2D,std::array<unsigned short,2> > > m_h2 {} ;
+      /// 3D-factors
+      std::vector<std::pair<Ostap::Math::Histo3D,std::array<unsigned short,3> > > m_h3 {} ;
+      /// plots
+      std::vector<Plot>        m_plots       {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+  namespace Functions
+  {
+    // ========================================================================
+    /** @class FuncReweight Ostap/Reweighter.h
+     *  The weight from Ostap::Utils::Reweighter as function of
+     *  <code>TTree</code> or <code>RooAbsData</code> entry
+     *  @code
+     *  Ostap::Utils::Reweighter rw ;
+     *  rw.add ( hpt , "pt" ) ;
+     *  Ostap::Functions::FuncReweight W ( rw ) ;
+     *  Ostap::Trees::add_branch ( tree , "weight" , W ) ;
+     *  @endcode
+     *  @see Ostap::Utils::Reweighter
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-03-15
+     */
+    class FuncReweight
+      : public Ostap::IFuncTree
+      , public Ostap::IFuncData
+      , public TObject
+    {
+    public :
+      // ======================================================================
+      ClassDefOverride(Ostap::Functions::FuncReweight,1) ;
+      // ======================================================================
+    public :
+      // ======================================================================
+      /// constructor from the reweighter
+      FuncReweight ( const Ostap::Utils::Reweighter& reweighter ) ;
+      /// copy constructor
+      FuncReweight ( const FuncReweight& right ) ;
+      /// default constructor, needed for serialization
+      FuncReweight () = default ;
+      /// destructor
+      virtual ~FuncReweight () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      FuncReweight* Clone ( const char* newname = "" ) const override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// evaluate the weight for TTree
+      double operator() ( const TTree*      tree ) const override ;
+      /// evaluate the weight for RooAbsData
+      double operator() ( const RooAbsData* data ) const override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      Bool_t Notify () override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the reweighter
+      const Ostap::Utils::Reweighter& reweighter () const { return m_reweighter ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the reweighter
+      Ostap::Utils::Reweighter                           m_reweighter {}  ;
+      /// the current tree
+      mutable const TTree*                               m_tree     { nullptr } ; //!
+      /// formulas for the expressions
+      mutable std::vector<std::unique_ptr<Ostap::Formula> >    m_formulas {} ; //!
+      /// the current dataset
+      mutable const RooAbsData*                          m_data     { nullptr } ; //!
+      /// formulas for the expressions (dataset)
+      mutable std::vector<std::unique_ptr<Ostap::FormulaVar> > m_vars   {} ; //!
+      /// the values of the expressions
+      mutable std::vector<double>                        m_values   {} ; //!
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                    The end of namespace Ostap::Functions
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_REWEIGHTER_H
+// ============================================================================
@@ -0,0 +1,249 @@
+// ============================================================================
+#ifndef OSTAP_SWEIGHTS_H
+#define OSTAP_SWEIGHTS_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <memory>
+#include <string>
+#include <vector>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "TObject.h"
+#include "RooArgList.h"
+#include "RooArgSet.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/IFuncs.h"
+#include "Ostap/StatusCode.h"
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class TTree       ; // ROOT
+class RooAbsData  ; // RooFit
+class RooRealVar  ; // RooFit
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  class Formula ;
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class SWeights Ostap/SWeights.h
+     *  The engine to calculate sWeights
+     *  \f$ w_i(x) = \frac{ \sum_j V_{ij} f_j(x) }{ \sum_k N_k f_k (x) } \f$,
+     *  where the inverse covariance matrix of yields is
+     *  \f$ V^{-1}_{ij} = \sum_e \frac{ f_i(x_e) f_j(x_e) }{ \left( \sum_k N_k f_k (x_e) \right)^2 } \f$
+     *  - the component PDFs are evaluated for all entries in one pass
+     *    (in several threads for TTree), and the covariance matrix is inverted once
+     *  - the sWeights as functions of <code>TTree</code>/<code>RooAbsData</code>
+     *    entries are provided by Ostap::Functions::FuncSWeight, that can be used
+     *    with Ostap::Trees::add_branch and Ostap::Functions::add_var
+     *  @see M.Pivk, F.R. Le Deberder,
+     *      "SPlot: A Statistical tool to unfold data distributions"
+     *       Published in Nucl.Instrum.Meth. A555 (2005) 356
+     *  @see http://arxiv.org/abs/physics/0402083
+     *  @see RooStats::SPlot
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-03-14
+     */
+    class SWeights
+    {
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param pdfs        the component PDFs
+       *  @param observables the observables
+       *  @param yields      the yields of components
+       */
+      SWeights
+      ( const RooArgList&          pdfs        ,
+        const RooArgSet&           observables ,
+        const std::vector<double>& yields      ) ;
+      /// default constructor
+      SWeights () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** calculate the covariance matrix for the dataset
+       *  (the event weights are taken into account)
+       *  @param data the dataset
+       */
+      Ostap::StatusCode fill
+      ( const RooAbsData&   data         ) ;
+      // ======================================================================
+      /** calculate the covariance matrix for the tree
+       *  @param tree     the tree
+       *  @param nthreads the number of threads
+       *                  (0: the size of ROOT MT pool or hardware concurrency)
+       */
+      Ostap::StatusCode fill
+      ( const TTree*        tree         ,
+        const unsigned int  nthreads = 1 ) ;
+      // ======================================================================
+      /** calculate the covariance matrix for the component densities
+       *  @param n         the number of entries
+       *  @param densities the component densities, <code>n*size()</code>, entry by entry
+       *  @param weights   event weights (optional)
+       */
+      Ostap::StatusCode fill
+      ( const std::size_t   n                    ,
+        const double*       densities            ,
+        const double*       weights    = nullptr ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of components
+      std::size_t   size    () const { return m_yields.size () ; }
+      /// sum of event weights for the last fill
+      double        sumw    () const { return m_sumw    ; }
+      /// number of entries for the last fill
+      unsigned long entries () const { return m_entries ; }
+      /// is the covariance matrix calculated ?
+      bool          ok      () const { return m_ok      ; }
+      /// the yields
+      const std::vector<double>& yields () const { return m_yields ; }
+      /// the element of the covariance matrix
+      double        cov2    ( const unsigned short i ,
+                              const unsigned short j ) const
+      { return m_cov [ i * size () + j ] ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** calculate sWeights for the given component densities
+       *  @param densities (INPUT)  the component densities, <code>size()</code>
+       *  @param result    (OUTPUT) sWeights, <code>size()</code>
+       */
+      void weights
+      ( const double* densities ,
+        double*       result    ) const ;
+      // ======================================================================
+      /** calculate the component densities for the current values of observables
+       *  @param result (OUTPUT) the densities, <code>size()</code>
+       */
+      void densities ( double* result ) const ;
+      // ======================================================================
+      /// the component PDFs
+      const RooArgList& pdfs        () const { return m_pdfs        ; }
+      /// the observables
+      const RooArgSet&  observables () const { return m_observables ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the component PDFs
+      RooArgList          m_pdfs        {} ;
+      /// the observables
+      RooArgSet           m_observables {} ;
+      /// the yields
+      std::vector<double> m_yields      {} ;
+      /// the covariance matrix
+      std::vector<double> m_cov         {} ;
+      /// sum of event weights
+      double              m_sumw        { 0 } ;
+      /// number of entries
+      unsigned long       m_entries     { 0 } ;
+      /// is the covariance matrix calculated ?
+      bool                m_ok          { false } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+  namespace Functions
+  {
+    // ========================================================================
+    /** @class FuncSWeight Ostap/SWeights.h
+     *  sWeight for the component as a function of
+     *  <code>TTree</code> or <code>RooAbsData</code> entry
+     *  @code
+     *  Ostap::Utils::SWeights sw ( pdfs , observables , yields ) ;
+     *  sw.fill ( dataset ) ;
+     *  Ostap::Functions::FuncSWeight S ( sw , 0 ) ;
+     *  Ostap::Functions::add_var ( dataset , "S_sw" , S ) ;
+     *  @endcode
+     *  The observables are read from the tree by names
+     *  @see Ostap::Utils::SWeights
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-03-14
+     */
+    class FuncSWeight
+      : public Ostap::IFuncTree
+      , public Ostap::IFuncData
+      , public TObject
+    {
+    public :
+      // ======================================================================
+      ClassDefOverride(Ostap::Functions::FuncSWeight,1) ;
+      // ======================================================================
+    public :
+      // ======================================================================
+      /** constructor
+       *  @param sweights the engine (with calculated covariance matrix)
+       *  @param index    the component
+       */
+      FuncSWeight
+      ( const Ostap::Utils::SWeights& sweights ,
+        const unsigned short          index    ) ;
+      /// copy constructor
+      FuncSWeight ( const FuncSWeight& right ) ;
+      /// default constructor, needed for serialization
+      FuncSWeight () = default ;
+      /// destructor
+      virtual ~FuncSWeight () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      FuncSWeight* Clone ( const char* newname = "" ) const override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// evaluate sWeight for TTree
+      double operator() ( const TTree*      tree ) const override ;
+      /// evaluate sWeight for RooAbsData
+      double operator() ( const RooAbsData* data ) const override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      Bool_t Notify () override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the component
+      unsigned short                index    () const { return m_index    ; }
+      /// the engine
+      const Ostap::Utils::SWeights& sweights () const { return m_sweights ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// sWeight for the current values of observables
+      double sweight () const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the engine
+      Ostap::Utils::SWeights                        m_sweights {}        ;
+      /// the component
+      unsigned short                                m_index    { 0 }     ;
+      /// the current tree
+      mutable const TTree*                          m_tree     { nullptr } ; //!
+      /// formulas for the observables
+      mutable std::vector<std::unique_ptr<Ostap::Formula> > m_formulas {} ; //!
+      /// the observables (as RooRealVar)
+      mutable std::vector<RooRealVar*>              m_vars     {}        ; //!
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                    The end of namespace Ostap::Functions
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_SWEIGHTS_H
+// ============================================================================
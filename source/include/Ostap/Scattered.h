@@ -0,0 +1,255 @@
+// ============================================================================
+#ifndef OSTAP_SCATTERED_H
+#define OSTAP_SCATTERED_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstddef>
+#include <utility>
+#include <vector>
+// ============================================================================
+/** @file Ostap/Scattered.h
+ *  Interpolation of the scattered data in 2D and 3D
+ *
+ *  Modified Shepard's method with the local linear nodal functions:
+ *  \f[ f(\mathbf{x}) = \frac{ \sum_i w_i(\mathbf{x}) Q_i(\mathbf{x}) }
+ *                           { \sum_i w_i(\mathbf{x}) } , \quad
+ *      w_i = \left( \frac{ R - d_i }{ R d_i } \right)^2 , \quad
+ *      Q_i(\mathbf{x}) = f_i + \mathbf{g}_i \cdot \left( \mathbf{x} - \mathbf{x}_i \right) \f]
+ *  where the sum runs over the nearest neighbours of the point
+ *  and \f$ R \f$ is the distance to the most distant of them.
+ *
+ *  - the nodal gradients \f$ \mathbf{g}_i \f$ are precomputed by the
+ *    weighted least-squares fit over the nearest neighbours of each data point
+ *  - the nearest neighbours are found with the static k-d tree
+ *  - the interpolation reproduces the data points and the linear functions
+ *
+ *  @see R.J.Renka, "Multivariate interpolation of large sets of scattered data",
+ *       ACM Trans. Math. Software 14 (1988) 139
+ *  @see https://en.wikipedia.org/wiki/Inverse_distance_weighting
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class Scattered Ostap/Scattered.h
+     *  Interpolation of the scattered data in arbitrary dimension
+     *  (modified Shepard's method with local linear nodal functions)
+     *  @see Ostap::Math::Scattered2D
+     *  @see Ostap::Math::Scattered3D
+     */
+    class Scattered
+    {
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param points (INPUT) the data points, stored row-wise
+       *  @param values (INPUT) the values at data points
+       *  @param dim    (INPUT) the dimension
+       *  @param nw     (INPUT) number of neighbours for interpolation (0: default)
+       *  @param nq     (INPUT) number of neighbours for the nodal functions (0: default)
+       */
+      Scattered
+      ( const std::vector<double>& points     ,
+        const std::vector<double>& values     ,
+        const unsigned short       dim        ,
+        const unsigned short       nw     = 0 ,
+        const unsigned short       nq     = 0 ) ;
+      /// default constructor
+      Scattered () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// evaluate the interpolation at the point
+      double evaluate ( const double* x ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the dimension
+      unsigned short dim   () const { return m_dim    ; }
+      /// number of data points
+      std::size_t    size  () const { return m_values.size () ; }
+      /// number of neighbours used for interpolation
+      unsigned short nw    () const { return m_nw     ; }
+      /// number of neighbours used for the nodal functions
+      unsigned short nq    () const { return m_nq     ; }
+      /// the data point
+      const double*  point ( const std::size_t i ) const
+      { return m_points.data () + i * m_dim ; }
+      /// the value at the data point
+      double         value ( const std::size_t i ) const { return m_values [ i ] ; }
+      /// the gradient of the nodal function
+      const double*  gradient ( const std::size_t i ) const
+      { return m_grads.data () + i * m_dim ; }
+      // ======================================================================
+    protected:
+      // ======================================================================
+      /** find k nearest neighbours
+       *  @param q (INPUT)  the query point
+       *  @param k (INPUT)  number of neighbours
+       *  @param nn (OUTPUT) (squared distance,index) pairs, sorted
+       */
+      void nearest
+      ( const double*                               q  ,
+        const std::size_t                           k  ,
+        std::vector<std::pair<double,std::size_t> >& nn ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// build the tree for the range [lo,hi)
+      void build  ( const std::size_t lo , const std::size_t hi ) ;
+      /// search the nearest neighbours in the range [lo,hi)
+      void search
+      ( const std::size_t                            lo ,
+        const std::size_t                            hi ,
+        const double*                                q  ,
+        const std::size_t                            k  ,
+        std::vector<std::pair<double,std::size_t> >& nn ) const ;
+      /// squared distance between the query and data point
+      double dist2 ( const double* q , const std::size_t i ) const ;
+      /// precompute the gradients of the nodal functions
+      void gradients () ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the dimension
+      unsigned short              m_dim    { 0 } ;
+      /// number of neighbours for interpolation
+      unsigned short              m_nw     { 0 } ;
+      /// number of neighbours for the nodal functions
+      unsigned short              m_nq     { 0 } ;
+      /// data points (row-wise)
+      std::vector<double>         m_points {} ;
+      /// values
+      std::vector<double>         m_values {} ;
+      /// gradients of the nodal functions (row-wise)
+      std::vector<double>         m_grads  {} ;
+      /// k-d tree: permutation of points
+      std::vector<std::size_t>    m_index  {} ;
+      /// k-d tree: split dimensions
+      std::vector<unsigned short> m_split  {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class Scattered2D Ostap/Scattered.h
+     *  Interpolation of the scattered data in 2D
+     *  @code
+     *  std::vector<double> x = ... , y = ... , v = ... ;
+     *  Ostap::Math::Scattered2D calib ( x , y , v ) ;
+     *  double value = calib ( 1.0 , 2.0 ) ;
+     *  @endcode
+     *  It can be used as <code>Ostap::IFuncTree</code> via
+     *  <code>Ostap::Functions::Func2D ( calib , "pt" , "eta" )</code>
+     *  @see Ostap::Math::Scattered
+     */
+    class Scattered2D : public Scattered
+    {
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param x      (INPUT) x-coordinates of data points
+       *  @param y      (INPUT) y-coordinates of data points
+       *  @param values (INPUT) the values at data points
+       *  @param nw     (INPUT) number of neighbours for interpolation (0: default)
+       *  @param nq     (INPUT) number of neighbours for the nodal functions (0: default)
+       */
+      Scattered2D
+      ( const std::vector<double>& x          ,
+        const std::vector<double>& y          ,
+        const std::vector<double>& values     ,
+        const unsigned short       nw     = 0 ,
+        const unsigned short       nq     = 0 ) ;
+      /// default constructor
+      Scattered2D () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the main method
+      double operator () ( const double x , const double y ) const
+      { return evaluate ( x , y ) ; }
+      /// the main method
+      double evaluate    ( const double x , const double y ) const
+      { const double q [ 2 ] = { x , y } ; return Scattered::evaluate ( q ) ; }
+      // ======================================================================
+      /** evaluate the interpolation for the arrays of points
+       *  @param n      (INPUT)  number of points
+       *  @param x      (INPUT)  x-coordinates
+       *  @param y      (INPUT)  y-coordinates
+       *  @param result (UPDATE) the results
+       */
+      void evaluate
+      ( const std::size_t n      ,
+        const double*     x      ,
+        const double*     y      ,
+        double*           result ) const ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class Scattered3D Ostap/Scattered.h
+     *  Interpolation of the scattered data in 3D
+     *  It can be used as <code>Ostap::IFuncTree</code> via
+     *  <code>Ostap::Functions::Func3D ( calib , "x" , "y" , "z" )</code>
+     *  @see Ostap::Math::Scattered
+     */
+    class Scattered3D : public Scattered
+    {
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param x      (INPUT) x-coordinates of data points
+       *  @param y      (INPUT) y-coordinates of data points
+       *  @param z      (INPUT) z-coordinates of data points
+       *  @param values (INPUT) the values at data points
+       *  @param nw     (INPUT) number of neighbours for interpolation (0: default)
+       *  @param nq     (INPUT) number of neighbours for the nodal functions (0: default)
+       */
+      Scattered3D
+      ( const std::vector<double>& x          ,
+        const std::vector<double>& y          ,
+        const std::vector<double>& z          ,
+        const std::vector<double>& values     ,
+        const unsigned short       nw     = 0 ,
+        const unsigned short       nq     = 0 ) ;
+      /// default constructor
+      Scattered3D () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// the main method
+      double operator () ( const double x , const double y , const double z ) const
+      { return evaluate ( x , y , z ) ; }
+      /// the main method
+      double evaluate    ( const double x , const double y , const double z ) const
+      { const double q [ 3 ] = { x , y , z } ; return Scattered::evaluate ( q ) ; }
+      // ======================================================================
+      /** evaluate the interpolation for the arrays of points
+       *  @param n      (INPUT)  number of points
+       *  @param x      (INPUT)  x-coordinates
+       *  @param y      (INPUT)  y-coordinates
+       *  @param z      (INPUT)  z-coordinates
+       *  @param result (UPDATE) the results
+       */
+      void evaluate
+      ( const std::size_t n      ,
+        const double*     x      ,
+        const double*     y      ,
+        const double*     z      ,
+        double*           result ) const ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // OSTAP_SCATTERED_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
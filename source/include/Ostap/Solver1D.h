@@ -0,0 +1,302 @@
+// ============================================================================
+#ifndef OSTAP_SOLVER1D_H
+#define OSTAP_SOLVER1D_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class Solver1D Ostap/Solver1D.h
+     *  Native root-finding and minimization for 1D-functions
+     *  - Brent's root finder
+     *  - safeguarded Halley/Newton's root finder
+     *  - Brent's bounded minimization (golden section + parabolic interpolation)
+     *  - mode, width (FWHM) and quantiles of distributions
+     *
+     *  The functions are C++ functors (e.g. <code>Ostap::Math</code> shapes),
+     *  therefore the summary statistics for the shapes are calculated
+     *  without per-iteration python calls
+     *  @see https://en.wikipedia.org/wiki/Brent%27s_method
+     *  @see https://en.wikipedia.org/wiki/Halley%27s_method
+     *  @see R.P.Brent, "Algorithms for Minimization without Derivatives", 1973
+     *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+     *  @date 2026-10-15
+     */
+    class Solver1D
+    {
+    public:
+      // ======================================================================
+      typedef std::function<double(double)> function1 ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** find the root of the function using Brent's method
+       *  @param f    the function
+       *  @param a    low edge of the bracketing interval
+       *  @param b    high edge of the bracketing interval
+       *  @param xtol absolute tolerance
+       *  @param rtol relative tolerance
+       *  @param maxiter maximal number of iterations
+       *  @return the root
+       *  @attention <code>f(a)</code> and <code>f(b)</code> must have different signs
+       */
+      template <class FUNCTION1>
+      static inline double root
+      ( FUNCTION1            f                ,
+        const double         a                ,
+        const double         b                ,
+        const double         xtol    = 1.e-14 ,
+        const double         rtol    = 1.e-14 ,
+        const unsigned short maxiter = 100    )
+      { return root_ ( std::cref ( f ) , a , b , xtol , rtol , maxiter ) ; }
+      // ======================================================================
+      /** solve the equation \f$ f(x) = C \f$ using Brent's method
+       *  @param f    the function
+       *  @param C    the value
+       *  @param a    low edge of the bracketing interval
+       *  @param b    high edge of the bracketing interval
+       *  @return the solution
+       */
+      template <class FUNCTION1>
+      static inline double solve
+      ( FUNCTION1            f                ,
+        const double         C                ,
+        const double         a                ,
+        const double         b                ,
+        const double         xtol    = 1.e-14 ,
+        const double         rtol    = 1.e-14 ,
+        const unsigned short maxiter = 100    )
+      {
+        auto ff = std::cref ( f ) ;
+        return root_ ( [ff,C] ( const double x ) -> double { return ff ( x ) - C ; } ,
+                       a , b , xtol , rtol , maxiter ) ;
+      }
+      // ======================================================================
+      /** find the root of the function using safeguarded Halley's method
+       *  (or Newton's method if the second derivative is trivial)
+       *  the step is replaced by the bisection, if it leaves
+       *  the bracketing interval or does not shrink it fast enough
+       *  @param f    the function
+       *  @param d1   the first derivative
+       *  @param d2   the second derivative
+       *  @param a    low edge of the bracketing interval
+       *  @param b    high edge of the bracketing interval
+       *  @param x0   the initial approximation
+       *  @return the root
+       *  @attention <code>f(a)</code> and <code>f(b)</code> must have different signs
+       */
+      template <class FUNCTION1, class DERIV1, class DERIV2>
+      static inline double halley
+      ( FUNCTION1            f                ,
+        DERIV1               d1               ,
+        DERIV2               d2               ,
+        const double         a                ,
+        const double         b                ,
+        const double         x0               ,
+        const double         xtol    = 1.e-14 ,
+        const double         rtol    = 1.e-14 ,
+        const unsigned short maxiter = 100    )
+      { return halley_ ( std::cref ( f  ) ,
+                         std::cref ( d1 ) ,
+                         std::cref ( d2 ) , a , b , x0 , xtol , rtol , maxiter ) ; }
+      // ======================================================================
+      /** find the root of the function using safeguarded Newton's method
+       *  @param f    the function
+       *  @param d1   the first derivative
+       *  @param a    low edge of the bracketing interval
+       *  @param b    high edge of the bracketing interval
+       *  @param x0   the initial approximation
+       *  @return the root
+       */
+      template <class FUNCTION1, class DERIV1>
+      static inline double newton
+      ( FUNCTION1            f                ,
+        DERIV1               d1               ,
+        const double         a                ,
+        const double         b                ,
+        const double         x0               ,
+        const double         xtol    = 1.e-14 ,
+        const double         rtol    = 1.e-14 ,
+        const unsigned short maxiter = 100    )
+      { return halley_ ( std::cref ( f  ) ,
+                         std::cref ( d1 ) ,
+                         function1 () , a , b , x0 , xtol , rtol , maxiter ) ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** find the minimum of the function at the interval \f$ [a,b]\f$
+       *  using Brent's bounded method
+       *  @param f    the function
+       *  @param a    low edge of the interval
+       *  @param b    high edge of the interval
+       *  @param xtol absolute tolerance
+       *  @param maxiter maximal number of iterations
+       *  @return the position of the minimum
+       */
+      template <class FUNCTION1>
+      static inline double minimum
+      ( FUNCTION1            f                ,
+        const double         a                ,
+        const double         b                ,
+        const double         xtol    = 1.e-10 ,
+        const unsigned short maxiter = 500    )
+      { return minimum_ ( std::cref ( f ) , a , b , xtol , maxiter ) ; }
+      // ======================================================================
+      /** find the maximum of the function at the interval \f$ [a,b]\f$
+       *  using Brent's bounded method
+       *  @param f    the function
+       *  @param a    low edge of the interval
+       *  @param b    high edge of the interval
+       *  @return the position of the maximum
+       */
+      template <class FUNCTION1>
+      static inline double maximum
+      ( FUNCTION1            f                ,
+        const double         a                ,
+        const double         b                ,
+        const double         xtol    = 1.e-10 ,
+        const unsigned short maxiter = 500    )
+      {
+        auto ff = std::cref ( f ) ;
+        return minimum_ ( [ff] ( const double x ) -> double { return -ff ( x ) ; } ,
+                          a , b , xtol , maxiter ) ;
+      }
+      // ======================================================================
+      /** find the global maximum (mode) of the function at \f$ [a,b]\f$:
+       *  the coarse scan with <code>nscan</code> points is followed by
+       *  Brent's bounded maximization around the best point
+       *  @param f     the function
+       *  @param a     low edge of the interval
+       *  @param b     high edge of the interval
+       *  @param nscan number of points for the initial scan
+       *  @return the position of the maximum
+       */
+      template <class FUNCTION1>
+      static inline double mode
+      ( FUNCTION1            f            ,
+        const double         a            ,
+        const double         b            ,
+        const unsigned short nscan = 64   )
+      { return mode_ ( std::cref ( f ) , a , b , nscan ) ; }
+      // ======================================================================
+      /** find the points \f$ x_1 < x_{mode} < x_2 \f$, where
+       *  \f$ f(x_{1,2}) = \kappa f( x_{mode})\f$ (FWHM for \f$\kappa=0.5\f$)
+       *  @param f      the function
+       *  @param a      low edge of the interval
+       *  @param b      high edge of the interval
+       *  @param xmode  the position of the mode, if outside \f$ [a,b]\f$
+       *                (or NaN) it is calculated
+       *  @param factor the height factor \f$ \kappa \f$
+       *  @return \f$ ( x_1, x_2 ) \f$
+       */
+      template <class FUNCTION1>
+      static inline std::pair<double,double> width
+      ( FUNCTION1            f              ,
+        const double         a              ,
+        const double         b              ,
+        const double         xmode  = std::numeric_limits<double>::quiet_NaN () ,
+        const double         factor = 0.5   )
+      { return width_ ( std::cref ( f ) , a , b , xmode , factor ) ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** get the quantiles of the distribution at \f$ [a,b]\f$:
+       *  the cumulative integrals are calculated once at <code>nseg</code>
+       *  segments and each quantile is found by Brent's method
+       *  inside its segment
+       *  @param pdf   the (unnormalized) density
+       *  @param probs the quantile levels \f$ 0 \le p \le 1 \f$
+       *  @param a     low edge of the interval
+       *  @param b     high edge of the interval
+       *  @param nseg  number of segments
+       *  @return the quantiles
+       */
+      template <class FUNCTION1>
+      static inline std::vector<double> quantiles
+      ( FUNCTION1                  pdf         ,
+        const std::vector<double>& probs       ,
+        const double               a           ,
+        const double               b           ,
+        const unsigned short       nseg  = 64  )
+      { return quantiles_ ( std::cref ( pdf ) , probs , a , b , nseg ) ; }
+      // ======================================================================
+      /** get the quantile of the distribution at \f$ [a,b]\f$:
+       *  @param pdf   the (unnormalized) density
+       *  @param prob  the quantile level \f$ 0 \le p \le 1 \f$
+       *  @param a     low edge of the interval
+       *  @param b     high edge of the interval
+       *  @return the quantile
+       */
+      template <class FUNCTION1>
+      static inline double quantile
+      ( FUNCTION1                  pdf         ,
+        const double               prob        ,
+        const double               a           ,
+        const double               b           ,
+        const unsigned short       nseg  = 64  )
+      { return quantiles_ ( std::cref ( pdf ) , std::vector<double> ( 1 , prob ) , a , b , nseg ) . front () ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      static double root_
+      ( function1            f       ,
+        const double         a       ,
+        const double         b       ,
+        const double         xtol    ,
+        const double         rtol    ,
+        const unsigned short maxiter ) ;
+      static double halley_
+      ( function1            f       ,
+        function1            d1      ,
+        function1            d2      ,
+        const double         a       ,
+        const double         b       ,
+        const double         x0      ,
+        const double         xtol    ,
+        const double         rtol    ,
+        const unsigned short maxiter ) ;
+      static double minimum_
+      ( function1            f       ,
+        const double         a       ,
+        const double         b       ,
+        const double         xtol    ,
+        const unsigned short maxiter ) ;
+      static double mode_
+      ( function1            f       ,
+        const double         a       ,
+        const double         b       ,
+        const unsigned short nscan   ) ;
+      static std::pair<double,double> width_
+      ( function1            f       ,
+        const double         a       ,
+        const double         b       ,
+        const double         xmode   ,
+        const double         factor  ) ;
+      static std::vector<double> quantiles_
+      ( function1                  pdf   ,
+        const std::vector<double>& probs ,
+        const double               a     ,
+        const double               b     ,
+        const unsigned short       nseg  ) ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_SOLVER1D_H
+// ============================================================================
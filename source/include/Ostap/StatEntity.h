@@ -7,6 +7,7 @@
 // STD & STL
 // ============================================================================
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <string>
 #include <ostream>
@@ -301,6 +302,34 @@ namespace Ostap
      */
     StatEntity& add    ( const StatEntity& value ) ;
     // ========================================================================
+    /** add the array of values 
+     *  The values are processed in blocks: the block statistics 
+     *  (count, mean, second moment, min and max) are accumulated in 
+     *  several independent lanes (vectorizable), the second moment 
+     *  is calculated in the second (corrected) pass over the block 
+     *  and the block is folded into the counter once. 
+     *  @code
+     *  std::vector<double> data = ... ;
+     *  StatEntity cnt ;
+     *  cnt.add ( data.data() , data.data() + data.size() ) ;
+     *  @endcode
+     *  @param begin (INPUT) begin of the sequence of values 
+     *  @param end   (INPUT) end   of the sequence of values 
+     *  @return self-reference 
+     */
+    StatEntity& add    ( const double*     begin , 
+                         const double*     end   ) ;
+    // ========================================================================
+    /** add the array of values
+     *  @see StatEntity::add ( const double* , const double* ) 
+     *  @param n      (INPUT) number of values 
+     *  @param values (INPUT) the values 
+     *  @return self-reference 
+     */
+    StatEntity& add    ( const std::size_t n      , 
+                         const double*     values ) 
+    { return add ( values , values + n ) ; }
+    // ========================================================================
   public:
     // ========================================================================
     /// update counter 
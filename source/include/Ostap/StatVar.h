@@ -20,6 +20,8 @@ class RooAbsData ; // RooFit
 #include "Ostap/WStatEntity.h"
 #include "Ostap/ValueWithError.h"
 #include "Ostap/SymmetricMatrixTypes.h"
+#include "Ostap/TDigest.h"
+#include "Ostap/Covariance.h"
 #include "Ostap/DataFrame.h"
 // ============================================================================
 namespace Ostap
@@ -328,6 +330,57 @@ namespace Ostap
       const unsigned long             first       = 0    ,
       const unsigned long             last        = LAST ) ;
     // ========================================================================
+  public: // multithreaded processing  
+    // ========================================================================
+    /** build statistic for the <code>expression</code> using several threads
+     *  - the range of entries is split into chunks, aligned with tree clusters
+     *  - each thread processes the chunks with its own copy of the tree/chain
+     *  - the partial results are merged in the order of chunks 
+     *  For trees that are not read from files, it falls back to 
+     *  the sequential processing 
+     *  @param tree       (INPUT) the tree 
+     *  @param expression (INPUT) the expression
+     *  @param cuts       (INPUT) the selection criteria 
+     *  @param nthreads   (INPUT) number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @param first      (INPUT) the first entry 
+     *  @param last       (INPUT) the last entry
+     *
+     *  @code
+     *  tree = ... 
+     *  stat = tree.statVar( 'S_sw' ,'pt>1000' , nthreads = 8 ) 
+     *  @endcode 
+     *  @see Ostap::StatVar::statVar
+     *  @date   2023-01-12
+     */
+    static Statistic statVarMT
+    ( TTree*              tree              , 
+      const std::string&  expression        , 
+      const std::string&  cuts       = ""   ,
+      const unsigned int  nthreads   = 0    , 
+      const unsigned long first      = 0    ,
+      const unsigned long last       = LAST ) ;
+    // ========================================================================
+    /** build statistic for the <code>expressions</code> using several threads
+     *  @param tree        (INPUT)  the tree 
+     *  @param result      (UPDATE) the output statistics for specified expressions 
+     *  @param expressions (INPUT)  the list of  expressions
+     *  @param cuts        (INPUT)  the selection criteria 
+     *  @param nthreads    (INPUT)  number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @param first       (INPUT)  the first entry to process 
+     *  @param last        (INPUT)  the last entry to process (not including!)
+     *  @return number of processed entries 
+     *  @see Ostap::StatVar::statVars
+     *  @date   2023-01-12
+     */
+    static unsigned long statVarsMT
+    ( TTree*                          tree               ,       
+      std::vector<Statistic>&         result             , 
+      const Names&                    expressions        ,
+      const std::string&              cuts        = ""   ,
+      const unsigned int              nthreads    = 0    , 
+      const unsigned long             first       = 0    ,
+      const unsigned long             last        = LAST ) ;
+    // ========================================================================
   public:
     // ========================================================================
     /** build statistic for the <code>expression</code>
@@ -638,6 +691,108 @@ namespace Ostap
       const unsigned long  first = 0    ,
       const unsigned long  last  = LAST ) ;
     // ========================================================================
+  public:
+    // ========================================================================
+    /** calculate the statistics and covariances for several expressions 
+     *  in a single pass over the tree:
+     *  - all formulas are compiled once 
+     *  - each entry is read only once 
+     *  - the selection is evaluated only once per entry 
+     *  The covariance matrix is stored in packed form for the lower triangle:
+     *  \f$ C_{ij} \f$ for \f$ j\le i \f$ is stored at the index \f$ i(i+1)/2+j\f$
+     *
+     *  @code
+     *  tree = ...
+     *  stats , cov2 , len = tree.statCovs ( [ 'x' , 'y' , 'z' ] , 'pt>1' ) 
+     *  @endcode 
+     *  @attention for array-like expressions only the first element is used 
+     *  @param tree        (INPUT)  the input tree 
+     *  @param expressions (INPUT)  the list of expressions 
+     *  @param cuts        (INPUT)  the selection criteria (used as weight) 
+     *  @param stats       (UPDATE) the statistics for the expressions 
+     *  @param cov2        (UPDATE) the packed covariance matrix 
+     *  @param first       (INPUT)  the first entry to process 
+     *  @param last        (INPUT)  the last entry to process (not including!)
+     *  @return number of processed events 
+     *  @date   2023-01-16
+     */
+    static unsigned long statCov
+    ( TTree*               tree         ,
+      const Names&         expressions  , 
+      const std::string&   cuts         ,
+      Statistics&          stats        , 
+      std::vector<double>& cov2         , 
+      const unsigned long  first = 0    ,
+      const unsigned long  last  = LAST ) ;
+    // ========================================================================
+    /** calculate the statistics and covariances for several expressions 
+     *  in a single pass over the tree
+     *  @param tree        (INPUT)  the input tree 
+     *  @param expressions (INPUT)  the list of expressions 
+     *  @param stats       (UPDATE) the statistics for the expressions 
+     *  @param cov2        (UPDATE) the packed covariance matrix 
+     *  @param first       (INPUT)  the first entry to process 
+     *  @param last        (INPUT)  the last entry to process (not including!)
+     *  @return number of processed events 
+     *  @date   2023-01-16
+     */
+    static unsigned long statCov
+    ( TTree*               tree         ,
+      const Names&         expressions  , 
+      Statistics&          stats        , 
+      std::vector<double>& cov2         , 
+      const unsigned long  first = 0    ,
+      const unsigned long  last  = LAST ) ;
+    // ========================================================================
+    /** calculate the statistics and covariances for several expressions 
+     *  in a single pass over the tree
+     *  @param tree        (INPUT)  the input tree 
+     *  @param expressions (INPUT)  the list of expressions 
+     *  @param cuts        (INPUT)  the selection criteria (used as weight) 
+     *  @param stats       (UPDATE) the statistics for the expressions 
+     *  @param cov2        (UPDATE) the packed covariance matrix 
+     *  @param first       (INPUT)  the first entry to process 
+     *  @param last        (INPUT)  the last entry to process (not including!)
+     *  @return number of processed events 
+     *  @date   2023-01-16
+     */
+    static unsigned long statCov
+    ( TTree*               tree         ,
+      const Names&         expressions  , 
+      const TCut&          cuts         ,
+      Statistics&          stats        , 
+      std::vector<double>& cov2         , 
+      const unsigned long  first = 0    ,
+      const unsigned long  last  = LAST ) ;
+    // ========================================================================
+    /** calculate the statistics and covariances for several expressions 
+     *  in a single pass over the tree using the mergeable 
+     *  (numerically stable) counter: the entries are 
+     *  accumulated in blocks and added to the counter in batches 
+     *  @code
+     *  tree = ...
+     *  cnt  = Ostap.Math.Covariances ( 3 ) 
+     *  Ostap.StatVar.statCov ( tree , [ 'x' , 'y' , 'z' ] , 'pt>1' , cnt ) 
+     *  @endcode 
+     *  @attention for array-like expressions only the first element is used 
+     *  @param tree        (INPUT)  the input tree 
+     *  @param expressions (INPUT)  the list of expressions 
+     *  @param cuts        (INPUT)  the selection criteria (used as weight) 
+     *  @param result      (UPDATE) the counter 
+     *  @param first       (INPUT)  the first entry to process 
+     *  @param last        (INPUT)  the last entry to process (not including!)
+     *  @return number of processed events 
+     *  @see Ostap::Math::Covariances
+     *  @date   2026-10-15
+     */
+    static unsigned long statCov
+    ( TTree*                    tree         ,
+      const Names&              expressions  , 
+      const std::string&        cuts         ,
+      Ostap::Math::Covariances& result       , 
+      const unsigned long       first = 0    ,
+      const unsigned long       last  = LAST ) ;
+    // ========================================================================
   public:
     // ========================================================================
     /** calculate the covariance of two expressions 
@@ -688,6 +843,183 @@ namespace Ostap
       const unsigned long  first     = 0    ,
       const unsigned long  last      = LAST ) ;
     // ========================================================================
+  public: // multithreaded processing for RooAbsData 
+    // ========================================================================
+    /** build statistic for the <code>expression</code> using several threads
+     *  - the range of entries is split into chunks 
+     *  - each thread processes the chunks with its own view of the data:
+     *    the copies of variables and formulae, the shared read-only columns
+     *  - the partial results are merged in the order of chunks 
+     *  It is possible only for <code>RooDataSet</code> with 
+     *  <code>RooVectorDataStore</code>, otherwise it falls back to 
+     *  the sequential processing 
+     *  @param data       (INPUT) the data 
+     *  @param expression (INPUT) the expression
+     *  @param cuts       (INPUT) the selection criteria/weight
+     *  @param nthreads   (INPUT) number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @param first      (INPUT) the first entry 
+     *  @param last       (INPUT) the last entry
+     *
+     *  @code
+     *  data = ... 
+     *  stat = data.statVar( 'S_sw' ,'pt>10' , nthreads = 8 ) 
+     *  @endcode 
+     *  @see Ostap::StatVar::statVar
+     *  @date   2023-03-23
+     */
+    static Statistic statVarMT
+    ( const RooAbsData*   data              , 
+      const std::string&  expression        , 
+      const std::string&  cuts       = ""   ,
+      const unsigned int  nthreads   = 0    , 
+      const unsigned long first      = 0    ,
+      const unsigned long last       = LAST ) ;
+    // ========================================================================
+    /** build statistic for the <code>expressions</code> using several threads
+     *  @param data        (INPUT)  the data 
+     *  @param result      (UPDATE) the output statistics for specified expressions 
+     *  @param expressions (INPUT)  the list of  expressions
+     *  @param cuts        (INPUT)  the selection criteria/weight 
+     *  @param nthreads    (INPUT)  number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @param first       (INPUT)  the first entry to process 
+     *  @param last        (INPUT)  the last entry to process (not including!)
+     *  @return number of processed entries 
+     *  @see Ostap::StatVar::statVars
+     *  @date   2023-03-23
+     */
+    static unsigned long statVarsMT
+    ( const RooAbsData*               data               ,       
+      std::vector<Statistic>&         result             , 
+      const Names&                    expressions        ,
+      const std::string&              cuts        = ""   ,
+      const unsigned int              nthreads    = 0    , 
+      const unsigned long             first       = 0    ,
+      const unsigned long             last        = LAST ) ;
+    // ========================================================================
+    /** calculate the covariance of two expressions using several threads 
+     *  @param data     (INPUT)  the input data
+     *  @param exp1     (INPUT)  the first  expresiion
+     *  @param exp2     (INPUT)  the second expresiion
+     *  @param cuts     (INPUT)  the selection criteria/weight 
+     *  @param stat1    (UPDATE) the statistic for the first  expression
+     *  @param stat2    (UPDATE) the statistic for the second expression
+     *  @param cov2     (UPDATE) the covariance matrix 
+     *  @param nthreads (INPUT)  number of threads
+     *  @param first    (INPUT)  the first entry to process 
+     *  @param last     (INPUT)  the last entry to process (not including!)
+     *  @return number of processed events 
+     *  @see Ostap::StatVar::statCov
+     *  @date   2023-03-23
+     */
+    static unsigned long statCovMT
+    ( const RooAbsData*    data             , 
+      const std::string&   exp1             , 
+      const std::string&   exp2             , 
+      const std::string&   cuts             , 
+      Statistic&           stat1            ,  
+      Statistic&           stat2            ,  
+      Ostap::SymMatrix2x2& cov2             , 
+      const unsigned int   nthreads  = 0    , 
+      const unsigned long  first     = 0    ,
+      const unsigned long  last      = LAST ) ;
+    // ========================================================================
+    /** calculate the statistics and covariances for several expressions 
+     *  using several threads: the partial counters 
+     *  <code>Ostap::Math::Covariances</code> are merged 
+     *  in the order of chunks 
+     *  @param data        (INPUT)  the input data
+     *  @param expressions (INPUT)  the list of expressions 
+     *  @param cuts        (INPUT)  the selection criteria/weight 
+     *  @param result      (UPDATE) the counter 
+     *  @param nthreads    (INPUT)  number of threads
+     *  @param first       (INPUT)  the first entry to process 
+     *  @param last        (INPUT)  the last entry to process (not including!)
+     *  @return number of processed events 
+     *  @see Ostap::Math::Covariances
+     *  @date   2026-10-15
+     */
+    static unsigned long statCovMT
+    ( const RooAbsData*         data             , 
+      const Names&              expressions      , 
+      const std::string&        cuts             , 
+      Ostap::Math::Covariances& result           ,  
+      const unsigned int        nthreads  = 0    , 
+      const unsigned long       first     = 0    ,
+      const unsigned long       last      = LAST ) ;
+    // ========================================================================
+    /** get the number of equivalent entries using several threads 
+     *  \f$ n_{eff} \equiv = \frac{ (\sum w)^2}{ \sum w^2} \f$
+     *  @param data     (INPUT) the data 
+     *  @param cuts     (INPUT) selection criteria/weight  
+     *  @param nthreads (INPUT) number of threads
+     *  @param first    (INPUT) the first  event to process 
+     *  @param last     (INPUT) the last event to  process
+     *  @return number of equivalent entries 
+     *  @see Ostap::StatVar::nEff
+     *  @date   2023-03-23
+     */
+    static double nEffMT 
+    ( const RooAbsData&    data             , 
+      const std::string&   cuts      = ""   , 
+      const unsigned int   nthreads  = 0    , 
+      const unsigned long  first     = 0    ,
+      const unsigned long  last      = LAST ) ;
+    // ========================================================================
+    /** calculate the moment of order "order" using several threads 
+     *  @param  data     (INPUT) input data
+     *  @param  order    (INPUT) the order 
+     *  @param  expr     (INPUT) expression  (must  be valid TFormula!)
+     *  @param  cuts     (INPUT) cuts 
+     *  @param  nthreads (INPUT) number of threads
+     *  @param  first    (INPUT) the first  event to process 
+     *  @param  last     (INPUT) the last event to  process
+     *  @return the moment 
+     *  @see Ostap::StatVar::moment
+     *  @date   2023-03-23
+     */ 
+    static Ostap::Math::ValueWithError momentMT
+    ( const  RooAbsData&   data             ,  
+      const unsigned short order            ,
+      const std::string&   expr             , 
+      const std::string&   cuts      = ""   , 
+      const unsigned int   nthreads  = 0    , 
+      const unsigned long  first     = 0    ,
+      const unsigned long  last      = LAST ) ;
+    // ========================================================================
+    /** get (exact) quantiles of the distribution using several threads 
+     *  @param data      (INPUT) the input data
+     *  @param quantiles (INPUT) quantile values 0 < q < 1  
+     *  @param expr      (INPUT) the expression 
+     *  @param cuts      (INPUT) selection cuts 
+     *  @param nthreads  (INPUT) number of threads
+     *  @param first     (INPUT) the first  event to process 
+     *  @param last      (INPUT) the last event to  process
+     *  @return the quantile values 
+     *  @see Ostap::StatVar::quantiles
+     *  @date   2023-03-23
+     */
+    static Quantiles quantilesMT
+    ( const RooAbsData&          data              ,
+      const std::vector<double>& quantiles         , 
+      const std::string&         expr              , 
+      const std::string&         cuts       = ""   , 
+      const unsigned int         nthreads   = 0    , 
+      const unsigned long        first      = 0    ,
+      const unsigned long        last       = LAST ) ;
+    // ========================================================================
+    /** get (exact) quantile of the distribution using several threads 
+     *  @see Ostap::StatVar::quantilesMT
+     *  @date   2023-03-23
+     */
+    static Quantile quantileMT
+    ( const RooAbsData&   data             ,
+      const double        q                , //  0<q<1 
+      const std::string&  expr             , 
+      const std::string&  cuts      = ""   , 
+      const unsigned int  nthreads  = 0    , 
+      const unsigned long first     = 0    ,
+      const unsigned long last      = LAST ) ;
+    // ========================================================================
   public:
     // ========================================================================
     /** calculate the covariance of two expressions 
@@ -1384,16 +1716,81 @@ namespace Ostap
      *   Interval ab = p2interval ( frame , 0.05 , 0.95 , 'mass' , 'pt>3' ) ;
      *   @endcode 
      */
-    static QInterval p2interval 
+    static QInterval p2interval
     ( DataFrame           frame        ,
-      const double        q1           , //  0<q1<1 
-      const double        q2           , //  0<q2<1 
-      const std::string&  expr         , 
+      const double        q1           , //  0<q1<1
+      const double        q2           , //  0<q2<1
+      const std::string&  expr         ,
       const std::string&  cuts  = ""   ) ;
-    // ========================================================================    
+    // ========================================================================
+  public:
+    // ========================================================================
+    /** fill the mergeable quantile sketch (t-digest) for the distribution
+     *  - the sketches from different chunks/jobs can be merged
+     *  - the cuts are used only as boolean selection (no weights!)
+     *   @param tree   (INPUT)  the input tree
+     *   @param digest (UPDATE) the sketch to be updated
+     *   @param expr   (INPUT)  the expression
+     *   @param cuts   (INPUT)  selection cuts
+     *   @param first  (INPUT)  the first  event to process
+     *   @param last   (INPUT)  the last event to  process
+     *   @return number of added entries
+     *   @code
+     *   Tree& tree = ... ;
+     *   Ostap::Math::TDigest digest {} ;
+     *   StatVar::digest ( tree , digest , 'mass' , 'pt>3' ) ;
+     *   const double median = digest.quantile ( 0.5 ) ;
+     *   @endcode
+     *   @see Ostap::Math::TDigest
+     */
+    static unsigned long digest
+    ( TTree&                tree         ,
+      Ostap::Math::TDigest& digest       ,
+      const std::string&    expr         ,
+      const std::string&    cuts  = ""   ,
+      const unsigned long   first = 0    ,
+      const unsigned long   last  = LAST ) ;
+    // ========================================================================
+    /** fill the mergeable quantile sketch (t-digest) for the distribution
+     *  - the cuts and weights are used only as boolean selection (no weights!)
+     *   @param data      (INPUT)  the input data
+     *   @param digest    (UPDATE) the sketch to be updated
+     *   @param expr      (INPUT)  the expression
+     *   @param cuts      (INPUT)  selection cuts
+     *   @param cut_range (INPUT)  cut range
+     *   @param first     (INPUT)  the first  event to process
+     *   @param last      (INPUT)  the last event to  process
+     *   @return number of added entries
+     *   @see Ostap::Math::TDigest
+     */
+    static unsigned long digest
+    ( const RooAbsData&     data             ,
+      Ostap::Math::TDigest& digest           ,
+      const std::string&    expr             ,
+      const std::string&    cuts      = ""   ,
+      const std::string&    cut_range = ""   ,
+      const unsigned long   first     = 0    ,
+      const unsigned long   last      = LAST ) ;
+    // ========================================================================
+    /** fill the mergeable quantile sketch (t-digest) for the distribution
+     *  - the per-slot sketches are merged for multithreaded processing
+     *  - the cuts are used only as boolean selection (no weights!)
+     *   @param frame  (INPUT)  the input frame
+     *   @param digest (UPDATE) the sketch to be updated
+     *   @param expr   (INPUT)  the expression
+     *   @param cuts   (INPUT)  selection cuts
+     *   @return number of added entries
+     *   @see Ostap::Math::TDigest
+     */
+    static unsigned long digest
+    ( DataFrame             frame        ,
+      Ostap::Math::TDigest& digest       ,
+      const std::string&    expr         ,
+      const std::string&    cuts  = ""   ) ;
+    // ========================================================================
   public:
     // ========================================================================
-    /// data column 
+    /// data column
     typedef std::vector<double> Column ;    
     /// data table 
     typedef std::vector<Column> Table  ;
@@ -0,0 +1,181 @@
+// ============================================================================
+#ifndef OSTAP_TDIGEST_H
+#define OSTAP_TDIGEST_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+#include <utility>
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace  Math
+  {
+    // ========================================================================
+    /** @class TDigest Ostap/TDigest.h
+     *  Mergeable, bounded-memory sketch for the quantiles ("merging t-digest")
+     *  - the distribution is represented by the sorted list of weighted centroids,
+     *    the weight of the centroid is limited by the scale function
+     *    \f$ k(q) = \frac{\delta}{2\pi} \arcsin ( 2q - 1 ) \f$,
+     *    where \f$ \delta \f$ is the compression parameter
+     *  - the number of centroids does not exceed \f$ \delta \f$
+     *  - the rank error of the quantile is limited by the half-weight of the
+     *    centroid: \f$ \Delta q \lesssim \frac{\pi}{\delta} \sqrt{q(1-q)} \f$,
+     *    the accuracy is better at the tails
+     *  - two sketches can be merged (e.g. from different threads or jobs)
+     *    without loss of accuracy
+     *  - the points can be weighted (positive weights only)
+     *
+     *  @code
+     *  TDigest d1 , d2 ;
+     *  for ( ... ) { d1.add ( x ) ; }
+     *  for ( ... ) { d2.add ( y ) ; }
+     *  d1 += d2 ;
+     *  const double median = d1.quantile ( 0.5 ) ;
+     *  @endcode
+     *  @see T.Dunning, "The t-digest: Efficient estimates of distributions",
+     *       Software Impacts 7 (2021) 100049
+     *  @see https://doi.org/10.1016/j.simpa.2020.100049
+     *  @see https://arxiv.org/abs/1902.04023
+     *  @see Ostap::Math::GSL::P2Quantile
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-03-20
+     */
+    class TDigest
+    {
+    public:
+      // ======================================================================
+      /** constructor from the compression parameter
+       *  @param compression the compression parameter \f$ 20 \le \delta \f$
+       */
+      TDigest ( const unsigned int compression = 100 ) ;
+      // ======================================================================
+      /** full constructor (e.g. for deserialization)
+       *  @param compression the compression parameter
+       *  @param means       the means of centroids
+       *  @param weights     the weights of centroids
+       *  @param n           number of added points
+       *  @param xmin        the minimal value
+       *  @param xmax        the maximal value
+       */
+      TDigest ( const unsigned int         compression ,
+                const std::vector<double>& means       ,
+                const std::vector<double>& weights     ,
+                const unsigned long        n           ,
+                const double               xmin        ,
+                const double               xmax        ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** add the (weighted) point
+       *  @param x the value
+       *  @param w the weight
+       */
+      TDigest& add ( const double x , const double w = 1 ) ;
+      // ======================================================================
+      /// add several points
+      template <class ITERATOR>
+      TDigest& add ( ITERATOR begin ,
+                     ITERATOR end   )
+      {
+        for ( ; begin != end ; ++begin ) { add ( *begin ) ; }
+        return *this ;
+      }
+      // ======================================================================
+      /// merge with other sketch
+      TDigest& add ( const TDigest& right ) ;
+      // ======================================================================
+      /// add the point
+      TDigest& operator+= ( const double   x     ) { return add ( x     ) ; }
+      /// merge with other sketch
+      TDigest& operator+= ( const TDigest& right ) { return add ( right ) ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** get the quantile
+       *  @param p the probability \f$ 0 \le p \le 1 \f$
+       *  @return the quantile value
+       */
+      double quantile ( const double p ) const ;
+      // ======================================================================
+      /// get several quantiles
+      std::vector<double> quantiles ( const std::vector<double>& ps ) const ;
+      // ======================================================================
+      /// get the median
+      double median () const { return quantile ( 0.5 ) ; }
+      // ======================================================================
+      /** get the cumulative distribution function
+       *  @param x the value
+       *  @return the fraction of weight below x
+       */
+      double cdf ( const double x ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of added points
+      unsigned long n           () const { return m_n           ; }
+      /// empty ?
+      bool          empty       () const { return 0 == m_n      ; }
+      /// the sum of weights
+      double        sumw        () const { return m_sumw        ; }
+      /// the minimal value
+      double        min         () const { return m_min         ; }
+      /// the maximal value
+      double        max         () const { return m_max         ; }
+      /// the compression parameter
+      unsigned int  compression () const { return m_compression ; }
+      // ======================================================================
+      /// number of centroids
+      std::size_t   size        () const ;
+      /// the means of centroids
+      const std::vector<double>& means   () const { compress () ; return m_means   ; }
+      /// the weights of centroids
+      const std::vector<double>& weights () const { compress () ; return m_weights ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// merge the buffered points with the centroids
+      void compress () const ;
+      /// reset the sketch
+      void reset    () ;
+      /// swap two sketches
+      void swap     ( TDigest& right ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the compression parameter
+      unsigned int                                m_compression { 100 } ;
+      /// number of added points
+      unsigned long                               m_n           { 0   } ;
+      /// the sum of weights
+      double                                      m_sumw        { 0   } ;
+      /// the minimal value
+      double                                      m_min         { 0   } ;
+      /// the maximal value
+      double                                      m_max         { 0   } ;
+      /// the means of centroids
+      mutable std::vector<double>                 m_means       {} ;
+      /// the weights of centroids
+      mutable std::vector<double>                 m_weights     {} ;
+      /// the buffer of the non-merged points
+      mutable std::vector<std::pair<double,double> > m_buffer   {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /// swap two sketches
+    inline void swap ( TDigest& a , TDigest& b ) { a.swap ( b ) ; }
+    // ========================================================================
+    /// merge two sketches
+    inline TDigest operator+ ( TDigest a , const TDigest& b ) { a += b ; return a ; }
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_TDIGEST_H
+// ============================================================================
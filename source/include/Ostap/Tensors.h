@@ -7,6 +7,7 @@
 // STD&STL
 // ============================================================================
 #include <cmath>
+#include <cstddef>
 #include <complex>
 // ============================================================================
 // Ostap
@@ -50,6 +51,52 @@ namespace Ostap
         LAST = 4
       } ;
       // ======================================================================
+      /** @struct Vectors  Ostap/Tensors.h
+       *  Structure-of-arrays view of N 4-vectors:
+       *  four contiguous arrays of the contravariant components
+       *  \f$ (p_x,p_y,p_z,E) \f$. The arrays are not owned.
+       *  It is used for the batched contractions
+       *  @code
+       *  const Vectors v1 ( px1 , py1 , pz1 , e1 ) ;
+       *  const Vectors v2 ( px2 , py2 , pz2 , e2 ) ;
+       *  std::vector<double> r ( N ) ;
+       *  G::dot ( N , v1 , v2 , r.data() ) ;
+       *  @endcode
+       *  @see Ostap::Math::Tensors::Epsilon
+       *  @see Ostap::Math::Tensors::G
+       */
+      struct Vectors
+      {
+        Vectors ( const double* px_ ,
+                  const double* py_ ,
+                  const double* pz_ ,
+                  const double* e_  )
+          : px ( px_ ) , py ( py_ ) , pz ( pz_ ) , e ( e_ )
+        {}
+        const double* px { nullptr } ;
+        const double* py { nullptr } ;
+        const double* pz { nullptr } ;
+        const double* e  { nullptr } ;
+      } ;
+      // ======================================================================
+      /** @struct OutVectors  Ostap/Tensors.h
+       *  Structure-of-arrays output for N 4-vectors
+       *  @see Ostap::Math::Tensors::Vectors
+       */
+      struct OutVectors
+      {
+        OutVectors ( double* px_ ,
+                     double* py_ ,
+                     double* pz_ ,
+                     double* e_  )
+          : px ( px_ ) , py ( py_ ) , pz ( pz_ ) , e ( e_ )
+        {}
+        double* px { nullptr } ;
+        double* py { nullptr } ;
+        double* pz { nullptr } ;
+        double* e  { nullptr } ;
+      } ;
+      // ======================================================================
       /** @struct Delta_  Ostap/Tensors.h
        *
        *  (Compile-time) Kronecker delta: \f$ \delta^{\mu}_{\nu} \f$
@@ -179,6 +226,19 @@ namespace Ostap
             ( T    == i )  ?  1 : -1 ;
         }
         // ====================================================================
+        /** batched metric contraction for N pairs of 4-vectors:
+         *  \f$ r_i = g_{\mu\nu} a_i^{\mu} b_i^{\nu} \f$
+         *  @param n      (INPUT)  number of vectors
+         *  @param a      (INPUT)  the first  vectors
+         *  @param b      (INPUT)  the second vectors
+         *  @param result (OUTPUT) the array of size <code>n</code>
+         */
+        static void dot
+        ( const std::size_t n      ,
+          const Vectors&    a      ,
+          const Vectors&    b      ,
+          double*           result ) ;
+        // ====================================================================
       };
       // ======================================================================
       /** @struct Epsilon_
@@ -404,6 +464,91 @@ namespace Ostap
           typedef ROOT::Math::LorentzVector<COORDINATES>               vTYPE ;
         } ;  
         // ====================================================================
+        /** @struct _FMA
+         *  helper structure for the compile-time sign pattern of the symbol:
+         *  \f$ r + s a b c \f$ for \f$ s = \pm1 \f$, the zero terms are eliminated
+         */
+        template <int S> struct _FMA ;
+        template <> struct _FMA< 1>
+        {
+          static inline double add ( const double r , const double a , const double b ) { return r + a * b ; }
+          static inline double add ( const double r , const double a , const double b , const double c ) { return r + a * b * c ; }
+        } ;
+        template <> struct _FMA<-1>
+        {
+          static inline double add ( const double r , const double a , const double b ) { return r - a * b ; }
+          static inline double add ( const double r , const double a , const double b , const double c ) { return r - a * b * c ; }
+        } ;
+        template <> struct _FMA< 0>
+        {
+          static inline double add ( const double r , const double   , const double   ) { return r ; }
+          static inline double add ( const double r , const double   , const double   , const double   ) { return r ; }
+        } ;
+        /// add the term of the contraction with the compile-time symbol
+        template <unsigned int I, unsigned int J, unsigned int K, unsigned int L>
+        inline double _eps ( const double r , const double a , const double b )
+        { return _FMA<Epsilon_<I,J,K,L>::value>::add ( r , a , b ) ; }
+        /// add the term of the contraction with the compile-time symbol
+        template <unsigned int I, unsigned int J, unsigned int K, unsigned int L>
+        inline double _eps ( const double r , const double a , const double b , const double c )
+        { return _FMA<Epsilon_<I,J,K,L>::value>::add ( r , a , b , c ) ; }
+        // ====================================================================
+        /** \f$ \epsilon_{IJ\lambda\kappa} a^{\lambda} b^{\kappa} \f$
+         *  for the covariant components <code>(x,y,z,e)</code>
+         */
+        template <unsigned int I, unsigned int J>
+        inline double _e_2 ( const double* a , const double* b )
+        {
+          double r = 0 ;
+          r = _eps<I,J,X,Y> ( r , a [ 0 ] , b [ 1 ] ) ;
+          r = _eps<I,J,X,Z> ( r , a [ 0 ] , b [ 2 ] ) ;
+          r = _eps<I,J,X,E> ( r , a [ 0 ] , b [ 3 ] ) ;
+          r = _eps<I,J,Y,X> ( r , a [ 1 ] , b [ 0 ] ) ;
+          r = _eps<I,J,Y,Z> ( r , a [ 1 ] , b [ 2 ] ) ;
+          r = _eps<I,J,Y,E> ( r , a [ 1 ] , b [ 3 ] ) ;
+          r = _eps<I,J,Z,X> ( r , a [ 2 ] , b [ 0 ] ) ;
+          r = _eps<I,J,Z,Y> ( r , a [ 2 ] , b [ 1 ] ) ;
+          r = _eps<I,J,Z,E> ( r , a [ 2 ] , b [ 3 ] ) ;
+          r = _eps<I,J,E,X> ( r , a [ 3 ] , b [ 0 ] ) ;
+          r = _eps<I,J,E,Y> ( r , a [ 3 ] , b [ 1 ] ) ;
+          r = _eps<I,J,E,Z> ( r , a [ 3 ] , b [ 2 ] ) ;
+          return r ;
+        }
+        // ====================================================================
+        /** \f$ \epsilon_{I\nu\lambda\kappa} a^{\nu} b^{\lambda} c^{\kappa} \f$
+         *  for the covariant components <code>(x,y,z,e)</code>
+         */
+        template <unsigned int I>
+        inline double _e_1 ( const double* a , const double* b , const double* c )
+        {
+          double r = 0 ;
+          r = _eps<I,X,Y,Z> ( r , a [ 0 ] , b [ 1 ] , c [ 2 ] ) ;
+          r = _eps<I,X,Y,E> ( r , a [ 0 ] , b [ 1 ] , c [ 3 ] ) ;
+          r = _eps<I,X,Z,Y> ( r , a [ 0 ] , b [ 2 ] , c [ 1 ] ) ;
+          r = _eps<I,X,Z,E> ( r , a [ 0 ] , b [ 2 ] , c [ 3 ] ) ;
+          r = _eps<I,X,E,Y> ( r , a [ 0 ] , b [ 3 ] , c [ 1 ] ) ;
+          r = _eps<I,X,E,Z> ( r , a [ 0 ] , b [ 3 ] , c [ 2 ] ) ;
+          r = _eps<I,Y,X,Z> ( r , a [ 1 ] , b [ 0 ] , c [ 2 ] ) ;
+          r = _eps<I,Y,X,E> ( r , a [ 1 ] , b [ 0 ] , c [ 3 ] ) ;
+          r = _eps<I,Y,Z,X> ( r , a [ 1 ] , b [ 2 ] , c [ 0 ] ) ;
+          r = _eps<I,Y,Z,E> ( r , a [ 1 ] , b [ 2 ] , c [ 3 ] ) ;
+          r = _eps<I,Y,E,X> ( r , a [ 1 ] , b [ 3 ] , c [ 0 ] ) ;
+          r = _eps<I,Y,E,Z> ( r , a [ 1 ] , b [ 3 ] , c [ 2 ] ) ;
+          r = _eps<I,Z,X,Y> ( r , a [ 2 ] , b [ 0 ] , c [ 1 ] ) ;
+          r = _eps<I,Z,X,E> ( r , a [ 2 ] , b [ 0 ] , c [ 3 ] ) ;
+          r = _eps<I,Z,Y,X> ( r , a [ 2 ] , b [ 1 ] , c [ 0 ] ) ;
+          r = _eps<I,Z,Y,E> ( r , a [ 2 ] , b [ 1 ] , c [ 3 ] ) ;
+          r = _eps<I,Z,E,X> ( r , a [ 2 ] , b [ 3 ] , c [ 0 ] ) ;
+          r = _eps<I,Z,E,Y> ( r , a [ 2 ] , b [ 3 ] , c [ 1 ] ) ;
+          r = _eps<I,E,X,Y> ( r , a [ 3 ] , b [ 0 ] , c [ 1 ] ) ;
+          r = _eps<I,E,X,Z> ( r , a [ 3 ] , b [ 0 ] , c [ 2 ] ) ;
+          r = _eps<I,E,Y,X> ( r , a [ 3 ] , b [ 1 ] , c [ 0 ] ) ;
+          r = _eps<I,E,Y,Z> ( r , a [ 3 ] , b [ 1 ] , c [ 2 ] ) ;
+          r = _eps<I,E,Z,X> ( r , a [ 3 ] , b [ 2 ] , c [ 0 ] ) ;
+          r = _eps<I,E,Z,Y> ( r , a [ 3 ] , b [ 2 ] , c [ 1 ] ) ;
+          return r ;
+        }
+        // ====================================================================
       }
       // ======================================================================
       /** @struct Epsilon
@@ -1058,6 +1203,118 @@ namespace Ostap
               const ROOT::Math::LorentzVector<COORDINATES>& v2 ,
               const ROOT::Math::LorentzVector<COORDINATES>& v3 ) ;
         // ====================================================================
+      public: // batched contractions for the structure-of-arrays input
+        // ====================================================================
+        /** batched e*v1*v2 product for N pairs of vectors
+         *  \f$  r_i = \epsilon_{IJ\lambda\kappa}v_{1i}^{\lambda}v_{2i}^{\kappa} \f$
+         *  The zero terms of the symbol are eliminated at compile time.
+         *  @attention the calculations are performed in double precision
+         *  @code
+         *  Epsilon::e_2<Epsilon::X,Epsilon::Y> ( N , v1 , v2 , result ) ;
+         *  @endcode
+         *  @param n      (INPUT)  number of vectors
+         *  @param v1     (INPUT)  the first  vectors
+         *  @param v2     (INPUT)  the second vectors
+         *  @param result (OUTPUT) the array of size <code>n</code>
+         */
+        template <unsigned int I, unsigned int J>
+        static inline void
+        e_2 ( const std::size_t n      ,
+              const Vectors&    v1     ,
+              const Vectors&    v2     ,
+              double*           result ) ;
+        // ====================================================================
+        /** batched e*v1*v2*v3 product (component) for N triplets of vectors
+         *  \f$  r_i = \epsilon_{I\nu\lambda\kappa}
+         *   v_{1i}^{\nu}v_{2i}^{\lambda}v_{3i}^{\kappa} \f$
+         *  The zero terms of the symbol are eliminated at compile time.
+         *  @attention the calculations are performed in double precision
+         *  @code
+         *  Epsilon::e_1<Epsilon::E> ( N , v1 , v2 , v3 , result ) ;
+         *  @endcode
+         *  @param n      (INPUT)  number of vectors
+         *  @param v1     (INPUT)  the first  vectors
+         *  @param v2     (INPUT)  the second vectors
+         *  @param v3     (INPUT)  the third  vectors
+         *  @param result (OUTPUT) the array of size <code>n</code>
+         */
+        template <unsigned int I>
+        static inline void
+        e_1 ( const std::size_t n      ,
+              const Vectors&    v1     ,
+              const Vectors&    v2     ,
+              const Vectors&    v3     ,
+              double*           result ) ;
+        // ====================================================================
+        /** batched e*v1*v2*v3 product (4-normal) for N triplets of vectors
+         *  \f$  L_{i\mu} = \epsilon_{\mu\nu\lambda\kappa}
+         *   v_{1i}^{\nu}v_{2i}^{\lambda}v_{3i}^{\kappa} \f$
+         *  @attention the calculations are performed in double precision
+         *  @param n      (INPUT)  number of vectors
+         *  @param v1     (INPUT)  the first  vectors
+         *  @param v2     (INPUT)  the second vectors
+         *  @param v3     (INPUT)  the third  vectors
+         *  @param result (OUTPUT) the arrays of size <code>n</code>
+         */
+        static void epsilon
+        ( const std::size_t n      ,
+          const Vectors&    v1     ,
+          const Vectors&    v2     ,
+          const Vectors&    v3     ,
+          const OutVectors& result ) ;
+        // ====================================================================
+        /** batched e*v1*v2*v3*v4 product for N quartets of vectors
+         *  \f$  r_i = \epsilon_{\mu\nu\lambda\kappa}
+         *   v_{1i}^{\mu}v_{2i}^{\nu}v_{3i}^{\lambda}v_{4i}^{\kappa} \f$
+         *  (e.g. the triple products for the candidates in the ntuple)
+         *  @attention the calculations are performed in double precision
+         *  @param n      (INPUT)  number of vectors
+         *  @param v1     (INPUT)  the first  vectors
+         *  @param v2     (INPUT)  the second vectors
+         *  @param v3     (INPUT)  the third  vectors
+         *  @param v4     (INPUT)  the fourth vectors
+         *  @param result (OUTPUT) the array of size <code>n</code>
+         */
+        static void epsilon
+        ( const std::size_t n      ,
+          const Vectors&    v1     ,
+          const Vectors&    v2     ,
+          const Vectors&    v3     ,
+          const Vectors&    v4     ,
+          double*           result ) ;
+        // ====================================================================
+        /** batched tensor product (e*a1*a2*a3)*(e*b1*b2*b3)
+         *  for N sextets of vectors ("plane-angles")
+         *  @attention the calculations are performed in double precision
+         *  @param n      (INPUT)  number of vectors
+         *  @param result (OUTPUT) the array of size <code>n</code>
+         */
+        static void epsilon
+        ( const std::size_t n      ,
+          const Vectors&    a1     ,
+          const Vectors&    a2     ,
+          const Vectors&    a3     ,
+          const Vectors&    b1     ,
+          const Vectors&    b2     ,
+          const Vectors&    b3     ,
+          double*           result ) ;
+        // ====================================================================
+        /** batched magnitude of the "4-normal" for N triplets of vectors
+         *  @see Epsilon::mag2
+         *  @attention the calculations are performed in double precision
+         *  @param n      (INPUT)  number of vectors
+         *  @param a      (INPUT)  the first  vectors
+         *  @param b      (INPUT)  the second vectors
+         *  @param c      (INPUT)  the third  vectors
+         *  @param result (OUTPUT) the array of size <code>n</code>
+         */
+        static void mag2
+        ( const std::size_t n      ,
+          const Vectors&    a      ,
+          const Vectors&    b      ,
+          const Vectors&    c      ,
+          double*           result ) ;
+        // ====================================================================
       };
       // ======================================================================
     } //                                  end of namespace Ostap::Math::Tensors
@@ -92,6 +92,33 @@ namespace Ostap
       const std::string& suffix  = ""  , 
       const double       aux     = 0.9 ) ;
     // ========================================================================
+    /** Add TMVA response to TTree using several threads 
+     *  - each thread uses its own copy of the tree and own TMVA readers
+     *  - the responses are calculated in parallel for chunks of entries 
+     *    and the branches are filled in order in the calling thread
+     *  - it falls back to the sequential processing if the tree is not 
+     *    suitable for the parallel processing 
+     *  @param tree         (UPDATE) input TTree
+     *  @param inputs       (INPUT) map  { varname : formula     }  
+     *  @param weight_files (INPUT) map  { method  : weight_file }  
+     *  @param prefix       (INPUT) the prefix for added variables 
+     *  @param suffix       (INPUT) the suffix for added variables 
+     *  @param aux          (INPUT) obligatory for the cuts method
+     *                              where it represents the efficiency cutoff
+     *  @param nthreads     (INPUT) number of threads (0: default)
+     *  @see Ostap::TMVA::addResponse
+     *  @date 2023-01-29
+     */ 
+    Ostap::StatusCode addResponseMT
+    ( TTree*             tree          ,
+      const MAP&         inputs        , 
+      const MAP&         weight_files  ,
+      const std::string& options  = "" ,
+      const std::string& prefix   = "" , 
+      const std::string& suffix   = "" , 
+      const double       aux      = 0.9 , 
+      const unsigned int nthreads = 0   ) ;
+    // ========================================================================
     // Chopping 
     // ========================================================================
     /** Add TMVA/Chopping response to dataset 
@@ -150,6 +177,39 @@ namespace Ostap
       const std::string&   suffix   = ""          ,
       const double         aux      = 0.9         ) ;
     // ========================================================================
+    /** Add TMVA/Chopping response to TTree using several threads 
+     *  - each thread uses its own copy of the tree and own TMVA readers
+     *  - the responses are calculated in parallel for chunks of entries 
+     *    and the branches are filled in order in the calling thread
+     *  - it falls back to the sequential processing if the tree is not 
+     *    suitable for the parallel processing 
+     *  @param tree         (UPDATE) input tree 
+     *  @param chopping     (INPUT) chopping variable/expression
+     *  @param chopping     (INPUT) chopping category 
+     *  @param N            (INPUT) number of categories 
+     *  @param inputs       (INPUT) map  { varname : formula     }  
+     *  @param weight_files (INPUT) map  { method  : weight_file }  
+     *  @param prefix       (INPUT) the prefix for added variables 
+     *  @param suffix       (INPUT) the suffix for added variables 
+     *  @param aux          (INPUT) obligatory for the cuts method
+     *                              where it represents the efficiency cutoff
+     *  @param nthreads     (INPUT) number of threads (0: default)
+     *  @see Ostap::TMVA::addChoppingResponse
+     *  @date 2023-01-29
+     */ 
+    Ostap::StatusCode addChoppingResponseMT
+    ( TTree*               tree                   ,
+      const std::string&   chopping               , // category function 
+      const std::string&   category_name          , // category variable 
+      const unsigned short N                      , // number of categories 
+      const MAP&           inputs                 , // mapping of input variables 
+      const MAPS&          weight_files           ,
+      const std::string&   options  = ""          ,
+      const std::string&   prefix   = ""          , 
+      const std::string&   suffix   = ""          ,
+      const double         aux      = 0.9         , 
+      const unsigned int   nthreads = 0           ) ;
+    // ========================================================================
   } //                                         The END of namespace Ostap::TMVA 
   // ==========================================================================
 } //                                                 The END of namespace Ostap
@@ -0,0 +1,244 @@
+// ============================================================================
+#ifndef OSTAP_TMVAFOREST_H
+#define OSTAP_TMVAFOREST_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/IFuncs.h"
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class TTree ; // ROOT
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  class Formula ;
+  // ==========================================================================
+  namespace TMVA
+  {
+    // ========================================================================
+    /** @class Forest Ostap/TmvaForest.h
+     *  Flattened, compiled form of the trained TMVA BDT:
+     *  all nodes of all trees are stored in one contiguous array,
+     *  the evaluation does not need <code>TMVA::Reader</code>,
+     *  it is <code>const</code> and thread-safe.
+     *
+     *  Each node is defined by
+     *   - <code>var</code>  : index of the input variable, negative for leaves
+     *   - <code>cut</code>  : the cut value
+     *   - <code>left/right</code> : indices of the daughter nodes
+     *     (the cut type of TMVA is already applied, the event goes
+     *     to the <code>right</code> node if <code>x[var]>=cut</code>)
+     *   - <code>value</code> : the response of the leaf
+     *     (the residual for gradient boosting, the purity or the node type otherwise)
+     *
+     *  The response is
+     *   - gradient boosting: \f$ \frac{2}{1+\mathrm{e}^{-2\sum_i v_i}}-1\f$
+     *   - otherwise        : \f$ \frac{\sum_i w_i v_i}{\sum_i w_i}\f$
+     *
+     *  As for <code>TMVA::Reader</code>, the input values are converted to <code>float</code>
+     *  @see ostap.tools.tmva_forest
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2026-10-15
+     */
+    class Forest
+    {
+    public:
+      // ======================================================================
+      /** constructor from the flattened node arrays
+       *  @param nvars    number of input variables
+       *  @param var      index of the variable for each node (negative for leaves)
+       *  @param cut      the cut value for each node
+       *  @param left     index of the left  daughter for each node
+       *  @param right    index of the right daughter for each node
+       *  @param value    the leaf value for each node
+       *  @param roots    indices of the root nodes of the trees
+       *  @param weights  boost weights of the trees
+       *  @param gradient gradient boosting?
+       */
+      Forest
+      ( const unsigned short        nvars    ,
+        const std::vector<int>&     var      ,
+        const std::vector<double>&  cut      ,
+        const std::vector<int>&     left     ,
+        const std::vector<int>&     right    ,
+        const std::vector<double>&  value    ,
+        const std::vector<int>&     roots    ,
+        const std::vector<double>&  weights  ,
+        const bool                  gradient ) ;
+      // ======================================================================
+      /// default constructor: empty forest
+      Forest () = default ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// evaluate the response for the input vector (at least nvars elements)
+      double evaluate    ( const double*              x ) const ;
+      /// evaluate the response for the input vector
+      double operator () ( const std::vector<double>& x ) const ;
+      // ======================================================================
+      /** evaluate the responses for the batch of inputs
+       *  @param n      number of input vectors
+       *  @param x      the row-major array of <code>n*nvars</code> input values
+       *  @param result the output array (at least <code>n</code> elements)
+       */
+      void evaluate
+      ( const std::size_t n      ,
+        const double*     x      ,
+        double*           result ) const ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of input variables
+      unsigned short nvars    () const { return m_nvars          ; }
+      /// number of trees
+      std::size_t    ntrees   () const { return m_roots.size ()  ; }
+      /// total number of nodes
+      std::size_t    nnodes   () const { return m_nodes.size ()  ; }
+      /// gradient boosting?
+      bool           gradient () const { return m_gradient       ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the flattened node
+      struct Node
+      {
+        float  cut         ;
+        int    var         ;
+        int    next  [ 2 ] ; // left & right
+        double value       ;
+      } ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the response from the float inputs
+      double response ( const float* x ) const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// number of input variables
+      unsigned short      m_nvars    { 0     } ;
+      /// all nodes of all trees
+      std::vector<Node>   m_nodes    {       } ;
+      /// the roots of trees
+      std::vector<int>    m_roots    {       } ;
+      /// the boost weights
+      std::vector<double> m_weights  {       } ;
+      /// the sum of boost weights
+      double              m_norm     { 0     } ;
+      /// gradient boosting?
+      bool                m_gradient { false } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class ForestResponse Ostap/TmvaForest.h
+     *  TTree-function for the response of the compiled TMVA BDT,
+     *  the inputs are defined by the formulas.
+     *  For the ``chopping'' the category is <code>chopping%N</code>,
+     *  where <code>N</code> is the number of forests.
+     *  It can be used with <code>Ostap::Trees::add_branch</code>
+     *  @see Ostap::TMVA::Forest
+     *  @see Ostap::Trees::add_branch
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2026-10-15
+     */
+    class ForestResponse : public Ostap::IFuncTree
+    {
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param forest the compiled forest
+       *  @param inputs the formulas for the input variables
+       *  @param tree   the tree
+       */
+      ForestResponse
+      ( const Forest&                   forest           ,
+        const std::vector<std::string>& inputs           ,
+        const TTree*                    tree   = nullptr ) ;
+      // ======================================================================
+      /** constructor for the ``chopping''
+       *  @param forests  the compiled forests for the categories
+       *  @param chopping the chopping expression
+       *  @param inputs   the formulas for the input variables
+       *  @param tree     the tree
+       */
+      ForestResponse
+      ( const std::vector<Forest>&      forests            ,
+        const std::string&              chopping           ,
+        const std::vector<std::string>& inputs             ,
+        const TTree*                    tree     = nullptr ) ;
+      // ======================================================================
+      /// copy constructor
+      ForestResponse ( const ForestResponse& right ) ;
+      /// destructor
+      virtual ~ForestResponse () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// evaluate the response for TTree
+      double operator() ( const TTree* tree ) const override ;
+      // ======================================================================
+      /** evaluate the response for the block of entries [first,last)
+       *  the formulas are prepared only once
+       *  @see Ostap::IFuncTree::evaluate_range
+       */
+      unsigned long evaluate_range
+      ( const TTree*        tree   ,
+        const unsigned long first  ,
+        const unsigned long last   ,
+        double*             result ) const override ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of categories
+      std::size_t                     N        () const { return m_forests.size () ; }
+      /// the input formulas
+      const std::vector<std::string>& inputs   () const { return m_inputs   ; }
+      /// the chopping expression
+      const std::string&              chopping () const { return m_chopping ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// prepare formulas for the tree
+      void   make_formulas ( const TTree* tree ) const ;
+      /// evaluate the response for the current entry
+      double evaluate      () const ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the forests
+      std::vector<Forest>      m_forests  {} ;
+      /// the chopping expression
+      std::string              m_chopping {} ;
+      /// the input expressions
+      std::vector<std::string> m_inputs   {} ;
+      // ======================================================================
+      /// the tree
+      mutable const TTree*                                 m_tree    { nullptr } ;
+      /// the input formulas
+      mutable std::vector<std::unique_ptr<Ostap::Formula>> m_formulas {} ;
+      /// the chopping formula
+      mutable std::unique_ptr<Ostap::Formula>              m_chopper  {} ;
+      /// the input buffer
+      mutable std::vector<double>                          m_x        {} ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                         The END of namespace Ostap::TMVA
+  // ==========================================================================
+} //                                                 The END of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_TMVAFOREST_H
+// ============================================================================
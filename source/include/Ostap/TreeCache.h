@@ -0,0 +1,125 @@
+// ============================================================================
+#ifndef OSTAP_TREECACHE_H
+#define OSTAP_TREECACHE_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <set>
+#include <string>
+#include <vector>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "RtypesCore.h"
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class TTree        ; // ROOT
+class TObject      ; // ROOT
+class TTreeFormula ; // ROOT
+// ============================================================================
+namespace  Ostap
+{
+  // ==========================================================================
+  namespace  Utils
+  {
+    // ========================================================================
+    /** @class TreeCache Ostap/TreeCache.h
+     *  Local helper class to configure <code>TTreeCache</code> for the loop
+     *  - the branches, used by the formulas, are added to the cache,
+     *    and the learning phase is stopped
+     *  - the cache size is tuned to keep two clusters of these branches
+     *  - optionally (see TreeCache::setAsync) the asynchronous prefetching
+     *    of the next cluster is activated and the next (remote) file in chain
+     *    is opened asynchronously while the current one is processed
+     *  - at destruction the cache is reset to the default/previous size
+     *  The default is defined by the <code>OSTAP_TREE_CACHE</code> and
+     *  <code>OSTAP_ASYNC_PREFETCH</code> environment variables
+     *  @see TTreeCache
+     *  @see TTree::AddBranchToCache
+     *  @see TFile::AsyncOpen
+     *  @date 2023-03-12
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     */
+    class TreeCache
+    {
+    public:
+      // ======================================================================
+      /** constructor from the tree and the objects
+       *  @param tree    the tree
+       *  @param objects the objects, formulas are picked up
+       *  @param nested  the cache is already configured (add branches only)
+       */
+      TreeCache
+      ( TTree*                             tree           ,
+        const std::vector<const TObject*>& objects        ,
+        const bool                         nested = false ) ;
+      /// destructor: reset the cache
+      ~TreeCache () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// is the cache configured by this object ?
+      bool                         ok       () const { return m_ok       ; }
+      /// the branches added to the cache
+      const std::set<std::string>& branches () const { return m_branches ; }
+      /// the cache size
+      Long64_t                     size     () const { return m_size     ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// new tree in chain: open the next (remote) file asynchronously
+      void notify () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// configure TTreeCache for the loops?
+      static bool enabled    () ;
+      /// configure TTreeCache for the loops?
+      static void setEnabled ( const bool value ) ;
+      /// asynchronous prefetching ?
+      static bool async      () ;
+      /// asynchronous prefetching ?
+      static void setAsync   ( const bool value ) ;
+      // ======================================================================
+      /** collect the names of branches, used by the formula
+       *  @param formula  the formula
+       *  @param branches (UPDATE) the names of branches
+       *  @return number of added branches
+       */
+      static std::size_t collect
+      ( const TTreeFormula*    formula  ,
+        std::set<std::string>& branches ) ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      TreeCache             ( const TreeCache& ) = delete ;
+      TreeCache& operator=  ( const TreeCache& ) = delete ;
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the tree
+      TTree*                m_tree     { nullptr } ; // the tree
+      /// the branches
+      std::set<std::string> m_branches {}          ; // the branches
+      /// the cache size
+      Long64_t              m_size     { 0       } ; // the cache size
+      /// the previous cache size
+      Long64_t              m_old      { 0       } ; // the previous cache size
+      /// is cache configured by this object?
+      bool                  m_ok       { false   } ;
+      /// the last file in chain, opened asynchronously
+      int                   m_next     { -1      } ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                     The END
+// ============================================================================
+#endif // OSTAP_TREECACHE_H
+// ============================================================================
@@ -77,6 +77,35 @@ namespace Ostap
       /// get the results 
       Ostap::StatusCode   eval ( std::vector<double>& result ) const ;
       // ======================================================================
+      /** get the results for the range of entries  [first,last) 
+       *  - each expression must be scalar  
+       *  - the buffer is a plain 2D-array (e.g. numpy-array) 
+       *    for <code>(last-first)</code> rows and <code>size()</code> columns 
+       *  - switching between the trees in chain is treated internally 
+       *  @param first    the first entry 
+       *  @param last     the last entry (not included)
+       *  @param buffer   the buffer 
+       *  @param size     the size of the buffer 
+       *  @param rowmajor row-major (C) or column-major (Fortran) layout 
+       */
+      Ostap::StatusCode   eval_range 
+      ( const unsigned long first           , 
+        const unsigned long last            , 
+        double*             buffer          , 
+        const unsigned long size            , 
+        const bool          rowmajor = true ) const ;
+      /** get the results for the range of entries [first,last) 
+       *  @see Ostap::Trees::Getter::eval_range
+       */
+      Ostap::StatusCode   eval_range 
+      ( const unsigned long  first           , 
+        const unsigned long  last            , 
+        std::vector<double>& result          ,
+        const bool           rowmajor = true ) const ;
+      // ======================================================================
+      /// number of expressions 
+      std::size_t size () const { return m_formulas.size() ; }
+      // ======================================================================
     private:
       // ======================================================================
       /// The tree 
@@ -38,18 +38,22 @@ namespace Ostap
   public: 
     // ========================================================================
     /** calculate U-statistics 
-     *  @param pdf   (input) PDF
-     *  @param data  (input) data 
-     *  @param hist  (update) the histogram with U-statistics 
-     *  @param tStat (update) value for T-statistics 
-     *  @param args  (input)  the arguments
+     *  The distances to the nearest neighbours are calculated 
+     *  using k-d tree, \f$ \mathcal{O}(N\log N)\f$, in parallel 
+     *  @param pdf      (input) PDF
+     *  @param data     (input) data 
+     *  @param hist     (update) the histogram with U-statistics 
+     *  @param tStat    (update) value for T-statistics 
+     *  @param args     (input)  the arguments
+     *  @param nthreads (input)  number of threads (0: use default)
      */
     static Ostap::StatusCode calculate
-    ( const RooAbsPdf&  pdf       , 
-      const RooDataSet& data      ,  
-      TH1&              hist      ,
-      double&           tStat     ,
-      RooArgSet *       args  = 0 ) ;
+    ( const RooAbsPdf&   pdf          , 
+      const RooDataSet&  data         ,  
+      TH1&               hist         ,
+      double&            tStat        ,
+      RooArgSet *        args     = 0 , 
+      const unsigned int nthreads = 0 ) ;
     // ========================================================================
   };
   // ==========================================================================
@@ -0,0 +1,196 @@
+// ============================================================================
+#ifndef OSTAP_UPDATEFILES_H
+#define OSTAP_UPDATEFILES_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/AddBranch.h"
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class TTree   ; // from ROOT
+class TH1     ; // from ROOT
+// ============================================================================
+/** @file Ostap/UpdateFiles.h
+ *  Chain-wide update of the trees: the files are processed
+ *  concurrently with the bounded pool of threads
+ *  - each file is opened in <code>UPDATE</code> mode by one thread
+ *  - (optionally) the local file is updated via the temporary copy,
+ *    that atomically replaces the original file at the end,
+ *    therefore the original file is never left half-updated
+ *  @see Ostap::Trees::add_branch
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Trees
+  {
+    // ========================================================================
+    /** @struct UpdateStat
+     *  Statistics of the chain-wide update
+     */
+    struct UpdateStat
+    {
+      /// number of successfully updated files
+      unsigned long files   { 0 } ;
+      /// number of failed files
+      unsigned long failed  { 0 } ;
+      /// number of processed entries
+      unsigned long entries { 0 } ;
+      /// wall-clock time (seconds)
+      double        seconds { 0 } ;
+      /// throughput (entries per second)
+      double rate () const { return 0 < seconds ? entries / seconds : 0.0 ; }
+      /// all files are updated ?
+      bool   ok   () const { return 0 == failed ; }
+    } ;
+    // ========================================================================
+    /** @typedef TREEUPDATE
+     *  the function to update the tree from the file with the given index
+     */
+    typedef std::function<Ostap::StatusCode(TTree*,const std::size_t)> TREEUPDATE ;
+    // ========================================================================
+    /** update the trees with the given name in all files
+     *  @param files    the files
+     *  @param tree     the name of the tree (including the directory)
+     *  @param update   the function to update the tree
+     *  @param nthreads number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @param atomic   update the local files via the temporary copy
+     *  @return statistics of the update
+     *  @attention the function must be thread-safe for <code>nthreads!=1</code>
+     */
+    UpdateStat update_files
+    ( const std::vector<std::string>& files           ,
+      const std::string&              tree            ,
+      TREEUPDATE                      update          ,
+      const unsigned int              nthreads = 0    ,
+      const bool                      atomic   = true ) ;
+    // ========================================================================
+    /** add new branches to the trees in all files
+     *  - the formulas are created independently for each file,
+     *    the files are processed concurrently
+     *  @param files    the files
+     *  @param tree     the name of the tree (including the directory)
+     *  @param branches the map name->formula
+     *  @param nthreads number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @param atomic   update the local files via the temporary copy
+     *  @return statistics of the update
+     *  @see Ostap::Trees::add_branch
+     */
+    UpdateStat add_branch_files
+    ( const std::vector<std::string>&          files           ,
+      const std::string&                       tree            ,
+      const std::map<std::string,std::string>& branches        ,
+      const unsigned int                       nthreads = 0    ,
+      const bool                               atomic   = true ) ;
+    // ========================================================================
+    /** add new branches to the trees in all files
+     *  - the functions are shared, therefore the files are processed sequentially
+     *  @param files    the files
+     *  @param tree     the name of the tree (including the directory)
+     *  @param branches the map name->function
+     *  @param atomic   update the local files via the temporary copy
+     *  @return statistics of the update
+     *  @see Ostap::Trees::add_branch
+     */
+    UpdateStat add_branch_files
+    ( const std::vector<std::string>&          files           ,
+      const std::string&                       tree            ,
+      const FUNCTREEMAP&                       branches        ,
+      const bool                               atomic   = true ) ;
+    // ========================================================================
+    /** add new branch to the trees in all files, sampling it from the histogram
+     *  - the random generator is shared, therefore the files are processed sequentially
+     *  @param files    the files
+     *  @param tree     the name of the tree (including the directory)
+     *  @param name     the name of new branch
+     *  @param histo    the histogram to be sampled
+     *  @param atomic   update the local files via the temporary copy
+     *  @return statistics of the update
+     *  @see Ostap::Trees::add_branch
+     */
+    UpdateStat add_branch_files
+    ( const std::vector<std::string>&          files           ,
+      const std::string&                       tree            ,
+      const std::string&                       name            ,
+      const TH1&                               histo           ,
+      const bool                               atomic   = true ) ;
+    // ========================================================================
+#if ROOT_VERSION(6,24,0)<=ROOT_VERSION_CODE
+    // ========================================================================
+    /** copy data from the buffer into new branch in all files
+     *  - the buffer is split according to the numbers of entries in files,
+     *    the files are processed concurrently
+     *  @param files    the files
+     *  @param tree     the name of the tree (including the directory)
+     *  @param name     the name of new branch
+     *  @param data     the buffer
+     *  @param size     the length of the buffer
+     *  @param value    the default value (used for short buffers)
+     *  @param nthreads number of threads (0: use the size of ROOT MT pool or hardware concurrency)
+     *  @param atomic   update the local files via the temporary copy
+     *  @return statistics of the update
+     *  @see Ostap::Trees::add_branch
+     */
+    UpdateStat add_branch_files
+    ( const std::vector<std::string>&          files           ,
+      const std::string&                       tree            ,
+      const std::string&                       name            ,
+      const double*                            data            ,
+      const unsigned long                      size            ,
+      const double                             value    = 0    ,
+      const unsigned int                       nthreads = 0    ,
+      const bool                               atomic   = true ) ;
+    // ========================================================================
+    UpdateStat add_branch_files
+    ( const std::vector<std::string>&          files           ,
+      const std::string&                       tree            ,
+      const std::string&                       name            ,
+      const float*                             data            ,
+      const unsigned long                      size            ,
+      const float                              value    = 0    ,
+      const unsigned int                       nthreads = 0    ,
+      const bool                               atomic   = true ) ;
+    // ========================================================================
+    UpdateStat add_branch_files
+    ( const std::vector<std::string>&          files           ,
+      const std::string&                       tree            ,
+      const std::string&                       name            ,
+      const int*                               data            ,
+      const unsigned long                      size            ,
+      const int                                value    = 0    ,
+      const unsigned int                       nthreads = 0    ,
+      const bool                               atomic   = true ) ;
+    // ========================================================================
+    UpdateStat add_branch_files
+    ( const std::vector<std::string>&          files           ,
+      const std::string&                       tree            ,
+      const std::string&                       name            ,
+      const long*                              data            ,
+      const unsigned long                      size            ,
+      const long                               value    = 0    ,
+      const unsigned int                       nthreads = 0    ,
+      const bool                               atomic   = true ) ;
+    // ========================================================================
+#endif
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Trees
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_UPDATEFILES_H
+// ============================================================================
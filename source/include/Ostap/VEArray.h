@@ -0,0 +1,246 @@
+// ============================================================================
+#ifndef OSTAP_VEARRAY_H
+#define OSTAP_VEARRAY_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/ValueWithError.h"
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class TH1 ; // ROOT
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    /** @class VEArray Ostap/VEArray.h
+     *  Array of values with errors in "structure-of-arrays" layout:
+     *  values and squared uncertainties are kept in two separate
+     *  contiguous arrays, and all element-wise operations are
+     *  simple (vectorizable) loops over these arrays.
+     *
+     *  The error propagation is the same as for
+     *  Ostap::Math::ValueWithError, the elements are considered
+     *  as uncorrelated, negative covariances of the second operand
+     *  are ignored.
+     *
+     *  @code
+     *  const TH1& h1 = ... ;
+     *  const TH1& h2 = ... ;
+     *  VEArray a ( h1 ) , b ( h2 ) ;
+     *  VEArray r = a / b ;
+     *  r.to_histo ( h3 ) ;
+     *  @endcode
+     *  @see Ostap::Math::ValueWithError
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date 2023-02-01
+     */
+    class VEArray
+    {
+    public:
+      // ======================================================================
+      typedef std::vector<double>          Data ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// constructor: n identical elements
+      VEArray ( const std::size_t n     = 0 ,
+                const double      value = 0 ,
+                const double      cov2  = 0 ) ;
+      /// constructor from the values and (optional) squared uncertainties
+      VEArray ( const Data& values ,
+                const Data& cov2s  = Data () ) ;
+      /// constructor from the values and squared uncertainties
+      VEArray ( const double*     values ,
+                const double*     cov2s  ,
+                const std::size_t n      ) ;
+      /// constructor from the vector of values with errors
+      VEArray ( const ValueWithError::Vector& vct ) ;
+      /** constructor from the histogram: all cells of the histogram,
+       *  including underflow & overflow bins, in the order of global bin index
+       *  @see TH1::GetNcells
+       */
+      VEArray ( const TH1& histo ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of elements
+      inline std::size_t size  () const { return m_values.size  () ; }
+      /// empty ?
+      inline bool        empty () const { return m_values.empty () ; }
+      // ======================================================================
+      /// get the value
+      inline double value ( const std::size_t i ) const { return m_values [ i ] ; }
+      /// get the squared uncertainty
+      inline double cov2  ( const std::size_t i ) const { return m_cov2s  [ i ] ; }
+      /// get the uncertainty
+      inline double error ( const std::size_t i ) const
+      { return ValueWithError ( m_values [ i ] , m_cov2s [ i ] ).error () ; }
+      /// get the element
+      inline ValueWithError operator[] ( const std::size_t i ) const
+      { return ValueWithError ( m_values [ i ] , m_cov2s [ i ] ) ; }
+      /// get the element with the check of index
+      ValueWithError at ( const std::size_t i ) const ;
+      // ======================================================================
+      /// set the element
+      inline void set ( const std::size_t i , const ValueWithError& v )
+      { m_values [ i ] = v.value () ; m_cov2s [ i ] = v.cov2 () ; }
+      /// add the element
+      inline void push_back ( const ValueWithError& v )
+      { m_values.push_back ( v.value () ) ; m_cov2s.push_back ( v.cov2 () ) ; }
+      /// resize the array
+      void resize ( const std::size_t n ) ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// all values
+      inline const Data&   values      () const { return m_values        ; }
+      /// all squared uncertainties
+      inline const Data&   cov2s       () const { return m_cov2s         ; }
+      /// raw pointer to the values (e.g. for numpy)
+      inline const double* values_data () const { return m_values.data () ; }
+      /// raw pointer to the squared uncertainties (e.g. for numpy)
+      inline const double* cov2s_data  () const { return m_cov2s .data () ; }
+      /// raw pointer to the values
+      inline double*       values_data ()       { return m_values.data () ; }
+      /// raw pointer to the squared uncertainties
+      inline double*       cov2s_data  ()       { return m_cov2s .data () ; }
+      // ======================================================================
+      /// convert to the vector of values with errors
+      ValueWithError::Vector vector () const ;
+      /** put the content to the histogram: all cells, including
+       *  undeflow & overflow bins, in the order of global bin index
+       *  @see TH1::GetNcells
+       */
+      void to_histo ( TH1& histo ) const ;
+      // ======================================================================
+    public: // reductions
+      // ======================================================================
+      /// sum of all elements
+      ValueWithError sum              () const ;
+      /// arithmetic mean of all elements: sum/n
+      ValueWithError mean             () const ;
+      /** weighted average of all elements with weights 1/cov2,
+       *  elements with non-positive cov2 are ignored
+       *  (if there are no such elements, the plain mean of values is returned)
+       */
+      ValueWithError weighted_average () const ;
+      // ======================================================================
+    public: // element-wise operations
+      // ======================================================================
+      VEArray& operator+= ( const VEArray&        right ) ;
+      VEArray& operator-= ( const VEArray&        right ) ;
+      VEArray& operator*= ( const VEArray&        right ) ;
+      VEArray& operator/= ( const VEArray&        right ) ;
+      // ======================================================================
+      VEArray& operator+= ( const ValueWithError& right ) ;
+      VEArray& operator-= ( const ValueWithError& right ) ;
+      VEArray& operator*= ( const ValueWithError& right ) ;
+      VEArray& operator/= ( const ValueWithError& right ) ;
+      // ======================================================================
+      VEArray& operator+= ( const double          right ) ;
+      VEArray& operator-= ( const double          right ) ;
+      VEArray& operator*= ( const double          right ) ;
+      VEArray& operator/= ( const double          right ) ;
+      // ======================================================================
+      /// unary minus
+      VEArray  operator-  () const ;
+      // ======================================================================
+    public: // helper functions for Python:
+      // ======================================================================
+      VEArray __add__      ( const VEArray&        right ) const ;
+      VEArray __add__      ( const ValueWithError& right ) const ;
+      VEArray __add__      ( const double          right ) const ;
+      VEArray __sub__      ( const VEArray&        right ) const ;
+      VEArray __sub__      ( const ValueWithError& right ) const ;
+      VEArray __sub__      ( const double          right ) const ;
+      VEArray __mul__      ( const VEArray&        right ) const ;
+      VEArray __mul__      ( const ValueWithError& right ) const ;
+      VEArray __mul__      ( const double          right ) const ;
+      VEArray __truediv__  ( const VEArray&        right ) const ;
+      VEArray __truediv__  ( const ValueWithError& right ) const ;
+      VEArray __truediv__  ( const double          right ) const ;
+      // ======================================================================
+      ///     right + a
+      VEArray __radd__     ( const ValueWithError& right ) const { return __add__ ( right ) ; }
+      ///     right + a
+      VEArray __radd__     ( const double          right ) const { return __add__ ( right ) ; }
+      ///     right * a
+      VEArray __rmul__     ( const ValueWithError& right ) const { return __mul__ ( right ) ; }
+      ///     right * a
+      VEArray __rmul__     ( const double          right ) const { return __mul__ ( right ) ; }
+      ///     right - a
+      VEArray __rsub__     ( const ValueWithError& right ) const ;
+      ///     right - a
+      VEArray __rsub__     ( const double          right ) const ;
+      ///     right / a
+      VEArray __rtruediv__ ( const ValueWithError& right ) const ;
+      ///     right / a
+      VEArray __rtruediv__ ( const double          right ) const ;
+      // ======================================================================
+      VEArray __div__      ( const VEArray&        right ) const { return __truediv__   ( right ) ; }
+      VEArray __div__      ( const ValueWithError& right ) const { return __truediv__   ( right ) ; }
+      VEArray __div__      ( const double          right ) const { return __truediv__   ( right ) ; }
+      VEArray __rdiv__     ( const ValueWithError& right ) const { return __rtruediv__ ( right ) ; }
+      VEArray __rdiv__     ( const double          right ) const { return __rtruediv__ ( right ) ; }
+      // ======================================================================
+      VEArray __neg__      () const { return -(*this) ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// values
+      Data m_values ; // values
+      /// squared uncertainties
+      Data m_cov2s  ; // squared uncertainties
+      // ======================================================================
+    };
+    // ========================================================================
+    inline VEArray operator+ ( VEArray a , const VEArray&        b ) { a += b ; return a ; }
+    inline VEArray operator- ( VEArray a , const VEArray&        b ) { a -= b ; return a ; }
+    inline VEArray operator* ( VEArray a , const VEArray&        b ) { a *= b ; return a ; }
+    inline VEArray operator/ ( VEArray a , const VEArray&        b ) { a /= b ; return a ; }
+    // ========================================================================
+    inline VEArray operator+ ( VEArray a , const ValueWithError& b ) { a += b ; return a ; }
+    inline VEArray operator- ( VEArray a , const ValueWithError& b ) { a -= b ; return a ; }
+    inline VEArray operator* ( VEArray a , const ValueWithError& b ) { a *= b ; return a ; }
+    inline VEArray operator/ ( VEArray a , const ValueWithError& b ) { a /= b ; return a ; }
+    // ========================================================================
+    inline VEArray operator+ ( VEArray a , const double          b ) { a += b ; return a ; }
+    inline VEArray operator- ( VEArray a , const double          b ) { a -= b ; return a ; }
+    inline VEArray operator* ( VEArray a , const double          b ) { a *= b ; return a ; }
+    inline VEArray operator/ ( VEArray a , const double          b ) { a /= b ; return a ; }
+    // ========================================================================
+    inline VEArray operator+ ( const ValueWithError& b , VEArray a ) { a += b ; return a ; }
+    inline VEArray operator* ( const ValueWithError& b , VEArray a ) { a *= b ; return a ; }
+    inline VEArray operator- ( const ValueWithError& b , const VEArray& a ) { return a.__rsub__ ( b ) ; }
+    inline VEArray operator/ ( const ValueWithError& b , const VEArray& a ) { return a.__rtruediv__ ( b ) ; }
+    // ========================================================================
+    inline VEArray operator+ ( const double          b , VEArray a ) { a += b ; return a ; }
+    inline VEArray operator* ( const double          b , VEArray a ) { a *= b ; return a ; }
+    inline VEArray operator- ( const double          b , const VEArray& a ) { return a.__rsub__ ( b ) ; }
+    inline VEArray operator/ ( const double          b , const VEArray& a ) { return a.__rtruediv__ ( b ) ; }
+    // ========================================================================
+    /// element-wise exponent
+    VEArray exp ( const VEArray& a ) ;
+    /// element-wise natural logarithm
+    VEArray log ( const VEArray& a ) ;
+    /// element-wise power
+    VEArray pow ( const VEArray& a , const double b ) ;
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // OSTAP_VEARRAY_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
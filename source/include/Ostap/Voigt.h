@@ -45,6 +45,14 @@ namespace Ostap
       /// get the value of Voigt function
       // ======================================================================
       virtual double operator() ( const double x ) const ;
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
@@ -119,6 +127,14 @@ namespace Ostap
       /// get the value of Voigt function
       // ======================================================================
       virtual double operator() ( const double x ) const ;
+      /** evaluate the function for the array of points 
+       *  @param n      (INPUT)  number of points 
+       *  @param x      (INPUT)  array of points 
+       *  @param result (UPDATE) array of results 
+       */
+      void   evaluate   ( const std::size_t n      , 
+                          const double*     x      , 
+                          double*           result ) const ;
       // ======================================================================
     public:
       // ======================================================================
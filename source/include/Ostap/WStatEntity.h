@@ -25,6 +25,16 @@ namespace Ostap
     WStatEntity () = default ;
     /// constructor from StatEntity of values 
     WStatEntity ( const StatEntity& values ) ;
+    /** full constructor 
+     *  @param mu      (INPUT) the weighted mean-value 
+     *  @param mu2     (INPUT) the weighted second central moment  
+     *  @param values  (INPUT) statistic of values with non-zero weight 
+     *  @param weights (INPUT) statistic of weights 
+     */
+    WStatEntity ( const double      mu      , 
+                  const double      mu2     , 
+                  const StatEntity& values  , 
+                  const StatEntity& weights ) ;
     // ======================================================================
   public: // the basic getters 
     // ======================================================================
@@ -120,6 +130,30 @@ namespace Ostap
      *  @see https://doi.org/10.1007/s00180-015-0637-z
      */
     WStatEntity& add ( const WStatEntity& stat ) ;
+    /** add the arrays of values and weights 
+     *  The arrays are processed in blocks, the block statistics are 
+     *  accumulated in several independent lanes (vectorizable) and 
+     *  the block is folded into the counter once.
+     *  @param begin   (INPUT) begin of the sequence of values 
+     *  @param end     (INPUT) end   of the sequence of values 
+     *  @param weights (INPUT) the weights (null for unit weights)
+     *  @return self-reference 
+     */
+    WStatEntity& add 
+    ( const double* begin             , 
+      const double* end               , 
+      const double* weights = nullptr ) ;
+    /** add the arrays of values and weights 
+     *  @param n       (INPUT) number of values 
+     *  @param values  (INPUT) the values 
+     *  @param weights (INPUT) the weights (null for unit weights)
+     *  @return self-reference 
+     */
+    WStatEntity& add 
+    ( const std::size_t n                 , 
+      const double*     values            , 
+      const double*     weights = nullptr ) 
+    { return add ( values , values + n , weights ) ; }
     /// add another counter 
     WStatEntity& add ( const  StatEntity& stat ) 
     { return add ( WStatEntity (   stat ) ) ; }
@@ -4,6 +4,10 @@
 // ============================================================================
 // Include files
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <cstddef>
+// ============================================================================
 // ROOT 
 // ============================================================================
 #include "RVersion.h"
@@ -16,29 +20,81 @@ namespace Ostap
     // ========================================================================
     /** @class WorkSpace Ostap/Workspace.h
      *  helper utility to keep the integration workspace for GSL integration
+     *
+     *  The object itself keeps only the requested size of the workspace, 
+     *  the actual GSL-workspace is borrowed from the thread-local pool 
+     *  for each integration and returned back to the pool afterwards.
+     *  Therefore the same (const) object can be used concurrently from 
+     *  several threads and for the nested integrations, and the copies 
+     *  of the object are cheap.
+     *
+     *  @code
+     *  const WorkSpace ws ( 10000 ) ;
+     *  ...
+     *  {
+     *    const WorkSpace::Borrowed b = ws.borrow () ;
+     *    gsl_integration_workspace* w = (gsl_integration_workspace*) b.workspace() ;
+     *    ...
+     *  } // the workspace is returned back to the pool here
+     *  @endcode
      *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
      *  @date 2011-12-03
      */
     class WorkSpace
     {
+    public:
+      // ======================================================================
+      /** @class Borrowed 
+       *  The GSL-workspace, borrowed from the thread-local pool 
+       *  (and returned back to the pool by destructor)
+       *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+       *  @date 2023-01-26
+       */
+      class Borrowed
+      {
+      public:
+        // ====================================================================
+        /// borrow the workspace of the given size from the pool 
+        Borrowed  ( const std::size_t size  ) ;
+        /// move constructor 
+        Borrowed  (       Borrowed&&  right ) ;
+        /// destructor: return the workspace back to the pool 
+        ~Borrowed () ; 
+        /// no copy 
+        Borrowed  ( const Borrowed&   right ) = delete ;
+        /// no assignement 
+        Borrowed& operator= ( const Borrowed& right ) = delete ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        /// get the (borrowed) integration workspace
+        void* workspace () const { return m_workspace ; }
+        // ====================================================================
+      private:
+        // ====================================================================
+        /// the actual GSL-workspace 
+        void*       m_workspace ; // the actual GSL-workspace 
+        // ====================================================================
+      } ;
+      // ======================================================================
     public:
       // ======================================================================
       /// constructor
       WorkSpace  ( const std::size_t size  = 0 ) ;
-      /// (fictive) copy constructor
-      WorkSpace  ( const WorkSpace&  right ) ;
+      /// copy constructor
+      WorkSpace  ( const WorkSpace&  right ) = default ;
       /// move constructor 
-      WorkSpace  (       WorkSpace&& right ) ;
-      /// destructor
-      ~WorkSpace () ;
+      WorkSpace  (       WorkSpace&& right ) = default ;
       // ======================================================================
     public:
       // ======================================================================
-      /// get the integration workspace
-      void* workspace () const ;               // get the integration workspace
-      // ======================================================================
-      /// get the size of allocated workspace 
+      /** borrow the integration workspace from the thread-local pool 
+       *  @attention the workspace is returned back to the pool 
+       *             by destructor of the <code>Borrowed</code> object 
+       */
+      Borrowed borrow () const ;
       // ======================================================================
+      /// get the size of the workspace 
       std::size_t size () const { return m_size ; }
       // ======================================================================
     public:
@@ -48,25 +104,24 @@ namespace Ostap
       // ======================================================================
     public:
       // ======================================================================
-      /// (fictive) assignement operator
-      WorkSpace& operator= ( const WorkSpace&  right ) ;
+      /// copy assignement operator
+      WorkSpace& operator= ( const WorkSpace&  right ) = default ;
       /// move      assignement operator
-      WorkSpace& operator= (       WorkSpace&& right ) ;
+      WorkSpace& operator= (       WorkSpace&& right ) = default ;
       // ======================================================================
     public:
       // ======================================================================
       void swap ( WorkSpace& right ) ;
       // ======================================================================
-    private:
+    public:
       // ======================================================================
-      /// the actual GSL-workspace
-      /// mutable char*  m_workspace ;  /// the actual GSL-workspace
-      // char* here to please dictionary generator...
-      /// mutable char* m_workspace  { nullptr } ; //! the actual GSL-workspace
-      mutable void* m_workspace  { nullptr } ; //! the actual GSL-workspace
+      /// number of workspaces, kept in the pool of the current thread
+      static std::size_t pool_size () ;
+      // ======================================================================
+    private:
       // ======================================================================
-      /// size of the allocated workspace 
-      std::size_t   m_size       { 0 } ;   /// size of the allocated workspace 
+      /// size of the workspace 
+      std::size_t   m_size       { 0 } ;   /// size of the workspace 
       // ======================================================================
     } ;
     // ========================================================================
@@ -3,6 +3,10 @@
 // ============================================================================
 #include <string>
 #include <tuple>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <memory>
 // ============================================================================
 // ROOT
 // ============================================================================
@@ -18,6 +22,12 @@
 #include "Ostap/AddBranch.h"
 #include "Ostap/Funcs.h"
 #include "Ostap/Notifier.h"
+#include "Ostap/Formula.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
 // ============================================================================
 /** @file
  *  Implementation file for function Ostap::Trees::add_branch 
@@ -39,6 +49,155 @@ namespace
     INVALID_BUFFER        = 756 , 
   };
   // ==========================================================================
+  /// the block size for the batched evaluation of formula-based functions 
+  const Long64_t s_BLOCK = 4096 ;
+  // ==========================================================================
+  /** parse the branch name: the optional type suffix 
+   *  <code>"/F"</code> (float) or <code>"/D"</code> (double, default) 
+   *  @param name  (INPUT)  the branch name with optional suffix 
+   *  @param base  (OUTPUT) the branch name without suffix 
+   *  @return true for float branch 
+   */
+  inline bool float_branch ( const std::string& name , std::string& base ) 
+  {
+    const std::size_t n = name.size () ;
+    base = name ;
+    if ( 2 < n && '/' == name [ n - 2 ] && ( 'F' == name [ n - 1 ] || 'D' == name [ n - 1 ] ) ) 
+    { 
+      base = name.substr ( 0 , n - 2 ) ;
+      return 'F' == name [ n - 1 ] ;
+    }
+    return false ;
+  }
+  // ==========================================================================
+  /** is the function based on <code>TTreeFormula</code>? 
+   *  Such functions read the needed branches themselves, 
+   *  and <code>TTree::GetEntry</code> is not needed 
+   */
+  inline bool formula_based ( const Ostap::IFuncTree* f ) 
+  {
+    return 
+      nullptr != dynamic_cast<const Ostap::Functions::FuncFormula*> ( f ) || 
+      nullptr != dynamic_cast<const Ostap::Functions::Func1D*>      ( f ) || 
+      nullptr != dynamic_cast<const Ostap::Functions::Func2D*>      ( f ) || 
+      nullptr != dynamic_cast<const Ostap::Functions::Func3D*>      ( f ) ;
+  }
+  // ==========================================================================
+  /** add new branches to the tree in one pass:
+   *  - the entry is read once (only the needed branches 
+   *    are read for formula-based functions)
+   *  - all functions are evaluated into the preallocated buffers 
+   *  - all new branches are filled together 
+   *  @param tree      (UPDATE) the tree 
+   *  @param names     (INPUT) names of new branches (with optional "/F" suffix)
+   *  @param functions (INPUT) the functions 
+   *  @return status code 
+   */
+  Ostap::StatusCode 
+  _add_branches_ 
+  ( TTree*                                      tree      , 
+    const std::vector<std::string>&             names     , 
+    const std::vector<const Ostap::IFuncTree*>& functions ) 
+  {
+    if ( !tree ) { return Ostap::StatusCode ( INVALID_TREE ) ; }
+    //
+    const std::size_t N = functions.size() ;
+    // 
+    // unique functions: the same function for several branches is evaluated once 
+    std::vector<const Ostap::IFuncTree*> unique  ;
+    std::vector<std::size_t>             which   ( N ) ;
+    for ( std::size_t k = 0 ; k < N ; ++k ) 
+    {
+      if ( !functions [ k ] ) { return Ostap::StatusCode ( INVALID_TREEFUNCTION ) ; }
+      auto it = std::find ( unique.begin () , unique.end () , functions [ k ] ) ;
+      which [ k ] = it - unique.begin () ;
+      if ( unique.end () == it ) { unique.push_back ( functions [ k ] ) ; }
+    }
+    const std::size_t NU = unique.size () ;
+    //
+    std::vector<Double_t> results ( NU ) ;
+    std::vector<Double_t> dvalues ( N  ) ;
+    std::vector<Float_t>  fvalues ( N  ) ;
+    std::vector<bool>     floats  ( N  ) ;
+    std::vector<TBranch*> tbranches ( N ) ;
+    //
+    // Notifier
+    Ostap::Utils::Notifier notifier { tree } ;
+    //
+    bool load_only = true ;
+    for ( const Ostap::IFuncTree* func : unique ) 
+    {
+      const TObject* o = dynamic_cast<const TObject*>( func ) ;
+      if ( nullptr != o ) { notifier.add ( const_cast<TObject*> ( o ) ) ; }
+      if ( !formula_based ( func ) ) { load_only = false ; }
+    }
+    //
+    for ( std::size_t k = 0 ; k < N ; ++k ) 
+    {
+      std::string name ;
+      floats [ k ] = float_branch ( names [ k ] , name ) ;
+      TBranch* branch = floats [ k ] ? 
+        tree->Branch ( name.c_str() , &fvalues [ k ] , ( name + "/F" ).c_str() ) :
+        tree->Branch ( name.c_str() , &dvalues [ k ] , ( name + "/D" ).c_str() ) ;
+      if ( !branch ) { return Ostap::StatusCode ( CANNOT_CREATE_BRANCH ) ; }
+      tbranches [ k ] = branch ;
+    }
+    //
+    // due to some very strange reasons we need to invoke the Notifier explicitely.
+    // - otherwise crash could happen  
+    //
+    notifier.Notify() ;
+    //
+    const Long64_t nentries = tree->GetEntries(); 
+    //
+    // formula-based functions: evaluate them in blocks 
+    if ( load_only ) 
+    {
+      std::vector<Double_t> block ( NU * s_BLOCK ) ;
+      for ( Long64_t first = 0 ; first < nentries ; first += s_BLOCK ) 
+      {
+        const Long64_t last = std::min ( first + s_BLOCK , nentries ) ;
+        unsigned long  nb   = last - first ;
+        // evaluate the functions 
+        for ( std::size_t k = 0 ; k < NU ; ++k ) 
+        { nb = std::min ( nb , unique [ k ] -> evaluate_range ( tree , first , last , &block [ k * s_BLOCK ] ) ) ; }
+        //
+        for ( unsigned long j = 0 ; j < nb ; ++j ) 
+        {
+          // fill the buffers 
+          for ( std::size_t k = 0 ; k < N  ; ++k ) 
+          {
+            const Double_t r = block [ which [ k ] * s_BLOCK + j ] ;
+            if ( floats [ k ] ) { fvalues [ k ] = r ; }
+            else                { dvalues [ k ] = r ; }
+          }
+          // fill the branches
+          for ( std::size_t k = 0 ; k < N  ; ++k ) { tbranches [ k ] -> Fill ()     ; }
+        }
+        if ( nb < static_cast<unsigned long> ( last - first ) ) { break ; }
+      }
+      return Ostap::StatusCode::SUCCESS ; 
+    }
+    //
+    for ( Long64_t i = 0 ; i < nentries ; ++i )
+    {
+      if ( tree->GetEntry ( i ) < 0 ) { break ; };
+      //
+      // evaluate the functions
+      for ( std::size_t k = 0 ; k < NU ; ++k ) { results   [ k ] = (*unique [ k ]) ( tree ) ; }
+      // fill the buffers 
+      for ( std::size_t k = 0 ; k < N  ; ++k ) 
+      {
+        if ( floats [ k ] ) { fvalues [ k ] = results [ which [ k ] ] ; }
+        else                { dvalues [ k ] = results [ which [ k ] ] ; }
+      }
+      // fill the branches
+      for ( std::size_t k = 0 ; k < N  ; ++k ) { tbranches [ k ] -> Fill ()     ; }
+    }
+    //
+    return Ostap::StatusCode::SUCCESS ; 
+  }
+  // ==========================================================================
 }
 // ============================================================================
 /* add new branch with name <code>name</code> to the tree
@@ -58,30 +217,10 @@ Ostap::Trees::add_branch
   const Ostap::IFuncTree& func ) 
 {
   if ( !tree ) { return Ostap::StatusCode ( INVALID_TREE ) ; }
-  //
-  Double_t value    = 0  ;
-  TBranch* branch   = tree->Branch( name.c_str() , &value , (name + "/D").c_str() );
-  if ( !branch ) { return Ostap::StatusCode ( CANNOT_CREATE_BRANCH ) ; }
-  //
-  const TObject* o = dynamic_cast<const TObject*>( &func ) ;
-  //
-  Ostap::Utils::Notifier notifier { tree , o ? const_cast<TObject*>(o) : nullptr } ;
-  //
-  // due to  some strange reasons we need to invoke the Notifier explicitely.
-  // - otherwise FuncTH1::Notify causes crash..
-  notifier.Notify() ;
-  //
-  const Long64_t nentries = tree->GetEntries(); 
-  for ( Long64_t i = 0 ; i < nentries ; ++i )
-  {
-    if ( tree->GetEntry ( i ) < 0 ) { break ; };
-    //
-    value  =  func ( tree  ) ;
-    //
-    branch -> Fill (       ) ;
-  }
-  //
-  return Ostap::StatusCode::SUCCESS ;  
+  return _add_branches_ 
+    ( tree                                                , 
+      std::vector<std::string>             ( 1 , name  ) , 
+      std::vector<const Ostap::IFuncTree*> ( 1 , &func ) ) ;
 }
 // =============================================================================
 /*   add new branch with name <code>name</code> to the tree
@@ -129,32 +268,26 @@ Ostap::Trees::add_branch
   if      ( !tree            ) { return Ostap::StatusCode ( INVALID_TREE ) ; }
   else if ( branches.empty() ) { return Ostap::StatusCode::SUCCESS         ; }
   //
-  typedef FUNCTREEMAP                                                  MAP   ;
-  typedef std::vector<std::unique_ptr<Ostap::Functions::FuncFormula> > STORE ;
-  //
-  STORE store ;
-  MAP   map ;
+  typedef std::unique_ptr<Ostap::Functions::FuncFormula> UFF ;
   //
-  store.reserve( branches.size () ) ;
-  //
-  Ostap::Utils::Notifier notifier ( tree ) ;
+  // identical formulas are shared 
+  std::map<std::string,UFF>            formulas  ;
+  std::vector<std::string>             names     ;
+  std::vector<const Ostap::IFuncTree*> functions ;
   //
   for ( const auto& entry : branches )
   {
-    store.emplace_back ( std::make_unique<Ostap::Functions::FuncFormula>( entry.second ,  tree ) ) ;
-    auto const& func = store.back() ;
-    if ( !func ) { return Ostap::StatusCode ( CANNOT_CREATE_FORMULA ) ; }
-    //
-    notifier.add ( func.get() )   ;
-    map [ entry.first ] = func.get () ;    
-    //
+    UFF& func = formulas [ entry.second ] ;
+    if ( !func ) 
+    {
+      func = std::make_unique<Ostap::Functions::FuncFormula>( entry.second ,  tree ) ;
+      if ( !func ) { return Ostap::StatusCode ( CANNOT_CREATE_FORMULA ) ; }
+    }
+    names    .push_back ( entry.first ) ;
+    functions.push_back ( func.get () ) ;
   }
   //
-  // due to some very strange reasons we need to invoke the Notifier explicitely.
-  // - otherwise crash could happen causes crash..
-  notifier.Notify() ;
-  //
-  return add_branch ( tree , map ) ;
+  return _add_branches_ ( tree , names , functions ) ;
 }
 // ============================================================================
 /*  add new branches to the tree
@@ -176,55 +309,15 @@ Ostap::Trees::add_branch
   if      ( !tree            ) { return Ostap::StatusCode ( INVALID_TREE ) ; }
   else if ( branches.empty() ) { return Ostap::StatusCode::SUCCESS         ; }
   //
-  typedef std::vector<const Ostap::IFuncTree*> FUNCTIONS ;
-  typedef std::vector<double>                  VALUES    ;
-  typedef std::vector<TBranch*>                BRANCHES  ;
-  //
-  const std::size_t N = branches.size() ;
-  VALUES    values    ( N ) ;
-  BRANCHES  tbranches ( N ) ;
-  FUNCTIONS functions ( N ) ;
-  //
-  // Notifier
-  Ostap::Utils::Notifier notifier { tree } ;
-  //
-  unsigned int index = 0 ;
+  std::vector<std::string>             names     ;
+  std::vector<const Ostap::IFuncTree*> functions ;
   for ( const auto& entry : branches ) 
   {
-    const auto&             name = entry.first  ;
-    const Ostap::IFuncTree* func = entry.second ;
-    if ( !func   ) { return Ostap::StatusCode ( INVALID_TREEFUNCTION ) ; }
-    functions [ index ] = func ;
-    //
-    const TObject* o = dynamic_cast<const TObject*>( func ) ;
-    if ( nullptr != o ) { notifier.add ( const_cast<TObject*> ( o ) ) ; }
-    //
-    TBranch* branch   = tree->Branch
-      ( name.c_str() ,
-        &values[index] , (name + "/D").c_str() );
-    if ( !branch ) { return Ostap::StatusCode ( CANNOT_CREATE_BRANCH ) ; }
-    tbranches [ index ] = branch ;
-    //
-    ++index ;
-  }
-  //
-  // due to some very strange reasons we need to invoke the Notifier explicitely.
-  // - otherwise crash could happen  
-  //
-  notifier.Notify() ;
-  //
-  const Long64_t nentries = tree->GetEntries(); 
-  for ( Long64_t i = 0 ; i < nentries ; ++i )
-  {
-    if ( tree->GetEntry ( i ) < 0 ) { break ; };
-    //
-    // evaluate the functions
-    for ( unsigned int k = 0 ; k < N ; ++k ) { values    [ k ] = (*functions[ k ]) ( tree ) ; }
-    // fill the branches
-    for ( unsigned int j = 0 ; j < N ; ++j ) { tbranches [ j ] -> Fill ()                   ; }
+    names    .push_back ( entry.first  ) ;
+    functions.push_back ( entry.second ) ;
   }
   //
-  return Ostap::StatusCode::SUCCESS ; 
+  return _add_branches_ ( tree , names , functions ) ;
 }
 // ============================================================================
 /*  add new branch to TTree, sampling it from   the 1D-histogram
@@ -568,6 +661,167 @@ Ostap::Trees::add_branch
 
 
 
+// ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /** @class FormulaWorker
+   *  Thread-local worker for the multithreaded Ostap::Trees::add_branchMT:
+   *  evaluate the formulas for the chunk and fill the column buffers 
+   *  @see Ostap::Utils::process_ordered 
+   */
+  class FormulaWorker 
+  {
+  public:
+    // ========================================================================
+    FormulaWorker ( const std::vector<std::string>& expressions , 
+                    TTree*                          tree        ) 
+      : m_tree ( tree ) 
+    {
+      for ( const auto& e : expressions ) 
+      {
+        m_formulas.emplace_back ( std::make_unique<Ostap::Formula> ( e , tree ) ) ;
+        Ostap::Assert ( m_formulas.back()->ok ()         , 
+                        "Invalid formula:\"" + e + "\"" , 
+                        "Ostap::Trees::add_branchMT"     ) ;
+      }
+      m_notifier = std::make_unique<Ostap::Utils::Notifier> 
+        ( m_formulas.begin() , m_formulas.end() , tree ) ;
+    }
+    // ========================================================================
+    void operator() ( const Ostap::Utils::Chunk& chunk , 
+                      std::vector<double>&       data  ) 
+    {
+      const std::size_t N    = m_formulas.size () ;
+      const std::size_t size = chunk.size () ;
+      data.assign ( N * size , 0.0 ) ;
+      for ( std::size_t i = 0 ; i < size ; ++i ) 
+      {
+        Long64_t ievent = m_tree->GetEntryNumber ( chunk.first + i ) ;
+        Ostap::Assert ( 0 <= ievent , "Invalid entry" , "Ostap::Trees::add_branchMT" ) ;
+        ievent          = m_tree->LoadTree       ( ievent ) ;
+        Ostap::Assert ( 0 <= ievent , "Invalid entry" , "Ostap::Trees::add_branchMT" ) ;
+        // column buffers 
+        for ( std::size_t k = 0 ; k < N ; ++k ) 
+        { data [ k * size + i ] = m_formulas [ k ]->evaluate () ; }
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the tree (thread copy) 
+    TTree*                                       m_tree     { nullptr } ;
+    /// formulas 
+    std::vector<std::unique_ptr<Ostap::Formula>> m_formulas {} ;
+    /// notifier (destroyed before formulas)
+    std::unique_ptr<Ostap::Utils::Notifier>      m_notifier {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+}
+// ============================================================================
+/*  add new branches to the tree using several threads 
+ *  @param tree     input tree 
+ *  @param branches the map name->formula use to calculate new branch
+ *  @param nthreads number of threads 
+ *  @return status code 
+ *  @see Ostap::Trees::add_branch 
+ *  @date 2023-01-29
+ */
+// ============================================================================
+Ostap::StatusCode 
+Ostap::Trees::add_branchMT
+( TTree*                                   tree     ,  
+  const std::map<std::string,std::string>& branches , 
+  const unsigned int                       nthreads ) 
+{
+  //
+  if      ( !tree            ) { return Ostap::StatusCode ( INVALID_TREE ) ; }
+  else if ( branches.empty() ) { return Ostap::StatusCode::SUCCESS         ; }
+  //
+  const unsigned int nt = Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) ) 
+  { return add_branch ( tree , branches ) ; }
+  //
+  // validate the formulas using the original tree 
+  std::vector<std::string> names       ;
+  std::vector<std::string> expressions ;
+  for ( const auto& entry : branches ) 
+  {
+    if ( !Ostap::Formula ( entry.second , tree ).ok() ) 
+    { return Ostap::StatusCode ( CANNOT_CREATE_FORMULA ) ; }
+    names      .push_back ( entry.first  ) ;
+    expressions.push_back ( entry.second ) ;
+  }
+  const std::size_t N = names.size() ;
+  //
+  // split into chunks: aligned with the clusters, at most 1M entries per chunk 
+  const unsigned long nentries = tree->GetEntries () ;
+  const unsigned int  nchunks  = std::max ( 4 * nt , (unsigned int) ( nentries >> 20 ) + 1 ) ;
+  const Ostap::Utils::Chunks chunks = Ostap::Utils::clusters ( tree , 0 , nentries , nchunks ) ;
+  //
+  // create the branches 
+  std::vector<Double_t> dvalues   ( N ) ;
+  std::vector<Float_t>  fvalues   ( N ) ;
+  std::vector<bool>     floats    ( N ) ;
+  std::vector<TBranch*> tbranches ( N ) ;
+  // the basket size, tuned for the cluster size
+  const Long64_t autoflush = tree->GetAutoFlush () ;
+  const Int_t    bsize     = 0 < autoflush ? 
+    Int_t ( std::min ( std::max ( autoflush * Long64_t ( sizeof ( Double_t ) ) + 1024 , Long64_t ( 32000 ) ) , 
+                       Long64_t ( 16 * 1024 * 1024 ) ) ) : 32000 ;
+  for ( std::size_t k = 0 ; k < N ; ++k ) 
+  {
+    std::string name ;
+    floats [ k ] = float_branch ( names [ k ] , name ) ;
+    TBranch* branch = floats [ k ] ? 
+      tree->Branch ( name.c_str() , &fvalues [ k ] , ( name + "/F" ).c_str() , bsize ) : 
+      tree->Branch ( name.c_str() , &dvalues [ k ] , ( name + "/D" ).c_str() , bsize ) ;
+    if ( !branch ) { return Ostap::StatusCode ( CANNOT_CREATE_BRANCH ) ; }
+    tbranches [ k ] = branch ;
+  }
+  //
+  // workers: evaluate the formulas; writer: fill the branches in order 
+  Ostap::Utils::process_ordered 
+    ( tree , chunks , nt , 
+      [&expressions] ( TTree* t ) { return FormulaWorker ( expressions , t ) ; } , 
+      [&] ( const Ostap::Utils::Chunk& chunk , const std::vector<double>& data ) 
+      {
+        const std::size_t size = chunk.size () ;
+        for ( std::size_t i = 0 ; i < size ; ++i ) 
+        {
+          for ( std::size_t k = 0 ; k < N ; ++k ) 
+          {
+            if ( floats [ k ] ) { fvalues [ k ] = data [ k * size + i ] ; }
+            else                { dvalues [ k ] = data [ k * size + i ] ; }
+          }
+          for ( std::size_t k = 0 ; k < N ; ++k ) { tbranches [ k ] -> Fill () ; }
+        }
+      } ) ;
+  //
+  return Ostap::StatusCode::SUCCESS ; 
+}
+// ============================================================================
+/*  add new branch with name <code>name</code> to the tree using several threads 
+ *  @param tree     input tree 
+ *  @param name     the name for new branch 
+ *  @param formula  the fomula use to calculate new  branch
+ *  @param nthreads number of threads
+ *  @return status code 
+ *  @see Ostap::Trees::add_branchMT
+ *  @date 2023-01-29
+ */
+// ============================================================================
+Ostap::StatusCode 
+Ostap::Trees::add_branchMT
+( TTree*             tree     ,  
+  const std::string& name     , 
+  const std::string& formula  , 
+  const unsigned int nthreads ) 
+{
+  const std::map<std::string,std::string> branches { { name , formula } } ;
+  return add_branchMT ( tree , branches , nthreads ) ;
+}
 // ============================================================================
 //                                                                      The END 
 // ============================================================================
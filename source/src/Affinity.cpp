@@ -0,0 +1,225 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <atomic>
+#include <thread>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+// ============================================================================
+#if defined(__linux__)
+#include <sched.h>
+#include <pthread.h>
+#endif
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Affinity.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Utils::Affinity
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// the placement policy
+  std::atomic<int>  s_policy   { Ostap::Utils::Affinity::None } ;
+  /// merge per node?
+  std::atomic<bool> s_premerge { true } ;
+  // ==========================================================================
+  /** parse the list of CPUs/nodes in the kernel format, e.g.
+   *  <code>"0-15,32-47"</code>
+   */
+  std::vector<unsigned int> _parse_list_ ( const std::string& line )
+  {
+    std::vector<unsigned int> result ;
+    std::stringstream ss ( line ) ;
+    std::string item ;
+    while ( std::getline ( ss , item , ',' ) )
+    {
+      if ( item.empty () ) { continue ; }
+      const std::string::size_type dash = item.find ( '-' ) ;
+      try
+      {
+        const unsigned long a = std::stoul ( item.substr ( 0 , dash ) ) ;
+        const unsigned long b = std::string::npos == dash ? a : std::stoul ( item.substr ( dash + 1 ) ) ;
+        for ( unsigned long i = a ; i <= b ; ++i ) { result.push_back ( i ) ; }
+      }
+      catch ( ... ) { return std::vector<unsigned int> () ; }           // RETURN
+    }
+    return result ;
+  }
+  // ==========================================================================
+  /// read the first line of the file
+  std::string _read_line_ ( const std::string& name )
+  {
+    std::ifstream file ( name ) ;
+    std::string   line ;
+    if ( file ) { std::getline ( file , line ) ; }
+    return line ;
+  }
+  // ==========================================================================
+  /** @struct Topology
+   *  the NUMA nodes and their (allowed) CPUs
+   */
+  struct Topology
+  {
+    Topology ()
+    {
+      std::vector<unsigned int> allowed ;
+#if defined(__linux__)
+      cpu_set_t set ;
+      CPU_ZERO ( &set ) ;
+      if ( 0 == sched_getaffinity ( 0 , sizeof ( set ) , &set ) )
+      { for ( unsigned int c = 0 ; c < CPU_SETSIZE ; ++c ) { if ( CPU_ISSET ( c , &set ) ) { allowed.push_back ( c ) ; } } }
+      //
+      const std::string base = "/sys/devices/system/node/" ;
+      for ( const unsigned int n : _parse_list_ ( _read_line_ ( base + "online" ) ) )
+      {
+        std::vector<unsigned int> cs = _parse_list_
+          ( _read_line_ ( base + "node" + std::to_string ( n ) + "/cpulist" ) ) ;
+        if ( !allowed.empty () )
+        {
+          cs.erase ( std::remove_if ( cs.begin () , cs.end () ,
+                                      [&allowed] ( const unsigned int c )
+                                      { return !std::binary_search ( allowed.begin () , allowed.end () , c ) ; } ) ,
+                     cs.end () ) ;
+        }
+        if ( !cs.empty () ) { nodes.push_back ( cs ) ; }
+      }
+#endif
+      // fallback: one node with all CPUs
+      if ( nodes.empty () )
+      {
+        if ( allowed.empty () )
+        {
+          const unsigned int n = std::max ( 1u , std::thread::hardware_concurrency () ) ;
+          for ( unsigned int c = 0 ; c < n ; ++c ) { allowed.push_back ( c ) ; }
+        }
+        nodes.push_back ( allowed ) ;
+      }
+      for ( const auto& n : nodes ) { ncpus += n.size () ; }
+    }
+    /// CPUs per node
+    std::vector<std::vector<unsigned int> > nodes {}    ;
+    /// total number of CPUs
+    std::size_t                             ncpus { 0 } ;
+  } ;
+  // ==========================================================================
+  /// the topology (detected once)
+  const Topology& topology ()
+  {
+    static const Topology s_topology {} ;
+    return s_topology ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// the current placement policy
+// ============================================================================
+Ostap::Utils::Affinity::Policy
+Ostap::Utils::Affinity::policy ()
+{ return static_cast<Policy> ( s_policy.load () ) ; }
+// ============================================================================
+// set the placement policy
+// ============================================================================
+Ostap::Utils::Affinity::Policy
+Ostap::Utils::Affinity::setPolicy ( const Ostap::Utils::Affinity::Policy value )
+{ return static_cast<Policy> ( s_policy.exchange ( value ) ) ; }
+// ============================================================================
+// merge the partial results per node?
+// ============================================================================
+bool Ostap::Utils::Affinity::premerge    () { return s_premerge.load () ; }
+// ============================================================================
+// merge the partial results per node?
+// ============================================================================
+bool Ostap::Utils::Affinity::setPremerge ( const bool value )
+{ return s_premerge.exchange ( value ) ; }
+// ============================================================================
+// number of NUMA nodes
+// ============================================================================
+unsigned int Ostap::Utils::Affinity::nNodes () { return topology ().nodes.size () ; }
+// ============================================================================
+// the (allowed) CPUs of the node
+// ============================================================================
+const std::vector<unsigned int>&
+Ostap::Utils::Affinity::cpus ( const unsigned int node )
+{
+  const Topology& t = topology () ;
+  return t.nodes [ node % t.nodes.size () ] ;
+}
+// ============================================================================
+// the node for the thread according to the current policy
+// ============================================================================
+unsigned int Ostap::Utils::Affinity::node
+( const unsigned int ithread  ,
+  const unsigned int /* nthreads */ )
+{
+  const Topology& t = topology () ;
+  if ( 1 == t.nodes.size () ) { return 0 ; }                         // RETURN
+  //
+  switch ( policy () )
+  {
+  case Scatter : return ithread % t.nodes.size () ;                  // RETURN
+  case Compact :
+    {
+      // fill the CPUs of the first node, then the next node, etc.
+      std::size_t slot = ithread % t.ncpus ;
+      for ( unsigned int k = 0 ; k < t.nodes.size () ; ++k )
+      {
+        if ( slot < t.nodes [ k ].size () ) { return k ; }             // RETURN
+        slot -= t.nodes [ k ].size () ;
+      }
+      return 0 ;
+    }
+  default : return 0 ;
+  }
+}
+// ============================================================================
+// pin the current thread to the CPUs of the node
+// ============================================================================
+bool Ostap::Utils::Affinity::pin ( const unsigned int node )
+{
+  if ( !enabled () ) { return false ; }                              // RETURN
+#if defined(__linux__)
+  cpu_set_t set ;
+  CPU_ZERO ( &set ) ;
+  for ( const unsigned int c : cpus ( node ) ) { if ( c < CPU_SETSIZE ) { CPU_SET ( c , &set ) ; } }
+  return 0 == pthread_setaffinity_np ( pthread_self () , sizeof ( set ) , &set ) ;
+#else
+  return false ;
+#endif
+}
+// ============================================================================
+// partition the items into contiguous blocks, one per node
+// ============================================================================
+std::vector<std::size_t>
+Ostap::Utils::Affinity::blocks
+( const std::size_t  nitems   ,
+  const unsigned int nthreads )
+{
+  const unsigned int nn = nNodes () ;
+  if ( !enabled () || 1 == nn || nthreads <= 1 ) { return { 0 , nitems } ; }  // RETURN
+  //
+  // number of threads per node
+  std::vector<std::size_t> counts ( nn , 0 ) ;
+  for ( unsigned int i = 0 ; i < nthreads ; ++i ) { ++counts [ node ( i , nthreads ) ] ; }
+  //
+  std::vector<std::size_t> result ( nn + 1 , 0 ) ;
+  std::size_t threads = 0 ;
+  for ( unsigned int k = 0 ; k < nn ; ++k )
+  {
+    threads        += counts [ k ] ;
+    result [ k + 1 ] = ( nitems * threads ) / nthreads ;
+  }
+  return result ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
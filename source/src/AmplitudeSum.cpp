@@ -0,0 +1,380 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/AmplitudeSum.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Math::AmplitudeSum
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /** calculate the amplitudes for the sample (SoA)
+   *  @param bw      the resonance
+   *  @param masses  the masses
+   *  @param factors the (optional) complex factors
+   *  @param re      (OUTPUT) real parts
+   *  @param im      (OUTPUT) imaginary parts
+   */
+  void _amplitudes_
+  ( const Ostap::Math::BW&                     bw      ,
+    const Ostap::Math::AmplitudeSum::Values&  masses  ,
+    const Ostap::Math::AmplitudeSum::Factors& factors ,
+    Ostap::Math::AmplitudeSum::Values&        re      ,
+    Ostap::Math::AmplitudeSum::Values&        im      )
+  {
+    const std::size_t n = masses.size () ;
+    re.resize ( n ) ;
+    im.resize ( n ) ;
+    if ( factors.empty () )
+    {
+      for ( std::size_t e = 0 ; e < n ; ++e )
+      {
+        const std::complex<double> a = bw.amplitude ( masses [ e ] ) ;
+        re [ e ] = a.real () ;
+        im [ e ] = a.imag () ;
+      }
+    }
+    else
+    {
+      for ( std::size_t e = 0 ; e < n ; ++e )
+      {
+        const std::complex<double> a = bw.amplitude ( masses [ e ] ) * factors [ e ] ;
+        re [ e ] = a.real () ;
+        im [ e ] = a.imag () ;
+      }
+    }
+  }
+  // ==========================================================================
+}
+// ============================================================================
+/*  constructor
+ *  @param ndata    size of the data sample
+ *  @param nnorm    size of the normalization sample
+ *  @param weights  (optional) weights for the normalization sample
+ */
+// ============================================================================
+Ostap::Math::AmplitudeSum::AmplitudeSum
+( const std::size_t ndata   ,
+  const std::size_t nnorm   ,
+  const Values&     weights )
+  : m_ndata   ( ndata   )
+  , m_nnorm   ( nnorm   )
+  , m_weights ( weights )
+{
+  Ostap::Assert ( m_weights.empty () || m_weights.size () == m_nnorm ,
+                  "Invalid size of weights"                          ,
+                  "Ostap::Math::AmplitudeSum"                        ) ;
+  m_sumw = m_weights.empty () ? double ( m_nnorm ) :
+    std::accumulate ( m_weights.begin () , m_weights.end () , 0.0 ) ;
+}
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::Math::AmplitudeSum::AmplitudeSum
+( const Ostap::Math::AmplitudeSum& right )
+  : m_ndata      ( right.m_ndata   )
+  , m_nnorm      ( right.m_nnorm   )
+  , m_weights    ( right.m_weights )
+  , m_sumw       ( right.m_sumw    )
+  , m_components ()
+  , m_matrix     ( right.m_matrix  )
+{
+  m_components.reserve ( right.m_components.size () ) ;
+  for ( const Component& c : right.m_components )
+  {
+    Component n ;
+    n.bw.reset ( c.bw->clone () ) ;
+    n.coupling = c.coupling ;
+    n.mdata    = c.mdata    ;
+    n.mnorm    = c.mnorm    ;
+    n.fdata    = c.fdata    ;
+    n.fnorm    = c.fnorm    ;
+    n.dre      = c.dre      ;
+    n.dim      = c.dim      ;
+    n.nre      = c.nre      ;
+    n.nim      = c.nim      ;
+    n.tag      = c.tag      ;
+    n.valid    = c.valid    ;
+    m_components.push_back ( std::move ( n ) ) ;
+  }
+}
+// ============================================================================
+/*  add the resonance
+ *  @param bw       the resonance amplitude
+ *  @param mdata    the masses for the data sample
+ *  @param mnorm    the masses for the normalization sample
+ *  @param coupling the complex coupling
+ *  @param fdata    (optional) the complex factors for the data sample
+ *  @param fnorm    (optional) the complex factors for the normalization sample
+ *  @return the index of the resonance
+ */
+// ============================================================================
+std::size_t Ostap::Math::AmplitudeSum::add
+( const Ostap::Math::BW& bw       ,
+  const Values&          mdata    ,
+  const Values&          mnorm    ,
+  const complex_type     coupling ,
+  const Factors&         fdata    ,
+  const Factors&         fnorm    )
+{
+  static const char s_tag [] = "Ostap::Math::AmplitudeSum::add" ;
+  Ostap::Assert ( mdata.size () == m_ndata                      ,
+                  "Invalid size of data sample"                 , s_tag ) ;
+  Ostap::Assert ( mnorm.size () == m_nnorm                      ,
+                  "Invalid size of normalization sample"        , s_tag ) ;
+  Ostap::Assert ( fdata.empty () || fdata.size () == m_ndata    ,
+                  "Invalid size of data factors"                , s_tag ) ;
+  Ostap::Assert ( fnorm.empty () || fnorm.size () == m_nnorm    ,
+                  "Invalid size of normalization factors"       , s_tag ) ;
+  //
+  Component c ;
+  c.bw.reset ( bw.clone () ) ;
+  c.coupling = coupling ;
+  c.mdata    = mdata    ;
+  c.mnorm    = mnorm    ;
+  c.fdata    = fdata    ;
+  c.fnorm    = fnorm    ;
+  m_components.push_back ( std::move ( c ) ) ;
+  //
+  // extend the interference matrix
+  const std::size_t K = m_components.size () ;
+  Factors matrix ( K * K ) ;
+  for ( std::size_t j = 0 ; j + 1 < K ; ++j )
+  { for ( std::size_t k = 0 ; k + 1 < K ; ++k )
+    { matrix [ j * K + k ] = m_matrix [ j * ( K - 1 ) + k ] ; } }
+  m_matrix.swap ( matrix ) ;
+  //
+  return K - 1 ;
+}
+// ============================================================================
+// get the resonance (parameters can be modified)
+// ============================================================================
+Ostap::Math::BW&
+Ostap::Math::AmplitudeSum::resonance ( const std::size_t i )
+{
+  Ostap::Assert ( i < m_components.size () , "Invalid index" , "Ostap::Math::AmplitudeSum" ) ;
+  return *m_components [ i ].bw ;
+}
+// ============================================================================
+// get the resonance
+// ============================================================================
+const Ostap::Math::BW&
+Ostap::Math::AmplitudeSum::resonance ( const std::size_t i ) const
+{
+  Ostap::Assert ( i < m_components.size () , "Invalid index" , "Ostap::Math::AmplitudeSum" ) ;
+  return *m_components [ i ].bw ;
+}
+// ============================================================================
+// get the coupling
+// ============================================================================
+const Ostap::Math::AmplitudeSum::complex_type&
+Ostap::Math::AmplitudeSum::coupling ( const std::size_t i ) const
+{
+  Ostap::Assert ( i < m_components.size () , "Invalid index" , "Ostap::Math::AmplitudeSum" ) ;
+  return m_components [ i ].coupling ;
+}
+// ============================================================================
+// set the coupling
+// ============================================================================
+bool Ostap::Math::AmplitudeSum::setCoupling
+( const std::size_t   i ,
+  const complex_type& c )
+{
+  if ( m_components.size () <= i       ) { return false ; }
+  if ( m_components [ i ].coupling == c ) { return false ; }
+  m_components [ i ].coupling = c ;
+  return true ;
+}
+// ============================================================================
+// recalculate the amplitudes for the component
+// ============================================================================
+void Ostap::Math::AmplitudeSum::calculate ( const Component& c ) const
+{
+  _amplitudes_ ( *c.bw , c.mdata , c.fdata , c.dre , c.dim ) ;
+  _amplitudes_ ( *c.bw , c.mnorm , c.fnorm , c.nre , c.nim ) ;
+  c.tag   = c.bw->tag () ;
+  c.valid = true ;
+}
+// ============================================================================
+/*  refresh the cached amplitudes for the modified resonances
+ *  @return number of recalculated resonances
+ */
+// ============================================================================
+std::size_t Ostap::Math::AmplitudeSum::update () const
+{
+  const std::size_t K = m_components.size () ;
+  //
+  std::vector<bool> changed ( K , false ) ;
+  std::size_t nchanged = 0 ;
+  for ( std::size_t j = 0 ; j < K ; ++j )
+  {
+    const Component& c = m_components [ j ] ;
+    if ( c.valid && c.tag == c.bw->tag () ) { continue ; }
+    calculate ( c ) ;
+    changed [ j ] = true ;
+    ++nchanged ;
+  }
+  if ( 0 == nchanged ) { return 0 ; }
+  //
+  // update the rows/columns of the interference matrix
+  const bool   weighted = !m_weights.empty () ;
+  const double scale    = 0 < m_sumw ? 1.0 / m_sumw : 0.0 ;
+  for ( std::size_t j = 0 ; j < K ; ++j )
+  {
+    const Component& cj = m_components [ j ] ;
+    const double* jre = cj.nre.data () ;
+    const double* jim = cj.nim.data () ;
+    for ( std::size_t k = j ; k < K ; ++k )
+    {
+      if ( !changed [ j ] && !changed [ k ] ) { continue ; }
+      const Component& ck = m_components [ k ] ;
+      const double* kre = ck.nre.data () ;
+      const double* kim = ck.nim.data () ;
+      // A_j * conj ( A_k )
+      double sre = 0 ;
+      double sim = 0 ;
+      if ( weighted )
+      {
+        const double* w = m_weights.data () ;
+        for ( std::size_t e = 0 ; e < m_nnorm ; ++e )
+        {
+          sre += w [ e ] * ( jre [ e ] * kre [ e ] + jim [ e ] * kim [ e ] ) ;
+          sim += w [ e ] * ( jim [ e ] * kre [ e ] - jre [ e ] * kim [ e ] ) ;
+        }
+      }
+      else
+      {
+        for ( std::size_t e = 0 ; e < m_nnorm ; ++e )
+        {
+          sre += jre [ e ] * kre [ e ] + jim [ e ] * kim [ e ] ;
+          sim += jim [ e ] * kre [ e ] - jre [ e ] * kim [ e ] ;
+        }
+      }
+      m_matrix [ j * K + k ] = complex_type ( sre * scale ,  sim * scale ) ;
+      m_matrix [ k * K + j ] = complex_type ( sre * scale , -sim * scale ) ;
+    }
+  }
+  //
+  return nchanged ;
+}
+// ============================================================================
+// the total amplitude for the data event
+// ============================================================================
+Ostap::Math::AmplitudeSum::complex_type
+Ostap::Math::AmplitudeSum::amplitude ( const std::size_t event ) const
+{
+  Ostap::Assert ( event < m_ndata , "Invalid event index" , "Ostap::Math::AmplitudeSum" ) ;
+  update () ;
+  complex_type result = 0 ;
+  for ( const Component& c : m_components )
+  { result += c.coupling * complex_type ( c.dre [ event ] , c.dim [ event ] ) ; }
+  return result ;
+}
+// ============================================================================
+// the intensities for all data events
+// ============================================================================
+Ostap::Math::AmplitudeSum::Values
+Ostap::Math::AmplitudeSum::intensities () const
+{
+  update () ;
+  //
+  Values sre ( m_ndata , 0.0 ) ;
+  Values sim ( m_ndata , 0.0 ) ;
+  double* const pre = sre.data () ;
+  double* const pim = sim.data () ;
+  for ( const Component& c : m_components )
+  {
+    const double cr = c.coupling.real () ;
+    const double ci = c.coupling.imag () ;
+    const double* are = c.dre.data () ;
+    const double* aim = c.dim.data () ;
+    for ( std::size_t e = 0 ; e < m_ndata ; ++e )
+    {
+      pre [ e ] += cr * are [ e ] - ci * aim [ e ] ;
+      pim [ e ] += cr * aim [ e ] + ci * are [ e ] ;
+    }
+  }
+  //
+  for ( std::size_t e = 0 ; e < m_ndata ; ++e )
+  { pre [ e ] = pre [ e ] * pre [ e ] + pim [ e ] * pim [ e ] ; }
+  //
+  return sre ;
+}
+// ============================================================================
+// the normalization integral (mean intensity over the normalization sample)
+// ============================================================================
+double Ostap::Math::AmplitudeSum::normalization () const
+{
+  update () ;
+  const std::size_t K = m_components.size () ;
+  double result = 0 ;
+  for ( std::size_t j = 0 ; j < K ; ++j )
+  {
+    const complex_type& cj = m_components [ j ].coupling ;
+    result += std::norm ( cj ) * m_matrix [ j * K + j ].real () ;
+    for ( std::size_t k = j + 1 ; k < K ; ++k )
+    { result += 2 * std::real ( cj * std::conj ( m_components [ k ].coupling ) * m_matrix [ j * K + k ] ) ; }
+  }
+  return result ;
+}
+// ============================================================================
+/*  the fit fraction for the resonance
+ *  \f$ f_k = \left| c_k \right|^2 M_{kk} / N \f$
+ */
+// ============================================================================
+double Ostap::Math::AmplitudeSum::fraction ( const std::size_t i ) const
+{
+  Ostap::Assert ( i < m_components.size () , "Invalid index" , "Ostap::Math::AmplitudeSum" ) ;
+  const double norm = normalization () ;
+  if ( norm <= 0 ) { return 0 ; }
+  const std::size_t K = m_components.size () ;
+  return std::norm ( m_components [ i ].coupling ) * m_matrix [ i * K + i ].real () / norm ;
+}
+// ============================================================================
+// the interference matrix element (without couplings)
+// ============================================================================
+Ostap::Math::AmplitudeSum::complex_type
+Ostap::Math::AmplitudeSum::interference
+( const std::size_t j ,
+  const std::size_t k ) const
+{
+  const std::size_t K = m_components.size () ;
+  Ostap::Assert ( j < K && k < K , "Invalid index" , "Ostap::Math::AmplitudeSum" ) ;
+  update () ;
+  return m_matrix [ j * K + k ] ;
+}
+// ============================================================================
+/*  the negative log-likelihood for the data sample
+ *  \f$ -\sum_e \log \frac{I(e)}{N} \f$
+ */
+// ============================================================================
+double Ostap::Math::AmplitudeSum::nll () const
+{
+  const double norm = normalization () ;
+  Ostap::Assert ( 0 < norm , "Non-positive normalization" , "Ostap::Math::AmplitudeSum::nll" ) ;
+  const Values values = intensities () ;
+  double result = 0 ;
+  for ( const double v : values )
+  { result -= std::log ( std::max ( v , std::numeric_limits<double>::min () ) ) ; }
+  return result + values.size () * std::log ( norm ) ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
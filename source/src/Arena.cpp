@@ -0,0 +1,147 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Arena.h"
+#include "Ostap/Instrument.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Utils::Arena
+ *  @see Ostap::Utils::Arena
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// total number of heap allocations for all arenas
+  std::atomic<unsigned long long> s_heap { 0 } ;
+  // ==========================================================================
+  /// try to allocate from the block, return nullptr if there is no space
+  inline void* _allocate_
+  ( char*             data   ,
+    const std::size_t size   ,
+    std::size_t&      offset ,
+    const std::size_t bytes  ,
+    const std::size_t align  )
+  {
+    const std::uintptr_t base    = reinterpret_cast<std::uintptr_t> ( data ) ;
+    const std::uintptr_t current = base + offset ;
+    const std::uintptr_t aligned = ( current + align - 1 ) & ~std::uintptr_t ( align - 1 ) ;
+    if ( base + size < aligned + bytes ) { return nullptr ; }
+    offset = aligned + bytes - base ;
+    return reinterpret_cast<void*> ( aligned ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor with the (minimal) size of the block (bytes)
+// ============================================================================
+Ostap::Utils::Arena::Arena
+( const std::size_t block )
+  : m_blocks  ()
+  , m_current ( 0 )
+  , m_offset  ( 0 )
+  , m_block   ( std::max ( block , std::size_t ( 1024 ) ) )
+  , m_heap    ( 0 )
+{}
+// ============================================================================
+// the arena for the current thread
+// ============================================================================
+Ostap::Utils::Arena&
+Ostap::Utils::Arena::local ()
+{
+  static thread_local Arena s_arena {} ;
+  return s_arena ;
+}
+// ============================================================================
+// total number of heap allocations for all arenas
+// ============================================================================
+unsigned long long
+Ostap::Utils::Arena::total_heap_allocations ()
+{ return s_heap.load ( std::memory_order_relaxed ) ; }
+// ============================================================================
+// total capacity (bytes)
+// ============================================================================
+std::size_t Ostap::Utils::Arena::capacity () const
+{
+  std::size_t result = 0 ;
+  for ( const Block& b : m_blocks ) { result += b.size ; }
+  return result ;
+}
+// ============================================================================
+// allocate the memory
+// ============================================================================
+void* Ostap::Utils::Arena::allocate
+( const std::size_t bytes ,
+  const std::size_t align )
+{
+  OSTAP_COUNT ( "Arena::allocate" ) ;
+  if ( !m_blocks.empty () )
+  {
+    Block& b = m_blocks [ m_current ] ;
+    void*  p = _allocate_ ( b.data.get () , b.size , m_offset , bytes , align ) ;
+    if ( p ) { return p ; }                                        // RETURN
+  }
+  return allocate_slow ( bytes , align ) ;
+}
+// ============================================================================
+// allocate from the next (new or existing) block
+// ============================================================================
+void* Ostap::Utils::Arena::allocate_slow
+( const std::size_t bytes ,
+  const std::size_t align )
+{
+  const std::size_t next = m_blocks.empty () ? 0 : m_current + 1 ;
+  const std::size_t need = bytes + align ;
+  //
+  // the blocks after the current one are free: reuse or replace
+  if ( m_blocks.size () <= next ) { m_blocks.emplace_back () ; }
+  Block& b = m_blocks [ next ] ;
+  if ( b.size < need )
+  {
+    const std::size_t size = std::max ( m_block , need ) ;
+    b.data.reset ( new char [ size ] ) ;
+    b.size = size ;
+    ++m_heap ;
+    s_heap.fetch_add ( 1 , std::memory_order_relaxed ) ;
+    OSTAP_COUNT ( "Arena::heap" ) ;
+  }
+  //
+  m_current = next ;
+  m_offset  = 0    ;
+  return _allocate_ ( b.data.get () , b.size , m_offset , bytes , align ) ;
+}
+// ============================================================================
+/*  rewind to the position
+ *  - rewinding to the very beginning merges the blocks into one,
+ *    thus the next cycle needs no more heap allocations
+ */
+// ============================================================================
+void Ostap::Utils::Arena::rewind ( const Mark& m )
+{
+  m_current = m.block  ;
+  m_offset  = m.offset ;
+  //
+  if ( 0 == m.block && 0 == m.offset && 1 < m_blocks.size () )
+  {
+    const std::size_t size = capacity () ;
+    m_blocks.resize ( 1 ) ;
+    m_blocks.front ().data.reset ( new char [ size ] ) ;
+    m_blocks.front ().size = size ;
+    ++m_heap ;
+    s_heap.fetch_add ( 1 , std::memory_order_relaxed ) ;
+    OSTAP_COUNT ( "Arena::heap" ) ;
+  }
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
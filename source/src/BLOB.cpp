@@ -5,6 +5,11 @@
 // ============================================================================
 #include <memory>
 #include <cstring>
+#include <algorithm>
+// ============================================================================
+// ROOT 
+// ============================================================================
+#include "RZip.h"
 // ============================================================================
 // Ostap 
 // ============================================================================
@@ -17,6 +22,16 @@
  *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
  */
 // ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /// maximal size of the chunk for R__zip 
+  const std::size_t s_MAXCHUNK  = 0xffffff ;
+  /// size of the chunk header 
+  const std::size_t s_HEADER    = 9        ;
+  // ==========================================================================
+}
+// ============================================================================
 // Standard constructor
 // ============================================================================
 Ostap::BLOB::BLOB
@@ -41,9 +56,74 @@ Ostap::BLOB::~BLOB(){}
 // ============================================================================
 // redefine the buffer 
 // ============================================================================
-void Ostap::BLOB::setBuffer ( const std::size_t size   , 
-                              const void*       buffer ) 
-{ m_data.Set ( size , (const char*) buffer ) ; }
+void Ostap::BLOB::setBuffer ( const std::size_t size     , 
+                              const void*       buffer   , 
+                              const int         compress ) 
+{
+  m_raw = -1 ;
+  if ( 0 < compress && s_HEADER < size ) 
+  {
+    // compress chunk-by-chunk directly into the final storage 
+    char*       src  = const_cast<char*> ( static_cast<const char*> ( buffer ) ) ;
+    char*       data = new char [ size ] ;
+    std::size_t nin  = 0 ;
+    std::size_t nout = 0 ;
+    while ( nin < size ) 
+    {
+      int srcsize = std::min ( size - nin  , s_MAXCHUNK ) ;
+      int tgtsize = std::min ( size - nout , s_MAXCHUNK + s_HEADER ) ;
+      int irep    = 0 ;
+      if ( s_HEADER < static_cast<std::size_t> ( tgtsize ) ) 
+      { R__zip ( compress , &srcsize , src + nin , &tgtsize , data + nout , &irep ) ; }
+      if ( irep <= 0 ) { break ; }   // not compressible
+      nin  += srcsize ;
+      nout += irep    ;
+    }
+    if ( size <= nin ) 
+    {
+      m_data.Adopt ( nout , data ) ;
+      m_raw = size ;
+      return ;
+    }
+    delete [] data ;
+  }
+  m_data.Set ( size , (const char*) buffer ) ; 
+}
+// ============================================================================
+// get the (uncompressed) content into the external buffer 
+// ============================================================================
+bool Ostap::BLOB::getBuffer 
+( const std::size_t size   , 
+  void*             buffer ) const 
+{
+  if ( size != raw_size () ) { return false ; }
+  if ( 0 == size           ) { return true  ; }
+  //
+  if ( !zipped () ) 
+  {
+    std::memcpy ( buffer , m_data.GetArray () , size ) ;
+    return true ;
+  }
+  // 
+  unsigned char* src  = reinterpret_cast<unsigned char*> ( const_cast<char*> ( m_data.GetArray () ) ) ;
+  unsigned char* tgt  = static_cast<unsigned char*>      ( buffer ) ;
+  const std::size_t nsrc = m_data.GetSize () ;
+  std::size_t nin  = 0 ;
+  std::size_t nout = 0 ;
+  while ( nin + s_HEADER <= nsrc && nout < size ) 
+  {
+    int srcsize = 0 ;
+    int tgtsize = 0 ;
+    if ( 0 != R__unzip_header ( &srcsize , src + nin , &tgtsize ) ) { return false ; }
+    if ( nsrc < nin  + srcsize || size < nout + tgtsize           ) { return false ; }
+    int irep = 0 ;
+    R__unzip ( &srcsize , src + nin , &tgtsize , tgt + nout , &irep ) ;
+    if ( irep != tgtsize ) { return false ; }
+    nin  += srcsize ;
+    nout += tgtsize ;
+  }
+  return nin == nsrc && nout == size ;
+}
 
 // ============================================================================
 //                                                                      The END 
@@ -12,6 +12,7 @@
 #include "Ostap/BSpline.h"
 #include "Ostap/Bernstein.h"
 #include "Ostap/Lomont.h"
+#include "Ostap/Arena.h"
 // ============================================================================
 // Local
 // ============================================================================
@@ -259,6 +260,75 @@ namespace
     }
     return  nt + n ;
   }
+  // ==========================================================================
+  /** one step of the (non-recursive) Cox-de Boor triangle: 
+   *  non-zero basic splines of order k-1 at the span j are 
+   *  converted into the non-zero basic splines of order k
+   *  @see L.Piegl, W.Tiller, "The NURBS Book", algorithm A2.2
+   *  @param knots  (INPUT)  vector of knots 
+   *  @param j      (INPUT)  the span  knots[j] <= x < knots[j+1] 
+   *  @param x      (INPUT)  the argument 
+   *  @param k      (INPUT)  the new order 
+   *  @param values (UPDATE) k values on input, k+1 values on output 
+   */
+  inline void _cox_de_boor_
+  ( const std::vector<double>& knots  , 
+    const unsigned short       j      , 
+    const double               x      , 
+    const unsigned short       k      , 
+    double*                    values ) 
+  {
+    double saved = 0 ;
+    for ( unsigned short r = 0 ; r < k ; ++r )
+    {
+      const double tr   = knot ( knots , j + r + 1     ) ;
+      const double tl   = knot ( knots , j + r + 1 - k ) ;
+      const double temp = values [ r ] / ( tr - tl ) ;
+      values [ r ] = saved + ( tr - x ) * temp ;
+      saved        =         ( x - tl ) * temp ;
+    }
+    values [ k ] = saved ;
+  }
+  // ==========================================================================
+  /** add integrals of all B-splines from xmin up to x into the vector 
+   *  \f$ \int_{x_{min}}^{x} B_i(t) dt = w_i \sum_{k>i} E_k(x) \f$, 
+   *  where \f$ w_i = (t_{i+p+1}-t_i)/(p+1) \f$ and \f$ E_k \f$ 
+   *  are B-splines of order p+1
+   *  @param knots  (INPUT)  vector of knots 
+   *  @param order  (INPUT)  the order of spline
+   *  @param j      (INPUT)  the span  knots[j] <= x <= knots[j+1] 
+   *  @param x      (INPUT)  the argument 
+   *  @param scale  (INPUT)  the scale factor (+1 or -1) 
+   *  @param values (UPDATE) vector of integrals 
+   *  @param work   (UPDATE) work array of (at least) order+2 values 
+   */
+  inline void _add_integrals_
+  ( const std::vector<double>& knots  , 
+    const unsigned short       order  , 
+    const unsigned short       j      , 
+    const double               x      , 
+    const double               scale  ,
+    std::vector<double>&       values ,
+    double*                    work   ) 
+  {
+    work [ 0 ] = 1 ;
+    for ( unsigned short k = 1 ; k <= order + 1 ; ++k )
+    { _cox_de_boor_ ( knots , j , x , k , work ) ; }
+    //
+    const int i0 = j - order ;
+    // the splines that are completely to the left of x
+    for ( int i = 0 ; i < i0 ; ++i )
+    { values [ i ] += scale * ( knots [ i + order + 1 ] - knots [ i ] ) / ( order + 1 ) ; }
+    // the splines that overlap with x : suffix sums 
+    double sum = 0 ;
+    for ( int r = order ; 0 <= r ; --r )
+    {
+      sum += work [ r + 1 ] ;
+      const int i = i0 + r ;
+      values [ i ] += scale * sum * ( knots [ i + order + 1 ] - knots [ i ] ) / ( order + 1 ) ;
+    }
+  }
+  // ==========================================================================
 }
 // ============================================================================
 // The  Basic spline 
@@ -314,6 +384,8 @@ Ostap::Math::BSpline::BSpline
   std::copy ( m_knots.begin() , m_knots.end() , m_knots_i.begin() + 1 ) ;
   m_knots_i.front () = m_xmin ;
   m_knots_i.back  () = m_xmax ;
+  //
+  updateTable () ;
 }
 // ======================================================================
 /*  Constructor from the list of knots and list of parameters 
@@ -367,6 +439,8 @@ Ostap::Math::BSpline::BSpline
   std::copy ( m_knots.begin() , m_knots.end() , m_knots_i.begin() + 1 ) ;
   m_knots_i.front () = m_xmin ;
   m_knots_i.back  () = m_xmax ;
+  //
+  updateTable () ;
 }
 // ============================================================================
 /* Constructor for uniform binning 
@@ -406,6 +480,8 @@ Ostap::Math::BSpline::BSpline
   std::copy ( m_knots.begin() , m_knots.end() , m_knots_i.begin() + 1 ) ;
   m_knots_i.front () = m_xmin ;
   m_knots_i.back  () = m_xmax ;
+  //
+  updateTable () ;
 }
 // ============================================================================
 /*  Constructor from the list of knots and list of parameters 
@@ -481,6 +557,8 @@ Ostap::Math::BSpline::BSpline
   std::copy ( m_knots.begin() , m_knots.end() , m_knots_i.begin() + 1 ) ;
   m_knots_i.front () = m_xmin ;
   m_knots_i.back  () = m_xmax ;
+  //
+  updateTable () ;
 }
 // ============================================================================(
 Ostap::Math::BSpline::BSpline 
@@ -500,6 +578,7 @@ Ostap::Math::BSpline::BSpline( Ostap::Math::BSpline&&  right )
   , m_jlast   ( std::move ( right.m_jlast   ) ) 
   , m_pars_i  ( std::move ( right.m_pars_i  ) )  
   , m_knots_i ( std::move ( right.m_knots_i ) )  
+  , m_table   ( std::move ( right.m_table   ) )  
 {}
 // ============================================================================
 /// assignement move operator 
@@ -518,6 +597,7 @@ Ostap::Math::BSpline& Ostap::Math::BSpline::operator=
   m_jlast   = std::move ( right.m_jlast   ) ;
   m_pars_i  = std::move ( right.m_pars_i  ) ;
   m_knots_i = std::move ( right.m_knots_i ) ;
+  m_table   = std::move ( right.m_table   ) ;
   //
   return *this ;
 }
@@ -794,14 +874,8 @@ double Ostap::Math::BSpline::operator () ( const double x ) const
   //
   const double arg = x ;
   //
-  // find the proper "j"
-  //
-  // 1) try from jlast
-  if ( x <  m_knots[ m_jlast ] || x >= m_knots[ m_jlast + 1 ] ) 
-  {
-    m_jlast = find_i ( m_knots.begin () , 
-                       m_knots.end   () , arg ) - m_knots.begin() ;
-  }
+  // find the proper "j": try from jlast, then use the lookup table 
+  m_jlast = span ( arg , m_jlast ) ;
   //
   // straightforward calculations: 
   // double result = 0 ;
@@ -813,6 +887,202 @@ double Ostap::Math::BSpline::operator () ( const double x ) const
   //
 }
 // ============================================================================
+// (re)build the lookup table for the knot intervals
+// ============================================================================
+void Ostap::Math::BSpline::updateTable () 
+{
+  m_table.clear () ;
+  if ( m_pars.empty () || !( m_xmin < m_xmax ) ) { return ; }
+  //
+  const unsigned short jmin = m_order            ;
+  const unsigned short jmax = m_pars.size () - 1 ;
+  //
+  // two bins per knot interval: O(1) search for (nearly) uniform knots
+  const std::size_t M = 2 * ( jmax - jmin + 1 ) ;
+  m_table.resize ( M ) ;
+  const double dx = ( m_xmax - m_xmin ) / M ;
+  unsigned short j = jmin ;
+  for ( std::size_t b = 0 ; b < M ; ++b ) 
+  {
+    const double xb = m_xmin + b * dx ;
+    while ( j < jmax && m_knots [ j + 1 ] <= xb ) { ++j ; }
+    m_table [ b ] = j ;
+  }
+}
+// ============================================================================
+// get the index of the knot interval  knots[j] <= x < knots[j+1]
+// ============================================================================
+unsigned short Ostap::Math::BSpline::span 
+( const double         x    , 
+  const unsigned short hint ) const 
+{
+  const unsigned short jmin = m_order            ;
+  const unsigned short jmax = m_pars.size () - 1 ;
+  //
+  // 1) try the hint and the next interval 
+  if ( jmin <= hint && hint <= jmax && m_knots [ hint ] <= x ) 
+  {
+    if ( x < m_knots [ hint + 1 ] ) { return hint ; }
+    if ( hint < jmax && x < m_knots [ hint + 2 ] ) { return hint + 1 ; }
+  }
+  //
+  // 2) use the lookup table 
+  unsigned short j = jmin ;
+  const std::size_t M = m_table.size () ;
+  if ( 0 < M && m_xmin < x ) 
+  {
+    const std::size_t b = std::min ( std::size_t ( ( x - m_xmin ) / ( m_xmax - m_xmin ) * M ) , M - 1 ) ;
+    j = m_table [ b ] ;
+  }
+  //
+  // 3) local adjustment 
+  while ( j < jmax && m_knots [ j + 1 ] <= x ) { ++j ; }
+  while ( jmin < j && x <  m_knots [ j ]     ) { --j ; }
+  //
+  return j ;
+}
+// ============================================================================
+// get the values of all non-zero B-splines at point x 
+// ============================================================================
+unsigned short Ostap::Math::BSpline::bsplines
+( const double         x      , 
+  double*              values , 
+  const unsigned short hint   ) const
+{
+  const double         arg = std::max ( m_xmin , std::min ( x , m_xmax ) ) ;
+  // at xmax the last interval is used (the left limit) 
+  const unsigned short j   = arg < m_xmax ? span ( arg , hint ) : m_pars.size () - 1 ;
+  //
+  values [ 0 ] = 1 ;
+  for ( unsigned short k = 1 ; k <= m_order ; ++k ) 
+  { _cox_de_boor_ ( m_knots , j , arg , k , values ) ; }
+  //
+  return j ;
+}
+// ============================================================================
+// get the integrals of all B-splines between low and high 
+// ============================================================================
+void Ostap::Math::BSpline::bspline_integrals 
+( const double         low    , 
+  const double         high   , 
+  std::vector<double>& values ) const 
+{
+  values.assign ( m_pars.size () , 0.0 ) ;
+  //
+  const double scale = low <= high ? 1 : -1 ;  
+  const double xlow  = std::max ( m_xmin , std::min ( std::min ( low , high ) , m_xmax ) ) ;
+  const double xhigh = std::max ( m_xmin , std::min ( std::max ( low , high ) , m_xmax ) ) ;
+  if ( !( xlow < xhigh ) ) { return ; }
+  //
+  const unsigned short jmax = m_pars.size () - 1 ;
+  std::vector<double> work ( m_order + 2 ) ;
+  //
+  const unsigned short jL = span ( xlow ) ;
+  const unsigned short jH = xhigh < m_xmax ? span ( xhigh , jL ) : jmax ;
+  _add_integrals_ ( m_knots , m_order , jH , xhigh ,  scale , values , work.data () ) ;
+  _add_integrals_ ( m_knots , m_order , jL , xlow  , -scale , values , work.data () ) ;
+}
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::BSpline::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{ evaluate ( n , x , result , nullptr , nullptr ) ; }
+// ============================================================================
+// evaluate the function, derivative and integral for the array of points 
+// ============================================================================
+void Ostap::Math::BSpline::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result , 
+  double*           deriv  , 
+  double*           integ  ) const 
+{
+  const unsigned short p  = m_order       ;
+  const unsigned short np = m_pars.size() ;
+  //
+  // coefficients for the derivative 
+  std::vector<double> dpars ;
+  if ( deriv && 0 < p ) 
+  {
+    dpars.resize ( np , 0.0 ) ;
+    for ( unsigned short i = 1 ; i < np ; ++i ) 
+    { dpars [ i ] = ( m_pars [ i ] - m_pars [ i - 1 ] ) / ( m_knots [ i + p ] - m_knots [ i ] ) ; }
+  }
+  // coefficients for the integral 
+  std::vector<double> ipars ;
+  if ( integ ) 
+  {
+    ipars.resize ( np + 1 , 0.0 ) ;
+    for ( unsigned short i = 0 ; i < np ; ++i ) 
+    { ipars [ i + 1 ] = ipars [ i ] + m_pars [ i ] * ( m_knots [ i + p + 1 ] - m_knots [ i ] ) ; }
+  }
+  const double total = integ ? ipars.back () / ( p + 1 ) : 0.0 ;
+  //
+  std::vector<double> nb ( p + 2 ) ;
+  std::vector<double> nd ( p + 1 ) ;
+  //
+  unsigned short j = p ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if ( xi < m_xmin || xi > m_xmax ) 
+    {
+      result [ i ] = 0 ;
+      if ( deriv ) { deriv [ i ] = 0 ; }
+      if ( integ ) { integ [ i ] = xi < m_xmin ? 0.0 : total ; }
+      continue ;
+    }
+    //
+    const bool   at_min = s_equal ( xi , m_xmin ) ;
+    const bool   at_max = s_equal ( xi , m_xmax ) ;
+    const double arg    = !at_max ? xi : Ostap::Math::next_double ( m_xmax , -s_ulps ) ;
+    //
+    j = span ( arg , j ) ;
+    //
+    // Cox-de Boor triangle: the basis is calculated once per point
+    nb [ 0 ] = 1 ;
+    for ( unsigned short k = 1 ; k <= p ; ++k ) 
+    {
+      if ( k == p && deriv ) { std::copy ( nb.begin () , nb.begin () + p , nd.begin () ) ; }
+      _cox_de_boor_ ( m_knots , j , arg , k , nb.data () ) ;
+    }
+    //
+    // 1) the value 
+    if      ( at_min ) { result [ i ] = m_pars.front () ; }
+    else if ( at_max ) { result [ i ] = m_pars.back  () ; }
+    else 
+    {
+      double r = 0 ;
+      for ( unsigned short k = 0 ; k <= p ; ++k ) { r += m_pars [ j - p + k ] * nb [ k ] ; }
+      result [ i ] = r ;
+    }
+    //
+    // 2) the derivative 
+    if ( deriv ) 
+    {
+      double r = 0 ;
+      for ( unsigned short k = 0 ; 0 < p && k < p ; ++k ) { r += dpars [ j - p + 1 + k ] * nd [ k ] ; }
+      deriv [ i ] = r * p ;
+    }
+    //
+    // 3) the integral
+    if ( integ ) 
+    {
+      if ( at_max ) { integ [ i ] = total ; }
+      else 
+      {
+        _cox_de_boor_ ( m_knots , j , arg , p + 1 , nb.data () ) ;
+        double r = 0 ;
+        for ( unsigned short k = 0 ; k <= p + 1 ; ++k ) { r += ipars [ j - p + k ] * nb [ k ] ; }
+        integ [ i ] = r / ( p + 1 ) ;
+      }
+    }
+  }
+}
+// ============================================================================
 
 // ============================================================================
 namespace 
@@ -870,8 +1140,9 @@ double Ostap::Math::BSpline::integral
   for ( unsigned int i = 0 ; i < m_pars.size() ; ++i ) 
   { m_pars_i[i+1] = m_pars_i[i] + m_pars[i] * ( m_knots[ i + m_order + 1 ] - m_knots [ i ] ) ; }
   //
-  const short  jL = find_i ( m_knots_i.begin () , m_knots_i.end () ,  low  ) - m_knots_i.begin() ;  
-  const short  jH = find_i ( m_knots_i.begin () , m_knots_i.end () , xhigh ) - m_knots_i.begin() ;
+  // the extended knots are shifted by one: m_knots_i[j+1] = m_knots[j]
+  const short  jL = span (  low  ) + 1 ;
+  const short  jH = span ( xhigh ) + 1 ;
   //
   const double rL = _deboor_ ( m_order + 1 , m_order + 1 , jL ,  low  , m_knots_i , m_pars_i ) ;
   const double rH = _deboor_ ( m_order + 1 , m_order + 1 , jH , xhigh , m_knots_i , m_pars_i ) ;
@@ -905,6 +1176,8 @@ Ostap::Math::BSpline::indefinite_integral ( const double C ) const
   { result.m_pars[i+1] = result.m_pars[i] 
       + m_pars[i] * ( m_knots[ i + m_order + 1 ] - m_knots [ i ] ) / ( m_order + 1 ) ; }
   //
+  result.updateTable () ;
+  //
   return result ;
 }
 // ============================================================================
@@ -926,9 +1199,8 @@ double Ostap::Math::BSpline::derivative ( const double x   ) const
   for ( unsigned int i = 1  ; i < m_pars.size() ; ++i ) 
   {m_pars_i[i] = ( m_pars[i] - m_pars[i-1] ) / ( m_knots [ i + m_order ] - m_knots [ i ] ) ; }
   //
-  // try from jlast
-  if ( arg <  m_knots[ m_jlast ] || arg >= m_knots[ m_jlast + 1 ] ) 
-  { m_jlast = find_i ( m_knots.begin () , m_knots.end   () , arg ) - m_knots.begin() ; }
+  // try from jlast, then use the lookup table 
+  m_jlast = span ( arg , m_jlast ) ;
   //
   const double r = _deboor_ ( m_order - 1 , m_order - 1 , m_jlast , arg , m_knots , m_pars_i ) ;
   //
@@ -953,6 +1225,8 @@ Ostap::Math::BSpline Ostap::Math::BSpline::derivative () const
   //
   std::copy ( _pars.begin() + 1 , _pars.end() , result.m_pars.begin() ) ;
   //
+  result.updateTable () ;
+  //
   return result ;
 }
 // ============================================================================
@@ -975,7 +1249,20 @@ bool Ostap::Math::BSpline::insert ( const double t )
   // such not is laready in the list! 
   if ( iu != il ) { return false ; }
   //
-  return _insert_ ( t , 1 , m_knots , m_pars , m_order ) ;
+  if ( !_insert_ ( t , 1 , m_knots , m_pars , m_order ) ) { return false ; }
+  //
+  ++m_inner ;
+  //
+  // integration cache:
+  m_pars_i .resize ( m_pars.size  () + 1 ) ;
+  m_knots_i.resize ( m_knots.size () + 2 ) ;
+  std::copy ( m_knots.begin() , m_knots.end() , m_knots_i.begin() + 1 ) ;
+  m_knots_i.front () = m_xmin ;
+  m_knots_i.back  () = m_xmax ;
+  //
+  updateTable () ;
+  //
+  return true ;
 }
 // ============================================================================
 /*  calculate the value of spline defined by vector of knot and vector of 
@@ -1701,6 +1988,51 @@ bool Ostap::Math::ConvexSpline::updateCoefficients  ()
 // ============================================================================
 // 2D-objects 
 // ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /** fill the normalized B-splines 
+   *  \f$ f_i = B_i(x) / ( t_{i+k+1} - t_i ) \f$ 
+   *  only non-zero B-splines are calculated
+   */
+  inline void _bsplines_ 
+  ( const Ostap::Math::BSpline& spline ,
+    const double                x      , 
+    std::vector<double>&        f      ) 
+  {
+    std::fill ( f.begin () , f.end () , 0.0 ) ;
+    const unsigned short k = spline.order () ;
+    // scratch memory from the per-thread arena: no heap in the steady state 
+    Ostap::Utils::ArenaScope scope {} ;
+    double* b = scope.allocate<double> ( k + 1 ) ;
+    const unsigned short j = spline.bsplines ( x , b ) ;
+    for ( unsigned short r = 0 ; r <= k ; ++r ) 
+    {
+      const unsigned short i = j - k + r ;
+      if ( 0 < b [ r ] ) 
+      { f [ i ] = b [ r ] / ( spline.knot_i ( i + k + 1 ) - spline.knot_i ( i ) ) ; }
+    }
+  }
+  // ==========================================================================
+  /** fill the normalized integrals of B-splines 
+   *  \f$ f_i = \int_{low}^{high} B_i(x) dx / ( t_{i+k+1} - t_i ) \f$ 
+   */
+  inline void _bspline_integrals_ 
+  ( const Ostap::Math::BSpline& spline ,
+    const double                low    , 
+    const double                high   , 
+    std::vector<double>&        f      ) 
+  {
+    spline.bspline_integrals ( low , high , f ) ;
+    const unsigned short k = spline.order () ;
+    for ( unsigned short i = 0 ; i < f.size () ; ++i ) 
+    {
+      if ( 0 < f [ i ] ) 
+      { f [ i ] /= ( spline.knot_i ( i + k + 1 ) - spline.knot_i ( i ) ) ; }
+    }
+  }
+  // ==========================================================================
+}
 
 
 
@@ -1773,49 +2105,72 @@ double Ostap::Math::BSpline2D::evaluate
     !s_equal ( y , ymax ()) ? y :
     Ostap::Math::next_double ( ymax() , -s_ulps ) ;
   //
-  const unsigned short NX = m_xspline.npars() ;
-  const unsigned short NY = m_yspline.npars() ;
-  //
-  std::vector<double>  fx ( NX , 0 ) ;
-  std::vector<double>  fy ( NY , 0 ) ;
+  unsigned short hx = 0 ;
+  unsigned short hy = 0 ;
+  return evaluate ( xarg , yarg , hx , hy ) ;
+}
+// ============================================================================
+// get the value using and updating the span hints 
+// ============================================================================
+double Ostap::Math::BSpline2D::evaluate 
+( const double    x  , 
+  const double    y  , 
+  unsigned short& hx , 
+  unsigned short& hy ) const
+{
+  const unsigned short kx = m_xspline.order () ;
+  const unsigned short ky = m_yspline.order () ;
+  //
+  // only non-zero B-splines contribute 
+  std::vector<double> fx ( kx + 1 ) ;
+  std::vector<double> fy ( ky + 1 ) ;
+  hx = m_xspline.bsplines ( x , fx.data () , hx ) ;
+  hy = m_yspline.bsplines ( y , fy.data () , hy ) ;
+  //
+  const unsigned short jx = hx - kx ;
+  const unsigned short jy = hy - ky ;
+  for ( unsigned short r = 0 ; r <= kx ; ++r ) 
+  { fx [ r ] /= ( m_xspline.knot_i ( jx + r + kx + 1 ) - m_xspline.knot_i ( jx + r ) ) ; }
+  for ( unsigned short r = 0 ; r <= ky ; ++r ) 
+  { fy [ r ] /= ( m_yspline.knot_i ( jy + r + ky + 1 ) - m_yspline.knot_i ( jy + r ) ) ; }
   //
-  // fill x-cache
-  for ( unsigned short ix = 0 ; ix < NX ; ++ix )
+  double result = 0.0 ;
+  for ( unsigned short rx = 0 ; rx <= kx ; ++rx ) 
   {
-    m_xspline.setPar ( ix , 1.0 ) ;
-    //
-    double resx  = m_xspline ( xarg ) ;
-    if ( 0 < resx )
-    {
-      const double ti  = knot ( m_xspline.knots() , ix                         ) ;
-      const double tip = knot ( m_xspline.knots() , ix + m_xspline.order() + 1 ) ;
-      resx /= ( tip - ti ) ;
-    }
-    //
-    fx[ix] = resx ;
-    //
-    m_xspline.setPar ( ix , 0.0 ) ;
+    double r = 0.0 ;
+    for ( unsigned short ry = 0 ; ry <= ky ; ++ry ) 
+    { r += par ( jx + rx , jy + ry ) * fy [ ry ] ; }
+    result += r * fx [ rx ] ;
   }
-  //
-  // fill y-cache
-  for ( unsigned short iy = 0 ; iy < NY ; ++iy )
+  return result * ( kx + 1 ) * ( ky + 1 ) ;
+}
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::BSpline2D::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  const double*     y      , 
+  double*           result ) const 
+{
+  unsigned short hx = 0 ;
+  unsigned short hy = 0 ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
   {
-    m_yspline.setPar ( iy , 1.0 ) ;
+    const double xi = x [ i ] ;
+    const double yi = y [ i ] ;
+    if ( xi < xmin() || yi < ymin() || xi > xmax() || yi > ymax() ) { result [ i ] = 0 ; continue ; }
     //
-    double resy  = m_yspline ( yarg ) ;
-    if ( 0 < resy )
-    {
-      const double ti  = knot ( m_yspline.knots() , iy                         ) ;
-      const double tip = knot ( m_yspline.knots() , iy + m_yspline.order() + 1 ) ;
-      resy /= ( tip - ti ) ;
-    }
+    const double xarg =
+      !s_equal ( xi , xmax ()) ? xi :
+      Ostap::Math::next_double ( xmax() , -s_ulps ) ;
     //
-    fy[iy] = resy ;
+    const double yarg =
+      !s_equal ( yi , ymax ()) ? yi :
+      Ostap::Math::next_double ( ymax() , -s_ulps ) ;
     //
-    m_yspline.setPar ( iy , 0.0 ) ;
+    result [ i ] = evaluate ( xarg , yarg , hx , hy ) ;
   }
-  //
-  return calculate ( fx , fy ) ;
 }
 // ============================================================================
 /*  get the integral over 2D-region
@@ -1865,40 +2220,10 @@ double Ostap::Math::BSpline2D::integral
   std::vector<double>  fy ( NY , 0 ) ;
   //
   // fill x-cache
-  for ( unsigned short ix = 0 ; ix < NX ; ++ix )
-  {
-    m_xspline.setPar ( ix , 1.0 ) ;
-    //
-    double resx  = m_xspline.integral ( xlow , xarg ) ;
-    if ( 0 < resx )
-    {
-      const double ti  = knot ( m_xspline.knots() , ix                         ) ;
-      const double tip = knot ( m_xspline.knots() , ix + m_xspline.order() + 1 ) ;
-      resx /= ( tip - ti ) ;
-    }
-    //
-    fx[ix] = resx ;
-    //
-    m_xspline.setPar ( ix , 0.0 ) ;
-  }
+  _bspline_integrals_ ( m_xspline , xlow , xarg , fx ) ;
   //
   // fill y-cache
-  for ( unsigned short iy = 0 ; iy < NY ; ++iy )
-  {
-    m_yspline.setPar ( iy , 1.0 ) ;
-    //
-    double resy  = m_yspline.integral ( ylow ,  yarg ) ;
-    if ( 0 < resy )
-    {
-      const double ti  = knot ( m_yspline.knots() , iy                         ) ;
-      const double tip = knot ( m_yspline.knots() , iy + m_yspline.order() + 1 ) ;
-      resy /= ( tip - ti ) ;
-    }
-    //
-    fy[iy] = resy ;
-    //
-    m_yspline.setPar ( iy , 0.0 ) ;
-  }
+  _bspline_integrals_ ( m_yspline , ylow , yarg , fy ) ;
   //
   return calculate ( fx , fy ) ;
 }
@@ -1938,40 +2263,10 @@ double Ostap::Math::BSpline2D::integrateY
   std::vector<double>  fy ( NY , 0 ) ;
   //
   // fill x-cache
-  for ( unsigned short ix = 0 ; ix < NX ; ++ix )
-  {
-    m_xspline.setPar ( ix , 1.0 ) ;
-    //
-    double resx  = m_xspline ( xarg ) ;
-    if ( 0 < resx )
-    {
-      const double ti  = knot ( m_xspline.knots() , ix                         ) ;
-      const double tip = knot ( m_xspline.knots() , ix + m_xspline.order() + 1 ) ;
-      resx /= ( tip - ti ) ;
-    }
-    //
-    fx[ix] = resx ;
-    //
-    m_xspline.setPar ( ix , 0.0 ) ;
-  }
+  _bsplines_ ( m_xspline , xarg , fx ) ;
   //
   // fill y-cache
-  for ( unsigned short iy = 0 ; iy < NY ; ++iy )
-  {
-    m_yspline.setPar ( iy , 1.0 ) ;
-    //
-    double resy  = m_yspline.integral ( ylow ,  yarg ) ;
-    if ( 0 < resy )
-    {
-      const double ti  = knot ( m_yspline.knots() , iy                         ) ;
-      const double tip = knot ( m_yspline.knots() , iy + m_yspline.order() + 1 ) ;
-      resy /= ( tip - ti ) ;
-    }
-    //
-    fy[iy] = resy ;
-    //
-    m_yspline.setPar ( iy , 0.0 ) ;
-  }
+  _bspline_integrals_ ( m_yspline , ylow , yarg , fy ) ;
   //
   return calculate ( fx , fy ) ;
 }
@@ -2011,40 +2306,10 @@ double Ostap::Math::BSpline2D::integrateX
   std::vector<double>  fy ( NY , 0 ) ;
   //
   // fill x-cache
-  for ( unsigned short ix = 0 ; ix < NX ; ++ix )
-  {
-    m_xspline.setPar ( ix , 1.0 ) ;
-    //
-    double resx  = m_xspline.integral ( xlow , xarg ) ;
-    if ( 0 < resx )
-    {
-      const double ti  = knot ( m_xspline.knots() , ix                         ) ;
-      const double tip = knot ( m_xspline.knots() , ix + m_xspline.order() + 1 ) ;
-      resx /= ( tip - ti ) ;
-    }
-    //
-    fx [ix] = resx ;
-    //
-    m_xspline.setPar ( ix , 0.0 ) ;
-  }
+  _bspline_integrals_ ( m_xspline , xlow , xarg , fx ) ;
   //
   // fill y-cache
-  for ( unsigned short iy = 0 ; iy < NY ; ++iy )
-  {
-    m_yspline.setPar ( iy , 1.0 ) ;
-    //
-    double resy  = m_yspline( yarg ) ;
-    if ( 0 < resy )
-    {
-      const double ti  = knot ( m_yspline.knots() , iy                         ) ;
-      const double tip = knot ( m_yspline.knots() , iy + m_yspline.order() + 1 ) ;
-      resy /= ( tip - ti ) ;
-    }
-    //
-    fy [iy] = resy ;
-    //
-    m_yspline.setPar ( iy , 0.0 ) ;
-  }
+  _bsplines_ ( m_yspline , yarg , fy ) ;
   //
   return calculate ( fx , fy ) ;
 }
@@ -2080,22 +2345,7 @@ double Ostap::Math::BSpline2D::integrateY ( const double x ) const
   std::vector<double>  fy ( NY ,  1.0 / ( m_yspline.order() + 1 ) ) ;
   //
   // fill x-cache
-  for ( unsigned short ix = 0 ; ix < NX ; ++ix )
-  {
-    m_xspline.setPar ( ix , 1.0 ) ;
-    //
-    double resx  = m_xspline ( xarg ) ;
-    if ( 0 < resx )
-    {
-      const double ti  = knot ( m_xspline.knots() , ix                         ) ;
-      const double tip = knot ( m_xspline.knots() , ix + m_xspline.order() + 1 ) ;
-      resx /= ( tip - ti ) ;
-    }
-    //
-    fx [ix] = resx ;
-    //
-    m_xspline.setPar ( ix , 0.0 ) ;
-  }
+  _bsplines_ ( m_xspline , xarg , fx ) ;
   //
   return calculate ( fx , fy ) ;
 }
@@ -2122,22 +2372,7 @@ double Ostap::Math::BSpline2D::integrateX
   std::vector<double>  fy ( NY ,  0.0 ) ;
   //
   // fill y-cache
-  for ( unsigned short iy = 0 ; iy < NY ; ++iy )
-  {
-    m_yspline.setPar ( iy , 1.0 ) ;
-    //
-    double resy  = m_yspline( yarg ) ;
-    if ( 0 < resy )
-    {
-      const double ti  = knot ( m_yspline.knots() , iy                         ) ;
-      const double tip = knot ( m_yspline.knots() , iy + m_yspline.order() + 1 ) ;
-      resy /= ( tip - ti ) ;
-    }
-    //
-    fy[iy] = resy ;
-    //
-    m_yspline.setPar ( iy , 0.0 ) ;
-  }
+  _bsplines_ ( m_yspline , yarg , fy ) ;
   //
   return calculate ( fx , fy ) ;
 }
@@ -2308,40 +2543,10 @@ double Ostap::Math::BSpline2DSym::evaluate
   std::vector<double>  fy ( NY , 0 ) ;
   //
   // fill x-cache
-  for ( unsigned short ix = 0 ; ix < NX ; ++ix )
-  {
-    m_spline.setPar ( ix , 1.0 ) ;
-    //
-    double resx  = m_spline ( xarg ) ;
-    if ( 0 < resx )
-    {
-      const double ti  = knot ( m_spline.knots() , ix                        ) ;
-      const double tip = knot ( m_spline.knots() , ix + m_spline.order() + 1 ) ;
-      resx /= ( tip - ti ) ;
-    }
-    //
-    fx[ix] = resx ;
-    //
-    m_spline.setPar ( ix , 0.0 ) ;
-  }
+  _bsplines_ ( m_spline , xarg , fx ) ;
   //
   // fill y-cache
-  for ( unsigned short iy = 0 ; iy < NY ; ++iy )
-  {
-    m_spline.setPar ( iy , 1.0 ) ;
-    //
-    double resy  = m_spline ( yarg ) ;
-    if ( 0 < resy )
-    {
-      const double ti  = knot ( m_spline.knots() , iy                        ) ;
-      const double tip = knot ( m_spline.knots() , iy + m_spline.order() + 1 ) ;
-      resy /= ( tip - ti ) ;
-    }
-    //
-    fy[iy] = resy ;
-    //
-    m_spline.setPar ( iy , 0.0 ) ;
-  }
+  _bsplines_ ( m_spline , yarg , fy ) ;
   //
   return calculate ( fx , fy ) ;
 }
@@ -2393,40 +2598,10 @@ double Ostap::Math::BSpline2DSym::integral
   std::vector<double>  fy ( NY , 0 ) ;
   //
   // fill x-cache
-  for ( unsigned short ix = 0 ; ix < NX ; ++ix )
-  {
-    m_spline.setPar ( ix , 1.0 ) ;
-    //
-    double resx  = m_spline.integral ( xlow , xarg ) ;
-    if ( 0 < resx )
-    {
-      const double ti  = knot ( m_spline.knots() , ix                        ) ;
-      const double tip = knot ( m_spline.knots() , ix + m_spline.order() + 1 ) ;
-      resx /= ( tip - ti ) ;
-    }
-    //
-    fx[ix] = resx ;
-    //
-    m_spline.setPar ( ix , 0.0 ) ;
-  }
+  _bspline_integrals_ ( m_spline , xlow , xarg , fx ) ;
   //
   // fill y-cache
-  for ( unsigned short iy = 0 ; iy < NY ; ++iy )
-  {
-    m_spline.setPar ( iy , 1.0 ) ;
-    //
-    double resy  = m_spline.integral ( ylow ,  yarg ) ;
-    if ( 0 < resy )
-    {
-      const double ti  = knot ( m_spline.knots() , iy                        ) ;
-      const double tip = knot ( m_spline.knots() , iy + m_spline.order() + 1 ) ;
-      resy /= ( tip - ti ) ;
-    }
-    //
-    fy[iy] = resy ;
-    //
-    m_spline.setPar ( iy , 0.0 ) ;
-  }
+  _bspline_integrals_ ( m_spline , ylow , yarg , fy ) ;
   //
   return calculate ( fx , fy ) ;
 }
@@ -2466,40 +2641,10 @@ double Ostap::Math::BSpline2DSym::integrateY
   std::vector<double>  fy ( NY , 0 ) ;
   //
   // fill x-cache
-  for ( unsigned short ix = 0 ; ix < NX ; ++ix )
-  {
-    m_spline.setPar ( ix , 1.0 ) ;
-    //
-    double resx  = m_spline ( xarg ) ;
-    if ( 0 < resx )
-    {
-      const double ti  = knot ( m_spline.knots() , ix                        ) ;
-      const double tip = knot ( m_spline.knots() , ix + m_spline.order() + 1 ) ;
-      resx /= ( tip - ti ) ;
-    }
-    //
-    fx[ix] = resx ;
-    //
-    m_spline.setPar ( ix , 0.0 ) ;
-  }
+  _bsplines_ ( m_spline , xarg , fx ) ;
   //
   // fill y-cache
-  for ( unsigned short iy = 0 ; iy < NY ; ++iy )
-  {
-    m_spline.setPar ( iy , 1.0 ) ;
-    //
-    double resy  = m_spline.integral ( ylow ,  yarg ) ;
-    if ( 0 < resy )
-    {
-      const double ti  = knot ( m_spline.knots() , iy                        ) ;
-      const double tip = knot ( m_spline.knots() , iy + m_spline.order() + 1 ) ;
-      resy /= ( tip - ti ) ;
-    }
-    //
-    fy[iy] = resy ;
-    //
-    m_spline.setPar ( iy , 0.0 ) ;
-  }
+  _bspline_integrals_ ( m_spline , ylow , yarg , fy ) ;
   //
   return calculate ( fx , fy ) ;
 }
@@ -2558,22 +2703,7 @@ double Ostap::Math::BSpline2DSym::integrateY ( const double x ) const
   std::vector<double>  fy ( NY ,  1.0 / ( m_spline.order() + 1 ) ) ;
   //
   // fill x-cache
-  for ( unsigned short ix = 0 ; ix < NX ; ++ix )
-  {
-    m_spline.setPar ( ix , 1.0 ) ;
-    //
-    double resx  = m_spline ( xarg ) ;
-    if ( 0 < resx )
-    {
-      const double ti  = knot ( m_spline.knots() , ix                        ) ;
-      const double tip = knot ( m_spline.knots() , ix + m_spline.order() + 1 ) ;
-      resx /= ( tip - ti ) ;
-    }
-    //
-    fx [ix] = resx ;
-    //
-    m_spline.setPar ( ix , 0.0 ) ;
-  }
+  _bsplines_ ( m_spline , xarg , fx ) ;
   //
   return calculate ( fx , fy ) ;
 }
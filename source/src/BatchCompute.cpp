@@ -0,0 +1,53 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <atomic>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/BatchCompute.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Utils::BatchCompute
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// number of batch evaluations
+  std::atomic<unsigned long long> s_calls   { 0 } ;
+  /// number of evaluated entries
+  std::atomic<unsigned long long> s_entries { 0 } ;
+  // ==========================================================================
+}
+// ============================================================================
+// number of batch evaluations
+// ============================================================================
+unsigned long long Ostap::Utils::BatchCompute::calls   () { return s_calls   ; }
+// ============================================================================
+// number of evaluated entries
+// ============================================================================
+unsigned long long Ostap::Utils::BatchCompute::entries () { return s_entries ; }
+// ============================================================================
+// reset the counters
+// ============================================================================
+void Ostap::Utils::BatchCompute::reset ()
+{
+  s_calls   = 0 ;
+  s_entries = 0 ;
+}
+// ============================================================================
+// register the batch evaluation
+// ============================================================================
+void Ostap::Utils::BatchCompute::add ( const std::size_t nEvents )
+{
+  s_calls  .fetch_add ( 1       , std::memory_order_relaxed ) ;
+  s_entries.fetch_add ( nEvents , std::memory_order_relaxed ) ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
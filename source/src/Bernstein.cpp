@@ -27,6 +27,7 @@
 #include "local_math.h"
 #include "local_hash.h"
 #include "bernstein_utils.h"
+#include "local_tables.h"
 // ============================================================================
 /** @file 
  *  Implementation file for functions, related to Bernstein's polynomnials 
@@ -441,6 +442,58 @@ double Ostap::Math::Bernstein::derivative ( const double x   ) const
     ( npars () - 1 ) / ( m_xmax - m_xmin ) ;
 }
 // ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /// the fixed-degree evaluator 
+  typedef double (*BKERNEL) ( const double*     , 
+                              const long double , 
+                              const long double ) ;
+  // ==========================================================================
+  /// get the unrolled fixed-degree evaluator for small degrees 
+  inline BKERNEL _bkernel_ ( const unsigned short degree ) 
+  {
+    switch ( degree ) 
+    {
+    case 1 : return &Ostap::Math::Bernstein_<1>::evaluate ;
+    case 2 : return &Ostap::Math::Bernstein_<2>::evaluate ;
+    case 3 : return &Ostap::Math::Bernstein_<3>::evaluate ;
+    case 4 : return &Ostap::Math::Bernstein_<4>::evaluate ;
+    case 5 : return &Ostap::Math::Bernstein_<5>::evaluate ;
+    case 6 : return &Ostap::Math::Bernstein_<6>::evaluate ;
+    case 7 : return &Ostap::Math::Bernstein_<7>::evaluate ;
+    case 8 : return &Ostap::Math::Bernstein_<8>::evaluate ;
+    default: break ;
+    }
+    return nullptr ;
+  }
+  // ==========================================================================
+  /// evaluate the Bernstein sum of fixed degree for the array of points 
+  template <unsigned short N>
+  inline void _bevaluate_
+  ( const double*     pars   , 
+    const double      xmin   , 
+    const double      xmax   , 
+    const std::size_t n      , 
+    const double*     x      , 
+    double*           result ) 
+  {
+    for ( std::size_t i = 0 ; i < n ; ++i ) 
+    {
+      const double xi = x [ i ] ;
+      if      ( xi < xmin || xi > xmax ) { result [ i ] = 0           ; }
+      else if ( s_equal ( xi , xmin )  ) { result [ i ] = pars [ 0 ]  ; }
+      else if ( s_equal ( xi , xmax )  ) { result [ i ] = pars [ N ]  ; }
+      else 
+      {
+        const long double t0 = ( xi - xmin ) / ( xmax - xmin ) ;
+        result [ i ] = Ostap::Math::Bernstein_<N>::evaluate ( pars , t0 , 1 - t0 ) ;
+      }
+    }
+  }
+  // ==========================================================================
+}
+// ============================================================================
 // get the value
 // ============================================================================
 double Ostap::Math::Bernstein::evaluate ( const double x ) const
@@ -460,6 +513,11 @@ double Ostap::Math::Bernstein::evaluate ( const double x ) const
   const long double t0 = t ( x ) ;
   const long double t1 = 1 - t0  ;
   //
+  // use the unrolled kernel for the small degrees 
+  //
+  const BKERNEL kernel = _bkernel_ ( degree () ) ;
+  if ( kernel ) { return kernel ( m_pars.data () , t0 , t1 ) ; }
+  //
   // start de casteljau algorithm:
   //
   std::copy ( m_pars.begin() , m_pars.end() , m_aux.begin() ) ;
@@ -467,6 +525,53 @@ double Ostap::Math::Bernstein::evaluate ( const double x ) const
                                          m_aux.begin () + npars () , t0 , t1 ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Bernstein::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  //
+  // treat the trivial cases
+  //
+  if ( m_pars.empty() || s_vzero ( m_pars ) )
+  { std::fill ( result , result + n , 0.0 ) ; return ; }
+  //
+  // use the unrolled kernels for the small degrees 
+  //
+  const double* p = m_pars.data () ;
+  switch ( degree () )
+  {
+  case 1 : return _bevaluate_<1> ( p , m_xmin , m_xmax , n , x , result ) ;
+  case 2 : return _bevaluate_<2> ( p , m_xmin , m_xmax , n , x , result ) ;
+  case 3 : return _bevaluate_<3> ( p , m_xmin , m_xmax , n , x , result ) ;
+  case 4 : return _bevaluate_<4> ( p , m_xmin , m_xmax , n , x , result ) ;
+  case 5 : return _bevaluate_<5> ( p , m_xmin , m_xmax , n , x , result ) ;
+  case 6 : return _bevaluate_<6> ( p , m_xmin , m_xmax , n , x , result ) ;
+  case 7 : return _bevaluate_<7> ( p , m_xmin , m_xmax , n , x , result ) ;
+  case 8 : return _bevaluate_<8> ( p , m_xmin , m_xmax , n , x , result ) ;
+  default: break ;
+  }
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if      ( xi < m_xmin || xi > m_xmax   ) { result [ i ] = 0              ; }
+    else if ( s_equal ( xi , m_xmin )      ) { result [ i ] = m_pars [0]     ; }
+    else if ( s_equal ( xi , m_xmax )      ) { result [ i ] = m_pars.back () ; }
+    else if ( 1 == npars ()                ) { result [ i ] = m_pars [0]     ; }
+    else 
+    {
+      const long double t0 = t ( xi ) ;
+      const long double t1 = 1 - t0   ;
+      std::copy ( m_pars.begin() , m_pars.end() , m_aux.begin() ) ;
+      result [ i ] = Ostap::Math::Utils::casteljau 
+        ( m_aux.begin () , m_aux.begin () + npars () , t0 , t1 ) ;
+    }
+  }
+}
+// ============================================================================
 Ostap::Math::Bernstein&
 Ostap::Math::Bernstein::operator+=( const double a ) 
 {
@@ -1381,6 +1486,44 @@ namespace
     return 0 == ( k - j ) % 2 ?  c : -c ;
   }
   // ==========================================================================
+  // the cached transformation matrices, calculated once per degree 
+  // ==========================================================================
+  /// legendre -> bernstein 
+  const std::vector<double>& l2b_matrix ( const unsigned short n ) 
+  {
+    static Ostap::Math::Tables::OnceTable<std::vector<double> > s_table ;
+    return s_table.get ( n , [] ( const unsigned short d ) 
+                         { return Ostap::Math::Tables::make_matrix<double> ( d , l2b_mtrx ) ; } ) ;
+  }
+  // ==========================================================================
+  /// chebyshev -> bernstein 
+  const std::vector<long double>& c2b_matrix ( const unsigned short n ) 
+  {
+    static Ostap::Math::Tables::OnceTable<std::vector<long double> > s_table ;
+    return s_table.get ( n , [] ( const unsigned short d ) 
+                         { return Ostap::Math::Tables::make_matrix<long double> ( d , c2b_mtrx ) ; } ) ;
+  }
+  // ==========================================================================
+  /// monomial -> bernstein 
+  const std::vector<long double>& m2b_matrix ( const unsigned short n ) 
+  {
+    static Ostap::Math::Tables::OnceTable<std::vector<long double> > s_table ;
+    return s_table.get ( n , [] ( const unsigned short d ) 
+                         { return Ostap::Math::Tables::make_matrix<long double> ( d , m2b_mtrx ) ; } ) ;
+  }
+  // ==========================================================================
+  /// affine transformation of monomials: [-1,1] -> [0,1] 
+  const std::vector<long double>& m2m_matrix_2 ( const unsigned short n ) 
+  {
+    static Ostap::Math::Tables::OnceTable<std::vector<long double> > s_table ;
+    return s_table.get ( n , [] ( const unsigned short d ) 
+                         { return Ostap::Math::Tables::make_matrix<long double> 
+                             ( d , [] ( const unsigned short j , 
+                                        const unsigned short k , 
+                                        const unsigned short /* n */ ) 
+                               { return m2m_mtrx_2 ( j , k ) ; } ) ; } ) ;
+  }
+  // ==========================================================================
 }
 // ============================================================================
 // constructor from Legendre polynomial
@@ -1392,15 +1535,8 @@ Ostap::Math::Bernstein::Bernstein
   , m_xmax ( poly.xmax() )
   , m_aux  ( degree () + 2 ) 
 {
-  for ( unsigned short i = 0 ; i < npars() ; ++i ) 
-  { 
-    for ( unsigned short k = 0 ; k < npars() ; ++k ) 
-    { 
-      const double p = poly.par ( k ) ;
-      if ( s_zero ( p ) ) { continue ; }
-      m_pars[i] += l2b_mtrx ( i , k , degree() ) * p ; 
-    } 
-  }
+  Ostap::Math::Tables::apply_matrix 
+    ( npars () , l2b_matrix ( degree () ) , poly.pars ().begin () , m_pars.begin () ) ;
 }
 // ============================================================================
 // constructor from Chebyshev polynomial
@@ -1412,17 +1548,8 @@ Ostap::Math::Bernstein::Bernstein
   , m_xmax ( poly.xmax() ) 
   , m_aux  ( degree () + 2 ) 
 {
-  //
-  for ( unsigned short i = 0 ; i < npars() ; ++i ) 
-  { 
-    for ( unsigned short k = 0 ; k < npars() ; ++k ) 
-    { 
-      const double p = poly.par ( k ) ;
-      if ( s_zero ( p ) ) { continue ; }
-      m_pars[i] += c2b_mtrx ( i , k , degree() ) * p ; 
-    } 
-  }
-  //
+  Ostap::Math::Tables::apply_matrix 
+    ( npars () , c2b_matrix ( degree () ) , poly.pars ().begin () , m_pars.begin () ) ;
 }
 // ============================================================================
 // constructor from simple monomial form 
@@ -1441,27 +1568,13 @@ Ostap::Math::Bernstein::Bernstein
   // 1: affine transform to [0,1]
   //
   std::vector<double> _pars ( np ) ;
-  for ( unsigned short i = 0 ; i < np ; ++i ) 
-  { 
-    for ( unsigned short k = i ; k < np ; ++k )  
-    { 
-      const double p = poly.par ( k )  ;
-      if ( s_zero ( p ) ) { continue ; }
-      _pars[i] += m2m_mtrx_2 ( i , k ) * p ; 
-    } 
-  }  
+  Ostap::Math::Tables::apply_matrix 
+    ( np , m2m_matrix_2 ( degree () ) , poly.pars ().begin () , _pars.begin () ) ;
   //
   // 2: transform from shifted poly basis:
   //
-  for ( unsigned short i = 0 ; i < np ; ++i ) 
-  { 
-    for ( unsigned short k = 0 ; k <= i ;  ++k )  // ATTENTION!!
-    { 
-      const double p = _pars[ k ] ;
-      if ( s_zero ( p ) ) { continue ; }
-      m_pars[i] += m2b_mtrx ( i , k , degree() ) * p ; 
-    } 
-  }
+  Ostap::Math::Tables::apply_matrix 
+    ( np , m2b_matrix   ( degree () ) , _pars.begin ()        , m_pars.begin () ) ;
   //
 }
 // ============================================================================
@@ -22,7 +22,7 @@
 #include "Exception.h"
 #include "local_math.h"
 #include "bernstein_utils.h"
-#include "syncedcache.h"
+#include "local_tables.h"
 // ============================================================================
 /** @file 
  *  Implementation file for functions, related to Bernstein's polynomnials 
@@ -48,24 +48,8 @@ namespace
   
   // ==========================================================================
   typedef std::tuple<double,std::vector<double> >  PPROOTS ;
-  const PPROOTS& deltas_for_pproots  ( const unsigned short N ) 
+  PPROOTS make_pproots ( const unsigned short N ) 
   {
-    //
-    typedef std::map<unsigned short, PPROOTS> MAP   ;
-    typedef SyncedCache<MAP>                  CACHE ;
-    // 
-    // ========================================================================
-    //
-    static CACHE s_cache {} ;
-    // ========================================================================
-    { // look into the cache ==================================================
-      CACHE::Lock lock { s_cache.mutex() } ;
-      auto it = s_cache->find  ( N ) ;
-      if ( s_cache->end() != it ) {  return it->second ; }  // AVOID calculation
-      // ======================================================================
-    } // ======================================================================
-    // ========================================================================
-    
     std::vector<double> pproots ( N + 1 ) ;
     double alpha = Ostap::Math::Utils::positive_pseudo_roots ( N , pproots ) ;
     pproots.push_back ( 1 ) ;
@@ -83,15 +67,14 @@ namespace
     //
     alpha = std::acos ( std::sqrt ( alpha ) ) ;
     //    
-    PPROOTS result = std::make_tuple ( alpha , pproots ) ;
-    // ========================================================================
-    { // update the cache =====================================================
-      CACHE::Lock lock  { s_cache.mutex() } ;
-      // update the cache
-      s_cache->insert ( std::make_pair ( N , result ) ) ;
-      auto it = s_cache->find  ( N ) ;
-      return it->second ;
-    } // ======================================================================
+    return std::make_tuple ( alpha , pproots ) ;
+  }
+  // ==========================================================================
+  /// get the (cached) deltas, no lock at the read path 
+  const PPROOTS& deltas_for_pproots  ( const unsigned short N ) 
+  {
+    static Ostap::Math::Tables::OnceTable<PPROOTS> s_table {} ;
+    return s_table.get ( N , make_pproots ) ;
   }
   // ==========================================================================
 }
@@ -292,7 +275,7 @@ Ostap::Math::Positive::Positive
 // =============================================================================
 // update bernstein coefficients
 // =============================================================================
-bool Ostap::Math::Positive::updateBernstein ()
+bool Ostap::Math::Positive::updateBernstein ( const bool roots )
 {
   //
   bool update = false ;
@@ -352,50 +335,57 @@ bool Ostap::Math::Positive::updateBernstein ()
   const long double alpha     = m_sphereA . x2 ( 0 ) ;
   const long double beta      = 1 - alpha ;
   ///
-  /// get root-parameters from R-sphere and integrate them to get the roots 
-  const unsigned nR = m_rs.size() ;
-  for ( unsigned short iR = 0 ; iR < nR ; ++iR ) { m_rs [ iR ] = m_sphereR.x2 ( iR ) ; }
-  std::partial_sum ( m_rs.begin() , m_rs.end () , m_rs.begin() ) ;
-  
-  ///
-  const bool even = ( 0 == o % 2 );
-  //
-  std::array<long double,3> br ;   // helper second order polynomial 
-  /// "half-order"
-  const unsigned short m = even ? o / 2 :  ( o - 1 ) / 2 ;
-  //
-  unsigned short n1 = 2 ;
-  unsigned short n2 = 2 ;
-  //
-  if ( even )
-  {
-    m_v1 [ 0 ] = alpha                                      ; n1 = 1 ;    
-    m_v2 [ 0 ] = 0     ; m_v2 [ 1 ] = beta ; m_v2 [ 2 ] = 0 ; n2 = 3 ;
-  }
-  else 
+  /// the products over roots do not depend on alpha/beta:
+  /// recalculate them only if the roots are changed 
+  if ( roots ) 
   {
-    m_v1 [ 0 ] = alpha ; m_v1 [ 1 ] = 0                         ; n1 = 2 ;
-    m_v2 [ 0 ] = 0     ; m_v2 [ 1 ] = beta                      ; n2 = 2 ;
-  }
-  //
-  for ( unsigned short iR = 0 ; iR < nR ; ++iR ) 
-  {
-    const long double r  = m_rs [ iR ] ;    
-    Ostap::Math::Utils::bernstein2_from_roots ( r , r , br ) ;
+    /// get root-parameters from R-sphere and integrate them to get the roots 
+    const unsigned nR = m_rs.size() ;
+    for ( unsigned short iR = 0 ; iR < nR ; ++iR ) { m_rs [ iR ] = m_sphereR.x2 ( iR ) ; }
+    std::partial_sum ( m_rs.begin() , m_rs.end () , m_rs.begin() ) ;
+  
+    ///
+    const bool even = ( 0 == o % 2 );
+    //
+    std::array<long double,3> br ;   // helper second order polynomial 
+    //
+    unsigned short n1 = 2 ;
+    unsigned short n2 = 2 ;
+    //
+    std::fill ( m_v1.begin () , m_v1.end () , 0.0L ) ;
+    std::fill ( m_v2.begin () , m_v2.end () , 0.0L ) ;
     //
-    if ( 0 == iR % 2 ) 
+    if ( even )
     {
-      Ostap::Math::Utils::b_multiply ( m_v1.begin () , m_v1.begin () + n1 , br , m_aux.begin () );
-      n1  += 2 ;
-      std::swap  ( m_v1 , m_aux ) ;
+      m_v1 [ 0 ] = 1                                       ; n1 = 1 ;    
+      m_v2 [ 0 ] = 0     ; m_v2 [ 1 ] = 1 ; m_v2 [ 2 ] = 0 ; n2 = 3 ;
     }
     else 
     {
-      Ostap::Math::Utils::b_multiply ( m_v2.begin () , m_v2.begin () + n2 , br , m_aux.begin () );
-      n2  += 2 ;
-      std::swap  ( m_v2 , m_aux ) ;      
+      m_v1 [ 0 ] = 1     ; m_v1 [ 1 ] = 0                  ; n1 = 2 ;
+      m_v2 [ 0 ] = 0     ; m_v2 [ 1 ] = 1                  ; n2 = 2 ;
     }
-  }
+    //
+    for ( unsigned short iR = 0 ; iR < nR ; ++iR ) 
+    {
+      const long double r  = m_rs [ iR ] ;    
+      Ostap::Math::Utils::bernstein2_from_roots ( r , r , br ) ;
+      //
+      if ( 0 == iR % 2 ) 
+      {
+        Ostap::Math::Utils::b_multiply ( m_v1.begin () , m_v1.begin () + n1 , br , m_aux.begin () );
+        n1  += 2 ;
+        std::swap  ( m_v1 , m_aux ) ;
+      }
+      else 
+      {
+        Ostap::Math::Utils::b_multiply ( m_v2.begin () , m_v2.begin () + n2 , br , m_aux.begin () );
+        n2  += 2 ;
+        std::swap  ( m_v2 , m_aux ) ;      
+      }
+    }
+    //
+  } // end of the block for roots
   //
   const long double s1 = norm * alpha / std::accumulate ( m_v1.begin () , m_v1.end() , 0.0L ) ;
   const long double s2 = norm * beta  / std::accumulate ( m_v2.begin () , m_v2.end() , 0.0L ) ;
@@ -409,6 +399,14 @@ bool Ostap::Math::Positive::updateBernstein ()
   //
   return update ;
 }
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Positive::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{ m_bernstein.evaluate ( n , x , result ) ; }
 // =============================================================================
 // get the integral between low and high 
 // =============================================================================
@@ -19,6 +19,7 @@
 #include "Exception.h"
 #include "local_math.h"
 #include "local_hash.h"
+#include "bernstein_utils.h"
 // ============================================================================
 /** @file 
  *  Implementation file for functions, related to Bernstein's polynomnials 
@@ -158,8 +159,8 @@ void Ostap::Math::Bernstein2D::swap ( Ostap::Math::Bernstein2D& right )
 // helper function to make calculations
 // ============================================================================
 double Ostap::Math::Bernstein2D::calculate
-( const std::vector<double>& fx , 
-  const std::vector<double>& fy ) const 
+( const double* fx , 
+  const double* fy ) const 
 {
   double       result = 0 ;
   for  ( unsigned short ix = 0 ; ix <= m_nx ; ++ix )
@@ -193,15 +194,51 @@ double Ostap::Math::Bernstein2D::evaluate
     return m_pars [0] * scalex * scaley ; 
   }
   //
-  std::vector<double> fx ( m_nx + 1 , 0 ) ;
-  for  ( unsigned short i = 0 ; i <= m_nx ; ++i )
-  { fx[i] = m_bx[i] ( x )  ; }
+  const long double tx = ( x - m_xmin ) / ( m_xmax - m_xmin ) ;
+  const long double ty = ( y - m_ymin ) / ( m_ymax - m_ymin ) ;
   //
-  std::vector<double> fy ( m_ny + 1 , 0 ) ;
-  for ( unsigned short i = 0 ; i <= m_ny ; ++i )
-  { fy[i] = m_by[i] ( y )  ; }
+  Ostap::Math::Utils::Buffer fx ( m_nx + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( m_nx , tx , 1 - tx , fx.data () ) ;
+  //
+  Ostap::Math::Utils::Buffer fy ( m_ny + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( m_ny , ty , 1 - ty , fy.data () ) ;
+  //
+  return calculate ( fx.data () , fy.data () ) ;
+}
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Bernstein2D::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  const double*     y      , 
+  double*           result ) const 
+{
+  //
+  if ( npars () <= 1 ) 
+  { for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = evaluate ( x [ i ] , y [ i ] ) ; } ; return ; }
   //
-  return calculate ( fx  ,  fy ) ;
+  Ostap::Math::Utils::Buffer fx ( m_nx + 1 ) ;
+  Ostap::Math::Utils::Buffer fy ( m_ny + 1 ) ;
+  //
+  const double dx = m_xmax - m_xmin ;
+  const double dy = m_ymax - m_ymin ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    const double yi = y [ i ] ;
+    if ( xi < m_xmin || xi > m_xmax || yi < m_ymin || yi > m_ymax ) 
+    { result [ i ] = 0 ; continue ; }
+    //
+    const long double tx = ( xi - m_xmin ) / dx ;
+    const long double ty = ( yi - m_ymin ) / dy ;
+    //
+    Ostap::Math::Utils::bernstein_basis ( m_nx , tx , 1 - tx , fx.data () ) ;
+    Ostap::Math::Utils::bernstein_basis ( m_ny , ty , 1 - ty , fy.data () ) ;
+    //
+    result [ i ] = calculate ( fx.data () , fy.data () ) ;
+  }
 }
 // ============================================================================
 /** get the integral over 2D-region 
@@ -244,15 +281,15 @@ double Ostap::Math::Bernstein2D::integral
   const double  y_high = std::min ( ymax() , yhigh ) ;
   if ( y_low >= y_high ) { return 0 ; }
   //
-  std::vector<double> fy ( m_ny + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( m_ny + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= m_ny ; ++i )
   { fy[i] = m_by[i].integral ( y_low , y_high ) ; }
   //
-  std::vector<double> fx ( m_nx + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( m_nx + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= m_nx ; ++i )
   { fx[i] = m_bx[i].integral ( x_low , x_high ) ; }
   //
-  return calculate (  fx , fy ) ;
+  return calculate ( fx.data () , fy.data () ) ;
 }
 // ============================================================================
 /*  integral over x-dimension 
@@ -277,15 +314,15 @@ double Ostap::Math::Bernstein2D::integrateX
   const double  x_high = std::min ( xmax() , xhigh ) ;
   if ( x_low >= x_high ) { return 0 ; }
   //
-  std::vector<double> fy ( m_ny + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( m_ny + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= m_ny ; ++i )
   { fy[i] = m_by[i] ( y ) ; }
   //
-  std::vector<double> fx ( m_nx + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( m_nx + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= m_nx ; ++i )
   { fx[i] = m_bx[i].integral ( x_low , x_high ) ; }
   //
-  return calculate (  fx , fy ) ;
+  return calculate ( fx.data () , fy.data () ) ;
 }
 // ============================================================================
 /*  integral over y-dimension 
@@ -310,15 +347,15 @@ double Ostap::Math::Bernstein2D::integrateY
   const double  y_high = std::min ( ymax() , yhigh ) ;
   if ( y_low >= y_high ) { return 0 ; }
   //
-  std::vector<double> fy ( m_ny + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( m_ny + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= m_ny ; ++i )
   { fy[i] = m_by[i].integral ( y_low , y_high ) ; }
   //
-  std::vector<double> fx ( m_nx + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( m_nx + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= m_nx ; ++i )
   { fx[i] = m_bx[i] ( x ) ; }
   //
-  return calculate (  fx , fy ) ;
+  return calculate ( fx.data () , fy.data () ) ;
 }
 // ============================================================================
 /*  integral over x-dimension 
@@ -330,13 +367,13 @@ double Ostap::Math::Bernstein2D::integrateX ( const double y ) const
 {
   if ( y < ymin () || y > ymax() ) { return 0 ; }
   //
-  const std::vector<double> fx ( m_nx + 1 , (xmax()  -  xmin() ) / ( m_nx  + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fx ( m_nx + 1 , (xmax()  -  xmin() ) / ( m_nx  + 1 ) ) ;
   //
-  std::vector<double> fy ( m_ny + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( m_ny + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= m_ny ; ++i )
   { fy[i] = m_by[i] ( y ) ; }
   //
-  return calculate (  fx , fy ) ;
+  return calculate ( fx.data () , fy.data () ) ;
 }
 // ============================================================================
 /*  integral over x-dimension 
@@ -349,13 +386,13 @@ double Ostap::Math::Bernstein2D::integrateY
 {
  if ( x < xmin () || x > xmax() ) { return 0 ; }
   //
-  std::vector<double> fx ( m_nx + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( m_nx + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= m_nx ; ++i )
   { fx[i] = m_bx[i] ( x ) ; }
   //
-  const std::vector<double> fy ( m_ny + 1 , (ymax()  -  ymin() ) / ( m_ny  + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fy ( m_ny + 1 , (ymax()  -  ymin() ) / ( m_ny  + 1 ) ) ;
   //
-  return calculate ( fx ,  fy ) ;
+  return calculate ( fx.data () , fy.data () ) ;
 }
 // ============================================================================
 // set k-parameter
@@ -515,8 +552,8 @@ void Ostap::Math::Bernstein2DSym::swap( Ostap::Math::Bernstein2DSym& right )
 // helper function to make calculations
 // ============================================================================
 double Ostap::Math::Bernstein2DSym::calculate
-( const std::vector<double>& fx , 
-  const std::vector<double>& fy ) const 
+( const double* fx , 
+  const double* fy ) const 
 {
   double       result = 0 ;
   for  ( unsigned short ix = 0 ; ix <= m_n ; ++ix )
@@ -549,15 +586,51 @@ double Ostap::Math::Bernstein2DSym::evaluate
     return m_pars [0] * ( scale * scale ) ;
   }
   ///
-  std::vector<double> fy ( m_n + 1 , 0 ) ;
-  for ( unsigned short i = 0 ; i <= m_n ; ++i )
-  { fy[i] = m_b[i] ( y ) ; }
+  const long double tx = ( x - xmin () ) / ( xmax () - xmin () ) ;
+  const long double ty = ( y - ymin () ) / ( ymax () - ymin () ) ;
   //
-  std::vector<double> fx ( m_n + 1 , 0 ) ;
-  for  ( unsigned short i = 0 ; i <= m_n ; ++i )
-  { fx[i] = m_b[i] ( x ) ; }
+  Ostap::Math::Utils::Buffer fx ( m_n + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( m_n , tx , 1 - tx , fx.data () ) ;
+  //
+  Ostap::Math::Utils::Buffer fy ( m_n + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( m_n , ty , 1 - ty , fy.data () ) ;
   //
-  return calculate ( fx , fy ) ;
+  return calculate ( fx.data () , fy.data () ) ;
+}
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Bernstein2DSym::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  const double*     y      , 
+  double*           result ) const 
+{
+  //
+  if ( npars () <= 1 ) 
+  { for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = evaluate ( x [ i ] , y [ i ] ) ; } ; return ; }
+  //
+  Ostap::Math::Utils::Buffer fx ( m_n + 1 ) ;
+  Ostap::Math::Utils::Buffer fy ( m_n + 1 ) ;
+  //
+  const double dx = xmax () - xmin () ;
+  const double dy = ymax () - ymin () ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    const double yi = y [ i ] ;
+    if ( xi < xmin () || xi > xmax () || yi < ymin () || yi > ymax () ) 
+    { result [ i ] = 0 ; continue ; }
+    //
+    const long double tx = ( xi - xmin () ) / dx ;
+    const long double ty = ( yi - ymin () ) / dy ;
+    //
+    Ostap::Math::Utils::bernstein_basis ( m_n , tx , 1 - tx , fx.data () ) ;
+    Ostap::Math::Utils::bernstein_basis ( m_n , ty , 1 - ty , fy.data () ) ;
+    //
+    result [ i ] = calculate ( fx.data () , fy.data () ) ;
+  }
 }
 // ============================================================================
 /* get the integral over 2D-region 
@@ -584,15 +657,15 @@ double Ostap::Math::Bernstein2DSym::integral
   //
   else if ( s_equal ( xlow , xhigh ) || s_equal ( ylow , yhigh ) ) { return 0 ; }
   //
-  std::vector<double> fx ( m_n + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( m_n + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= m_n ; ++i )
   { fx[i] = m_b[i].integral ( xlow , xhigh ) ; }
   //
-  std::vector<double> fy ( m_n + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( m_n + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= m_n ; ++i )
   { fy[i] = m_b[i].integral ( ylow , yhigh ) ; }
   //
-  return calculate ( fx , fy ) ;
+  return calculate ( fx.data () , fy.data () ) ;
 }
 // ============================================================================
 /*  integral over x-dimension 
@@ -630,15 +703,15 @@ double Ostap::Math::Bernstein2DSym::integrateY
   const double  y_high = std::min ( ymax() , yhigh ) ;
   if ( y_low >= y_high ) { return 0 ; }
   //
-  std::vector<double> fy ( m_n + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( m_n + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= m_n ; ++i )
   { fy[i] = m_b[i].integral ( y_low , y_high ) ; }
   //
-  std::vector<double> fx ( m_n + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( m_n + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= m_n ; ++i )
   { fx[i] = m_b[i] ( x ) ; }
   //
-  return calculate ( fx , fy ) ;
+  return calculate ( fx.data () , fy.data () ) ;
 }
 // ============================================================================
 /* get the integral over 2D-region 
@@ -677,11 +750,11 @@ double Ostap::Math::Bernstein2DSym::integrateY ( const double x ) const
   //
   if ( x     <  xmin () || x    >  xmax() ) { return 0 ; }
   //
-  std::vector<double>       fx ( m_n + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer       fx ( m_n + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= m_n ; ++i ) { fx[i] = m_b[i] ( x ) ; }
-  const std::vector<double> fy ( m_n + 1 , ( ymax() - ymin () ) / ( m_n + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fy ( m_n + 1 , ( ymax() - ymin () ) / ( m_n + 1 ) ) ;
   //
-  return  calculate ( fx , fy ) ;
+  return  calculate ( fx.data () , fy.data () ) ;
 }
 // ============================================================================
 // set (k)-parameter
@@ -832,16 +905,16 @@ bool Ostap::Math::Positive2D::setPar
   const bool update = m_sphere.setPhase ( k , value ) ;
   if ( !update ) { return false ; }   // no actual change 
   //
-  return updateBernstein () ;
+  return updateBernstein ( k ) ;
 }
 // =============================================================================
 // update bernstein coefficients
 // =============================================================================
-bool Ostap::Math::Positive2D::updateBernstein ()
+bool Ostap::Math::Positive2D::updateBernstein ( const unsigned int first )
 {
   //
   bool update = false ;
-  for ( unsigned int ix = 0 ; ix < m_sphere.nX() ; ++ix ) 
+  for ( unsigned int ix = first ; ix < m_sphere.nX() ; ++ix ) 
   { 
     const bool updated = m_bernstein.setPar ( ix , m_sphere.x2 ( ix ) ) ;
     update = updated || update ;  
@@ -14,6 +14,7 @@
 // ============================================================================
 #include "local_math.h"
 #include "local_hash.h"
+#include "bernstein_utils.h"
 // ============================================================================
 /** @file
  *  Implementation file for functions, related to Bernstein's polynomnials
@@ -221,9 +222,9 @@ void Ostap::Math::Bernstein3D::swap ( Ostap::Math::Bernstein3D&  right )
 // helper function to make calculations
 // ============================================================================
 double Ostap::Math::Bernstein3D::calculate
-( const std::vector<double>& fx , 
-  const std::vector<double>& fy , 
-  const std::vector<double>& fz ) const 
+( const double* fx , 
+  const double* fy , 
+  const double* fz ) const 
 {
   double       result = 0 ;
   for  ( unsigned short ix = 0 ; ix <= nX () ; ++ix )
@@ -266,19 +267,65 @@ double Ostap::Math::Bernstein3D::evaluate
     return m_pars [0] * scalex * scaley * scalez ;
   }
   ///
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
-  for  ( unsigned short i = 0 ; i <= nX ()  ; ++i )
-  { fx[i] = m_bx[i] ( x )  ; }
+  const long double tx = ( x - xmin () ) / ( xmax () - xmin () ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( nX () , tx , 1 - tx , fx.data () ) ;
   //
-  std::vector<double> fy ( nY ()  + 1 , 0 ) ;
-  for ( unsigned short i = 0 ; i <= nY ()  ; ++i )
-  { fy[i] = m_by[i] ( y )  ; }
+  const long double ty = ( y - ymin () ) / ( ymax () - ymin () ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( nY () , ty , 1 - ty , fy.data () ) ;
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
-  for  ( unsigned short i = 0 ; i <= nZ () ; ++i )
-  { fz[i] = m_bz[i] ( z )  ; }
+  const long double tz = ( z - zmin () ) / ( zmax () - zmin () ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( nZ () , tz , 1 - tz , fz.data () ) ;
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
+}
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Bernstein3D::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  const double*     y      , 
+  const double*     z      , 
+  double*           result ) const 
+{
+  //
+  if ( npars () <= 1 ) 
+  { 
+    for ( std::size_t i = 0 ; i < n ; ++i ) 
+    { result [ i ] = evaluate ( x [ i ] , y [ i ] , z [ i ] ) ; } 
+    return ; 
+  }
+  //
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 ) ;
+  //
+  const double dx = xmax () - xmin () ;
+  const double dy = ymax () - ymin () ;
+  const double dz = zmax () - zmin () ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    const double yi = y [ i ] ;
+    const double zi = z [ i ] ;
+    if ( xi < xmin () || xi > xmax () || 
+         yi < ymin () || yi > ymax () || 
+         zi < zmin () || zi > zmax () ) { result [ i ] = 0 ; continue ; }
+    //
+    const long double tx = ( xi - xmin () ) / dx ;
+    const long double ty = ( yi - ymin () ) / dy ;
+    const long double tz = ( zi - zmin () ) / dz ;
+    //
+    Ostap::Math::Utils::bernstein_basis ( nX () , tx , 1 - tx , fx.data () ) ;
+    Ostap::Math::Utils::bernstein_basis ( nY () , ty , 1 - ty , fy.data () ) ;
+    Ostap::Math::Utils::bernstein_basis ( nZ () , tz , 1 - tz , fz.data () ) ;
+    //
+    result [ i ] = calculate ( fx.data () , fy.data () , fz.data () ) ;
+  }
 }
 
 // ============================================================================
@@ -341,19 +388,19 @@ double Ostap::Math::Bernstein3D::integral
   const double  z_high = std::min ( zmax() , zhigh ) ;
   if ( z_low >= z_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nX ()  ; ++i )
   { fx[i] = m_bx[i].integral ( x_low , x_high ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY ()  ; ++i )
   { fy[i] = m_by[i].integral ( y_low , y_high ) ; }
   //
-  std::vector<double> fz ( nZ ()  + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ ()  + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ ()  ; ++i )
   { fz[i] = m_bz[i].integral ( z_low , z_high ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x-dimension
@@ -381,19 +428,19 @@ double Ostap::Math::Bernstein3D::integrateX
   const double  x_high = std::min ( xmax() , xhigh ) ;
   if ( x_low >= x_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_bx[i].integral ( x_low , x_high ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_by[i] ( y ) ; }
   //
-  std::vector<double> fz ( nZ ()  + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ ()  + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ ()  ; ++i )
   { fz[i] = m_bz[i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /** integral over y-dimension
@@ -421,19 +468,19 @@ double Ostap::Math::Bernstein3D::integrateY
   const double  y_high = std::min ( ymax() , yhigh ) ;
   if ( y_low >= y_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX ()  + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX ()  + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nX ()  ; ++i )
   { fx[i] = m_bx[i] ( x ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_by[i].integral ( y_low , y_high ) ; }
   //
-  std::vector<double> fz ( nZ ()  + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ ()  + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nZ ()  ; ++i )
   { fz[i] = m_bz[i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /** integral over z-dimension
@@ -461,19 +508,19 @@ double Ostap::Math::Bernstein3D::integrateZ
   const double  z_high = std::min ( zmax() , zhigh ) ;
   if ( z_low >= z_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nX ()  ; ++i )
   { fx[i] = m_bx[i] ( x ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY ()  ; ++i )
   { fy[i] = m_by[i] ( y ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nZ () ; ++i ) 
   { fz[i] = m_bz[i].integral ( z_low , z_high ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 double Ostap::Math::Bernstein3D::integrateX ( const double y , 
@@ -482,17 +529,17 @@ double Ostap::Math::Bernstein3D::integrateX ( const double y ,
   if      ( y < ymin () || y > ymax() ) { return 0 ; }
   else if ( z < zmin () || z > zmax() ) { return 0 ; }
   //
-  const std::vector<double> fx ( nX () + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fx ( nX () + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_by[i] ( y ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ ()  ; ++i )
   { fz[i] = m_bz[i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 double Ostap::Math::Bernstein3D::integrateY ( const double x , 
@@ -501,17 +548,17 @@ double Ostap::Math::Bernstein3D::integrateY ( const double x ,
   if      ( x < xmin () || x > xmax() ) { return 0 ; }
   else if ( z < zmin () || z > zmax() ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_bx[i] ( x ) ; }
   //
-  const std::vector<double> fy ( nY () + 1 , ( ymax() - ymin () ) / ( nY () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fy ( nY () + 1 , ( ymax() - ymin () ) / ( nY () + 1 ) ) ;
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ ()  ; ++i )
   { fz[i] = m_bz[i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 double Ostap::Math::Bernstein3D::integrateZ ( const double x , 
@@ -520,17 +567,17 @@ double Ostap::Math::Bernstein3D::integrateZ ( const double x ,
   if      ( x < xmin () || x > xmax() ) { return 0 ; }
   else if ( y < ymin () || y > ymax() ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_bx[i] ( x ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_by[i] ( y ) ; }
   //
-  const std::vector<double> fz ( nZ() + 1 , ( zmax() - zmin () ) / ( nZ () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fz ( nZ() + 1 , ( zmax() - zmin () ) / ( nZ () + 1 ) ) ;
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x&y-dimensions
@@ -566,19 +613,19 @@ double Ostap::Math::Bernstein3D::integrateXY
   const double  y_high = std::min ( ymax() , yhigh ) ;
   if ( y_low >= y_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX ()  ; ++i )
   { fx[i] = m_bx[i].integral ( x_low , x_high ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_by[i].integral ( y_low , y_high ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nZ () ; ++i )
   { fz[i] = m_bz[i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /** integral over x&z-dimensions
@@ -614,19 +661,19 @@ double Ostap::Math::Bernstein3D::integrateXZ
   const double  z_high = std::min ( zmax() , zhigh ) ;
   if ( z_low >= z_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_bx[i].integral ( x_low , x_high ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_by[i] ( y ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nZ () ; ++i )
   { fz[i] = m_bz[i].integral ( z_low , z_high ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /** integral over y&z-dimensions
@@ -662,19 +709,19 @@ double Ostap::Math::Bernstein3D::integrateYZ
   const double  z_high = std::min ( zmax() , zhigh ) ;
   if ( z_low >= z_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_bx[i] ( x ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_by[i].integral ( y_low , y_high ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <=  nZ () ; ++i )
   { fz[i] = m_bz[i].integral ( z_low , z_high ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x&y-dimensions
@@ -687,14 +734,14 @@ double Ostap::Math::Bernstein3D::integrateXY ( const double z    ) const
 {
   if ( z < zmin () || z > zmax() ) { return 0 ; }
   //
-  const std::vector<double> fx ( nX () + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
-  const std::vector<double> fy ( nY () + 1 , ( ymax() - ymin () ) / ( nY () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fx ( nX () + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fy ( nY () + 1 , ( ymax() - ymin () ) / ( nY () + 1 ) ) ;
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ () ; ++i )
   { fz[i] = m_bz[i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x&z-dimensions
@@ -707,15 +754,15 @@ double Ostap::Math::Bernstein3D::integrateXZ ( const double y    ) const
 {
   if ( y < ymin () || y > ymax() ) { return 0 ; }
   //
-  const std::vector<double> fx ( nX() + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fx ( nX() + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
   //
-  std::vector<double> fy ( nY ()  + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY ()  + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_by[i] ( y ) ; }
   //
-  const std::vector<double> fz ( nZ () + 1 , ( zmax() - zmin () ) / ( nZ () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fz ( nZ () + 1 , ( zmax() - zmin () ) / ( nZ () + 1 ) ) ;
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /* integral over y&z-dimensions
@@ -728,15 +775,15 @@ double Ostap::Math::Bernstein3D::integrateYZ ( const double x    ) const
 {
   if ( x < xmin () || x > xmax() ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_bx[i] ( x ) ; }
   //
-  const std::vector<double> fy ( nY () + 1 , ( ymax() - ymin () ) / ( nY () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fy ( nY () + 1 , ( ymax() - ymin () ) / ( nY () + 1 ) ) ;
   //
-  const std::vector<double> fz ( nZ () + 1 , ( zmax() - zmin () ) / ( nZ () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fz ( nZ () + 1 , ( zmax() - zmin () ) / ( nZ () + 1 ) ) ;
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 // set k-parameter
@@ -897,9 +944,9 @@ void Ostap::Math::Bernstein3DSym::swap
 // helper function to make calculations
 // ============================================================================
 double Ostap::Math::Bernstein3DSym::calculate
-( const std::vector<double>& fx , 
-  const std::vector<double>& fy , 
-  const std::vector<double>& fz ) const 
+( const double* fx , 
+  const double* fy , 
+  const double* fz ) const 
 {
   double       result = 0 ;
   for  ( unsigned short ix = 0 ; ix <= nX ()  ; ++ix )
@@ -967,19 +1014,65 @@ double Ostap::Math::Bernstein3DSym::evaluate
     return m_pars [0] * scale * scale * scale ;
   }
   ///
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
-  for ( unsigned short i = 0 ; i <= nX () ; ++i )
-  { fx[i] = m_b [i] ( x )  ; }
+  const long double tx = ( x - xmin () ) / ( xmax () - xmin () ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( nX () , tx , 1 - tx , fx.data () ) ;
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
-  for ( unsigned short i = 0 ; i <= nY ()  ; ++i )
-  { fy[i] = m_b [i] ( y )  ; }
+  const long double ty = ( y - ymin () ) / ( ymax () - ymin () ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( nY () , ty , 1 - ty , fy.data () ) ;
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
-  for  ( unsigned short i = 0 ; i <= nZ () ; ++i )
-  { fz[i] = m_b [i] ( z )  ; }
+  const long double tz = ( z - zmin () ) / ( zmax () - zmin () ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( nZ () , tz , 1 - tz , fz.data () ) ;
+  //
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
+}
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Bernstein3DSym::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  const double*     y      , 
+  const double*     z      , 
+  double*           result ) const 
+{
+  //
+  if ( npars () <= 1 ) 
+  { 
+    for ( std::size_t i = 0 ; i < n ; ++i ) 
+    { result [ i ] = evaluate ( x [ i ] , y [ i ] , z [ i ] ) ; } 
+    return ; 
+  }
+  //
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 ) ;
+  //
+  const double dx = xmax () - xmin () ;
+  const double dy = ymax () - ymin () ;
+  const double dz = zmax () - zmin () ;
   //
-  return calculate ( fx , fy , fz ) ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    const double yi = y [ i ] ;
+    const double zi = z [ i ] ;
+    if ( xi < xmin () || xi > xmax () || 
+         yi < ymin () || yi > ymax () || 
+         zi < zmin () || zi > zmax () ) { result [ i ] = 0 ; continue ; }
+    //
+    const long double tx = ( xi - xmin () ) / dx ;
+    const long double ty = ( yi - ymin () ) / dy ;
+    const long double tz = ( zi - zmin () ) / dz ;
+    //
+    Ostap::Math::Utils::bernstein_basis ( nX () , tx , 1 - tx , fx.data () ) ;
+    Ostap::Math::Utils::bernstein_basis ( nY () , ty , 1 - ty , fy.data () ) ;
+    Ostap::Math::Utils::bernstein_basis ( nZ () , tz , 1 - tz , fz.data () ) ;
+    //
+    result [ i ] = calculate ( fx.data () , fy.data () , fz.data () ) ;
+  }
 }
 // ============================================================================
 /** get the integral over 3D-region
@@ -1059,19 +1152,19 @@ double Ostap::Math::Bernstein3DSym::integral
   const double  z_high = std::min ( zmax() , zhigh ) ;
   if ( z_low >= z_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_b [i].integral ( x_low , x_high ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_b [i].integral ( y_low , y_high ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ ()  ; ++i )
   { fz[i] = m_b [i].integral ( z_low , z_high ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x-dimension
@@ -1099,19 +1192,19 @@ double Ostap::Math::Bernstein3DSym::integrateX
   const double  x_high = std::min ( xmax() , xhigh ) ;
   if ( x_low >= x_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_b [i].integral ( x_low , x_high ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY ()   ; ++i )
   { fy[i] = m_b [i] ( y ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ ()  ; ++i )
   { fz[i] = m_b [i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 double Ostap::Math::Bernstein3DSym::integrateX ( const double y , 
@@ -1120,17 +1213,17 @@ double Ostap::Math::Bernstein3DSym::integrateX ( const double y ,
   if      ( y < ymin () || y > ymax() ) { return 0 ; }
   else if ( z < zmin () || z > zmax() ) { return 0 ; }
   //
-  const std::vector<double> fx ( nX () + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fx ( nX () + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_b [i] ( y ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ () ; ++i )
   { fz[i] = m_b [i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x&y-dimensions
@@ -1166,19 +1259,19 @@ double Ostap::Math::Bernstein3DSym::integrateXY
   const double  y_high = std::min ( ymax() , yhigh ) ;
   if ( y_low >= y_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_b [i].integral ( x_low , x_high ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_b [i].integral ( y_low , y_high ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nZ () ; ++i )
   { fz[i] = m_b [i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x&y-dimensions
@@ -1191,14 +1284,14 @@ double Ostap::Math::Bernstein3DSym::integrateXY ( const double z    ) const
 {
   if ( z < zmin () || z > zmax() ) { return 0 ; }
   //
-  const std::vector<double> fx ( nX() + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
-  const std::vector<double> fy ( nY() + 1 , ( ymax() - ymin () ) / ( nY () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fx ( nX() + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fy ( nY() + 1 , ( ymax() - ymin () ) / ( nY () + 1 ) ) ;
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ () ; ++i )
   { fz[i] = m_b [i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 // set k-parameter
@@ -1396,9 +1489,9 @@ void Ostap::Math::Bernstein3DMix::swap
 // helper function to make calculations
 // ============================================================================
 double Ostap::Math::Bernstein3DMix::calculate
-( const std::vector<double>& fx , 
-  const std::vector<double>& fy , 
-  const std::vector<double>& fz ) const 
+( const double* fx , 
+  const double* fy , 
+  const double* fz ) const 
 {
   double       result = 0 ;
   for  ( unsigned short ix = 0 ; ix <= nX () ; ++ix )
@@ -1452,19 +1545,65 @@ double Ostap::Math::Bernstein3DMix::evaluate
     return m_pars [0] * scalex * scaley * scalez ;
   }
   ///
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
-  for  ( unsigned short i = 0 ; i <= nX () ; ++i )
-  { fx[i] = m_b [i] ( x )  ; }
+  const long double tx = ( x - xmin () ) / ( xmax () - xmin () ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( nX () , tx , 1 - tx , fx.data () ) ;
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
-  for ( unsigned short i = 0 ; i <= nY () ; ++i )
-  { fy[i] = m_b [i] ( y )  ; }
+  const long double ty = ( y - ymin () ) / ( ymax () - ymin () ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( nY () , ty , 1 - ty , fy.data () ) ;
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
-  for  ( unsigned short i = 0 ; i <= nZ () ; ++i )
-  { fz[i] = m_bz[i] ( z )  ; }
+  const long double tz = ( z - zmin () ) / ( zmax () - zmin () ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 ) ;
+  Ostap::Math::Utils::bernstein_basis ( nZ () , tz , 1 - tz , fz.data () ) ;
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
+}
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Bernstein3DMix::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  const double*     y      , 
+  const double*     z      , 
+  double*           result ) const 
+{
+  //
+  if ( npars () <= 1 ) 
+  { 
+    for ( std::size_t i = 0 ; i < n ; ++i ) 
+    { result [ i ] = evaluate ( x [ i ] , y [ i ] , z [ i ] ) ; } 
+    return ; 
+  }
+  //
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 ) ;
+  //
+  const double dx = xmax () - xmin () ;
+  const double dy = ymax () - ymin () ;
+  const double dz = zmax () - zmin () ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    const double yi = y [ i ] ;
+    const double zi = z [ i ] ;
+    if ( xi < xmin () || xi > xmax () || 
+         yi < ymin () || yi > ymax () || 
+         zi < zmin () || zi > zmax () ) { result [ i ] = 0 ; continue ; }
+    //
+    const long double tx = ( xi - xmin () ) / dx ;
+    const long double ty = ( yi - ymin () ) / dy ;
+    const long double tz = ( zi - zmin () ) / dz ;
+    //
+    Ostap::Math::Utils::bernstein_basis ( nX () , tx , 1 - tx , fx.data () ) ;
+    Ostap::Math::Utils::bernstein_basis ( nY () , ty , 1 - ty , fy.data () ) ;
+    Ostap::Math::Utils::bernstein_basis ( nZ () , tz , 1 - tz , fz.data () ) ;
+    //
+    result [ i ] = calculate ( fx.data () , fy.data () , fz.data () ) ;
+  }
 }
 // ============================================================================
 /** get the integral over 3D-region
@@ -1541,19 +1680,19 @@ double Ostap::Math::Bernstein3DMix::integral
   const double  z_high = std::min ( zmax() , zhigh ) ;
   if ( z_low >= z_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_b [i].integral ( x_low , x_high ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_b [i].integral ( y_low , y_high ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ () ; ++i )
   { fz[i] = m_bz[i].integral ( z_low , z_high ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x-dimension
@@ -1581,19 +1720,19 @@ double Ostap::Math::Bernstein3DMix::integrateX
   const double  x_high = std::min ( xmax() , xhigh ) ;
   if ( x_low >= x_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX ()  ; ++i )
   { fx[i] = m_b [i].integral ( x_low , x_high ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY ()  ; ++i )
   { fy[i] = m_b [i] ( y ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ () ; ++i )
   { fz[i] = m_bz[i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over z-dimension
@@ -1621,19 +1760,19 @@ double Ostap::Math::Bernstein3DMix::integrateZ
   const double  z_high = std::min ( zmax() , zhigh ) ;
   if ( z_low >= z_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_b [i] ( x ) ; }
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_b [i] ( y ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nZ () ; ++i ) 
   { fz[i] = m_bz[i].integral ( z_low , z_high ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 double Ostap::Math::Bernstein3DMix::integrateX ( const double y , 
@@ -1642,17 +1781,17 @@ double Ostap::Math::Bernstein3DMix::integrateX ( const double y ,
   if      ( y < ymin () || y > ymax() ) { return 0 ; }
   else if ( z < zmin () || z > zmax() ) { return 0 ; }
   //
-  const std::vector<double> fx ( nX () + 1 , ( xmax() - xmin () ) / ( m_n + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fx ( nX () + 1 , ( xmax() - xmin () ) / ( m_n + 1 ) ) ;
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_b [i] ( y ) ; }
   //
-  std::vector<double> fz ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY ()  ; ++i )
   { fz[i] = m_bz[i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 double Ostap::Math::Bernstein3DMix::integrateZ ( const double x , 
@@ -1661,17 +1800,17 @@ double Ostap::Math::Bernstein3DMix::integrateZ ( const double x ,
   if      ( x < xmin () || x > xmax() ) { return 0 ; }
   else if ( y < ymin () || y > ymax() ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_b [i] ( x ) ; }
   //
-  std::vector<double> fy ( nY() + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY() + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_b [i] ( y ) ; }
   //
-  const std::vector<double> fz ( nZ () + 1  , ( zmax() - zmin () ) / ( nZ () + 1  ) ) ;
+  const Ostap::Math::Utils::Buffer fz ( nZ () + 1  , ( zmax() - zmin () ) / ( nZ () + 1  ) ) ;
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x&y-dimensions
@@ -1707,19 +1846,19 @@ double Ostap::Math::Bernstein3DMix::integrateXY
   const double  y_high = std::min ( ymax() , yhigh ) ;
   if ( y_low >= y_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_b [i].integral ( x_low , x_high ) ; }
   //
-  std::vector<double> fy ( nY () + 1  , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1  , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY ()  ; ++i )
   { fy[i] = m_b [i].integral ( y_low , y_high ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nZ () ; ++i )
   { fz[i] = m_bz [i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x&z-dimensions
@@ -1755,19 +1894,19 @@ double Ostap::Math::Bernstein3DMix::integrateXZ
   const double  z_high = std::min ( zmax() , zhigh ) ;
   if ( z_low >= z_high ) { return 0 ; }
   //
-  std::vector<double> fx ( nX () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fx ( nX () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nX () ; ++i )
   { fx[i] = m_b [i].integral ( x_low , x_high ) ; }
   //
-  std::vector<double> fy ( nY () + 1  , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1  , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY ()  ; ++i )
   { fy[i] = m_b [i] ( y ) ; }
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for  ( unsigned short i = 0 ; i <= nZ () ; ++i )
   { fz[i] = m_b [i].integral ( z_low , z_high ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x&y-dimensions
@@ -1780,14 +1919,14 @@ double Ostap::Math::Bernstein3DMix::integrateXY ( const double z    ) const
 {
   if ( z < zmin () || z > zmax() ) { return 0 ; }
   //
-  const std::vector<double> fx ( nX () + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
-  const std::vector<double> fy ( nY () + 1 , ( ymax() - ymin () ) / ( nY () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fx ( nX () + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fy ( nY () + 1 , ( ymax() - ymin () ) / ( nY () + 1 ) ) ;
   //
-  std::vector<double> fz ( nZ () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fz ( nZ () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nZ () ; ++i )
   { fz[i] = m_bz [i] ( z ) ; }
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 /*  integral over x&z-dimensions
@@ -1800,15 +1939,15 @@ double Ostap::Math::Bernstein3DMix::integrateXZ ( const double y    ) const
 {
   if ( y < ymin () || y > ymax() ) { return 0 ; }
   //
-  const std::vector<double> fx ( nX () + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fx ( nX () + 1 , ( xmax() - xmin () ) / ( nX () + 1 ) ) ;
   //
-  std::vector<double> fy ( nY () + 1 , 0 ) ;
+  Ostap::Math::Utils::Buffer fy ( nY () + 1 , 0 ) ;
   for ( unsigned short i = 0 ; i <= nY () ; ++i )
   { fy[i] = m_b  [i] ( y ) ; }
   //
-  const std::vector<double> fz ( nZ () + 1 , ( zmax() - zmin () ) / ( nZ () + 1 ) ) ;
+  const Ostap::Math::Utils::Buffer fz ( nZ () + 1 , ( zmax() - zmin () ) / ( nZ () + 1 ) ) ;
   //
-  return calculate ( fx , fy , fz ) ;
+  return calculate ( fx.data () , fy.data () , fz.data () ) ;
 }
 // ============================================================================
 // set k-parameter
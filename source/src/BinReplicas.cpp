@@ -0,0 +1,339 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <cmath>
+#include <array>
+#include <algorithm>
+#include <utility>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TH1.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/BinReplicas.h"
+#include "Ostap/RandomStream.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::BinReplicas
+ *  @see Ostap::BinReplicas
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_MODEL     = 897 ,
+    INVALID_HISTOGRAM = 898 ,
+    INVALID_BINNING   = 899 ,
+  } ;
+  // ==========================================================================
+  static const char s_TAG [] = "Ostap::BinReplicas" ;
+  // ==========================================================================
+  /// clone the model histogram (not attached to any directory)
+  std::unique_ptr<TH1> _clone_ ( const TH1& model )
+  {
+    const bool add = TH1::AddDirectoryStatus () ;
+    TH1::AddDirectory ( false ) ;
+    std::unique_ptr<TH1> h { static_cast<TH1*> ( model.Clone () ) } ;
+    TH1::AddDirectory ( add ) ;
+    h->SetDirectory ( nullptr ) ;
+    h->Reset        () ;
+    return h ;
+  }
+  // ==========================================================================
+  inline std::uint32_t lo32 ( const std::uint64_t v ) { return std::uint32_t ( v       ) ; }
+  inline std::uint32_t hi32 ( const std::uint64_t v ) { return std::uint32_t ( v >> 32 ) ; }
+  // ==========================================================================
+  /// the maximal Poisson(1) value: P(k>15) is far below 2^-32
+  const std::size_t s_KMAX = 16 ;
+  typedef std::array<std::uint64_t,s_KMAX> Thresholds ;
+  // ==========================================================================
+  /** the thresholds of the Poisson(1) CDF in the units of 2^-32:
+   *  k is the number of thresholds not exceeding the 32-bit word
+   */
+  const Thresholds& _thresholds_ ()
+  {
+    static const Thresholds s_thresholds = [] ()
+    {
+      Thresholds t {} ;
+      const double scale = 4294967296.0 ; // 2^32
+      double p   = std::exp ( -1.0 ) ;
+      double cdf = p ;
+      for ( std::size_t k = 0 ; k < s_KMAX ; ++k )
+      {
+        t [ k ] = std::uint64_t ( std::min ( cdf * scale , scale ) ) ;
+        p      /= ( k + 1 ) ;
+        cdf    += p ;
+      }
+      t [ s_KMAX - 1 ] = std::uint64_t ( scale ) ;
+      return t ;
+    } () ;
+    return s_thresholds ;
+  }
+  // ==========================================================================
+  /// Poisson(1) variate from the 32-bit word
+  inline unsigned short _poisson1_ ( const std::uint32_t u , const Thresholds& t )
+  {
+    unsigned short k = 0 ;
+    while ( t [ k ] <= u ) { ++k ; }
+    return k ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor from the model histogram
+// ============================================================================
+Ostap::BinReplicas::BinReplicas
+( const TH1&           model     ,
+  const unsigned short nReplicas ,
+  const std::uint64_t  seed      )
+  : m_dim      ( model.GetDimension () )
+  , m_N        ( nReplicas )
+  , m_seed     ( seed      )
+  , m_model    ( _clone_ ( model ) )
+  , m_sumw     ( std::size_t ( model.GetNcells () ) * nReplicas , 0.0 )
+  , m_nominal  ( model.GetNcells () , 0.0 )
+  , m_nominal2 ( model.GetNcells () , 0.0 )
+{
+  Ostap::Assert ( 1 <= m_dim && m_dim <= 3          ,
+                  "Invalid dimension of the model"  ,
+                  s_TAG , INVALID_MODEL             ) ;
+  Ostap::Assert ( 2 <= m_N                          ,
+                  "Invalid number of replicas"      ,
+                  s_TAG , INVALID_MODEL             ) ;
+}
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::BinReplicas::BinReplicas ( const Ostap::BinReplicas& right )
+  : m_dim      ( right.m_dim      )
+  , m_N        ( right.m_N        )
+  , m_seed     ( right.m_seed     )
+  , m_model    ( right.m_model ? _clone_ ( *right.m_model ) : nullptr )
+  , m_sumw     ( right.m_sumw     )
+  , m_nominal  ( right.m_nominal  )
+  , m_nominal2 ( right.m_nominal2 )
+{}
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::BinReplicas::~BinReplicas () {}
+// ============================================================================
+// copy assignment
+// ============================================================================
+Ostap::BinReplicas&
+Ostap::BinReplicas::operator= ( const Ostap::BinReplicas& right )
+{
+  if ( &right == this ) { return *this ; }
+  BinReplicas tmp ( right ) ;
+  *this = std::move ( tmp ) ;
+  return *this ;
+}
+// ============================================================================
+// get the global bin (1D)
+// ============================================================================
+int Ostap::BinReplicas::bin ( const double x ) const
+{ return m_model->FindFixBin ( x ) ; }
+// ============================================================================
+// get the global bin (2D)
+// ============================================================================
+int Ostap::BinReplicas::bin ( const double x , const double y ) const
+{ return m_model->FindFixBin ( x , y ) ; }
+// ============================================================================
+// get the global bin (3D)
+// ============================================================================
+int Ostap::BinReplicas::bin ( const double x , const double y , const double z ) const
+{ return m_model->FindFixBin ( x , y , z ) ; }
+// ============================================================================
+// get the Poisson(1) weights of the entry for all replicas
+// ============================================================================
+void Ostap::BinReplicas::poisson
+( const std::uint64_t           entry   ,
+  Ostap::BinReplicas::Weights&  weights ) const
+{
+  weights.resize ( m_N ) ;
+  const Thresholds&                t   = _thresholds_ () ;
+  const Ostap::Math::Philox::Key   key { { lo32 ( m_seed ) , hi32 ( m_seed ) } } ;
+  // four replicas per block of the generator
+  for ( unsigned int block = 0 ; 4 * block < m_N ; ++block )
+  {
+    const Ostap::Math::Philox::Counter words = Ostap::Math::Philox::block
+      ( { { lo32 ( entry ) , hi32 ( entry ) , block , 0u } } , key ) ;
+    const unsigned int first = 4 * block ;
+    const unsigned int n     = std::min ( 4u , m_N - first ) ;
+    for ( unsigned int i = 0 ; i < n ; ++i )
+    { weights [ first + i ] = _poisson1_ ( words [ i ] , t ) ; }
+  }
+}
+// ============================================================================
+// add the weight to the global bin, the Poisson weights are precomputed
+// ============================================================================
+void Ostap::BinReplicas::add
+( const int                           bin     ,
+  const double                        weight  ,
+  const Ostap::BinReplicas::Weights&  weights )
+{
+  m_nominal  [ bin ] += weight          ;
+  m_nominal2 [ bin ] += weight * weight ;
+  double* sumw = m_sumw.data () + bin * std::size_t ( m_N ) ;
+  for ( unsigned short r = 0 ; r < m_N ; ++r ) { sumw [ r ] += weights [ r ] * weight ; }
+}
+// ============================================================================
+// add the weight of the entry to the global bin
+// ============================================================================
+void Ostap::BinReplicas::fill
+( const int           bin    ,
+  const std::uint64_t entry  ,
+  const double        weight )
+{
+  Weights weights ;
+  poisson ( entry , weights ) ;
+  add     ( bin   , weight , weights ) ;
+}
+// ============================================================================
+// merge with another replicas
+// ============================================================================
+Ostap::BinReplicas&
+Ostap::BinReplicas::add ( const Ostap::BinReplicas& right )
+{
+  if ( &right == this ) { BinReplicas tmp ( right ) ; return add ( tmp ) ; }
+  if ( right.m_nominal.empty () ) { return *this ; }
+  if (       m_nominal.empty () ) { return *this = right ; }
+  //
+  Ostap::Assert ( m_dim  == right.m_dim                       &&
+                  m_N    == right.m_N                         &&
+                  m_seed == right.m_seed                      &&
+                  m_nominal.size () == right.m_nominal.size () ,
+                  "Mismatch in binning/replicas"               ,
+                  s_TAG , INVALID_BINNING                      ) ;
+  //
+  for ( std::size_t i = 0 ; i < m_sumw.size () ; ++i ) { m_sumw [ i ] += right.m_sumw [ i ] ; }
+  for ( std::size_t bin = 0 ; bin < m_nominal.size () ; ++bin )
+  {
+    m_nominal  [ bin ] += right.m_nominal  [ bin ] ;
+    m_nominal2 [ bin ] += right.m_nominal2 [ bin ] ;
+  }
+  //
+  return *this ;
+}
+// ============================================================================
+// reset all counters
+// ============================================================================
+void Ostap::BinReplicas::reset ()
+{
+  std::fill ( m_sumw    .begin () , m_sumw    .end () , 0.0 ) ;
+  std::fill ( m_nominal .begin () , m_nominal .end () , 0.0 ) ;
+  std::fill ( m_nominal2.begin () , m_nominal2.end () , 0.0 ) ;
+}
+// ============================================================================
+// the mean over replicas in the global bin
+// ============================================================================
+double Ostap::BinReplicas::mean ( const int bin ) const
+{
+  const double* sumw = m_sumw.data () + bin * std::size_t ( m_N ) ;
+  double s = 0 ;
+  for ( unsigned short r = 0 ; r < m_N ; ++r ) { s += sumw [ r ] ; }
+  return s / m_N ;
+}
+// ============================================================================
+// the bootstrap uncertainty (r.m.s. over replicas) in the global bin
+// ============================================================================
+double Ostap::BinReplicas::error ( const int bin ) const
+{
+  const double c = covariance ( bin , bin ) ;
+  return 0 < c ? std::sqrt ( c ) : 0.0 ;
+}
+// ============================================================================
+// the bootstrap covariance of two global bins
+// ============================================================================
+double Ostap::BinReplicas::covariance ( const int bin1 , const int bin2 ) const
+{
+  const double  m1 = mean ( bin1 ) ;
+  const double  m2 = mean ( bin2 ) ;
+  const double* s1 = m_sumw.data () + bin1 * std::size_t ( m_N ) ;
+  const double* s2 = m_sumw.data () + bin2 * std::size_t ( m_N ) ;
+  double c = 0 ;
+  for ( unsigned short r = 0 ; r < m_N ; ++r ) { c += ( s1 [ r ] - m1 ) * ( s2 [ r ] - m2 ) ; }
+  return c / ( m_N - 1 ) ;
+}
+// ============================================================================
+// the bootstrap correlation of two global bins
+// ============================================================================
+double Ostap::BinReplicas::correlation ( const int bin1 , const int bin2 ) const
+{
+  const double e1 = error ( bin1 ) ;
+  const double e2 = error ( bin2 ) ;
+  return 0 < e1 && 0 < e2 ? covariance ( bin1 , bin2 ) / ( e1 * e2 ) : 0.0 ;
+}
+// ============================================================================
+// check the compatibility of the histogram
+// ============================================================================
+void Ostap::BinReplicas::check ( const TH1* h ) const
+{
+  Ostap::Assert ( nullptr != h                          ,
+                  "Invalid histogram"                   ,
+                  s_TAG , INVALID_HISTOGRAM             ) ;
+  Ostap::Assert ( m_dim == h->GetDimension () &&
+                  m_nominal.size () == std::size_t ( h->GetNcells () ) ,
+                  "Mismatch in binning"                 ,
+                  s_TAG , INVALID_BINNING               ) ;
+}
+// ============================================================================
+// fill the histogram with the replica
+// ============================================================================
+void Ostap::BinReplicas::replica ( const unsigned short replica , TH1* h ) const
+{
+  check ( h ) ;
+  Ostap::Assert ( replica < m_N , "Invalid replica" , s_TAG , INVALID_HISTOGRAM ) ;
+  h->Reset () ;
+  for ( std::size_t bin = 0 ; bin < m_nominal.size () ; ++bin )
+  {
+    const double v = value ( bin , replica ) ;
+    if ( !v ) { continue ; }
+    h->SetBinContent ( bin , v ) ;
+    // the uncertainty of the replica is not defined
+    h->SetBinError   ( bin , 0 ) ;
+  }
+}
+// ============================================================================
+// fill the histogram with the nominal contents and bootstrap uncertainties
+// ============================================================================
+void Ostap::BinReplicas::bootstrap ( TH1* h ) const
+{
+  check ( h ) ;
+  h->Reset () ;
+  for ( std::size_t bin = 0 ; bin < m_nominal.size () ; ++bin )
+  {
+    if ( !m_nominal2 [ bin ] ) { continue ; }
+    h->SetBinContent ( bin , m_nominal [ bin ] ) ;
+    h->SetBinError   ( bin , error ( bin ) ) ;
+  }
+}
+// ============================================================================
+// fill the histogram with the nominal sums of weights and their uncertainties
+// ============================================================================
+void Ostap::BinReplicas::sumw ( TH1* h ) const
+{
+  check ( h ) ;
+  h->Reset () ;
+  for ( std::size_t bin = 0 ; bin < m_nominal.size () ; ++bin )
+  {
+    const double w2 = m_nominal2 [ bin ] ;
+    if ( !w2 ) { continue ; }
+    h->SetBinContent ( bin , m_nominal [ bin ] ) ;
+    h->SetBinError   ( bin , std::sqrt ( w2 ) ) ;
+  }
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
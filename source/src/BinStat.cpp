@@ -0,0 +1,293 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <cmath>
+#include <utility>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TH1.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TProfile3D.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/BinStat.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::BinStat
+ *  @see Ostap::BinStat
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_MODEL     = 880 ,
+    INVALID_HISTOGRAM = 881 ,
+    INVALID_BINNING   = 882 ,
+  } ;
+  // ==========================================================================
+  /// clone the model histogram (not attached to any directory)
+  std::unique_ptr<TH1> _clone_ ( const TH1& model )
+  {
+    const bool add = TH1::AddDirectoryStatus () ;
+    TH1::AddDirectory ( false ) ;
+    std::unique_ptr<TH1> h { static_cast<TH1*> ( model.Clone () ) } ;
+    TH1::AddDirectory ( add ) ;
+    h->SetDirectory ( nullptr ) ;
+    h->Reset        () ;
+    return h ;
+  }
+  // ==========================================================================
+  /// fill the profile histogram from the counters
+  template <class PROFILE>
+  void _profile_
+  ( const std::vector<Ostap::WStatEntity>& stat    ,
+    PROFILE*                               profile )
+  {
+    profile->Reset () ;
+    //
+    // are weights trivial ?
+    bool weighted = false ;
+    for ( const Ostap::WStatEntity& c : stat )
+    {
+      if ( c.n () && ( 1 != c.weights ().min () || 1 != c.weights ().max () ) )
+      { weighted = true ; break ; }
+    }
+    if ( weighted || !profile->GetSumw2N () ) { profile->Sumw2 ( true ) ; }
+    //
+    double*       sumwv  = profile->GetArray () ;
+    double*       sumwv2 = profile->GetSumw2 () ->GetArray () ;
+    TArrayD*      bsumw2 = profile->GetBinSumw2 () ;
+    const bool    bw2    = bsumw2 && 0 < bsumw2->GetSize () ;
+    //
+    unsigned long long entries = 0 ;
+    for ( std::size_t bin = 0 ; bin < stat.size () ; ++bin )
+    {
+      const Ostap::WStatEntity& c = stat [ bin ] ;
+      if ( !c.n () ) { continue ; }
+      //
+      const double sw = c.sumw () ;
+      const double mu = c.mu   () ;
+      sumwv  [ bin ] = mu * sw ;
+      sumwv2 [ bin ] = ( c.mu2 () + mu * mu ) * sw ;
+      profile->SetBinEntries ( bin , sw ) ;
+      if ( bw2 ) { bsumw2->SetAt ( c.sumw2 () , bin ) ; }
+      entries += c.n () ;
+    }
+    //
+    profile->ResetStats () ;
+    profile->SetEntries ( entries ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor from the model histogram
+// ============================================================================
+Ostap::BinStat::BinStat ( const TH1& model )
+  : m_dim   ( model.GetDimension () )
+  , m_model ( _clone_ ( model ) )
+  , m_stat  ( model.GetNcells    () )
+{
+  Ostap::Assert ( 1 <= m_dim && m_dim <= 3          ,
+                  "Invalid dimension of the model"  ,
+                  "Ostap::BinStat" , INVALID_MODEL  ) ;
+}
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::BinStat::BinStat ( const Ostap::BinStat& right )
+  : m_dim   ( right.m_dim   )
+  , m_model ( right.m_model ? _clone_ ( *right.m_model ) : nullptr )
+  , m_stat  ( right.m_stat  )
+{}
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::BinStat::~BinStat () {}
+// ============================================================================
+// copy assignment
+// ============================================================================
+Ostap::BinStat&
+Ostap::BinStat::operator= ( const Ostap::BinStat& right )
+{
+  if ( &right == this ) { return *this ; }
+  BinStat tmp ( right ) ;
+  *this = std::move ( tmp ) ;
+  return *this ;
+}
+// ============================================================================
+// get the global bin (1D)
+// ============================================================================
+int Ostap::BinStat::bin ( const double x ) const
+{ return m_model->FindFixBin ( x ) ; }
+// ============================================================================
+// get the global bin (2D)
+// ============================================================================
+int Ostap::BinStat::bin ( const double x , const double y ) const
+{ return m_model->FindFixBin ( x , y ) ; }
+// ============================================================================
+// get the global bin (3D)
+// ============================================================================
+int Ostap::BinStat::bin ( const double x , const double y , const double z ) const
+{ return m_model->FindFixBin ( x , y , z ) ; }
+// ============================================================================
+// merge with another statistics, the binning must be the same
+// ============================================================================
+Ostap::BinStat&
+Ostap::BinStat::add ( const Ostap::BinStat& right )
+{
+  if ( &right == this ) { BinStat tmp ( right ) ; return add ( tmp ) ; }
+  if ( right.m_stat.empty () ) { return *this ; }
+  if (       m_stat.empty () ) { return *this = right ; }
+  //
+  Ostap::Assert ( m_dim == right.m_dim && m_stat.size () == right.m_stat.size () ,
+                  "Mismatch in binning"                                         ,
+                  "Ostap::BinStat" , INVALID_BINNING                            ) ;
+  //
+  for ( std::size_t bin = 0 ; bin < m_stat.size () ; ++bin )
+  { m_stat [ bin ] += right.m_stat [ bin ] ; }
+  //
+  return *this ;
+}
+// ============================================================================
+// reset all counters
+// ============================================================================
+void Ostap::BinStat::reset ()
+{ for ( Ostap::WStatEntity& c : m_stat ) { c.reset () ; } }
+// ============================================================================
+// check the compatibility of the histogram
+// ============================================================================
+void Ostap::BinStat::check ( const TH1* h ) const
+{
+  Ostap::Assert ( nullptr != h                          ,
+                  "Invalid histogram"                   ,
+                  "Ostap::BinStat" , INVALID_HISTOGRAM  ) ;
+  Ostap::Assert ( m_dim == h->GetDimension () &&
+                  m_stat.size () == std::size_t ( h->GetNcells () ) ,
+                  "Mismatch in binning"                 ,
+                  "Ostap::BinStat" , INVALID_BINNING    ) ;
+}
+// ============================================================================
+// fill the profile histogram
+// ============================================================================
+void Ostap::BinStat::profile ( TProfile*   p ) const
+{ check ( p ) ; _profile_ ( m_stat , p ) ; }
+// ============================================================================
+// fill the 2D-profile histogram
+// ============================================================================
+void Ostap::BinStat::profile ( TProfile2D* p ) const
+{ check ( p ) ; _profile_ ( m_stat , p ) ; }
+// ============================================================================
+// fill the 3D-profile histogram
+// ============================================================================
+void Ostap::BinStat::profile ( TProfile3D* p ) const
+{ check ( p ) ; _profile_ ( m_stat , p ) ; }
+// ============================================================================
+// fill the histogram with the mean values and the uncertainties of the mean
+// ============================================================================
+void Ostap::BinStat::mean ( TH1* h ) const
+{
+  check ( h ) ;
+  h->Reset () ;
+  for ( std::size_t bin = 0 ; bin < m_stat.size () ; ++bin )
+  {
+    const Ostap::WStatEntity& c = m_stat [ bin ] ;
+    if ( !c.n () ) { continue ; }
+    h->SetBinContent ( bin , c.mean    () ) ;
+    h->SetBinError   ( bin , c.meanErr () ) ;
+  }
+}
+// ============================================================================
+// fill the histogram with the r.m.s. values
+// ============================================================================
+void Ostap::BinStat::rms ( TH1* h ) const
+{
+  check ( h ) ;
+  h->Reset () ;
+  for ( std::size_t bin = 0 ; bin < m_stat.size () ; ++bin )
+  {
+    const Ostap::WStatEntity& c = m_stat [ bin ] ;
+    if ( !c.n () ) { continue ; }
+    const double r = c.rms  () ;
+    const double n = c.nEff () ;
+    h->SetBinContent ( bin , r ) ;
+    // the gaussian approximation for the uncertainty
+    h->SetBinError   ( bin , 0 < n ? r / std::sqrt ( 2 * n ) : 0.0 ) ;
+  }
+}
+// ============================================================================
+// fill the histogram with the minimal values
+// ============================================================================
+void Ostap::BinStat::min ( TH1* h ) const
+{
+  check ( h ) ;
+  h->Reset () ;
+  for ( std::size_t bin = 0 ; bin < m_stat.size () ; ++bin )
+  {
+    const Ostap::WStatEntity& c = m_stat [ bin ] ;
+    if ( !c.values ().n () ) { continue ; }
+    h->SetBinContent ( bin , c.values ().min () ) ;
+    h->SetBinError   ( bin , 0 ) ;
+  }
+}
+// ============================================================================
+// fill the histogram with the maximal values
+// ============================================================================
+void Ostap::BinStat::max ( TH1* h ) const
+{
+  check ( h ) ;
+  h->Reset () ;
+  for ( std::size_t bin = 0 ; bin < m_stat.size () ; ++bin )
+  {
+    const Ostap::WStatEntity& c = m_stat [ bin ] ;
+    if ( !c.values ().n () ) { continue ; }
+    h->SetBinContent ( bin , c.values ().max () ) ;
+    h->SetBinError   ( bin , 0 ) ;
+  }
+}
+// ============================================================================
+// fill the histogram with the effective number of entries
+// ============================================================================
+void Ostap::BinStat::nEff ( TH1* h ) const
+{
+  check ( h ) ;
+  h->Reset () ;
+  for ( std::size_t bin = 0 ; bin < m_stat.size () ; ++bin )
+  {
+    const Ostap::WStatEntity& c = m_stat [ bin ] ;
+    if ( !c.n () ) { continue ; }
+    const double n = c.nEff () ;
+    h->SetBinContent ( bin , n ) ;
+    h->SetBinError   ( bin , 0 < n ? std::sqrt ( n ) : 0.0 ) ;
+  }
+}
+// ============================================================================
+// fill the histogram with the sums of weights and their uncertainties
+// ============================================================================
+void Ostap::BinStat::sumw ( TH1* h ) const
+{
+  check ( h ) ;
+  h->Reset () ;
+  for ( std::size_t bin = 0 ; bin < m_stat.size () ; ++bin )
+  {
+    const Ostap::WStatEntity& c = m_stat [ bin ] ;
+    if ( !c.n () ) { continue ; }
+    const double w2 = c.sumw2 () ;
+    h->SetBinContent ( bin , c.sumw () ) ;
+    h->SetBinError   ( bin , 0 < w2 ? std::sqrt ( w2 ) : 0.0 ) ;
+  }
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,349 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "TH1.h"
+#include "TAxis.h"
+#include "RooRealVar.h"
+#include "RooArgSet.h"
+#include "RooArgList.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/BinnedNLL.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::MoreRooFit::BinnedNLL
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-03-17
+ */
+// ============================================================================
+ClassImp(Ostap::MoreRooFit::BinnedNLL)
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_HISTO = 795 ,
+    INVALID_PDF   = 796 ,
+    NO_BINS       = 797 ,
+  } ;
+  // ==========================================================================
+  /// the minimal expectation in bin
+  const double s_TINY = 1.e-300 ;
+  /// the relative tolerance for the bin edges
+  const double s_EPS  = 1.e-9   ;
+  /// counter of instances, to get the unique range names
+  std::atomic<unsigned long> s_counter { 0 } ;
+  // ==========================================================================
+  /// get the current values of parameters
+  void values_
+  ( const RooArgSet*     pars   ,
+    std::vector<double>& result )
+  {
+    result.clear () ;
+    if ( nullptr == pars ) { return ; }
+    for ( const RooAbsArg* a : *pars )
+    {
+      const RooAbsReal* r = dynamic_cast<const RooAbsReal*> ( a ) ;
+      if ( nullptr != r ) { result.push_back ( r->getVal () ) ; }
+    }
+  }
+  // ==========================================================================
+}
+// ============================================================================
+/*  constructor for the extended case
+ *  @param name   the name
+ *  @param title  the title
+ *  @param x      the observable
+ *  @param pdfs   the components
+ *  @param yields the yields of components
+ *  @param histo  the histogram
+ */
+// ============================================================================
+Ostap::MoreRooFit::BinnedNLL::BinnedNLL
+( const std::string& name   ,
+  const std::string& title  ,
+  RooRealVar&        x      ,
+  const RooArgList&  pdfs   ,
+  const RooArgList&  yields ,
+  const TH1&         histo  )
+  : RooAbsReal ( name.c_str () , title.c_str () )
+  , m_x        ( "!x"      , "observable" , this , x , false , false )
+  , m_pdfs     ( "!pdfs"   , "components" , this )
+  , m_yields   ( "!yields" , "yields"     , this )
+  , m_extended ( true )
+{
+  Ostap::Assert ( 0 < pdfs.getSize () && pdfs.getSize () == yields.getSize () ,
+                  "Mismatch in number of PDFs/yields"  ,
+                  "Ostap::MoreRooFit::BinnedNLL"       , INVALID_PDF ) ;
+  for ( const RooAbsArg* a : pdfs )
+  { Ostap::Assert ( nullptr != dynamic_cast<const RooAbsReal*> ( a ) ,
+                    "Invalid PDF"                      ,
+                    "Ostap::MoreRooFit::BinnedNLL"     , INVALID_PDF ) ; }
+  for ( const RooAbsArg* a : yields )
+  { Ostap::Assert ( nullptr != dynamic_cast<const RooAbsReal*> ( a ) ,
+                    "Invalid yield"                    ,
+                    "Ostap::MoreRooFit::BinnedNLL"     , INVALID_PDF ) ; }
+  //
+  m_pdfs  .add ( pdfs   ) ;
+  m_yields.add ( yields ) ;
+  //
+  book_ ( x , histo ) ;
+}
+// ============================================================================
+/*  constructor for the non-extended case
+ *  @param name   the name
+ *  @param title  the title
+ *  @param x      the observable
+ *  @param pdf    the PDF
+ *  @param histo  the histogram
+ */
+// ============================================================================
+Ostap::MoreRooFit::BinnedNLL::BinnedNLL
+( const std::string& name   ,
+  const std::string& title  ,
+  RooRealVar&        x      ,
+  RooAbsReal&        pdf    ,
+  const TH1&         histo  )
+  : RooAbsReal ( name.c_str () , title.c_str () )
+  , m_x        ( "!x"      , "observable" , this , x , false , false )
+  , m_pdfs     ( "!pdfs"   , "components" , this )
+  , m_yields   ( "!yields" , "yields"     , this )
+  , m_extended ( false )
+{
+  m_pdfs.add ( pdf ) ;
+  //
+  book_ ( x , histo ) ;
+}
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::MoreRooFit::BinnedNLL::BinnedNLL
+( const Ostap::MoreRooFit::BinnedNLL& right ,
+  const char*                         name  )
+  : RooAbsReal ( right , name )
+  , m_x        ( "!x"      , this , right.m_x      )
+  , m_pdfs     ( "!pdfs"   , this , right.m_pdfs   )
+  , m_yields   ( "!yields" , this , right.m_yields )
+  , m_extended ( right.m_extended )
+  , m_edges    ( right.m_edges    )
+  , m_contents ( right.m_contents )
+  , m_ranges   ( right.m_ranges   )
+  , m_sumw     ( right.m_sumw     )
+{}
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::MoreRooFit::BinnedNLL::~BinnedNLL(){}
+// ============================================================================
+// clone method
+// ============================================================================
+Ostap::MoreRooFit::BinnedNLL*
+Ostap::MoreRooFit::BinnedNLL::clone ( const char* newname ) const
+{ return new Ostap::MoreRooFit::BinnedNLL ( *this , newname ) ; }
+// ============================================================================
+// book the bins and the named ranges
+// ============================================================================
+void Ostap::MoreRooFit::BinnedNLL::book_
+( RooRealVar& x     ,
+  const TH1&  histo )
+{
+  Ostap::Assert ( 1 == histo.GetDimension () ,
+                  "Invalid histogram dimension"    ,
+                  "Ostap::MoreRooFit::BinnedNLL"   , INVALID_HISTO ) ;
+  //
+  const double xmin = x.getMin () ;
+  const double xmax = x.getMax () ;
+  const double eps  = s_EPS * std::max ( std::abs ( xmin ) , std::abs ( xmax ) ) ;
+  //
+  const std::string prefix = "bnll" + std::to_string ( ++s_counter ) + "_" ;
+  //
+  // only the bins inside the range of the observable are used
+  const TAxis* axis = histo.GetXaxis () ;
+  for ( int ibin = 1 ; ibin <= axis->GetNbins () ; ++ibin )
+  {
+    const double low  = axis->GetBinLowEdge ( ibin ) ;
+    const double high = axis->GetBinUpEdge  ( ibin ) ;
+    if ( low < xmin - eps || xmax + eps < high ) { continue ; }
+    //
+    if ( m_edges.empty () ) { m_edges.push_back ( low ) ; }
+    m_edges   .push_back ( high ) ;
+    //
+    const double content = histo.GetBinContent ( ibin ) ;
+    m_contents.push_back ( content ) ;
+    m_sumw += content ;
+    //
+    const std::string range = prefix + std::to_string ( m_ranges.size () ) ;
+    x.setRange ( range.c_str () , low , high ) ;
+    m_ranges  .push_back ( range ) ;
+  }
+  //
+  Ostap::Assert ( !m_contents.empty () ,
+                  "No bins in the range of observable" ,
+                  "Ostap::MoreRooFit::BinnedNLL"       , NO_BINS ) ;
+}
+// ============================================================================
+// the parameters of the component are changed?
+// ============================================================================
+bool Ostap::MoreRooFit::BinnedNLL::changed_ ( const unsigned int component ) const
+{
+  std::vector<double>& snapshot = m_snapshots [ component ] ;
+  const std::vector<double> previous { snapshot } ;
+  values_ ( m_parameters [ component ].get () , snapshot ) ;
+  return previous != snapshot ;
+}
+// ============================================================================
+// calculate the bin integrals for the component
+// ============================================================================
+void Ostap::MoreRooFit::BinnedNLL::calculate_ ( const unsigned int component ) const
+{
+  const std::size_t nb     = m_contents.size () ;
+  double*           result = m_fractions.data () + component * nb ;
+  //
+  const RooAbsReal& pdf  = static_cast<const RooAbsReal&> ( *m_pdfs.at ( component ) ) ;
+  const Int_t       code = m_codes [ component ] ;
+  //
+  if ( 0 < code )
+  {
+    // the analytical integrals, e.g. Ostap::Math::XXX::integral ( low , high )
+    for ( std::size_t b = 0 ; b < nb ; ++b )
+    { result [ b ] = pdf.analyticalIntegral ( code , m_ranges [ b ].c_str () ) ; }
+  }
+  else
+  {
+    const std::vector<std::unique_ptr<RooAbsReal> >& integrals = m_integrals [ component ] ;
+    for ( std::size_t b = 0 ; b < nb ; ++b ) { result [ b ] = integrals [ b ]->getVal () ; }
+  }
+  //
+  // normalization: the whole range of observable (extended) or the sum over bins
+  double norm = 0 ;
+  if      ( !m_extended ) { norm = std::accumulate ( result , result + nb , 0.0 ) ; }
+  else if ( 0 < code    ) { norm = pdf.analyticalIntegral ( code , nullptr ) ; }
+  else                    { norm = m_integrals [ component ].back ()->getVal () ; }
+  //
+  if ( 0 < norm ) { std::transform ( result , result + nb , result , [norm] ( const double v ) { return v / norm ; } ) ; }
+  else            { std::fill      ( result , result + nb , 0.0 ) ; }
+  //
+  ++m_recalculations ;
+}
+// ============================================================================
+// (re)calculate the bin integrals for the components, if needed
+// ============================================================================
+void Ostap::MoreRooFit::BinnedNLL::update_ () const
+{
+  const unsigned int nc = nComponents () ;
+  //
+  if ( m_codes.size () != nc )
+  {
+    // the first call: the integration codes, parameters & all bin integrals
+    m_fractions .assign ( nc * m_contents.size () , 0.0 ) ;
+    m_codes     .assign ( nc , 0 ) ;
+    m_parameters.clear  () ; m_parameters.resize ( nc ) ;
+    m_snapshots .clear  () ; m_snapshots .resize ( nc ) ;
+    m_integrals .clear  () ; m_integrals .resize ( nc ) ;
+    //
+    const RooArgSet observables { m_x.arg () } ;
+    for ( unsigned int k = 0 ; k < nc ; ++k )
+    {
+      const RooAbsReal& pdf = static_cast<const RooAbsReal&> ( *m_pdfs.at ( k ) ) ;
+      //
+      RooArgSet all      { observables } ;
+      RooArgSet analytic {} ;
+      const Int_t code = pdf.getAnalyticalIntegral ( all , analytic , m_ranges.front ().c_str () ) ;
+      if ( 0 < code && analytic.contains ( m_x.arg () ) ) { m_codes [ k ] = code ; }
+      else
+      {
+        // no analytical integral: use RooFit machinery
+        for ( const std::string& range : m_ranges )
+        { m_integrals [ k ].emplace_back ( pdf.createIntegral ( observables , range.c_str () ) ) ; }
+        m_integrals [ k ].emplace_back ( pdf.createIntegral ( observables ) ) ;
+      }
+      //
+      m_parameters [ k ].reset ( pdf.getParameters ( observables ) ) ;
+      values_    ( m_parameters [ k ].get () , m_snapshots [ k ] ) ;
+      calculate_ ( k ) ;
+    }
+    return ;
+  }
+  //
+  for ( unsigned int k = 0 ; k < nc ; ++k )
+  { if ( changed_ ( k ) ) { calculate_ ( k ) ; } }
+}
+// ============================================================================
+/*  the expected number of entries in the bin
+ *  (the current parameters are used)
+ *  @param bin the bin, 0 <= bin < nBins()
+ */
+// ============================================================================
+double Ostap::MoreRooFit::BinnedNLL::expected ( const unsigned int bin ) const
+{
+  if ( nBins () <= bin ) { return 0 ; }
+  update_ () ;
+  //
+  const std::size_t nb = m_contents.size () ;
+  if ( !m_extended ) { return m_sumw * m_fractions [ bin ] ; }
+  //
+  double mu = 0 ;
+  for ( unsigned int k = 0 ; k < nComponents () ; ++k )
+  { mu += static_cast<const RooAbsReal*> ( m_yields.at ( k ) )->getVal () * m_fractions [ k * nb + bin ] ; }
+  return mu ;
+}
+// ============================================================================
+// the actual evaluation of the result
+// ============================================================================
+Double_t Ostap::MoreRooFit::BinnedNLL::evaluate () const
+{
+  update_ () ;
+  //
+  const std::size_t  nb = m_contents.size () ;
+  const unsigned int nc = nComponents    () ;
+  //
+  long double nll = 0 ;
+  if ( m_extended )
+  {
+    // expected numbers of entries: all bins, component by component
+    std::vector<double> mu ( nb , 0.0 ) ;
+    for ( unsigned int k = 0 ; k < nc ; ++k )
+    {
+      const double  yield = static_cast<const RooAbsReal*> ( m_yields.at ( k ) )->getVal () ;
+      const double* f     = m_fractions.data () + k * nb ;
+      for ( std::size_t b = 0 ; b < nb ; ++b ) { mu [ b ] += yield * f [ b ] ; }
+    }
+    //
+    for ( std::size_t b = 0 ; b < nb ; ++b )
+    {
+      const double n = m_contents [ b ] ;
+      const double m = std::max ( mu [ b ] , s_TINY ) ;
+      nll += m - n ;
+      if ( 0 < n ) { nll += n * std::log ( n / m ) ; }
+    }
+  }
+  else
+  {
+    for ( std::size_t b = 0 ; b < nb ; ++b )
+    {
+      const double n = m_contents [ b ] ;
+      if ( n <= 0 ) { continue ; }
+      const double m = std::max ( m_sumw * m_fractions [ b ] , s_TINY ) ;
+      nll += n * std::log ( n / m ) ;
+    }
+  }
+  //
+  return nll ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
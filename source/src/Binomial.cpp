@@ -3,6 +3,9 @@
 // STD& STL
 // ============================================================================
 #include <cmath>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
 // ============================================================================
 // GSL 
 // ============================================================================
@@ -14,6 +17,11 @@
 #include "Ostap/Binomial.h"
 #include "Ostap/MoreMath.h"
 // ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+// ============================================================================
 /** @file
  *  implementation of funcntions from file Ostap/Binomial.h
  * 
@@ -39,6 +47,282 @@ namespace
                              const double p )
   { return gsl_cdf_beta_Pinv      ( p , a , b ) ; } 
   // ==========================================================================
+  /// normal approximation ("Wald") interval for (effective) numbers of accepted/rejected events 
+  inline std::pair<double,double>
+  _wald_
+  ( const double accepted  ,
+    const double rejected  ,
+    const double conflevel )
+  {
+    if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    //
+    if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    const double a = accepted ;
+    const double p = a / ( a + rejected ) ;
+    if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
+    //
+    const double alpha = 1 - conflevel ;
+    const double  z    = _probit_ ( 1 - 0.5  * alpha ) ;
+    //
+    // adjust cases of p=0 and p=1
+    //
+    const double p1 =
+      0 == accepted ?   ( a + 1 ) / ( a + rejected + 1 ) :
+      0 == rejected ?   ( a     ) / ( a + rejected + 1 ) : p ;
+    //
+    const double  dx = std::sqrt ( p1 * ( 1 - p1 ) / ( accepted + rejected ) ) ;
+    //
+    const double low  = std::max ( 0.0 , p - z * dx ) ;
+    const double high = std::min ( 1.0 , p + z * dx ) ;
+    //
+    return std::make_pair ( low , high ) ;
+  }
+  // ==========================================================================
+  /// Wilson score interval for (effective) numbers of accepted/rejected events 
+  inline std::pair<double,double>
+  _wilson_
+  ( const double accepted  ,
+    const double rejected  ,
+    const double conflevel )
+  {
+    if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    //
+    if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    const double a = accepted ;
+    const double p = a / ( a + rejected ) ;
+    if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
+    //
+    const double alpha = 1 - conflevel ;
+    const double  z  = _probit_ ( 1 - 0.5  * alpha ) ;
+    //
+    const long double n = accepted + rejected ;
+    const double dx  = std::sqrt ( p * ( 1 - p ) / n + z * z / ( 4 * n * n ) ) ;
+    const double f1  = p + z * z / ( 2 * n ) ;
+    const double f2  = 1 / ( 1 + z * z / n ) ;
+    //
+    const double low  = f2 * ( f1 - z * dx ) ;
+    const double high = f2 * ( f1 + z * dx ) ;
+    //
+    return std::make_pair ( low  , high ) ;
+  }
+  // ==========================================================================
+  /// Wilson score interval with continuity correction for (effective) numbers of accepted/rejected events 
+  inline std::pair<double,double>
+  _wilson_cc_
+  ( const double accepted  ,
+    const double rejected  ,
+    const double conflevel )
+  {
+    if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    //
+    if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    const double a = accepted ;
+    const double p = a / ( a + rejected ) ;
+    if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
+    //
+    const double alpha = 1 - conflevel ;
+    const double  z  = _probit_ ( 1 - 0.5  * alpha ) ;
+    //
+    const double      np =  accepted ;
+    const long double n  = accepted + rejected ;
+    //
+    const double dx  = z * std::sqrt ( z*z - 1 / n + 4 * np * ( 1 - p ) + 4*p-2  ) + 1 ;
+    //
+    const double f1  =  2 * np + z * z ;
+    const double f2  =  1 / ( 2 * ( n + z*z ) ) ;
+    //
+    const double low  = std::max ( 0.0 , f2 * ( f1 - dx ) ) ;
+    const double high = std::min ( 1.0 , f2 * ( f1 + dx ) ) ;
+    //
+    return std::make_pair ( low  , high ) ;
+  }
+  // ==========================================================================
+  /// ArcSin interval for (effective) numbers of accepted/rejected events 
+  inline std::pair<double,double>
+  _arcsin_
+  ( const double accepted  ,
+    const double rejected  ,
+    const double conflevel )
+  {
+    if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    //
+    if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    const double a = accepted ;
+    const double p = a / ( a + rejected ) ;
+    if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
+    //
+    const double alpha = 1 - conflevel ;
+    const double  z  = _probit_ ( 1 - 0.5  * alpha ) ;
+    //
+    // const double p1  =
+    //  0 == accepted ? ( a + 1 ) / ( a + rejected     ) :
+    //  0 == rejected ? ( a     ) / ( a + rejected + 1 ) : p ;
+    const double p1  =
+      ( a + 3.0 / 8 ) / ( a + rejected + 3.0 / 4 ) ;
+    // 0 == accepted ? ( a + 1 ) / ( a + rejected     ) :
+    // 0 == rejected ? ( a     ) / ( a + rejected + 1 ) : p ;
+    //
+    const double asp   = std::asin ( std::sqrt ( p1 ) ) ;
+    //
+    const double n  = accepted + rejected ;
+    //
+    const double dx  = z / ( 0.5 * std::sqrt( n ) ) ;
+    //
+    const double l1  =
+      0 == accepted ? 0.0 : std::sin ( asp - dx ) ;
+    const double h1  =
+      0 == rejected ? 1.0 : std::sin ( asp + dx ) ;
+    //
+    return std::make_pair ( l1 * l1  , h1 * h1  ) ;
+  }
+  // ==========================================================================
+  /// Agresti-Coull interval for (effective) numbers of accepted/rejected events 
+  inline std::pair<double,double>
+  _agresti_coull_
+  ( const double accepted  ,
+    const double rejected  ,
+    const double conflevel )
+  {
+    if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    //
+    if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    const double a = accepted ;
+    const double p = a / ( a + rejected ) ;
+    if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
+    //
+    const double alpha = 1 - conflevel ;
+    const double  z  = _probit_ ( 1 - 0.5  * alpha ) ;
+    //
+    const double n1 = accepted + rejected + z * z ;
+    const double p1 = ( accepted + 0.5 * z * z ) / n1 ;
+    //
+    const double dx   = z * std::sqrt ( p1 * ( 1 - p1 ) / n1 ) ;
+    //
+    const double low  = std::max ( 0.0 , p1 - dx ) ;
+    const double high = std::min ( 1.0 , p1 + dx ) ;
+    //
+    return std::make_pair ( low , high ) ;
+  }
+  // ==========================================================================
+  /// Jeffreys interval for (effective) numbers of accepted/rejected events 
+  inline std::pair<double,double>
+  _jeffreys_
+  ( const double accepted  ,
+    const double rejected  ,
+    const double conflevel )
+  {
+    if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    //
+    if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    const double a = accepted ;
+    const double p = a / ( a + rejected ) ;
+    if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
+    //
+    const double alpha = 1 - conflevel ;
+    //
+    const double low   =
+      0 == accepted ? 0.0 : ibeta_inv (  accepted + 0.5 , rejected + 0.5 ,     0.5 * alpha ) ;
+    const double high  =
+      0 == rejected ? 1.0 : ibeta_inv (  accepted + 0.5 , rejected + 0.5 , 1 - 0.5 * alpha ) ;
+    //
+    return std::make_pair ( low  , high ) ;
+  }
+  // ==========================================================================
+  /// Clopper-Pearson interval for (effective) numbers of accepted/rejected events 
+  inline std::pair<double,double>
+  _clopper_pearson_
+  ( const double accepted  ,
+    const double rejected  ,
+    const double conflevel )
+  {
+    if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    //
+    if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
+    const double a = accepted ;
+    const double p = a / ( a + rejected ) ;
+    if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
+    //
+    const double alpha = 1 - conflevel ;
+    //
+    const double low   =
+      0 == accepted ? 0.0 : ibeta_inv (  accepted     , rejected + 1 ,     0.5 * alpha ) ;
+    const double high  =
+      0 == rejected ? 1.0 : ibeta_inv (  accepted + 1 , rejected     , 1 - 0.5 * alpha ) ;
+    //
+    return std::make_pair ( low  , high ) ;
+  }
+  // ==========================================================================
+  /// dispatch the interval type 
+  inline std::pair<double,double>
+  _interval_
+  ( const Ostap::Math::BinomialInterval type      ,
+    const double                        accepted  ,
+    const double                        rejected  ,
+    const double                        conflevel )
+  {
+    switch ( type )
+    {
+    case Ostap::Math::BinomialInterval::Wald                  :
+      return _wald_            ( accepted , rejected , conflevel ) ;
+    case Ostap::Math::BinomialInterval::WilsonScore           :
+      return _wilson_          ( accepted , rejected , conflevel ) ;
+    case Ostap::Math::BinomialInterval::WilsonScoreContinuity :
+      return _wilson_cc_       ( accepted , rejected , conflevel ) ;
+    case Ostap::Math::BinomialInterval::ArcSin                :
+      return _arcsin_          ( accepted , rejected , conflevel ) ;
+    case Ostap::Math::BinomialInterval::AgrestiCoull          :
+      return _agresti_coull_   ( accepted , rejected , conflevel ) ;
+    case Ostap::Math::BinomialInterval::Jeffreys              :
+      return _jeffreys_        ( accepted , rejected , conflevel ) ;
+    case Ostap::Math::BinomialInterval::ClopperPearson        :
+      return _clopper_pearson_ ( accepted , rejected , conflevel ) ;
+    default : break ;
+    }
+    Ostap::throwException ( "Invalid type of binomial interval" ,
+                            "Ostap::Math::binomial_intervals"   ) ;
+    return std::make_pair ( 0.0 , 1.0 ) ;
+  }
+  // ==========================================================================
+  /** run the loop in parallel
+   *  @param n        number of items 
+   *  @param nthreads number of threads
+   *  @param action   the action for the item 
+   */
+  template <class ACTION>
+  void parallel_loop
+  ( const std::size_t  n        ,
+    const unsigned int nthreads ,
+    ACTION             action   )
+  {
+    const std::size_t  block = 256 ;
+    const std::size_t  nb    = ( n + block - 1 ) / block ;
+    const unsigned int nt    = std::min<std::size_t>
+      ( nb , 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ;
+    if ( nt <= 1 )
+    {
+      for ( std::size_t i = 0 ; i < n ; ++i ) { action ( i ) ; }
+      return ;                                                    // RETURN
+    }
+    //
+    std::atomic<std::size_t> next { 0 } ;
+    Ostap::Utils::WorkerPool pool ( nt ) ;
+    pool.run ( [&] ( const unsigned int /* index */ )
+      {
+        for ( std::size_t b = next++ ; b < nb ; b = next++ )
+        {
+          const std::size_t last = std::min ( n , ( b + 1 ) * block ) ;
+          for ( std::size_t i = b * block ; i < last ; ++i ) { action ( i ) ; }
+        }
+      } ) ;
+  }
+  // ==========================================================================
+  /// hash for the pair (accepted,rejected)
+  struct PairHash
+  {
+    std::size_t operator() ( const std::pair<unsigned long,unsigned long>& p ) const
+    { return std::hash<unsigned long>() ( p.first ) ^ ( std::hash<unsigned long>() ( p.second ) * 0x9e3779b97f4a7c15ULL ) ; }
+  } ;
+  // ==========================================================================
 }
 // ============================================================================
 /* get quantile function for standard normal distribution
@@ -70,30 +354,7 @@ Ostap::Math::wald_interval
   const unsigned long rejected  ,
   const double        conflevel )
 {
-  //
-  if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  //
-  if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  const double a = accepted ;
-  const double p = a / ( a + rejected ) ;
-  if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
-  //
-  const double alpha = 1 - conflevel ;
-  const double  z    = _probit_ ( 1 - 0.5  * alpha ) ;
-  //
-  // adjust cases of p=0 and p=1
-  //
-  const double p1 =
-    0 == accepted ?   ( a + 1 ) / ( a + rejected + 1 ) :
-    0 == rejected ?   ( a     ) / ( a + rejected + 1 ) : p ;
-  //
-  const double  dx = std::sqrt ( p1 * ( 1 - p1 ) / ( accepted + rejected ) ) ;
-  //
-  const double low  = std::max ( 0.0 , p - z * dx ) ;
-  const double high = std::min ( 1.0 , p + z * dx ) ;
-  //
-  return std::make_pair ( low , high ) ;
-  //
+  return _wald_ ( accepted , rejected , conflevel ) ;
 }
 // ============================================================================
 /*  Wilson score interval for binomial proportion/efficiency 
@@ -111,25 +372,7 @@ Ostap::Math::wilson_score_interval
   const unsigned long rejected  ,
   const double        conflevel )
 {
-  if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  //
-  if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  const double a = accepted ;
-  const double p = a / ( a + rejected ) ;
-  if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
-  //
-  const double alpha = 1 - conflevel ;
-  const double  z  = _probit_ ( 1 - 0.5  * alpha ) ;
-  //
-  const long double n = accepted + rejected ;
-  const double dx  = std::sqrt ( p * ( 1 - p ) / n + z * z / ( 4 * n * n ) ) ;
-  const double f1  = p + z * z / ( 2 * n ) ;
-  const double f2  = 1 / ( 1 + z * z / n ) ;
-  //
-  const double low  = f2 * ( f1 - z * dx ) ;
-  const double high = f2 * ( f1 + z * dx ) ;
-  //
-  return std::make_pair ( low  , high ) ;  
+  return _wilson_ ( accepted , rejected , conflevel ) ;
 }
 // ============================================================================
 /*  Wilson score interval with continuity correction for binomial proportion/efficiency 
@@ -147,28 +390,7 @@ Ostap::Math::wilson_score_continuity_interval
   const unsigned long rejected  ,
   const double        conflevel )
 {
-  if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  //
-  if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  const double a = accepted ;
-  const double p = a / ( a + rejected ) ;
-  if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
-  //
-  const double alpha = 1 - conflevel ;
-  const double  z  = _probit_ ( 1 - 0.5  * alpha ) ;
-  //
-  const double      np =  accepted ;
-  const long double n  = accepted + rejected ;
-  //
-  const double dx  = z * std::sqrt ( z*z - 1 / n + 4 * np * ( 1 - p ) + 4*p-2  ) + 1 ;
-  //
-  const double f1  =  2 * np + z * z ;
-  const double f2  =  1 / ( 2 * ( n + z*z ) ) ;
-  //
-  const double low  = std::max ( 0.0 , f2 * ( f1 - dx ) ) ;
-  const double high = std::min ( 1.0 , f2 * ( f1 + dx ) ) ;
-  //
-  return std::make_pair ( low  , high ) ;  
+  return _wilson_cc_ ( accepted , rejected , conflevel ) ;
 }
 // ============================================================================
 /*  ArcSin interval with continuity correction for binomial proportion/efficiency 
@@ -186,36 +408,7 @@ Ostap::Math::arcsin_interval
   const unsigned long rejected  ,
   const double        conflevel )
 {
-  if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  //
-  if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  const double a = accepted ;
-  const double p = a / ( a + rejected ) ;
-  if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
-  //
-  const double alpha = 1 - conflevel ;
-  const double  z  = _probit_ ( 1 - 0.5  * alpha ) ;
-  //
-  // const double p1  =
-  //  0 == accepted ? ( a + 1 ) / ( a + rejected     ) :
-  //  0 == rejected ? ( a     ) / ( a + rejected + 1 ) : p ;
-  const double p1  =
-    ( a + 3.0 / 8 ) / ( a + rejected + 3.0 / 4 ) ;
-  // 0 == accepted ? ( a + 1 ) / ( a + rejected     ) :
-  // 0 == rejected ? ( a     ) / ( a + rejected + 1 ) : p ;
-  //
-  const double asp   = std::asin ( std::sqrt ( p1 ) ) ;
-  //
-  const double n  = accepted + rejected ;
-  //
-  const double dx  = z / ( 0.5 * std::sqrt( n ) ) ;
-  //
-  const double l1  =
-    0 == accepted ? 0.0 : std::sin ( asp - dx ) ;
-  const double h1  =
-    0 == rejected ? 1.0 : std::sin ( asp + dx ) ;
-  //
-  return std::make_pair ( l1 * l1  , h1 * h1  ) ;  
+  return _arcsin_ ( accepted , rejected , conflevel ) ;
 }
 // ============================================================================
 /*  Agresti-Coull interval with continuity correction for binomial proportion/efficiency 
@@ -233,25 +426,7 @@ Ostap::Math::agresti_coull_interval
   const unsigned long rejected  ,
   const double        conflevel )
 {
-  if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  //
-  if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  const double a = accepted ;
-  const double p = a / ( a + rejected ) ;
-  if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
-  //
-  const double alpha = 1 - conflevel ;
-  const double  z  = _probit_ ( 1 - 0.5  * alpha ) ;
-  //
-  const double n1 = accepted + rejected + z * z ;
-  const double p1 = ( accepted + 0.5 * z * z ) / n1 ;
-  //
-  const double dx   = z * std::sqrt ( p1 * ( 1 - p1 ) / n1 ) ;
-  //
-  const double low  = std::max ( 0.0 , p1 - dx ) ;
-  const double high = std::min ( 1.0 , p1 + dx ) ;
-  //
-  return std::make_pair ( low , high ) ;  
+  return _agresti_coull_ ( accepted , rejected , conflevel ) ;
 }
 // ============================================================================
 /*  Jeffreys interval for binomial proportion/efficiency 
@@ -271,22 +446,7 @@ Ostap::Math::jeffreys_interval
   const unsigned long rejected  ,
   const double        conflevel )
 {
-  //
-  if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  //
-  if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  const double a = accepted ;
-  const double p = a / ( a + rejected ) ;
-  if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
-  //
-  const double alpha = 1 - conflevel ;
-  //
-  const double low   =
-    0 == accepted ? 0.0 : ibeta_inv (  accepted + 0.5 , rejected + 0.5 ,     0.5 * alpha ) ;
-  const double high  =
-    0 == rejected ? 1.0 : ibeta_inv (  accepted + 0.5 , rejected + 0.5 , 1 - 0.5 * alpha ) ;
-  //
-  return std::make_pair ( low  , high ) ;
+  return _jeffreys_ ( accepted , rejected , conflevel ) ;
 }
 // ============================================================================
 /* Clopper-Pearson interval for binomial proportion/efficiency 
@@ -305,24 +465,127 @@ Ostap::Math::clopper_pearson_interval
   const unsigned long rejected  ,
   const double        conflevel )
 {
-  //
-  if ( 0 == accepted && 0 == rejected ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  //
-  if ( 1 <= conflevel ) { return std::make_pair ( 0.0 , 1.0 ) ; }
-  const double a = accepted ;
-  const double p = a / ( a + rejected ) ;
-  if ( 0 >= conflevel  ) { return std::make_pair ( p , p )     ; }
-  //
-  const double alpha = 1 - conflevel ;
-  //
-  const double low   =
-    0 == accepted ? 0.0 : ibeta_inv (  accepted     , rejected + 1 ,     0.5 * alpha ) ;
-  const double high  =
-    0 == rejected ? 1.0 : ibeta_inv (  accepted + 1 , rejected     , 1 - 0.5 * alpha ) ;
-  //
-  return std::make_pair ( low  , high ) ;
+  return _clopper_pearson_ ( accepted , rejected , conflevel ) ;
 }
 
+// ============================================================================
+/*  batch calculation of the confidence intervals for
+ *  binomial proportions/efficiencies
+ *  @param  type      the type of the interval 
+ *  @param  accepted  numbers of accepted events
+ *  @param  rejected  numbers of rejected events
+ *  @param  conflevel the confidence level:    0<=CL<=1 
+ *  @param  low       (output) the lower edges of the intervals 
+ *  @param  high      (output) the upper edges of the intervals 
+ *  @param  nthreads  number of threads (0: all, 1: sequential)
+ *  @return number of calculated intervals 
+ */
+// ============================================================================
+std::size_t 
+Ostap::Math::binomial_intervals
+( const Ostap::Math::BinomialInterval type      ,
+  const std::vector<unsigned long>&   accepted  ,
+  const std::vector<unsigned long>&   rejected  ,
+  const double                        conflevel ,
+  std::vector<double>&                low       ,
+  std::vector<double>&                high      ,
+  const unsigned int                  nthreads  )
+{
+  Ostap::Assert ( accepted.size () == rejected.size () ,
+                  "Mismatch in array sizes"            ,
+                  "Ostap::Math::binomial_intervals"    ) ;
+  //
+  const std::size_t N = accepted.size () ;
+  low .resize ( N ) ;
+  high.resize ( N ) ;
+  if ( 0 == N ) { return 0 ; }                                     // RETURN 
+  //
+  // the same (accepted,rejected) pairs are very frequent for the 
+  // efficiency maps (e.g. empty bins or 100% efficiency),
+  // therefore each distinct pair is calculated only once 
+  typedef std::pair<unsigned long,unsigned long> Key ;
+  std::unordered_map<Key,std::size_t,PairHash> index ;
+  index.reserve ( N ) ;
+  std::vector<Key>         keys  ; keys.reserve ( N ) ;
+  std::vector<std::size_t> where ( N ) ;
+  for ( std::size_t i = 0 ; i < N ; ++i )
+  {
+    const Key key { accepted [ i ] , rejected [ i ] } ;
+    auto it = index.emplace ( key , keys.size () ) ;
+    if ( it.second ) { keys.push_back ( key ) ; }
+    where [ i ] = it.first->second ;
+  }
+  //
+  std::vector<std::pair<double,double> > results ( keys.size () ) ;
+  parallel_loop ( keys.size () , nthreads , [&] ( const std::size_t k )
+    { results [ k ] = _interval_ ( type , keys [ k ].first , keys [ k ].second , conflevel ) ; } ) ;
+  //
+  for ( std::size_t i = 0 ; i < N ; ++i )
+  {
+    const auto& r = results [ where [ i ] ] ;
+    low  [ i ] = r.first  ;
+    high [ i ] = r.second ;
+  }
+  //
+  return N ;
+}
+// ============================================================================
+/*  batch calculation of the confidence intervals for
+ *  binomial proportions/efficiencies for the weighted data.
+ *  @param  type      the type of the interval 
+ *  @param  sumwa     sums of weights   for accepted events
+ *  @param  sumw2a    sums of weights^2 for accepted events
+ *  @param  sumwr     sums of weights   for rejected events
+ *  @param  sumw2r    sums of weights^2 for rejected events
+ *  @param  conflevel the confidence level:    0<=CL<=1 
+ *  @param  low       (output) the lower edges of the intervals 
+ *  @param  high      (output) the upper edges of the intervals 
+ *  @param  nthreads  number of threads (0: all, 1: sequential)
+ *  @return number of calculated intervals 
+ */
+// ============================================================================
+std::size_t 
+Ostap::Math::binomial_intervals
+( const Ostap::Math::BinomialInterval type      ,
+  const std::vector<double>&          sumwa     ,
+  const std::vector<double>&          sumw2a    ,
+  const std::vector<double>&          sumwr     ,
+  const std::vector<double>&          sumw2r    ,
+  const double                        conflevel ,
+  std::vector<double>&                low       ,
+  std::vector<double>&                high      ,
+  const unsigned int                  nthreads  )
+{
+  const std::size_t N = sumwa.size () ;
+  Ostap::Assert ( N == sumw2a.size () && N == sumwr.size () && N == sumw2r.size () ,
+                  "Mismatch in array sizes"            ,
+                  "Ostap::Math::binomial_intervals"    ) ;
+  //
+  low .resize ( N ) ;
+  high.resize ( N ) ;
+  if ( 0 == N ) { return 0 ; }                                     // RETURN 
+  //
+  parallel_loop ( N , nthreads , [&] ( const std::size_t i )
+    {
+      const double sw  = sumwa  [ i ] + sumwr  [ i ] ;
+      const double sw2 = sumw2a [ i ] + sumw2r [ i ] ;
+      if ( sw <= 0 || sw2 <= 0 ) { low [ i ] = 0 ; high [ i ] = 1 ; return ; }
+      //
+      const double eff  = std::min ( 1.0 , std::max ( 0.0 , sumwa [ i ] / sw ) ) ;
+      const double neff = sw * sw / sw2 ;
+      const double a    = 0 >= sumwa [ i ] ? 0.0  :
+        0 >= sumwr [ i ] ? neff : eff * neff ;
+      const double r    = 0 >= sumwa [ i ] ? neff :
+        0 >= sumwr [ i ] ? 0.0  : neff - a ;
+      //
+      const std::pair<double,double> res = _interval_ ( type , a , r , conflevel ) ;
+      low  [ i ] = res.first  ;
+      high [ i ] = res.second ;
+    } ) ;
+  //
+  return N ;
+}
+// ============================================================================
 
 // ============================================================================
 // The END 
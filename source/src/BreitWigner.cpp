@@ -16,6 +16,7 @@
 #include "Ostap/DalitzIntegrator.h"
 #include "Ostap/Workspace.h"
 #include "Ostap/Models.h"
+#include "Ostap/ChebyshevApproximation.h"
 // ============================================================================
 // local
 // ============================================================================
@@ -50,6 +51,61 @@ namespace
    */
   const Ostap::Math::WorkSpace s_WS ;
   // ==========================================================================
+  /** approximate the function in the range [smin,smax] with 
+   *  Chebyshev polynomials, the order is doubled until the 
+   *  required precision is reached at the control points 
+   *  - the control points are the midpoints of the uniform grid 
+   *  - the precision is defined relative to the maximal value of the function
+   *  @param width     (UPDATE) the function to be approximated 
+   *  @param smin      (INPUT)  low  edge 
+   *  @param smax      (INPUT)  high edge 
+   *  @param precision (INPUT)  the required precision 
+   *  @param nmax      (INPUT)  the maximal order 
+   *  @param order     (OUTPUT) the order of the approximation 
+   *  @return the achieved precision 
+   */
+  double _approximate_ 
+  ( std::function<double(double)>& width     , 
+    const double                   smin      , 
+    const double                   smax      , 
+    const double                   precision , 
+    const unsigned short           nmax      , 
+    unsigned short&                order     ) 
+  {
+    order = 0 ;
+    if ( !( smin < smax ) ) { return -1 ; }
+    //
+    const std::function<double(double)> original { width } ;
+    double achieved = -1 ;
+    for ( unsigned short N = 16 ; N <= nmax ; N *= 2 ) 
+    {
+      const Ostap::Math::ChebyshevApproximation approx ( original , smin , smax , N ) ;
+      //
+      const unsigned int nc   = 2 * N + 1 ;
+      const double       ds   = ( smax - smin ) / nc ;
+      double             fmax = 0 ;
+      double             dmax = 0 ;
+      for ( unsigned int i = 0 ; i < nc ; ++i ) 
+      {
+        const double s  = smin + ( i + 0.5 ) * ds ;
+        const double f  = original ( s ) ;
+        fmax = std::max ( fmax , std::abs ( f              ) ) ;
+        dmax = std::max ( dmax , std::abs ( f - approx ( s ) ) ) ;
+      }
+      achieved = 0 < fmax ? dmax / fmax : dmax ;
+      //
+      if ( achieved <= precision ) 
+      {
+        order = N ;
+        width = [approx,original,smin,smax] ( const double s ) -> double 
+          { return smin <= s && s <= smax ? approx ( s ) : original ( s ) ; } ;
+        break ;
+      }
+      if ( 2 * N > nmax ) { break ; }
+    }
+    return achieved ;
+  }
+  // ==========================================================================
 } //                                            The end of  anonymous namespace 
 // ============================================================================
 // Rho-functions from Jackson
@@ -589,6 +645,29 @@ std::size_t Ostap::Math::ChannelWidth::tag () const
                               m_tag          ) ; 
 }
 // ============================================================================
+/*  approximate the mass-dependent width in the range 
+ *  \f$ s_{min} \le s \le s_{max} \f$ with Chebyshev polynomials. 
+ *  @param smin      (INPUT) low  edge of the range 
+ *  @param smax      (INPUT) high edge of the range 
+ *  @param precision (INPUT) the required relative precision 
+ *  @param nmax      (INPUT) the maximal order of approximation 
+ *  @return the achieved precision
+ */
+// ============================================================================
+double Ostap::Math::ChannelWidth::approximate 
+( const double         smin      , 
+  const double         smax      , 
+  const double         precision , 
+  const unsigned short nmax      ) 
+{
+  const double   low   = std::max ( smin , m_sthreshold ) ;
+  unsigned short order = 0 ;
+  const double result  = _approximate_ ( m_w , low , smax , precision , nmax , order ) ;
+  // the function is changed: update the tag 
+  if ( 0 < order ) { m_tag = std::hash_combine ( m_tag , low , smax , order ) ; }
+  return result ;
+}
+// ============================================================================
 
 
 // ============================================================================
@@ -627,6 +706,29 @@ std::size_t Ostap::Math::ChannelGamma::tag () const
                               m_tag          ) ; 
 }
 // ============================================================================
+/*  approximate the mass-dependent width in the range 
+ *  \f$ s_{min} \le s \le s_{max} \f$ with Chebyshev polynomials. 
+ *  @param smin      (INPUT) low  edge of the range 
+ *  @param smax      (INPUT) high edge of the range 
+ *  @param precision (INPUT) the required relative precision 
+ *  @param nmax      (INPUT) the maximal order of approximation 
+ *  @return the achieved precision
+ */
+// ============================================================================
+double Ostap::Math::ChannelGamma::approximate 
+( const double         smin      , 
+  const double         smax      , 
+  const double         precision , 
+  const unsigned short nmax      ) 
+{
+  const double   low   = std::max ( smin , m_sthreshold ) ;
+  unsigned short order = 0 ;
+  const double result  = _approximate_ ( m_gamma , low , smax , precision , nmax , order ) ;
+  // the function is changed: update the tag 
+  if ( 0 < order ) { m_tag = std::hash_combine ( m_tag , low , smax , order ) ; }
+  return result ;
+}
+// ============================================================================
 
 
 
@@ -4,16 +4,17 @@
 // STD&STL
 // ============================================================================
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
 // ============================================================================
 // GSL
 // ============================================================================
 #include "gsl/gsl_math.h"
 #include "gsl/gsl_chebyshev.h"
 // ============================================================================
-// ROOT 
-// ============================================================================
-#include "Math/GSLFunctionAdapter.h"
-// ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/ChebyshevApproximation.h"
@@ -23,6 +24,8 @@
 // Local
 // ============================================================================
 #include "Exception.h"
+#include "local_fft.h"
+#include "local_mt.h"
 // ============================================================================
 /** @file
  *  Implementation file for class Ostap::Math::ChebyshevApproximation
@@ -40,8 +43,75 @@ namespace
   const char s_METHOD4 [] = "Ostap::Math::ChebyshevApproximation::operator+"  ;
   const char s_METHOD5 [] = "Ostap::Math::ChebyshevApproximation::operator*"  ;
   const char s_METHOD6 [] = "Ostap::Math::ChebyshevApproximation::polynomial" ;
+  const char s_METHOD7 [] = "Ostap::Math::ChebyshevProxy"                     ;
+  const char s_METHOD8 [] = "Ostap::Math::ChebyshevApproximation::adaptive"   ;
   const Ostap::StatusCode s_SC =  Ostap::StatusCode::FAILURE                  ;
   // ==========================================================================
+  /** evaluate the function at the points \f$ x_i = m + h t_i \f$
+   *  (in parallel for nthreads>1)
+   */
+  void evaluate_at 
+  ( const std::function<double(double)>& func     , 
+    const double                         m        , 
+    const double                         h        , 
+    const std::vector<double>&           t        , 
+    const unsigned int                   nthreads , 
+    double*                              result   ) 
+  {
+    const std::size_t  n     = t.size () ;
+    const std::size_t  block = 16 ;
+    const std::size_t  nb    = ( n + block - 1 ) / block ;
+    const unsigned int nt    = std::min<std::size_t> 
+      ( nb , nthreads <= 1 ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ;
+    if ( nt <= 1 ) 
+    {
+      for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = func ( m + h * t [ i ] ) ; }
+      return ;                                                    // RETURN 
+    }
+    //
+    std::atomic<std::size_t> next { 0 } ;
+    Ostap::Utils::WorkerPool pool ( nt ) ;
+    pool.run ( [&] ( const unsigned int /* index */ ) 
+      {
+        for ( std::size_t b = next++ ; b < nb ; b = next++ ) 
+        {
+          const std::size_t last = std::min ( n , ( b + 1 ) * block ) ;
+          for ( std::size_t i = b * block ; i < last ; ++i ) 
+          { result [ i ] = func ( m + h * t [ i ] ) ; }
+        }
+      } ) ;
+  }
+  // ==========================================================================
+  /** DCT-II via FFT of the symmetric extension (length 2n):
+   *  \f$ X_k = \sum_{j=0}^{n-1} f_j \cos \frac{\pi k (j+1/2)}{n} \f$
+   */
+  std::vector<double> dct2 ( const std::vector<double>& f ) 
+  {
+    const std::size_t n = f.size () ;
+    std::vector<std::complex<double> > y ( 2 * n ) ;
+    for ( std::size_t j = 0 ; j < n ; ++j ) { y [ j ] = y [ 2 * n - 1 - j ] = f [ j ] ; }
+    Ostap::Math::FFT::fft ( y ) ;
+    std::vector<double> X ( n ) ;
+    for ( std::size_t k = 0 ; k < n ; ++k ) 
+    { X [ k ] = 0.5 * ( std::polar ( 1.0 , -M_PI * k / ( 2.0 * n ) ) * y [ k ] ).real () ; }
+    return X ;
+  }
+  // ==========================================================================
+  /** DCT-I via FFT of the even extension (length 2N):
+   *  \f$ X_k = f_0 + (-1)^k f_N + 2 \sum_{j=1}^{N-1} f_j \cos \frac{\pi k j}{N} \f$
+   */
+  std::vector<double> dct1 ( const std::vector<double>& f ) 
+  {
+    const std::size_t N = f.size () - 1 ;
+    std::vector<std::complex<double> > y ( 2 * N ) ;
+    for ( std::size_t j = 0 ; j <= N ; ++j ) { y [ j ] = f [ j ] ; }
+    for ( std::size_t j = 1 ; j <  N ; ++j ) { y [ 2 * N - j ] = f [ j ] ; }
+    Ostap::Math::FFT::fft ( y ) ;
+    std::vector<double> X ( N + 1 ) ;
+    for ( std::size_t k = 0 ; k <= N ; ++k ) { X [ k ] = y [ k ].real () ; }
+    return X ;
+  }
+  // ==========================================================================
 }
 // ============================================================================
 /*  constructor from the function, low/high-limits and the approximation order 
@@ -52,25 +122,35 @@ namespace
  */
 // ============================================================================
 Ostap::Math::ChebyshevApproximation::ChebyshevApproximation
-( std::function<double(double)> func , 
-  const double                  a    , 
-  const double                  b    , 
-  const unsigned short          N    ) 
+( std::function<double(double)> func     , 
+  const double                  a        , 
+  const double                  b        , 
+  const unsigned short          N        , 
+  const unsigned int            nthreads ) 
   : m_a ( std::min ( a , b ) )
   , m_b ( std::max ( a , b ) )
   , m_N ( N )
   , m_chebyshev ( nullptr )
 {
   //
-  ROOT::Math::GSLFunctionAdapter< std::function<double(double)> > adapter ;
-  const void* p = &func ;
+  // the same nodes and coefficients as gsl_cheb_init, but via DCT-II 
+  const std::size_t   n = m_N + 1 ;
+  std::vector<double> t ( n ) ;
+  for ( std::size_t k = 0 ; k < n ; ++k ) { t [ k ] = std::cos ( M_PI * ( k + 0.5 ) / n ) ; }
   //
-  gsl_function F ;
-  F.function = &adapter.F ;
-  F.params   = const_cast<void*> (p) ;
+  std::vector<double> f ( n ) ;
+  evaluate_at ( func , 0.5 * ( m_b + m_a ) , 0.5 * ( m_b - m_a ) , t , nthreads , f.data () ) ;
+  const std::vector<double> c = dct2 ( f ) ;
   //
   gsl_cheb_series* ns = gsl_cheb_alloc ( m_N ) ;  
-  gsl_cheb_init ( ns , &F , m_a , m_b ) ;
+  ns -> a        = m_a ;
+  ns -> b        = m_b ;
+  ns -> order_sp = m_N ;
+  for ( std::size_t k = 0 ; k < n ; ++k ) 
+  {
+    ns -> c [ k ] = 2 * c [ k ] / n ;
+    ns -> f [ k ] = f [ k ] ;
+  }
   //
   m_chebyshev = (char*) ns ;
 }
@@ -90,9 +170,108 @@ Ostap::Math::ChebyshevApproximation::ChebyshevApproximation
   : ChebyshevApproximation ( std::function<double(double)> ( std::cref ( func ) ) , a ,  b , N )
 {}
 // ============================================================================
-
-
-
+/*  Build chebyshev approximation with the adaptive choice of the order
+ *  @param f         the function 
+ *  @param a         low   edge 
+ *  @param b         high edge 
+ *  @param precision the (relative to max|f|) precision 
+ *  @param Nmax      the maximal order of approximation 
+ *  @param nthreads  number of threads for the evaluation of the function
+ */
+// ============================================================================
+Ostap::Math::ChebyshevApproximation
+Ostap::Math::ChebyshevApproximation::adaptive 
+( std::function<double(double)> f         , 
+  const double                  a         , 
+  const double                  b         , 
+  const double                  precision , 
+  const unsigned short          Nmax      , 
+  const unsigned int            nthreads  ) 
+{
+  const double xmin = std::min ( a , b ) ;
+  const double xmax = std::max ( a , b ) ;
+  Ostap::Assert ( xmin < xmax && std::isfinite ( xmin ) && std::isfinite ( xmax ) , 
+                  "Invalid interval!" , s_METHOD8 , s_SC ) ;
+  //
+  const double        m    = 0.5 * ( xmax + xmin ) ;
+  const double        h    = 0.5 * ( xmax - xmin ) ;
+  const double        eps  = std::max ( std::abs ( precision ) , std::numeric_limits<double>::epsilon () ) ;
+  const std::size_t   NMAX = std::max ( Nmax , (unsigned short) 16 ) ;
+  //
+  // the initial Chebyshev-Lobatto points: t_j = cos ( pi j / N ) , j = 0 .. N 
+  std::size_t         N    = 16 ;
+  std::vector<double> t    ( N + 1 ) ;
+  for ( std::size_t j = 0 ; j <= N ; ++j ) { t [ j ] = std::cos ( M_PI * j / N ) ; }
+  std::vector<double> fv   ( N + 1 ) ;
+  evaluate_at ( f , m , h , t , nthreads , fv.data () ) ;
+  //
+  std::vector<double> c    ;
+  double              scale = 0 ;
+  while ( true ) 
+  {
+    // coefficients of the interpolating polynomial 
+    c = dct1 ( fv ) ;
+    for ( double& ck : c ) { ck /= N ; }
+    c [ N ] *= 0.5 ;
+    //
+    scale = 0 ;
+    for ( const double v : fv ) { if ( std::isfinite ( v ) ) { scale = std::max ( scale , std::abs ( v ) ) ; } }
+    //
+    const double tail = std::abs ( c [ N ] ) + std::abs ( c [ N - 1 ] ) + std::abs ( c [ N - 2 ] ) ;
+    if ( tail <= 0.1 * eps * scale || NMAX < 2 * N ) { break ; }
+    //
+    // double the number of points: the old points are the even ones 
+    t.resize ( N ) ;
+    for ( std::size_t i = 0 ; i < N ; ++i ) { t [ i ] = std::cos ( M_PI * ( 2 * i + 1 ) / ( 2 * N ) ) ; }
+    std::vector<double> fnew ( N ) ;
+    evaluate_at ( f , m , h , t , nthreads , fnew.data () ) ;
+    //
+    std::vector<double> fall ( 2 * N + 1 ) ;
+    for ( std::size_t j = 0 ; j <= N ; ++j ) { fall [ 2 * j     ] = fv   [ j ] ; }
+    for ( std::size_t i = 0 ; i <  N ; ++i ) { fall [ 2 * i + 1 ] = fnew [ i ] ; }
+    fv.swap ( fall ) ;
+    N *= 2 ;
+  }
+  //
+  // truncate the negligible tail: the sum of dropped coefficients is small 
+  std::size_t order   = N ;
+  double      dropped = 0 ;
+  while ( 1 < order && dropped + std::abs ( c [ order ] ) <= 0.5 * eps * scale ) 
+  { dropped += std::abs ( c [ order ] ) ; --order ; }
+  //
+  ChebyshevApproximation result ;
+  result.m_a = xmin  ;
+  result.m_b = xmax  ;
+  result.m_N = order ;
+  //
+  gsl_cheb_series* ns = gsl_cheb_alloc ( order ) ;
+  ns -> a        = xmin  ;
+  ns -> b        = xmax  ;
+  ns -> order_sp = order ;
+  // NB: the function values at the GSL nodes are not known (and not needed) 
+  std::copy ( c.begin () , c.begin () + ( order + 1 ) , ns -> c ) ;
+  std::fill ( ns -> f , ns -> f + ( order + 1 ) , 0.0 ) ;
+  //
+  result.m_chebyshev = (char*) ns ;
+  return result ;
+}
+// ============================================================================
+/*  Build chebyshev approximation with the adaptive choice of the order
+ *  @param f         the function 
+ *  @param a         low   edge 
+ *  @param b         high edge 
+ *  @param precision the (relative to max|f|) precision 
+ *  @param Nmax      the maximal order of approximation 
+ */
+// ============================================================================
+Ostap::Math::ChebyshevApproximation
+Ostap::Math::ChebyshevApproximation::adaptive 
+( const Ostap::Functions::PyCallable& f         , 
+  const double                        a         , 
+  const double                        b         , 
+  const double                        precision , 
+  const unsigned short                Nmax      ) 
+{ return adaptive ( std::function<double(double)> ( std::cref ( f ) ) , a , b , precision , Nmax , 1 ) ; }
 // ============================================================================
 // default (protected) constructor 
 // ============================================================================
@@ -314,6 +493,245 @@ Ostap::Math::ChebyshevApproximation::polynomial() const
 // ============================================================================
 
 
+// ============================================================================
+/*  constructor from the function and the interval 
+ *  @param func      the function 
+ *  @param a         the low-limit 
+ *  @param b         the high-limit 
+ *  @param precision the (relative to max|f|) precision 
+ *  @param N         the approximation order in each piece 
+ *  @param maxdepth  the maximal depth of bisections 
+ */
+// ============================================================================
+Ostap::Math::ChebyshevProxy::ChebyshevProxy
+( std::function<double(double)> func      , 
+  const double                  a         , 
+  const double                  b         , 
+  const double                  precision , 
+  const unsigned short          N         , 
+  const unsigned short          maxdepth  ) 
+  : m_a         ( std::min ( a , b ) ) 
+  , m_b         ( std::max ( a , b ) ) 
+  , m_N         ( std::max ( N , (unsigned short) 4 ) ) 
+  , m_precision ( std::abs ( precision ) ) 
+{
+  Ostap::Assert ( m_a < m_b && std::isfinite ( m_a ) && std::isfinite ( m_b ) , 
+                  "Invalid interval!" , s_METHOD7 , s_SC ) ;
+  //
+  const unsigned short D  = std::min ( maxdepth , (unsigned short) 20 ) ;
+  const unsigned int   NN = m_N ;
+  //
+  // Chebyshev nodes and the cosine table for the coefficients 
+  std::vector<double> nodes ( NN      ) ;
+  std::vector<double> ctab  ( NN * NN ) ;
+  for ( unsigned int j = 0 ; j < NN ; ++j ) 
+  {
+    nodes [ j ] = std::cos ( M_PI * ( j + 0.5 ) / NN ) ;
+    for ( unsigned int k = 0 ; k < NN ; ++k ) 
+    { ctab [ k * NN + j ] = std::cos ( M_PI * k * ( j + 0.5 ) / NN ) ; }
+  }
+  //
+  // the initial scale of the function 
+  const unsigned int NS = 256 ;
+  for ( unsigned int i = 0 ; i <= NS ; ++i ) 
+  {
+    const double v = func ( m_a + i * ( m_b - m_a ) / NS ) ;
+    if ( std::isfinite ( v ) ) { m_scale = std::max ( m_scale , std::abs ( v ) ) ; } 
+  }
+  //
+  // the control points (not the nodes for any order)
+  static const double s_control [ 2 ] = { -0.6180339887498949 , 0.3819660112501051 } ;
+  //
+  struct Piece { double low ; double high ; unsigned short depth ; } ;
+  std::vector<Piece>          stack  { { m_a , m_b , 0 } } ;
+  std::vector<unsigned short> depths {} ;
+  std::vector<double>         fv     ( NN ) ;
+  std::vector<double>         cs     ( NN ) ;
+  //
+  m_knots.push_back ( m_a ) ;
+  //
+  // bisect the pieces (the left one first), the accepted pieces go left-to-right 
+  while ( !stack.empty() ) 
+  {
+    const Piece pc = stack.back() ; stack.pop_back() ;
+    //
+    const double h = 0.5 * ( pc.high - pc.low ) ;
+    const double m = 0.5 * ( pc.high + pc.low ) ;
+    for ( unsigned int j = 0 ; j < NN ; ++j ) 
+    {
+      fv [ j ] = func ( m + h * nodes [ j ] ) ;
+      if ( std::isfinite ( fv [ j ] ) ) { m_scale = std::max ( m_scale , std::abs ( fv [ j ] ) ) ; } 
+    }
+    for ( unsigned int k = 0 ; k < NN ; ++k ) 
+    {
+      double c = 0 ;
+      for ( unsigned int j = 0 ; j < NN ; ++j ) { c += fv [ j ] * ctab [ k * NN + j ] ; }
+      cs [ k ] = 2 * c / NN ;
+    }
+    cs [ 0 ] *= 0.5 ;
+    //
+    // error estimate: the tail of the series and the control points 
+    double error = std::abs ( cs [ NN - 1 ] ) + std::abs ( cs [ NN - 2 ] ) ;
+    for ( const double t : s_control ) 
+    {
+      double b1 = 0 ;
+      double b2 = 0 ;
+      for ( unsigned int k = NN - 1 ; 0 < k ; --k ) 
+      {
+        const double b0 = 2 * t * b1 - b2 + cs [ k ] ;
+        b2 = b1 ;
+        b1 = b0 ;
+      }
+      const double approx = cs [ 0 ] + t * b1 - b2 ;
+      error = std::max ( error , std::abs ( func ( m + h * t ) - approx ) ) ;
+    }
+    if ( !std::isfinite ( error ) ) { error = std::numeric_limits<double>::max () ; }
+    //
+    if ( error <= m_precision * m_scale || D <= pc.depth ) 
+    {
+      m_knots.push_back ( pc.high ) ;
+      m_coefficients.insert ( m_coefficients.end () , cs.begin () , cs.end () ) ;
+      depths.push_back ( pc.depth ) ;
+      m_error = std::max ( m_error , error ) ;
+    }
+    else 
+    {
+      stack.push_back ( { m      , pc.high , (unsigned short) ( pc.depth + 1 ) } ) ;
+      stack.push_back ( { pc.low , m       , (unsigned short) ( pc.depth + 1 ) } ) ;
+    }
+  }
+  //
+  // the lookup table: the pieces are dyadic, each cell belongs to one piece 
+  const unsigned short depth = *std::max_element ( depths.begin () , depths.end () ) ;
+  const std::size_t    ncell = std::size_t ( 1 ) << depth ;
+  m_table.reserve ( ncell ) ;
+  for ( unsigned int p = 0 ; p < depths.size () ; ++p ) 
+  { m_table.insert ( m_table.end () , std::size_t ( 1 ) << ( depth - depths [ p ] ) , p ) ; }
+  m_icell = ncell / ( m_b - m_a ) ;
+  //
+  // integrals up to the knots 
+  m_integrals.push_back ( 0.0 ) ;
+  for ( std::size_t p = 0 ; p + 1 < m_knots.size () ; ++p ) 
+  { m_integrals.push_back ( m_integrals.back () + _integral_ ( p , m_knots [ p + 1 ] ) ) ; }
+}
+// ============================================================================
+/*  constructor from the function and the interval 
+ *  @param func      the function 
+ *  @param a         the low-limit 
+ *  @param b         the high-limit 
+ *  @param precision the (relative to max|f|) precision 
+ *  @param N         the approximation order in each piece 
+ *  @param maxdepth  the maximal depth of bisections 
+ */
+// ============================================================================
+Ostap::Math::ChebyshevProxy::ChebyshevProxy
+( const Ostap::Functions::PyCallable& func      , 
+  const double                        a         , 
+  const double                        b         , 
+  const double                        precision , 
+  const unsigned short                N         , 
+  const unsigned short                maxdepth  ) 
+  : ChebyshevProxy ( std::function<double(double)> ( std::cref ( func ) ) , 
+                     a , b , precision , N , maxdepth ) 
+{}
+// ============================================================================
+// evaluate the piece 
+// ============================================================================
+double Ostap::Math::ChebyshevProxy::_evaluate_
+( const std::size_t p , 
+  const double      x ) const 
+{
+  const double  low  = m_knots [ p     ] ;
+  const double  high = m_knots [ p + 1 ] ;
+  const double  t    = ( 2 * x - low - high ) / ( high - low ) ;
+  const double* c    = m_coefficients.data () + p * m_N ;
+  //
+  double b1 = 0 ;
+  double b2 = 0 ;
+  for ( unsigned int k = m_N - 1 ; 0 < k ; --k ) 
+  {
+    const double b0 = 2 * t * b1 - b2 + c [ k ] ;
+    b2 = b1 ;
+    b1 = b0 ;
+  }
+  return c [ 0 ] + t * b1 - b2 ;
+}
+// ============================================================================
+// indefinite integral for the piece (from its low edge) 
+// ============================================================================
+double Ostap::Math::ChebyshevProxy::_integral_
+( const std::size_t p , 
+  const double      x ) const 
+{
+  const double  low  = m_knots [ p     ] ;
+  const double  high = m_knots [ p + 1 ] ;
+  const double  t    = ( 2 * x - low - high ) / ( high - low ) ;
+  const double* c    = m_coefficients.data () + p * m_N ;
+  //
+  // the coefficients of the antiderivative:  C_k = ( c_{k-1} - c_{k+1} ) / 2k 
+  const unsigned int N = m_N ;
+  auto cc = [c,N] ( const unsigned int k ) -> double 
+    { return 0 == k ? 2 * c [ 0 ] : k < N ? c [ k ] : 0.0 ; } ;
+  //
+  double b1 = 0 ;
+  double b2 = 0 ;
+  double sm = 0 ; // the value at t = -1 
+  for ( unsigned int k = N ; 0 < k ; --k ) 
+  {
+    const double C  = ( cc ( k - 1 ) - cc ( k + 1 ) ) / ( 2 * k ) ;
+    const double b0 = 2 * t * b1 - b2 + C ;
+    b2 = b1 ;
+    b1 = b0 ;
+    sm += ( k % 2 ? -C : C ) ;
+  }
+  return 0.5 * ( high - low ) * ( t * b1 - b2 - sm ) ;
+}
+// ============================================================================
+// the main method: evaluate the approximation 
+// ============================================================================
+double Ostap::Math::ChebyshevProxy::evaluate ( const double x ) const 
+{ return x < m_a || x > m_b ? 0.0 : _evaluate_ ( piece ( x ) , x ) ; }
+// ============================================================================
+/*  evaluate the approximation for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of points 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::ChebyshevProxy::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    result [ i ] = xi < m_a || xi > m_b ? 0.0 : _evaluate_ ( piece ( xi ) , xi ) ;
+  }
+}
+// ============================================================================
+// get the integral between low and high 
+// ============================================================================
+double Ostap::Math::ChebyshevProxy::integral 
+( const double low  , 
+  const double high ) const 
+{
+  if      ( high < low ) { return - integral ( high , low ) ; }
+  //
+  const double xlow  = std::max ( low  , m_a ) ;
+  const double xhigh = std::min ( high , m_b ) ;
+  if ( xhigh <= xlow ) { return 0 ; }
+  //
+  const std::size_t pl = piece ( xlow  ) ;
+  const std::size_t ph = piece ( xhigh ) ;
+  //
+  return 
+    ( m_integrals [ ph ] + _integral_ ( ph , xhigh ) ) - 
+    ( m_integrals [ pl ] + _integral_ ( pl , xlow  ) ) ;
+}
+// ============================================================================
+
+
 
 // ============================================================================
 //                                                                      The END 
@@ -7,12 +7,17 @@
 #include <cmath>
 #include <limits>
 #include <sstream>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <exception>
 // =============================================================================
 // GSL
 // =============================================================================
 #include "gsl/gsl_errno.h"
 #include "gsl/gsl_vector.h"
-#include "gsl/gsl_multimin.h"
+#include "gsl/gsl_matrix.h"
 // =============================================================================
 // Ostap
 // =============================================================================
@@ -25,6 +30,8 @@
 // Local
 // =============================================================================
 #include "GSL_sentry.h"
+#include "local_mt.h"
+#include "Exception.h"
 // =============================================================================
 /** @file  
  *  Implementation file for class Gaudi::Math::Chi2Fit
@@ -33,12 +40,243 @@
  *  @date   2012-05-26
  */
 // =============================================================================
-namespace 
+namespace
 {
   // ==========================================================================
   const double s_Inf = 0.5 * std::numeric_limits<double>::max() ;
   // ==========================================================================
-  class Chi2 
+  /// the block of points for accumulation of gradient and hessian
+  const std::size_t    s_BLOCK   = 128     ;
+  /// the minimal work (number of multiplications) per thread
+  const std::size_t    s_MINWORK = 1 << 22 ;
+  /// the maximal number of Newton iterations
+  const std::size_t    s_MAXITER = 100     ;
+  /// the relative precision for Newton iterations
+  const double         s_TOL     = 1.e-10  ;
+  // ==========================================================================
+  /** split the range <code>[0,N)</code> between threads,
+   *  process the parts with <code>partial(first,last,acc)</code>
+   *  and sum the accumulators in the fixed order
+   *  @param N        number of points
+   *  @param work     the work per point
+   *  @param nthreads number of threads
+   *  @param partial  the partial function
+   *  @param result   (OUTPUT) the accumulator
+   */
+  template <class PARTIAL>
+  void _accumulate_
+  ( const std::size_t    N        ,
+    const std::size_t    work     ,
+    const unsigned int   nthreads ,
+    PARTIAL              partial  ,
+    std::vector<double>& result   )
+  {
+    const std::size_t minsize = std::max<std::size_t>
+      ( s_BLOCK , s_MINWORK / std::max<std::size_t> ( 1 , work ) ) ;
+    const std::size_t nt      = std::min<std::size_t>
+      ( std::max<std::size_t> ( 1 , N / minsize ) ,
+        1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ;
+    //
+    std::fill ( result.begin () , result.end () , 0.0 ) ;
+    if ( nt <= 1 ) { partial ( 0 , N , result.data () ) ; return ; }     // RETURN
+    //
+    const std::size_t size = ( N + nt - 1 ) / nt ;
+    std::vector<std::vector<double> > parts   ( nt , std::vector<double> ( result.size () , 0.0 ) ) ;
+    std::vector<std::exception_ptr>   errors  ( nt ) ;
+    std::vector<std::thread>          threads ;
+    threads.reserve ( nt ) ;
+    for ( std::size_t t = 1 ; t < nt ; ++t )
+    {
+      const std::size_t first = std::min ( N , t * size     ) ;
+      const std::size_t last  = std::min ( N , first + size ) ;
+      if ( last <= first ) { break ; }
+      threads.emplace_back ( [&partial,&parts,&errors,first,last,t] ()
+                             {
+                               try { partial ( first , last , parts [ t ].data () ) ; }
+                               catch ( ... ) { errors [ t ] = std::current_exception () ; }
+                             } ) ;
+    }
+    // the first chunk is processed by this thread
+    try { partial ( 0 , std::min ( N , size ) , parts [ 0 ].data () ) ; }
+    catch ( ... ) { errors [ 0 ] = std::current_exception () ; }
+    //
+    for ( auto& t : threads ) { t.join () ; }
+    for ( const auto& e : errors ) { if ( e ) { std::rethrow_exception ( e ) ; } }
+    //
+    // combine the partial sums in the fixed order
+    for ( const auto& p : parts )
+    { for ( std::size_t k = 0 ; k < result.size () ; ++k ) { result [ k ] += p [ k ] ; } }
+  }
+  // ==========================================================================
+  /// scalar product with independent lanes (vectorizable)
+  inline double _dot_
+  ( const double*     x ,
+    const double*     y ,
+    const std::size_t n )
+  {
+    double s0 = 0 , s1 = 0 , s2 = 0 , s3 = 0 ;
+    std::size_t i = 0 ;
+    for ( ; i + 4 <= n ; i += 4 )
+    {
+      s0 += x [ i     ] * y [ i     ] ;
+      s1 += x [ i + 1 ] * y [ i + 1 ] ;
+      s2 += x [ i + 2 ] * y [ i + 2 ] ;
+      s3 += x [ i + 3 ] * y [ i + 3 ] ;
+    }
+    for ( ; i < n ; ++i ) { s0 += x [ i ] * y [ i ] ; }
+    return ( s0 + s1 ) + ( s2 + s3 ) ;
+  }
+  // ==========================================================================
+  /// copy the lower triangle of the square matrix to the upper one
+  inline void _symmetrize_ ( double* a , const std::size_t n )
+  {
+    for ( std::size_t j = 0 ; j < n ; ++j )
+    { for ( std::size_t k = 0 ; k < j ; ++k ) { a [ k * n + j ] = a [ j * n + k ] ; } }
+  }
+  // ==========================================================================
+  /** in-place Cholesky decomposition \f$ A = L L^T \f$
+   *  of the symmetric positive definite matrix (row-major)
+   *  @return false if the matrix is not positive definite
+   */
+  bool _cholesky_ ( std::vector<double>& a , const std::size_t n )
+  {
+    for ( std::size_t j = 0 ; j < n ; ++j )
+    {
+      double*      aj  = a.data () + j * n ;
+      const double ajj = aj [ j ] ;
+      const double d   = ajj - _dot_ ( aj , aj , j ) ;
+      if ( !std::isfinite ( d ) || !( 0 < d ) || d <= 1.e-14 * ajj ) { return false ; }
+      const double l   = std::sqrt ( d ) ;
+      aj [ j ] = l ;
+      for ( std::size_t i = j + 1 ; i < n ; ++i )
+      {
+        double* ai = a.data () + i * n ;
+        ai [ j ] = ( ai [ j ] - _dot_ ( ai , aj , j ) ) / l ;
+      }
+    }
+    // clear the upper triangle
+    for ( std::size_t i = 0 ; i < n ; ++i )
+    { std::fill ( a.begin () + i * n + i + 1 , a.begin () + ( i + 1 ) * n , 0.0 ) ; }
+    return true ;
+  }
+  // ==========================================================================
+  /// solve \f$ L L^T x = b \f$ in-place, for the Cholesky factor \f$ L \f$
+  void _cholesky_solve_
+  ( const std::vector<double>& l ,
+    const std::size_t          n ,
+    double*                    x )
+  {
+    // L y = b
+    for ( std::size_t i = 0 ; i < n ; ++i )
+    {
+      const double* li = l.data () + i * n ;
+      x [ i ] = ( x [ i ] - _dot_ ( li , x , i ) ) / li [ i ] ;
+    }
+    // L^T x = y
+    for ( std::size_t i = n ; 0 < i-- ; )
+    {
+      const double* li = l.data () + i * n ;
+      x [ i ] /= li [ i ] ;
+      const double  xi = x [ i ] ;
+      for ( std::size_t k = 0 ; k < i ; ++k ) { x [ k ] -= li [ k ] * xi ; }
+    }
+  }
+  // ==========================================================================
+  /** non-negative solution of normal equations \f$ M x = b \f$
+   *  (Lawson-Hanson active set algorithm)
+   *  @param m       (INPUT)  the normal matrix
+   *  @param b       (INPUT)  the right-hand side
+   *  @param n       (INPUT)  the size
+   *  @param x       (OUTPUT) the solution
+   *  @param passive (OUTPUT) the passive set (non-zero components)
+   */
+  Ostap::StatusCode _nnls_
+  ( const std::vector<double>& m       ,
+    const double*              b       ,
+    const std::size_t          n       ,
+    double*                    x       ,
+    std::vector<int>&          passive )
+  {
+    passive.assign ( n , 0 ) ;
+    std::fill ( x , x + n , 0.0 ) ;
+    //
+    double scale = 0 ;
+    for ( std::size_t j = 0 ; j < n ; ++j ) { scale = std::max ( scale , std::abs ( b [ j ] ) ) ; }
+    const double tol = 1.e-12 * scale ;
+    //
+    std::vector<double>      w   ( n ) ;
+    std::vector<double>      sub {   } ;
+    std::vector<double>      z   {   } ;
+    std::vector<std::size_t> idx {   } ;
+    //
+    const std::size_t maxiter = 3 * n + 10 ;
+    std::size_t       iter    = 0 ;
+    while ( iter < maxiter )
+    {
+      // the (negative) gradient
+      for ( std::size_t j = 0 ; j < n ; ++j )
+      { w [ j ] = b [ j ] - _dot_ ( m.data () + j * n , x , n ) ; }
+      // the most violating constraint
+      std::size_t jmax = n   ;
+      double      wmax = tol ;
+      for ( std::size_t j = 0 ; j < n ; ++j )
+      { if ( !passive [ j ] && wmax < w [ j ] ) { wmax = w [ j ] ; jmax = j ; } }
+      if ( n == jmax ) { return Ostap::StatusCode::SUCCESS ; }      // RETURN
+      passive [ jmax ] = 1 ;
+      //
+      while ( iter++ < maxiter )
+      {
+        // the unconstrained solution for the passive set
+        idx.clear () ;
+        for ( std::size_t j = 0 ; j < n ; ++j ) { if ( passive [ j ] ) { idx.push_back ( j ) ; } }
+        const std::size_t np = idx.size () ;
+        sub.resize ( np * np ) ;
+        z  .resize ( np      ) ;
+        for ( std::size_t p = 0 ; p < np ; ++p )
+        {
+          z [ p ] = b [ idx [ p ] ] ;
+          for ( std::size_t q = 0 ; q < np ; ++q )
+          { sub [ p * np + q ] = m [ idx [ p ] * n + idx [ q ] ] ; }
+        }
+        if ( !_cholesky_ ( sub , np ) ) { return Ostap::StatusCode ( 321 ) ; }
+        _cholesky_solve_ ( sub , np , z.data () ) ;
+        //
+        // the step towards the unconstrained solution
+        double      alpha = 1  ;
+        std::size_t pmin  = np ;
+        for ( std::size_t p = 0 ; p < np ; ++p )
+        {
+          if ( 0 < z [ p ] ) { continue ; }
+          const double xp = x [ idx [ p ] ] ;
+          const double ap = xp / ( xp - z [ p ] ) ;
+          if ( ap < alpha || np == pmin ) { alpha = ap ; pmin = p ; }
+        }
+        //
+        if ( np == pmin )
+        {
+          for ( std::size_t p = 0 ; p < np ; ++p ) { x [ idx [ p ] ] = z [ p ] ; }
+          break ;                                                   // BREAK
+        }
+        //
+        // move and remove the zero components from the passive set
+        for ( std::size_t p = 0 ; p < np ; ++p )
+        {
+          const std::size_t j = idx [ p ] ;
+          x [ j ] += alpha * ( z [ p ] - x [ j ] ) ;
+          if ( p == pmin || x [ j ] <= 0 ) { x [ j ] = 0 ; passive [ j ] = 0 ; }
+        }
+      }
+    }
+    return Ostap::StatusCode ( 322 ) ;
+  }
+  // ==========================================================================
+  /** @class Chi2
+   *  The actual fitting engine for Ostap::Math::Chi2Fit
+   *  - the direct solution of normal equations
+   *  - Newton refinement with analytical hessian,
+   *    if components have uncertainties
+   */
+  class Chi2
   {
     // ========================================================================
     friend  class Ostap::Math::Chi2Fit ;
@@ -49,498 +287,399 @@ namespace
     typedef Ostap::Math::Chi2Fit::DATA  DATA ;
     typedef Ostap::Math::Chi2Fit::CMPS  CMPS ;
     // ========================================================================
-  protected : // protected interface 
+  protected : // protected interface
     // ========================================================================
-    Chi2 ( const Ostap::Math::Chi2Fit& fit ) ;
+    Chi2 ( const Ostap::Math::Chi2Fit& fit      ,
+           const unsigned int          nthreads ) ;
     // ========================================================================
     ~Chi2 () ; // destructor
     // ========================================================================
   protected:
     // ========================================================================
-    /// perform the fit 
+    /// perform the fit
     Ostap::StatusCode fit () ;
     // ========================================================================
-  private:    // disabled methods 
+  private:    // disabled methods
     // ========================================================================
-    /// the default constructor is disabled 
-    Chi2 () ; // the default constructor is disabled 
-    /// the copy constructor is disabled 
-    Chi2 ( const Chi2& ) ; // the copy constructor is disabled 
-    /// the assigmenet operator is disabled 
-    Chi2& operator=( const Chi2& ) ; // the assigmenet operator is disabled 
+    /// the default constructor is disabled
+    Chi2 () ; // the default constructor is disabled
+    /// the copy constructor is disabled
+    Chi2 ( const Chi2& ) ; // the copy constructor is disabled
+    /// the assigmenet operator is disabled
+    Chi2& operator=( const Chi2& ) ; // the assigmenet operator is disabled
     // ========================================================================
-  public : // GSL-specific stuff
-    // ======================================================================
-    /// calculate the function value 
-    double f      ( const gsl_vector* x ) const ; // function
-    /// calcualate the gradient 
-    void   df     ( const gsl_vector* x , 
-                    gsl_vector*       g ) const ; // gradient 
-    /// calculate the function and gradient 
-    double fdf    ( const gsl_vector* x , 
-                    gsl_vector*       g ) const ; // f & df 
-    /// calculate the function, gradient and hessian 
-    double fdfddf ( const gsl_vector* x , 
-                    gsl_vector*       g , 
-                    gsl_matrix*       h ) const ; // f & df & ddf 
+  public :
+    // ========================================================================
+    /** calculate chi2, gradient and hessian
+     *  @param a     (INPUT)  parameters
+     *  @param g     (OUTPUT) gradient (can be nullptr)
+     *  @param h     (OUTPUT) hessian  (can be nullptr)
+     *  @param exact (INPUT)  exact hessian or Gauss-Newton approximation?
+     *  @return chi2
+     */
+    double eval
+    ( const double* a     ,
+      double*       g     ,
+      double*       h     ,
+      const bool    exact ) const ;
     // ========================================================================
   public:
     // ========================================================================
     const gsl_vector* solution   () const { return m_solution   ; }
-    // const gsl_matrix* hessian    () const { return m_hessian    ; }    
-    const gsl_matrix* covariance () const { return m_covariance ; }    
+    const gsl_matrix* covariance () const { return m_covariance ; }
     // ========================================================================
   public:
     // ========================================================================
-    double      chi2         () const { return m_chi2         ; }    
-    std::size_t calls_f      () const { return m_calls_f      ; }
-    std::size_t calls_df     () const { return m_calls_df     ; }
-    std::size_t calls_fdf    () const { return m_calls_fdf    ; }
-    std::size_t calls_fdfddf () const { return m_calls_fdfddf ; }
+    double      chi2         () const { return m_chi2         ; }
+    std::size_t calls        () const { return m_calls        ; }
     std::size_t points       () const { return m_points       ; }
     std::size_t iters        () const { return m_iter         ; }
     // ========================================================================
-  private: 
+  private:
     // ========================================================================
-    const Ostap::Math::Chi2Fit* m_fit         ;
-    //
-    mutable std::size_t m_calls_f      ;
-    mutable std::size_t m_calls_df     ;
-    mutable std::size_t m_calls_fdf    ;
-    mutable std::size_t m_calls_fdfddf ;
-    mutable std::size_t m_points       ;
+    /// accumulate chi2, gradient & hessian for the range of points
+    void partial
+    ( const double*     a     ,
+      const std::size_t first ,
+      const std::size_t last  ,
+      double*           acc   ,
+      const bool        full  ,
+      const bool        hesse ,
+      const bool        exact ) const ;
     // ========================================================================
-    /// the solution 
-    gsl_vector* m_solution   ;  // the current solution 
-    /// the hessian 
-    gsl_matrix* m_hessian    ;  // the hessian 
-    /// the covariance 
-    gsl_matrix* m_covariance ;   // the covariance 
+  private:
+    // ========================================================================
+    /// number of components
+    std::size_t         m_K        ;
+    /// number of points
+    std::size_t         m_N        ;
+    /// number of threads
+    unsigned int        m_nthreads ;
+    /// data: values
+    std::vector<double> m_d        ;
+    /// data: squared uncertainties
+    std::vector<double> m_s        ;
+    /// components: values  (component-major)
+    std::vector<double> m_c        ;
+    /// components: squared uncertainties (component-major, if any)
+    std::vector<double> m_t        ;
+    // ========================================================================
+    mutable std::size_t m_calls    ;
+    mutable std::size_t m_points   ;
+    // ========================================================================
+    /// the solution
+    gsl_vector* m_solution   ;  // the current solution
+    /// the hessian
+    gsl_matrix* m_hessian    ;  // the hessian
+    /// the covariance
+    gsl_matrix* m_covariance ;   // the covariance
     // ========================================================================
     double      m_chi2 ;
     std::size_t m_iter ;
     // ========================================================================
-  } ;  
-  // ==========================================================================
-  // GSL specific stuff 
+  } ;
   // ==========================================================================
-  /// get the function value 
-  double chi2_f ( const gsl_vector *x, void * params )
-  {
-    // 
-    const Chi2* fit = (const Chi2*) params ;
-    // 
-    return fit->f ( x )  ;
-  }
+  // accumulate chi2, gradient & hessian for the range of points
   // ==========================================================================
-  /// get the fradient 
-  void chi2_df ( const gsl_vector *x, void *params, gsl_vector *df )
+  void Chi2::partial
+  ( const double*     a     ,
+    const std::size_t first ,
+    const std::size_t last  ,
+    double*           acc   ,
+    const bool        full  ,
+    const bool        hesse ,
+    const bool        exact ) const
   {
-    // 
-    const Chi2* fit = (const Chi2*) params ;
-    // 
-    fit->df ( x , df )  ;
-  }
-  // ==========================================================================
-  /// get the function and gradient 
-  void chi2_fdf ( const gsl_vector *x, void *params, double *f, gsl_vector *df) 
-  {
-    //
-    //
-    const Chi2* fit = (const Chi2*) params ;
-    // 
-    *f = fit->fdf ( x , df )  ;
-    //
-  }
-  // ===========================================================================
-  // implementation of class Chi2 
-  // ===========================================================================
-  /// contribution to chi2  
-  inline Chi2::VE term_chi2 
-  ( Chi2::VE             res   ,    
-    const Chi2::CMPS&    cmps  , 
-    const unsigned short index , 
-    const gsl_vector*    x     ) 
-  {
-    //
-    for ( unsigned int j = 0 ; j < cmps.size() ; ++j ) 
-    {
-      // get the parameter from GSL 
-      const double    aj = gsl_vector_get ( x , j ) ;
-      // get the component value 
-      const Chi2::VE& cj = cmps [ j ] [ index ] ;
-      //
-      res  -= aj * cj ;
-    }
+    const std::size_t K      = m_K  ;
+    const std::size_t N      = m_N  ;
+    const bool        errors = !m_t.empty () ;
+    const bool        second = hesse && exact && errors ;
     //
-    return res ;
-  }
-  // ========================================================================
-  /// get the contribution to the gradient 
-  inline 
-  void term_grad 
-  ( const Chi2::VE&      res   , 
-    const Chi2::CMPS&    cmps  , 
-    const unsigned short index , 
-    const gsl_vector*    x     ,
-    gsl_vector*          g     )
-  {
+    std::vector<double> r     ( s_BLOCK ) ;
+    std::vector<double> w     ( s_BLOCK ) ;
+    std::vector<double> p     ( s_BLOCK ) ;
+    std::vector<double> q     ( s_BLOCK ) ;
+    std::vector<double> alpha ( hesse  ? s_BLOCK     : 0 ) ;
+    std::vector<double> beta  ( second ? s_BLOCK     : 0 ) ;
+    std::vector<double> gamma ( second ? s_BLOCK     : 0 ) ;
+    std::vector<double> s     ( full && errors ? K * s_BLOCK : 0 ) ;
+    std::vector<double> u     ( hesse  ? K * s_BLOCK : 0 ) ;
+    std::vector<double> v     ( second ? K * s_BLOCK : 0 ) ;
     //
-    const double rv     = res.value ()  ;
-    const double rv2    = rv * rv       ;
-    const double cov2   = res.cov2  ()  ;
+    double* g = acc + 2 ;
+    double* h = acc + 2 + K ;
     //
-    // 3b. the second loop over components 
-    for ( unsigned int j = 0 ; j < cmps.size() ; ++j ) 
+    for ( std::size_t b0 = first ; b0 < last ; b0 += s_BLOCK )
     {
-      // get the parameter from GSL 
-      const double    aj = gsl_vector_get ( x , j ) ;
-      // get the component value 
-      const Chi2::VE& cj  = cmps[j][index] ;
-      //
-      // d(res)   / d(l_j)
-      const double drdj =         - cj.value () ;
-      // d(cov2)  / d(l_j)
-      const double dsdj =  2 * aj * cj.cov2  () ;
+      const std::size_t nb = std::min ( s_BLOCK , last - b0 ) ;
       //
-      // d(chi2)  / d(l_j) 
-      //
-      double dcdj   = 2 * rv  / cov2        * drdj ;
-      dcdj         += -   rv2 / cov2 / cov2 * dsdj ;
+      // 1. residuals and their variances
+      std::copy ( m_d.begin () + b0 , m_d.begin () + b0 + nb , r.begin () ) ;
+      std::copy ( m_s.begin () + b0 , m_s.begin () + b0 + nb , w.begin () ) ;
+      for ( std::size_t j = 0 ; j < K ; ++j )
+      {
+        const double  aj = a [ j ] ;
+        const double* cj = m_c.data () + j * N + b0 ;
+        for ( std::size_t i = 0 ; i < nb ; ++i ) { r [ i ] -= aj * cj [ i ] ; }
+        if ( !errors ) { continue ; }
+        const double  a2 = aj * aj ;
+        const double* tj = m_t.data () + j * N + b0 ;
+        for ( std::size_t i = 0 ; i < nb ; ++i ) { w [ i ] += a2 * tj [ i ] ; }
+      }
       //
-      // update the gradient
-      const double gold = gsl_vector_get ( g , j ) ;
-      gsl_vector_set ( g , j , gold + dcdj  ) ; // update gradient
-    }
-    //
-  }
-  // ==========================================================================
-  /// get the contributions to the hessian 
-  inline 
-  void term_hesse
-  ( const Chi2::VE&      res   , 
-    const Chi2::CMPS&    cmps  , 
-    const unsigned short index , 
-    const gsl_vector*    x     ,
-    gsl_matrix*          h     )
-  {
-    //
-    const double rv     = res.value ()  ;
-    const double rv2    = rv * rv       ;
-    const double cov2   = res.cov2  ()  ;
-    //
-    // 3b. the second loop over components 
-    for ( unsigned int j = 0 ; j < cmps.size() ; ++j ) 
-    {
-      // get the parameter from GSL 
-      const double    aj = gsl_vector_get ( x , j ) ;
-      // get the component value 
-      const Chi2::VE& cj = cmps [ j ][ index ] ;
+      // 2. weights and chi2
+      for ( std::size_t i = 0 ; i < nb ; ++i )
+      {
+        if ( 0 < w [ i ] )
+        {
+          w [ i ]  = 1 / w [ i ] ;
+          acc [ 0 ] += r [ i ] * r [ i ] * w [ i ] ;
+          acc [ 1 ] += 1 ;
+        }
+        else { w [ i ] = 0 ; }
+      }
+      if ( !full ) { continue ; }
       //
-      // d(res)   / d(l_j)
-      const double drdj =         - cj.value () ;
-      // d(cov2)  / d(l_j)
-      const double dsdj =  2 * aj * cj.cov2  () ;
+      // 3. gradient: g_j = -2 sum ( w r c_j ) - 2 sum ( w^2 r^2 s_j ) , s_j = a_j t_j
+      for ( std::size_t i = 0 ; i < nb ; ++i )
+      {
+        p [ i ] = -2 * w [ i ] * r [ i ] ;
+        q [ i ] = p [ i ] * w [ i ] * r [ i ] ;
+      }
+      for ( std::size_t j = 0 ; j < K ; ++j )
+      {
+        g [ j ] += _dot_ ( p.data () , m_c.data () + j * N + b0 , nb ) ;
+        if ( !errors ) { continue ; }
+        const double  aj = a [ j ] ;
+        const double* tj = m_t.data () + j * N + b0 ;
+        double*       sj = s.data   () + j * s_BLOCK ;
+        for ( std::size_t i = 0 ; i < nb ; ++i ) { sj [ i ] = aj * tj [ i ] ; }
+        g [ j ] += _dot_ ( q.data () , sj , nb ) ;
+      }
+      if ( !hesse ) { continue ; }
       //
-      // next step: hessian 
-      for ( unsigned  int k = j ; k < cmps.size() ; ++k )
+      // 4. hessian:
+      //   h_jk = sum [ alpha c_j c_k + beta ( c_j s_k + s_j c_k ) + gamma s_j s_k ]
+      //        - delta_jk * sum ( 2 w^2 r^2 t_j )
+      //   alpha = 2 w, beta = 4 w^2 r , gamma = 8 w^3 r^2
+      for ( std::size_t i = 0 ; i < nb ; ++i )
       {
-        // get the parameter from GSL 
-        const double    ak = gsl_vector_get ( x , k ) ;
-        // get the component value 
-        const Chi2::VE& ck = cmps [ k ][ index ] ;
-        //
-        // d(res)   / d(l_k)
-        const double drdk  =         - ck.value () ;
-        // d(cov2)  / d(l_k)
-        const double dsdk  =  2 * ak * ck.cov2  () ;
-        //
-        const double d2sjk = ( j == k ) ? 2 * cj.cov2() : 0.0 ;
-        //
-        //
-        double dh = 0                                      ;
-        dh += -     rv2 / cov2 / cov2        * d2sjk       ; 
-        dh +=   2              / cov2        * drdj * drdk ; 
-        dh += - 2 * rv  / cov2 / cov2        * drdj * dsdk ;
-        dh += - 2 * rv  / cov2 / cov2        * drdk * dsdj ;
-        dh += - 2 * rv2 / cov2 / cov2 / cov2 * dsdj * dsdk ;
-        //
-        const double hjk = gsl_matrix_get ( h , j , k ) ;
-        //
-        if ( j == k ) 
-        { 
-          gsl_matrix_set ( h , j , k , hjk + dh ) ; 
+        alpha [ i ] = 2 * w [ i ] ;
+        if ( !second ) { continue ; }
+        beta  [ i ] = -2 * p [ i ] * w [ i ] ;
+        gamma [ i ] = -4 * q [ i ] * w [ i ] ;
+      }
+      for ( std::size_t j = 0 ; j < K ; ++j )
+      {
+        const double* cj = m_c.data () + j * N + b0 ;
+        double*       uj = u.data   () + j * s_BLOCK ;
+        if ( !second )
+        {
+          for ( std::size_t i = 0 ; i < nb ; ++i ) { uj [ i ] = alpha [ i ] * cj [ i ] ; }
+          continue ;
         }
-        else 
-        { 
-          // enforce the symmetry:
-          gsl_matrix_set ( h , j , k , hjk + dh ) ; 
-          gsl_matrix_set ( h , k , j , hjk + dh ) ;
+        const double* sj = s.data () + j * s_BLOCK ;
+        double*       vj = v.data () + j * s_BLOCK ;
+        for ( std::size_t i = 0 ; i < nb ; ++i )
+        {
+          uj [ i ] = alpha [ i ] * cj [ i ] + beta  [ i ] * sj [ i ] ;
+          vj [ i ] = beta  [ i ] * cj [ i ] + gamma [ i ] * sj [ i ] ;
         }
-        //
       }
-      //
+      for ( std::size_t j = 0 ; j < K ; ++j )
+      {
+        const double* uj = u.data () + j * s_BLOCK ;
+        const double* vj = v.data () + j * s_BLOCK ;
+        double*       hj = h + j * K ;
+        for ( std::size_t k = 0 ; k <= j ; ++k )
+        {
+          hj [ k ] += _dot_ ( uj , m_c.data () + k * N + b0 , nb ) ;
+          if ( second ) { hj [ k ] += _dot_ ( vj , s.data () + k * s_BLOCK , nb ) ; }
+        }
+        if ( second ) { hj [ j ] += _dot_ ( q.data () , m_t.data () + j * N + b0 , nb ) ; }
+      }
     }
-    //
   }
-  // ===========================================================================
-  // calculate the function value 
-  // ===========================================================================
-  double Chi2::f ( const gsl_vector* x ) const // function
+  // ==========================================================================
+  // calculate chi2, gradient and hessian
+  // ==========================================================================
+  double Chi2::eval
+  ( const double* a     ,
+    double*       g     ,
+    double*       h     ,
+    const bool    exact ) const
   {
+    ++m_calls ;
     //
-    ++m_calls_f   ;
+    const std::size_t K     = m_K ;
+    const bool        hesse = nullptr != h ;
+    const bool        full  = hesse || nullptr != g ;
     //
-    const DATA& data = m_fit -> data () ;
-    const CMPS& cmps = m_fit -> cmps () ;
+    std::vector<double> acc ( 2 + ( full ? K : 0 ) + ( hesse ? K * K : 0 ) ) ;
+    const std::size_t   work =
+      ( hesse ? ( m_t.empty () || !exact ? 1 : 2 ) * K * K / 2 : 0 ) + 4 * K ;
     //
-    m_points    = 0 ;
-    double chi2 = 0 ;
-    // the loop over the data-points 
-    for ( std::size_t i = 0 ; i < data.size() ; ++ i ) 
+    _accumulate_
+      ( m_N , work , m_nthreads ,
+        [this,a,full,hesse,exact] ( const std::size_t first ,
+                                    const std::size_t last  ,
+                                    double*           acc   )
+        { partial ( a , first , last , acc , full , hesse , exact ) ; } , acc ) ;
+    //
+    m_points = std::size_t ( acc [ 1 ] ) ;
+    //
+    if ( nullptr != g ) { std::copy ( acc.begin () + 2 , acc.begin () + 2 + K , g ) ; }
+    if ( hesse )
     {
-      // calculate the chi2-term 
-      VE res = term_chi2 ( data[i] , cmps , i , x ) ;
-      //
-      if ( 0 >= res.cov2() ) { continue ; } // CONTINUE 
-      //
-      const double rv2 = res.value() * res.value() ;
-      //
-      chi2 += rv2 / res.cov2() ; // accumulate 
-      //
-      ++m_points ;
-      //
+      std::copy ( acc.begin () + 2 + K , acc.end () , h ) ;
+      _symmetrize_ ( h , K ) ;
     }
     //
-    return chi2 ;
-  } 
-  // ==========================================================================
-  // calculate the gradient
-  // ==========================================================================
-  void Chi2::df ( const gsl_vector* x , gsl_vector* g ) const 
-  { 
-    ++m_calls_df  ;
-    fdf ( x , g )  ; 
-    --m_calls_fdf ;
+    return acc [ 0 ] ;
   }
   // ==========================================================================
-  // calculate the function and gradient 
+  // constructor
   // ==========================================================================
-  double Chi2::fdf ( const gsl_vector* x , gsl_vector *g ) const
+  Chi2::Chi2
+  ( const Ostap::Math::Chi2Fit& fit      ,
+    const unsigned int          nthreads )
+    : m_K            ( fit.cmps ().size () )
+    , m_N            ( fit.data ().size () )
+    , m_nthreads     ( nthreads )
+    , m_d            ( m_N )
+    , m_s            ( m_N )
+    , m_c            ( m_K * m_N )
+    , m_t            ()
+    , m_calls        ( 0 )
+    , m_points       ( 0 )
+    , m_solution     ( 0 )
+    , m_hessian      ( 0 )
+    , m_covariance   ( 0 )
+    , m_chi2         ( s_Inf )
+    , m_iter         ( 0 )
   {
-    ++m_calls_fdf  ;
-    //
-    m_points = 0 ;
-    // 1. reset the gradient 
-    gsl_vector_set_zero ( g ) ;
-    //    
-    const DATA& data = m_fit -> data () ;
-    const CMPS& cmps = m_fit -> cmps () ;
-    //
-    double chi2 = 0 ;
-    // 2. the loop over the data points 
-    for ( std::size_t i = 0 ; i < data.size() ; ++ i ) 
+    const DATA& data = fit.data () ;
+    const CMPS& cmps = fit.cmps () ;
+    //
+    for ( std::size_t i = 0 ; i < m_N ; ++i )
     {
-      //
-      VE res = term_chi2 ( data[i] , cmps , i , x ) ;
-      //
-      if ( 0 >= res.cov2() ) { continue ; } // CONTINUE 
-      //
-      const double rv2 = res.value() * res.value() ;
-      //
-      chi2 += rv2 / res.cov2() ; // accumulate 
-      //
-      ++m_points;
-      //
-      // update the gradient 
-      term_grad  ( res , cmps , i , x , g ) ;
-      //
+      m_d [ i ] = data [ i ].value () ;
+      m_s [ i ] = data [ i ].cov2  () ;
     }
     //
-    return chi2 ;
-  }
-  // ==========================================================================
-  // calculate the function, gradient and hesse-matrix
-  // ==========================================================================
-  double Chi2::fdfddf ( const gsl_vector* x , 
-                        gsl_vector*       g , 
-                        gsl_matrix*       h ) const
-  {
-    ++m_calls_fdfddf ;
-    //
-    m_points = 0 ;
-    // 1. reset the gradient & hessian  
-    if ( 0 != g ) { gsl_vector_set_zero ( g ) ; }
-    gsl_matrix_set_zero ( h ) ;
-    //    
-    const DATA& data = m_fit -> data () ;
-    const CMPS& cmps = m_fit -> cmps () ;
-    //
-    double chi2 = 0 ;
-    // 2. the loop over the data points 
-    for ( std::size_t i = 0 ; i < data.size() ; ++ i ) 
+    bool errors = false ;
+    for ( std::size_t j = 0 ; j < m_K ; ++j )
     {
-      //
-      VE res = term_chi2 ( data[i] , cmps , i , x ) ;
-      //
-      if ( 0 >= res.cov2() ) { continue ; } // CONTINUE 
-      //
-      const double rv2 = res.value() * res.value() ;
-      //
-      chi2 += rv2 / res.cov2() ; // accumulate 
-      //
-      ++m_points;
-      //
-      // update the gradient
-      if ( 0 != g ) { term_grad  ( res , cmps , i , x , g ) ; } 
-      //
-      // update the hessian
-      term_hesse ( res , cmps , i , x , h ) ;
-      //
+      const DATA& cmp = cmps [ j ] ;
+      for ( std::size_t i = 0 ; i < m_N ; ++i )
+      {
+        m_c [ j * m_N + i ] = cmp [ i ].value () ;
+        if ( 0 < cmp [ i ].cov2 () ) { errors = true ; }
+      }
+    }
+    // the negative squared uncertainties of components are ignored, see ValueWithError
+    if ( errors )
+    {
+      m_t.resize ( m_K * m_N ) ;
+      for ( std::size_t j = 0 ; j < m_K ; ++j )
+      {
+        const DATA& cmp = cmps [ j ] ;
+        for ( std::size_t i = 0 ; i < m_N ; ++i )
+        { m_t [ j * m_N + i ] = std::max ( cmp [ i ].cov2 () , 0.0 ) ; }
+      }
     }
-    //
-    return chi2 ;
   }
   // ==========================================================================
-  // constructor 
-  // ==========================================================================
-  Chi2::Chi2 ( const Ostap::Math::Chi2Fit& fit ) 
-    : m_fit          ( &fit ) 
-    , m_calls_f      ( 0 )
-    , m_calls_df     ( 0 ) 
-    , m_calls_fdf    ( 0 ) 
-    , m_calls_fdfddf ( 0 ) 
-    , m_points       ( 0 ) 
-    , m_solution     ( 0 ) 
-    , m_hessian      ( 0 )
-    , m_covariance   ( 0 )
-    , m_chi2         ( s_Inf )
-    , m_iter         ( 0 ) 
-  {} 
-  // ==========================================================================
   /// destructor
   // ==========================================================================
   Chi2::~Chi2 ()  // destructor
   {
-    /// free allocated vectors & matrices 
-    if ( 0 != m_solution   ) 
+    /// free allocated vectors & matrices
+    if ( 0 != m_solution   )
     { gsl_vector_free ( m_solution   ) ; m_solution   = 0 ; }
-    if ( 0 != m_hessian    ) 
+    if ( 0 != m_hessian    )
     { gsl_matrix_free ( m_hessian    ) ; m_hessian    = 0 ; }
-    if ( 0 != m_covariance ) 
+    if ( 0 != m_covariance )
     { gsl_matrix_free ( m_covariance ) ; m_covariance = 0 ; }
     // ========================================================================
   }
   // ==========================================================================
-  // perform the fit 
+  // perform the fit
   // ==========================================================================
-  Ostap::StatusCode Chi2::fit () 
+  Ostap::StatusCode Chi2::fit ()
   {
     //
     Ostap::Math::GSL::GSL_Error_Handler sentry ;
     //
-    const std::size_t size = m_fit->cmps().size() ;
-    /// the function  
-    gsl_multimin_function_fdf F ;
-    F.n      = size        ;
-    F.f      = &chi2_f     ;
-    F.df     = &chi2_df    ;
-    F.fdf    = &chi2_fdf   ;
-    F.params = (void*)this ;
-    // ========================================================================
-    /// the minimizer 
-    const gsl_multimin_fdfminimizer_type *T = 
-      // gsl_multimin_fdfminimizer_conjugate_fr;
-      gsl_multimin_fdfminimizer_vector_bfgs2;
-    //
-    gsl_multimin_fdfminimizer *s = gsl_multimin_fdfminimizer_alloc ( T , size );
-    // 
-    gsl_vector* x = gsl_vector_calloc ( size ) ;
+    const std::size_t K = m_K ;
+    if ( 0 == K || 0 == m_N ) { return Ostap::StatusCode ( 320 ) ; }
     //
-    /// 
-    double step = 0  ;
-    const DATA& init = m_fit->init() ;
-    for ( unsigned int i =0 ; i < x->size ; ++i ) 
-    {
-      const VE& f = init[i] ;
-      gsl_vector_set  ( x , i , 0.5 * f.value()  ) ;
-      step = std::max ( step , f.error () ) ;
-    }
+    std::vector<double> a    ( K     , 0.0 ) ;
+    std::vector<double> an   ( K     , 0.0 ) ;
+    std::vector<double> g    ( K     , 0.0 ) ;
+    std::vector<double> step ( K     , 0.0 ) ;
+    std::vector<double> h    ( K * K , 0.0 ) ;
     //
-    gsl_multimin_fdfminimizer_set  ( s , &F , x , 0.1 * step , 0.05 );
+    // 1. the direct solution of normal equations,
+    //    the uncertainties of components are ignored
+    eval ( a.data () , g.data () , h.data () , false ) ;
+    if ( !_cholesky_ ( h , K ) ) { return Ostap::StatusCode ( 321 ) ; }
+    for ( std::size_t j = 0 ; j < K ; ++j ) { a [ j ] = -g [ j ] ; }
+    _cholesky_solve_ ( h , K , a.data () ) ;
     //
+    // 2. Newton refinement, if components have uncertainties
     m_iter = 0 ;
-    int          status    ;
-    do 
+    if ( !m_t.empty () )
     {
-      ++m_iter ;
-      //
-      status = gsl_multimin_fdfminimizer_iterate ( s );
-      if ( status ) 
-      { 
-        gsl_error ( "Chi2Fit error from minimization" , 
-                    __FILE__ , __LINE__ , status ) ;
-        /// break ;                                                  // BREAK
-        continue  ;                                                  // BREAK
-      }  
-      //
-      status = gsl_multimin_test_gradient ( s->gradient , 1.e-4  );
-      if ( GSL_SUCCESS == status )
-      { 
-        // std::cout << " Converge!!! " << std::endl ; 
+      double chi2 = eval ( a.data () , nullptr , nullptr , false ) ;
+      while ( m_iter < s_MAXITER )
+      {
+        ++m_iter ;
+        eval ( a.data () , g.data () , h.data () , true ) ;
+        // use Gauss-Newton approximation if the hessian is not positive
+        if ( !_cholesky_ ( h , K ) )
+        {
+          eval ( a.data () , g.data () , h.data () , false ) ;
+          if ( !_cholesky_ ( h , K ) ) { return Ostap::StatusCode ( 321 ) ; }
+        }
+        for ( std::size_t j = 0 ; j < K ; ++j ) { step [ j ] = -g [ j ] ; }
+        _cholesky_solve_ ( h , K , step.data () ) ;
+        // the Newton decrement
+        const double decrement = -_dot_ ( g.data () , step.data () , K ) ;
+        if ( decrement <= s_TOL * ( 1 + chi2 ) ) { break ; }            // BREAK
+        // backtracking
+        bool   accepted = false ;
+        double t        = 1     ;
+        for ( unsigned short l = 0 ; l < 30 && !accepted ; ++l , t *= 0.5 )
+        {
+          for ( std::size_t j = 0 ; j < K ; ++j ) { an [ j ] = a [ j ] + t * step [ j ] ; }
+          const double c2 = eval ( an.data () , nullptr , nullptr , false ) ;
+          if ( c2 < chi2 ) { chi2 = c2 ; a.swap ( an ) ; accepted = true ; }
+        }
+        if ( !accepted ) { break ; }                                   // BREAK
       }
-      //
-      // std::cout
-      // << " ITER  : " << m_iter 
-      //  << " POINT : " << s->f << " " << (*s->x) << std::endl ;  
-      // std::cout << " GRAD : "  << (*s->gradient) << std::endl ;
     }
-    while ( status == GSL_CONTINUE && m_iter < 5000 ) ; 
-    //
-    //
-    if ( GSL_SUCCESS != status && 27 != status ) { return 300 + status ; }
-    //
-    
-    // get chi2 
-    m_chi2 = s->f ;
-    //
-    // get the solution 
-    m_solution = gsl_vector_alloc ( s->x->size ) ;
-    gsl_vector_memcpy ( m_solution , s->x ) ;
-    // std::cout << " solution! " << (*m_solution) << std::endl ;
-    
-    // std::cout 
-    //<< " #f      " << calls_f      () 
-    //<< " #df     " << calls_df     () 
-    //<< " #fdf    " << calls_fdf    ()   
-    //<< " #fdfddf " << calls_fdfddf ()   
-    //<< " #points " << points       ()   
-    //<< std::endl ;
-
-    
-    //
-    /// calcualte hessian:
-    //
-    m_hessian = gsl_matrix_alloc ( s->x->size , s->x->size );
-    fdfddf ( s->x , 0 , m_hessian ) ;
-    
-    // std::cout << " ANALYTICAL " << std::endl ;
-    // std::cout << (*m_hessian)   << std::endl ;
-    
-    // calculate the covariance  matrix 
-    m_covariance = gsl_matrix_alloc ( s->x->size , s->x->size );
-    
+    //
+    // 3. chi2 and the exact hessian at the solution
+    m_chi2 = eval ( a.data () , nullptr , h.data () , true ) ;
+    //
+    m_solution = gsl_vector_alloc ( K ) ;
+    for ( std::size_t j = 0 ; j < K ; ++j ) { gsl_vector_set ( m_solution , j , a [ j ] ) ; }
+    //
+    m_hessian  = gsl_matrix_alloc ( K , K ) ;
+    for ( std::size_t j = 0 ; j < K ; ++j )
+    { for ( std::size_t k = 0 ; k < K ; ++k ) { gsl_matrix_set ( m_hessian , j , k , h [ j * K + k ] ) ; } }
+    //
+    // calculate the covariance  matrix
+    m_covariance = gsl_matrix_alloc ( K , K ) ;
+    //
     Ostap::StatusCode sc = Ostap::Math::GSL::invert_LU_2 ( m_hessian , m_covariance  ) ;
     gsl_matrix_scale ( m_covariance , 2 ) ;
-    
-    //
-    gsl_multimin_fdfminimizer_free ( s ) ;
-    gsl_vector_free                ( x ) ;
     //
     return sc ;
   }
   // ==========================================================================
-} //                                                  end of anonymous namespace 
+} //                                                  end of anonymous namespace
 // ============================================================================
 // constructor 
 // ============================================================================
@@ -597,7 +736,8 @@ namespace
 // ============================================================================
 Ostap::Math::Chi2Fit::Chi2Fit 
 ( const Ostap::Math::Chi2Fit::DATA& data , 
-  const Ostap::Math::Chi2Fit::DATA& cmps )
+  const Ostap::Math::Chi2Fit::DATA& cmps , 
+  const unsigned int                nthreads )
 //
   : m_data (     data )
   , m_cmps ( 1 , cmps ) 
@@ -617,18 +757,14 @@ Ostap::Math::Chi2Fit::Chi2Fit
   for ( CMPS::iterator icmp = m_cmps.begin() ; m_cmps.end () != icmp ; ++icmp ) 
   { m_init.push_back ( _adjust_ ( m_data , *icmp , m_cmps.size() ) ) ; }
   //  
-  Chi2 c2 ( *this ) ;
+  Chi2 c2 ( *this , nthreads ) ;
   //
   m_code = c2.fit () ;
   //
   if ( m_code.isSuccess() ) 
   {
     m_chi2   = c2.chi2    () ;
-    m_calls  =
-      c2.calls_f      () + 
-      c2.calls_df     () + 
-      c2.calls_fdf    () +
-      c2.calls_fdfddf () ;
+    m_calls  = c2.calls   () ;
     m_iters  = c2.iters   () ;
     m_points = c2.points  () ;
     //
@@ -651,7 +787,8 @@ Ostap::Math::Chi2Fit::Chi2Fit
 // ============================================================================
 Ostap::Math::Chi2Fit::Chi2Fit 
 ( const Ostap::Math::Chi2Fit::DATA& data , 
-  const Ostap::Math::Chi2Fit::CMPS& cmps )
+  const Ostap::Math::Chi2Fit::CMPS& cmps , 
+  const unsigned int                nthreads )
   : m_data ( data )
   , m_cmps ( cmps ) 
   , m_init () 
@@ -671,14 +808,14 @@ Ostap::Math::Chi2Fit::Chi2Fit
   for ( CMPS::iterator icmp = m_cmps.begin() ; m_cmps.end () != icmp ; ++icmp ) 
   { m_init.push_back ( _adjust_ ( m_data , *icmp , m_cmps.size () ) ) ; }
   //
-  Chi2 c2 ( *this ) ;
+  Chi2 c2 ( *this , nthreads ) ;
   //
   m_code  = c2.fit   () ;
   //
   if ( m_code.isSuccess() ) 
   {
     m_chi2   = c2.chi2    () ;
-    m_calls  = c2.calls_f () + c2.calls_df () + c2.calls_fdf () ;
+    m_calls  = c2.calls   () ;
     m_iters  = c2.iters   () ;
     m_points = c2.points  () ;
     //
@@ -831,5 +968,334 @@ std::string Ostap::Math::Chi2Fit::toString () const
   return s.str();
 }
 // ============================================================================
+// Chi2Solver
+// ============================================================================
+/*  constructor from the components (values are used)
+ *  @param cmps        the components
+ *  @param weights     the weights of points (empty: unit weights)
+ *  @param nonnegative look for non-negative solutions?
+ *  @param nthreads    number of threads, 0 means all available
+ */
+// ============================================================================
+Ostap::Math::Chi2Solver::Chi2Solver
+( const Ostap::Math::Chi2Solver::CMPS& cmps        ,
+  const Ostap::Math::Chi2Solver::Data& weights     ,
+  const bool                           nonnegative ,
+  const unsigned int                   nthreads    )
+  : m_ncmps       ( cmps.size () )
+  , m_npoints     ( cmps.empty () ? 0 : cmps.front ().size () )
+  , m_nonnegative ( nonnegative )
+  , m_nthreads    ( nthreads    )
+{
+  Ostap::Assert ( weights.empty () || weights.size () == m_npoints ,
+                  "Invalid size of weights!"    ,
+                  "Ostap::Math::Chi2Solver"     ) ;
+  //
+  Data values ( m_ncmps * m_npoints ) ;
+  for ( std::size_t j = 0 ; j < m_ncmps ; ++j )
+  {
+    const DATA& cmp = cmps [ j ] ;
+    Ostap::Assert ( cmp.size () == m_npoints     ,
+                    "Invalid size of component!" ,
+                    "Ostap::Math::Chi2Solver"    ) ;
+    for ( std::size_t i = 0 ; i < m_npoints ; ++i )
+    { values [ j * m_npoints + i ] = cmp [ i ].value () ; }
+  }
+  //
+  build ( values.data () , weights.empty () ? nullptr : weights.data () ) ;
+}
+// ============================================================================
+/*  constructor from the components
+ *  @param cmps        the components: <code>ncmps</code> consecutive
+ *                     arrays of <code>npoints</code> values
+ *  @param ncmps       number of components
+ *  @param npoints     number of points
+ *  @param weights     the weights of points (nullptr: unit weights)
+ *  @param nonnegative look for non-negative solutions?
+ *  @param nthreads    number of threads, 0 means all available
+ */
+// ============================================================================
+Ostap::Math::Chi2Solver::Chi2Solver
+( const double*      cmps        ,
+  const std::size_t  ncmps       ,
+  const std::size_t  npoints     ,
+  const double*      weights     ,
+  const bool         nonnegative ,
+  const unsigned int nthreads    )
+  : m_ncmps       ( ncmps       )
+  , m_npoints     ( npoints     )
+  , m_nonnegative ( nonnegative )
+  , m_nthreads    ( nthreads    )
+{
+  Ostap::Assert ( nullptr != cmps || 0 == ncmps * npoints ,
+                  "Invalid components!"      ,
+                  "Ostap::Math::Chi2Solver"  ) ;
+  build ( cmps , weights ) ;
+}
+// ============================================================================
+// build and factorize the normal matrix
+// ============================================================================
+void Ostap::Math::Chi2Solver::build
+( const double* cmps    ,
+  const double* weights )
+{
+  Ostap::Assert ( 0 < m_ncmps && 0 < m_npoints                 ,
+                  "Invalid number of components and/or points!" ,
+                  "Ostap::Math::Chi2Solver"                      ) ;
+  //
+  const std::size_t K = m_ncmps   ;
+  const std::size_t N = m_npoints ;
+  //
+  m_cmps.assign ( cmps , cmps + K * N ) ;
+  if ( nullptr != weights ) { m_weights.assign ( weights , weights + N ) ; }
+  //
+  const double* c = m_cmps.data () ;
+  const double* w = m_weights.empty () ? nullptr : m_weights.data () ;
+  //
+  // the normal matrix: C^T W C
+  m_matrix.resize ( K * K ) ;
+  _accumulate_
+    ( N , K * K / 2 + K , m_nthreads ,
+      [K,N,c,w] ( const std::size_t first ,
+                  const std::size_t last  ,
+                  double*           acc   )
+      {
+        std::vector<double> u ( K * s_BLOCK ) ;
+        for ( std::size_t b0 = first ; b0 < last ; b0 += s_BLOCK )
+        {
+          const std::size_t nb = std::min ( s_BLOCK , last - b0 ) ;
+          for ( std::size_t j = 0 ; j < K ; ++j )
+          {
+            const double* cj = c + j * N + b0 ;
+            double*       uj = u.data () + j * s_BLOCK ;
+            if ( nullptr == w ) { std::copy ( cj , cj + nb , uj ) ; continue ; }
+            for ( std::size_t i = 0 ; i < nb ; ++i ) { uj [ i ] = w [ b0 + i ] * cj [ i ] ; }
+          }
+          for ( std::size_t j = 0 ; j < K ; ++j )
+          {
+            const double* uj = u.data () + j * s_BLOCK ;
+            for ( std::size_t k = 0 ; k <= j ; ++k )
+            { acc [ j * K + k ] += _dot_ ( uj , c + k * N + b0 , nb ) ; }
+          }
+        }
+      } , m_matrix ) ;
+  _symmetrize_ ( m_matrix.data () , K ) ;
+  //
+  m_factor = m_matrix ;
+  m_code   = _cholesky_ ( m_factor , K ) ?
+    Ostap::StatusCode ( Ostap::StatusCode::SUCCESS ) : Ostap::StatusCode ( 321 ) ;
+}
+// ============================================================================
+// the element of normal matrix
+// ============================================================================
+double Ostap::Math::Chi2Solver::matrix
+( const unsigned int i1 ,
+  const unsigned int i2 ) const
+{
+  if ( m_ncmps <= i1 || m_ncmps <= i2 ) { return -s_Inf ; }
+  return m_matrix [ i1 * m_ncmps + i2 ] ;
+}
+// ============================================================================
+// the element of covariance matrix (unconstrained)
+// ============================================================================
+double Ostap::Math::Chi2Solver::cov2
+( const unsigned int i1 ,
+  const unsigned int i2 ) const
+{
+  if ( m_code.isFailure ()              ) { return -s_Inf ; }
+  if ( m_ncmps <= i1 || m_ncmps <= i2   ) { return -s_Inf ; }
+  Data e ( m_ncmps , 0.0 ) ;
+  e [ i2 ] = 1 ;
+  _cholesky_solve_ ( m_factor , m_ncmps , e.data () ) ;
+  return e [ i1 ] ;
+}
+// ============================================================================
+// solve for one data vector
+// ============================================================================
+Ostap::StatusCode Ostap::Math::Chi2Solver::solve_
+( const double*      data     ,
+  double*            result   ,
+  double&            chi2     ,
+  const unsigned int nthreads ,
+  std::vector<int>*  passive  ) const
+{
+  chi2 = s_Inf ;
+  if ( m_code.isFailure () ) { return m_code ; }                     // RETURN
+  //
+  const std::size_t K = m_ncmps   ;
+  const std::size_t N = m_npoints ;
+  const double*     c = m_cmps.data () ;
+  const double*     w = m_weights.empty () ? nullptr : m_weights.data () ;
+  //
+  // the right-hand side C^T W d and d^T W d
+  Data acc ( K + 1 , 0.0 ) ;
+  _accumulate_
+    ( N , K + 1 , nthreads ,
+      [K,N,c,w,data] ( const std::size_t first ,
+                       const std::size_t last  ,
+                       double*           acc   )
+      {
+        std::vector<double> u ( s_BLOCK ) ;
+        for ( std::size_t b0 = first ; b0 < last ; b0 += s_BLOCK )
+        {
+          const std::size_t nb = std::min ( s_BLOCK , last - b0 ) ;
+          const double*     d  = data + b0 ;
+          if ( nullptr == w ) { std::copy ( d , d + nb , u.begin () ) ; }
+          else { for ( std::size_t i = 0 ; i < nb ; ++i ) { u [ i ] = w [ b0 + i ] * d [ i ] ; } }
+          acc [ K ] += _dot_ ( u.data () , d , nb ) ;
+          for ( std::size_t j = 0 ; j < K ; ++j )
+          { acc [ j ] += _dot_ ( u.data () , c + j * N + b0 , nb ) ; }
+        }
+      } , acc ) ;
+  //
+  // unconstrained solution
+  std::copy ( acc.begin () , acc.begin () + K , result ) ;
+  _cholesky_solve_ ( m_factor , K , result ) ;
+  //
+  std::vector<int> pset {} ;
+  std::vector<int>& ps = nullptr != passive ? *passive : pset ;
+  ps.assign ( K , 1 ) ;
+  //
+  if ( m_nonnegative && std::any_of ( result , result + K , [] ( const double v ) { return v < 0 ; } ) )
+  {
+    const Ostap::StatusCode sc = _nnls_ ( m_matrix , acc.data () , K , result , ps ) ;
+    if ( sc.isFailure () ) { return sc ; }                           // RETURN
+  }
+  //
+  // chi2 = d^T W d - 2 a^T b + a^T M a
+  double c2 = acc [ K ] ;
+  for ( std::size_t j = 0 ; j < K ; ++j )
+  {
+    c2 -= 2 * result [ j ] * acc [ j ] ;
+    c2 += result [ j ] * _dot_ ( m_matrix.data () + j * K , result , K ) ;
+  }
+  chi2 = std::max ( c2 , 0.0 ) ;
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+/*  solve for one data vector
+ *  @param data   (INPUT)  data, <code>points()</code> values
+ *  @param result (OUTPUT) parameters,  <code>size()</code> values
+ *  @param chi2   (OUTPUT) chi2 at solution
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::Math::Chi2Solver::solve
+( const double* data   ,
+  double*       result ,
+  double&       chi2   ) const
+{ return solve_ ( data , result , chi2 , m_nthreads , nullptr ) ; }
+// ============================================================================
+/*  solve for many data vectors
+ *  @param data     (INPUT)  <code>nvectors</code> consecutive data vectors
+ *  @param nvectors (INPUT)  number of data vectors
+ *  @param results  (OUTPUT) <code>nvectors</code> consecutive parameter vectors
+ *  @param chi2s    (OUTPUT) <code>nvectors</code> chi2 values (can be nullptr)
+ *  @return status code (the first failure, if any)
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::Math::Chi2Solver::solve_many
+( const double*     data     ,
+  const std::size_t nvectors ,
+  double*           results  ,
+  double*           chi2s    ) const
+{
+  if ( m_code.isFailure () ) { return m_code ; }                     // RETURN
+  //
+  const std::size_t K  = m_ncmps   ;
+  const std::size_t N  = m_npoints ;
+  const std::size_t nt = std::min<std::size_t>
+    ( nvectors , 1 == m_nthreads ? 1u : Ostap::Utils::nThreads ( m_nthreads ) ) ;
+  //
+  // one vector (or one thread): the points are split between threads
+  if ( nt <= 1 )
+  {
+    Ostap::StatusCode result = Ostap::StatusCode::SUCCESS ;
+    for ( std::size_t v = 0 ; v < nvectors ; ++v )
+    {
+      double c2 = 0 ;
+      const Ostap::StatusCode sc = solve_ ( data + v * N , results + v * K , c2 , m_nthreads , nullptr ) ;
+      if ( nullptr != chi2s    ) { chi2s [ v ] = c2 ; }
+      if ( result.isSuccess () ) { result = sc ; }
+    }
+    return result ;
+  }
+  //
+  // many vectors: the vectors are split between threads
+  std::vector<unsigned long>      codes   ( nvectors , Ostap::StatusCode::SUCCESS ) ;
+  std::vector<std::exception_ptr> errors  ( nt ) ;
+  std::atomic<std::size_t>        next    { 0 } ;
+  auto task = [&] ( const std::size_t t )
+    {
+      try
+      {
+        for ( std::size_t v = next++ ; v < nvectors ; v = next++ )
+        {
+          double c2 = 0 ;
+          codes [ v ] = solve_ ( data + v * N , results + v * K , c2 , 1 , nullptr ) ;
+          if ( nullptr != chi2s ) { chi2s [ v ] = c2 ; }
+        }
+      }
+      catch ( ... ) { errors [ t ] = std::current_exception () ; }
+    } ;
+  //
+  std::vector<std::thread> threads ;
+  threads.reserve ( nt ) ;
+  for ( std::size_t t = 1 ; t < nt ; ++t ) { threads.emplace_back ( task , t ) ; }
+  task ( 0 ) ;
+  for ( auto& t : threads ) { t.join () ; }
+  for ( const auto& e : errors ) { if ( e ) { std::rethrow_exception ( e ) ; } }
+  //
+  for ( const unsigned long c : codes )
+  { if ( Ostap::StatusCode::SUCCESS != c ) { return Ostap::StatusCode ( c ) ; } }
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+/*  solve for one data vector
+ *  @param data (INPUT)  data, <code>points()</code> values
+ *  @return parameters (empty vector for failure)
+ */
+// ============================================================================
+Ostap::Math::Chi2Solver::DATA
+Ostap::Math::Chi2Solver::solve
+( const Ostap::Math::Chi2Solver::Data& data ) const
+{
+  Ostap::Assert ( data.size () == m_npoints  ,
+                  "Invalid size of data!"    ,
+                  "Ostap::Math::Chi2Solver"  ) ;
+  //
+  const std::size_t K = m_ncmps ;
+  Data              result ( K , 0.0 ) ;
+  double            chi2   = 0 ;
+  std::vector<int>  passive {} ;
+  if ( solve_ ( data.data () , result.data () , chi2 , m_nthreads , &passive ).isFailure () )
+  { return DATA () ; }                                               // RETURN
+  //
+  // the covariance matrix, restricted to non-zero parameters
+  std::vector<std::size_t> idx {} ;
+  for ( std::size_t j = 0 ; j < K ; ++j ) { if ( passive [ j ] ) { idx.push_back ( j ) ; } }
+  const std::size_t np = idx.size () ;
+  //
+  Data sub ( np * np ) ;
+  for ( std::size_t p = 0 ; p < np ; ++p )
+  { for ( std::size_t q = 0 ; q < np ; ++q ) { sub [ p * np + q ] = m_matrix [ idx [ p ] * K + idx [ q ] ] ; } }
+  if ( np < K && !_cholesky_ ( sub , np ) ) { return DATA () ; }     // RETURN
+  const Data& factor = np < K ? sub : m_factor ;
+  //
+  DATA params ( K ) ;
+  Data e      ( np ) ;
+  for ( std::size_t p = 0 ; p < np ; ++p )
+  {
+    std::fill ( e.begin () , e.end () , 0.0 ) ;
+    e [ p ] = 1 ;
+    _cholesky_solve_ ( factor , np , e.data () ) ;
+    params [ idx [ p ] ] = VE ( result [ idx [ p ] ] , e [ p ] ) ;
+  }
+  for ( std::size_t j = 0 ; j < K ; ++j )
+  { if ( !passive [ j ] ) { params [ j ] = VE ( result [ j ] , 0 ) ; } }
+  //
+  return params ;
+}
+// ============================================================================
 // The END 
 // ============================================================================
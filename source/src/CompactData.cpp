@@ -0,0 +1,370 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <map>
+#include <memory>
+#include <algorithm>
+// ============================================================================
+// ROOT&RooFit
+// ============================================================================
+#include "TTree.h"
+#include "RooAbsData.h"
+#include "RooAbsReal.h"
+#include "RooAbsCategory.h"
+#include "RooArgSet.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/CompactData.h"
+#include "Ostap/DataColumns.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Utils::CompactData
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  static const char s_TAG [] = "Ostap::Utils::CompactData" ;
+  // ==========================================================================
+  /// number of bits needed for the given number of states
+  inline unsigned int _bits_ ( const std::size_t nstates )
+  {
+    unsigned int bits = 1 ;
+    while ( bits < 32 && ( std::size_t ( 1 ) << bits ) < nstates ) { ++bits ; }
+    return bits ;
+  }
+  // ==========================================================================
+  /// is the name in the list?
+  inline bool _in_ ( const std::string& name , const std::vector<std::string>& names )
+  { return names.end () != std::find ( names.begin () , names.end () , name ) ; }
+  // ==========================================================================
+}
+// ============================================================================
+// pack the state numbers of the category
+// ============================================================================
+void Ostap::Utils::CompactData::pack
+( Ostap::Utils::CompactData::Category& cat    ,
+  const std::vector<unsigned int>&     states )
+{
+  cat.bits = _bits_ ( cat.labels.size () ) ;
+  const std::size_t nbits = states.size () * cat.bits ;
+  cat.packed.assign ( ( nbits + 63 ) / 64 , 0 ) ;
+  for ( std::size_t i = 0 ; i < states.size () ; ++i )
+  {
+    const std::size_t   pos   = i * cat.bits ;
+    const std::size_t   word  = pos / 64 ;
+    const unsigned int  shift = pos % 64 ;
+    const std::uint64_t value = states [ i ] ;
+    cat.packed [ word ] |= value << shift ;
+    if ( 64 < shift + cat.bits ) { cat.packed [ word + 1 ] |= value >> ( 64 - shift ) ; }
+  }
+}
+// ============================================================================
+/*  constructor from the RooFit dataset
+ *  @param data    the dataset
+ *  @param doubles the names of the columns to be kept in double precision
+ */
+// ============================================================================
+Ostap::Utils::CompactData::CompactData
+( const RooAbsData&               data    ,
+  const std::vector<std::string>& doubles )
+{
+  const RooArgSet* vars = data.get () ;
+  Ostap::Assert ( nullptr != vars , "Invalid dataset" , s_TAG ) ;
+  //
+  m_size = data.numEntries () ;
+  //
+  std::vector<std::string>                names ;
+  std::vector<std::string>                cats  ;
+  for ( const RooAbsArg* a : *vars )
+  {
+    if      ( nullptr != dynamic_cast<const RooAbsCategory*> ( a ) ) { cats .push_back ( a->GetName () ) ; }
+    else if ( nullptr != dynamic_cast<const RooAbsReal*>     ( a ) ) { names.push_back ( a->GetName () ) ; }
+  }
+  //
+  for ( const std::string& n : names )
+  {
+    Column c ;
+    c.name   = n ;
+    c.single = !_in_ ( n , doubles ) ;
+    if ( c.single ) { c.floats .reserve ( m_size ) ; }
+    else            { c.doubles.reserve ( m_size ) ; }
+    m_columns.push_back ( std::move ( c ) ) ;
+  }
+  //
+  std::vector<std::vector<unsigned int> > states ( cats.size () ) ;
+  std::vector<std::map<int,unsigned int> > known ( cats.size () ) ;
+  for ( std::size_t k = 0 ; k < cats.size () ; ++k )
+  {
+    Category c ;
+    c.name = cats [ k ] ;
+    m_cats.push_back ( std::move ( c ) ) ;
+    states [ k ].reserve ( m_size ) ;
+  }
+  //
+  const bool weighted = data.isWeighted () ;
+  if ( weighted ) { m_weights.reserve ( m_size ) ; }
+  //
+  long double sumw = 0 ;
+  for ( std::size_t i = 0 ; i < m_size ; ++i )
+  {
+    const RooArgSet* row = data.get ( i ) ;
+    //
+    for ( Column& c : m_columns )
+    {
+      const RooAbsReal* v = static_cast<const RooAbsReal*> ( row->find ( c.name.c_str () ) ) ;
+      if ( c.single ) { c.floats .push_back ( v->getVal () ) ; }
+      else            { c.doubles.push_back ( v->getVal () ) ; }
+    }
+    //
+    for ( std::size_t k = 0 ; k < m_cats.size () ; ++k )
+    {
+      const RooAbsCategory* c = static_cast<const RooAbsCategory*> ( row->find ( m_cats [ k ].name.c_str () ) ) ;
+      const int index = c->getCurrentIndex () ;
+      auto it = known [ k ].find ( index ) ;
+      if ( known [ k ].end () == it )
+      {
+        it = known [ k ].emplace ( index , m_cats [ k ].labels.size () ).first ;
+        m_cats [ k ].labels .push_back ( c->getCurrentLabel () ) ;
+        m_cats [ k ].indices.push_back ( index ) ;
+      }
+      states [ k ].push_back ( it->second ) ;
+    }
+    //
+    const double w = data.weight () ;
+    if ( weighted ) { m_weights.push_back ( w ) ; }
+    sumw += w ;
+  }
+  m_sumw = sumw ;
+  //
+  for ( std::size_t k = 0 ; k < m_cats.size () ; ++k ) { pack ( m_cats [ k ] , states [ k ] ) ; }
+}
+// ============================================================================
+/*  constructor from TTree/TChain
+ *  @param tree        the tree/chain
+ *  @param names       the names of the columns
+ *  @param expressions the expressions for the columns
+ *  @param selection   the selection
+ *  @param weight      the expression for the weight (if any)
+ *  @param doubles     the names of the columns to be kept in double precision
+ *  @param nthreads    number of threads
+ *  @param first       the first entry to process
+ *  @param last        the last entry to process
+ */
+// ============================================================================
+Ostap::Utils::CompactData::CompactData
+( TTree*                          tree        ,
+  const std::vector<std::string>& names       ,
+  const std::vector<std::string>& expressions ,
+  const std::string&              selection   ,
+  const std::string&              weight      ,
+  const std::vector<std::string>& doubles     ,
+  const unsigned int              nthreads    ,
+  const unsigned long             first       ,
+  const unsigned long             last        )
+{
+  Ostap::Assert ( nullptr != tree                      , "Invalid tree"              , s_TAG ) ;
+  Ostap::Assert ( names.size () == expressions.size () , "Mismatch names/expressions" , s_TAG ) ;
+  //
+  const unsigned long nentries = std::min ( last , (unsigned long) tree->GetEntries () ) ;
+  const unsigned long capacity = first < nentries ? nentries - first : 0 ;
+  //
+  // split the columns according to the precision
+  std::vector<std::string> fexprs , dexprs ;
+  for ( std::size_t i = 0 ; i < names.size () ; ++i )
+  {
+    Column c ;
+    c.name   = names [ i ] ;
+    c.single = !_in_ ( c.name , doubles ) ;
+    if ( c.single ) { fexprs.push_back ( expressions [ i ] ) ; }
+    else            { dexprs.push_back ( expressions [ i ] ) ; }
+    m_columns.push_back ( std::move ( c ) ) ;
+  }
+  if ( !weight.empty () ) { fexprs.push_back ( weight ) ; }
+  //
+  // single-precision columns (and the weight)
+  std::size_t nf = 0 ;
+  if ( !fexprs.empty () )
+  {
+    std::vector<float> buffer ( fexprs.size () * capacity ) ;
+    nf = Ostap::Utils::read_columns
+      ( tree , fexprs , selection , buffer.data () , capacity , first , last , nthreads ) ;
+    std::size_t j = 0 ;
+    for ( Column& c : m_columns )
+    {
+      if ( !c.single ) { continue ; }
+      const float* begin = buffer.data () + j * capacity ;
+      c.floats.assign ( begin , begin + nf ) ;
+      ++j ;
+    }
+    if ( !weight.empty () )
+    {
+      const float* begin = buffer.data () + j * capacity ;
+      m_weights.assign ( begin , begin + nf ) ;
+    }
+  }
+  //
+  // double-precision columns
+  std::size_t nd = 0 ;
+  if ( !dexprs.empty () )
+  {
+    std::vector<double> buffer ( dexprs.size () * capacity ) ;
+    nd = Ostap::Utils::read_columns
+      ( tree , dexprs , selection , buffer.data () , capacity , first , last , nthreads ) ;
+    std::size_t j = 0 ;
+    for ( Column& c : m_columns )
+    {
+      if ( c.single ) { continue ; }
+      const double* begin = buffer.data () + j * capacity ;
+      c.doubles.assign ( begin , begin + nd ) ;
+      ++j ;
+    }
+  }
+  //
+  Ostap::Assert ( fexprs.empty () || dexprs.empty () || nf == nd ,
+                  "Mismatch in number of selected entries" , s_TAG ) ;
+  m_size = fexprs.empty () ? nd : nf ;
+  //
+  if ( m_weights.empty () ) { m_sumw = m_size ; }
+  else
+  {
+    long double sumw = 0 ;
+    for ( const float w : m_weights ) { sumw += w ; }
+    m_sumw = sumw ;
+  }
+}
+// ============================================================================
+// memory used by the data (bytes)
+// ============================================================================
+std::size_t Ostap::Utils::CompactData::memory () const
+{
+  std::size_t result = m_weights.size () * sizeof ( float ) ;
+  for ( const Column&   c : m_columns )
+  { result += c.floats.size () * sizeof ( float ) + c.doubles.size () * sizeof ( double ) ; }
+  for ( const Category& c : m_cats    )
+  { result += c.packed.size () * sizeof ( std::uint64_t ) ; }
+  return result ;
+}
+// ============================================================================
+// the name of the real column
+// ============================================================================
+const std::string& Ostap::Utils::CompactData::name ( const std::size_t column ) const
+{
+  Ostap::Assert ( column < m_columns.size () , "Invalid column" , s_TAG ) ;
+  return m_columns [ column ].name ;
+}
+// ============================================================================
+// the name of the category
+// ============================================================================
+const std::string& Ostap::Utils::CompactData::catName ( const std::size_t icat ) const
+{
+  Ostap::Assert ( icat < m_cats.size () , "Invalid category" , s_TAG ) ;
+  return m_cats [ icat ].name ;
+}
+// ============================================================================
+// is the column kept in single precision?
+// ============================================================================
+bool Ostap::Utils::CompactData::isFloat ( const std::size_t column ) const
+{
+  Ostap::Assert ( column < m_columns.size () , "Invalid column" , s_TAG ) ;
+  return m_columns [ column ].single ;
+}
+// ============================================================================
+// the index of real column
+// ============================================================================
+std::size_t Ostap::Utils::CompactData::column ( const std::string& name ) const
+{
+  for ( std::size_t i = 0 ; i < m_columns.size () ; ++i )
+  { if ( name == m_columns [ i ].name ) { return i ; } }
+  return m_columns.size () ;
+}
+// ============================================================================
+// the index of category
+// ============================================================================
+std::size_t Ostap::Utils::CompactData::category ( const std::string& name ) const
+{
+  for ( std::size_t i = 0 ; i < m_cats.size () ; ++i )
+  { if ( name == m_cats [ i ].name ) { return i ; } }
+  return m_cats.size () ;
+}
+// ============================================================================
+// get the batch of values (converted to double precision)
+// ============================================================================
+std::size_t Ostap::Utils::CompactData::values
+( const std::size_t column ,
+  const std::size_t first  ,
+  const std::size_t n      ,
+  double*           result ) const
+{
+  Ostap::Assert ( column < m_columns.size () , "Invalid column" , s_TAG ) ;
+  if ( m_size <= first ) { return 0 ; }                            // RETURN
+  const std::size_t num = std::min ( n , m_size - first ) ;
+  const Column& c = m_columns [ column ] ;
+  if ( c.single ) { std::copy ( c.floats .begin () + first , c.floats .begin () + first + num , result ) ; }
+  else            { std::copy ( c.doubles.begin () + first , c.doubles.begin () + first + num , result ) ; }
+  return num ;
+}
+// ============================================================================
+// get the batch of weights
+// ============================================================================
+std::size_t Ostap::Utils::CompactData::weights
+( const std::size_t first  ,
+  const std::size_t n      ,
+  double*           result ) const
+{
+  if ( m_size <= first ) { return 0 ; }                            // RETURN
+  const std::size_t num = std::min ( n , m_size - first ) ;
+  if ( m_weights.empty () ) { std::fill ( result , result + num , 1.0 ) ; }
+  else { std::copy ( m_weights.begin () + first , m_weights.begin () + first + num , result ) ; }
+  return num ;
+}
+// ============================================================================
+// the state number of the category for the given entry
+// ============================================================================
+unsigned int Ostap::Utils::CompactData::state
+( const std::size_t icat  ,
+  const std::size_t entry ) const
+{
+  const Category&     c     = m_cats [ icat ] ;
+  const std::size_t   pos   = entry * c.bits ;
+  const std::size_t   word  = pos / 64 ;
+  const unsigned int  shift = pos % 64 ;
+  std::uint64_t value = c.packed [ word ] >> shift ;
+  if ( 64 < shift + c.bits ) { value |= c.packed [ word + 1 ] << ( 64 - shift ) ; }
+  return static_cast<unsigned int> ( value & ( ( std::uint64_t ( 1 ) << c.bits ) - 1 ) ) ;
+}
+// ============================================================================
+// the category label for the given entry
+// ============================================================================
+const std::string& Ostap::Utils::CompactData::label
+( const std::size_t icat  ,
+  const std::size_t entry ) const
+{ return m_cats [ icat ].labels [ state ( icat , entry ) ] ; }
+// ============================================================================
+// the category index for the given entry
+// ============================================================================
+int Ostap::Utils::CompactData::index
+( const std::size_t icat  ,
+  const std::size_t entry ) const
+{ return m_cats [ icat ].indices [ state ( icat , entry ) ] ; }
+// ============================================================================
+// all labels of the category
+// ============================================================================
+const std::vector<std::string>&
+Ostap::Utils::CompactData::labels ( const std::size_t icat ) const
+{
+  Ostap::Assert ( icat < m_cats.size () , "Invalid category" , s_TAG ) ;
+  return m_cats [ icat ].labels ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,548 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Covariance.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for classes Ostap::Math::Covariance
+ *  and Ostap::Math::Covariances
+ *  @see Ostap::Math::Covariance
+ *  @see Ostap::Math::Covariances
+ *  @author  Vanya Belyaev Ivan.Belyaev@itep.ru
+ *  @date 2023-01-23
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_SIZE      = 860 ,
+    INVALID_INDEX     = 861 ,
+    DEGENERATE_MATRIX = 862 ,
+  } ;
+  // ==========================================================================
+  /// the block size for the batched updates
+  const std::size_t s_BLOCK = 256 ;
+  // ==========================================================================
+  /** eigen decomposition of the symmetric matrix with the cyclic Jacobi method
+   *  @param N (INPUT)  the dimension
+   *  @param a (UPDATE) the matrix (row-wise), eigenvalues on diagonal at exit
+   *  @param v (OUTPUT) the eigenvectors (column-wise)
+   */
+  void jacobi
+  ( const unsigned short N ,
+    std::vector<double>& a ,
+    std::vector<double>& v )
+  {
+    v.assign ( N * N , 0.0 ) ;
+    for ( unsigned short i = 0 ; i < N ; ++i ) { v [ i * N + i ] = 1 ; }
+    //
+    for ( unsigned short sweep = 0 ; sweep < 100 ; ++sweep )
+    {
+      double off  = 0 ;
+      double diag = 0 ;
+      for ( unsigned short p = 0 ; p < N ; ++p )
+      {
+        diag += a [ p * N + p ] * a [ p * N + p ] ;
+        for ( unsigned short q = p + 1 ; q < N ; ++q ) { off += a [ p * N + q ] * a [ p * N + q ] ; }
+      }
+      if ( off <= diag * std::numeric_limits<double>::epsilon () * std::numeric_limits<double>::epsilon () )
+      { break ; }                                                 // BREAK
+      //
+      for ( unsigned short p = 0 ; p < N ; ++p )
+      {
+        for ( unsigned short q = p + 1 ; q < N ; ++q )
+        {
+          const double apq = a [ p * N + q ] ;
+          if ( !apq ) { continue ; }
+          //
+          const double theta = 0.5 * ( a [ q * N + q ] - a [ p * N + p ] ) / apq ;
+          const double t     = 1.e+150 < std::abs ( theta ) ? 0.5 / theta :
+            std::copysign ( 1.0 , theta ) / ( std::abs ( theta ) + std::sqrt ( theta * theta + 1 ) ) ;
+          const double c     = 1 / std::sqrt ( t * t + 1 ) ;
+          const double s     = t * c ;
+          //
+          for ( unsigned short k = 0 ; k < N ; ++k )
+          {
+            const double akp = a [ k * N + p ] ;
+            const double akq = a [ k * N + q ] ;
+            a [ k * N + p ] = c * akp - s * akq ;
+            a [ k * N + q ] = s * akp + c * akq ;
+          }
+          for ( unsigned short k = 0 ; k < N ; ++k )
+          {
+            const double apk = a [ p * N + k ] ;
+            const double aqk = a [ q * N + k ] ;
+            a [ p * N + k ] = c * apk - s * aqk ;
+            a [ q * N + k ] = s * apk + c * aqk ;
+          }
+          for ( unsigned short k = 0 ; k < N ; ++k )
+          {
+            const double vkp = v [ k * N + p ] ;
+            const double vkq = v [ k * N + q ] ;
+            v [ k * N + p ] = c * vkp - s * vkq ;
+            v [ k * N + q ] = s * vkp + c * vkq ;
+          }
+        }
+      }
+    }
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// full constructor
+// ============================================================================
+Ostap::Math::Covariance::Covariance
+( const Ostap::WStatEntity& cnt1 ,
+  const Ostap::WStatEntity& cnt2 ,
+  const double              cov  )
+  : m_cnt1 ( cnt1 )
+  , m_cnt2 ( cnt2 )
+  , m_cov  ( cov  )
+{
+  Ostap::Assert ( cnt1.n () == cnt2.n () && cnt1.sumw () == cnt2.sumw () ,
+                  "Inconsistent counters" ,
+                  "Ostap::Math::Covariance" ) ;
+}
+// ============================================================================
+// add the pair of values with the weight
+// ============================================================================
+Ostap::Math::Covariance&
+Ostap::Math::Covariance::add
+( const double x ,
+  const double y ,
+  const double w )
+{
+  if ( 0 < n () )
+  {
+    const long double wA = sumw () ;
+    const long double W  = wA + w  ;
+    if ( W )
+    {
+      const long double fA = wA / W   ;
+      const long double fB = 1.0L - fA ;
+      const long double dx = 1.0L * x - m_cnt1.mu () ;
+      const long double dy = 1.0L * y - m_cnt2.mu () ;
+      m_cov = fA * m_cov + fA * fB * dx * dy ;                 // UPDATE
+    }
+  }
+  else { m_cov = 0 ; }
+  //
+  m_cnt1.add ( x , w ) ;                                       // UPDATE
+  m_cnt2.add ( y , w ) ;                                       // UPDATE
+  //
+  return *this ;
+}
+// ============================================================================
+// add other counter
+// ============================================================================
+Ostap::Math::Covariance&
+Ostap::Math::Covariance::add
+( const Ostap::Math::Covariance& other )
+{
+  // treat the trivial cases
+  if      ( 0 == other.n () ) { return *this ; }
+  else if ( 0 ==       n () ) { *this = other ; return *this ; }
+  //
+  const long double wA = sumw       () ;
+  const long double wB = other.sumw () ;
+  const long double W  = wA + wB       ;
+  if ( W )
+  {
+    const long double fA = wA / W    ;
+    const long double fB = 1.0L - fA ;
+    const long double dx = 1.0L * other.m_cnt1.mu () - m_cnt1.mu () ;
+    const long double dy = 1.0L * other.m_cnt2.mu () - m_cnt2.mu () ;
+    m_cov = fA * m_cov + fB * other.m_cov + fA * fB * dx * dy ; // UPDATE
+  }
+  //
+  m_cnt1 += other.m_cnt1 ;                                      // UPDATE
+  m_cnt2 += other.m_cnt2 ;                                      // UPDATE
+  //
+  return *this ;
+}
+// ============================================================================
+// the weighted correlation coefficient
+// ============================================================================
+double Ostap::Math::Covariance::correlation () const
+{
+  const double v1 = m_cnt1.mu2 () ;
+  const double v2 = m_cnt2.mu2 () ;
+  if ( v1 <= 0 || v2 <= 0 ) { return 0 ; }
+  const double r  = m_cov / std::sqrt ( v1 * v2 ) ;
+  return std::max ( -1.0 , std::min ( 1.0 , r ) ) ;
+}
+// ============================================================================
+// reset the counter
+// ============================================================================
+void Ostap::Math::Covariance::reset ()
+{
+  m_cnt1.reset () ;
+  m_cnt2.reset () ;
+  m_cov = 0 ;
+}
+// ============================================================================
+// constructor for N variables
+// ============================================================================
+Ostap::Math::Covariances::Covariances
+( const unsigned short N )
+  : m_cnts ( N )
+  , m_cov  ( N * ( N + 1 ) / 2 , 0.0 )
+{}
+// ============================================================================
+// full constructor
+// ============================================================================
+Ostap::Math::Covariances::Covariances
+( const std::vector<Ostap::WStatEntity>& counters ,
+  const std::vector<double>&             cov2     )
+  : m_cnts ( counters )
+  , m_cov  ( cov2     )
+{
+  const std::size_t N = counters.size () ;
+  Ostap::Assert ( N * ( N + 1 ) / 2 == cov2.size () ,
+                  "Inconsistent size of covariance matrix" ,
+                  "Ostap::Math::Covariances" , INVALID_SIZE ) ;
+  for ( const auto& c : counters )
+  {
+    Ostap::Assert ( c.n () == n () && c.sumw () == sumw () ,
+                    "Inconsistent counters" ,
+                    "Ostap::Math::Covariances" , INVALID_SIZE ) ;
+  }
+}
+// ============================================================================
+// statistic for the i-th variable
+// ============================================================================
+const Ostap::WStatEntity&
+Ostap::Math::Covariances::counter ( const unsigned short i ) const
+{
+  Ostap::Assert ( i < size () , "Invalid index" ,
+                  "Ostap::Math::Covariances" , INVALID_INDEX ) ;
+  return m_cnts [ i ] ;
+}
+// ============================================================================
+// the weighted covariance
+// ============================================================================
+double Ostap::Math::Covariances::covariance
+( const unsigned short i ,
+  const unsigned short j ) const
+{
+  Ostap::Assert ( i < size () && j < size () , "Invalid index" ,
+                  "Ostap::Math::Covariances" , INVALID_INDEX ) ;
+  return m_cov [ index ( i , j ) ] ;
+}
+// ============================================================================
+// the weighted correlation coefficient
+// ============================================================================
+double Ostap::Math::Covariances::correlation
+( const unsigned short i ,
+  const unsigned short j ) const
+{
+  const double cij = covariance ( i , j ) ;
+  const double vi  = m_cov [ index ( i , i ) ] ;
+  const double vj  = m_cov [ index ( j , j ) ] ;
+  if ( vi <= 0 || vj <= 0 ) { return 0 ; }
+  const double r   = cij / std::sqrt ( vi * vj ) ;
+  return std::max ( -1.0 , std::min ( 1.0 , r ) ) ;
+}
+// ============================================================================
+// add the entry with the weight
+// ============================================================================
+Ostap::Math::Covariances&
+Ostap::Math::Covariances::add
+( const double* x ,
+  const double  w )
+{
+  const unsigned short N = size () ;
+  if ( 0 < n () )
+  {
+    const long double wA = sumw () ;
+    const long double W  = wA + w  ;
+    if ( W )
+    {
+      const long double fA = wA / W    ;
+      const long double fB = 1.0L - fA ;
+      for ( unsigned short i = 0 ; i < N ; ++i )
+      {
+        const long double di = 1.0L * x [ i ] - m_cnts [ i ].mu () ;
+        const std::size_t ii = i * ( i + 1 ) / 2 ;
+        for ( unsigned short j = 0 ; j <= i ; ++j )
+        {
+          const long double dj = 1.0L * x [ j ] - m_cnts [ j ].mu () ;
+          m_cov [ ii + j ] = fA * m_cov [ ii + j ] + fA * fB * di * dj ; // UPDATE
+        }
+      }
+    }
+  }
+  else { std::fill ( m_cov.begin () , m_cov.end () , 0.0 ) ; }
+  //
+  for ( unsigned short i = 0 ; i < N ; ++i ) { m_cnts [ i ].add ( x [ i ] , w ) ; }
+  //
+  return *this ;
+}
+// ============================================================================
+// add the entry with the weight
+// ============================================================================
+Ostap::Math::Covariances&
+Ostap::Math::Covariances::add
+( const std::vector<double>& x ,
+  const double               w )
+{
+  Ostap::Assert ( x.size () == size () , "Invalid size of the entry" ,
+                  "Ostap::Math::Covariances" , INVALID_SIZE ) ;
+  return add ( x.data () , w ) ;
+}
+// ============================================================================
+/*  add the batch of entries
+ *  @param n       (INPUT) number of entries
+ *  @param rows    (INPUT) the values, stored row-wise (n*N values)
+ *  @param weights (INPUT) the weights, nullptr for unit weights
+ */
+// ============================================================================
+Ostap::Math::Covariances&
+Ostap::Math::Covariances::add
+( const std::size_t n       ,
+  const double*     rows    ,
+  const double*     weights )
+{
+  const unsigned short N = size () ;
+  if ( 0 == N || 0 == n ) { return *this ; }                      // RETURN
+  //
+  // the block of values, stored column-wise
+  std::vector<double> cols ( N * s_BLOCK ) ;
+  std::vector<double> ws   (     s_BLOCK ) ;
+  //
+  for ( std::size_t start = 0 ; start < n ; start += s_BLOCK )
+  {
+    const std::size_t m   = std::min ( s_BLOCK , n - start ) ;
+    const double*     row = rows + start * N ;
+    for ( std::size_t k = 0 ; k < m ; ++k )
+    {
+      for ( unsigned short i = 0 ; i < N ; ++i ) { cols [ i * s_BLOCK + k ] = row [ k * N + i ] ; }
+      ws [ k ] = weights ? weights [ start + k ] : 1.0 ;
+    }
+    //
+    Covariances block ( N ) ;
+    if ( block.fill ( m , cols.data () , s_BLOCK , ws.data () ) ) { add ( block ) ; }
+    else
+    {
+      // zero sum of weights or non-finite values: use the regular update
+      for ( std::size_t k = 0 ; k < m ; ++k ) { add ( row + k * N , ws [ k ] ) ; }
+    }
+  }
+  //
+  return *this ;
+}
+// ============================================================================
+/*  fill the counter from the block of entries
+ *  @param m      (INPUT)  number of entries
+ *  @param cols   (UPDATE) the values, stored column-wise
+ *  @param stride (INPUT)  the stride between the columns
+ *  @param ws     (INPUT)  the weights
+ *  @return false if the block cannot be processed in this way
+ */
+// ============================================================================
+bool Ostap::Math::Covariances::fill
+( const std::size_t m      ,
+  double*           cols   ,
+  const std::size_t stride ,
+  const double*     ws     )
+{
+  const unsigned short N = size () ;
+  //
+  // (1) statistic of weights
+  double sumw = 0 ;
+  double nz   = 0 ;
+  double wmin =   std::numeric_limits<double>::max () ;
+  double wmax = - std::numeric_limits<double>::max () ;
+  for ( std::size_t k = 0 ; k < m ; ++k )
+  {
+    const double w = ws [ k ] ;
+    sumw += w ;
+    nz   += ( w ? 1 : 0 ) ;
+    wmin  = w < wmin ? w : wmin ;
+    wmax  = wmax < w ? w : wmax ;
+  }
+  if ( !sumw || !std::isfinite ( sumw ) ) { return false ; }    // RETURN
+  //
+  const double wmu = sumw / m ;
+  double wmu2 = 0 ;
+  for ( std::size_t k = 0 ; k < m ; ++k ) { const double d = ws [ k ] - wmu ; wmu2 += d * d ; }
+  wmu2 /= m ;
+  const Ostap::StatEntity wstat ( m , wmu , wmu2 , wmin , wmax ) ;
+  //
+  // (2) means and the statistic of values with non-zero weights
+  std::vector<double> means ( N ) ;
+  std::vector<Ostap::StatEntity> vstats ( N ) ;
+  for ( unsigned short i = 0 ; i < N ; ++i )
+  {
+    const double* x = cols + i * stride ;
+    double sum  = 0 ;
+    double sumv = 0 ;
+    double vmin =   std::numeric_limits<double>::max () ;
+    double vmax = - std::numeric_limits<double>::max () ;
+    for ( std::size_t k = 0 ; k < m ; ++k )
+    {
+      const double w = ws [ k ] ;
+      const double v = w ? x [ k ] : 0.0 ;
+      sum  += w * x [ k ] ;
+      sumv += v ;
+      vmin  = w && v < vmin ? v : vmin ;
+      vmax  = w && vmax < v ? v : vmax ;
+    }
+    const double vmu  = sumv / nz ;
+    double       vmu2 = 0 ;
+    for ( std::size_t k = 0 ; k < m ; ++k )
+    { const double d = ws [ k ] ? x [ k ] - vmu : 0.0 ; vmu2 += d * d ; }
+    vmu2 /= nz ;
+    //
+    if ( !std::isfinite ( sum ) || !( vmin <= vmu && vmu <= vmax ) || !( 0 <= vmu2 ) )
+    { return false ; }                                          // RETURN
+    //
+    means  [ i ] = sum / sumw ;
+    vstats [ i ] = Ostap::StatEntity ( (unsigned long) nz , vmu , vmu2 , vmin , vmax ) ;
+  }
+  //
+  // (3) center the values and get the co-moments
+  for ( unsigned short i = 0 ; i < N ; ++i )
+  {
+    double*      x  = cols + i * stride ;
+    const double mu = means [ i ] ;
+    for ( std::size_t k = 0 ; k < m ; ++k ) { x [ k ] -= mu ; }
+  }
+  for ( unsigned short i = 0 ; i < N ; ++i )
+  {
+    const double*     xi = cols + i * stride ;
+    const std::size_t ii = i * ( i + 1 ) / 2 ;
+    for ( unsigned short j = 0 ; j <= i ; ++j )
+    {
+      const double* xj  = cols + j * stride ;
+      double        sij = 0 ;
+      for ( std::size_t k = 0 ; k < m ; ++k ) { sij += ws [ k ] * xi [ k ] * xj [ k ] ; }
+      m_cov [ ii + j ] = sij / sumw ;
+    }
+  }
+  //
+  for ( unsigned short i = 0 ; i < N ; ++i )
+  {
+    m_cnts [ i ] = Ostap::WStatEntity ( means [ i ] , m_cov [ index ( i , i ) ] , vstats [ i ] , wstat ) ;
+  }
+  //
+  return true ;
+}
+// ============================================================================
+// add other counter
+// ============================================================================
+Ostap::Math::Covariances&
+Ostap::Math::Covariances::add
+( const Ostap::Math::Covariances& other )
+{
+  // treat the trivial cases
+  if      ( 0 == other.n () ) { return *this ; }
+  else if ( 0 ==       n () ) { *this = other ; return *this ; }
+  //
+  Ostap::Assert ( size () == other.size () , "Mismatch in number of variables" ,
+                  "Ostap::Math::Covariances" , INVALID_SIZE ) ;
+  //
+  const unsigned short N  = size () ;
+  const long double    wA = sumw       () ;
+  const long double    wB = other.sumw () ;
+  const long double    W  = wA + wB       ;
+  if ( W )
+  {
+    const long double fA = wA / W    ;
+    const long double fB = 1.0L - fA ;
+    for ( unsigned short i = 0 ; i < N ; ++i )
+    {
+      const long double di = 1.0L * other.m_cnts [ i ].mu () - m_cnts [ i ].mu () ;
+      const std::size_t ii = i * ( i + 1 ) / 2 ;
+      for ( unsigned short j = 0 ; j <= i ; ++j )
+      {
+        const long double dj = 1.0L * other.m_cnts [ j ].mu () - m_cnts [ j ].mu () ;
+        m_cov [ ii + j ] = fA * m_cov [ ii + j ] + fB * other.m_cov [ ii + j ] + fA * fB * di * dj ; // UPDATE
+      }
+    }
+  }
+  //
+  for ( unsigned short i = 0 ; i < N ; ++i ) { m_cnts [ i ] += other.m_cnts [ i ] ; }
+  //
+  return *this ;
+}
+// ============================================================================
+// reset the counter
+// ============================================================================
+void Ostap::Math::Covariances::reset ()
+{
+  for ( auto& c : m_cnts ) { c.reset () ; }
+  std::fill ( m_cov.begin () , m_cov.end () , 0.0 ) ;
+}
+// ============================================================================
+/*  eigen decomposition of the covariance matrix
+ *  @param values  (OUTPUT) the eigenvalues in ascending order
+ *  @param vectors (OUTPUT) the eigenvectors, stored row-wise
+ */
+// ============================================================================
+void Ostap::Math::Covariances::eigen
+( std::vector<double>& values  ,
+  std::vector<double>& vectors ) const
+{
+  const unsigned short N = size () ;
+  //
+  std::vector<double> a ( N * N ) ;
+  for ( unsigned short i = 0 ; i < N ; ++i )
+  { for ( unsigned short j = 0 ; j < N ; ++j ) { a [ i * N + j ] = m_cov [ index ( i , j ) ] ; } }
+  //
+  std::vector<double> v ;
+  jacobi ( N , a , v ) ;
+  //
+  std::vector<unsigned short> order ( N ) ;
+  std::iota ( order.begin () , order.end () , 0 ) ;
+  std::sort ( order.begin () , order.end () ,
+              [&a,N] ( const unsigned short p , const unsigned short q )
+              { return a [ p * N + p ] < a [ q * N + q ] ; } ) ;
+  //
+  values .resize ( N     ) ;
+  vectors.resize ( N * N ) ;
+  for ( unsigned short k = 0 ; k < N ; ++k )
+  {
+    const unsigned short p = order [ k ] ;
+    values [ k ] = a [ p * N + p ] ;
+    for ( unsigned short i = 0 ; i < N ; ++i ) { vectors [ k * N + i ] = v [ i * N + p ] ; }
+  }
+}
+// ============================================================================
+/*  the decorrelation matrix D (stored row-wise):
+ *  the variables y = D ( x - mean ) are uncorrelated and have unit variances.
+ */
+// ============================================================================
+std::vector<double> Ostap::Math::Covariances::decorrelation () const
+{
+  const unsigned short N = size () ;
+  std::vector<double> values  ;
+  std::vector<double> vectors ;
+  eigen ( values , vectors ) ;
+  //
+  for ( unsigned short k = 0 ; k < N ; ++k )
+  {
+    Ostap::Assert ( 0 < values [ k ] , "Degenerate covariance matrix" ,
+                    "Ostap::Math::Covariances" , DEGENERATE_MATRIX ) ;
+    const double scale = 1 / std::sqrt ( values [ k ] ) ;
+    for ( unsigned short i = 0 ; i < N ; ++i ) { vectors [ k * N + i ] *= scale ; }
+  }
+  return vectors ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -326,6 +326,129 @@ Ostap::Kinematics::Dalitz0::s2_minmax_for_s_s1
   return std::make_pair ( q2 , q1 ) ; 
 }
 // ============================================================================
+/*  Dalitz plot boundaries \f$ s_1^{min/max} ( s, s_2 ) \f$ for arrays of points
+ *  - the triangle functions are taken in the factorized forms
+ *  - the configurations with two massless particles and invalid points
+ *    are delegated to the scalar method 
+ *  @param n     (INPUT)  number of points
+ *  @param s     (INPUT)  values of \f$ s   \f$
+ *  @param s2    (INPUT)  values of \f$ s_2 \f$
+ *  @param s1min (OUTPUT) lower boundaries for \f$ s_1 \f$
+ *  @param s1max (OUTPUT) upper boundaries for \f$ s_1 \f$
+ *  @return number of points with valid boundaries
+ */
+// ============================================================================
+std::size_t Ostap::Kinematics::Dalitz0::s1_minmax_for_s_s2
+( const std::size_t n     ,
+  const double*     s     ,
+  const double*     s2    ,
+  double*           s1min ,
+  double*           s1max ) const
+{
+  const bool special =
+    ( m1_zero () && m2_zero () ) ||
+    ( m2_zero () && m3_zero () ) ||
+    ( m3_zero () && m1_zero () ) ;
+  //
+  const double m1_  = m1     () ;
+  const double m1s  = m1sq   () ;
+  const double dm23 = m2sq   () - m3sq () ;
+  const double s_a  = m1s    + m2sq () ;
+  const double smin = sqsumm () ;
+  const double ymin = s2_min () ;
+  // lambda ( s_2 , m_2^2 , m_3^2 ) = ( s_2 - (m_2+m_3)^2 ) * ( s_2 - (m_2-m_3)^2 )
+  const double q23  = std::pow ( m2 () - m3 () , 2 ) ;
+  //
+  std::size_t nvalid = 0 ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double x   = s  [ i ] ;
+    const double y   = s2 [ i ] ;
+    const double sqs = 0 < x ? std::sqrt ( x ) : 0.0 ;
+    const double ym  = ( sqs - m1_ ) * ( sqs - m1_ ) ;
+    //
+    // lambda ( s_2 , s , m_1^2 ) = ( s_2 - (M-m_1)^2 ) * ( s_2 - (M+m_1)^2 )
+    const double f1  = ( y - ym   ) * ( y - ( sqs + m1_ ) * ( sqs + m1_ ) ) ;
+    const double f2  = ( y - ymin ) * ( y - q23 ) ;
+    //
+    if ( special || x < smin || y < ymin || ym < y || f1 < 0 || f2 < 0 || y <= 0 )
+    {
+      const std::pair<double,double> r = s1_minmax_for_s_s2 ( x , y ) ;
+      s1min  [ i ] = r.first  ;
+      s1max  [ i ] = r.second ;
+      nvalid += r.first <= r.second ;
+      continue ;
+    }
+    //
+    const double b  = ( y - x + m1s ) * ( y + dm23 ) ;
+    const double c  = std::sqrt ( f1 * f2 ) ;
+    const double sc = 0.5 / y ;
+    //
+    s1min [ i ] = s_a - ( b + c ) * sc ;
+    s1max [ i ] = s_a - ( b - c ) * sc ;
+    ++nvalid ;
+  }
+  return nvalid ;
+}
+// ============================================================================
+/*  Dalitz plot boundaries \f$ s_2^{min/max} ( s, s_1 ) \f$ for arrays of points
+ *  @see Ostap::Kinematics::Dalitz0::s2_minmax_for_s_s1
+ *  @see Ostap::Kinematics::Dalitz0::s1_minmax_for_s_s2
+ */
+// ============================================================================
+std::size_t Ostap::Kinematics::Dalitz0::s2_minmax_for_s_s1
+( const std::size_t n     ,
+  const double*     s     ,
+  const double*     s1    ,
+  double*           s2min ,
+  double*           s2max ) const
+{
+  const bool special =
+    ( m1_zero () && m2_zero () ) ||
+    ( m2_zero () && m3_zero () ) ||
+    ( m3_zero () && m1_zero () ) ;
+  //
+  const double m3_  = m3     () ;
+  const double m3s  = m3sq   () ;
+  const double dm21 = m2sq   () - m1sq () ;
+  const double s_a  = m3s    + m2sq () ;
+  const double smin = sqsumm () ;
+  const double xmin = s1_min () ;
+  // lambda ( s_1 , m_2^2 , m_1^2 ) = ( s_1 - (m_1+m_2)^2 ) * ( s_1 - (m_1-m_2)^2 )
+  const double q12  = std::pow ( m1 () - m2 () , 2 ) ;
+  //
+  std::size_t nvalid = 0 ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double x   = s  [ i ] ;
+    const double y   = s1 [ i ] ;
+    const double sqs = 0 < x ? std::sqrt ( x ) : 0.0 ;
+    const double ym  = ( sqs - m3_ ) * ( sqs - m3_ ) ;
+    //
+    // lambda ( s_1 , s , m_3^2 ) = ( s_1 - (M-m_3)^2 ) * ( s_1 - (M+m_3)^2 )
+    const double f1  = ( y - ym   ) * ( y - ( sqs + m3_ ) * ( sqs + m3_ ) ) ;
+    const double f2  = ( y - xmin ) * ( y - q12 ) ;
+    //
+    if ( special || x < smin || y < xmin || ym < y || f1 < 0 || f2 < 0 || y <= 0 )
+    {
+      const std::pair<double,double> r = s2_minmax_for_s_s1 ( x , y ) ;
+      s2min  [ i ] = r.first  ;
+      s2max  [ i ] = r.second ;
+      nvalid += r.first <= r.second ;
+      continue ;
+    }
+    //
+    const double b  = ( y - x + m3s ) * ( y + dm21 ) ;
+    const double c  = std::sqrt ( f1 * f2 ) ;
+    const double sc = 0.5 / y ;
+    //
+    s2min [ i ] = s_a - ( b + c ) * sc ;
+    s2max [ i ] = s_a - ( b - c ) * sc ;
+    ++nvalid ;
+  }
+  return nvalid ;
+}
+// ============================================================================
 /** the first x-variable is just \f$ x_1 = \cos_{R23}(12) \f$ 
  *  - cosine on the angle between 1st and 2nd particles in the  (2,3) rest frame
  *  \f$ \cos \theta_{12}^{R(2,3)}
@@ -525,6 +648,21 @@ Ostap::Kinematics::Dalitz::Dalitz
                ( m_M * m_M + m2sq () - ( m1 () + m3 () ) * ( m1 () + m3 () ) ) / ( 2 * m_M ) , // [6] 
                ( m_M * m_M + m3sq () - ( m1 () + m2 () ) * ( m1 () + m2 () ) ) / ( 2 * m_M )   // [7]
                }
+    // precalculated quantities for the batch evaluation 
+  , m_cache3 { 0.25 * M_PI * M_PI / ( m_M * m_M )  , // [0] density 
+               ( m_M + m1 () ) * ( m_M + m1 () )   , // [1] (M+m1)^2 
+               ( m_M + m2 () ) * ( m_M + m2 () )   , // [2] (M+m2)^2 
+               ( m_M + m3 () ) * ( m_M + m3 () )   , // [3] (M+m3)^2 
+               ( m2 () - m3 () ) * ( m2 () - m3 () ) , // [4] (m2-m3)^2 
+               // G ( s1 , s2 , s , m2^2 , m1^2 , m3^2 ) = s1*s2*(s1+s2-[5]) + [6]*s1 + [7]*s2 + [8]
+               m_M * m_M + summ2 ()                , // [5] 
+               m_M * m_M * m3sq () + m2sq () * m1sq () - m_M * m_M * m2sq () - m1sq () * m3sq () , // [6]
+               m_M * m_M * m1sq () + m2sq () * m3sq () - m_M * m_M * m2sq () - m1sq () * m3sq () , // [7]
+               m_M * m_M * m2sq () * ( m_M * m_M + m2sq () ) 
+               + m1sq () * m3sq () * ( m1sq () + m3sq () ) 
+               - m_M * m_M * m2sq () * ( m1sq () + m3sq () ) 
+               - m1sq () * m3sq () * ( m_M * m_M + m2sq () )    // [8]
+               }
   , m_tag2 ( std::hash_combine ( Dalitz0::tag()  , m_M ) ) 
 {
   Ostap::Assert ( m_M > m1 ()  + m2 () + m3 ()  , 
@@ -884,6 +1022,99 @@ double Ostap::Kinematics::Dalitz::density ( const double s1 , const double s2 )
   return g < 0 ? s_norm / s ()  : 0.0 ;  
 }
 // ============================================================================
+/*  evaluate the Dalitz plot quantities for arrays of points in one pass 
+ *  - all mass-dependent constants are precalculated 
+ *  - the output arrays can be <code>nullptr</code>, if not needed
+ *  @param n        number of points 
+ *  @param s1       (INPUT)  values of \f$ s_1 \f$  
+ *  @param s2       (INPUT)  values of \f$ s_2 \f$  
+ *  @param inside   (OUTPUT) is the point inside the Dalitz plot? 
+ *  @param density  (OUTPUT) Dalitz plot density, @see Dalitz::density 
+ *  @param jacobian (OUTPUT) jacobian, @see Dalitz0::J 
+ *  @param cos12    (OUTPUT) \f$ \cos \theta^{*}_{12} \f$, @see Dalitz::cos_12 
+ *  @param cos23    (OUTPUT) \f$ \cos \theta^{*}_{23} \f$, @see Dalitz::cos_23 
+ *  @param cos31    (OUTPUT) \f$ \cos \theta^{*}_{31} \f$, @see Dalitz::cos_31 
+ *  @return number of points inside the Dalitz plot 
+ */
+// ============================================================================
+std::size_t Ostap::Kinematics::Dalitz::evaluate 
+( const std::size_t n        , 
+  const double*     s1       , 
+  const double*     s2       , 
+  bool*             inside   , 
+  double*           density  , 
+  double*           jacobian , 
+  double*           cos12    , 
+  double*           cos23    , 
+  double*           cos31    ) const 
+{
+  // local copies of all constants 
+  const double ss     = s      () ;
+  const double sum    = sums   () ;
+  const double m1s    = m1sq   () ;
+  const double m2s    = m2sq   () ;
+  const double m3s    = m3sq   () ;
+  const double s1min  = s1_min () , s1max = s1_max () ;
+  const double s2min  = s2_min () , s2max = s2_max () ;
+  const double s3min  = s3_min () , s3max = s3_max () ;
+  const double dens   = m_cache3 [ 0 ] ;
+  const double q1     = m_cache3 [ 1 ] ;
+  const double q2     = m_cache3 [ 2 ] ;
+  const double q3     = m_cache3 [ 3 ] ;
+  const double q23    = m_cache3 [ 4 ] ;
+  const double gS     = m_cache3 [ 5 ] ;
+  const double gA     = m_cache3 [ 6 ] ;
+  const double gB     = m_cache3 [ 7 ] ;
+  const double gC     = m_cache3 [ 8 ] ;
+  const bool   angles = cos12 || cos23 || cos31 ;
+  //
+  std::size_t ninside = 0 ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double x = s1 [ i ] ;
+    const double y = s2 [ i ] ;
+    const double z = sum - x - y ;
+    //
+    const double g  = x * y * ( x + y - gS ) + gA * x + gB * y + gC ;
+    const bool   in = 
+      s1min <= x && x <= s1max && 
+      s2min <= y && y <= s2max && 
+      s3min <= z && z <= s3max && 0 >= g ;
+    //
+    ninside += in ;
+    if ( inside  ) { inside  [ i ] = in ; }
+    if ( density ) { density [ i ] = in && g < 0 ? dens : 0.0 ; }
+    //
+    if ( !jacobian && !angles ) { continue ; }
+    //
+    // triangle functions via the boundaries 
+    //   lambda ( s , m_1^2 , s_2 ) = ( s_2 - (M-m_1)^2 ) * ( s_2 - (M+m_1)^2 ) 
+    const double l1 = ( y - s2max ) * ( y - q1 ) ;
+    const double l2 = ( z - s3max ) * ( z - q2 ) ;
+    const double l3 = ( x - s1max ) * ( x - q3 ) ;
+    //
+    if ( jacobian ) 
+    {
+      // lambda ( s_2 , m_2^2 , m_3^2 ) 
+      const double l23 = ( y - s2min ) * ( y - q23 ) ;
+      jacobian [ i ] = in && 0 < l1 && 0 < l23 ? std::sqrt ( l1 * l23 ) / ( 2 * y ) : 0.0 ;
+    }
+    //
+    const double e1 = ss + m1s - y ;
+    const double e2 = ss + m2s - z ;
+    const double e3 = ss + m3s - x ;
+    //
+    if ( cos12 ) 
+    { cos12 [ i ] = 0 < l1 && 0 < l2 ? ( e1 * e2 + 2 * ss * ( m1s + m2s - x ) ) / std::sqrt ( l1 * l2 ) : -1.0 ; }
+    if ( cos23 ) 
+    { cos23 [ i ] = 0 < l2 && 0 < l3 ? ( e2 * e3 + 2 * ss * ( m2s + m3s - y ) ) / std::sqrt ( l2 * l3 ) : -1.0 ; }
+    if ( cos31 ) 
+    { cos31 [ i ] = 0 < l3 && 0 < l1 ? ( e3 * e1 + 2 * ss * ( m3s + m1s - z ) ) / std::sqrt ( l3 * l1 ) : -1.0 ; }
+  }
+  //
+  return ninside ;
+}
+// ============================================================================
 /** Dalitz density in 1-dimension:
  *  \f$  \frac{d R_3}{d_s2} = 
  *  \frac{\pi^2}{2ss_2}
@@ -4,6 +4,10 @@
 // ============================================================================
 #include <functional>
 #include <tuple>
+#include <vector>
+#include <thread>
+#include <exception>
+#include <algorithm>
 // ============================================================================
 // local
 // ============================================================================
@@ -18,6 +22,9 @@
 #include "local_math.h"
 #include "local_hash.h"
 #include "local_gsl.h"
+#include "local_mt.h"
+#include "local_tables.h"
+#include "Exception.h"
 // ============================================================================
 /** @file
  *  Implementation file for the class Ostap::Math::DalitzIntegrator
@@ -485,6 +492,210 @@ double Ostap::Math::DalitzIntegrator::integrate_e2e3
   return integrate_s1s2 ( std::cref ( fun ) , M * M , d , tag , n1 , n2 ) ;
 }
 // ============================================================================
+// Precomputed integration rule for the Dalitz plot
+// ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /// minimal number of nodes per thread 
+  const std::size_t s_MINNODES = 1024 ;
+  // ==========================================================================
+}
+// ============================================================================
+/*  constructor from Dalitz configuration and s 
+ *  @param d  Dalitz configuration 
+ *  @param s  \f$ s = M^2 \f$ 
+ *  @param n1 number of Gauss-Legendre points for \f$ x_1 \f$ 
+ *  @param n2 number of Gauss-Legendre points for \f$ x_2 \f$ 
+ */
+// ============================================================================
+Ostap::Math::DalitzRule::DalitzRule 
+( const Ostap::Kinematics::Dalitz0& d  , 
+  const double                      s  ,
+  const unsigned short              n1 , 
+  const unsigned short              n2 ) 
+  : m_s  ( s  ) 
+  , m_n1 ( n1 ) 
+  , m_n2 ( n2 ) 
+{
+  build ( d ) ;
+}
+// ============================================================================
+/*  constructor from Dalitz configuration 
+ *  @param d  Dalitz configuration 
+ *  @param n1 number of Gauss-Legendre points for \f$ x_1 \f$ 
+ *  @param n2 number of Gauss-Legendre points for \f$ x_2 \f$ 
+ */
+// ============================================================================
+Ostap::Math::DalitzRule::DalitzRule 
+( const Ostap::Kinematics::Dalitz&  d  , 
+  const unsigned short              n1 , 
+  const unsigned short              n2 ) 
+  : m_s  ( d.s () ) 
+  , m_n1 ( n1     ) 
+  , m_n2 ( n2     ) 
+{
+  build ( d ) ;
+  //
+  const std::size_t N = m_w.size () ;
+  m_e2.resize ( N ) ;
+  m_e3.resize ( N ) ;
+  for ( std::size_t i = 0 ; i < N ; ++i ) 
+  {
+    m_e2 [ i ] = d.E2 ( m_s1 [ i ] , m_s2 [ i ] ) ;
+    m_e3 [ i ] = d.E3 ( m_s1 [ i ] , m_s2 [ i ] ) ;
+  }
+}
+// ============================================================================
+// build the rule 
+// ============================================================================
+void Ostap::Math::DalitzRule::build ( const Ostap::Kinematics::Dalitz0& d ) 
+{
+  Ostap::Assert ( 0 < m_n1 && 0 < m_n2                     , 
+                  "Invalid number of points"               , 
+                  "Ostap::Math::DalitzRule"                ) ;
+  //
+  if ( m_s <= d.sqsumm () ) { return ; }
+  //
+  const double M      = std::sqrt ( m_s ) ;
+  const double x2_min = d.s2_min (   ) ;
+  const double x2_max = d.s2_max ( M ) ;
+  const double h2     = 0.5 * ( x2_max - x2_min ) ;
+  const double c2     = 0.5 * ( x2_max + x2_min ) ;
+  //
+  const Ostap::Math::Tables::GaussLegendre& gl1 = Ostap::Math::Tables::gauss_legendre ( m_n1 ) ;
+  const Ostap::Math::Tables::GaussLegendre& gl2 = Ostap::Math::Tables::gauss_legendre ( m_n2 ) ;
+  const std::vector<double>& x1 = gl1.x ;
+  const std::vector<double>& w1 = gl1.w ;
+  const std::vector<double>& x2 = gl2.x ;
+  const std::vector<double>& w2 = gl2.w ;
+  //
+  const std::size_t N = std::size_t ( m_n1 ) * m_n2 ;
+  m_s1.reserve ( N ) ;
+  m_s2.reserve ( N ) ;
+  m_w .reserve ( N ) ;
+  //
+  for ( unsigned short i2 = 0 ; i2 < m_n2 ; ++i2 ) 
+  {
+    const double y2 = c2 + h2 * x2 [ i2 ] ;
+    for ( unsigned short i1 = 0 ; i1 < m_n1 ; ++i1 ) 
+    {
+      double s1 , s2 ;
+      std::tie ( s1 , s2 ) = d.x2s ( m_s , x1 [ i1 ] , y2 ) ;
+      const double J = d.J ( m_s , s1 , s2 ) ;
+      if ( J <= 0 ) { continue ; }                     // skip trivial nodes 
+      m_s1.push_back ( s1 ) ;
+      m_s2.push_back ( s2 ) ;
+      m_w .push_back ( w1 [ i1 ] * w2 [ i2 ] * h2 * J ) ;
+    }
+  }
+}
+// ============================================================================
+// weighted sum of the function values at the nodes 
+// ============================================================================
+double Ostap::Math::DalitzRule::sum ( const double* values ) const 
+{
+  if ( nullptr == values ) { return 0 ; }
+  const std::size_t N = m_w.size () ;
+  long double result  = 0 ;
+  for ( std::size_t i = 0 ; i < N ; ++i ) { result += m_w [ i ] * values [ i ] ; }
+  return result ;
+}
+// ============================================================================
+// weighted sum of the function values, large rules are split between threads 
+// ============================================================================
+double Ostap::Math::DalitzRule::wsum 
+( const std::vector<double>& x1       , 
+  const std::vector<double>& x2       , 
+  Ostap::Math::DalitzRule::function2 f2 , 
+  const unsigned int         nthreads ) const 
+{
+  const std::size_t N  = m_w.size () ;
+  const std::size_t nt = std::min<std::size_t> 
+    ( std::max<std::size_t> ( 1 , N / s_MINNODES ) , 
+      1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ;
+  //
+  auto ff = std::cref ( f2 ) ;
+  auto partial = [this,&x1,&x2,ff] ( const std::size_t first , 
+                                     const std::size_t last  ) -> long double 
+    {
+      long double r = 0 ;
+      for ( std::size_t i = first ; i < last ; ++i ) 
+      { r += m_w [ i ] * ff ( x1 [ i ] , x2 [ i ] ) ; }
+      return r ;
+    } ;
+  //
+  if ( nt <= 1 ) { return partial ( 0 , N ) ; }
+  //
+  const std::size_t size = ( N + nt - 1 ) / nt ;
+  std::vector<long double>        results ( nt , 0.0L ) ;
+  std::vector<std::exception_ptr> errors  ( nt ) ;
+  std::vector<std::thread>        threads ;
+  threads.reserve ( nt ) ;
+  for ( std::size_t t = 1 ; t < nt ; ++t ) 
+  {
+    const std::size_t first = std::min ( N , t * size     ) ;
+    const std::size_t last  = std::min ( N , first + size ) ;
+    if ( last <= first ) { break ; }
+    threads.emplace_back ( [&partial,&results,&errors,first,last,t] ()
+                           {
+                             try { results [ t ] = partial ( first , last ) ; }
+                             catch ( ... ) { errors [ t ] = std::current_exception () ; }
+                           } ) ;
+  }
+  // the first chunk is processed by this thread 
+  try { results [ 0 ] = partial ( 0 , std::min ( N , size ) ) ; }
+  catch ( ... ) { errors [ 0 ] = std::current_exception () ; }
+  //
+  for ( auto& t : threads ) { t.join () ; }
+  for ( const auto& e : errors ) { if ( e ) { std::rethrow_exception ( e ) ; } }
+  //
+  // combine the partial sums in the fixed order 
+  long double result = 0 ;
+  for ( const long double r : results ) { result += r ; }
+  return result ;
+}
+// ============================================================================
+/*  integrate the function \f$ f(s_1,s_2) \f$ over the Dalitz plot 
+ *  @param f2       the function \f$ f(s_1,s_2) \f$ 
+ *  @param nthreads number of threads
+ */
+// ============================================================================
+double Ostap::Math::DalitzRule::integrate 
+( Ostap::Math::DalitzRule::function2 f2       , 
+  const unsigned int                 nthreads ) const 
+{ return wsum ( m_s1 , m_s2 , std::cref ( f2 ) , nthreads ) ; }
+// ============================================================================
+/*  integrate the function \f$ f(s,s_1,s_2) \f$ over the Dalitz plot 
+ *  @param f3       the function \f$ f(s,s_1,s_2) \f$ 
+ *  @param nthreads number of threads
+ */
+// ============================================================================
+double Ostap::Math::DalitzRule::integrate 
+( Ostap::Math::DalitzRule::function3 f3       , 
+  const unsigned int                 nthreads ) const 
+{
+  auto      f1 = std::cref ( f3 ) ;
+  function2 f2 = std::bind ( f1 , m_s , std::placeholders::_1 , std::placeholders::_2 ) ;
+  return wsum ( m_s1 , m_s2 , std::cref ( f2 ) , nthreads ) ;
+}
+// ============================================================================
+/*  integrate the function \f$ f(e_2,e_3) \f$ over the Dalitz plot 
+ *  @param f2       the function \f$ f(e_2,e_3) \f$ 
+ *  @param nthreads number of threads
+ */
+// ============================================================================
+double Ostap::Math::DalitzRule::integrate_e2e3
+( Ostap::Math::DalitzRule::function2 f2       , 
+  const unsigned int                 nthreads ) const 
+{
+  Ostap::Assert ( m_e2.size () == m_w.size ()                , 
+                  "The rule is not built from Dalitz object" , 
+                  "Ostap::Math::DalitzRule"                  ) ;
+  const double J = 0.25 / m_s ; // jacobian 
+  return J * wsum ( m_e2 , m_e3 , std::cref ( f2 ) , nthreads ) ;
+}
+// ============================================================================
 //                                                                      The END 
 // ============================================================================
 
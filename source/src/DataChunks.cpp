@@ -0,0 +1,187 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <memory>
+#include <algorithm>
+// ============================================================================
+// ROOT&RooFit
+// ============================================================================
+#include "RVersion.h"
+#include "RooAbsData.h"
+#include "RooArgSet.h"
+#include "RooDataSet.h"
+#include "RooVectorDataStore.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/DataChunks.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Utils::DataChunks
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  static const char s_TAG [] = "Ostap::Utils::DataChunks" ;
+  // ==========================================================================
+  /// the column arrays are accessible?
+  inline bool _columns_ ( const RooAbsData* data )
+  {
+    return nullptr != dynamic_cast<const RooDataSet*>         ( data          )
+      &&   nullptr != dynamic_cast<const RooVectorDataStore*> ( data->store () ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// view of the partial datasets
+// ============================================================================
+Ostap::Utils::DataChunks::DataChunks
+( const std::vector<const RooAbsData*>& chunks )
+{
+  m_chunks .reserve ( chunks.size ()     ) ;
+  m_offsets.reserve ( chunks.size () + 1 ) ;
+  for ( const RooAbsData* c : chunks ) { add ( c ) ; }
+}
+// ============================================================================
+// add the partial dataset (no copy)
+// ============================================================================
+std::size_t Ostap::Utils::DataChunks::add ( const RooAbsData* chunk )
+{
+  Ostap::Assert ( nullptr != chunk && nullptr != chunk->get () ,
+                  "Invalid chunk"                              , s_TAG ) ;
+  if ( !m_chunks.empty () )
+  {
+    const RooAbsData* first = m_chunks.front () ;
+    Ostap::Assert ( chunk->get ()->equals ( *first->get () )   ,
+                    "Chunk with different variables"           , s_TAG ) ;
+    Ostap::Assert ( chunk->isWeighted () == m_weighted         ,
+                    "Weighted and non-weighted chunks"         , s_TAG ) ;
+  }
+  else { m_weighted = chunk->isWeighted () ; }
+  //
+  m_chunks .push_back ( chunk ) ;
+  m_offsets.push_back ( m_offsets.back () + chunk->numEntries () ) ;
+  return m_chunks.size () ;
+}
+// ============================================================================
+// locate the entry
+// ============================================================================
+std::pair<std::size_t,std::size_t>
+Ostap::Utils::DataChunks::locate ( const std::size_t entry ) const
+{
+  if ( size () <= entry ) { return std::make_pair ( nChunks () , entry ) ; }
+  // the last chunk with offset <= entry
+  const auto found = std::upper_bound ( m_offsets.begin () , m_offsets.end () , entry ) ;
+  const std::size_t index = ( found - m_offsets.begin () ) - 1 ;
+  return std::make_pair ( index , entry - m_offsets [ index ] ) ;
+}
+// ============================================================================
+// load the entry
+// ============================================================================
+const RooArgSet* Ostap::Utils::DataChunks::get ( const std::size_t entry ) const
+{
+  const auto where = locate ( entry ) ;
+  if ( nChunks () <= where.first ) { return nullptr ; }
+  m_current = where.first ;
+  return m_chunks [ m_current ]->get ( where.second ) ;
+}
+// ============================================================================
+// the weight of the last loaded entry
+// ============================================================================
+double Ostap::Utils::DataChunks::weight () const
+{ return m_current < m_chunks.size () ? m_chunks [ m_current ]->weight () : 1.0 ; }
+// ============================================================================
+// the batch spans for the variable
+// ============================================================================
+Ostap::Utils::DataChunks::Spans
+Ostap::Utils::DataChunks::spans ( const std::string& name ) const
+{
+  Spans result ;
+#if ROOT_VERSION(6,26,0) <= ROOT_VERSION_CODE
+  result.reserve ( m_chunks.size () ) ;
+  for ( const RooAbsData* c : m_chunks )
+  {
+    if ( !_columns_ ( c ) ) { return Spans () ; }                    // RETURN
+    const RooAbsArg* var = c->get ()->find ( name.c_str () ) ;
+    if ( nullptr == var   ) { return Spans () ; }                    // RETURN
+    const std::size_t n     = c->numEntries () ;
+    const auto        spans = c->getBatches ( 0 , n ) ;
+    const auto        found = spans.find ( var ) ;
+    if ( spans.end () == found || found->second.size () < n ) { return Spans () ; }
+    result.emplace_back ( found->second.data () , n ) ;
+  }
+#endif
+  return result ;
+}
+// ============================================================================
+// the batch spans for the weights
+// ============================================================================
+Ostap::Utils::DataChunks::Spans
+Ostap::Utils::DataChunks::weights () const
+{
+  Spans result ;
+  if ( !m_weighted ) { return result ; }                             // RETURN
+#if ROOT_VERSION(6,26,0) <= ROOT_VERSION_CODE
+  result.reserve ( m_chunks.size () ) ;
+  for ( const RooAbsData* c : m_chunks )
+  {
+    if ( !_columns_ ( c ) ) { return Spans () ; }                    // RETURN
+    const std::size_t n  = c->numEntries () ;
+    const auto        ws = c->getWeightBatch ( 0 , n ) ;
+    if ( ws.size () < n   ) { return Spans () ; }                    // RETURN
+    result.emplace_back ( ws.data () , n ) ;
+  }
+#endif
+  return result ;
+}
+// ============================================================================
+// materialize: the one-shot concatenation of the chunks
+// ============================================================================
+RooDataSet* Ostap::Utils::DataChunks::concatenate
+( const std::string& name  ,
+  const std::string& title ) const
+{
+  Ostap::Assert ( !m_chunks.empty ()  , "No chunks to concatenate" , s_TAG ) ;
+  const RooAbsData* first = m_chunks.front () ;
+  //
+  const std::string n = name .empty () ? first->GetName  () : name  ;
+  const std::string t = title.empty () ? first->GetTitle () : title ;
+  std::unique_ptr<RooAbsData> cloned { first->emptyClone ( n.c_str () , t.c_str () ) } ;
+  RooDataSet* result = dynamic_cast<RooDataSet*> ( cloned.get () ) ;
+  Ostap::Assert ( nullptr != result   , "Chunk is not RooDataSet"  , s_TAG ) ;
+  //
+  // preallocate the final store exactly:
+  // the subsequent appends do not reallocate it
+  RooVectorDataStore* store = dynamic_cast<RooVectorDataStore*> ( result->store () ) ;
+  if ( nullptr != store ) { store->reserve ( size () ) ; }
+  //
+  for ( const RooAbsData* c : m_chunks )
+  {
+    const RooDataSet* ds = dynamic_cast<const RooDataSet*> ( c ) ;
+    Ostap::Assert ( nullptr != ds     , "Chunk is not RooDataSet"  , s_TAG ) ;
+    result->append ( const_cast<RooDataSet&> ( *ds ) ) ;
+  }
+  //
+  cloned.release () ;
+  return result ;
+}
+// ============================================================================
+// one-shot concatenation of the partial datasets
+// ============================================================================
+RooDataSet* Ostap::Utils::concatenate
+( const std::vector<const RooAbsData*>& chunks ,
+  const std::string&                    name   ,
+  const std::string&                    title  )
+{ return DataChunks ( chunks ).concatenate ( name , title ) ; }
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,626 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+// ============================================================================
+// ROOT&RooFit 
+// ============================================================================
+#include "TTree.h"
+#include "TH1.h"
+#include "TAxis.h"
+#include "RooAbsReal.h"
+#include "RooAbsData.h"
+#include "RooRealVar.h"
+#include "RooArgSet.h"
+#include "RooArgList.h"
+#include "RooDataSet.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/DataColumns.h"
+#include "Ostap/Formula.h"
+#include "Ostap/Notifier.h"
+#include "Ostap/RandomStream.h"
+#include "Ostap/Instrument.h"
+#include "Ostap/MemoryBudget.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+#include "local_columns.h"
+// ============================================================================
+/** @file
+ *  Implementation file for functions from file Ostap/DataColumns.h
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-01-30
+ */
+namespace 
+{
+  // ==========================================================================
+  /// get the variables of the dataset in the order of columns 
+  std::vector<RooRealVar*> _columns_ 
+  ( RooDataSet&       dataset , 
+    const RooArgList& vars    , 
+    const char*       tag     ) 
+  {
+    const RooArgSet* dvars = dataset.get () ;
+    Ostap::Assert ( nullptr != dvars                              , 
+                    "Invalid dataset"                             , 
+                    tag                                           ) ;
+    std::vector<RooRealVar*> columns ; 
+    columns.reserve ( vars.getSize () ) ;
+    for ( int i = 0 ; i < vars.getSize () ; ++i ) 
+    {
+      const RooAbsArg* a = vars.at ( i ) ;
+      RooRealVar*      v = nullptr == a ? nullptr : 
+        dynamic_cast<RooRealVar*> ( dvars->find ( a->GetName () ) ) ;
+      Ostap::Assert ( nullptr != v                                , 
+                      "Variable is not RooRealVar from dataset"   , 
+                      tag                                         ) ;
+      columns.push_back ( v ) ;
+    }
+    return columns ;
+  }
+  // ==========================================================================
+  /** the number of the buffer slots (the prefetch depth) for 
+   *  Ostap::Utils::process_ordered, that fit into the memory budget
+   *  @param chunks  the chunks 
+   *  @param ncols   number of columns 
+   *  @param nt      number of threads 
+   *  @return number of slots, <code>1<=result<=2*nt</code>
+   *  @see Ostap::Utils::memory_budget 
+   */
+  std::size_t budget_slots 
+  ( const Ostap::Utils::Chunks& chunks , 
+    const std::size_t           ncols  , 
+    const unsigned int          nt     ) 
+  {
+    unsigned long longest = 0 ;
+    for ( const auto& c : chunks ) { longest = std::max ( longest , c.size () ) ; }
+    const std::size_t bytes = sizeof ( double ) * ( longest * ncols + 3 ) ;
+    return std::max ( std::size_t ( 1 ) , Ostap::Utils::copies_in_budget ( bytes , 2 * nt ) ) ;
+  }
+  // ==========================================================================
+  /** @class FillWorker
+   *  Thread-local worker for Ostap::Utils::fill_datasetMT
+   *  and Ostap::Utils::read_columns:
+   *  evaluate the selection and the variables for the chunk, 
+   *  and fill the buffer with the accepted rows, followed by 
+   *  the counters (total, processed, skipped) 
+   *  (no range check for empty ranges)
+   *  @see Ostap::Utils::process_ordered 
+   */
+  class FillWorker 
+  {
+  public:
+    // ========================================================================
+    FillWorker ( TTree*                          tree        , 
+                 const std::vector<std::string>& expressions , 
+                 const std::string&              selection   , 
+                 const std::vector<double>&      vmin        , 
+                 const std::vector<double>&      vmax        ) 
+      : m_tree ( tree ) 
+      , m_vmin ( vmin ) 
+      , m_vmax ( vmax ) 
+      , m_row  ( expressions.size () ) 
+    {
+      for ( const auto& e : expressions ) 
+      {
+        m_formulas.emplace_back ( std::make_unique<Ostap::Formula> ( e , tree ) ) ;
+        Ostap::Assert ( m_formulas.back()->ok ()         , 
+                        "Invalid formula:\"" + e + "\"" , 
+                        "Ostap::Utils::fill_datasetMT"   ) ;
+      }
+      if ( !selection.empty () ) 
+      {
+        m_cuts = std::make_unique<Ostap::Formula> ( selection , tree ) ;
+        Ostap::Assert ( m_cuts->ok ()                             , 
+                        "Invalid selection:\"" + selection + "\"" , 
+                        "Ostap::Utils::fill_datasetMT"            ) ;
+      }
+      m_notifier = std::make_unique<Ostap::Utils::Notifier> 
+        ( m_formulas.begin() , m_formulas.end() , m_cuts.get() , tree ) ;
+    }
+    // ========================================================================
+    void operator() ( const Ostap::Utils::Chunk& chunk , 
+                      std::vector<double>&       data  ) 
+    {
+      data.clear () ;
+      const std::size_t N = m_formulas.size () ;
+      unsigned long total     = 0 ;
+      unsigned long processed = 0 ;
+      unsigned long skipped   = 0 ;
+      for ( unsigned long entry = chunk.first ; entry < chunk.last ; ++entry ) 
+      {
+        Long64_t ievent = m_tree->GetEntryNumber ( entry ) ;
+        if ( 0 > ievent ) { break ; }                              // BREAK 
+        ievent          = m_tree->LoadTree       ( ievent ) ;
+        if ( 0 > ievent ) { break ; }                              // BREAK 
+        //
+        ++total ;
+        if ( m_cuts && !m_cuts->evaluate () ) { continue ; }      // CONTINUE 
+        ++processed ;
+        //
+        bool ok = true ;
+        for ( std::size_t k = 0 ; k < N && ok ; ++k ) 
+        {
+          const double value = m_formulas [ k ]->evaluate () ;
+          ok = m_vmin.empty () || ( m_vmin [ k ] <= value && value <= m_vmax [ k ] ) ; // MUST BE IN RANGE! 
+          m_row [ k ] = value ;
+        }
+        if ( !ok ) { ++skipped ; continue ; }                      // CONTINUE 
+        data.insert ( data.end () , m_row.begin () , m_row.end () ) ;
+      }
+      // the counters are appended to the rows 
+      data.push_back ( total     ) ;
+      data.push_back ( processed ) ;
+      data.push_back ( skipped   ) ;
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the tree (thread copy) 
+    TTree*                                       m_tree     { nullptr } ;
+    /// the ranges 
+    std::vector<double>                          m_vmin     {} ;
+    std::vector<double>                          m_vmax     {} ;
+    /// the current row 
+    std::vector<double>                          m_row      {} ;
+    /// formulas 
+    std::vector<std::unique_ptr<Ostap::Formula>> m_formulas {} ;
+    /// selection 
+    std::unique_ptr<Ostap::Formula>              m_cuts     {} ;
+    /// notifier (destroyed before formulas)
+    std::unique_ptr<Ostap::Utils::Notifier>      m_notifier {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /// read the columns into the buffer (single pass)
+  template <class TYPE>
+  unsigned long _read_columns_ 
+  ( TTree*                          tree        ,
+    const std::vector<std::string>& expressions , 
+    const std::string&              selection   , 
+    TYPE*                           data        , 
+    const unsigned long             capacity    , 
+    const unsigned long             first       , 
+    const unsigned long             last        , 
+    const unsigned int              nthreads    ) 
+  {
+    static const char s_tag [] = "Ostap::Utils::read_columns" ;
+    Ostap::Assert ( nullptr != tree , "Invalid tree" , s_tag ) ;
+    const std::size_t N = expressions.size () ;
+    if ( 0 == N ) { return 0 ; }                                  // RETURN
+    Ostap::Assert ( nullptr != data || 0 == capacity , "Invalid buffer" , s_tag ) ;
+    //
+    const unsigned long nentries = std::min ( last , (unsigned long) tree->GetEntries () ) ;
+    if ( nentries <= first ) { return 0 ; }                       // RETURN
+    //
+    // validate the formulas using the original tree 
+    if ( !selection.empty () ) 
+    {
+      Ostap::Assert ( Ostap::Formula ( selection , tree ).ok ()   ,
+                      "Invalid selection:\"" + selection + "\"" , s_tag ) ;
+    }
+    for ( const auto& e : expressions ) 
+    {
+      Ostap::Assert ( Ostap::Formula ( e , tree ).ok ()           ,
+                      "Invalid formula:\"" + e + "\""            , s_tag ) ;
+    }
+    //
+    // the writer: transpose the rows into the columns (in the calling thread) 
+    unsigned long rows = 0 ;
+    auto writer = [&] ( const Ostap::Utils::Chunk& /* chunk */ , const std::vector<double>& buffer ) 
+      {
+        const std::size_t size = buffer.size () - 3 ;
+        Ostap::Assert ( rows + size / N <= capacity , "Buffer overflow" , s_tag ) ;
+        for ( std::size_t i = 0 ; i + N <= size ; i += N , ++rows )
+        { for ( std::size_t k = 0 ; k < N ; ++k ) { data [ k * capacity + rows ] = buffer [ i + k ] ; } }
+      } ;
+    //
+    const std::vector<double> norange {} ;
+    const unsigned int nt = 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ;
+    if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) ) 
+    {
+      FillWorker          worker ( tree , expressions , selection , norange , norange ) ;
+      std::vector<double> buffer ;
+      // process by chunks of 1M entries to keep the buffer size under control 
+      for ( unsigned long start = first ; start < nentries ; start += ( 1ul << 20 ) ) 
+      {
+        const Ostap::Utils::Chunk chunk ( start , std::min ( nentries , start + ( 1ul << 20 ) ) ) ;
+        worker ( chunk , buffer ) ;
+        writer ( chunk , buffer ) ;
+      }
+      return rows ;                                               // RETURN 
+    }
+    //
+    // split into chunks: aligned with the clusters, at most 1M entries per chunk 
+    const unsigned int  nchunks = std::max ( 4 * nt , (unsigned int) ( ( nentries - first ) >> 20 ) + 1 ) ;
+    const Ostap::Utils::Chunks chunks = Ostap::Utils::clusters ( tree , first , nentries , nchunks ) ;
+    //
+    OSTAP_MEMORY_STAGE ( "DataColumns::read" ) ;
+    Ostap::Utils::process_ordered 
+      ( tree , chunks , nt , 
+        [&expressions,&selection,&norange] ( TTree* t ) 
+        { return FillWorker ( t , expressions , selection , norange , norange ) ; } , 
+        writer , budget_slots ( chunks , N , nt ) ) ;
+    //
+    return rows ;
+  }
+  // ==========================================================================
+  /** the block size for the accept/reject unweighting: 
+   *  the blocks do not depend on the number of threads, 
+   *  that makes the result reproducible 
+   */
+  constexpr unsigned long s_UNWEIGHT_BLOCK = 1ul << 16 ;
+  // ==========================================================================
+}
+// ============================================================================
+/*  fill the dataset from the contiguous columns 
+ *  @param dataset (UPDATE) dataset to be filled 
+ *  @param vars    (INPUT)  the variables (RooRealVar) in the order of columns
+ *  @param n       (INPUT)  number of entries 
+ *  @param data    (INPUT)  the columns 
+ *  @param weights (INPUT)  the weights (if not null)
+ *  @return number of added entries 
+ */
+// ============================================================================
+unsigned long Ostap::Utils::fill_dataset 
+( RooDataSet&         dataset , 
+  const RooArgList&   vars    , 
+  const unsigned long n       , 
+  const double*       data    , 
+  const double*       weights ) 
+{
+  if ( 0 == n ) { return 0 ; }
+  Ostap::Assert ( nullptr != data                               , 
+                  "Invalid data"                                , 
+                  "Ostap::Utils::fill_dataset"                  ) ;
+  //
+  const RooArgSet*         dvars   = dataset.get () ;
+  std::vector<RooRealVar*> columns = _columns_ ( dataset , vars , "Ostap::Utils::fill_dataset" ) ;
+  //
+  const std::size_t nc = columns.size () ;
+  for ( unsigned long j = 0 ; j < n ; ++j ) 
+  {
+    for ( std::size_t i = 0 ; i < nc ; ++i ) 
+    { columns [ i ]->setVal ( data [ i * n + j ] ) ; }
+    //
+    if ( nullptr != weights ) { dataset.add ( *dvars , weights [ j ] ) ; }
+    else                      { dataset.add ( *dvars                 ) ; }
+  }
+  //
+  return n ;
+}
+// ============================================================================
+/*  fill the dataset from TTree/TChain using several threads
+ *  @param tree        (INPUT)  the tree/chain 
+ *  @param dataset     (UPDATE) dataset to be filled 
+ *  @param vars        (INPUT)  the variables (RooRealVar) of the dataset 
+ *  @param expressions (INPUT)  expressions for the variables 
+ *  @param selection   (INPUT)  the selection 
+ *  @param nthreads    (INPUT)  number of threads 
+ *  @param first       (INPUT)  the first entry to process 
+ *  @param last        (INPUT)  the last entry to process 
+ *  @return statistics of the filling 
+ */
+// ============================================================================
+Ostap::Utils::FillStat 
+Ostap::Utils::fill_datasetMT
+( TTree*                          tree        ,
+  RooDataSet&                     dataset     , 
+  const RooArgList&               vars        , 
+  const std::vector<std::string>& expressions , 
+  const std::string&              selection   , 
+  const unsigned int              nthreads    , 
+  const unsigned long             first       , 
+  const unsigned long             last        ) 
+{
+  static const char s_tag [] = "Ostap::Utils::fill_datasetMT" ;
+  Ostap::Assert ( nullptr != tree                               , 
+                  "Invalid tree"                                , s_tag ) ;
+  Ostap::Assert ( std::size_t ( vars.getSize () ) == expressions.size () , 
+                  "Mismatch variables/expressions"              , s_tag ) ;
+  //
+  const RooArgSet*         dvars   = dataset.get () ;
+  std::vector<RooRealVar*> columns = _columns_ ( dataset , vars , s_tag ) ;
+  const std::size_t        N       = columns.size () ;
+  std::vector<double>      vmin ( N ) ;
+  std::vector<double>      vmax ( N ) ;
+  for ( std::size_t k = 0 ; k < N ; ++k ) 
+  {
+    vmin [ k ] = columns [ k ]->getMin () ;
+    vmax [ k ] = columns [ k ]->getMax () ;
+  }
+  //
+  FillStat stat {} ;
+  const unsigned long nentries = std::min ( last , (unsigned long) tree->GetEntries () ) ;
+  if ( nentries <= first ) { return stat ; }                      // RETURN
+  //
+  // validate the formulas using the original tree 
+  if ( !selection.empty () ) 
+  {
+    Ostap::Assert ( Ostap::Formula ( selection , tree ).ok ()   ,
+                    "Invalid selection:\"" + selection + "\"" , s_tag ) ;
+  }
+  for ( const auto& e : expressions ) 
+  {
+    Ostap::Assert ( Ostap::Formula ( e , tree ).ok ()           ,
+                    "Invalid formula:\"" + e + "\""            , s_tag ) ;
+  }
+  //
+  // the writer: append the rows to the dataset (in the calling thread) 
+  auto writer = [&] ( const Ostap::Utils::Chunk& /* chunk */ , const std::vector<double>& data ) 
+    {
+      const std::size_t size = data.size () - 3 ;
+      for ( std::size_t i = 0 ; i + N <= size ; i += N )
+      {
+        for ( std::size_t k = 0 ; k < N ; ++k ) { columns [ k ]->setVal ( data [ i + k ] ) ; }
+        dataset.add ( *dvars ) ;
+      }
+      stat.total     += (unsigned long) data [ size     ] ;
+      stat.processed += (unsigned long) data [ size + 1 ] ;
+      stat.skipped   += (unsigned long) data [ size + 2 ] ;
+    } ;
+  //
+  const unsigned int nt = 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) ) 
+  {
+    FillWorker          worker ( tree , expressions , selection , vmin , vmax ) ;
+    std::vector<double> data   ;
+    // process by chunks of 1M entries to keep the buffer size under control 
+    for ( unsigned long start = first ; start < nentries ; start += ( 1ul << 20 ) ) 
+    {
+      const Ostap::Utils::Chunk chunk ( start , std::min ( nentries , start + ( 1ul << 20 ) ) ) ;
+      worker ( chunk , data ) ;
+      writer ( chunk , data ) ;
+    }
+    return stat ;                                                 // RETURN 
+  }
+  //
+  // split into chunks: aligned with the clusters, at most 1M entries per chunk 
+  const unsigned int  nchunks = std::max ( 4 * nt , (unsigned int) ( ( nentries - first ) >> 20 ) + 1 ) ;
+  const Ostap::Utils::Chunks chunks = Ostap::Utils::clusters ( tree , first , nentries , nchunks ) ;
+  //
+  // workers: evaluate the formulas; writer: fill the dataset in order 
+  // (the number of the prefetched chunks is limited by the memory budget)
+  OSTAP_MEMORY_STAGE ( "DataColumns::fill" ) ;
+  Ostap::Utils::process_ordered 
+    ( tree , chunks , nt , 
+      [&expressions,&selection,&vmin,&vmax] ( TTree* t ) 
+      { return FillWorker ( t , expressions , selection , vmin , vmax ) ; } , 
+      writer , budget_slots ( chunks , N , nt ) ) ;
+  //
+  return stat ;
+}
+// ============================================================================
+/*  read the columns from TTree/TChain in a single pass 
+ *  @param tree        (INPUT)  the tree/chain 
+ *  @param expressions (INPUT)  expressions for the columns 
+ *  @param selection   (INPUT)  the selection 
+ *  @param data        (OUTPUT) the buffer of size <code>expressions.size()*capacity</code>
+ *  @param capacity    (INPUT)  maximal number of rows in the buffer 
+ *  @param first       (INPUT)  the first entry to process 
+ *  @param last        (INPUT)  the last entry to process 
+ *  @param nthreads    (INPUT)  number of threads 
+ *  @return number of rows written to the buffer 
+ */
+// ============================================================================
+unsigned long Ostap::Utils::read_columns
+( TTree*                          tree        ,
+  const std::vector<std::string>& expressions , 
+  const std::string&              selection   , 
+  double*                         data        , 
+  const unsigned long             capacity    , 
+  const unsigned long             first       , 
+  const unsigned long             last        , 
+  const unsigned int              nthreads    ) 
+{ return _read_columns_ ( tree , expressions , selection , data , capacity , first , last , nthreads ) ; }
+// ============================================================================
+unsigned long Ostap::Utils::read_columns
+( TTree*                          tree        ,
+  const std::vector<std::string>& expressions , 
+  const std::string&              selection   , 
+  float*                          data        , 
+  const unsigned long             capacity    , 
+  const unsigned long             first       , 
+  const unsigned long             last        , 
+  const unsigned int              nthreads    ) 
+{ return _read_columns_ ( tree , expressions , selection , data , capacity , first , last , nthreads ) ; }
+// ============================================================================
+/*  split the data into the bins in a single pass 
+ *  @param data    (INPUT)  the data 
+ *  @param bins    (UPDATE) the (empty) datasets for the bins 
+ *  @param binning (INPUT)  the binning histogram 
+ *  @param xvar    (INPUT)  the name of x-variable 
+ *  @param yvar    (INPUT)  the name of y-variable (for 2D and 3D binning) 
+ *  @param zvar    (INPUT)  the name of z-variable (for 3D binning) 
+ *  @return number of distributed entries 
+ */
+// ============================================================================
+unsigned long Ostap::Utils::split_dataset 
+( const RooAbsData&               data    , 
+  const std::vector<RooAbsData*>& bins    , 
+  const TH1&                      binning , 
+  const std::string&              xvar    , 
+  const std::string&              yvar    , 
+  const std::string&              zvar    ) 
+{
+  static const char s_tag [] = "Ostap::Utils::split_dataset" ;
+  //
+  const unsigned int dim = binning.GetDimension () ;
+  Ostap::Assert ( !xvar.empty () && ( dim < 2 || !yvar.empty () ) && ( dim < 3 || !zvar.empty () ) , 
+                  "Binning variables are not specified"      , s_tag ) ;
+  //
+  const TAxis* xaxis = binning.GetXaxis () ;
+  const TAxis* yaxis = 2 <= dim ? binning.GetYaxis () : nullptr ;
+  const TAxis* zaxis = 3 <= dim ? binning.GetZaxis () : nullptr ;
+  //
+  const int nx = xaxis->GetNbins () ;
+  const int ny = yaxis ? yaxis->GetNbins () : 1 ;
+  const int nz = zaxis ? zaxis->GetNbins () : 1 ;
+  Ostap::Assert ( bins.size () == std::size_t ( nx ) * ny * nz , 
+                  "Mismatch between binning and number of datasets" , s_tag ) ;
+  for ( const RooAbsData* b : bins ) 
+  { Ostap::Assert ( nullptr != b , "Invalid dataset for the bin" , s_tag ) ; }
+  //
+  const RooArgSet* row = data.get () ;
+  Ostap::Assert ( nullptr != row , "Invalid data" , s_tag ) ;
+  //
+  const RooAbsReal* x = dynamic_cast<const RooAbsReal*> ( row->find ( xvar.c_str () ) ) ;
+  const RooAbsReal* y = yaxis ? dynamic_cast<const RooAbsReal*> ( row->find ( yvar.c_str () ) ) : nullptr ;
+  const RooAbsReal* z = zaxis ? dynamic_cast<const RooAbsReal*> ( row->find ( zvar.c_str () ) ) : nullptr ;
+  Ostap::Assert ( nullptr != x && ( !yaxis || y ) && ( !zaxis || z ) , 
+                  "Binning variable is not in the data" , s_tag ) ;
+  //
+  const bool weighted = data.isWeighted () ;
+  //
+  unsigned long accepted = 0 ;
+  const unsigned long nentries = data.numEntries () ;
+  for ( unsigned long i = 0 ; i < nentries ; ++i ) 
+  {
+    row = data.get ( i ) ;
+    if ( nullptr == row ) { continue ; }
+    //
+    const int ix = xaxis->FindFixBin ( x->getVal () ) ;
+    if ( ix < 1 || nx < ix ) { continue ; }
+    const int iy = yaxis ? yaxis->FindFixBin ( y->getVal () ) : 1 ;
+    if ( iy < 1 || ny < iy ) { continue ; }
+    const int iz = zaxis ? zaxis->FindFixBin ( z->getVal () ) : 1 ;
+    if ( iz < 1 || nz < iz ) { continue ; }
+    //
+    RooAbsData* target = bins [ ( ix - 1 ) + nx * ( ( iy - 1 ) + ny * ( iz - 1 ) ) ] ;
+    if ( weighted ) { target->add ( *row , data.weight () , data.weightError ( RooAbsData::SumW2 ) ) ; }
+    else            { target->add ( *row ) ; }
+    ++accepted ;
+  }
+  //
+  return accepted ;
+}
+// ============================================================================
+/*  accept/reject (``hit-or-miss'') unweighting of the weighted dataset 
+ *  @param data       (INPUT)  the weighted dataset
+ *  @param unweighted (UPDATE) the non-weighted dataset to be filled 
+ *  @param seed       (INPUT)  the seed for the random streams 
+ *  @param nthreads   (INPUT)  number of threads 
+ *  @param wmax       (INPUT)  the maximal weight (non-positive: from data)
+ *  @return statistics of the unweighting 
+ */
+// ============================================================================
+Ostap::Utils::UnweightStat 
+Ostap::Utils::accept_reject 
+( const RooAbsData&   data       , 
+  RooDataSet&         unweighted , 
+  const std::uint64_t seed       , 
+  const unsigned int  nthreads   , 
+  const double        wmax       ) 
+{
+  static const char s_tag [] = "Ostap::Utils::accept_reject" ;
+  Ostap::Assert ( data.isWeighted ()                            , 
+                  "Dataset is not weighted"                     , s_tag ) ;
+  //
+  UnweightStat stat {} ;
+  const unsigned long n = data.numEntries () ;
+  stat.total = n ;
+  if ( 0 == n ) { return stat ; }                                 // RETURN 
+  //
+  // the weights: directly from the column store, if possible 
+  const DataColumns   columns ( data ) ;
+  std::vector<double> wbuffer {} ;
+  const double*       weights = columns.ok () ? columns.weights () : nullptr ;
+  if ( nullptr == weights ) 
+  {
+    wbuffer.resize ( n ) ;
+    for ( unsigned long i = 0 ; i < n ; ++i ) 
+    { data.get ( i ) ; wbuffer [ i ] = data.weight () ; }
+    weights = wbuffer.data () ;
+  }
+  //
+  // the maximal weight: single scan over the weight column 
+  const double wm = 0 < wmax ? wmax : *std::max_element ( weights , weights + n ) ;
+  Ostap::Assert ( 0 < wm , "Non-positive maximal weight" , s_tag ) ;
+  stat.wmax = wm ;
+  //
+  // the blocks & the accepted entries for each block 
+  const Ostap::Utils::Chunks blocks = Ostap::Utils::split 
+    ( 0 , n , ( n + s_UNWEIGHT_BLOCK - 1 ) / s_UNWEIGHT_BLOCK ) ;
+  const std::size_t NB = blocks.size () ;
+  std::vector<std::vector<unsigned long> > accepted ( NB ) ;
+  std::vector<unsigned long>               negative ( NB , 0 ) ;
+  std::vector<unsigned long>               overflow ( NB , 0 ) ;
+  //
+  auto block = [&] ( const std::size_t b ) 
+    {
+      const Ostap::Utils::Chunk& c = blocks [ b ] ;
+      // the own random stream for each block 
+      Ostap::Math::RandomStream rs ( seed , b ) ;
+      std::vector<double> u ( c.size () ) ;
+      rs.fill_uniform ( u.size () , u.data () , 0 , wm ) ;
+      //
+      std::vector<unsigned long>& acc = accepted [ b ] ;
+      for ( unsigned long i = c.first ; i < c.last ; ++i ) 
+      {
+        const double w = weights [ i ] ;
+        if ( w < 0  ) { ++negative [ b ] ; continue ; }
+        if ( wm < w ) { ++overflow [ b ] ; }
+        if ( u [ i - c.first ] < w ) { acc.push_back ( i ) ; }
+      }
+    } ;
+  //
+  const unsigned int nt = std::min<std::size_t> 
+    ( NB , 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ;
+  if ( nt <= 1 ) { for ( std::size_t b = 0 ; b < NB ; ++b ) { block ( b ) ; } }
+  else 
+  {
+    Ostap::Utils::WorkerPool pool ( nt ) ;
+    std::atomic<std::size_t> next { 0 } ;
+    pool.run ( [&] ( const unsigned int /* index */ ) 
+      { for ( std::size_t b = next++ ; b < NB ; b = next++ ) { block ( b ) ; } } ) ;
+  }
+  //
+  // the output variables: directly from the columns, if possible 
+  const RooArgSet* orow = unweighted.get () ;
+  Ostap::Assert ( nullptr != orow , "Invalid output dataset" , s_tag ) ;
+  std::vector<RooRealVar*>    ovars  ;
+  std::vector<const double*>  inputs ;
+  bool direct = columns.ok () ;
+  for ( RooAbsArg* a : *orow ) 
+  {
+    if ( !direct ) { break ; }
+    RooRealVar*   v = dynamic_cast<RooRealVar*> ( a ) ;
+    const double* c = nullptr == v ? nullptr : columns.column ( std::string ( a->GetName () ) ) ;
+    if ( nullptr == c ) { direct = false ; break ; }
+    ovars .push_back ( v ) ;
+    inputs.push_back ( c ) ;
+  }
+  //
+  // fill the output dataset in the original order 
+  const std::size_t nv = ovars.size () ;
+  for ( std::size_t b = 0 ; b < NB ; ++b ) 
+  {
+    for ( const unsigned long i : accepted [ b ] ) 
+    {
+      if ( direct ) 
+      {
+        for ( std::size_t k = 0 ; k < nv ; ++k ) { ovars [ k ]->setVal ( inputs [ k ] [ i ] ) ; }
+        unweighted.add ( *orow ) ;
+      }
+      else { unweighted.add ( *data.get ( i ) ) ; }
+    }
+    stat.accepted += accepted [ b ].size () ;
+    stat.negative += negative [ b ] ;
+    stat.overflow += overflow [ b ] ;
+  }
+  //
+  return stat ;
+}
+// ============================================================================
+//                                                                      The END 
+// ============================================================================
@@ -22,15 +22,22 @@
  *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
  */
 // ============================================================================
-// constructor 
+// get the number of slots for the actions 
 // ============================================================================
-ROOT::Detail::RDF::StatVar::StatVar ()
-  : m_result ( std::make_shared<Ostap::StatEntity>() ) 
+unsigned int Ostap::Actions::nSlots () 
+{
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
-  , m_N      ( ROOT::IsImplicitMTEnabled() ? std::max ( 1u , ROOT::GetThreadPoolSize     () ) : 1u )
+  return ROOT::IsImplicitMTEnabled() ? std::max ( 1u , ROOT::GetThreadPoolSize     () ) : 1u ;
 #else 
-  , m_N      ( ROOT::IsImplicitMTEnabled() ? std::max ( 1u , ROOT::GetImplicitMTPoolSize () ) : 1u )
+  return ROOT::IsImplicitMTEnabled() ? std::max ( 1u , ROOT::GetImplicitMTPoolSize () ) : 1u ;
 #endif
+}
+// ============================================================================
+// constructor 
+// ============================================================================
+ROOT::Detail::RDF::StatVar::StatVar ()
+  : m_result ( std::make_shared<Ostap::StatEntity>() ) 
+  , m_N      ( Ostap::Actions::nSlots () ) 
   , m_slots  ( this->m_N ) 
 {}
 // ============================================================================
@@ -38,20 +45,33 @@ ROOT::Detail::RDF::StatVar::StatVar ()
 // ============================================================================
 void ROOT::Detail::RDF::StatVar::Finalize() 
 { 
-  Result_t sum { m_slots [0] } ;
-  for ( unsigned int i = 1 ; i < m_N ; ++i ) { sum += m_slots [ i ] ; }
+  Result_t sum { m_slots [ 0 ].entity } ;
+  for ( unsigned int i = 1 ; i < m_N ; ++i ) { sum += m_slots [ i ].entity ; }
   *m_result = sum ;
 }
 // ============================================================================
 // constructor 
 // ============================================================================
+ROOT::Detail::RDF::CovVars::CovVars ( const unsigned short N )
+  : m_result ( std::make_shared<Result_t>( N ) ) 
+  , m_nvars  ( N ) 
+  , m_N      ( Ostap::Actions::nSlots () ) 
+  , m_slots  ( this->m_N , Ostap::Actions::Slot<Ostap::Math::CovariancesBuffer> ( Ostap::Math::CovariancesBuffer ( N ) ) ) 
+{}
+// ============================================================================
+// Finalize: flush the buffers and merge the per-slot counters 
+// ============================================================================
+void ROOT::Detail::RDF::CovVars::Finalize() 
+{ 
+  Result_t& result = *m_result ;
+  for ( unsigned int i = 0 ; i < m_N ; ++i ) { result += m_slots [ i ].entity.flush () ; }
+}
+// ============================================================================
+// constructor 
+// ============================================================================
 ROOT::Detail::RDF::WStatVar::WStatVar ()
   : m_result ( std::make_shared<Ostap::WStatEntity>() ) 
-#if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
-  , m_N      ( ROOT::IsImplicitMTEnabled() ? std::max ( 1u , ROOT::GetThreadPoolSize     () ) : 1u )
-#else 
-  , m_N      ( ROOT::IsImplicitMTEnabled() ? std::max ( 1u , ROOT::GetImplicitMTPoolSize () ) : 1u )
-#endif
+  , m_N      ( Ostap::Actions::nSlots () ) 
   , m_slots  ( this->m_N ) 
 {}
 // ============================================================================
@@ -59,8 +79,66 @@ ROOT::Detail::RDF::WStatVar::WStatVar ()
 // ============================================================================
 void ROOT::Detail::RDF::WStatVar::Finalize() 
 { 
-  Result_t sum { m_slots [0] } ;
-  for ( unsigned int i = 1 ; i < m_N ; ++i ) { sum += m_slots [ i ] ; }
+  Result_t sum { m_slots [ 0 ].entity } ;
+  for ( unsigned int i = 1 ; i < m_N ; ++i ) { sum += m_slots [ i ].entity ; }
+  *m_result = sum ;
+}
+// ============================================================================
+// constructor 
+// ============================================================================
+ROOT::Detail::RDF::P2QuantileVar::P2QuantileVar ( const double p )
+  : m_result ( std::make_shared<double>( 0 ) ) 
+  , m_N      ( Ostap::Actions::nSlots () ) 
+  , m_slots  ( this->m_N , Ostap::Actions::Slot<Ostap::Math::GSL::P2Quantile> ( Ostap::Math::GSL::P2Quantile ( p ) ) ) 
+{}
+// ============================================================================
+// Finalize: combine the per-slot estimates 
+// ============================================================================
+void ROOT::Detail::RDF::P2QuantileVar::Finalize() 
+{ 
+  long double   sum = 0 ;
+  unsigned long num = 0 ;
+  for ( unsigned int i = 0 ; i < m_N ; ++i ) 
+  {
+    const Ostap::Math::GSL::P2Quantile& q = m_slots [ i ].entity ;
+    const unsigned long n = q.n () ;
+    if ( 0 == n ) { continue ; }
+    sum += 1.0L * n * q.value () ;
+    num += n ;
+  }
+  *m_result = 0 < num ? double ( sum / num ) : 0.0 ;
+}
+// ============================================================================
+// constructor 
+// ============================================================================
+ROOT::Detail::RDF::TDigestVar::TDigestVar ( const unsigned int compression )
+  : m_result ( std::make_shared<Result_t>( compression ) ) 
+  , m_N      ( Ostap::Actions::nSlots () ) 
+  , m_slots  ( this->m_N , Ostap::Actions::Slot<Result_t> ( Result_t ( compression ) ) ) 
+{}
+// ============================================================================
+// Finalize: merge the per-slot sketches 
+// ============================================================================
+void ROOT::Detail::RDF::TDigestVar::Finalize() 
+{ 
+  Result_t& result = *m_result ;
+  for ( unsigned int i = 0 ; i < m_N ; ++i ) { result += m_slots [ i ].entity ; }
+}
+// ============================================================================
+// constructor 
+// ============================================================================
+ROOT::Detail::RDF::CovVar::CovVar ()
+  : m_result ( std::make_shared<Ostap::Math::Covariance>() ) 
+  , m_N      ( Ostap::Actions::nSlots () ) 
+  , m_slots  ( this->m_N ) 
+{}
+// ============================================================================
+// Finalize 
+// ============================================================================
+void ROOT::Detail::RDF::CovVar::Finalize() 
+{ 
+  Result_t sum { m_slots [ 0 ].entity } ;
+  for ( unsigned int i = 1 ; i < m_N ; ++i ) { sum += m_slots [ i ].entity ; }
   *m_result = sum ;
 }
 // ============================================================================
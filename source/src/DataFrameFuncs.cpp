@@ -0,0 +1,382 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <cstdio>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "RVersion.h"
+// ============================================================================
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,16,0)
+// ============================================================================
+// TMVA
+// ============================================================================
+#include "TMVA/Reader.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/DataFrameFuncs.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "OstapDataFrame.h"
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for JIT-free adapters from namespace Ostap::Frames
+ *  @see Ostap::Frames
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// number of processing slots for the frame
+  inline unsigned int n_slots ( Ostap::Frames::FrameNode& frame )
+  { return std::max ( 1u , frame.GetNSlots () ) ; }
+  // ==========================================================================
+  /// generate the unique name for the auxiliary column
+  std::string aux_name
+  ( Ostap::Frames::FrameNode& frame  ,
+    const std::string&        prefix )
+  {
+    static std::atomic<unsigned long> s_counter { 0 } ;
+    const auto columns = frame.GetColumnNames () ;
+    std::string name ;
+    do
+    {
+      char buffer [ 32 ] ;
+      std::snprintf ( buffer , sizeof ( buffer ) , "%lx" , s_counter++ ) ;
+      name = prefix + buffer ;
+    }
+    while ( columns.end () != std::find ( columns.begin () , columns.end () , name ) ) ;
+    return name ;
+  }
+  // ==========================================================================
+  /// per-slot clones of the function
+  template <class FUNCTION>
+  std::shared_ptr<std::vector<FUNCTION> >
+  clones ( Ostap::Frames::FrameNode& frame , const FUNCTION& fun )
+  { return std::make_shared<std::vector<FUNCTION> > ( n_slots ( frame ) , fun ) ; }
+  // ==========================================================================
+  /// the acceptance interval for the filter
+  inline std::function<bool(double)> in_range ( const double low , const double high )
+  { return [low,high] ( const double v ) -> bool { return low <= v && v < high ; } ; }
+  // ==========================================================================
+  /** @struct TmvaSlot
+   *  TMVA reader and placeholders for the variables, one per slot
+   */
+  struct TmvaSlot
+  {
+    std::unique_ptr<TMVA::Reader> reader {} ;
+    std::vector<float>            vars   {} ;
+  } ;
+  // ==========================================================================
+}
+// ============================================================================
+/* define the double-precision copy of the arithmetic column
+ *  - no new column is defined for the <code>double</code> columns
+ *  @param frame  (INPUT) the frame
+ *  @param column (INPUT) the column
+ *  @param name   (UPDATE) the name of the double-precision column
+ *  @return the updated frame
+ */
+// ============================================================================
+Ostap::Frames::FrameNode
+Ostap::Frames::as_double
+( Ostap::Frames::FrameNode frame  ,
+  const std::string&       column ,
+  std::string&             name   )
+{
+  const std::string type = frame.GetColumnType ( column ) ;
+  if ( "double" == type || "Double_t" == type ) { name = column ; return frame ; }
+  //
+  name = aux_name ( frame , "ostap_double_" ) ;
+  //
+  if      ( "float"              == type || "Float_t"   == type )
+  { return frame.Define ( name , [] ( const float              v ) -> double { return v ; } , { column } ) ; }
+  else if ( "int"                == type || "Int_t"     == type )
+  { return frame.Define ( name , [] ( const int                v ) -> double { return v ; } , { column } ) ; }
+  else if ( "unsigned int"       == type || "UInt_t"    == type )
+  { return frame.Define ( name , [] ( const unsigned int       v ) -> double { return v ; } , { column } ) ; }
+  else if ( "Long64_t"           == type || "long long" == type )
+  { return frame.Define ( name , [] ( const Long64_t           v ) -> double { return v ; } , { column } ) ; }
+  else if ( "ULong64_t"          == type || "unsigned long long" == type )
+  { return frame.Define ( name , [] ( const ULong64_t          v ) -> double { return v ; } , { column } ) ; }
+  else if ( "long"               == type || "Long_t"    == type )
+  { return frame.Define ( name , [] ( const long               v ) -> double { return v ; } , { column } ) ; }
+  else if ( "unsigned long"      == type || "ULong_t"   == type )
+  { return frame.Define ( name , [] ( const unsigned long      v ) -> double { return v ; } , { column } ) ; }
+  else if ( "short"              == type || "Short_t"   == type )
+  { return frame.Define ( name , [] ( const short              v ) -> double { return v ; } , { column } ) ; }
+  else if ( "unsigned short"     == type || "UShort_t"  == type )
+  { return frame.Define ( name , [] ( const unsigned short     v ) -> double { return v ; } , { column } ) ; }
+  else if ( "char"               == type || "Char_t"    == type )
+  { return frame.Define ( name , [] ( const char               v ) -> double { return v ; } , { column } ) ; }
+  else if ( "unsigned char"      == type || "UChar_t"   == type )
+  { return frame.Define ( name , [] ( const unsigned char      v ) -> double { return v ; } , { column } ) ; }
+  else if ( "bool"               == type || "Bool_t"    == type )
+  { return frame.Define ( name , [] ( const bool               v ) -> double { return v ; } , { column } ) ; }
+  //
+  Ostap::throwException ( "Column '" + column + "' of non-arithmetic type '" + type + "'" ,
+                          "Ostap::Frames::as_double" ) ;
+  return frame ;
+}
+// ============================================================================
+/*  define new column as 1D-function of the column
+ *  @param frame  (INPUT) the frame
+ *  @param name   (INPUT) the name of new column
+ *  @param fun    (INPUT) the function (the expressions are ignored)
+ *  @param x      (INPUT) the column for x
+ *  @return the updated frame
+ */
+// ============================================================================
+Ostap::Frames::FrameNode
+Ostap::Frames::define
+( Ostap::Frames::FrameNode          frame ,
+  const std::string&                name  ,
+  const Ostap::Functions::Func1D&   fun   ,
+  const std::string&                x     )
+{
+  std::string xc ;
+  FrameNode node  = as_double ( frame , x , xc ) ;
+  auto      funcs = clones ( node , fun ) ;
+  return node.DefineSlot
+    ( name ,
+      [funcs] ( const unsigned int slot , const double x ) -> double
+      { return ( *funcs ) [ slot ].func ( x ) ; } , { xc } ) ;
+}
+// ============================================================================
+/*  define new column as 2D-function of the columns
+ *  @param frame  (INPUT) the frame
+ *  @param name   (INPUT) the name of new column
+ *  @param fun    (INPUT) the function (the expressions are ignored)
+ *  @param x      (INPUT) the column for x
+ *  @param y      (INPUT) the column for y
+ *  @return the updated frame
+ */
+// ============================================================================
+Ostap::Frames::FrameNode
+Ostap::Frames::define
+( Ostap::Frames::FrameNode          frame ,
+  const std::string&                name  ,
+  const Ostap::Functions::Func2D&   fun   ,
+  const std::string&                x     ,
+  const std::string&                y     )
+{
+  std::string xc , yc ;
+  FrameNode node  = as_double ( frame , x , xc ) ;
+  node            = as_double ( node  , y , yc ) ;
+  auto      funcs = clones ( node , fun ) ;
+  return node.DefineSlot
+    ( name ,
+      [funcs] ( const unsigned int slot , const double x , const double y ) -> double
+      { return ( *funcs ) [ slot ].func ( x , y ) ; } , { xc , yc } ) ;
+}
+// ============================================================================
+/*  define new column as 3D-function of the columns
+ *  @param frame  (INPUT) the frame
+ *  @param name   (INPUT) the name of new column
+ *  @param fun    (INPUT) the function (the expressions are ignored)
+ *  @param x      (INPUT) the column for x
+ *  @param y      (INPUT) the column for y
+ *  @param z      (INPUT) the column for z
+ *  @return the updated frame
+ */
+// ============================================================================
+Ostap::Frames::FrameNode
+Ostap::Frames::define
+( Ostap::Frames::FrameNode          frame ,
+  const std::string&                name  ,
+  const Ostap::Functions::Func3D&   fun   ,
+  const std::string&                x     ,
+  const std::string&                y     ,
+  const std::string&                z     )
+{
+  std::string xc , yc , zc ;
+  FrameNode node  = as_double ( frame , x , xc ) ;
+  node            = as_double ( node  , y , yc ) ;
+  node            = as_double ( node  , z , zc ) ;
+  auto      funcs = clones ( node , fun ) ;
+  return node.DefineSlot
+    ( name ,
+      [funcs] ( const unsigned int slot , const double x , const double y , const double z ) -> double
+      { return ( *funcs ) [ slot ].func ( x , y , z ) ; } , { xc , yc , zc } ) ;
+}
+// ============================================================================
+/*  filter the frame using the 1D-function: <code>low <= fun(x) < high</code>
+ *  @param frame  (INPUT) the frame
+ *  @param fun    (INPUT) the function (the expressions are ignored)
+ *  @param x      (INPUT) the column for x
+ *  @param low    (INPUT) the low  edge of accepted interval
+ *  @param high   (INPUT) the high edge of accepted interval
+ *  @param name   (INPUT) the name of the filter
+ *  @return the filtered frame
+ */
+// ============================================================================
+Ostap::Frames::FrameNode
+Ostap::Frames::filter
+( Ostap::Frames::FrameNode          frame ,
+  const Ostap::Functions::Func1D&   fun   ,
+  const std::string&                x     ,
+  const double                      low   ,
+  const double                      high  ,
+  const std::string&                name  )
+{
+  std::string xc ;
+  FrameNode node  = as_double ( frame , x , xc ) ;
+  auto      funcs = clones    ( node  , fun    ) ;
+  auto      range = in_range  ( low   , high   ) ;
+  const std::string flag = aux_name ( node , "ostap_filter_" ) ;
+  node = node.DefineSlot
+    ( flag ,
+      [funcs,range] ( const unsigned int slot , const double x ) -> bool
+      { return range ( ( *funcs ) [ slot ].func ( x ) ) ; } , { xc } ) ;
+  return node.Filter ( [] ( const bool accept ) -> bool { return accept ; } , { flag } , name ) ;
+}
+// ============================================================================
+/*  filter the frame using the 2D-function: <code>low <= fun(x,y) < high</code>
+ *  @see Ostap::Frames::filter
+ */
+// ============================================================================
+Ostap::Frames::FrameNode
+Ostap::Frames::filter
+( Ostap::Frames::FrameNode          frame ,
+  const Ostap::Functions::Func2D&   fun   ,
+  const std::string&                x     ,
+  const std::string&                y     ,
+  const double                      low   ,
+  const double                      high  ,
+  const std::string&                name  )
+{
+  std::string xc , yc ;
+  FrameNode node  = as_double ( frame , x , xc ) ;
+  node            = as_double ( node  , y , yc ) ;
+  auto      funcs = clones    ( node  , fun    ) ;
+  auto      range = in_range  ( low   , high   ) ;
+  const std::string flag = aux_name ( node , "ostap_filter_" ) ;
+  node = node.DefineSlot
+    ( flag ,
+      [funcs,range] ( const unsigned int slot , const double x , const double y ) -> bool
+      { return range ( ( *funcs ) [ slot ].func ( x , y ) ) ; } , { xc , yc } ) ;
+  return node.Filter ( [] ( const bool accept ) -> bool { return accept ; } , { flag } , name ) ;
+}
+// ============================================================================
+/*  filter the frame using the 3D-function: <code>low <= fun(x,y,z) < high</code>
+ *  @see Ostap::Frames::filter
+ */
+// ============================================================================
+Ostap::Frames::FrameNode
+Ostap::Frames::filter
+( Ostap::Frames::FrameNode          frame ,
+  const Ostap::Functions::Func3D&   fun   ,
+  const std::string&                x     ,
+  const std::string&                y     ,
+  const std::string&                z     ,
+  const double                      low   ,
+  const double                      high  ,
+  const std::string&                name  )
+{
+  std::string xc , yc , zc ;
+  FrameNode node  = as_double ( frame , x , xc ) ;
+  node            = as_double ( node  , y , yc ) ;
+  node            = as_double ( node  , z , zc ) ;
+  auto      funcs = clones    ( node  , fun    ) ;
+  auto      range = in_range  ( low   , high   ) ;
+  const std::string flag = aux_name ( node , "ostap_filter_" ) ;
+  node = node.DefineSlot
+    ( flag ,
+      [funcs,range] ( const unsigned int slot , const double x , const double y , const double z ) -> bool
+      { return range ( ( *funcs ) [ slot ].func ( x , y , z ) ) ; } , { xc , yc , zc } ) ;
+  return node.Filter ( [] ( const bool accept ) -> bool { return accept ; } , { flag } , name ) ;
+}
+// ============================================================================
+/*  add TMVA responses as new columns <code>prefix+method+suffix</code>
+ *  - each processing slot gets its own <code>TMVA::Reader</code>
+ *  - the input variables are loaded into the reader via the chain of
+ *    the auxiliary columns: each column takes one input variable,
+ *    therefore no arity limitation exists for the typed callables
+ *  @see Ostap::TMVA::addResponse
+ */
+// ============================================================================
+Ostap::Frames::FrameNode
+Ostap::Frames::add_response
+( Ostap::Frames::FrameNode                  frame        ,
+  const std::map<std::string,std::string>&  inputs       ,
+  const std::map<std::string,std::string>&  weight_files ,
+  const std::string&                        options      ,
+  const std::string&                        prefix       ,
+  const std::string&                        suffix       ,
+  const double                              aux          )
+{
+  Ostap::Assert ( !inputs.empty () , "No input variables are specified" ,
+                  "Ostap::Frames::add_response" ) ;
+  Ostap::Assert ( !weight_files.empty () , "No weight files are specified" ,
+                  "Ostap::Frames::add_response" ) ;
+  //
+  // (1) the readers: one per slot
+  auto slots = std::make_shared<std::vector<TmvaSlot> > ( n_slots ( frame ) ) ;
+  for ( TmvaSlot& s : *slots )
+  {
+    s.vars.assign ( inputs.size () , 0.0f ) ;
+    s.reader = std::make_unique<TMVA::Reader> ( options ) ;
+    std::size_t index = 0 ;
+    for ( const auto& i : inputs ) { s.reader->AddVariable ( i.first , &s.vars [ index++ ] ) ; }
+    for ( const auto& w : weight_files )
+    {
+      Ostap::Assert ( nullptr != s.reader->BookMVA ( w.first , w.second ) ,
+                      "Cannot book TMVA method '" + w.first + "' from '" + w.second + "'" ,
+                      "Ostap::Frames::add_response" ) ;
+    }
+  }
+  //
+  // (2) the chain of auxiliary columns to load the variables
+  FrameNode   node  = frame ;
+  std::string stage = "" ;
+  std::size_t index = 0  ;
+  for ( const auto& i : inputs )
+  {
+    std::string column ;
+    node = as_double ( node , i.second.empty () ? i.first : i.second , column ) ;
+    const std::string next = aux_name ( node , "ostap_tmva_" ) ;
+    if ( stage.empty () )
+    {
+      node = node.DefineSlot
+        ( next ,
+          [slots,index] ( const unsigned int slot , const double v ) -> int
+          { ( *slots ) [ slot ].vars [ index ] = v ; return 0 ; } , { column } ) ;
+    }
+    else
+    {
+      node = node.DefineSlot
+        ( next ,
+          [slots,index] ( const unsigned int slot , const int /* previous */ , const double v ) -> int
+          { ( *slots ) [ slot ].vars [ index ] = v ; return 0 ; } , { stage , column } ) ;
+    }
+    stage = next ;
+    ++index ;
+  }
+  //
+  // (3) the responses
+  for ( const auto& w : weight_files )
+  {
+    const std::string method = w.first ;
+    node = node.DefineSlot
+      ( prefix + method + suffix ,
+        [slots,method,aux] ( const unsigned int slot , const int /* loaded */ ) -> double
+        { return ( *slots ) [ slot ].reader->EvaluateMVA ( method , aux ) ; } , { stage } ) ;
+  }
+  //
+  return node ;
+}
+// ============================================================================
+#endif // ROOT_VERSION_CODE >= ROOT_VERSION(6,16,0)
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -2,14 +2,15 @@
 // ============================================================================
 // STD&STL
 // ============================================================================
-#include  <iostream> 
-#include  <mutex> 
-#include  <cmath> 
+#include  <algorithm> 
+#include  <memory> 
+#include  <thread> 
 // ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/DataFrame.h"
 #include "Ostap/DataFrameUtils.h"
+#include "Ostap/Progress.h"
 // ============================================================================
 // local 
 // ============================================================================
@@ -22,14 +23,6 @@
  *  @date   2019-11-08
  */
 // ============================================================================
-namespace 
-{
-  // ==========================================================================
-  /// local mutex from progress  bar 
-  std::mutex s_mutex_bar {} ;
-  // ==========================================================================
-}
-// ============================================================================
 /* helper function to create callable  for drawing of progress bar to the frame 
  *  @param  chunk   sise of each chunk  (parameter <code>everyN</code> for 
  *                                       <code>OnPartialResultSlot</code>)
@@ -40,6 +33,7 @@ namespace
  *  @param  right  suffix 
  *  The format of progress bar is:
  *  <code>left+(%*psymbol)+(N-%)*blank+right+percentage</code>
+ *  @see Ostap::Utils::Progress
  *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
  *  @date   2019-11-08
  */
@@ -53,34 +47,15 @@ Ostap::Utils::frame_progress
   const std::string&   left    , 
   const std::string&   right   )
 {
+  // no locks at the hot path: per-slot atomic counters & rate-limited rendering
+  auto progress = std::make_shared<Ostap::Utils::Progress>
+    ( nchunks , std::max ( 1u , std::thread::hardware_concurrency () ) ,
+      nchunks , symbol , blank , left , right ) ;
   //
-  return [symbol,nchunks,left,right,blank] 
-    ( unsigned int islot , ULong64_t& /* u */ ) -> void 
+  return [progress] ( unsigned int islot , ULong64_t& /* u */ ) -> void 
   {
-    //
-    static unsigned short istep { 0 } ;
-    std::lock_guard<std::mutex> lock ( s_mutex_bar ) ;
-    //
-    istep        += 1      ;
-    //
-    if ( istep <= nchunks ) 
-    {
-      const int percent = 
-        istep >= nchunks ? 100 : 
-        int ( std::floor ( double ( istep * 100 ) / nchunks ) ) ; 
-      //
-      std::string show = "\r" + left ;
-      for  ( unsigned short i = 0     ; i < istep    ; ++i ) { show += symbol ; } 
-      for  ( unsigned short j = istep ; j < nchunks  ; ++j ) { show += blank  ; } 
-      show += right ;
-      show += " "   ;
-      std::cout << show << percent << "%" ;
-    }
-    //
-    if ( istep == nchunks ) { std::cout << std::endl ; }
-    //
-    std::cout << std::flush ;
-    //
+    progress->add ( islot ) ;
+    if ( progress->total () <= progress->count () ) { progress->finish () ; }
   } ;
   //
 }
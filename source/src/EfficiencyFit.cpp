@@ -0,0 +1,410 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "Math/IFunction.h"
+#include "Math/Minimizer.h"
+#include "Math/Factory.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Bernstein2D.h"
+#include "Ostap/Bernstein3D.h"
+#include "Ostap/BSpline.h"
+#include "Ostap/EfficiencyFit.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+#include "bernstein_utils.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Math::EfficiencyFit
+ *  @see Ostap::Math::EfficiencyFit
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// the minimal size of the block of events
+  const std::size_t s_BLOCK   = 4096 ;
+  /// the margin for the efficiency to avoid log(0)
+  const double      s_EPSILON = 1.e-12 ;
+  // ==========================================================================
+  /// check the input arrays
+  void check_sizes
+  ( const std::size_t          n       ,
+    const std::vector<double>& a       ,
+    const std::vector<double>& accept  ,
+    const std::vector<double>& weights )
+  {
+    Ostap::Assert ( a.size () == n && accept.size () == n ,
+                    "Mismatch in array sizes"              ,
+                    "Ostap::Math::EfficiencyFit"           ) ;
+    Ostap::Assert ( weights.empty () || weights.size () == n ,
+                    "Mismatch in size of weights"            ,
+                    "Ostap::Math::EfficiencyFit"             ) ;
+  }
+  // ==========================================================================
+  /// the values of the Bernstein basis polynomials at the point
+  inline void bernstein_values
+  ( const unsigned short N     ,
+    const double         xmin  ,
+    const double         xmax  ,
+    const double         x     ,
+    double*              out   )
+  {
+    const long double t  = std::min ( 1.0 , std::max ( 0.0 , ( x - xmin ) / ( xmax - xmin ) ) ) ;
+    Ostap::Math::Utils::bernstein_basis ( N , t , 1 - t , out ) ;
+  }
+  // ==========================================================================
+  /** @class NLL
+   *  the adapter for Minuit with the analytic gradient
+   */
+  class NLL : public ROOT::Math::IMultiGradFunction
+  {
+  public:
+    // ========================================================================
+    explicit NLL ( const Ostap::Math::EfficiencyFit& fit ) : m_fit ( &fit ) {}
+    // ========================================================================
+    NLL*         Clone () const override { return new NLL ( *this ) ; }
+    unsigned int NDim  () const override { return m_fit->nbasis () ; }
+    // ========================================================================
+    void Gradient ( const double* x , double* grad ) const override
+    { m_fit->nll ( x , grad ) ; }
+    void FdF ( const double* x , double& f , double* grad ) const override
+    { f = m_fit->nll ( x , grad ) ; }
+    // ========================================================================
+  private:
+    // ========================================================================
+    double DoEval ( const double* x ) const override
+    { return m_fit->nll ( x ) ; }
+    double DoDerivative ( const double* x , unsigned int icoord ) const override
+    {
+      std::vector<double> grad ( NDim () ) ;
+      m_fit->nll ( x , grad.data () ) ;
+      return grad [ icoord ] ;
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    const Ostap::Math::EfficiencyFit* m_fit ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+}
+// ============================================================================
+// constructor from 2D Bernstein polynomial
+// ============================================================================
+Ostap::Math::EfficiencyFit::EfficiencyFit
+( const Ostap::Math::Bernstein2D& shape    ,
+  const std::vector<double>&      x        ,
+  const std::vector<double>&      y        ,
+  const std::vector<double>&      accept   ,
+  const std::vector<double>&      weights  ,
+  const unsigned int              nthreads )
+  : m_nevents ( x.size      () )
+  , m_nbasis  ( shape.npars () )
+{
+  check_sizes ( m_nevents , y , accept , weights ) ;
+  //
+  const unsigned short nx = shape.nX () ;
+  const unsigned short ny = shape.nY () ;
+  m_matrix.resize ( m_nevents * m_nbasis ) ;
+  //
+  std::vector<double> fx ( nx + 1 ) ;
+  std::vector<double> fy ( ny + 1 ) ;
+  for ( std::size_t i = 0 ; i < m_nevents ; ++i )
+  {
+    bernstein_values ( nx , shape.xmin () , shape.xmax () , x [ i ] , fx.data () ) ;
+    bernstein_values ( ny , shape.ymin () , shape.ymax () , y [ i ] , fy.data () ) ;
+    for ( unsigned short l = 0 ; l <= nx ; ++l )
+    { for ( unsigned short m = 0 ; m <= ny ; ++m )
+      { m_matrix [ shape.index ( l , m ) * m_nevents + i ] = fx [ l ] * fy [ m ] ; } }
+  }
+  // p_k = c_k / ( scalex * scaley )
+  const double scalex = ( nx + 1 ) / ( shape.xmax () - shape.xmin () ) ;
+  const double scaley = ( ny + 1 ) / ( shape.ymax () - shape.ymin () ) ;
+  m_scales.assign ( m_nbasis , 1.0 / ( scalex * scaley ) ) ;
+  //
+  setup ( accept , weights , nthreads ) ;
+}
+// ============================================================================
+// constructor from 3D Bernstein polynomial
+// ============================================================================
+Ostap::Math::EfficiencyFit::EfficiencyFit
+( const Ostap::Math::Bernstein3D& shape    ,
+  const std::vector<double>&      x        ,
+  const std::vector<double>&      y        ,
+  const std::vector<double>&      z        ,
+  const std::vector<double>&      accept   ,
+  const std::vector<double>&      weights  ,
+  const unsigned int              nthreads )
+  : m_nevents ( x.size      () )
+  , m_nbasis  ( shape.npars () )
+{
+  check_sizes ( m_nevents , y , accept , weights ) ;
+  check_sizes ( m_nevents , z , accept , weights ) ;
+  //
+  const unsigned short nx = shape.nX () ;
+  const unsigned short ny = shape.nY () ;
+  const unsigned short nz = shape.nZ () ;
+  m_matrix.resize ( m_nevents * m_nbasis ) ;
+  //
+  std::vector<double> fx ( nx + 1 ) ;
+  std::vector<double> fy ( ny + 1 ) ;
+  std::vector<double> fz ( nz + 1 ) ;
+  for ( std::size_t i = 0 ; i < m_nevents ; ++i )
+  {
+    bernstein_values ( nx , shape.xmin () , shape.xmax () , x [ i ] , fx.data () ) ;
+    bernstein_values ( ny , shape.ymin () , shape.ymax () , y [ i ] , fy.data () ) ;
+    bernstein_values ( nz , shape.zmin () , shape.zmax () , z [ i ] , fz.data () ) ;
+    for ( unsigned short l = 0 ; l <= nx ; ++l )
+    { for ( unsigned short m = 0 ; m <= ny ; ++m )
+      { for ( unsigned short n = 0 ; n <= nz ; ++n )
+        { m_matrix [ shape.index ( l , m , n ) * m_nevents + i ] = fx [ l ] * fy [ m ] * fz [ n ] ; } } }
+  }
+  // p_k = c_k / ( scalex * scaley * scalez )
+  const double scalex = ( nx + 1 ) / ( shape.xmax () - shape.xmin () ) ;
+  const double scaley = ( ny + 1 ) / ( shape.ymax () - shape.ymin () ) ;
+  const double scalez = ( nz + 1 ) / ( shape.zmax () - shape.zmin () ) ;
+  m_scales.assign ( m_nbasis , 1.0 / ( scalex * scaley * scalez ) ) ;
+  //
+  setup ( accept , weights , nthreads ) ;
+}
+// ============================================================================
+// constructor from 2D B-spline
+// ============================================================================
+Ostap::Math::EfficiencyFit::EfficiencyFit
+( const Ostap::Math::BSpline2D&   shape    ,
+  const std::vector<double>&      x        ,
+  const std::vector<double>&      y        ,
+  const std::vector<double>&      accept   ,
+  const std::vector<double>&      weights  ,
+  const unsigned int              nthreads )
+  : m_nevents ( x.size      () )
+  , m_nbasis  ( shape.npars () )
+{
+  check_sizes ( m_nevents , y , accept , weights ) ;
+  //
+  const Ostap::Math::BSpline& xs = shape.xspline () ;
+  const Ostap::Math::BSpline& ys = shape.yspline () ;
+  const unsigned short kx = xs.order () ;
+  const unsigned short ky = ys.order () ;
+  m_matrix.resize ( m_nevents * m_nbasis ) ;
+  //
+  // only non-zero B-splines contribute
+  std::vector<double> fx ( kx + 1 ) ;
+  std::vector<double> fy ( ky + 1 ) ;
+  unsigned short hx = 0 ;
+  unsigned short hy = 0 ;
+  for ( std::size_t i = 0 ; i < m_nevents ; ++i )
+  {
+    hx = xs.bsplines ( x [ i ] , fx.data () , hx ) ;
+    hy = ys.bsplines ( y [ i ] , fy.data () , hy ) ;
+    const unsigned short jx = hx - kx ;
+    const unsigned short jy = hy - ky ;
+    for ( unsigned short rx = 0 ; rx <= kx ; ++rx )
+    { for ( unsigned short ry = 0 ; ry <= ky ; ++ry )
+      { m_matrix [ shape.index ( jx + rx , jy + ry ) * m_nevents + i ] = fx [ rx ] * fy [ ry ] ; } }
+  }
+  // p_k = c_k * dtx * dty / ( ( kx + 1 ) * ( ky + 1 ) )
+  m_scales.resize ( m_nbasis ) ;
+  for ( unsigned short ix = 0 ; ix < xs.npars () ; ++ix )
+  {
+    const double dx = xs.knot_i ( ix + kx + 1 ) - xs.knot_i ( ix ) ;
+    for ( unsigned short iy = 0 ; iy < ys.npars () ; ++iy )
+    {
+      const double dy = ys.knot_i ( iy + ky + 1 ) - ys.knot_i ( iy ) ;
+      m_scales [ shape.index ( ix , iy ) ] = dx * dy / ( ( kx + 1 ) * ( ky + 1 ) ) ;
+    }
+  }
+  //
+  setup ( accept , weights , nthreads ) ;
+}
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::Math::EfficiencyFit::~EfficiencyFit () {}
+// ============================================================================
+// fill the common data
+// ============================================================================
+void Ostap::Math::EfficiencyFit::setup
+( const std::vector<double>& accept   ,
+  const std::vector<double>& weights  ,
+  const unsigned int         nthreads )
+{
+  Ostap::Assert ( 0 < m_nbasis , "Empty basis" , "Ostap::Math::EfficiencyFit" ) ;
+  //
+  m_accept .resize ( m_nevents ) ;
+  m_weights.resize ( m_nevents , 1.0 ) ;
+  for ( std::size_t i = 0 ; i < m_nevents ; ++i )
+  {
+    m_accept [ i ] = 0 != accept [ i ] ;
+    if ( !weights.empty () ) { m_weights [ i ] = weights [ i ] ; }
+    m_total += m_weights [ i ] ;
+    if ( m_accept [ i ] ) { m_accepted += m_weights [ i ] ; }
+  }
+  //
+  // the blocks of events: their number does not depend on the number of threads,
+  // therefore the result is reproducible
+  const std::size_t nblocks = std::max<std::size_t> ( 1 , m_nevents / s_BLOCK ) ;
+  for ( const auto& c : Ostap::Utils::split ( 0 , m_nevents , nblocks ) )
+  { if ( c.first < c.last ) { m_blocks.emplace_back ( c.first , c.last ) ; } }
+  //
+  const unsigned int nt = std::min<std::size_t>
+    ( m_blocks.size () , 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ;
+  if ( 1 < nt ) { m_pool.reset ( new Ostap::Utils::WorkerPool ( nt ) ) ; }
+  //
+  const double eff = 0 < m_total ? m_accepted / m_total : 0.5 ;
+  m_coeffs.assign ( m_nbasis , std::min ( 1 - 1.e-3 , std::max ( 1.e-3 , eff ) ) ) ;
+  m_errors.assign ( m_nbasis , 0.0 ) ;
+  m_cov   .assign ( m_nbasis * m_nbasis , 0.0 ) ;
+}
+// ============================================================================
+// negative log-likelihood and (optionally) its gradient
+// ============================================================================
+double Ostap::Math::EfficiencyFit::nll
+( const double* c        ,
+  double*       gradient ) const
+{
+  const std::size_t NB  = m_blocks.size () ;
+  const std::size_t K   = m_nbasis        ;
+  const bool        der = nullptr != gradient ;
+  //
+  // partial sums for each block
+  std::vector<double> values ( NB , 0.0 ) ;
+  std::vector<double> grads  ( der ? NB * K : 0 , 0.0 ) ;
+  //
+  auto block = [&] ( const std::size_t b )
+    {
+      const std::size_t first = m_blocks [ b ].first  ;
+      const std::size_t last  = m_blocks [ b ].second ;
+      const std::size_t n     = last - first ;
+      //
+      // efficiency: eps = M * c
+      std::vector<double> eps ( n , 0.0 ) ;
+      for ( std::size_t k = 0 ; k < K ; ++k )
+      {
+        const double  ck  = c [ k ] ;
+        const double* col = m_matrix.data () + k * m_nevents + first ;
+        for ( std::size_t i = 0 ; i < n ; ++i ) { eps [ i ] += ck * col [ i ] ; }
+      }
+      // value and the derivative with respect to efficiency
+      double result = 0 ;
+      for ( std::size_t i = 0 ; i < n ; ++i )
+      {
+        const double e = std::min ( 1 - s_EPSILON , std::max ( s_EPSILON , eps [ i ] ) ) ;
+        const double w = m_weights [ first + i ] ;
+        if ( m_accept [ first + i ] ) { result -= w * std::log (     e ) ; eps [ i ] = -w / e         ; }
+        else                          { result -= w * std::log ( 1 - e ) ; eps [ i ] =  w / ( 1 - e ) ; }
+      }
+      values [ b ] = result ;
+      if ( !der ) { return ; }                                            // RETURN
+      // gradient: g = M^T * d
+      double* g = grads.data () + b * K ;
+      for ( std::size_t k = 0 ; k < K ; ++k )
+      {
+        const double* col = m_matrix.data () + k * m_nevents + first ;
+        double gk = 0 ;
+        for ( std::size_t i = 0 ; i < n ; ++i ) { gk += col [ i ] * eps [ i ] ; }
+        g [ k ] = gk ;
+      }
+    } ;
+  //
+  if ( !m_pool ) { for ( std::size_t b = 0 ; b < NB ; ++b ) { block ( b ) ; } }
+  else
+  {
+    std::atomic<std::size_t> next { 0 } ;
+    m_pool->run ( [&] ( const unsigned int /* index */ )
+      { for ( std::size_t b = next++ ; b < NB ; b = next++ ) { block ( b ) ; } } ) ;
+  }
+  //
+  // combine the partial sums in the fixed order
+  double result = 0 ;
+  for ( std::size_t b = 0 ; b < NB ; ++b ) { result += values [ b ] ; }
+  if ( der )
+  {
+    std::fill ( gradient , gradient + K , 0.0 ) ;
+    for ( std::size_t b = 0 ; b < NB ; ++b )
+    { for ( std::size_t k = 0 ; k < K ; ++k ) { gradient [ k ] += grads [ b * K + k ] ; } }
+  }
+  return result ;
+}
+// ============================================================================
+// negative log-likelihood
+// ============================================================================
+double Ostap::Math::EfficiencyFit::nll ( const std::vector<double>& c ) const
+{
+  Ostap::Assert ( m_nbasis <= c.size ()    ,
+                  "Invalid size of coefficients" ,
+                  "Ostap::Math::EfficiencyFit"   ) ;
+  return nll ( c.data () ) ;
+}
+// ============================================================================
+// perform the fit
+// ============================================================================
+int Ostap::Math::EfficiencyFit::fit
+( const int    strategy  ,
+  const double tolerance )
+{
+  std::unique_ptr<ROOT::Math::Minimizer> minimizer
+    ( ROOT::Math::Factory::CreateMinimizer ( "Minuit2" , "Migrad" ) ) ;
+  if ( !minimizer ) { minimizer.reset ( ROOT::Math::Factory::CreateMinimizer ( "Minuit" , "Migrad" ) ) ; }
+  Ostap::Assert ( nullptr != minimizer.get ()  ,
+                  "Cannot create the minimizer" ,
+                  "Ostap::Math::EfficiencyFit"  ) ;
+  //
+  const NLL function ( *this ) ;
+  minimizer->SetFunction  ( function  ) ;
+  minimizer->SetStrategy  ( strategy  ) ;
+  minimizer->SetTolerance ( tolerance ) ;
+  minimizer->SetErrorDef  ( 0.5       ) ;
+  minimizer->SetPrintLevel ( -1       ) ;
+  //
+  for ( std::size_t k = 0 ; k < m_nbasis ; ++k )
+  {
+    minimizer->SetLimitedVariable
+      ( k , "c" + std::to_string ( k ) , m_coeffs [ k ] , 0.01 , 0.0 , 1.0 ) ;
+  }
+  //
+  minimizer->Minimize () ;
+  //
+  const double* xs = minimizer->X      () ;
+  const double* es = minimizer->Errors () ;
+  for ( std::size_t k = 0 ; k < m_nbasis ; ++k )
+  {
+    m_coeffs [ k ] = xs [ k ] ;
+    m_errors [ k ] = nullptr != es ? es [ k ] : 0.0 ;
+    for ( std::size_t j = 0 ; j < m_nbasis ; ++j )
+    { m_cov [ k * m_nbasis + j ] = minimizer->CovMatrix ( k , j ) ; }
+  }
+  m_minnll = minimizer->MinValue () ;
+  //
+  return minimizer->Status () ;
+}
+// ============================================================================
+// the parameters of the shape, that reproduce the fitted efficiency
+// ============================================================================
+std::vector<double> Ostap::Math::EfficiencyFit::pars () const
+{
+  std::vector<double> result ( m_nbasis ) ;
+  for ( std::size_t k = 0 ; k < m_nbasis ; ++k ) { result [ k ] = m_coeffs [ k ] * m_scales [ k ] ; }
+  return result ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -5,6 +5,11 @@
 // STD & STL 
 // ============================================================================
 #include <vector>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include <thread>
+#include <exception>
 // ============================================================================
 // GSL
 // ============================================================================
@@ -25,6 +30,7 @@
 // Local
 // ============================================================================
 #include "Exception.h"
+#include "local_mt.h"
 // ============================================================================
 /** @file 
  *  Implementation fiel for class Gaudi::Math::GSL::EigenSystem
@@ -121,6 +127,294 @@ Ostap::StatusCode Ostap::Math::GSL::EigenSystem::_fun2
   return Ostap::StatusCode::SUCCESS ;
 } 
 // ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /// minimal number of matrices per thread 
+  const std::size_t    s_MINCHUNK = 1024 ;
+  /// maximal number of Jacobi sweeps 
+  const unsigned int   s_SWEEPS   = 64   ;
+  /// relative gap between eigenvalues for the closed-form 3x3 eigenvectors 
+  const double         s_GAP3     = 1.e-5 ;
+  // ==========================================================================
+  /** cyclic Jacobi sweeps for the symmetric DxD matrix 
+   *  @param a (UPDATE) full matrix, diagonalized 
+   *  @param d (OUTPUT) the eigenvalues 
+   *  @param v (OUTPUT) matrix of eigenvectors as columns (could be null)
+   *  @return true if converged 
+   */
+  bool _jacobi_ 
+  ( double*            a , 
+    double*            d , 
+    double*            v , 
+    const unsigned int D ) 
+  {
+    if ( 0 != v ) 
+    {
+      std::fill ( v , v + D * D , 0.0 ) ;
+      for ( unsigned int i = 0 ; i < D ; ++i ) { v [ i * D + i ] = 1 ; }
+    }
+    //
+    double norm2 = 0 ;
+    for ( unsigned int i = 0 ; i < D * D ; ++i ) { norm2 += a [ i ] * a [ i ] ; }
+    const double tiny = norm2 * DBL_EPSILON * DBL_EPSILON ;
+    //
+    bool converged = false ;
+    for ( unsigned int sweep = 0 ; sweep < s_SWEEPS && !converged ; ++sweep ) 
+    {
+      double off = 0 ;
+      for ( unsigned int p = 0 ; p < D ; ++p ) 
+      { for ( unsigned int q = p + 1 ; q < D ; ++q ) { off += a [ p * D + q ] * a [ p * D + q ] ; } }
+      //
+      if ( off <= tiny ) { converged = true ; break ; }
+      //
+      for ( unsigned int p = 0 ; p < D ; ++p ) 
+      {
+        for ( unsigned int q = p + 1 ; q < D ; ++q ) 
+        {
+          const double apq = a [ p * D + q ] ;
+          if ( 0 == apq ) { continue ; }
+          //
+          const double theta = 0.5 * ( a [ q * D + q ] - a [ p * D + p ] ) / apq ;
+          const double t     = ( theta < 0 ? -1.0 : 1.0 ) / ( std::abs ( theta ) + std::hypot ( theta , 1.0 ) ) ;
+          const double c     = 1 / std::sqrt ( t * t + 1 ) ;
+          const double s     = t * c ;
+          //
+          for ( unsigned int k = 0 ; k < D ; ++k ) 
+          {
+            const double akp = a [ k * D + p ] ;
+            const double akq = a [ k * D + q ] ;
+            a [ k * D + p ] = c * akp - s * akq ;
+            a [ k * D + q ] = s * akp + c * akq ;
+          }
+          for ( unsigned int k = 0 ; k < D ; ++k ) 
+          {
+            const double apk = a [ p * D + k ] ;
+            const double aqk = a [ q * D + k ] ;
+            a [ p * D + k ] = c * apk - s * aqk ;
+            a [ q * D + k ] = s * apk + c * aqk ;
+          }
+          a [ p * D + q ] = a [ q * D + p ] = 0 ;
+          //
+          if ( 0 != v ) 
+          {
+            for ( unsigned int k = 0 ; k < D ; ++k ) 
+            {
+              const double vkp = v [ k * D + p ] ;
+              const double vkq = v [ k * D + q ] ;
+              v [ k * D + p ] = c * vkp - s * vkq ;
+              v [ k * D + q ] = s * vkp + c * vkq ;
+            }
+          }
+        }
+      }
+    }
+    //
+    for ( unsigned int i = 0 ; i < D ; ++i ) { d [ i ] = a [ i * D + i ] ; }
+    return converged ;
+  }
+  // ==========================================================================
+  /// closed-form eigenvalues & eigenvectors for 2x2 symmetric matrix 
+  void _closed2_ 
+  ( const double* a , 
+    double*       d , 
+    double*       v ) 
+  {
+    const double a00 = a [ 0 ] ;
+    const double a01 = a [ 1 ] ;
+    const double a11 = a [ 3 ] ;
+    //
+    const double m   = 0.5 * ( a00 + a11 ) ;
+    const double r   = std::hypot ( 0.5 * ( a00 - a11 ) , a01 ) ;
+    d [ 0 ] = m - r ;
+    d [ 1 ] = m + r ;
+    //
+    if ( 0 != v ) 
+    {
+      const double phi = 0.5 * std::atan2 ( 2 * a01 , a00 - a11 ) ;
+      const double c   = std::cos ( phi ) ;
+      const double s   = std::sin ( phi ) ;
+      // columns: (-s,c) for the smallest and (c,s) for the largest eigenvalue 
+      v [ 0 ] = -s ; v [ 1 ] = c ;
+      v [ 2 ] =  c ; v [ 3 ] = s ;
+    }
+  }
+  // ==========================================================================
+  /// eigenvector of 3x3 matrix for the (isolated) eigenvalue 
+  void _vector3_ 
+  ( const double* a      , 
+    const double  lambda , 
+    double*       e      ) 
+  {
+    const double r0 [3] = { a [ 0 ] - lambda , a [ 1 ]          , a [ 2 ]          } ;
+    const double r1 [3] = { a [ 3 ]          , a [ 4 ] - lambda , a [ 5 ]          } ;
+    const double r2 [3] = { a [ 6 ]          , a [ 7 ]          , a [ 8 ] - lambda } ;
+    //
+    auto cross = [] ( const double* x , const double* y , double* z ) 
+      {
+        z [ 0 ] = x [ 1 ] * y [ 2 ] - x [ 2 ] * y [ 1 ] ;
+        z [ 1 ] = x [ 2 ] * y [ 0 ] - x [ 0 ] * y [ 2 ] ;
+        z [ 2 ] = x [ 0 ] * y [ 1 ] - x [ 1 ] * y [ 0 ] ;
+        return z [ 0 ] * z [ 0 ] + z [ 1 ] * z [ 1 ] + z [ 2 ] * z [ 2 ] ;
+      } ;
+    //
+    double c [ 3 ][ 3 ] ;
+    const double n0 = cross ( r0 , r1 , c [ 0 ] ) ;
+    const double n1 = cross ( r0 , r2 , c [ 1 ] ) ;
+    const double n2 = cross ( r1 , r2 , c [ 2 ] ) ;
+    //
+    const unsigned int k = n0 >= n1 ? ( n0 >= n2 ? 0 : 2 ) : ( n1 >= n2 ? 1 : 2 ) ;
+    const double       n = std::sqrt ( std::max ( n0 , std::max ( n1 , n2 ) ) ) ;
+    for ( unsigned int i = 0 ; i < 3 ; ++i ) { e [ i ] = c [ k ][ i ] / n ; }
+  }
+  // ==========================================================================
+  /** closed-form eigenvalues & eigenvectors for 3x3 symmetric matrix 
+   *  @return false for (almost) degenerate eigenvalues, 
+   *          when the closed-form eigenvectors are not reliable 
+   */
+  bool _closed3_ 
+  ( const double* a , 
+    double*       d , 
+    double*       v ) 
+  {
+    const double p1 = a [ 1 ] * a [ 1 ] + a [ 2 ] * a [ 2 ] + a [ 5 ] * a [ 5 ] ;
+    const double q  = ( a [ 0 ] + a [ 4 ] + a [ 8 ] ) / 3 ;
+    const double b0 = a [ 0 ] - q ;
+    const double b1 = a [ 4 ] - q ;
+    const double b2 = a [ 8 ] - q ;
+    const double p2 = b0 * b0 + b1 * b1 + b2 * b2 + 2 * p1 ;
+    //
+    // diagonal matrix 
+    if ( 0 == p1 || 0 == p2 ) { return false ; }
+    //
+    const double p  = std::sqrt ( p2 / 6 ) ;
+    // r = det ( ( A - q ) / p ) / 2 
+    const double det = 
+      b0 * ( b1 * b2 - a [ 5 ] * a [ 5 ] ) - 
+      a [ 1 ] * ( a [ 1 ] * b2 - a [ 5 ] * a [ 2 ] ) + 
+      a [ 2 ] * ( a [ 1 ] * a [ 5 ] - b1 * a [ 2 ] ) ;
+    const double r   = std::max ( -1.0 , std::min ( 1.0 , 0.5 * det / ( p * p * p ) ) ) ;
+    const double phi = std::acos ( r ) / 3 ;
+    //
+    d [ 2 ] = q + 2 * p * std::cos ( phi                    ) ;
+    d [ 0 ] = q + 2 * p * std::cos ( phi + 2 * M_PI / 3     ) ;
+    d [ 1 ] = 3 * q - d [ 0 ] - d [ 2 ] ;
+    //
+    if ( 0 == v ) { return true ; }
+    //
+    const double scale = std::max ( std::abs ( d [ 0 ] ) , std::abs ( d [ 2 ] ) ) ;
+    const double gap   = std::min ( d [ 1 ] - d [ 0 ] , d [ 2 ] - d [ 1 ] ) ;
+    if ( gap <= s_GAP3 * scale ) { return false ; }
+    //
+    double e0 [3] , e2 [3] ;
+    _vector3_ ( a , d [ 0 ] , e0 ) ;
+    _vector3_ ( a , d [ 2 ] , e2 ) ;
+    // the middle one: orthogonal to others 
+    const double e1 [3] = { e2 [ 1 ] * e0 [ 2 ] - e2 [ 2 ] * e0 [ 1 ] , 
+                            e2 [ 2 ] * e0 [ 0 ] - e2 [ 0 ] * e0 [ 2 ] , 
+                            e2 [ 0 ] * e0 [ 1 ] - e2 [ 1 ] * e0 [ 0 ] } ;
+    for ( unsigned int i = 0 ; i < 3 ; ++i ) 
+    {
+      v [ i * 3 + 0 ] = e0 [ i ] ;
+      v [ i * 3 + 1 ] = e1 [ i ] ;
+      v [ i * 3 + 2 ] = e2 [ i ] ;
+    }
+    return true ;
+  }
+  // ==========================================================================
+  /// sort eigenvalues (and eigenvectors) in ascending order 
+  void _sort_ 
+  ( double*            d , 
+    double*            v , 
+    const unsigned int D ) 
+  {
+    for ( unsigned int i = 1 ; i < D ; ++i ) 
+    {
+      for ( unsigned int j = i ; 0 < j && d [ j ] < d [ j - 1 ] ; --j ) 
+      {
+        std::swap ( d [ j ] , d [ j - 1 ] ) ;
+        if ( 0 != v ) 
+        { for ( unsigned int k = 0 ; k < D ; ++k ) { std::swap ( v [ k * D + j ] , v [ k * D + j - 1 ] ) ; } }
+      }
+    }
+  }
+  // ==========================================================================
+} //                                                 The end of anonymous namespace 
+// ============================================================================
+// solve the eigenproblem for the small (D<=6) matrix 
+// ============================================================================
+Ostap::StatusCode Ostap::Math::GSL::EigenSystem::_small 
+( double*            a      , 
+  double*            vals   , 
+  double*            vecs   , 
+  const unsigned int D      , 
+  const bool         sorted ) 
+{
+  if      ( 1 == D ) 
+  {
+    vals [ 0 ] = a [ 0 ] ;
+    if ( 0 != vecs ) { vecs [ 0 ] = 1 ; }
+    return Ostap::StatusCode::SUCCESS ;
+  }
+  else if ( 2 == D ) 
+  {
+    _closed2_ ( a , vals , vecs ) ;
+    return Ostap::StatusCode::SUCCESS ;
+  }
+  else if ( 3 == D && _closed3_ ( a , vals , vecs ) ) 
+  { return Ostap::StatusCode::SUCCESS ; }
+  //
+  if ( !_jacobi_ ( a , vals , vecs , D ) ) 
+  { return Ostap::StatusCode ( JacobiFailure ) ; }
+  //
+  if ( sorted ) { _sort_ ( vals , vecs , D ) ; }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+// process the range [0,N) in chunks using several threads 
+// ============================================================================
+Ostap::StatusCode Ostap::Math::GSL::EigenSystem::_process 
+( const std::size_t                          N        , 
+  const unsigned int                         nthreads , 
+  const Ostap::Math::GSL::EigenSystem::Task& task     ) 
+{
+  if ( 0 == N ) { return Ostap::StatusCode::SUCCESS ; }
+  //
+  const std::size_t nt = std::min 
+    ( std::max ( std::size_t ( 1 ) , N / s_MINCHUNK ) , 
+      std::size_t ( 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ) ;
+  //
+  if ( 1 == nt ) { return task ( 0 , N ) ; }
+  //
+  std::vector<Ostap::StatusCode>  status ( nt , Ostap::StatusCode::SUCCESS ) ;
+  std::vector<std::exception_ptr> errors ( nt ) ;
+  const std::size_t chunk = N / nt + ( N % nt ? 1 : 0 ) ;
+  //
+  auto run = [&task,&status,&errors,chunk,N] ( const std::size_t t ) 
+    {
+      try 
+      {
+        const std::size_t first = std::min ( N , t * chunk ) ;
+        const std::size_t last  = std::min ( N , first + chunk ) ;
+        if ( first < last ) { status [ t ] = task ( first , last ) ; }
+      }
+      catch ( ... ) { errors [ t ] = std::current_exception () ; }
+    } ;
+  //
+  std::vector<std::thread> threads ;
+  threads.reserve ( nt ) ;
+  for ( std::size_t t = 1 ; t < nt ; ++t ) { threads.emplace_back ( run , t ) ; }
+  // the first chunk is processed by this thread 
+  run ( 0 ) ;
+  for ( auto& t : threads ) { t.join () ; }
+  //
+  for ( const auto& e : errors ) { if ( e ) { std::rethrow_exception ( e ) ; } }
+  for ( const auto& s : status ) { if ( s.isFailure () ) { return s ; } }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
 // thrown the exception 
 // ============================================================================
 Ostap::StatusCode Ostap::Math::GSL::EigenSystem::Exception
@@ -0,0 +1,386 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <limits>
+#include <functional>
+#include <algorithm>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooArgSet.h"
+#include "RooRealVar.h"
+#include "RooGaussian.h"
+#include "RooArgProxy.h"
+#include "RooAbsCategory.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/PDFs.h"
+#include "Ostap/FFTConvolution.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+#include "local_fft.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Models::FFTConvolution
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+ClassImp(Ostap::Models::FFTConvolution)
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// the name of the first argument of PDF (usually the observable)
+  std::string first_argument ( const RooAbsArg& pdf )
+  {
+    if ( pdf.numProxies () < 1 ) { return "" ; }
+    const RooArgProxy* p = dynamic_cast<const RooArgProxy*> ( pdf.getProxy ( 0 ) ) ;
+    return nullptr != p && nullptr != p->absArg () ? p->absArg ()->GetName () : "" ;
+  }
+  // ==========================================================================
+  /// the analytic integral for the given model
+  template <class MODEL>
+  inline bool bin_integral_
+  ( const RooAbsPdf&                         pdf ,
+    std::function<double(double,double)>&    fun )
+  {
+    const MODEL* m = dynamic_cast<const MODEL*> ( &pdf ) ;
+    if ( nullptr == m ) { return false ; }
+    m->setPars () ;
+    fun = [m] ( const double a , const double b ) { return m->function ().integral ( a , b ) ; } ;
+    return true ;
+  }
+  // ==========================================================================
+  /** get the integral of the signal between two points
+   *  (for the shapes from Ostap::Models with the analytic integrals)
+   *  @param pdf the signal
+   *  @param x   the name of observable
+   *  @param fun (OUTPUT) the integral
+   */
+  bool bin_integral
+  ( const RooAbsPdf&                         pdf ,
+    const std::string&                       x   ,
+    std::function<double(double,double)>&    fun )
+  {
+    if ( x != first_argument ( pdf ) ) { return false ; }
+    using namespace Ostap::Models ;
+    return
+      bin_integral_<BreitWigner>        ( pdf , fun ) ||
+      bin_integral_<Voigt>              ( pdf , fun ) ||
+      bin_integral_<PseudoVoigt>        ( pdf , fun ) ||
+      bin_integral_<CrystalBall>        ( pdf , fun ) ||
+      bin_integral_<CrystalBallRS>      ( pdf , fun ) ||
+      bin_integral_<CrystalBallDS>      ( pdf , fun ) ||
+      bin_integral_<Needham>            ( pdf , fun ) ||
+      bin_integral_<Apollonios>         ( pdf , fun ) ||
+      bin_integral_<Apollonios2>        ( pdf , fun ) ||
+      bin_integral_<BifurcatedGauss>    ( pdf , fun ) ||
+      bin_integral_<Bukin>              ( pdf , fun ) ||
+      bin_integral_<StudentT>           ( pdf , fun ) ||
+      bin_integral_<BifurcatedStudentT> ( pdf , fun ) ||
+      bin_integral_<PolyPositive>       ( pdf , fun ) ;
+  }
+  // ==========================================================================
+  /// the key: the values of parameters
+  void add_key ( const RooListProxy& pars , std::vector<double>& key )
+  {
+    for ( const RooAbsArg* a : pars )
+    {
+      const RooAbsReal*     r = dynamic_cast<const RooAbsReal*>     ( a ) ;
+      if ( nullptr != r ) { key.push_back ( r->getVal () ) ; continue ; }
+      const RooAbsCategory* c = dynamic_cast<const RooAbsCategory*> ( a ) ;
+      if ( nullptr != c ) { key.push_back ( c->getCurrentIndex () ) ; }
+    }
+  }
+  // ==========================================================================
+  /// shallow clone of PDF, that depends on the given observable
+  RooAbsPdf* make_clone ( const RooAbsPdf& pdf , RooRealVar& x )
+  {
+    RooAbsPdf* clone = static_cast<RooAbsPdf*> ( pdf.clone ( pdf.GetName () ) ) ;
+    clone->redirectServers ( RooArgSet ( x ) , false , false ) ;
+    Ostap::Assert ( clone->dependsOn ( x )                                     ,
+                    std::string ( "PDF does not depend on observable: " ) + pdf.GetName () ,
+                    "Ostap::Models::FFTConvolution" ) ;
+    return clone ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor
+// ============================================================================
+Ostap::Models::FFTConvolution::FFTConvolution
+( const char*          name       ,
+  const char*          title      ,
+  RooAbsReal&          x          ,
+  RooAbsPdf&           pdf        ,
+  RooAbsPdf&           resolution ,
+  const unsigned int   nbins      ,
+  const double         buffer     )
+  : RooAbsPdf    ( name , title )
+  , m_x          ( "x"     , "Observable"               , this , x          )
+  , m_pdf        ( "pdf"   , "Signal"                   , this , pdf        )
+  , m_resolution ( "reso"  , "Resolution"               , this , resolution )
+  , m_spars      ( "spars" , "Parameters of signal"     , this )
+  , m_rpars      ( "rpars" , "Parameters of resolution" , this )
+  , m_nbins      ( nbins  )
+  , m_buffer     ( buffer )
+{
+  Ostap::Assert ( nullptr != dynamic_cast<RooRealVar*> ( &x ) ,
+                  "Observable must be RooRealVar"             ,
+                  "Ostap::Models::FFTConvolution"             ) ;
+  Ostap::Assert ( 16 <= m_nbins                               ,
+                  "Invalid number of bins"                    ,
+                  "Ostap::Models::FFTConvolution"             ) ;
+  Ostap::Assert ( 0 <= m_buffer                               ,
+                  "Invalid buffer fraction"                   ,
+                  "Ostap::Models::FFTConvolution"             ) ;
+  //
+  const RooArgSet observables ( x ) ;
+  std::unique_ptr<RooArgSet> sp { pdf       .getParameters ( observables ) } ;
+  std::unique_ptr<RooArgSet> rp { resolution.getParameters ( observables ) } ;
+  m_spars.add ( *sp ) ;
+  m_rpars.add ( *rp ) ;
+}
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::Models::FFTConvolution::FFTConvolution
+( const Ostap::Models::FFTConvolution& right ,
+  const char*                          name  )
+  : RooAbsPdf    ( right , name )
+  , m_x          ( "x"     , this , right.m_x          )
+  , m_pdf        ( "pdf"   , this , right.m_pdf        )
+  , m_resolution ( "reso"  , this , right.m_resolution )
+  , m_spars      ( "spars" , this , right.m_spars      )
+  , m_rpars      ( "rpars" , this , right.m_rpars      )
+  , m_nbins      ( right.m_nbins  )
+  , m_buffer     ( right.m_buffer )
+{}
+// ============================================================================
+// fake default contructor, needed just for proper (de)serialization
+// ============================================================================
+Ostap::Models::FFTConvolution::FFTConvolution () = default ;
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::Models::FFTConvolution::~FFTConvolution() {}
+// ============================================================================
+// clone
+// ============================================================================
+Ostap::Models::FFTConvolution*
+Ostap::Models::FFTConvolution::clone ( const char* name ) const
+{ return new Ostap::Models::FFTConvolution ( *this , name ) ; }
+// ============================================================================
+// create the unbounded observable and shallow clones of PDFs
+// ============================================================================
+void Ostap::Models::FFTConvolution::setup () const
+{
+  if ( m_setup ) { return ; }
+  //
+  const RooAbsPdf&   pdf  = static_cast<const RooAbsPdf&> ( m_pdf       .arg () ) ;
+  const RooAbsPdf&   reso = static_cast<const RooAbsPdf&> ( m_resolution.arg () ) ;
+  const std::string  x    = m_x.arg ().GetName () ;
+  //
+  // gaussian resolution: the analytic Fourier image
+  m_gmean  = nullptr ;
+  m_gsigma = nullptr ;
+  if ( nullptr != dynamic_cast<const RooGaussian*> ( &reso ) && x == first_argument ( reso ) && 3 <= reso.numProxies () )
+  {
+    const RooArgProxy* pm = dynamic_cast<const RooArgProxy*> ( reso.getProxy ( 1 ) ) ;
+    const RooArgProxy* ps = dynamic_cast<const RooArgProxy*> ( reso.getProxy ( 2 ) ) ;
+    const RooAbsReal*  mu = pm ? dynamic_cast<const RooAbsReal*> ( pm->absArg () ) : nullptr ;
+    const RooAbsReal*  sg = ps ? dynamic_cast<const RooAbsReal*> ( ps->absArg () ) : nullptr ;
+    if ( mu && sg && !mu->dependsOn ( m_x.arg () ) && !sg->dependsOn ( m_x.arg () ) )
+    { m_gmean = mu ; m_gsigma = sg ; }
+  }
+  //
+  // the generic sampling: the shapes are evaluated outside of the observable range
+  std::function<double(double,double)> integral ;
+  const bool asignal = bin_integral ( pdf , x , integral ) ;
+  if ( !asignal || nullptr == m_gsigma )
+  {
+    m_xx.reset ( new RooRealVar ( x.c_str () , m_x.arg ().GetTitle () , 0 ,
+                                  -std::numeric_limits<double>::max () ,
+                                  +std::numeric_limits<double>::max () ) ) ;
+    if ( !asignal         ) { m_sclone.reset ( make_clone ( pdf  , *m_xx ) ) ; }
+    if ( !m_gsigma        ) { m_rclone.reset ( make_clone ( reso , *m_xx ) ) ; }
+  }
+  //
+  m_setup = true ;
+}
+// ============================================================================
+// analytic Fourier image of the resolution?
+// ============================================================================
+bool Ostap::Models::FFTConvolution::analyticResolution () const
+{ setup () ; return nullptr != m_gsigma ; }
+// ============================================================================
+// bin-integrated sampling of the signal?
+// ============================================================================
+bool Ostap::Models::FFTConvolution::analyticSignal () const
+{ setup () ; return !m_sclone ; }
+// ============================================================================
+// sample the signal at the grid
+// ============================================================================
+void Ostap::Models::FFTConvolution::signal () const
+{
+  const std::size_t N = m_nbins ;
+  std::vector<std::complex<double> > s ( N ) ;
+  //
+  std::function<double(double,double)> integral ;
+  if ( !m_sclone && bin_integral ( static_cast<const RooAbsPdf&> ( m_pdf.arg () ) ,
+                                   m_x.arg ().GetName () , integral ) )
+  {
+    // bin-integrated values
+    for ( std::size_t k = 0 ; k < N ; ++k )
+    { s [ k ] = integral ( m_x0 + k * m_h , m_x0 + ( k + 1 ) * m_h ) / m_h ; }
+  }
+  else
+  {
+    for ( std::size_t k = 0 ; k < N ; ++k )
+    {
+      m_xx->setVal ( m_x0 + ( k + 0.5 ) * m_h ) ;
+      s [ k ] = m_sclone->getVal () ;
+    }
+  }
+  //
+  Ostap::Math::FFT::fft ( s ) ;
+  m_sfft.swap ( s ) ;
+  ++m_nsignal ;
+}
+// ============================================================================
+// sample the resolution at the grid
+// ============================================================================
+void Ostap::Models::FFTConvolution::resolution () const
+{
+  const std::size_t N = m_nbins ;
+  std::vector<std::complex<double> > r ( N ) ;
+  //
+  if ( nullptr != m_gsigma )
+  {
+    // the analytic Fourier image of the gaussian
+    static const double s_2pi = 2 * M_PI ;
+    const double mu    = m_gmean ->getVal () ;
+    const double sigma = std::abs ( m_gsigma->getVal () ) ;
+    for ( std::size_t j = 0 ; j < N ; ++j )
+    {
+      const double f = ( 2 * j <= N ? double ( j ) : double ( j ) - N ) / ( N * m_h ) ;
+      const double w = s_2pi * f ;
+      r [ j ] = std::exp ( std::complex<double> ( -0.5 * w * w * sigma * sigma , -w * mu ) ) ;
+    }
+  }
+  else
+  {
+    // sample at the (wrapped) displacements, normalize to unit sum
+    double sum = 0 ;
+    for ( std::size_t k = 0 ; k < N ; ++k )
+    {
+      const double d = ( 2 * k <= N ? double ( k ) : double ( k ) - N ) * m_h ;
+      m_xx->setVal ( d ) ;
+      const double v = m_rclone->getVal () ;
+      r [ k ] = v   ;
+      sum    += v   ;
+    }
+    Ostap::Assert ( 0 < sum                              ,
+                    "Invalid resolution function"        ,
+                    "Ostap::Models::FFTConvolution"      ) ;
+    for ( auto& v : r ) { v /= sum ; }
+    Ostap::Math::FFT::fft ( r ) ;
+  }
+  //
+  m_rfft.swap ( r ) ;
+  ++m_nresolution ;
+}
+// ============================================================================
+// update the grid, the Fourier images and the convolution (if needed)
+// ============================================================================
+void Ostap::Models::FFTConvolution::update () const
+{
+  setup () ;
+  //
+  const double xmin  = m_x.min () ;
+  const double xmax  = m_x.max () ;
+  const double delta = ( xmax - xmin ) * m_buffer ;
+  m_x0 = xmin - delta ;
+  m_h  = ( xmax - xmin + 2 * delta ) / m_nbins ;
+  //
+  // the keys: the grid and the parameters
+  std::vector<double> skey { xmin , xmax , double ( m_nbins ) , m_buffer } ;
+  std::vector<double> rkey ( skey ) ;
+  add_key ( m_spars , skey ) ;
+  add_key ( m_rpars , rkey ) ;
+  //
+  bool changed = m_values.empty () ;
+  if ( skey != m_skey || m_sfft.empty () ) { signal     () ; m_skey.swap ( skey ) ; changed = true ; }
+  if ( rkey != m_rkey || m_rfft.empty () ) { resolution () ; m_rkey.swap ( rkey ) ; changed = true ; }
+  if ( !changed ) { return ; }                                      // RETURN
+  //
+  const std::size_t N = m_nbins ;
+  std::vector<std::complex<double> > c ( N ) ;
+  for ( std::size_t j = 0 ; j < N ; ++j ) { c [ j ] = m_sfft [ j ] * m_rfft [ j ] ; }
+  Ostap::Math::FFT::fft ( c , true ) ;
+  //
+  m_values.resize ( N ) ;
+  m_cumul .resize ( N ) ;
+  for ( std::size_t k = 0 ; k < N ; ++k ) { m_values [ k ] = std::max ( 0.0 , c [ k ].real () / N ) ; }
+  m_cumul [ 0 ] = 0 ;
+  for ( std::size_t k = 1 ; k < N ; ++k )
+  { m_cumul [ k ] = m_cumul [ k - 1 ] + 0.5 * m_h * ( m_values [ k - 1 ] + m_values [ k ] ) ; }
+}
+// ============================================================================
+// the integral of the interpolated convolution from the first grid node
+// ============================================================================
+double Ostap::Models::FFTConvolution::primitive ( const double x ) const
+{
+  const std::size_t N = m_values.size () ;
+  const double      u = std::min ( double ( N - 1 ) , std::max ( 0.0 , ( x - m_x0 ) / m_h - 0.5 ) ) ;
+  const std::size_t k = std::min<std::size_t> ( N - 2 , std::size_t ( u ) ) ;
+  const double      t = u - k ;
+  const double      v0 = m_values [ k     ] ;
+  const double      v1 = m_values [ k + 1 ] ;
+  return m_cumul [ k ] + m_h * ( t * v0 + 0.5 * t * t * ( v1 - v0 ) ) ;
+}
+// ============================================================================
+// the actual evaluation of function
+// ============================================================================
+Double_t Ostap::Models::FFTConvolution::evaluate() const
+{
+  update () ;
+  //
+  const std::size_t N = m_values.size () ;
+  const double      u = ( m_x - m_x0 ) / m_h - 0.5 ;
+  if ( u <= 0           ) { return m_values.front () ; }
+  if ( N - 1 <= u       ) { return m_values.back  () ; }
+  const std::size_t k = std::size_t ( u ) ;
+  const double      t = u - k ;
+  return ( 1 - t ) * m_values [ k ] + t * m_values [ k + 1 ] ;
+}
+// ============================================================================
+Int_t Ostap::Models::FFTConvolution::getAnalyticalIntegral
+( RooArgSet&     allVars      ,
+  RooArgSet&     analVars     ,
+  const char* /* rangename */ ) const
+{
+  if ( matchArgs ( allVars , analVars , m_x ) ) { return 1 ; }
+  return 0 ;
+}
+// ============================================================================
+Double_t Ostap::Models::FFTConvolution::analyticalIntegral
+( Int_t          code         ,
+  const char*    rangeName    ) const
+{
+  assert ( code == 1 ) ;
+  if ( 1 != code ) {}
+  //
+  update () ;
+  return primitive ( m_x.max ( rangeName ) ) - primitive ( m_x.min ( rangeName ) ) ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
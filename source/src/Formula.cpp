@@ -4,6 +4,16 @@
 // STD&STL
 // ============================================================================
 #include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <limits>
 // ============================================================================
 // ROOT 
 // ============================================================================
@@ -11,10 +21,17 @@
 #include "TChain.h"
 #include "TFile.h"
 #include "TCut.h"
+#include "TLeaf.h"
+#include "TLeafC.h"
+#include "TLeafElement.h"
+#include "TBranch.h"
+#include "TInterpreter.h"
+#include "TVirtualMutex.h"
 // ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/Formula.h"
+#include "Ostap/Instrument.h"
 // ============================================================================
 // Local
 // ============================================================================
@@ -36,6 +53,290 @@ namespace
                              const TTree*       tree       ) 
   { return Ostap::tmp_name ( prefix , expression , tree , true ) ; }
   // ==========================================================================
+  /// compile new formulas? 
+  std::atomic<bool> s_jit { []() -> bool 
+      {
+        const char* env = std::getenv ( "OSTAP_JIT" ) ;
+        if ( nullptr == env ) { return false ; }
+        const std::string value { env } ;
+        return !value.empty() && value != "0" && value != "no" && value != "off" && value != "false" ;
+      } () } ;
+  // ==========================================================================
+  /// decompose new compound selections? 
+  std::atomic<bool> s_adaptive { []() -> bool 
+      {
+        const char* env = std::getenv ( "OSTAP_ADAPTIVE_CUTS" ) ;
+        if ( nullptr == env ) { return true ; }
+        const std::string value { env } ;
+        return !value.empty() && value != "0" && value != "no" && value != "off" && value != "false" ;
+      } () } ;
+  // ==========================================================================
+  /// number of the first evaluations, used to learn the order of conjuncts 
+  const unsigned long long s_LEARN  = 1024  ;
+  /// after learning: time each s_SAMPLE-th evaluation 
+  const unsigned long long s_SAMPLE = 64    ;
+  /// after learning: reorder the conjuncts each s_PERIOD evaluations
+  const unsigned long long s_PERIOD = 16384 ;
+  // ==========================================================================
+  /** split the expression into the top-level conjuncts 
+   *  - the enclosing parentheses are removed 
+   *  - the parenthesized conjuncts are split recursively 
+   *  - the expression with the top-level <code>||</code> is not split 
+   *  @return the conjuncts (the expression itself if it can't be split)
+   */
+  std::vector<std::string> conjuncts ( const std::string& expression ) 
+  {
+    // strip spaces and the enclosing parentheses 
+    std::string e { expression } ;
+    while ( true ) 
+    {
+      const std::size_t b = e.find_first_not_of ( " \t\n" ) ;
+      const std::size_t l = e.find_last_not_of  ( " \t\n" ) ;
+      if ( std::string::npos == b ) { return {} ; }                  // RETURN 
+      e = e.substr ( b , l + 1 - b ) ;
+      if ( e.size () < 2 || '(' != e.front () || ')' != e.back () ) { break ; }
+      // do the first and the last parentheses match each other? 
+      int  depth = 0     ;
+      bool outer = true  ;
+      for ( std::size_t i = 0 ; i + 1 < e.size () && outer ; ++i ) 
+      {
+        if      ( '(' == e [ i ] ) { ++depth ; }
+        else if ( ')' == e [ i ] ) { --depth ; }
+        if ( 0 == depth ) { outer = false ; }
+      }
+      if ( !outer ) { break ; }
+      e = e.substr ( 1 , e.size () - 2 ) ;
+    }
+    //
+    std::vector<std::string> parts ;
+    int         depth  = 0     ;
+    char        quote  = '\0'  ;
+    std::size_t start  = 0     ;
+    for ( std::size_t i = 0 ; i < e.size () ; ++i ) 
+    {
+      const char c = e [ i ] ;
+      if      ( '\0' != quote      ) { if ( c == quote ) { quote = '\0' ; } continue ; }
+      else if ( '"' == c || '\'' == c ) { quote = c ; continue ; }
+      else if ( '(' == c || '[' == c || '{' == c ) { ++depth ; continue ; }
+      else if ( ')' == c || ']' == c || '}' == c ) { --depth ; continue ; }
+      if ( 0 != depth || i + 1 >= e.size () || c != e [ i + 1 ] ) { continue ; }
+      if ( '|' == c ) { return { e } ; }               // RETURN: top-level "or" 
+      if ( '&' == c ) 
+      {
+        parts.push_back ( e.substr ( start , i - start ) ) ;
+        start = i + 2 ;
+        ++i ;
+      }
+    }
+    if ( 0 != depth || '\0' != quote ) { return { e } ; }          // RETURN: invalid
+    if ( parts.empty () ) { return { e } ; }                        // RETURN: no conjuncts 
+    parts.push_back ( e.substr ( start ) ) ;
+    //
+    std::vector<std::string> result ;
+    for ( const std::string& p : parts ) 
+    {
+      const std::vector<std::string> sub = conjuncts ( p ) ;
+      if ( sub.empty () ) { return { e } ; }                        // RETURN: empty conjunct 
+      result.insert ( result.end () , sub.begin () , sub.end () ) ;
+    }
+    return result ;
+  }
+  // ==========================================================================
+  /// leaf types, supported by the compiled formulas 
+  bool jit_type ( const std::string& type ) 
+  {
+    static const std::set<std::string> s_types { 
+      "Double_t" , "Float_t"   , 
+        "Int_t"  , "UInt_t"    , "Long_t"  , "ULong_t"  , 
+        "Long64_t" , "ULong64_t" , "Short_t" , "UShort_t" , 
+        "Char_t" , "UChar_t"   , "Bool_t"  } ;
+    return s_types.end () != s_types.find ( type ) ;
+  }
+  // ==========================================================================
+  /// functions, supported by the compiled formulas 
+  const std::map<std::string,std::string>& jit_functions () 
+  {
+    static const std::map<std::string,std::string> s_functions {
+      { "sqrt"  , "std::sqrt"  } , { "exp"   , "std::exp"   } , 
+      { "log"   , "std::log"   } , { "log10" , "std::log10" } , 
+      { "sin"   , "std::sin"   } , { "cos"   , "std::cos"   } , 
+      { "tan"   , "std::tan"   } , { "asin"  , "std::asin"  } , 
+      { "acos"  , "std::acos"  } , { "atan"  , "std::atan"  } , 
+      { "atan2" , "std::atan2" } , { "sinh"  , "std::sinh"  } , 
+      { "cosh"  , "std::cosh"  } , { "tanh"  , "std::tanh"  } , 
+      { "floor" , "std::floor" } , { "ceil"  , "std::ceil"  } , 
+      { "pow"   , "std::pow"   } , { "erf"   , "std::erf"   } , 
+      { "erfc"  , "std::erfc"  } , { "abs"   , "std::fabs"  } , 
+      { "fabs"  , "std::fabs"  } , { "min"   , "std::fmin"  } , 
+      { "max"   , "std::fmax"  } } ;
+    return s_functions ;
+  }
+  // ==========================================================================
+  /** translate the (simple) expression into C++ 
+   *  - leaves are replaced by <code>vN_</code> variables 
+   *  - numbers are treated as doubles, as in TTreeFormula 
+   *  - single <code>=</code> means comparison, as in TTreeFormula
+   *  @return false for unsupported expressions 
+   */
+  bool jit_translate 
+  ( const std::string&        expression , 
+    std::string&              body       , 
+    std::vector<std::string>& names      ) 
+  {
+    body.clear () ;
+    names.clear() ;
+    const std::string& e = expression ;
+    const std::size_t  n = e.size () ;
+    auto digit = [&e] ( const std::size_t k ) { return 0 != std::isdigit ( (unsigned char) e [ k ] ) ; } ;
+    auto alpha = [&e] ( const std::size_t k ) { return 0 != std::isalpha ( (unsigned char) e [ k ] ) || '_' == e [ k ] ; } ;
+    auto alnum = [&e] ( const std::size_t k ) { return 0 != std::isalnum ( (unsigned char) e [ k ] ) || '_' == e [ k ] ; } ;
+    auto space = [&e] ( const std::size_t k ) { return 0 != std::isspace ( (unsigned char) e [ k ] ) ; } ;
+    std::size_t i = 0 ;
+    while ( i < n ) 
+    {
+      const char c = e [ i ] ;
+      if ( space ( i ) ) { body += ' ' ; ++i ; continue ; }
+      // number 
+      if ( digit ( i ) || ( '.' == c && i + 1 < n && digit ( i + 1 ) ) ) 
+      {
+        std::size_t j    = i    ;
+        bool        real = false ;
+        while ( j < n && ( digit ( j ) || '.' == e [ j ] ) ) { real = real || '.' == e [ j ] ; ++j ; }
+        if ( j < n && ( 'e' == e [ j ] || 'E' == e [ j ] ) ) 
+        {
+          real = true ; ++j ;
+          if ( j < n && ( '+' == e [ j ] || '-' == e [ j ] ) ) { ++j ; }
+          if ( n <= j || !digit ( j ) ) { return false ; }
+          while ( j < n && digit ( j ) ) { ++j ; }
+        }
+        if ( j < n && alpha ( j ) ) { return false ; }  // suffixes, hex, ... 
+        body += e.substr ( i , j - i ) ;
+        if ( !real ) { body += ".0" ; }
+        i = j ;
+        continue ;
+      }
+      // identifier 
+      if ( alpha ( i ) ) 
+      {
+        std::size_t j = i ;
+        while ( j < n && alnum ( j ) ) { ++j ; }
+        const std::string name = e.substr ( i , j - i ) ;
+        // TMath functions 
+        if ( "TMath" == name && j + 2 < n && ':' == e [ j ] && ':' == e [ j + 1 ] && alpha ( j + 2 ) ) 
+        {
+          std::size_t k = j + 2 ;
+          while ( k < n && alnum ( k ) ) { ++k ; }
+          std::size_t m = k ;
+          while ( m < n && space ( m ) ) { ++m ; }
+          if ( n <= m || '(' != e [ m ] ) { return false ; }
+          body += e.substr ( i , k - i ) ;
+          i = k ;
+          continue ;
+        }
+        std::size_t m = j ;
+        while ( m < n && space ( m ) ) { ++m ; }
+        // function 
+        if ( m < n && '(' == e [ m ] ) 
+        {
+          const std::map<std::string,std::string>& functions = jit_functions () ;
+          auto f = functions.find ( name ) ;
+          if ( functions.end () == f ) { return false ; }
+          body += f->second ;
+          i = j ;
+          continue ;
+        }
+        // leaf 
+        auto it = std::find ( names.begin () , names.end () , name ) ;
+        const std::size_t index = it - names.begin () ;
+        if ( names.end () == it ) { names.push_back ( name ) ; }
+        body += "v" + std::to_string ( index ) + "_" ;
+        i = j ;
+        continue ;
+      }
+      // operators 
+      const char next = i + 1 < n ? e [ i + 1 ] : '\0' ;
+      switch ( c ) 
+      {
+      case '+' : case '-' : case '/' : case '(' : case ')' : case ',' :
+        body += c ; ++i ; break ;
+      case '*' :
+        if ( '*' == next ) { return false ; }                  // power
+        body += c ; ++i ; break ;
+      case '<' : case '>' :
+        if      ( '=' == next ) { body += c ; body += '=' ; i += 2 ; }
+        else if ( c   == next ) { return false ; }            // shifts 
+        else                    { body += c ; ++i ; }
+        break ;
+      case '=' :
+        body += "==" ; i += ( '=' == next ? 2 : 1 ) ; break ;
+      case '!' :
+        if ( '=' == next ) { body += "!=" ; i += 2 ; }
+        else               { body += '!'  ; ++i    ; }
+        break ;
+      case '&' : case '|' :
+        if ( c != next ) { return false ; }                   // bitwise 
+        body += c ; body += c ; i += 2 ; break ;
+      default:
+        return false ;
+      }
+    }
+    return !names.empty () ;
+  }
+  // ==========================================================================
+  typedef double (*jit_function) ( const void* const* ) ;
+  // ==========================================================================
+  /** compile the function (or get it from the cache) 
+   *  @param  key  the unique key (expression&types) 
+   *  @param  body the body of the function 
+   *  @return the compiled function or nullptr 
+   */
+  jit_function jit_compile 
+  ( const std::string& key  , 
+    const std::string& body ) 
+  {
+    static std::mutex                          s_mutex ;
+    static std::map<std::string,jit_function>  s_cache ;
+    std::lock_guard<std::mutex> lock ( s_mutex ) ;
+    auto found = s_cache.find ( key ) ;
+    if ( s_cache.end () != found ) { return found->second ; }  // including failures 
+    //
+    const std::string fname = "formula_" + std::to_string ( s_cache.size () ) ;
+    const std::string code  = 
+      "#include <cmath>\n#include \"TMath.h\"\n"
+      "namespace ostap_jit { double " + fname + 
+      " ( const void* const* ostap_p ) { " + body + " } }" ;
+    //
+    jit_function fun = nullptr ;
+    {
+      R__LOCKGUARD ( gInterpreterMutex ) ;
+      if ( nullptr != gInterpreter && gInterpreter->Declare ( code.c_str () ) ) 
+      {
+        const auto address = gInterpreter->Calc ( ( "(long)&ostap_jit::" + fname ).c_str () ) ;
+        fun = reinterpret_cast<jit_function> ( address ) ;
+      }
+    }
+    s_cache [ key ] = fun ;
+    return fun ;
+  }
+  // ==========================================================================
+  /// is the leaf suitable for the compiled formula? 
+  bool jit_good ( const TLeaf* leaf ) 
+  {
+    if ( nullptr == leaf                              ) { return false ; }
+    if ( leaf->InheritsFrom ( TLeafElement::Class () ) ) { return false ; }
+    if ( leaf->InheritsFrom ( TLeafC::Class       () ) ) { return false ; }
+    if ( 1 != leaf->GetLen () || nullptr != leaf->GetLeafCount () ) { return false ; }
+    return jit_type ( leaf->GetTypeName () ) ;
+  }
+  // ==========================================================================
+  /// get the leaf, suitable for the compiled formula 
+  TLeaf* jit_leaf ( TTree* tree , const std::string& name ) 
+  {
+    if ( nullptr == tree ) { return nullptr ; }
+    TLeaf* leaf = tree->GetLeaf ( name.c_str () ) ;
+    return jit_good ( leaf ) ? leaf : nullptr ;
+  }
+  // ==========================================================================
 } //                                             The end of anonymous namespace 
 // ============================================================================
 ClassImp(Ostap::Formula)
@@ -47,14 +348,22 @@ Ostap::Formula::Formula
   const std::string& expression ,
   TTree*             tree       ) 
 : TTreeFormula ( name.c_str() , expression.c_str() , tree )
-{}
+{
+  // the conjuncts are compiled individually: no need to compile the whole 
+  if ( s_adaptive && ok () && 0 == GetMultiplicity () ) { decompose_ () ; }
+  if ( s_jit && ok () && m_terms.empty () ) { compile_ () ; }  
+}
 // ============================================================================
 Ostap::Formula::Formula
 ( const std::string& name       , 
   const TCut&        expression ,
   TTree*             tree       ) 
   : TTreeFormula ( name.c_str() , expression , tree )
-{}
+{
+  // the conjuncts are compiled individually: no need to compile the whole 
+  if ( s_adaptive && ok () && 0 == GetMultiplicity () ) { decompose_ () ; }
+  if ( s_jit && ok () && m_terms.empty () ) { compile_ () ; }  
+}
 // ============================================================================
 Ostap::Formula::Formula
 ( const std::string& expression ,
@@ -80,6 +389,10 @@ Ostap::Formula::~Formula()
 // ============================================================================
 double Ostap::Formula::evaluate () // evaluate the formula 
 { 
+  OSTAP_PROBE ( "Ostap::Formula::evaluate" ) ;
+  if ( !m_terms.empty () ) { return terms_eval_ () ; }
+  if ( m_jit ) { return jit_eval_ () ; }
+  if ( m_stale ) { TTreeFormula::Notify () ; m_stale = false ; }
   const Int_t d = GetNdata() ; 
   Ostap::Assert ( 1 == d , 
                   "evaluate: scalar call for GetNdata()!=1 function" , 
@@ -92,6 +405,10 @@ double Ostap::Formula::evaluate () // evaluate the formula
 // ============================================================================
 double Ostap::Formula::evaluate ( const unsigned short i ) // evaluate the formula 
 { 
+  OSTAP_PROBE ( "Ostap::Formula::evaluate" ) ;
+  if ( !m_terms.empty () && 0 == i ) { return terms_eval_ () ; }
+  if ( m_jit && 0 == i ) { return jit_eval_ () ; }
+  if ( m_stale ) { TTreeFormula::Notify () ; m_stale = false ; }
   const Int_t d = GetNdata() ; 
   Ostap::Assert ( i  < d ,
                   "evaluate: invalid instance counter" , 
@@ -104,11 +421,226 @@ double Ostap::Formula::evaluate ( const unsigned short i ) // evaluate the formu
 // ============================================================================
 Int_t Ostap::Formula::evaluate ( std::vector<double>& results ) 
 { 
+  OSTAP_PROBE ( "Ostap::Formula::evaluate" ) ;
+  if ( !m_terms.empty () ) { results.assign ( 1 , terms_eval_ () ) ; return 1 ; }
+  if ( m_jit ) { results.assign ( 1 , jit_eval_ () ) ; return 1 ; }
+  if ( m_stale ) { TTreeFormula::Notify () ; m_stale = false ; }
   const Int_t d = GetNdata() ; 
   results.resize ( d ) ;
   for ( Int_t i = 0 ; i < d ; ++i ) { results [ i ] = EvalInstance ( i ) ; }
   return d ;  
 }
 // ============================================================================
+// compile the new formulas?
+// ============================================================================
+bool Ostap::Formula::jit    () { return s_jit ; }
+// ============================================================================
+// compile the new formulas?
+// ============================================================================
+void Ostap::Formula::setJIT ( const bool value ) { s_jit = value ; }
+// ============================================================================
+// decompose the new compound selections? 
+// ============================================================================
+bool Ostap::Formula::adaptive    () { return s_adaptive ; }
+// ============================================================================
+// decompose the new compound selections? 
+// ============================================================================
+void Ostap::Formula::setAdaptive ( const bool value ) { s_adaptive = value ; }
+// ============================================================================
+// the conjuncts in the current order of evaluation 
+// ============================================================================
+std::vector<std::string> Ostap::Formula::terms () const 
+{
+  std::vector<std::string> result ;
+  for ( const unsigned short k : m_order ) { result.push_back ( m_terms [ k ]->GetTitle () ) ; }
+  return result ;
+}
+// ============================================================================
+// update the leaves (e.g. for the new tree in chain) 
+// ============================================================================
+Bool_t Ostap::Formula::Notify () 
+{
+  /// the conjuncts are notified independently 
+  for ( auto& t : m_terms ) { t->Notify () ; }
+  /// for the compiled formula it is enough to re-point the leaf buffers 
+  if ( m_jit && bind_ () ) { m_stale = true ; return kTRUE ; }
+  m_jit   = nullptr ;
+  m_stale = false   ;
+  return TTreeFormula::Notify () ;
+}
+// ============================================================================
+// try to compile the expression 
+// ============================================================================
+void Ostap::Formula::compile_ () 
+{
+  m_jit = nullptr ;
+  //
+  std::string expression { GetTitle () } ;
+  std::string body ;
+  if ( !jit_translate ( expression , body , m_names ) ) { return ; }
+  //
+  TTree* tree = GetTree () ;
+  m_types.clear () ;
+  std::string key  ;
+  std::string vars ;
+  for ( std::size_t i = 0 ; i < m_names.size () ; ++i ) 
+  {
+    const TLeaf* leaf = jit_leaf ( tree , m_names [ i ] ) ;
+    if ( nullptr == leaf ) { return ; }
+    m_types.push_back ( leaf->GetTypeName () ) ;
+    key  += m_types.back () + ";" ;
+    vars += "const double v" + std::to_string ( i ) + "_ = *static_cast<const " 
+      + m_types.back () + "*> ( ostap_p [ " + std::to_string ( i ) + " ] ) ; " ;
+  }
+  key += body ;
+  //
+  const jit_function fun = jit_compile ( key , vars + "return static_cast<double> ( " + body + " ) ;" ) ;
+  if ( nullptr == fun ) { return ; }
+  //
+  m_jit = fun ;
+  if ( !bind_ () ) { m_jit = nullptr ; }
+}
+// ============================================================================
+// bind the leaves for the compiled function 
+// ============================================================================
+bool Ostap::Formula::bind_ () 
+{
+  m_leaves.clear () ;
+  m_ptrs  .clear () ;
+  m_entry = -1 ;
+  TTree* tree = GetTree () ;
+  if ( nullptr == tree ) { return false ; }
+  const TObjArray* leaves = tree->GetListOfLeaves () ;
+  m_index.resize ( m_names.size () , -1 ) ;
+  for ( std::size_t i = 0 ; i < m_names.size () ; ++i ) 
+  {
+    TLeaf* leaf = nullptr ;
+    /// the same structure of the trees in chain: try the cached position first 
+    const int index = m_index [ i ] ;
+    if ( nullptr != leaves && 0 <= index && index <= leaves->GetLast () ) 
+    {
+      TLeaf* candidate = static_cast<TLeaf*> ( leaves->UncheckedAt ( index ) ) ;
+      if ( nullptr != candidate && m_names [ i ] == candidate->GetName () && 
+           jit_good ( candidate ) ) { leaf = candidate ; }
+    }
+    if ( nullptr == leaf ) 
+    {
+      leaf = jit_leaf ( tree , m_names [ i ] ) ;
+      m_index [ i ] = ( nullptr != leaf && nullptr != leaves ) ? leaves->IndexOf ( leaf ) : -1 ;
+    }
+    if ( nullptr == leaf || m_types [ i ] != leaf->GetTypeName () ) { return false ; }
+    m_leaves.push_back ( leaf ) ;
+    m_ptrs  .push_back ( leaf->GetValuePointer () ) ;
+  }
+  return true ;
+}
+// ============================================================================
+// evaluate the compiled function 
+// ============================================================================
+double Ostap::Formula::jit_eval_ () 
+{
+  const Long64_t entry = m_leaves.front ()->GetBranch ()->GetTree ()->GetReadEntry () ;
+  if ( entry != m_entry ) 
+  {
+    for ( std::size_t i = 0 ; i < m_leaves.size () ; ++i ) 
+    {
+      TBranch* branch = m_leaves [ i ]->GetBranch () ;
+      branch->GetEntry ( branch->GetTree ()->GetReadEntry () ) ;
+      m_ptrs [ i ] = m_leaves [ i ]->GetValuePointer () ; // address could be redefined 
+    }
+    m_entry = entry ;
+  }
+  return (*m_jit) ( m_ptrs.data () ) ;
+}
+// ============================================================================
+// try to decompose the expression into conjuncts 
+// ============================================================================
+void Ostap::Formula::decompose_ () 
+{
+  m_terms.clear () ;
+  const std::vector<std::string> parts = conjuncts ( GetTitle () ) ;
+  if ( parts.size () < 2 || std::numeric_limits<unsigned short>::max () < parts.size () ) { return ; }
+  //
+  TTree* tree = GetTree () ;
+  std::vector<std::unique_ptr<Formula> > terms ;
+  for ( const std::string& p : parts ) 
+  {
+    auto t = std::make_unique<Formula> ( p , tree ) ;
+    if ( !t->ok () || 0 != t->GetMultiplicity () ) { return ; }     // RETURN 
+    terms.push_back ( std::move ( t ) ) ;
+  }
+  //
+  const std::size_t n = terms.size () ;
+  m_terms   = std::move ( terms ) ;
+  m_calls   .assign ( n , 0.0 ) ;
+  m_rejects .assign ( n , 0.0 ) ;
+  m_time    .assign ( n , 0.0 ) ;
+  m_timed   .assign ( n , 0.0 ) ;
+  m_order   .clear  () ;
+  for ( std::size_t k = 0 ; k < n ; ++k ) { m_order.push_back ( k ) ; }
+  m_nevals  = 0 ;
+}
+// ============================================================================
+// evaluate the conjuncts in the adaptive order 
+// ============================================================================
+double Ostap::Formula::terms_eval_ () 
+{
+  typedef std::chrono::steady_clock clock ;
+  ++m_nevals ;
+  const bool timed = m_nevals <= s_LEARN || 0 == m_nevals % s_SAMPLE ;
+  //
+  double result = 1 ;
+  for ( const unsigned short k : m_order ) 
+  {
+    double value = 0 ;
+    if ( timed ) 
+    {
+      const auto start = clock::now () ;
+      value = m_terms [ k ]->evaluate () ;
+      m_time  [ k ] += std::chrono::duration<double> ( clock::now () - start ).count () ;
+      m_timed [ k ] += 1 ;
+    }
+    else { value = m_terms [ k ]->evaluate () ; }
+    //
+    m_calls [ k ] += 1 ;
+    if ( !value ) { m_rejects [ k ] += 1 ; result = 0 ; break ; }
+  }
+  //
+  if ( s_LEARN == m_nevals || 
+       ( s_LEARN < m_nevals && 0 == ( m_nevals - s_LEARN ) % s_PERIOD ) ) { reorder_ () ; }
+  //
+  return result ;
+}
+// ============================================================================
+// reorder the conjuncts according to the collected statistics  
+// - the cheapest conjuncts per rejection go first 
+// - the conjuncts without rejections keep their order at the end 
+// ============================================================================
+void Ostap::Formula::reorder_ () 
+{
+  const std::size_t n = m_terms.size () ;
+  std::vector<double> rank ( n , std::numeric_limits<double>::max () ) ;
+  for ( std::size_t k = 0 ; k < n ; ++k ) 
+  {
+    if ( 0 < m_calls [ k ] && 0 < m_rejects [ k ] ) 
+    {
+      const double cost = 0 < m_timed [ k ] ? m_time [ k ] / m_timed [ k ] : 0.0 ;
+      rank [ k ] = cost * m_calls [ k ] / m_rejects [ k ] ;
+    }
+  }
+  std::stable_sort ( m_order.begin () , m_order.end () , 
+                     [&rank] ( const unsigned short a , const unsigned short b ) 
+                     { return rank [ a ] < rank [ b ] ; } ) ;
+  //
+  // forget the old statistics gradually to follow the changes in data 
+  for ( std::size_t k = 0 ; k < n ; ++k ) 
+  {
+    m_calls   [ k ] *= 0.5 ;
+    m_rejects [ k ] *= 0.5 ;
+    m_time    [ k ] *= 0.5 ;
+    m_timed   [ k ] *= 0.5 ;
+  }
+}
+// ============================================================================
 //                                                                      The END 
 // ============================================================================
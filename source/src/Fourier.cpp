@@ -4,6 +4,8 @@
 // STD & STL 
 // ============================================================================
 #include <limits>
+#include <complex>
+#include <cmath>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -15,6 +17,7 @@
 // ============================================================================
 #include "Exception.h"
 #include "local_math.h"
+#include "local_fft.h"
 // ============================================================================
 /** @file
  *  Implementation file for functions from the file Ostap/Fourier.h
@@ -448,6 +451,78 @@ double Ostap::Math::FourierSum::regularization
   return std::sqrt ( -2 * std::log ( delta ) ) * m_scale / std::abs ( sigma ) ;
 }
 // ============================================================================
+/*  evaluate the sum at N equidistant points using FFT
+ *  \f$ x_i = x_{min} + i \frac{x_{max}-x_{min}}{N}\f$, \f$ 0 \le i < N \f$
+ *  - \f$ t_i = -\pi + \frac{2\pi i}{N}\f$, 
+ *  - \f$ f_i = \Re \sum_k (-1)^k \left( a_k - i b_k \right) e^{2\pi i ki/N}\f$
+ *  - harmonics with \f$ k \ge N\f$ are folded (aliased)
+ *  - Fejer weights are the same as for the Clenshaw summation 
+ */
+// ============================================================================
+std::vector<double> 
+Ostap::Math::FourierSum::values ( const unsigned int N ) const 
+{
+  Ostap::Assert ( 1 <= N                          , 
+                  "Invalid number of points"      ,
+                  "Ostap::Math::FourierSum::values" ) ;
+  //
+  std::vector<std::complex<double> > c ( N , 0.0 ) ;
+  //
+  const unsigned long np = m_pars.size() ;
+  const long double   fd = 1.0L / ( np + 1 ) ;
+  //
+  c [ 0 ] += 0.5 * m_pars [ 0 ] ;
+  for ( unsigned short k = 1 ; 2 * k < np ; ++k  ) 
+  {
+    const double w = m_fejer ? 2 * ( degree () + 1 - k ) * fd : 1.0 ;
+    const double f = 0 == k % 2 ? w : -w ;
+    c [ k % N ]   += f * std::complex<double> ( m_pars [ 2 * k ] , -m_pars [ 2 * k - 1 ] ) ;
+  }
+  //
+  Ostap::Math::FFT::fft ( c , true ) ;
+  //
+  std::vector<double> result ( N ) ;
+  for ( unsigned int i = 0 ; i < N ; ++i ) { result [ i ] = c [ i ].real () ; }
+  return result ;
+}
+// ============================================================================
+/*  create the Fourier sum from the function values sampled at N 
+ *  equidistant points (the trigonometric interpolation) using FFT 
+ *  \f$ x_i = x_{min} + i \frac{x_{max}-x_{min}}{N}\f$, \f$ 0 \le i < N \f$
+ */
+// ============================================================================
+Ostap::Math::FourierSum
+Ostap::Math::FourierSum::fit
+( const std::vector<double>& values , 
+  const unsigned short       degree , 
+  const double               xmin   , 
+  const double               xmax   , 
+  const bool                 fejer  ) 
+{
+  const std::size_t N = values.size() ;
+  Ostap::Assert ( 1 <= N && 2 * degree <= N      ,
+                  "Invalid number of points"     ,
+                  "Ostap::Math::FourierSum::fit" ) ;
+  //
+  std::vector<std::complex<double> > c ( values.begin () , values.end () ) ;
+  Ostap::Math::FFT::fft ( c , false ) ;
+  //
+  FourierSum result ( degree , xmin , xmax , fejer ) ;
+  //
+  const double scale = 2.0 / N ;
+  result.setPar ( 0 , scale * c [ 0 ].real () ) ;
+  for ( unsigned short k = 1 ; k <= degree ; ++k ) 
+  { 
+    // the Nyquist harmonic  
+    const double f    = 2 * k == N ? 0.5 * scale : scale ;
+    const double sign = 0 == k % 2 ? 1.0 : -1.0 ;
+    result.setA ( k ,  sign * f * c [ k ].real () ) ;
+    if ( 2 * k < N ) { result.setB ( k , -sign * f * c [ k ].imag () ) ; }
+  }
+  //
+  return result ;
+}
+// ============================================================================
 // simple  manipulations with polynoms: scale it! 
 // ============================================================================
 Ostap::Math::FourierSum&
@@ -848,6 +923,76 @@ double Ostap::Math::CosineSum::regularization
   return std::sqrt ( -2 * std::log ( delta ) ) * m_scale / std::abs ( sigma ) ;
 }
 // ============================================================================
+/*  evaluate the sum at N+1 equidistant points using FFT
+ *  \f$ x_i = x_{min} + i \frac{x_{max}-x_{min}}{N}\f$, \f$ 0 \le i \le N \f$
+ *  - \f$ t_i = \frac{\pi i}{N}\f$, 
+ *  - \f$ f_i = \Re \sum_k a_k e^{2\pi i ki/2N}\f$
+ *  - harmonics with \f$ k \ge 2N\f$ are folded (aliased)
+ *  - Fejer weights are the same as for the Clenshaw summation 
+ */
+// ============================================================================
+std::vector<double> 
+Ostap::Math::CosineSum::values ( const unsigned int N ) const 
+{
+  Ostap::Assert ( 1 <= N                         , 
+                  "Invalid number of intervals"  ,
+                  "Ostap::Math::CosineSum::values" ) ;
+  //
+  const unsigned int M = 2 * N ;
+  std::vector<std::complex<double> > c ( M , 0.0 ) ;
+  //
+  const unsigned long np = m_pars.size() ;
+  const long double   fd = 1.0L / np ;
+  //
+  c [ 0 ] += 0.5 * m_pars [ 0 ] ;
+  for ( unsigned short k = 1 ; k < np ; ++k  ) 
+  { c [ k % M ] += ( m_fejer ? ( np - k ) * fd : 1.0L ) * m_pars [ k ] ; }
+  //
+  Ostap::Math::FFT::fft ( c , true ) ;
+  //
+  std::vector<double> result ( N + 1 ) ;
+  for ( unsigned int i = 0 ; i <= N ; ++i ) { result [ i ] = c [ i ].real () ; }
+  return result ;
+}
+// ============================================================================
+/*  create the cosine sum from the function values sampled at N+1
+ *  equidistant points (the cosine interpolation) using FFT (DCT-I)
+ *  \f$ x_i = x_{min} + i \frac{x_{max}-x_{min}}{N}\f$, \f$ 0 \le i \le N \f$
+ */
+// ============================================================================
+Ostap::Math::CosineSum
+Ostap::Math::CosineSum::fit
+( const std::vector<double>& values , 
+  const unsigned short       degree , 
+  const double               xmin   , 
+  const double               xmax   , 
+  const bool                 fejer  ) 
+{
+  Ostap::Assert ( 2 <= values.size () && degree < values.size () ,
+                  "Invalid number of points"     ,
+                  "Ostap::Math::CosineSum::fit"  ) ;
+  //
+  const std::size_t N = values.size() - 1 ;
+  //
+  // DCT-I via FFT of the even extension 
+  std::vector<std::complex<double> > c ( 2 * N , 0.0 ) ;
+  for ( std::size_t i = 0 ; i <= N    ; ++i ) { c [ i         ] = values [ i ] ; }
+  for ( std::size_t i = 1 ; i <  N    ; ++i ) { c [ 2 * N - i ] = values [ i ] ; }
+  Ostap::Math::FFT::fft ( c , false ) ;
+  //
+  CosineSum result ( degree , xmin , xmax , fejer ) ;
+  //
+  const double scale = 1.0 / N ;
+  for ( unsigned short k = 0 ; k <= degree ; ++k ) 
+  {
+    // the last term for the interpolation 
+    const double f = k == N ? 0.5 * scale : scale ;
+    result.setPar ( k , f * c [ k ].real () ) ;
+  }
+  //
+  return result ;
+}
+// ============================================================================
 // simple  manipulations with polynoms: scale it! 
 // ============================================================================
 Ostap::Math::CosineSum&
@@ -1115,6 +1260,54 @@ Ostap::Math::sum
 ( const Ostap::Math::CosineSum& s1 , 
   const Ostap::Math::CosineSum& s2 ) { return s1.sum ( s2 ) ; }
 // ============================================================================
+/*  convolve the function values, sampled at equidistant points 
+ *  with gaussian in the spectral domain using FFT
+ *  - the transfer function is 
+ *   \f$ H_k = \exp { -\frac{1}{2} \left( \frac{2\pi k \sigma}{M h} \right)^2 }\f$
+ *  - for non-periodic data the array is padded with zeroes to the length 
+ *    \f$ M \ge N + 12\frac{\sigma}{h} \f$
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-02-01
+ */
+// ============================================================================
+std::vector<double> 
+Ostap::Math::gauss_convolve 
+( const std::vector<double>& values   , 
+  const double               sigma    , 
+  const double               xmin     , 
+  const double               xmax     , 
+  const bool                 periodic ) 
+{
+  const std::size_t N = values.size () ;
+  if ( 0 == N || s_zero ( sigma ) ) { return values ; }
+  //
+  const double h  = std::abs ( xmax - xmin ) / N ;
+  Ostap::Assert ( 0 < h                      ,
+                  "Invalid interval"         ,
+                  "Ostap::Math::gauss_convolve" ) ;
+  //
+  const double      sh = std::abs ( sigma ) / h ;  // sigma in units of step 
+  const std::size_t M  = periodic ? N : 
+    Ostap::Math::FFT::next_pow2 ( N + 2 * static_cast<std::size_t> ( std::ceil ( 6 * sh ) ) ) ;
+  //
+  std::vector<std::complex<double> > c ( M , 0.0 ) ;
+  std::copy ( values.begin () , values.end () , c.begin () ) ;
+  Ostap::Math::FFT::fft ( c , false ) ;
+  //
+  const double a = M_PI * sh / M ;
+  for ( std::size_t k = 0 ; k < M ; ++k ) 
+  {
+    const std::size_t kk = std::min ( k , M - k ) ;
+    c [ k ] *= std::exp ( -2 * a * a * kk * kk ) / M ;
+  }
+  //
+  Ostap::Math::FFT::fft ( c , true ) ;
+  //
+  std::vector<double> result ( N ) ;
+  for ( std::size_t i = 0 ; i < N ; ++i ) { result [ i ] = c [ i ].real () ; }
+  return result ;
+}
+// ============================================================================
 //                                                                      The END 
 // ============================================================================
 
@@ -0,0 +1,244 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Bernstein.h"
+#include "Ostap/Bernstein1D.h"
+#include "Ostap/BSpline.h"
+#include "Ostap/FrozenBasis.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "bernstein_utils.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Math::FrozenBasis
+ *  @see Ostap::Math::FrozenBasis
+ *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+ *  @date 2023-01-28
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /** fill the matrix of bin integrals using the copy of the function
+   *  with unit parameters
+   */
+  template <class FUNCTION>
+  void _integrals_
+  ( FUNCTION                   f      ,
+    const std::vector<double>& low    ,
+    const std::vector<double>& high   ,
+    std::vector<double>&       matrix )
+  {
+    const std::size_t N = low.size () ;
+    const std::size_t n = f.npars  () ;
+    for ( std::size_t j = 0 ; j < n ; ++j ) { f.setPar ( j , 0.0 ) ; }
+    for ( std::size_t j = 0 ; j < n ; ++j )
+    {
+      f.setPar ( j , 1.0 ) ;
+      double* column = matrix.data () + j * N ;
+      for ( std::size_t i = 0 ; i < N ; ++i )
+      { column [ i ] = f.integral ( low [ i ] , high [ i ] ) ; }
+      f.setPar ( j , 0.0 ) ;
+    }
+  }
+  // ==========================================================================
+}
+// ============================================================================
+/*  create the basis matrix for Bernstein polynomial
+ *  \f$ M_{ij} = b_j(x_i) \f$
+ *  @param b (INPUT) Bernstein polynomial
+ *  @param x (INPUT) the points
+ */
+// ============================================================================
+Ostap::Math::FrozenBasis::FrozenBasis
+( const Ostap::Math::Bernstein&  b    ,
+  const std::vector<double>&     x    )
+  : m_npoints ( x.size ()  )
+  , m_nbasis  ( b.npars () )
+  , m_matrix  ( x.size () * b.npars () , 0.0 )
+{
+  const unsigned short N = b.degree () ;
+  Ostap::Math::Utils::Buffer basis ( N + 1 ) ;
+  for ( std::size_t i = 0 ; i < m_npoints ; ++i )
+  {
+    const double xi = x [ i ] ;
+    if ( xi < b.xmin () || xi > b.xmax () ) { continue ; }
+    const long double t0 = b.t ( xi ) ;
+    Ostap::Math::Utils::bernstein_basis ( N , t0 , 1 - t0 , basis.data () ) ;
+    for ( unsigned short j = 0 ; j <= N ; ++j )
+    { m_matrix [ j * m_npoints + i ] = basis [ j ] ; }
+  }
+}
+// ============================================================================
+/*  create the matrix of bin integrals for Bernstein polynomial
+ *  \f$ M_{ij} = \int_{x^{low}_i}^{x^{high}_i} b_j(x)dx \f$
+ *  @param b    (INPUT) Bernstein polynomial
+ *  @param low  (INPUT) low  edges of bins
+ *  @param high (INPUT) high edges of bins
+ */
+// ============================================================================
+Ostap::Math::FrozenBasis::FrozenBasis
+( const Ostap::Math::Bernstein&  b    ,
+  const std::vector<double>&     low  ,
+  const std::vector<double>&     high )
+  : m_npoints ( low.size () )
+  , m_nbasis  ( b.npars  () )
+  , m_matrix  ( low.size () * b.npars () , 0.0 )
+{
+  Ostap::Assert ( low.size () == high.size () ,
+                  "Mismatch in low/high sizes" ,
+                  "Ostap::Math::FrozenBasis"   ) ;
+  _integrals_ ( b , low , high , m_matrix ) ;
+}
+// ============================================================================
+// create the basis matrix for positive polynomial
+// ============================================================================
+Ostap::Math::FrozenBasis::FrozenBasis
+( const Ostap::Math::Positive&   p    ,
+  const std::vector<double>&     x    )
+  : FrozenBasis ( p.bernstein () , x )
+{}
+// ============================================================================
+// create the matrix of bin integrals for positive polynomial
+// ============================================================================
+Ostap::Math::FrozenBasis::FrozenBasis
+( const Ostap::Math::Positive&   p    ,
+  const std::vector<double>&     low  ,
+  const std::vector<double>&     high )
+  : FrozenBasis ( p.bernstein () , low , high )
+{}
+// ============================================================================
+/*  create the basis matrix for B-spline
+ *  \f$ M_{ij} = B_j(x_i) \f$
+ *  @param b (INPUT) B-spline
+ *  @param x (INPUT) the points
+ */
+// ============================================================================
+Ostap::Math::FrozenBasis::FrozenBasis
+( const Ostap::Math::BSpline&    b    ,
+  const std::vector<double>&     x    )
+  : m_npoints ( x.size ()  )
+  , m_nbasis  ( b.npars () )
+  , m_matrix  ( x.size () * b.npars () , 0.0 )
+{
+  Ostap::Math::BSpline f ( b ) ;
+  for ( std::size_t j = 0 ; j < m_nbasis ; ++j ) { f.setPar ( j , 0.0 ) ; }
+  for ( std::size_t j = 0 ; j < m_nbasis ; ++j )
+  {
+    f.setPar ( j , 1.0 ) ;
+    double* column = m_matrix.data () + j * m_npoints ;
+    for ( std::size_t i = 0 ; i < m_npoints ; ++i ) { column [ i ] = f ( x [ i ] ) ; }
+    f.setPar ( j , 0.0 ) ;
+  }
+}
+// ============================================================================
+/*  create the matrix of bin integrals for B-spline
+ *  \f$ M_{ij} = \int_{x^{low}_i}^{x^{high}_i} B_j(x)dx \f$
+ *  @param b    (INPUT) B-spline
+ *  @param low  (INPUT) low  edges of bins
+ *  @param high (INPUT) high edges of bins
+ */
+// ============================================================================
+Ostap::Math::FrozenBasis::FrozenBasis
+( const Ostap::Math::BSpline&    b    ,
+  const std::vector<double>&     low  ,
+  const std::vector<double>&     high )
+  : m_npoints ( low.size () )
+  , m_nbasis  ( b.npars  () )
+  , m_matrix  ( low.size () * b.npars () , 0.0 )
+{
+  Ostap::Assert ( low.size () == high.size () ,
+                  "Mismatch in low/high sizes" ,
+                  "Ostap::Math::FrozenBasis"   ) ;
+  _integrals_ ( b , low , high , m_matrix ) ;
+}
+// ============================================================================
+// create the basis matrix for positive spline
+// ============================================================================
+Ostap::Math::FrozenBasis::FrozenBasis
+( const Ostap::Math::PositiveSpline& p    ,
+  const std::vector<double>&         x    )
+  : FrozenBasis ( p.bspline () , x )
+{}
+// ============================================================================
+// create the matrix of bin integrals for positive spline
+// ============================================================================
+Ostap::Math::FrozenBasis::FrozenBasis
+( const Ostap::Math::PositiveSpline& p    ,
+  const std::vector<double>&         low  ,
+  const std::vector<double>&         high )
+  : FrozenBasis ( p.bspline () , low , high )
+{}
+// ============================================================================
+/*  evaluate the function at all points
+ *  @param pars   (INPUT)  parameters: at least nbasis() elements
+ *  @param result (UPDATE) result: at least npoints() elements
+ */
+// ============================================================================
+void Ostap::Math::FrozenBasis::evaluate
+( const double* pars   ,
+  double*       result ) const
+{
+  std::fill ( result , result + m_npoints , 0.0 ) ;
+  for ( std::size_t j = 0 ; j < m_nbasis ; ++j )
+  {
+    const double a = pars [ j ] ;
+    if ( 0 == a ) { continue ; }
+    const double* column = m_matrix.data () + j * m_npoints ;
+    // "axpy": no reduction here, the loop is vectorized
+    for ( std::size_t i = 0 ; i < m_npoints ; ++i ) { result [ i ] += a * column [ i ] ; }
+  }
+}
+// ============================================================================
+// evaluate the function at all points
+// ============================================================================
+std::vector<double>
+Ostap::Math::FrozenBasis::evaluate
+( const std::vector<double>& pars ) const
+{
+  Ostap::Assert ( m_nbasis <= pars.size () ,
+                  "Invalid size of parameters" ,
+                  "Ostap::Math::FrozenBasis"   ) ;
+  std::vector<double> result ( m_npoints , 0.0 ) ;
+  evaluate ( pars.data () , result.data () ) ;
+  return result ;
+}
+// ============================================================================
+// evaluate Bernstein polynomial at all points
+// ============================================================================
+std::vector<double>
+Ostap::Math::FrozenBasis::evaluate
+( const Ostap::Math::Bernstein&      b ) const
+{ return evaluate ( b.pars () ) ; }
+// ============================================================================
+// evaluate positive polynomial at all points
+// ============================================================================
+std::vector<double>
+Ostap::Math::FrozenBasis::evaluate
+( const Ostap::Math::Positive&       p ) const
+{ return evaluate ( p.bernstein ().pars () ) ; }
+// ============================================================================
+// evaluate B-spline at all points
+// ============================================================================
+std::vector<double>
+Ostap::Math::FrozenBasis::evaluate
+( const Ostap::Math::BSpline&        b ) const
+{ return evaluate ( b.pars () ) ; }
+// ============================================================================
+// evaluate positive spline at all points
+// ============================================================================
+std::vector<double>
+Ostap::Math::FrozenBasis::evaluate
+( const Ostap::Math::PositiveSpline& p ) const
+{ return evaluate ( p.bspline ().pars () ) ; }
+// ============================================================================
+//                                                                      The END
+// ============================================================================
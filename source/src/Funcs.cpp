@@ -1,6 +1,10 @@
 // ============================================================================
 // Include files
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+// ============================================================================
 // local
 // ============================================================================
 #include "Ostap/Funcs.h"
@@ -9,6 +13,7 @@
 #include "Ostap/StatusCode.h"
 #include "Ostap/HFuncs.h"
 #include "Ostap/FormulaVar.h"
+#include "Ostap/Notifier.h"
 // ============================================================================
 // Root
 // ============================================================================
@@ -126,6 +131,41 @@ double Ostap::Functions::FuncFormula::operator() ( const TTree* tree ) const
   //
   return m_formula->evaluate() ;
 }
+// ============================================================================
+/*  evaluate the formula for the block of entries [first,last)
+ *  the tree is checked and the formulas are prepared only once
+ *  @see Ostap::IFuncTree::evaluate_range 
+ */
+// ============================================================================
+unsigned long Ostap::Functions::FuncFormula::evaluate_range 
+( const TTree*        tree   ,
+  const unsigned long first  , 
+  const unsigned long last   , 
+  double*             result ) const 
+{
+  if ( nullptr == tree || nullptr == result ) { return 0 ; }
+  TTree* t = const_cast<TTree*> ( tree ) ;
+  const unsigned long the_last = 
+    std::min ( last , static_cast<unsigned long> ( t->GetEntries () ) ) ;
+  if ( the_last <= first ) { return 0 ; }
+  //
+  // track the files of the chain 
+  Ostap::Utils::Notifier notifier ( t , const_cast<FuncFormula*> ( this ) ) ;
+  //
+  if ( t->LoadTree ( first ) < 0 ) { return 0 ; }
+  // the first entry: all checks and preparation of formulas 
+  result [ 0 ] = (*this) ( tree ) ;
+  //
+  unsigned long n = 1 ;
+  for ( unsigned long entry = first + 1 ; entry < the_last ; ++entry , ++n ) 
+  {
+    if ( t->LoadTree ( entry ) < 0 ) { break ; }
+    // new file in the chain: formulas are recreated 
+    if ( !m_formula ) { result [ n ] = (*this) ( tree ) ; continue ; }
+    result [ n ] = m_formula->evaluate () ;
+  }
+  return n ;
+}
 // ===========================================================================
 /* constructor from the formula expression 
  *  @param expression the formula expression 
@@ -286,6 +326,41 @@ double Ostap::Functions::Func1D::operator() ( const TTree* tree ) const
   return m_fun ( xvar ) ;
 }
 // ============================================================================
+/*  evaluate the function for the block of entries [first,last)
+ *  the tree is checked and the formulas are prepared only once
+ *  @see Ostap::IFuncTree::evaluate_range 
+ */
+// ============================================================================
+unsigned long Ostap::Functions::Func1D::evaluate_range 
+( const TTree*        tree   ,
+  const unsigned long first  , 
+  const unsigned long last   , 
+  double*             result ) const 
+{
+  if ( nullptr == tree || nullptr == result ) { return 0 ; }
+  TTree* t = const_cast<TTree*> ( tree ) ;
+  const unsigned long the_last = 
+    std::min ( last , static_cast<unsigned long> ( t->GetEntries () ) ) ;
+  if ( the_last <= first ) { return 0 ; }
+  //
+  // track the files of the chain 
+  Ostap::Utils::Notifier notifier ( t , const_cast<Func1D*> ( this ) ) ;
+  //
+  if ( t->LoadTree ( first ) < 0 ) { return 0 ; }
+  // the first entry: all checks and preparation of formulas 
+  result [ 0 ] = (*this) ( tree ) ;
+  //
+  unsigned long n = 1 ;
+  for ( unsigned long entry = first + 1 ; entry < the_last ; ++entry , ++n ) 
+  {
+    if ( t->LoadTree ( entry ) < 0 ) { break ; }
+    // new file in the chain: formulas are recreated 
+    if ( !m_xvar ) { result [ n ] = (*this) ( tree ) ; continue ; }
+    result [ n ] = m_fun ( m_xvar->evaluate () ) ;
+  }
+  return n ;
+}
+// ============================================================================
 // copy constructor 
 // ============================================================================
 Ostap::Functions::Func2D::Func2D
@@ -389,6 +464,43 @@ double Ostap::Functions::Func2D::operator() ( const TTree* tree ) const
   return m_fun ( xvar , yvar ) ;
 }
 // ============================================================================
+/*  evaluate the function for the block of entries [first,last)
+ *  the tree is checked and the formulas are prepared only once
+ *  @see Ostap::IFuncTree::evaluate_range 
+ */
+// ============================================================================
+unsigned long Ostap::Functions::Func2D::evaluate_range 
+( const TTree*        tree   ,
+  const unsigned long first  , 
+  const unsigned long last   , 
+  double*             result ) const 
+{
+  if ( nullptr == tree || nullptr == result ) { return 0 ; }
+  TTree* t = const_cast<TTree*> ( tree ) ;
+  const unsigned long the_last = 
+    std::min ( last , static_cast<unsigned long> ( t->GetEntries () ) ) ;
+  if ( the_last <= first ) { return 0 ; }
+  //
+  // track the files of the chain 
+  Ostap::Utils::Notifier notifier ( t , const_cast<Func2D*> ( this ) ) ;
+  //
+  if ( t->LoadTree ( first ) < 0 ) { return 0 ; }
+  // the first entry: all checks and preparation of formulas 
+  result [ 0 ] = (*this) ( tree ) ;
+  //
+  unsigned long n = 1 ;
+  for ( unsigned long entry = first + 1 ; entry < the_last ; ++entry , ++n ) 
+  {
+    if ( t->LoadTree ( entry ) < 0 ) { break ; }
+    // new file in the chain: formulas are recreated 
+    if ( !m_xvar || !m_yvar ) { result [ n ] = (*this) ( tree ) ; continue ; }
+    const double xvar = m_xvar->evaluate () ;
+    const double yvar = m_yvar->evaluate () ;
+    result [ n ] = m_fun ( xvar , yvar ) ;
+  }
+  return n ;
+}
+// ============================================================================
 
 // ============================================================================
 // Func3D 
@@ -521,6 +633,44 @@ double Ostap::Functions::Func3D::operator() ( const TTree* tree ) const
   //
   return m_fun ( xvar , yvar , zvar ) ;
 }
+// ============================================================================
+/*  evaluate the function for the block of entries [first,last)
+ *  the tree is checked and the formulas are prepared only once
+ *  @see Ostap::IFuncTree::evaluate_range 
+ */
+// ============================================================================
+unsigned long Ostap::Functions::Func3D::evaluate_range 
+( const TTree*        tree   ,
+  const unsigned long first  , 
+  const unsigned long last   , 
+  double*             result ) const 
+{
+  if ( nullptr == tree || nullptr == result ) { return 0 ; }
+  TTree* t = const_cast<TTree*> ( tree ) ;
+  const unsigned long the_last = 
+    std::min ( last , static_cast<unsigned long> ( t->GetEntries () ) ) ;
+  if ( the_last <= first ) { return 0 ; }
+  //
+  // track the files of the chain 
+  Ostap::Utils::Notifier notifier ( t , const_cast<Func3D*> ( this ) ) ;
+  //
+  if ( t->LoadTree ( first ) < 0 ) { return 0 ; }
+  // the first entry: all checks and preparation of formulas 
+  result [ 0 ] = (*this) ( tree ) ;
+  //
+  unsigned long n = 1 ;
+  for ( unsigned long entry = first + 1 ; entry < the_last ; ++entry , ++n ) 
+  {
+    if ( t->LoadTree ( entry ) < 0 ) { break ; }
+    // new file in the chain: formulas are recreated 
+    if ( !m_xvar || !m_yvar || !m_zvar ) { result [ n ] = (*this) ( tree ) ; continue ; }
+    const double xvar = m_xvar->evaluate () ;
+    const double yvar = m_yvar->evaluate () ;
+    const double zvar = m_zvar->evaluate () ;
+    result [ n ] = m_fun ( xvar , yvar , zvar ) ;
+  }
+  return n ;
+}
 
 
 
@@ -675,6 +825,29 @@ Ostap::Functions::FuncTH3::FuncTH3
   const TTree*                tree  )
   : Func3D ( histo , xvar , yvar , zvar , tree )
 {}
+// ======================================================================
+/*  constructor from the 3D sparse histogram 
+ *  @see Ostap::Math::SparseHisto3D 
+ */
+// ======================================================================
+Ostap::Functions::FuncTH3::FuncTH3
+( const THnBase&       histo                     , 
+  const std::string&   xvar                      , 
+  const std::string&   yvar                      , 
+  const std::string&   zvar                      , 
+  const TTree*         tree                      ,
+  const Ostap::Math::HistoInterpolation::Type tx ,
+  const Ostap::Math::HistoInterpolation::Type ty , 
+  const Ostap::Math::HistoInterpolation::Type tz , 
+  const bool           edges                     ,
+  const bool           extrapolate               , 
+  const bool           density                   )
+  : Func3D ( Ostap::Math::SparseHisto3D ( histo , tx , ty , tz , edges , extrapolate , density ) , 
+             xvar , 
+             yvar , 
+             zvar , 
+             tree )
+{}
 // ============================================================================
 // copy constructor 
 // ============================================================================
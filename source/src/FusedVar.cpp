@@ -0,0 +1,554 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooAbsReal.h"
+#include "RooArgList.h"
+#include "RooAddition.h"
+#include "RooProduct.h"
+#include "RooConstVar.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Math.h"
+#include "Ostap/MoreMath.h"
+#include "Ostap/MoreRooFit.h"
+#include "Ostap/FusedVar.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+#include "local_math.h"
+#include "local_batch.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::MoreRooFit::FusedVar
+ *  @see Ostap::MoreRooFit::FusedVar
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-03-21
+ */
+// ============================================================================
+ClassImp(Ostap::MoreRooFit::FusedVar)
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_PROGRAM  = 830 ,
+    INVALID_LEAF     = 831 ,
+    INVALID_COLUMNS  = 832 ,
+  } ;
+  // ==========================================================================
+  typedef Ostap::MoreRooFit::FusedVar FV ;
+  // ==========================================================================
+  /// the names of the operations (for listing)
+  const char* const s_NAMES [ FV::LAST_OPERATION ] = {
+    "LOAD"     , "CONST"     , "ADD"         , "SUBTRACT" , "MULTIPLY" ,
+    "DIVIDE"   , "FRACTION"  , "ASYMMETRY"   , "COMBINATION" ,
+    "POWER"    , "ATAN2"     , "ABS"         , "EXP"      , "LOG"      ,
+    "LOG10"    , "ERF"       , "ERFC"        , "GAMMA"    , "LGAMMA"   ,
+    "IGAMMA"   , "SIN"       , "COS"         , "TAN"      , "SINH"     ,
+    "COSH"     , "TANH"      , "SECH"        } ;
+  // ==========================================================================
+  /// number of operands, taken from the stack
+  inline unsigned int _arity_ ( const unsigned int op )
+  {
+    return
+      op <= FV::CONST ? 0 :
+      op <= FV::ATAN2 ? 2 : 1 ;
+  }
+  // ==========================================================================
+  /// the same as Ostap::MoreRooFit::Power::evaluate
+  inline double _power_ ( const double x , const double y )
+  {
+    if      ( s_zero ( y )                      ) { return 1.0 ; }
+    else if ( 0 < y && s_zero ( x )             ) { return 0.0 ; }
+    else if ( 0 < y && Ostap::Math::isint ( y ) )
+    {
+      const int ny = Ostap::Math::round ( y ) ;
+      if      ( 0 == ny ) { return 1.0 ; }
+      return std::pow ( x , ny ) ;
+    }
+    return std::pow ( x , y ) ;
+  }
+  // ==========================================================================
+  /// evaluate the binary operation
+  inline double _binary_
+  ( const unsigned int op ,
+    const double       a  ,
+    const double       b  ,
+    const double*      c  )
+  {
+    switch ( op )
+    {
+    case FV::ADD         : return a + b ;
+    case FV::SUBTRACT    : return a - b ;
+    case FV::MULTIPLY    : return a * b ;
+    case FV::DIVIDE      : return a / b ;
+    case FV::FRACTION    : return a / ( a + b ) ;
+    case FV::ASYMMETRY   : return c [ 0 ] * ( a - b ) / ( a + b ) ;
+    case FV::COMBINATION : return c [ 0 ] * a * ( c [ 1 ] + c [ 2 ] * b ) ;
+    case FV::POWER       : return _power_    ( a , b ) ;
+    case FV::ATAN2       : return std::atan2 ( a , b ) ;
+    default              : break ;
+    }
+    return 0 ;
+  }
+  // ==========================================================================
+  typedef double (*Unary) ( const double ) ;
+  // ==========================================================================
+  inline double _abs_    ( const double x ) { return std::abs    ( x ) ; }
+  inline double _exp_    ( const double x ) { return std::exp    ( x ) ; }
+  inline double _log_    ( const double x ) { return std::log    ( x ) ; }
+  inline double _log10_  ( const double x ) { return std::log10  ( x ) ; }
+  inline double _erf_    ( const double x ) { return std::erf    ( x ) ; }
+  inline double _erfc_   ( const double x ) { return std::erfc   ( x ) ; }
+  inline double _gamma_  ( const double x ) { return std::tgamma ( x ) ; }
+  inline double _lgamma_ ( const double x ) { return std::lgamma ( x ) ; }
+  inline double _sin_    ( const double x ) { return std::sin    ( x ) ; }
+  inline double _cos_    ( const double x ) { return std::cos    ( x ) ; }
+  inline double _tan_    ( const double x ) { return std::tan    ( x ) ; }
+  inline double _sinh_   ( const double x ) { return std::sinh   ( x ) ; }
+  inline double _cosh_   ( const double x ) { return std::cosh   ( x ) ; }
+  inline double _tanh_   ( const double x ) { return std::tanh   ( x ) ; }
+  inline double _igamma_ ( const double x ) { return Ostap::Math::igamma ( x ) ; }
+  inline double _sech_   ( const double x ) { return Ostap::Math::sech   ( x ) ; }
+  // ==========================================================================
+  /// get the unary function
+  inline Unary _unary_ ( const unsigned int op )
+  {
+    switch ( op )
+    {
+    case FV::ABS    : return &_abs_    ;
+    case FV::EXP    : return &_exp_    ;
+    case FV::LOG    : return &_log_    ;
+    case FV::LOG10  : return &_log10_  ;
+    case FV::ERF    : return &_erf_    ;
+    case FV::ERFC   : return &_erfc_   ;
+    case FV::GAMMA  : return &_gamma_  ;
+    case FV::LGAMMA : return &_lgamma_ ;
+    case FV::IGAMMA : return &_igamma_ ;
+    case FV::SIN    : return &_sin_    ;
+    case FV::COS    : return &_cos_    ;
+    case FV::TAN    : return &_tan_    ;
+    case FV::SINH   : return &_sinh_   ;
+    case FV::COSH   : return &_cosh_   ;
+    case FV::TANH   : return &_tanh_   ;
+    case FV::SECH   : return &_sech_   ;
+    default         : break ;
+    }
+    return nullptr ;
+  }
+  // ==========================================================================
+  /// get the opcode for the "function of product" node f(a*b)
+  inline unsigned int _function_ ( const RooAbsReal& node )
+  {
+    using namespace Ostap::MoreRooFit ;
+    if      ( dynamic_cast<const Abs*>    ( &node ) ) { return FV::ABS    ; }
+    else if ( dynamic_cast<const Exp*>    ( &node ) ) { return FV::EXP    ; }
+    else if ( dynamic_cast<const Log*>    ( &node ) ) { return FV::LOG    ; }
+    else if ( dynamic_cast<const Log10*>  ( &node ) ) { return FV::LOG10  ; }
+    else if ( dynamic_cast<const Erf*>    ( &node ) ) { return FV::ERF    ; }
+    else if ( dynamic_cast<const Erfc*>   ( &node ) ) { return FV::ERFC   ; }
+    else if ( dynamic_cast<const Gamma*>  ( &node ) ) { return FV::GAMMA  ; }
+    else if ( dynamic_cast<const LGamma*> ( &node ) ) { return FV::LGAMMA ; }
+    else if ( dynamic_cast<const IGamma*> ( &node ) ) { return FV::IGAMMA ; }
+    else if ( dynamic_cast<const Sin*>    ( &node ) ) { return FV::SIN    ; }
+    else if ( dynamic_cast<const Cos*>    ( &node ) ) { return FV::COS    ; }
+    else if ( dynamic_cast<const Tan*>    ( &node ) ) { return FV::TAN    ; }
+    else if ( dynamic_cast<const Sinh*>   ( &node ) ) { return FV::SINH   ; }
+    else if ( dynamic_cast<const Cosh*>   ( &node ) ) { return FV::COSH   ; }
+    else if ( dynamic_cast<const Tanh*>   ( &node ) ) { return FV::TANH   ; }
+    else if ( dynamic_cast<const Sech*>   ( &node ) ) { return FV::SECH   ; }
+    //
+    return FV::LAST_OPERATION ;
+  }
+  // ==========================================================================
+  /// get the opcode for the binary node f(a,b)
+  inline unsigned int _binop_ ( const RooAbsReal& node )
+  {
+    using namespace Ostap::MoreRooFit ;
+    if      ( dynamic_cast<const Division*>    ( &node ) ) { return FV::DIVIDE      ; }
+    else if ( dynamic_cast<const Fraction*>    ( &node ) ) { return FV::FRACTION    ; }
+    else if ( dynamic_cast<const Asymmetry*>   ( &node ) ) { return FV::ASYMMETRY   ; }
+    else if ( dynamic_cast<const Combination*> ( &node ) ) { return FV::COMBINATION ; }
+    else if ( dynamic_cast<const Power*>       ( &node ) ) { return FV::POWER       ; }
+    else if ( dynamic_cast<const Atan2*>       ( &node ) ) { return FV::ATAN2       ; }
+    //
+    return FV::LAST_OPERATION ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+/*  constructor from the expression tree
+ *  @param name  the name
+ *  @param title the title
+ *  @param root  the root of expression tree
+ */
+// ============================================================================
+Ostap::MoreRooFit::FusedVar::FusedVar
+( const std::string& name  ,
+  const std::string& title ,
+  const RooAbsReal&  root  )
+  : RooAbsReal ( ( name.empty  () ? std::string ( "fused_" ) + root.GetName  () : name  ).c_str () ,
+                 ( title.empty () ? std::string ( "fused(" ) + root.GetTitle () + ")" : title ).c_str () )
+  , m_leaves   ( "!leaves" , "The leaves of expression" , this )
+{
+  compile ( root ) ;
+  check   () ;
+}
+// ============================================================================
+/*  full constructor (e.g. for deserialization)
+ *  @param name      the name
+ *  @param title     the title
+ *  @param leaves    the leaves
+ *  @param program   the program: pairs (opcode, argument)
+ *  @param constants the constants
+ */
+// ============================================================================
+Ostap::MoreRooFit::FusedVar::FusedVar
+( const std::string&                name      ,
+  const std::string&                title     ,
+  const RooArgList&                 leaves    ,
+  const std::vector<unsigned int>&  program   ,
+  const std::vector<double>&        constants )
+  : RooAbsReal  ( name.c_str () , title.c_str () )
+  , m_leaves    ( "!leaves" , "The leaves of expression" , this )
+  , m_program   ( program   )
+  , m_constants ( constants )
+{
+  for ( RooAbsArg* a : leaves )
+  {
+    Ostap::Assert ( nullptr != dynamic_cast<RooAbsReal*> ( a )   ,
+                    std::string ( "Invalid leaf " ) + a->GetName () ,
+                    "Ostap::MoreRooFit::FusedVar" , INVALID_LEAF ) ;
+    m_leaves.add ( *a ) ;
+  }
+  check () ;
+}
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::MoreRooFit::FusedVar::FusedVar
+( const Ostap::MoreRooFit::FusedVar& right   ,
+  const char*                        newname )
+  : RooAbsReal  ( right , newname )
+  , m_leaves    ( "!leaves" , this , right.m_leaves )
+  , m_program   ( right.m_program   )
+  , m_constants ( right.m_constants )
+  , m_depth     ( right.m_depth     )
+{}
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::MoreRooFit::FusedVar::~FusedVar(){}
+// ============================================================================
+// clone
+// ============================================================================
+Ostap::MoreRooFit::FusedVar*
+Ostap::MoreRooFit::FusedVar::clone ( const char* newname ) const
+{ return new Ostap::MoreRooFit::FusedVar ( *this , newname ) ; }
+// ============================================================================
+// add the instruction
+// ============================================================================
+void Ostap::MoreRooFit::FusedVar::emit
+( const unsigned int op  ,
+  const unsigned int arg )
+{
+  m_program.push_back ( op  ) ;
+  m_program.push_back ( arg ) ;
+}
+// ============================================================================
+// compile the subtree into the program (post-order)
+// ============================================================================
+void Ostap::MoreRooFit::FusedVar::compile ( const RooAbsReal& node )
+{
+  // ==========================================================================
+  // (1) constants
+  if ( dynamic_cast<const RooConstVar*> ( &node ) )
+  {
+    emit ( CONST , m_constants.size () ) ;
+    m_constants.push_back ( node.getVal () ) ;
+    return ;                                                     // RETURN
+  }
+  // ==========================================================================
+  // (2) sums
+  const RooAddition* sum = dynamic_cast<const RooAddition*> ( &node ) ;
+  if ( sum )
+  {
+    const RooArgList& terms = sum->list () ;
+    if ( 0 == terms.getSize () ) { emit ( CONST , m_constants.size () ) ; m_constants.push_back ( 0 ) ; return ; }
+    for ( int i = 0 ; i < terms.getSize () ; ++i )
+    {
+      compile ( static_cast<const RooAbsReal&> ( terms [ i ] ) ) ;
+      if ( 0 < i ) { emit ( ADD ) ; }
+    }
+    return ;                                                     // RETURN
+  }
+  // ==========================================================================
+  // (3) products: only real-valued components
+  const RooProduct* prod = dynamic_cast<const RooProduct*> ( &node ) ;
+  if ( prod )
+  {
+    const RooArgList comps = const_cast<RooProduct*> ( prod )->components () ;
+    bool reals = true ;
+    for ( RooAbsArg* a : comps )
+    { if ( nullptr == dynamic_cast<RooAbsReal*> ( a ) ) { reals = false ; break ; } }
+    if ( reals )
+    {
+      if ( 0 == comps.getSize () ) { emit ( CONST , m_constants.size () ) ; m_constants.push_back ( 1 ) ; return ; }
+      for ( int i = 0 ; i < comps.getSize () ; ++i )
+      {
+        compile ( static_cast<const RooAbsReal&> ( comps [ i ] ) ) ;
+        if ( 0 < i ) { emit ( MULTIPLY ) ; }
+      }
+      return ;                                                   // RETURN
+    }
+  }
+  // ==========================================================================
+  // (4) identity
+  const Ostap::MoreRooFit::Id* id = dynamic_cast<const Ostap::MoreRooFit::Id*> ( &node ) ;
+  if ( id ) { compile ( id->x () ) ; return ; }                  // RETURN
+  // ==========================================================================
+  // (5) binary operations and functions of product
+  const Ostap::MoreRooFit::TwoVars* two = dynamic_cast<const Ostap::MoreRooFit::TwoVars*> ( &node ) ;
+  if ( two )
+  {
+    const unsigned int bop = _binop_ ( node ) ;
+    if ( LAST_OPERATION != bop )
+    {
+      compile ( two->x () ) ;
+      compile ( two->y () ) ;
+      unsigned int arg = 0 ;
+      if      ( ASYMMETRY == bop )
+      {
+        arg = m_constants.size () ;
+        m_constants.push_back ( static_cast<const Ostap::MoreRooFit::Asymmetry&>   ( node ).scale () ) ;
+      }
+      else if ( COMBINATION == bop )
+      {
+        const Ostap::MoreRooFit::Combination& c =
+          static_cast<const Ostap::MoreRooFit::Combination&> ( node ) ;
+        arg = m_constants.size () ;
+        m_constants.push_back ( c.alpha () ) ;
+        m_constants.push_back ( c.beta  () ) ;
+        m_constants.push_back ( c.gamma () ) ;
+      }
+      emit ( bop , arg ) ;
+      return ;                                                   // RETURN
+    }
+    //
+    const unsigned int fop = _function_ ( node ) ;
+    if ( LAST_OPERATION != fop )
+    {
+      compile ( two->x () ) ;
+      compile ( two->y () ) ;
+      emit ( MULTIPLY ) ;
+      emit ( fop      ) ;
+      return ;                                                   // RETURN
+    }
+  }
+  // ==========================================================================
+  // (6) everything else is a leaf
+  int index = m_leaves.index ( &node ) ;
+  if ( index < 0 )
+  {
+    index = m_leaves.getSize () ;
+    m_leaves.add ( node ) ;
+  }
+  emit ( LOAD , index ) ;
+}
+// ============================================================================
+// check the program and calculate the depth of the stack
+// ============================================================================
+void Ostap::MoreRooFit::FusedVar::check ()
+{
+  Ostap::Assert ( !m_program.empty () && 0 == m_program.size () % 2 ,
+                  "Invalid program"                                 ,
+                  "Ostap::MoreRooFit::FusedVar" , INVALID_PROGRAM   ) ;
+  //
+  const std::size_t nleaves = m_leaves.getSize () ;
+  unsigned int depth = 0 ;
+  m_depth            = 0 ;
+  for ( std::size_t i = 0 ; i < m_program.size () ; i += 2 )
+  {
+    const unsigned int op  = m_program [ i     ] ;
+    const unsigned int arg = m_program [ i + 1 ] ;
+    Ostap::Assert ( op < LAST_OPERATION , "Invalid opcode" ,
+                    "Ostap::MoreRooFit::FusedVar" , INVALID_PROGRAM ) ;
+    const bool ok =
+      LOAD        == op ? arg     < nleaves             :
+      CONST       == op ? arg     < m_constants.size () :
+      ASYMMETRY   == op ? arg     < m_constants.size () :
+      COMBINATION == op ? arg + 2 < m_constants.size () : true ;
+    Ostap::Assert ( ok , "Invalid argument of the instruction" ,
+                    "Ostap::MoreRooFit::FusedVar" , INVALID_PROGRAM ) ;
+    const unsigned int n = _arity_ ( op ) ;
+    Ostap::Assert ( n <= depth , "Stack underflow" ,
+                    "Ostap::MoreRooFit::FusedVar" , INVALID_PROGRAM ) ;
+    depth   = 0 == n ? depth + 1 : depth + 1 - n ;
+    m_depth = std::max ( m_depth , depth ) ;
+  }
+  Ostap::Assert ( 1 == depth , "Invalid final depth of the stack" ,
+                  "Ostap::MoreRooFit::FusedVar" , INVALID_PROGRAM ) ;
+}
+// ============================================================================
+// the actual evaluation of the result
+// ============================================================================
+Double_t Ostap::MoreRooFit::FusedVar::evaluate () const
+{
+  if ( m_stack.size () < m_depth ) { m_stack.resize ( m_depth ) ; }
+  double* top = m_stack.data () ;
+  //
+  for ( std::size_t i = 0 ; i < m_program.size () ; i += 2 )
+  {
+    const unsigned int op  = m_program [ i     ] ;
+    const unsigned int arg = m_program [ i + 1 ] ;
+    switch ( op )
+    {
+    case LOAD  :
+      *top++ = static_cast<const RooAbsReal&> ( m_leaves [ arg ] ).getVal ( m_leaves.nset () ) ;
+      break ;
+    case CONST :
+      *top++ = m_constants [ arg ] ;
+      break ;
+    default    :
+      if ( 2 == _arity_ ( op ) )
+      {
+        --top ;
+        *( top - 1 ) = _binary_ ( op , *( top - 1 ) , *top , m_constants.data () + arg ) ;
+      }
+      else { *( top - 1 ) = (*_unary_ ( op ) ) ( *( top - 1 ) ) ; }
+      break ;
+    }
+  }
+  return m_stack [ 0 ] ;
+}
+// ============================================================================
+/*  run the program column-wise
+ *  @param output  (OUTPUT) the output column of size n
+ *  @param n       the number of entries
+ *  @param columns the input columns (one for each leaf)
+ *  @param sizes   the sizes of the input columns: 1 or  n
+ */
+// ============================================================================
+void Ostap::MoreRooFit::FusedVar::evaluate_columns
+( double*                           output  ,
+  const std::size_t                 n       ,
+  const std::vector<const double*>& columns ,
+  const std::vector<std::size_t>&   sizes   ) const
+{
+  if ( 0 == n ) { return ; }                                     // RETURN
+  //
+  const std::size_t nleaves = m_leaves.getSize () ;
+  Ostap::Assert ( nleaves == columns.size () && nleaves == sizes.size () ,
+                  "Invalid number of columns"         ,
+                  "Ostap::MoreRooFit::FusedVar"       , INVALID_COLUMNS ) ;
+  //
+  if ( m_columns.size () < m_depth ) { m_columns.resize ( m_depth ) ; }
+  for ( std::size_t k = 0 ; k < m_depth ; ++k ) { m_columns [ k ].resize ( n ) ; }
+  //
+  std::size_t top = 0 ;
+  for ( std::size_t i = 0 ; i < m_program.size () ; i += 2 )
+  {
+    const unsigned int op  = m_program [ i     ] ;
+    const unsigned int arg = m_program [ i + 1 ] ;
+    //
+    if      ( LOAD  == op )
+    {
+      const double*     c  = columns [ arg ] ;
+      double*           r  = m_columns [ top++ ].data () ;
+      const std::size_t nc = sizes   [ arg ] ;
+      Ostap::Assert ( 1 == nc || n <= nc , "Invalid size of the column" ,
+                      "Ostap::MoreRooFit::FusedVar" , INVALID_COLUMNS ) ;
+      if ( 1 == nc ) { std::fill ( r , r + n , c [ 0 ] ) ; }
+      else           { std::copy ( c , c + n , r       ) ; }
+    }
+    else if ( CONST == op )
+    {
+      double* r = m_columns [ top++ ].data () ;
+      std::fill ( r , r + n , m_constants [ arg ] ) ;
+    }
+    else if ( 2 == _arity_ ( op ) )
+    {
+      --top ;
+      double*       a = m_columns [ top - 1 ].data () ;
+      const double* b = m_columns [ top     ].data () ;
+      switch ( op )
+      {
+      case ADD      : for ( std::size_t j = 0 ; j < n ; ++j ) { a [ j ] += b [ j ] ; } break ;
+      case SUBTRACT : for ( std::size_t j = 0 ; j < n ; ++j ) { a [ j ] -= b [ j ] ; } break ;
+      case MULTIPLY : for ( std::size_t j = 0 ; j < n ; ++j ) { a [ j ] *= b [ j ] ; } break ;
+      case DIVIDE   : for ( std::size_t j = 0 ; j < n ; ++j ) { a [ j ] /= b [ j ] ; } break ;
+      default       :
+        {
+          const double* c = m_constants.data () + arg ;
+          for ( std::size_t j = 0 ; j < n ; ++j ) { a [ j ] = _binary_ ( op , a [ j ] , b [ j ] , c ) ; }
+        }
+        break ;
+      }
+    }
+    else
+    {
+      const Unary f = _unary_ ( op ) ;
+      double*     a = m_columns [ top - 1 ].data () ;
+      for ( std::size_t j = 0 ; j < n ; ++j ) { a [ j ] = (*f) ( a [ j ] ) ; }
+    }
+  }
+  //
+  std::copy ( m_columns [ 0 ].begin () , m_columns [ 0 ].begin () + n , output ) ;
+}
+// ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// evaluate the batch
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::MoreRooFit::FusedVar , RooAbsReal )
+// ============================================================================
+void Ostap::MoreRooFit::FusedVar::computeBatch_
+( Ostap::Utils::BatchData& data    ,
+  double*                  output  ,
+  const std::size_t        nEvents ) const
+{
+  const std::size_t nleaves = m_leaves.getSize () ;
+  std::vector<const double*> columns ( nleaves , nullptr ) ;
+  std::vector<std::size_t>   sizes   ( nleaves , 0       ) ;
+  for ( std::size_t k = 0 ; k < nleaves ; ++k )
+  {
+    const Ostap::Utils::BatchData::Span span = data.at ( &m_leaves [ k ] ) ;
+    columns [ k ] = span.data () ;
+    sizes   [ k ] = span.size () ;
+  }
+  evaluate_columns ( output , nEvents , columns , sizes ) ;
+}
+// ============================================================================
+#endif
+// ============================================================================
+// the human-readable listing of the program
+// ============================================================================
+std::string Ostap::MoreRooFit::FusedVar::listing () const
+{
+  std::ostringstream s ;
+  for ( std::size_t i = 0 ; i < m_program.size () ; i += 2 )
+  {
+    const unsigned int op  = m_program [ i     ] ;
+    const unsigned int arg = m_program [ i + 1 ] ;
+    s << ( i / 2 ) << ": " << ( op < LAST_OPERATION ? s_NAMES [ op ] : "?" ) ;
+    if      ( LOAD  == op && arg < (unsigned int) m_leaves.getSize () )
+    { s << " " << m_leaves [ arg ].GetName () ; }
+    else if ( CONST == op && arg < m_constants.size () )
+    { s << " " << m_constants [ arg ] ; }
+    s << '\n' ;
+  }
+  return s.str () ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -7,12 +7,17 @@
 #include <iostream>
 #include <sstream>
 #include <map>
+#include <set>
 #include <tuple>
+#include <array>
+#include <atomic>
+#include <mutex>
 // ============================================================================
 // Ostap 
 // ============================================================================
 #include "Ostap/Error2Exception.h"
 #include "Ostap/ToStream.h"
+#include "Ostap/Instrument.h"
 // ============================================================================
 // local
 // ============================================================================
@@ -31,31 +36,125 @@
 namespace
 {
   // ==========================================================================
-  class Cache 
+  // item in the map 
+  typedef std::tuple<std::string,std::string,int,int> ITEM  ;
+  // map type itself
+  typedef std::map<ITEM,unsigned long>                MAP   ;  
+  // ==========================================================================
+  /// the lowest GSL error code (GSL_CONTINUE)
+  const int         s_code_min = -2 ;
+  /// number of counters (the last one is for all "other" codes)
+  const std::size_t s_ncodes   = 64 ;  
+  /// index of the counter 
+  inline std::size_t code_index ( const int errcode ) 
+  {
+    const int index = errcode - s_code_min ;
+    return 
+      ( index < 0 || int ( s_ncodes ) - 1 <= index ) ? s_ncodes - 1 : index ;
+  }
+  // ==========================================================================
+  /** @class Buffer 
+   *  thread-local buffer of GSL errors 
+   *  - only the owner thread adds the errors, the lock is never contended 
+   *    in hot loops 
+   *  - the buffer is merged into the global cache on demand 
+   *    and at the thread exit 
+   */
+  class Buffer 
   {
   public: 
     // ========================================================================
-    static void add 
+    Buffer  () ;
+    ~Buffer () ;
+    // ========================================================================
+  public: 
+    // ========================================================================
+    /// add the error 
+    void add 
     ( const char * reason  ,
       const char * file    ,
       int          line    ,
       int          errcode ) 
+    {
+      std::lock_guard<std::mutex> lock { m_mutex } ;
+      m_map [ std::make_tuple ( reason , file , line , errcode ) ] += 1 ;
+    }
+    /// count the error 
+    void count ( const int errcode ) 
+    { 
+      OSTAP_COUNT ( "Ostap::Math::GSL::error" ) ;
+      m_counters [ code_index ( errcode ) ].fetch_add ( 1 , std::memory_order_relaxed ) ; 
+    }
+    // ========================================================================
+    /// move the content into the merged map&counters 
+    void merge ( MAP& merged , std::array<unsigned long,s_ncodes>& counters ) 
+    {
+      std::lock_guard<std::mutex> lock { m_mutex } ;
+      for ( const auto& item : m_map ) { merged [ item.first ] += item.second ; }
+      m_map.clear () ;
+      for ( std::size_t i = 0 ; i < s_ncodes ; ++i ) 
+      { counters [ i ] += m_counters [ i ].exchange ( 0 , std::memory_order_relaxed ) ; }
+    }
+    // ========================================================================
+  public:
+    // ========================================================================
+    /// record errors ? 
+    bool record = true ;
+    // ========================================================================
+  private: 
+    // ========================================================================
+    std::mutex                                      m_mutex    {} ;
+    MAP                                             m_map      {} ;
+    std::array<std::atomic<unsigned long>,s_ncodes> m_counters {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  class Cache 
+  {
+  public: 
+    // ========================================================================
+    /// register the thread-local buffer 
+    static void attach ( Buffer* buffer ) 
+    {
+      CACHE::Lock lock  { s_CACHE.mutex() } ;
+      s_BUFFERS.insert ( buffer ) ;
+    }
+    /// merge and unregister the thread-local buffer 
+    static void detach ( Buffer* buffer ) 
     {
       CACHE::Lock lock  { s_CACHE.mutex() } ;
-      const ITEM key = std::make_tuple ( reason , file , line , errcode ) ;
-      s_CACHE.container() [ key ] += 1 ;
+      buffer->merge ( s_CACHE.container() , s_COUNTERS ) ;
+      s_BUFFERS.erase ( buffer ) ;
     }
     // =========================================================================    
     static std::size_t size() 
     {
       CACHE::Lock lock  { s_CACHE.mutex() } ;
+      _merge () ;
       return s_CACHE->size () ;
     }
     // =========================================================================    
+    static unsigned long counter ( const int errcode ) 
+    {
+      CACHE::Lock lock  { s_CACHE.mutex() } ;
+      _merge () ;
+      return s_COUNTERS [ code_index ( errcode ) ] ;
+    }
+    // =========================================================================    
+    static unsigned long total () 
+    {
+      CACHE::Lock lock  { s_CACHE.mutex() } ;
+      _merge () ;
+      unsigned long result = 0 ;
+      for ( const unsigned long c : s_COUNTERS ) { result += c ; }
+      return result ;
+    }
+    // =========================================================================    
     /// get summary of GSL errors 
     static Ostap::Utils::GslCount::Table table () 
     {
       CACHE::Lock lock  { s_CACHE.mutex() } ;
+      _merge () ;
       //
       Ostap::Utils::GslCount::Table _table ;
       _table.reserve ( s_CACHE->size () ) ;
@@ -87,14 +186,17 @@ namespace
     static std::size_t clear() 
     {
       CACHE::Lock lock  { s_CACHE.mutex() } ;
+      _merge () ;
       const std::size_t size = s_CACHE->size() ;
       s_CACHE->clear() ;
+      s_COUNTERS.fill ( 0 ) ;
       return size ;
     }
     // =========================================================================
     ~Cache () 
     {
       CACHE::Lock lock { s_CACHE.mutex() } ;
+      _merge () ;
       if ( 0 < s_CACHE->size() ) 
       {
         std::cerr << "Summary of GSL Errors " << std::endl ;
@@ -121,25 +223,43 @@ namespace
     // =========================================================================
   private :
     // =========================================================================
-    // item in the map 
-    typedef std::tuple<std::string,std::string,int,int> ITEM  ;
-    // map type itself
-    typedef std::map<ITEM,unsigned long>                MAP   ;  
+    /// merge all thread-local buffers (the global lock must be acquired!)
+    static void _merge () 
+    { for ( Buffer* b : s_BUFFERS ) { b->merge ( s_CACHE.container() , s_COUNTERS ) ; } }
+    // =========================================================================
+  private :
+    // =========================================================================
     // synched map 
     typedef SyncedCache<MAP>                            CACHE ;
     // =========================================================================
     // cache itself 
-    static CACHE s_CACHE ;
+    static CACHE                              s_CACHE    ;
+    // merged counters 
+    static std::array<unsigned long,s_ncodes> s_COUNTERS ;
+    // all known thread-local buffers 
+    static std::set<Buffer*>                  s_BUFFERS  ;
     // =========================================================================
   } ;
   // ===========================================================================
-  Cache::CACHE Cache::s_CACHE = CACHE{} ;
+  Cache::CACHE                              Cache::s_CACHE    = CACHE{} ;
+  std::array<unsigned long,s_ncodes>        Cache::s_COUNTERS {}      ;
+  std::set<Buffer*>                         Cache::s_BUFFERS  {}      ;
   // ===========================================================================
   /** @var s_cache 
    *  The actual cache object 
    */
   Cache s_cache ;
   // ==========================================================================
+  Buffer:: Buffer () { Cache::attach ( this ) ; }
+  Buffer::~Buffer () { Cache::detach ( this ) ; }
+  // ==========================================================================
+  /// get the thread-local buffer 
+  inline Buffer& buffer () 
+  {
+    static thread_local Buffer s_buffer {} ;
+    return s_buffer ;
+  }
+  // ==========================================================================
 
 
   // ==========================================================================
@@ -150,6 +270,7 @@ namespace
     int          line      ,
     int          gsl_errno ) 
   {
+    buffer().count ( gsl_errno ) ;
     std::cerr 
       << " GSL_ERROR : "   
       << gsl_errno << "/'" << gsl_strerror ( gsl_errno ) << "'"
@@ -165,7 +286,7 @@ namespace
   ( const char * /* reason    */ ,
     const char * /* file      */ ,
     int          /* line      */ ,
-    int          /* gsl_errno */ ) {}
+    int          gsl_errno       ) { buffer().count ( gsl_errno ) ; }
   // ==========================================================================
   /// convert errors to exceptions 
   void GSL_exception_error
@@ -174,6 +295,7 @@ namespace
     int          line      ,
     int          gsl_errno ) 
   {
+    buffer().count ( gsl_errno ) ;
     std::string tag = "GSL/Error" ;
     std::ostringstream ss ;
     ss << gsl_strerror ( gsl_errno ) << "(" << gsl_errno << ") "
@@ -191,7 +313,11 @@ namespace
     int          line      ,
     int          gsl_errno ) 
   {
-    s_cache.add ( reason , file , line , gsl_errno ) ;
+    Buffer& b = buffer () ;
+    b.count ( gsl_errno ) ;
+#ifndef OSTAP_GSL_NO_RECORD
+    if ( b.record ) { b.add ( reason , file , line , gsl_errno ) ; }
+#endif 
   }
   // ==========================================================================
 }
@@ -247,6 +373,41 @@ Ostap::Utils::GslCount::Table
 Ostap::Utils::GslCount::table() 
 { return Cache::table () ; }
 // ============================================================================
+// how many times GSL error with the given code has been fired? 
+// ============================================================================
+unsigned long Ostap::Utils::GslCount::counter ( const int errcode ) 
+{ return Cache::counter ( errcode ) ; }
+// ============================================================================
+// total number of fired GSL errors 
+// ============================================================================
+unsigned long Ostap::Utils::GslCount::total () 
+{ return Cache::total () ; }
+// ============================================================================
+// enable/disable the recording of errors for the current thread 
+// ============================================================================
+bool Ostap::Utils::GslCount::record ( const bool value ) 
+{
+  Buffer& b = buffer () ;
+  const bool previous = b.record ;
+  b.record = value ;
+  return previous ;
+}
+// ============================================================================
+// is the recording of errors enabled for the current thread?
+// ============================================================================
+bool Ostap::Utils::GslCount::recording () { return buffer().record ; }
+// ============================================================================
+// constructor: disable the recording 
+// ============================================================================
+Ostap::Utils::GslNoRecord::GslNoRecord  () 
+  : m_previous ( Ostap::Utils::GslCount::record ( false ) ) 
+{}
+// ============================================================================
+// destructor: restore the previous state 
+// ============================================================================
+Ostap::Utils::GslNoRecord::~GslNoRecord () 
+{ Ostap::Utils::GslCount::record ( m_previous ) ; }
+// ============================================================================
   
 // ============================================================================
 // constructor: make use of Gsl Error Handler: print error to stderr 
@@ -0,0 +1,795 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <atomic>
+#include <algorithm>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooAbsPdf.h"
+#include "RooAbsData.h"
+#include "RooAddPdf.h"
+#include "RooRealVar.h"
+#include "RooArgList.h"
+#include "RooArgProxy.h"
+#include "Math/IFunction.h"
+#include "Math/Minimizer.h"
+#include "Math/Factory.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Math.h"
+#include "Ostap/Peaks.h"
+#include "Ostap/Bernstein1D.h"
+#include "Ostap/PDFs.h"
+#include "Ostap/GradientNLL.h"
+#include "Ostap/Arena.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+#include "bernstein_utils.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::MoreRooFit::GradientNLL
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+ClassImp(Ostap::MoreRooFit::GradientNLL)
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_DATA        = 810 ,
+    INVALID_PDF         = 811 ,
+    INVALID_OBSERVABLE  = 812 ,
+    INVALID_PARAMETER   = 813 ,
+    INVALID_MINIMIZER   = 814 ,
+  } ;
+  // ==========================================================================
+  /// the minimal value of PDF
+  const double      s_TINY  = 1.e-300 ;
+  /// the size of the block of events
+  const std::size_t s_BLOCK = 8192    ;
+  // ==========================================================================
+  /** get the arguments of PDF in the order of proxies:
+   *  the first one is the observable, the rest are the parameters
+   */
+  std::vector<const RooAbsArg*> arguments ( const RooAbsPdf& pdf )
+  {
+    std::vector<const RooAbsArg*> result ;
+    for ( int i = 0 ; i < pdf.numProxies () ; ++i )
+    {
+      const RooAbsProxy* proxy = pdf.getProxy ( i ) ;
+      const RooArgProxy* arg   = dynamic_cast<const RooArgProxy*> ( proxy ) ;
+      if ( nullptr != arg ) { result.push_back ( arg->absArg () ) ; continue ; }
+      const RooArgList*  lst   = dynamic_cast<const RooArgList*>  ( proxy ) ;
+      if ( nullptr != lst ) { for ( const RooAbsArg* a : *lst ) { result.push_back ( a ) ; } }
+    }
+    return result ;
+  }
+  // ==========================================================================
+  /// step for the numerical derivatives in the parameter space
+  inline double step ( const double value )
+  { return 1.e-6 * std::max ( 1.0 , std::abs ( value ) ) ; }
+  // ==========================================================================
+  /** @class Component
+   *  the shape with the analytic derivatives of log(f)
+   */
+  class Component
+  {
+  public:
+    // ========================================================================
+    virtual ~Component () = default ;
+    // ========================================================================
+    /** update the function from the parameters,
+     *  calculate the integral and the derivatives of its logarithm
+     */
+    virtual void   update  ( const double low , const double high ) = 0 ;
+    /// the value and the derivatives of log(f) with respect to the parameters
+    virtual double dlogpdf ( const double x   , double* dlog ) const = 0 ;
+    /// the values for the array of points (no derivatives)
+    virtual void   evaluate
+    ( const std::size_t n , const double* x , double* f ) const = 0 ;
+    // ========================================================================
+    /// the parameters
+    const std::vector<const RooRealVar*>& pars () const { return m_pars ; }
+    /// the integral over the observable range
+    double integral () const { return m_integral ; }
+    /// the derivatives of the logarithm of integral
+    const std::vector<double>& dlogint () const { return m_dlogint ; }
+    // ========================================================================
+  protected:
+    // ========================================================================
+    std::vector<const RooRealVar*> m_pars     {} ;
+    double                         m_integral { 1 } ;
+    std::vector<double>            m_dlogint  {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** @class Peak
+   *  the peak with analytic <code>dlogpdf</code> method
+   */
+  template <class FUNCTION>
+  class Peak : public Component
+  {
+  public:
+    // ========================================================================
+    typedef bool (FUNCTION::*Setter)( const double ) ;
+    // ========================================================================
+    Peak ( const FUNCTION&                        fun      ,
+           const std::vector<const RooRealVar*>&  pars     ,
+           const std::vector<Setter>&             setters  ,
+           const std::vector<bool>&               absolute )
+      : m_fun      ( fun      )
+      , m_setters  ( setters  )
+      , m_absolute ( absolute )
+      , m_signs    ( pars.size () , 1.0 )
+    {
+      m_pars = pars ;
+      m_dlogint.resize ( pars.size () ) ;
+    }
+    // ========================================================================
+    void update ( const double low , const double high ) override
+    {
+      const std::size_t N = m_pars.size () ;
+      for ( std::size_t k = 0 ; k < N ; ++k )
+      {
+        const double v = m_pars [ k ]->getVal () ;
+        ( m_fun.*m_setters [ k ] ) ( v ) ;
+        // the parameters that enter via the absolute value
+        m_signs [ k ] = m_absolute [ k ] && v < 0 ? -1.0 : 1.0 ;
+      }
+      m_integral = m_fun.integral ( low , high ) ;
+      // the integrals do not depend on data: the numerical derivatives are cheap
+      for ( std::size_t k = 0 ; k < N ; ++k )
+      {
+        const double v = m_pars [ k ]->getVal () ;
+        const double h = step ( v ) ;
+        FUNCTION f1 ( m_fun ) ; ( f1.*m_setters [ k ] ) ( v + h ) ;
+        FUNCTION f2 ( m_fun ) ; ( f2.*m_setters [ k ] ) ( v - h ) ;
+        m_dlogint [ k ] = ( f1.integral ( low , high ) - f2.integral ( low , high ) ) / ( 2 * h * m_integral ) ;
+      }
+    }
+    // ========================================================================
+    double dlogpdf ( const double x , double* dlog ) const override
+    {
+      const double f = m_fun.dlogpdf ( x , dlog ) ;
+      for ( std::size_t k = 0 ; k < m_signs.size () ; ++k ) { dlog [ k ] *= m_signs [ k ] ; }
+      return f ;
+    }
+    // ========================================================================
+    void evaluate ( const std::size_t n , const double* x , double* f ) const override
+    { m_fun.evaluate ( n , x , f ) ; }
+    // ========================================================================
+  private:
+    // ========================================================================
+    FUNCTION            m_fun      ;
+    std::vector<Setter> m_setters  ;
+    std::vector<bool>   m_absolute ;
+    std::vector<double> m_signs    ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** @class Positive
+   *  positive polynomial: the Bernstein coefficients are linear in basis
+   *  functions, the Jacobian of coefficients with respect to the phases
+   *  does not depend on data
+   */
+  class Positive : public Component
+  {
+  public:
+    // ========================================================================
+    Positive ( const Ostap::Math::Positive&           fun  ,
+               const std::vector<const RooRealVar*>&  pars )
+      : m_fun ( fun )
+    {
+      m_pars = pars ;
+      m_dlogint .resize ( pars.size () ) ;
+      m_coeffs  .resize ( m_fun.bernstein ().npars () ) ;
+      m_jacobian.resize ( m_coeffs.size () * pars.size () ) ;
+    }
+    // ========================================================================
+    void update ( const double low , const double high ) override
+    {
+      const std::size_t N = m_pars.size   () ;
+      const std::size_t K = m_coeffs.size () ;
+      for ( std::size_t k = 0 ; k < N ; ++k ) { m_fun.setPar ( k , m_pars [ k ]->getVal () ) ; }
+      for ( std::size_t i = 0 ; i < K ; ++i ) { m_coeffs [ i ] = m_fun.bernstein ().par ( i ) ; }
+      m_integral = m_fun.integral ( low , high ) ;
+      //
+      for ( std::size_t k = 0 ; k < N ; ++k )
+      {
+        const double v = m_pars [ k ]->getVal () ;
+        const double h = step ( v ) ;
+        Ostap::Math::Positive f1 ( m_fun ) ; f1.setPar ( k , v + h ) ;
+        Ostap::Math::Positive f2 ( m_fun ) ; f2.setPar ( k , v - h ) ;
+        for ( std::size_t i = 0 ; i < K ; ++i )
+        { m_jacobian [ i * N + k ] = ( f1.bernstein ().par ( i ) - f2.bernstein ().par ( i ) ) / ( 2 * h ) ; }
+        m_dlogint [ k ] = ( f1.integral ( low , high ) - f2.integral ( low , high ) ) / ( 2 * h * m_integral ) ;
+      }
+    }
+    // ========================================================================
+    double dlogpdf ( const double x , double* dlog ) const override
+    {
+      const std::size_t N = m_pars.size   () ;
+      const std::size_t K = m_coeffs.size () ;
+      const double      t = std::min ( 1.0 , std::max ( 0.0 , m_fun.bernstein ().t ( x ) ) ) ;
+      //
+      Ostap::Math::Utils::Buffer b ( K ) ;
+      Ostap::Math::Utils::bernstein_basis ( K - 1 , t , 1 - t , b.data () ) ;
+      //
+      double f = 0 ;
+      for ( std::size_t i = 0 ; i < K ; ++i ) { f += m_coeffs [ i ] * b [ i ] ; }
+      std::fill ( dlog , dlog + N , 0.0 ) ;
+      for ( std::size_t i = 0 ; i < K ; ++i )
+      {
+        const double* J = m_jacobian.data () + i * N ;
+        for ( std::size_t k = 0 ; k < N ; ++k ) { dlog [ k ] += J [ k ] * b [ i ] ; }
+      }
+      const double fi = 1 / std::max ( f , s_TINY ) ;
+      for ( std::size_t k = 0 ; k < N ; ++k ) { dlog [ k ] *= fi ; }
+      return f ;
+    }
+    // ========================================================================
+    void evaluate ( const std::size_t n , const double* x , double* f ) const override
+    { m_fun.evaluate ( n , x , f ) ; }
+    // ========================================================================
+  private:
+    // ========================================================================
+    Ostap::Math::Positive m_fun      ;
+    std::vector<double>   m_coeffs   {} ;
+    std::vector<double>   m_jacobian {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** get the parameters of the shape
+   *  @return false if the observable is invalid or some parameters are not RooRealVar
+   */
+  bool shape_parameters
+  ( const RooAbsPdf&                pdf        ,
+    std::string&                    observable ,
+    std::vector<const RooRealVar*>& pars       )
+  {
+    pars.clear () ;
+    const std::vector<const RooAbsArg*> args = arguments ( pdf ) ;
+    if ( args.empty () ) { return false ; }
+    const RooRealVar* x = dynamic_cast<const RooRealVar*> ( args.front () ) ;
+    if ( nullptr == x ) { return false ; }
+    observable = x->GetName () ;
+    for ( std::size_t k = 1 ; k < args.size () ; ++k )
+    {
+      const RooRealVar* v = dynamic_cast<const RooRealVar*> ( args [ k ] ) ;
+      if ( nullptr == v ) { return false ; }
+      pars.push_back ( v ) ;
+    }
+    return true ;
+  }
+  // ==========================================================================
+  /// create the component for the supported shape
+  std::unique_ptr<Component> make_component
+  ( const RooAbsPdf&   pdf        ,
+    std::string&       observable )
+  {
+    std::unique_ptr<Component>     result ;
+    std::vector<const RooRealVar*> pars   ;
+    if ( !shape_parameters ( pdf , observable , pars ) ) { return result ; }
+    //
+    if      ( const auto* p = dynamic_cast<const Ostap::Models::CrystalBall*>   ( &pdf ) )
+    {
+      typedef Ostap::Math::CrystalBall F ;
+      result.reset ( new Peak<F> ( p->function () , pars ,
+                                   { &F::setM0 , &F::setSigma , &F::setAlpha , &F::setN } ,
+                                   { false     , true         , false        , true     } ) ) ;
+    }
+    else if ( const auto* p = dynamic_cast<const Ostap::Models::CrystalBallDS*> ( &pdf ) )
+    {
+      typedef Ostap::Math::CrystalBallDoubleSided F ;
+      result.reset ( new Peak<F> ( p->function () , pars ,
+                                   { &F::setM0 , &F::setSigma ,
+                                     &F::setAlpha_L , &F::setN_L , &F::setAlpha_R , &F::setN_R } ,
+                                   { false , true , false , true , false , true } ) ) ;
+    }
+    else if ( const auto* p = dynamic_cast<const Ostap::Models::Apollonios*>    ( &pdf ) )
+    {
+      typedef Ostap::Math::Apollonios F ;
+      result.reset ( new Peak<F> ( p->function () , pars ,
+                                   { &F::setM0 , &F::setSigma , &F::setAlpha , &F::setN , &F::setB } ,
+                                   { false     , true         , false        , true     , true     } ) ) ;
+    }
+    else if ( const auto* p = dynamic_cast<const Ostap::Models::StudentT*>      ( &pdf ) )
+    {
+      typedef Ostap::Math::StudentT F ;
+      result.reset ( new Peak<F> ( p->function () , pars ,
+                                   { &F::setM , &F::setSigma , &F::setN } ,
+                                   { true     , true         , true     } ) ) ;
+    }
+    else if ( const auto* p = dynamic_cast<const Ostap::Models::PolyPositive*>  ( &pdf ) )
+    { result.reset ( new Positive ( p->function () , pars ) ) ; }
+    //
+    return result ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+/** @class Ostap::MoreRooFit::GradientNLL::Model
+ *  The shapes, the yields and the thread pool
+ */
+// ============================================================================
+class Ostap::MoreRooFit::GradientNLL::Model
+{
+public:
+  // ==========================================================================
+  Model ( const RooAbsPdf& pdf , const unsigned int nthreads )
+  {
+    const RooAddPdf* add = dynamic_cast<const RooAddPdf*> ( &pdf ) ;
+    if ( nullptr == add ) { add_component ( pdf , nullptr ) ; }
+    else
+    {
+      const RooArgList& pdfs   = add->pdfList  () ;
+      const RooArgList& coeffs = add->coefList () ;
+      Ostap::Assert ( pdf.canBeExtended () && pdfs.getSize () == coeffs.getSize () ,
+                      "Only extended RooAddPdf is supported"   ,
+                      "Ostap::MoreRooFit::GradientNLL"         , INVALID_PDF ) ;
+      for ( int i = 0 ; i < pdfs.getSize () ; ++i )
+      {
+        const RooAbsPdf*  c = dynamic_cast<const RooAbsPdf*>  ( pdfs.at   ( i ) ) ;
+        const RooRealVar* y = dynamic_cast<const RooRealVar*> ( coeffs.at ( i ) ) ;
+        Ostap::Assert ( nullptr != c && nullptr != y            ,
+                        "Invalid component/yield of RooAddPdf"  ,
+                        "Ostap::MoreRooFit::GradientNLL"        , INVALID_PDF ) ;
+        add_component ( *c , y ) ;
+      }
+    }
+    //
+    if ( 1 < nthreads ) { m_pool.reset ( new Ostap::Utils::WorkerPool ( nthreads ) ) ; }
+  }
+  // ==========================================================================
+  /// extended likelihood ?
+  bool extended () const { return !m_yields.empty () ; }
+  /// the name of observable
+  const std::string& observable () const { return m_observable ; }
+  /// the parameters
+  const std::vector<const RooRealVar*>& parameters () const { return m_parameters ; }
+  // ==========================================================================
+  /// the value and (optionally) the gradient
+  double nll
+  ( const std::vector<double>& values   ,
+    const std::vector<double>& weights  ,
+    const double               low      ,
+    const double               high     ,
+    double*                    gradient )
+  {
+    const std::size_t NC = m_components.size () ;
+    const std::size_t NP = m_parameters.size () ;
+    const std::size_t NE = values.size       () ;
+    const bool        ex = extended () ;
+    //
+    for ( auto& c : m_components ) { c->update ( low , high ) ; }
+    std::vector<double> yields ( NC , 1.0 ) ;
+    if ( ex ) { for ( std::size_t j = 0 ; j < NC ; ++j ) { yields [ j ] = m_yields [ j ]->getVal () ; } }
+    //
+    const std::size_t NB = std::max<std::size_t> ( 1 , NE / s_BLOCK ) ;
+    const Ostap::Utils::Chunks blocks = Ostap::Utils::split ( 0 , NE , NB ) ;
+    std::vector<double> bvalues ( blocks.size () , 0.0 ) ;
+    //
+    // the value only: the array kernels of the shapes and the block-wise log-sum
+    if ( !gradient )
+    {
+      std::vector<double> scale ( NC ) ;
+      for ( std::size_t j = 0 ; j < NC ; ++j ) { scale [ j ] = yields [ j ] / m_components [ j ]->integral () ; }
+      run ( blocks.size () , [&] ( const std::size_t b )
+        {
+          const std::size_t first = blocks [ b ].first ;
+          const std::size_t n     = blocks [ b ].last - first ;
+          const double*     x     = values .data () + first ;
+          const double*     w     = weights.data () + first ;
+          // the scratch memory from the per-thread arena
+          Ostap::Utils::ArenaScope scope {} ;
+          double* F = scope.allocate<double> ( n ) ;
+          double* f = scope.allocate<double> ( n ) ;
+          std::fill ( F , F + n , 0.0 ) ;
+          for ( std::size_t j = 0 ; j < NC ; ++j )
+          {
+            m_components [ j ]->evaluate ( n , x , f ) ;
+            const double c = scale [ j ] ;
+            for ( std::size_t i = 0 ; i < n ; ++i ) { F [ i ] += c * f [ i ] ; }
+          }
+          double result = 0 ;
+          for ( std::size_t i = 0 ; i < n ; ++i )
+          { if ( 0 != w [ i ] ) { result -= w [ i ] * std::log ( std::max ( F [ i ] , s_TINY ) ) ; } }
+          bvalues [ b ] = result ;
+        } ) ;
+      double result = Ostap::Math::sum_kahan ( bvalues.begin () , bvalues.end () ) ;
+      if ( ex ) { for ( std::size_t j = 0 ; j < NC ; ++j ) { result += yields [ j ] ; } }
+      return result ;
+    }
+    //
+    std::vector<double> bgrads  ( gradient ? blocks.size () * NP : 0 , 0.0 ) ;
+    std::vector<double> bsums   ( gradient ? blocks.size () * NC : 0 , 0.0 ) ;
+    //
+    auto block = [&] ( const std::size_t b )
+      {
+        std::vector<std::vector<double> > dlog ( NC ) ;
+        for ( std::size_t j = 0 ; j < NC ; ++j ) { dlog [ j ].resize ( m_components [ j ]->pars ().size () ) ; }
+        std::vector<double> g ( NC ) ;
+        double* grad   = gradient ? bgrads.data () + b * NP : nullptr ;
+        double* sums   = gradient ? bsums .data () + b * NC : nullptr ;
+        double  result = 0 ;
+        for ( unsigned long i = blocks [ b ].first ; i < blocks [ b ].last ; ++i )
+        {
+          const double w = weights [ i ] ;
+          const double x = values  [ i ] ;
+          if ( 0 == w ) { continue ; }
+          // the normalized densities (multiplied by yields)
+          double F = 0 ;
+          for ( std::size_t j = 0 ; j < NC ; ++j )
+          {
+            g [ j ] = m_components [ j ]->dlogpdf ( x , dlog [ j ].data () ) / m_components [ j ]->integral () ;
+            F      += yields [ j ] * g [ j ] ;
+          }
+          F = std::max ( F , s_TINY ) ;
+          result -= w * std::log ( F ) ;
+          if ( !grad ) { continue ; }
+          for ( std::size_t j = 0 ; j < NC ; ++j )
+          {
+            const double r = w * g [ j ] / F ;
+            if ( ex ) { grad [ m_yindex [ j ] ] -= r ; }
+            const double                     ry = r * yields [ j ]   ;
+            sums [ j ] += ry ;
+            const std::vector<unsigned int>& ix = m_index  [ j ]     ;
+            const std::vector<double>&       dl = dlog     [ j ]     ;
+            for ( std::size_t k = 0 ; k < ix.size () ; ++k ) { grad [ ix [ k ] ] -= ry * dl [ k ] ; }
+          }
+        }
+        bvalues [ b ] = result ;
+      } ;
+    //
+    run ( blocks.size () , block ) ;
+    //
+    // the fixed order of summation: the result does not depend on the number of threads
+    double result = Ostap::Math::sum_kahan ( bvalues.begin () , bvalues.end () ) ;
+    std::vector<double> sums ( NC , 0.0 ) ;
+    if ( gradient )
+    {
+      std::fill ( gradient , gradient + NP , 0.0 ) ;
+      for ( std::size_t b = 0 ; b < blocks.size () ; ++b )
+      {
+        for ( std::size_t k = 0 ; k < NP ; ++k ) { gradient [ k ] += bgrads [ b * NP + k ] ; }
+        for ( std::size_t j = 0 ; j < NC ; ++j ) { sums     [ j ] += bsums  [ b * NC + j ] ; }
+      }
+    }
+    //
+    for ( std::size_t j = 0 ; j < NC ; ++j )
+    {
+      // the extended term
+      if ( ex ) { result += yields [ j ] ; if ( gradient ) { gradient [ m_yindex [ j ] ] += 1 ; } }
+      if ( !gradient ) { continue ; }
+      // the normalization: d/dp log I_j enters with the weight sum_i w_i N_j g_ij / F_i
+      const std::vector<unsigned int>& ix = m_index [ j ] ;
+      const std::vector<double>&       dl = m_components [ j ]->dlogint () ;
+      for ( std::size_t k = 0 ; k < ix.size () ; ++k ) { gradient [ ix [ k ] ] += sums [ j ] * dl [ k ] ; }
+    }
+    return result ;
+  }
+  // ==========================================================================
+private:
+  // ==========================================================================
+  /// process the blocks, dynamically distributed among the threads
+  template <class BLOCK>
+  void run ( const std::size_t nblocks , BLOCK block ) const
+  {
+    if ( !m_pool || nblocks < 2 ) { for ( std::size_t b = 0 ; b < nblocks ; ++b ) { block ( b ) ; } }
+    else
+    {
+      std::atomic<std::size_t> next { 0 } ;
+      m_pool->run ( [&] ( const unsigned int /* index */ )
+        { for ( std::size_t b = next++ ; b < nblocks ; b = next++ ) { block ( b ) ; } } ) ;
+    }
+  }
+  // ==========================================================================
+  /// index of the parameter in the global list
+  unsigned int index ( const RooRealVar* p )
+  {
+    auto it = std::find ( m_parameters.begin () , m_parameters.end () , p ) ;
+    if ( m_parameters.end () != it ) { return it - m_parameters.begin () ; }
+    m_parameters.push_back ( p ) ;
+    return m_parameters.size () - 1 ;
+  }
+  // ==========================================================================
+  /// add the component
+  void add_component ( const RooAbsPdf& pdf , const RooRealVar* yield )
+  {
+    std::string observable ;
+    std::unique_ptr<Component> c = make_component ( pdf , observable ) ;
+    Ostap::Assert ( nullptr != c.get ()                                     ,
+                    std::string ( "Unsupported PDF " ) + pdf.GetName ()     ,
+                    "Ostap::MoreRooFit::GradientNLL"                        , INVALID_PDF ) ;
+    Ostap::Assert ( m_observable.empty () || m_observable == observable     ,
+                    "Components have different observables"                 ,
+                    "Ostap::MoreRooFit::GradientNLL"                        , INVALID_OBSERVABLE ) ;
+    m_observable = observable ;
+    //
+    if ( nullptr != yield )
+    { m_yields.push_back ( yield ) ; m_yindex.push_back ( index ( yield ) ) ; }
+    std::vector<unsigned int> ix ;
+    for ( const RooRealVar* p : c->pars () ) { ix.push_back ( index ( p ) ) ; }
+    m_index     .push_back ( ix ) ;
+    m_components.push_back ( std::move ( c ) ) ;
+  }
+  // ==========================================================================
+private:
+  // ==========================================================================
+  /// the shapes
+  std::vector<std::unique_ptr<Component> >  m_components {} ;
+  /// the yields (for extended model)
+  std::vector<const RooRealVar*>            m_yields     {} ;
+  /// the indices of yields in the global list
+  std::vector<unsigned int>                 m_yindex     {} ;
+  /// the indices of shape parameters in the global list
+  std::vector<std::vector<unsigned int> >   m_index      {} ;
+  /// all parameters
+  std::vector<const RooRealVar*>            m_parameters {} ;
+  /// the name of observable
+  std::string                               m_observable {} ;
+  /// the thread pool
+  std::unique_ptr<Ostap::Utils::WorkerPool> m_pool       {} ;
+  // ==========================================================================
+} ;
+// ============================================================================
+/*  constructor
+ *  @param name       the name
+ *  @param title      the title
+ *  @param pdf        the PDF
+ *  @param data       the data
+ *  @param nthreads   the number of threads
+ */
+// ============================================================================
+Ostap::MoreRooFit::GradientNLL::GradientNLL
+( const std::string&  name       ,
+  const std::string&  title      ,
+  const RooAbsPdf&    pdf        ,
+  const RooAbsData&   data       ,
+  const unsigned int  nthreads   )
+  : RooAbsReal   ( name.c_str () , title.c_str () )
+  , m_parameters ( "!pars" , "parameters" , this )
+  , m_nthreads   ( Ostap::Utils::nThreads ( nthreads ) )
+  , m_pdf        ( &pdf )
+{
+  const Model& model = model_ () ;
+  m_extended   = model.extended   () ;
+  m_observable = model.observable () ;
+  for ( const RooRealVar* p : model.parameters () ) { m_parameters.add ( *p ) ; }
+  //
+  const RooArgSet* vars = data.get () ;
+  Ostap::Assert ( nullptr != vars                  ,
+                  "Invalid data"                   ,
+                  "Ostap::MoreRooFit::GradientNLL" , INVALID_DATA ) ;
+  const RooRealVar* x = dynamic_cast<const RooRealVar*> ( vars->find ( m_observable.c_str () ) ) ;
+  Ostap::Assert ( nullptr != x                                   ,
+                  "No observable " + m_observable + " in data"   ,
+                  "Ostap::MoreRooFit::GradientNLL"               , INVALID_OBSERVABLE ) ;
+  // the range: from the observable of PDF
+  std::unique_ptr<RooArgSet> observables { pdf.getObservables ( *vars ) } ;
+  const RooRealVar* xp = dynamic_cast<const RooRealVar*> ( observables->find ( m_observable.c_str () ) ) ;
+  m_low  = nullptr != xp ? xp->getMin () : x->getMin () ;
+  m_high = nullptr != xp ? xp->getMax () : x->getMax () ;
+  //
+  const int nentries = data.numEntries () ;
+  m_values .reserve ( nentries ) ;
+  m_weights.reserve ( nentries ) ;
+  for ( int i = 0 ; i < nentries ; ++i )
+  {
+    data.get ( i ) ;
+    const double v = x->getVal () ;
+    if ( v < m_low || m_high < v ) { continue ; }
+    m_values .push_back ( v ) ;
+    m_weights.push_back ( data.weight () ) ;
+  }
+}
+// ============================================================================
+// default constructor, needed for serialization
+// ============================================================================
+Ostap::MoreRooFit::GradientNLL::GradientNLL () = default ;
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::MoreRooFit::GradientNLL::GradientNLL
+( const Ostap::MoreRooFit::GradientNLL& right ,
+  const char*                           name  )
+  : RooAbsReal   ( right , name )
+  , m_parameters ( "!pars" , this , right.m_parameters )
+  , m_extended   ( right.m_extended   )
+  , m_nthreads   ( right.m_nthreads   )
+  , m_observable ( right.m_observable )
+  , m_low        ( right.m_low        )
+  , m_high       ( right.m_high       )
+  , m_pdf        ( right.m_pdf        )
+  , m_values     ( right.m_values     )
+  , m_weights    ( right.m_weights    )
+{}
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::MoreRooFit::GradientNLL::~GradientNLL(){}
+// ============================================================================
+// clone method
+// ============================================================================
+Ostap::MoreRooFit::GradientNLL*
+Ostap::MoreRooFit::GradientNLL::clone ( const char* newname ) const
+{ return new Ostap::MoreRooFit::GradientNLL ( *this , newname ) ; }
+// ============================================================================
+// is the PDF supported?
+// ============================================================================
+bool Ostap::MoreRooFit::GradientNLL::supported ( const RooAbsPdf& pdf )
+{
+  std::string      observable ;
+  const RooAddPdf* add = dynamic_cast<const RooAddPdf*> ( &pdf ) ;
+  if ( nullptr == add ) { return nullptr != make_component ( pdf , observable ).get () ; }
+  //
+  const RooArgList& pdfs   = add->pdfList  () ;
+  const RooArgList& coeffs = add->coefList () ;
+  if ( !pdf.canBeExtended () || pdfs.getSize () != coeffs.getSize () ) { return false ; }
+  for ( int i = 0 ; i < pdfs.getSize () ; ++i )
+  {
+    const RooAbsPdf* c = dynamic_cast<const RooAbsPdf*> ( pdfs.at ( i ) ) ;
+    if ( nullptr == c || nullptr == dynamic_cast<const RooRealVar*> ( coeffs.at ( i ) ) ) { return false ; }
+    std::string name ;
+    if ( !make_component ( *c , name ) ) { return false ; }
+    if ( !observable.empty () && name != observable ) { return false ; }
+    observable = name ;
+  }
+  return true ;
+}
+// ============================================================================
+// get the model
+// ============================================================================
+Ostap::MoreRooFit::GradientNLL::Model&
+Ostap::MoreRooFit::GradientNLL::model_ () const
+{
+  if ( !m_model )
+  {
+    Ostap::Assert ( nullptr != m_pdf                 ,
+                    "Invalid PDF"                    ,
+                    "Ostap::MoreRooFit::GradientNLL" , INVALID_PDF ) ;
+    m_model.reset ( new Model ( *m_pdf , m_nthreads ) ) ;
+  }
+  return *m_model ;
+}
+// ============================================================================
+// the actual evaluation of the result
+// ============================================================================
+Double_t Ostap::MoreRooFit::GradientNLL::evaluate () const
+{ return model_ ().nll ( m_values , m_weights , m_low , m_high , nullptr ) ; }
+// ============================================================================
+// get the value and the gradient with respect to parameters
+// ============================================================================
+double Ostap::MoreRooFit::GradientNLL::nll ( std::vector<double>& gradient ) const
+{
+  gradient.resize ( m_parameters.getSize () ) ;
+  return model_ ().nll ( m_values , m_weights , m_low , m_high , gradient.data () ) ;
+}
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /** @class GradFunction
+   *  the adapter for Minuit with the analytic gradient
+   */
+  class GradFunction : public ROOT::Math::IMultiGradFunction
+  {
+  public:
+    // ========================================================================
+    GradFunction ( const Ostap::MoreRooFit::GradientNLL& nll  ,
+                   const std::vector<RooRealVar*>&       pars )
+      : m_nll  ( &nll )
+      , m_pars ( pars )
+    {}
+    // ========================================================================
+    GradFunction* Clone () const override { return new GradFunction ( *this ) ; }
+    unsigned int  NDim  () const override { return m_pars.size () ; }
+    // ========================================================================
+    void Gradient ( const double* x , double* grad ) const override
+    { double f ; FdF ( x , f , grad ) ; }
+    void FdF ( const double* x , double& f , double* grad ) const override
+    {
+      set ( x ) ;
+      f = m_nll->nll ( m_grad ) ;
+      std::copy ( m_grad.begin () , m_grad.end () , grad ) ;
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    void set ( const double* x ) const
+    { for ( std::size_t k = 0 ; k < m_pars.size () ; ++k ) { m_pars [ k ]->setVal ( x [ k ] ) ; } }
+    double DoEval ( const double* x ) const override
+    { set ( x ) ; return m_nll->getVal () ; }
+    double DoDerivative ( const double* x , unsigned int icoord ) const override
+    {
+      set ( x ) ;
+      m_nll->nll ( m_grad ) ;
+      return m_grad [ icoord ] ;
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    const Ostap::MoreRooFit::GradientNLL* m_nll  ;
+    std::vector<RooRealVar*>              m_pars ;
+    mutable std::vector<double>           m_grad {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+}
+// ============================================================================
+/*  minimize NLL using Minuit2 with the analytic gradient
+ *  the values and errors of parameters are updated
+ *  @param strategy   Minuit strategy
+ *  @param tolerance  the tolerance
+ *  @param printlevel print level
+ *  @return status of the minimization (0 for success)
+ */
+// ============================================================================
+int Ostap::MoreRooFit::GradientNLL::migrad
+( const int    strategy   ,
+  const double tolerance  ,
+  const int    printlevel )
+{
+  std::unique_ptr<ROOT::Math::Minimizer> minimizer
+    ( ROOT::Math::Factory::CreateMinimizer ( "Minuit2" , "Migrad" ) ) ;
+  if ( !minimizer ) { minimizer.reset ( ROOT::Math::Factory::CreateMinimizer ( "Minuit" , "Migrad" ) ) ; }
+  Ostap::Assert ( nullptr != minimizer.get ()      ,
+                  "Cannot create the minimizer"    ,
+                  "Ostap::MoreRooFit::GradientNLL" , INVALID_MINIMIZER ) ;
+  //
+  std::vector<RooRealVar*> pars ;
+  for ( RooAbsArg* a : m_parameters )
+  {
+    RooRealVar* v = dynamic_cast<RooRealVar*> ( a ) ;
+    Ostap::Assert ( nullptr != v                     ,
+                    "Invalid parameter"              ,
+                    "Ostap::MoreRooFit::GradientNLL" , INVALID_PARAMETER ) ;
+    pars.push_back ( v ) ;
+  }
+  //
+  const GradFunction function ( *this , pars ) ;
+  minimizer->SetFunction   ( function   ) ;
+  minimizer->SetStrategy   ( strategy   ) ;
+  minimizer->SetTolerance  ( tolerance  ) ;
+  minimizer->SetErrorDef   ( defaultErrorLevel () ) ;
+  minimizer->SetPrintLevel ( printlevel ) ;
+  //
+  for ( std::size_t k = 0 ; k < pars.size () ; ++k )
+  {
+    const RooRealVar* v    = pars [ k ] ;
+    const double      val  = v->getVal () ;
+    const double      err  = 0 < v->getError () ? v->getError () : 0.1 * std::max ( 1.e-3 , std::abs ( val ) ) ;
+    if      ( v->isConstant () )
+    { minimizer->SetFixedVariable   ( k , v->GetName () , val ) ; }
+    else if ( v->hasMin () && v->hasMax () )
+    { minimizer->SetLimitedVariable ( k , v->GetName () , val , err , v->getMin () , v->getMax () ) ; }
+    else
+    { minimizer->SetVariable        ( k , v->GetName () , val , err ) ; }
+  }
+  //
+  minimizer->Minimize () ;
+  //
+  const double* xs = minimizer->X      () ;
+  const double* es = minimizer->Errors () ;
+  for ( std::size_t k = 0 ; k < pars.size () ; ++k )
+  {
+    if ( pars [ k ]->isConstant () ) { continue ; }
+    pars [ k ]->setVal ( xs [ k ] ) ;
+    if ( nullptr != es ) { pars [ k ]->setError ( es [ k ] ) ; }
+  }
+  //
+  return minimizer->Status () ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -5,11 +5,18 @@
 // STD& STL
 // ============================================================================
 #include <cmath>
+#include <map>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <algorithm>
+#include <exception>
 // ============================================================================
 // GSL 
 // ============================================================================
 #include "gsl/gsl_math.h"
-#include "gsl/gsl_multimin.h"
 #include "gsl/gsl_linalg.h"
 // ============================================================================
 // Ostap
@@ -20,6 +27,7 @@
 // Local
 // ============================================================================
 #include "GSL_sentry.h"
+#include "local_mt.h"
 // ============================================================================
 namespace 
 {
@@ -135,28 +143,90 @@ namespace
     }
   }
   // ==========================================================================
+  /** get the step from the dyadic ladder <code>h0*2^k</code>, 
+   *  that is the closest to <code>h</code> 
+   *  The stencils for the steps from the ladder share the points 
+   */
+  inline double _dyadic_ 
+  ( const double h  , 
+    const double h0 ) 
+  {
+    const int k = static_cast<int> ( std::lround ( std::log2 ( h / h0 ) ) ) ;
+    return std::ldexp ( h0 , k ) ;
+  }
+  // ==========================================================================
+  /** @class Direction 
+   *  the function along the direction <code>x+s*d</code>
+   *  with the cache of the evaluated values 
+   */
+  class Direction 
+  {
+  public:
+    // ========================================================================
+    Direction 
+    ( function          f      , 
+      void*             params , 
+      const gsl_vector* x      , 
+      const gsl_vector* d      , 
+      const double      f0     , 
+      gsl_vector*       a      ) 
+      : m_func   ( f      )
+      , m_params ( params ) 
+      , m_x      ( x      ) 
+      , m_d      ( d      ) 
+      , m_f0     ( f0     ) 
+      , m_a      ( a      ) 
+    {}
+    // ========================================================================
+    /// the function value at x+s*d 
+    double operator() ( const double s ) 
+    {
+      if ( 0 == s ) { return m_f0 ; }                        // central point 
+      //
+      auto found = m_cache.find ( s ) ;
+      if ( m_cache.end () != found ) { return found->second ; }
+      //
+      _update_ ( m_x , m_d , s , m_a ) ;
+      const double value = (*m_func) ( m_a , m_params ) ;
+      ++m_ncalls ;
+      m_cache.emplace ( s , value ) ;
+      return value ;
+    }
+    // ========================================================================
+    const gsl_vector* x      () const { return m_x      ; }
+    const gsl_vector* d      () const { return m_d      ; }
+    unsigned long     ncalls () const { return m_ncalls ; }
+    // ========================================================================
+  private:
+    // ========================================================================
+    function                 m_func       ;
+    void*                    m_params     ;
+    const gsl_vector*        m_x          ;
+    const gsl_vector*        m_d          ;
+    double                   m_f0         ;
+    gsl_vector*              m_a          ;
+    std::map<double,double>  m_cache      ;
+    unsigned long            m_ncalls { 0 } ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
   // get the second derivative along the direction d
   // ==========================================================================
   double deriv2_8
-  ( const gsl_multimin_function* f  , 
-    const gsl_vector*            x  ,
-    const gsl_vector*            d  ,
+  ( Direction&                   f  , 
     double                       h  ,
     double*                  round  , 
-    double*                  trunc  , 
-    gsl_vector*                  a ) 
+    double*                  trunc  ) 
   {
     //
     double values[9] ;
     const double h0 = 0.25 * std::abs ( h ) ;
     //
-    
     for ( std::size_t j = 0 ; j < 9 ; ++j ) 
-    {
-      const double s = ( j - 4.0 )  * h0 ;      
-      _update_ ( x , d , s , a ) ;
-      values [ j ] = GSL_MULTIMIN_FN_EVAL_F( f , a  ) ;
-    }
+    { values [ j ] = f ( ( j - 4.0 ) * h0 ) ; }
+    //
+    const gsl_vector* x = f.x () ;
+    const gsl_vector* d = f.d () ;
     //
     double xx = 0 ;
     for ( unsigned int j = 0 ; j < x->size ; ++j ) 
@@ -177,18 +247,15 @@ namespace
   // get the second derivative along the direction d
   // ==========================================================================
   double deriv2
-  ( const gsl_multimin_function* f , 
-    const gsl_vector*            x ,
-    const gsl_vector*            d ,
+  ( Direction&                   f , 
     double                       h ,
-    double*                      e , 
-    gsl_vector*                  a ) 
+    double*                      e ) 
   {
     //
     double round ;
     double trunc ;
     //
-    double result = deriv2_8 ( f  , x  , d  , h  , &round , &trunc , a  ) ;
+    double result = deriv2_8 ( f  , h  , &round , &trunc ) ;
     //
     *e = round + trunc ;
     //
@@ -208,10 +275,12 @@ namespace
       //
       if ( std::abs ( corr - 1 )  < 0.25 ) { break ; }   // BREAK   
       //
-      if ( 0 != corr ) { h_new *= corr ; }
-      else             { h_new /= 2    ; }
+      // the new step from the dyadic ladder: reuse the evaluated points 
+      const double h_next = 0 != corr ? _dyadic_ ( h_new * corr , h ) : 0.5 * h_new ;
+      if ( h_next == h_new ) { break ; }                 // BREAK 
+      h_new = h_next ;
       //
-      res   = deriv2_8 ( f , x , d , h_new , &round , &trunc , a ) ;
+      res   = deriv2_8 ( f , h_new , &round , &trunc ) ;
       //
       if ( iter > 2 && ( *e ) < ( trunc + round) ) { break    ; } // BREAK 
       //
@@ -225,35 +294,59 @@ namespace
     return result ;
   }
   // ==========================================================================
-  // get the second derivative along pseudo-axis 
-  // ==========================================================================
-  double deriv2 
-  ( const gsl_multimin_function* f , 
-    const gsl_vector*            x ,
-    const unsigned short         i , 
-    const unsigned short         j ,
-    double                       h ,
-    double*                  error , 
-    gsl_vector*                  a ,  // helper vector (workspace)
-    gsl_vector*                  b )  // helper vector (workspace)
+  /** @class Workspace 
+   *  the thread-local workspace: parameters and helper vectors 
+   */
+  class Workspace 
   {
-    //
-    gsl_vector_set_zero ( b ) ;    
-    //
-    // define the direction 
-    if ( i == j  ) 
-    { 
-      gsl_vector_set ( b , i , 1 ) ; 
-    }
-    else 
-    { 
-      gsl_vector_set ( b , i ,  s_SQRT2i ) ;
-      gsl_vector_set ( b , j ,  s_SQRT2i ) ;
+  public:
+    // ========================================================================
+    /// the shared parameters and helper vectors  
+    Workspace 
+    ( void*       params , 
+      gsl_vector* a      , 
+      gsl_vector* b      ) 
+      : m_params ( params ) 
+      , m_a      ( a      ) 
+      , m_b      ( b      ) 
+    {}
+    /// cloned parameters and own helper vectors 
+    Workspace 
+    ( void*                                 params , 
+      const std::size_t                     n      , 
+      Ostap::Math::GSL::Hesse::clone        c      , 
+      Ostap::Math::GSL::Hesse::release      r      ) 
+      : m_params  ( c ? (*c) ( params ) : params ) 
+      , m_a       ( gsl_vector_calloc ( n ) ) 
+      , m_b       ( gsl_vector_calloc ( n ) ) 
+      , m_release ( c ? r : 0 ) 
+      , m_own     ( true ) 
+    {}
+    /// destructor 
+    ~Workspace () 
+    {
+      if ( m_release && m_params ) { (*m_release) ( m_params ) ; }
+      if ( m_own ) 
+      {
+        if ( 0 != m_a ) { gsl_vector_free ( m_a ) ; }
+        if ( 0 != m_b ) { gsl_vector_free ( m_b ) ; }
+      }
     }
-    //
-    return deriv2  ( f , x , b , h , error , a ) ;
     // ========================================================================
-  }
+  private:
+    // ========================================================================
+    Workspace            ( const Workspace& ) = delete ;
+    Workspace& operator= ( const Workspace& ) = delete ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    void*                            m_params  { 0     } ;
+    gsl_vector*                      m_a       { 0     } ;
+    gsl_vector*                      m_b       { 0     } ;
+    Ostap::Math::GSL::Hesse::release m_release { 0     } ;
+    bool                             m_own     { false } ;
+    // ========================================================================
+  } ;
   // ==========================================================================
 } // end of namespace 
 // ============================================================================
@@ -271,19 +364,45 @@ Ostap::Math::GSL::Hesse::Hesse
   const gsl_vector* x      ,
   void*             params , 
   const double      h      ) 
+  : Hesse ( f , x , params , h , 1 ) 
+{}
+// ============================================================================
+/*  constructor with all parameters 
+ *  @param f        the function to be used 
+ *  @param x        the point for hessian to be evaluated 
+ *  @param params   the parameters for the function 
+ *  @param h        the step-size (guess)
+ *  @param nthreads number of threads, 0 means all available 
+ *  @param c        clone parameters for the separate thread 
+ *  @param r        release the cloned parameters 
+ */
+// ============================================================================
+Ostap::Math::GSL::Hesse::Hesse
+( function           f        ,
+  const gsl_vector*  x        ,
+  void*              params   , 
+  const double       h        , 
+  const unsigned int nthreads , 
+  clone              c        , 
+  release            r        ) 
+//
+  : m_func     ( f        ) 
+  , m_x        ( x        ) 
+  , m_params   ( params   ) 
 //
-  : m_func   ( f      ) 
-  , m_x      ( x      ) 
-  , m_params ( params ) 
+  , m_h        ( std::abs ( h ) )
 //
-  , m_h      ( std::abs ( h ) )
+  , m_nthreads ( nthreads ) 
+  , m_clone    ( c        ) 
+  , m_release  ( r        ) 
+  , m_ncalls   ( 0        ) 
 //
-  , m_hesse  ( 0      )
-  , m_aux    ( 0      )
-  , m_cov2   ( 0      )
+  , m_hesse    ( 0        )
+  , m_aux      ( 0        )
+  , m_cov2     ( 0        )
 //
-  , m_a      ( 0 ) 
-  , m_b      ( 0 )
+  , m_a        ( 0        ) 
+  , m_b        ( 0        )
 {
   m_a     = gsl_vector_calloc ( x -> size ) ;
   m_b     = gsl_vector_calloc ( x -> size ) ;
@@ -310,40 +429,90 @@ Ostap::StatusCode Ostap::Math::GSL::Hesse::calcHesse ()
   // if ( 0 == m_func ) { return InvalidFunction ; }
   //
   if ( 0 != m_hesse ) { gsl_matrix_free ( m_hesse ) ; m_hesse = 0 ; }
-  if ( 0 != m_aux   ) { gsl_matrix_free ( m_aux   ) ; m_cov2  = 0 ; }
+  if ( 0 != m_aux   ) { gsl_matrix_free ( m_aux   ) ; m_aux   = 0 ; }
   //
-  // allocate new matrix 
+  const std::size_t N = size () ;
   //
-  m_hesse = gsl_matrix_calloc ( size () , size () )  ;
-  m_aux   = gsl_matrix_calloc ( size () , size () )  ;
+  // the directions: the axes and the diagonals 
+  std::vector<std::pair<std::size_t,std::size_t> > directions ;
+  directions.reserve ( N * ( N + 1 ) / 2 ) ;
+  for ( std::size_t i = 0 ; i < N ; ++i ) 
+  { for ( std::size_t j = i ; j < N ; ++j ) { directions.emplace_back ( i , j ) ; } }
   //
-  double error = 0 ;
+  // the central point is common for all directions 
+  const double f0 = (*m_func) ( m_x , m_params ) ;
   //
-  gsl_multimin_function F ;
-  F.f      = m_func      ;
-  F.params = m_params    ;
-  F.n      = m_x -> size ;
+  const std::size_t nt = std::max ( std::size_t ( 1 ) , std::min 
+    ( directions.size () , 
+      std::size_t ( 1 == m_nthreads ? 1u : Ostap::Utils::nThreads ( m_nthreads ) ) ) ) ;
   //
-  // fill auxillary Hesse matrix 
-  for ( std::size_t i = 0 ; i < m_aux->size1 ; ++i ) 
+  // thread-local workspaces: the first one is used by this thread 
+  std::vector<std::unique_ptr<Workspace> > workspaces ;
+  workspaces.reserve ( nt ) ;
+  workspaces.emplace_back ( new Workspace ( m_params , m_a , m_b ) ) ;
+  for ( std::size_t t = 1 ; t < nt ; ++t ) 
   {
-    //
-    for ( std::size_t j = 0 ; j < m_aux->size2 ; ++j )
+    workspaces.emplace_back ( new Workspace ( m_params , N , m_clone , m_release ) ) ;
+    if ( 0 == workspaces.back()->m_params ) { return Ostap::StatusCode ( 300 ) ; } 
+  }
+  //
+  std::vector<double>             values ( directions.size () , 0 ) ;
+  std::vector<unsigned long>      calls  ( nt , 0 ) ;
+  std::vector<std::exception_ptr> errors ( nt ) ;
+  std::atomic<std::size_t>        next   { 0 } ;
+  //
+  auto task = [&] ( const std::size_t t ) 
     {
-      //
-      const double hij = deriv2  ( &F       , 
-                                   m_x      , 
-                                   i        , 
-                                   j        , 
-                                   m_h      , 
-                                   &error   , 
-                                   m_a      ,  
-                                   m_b      ) ;
-      //
-      gsl_matrix_set ( m_aux , i , j , hij ) ;
-      //
-    }
-    //
+      try 
+      {
+        Workspace& w = *workspaces [ t ] ;
+        for ( std::size_t k = next++ ; k < directions.size () ; k = next++ ) 
+        {
+          const std::size_t i = directions [ k ].first  ;
+          const std::size_t j = directions [ k ].second ;
+          //
+          // define the direction 
+          gsl_vector_set_zero ( w.m_b ) ;
+          if ( i == j ) { gsl_vector_set ( w.m_b , i , 1 ) ; }
+          else 
+          { 
+            gsl_vector_set ( w.m_b , i , s_SQRT2i ) ;
+            gsl_vector_set ( w.m_b , j , s_SQRT2i ) ;
+          }
+          //
+          Direction F ( m_func , w.m_params , m_x , w.m_b , f0 , w.m_a ) ;
+          double error = 0 ;
+          values [ k ]  = deriv2 ( F , m_h , &error ) ;
+          calls  [ t ] += F.ncalls () ;
+        }
+      }
+      catch ( ... ) { errors [ t ] = std::current_exception () ; }
+    } ;
+  //
+  std::vector<std::thread> threads ;
+  threads.reserve ( nt ) ;
+  for ( std::size_t t = 1 ; t < nt ; ++t ) { threads.emplace_back ( task , t ) ; }
+  task ( 0 ) ;
+  for ( auto& t : threads ) { t.join () ; }
+  //
+  workspaces.clear () ;
+  for ( const auto& e : errors ) { if ( e ) { std::rethrow_exception ( e ) ; } }
+  //
+  m_ncalls = 1 ;
+  for ( const auto c : calls ) { m_ncalls += c ; }
+  //
+  // allocate new matrix 
+  //
+  m_hesse = gsl_matrix_calloc ( N , N )  ;
+  m_aux   = gsl_matrix_calloc ( N , N )  ;
+  //
+  // fill auxillary Hesse matrix 
+  for ( std::size_t k = 0 ; k < directions.size () ; ++k ) 
+  {
+    const std::size_t i = directions [ k ].first  ;
+    const std::size_t j = directions [ k ].second ;
+    gsl_matrix_set ( m_aux , i , j , values [ k ] ) ;
+    gsl_matrix_set ( m_aux , j , i , values [ k ] ) ;
   }
   //
   // adjust hesse matrix 
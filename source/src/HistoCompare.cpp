@@ -0,0 +1,318 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <cmath>
+#include <atomic>
+#include <limits>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TH1.h"
+#include "TAxis.h"
+#include "TMath.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/HistoCompare.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Utils::HistoCompare
+ *  @see Ostap::Utils::HistoCompare
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  typedef Ostap::Math::ValueWithError VE ;
+  // ==========================================================================
+  /** @struct Bins
+   *  The content of the histogram (no underflow/overflow bins)
+   *  as the plain arrays: values, squared errors and the bin volumes
+   *  the order of bins: x is the outer loop, z is the inner loop
+   */
+  struct Bins
+  {
+    // ========================================================================
+    Bins ( const TH1* h )
+    {
+      Ostap::Assert ( nullptr != h                    ,
+                      "Invalid histogram"             ,
+                      "Ostap::Utils::HistoCompare"    ) ;
+      const int dim = h->GetDimension () ;
+      const TAxis* xa = h->GetXaxis () ;
+      const TAxis* ya = h->GetYaxis () ;
+      const TAxis* za = h->GetZaxis () ;
+      nx = xa->GetNbins () ;
+      ny = 2 <= dim ? ya->GetNbins () : 1 ;
+      nz = 3 <= dim ? za->GetNbins () : 1 ;
+      //
+      volume = xa->GetXmax () - xa->GetXmin () ;
+      if ( 2 <= dim ) { volume *= ya->GetXmax () - ya->GetXmin () ; }
+      if ( 3 <= dim ) { volume *= za->GetXmax () - za->GetXmin () ; }
+      //
+      const std::size_t n = std::size_t ( nx ) * ny * nz ;
+      values .resize ( n ) ;
+      cov2   .resize ( n ) ;
+      volumes.resize ( n ) ;
+      std::size_t k = 0 ;
+      for ( int ix = 1 ; ix <= nx ; ++ix )
+      {
+        const double wx = xa->GetBinWidth ( ix ) ;
+        for ( int iy = 1 ; iy <= ny ; ++iy )
+        {
+          const double wy = 2 <= dim ? ya->GetBinWidth ( iy ) : 1.0 ;
+          for ( int iz = 1 ; iz <= nz ; ++iz , ++k )
+          {
+            const double wz  = 3 <= dim ? za->GetBinWidth ( iz ) : 1.0 ;
+            const int    bin = h->GetBin ( ix , iy , iz ) ;
+            const double e   = h->GetBinError ( bin ) ;
+            values  [ k ] = h->GetBinContent ( bin ) ;
+            cov2    [ k ] = e * e ;
+            volumes [ k ] = wx * wy * wz ;
+          }
+        }
+      }
+    }
+    // ========================================================================
+    /// get bin indices from the index in the arrays
+    void indices ( const std::size_t k , int& ix , int& iy , int& iz ) const
+    {
+      iz = 1 + int (   k               % nz ) ;
+      iy = 1 + int ( ( k / nz )        % ny ) ;
+      ix = 1 + int (   k / ( nz * ny )      ) ;
+    }
+    // ========================================================================
+    int                 nx      { 1 } ;
+    int                 ny      { 1 } ;
+    int                 nz      { 1 } ;
+    double              volume  { 0 } ;
+    std::vector<double> values  {   } ;
+    std::vector<double> cov2    {   } ;
+    std::vector<double> volumes {   } ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /// check the binning
+  void check_binning ( const TH1* h1 , const TH1* h2 )
+  {
+    Ostap::Assert ( Ostap::Utils::HistoCompare::same_binning ( h1 , h2 ) ,
+                    "Histograms have different binning"  ,
+                    "Ostap::Utils::HistoCompare"         ) ;
+  }
+  // ==========================================================================
+  /// the same axes?
+  bool same_axis ( const TAxis* a1 , const TAxis* a2 )
+  {
+    if ( a1 == a2 ) { return true ; }
+    if ( nullptr == a1 || nullptr == a2 ) { return false ; }
+    const int n = a1->GetNbins () ;
+    if ( n != a2->GetNbins () ) { return false ; }
+    for ( int i = 1 ; i <= n + 1 ; ++i )
+    { if ( a1->GetBinLowEdge ( i ) != a2->GetBinLowEdge ( i ) ) { return false ; } }
+    return true ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// do two histograms have the same dimension and the same binning?
+// ============================================================================
+bool Ostap::Utils::HistoCompare::same_binning
+( const TH1* h1 ,
+  const TH1* h2 )
+{
+  if ( nullptr == h1 || nullptr == h2 ) { return false ; }
+  const int dim = h1->GetDimension () ;
+  if ( dim != h2->GetDimension () )                              { return false ; }
+  if ( !same_axis ( h1->GetXaxis () , h2->GetXaxis () ) )        { return false ; }
+  if ( 2 <= dim && !same_axis ( h1->GetYaxis () , h2->GetYaxis () ) ) { return false ; }
+  if ( 3 <= dim && !same_axis ( h1->GetZaxis () , h2->GetZaxis () ) ) { return false ; }
+  return true ;
+}
+// ============================================================================
+// chi2-comparison of two histograms
+// ============================================================================
+std::pair<double,unsigned long>
+Ostap::Utils::HistoCompare::chi2
+( const TH1* h1 ,
+  const TH1* h2 )
+{
+  check_binning ( h1 , h2 ) ;
+  const Bins b1 ( h1 ) ;
+  const Bins b2 ( h2 ) ;
+  //
+  const std::size_t n = b1.values.size () ;
+  double chi2 = 0 ;
+  for ( std::size_t k = 0 ; k < n ; ++k )
+  {
+    const VE v1 ( b1.values [ k ] , b1.cov2 [ k ] ) ;
+    const VE v2 ( b2.values [ k ] , b2.cov2 [ k ] ) ;
+    chi2 += v1.chi2 ( v2 ) ;
+  }
+  return std::make_pair ( chi2 , n ) ;
+}
+// ============================================================================
+// "discrete" cos(theta) for two histograms
+// ============================================================================
+Ostap::Math::ValueWithError
+Ostap::Utils::HistoCompare::cos_theta
+( const TH1* h1 ,
+  const TH1* h2 )
+{
+  check_binning ( h1 , h2 ) ;
+  const Bins b1 ( h1 ) ;
+  const Bins b2 ( h2 ) ;
+  //
+  const std::size_t n = b1.values.size () ;
+  double r1  = 0 ;
+  double r2  = 0 ;
+  double r12 = 0 ;
+  double c12 = 0 ;
+  for ( std::size_t k = 0 ; k < n ; ++k )
+  {
+    const double w  = b1.volumes [ k ] ;
+    const double a  = b1.values  [ k ] ;
+    const double b  = b2.values  [ k ] ;
+    r1  += w * a * a ;
+    r2  += w * b * b ;
+    r12 += w * a * b ;
+    c12 += w * w * ( a * a * b2.cov2 [ k ] + b * b * b1.cov2 [ k ] ) ;
+  }
+  return VE ( r12 , c12 ) / std::sqrt ( r1 * r2 ) ;
+}
+// ============================================================================
+// "discrete" distance for two scaled histograms
+// ============================================================================
+Ostap::Math::ValueWithError
+Ostap::Utils::HistoCompare::distance
+( const TH1* h1 ,
+  const TH1* h2 )
+{
+  check_binning ( h1 , h2 ) ;
+  const Bins b1 ( h1 ) ;
+  const Bins b2 ( h2 ) ;
+  //
+  const std::size_t n = b1.values.size () ;
+  double r1 = 0 ;
+  double r2 = 0 ;
+  for ( std::size_t k = 0 ; k < n ; ++k )
+  {
+    const double w  = b1.volumes [ k ] ;
+    r1 += w * b1.values [ k ] * b1.values [ k ] ;
+    r2 += w * b2.values [ k ] * b2.values [ k ] ;
+  }
+  r1 /= b1.volume ;
+  r2 /= b1.volume ;
+  //
+  const double sf1 = 1.0 / std::sqrt ( r1 ) ;
+  const double sf2 = 1.0 / std::sqrt ( r2 ) ;
+  //
+  double d12 = 0 ;
+  double c12 = 0 ;
+  for ( std::size_t k = 0 ; k < n ; ++k )
+  {
+    const double w  = b1.volumes [ k ] ;
+    const double d  = sf1 * b1.values [ k ] - sf2 * b2.values [ k ] ;
+    const double dc = sf1 * sf1 * b1.cov2 [ k ] + sf2 * sf2 * b2.cov2 [ k ] ;
+    d12 += w * d * d ;
+    c12 += w * w * 4 * d * d * dc ;
+  }
+  //
+  return Ostap::Math::sqrt ( VE ( d12 , c12 ) / b1.volume ) ;
+}
+// ============================================================================
+// the minimal and maximal bin-by-bin difference h2-h1
+// ============================================================================
+Ostap::Utils::HistoCompare::MinMax
+Ostap::Utils::HistoCompare::minmax
+( const TH1* h1 ,
+  const TH1* h2 )
+{
+  check_binning ( h1 , h2 ) ;
+  const Bins b1 ( h1 ) ;
+  const Bins b2 ( h2 ) ;
+  //
+  MinMax result {} ;
+  const std::size_t n = b1.values.size () ;
+  if ( 0 == n ) { return result ; }                             // RETURN
+  //
+  std::size_t kmin = 0 ;
+  std::size_t kmax = 0 ;
+  double      dmin = b2.values [ 0 ] - b1.values [ 0 ] ;
+  double      dmax = dmin ;
+  for ( std::size_t k = 1 ; k < n ; ++k )
+  {
+    const double d = b2.values [ k ] - b1.values [ k ] ;
+    if ( d < dmin ) { dmin = d ; kmin = k ; }
+    if ( d > dmax ) { dmax = d ; kmax = k ; }
+  }
+  //
+  b1.indices ( kmin , result.ixmin , result.iymin , result.izmin ) ;
+  b1.indices ( kmax , result.ixmax , result.iymax , result.izmax ) ;
+  result.vmin = VE ( dmin , b1.cov2 [ kmin ] + b2.cov2 [ kmin ] ) ;
+  result.vmax = VE ( dmax , b1.cov2 [ kmax ] + b2.cov2 [ kmax ] ) ;
+  //
+  return result ;
+}
+// ============================================================================
+// compare many pairs of histograms (in parallel)
+// ============================================================================
+std::vector<double>
+Ostap::Utils::HistoCompare::compare
+( const Ostap::Utils::HistoCompare::Metric metric   ,
+  const std::vector<const TH1*>&           h1       ,
+  const std::vector<const TH1*>&           h2       ,
+  const unsigned int                       nthreads )
+{
+  Ostap::Assert ( h1.size () == h2.size ()                       ,
+                  "Mismatch in number of histograms"             ,
+                  "Ostap::Utils::HistoCompare::compare"          ) ;
+  //
+  const std::size_t   N = h1.size () ;
+  std::vector<double> result ( N , std::numeric_limits<double>::quiet_NaN () ) ;
+  if ( 0 == N ) { return result ; }                              // RETURN
+  //
+  auto one = [&] ( const std::size_t i ) -> double
+    {
+      switch ( metric )
+      {
+      case Chi2     :
+        { const auto r = chi2 ( h1 [ i ] , h2 [ i ] ) ;
+          return 0 < r.second ? r.first / r.second : 0.0 ; }
+      case Prob     :
+        { const auto r = chi2 ( h1 [ i ] , h2 [ i ] ) ;
+          return TMath::Prob ( r.first , r.second ) ; }
+      case CosTheta : return cos_theta ( h1 [ i ] , h2 [ i ] ).value () ;
+      case Distance : return distance  ( h1 [ i ] , h2 [ i ] ).value () ;
+      case MinDiff  : return minmax    ( h1 [ i ] , h2 [ i ] ).vmin.value () ;
+      case MaxDiff  : return minmax    ( h1 [ i ] , h2 [ i ] ).vmax.value () ;
+      }
+      return std::numeric_limits<double>::quiet_NaN () ;
+    } ;
+  //
+  const unsigned int nt = std::min<std::size_t>
+    ( N , 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ;
+  if ( nt <= 1 )
+  {
+    for ( std::size_t i = 0 ; i < N ; ++i ) { result [ i ] = one ( i ) ; }
+    return result ;                                              // RETURN
+  }
+  //
+  std::atomic<std::size_t> next { 0 } ;
+  Ostap::Utils::WorkerPool pool ( nt ) ;
+  pool.run ( [&] ( const unsigned int /* index */ )
+    { for ( std::size_t i = next++ ; i < N ; i = next++ ) { result [ i ] = one ( i ) ; } } ) ;
+  //
+  return result ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
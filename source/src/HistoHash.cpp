@@ -2,13 +2,33 @@
 // ============================================================================
 // STD&STL
 // ============================================================================
+#include <algorithm>
 #include <functional>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
 // ============================================================================
 // ROOT 
 // ============================================================================
 #include "TH1.h"
 #include "TGraph.h"
 #include "TAxis.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
+#include "TArrayI.h"
+#include "TArrayS.h"
+#include "TArrayC.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TProfile3D.h"
+// ============================================================================
+// RooFit
+// ============================================================================
+#include "RooAbsData.h"
+#include "RooArgSet.h"
+#include "RooAbsReal.h"
+#include "RooAbsCategory.h"
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -23,6 +43,58 @@
  *  @date  2021-04-09 
  *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
  */
+namespace 
+{
+  // ==========================================================================
+  /// size of the block (in bytes) for block hashing 
+  const std::size_t s_BLOCK = 1 << 14 ; 
+  // ==========================================================================
+  /// hash the block of bytes (8-byte words, multiplicative mixing)
+  inline std::size_t hash_bytes 
+  ( const unsigned char* data , 
+    const std::size_t    n    )
+  {
+    const std::uint64_t m = 0x9ddfea08eb382d69ULL ;
+    std::uint64_t       h = n * m ;
+    std::size_t         i = 0     ;
+    for ( ; i + 8 <= n ; i += 8 ) 
+    {
+      std::uint64_t w ; 
+      std::memcpy ( &w , data + i , 8 ) ;
+      h  = ( h ^ w ) * m ;
+      h ^= h >> 47 ;
+    }
+    for ( ; i < n ; ++i ) { h = ( h ^ data [ i ] ) * m ; h ^= h >> 47 ; }
+    return static_cast<std::size_t> ( h ) ;
+  }
+  // ==========================================================================
+  /// hash the (large) array of bytes block-by-block 
+  inline std::size_t hash_blocks 
+  ( const void*       data  , 
+    const std::size_t bytes ) 
+  {
+    const unsigned char* p    = static_cast<const unsigned char*> ( data ) ;
+    std::size_t          seed = bytes ;
+    for ( std::size_t i = 0 ; i < bytes ; i += s_BLOCK ) 
+    { seed = std::hash_combine ( seed , hash_bytes ( p + i , std::min ( s_BLOCK , bytes - i ) ) ) ; }
+    return seed ;
+  }
+  // ==========================================================================
+  /// get the raw storage of the histogram 
+  template <class ARRAY>
+  inline bool storage 
+  ( const TH1*   histo , 
+    const void*& data  , 
+    std::size_t& bytes ) 
+  {
+    const ARRAY* a = dynamic_cast<const ARRAY*> ( histo ) ;
+    if ( nullptr == a || nullptr == a->GetArray () ) { return false ; }
+    data  = a->GetArray () ;
+    bytes = a->GetSize  () * sizeof ( *a->GetArray () ) ;
+    return true ;
+  }
+  // ==========================================================================
+}
 // ============================================================================
 /* get hash for the given graph 
  *  @param graph the graphs 
@@ -107,6 +179,20 @@ std::size_t Ostap::Utils::hash_axis
 // ============================================================================
 std::size_t Ostap::Utils::hash_histo 
 ( const TH1* histo )  
+{
+  if ( nullptr == histo ) { return 0 ; }
+  return std::hash_combine ( histo->Hash() , hash_histo_content ( histo ) ) ;
+}
+// ============================================================================
+/*  get the content hash for the given histogram: the type, 
+ *  the binning, the bin contents and the errors, 
+ *  but not the name or the title. 
+ *  @param histo the historgam  
+ *  @return hash value 
+ */
+// ============================================================================
+std::size_t Ostap::Utils::hash_histo_content
+( const TH1* histo )  
 {
   if ( nullptr == histo ) { return 0 ; }
   //
@@ -114,12 +200,35 @@ std::size_t Ostap::Utils::hash_histo
   const Int_t NY = histo -> GetNbinsY () ;
   const Int_t NZ = histo -> GetNbinsZ () ;
   //
-  std::size_t seed = std::hash_combine ( histo->Hash() , NX , NY , NZ ) ;
+  std::size_t seed = std::hash_combine ( std::string ( histo->ClassName () ) , NX , NY , NZ ) ;
   //
   seed = std::hash_combine ( seed , hash_axis ( histo->GetXaxis() ) ) ;
   seed = std::hash_combine ( seed , hash_axis ( histo->GetYaxis() ) ) ;
   seed = std::hash_combine ( seed , hash_axis ( histo->GetZaxis() ) ) ;
   //
+  const bool profile = 
+    histo->InheritsFrom ( TProfile  ::Class () ) || 
+    histo->InheritsFrom ( TProfile2D::Class () ) || 
+    histo->InheritsFrom ( TProfile3D::Class () ) ;
+  //
+  const void* data  = nullptr ;
+  std::size_t bytes = 0       ;
+  if ( !profile && 
+       ( storage<TArrayD> ( histo , data , bytes ) || 
+         storage<TArrayF> ( histo , data , bytes ) || 
+         storage<TArrayI> ( histo , data , bytes ) || 
+         storage<TArrayS> ( histo , data , bytes ) || 
+         storage<TArrayC> ( histo , data , bytes ) ) ) 
+  {
+    // fast: hash the raw storage and the sum of squared weights block-by-block
+    seed = std::hash_combine ( seed , hash_blocks ( data , bytes ) ) ;
+    const TArrayD* sumw2 = histo->GetSumw2 () ;
+    if ( sumw2 && sumw2->GetArray () && 0 < sumw2->GetSize () ) 
+    { seed = std::hash_combine ( seed , hash_blocks ( sumw2->GetArray () , sumw2->GetSize () * sizeof ( Double_t ) ) ) ; }
+    return std::hash_combine ( seed , int ( histo->GetBinErrorOption () ) ) ;
+  }
+  //
+  // slow: loop over bins 
   for ( int ix = 1 ; ix <= NX ; ++ix ) 
   { for ( int iy = 1 ; iy <= NY ; ++iy ) 
     { for ( int iz = 1 ; iz <= NZ ; ++iz ) 
@@ -134,5 +243,62 @@ std::size_t Ostap::Utils::hash_histo
   return seed ;
 }
 // ============================================================================
+/*  get the content hash for the given dataset: the names and 
+ *  types of variables, the number of entries, the values and 
+ *  the weights, but not the name or the title of the dataset.
+ *  @param data the dataset 
+ *  @return hash value 
+ */
+// ============================================================================
+std::size_t Ostap::Utils::hash_data_content
+( const RooAbsData* data )  
+{
+  if ( nullptr == data ) { return 0 ; }
+  //
+  const RooArgSet* vars = data->get () ;
+  if ( nullptr == vars ) { return 0 ; }
+  //
+  const int  N        = data->numEntries () ;
+  const bool weighted = data->isWeighted () ;
+  std::size_t seed    = std::hash_combine ( std::string ( data->ClassName () ) , N , weighted ) ;
+  //
+  std::vector<const RooAbsReal*>     reals {} ;
+  std::vector<const RooAbsCategory*> cats  {} ;
+  for ( const RooAbsArg* a : *vars )
+  {
+    if      ( const RooAbsReal*     r = dynamic_cast<const RooAbsReal*>     ( a ) ) 
+    { reals.push_back ( r ) ; seed = std::hash_combine ( seed , std::string ( r->GetName () ) ) ; }
+    else if ( const RooAbsCategory* c = dynamic_cast<const RooAbsCategory*> ( a ) ) 
+    { cats .push_back ( c ) ; seed = std::hash_combine ( seed , std::string ( c->GetName () ) ) ; }
+  }
+  //
+  // the values are collected into the buffer and hashed block-by-block 
+  const std::size_t   nbuf = s_BLOCK / sizeof ( double ) ;
+  std::vector<double> buffer ; buffer.reserve ( nbuf + 2 + reals.size () + cats.size () ) ;
+  //
+  for ( int i = 0 ; i < N ; ++i ) 
+  {
+    data->get ( i ) ;
+    for ( const RooAbsReal*     r : reals ) { buffer.push_back ( r->getVal          () ) ; }
+    for ( const RooAbsCategory* c : cats  ) { buffer.push_back ( c->getCurrentIndex () ) ; }
+    if  ( weighted ) 
+    {
+      buffer.push_back ( data->weight        () ) ;
+      buffer.push_back ( data->weightSquared () ) ;
+    }
+    if ( nbuf <= buffer.size () ) 
+    {
+      seed = std::hash_combine ( seed , hash_bytes ( reinterpret_cast<const unsigned char*> ( buffer.data () ) , 
+                                                     buffer.size () * sizeof ( double ) ) ) ;
+      buffer.clear () ;
+    }
+  }
+  if ( !buffer.empty () ) 
+  { seed = std::hash_combine ( seed , hash_bytes ( reinterpret_cast<const unsigned char*> ( buffer.data () ) , 
+                                                   buffer.size () * sizeof ( double ) ) ) ; }
+  //
+  return seed ;
+}
+// ============================================================================
 //                                                                      The END 
 // ============================================================================
@@ -2905,16 +2905,16 @@ Ostap::Math::HistoInterpolation::interpolate_3D
         ( y , y0 , y1 , y2 , 
           _linear_ 
           ( z , z0 , z1 , 
-            _bin_ ( h3 , ix[2] , iy[0] , iz[0] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[0] , iz[1] , density ) ) , 
+            _bin_ ( h3 , ix[3] , iy[0] , iz[0] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[0] , iz[1] , density ) ) , 
           _linear_ 
           ( z , z0 , z1 , 
-            _bin_ ( h3 , ix[2] , iy[1] , iz[0] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[1] , iz[1] , density ) ) , 
+            _bin_ ( h3 , ix[3] , iy[1] , iz[0] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[1] , iz[1] , density ) ) , 
           _linear_ 
           ( z , z0 , z1 , 
-            _bin_ ( h3 , ix[2] , iy[2] , iz[0] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[2] , iz[1] , density ) ) ) ) ;
+            _bin_ ( h3 , ix[3] , iy[2] , iz[0] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[2] , iz[1] , density ) ) ) ) ;
   }
   //
   else if ( Quadratic == itypex && Quadratic == itypey && Linear == itypez && 3 == nbx )  // (27'') 
@@ -3082,20 +3082,20 @@ Ostap::Math::HistoInterpolation::interpolate_3D
         ( y , y0 , y1 , y2 , y3 , 
           _linear_ 
           ( z , z0 , z1 , 
-            _bin_ ( h3 , ix[2] , iy[0] , iz[0] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[0] , iz[1] , density ) ) , 
+            _bin_ ( h3 , ix[3] , iy[0] , iz[0] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[0] , iz[1] , density ) ) , 
           _linear_ 
           ( z , z0 , z1 , 
-            _bin_ ( h3 , ix[2] , iy[1] , iz[0] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[1] , iz[1] , density ) ) , 
+            _bin_ ( h3 , ix[3] , iy[1] , iz[0] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[1] , iz[1] , density ) ) , 
           _linear_ 
           ( z , z0 , z1 , 
-            _bin_ ( h3 , ix[2] , iy[2] , iz[0] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[2] , iz[1] , density ) ) ,
+            _bin_ ( h3 , ix[3] , iy[2] , iz[0] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[2] , iz[1] , density ) ) ,
           _linear_ 
           ( z , z0 , z1 , 
-            _bin_ ( h3 , ix[2] , iy[3] , iz[0] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[3] , iz[1] , density ) ) ) ) ;
+            _bin_ ( h3 , ix[3] , iy[3] , iz[0] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[3] , iz[1] , density ) ) ) ) ;
   }
   // 
   else if ( Cubic == itypex && Quadratic == itypey && Linear == itypez &&  3 == nby )  // (28) 
@@ -3821,7 +3821,7 @@ Ostap::Math::HistoInterpolation::interpolate_3D
           _bin_ ( h3 , ix[2] , iby , iz[0] , density ) , 
           _bin_ ( h3 , ix[2] , iby , iz[1] , density ) , 
           _bin_ ( h3 , ix[2] , iby , iz[2] , density ) , 
-          _bin_ ( h3 , ix[2] , iby , iz[2] , density ) ) ) ;    
+          _bin_ ( h3 , ix[2] , iby , iz[3] , density ) ) ) ;    
   }
   else if ( Quadratic == itypex && Nearest == itypey && Quadratic == itypez &&  3 == nbz )  // (35'') 
   {
@@ -4434,7 +4434,7 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[2] , iy[1] , iz[0] , density ) , 
             _bin_ ( h3 , ix[2] , iy[1] , iz[1] , density ) , 
             _bin_ ( h3 , ix[2] , iy[1] , iz[2] , density ) ,
-            _bin_ ( h3 , ix[2] , iy[1] , iz[2] , density ) ) ) ,
+            _bin_ ( h3 , ix[2] , iy[1] , iz[3] , density ) ) ) ,
         _linear_
         ( y , y0 , y1 , 
           _quadratic2_ 
@@ -4448,7 +4448,7 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[3] , iy[1] , iz[0] , density ) , 
             _bin_ ( h3 , ix[3] , iy[1] , iz[1] , density ) , 
             _bin_ ( h3 , ix[3] , iy[1] , iz[2] , density ) ,
-            _bin_ ( h3 , ix[3] , iy[1] , iz[2] , density ) ) ) ) ;
+            _bin_ ( h3 , ix[3] , iy[1] , iz[3] , density ) ) ) ) ;
   }
   //
   else if ( Cubic == itypex && Linear == itypey && Quadratic == itypez && 3 ==  nbz )  // (40) 
@@ -4762,13 +4762,13 @@ Ostap::Math::HistoInterpolation::interpolate_3D
           _bin_ ( h3 , ibx , iy[2] , iz[0] , density ) , 
           _bin_ ( h3 , ibx , iy[2] , iz[1] , density ) , 
           _bin_ ( h3 , ibx , iy[2] , iz[2] , density ) ,
-          _bin_ ( h3 , ibx , iy[2] , iz[2] , density ) ) ,
+          _bin_ ( h3 , ibx , iy[2] , iz[3] , density ) ) ,
         _quadratic2_ 
         ( z , z0 , z1 , z2 , z3 ,   
           _bin_ ( h3 , ibx , iy[3] , iz[0] , density ) , 
           _bin_ ( h3 , ibx , iy[3] , iz[1] , density ) , 
           _bin_ ( h3 , ibx , iy[3] , iz[2] , density ) ,
-          _bin_ ( h3 , ibx , iy[3] , iz[2] , density ) ) ) ;
+          _bin_ ( h3 , ibx , iy[3] , iz[3] , density ) ) ) ;
   }
   //  
   else if ( Linear == itypex && Quadratic == itypey && Quadratic == itypez && 3 == nby && 3 == nbz )  // (42) 
@@ -4828,7 +4828,7 @@ Ostap::Math::HistoInterpolation::interpolate_3D
           ( z , z0 , z1 , z2 ,  
             _bin_ ( h3 , ix[1] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[1] , iy[2] , iz[1] , density ) , 
-            _bin_ ( h3 , ix[0] , iy[2] , iz[2] , density ) ) ) ) ;  
+            _bin_ ( h3 , ix[1] , iy[2] , iz[2] , density ) ) ) ) ;  
   }
   //
   else if ( Linear == itypex && Quadratic == itypey && Quadratic == itypez && 3 ==  nby )  // (42') 
@@ -4875,7 +4875,7 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[0] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[0] , iy[2] , iz[1] , density ) , 
             _bin_ ( h3 , ix[0] , iy[2] , iz[2] , density ) ,
-            _bin_ ( h3 , ix[0] , iy[2] , iz[2] , density ) ) ) ,
+            _bin_ ( h3 , ix[0] , iy[2] , iz[3] , density ) ) ) ,
         _quadratic_
         ( y , y0 , y1 , y2 ,  
           _quadratic2_ 
@@ -4894,8 +4894,8 @@ Ostap::Math::HistoInterpolation::interpolate_3D
           ( z , z0 , z1 , z2 , z3 ,  
             _bin_ ( h3 , ix[1] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[1] , iy[2] , iz[1] , density ) , 
-            _bin_ ( h3 , ix[0] , iy[2] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[0] , iy[2] , iz[3] , density ) ) ) ) ;  
+            _bin_ ( h3 , ix[1] , iy[2] , iz[2] , density ) ,  
+            _bin_ ( h3 , ix[1] , iy[2] , iz[3] , density ) ) ) ) ;  
   }
   //
   else if ( Linear == itypex && Quadratic == itypey && Quadratic == itypez &&  3 ==  nbz )  // (42'') 
@@ -4961,12 +4961,12 @@ Ostap::Math::HistoInterpolation::interpolate_3D
           ( z , z0 , z1 , z2 ,  
             _bin_ ( h3 , ix[1] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[1] , iy[2] , iz[1] , density ) , 
-            _bin_ ( h3 , ix[0] , iy[2] , iz[2] , density ) ) ,  
+            _bin_ ( h3 , ix[1] , iy[2] , iz[2] , density ) ) ,  
           _quadratic_ 
           ( z , z0 , z1 , z2 ,  
             _bin_ ( h3 , ix[1] , iy[3] , iz[0] , density ) , 
             _bin_ ( h3 , ix[1] , iy[3] , iz[1] , density ) , 
-            _bin_ ( h3 , ix[0] , iy[3] , iz[2] , density ) ) ) ) ;  
+            _bin_ ( h3 , ix[1] , iy[3] , iz[2] , density ) ) ) ) ;  
   }
   //
   else if ( Linear == itypex && Quadratic == itypey && Quadratic == itypez )  // (42''') 
@@ -5014,13 +5014,13 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[0] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[0] , iy[2] , iz[1] , density ) , 
             _bin_ ( h3 , ix[0] , iy[2] , iz[2] , density ) ,
-            _bin_ ( h3 , ix[0] , iy[2] , iz[2] , density ) ) ,
+            _bin_ ( h3 , ix[0] , iy[2] , iz[3] , density ) ) ,
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 ,   
             _bin_ ( h3 , ix[0] , iy[3] , iz[0] , density ) , 
             _bin_ ( h3 , ix[0] , iy[3] , iz[1] , density ) , 
             _bin_ ( h3 , ix[0] , iy[3] , iz[2] , density ) ,
-            _bin_ ( h3 , ix[0] , iy[3] , iz[2] , density ) ) ) ,
+            _bin_ ( h3 , ix[0] , iy[3] , iz[3] , density ) ) ) ,
         _quadratic2_
         ( y , y0 , y1 , y2 , y3 ,  
           _quadratic2_ 
@@ -5039,14 +5039,14 @@ Ostap::Math::HistoInterpolation::interpolate_3D
           ( z , z0 , z1 , z2 , z3 , 
             _bin_ ( h3 , ix[1] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[1] , iy[2] , iz[1] , density ) , 
-            _bin_ ( h3 , ix[0] , iy[2] , iz[2] , density ) ,   
-            _bin_ ( h3 , ix[0] , iy[2] , iz[3] , density ) ) ,
+            _bin_ ( h3 , ix[1] , iy[2] , iz[2] , density ) ,   
+            _bin_ ( h3 , ix[1] , iy[2] , iz[3] , density ) ) ,
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 , 
             _bin_ ( h3 , ix[1] , iy[3] , iz[0] , density ) , 
             _bin_ ( h3 , ix[1] , iy[3] , iz[1] , density ) , 
-            _bin_ ( h3 , ix[0] , iy[3] , iz[2] , density ) ,   
-            _bin_ ( h3 , ix[0] , iy[3] , iz[3] , density ) ) ) ) ;
+            _bin_ ( h3 , ix[1] , iy[3] , iz[2] , density ) ,   
+            _bin_ ( h3 , ix[1] , iy[3] , iz[3] , density ) ) ) ) ;
   }
   // 
   // SKIP IT HERE move it to the end 
@@ -5254,7 +5254,7 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[3] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[3] , iy[2] , iz[1] , density ) , 
             _bin_ ( h3 , ix[3] , iy[2] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[3] , iy[2] , iz[2] , density ) ) ) ) ;  
+            _bin_ ( h3 , ix[3] , iy[2] , iz[3] , density ) ) ) ) ;  
   }
   //
   else if ( Cubic == itypex && Quadratic == itypey && Quadratic == itypez && 3 == nbz )  // (44'') 
@@ -5487,25 +5487,25 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[3] , iy[0] , iz[0] , density ) , 
             _bin_ ( h3 , ix[3] , iy[0] , iz[1] , density ) , 
             _bin_ ( h3 , ix[3] , iy[0] , iz[2] , density ) , 
-            _bin_ ( h3 , ix[3] , iy[0] , iz[2] , density ) ) , 
+            _bin_ ( h3 , ix[3] , iy[0] , iz[3] , density ) ) , 
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 , 
             _bin_ ( h3 , ix[3] , iy[1] , iz[0] , density ) , 
             _bin_ ( h3 , ix[3] , iy[1] , iz[1] , density ) , 
             _bin_ ( h3 , ix[3] , iy[1] , iz[2] , density ) ,
-            _bin_ ( h3 , ix[3] , iy[1] , iz[2] , density ) ) ,
+            _bin_ ( h3 , ix[3] , iy[1] , iz[3] , density ) ) ,
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 ,
             _bin_ ( h3 , ix[3] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[3] , iy[2] , iz[1] , density ) , 
             _bin_ ( h3 , ix[3] , iy[2] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[3] , iy[2] , iz[2] , density ) ) , 
+            _bin_ ( h3 , ix[3] , iy[2] , iz[3] , density ) ) , 
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 ,
             _bin_ ( h3 , ix[3] , iy[3] , iz[0] , density ) , 
             _bin_ ( h3 , ix[3] , iy[3] , iz[1] , density ) , 
             _bin_ ( h3 , ix[3] , iy[3] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[3] , iy[3] , iz[2] , density ) ) ) ) ;  
+            _bin_ ( h3 , ix[3] , iy[3] , iz[3] , density ) ) ) ) ;  
   }
   // 
   else if ( Nearest == itypex && Cubic == itypey && Quadratic == itypez && 3 == nbz )  // (45) 
@@ -5586,7 +5586,7 @@ Ostap::Math::HistoInterpolation::interpolate_3D
           _bin_ ( h3 , ibx , iy[2] , iz[0] , density ) , 
           _bin_ ( h3 , ibx , iy[2] , iz[1] , density ) , 
           _bin_ ( h3 , ibx , iy[2] , iz[2] , density ) ,
-          _bin_ ( h3 , ibx , iy[2] , iz[2] , density ) ) ,
+          _bin_ ( h3 , ibx , iy[2] , iz[3] , density ) ) ,
         _quadratic2_ 
         ( z , z0 , z1 , z2 , z3 ,  
           _bin_ ( h3 , ibx , iy[3] , iz[0] , density ) , 
@@ -5926,7 +5926,7 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[2] , iy[0] , iz[0] , density ) , 
             _bin_ ( h3 , ix[2] , iy[0] , iz[1] , density ) , 
             _bin_ ( h3 , ix[2] , iy[0] , iz[2] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[0] , iz[2] , density ) ) , 
+            _bin_ ( h3 , ix[2] , iy[0] , iz[3] , density ) ) , 
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 , 
             _bin_ ( h3 , ix[2] , iy[1] , iz[0] , density ) , 
@@ -6163,13 +6163,13 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[2] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[2] , iy[2] , iz[1] , density ) , 
             _bin_ ( h3 , ix[2] , iy[2] , iz[2] , density ) ,
-            _bin_ ( h3 , ix[2] , iy[2] , iz[2] , density ) ) ,
+            _bin_ ( h3 , ix[2] , iy[2] , iz[3] , density ) ) ,
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 ,  
             _bin_ ( h3 , ix[2] , iy[3] , iz[0] , density ) , 
             _bin_ ( h3 , ix[2] , iy[3] , iz[1] , density ) , 
             _bin_ ( h3 , ix[2] , iy[3] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[2] , iy[3] , iz[2] , density ) ) ) ,
+            _bin_ ( h3 , ix[2] , iy[3] , iz[3] , density ) ) ) ,
         _cubic_
         ( y , y0 , y1 , y2 , y3 ,  
           _quadratic2_ 
@@ -6189,13 +6189,13 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[3] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[3] , iy[2] , iz[1] , density ) , 
             _bin_ ( h3 , ix[3] , iy[2] , iz[2] , density ) ,
-            _bin_ ( h3 , ix[3] , iy[2] , iz[2] , density ) ) ,
+            _bin_ ( h3 , ix[3] , iy[2] , iz[3] , density ) ) ,
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 ,  
             _bin_ ( h3 , ix[3] , iy[3] , iz[0] , density ) , 
             _bin_ ( h3 , ix[3] , iy[3] , iz[1] , density ) , 
             _bin_ ( h3 , ix[3] , iy[3] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[3] , iy[3] , iz[2] , density ) ) ) ) ;  
+            _bin_ ( h3 , ix[3] , iy[3] , iz[3] , density ) ) ) ) ;  
   }
   // 
   else if ( Cubic == itypex && Cubic == itypey && Quadratic == itypez && 3 == nbz )  // (48) 
@@ -6368,7 +6368,7 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[0] , iy[3] , iz[0] , density ) , 
             _bin_ ( h3 , ix[0] , iy[3] , iz[1] , density ) , 
             _bin_ ( h3 , ix[0] , iy[3] , iz[2] , density ) ,
-            _bin_ ( h3 , ix[0] , iy[3] , iz[2] , density ) ) ) ,
+            _bin_ ( h3 , ix[0] , iy[3] , iz[3] , density ) ) ) ,
         _cubic_
         ( y , y0 , y1 , y2 , y3 ,  
           _quadratic2_ 
@@ -6446,7 +6446,7 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[3] , iy[3] , iz[0] , density ) , 
             _bin_ ( h3 , ix[3] , iy[3] , iz[1] , density ) , 
             _bin_ ( h3 , ix[3] , iy[3] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[3] , iy[3] , iz[2] , density ) ) ) ) ;  
+            _bin_ ( h3 , ix[3] , iy[3] , iz[3] , density ) ) ) ) ;  
   }
   // 
   else if ( Nearest  == itypex && Nearest == itypey && Cubic == itypez )  // (49) 
@@ -7178,10 +7178,10 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[1] , iy[2] , iz[3] , density ) ) ,
           _cubic_ 
           ( z , z0 , z1 , z2 , z3 ,  
-            _bin_ ( h3 , ix[1] , iy[2] , iz[0] , density ) , 
-            _bin_ ( h3 , ix[1] , iy[2] , iz[1] , density ) , 
-            _bin_ ( h3 , ix[1] , iy[2] , iz[2] , density ) ,
-            _bin_ ( h3 , ix[1] , iy[2] , iz[3] , density ) ) ) ) ;
+            _bin_ ( h3 , ix[1] , iy[3] , iz[0] , density ) , 
+            _bin_ ( h3 , ix[1] , iy[3] , iz[1] , density ) , 
+            _bin_ ( h3 , ix[1] , iy[3] , iz[2] , density ) ,
+            _bin_ ( h3 , ix[1] , iy[3] , iz[3] , density ) ) ) ) ;
   }
   // 
   else if ( Quadratic  == itypex && Quadratic == itypey && Cubic == itypez && 3 ==  nbx && 3 == nby )  // (59) 
@@ -8821,13 +8821,13 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[2] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[2] , iy[2] , iz[1] , density ) , 
             _bin_ ( h3 , ix[2] , iy[2] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[2] , iy[2] , iz[2] , density ) ) ,
+            _bin_ ( h3 , ix[2] , iy[2] , iz[3] , density ) ) ,
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 ,  
             _bin_ ( h3 , ix[2] , iy[3] , iz[0] , density ) , 
             _bin_ ( h3 , ix[2] , iy[3] , iz[1] , density ) , 
             _bin_ ( h3 , ix[2] , iy[3] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[2] , iy[3] , iz[2] , density ) ) ) ) ;  
+            _bin_ ( h3 , ix[2] , iy[3] , iz[3] , density ) ) ) ) ;  
   }
   //
   else if ( Quadratic == itypex && Quadratic == itypey && Quadratic == itypez && 3 ==  nby )  // (43^5) 
@@ -8896,7 +8896,7 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[1] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[1] , iy[2] , iz[1] , density ) , 
             _bin_ ( h3 , ix[1] , iy[2] , iz[2] , density ) , 
-            _bin_ ( h3 , ix[1] , iy[2] , iz[2] , density ) ) ) , 
+            _bin_ ( h3 , ix[1] , iy[2] , iz[3] , density ) ) ) , 
         _quadratic_
         ( y , y0 , y1 , y2 ,  
           _quadratic2_ 
@@ -8921,22 +8921,22 @@ Ostap::Math::HistoInterpolation::interpolate_3D
         ( y , y0 , y1 , y2 ,  
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 ,  
-            _bin_ ( h3 , ix[2] , iy[0] , iz[0] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[0] , iz[1] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[0] , iz[2] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[0] , iz[3] , density ) ) , 
+            _bin_ ( h3 , ix[3] , iy[0] , iz[0] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[0] , iz[1] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[0] , iz[2] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[0] , iz[3] , density ) ) , 
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 , 
-            _bin_ ( h3 , ix[2] , iy[1] , iz[0] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[1] , iz[1] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[1] , iz[2] , density ) ,
-            _bin_ ( h3 , ix[2] , iy[1] , iz[3] , density ) ) ,
+            _bin_ ( h3 , ix[3] , iy[1] , iz[0] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[1] , iz[1] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[1] , iz[2] , density ) ,
+            _bin_ ( h3 , ix[3] , iy[1] , iz[3] , density ) ) ,
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 ,  
-            _bin_ ( h3 , ix[2] , iy[2] , iz[0] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[2] , iz[1] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[2] , iz[2] , density ) , 
-            _bin_ ( h3 , ix[2] , iy[2] , iz[3] , density ) ) ) ) ;  
+            _bin_ ( h3 , ix[3] , iy[2] , iz[0] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[2] , iz[1] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[2] , iz[2] , density ) , 
+            _bin_ ( h3 , ix[3] , iy[2] , iz[3] , density ) ) ) ) ;  
   }
   //
   else if ( Quadratic == itypex && Quadratic == itypey && Quadratic == itypez && 3 == nbz )  // (43^6) 
@@ -9155,13 +9155,13 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[2] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[2] , iy[2] , iz[1] , density ) , 
             _bin_ ( h3 , ix[2] , iy[2] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[2] , iy[2] , iz[2] , density ) ) ,
+            _bin_ ( h3 , ix[2] , iy[2] , iz[3] , density ) ) ,
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 ,  
             _bin_ ( h3 , ix[2] , iy[3] , iz[0] , density ) , 
             _bin_ ( h3 , ix[2] , iy[3] , iz[1] , density ) , 
             _bin_ ( h3 , ix[2] , iy[3] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[2] , iy[3] , iz[2] , density ) ) ) , 
+            _bin_ ( h3 , ix[2] , iy[3] , iz[3] , density ) ) ) , 
         _quadratic2_
         ( y , y0 , y1 , y2 ,  y3 ,  
           _quadratic2_ 
@@ -9181,13 +9181,13 @@ Ostap::Math::HistoInterpolation::interpolate_3D
             _bin_ ( h3 , ix[3] , iy[2] , iz[0] , density ) , 
             _bin_ ( h3 , ix[3] , iy[2] , iz[1] , density ) , 
             _bin_ ( h3 , ix[3] , iy[2] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[3] , iy[2] , iz[2] , density ) ) ,
+            _bin_ ( h3 , ix[3] , iy[2] , iz[3] , density ) ) ,
           _quadratic2_ 
           ( z , z0 , z1 , z2 , z3 ,  
             _bin_ ( h3 , ix[3] , iy[3] , iz[0] , density ) , 
             _bin_ ( h3 , ix[3] , iy[3] , iz[1] , density ) , 
             _bin_ ( h3 , ix[3] , iy[3] , iz[2] , density ) ,  
-            _bin_ ( h3 , ix[3] , iy[3] , iz[2] , density ) ) ) ) ;  
+            _bin_ ( h3 , ix[3] , iy[3] , iz[3] , density ) ) ) ) ;  
   }
   //
 
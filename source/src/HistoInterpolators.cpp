@@ -3,10 +3,19 @@
 // ============================================================================
 // STD&STL
 // ============================================================================
+#include <algorithm>
+#include <array>
+// ============================================================================
+// ROOT 
+// ============================================================================
+#include "THnBase.h"
+#include "TAxis.h"
+// ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/HistoInterpolation.h"
 #include "Ostap/HistoInterpolators.h"
+#include "Ostap/HistoTables.h"
 // ============================================================================
 // Local
 // ============================================================================
@@ -17,9 +26,70 @@
  *   - class Ostap:::::Math::Histo1D
  *   - class Ostap:::::Math::Histo2D
  *   - class Ostap:::::Math::Histo3D
+ *   - class Ostap:::::Math::SparseHisto3D
  *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
  *  @date   2019-11-16
  */
+namespace 
+{
+  // ==========================================================================
+  /// get the bin edges for the axis 
+  std::vector<double> _edges_ ( const TAxis* axis ) 
+  {
+    const int nbins = axis->GetNbins () ;
+    std::vector<double> edges ( nbins + 1 ) ;
+    for ( int i = 1 ; i <= nbins ; ++i ) { edges [ i - 1 ] = axis->GetBinLowEdge ( i ) ; }
+    edges [ nbins ] = axis->GetBinUpEdge ( nbins ) ;
+    return edges ;
+  }
+  // ==========================================================================
+  /** get (up to two) bins and weights for the value along the axis 
+   *  @return number of bins (0 for the value outside the axis range)
+   */
+  unsigned int _bins_ 
+  ( const std::vector<double>&                  edges       , 
+    double                                      value       , 
+    const Ostap::Math::HistoInterpolation::Type t           , 
+    const bool                                  extrapolate , 
+    std::array<int,2>&                          bins        , 
+    std::array<double,2>&                       weights     ) 
+  {
+    const int n = edges.size () - 1 ;
+    if ( value < edges.front () || edges.back () < value ) 
+    {
+      if ( !extrapolate ) { return 0 ; }                           // RETURN 
+      value = std::clamp ( value , edges.front () , edges.back () ) ;
+    }
+    //
+    int i = std::upper_bound ( edges.begin () , edges.end () , value ) - edges.begin () ;
+    i     = std::clamp ( i , 1 , n ) ;
+    //
+    if ( Ostap::Math::HistoInterpolation::Nearest == t || 1 == n ) 
+    {
+      bins    [ 0 ] = i   ;
+      weights [ 0 ] = 1.0 ;
+      return 1 ;                                                   // RETURN 
+    }
+    //
+    const double ci = 0.5 * ( edges [ i - 1 ] + edges [ i ] ) ;
+    const int    j  = value < ci ? i - 1 : i + 1 ;
+    if ( j < 1 || n < j ) 
+    {
+      // near the edges: the content of the edge bin 
+      bins    [ 0 ] = i   ;
+      weights [ 0 ] = 1.0 ;
+      return 1 ;                                                   // RETURN 
+    }
+    const double cj = 0.5 * ( edges [ j - 1 ] + edges [ j ] ) ;
+    const double wj = ( value - ci ) / ( cj - ci ) ;
+    bins    [ 0 ] = i        ; 
+    weights [ 0 ] = 1.0 - wj ;
+    bins    [ 1 ] = j        ;
+    weights [ 1 ] = wj       ;
+    return 2 ;
+  }
+  // ==========================================================================
+}
 // ============================================================================
 /*  constructor with full  specification 
  *  @see Ostap::Math::HistoInterpolation
@@ -58,6 +128,7 @@ Ostap::Math::Histo1D::Histo1D
                    "Ostap::Math::Histo1D"       ) ;
   histo.Copy ( m_h ) ;
   m_h.SetDirectory ( nullptr ) ;
+  m_table = Ostap::Math::HistoTable1D ( m_h , m_t , edges , extrapolate , density ) ;
 }
 // ============================================================================
 /*  constructor with full specification 
@@ -83,6 +154,7 @@ Ostap::Math::Histo2D::Histo2D
                    "Ostap::Math::Histo2D"       ) ;
   histo.Copy ( m_h ) ;
   m_h.SetDirectory ( nullptr ) ;
+  m_table = Ostap::Math::HistoTable2D ( m_h , m_tx , m_ty , edges , extrapolate , density ) ;
 }
 // ============================================================================
 /*  constructor with full specification 
@@ -106,6 +178,7 @@ Ostap::Math::Histo3D::Histo3D
 {
   histo.Copy ( m_h ) ;
   m_h.SetDirectory ( nullptr ) ;
+  m_table = Ostap::Math::HistoTable3D ( m_h , m_tx , m_ty , m_tz , edges , extrapolate , density ) ;
 }
 // ============================================================================
 Ostap::Math::Histo1D::Histo1D () 
@@ -129,5 +202,104 @@ Ostap::Math::Histo3D::Histo3D ()
   , m_tz ( Ostap::Math::HistoInterpolation::Default )
 { m_h.SetDirectory ( nullptr ) ; }
 // ============================================================================
+/*  constructor with full  specification 
+ *  @see Ostap::Math::HistoInterpolation
+ */
+// ============================================================================
+Ostap::Math::SparseHisto3D::SparseHisto3D
+( const THnBase&                              histo       , 
+  const Ostap::Math::HistoInterpolation::Type tx          ,
+  const Ostap::Math::HistoInterpolation::Type ty          ,
+  const Ostap::Math::HistoInterpolation::Type tz          ,
+  const bool                                  edges       , 
+  const bool                                  extrapolate ,
+  const bool                                  density     ) 
+  : Ostap::Math::HistoInterpolator ( edges , extrapolate , density ) 
+  , m_x  ( ) 
+  , m_y  ( ) 
+  , m_z  ( ) 
+  , m_bins ( ) 
+  , m_tx ( tx ) 
+  , m_ty ( ty ) 
+  , m_tz ( tz ) 
+{
+  Ostap::Assert ( 3 == histo.GetNdimensions () , 
+                  "Invalid dimension of THnBase"  , 
+                  "Ostap::Math::SparseHisto3D"    ) ;
+  //
+  m_x = _edges_ ( histo.GetAxis ( 0 ) ) ;
+  m_y = _edges_ ( histo.GetAxis ( 1 ) ) ;
+  m_z = _edges_ ( histo.GetAxis ( 2 ) ) ;
+  //
+  const int nx = m_x.size () - 1 ;
+  const int ny = m_y.size () - 1 ;
+  const int nz = m_z.size () - 1 ;
+  //
+  // only filled bins are visited for THnSparse 
+  const Long64_t nbins = histo.GetNbins () ;
+  std::array<int,3> coord ;
+  for ( Long64_t i = 0 ; i < nbins ; ++i ) 
+  {
+    double value = histo.GetBinContent ( i , coord.data () ) ;
+    if ( !value ) { continue ; }
+    // skip underflow/overflow bins 
+    if ( coord [ 0 ] < 1 || nx < coord [ 0 ] ||
+         coord [ 1 ] < 1 || ny < coord [ 1 ] ||
+         coord [ 2 ] < 1 || nz < coord [ 2 ] ) { continue ; }
+    //
+    if ( density ) 
+    {
+      value /= ( m_x [ coord [ 0 ] ] - m_x [ coord [ 0 ] - 1 ] ) ;
+      value /= ( m_y [ coord [ 1 ] ] - m_y [ coord [ 1 ] - 1 ] ) ;
+      value /= ( m_z [ coord [ 2 ] ] - m_z [ coord [ 2 ] - 1 ] ) ;
+    }
+    //
+    const std::uint64_t key = 
+      coord [ 0 ] + std::uint64_t ( nx + 2 ) * ( coord [ 1 ] + std::uint64_t ( ny + 2 ) * coord [ 2 ] ) ;
+    m_bins [ key ] = value ;
+  }
+}
+// ============================================================================
+// content of the bin (0 for empty/missing bins)
+// ============================================================================
+double Ostap::Math::SparseHisto3D::content
+( const int ix , 
+  const int iy , 
+  const int iz ) const 
+{
+  const std::uint64_t nx  = m_x.size () + 1 ;
+  const std::uint64_t ny  = m_y.size () + 1 ;
+  const std::uint64_t key = ix + nx * ( iy + ny * iz ) ;
+  auto it = m_bins.find ( key ) ;
+  return m_bins.end () == it ? 0.0 : it->second ;
+}
+// ============================================================================
+// evaluate the function 
+// ============================================================================
+double Ostap::Math::SparseHisto3D::operator() 
+( const double x , 
+  const double y , 
+  const double z ) const 
+{
+  if ( m_bins.empty () ) { return 0 ; }
+  //
+  std::array<int,2>    bx , by , bz ;
+  std::array<double,2> wx , wy , wz ;
+  const unsigned int nx = _bins_ ( m_x , x , m_tx , m_extrapolate , bx , wx ) ;
+  if ( !nx ) { return 0 ; }
+  const unsigned int ny = _bins_ ( m_y , y , m_ty , m_extrapolate , by , wy ) ;
+  if ( !ny ) { return 0 ; }
+  const unsigned int nz = _bins_ ( m_z , z , m_tz , m_extrapolate , bz , wz ) ;
+  if ( !nz ) { return 0 ; }
+  //
+  double result = 0 ;
+  for ( unsigned int i = 0 ; i < nx ; ++i ) 
+  { for ( unsigned int j = 0 ; j < ny ; ++j ) 
+    { for ( unsigned int k = 0 ; k < nz ; ++k ) 
+      { result += wx [ i ] * wy [ j ] * wz [ k ] * content ( bx [ i ] , by [ j ] , bz [ k ] ) ; } } }
+  //
+  return result ;
+}
+// ============================================================================
 //                                                                      The END 
 // ============================================================================
@@ -0,0 +1,250 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <cmath>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TH1.h"
+#include "TAxis.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Polynomials.h"
+#include "Ostap/Bernstein.h"
+#include "Ostap/BSpline.h"
+#include "Ostap/Chi2Fit.h"
+#include "Ostap/HistoCompare.h"
+#include "Ostap/HistoParam.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Math::HistoParam
+ *  @see Ostap::Math::HistoParam
+ *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /** @struct Design
+   *  The "frozen" design matrix: the averages of basis functions over bins
+   */
+  struct Design
+  {
+    /// the bins used in the fit
+    std::vector<int>    bins  {} ;
+    /// the averages of basis functions (component-major)
+    std::vector<double> cmps  {} ;
+    /// number of components
+    std::size_t         ncmps { 0 } ;
+  } ;
+  // ==========================================================================
+  /// build the design matrix for the histogram and the basis
+  template <class FUNCTION>
+  Design design ( const TH1& histo , const FUNCTION& func )
+  {
+    Design result {} ;
+    const TAxis*  axis = histo.GetXaxis () ;
+    const double  xmin = func.xmin () ;
+    const double  xmax = func.xmax () ;
+    const int     nb   = axis->GetNbins () ;
+    for ( int i = 1 ; i <= nb ; ++i )
+    {
+      const double xc = axis->GetBinCenter ( i ) ;
+      if ( xmin <= xc && xc <= xmax ) { result.bins.push_back ( i ) ; }
+    }
+    //
+    const std::size_t np = result.bins.size () ;
+    result.ncmps = func.npars () ;
+    result.cmps.assign ( result.ncmps * np , 0.0 ) ;
+    //
+    FUNCTION basis ( func ) ;
+    for ( std::size_t k = 0 ; k < result.ncmps ; ++k ) { basis.setPar ( k , 0.0 ) ; }
+    for ( std::size_t k = 0 ; k < result.ncmps ; ++k )
+    {
+      basis.setPar ( k , 1.0 ) ;
+      double* c = result.cmps.data () + k * np ;
+      for ( std::size_t j = 0 ; j < np ; ++j )
+      {
+        const int    bin = result.bins [ j ] ;
+        const double lo  = std::max ( xmin , axis->GetBinLowEdge ( bin ) ) ;
+        const double hi  = std::min ( xmax , axis->GetBinUpEdge  ( bin ) ) ;
+        c [ j ] = lo < hi ? basis.integral ( lo , hi ) / ( hi - lo ) : basis ( 0.5 * ( lo + hi ) ) ;
+      }
+      basis.setPar ( k , 0.0 ) ;
+    }
+    return result ;
+  }
+  // ==========================================================================
+  /// fit the histogram with the given design matrix
+  template <class FUNCTION>
+  Ostap::StatusCode fit_
+  ( const TH1&    histo       ,
+    const Design& design      ,
+    FUNCTION&     func        ,
+    const bool    nonnegative )
+  {
+    const std::size_t np = design.bins.size () ;
+    std::vector<double> data    ( np ) ;
+    std::vector<double> weights ( np ) ;
+    for ( std::size_t j = 0 ; j < np ; ++j )
+    {
+      const int    bin = design.bins [ j ] ;
+      const double e   = histo.GetBinError ( bin ) ;
+      data    [ j ] = histo.GetBinContent ( bin ) ;
+      weights [ j ] = 0 < e ? 1.0 / ( e * e ) : 0.0 ;
+    }
+    //
+    const Ostap::Math::Chi2Solver solver
+      ( design.cmps.data () , design.ncmps , np , weights.data () , nonnegative , 1 ) ;
+    if ( solver.status ().isFailure () ) { return solver.status () ; }      // RETURN
+    //
+    std::vector<double> params ( design.ncmps , 0.0 ) ;
+    double chi2 = 0 ;
+    const Ostap::StatusCode sc = solver.solve ( data.data () , params.data () , chi2 ) ;
+    if ( sc.isFailure () ) { return sc ; }                                  // RETURN
+    //
+    for ( std::size_t k = 0 ; k < design.ncmps ; ++k ) { func.setPar ( k , params [ k ] ) ; }
+    return Ostap::StatusCode::SUCCESS ;
+  }
+  // ==========================================================================
+  /// fit one histogram
+  template <class FUNCTION>
+  Ostap::StatusCode fit_one
+  ( const TH1&    histo       ,
+    FUNCTION&     func        ,
+    const bool    nonnegative )
+  { return fit_ ( histo , design ( histo , func ) , func , nonnegative ) ; }
+  // ==========================================================================
+  /// fit many histograms (in parallel)
+  template <class FUNCTION>
+  std::vector<FUNCTION> fit_many_
+  ( const std::vector<const TH1*>& histos      ,
+    const FUNCTION&                func        ,
+    const bool                     nonnegative ,
+    const unsigned int             nthreads    )
+  {
+    for ( const TH1* h : histos )
+    { Ostap::Assert ( nullptr != h , "Invalid histogram" , "Ostap::Math::HistoParam" ) ; }
+    //
+    const std::size_t     N = histos.size () ;
+    std::vector<FUNCTION> result ( N , func ) ;
+    if ( 0 == N ) { return result ; }                                       // RETURN
+    //
+    // the design matrix for the binning of the first histogram
+    const Design common = design ( *histos.front () , func ) ;
+    //
+    auto one = [&] ( const std::size_t i )
+      {
+        const TH1* h = histos [ i ] ;
+        if ( 0 == i || Ostap::Utils::HistoCompare::same_binning ( histos.front () , h ) )
+        { fit_ ( *h , common , result [ i ] , nonnegative ) ; }
+        else
+        { fit_one ( *h , result [ i ] , nonnegative ) ; }
+      } ;
+    //
+    const unsigned int nt = std::min<std::size_t>
+      ( N , 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ;
+    if ( nt <= 1 )
+    {
+      for ( std::size_t i = 0 ; i < N ; ++i ) { one ( i ) ; }
+      return result ;                                                       // RETURN
+    }
+    //
+    std::atomic<std::size_t> next { 0 } ;
+    Ostap::Utils::WorkerPool pool ( nt ) ;
+    pool.run ( [&] ( const unsigned int /* index */ )
+      { for ( std::size_t i = next++ ; i < N ; i = next++ ) { one ( i ) ; } } ) ;
+    //
+    return result ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// fit the histogram with the linear combination of basis functions
+// ============================================================================
+Ostap::StatusCode Ostap::Math::HistoParam::fit
+( const TH1&                 histo       ,
+  Ostap::Math::LegendreSum&  func        ,
+  const bool                 nonnegative )
+{ return fit_one ( histo , func , nonnegative ) ; }
+// ============================================================================
+Ostap::StatusCode Ostap::Math::HistoParam::fit
+( const TH1&                 histo       ,
+  Ostap::Math::ChebyshevSum& func        ,
+  const bool                 nonnegative )
+{ return fit_one ( histo , func , nonnegative ) ; }
+// ============================================================================
+Ostap::StatusCode Ostap::Math::HistoParam::fit
+( const TH1&                 histo       ,
+  Ostap::Math::Polynomial&   func        ,
+  const bool                 nonnegative )
+{ return fit_one ( histo , func , nonnegative ) ; }
+// ============================================================================
+Ostap::StatusCode Ostap::Math::HistoParam::fit
+( const TH1&                 histo       ,
+  Ostap::Math::Bernstein&    func        ,
+  const bool                 nonnegative )
+{ return fit_one ( histo , func , nonnegative ) ; }
+// ============================================================================
+Ostap::StatusCode Ostap::Math::HistoParam::fit
+( const TH1&                 histo       ,
+  Ostap::Math::BSpline&      func        ,
+  const bool                 nonnegative )
+{ return fit_one ( histo , func , nonnegative ) ; }
+// ============================================================================
+// fit many histograms (in parallel)
+// ============================================================================
+std::vector<Ostap::Math::LegendreSum>
+Ostap::Math::HistoParam::fit_many
+( const std::vector<const TH1*>&   histos      ,
+  const Ostap::Math::LegendreSum&  func        ,
+  const bool                       nonnegative ,
+  const unsigned int               nthreads    )
+{ return fit_many_ ( histos , func , nonnegative , nthreads ) ; }
+// ============================================================================
+std::vector<Ostap::Math::ChebyshevSum>
+Ostap::Math::HistoParam::fit_many
+( const std::vector<const TH1*>&   histos      ,
+  const Ostap::Math::ChebyshevSum& func        ,
+  const bool                       nonnegative ,
+  const unsigned int               nthreads    )
+{ return fit_many_ ( histos , func , nonnegative , nthreads ) ; }
+// ============================================================================
+std::vector<Ostap::Math::Polynomial>
+Ostap::Math::HistoParam::fit_many
+( const std::vector<const TH1*>&   histos      ,
+  const Ostap::Math::Polynomial&   func        ,
+  const bool                       nonnegative ,
+  const unsigned int               nthreads    )
+{ return fit_many_ ( histos , func , nonnegative , nthreads ) ; }
+// ============================================================================
+std::vector<Ostap::Math::Bernstein>
+Ostap::Math::HistoParam::fit_many
+( const std::vector<const TH1*>&   histos      ,
+  const Ostap::Math::Bernstein&    func        ,
+  const bool                       nonnegative ,
+  const unsigned int               nthreads    )
+{ return fit_many_ ( histos , func , nonnegative , nthreads ) ; }
+// ============================================================================
+std::vector<Ostap::Math::BSpline>
+Ostap::Math::HistoParam::fit_many
+( const std::vector<const TH1*>&   histos      ,
+  const Ostap::Math::BSpline&      func        ,
+  const bool                       nonnegative ,
+  const unsigned int               nthreads    )
+{ return fit_many_ ( histos , func , nonnegative , nthreads ) ; }
+// ============================================================================
+//                                                                      The END
+// ============================================================================
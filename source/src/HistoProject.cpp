@@ -4,21 +4,34 @@
 // ROOT 
 // ============================================================================
 #include "RooDataSet.h"
+#include "RooDataHist.h"
+#include "RooAbsRealLValue.h"
+#include "RooAbsBinning.h"
+#include "TTree.h"
 #include "TH1.h"
 #include "TH2.h"
 #include "TH3.h"
+#include "THnBase.h"
+#include "TArrayF.h"
 // ============================================================================
 // Local: 
 // ============================================================================
+#include "Ostap/BinStat.h"
+#include "Ostap/BinReplicas.h"
 #include "Ostap/StatVar.h"
 #include "Ostap/Formula.h"
 #include "Ostap/FormulaVar.h"
 #include "Ostap/HistoProject.h"
-#include "Ostap/Iterator.h"
+#include "Ostap/Notifier.h"
+#include "Ostap/Instrument.h"
+#include "Ostap/MemoryBudget.h"
 // ============================================================================
 #include "OstapDataFrame.h"
+#include "Exception.h"
 #include "local_math.h"
 #include "local_utils.h"
+#include "local_mt.h"
+#include "local_columns.h"
 // ============================================================================
 /** @file
  *  Implementation file for class Ostap::HistoProject
@@ -41,6 +54,782 @@ namespace
     return 0 != arg ? dynamic_cast<RooAbsReal*> ( arg ) : nullptr ;
   }
   // ==========================================================================
+  /** @struct Buffer 
+   *  double-precision accumulator for the single-precision histograms
+   */
+  struct Buffer
+  {
+    /// sum of weights per (global) bin 
+    std::vector<double> sumw     {} ;
+    /// sum of squared weights per (global) bin 
+    std::vector<double> sumw2    {} ;
+    /// number of fills 
+    unsigned long       entries  { 0 } ;
+    /// non-unit weights?
+    bool                weighted { false } ;
+  } ;
+  // ==========================================================================
+  /// does the histogram keep the content in single precision?
+  inline bool single_precision ( const TH1* histo ) 
+  { return nullptr != dynamic_cast<const TArrayF*> ( histo ) ; }
+  // ==========================================================================
+  /// make the buffers for the histogram 
+  std::vector<Buffer> make_buffers ( const TH1* histo , const std::size_t n ) 
+  {
+    std::vector<Buffer> buffers ( n ) ;
+    const std::size_t ncells = histo->GetNcells () ;
+    for ( Buffer& b : buffers ) 
+    {
+      b.sumw .assign ( ncells , 0.0 ) ;
+      b.sumw2.assign ( ncells , 0.0 ) ;
+    }
+    return buffers ;
+  }
+  // ==========================================================================
+  /// merge the buffers (in order) and store the result into the histogram 
+  void flush_buffers ( TH1* histo , const std::vector<Buffer>& buffers ) 
+  {
+    const std::size_t ncells   = histo->GetNcells () ;
+    unsigned long     entries  = 0     ;
+    bool              weighted = false ;
+    for ( const Buffer& b : buffers ) { entries += b.entries ; weighted = weighted || b.weighted ; }
+    if ( weighted && 0 == histo->GetSumw2N () ) { histo->Sumw2 () ; }
+    const bool sumw2 = 0 < histo->GetSumw2N () ;
+    //
+    for ( std::size_t bin = 0 ; bin < ncells ; ++bin ) 
+    {
+      long double s1 = 0 ;
+      long double s2 = 0 ;
+      for ( const Buffer& b : buffers ) { s1 += b.sumw [ bin ] ; s2 += b.sumw2 [ bin ] ; }
+      if ( !s1 && !s2 ) { continue ; }
+      histo->SetBinContent ( bin , s1 ) ;
+      if ( sumw2 ) { histo->GetSumw2 ()->SetAt ( s2 , bin ) ; }
+    }
+    //
+    histo->ResetStats () ;
+    histo->SetEntries ( entries ) ;
+  }
+  // ==========================================================================
+  /** @struct AtomicBuffer
+   *  shared double-precision accumulator for all threads: 
+   *  the fallback for the tight memory budget, when 
+   *  the private clones/buffers do not fit into the memory.
+   *  @attention the order of additions is not defined, 
+   *  the result is not bit-wise reproducible 
+   *  @see Ostap::Utils::memory_budget 
+   */
+  struct AtomicBuffer
+  {
+    AtomicBuffer ( const std::size_t ncells ) 
+      : sumw  ( ncells ) 
+      , sumw2 ( ncells ) 
+    {
+      for ( auto& a : sumw  ) { a.store ( 0.0 , std::memory_order_relaxed ) ; }
+      for ( auto& a : sumw2 ) { a.store ( 0.0 , std::memory_order_relaxed ) ; }
+    }
+    /// sum of weights per (global) bin 
+    std::vector<std::atomic<double> > sumw     ;
+    /// sum of squared weights per (global) bin 
+    std::vector<std::atomic<double> > sumw2    ;
+    /// number of fills 
+    std::atomic<unsigned long>        entries  { 0     } ;
+    /// non-unit weights?
+    std::atomic<bool>                 weighted { false } ;
+  } ;
+  // ==========================================================================
+  /// atomic addition for double 
+  inline void atomic_add ( std::atomic<double>& a , const double value ) 
+  {
+    double old = a.load ( std::memory_order_relaxed ) ;
+    while ( !a.compare_exchange_weak ( old , old + value , std::memory_order_relaxed ) ) {}
+  }
+  // ==========================================================================
+  /// store the shared atomic buffer into the histogram 
+  void flush_atomic ( TH1* histo , const AtomicBuffer& atomic ) 
+  {
+    std::vector<Buffer> buffers ( 1 ) ;
+    Buffer& b  = buffers.front () ;
+    b.entries  = atomic.entries .load () ;
+    b.weighted = atomic.weighted.load () ;
+    b.sumw .reserve ( atomic.sumw .size () ) ;
+    b.sumw2.reserve ( atomic.sumw2.size () ) ;
+    for ( const auto& a : atomic.sumw  ) { b.sumw .push_back ( a.load () ) ; }
+    for ( const auto& a : atomic.sumw2 ) { b.sumw2.push_back ( a.load () ) ; }
+    flush_buffers ( histo , buffers ) ;
+  }
+  // ==========================================================================
+  /** @class ProjectWorker
+   *  helper class to project the chunk of TTree entries into histogram
+   *  - formulas are created for the (per-thread copy of) the tree 
+   *  - the chunk is filled into the histogram, defined by the chunk index 
+   *  - for single-precision histograms the chunk is accumulated 
+   *    into the double-precision buffer, defined by the chunk index 
+   *  - N-dimensional histograms (e.g. <code>THnSparse</code>) are supported 
+   *  - for the tight memory budget all chunks are accumulated 
+   *    into the shared atomic buffer 
+   *  - the private clones of the histogram can be created lazily 
+   *    by the thread that processes the chunk (first-touch placement)
+   */
+  class ProjectWorker 
+  {
+  public:
+    // ========================================================================
+    typedef std::unique_ptr<Ostap::Formula> UOF ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    ProjectWorker
+    ( TTree*                          tree        , 
+      const std::vector<std::string>& expressions , 
+      const std::string&              selection   , 
+      const std::vector<TH1*>&        histos      , 
+      std::vector<Buffer>*            buffers = nullptr , 
+      const std::vector<THnBase*>&    nhistos = {}      , 
+      AtomicBuffer*                   atomic  = nullptr , 
+      Ostap::Utils::FirstTouch<TH1>*  clones  = nullptr ) 
+      : m_tree    ( tree    ) 
+      , m_histos  ( histos  ) 
+      , m_nhistos ( nhistos ) 
+      , m_buffers ( buffers ) 
+      , m_atomic  ( atomic  ) 
+      , m_clones  ( clones  ) 
+      , m_values  ( expressions.size() ) 
+      , m_point   ( expressions.size() ) 
+    {
+      for ( const auto& e : expressions ) 
+      {
+        auto p = std::make_unique<Ostap::Formula> ( e , m_tree ) ;
+        Ostap::Assert ( p && p->ok()                    , 
+                        "Invalid formula:\"" + e + "\"" , 
+                        "Ostap::HistoProject"           ) ;
+        m_formulas.push_back ( std::move ( p ) ) ;
+      }
+      if ( !selection.empty() ) 
+      {
+        m_cuts = std::make_unique<Ostap::Formula> ( selection , m_tree ) ;
+        Ostap::Assert ( m_cuts->ok()                              , 
+                        "Invalid selection:\"" + selection + "\"" , 
+                        "Ostap::HistoProject"                     ) ;
+      }
+      m_notifier = std::make_unique<Ostap::Utils::Notifier> 
+        ( m_formulas.begin() , m_formulas.end() , m_cuts.get() , m_tree ) ;
+    }
+    // ========================================================================
+    /// fill the chunk into histogram 
+    void operator() ( const Ostap::Utils::Chunk& chunk , 
+                      const std::size_t          index ) 
+    {
+      THnBase* hn    = m_nhistos.empty () ? nullptr : m_nhistos [ index ] ;
+      TH1*     histo = 
+        hn       ? nullptr                  : 
+        m_clones ? m_clones -> get ( index ) : 
+        m_histos [ m_buffers || m_atomic ? 0 : index ] ;
+      Buffer*  buff  = m_buffers ? &( *m_buffers ) [ index ] : nullptr ; 
+      TH2*     h2    = hn || 2 != m_formulas.size() ? nullptr : static_cast<TH2*> ( histo ) ;
+      TH3*     h3    = hn || 3 != m_formulas.size() ? nullptr : static_cast<TH3*> ( histo ) ;
+      //
+      const std::size_t N = m_formulas.size() ;
+      for ( unsigned long entry = chunk.first ; entry < chunk.last ; ++entry )
+      {
+        //
+        long ievent = m_tree->GetEntryNumber ( entry ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        ievent      = m_tree->LoadTree ( ievent ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        const double w = m_cuts ? m_cuts->evaluate() : 1.0 ;
+        if ( !w ) { continue  ; }                             // CONTINUE 
+        //
+        // evaluate the expressions (only for non-zero weights)
+        std::size_t n = std::numeric_limits<std::size_t>::max () ;
+        for ( std::size_t i = 0 ; i < N ; ++i ) 
+        { n = std::min ( n , std::size_t ( m_formulas [ i ]->evaluate ( m_values [ i ] ) ) ) ; }
+        //
+        // fill the histogram (array-like expressions are paired element-wise)
+        for ( std::size_t k = 0 ; k < n ; ++k ) 
+        {
+          if      ( hn   ) 
+          {
+            for ( std::size_t i = 0 ; i < N ; ++i ) { m_point [ i ] = m_values [ i ][ k ] ; }
+            hn->Fill ( m_point.data () , w ) ;
+          }
+          else if ( buff ) 
+          {
+            // the bin search is const: the shared histogram is not modified 
+            const int bin = 
+              h3 ? h3   ->FindFixBin ( m_values [ 0 ][ k ] , m_values [ 1 ][ k ] , m_values [ 2 ][ k ] ) :
+              h2 ? h2   ->FindFixBin ( m_values [ 0 ][ k ] , m_values [ 1 ][ k ] ) :
+              histo->FindFixBin ( m_values [ 0 ][ k ] ) ;
+            buff->sumw  [ bin ] += w     ;
+            buff->sumw2 [ bin ] += w * w ;
+            buff->entries       += 1     ;
+            if ( 1 != w ) { buff->weighted = true ; }
+          }
+          else if ( m_atomic ) 
+          {
+            const int bin = 
+              h3 ? h3   ->FindFixBin ( m_values [ 0 ][ k ] , m_values [ 1 ][ k ] , m_values [ 2 ][ k ] ) :
+              h2 ? h2   ->FindFixBin ( m_values [ 0 ][ k ] , m_values [ 1 ][ k ] ) :
+              histo->FindFixBin ( m_values [ 0 ][ k ] ) ;
+            atomic_add ( m_atomic->sumw  [ bin ] , w     ) ;
+            atomic_add ( m_atomic->sumw2 [ bin ] , w * w ) ;
+            m_atomic->entries.fetch_add ( 1 , std::memory_order_relaxed ) ;
+            if ( 1 != w ) { m_atomic->weighted.store ( true , std::memory_order_relaxed ) ; }
+          }
+          else if ( h3 ) { h3   ->Fill ( m_values [ 0 ][ k ] , m_values [ 1 ][ k ] , m_values [ 2 ][ k ] , w ) ; }
+          else if ( h2 ) { h2   ->Fill ( m_values [ 0 ][ k ] , m_values [ 1 ][ k ] , w ) ; }
+          else           { histo->Fill ( m_values [ 0 ][ k ] , w ) ; }
+        }
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the tree 
+    TTree*                                  m_tree     { nullptr } ; // the tree 
+    /// histograms (per chunk) 
+    std::vector<TH1*>                       m_histos   {} ; // histograms 
+    /// N-dimensional histograms (per chunk) 
+    std::vector<THnBase*>                   m_nhistos  {} ; // histograms 
+    /// double-precision buffers (per chunk)
+    std::vector<Buffer>*                    m_buffers  { nullptr } ; // buffers 
+    /// shared atomic buffer (tight memory budget)
+    AtomicBuffer*                           m_atomic   { nullptr } ; // atomic buffer 
+    /// lazy private clones (per chunk)
+    Ostap::Utils::FirstTouch<TH1>*          m_clones   { nullptr } ; // clones 
+    /// formulas 
+    std::vector<UOF>                        m_formulas {} ; // formulas 
+    /// selection 
+    UOF                                     m_cuts     {} ; // selection 
+    /// helper vectors of the results 
+    std::vector<std::vector<double> >       m_values   {} ; // helper vectors    
+    /// helper point for N-dimensional histograms 
+    std::vector<double>                     m_point    {} ; // helper point 
+    /// notifier (must be destroyed before formulas!)
+    std::unique_ptr<Ostap::Utils::Notifier> m_notifier {} ; // notifier 
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** make a projection of TTree/TChain into the 1,2,3D-histogram 
+   *  @param tree        (INPUT)  input tree 
+   *  @param histo       (UPDATE) histogram 
+   *  @param expressions (INPUT)  expressions for x,y,z-axes 
+   *  @param selection   (INPUT)  selection criteria/weight 
+   *  @param nthreads    (INPUT)  number of threads (1: sequential processing)
+   *  @param first       (INPUT)  the first event to process 
+   *  @param last        (INPUT)  the last event to process 
+   *
+   *  The number of private clones/buffers (and therefore the number of threads)
+   *  is limited by the memory budget. If less than two clones fit into 
+   *  the budget, all threads fill the shared atomic buffer. 
+   *  @see Ostap::Utils::memory_budget 
+   */
+  Ostap::StatusCode _project_
+  ( TTree*                          tree        , 
+    TH1*                            histo       , 
+    const std::vector<std::string>& expressions , 
+    const std::string&              selection   , 
+    const unsigned int              nthreads    , 
+    const unsigned long             first       , 
+    const unsigned long             last        ) 
+  {
+    //
+    if ( 0 == histo ) { return Ostap::StatusCode ( 301 ) ; }
+    else { histo->Reset() ; } // reset the historgam 
+    if ( 0 == tree  ) { return Ostap::StatusCode ( 300 ) ; }
+    //
+    const unsigned long nEntries = 
+      std::min ( last , (unsigned long) tree->GetEntries() ) ;
+    if ( nEntries <= first  ) { return Ostap::StatusCode::RECOVERABLE ; }
+    //
+    // validate selection & expressions
+    if ( !selection.empty() && !Ostap::Formula ( selection , tree ).ok() ) 
+    { return Ostap::StatusCode ( 302 ) ; }                         // RETURN 
+    for ( std::size_t i = 0 ; i < expressions.size() ; ++i ) 
+    { 
+      if ( !Ostap::Formula ( expressions [ i ] , tree ).ok() ) 
+      { return Ostap::StatusCode ( 303 + i ) ; }                   // RETURN 
+    }
+    //
+    const bool         single = single_precision ( histo ) ;
+    unsigned int       nt     = 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ;
+    if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) ) 
+    {
+      std::vector<Buffer> buffers = single ? make_buffers ( histo , 1 ) : std::vector<Buffer> () ;
+      ProjectWorker worker ( tree , expressions , selection , { histo } , single ? &buffers : nullptr ) ;
+      {
+        OSTAP_MEMORY_STAGE ( "HistoProject::fill" ) ;
+        worker ( Ostap::Utils::Chunk ( first , nEntries ) , 0 ) ;
+      }
+      OSTAP_MEMORY_STAGE ( "HistoProject::merge" ) ;
+      if ( single ) { flush_buffers ( histo , buffers ) ; }
+      return Ostap::StatusCode::SUCCESS ;                          // RETURN 
+    }
+    //
+    // the memory budget: how many private clones/buffers (content & squared weights) fit?
+    const std::size_t ncells = histo->GetNcells () ;
+    const std::size_t nfit   = Ostap::Utils::copies_in_budget ( 2 * sizeof ( double ) * ncells , nt ) ;
+    //
+    // tight budget: all threads fill the shared atomic buffer 
+    if ( nfit < 2 ) 
+    {
+      AtomicBuffer  atomic ( ncells ) ;
+      AtomicBuffer* pa     = &atomic ;
+      const Ostap::Utils::Chunks chunks = Ostap::Utils::clusters ( tree , first , nEntries , 4 * nt ) ;
+      {
+        OSTAP_MEMORY_STAGE ( "HistoProject::fill" ) ;
+        Ostap::Utils::process_chunks 
+          ( tree , chunks , nt , 
+            [&expressions,&selection,histo,pa] ( TTree* t ) 
+            { return ProjectWorker ( t , expressions , selection , { histo } , nullptr , {} , pa ) ; } ) ;
+      }
+      OSTAP_MEMORY_STAGE ( "HistoProject::merge" ) ;
+      flush_atomic ( histo , atomic ) ;
+      return Ostap::StatusCode::SUCCESS ;                          // RETURN 
+    }
+    // fewer clones: fewer threads 
+    nt = std::min ( nt , (unsigned int) nfit ) ;
+    //
+    // one chunk per thread to keep the memory footprint under control 
+    const Ostap::Utils::Chunks chunks = Ostap::Utils::clusters ( tree , first , nEntries , nt ) ;
+    //
+    // single precision: accumulate into the double-precision buffers 
+    if ( single ) 
+    {
+      std::vector<Buffer> buffers = make_buffers ( histo , chunks.size () ) ;
+      std::vector<Buffer>* pb     = &buffers ;
+      {
+        OSTAP_MEMORY_STAGE ( "HistoProject::fill" ) ;
+        Ostap::Utils::process_chunks 
+          ( tree , chunks , nt , 
+            [&expressions,&selection,histo,pb] ( TTree* t ) 
+            { return ProjectWorker ( t , expressions , selection , { histo } , pb ) ; } ) ;
+      }
+      OSTAP_MEMORY_STAGE ( "HistoProject::merge" ) ;
+      flush_buffers ( histo , buffers ) ;
+      return Ostap::StatusCode::SUCCESS ;                          // RETURN 
+    }
+    //
+    // private clones of the histogram, one per chunk, created 
+    // by the processing thread (local memory for the pinned threads) 
+    Ostap::Utils::FirstTouch<TH1> clones 
+      ( chunks.size () , 
+        [histo] () 
+        { 
+          TH1* h = static_cast<TH1*> ( histo->Clone () ) ;
+          h->SetDirectory ( nullptr ) ;
+          return h ;
+        } ) ;
+    Ostap::Utils::FirstTouch<TH1>* pc = &clones ;
+    {
+      OSTAP_MEMORY_STAGE ( "HistoProject::fill" ) ;
+      const bool add = TH1::AddDirectoryStatus () ;
+      TH1::AddDirectory ( false ) ;
+      try 
+      {
+        Ostap::Utils::process_chunks 
+          ( tree , chunks , nt , 
+            [&expressions,&selection,pc] ( TTree* t ) 
+            { return ProjectWorker ( t , expressions , selection , {} , nullptr , {} , nullptr , pc ) ; } ) ;
+      }
+      catch ( ... ) { TH1::AddDirectory ( add ) ; throw ; }
+      TH1::AddDirectory ( add ) ;
+    }
+    //
+    // merge the clones in the order of chunks (per node first, if configured)
+    OSTAP_MEMORY_STAGE ( "HistoProject::merge" ) ;
+    const std::vector<std::size_t> heads = Ostap::Utils::premerge 
+      ( chunks.size () , nt , 
+        [&clones] ( const std::size_t to , const std::size_t from ) 
+        { 
+          TH1* h = clones [ from ] ;
+          if ( !h ) { return ; }
+          if ( !clones [ to ] ) { clones.get ( to )  ; }
+          clones [ to ]->Add ( h ) ; 
+        } ) ;
+    for ( const std::size_t i : heads ) 
+    { if ( const TH1* h = clones [ i ] ) { histo->Add ( h ) ; } }
+    //
+    return Ostap::StatusCode::SUCCESS ;
+  }
+  // ==========================================================================
+  /** make a projection of TTree/TChain into the N-dimensional histogram 
+   *  @param tree        (INPUT)  input tree 
+   *  @param histo       (UPDATE) histogram 
+   *  @param expressions (INPUT)  expressions for the axes 
+   *  @param selection   (INPUT)  selection criteria/weight 
+   *  @param nthreads    (INPUT)  number of threads (1: sequential processing)
+   *  @param first       (INPUT)  the first event to process 
+   *  @param last        (INPUT)  the last event to process 
+   */
+  Ostap::StatusCode _projectN_
+  ( TTree*                          tree        , 
+    THnBase*                        histo       , 
+    const std::vector<std::string>& expressions , 
+    const std::string&              selection   , 
+    const unsigned int              nthreads    , 
+    const unsigned long             first       , 
+    const unsigned long             last        ) 
+  {
+    //
+    if ( 0 == histo ) { return Ostap::StatusCode ( 301 ) ; }
+    else { histo->Reset() ; } // reset the historgam 
+    if ( 0 == tree  ) { return Ostap::StatusCode ( 300 ) ; }
+    if ( histo->GetNdimensions () != int ( expressions.size () ) ) 
+    { return Ostap::StatusCode ( 301 ) ; }
+    //
+    const unsigned long nEntries = 
+      std::min ( last , (unsigned long) tree->GetEntries() ) ;
+    if ( nEntries <= first  ) { return Ostap::StatusCode::RECOVERABLE ; }
+    //
+    // validate selection & expressions
+    if ( !selection.empty() && !Ostap::Formula ( selection , tree ).ok() ) 
+    { return Ostap::StatusCode ( 302 ) ; }                         // RETURN 
+    for ( std::size_t i = 0 ; i < expressions.size() ; ++i ) 
+    { 
+      if ( !Ostap::Formula ( expressions [ i ] , tree ).ok() ) 
+      { return Ostap::StatusCode ( 303 + i ) ; }                   // RETURN 
+    }
+    //
+    const unsigned int nt = 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ;
+    if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) ) 
+    {
+      ProjectWorker worker ( tree , expressions , selection , {} , nullptr , { histo } ) ;
+      worker ( Ostap::Utils::Chunk ( first , nEntries ) , 0 ) ;
+      return Ostap::StatusCode::SUCCESS ;                          // RETURN 
+    }
+    //
+    const Ostap::Utils::Chunks chunks = Ostap::Utils::clusters ( tree , first , nEntries , nt ) ;
+    //
+    // private clones of the histogram, one per chunk (only non-empty bins for THnSparse)
+    std::vector<std::unique_ptr<THnBase> > clones ; 
+    std::vector<THnBase*>                  histos ; 
+    for ( std::size_t i = 0 ; i < chunks.size() ; ++i ) 
+    {
+      THnBase* h = static_cast<THnBase*> ( histo->Clone () ) ;
+      clones.emplace_back ( h ) ;
+      histos.push_back    ( h ) ;
+    }
+    //
+    Ostap::Utils::process_chunks 
+      ( tree , chunks , nt , 
+        [&expressions,&selection,&histos] ( TTree* t ) 
+        { return ProjectWorker ( t , expressions , selection , {} , nullptr , histos ) ; } ) ;
+    //
+    // merge the clones in the order of chunks 
+    for ( THnBase* h : histos ) { histo->Add ( h ) ; }
+    //
+    return Ostap::StatusCode::SUCCESS ;
+  }
+  // ==========================================================================
+  /** @class ProfileWorker
+   *  helper class to project the chunk of TTree entries into
+   *  the per-bin statistics, defined by the chunk index 
+   *  @see Ostap::BinStat 
+   */
+  class ProfileWorker 
+  {
+  public:
+    // ========================================================================
+    typedef std::unique_ptr<Ostap::Formula> UOF ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    ProfileWorker
+    ( TTree*                          tree        , 
+      const std::vector<std::string>& expressions , 
+      const std::string&              value       , 
+      const std::string&              selection   , 
+      std::vector<Ostap::BinStat>&    results     ) 
+      : m_tree    ( tree    ) 
+      , m_results ( &results ) 
+      , m_values  ( expressions.size() + 1 ) 
+    {
+      for ( std::size_t i = 0 ; i <= expressions.size () ; ++i ) 
+      {
+        const std::string& e = i < expressions.size () ? expressions [ i ] : value ;
+        auto p = std::make_unique<Ostap::Formula> ( e , m_tree ) ;
+        Ostap::Assert ( p && p->ok()                    , 
+                        "Invalid formula:\"" + e + "\"" , 
+                        "Ostap::HistoProject"           ) ;
+        m_formulas.push_back ( std::move ( p ) ) ;
+      }
+      if ( !selection.empty() ) 
+      {
+        m_cuts = std::make_unique<Ostap::Formula> ( selection , m_tree ) ;
+        Ostap::Assert ( m_cuts->ok()                              , 
+                        "Invalid selection:\"" + selection + "\"" , 
+                        "Ostap::HistoProject"                     ) ;
+      }
+      m_notifier = std::make_unique<Ostap::Utils::Notifier> 
+        ( m_formulas.begin() , m_formulas.end() , m_cuts.get() , m_tree ) ;
+    }
+    // ========================================================================
+    /// fill the chunk into the statistics 
+    void operator() ( const Ostap::Utils::Chunk& chunk , 
+                      const std::size_t          index ) 
+    {
+      Ostap::BinStat& result = ( *m_results ) [ index ] ;
+      const std::size_t N    = m_formulas.size() ;
+      const std::size_t D    = N - 1 ;
+      const std::vector<double>& vs = m_values [ D ] ;
+      for ( unsigned long entry = chunk.first ; entry < chunk.last ; ++entry )
+      {
+        //
+        long ievent = m_tree->GetEntryNumber ( entry ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        ievent      = m_tree->LoadTree ( ievent ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        const double w = m_cuts ? m_cuts->evaluate() : 1.0 ;
+        if ( !w ) { continue  ; }                             // CONTINUE 
+        //
+        // evaluate the expressions (only for non-zero weights)
+        std::size_t n = std::numeric_limits<std::size_t>::max () ;
+        for ( std::size_t i = 0 ; i < N ; ++i ) 
+        { n = std::min ( n , std::size_t ( m_formulas [ i ]->evaluate ( m_values [ i ] ) ) ) ; }
+        //
+        // fill the statistics (array-like expressions are paired element-wise)
+        for ( std::size_t k = 0 ; k < n ; ++k ) 
+        {
+          const int bin = 
+            3 == D ? result.bin ( m_values [ 0 ][ k ] , m_values [ 1 ][ k ] , m_values [ 2 ][ k ] ) :
+            2 == D ? result.bin ( m_values [ 0 ][ k ] , m_values [ 1 ][ k ] ) :
+            result.bin ( m_values [ 0 ][ k ] ) ;
+          result.add ( bin , vs [ k ] , w ) ;
+        }
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the tree 
+    TTree*                                  m_tree     { nullptr } ; // the tree 
+    /// the results (per chunk) 
+    std::vector<Ostap::BinStat>*            m_results  { nullptr } ; // results 
+    /// formulas: axes & value  
+    std::vector<UOF>                        m_formulas {} ; // formulas 
+    /// selection 
+    UOF                                     m_cuts     {} ; // selection 
+    /// helper vectors of the results 
+    std::vector<std::vector<double> >       m_values   {} ; // helper vectors    
+    /// notifier (must be destroyed before formulas!)
+    std::unique_ptr<Ostap::Utils::Notifier> m_notifier {} ; // notifier 
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** @class ReplicasWorker
+   *  helper class to project the chunk of TTree entries into
+   *  the Poisson-bootstrap replicas, defined by the chunk index 
+   *  - the Poisson weights are defined by the global entry number 
+   *  @see Ostap::BinReplicas 
+   */
+  class ReplicasWorker 
+  {
+  public:
+    // ========================================================================
+    typedef std::unique_ptr<Ostap::Formula> UOF ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    ReplicasWorker
+    ( TTree*                           tree        , 
+      const std::vector<std::string>&  expressions , 
+      const std::string&               selection   , 
+      std::vector<Ostap::BinReplicas>& results     ) 
+      : m_tree    ( tree    ) 
+      , m_results ( &results ) 
+      , m_values  ( expressions.size() ) 
+    {
+      for ( const auto& e : expressions ) 
+      {
+        auto p = std::make_unique<Ostap::Formula> ( e , m_tree ) ;
+        Ostap::Assert ( p && p->ok()                    , 
+                        "Invalid formula:\"" + e + "\"" , 
+                        "Ostap::HistoProject"           ) ;
+        m_formulas.push_back ( std::move ( p ) ) ;
+      }
+      if ( !selection.empty() ) 
+      {
+        m_cuts = std::make_unique<Ostap::Formula> ( selection , m_tree ) ;
+        Ostap::Assert ( m_cuts->ok()                              , 
+                        "Invalid selection:\"" + selection + "\"" , 
+                        "Ostap::HistoProject"                     ) ;
+      }
+      m_notifier = std::make_unique<Ostap::Utils::Notifier> 
+        ( m_formulas.begin() , m_formulas.end() , m_cuts.get() , m_tree ) ;
+    }
+    // ========================================================================
+    /// fill the chunk into the replicas 
+    void operator() ( const Ostap::Utils::Chunk& chunk , 
+                      const std::size_t          index ) 
+    {
+      Ostap::BinReplicas& result = ( *m_results ) [ index ] ;
+      const std::size_t   D      = m_formulas.size() ;
+      for ( unsigned long entry = chunk.first ; entry < chunk.last ; ++entry )
+      {
+        //
+        long ievent = m_tree->GetEntryNumber ( entry ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        ievent      = m_tree->LoadTree ( ievent ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        const double w = m_cuts ? m_cuts->evaluate() : 1.0 ;
+        if ( !w ) { continue  ; }                             // CONTINUE 
+        //
+        // evaluate the expressions (only for non-zero weights)
+        std::size_t n = std::numeric_limits<std::size_t>::max () ;
+        for ( std::size_t i = 0 ; i < D ; ++i ) 
+        { n = std::min ( n , std::size_t ( m_formulas [ i ]->evaluate ( m_values [ i ] ) ) ) ; }
+        if ( !n ) { continue ; }                              // CONTINUE 
+        //
+        // the same Poisson weights for all elements of the entry 
+        result.poisson ( entry , m_weights ) ;
+        //
+        // fill the replicas (array-like expressions are paired element-wise)
+        for ( std::size_t k = 0 ; k < n ; ++k ) 
+        {
+          const int bin = 
+            3 == D ? result.bin ( m_values [ 0 ][ k ] , m_values [ 1 ][ k ] , m_values [ 2 ][ k ] ) :
+            2 == D ? result.bin ( m_values [ 0 ][ k ] , m_values [ 1 ][ k ] ) :
+            result.bin ( m_values [ 0 ][ k ] ) ;
+          result.add ( bin , w , m_weights ) ;
+        }
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the tree 
+    TTree*                                  m_tree     { nullptr } ; // the tree 
+    /// the results (per chunk) 
+    std::vector<Ostap::BinReplicas>*        m_results  { nullptr } ; // results 
+    /// formulas for the axes 
+    std::vector<UOF>                        m_formulas {} ; // formulas 
+    /// selection 
+    UOF                                     m_cuts     {} ; // selection 
+    /// helper vectors of the results 
+    std::vector<std::vector<double> >       m_values   {} ; // helper vectors    
+    /// the Poisson weights of the current entry 
+    Ostap::BinReplicas::Weights             m_weights  {} ; // Poisson weights 
+    /// notifier (must be destroyed before formulas!)
+    std::unique_ptr<Ostap::Utils::Notifier> m_notifier {} ; // notifier 
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** @class DataHistWorker
+   *  helper class to project the chunk of TTree entries into the 
+   *  double-precision buffer of weights of <code>RooDataHist</code>, 
+   *  defined by the chunk index 
+   *  - the (global) bin is calculated from the binnings of the observables, 
+   *    the last observable runs fastest
+   *  - the entries outside the ranges of observables are skipped 
+   */
+  class DataHistWorker 
+  {
+  public:
+    // ========================================================================
+    typedef std::unique_ptr<Ostap::Formula> UOF ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    DataHistWorker
+    ( TTree*                                 tree        , 
+      const std::vector<std::string>&        expressions , 
+      const std::string&                     selection   , 
+      const std::vector<const RooAbsBinning*>& binnings  , 
+      std::vector<Buffer>&                   buffers     ) 
+      : m_tree     ( tree      ) 
+      , m_binnings ( binnings  ) 
+      , m_buffers  ( &buffers  ) 
+      , m_values   ( expressions.size() ) 
+    {
+      for ( const auto& e : expressions ) 
+      {
+        auto p = std::make_unique<Ostap::Formula> ( e , m_tree ) ;
+        Ostap::Assert ( p && p->ok()                    , 
+                        "Invalid formula:\"" + e + "\"" , 
+                        "Ostap::HistoProject"           ) ;
+        m_formulas.push_back ( std::move ( p ) ) ;
+      }
+      if ( !selection.empty() ) 
+      {
+        m_cuts = std::make_unique<Ostap::Formula> ( selection , m_tree ) ;
+        Ostap::Assert ( m_cuts->ok()                              , 
+                        "Invalid selection:\"" + selection + "\"" , 
+                        "Ostap::HistoProject"                     ) ;
+      }
+      m_notifier = std::make_unique<Ostap::Utils::Notifier> 
+        ( m_formulas.begin() , m_formulas.end() , m_cuts.get() , m_tree ) ;
+    }
+    // ========================================================================
+    /// fill the chunk into the buffer 
+    void operator() ( const Ostap::Utils::Chunk& chunk , 
+                      const std::size_t          index ) 
+    {
+      Buffer& buff = ( *m_buffers ) [ index ] ;
+      const std::size_t N = m_formulas.size() ;
+      for ( unsigned long entry = chunk.first ; entry < chunk.last ; ++entry )
+      {
+        //
+        long ievent = m_tree->GetEntryNumber ( entry ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        ievent      = m_tree->LoadTree ( ievent ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        const double w = m_cuts ? m_cuts->evaluate() : 1.0 ;
+        if ( !w ) { continue  ; }                             // CONTINUE 
+        //
+        // evaluate the expressions (only for non-zero weights)
+        std::size_t n = std::numeric_limits<std::size_t>::max () ;
+        for ( std::size_t i = 0 ; i < N ; ++i ) 
+        { n = std::min ( n , std::size_t ( m_formulas [ i ]->evaluate ( m_values [ i ] ) ) ) ; }
+        //
+        // fill the buffer (array-like expressions are paired element-wise)
+        for ( std::size_t k = 0 ; k < n ; ++k ) 
+        {
+          std::size_t bin    = 0    ;
+          bool        inside = true ;
+          for ( std::size_t i = 0 ; i < N && inside ; ++i ) 
+          {
+            const RooAbsBinning* b = m_binnings [ i ] ;
+            const double         x = m_values   [ i ][ k ] ;
+            inside = b->lowBound () <= x && x <= b->highBound () ;
+            bin    = bin * b->numBins () + b->binNumber ( x ) ;
+          }
+          if ( !inside ) { continue ; }                       // CONTINUE 
+          //
+          buff.sumw  [ bin ] += w     ;
+          buff.sumw2 [ bin ] += w * w ;
+          buff.entries       += 1     ;
+          if ( 1 != w ) { buff.weighted = true ; }
+        }
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the tree 
+    TTree*                                  m_tree     { nullptr } ; // the tree 
+    /// binnings of the observables 
+    std::vector<const RooAbsBinning*>       m_binnings {} ; // binnings 
+    /// double-precision buffers (per chunk)
+    std::vector<Buffer>*                    m_buffers  { nullptr } ; // buffers 
+    /// formulas 
+    std::vector<UOF>                        m_formulas {} ; // formulas 
+    /// selection 
+    UOF                                     m_cuts     {} ; // selection 
+    /// helper vectors of the results 
+    std::vector<std::vector<double> >       m_values   {} ; // helper vectors    
+    /// notifier (must be destroyed before formulas!)
+    std::unique_ptr<Ostap::Utils::Notifier> m_notifier {} ; // notifier 
+    // ========================================================================
+  } ;
+  // ==========================================================================
 }
 // ============================================================================
 /** make a projection of RooDataSet into the histogram 
@@ -73,6 +862,13 @@ Ostap::HistoProject::project
   const double xmin = histo->GetXaxis()->GetXmin () ;
   const double xmax = histo->GetXaxis()->GetXmax () ;
   //
+  // column-wise evaluation for non-weighted RooDataSet 
+  if ( !weighted && columns_loop 
+       ( *data , { &expression } , selection , first , nEntries , 
+         [histo,xmin,xmax] ( const double* v , const double w ) 
+         { if ( xmin <= v [ 0 ] && v [ 0 ] < xmax ) { histo->Fill ( v [ 0 ] , w ) ; } } ) ) 
+  { return Ostap::StatusCode::SUCCESS ; }                         // RETURN 
+  //
   for ( unsigned long entry = first ; entry < nEntries ; ++entry )   
   {
     //
@@ -150,6 +946,16 @@ Ostap::HistoProject::project2
   const double ymin = histo -> GetYaxis () -> GetXmin () ;
   const double ymax = histo -> GetYaxis () -> GetXmax () ;
   //
+  // column-wise evaluation for non-weighted RooDataSet 
+  if ( !weighted && columns_loop 
+       ( *data , { &xexpression , &yexpression } , selection , first , nEntries , 
+         [histo,xmin,xmax,ymin,ymax] ( const double* v , const double w ) 
+         {
+           if ( xmin <= v [ 0 ] && v [ 0 ] < xmax && 
+                ymin <= v [ 1 ] && v [ 1 ] < ymax ) { histo->Fill ( v [ 0 ] , v [ 1 ] , w ) ; }
+         } ) ) 
+  { return Ostap::StatusCode::SUCCESS ; }                         // RETURN 
+  //
   for ( unsigned long entry = first ; entry < nEntries ; ++entry )   
   {
     //
@@ -234,6 +1040,17 @@ Ostap::HistoProject::project3
   const double zmin = histo -> GetZaxis () -> GetXmin () ;
   const double zmax = histo -> GetZaxis () -> GetXmax () ;
   //
+  // column-wise evaluation for non-weighted RooDataSet 
+  if ( !weighted && columns_loop 
+       ( *data , { &xexpression , &yexpression , &zexpression } , selection , first , nEntries , 
+         [histo,xmin,xmax,ymin,ymax,zmin,zmax] ( const double* v , const double w ) 
+         {
+           if ( xmin <= v [ 0 ] && v [ 0 ] < xmax && 
+                ymin <= v [ 1 ] && v [ 1 ] < ymax &&
+                zmin <= v [ 2 ] && v [ 2 ] < zmax ) { histo->Fill ( v [ 0 ] , v [ 1 ] , v [ 2 ] , w ) ; }
+         } ) ) 
+  { return Ostap::StatusCode::SUCCESS ; }                         // RETURN 
+  //
   for ( unsigned long entry = first ; entry < nEntries ; ++entry )   
   {
     //
@@ -309,9 +1126,7 @@ Ostap::HistoProject::project
   RooArgList        alst ;
   const RooArgSet*  aset = data->get() ;
   if ( 0 == aset       ) { return  0 ; }                          // RETURN
-  Ostap::Utils::Iterator iter ( *aset );
-  RooAbsArg*   coef = 0 ;
-  while ( ( coef = (RooAbsArg*) iter.next() ) ){ alst.add ( *coef ); }
+  alst.add ( *aset ) ;
   //
   // convert expressions into FormulaVar 
   const bool        with_cuts   = !selection.empty() ;
@@ -369,9 +1184,7 @@ Ostap::HistoProject::project2
   const RooArgSet*  aset = data->get() ;
   if ( 0 == aset       ) { return  0 ; }  // RETURN
   //
-  Ostap::Utils::Iterator iter ( *aset );
-  RooAbsArg*   coef = 0 ;
-  while ( ( coef = (RooAbsArg*) iter.next() ) ){ alst.add ( *coef ); }
+  alst.add ( *aset ) ;
   //
   // convert expressions into FormulaVar 
   const bool        with_cuts   = !selection.empty() ;
@@ -440,9 +1253,7 @@ Ostap::HistoProject::project3
   const RooArgSet*  aset = data->get() ;
   if ( 0 == aset       ) { return  0 ; }  // RETURN
   //
-  Ostap::Utils::Iterator iter ( *aset );
-  RooAbsArg*   coef = 0 ;
-  while ( ( coef = (RooAbsArg*) iter.next() ) ){ alst.add ( *coef ); }
+  alst.add ( *aset ) ;
   //
   // convert expressions into FormulaVar 
   const bool        with_cuts   = !selection.empty() ;
@@ -487,6 +1298,639 @@ Ostap::HistoProject::project3
                     0 != cut_var ?  cut_var :   cuts.get() , first , last ) ;
 }
 // ============================================================================
+/*  make a projection of TTree/TChain into the histogram 
+ *  @param tree       (INPUT)  input tree 
+ *  @param histo      (UPDATE) histogram 
+ *  @param expression (INPUT)  expression
+ *  @param selection  (INPUT)  selection criteria/weight 
+ *  @param first      (INPUT)  the first event to process 
+ *  @param last       (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::project
+( TTree*              tree       , 
+  TH1*                histo      ,
+  const std::string&  expression ,
+  const std::string&  selection  ,
+  const unsigned long first      ,
+  const unsigned long last       ) 
+{ 
+  if      ( dynamic_cast<TH2*>( histo ) ) { return Ostap::StatusCode ( 301 ) ; }  
+  return _project_ ( tree , histo , { expression } , selection , 1 , first , last ) ; 
+}
+// ============================================================================
+/*  make a projection of TTree/TChain into the 2D-histogram 
+ *  @param tree        (INPUT)  input tree 
+ *  @param histo       (UPDATE) histogram 
+ *  @param xexpression (INPUT)  expression for x-axis 
+ *  @param yexpression (INPUT)  expression for y-axis 
+ *  @param selection   (INPUT)  selection criteria/weight 
+ *  @param first       (INPUT)  the first event to process 
+ *  @param last        (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::project2
+( TTree*              tree        , 
+  TH2*                histo       ,
+  const std::string&  xexpression ,
+  const std::string&  yexpression ,
+  const std::string&  selection   ,
+  const unsigned long first       ,
+  const unsigned long last        ) 
+{ 
+  if      ( dynamic_cast<TH3*>( histo ) ) { return Ostap::StatusCode ( 301 ) ; }  
+  return _project_ ( tree , histo , { xexpression , yexpression } , selection , 1 , first , last ) ; 
+}
+// ============================================================================
+/*  make a projection of TTree/TChain into the 3D-histogram 
+ *  @param tree        (INPUT)  input tree 
+ *  @param histo       (UPDATE) histogram 
+ *  @param xexpression (INPUT)  expression for x-axis 
+ *  @param yexpression (INPUT)  expression for y-axis 
+ *  @param zexpression (INPUT)  expression for z-axis 
+ *  @param selection   (INPUT)  selection criteria/weight 
+ *  @param first       (INPUT)  the first event to process 
+ *  @param last        (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::project3
+( TTree*              tree        , 
+  TH3*                histo       ,
+  const std::string&  xexpression ,
+  const std::string&  yexpression ,
+  const std::string&  zexpression ,
+  const std::string&  selection   ,
+  const unsigned long first       ,
+  const unsigned long last        ) 
+{ 
+  return _project_ ( tree , histo , { xexpression , yexpression , zexpression } , 
+                     selection , 1 , first , last ) ; 
+}
+// ============================================================================
+/*  make a multithreaded projection of TTree/TChain into the histogram 
+ *  @param tree       (INPUT)  input tree 
+ *  @param histo      (UPDATE) histogram 
+ *  @param expression (INPUT)  expression
+ *  @param selection  (INPUT)  selection criteria/weight 
+ *  @param nthreads   (INPUT)  number of threads 
+ *  @param first      (INPUT)  the first event to process 
+ *  @param last       (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::projectMT
+( TTree*              tree       , 
+  TH1*                histo      ,
+  const std::string&  expression ,
+  const std::string&  selection  ,
+  const unsigned int  nthreads   , 
+  const unsigned long first      ,
+  const unsigned long last       ) 
+{ 
+  if      ( dynamic_cast<TH2*>( histo ) ) { return Ostap::StatusCode ( 301 ) ; }  
+  return _project_ ( tree , histo , { expression } , selection , 
+                     Ostap::Utils::nThreads ( nthreads ) , first , last ) ; 
+}
+// ============================================================================
+/*  make a multithreaded projection of TTree/TChain into the 2D-histogram 
+ *  @param tree        (INPUT)  input tree 
+ *  @param histo       (UPDATE) histogram 
+ *  @param xexpression (INPUT)  expression for x-axis 
+ *  @param yexpression (INPUT)  expression for y-axis 
+ *  @param selection   (INPUT)  selection criteria/weight 
+ *  @param nthreads    (INPUT)  number of threads 
+ *  @param first       (INPUT)  the first event to process 
+ *  @param last        (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::project2MT
+( TTree*              tree        , 
+  TH2*                histo       ,
+  const std::string&  xexpression ,
+  const std::string&  yexpression ,
+  const std::string&  selection   ,
+  const unsigned int  nthreads    , 
+  const unsigned long first       ,
+  const unsigned long last        ) 
+{ 
+  if      ( dynamic_cast<TH3*>( histo ) ) { return Ostap::StatusCode ( 301 ) ; }  
+  return _project_ ( tree , histo , { xexpression , yexpression } , selection , 
+                     Ostap::Utils::nThreads ( nthreads ) , first , last ) ; 
+}
+// ============================================================================
+/*  make a multithreaded projection of TTree/TChain into the 3D-histogram 
+ *  @param tree        (INPUT)  input tree 
+ *  @param histo       (UPDATE) histogram 
+ *  @param xexpression (INPUT)  expression for x-axis 
+ *  @param yexpression (INPUT)  expression for y-axis 
+ *  @param zexpression (INPUT)  expression for z-axis 
+ *  @param selection   (INPUT)  selection criteria/weight 
+ *  @param nthreads    (INPUT)  number of threads 
+ *  @param first       (INPUT)  the first event to process 
+ *  @param last        (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::project3MT
+( TTree*              tree        , 
+  TH3*                histo       ,
+  const std::string&  xexpression ,
+  const std::string&  yexpression ,
+  const std::string&  zexpression ,
+  const std::string&  selection   ,
+  const unsigned int  nthreads    , 
+  const unsigned long first       ,
+  const unsigned long last        ) 
+{ 
+  return _project_ ( tree , histo , { xexpression , yexpression , zexpression } , 
+                     selection , Ostap::Utils::nThreads ( nthreads ) , first , last ) ; 
+}
+// ============================================================================
+/*  make a (multithreaded) projection of TTree/TChain into 
+ *  N-dimensional histogram, e.g. <code>THnSparse</code>
+ *  @param tree        (INPUT)  input tree 
+ *  @param histo       (UPDATE) histogram 
+ *  @param expressions (INPUT)  expressions for the axes 
+ *  @param selection   (INPUT)  selection criteria/weight 
+ *  @param nthreads    (INPUT)  number of threads (1: sequential processing)
+ *  @param first       (INPUT)  the first event to process 
+ *  @param last        (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::projectN
+( TTree*                          tree        , 
+  THnBase*                        histo       ,
+  const std::vector<std::string>& expressions ,
+  const std::string&              selection   ,
+  const unsigned int              nthreads    , 
+  const unsigned long             first       ,
+  const unsigned long             last        ) 
+{
+  return _projectN_ ( tree , histo , expressions , selection , 
+                      1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) , first , last ) ; 
+}
+// ============================================================================
+/*  make a projection of TTree/TChain into the 3D sparse histogram 
+ *  @see Ostap::HistoProject::projectN 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::project3
+( TTree*              tree        , 
+  THnBase*            histo       ,
+  const std::string&  xexpression ,
+  const std::string&  yexpression ,
+  const std::string&  zexpression ,
+  const std::string&  selection   ,
+  const unsigned long first       ,
+  const unsigned long last        ) 
+{ 
+  return _projectN_ ( tree , histo , { xexpression , yexpression , zexpression } , 
+                      selection , 1 , first , last ) ; 
+}
+// ============================================================================
+/*  make a multithreaded projection of TTree/TChain into the 3D sparse histogram 
+ *  @see Ostap::HistoProject::projectN 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::project3MT
+( TTree*              tree        , 
+  THnBase*            histo       ,
+  const std::string&  xexpression ,
+  const std::string&  yexpression ,
+  const std::string&  zexpression ,
+  const std::string&  selection   ,
+  const unsigned int  nthreads    , 
+  const unsigned long first       ,
+  const unsigned long last        ) 
+{ 
+  return _projectN_ ( tree , histo , { xexpression , yexpression , zexpression } , 
+                      selection , Ostap::Utils::nThreads ( nthreads ) , first , last ) ; 
+}
+// ============================================================================
+/*  project TTree/TChain into the per-bin statistics of the value,
+ *  in bins of the model histogram, in a single (parallel) pass
+ *  @param tree        (INPUT)  input tree 
+ *  @param result      (UPDATE) the per-bin statistics 
+ *  @param expressions (INPUT)  expressions for the axes of the model histogram 
+ *  @param value       (INPUT)  expression for the value 
+ *  @param selection   (INPUT)  selection criteria/weight 
+ *  @param nthreads    (INPUT)  number of threads (1: sequential processing)
+ *  @param first       (INPUT)  the first event to process 
+ *  @param last        (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::profile
+( TTree*                          tree        , 
+  Ostap::BinStat&                 result      ,
+  const std::vector<std::string>& expressions ,
+  const std::string&              value       ,
+  const std::string&              selection   ,
+  const unsigned int              nthreads    , 
+  const unsigned long             first       ,
+  const unsigned long             last        ) 
+{
+  //
+  if ( !result.model () || result.dim () != expressions.size () ) 
+  { return Ostap::StatusCode ( 301 ) ; }
+  else { result.reset () ; }
+  if ( 0 == tree  ) { return Ostap::StatusCode ( 300 ) ; }
+  //
+  const unsigned long nEntries = 
+    std::min ( last , (unsigned long) tree->GetEntries() ) ;
+  if ( nEntries <= first  ) { return Ostap::StatusCode::RECOVERABLE ; }
+  //
+  // validate selection & expressions
+  if ( !selection.empty() && !Ostap::Formula ( selection , tree ).ok() ) 
+  { return Ostap::StatusCode ( 302 ) ; }                           // RETURN 
+  for ( std::size_t i = 0 ; i < expressions.size() ; ++i ) 
+  { 
+    if ( !Ostap::Formula ( expressions [ i ] , tree ).ok() ) 
+    { return Ostap::StatusCode ( 303 + i ) ; }                     // RETURN 
+  }
+  if ( !Ostap::Formula ( value , tree ).ok() ) 
+  { return Ostap::StatusCode ( 303 + expressions.size() ) ; }      // RETURN 
+  //
+  const unsigned int nt = 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) ) 
+  {
+    std::vector<Ostap::BinStat> results ( 1 , result ) ;
+    ProfileWorker worker ( tree , expressions , value , selection , results ) ;
+    worker ( Ostap::Utils::Chunk ( first , nEntries ) , 0 ) ;
+    result = std::move ( results.front () ) ;
+    return Ostap::StatusCode::SUCCESS ;                            // RETURN 
+  }
+  //
+  // one chunk per thread to keep the memory footprint under control 
+  const Ostap::Utils::Chunks  chunks = Ostap::Utils::clusters ( tree , first , nEntries , nt ) ;
+  std::vector<Ostap::BinStat> results ( chunks.size () , result ) ;
+  //
+  Ostap::Utils::process_chunks 
+    ( tree , chunks , nt , 
+      [&expressions,&value,&selection,&results] ( TTree* t ) 
+      { return ProfileWorker ( t , expressions , value , selection , results ) ; } ) ;
+  //
+  // merge the results in the order of chunks 
+  for ( const Ostap::BinStat& r : results ) { result += r ; }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+/*  project RooAbsData into the per-bin statistics of the value,
+ *  in bins of the model histogram 
+ *  @param data        (INPUT)  input data 
+ *  @param result      (UPDATE) the per-bin statistics 
+ *  @param expressions (INPUT)  expressions for the axes of the model histogram 
+ *  @param value       (INPUT)  expression for the value 
+ *  @param selection   (INPUT)  selection criteria/weight 
+ *  @param first       (INPUT)  the first event to process 
+ *  @param last        (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::profile
+( const RooAbsData*               data        , 
+  Ostap::BinStat&                 result      ,
+  const std::vector<std::string>& expressions ,
+  const std::string&              value       ,
+  const std::string&              selection   ,
+  const unsigned long             first       ,
+  const unsigned long             last        ) 
+{
+  //
+  if ( !result.model () || result.dim () != expressions.size () ) 
+  { return Ostap::StatusCode ( 301 ) ; }
+  else { result.reset () ; }
+  if ( 0 == data  ) { return Ostap::StatusCode ( 300 ) ; }
+  //
+  const unsigned long nEntries = 
+    std::min ( last , (unsigned long) data->numEntries() ) ;
+  if ( nEntries <= first  ) { return Ostap::StatusCode::RECOVERABLE ; }
+  //
+  RooArgList        alst ;
+  const RooArgSet*  aset = data->get() ;
+  if ( 0 == aset       ) { return Ostap::StatusCode ( 300 ) ; }  // RETURN
+  alst.add ( *aset ) ;
+  //
+  // convert expressions into FormulaVar 
+  std::vector<std::unique_ptr<Ostap::FormulaVar> > formulas ;
+  std::vector<const RooAbsReal*>                   vars     ;
+  for ( std::size_t i = 0 ; i <= expressions.size () ; ++i ) 
+  {
+    const std::string& e = i < expressions.size () ? expressions [ i ] : value ;
+    const RooAbsReal*  v = get_var ( *aset , e ) ;
+    if ( 0 == v ) 
+    {
+      formulas.emplace_back ( new Ostap::FormulaVar ( e , alst , false ) ) ;
+      if ( !formulas.back ()->ok () ) { return Ostap::StatusCode ( 303 + i ) ; } // RETURN
+      v = formulas.back ().get () ;
+    }
+    vars.push_back ( v ) ;
+  }
+  //
+  const RooAbsReal* cut_var = selection.empty () ? nullptr : get_var ( *aset , selection ) ;
+  std::unique_ptr<Ostap::FormulaVar> cuts ;
+  if ( !selection.empty () && 0 == cut_var ) 
+  {
+    cuts.reset ( new Ostap::FormulaVar ( selection , alst , false ) ) ;
+    if ( !cuts->ok () ) { return Ostap::StatusCode ( 302 ) ; }    // RETURN 
+    cut_var = cuts.get () ;
+  }
+  //
+  const bool        weighted = data->isWeighted() ;
+  const std::size_t D        = expressions.size () ;
+  for ( unsigned long entry = first ; entry < nEntries ; ++entry )   
+  {
+    //
+    if ( 0 == data->get( entry)  ) { break ; }                    // BREAK
+    //
+    // data weight 
+    const double dw = weighted ? data    -> weight () : 1.0 ;
+    if ( !dw ) { continue ; }                                     // SKIP    
+    //
+    // selection weight 
+    const double sw = cut_var  ? cut_var -> getVal () : 1.0 ;
+    if ( !sw ) { continue ; }                                     // SKIP    
+    //
+    const int bin = 
+      3 == D ? result.bin ( vars [ 0 ]->getVal () , vars [ 1 ]->getVal () , vars [ 2 ]->getVal () ) :
+      2 == D ? result.bin ( vars [ 0 ]->getVal () , vars [ 1 ]->getVal () ) :
+      result.bin ( vars [ 0 ]->getVal () ) ;
+    //
+    result.add ( bin , vars [ D ]->getVal () , sw * dw ) ;
+  }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+/*  project TTree/TChain into the Poisson-bootstrap replicas of the 
+ *  model histogram, in a single (parallel) pass
+ *  @param tree        (INPUT)  input tree 
+ *  @param result      (UPDATE) the replicas 
+ *  @param expressions (INPUT)  expressions for the axes of the model histogram 
+ *  @param selection   (INPUT)  selection criteria/weight 
+ *  @param nthreads    (INPUT)  number of threads (1: sequential processing)
+ *  @param first       (INPUT)  the first event to process 
+ *  @param last        (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::replicas
+( TTree*                          tree        , 
+  Ostap::BinReplicas&             result      ,
+  const std::vector<std::string>& expressions ,
+  const std::string&              selection   ,
+  const unsigned int              nthreads    , 
+  const unsigned long             first       ,
+  const unsigned long             last        ) 
+{
+  //
+  if ( !result.model () || result.dim () != expressions.size () ) 
+  { return Ostap::StatusCode ( 301 ) ; }
+  else { result.reset () ; }
+  if ( 0 == tree  ) { return Ostap::StatusCode ( 300 ) ; }
+  //
+  const unsigned long nEntries = 
+    std::min ( last , (unsigned long) tree->GetEntries() ) ;
+  if ( nEntries <= first  ) { return Ostap::StatusCode::RECOVERABLE ; }
+  //
+  // validate selection & expressions
+  if ( !selection.empty() && !Ostap::Formula ( selection , tree ).ok() ) 
+  { return Ostap::StatusCode ( 302 ) ; }                           // RETURN 
+  for ( std::size_t i = 0 ; i < expressions.size() ; ++i ) 
+  { 
+    if ( !Ostap::Formula ( expressions [ i ] , tree ).ok() ) 
+    { return Ostap::StatusCode ( 303 + i ) ; }                     // RETURN 
+  }
+  //
+  const unsigned int nt = 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) ) 
+  {
+    std::vector<Ostap::BinReplicas> results ( 1 , result ) ;
+    ReplicasWorker worker ( tree , expressions , selection , results ) ;
+    worker ( Ostap::Utils::Chunk ( first , nEntries ) , 0 ) ;
+    result = std::move ( results.front () ) ;
+    return Ostap::StatusCode::SUCCESS ;                            // RETURN 
+  }
+  //
+  // one chunk per thread to keep the memory footprint under control 
+  const Ostap::Utils::Chunks      chunks = Ostap::Utils::clusters ( tree , first , nEntries , nt ) ;
+  std::vector<Ostap::BinReplicas> results ( chunks.size () , result ) ;
+  //
+  Ostap::Utils::process_chunks 
+    ( tree , chunks , nt , 
+      [&expressions,&selection,&results] ( TTree* t ) 
+      { return ReplicasWorker ( t , expressions , selection , results ) ; } ) ;
+  //
+  // merge the results in the order of chunks 
+  for ( const Ostap::BinReplicas& r : results ) { result += r ; }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+/*  project RooAbsData into the Poisson-bootstrap replicas of the 
+ *  model histogram, in a single pass
+ *  @param data        (INPUT)  input data 
+ *  @param result      (UPDATE) the replicas 
+ *  @param expressions (INPUT)  expressions for the axes of the model histogram 
+ *  @param selection   (INPUT)  selection criteria/weight 
+ *  @param first       (INPUT)  the first event to process 
+ *  @param last        (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::replicas
+( const RooAbsData*               data        , 
+  Ostap::BinReplicas&             result      ,
+  const std::vector<std::string>& expressions ,
+  const std::string&              selection   ,
+  const unsigned long             first       ,
+  const unsigned long             last        ) 
+{
+  //
+  if ( !result.model () || result.dim () != expressions.size () ) 
+  { return Ostap::StatusCode ( 301 ) ; }
+  else { result.reset () ; }
+  if ( 0 == data  ) { return Ostap::StatusCode ( 300 ) ; }
+  //
+  const unsigned long nEntries = 
+    std::min ( last , (unsigned long) data->numEntries() ) ;
+  if ( nEntries <= first  ) { return Ostap::StatusCode::RECOVERABLE ; }
+  //
+  RooArgList        alst ;
+  const RooArgSet*  aset = data->get() ;
+  if ( 0 == aset       ) { return Ostap::StatusCode ( 300 ) ; }  // RETURN
+  alst.add ( *aset ) ;
+  //
+  // convert expressions into FormulaVar 
+  std::vector<std::unique_ptr<Ostap::FormulaVar> > formulas ;
+  std::vector<const RooAbsReal*>                   vars     ;
+  for ( std::size_t i = 0 ; i < expressions.size () ; ++i ) 
+  {
+    const std::string& e = expressions [ i ] ;
+    const RooAbsReal*  v = get_var ( *aset , e ) ;
+    if ( 0 == v ) 
+    {
+      formulas.emplace_back ( new Ostap::FormulaVar ( e , alst , false ) ) ;
+      if ( !formulas.back ()->ok () ) { return Ostap::StatusCode ( 303 + i ) ; } // RETURN
+      v = formulas.back ().get () ;
+    }
+    vars.push_back ( v ) ;
+  }
+  //
+  const RooAbsReal* cut_var = selection.empty () ? nullptr : get_var ( *aset , selection ) ;
+  std::unique_ptr<Ostap::FormulaVar> cuts ;
+  if ( !selection.empty () && 0 == cut_var ) 
+  {
+    cuts.reset ( new Ostap::FormulaVar ( selection , alst , false ) ) ;
+    if ( !cuts->ok () ) { return Ostap::StatusCode ( 302 ) ; }    // RETURN 
+    cut_var = cuts.get () ;
+  }
+  //
+  const bool                  weighted = data->isWeighted() ;
+  const std::size_t           D        = expressions.size () ;
+  Ostap::BinReplicas::Weights weights  ;
+  for ( unsigned long entry = first ; entry < nEntries ; ++entry )   
+  {
+    //
+    if ( 0 == data->get( entry)  ) { break ; }                    // BREAK
+    //
+    // data weight 
+    const double dw = weighted ? data    -> weight () : 1.0 ;
+    if ( !dw ) { continue ; }                                     // SKIP    
+    //
+    // selection weight 
+    const double sw = cut_var  ? cut_var -> getVal () : 1.0 ;
+    if ( !sw ) { continue ; }                                     // SKIP    
+    //
+    const int bin = 
+      3 == D ? result.bin ( vars [ 0 ]->getVal () , vars [ 1 ]->getVal () , vars [ 2 ]->getVal () ) :
+      2 == D ? result.bin ( vars [ 0 ]->getVal () , vars [ 1 ]->getVal () ) :
+      result.bin ( vars [ 0 ]->getVal () ) ;
+    //
+    result.poisson ( entry , weights ) ;
+    result.add     ( bin   , sw * dw , weights ) ;
+  }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+/*  make a direct (multithreaded) projection of TTree/TChain into 
+ *  the binned dataset, without the intermediate <code>RooDataSet</code>
+ *  or histogram, in a single (parallel) pass
+ *  @param tree        (INPUT)  input tree 
+ *  @param data        (UPDATE) binned dataset with real observables 
+ *  @param expressions (INPUT)  expressions for the observables (in the order of 
+ *                              <code>data->get()</code>), empty: names of the observables 
+ *  @param selection   (INPUT)  selection criteria/weight 
+ *  @param nthreads    (INPUT)  number of threads (1: sequential processing)
+ *  @param first       (INPUT)  the first event to process 
+ *  @param last        (INPUT)  the last event to process 
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::HistoProject::project
+( TTree*                          tree        , 
+  RooDataHist*                    data        ,
+  const std::vector<std::string>& expressions ,
+  const std::string&              selection   ,
+  const unsigned int              nthreads    , 
+  const unsigned long             first       ,
+  const unsigned long             last        ) 
+{
+  //
+  if ( 0 == data  ) { return Ostap::StatusCode ( 301 ) ; }
+  if ( 0 == tree  ) { return Ostap::StatusCode ( 300 ) ; }
+  //
+  const RooArgSet*  aset = data->get () ;
+  if ( 0 == aset  ) { return Ostap::StatusCode ( 301 ) ; }
+  //
+  // the observables and their binnings 
+  std::vector<RooAbsRealLValue*>    vars     ;
+  std::vector<const RooAbsBinning*> binnings ;
+  std::vector<std::string>          exprs    ;
+  std::size_t                       nbins    = 1 ;
+  for ( RooAbsArg* coef : *aset )
+  {
+    RooAbsRealLValue* v = dynamic_cast<RooAbsRealLValue*> ( coef ) ;
+    if ( 0 == v ) { return Ostap::StatusCode ( 301 ) ; }          // RETURN 
+    vars     .push_back (  v ) ;
+    binnings .push_back ( &v->getBinning () ) ;
+    exprs    .push_back (  v->GetName () ) ;
+    nbins   *= binnings.back ()->numBins () ;
+  }
+  if ( vars.empty () ) { return Ostap::StatusCode ( 301 ) ; }
+  if ( !expressions.empty () ) 
+  {
+    if ( expressions.size () != vars.size () ) { return Ostap::StatusCode ( 301 ) ; }
+    exprs = expressions ;
+  }
+  //
+  data->reset () ; // reset the dataset 
+  //
+  const unsigned long nEntries = 
+    std::min ( last , (unsigned long) tree->GetEntries() ) ;
+  if ( nEntries <= first  ) { return Ostap::StatusCode::RECOVERABLE ; }
+  //
+  // validate selection & expressions
+  if ( !selection.empty() && !Ostap::Formula ( selection , tree ).ok() ) 
+  { return Ostap::StatusCode ( 302 ) ; }                           // RETURN 
+  for ( std::size_t i = 0 ; i < exprs.size() ; ++i ) 
+  { 
+    if ( !Ostap::Formula ( exprs [ i ] , tree ).ok() ) 
+    { return Ostap::StatusCode ( 303 + i ) ; }                     // RETURN 
+  }
+  //
+  const unsigned int nt = 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ;
+  const bool         mt = 1 != nt && Ostap::Utils::parallelizable ( tree ) ;
+  //
+  // one chunk per thread to keep the memory footprint under control 
+  const Ostap::Utils::Chunks chunks = mt ? 
+    Ostap::Utils::clusters ( tree , first , nEntries , nt ) : 
+    Ostap::Utils::Chunks   ( 1 , Ostap::Utils::Chunk ( first , nEntries ) ) ;
+  //
+  std::vector<Buffer> buffers ( chunks.size () ) ;
+  for ( Buffer& b : buffers ) 
+  {
+    b.sumw .assign ( nbins , 0.0 ) ;
+    b.sumw2.assign ( nbins , 0.0 ) ;
+  }
+  //
+  if ( !mt ) 
+  {
+    DataHistWorker worker ( tree , exprs , selection , binnings , buffers ) ;
+    worker ( chunks.front () , 0 ) ;
+  }
+  else 
+  {
+    Ostap::Utils::process_chunks 
+      ( tree , chunks , nt , 
+        [&exprs,&selection,&binnings,&buffers] ( TTree* t ) 
+        { return DataHistWorker ( t , exprs , selection , binnings , buffers ) ; } ) ;
+  }
+  //
+  // merge the buffers in the order of chunks and fill the dataset 
+  bool weighted = false ;
+  for ( const Buffer& b : buffers ) { weighted = weighted || b.weighted ; }
+  //
+  const std::size_t N = vars.size () ;
+  for ( std::size_t bin = 0 ; bin < nbins ; ++bin ) 
+  {
+    long double s1 = 0 ;
+    long double s2 = 0 ;
+    for ( const Buffer& b : buffers ) { s1 += b.sumw [ bin ] ; s2 += b.sumw2 [ bin ] ; }
+    if ( !s1 && !s2 ) { continue ; }
+    //
+    // set the observables to the bin centre 
+    std::size_t index = bin ;
+    for ( std::size_t i = N ; 0 < i ; --i ) 
+    {
+      const RooAbsBinning* b  = binnings [ i - 1 ] ;
+      const int            nb = b->numBins () ;
+      vars [ i - 1 ]->setVal ( b->binCenter ( index % nb ) ) ;
+      index /= nb ;
+    }
+    //
+    if ( weighted ) { data->add ( *aset , s1 , s2 ) ; }
+    else            { data->add ( *aset , s1      ) ; }
+  }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
 /*  make a projection of DataFrame into the histogram 
  *  @param data  (INPUT)  input data 
  *  @param histo (UPDATE) histogram 
@@ -0,0 +1,597 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TAxis.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Math.h"
+#include "Ostap/HistoTables.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for
+ *   - class Ostap::Math::HistoAxisTable
+ *   - class Ostap::Math::HistoTable1D
+ *   - class Ostap::Math::HistoTable2D
+ *   - class Ostap::Math::HistoTable3D
+ *
+ *  All interpolation rules of Ostap::Math::HistoInterpolation are separable,
+ *  the result is \f$ \sum_{ijk} w^x_i w^y_j w^z_k v_{ijk}\f$ and the squared
+ *  uncertainty is \f$ \sum_{ijk} e^x_i e^y_j e^z_k \sigma^2_{ijk}\f$, where
+ *  the per-axis weights are defined by the Lagrange stencils along the axis.
+ *
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2023-01-31
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// equality criteria for doubles
+  const Ostap::Math::Equal_To<double> s_equal{} ; // equality criteria for doubles
+  // ==========================================================================
+  typedef Ostap::Math::HistoAxisTable::Stencil Stencil ;
+  // ==========================================================================
+  /// adjust the interpolation type, the same as in HistoInterpolation
+  inline Ostap::Math::HistoInterpolation::Type
+  _adjust_
+  ( const Ostap::Math::HistoInterpolation::Type t  ,
+    const unsigned int                          nb )
+  {
+    typedef Ostap::Math::HistoInterpolation HI ;
+    return
+      ( t <= HI::Nearest                 ) ? HI::Nearest   :
+      ( 1  >= nb                         ) ? HI::Nearest   :
+      ( 2  == nb && t >= HI::Linear      ) ? HI::Linear    :
+      ( 3  == nb && t >= HI::Quadratic   ) ? HI::Quadratic :
+      (             t >= HI::Cubic       ) ? HI::Cubic     : t ;
+  }
+  // ==========================================================================
+  /// quadratic Lagrange weights
+  inline void _quadratic_
+  ( const double x  ,
+    const double x0 ,
+    const double x1 ,
+    const double x2 ,
+    double*      c  )
+  {
+    const double dx0  = x  - x0 ;
+    const double dx1  = x  - x1 ;
+    const double dx2  = x  - x2 ;
+    //
+    const double dx01 = x0 - x1 ;
+    const double dx02 = x0 - x2 ;
+    const double dx12 = x1 - x2 ;
+    //
+    c [ 0 ] =   dx1 * dx2 / ( dx01 * dx02 ) ;
+    c [ 1 ] = - dx0 * dx2 / ( dx01 * dx12 ) ;
+    c [ 2 ] =   dx0 * dx1 / ( dx02 * dx12 ) ;
+  }
+  // ==========================================================================
+  /// the stencil with the single bin
+  inline void _nearest_ ( Stencil& s , const unsigned int ib )
+  {
+    s.n      = 1      ;
+    s.i  [0] = ib - 1 ;
+    s.w  [0] = 1      ;
+    s.e  [0] = 1      ;
+  }
+  // ==========================================================================
+  /// sum of values/uncertainties over the stencil
+  inline void _sum_
+  ( const Stencil&     s      ,
+    const double*      values ,
+    const double*      errors ,
+    const std::size_t  offset ,
+    double&            v      ,
+    double&            e2     )
+  {
+    v = 0 ; e2 = 0 ;
+    for ( unsigned short k = 0 ; k < s.n ; ++k )
+    {
+      const std::size_t i = offset + s.i [ k ] ;
+      v  += s.w [ k ] * values [ i ] ;
+      e2 += s.e [ k ] * errors [ i ] ;
+    }
+  }
+  // ==========================================================================
+  /// sum of values over the stencil
+  inline double _sum_
+  ( const Stencil&     s      ,
+    const double*      values ,
+    const std::size_t  offset )
+  {
+    double v = 0 ;
+    for ( unsigned short k = 0 ; k < s.n ; ++k )
+    { v += s.w [ k ] * values [ offset + s.i [ k ] ] ; }
+    return v ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor from the axis
+// ============================================================================
+Ostap::Math::HistoAxisTable::HistoAxisTable
+( const TAxis&                                axis ,
+  const Ostap::Math::HistoInterpolation::Type t    )
+  : m_nbins   ( axis.GetNbins () )
+  , m_xmin    ( axis.GetXmin  () )
+  , m_xmax    ( axis.GetXmax  () )
+  , m_uniform ( nullptr == axis.GetXbins () || 0 == axis.GetXbins ()->GetSize () )
+  , m_t       ( _adjust_ ( t , axis.GetNbins () ) )
+  , m_edges   ( axis.GetNbins () + 1 )
+  , m_centres ( axis.GetNbins ()     )
+{
+  Ostap::Assert ( 0 < m_nbins             ,
+                  "Invalid number of bins" ,
+                  "Ostap::Math::HistoAxisTable" ) ;
+  for ( unsigned int i = 1 ; i <= m_nbins ; ++i )
+  {
+    m_edges   [ i - 1 ] = axis.GetBinLowEdge ( i ) ;
+    m_centres [ i - 1 ] = axis.GetBinCenter  ( i ) ;
+  }
+  m_edges [ m_nbins ] = axis.GetBinUpEdge ( m_nbins ) ;
+}
+// ============================================================================
+// find the bin, the same as TAxis::FindFixBin
+// ============================================================================
+unsigned int Ostap::Math::HistoAxisTable::find ( const double x ) const
+{
+  if      (    x < m_xmin   ) { return 0           ; }
+  else if ( !( x < m_xmax ) ) { return m_nbins + 1 ; }
+  //
+  return m_uniform ?
+    1 + int ( m_nbins * ( x - m_xmin ) / ( m_xmax - m_xmin ) ) :
+    std::upper_bound ( m_edges.begin () , m_edges.end () , x ) - m_edges.begin () ;
+}
+// ============================================================================
+/*  get the stencil for the given point
+ *  @param x           the point
+ *  @param s           (OUTPUT) the stencil
+ *  @param edges       special treatment of edges?
+ *  @param extrapolate extrapolation?
+ *  @param closed      is the upper edge of the axis included?
+ *  @return false if the point is outside the axis
+ */
+// ============================================================================
+bool Ostap::Math::HistoAxisTable::stencil
+( const double x           ,
+  Stencil&     s           ,
+  const bool   edges       ,
+  const bool   extrapolate ,
+  const bool   closed      ) const
+{
+  typedef Ostap::Math::HistoInterpolation HI ;
+  //
+  s.n = 0 ;
+  if ( 0 == m_nbins ) { return false ; }                           // RETURN
+  if ( !extrapolate && ( x < m_xmin || m_xmax < x ) ) { return false ; }
+  //
+  const unsigned int nb = m_nbins ;
+  unsigned int       ib = find ( x ) ;
+  //
+  if ( closed )
+  {
+    if      ( 0      == ib && s_equal ( x , m_xmin ) ) { ib = 1  ; }
+    else if ( nb + 1 == ib && s_equal ( x , m_xmax ) ) { ib = nb ; }
+  }
+  //
+  if      ( extrapolate &&      0 == ib ) { ib =  1 ; }
+  else if ( extrapolate && nb + 1 == ib ) { ib = nb ; }
+  //
+  if ( 0 == ib || nb < ib ) { return false ; }                     // RETURN
+  //
+  if ( HI::Nearest == m_t ) { _nearest_ ( s , ib ) ; return true ; } // RETURN
+  //
+  const double xc = centre ( ib ) ;
+  //
+  // special treatment of edges and bin centres
+  if ( edges && !extrapolate && ( ( 1 == ib && x <= xc ) || ( nb == ib && xc <= x ) ) )
+  { _nearest_ ( s , ib ) ; return true ; }                         // RETURN
+  if ( s_equal ( xc , x ) )
+  { _nearest_ ( s , ib ) ; return true ; }                         // RETURN
+  //
+  if ( HI::Linear == m_t )
+  {
+    const unsigned int i0 =
+      1  >= ib ? 1      :
+      nb <= ib ? nb - 1 :
+      x  <  xc ? ib - 1 : ib ;
+    //
+    const double x0 = centre ( i0     ) ;
+    const double x1 = centre ( i0 + 1 ) ;
+    const double dx = 1 / ( x0 - x1 ) ;
+    const double c0 = ( x  - x1 ) * dx ;
+    const double c1 = ( x0 - x  ) * dx ;
+    //
+    s.n = 2 ;
+    s.i [ 0 ] = i0 - 1 ; s.w [ 0 ] = c0 ; s.e [ 0 ] = c0 * c0 ;
+    s.i [ 1 ] = i0     ; s.w [ 1 ] = c1 ; s.e [ 1 ] = c1 * c1 ;
+    return true ;                                                  // RETURN
+  }
+  //
+  if ( HI::Quadratic == m_t && 3 == nb )
+  {
+    const unsigned int i0 = 1 ;
+    double c [ 3 ] ;
+    _quadratic_ ( x , centre ( 1 ) , centre ( 2 ) , centre ( 3 ) , c ) ;
+    //
+    s.n = 3 ;
+    for ( unsigned short k = 0 ; k < 3 ; ++k )
+    { s.i [ k ] = i0 - 1 + k ; s.w [ k ] = c [ k ] ; s.e [ k ] = c [ k ] * c [ k ] ; }
+    return true ;                                                  // RETURN
+  }
+  //
+  // four-point stencils: bi-quadratic & cubic
+  const unsigned int i0 =
+    2  >= ib     ? 1      :
+    nb <= ib + 1 ? nb - 3 :
+    x < xc       ? ib - 2 : ib - 1 ;
+  //
+  const double x0 = centre ( i0     ) ;
+  const double x1 = centre ( i0 + 1 ) ;
+  const double x2 = centre ( i0 + 2 ) ;
+  const double x3 = centre ( i0 + 3 ) ;
+  //
+  s.n = 4 ;
+  for ( unsigned short k = 0 ; k < 4 ; ++k ) { s.i [ k ] = i0 - 1 + k ; }
+  //
+  if ( HI::Quadratic == m_t )
+  {
+    double a [ 3 ] ;
+    double b [ 3 ] ;
+    if      ( x < x1 )
+    {
+      _quadratic_ ( x , x0 , x1 , x2 , a ) ;
+      for ( unsigned short k = 0 ; k < 3 ; ++k ) { s.w [ k ] = a [ k ] ; s.e [ k ] = a [ k ] * a [ k ] ; }
+      s.w [ 3 ] = 0 ; s.e [ 3 ] = 0 ;
+    }
+    else if ( x > x2 )
+    {
+      _quadratic_ ( x , x1 , x2 , x3 , b ) ;
+      s.w [ 0 ] = 0 ; s.e [ 0 ] = 0 ;
+      for ( unsigned short k = 0 ; k < 3 ; ++k ) { s.w [ k + 1 ] = b [ k ] ; s.e [ k + 1 ] = b [ k ] * b [ k ] ; }
+    }
+    else
+    {
+      // average of two quadratic interpolations
+      _quadratic_ ( x , x0 , x1 , x2 , a ) ;
+      _quadratic_ ( x , x1 , x2 , x3 , b ) ;
+      s.w [ 0 ] = 0.5  *   a [ 0 ]                       ;
+      s.w [ 1 ] = 0.5  * ( a [ 1 ]           + b [ 0 ] ) ;
+      s.w [ 2 ] = 0.5  * ( a [ 2 ]           + b [ 1 ] ) ;
+      s.w [ 3 ] = 0.5  *                       b [ 2 ]   ;
+      s.e [ 0 ] = 0.25 *   a [ 0 ] * a [ 0 ]             ;
+      s.e [ 1 ] = 0.25 * ( a [ 1 ] * a [ 1 ] + b [ 0 ] * b [ 0 ] ) ;
+      s.e [ 2 ] = 0.25 * ( a [ 2 ] * a [ 2 ] + b [ 1 ] * b [ 1 ] ) ;
+      s.e [ 3 ] = 0.25 *                       b [ 2 ] * b [ 2 ]   ;
+    }
+    return true ;                                                  // RETURN
+  }
+  //
+  // cubic
+  const double dx0  = x  - x0 ;
+  const double dx1  = x  - x1 ;
+  const double dx2  = x  - x2 ;
+  const double dx3  = x  - x3 ;
+  //
+  const double dx01 = x0 - x1 ;
+  const double dx02 = x0 - x2 ;
+  const double dx03 = x0 - x3 ;
+  const double dx12 = x1 - x2 ;
+  const double dx13 = x1 - x3 ;
+  const double dx23 = x2 - x3 ;
+  //
+  s.w [ 0 ] =         dx1 * dx2 * dx3 / ( dx01 * dx02 * dx03 ) ;
+  s.w [ 1 ] = - dx0 *       dx2 * dx3 / ( dx01 * dx12 * dx13 ) ;
+  s.w [ 2 ] =   dx0 * dx1 *       dx3 / ( dx02 * dx12 * dx23 ) ;
+  s.w [ 3 ] = - dx0 * dx1 * dx2       / ( dx03 * dx13 * dx23 ) ;
+  for ( unsigned short k = 0 ; k < 4 ; ++k ) { s.e [ k ] = s.w [ k ] * s.w [ k ] ; }
+  //
+  return true ;
+}
+// ============================================================================
+// 1D
+// ============================================================================
+/*  constructor with full specification
+ *  @see Ostap::Math::HistoInterpolation::interpolate_1D
+ */
+// ============================================================================
+Ostap::Math::HistoTable1D::HistoTable1D
+( const TH1&                                  histo       ,
+  const Ostap::Math::HistoInterpolation::Type t           ,
+  const bool                                  edges       ,
+  const bool                                  extrapolate ,
+  const bool                                  density     )
+  : m_edges       ( edges       )
+  , m_extrapolate ( extrapolate )
+  , m_density     ( density     )
+  , m_xaxis       ( *histo.GetXaxis () , t )
+{
+  const TH1* h = &histo ;
+  Ostap::Assert  ( nullptr == dynamic_cast<const TH2*>( h ) ,
+                   "Invalid type of ROOT::TH1"  ,
+                   "Ostap::Math::HistoTable1D"  ) ;
+  //
+  const unsigned int nx = m_xaxis.nbins () ;
+  m_values.resize ( nx ) ;
+  m_errors.resize ( nx ) ;
+  for ( unsigned int ix = 1 ; ix <= nx ; ++ix )
+  {
+    double v = histo.GetBinContent ( ix ) ;
+    double e = histo.GetBinError   ( ix ) ;
+    if ( m_density )
+    {
+      const double ibw = 1 / m_xaxis.width ( ix ) ;
+      v *= ibw ;
+      e *= ibw ;
+    }
+    m_values [ ix - 1 ] = v     ;
+    m_errors [ ix - 1 ] = e * e ;
+  }
+}
+// ============================================================================
+// interpolated value with uncertainty
+// ============================================================================
+Ostap::Math::ValueWithError
+Ostap::Math::HistoTable1D::operator() ( const double x ) const
+{
+  Stencil sx ;
+  if ( !m_xaxis.stencil ( x , sx , m_edges , m_extrapolate , m_edges ) )
+  { return Ostap::Math::ValueWithError () ; }
+  //
+  double v , e2 ;
+  _sum_ ( sx , m_values.data () , m_errors.data () , 0 , v , e2 ) ;
+  return Ostap::Math::ValueWithError ( v , e2 ) ;
+}
+// ============================================================================
+// interpolated value
+// ============================================================================
+double Ostap::Math::HistoTable1D::value ( const double x ) const
+{
+  Stencil sx ;
+  if ( !m_xaxis.stencil ( x , sx , m_edges , m_extrapolate , m_edges ) ) { return 0 ; }
+  return _sum_ ( sx , m_values.data () , 0 ) ;
+}
+// ============================================================================
+// batched evaluation of values
+// ============================================================================
+void Ostap::Math::HistoTable1D::eval
+( const double*     x      ,
+  const std::size_t n      ,
+  double*           result ) const
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = value ( x [ i ] ) ; } }
+// ============================================================================
+// 2D
+// ============================================================================
+/*  constructor with full specification
+ *  @see Ostap::Math::HistoInterpolation::interpolate_2D
+ */
+// ============================================================================
+Ostap::Math::HistoTable2D::HistoTable2D
+( const TH2&                                  histo       ,
+  const Ostap::Math::HistoInterpolation::Type tx          ,
+  const Ostap::Math::HistoInterpolation::Type ty          ,
+  const bool                                  edges       ,
+  const bool                                  extrapolate ,
+  const bool                                  density     )
+  : m_edges       ( edges       )
+  , m_extrapolate ( extrapolate )
+  , m_density     ( density     )
+  , m_xaxis       ( *histo.GetXaxis () , tx )
+  , m_yaxis       ( *histo.GetYaxis () , ty )
+{
+  const unsigned int nx = m_xaxis.nbins () ;
+  const unsigned int ny = m_yaxis.nbins () ;
+  m_values.resize ( nx * ny ) ;
+  m_errors.resize ( nx * ny ) ;
+  for ( unsigned int iy = 1 ; iy <= ny ; ++iy )
+  {
+    for ( unsigned int ix = 1 ; ix <= nx ; ++ix )
+    {
+      double v = histo.GetBinContent ( ix , iy ) ;
+      double e = histo.GetBinError   ( ix , iy ) ;
+      if ( m_density )
+      {
+        const double ibw = 1 / ( m_xaxis.width ( ix ) * m_yaxis.width ( iy ) ) ;
+        v *= ibw ;
+        e *= ibw ;
+      }
+      const std::size_t i = ( iy - 1 ) * std::size_t ( nx ) + ( ix - 1 ) ;
+      m_values [ i ] = v     ;
+      m_errors [ i ] = e * e ;
+    }
+  }
+}
+// ============================================================================
+// interpolated value with uncertainty
+// ============================================================================
+Ostap::Math::ValueWithError
+Ostap::Math::HistoTable2D::operator()
+  ( const double x ,
+    const double y ) const
+{
+  Stencil sx , sy ;
+  if ( !m_xaxis.stencil ( x , sx , m_edges , m_extrapolate ) ||
+       !m_yaxis.stencil ( y , sy , m_edges , m_extrapolate ) )
+  { return Ostap::Math::ValueWithError () ; }
+  //
+  const std::size_t nx = m_xaxis.nbins () ;
+  double v  = 0 ;
+  double e2 = 0 ;
+  for ( unsigned short j = 0 ; j < sy.n ; ++j )
+  {
+    double vx , ex ;
+    _sum_ ( sx , m_values.data () , m_errors.data () , sy.i [ j ] * nx , vx , ex ) ;
+    v  += sy.w [ j ] * vx ;
+    e2 += sy.e [ j ] * ex ;
+  }
+  return Ostap::Math::ValueWithError ( v , e2 ) ;
+}
+// ============================================================================
+// interpolated value
+// ============================================================================
+double Ostap::Math::HistoTable2D::value
+( const double x ,
+  const double y ) const
+{
+  Stencil sx , sy ;
+  if ( !m_xaxis.stencil ( x , sx , m_edges , m_extrapolate ) ||
+       !m_yaxis.stencil ( y , sy , m_edges , m_extrapolate ) ) { return 0 ; }
+  //
+  const std::size_t nx = m_xaxis.nbins () ;
+  double v = 0 ;
+  for ( unsigned short j = 0 ; j < sy.n ; ++j )
+  { v += sy.w [ j ] * _sum_ ( sx , m_values.data () , sy.i [ j ] * nx ) ; }
+  return v ;
+}
+// ============================================================================
+// batched evaluation of values
+// ============================================================================
+void Ostap::Math::HistoTable2D::eval
+( const double*     x      ,
+  const double*     y      ,
+  const std::size_t n      ,
+  double*           result ) const
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = value ( x [ i ] , y [ i ] ) ; } }
+// ============================================================================
+// 3D
+// ============================================================================
+/*  constructor with full specification
+ *  @see Ostap::Math::HistoInterpolation::interpolate_3D
+ */
+// ============================================================================
+Ostap::Math::HistoTable3D::HistoTable3D
+( const TH3&                                  histo       ,
+  const Ostap::Math::HistoInterpolation::Type tx          ,
+  const Ostap::Math::HistoInterpolation::Type ty          ,
+  const Ostap::Math::HistoInterpolation::Type tz          ,
+  const bool                                  edges       ,
+  const bool                                  extrapolate ,
+  const bool                                  density     )
+  : m_edges       ( edges       )
+  , m_extrapolate ( extrapolate )
+  , m_density     ( density     )
+  , m_xaxis       ( *histo.GetXaxis () , tx )
+  , m_yaxis       ( *histo.GetYaxis () , ty )
+  , m_zaxis       ( *histo.GetZaxis () , tz )
+{
+  const unsigned int nx = m_xaxis.nbins () ;
+  const unsigned int ny = m_yaxis.nbins () ;
+  const unsigned int nz = m_zaxis.nbins () ;
+  m_values.resize ( std::size_t ( nx ) * ny * nz ) ;
+  m_errors.resize ( std::size_t ( nx ) * ny * nz ) ;
+  for ( unsigned int iz = 1 ; iz <= nz ; ++iz )
+  {
+    for ( unsigned int iy = 1 ; iy <= ny ; ++iy )
+    {
+      for ( unsigned int ix = 1 ; ix <= nx ; ++ix )
+      {
+        double v = histo.GetBinContent ( ix , iy , iz ) ;
+        double e = histo.GetBinError   ( ix , iy , iz ) ;
+        if ( m_density )
+        {
+          const double ibw = 1 / ( m_xaxis.width ( ix ) *
+                                   m_yaxis.width ( iy ) *
+                                   m_zaxis.width ( iz ) ) ;
+          v *= ibw ;
+          e *= ibw ;
+        }
+        const std::size_t i =
+          ( ( iz - 1 ) * std::size_t ( ny ) + ( iy - 1 ) ) * nx + ( ix - 1 ) ;
+        m_values [ i ] = v     ;
+        m_errors [ i ] = e * e ;
+      }
+    }
+  }
+}
+// ============================================================================
+// interpolated value with uncertainty
+// ============================================================================
+Ostap::Math::ValueWithError
+Ostap::Math::HistoTable3D::operator()
+  ( const double x ,
+    const double y ,
+    const double z ) const
+{
+  Stencil sx , sy , sz ;
+  if ( !m_xaxis.stencil ( x , sx , m_edges , m_extrapolate ) ||
+       !m_yaxis.stencil ( y , sy , m_edges , m_extrapolate ) ||
+       !m_zaxis.stencil ( z , sz , m_edges , m_extrapolate ) )
+  { return Ostap::Math::ValueWithError () ; }
+  //
+  const std::size_t nx = m_xaxis.nbins () ;
+  const std::size_t ny = m_yaxis.nbins () ;
+  double v  = 0 ;
+  double e2 = 0 ;
+  for ( unsigned short k = 0 ; k < sz.n ; ++k )
+  {
+    double vy = 0 ;
+    double ey = 0 ;
+    for ( unsigned short j = 0 ; j < sy.n ; ++j )
+    {
+      double vx , ex ;
+      _sum_ ( sx , m_values.data () , m_errors.data () ,
+              ( sz.i [ k ] * ny + sy.i [ j ] ) * nx , vx , ex ) ;
+      vy += sy.w [ j ] * vx ;
+      ey += sy.e [ j ] * ex ;
+    }
+    v  += sz.w [ k ] * vy ;
+    e2 += sz.e [ k ] * ey ;
+  }
+  return Ostap::Math::ValueWithError ( v , e2 ) ;
+}
+// ============================================================================
+// interpolated value
+// ============================================================================
+double Ostap::Math::HistoTable3D::value
+( const double x ,
+  const double y ,
+  const double z ) const
+{
+  Stencil sx , sy , sz ;
+  if ( !m_xaxis.stencil ( x , sx , m_edges , m_extrapolate ) ||
+       !m_yaxis.stencil ( y , sy , m_edges , m_extrapolate ) ||
+       !m_zaxis.stencil ( z , sz , m_edges , m_extrapolate ) ) { return 0 ; }
+  //
+  const std::size_t nx = m_xaxis.nbins () ;
+  const std::size_t ny = m_yaxis.nbins () ;
+  double v = 0 ;
+  for ( unsigned short k = 0 ; k < sz.n ; ++k )
+  {
+    double vy = 0 ;
+    for ( unsigned short j = 0 ; j < sy.n ; ++j )
+    { vy += sy.w [ j ] * _sum_ ( sx , m_values.data () , ( sz.i [ k ] * ny + sy.i [ j ] ) * nx ) ; }
+    v += sz.w [ k ] * vy ;
+  }
+  return v ;
+}
+// ============================================================================
+// batched evaluation of values
+// ============================================================================
+void Ostap::Math::HistoTable3D::eval
+( const double*     x      ,
+  const double*     y      ,
+  const double*     z      ,
+  const std::size_t n      ,
+  double*           result ) const
+{
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  { result [ i ] = value ( x [ i ] , y [ i ] , z [ i ] ) ; }
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -1,6 +1,14 @@
 // ============================================================================
 // Include files
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+// ============================================================================
+// ROOT 
+// ============================================================================
+#include "TTree.h"
+// ============================================================================
 // local
 // ============================================================================
 #include "Ostap/IFuncs.h"
@@ -15,6 +23,31 @@
 // ============================================================================
 Ostap::IFuncTree::~IFuncTree(){}
 // ============================================================================
+/*  evaluate the function for the block of entries [first,last) 
+ *  and fill the output buffer 
+ *  @return number of evaluated entries 
+ */
+// ============================================================================
+unsigned long Ostap::IFuncTree::evaluate_range 
+( const TTree*        tree   ,
+  const unsigned long first  , 
+  const unsigned long last   , 
+  double*             result ) const 
+{
+  if ( nullptr == tree || nullptr == result ) { return 0 ; }
+  TTree* t = const_cast<TTree*> ( tree ) ;
+  const unsigned long the_last = 
+    std::min ( last , static_cast<unsigned long> ( t->GetEntries () ) ) ;
+  //
+  unsigned long n = 0 ;
+  for ( unsigned long entry = first ; entry < the_last ; ++entry , ++n ) 
+  {
+    if ( t->GetEntry ( entry ) < 0 ) { break ; }
+    result [ n ] = (*this) ( tree ) ;
+  }
+  return n ;
+}
+// ============================================================================
 // desructor
 // ============================================================================
 Ostap::IFuncData::~IFuncData (){}
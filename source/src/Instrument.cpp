@@ -0,0 +1,221 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <mutex>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Instrument.h"
+#include "Ostap/MemoryBudget.h"
+// ============================================================================
+/** @file
+ *  Implementation file for the instrumentation counters
+ *  @see Ostap/Instrument.h
+ *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// the registry of (static) counters
+  struct Registry
+  {
+    std::mutex                                mutex    {} ;
+    std::vector<Ostap::Instrument::Counter*>  counters {} ;
+    std::vector<Ostap::Instrument::MemoryCounter*> memory {} ;
+  } ;
+  // ==========================================================================
+  /// get the registry
+  Registry& registry ()
+  {
+    static Registry s_registry {} ;
+    return s_registry ;
+  }
+  // ==========================================================================
+  /// calibrate the ticks against the steady clock
+  double calibrate ()
+  {
+    typedef std::chrono::steady_clock clock ;
+    const auto               t0 = clock::now () ;
+    const unsigned long long c0 = Ostap::Instrument::ticks () ;
+    std::this_thread::sleep_for ( std::chrono::milliseconds ( 20 ) ) ;
+    const unsigned long long c1 = Ostap::Instrument::ticks () ;
+    const auto               t1 = clock::now () ;
+    const double dt = std::chrono::duration<double> ( t1 - t0 ).count () ;
+    return 0 < dt ? ( c1 - c0 ) / dt : 1.e+9 ;
+  }
+  // ==========================================================================
+  /// atomic maximum
+  inline void update_max ( std::atomic<unsigned long long>& a , const unsigned long long value )
+  {
+    unsigned long long old = a.load ( std::memory_order_relaxed ) ;
+    while ( old < value && !a.compare_exchange_weak ( old , value , std::memory_order_relaxed ) ) {}
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// the global switch
+// ============================================================================
+std::atomic<bool> Ostap::Instrument::s_active { false } ;
+// ============================================================================
+// are the probes compiled?
+// ============================================================================
+bool Ostap::Instrument::compiled ()
+{
+#ifdef OSTAP_INSTRUMENT
+  return true ;
+#else
+  return false ;
+#endif
+}
+// ============================================================================
+// activate/deactivate the probes
+// ============================================================================
+bool Ostap::Instrument::enable ( const bool value )
+{
+  if ( value ) { ticks_per_second () ; } // calibrate before the first use
+  return s_active.exchange ( value ) ;
+}
+// ============================================================================
+// number of ticks per second
+// ============================================================================
+double Ostap::Instrument::ticks_per_second ()
+{
+  static const double s_tps = calibrate () ;
+  return s_tps ;
+}
+// ============================================================================
+// constructor with the name, the counter is registered
+// ============================================================================
+Ostap::Instrument::Counter::Counter ( const char* name )
+  : m_name ( name )
+{
+  Registry& r = registry () ;
+  std::lock_guard<std::mutex> lock ( r.mutex ) ;
+  r.counters.push_back ( this ) ;
+}
+// ============================================================================
+// reset the counter
+// ============================================================================
+void Ostap::Instrument::Counter::reset ()
+{
+  m_calls.store ( 0 , std::memory_order_relaxed ) ;
+  m_ticks.store ( 0 , std::memory_order_relaxed ) ;
+}
+// ============================================================================
+// reset all counters
+// ============================================================================
+void Ostap::Instrument::reset ()
+{
+  Registry& r = registry () ;
+  std::lock_guard<std::mutex> lock ( r.mutex ) ;
+  for ( Counter*       c : r.counters ) { c->reset () ; }
+  for ( MemoryCounter* m : r.memory   ) { m->reset () ; }
+}
+// ============================================================================
+// get the snapshot of all counters, sorted by time
+// (the counters with the same name, e.g. from template instances, are merged)
+// ============================================================================
+std::vector<Ostap::Instrument::Entry>
+Ostap::Instrument::counters ( const bool all )
+{
+  std::vector<Entry> result ;
+  {
+    Registry& r = registry () ;
+    std::lock_guard<std::mutex> lock ( r.mutex ) ;
+    for ( const Counter* c : r.counters )
+    {
+      const unsigned long long calls = c->calls () ;
+      if ( 0 == calls && !all ) { continue ; }
+      auto it = std::find_if ( result.begin () , result.end () ,
+                               [c] ( const Entry& e ) { return e.name == c->name () ; } ) ;
+      if ( result.end () == it ) { result.push_back ( Entry { c->name () , 0 , 0 , 0 } ) ; it = result.end () - 1 ; }
+      it->calls += calls       ;
+      it->ticks += c->ticks () ;
+    }
+  }
+  const double tps = ticks_per_second () ;
+  for ( Entry& e : result ) { e.time = e.ticks / tps ; }
+  std::stable_sort ( result.begin () , result.end () ,
+                     [] ( const Entry& a , const Entry& b ) { return a.ticks > b.ticks ; } ) ;
+  return result ;
+}
+// ============================================================================
+// constructor with the name, the memory counter is registered
+// ============================================================================
+Ostap::Instrument::MemoryCounter::MemoryCounter ( const char* name )
+  : m_name ( name )
+{
+  Registry& r = registry () ;
+  std::lock_guard<std::mutex> lock ( r.mutex ) ;
+  r.memory.push_back ( this ) ;
+}
+// ============================================================================
+// add the call with the RSS at exit and the growth of the peak RSS
+// ============================================================================
+void Ostap::Instrument::MemoryCounter::add
+( const unsigned long long rss    ,
+  const unsigned long long growth )
+{
+  m_calls.fetch_add ( 1 , std::memory_order_relaxed ) ;
+  update_max ( m_rss    , rss    ) ;
+  update_max ( m_growth , growth ) ;
+}
+// ============================================================================
+// reset the memory counter
+// ============================================================================
+void Ostap::Instrument::MemoryCounter::reset ()
+{
+  m_calls .store ( 0 , std::memory_order_relaxed ) ;
+  m_rss   .store ( 0 , std::memory_order_relaxed ) ;
+  m_growth.store ( 0 , std::memory_order_relaxed ) ;
+}
+// ============================================================================
+// start the stage: remember the peak RSS
+// ============================================================================
+Ostap::Instrument::MemoryStage::MemoryStage ( MemoryCounter& counter )
+  : m_counter ( active () ? &counter : nullptr )
+  , m_peak    ( m_counter ? Ostap::Utils::peak_rss () : 0 )
+{}
+// ============================================================================
+// end the stage: record the RSS and the growth of the peak RSS
+// ============================================================================
+Ostap::Instrument::MemoryStage::~MemoryStage ()
+{
+  if ( !m_counter ) { return ; }
+  const unsigned long long peak = Ostap::Utils::peak_rss () ;
+  m_counter->add ( Ostap::Utils::rss () , m_peak < peak ? peak - m_peak : 0 ) ;
+}
+// ============================================================================
+// get the snapshot of all memory counters, in order of registration
+// (the counters with the same name are merged)
+// ============================================================================
+std::vector<Ostap::Instrument::MemoryEntry>
+Ostap::Instrument::memory_counters ( const bool all )
+{
+  std::vector<MemoryEntry> result ;
+  Registry& r = registry () ;
+  std::lock_guard<std::mutex> lock ( r.mutex ) ;
+  for ( const MemoryCounter* m : r.memory )
+  {
+    const unsigned long long calls = m->calls () ;
+    if ( 0 == calls && !all ) { continue ; }
+    auto it = std::find_if ( result.begin () , result.end () ,
+                             [m] ( const MemoryEntry& e ) { return e.name == m->name () ; } ) ;
+    if ( result.end () == it ) { result.push_back ( MemoryEntry { m->name () , 0 , 0 , 0 } ) ; it = result.end () - 1 ; }
+    it->calls += calls ;
+    it->rss    = std::max ( it->rss    , m->rss    () ) ;
+    it->growth = std::max ( it->growth , m->growth () ) ;
+  }
+  return result ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,106 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <mutex>
+#include <vector>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/IntegrationCache.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "shardedcache.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Math::IntegrationCache
+ *  and the registry of caches
+ *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+ *  @date 2023-01-25
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// the registry of (static) caches
+  struct Registry
+  {
+    std::mutex                                   mutex  {} ;
+    std::vector<Ostap::Utils::CacheBase*>        caches {} ;
+  } ;
+  // ==========================================================================
+  /// get the registry
+  Registry& registry ()
+  {
+    static Registry s_registry {} ;
+    return s_registry ;
+  }
+  // ==========================================================================
+  /// sum something over the registered caches
+  template <class FUNCTOR>
+  unsigned long long sum ( FUNCTOR f )
+  {
+    Registry& r = registry () ;
+    std::lock_guard<std::mutex> lock ( r.mutex ) ;
+    unsigned long long n = 0 ;
+    for ( const Ostap::Utils::CacheBase* c : r.caches ) { n += f ( *c ) ; }
+    return n ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::Utils::CacheBase::~CacheBase () {}
+// ============================================================================
+// register the cache
+// ============================================================================
+void Ostap::Utils::CacheBase::register_cache ()
+{
+  Registry& r = registry () ;
+  std::lock_guard<std::mutex> lock ( r.mutex ) ;
+  r.caches.push_back ( this ) ;
+}
+// ============================================================================
+// number of cache hits
+// ============================================================================
+unsigned long long Ostap::Math::IntegrationCache::hits      ()
+{ return sum ( [] ( const Ostap::Utils::CacheBase& c ) { return c.hits      () ; } ) ; }
+// ============================================================================
+// number of cache misses
+// ============================================================================
+unsigned long long Ostap::Math::IntegrationCache::misses    ()
+{ return sum ( [] ( const Ostap::Utils::CacheBase& c ) { return c.misses    () ; } ) ; }
+// ============================================================================
+// number of evicted entries
+// ============================================================================
+unsigned long long Ostap::Math::IntegrationCache::evictions ()
+{ return sum ( [] ( const Ostap::Utils::CacheBase& c ) { return c.evictions () ; } ) ; }
+// ============================================================================
+// number of cached entries
+// ============================================================================
+std::size_t Ostap::Math::IntegrationCache::size ()
+{ return sum ( [] ( const Ostap::Utils::CacheBase& c ) { return c.size      () ; } ) ; }
+// ============================================================================
+// number of registered caches
+// ============================================================================
+std::size_t Ostap::Math::IntegrationCache::caches ()
+{
+  Registry& r = registry () ;
+  std::lock_guard<std::mutex> lock ( r.mutex ) ;
+  return r.caches.size () ;
+}
+// ============================================================================
+// reset all counters
+// ============================================================================
+void Ostap::Math::IntegrationCache::reset ()
+{
+  Registry& r = registry () ;
+  std::lock_guard<std::mutex> lock ( r.mutex ) ;
+  for ( Ostap::Utils::CacheBase* c : r.caches ) { c->reset_counters () ; }
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
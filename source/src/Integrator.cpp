@@ -3,6 +3,7 @@
 // =============================================================================
 // STD&STL
 // =============================================================================
+#include <atomic>
 #include <functional>
 // =============================================================================
 // Ostap
@@ -16,6 +17,7 @@
 #include "Integrator2D.h"
 #include "local_hash.h"
 #include "local_math.h"
+#include "local_mt.h"
 // =============================================================================
 /** @file 
  *  Implementation file for class Ostap::Math::Integrator
@@ -25,6 +27,9 @@
 // =============================================================================
 namespace 
 {
+  // ===========================================================================
+  /// use the fast path for 1D-integration ?
+  std::atomic<bool> s_fast_path { true } ;
   // ===========================================================================
   template <class FUNCTION>
   inline double fun_scale ( const FUNCTION&      fun     , 
@@ -39,6 +44,27 @@ namespace
     return scale * ( xmin - xmax ) / rescale ;
   } 
   // ===========================================================================
+  /// the vectorized adapter for 3D-cubature: all points of the batch at once 
+  int adapter3d_v 
+  ( unsigned      ndim  , 
+    std::size_t   npt   , 
+    const double* x     , 
+    void*         fdata ,
+    unsigned      fdim  , 
+    double*       fval  )   
+  {
+    if ( 1       != fdim  || 
+         3       != ndim  || 
+         nullptr == x     || 
+         nullptr == fdata || 
+         nullptr == fval  ) { return 1 ; }
+    const Ostap::Math::Integrator::function3* f = 
+      static_cast<const Ostap::Math::Integrator::function3*> ( fdata ) ;
+    for ( std::size_t i = 0 ; i < npt ; ++i ) 
+    { fval [ i ] = (*f) ( x [ 3 * i ] , x [ 3 * i + 1 ] , x [ 3 * i + 2 ] ) ; }
+    return 0 ;
+  }
+  // ===========================================================================
 }
 // =============================================================================
 // constructor with integration workspace size 
@@ -48,6 +74,16 @@ Ostap::Math::Integrator::Integrator
   : m_workspace ( size )
 {}
 // =============================================================================
+// use the fast path for 1D-integration ? 
+// =============================================================================
+bool Ostap::Math::Integrator::fast_path () 
+{ return s_fast_path.load ( std::memory_order_relaxed ) ; }
+// =============================================================================
+// switch on/off the fast path for 1D-integration, return the previous value
+// =============================================================================
+bool Ostap::Math::Integrator::set_fast_path ( const bool value ) 
+{ return s_fast_path.exchange ( value ) ; }
+// =============================================================================
 /*  calculate the integral 
  *  \f[ r = \int_{x_{min}}^{x_{max}} f_1(x) dx \f]
  *  @param f1 the function 
@@ -605,10 +641,106 @@ Ostap::Math::Integrator::integrate_
   return result  ( value , error );
 }
 // =============================================================================
-
-
-
-
+/*  calculate the integral (adaptive cubature) 
+ *  \f[ r = \int_{x_{min}}^{x_{max}}\int_{y_{min}}^{y_{max}}f_2(x,y) dx dy \f]
+ *  @param f2 the function 
+ *  @param xmin lower integration edge in x 
+ *  @param xmax upper integration edge in x 
+ *  @param ymin lower integration edge in y 
+ *  @param ymax upper integration edge in y 
+ *  @param aprecision absolute precision 
+ *  @param rprecision relative precision 
+ *  @return the value of the integral and the estimate for the error 
+ */
+// =============================================================================
+Ostap::Math::Integrator::result
+Ostap::Math::Integrator::cubature2_
+( Ostap::Math::Integrator::function2 f2         , 
+  const double                       xmin       , 
+  const double                       xmax       ,
+  const double                       ymin       , 
+  const double                       ymax       ,
+  const double                       aprecision , 
+  const double                       rprecision ) 
+{ 
+  //
+  if ( s_equal ( xmin , xmax ) || s_equal ( ymin , ymax ) ) { return result ( 0 , 0 ) ; }
+  //
+  static const Ostap::Math::GSL::Integrator2D<function2> s_cubature{} ;
+  static const char s_message[] = "Ostap::Math::Integrator/cubature(2D)" ;
+  const auto F = s_cubature.make_function ( &f2 , xmin , xmax , ymin , ymax ) ;
+  int     ierror =  0 ;
+  double  value  =  1 ;
+  double  error  = -1 ;
+  std::tie ( ierror , value , error ) = s_cubature.cubature 
+    ( &F                                , // the function  
+      100000                            , // limits  
+      0 < aprecision ? aprecision : s_APRECISION , // absolute precision 
+      0 < rprecision ? rprecision : s_RPRECISION , // relative precision 
+      //
+      s_message   ,   // message 
+      __FILE__    ,   // the file name 
+      __LINE__    ) ; // the line number 
+  //
+  return result  ( value , error );
+}
+// =============================================================================
+/*  calculate the integral (adaptive cubature) 
+ *  \f[ r = \int_{x_{min}}^{x_{max}}\int_{y_{min}}^{y_{max}}\int_{z_{min}}^{z_{max}}f_3(x,y,z) dx dy dz \f]
+ *  @param f3 the function 
+ *  @param xmin lower integration edge in x 
+ *  @param xmax upper integration edge in x 
+ *  @param ymin lower integration edge in y 
+ *  @param ymax upper integration edge in y 
+ *  @param zmin lower integration edge in z 
+ *  @param zmax upper integration edge in z 
+ *  @param aprecision absolute precision 
+ *  @param rprecision relative precision 
+ *  @param nthreads   number of threads for evaluation of the regions 
+ *  @return the value of the integral and the estimate for the error 
+ */
+// =============================================================================
+Ostap::Math::Integrator::result
+Ostap::Math::Integrator::cubature3_
+( Ostap::Math::Integrator::function3 f3         , 
+  const double                       xmin       , 
+  const double                       xmax       ,
+  const double                       ymin       , 
+  const double                       ymax       ,
+  const double                       zmin       , 
+  const double                       zmax       ,
+  const double                       aprecision , 
+  const double                       rprecision , 
+  const unsigned int                 nthreads   ) 
+{
+  //
+  if ( s_equal ( xmin , xmax ) || 
+       s_equal ( ymin , ymax ) || 
+       s_equal ( zmin , zmax ) ) { return result ( 0 , 0 ) ; }
+  //
+  OSTAP_PROBE ( "Ostap::Math::Integrator3D::computed" ) ;
+  static const char s_message[] = "Ostap::Math::Integrator/cubature(3D)" ;
+  const double xlow  [3] = { xmin , ymin , zmin } ;
+  const double xhigh [3] = { xmax , ymax , zmax } ;
+  double value  =  1 ;
+  double error  = -1 ;
+  // the points from many regions are evaluated in one batch,
+  // the batch is split between the threads 
+  const unsigned int nt = 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ;
+  const int ierror = hcubature_v_mt 
+    ( 1 , &adapter3d_v , &f3 ,                   // f-dimension, function & data 
+      3 , xlow , xhigh       ,                   // dimension and integration range 
+      500000                 ,                   // maximal number of function calls 
+      0 < aprecision ? aprecision : s_APRECISION , // absolute precision 
+      0 < rprecision ? rprecision : s_RPRECISION , // relative precision 
+      ERROR_INDIVIDUAL       ,                   // error norm 
+      &value , &error        ,                   // output: result&error
+      nt                     ) ;                 // number of threads 
+  //
+  if ( ierror ) { gsl_error ( s_message , __FILE__ , __LINE__ , ierror ) ; }
+  //
+  return result ( value , error ) ;
+}
 // =============================================================================
 //                                                                       The END 
 // =============================================================================
@@ -8,10 +8,14 @@
 // ============================================================================
 #include <map>
 #include <vector>
+#include <cmath>
+#include <algorithm>
 // ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/GSL_utils.h"
+#include "Ostap/Integrator.h"
+#include "Ostap/Instrument.h"
 // ============================================================================
 // GSL
 // ============================================================================
@@ -23,7 +27,7 @@
 #include "GSL_sentry.h"
 #include "local_gsl.h"
 #include "local_hash.h"   // hash_combine 
-#include "syncedcache.h"  // the cache 
+#include "shardedcache.h" // the cache 
 // ============================================================================
 namespace Ostap
 {
@@ -105,8 +109,18 @@ namespace Ostap
                                                    line       , 
                                                    rule       ) ; }
           //
+          // try the fast non-adaptive path first 
+          const bool fast = Ostap::Math::Integrator::fast_path () ;
+          if ( fast ) 
+          {
+            Result quick {} ;
+            if ( fast_integrate ( func , xlow , xhigh , aprecision , rprecision , rule , quick ) ) 
+            { return quick ; }                                        // RETURN 
+          }
+          //
           // setup GSL 
           Ostap::Math::GSL::GSL_Error_Handler sentry ;
+          OSTAP_PROBE ( "Ostap::Math::Integrator::computed" ) ;
           //
           double    result =  1.0 ;
           double    error  = -1.0 ;
@@ -125,6 +139,9 @@ namespace Ostap
               &error             ) ; // the error in result
           if ( ierror ) { gsl_error ( reason , file , line , ierror ) ; }
           //
+          // remember the subdivisions for the next calls 
+          if ( fast && !ierror ) { learn ( xlow , xhigh , rule , workspace ) ; }
+          //
           return Result { ierror , result , error } ;  
         }
         // ====================================================================
@@ -153,6 +170,7 @@ namespace Ostap
           //
           // setup GSL 
           Ostap::Math::GSL::GSL_Error_Handler sentry ;
+          OSTAP_PROBE ( "Ostap::Math::Integrator::computed" ) ;
           //
           double    result =  1.0 ;
           double    error  = -1.0 ;
@@ -199,6 +217,7 @@ namespace Ostap
           //
           // setup GSL 
           Ostap::Math::GSL::GSL_Error_Handler sentry ;
+          OSTAP_PROBE ( "Ostap::Math::Integrator::computed" ) ;
           //
           double    result =  1.0 ;
           double    error  = -1.0 ;
@@ -245,6 +264,7 @@ namespace Ostap
                                                      line       ) ; }
           // setup GSL 
           Ostap::Math::GSL::GSL_Error_Handler sentry ;
+          OSTAP_PROBE ( "Ostap::Math::Integrator::computed" ) ;
           //
           double    result =  1.0 ;
           double    error  = -1.0 ;
@@ -296,6 +316,7 @@ namespace Ostap
           
           // setup GSL 
           Ostap::Math::GSL::GSL_Error_Handler sentry ;
+          OSTAP_PROBE ( "Ostap::Math::Integrator::computed" ) ;
           //
           double    result =  1.0 ;
           double    error  = -1.0 ;
@@ -350,6 +371,7 @@ namespace Ostap
                                                     line       ) ; }
           // setup GSL 
           Ostap::Math::GSL::GSL_Error_Handler sentry ;
+          OSTAP_PROBE ( "Ostap::Math::Integrator::computed" ) ;
           //
           double    result =  1.0 ;
           double    error  = -1.0 ;
@@ -396,9 +418,9 @@ namespace Ostap
               limit      , reason , file , line , rule ) ;
           // ==================================================================
           { // look into the cache ============================================
-            CACHE::Lock lock { s_cache.mutex() } ;
-            auto it = s_cache->find  ( key ) ;
-            if ( s_cache->end() != it ) {  return it->second ; }  // AVOID calculation
+            Result cached {} ;
+            if ( s_cache.find ( key , cached ) ) 
+            { OSTAP_COUNT ( "Ostap::Math::Integrator::cached" ) ; return cached ; }  // AVOID calculation
             // ================================================================
           } // ================================================================
           // ==================================================================
@@ -411,11 +433,8 @@ namespace Ostap
                                           reason        , file , line , rule ) ;
           // ==================================================================
           { // update the cache ===============================================
-            CACHE::Lock lock  { s_cache.mutex() } ;
-            // clear the cache is too large
-            if ( s_CACHESIZE < s_cache->size() ) { s_cache->clear() ; }
-            // update the cache
-            s_cache->insert ( std::make_pair ( key , result ) ) ;
+            // update the cache (the unused entries are evicted, if needed)
+            s_cache.insert ( key , result ) ;
           } // ================================================================
           // ==================================================================
           return result ;
@@ -443,9 +462,9 @@ namespace Ostap
               limit      , reason     , file , line ) ;
           // ==================================================================
           { // look into the cache ============================================
-            CACHE::Lock lock { s_cache.mutex() } ;
-            auto it = s_cache->find  ( key ) ;
-            if ( s_cache->end() != it ) {  return it->second ; }  // AVOID calculation
+            Result cached {} ;
+            if ( s_cache.find ( key , cached ) ) 
+            { OSTAP_COUNT ( "Ostap::Math::Integrator::cached" ) ; return cached ; }  // AVOID calculation
             // ================================================================
           } // ================================================================
           // ==================================================================
@@ -457,11 +476,8 @@ namespace Ostap
                                            reason     , file , line ) ;
           // ==================================================================
           { // update the cache ===============================================
-            CACHE::Lock lock  { s_cache.mutex() } ;
-            // clear the cache is too large
-            if ( s_CACHESIZE < s_cache->size() ) { s_cache->clear() ; }
-            // update the cache
-            s_cache->insert ( std::make_pair ( key , result ) ) ;
+            // update the cache (the unused entries are evicted, if needed)
+            s_cache.insert ( key , result ) ;
           } // ================================================================
           // ==================================================================
           return result ;
@@ -490,9 +506,9 @@ namespace Ostap
               limit      , reason , file , line ) ;
           // ==================================================================
           { // look into the cache ============================================
-            CACHE::Lock lock { s_cache.mutex() } ;
-            auto it = s_cache->find  ( key ) ;
-            if ( s_cache->end() != it ) {  return it->second ; }  // AVOID calculation
+            Result cached {} ;
+            if ( s_cache.find ( key , cached ) ) 
+            { OSTAP_COUNT ( "Ostap::Math::Integrator::cached" ) ; return cached ; }  // AVOID calculation
             // ================================================================
           } // ================================================================
           // ==================================================================
@@ -505,11 +521,8 @@ namespace Ostap
                                             reason     , file , line ) ;
           // ==================================================================
           { // update the cache ===============================================
-            CACHE::Lock lock  { s_cache.mutex() } ;
-            // clear the cache is too large
-            if ( s_CACHESIZE < s_cache->size() ) { s_cache->clear() ; }
-            // update the cache
-            s_cache->insert ( std::make_pair ( key , result ) ) ;
+            // update the cache (the unused entries are evicted, if needed)
+            s_cache.insert ( key , result ) ;
           } // ================================================================
           // ==================================================================
           return result ;
@@ -538,9 +551,9 @@ namespace Ostap
               limit      , reason        ,  file , line ) ;
           // ==================================================================
           { // look into the cache ============================================
-            CACHE::Lock lock { s_cache.mutex() } ;
-            auto it = s_cache->find  ( key ) ;
-            if ( s_cache->end() != it ) {  return it->second ; }  // AVOID calculation
+            Result cached {} ;
+            if ( s_cache.find ( key , cached ) ) 
+            { OSTAP_COUNT ( "Ostap::Math::Integrator::cached" ) ; return cached ; }  // AVOID calculation
             // ================================================================
           } // ================================================================
           // ==================================================================
@@ -553,11 +566,8 @@ namespace Ostap
                                             reason     , file , line ) ;
           // ==================================================================
           { // update the cache ===============================================
-            CACHE::Lock lock  { s_cache.mutex() } ;
-            // clear the cache is too large
-            if ( s_CACHESIZE < s_cache->size() ) { s_cache->clear() ; }
-            // update the cache
-            s_cache->insert ( std::make_pair ( key , result ) ) ;
+            // update the cache (the unused entries are evicted, if needed)
+            s_cache.insert ( key , result ) ;
           } // ================================================================
           // ==================================================================
           return result ;
@@ -588,9 +598,9 @@ namespace Ostap
               limit        , reason     ,  file , line ) ;
           // ==================================================================
           { // look into the cache ============================================
-            CACHE::Lock lock { s_cache.mutex() } ;
-            auto it = s_cache->find  ( key ) ;
-            if ( s_cache->end() != it ) {  return it->second ; }  // AVOID calculation
+            Result cached {} ;
+            if ( s_cache.find ( key , cached ) ) 
+            { OSTAP_COUNT ( "Ostap::Math::Integrator::cached" ) ; return cached ; }  // AVOID calculation
             // ================================================================
           } // ================================================================
           // ==================================================================
@@ -608,11 +618,8 @@ namespace Ostap
                                            line       ) ;
           // ==================================================================
           { // update the cache ===============================================
-            CACHE::Lock lock  { s_cache.mutex() } ;
-            // clear the cache is too large
-            if ( s_CACHESIZE < s_cache->size() ) { s_cache->clear() ; }
-            // update the cache
-            s_cache->insert ( std::make_pair ( key , result ) ) ;
+            // update the cache (the unused entries are evicted, if needed)
+            s_cache.insert ( key , result ) ;
           } // ================================================================
           // ==================================================================
           return result ;
@@ -643,9 +650,9 @@ namespace Ostap
               limit        , reason     ,  file , line ) ;
           // ==================================================================
           { // look into the cache ============================================
-            CACHE::Lock lock { s_cache.mutex() } ;
-            auto it = s_cache->find  ( key ) ;
-            if ( s_cache->end() != it ) {  return it->second ; }  // AVOID calculation
+            Result cached {} ;
+            if ( s_cache.find ( key , cached ) ) 
+            { OSTAP_COUNT ( "Ostap::Math::Integrator::cached" ) ; return cached ; }  // AVOID calculation
             // ================================================================
           } // ================================================================
           // ==================================================================
@@ -663,11 +670,8 @@ namespace Ostap
                                            line       ) ;
           // ==================================================================
           { // update the cache ===============================================
-            CACHE::Lock lock  { s_cache.mutex() } ;
-            // clear the cache is too large
-            if ( s_CACHESIZE < s_cache->size() ) { s_cache->clear() ; }
-            // update the cache
-            s_cache->insert ( std::make_pair ( key , result ) ) ;
+            // update the cache (the unused entries are evicted, if needed)
+            s_cache.insert ( key , result ) ;
           } // ================================================================
           // ==================================================================
           return result ;
@@ -683,23 +687,133 @@ namespace Ostap
           return (*f) ( x ) ;
         }
         // ====================================================================
+      private: // the fast path 
+        // ====================================================================
+        /// apply the fixed Gauss-Kronrod rule to the interval 
+        static void apply_rule 
+        ( const gsl_function* func   , 
+          const double        xlow   , 
+          const double        xhigh  , 
+          const int           rule   ,
+          double&             result , 
+          double&             error  ) 
+        {
+          double resabs = 0 ;
+          double resasc = 0 ;
+          switch ( rule ) 
+          {
+          case GSL_INTEG_GAUSS15 : 
+            gsl_integration_qk15 ( func , xlow , xhigh , &result , &error , &resabs , &resasc ) ; break ;
+          case GSL_INTEG_GAUSS31 : 
+            gsl_integration_qk31 ( func , xlow , xhigh , &result , &error , &resabs , &resasc ) ; break ;
+          case GSL_INTEG_GAUSS41 : 
+            gsl_integration_qk41 ( func , xlow , xhigh , &result , &error , &resabs , &resasc ) ; break ;
+          case GSL_INTEG_GAUSS51 : 
+            gsl_integration_qk51 ( func , xlow , xhigh , &result , &error , &resabs , &resasc ) ; break ;
+          case GSL_INTEG_GAUSS61 : 
+            gsl_integration_qk61 ( func , xlow , xhigh , &result , &error , &resabs , &resasc ) ; break ;
+          default : 
+            gsl_integration_qk21 ( func , xlow , xhigh , &result , &error , &resabs , &resasc ) ; break ;
+          }
+        }
+        // ====================================================================
+        /// is the result good enough? 
+        static inline bool good 
+        ( const double result     , 
+          const double error      , 
+          const double aprecision , 
+          const double rprecision ) 
+        {
+          return std::isfinite ( result ) && std::isfinite ( error ) && 
+            error <= std::max ( aprecision , rprecision * std::abs ( result ) ) ;
+        }
+        // ====================================================================
+        /** the fast non-adaptive integration: 
+         *  - the single 21-point Gauss-Kronrod rule 
+         *  - the fixed rule applied to the learned subdivisions 
+         *  @return true if the result satisfies the requested precision 
+         */
+        bool fast_integrate 
+        ( const gsl_function* func       , 
+          const double        xlow       , 
+          const double        xhigh      , 
+          const double        aprecision , 
+          const double        rprecision , 
+          const int           rule       , 
+          Result&             quick      ) const 
+        {
+          // (1) the single 21-point rule 
+          double result = 0 ;
+          double error  = 0 ;
+          double resabs = 0 ;
+          double resasc = 0 ;
+          gsl_integration_qk21 ( func , xlow , xhigh , &result , &error , &resabs , &resasc ) ;
+          // all nodes are at zero or the estimate is unreliable: go to adaptive integration 
+          if ( 0 < resabs && error != resasc && good ( result , error , aprecision , rprecision ) ) 
+          {
+            OSTAP_COUNT ( "Ostap::Math::Integrator::fast" ) ;
+            quick = Result { GSL_SUCCESS , result , error } ;
+            return true ;                                             // RETURN 
+          }
+          // (2) the learned subdivisions 
+          std::vector<double> edges {} ;
+          if ( !s_splits.find ( std::hash_combine ( xlow , xhigh , rule ) , edges ) ) { return false ; }
+          //
+          double sum  = 0 ;
+          double esum = 0 ;
+          for ( std::size_t i = 0 ; i + 1 < edges.size () ; ++i ) 
+          {
+            apply_rule ( func , edges [ i ] , edges [ i + 1 ] , rule , result , error ) ;
+            sum  += result ;
+            esum += error  ;
+          }
+          if ( !good ( sum , esum , aprecision , rprecision ) ) { return false ; }
+          //
+          OSTAP_COUNT ( "Ostap::Math::Integrator::learned" ) ;
+          quick = Result { GSL_SUCCESS , sum , esum } ;
+          return true ;
+        }
+        // ====================================================================
+        /// remember the subdivisions of the adaptive integration  
+        void learn 
+        ( const double                     xlow      , 
+          const double                     xhigh     , 
+          const int                        rule      , 
+          const gsl_integration_workspace* workspace ) const 
+        {
+          const std::size_t n = workspace->size ;
+          if ( 0 == n ) { return ; }
+          std::vector<double> edges ( workspace->alist , workspace->alist + n ) ;
+          if ( xlow < xhigh ) { std::sort ( edges.begin () , edges.end () ) ; }
+          else { std::sort ( edges.begin () , edges.end () , std::greater<double> () ) ; }
+          edges.push_back ( xhigh ) ;
+          s_splits.insert ( std::hash_combine ( xlow , xhigh , rule ) , edges ) ;
+        }
+        // ====================================================================
       private:
         // ====================================================================
-        typedef std::map<std::size_t,Result>  MAP   ;
-        typedef SyncedCache<MAP>              CACHE ;
+        typedef Ostap::Utils::ShardedCache<std::size_t,Result> CACHE ;
         /// the actual integration cache 
         static CACHE              s_cache     ; // integration cache 
         /// integration cache size 
         static const unsigned int s_CACHESIZE ; // cache size 
         // ====================================================================
+        typedef Ostap::Utils::ShardedCache<std::size_t,std::vector<double> > SPLITS ;
+        /// the learned subdivisions for the given range 
+        static SPLITS             s_splits    ; // learned subdivisions 
+        // ====================================================================
       };  
       // ======================================================================
       template <class FUNCTION>
+      const unsigned int Integrator1D<FUNCTION>::s_CACHESIZE = 50000 ;
+      // ======================================================================
+      template <class FUNCTION>
       typename Integrator1D<FUNCTION>::CACHE 
-      Integrator1D<FUNCTION>::s_cache = Integrator1D<FUNCTION>::CACHE{} ;
+      Integrator1D<FUNCTION>::s_cache { Integrator1D<FUNCTION>::s_CACHESIZE } ;
       // ======================================================================
       template <class FUNCTION>
-      const unsigned int Integrator1D<FUNCTION>::s_CACHESIZE = 50000 ;
+      typename Integrator1D<FUNCTION>::SPLITS 
+      Integrator1D<FUNCTION>::s_splits { 1000 } ;
       // ======================================================================
     } //                                  The end of namespace Ostap::Math::GSL
     // ========================================================================
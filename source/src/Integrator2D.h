@@ -7,14 +7,19 @@
 // STD&STL
 // ============================================================================
 #include <map>
+#include <vector>
+#include <thread>
+#include <exception>
+#include <type_traits>
 // ============================================================================
 // Local 
 // ============================================================================
 #include "Integrator1D.h"     // GSL-integrator 
 #include "cubature.h"         // cubature 
-#include "syncedcache.h"      // the cache 
+#include "shardedcache.h"     // the cache 
 #include "local_hash.h"       // hash_combine 
 #include "local_gsl.h"        // hash_combine 
+#include "local_mt.h"         // nThreads 
 // ============================================================================
 namespace Ostap
 {
@@ -24,6 +29,30 @@ namespace Ostap
     // ========================================================================
     namespace GSL 
     {
+      // ======================================================================
+      /** @struct has_array_evaluate2 
+       *  Does the function provide the (thread-safe) array evaluation 
+       *  @code
+       *  void evaluate ( std::size_t n , const double* x , const double* y , double* result ) const ;
+       *  @endcode
+       *  @see Ostap::Math::Bernstein2D::evaluate 
+       *  @see Ostap::Math::Positive2D::evaluate 
+       */
+      template <class FUNCTION>
+      struct has_array_evaluate2 
+      {
+      private:
+        template <class F>
+        static auto check ( const F* f ) -> decltype 
+          ( f->evaluate ( std::size_t ( 0 )           , 
+                          static_cast<const double*> ( nullptr ) , 
+                          static_cast<const double*> ( nullptr ) , 
+                          static_cast<double*>       ( nullptr ) ) , std::true_type () ) ;
+        template <class F>
+        static std::false_type check ( ... ) ;
+      public:
+        static const bool value = decltype ( check<FUNCTION> ( nullptr ) )::value ;
+      } ;
       // ======================================================================
       /** @class Integrator2D  Integrator2D.h 
        *  Helper class to simplify operations with integration of 2D-functions 
@@ -38,10 +67,11 @@ namespace Ostap
         // ====================================================================
         struct Fun 
         {
-          integrand  fun     ;
-          void*      fdata   ;
-          double     min [2] ;
-          double     max [2] ;
+          integrand   fun     ;
+          integrand_v fun_v   ; // vectorized (batched) integrand 
+          void*       fdata   ;
+          double      min [2] ;
+          double      max [2] ;
         } ;  
         // ====================================================================
         Fun make_function ( const FUNCTION* f                     , 
@@ -50,7 +80,8 @@ namespace Ostap
         {
           Fun F ;
           F.fdata   = const_cast<FUNCTION*>( f ) ;
-          F.fun     = &adapter2d ;
+          F.fun     = &adapter2d   ;
+          F.fun_v   = &adapter2d_v ;
           F.min [0] = xmin ;
           F.min [1] = ymin ;
           F.max [0] = xmax ;
@@ -79,10 +110,12 @@ namespace Ostap
                                               file       , 
                                               line       ) ; }
           //
+          OSTAP_PROBE ( "Ostap::Math::Integrator2D::computed" ) ;
           double result =  1 ;        
           double error  = -1 ;
-          const int ierror = hcubature 
-            ( 1 , fun -> fun   , fun->fdata , // f-dimension, function  & data 
+          // the points from many regions are evaluated in one batch 
+          const int ierror = hcubature_v 
+            ( 1 , fun -> fun_v , fun->fdata , // f-dimension, function  & data 
               2 , fun -> min   , fun->max   , // dimension and integration range 
               maxcalls         ,              // maximal number of  function calls 
               aprecision       ,              // absolute precision 
@@ -112,9 +145,9 @@ namespace Ostap
               reason      , file        , line        ) ;
           // ==================================================================
           { // look into the cache ============================================
-            CACHE::Lock lock { s_cache.mutex() } ;
-            auto it = s_cache->find ( key ) ;
-            if ( s_cache->end() != it ) {  return it->second ; }  // AVOID calculation
+            Result cached {} ;
+            if ( s_cache.find ( key , cached ) ) 
+            { OSTAP_COUNT ( "Ostap::Math::Integrator2D::cached" ) ; return cached ; }  // AVOID calculation
             // ================================================================
           } // ================================================================
           // ==================================================================
@@ -124,11 +157,8 @@ namespace Ostap
                                      reason   , file       , line        ) ;
           // ==================================================================
           { // update the cache ===============================================
-            CACHE::Lock lock  { s_cache.mutex() } ;
-            // clear the cache if too large
-            if ( s_CACHESIZE < s_cache->size() ) { s_cache->clear() ; }
-            // update the cache
-            auto r = s_cache->insert ( std::make_pair ( key , result ) ) ;
+            // update the cache (the unused entries are evicted, if needed)
+            s_cache.insert ( key , result ) ;
           } // ================================================================
           // ==================================================================
           return result ;
@@ -155,10 +185,105 @@ namespace Ostap
           return 0 ;
         }
         // ====================================================================
+        /** the actual vectorized adapter for cubature 
+         *  - for the functions with array evaluation the points are 
+         *    passed as contiguous x/y-arrays, and large batches are 
+         *    split between the threads 
+         *  - otherwise the function is evaluated point-by-point 
+         *  @see has_array_evaluate2
+         */
+        static int adapter2d_v 
+        ( unsigned      ndim  , 
+          std::size_t   npt   , 
+          const double* x     , 
+          void*         fdata ,
+          unsigned      fdim  , 
+          double*       fval  )   
+        {
+          if ( 1       != fdim  || 
+               2       != ndim  || 
+               nullptr == x     || 
+               nullptr == fdata || 
+               nullptr == fval  ) { return 1 ; }
+          const FUNCTION* f = (FUNCTION*) fdata  ; 
+          evaluate_ ( f , npt , x , fval , 
+                      std::integral_constant<bool,has_array_evaluate2<FUNCTION>::value> () ) ;
+          return 0 ;
+        }
+        // ====================================================================
       private:
         // ====================================================================
-        typedef std::map<std::size_t,Result>  MAP   ;
-        typedef SyncedCache<MAP>              CACHE ;
+        /// point-by-point evaluation 
+        static void evaluate_ 
+        ( const FUNCTION*   f    , 
+          const std::size_t npt  , 
+          const double*     x    , 
+          double*           fval , 
+          std::false_type        ) 
+        {
+          for ( std::size_t i = 0 ; i < npt ; ++i ) 
+          { fval [ i ] = (*f) ( x [ 2 * i ] , x [ 2 * i + 1 ] ) ; }
+        }
+        // ====================================================================
+        /// array evaluation for the contiguous chunk of points 
+        static void chunk_ 
+        ( const FUNCTION*   f    , 
+          const std::size_t npt  , 
+          const double*     x    , 
+          double*           fval ) 
+        {
+          std::vector<double> xs ( npt ) ;
+          std::vector<double> ys ( npt ) ;
+          for ( std::size_t i = 0 ; i < npt ; ++i ) 
+          {
+            xs [ i ] = x [ 2 * i     ] ;
+            ys [ i ] = x [ 2 * i + 1 ] ;
+          }
+          f->evaluate ( npt , xs.data () , ys.data () , fval ) ;
+        }
+        // ====================================================================
+        /// array evaluation, large batches are split between the threads 
+        static void evaluate_ 
+        ( const FUNCTION*   f    , 
+          const std::size_t npt  , 
+          const double*     x    , 
+          double*           fval , 
+          std::true_type         ) 
+        {
+          const std::size_t nmax = npt / s_MINBATCH ;
+          const std::size_t nt   = std::min<std::size_t> 
+            ( nmax , Ostap::Utils::nThreads () ) ;
+          if ( nt <= 1 ) { return chunk_ ( f , npt , x , fval ) ; }
+          //
+          const std::size_t  size = ( npt + nt - 1 ) / nt ;
+          std::vector<std::thread>        threads ;
+          std::vector<std::exception_ptr> errors ( nt ) ;
+          threads.reserve ( nt ) ;
+          for ( std::size_t t = 1 ; t < nt ; ++t ) 
+          {
+            const std::size_t first = std::min ( npt , t * size     ) ;
+            const std::size_t last  = std::min ( npt , first + size ) ;
+            if ( last <= first ) { break ; }
+            threads.emplace_back ( [f,first,last,x,fval,t,&errors] () 
+                                   {
+                                     try { chunk_ ( f , last - first , x + 2 * first , fval + first ) ; }
+                                     catch ( ... ) { errors [ t ] = std::current_exception () ; }
+                                   } ) ;
+          }
+          // the first chunk is processed by this thread 
+          try { chunk_ ( f , std::min ( npt , size ) , x , fval ) ; }
+          catch ( ... ) { errors [ 0 ] = std::current_exception () ; }
+          //
+          for ( auto& t : threads ) { t.join () ; }
+          for ( const auto& e : errors ) { if ( e ) { std::rethrow_exception ( e ) ; } }
+        }
+        // ====================================================================
+      private:
+        // ====================================================================
+        /// minimal number of points per thread 
+        static const std::size_t  s_MINBATCH  = 4096 ;
+        // ====================================================================
+        typedef Ostap::Utils::ShardedCache<std::size_t,Result> CACHE ;
         /// the actual integration cache 
         static CACHE              s_cache     ; // integration cache 
         static const unsigned int s_CACHESIZE ; // cache size 
@@ -166,11 +291,11 @@ namespace Ostap
       };  
       // ======================================================================
       template <class FUNCTION>
-      typename Integrator2D<FUNCTION>::CACHE 
-      Integrator2D<FUNCTION>::s_cache = Integrator2D<FUNCTION>::CACHE{} ;
+      const unsigned int Integrator2D<FUNCTION>::s_CACHESIZE = 50000 ;
       // ======================================================================
       template <class FUNCTION>
-      const unsigned int Integrator2D<FUNCTION>::s_CACHESIZE = 50000 ;
+      typename Integrator2D<FUNCTION>::CACHE 
+      Integrator2D<FUNCTION>::s_cache { Integrator2D<FUNCTION>::s_CACHESIZE } ;
       // ======================================================================
     } //                                  The end of namespace Ostap::Math::GSL 
     // ========================================================================
@@ -4,6 +4,7 @@
 // STD/STL
 // ===========================================================================
 #include <algorithm>
+#include <cmath>
 // ===========================================================================
 // Ostap
 // ===========================================================================
@@ -34,6 +35,147 @@ namespace
   /// "numerically equal" 
   const Ostap::Math::Equal_To<double> s_num_equal {} ;
   // ==========================================================================
+  /** barycentric interpolation for the array of points 
+   *  \f[ F(x) = \frac{ \sum_i \frac{w_i}{x-x_i} y_i}
+   *                    { \sum_i \frac{w_i}{x-x_i} } \f]
+   *  - the closest abscissas are located via Abscissas::index, 
+   *    and the tabulated value is used for the exact hit 
+   *  - the loop over abscissas has no branches, and it is split 
+   *    into four independent accumulators (vectorization/pipelining)
+   *  @param a      (INPUT)  abscissas 
+   *  @param y      (INPUT)  values 
+   *  @param w      (INPUT)  barycentric weights 
+   *  @param n      (INPUT)  number of points 
+   *  @param x      (INPUT)  array of points 
+   *  @param result (UPDATE) array of results 
+   */
+  inline void _barycentric_
+  ( const Ostap::Math::Interpolation::Abscissas&       a      , 
+    const Ostap::Math::Interpolation::Abscissas::Data& y      , 
+    const Ostap::Math::Interpolation::Abscissas::Data& w      , 
+    const std::size_t                                  n      , 
+    const double*                                      x      , 
+    double*                                            result ) 
+  {
+    const unsigned int N = a.size () ;
+    if ( 0 == N ) { std::fill ( result , result + n , 0.0 ) ; return ; }
+    //
+    const double* xs = a.x () .data () ;
+    const double* ys = y      .data () ;
+    const double* ws = w      .data () ;
+    const unsigned int N4 = N - N % 4 ;
+    //
+    for ( std::size_t k = 0 ; k < n ; ++k ) 
+    {
+      const double xk = x [ k ] ;
+      //
+      const unsigned int j = a.index ( xk ) ;
+      if (                s_equal ( xk , xs [ j     ] ) ) { result [ k ] = ys [ j     ] ; continue ; }
+      if ( j + 1 < N && s_equal ( xk , xs [ j + 1 ] ) ) { result [ k ] = ys [ j + 1 ] ; continue ; }
+      //
+      double s1 [ 4 ] = { 0 , 0 , 0 , 0 } ;
+      double s2 [ 4 ] = { 0 , 0 , 0 , 0 } ;
+      for ( unsigned int i = 0 ; i < N4 ; i += 4 ) 
+      {
+        for ( unsigned short l = 0 ; l < 4 ; ++l ) 
+        {
+          const double wi = ws [ i + l ] / ( xk - xs [ i + l ] ) ;
+          s1 [ l ] += wi * ys [ i + l ] ;
+          s2 [ l ] += wi ;
+        }
+      }
+      for ( unsigned int i = N4 ; i < N ; ++i ) 
+      {
+        const double wi = ws [ i ] / ( xk - xs [ i ] ) ;
+        s1 [ 0 ] += wi * ys [ i ] ;
+        s2 [ 0 ] += wi ;
+      }
+      //
+      result [ k ] = ( ( s1 [ 0 ] + s1 [ 1 ] ) + ( s1 [ 2 ] + s1 [ 3 ] ) ) / 
+        (              ( s2 [ 0 ] + s2 [ 1 ] ) + ( s2 [ 2 ] + s2 [ 3 ] ) ) ;
+    }
+  }
+  // ==========================================================================
+  /** calculate the barycentric weights for the given abscissas 
+   *  - O(n) for <code>Uniform</code>, <code>Chebyshev</code> and 
+   *    <code>Chebyshev2</code> abscissas 
+   *  - O(n^2) for the generic case 
+   *  @param a       (INPUT)  abscissas 
+   *  @param weights (OUTPUT) barycentric weights 
+   */
+  void _barycentric_weights_
+  ( const Ostap::Math::Interpolation::Abscissas& a       , 
+    Ostap::Math::Interpolation::Abscissas::Data& weights ) 
+  {
+    /// (1) resize container of weigths 
+    weights.resize ( a.size() ) ;
+    //
+    const unsigned int N = a.size() ;
+    //
+    switch ( a.atype() ) 
+    {
+      // ======================================================================
+    case Ostap::Math::Interpolation::Abscissas::Uniform : 
+      // ======================================================================
+      {
+        for ( unsigned int i = 0 ; i < N ; ++ i ) 
+        { weights [i] = ( i % 2 ? 1 : -1 ) * Ostap::Math::choose_double ( N - 1 , i ) ; }
+        //
+        return ;  // RETURN 
+      }
+      // ======================================================================
+    case Ostap::Math::Interpolation::Abscissas::Chebyshev1 : 
+      // ======================================================================
+      {
+        for ( unsigned int i = 0 ; i < N ; ++ i ) 
+        {
+          const long double aa = 1.0L * ( 2 * ( N - i ) - 1 ) * M_PIl / ( 2 * N ) ;
+          const long double x  = std::sin ( aa ) ;
+          weights [i] = ( i % 2 ? 1 : -1 ) * x ;
+        }
+        //
+        return ;  // RETURN 
+      }
+      // ======================================================================
+    case Ostap::Math::Interpolation::Abscissas::Chebyshev2 : 
+      // ======================================================================    
+      {
+        for ( unsigned int i = 0 ; i < N ; ++ i ) 
+        { weights [i] = ( i % 2 ? 1 : -1 ) ; }
+        if ( 2 <= weights.size () ) 
+        {
+          weights.front () *= 0.5 ;
+          weights.back  () *= 0.5 ;
+        }
+        //
+        return ;  // RETURN 
+      }  
+      // ======================================================================
+    default :
+      break ;
+    }
+    // ========================================================================
+    // Generic case 
+    // ========================================================================
+    for   ( unsigned short i = 0 ;  i < N ; ++i ) 
+    {
+      //
+      const long double xi  = a.x ( i ) ;
+      //
+      long double ww = 1 ;
+      for  ( unsigned short j = 0 ; j < N ; ++j  )
+      { 
+        if ( i != j ) 
+        { 
+          const long double xj  = a.x ( j ) ; 
+          ww *= ( xi - xj ) ; 
+        } 
+      }
+      //   
+      weights [ i ] = 1 / ww ; 
+    }
+  }
+  // ==========================================================================
 }
 // ============================================================================
 /*  create the abscissas from vector of abscissas 
@@ -83,6 +225,40 @@ Ostap::Math::Interpolation::Abscissas::slice
     Abscissas () ;
 }
 // ============================================================================
+/* get the index of the interval  x_i <= x < x_{i+1}
+ *  - O(1) for Uniform, Chebyshev and Chebyshev2 abscissas 
+ *  - O(log n) for the generic case 
+ */
+// ============================================================================
+unsigned int Ostap::Math::Interpolation::Abscissas::index 
+( const double x ) const 
+{
+  const unsigned int N = m_x.size () ;
+  if ( N < 2 || x <= m_x.front () ) { return 0     ; }
+  if ( m_x.back () <= x           ) { return N - 2 ; }
+  //
+  // position inside the interval, -1<t<1 
+  const double t = std::max ( -1.0 , std::min 
+                              ( 1.0 , ( 2 * x - m_xmin - m_xmax ) / ( m_xmax - m_xmin ) ) ) ;
+  //
+  double jj = 0 ;
+  switch ( m_atype ) 
+  {
+  case Uniform    : jj = 0.5 * ( t + 1 ) * ( N - 1 )             ; break ;
+  case Chebyshev1 : jj = std::acos ( -t ) * N / M_PI - 0.5       ; break ;
+  case Chebyshev2 : jj = std::acos ( -t ) * ( N - 1 ) / M_PI     ; break ;
+  default         : 
+    jj = ( std::upper_bound ( m_x.begin () , m_x.end () , x ) - m_x.begin () ) - 1.0 ; 
+  }
+  //
+  int j = std::max ( 0 , std::min ( int ( N ) - 2 , int ( std::floor ( jj ) ) ) ) ;
+  // adjust it for the rounding errors 
+  while ( 0 < j             && x < m_x [ j ]      ) { --j ; }
+  while ( j + 2 < int ( N ) && m_x [ j + 1 ] <= x ) { ++j ; }
+  //
+  return j ;
+}
+// ============================================================================
 /* special constructor for the given interpoaltion type 
  * @param n    number of interpolation points 
      * @param low  low edge of the interval 
@@ -538,6 +714,72 @@ Ostap::Math::Berrut2nd::Berrut2nd
 ( Ostap::Math::Interpolation::Table&& p ) 
   : Ostap::Math::Interpolation::Table ( std::move ( p ) ) 
 {}
+// ============================================================================
+/*  evaluate the interpolant for the array of points 
+ *  - Neville's polynomial is evaluated in the barycentric form 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of points 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::Neville::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  Interpolation::Abscissas::Data weights ;
+  _barycentric_weights_ ( abscissas () , weights ) ;
+  _barycentric_ ( abscissas () , values () , weights , n , x , result ) ;
+}
+// ============================================================================
+/*  evaluate the interpolant for the array of points 
+ *  - Lagrange polynomial is evaluated in the barycentric form 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of points 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::Lagrange::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  Interpolation::Abscissas::Data weights ;
+  _barycentric_weights_ ( abscissas () , weights ) ;
+  _barycentric_ ( abscissas () , values () , weights , n , x , result ) ;
+}
+// ============================================================================
+/*  evaluate the interpolant for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of points 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::Berrut1st::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  Interpolation::Abscissas::Data weights ( size () ) ;
+  for ( unsigned int i = 0 ; i < weights.size () ; ++i ) { weights [ i ] = weight ( i ) ; }
+  _barycentric_ ( abscissas () , values () , weights , n , x , result ) ;
+}
+// ============================================================================
+/*  evaluate the interpolant for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of points 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::Berrut2nd::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  Interpolation::Abscissas::Data weights ( size () ) ;
+  for ( unsigned int i = 0 ; i < weights.size () ; ++i ) { weights [ i ] = weight ( i ) ; }
+  _barycentric_ ( abscissas () , values () , weights , n , x , result ) ;
+}
 
 
 
@@ -634,6 +876,18 @@ double Ostap::Math::FloaterHormann::evaluate
   }
   return s1 / s2 ;
 }
+// ============================================================================
+/*  evaluate the interpolant for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of points 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::FloaterHormann::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{ _barycentric_ ( abscissas () , values () , m_weights , n , x , result ) ; }
 
 
   
@@ -702,6 +956,32 @@ double Ostap::Math::Newton::evaluate ( const double x ) const
   return result ;  
 }
 // ============================================================================
+/*  evaluate the interpolant for the array of points 
+ *  - the nested (Horner-like) form is used 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of points 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::Newton::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const unsigned int N  = m_diffs.size () ;
+  if ( 0 == N ) { std::fill ( result , result + n , 0.0 ) ; return ; }
+  //
+  const double*      xs = abscissas ().x ().data () ;
+  const double*      ds = m_diffs.data () ;
+  for ( std::size_t k = 0 ; k < n ; ++k ) 
+  {
+    const double xk = x [ k ] ;
+    double       r  = ds [ N - 1 ] ;
+    for ( unsigned int i = N - 1 ; 0 < i ; --i ) { r = r * ( xk - xs [ i - 1 ] ) + ds [ i - 1 ] ; }
+    result [ k ] = r ;
+  }
+}
+// ============================================================================
 
 
 // ============================================================================
@@ -726,75 +1006,7 @@ Ostap::Math::Barycentric::Barycentric
 // calculate weigthts for the Barycentric interpolant 
 // ============================================================================
 void Ostap::Math::Barycentric::get_weights() 
-{
-  /// (1) resize container of weigths 
-  m_weights.resize ( size() ) ;
-  //
-  const unsigned int N = size() ;
-  //
-  switch ( atype() ) 
-  {
-    // ========================================================================
-  case Ostap::Math::Interpolation::Abscissas::Uniform : 
-    // ========================================================================
-    {
-      for ( unsigned int i = 0 ; i < N ; ++ i ) 
-      { m_weights [i] = ( i % 2 ? 1 : -1 ) * Ostap::Math::choose_double ( N - 1 , i ) ; }
-      //
-      return ;  // RETURN 
-    }
-    // ========================================================================
-  case Ostap::Math::Interpolation::Abscissas::Chebyshev1 : 
-    // ========================================================================
-    {
-      for ( unsigned int i = 0 ; i < N ; ++ i ) 
-      {
-        const long double a = 1.0L * ( 2 * ( N - i ) - 1 ) * M_PIl / ( 2 * N ) ;
-        const long double x = std::sin ( a ) ;
-        m_weights [i] = ( i % 2 ? 1 : -1 ) * x ;
-      }
-      //
-      return ;  // RETURN 
-    }
-    // ========================================================================
-  case Ostap::Math::Interpolation::Abscissas::Chebyshev2 : 
-    // ========================================================================    
-    {
-      for ( unsigned int i = 0 ; i < N ; ++ i ) 
-      { m_weights [i] = ( i % 2 ? 1 : -1 ) ; }
-      if ( 2 <= m_weights.size () ) 
-      {
-        m_weights.front () *= 0.5 ;
-        m_weights.back  () *= 0.5 ;
-      }
-      //
-      return ;  // RETURN 
-    }  
-    // ======================================================================
-  default :
-    break ;
-  }
-  // ========================================================================
-  // Generic case 
-  // ========================================================================
-  for   ( unsigned short i = 0 ;  i < N ; ++i ) 
-  {
-    //
-    const long double xi  = x ( i ) ;
-    //
-    long double ww = 1 ;
-    for  ( unsigned short j = 0 ; j < N ; ++j  )
-    { 
-      if ( i != j ) 
-      { 
-        const long double xj  = x( j ) ; 
-        ww *= ( xi - xj ) ; 
-      } 
-    }
-    //   
-    m_weights [ i ] = 1 / ww ; 
-  }
-}
+{ _barycentric_weights_ ( abscissas () , m_weights ) ; }
 // ============================================================================
 // the main method: get the value of Floater-Hormann interpolant 
 // ============================================================================
@@ -821,6 +1033,18 @@ double Ostap::Math::Barycentric::evaluate
   }
   return s1 / s2 ;
 }
+// ============================================================================
+/*  evaluate the interpolant for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of points 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::Barycentric::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{ _barycentric_ ( abscissas () , values () , m_weights , n , x , result ) ; }
 
 
 
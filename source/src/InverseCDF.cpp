@@ -0,0 +1,286 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <atomic>
+#include <numeric>
+#include <algorithm>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/InverseCDF.h"
+#include "Ostap/RandomStream.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+// ============================================================================
+/** @file
+ *  Implementation file for classes from Ostap/InverseCDF.h
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /** counter-based uniform random numbers in (0,1) for the given event:
+   *  they depend only on the seed and the event index
+   *  @see Ostap::Math::Philox
+   */
+  inline void uniforms
+  ( const std::uint64_t seed  ,
+    const std::uint64_t event ,
+    const unsigned int  n     , // at most 4
+    double*             u     )
+  {
+    const Ostap::Math::Philox::Key key { { std::uint32_t ( seed ) , std::uint32_t ( seed >> 32 ) } } ;
+    for ( unsigned int j = 0 ; j < n ; j += 2 )
+    {
+      const Ostap::Math::Philox::Counter c = Ostap::Math::Philox::block
+        ( Ostap::Math::Philox::Counter { { std::uint32_t ( event ) , std::uint32_t ( event >> 32 ) , j / 2 , 0 } } , key ) ;
+      u [ j     ] = ( ( ( std::uint64_t ( c [ 0 ] >> 5 ) << 26 ) | ( c [ 1 ] >> 6 ) ) + 0.5 ) * ( 1.0 / 9007199254740992.0 ) ;
+      u [ j + 1 ] = ( ( ( std::uint64_t ( c [ 2 ] >> 5 ) << 26 ) | ( c [ 3 ] >> 6 ) ) + 0.5 ) * ( 1.0 / 9007199254740992.0 ) ;
+    }
+  }
+  // ==========================================================================
+  /** run the loop over events in parallel
+   *  @param n        number of events
+   *  @param nthreads number of threads
+   *  @param fun      the action for the event
+   */
+  template <class ACTION>
+  void parallel_loop
+  ( const std::size_t  n        ,
+    const unsigned int nthreads ,
+    ACTION             action   )
+  {
+    const std::size_t  block = 4096 ;
+    const std::size_t  nb    = ( n + block - 1 ) / block ;
+    const unsigned int nt    = std::min<std::size_t>
+      ( nb , 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ;
+    if ( nt <= 1 )
+    {
+      for ( std::size_t i = 0 ; i < n ; ++i ) { action ( i ) ; }
+      return ;                                                    // RETURN
+    }
+    //
+    std::atomic<std::size_t> next { 0 } ;
+    Ostap::Utils::WorkerPool pool ( nt ) ;
+    pool.run ( [&] ( const unsigned int /* index */ )
+      {
+        for ( std::size_t b = next++ ; b < nb ; b = next++ )
+        {
+          const std::size_t last = std::min ( n , ( b + 1 ) * block ) ;
+          for ( std::size_t i = b * block ; i < last ; ++i ) { action ( i ) ; }
+        }
+      } ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor from the bin contents
+// ============================================================================
+Ostap::Math::InverseCDF::InverseCDF
+( const std::vector<double>& bins ,
+  const double               xmin ,
+  const double               xmax )
+  : m_xmin ( std::min ( xmin , xmax ) )
+  , m_xmax ( std::max ( xmin , xmax ) )
+{
+  setup ( bins ) ;
+}
+// ============================================================================
+// build the cumulative distribution and the guide table
+// ============================================================================
+void Ostap::Math::InverseCDF::setup
+( const std::vector<double>& bins )
+{
+  Ostap::Assert ( m_xmin < m_xmax                   ,
+                  "Invalid range"                   ,
+                  "Ostap::Math::InverseCDF"         ) ;
+  Ostap::Assert ( !bins.empty ()                    ,
+                  "Empty bins"                      ,
+                  "Ostap::Math::InverseCDF"         ) ;
+  //
+  const std::size_t N = bins.size () ;
+  m_cdf.assign ( N + 1 , 0.0 ) ;
+  for ( std::size_t k = 0 ; k < N ; ++k )
+  {
+    const double b = bins [ k ] ;
+    m_cdf [ k + 1 ] = m_cdf [ k ] + ( std::isfinite ( b ) && 0 < b ? b : 0.0 ) ;
+  }
+  const double total = m_cdf.back () ;
+  Ostap::Assert ( 0 < total                         ,
+                  "Non-positive distribution"       ,
+                  "Ostap::Math::InverseCDF"         ) ;
+  for ( std::size_t k = 1 ; k < N ; ++k ) { m_cdf [ k ] /= total ; }
+  m_cdf [ N ] = 1 ;
+  //
+  // the guide table: the first bin k with cdf[k+1] > j/N
+  m_guide.assign ( N , 0 ) ;
+  std::size_t k = 0 ;
+  for ( std::size_t j = 0 ; j < N ; ++j )
+  {
+    const double p = double ( j ) / N ;
+    while ( k + 1 < N && m_cdf [ k + 1 ] <= p ) { ++k ; }
+    m_guide [ j ] = k ;
+  }
+}
+// ============================================================================
+// get the quantile for the given probability
+// ============================================================================
+double Ostap::Math::InverseCDF::quantile ( const double u ) const
+{
+  if      ( m_cdf.empty () ) { return m_xmin ; }
+  else if ( u <= 0         ) { return m_xmin ; }
+  else if ( u >= 1         ) { return m_xmax ; }
+  //
+  const std::size_t N = m_guide.size () ;
+  std::size_t       k = m_guide [ std::min<std::size_t> ( std::size_t ( u * N ) , N - 1 ) ] ;
+  while ( k + 1 < N && m_cdf [ k + 1 ] <= u ) { ++k ; }
+  //
+  const double dc = m_cdf [ k + 1 ] - m_cdf [ k ] ;
+  const double t  = 0 < dc ? ( u - m_cdf [ k ] ) / dc : 0.5 ;
+  return m_xmin + ( m_xmax - m_xmin ) * ( k + t ) / N ;
+}
+// ============================================================================
+// the tabulated cumulative distribution
+// ============================================================================
+double Ostap::Math::InverseCDF::cdf ( const double x ) const
+{
+  if      ( m_cdf.empty () || x <= m_xmin ) { return 0 ; }
+  else if ( x >= m_xmax                   ) { return 1 ; }
+  const std::size_t N = m_guide.size () ;
+  const double      s = ( x - m_xmin ) / ( m_xmax - m_xmin ) * N ;
+  const std::size_t k = std::min<std::size_t> ( std::size_t ( s ) , N - 1 ) ;
+  return m_cdf [ k ] + ( s - k ) * ( m_cdf [ k + 1 ] - m_cdf [ k ] ) ;
+}
+// ============================================================================
+// get quantiles for the array of probabilities
+// ============================================================================
+void Ostap::Math::InverseCDF::quantiles
+( const std::size_t n ,
+  const double*     u ,
+  double*           x ) const
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { x [ i ] = quantile ( u [ i ] ) ; } }
+// ============================================================================
+// generate the random numbers
+// ============================================================================
+void Ostap::Math::InverseCDF::generate
+( const std::size_t   n        ,
+  const std::uint64_t seed     ,
+  double*             out      ,
+  const unsigned int  nthreads ) const
+{
+  parallel_loop ( n , nthreads , [&] ( const std::size_t i )
+    {
+      double u [ 2 ] ;
+      uniforms ( seed , i , 2 , u ) ;
+      out [ i ] = quantile ( u [ 0 ] ) ;
+    } ) ;
+}
+// ============================================================================
+// generate the random numbers
+// ============================================================================
+std::vector<double>
+Ostap::Math::InverseCDF::generate
+( const std::size_t   n        ,
+  const std::uint64_t seed     ,
+  const unsigned int  nthreads ) const
+{
+  std::vector<double> result ( n , 0.0 ) ;
+  generate ( n , seed , result.data () , nthreads ) ;
+  return result ;
+}
+// ============================================================================
+// constructor from the weights: Vose's algorithm
+// ============================================================================
+Ostap::Math::AliasTable::AliasTable
+( const std::vector<double>& weights )
+  : m_prob  ( weights.size () , 0.0 )
+  , m_alias ( weights.size () , 0   )
+  , m_total ( 0 )
+{
+  const std::size_t N = weights.size () ;
+  Ostap::Assert ( 0 < N                             ,
+                  "Empty weights"                   ,
+                  "Ostap::Math::AliasTable"         ) ;
+  for ( const double w : weights )
+  { if ( std::isfinite ( w ) && 0 < w ) { m_total += w ; } }
+  Ostap::Assert ( 0 < m_total                       ,
+                  "Non-positive distribution"       ,
+                  "Ostap::Math::AliasTable"         ) ;
+  //
+  std::vector<double>      scaled ( N ) ;
+  std::vector<std::size_t> small  ; small.reserve ( N ) ;
+  std::vector<std::size_t> large  ; large.reserve ( N ) ;
+  for ( std::size_t i = 0 ; i < N ; ++i )
+  {
+    const double w = weights [ i ] ;
+    scaled [ i ] = ( std::isfinite ( w ) && 0 < w ? w : 0.0 ) * N / m_total ;
+    if ( scaled [ i ] < 1 ) { small.push_back ( i ) ; }
+    else                    { large.push_back ( i ) ; }
+  }
+  //
+  while ( !small.empty () && !large.empty () )
+  {
+    const std::size_t s = small.back () ; small.pop_back () ;
+    const std::size_t l = large.back () ;
+    m_prob  [ s ] = scaled [ s ] ;
+    m_alias [ s ] = l ;
+    scaled  [ l ] = ( scaled [ l ] + scaled [ s ] ) - 1 ;
+    if ( scaled [ l ] < 1 ) { large.pop_back () ; small.push_back ( l ) ; }
+  }
+  // the rest (up to rounding errors)
+  for ( const std::size_t l : large ) { m_prob [ l ] = 1 ; m_alias [ l ] = l ; }
+  for ( const std::size_t s : small ) { m_prob [ s ] = 1 ; m_alias [ s ] = s ; }
+}
+// ============================================================================
+// generate the random points
+// ============================================================================
+void Ostap::Math::GridGenerator::generate
+( const std::size_t   n        ,
+  const std::uint64_t seed     ,
+  double*             out      ,
+  const unsigned int  nthreads ) const
+{
+  Ostap::Assert ( 0 < m_table.size ()               ,
+                  "Generator is not initialized"    ,
+                  "Ostap::Math::GridGenerator"      ) ;
+  //
+  const unsigned int D = m_dim ;
+  parallel_loop ( n , nthreads , [&] ( const std::size_t i )
+    {
+      double u [ 4 ] ;
+      uniforms ( seed , i , 1 + D , u ) ;
+      std::size_t cell = m_table ( u [ 0 ] ) ;
+      // decode the cell index, the last axis runs fastest
+      for ( int d = D - 1 ; 0 <= d ; --d )
+      {
+        const unsigned int idx = cell % m_bins [ d ] ;
+        cell /= m_bins [ d ] ;
+        const double h = ( m_max [ d ] - m_min [ d ] ) / m_bins [ d ] ;
+        out [ d * n + i ] = m_min [ d ] + h * ( idx + u [ 1 + d ] ) ;
+      }
+    } ) ;
+}
+// ============================================================================
+// generate the random points
+// ============================================================================
+std::vector<double>
+Ostap::Math::GridGenerator::generate
+( const std::size_t   n        ,
+  const std::uint64_t seed     ,
+  const unsigned int  nthreads ) const
+{
+  std::vector<double> result ( m_dim * n , 0.0 ) ;
+  generate ( n , seed , result.data () , nthreads ) ;
+  return result ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,730 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <limits>
+#include <complex>
+#include <algorithm>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TAxis.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/KDE.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_fft.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Math::KDE
+ *  @see Ostap::Math::KDE
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_BINS      = 870 ,
+    INVALID_RANGE     = 871 ,
+    INVALID_BANDWIDTH = 872 ,
+    INVALID_DIMENSION = 873 ,
+    INVALID_DATA      = 874 ,
+    NOT_READY         = 875 ,
+  } ;
+  // ==========================================================================
+  /// the kernel is truncated at this number of bandwidths
+  const double         s_NSIGMA  = 5    ;
+  /// the limits for the local bandwidth factors of the adaptive estimator
+  const double         s_LAMBDA  = 5    ;
+  /// the ratio of the neighbouring bandwidth classes of the adaptive estimator
+  const double         s_RATIO   = 1.25 ;
+  /// the maximal number of the bandwidth classes of the adaptive estimator
+  const unsigned short s_NCLASS  = 24   ;
+  // ==========================================================================
+  /** @struct Weights
+   *  The weights of grid nodes along the axis:
+   *  the interpolation stencil or the integrals of the hat functions
+   */
+  struct Weights
+  {
+    std::size_t         first { 0 } ;
+    std::vector<double> w     {   } ;
+  } ;
+  // ==========================================================================
+  /// the stencil as weights
+  inline void _stencil_
+  ( const Ostap::Math::HistoAxisTable::Stencil& s ,
+    Weights&                                    w )
+  {
+    w.first = s.i [ 0 ] ;
+    w.w.assign ( s.w , s.w + s.n ) ;
+  }
+  // ==========================================================================
+  /** the integrals of the hat functions over [low,high]:
+   *  the linear interpolant between bin centres, constant in the outer half-bins
+   */
+  inline void _integral_
+  ( const unsigned int n    ,
+    const double       xmin ,
+    const double       xmax ,
+    const double       low  ,
+    const double       high ,
+    Weights&           w    )
+  {
+    w.first = 0 ;
+    w.w.assign ( n , 0.0 ) ;
+    //
+    const double dx = ( xmax - xmin ) / n ;
+    const double lo = ( std::max ( low  , xmin ) - xmin ) / dx - 0.5 ;
+    const double hi = ( std::min ( high , xmax ) - xmin ) / dx - 0.5 ;
+    if ( !( lo < hi ) ) { w.w.clear () ; return ; }                 // RETURN
+    //
+    // the outer half-bins
+    w.w [ 0     ] += dx * std::max ( 0.0 , std::min ( hi , 0.0     ) - lo ) ;
+    w.w [ n - 1 ] += dx * std::max ( 0.0 , hi - std::max ( lo , n - 1.0 ) ) ;
+    //
+    // the inner segments
+    const long k0 = std::max ( 0L , long ( std::floor ( lo ) ) ) ;
+    const long k1 = std::min ( long ( n ) - 2 , long ( std::floor ( hi ) ) ) ;
+    for ( long k = k0 ; k <= k1 ; ++k )
+    {
+      const double t0 = std::min ( 1.0 , std::max ( 0.0 , lo - k ) ) ;
+      const double t1 = std::min ( 1.0 , std::max ( 0.0 , hi - k ) ) ;
+      if ( !( t0 < t1 ) ) { continue ; }
+      const double q = 0.5 * ( t1 * t1 - t0 * t0 ) ;
+      w.w [ k     ] += dx * ( t1 - t0 - q ) ;
+      w.w [ k + 1 ] += dx * q ;
+    }
+  }
+  // ==========================================================================
+  /** the Fourier image of the (sampled, truncated and normalized)
+   *  gaussian kernel for the given bandwidth (in bins)
+   */
+  void _kernel_
+  ( const std::size_t                    L ,
+    const std::size_t                    P ,
+    const double                         s ,
+    std::vector<std::complex<double> >&  k )
+  {
+    k.assign ( L , 0.0 ) ;
+    double sum = 0 ;
+    for ( std::size_t m = 0 ; m <= P ; ++m )
+    {
+      const double g = 0 < s ? std::exp ( -0.5 * ( m * m ) / ( s * s ) ) : ( 0 == m ? 1.0 : 0.0 ) ;
+      k [ m ] = g ;
+      sum    += g ;
+      if ( 0 < m ) { k [ L - m ] = g ; sum += g ; }
+    }
+    for ( auto& v : k ) { v /= sum ; }
+    Ostap::Math::FFT::radix2 ( k , false ) ;
+  }
+  // ==========================================================================
+  /// fold the index back into [0,n) by the reflections at the boundaries
+  inline long _reflect_ ( long j , const long n )
+  {
+    while ( j < 0 || n <= j ) { j = j < 0 ? -1 - j : 2 * n - 1 - j ; }
+    return j ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// 1D-estimator
+// ============================================================================
+Ostap::Math::KDE::KDE
+( const unsigned int nx   ,
+  const double       xmin ,
+  const double       xmax )
+  : m_dim  ( 1 )
+  , m_n    { nx   }
+  , m_xmin { xmin }
+  , m_xmax { xmax }
+{
+  setup () ;
+}
+// ============================================================================
+// 2D-estimator
+// ============================================================================
+Ostap::Math::KDE::KDE
+( const unsigned int nx   ,
+  const double       xmin ,
+  const double       xmax ,
+  const unsigned int ny   ,
+  const double       ymin ,
+  const double       ymax )
+  : m_dim  ( 2 )
+  , m_n    { nx   , ny   }
+  , m_xmin { xmin , ymin }
+  , m_xmax { xmax , ymax }
+{
+  setup () ;
+}
+// ============================================================================
+// 3D-estimator
+// ============================================================================
+Ostap::Math::KDE::KDE
+( const unsigned int nx   ,
+  const double       xmin ,
+  const double       xmax ,
+  const unsigned int ny   ,
+  const double       ymin ,
+  const double       ymax ,
+  const unsigned int nz   ,
+  const double       zmin ,
+  const double       zmax )
+  : m_dim  ( 3 )
+  , m_n    { nx   , ny   , nz   }
+  , m_xmin { xmin , ymin , zmin }
+  , m_xmax { xmax , ymax , zmax }
+{
+  setup () ;
+}
+// ============================================================================
+// the common part of constructors
+// ============================================================================
+void Ostap::Math::KDE::setup ()
+{
+  std::size_t size = 1 ;
+  for ( unsigned short a = 0 ; a < m_dim ; ++a )
+  {
+    Ostap::Assert ( 2 <= m_n [ a ]                   ,
+                    "Invalid number of bins"         ,
+                    "Ostap::Math::KDE" , INVALID_BINS  ) ;
+    Ostap::Assert ( m_xmin [ a ] < m_xmax [ a ]      ,
+                    "Invalid range"                  ,
+                    "Ostap::Math::KDE" , INVALID_RANGE ) ;
+    const TAxis axis ( m_n [ a ] , m_xmin [ a ] , m_xmax [ a ] ) ;
+    m_axes.emplace_back ( axis , Ostap::Math::HistoInterpolation::Linear ) ;
+    size *= m_n [ a ] ;
+  }
+  m_h  .assign ( m_dim , 0.0 ) ;
+  m_cnt.assign ( m_dim , Ostap::WStatEntity () ) ;
+  m_counts.assign ( size , 0.0 ) ;
+}
+// ============================================================================
+// the effective number of entries inside the range
+// ============================================================================
+double Ostap::Math::KDE::nEff () const
+{ return 0 < m_sumw2 ? m_sumw * m_sumw / m_sumw2 : 0.0 ; }
+// ============================================================================
+/*  add the point (linear binning)
+ *  @param point the point, array of <code>dim()</code> coordinates
+ *  @param w     the weight
+ *  @return true if the point is inside the range
+ */
+// ============================================================================
+bool Ostap::Math::KDE::fill
+( const double* point ,
+  const double  w     )
+{
+  std::size_t index [ 3 ] = { 0 , 0 , 0 } ;
+  double      frac  [ 3 ] = { 0 , 0 , 0 } ;
+  std::size_t step  [ 3 ] = { 0 , 0 , 0 } ;
+  std::size_t stride      = 1 ;
+  for ( unsigned short a = 0 ; a < m_dim ; ++a )
+  {
+    const double x = point [ a ] ;
+    if ( !( m_xmin [ a ] <= x && x <= m_xmax [ a ] ) ) { return false ; } // RETURN
+    //
+    const unsigned int n = m_n [ a ] ;
+    const double       u = ( x - m_xmin [ a ] ) * n / ( m_xmax [ a ] - m_xmin [ a ] ) - 0.5 ;
+    const std::size_t  i = u <= 0 ? 0 : n - 1 <= u ? n - 2 : std::size_t ( u ) ;
+    index [ a ] = i ;
+    frac  [ a ] = std::min ( 1.0 , std::max ( 0.0 , u - i ) ) ;
+    step  [ a ] = stride ;
+    stride     *= n ;
+  }
+  //
+  // distribute the weight over the corners
+  std::size_t base = 0 ;
+  for ( unsigned short a = 0 ; a < m_dim ; ++a ) { base += index [ a ] * step [ a ] ; }
+  const unsigned short nc = 1 << m_dim ;
+  for ( unsigned short c = 0 ; c < nc ; ++c )
+  {
+    double      f = w    ;
+    std::size_t k = base ;
+    for ( unsigned short a = 0 ; a < m_dim ; ++a )
+    {
+      if ( c & ( 1 << a ) ) { f *= frac [ a ] ; k += step [ a ] ; }
+      else                  { f *= 1 - frac [ a ] ; }
+    }
+    if ( f ) { m_counts [ k ] += f ; }
+  }
+  //
+  for ( unsigned short a = 0 ; a < m_dim ; ++a ) { m_cnt [ a ].add ( point [ a ] , w ) ; }
+  m_sumw  += w     ;
+  m_sumw2 += w * w ;
+  m_ok     = false ;
+  return true ;
+}
+// ============================================================================
+/*  add the points (linear binning)
+ *  @param n  number of points
+ *  @param x  x-coordinates
+ *  @param y  y-coordinates (2D and 3D)
+ *  @param z  z-coordinates (3D)
+ *  @param w  the weights (null for unit weights)
+ *  @return number of points inside the range
+ */
+// ============================================================================
+std::size_t Ostap::Math::KDE::fill
+( const std::size_t n ,
+  const double*     x ,
+  const double*     y ,
+  const double*     z ,
+  const double*     w )
+{
+  Ostap::Assert ( ( 2 > m_dim || nullptr != y ) && ( 3 > m_dim || nullptr != z ) ,
+                  "Invalid number of coordinates" ,
+                  "Ostap::Math::KDE" , INVALID_DIMENSION ) ;
+  std::size_t filled = 0 ;
+  double point [ 3 ] = { 0 , 0 , 0 } ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    point [ 0 ] = x [ i ] ;
+    if ( 2 <= m_dim ) { point [ 1 ] = y [ i ] ; }
+    if ( 3 <= m_dim ) { point [ 2 ] = z [ i ] ; }
+    if ( fill ( point , nullptr == w ? 1.0 : w [ i ] ) ) { ++filled ; }
+  }
+  return filled ;
+}
+// ============================================================================
+/*  smooth the grid with the per-axis (relative) bandwidths
+ *  the gaussian product kernel is separable, therefore the grid
+ *  is convolved axis by axis; two lines are packed into one complex FFT
+ */
+// ============================================================================
+void Ostap::Math::KDE::smooth
+( std::vector<double>&       grid ,
+  const std::vector<double>& s    ) const
+{
+  std::vector<std::complex<double> > kernel ;
+  std::vector<std::complex<double> > buffer ;
+  std::vector<std::complex<double> > twf    ;
+  std::vector<std::complex<double> > twi    ;
+  std::vector<double>                out1   ;
+  std::vector<double>                out2   ;
+  //
+  const std::size_t size   = grid.size () ;
+  std::size_t       stride = 1 ;
+  for ( unsigned short a = 0 ; a < m_dim ; ++a )
+  {
+    const long        n = m_n [ a ] ;
+    const std::size_t P = std::size_t ( std::min ( std::ceil ( s_NSIGMA * s [ a ] ) , 4.0 * n ) ) ;
+    const std::size_t L = Ostap::Math::FFT::next_pow2 ( n + 2 * P ) ;
+    const long        H = n + ( L - n ) / 2 ; // split of the free zone
+    _kernel_ ( L , P , s [ a ] , kernel ) ;
+    Ostap::Math::FFT::twiddles ( L , false , twf ) ;
+    Ostap::Math::FFT::twiddles ( L , true  , twi ) ;
+    //
+    // all lines along the axis
+    std::vector<std::size_t> starts ;
+    starts.reserve ( size / n ) ;
+    for ( std::size_t k = 0 ; k < size ; ++k )
+    { if ( 0 == ( k / stride ) % n ) { starts.push_back ( k ) ; } }
+    //
+    out1.resize ( n ) ;
+    out2.resize ( n ) ;
+    for ( std::size_t l = 0 ; l < starts.size () ; l += 2 )
+    {
+      const std::size_t s1   = starts [ l ] ;
+      const bool        pair = l + 1 < starts.size () ;
+      const std::size_t s2   = pair ? starts [ l + 1 ] : s1 ;
+      //
+      buffer.assign ( L , 0.0 ) ;
+      bool empty = true ;
+      for ( long j = 0 ; j < n ; ++j )
+      {
+        const double v1 = grid [ s1 + j * stride ] ;
+        const double v2 = pair ? grid [ s2 + j * stride ] : 0.0 ;
+        buffer [ P + j ] = std::complex<double> ( v1 , v2 ) ;
+        if ( v1 || v2 ) { empty = false ; }
+      }
+      if ( empty ) { continue ; }    // nothing to smooth (sparse classes)
+      Ostap::Math::FFT::radix2 ( buffer , twf ) ;
+      for ( std::size_t j = 0 ; j < L ; ++j ) { buffer [ j ] *= kernel [ j ] ; }
+      Ostap::Math::FFT::radix2 ( buffer , twi ) ;
+      //
+      std::fill ( out1.begin () , out1.end () , 0.0 ) ;
+      std::fill ( out2.begin () , out2.end () , 0.0 ) ;
+      for ( std::size_t k = 0 ; k < L ; ++k )
+      {
+        long j = long ( k ) - long ( P ) ;
+        if ( H <= j ) { j -= L ; }
+        if ( j < 0 || n <= j )
+        {
+          if ( !m_mirror ) { continue ; }
+          j = _reflect_ ( j , n ) ;
+        }
+        out1 [ j ] += buffer [ k ].real () ;
+        out2 [ j ] += buffer [ k ].imag () ;
+      }
+      for ( long j = 0 ; j < n ; ++j )
+      {
+        grid [ s1 + j * stride ] = out1 [ j ] / L ;
+        if ( pair ) { grid [ s2 + j * stride ] = out2 [ j ] / L ; }
+      }
+    }
+    stride *= n ;
+  }
+}
+// ============================================================================
+/*  smooth the binned data using the bandwidth from the rule
+ *  @param rho      the scale factor for the bandwidth
+ *  @param adaptive use the adaptive bandwidth?
+ *  @param mirror   mirror the data at the boundaries?
+ */
+// ============================================================================
+void Ostap::Math::KDE::build
+( const double rho      ,
+  const bool   adaptive ,
+  const bool   mirror   )
+{
+  Ostap::Assert ( 0 < rho                          ,
+                  "Invalid scale factor"           ,
+                  "Ostap::Math::KDE" , INVALID_BANDWIDTH ) ;
+  const double ne = nEff () ;
+  Ostap::Assert ( 0 < ne && 0 < m_sumw             ,
+                  "No data for density estimation" ,
+                  "Ostap::Math::KDE" , INVALID_DATA  ) ;
+  //
+  const double factor = rho * std::pow ( 4.0 / ( ( m_dim + 2 ) * ne ) , 1.0 / ( m_dim + 4 ) ) ;
+  std::vector<double> h ( m_dim ) ;
+  for ( unsigned short a = 0 ; a < m_dim ; ++a )
+  {
+    const double dx    = ( m_xmax [ a ] - m_xmin [ a ] ) / m_n [ a ] ;
+    const double sigma = m_cnt [ a ].rms () ;
+    h [ a ] = 0 < sigma ? factor * sigma : dx ;
+  }
+  build ( h , adaptive , mirror ) ;
+}
+// ============================================================================
+/*  smooth the binned data using the explicit bandwidth
+ *  @param h        the bandwidth for each axis
+ *  @param adaptive use the adaptive bandwidth?
+ *  @param mirror   mirror the data at the boundaries?
+ */
+// ============================================================================
+void Ostap::Math::KDE::build
+( const std::vector<double>& h        ,
+  const bool                 adaptive ,
+  const bool                 mirror   )
+{
+  Ostap::Assert ( m_dim == h.size ()               ,
+                  "Invalid size of bandwidth"      ,
+                  "Ostap::Math::KDE" , INVALID_DIMENSION ) ;
+  for ( const double v : h )
+  {
+    Ostap::Assert ( 0 <= v                         ,
+                    "Invalid bandwidth"            ,
+                    "Ostap::Math::KDE" , INVALID_BANDWIDTH ) ;
+  }
+  Ostap::Assert ( 0 < m_sumw                       ,
+                  "No data for density estimation" ,
+                  "Ostap::Math::KDE" , INVALID_DATA ) ;
+  //
+  m_h        = h        ;
+  m_adaptive = adaptive ;
+  m_mirror   = mirror   ;
+  //
+  // the bandwidth in bins
+  std::vector<double> s ( m_dim ) ;
+  double volume = 1 ;
+  for ( unsigned short a = 0 ; a < m_dim ; ++a )
+  {
+    const double dx = ( m_xmax [ a ] - m_xmin [ a ] ) / m_n [ a ] ;
+    s [ a ]  = h [ a ] / dx ;
+    volume  *= dx ;
+  }
+  //
+  // the first pass: the fixed bandwidth
+  std::vector<double> result ( m_counts ) ;
+  smooth ( result , s ) ;
+  //
+  // the second pass: the adaptive bandwidth, Abramson's square-root law
+  if ( adaptive )
+  {
+    const std::vector<double> pilot ( result ) ;
+    const std::size_t         size = m_counts.size () ;
+    //
+    // the geometric mean of the pilot density over the data
+    const double tiny = std::numeric_limits<double>::min () ;
+    double slog = 0 ;
+    double sw   = 0 ;
+    for ( std::size_t k = 0 ; k < size ; ++k )
+    {
+      const double c = m_counts [ k ] ;
+      if ( 0 < c ) { slog += c * std::log ( std::max ( pilot [ k ] , tiny ) ) ; sw += c ; }
+    }
+    const double g = std::exp ( slog / sw ) ;
+    //
+    // the local bandwidth factors
+    std::vector<double> lambda ( size , 1.0 ) ;
+    double lmin = s_LAMBDA ;
+    double lmax = 1 / s_LAMBDA ;
+    for ( std::size_t k = 0 ; k < size ; ++k )
+    {
+      if ( !m_counts [ k ] ) { continue ; }
+      const double l = std::min ( s_LAMBDA , std::max ( 1 / s_LAMBDA ,
+                                                        std::sqrt ( g / std::max ( pilot [ k ] , tiny ) ) ) ) ;
+      lambda [ k ] = l ;
+      lmin = std::min ( lmin , l ) ;
+      lmax = std::max ( lmax , l ) ;
+    }
+    //
+    // the bandwidth classes: log-spaced, the counts are shared
+    // between two neighbouring classes
+    if ( lmin < lmax )
+    {
+      const unsigned short nc = std::min<unsigned short>
+        ( s_NCLASS , 2 + (unsigned short) std::ceil ( std::log ( lmax / lmin ) / std::log ( s_RATIO ) ) ) ;
+      const double         lr = std::log ( lmax / lmin ) / ( nc - 1 ) ;
+      //
+      std::vector<std::vector<double> > classes ( nc ) ;
+      for ( std::size_t k = 0 ; k < size ; ++k )
+      {
+        const double c = m_counts [ k ] ;
+        if ( !c ) { continue ; }
+        const double       t = std::log ( lambda [ k ] / lmin ) / lr ;
+        const unsigned int i = std::min<unsigned int> ( nc - 2 , (unsigned int) t ) ;
+        const double       f = std::min ( 1.0 , std::max ( 0.0 , t - i ) ) ;
+        if ( classes [ i     ].empty () ) { classes [ i     ].assign ( size , 0.0 ) ; }
+        if ( classes [ i + 1 ].empty () ) { classes [ i + 1 ].assign ( size , 0.0 ) ; }
+        classes [ i     ][ k ] += c * ( 1 - f ) ;
+        classes [ i + 1 ][ k ] += c * f ;
+      }
+      //
+      std::fill ( result.begin () , result.end () , 0.0 ) ;
+      std::vector<double> sc ( m_dim ) ;
+      for ( unsigned short i = 0 ; i < nc ; ++i )
+      {
+        if ( classes [ i ].empty () ) { continue ; }
+        const double l = lmin * std::exp ( i * lr ) ;
+        for ( unsigned short a = 0 ; a < m_dim ; ++a ) { sc [ a ] = s [ a ] * l ; }
+        smooth ( classes [ i ] , sc ) ;
+        for ( std::size_t k = 0 ; k < size ; ++k ) { result [ k ] += classes [ i ][ k ] ; }
+        std::vector<double>().swap ( classes [ i ] ) ;
+      }
+    }
+  }
+  //
+  // normalize: the integral of the interpolant is the sum of nodes times the cell volume
+  double sum = 0 ;
+  for ( double& v : result ) { v = std::max ( 0.0 , v ) ; sum += v ; }
+  Ostap::Assert ( 0 < sum                          ,
+                  "Invalid density"                ,
+                  "Ostap::Math::KDE" , INVALID_DATA ) ;
+  const double scale = 1 / ( sum * volume ) ;
+  for ( double& v : result ) { v *= scale ; }
+  //
+  m_density.swap ( result ) ;
+  m_ok = true ;
+}
+// ============================================================================
+// the interpolated value at the point
+// ============================================================================
+double Ostap::Math::KDE::value ( const double* point ) const
+{
+  Ostap::Assert ( m_ok , "The density is not built" , "Ostap::Math::KDE" , NOT_READY ) ;
+  //
+  typedef Ostap::Math::HistoAxisTable::Stencil Stencil ;
+  Stencil s [ 3 ] ;
+  for ( unsigned short a = 0 ; a < 3 ; ++a )
+  {
+    if ( a < m_dim )
+    {
+      if ( !m_axes [ a ].stencil ( point [ a ] , s [ a ] , true , false , true ) )
+      { return 0 ; }                                               // RETURN
+    }
+    else { s [ a ].n = 1 ; s [ a ].i [ 0 ] = 0 ; s [ a ].w [ 0 ] = 1 ; }
+  }
+  //
+  const std::size_t nx = m_n [ 0 ] ;
+  const std::size_t ny = 2 <= m_dim ? m_n [ 1 ] : 1 ;
+  double result = 0 ;
+  for ( unsigned short k = 0 ; k < s [ 2 ].n ; ++k )
+  {
+    for ( unsigned short j = 0 ; j < s [ 1 ].n ; ++j )
+    {
+      const std::size_t offset = ( s [ 2 ].i [ k ] * ny + s [ 1 ].i [ j ] ) * nx ;
+      const double      wyz    = s [ 2 ].w [ k ] * s [ 1 ].w [ j ] ;
+      for ( unsigned short i = 0 ; i < s [ 0 ].n ; ++i )
+      { result += wyz * s [ 0 ].w [ i ] * m_density [ offset + s [ 0 ].i [ i ] ] ; }
+    }
+  }
+  return std::max ( 0.0 , result ) ;
+}
+// ============================================================================
+// evaluate the density (1D)
+// ============================================================================
+double Ostap::Math::KDE::operator () ( const double x ) const
+{
+  Ostap::Assert ( 1 == m_dim , "Invalid dimension" , "Ostap::Math::KDE" , INVALID_DIMENSION ) ;
+  return value ( &x ) ;
+}
+// ============================================================================
+// evaluate the density (2D)
+// ============================================================================
+double Ostap::Math::KDE::operator () ( const double x , const double y ) const
+{
+  Ostap::Assert ( 2 == m_dim , "Invalid dimension" , "Ostap::Math::KDE" , INVALID_DIMENSION ) ;
+  const double p [ 2 ] = { x , y } ;
+  return value ( p ) ;
+}
+// ============================================================================
+// evaluate the density (3D)
+// ============================================================================
+double Ostap::Math::KDE::operator ()
+  ( const double x , const double y , const double z ) const
+{
+  Ostap::Assert ( 3 == m_dim , "Invalid dimension" , "Ostap::Math::KDE" , INVALID_DIMENSION ) ;
+  const double p [ 3 ] = { x , y , z } ;
+  return value ( p ) ;
+}
+// ============================================================================
+// batch evaluation (1D)
+// ============================================================================
+void Ostap::Math::KDE::evaluate
+( const std::size_t n      ,
+  const double*     x      ,
+  double*           result ) const
+{
+  Ostap::Assert ( 1 == m_dim , "Invalid dimension" , "Ostap::Math::KDE" , INVALID_DIMENSION ) ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = value ( x + i ) ; }
+}
+// ============================================================================
+// batch evaluation (2D)
+// ============================================================================
+void Ostap::Math::KDE::evaluate
+( const std::size_t n      ,
+  const double*     x      ,
+  const double*     y      ,
+  double*           result ) const
+{
+  Ostap::Assert ( 2 == m_dim , "Invalid dimension" , "Ostap::Math::KDE" , INVALID_DIMENSION ) ;
+  double p [ 2 ] ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    p [ 0 ] = x [ i ] ; p [ 1 ] = y [ i ] ;
+    result [ i ] = value ( p ) ;
+  }
+}
+// ============================================================================
+// batch evaluation (3D)
+// ============================================================================
+void Ostap::Math::KDE::evaluate
+( const std::size_t n      ,
+  const double*     x      ,
+  const double*     y      ,
+  const double*     z      ,
+  double*           result ) const
+{
+  Ostap::Assert ( 3 == m_dim , "Invalid dimension" , "Ostap::Math::KDE" , INVALID_DIMENSION ) ;
+  double p [ 3 ] ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    p [ 0 ] = x [ i ] ; p [ 1 ] = y [ i ] ; p [ 2 ] = z [ i ] ;
+    result [ i ] = value ( p ) ;
+  }
+}
+// ============================================================================
+/*  integrate over the chosen axes at the fixed values of others
+ *  @param mask  (INPUT) bit mask of integrated axes (1:x, 2:y, 4:z)
+ *  @param point (INPUT) the point for non-integrated axes
+ *  @param low   (INPUT) the low  edges for integrated axes
+ *  @param high  (INPUT) the high edges for integrated axes
+ */
+// ============================================================================
+double Ostap::Math::KDE::integrate
+( const unsigned short mask  ,
+  const double*        point ,
+  const double*        low   ,
+  const double*        high  ) const
+{
+  Ostap::Assert ( m_ok , "The density is not built" , "Ostap::Math::KDE" , NOT_READY ) ;
+  //
+  Weights w [ 3 ] ;
+  double  sign = 1 ;
+  for ( unsigned short a = 0 ; a < 3 ; ++a )
+  {
+    if ( m_dim <= a ) { w [ a ].first = 0 ; w [ a ].w.assign ( 1 , 1.0 ) ; }
+    else if ( mask & ( 1 << a ) )
+    {
+      const double lo = std::min ( low [ a ] , high [ a ] ) ;
+      const double hi = std::max ( low [ a ] , high [ a ] ) ;
+      if ( high [ a ] < low [ a ] ) { sign = -sign ; }
+      _integral_ ( m_n [ a ] , m_xmin [ a ] , m_xmax [ a ] , lo , hi , w [ a ] ) ;
+    }
+    else
+    {
+      Ostap::Math::HistoAxisTable::Stencil s ;
+      if ( !m_axes [ a ].stencil ( point [ a ] , s , true , false , true ) ) { return 0 ; }
+      _stencil_ ( s , w [ a ] ) ;
+    }
+    if ( w [ a ].w.empty () ) { return 0 ; }                       // RETURN
+  }
+  //
+  const std::size_t nx = m_n [ 0 ] ;
+  const std::size_t ny = 2 <= m_dim ? m_n [ 1 ] : 1 ;
+  double result = 0 ;
+  for ( std::size_t k = 0 ; k < w [ 2 ].w.size () ; ++k )
+  {
+    const double wz = w [ 2 ].w [ k ] ;
+    if ( !wz ) { continue ; }
+    for ( std::size_t j = 0 ; j < w [ 1 ].w.size () ; ++j )
+    {
+      const double wyz = wz * w [ 1 ].w [ j ] ;
+      if ( !wyz ) { continue ; }
+      const double* row = m_density.data ()
+        + ( ( w [ 2 ].first + k ) * ny + w [ 1 ].first + j ) * nx + w [ 0 ].first ;
+      double sx = 0 ;
+      for ( std::size_t i = 0 ; i < w [ 0 ].w.size () ; ++i ) { sx += w [ 0 ].w [ i ] * row [ i ] ; }
+      result += wyz * sx ;
+    }
+  }
+  return sign * result ;
+}
+// ============================================================================
+// integral over the x-range (1D)
+// ============================================================================
+double Ostap::Math::KDE::integral
+( const double xlow , const double xhigh ) const
+{
+  Ostap::Assert ( 1 == m_dim , "Invalid dimension" , "Ostap::Math::KDE" , INVALID_DIMENSION ) ;
+  return integrate ( 1 , &xlow , &xlow , &xhigh ) ;
+}
+// ============================================================================
+// integral over the box (2D)
+// ============================================================================
+double Ostap::Math::KDE::integral
+( const double xlow , const double xhigh ,
+  const double ylow , const double yhigh ) const
+{
+  Ostap::Assert ( 2 == m_dim , "Invalid dimension" , "Ostap::Math::KDE" , INVALID_DIMENSION ) ;
+  const double lo [ 2 ] = { xlow  , ylow  } ;
+  const double hi [ 2 ] = { xhigh , yhigh } ;
+  return integrate ( 3 , lo , lo , hi ) ;
+}
+// ============================================================================
+// integral over the box (3D)
+// ============================================================================
+double Ostap::Math::KDE::integral
+( const double xlow , const double xhigh ,
+  const double ylow , const double yhigh ,
+  const double zlow , const double zhigh ) const
+{
+  Ostap::Assert ( 3 == m_dim , "Invalid dimension" , "Ostap::Math::KDE" , INVALID_DIMENSION ) ;
+  const double lo [ 3 ] = { xlow  , ylow  , zlow  } ;
+  const double hi [ 3 ] = { xhigh , yhigh , zhigh } ;
+  return integrate ( 7 , lo , lo , hi ) ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
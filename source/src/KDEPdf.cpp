@@ -0,0 +1,311 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cassert>
+#include <string>
+#include <vector>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooArgSet.h"
+#include "RooAbsData.h"
+#include "RooAbsRealLValue.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/KDEPdf.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+#include "local_batch.h"
+#include "local_snapshot.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Models::KDE
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+ClassImp(Ostap::Models::KDE)
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// get the range of the observable
+  const RooAbsRealLValue& _lvalue_ ( const RooAbsReal& x )
+  {
+    const RooAbsRealLValue* lv = dynamic_cast<const RooAbsRealLValue*> ( &x ) ;
+    Ostap::Assert ( nullptr != lv                           ,
+                    std::string ( "Observable must be l-value: " ) + x.GetName () ,
+                    "Ostap::Models::KDE"                    ) ;
+    return *lv ;
+  }
+  // ==========================================================================
+  /** fill and build the density from the data
+   *  @param kde      (UPDATE) the density
+   *  @param vars     (INPUT)  the observables
+   *  @param data     (INPUT)  the data
+   *  @param rho      (INPUT)  the scale factor for the bandwidth
+   *  @param adaptive (INPUT)  use the adaptive bandwidth?
+   *  @param mirror   (INPUT)  mirror the data at the boundaries?
+   */
+  Ostap::Math::KDE _build_
+  ( Ostap::Math::KDE                      kde      ,
+    const std::vector<const RooAbsReal*>& vars     ,
+    const RooAbsData&                     data     ,
+    const double                          rho      ,
+    const bool                            adaptive ,
+    const bool                            mirror   )
+  {
+    Ostap::Assert ( nullptr != data.get ()                   ,
+                    "Invalid data"                           ,
+                    "Ostap::Models::KDE"                     ) ;
+    //
+    // the variables in the data
+    ValueSnapshot snapshot ( data , vars ) ;
+    Ostap::Assert ( snapshot.ok ()                           ,
+                    "Variable is not in data: " + snapshot.missing () ,
+                    "Ostap::Models::KDE"                     ) ;
+    //
+    const unsigned long nEntries = data.numEntries () ;
+    for ( unsigned long i = 0 ; i < nEntries ; ++i )
+    {
+      const double* point = snapshot.load ( i ) ;
+      if ( nullptr == point ) { break ; }                   // BREAK
+      kde.fill ( point , snapshot.weight () ) ;
+    }
+    //
+    kde.build ( rho , adaptive , mirror ) ;
+    return kde ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// 1D-estimator from the ready density
+// ============================================================================
+Ostap::Models::KDE::KDE
+( const char*             name  ,
+  const char*             title ,
+  RooAbsReal&             x     ,
+  const Ostap::Math::KDE& kde   )
+  : RooAbsPdf ( name , title )
+  , m_x       ( "x" , "x-observable" , this , x )
+  , m_kde     ( kde )
+{
+  Ostap::Assert ( 1 == m_kde.dim () && m_kde.ok () ,
+                  "Invalid density"                ,
+                  "Ostap::Models::KDE"             ) ;
+}
+// ============================================================================
+// 2D-estimator from the ready density
+// ============================================================================
+Ostap::Models::KDE::KDE
+( const char*             name  ,
+  const char*             title ,
+  RooAbsReal&             x     ,
+  RooAbsReal&             y     ,
+  const Ostap::Math::KDE& kde   )
+  : RooAbsPdf ( name , title )
+  , m_x       ( "x" , "x-observable" , this , x )
+  , m_y       ( "y" , "y-observable" , this , y )
+  , m_kde     ( kde )
+{
+  Ostap::Assert ( 2 == m_kde.dim () && m_kde.ok () ,
+                  "Invalid density"                ,
+                  "Ostap::Models::KDE"             ) ;
+}
+// ============================================================================
+// 3D-estimator from the ready density
+// ============================================================================
+Ostap::Models::KDE::KDE
+( const char*             name  ,
+  const char*             title ,
+  RooAbsReal&             x     ,
+  RooAbsReal&             y     ,
+  RooAbsReal&             z     ,
+  const Ostap::Math::KDE& kde   )
+  : RooAbsPdf ( name , title )
+  , m_x       ( "x" , "x-observable" , this , x )
+  , m_y       ( "y" , "y-observable" , this , y )
+  , m_z       ( "z" , "z-observable" , this , z )
+  , m_kde     ( kde )
+{
+  Ostap::Assert ( 3 == m_kde.dim () && m_kde.ok () ,
+                  "Invalid density"                ,
+                  "Ostap::Models::KDE"             ) ;
+}
+// ============================================================================
+// 1D-estimator from the data
+// ============================================================================
+Ostap::Models::KDE::KDE
+( const char*             name     ,
+  const char*             title    ,
+  RooAbsReal&             x        ,
+  const RooAbsData&       data     ,
+  const unsigned int      nx       ,
+  const double            rho      ,
+  const bool              adaptive ,
+  const bool              mirror   )
+  : RooAbsPdf ( name , title )
+  , m_x       ( "x" , "x-observable" , this , x )
+  , m_kde     ( _build_ ( Ostap::Math::KDE ( nx , _lvalue_ ( x ).getMin () , _lvalue_ ( x ).getMax () ) ,
+                          { &x } , data , rho , adaptive , mirror ) )
+{}
+// ============================================================================
+// 2D-estimator from the data
+// ============================================================================
+Ostap::Models::KDE::KDE
+( const char*             name     ,
+  const char*             title    ,
+  RooAbsReal&             x        ,
+  RooAbsReal&             y        ,
+  const RooAbsData&       data     ,
+  const unsigned int      nx       ,
+  const unsigned int      ny       ,
+  const double            rho      ,
+  const bool              adaptive ,
+  const bool              mirror   )
+  : RooAbsPdf ( name , title )
+  , m_x       ( "x" , "x-observable" , this , x )
+  , m_y       ( "y" , "y-observable" , this , y )
+  , m_kde     ( _build_ ( Ostap::Math::KDE ( nx , _lvalue_ ( x ).getMin () , _lvalue_ ( x ).getMax () ,
+                                             ny , _lvalue_ ( y ).getMin () , _lvalue_ ( y ).getMax () ) ,
+                          { &x , &y } , data , rho , adaptive , mirror ) )
+{}
+// ============================================================================
+// 3D-estimator from the data
+// ============================================================================
+Ostap::Models::KDE::KDE
+( const char*             name     ,
+  const char*             title    ,
+  RooAbsReal&             x        ,
+  RooAbsReal&             y        ,
+  RooAbsReal&             z        ,
+  const RooAbsData&       data     ,
+  const unsigned int      nx       ,
+  const unsigned int      ny       ,
+  const unsigned int      nz       ,
+  const double            rho      ,
+  const bool              adaptive ,
+  const bool              mirror   )
+  : RooAbsPdf ( name , title )
+  , m_x       ( "x" , "x-observable" , this , x )
+  , m_y       ( "y" , "y-observable" , this , y )
+  , m_z       ( "z" , "z-observable" , this , z )
+  , m_kde     ( _build_ ( Ostap::Math::KDE ( nx , _lvalue_ ( x ).getMin () , _lvalue_ ( x ).getMax () ,
+                                             ny , _lvalue_ ( y ).getMin () , _lvalue_ ( y ).getMax () ,
+                                             nz , _lvalue_ ( z ).getMin () , _lvalue_ ( z ).getMax () ) ,
+                          { &x , &y , &z } , data , rho , adaptive , mirror ) )
+{}
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::Models::KDE::KDE
+( const Ostap::Models::KDE& right ,
+  const char*               name  )
+  : RooAbsPdf ( right , name )
+  , m_x       ( "!x" , this , right.m_x )
+  , m_y       ( "!y" , this , right.m_y )
+  , m_z       ( "!z" , this , right.m_z )
+  , m_kde     ( right.m_kde )
+{}
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::Models::KDE::~KDE () {}
+// ============================================================================
+// clone
+// ============================================================================
+Ostap::Models::KDE*
+Ostap::Models::KDE::clone ( const char* name ) const
+{ return new Ostap::Models::KDE ( *this , name ) ; }
+// ============================================================================
+// the actual evaluation of function
+// ============================================================================
+Double_t Ostap::Models::KDE::evaluate() const
+{
+  const unsigned short d = m_kde.dim () ;
+  return
+    3 == d ? m_kde ( m_x , m_y , m_z ) :
+    2 == d ? m_kde ( m_x , m_y       ) : m_kde ( m_x ) ;
+}
+// ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::KDE , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::KDE::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  auto nopars = [] ( const std::vector<double>& /* p */ ) {} ;
+  const unsigned short d = m_kde.dim () ;
+  if      ( 3 == d )
+  {
+    ::Batch batch ( data , m_x , m_y , m_z , nEvents ) ;
+    batch.evaluate3D ( m_kde , nopars , output ) ;
+  }
+  else if ( 2 == d )
+  {
+    ::Batch batch ( data , m_x , m_y , nEvents ) ;
+    batch.evaluate2D ( m_kde , nopars , output ) ;
+  }
+  else
+  {
+    ::Batch batch ( data , m_x , nEvents ) ;
+    batch.evaluate   ( m_kde , nopars , output ) ;
+  }
+}
+#endif
+// ============================================================================
+/*  the integration codes: bit mask of the integrated observables
+ *  (1:x, 2:y, 4:z), the projections are analytic as well
+ */
+// ============================================================================
+Int_t Ostap::Models::KDE::getAnalyticalIntegral
+( RooArgSet&     allVars      ,
+  RooArgSet&     analVars     ,
+  const char* /* rangename */ ) const
+{
+  const unsigned short d = m_kde.dim () ;
+  if      ( 3 == d && matchArgs ( allVars , analVars , m_x , m_y , m_z ) ) { return 7 ; }
+  else if ( 3 == d && matchArgs ( allVars , analVars , m_x , m_z       ) ) { return 5 ; }
+  else if ( 3 == d && matchArgs ( allVars , analVars , m_y , m_z       ) ) { return 6 ; }
+  else if ( 2 <= d && matchArgs ( allVars , analVars , m_x , m_y       ) ) { return 3 ; }
+  else if ( 3 == d && matchArgs ( allVars , analVars , m_z             ) ) { return 4 ; }
+  else if ( 2 <= d && matchArgs ( allVars , analVars , m_y             ) ) { return 2 ; }
+  else if ( 1 <= d && matchArgs ( allVars , analVars , m_x             ) ) { return 1 ; }
+  //
+  return 0 ;
+}
+// ============================================================================
+Double_t Ostap::Models::KDE::analyticalIntegral
+( Int_t       code      ,
+  const char* rangeName ) const
+{
+  assert ( 1 <= code && code <= 7 ) ;
+  //
+  const unsigned short d = m_kde.dim () ;
+  double point [ 3 ] = { 0 , 0 , 0 } ;
+  double low   [ 3 ] = { 0 , 0 , 0 } ;
+  double high  [ 3 ] = { 0 , 0 , 0 } ;
+  //
+  const RooRealProxy* proxies [ 3 ] = { &m_x , &m_y , &m_z } ;
+  for ( unsigned short a = 0 ; a < d ; ++a )
+  {
+    const RooRealProxy& p = *proxies [ a ] ;
+    if ( code & ( 1 << a ) ) { low [ a ] = p.min ( rangeName ) ; high [ a ] = p.max ( rangeName ) ; }
+    else                     { point [ a ] = p ; }
+  }
+  //
+  return m_kde.integrate ( code , point , low , high ) ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
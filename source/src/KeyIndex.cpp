@@ -0,0 +1,200 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <fnmatch.h>
+#include <unordered_map>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TDirectory.h"
+#include "TClass.h"
+#include "TList.h"
+#include "TKey.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/KeyIndex.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Utils::KeyIndex
+ *  @see Ostap::Utils::KeyIndex
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_DIRECTORY = 840 ,
+    INVALID_INDEX     = 841 ,
+  } ;
+  // ==========================================================================
+}
+// ============================================================================
+/*  constructor
+ *  @param dir       (INPUT) the directory
+ *  @param recursive (INPUT) traverse the subdirectories?
+ */
+// ============================================================================
+Ostap::Utils::KeyIndex::KeyIndex
+( const TDirectory* dir       ,
+  const bool        recursive )
+  : m_entries ()
+  , m_map     ()
+{
+  Ostap::Assert ( nullptr != dir                 ,
+                  "Invalid directory"            ,
+                  "Ostap::Utils::KeyIndex"       , INVALID_DIRECTORY ) ;
+  traverse ( dir , "" , recursive ) ;
+}
+// ============================================================================
+// traverse the directory
+// ============================================================================
+void Ostap::Utils::KeyIndex::traverse
+( const TDirectory*  dir       ,
+  const std::string& prefix    ,
+  const bool         recursive )
+{
+  const TList* keys = dir->GetListOfKeys () ;
+  if ( nullptr == keys ) { return ; }                                // RETURN
+  //
+  static const TClass* s_dir = TDirectory::Class () ;
+  //
+  for ( const TObject* o : *keys )
+  {
+    const TKey* key = dynamic_cast<const TKey*> ( o ) ;
+    if ( nullptr == key ) { continue ; }
+    //
+    Entry entry ;
+    entry.path      = prefix + key->GetName () ;
+    entry.classname = key->GetClassName () ;
+    entry.cycle     = key->GetCycle     () ;
+    entry.nbytes    = key->GetNbytes    () ;
+    entry.objlen    = key->GetObjlen    () ;
+    entry.directory = inherits ( entry.classname , s_dir ) ;
+    //
+    auto it = m_map.find ( entry.path ) ;
+    if ( m_map.end () == it || m_entries [ it->second ].cycle < entry.cycle )
+    { m_map [ entry.path ] = m_entries.size () ; }
+    //
+    const bool        directory = entry.directory ;
+    const std::string path      = entry.path      ;
+    m_entries.push_back ( std::move ( entry ) ) ;
+    //
+    if ( !recursive || !directory ) { continue ; }
+    TDirectory* sub = const_cast<TDirectory*> ( dir )->GetDirectory ( key->GetName () ) ;
+    if ( nullptr != sub && sub != dir ) { traverse ( sub , path + "/" , recursive ) ; }
+  }
+}
+// ============================================================================
+// does the class inherit from the base?
+// ============================================================================
+bool Ostap::Utils::KeyIndex::inherits
+( const std::string& classname ,
+  const TClass*      base      ) const
+{
+  if ( nullptr == base ) { return true ; }
+  const TClass* cls = TClass::GetClass ( classname.c_str () , true , true ) ;
+  return nullptr != cls && cls->InheritsFrom ( base ) ;
+}
+// ============================================================================
+// get the entry
+// ============================================================================
+const Ostap::Utils::KeyIndex::Entry&
+Ostap::Utils::KeyIndex::entry ( const std::size_t index ) const
+{
+  Ostap::Assert ( index < m_entries.size ()      ,
+                  "Invalid index"                ,
+                  "Ostap::Utils::KeyIndex"       , INVALID_INDEX ) ;
+  return m_entries [ index ] ;
+}
+// ============================================================================
+// is the path in the index?
+// ============================================================================
+bool Ostap::Utils::KeyIndex::has ( const std::string& path ) const
+{ return m_map.end () != m_map.find ( path ) ; }
+// ============================================================================
+// get the index of the entry by path (the highest cycle)
+// ============================================================================
+std::size_t Ostap::Utils::KeyIndex::find ( const std::string& path ) const
+{
+  auto it = m_map.find ( path ) ;
+  return m_map.end () == it ? m_entries.size () : it->second ;
+}
+// ============================================================================
+/*  select the entries
+ *  @param pattern (INPUT) the shell-style (glob) pattern, empty for all
+ *  @param base    (INPUT) the name of the base class, empty for all
+ *  @param no_dir  (INPUT) skip the directories?
+ *  @return the indices of the entries
+ */
+// ============================================================================
+std::vector<std::size_t>
+Ostap::Utils::KeyIndex::select
+( const std::string& pattern ,
+  const std::string& base    ,
+  const bool         no_dir  ) const
+{
+  std::vector<std::size_t> result ;
+  //
+  const TClass* bcl = base.empty () ? nullptr : TClass::GetClass ( base.c_str () , true , true ) ;
+  if ( !base.empty () && nullptr == bcl ) { return result ; }        // RETURN
+  //
+  // the classes are checked only once
+  std::unordered_map<std::string,bool> accepted ;
+  //
+  for ( std::size_t i = 0 ; i < m_entries.size () ; ++i )
+  {
+    const Entry& e = m_entries [ i ] ;
+    if ( no_dir && e.directory ) { continue ; }
+    if ( !pattern.empty () && 0 != fnmatch ( pattern.c_str () , e.path.c_str () , 0 ) ) { continue ; }
+    if ( nullptr != bcl )
+    {
+      auto it = accepted.find ( e.classname ) ;
+      if ( accepted.end () == it )
+      { it = accepted.emplace ( e.classname , inherits ( e.classname , bcl ) ).first ; }
+      if ( !it->second ) { continue ; }
+    }
+    result.push_back ( i ) ;
+  }
+  return result ;
+}
+// ============================================================================
+/*  select the paths
+ *  @param pattern (INPUT) the shell-style (glob) pattern, empty for all
+ *  @param base    (INPUT) the name of the base class, empty for all
+ *  @param no_dir  (INPUT) skip the directories?
+ *  @return the paths in the order of the traversal
+ */
+// ============================================================================
+std::vector<std::string>
+Ostap::Utils::KeyIndex::paths
+( const std::string& pattern ,
+  const std::string& base    ,
+  const bool         no_dir  ) const
+{
+  const std::vector<std::size_t> selected = select ( pattern , base , no_dir ) ;
+  std::vector<std::string> result ;
+  result.reserve ( selected.size () ) ;
+  for ( const std::size_t i : selected ) { result.push_back ( m_entries [ i ].path ) ; }
+  return result ;
+}
+// ============================================================================
+// total size of objects on disk (bytes)
+// ============================================================================
+double Ostap::Utils::KeyIndex::nbytes () const
+{
+  double result = 0 ;
+  for ( const Entry& e : m_entries ) { result += e.nbytes ; }
+  return result ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -5,6 +5,9 @@
 // ============================================================================
 #include <cmath>
 #include <climits>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -1292,5 +1295,321 @@ double Ostap::Kinematics::phasespace3nr
   return s_norm * std::sqrt ( pm / sm ) * dm * dm / sm ;
 }
 // ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /// infinity 
+  const double s_INF = std::numeric_limits<double>::infinity () ;
+  // ==========================================================================
+  /** \f$ J^T C J \f$ for packed symmetric 4x4 matrix 
+   *  @see ROOT::Math::MatRepSym 
+   */
+  inline double _sim4_ 
+  ( const double* c  , 
+    const double  j0 , 
+    const double  j1 , 
+    const double  j2 , 
+    const double  j3 )
+  {
+    return 
+      c [ 0 ] * j0 * j0 + c [ 2 ] * j1 * j1 + c [ 5 ] * j2 * j2 + c [ 9 ] * j3 * j3 + 
+      2 * ( c [ 1 ] * j0 * j1 + c [ 3 ] * j0 * j2 + c [ 4 ] * j1 * j2 + 
+            c [ 6 ] * j0 * j3 + c [ 7 ] * j1 * j3 + c [ 8 ] * j2 * j3 ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+/*  invariant mass and its uncertainty 
+ *  @param n     (INPUT)  number of candidates 
+ *  @param px    (INPUT)  x-components of momenta 
+ *  @param py    (INPUT)  y-components of momenta 
+ *  @param pz    (INPUT)  z-components of momenta 
+ *  @param e     (INPUT)  energies 
+ *  @param cov   (INPUT)  packed 4x4 covariances, 10 elements per candidate 
+ *  @param mass  (OUTPUT) masses 
+ *  @param sigma (OUTPUT) uncertainties of masses 
+ *  @return number of processed candidates 
+ */
+// ============================================================================
+std::size_t Ostap::Kinematics::mass_with_error 
+( const std::size_t n     , 
+  const double*     px    , 
+  const double*     py    , 
+  const double*     pz    , 
+  const double*     e     , 
+  const double*     cov   , 
+  double*           mass  , 
+  double*           sigma ) 
+{
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double x  = px [ i ] ;
+    const double y  = py [ i ] ;
+    const double z  = pz [ i ] ;
+    const double t  = e  [ i ] ;
+    const double m2 = t * t - x * x - y * y - z * z ;
+    //
+    // sigma^2(M^2) = 4 * J^T C J with J = ( -px , -py , -pz , E ) 
+    const double s2 = _sim4_ ( cov + 10 * i , -x , -y , -z , t ) ;
+    //
+    // zero for space-like vectors and invalid covariances 
+    const double r2 = std::max ( s2 , 0.0 ) / ( 0 < m2 ? m2 : s_INF ) ;
+    //
+    mass  [ i ] = 0 <= m2 ? std::sqrt ( m2 ) : -std::sqrt ( -m2 ) ;
+    sigma [ i ] = std::sqrt ( r2 ) ;
+  }
+  return n ;
+}
+// ============================================================================
+/*  transverse momentum and its uncertainty 
+ *  @see Ostap::Kinematics::mass_with_error
+ */
+// ============================================================================
+std::size_t Ostap::Kinematics::pt_with_error 
+( const std::size_t n     , 
+  const double*     px    , 
+  const double*     py    , 
+  const double*     cov   , 
+  double*           pt    , 
+  double*           sigma ) 
+{
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double  x   = px  [ i ] ;
+    const double  y   = py  [ i ] ;
+    const double* c   = cov + 10 * i ;
+    const double  pt2 = x * x + y * y ;
+    const double  s2  = c [ 0 ] * x * x + 2 * c [ 1 ] * x * y + c [ 2 ] * y * y ;
+    //
+    const double  r2  = std::max ( s2 , 0.0 ) / ( 0 < pt2 ? pt2 : s_INF ) ;
+    //
+    pt    [ i ] = std::sqrt ( pt2 ) ;
+    sigma [ i ] = std::sqrt ( r2  ) ;
+  }
+  return n ;
+}
+// ============================================================================
+/*  rapidity and its uncertainty 
+ *  @see Ostap::Kinematics::mass_with_error
+ */
+// ============================================================================
+std::size_t Ostap::Kinematics::rapidity_with_error 
+( const std::size_t n     , 
+  const double*     pz    , 
+  const double*     e     , 
+  const double*     cov   , 
+  double*           y     , 
+  double*           sigma ) 
+{
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double  z    = pz  [ i ] ;
+    const double  t    = e   [ i ] ;
+    const double* c    = cov + 10 * i ;
+    const double  ePpz = 0.5 / ( t + z ) ;
+    const double  eMpz = 0.5 / ( t - z ) ;
+    const double  j2   = ePpz + eMpz ;
+    const double  j3   = ePpz - eMpz ;
+    const double  s2   = c [ 5 ] * j2 * j2 + 2 * c [ 8 ] * j2 * j3 + c [ 9 ] * j3 * j3 ;
+    //
+    y     [ i ] = 0.5 * std::log ( ( t + z ) / ( t - z ) ) ;
+    sigma [ i ] = std::abs ( z ) < t ? std::sqrt ( std::max ( s2 , 0.0 ) ) : 0.0 ;
+  }
+  return n ;
+}
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /** @struct CSum
+   *  compensated (Neumaier) summation of the exactly-split products
+   *  @see T.Ogita, S.M.Rump, S.Oishi, "Accurate sum and dot product",
+   *       SIAM J. Sci. Comput. 26 (2005) 1955
+   */
+  struct CSum
+  {
+    // ========================================================================
+    /// add the value: the rounding error goes to the compensation term
+    inline void add ( const double x )
+    {
+      const double t = m_sum + x ;
+      m_err += std::abs ( m_sum ) >= std::abs ( x ) ? ( m_sum - t ) + x : ( x - t ) + m_sum ;
+      m_sum  = t ;
+    }
+    /// add the product \f$ a b \f$ (split exactly via fma)
+    inline void add ( const double a , const double b )
+    {
+      const double p = a * b ;
+      m_err += std::fma ( a , b , -p ) ;
+      add ( p ) ;
+    }
+    /// add the product \f$ a b c \f$ (split via fma, second order error is neglected)
+    inline void add ( const double a , const double b , const double c )
+    {
+      const double p = a * b ;
+      const double e = std::fma ( a , b , -p ) ;
+      m_err += e * c ;
+      add ( p , c ) ;
+    }
+    /// the result
+    inline double value () const { return m_sum + m_err ; }
+    // ========================================================================
+    double m_sum { 0 } ;
+    double m_err { 0 } ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** compensated triangle function
+   *  \f$ \lambda ( a , b , c ) = ( a - b - c )^2 - 4bc \f$,
+   *  the difference \f$ a-b-c\f$ is calculated exactly as a sum of two doubles,
+   *  and the final subtraction is exact for the cancelling terms (Sterbenz lemma)
+   */
+  inline double _triangle_
+  ( const double a ,
+    const double b ,
+    const double c )
+  {
+    // d1 = a - b with error e1 (TwoSum)
+    const double d1  = a  - b ;
+    const double z1  = d1 - a ;
+    const double e1  = ( a - ( d1 - z1 ) ) + ( -b - z1 ) ;
+    // d = d1 - c with error e2 (TwoSum)
+    const double d   = d1 - c ;
+    const double z2  = d  - d1 ;
+    const double e2  = ( d1 - ( d - z2 ) ) + ( -c - z2 ) ;
+    const double ed  = e1 + e2 ;
+    // d^2 = p + ep
+    const double p   = d * d ;
+    const double ep  = std::fma ( d , d , -p ) ;
+    // 4bc = q + eq
+    const double b4  = 4 * b ;
+    const double q   = b4 * c ;
+    const double eq  = std::fma ( b4 , c , -q ) ;
+    //
+    return ( p - q ) + ( ( ep - eq ) + 2 * d * ed ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+/*  the triangle function for arrays of arguments
+ *  \f$ \lambda ( a_i , b_i , c_i ) \f$
+ *  @param n      (INPUT)  number of points
+ *  @param a      (INPUT)  array of the first arguments
+ *  @param b      (INPUT)  array of the second arguments
+ *  @param c      (INPUT)  array of the third arguments
+ *  @param result (OUTPUT) array of results
+ *  @return number of processed points
+ */
+// ============================================================================
+std::size_t Ostap::Kinematics::triangle
+( const std::size_t n      ,
+  const double*     a      ,
+  const double*     b      ,
+  const double*     c      ,
+  double*           result )
+{
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  { result [ i ] = _triangle_ ( a [ i ] , b [ i ] , c [ i ] ) ; }
+  return n ;
+}
+// ============================================================================
+/*  the triangle function for array of the first argument
+ *  and fixed other arguments (e.g. squared masses)
+ *  \f$ \lambda ( a_i , b , c ) \f$
+ */
+// ============================================================================
+std::size_t Ostap::Kinematics::triangle
+( const std::size_t n      ,
+  const double*     a      ,
+  const double      b      ,
+  const double      c      ,
+  double*           result )
+{
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  { result [ i ] = _triangle_ ( a [ i ] , b , c ) ; }
+  return n ;
+}
+// ============================================================================
+/*  momenta of the two-body decays for array of \f$ s \f$
+ *  and the fixed squared masses of daughter particles
+ *  \f$ q_s ( s_i , m_1^2 , m_2^2 ) \f$; zero below the threshold
+ */
+// ============================================================================
+std::size_t Ostap::Kinematics::q_s
+( const std::size_t n      ,
+  const double*     s      ,
+  const double      m2_1   ,
+  const double      m2_2   ,
+  double*           result )
+{
+  if ( m2_1 < 0 || m2_2 < 0 ) { std::fill ( result , result + n , 0.0 ) ; return n ; }
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double x = s [ i ] ;
+    const double l = 0 < x ? _triangle_ ( x , m2_1 , m2_2 ) : 0.0 ;
+    result [ i ] = 0 < l ? 0.5 * std::sqrt ( l / x ) : 0.0 ;
+  }
+  return n ;
+}
+// ============================================================================
+/*  the universal four-particle ``tetrahedron-function''
+ *  for arrays of arguments
+ *  \f$ G ( x_i , y_i , z_i , u_i , v_i , w_i ) \f$
+ *  @see Ostap::Kinematics::G
+ */
+// ============================================================================
+std::size_t Ostap::Kinematics::G
+( const std::size_t n      ,
+  const double*     x      ,
+  const double*     y      ,
+  const double*     z      ,
+  const double*     u      ,
+  const double*     v      ,
+  const double*     w      ,
+  double*           result )
+{
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double xi = x [ i ] ;
+    const double yi = y [ i ] ;
+    const double zi = z [ i ] ;
+    const double ui = u [ i ] ;
+    const double vi = v [ i ] ;
+    const double wi = w [ i ] ;
+    //
+    // pairwise products, split exactly: ab = pab + eab
+    const double pxy = xi * yi , exy = std::fma ( xi , yi , -pxy ) ;
+    const double pzu = zi * ui , ezu = std::fma ( zi , ui , -pzu ) ;
+    const double pvw = vi * wi , evw = std::fma ( vi , wi , -pvw ) ;
+    //
+    CSum sum ;
+    // x y ( x + y - z - u - v - w )
+    sum.add ( pxy ,  xi ) ; sum.add ( pxy ,  yi ) ;
+    sum.add ( pxy , -zi ) ; sum.add ( pxy , -ui ) ;
+    sum.add ( pxy , -vi ) ; sum.add ( pxy , -wi ) ;
+    // z u ( z + u - x - y - v - w )
+    sum.add ( pzu ,  zi ) ; sum.add ( pzu ,  ui ) ;
+    sum.add ( pzu , -xi ) ; sum.add ( pzu , -yi ) ;
+    sum.add ( pzu , -vi ) ; sum.add ( pzu , -wi ) ;
+    // v w ( v + w - x - y - z - u )
+    sum.add ( pvw ,  vi ) ; sum.add ( pvw ,  wi ) ;
+    sum.add ( pvw , -xi ) ; sum.add ( pvw , -yi ) ;
+    sum.add ( pvw , -zi ) ; sum.add ( pvw , -ui ) ;
+    // x z w + x u v + y z v + y u w
+    sum.add (  xi , zi , wi ) ;
+    sum.add (  xi , ui , vi ) ;
+    sum.add (  yi , zi , vi ) ;
+    sum.add (  yi , ui , wi ) ;
+    // errors of the pairwise products (second order)
+    sum.m_err += exy * ( xi + yi - zi - ui - vi - wi ) ;
+    sum.m_err += ezu * ( zi + ui - xi - yi - vi - wi ) ;
+    sum.m_err += evw * ( vi + wi - xi - yi - zi - ui ) ;
+    //
+    result [ i ] = sum.value () ;
+  }
+  return n ;
+}
+// ============================================================================
 //                                                                      The END 
 // ============================================================================
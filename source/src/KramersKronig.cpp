@@ -3,9 +3,20 @@
 // =============================================================================
 // Incldue files 
 // =============================================================================
+// STD&STL
+// =============================================================================
+#include <cmath>
+#include <array>
+#include <algorithm>
+// =============================================================================
 // Ostap
 // =============================================================================
 #include "Ostap/KramersKronig.h"
+#include "Ostap/ChebyshevApproximation.h"
+// =============================================================================
+// Local
+// =============================================================================
+#include "local_tables.h"
 // =============================================================================
 /** @file 
  *  Implementation file for class Ostap::Math::KramersKronig
@@ -25,9 +36,199 @@
  */
 // =============================================================================
 double Ostap::Math::KramersKronig::operator() ( const double x ) const
+{
+  return 
+    prepared () && m_table.xmin <= x && x <= m_table.xmax ? 
+    _table_ ( x ) : direct ( x ) ; 
+}
+// =============================================================================
+// the direct calculation via the numerical integration 
+// =============================================================================
+double Ostap::Math::KramersKronig::direct ( const double x ) const
 { return m_scale * m_integrator.kramers_kronig 
     ( std::cref ( m_rho ) , x , m_omega0 , m_n , m_tag , m_rescale ) ; }
 // =============================================================================
+namespace 
+{
+  // ===========================================================================
+  /// number of Gauss-Legendre nodes for the distant pieces 
+  const unsigned int s_NGL    = 40  ;
+  /// the pieces with \f$ |\tau| \le \tau_{near} \f$ are treated analytically 
+  const double       s_NEAR   = 1.1 ;
+  /// number of Chebyshev nodes for the tail 
+  const unsigned int s_NTAIL  = 24  ;
+  // ===========================================================================
+  /** principal value integral \f$ \mathcal{P}\int_{-1}^{1} \frac{p(t)}{t-\tau}dt \f$
+   *  for the Chebyshev sum \f$ p(t) = \sum_k a_k T_k(t) \f$ using the recurrence 
+   *  \f$ Q_{k+1} = 2 \tau Q_k  - Q_{k-1} + 2 \int_{-1}^{1}T_k(t)dt \f$ 
+   *  (stable for \f$ |\tau| \le \tau_{near} \f$)
+   *  @param a   Chebyshev coefficients 
+   *  @param N   number of coefficients 
+   *  @param tau the point 
+   *  @param L   \f$ \log \left| \frac{1-\tau}{1+\tau} \right| \f$
+   */
+  inline double _pv_chebyshev_ 
+  ( const double*      a   , 
+    const unsigned int N   , 
+    const double       tau , 
+    const double       L   ) 
+  {
+    double       q0 = L ;
+    double       q1 = 2 + tau * L ;
+    double       r  = a [ 0 ] * q0 + a [ 1 ] * q1 ;
+    for ( unsigned int k = 1 ; k + 1 < N ; ++k ) 
+    {
+      const double mk = k % 2 ? 0.0 : 2.0 / ( 1.0 - double ( k ) * k ) ;
+      const double q2 = 2 * tau * q1 - q0 + 2 * mk ;
+      r  += a [ k + 1 ] * q2 ;
+      q0  = q1 ;
+      q1  = q2 ;
+    }
+    return r ;
+  }
+  // ===========================================================================
+}
+// =============================================================================
+/*  prepare the grid-based representation of the transform for 
+ *  \f$ x_{min} \le x \le x_{max} \f$
+ *  @param xmin      low  edge of the range 
+ *  @param xmax      high edge of the range 
+ *  @param precision the relative precision of the piecewise Chebyshev approximation
+ *  @param N         the order of the Chebyshev approximation in each piece 
+ *  @return number of pieces 
+ */
+// =============================================================================
+std::size_t Ostap::Math::KramersKronig::prepare 
+( const double         xmin      , 
+  const double         xmax      , 
+  const double         precision , 
+  const unsigned short N         ) 
+{
+  reset () ;
+  //
+  Table table ;
+  table.xmin = std::min ( xmin , xmax ) ;
+  table.xmax = std::max ( xmin , xmax ) ;
+  //
+  // the upper edge for the piecewise approximation: 
+  // the tail is analytic well beyond the range 
+  const double lo = std::min ( table.xmin , m_omega0 ) ;
+  const double hi = std::max ( table.xmax , m_omega0 ) ;
+  const double W  = hi + std::max ( hi - lo , 1.e-3 * ( 1 + std::abs ( hi ) ) ) ;
+  //
+  const std::function<double(double)>& rho = m_rho ;
+  const unsigned short                 n   = m_n   ;
+  auto h = [&rho,n] ( const double x ) -> double 
+    { return 0 < n ? rho ( x ) / std::pow ( x , n ) : rho ( x ) ; } ;
+  //
+  const Ostap::Math::ChebyshevProxy proxy ( h , m_omega0 , W , precision , N ) ;
+  table.N            = proxy.N            () ;
+  table.knots        = proxy.knots        () ;
+  table.coefficients = proxy.coefficients () ;
+  //
+  // values at Gauss-Legendre nodes for the distant pieces 
+  const Ostap::Math::Tables::GaussLegendre& gl = Ostap::Math::Tables::gauss_legendre ( s_NGL ) ;
+  const std::size_t np = table.knots.size () - 1 ;
+  table.values.reserve ( np * s_NGL ) ;
+  for ( std::size_t p = 0 ; p < np ; ++p ) 
+  {
+    const double m  = 0.5 * ( table.knots [ p + 1 ] + table.knots [ p ] ) ;
+    const double hw = 0.5 * ( table.knots [ p + 1 ] - table.knots [ p ] ) ;
+    for ( unsigned int i = 0 ; i < s_NGL ; ++i ) 
+    { table.values.push_back ( gl.w [ i ] * proxy ( m + hw * gl.x [ i ] ) ) ; }
+  }
+  //
+  // the tail: interpolate at Chebyshev nodes 
+  std::array<double,s_NTAIL> tv ;
+  const double tm = 0.5 * ( table.xmax + table.xmin ) ;
+  const double th = 0.5 * ( table.xmax - table.xmin ) ;
+  for ( unsigned int j = 0 ; j < s_NTAIL ; ++j ) 
+  {
+    const double sj = tm + th * std::cos ( M_PI * ( j + 0.5 ) / s_NTAIL ) ;
+    auto ff = [&h,sj] ( const double x ) -> double { return h ( x ) / ( x - sj ) ; } ;
+    tv [ j ] = m_integrator.integrate_to_infinity ( std::cref ( ff ) , W ) ;
+  }
+  table.tail.resize ( s_NTAIL ) ;
+  for ( unsigned int k = 0 ; k < s_NTAIL ; ++k ) 
+  {
+    double c = 0 ;
+    for ( unsigned int j = 0 ; j < s_NTAIL ; ++j ) 
+    { c += tv [ j ] * std::cos ( M_PI * k * ( j + 0.5 ) / s_NTAIL ) ; }
+    table.tail [ k ] = 2 * c / s_NTAIL ;
+  }
+  table.tail [ 0 ] *= 0.5 ;
+  //
+  m_table = table ;
+  return np ;
+}
+// =============================================================================
+// evaluate the transform using the grid-based representation 
+// =============================================================================
+double Ostap::Math::KramersKronig::_table_ ( const double x ) const 
+{
+  const Ostap::Math::Tables::GaussLegendre& gl = Ostap::Math::Tables::gauss_legendre ( s_NGL ) ;
+  //
+  const std::vector<double>& knots = m_table.knots ;
+  const unsigned int         N     = m_table.N     ;
+  //
+  // points exactly at the knots: the logarithms from the adjacent pieces cancel, 
+  // but their sum is not computable, shift the point a bit 
+  double s = x ;
+  auto it  = std::lower_bound ( knots.begin () , knots.end () , s ) ;
+  const double eps = 1.e-12 * ( 1 + std::abs ( s ) ) ;
+  if ( ( knots.end   () != it && std::abs ( *it   - s ) < eps ) || 
+       ( knots.begin () != it && std::abs ( *(it-1) - s ) < eps ) ) { s += 2 * eps ; }
+  //
+  double result = 0 ;
+  const std::size_t np = knots.size () - 1 ;
+  for ( std::size_t p = 0 ; p < np ; ++p ) 
+  {
+    const double m   = 0.5 * ( knots [ p + 1 ] + knots [ p ] ) ;
+    const double hw  = 0.5 * ( knots [ p + 1 ] - knots [ p ] ) ;
+    const double tau = ( s - m ) / hw ;
+    if ( std::abs ( tau ) <= s_NEAR ) 
+    {
+      // the logarithm directly from the distances to the knots (no cancellations)
+      const double L = std::log ( std::abs ( ( knots [ p + 1 ] - s ) / ( s - knots [ p ] ) ) ) ;
+      result += _pv_chebyshev_ ( m_table.coefficients.data () + p * N , N , tau , L ) ;
+    }
+    else 
+    {
+      const double* v = m_table.values.data () + p * s_NGL ;
+      double r = 0 ;
+      for ( unsigned int i = 0 ; i < s_NGL ; ++i ) { r += v [ i ] / ( gl.x [ i ] - tau ) ; }
+      result += r ;
+    }
+  }
+  //
+  // the tail 
+  const double t  = ( 2 * x - m_table.xmin - m_table.xmax ) / ( m_table.xmax - m_table.xmin ) ;
+  double b1 = 0 ;
+  double b2 = 0 ;
+  for ( unsigned int k = s_NTAIL - 1 ; 0 < k ; --k ) 
+  {
+    const double b0 = 2 * t * b1 - b2 + m_table.tail [ k ] ;
+    b2 = b1 ;
+    b1 = b0 ;
+  }
+  result += m_table.tail [ 0 ] + t * b1 - b2 ;
+  //
+  const double sn = 0 < m_n ? std::pow ( x , m_n ) : 1.0 ;
+  return m_scale * sn * result / M_PI ;
+}
+// =============================================================================
+/*  evaluate the transform for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of points 
+ *  @param result (UPDATE) array of results 
+ */
+// =============================================================================
+void Ostap::Math::KramersKronig::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = (*this) ( x [ i ] ) ; } }
+// =============================================================================
 
 
 // =============================================================================
@@ -306,7 +306,7 @@ double Ostap::Math::LorentzVectorWithError::chi2
   Ostap::Math::geo2LA ( vector4d() , vct ) ;
   vct -= right.value() ;
   //
-  return ROOT::Math::Similarity ( vct , s_cov2 ) ;
+  return Ostap::Math::similarity ( s_cov2 , vct ) ;
 }
 // ============================================================================
 // chi2 distance 
@@ -323,7 +323,7 @@ double Ostap::Math::LorentzVectorWithError::chi2
   Ostap::Math::geo2LA ( vector4d() , vct ) ;
   vct -= right ;
   //
-  return ROOT::Math::Similarity ( vct , s_cov2 ) ;
+  return Ostap::Math::similarity ( s_cov2 , vct ) ;
 }
 // ============================================================================
 void Ostap::Math::LorentzVectorWithError::asVector 
@@ -487,7 +487,7 @@ Ostap::Math::Kinematics::pseudorapidity
   dEtadP_i [2] =  1 / p ;
   dEtadP_i [3] =  0.0 ;
   //
-  const double s2eta = ROOT::Math::Similarity ( cov , dEtadP_i ) ;
+  const double s2eta = Ostap::Math::similarity ( cov , dEtadP_i ) ;
   return 
     s2eta <= 0 || s_zero ( s2eta )  ? 
     Ostap::Math::ValueWithError ( eta         ) : 
@@ -533,7 +533,7 @@ Ostap::Math::Kinematics::transverseMass2
   dMt2dP_i [2] = -2 * mom.Pz() ;
   dMt2dP_i [3] =  2 * mom.E () ;
   //
-  const double s2mt2 = ROOT::Math::Similarity ( cov , dMt2dP_i ) ;
+  const double s2mt2 = Ostap::Math::similarity ( cov , dMt2dP_i ) ;
   return 
     s2mt2 <= 0 || s_zero ( s2mt2 )  ? 
     Ostap::Math::ValueWithError ( mt2         ) : 
@@ -588,7 +588,7 @@ Ostap::Math::Kinematics::transverseEnergy2
   dEt2dP_i [2] =  c1 * ( 0 - c2 ) * mom.Pz () ;
   dEt2dP_i [3] =  2 * e * c2 ;
   //
-  const double s2et2 = ROOT::Math::Similarity ( cov , dEt2dP_i ) ;
+  const double s2et2 = Ostap::Math::similarity ( cov , dEt2dP_i ) ;
   return 
     s2et2 <= 0 || s_zero ( s2et2 )  ? 
     Ostap::Math::ValueWithError ( et2         ) : 
@@ -644,7 +644,7 @@ Ostap::Math::Kinematics::kineticEnergy
   dEkdP_i [2] =      mom.Pz() / m ;
   dEkdP_i [3] =  1 - mom.E () / m ;
   //
-  const double s2ek = ROOT::Math::Similarity ( cov , dEkdP_i ) ;
+  const double s2ek = Ostap::Math::similarity ( cov , dEkdP_i ) ;
   return 
     s2ek <= 0 || s_zero ( s2ek )  ? 
     Ostap::Math::ValueWithError ( eK        ) : 
@@ -675,7 +675,7 @@ Ostap::Math::Kinematics::phi
   dPhidP_i [2] =   0.0 ;
   dPhidP_i [3] =   0.0 ;
   //
-  const double s2phi = ROOT::Math::Similarity ( cov , dPhidP_i ) ;
+  const double s2phi = Ostap::Math::similarity ( cov , dPhidP_i ) ;
   return 
     s2phi <= 0 || s_zero ( s2phi )  ? 
     Ostap::Math::ValueWithError ( phi         ) : 
@@ -713,7 +713,7 @@ Ostap::Math::Kinematics::theta
   dThetadP_i [2] =  - pt / p2    ;
   dThetadP_i [3] =  0.0 ;
   //
-  const double s2theta = ROOT::Math::Similarity ( cov , dThetadP_i ) ;
+  const double s2theta = Ostap::Math::similarity ( cov , dThetadP_i ) ;
   return 
     s2theta <= 0 || s_zero ( s2theta )  ? 
     Ostap::Math::ValueWithError ( theta           ) : 
@@ -752,7 +752,7 @@ Ostap::Math::Kinematics::transverseKineticEnergy
   dEtk_dP [2] = pz / m * ( 1 - m / mt ) ;
   dEtk_dP [3] = -e / m * ( 1 - m / mt ) ;
   //
-  const double s2etk = ROOT::Math::Similarity ( cov , dEtk_dP ) ;
+  const double s2etk = Ostap::Math::similarity ( cov , dEtk_dP ) ;
   return 
     s2etk <= 0 || s_zero ( s2etk )  ? 
     Ostap::Math::ValueWithError ( etk         ) : 
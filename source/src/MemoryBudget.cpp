@@ -0,0 +1,105 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+// ============================================================================
+// POSIX
+// ============================================================================
+#include <unistd.h>
+#include <sys/resource.h>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/MemoryBudget.h"
+// ============================================================================
+/** @file
+ *  Implementation file for functions from file Ostap/MemoryBudget.h
+ *  @see Ostap/MemoryBudget.h
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// the explicitly defined budget (the maximal value: not defined)
+  std::atomic<std::size_t> s_budget { std::numeric_limits<std::size_t>::max () } ;
+  // ==========================================================================
+}
+// ============================================================================
+// the current resident set size of the process (in bytes)
+// ============================================================================
+std::size_t Ostap::Utils::rss ()
+{
+  unsigned long size     = 0 ;
+  unsigned long resident = 0 ;
+  FILE* f = std::fopen ( "/proc/self/statm" , "r" ) ;
+  if ( nullptr == f ) { return peak_rss () ; }          // no procfs
+  const int n = std::fscanf ( f , "%lu %lu" , &size , &resident ) ;
+  std::fclose ( f ) ;
+  if ( 2 != n ) { return peak_rss () ; }
+  return std::size_t ( resident ) * std::size_t ( ::sysconf ( _SC_PAGESIZE ) ) ;
+}
+// ============================================================================
+// the peak resident set size of the process (in bytes)
+// ============================================================================
+std::size_t Ostap::Utils::peak_rss ()
+{
+  struct rusage usage ;
+  if ( 0 != ::getrusage ( RUSAGE_SELF , &usage ) ) { return 0 ; }
+#if defined ( __APPLE__ )
+  return std::size_t ( usage.ru_maxrss ) ;           // bytes
+#else
+  return std::size_t ( usage.ru_maxrss ) * 1024 ;    // kilobytes
+#endif
+}
+// ============================================================================
+// get the memory budget (in bytes), zero means no limit
+// ============================================================================
+std::size_t Ostap::Utils::memory_budget ()
+{
+  const std::size_t budget = s_budget.load () ;
+  if ( std::numeric_limits<std::size_t>::max () != budget ) { return budget ; }
+  //
+  const char* env = std::getenv ( "OSTAP_MEMORY_BUDGET" ) ;
+  if ( nullptr == env ) { return 0 ; }
+  const double mb = std::atof ( env ) ;
+  return 0 < mb ? std::size_t ( mb * ( 1ul << 20 ) ) : 0 ;
+}
+// ============================================================================
+// set the memory budget (in bytes), zero means no limit
+// ============================================================================
+std::size_t Ostap::Utils::set_memory_budget ( const std::size_t bytes )
+{
+  const std::size_t previous = s_budget.exchange ( bytes ) ;
+  return std::numeric_limits<std::size_t>::max () != previous ? previous : 0 ;
+}
+// ============================================================================
+// the memory still available within the budget
+// ============================================================================
+std::size_t Ostap::Utils::memory_available ()
+{
+  const std::size_t budget = memory_budget () ;
+  if ( 0 == budget ) { return std::numeric_limits<std::size_t>::max () ; }
+  const std::size_t used   = rss () ;
+  return used < budget ? budget - used : 0 ;
+}
+// ============================================================================
+// how many copies of the object of given size fit into the available memory?
+// ============================================================================
+std::size_t Ostap::Utils::copies_in_budget
+( const std::size_t size ,
+  const std::size_t n    )
+{
+  if ( 0 == size || 0 == memory_budget () ) { return n ; }
+  return std::min ( n , memory_available () / size ) ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
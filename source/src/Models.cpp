@@ -132,6 +132,23 @@ double Ostap::Math::Gumbel::pdf  ( const double x ) const
   return std::abs ( m_beta ) * std::exp ( -( z + std::exp ( -z ) ) ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Gumbel::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const long double ibeta = 1/m_beta ;
+  const double      scale = std::abs ( m_beta ) ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const long double z = ( x [ i ] - m_mu ) * ibeta ;
+    result [ i ] = scale * std::exp ( -( z + std::exp ( -z ) ) ) ;
+  }
+}
+// ============================================================================
 // get CDF
 // ============================================================================
 double Ostap::Math::Gumbel::cdf ( const double x ) const 
@@ -401,6 +418,27 @@ double Ostap::Math::PhaseSpacePol::evaluate ( const double x ) const
   //
   return m_positive ( x ) * m_phasespace ( x ) ;
 }
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::PhaseSpacePol::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  //
+  // the polynomial part (zero outside its range) 
+  m_positive.evaluate ( n , x , result ) ;
+  //
+  // the phase space part 
+  const double xlow  = m_phasespace . lowEdge () ;
+  const double xhigh = m_phasespace .highEdge () ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    if ( x [ i ] < xlow || x [ i ] > xhigh ) { result [ i ]  = 0                        ; } 
+    else if ( 0 != result [ i ]          ) { result [ i ] *= m_phasespace ( x [ i ] ) ; }
+  }
+}
 // =====================================================================
 // destructor 
 // =====================================================================
@@ -789,6 +827,23 @@ double Ostap::Math::GammaDist::pdf ( const double x ) const
   return my_exp ( result ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::GammaDist::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double itheta = 1 / m_theta ;
+  const double k1     = m_k - 1    ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    result [ i ] = xi <= 0 ? 0.0 : my_exp ( m_aux - xi * itheta + k1 * my_log ( xi ) ) ;
+  }
+}
+// ============================================================================
 // get the integral
 // ============================================================================
 double Ostap::Math::GammaDist::integral () const { return 1 ; }
@@ -900,6 +955,29 @@ double Ostap::Math::GenGammaDist::pdf ( const double x ) const
   return my_exp ( result ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::GenGammaDist::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double itheta = 1 / theta () ;
+  const double k1     = k () - 1    ;
+  const double aux    = 
+    gsl_sf_log ( p () / theta () ) - gsl_sf_lngamma ( k () / p () ) ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if ( xi <= m_low || s_equal ( xi , m_low ) ) { result [ i ] = 0 ; continue ; }
+    //
+    const double xc = ( xi - m_low ) * itheta ;  
+    const double xt = std::pow ( xc , p () ) ;  
+    result [ i ] = my_exp ( k1 * gsl_sf_log ( xc ) - xt + aux ) ;
+  }
+}
+// ============================================================================
 double Ostap::Math::GenGammaDist::cdf ( const double x ) const 
 {
   //
@@ -1004,6 +1082,31 @@ double Ostap::Math::Amoroso::pdf ( const double x ) const
   return my_exp ( result ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Amoroso::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const bool   positive = theta () > 0 ;
+  const double itheta   = 1 / theta () ;
+  const double ab1      = alpha () * beta () - 1 ;
+  const double aux      = 
+    gsl_sf_log ( std::abs ( beta () / theta () ) ) - gsl_sf_lngamma ( alpha () ) ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if      (  positive && ( xi <= m_a || s_equal ( xi , m_a ) ) ) { result [ i ] = 0 ; continue ; }
+    else if ( !positive && ( xi >= m_a || s_equal ( xi , m_a ) ) ) { result [ i ] = 0 ; continue ; }
+    //
+    const double xc = ( xi - m_a ) * itheta ;
+    const double xt = std::pow ( xc , beta () ) ;
+    result [ i ] = my_exp ( ab1 * gsl_sf_log ( xc ) - xt + aux ) ;
+  }
+}
+// ============================================================================
 double Ostap::Math::Amoroso::cdf ( const double x ) const 
 {
   //
@@ -1287,6 +1390,24 @@ double Ostap::Math::LogGamma::pdf ( const double x ) const
   return my_exp ( result ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::LogGamma::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double ilambda = 1 / lambda () ;
+  const double aux     = 
+    - gsl_sf_log ( std::abs ( lambda () ) ) - gsl_sf_lngamma ( alpha () ) ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xt = ( x [ i ] - nu () ) * ilambda ;
+    result [ i ] = my_exp ( alpha () * xt - my_exp ( xt ) + aux ) ;
+  }
+}
+// ============================================================================
 double Ostap::Math::LogGamma::cdf ( const double x ) const 
 {
   //
@@ -1422,6 +1543,30 @@ double Ostap::Math::BetaPrime::pdf ( const double x ) const
     * std::pow ( 1 + y , - alpha () - beta () ) ;  
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::BetaPrime::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double iscale = 1 / m_scale ;
+  const double norm   = m_aux / std::abs ( m_scale ) ;
+  const double a1     =   alpha () - 1        ;
+  const double ab     = - alpha () - beta ()  ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if      ( m_scale >= 0 && xi <= m_shift ) { result [ i ] = 0 ; continue ; }
+    else if ( m_scale <= 0 && xi >= m_shift ) { result [ i ] = 0 ; continue ; }
+    else if ( s_equal ( xi , m_shift )      ) { result [ i ] = 0 ; continue ; }
+    //
+    const double y = ( xi - m_shift ) * iscale ;
+    result [ i ] = norm * std::pow ( y , a1 ) * std::pow ( 1 + y , ab ) ;
+  }
+}
+// ============================================================================
 double Ostap::Math::BetaPrime::cdf ( const double x ) const 
 {
   //
@@ -1540,6 +1685,19 @@ double Ostap::Math::Landau::pdf ( const double x ) const
   return gsl_ran_landau_pdf ( y ) / m_scale ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Landau::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double iscale = 1 / m_scale ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  { result [ i ] = gsl_ran_landau_pdf ( ( x [ i ] - m_shift ) * iscale ) * iscale ; }
+}
+// ============================================================================
 namespace 
 {
 /* Not needed yet */
@@ -1750,6 +1908,28 @@ double Ostap::Math::Weibull::pdf ( const double x ) const
     std::exp ( - std::pow ( y , m_shape ) ) ;  
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Weibull::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double iscale = 1 / m_scale        ;
+  const double norm   = m_shape * iscale    ;
+  const double k1     = m_shape - 1         ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if ( xi <= m_shift ) { result [ i ] = 0 ; continue ; }
+    //
+    const double y  = ( xi - m_shift ) * iscale ;
+    const double yk = std::pow ( y , m_shape ) ;
+    result [ i ] = norm * std::pow ( y , k1 ) * std::exp ( - yk ) ;
+  }
+}
+// ============================================================================
 bool Ostap::Math::Weibull::setScale  ( const double value ) 
 {
   const double v = std::abs ( value ) ;  
@@ -1921,6 +2101,32 @@ double Ostap::Math::Argus::pdf ( const double x ) const
   return     res / std::abs ( m_high - m_low ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Argus::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double xmin = std::min ( m_high , m_low ) ;
+  const double xmax = std::max ( m_high , m_low ) ;
+  const double c2   = -0.5 * m_shape * m_shape ;
+  const double norm = s_SQRT2PIi 
+    * Ostap::Math::POW ( m_shape , 3 ) / Psi_ ( m_shape ) / std::abs ( m_high - m_low ) ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if ( xi >= xmax || xi <= xmin ) { result [ i ] = 0 ; continue ; }
+    //
+    const double y  = y_ ( xi ) ;
+    if ( y <= 0 || y >= 1 ) { result [ i ] = 0 ; continue ; }
+    //
+    const double y2 = 1 - y * y  ;
+    result [ i ] = norm * y * std::sqrt ( y2 ) * my_exp ( c2 * y2 ) ;
+  }
+}
+// ============================================================================
 // evaluate Argus-CDF 
 // ============================================================================
 double Ostap::Math::Argus::cdf ( const double x ) const 
@@ -2030,6 +2236,29 @@ double Ostap::Math::Sigmoid::operator () ( const double x ) const
     0.5 * m_positive ( x ) * ( 1 + std::tanh ( m_alpha * ( x - m_x0 ) ) ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Sigmoid::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  // the positive polynomial for all points at once 
+  m_positive.evaluate ( n , x , result ) ;
+  //
+  const double xlow  = xmin () ;
+  const double xhigh = xmax () ;
+  const bool   flat  = s_zero ( m_alpha ) ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if ( xi < xlow || xi > xhigh ) { result [ i ] = 0 ; continue ; }
+    //
+    result [ i ] *= flat ? 0.5 : 0.5 * ( 1 + std::tanh ( m_alpha * ( xi - m_x0 ) ) ) ;
+  }
+}
+// ============================================================================
 // get the integral between xmin and xmax 
 // ============================================================================
 double Ostap::Math::Sigmoid::integral   () const 
@@ -2172,6 +2401,27 @@ double Ostap::Math::TwoExpos::integral
       ( std::exp ( -a * xhigh ) - std::exp ( -a * xlow ) ) / a ) / norm ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::TwoExpos::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const long double c  = norm () ;
+  const long double a  = tau1 () ;
+  const long double b  = tau2 () ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if ( xi < m_x0 ) { result [ i ] = 0 ; continue ; }
+    //
+    const long double dx = xi - m_x0 ;
+    result [ i ] = c * ( std::exp ( a * dx ) - std::exp ( b * dx ) ) ;
+  }
+}
+// ============================================================================
 namespace 
 {
   // ==========================================================================
@@ -2370,6 +2620,24 @@ std::size_t Ostap::Math::TwoExpoPositive::tag () const
 
 
 
+// ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /** \f$ \int_{z_l}^{z_h} z^{k} dz \f$ for \f$ 0 < z_l, z_h \f$, 
+   *  numerically stable for \f$ k \rightarrow -1 \f$ 
+   */
+  inline double _zpow_integral_ 
+  ( const double k  , 
+    const double zl , 
+    const double zh ) 
+  {
+    const double k1 = k + 1 ;
+    const double lr = std::log ( zh / zl ) ;
+    return s_zero ( k1 ) ? lr : std::pow ( zl , k1 ) * std::expm1 ( k1 * lr ) / k1 ; 
+  }
+  // ==========================================================================
+}
 // ============================================================================
 // Tsallis function 
 // ============================================================================
@@ -2440,41 +2708,36 @@ double Ostap::Math::Tsallis::integral
   //
   const double _low = std::max ( low , xmin () ) ;
   //
-  // split too large intervals
-  if ( 0 < m_mass ) 
-  {
-    // split points 
-    static const std::array<int,7> s_split = {{ 1 ,  3  , 10 , 20 , 50 , 100 , 1000 }} ;
-    for( const auto p : s_split )
-    {
-      const double middle = m_mass * p ;
-      if (  _low < middle && middle < high ) 
-      { return integral ( _low , middle ) + integral ( middle , high ) ; }
-    }
-  }
-  //
-  // use GSL to evaluate the integral
-  //
-  static const Ostap::Math::GSL::Integrator1D<Tsallis> s_integrator {} ;
-  static char s_message[] = "Integral(Tsallis)" ;
+  // trivial cases 
+  if      ( s_zero ( m_n ) ) { return 0.5 * ( high * high - _low * _low ) ; }
+  else if ( s_zero ( m_T ) ) { return 0 ; }
   //
-  const auto F = s_integrator.make_function ( this ) ;
-  int    ierror   = 0   ;
-  double result   = 1.0 ;
-  double error    = 1.0 ;
-  std::tie ( ierror , result , error ) = s_integrator.gaq_integrate
-    ( tag  () , 
-      &F      , 
-      low     , high  ,              // low & high edges
-      workspace ( m_workspace ) ,    // workspace
-      s_PRECISION         ,          // absolute precision
-      s_PRECISION         ,          // relative precision
-      m_workspace.size()              ,          // size of workspace
-      s_message           , 
-      __FILE__ , __LINE__ ) ;
+  // with u = mT(x) and a = nT : x dx = u du , z = 1 + E_kin/a , u = ( m - a ) + a z 
+  // \int x ( 1 + E_kin/a )^{-n} dx = a \int [ ( m - a ) z^{-n} + a z^{1-n} ] dz 
+  const double a  = m_n * m_T ;
+  const double zl = 1 + eTkin ( _low ) / a ;
+  const double zh = 1 + eTkin ( high ) / a ;
   //
-  return result ;
+  return a * ( ( m_mass - a ) * _zpow_integral_ ( -m_n     , zl , zh ) + 
+               a              * _zpow_integral_ ( 1 - m_n  , zl , zh ) ) ;
+}
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Tsallis::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double ia = 1 / ( m_T * m_n ) ;
+  const double m2 = m_mass * m_mass  ;
   //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    result [ i ] = xi <= 0 ? 0.0 : 
+      xi * std::pow ( 1.0 + ( std::sqrt ( xi * xi + m2 ) - m_mass ) * ia , -m_n ) ;
+  }
 }
 // ============================================================================
 // get the tag
@@ -2548,41 +2811,33 @@ double Ostap::Math::QGSM::integral
   //
   const double _low = std::max ( low , xmin() ) ;
   //
-  // split too large intervals
-  if ( 0 < m_mass ) 
-  {
-    // split points 
-    static const std::array<int,5> s_split = {{ 1 ,  3  , 10 , 20 , 50 }} ;
-    for( const auto p : s_split )
-    {
-      const double middle = m_mass * p ;
-      if (  _low < middle && middle < high ) 
-      { return integral ( _low , middle ) + integral ( middle , high ) ; }
-    }
-  }
-  //
-  // use GSL to evaluate the integral
+  // trivial case 
+  if ( s_zero ( m_b ) ) { return 0.5 * ( high * high - _low * _low ) ; }
   //
-  static const Ostap::Math::GSL::Integrator1D<QGSM> s_integrator {} ;
-  static char s_message [] = "Integral(QGSM)" ;
-  //
-  const auto F = s_integrator.make_function ( this ) ;
-  int    ierror   = 0   ;
-  double result   = 1.0 ;
-  double error    = 1.0 ;
-  std::tie ( ierror , result , error ) = s_integrator.gaq_integrate
-    ( tag  () , 
-      &F      , 
-      low     , high      ,          // low & high edges
-      workspace ( m_workspace ) ,    // workspace
-      s_PRECISION         ,          // absolute precision
-      s_PRECISION         ,          // relative precision
-      m_workspace.size()              ,          // size of workspace
-      s_message           , 
-      __FILE__ , __LINE__ ) ;
+  // with u = mT(x) : x dx = u du and 
+  // \int u exp ( -b ( u - m ) ) du = - exp ( -b ( u - m ) ) * ( u / b + 1 / b^2 ) 
+  const double ib = 1 / m_b ;
+  const double fl = std::exp ( -m_b * eTkin ( _low ) ) * ( mT ( _low ) + ib ) ;
+  const double fh = std::exp ( -m_b * eTkin ( high ) ) * ( mT ( high ) + ib ) ;
   //
-  return result ;
+  return ( fl - fh ) * ib ;
+}
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::QGSM::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double m2 = m_mass * m_mass  ;
   //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    result [ i ] = xi <= 0 ? 0.0 : 
+      xi * std::exp ( -m_b * ( std::sqrt ( xi * xi + m2 ) - m_mass ) ) ;
+  }
 }
 // ============================================================================
 // get the tag
@@ -2644,6 +2899,26 @@ double Ostap::Math::CutOffGauss::operator() ( const double x ) const
   return std::exp ( -0.5 * dx * dx ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::CutOffGauss::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double isigma = 1 / m_sigma ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if      (  m_right && xi <= m_x0 ) { result [ i ] = 1 ; continue ; }
+    else if ( !m_right && xi >= m_x0 ) { result [ i ] = 1 ; continue ; }
+    //
+    const double dx = ( xi - m_x0 ) * isigma ;
+    result [ i ] = std::exp ( -0.5 * dx * dx ) ;
+  }
+}
+// ============================================================================
 // get the integral between low and high
 // ============================================================================
 double Ostap::Math::CutOffGauss::integral
@@ -2745,6 +3020,28 @@ double Ostap::Math::CutOffStudent::operator() ( const double x ) const
   return std::pow ( 1 + dx * dx / m_nu , -0.5 * ( m_nu + 1 ) ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::CutOffStudent::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double isigma = 1 / m_sigma ;
+  const double inu    = 1 / m_nu    ;
+  const double p      = -0.5 * ( m_nu + 1 ) ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if      (  m_right && xi <= m_x0 ) { result [ i ] = 1 ; continue ; }
+    else if ( !m_right && xi >= m_x0 ) { result [ i ] = 1 ; continue ; }
+    //
+    const double dx = ( xi - m_x0 ) * isigma ;
+    result [ i ] = std::pow ( 1 + dx * dx * inu , p ) ;
+  }
+}
+// ============================================================================
 // get the integral between low and high
 // ============================================================================
 double Ostap::Math::CutOffStudent::integral
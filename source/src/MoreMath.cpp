@@ -9,6 +9,8 @@
 #include <complex>
 #include <cassert>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 // ============================================================================
 // GSL 
 // ============================================================================
@@ -213,21 +215,148 @@ double Ostap::Math::exp_rel_N ( const double x , const unsigned short N )
     _exp_rel_N_ ( y , N ) ;  
 }
 // ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /** exponent, written in a branch-free way, such that the loops over 
+   *  arrays can be vectorized by the compiler 
+   *  - Cody-Waite reduction \f$ x = k \ln 2 + r \f$, \f$ |r| \le \frac{\ln 2}{2}\f$
+   *  - Taylor polynomial of degree 13 for \f$ e^r \f$
+   *  - \f$ 2^k\f$ is constructed directly from the bits 
+   *  The relative precision is better than \f$ 3\cdot10^{-16}\f$, 
+   *  the results below \f$ e^{-708}\f$ are flushed to zero 
+   */
+  inline double _exp_ ( const double x ) 
+  {
+    static const double s_log2e = 1.4426950408889634074    ;
+    static const double s_ln2hi = 6.93147180369123816490e-01 ;
+    static const double s_ln2lo = 1.90821492927058770002e-10 ;
+    /// 1.5*2^52: rounding to the integer and the integer in the low bits 
+    static const double s_shift = 6755399441055744.0       ;
+    static const double s_xmin  = -708.0                   ;
+    static const double s_xmax  =  709.78                  ;
+    //
+    const double  xc = x < s_xmin ? s_xmin : x > s_xmax ? s_xmax : x ;
+    double        kd = xc * s_log2e + s_shift ;
+    std::uint64_t ki ;
+    std::memcpy ( &ki , &kd , sizeof ( ki ) ) ;
+    kd -= s_shift ;
+    const double  r  = ( xc - kd * s_ln2hi ) - kd * s_ln2lo ;
+    //
+    double p = 1.0 / 6227020800.0 ;
+    p = p * r + 1.0 / 479001600.0 ;
+    p = p * r + 1.0 / 39916800.0  ;
+    p = p * r + 1.0 / 3628800.0   ;
+    p = p * r + 1.0 / 362880.0    ;
+    p = p * r + 1.0 / 40320.0     ;
+    p = p * r + 1.0 / 5040.0      ;
+    p = p * r + 1.0 / 720.0       ;
+    p = p * r + 1.0 / 120.0       ;
+    p = p * r + 1.0 / 24.0        ;
+    p = p * r + 1.0 / 6.0         ;
+    p = p * r + 0.5               ;
+    p = p * r + 1.0               ;
+    p = p * r + 1.0               ;
+    //
+    // 2^(k-1): k-1+1023 is always within [1,2046] 
+    const std::uint64_t eb = ( ki + 1022 ) << 52 ;
+    double scale ;
+    std::memcpy ( &scale , &eb , sizeof ( scale ) ) ;
+    const double result = 2 * p * scale ;
+    //
+    return 
+      x < s_xmin ? 0.0 : 
+      x > s_xmax ? std::numeric_limits<double>::infinity() : result ;
+  }
+  // ==========================================================================
+  /// \f$ f(x) = \frac{e^x-1}{x}\f$
+  inline double _exprel_ ( const double x ) 
+  {
+    const long double y = x ;
+    return
+      x < GSL_LOG_DBL_MIN ? -1.0 / y             : // RETURN
+      x > GSL_LOG_DBL_MAX ? s_infinity           : // RETURN 
+      0 == x              ? 1.0                  : // RETURN 
+      1 > std::abs ( x )  ? std::expm1 ( y ) / y : // RETURN 
+      ( std::exp ( y ) - 1 ) / y ;
+  }
+  // ==========================================================================
+  /** inverse gamma function \f$ \frac{1}{\Gamma(x)}\f$ 
+   *  long double is used to keep the full double precision 
+   */
+  inline double _igamma_ ( const double x ) 
+  {
+    return 
+      ( x > 170 || ( x <= 0 && x == std::floor ( x ) ) ) ? 0.0 : 
+      double ( 1 / std::tgamma ( static_cast<long double> ( x ) ) ) ;
+  }
+  // ==========================================================================
+  /** psi (digamma) function 
+   *  - reflection \f$ \psi(x) = \psi(1-x) - \pi \cot \pi x \f$ for \f$ x<0\f$
+   *  - recurrence \f$ \psi(x) = \psi(x+1) - \frac{1}{x}\f$ up to \f$ x \ge 10 \f$
+   *  - asymptotic expansion with seven Bernoulli terms 
+   *  The calculations are performed with long doubles to avoid 
+   *  the loss of precision near the root of \f$ \psi\f$ 
+   */
+  inline double _psi_ ( const double x ) 
+  {
+    if ( x <= 0 && x == std::floor ( x ) ) 
+    { return std::numeric_limits<double>::quiet_NaN () ; }        // RETURN 
+    //
+    long double z      = x ;
+    long double result = 0 ;
+    if ( z < 0 ) 
+    {
+      // cot ( pi x ) = cot ( pi ( x - round ( x ) ) ) 
+      const long double r = z - std::round ( x ) ;
+      result = - M_PI / std::tan ( M_PI * r ) ;
+      z      = 1 - z ;
+    }
+    for ( ; z < 10 ; z += 1 ) { result -= 1 / z ; }
+    //
+    const long double iz2 = 1 / ( z * z ) ;
+    const long double s   = iz2 * ( 1.0L / 12 - iz2 * ( 1.0L / 120 - 
+                            iz2 * ( 1.0L / 252 - iz2 * ( 1.0L / 240 - 
+                            iz2 * ( 1.0L / 132 - iz2 * ( 691.0L / 32760 - iz2 / 12 ) ) ) ) ) ) ;
+    //
+    return result + ( std::log ( z ) - 0.5L / z - s ) ;
+  }
+  // ==========================================================================
+  /// gaussian cdf for the scaled argument \f$ y = \frac{x-\mu}{\sqrt{2}\sigma}\f$
+  inline double _gauss_cdf_ ( const double y ) 
+  { return y < 0 ? 0.5 * std::erfc ( -y ) : 0.5 * ( 1 + std::erf ( y ) ) ; }
+  // ==========================================================================
+  /// gaussian integral for the scaled limits 
+  inline double _gauss_int_ ( const double ya , const double yb ) 
+  {
+    return 
+      ( std::max ( ya , yb ) < -3 ) ? 
+      0.5 * ( std::erfc ( std::abs ( yb ) ) - std::erfc ( std::abs ( ya ) ) ) :
+      ( std::min ( ya , yb ) >  3 ) ? 
+      0.5 * ( std::erfc (            ya   ) - std::erfc (            yb   ) ) :
+      0.5 * ( std::erf ( yb ) - std::erf ( ya ) ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
 /*  compute \f$ f(x) = \frac{e^x-1}{x}\f$
  *  @return the value of psi function 
  *  @see exp_rel_N 
  */        
 // ============================================================================
-double Ostap::Math::exprel ( const double x ) 
-{
-  //
-  const long double y = x ;
-  return
-    x < GSL_LOG_DBL_MIN ? -1.0 / y             : // RETURN
-    x > GSL_LOG_DBL_MAX ? s_infinity           : // RETURN 
-    1 > std::abs ( x )  ? std::expm1 ( y ) / y : // RETURN 
-    ( std::exp ( y ) - 1 ) / y ;
-}
+double Ostap::Math::exprel ( const double x ) { return _exprel_ ( x ) ; }
+// ============================================================================
+/*  compute \f$ f(x) = \frac{e^x-1}{x}\f$ for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of arguments 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::exprel 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) 
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = _exprel_ ( x [ i ] ) ; } }
 // ============================================================================
 namespace
 {
@@ -645,6 +774,18 @@ double Ostap::Math::kummer
 // ============================================================================
 double Ostap::Math::erfcx ( const double x ) { return Faddeeva::erfcx ( x ) ; }
 // ============================================================================
+/*  scaled complementary error function for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of arguments 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::erfcx 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) 
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = Faddeeva::erfcx ( x [ i ] ) ; } }
+// ============================================================================
 /*  scaled complementary error function 
  *  \f$ 1 -  erf (x) = e^{-x^2} erfcx(x)  \f$ 
  *  @param x  the argument 
@@ -673,6 +814,126 @@ std::complex<double>
 Ostap::Math::faddeeva_w ( const std::complex<double>& x ) 
 { return Faddeeva::w ( x ) ; }
 // ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /** @class Weideman 
+   *  Rational approximation for Faddeeva function with N=32 terms 
+   *  @see J.A.C. Weideman, "Computation of the Complex Error Function", 
+   *       SIAM Journal on Numerical Analysis, 31 (1994) 1497
+   *  @see https://doi.org/10.1137/0731077
+   */
+  class Weideman 
+  {
+  public:
+    // ========================================================================
+    enum { N = 32 } ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    Weideman () 
+      : m_L ( std::sqrt ( N / std::sqrt ( 2.0 ) ) ) 
+    {
+      const int M  = 2 * N ;
+      const int M2 = 2 * M ;
+      // the samples of the function at t = L*tan(theta/2)
+      std::array<double,2*M> f ;
+      f [ 0 ] = 0 ;
+      for ( int k = 1 ; k < M2 ; ++k ) 
+      {
+        const double t = m_L * std::tan ( 0.5 * ( k - M ) * M_PI / M ) ;
+        f [ k ] = std::exp ( -t * t ) * ( m_L * m_L + t * t ) ;
+      }
+      // the (shifted) discrete Fourier transform, highest coefficient first 
+      for ( int n = 1 ; n <= N ; ++n ) 
+      {
+        double sum = 0 ;
+        for ( int j = 0 ; j < M2 ; ++j ) 
+        { sum += f [ ( j + M ) % M2 ] * std::cos ( 2 * M_PI * j * n / M2 ) ; }
+        m_a [ N - n ] = sum / M2 ;
+      }
+    }
+    // ========================================================================
+    /// evaluate w(z) for Im(z)>0 
+    inline std::complex<double> 
+    operator() ( const double x , const double y ) const 
+    {
+      // 1/(L-iz)
+      const double ar = m_L + y ;
+      const double d  = 1 / ( ar * ar + x * x ) ;
+      const double dr = ar * d ;
+      const double di = x  * d ;
+      // Z = (L+iz)/(L-iz)
+      const double br = m_L - y ;
+      const double Zr = br * dr - x  * di ;
+      const double Zi = br * di + x  * dr ;
+      // Horner's scheme
+      double pr = m_a [ 0 ] ;
+      double pi = 0 ;
+      for ( unsigned short k = 1 ; k < N ; ++k ) 
+      {
+        const double qr = pr * Zr - pi * Zi + m_a [ k ] ;
+        pi              = pr * Zi + pi * Zr ;
+        pr              = qr ;
+      }
+      // 2 p/(L-iz)^2 + 1/sqrt(pi)/(L-iz)
+      const double er = dr * dr - di * di ;
+      const double ei = 2 * dr * di ;
+      return std::complex<double> 
+        ( 2 * ( pr * er - pi * ei ) + s_ISQRTPI * dr , 
+          2 * ( pr * ei + pi * er ) + s_ISQRTPI * di ) ;
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// 1/sqrt(pi)
+    static constexpr double s_ISQRTPI = 0.56418958354775628694807945156 ;
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// scale parameter 
+    double               m_L ;
+    /// coefficients 
+    std::array<double,N> m_a ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  constexpr double Weideman::s_ISQRTPI ;
+  // ==========================================================================
+}
+// ============================================================================
+/*  compute Faddeeva "w" function for the array of arguments 
+ *  w(z) = exp(-z^2) erfc(-iz) [ Faddeeva / scaled complex error func ]
+ *  - in the central region the rational approximation by 
+ *    J.A.C.Weideman is used 
+ *  - elsewhere the scalar function is used 
+ *  @see J.A.C. Weideman, "Computation of the Complex Error Function", 
+ *       SIAM Journal on Numerical Analysis, 31 (1994) 1497
+ *  @see https://doi.org/10.1137/0731077
+ *  @param n      (INPUT)  number of points 
+ *  @param z      (INPUT)  array of arguments 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::faddeeva_w 
+( const std::size_t           n      , 
+  const std::complex<double>* z      , 
+  std::complex<double>*       result ) 
+{
+  static const Weideman s_weideman {} ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double x = z [ i ].real () ;
+    const double y = z [ i ].imag () ;
+    //
+    // outside the central region the continued fraction 
+    // (large |z|) or algorithm 916 (small Im(z)) are used 
+    result [ i ] = 
+      0.5 <= y && y <= 7 && std::abs ( x ) <= 6 ? 
+      s_weideman ( x , y ) : Faddeeva::w ( z [ i ] ) ;
+  }
+}
+// ============================================================================
 /*  complex error function (the error function of complex arguments)
  *  @param x  the argument 
  *  @return the value of the coplmex error function 
@@ -747,50 +1008,38 @@ std::complex<double> Ostap::Math::sech
  *  @return the value of inverse Gamma functions 
  */
 // ============================================================================
-double Ostap::Math::igamma ( const double x ) 
-{
-  if ( x > 170 || ( x<=0 && Ostap::Math::isint ( x ) ) ) { return 0 ; }  // RETURN 
-  // use GSL: 
-  Ostap::Math::GSL::GSL_Error_Handler sentry ;
-  //
-  gsl_sf_result result ;
-  const int ierror = gsl_sf_gammainv_e ( x , &result ) ;
-  if ( ierror ) 
-  {
-    //
-    gsl_error ( "Error from gsl_sf_gammainv_e" , __FILE__ , __LINE__ , ierror ) ;
-    if      ( ierror == GSL_EDOM     ) // input domain error, e.g sqrt(-1)
-    { return std::numeric_limits<double>::quiet_NaN(); }
-    //
-  }
-  //
-  return result.val ;
-}
+double Ostap::Math::igamma ( const double x ) { return _igamma_ ( x ) ; }
+// ============================================================================
+/*  compute inverse Gamma function for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of arguments 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::igamma 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) 
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = _igamma_ ( x [ i ] ) ; } }
 // ============================================================================
 /*  compute psi function 
  *  \$f f(x) = \frac{d}{dx}\ln \Gamma(x)\f$
  *  @return the value of psi function 
  */
-// ============================================================================G
-double Ostap::Math::psi ( const double x ) 
-{
-  //
-  // use GSL: 
-  Ostap::Math::GSL::GSL_Error_Handler sentry ( false )  ;
-  //
-  gsl_sf_result result ;
-  const int ierror = gsl_sf_psi_e ( x , &result ) ;
-  if ( ierror ) 
-  {
-    //
-    gsl_error ( "Error from gsl_sf_psi_e" , __FILE__ , __LINE__ , ierror ) ;
-    if      ( ierror == GSL_EDOM     ) // input domain error, e.g sqrt(-1)
-    { return std::numeric_limits<double>::quiet_NaN(); }
-    //
-  }
-  //
-  return result.val ;
-}
+// ============================================================================
+double Ostap::Math::psi ( const double x ) { return _psi_ ( x ) ; }
+// ============================================================================
+/*  compute psi function for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of arguments 
+ *  @param result (UPDATE) array of results 
+ */
+// ============================================================================
+void Ostap::Math::psi 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) 
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = _psi_ ( x [ i ] ) ; } }
 // ============================================================================
 
 
@@ -870,7 +1119,32 @@ double Ostap::Math::gauss_pdf
 {
   static const double s_norm = 1.0/std::sqrt( 2.0 * M_PI ) ;
   const double dx = ( x  - mu ) / std::abs ( sigma ) ;
-  return s_norm * std::exp ( -0.5 * dx * dx ) / std::abs ( sigma ) ;
+  return s_norm * _exp_ ( -0.5 * dx * dx ) / std::abs ( sigma ) ;
+}
+// ============================================================================
+/*  get the gaussian pdf for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of arguments 
+ *  @param result (UPDATE) array of results 
+ *  @param mu     (INPUT)  mu (location)
+ *  @param sigma  (INPUT)  sigma (width)  
+ */
+// ============================================================================
+void Ostap::Math::gauss_pdf
+( const std::size_t n      ,
+  const double*     x      ,
+  double*           result , 
+  const double      mu     ,
+  const double      sigma  )
+{
+  static const double s_norm = 1.0/std::sqrt( 2.0 * M_PI ) ;
+  const double i_s  = 1 / std::abs ( sigma ) ;
+  const double norm = s_norm * i_s ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double dx = ( x [ i ] - mu ) * i_s ;
+    result [ i ] = norm * _exp_ ( -0.5 * dx * dx ) ;
+  }
 }
 // ============================================================================
 /*  get the standard gaussian cdf 
@@ -888,7 +1162,28 @@ double Ostap::Math::gauss_cdf
   //
   static const double s_sqrt2 = std::sqrt( 2.0 ) ;
   const double y = ( x - mu ) / ( s_sqrt2 * std::abs ( sigma ) ) ;
-  return 0.5 * ( 1 + std::erf ( y ) ) ;
+  return _gauss_cdf_ ( y ) ;
+}
+// ============================================================================
+/*  get the gaussian cdf for the array of points 
+ *  @param n      (INPUT)  number of points 
+ *  @param x      (INPUT)  array of arguments 
+ *  @param result (UPDATE) array of results 
+ *  @param mu     (INPUT)  mu (location)
+ *  @param sigma  (INPUT)  sigma (width)  
+ */
+// ============================================================================
+void Ostap::Math::gauss_cdf 
+( const std::size_t n      ,
+  const double*     x      ,
+  double*           result , 
+  const double      mu     ,
+  const double      sigma  )
+{
+  static const double s_sqrt2 = std::sqrt( 2.0 ) ;
+  const double i_s = 1 / ( s_sqrt2 * std::abs ( sigma ) ) ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  { result [ i ] = _gauss_cdf_ ( ( x [ i ] - mu ) * i_s ) ; }
 }
 // ============================================================================
 /*  get the Gaussian integral 
@@ -915,12 +1210,30 @@ double Ostap::Math::gauss_int
   const double ya = ( a - mu ) * i_s ;
   const double yb = ( b - mu ) * i_s ;
   //
-  return 
-    ( std::max ( ya , yb ) < -3 ) ? 
-    0.5 * ( std::erfc ( std::abs ( yb ) ) - std::erfc ( std::abs ( ya ) ) ) :
-    ( std::min ( ya , yb ) >  3 ) ? 
-    0.5 * ( std::erfc (            ya   ) - std::erfc (            yb   ) ) :
-    0.5 * ( std::erf ( yb ) - std::erf ( ya ) ) ;
+  return _gauss_int_ ( ya , yb ) ;
+}
+// ============================================================================
+/*  get the Gaussian integrals for the arrays of integration limits 
+ *  @param n      (INPUT)  number of intervals 
+ *  @param a      (INPUT)  array of low  integration limits 
+ *  @param b      (INPUT)  array of high integration limits 
+ *  @param result (UPDATE) array of results 
+ *  @param mu     (INPUT)  location of Gaussian
+ *  @param sigma  (INPUT)  width of the Gaussian
+ */
+// ============================================================================
+void Ostap::Math::gauss_int
+( const std::size_t n      ,
+  const double*     a      ,
+  const double*     b      ,
+  double*           result , 
+  const double      mu     ,
+  const double      sigma  )
+{
+  static const double s_sqrt2 = std::sqrt( 2.0 ) ;
+  const double i_s = 1 / ( s_sqrt2 * std::abs ( sigma ) ) ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  { result [ i ] = _gauss_int_ ( ( a [ i ] - mu ) * i_s , ( b [ i ] - mu ) * i_s ) ; }
 }
 // ============================================================================
 /*  Student's t-CDF 
@@ -1,6 +1,12 @@
 // ============================================================================
 // Include files 
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+// ============================================================================
 // ROOT/RooFit 
 // ============================================================================
 #include "RooAbsReal.h"
@@ -56,6 +62,7 @@ ClassImp(Ostap::MoreRooFit::TwoVars       )
 ClassImp(Ostap::MoreRooFit::FunOneVar     )
 ClassImp(Ostap::MoreRooFit::FunTwoVars    )
 ClassImp(Ostap::MoreRooFit::ProductPdf    )
+ClassImp(Ostap::MoreRooFit::AddPdf        )
 // ============================================================================
 namespace 
 {
@@ -786,6 +793,322 @@ Double_t Ostap::MoreRooFit::ProductPdf::evaluate () const
 }
 // ============================================================================
 
+
+// ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /// the maximal number of cached entries per component 
+  std::atomic<std::size_t> s_MAX_CACHE { 5000000 } ;
+  // ==========================================================================
+  /// get the current values of parameters
+  void values_
+  ( const RooArgSet*     pars   ,
+    std::vector<double>& result )
+  {
+    result.clear () ;
+    if ( nullptr == pars ) { return ; }
+    for ( const RooAbsArg* a : *pars )
+    {
+      const RooAbsReal* r = dynamic_cast<const RooAbsReal*> ( a ) ;
+      if ( nullptr != r ) { result.push_back ( r->getVal () ) ; }
+    }
+  }
+  // ==========================================================================
+  /// get the names of variables 
+  std::string names_ ( const RooArgSet* vars ) 
+  {
+    std::string result {} ;
+    if ( nullptr == vars ) { return result ; }
+    for ( const RooAbsArg* a : *vars ) 
+    { result += a->GetName () ; result += ',' ; }
+    return result ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor from name, title, pdfs and coefficients
+// ============================================================================
+Ostap::MoreRooFit::AddPdf::AddPdf 
+( const char*       name      , 
+  const char*       title     , 
+  const RooArgList& pdfs      , 
+  const RooArgList& coefs     , 
+  const bool        recursive ) 
+  : RooAbsPdf   ( name , title ) 
+    //
+  , m_pdfs      ( "!pdfs"  , "The components"     , this ) 
+  , m_coefs     ( "!coefs" , "The yields/fractions" , this ) 
+  , m_recursive ( recursive ) 
+{
+  for ( RooAbsArg* a : pdfs ) 
+  {
+    Ostap::Assert ( nullptr != dynamic_cast<RooAbsPdf*> ( a ) , 
+                    std::string ( "Invalid PDF "  ) + a->GetName () , 
+                    "Ostap::MoreRooFit::AddPdf" ) ;
+    m_pdfs.add ( *a ) ;
+  }
+  for ( RooAbsArg* a : coefs ) 
+  {
+    Ostap::Assert ( nullptr != dynamic_cast<RooAbsReal*> ( a ) , 
+                    std::string ( "Invalid coefficient " ) + a->GetName () , 
+                    "Ostap::MoreRooFit::AddPdf" ) ;
+    m_coefs.add ( *a ) ;
+  }
+  //
+  Ostap::Assert ( 0 < m_pdfs.getSize () && 
+                  ( m_pdfs.getSize () == m_coefs.getSize ()       ||   
+                    m_pdfs.getSize () == m_coefs.getSize () + 1 ) , 
+                  "Mismatch in number of PDFs/coefficients"       , 
+                  "Ostap::MoreRooFit::AddPdf" ) ;
+}
+// ============================================================================
+// "copy" constructor 
+// ============================================================================
+Ostap::MoreRooFit::AddPdf::AddPdf 
+( const Ostap::MoreRooFit::AddPdf& right , 
+  const char*                      name  ) 
+  : RooAbsPdf   ( right , name ) 
+    //
+  , m_pdfs      ( "!pdfs"  , this , right.m_pdfs  ) 
+  , m_coefs     ( "!coefs" , this , right.m_coefs ) 
+  , m_recursive ( right.m_recursive ) 
+{}
+// ============================================================================
+// destructor 
+// ============================================================================
+Ostap::MoreRooFit::AddPdf::~AddPdf(){}
+// ============================================================================
+// clone 
+// ============================================================================
+Ostap::MoreRooFit::AddPdf*
+Ostap::MoreRooFit::AddPdf::clone ( const char* newname ) const 
+{ return new Ostap::MoreRooFit::AddPdf ( *this , newname ) ; }
+// ============================================================================
+// the maximal number of cached entries per component 
+// ============================================================================
+std::size_t Ostap::MoreRooFit::AddPdf::maxCache    () { return s_MAX_CACHE ; }
+// ============================================================================
+// set the maximal number of cached entries per component 
+// ============================================================================
+void Ostap::MoreRooFit::AddPdf::setMaxCache ( const std::size_t value ) 
+{ s_MAX_CACHE = value ; }
+// ============================================================================
+// hash for the cache key 
+// ============================================================================
+std::size_t Ostap::MoreRooFit::AddPdf::KeyHash::operator() 
+  ( const Ostap::MoreRooFit::AddPdf::Key& key ) const 
+{
+  std::size_t seed = 0 ;
+  for ( const double v : key ) 
+  { seed ^= std::hash<double>() ( v ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 ) ; }
+  return seed ;
+}
+// ============================================================================
+// extended PDF ? 
+// ============================================================================
+RooAbsPdf::ExtendMode Ostap::MoreRooFit::AddPdf::extendMode () const 
+{ return extended () ? RooAbsPdf::CanBeExtended : RooAbsPdf::CanNotBeExtended ; }
+// ============================================================================
+// expected number of events 
+// ============================================================================
+Double_t Ostap::MoreRooFit::AddPdf::expectedEvents ( const RooArgSet* /* nset */ ) const 
+{
+  if ( !extended () ) { return 0 ; }
+  double sum = 0 ;
+  for ( const RooAbsArg* a : m_coefs ) 
+  { sum += static_cast<const RooAbsReal*> ( a )->getVal () ; }
+  return sum ;
+}
+// ============================================================================
+// clear the cache 
+// ============================================================================
+void Ostap::MoreRooFit::AddPdf::clearCache () const 
+{
+  m_synced = false ;
+  m_cache      .clear () ;
+  m_parameters .clear () ;
+  m_snapshots  .clear () ;
+  m_observables.clear () ;
+}
+// ============================================================================
+// calculate the coefficients 
+// ============================================================================
+void Ostap::MoreRooFit::AddPdf::coefficients_ () const 
+{
+  const unsigned int nc = m_pdfs.getSize () ;
+  m_coefficients.resize ( nc ) ;
+  //
+  if ( extended () ) 
+  {
+    double sum = 0 ;
+    for ( unsigned int k = 0 ; k < nc ; ++k ) 
+    { sum += ( m_coefficients [ k ] = static_cast<const RooAbsReal*> ( m_coefs.at ( k ) )->getVal () ) ; }
+    if ( 0 == sum ) { std::fill ( m_coefficients.begin () , m_coefficients.end () , 0.0 ) ; }
+    else { for ( double& c : m_coefficients ) { c /= sum ; } }
+    return ;
+  }
+  //
+  double last = 1 ;
+  for ( unsigned int k = 0 ; k + 1 < nc ; ++k ) 
+  {
+    const double f = static_cast<const RooAbsReal*> ( m_coefs.at ( k ) )->getVal () ;
+    if ( m_recursive ) { m_coefficients [ k ] = last * f ; last *= ( 1 - f ) ; }
+    else               { m_coefficients [ k ] =        f ; last -=       f   ; }
+  }
+  m_coefficients [ nc - 1 ] = last ;
+}
+// ============================================================================
+// synchronize the cache with the normalization set 
+// ============================================================================
+void Ostap::MoreRooFit::AddPdf::sync_ ( const RooArgSet* nset ) const 
+{
+  if ( m_synced && nset == m_nset ) { return ; }
+  //
+  clearCache () ;
+  m_nset      = nset ;
+  m_synced    = true ;
+  m_cacheable = false ;
+  //
+  // no normalization: the observables are not known
+  if ( nullptr == nset || 0 == nset->getSize () ) { return ; }
+  //
+  for ( const RooAbsArg* a : *nset ) 
+  {
+    const RooAbsReal* r = dynamic_cast<const RooAbsReal*> ( a ) ;
+    if ( nullptr == r ) { m_observables.clear () ; return ; }    // e.g. categories 
+    m_observables.push_back ( r ) ;
+  }
+  if ( std::tuple_size<Key>::value < m_observables.size () ) { m_observables.clear () ; return ; }
+  //
+  const unsigned int nc = m_pdfs.getSize () ;
+  m_cache     .resize ( nc ) ;
+  m_snapshots .resize ( nc ) ;
+  m_parameters.resize ( nc ) ;
+  for ( unsigned int k = 0 ; k < nc ; ++k ) 
+  {
+    const RooAbsPdf& pdf = static_cast<const RooAbsPdf&> ( *m_pdfs.at ( k ) ) ;
+    m_parameters [ k ].reset ( pdf.getParameters ( *nset ) ) ;
+    values_ ( m_parameters [ k ].get () , m_snapshots [ k ] ) ;
+  }
+  //
+  m_cacheable = true ;
+}
+// ============================================================================
+// the parameters of the component are changed?
+// ============================================================================
+bool Ostap::MoreRooFit::AddPdf::changed_ ( const unsigned int component ) const
+{
+  std::vector<double>& snapshot = m_snapshots [ component ] ;
+  const std::vector<double> previous { snapshot } ;
+  values_ ( m_parameters [ component ].get () , snapshot ) ;
+  return previous != snapshot ;
+}
+// ============================================================================
+// the main method 
+// ============================================================================
+Double_t Ostap::MoreRooFit::AddPdf::evaluate () const
+{
+  sync_         ( _normSet ) ;
+  coefficients_ () ;
+  //
+  Key key ;
+  key.fill ( 0.0 ) ;
+  if ( m_cacheable ) 
+  { for ( std::size_t i = 0 ; i < m_observables.size () ; ++i ) { key [ i ] = m_observables [ i ]->getVal () ; } }
+  //
+  const std::size_t  maxsize = s_MAX_CACHE ;
+  const unsigned int nc      = m_pdfs.getSize () ;
+  //
+  double result = 0 ;
+  for ( unsigned int k = 0 ; k < nc ; ++k ) 
+  {
+    const RooAbsPdf& pdf = static_cast<const RooAbsPdf&> ( *m_pdfs.at ( k ) ) ;
+    if ( !pdf.isSelectedComp () ) { continue ; }
+    //
+    const double c = m_coefficients [ k ] ;
+    //
+    if ( !m_cacheable ) 
+    {
+      result += c * pdf.getVal ( m_nset ) ;
+      ++m_evaluations ;
+      continue ;
+    }
+    //
+    Cache& cache = m_cache [ k ] ;
+    if ( changed_ ( k ) ) { cache.clear () ; }
+    //
+    Cache::const_iterator found = cache.find ( key ) ;
+    if ( cache.end () != found ) { result += c * found->second ; continue ; }
+    //
+    const double value = pdf.getVal ( m_nset ) ;
+    ++m_evaluations ;
+    if ( cache.size () < maxsize ) { cache.emplace ( key , value ) ; }
+    result += c * value ;
+  }
+  //
+  return result ;
+}
+// ============================================================================
+// integrals are delegated to the components 
+// ============================================================================
+Int_t Ostap::MoreRooFit::AddPdf::getAnalyticalIntegralWN 
+( RooArgSet&       allVars   , 
+  RooArgSet&       analVars  , 
+  const RooArgSet* normSet   ,
+  const char*      rangeName ) const 
+{
+  if ( 0 == allVars.getSize () ) { return 0 ; }
+  //
+  const std::string key = 
+    names_ ( &allVars ) + '|' + names_ ( normSet ) + '|' + 
+    ( nullptr == rangeName ? "" : rangeName ) ;
+  //
+  analVars.add ( allVars ) ;
+  //
+  std::vector<std::string>::const_iterator found = 
+    std::find ( m_keys.begin () , m_keys.end () , key ) ;
+  if ( m_keys.end () != found ) { return found - m_keys.begin () + 1 ; }
+  //
+  const RooArgSet nset { nullptr == normSet ? RooArgSet () : *normSet } ;
+  std::vector<std::unique_ptr<RooAbsReal> > integrals ;
+  for ( const RooAbsArg* a : m_pdfs ) 
+  {
+    const RooAbsPdf* pdf = static_cast<const RooAbsPdf*> ( a ) ;
+    integrals.emplace_back ( pdf->createIntegral ( allVars , nset , rangeName ) ) ;
+  }
+  //
+  m_keys     .push_back ( key ) ;
+  m_integrals.push_back ( std::move ( integrals ) ) ;
+  //
+  return m_keys.size () ;
+}
+// ============================================================================
+// integrals are delegated to the components 
+// ============================================================================
+Double_t Ostap::MoreRooFit::AddPdf::analyticalIntegralWN 
+( Int_t            code      , 
+  const RooArgSet* /* normSet   */ , 
+  const char*      /* rangeName */ ) const 
+{
+  Ostap::Assert ( 1 <= code && static_cast<std::size_t> ( code ) <= m_integrals.size () , 
+                  "Invalid integration code" , 
+                  "Ostap::MoreRooFit::AddPdf" ) ;
+  //
+  coefficients_ () ;
+  //
+  const std::vector<std::unique_ptr<RooAbsReal> >& integrals = m_integrals [ code - 1 ] ;
+  double result = 0 ;
+  for ( std::size_t k = 0 ; k < integrals.size () ; ++k ) 
+  {
+    const RooAbsPdf& pdf = static_cast<const RooAbsPdf&> ( *m_pdfs.at ( k ) ) ;
+    if ( !pdf.isSelectedComp () ) { continue ; }
+    result += m_coefficients [ k ] * integrals [ k ]->getVal () ;
+  }
+  return result ;
+}
+// ============================================================================
+
 // ============================================================================
 //                                                                      The END
 // ============================================================================
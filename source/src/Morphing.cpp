@@ -0,0 +1,289 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <utility>
+#include <algorithm>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Morphing.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Math::Morphing
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// check the grid of morphing parameter
+  bool valid_grid ( const std::vector<double>& grid )
+  {
+    if ( grid.empty () ) { return false ; }
+    for ( std::size_t i = 1 ; i < grid.size () ; ++i )
+    { if ( !( grid [ i - 1 ] < grid [ i ] ) ) { return false ; } }
+    return true ;
+  }
+  // ==========================================================================
+  /** find the interval of the grid and the interpolation parameter
+   *  (the value is clamped to the grid range)
+   */
+  std::pair<std::size_t,double> bracket
+  ( const std::vector<double>& grid  ,
+    const double               value )
+  {
+    const std::size_t N = grid.size () ;
+    if ( N < 2 ) { return std::make_pair ( std::size_t ( 0 ) , 0.0 ) ; }
+    const double v = std::min ( grid.back () , std::max ( grid.front () , value ) ) ;
+    std::size_t  i = std::upper_bound ( grid.begin () , grid.end () , v ) - grid.begin () ;
+    i = 0 < i ? i - 1 : 0 ;
+    if ( N - 2 < i ) { i = N - 2 ; }
+    return std::make_pair ( i , ( v - grid [ i ] ) / ( grid [ i + 1 ] - grid [ i ] ) ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor for 1D morphing
+// ============================================================================
+Ostap::Math::Morphing::Morphing
+( const std::vector<double>&               mu        ,
+  const std::vector<std::vector<double> >& templates ,
+  const double                             xmin      ,
+  const double                             xmax      ,
+  const Ostap::Math::Morphing::Mode        mode      )
+  : m_mu1  ( mu )
+  , m_mu2  (    )
+  , m_xmin ( std::min ( xmin , xmax ) )
+  , m_xmax ( std::max ( xmin , xmax ) )
+  , m_mode ( mode )
+{
+  setup ( templates ) ;
+}
+// ============================================================================
+// constructor for 2D morphing
+// ============================================================================
+Ostap::Math::Morphing::Morphing
+( const std::vector<double>&               mu1       ,
+  const std::vector<double>&               mu2       ,
+  const std::vector<std::vector<double> >& templates ,
+  const double                             xmin      ,
+  const double                             xmax      ,
+  const Ostap::Math::Morphing::Mode        mode      )
+  : m_mu1  ( mu1 )
+  , m_mu2  ( mu2 )
+  , m_xmin ( std::min ( xmin , xmax ) )
+  , m_xmax ( std::max ( xmin , xmax ) )
+  , m_mode ( mode )
+{
+  Ostap::Assert ( valid_grid ( m_mu2 )            ,
+                  "Invalid grid of mu2"           ,
+                  "Ostap::Math::Morphing"         ) ;
+  setup ( templates ) ;
+}
+// ============================================================================
+// prepare the cumulative distributions and the quantiles
+// ============================================================================
+void Ostap::Math::Morphing::setup
+( const std::vector<std::vector<double> >& templates )
+{
+  Ostap::Assert ( valid_grid ( m_mu1 )                     ,
+                  "Invalid grid of mu1"                    ,
+                  "Ostap::Math::Morphing"                  ) ;
+  Ostap::Assert ( m_xmin < m_xmax                          ,
+                  "Invalid range"                          ,
+                  "Ostap::Math::Morphing"                  ) ;
+  Ostap::Assert ( templates.size () == ntemplates ()       ,
+                  "Mismatch in number of templates"        ,
+                  "Ostap::Math::Morphing"                  ) ;
+  //
+  m_nbins = templates.front ().size () ;
+  Ostap::Assert ( 0 < m_nbins                              ,
+                  "Empty templates"                        ,
+                  "Ostap::Math::Morphing"                  ) ;
+  m_nq    = 2 * m_nbins ;
+  //
+  const std::size_t NT = templates.size () ;
+  const std::size_t N  = m_nbins ;
+  const std::size_t NQ = m_nq    ;
+  const double      h  = ( m_xmax - m_xmin ) / N ;
+  //
+  m_cdfs     .assign ( NT * ( N  + 1 ) , 0.0 ) ;
+  m_quantiles.assign ( NT * ( NQ + 1 ) , 0.0 ) ;
+  //
+  for ( std::size_t i = 0 ; i < NT ; ++i )
+  {
+    const std::vector<double>& t = templates [ i ] ;
+    Ostap::Assert ( t.size () == N                         ,
+                    "Templates have different binning"     ,
+                    "Ostap::Math::Morphing"                ) ;
+    //
+    double* C = m_cdfs.data () + i * ( N + 1 ) ;
+    C [ 0 ] = 0 ;
+    for ( std::size_t k = 0 ; k < N ; ++k ) { C [ k + 1 ] = C [ k ] + std::max ( 0.0 , t [ k ] ) ; }
+    const double total = C [ N ] ;
+    Ostap::Assert ( 0 < total                              ,
+                    "Template must be positive"            ,
+                    "Ostap::Math::Morphing"                ) ;
+    for ( std::size_t k = 1 ; k <= N ; ++k ) { C [ k ] /= total ; }
+    C [ N ] = 1 ;
+    //
+    // the quantiles: invert the piecewise linear cumulative distribution
+    double* Q = m_quantiles.data () + i * ( NQ + 1 ) ;
+    for ( std::size_t j = 0 ; j <= NQ ; ++j )
+    {
+      const double p = double ( j ) / NQ ;
+      std::size_t  k = 0 ;
+      if ( j < NQ ) { k = std::upper_bound ( C , C + N + 1 , p ) - C - 1 ; }
+      else          { k = std::lower_bound ( C , C + N + 1 , p ) - C     ; }
+      if ( N <= k ) { Q [ j ] = m_xmin + k * h ; continue ; }
+      const double dC = C [ k + 1 ] - C [ k ] ;
+      Q [ j ] = m_xmin + h * ( k + ( 0 < dC ? ( p - C [ k ] ) / dC : 0.0 ) ) ;
+    }
+  }
+  //
+  m_cmu1 = m_mu1.front () ;
+  m_cmu2 = m_mu2.empty () ? 0.0 : m_mu2.front () ;
+  morph () ;
+}
+// ============================================================================
+// set the morphing parameters
+// ============================================================================
+bool Ostap::Math::Morphing::setMu
+( const double mu1 ,
+  const double mu2 )
+{
+  const double m2 = m_mu2.empty () ? 0.0 : mu2 ;
+  if ( mu1 == m_cmu1 && m2 == m_cmu2 && !m_cdf.empty () ) { return false ; }
+  m_cmu1 = mu1 ;
+  m_cmu2 = m2  ;
+  morph () ;
+  return true ;
+}
+// ============================================================================
+// recalculate the morphed distribution
+// ============================================================================
+void Ostap::Math::Morphing::morph ()
+{
+  // (bi)linear weights of the neighbouring templates
+  std::vector<std::pair<std::size_t,double> > weights ;
+  const auto b1 = bracket ( m_mu1 , m_cmu1 ) ;
+  if ( m_mu2.empty () )
+  {
+    weights.emplace_back ( b1.first , 1 - b1.second ) ;
+    if ( 1 < m_mu1.size () ) { weights.emplace_back ( b1.first + 1 , b1.second ) ; }
+  }
+  else
+  {
+    const auto        b2 = bracket ( m_mu2 , m_cmu2 ) ;
+    const std::size_t N2 = m_mu2.size () ;
+    for ( unsigned int a = 0 ; a < 2 ; ++a )
+    {
+      if ( 1 == a && m_mu1.size () < 2 ) { break ; }
+      const double wa = a ? b1.second : 1 - b1.second ;
+      for ( unsigned int b = 0 ; b < 2 ; ++b )
+      {
+        if ( 1 == b && N2 < 2 ) { break ; }
+        const double wb = b ? b2.second : 1 - b2.second ;
+        weights.emplace_back ( ( b1.first + a ) * N2 + b2.first + b , wa * wb ) ;
+      }
+    }
+  }
+  //
+  const std::size_t N  = m_nbins ;
+  const std::size_t NQ = m_nq    ;
+  const double      h  = ( m_xmax - m_xmin ) / N ;
+  //
+  m_cdf.assign ( N + 1 , 0.0 ) ;
+  if ( Vertical == m_mode )
+  {
+    for ( const auto& w : weights )
+    {
+      if ( 0 == w.second ) { continue ; }
+      const double* C = m_cdfs.data () + w.first * ( N + 1 ) ;
+      for ( std::size_t k = 0 ; k <= N ; ++k ) { m_cdf [ k ] += w.second * C [ k ] ; }
+    }
+  }
+  else
+  {
+    // interpolate the quantile functions
+    std::vector<double> Q ( NQ + 1 , 0.0 ) ;
+    for ( const auto& w : weights )
+    {
+      if ( 0 == w.second ) { continue ; }
+      const double* q = m_quantiles.data () + w.first * ( NQ + 1 ) ;
+      for ( std::size_t j = 0 ; j <= NQ ; ++j ) { Q [ j ] += w.second * q [ j ] ; }
+    }
+    // and invert it at the bin edges: both are monotonic, single pass
+    std::size_t j = 0 ;
+    for ( std::size_t k = 0 ; k <= N ; ++k )
+    {
+      const double e = m_xmin + k * h ;
+      while ( j < NQ && Q [ j + 1 ] <= e ) { ++j ; }
+      if      ( e < Q [ 0 ] ) { m_cdf [ k ] = 0 ; }
+      else if ( NQ == j     ) { m_cdf [ k ] = 1 ; }
+      else
+      {
+        const double dQ = Q [ j + 1 ] - Q [ j ] ;
+        m_cdf [ k ] = ( j + ( 0 < dQ ? ( e - Q [ j ] ) / dQ : 0.0 ) ) / NQ ;
+      }
+    }
+  }
+  m_cdf [ 0 ] = 0 ;
+  m_cdf [ N ] = 1 ;
+  //
+  m_density.resize ( N ) ;
+  for ( std::size_t k = 0 ; k < N ; ++k )
+  { m_density [ k ] = std::max ( 0.0 , m_cdf [ k + 1 ] - m_cdf [ k ] ) / h ; }
+  //
+  ++m_nmorph ;
+}
+// ============================================================================
+// evaluate the morphed density
+// ============================================================================
+double Ostap::Math::Morphing::pdf ( const double x ) const
+{
+  if ( x < m_xmin || m_xmax < x || m_density.empty () ) { return 0 ; }
+  const std::size_t k = std::size_t ( ( x - m_xmin ) / ( m_xmax - m_xmin ) * m_nbins ) ;
+  return m_density [ std::min<std::size_t> ( k , m_nbins - 1 ) ] ;
+}
+// ============================================================================
+// evaluate the morphed cumulative distribution
+// ============================================================================
+double Ostap::Math::Morphing::cdf ( const double x ) const
+{
+  if      ( x <= m_xmin || m_cdf.empty () ) { return 0 ; }
+  else if ( x >= m_xmax                   ) { return 1 ; }
+  const double      u = ( x - m_xmin ) / ( m_xmax - m_xmin ) * m_nbins ;
+  const std::size_t k = std::min<std::size_t> ( std::size_t ( u ) , m_nbins - 1 ) ;
+  const double      t = u - k ;
+  return m_cdf [ k ] + t * ( m_cdf [ k + 1 ] - m_cdf [ k ] ) ;
+}
+// ============================================================================
+// evaluate the morphed density for the array of points
+// ============================================================================
+void Ostap::Math::Morphing::evaluate
+( const std::size_t n      ,
+  const double*     x      ,
+  double*           result ) const
+{
+  if ( m_density.empty () ) { std::fill ( result , result + n , 0.0 ) ; return ; }
+  const double      scale = m_nbins / ( m_xmax - m_xmin ) ;
+  const std::size_t last  = m_nbins - 1 ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double v = x [ i ] ;
+    result [ i ] = v < m_xmin || m_xmax < v ? 0.0 :
+      m_density [ std::min<std::size_t> ( std::size_t ( ( v - m_xmin ) * scale ) , last ) ] ;
+  }
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
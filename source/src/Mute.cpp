@@ -3,6 +3,7 @@
 // Include files 
 // =============================================================================
 #include <iostream>
+#include <mutex>
 // =============================================================================
 // Ostap
 // =============================================================================
@@ -19,6 +20,32 @@
  *  Last Modification $Date$
  *                 by $Author$ 
  */
+namespace 
+{
+  // ==========================================================================
+  /** @class NullBuffer 
+   *  the stream buffer that discards everything 
+   */
+  class NullBuffer : public std::streambuf 
+  {
+  protected:
+    // ========================================================================
+    int_type        overflow ( int_type c ) override 
+    { return traits_type::not_eof ( c ) ; }
+    std::streamsize xsputn   ( const char* /* s */ , std::streamsize n ) override 
+    { return n ; }
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /// the shared null stream buffer 
+  NullBuffer      s_null        {} ;
+  /// the original buffers for the process-level muted state 
+  std::streambuf* s_keep_cout { nullptr } ;
+  std::streambuf* s_keep_cerr { nullptr } ;
+  /// mutex for the process-level state 
+  std::mutex      s_mutex       {} ;
+  // ==========================================================================
+}
 // ============================================================================
 // constructor from filename 
 // ============================================================================
@@ -37,12 +64,15 @@ Ostap::Utils::Mute::Mute ( const std::string& fname ,
 // ============================================================================
 Ostap::Utils::Mute::Mute( const bool out  )
   : m_cout   ( out               ) 
-  , m_output ( "/dev/null"       ) 
-  , m_buffer ( out ? std::cout.rdbuf() : std::cerr.rdbuf() ) 
+  , m_output (                   ) 
+  , m_buffer ( nullptr           ) 
 {
+  // already muted at the process level: nothing to do 
+  if ( silent ( m_cout ) ) { return ; }
   // make a trick 
-  if  ( m_cout ) { std::cout.rdbuf ( m_output. rdbuf () ) ; } // redirect 'cout' to a 'fout'
-  else           { std::cerr.rdbuf ( m_output. rdbuf () ) ; } // redirect 'cerr' to a 'fout'
+  m_buffer = m_cout ? std::cout.rdbuf() : std::cerr.rdbuf() ;
+  if  ( m_cout ) { std::cout.rdbuf ( &s_null ) ; } // redirect 'cout' to the null buffer 
+  else           { std::cerr.rdbuf ( &s_null ) ; } // redirect 'cerr' to the null buffer 
 }
 // ============================================================================
 // destructor 
@@ -66,6 +96,33 @@ void Ostap::Utils::Mute::exit  ()
 // ============================================================================
 void Ostap::Utils::Mute::enter () {}
 // ============================================================================
+/*  set the process-level muted state
+ *  @param out (INPUT) mute std::cout?
+ *  @param err (INPUT) mute std::cerr?
+ */
+// ============================================================================
+void Ostap::Utils::Mute::setSilent 
+( const bool out , 
+  const bool err ) 
+{
+  std::lock_guard<std::mutex> lock ( s_mutex ) ;
+  //
+  if      (  out && nullptr == s_keep_cout ) 
+  { std::cout << std::flush ; s_keep_cout = std::cout.rdbuf ( &s_null ) ; }
+  else if ( !out && nullptr != s_keep_cout ) 
+  { std::cout.rdbuf ( s_keep_cout ) ; s_keep_cout = nullptr ; }
+  //
+  if      (  err && nullptr == s_keep_cerr ) 
+  { std::cerr << std::flush ; s_keep_cerr = std::cerr.rdbuf ( &s_null ) ; }
+  else if ( !err && nullptr != s_keep_cerr ) 
+  { std::cerr.rdbuf ( s_keep_cerr ) ; s_keep_cerr = nullptr ; }
+}
+// ============================================================================
+// is the stream muted at the process level?
+// ============================================================================
+bool Ostap::Utils::Mute::silent ( const bool out ) 
+{ return nullptr != ( out ? s_keep_cout : s_keep_cerr ) ; }
+// ============================================================================
 
 
 
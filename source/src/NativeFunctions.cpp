@@ -0,0 +1,104 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <cstdint>
+#include <string>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/NativeFunctions.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_hash.h"
+// ============================================================================
+/** @file
+ *  Implementation file for classes Ostap::Functions::NativeFunction1,2,3
+ *  @see Ostap::Functions::NativeFunction1
+ *  @see Ostap::Functions::NativeFunction2
+ *  @see Ostap::Functions::NativeFunction3
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_FUNCTION = 893 ,
+  } ;
+  // ==========================================================================
+  /// cast the address to the function pointer
+  template <class FUNCTION>
+  inline FUNCTION _cast_ ( const std::uintptr_t address , const std::string& method )
+  {
+    Ostap::Assert ( 0 != address , "Invalid function address" , method , INVALID_FUNCTION ) ;
+    return reinterpret_cast<FUNCTION> ( address ) ;
+  }
+  // ==========================================================================
+  /// check the function pointer
+  template <class FUNCTION>
+  inline FUNCTION _check_ ( FUNCTION fun , const std::string& method )
+  {
+    Ostap::Assert ( nullptr != fun , "Invalid function pointer" , method , INVALID_FUNCTION ) ;
+    return fun ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor from the address of the function
+// ============================================================================
+Ostap::Functions::NativeFunction1::NativeFunction1 ( const std::uintptr_t address )
+  : m_fun ( _cast_<raw_function> ( address , "Ostap::Functions::NativeFunction1" ) )
+{}
+// ============================================================================
+// constructor from the function pointer
+// ============================================================================
+Ostap::Functions::NativeFunction1::NativeFunction1 ( raw_function fun )
+  : m_fun ( _check_ ( fun , "Ostap::Functions::NativeFunction1" ) )
+{}
+// ============================================================================
+// the unique tag
+// ============================================================================
+std::size_t Ostap::Functions::NativeFunction1::tag () const
+{ return std::hash_combine ( std::string ( "NativeFunction1" ) , address () ) ; }
+// ============================================================================
+// constructor from the address of the function
+// ============================================================================
+Ostap::Functions::NativeFunction2::NativeFunction2 ( const std::uintptr_t address )
+  : m_fun ( _cast_<raw_function> ( address , "Ostap::Functions::NativeFunction2" ) )
+{}
+// ============================================================================
+// constructor from the function pointer
+// ============================================================================
+Ostap::Functions::NativeFunction2::NativeFunction2 ( raw_function fun )
+  : m_fun ( _check_ ( fun , "Ostap::Functions::NativeFunction2" ) )
+{}
+// ============================================================================
+// the unique tag
+// ============================================================================
+std::size_t Ostap::Functions::NativeFunction2::tag () const
+{ return std::hash_combine ( std::string ( "NativeFunction2" ) , address () ) ; }
+// ============================================================================
+// constructor from the address of the function
+// ============================================================================
+Ostap::Functions::NativeFunction3::NativeFunction3 ( const std::uintptr_t address )
+  : m_fun ( _cast_<raw_function> ( address , "Ostap::Functions::NativeFunction3" ) )
+{}
+// ============================================================================
+// constructor from the function pointer
+// ============================================================================
+Ostap::Functions::NativeFunction3::NativeFunction3 ( raw_function fun )
+  : m_fun ( _check_ ( fun , "Ostap::Functions::NativeFunction3" ) )
+{}
+// ============================================================================
+// the unique tag
+// ============================================================================
+std::size_t Ostap::Functions::NativeFunction3::tag () const
+{ return std::hash_combine ( std::string ( "NativeFunction3" ) , address () ) ; }
+// ============================================================================
+//                                                                      The END
+// ============================================================================
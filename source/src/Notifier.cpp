@@ -1,9 +1,15 @@
 // ============================================================================
 // Include files
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <atomic>
+#include <chrono>
+// ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/Notifier.h"
+#include "Ostap/Instrument.h"
 // ============================================================================
 // ROOT
 // ============================================================================
@@ -15,6 +21,18 @@
  *  @date 2018-04-09 
  */
 // ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /// number of (top-level) notifications 
+  std::atomic<unsigned long long> s_notifications { 0 } ;
+  /// time (in nanoseconds) spent in (top-level) notifications 
+  std::atomic<unsigned long long> s_notify_time   { 0 } ;
+  /// depth of nested notifications (notifiers keep the previous notifiers) 
+  thread_local unsigned int       s_depth         { 0 } ;
+  // ==========================================================================
+}
+// ============================================================================
 Ostap::Utils::Notifier::Notifier 
 ( TTree*   tree , 
   TObject* obj0 , 
@@ -31,6 +49,7 @@ Ostap::Utils::Notifier::Notifier
   , m_tree    ( tree    ) 
   , m_old     ( nullptr )
   , m_objects () 
+  , m_cache   () 
 {
   //
   _pre_action () ;
@@ -57,10 +76,49 @@ Ostap::Utils::Notifier::~Notifier() { exit() ; }
 // ============================================================================
 Bool_t Ostap::Utils::Notifier::Notify   () 
 {
+  if ( 0 < s_depth ) 
+  {
+    for ( TObject* o : m_objects ) { if ( nullptr != o ) { o->Notify() ; } }    
+    return kTRUE ;
+  }
+  //
+  OSTAP_PROBE ( "Ostap::Utils::Notifier::Notify" ) ;
+  /// count the time and the number of top-level notifications 
+  struct Counter 
+  {
+    Counter  () : m_start ( std::chrono::steady_clock::now () ) { ++s_depth ; }
+    ~Counter () 
+    {
+      --s_depth ;
+      const auto stop = std::chrono::steady_clock::now () ;
+      s_notify_time  += std::chrono::duration_cast<std::chrono::nanoseconds> ( stop - m_start ).count () ;
+      ++s_notifications ;
+    }
+    std::chrono::steady_clock::time_point m_start ;
+  } counter ;
+  //
   for ( TObject* o : m_objects ) { if ( nullptr != o ) { o->Notify() ; } }    
+  //
+  if ( m_cache ) { m_cache->notify () ; }
   return kTRUE ;
 }
 // ============================================================================
+// total number of (top-level) notifications 
+// ============================================================================
+unsigned long long Ostap::Utils::Notifier::notifications () { return s_notifications ; }
+// ============================================================================
+// total time (in seconds) spent in (top-level) notifications 
+// ============================================================================
+double Ostap::Utils::Notifier::notify_time () { return 1.e-9 * s_notify_time ; }
+// ============================================================================
+// reset the notification counters 
+// ============================================================================
+void Ostap::Utils::Notifier::reset_counters () 
+{
+  s_notifications = 0 ;
+  s_notify_time   = 0 ;
+}
+// ============================================================================
 void Ostap::Utils::Notifier::_pre_action()
 {
   if ( nullptr != m_tree ) { m_old = m_tree->GetNotify ()  ; }
@@ -68,10 +126,33 @@ void Ostap::Utils::Notifier::_pre_action()
 }
 // ============================================================================
 void Ostap::Utils::Notifier::_post_action()
-{ if ( nullptr != m_tree ) { m_tree -> SetNotify ( this ) ; } }
+{
+  if ( nullptr != m_tree ) { m_tree -> SetNotify ( this ) ; }
+  cache () ;
+}
+// ============================================================================
+// (re)configure TTreeCache for the branches, used by the formulas
+// ============================================================================
+bool Ostap::Utils::Notifier::cache ()
+{
+  m_cache.reset () ;
+  if ( nullptr == m_tree || !Ostap::Utils::TreeCache::enabled () ) { return false ; }
+  //
+  std::vector<const TObject*> objects ;
+  objects.reserve ( m_objects.size () ) ;
+  for ( const TObject* o : m_objects )
+  { if ( nullptr != o && this != o && m_old != o ) { objects.push_back ( o ) ; } }
+  //
+  // nested notifier: the cache is configured by the outer one 
+  const bool nested = nullptr != dynamic_cast<const Ostap::Utils::Notifier*> ( m_old ) ;
+  m_cache = std::make_unique<Ostap::Utils::TreeCache> ( m_tree , objects , nested ) ;
+  //
+  return m_cache->ok () ;
+}
 // ============================================================================
 bool Ostap::Utils::Notifier::exit()
 {
+  m_cache.reset () ;
   if ( nullptr == m_tree || m_tree->GetNotify() != this ) { return false ; }
   //
   if ( this != m_old ) { m_tree->SetNotify ( m_old ) ; } // RESTORE OLD NOTIFICATIONS 
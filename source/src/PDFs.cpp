@@ -9,6 +9,7 @@
 // ============================================================================
 #include "Ostap/PDFs.h"
 #include "Ostap/Iterator.h"
+#include "Ostap/Instrument.h"
 // ============================================================================
 // ROOT 
 // ============================================================================
@@ -20,6 +21,7 @@
 // Local
 // ============================================================================
 #include "local_roofit.h"
+#include "local_batch.h"
 // ============================================================================
 /** @file 
  *  Implementation file for namespace Ostap::Models
@@ -220,7 +222,7 @@ void Ostap::Models::BreitWigner::setPars () const
 // the actual evaluation of function 
 // ============================================================================
 Double_t Ostap::Models::BreitWigner::evaluate() const 
-{ setPars() ; return  ( *m_bw ) ( m_x ) ; }
+{ OSTAP_PROBE ( "Ostap::Models::BreitWigner::evaluate" ) ; setPars() ; return  ( *m_bw ) ( m_x ) ; }
 // ============================================================================
 Int_t Ostap::Models::BreitWigner::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -235,6 +237,7 @@ Double_t Ostap::Models::BreitWigner::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::BreitWigner::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -632,7 +635,7 @@ void Ostap::Models::BWPS::setPars () const
 // the actual evaluation of function 
 // ============================================================================
 Double_t Ostap::Models::BWPS::evaluate() const 
-{ setPars() ; return  m_bwps  ( m_x ) ; }
+{ OSTAP_PROBE ( "Ostap::Models::BWPS::evaluate" ) ; setPars() ; return  m_bwps  ( m_x ) ; }
 // ============================================================================
 Int_t Ostap::Models::BWPS::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -647,6 +650,7 @@ Double_t Ostap::Models::BWPS::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::BWPS::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -756,7 +760,7 @@ Ostap::Models::BW3L::amplitude () const
 // the actual evaluation of function 
 // ============================================================================
 Double_t Ostap::Models::BW3L::evaluate() const 
-{ setPars() ; return  m_bw3l  ( m_x ) ; }
+{ OSTAP_PROBE ( "Ostap::Models::BW3L::evaluate" ) ; setPars() ; return  m_bw3l  ( m_x ) ; }
 // ============================================================================
 Int_t Ostap::Models::BW3L::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -771,6 +775,7 @@ Double_t Ostap::Models::BW3L::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::BW3L::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -845,11 +850,38 @@ void Ostap::Models::Voigt::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Voigt::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Voigt::evaluate" ) ;
   //
   setPars() ;
   //
   return m_voigt    ( m_x     ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Voigt , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Voigt::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_m0    ) ;
+  batch.add ( m_gamma ) ;
+  batch.add ( m_sigma ) ;
+  //
+  batch.evaluate 
+    ( m_voigt , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_voigt.setM0    ( p [ 0 ] ) ;
+        m_voigt.setGamma ( p [ 1 ] ) ;
+        m_voigt.setSigma ( p [ 2 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::Voigt::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -864,6 +896,7 @@ Double_t Ostap::Models::Voigt::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Voigt::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -940,11 +973,38 @@ void Ostap::Models::PseudoVoigt::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PseudoVoigt::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PseudoVoigt::evaluate" ) ;
   //
   setPars() ;
   //
   return m_voigt    ( m_x     ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::PseudoVoigt , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::PseudoVoigt::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_m0    ) ;
+  batch.add ( m_gamma ) ;
+  batch.add ( m_sigma ) ;
+  //
+  batch.evaluate 
+    ( m_voigt , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_voigt.setM0    ( p [ 0 ] ) ;
+        m_voigt.setGamma ( p [ 1 ] ) ;
+        m_voigt.setSigma ( p [ 2 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::PseudoVoigt::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -959,6 +1019,7 @@ Double_t Ostap::Models::PseudoVoigt::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PseudoVoigt::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -1037,6 +1098,7 @@ void Ostap::Models::CrystalBall::setPars () const
 // ============================================================================
 Double_t Ostap::Models::CrystalBall::evaluate() const
 {
+  OSTAP_PROBE ( "Ostap::Models::CrystalBall::evaluate" ) ;
   //
   setPars () ;
   //
@@ -1056,6 +1118,7 @@ Double_t Ostap::Models::CrystalBall::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::CrystalBall::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -1136,6 +1199,7 @@ void Ostap::Models::CrystalBallRS::setPars () const
 // ============================================================================
 Double_t Ostap::Models::CrystalBallRS::evaluate() const
 {
+  OSTAP_PROBE ( "Ostap::Models::CrystalBallRS::evaluate" ) ;
   //
   setPars() ;
   //
@@ -1155,6 +1219,7 @@ Double_t Ostap::Models::CrystalBallRS::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::CrystalBallRS::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -1241,11 +1306,44 @@ void Ostap::Models::CrystalBallDS::setPars () const
 // ============================================================================
 Double_t Ostap::Models::CrystalBallDS::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::CrystalBallDS::evaluate" ) ;
   //
   setPars () ;
   //
   return m_cb2     ( m_x      ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::CrystalBallDS , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::CrystalBallDS::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_m0 ) ;
+  batch.add ( m_sigma ) ;
+  batch.add ( m_alphaL ) ;
+  batch.add ( m_nL ) ;
+  batch.add ( m_alphaR ) ;
+  batch.add ( m_nR ) ;
+  //
+  batch.evaluate 
+    ( m_cb2 , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_cb2.setM0      ( p [ 0 ] ) ;
+        m_cb2.setSigma   ( p [ 1 ] ) ;
+        m_cb2.setAlpha_L ( p [ 2 ] ) ;
+        m_cb2.setN_L     ( p [ 3 ] ) ;
+        m_cb2.setAlpha_R ( p [ 4 ] ) ;
+        m_cb2.setN_R     ( p [ 5 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::CrystalBallDS::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -1260,6 +1358,7 @@ Double_t Ostap::Models::CrystalBallDS::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::CrystalBallDS::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -1351,6 +1450,7 @@ void Ostap::Models::Needham::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Needham::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Needham::evaluate" ) ;
   //
   setPars () ;
   //
@@ -1370,6 +1470,7 @@ Double_t Ostap::Models::Needham::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Needham::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -1472,6 +1573,7 @@ void Ostap::Models::Apollonios::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Apollonios::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Apollonios::evaluate" ) ;
   //
   setPars () ;
   //
@@ -1491,11 +1593,12 @@ Double_t Ostap::Models::Apollonios::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Apollonios::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
   setPars () ;
-  return m_apo.integral ( m_x.min(rangeName) , m_x.max(rangeName) ) ;
+  return m_icache.integral ( m_apo , m_x.min(rangeName) , m_x.max(rangeName) ) ;
 }
 // ============================================================================
 
@@ -1568,11 +1671,40 @@ void Ostap::Models::Apollonios2::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Apollonios2::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Apollonios2::evaluate" ) ;
   //
   setPars () ;
   //
   return m_apo2 ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Apollonios2 , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Apollonios2::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_m0 ) ;
+  batch.add ( m_sigmaL ) ;
+  batch.add ( m_sigmaR ) ;
+  batch.add ( m_beta ) ;
+  //
+  batch.evaluate 
+    ( m_apo2 , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_apo2.setM0     ( p [ 0 ] ) ;
+        m_apo2.setSigmaL ( p [ 1 ] ) ;
+        m_apo2.setSigmaR ( p [ 2 ] ) ;
+        m_apo2.setBeta   ( p [ 3 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::Apollonios2::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -1587,11 +1719,12 @@ Double_t Ostap::Models::Apollonios2::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Apollonios2::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
   setPars () ;
-  return m_apo2.integral ( m_x.min(rangeName) , m_x.max(rangeName) ) ;
+  return m_icache.integral ( m_apo2 , m_x.min(rangeName) , m_x.max(rangeName) ) ;
 }
 // ============================================================================
 
@@ -1661,11 +1794,38 @@ void Ostap::Models::BifurcatedGauss::setPars () const
 // ============================================================================
 Double_t Ostap::Models::BifurcatedGauss::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::BifurcatedGauss::evaluate" ) ;
   //
   setPars () ;
   //
   return m_bg    ( m_x      ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::BifurcatedGauss , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::BifurcatedGauss::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_peak ) ;
+  batch.add ( m_sigmaL ) ;
+  batch.add ( m_sigmaR ) ;
+  //
+  batch.evaluate 
+    ( m_bg , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_bg.setPeak   ( p [ 0 ] ) ;
+        m_bg.setSigmaL ( p [ 1 ] ) ;
+        m_bg.setSigmaR ( p [ 2 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::BifurcatedGauss::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -1680,6 +1840,7 @@ Double_t Ostap::Models::BifurcatedGauss::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::BifurcatedGauss::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -1755,6 +1916,7 @@ void Ostap::Models::GenGaussV1::setPars () const
 // ============================================================================
 Double_t Ostap::Models::GenGaussV1::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::GenGaussV1::evaluate" ) ;
   //
   setPars () ;
   //
@@ -1774,6 +1936,7 @@ Double_t Ostap::Models::GenGaussV1::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::GenGaussV1::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -1849,6 +2012,7 @@ void Ostap::Models::GenGaussV2::setPars () const
 // ============================================================================
 Double_t Ostap::Models::GenGaussV2::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::GenGaussV2::evaluate" ) ;
   //
   setPars () ;
   //
@@ -1868,6 +2032,7 @@ Double_t Ostap::Models::GenGaussV2::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::GenGaussV2::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -1943,6 +2108,7 @@ void Ostap::Models::SkewGauss::setPars () const
 // ============================================================================
 Double_t Ostap::Models::SkewGauss::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::SkewGauss::evaluate" ) ;
   //
   setPars () ;
   //
@@ -1962,6 +2128,7 @@ Double_t Ostap::Models::SkewGauss::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::SkewGauss::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -2044,11 +2211,42 @@ void Ostap::Models::Bukin::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Bukin::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Bukin::evaluate" ) ;
   //
   setPars () ;
   //
   return m_bukin    ( m_x     ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Bukin , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Bukin::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_peak ) ;
+  batch.add ( m_sigma ) ;
+  batch.add ( m_xi ) ;
+  batch.add ( m_rhoL ) ;
+  batch.add ( m_rhoR ) ;
+  //
+  batch.evaluate 
+    ( m_bukin , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_bukin.setPeak  ( p [ 0 ] ) ;
+        m_bukin.setSigma ( p [ 1 ] ) ;
+        m_bukin.setXi    ( p [ 2 ] ) ;
+        m_bukin.setRho_L ( p [ 3 ] ) ;
+        m_bukin.setRho_R ( p [ 4 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::Bukin::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -2063,11 +2261,12 @@ Double_t Ostap::Models::Bukin::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Bukin::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
   setPars() ;
-  return m_bukin.integral ( m_x.min(rangeName) , m_x.max(rangeName) ) ;
+  return m_icache.integral ( m_bukin , m_x.min(rangeName) , m_x.max(rangeName) ) ;
 }
 // ============================================================================
 
@@ -2134,11 +2333,38 @@ void Ostap::Models::StudentT::setPars () const
 // ============================================================================
 Double_t Ostap::Models::StudentT::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::StudentT::evaluate" ) ;
   //
   setPars () ;
   //
   return m_stt   ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::StudentT , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::StudentT::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_mu ) ;
+  batch.add ( m_sigma ) ;
+  batch.add ( m_n ) ;
+  //
+  batch.evaluate 
+    ( m_stt , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_stt.setM     ( p [ 0 ] ) ;
+        m_stt.setSigma ( p [ 1 ] ) ;
+        m_stt.setN     ( p [ 2 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::StudentT::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -2153,6 +2379,7 @@ Double_t Ostap::Models::StudentT::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::StudentT::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -2232,6 +2459,7 @@ void Ostap::Models::BifurcatedStudentT::setPars () const
 // ============================================================================
 Double_t Ostap::Models::BifurcatedStudentT::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::BifurcatedStudentT::evaluate" ) ;
   //
   setPars () ;
   //
@@ -2251,6 +2479,7 @@ Double_t Ostap::Models::BifurcatedStudentT::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::BifurcatedStudentT::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -2330,6 +2559,7 @@ void Ostap::Models::GramCharlierA::setPars () const
 // ============================================================================
 Double_t Ostap::Models::GramCharlierA::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::GramCharlierA::evaluate" ) ;
   //
   setPars() ;
   //
@@ -2349,6 +2579,7 @@ Double_t Ostap::Models::GramCharlierA::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::GramCharlierA::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -2401,7 +2632,7 @@ Ostap::Models::PhaseSpace2::clone( const char* name ) const
 // the actual evaluation of function 
 // ============================================================================
 Double_t Ostap::Models::PhaseSpace2::evaluate() const 
-{ return m_ps2 ( m_x ) ; }
+{ OSTAP_PROBE ( "Ostap::Models::PhaseSpace2::evaluate" ) ; return m_ps2 ( m_x ) ; }
 // ============================================================================
 Int_t Ostap::Models::PhaseSpace2::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -2416,6 +2647,7 @@ Double_t Ostap::Models::PhaseSpace2::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PhaseSpace2::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -2585,6 +2817,7 @@ void Ostap::Models::PhaseSpaceLeft::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PhaseSpaceLeft::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PhaseSpaceLeft::evaluate" ) ;
   //
   setPars () ;
   //
@@ -2604,6 +2837,7 @@ Double_t Ostap::Models::PhaseSpaceLeft::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PhaseSpaceLeft::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -2671,6 +2905,7 @@ void Ostap::Models::PhaseSpaceRight::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PhaseSpaceRight::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PhaseSpaceRight::evaluate" ) ;
   //
   setPars () ;
   //
@@ -2690,6 +2925,7 @@ Double_t Ostap::Models::PhaseSpaceRight::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PhaseSpaceRight::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -2758,6 +2994,7 @@ void Ostap::Models::PhaseSpaceNL::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PhaseSpaceNL::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PhaseSpaceNL::evaluate" ) ;
   //
   setPars () ;
   //
@@ -2777,6 +3014,7 @@ Double_t Ostap::Models::PhaseSpaceNL::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PhaseSpaceNL::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -2823,7 +3061,7 @@ Ostap::Models::PhaseSpace23L::clone( const char* name ) const
 // the actual evaluation of function 
 // ============================================================================
 Double_t Ostap::Models::PhaseSpace23L::evaluate() const 
-{ return m_ps23L ( m_x ) ; }
+{ OSTAP_PROBE ( "Ostap::Models::PhaseSpace23L::evaluate" ) ; return m_ps23L ( m_x ) ; }
 // ============================================================================
 Int_t Ostap::Models::PhaseSpace23L::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -2838,6 +3076,7 @@ Double_t Ostap::Models::PhaseSpace23L::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PhaseSpace23L::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -3146,6 +3385,27 @@ Double_t Ostap::Models::PhaseSpacePol::evaluate () const
   //
   return m_ps ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::PhaseSpacePol , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::PhaseSpacePol::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate 
+    ( m_ps , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_ps.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::PhaseSpacePol::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -3160,6 +3420,7 @@ Double_t Ostap::Models::PhaseSpacePol::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PhaseSpacePol::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -3336,6 +3597,7 @@ Double_t Ostap::Models::PhaseSpaceLeftExpoPol::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PhaseSpaceLeftExpoPol::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -3413,11 +3675,33 @@ void Ostap::Models::PolyPositive::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PolyPositive::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolyPositive::evaluate" ) ;
   //
   setPars () ;
   //
   return m_positive ( m_x ) ; 
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::PolyPositive , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::PolyPositive::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate 
+    ( m_positive , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_positive.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::PolyPositive::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -3432,6 +3716,7 @@ Double_t Ostap::Models::PolyPositive::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolyPositive::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -3509,6 +3794,7 @@ void Ostap::Models::PolyPositiveEven::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PolyPositiveEven::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolyPositiveEven::evaluate" ) ;
   //
   setPars () ;
   //
@@ -3528,6 +3814,7 @@ Double_t Ostap::Models::PolyPositiveEven::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolyPositiveEven::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -3602,6 +3889,7 @@ void Ostap::Models::PolyMonotonic::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PolyMonotonic::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolyMonotonic::evaluate" ) ;
   //
   setPars () ;
   //
@@ -3621,6 +3909,7 @@ Double_t Ostap::Models::PolyMonotonic::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolyMonotonic::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -3694,6 +3983,7 @@ void Ostap::Models::PolyConvex::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PolyConvex::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolyConvex::evaluate" ) ;
   //
   setPars () ;
   //
@@ -3713,6 +4003,7 @@ Double_t Ostap::Models::PolyConvex::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolyConvex::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -3787,6 +4078,7 @@ void Ostap::Models::PolyConvexOnly::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PolyConvexOnly::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolyConvexOnly::evaluate" ) ;
   //
   setPars () ;
   //
@@ -3806,6 +4098,7 @@ Double_t Ostap::Models::PolyConvexOnly::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolyConvexOnly::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -3885,11 +4178,36 @@ void Ostap::Models::PolySigmoid::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PolySigmoid::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolySigmoid::evaluate" ) ;
   //
   setPars () ;
   //
   return m_sigmoid ( m_x ) ; 
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::PolySigmoid , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::PolySigmoid::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_phis  ) ;
+  batch.add ( m_alpha ) ;
+  batch.add ( m_x0    ) ;
+  //
+  // the parameters of Sigmoid: polynomial phases, alpha, x0 
+  batch.evaluate 
+    ( m_sigmoid , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_sigmoid.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::PolySigmoid::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -3904,6 +4222,7 @@ Double_t Ostap::Models::PolySigmoid::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PolySigmoid::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -3983,6 +4302,7 @@ void Ostap::Models::PositiveSpline::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PositiveSpline::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PositiveSpline::evaluate" ) ;
   //
   setPars () ;
   //
@@ -4002,6 +4322,7 @@ Double_t Ostap::Models::PositiveSpline::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PositiveSpline::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -4083,6 +4404,7 @@ void Ostap::Models::MonotonicSpline::setPars () const
 // ============================================================================
 Double_t Ostap::Models::MonotonicSpline::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::MonotonicSpline::evaluate" ) ;
   //
   setPars () ;
   //
@@ -4102,6 +4424,7 @@ Double_t Ostap::Models::MonotonicSpline::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::MonotonicSpline::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -4180,6 +4503,7 @@ void Ostap::Models::ConvexSpline::setPars () const
 // ============================================================================
 Double_t Ostap::Models::ConvexSpline::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::ConvexSpline::evaluate" ) ;
   //
   setPars () ;
   //
@@ -4199,6 +4523,7 @@ Double_t Ostap::Models::ConvexSpline::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::ConvexSpline::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -4277,6 +4602,7 @@ void Ostap::Models::ConvexOnlySpline::setPars () const
 // ============================================================================
 Double_t Ostap::Models::ConvexOnlySpline::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::ConvexOnlySpline::evaluate" ) ;
   //
   setPars () ;
   //
@@ -4296,6 +4622,7 @@ Double_t Ostap::Models::ConvexOnlySpline::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::ConvexOnlySpline::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -4376,6 +4703,7 @@ void Ostap::Models::ExpoPositive::setPars () const
 // ============================================================================
 Double_t Ostap::Models::ExpoPositive::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::ExpoPositive::evaluate" ) ;
   //
   setPars () ;
   //
@@ -4395,6 +4723,7 @@ Double_t Ostap::Models::ExpoPositive::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::ExpoPositive::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -4481,6 +4810,7 @@ void Ostap::Models::TwoExpoPositive::setPars () const
 // ============================================================================
 Double_t Ostap::Models::TwoExpoPositive::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::TwoExpoPositive::evaluate" ) ;
   //
   setPars () ;
   //
@@ -4500,6 +4830,7 @@ Double_t Ostap::Models::TwoExpoPositive::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::TwoExpoPositive::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -4567,11 +4898,36 @@ void Ostap::Models::GammaDist::setPars () const
 // ============================================================================
 Double_t Ostap::Models::GammaDist::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::GammaDist::evaluate" ) ;
   //
   setPars () ;
   //
   return m_gamma   ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::GammaDist , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::GammaDist::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_k ) ;
+  batch.add ( m_theta ) ;
+  //
+  batch.evaluate 
+    ( m_gamma , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_gamma.setK     ( p [ 0 ] ) ;
+        m_gamma.setTheta ( p [ 1 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::GammaDist::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -4586,6 +4942,7 @@ Double_t Ostap::Models::GammaDist::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::GammaDist::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -4661,11 +5018,40 @@ void Ostap::Models::GenGammaDist::setPars () const
 // ============================================================================
 Double_t Ostap::Models::GenGammaDist::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::GenGammaDist::evaluate" ) ;
   //
   setPars () ;
   //
   return m_ggamma   ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::GenGammaDist , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::GenGammaDist::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_k ) ;
+  batch.add ( m_theta ) ;
+  batch.add ( m_p ) ;
+  batch.add ( m_low ) ;
+  //
+  batch.evaluate 
+    ( m_ggamma , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_ggamma.setK     ( p [ 0 ] ) ;
+        m_ggamma.setTheta ( p [ 1 ] ) ;
+        m_ggamma.setP     ( p [ 2 ] ) ;
+        m_ggamma.setLow   ( p [ 3 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::GenGammaDist::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -4680,6 +5066,7 @@ Double_t Ostap::Models::GenGammaDist::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::GenGammaDist::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -4758,11 +5145,40 @@ void Ostap::Models::Amoroso::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Amoroso::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Amoroso::evaluate" ) ;
   //
   setPars () ;
   //
   return m_amoroso   ( m_x     ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Amoroso , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Amoroso::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_theta ) ;
+  batch.add ( m_alpha ) ;
+  batch.add ( m_beta ) ;
+  batch.add ( m_a ) ;
+  //
+  batch.evaluate 
+    ( m_amoroso , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_amoroso.setTheta ( p [ 0 ] ) ;
+        m_amoroso.setAlpha ( p [ 1 ] ) ;
+        m_amoroso.setBeta  ( p [ 2 ] ) ;
+        m_amoroso.setA     ( p [ 3 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::Amoroso::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -4777,6 +5193,7 @@ Double_t Ostap::Models::Amoroso::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Amoroso::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -4849,6 +5266,7 @@ void Ostap::Models::LogGammaDist::setPars () const
 // ============================================================================
 Double_t Ostap::Models::LogGammaDist::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::LogGammaDist::evaluate" ) ;
   //
   setPars () ;
   //
@@ -4868,6 +5286,7 @@ Double_t Ostap::Models::LogGammaDist::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::LogGammaDist::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -4936,6 +5355,7 @@ void Ostap::Models::Log10GammaDist::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Log10GammaDist::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Log10GammaDist::evaluate" ) ;
   //
   setPars () ;
   //
@@ -4955,6 +5375,7 @@ Double_t Ostap::Models::Log10GammaDist::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Log10GammaDist::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -5026,11 +5447,38 @@ void Ostap::Models::LogGamma::setPars () const
 // ============================================================================
 Double_t Ostap::Models::LogGamma::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::LogGamma::evaluate" ) ;
   //
   setPars () ;
   //
   return m_lgamma    ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::LogGamma , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::LogGamma::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_nu ) ;
+  batch.add ( m_lambda ) ;
+  batch.add ( m_alpha ) ;
+  //
+  batch.evaluate 
+    ( m_lgamma , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_lgamma.setNu     ( p [ 0 ] ) ;
+        m_lgamma.setLambda ( p [ 1 ] ) ;
+        m_lgamma.setAlpha  ( p [ 2 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::LogGamma::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -5045,6 +5493,7 @@ Double_t Ostap::Models::LogGamma::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::LogGamma::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -5120,11 +5569,40 @@ void Ostap::Models::BetaPrime::setPars () const
 // ============================================================================
 Double_t Ostap::Models::BetaPrime::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::BetaPrime::evaluate" ) ;
   //
   setPars () ;
   //
   return m_betap    ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::BetaPrime , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::BetaPrime::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_alpha ) ;
+  batch.add ( m_beta ) ;
+  batch.add ( m_scale ) ;
+  batch.add ( m_shift ) ;
+  //
+  batch.evaluate 
+    ( m_betap , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_betap.setAlpha ( p [ 0 ] ) ;
+        m_betap.setBeta  ( p [ 1 ] ) ;
+        m_betap.setScale ( p [ 2 ] ) ;
+        m_betap.setShift ( p [ 3 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::BetaPrime::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -5139,6 +5617,7 @@ Double_t Ostap::Models::BetaPrime::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::BetaPrime::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -5214,6 +5693,7 @@ void Ostap::Models::SinhAsinh::setPars () const
 // ============================================================================
 Double_t Ostap::Models::SinhAsinh::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::SinhAsinh::evaluate" ) ;
   //
   setPars () ;
   //
@@ -5233,6 +5713,7 @@ Double_t Ostap::Models::SinhAsinh::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::SinhAsinh::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -5308,11 +5789,40 @@ void Ostap::Models::JohnsonSU::setPars () const
 // ============================================================================
 Double_t Ostap::Models::JohnsonSU::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::JohnsonSU::evaluate" ) ;
   //
   setPars () ;
   //
   return m_johnsonSU ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::JohnsonSU , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::JohnsonSU::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_xi ) ;
+  batch.add ( m_lambda ) ;
+  batch.add ( m_delta ) ;
+  batch.add ( m_gamma ) ;
+  //
+  batch.evaluate 
+    ( m_johnsonSU , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_johnsonSU.setXi     ( p [ 0 ] ) ;
+        m_johnsonSU.setLambda ( p [ 1 ] ) ;
+        m_johnsonSU.setDelta  ( p [ 2 ] ) ;
+        m_johnsonSU.setGamma  ( p [ 3 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::JohnsonSU::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -5327,6 +5837,7 @@ Double_t Ostap::Models::JohnsonSU::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::JohnsonSU::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -5394,11 +5905,36 @@ void Ostap::Models::Landau::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Landau::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Landau::evaluate" ) ;
   //
   setPars () ;
   //
   return m_landau ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Landau , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Landau::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_scale ) ;
+  batch.add ( m_shift ) ;
+  //
+  batch.evaluate 
+    ( m_landau , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_landau.setScale ( p [ 0 ] ) ;
+        m_landau.setShift ( p [ 1 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::Landau::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -5413,6 +5949,7 @@ Double_t Ostap::Models::Landau::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Landau::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -5480,6 +6017,7 @@ void Ostap::Models::Atlas::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Atlas::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Atlas::evaluate" ) ;
   //
   setPars () ;
   //
@@ -5499,11 +6037,12 @@ Double_t Ostap::Models::Atlas::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Atlas::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
   setPars () ;
-  return m_atlas.integral ( m_x.min( rangeName ) , m_x.max( rangeName ) ) ;
+  return m_icache.integral ( m_atlas , m_x.min( rangeName ) , m_x.max( rangeName ) ) ;
 }
 // ============================================================================
 
@@ -5567,6 +6106,7 @@ void Ostap::Models::Sech::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Sech::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Sech::evaluate" ) ;
   //
   setPars () ;
   //
@@ -5586,6 +6126,7 @@ Double_t Ostap::Models::Sech::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Sech::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -5657,6 +6198,7 @@ void Ostap::Models::Losev::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Losev::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Losev::evaluate" ) ;
   //
   setPars () ;
   //
@@ -5676,11 +6218,12 @@ Double_t Ostap::Models::Losev::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Losev::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
   setPars () ;
-  return m_losev.integral ( m_x.min ( rangeName ) , m_x.max ( rangeName ) ) ;
+  return m_icache.integral ( m_losev , m_x.min ( rangeName ) , m_x.max ( rangeName ) ) ;
 }
 // ============================================================================
 
@@ -5743,6 +6286,7 @@ void Ostap::Models::Logistic::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Logistic::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Logistic::evaluate" ) ;
   //
   setPars () ;
   //
@@ -5762,6 +6306,7 @@ Double_t Ostap::Models::Logistic::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Logistic::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -5834,11 +6379,38 @@ void Ostap::Models::Argus::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Argus::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Argus::evaluate" ) ;
   //
   setPars () ;
   //
   return m_argus ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Argus , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Argus::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_shape ) ;
+  batch.add ( m_low ) ;
+  batch.add ( m_high ) ;
+  //
+  batch.evaluate 
+    ( m_argus , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_argus.setShape ( p [ 0 ] ) ;
+        m_argus.setLow   ( p [ 1 ] ) ;
+        m_argus.setHigh  ( p [ 2 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::Argus::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -5853,6 +6425,7 @@ Double_t Ostap::Models::Argus::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Argus::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -5918,6 +6491,7 @@ void Ostap::Models::Slash::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Slash::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Slash::evaluate" ) ;
   setPars () ;
   return m_slash ( m_x ) ;
 }
@@ -5935,6 +6509,7 @@ Double_t Ostap::Models::Slash::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Slash::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -6005,6 +6580,7 @@ void Ostap::Models::AsymmetricLaplace::setPars () const
 // ============================================================================
 Double_t Ostap::Models::AsymmetricLaplace::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::AsymmetricLaplace::evaluate" ) ;
   setPars () ;
   return m_laplace( m_x ) ;
 }
@@ -6022,6 +6598,7 @@ Double_t Ostap::Models::AsymmetricLaplace::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::AsymmetricLaplace::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -6093,11 +6670,38 @@ void Ostap::Models::Tsallis::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Tsallis::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Tsallis::evaluate" ) ;
   //
   setPars () ;
   //
   return m_tsallis ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Tsallis , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Tsallis::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_mass ) ;
+  batch.add ( m_n ) ;
+  batch.add ( m_T ) ;
+  //
+  batch.evaluate 
+    ( m_tsallis , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_tsallis.setMass ( p [ 0 ] ) ;
+        m_tsallis.setN    ( p [ 1 ] ) ;
+        m_tsallis.setT    ( p [ 2 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::Tsallis::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -6112,6 +6716,7 @@ Double_t Ostap::Models::Tsallis::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Tsallis::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -6180,11 +6785,36 @@ void Ostap::Models::QGSM::setPars () const
 // ============================================================================
 Double_t Ostap::Models::QGSM::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::QGSM::evaluate" ) ;
   //
   setPars () ;
   //
   return m_qgsm ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::QGSM , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::QGSM::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_mass ) ;
+  batch.add ( m_b ) ;
+  //
+  batch.evaluate 
+    ( m_qgsm , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_qgsm.setMass ( p [ 0 ] ) ;
+        m_qgsm.setB    ( p [ 1 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::QGSM::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -6199,6 +6829,7 @@ Double_t Ostap::Models::QGSM::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::QGSM::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -6272,11 +6903,38 @@ void Ostap::Models::TwoExpos::setPars () const
 // ============================================================================
 Double_t Ostap::Models::TwoExpos::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::TwoExpos::evaluate" ) ;
   //
   setPars () ;
   //
   return m_2expos( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::TwoExpos , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::TwoExpos::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_alpha ) ;
+  batch.add ( m_delta ) ;
+  batch.add ( m_x0 ) ;
+  //
+  batch.evaluate 
+    ( m_2expos , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_2expos.setAlpha ( p [ 0 ] ) ;
+        m_2expos.setDelta ( p [ 1 ] ) ;
+        m_2expos.setX0    ( p [ 2 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::TwoExpos::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
@@ -6291,6 +6949,7 @@ Double_t Ostap::Models::TwoExpos::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::TwoExpos::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ) {}
   //
@@ -6358,6 +7017,7 @@ void Ostap::Models::DoubleGauss::setPars () const
 // ============================================================================
 Double_t Ostap::Models::DoubleGauss::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::DoubleGauss::evaluate" ) ;
   //
   setPars() ;
   return m_2gauss ( m_x ) ;
@@ -6376,6 +7036,7 @@ Double_t Ostap::Models::DoubleGauss::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const
 {
+  OSTAP_PROBE ( "Ostap::Models::DoubleGauss::analyticalIntegral" ) ;
   assert( code == 1 ) ;
   if ( 1 != code ){}
   //
@@ -6441,10 +7102,35 @@ void Ostap::Models::Gumbel::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Gumbel::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Gumbel::evaluate" ) ;
   //
   setPars ();
   return m_gumbel ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Gumbel , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Gumbel::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_mu ) ;
+  batch.add ( m_beta ) ;
+  //
+  batch.evaluate 
+    ( m_gumbel , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_gumbel.setMu   ( p [ 0 ] ) ;
+        m_gumbel.setBeta ( p [ 1 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::Gumbel::getAnalyticalIntegral
 ( RooArgSet&  allVars       , 
@@ -6459,6 +7145,7 @@ Double_t Ostap::Models::Gumbel::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const
 {
+  OSTAP_PROBE ( "Ostap::Models::Gumbel::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ){}
   //
@@ -6529,9 +7216,36 @@ void Ostap::Models::Weibull::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Weibull::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Weibull::evaluate" ) ;
   setPars() ;
   return m_weibull ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Weibull , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Weibull::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_scale ) ;
+  batch.add ( m_shape ) ;
+  batch.add ( m_shift ) ;
+  //
+  batch.evaluate 
+    ( m_weibull , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_weibull.setScale ( p [ 0 ] ) ;
+        m_weibull.setShape ( p [ 1 ] ) ;
+        m_weibull.setShift ( p [ 2 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::Weibull::getAnalyticalIntegral
 ( RooArgSet&  allVars       , 
@@ -6546,6 +7260,7 @@ Double_t Ostap::Models::Weibull::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const
 {
+  OSTAP_PROBE ( "Ostap::Models::Weibull::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ){}
   //
@@ -6611,6 +7326,7 @@ void Ostap::Models::RaisingCosine::setPars () const
 // ============================================================================
 Double_t Ostap::Models::RaisingCosine::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::RaisingCosine::evaluate" ) ;
   setPars() ;
   return m_rcos ( m_x ) ;
 }
@@ -6628,6 +7344,7 @@ Double_t Ostap::Models::RaisingCosine::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const
 {
+  OSTAP_PROBE ( "Ostap::Models::RaisingCosine::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ){}
   //
@@ -6698,6 +7415,7 @@ void Ostap::Models::QGaussian::setPars () const
 // ============================================================================
 Double_t Ostap::Models::QGaussian::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::QGaussian::evaluate" ) ;
   setPars() ;
   return m_qgauss ( m_x ) ;
 }
@@ -6715,6 +7433,7 @@ Double_t Ostap::Models::QGaussian::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const
 {
+  OSTAP_PROBE ( "Ostap::Models::QGaussian::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ){}
   //
@@ -6722,7 +7441,7 @@ Double_t Ostap::Models::QGaussian::analyticalIntegral
   const double xmax =  m_x.max ( rangeName ) ;
   //
   setPars() ;
-  return m_qgauss.integral ( xmin , xmax ) ;
+  return m_icache.integral ( m_qgauss , xmin , xmax ) ;
 }
 // ============================================================================
 
@@ -6793,6 +7512,7 @@ void Ostap::Models::Hyperbolic::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Hyperbolic::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Hyperbolic::evaluate" ) ;
   setPars() ;
   return m_hyperbolic ( m_x ) ;
 }
@@ -6810,6 +7530,7 @@ Double_t Ostap::Models::Hyperbolic::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const
 {
+  OSTAP_PROBE ( "Ostap::Models::Hyperbolic::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ){}
   //
@@ -6817,7 +7538,7 @@ Double_t Ostap::Models::Hyperbolic::analyticalIntegral
   const double xmax =  m_x.max ( rangeName ) ;
   //
   setPars() ;
-  return m_hyperbolic.integral ( xmin , xmax ) ;
+  return m_icache.integral ( m_hyperbolic , xmin , xmax ) ;
 }
 // ============================================================================
 
@@ -6894,6 +7615,7 @@ void Ostap::Models::GenHyperbolic::setPars () const
 // ============================================================================
 Double_t Ostap::Models::GenHyperbolic::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::GenHyperbolic::evaluate" ) ;
   setPars() ;
   return m_hyperbolic ( m_x ) ;
 }
@@ -6911,6 +7633,7 @@ Double_t Ostap::Models::GenHyperbolic::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const
 {
+  OSTAP_PROBE ( "Ostap::Models::GenHyperbolic::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ){}
   //
@@ -6918,7 +7641,7 @@ Double_t Ostap::Models::GenHyperbolic::analyticalIntegral
   const double xmax =  m_x.max ( rangeName ) ;
   //
   setPars() ;
-  return m_hyperbolic.integral ( xmin , xmax ) ;
+  return m_icache.integral ( m_hyperbolic , xmin , xmax ) ;
 }
 // ============================================================================
 
@@ -6989,6 +7712,7 @@ void Ostap::Models::Das::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Das::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Das::evaluate" ) ;
   setPars() ;
   return m_das ( m_x ) ;
 }
@@ -7006,6 +7730,7 @@ Double_t Ostap::Models::Das::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const
 {
+  OSTAP_PROBE ( "Ostap::Models::Das::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ){}
   //
@@ -7088,9 +7813,34 @@ void Ostap::Models::CutOffGauss::setPars () const
 // ============================================================================
 Double_t Ostap::Models::CutOffGauss::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::CutOffGauss::evaluate" ) ;
   setPars() ;
   return m_cutoff ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::CutOffGauss , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::CutOffGauss::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_x0 ) ;
+  batch.add ( m_sigma ) ;
+  //
+  batch.evaluate 
+    ( m_cutoff , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_cutoff.setX0    ( p [ 0 ] ) ;
+        m_cutoff.setSigma ( p [ 1 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::CutOffGauss::getAnalyticalIntegral
 ( RooArgSet&  allVars       , 
@@ -7105,6 +7855,7 @@ Double_t Ostap::Models::CutOffGauss::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const
 {
+  OSTAP_PROBE ( "Ostap::Models::CutOffGauss::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ){}
   //
@@ -7192,9 +7943,36 @@ void Ostap::Models::CutOffStudent::setPars () const
 // ============================================================================
 Double_t Ostap::Models::CutOffStudent::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::CutOffStudent::evaluate" ) ;
   setPars() ;
   return m_cutoff ( m_x ) ;
 }
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::CutOffStudent , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::CutOffStudent::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_x0 ) ;
+  batch.add ( m_nu ) ;
+  batch.add ( m_sigma ) ;
+  //
+  batch.evaluate 
+    ( m_cutoff , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        m_cutoff.setX0    ( p [ 0 ] ) ;
+        m_cutoff.setNu    ( p [ 1 ] ) ;
+        m_cutoff.setSigma ( p [ 2 ] ) ;
+      } , output ) ;
+}
+#endif
 // ============================================================================
 Int_t Ostap::Models::CutOffStudent::getAnalyticalIntegral
 ( RooArgSet&  allVars       , 
@@ -7209,6 +7987,7 @@ Double_t Ostap::Models::CutOffStudent::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const
 {
+  OSTAP_PROBE ( "Ostap::Models::CutOffStudent::analyticalIntegral" ) ;
   assert ( code == 1 ) ;
   if ( 1 != code ){}
   //
@@ -7227,6 +8006,158 @@ Double_t Ostap::Models::CutOffStudent::analyticalIntegral
 
 
 
+// ============================================================================
+// constructor for 1D morphing
+// ============================================================================
+Ostap::Models::Morphing::Morphing
+( const char*                  name     ,
+  const char*                  title    ,
+  RooAbsReal&                  x        ,
+  RooAbsReal&                  mu       ,
+  const Ostap::Math::Morphing& morphing ) 
+  : RooAbsPdf  ( name , title ) 
+  , m_x        ( "x"   , "Observable"           , this , x ) 
+  , m_mus      ( "mus" , "Morphing parameters"  , this     ) 
+  , m_morphing ( morphing ) 
+{
+  Ostap::Assert ( m_morphing.mus2 ().empty ()             , 
+                  "Invalid morphing object: 2D morphing"  ,
+                  "Ostap::Models::Morphing"               ) ;
+  m_mus.add ( mu ) ;
+  setPars () ;
+}
+// ============================================================================
+// constructor for 2D morphing
+// ============================================================================
+Ostap::Models::Morphing::Morphing
+( const char*                  name     ,
+  const char*                  title    ,
+  RooAbsReal&                  x        ,
+  RooAbsReal&                  mu1      ,
+  RooAbsReal&                  mu2      ,
+  const Ostap::Math::Morphing& morphing ) 
+  : RooAbsPdf  ( name , title ) 
+  , m_x        ( "x"   , "Observable"           , this , x ) 
+  , m_mus      ( "mus" , "Morphing parameters"  , this     ) 
+  , m_morphing ( morphing ) 
+{
+  Ostap::Assert ( !m_morphing.mus2 ().empty ()            , 
+                  "Invalid morphing object: 1D morphing"  ,
+                  "Ostap::Models::Morphing"               ) ;
+  m_mus.add ( mu1 ) ;
+  m_mus.add ( mu2 ) ;
+  setPars () ;
+}
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::Models::Morphing::Morphing
+( const Ostap::Models::Morphing& right ,
+  const char*                    name  ) 
+  : RooAbsPdf  ( right , name ) 
+  , m_x        ( "x"   , this , right.m_x   ) 
+  , m_mus      ( "mus" , this , right.m_mus ) 
+  , m_morphing ( right.m_morphing ) 
+{}
+// ============================================================================
+// destructor 
+// ============================================================================
+Ostap::Models::Morphing::~Morphing(){}
+// ============================================================================
+// clone 
+// ============================================================================
+Ostap::Models::Morphing*
+Ostap::Models::Morphing::clone( const char* name ) const 
+{ return new Ostap::Models::Morphing(*this,name) ; }
+// ============================================================================
+// set the morphing parameters: the shape is recalculated only if they change 
+// ============================================================================
+void Ostap::Models::Morphing::setPars () const 
+{
+  const double mu1 = static_cast<const RooAbsReal&> ( m_mus [ 0 ] ).getVal () ;
+  const double mu2 = 2 <= ::size ( m_mus ) ?
+    static_cast<const RooAbsReal&> ( m_mus [ 1 ] ).getVal () : 0.0 ;
+  m_morphing.setMu ( mu1 , mu2 ) ;
+}
+// ============================================================================
+// the actual evaluation of function 
+// ============================================================================
+Double_t Ostap::Models::Morphing::evaluate() const 
+{
+  OSTAP_PROBE ( "Ostap::Models::Morphing::evaluate" ) ;
+  setPars() ;
+  return m_morphing ( m_x ) ;
+}
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Morphing , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Morphing::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , nEvents ) ;
+  batch.add ( m_mus ) ;
+  //
+  batch.evaluate 
+    ( m_morphing , 
+      [this] ( const std::vector<double>& p ) 
+      { m_morphing.setMu ( p [ 0 ] , 2 <= p.size () ? p [ 1 ] : 0.0 ) ; } , output ) ;
+}
+#endif
+// ============================================================================
+Int_t Ostap::Models::Morphing::getAnalyticalIntegral
+( RooArgSet&  allVars       , 
+  RooArgSet&  analVars      ,
+  const char* /*rangeName*/ ) const
+{
+  if ( matchArgs ( allVars , analVars , m_x ) ) { return 1 ; }
+  return 0 ;
+}
+// ============================================================================
+Double_t Ostap::Models::Morphing::analyticalIntegral
+( Int_t       code      , 
+  const char* rangeName ) const
+{
+  OSTAP_PROBE ( "Ostap::Models::Morphing::analyticalIntegral" ) ;
+  assert ( code == 1 ) ;
+  if ( 1 != code ){}
+  //
+  setPars() ;
+  return m_morphing.integral ( m_x.min ( rangeName ) , m_x.max ( rangeName ) ) ;
+}
+// ============================================================================
+// sample the PDF at the bin centers of the uniform binning 
+// ============================================================================
+std::vector<double> Ostap::Models::Morphing::sample
+( const RooAbsPdf&   pdf   ,
+  RooRealVar&        x     ,
+  const unsigned int nbins ) 
+{
+  Ostap::Assert ( 0 < nbins && x.hasMin () && x.hasMax () ,
+                  "Invalid observable/binning"            ,
+                  "Ostap::Models::Morphing"               ) ;
+  //
+  const double    xmin  = x.getMin () ;
+  const double    xmax  = x.getMax () ;
+  const double    h     = ( xmax - xmin ) / nbins ;
+  const double    saved = x.getVal () ;
+  const RooArgSet nset  ( x ) ;
+  //
+  std::vector<double> result ( nbins , 0.0 ) ;
+  for ( unsigned int k = 0 ; k < nbins ; ++k ) 
+  {
+    x.setVal ( xmin + ( k + 0.5 ) * h ) ;
+    result [ k ] = pdf.getVal ( &nset ) ;
+  }
+  x.setVal ( saved ) ;
+  return result ;
+}
+// ============================================================================
+
 // ============================================================================
 // Flat in 1D
 // ============================================================================
@@ -7318,6 +8249,7 @@ Double_t Ostap::Models::Uniform::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Uniform::analyticalIntegral" ) ;
   // 3D-integral 
   if      ( 3 == m_dim && 1 == code ) 
   {
@@ -7453,6 +8385,7 @@ ClassImp(Ostap::Models::ConvexOnlySpline   )
 ClassImp(Ostap::Models::ConvexSpline       )
 ClassImp(Ostap::Models::CutOffGauss        )
 ClassImp(Ostap::Models::CutOffStudent      )
+ClassImp(Ostap::Models::Morphing           )
 // ============================================================================
 //                                                                      The END 
 // ============================================================================
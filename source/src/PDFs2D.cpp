@@ -10,6 +10,7 @@
 #include "Ostap/StatusCode.h"
 #include "Ostap/PDFs2D.h"
 #include "Ostap/Iterator.h"
+#include "Ostap/Instrument.h"
 // ============================================================================
 // ROOT 
 // ============================================================================
@@ -20,6 +21,7 @@
 // Local
 // ============================================================================
 #include "local_roofit.h"
+#include "local_batch.h"
 // ============================================================================
 /** @file 
  *  Implementation file for namespace Ostap::Models
@@ -88,12 +90,35 @@ void Ostap::Models::Poly2DPositive::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Poly2DPositive::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Poly2DPositive::evaluate" ) ;
   //
   setPars () ;
   //
   return m_positive ( m_x , m_y ) ; 
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Poly2DPositive , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Poly2DPositive::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate2D 
+    ( m_positive , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_positive.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::Poly2DPositive::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -110,12 +135,13 @@ Double_t Ostap::Models::Poly2DPositive::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Poly2DPositive::analyticalIntegral" ) ;
   assert ( 1 == code || 2 ==code || 3 == code ) ;
   //
   setPars () ;
   //
   return 
-    1 == code ? m_positive.integral   (        m_x.min(rangeName) , m_x.max(rangeName) ,
+    1 == code ? m_icache.integral ( m_positive , m_x.min(rangeName) , m_x.max(rangeName) ,
                                                m_y.min(rangeName) , m_y.max(rangeName) ) : 
     2 == code ? m_positive.integrateX ( m_y  , m_x.min(rangeName) , m_x.max(rangeName) ) : 
     3 == code ? m_positive.integrateY ( m_x  , m_y.min(rangeName) , m_y.max(rangeName) ) : 0.0 ;  
@@ -189,12 +215,35 @@ void Ostap::Models::Poly2DSymPositive::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Poly2DSymPositive::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Poly2DSymPositive::evaluate" ) ;
   //
   setPars () ;
   //
   return m_positive ( m_x , m_y ) ; 
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Poly2DSymPositive , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Poly2DSymPositive::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate2D 
+    ( m_positive , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_positive.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::Poly2DSymPositive::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -211,12 +260,13 @@ Double_t Ostap::Models::Poly2DSymPositive::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Poly2DSymPositive::analyticalIntegral" ) ;
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
   setPars () ;
   //
   return 
-    1 == code ? m_positive.integral   (        m_x.min(rangeName) , m_x.max(rangeName) , 
+    1 == code ? m_icache.integral ( m_positive , m_x.min(rangeName) , m_x.max(rangeName) , 
                                                m_y.min(rangeName) , m_y.max(rangeName) ) : 
     2 == code ? m_positive.integrateX ( m_y  , m_x.min(rangeName) , m_x.max(rangeName) ) : 
     3 == code ? m_positive.integrateY ( m_x  , m_y.min(rangeName) , m_y.max(rangeName) ) : 0.0 ;  
@@ -319,12 +369,35 @@ void Ostap::Models::PS2DPol::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PS2DPol::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPol::evaluate" ) ;
   //
   setPars () ;
   //
   return m_function ( m_x , m_y ) ;
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::PS2DPol , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::PS2DPol::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate2D 
+    ( ::loop2D ( m_function ) , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_function.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::PS2DPol::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -341,12 +414,13 @@ Double_t Ostap::Models::PS2DPol::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPol::analyticalIntegral" ) ;
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
   setPars () ;
   //
   return 
-    1 == code ? m_function.integral   (        m_x.min(rangeName) , m_x.max(rangeName) , 
+    1 == code ? m_icache.integral ( m_function , m_x.min(rangeName) , m_x.max(rangeName) , 
                                                m_y.min(rangeName) , m_y.max(rangeName) ) : 
     2 == code ? m_function.integrateX ( m_y  , m_x.min(rangeName) , m_x.max(rangeName) ) : 
     3 == code ? m_function.integrateY ( m_x  , m_y.min(rangeName) , m_y.max(rangeName) ) : 0.0 ;  
@@ -450,12 +524,35 @@ void Ostap::Models::PS2DPol2::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PS2DPol2::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPol2::evaluate" ) ;
   //
   setPars () ;
   //
   return m_function ( m_x , m_y ) ;
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::PS2DPol2 , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::PS2DPol2::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate2D 
+    ( ::loop2D ( m_function ) , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_function.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::PS2DPol2::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -472,12 +569,13 @@ Double_t Ostap::Models::PS2DPol2::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPol2::analyticalIntegral" ) ;
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
   setPars () ;
   //
   return 
-    1 == code ? m_function.integral   (        m_x.min(rangeName) , m_x.max(rangeName) , 
+    1 == code ? m_icache.integral ( m_function , m_x.min(rangeName) , m_x.max(rangeName) , 
                                                m_y.min(rangeName) , m_y.max(rangeName) ) : 
     2 == code ? m_function.integrateX ( m_y  , m_x.min(rangeName) , m_x.max(rangeName) ) : 
     3 == code ? m_function.integrateY ( m_x  , m_y.min(rangeName) , m_y.max(rangeName) ) : 0.0 ;  
@@ -584,12 +682,35 @@ void Ostap::Models::PS2DPol3::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PS2DPol3::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPol3::evaluate" ) ;
   //
   setPars () ;
   //
   return m_function ( m_x , m_y ) ;
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::PS2DPol3 , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::PS2DPol3::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate2D 
+    ( ::loop2D ( m_function ) , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_function.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::PS2DPol3::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -606,12 +727,13 @@ Double_t Ostap::Models::PS2DPol3::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPol3::analyticalIntegral" ) ;
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
   setPars () ;
   //
   return 
-    1 == code ? m_function.integral   (        m_x.min(rangeName) , m_x.max(rangeName) , 
+    1 == code ? m_icache.integral ( m_function , m_x.min(rangeName) , m_x.max(rangeName) , 
                                                m_y.min(rangeName) , m_y.max(rangeName) ) : 
     2 == code ? m_function.integrateX ( m_y  , m_x.min(rangeName) , m_x.max(rangeName) ) : 
     3 == code ? m_function.integrateY ( m_x  , m_y.min(rangeName) , m_y.max(rangeName) ) : 0.0 ;  
@@ -712,12 +834,35 @@ void Ostap::Models::PS2DPolSym::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PS2DPolSym::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPolSym::evaluate" ) ;
   //
   setPars () ;
   //
   return m_function ( m_x , m_y ) ;
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::PS2DPolSym , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::PS2DPolSym::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate2D 
+    ( ::loop2D ( m_function ) , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_function.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::PS2DPolSym::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -734,12 +879,13 @@ Double_t Ostap::Models::PS2DPolSym::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPolSym::analyticalIntegral" ) ;
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
   setPars () ;
   //
   return 
-    1 == code ? m_function.integral   (        m_x.min(rangeName) , m_x.max(rangeName) , 
+    1 == code ? m_icache.integral ( m_function , m_x.min(rangeName) , m_x.max(rangeName) , 
                                                m_y.min(rangeName) , m_y.max(rangeName) ) : 
     2 == code ? m_function.integrateX ( m_y  , m_x.min(rangeName) , m_x.max(rangeName) ) : 
     3 == code ? m_function.integrateY ( m_x  , m_y.min(rangeName) , m_y.max(rangeName) ) : 0.0 ;  
@@ -839,12 +985,35 @@ void Ostap::Models::PS2DPol2Sym::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PS2DPol2Sym::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPol2Sym::evaluate" ) ;
   //
   setPars () ;
   //
   return m_function ( m_x , m_y ) ;
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::PS2DPol2Sym , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::PS2DPol2Sym::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate2D 
+    ( ::loop2D ( m_function ) , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_function.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::PS2DPol2Sym::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -861,12 +1030,13 @@ Double_t Ostap::Models::PS2DPol2Sym::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPol2Sym::analyticalIntegral" ) ;
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
   setPars () ;
   //
   return 
-    1 == code ? m_function.integral   (        m_x.min(rangeName) , m_x.max(rangeName) , 
+    1 == code ? m_icache.integral ( m_function , m_x.min(rangeName) , m_x.max(rangeName) , 
                                                m_y.min(rangeName) , m_y.max(rangeName) ) : 
     2 == code ? m_function.integrateX ( m_y  , m_x.min(rangeName) , m_x.max(rangeName) ) : 
     3 == code ? m_function.integrateY ( m_x  , m_y.min(rangeName) , m_y.max(rangeName) ) : 0.0 ;  
@@ -965,12 +1135,35 @@ void Ostap::Models::PS2DPol3Sym::setPars () const
 // ============================================================================
 Double_t Ostap::Models::PS2DPol3Sym::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPol3Sym::evaluate" ) ;
   //
   setPars () ;
   //
   return m_function ( m_x , m_y ) ;
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::PS2DPol3Sym , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::PS2DPol3Sym::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate2D 
+    ( ::loop2D ( m_function ) , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_function.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::PS2DPol3Sym::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -987,12 +1180,13 @@ Double_t Ostap::Models::PS2DPol3Sym::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PS2DPol3Sym::analyticalIntegral" ) ;
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
   setPars () ;
   //
   return 
-    1 == code ? m_function.integral   (        m_x.min(rangeName) , m_x.max(rangeName) , 
+    1 == code ? m_icache.integral ( m_function , m_x.min(rangeName) , m_x.max(rangeName) , 
                                                m_y.min(rangeName) , m_y.max(rangeName) ) : 
     2 == code ? m_function.integrateX ( m_y  , m_x.min(rangeName) , m_x.max(rangeName) ) : 
     3 == code ? m_function.integrateY ( m_x  , m_y.min(rangeName) , m_y.max(rangeName) ) : 0.0 ;  
@@ -1107,12 +1301,40 @@ void Ostap::Models::ExpoPS2DPol::setPars () const
 // ============================================================================
 Double_t Ostap::Models::ExpoPS2DPol::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::ExpoPS2DPol::evaluate" ) ;
   //
   setPars () ;
   //
   return m_function ( m_x , m_y ) ;
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::ExpoPS2DPol , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::ExpoPS2DPol::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  batch.add ( m_tau ) ;
+  //
+  batch.evaluate2D 
+    ( ::loop2D ( m_function ) , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        const unsigned int n = p.size() - 1 ;
+        for ( unsigned int k = 0 ; k < n ; ++k ) { m_function.setPar ( k , p [ k ] ) ; }
+        m_function.setTau ( p [ n ] ) ;
+      } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::ExpoPS2DPol::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -1129,12 +1351,13 @@ Double_t Ostap::Models::ExpoPS2DPol::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::ExpoPS2DPol::analyticalIntegral" ) ;
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
   setPars () ;
   //
   return 
-    1 == code ? m_function.integral   (        m_x.min(rangeName) , m_x.max(rangeName) , 
+    1 == code ? m_icache.integral ( m_function , m_x.min(rangeName) , m_x.max(rangeName) , 
                                                m_y.min(rangeName) , m_y.max(rangeName) ) : 
     2 == code ? m_function.integrateX ( m_y  , m_x.min(rangeName) , m_x.max(rangeName) ) : 
     3 == code ? m_function.integrateY ( m_x  , m_y.min(rangeName) , m_y.max(rangeName) ) : 0.0 ;  
@@ -1224,12 +1447,42 @@ void Ostap::Models::Expo2DPol::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Expo2DPol::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Expo2DPol::evaluate" ) ;
   //
   setPars () ;
   //
   return m_function ( m_x , m_y ) ;
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Expo2DPol , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Expo2DPol::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  batch.add ( m_taux ) ;
+  batch.add ( m_tauy ) ;
+  //
+  batch.evaluate2D 
+    ( ::loop2D ( m_function ) , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        const unsigned int n = p.size() - 2 ;
+        for ( unsigned int k = 0 ; k < n ; ++k ) { m_function.setPar ( k , p [ k ] ) ; }
+        m_function.setTauX ( p [ n ] ) ;
+        m_function.setTauY ( p [ n + 1 ] ) ;
+      } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::Expo2DPol::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -1246,12 +1499,13 @@ Double_t Ostap::Models::Expo2DPol::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Expo2DPol::analyticalIntegral" ) ;
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
   setPars () ;
   //
   return 
-    1 == code ? m_function.integral   (        m_x.min(rangeName) , m_x.max(rangeName) , 
+    1 == code ? m_icache.integral ( m_function , m_x.min(rangeName) , m_x.max(rangeName) , 
                                                m_y.min(rangeName) , m_y.max(rangeName) ) : 
     2 == code ? m_function.integrateX ( m_y  , m_x.min(rangeName) , m_x.max(rangeName) ) : 
     3 == code ? m_function.integrateY ( m_x  , m_y.min(rangeName) , m_y.max(rangeName) ) : 0.0 ;  
@@ -1330,12 +1584,40 @@ void Ostap::Models::Expo2DPolSym::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Expo2DPolSym::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Expo2DPolSym::evaluate" ) ;
   //
   setPars () ;
   //
   return m_function ( m_x , m_y ) ;
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Expo2DPolSym , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Expo2DPolSym::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  batch.add ( m_tau ) ;
+  //
+  batch.evaluate2D 
+    ( ::loop2D ( m_function ) , 
+      [this] ( const std::vector<double>& p ) 
+      {
+        const unsigned int n = p.size() - 1 ;
+        for ( unsigned int k = 0 ; k < n ; ++k ) { m_function.setPar ( k , p [ k ] ) ; }
+        m_function.setTau ( p [ n ] ) ;
+      } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::Expo2DPolSym::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -1352,12 +1634,13 @@ Double_t Ostap::Models::Expo2DPolSym::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Expo2DPolSym::analyticalIntegral" ) ;
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
   setPars () ;
   //
   return 
-    1 == code ? m_function.integral   (        m_x.min(rangeName) , m_x.max(rangeName) , 
+    1 == code ? m_icache.integral ( m_function , m_x.min(rangeName) , m_x.max(rangeName) , 
                                                m_y.min(rangeName) , m_y.max(rangeName) ) : 
     2 == code ? m_function.integrateX ( m_y  , m_x.min(rangeName) , m_x.max(rangeName) ) : 
     3 == code ? m_function.integrateY ( m_x  , m_y.min(rangeName) , m_y.max(rangeName) ) : 0.0 ;  
@@ -1435,12 +1718,35 @@ void Ostap::Models::Spline2D::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Spline2D::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Spline2D::evaluate" ) ;
   //
   setPars () ;
   //
   return m_spline ( m_x , m_y ) ; 
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Spline2D , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Spline2D::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate2D 
+    ( m_spline , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_spline.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::Spline2D::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -1457,6 +1763,7 @@ Double_t Ostap::Models::Spline2D::analyticalIntegral
 ( Int_t       code       , 
   const char* rangeName  ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Spline2D::analyticalIntegral" ) ;
   //
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
@@ -1534,12 +1841,35 @@ void Ostap::Models::Spline2DSym::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Spline2DSym::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Spline2DSym::evaluate" ) ;
   //
   setPars () ;
   //
   return m_spline ( m_x , m_y ) ; 
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Spline2DSym , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Spline2DSym::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate2D 
+    ( ::loop2D ( m_spline ) , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_spline.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::Spline2DSym::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -1556,6 +1886,7 @@ Double_t Ostap::Models::Spline2DSym::analyticalIntegral
 ( Int_t       code       , 
   const char* rangeName  ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Spline2DSym::analyticalIntegral" ) ;
   //
   assert ( 1 == code || 2 == code || 3 == code ) ;
   //
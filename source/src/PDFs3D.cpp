@@ -10,6 +10,7 @@
 #include "Ostap/StatusCode.h"
 #include "Ostap/PDFs3D.h"
 #include "Ostap/Iterator.h"
+#include "Ostap/Instrument.h"
 // ============================================================================
 // ROOT 
 // ============================================================================
@@ -19,6 +20,7 @@
 // Local
 // ============================================================================
 #include "local_roofit.h"
+#include "local_batch.h"
 // ============================================================================
 /** @file 
  *  Implementation file for namespace Ostap::Models
@@ -95,10 +97,33 @@ void Ostap::Models::Poly3DPositive::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Poly3DPositive::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Poly3DPositive::evaluate" ) ;
   setPars () ;
   return m_positive ( m_x , m_y , m_z ) ; 
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Poly3DPositive , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Poly3DPositive::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , m_z , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate3D 
+    ( m_positive , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_positive.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::Poly3DPositive::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -120,12 +145,16 @@ Double_t Ostap::Models::Poly3DPositive::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Poly3DPositive::analyticalIntegral" ) ;
   assert ( 1 <= code && code <=7 ) ;
   //
+  setPars () ;
+  //
   return 
     // 3D-integral
-    1 == code ? m_positive.integral
-    ( m_x.min ( rangeName ) , m_x.max ( rangeName ) ,
+    1 == code ? m_icache.integral
+    ( m_positive , 
+      m_x.min ( rangeName ) , m_x.max ( rangeName ) ,
       m_y.min ( rangeName ) , m_y.max ( rangeName ) , 
       m_z.min ( rangeName ) , m_z.max ( rangeName ) ) : 
     // 2D-integrals
@@ -221,10 +250,33 @@ void Ostap::Models::Poly3DSymPositive::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Poly3DSymPositive::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Poly3DSymPositive::evaluate" ) ;
   setPars () ;
   return m_positive ( m_x , m_y , m_z ) ; 
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Poly3DSymPositive , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Poly3DSymPositive::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , m_z , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate3D 
+    ( m_positive , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_positive.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::Poly3DSymPositive::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -246,12 +298,16 @@ Double_t Ostap::Models::Poly3DSymPositive::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Poly3DSymPositive::analyticalIntegral" ) ;
   assert ( 1 <= code && code <=7 ) ;
   //
+  setPars () ;
+  //
   return 
     // 3D-integral
-    1 == code ? m_positive.integral
-    ( m_x.min ( rangeName ) , m_x.max ( rangeName ) ,
+    1 == code ? m_icache.integral
+    ( m_positive , 
+      m_x.min ( rangeName ) , m_x.max ( rangeName ) ,
       m_y.min ( rangeName ) , m_y.max ( rangeName ) , 
       m_z.min ( rangeName ) , m_z.max ( rangeName ) ) : 
     // 2D-integrals
@@ -350,10 +406,33 @@ void Ostap::Models::Poly3DMixPositive::setPars () const
 // ============================================================================
 Double_t Ostap::Models::Poly3DMixPositive::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Poly3DMixPositive::evaluate" ) ;
   setPars () ;
   return m_positive ( m_x , m_y , m_z ) ; 
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT ( Ostap::Models::Poly3DMixPositive , RooAbsPdf )
+// ============================================================================
+void Ostap::Models::Poly3DMixPositive::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  ::Batch batch ( data , m_x , m_y , m_z , nEvents ) ;
+  batch.add ( m_phis ) ;
+  //
+  batch.evaluate3D 
+    ( m_positive , 
+      [this] ( const std::vector<double>& p ) 
+      { for ( unsigned int k = 0 ; k < p.size() ; ++k ) { m_positive.setPar ( k , p [ k ] ) ; } } , 
+      output ) ;
+}
+#endif
+// ============================================================================
 Int_t Ostap::Models::Poly3DMixPositive::getAnalyticalIntegral
 ( RooArgSet&     allVars      , 
   RooArgSet&     analVars     ,
@@ -375,12 +454,16 @@ Double_t Ostap::Models::Poly3DMixPositive::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::Poly3DMixPositive::analyticalIntegral" ) ;
   assert ( 1 <= code && code <=7 ) ;
   //
+  setPars () ;
+  //
   return 
     // 3D-integral
-    1 == code ? m_positive.integral
-    ( m_x.min ( rangeName ) , m_x.max ( rangeName ) ,
+    1 == code ? m_icache.integral
+    ( m_positive , 
+      m_x.min ( rangeName ) , m_x.max ( rangeName ) ,
       m_y.min ( rangeName ) , m_y.max ( rangeName ) , 
       m_z.min ( rangeName ) , m_z.max ( rangeName ) ) : 
     // 2D-integrals
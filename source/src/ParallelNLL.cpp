@@ -0,0 +1,557 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <atomic>
+#include <map>
+#include <algorithm>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooAbsPdf.h"
+#include "RooAbsData.h"
+#include "RooAbsCategory.h"
+#include "RooRealVar.h"
+#include "RooArgSet.h"
+#include "RooSimultaneous.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Math.h"
+#include "Ostap/ParallelNLL.h"
+#include "Ostap/CompactData.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::MoreRooFit::ParallelNLL
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-03-19
+ */
+// ============================================================================
+ClassImp(Ostap::MoreRooFit::ParallelNLL)
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_DATA        = 800 ,
+    INVALID_PDF         = 801 ,
+    INVALID_CATEGORY    = 802 ,
+    INVALID_OBSERVABLE  = 803 ,
+  } ;
+  // ==========================================================================
+  /// the minimal value of PDF
+  const double s_TINY = 1.e-300 ;
+  // ==========================================================================
+  /// Kahan summation
+  class Kahan
+  {
+  public:
+    // ========================================================================
+    void add ( const long double value )
+    {
+      volatile const long double y = value - m_c   ;
+      volatile const long double t = m_sum + y     ;
+      m_c   = ( t - m_sum ) - y ;
+      m_sum = t ;
+    }
+    double sum () const { return m_sum ; }
+    // ========================================================================
+  private:
+    // ========================================================================
+    long double m_sum { 0 } ;
+    long double m_c   { 0 } ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** @struct Replica
+   *  The thread-local deep copy of PDF
+   */
+  struct Replica
+  {
+    // ========================================================================
+    /// synchronize the parameters with the original PDF
+    void sync () const
+    {
+      for ( const auto& p : parameters )
+      {
+        const double value = p.second->getVal () ;
+        if ( value != p.first->getVal () ) { p.first->setVal ( value ) ; }
+      }
+    }
+    // ========================================================================
+    /// evaluate NLL for the task
+    double evaluate
+    ( const Ostap::MoreRooFit::ParallelNLL::Partition& partition ,
+      const Ostap::MoreRooFit::ParallelNLL::Task&      task      ,
+      const bool                                       extended  ,
+      const Ostap::Utils::CompactData*                 compact   ) const
+    {
+      const RooAbsPdf*                pdf  = pdfs        [ task.partition ] ;
+      const std::vector<RooRealVar*>& vars = observables [ task.partition ] ;
+      const RooArgSet*                nset = nsets       [ task.partition ].get () ;
+      const std::size_t               no   = vars.size () ;
+      //
+      Kahan kahan {} ;
+      if      ( nullptr == compact )
+      {
+        const double* values = partition.values.data () + task.first * no ;
+        for ( unsigned long i = task.first ; i < task.last ; ++i , values += no )
+        {
+          const double w = partition.weights [ i ] ;
+          if ( 0 == w ) { continue ; }
+          for ( std::size_t j = 0 ; j < no ; ++j ) { vars [ j ]->setVal ( values [ j ] ) ; }
+          const double v = pdf->getVal ( nset ) ;
+          kahan.add ( -w * std::log ( std::max ( v , s_TINY ) ) ) ;
+        }
+      }
+      else if ( partition.rows.empty () )
+      {
+        // contiguous rows: convert the whole chunk to double precision at once
+        const std::size_t n = task.last - task.first ;
+        buffer.resize ( ( no + 1 ) * n ) ;
+        for ( std::size_t j = 0 ; j < no ; ++j )
+        { compact->values ( partition.columns [ j ] , task.first , n , buffer.data () + j * n ) ; }
+        const double* weights = buffer.data () + no * n ;
+        compact->weights ( task.first , n , buffer.data () + no * n ) ;
+        for ( std::size_t i = 0 ; i < n ; ++i )
+        {
+          const double w = weights [ i ] ;
+          if ( 0 == w ) { continue ; }
+          for ( std::size_t j = 0 ; j < no ; ++j ) { vars [ j ]->setVal ( buffer [ j * n + i ] ) ; }
+          const double v = pdf->getVal ( nset ) ;
+          kahan.add ( -w * std::log ( std::max ( v , s_TINY ) ) ) ;
+        }
+      }
+      else
+      {
+        for ( unsigned long i = task.first ; i < task.last ; ++i )
+        {
+          const std::size_t row = partition.rows [ i ] ;
+          const double      w   = compact->weight ( row ) ;
+          if ( 0 == w ) { continue ; }
+          for ( std::size_t j = 0 ; j < no ; ++j )
+          { vars [ j ]->setVal ( compact->value ( partition.columns [ j ] , row ) ) ; }
+          const double v = pdf->getVal ( nset ) ;
+          kahan.add ( -w * std::log ( std::max ( v , s_TINY ) ) ) ;
+        }
+      }
+      //
+      // extended term: once per partition
+      if ( extended && 0 == task.first )
+      {
+        const double nu = pdf->expectedEvents ( nset ) ;
+        kahan.add ( nu - partition.sumw * std::log ( std::max ( nu , s_TINY ) ) ) ;
+      }
+      //
+      return kahan.sum () ;
+    }
+    // ========================================================================
+    /// the deep copy of PDF (with parameters and observables)
+    std::unique_ptr<RooArgSet>                            clones      {} ;
+    /// the PDFs for partitions
+    std::vector<const RooAbsPdf*>                         pdfs        {} ;
+    /// the observables for partitions
+    std::vector<std::vector<RooRealVar*> >                observables {} ;
+    /// the normalization sets for partitions
+    std::vector<std::unique_ptr<RooArgSet> >              nsets       {} ;
+    /// the parameters: (copy, original)
+    std::vector<std::pair<RooRealVar*,const RooAbsReal*> > parameters {} ;
+    /// the buffer for the values from the compact data
+    mutable std::vector<double>                           buffer      {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+}
+// ============================================================================
+/** @class Ostap::MoreRooFit::ParallelNLL::Replicas
+ *  The per-thread replicas of PDF and the persistent thread pool
+ */
+// ============================================================================
+class Ostap::MoreRooFit::ParallelNLL::Replicas
+{
+public:
+  // ==========================================================================
+  Replicas
+  ( const RooAbsPdf&              pdf        ,
+    const RooArgSet&              params     ,
+    const std::vector<Partition>& partitions ,
+    const bool                    extended   ,
+    const unsigned int            nthreads   ,
+    const Ostap::Utils::CompactData* compact = nullptr )
+    : m_replicas ( std::max ( 1u , nthreads ) )
+  {
+    for ( Replica& r : m_replicas )
+    {
+      r.clones.reset ( new RooArgSet () ) ;
+      RooArgSet ( pdf ).snapshot ( *r.clones , true ) ;
+      //
+      for ( const RooAbsArg* a : params )
+      {
+        RooRealVar* v = dynamic_cast<RooRealVar*> ( r.clones->find ( a->GetName () ) ) ;
+        if ( nullptr != v ) { r.parameters.emplace_back ( v , static_cast<const RooAbsReal*> ( a ) ) ; }
+      }
+      //
+      for ( const Partition& p : partitions )
+      {
+        const RooAbsPdf* cpdf = dynamic_cast<const RooAbsPdf*> ( r.clones->find ( p.pdf.c_str () ) ) ;
+        Ostap::Assert ( nullptr != cpdf                         ,
+                        "Cannot clone PDF " + p.pdf             ,
+                        "Ostap::MoreRooFit::ParallelNLL"        , INVALID_PDF ) ;
+        r.pdfs.push_back ( cpdf ) ;
+        //
+        std::vector<RooRealVar*> vars ;
+        std::unique_ptr<RooArgSet> nset { new RooArgSet () } ;
+        for ( const std::string& name : p.observables )
+        {
+          RooRealVar* v = dynamic_cast<RooRealVar*> ( r.clones->find ( name.c_str () ) ) ;
+          Ostap::Assert ( nullptr != v                          ,
+                          "Cannot clone observable " + name     ,
+                          "Ostap::MoreRooFit::ParallelNLL"      , INVALID_OBSERVABLE ) ;
+          vars.push_back ( v ) ;
+          nset->add ( *v ) ;
+        }
+        r.observables.push_back ( vars ) ;
+        r.nsets      .push_back ( std::move ( nset ) ) ;
+      }
+      //
+      // warm-up: the normalization integrals are created here, in the calling thread
+      r.sync () ;
+      for ( std::size_t k = 0 ; k < partitions.size () ; ++k )
+      {
+        const Partition& p = partitions [ k ] ;
+        if ( 0 == p.size () ) { continue ; }
+        const std::size_t row = p.rows.empty () ? 0 : p.rows.front () ;
+        for ( std::size_t j = 0 ; j < r.observables [ k ].size () ; ++j )
+        {
+          r.observables [ k ][ j ]->setVal 
+            ( nullptr == compact ? p.values [ j ] : compact->value ( p.columns [ j ] , row ) ) ;
+        }
+        r.pdfs [ k ]->getVal ( r.nsets [ k ].get () ) ;
+        if ( extended ) { r.pdfs [ k ]->expectedEvents ( r.nsets [ k ].get () ) ; }
+      }
+    }
+  }
+  // ==========================================================================
+  /// the replicas
+  const std::vector<Replica>& replicas () const { return m_replicas ; }
+  /// the thread pool
+  Ostap::Utils::WorkerPool&   pool     ()       { return m_pool     ; }
+  // ==========================================================================
+private:
+  // ==========================================================================
+  /// the replicas
+  std::vector<Replica>     m_replicas ;
+  /// the thread pool (destroyed before the replicas)
+  Ostap::Utils::WorkerPool m_pool     { static_cast<unsigned int> ( m_replicas.size () ) } ;
+  // ==========================================================================
+} ;
+// ============================================================================
+/*  constructor
+ *  @param name       the name
+ *  @param title      the title
+ *  @param pdf        the PDF (e.g. <code>RooSimultaneous</code>)
+ *  @param data       the data
+ *  @param extended   use extended likelihood?
+ *  @param nthreads   the number of threads
+ *  @param chunk_size the (minimal) number of events per task
+ */
+// ============================================================================
+Ostap::MoreRooFit::ParallelNLL::ParallelNLL
+( const std::string&  name       ,
+  const std::string&  title      ,
+  const RooAbsPdf&    pdf        ,
+  const RooAbsData&   data       ,
+  const bool          extended   ,
+  const unsigned int  nthreads   ,
+  const unsigned long chunk_size )
+  : RooAbsReal   ( name.c_str () , title.c_str () )
+  , m_parameters ( "!pars" , "parameters" , this )
+  , m_extended   ( extended )
+  , m_nthreads   ( Ostap::Utils::nThreads ( nthreads ) )
+  , m_pdf        ( &pdf )
+{
+  const RooArgSet* vars = data.get () ;
+  Ostap::Assert ( nullptr != vars                  ,
+                  "Invalid data"                   ,
+                  "Ostap::MoreRooFit::ParallelNLL" , INVALID_DATA ) ;
+  //
+  std::unique_ptr<RooArgSet> pars { pdf.getParameters ( *vars ) } ;
+  for ( RooAbsArg* a : *pars )
+  { if ( nullptr != dynamic_cast<RooAbsReal*> ( a ) ) { m_parameters.add ( *a ) ; } }
+  //
+  split_ ( data , chunk_size ) ;
+}
+// ============================================================================
+/*  constructor from the compact (single-precision) data
+ *  @param name       the name
+ *  @param title      the title
+ *  @param pdf        the PDF (e.g. <code>RooSimultaneous</code>)
+ *  @param data       the data (not owned)
+ *  @param extended   use extended likelihood?
+ *  @param nthreads   the number of threads
+ *  @param chunk_size the (minimal) number of events per task
+ */
+// ============================================================================
+Ostap::MoreRooFit::ParallelNLL::ParallelNLL
+( const std::string&               name       ,
+  const std::string&               title      ,
+  const RooAbsPdf&                 pdf        ,
+  const Ostap::Utils::CompactData& data       ,
+  const bool                       extended   ,
+  const unsigned int               nthreads   ,
+  const unsigned long              chunk_size )
+  : RooAbsReal   ( name.c_str () , title.c_str () )
+  , m_parameters ( "!pars" , "parameters" , this )
+  , m_extended   ( extended )
+  , m_nthreads   ( Ostap::Utils::nThreads ( nthreads ) )
+  , m_pdf        ( &pdf  )
+  , m_compact    ( &data )
+{
+  std::unique_ptr<RooArgSet> variables { pdf.getVariables () } ;
+  RooArgSet observables ;
+  for ( const RooAbsArg* a : *variables )
+  {
+    if ( data.nColumns    () != data.column   ( a->GetName () ) ||
+         data.nCategories () != data.category ( a->GetName () ) ) { observables.add ( *a ) ; }
+  }
+  //
+  std::unique_ptr<RooArgSet> pars { pdf.getParameters ( observables ) } ;
+  for ( RooAbsArg* a : *pars )
+  { if ( nullptr != dynamic_cast<RooAbsReal*> ( a ) ) { m_parameters.add ( *a ) ; } }
+  //
+  split_ ( data , chunk_size ) ;
+}
+// ============================================================================
+// default constructor, needed for serialization
+// ============================================================================
+Ostap::MoreRooFit::ParallelNLL::ParallelNLL () = default ;
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::MoreRooFit::ParallelNLL::ParallelNLL
+( const Ostap::MoreRooFit::ParallelNLL& right ,
+  const char*                           name  )
+  : RooAbsReal   ( right , name )
+  , m_parameters ( "!pars" , this , right.m_parameters )
+  , m_extended   ( right.m_extended   )
+  , m_nthreads   ( right.m_nthreads   )
+  , m_pdf        ( right.m_pdf        )
+  , m_compact    ( right.m_compact    )
+  , m_partitions ( right.m_partitions )
+  , m_tasks      ( right.m_tasks      )
+{}
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::MoreRooFit::ParallelNLL::~ParallelNLL(){}
+// ============================================================================
+// clone method
+// ============================================================================
+Ostap::MoreRooFit::ParallelNLL*
+Ostap::MoreRooFit::ParallelNLL::clone ( const char* newname ) const
+{ return new Ostap::MoreRooFit::ParallelNLL ( *this , newname ) ; }
+// ============================================================================
+// split the data into partitions and tasks
+// ============================================================================
+void Ostap::MoreRooFit::ParallelNLL::split_
+( const RooAbsData&   data       ,
+  const unsigned long chunk_size )
+{
+  const RooSimultaneous* sim     = dynamic_cast<const RooSimultaneous*> ( m_pdf ) ;
+  const std::string      catname = nullptr == sim ? "" : sim->indexCat ().GetName () ;
+  //
+  std::map<std::string,unsigned int>            index ;
+  std::vector<std::vector<const RooAbsReal*> >  rowvars ;
+  //
+  const int nentries = data.numEntries () ;
+  for ( int i = 0 ; i < nentries ; ++i )
+  {
+    const RooArgSet* row = data.get ( i ) ;
+    const double     w   = data.weight () ;
+    //
+    std::string label {} ;
+    if ( nullptr != sim )
+    {
+      const RooAbsCategory* cat = dynamic_cast<const RooAbsCategory*> ( row->find ( catname.c_str () ) ) ;
+      Ostap::Assert ( nullptr != cat                       ,
+                      "No category " + catname + " in data" ,
+                      "Ostap::MoreRooFit::ParallelNLL"     , INVALID_CATEGORY ) ;
+      label = cat->getCurrentLabel () ;
+    }
+    //
+    std::map<std::string,unsigned int>::const_iterator found = index.find ( label ) ;
+    if ( index.end () == found )
+    {
+      // new partition
+      const RooAbsPdf* pdf = nullptr == sim ? m_pdf : sim->getPdf ( label.c_str () ) ;
+      Ostap::Assert ( nullptr != pdf                       ,
+                      "No PDF for category " + label       ,
+                      "Ostap::MoreRooFit::ParallelNLL"     , INVALID_CATEGORY ) ;
+      //
+      Partition partition ;
+      partition.pdf = pdf->GetName () ;
+      std::vector<const RooAbsReal*> vars ;
+      std::unique_ptr<RooArgSet> observables { pdf->getObservables ( *row ) } ;
+      for ( const RooAbsArg* a : *observables )
+      {
+        const RooAbsReal* v = dynamic_cast<const RooAbsReal*> ( row->find ( a->GetName () ) ) ;
+        if ( nullptr == v ) { continue ; }
+        partition.observables.push_back ( a->GetName () ) ;
+        vars.push_back ( v ) ;
+      }
+      //
+      found = index.emplace ( label , m_partitions.size () ).first ;
+      m_partitions.push_back ( partition ) ;
+      rowvars     .push_back ( vars      ) ;
+    }
+    //
+    Partition& partition = m_partitions [ found->second ] ;
+    for ( const RooAbsReal* v : rowvars [ found->second ] )
+    { partition.values.push_back ( v->getVal () ) ; }
+    partition.weights.push_back ( w ) ;
+    partition.sumw += w ;
+    ++partition.entries ;
+  }
+  //
+  tasks_ ( chunk_size ) ;
+}
+// ============================================================================
+// split the compact data into partitions and tasks
+// ============================================================================
+void Ostap::MoreRooFit::ParallelNLL::split_
+( const Ostap::Utils::CompactData& data       ,
+  const unsigned long              chunk_size )
+{
+  const RooSimultaneous* sim = dynamic_cast<const RooSimultaneous*> ( m_pdf ) ;
+  //
+  // the columns of the observables for the given PDF
+  auto columns = [&data] ( const RooAbsPdf* pdf , Partition& partition )
+    {
+      std::unique_ptr<RooArgSet> variables { pdf->getVariables () } ;
+      for ( std::size_t c = 0 ; c < data.nColumns () ; ++c )
+      {
+        if ( nullptr == variables->find ( data.name ( c ).c_str () ) ) { continue ; }
+        partition.observables.push_back ( data.name ( c ) ) ;
+        partition.columns    .push_back ( c ) ;
+      }
+    } ;
+  //
+  if ( nullptr == sim )
+  {
+    Partition partition ;
+    partition.pdf     = m_pdf->GetName () ;
+    partition.entries = data.size () ;
+    partition.sumw    = data.sumw () ;
+    columns ( m_pdf , partition ) ;
+    m_partitions.push_back ( partition ) ;
+    tasks_ ( chunk_size ) ;
+    return ;                                                       // RETURN
+  }
+  //
+  const std::string catname = sim->indexCat ().GetName () ;
+  const std::size_t icat    = data.category ( catname ) ;
+  Ostap::Assert ( icat < data.nCategories ()              ,
+                  "No category " + catname + " in data"   ,
+                  "Ostap::MoreRooFit::ParallelNLL"        , INVALID_CATEGORY ) ;
+  //
+  const std::vector<std::string>& labels = data.labels ( icat ) ;
+  std::vector<int> index ( labels.size () , -1 ) ;
+  std::vector<long double> sumw ;
+  for ( std::size_t i = 0 ; i < data.size () ; ++i )
+  {
+    const unsigned int state = data.state ( icat , i ) ;
+    if ( index [ state ] < 0 )
+    {
+      const RooAbsPdf* pdf = sim->getPdf ( labels [ state ].c_str () ) ;
+      Ostap::Assert ( nullptr != pdf                               ,
+                      "No PDF for category " + labels [ state ]    ,
+                      "Ostap::MoreRooFit::ParallelNLL"             , INVALID_CATEGORY ) ;
+      Partition partition ;
+      partition.pdf = pdf->GetName () ;
+      columns ( pdf , partition ) ;
+      index [ state ] = m_partitions.size () ;
+      m_partitions.push_back ( partition ) ;
+      sumw        .push_back ( 0 ) ;
+    }
+    Partition& partition = m_partitions [ index [ state ] ] ;
+    partition.rows.push_back ( i ) ;
+    ++partition.entries ;
+    sumw [ index [ state ] ] += data.weight ( i ) ;
+  }
+  for ( std::size_t p = 0 ; p < m_partitions.size () ; ++p ) { m_partitions [ p ].sumw = sumw [ p ] ; }
+  //
+  tasks_ ( chunk_size ) ;
+}
+// ============================================================================
+// split the partitions into tasks
+// ============================================================================
+void Ostap::MoreRooFit::ParallelNLL::tasks_
+( const unsigned long chunk_size )
+{
+  const unsigned long chunk = std::max ( chunk_size , 1ul ) ;
+  for ( unsigned int p = 0 ; p < m_partitions.size () ; ++p )
+  {
+    const unsigned long n = m_partitions [ p ].size () ;
+    for ( unsigned long first = 0 ; first < n ; first += chunk )
+    {
+      Task task ;
+      task.partition = p ;
+      task.first     = first ;
+      task.last      = std::min ( first + chunk , n ) ;
+      m_tasks.push_back ( task ) ;
+    }
+  }
+}
+// ============================================================================
+// create the per-thread replicas of PDF
+// ============================================================================
+void Ostap::MoreRooFit::ParallelNLL::replicate_ () const
+{
+  Ostap::Assert ( nullptr != m_pdf                 ,
+                  "Invalid PDF"                    ,
+                  "Ostap::MoreRooFit::ParallelNLL" , INVALID_PDF ) ;
+  //
+  const unsigned int nt = std::min ( std::size_t ( m_nthreads ) , std::max ( m_tasks.size () , std::size_t ( 1 ) ) ) ;
+  if ( 1 < nt ) { Ostap::Utils::thread_safety () ; }
+  //
+  m_replicas.reset ( new Replicas ( *m_pdf , m_parameters , m_partitions , m_extended , nt , m_compact ) ) ;
+}
+// ============================================================================
+// the actual evaluation of the result
+// ============================================================================
+Double_t Ostap::MoreRooFit::ParallelNLL::evaluate () const
+{
+  if ( !m_replicas ) { replicate_ () ; }
+  //
+  const std::vector<Replica>& replicas = m_replicas->replicas () ;
+  const std::size_t           ntasks   = m_tasks.size () ;
+  m_results.assign ( ntasks , 0.0 ) ;
+  //
+  std::atomic<std::size_t> next { 0 } ;
+  const Ostap::Utils::WorkerPool::Job job = [&] ( const unsigned int ithread )
+    {
+      const Replica& replica = replicas [ ithread ] ;
+      replica.sync () ;
+      for ( std::size_t k = next++ ; k < ntasks ; k = next++ )
+      {
+        const Task& task = m_tasks [ k ] ;
+        m_results [ k ] = replica.evaluate ( m_partitions [ task.partition ] , task , m_extended , m_compact ) ;
+      }
+    } ;
+  //
+  if ( 1 == replicas.size () ) { job ( 0 ) ; }
+  else                         { m_replicas->pool ().run ( job ) ; }
+  //
+  // the fixed order of summation: the result does not depend on the number of threads
+  return Ostap::Math::sum_kahan ( m_results.begin () , m_results.end () ) ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
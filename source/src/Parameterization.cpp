@@ -1,6 +1,11 @@
 // ============================================================================
 // Include files
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+#include <vector>
+// ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/Polynomials.h"
@@ -61,6 +66,46 @@ namespace
     }
   }
   // ==========================================================================
+  /// the block size for the array evaluation 
+  const std::size_t s_BLOCK = 16 ;
+  // ==========================================================================
+  /** precompute values of Legendre polynomials \f$ P_k(t_j) \f$ 
+   *  for the block of points: <code>out [ k * s_BLOCK + j ]</code>  
+   */
+  inline void _legendre_block 
+  ( const unsigned short N   , 
+    const double*        t   , 
+    double*              out ) 
+  {
+    std::fill ( out , out + s_BLOCK , 1.0 ) ;
+    if ( 0 == N ) { return ; }
+    std::copy ( t   , t   + s_BLOCK , out + s_BLOCK ) ;
+    for ( unsigned short k = 2 ; k <= N ; ++k ) 
+    {
+      const double  a  = ( 2.0 * k - 1 ) / k ;
+      const double  b  = ( k   - 1.0   ) / k ;
+      const double* p1 = out + ( k - 1 ) * s_BLOCK ;
+      const double* p0 = out + ( k - 2 ) * s_BLOCK ;
+      double*       pk = out +   k       * s_BLOCK ;
+      for ( std::size_t j = 0 ; j < s_BLOCK ; ++j ) 
+      { pk [ j ] = a * t [ j ] * p1 [ j ] - b * p0 [ j ] ; }
+    }
+  }
+  // ==========================================================================
+  /// "axpy" for the block of points: r += a * p 
+  inline void _axpy_block 
+  ( const double  a , 
+    const double* p , 
+    double*       r ) 
+  { for ( std::size_t j = 0 ; j < s_BLOCK ; ++j ) { r [ j ] += a * p [ j ] ; } }
+  // ==========================================================================
+  /// product for the block of points: r += q * p 
+  inline void _mul_block 
+  ( const double* q , 
+    const double* p , 
+    double*       r ) 
+  { for ( std::size_t j = 0 ; j < s_BLOCK ; ++j ) { r [ j ] += q [ j ] * p [ j ] ; } }
+  // ==========================================================================
 }
 // ============================================================================
 // Negation operators 
@@ -155,6 +200,48 @@ double Ostap::Math::LegendreSum2::evaluate
   return calculate () ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::LegendreSum2::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  const double*     y      , 
+  double*           result ) const 
+{
+  std::vector<double> px ( ( m_NX + 1 ) * s_BLOCK ) ;
+  std::vector<double> py ( ( m_NY + 1 ) * s_BLOCK ) ;
+  //
+  for ( std::size_t i0 = 0 ; i0 < n ; i0 += s_BLOCK )
+  {
+    const std::size_t m = std::min ( s_BLOCK , n - i0 ) ;
+    //
+    // 1) per-axis basis values 
+    double tt [ s_BLOCK ] = {} ;
+    for ( std::size_t j = 0 ; j < m ; ++j ) { tt [ j ] = tx ( x [ i0 + j ] ) ; }
+    _legendre_block ( m_NX , tt , px.data () ) ;
+    for ( std::size_t j = 0 ; j < m ; ++j ) { tt [ j ] = ty ( y [ i0 + j ] ) ; }
+    _legendre_block ( m_NY , tt , py.data () ) ;
+    //
+    // 2) tensor-product sum, the coefficients are streamed once 
+    double rr [ s_BLOCK ] = {} ;
+    for ( unsigned short ix = 0 ; ix <= m_NX ; ++ix ) 
+    {
+      double ry [ s_BLOCK ] = {} ;
+      for ( unsigned short iy = 0 ; iy <= m_NY ; ++iy ) 
+      { _axpy_block ( m_pars [ index ( ix , iy ) ] , py.data () + iy * s_BLOCK , ry ) ; }
+      _mul_block ( ry , px.data () + ix * s_BLOCK , rr ) ;
+    }
+    //
+    for ( std::size_t j = 0 ; j < m ; ++j ) 
+    {
+      const std::size_t i = i0 + j ;
+      result [ i ] = 
+        x [ i ] < m_xmin || x [ i ] > m_xmax ? 0 : 
+        y [ i ] < m_ymin || y [ i ] > m_ymax ? 0 : rr [ j ] ;
+    }
+  }
+}
+// ============================================================================
 /*  update  the Legendre expansion by addition of one "event" with 
  *  the given weight
  *  @code
@@ -513,6 +600,58 @@ double Ostap::Math::LegendreSum3::evaluate
   return calculate () ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::LegendreSum3::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  const double*     y      , 
+  const double*     z      , 
+  double*           result ) const 
+{
+  std::vector<double> px ( ( m_NX + 1 ) * s_BLOCK ) ;
+  std::vector<double> py ( ( m_NY + 1 ) * s_BLOCK ) ;
+  std::vector<double> pz ( ( m_NZ + 1 ) * s_BLOCK ) ;
+  //
+  for ( std::size_t i0 = 0 ; i0 < n ; i0 += s_BLOCK )
+  {
+    const std::size_t m = std::min ( s_BLOCK , n - i0 ) ;
+    //
+    // 1) per-axis basis values 
+    double tt [ s_BLOCK ] = {} ;
+    for ( std::size_t j = 0 ; j < m ; ++j ) { tt [ j ] = tx ( x [ i0 + j ] ) ; }
+    _legendre_block ( m_NX , tt , px.data () ) ;
+    for ( std::size_t j = 0 ; j < m ; ++j ) { tt [ j ] = ty ( y [ i0 + j ] ) ; }
+    _legendre_block ( m_NY , tt , py.data () ) ;
+    for ( std::size_t j = 0 ; j < m ; ++j ) { tt [ j ] = tz ( z [ i0 + j ] ) ; }
+    _legendre_block ( m_NZ , tt , pz.data () ) ;
+    //
+    // 2) tensor-product sum, the coefficients are streamed once 
+    double rr [ s_BLOCK ] = {} ;
+    for ( unsigned short ix = 0 ; ix <= m_NX ; ++ix ) 
+    {
+      double ry [ s_BLOCK ] = {} ;
+      for ( unsigned short iy = 0 ; iy <= m_NY ; ++iy ) 
+      {
+        double rz [ s_BLOCK ] = {} ;
+        for ( unsigned short iz = 0 ; iz <= m_NZ ; ++iz ) 
+        { _axpy_block ( m_pars [ index ( ix , iy , iz ) ] , pz.data () + iz * s_BLOCK , rz ) ; }
+        _mul_block ( rz , py.data () + iy * s_BLOCK , ry ) ;
+      }
+      _mul_block ( ry , px.data () + ix * s_BLOCK , rr ) ;
+    }
+    //
+    for ( std::size_t j = 0 ; j < m ; ++j ) 
+    {
+      const std::size_t i = i0 + j ;
+      result [ i ] = 
+        x [ i ] < m_xmin || x [ i ] > m_xmax ? 0 : 
+        y [ i ] < m_ymin || y [ i ] > m_ymax ? 0 : 
+        z [ i ] < m_zmin || z [ i ] > m_zmax ? 0 : rr [ j ] ;
+    }
+  }
+}
+// ============================================================================
 /*  update  the Legendre expansion by addition of one "event" with 
  *  the given weight
  *  @code
@@ -857,6 +996,68 @@ double Ostap::Math::LegendreSum4::evaluate
   //
   return calculate () ;
 }
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::LegendreSum4::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  const double*     y      , 
+  const double*     z      , 
+  const double*     u      , 
+  double*           result ) const 
+{
+  std::vector<double> px ( ( m_NX + 1 ) * s_BLOCK ) ;
+  std::vector<double> py ( ( m_NY + 1 ) * s_BLOCK ) ;
+  std::vector<double> pz ( ( m_NZ + 1 ) * s_BLOCK ) ;
+  std::vector<double> pu ( ( m_NU + 1 ) * s_BLOCK ) ;
+  //
+  for ( std::size_t i0 = 0 ; i0 < n ; i0 += s_BLOCK )
+  {
+    const std::size_t m = std::min ( s_BLOCK , n - i0 ) ;
+    //
+    // 1) per-axis basis values 
+    double tt [ s_BLOCK ] = {} ;
+    for ( std::size_t j = 0 ; j < m ; ++j ) { tt [ j ] = tx ( x [ i0 + j ] ) ; }
+    _legendre_block ( m_NX , tt , px.data () ) ;
+    for ( std::size_t j = 0 ; j < m ; ++j ) { tt [ j ] = ty ( y [ i0 + j ] ) ; }
+    _legendre_block ( m_NY , tt , py.data () ) ;
+    for ( std::size_t j = 0 ; j < m ; ++j ) { tt [ j ] = tz ( z [ i0 + j ] ) ; }
+    _legendre_block ( m_NZ , tt , pz.data () ) ;
+    for ( std::size_t j = 0 ; j < m ; ++j ) { tt [ j ] = tu ( u [ i0 + j ] ) ; }
+    _legendre_block ( m_NU , tt , pu.data () ) ;
+    //
+    // 2) tensor-product sum, the coefficients are streamed once 
+    double rr [ s_BLOCK ] = {} ;
+    for ( unsigned short ix = 0 ; ix <= m_NX ; ++ix ) 
+    {
+      double ry [ s_BLOCK ] = {} ;
+      for ( unsigned short iy = 0 ; iy <= m_NY ; ++iy ) 
+      {
+        double rz [ s_BLOCK ] = {} ;
+        for ( unsigned short iz = 0 ; iz <= m_NZ ; ++iz ) 
+        {
+          double ru [ s_BLOCK ] = {} ;
+          for ( unsigned short iu = 0 ; iu <= m_NU ; ++iu ) 
+          { _axpy_block ( m_pars [ index ( ix , iy , iz , iu ) ] , pu.data () + iu * s_BLOCK , ru ) ; }
+          _mul_block ( ru , pz.data () + iz * s_BLOCK , rz ) ;
+        }
+        _mul_block ( rz , py.data () + iy * s_BLOCK , ry ) ;
+      }
+      _mul_block ( ry , px.data () + ix * s_BLOCK , rr ) ;
+    }
+    //
+    for ( std::size_t j = 0 ; j < m ; ++j ) 
+    {
+      const std::size_t i = i0 + j ;
+      result [ i ] = 
+        x [ i ] < m_xmin || x [ i ] > m_xmax ? 0 : 
+        y [ i ] < m_ymin || y [ i ] > m_ymax ? 0 : 
+        z [ i ] < m_zmin || z [ i ] > m_zmax ? 0 : 
+        u [ i ] < m_umin || u [ i ] > m_umax ? 0 : rr [ j ] ;
+    }
+  }
+}
 // ===========================================================================
 /** update  the Legendre expansion by addition of one "event" with 
  *  the given weight
@@ -1,6 +1,12 @@
 // ============================================================================
 // Include files 
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+#include <memory>
+#include <algorithm>
+// ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/Params.h"
@@ -15,6 +21,7 @@
 // Local 
 // ============================================================================
 #include "Exception.h"
+#include "local_mt.h"
 // ============================================================================
 /** @file 
  *  Implementation file for header Ostap/Params.h
@@ -22,6 +29,277 @@
  *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
  */
 // ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /** @struct Axis 
+   *  the axis of Legendre parameterization 
+   */
+  struct Axis 
+  {
+    /// the degree 
+    unsigned short N    { 0 } ;
+    /// the low edge 
+    double         xmin { -1 } ;
+    /// the high edge 
+    double         xmax {  1 } ;
+  } ;
+  // ==========================================================================
+  typedef std::vector<Axis> Axes ;
+  // ==========================================================================
+  /** @struct Moments 
+   *  the accumulated Legendre moments for one chunk 
+   */
+  struct Moments 
+  {
+    /// the coefficients 
+    std::vector<long double> sum  {} ;
+    /// the covariance (upper triangle, packed row-by-row)
+    std::vector<long double> cov2 {} ;
+    /// sum of weights 
+    long double              sumw { 0 } ;
+  } ;
+  // ==========================================================================
+  /** @class MomentsWorker
+   *  helper class to process the chunk of entries for 
+   *  multithreaded Ostap::DataParam::parameterizeMT
+   *  - formulas are created for per-thread copy of the tree 
+   *  - results for the chunk are stored at the position, 
+   *    defined by the chunk index
+   */
+  class MomentsWorker 
+  {
+  public:
+    // ========================================================================
+    typedef std::unique_ptr<Ostap::Formula>   UOF        ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    MomentsWorker
+    ( TTree*                          tree        , 
+      const std::vector<std::string>& expressions , 
+      const std::string&              selection   , 
+      const Axes&                     axes        , 
+      const bool                      covariance  , 
+      std::vector<Moments>&           results     ) 
+      : m_tree       ( tree        ) 
+      , m_axes       ( axes        ) 
+      , m_covariance ( covariance  ) 
+      , m_results    ( &results    ) 
+    {
+      m_formulas.reserve ( expressions.size() ) ;
+      for ( const auto& e : expressions ) 
+      {
+        auto p = std::make_unique<Ostap::Formula> ( e , m_tree ) ;
+        Ostap::Assert ( p && p->ok()                      , 
+                        "Invalid expression:\"" + e + "\"" , 
+                        "Ostap::DataParam::parameterizeMT" ) ;
+        m_formulas.push_back ( std::move ( p ) ) ;
+      }
+      if ( !selection.empty() ) 
+      {
+        m_cuts = std::make_unique<Ostap::Formula> ( selection , m_tree ) ;
+        Ostap::Assert ( m_cuts->ok()                              , 
+                        "Invalid selection:\"" + selection + "\"" , 
+                        "Ostap::DataParam::parameterizeMT"        ) ;
+      }
+      m_notifier = std::make_unique<Ostap::Utils::Notifier> 
+        ( m_formulas.begin() , m_formulas.end() , m_cuts.get() , m_tree ) ;
+      //
+      m_npars = 1 ;
+      for ( const auto& a : m_axes ) { m_npars *= ( a.N + 1 ) ; }
+      m_basis.resize ( m_axes.size () ) ;
+      for ( std::size_t d = 0 ; d < m_axes.size () ; ++d ) 
+      { m_basis [ d ].resize ( m_axes [ d ].N + 1 ) ; }
+      m_f.resize ( m_npars ) ;
+      m_g.resize ( m_npars ) ;
+    }
+    // ========================================================================
+    /// process the chunk 
+    void operator() ( const Ostap::Utils::Chunk& chunk , 
+                      const std::size_t          index ) 
+    {
+      Moments& result = ( *m_results ) [ index ] ;
+      result.sum.assign ( m_npars , 0.0L ) ;
+      if ( m_covariance ) { result.cov2.assign ( m_npars * ( m_npars + 1 ) / 2 , 0.0L ) ; }
+      //
+      const std::size_t D = m_axes.size () ;
+      for ( unsigned long entry = chunk.first ; entry < chunk.last ; ++entry )
+      {
+        //
+        long ievent = m_tree->GetEntryNumber ( entry ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        ievent      = m_tree->LoadTree ( ievent ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        const double w = m_cuts ? m_cuts->evaluate() : 1.0 ;
+        if ( !w ) { continue  ; }
+        //
+        // the scaled Legendre basis for each axis 
+        bool inside = true ;
+        for ( std::size_t d = 0 ; d < D && inside ; ++d ) 
+        {
+          const Axis&  a = m_axes [ d ] ;
+          const double x = m_formulas [ d ]->evaluate () ;
+          if ( x < a.xmin || x > a.xmax ) { inside = false ; break ; }
+          //
+          const long double t = ( 2 * x - a.xmin - a.xmax ) / ( a.xmax - a.xmin ) ;
+          std::vector<long double>& b = m_basis [ d ] ;
+          Ostap::Math::legendre_values ( b.begin () , b.end () , t ) ;
+          const long double scale = 2.0L / ( a.xmax - a.xmin ) ;
+          for ( unsigned short i = 0 ; i <= a.N ; ++i ) { b [ i ] *= scale * ( i + 0.5L ) ; }
+        }
+        if ( !inside ) { continue ; }
+        //
+        // the outer product of the per-axis basis values 
+        std::size_t n = 1 ;
+        m_f [ 0 ] = 1 ;
+        for ( std::size_t d = 0 ; d < D ; ++d ) 
+        {
+          const std::vector<long double>& b  = m_basis [ d ] ;
+          const std::size_t               nb = b.size () ;
+          for ( std::size_t i = 0 ; i < n ; ++i ) 
+          { for ( std::size_t j = 0 ; j < nb ; ++j ) { m_g [ i * nb + j ] = m_f [ i ] * b [ j ] ; } }
+          n *= nb ;
+          std::swap ( m_f , m_g ) ;
+        }
+        //
+        for ( std::size_t k = 0 ; k < m_npars ; ++k ) { result.sum [ k ] += w * m_f [ k ] ; }
+        result.sumw += w ;
+        //
+        if ( !m_covariance ) { continue ; }
+        const long double w2 = 1.0L * w * w ;
+        std::size_t       ip = 0 ;
+        for ( std::size_t a = 0 ; a < m_npars ; ++a ) 
+        {
+          const long double wa = w2 * m_f [ a ] ;
+          for ( std::size_t b = a ; b < m_npars ; ++b , ++ip ) { result.cov2 [ ip ] += wa * m_f [ b ] ; }
+        }
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the tree 
+    TTree*                                  m_tree       { nullptr } ; // the tree 
+    /// axes 
+    Axes                                    m_axes       {} ;
+    /// calculate the covariance? 
+    bool                                    m_covariance { false   } ;
+    /// results (per chunk) 
+    std::vector<Moments>*                   m_results    { nullptr } ; // results 
+    /// number of coefficients 
+    std::size_t                             m_npars      { 1 } ;
+    /// formulas 
+    std::vector<UOF>                        m_formulas   {} ; // formulas 
+    /// selection 
+    UOF                                     m_cuts       {} ; // selection 
+    /// the per-axis basis values 
+    std::vector<std::vector<long double> >  m_basis      {} ;
+    /// helper vectors for the outer product 
+    std::vector<long double>                m_f          {} ;
+    std::vector<long double>                m_g          {} ;
+    /// notifier (must be destroyed before formulas!)
+    std::unique_ptr<Ostap::Utils::Notifier> m_notifier   {} ; // notifier 
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** accumulate Legendre moments from the tree in one (multithreaded) pass 
+   *  @param tree        (INPUT)  the tree 
+   *  @param expressions (INPUT)  the expressions, one per axis 
+   *  @param selection   (INPUT)  the selection/weight 
+   *  @param axes        (INPUT)  the axes 
+   *  @param nthreads    (INPUT)  number of threads 
+   *  @param first       (INPUT)  the first entry 
+   *  @param last        (INPUT)  the last entry 
+   *  @param coeffs      (OUTPUT) the coefficients 
+   *  @param cov2        (OUTPUT) the covariance matrix (optional)
+   *  @return sum of weights 
+   */
+  double _moments_
+  ( TTree*                          tree        , 
+    const std::vector<std::string>& expressions , 
+    const std::string&              selection   , 
+    const Axes&                     axes        , 
+    const unsigned int              nthreads    , 
+    const unsigned long             first       , 
+    const unsigned long             last        , 
+    std::vector<double>&            coeffs      , 
+    std::vector<double>*            cov2        ) 
+  {
+    std::size_t np = 1 ;
+    for ( const auto& a : axes ) { np *= ( a.N + 1 ) ; }
+    coeffs.assign ( np , 0.0 ) ;
+    if ( cov2 ) { cov2->assign ( np * np , 0.0 ) ; }
+    //
+    // invalid tree or empty range 
+    if ( nullptr == tree || last <= first ) { return 0 ; }
+    const unsigned long nEntries = std::min ( last , (unsigned long) tree->GetEntries() ) ;
+    if ( nEntries <= first ) { return 0 ; }
+    //
+    std::vector<Moments> partial {} ;
+    const unsigned int nt = 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ;
+    if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) ) 
+    {
+      partial.resize ( 1 ) ;
+      MomentsWorker worker ( tree , expressions , selection , axes , nullptr != cov2 , partial ) ;
+      worker ( Ostap::Utils::Chunk ( first , nEntries ) , 0 ) ;
+    }
+    else 
+    {
+      // validate the expressions and selection using the original tree 
+      for ( const auto& e : expressions ) 
+      { Ostap::Assert ( Ostap::Formula ( e , tree ).ok ()           , 
+                        "Invalid expression:\"" + e + "\""          ,
+                        "Ostap::DataParam::parameterizeMT"          ) ; }
+      Ostap::Assert ( selection.empty () || Ostap::Formula ( selection , tree ).ok () , 
+                      "Invalid selection:\"" + selection + "\""    ,
+                      "Ostap::DataParam::parameterizeMT"           ) ;
+      //
+      const Ostap::Utils::Chunks chunks = Ostap::Utils::clusters ( tree , first , nEntries , 4 * nt ) ;
+      partial.resize ( chunks.size () ) ;
+      const bool covariance = nullptr != cov2 ;
+      Ostap::Utils::process_chunks 
+        ( tree , chunks , nt , 
+          [&expressions,&selection,&axes,covariance,&partial] ( TTree* t ) 
+          { return MomentsWorker ( t , expressions , selection , axes , covariance , partial ) ; } ) ;
+    }
+    //
+    // merge partial results in the order of chunks 
+    std::vector<long double> sum  ( np , 0.0L ) ;
+    std::vector<long double> cov  ( cov2 ? np * ( np + 1 ) / 2 : 0 , 0.0L ) ;
+    long double              sumw = 0 ;
+    for ( const Moments& m : partial ) 
+    {
+      if ( m.sum.empty () ) { continue ; }
+      for ( std::size_t k = 0 ; k < np ; ++k ) { sum [ k ] += m.sum [ k ] ; }
+      for ( std::size_t k = 0 ; k < cov.size () && k < m.cov2.size () ; ++k ) { cov [ k ] += m.cov2 [ k ] ; }
+      sumw += m.sumw ;
+    }
+    //
+    std::copy ( sum.begin () , sum.end () , coeffs.begin () ) ;
+    if ( cov2 ) 
+    {
+      std::size_t ip = 0 ;
+      for ( std::size_t a = 0 ; a < np ; ++a ) 
+      { for ( std::size_t b = a ; b < np ; ++b , ++ip ) 
+        { (*cov2) [ a * np + b ] = (*cov2) [ b * np + a ] = cov [ ip ] ; } }
+    }
+    //
+    return sumw ;
+  }
+  // ==========================================================================
+  /// update the coefficients of the Legendre sum 
+  template <class SUM>
+  inline void _update_ ( SUM& sum , const std::vector<double>& coeffs ) 
+  {
+    for ( std::size_t k = 0 ; k < coeffs.size () ; ++k ) 
+    { if ( coeffs [ k ] ) { sum.setPar ( k , sum.par ( k ) + coeffs [ k ] ) ; } }
+  }
+  // ==========================================================================
+}
+// ============================================================================
 /*  fill Legendre sum with data from the Tree 
  *  @see Ostap::Math::LegendreSum 
  *  @see Ostap::Math::LegendreSum::fill
@@ -610,9 +888,127 @@ double Ostap::DataParam::parameterize
   return sumw ;
 }
 
-
-
-
+// ============================================================================
+/*  fill Legendre sum with data from the Tree in one multithreaded pass 
+ *  @see Ostap::Math::LegendreSum 
+ *  @see Ostap::Math::LegendreSum::fill
+ *  @param tree       (INPUT)  the input tree 
+ *  @param sum        (UPDATE) the parameterization object 
+ *  @param expression (INPUT)  expression to be parameterized
+ *  @param selection  (INPUT)  selection/weight to be used 
+ *  @param nthreads   (INPUT)  number of threads (1: sequential processing)
+ *  @param cov2       (UPDATE) the covariance matrix of coefficients (row-major)
+ *  @param first      (INPUT)  the first event in Tree 
+ *  @param last       (INPUT)  the last  event in Tree 
+ *  @return  sum of weigths  used in parameterization
+ *  @date   2026-10-15
+ */ 
+// ============================================================================
+double Ostap::DataParam::parameterizeMT
+( TTree*                    tree       , 
+  Ostap::Math::LegendreSum& sum        , 
+  const std::string&        expression , 
+  const std::string&        selection  , 
+  const unsigned int        nthreads   , 
+  std::vector<double>*      cov2       , 
+  const unsigned long       first      ,
+  const unsigned long       last       ) 
+{
+  std::vector<double> coeffs ;
+  const double sumw = _moments_ 
+    ( tree , { expression } , selection , 
+      { Axis { sum.degree () , sum.xmin () , sum.xmax () } } , 
+      nthreads , first , last , coeffs , cov2 ) ;
+  _update_ ( sum , coeffs ) ;
+  return sumw ;
+}
+// ============================================================================
+/*  fill 2D Legendre sum with data from the Tree in one multithreaded pass 
+ *  @see Ostap::DataParam::parameterizeMT 
+ *  @see Ostap::Math::LegendreSum2::fill
+ *  @date   2026-10-15
+ */ 
+// ============================================================================
+double Ostap::DataParam::parameterizeMT
+( TTree*                     tree        , 
+  Ostap::Math::LegendreSum2& sum         , 
+  const std::string&         xexpression , 
+  const std::string&         yexpression , 
+  const std::string&         selection   , 
+  const unsigned int         nthreads    , 
+  std::vector<double>*       cov2        , 
+  const unsigned long        first       ,
+  const unsigned long        last        ) 
+{
+  std::vector<double> coeffs ;
+  const double sumw = _moments_ 
+    ( tree , { xexpression , yexpression } , selection , 
+      { Axis { sum.nx () , sum.xmin () , sum.xmax () } , 
+        Axis { sum.ny () , sum.ymin () , sum.ymax () } } , 
+      nthreads , first , last , coeffs , cov2 ) ;
+  _update_ ( sum , coeffs ) ;
+  return sumw ;
+}
+// ============================================================================
+/*  fill 3D Legendre sum with data from the Tree in one multithreaded pass 
+ *  @see Ostap::DataParam::parameterizeMT 
+ *  @see Ostap::Math::LegendreSum3::fill
+ *  @date   2026-10-15
+ */ 
+// ============================================================================
+double Ostap::DataParam::parameterizeMT
+( TTree*                     tree        , 
+  Ostap::Math::LegendreSum3& sum         , 
+  const std::string&         xexpression , 
+  const std::string&         yexpression , 
+  const std::string&         zexpression , 
+  const std::string&         selection   , 
+  const unsigned int         nthreads    , 
+  std::vector<double>*       cov2        , 
+  const unsigned long        first       ,
+  const unsigned long        last        ) 
+{
+  std::vector<double> coeffs ;
+  const double sumw = _moments_ 
+    ( tree , { xexpression , yexpression , zexpression } , selection , 
+      { Axis { sum.nx () , sum.xmin () , sum.xmax () } , 
+        Axis { sum.ny () , sum.ymin () , sum.ymax () } , 
+        Axis { sum.nz () , sum.zmin () , sum.zmax () } } , 
+      nthreads , first , last , coeffs , cov2 ) ;
+  _update_ ( sum , coeffs ) ;
+  return sumw ;
+}
+// ============================================================================
+/*  fill 4D Legendre sum with data from the Tree in one multithreaded pass 
+ *  @see Ostap::DataParam::parameterizeMT 
+ *  @see Ostap::Math::LegendreSum4::fill
+ *  @date   2026-10-15
+ */ 
+// ============================================================================
+double Ostap::DataParam::parameterizeMT
+( TTree*                     tree        , 
+  Ostap::Math::LegendreSum4& sum         , 
+  const std::string&         xexpression , 
+  const std::string&         yexpression , 
+  const std::string&         zexpression , 
+  const std::string&         uexpression , 
+  const std::string&         selection   , 
+  const unsigned int         nthreads    , 
+  std::vector<double>*       cov2        , 
+  const unsigned long        first       ,
+  const unsigned long        last        ) 
+{
+  std::vector<double> coeffs ;
+  const double sumw = _moments_ 
+    ( tree , { xexpression , yexpression , zexpression , uexpression } , selection , 
+      { Axis { sum.nx () , sum.xmin () , sum.xmax () } , 
+        Axis { sum.ny () , sum.ymin () , sum.ymax () } , 
+        Axis { sum.nz () , sum.zmin () , sum.zmax () } , 
+        Axis { sum.nu () , sum.umin () , sum.umax () } } , 
+      nthreads , first , last , coeffs , cov2 ) ;
+  _update_ ( sum , coeffs ) ;
+  return sumw ;
+}
 // ============================================================================
 //                                                                      The END 
 // ============================================================================
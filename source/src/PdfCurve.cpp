@@ -0,0 +1,192 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooAbsReal.h"
+#include "RooAbsRealLValue.h"
+#include "RooArgSet.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/PdfCurve.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Utils::PdfCurve
+ *  @see Ostap::Utils::PdfCurve
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_XVAR       = 890 ,
+    INVALID_INTEGRAL   = 891 ,
+    INVALID_COMPONENTS = 892 ,
+  } ;
+  // ==========================================================================
+  /** @class Select
+   *  Select the components of the PDF (in the same way as
+   *  <code>RooAbsReal::plotOnCompSelect</code>) and restore
+   *  the default "all components are selected" state at the end
+   */
+  class Select
+  {
+  public:
+    // ========================================================================
+    Select ( const RooAbsReal& pdf , const std::string& components )
+    {
+      if ( components.empty () ) { return ; }
+      //
+      pdf.branchNodeServerList ( &m_branches ) ;
+      std::unique_ptr<RooAbsCollection> direct
+        { m_branches.selectByName ( components.c_str () ) } ;
+      Ostap::Assert ( direct && !direct->empty ()      ,
+                      "No components are selected: " + components ,
+                      "Ostap::Utils::PdfCurve"         ,
+                      INVALID_COMPONENTS               ) ;
+      //
+      RooArgSet selected ;
+      // the selected components and all their branch nodes
+      for ( const RooAbsArg* a : *direct ) { a->branchNodeServerList ( &selected ) ; }
+      // all nodes that depend on the selected components
+      for ( RooAbsArg* a : m_branches )
+      { if ( a->dependsOn ( *direct , nullptr , true ) ) { selected.add ( *a , true ) ; } }
+      //
+      for ( RooAbsArg* a : m_branches )
+      {
+        RooAbsReal* r = dynamic_cast<RooAbsReal*> ( a ) ;
+        if ( !r ) { continue ; }
+        r->selectComp    ( selected.contains ( *a ) ) ;
+        r->setValueDirty () ;
+      }
+    }
+    // ========================================================================
+    ~Select ()
+    {
+      for ( RooAbsArg* a : m_branches )
+      {
+        RooAbsReal* r = dynamic_cast<RooAbsReal*> ( a ) ;
+        if ( !r ) { continue ; }
+        r->selectComp    ( true ) ;
+        r->setValueDirty () ;
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    RooArgSet m_branches {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+}
+// ============================================================================
+// constructor
+// ============================================================================
+Ostap::Utils::PdfCurve::PdfCurve
+( const RooAbsReal&  pdf       ,
+  RooAbsRealLValue&  xvar      ,
+  const RooArgSet&   projected )
+  : m_pdf  ( &pdf  )
+  , m_xvar ( &xvar )
+{
+  Ostap::Assert ( !projected.contains ( xvar )          ,
+                  "Drawing variable can't be projected" ,
+                  "Ostap::Utils::PdfCurve"              ,
+                  INVALID_XVAR                          ) ;
+  //
+  m_projected.add ( projected ) ;
+  m_normset  .add ( xvar      ) ;
+  m_normset  .add ( projected ) ;
+  //
+  if ( !m_projected.empty () )
+  {
+    m_integral.reset ( pdf.createIntegral ( m_projected , m_normset ) ) ;
+    Ostap::Assert ( nullptr != m_integral                  ,
+                    "Can't create the projection integral" ,
+                    "Ostap::Utils::PdfCurve"               ,
+                    INVALID_INTEGRAL                       ) ;
+  }
+}
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::Utils::PdfCurve::~PdfCurve () {}
+// ============================================================================
+// the uniform grid of points of the drawing variable (edges included)
+// ============================================================================
+std::vector<double>
+Ostap::Utils::PdfCurve::grid ( const unsigned int n ) const
+{
+  const unsigned int N    = std::max ( 2u , n ) ;
+  const double       xmin = m_xvar->getMin () ;
+  const double       xmax = m_xvar->getMax () ;
+  std::vector<double> result ( N ) ;
+  for ( unsigned int i = 0 ; i < N ; ++i )
+  { result [ i ] = xmin + ( xmax - xmin ) * i / ( N - 1 ) ; }
+  result.back () = xmax ;
+  return result ;
+}
+// ============================================================================
+// evaluate the curve for the current selection of components
+// ============================================================================
+void Ostap::Utils::PdfCurve::eval
+( const std::vector<double>& x      ,
+  std::vector<double>&       result ) const
+{
+  result.resize ( x.size () ) ;
+  const double x0 = m_xvar->getVal () ;
+  for ( std::size_t i = 0 ; i < x.size () ; ++i )
+  {
+    m_xvar->setVal ( x [ i ] ) ;
+    result [ i ] = m_integral ?
+      m_integral -> getVal () :
+      m_pdf      -> getVal ( m_normset ) ;
+  }
+  m_xvar->setVal ( x0 ) ;
+}
+// ============================================================================
+// evaluate the curve on the grid
+// ============================================================================
+std::vector<double>
+Ostap::Utils::PdfCurve::values
+( const std::vector<double>& x          ,
+  const std::string&         components ) const
+{
+  std::vector<double> result ;
+  Select select ( *m_pdf , components ) ;
+  eval ( x , result ) ;
+  return result ;
+}
+// ============================================================================
+// evaluate several curves on the same grid
+// ============================================================================
+std::vector<std::vector<double> >
+Ostap::Utils::PdfCurve::curves
+( const std::vector<double>&      x          ,
+  const std::vector<std::string>& components ) const
+{
+  std::vector<std::vector<double> > result ( components.size () ) ;
+  for ( std::size_t i = 0 ; i < components.size () ; ++i )
+  {
+    Select select ( *m_pdf , components [ i ] ) ;
+    eval ( x , result [ i ] ) ;
+  }
+  return result ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,282 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <cmath>
+#include <algorithm>
+// ============================================================================
+// ROOT/RooFit
+// ============================================================================
+#include "RooAbsReal.h"
+#include "RooAbsRealLValue.h"
+#include "RooArgSet.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/PdfSummary.h"
+#include "Ostap/Solver1D.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_tables.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Math::PdfSummary
+ *  @see Ostap::Math::PdfSummary
+ *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  const char s_METHOD [] = "Ostap::Math::PdfSummary" ;
+  // ==========================================================================
+  /// RooFit PDF as the function of the observable
+  std::function<double(double)> roo_function
+  ( const RooAbsReal&       pdf  ,
+    RooAbsRealLValue&       xvar )
+  {
+    return [&pdf,&xvar] ( const double x ) -> double
+      {
+        const RooArgSet nset ( xvar ) ;
+        xvar.setVal ( x ) ;
+        return pdf.getVal ( &nset ) ;
+      } ;
+  }
+  // ==========================================================================
+  /// restore the value of RooFit variable at the scope exit
+  struct RestoreValue
+  {
+    RestoreValue ( RooAbsRealLValue& v ) : m_var ( v ) , m_value ( v.getVal () ) {}
+    ~RestoreValue () { m_var.setVal ( m_value ) ; }
+    RooAbsRealLValue& m_var   ;
+    double            m_value ;
+  } ;
+  // ==========================================================================
+  /// build the proxy for RooFit PDF
+  Ostap::Math::ChebyshevProxy roo_proxy
+  ( const RooAbsReal&       pdf       ,
+    RooAbsRealLValue&       xvar      ,
+    const double            a         ,
+    const double            b         ,
+    const double            precision ,
+    const unsigned short    N         ,
+    const unsigned short    maxdepth  )
+  {
+    const RestoreValue restore ( xvar ) ;
+    return Ostap::Math::ChebyshevProxy ( roo_function ( pdf , xvar ) ,
+                                         a , b , precision , N , maxdepth ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor from the proxy
+// ============================================================================
+Ostap::Math::PdfSummary::PdfSummary
+( const Ostap::Math::ChebyshevProxy& proxy ,
+  const unsigned short               nodes )
+  : m_proxy ( proxy )
+{
+  init ( nodes ) ;
+}
+// ============================================================================
+// constructor from the function and the interval
+// ============================================================================
+Ostap::Math::PdfSummary::PdfSummary
+( std::function<double(double)> pdf       ,
+  const double                  a         ,
+  const double                  b         ,
+  const double                  precision ,
+  const unsigned short          N         ,
+  const unsigned short          maxdepth  )
+  : m_proxy ( pdf , a , b , precision , N , maxdepth )
+{
+  init ( 0 ) ;
+}
+// ============================================================================
+// constructor from RooFit PDF and the observable
+// ============================================================================
+Ostap::Math::PdfSummary::PdfSummary
+( const RooAbsReal&             pdf       ,
+  RooAbsRealLValue&             xvar      ,
+  const double                  a         ,
+  const double                  b         ,
+  const double                  precision ,
+  const unsigned short          N         ,
+  const unsigned short          maxdepth  )
+  : m_proxy ( roo_proxy ( pdf , xvar , a , b , precision , N , maxdepth ) )
+{
+  init ( 0 ) ;
+}
+// ============================================================================
+// initialize nodes, weights and the mean value
+// ============================================================================
+void Ostap::Math::PdfSummary::init ( const unsigned short nodes )
+{
+  m_norm = m_proxy.integral () ;
+  Ostap::Assert ( 0 < m_norm && std::isfinite ( m_norm ) ,
+                  "Non-positive normalization" , s_METHOD ) ;
+  //
+  // the pieces are polynomials of degree N-1: the rule with n nodes
+  // is exact for the moments up to order 2n-N
+  const unsigned int n = 0 < nodes ? nodes : ( m_proxy.N () + 17 ) / 2 + 1 ;
+  const Ostap::Math::Tables::GaussLegendre& gl = Ostap::Math::Tables::gauss_legendre ( n ) ;
+  const std::vector<double>& gx = gl.x ;
+  const std::vector<double>& gw = gl.w ;
+  //
+  const std::vector<double>& knots = m_proxy.knots () ;
+  const std::size_t np = m_proxy.pieces () ;
+  m_x.resize ( np * n ) ;
+  m_w.resize ( np * n ) ;
+  for ( std::size_t p = 0 ; p < np ; ++p )
+  {
+    const double h = 0.5 * ( knots [ p + 1 ] - knots [ p ] ) ;
+    const double m = 0.5 * ( knots [ p + 1 ] + knots [ p ] ) ;
+    for ( unsigned int j = 0 ; j < n ; ++j )
+    {
+      const double x = m + h * gx [ j ] ;
+      m_x [ p * n + j ] = x ;
+      m_w [ p * n + j ] = h * gw [ j ] * m_proxy ( x ) / m_norm ;
+    }
+  }
+  //
+  m_mean = moment ( 1 , 0.0 ) ;
+}
+// ============================================================================
+// normalized density (proxy)
+// ============================================================================
+double Ostap::Math::PdfSummary::pdf ( const double x ) const
+{ return m_proxy ( x ) / m_norm ; }
+// ============================================================================
+// cumulative distribution function (proxy)
+// ============================================================================
+double Ostap::Math::PdfSummary::cdf ( const double x ) const
+{
+  if      ( x <= xmin () ) { return 0 ; }
+  else if ( x >= xmax () ) { return 1 ; }
+  return m_proxy.integral ( xmin () , x ) / m_norm ;
+}
+// ============================================================================
+// the moment
+// ============================================================================
+double Ostap::Math::PdfSummary::moment
+( const unsigned short k  ,
+  const double         x0 ) const
+{
+  if ( 0 == k ) { return 1 ; }
+  double result = 0 ;
+  const std::size_t N = m_x.size () ;
+  for ( std::size_t i = 0 ; i < N ; ++i )
+  { result += m_w [ i ] * std::pow ( m_x [ i ] - x0 , k ) ; }
+  return result ;
+}
+// ============================================================================
+// the RMS
+// ============================================================================
+double Ostap::Math::PdfSummary::rms () const
+{
+  const double v = variance () ;
+  return 0 < v ? std::sqrt ( v ) : 0.0 ;
+}
+// ============================================================================
+// the skewness
+// ============================================================================
+double Ostap::Math::PdfSummary::skewness () const
+{
+  const double v = variance () ;
+  return 0 < v ? central_moment ( 3 ) / std::pow ( v , 1.5 ) : 0.0 ;
+}
+// ============================================================================
+// the (excess) kurtosis
+// ============================================================================
+double Ostap::Math::PdfSummary::kurtosis () const
+{
+  const double v = variance () ;
+  return 0 < v ? central_moment ( 4 ) / ( v * v ) - 3.0 : 0.0 ;
+}
+// ============================================================================
+// the quantile
+// ============================================================================
+double Ostap::Math::PdfSummary::quantile ( const double p ) const
+{
+  Ostap::Assert ( 0 <= p && p <= 1 , "Invalid quantile level" , s_METHOD ) ;
+  if      ( 0 == p ) { return xmin () ; }
+  else if ( 1 == p ) { return xmax () ; }
+  const double scale = xmax () - xmin () ;
+  return Ostap::Math::Solver1D::root_
+    ( [this,p] ( const double x ) -> double { return cdf ( x ) - p ; } ,
+      xmin () , xmax () , 1.e-14 * scale , 1.e-14 , 200 ) ;
+}
+// ============================================================================
+// the mode
+// ============================================================================
+double Ostap::Math::PdfSummary::mode () const
+{
+  return Ostap::Math::Solver1D::mode_
+    ( [this] ( const double x ) -> double { return m_proxy ( x ) ; } ,
+      xmin () , xmax () , 128 ) ;
+}
+// ============================================================================
+// the points where the density is factor*f(mode)
+// ============================================================================
+std::pair<double,double>
+Ostap::Math::PdfSummary::width ( const double factor ) const
+{
+  return Ostap::Math::Solver1D::width_
+    ( [this] ( const double x ) -> double { return m_proxy ( x ) ; } ,
+      xmin () , xmax () , mode () , factor ) ;
+}
+// ============================================================================
+// the half-width of the symmetric interval with the given probability
+// ============================================================================
+double Ostap::Math::PdfSummary::cl_symm
+( const double prob ,
+  const double x0   ) const
+{
+  Ostap::Assert ( 0 < prob && prob < 1 , "Invalid probability" , s_METHOD ) ;
+  const double c    = ( xmin () <= x0 && x0 <= xmax () ) ? x0 : m_mean ;
+  const double smax = std::max ( xmax () - c , c - xmin () ) ;
+  return Ostap::Math::Solver1D::root_
+    ( [this,c,prob] ( const double s ) -> double
+      { return cdf ( c + s ) - cdf ( c - s ) - prob ; } ,
+      0.0 , smax , 1.e-14 * smax , 1.e-14 , 200 ) ;
+}
+// ============================================================================
+// the asymmetric interval with the given probability
+// ============================================================================
+std::pair<double,double>
+Ostap::Math::PdfSummary::cl_asymm ( const double prob ) const
+{
+  Ostap::Assert ( 0 < prob && prob < 1 , "Invalid probability" , s_METHOD ) ;
+  //
+  const double xm = mode () ;
+  const double fm = pdf ( xm ) ;
+  const double lo = xmin () ;
+  const double hi = xmax () ;
+  //
+  // the points where the density is equal to the level
+  auto points = [this,xm,lo,hi] ( const double level ) -> std::pair<double,double>
+    {
+      auto fun = [this,level] ( const double x ) -> double { return pdf ( x ) - level ; } ;
+      const double x1 = 0 <= fun ( lo ) ? lo :
+        Ostap::Math::Solver1D::root_ ( fun , lo , xm , 1.e-14 * ( hi - lo ) , 1.e-14 , 200 ) ;
+      const double x2 = 0 <= fun ( hi ) ? hi :
+        Ostap::Math::Solver1D::root_ ( fun , xm , hi , 1.e-14 * ( hi - lo ) , 1.e-14 , 200 ) ;
+      return std::make_pair ( x1 , x2 ) ;
+    } ;
+  //
+  const double level = Ostap::Math::Solver1D::root_
+    ( [this,&points,prob] ( const double l ) -> double
+      {
+        const std::pair<double,double> x = points ( l ) ;
+        return cdf ( x.second ) - cdf ( x.first ) - prob ;
+      } , 0.0 , fm , 1.e-14 * fm , 1.e-14 , 200 ) ;
+  //
+  return points ( level ) ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -3,6 +3,7 @@
 // ============================================================================
 // STD & STL
 // ============================================================================
+#include <algorithm>
 #include <cmath>
 // ============================================================================
 // GSL
@@ -10,6 +11,7 @@
 #include "gsl/gsl_sf_exp.h"
 #include "gsl/gsl_sf_gamma.h"
 #include "gsl/gsl_sf_gamma.h"
+#include "gsl/gsl_sf_psi.h"
 #include "gsl/gsl_randist.h"
 #include "gsl/gsl_cdf.h"
 // ============================================================================
@@ -17,6 +19,7 @@
 // ============================================================================
 #include "Ostap/Peaks.h"
 #include "Ostap/MoreMath.h"
+#include "Ostap/ChebyshevApproximation.h"
 // ============================================================================
 //  Local
 // ============================================================================
@@ -190,6 +193,24 @@ double Ostap::Math::BifurcatedGauss::evaluate ( const double x ) const
     my_exp ( -0.5 * dx * dx / ( sigmaR () * sigmaR () ) ) / norm ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::BifurcatedGauss::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double norm = s_SQRTPIHALF * ( sigmaL() + sigmaR() ) ;
+  const double aL   = -0.5 / ( sigmaL () * sigmaL () ) ;
+  const double aR   = -0.5 / ( sigmaR () * sigmaR () ) ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double dx = x [ i ] - m_peak ;
+    result [ i ] = my_exp ( ( dx < 0 ? aL : aR ) * dx * dx ) / norm ;
+  }
+}
+// ============================================================================
 // get the integral
 // ============================================================================
 double Ostap::Math::BifurcatedGauss::integral () const { return 1 ; }
@@ -456,6 +477,33 @@ double Ostap::Math::Gauss::evaluate ( const double x ) const
   return my_exp ( -0.5 * dx * dx ) / norm ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Gauss::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double norm = s_SQRTPIHALF * m_sigma  ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double dx = ( x [ i ] - m_peak ) / m_sigma ;
+    result [ i ]    = my_exp ( -0.5 * dx * dx ) / norm ;
+  }
+}
+// ============================================================================
+// evaluate the function and the derivatives of its logarithm
+// ============================================================================
+double Ostap::Math::Gauss::dlogpdf
+( const double x    , 
+  double*      dlog ) const
+{
+  const double dx = ( x - m_peak ) / m_sigma ;
+  dlog [ 0 ] = dx / m_sigma ;
+  dlog [ 1 ] = ( dx * dx - 1 ) / m_sigma ;
+  return evaluate ( x ) ;
+}
+// ============================================================================
 // get the integral
 // ============================================================================
 double Ostap::Math::Gauss::integral () const { return 1 ; }
@@ -1083,6 +1131,14 @@ double Ostap::Math::Bukin::pdf ( const double x ) const
   //
   return my_exp ( - s_ln2 * dx * dx * A * A * m_B2 ) ;
 }
+// ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Bukin::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = pdf ( x [ i ] ) ; } }
 // =========================================================================
 // get the integral between low and high limits
 // =========================================================================
@@ -1528,6 +1584,66 @@ double Ostap::Math::CrystalBall::pdf ( const double x ) const
   return my_exp ( -0.5 * dx * dx ) * s_SQRT2PIi / sigma() ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::CrystalBall::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  // 
+  const double norm = s_SQRT2PIi / sigma() ;
+  //
+  // (1) the core: branch-free loop 
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double dx = ( x [ i ] - m_m0 ) / m_sigma ;
+    result [ i ]    = my_exp ( -0.5 * dx * dx ) * norm ;
+  }
+  //
+  // (2) the tail 
+  const double np = np1 () ;
+  const double a  = aa  () ;
+  const double xL = m_m0 - m_alpha * m_sigma ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    if ( xL <= x [ i ] ) { continue ; }
+    const double dx = ( x [ i ] - m_m0 ) / m_sigma ;
+    if ( dx < -m_alpha ) 
+    { result [ i ] = std::pow ( np / ( np - a * ( m_alpha + dx ) ) , np ) * m_A * norm ; }
+  }
+}
+// ============================================================================
+// evaluate the function and the derivatives of its logarithm
+// ============================================================================
+double Ostap::Math::CrystalBall::dlogpdf
+( const double x    , 
+  double*      dlog ) const
+{
+  const double dx = ( x - m_m0 ) / m_sigma ;
+  //
+  // the tail
+  if  ( dx < -m_alpha )
+  {
+    const double np = np1 () ;
+    const double a  = aa  () ;
+    const double d  = np - a * ( m_alpha + dx ) ;
+    const double s  = m_alpha < 0 ? -1 : 1 ;
+    dlog [ 0 ] = -np * a / ( d * m_sigma ) ;
+    dlog [ 1 ] = -np * a * dx / ( d * m_sigma ) - 1 / m_sigma ;
+    dlog [ 2 ] =  np * ( s * ( m_alpha + dx ) + a ) / d - m_alpha ;
+    dlog [ 3 ] =  std::log ( np / d ) + 1 - np / d ;
+    return std::pow ( np / d , np ) * m_A * s_SQRT2PIi / m_sigma ;
+  }
+  //
+  // the peak
+  dlog [ 0 ] = dx / m_sigma ;
+  dlog [ 1 ] = ( dx * dx - 1 ) / m_sigma ;
+  dlog [ 2 ] = 0 ;
+  dlog [ 3 ] = 0 ;
+  return my_exp ( -0.5 * dx * dx ) * s_SQRT2PIi / m_sigma ;
+}
+// ============================================================================
 // get the integral between low and high
 // ============================================================================
 double Ostap::Math::CrystalBall::integral
@@ -1657,6 +1773,14 @@ std::size_t Ostap::Math::Needham::tag () const
   return std::hash_combine ( s_name , m_cb.tag() ,  m_a0 , m_a1 , m_a2 ) ; 
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Needham::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{ m_cb.evaluate ( n , x , result ) ; }
+// ============================================================================
 
 
 // ============================================================================
@@ -1687,6 +1811,25 @@ double Ostap::Math::CrystalBallRightSide::pdf ( const double x ) const
   return  m_cb.pdf ( y ) ;  
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::CrystalBallRightSide::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  const double x2 = 2 * m0 () ;
+  // the reflected points are processed by chunks to avoid the allocation 
+  const std::size_t s_CHUNK = 256 ;
+  double y [ s_CHUNK ] ;
+  for ( std::size_t i0 = 0 ; i0 < n ; i0 += s_CHUNK ) 
+  {
+    const std::size_t nc = std::min ( s_CHUNK , n - i0 ) ;
+    for ( std::size_t i = 0 ; i < nc ; ++i ) { y [ i ] = x2 - x [ i0 + i ] ; }
+    m_cb.evaluate ( nc , y , result + i0 ) ;
+  }
+}
+// ============================================================================
 // get the integral between low and high
 // ============================================================================
 double Ostap::Math::CrystalBallRightSide::integral
@@ -1864,6 +2007,83 @@ double Ostap::Math::CrystalBallDoubleSided::pdf ( const double x ) const
   return my_exp ( -0.5 * dx * dx ) * s_SQRT2PIi / sigma() ; 
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::CrystalBallDoubleSided::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  // 
+  const double norm = s_SQRT2PIi / sigma() ;
+  //
+  // (1) the core: branch-free loop 
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double dx = ( x [ i ] - m_m0 ) / m_sigma ;
+    result [ i ]    = my_exp ( -0.5 * dx * dx ) * norm ;
+  }
+  //
+  // (2) the tails 
+  const double npL  = n_L () + 1 ;
+  const double npR  = n_R () + 1 ;
+  const double aL   = std::abs ( m_alpha_L ) ;
+  const double aR   = std::abs ( m_alpha_R ) ;
+  const double xL   = m_m0 - m_alpha_L * m_sigma ;
+  const double xR   = m_m0 + m_alpha_R * m_sigma ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    if ( xL <= x [ i ] && x [ i ] <= xR ) { continue ; }
+    const double dx = ( x [ i ] - m_m0 ) / m_sigma ;
+    if      ( dx  < -m_alpha_L )  // left tail
+    { result [ i ] = std::pow ( npL / ( npL - aL * ( m_alpha_L + dx ) ) , npL ) * m_AL * norm ; }
+    else if ( dx  >  m_alpha_R )  // right tail
+    { result [ i ] = std::pow ( npR / ( npR - aR * ( m_alpha_R - dx ) ) , npR ) * m_AR * norm ; }
+  }
+}
+// ============================================================================
+// evaluate the function and the derivatives of its logarithm
+// ============================================================================
+double Ostap::Math::CrystalBallDoubleSided::dlogpdf
+( const double x    , 
+  double*      dlog ) const
+{
+  const double dx = ( x - m_m0 ) / m_sigma ;
+  std::fill ( dlog , dlog + 6 , 0.0 ) ;
+  //
+  // the left tail
+  if      ( dx < -m_alpha_L )
+  {
+    const double np = n_L () + 1 ;
+    const double a  = std::abs ( m_alpha_L ) ;
+    const double d  = np - a * ( m_alpha_L + dx ) ;
+    const double s  = m_alpha_L < 0 ? -1 : 1 ;
+    dlog [ 0 ] = -np * a / ( d * m_sigma ) ;
+    dlog [ 1 ] = -np * a * dx / ( d * m_sigma ) - 1 / m_sigma ;
+    dlog [ 2 ] =  np * ( s * ( m_alpha_L + dx ) + a ) / d - m_alpha_L ;
+    dlog [ 3 ] =  std::log ( np / d ) + 1 - np / d ;
+    return std::pow ( np / d , np ) * m_AL * s_SQRT2PIi / m_sigma ;
+  }
+  // the right tail
+  else if ( dx >  m_alpha_R )
+  {
+    const double np = n_R () + 1 ;
+    const double a  = std::abs ( m_alpha_R ) ;
+    const double d  = np - a * ( m_alpha_R - dx ) ;
+    const double s  = m_alpha_R < 0 ? -1 : 1 ;
+    dlog [ 0 ] =  np * a / ( d * m_sigma ) ;
+    dlog [ 1 ] =  np * a * dx / ( d * m_sigma ) - 1 / m_sigma ;
+    dlog [ 4 ] =  np * ( s * ( m_alpha_R - dx ) + a ) / d - m_alpha_R ;
+    dlog [ 5 ] =  std::log ( np / d ) + 1 - np / d ;
+    return std::pow ( np / d , np ) * m_AR * s_SQRT2PIi / m_sigma ;
+  }
+  //
+  // the peak
+  dlog [ 0 ] = dx / m_sigma ;
+  dlog [ 1 ] = ( dx * dx - 1 ) / m_sigma ;
+  return my_exp ( -0.5 * dx * dx ) * s_SQRT2PIi / m_sigma ;
+}
+// ============================================================================
 // get the integral between low and high
 // ============================================================================
 double Ostap::Math::CrystalBallDoubleSided::integral
@@ -2094,6 +2314,73 @@ double Ostap::Math::Apollonios::pdf ( const double x ) const
   return my_exp ( -b() * std::sqrt ( 1 + dx*dx ) ) * s_SQRT2PIi / sigma() ;  
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Apollonios::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  // 
+  const double norm = s_SQRT2PIi / sigma() ;
+  const double bb   = b () ;
+  //
+  // (1) the core: branch-free loop 
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double dx = ( x [ i ] - m_m0 ) / m_sigma ;
+    result [ i ]    = my_exp ( -bb * std::sqrt ( 1 + dx * dx ) ) * norm ;
+  }
+  //
+  // (2) the tail 
+  const double np = np1 () ;
+  const double a  = aa  () ;
+  const double xL = m_m0 - m_alpha * m_sigma ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    if ( xL <= x [ i ] ) { continue ; }
+    const double dx = ( x [ i ] - m_m0 ) / m_sigma ;
+    if ( dx < -m_alpha ) 
+    { result [ i ] = std::pow ( np / ( np - ( m_alpha + dx ) * a ) , np ) * m_A * norm ; }
+  }
+}
+// ============================================================================
+// evaluate the function and the derivatives of its logarithm
+// ============================================================================
+double Ostap::Math::Apollonios::dlogpdf
+( const double x    , 
+  double*      dlog ) const
+{
+  const double dx = ( x - m_m0 ) / m_sigma ;
+  //
+  // the tail
+  if  ( dx < -m_alpha )
+  {
+    const double np = np1 () ;
+    const double a  = aa  () ;
+    const double q  = a1  () ;
+    const double d  = np - ( m_alpha + dx ) * a ;
+    const double s  = m_alpha < 0 ? -1 : 1 ;
+    // d(aa)/d(alpha) 
+    const double da = b () * s / ( q * q * q ) ;
+    dlog [ 0 ] = -np * a / ( d * m_sigma ) ;
+    dlog [ 1 ] = -np * a * dx / ( d * m_sigma ) - 1 / m_sigma ;
+    dlog [ 2 ] =  np * ( a + ( m_alpha + dx ) * da ) / d - b () * m_alpha / q ;
+    dlog [ 3 ] =  std::log ( np / d ) + 1 - np / d ;
+    dlog [ 4 ] =  np * ( m_alpha + dx ) * std::abs ( m_alpha ) / ( q * d ) - q ;
+    return std::pow ( np / d , np ) * m_A * s_SQRT2PIi / m_sigma ;
+  }
+  //
+  // the peak
+  const double r = std::sqrt ( 1 + dx * dx ) ;
+  dlog [ 0 ] = b () * dx / ( r * m_sigma ) ;
+  dlog [ 1 ] = b () * dx * dx / ( r * m_sigma ) - 1 / m_sigma ;
+  dlog [ 2 ] = 0 ;
+  dlog [ 3 ] = 0 ;
+  dlog [ 4 ] = -r ;
+  return my_exp ( -b () * r ) * s_SQRT2PIi / m_sigma ;
+}
+// ============================================================================
 // get the integral between low and high
 // ============================================================================
 double Ostap::Math::Apollonios::integral
@@ -2258,6 +2545,29 @@ double Ostap::Math::Apollonios2::pdf ( const double x ) const
   return my_exp ( beta() * ( beta()  - std::sqrt ( b2 () + dx * dx ) ) ) * s_SQRT2PIi / sigma()  ;  
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Apollonios2::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  //
+  const double norm = s_SQRT2PIi / sigma() ;
+  const double b    = beta () ;
+  const double bb   = b2   () ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double dx = 
+      ( x [ i ] < m_m0 ) ?
+      ( x [ i ] - m_m0 ) / m_sigmaL :
+      ( x [ i ] - m_m0 ) / m_sigmaR ;
+    //
+    result [ i ] = my_exp ( b * ( b - std::sqrt ( bb + dx * dx ) ) ) * norm ;
+  }
+}
+// ============================================================================
 // get the integral between low and high
 // ============================================================================
 double Ostap::Math::Apollonios2::integral
@@ -2802,6 +3112,43 @@ double Ostap::Math::StudentT::pdf ( const double x ) const
   return m_norm * f / sigma () ; // sigma comes from dx = dy * sigma 
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::StudentT::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  //
+  const double v    = nu    () ;
+  const double p    = -0.5 * ( v + 1 ) ;
+  const double norm = m_norm / sigma () ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double y = ( x [ i ] - M () ) / sigma () ;
+    result [ i ] = norm * std::pow (  1 + y * y / v , p ) ;
+  }
+}
+// ============================================================================
+// evaluate the function and the derivatives of its logarithm
+// ============================================================================
+double Ostap::Math::StudentT::dlogpdf
+( const double x    , 
+  double*      dlog ) const
+{
+  const double v = nu () ;
+  const double y = ( x - M () ) / sigma () ;
+  const double q = v + y * y ;
+  //
+  dlog [ 0 ] = ( v + 1 ) * y / ( sigma () * q ) ;
+  dlog [ 1 ] = ( v + 1 ) * y * y / ( sigma () * q ) - 1 / sigma () ;
+  dlog [ 2 ] = 0.5 * ( gsl_sf_psi ( 0.5 * ( v + 1 ) ) - gsl_sf_psi ( 0.5 * v ) - 1 / v )
+    - 0.5 * std::log1p ( y * y / v ) + 0.5 * ( v + 1 ) * y * y / ( v * q ) ;
+  //
+  return pdf ( x ) ;
+}
+// ============================================================================
 double Ostap::Math::StudentT::cdf ( const double y ) const
 {
   //
@@ -3077,6 +3424,28 @@ double Ostap::Math::SinhAsinh::pdf ( const double x ) const
   return  r / sigma() ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::SinhAsinh::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  //
+  const double mu_   = mu      () ;
+  const double sigma_= sigma   () ;
+  const double eps   = epsilon () ;
+  const double dlt   = delta   () ;
+  const double norm  = s_SQRT2PIi * dlt / sigma_ ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double y = ( x [ i ] - mu_ ) / sigma_  ;
+    const double z = shash ( y , eps , dlt )  ;
+    result [ i ] = norm * std::hypot ( 1 , z ) / std::hypot ( 1 , y ) * my_exp ( -0.5 * z * z ) ;
+  }
+}
+// ============================================================================
 // evaluate sinhasinh cimulative distribution
 // ============================================================================
 double Ostap::Math::SinhAsinh::cdf ( const double x ) const 
@@ -3196,6 +3565,24 @@ double Ostap::Math::JohnsonSU::pdf        ( const double x ) const
   return res * m_delta / ( m_lambda * s_SQRT2PI ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::JohnsonSU::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  //
+  const long double norm = m_delta / ( m_lambda * s_SQRT2PI ) ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const long double dx  = ( x [ i ] - m_xi ) / m_lambda ;
+    const long double z   = m_gamma + m_delta * std::asinh ( dx ) ;
+    result [ i ] = std::exp ( -0.5 * z * z ) / std::sqrt ( 1 + dx * dx ) * norm ;
+  }
+}
+// ============================================================================
 // evaluate JohnsonSU-distributions
 // ============================================================================
 double Ostap::Math::JohnsonSU::cdf        ( const double x ) const 
@@ -3790,6 +4177,84 @@ namespace
     return 2 * nu ;
   }
   // ==========================================================================
+  /** @struct BesselConstants
+   *  The small per-thread memo for the Bessel-based constants 
+   *  \f$ A^2_{\nu}(\zeta)= \zeta K_{\nu+1}(\zeta)/K_{\nu}(\zeta)\f$ and 
+   *  \f$ \zeta^{\nu}K^*_{\nu}(\zeta) \f$.
+   *  The minimizer moves the parameters back and forth 
+   *  (e.g. for the numerical derivatives), and the memo allows 
+   *  to avoid the recalculation of the Bessel functions 
+   *  for the recently used parameters 
+   */
+  struct BesselConstants 
+  {
+    // ========================================================================
+    struct Entry { double nu ; double z ; double AL2 ; double zK ; } ;
+    // ========================================================================
+    /// get the constants \f$ (A^2, \zeta^{\nu}K^*_{\nu}) \f$
+    std::pair<double,double> get ( const double nu , const double z ) 
+    {
+      for ( std::size_t i = 0 ; i < m_size ; ++i ) 
+      {
+        const Entry& e = m_entries [ i ] ;
+        if ( e.nu == nu && e.z == z ) { return std::make_pair ( e.AL2 , e.zK ) ; } // RETURN
+      }
+      //
+      const Entry e { nu , z , _AL2_ ( nu , z ) , z_knu_scaled ( z , nu ) } ;
+      m_entries [ m_next ] = e ;
+      m_next = ( m_next + 1 ) % s_N ;
+      if ( m_size < s_N ) { ++m_size ; }
+      return std::make_pair ( e.AL2 , e.zK ) ;
+    }
+    // ========================================================================
+    static constexpr std::size_t s_N = 16 ;
+    Entry       m_entries [ s_N ] ;
+    std::size_t m_next { 0 } ;
+    std::size_t m_size { 0 } ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /// get the Bessel constants \f$ (A^2_{\nu}(\zeta), \zeta^{\nu}K^*_{\nu}(\zeta)) \f$
+  inline std::pair<double,double> _bessel_constants_ ( const double nu , const double z ) 
+  {
+    static thread_local BesselConstants s_memo {} ;
+    return s_memo.get ( nu , z ) ;
+  }
+  // ==========================================================================
+  /// the range of arguments for the Chebyshev proxy of \f$ \log K^*_{\nu}(x) \f$
+  const double s_KNU_XMIN = 1.e-4 ;
+  const double s_KNU_XMAX = 500   ;
+  // ==========================================================================
+  /** is \f$ \nu \f$ half-integer: \f$ \left|\nu\right| = n + 1/2 \f$ ? 
+   *  (only moderate values of n are considered)
+   */
+  inline bool _half_integer_ ( const double nu , unsigned int& n ) 
+  {
+    const double a = std::abs ( nu ) - 0.5 ;
+    if ( a < 0 || 20 < a ) { return false ; }
+    const long k = std::lround ( a ) ;
+    if ( !s_equal ( a , k ) ) { return false ; }
+    n = k ;
+    return true ;
+  }
+  // ==========================================================================
+  /** scaled modified Bessel function for half-integer order:
+   *  \f$ K^*_{n+1/2}(x) = \sqrt{\frac{\pi}{2x}} 
+   *   \sum_{k=0}^{n} \frac{(n+k)!}{k!(n-k)!} \left(2x\right)^{-k} \f$ 
+   */
+  inline double _knu_half_scaled_ ( const unsigned int n , const double x ) 
+  {
+    const double y    = 0.5 / x ;
+    double       term = 1 ;
+    double       sum  = 1 ;
+    for ( unsigned int k = 0 ; k < n ; ++k ) 
+    {
+      term *= ( n + k + 1.0 ) * ( n - k ) / ( k + 1.0 ) * y ;
+      sum  += term ;
+    }
+    return std::sqrt ( M_PI * y ) * sum ;
+  }
+  // ==========================================================================
 }
 // ============================================================================
 
@@ -3841,8 +4306,9 @@ bool Ostap::Math::Hyperbolic::setZeta ( const double value )
   if ( s_equal ( avalue , m_zeta ) &&  ( 0 < m_AL ) && ( 0 < m_N ) ) { return false ; }
   m_zeta = avalue ;
   //
-  m_AL = std::sqrt ( _AL2_ ( 1 , m_zeta ) ) ;
-  m_N  = 1 / ( z_knu_scaled ( m_zeta , 1 ) ) ; 
+  const std::pair<double,double> c = _bessel_constants_ ( 1 , m_zeta ) ;
+  m_AL = std::sqrt ( c.first ) ;
+  m_N  = 1 / c.second ; 
   //
   return true ;
 }
@@ -3877,13 +4343,13 @@ bool Ostap::Math::Hyperbolic::setStandard
   if ( !s_equal ( m_zeta , _zeta ) ) { modified = true ; }
   m_zeta = _zeta ;
   //
-  if ( modified ) { m_AL = std::sqrt ( _AL2_ ( 1  , m_zeta ) ) ; }
+  if ( modified ) { m_AL = std::sqrt ( _bessel_constants_ ( 1 , m_zeta ).first ) ; }
   //
   const double _sigma = m_AL / std::abs ( gamma ) ;
   if ( s_equal ( m_sigma , _sigma ) ) { modified = true ; }
   m_sigma = _sigma ;
   //
-  if ( modified ) { m_N = 1 / ( s_SQRT2PI * z_knu_scaled ( m_zeta , 1 ) ) ; }
+  if ( modified ) { m_N = 1 / ( s_SQRT2PI * _bessel_constants_ ( 1 , m_zeta ).second ) ; }
   //
   const double _kappa = beta / m_sigma ;
   if ( s_equal ( m_kappa , _kappa ) ) { modified = true ; }
@@ -3934,6 +4400,28 @@ double Ostap::Math::Hyperbolic::pdf ( const double x ) const
   return m_N * std::exp ( q ) * aa ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Hyperbolic::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  //
+  const double a2 = m_AL * m_AL            ;
+  const double ka = m_kappa * m_kappa + a2 ;
+  const double z2 = m_zeta  * m_zeta  / a2 ;
+  const double aa = 0.5 * a2 / ( m_sigma * std::sqrt ( ka ) ) ;
+  const double na = m_N * aa ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double dx =  ( x [ i ] - m_mu ) / m_sigma ;
+    const double q  = - std::sqrt ( ka * ( z2 + dx * dx ) ) + m_kappa * dx + m_zeta ;
+    result [ i ] = na * std::exp ( q ) ;
+  }
+}
+// ============================================================================
 // get the integral between low and high limits
 // =========================================================================
 double Ostap::Math::Hyperbolic::integral
@@ -4053,8 +4541,9 @@ bool Ostap::Math::GenHyperbolic::setZeta ( const double value )
   if ( s_equal ( avalue , m_zeta ) &&  ( 0 < m_AL ) && ( 0 < m_N ) ) { return false ; }
   m_zeta = avalue ;
   //
-  m_AL = std::sqrt ( _AL2_ ( m_lambda , m_zeta ) ) ;
-  m_N  = 1 / ( s_SQRT2PI * z_knu_scaled ( m_zeta , m_lambda ) ) ;
+  const std::pair<double,double> c = _bessel_constants_ ( m_lambda , m_zeta ) ;
+  m_AL = std::sqrt ( c.first ) ;
+  m_N  = 1 / ( s_SQRT2PI * c.second ) ;
   //
   return true ;
 }
@@ -4064,8 +4553,12 @@ bool Ostap::Math::GenHyperbolic::setLambda ( const double value )
   if ( s_equal ( value , m_lambda ) && ( 0 < m_AL ) && ( 0 < m_N ) ) { return false ; }
   m_lambda = value ;
   //
-  m_AL = std::sqrt ( _AL2_ ( m_lambda , m_zeta ) ) ;
-  m_N  = 1 / ( s_SQRT2PI * z_knu_scaled ( m_zeta , m_lambda ) ) ;
+  const std::pair<double,double> c = _bessel_constants_ ( m_lambda , m_zeta ) ;
+  m_AL = std::sqrt ( c.first ) ;
+  m_N  = 1 / ( s_SQRT2PI * c.second ) ;
+  //
+  // the proxy for the Bessel function depends on lambda 
+  m_knu.reset () ;
   //
   return true ;
 }
@@ -4094,6 +4587,8 @@ bool Ostap::Math::GenHyperbolic::setStandard
 {
   bool modified = !s_equal ( m_mu , mu ) || !s_equal ( m_lambda , lambda ) ;
   //
+  if ( !s_equal ( m_lambda , lambda ) ) { m_knu.reset () ; }
+  //
   m_mu     = mu     ;
   m_lambda = lambda ;
   //
@@ -4101,13 +4596,13 @@ bool Ostap::Math::GenHyperbolic::setStandard
   if ( !s_equal ( m_zeta , _zeta ) ) { modified = true ; }
   m_zeta = _zeta ;
   //
-  if ( modified ) { m_AL = std::sqrt ( _AL2_ ( m_lambda , m_zeta ) ) ; }
+  if ( modified ) { m_AL = std::sqrt ( _bessel_constants_ ( m_lambda , m_zeta ).first ) ; }
   //
   const double _sigma = m_AL / std::abs ( gamma ) ;
   if ( s_equal ( m_sigma , _sigma ) ) { modified = true ; }
   m_sigma = _sigma ;
   //
-  if ( modified ) { m_N = 1 / ( s_SQRT2PI * z_knu_scaled ( m_zeta , m_lambda ) ) ; }
+  if ( modified ) { m_N = 1 / ( s_SQRT2PI * _bessel_constants_ ( m_lambda , m_zeta ).second ) ; }
   //
   const double _kappa = beta / m_sigma ;
   if ( s_equal ( m_kappa , _kappa ) ) { modified = true ; }
@@ -4130,10 +4625,8 @@ double Ostap::Math::GenHyperbolic::pdf ( const  double x ) const
   const double arg  =  std::sqrt ( arg2 ) ;
   //
   // NB: we use scaled bessel function here!
-  const double kfun = Ostap::Math::bessel_Knu_scaled ( m_lambda - 0.5 , arg ) ;
-  //
   const double f   = 
-    + std::log ( kfun )             // scaled bessel function 
+    + log_knu ( arg )               // scaled bessel function 
     - arg                           // "unscale" it 
     + m_zeta                        // from normalzation 
     + m_kappa * dx                  // asymmetry factor  
@@ -4142,6 +4635,36 @@ double Ostap::Math::GenHyperbolic::pdf ( const  double x ) const
   return m_N * std::exp ( f ) * std::pow ( gamma2() , m_lambda ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::GenHyperbolic::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  //
+  const double k2   = m_kappa * m_kappa ;
+  const double k2pA = k2 + m_AL * m_AL  ;
+  const double z_A  = m_zeta    / m_AL  ;
+  const double z2   = z_A * z_A ;
+  const double l5   = m_lambda - 0.5    ;
+  const double s2k  = m_sigma * m_sigma / k2pA ;
+  const double norm = m_N * std::pow ( gamma2() , m_lambda ) ;
+  //
+  // the Bessel function for the fixed order: build the proxy once 
+  if ( !m_knu ) { build_knu () ; }
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double dx   = ( x [ i ] - m_mu ) / m_sigma ;
+    const double arg  = std::sqrt ( k2pA * ( dx * dx + z2 ) ) ;
+    //
+    // NB: we use scaled bessel function here!
+    const double f    = log_knu ( arg ) - arg + m_zeta + m_kappa * dx + l5 * std::log ( arg * s2k ) ;
+    result [ i ] = norm * std::exp ( f ) ;
+  }
+}
+// ============================================================================
 // get the integral between low and high limits
 // =========================================================================
 double Ostap::Math::GenHyperbolic::integral
@@ -4166,6 +4689,9 @@ double Ostap::Math::GenHyperbolic::integral
   // in tails 
   const bool in_tail = ( high <= mlow ) || ( low >= mhigh ) ;
   //
+  // the integrand is evaluated many times: build the proxy for the Bessel function 
+  if ( !m_knu ) { build_knu () ; }
+  //
   // use GSL to evaluate the integral
   //
   static const Ostap::Math::GSL::Integrator1D<GenHyperbolic> s_integrator {} ;
@@ -4189,6 +4715,44 @@ double Ostap::Math::GenHyperbolic::integral
   return result ;
   //
 }
+// ============================================================================
+/*  \f$ \log K^*_{\lambda-1/2}(x) \f$, 
+ *  where \f$ K^*_{\nu}(x) \f$ is scaled modified Bessel function
+ *  - for the half-integer \f$\nu\f$ the elementary expression is used 
+ *  - otherwise the Chebyshev proxy (if exists) or GSL 
+ */
+// ============================================================================
+double Ostap::Math::GenHyperbolic::log_knu ( const double x ) const 
+{
+  const double nu = m_lambda - 0.5 ;
+  unsigned int n  = 0 ;
+  if ( _half_integer_ ( nu , n ) ) { return std::log ( _knu_half_scaled_ ( n , x ) ) ; }
+  //
+  if ( m_knu && s_KNU_XMIN <= x && x <= s_KNU_XMAX ) 
+  { return m_knu->evaluate ( std::log ( x ) ) ; }
+  //
+  return std::log ( Ostap::Math::bessel_Knu_scaled ( nu , x ) ) ;
+}
+// ============================================================================
+/*  build the Chebyshev proxy for \f$ \log K^*_{\lambda-1/2}(x) \f$
+ *  in the variable \f$ u = \log x \f$: 
+ *  the function is very smooth in this variable, 
+ *  and a few pieces provide \f$ 10^{-13}\f$ relative precision 
+ *  in the whole range \f$ 10^{-4} \le x \le 500 \f$ 
+ */
+// ============================================================================
+void Ostap::Math::GenHyperbolic::build_knu () const 
+{
+  const double nu = m_lambda - 0.5 ;
+  unsigned int n  = 0 ;
+  if ( _half_integer_ ( nu , n ) ) { return ; }  // not needed 
+  //
+  auto fun = [nu] ( const double u ) -> double 
+    { return std::log ( Ostap::Math::bessel_Knu_scaled ( nu , std::exp ( u ) ) ) ; } ;
+  //
+  m_knu = std::make_shared<const ChebyshevProxy>
+    ( fun , std::log ( s_KNU_XMIN ) , std::log ( s_KNU_XMAX ) , 1.e-13 , 16 ) ;
+}
 // ==============================================================================
 // get mean value 
 // ==============================================================================
@@ -4,10 +4,13 @@
 // STD & STL 
 // ============================================================================
 #include <cmath>
+#include <algorithm>
+#include <functional>
 // ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/PhaseSpace.h"
+#include "Ostap/ChebyshevApproximation.h"
 #include "Ostap/Dalitz.h"
 #include "Ostap/Kinematics.h"
 #include "Ostap/MoreMath.h"
@@ -29,6 +32,85 @@
  *  @author Vanya Belyaev
  */  
 // ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /// the precision of the Chebyshev approximations 
+  const double         s_APPROXIMATION = 1.e-7 ;
+  // ==========================================================================
+  /// maximal range of the approximation for 3-body phase space (in thresholds)
+  const double         s_PS3_RANGE     = 100   ;
+  // ==========================================================================
+  /** approximate the function in the range [xmin,xmax] with 
+   *  Chebyshev polynomials, the order is doubled until the 
+   *  required precision is reached at the control points 
+   *  - the control points are the midpoints of the uniform grid 
+   *  - the precision is defined relative to the maximal value of the function
+   *  @param fun       (INPUT)  the function to be approximated 
+   *  @param xmin      (INPUT)  low  edge 
+   *  @param xmax      (INPUT)  high edge 
+   *  @param precision (INPUT)  the required precision 
+   *  @param nmax      (INPUT)  the maximal order 
+   *  @return the approximation or nullptr, if precision is not reached 
+   */
+  std::shared_ptr<const Ostap::Math::ChebyshevApproximation> 
+  _approximate_ 
+  ( const std::function<double(double)>& fun       , 
+    const double                         xmin      , 
+    const double                         xmax      , 
+    const double                         precision , 
+    const unsigned short                 nmax      ) 
+  {
+    if ( !( xmin < xmax ) ) { return nullptr ; }
+    //
+    for ( unsigned short N = 16 ; N <= nmax ; N *= 2 ) 
+    {
+      auto approx = std::make_shared<const Ostap::Math::ChebyshevApproximation> ( fun , xmin , xmax , N ) ;
+      //
+      const unsigned int nc   = 2 * N + 1 ;
+      const double       dx   = ( xmax - xmin ) / nc ;
+      double             fmax = 0 ;
+      double             dmax = 0 ;
+      for ( unsigned int i = 0 ; i < nc ; ++i ) 
+      {
+        const double x = xmin + ( i + 0.5 ) * dx ;
+        const double f = fun ( x ) ;
+        fmax = std::max ( fmax , std::abs ( f                  ) ) ;
+        dmax = std::max ( dmax , std::abs ( f - ( *approx ) ( x ) ) ) ;
+      }
+      //
+      if ( 0 < fmax && dmax <= precision * fmax ) { return approx ; }
+      if ( 2 * N > nmax ) { break ; }
+    }
+    return nullptr ;
+  }
+  // ==========================================================================
+  /** the threshold & asymptotic behaviour of 3-body phase space 
+   *  - near threshold \f$ R_3 \propto Q^k\f$, \f$ Q = M - m_1 - m_2 - m_3\f$, 
+   *    where each momentum \f$ q^{2\ell+1}\f$ gives \f$ Q^{\ell+1/2}\f$ 
+   *    for massive and \f$ Q^{2\ell+1}\f$ for (partly) massless pair 
+   *  - for large masses \f$ R_3 \propto M^{2\ell_1+2\ell_2+2}\f$ 
+   */
+  double _ps3_envelope_ 
+  ( const Ostap::Math::PhaseSpace3& ps , 
+    const double                    x  ) 
+  {
+    const double thr = ps.lowEdge () ;
+    const double Q   = x - thr ;
+    //
+    const bool   m12 = 0 < ps.m1 () && 0 < ps.m2 () ;
+    const bool   m3  = 0 < ps.m3 () && 0 < ps.m1 () + ps.m2 () ;
+    //
+    const double a1  = m12 ? ps.l1 () + 0.5 : 2 * ps.l1 () + 1 ;
+    const double a2  = m3  ? ps.l2 () + 0.5 : 2 * ps.l2 () + 1 ;
+    const double k   = a1 + a2 + 1 ;
+    const double p   = 2 * ps.l1 () + 2 * ps.l2 () + 2 - k ;
+    //
+    return std::pow ( Q , k ) * std::pow ( Q + thr , p ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
 // constructor from two masses
 // ============================================================================
 Ostap::Math::PhaseSpace2::PhaseSpace2
@@ -308,6 +390,9 @@ bool Ostap::Math::PhaseSpace3::setM1 ( const double value )
   if ( s_equal ( a , m_m1 ) ) { return false ; }
   m_m1 = a ;
   if ( s_zero ( m_m1 ) ) { m_m1 = 0 ; }
+  // reset the approximation 
+  m_approx.reset () ;
+  m_failed = false  ;
   return true ;
 }
 // ============================================================================a
@@ -319,6 +404,9 @@ bool Ostap::Math::PhaseSpace3::setM2 ( const double value )
   if ( s_equal ( a , m_m2 ) ) { return false ; }
   m_m2 = a ;
   if ( s_zero ( m_m2 ) ) { m_m2 = 0 ; }
+  // reset the approximation 
+  m_approx.reset () ;
+  m_failed = false  ;
   return true ;
 }
 // ============================================================================a
@@ -330,6 +418,9 @@ bool Ostap::Math::PhaseSpace3::setM3 ( const double value )
   if ( s_equal ( a , m_m3 ) ) { return false ; }
   m_m3 = a ;
   if ( s_zero ( m_m3 ) ) { m_m3 = 0 ; }
+  // reset the approximation 
+  m_approx.reset () ;
+  m_failed = false  ;
   return true ;
 }
 // ============================================================================
@@ -383,6 +474,35 @@ namespace
  */
 // ============================================================================
 double Ostap::Math::PhaseSpace3::evaluate  ( const double x ) const
+{
+  //
+  const double thr = lowEdge () ;
+  if ( x <= thr ) { return 0 ; }
+  //
+  const double Q   = x - thr ;
+  if ( m_failed || thr <= 0 || s_PS3_RANGE * thr < Q ) { return direct ( x ) ; }
+  //
+  if ( !m_approx || m_approx->xmax () < x ) 
+  {
+    // extend the range of the approximation (at least the threshold value) 
+    const double qmax = std::min ( s_PS3_RANGE * thr , 
+                                   std::max ( { thr , 2 * Q , m_approx ? 2 * ( m_approx->xmax () - thr ) : 0.0 } ) ) ;
+    //
+    const std::function<double(double)> ratio = [this] ( const double m ) -> double 
+      { return this->direct ( m ) / _ps3_envelope_ ( *this , m ) ; } ;
+    //
+    m_approx = _approximate_ ( ratio , thr , thr + qmax , s_APPROXIMATION , 512 ) ;
+    if ( !m_approx ) { m_failed = true ; return direct ( x ) ; }
+  }
+  //
+  return ( *m_approx ) ( x ) * _ps3_envelope_ ( *this , x ) ;
+}
+// ============================================================================
+/*  evaluate 3-body phase space via the direct numerical integration
+ *  (no approximation is used)
+ */
+// ============================================================================
+double Ostap::Math::PhaseSpace3::direct ( const double x ) const
 {
   //
   if ( x <= lowEdge() ) { return 0 ; }
@@ -1010,9 +1130,6 @@ Ostap::Math::PhaseSpaceNL::PhaseSpaceNL
   , m_N          ( n )
   , m_L          ( l )
   , m_norm       ( 1 )
-    //
-  , m_workspace  ()
-    //
 {
   //
   Ostap::Assert ( ( 2 <= l && l <  n ) ||  // the regular case 
@@ -1130,42 +1247,21 @@ double  Ostap::Math::PhaseSpaceNL::integral
     const double y1      = ( low  - m_threshold1 ) * ilength ;
     const double y2      = ( high - m_threshold1 ) * ilength ;
     ///
-    return m_norm * ( std::pow ( y2 , 0.5 * ( 3 * m_N ) ) - 
-                      std::pow ( y1 , 0.5 * ( 3 * m_L ) ) ) ;
+    return std::pow ( 1 - y1 , 0.5 * ( 3 * m_N ) ) - 
+           std::pow ( 1 - y2 , 0.5 * ( 3 * m_N ) ) ;
   }
   //
-  // generic case 
+  // generic case: the normalization is the inverse beta-function,
+  // and the integral is expressed via the regularized incomplete beta-function 
   //
-  // split, if the interval is too large
-  const double width = 0.25 * std::abs  ( m_threshold2 - m_threshold1 ) ;
-  if ( 0 < width &&  width < high - low  )
-  {
-    return
-      integral ( low                   , 0.5 *  ( high + low ) ) +
-      integral ( 0.5 *  ( high + low ) ,          high         ) ;
-  }
+  const double ilength = 1.0 / ( m_threshold2  - m_threshold1 ) ;
+  const double y1      = std::max ( 0.0 , std::min ( 1.0 , ( low  - m_threshold1 ) * ilength ) ) ;
+  const double y2      = std::max ( 0.0 , std::min ( 1.0 , ( high - m_threshold1 ) * ilength ) ) ;
   //
-  // use GSL to evaluate the integral
-  //
-  static const Ostap::Math::GSL::Integrator1D<PhaseSpaceNL> s_integrator {} ;
-  static char s_message[] = "Integral(PhaseSpaceNL)" ;
-  //
-  const auto F = s_integrator.make_function ( this ) ;
-  int    ierror   = 0   ;
-  double result   = 1.0 ;
-  double error    = 1.0 ;
-  std::tie ( ierror , result , error ) = s_integrator.gaq_integrate
-    ( tag ()        ,
-      &F            , 
-      low           , high      ,    // low & high edges
-      workspace ( m_workspace ) ,    // workspace
-      s_PRECISION         ,          // absolute precision
-      s_PRECISION         ,          // relative precision
-      m_workspace.size () ,          // size of workspace
-      s_message           , 
-      __FILE__ , __LINE__ ) ;
+  const double a       = 0.5 * ( 3 *   m_L         - 3 ) ;
+  const double b       = 0.5 * ( 3 * ( m_N - m_L )     ) ;
   //
-  return result ;
+  return gsl_sf_beta_inc ( a , b , y2 ) - gsl_sf_beta_inc ( a , b , y1 ) ;
 }
 // ============================================================================
 // get the integral
@@ -1362,6 +1458,32 @@ double  Ostap::Math::PhaseSpace23L::integral
   if ( 0 < m_norm && s_equal ( x_min , low ) && s_equal ( x_max , high ) ) 
   { return 1.0 ; }
   //
+  // (1) approximate the density in variable t, 
+  //     x = x_min + 0.5 * ( x_max - x_min ) * ( 1 - cos t ) ,
+  //     that removes the square-root singularities at both edges 
+  //
+  const double delta = x_max - x_min ;
+  if ( !m_cdf && !m_failed ) 
+  {
+    const double scale = 0 < m_norm ? 1 / m_norm : 1.0 ;
+    const std::function<double(double)> density = [this,x_min,delta,scale] ( const double t ) -> double 
+      { return this->ps23L ( x_min + 0.5 * delta * ( 1 - std::cos ( t ) ) ) * 0.5 * delta * std::sin ( t ) * scale ; } ;
+    //
+    auto approx = _approximate_ ( density , 0 , M_PI , s_APPROXIMATION , 1024 ) ;
+    if ( approx ) { m_cdf = std::make_shared<const ChebyshevApproximation> ( approx->integral () ) ; }
+    else          { m_failed = true ; }
+  }
+  //
+  // (2) and use its integral 
+  //
+  if ( m_cdf ) 
+  {
+    const double t1 = std::acos ( std::max ( -1.0 , std::min ( 1.0 , 1 - 2 * ( low  - x_min ) / delta ) ) ) ;
+    const double t2 = std::acos ( std::max ( -1.0 , std::min ( 1.0 , 1 - 2 * ( high - x_min ) / delta ) ) ) ;
+    const double result = ( *m_cdf ) ( t2 ) - ( *m_cdf ) ( t1 ) ;
+    return 0 < m_norm ? result * m_norm : result ;
+  }
+  //
   // use GSL to evaluate the integral
   //
   static const Ostap::Math::GSL::Integrator1D<PhaseSpace23L> s_integrator {} ;
@@ -6,6 +6,7 @@
 #include <functional>
 #include <algorithm>
 #include <vector>
+#include <numeric>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -29,15 +30,22 @@ namespace
   const std::string s_METHOD3 { "Ostap::Math::Piecewise(3)"   } ;
   const std::string s_METHOD4 { "Ostap::Math::Piecewise(4)"   } ;
   // ==========================================================================
+  /// use the lookup table if the number of edges exceeds this value 
+  const std::size_t s_TABLE   { 4 } ;
+  // ==========================================================================
 }
 // ============================================================================
 // default constructor : create constant function
 // ============================================================================
 Ostap::Math::Piecewise::Piecewise 
 ( const double value ) 
-  : m_edges() 
-  , m_funcs ( 1 , FPAIR ( []( const double /* x */ ) -> double { return 1 ; } , value ) )
-{}
+  : m_edges    () 
+  , m_funcs    ( 1 , FPAIR ( []( const double /* x */ ) -> double { return 1 ; } , value ) )
+  , m_segments ( 1 ) 
+  , m_table    () 
+{
+  m_segments.front().kind = Constant ;
+}
 // ============================================================================
 /*  add new function, defined for  \f$ x\ge x_i\$ 
  *  @attention xi must be larger than any previosly aded ranges!
@@ -49,12 +57,134 @@ void Ostap::Math::Piecewise::add_
 ( const double                  xi , 
   std::function<double(double)> fi ,
   const double                  si ) 
+{
+  Segment seg {} ;
+  // plain function ? 
+  const FPTR* fp = fi.target<FPTR> () ;
+  if ( fp && *fp ) { seg.kind = Pointer ; seg.ptr = *fp ; }
+  //
+  this->add_ ( xi , FPAIR ( fi , si ) , seg ) ;
+}
+// ============================================================================
+// add the component: the edge is checked and the lookup table updated
+// ============================================================================
+void Ostap::Math::Piecewise::add_ 
+( const double   xi , 
+  const FPAIR&   p  , 
+  const Segment& s  ) 
 {
   //
   Ostap::Assert ( m_edges.empty () || xi > m_edges.back() , s_ERROR , s_METHOD ) ;
   //
-  m_edges.push_back ( xi ) ; 
-  m_funcs.push_back ( FPAIR ( fi , si ) ) ;
+  m_edges   .push_back ( xi ) ; 
+  m_funcs   .push_back ( p  ) ;
+  m_segments.push_back ( s  ) ;
+  //
+  this->updateTable () ;
+}
+// ============================================================================
+// add the very first component 
+// ============================================================================
+void Ostap::Math::Piecewise::push_ 
+( const FPAIR&   p  , 
+  const Segment& s  ) 
+{
+  m_funcs   .push_back ( p  ) ;
+  m_segments.push_back ( s  ) ;
+}
+// ============================================================================
+// (re)build the lookup table for the segments 
+// ============================================================================
+void Ostap::Math::Piecewise::updateTable () 
+{
+  m_table.clear () ;
+  const std::size_t N = m_edges.size () ;
+  if ( N <= s_TABLE ) { return ; }                 // binary search is fine 
+  //
+  // two bins per segment: O(1) search for (nearly) uniform edges 
+  const std::size_t M    = 2 * N ;
+  const double      xmin = m_edges.front () ;
+  const double      xmax = m_edges.back  () ;
+  const double      dx   = ( xmax - xmin ) / M ;
+  m_table.resize ( M ) ;
+  std::size_t j = 0 ;
+  for ( std::size_t b = 0 ; b < M ; ++b ) 
+  {
+    const double xb = xmin + b * dx ;
+    while ( j < N && m_edges [ j ] <= xb ) { ++j ; }
+    m_table [ b ] = j ;
+  }
+}
+// ============================================================================
+/*  evaluate the function for the array of points 
+ *  - the points are grouped by segments 
+ *  @param n      number of points 
+ *  @param x      (INPUT)  the points 
+ *  @param result (OUTPUT) the function values
+ */
+// ============================================================================
+void Ostap::Math::Piecewise::evaluate 
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  if ( 0 == n ) { return ; }
+  //
+  const std::size_t NS = m_funcs.size () ;
+  if ( 1 == NS ) 
+  {
+    for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = value ( 0 , x [ i ] ) ; }
+    return ;
+  }
+  //
+  // 1) segment for each point (the previous segment is a good guess) 
+  std::vector<std::size_t> segment ( n ) ;
+  std::vector<std::size_t> offsets ( NS + 1 , 0 ) ;
+  const std::size_t NE = m_edges.size () ;
+  std::size_t       j  = index ( x [ 0 ] ) ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double xi = x [ i ] ;
+    if ( !( ( 0 == j || m_edges [ j - 1 ] <= xi ) && ( NE == j || xi < m_edges [ j ] ) ) )
+    { j = index ( xi ) ; }
+    segment [ i ] = j ;
+    ++offsets [ j + 1 ] ;
+  }
+  //
+  // 2) group the points by segments 
+  std::partial_sum ( offsets.begin () , offsets.end () , offsets.begin () ) ;
+  std::vector<std::size_t> order ( n ) ;
+  {
+    std::vector<std::size_t> pos ( offsets.begin () , offsets.end () - 1 ) ;
+    for ( std::size_t i = 0 ; i < n ; ++i ) { order [ pos [ segment [ i ] ]++ ] = i ; }
+  }
+  //
+  // 3) evaluate segment-by-segment 
+  for ( std::size_t k = 0 ; k < NS ; ++k ) 
+  {
+    const std::size_t first = offsets [ k     ] ;
+    const std::size_t last  = offsets [ k + 1 ] ;
+    if ( first == last ) { continue ; }
+    //
+    const FPAIR&   p     = m_funcs    [ k ] ;
+    const Segment& s     = m_segments [ k ] ;
+    const double   scale = p.second ;
+    //
+    switch ( s.kind ) 
+    {
+    case Constant : 
+      for ( std::size_t l = first ; l < last ; ++l ) { result [ order [ l ] ] = scale ; }
+      break ;
+    case Pointer  : 
+      for ( std::size_t l = first ; l < last ; ++l ) 
+      { const std::size_t i = order [ l ] ; result [ i ] = scale * s.ptr   ( x [ i ] ) ; }
+      break ;
+    default       : 
+      for ( std::size_t l = first ; l < last ; ++l ) 
+      { const std::size_t i = order [ l ] ; result [ i ] = scale * p.first ( x [ i ] ) ; }
+      break ;
+    }
+  }
 }
 // ============================================================================
 // scale the function 
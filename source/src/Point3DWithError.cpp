@@ -188,7 +188,7 @@ double Ostap::Math::Point3DWithError::chi2
   Ostap::Math::geo2LA ( point() , vct ) ;
   vct -= right ;
   //
-  return ROOT::Math::Similarity ( vct , s_cov2 ) ;
+  return Ostap::Math::similarity ( s_cov2 , vct ) ;
 }
 // ============================================================================
 // chi2 distance
@@ -207,7 +207,7 @@ double Ostap::Math::Point3DWithError::chi2
   Ostap::Math::geo2LA ( point() , vct ) ;
   vct -= right.value() ;
   //
-  return ROOT::Math::Similarity ( vct , s_cov2 ) ;
+  return Ostap::Math::similarity ( s_cov2 , vct ) ;
 }
 // ============================================================================
 // printout
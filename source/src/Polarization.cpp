@@ -5,6 +5,8 @@
 // ============================================================================
 #include <cmath>
 #include <climits>
+#include <atomic>
+#include <algorithm>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -12,6 +14,10 @@
 #include "Ostap/Tensors.h"
 #include "Ostap/Kinematics.h"
 // ============================================================================
+// local
+// ============================================================================
+#include "local_mt.h"
+// ============================================================================
 /** @file 
  *  Implementation file for functions from namespace Ostap::Polarization
  *  @date 2018-03-20 
@@ -246,6 +252,208 @@ Ostap::Math::Polarization::vectors
               ( -ax.T () - j * ay.T () ) * s_isq2 ) }} ;
 }
 // ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /// Minkowski product 
+  inline double _dot_ 
+  ( const double ax , const double ay , const double az , const double at , 
+    const double bx , const double by , const double bz , const double bt ) 
+  { return at * bt - ax * bx - ay * by - az * bz ; }
+  // ==========================================================================
+  /// "signed mass" as ROOT::Math::LorentzVector::M 
+  inline double _mass_ ( const double m2 ) 
+  { return 0 <= m2 ? std::sqrt ( m2 ) : -std::sqrt ( -m2 ) ; }
+  // ==========================================================================
+  /// determinant of 4x4 matrix (rows a,b,c,d) 
+  inline double _det4_ 
+  ( const double a0 , const double a1 , const double a2 , const double a3 , 
+    const double b0 , const double b1 , const double b2 , const double b3 , 
+    const double c0 , const double c1 , const double c2 , const double c3 , 
+    const double d0 , const double d1 , const double d2 , const double d3 ) 
+  {
+    const double s0 = a0 * b1 - a1 * b0 ;
+    const double s1 = a0 * b2 - a2 * b0 ;
+    const double s2 = a0 * b3 - a3 * b0 ;
+    const double s3 = a1 * b2 - a2 * b1 ;
+    const double s4 = a1 * b3 - a3 * b1 ;
+    const double s5 = a2 * b3 - a3 * b2 ;
+    //
+    const double t0 = c0 * d1 - c1 * d0 ;
+    const double t1 = c0 * d2 - c2 * d0 ;
+    const double t2 = c0 * d3 - c3 * d0 ;
+    const double t3 = c1 * d2 - c2 * d1 ;
+    const double t4 = c1 * d3 - c3 * d1 ;
+    const double t5 = c2 * d3 - c3 * d2 ;
+    //
+    return s0 * t5 - s1 * t4 + s2 * t3 + s3 * t2 - s4 * t1 + s5 * t0 ;
+  }
+  // ==========================================================================
+  /** @struct Beams 
+   *  invariants of the beams: A = beam1 + beam2 , B = beam1 - beam2 
+   */
+  struct Beams 
+  {
+    double ax , ay , az , at ;
+    double bx , by , bz , bt ;
+    double AA , AB , BB ;
+  } ;
+  // ==========================================================================
+  /** the angles of the particle in the polarization frame, 
+   *  expressed via the invariant products (no frame axes are constructed)
+   *  - \f$ X, Z \f$ are the linear combinations of 
+   *    \f$ A_T \f$ and \f$ B_T \f$  (the beam vectors transverse to \f$ P \f$)
+   *  - \f$ Y \cdot p \f$ is reduced to \f$ \epsilon(p,P,A,B) \f$ 
+   *  @see Ostap::Math::Polarization::frame 
+   *  @return false for invalid kinematics
+   */
+  inline bool _angles_ 
+  ( const Ostap::Math::Polarization::Frames f       , 
+    const bool                              madison , 
+    const Beams&                            beams   , 
+    const double px , const double py , const double pz , const double pe , 
+    const double Px , const double Py , const double Pz , const double Pe , 
+    double& cos_theta , 
+    double& phi       ) 
+  {
+    const Beams& b = beams ;
+    //
+    const double M2 = _dot_ ( Px , Py , Pz , Pe , Px , Py , Pz , Pe ) ;
+    if ( M2 <= 0 ) { return false ; }                               // RETURN 
+    //
+    const double AP = _dot_ ( b.ax , b.ay , b.az , b.at , Px , Py , Pz , Pe ) ;
+    const double BP = _dot_ ( b.bx , b.by , b.bz , b.bt , Px , Py , Pz , Pe ) ;
+    const double pP = _dot_ ( px   , py   , pz   , pe   , Px , Py , Pz , Pe ) ;
+    const double pA = _dot_ ( px   , py   , pz   , pe   , b.ax , b.ay , b.az , b.at ) ;
+    const double pB = _dot_ ( px   , py   , pz   , pe   , b.bx , b.by , b.bz , b.bt ) ;
+    const double pp = _dot_ ( px   , py   , pz   , pe   , px , py , pz , pe ) ;
+    //
+    // products of the transverse beam vectors 
+    const double iM2  = 1 / M2 ;
+    const double atat = b.AA - AP * AP * iM2 ;
+    const double atbt = b.AB - AP * BP * iM2 ;
+    const double btbt = b.BB - BP * BP * iM2 ;
+    const double pat  = pA   - AP * pP * iM2 ;
+    const double pbt  = pB   - BP * pP * iM2 ;
+    //
+    double az = 0 ;
+    double bz = 0 ;
+    switch ( f ) 
+    {
+    case Ostap::Math::Polarization::Frames::GottfriedJackson :
+      az = -1 / _mass_ ( atat + 2 * atbt + btbt ) ; bz =  az ; break ;
+    case Ostap::Math::Polarization::Frames::Target           :
+      az =  1 / _mass_ ( atat - 2 * atbt + btbt ) ; bz = -az ; break ;
+    case Ostap::Math::Polarization::Frames::CollinsSoper     :
+      {
+        const double c1 = 1 / _mass_ ( atat - 2 * atbt + btbt ) ;
+        const double c2 = 1 / _mass_ ( atat + 2 * atbt + btbt ) ;
+        const double a1 = c1 - c2 ;
+        const double a2 = c1 + c2 ;
+        const double d  = 1 / _mass_ ( a1 * a1 * atat - 2 * a1 * a2 * atbt + a2 * a2 * btbt ) ;
+        az = -a1 * d ;
+        bz =  a2 * d ;
+        break ;
+      }
+    case Ostap::Math::Polarization::Frames::Recoil           : 
+    default : 
+      az = 1 / _mass_ ( atat ) ; bz = 0 ;
+    }
+    //
+    const double ax  = -az * atbt - bz * btbt ;
+    const double bx  =  az * atat + bz * atbt ;
+    const double x2  = ax * ax * atat + 2 * ax * bx * atbt + bx * bx * btbt ;
+    const double det = az * bx - ax * bz ;
+    const double sx  = ( madison ? 1 : -1 ) * ( 0 < det ? 1 : -1 ) / std::sqrt ( std::abs ( x2 ) ) ;
+    //
+    const double P2  = pP * pP * iM2 - pp ;
+    if ( P2 <= 0 || !std::isfinite ( sx ) || !std::isfinite ( az ) ) { return false ; } // RETURN 
+    const double irm = -1 / std::sqrt ( P2 ) ;
+    //
+    const double Xp  = sx * ( ax * pat + bx * pbt ) ;
+    const double Zp  = az * pat + bz * pbt ;
+    // epsilon ( p , P , A , B ) for the lowered components 
+    const double eps = -_det4_ ( px   , py   , pz   , pe   , 
+                                 Px   , Py   , Pz   , Pe   , 
+                                 b.ax , b.ay , b.az , b.at , 
+                                 b.bx , b.by , b.bz , b.bt ) ;
+    const double Yp  = -sx * ( ax * bz - bx * az ) * eps / std::sqrt ( M2 ) ;
+    //
+    cos_theta = Zp * irm ;
+    phi       = std::atan2 ( Yp * irm , Xp * irm ) ;
+    //
+    return true ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+/*  get the angles (cos theta, phi) for the arrays of candidates 
+ *  (structure-of-arrays), e.g. for the columns of the tree.
+ *  @return number of valid candidates 
+ */
+// ============================================================================
+std::size_t Ostap::Math::Polarization::angles 
+( const Ostap::Math::Polarization::Frames               f         , 
+  const std::size_t                                     n         , 
+  const double*                                         px        , 
+  const double*                                         py        , 
+  const double*                                         pz        , 
+  const double*                                         pe        , 
+  const double*                                         mx        , 
+  const double*                                         my        , 
+  const double*                                         mz        , 
+  const double*                                         me        , 
+  const Ostap::LorentzVector&                           beam1     , 
+  const Ostap::LorentzVector&                           beam2     , 
+  double*                                               cos_theta , 
+  double*                                               phi       , 
+  const Ostap::Math::Polarization::UseMadisonConvention madison   , 
+  const unsigned int                                    nthreads  ) 
+{
+  if ( 0 == n ) { return 0 ; }
+  //
+  Beams b ;
+  b.ax = beam1.Px () + beam2.Px () ; b.bx = beam1.Px () - beam2.Px () ;
+  b.ay = beam1.Py () + beam2.Py () ; b.by = beam1.Py () - beam2.Py () ;
+  b.az = beam1.Pz () + beam2.Pz () ; b.bz = beam1.Pz () - beam2.Pz () ;
+  b.at = beam1.E  () + beam2.E  () ; b.bt = beam1.E  () - beam2.E  () ;
+  b.AA = _dot_ ( b.ax , b.ay , b.az , b.at , b.ax , b.ay , b.az , b.at ) ;
+  b.AB = _dot_ ( b.ax , b.ay , b.az , b.at , b.bx , b.by , b.bz , b.bt ) ;
+  b.BB = _dot_ ( b.bx , b.by , b.bz , b.bt , b.bx , b.by , b.bz , b.bt ) ;
+  //
+  const bool mc = madison ;
+  auto block = [&] ( const std::size_t first , const std::size_t last ) -> std::size_t 
+    {
+      std::size_t good = 0 ;
+      for ( std::size_t i = first ; i < last ; ++i ) 
+      {
+        if ( _angles_ ( f , mc , b , 
+                        px [ i ] , py [ i ] , pz [ i ] , pe [ i ] , 
+                        mx [ i ] , my [ i ] , mz [ i ] , me [ i ] , 
+                        cos_theta [ i ] , phi [ i ] ) ) { ++good ; }
+        else { cos_theta [ i ] = s_INVALID ; phi [ i ] = s_INVALID ; }
+      }
+      return good ;
+    } ;
+  //
+  const std::size_t  bsize = 16384 ;
+  const std::size_t  nb    = ( n + bsize - 1 ) / bsize ;
+  const unsigned int nt    = std::min<std::size_t> 
+    ( nb , 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ;
+  if ( nt <= 1 ) { return block ( 0 , n ) ; }                      // RETURN
+  //
+  std::atomic<std::size_t> next { 0 } ;
+  std::atomic<std::size_t> good { 0 } ;
+  Ostap::Utils::WorkerPool pool ( nt ) ;
+  pool.run ( [&] ( const unsigned int /* index */ )
+    {
+      for ( std::size_t k = next++ ; k < nb ; k = next++ )
+      { good += block ( k * bsize , std::min ( n , ( k + 1 ) * bsize ) ) ; }
+    } ) ;
+  //
+  return good ;
+}
+// ============================================================================
 
 
 // ============================================================================
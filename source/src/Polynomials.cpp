@@ -23,6 +23,7 @@
 // Local 
 // ============================================================================
 #include "Exception.h"
+#include "local_tables.h"
 // ============================================================================
 /** @file 
  *  Implementation file for classes from file Ostap/Polynomials.h
@@ -352,25 +353,7 @@ double Ostap::Math::Legendre::root  ( const unsigned short i ) const
 // get the roots of the Legendre polynomial
 // ============================================================================
 const std::vector<double>& Ostap::Math::Legendre::roots () const 
-{
-  typedef std::map<unsigned int, std::vector<double> >  Roots ;
-  static Roots s_rootmap {}  ;
-  //
-  Roots::const_iterator i = s_rootmap.find ( m_N ) ;
-  if (  s_rootmap.end() != i ) { return i->second ; }   //  RETURN
-  //
-  // calculate and insert the entry into the map
-  std::vector<double> rs ( m_N , 0 ) ;
-  static const unsigned short s_maxiter = 200 ;
-  for ( unsigned int i = 0 ; 2 * i  < m_N ; ++i ) 
-  {
-    const double ri    = calculate_root ( i ) ;
-    rs [           i ] =   ri ;
-    rs [ m_N - 1 - i ] = - ri ;
-  }
-  //
-  return s_rootmap.insert ( Roots::value_type ( m_N , rs ) ).first->second ;
-}
+{ return Ostap::Math::Tables::legendre_roots ( m_N ) ; }
 // ============================================================================
 /*  update  the Legendre expansion by addition of one "event" with 
  *  the given weight
@@ -767,6 +750,24 @@ double Ostap::Math::Polynomial::evaluate ( const double x ) const
   return clenshaw_polynom ( m_pars , tx ) ;              // RETURN 
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Polynomial::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  if ( zero () ) { std::fill ( result , result + n , 0.0 ) ; return ; }
+  //
+  // 1) transform arguments:
+  for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = t ( x [ i ] ) ; }
+  // 2) use Clenshaw's algorithm (in place) 
+  Ostap::Math::Clenshaw::monomial_sum ( m_pars.rbegin() , m_pars.rend() , n , result , result ) ;
+  // 3) outside the range 
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  { if ( x [ i ] < m_xmin || x [ i ] > m_xmax ) { result [ i ] = 0 ; } }
+}
+// ============================================================================
 double Ostap::Math::Polynomial::integral   
 ( const double low  , 
   const double high ) const 
@@ -1038,6 +1039,24 @@ double Ostap::Math::ChebyshevSum::evaluate ( const double x ) const
   return Ostap::Math::Clenshaw::chebyshev_sum ( m_pars.begin() , m_pars.end()  , tx ) ;        
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::ChebyshevSum::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  if ( zero () ) { std::fill ( result , result + n , 0.0 ) ; return ; }
+  //
+  // 1) transform arguments:
+  for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = t ( x [ i ] ) ; }
+  // 2) use Clenshaw's algorithm (in place) 
+  Ostap::Math::Clenshaw::chebyshev_sum ( m_pars.begin() , m_pars.end() , n , result , result ) ;
+  // 3) outside the range 
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  { if ( x [ i ] < m_xmin || x [ i ] > m_xmax ) { result [ i ] = 0 ; } }
+}
+// ============================================================================
 // get the integral between xmin and xmax
 // ============================================================================
 double Ostap::Math::ChebyshevSum::integral   () const 
@@ -1368,6 +1387,24 @@ double Ostap::Math::LegendreSum::evaluate ( const double x ) const
   return Ostap::Math::Clenshaw::legendre_sum ( m_pars.begin() , m_pars.end()  , tx ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::LegendreSum::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  if ( zero () ) { std::fill ( result , result + n , 0.0 ) ; return ; }
+  //
+  // 1) transform arguments:
+  for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = t ( x [ i ] ) ; }
+  // 2) use Clenshaw's algorithm (in place) 
+  Ostap::Math::Clenshaw::legendre_sum ( m_pars.begin() , m_pars.end() , n , result , result ) ;
+  // 3) outside the range 
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  { if ( x [ i ] < m_xmin || x [ i ] > m_xmax ) { result [ i ] = 0 ; } }
+}
+// ============================================================================
 // get the integral between xmin and xmax
 // ============================================================================
 double Ostap::Math::LegendreSum::integral   () const 
@@ -1668,6 +1705,19 @@ double Ostap::Math::HermiteSum:: evaluate  ( const double x ) const
   return Ostap::Math::Clenshaw::hermite_sum ( m_pars.begin() , m_pars.end() , tx ) ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::HermiteSum::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  // 1) transform arguments:
+  for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = t ( x [ i ] ) ; }
+  // 2) use Clenshaw's algorithm (in place) 
+  Ostap::Math::Clenshaw::hermite_sum ( m_pars.begin() , m_pars.end() , n , result , result ) ;
+}
+// ============================================================================
 // get the derivative at point "x" 
 // ============================================================================
 double  Ostap::Math::HermiteSum::derivative ( const double x     ) const 
@@ -1959,6 +2009,64 @@ namespace
       Ostap::Math::POW          ( 2         , k ) ;
   }
   // ==========================================================================
+  // the cached transformation matrices, calculated once per degree 
+  // ==========================================================================
+  /// bernstein -> legendre 
+  const std::vector<double>& b2l_matrix ( const unsigned short n ) 
+  {
+    static Ostap::Math::Tables::OnceTable<std::vector<double> > s_table ;
+    return s_table.get ( n , [] ( const unsigned short d ) 
+                         { return Ostap::Math::Tables::make_matrix<double> ( d , b2l_mtrx ) ; } ) ;
+  }
+  // ==========================================================================
+  /// bernstein -> monomial (lower triangular)
+  const std::vector<long double>& b2m_matrix ( const unsigned short n ) 
+  {
+    static Ostap::Math::Tables::OnceTable<std::vector<long double> > s_table ;
+    return s_table.get ( n , [] ( const unsigned short d ) 
+                         { return Ostap::Math::Tables::make_matrix<long double> 
+                             ( d , [] ( const unsigned short j , 
+                                        const unsigned short k , 
+                                        const unsigned short m ) -> long double 
+                               { return k <= j ? b2m_mtrx ( j , k , m ) : 0 ; } ) ; } ) ;
+  }
+  // ==========================================================================
+  /// affine transformation of monomials: [0,1] -> [-1,1] (upper triangular)
+  const std::vector<double>& m2m_matrix_1 ( const unsigned short n ) 
+  {
+    static Ostap::Math::Tables::OnceTable<std::vector<double> > s_table ;
+    return s_table.get ( n , [] ( const unsigned short d ) 
+                         { return Ostap::Math::Tables::make_matrix<double> 
+                             ( d , [] ( const unsigned short j , 
+                                        const unsigned short k , 
+                                        const unsigned short /* n */ ) 
+                               { return m2m_mtrx_1 ( j , k ) ; } ) ; } ) ;
+  }
+  // ==========================================================================
+  /// monomial -> chebyshev (upper triangular)
+  const std::vector<double>& m2c_matrix ( const unsigned short n ) 
+  {
+    static Ostap::Math::Tables::OnceTable<std::vector<double> > s_table ;
+    return s_table.get ( n , [] ( const unsigned short d ) 
+                         { return Ostap::Math::Tables::make_matrix<double> 
+                             ( d , [] ( const unsigned short j , 
+                                        const unsigned short k , 
+                                        const unsigned short /* n */ ) 
+                               { return j <= k ? m2c_mtrx ( j , k ) : 0.0 ; } ) ; } ) ;
+  }
+  // ==========================================================================
+  /// legendre -> monomial (upper triangular)
+  const std::vector<double>& l2m_matrix ( const unsigned short n ) 
+  {
+    static Ostap::Math::Tables::OnceTable<std::vector<double> > s_table ;
+    return s_table.get ( n , [] ( const unsigned short d ) 
+                         { return Ostap::Math::Tables::make_matrix<double> 
+                             ( d , [] ( const unsigned short j , 
+                                        const unsigned short k , 
+                                        const unsigned short /* n */ ) 
+                               { return j <= k ? l2m_mtrx ( j , k ) : 0.0 ; } ) ; } ) ;
+  }
+  // ==========================================================================
 }
 // ============================================================================
 // constructor from bernstein polynomial
@@ -1969,17 +2077,8 @@ Ostap::Math::LegendreSum::LegendreSum
   , m_xmin ( poly.xmin() ) 
   , m_xmax ( poly.xmax() ) 
 {
-  const unsigned short np = npars  () ;
-  const unsigned short d  = degree () ;
-  for ( unsigned short i  = 0 ; i < np ; ++i ) 
-  { 
-    for ( unsigned short k = 0 ; k < np ; ++k ) 
-    { 
-      const double p = poly.par ( k ) ;
-      if ( s_zero ( p ) ) { continue ; }
-      m_pars[i] += b2l_mtrx ( i , k , d ) * p ; 
-    } 
-  }
+  Ostap::Math::Tables::apply_matrix 
+    ( npars () , b2l_matrix ( degree () ) , poly.pars ().begin () , m_pars.begin () ) ;
 }
 // ============================================================================
 // constructor from bernstein polynomial
@@ -1998,26 +2097,12 @@ Ostap::Math::Polynomial::Polynomial
   //
   // 1: tranfrom to 'regular' ponynomial basic 
   std::vector<double> _pars( m_pars.size() ) ;
-  for ( unsigned short i = 0 ; i < np ; ++i ) 
-  { 
-    for ( unsigned short k = 0 ; k <= i ; ++k )  // ATTENTION!!! 
-    { 
-      const double p = poly.par ( k ) ;
-      if ( s_zero ( p ) ) { continue ; }
-      _pars[i] += b2m_mtrx ( i , k , d ) * p ; 
-    } 
-  }
+  Ostap::Math::Tables::apply_matrix 
+    ( np , b2m_matrix   ( d ) , poly.pars ().begin () , _pars.begin  () ) ;
   //
   // 2: affine tranform to use [-1,-1] range 
-  for ( unsigned short i = 0 ; i < np ; ++i ) 
-  { 
-    for ( unsigned short k = i ; k < np ; ++k )  // ATTENTION!!!
-    { 
-      const double p = _pars[  k ] ;
-      if ( s_zero ( p ) ) { continue ; }
-      m_pars[i] += m2m_mtrx_1 ( i , k ) * p ; 
-    } 
-  }  
+  Ostap::Math::Tables::apply_matrix 
+    ( np , m2m_matrix_1 ( d ) , _pars.begin ()        , m_pars.begin () ) ;
 }
 // ============================================================================
 // constructor from legendre polynomial
@@ -2029,17 +2114,8 @@ Ostap::Math::Polynomial::Polynomial
   , m_xmax ( poly.xmax() ) 
 {
   //
-  const unsigned short np = npars  () ;
-  //
-  for ( unsigned short i = 0 ; i < np ; ++i ) 
-  { 
-    for ( unsigned short k = i ; k < np ; k+=2 )   // ATTENTION!!! 2!
-    { 
-      const double p = poly.par ( k ) ;
-      if ( s_zero ( p ) ) { continue ; }
-      m_pars[i] += l2m_mtrx ( i , k ) * p ; 
-    } 
-  }
+  Ostap::Math::Tables::apply_matrix 
+    ( npars () , l2m_matrix ( degree () ) , poly.pars ().begin () , m_pars.begin () ) ;
 }
 // =============================================================================
 //  constructor from Polinomial 
@@ -2050,16 +2126,8 @@ Ostap::Math::ChebyshevSum::ChebyshevSum
   , m_xmin ( poly.xmin() ) 
   , m_xmax ( poly.xmax() ) 
 {
-  const unsigned short np = npars  () ;
-  for ( unsigned short i = 0 ; i < np ; ++i ) 
-  { 
-    for ( unsigned short k = i ; k < np  ; k+=2 ) // ATTENTION !!! 2!
-    { 
-      const double p = poly.par ( k ) ;
-      if ( s_zero ( p ) ) { continue ; }
-      m_pars[i] += m2c_mtrx ( i , k ) * p ; 
-    } 
-  }  
+  Ostap::Math::Tables::apply_matrix 
+    ( npars () , m2c_matrix ( degree () ) , poly.pars ().begin () , m_pars.begin () ) ;
 }
 // ============================================================================
 
@@ -0,0 +1,109 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+#include <iostream>
+#include <thread>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Progress.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Utils::Progress
+ *  @see Ostap::Utils::Progress
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// show the progress bar for parallel engines?
+  std::atomic<bool> s_enabled { false } ;
+  // ==========================================================================
+}
+// ============================================================================
+// constructor
+// ============================================================================
+Ostap::Utils::Progress::Progress
+( const unsigned long long total    ,
+  const unsigned int       nslots   ,
+  const unsigned short     width    ,
+  const std::string&       symbol   ,
+  const std::string&       blank    ,
+  const std::string&       left     ,
+  const std::string&       right    ,
+  const double             interval )
+  : m_slots    ( std::max ( 1u , nslots ) )
+  , m_total    ( total    )
+  , m_width    ( std::max ( width , (unsigned short) 1 ) )
+  , m_symbol   ( symbol   )
+  , m_blank    ( blank    )
+  , m_left     ( left     )
+  , m_right    ( right    )
+  , m_interval ( static_cast<long long> ( std::max ( 0.0 , interval ) * 1.e+9 ) )
+  , m_next     ( ticks () )
+{}
+// ============================================================================
+// destructor: finish the progress bar
+// ============================================================================
+Ostap::Utils::Progress::~Progress () { finish () ; }
+// ============================================================================
+// number of processed items (all slots)
+// ============================================================================
+unsigned long long Ostap::Utils::Progress::count () const
+{
+  unsigned long long result = 0 ;
+  for ( const auto& s : m_slots ) { result += s.value.load ( std::memory_order_relaxed ) ; }
+  return result ;
+}
+// ============================================================================
+// show the final bar (once)
+// ============================================================================
+void Ostap::Utils::Progress::finish ()
+{
+  if ( m_done.exchange ( true ) ) { return ; }                        // RETURN
+  // wait for the current rendering (if any)
+  while ( m_render.test_and_set ( std::memory_order_acquire ) ) { std::this_thread::yield () ; }
+  m_render.clear ( std::memory_order_release ) ;
+  render ( true ) ;
+}
+// ============================================================================
+// render the progress bar
+// ============================================================================
+void Ostap::Utils::Progress::render ( const bool last )
+{
+  // someone else is rendering now: skip it
+  if ( m_render.test_and_set ( std::memory_order_acquire ) ) { return ; } // RETURN
+  if ( !last && m_done.load () ) { m_render.clear ( std::memory_order_release ) ; return ; }
+  //
+  const unsigned long long n    = last ? std::max ( count () , m_total ) : count () ;
+  const double             frac = 0 < m_total ? std::min ( 1.0 , double ( n ) / m_total ) : 1.0 ;
+  const unsigned short     done = static_cast<unsigned short> ( frac * m_width ) ;
+  //
+  std::string show = "\r" + m_left ;
+  for ( unsigned short i = 0    ; i < done    ; ++i ) { show += m_symbol ; }
+  for ( unsigned short j = done ; j < m_width ; ++j ) { show += m_blank  ; }
+  show += m_right ;
+  show += " "     ;
+  std::cout << show << static_cast<int> ( 100 * frac ) << "%" ;
+  if ( last ) { std::cout << std::endl ; }
+  std::cout << std::flush ;
+  //
+  m_render.clear ( std::memory_order_release ) ;
+}
+// ============================================================================
+// show the progress bar for parallel engines (StatVar, HistoProject, ...)?
+// ============================================================================
+bool Ostap::Utils::Progress::enabled () { return s_enabled.load () ; }
+// ============================================================================
+// enable/disable the progress bar for parallel engines
+// ============================================================================
+bool Ostap::Utils::Progress::enable  ( const bool value )
+{ return s_enabled.exchange ( value ) ; }
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,434 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <memory>
+#include <limits>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TTree.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+// ============================================================================
+// RooFit
+// ============================================================================
+#include "RooAbsData.h"
+#include "RooAbsReal.h"
+#include "RooArgList.h"
+#include "RooArgSet.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Formula.h"
+#include "Ostap/FormulaVar.h"
+#include "Ostap/Notifier.h"
+#include "Ostap/ProjectPlan.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_math.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::ProjectPlan
+ *  @see Ostap::ProjectPlan
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2023-01-19
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// trim the expression
+  inline std::string trim ( const std::string& expression )
+  {
+    const std::string::size_type b = expression.find_first_not_of ( " \t\n" ) ;
+    if ( std::string::npos == b ) { return "" ; }
+    const std::string::size_type e = expression.find_last_not_of  ( " \t\n" ) ;
+    return expression.substr ( b , e + 1 - b ) ;
+  }
+  // ==========================================================================
+  /// get variable by name from RooArgSet
+  RooAbsReal* get_var ( const RooArgSet&   aset ,
+                        const std::string& name )
+  {
+    RooAbsArg* arg = aset.find ( name.c_str() ) ;
+    return 0 != arg ? dynamic_cast<RooAbsReal*> ( arg ) : nullptr ;
+  }
+  // ==========================================================================
+  /** @class Values
+   *  helper class for the lazy evaluation of the distinct expressions:
+   *  each expression is evaluated at most once per entry
+   */
+  template <class EVALUATOR>
+  class Values
+  {
+  public:
+    // ========================================================================
+    Values ( const std::size_t N , EVALUATOR evaluator )
+      : m_evaluator ( evaluator )
+      , m_values    ( N , 0.0 )
+      , m_stamps    ( N , std::numeric_limits<unsigned long>::max () )
+    {}
+    // ========================================================================
+    /// get the value of the i-th expression for the given entry
+    inline double operator() ( const std::size_t   index ,
+                               const unsigned long entry )
+    {
+      if ( entry != m_stamps [ index ] )
+      {
+        m_values [ index ] = m_evaluator ( index ) ;
+        m_stamps [ index ] = entry ;
+      }
+      return m_values [ index ] ;
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the actual evaluator
+    EVALUATOR                  m_evaluator ; // the actual evaluator
+    /// cached values
+    std::vector<double>        m_values    ; // cached values
+    /// entry-stamps for the cached values
+    std::vector<unsigned long> m_stamps    ; // entry-stamps
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  template <class EVALUATOR>
+  inline Values<EVALUATOR>
+  make_values ( const std::size_t N , EVALUATOR evaluator )
+  { return Values<EVALUATOR> ( N , evaluator ) ; }
+  // ==========================================================================
+  /// fill the histogram
+  inline void fill
+  ( const Ostap::ProjectPlan::Item& item ,
+    const double                    x    ,
+    const double                    y    ,
+    const double                    z    ,
+    const double                    w    )
+  {
+    switch ( item.dim )
+    {
+    case 3  : static_cast<TH3*> ( item.histo ) -> Fill ( x , y , z , w ) ; break ;
+    case 2  : static_cast<TH2*> ( item.histo ) -> Fill ( x , y     , w ) ; break ;
+    default : item.histo                       -> Fill ( x         , w ) ; break ;
+    }
+  }
+  // ==========================================================================
+  /// is the point inside the histogram range?
+  inline bool in_range
+  ( const Ostap::ProjectPlan::Item& item ,
+    const double                    x    ,
+    const double                    y    ,
+    const double                    z    )
+  {
+    const TAxis* xa = item.histo->GetXaxis () ;
+    if ( xa->GetXmax () <= x || x < xa->GetXmin () ) { return false ; }
+    if ( 2 <= item.dim )
+    {
+      const TAxis* ya = item.histo->GetYaxis () ;
+      if ( ya->GetXmax () <= y || y < ya->GetXmin () ) { return false ; }
+    }
+    if ( 3 <= item.dim )
+    {
+      const TAxis* za = item.histo->GetZaxis () ;
+      if ( za->GetXmax () <= z || z < za->GetXmin () ) { return false ; }
+    }
+    return true ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor with the common selection
+// ============================================================================
+Ostap::ProjectPlan::ProjectPlan ( const std::string& selection )
+  : m_selection   ( trim ( selection ) )
+  , m_cut         ( -1 )
+  , m_expressions ()
+  , m_items       ()
+{
+  if ( !m_selection.empty() ) { m_cut = index ( m_selection ) ; }
+}
+// ============================================================================
+// register the expression and get its index
+// ============================================================================
+std::size_t Ostap::ProjectPlan::index ( const std::string& expression )
+{
+  const std::string e = trim ( expression ) ;
+  for ( std::size_t i = 0 ; i < m_expressions.size () ; ++i )
+  { if ( e == m_expressions [ i ] ) { return i ; } }
+  m_expressions.push_back ( e ) ;
+  return m_expressions.size () - 1 ;
+}
+// ============================================================================
+/*  register the 1D-histogram
+ *  @param histo      (UPDATE) the histogram
+ *  @param expression (INPUT)  the expression
+ *  @param selection  (INPUT)  the selection/weight for this histogram
+ *  @return the number of registered histograms
+ */
+// ============================================================================
+std::size_t Ostap::ProjectPlan::add
+( TH1*               histo      ,
+  const std::string& expression ,
+  const std::string& selection  )
+{
+  Ostap::Assert ( nullptr != histo && 1 == histo->GetDimension () ,
+                  "Invalid 1D-histogram"        ,
+                  "Ostap::ProjectPlan::add"     ) ;
+  Item item {} ;
+  item.histo     = histo ;
+  item.dim       = 1     ;
+  item.axes [0]  = index ( expression ) ;
+  item.selection = trim ( selection ).empty () ? -1 : long ( index ( selection ) ) ;
+  m_items.push_back ( item ) ;
+  return m_items.size () ;
+}
+// ============================================================================
+/*  register the 2D-histogram
+ *  @param histo       (UPDATE) the histogram
+ *  @param xexpression (INPUT)  the expression for x-axis
+ *  @param yexpression (INPUT)  the expression for y-axis
+ *  @param selection   (INPUT)  the selection/weight for this histogram
+ *  @return the number of registered histograms
+ */
+// ============================================================================
+std::size_t Ostap::ProjectPlan::add
+( TH2*               histo       ,
+  const std::string& xexpression ,
+  const std::string& yexpression ,
+  const std::string& selection   )
+{
+  Ostap::Assert ( nullptr != histo && 2 == histo->GetDimension () ,
+                  "Invalid 2D-histogram"        ,
+                  "Ostap::ProjectPlan::add"     ) ;
+  Item item {} ;
+  item.histo     = histo ;
+  item.dim       = 2     ;
+  item.axes [0]  = index ( xexpression ) ;
+  item.axes [1]  = index ( yexpression ) ;
+  item.selection = trim ( selection ).empty () ? -1 : long ( index ( selection ) ) ;
+  m_items.push_back ( item ) ;
+  return m_items.size () ;
+}
+// ============================================================================
+/*  register the 3D-histogram
+ *  @param histo       (UPDATE) the histogram
+ *  @param xexpression (INPUT)  the expression for x-axis
+ *  @param yexpression (INPUT)  the expression for y-axis
+ *  @param zexpression (INPUT)  the expression for z-axis
+ *  @param selection   (INPUT)  the selection/weight for this histogram
+ *  @return the number of registered histograms
+ */
+// ============================================================================
+std::size_t Ostap::ProjectPlan::add
+( TH3*               histo       ,
+  const std::string& xexpression ,
+  const std::string& yexpression ,
+  const std::string& zexpression ,
+  const std::string& selection   )
+{
+  Ostap::Assert ( nullptr != histo && 3 == histo->GetDimension () ,
+                  "Invalid 3D-histogram"        ,
+                  "Ostap::ProjectPlan::add"     ) ;
+  Item item {} ;
+  item.histo     = histo ;
+  item.dim       = 3     ;
+  item.axes [0]  = index ( xexpression ) ;
+  item.axes [1]  = index ( yexpression ) ;
+  item.axes [2]  = index ( zexpression ) ;
+  item.selection = trim ( selection ).empty () ? -1 : long ( index ( selection ) ) ;
+  m_items.push_back ( item ) ;
+  return m_items.size () ;
+}
+// ============================================================================
+// reset all registered histograms
+// ============================================================================
+void Ostap::ProjectPlan::reset ()
+{ for ( const Item& item : m_items ) { if ( item.histo ) { item.histo->Reset () ; } } }
+// ============================================================================
+/*  fill all registered histograms in a single loop over the tree
+ *  @param tree  (INPUT) the tree/chain
+ *  @param first (INPUT) the first entry to process
+ *  @param last  (INPUT) the last entry to process (not including!)
+ *  @return status code
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::ProjectPlan::project
+( TTree*              tree  ,
+  const unsigned long first ,
+  const unsigned long last  )
+{
+  //
+  for ( const Item& item : m_items )
+  { if ( nullptr == item.histo ) { return Ostap::StatusCode ( 301 ) ; } }
+  reset () ;
+  if ( nullptr == tree ) { return Ostap::StatusCode ( 300 ) ; }
+  if ( m_items.empty() ) { return Ostap::StatusCode::SUCCESS ; }
+  //
+  const unsigned long nEntries =
+    std::min ( last , (unsigned long) tree->GetEntries() ) ;
+  if ( nEntries <= first  ) { return Ostap::StatusCode::RECOVERABLE ; }
+  //
+  // compile the distinct expressions (once!)
+  typedef std::unique_ptr<Ostap::Formula> UOF ;
+  std::vector<UOF> formulas ;
+  formulas.reserve ( m_expressions.size () ) ;
+  for ( std::size_t i = 0 ; i < m_expressions.size () ; ++i )
+  {
+    auto p = std::make_unique<Ostap::Formula> ( m_expressions [ i ] , tree ) ;
+    if ( !p || !p->ok () ) { return Ostap::StatusCode ( 303 + i ) ; } // RETURN
+    formulas.push_back ( std::move ( p ) ) ;
+  }
+  //
+  Ostap::Utils::Notifier notifier ( formulas.begin () , formulas.end () , tree ) ;
+  //
+  auto values = make_values
+    ( formulas.size () ,
+      [&formulas] ( const std::size_t i ) { return formulas [ i ]->evaluate () ; } ) ;
+  //
+  for ( unsigned long entry = first ; entry < nEntries ; ++entry )
+  {
+    //
+    long ievent = tree->GetEntryNumber ( entry ) ;
+    if ( 0 > ievent ) { break ; }                              // BREAK
+    //
+    ievent      = tree->LoadTree ( ievent ) ;
+    if ( 0 > ievent ) { break ; }                              // BREAK
+    //
+    // the common selection
+    const double cw = 0 <= m_cut ? values ( m_cut , entry ) : 1.0 ;
+    if ( !cw ) { continue ; }                                  // CONTINUE
+    //
+    for ( const Item& item : m_items )
+    {
+      const double sw = 0 <= item.selection ? values ( item.selection , entry ) : 1.0 ;
+      if ( !sw ) { continue ; }                                // CONTINUE
+      //
+      const double w = cw * sw ;
+      //
+      // evaluate the expressions (only for non-zero weights)
+      const double x =                  values ( item.axes [ 0 ] , entry )         ;
+      const double y = 2 <= item.dim ?  values ( item.axes [ 1 ] , entry ) : 0.0   ;
+      const double z = 3 <= item.dim ?  values ( item.axes [ 2 ] , entry ) : 0.0   ;
+      //
+      fill ( item , x , y , z , w ) ;
+    }
+  }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+/*  fill all registered histograms in a single loop over the data
+ *  @param data      (INPUT) the dataset
+ *  @param cut_range (INPUT) the cut-range
+ *  @param first     (INPUT) the first entry to process
+ *  @param last      (INPUT) the last entry to process (not including!)
+ *  @return status code
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::ProjectPlan::project
+( const RooAbsData*   data      ,
+  const std::string&  cut_range ,
+  const unsigned long first     ,
+  const unsigned long last      )
+{
+  //
+  for ( const Item& item : m_items )
+  { if ( nullptr == item.histo ) { return Ostap::StatusCode ( 301 ) ; } }
+  reset () ;
+  if ( nullptr == data ) { return Ostap::StatusCode ( 300 ) ; }
+  if ( m_items.empty() ) { return Ostap::StatusCode::SUCCESS ; }
+  //
+  const unsigned long nEntries =
+    std::min ( last , (unsigned long) data->numEntries() ) ;
+  if ( nEntries <= first  ) { return Ostap::StatusCode::RECOVERABLE ; }
+  //
+  const RooArgSet*  aset = data->get() ;
+  if ( nullptr == aset ) { return Ostap::StatusCode ( 300 ) ; }    // RETURN
+  //
+  RooArgList        alst ;
+  alst.add ( *aset ) ;
+  //
+  // convert the distinct expressions into variables (once!)
+  std::vector<const RooAbsReal*>                  vars     ( m_expressions.size () , nullptr ) ;
+  std::vector<std::unique_ptr<Ostap::FormulaVar>> formulas ;
+  for ( std::size_t i = 0 ; i < m_expressions.size () ; ++i )
+  {
+    const RooAbsReal* v = get_var ( *aset , m_expressions [ i ] ) ;
+    if ( nullptr == v )
+    {
+      auto p = std::make_unique<Ostap::FormulaVar> ( m_expressions [ i ] , alst , false ) ;
+      if ( !p->ok () ) { return Ostap::StatusCode ( 303 + i ) ; } // RETURN
+      v = p.get() ;
+      formulas.push_back ( std::move ( p ) ) ;
+    }
+    vars [ i ] = v ;
+  }
+  //
+  const char* cutrange = cut_range.empty() ?  nullptr : cut_range.c_str() ;
+  const bool  weighted = data->isWeighted() ;
+  //
+  auto values = make_values
+    ( vars.size () ,
+      [&vars] ( const std::size_t i ) { return vars [ i ]->getVal () ; } ) ;
+  //
+  for ( unsigned long entry = first ; entry < nEntries ; ++entry )
+  {
+    //
+    const RooArgSet* evars = data->get ( entry ) ;
+    if ( nullptr == evars ) { break ; }                            // BREAK
+    if ( cutrange && !evars->allInRange ( cutrange ) ) { continue ; } // CONTINUE
+    //
+    // data weight
+    const double dw = weighted  ? data -> weight () : 1.0 ;
+    if ( !dw ) { continue ; }                                      // CONTINUE
+    //
+    // the common selection
+    const double cw = 0 <= m_cut ? values ( m_cut , entry ) : 1.0 ;
+    if ( !cw ) { continue ; }                                      // CONTINUE
+    //
+    for ( const Item& item : m_items )
+    {
+      //
+      const double sw = cw * ( 0 <= item.selection ? values ( item.selection , entry ) : 1.0 ) ;
+      if ( !sw ) { continue ; }                                    // CONTINUE
+      //
+      // calculate the total weight
+      const double w = sw * dw ;
+      if ( !w  ) { continue ; }                                    // CONTINUE
+      //
+      const double x =                  values ( item.axes [ 0 ] , entry )         ;
+      const double y = 2 <= item.dim ?  values ( item.axes [ 1 ] , entry ) : 0.0   ;
+      const double z = 3 <= item.dim ?  values ( item.axes [ 2 ] , entry ) : 0.0   ;
+      //
+      // check the range
+      if ( !in_range ( item , x , y , z ) ) { continue ; }         // CONTINUE
+      //
+      // fill the histogram  (only for non-zero weights and in-range entries!)
+      fill ( item , x , y , z , w ) ;
+      //
+      if  ( weighted )
+      {
+        const double dwe = data -> weightError ( RooAbsData::SumW2 ) ;
+        const double we  = ( dwe ? dwe : dw ) * sw ;
+        if  ( !s_equal ( we , w ) )
+        {
+          const int    bin    = item.histo -> FindBin     ( x , y , z ) ;
+          const double binerr = item.histo -> GetBinError ( bin       ) ;
+          const double err2   = binerr * binerr - w * w + we * we  ;
+          item.histo -> SetBinError ( bin , std::sqrt ( err2 ) ) ;
+        }
+      }
+    }
+  }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -25,6 +25,26 @@
 // ============================================================================
 PyObject* Ostap::blob_to_bytes ( const Ostap::BLOB& blob ) 
 {
+  if ( blob.zipped () ) 
+  {
+    // uncompress directly into bytes object 
+#if defined (PY_MAJOR_VERSION) and PY_MAJOR_VERSION < 3
+    PyObject* result = PyString_FromStringAndSize ( NULL , blob.raw_size () ) ;
+    if ( nullptr == result ) { return NULL ; }
+    char*     data   = PyString_AsString ( result ) ;
+#else
+    PyObject* result = PyBytes_FromStringAndSize  ( NULL , blob.raw_size () ) ;
+    if ( nullptr == result ) { return NULL ; }
+    char*     data   = PyBytes_AsString  ( result ) ;
+#endif
+    if ( !blob.getBuffer ( blob.raw_size () , data ) ) 
+    {
+      Py_DECREF ( result ) ;
+      PyErr_SetString ( PyExc_ValueError , "Cannot uncompress the blob" ) ;
+      return NULL ;
+    }
+    return result ;
+  }
 #if defined (PY_MAJOR_VERSION) and PY_MAJOR_VERSION < 3
   return PyString_FromStringAndSize ( (const char*) blob.buffer () , blob.size () ) ;
 #else
@@ -67,9 +87,98 @@ PyObject* Ostap::blob_from_bytes ( Ostap::BLOB& blob , PyObject* bytes )
   return Py_True ;
 }
 
-// ==========================================================================
-
-
+// ============================================================================
+/*  fill the blob from any object that supports buffer protocol
+ *  (e.g. numpy array, bytes, bytearray, memoryview) without intermediate copies 
+ *  @see   Ostap::BLOB
+ *  @param blob     the blob to be updated 
+ *  @param obj      (INPUT) C-contiguous buffer object 
+ *  @param compress ROOT compression setting, e.g. 404 for LZ4 and 505 for ZSTD 
+ *  @return True if conversion successul
+ */
+// ============================================================================
+PyObject* Ostap::blob_from_buffer 
+( Ostap::BLOB& blob     , 
+  PyObject*    obj      , 
+  const int    compress ) 
+{
+  if ( nullptr == obj || !PyObject_CheckBuffer ( obj ) ) 
+  {
+    PyErr_SetString ( PyExc_TypeError , "Object does not support buffer protocol" ) ;
+    return NULL ;
+  }
+  //
+  Py_buffer view ;
+  if ( 0 != PyObject_GetBuffer ( obj , &view , PyBUF_C_CONTIGUOUS ) ) { return NULL ; }
+  //
+  blob.setBuffer ( view.len , view.buf , compress ) ;
+  PyBuffer_Release ( &view ) ;
+  // 
+  Py_INCREF ( Py_True );
+  //
+  return Py_True ;
+}
+// ============================================================================
+/*  extract (and uncompress) the content of the blob directly 
+ *  into writable buffer object, e.g. preallocated numpy array 
+ *  @see   Ostap::BLOB
+ *  @param blob the blob
+ *  @param obj  (UPDATE) writable C-contiguous buffer object of size blob.raw_size()
+ *  @return True if conversion successul
+ */
+// ============================================================================
+PyObject* Ostap::blob_to_buffer 
+( const Ostap::BLOB& blob , 
+  PyObject*          obj  ) 
+{
+  if ( nullptr == obj || !PyObject_CheckBuffer ( obj ) ) 
+  {
+    PyErr_SetString ( PyExc_TypeError , "Object does not support buffer protocol" ) ;
+    return NULL ;
+  }
+  //
+  Py_buffer view ;
+  if ( 0 != PyObject_GetBuffer ( obj , &view , PyBUF_C_CONTIGUOUS | PyBUF_WRITABLE ) ) { return NULL ; }
+  //
+  if ( static_cast<std::size_t> ( view.len ) != blob.raw_size () ) 
+  {
+    PyBuffer_Release ( &view ) ;
+    PyErr_SetString  ( PyExc_ValueError , "Mismatch in buffer and blob sizes" ) ;
+    return NULL ;
+  }
+  //
+  const bool ok = blob.getBuffer ( view.len , view.buf ) ;
+  PyBuffer_Release ( &view ) ;
+  if ( !ok ) 
+  {
+    PyErr_SetString ( PyExc_ValueError , "Cannot uncompress the blob" ) ;
+    return NULL ;
+  }
+  // 
+  Py_INCREF ( Py_True );
+  //
+  return Py_True ;
+}
+// ============================================================================
+/*  read-only memoryview for the content of uncompressed blob (no copy), 
+ *  for compressed blob the uncompressed bytes are returned 
+ *  @attention the view is valid only while the blob is alive 
+ *  @see   Ostap::BLOB
+ *  @param blob the blob
+ *  @return memoryview or bytes 
+ */
+// ============================================================================
+PyObject* Ostap::blob_to_memoryview ( const Ostap::BLOB& blob ) 
+{
+#if defined (PY_MAJOR_VERSION) and PY_MAJOR_VERSION < 3
+  return blob_to_bytes ( blob ) ;
+#else
+  if ( blob.zipped () ) { return blob_to_bytes ( blob ) ; }
+  return PyMemoryView_FromMemory 
+    ( const_cast<char*> ( static_cast<const char*> ( blob.buffer () ) ) , 
+      blob.size () , PyBUF_READ ) ;
+#endif
+}
 // ============================================================================
 //                                                                      The END 
 // ============================================================================
@@ -8,6 +8,7 @@
 // Ostap
 // ============================================================================
 #include "Ostap/PyCallable.h"
+#include "Ostap/Instrument.h"
 // ============================================================================
 // ROOT 
 // ============================================================================
@@ -48,12 +49,22 @@ Ostap::Functions::PyCallable::PyCallable
   Py_XINCREF ( m_callable ) ;
 }
 // ============================================================================
+// constructor from the compiled function (no Python, no GIL)
+// ============================================================================
+Ostap::Functions::PyCallable::PyCallable 
+( const Ostap::Functions::NativeFunction1& native ) 
+  : m_callable  ( nullptr      ) 
+  , m_arguments ( nullptr      )  
+  , m_native    ( native.raw() ) 
+{}
+// ============================================================================
 // copy constructor 
 // ============================================================================
 Ostap::Functions::PyCallable::PyCallable 
 ( const Ostap::Functions::PyCallable&  right ) 
   : m_callable  ( right.m_callable  ) 
-  , m_arguments ( PyTuple_New ( 1 ) )  
+  , m_arguments ( right.m_native ? nullptr : PyTuple_New ( 1 ) )  
+  , m_native    ( right.m_native    ) 
 {
   Py_XINCREF ( m_callable ) ;
 }
@@ -64,6 +75,7 @@ Ostap::Functions::PyCallable::PyCallable
 ( Ostap::Functions::PyCallable&&  right ) 
   : m_callable  ( right.m_callable  ) 
   , m_arguments ( right.m_arguments ) 
+  , m_native    ( right.m_native    ) 
 {
   right.m_callable  = nullptr ;
   right.m_arguments = nullptr ;
@@ -81,6 +93,10 @@ Ostap::Functions::PyCallable::~PyCallable()
 // ============================================================================
 double Ostap::Functions::PyCallable::evaluate ( const  double x ) const 
 {
+  // the compiled function: direct call, no Python
+  if  ( m_native ) { return m_native ( x ) ; }
+  //
+  OSTAP_PROBE ( "Ostap::Functions::PyCallable::evaluate" ) ;
   // 
   if  ( nullptr == m_callable || !PyCallable_Check( m_callable  ) ) 
   {
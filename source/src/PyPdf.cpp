@@ -8,21 +8,25 @@
 // STD&STL
 // ============================================================================
 #include <cstring>
+#include <vector>
 // ============================================================================
 // ROOT 
 // ============================================================================
 #include "RVersion.h"
 #include "TPython.h"
 // ============================================================================
+// ============================================================================
 // Ostap
 // ============================================================================
 #include "Ostap/PyPdf.h"
 #include "Ostap/PyVar.h"
 #include "Ostap/Iterator.h"
+#include "Ostap/Instrument.h"
 // ============================================================================
 // Local
 // ============================================================================
 #include "CallPython.h"
+#include "local_batch.h"
 // ============================================================================
 /** @file 
  *  Implementation file for class Ostap::Models::PyPdf 
@@ -40,6 +44,87 @@ namespace
   static char s_getAI   [] = "get_analytical_integral"  ;
   static char s_AI      [] = "analytical_integral"      ;
   // ==========================================================================
+  /// the maximal number of arguments to be kept on stack for vectorcall 
+  const std::size_t s_STACK = 8 ;
+  // ==========================================================================
+#if OSTAP_BATCH
+  // ==========================================================================
+  static char s_batch   [] = "evaluate_batch"           ;
+  static char s_release [] = "release"                  ;
+  // ==========================================================================
+  /** @class BatchViews
+   *  Helper class to expose the RooFit batch to python without copies:
+   *  tuple <code>( output , x1 , x2 , ... )</code> of <code>memoryview</code>s
+   *   - writable view for the output array 
+   *   - read-only views for the spans of all variables 
+   *  All views are released in destructor, therefore python 
+   *  is not allowed to keep the references to the data 
+   */
+  class BatchViews
+  {
+  public:
+    // ========================================================================
+    BatchViews 
+    ( double*                        output  , 
+      const std::size_t              nEvents , 
+      const Ostap::Utils::BatchData& data    , 
+      const RooListProxy&            vars    ) 
+    {
+      const std::size_t N = vars.size () ;
+      m_args = PyTuple_New ( N + 1 ) ;
+      if ( !m_args ) { return ; }
+      //
+      PyObject* out = PyMemoryView_FromMemory 
+        ( reinterpret_cast<char*> ( output ) , nEvents * sizeof ( double ) , PyBUF_WRITE ) ;
+      if ( !out ) { Py_DECREF ( m_args ) ; m_args = nullptr ; return ; }
+      PyTuple_SET_ITEM ( m_args , 0 , out ) ;
+      //
+      for ( std::size_t k = 0 ; k < N ; ++k ) 
+      {
+        const Ostap::Utils::BatchData::Span span = data.at ( &vars [ k ] ) ;
+        PyObject* view = PyMemoryView_FromMemory 
+          ( const_cast<char*> ( reinterpret_cast<const char*> ( span.data () ) ) , 
+            span.size () * sizeof ( double ) , PyBUF_READ ) ;
+        if ( !view ) { release () ; return ; }
+        PyTuple_SET_ITEM ( m_args , k + 1 , view ) ;
+      }
+    }
+    // ========================================================================
+    ~BatchViews () { release () ; }
+    // ========================================================================
+  public:
+    // ========================================================================
+    /// all arguments: ( output , x1 , x2 , ... ) 
+    PyObject* args () const { return m_args ; }
+    /// valid?
+    bool      ok   () const { return nullptr != m_args ; }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// release all views and the tuple 
+    void release ()
+    {
+      if ( !m_args ) { return ; }
+      const Py_ssize_t N = PyTuple_GET_SIZE ( m_args ) ;
+      for ( Py_ssize_t k = 0 ; k < N ; ++k ) 
+      {
+        PyObject* view = PyTuple_GET_ITEM ( m_args , k ) ;
+        if ( !view ) { continue ; }
+        PyObject* r = PyObject_CallMethod ( view , s_release , nullptr ) ;
+        if ( r ) { Py_DECREF ( r ) ; } else { PyErr_Clear () ; }
+      }
+      Py_DECREF ( m_args ) ;
+      m_args = nullptr ;
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    PyObject* m_args { nullptr } ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+#endif
+  // ==========================================================================
 }
 // ============================================================================
 #if defined(OSTAP_OLD_PYROOT) && OSTAP_OLD_PYROOT
@@ -405,6 +490,7 @@ Double_t Ostap::Models::PyPdf::analyticalIntegral
 ( Int_t       code      , 
   const char* rangeName ) const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PyPdf::analyticalIntegral" ) ;
   //
   m_intCode    = code      ;
   m_rangeName  = rangeName ;
@@ -440,6 +526,7 @@ Bool_t Ostap::Models::PyPdf::matchArgs ( const RooArgSet& refVars ) const
 // ============================================================================
 Double_t Ostap::Models::PyPdf::evaluate() const 
 { 
+  OSTAP_PROBE ( "Ostap::Models::PyPdf::evaluate" ) ;
   // ==========================================================================
 #if defined(OSTAP_OLD_PYROOT) && OSTAP_OLD_PYROOT
   // ==========================================================================
@@ -492,6 +579,67 @@ double Ostap::Models::PyPdf::variable ( const char* name  ) const
   return v->getVal() ;  
 }
 // ============================================================================
+// helper function to be redefined in python: batch evaluation 
+// ============================================================================
+bool Ostap::Models::PyPdf::evaluate_batch 
+( PyObject* /* output */ , 
+  PyObject* /* inputs */ ) const { return false ; }
+// ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function 
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT_FALLBACK ( Ostap::Models::PyPdf , RooAbsPdf )
+// ============================================================================
+bool Ostap::Models::PyPdf::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  // ==========================================================================
+#if defined(OSTAP_OLD_PYROOT) && OSTAP_OLD_PYROOT
+  // ==========================================================================
+  if ( !m_self || 1 != PyObject_HasAttrString ( m_self , s_batch ) ) 
+  { return false ; }
+  // ==========================================================================
+#endif 
+  // ==========================================================================
+  BatchViews views ( output , nEvents , data , m_varlist ) ;
+  Ostap::Assert ( views.ok ()                        , 
+                  "Can't create views for the batch" , 
+                  "PyPdf::computeBatch"              , 
+                  Ostap::StatusCode ( 810 )          ) ;
+  //
+  PyObject* args   = views.args () ;
+  PyObject* inputs = PyTuple_GetSlice ( args , 1 , PyTuple_GET_SIZE ( args ) ) ;
+  PyObject* out    = PyTuple_GET_ITEM ( args , 0 ) ;
+  // ==========================================================================
+#if defined(OSTAP_OLD_PYROOT) && OSTAP_OLD_PYROOT
+  // ==========================================================================
+  PyObject* r  = PyObject_CallMethod ( m_self , s_batch , const_cast<char*> ( "OO" ) , out , inputs ) ;
+  Py_XDECREF ( inputs ) ;
+  if ( !r ) 
+  {
+    PyErr_Print () ;
+    Ostap::throwException ( "Error in ``evaluate_batch''"   ,
+                            "PyPdf::computeBatch"           ,
+                            Ostap::StatusCode ( 811 )       ) ;
+  }
+  const bool done = PyObject_IsTrue ( r ) ;
+  Py_DECREF ( r ) ;
+  // ==========================================================================
+#else 
+  // ==========================================================================
+  const bool done = evaluate_batch ( out , inputs ) ;
+  Py_XDECREF ( inputs ) ;
+  // ==========================================================================
+#endif 
+  // ==========================================================================
+  return done ;
+}
+// ============================================================================
+#endif
+// ============================================================================
 
 
 // ============================================================================
@@ -537,9 +685,11 @@ Ostap::Models::PyPdf2::PyPdf2
   : RooAbsPdf  ( right , name     ) 
     //
   , m_function ( right.m_function ) 
+  , m_batch    ( right.m_batch    ) 
   , m_varlist  ( "!varlist" , this , right.m_varlist ) 
 {
   if ( m_function ) { Py_XINCREF ( m_function  ) ; }
+  if ( m_batch    ) { Py_XINCREF ( m_batch     ) ; }
   m_arguments = PyTuple_New ( m_varlist.getSize() ) ;
 }
 // ============================================================================
@@ -549,6 +699,23 @@ Ostap::Models::PyPdf2::~PyPdf2()
 {
   if ( m_function  ) { Py_DECREF ( m_function  ) ; m_function  = nullptr ; }
   if ( m_arguments ) { Py_DECREF ( m_arguments ) ; m_arguments = nullptr ; }
+  if ( m_batch     ) { Py_DECREF ( m_batch     ) ; m_batch     = nullptr ; }
+}
+// ============================================================================
+/*  set the batch callable 
+ *  @param batch <code>batch ( output , x1 , x2 , ... )</code> or nullptr/None 
+ */
+// ============================================================================
+void Ostap::Models::PyPdf2::setBatch ( PyObject* batch ) 
+{
+  if ( batch == Py_None ) { batch = nullptr ; }
+  Ostap::Assert ( !batch || PyCallable_Check ( batch ) , 
+                  "Batch function is not callable"     ,
+                  "PyPdf2::setBatch"                   ,
+                  Ostap::StatusCode ( 812 )            ) ;
+  Py_XINCREF ( batch   ) ;
+  Py_XDECREF ( m_batch ) ;
+  m_batch = batch ;
 }
 // ============================================================================
 Ostap::Models::PyPdf2* 
@@ -560,6 +727,7 @@ Ostap::Models::PyPdf2::clone ( const char* name ) const
 // ============================================================================
 Double_t Ostap::Models::PyPdf2::evaluate() const 
 {
+  OSTAP_PROBE ( "Ostap::Models::PyPdf2::evaluate" ) ;
   // 
   if  ( 0 == m_function || !PyCallable_Check( m_function ) ) 
   {
@@ -569,31 +737,85 @@ Double_t Ostap::Models::PyPdf2::evaluate() const
                             Ostap::StatusCode(500) )           ;
   }
   //
- Ostap:Assert ( PySequence_Size ( m_arguments ) == m_varlist.getSize() , 
-                "Invalid argument/varlist  size!" ,
-                "PyPdf2::evaluate"                 ,
-                Ostap::StatusCode(500) ) ;
+  const std::size_t N = m_varlist.size () ;
+  // ==========================================================================
+#if defined(PY_VERSION_HEX) && PY_VERSION_HEX >= 0x03090000
+  // ==========================================================================
+  // vectorcall: no argument tuple at all 
+  PyObject*               small [ s_STACK ] ;
+  std::vector<PyObject*>  large ;
+  PyObject** stack = small ;
+  if ( s_STACK < N ) { large.resize ( N ) ; stack = large.data () ; }
   //
-  Ostap::Utils::Iterator it ( m_varlist ) ;
-  unsigned short index = 0 ;
-  while ( RooAbsReal* v = it.static_next<RooAbsReal>() )
+  for ( std::size_t k = 0 ; k < N ; ++k ) 
   {
-    PyObject* pv =  PyFloat_FromDouble ( v->getVal()  ) ;
-    if ( 0 != PyTuple_SetItem ( m_arguments , index , pv ) ) 
+    const RooAbsReal* v = static_cast<const RooAbsReal*> ( &m_varlist [ k ] ) ;
+    stack [ k ] = PyFloat_FromDouble ( v->getVal () ) ;
+  }
+  //
+  PyObject* result = PyObject_Vectorcall ( m_function , stack , N , nullptr ) ;
+  for ( std::size_t k = 0 ; k < N ; ++k ) { Py_XDECREF ( stack [ k ] ) ; }
+  // ==========================================================================
+#else
+  // ==========================================================================
+  Ostap::Assert ( PySequence_Size ( m_arguments ) == Py_ssize_t ( N ) , 
+                  "Invalid argument/varlist  size!" ,
+                  "PyPdf2::evaluate"                 ,
+                  Ostap::StatusCode(500) ) ;
+  //
+  for ( std::size_t k = 0 ; k < N ; ++k ) 
+  {
+    const RooAbsReal* v  = static_cast<const RooAbsReal*> ( &m_varlist [ k ] ) ;
+    PyObject*         pv = PyFloat_FromDouble ( v->getVal () ) ;
+    if ( 0 != PyTuple_SetItem ( m_arguments , k , pv ) ) 
     {
       PyErr_Print () ;
       Ostap::throwException ( "Can't fill PyTuple"   ,
                               "PyPdf2::evaluate"     ,
                               Ostap::StatusCode(500) ) ;
     }
-    ++index ;
   }
   //
   PyObject* result = PyObject_CallObject ( m_function , m_arguments ) ;
-  //
+  // ==========================================================================
+#endif
+  // ==========================================================================
   return result_to_double ( result , "PyPdf2::evaluate" ) ;
 }
 // ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+// the batch evaluation of function (one python call per batch)
+// ============================================================================
+OSTAP_BATCH_IMPLEMENT_FALLBACK ( Ostap::Models::PyPdf2 , RooAbsPdf )
+// ============================================================================
+bool Ostap::Models::PyPdf2::computeBatch_
+( Ostap::Utils::BatchData& data    , 
+  double*                  output  , 
+  const std::size_t        nEvents ) const 
+{
+  if ( !m_batch ) { return false ; }
+  //
+  BatchViews views ( output , nEvents , data , m_varlist ) ;
+  Ostap::Assert ( views.ok ()                        , 
+                  "Can't create views for the batch" , 
+                  "PyPdf2::computeBatch"             , 
+                  Ostap::StatusCode ( 810 )          ) ;
+  //
+  PyObject* r = PyObject_CallObject ( m_batch , views.args () ) ;
+  if ( !r ) 
+  {
+    PyErr_Print () ;
+    Ostap::throwException ( "Error in batch function"   ,
+                            "PyPdf2::computeBatch"      ,
+                            Ostap::StatusCode ( 811 )   ) ;
+  }
+  Py_DECREF ( r ) ;
+  return true ;
+}
+// ============================================================================
+#endif
+// ============================================================================
 
 
 
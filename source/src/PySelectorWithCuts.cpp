@@ -24,6 +24,11 @@
 // ============================================================================
 namespace 
 {
+  // ==========================================================================
+  enum {
+    INVALID_BLOCK_FORMULA = 820 ,
+    INVALID_BLOCK_INDEX   = 821 ,
+  } ;
   // ==========================================================================
   const std::string s_whitespaces = " \t\n\r\f\v" ;
   inline std::string strip ( const std::string& s                          ,
@@ -108,6 +113,8 @@ void Ostap::SelectorWithCuts::reset_formula ( TTree* tree )
   { Ostap::Assert ( make_formula ( tree )           , 
                     "Invalid formula "              , 
                     "Ostap::SelectorWithCuts::Init" ) ; }
+  //
+  make_block ( tree ) ;
 }   
 // ============================================================================
 // notify 
@@ -115,6 +122,7 @@ void Ostap::SelectorWithCuts::reset_formula ( TTree* tree )
 Bool_t Ostap::SelectorWithCuts::Notify() 
 {
   if ( fMyFormula ) { fMyFormula->Notify() ; }
+  notify_block () ;
   return Ostap::Selector::Notify () ;
 }
 // ============================================================================
@@ -179,6 +187,13 @@ Bool_t Ostap::SelectorWithCuts::Process      ( Long64_t entry )
   // increment the event counter for good events 
   ++m_good  ;
   //
+  // block mode: accumulate the good entry 
+  if ( block_mode () ) 
+  {
+    increment_event () ;
+    return fill_block () ;
+  }
+  //
 #if ROOT_VERSION_CODE < ROOT_VERSION(6,22,0)
   //
   return Ostap::Selector::Process ( entry ) ;
@@ -195,7 +210,10 @@ Bool_t Ostap::SelectorWithCuts::Process      ( Long64_t entry )
 // terminate the slave 
 // ============================================================================
 void Ostap::SelectorWithCuts::SlaveTerminate () 
-{ return Ostap::Selector::SlaveTerminate() ; }
+{
+  flush_block () ;
+  return Ostap::Selector::SlaveTerminate() ; 
+}
 // ============================================================================
 // terminate
 // ============================================================================
@@ -236,6 +254,119 @@ void Ostap::SelectorWithCuts::set_cuts  ( const std::string& cuts )
   fMyCuts = strip ( cuts ) ;
 }
 // ============================================================================
+/*  switch on the block mode 
+ *  @param expressions the expressions to be evaluated for good entries 
+ *  @param size        the size of the block 
+ */
+// ============================================================================
+void Ostap::SelectorWithCuts::set_block 
+( const std::vector<std::string>& expressions , 
+  const unsigned long             size        ) 
+{
+  reset_block () ;
+  //
+  for ( const auto& e : expressions ) { m_block_exprs.push_back ( strip ( e ) ) ; }
+  m_block_size = size ;
+  //
+  TTree* tree = get_tree () ;
+  if ( tree ) { make_block ( tree ) ; }
+}
+// ============================================================================
+// switch off the block mode 
+// ============================================================================
+void Ostap::SelectorWithCuts::reset_block () 
+{
+  m_block_exprs   .clear () ;
+  m_block_formulas.clear () ;
+  m_block_data    .clear () ;
+  m_block_size = 0 ;
+  m_block_rows = 0 ;
+}
+// ============================================================================
+// create formulas for the block mode 
+// ============================================================================
+bool Ostap::SelectorWithCuts::make_block ( TTree* tree ) 
+{
+  m_block_formulas.clear () ;
+  if ( !block_mode () || nullptr == tree ) { return false ; }
+  //
+  const std::size_t N = m_block_exprs.size () ;
+  m_block_data.resize ( N ) ;
+  for ( std::size_t k = 0 ; k < N ; ++k ) 
+  {
+    std::unique_ptr<Ostap::Formula> formula { new Ostap::Formula ( m_block_exprs [ k ] , tree ) } ;
+    Ostap::Assert ( formula && formula->ok ()                              , 
+                    "Invalid block expression: '" + m_block_exprs [ k ] + "'" , 
+                    "Ostap::SelectorWithCuts::make_block"                  , 
+                    INVALID_BLOCK_FORMULA                                  ) ;
+    m_block_formulas.push_back ( std::move ( formula ) ) ;
+    m_block_data [ k ].reserve ( m_block_size ) ;
+  }
+  return true ;
+}
+// ============================================================================
+// notify the block formulas (e.g. new tree in the chain)
+// ============================================================================
+bool Ostap::SelectorWithCuts::notify_block () 
+{
+  for ( auto& f : m_block_formulas ) { if ( f ) { f->Notify () ; } }
+  return true ;
+}
+// ============================================================================
+// add the good entry to the block 
+// ============================================================================
+bool Ostap::SelectorWithCuts::fill_block () 
+{
+  const std::size_t N = m_block_formulas.size () ;
+  for ( std::size_t k = 0 ; k < N ; ++k ) 
+  { m_block_data [ k ].push_back ( m_block_formulas [ k ]->evaluate () ) ; }
+  ++m_block_rows ;
+  //
+  return m_block_rows < m_block_size ? true : flush_block () ;
+}
+// ============================================================================
+// process the accumulated rows (if any) and clear the block 
+// ============================================================================
+bool Ostap::SelectorWithCuts::flush_block () 
+{
+  if ( 0 == m_block_rows ) { return true ; }
+  //
+  const bool result = process_block () ;
+  //
+  for ( auto& d : m_block_data ) { d.clear () ; }
+  m_block_rows = 0 ;
+  //
+  return result ;
+}
+// ============================================================================
+// process the accumulated block: to be redefined 
+// ============================================================================
+bool Ostap::SelectorWithCuts::process_block () { return true ; }
+// ============================================================================
+// expression for the column 
+// ============================================================================
+const std::string& 
+Ostap::SelectorWithCuts::block_expression ( const unsigned short index ) const 
+{
+  Ostap::Assert ( index < m_block_exprs.size ()                     , 
+                  "Invalid column index"                            , 
+                  "Ostap::SelectorWithCuts::block_expression"       , 
+                  INVALID_BLOCK_INDEX                               ) ;
+  return m_block_exprs [ index ] ;
+}
+// ============================================================================
+// values of the column for the current block 
+// ============================================================================
+const std::vector<double>& 
+Ostap::SelectorWithCuts::block_column ( const unsigned short index ) const 
+{
+  Ostap::Assert ( index < m_block_data.size ()                      , 
+                  "Invalid column index"                            , 
+                  "Ostap::SelectorWithCuts::block_column"           , 
+                  INVALID_BLOCK_INDEX                               ) ;
+  return m_block_data [ index ] ;
+}
+// ============================================================================
 
 
 
@@ -0,0 +1,281 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/RandomStream.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for classes from Ostap/RandomStream.h
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// Philox4x32 constants
+  const std::uint32_t s_M0 = 0xD2511F53u ;
+  const std::uint32_t s_M1 = 0xCD9E8D57u ;
+  const std::uint32_t s_W0 = 0x9E3779B9u ;
+  const std::uint32_t s_W1 = 0xBB67AE85u ;
+  // ==========================================================================
+  /// 2^-53
+  const double s_2m53 = 1.0 / 9007199254740992.0 ;
+  /// 2*pi
+  const double s_2pi  = 2 * M_PI ;
+  // ==========================================================================
+  /// split 64-bit number into two 32-bit words
+  inline std::uint32_t lo32 ( const std::uint64_t v ) { return std::uint32_t ( v       ) ; }
+  inline std::uint32_t hi32 ( const std::uint64_t v ) { return std::uint32_t ( v >> 32 ) ; }
+  // ==========================================================================
+  /// two 32-bit words into the uniform number in (0,1)
+  inline double to_uniform ( const std::uint32_t a , const std::uint32_t b )
+  {
+    const std::uint64_t h = ( std::uint64_t ( a >> 5 ) << 26 ) | ( b >> 6 ) ;
+    return ( h + 0.5 ) * s_2m53 ;
+  }
+  // ==========================================================================
+  /// the threshold between inversion and the transformed rejection
+  const double s_poisson_threshold = 10 ;
+  // ==========================================================================
+}
+// ============================================================================
+// the Philox4x32-10 block function
+// ============================================================================
+Ostap::Math::Philox::Counter
+Ostap::Math::Philox::block
+( Ostap::Math::Philox::Counter c ,
+  Ostap::Math::Philox::Key     k )
+{
+  for ( unsigned int round = 0 ; round < 10 ; ++round )
+  {
+    const std::uint64_t p0 = std::uint64_t ( s_M0 ) * c [ 0 ] ;
+    const std::uint64_t p1 = std::uint64_t ( s_M1 ) * c [ 2 ] ;
+    c = Counter { { hi32 ( p1 ) ^ c [ 1 ] ^ k [ 0 ] , lo32 ( p1 ) ,
+                    hi32 ( p0 ) ^ c [ 3 ] ^ k [ 1 ] , lo32 ( p0 ) } } ;
+    k [ 0 ] += s_W0 ;
+    k [ 1 ] += s_W1 ;
+  }
+  return c ;
+}
+// ============================================================================
+// constructor
+// ============================================================================
+Ostap::Math::RandomStream::RandomStream
+( const std::uint64_t seed   ,
+  const std::uint64_t stream )
+  : m_seed   ( seed   )
+  , m_stream ( stream )
+  , m_key    { { lo32 ( seed ) , hi32 ( seed ) } }
+{}
+// ============================================================================
+// refill the buffer
+// ============================================================================
+void Ostap::Math::RandomStream::refill ()
+{
+  m_buffer = Philox::block
+    ( Philox::Counter { { lo32 ( m_counter ) , hi32 ( m_counter ) ,
+                          lo32 ( m_stream  ) , hi32 ( m_stream  ) } } , m_key ) ;
+  ++m_counter ;
+  m_index = 0 ;
+}
+// ============================================================================
+// set the position
+// ============================================================================
+void Ostap::Math::RandomStream::seek ( const std::uint64_t position )
+{
+  m_counter = position / 4 ;
+  m_index   = 4 ;
+  const unsigned int r = position % 4 ;
+  if ( r ) { refill () ; m_index = r ; }
+}
+// ============================================================================
+// next 32-bit word
+// ============================================================================
+std::uint32_t Ostap::Math::RandomStream::next32 ()
+{
+  if ( 4 <= m_index ) { refill () ; }
+  return m_buffer [ m_index++ ] ;
+}
+// ============================================================================
+// uniform in (0,1)
+// ============================================================================
+double Ostap::Math::RandomStream::uniform ()
+{
+  const std::uint32_t a = next32 () ;
+  const std::uint32_t b = next32 () ;
+  return to_uniform ( a , b ) ;
+}
+// ============================================================================
+// gaussian: Box-Muller
+// ============================================================================
+double Ostap::Math::RandomStream::gauss
+( const double mu    ,
+  const double sigma )
+{
+  const double u1 = uniform () ;
+  const double u2 = uniform () ;
+  return mu + sigma * std::sqrt ( -2 * std::log ( u1 ) ) * std::cos ( s_2pi * u2 ) ;
+}
+// ============================================================================
+// bifurcated gaussian
+// ============================================================================
+double Ostap::Math::RandomStream::bifur
+( const double mu     ,
+  const double sigma1 ,
+  const double sigma2 )
+{
+  Ostap::Assert ( sigma1 * sigma2 <= 0                             ,
+                  "Lower and upper errors must have opposite signs" ,
+                  "Ostap::Math::RandomStream::bifur"                ) ;
+  const double as1 = std::abs ( sigma1 ) ;
+  const double as2 = std::abs ( sigma2 ) ;
+  const double u   = uniform () ;
+  const double g   = std::abs ( gauss () ) ;
+  return u * ( as1 + as2 ) <= as1 ? mu + sigma1 * g : mu + sigma2 * g ;
+}
+// ============================================================================
+/* poisson
+ *  - inversion for small mean
+ *  - transformed rejection with squeeze (PTRS) for large mean
+ *  @see W. Hormann, "The transformed rejection method for generating
+ *       Poisson random variables", Insurance: Mathematics and Economics
+ *       12 (1993) 39-45
+ */
+// ============================================================================
+unsigned long Ostap::Math::RandomStream::poisson ( const double mu )
+{
+  if ( !( 0 < mu ) ) { return 0 ; }
+  //
+  if ( mu < s_poisson_threshold )
+  {
+    const double  u = uniform () ;
+    double        p = std::exp ( -mu ) ;
+    double        s = p ;
+    unsigned long k = 0 ;
+    while ( s < u && k < 1000 ) { ++k ; p *= mu / k ; s += p ; }
+    return k ;
+  }
+  //
+  const double slam     = std::sqrt ( mu ) ;
+  const double loglam   = std::log  ( mu ) ;
+  const double b        = 0.931 + 2.53 * slam ;
+  const double a        = -0.059 + 0.02483 * b ;
+  const double invalpha = 1.1239 + 1.1328 / ( b - 3.4 ) ;
+  const double vr       = 0.9277 - 3.6224 / ( b - 2 ) ;
+  //
+  while ( true )
+  {
+    const double U  = uniform () - 0.5 ;
+    const double V  = uniform () ;
+    const double us = 0.5 - std::abs ( U ) ;
+    const double k  = std::floor ( ( 2 * a / us + b ) * U + mu + 0.43 ) ;
+    if ( 0.07 <= us && V <= vr ) { return static_cast<unsigned long> ( k ) ; }
+    if ( k < 0 || ( us < 0.013 && V > us ) ) { continue ; }
+    if ( std::log ( V ) + std::log ( invalpha ) - std::log ( a / ( us * us ) + b ) <=
+         -mu + k * loglam - std::lgamma ( k + 1 ) )
+    { return static_cast<unsigned long> ( k ) ; }
+  }
+}
+// ============================================================================
+// array interface
+// ============================================================================
+void Ostap::Math::RandomStream::fill_uniform
+( const std::size_t n    ,
+  double*           out  ,
+  const double      low  ,
+  const double      high )
+{
+  const double d = high - low ;
+  std::size_t  i = 0 ;
+  // align to the block boundary
+  for ( ; i < n && 0 != ( m_index % 4 ) ; ++i ) { out [ i ] = low + d * uniform () ; }
+  // two numbers per block
+  for ( ; i + 1 < n ; i += 2 )
+  {
+    refill () ;
+    out [ i     ] = low + d * to_uniform ( m_buffer [ 0 ] , m_buffer [ 1 ] ) ;
+    out [ i + 1 ] = low + d * to_uniform ( m_buffer [ 2 ] , m_buffer [ 3 ] ) ;
+    m_index = 4 ;
+  }
+  for ( ; i < n ; ++i ) { out [ i ] = low + d * uniform () ; }
+}
+// ============================================================================
+void Ostap::Math::RandomStream::fill_gauss
+( const std::size_t n     ,
+  double*           out   ,
+  const double      mu    ,
+  const double      sigma )
+{
+  // Box-Muller: both numbers from the pair are used
+  std::size_t i = 0 ;
+  for ( ; i + 1 < n ; i += 2 )
+  {
+    const double u1 = uniform () ;
+    const double u2 = uniform () ;
+    const double r  = sigma * std::sqrt ( -2 * std::log ( u1 ) ) ;
+    out [ i     ] = mu + r * std::cos ( s_2pi * u2 ) ;
+    out [ i + 1 ] = mu + r * std::sin ( s_2pi * u2 ) ;
+  }
+  if ( i < n ) { out [ i ] = gauss ( mu , sigma ) ; }
+}
+// ============================================================================
+void Ostap::Math::RandomStream::fill_bifur
+( const std::size_t n      ,
+  double*           out    ,
+  const double      mu     ,
+  const double      sigma1 ,
+  const double      sigma2 )
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { out [ i ] = bifur ( mu , sigma1 , sigma2 ) ; } }
+// ============================================================================
+void Ostap::Math::RandomStream::fill_poisson
+( const std::size_t n   ,
+  double*           out ,
+  const double      mu  )
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { out [ i ] = poisson ( mu ) ; } }
+// ============================================================================
+// vector interface
+// ============================================================================
+std::vector<double> Ostap::Math::RandomStream::uniforms
+( const std::size_t n , const double low , const double high )
+{
+  std::vector<double> result ( n ) ;
+  fill_uniform ( n , result.data () , low , high ) ;
+  return result ;
+}
+// ============================================================================
+std::vector<double> Ostap::Math::RandomStream::gausses
+( const std::size_t n , const double mu , const double sigma )
+{
+  std::vector<double> result ( n ) ;
+  fill_gauss ( n , result.data () , mu , sigma ) ;
+  return result ;
+}
+// ============================================================================
+std::vector<double> Ostap::Math::RandomStream::bifurs
+( const std::size_t n , const double mu , const double sigma1 , const double sigma2 )
+{
+  std::vector<double> result ( n ) ;
+  fill_bifur ( n , result.data () , mu , sigma1 , sigma2 ) ;
+  return result ;
+}
+// ============================================================================
+std::vector<double> Ostap::Math::RandomStream::poissons
+( const std::size_t n , const double mu )
+{
+  std::vector<double> result ( n ) ;
+  fill_poisson ( n , result.data () , mu ) ;
+  return result ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,559 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+// ============================================================================
+// ROOT&RooFit
+// ============================================================================
+#include "TTree.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "RooArgList.h"
+#include "RooAbsData.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Formula.h"
+#include "Ostap/FormulaVar.h"
+#include "Ostap/Iterator.h"
+#include "Ostap/Notifier.h"
+#include "Ostap/Reweighter.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+// ============================================================================
+/** @file
+ *  Implementation file for classes Ostap::Utils::Reweighter
+ *  and Ostap::Functions::FuncReweight
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-03-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_TREE    = 790 ,
+    INVALID_HISTO   = 791 ,
+    INVALID_FORMULA = 792 ,
+    INVALID_DATA    = 793 ,
+  } ;
+  // ==========================================================================
+  /** fill the plots with the weight
+   *  @param plots  the plots
+   *  @param histos the histograms (one per plot)
+   *  @param values the values of the expressions
+   *  @param w      the weight
+   */
+  inline void _fill_
+  ( const std::vector<Ostap::Utils::Reweighter::Plot>& plots  ,
+    const std::vector<TH1*>&                           histos ,
+    const std::vector<double>&                         values ,
+    const double                                       w      )
+  {
+    const unsigned short NONE = Ostap::Utils::Reweighter::s_NONE ;
+    for ( std::size_t p = 0 ; p < plots.size () ; ++p )
+    {
+      const Ostap::Utils::Reweighter::Plot& plot = plots [ p ] ;
+      const double ww = NONE == plot.cuts ? w : w * values [ plot.cuts ] ;
+      if ( !ww ) { continue ; }                                // CONTINUE
+      //
+      TH1* histo = histos [ p ] ;
+      switch ( plot.dim )
+      {
+      case 3 :
+        static_cast<TH3*> ( histo ) -> Fill ( values [ plot.vars [ 0 ] ] ,
+                                              values [ plot.vars [ 1 ] ] ,
+                                              values [ plot.vars [ 2 ] ] , ww ) ; break ;
+      case 2 :
+        static_cast<TH2*> ( histo ) -> Fill ( values [ plot.vars [ 0 ] ] ,
+                                              values [ plot.vars [ 1 ] ] , ww ) ; break ;
+      default:
+        histo                       -> Fill ( values [ plot.vars [ 0 ] ] , ww ) ; break ;
+      }
+    }
+  }
+  // ==========================================================================
+  /** @class ReweightWorker
+   *  helper class to fill the plots with the current weights
+   *  for the chunk of TTree entries
+   *  - formulas are created for the (per-thread copy of) the tree
+   *  - the chunk is filled into histograms, defined by the chunk index
+   */
+  class ReweightWorker
+  {
+  public:
+    // ========================================================================
+    typedef std::unique_ptr<Ostap::Formula> UOF ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    ReweightWorker
+    ( TTree*                                 tree       ,
+      const Ostap::Utils::Reweighter&        reweighter ,
+      const std::vector<std::vector<TH1*> >& histos     )
+      : m_tree       ( tree        )
+      , m_reweighter ( &reweighter )
+      , m_histos     ( &histos     )
+      , m_values     ( reweighter.expressions().size () )
+    {
+      for ( const auto& e : reweighter.expressions () )
+      {
+        auto p = std::make_unique<Ostap::Formula> ( e , m_tree ) ;
+        Ostap::Assert ( p && p->ok()                    ,
+                        "Invalid formula:\"" + e + "\"" ,
+                        "Ostap::Utils::Reweighter"      , INVALID_FORMULA ) ;
+        m_formulas.push_back ( std::move ( p ) ) ;
+      }
+      m_notifier = std::make_unique<Ostap::Utils::Notifier>
+        ( m_formulas.begin() , m_formulas.end() , m_tree ) ;
+    }
+    // ========================================================================
+    /// fill the chunk into histograms
+    void operator() ( const Ostap::Utils::Chunk& chunk ,
+                      const std::size_t          index )
+    {
+      const std::vector<TH1*>& histos = ( *m_histos ) [ index ] ;
+      const std::size_t N = m_formulas.size() ;
+      for ( unsigned long entry = chunk.first ; entry < chunk.last ; ++entry )
+      {
+        //
+        long ievent = m_tree->GetEntryNumber ( entry ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        ievent      = m_tree->LoadTree ( ievent ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        for ( std::size_t i = 0 ; i < N ; ++i ) { m_values [ i ] = m_formulas [ i ]->evaluate () ; }
+        //
+        const double w = m_reweighter->weight ( m_values.data () ) ;
+        if ( !w ) { continue ; }                              // CONTINUE
+        //
+        _fill_ ( m_reweighter->plots () , histos , m_values , w ) ;
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the tree
+    TTree*                                  m_tree       { nullptr } ; // the tree
+    /// the reweighter
+    const Ostap::Utils::Reweighter*         m_reweighter { nullptr } ; // the reweighter
+    /// histograms (per chunk, per plot)
+    const std::vector<std::vector<TH1*> >*  m_histos     { nullptr } ; // histograms
+    /// formulas
+    std::vector<UOF>                        m_formulas   {} ; // formulas
+    /// the values of expressions
+    std::vector<double>                     m_values     {} ; // the values
+    /// notifier (must be destroyed before formulas!)
+    std::unique_ptr<Ostap::Utils::Notifier> m_notifier   {} ; // notifier
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /// make the formulas for the dataset
+  void _make_vars_
+  ( const RooAbsData*                                  data        ,
+    const std::vector<std::string>&                    expressions ,
+    std::vector<std::unique_ptr<Ostap::FormulaVar> >&  vars        )
+  {
+    vars.clear () ;
+    const RooArgSet* varset = data->get () ;
+    Ostap::Assert ( nullptr != varset              ,
+                    "Invalid RooArgSet"            ,
+                    "Ostap::Utils::Reweighter"     , INVALID_DATA ) ;
+    //
+    RooArgList varlst ;
+    Ostap::Utils::Iterator iter ( *varset ) ;
+    while ( RooAbsArg* a = iter.static_next<RooAbsArg>() ) { varlst.add ( *a ) ; }
+    //
+    for ( const auto& e : expressions )
+    {
+      auto p = Ostap::makeFormula ( e , varlst ) ;
+      Ostap::Assert ( p && p->ok ()                   ,
+                      "Invalid formula:\"" + e + "\"" ,
+                      "Ostap::Utils::Reweighter"      , INVALID_FORMULA ) ;
+      vars.push_back ( std::move ( p ) ) ;
+    }
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// get the index of the expression (add it, if needed)
+// ============================================================================
+unsigned short Ostap::Utils::Reweighter::index ( const std::string& expression )
+{
+  auto found = std::find ( m_expressions.begin () , m_expressions.end () , expression ) ;
+  if ( m_expressions.end () != found ) { return found - m_expressions.begin () ; }
+  Ostap::Assert ( m_expressions.size () + 1 < s_NONE   ,
+                  "Too many expressions"               ,
+                  "Ostap::Utils::Reweighter"           , INVALID_FORMULA ) ;
+  m_expressions.push_back ( expression ) ;
+  return m_expressions.size () - 1 ;
+}
+// ============================================================================
+// add 1D-factor
+// ============================================================================
+std::size_t Ostap::Utils::Reweighter::add
+( const TH1&         histo       ,
+  const std::string& xvar        ,
+  const Ostap::Math::HistoInterpolation::Type tx ,
+  const bool         edges       ,
+  const bool         extrapolate ,
+  const bool         density     )
+{ return add ( Ostap::Math::Histo1D ( histo , tx , edges , extrapolate , density ) , xvar ) ; }
+// ============================================================================
+// add 2D-factor
+// ============================================================================
+std::size_t Ostap::Utils::Reweighter::add
+( const TH2&         histo       ,
+  const std::string& xvar        ,
+  const std::string& yvar        ,
+  const Ostap::Math::HistoInterpolation::Type tx ,
+  const Ostap::Math::HistoInterpolation::Type ty ,
+  const bool         edges       ,
+  const bool         extrapolate ,
+  const bool         density     )
+{ return add ( Ostap::Math::Histo2D ( histo , tx , ty , edges , extrapolate , density ) , xvar , yvar ) ; }
+// ============================================================================
+// add 3D-factor
+// ============================================================================
+std::size_t Ostap::Utils::Reweighter::add
+( const TH3&         histo       ,
+  const std::string& xvar        ,
+  const std::string& yvar        ,
+  const std::string& zvar        ,
+  const Ostap::Math::HistoInterpolation::Type tx ,
+  const Ostap::Math::HistoInterpolation::Type ty ,
+  const Ostap::Math::HistoInterpolation::Type tz ,
+  const bool         edges       ,
+  const bool         extrapolate ,
+  const bool         density     )
+{ return add ( Ostap::Math::Histo3D ( histo , tx , ty , tz , edges , extrapolate , density ) , xvar , yvar , zvar ) ; }
+// ============================================================================
+// add 1D-factor
+// ============================================================================
+std::size_t Ostap::Utils::Reweighter::add
+( const Ostap::Math::Histo1D& histo ,
+  const std::string&          xvar  )
+{
+  const std::array<unsigned short,1> vars {{ index ( xvar ) }} ;
+  m_h1.emplace_back ( histo , vars ) ;
+  return nFactors () ;
+}
+// ============================================================================
+// add 2D-factor
+// ============================================================================
+std::size_t Ostap::Utils::Reweighter::add
+( const Ostap::Math::Histo2D& histo ,
+  const std::string&          xvar  ,
+  const std::string&          yvar  )
+{
+  const std::array<unsigned short,2> vars {{ index ( xvar ) , index ( yvar ) }} ;
+  m_h2.emplace_back ( histo , vars ) ;
+  return nFactors () ;
+}
+// ============================================================================
+// add 3D-factor
+// ============================================================================
+std::size_t Ostap::Utils::Reweighter::add
+( const Ostap::Math::Histo3D& histo ,
+  const std::string&          xvar  ,
+  const std::string&          yvar  ,
+  const std::string&          zvar  )
+{
+  const std::array<unsigned short,3> vars {{ index ( xvar ) , index ( yvar ) , index ( zvar ) }} ;
+  m_h3.emplace_back ( histo , vars ) ;
+  return nFactors () ;
+}
+// ============================================================================
+/*  add the plot to be filled with the current weight
+ *  @param histo     (INPUT) the histogram (not owned!)
+ *  @param xvar      (INPUT) the expression for x-axis
+ *  @param yvar      (INPUT) the expression for y-axis (2D and 3D histograms)
+ *  @param zvar      (INPUT) the expression for z-axis (3D histograms)
+ *  @param selection (INPUT) additional selection/weight
+ *  @return number of plots
+ */
+// ============================================================================
+std::size_t Ostap::Utils::Reweighter::addPlot
+( TH1*               histo     ,
+  const std::string& xvar      ,
+  const std::string& yvar      ,
+  const std::string& zvar      ,
+  const std::string& selection )
+{
+  Ostap::Assert ( nullptr != histo              ,
+                  "Invalid histogram"           ,
+                  "Ostap::Utils::Reweighter"    , INVALID_HISTO ) ;
+  //
+  Plot plot ;
+  plot.histo = histo ;
+  plot.dim   =
+    nullptr != dynamic_cast<TH3*> ( histo ) ? 3 :
+    nullptr != dynamic_cast<TH2*> ( histo ) ? 2 : 1 ;
+  //
+  Ostap::Assert ( ( 1 == plot.dim &&  yvar.empty () &&  zvar.empty () ) ||
+                  ( 2 == plot.dim && !yvar.empty () &&  zvar.empty () ) ||
+                  ( 3 == plot.dim && !yvar.empty () && !zvar.empty () ) ,
+                  "Mismatch in histogram dimension/expressions"         ,
+                  "Ostap::Utils::Reweighter"    , INVALID_HISTO ) ;
+  //
+  plot.vars [ 0 ] = index ( xvar ) ;
+  if ( 2 <= plot.dim ) { plot.vars [ 1 ] = index ( yvar ) ; }
+  if ( 3 <= plot.dim ) { plot.vars [ 2 ] = index ( zvar ) ; }
+  if ( !selection.empty () ) { plot.cuts = index ( selection ) ; }
+  //
+  m_plots.push_back ( plot ) ;
+  return m_plots.size () ;
+}
+// ============================================================================
+/*  get the weight for the values of the expressions
+ *  @param values (INPUT) the values of expressions
+ */
+// ============================================================================
+double Ostap::Utils::Reweighter::weight ( const double* values ) const
+{
+  double w = 1 ;
+  for ( const auto& h : m_h1 )
+  {
+    w *= h.first ( values [ h.second [ 0 ] ] ) ;
+    if ( !w ) { return 0 ; }
+  }
+  for ( const auto& h : m_h2 )
+  {
+    w *= h.first ( values [ h.second [ 0 ] ] ,
+                   values [ h.second [ 1 ] ] ) ;
+    if ( !w ) { return 0 ; }
+  }
+  for ( const auto& h : m_h3 )
+  {
+    w *= h.first ( values [ h.second [ 0 ] ] ,
+                   values [ h.second [ 1 ] ] ,
+                   values [ h.second [ 2 ] ] ) ;
+    if ( !w ) { return 0 ; }
+  }
+  return w ;
+}
+// ============================================================================
+/*  fill all plots with the current weights in one pass over the tree
+ *  @param tree     (INPUT) the tree
+ *  @param nthreads (INPUT) number of threads
+ *  @param first    (INPUT) the first event to process
+ *  @param last     (INPUT) the last event to process
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::Utils::Reweighter::project
+( TTree*              tree     ,
+  const unsigned int  nthreads ,
+  const unsigned long first    ,
+  const unsigned long last     ) const
+{
+  if ( nullptr == tree ) { return Ostap::StatusCode ( INVALID_TREE ) ; }
+  //
+  std::vector<TH1*> histos ;
+  for ( const Plot& p : m_plots ) { p.histo->Reset () ; histos.push_back ( p.histo ) ; }
+  if ( histos.empty () ) { return Ostap::StatusCode::SUCCESS ; }
+  //
+  const unsigned long nEntries =
+    std::min ( last , (unsigned long) tree->GetEntries() ) ;
+  if ( nEntries <= first  ) { return Ostap::StatusCode::RECOVERABLE ; }
+  //
+  // validate expressions
+  for ( const auto& e : m_expressions )
+  { if ( !Ostap::Formula ( e , tree ).ok() ) { return Ostap::StatusCode ( INVALID_FORMULA ) ; } }
+  //
+  const unsigned int nt = 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) )
+  {
+    const std::vector<std::vector<TH1*> > hs { histos } ;
+    ReweightWorker worker ( tree , *this , hs ) ;
+    worker ( Ostap::Utils::Chunk ( first , nEntries ) , 0 ) ;
+    return Ostap::StatusCode::SUCCESS ;                          // RETURN
+  }
+  //
+  // one chunk per thread to keep the memory footprint under control
+  const Ostap::Utils::Chunks chunks = Ostap::Utils::clusters ( tree , first , nEntries , nt ) ;
+  //
+  // private clones of the histograms, per chunk
+  std::vector<std::unique_ptr<TH1> > clones ;
+  std::vector<std::vector<TH1*> >    hs     ( chunks.size () ) ;
+  {
+    const bool add = TH1::AddDirectoryStatus () ;
+    TH1::AddDirectory ( false ) ;
+    for ( std::size_t i = 0 ; i < chunks.size() ; ++i )
+    {
+      for ( TH1* histo : histos )
+      {
+        TH1* h = static_cast<TH1*> ( histo->Clone () ) ;
+        h->SetDirectory ( nullptr ) ;
+        clones.emplace_back ( h ) ;
+        hs [ i ].push_back  ( h ) ;
+      }
+    }
+    TH1::AddDirectory ( add ) ;
+  }
+  //
+  const Reweighter& self = *this ;
+  Ostap::Utils::process_chunks
+    ( tree , chunks , nt ,
+      [&self,&hs] ( TTree* t )
+      { return ReweightWorker ( t , self , hs ) ; } ) ;
+  //
+  // merge the clones in the order of chunks
+  for ( const auto& h : hs )
+  { for ( std::size_t p = 0 ; p < histos.size () ; ++p ) { histos [ p ]->Add ( h [ p ] ) ; } }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+/*  fill all plots with the current weights in one pass over the dataset
+ *  @param data  (INPUT) the dataset
+ *  @param first (INPUT) the first event to process
+ *  @param last  (INPUT) the last event to process
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::Utils::Reweighter::project
+( const RooAbsData*   data  ,
+  const unsigned long first ,
+  const unsigned long last  ) const
+{
+  if ( nullptr == data ) { return Ostap::StatusCode ( INVALID_DATA ) ; }
+  //
+  std::vector<TH1*> histos ;
+  for ( const Plot& p : m_plots ) { p.histo->Reset () ; histos.push_back ( p.histo ) ; }
+  if ( histos.empty () ) { return Ostap::StatusCode::SUCCESS ; }
+  //
+  const unsigned long nEntries =
+    std::min ( last , (unsigned long) data->numEntries() ) ;
+  if ( nEntries <= first  ) { return Ostap::StatusCode::RECOVERABLE ; }
+  //
+  std::vector<std::unique_ptr<Ostap::FormulaVar> > vars ;
+  _make_vars_ ( data , m_expressions , vars ) ;
+  //
+  const bool weighted = data->isWeighted() ;
+  //
+  std::vector<double> values ( vars.size () ) ;
+  for ( unsigned long entry = first ; entry < nEntries ; ++entry )
+  {
+    //
+    if ( nullptr == data->get ( entry ) ) { break ; }              // BREAK
+    //
+    const double dw = weighted ? data->weight () : 1.0 ;
+    if ( !dw ) { continue ; }                                       // CONTINUE
+    //
+    for ( std::size_t i = 0 ; i < vars.size () ; ++i ) { values [ i ] = vars [ i ]->getVal () ; }
+    //
+    const double w = dw * weight ( values.data () ) ;
+    if ( !w  ) { continue ; }                                       // CONTINUE
+    //
+    _fill_ ( m_plots , histos , values , w ) ;
+  }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+
+
+
+// ============================================================================
+// constructor from the reweighter
+// ============================================================================
+Ostap::Functions::FuncReweight::FuncReweight
+( const Ostap::Utils::Reweighter& reweighter )
+  : Ostap::IFuncTree ()
+  , Ostap::IFuncData ()
+  , TObject          ()
+  , m_reweighter     ( reweighter )
+{}
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::Functions::FuncReweight::FuncReweight
+( const Ostap::Functions::FuncReweight& right )
+  : Ostap::IFuncTree ( right )
+  , Ostap::IFuncData ( right )
+  , TObject          ( right )
+  , m_reweighter     ( right.m_reweighter )
+  , m_tree           ( nullptr ) // ATTENTION!
+  , m_data           ( nullptr ) // ATTENTION!
+{}
+// ============================================================================
+Ostap::Functions::FuncReweight*
+Ostap::Functions::FuncReweight::Clone ( const char* /* newname */ ) const
+{ return new FuncReweight ( *this ) ; }
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::Functions::FuncReweight::~FuncReweight () {}
+// ============================================================================
+// notify
+// ============================================================================
+Bool_t Ostap::Functions::FuncReweight::Notify ()
+{
+  for ( auto& f : m_formulas ) { if ( f ) { f->Notify () ; } }
+  return kTRUE ;
+}
+// ============================================================================
+// evaluate the weight for TTree
+// ============================================================================
+double Ostap::Functions::FuncReweight::operator() ( const TTree* tree ) const
+{
+  Ostap::Assert ( nullptr != tree                  ,
+                  "Invalid tree"                   ,
+                  "Ostap::Functions::FuncReweight" , INVALID_TREE ) ;
+  //
+  const auto& expressions = m_reweighter.expressions () ;
+  if ( m_tree != tree || m_formulas.size () != expressions.size () ||
+       ( !m_formulas.empty () && m_formulas.front ()->GetTree () != tree ) )
+  {
+    m_tree = tree ;
+    m_formulas.clear () ;
+    TTree* t = const_cast<TTree*> ( tree ) ;
+    for ( const auto& e : expressions )
+    {
+      auto p = std::make_unique<Ostap::Formula> ( e , t ) ;
+      Ostap::Assert ( p && p->ok ()                    ,
+                      "Invalid formula:\"" + e + "\""  ,
+                      "Ostap::Functions::FuncReweight" , INVALID_FORMULA ) ;
+      m_formulas.push_back ( std::move ( p ) ) ;
+    }
+  }
+  //
+  m_values.resize ( m_formulas.size () ) ;
+  for ( std::size_t i = 0 ; i < m_formulas.size () ; ++i )
+  { m_values [ i ] = m_formulas [ i ]->evaluate () ; }
+  //
+  return m_reweighter.weight ( m_values.data () ) ;
+}
+// ============================================================================
+// evaluate the weight for RooAbsData
+// ============================================================================
+double Ostap::Functions::FuncReweight::operator() ( const RooAbsData* data ) const
+{
+  Ostap::Assert ( nullptr != data                  ,
+                  "Invalid data"                   ,
+                  "Ostap::Functions::FuncReweight" , INVALID_DATA ) ;
+  //
+  const auto& expressions = m_reweighter.expressions () ;
+  if ( m_data != data || m_vars.size () != expressions.size () )
+  {
+    m_data = data ;
+    _make_vars_ ( data , expressions , m_vars ) ;
+  }
+  //
+  m_values.resize ( m_vars.size () ) ;
+  for ( std::size_t i = 0 ; i < m_vars.size () ; ++i )
+  { m_values [ i ] = m_vars [ i ]->getVal () ; }
+  //
+  return m_reweighter.weight ( m_values.data () ) ;
+}
+// ============================================================================
+ClassImp(Ostap::Functions::FuncReweight)
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,522 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <algorithm>
+// ============================================================================
+// ROOT&RooFit
+// ============================================================================
+#include "TTree.h"
+#include "RooAbsReal.h"
+#include "RooRealVar.h"
+#include "RooAbsData.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Formula.h"
+#include "Ostap/Notifier.h"
+#include "Ostap/SWeights.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+#include "local_snapshot.h"
+// ============================================================================
+/** @file
+ *  Implementation file for classes Ostap::Utils::SWeights
+ *  and Ostap::Functions::FuncSWeight
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-03-14
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_DATA          = 780 ,
+    INVALID_PDF           = 781 ,
+    INVALID_OBSERVABLE    = 782 ,
+    CANNOT_CREATE_FORMULA = 783 ,
+    SINGULAR_MATRIX       = 784 ,
+  } ;
+  // ==========================================================================
+  /** in-place inversion of the (small) symmetric positive matrix
+   *  (Gauss-Jordan with partial pivoting)
+   *  @param a the matrix (row-major)
+   *  @param n the dimension
+   *  @return false for the singular matrix
+   */
+  bool _invert_ ( std::vector<double>& a , const std::size_t n )
+  {
+    std::vector<double> b ( n * n , 0.0 ) ;
+    for ( std::size_t i = 0 ; i < n ; ++i ) { b [ i * n + i ] = 1 ; }
+    //
+    for ( std::size_t c = 0 ; c < n ; ++c )
+    {
+      std::size_t p = c ;
+      for ( std::size_t r = c + 1 ; r < n ; ++r )
+      { if ( std::abs ( a [ r * n + c ] ) > std::abs ( a [ p * n + c ] ) ) { p = r ; } }
+      //
+      const double piv = a [ p * n + c ] ;
+      if ( !std::isfinite ( piv ) || 0 == piv ) { return false ; }
+      //
+      if ( p != c )
+      {
+        for ( std::size_t k = 0 ; k < n ; ++k )
+        {
+          std::swap ( a [ p * n + k ] , a [ c * n + k ] ) ;
+          std::swap ( b [ p * n + k ] , b [ c * n + k ] ) ;
+        }
+      }
+      //
+      for ( std::size_t k = 0 ; k < n ; ++k ) { a [ c * n + k ] /= piv ; b [ c * n + k ] /= piv ; }
+      //
+      for ( std::size_t r = 0 ; r < n ; ++r )
+      {
+        if ( r == c ) { continue ; }
+        const double f = a [ r * n + c ] ;
+        if ( 0 == f ) { continue ; }
+        for ( std::size_t k = 0 ; k < n ; ++k )
+        {
+          a [ r * n + k ] -= f * a [ c * n + k ] ;
+          b [ r * n + k ] -= f * b [ c * n + k ] ;
+        }
+      }
+    }
+    a.swap ( b ) ;
+    return true ;
+  }
+  // ==========================================================================
+  /** accumulate the inverse covariance matrix
+   *  @param K         the number of components
+   *  @param yields    the yields
+   *  @param densities the component densities
+   *  @param w         event weight
+   *  @param acc       (UPDATE) the accumulated matrix
+   */
+  inline void _accumulate_
+  ( const std::size_t          K         ,
+    const std::vector<double>& yields    ,
+    const double*              densities ,
+    const double               w         ,
+    double*                    acc       )
+  {
+    double d = 0 ;
+    for ( std::size_t k = 0 ; k < K ; ++k ) { d += yields [ k ] * densities [ k ] ; }
+    if ( !d || !w ) { return ; }
+    const double s = w / ( d * d ) ;
+    for ( std::size_t i = 0 ; i < K ; ++i )
+    { for ( std::size_t j = i ; j < K ; ++j )
+      { acc [ i * K + j ] += s * densities [ i ] * densities [ j ] ; } }
+  }
+  // ==========================================================================
+  /** @class SWeightsWorker
+   *  helper class to evaluate the component densities in the separate thread:
+   *  the PDFs are (deep) cloned, the observables are read from the tree copy
+   */
+  class SWeightsWorker
+  {
+  public:
+    // ========================================================================
+    SWeightsWorker
+    ( TTree*                               tree     ,
+      const Ostap::Utils::SWeights&        sweights ,
+      std::vector<std::vector<double> >&   results  )
+      : m_tree     ( tree      )
+      , m_yields   ( sweights.yields () )
+      , m_results  ( &results  )
+      , m_clones   ( new RooArgSet () )
+    {
+      RooArgSet ( sweights.pdfs () ).snapshot ( *m_clones , true ) ;
+      //
+      for ( const RooAbsArg* a : sweights.pdfs () )
+      {
+        RooAbsReal* pdf = dynamic_cast<RooAbsReal*> ( m_clones->find ( a->GetName () ) ) ;
+        Ostap::Assert ( nullptr != pdf , "Cannot clone PDF" , "Ostap::Utils::SWeights" , INVALID_PDF ) ;
+        m_pdfs.push_back ( pdf ) ;
+      }
+      //
+      for ( const RooAbsArg* a : sweights.observables () )
+      {
+        const std::string name = a->GetName () ;
+        RooRealVar* var = dynamic_cast<RooRealVar*> ( m_clones->find ( name.c_str () ) ) ;
+        if ( nullptr == var ) { continue ; }                 // not used by PDFs
+        m_nset.add ( *var ) ;
+        m_vars.push_back ( var ) ;
+        auto p = std::make_unique<Ostap::Formula> ( name , m_tree ) ;
+        Ostap::Assert ( p && p->ok ()                      ,
+                        "Invalid observable:\"" + name + "\"" ,
+                        "Ostap::Utils::SWeights"           , CANNOT_CREATE_FORMULA ) ;
+        m_formulas.push_back ( std::move ( p ) ) ;
+      }
+      //
+      m_notifier = std::make_unique<Ostap::Utils::Notifier>
+        ( m_formulas.begin () , m_formulas.end () , m_tree ) ;
+      //
+      m_densities.resize ( m_pdfs.size () ) ;
+      // initialize the normalization integrals under the lock
+      for ( RooAbsReal* pdf : m_pdfs ) { pdf->getVal ( &m_nset ) ; }
+    }
+    // ========================================================================
+    /// process the chunk
+    void operator() ( const Ostap::Utils::Chunk& chunk ,
+                      const std::size_t          index )
+    {
+      const std::size_t K = m_pdfs.size () ;
+      std::vector<double>& result = ( *m_results ) [ index ] ;
+      result.assign ( K * K + 2 , 0.0 ) ;
+      for ( unsigned long entry = chunk.first ; entry < chunk.last ; ++entry )
+      {
+        long ievent = m_tree->GetEntryNumber ( entry ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        ievent      = m_tree->LoadTree ( ievent ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        for ( std::size_t i = 0 ; i < m_vars.size () ; ++i )
+        { m_vars [ i ]->setVal ( m_formulas [ i ]->evaluate () ) ; }
+        for ( std::size_t k = 0 ; k < K ; ++k )
+        { m_densities [ k ] = m_pdfs [ k ]->getVal ( &m_nset ) ; }
+        //
+        _accumulate_ ( K , m_yields , m_densities.data () , 1.0 , result.data () ) ;
+        result [ K * K     ] += 1 ;
+        result [ K * K + 1 ] += 1 ;
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the tree
+    TTree*                                       m_tree      { nullptr } ;
+    /// the yields
+    std::vector<double>                          m_yields    {} ;
+    /// the results (per chunk)
+    std::vector<std::vector<double> >*           m_results   { nullptr } ;
+    /// the cloned PDFs and observables
+    std::unique_ptr<RooArgSet>                   m_clones    {} ;
+    /// the cloned PDFs
+    std::vector<RooAbsReal*>                     m_pdfs      {} ;
+    /// the cloned observables
+    std::vector<RooRealVar*>                     m_vars      {} ;
+    /// the normalization set
+    RooArgSet                                    m_nset      {} ;
+    /// the formulas for observables
+    std::vector<std::unique_ptr<Ostap::Formula> > m_formulas {} ;
+    /// the densities
+    std::vector<double>                          m_densities {} ;
+    /// notifier (must be destroyed before formulas!)
+    std::unique_ptr<Ostap::Utils::Notifier>      m_notifier  {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+}
+// ============================================================================
+/*  constructor
+ *  @param pdfs        the component PDFs
+ *  @param observables the observables
+ *  @param yields      the yields of components
+ */
+// ============================================================================
+Ostap::Utils::SWeights::SWeights
+( const RooArgList&          pdfs        ,
+  const RooArgSet&           observables ,
+  const std::vector<double>& yields      )
+  : m_pdfs        ( pdfs        )
+  , m_observables ( observables )
+  , m_yields      ( yields      )
+  , m_cov         ( yields.size () * yields.size () , 0.0 )
+{
+  Ostap::Assert ( 0 < m_yields.size () && m_yields.size () == static_cast<std::size_t> ( m_pdfs.getSize () ) ,
+                  "Mismatch in number of PDFs/yields" ,
+                  "Ostap::Utils::SWeights"            , INVALID_PDF ) ;
+  for ( const RooAbsArg* a : m_pdfs )
+  { Ostap::Assert ( nullptr != dynamic_cast<const RooAbsReal*> ( a ) ,
+                    "Invalid PDF"                     ,
+                    "Ostap::Utils::SWeights"          , INVALID_PDF ) ; }
+  for ( const RooAbsArg* a : m_observables )
+  { Ostap::Assert ( nullptr != dynamic_cast<const RooRealVar*> ( a ) ,
+                    "Invalid observable"              ,
+                    "Ostap::Utils::SWeights"          , INVALID_OBSERVABLE ) ; }
+}
+// ============================================================================
+/*  calculate the covariance matrix for the component densities
+ *  @param n         the number of entries
+ *  @param densities the component densities, <code>n*size()</code>, entry by entry
+ *  @param weights   event weights (optional)
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::Utils::SWeights::fill
+( const std::size_t   n         ,
+  const double*       densities ,
+  const double*       weights   )
+{
+  const std::size_t K = size () ;
+  std::vector<double> acc ( K * K , 0.0 ) ;
+  m_sumw    = 0 ;
+  m_entries = n ;
+  for ( std::size_t e = 0 ; e < n ; ++e )
+  {
+    const double w = nullptr != weights ? weights [ e ] : 1.0 ;
+    _accumulate_ ( K , m_yields , densities + e * K , w , acc.data () ) ;
+    m_sumw += w ;
+  }
+  //
+  for ( std::size_t i = 0 ; i < K ; ++i )
+  { for ( std::size_t j = 0 ; j < i ; ++j ) { acc [ i * K + j ] = acc [ j * K + i ] ; } }
+  //
+  m_ok = _invert_ ( acc , K ) ;
+  if ( !m_ok ) { return Ostap::StatusCode ( SINGULAR_MATRIX ) ; }
+  m_cov.swap ( acc ) ;
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+/*  calculate the covariance matrix for the dataset
+ *  (the event weights are taken into account)
+ *  @param data the dataset
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::Utils::SWeights::fill
+( const RooAbsData& data )
+{
+  const unsigned long nEntries = data.numEntries () ;
+  const std::size_t   K        = size () ;
+  //
+  if ( nullptr == data.get ( 0 ) ) { return Ostap::StatusCode ( INVALID_DATA ) ; }
+  //
+  // the observables <- the snapshot of the data
+  std::vector<RooRealVar*> observables ;
+  for ( RooAbsArg* a : m_observables ) { observables.push_back ( static_cast<RooRealVar*> ( a ) ) ; }
+  ValueSnapshot snapshot ( data , observables ) ;
+  if ( !snapshot.ok () ) { return Ostap::StatusCode ( INVALID_OBSERVABLE ) ; }
+  const std::size_t NO = observables.size () ;
+  //
+  std::vector<double> dens    ( nEntries * K , 0.0 ) ;
+  std::vector<double> weights ( nEntries     , 1.0 ) ;
+  for ( unsigned long entry = 0 ; entry < nEntries ; ++entry )
+  {
+    const double* values = snapshot.load ( entry ) ;
+    if ( nullptr == values ) { break ; }                        // BREAK
+    for ( std::size_t k = 0 ; k < NO ; ++k ) { observables [ k ]->setVal ( values [ k ] ) ; }
+    densities ( &dens [ entry * K ] ) ;
+    weights [ entry ] = snapshot.weight () ;
+  }
+  //
+  return fill ( nEntries , dens.data () , data.isWeighted () ? weights.data () : nullptr ) ;
+}
+// ============================================================================
+/*  calculate the covariance matrix for the tree
+ *  @param tree     the tree
+ *  @param nthreads the number of threads
+ */
+// ============================================================================
+Ostap::StatusCode Ostap::Utils::SWeights::fill
+( const TTree*        tree     ,
+  const unsigned int  nthreads )
+{
+  if ( nullptr == tree ) { return Ostap::StatusCode ( INVALID_DATA ) ; }
+  TTree* t = const_cast<TTree*> ( tree ) ;
+  //
+  const unsigned long nEntries = t->GetEntries () ;
+  const std::size_t   K        = size () ;
+  //
+  const unsigned int nt = Ostap::Utils::parallelizable ( tree ) ? Ostap::Utils::nThreads ( nthreads ) : 1 ;
+  //
+  std::vector<std::vector<double> > partial ;
+  if ( 1 == nt )
+  {
+    partial.resize ( 1 ) ;
+    SWeightsWorker worker ( t , *this , partial ) ;
+    worker ( Ostap::Utils::Chunk ( 0 , nEntries ) , 0 ) ;
+  }
+  else
+  {
+    // split the range of entries into chunks (a few chunks per thread)
+    const Ostap::Utils::Chunks chunks = Ostap::Utils::clusters ( t , 0 , nEntries , 4 * nt ) ;
+    partial.resize ( chunks.size () ) ;
+    const SWeights& self = *this ;
+    Ostap::Utils::process_chunks
+      ( tree , chunks , nt ,
+        [&self,&partial] ( TTree* c )
+        { return SWeightsWorker ( c , self , partial ) ; } ) ;
+  }
+  //
+  // merge partial results in the order of chunks
+  std::vector<double> acc ( K * K , 0.0 ) ;
+  m_sumw    = 0 ;
+  m_entries = 0 ;
+  for ( const auto& p : partial )
+  {
+    if ( p.size () < K * K + 2 ) { continue ; }
+    for ( std::size_t i = 0 ; i < K * K ; ++i ) { acc [ i ] += p [ i ] ; }
+    m_sumw    += p [ K * K     ] ;
+    m_entries += static_cast<unsigned long> ( p [ K * K + 1 ] ) ;
+  }
+  //
+  for ( std::size_t i = 0 ; i < K ; ++i )
+  { for ( std::size_t j = 0 ; j < i ; ++j ) { acc [ i * K + j ] = acc [ j * K + i ] ; } }
+  //
+  m_ok = _invert_ ( acc , K ) ;
+  if ( !m_ok ) { return Ostap::StatusCode ( SINGULAR_MATRIX ) ; }
+  m_cov.swap ( acc ) ;
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+/*  calculate sWeights for the given component densities
+ *  @param densities (INPUT)  the component densities, <code>size()</code>
+ *  @param result    (OUTPUT) sWeights, <code>size()</code>
+ */
+// ============================================================================
+void Ostap::Utils::SWeights::weights
+( const double* densities ,
+  double*       result    ) const
+{
+  const std::size_t K = size () ;
+  double d = 0 ;
+  for ( std::size_t k = 0 ; k < K ; ++k ) { d += m_yields [ k ] * densities [ k ] ; }
+  for ( std::size_t i = 0 ; i < K ; ++i )
+  {
+    double s = 0 ;
+    for ( std::size_t j = 0 ; j < K ; ++j ) { s += m_cov [ i * K + j ] * densities [ j ] ; }
+    result [ i ] = d ? s / d : 0.0 ;
+  }
+}
+// ============================================================================
+/*  calculate the component densities for the current values of observables
+ *  @param result (OUTPUT) the densities, <code>size()</code>
+ */
+// ============================================================================
+void Ostap::Utils::SWeights::densities ( double* result ) const
+{
+  std::size_t k = 0 ;
+  for ( const RooAbsArg* a : m_pdfs )
+  { result [ k++ ] = static_cast<const RooAbsReal*> ( a )->getVal ( &m_observables ) ; }
+}
+// ============================================================================
+
+
+
+// ============================================================================
+/*  constructor
+ *  @param sweights the engine (with calculated covariance matrix)
+ *  @param index    the component
+ */
+// ============================================================================
+Ostap::Functions::FuncSWeight::FuncSWeight
+( const Ostap::Utils::SWeights& sweights ,
+  const unsigned short          index    )
+  : Ostap::IFuncTree ()
+  , Ostap::IFuncData ()
+  , TObject          ()
+  , m_sweights       ( sweights )
+  , m_index          ( index    )
+{
+  Ostap::Assert ( m_index < m_sweights.size ()  ,
+                  "Invalid component index"     ,
+                  "Ostap::Functions::FuncSWeight" , INVALID_PDF ) ;
+  Ostap::Assert ( m_sweights.ok ()              ,
+                  "sWeights are not calculated" ,
+                  "Ostap::Functions::FuncSWeight" , SINGULAR_MATRIX ) ;
+}
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::Functions::FuncSWeight::FuncSWeight
+( const Ostap::Functions::FuncSWeight& right )
+  : Ostap::IFuncTree ( right )
+  , Ostap::IFuncData ( right )
+  , TObject          ( right )
+  , m_sweights       ( right.m_sweights )
+  , m_index          ( right.m_index    )
+  , m_tree           ( nullptr          ) // ATTENTION!
+{}
+// ============================================================================
+Ostap::Functions::FuncSWeight*
+Ostap::Functions::FuncSWeight::Clone ( const char* /* newname */ ) const
+{ return new FuncSWeight ( *this ) ; }
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::Functions::FuncSWeight::~FuncSWeight () {}
+// ============================================================================
+// notify
+// ============================================================================
+Bool_t Ostap::Functions::FuncSWeight::Notify ()
+{
+  for ( auto& f : m_formulas ) { if ( f ) { f->Notify () ; } }
+  return kTRUE ;
+}
+// ============================================================================
+// sWeight for the current values of observables
+// ============================================================================
+double Ostap::Functions::FuncSWeight::sweight () const
+{
+  const std::size_t K = m_sweights.size () ;
+  std::vector<double> dens ( K ) ;
+  std::vector<double> sw   ( K ) ;
+  m_sweights.densities ( dens.data () ) ;
+  m_sweights.weights   ( dens.data () , sw.data () ) ;
+  return sw [ m_index ] ;
+}
+// ============================================================================
+// evaluate sWeight for TTree
+// ============================================================================
+double Ostap::Functions::FuncSWeight::operator() ( const TTree* tree ) const
+{
+  Ostap::Assert ( nullptr != tree                 ,
+                  "Invalid tree"                  ,
+                  "Ostap::Functions::FuncSWeight" , INVALID_DATA ) ;
+  //
+  if ( m_tree != tree || m_formulas.empty () || m_formulas.front ()->GetTree () != tree )
+  {
+    m_tree = tree ;
+    m_formulas.clear () ;
+    m_vars    .clear () ;
+    TTree* t = const_cast<TTree*> ( tree ) ;
+    for ( RooAbsArg* a : m_sweights.observables () )
+    {
+      auto p = std::make_unique<Ostap::Formula> ( a->GetName () , t ) ;
+      Ostap::Assert ( p && p->ok ()                  ,
+                      std::string ( "Invalid observable:" ) + a->GetName () ,
+                      "Ostap::Functions::FuncSWeight" , CANNOT_CREATE_FORMULA ) ;
+      m_formulas.push_back ( std::move ( p ) ) ;
+      m_vars    .push_back ( static_cast<RooRealVar*> ( a ) ) ;
+    }
+  }
+  //
+  for ( std::size_t i = 0 ; i < m_vars.size () ; ++i )
+  { m_vars [ i ]->setVal ( m_formulas [ i ]->evaluate () ) ; }
+  //
+  return sweight () ;
+}
+// ============================================================================
+// evaluate sWeight for RooAbsData
+// ============================================================================
+double Ostap::Functions::FuncSWeight::operator() ( const RooAbsData* data ) const
+{
+  Ostap::Assert ( nullptr != data                 ,
+                  "Invalid data"                  ,
+                  "Ostap::Functions::FuncSWeight" , INVALID_DATA ) ;
+  //
+  const RooArgSet* row = data->get () ;
+  Ostap::Assert ( nullptr != row                  ,
+                  "Invalid data"                  ,
+                  "Ostap::Functions::FuncSWeight" , INVALID_DATA ) ;
+  //
+  for ( RooAbsArg* a : m_sweights.observables () )
+  {
+    const RooAbsReal* c = dynamic_cast<const RooAbsReal*> ( row->find ( a->GetName () ) ) ;
+    Ostap::Assert ( nullptr != c                    ,
+                    std::string ( "Invalid observable:" ) + a->GetName () ,
+                    "Ostap::Functions::FuncSWeight" , INVALID_OBSERVABLE ) ;
+    static_cast<RooRealVar*> ( a )->setVal ( c->getVal () ) ;
+  }
+  //
+  return sweight () ;
+}
+// ============================================================================
+ClassImp(Ostap::Functions::FuncSWeight)
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,391 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Scattered.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for classes Ostap::Math::Scattered,
+ *  Ostap::Math::Scattered2D and Ostap::Math::Scattered3D
+ *  @see Ostap::Math::Scattered
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_DIMENSION = 850 ,
+    INVALID_DATA      = 851 ,
+  } ;
+  // ==========================================================================
+  /// the size of the leaves of k-d tree
+  const std::size_t s_LEAF = 8 ;
+  // ==========================================================================
+  /** solve the small linear system <code>A x = b</code>
+   *  (Gaussian elimination with partial pivoting)
+   *  @return false for the singular matrix
+   */
+  bool solve
+  ( const unsigned short n ,
+    double*              A ,
+    double*              b )
+  {
+    for ( unsigned short c = 0 ; c < n ; ++c )
+    {
+      unsigned short p = c ;
+      for ( unsigned short r = c + 1 ; r < n ; ++r )
+      { if ( std::abs ( A [ r * n + c ] ) > std::abs ( A [ p * n + c ] ) ) { p = r ; } }
+      if ( 0 == A [ p * n + c ] ) { return false ; }                 // RETURN
+      if ( p != c )
+      {
+        for ( unsigned short k = 0 ; k < n ; ++k ) { std::swap ( A [ p * n + k ] , A [ c * n + k ] ) ; }
+        std::swap ( b [ p ] , b [ c ] ) ;
+      }
+      for ( unsigned short r = c + 1 ; r < n ; ++r )
+      {
+        const double f = A [ r * n + c ] / A [ c * n + c ] ;
+        for ( unsigned short k = c ; k < n ; ++k ) { A [ r * n + k ] -= f * A [ c * n + k ] ; }
+        b [ r ] -= f * b [ c ] ;
+      }
+    }
+    for ( int r = n - 1 ; 0 <= r ; --r )
+    {
+      double s = b [ r ] ;
+      for ( unsigned short k = r + 1 ; k < n ; ++k ) { s -= A [ r * n + k ] * b [ k ] ; }
+      b [ r ] = s / A [ r * n + r ] ;
+    }
+    return true ;
+  }
+  // ==========================================================================
+  /// merge the coordinates into the row-wise storage
+  std::vector<double> rows
+  ( const std::vector<const std::vector<double>*>& coordinates ,
+    const std::size_t                              n           )
+  {
+    for ( const auto* c : coordinates )
+    {
+      Ostap::Assert ( c->size () == n                   ,
+                      "Mismatch in the data size"       ,
+                      "Ostap::Math::Scattered"          , INVALID_DATA ) ;
+    }
+    const std::size_t   dim = coordinates.size () ;
+    std::vector<double> result ( n * dim ) ;
+    for ( std::size_t i = 0 ; i < n ; ++i )
+    { for ( std::size_t k = 0 ; k < dim ; ++k ) { result [ i * dim + k ] = ( *coordinates [ k ] ) [ i ] ; } }
+    return result ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+/*  constructor
+ *  @param points (INPUT) the data points, stored row-wise
+ *  @param values (INPUT) the values at data points
+ *  @param dim    (INPUT) the dimension
+ *  @param nw     (INPUT) number of neighbours for interpolation (0: default)
+ *  @param nq     (INPUT) number of neighbours for the nodal functions (0: default)
+ */
+// ============================================================================
+Ostap::Math::Scattered::Scattered
+( const std::vector<double>& points ,
+  const std::vector<double>& values ,
+  const unsigned short       dim    ,
+  const unsigned short       nw     ,
+  const unsigned short       nq     )
+  : m_dim    ( dim    )
+  , m_points ( points )
+  , m_values ( values )
+{
+  Ostap::Assert ( 1 <= m_dim && m_dim <= 10                ,
+                  "Invalid dimension"                      ,
+                  "Ostap::Math::Scattered" , INVALID_DIMENSION ) ;
+  Ostap::Assert ( !m_values.empty () && m_points.size () == m_values.size () * m_dim ,
+                  "Invalid data"                           ,
+                  "Ostap::Math::Scattered" , INVALID_DATA      ) ;
+  //
+  const std::size_t N = m_values.size () ;
+  m_nw = std::min<std::size_t> ( 0 < nw ? nw : 5 * m_dim , N     ) ;
+  m_nq = std::min<std::size_t> ( 0 < nq ? nq : 6 * m_dim , N - 1 ) ;
+  //
+  m_index.resize ( N ) ;
+  m_split.resize ( N , 0 ) ;
+  std::iota ( m_index.begin () , m_index.end () , 0 ) ;
+  build ( 0 , N ) ;
+  //
+  gradients () ;
+}
+// ============================================================================
+// build the tree for the range [lo,hi)
+// ============================================================================
+void Ostap::Math::Scattered::build
+( const std::size_t lo ,
+  const std::size_t hi )
+{
+  if ( hi <= lo + s_LEAF ) { return ; }
+  // split along the dimension with the largest spread
+  unsigned short split  = 0 ;
+  double         spread = -1 ;
+  for ( unsigned short k = 0 ; k < m_dim ; ++k )
+  {
+    double vmin = point ( m_index [ lo ] ) [ k ] ;
+    double vmax = vmin ;
+    for ( std::size_t j = lo + 1 ; j < hi ; ++j )
+    {
+      const double v = point ( m_index [ j ] ) [ k ] ;
+      vmin = std::min ( vmin , v ) ;
+      vmax = std::max ( vmax , v ) ;
+    }
+    if ( spread < vmax - vmin ) { spread = vmax - vmin ; split = k ; }
+  }
+  //
+  const std::size_t mid = ( lo + hi ) / 2 ;
+  std::nth_element
+    ( m_index.begin () + lo  ,
+      m_index.begin () + mid ,
+      m_index.begin () + hi  ,
+      [this,split] ( const std::size_t a , const std::size_t b )
+      { return point ( a ) [ split ] < point ( b ) [ split ] ; } ) ;
+  m_split [ mid ] = split ;
+  //
+  build ( lo      , mid ) ;
+  build ( mid + 1 , hi  ) ;
+}
+// ============================================================================
+// squared distance between the query and data point
+// ============================================================================
+double Ostap::Math::Scattered::dist2
+( const double*     q ,
+  const std::size_t i ) const
+{
+  const double* p      = point ( i ) ;
+  double        result = 0 ;
+  for ( unsigned short k = 0 ; k < m_dim ; ++k )
+  { const double d = q [ k ] - p [ k ] ; result += d * d ; }
+  return result ;
+}
+// ============================================================================
+// search the nearest neighbours in the range [lo,hi)
+// ============================================================================
+void Ostap::Math::Scattered::search
+( const std::size_t                            lo ,
+  const std::size_t                            hi ,
+  const double*                                q  ,
+  const std::size_t                            k  ,
+  std::vector<std::pair<double,std::size_t> >& nn ) const
+{
+  // insert the candidate into the sorted list of k neighbours
+  auto insert = [&nn,k] ( const double d2 , const std::size_t i )
+  {
+    if ( k <= nn.size () && nn.back ().first <= d2 ) { return ; }
+    if ( k <= nn.size () ) { nn.pop_back () ; }
+    const std::pair<double,std::size_t> item { d2 , i } ;
+    nn.insert ( std::upper_bound ( nn.begin () , nn.end () , item ) , item ) ;
+  } ;
+  //
+  if ( hi <= lo + s_LEAF )
+  {
+    for ( std::size_t j = lo ; j < hi ; ++j )
+    { insert ( dist2 ( q , m_index [ j ] ) , m_index [ j ] ) ; }
+    return ;                                                    // RETURN
+  }
+  //
+  const std::size_t mid = ( lo + hi ) / 2 ;
+  const std::size_t i   = m_index [ mid ] ;
+  insert ( dist2 ( q , i ) , i ) ;
+  //
+  const unsigned short s    = m_split [ mid ] ;
+  const double         diff = q [ s ] - point ( i ) [ s ] ;
+  if ( diff < 0 )
+  {
+    search ( lo , mid , q , k , nn ) ;
+    if ( nn.size () < k || diff * diff < nn.back ().first ) { search ( mid + 1 , hi  , q , k , nn ) ; }
+  }
+  else
+  {
+    search ( mid + 1 , hi  , q , k , nn ) ;
+    if ( nn.size () < k || diff * diff < nn.back ().first ) { search ( lo      , mid , q , k , nn ) ; }
+  }
+}
+// ============================================================================
+/*  find k nearest neighbours
+ *  @param q (INPUT)  the query point
+ *  @param k (INPUT)  number of neighbours
+ *  @param nn (OUTPUT) (squared distance,index) pairs, sorted
+ */
+// ============================================================================
+void Ostap::Math::Scattered::nearest
+( const double*                                q  ,
+  const std::size_t                            k  ,
+  std::vector<std::pair<double,std::size_t> >& nn ) const
+{
+  nn.clear   () ;
+  nn.reserve ( k + 1 ) ;
+  search ( 0 , m_index.size () , q , k , nn ) ;
+}
+// ============================================================================
+// precompute the gradients of the nodal functions
+// ============================================================================
+void Ostap::Math::Scattered::gradients ()
+{
+  const std::size_t N = m_values.size () ;
+  m_grads.assign ( N * m_dim , 0.0 ) ;
+  if ( m_nq < m_dim ) { return ; }                               // RETURN
+  //
+  std::vector<std::pair<double,std::size_t> > nn ;
+  std::vector<double> A ( m_dim * m_dim ) ;
+  std::vector<double> b ( m_dim ) ;
+  std::vector<double> d ( m_dim ) ;
+  //
+  for ( std::size_t i = 0 ; i < N ; ++i )
+  {
+    const double* p = point ( i ) ;
+    nearest ( p , m_nq + 1 , nn ) ;
+    //
+    const double R = 1.01 * std::sqrt ( nn.back ().first ) ;
+    std::fill ( A.begin () , A.end () , 0.0 ) ;
+    std::fill ( b.begin () , b.end () , 0.0 ) ;
+    //
+    // weighted least squares: sum w_j ( f_j - f_i - g.(x_j-x_i) )^2
+    for ( const auto& item : nn )
+    {
+      const std::size_t j = item.second ;
+      if ( j == i || 0 == item.first ) { continue ; }
+      const double dj = std::sqrt ( item.first ) ;
+      const double wj = std::pow ( ( R - dj ) / ( R * dj ) , 2 ) ;
+      const double df = m_values [ j ] - m_values [ i ] ;
+      const double* pj = point ( j ) ;
+      for ( unsigned short k = 0 ; k < m_dim ; ++k ) { d [ k ] = pj [ k ] - p [ k ] ; }
+      for ( unsigned short r = 0 ; r < m_dim ; ++r )
+      {
+        b [ r ] += wj * d [ r ] * df ;
+        for ( unsigned short c = 0 ; c < m_dim ; ++c ) { A [ r * m_dim + c ] += wj * d [ r ] * d [ c ] ; }
+      }
+    }
+    // tiny regularization for the degenerate configurations
+    double trace = 0 ;
+    for ( unsigned short r = 0 ; r < m_dim ; ++r ) { trace += A [ r * m_dim + r ] ; }
+    for ( unsigned short r = 0 ; r < m_dim ; ++r ) { A [ r * m_dim + r ] += 1.e-12 * trace ; }
+    //
+    if ( 0 < trace && solve ( m_dim , A.data () , b.data () ) )
+    { std::copy ( b.begin () , b.end () , m_grads.begin () + i * m_dim ) ; }
+  }
+}
+// ============================================================================
+// evaluate the interpolation at the point
+// ============================================================================
+double Ostap::Math::Scattered::evaluate ( const double* x ) const
+{
+  if ( m_values.empty () ) { return 0 ; }                        // RETURN
+  //
+  static thread_local std::vector<std::pair<double,std::size_t> > s_nn ;
+  nearest ( x , m_nw , s_nn ) ;
+  //
+  // exactly at the data point
+  if ( 0 == s_nn.front ().first || 1 == s_nn.size () )
+  { return m_values [ s_nn.front ().second ] ; }                   // RETURN
+  //
+  const double R  = 1.01 * std::sqrt ( s_nn.back ().first ) ;
+  double       sw = 0 ;
+  double       sf = 0 ;
+  for ( const auto& item : s_nn )
+  {
+    const std::size_t i  = item.second ;
+    const double      di = std::sqrt ( item.first ) ;
+    const double      wi = std::pow ( ( R - di ) / ( R * di ) , 2 ) ;
+    //
+    const double* p = point    ( i ) ;
+    const double* g = gradient ( i ) ;
+    double        q = m_values [ i ] ;
+    for ( unsigned short k = 0 ; k < m_dim ; ++k ) { q += g [ k ] * ( x [ k ] - p [ k ] ) ; }
+    //
+    sw += wi     ;
+    sf += wi * q ;
+  }
+  return sf / sw ;
+}
+// ============================================================================
+/*  constructor
+ *  @param x      (INPUT) x-coordinates of data points
+ *  @param y      (INPUT) y-coordinates of data points
+ *  @param values (INPUT) the values at data points
+ *  @param nw     (INPUT) number of neighbours for interpolation (0: default)
+ *  @param nq     (INPUT) number of neighbours for the nodal functions (0: default)
+ */
+// ============================================================================
+Ostap::Math::Scattered2D::Scattered2D
+( const std::vector<double>& x      ,
+  const std::vector<double>& y      ,
+  const std::vector<double>& values ,
+  const unsigned short       nw     ,
+  const unsigned short       nq     )
+  : Scattered ( rows ( { &x , &y } , values.size () ) , values , 2 , nw , nq )
+{}
+// ============================================================================
+/*  evaluate the interpolation for the arrays of points
+ *  @param n      (INPUT)  number of points
+ *  @param x      (INPUT)  x-coordinates
+ *  @param y      (INPUT)  y-coordinates
+ *  @param result (UPDATE) the results
+ */
+// ============================================================================
+void Ostap::Math::Scattered2D::evaluate
+( const std::size_t n      ,
+  const double*     x      ,
+  const double*     y      ,
+  double*           result ) const
+{
+  for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = evaluate ( x [ i ] , y [ i ] ) ; }
+}
+// ============================================================================
+/*  constructor
+ *  @param x      (INPUT) x-coordinates of data points
+ *  @param y      (INPUT) y-coordinates of data points
+ *  @param z      (INPUT) z-coordinates of data points
+ *  @param values (INPUT) the values at data points
+ *  @param nw     (INPUT) number of neighbours for interpolation (0: default)
+ *  @param nq     (INPUT) number of neighbours for the nodal functions (0: default)
+ */
+// ============================================================================
+Ostap::Math::Scattered3D::Scattered3D
+( const std::vector<double>& x      ,
+  const std::vector<double>& y      ,
+  const std::vector<double>& z      ,
+  const std::vector<double>& values ,
+  const unsigned short       nw     ,
+  const unsigned short       nq     )
+  : Scattered ( rows ( { &x , &y , &z } , values.size () ) , values , 3 , nw , nq )
+{}
+// ============================================================================
+/*  evaluate the interpolation for the arrays of points
+ *  @param n      (INPUT)  number of points
+ *  @param x      (INPUT)  x-coordinates
+ *  @param y      (INPUT)  y-coordinates
+ *  @param z      (INPUT)  z-coordinates
+ *  @param result (UPDATE) the results
+ */
+// ============================================================================
+void Ostap::Math::Scattered3D::evaluate
+( const std::size_t n      ,
+  const double*     x      ,
+  const double*     y      ,
+  const double*     z      ,
+  double*           result ) const
+{
+  for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = evaluate ( x [ i ] , y [ i ] , z [ i ] ) ; }
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -0,0 +1,351 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD & STL
+// ============================================================================
+#include <cmath>
+#include <limits>
+#include <algorithm>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Integrator.h"
+#include "Ostap/Solver1D.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Math::Solver1D
+ *  @see Ostap::Math::Solver1D
+ *  @author Vanya Belyaev Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  const double s_EPS = std::numeric_limits<double>::epsilon () ;
+  /// the golden section ratio: (3-sqrt(5))/2
+  const double s_GOLD = 0.5 * ( 3.0 - std::sqrt ( 5.0 ) ) ;
+  // ==========================================================================
+  inline bool opposite ( const double a , const double b )
+  { return ( a < 0 && 0 < b ) || ( b < 0 && 0 < a ) ; }
+  // ==========================================================================
+}
+// ============================================================================
+/*  find the root of the function using Brent's method
+ *  @see R.P.Brent, "Algorithms for Minimization without Derivatives", 1973, chapter 4
+ */
+// ============================================================================
+double Ostap::Math::Solver1D::root_
+( Ostap::Math::Solver1D::function1 f       ,
+  const double                     a       ,
+  const double                     b       ,
+  const double                     xtol    ,
+  const double                     rtol    ,
+  const unsigned short             maxiter )
+{
+  Ostap::Assert ( std::isfinite ( a ) && std::isfinite ( b ) ,
+                  "Invalid bracketing interval" , "Ostap::Math::Solver1D::root" ) ;
+  //
+  double xa = a , xb = b ;
+  double fa = f ( xa ) , fb = f ( xb ) ;
+  if ( 0 == fa ) { return xa ; }                                      // RETURN
+  if ( 0 == fb ) { return xb ; }                                      // RETURN
+  Ostap::Assert ( opposite ( fa , fb ) ,
+                  "f(a) and f(b) must have different signs" , "Ostap::Math::Solver1D::root" ) ;
+  //
+  double xc = xb , fc = fb ;
+  double d  = 0  , e  = 0  ;
+  for ( unsigned short iter = 0 ; iter < maxiter ; ++iter )
+  {
+    if ( opposite ( fb , fc ) == false ) { xc = xa ; fc = fa ; d = xb - xa ; e = d ; }
+    if ( std::abs ( fc ) < std::abs ( fb ) )
+    {
+      xa = xb ; xb = xc ; xc = xa ;
+      fa = fb ; fb = fc ; fc = fa ;
+    }
+    const double tol = 2 * s_EPS * std::abs ( xb ) + 0.5 * ( xtol + rtol * std::abs ( xb ) ) ;
+    const double m   = 0.5 * ( xc - xb ) ;
+    if ( std::abs ( m ) <= tol || 0 == fb ) { return xb ; }           // RETURN
+    //
+    if ( std::abs ( e ) >= tol && std::abs ( fa ) > std::abs ( fb ) )
+    {
+      // inverse quadratic interpolation or secant
+      double p , q ;
+      const double s = fb / fa ;
+      if ( xa == xc ) { p = 2 * m * s ; q = 1 - s ; }
+      else
+      {
+        const double qq = fa / fc ;
+        const double r  = fb / fc ;
+        p = s * ( 2 * m * qq * ( qq - r ) - ( xb - xa ) * ( r - 1 ) ) ;
+        q = ( qq - 1 ) * ( r - 1 ) * ( s - 1 ) ;
+      }
+      if ( 0 < p ) { q = -q ; } else { p = -p ; }
+      if ( 2 * p < std::min ( 3 * m * q - std::abs ( tol * q ) , std::abs ( e * q ) ) )
+      { e = d ; d = p / q ; }
+      else
+      { d = m ; e = m ; }                                   // bisection
+    }
+    else { d = m ; e = m ; }                                // bisection
+    //
+    xa = xb ; fa = fb ;
+    xb += std::abs ( d ) > tol ? d : ( 0 < m ? tol : -tol ) ;
+    fb  = f ( xb ) ;
+  }
+  return xb ;
+}
+// ============================================================================
+/*  find the root of the function using safeguarded Halley's method
+ *  (Newton's method if the second derivative is not specified)
+ */
+// ============================================================================
+double Ostap::Math::Solver1D::halley_
+( Ostap::Math::Solver1D::function1 f       ,
+  Ostap::Math::Solver1D::function1 d1      ,
+  Ostap::Math::Solver1D::function1 d2      ,
+  const double                     a       ,
+  const double                     b       ,
+  const double                     x0      ,
+  const double                     xtol    ,
+  const double                     rtol    ,
+  const unsigned short             maxiter )
+{
+  Ostap::Assert ( std::isfinite ( a ) && std::isfinite ( b ) ,
+                  "Invalid bracketing interval" , "Ostap::Math::Solver1D::halley" ) ;
+  Ostap::Assert ( bool ( d1 ) ,
+                  "The first derivative must be specified" , "Ostap::Math::Solver1D::halley" ) ;
+  //
+  double lo = std::min ( a , b ) , hi = std::max ( a , b ) ;
+  double flo = f ( lo ) , fhi = f ( hi ) ;
+  if ( 0 == flo ) { return lo ; }                                     // RETURN
+  if ( 0 == fhi ) { return hi ; }                                     // RETURN
+  Ostap::Assert ( opposite ( flo , fhi ) ,
+                  "f(a) and f(b) must have different signs" , "Ostap::Math::Solver1D::halley" ) ;
+  //
+  double x  = ( lo < x0 && x0 < hi ) ? x0 : 0.5 * ( lo + hi ) ;
+  double dxold = hi - lo ;
+  for ( unsigned short iter = 0 ; iter < maxiter ; ++iter )
+  {
+    const double fx = f ( x ) ;
+    if ( 0 == fx ) { return x ; }                                     // RETURN
+    // update the bracketing interval
+    if ( opposite ( fx , flo ) ) { hi = x ; fhi = fx ; }
+    else                         { lo = x ; flo = fx ; }
+    //
+    const double df  = d1 ( x ) ;
+    double       xn  = x ;
+    bool         ok  = 0 != df && std::isfinite ( df ) ;
+    if ( ok )
+    {
+      const double dn  = fx / df ;
+      double       dx  = dn ;
+      if ( d2 )
+      {
+        const double ddf   = d2 ( x ) ;
+        const double denom = 1.0 - 0.5 * dn * ddf / df ;
+        if ( std::isfinite ( ddf ) && 0 != denom ) { dx = dn / denom ; }
+      }
+      xn = x - dx ;
+      // safeguard: inside the bracket and shrink fast enough
+      ok = lo < xn && xn < hi && std::abs ( dx ) < 0.5 * dxold ;
+      if ( ok ) { dxold = std::abs ( dx ) ; }
+    }
+    if ( !ok ) { xn = 0.5 * ( lo + hi ) ; dxold = hi - lo ; }
+    //
+    const double tol = xtol + rtol * std::abs ( xn ) ;
+    if ( std::abs ( xn - x ) <= tol || ( hi - lo ) <= tol ) { return xn ; } // RETURN
+    x = xn ;
+  }
+  return x ;
+}
+// ============================================================================
+/*  find the minimum of the function at the interval [a,b]
+ *  using Brent's bounded method
+ *  @see R.P.Brent, "Algorithms for Minimization without Derivatives", 1973, chapter 5
+ */
+// ============================================================================
+double Ostap::Math::Solver1D::minimum_
+( Ostap::Math::Solver1D::function1 f       ,
+  const double                     a       ,
+  const double                     b       ,
+  const double                     xtol    ,
+  const unsigned short             maxiter )
+{
+  Ostap::Assert ( std::isfinite ( a ) && std::isfinite ( b ) ,
+                  "Invalid interval" , "Ostap::Math::Solver1D::minimum" ) ;
+  //
+  double lo = std::min ( a , b ) , hi = std::max ( a , b ) ;
+  double x  = lo + s_GOLD * ( hi - lo ) ;
+  double w  = x , v = x ;
+  double fx = f ( x ) , fw = fx , fv = fx ;
+  double d  = 0 , e  = 0 ;
+  const double seps = std::sqrt ( s_EPS ) ;
+  //
+  for ( unsigned short iter = 0 ; iter < maxiter ; ++iter )
+  {
+    const double xm   = 0.5 * ( lo + hi ) ;
+    const double tol1 = seps * std::abs ( x ) + xtol / 3 ;
+    const double tol2 = 2 * tol1 ;
+    if ( std::abs ( x - xm ) <= tol2 - 0.5 * ( hi - lo ) ) { break ; }  // BREAK
+    //
+    bool golden = true ;
+    if ( std::abs ( e ) > tol1 )
+    {
+      // parabolic fit
+      double r = ( x - w ) * ( fx - fv ) ;
+      double q = ( x - v ) * ( fx - fw ) ;
+      double p = ( x - v ) * q - ( x - w ) * r ;
+      q = 2 * ( q - r ) ;
+      if ( 0 < q ) { p = -p ; } else { q = -q ; }
+      const double etemp = e ;
+      if ( std::abs ( p ) < std::abs ( 0.5 * q * etemp ) &&
+           p > q * ( lo - x ) && p < q * ( hi - x ) )
+      {
+        e = d ;
+        d = p / q ;
+        const double u = x + d ;
+        if ( u - lo < tol2 || hi - u < tol2 ) { d = xm >= x ? tol1 : -tol1 ; }
+        golden = false ;
+      }
+    }
+    if ( golden )
+    {
+      e = x >= xm ? lo - x : hi - x ;
+      d = s_GOLD * e ;
+    }
+    //
+    const double u  = std::abs ( d ) >= tol1 ? x + d : x + ( 0 < d ? tol1 : -tol1 ) ;
+    const double fu = f ( u ) ;
+    //
+    if ( fu <= fx )
+    {
+      if ( u >= x ) { lo = x ; } else { hi = x ; }
+      v = w ; fv = fw ;
+      w = x ; fw = fx ;
+      x = u ; fx = fu ;
+    }
+    else
+    {
+      if ( u < x ) { lo = u ; } else { hi = u ; }
+      if ( fu <= fw || w == x )
+      { v = w ; fv = fw ; w = u ; fw = fu ; }
+      else if ( fu <= fv || v == x || v == w )
+      { v = u ; fv = fu ; }
+    }
+  }
+  return x ;
+}
+// ============================================================================
+// find the global maximum (mode) of the function at [a,b]
+// ============================================================================
+double Ostap::Math::Solver1D::mode_
+( Ostap::Math::Solver1D::function1 f     ,
+  const double                     a     ,
+  const double                     b     ,
+  const unsigned short             nscan )
+{
+  Ostap::Assert ( std::isfinite ( a ) && std::isfinite ( b ) ,
+                  "Invalid interval" , "Ostap::Math::Solver1D::mode" ) ;
+  //
+  const double       lo = std::min ( a , b ) ;
+  const double       hi = std::max ( a , b ) ;
+  const unsigned int N  = std::max ( 2u , (unsigned int) nscan ) ;
+  const double       dx = ( hi - lo ) / N ;
+  //
+  unsigned int ibest = 0 ;
+  double       fbest = -std::numeric_limits<double>::max () ;
+  for ( unsigned int i = 0 ; i <= N ; ++i )
+  {
+    const double fi = f ( lo + i * dx ) ;
+    if ( fi > fbest ) { fbest = fi ; ibest = i ; }
+  }
+  //
+  const double xl = lo + ( 0 < ibest ? ibest - 1 : 0     ) * dx ;
+  const double xr = lo + ( ibest < N ? ibest + 1 : N     ) * dx ;
+  const double xm = minimum_ ( [&f] ( const double x ) -> double { return -f ( x ) ; } ,
+                               xl , xr , 1.e-10 * ( hi - lo ) , 500 ) ;
+  return f ( xm ) >= fbest ? xm : lo + ibest * dx ;
+}
+// ============================================================================
+// find the points where the function is equal to factor*f(mode)
+// ============================================================================
+std::pair<double,double>
+Ostap::Math::Solver1D::width_
+( Ostap::Math::Solver1D::function1 f      ,
+  const double                     a      ,
+  const double                     b      ,
+  const double                     xmode  ,
+  const double                     factor )
+{
+  const double lo = std::min ( a , b ) ;
+  const double hi = std::max ( a , b ) ;
+  const double m0 = ( lo < xmode && xmode < hi ) ? xmode : mode_ ( f , lo , hi , 64 ) ;
+  const double v0 = f ( m0 ) * factor ;
+  //
+  auto fun = [&f,v0] ( const double x ) -> double { return f ( x ) - v0 ; } ;
+  const double x1 = 0 < fun ( lo ) ? lo : root_ ( fun , lo , m0 , 1.e-14 , 1.e-14 , 100 ) ;
+  const double x2 = 0 < fun ( hi ) ? hi : root_ ( fun , m0 , hi , 1.e-14 , 1.e-14 , 100 ) ;
+  return std::make_pair ( x1 , x2 ) ;
+}
+// ============================================================================
+// get the quantiles of the distribution at [a,b]
+// ============================================================================
+std::vector<double>
+Ostap::Math::Solver1D::quantiles_
+( Ostap::Math::Solver1D::function1 pdf   ,
+  const std::vector<double>&       probs ,
+  const double                     a     ,
+  const double                     b     ,
+  const unsigned short             nseg  )
+{
+  Ostap::Assert ( std::isfinite ( a ) && std::isfinite ( b ) && a < b ,
+                  "Invalid interval" , "Ostap::Math::Solver1D::quantiles" ) ;
+  //
+  const Ostap::Math::Integrator integrator {} ;
+  const unsigned int N  = std::max ( 1u , (unsigned int) nseg ) ;
+  const double       dx = ( b - a ) / N ;
+  //
+  // cumulative integrals at the edges of segments
+  std::vector<double> cumulative ( N + 1 , 0.0 ) ;
+  for ( unsigned int i = 0 ; i < N ; ++i )
+  {
+    const double xl = a + i * dx ;
+    const double xr = ( i + 1 == N ) ? b : xl + dx ;
+    cumulative [ i + 1 ] = cumulative [ i ] + integrator.integrate ( pdf , xl , xr ) ;
+  }
+  const double total = cumulative.back () ;
+  Ostap::Assert ( 0 < total , "Non-positive integral" , "Ostap::Math::Solver1D::quantiles" ) ;
+  //
+  std::vector<double> result ( probs.size () , 0.0 ) ;
+  for ( std::size_t k = 0 ; k < probs.size () ; ++k )
+  {
+    const double p = probs [ k ] ;
+    Ostap::Assert ( 0 <= p && p <= 1 , "Invalid quantile level" , "Ostap::Math::Solver1D::quantiles" ) ;
+    if      ( 0 == p ) { result [ k ] = a ; continue ; }
+    else if ( 1 == p ) { result [ k ] = b ; continue ; }
+    //
+    const double target = p * total ;
+    const std::size_t i = std::min<std::size_t>
+      ( N - 1 , std::upper_bound ( cumulative.begin () , cumulative.end () , target )
+        - cumulative.begin () - 1 ) ;
+    const double xl = a + i * dx ;
+    const double xr = ( i + 1 == N ) ? b : xl + dx ;
+    const double c0 = cumulative [ i ] ;
+    //
+    auto fun = [&] ( const double x ) -> double
+      { return c0 + ( x <= xl ? 0.0 : integrator.integrate ( pdf , xl , x ) ) - target ; } ;
+    const double fl = c0 - target ;
+    const double fr = cumulative [ i + 1 ] - target ;
+    if      ( 0 <= fl ) { result [ k ] = xl ; }
+    else if ( fr <= 0 ) { result [ k ] = xr ; }
+    else                { result [ k ] = root_ ( fun , xl , xr , 1.e-12 * ( b - a ) , 1.e-12 , 100 ) ; }
+  }
+  return result ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -5,6 +5,7 @@
 // ============================================================================
 // STD & STL
 // ============================================================================
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <cmath>
@@ -25,6 +26,15 @@
  *  @date 26/06/2001
  *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
  */
+namespace 
+{
+  // ==========================================================================
+  /// the block size for the bulk updates 
+  const std::size_t s_BLOCK = 1024 ;
+  /// number of independent lanes 
+  const std::size_t s_LANES =    8 ;
+  // ==========================================================================
+}
 // ============================================================================
 /* The full contructor from all important values
  * @see StatEntity::format
@@ -187,6 +197,100 @@ Ostap::StatEntity::add ( const Ostap::StatEntity& other )
   return *this ;
 }
 // ============================================================================
+/*  add the array of values 
+ *  The values are processed in blocks: the block statistics 
+ *  are accumulated in several independent lanes, the second moment 
+ *  is calculated in the second (corrected) pass over the block 
+ *  and the block is folded into the counter once. 
+ *  @param begin (INPUT) begin of the sequence of values 
+ *  @param end   (INPUT) end   of the sequence of values 
+ *  @return self-reference 
+ */
+// ============================================================================
+Ostap::StatEntity& 
+Ostap::StatEntity::add 
+( const double* begin , 
+  const double* end   ) 
+{
+  if ( !begin || end <= begin ) { return *this ; }               // RETURN 
+  //
+  for ( const double* first = begin ; first < end ; first += s_BLOCK ) 
+  {
+    const std::size_t nb   = std::min ( s_BLOCK , std::size_t ( end - first ) ) ;
+    const std::size_t nl   = nb - nb % s_LANES ;
+    //
+    // (1) the first pass: sum, min & max 
+    double s1   [ s_LANES ] = {} ;
+    double vmin [ s_LANES ] ;
+    double vmax [ s_LANES ] ;
+    std::fill ( vmin , vmin + s_LANES , first [ 0 ] ) ;
+    std::fill ( vmax , vmax + s_LANES , first [ 0 ] ) ;
+    //
+    for ( std::size_t i = 0 ; i < nl ; i += s_LANES ) 
+    {
+      for ( std::size_t k = 0 ; k < s_LANES ; ++k ) 
+      {
+        const double v = first [ i + k ] ;
+        s1   [ k ] += v ;
+        vmin [ k ]  = v < vmin [ k ] ? v : vmin [ k ] ;
+        vmax [ k ]  = v > vmax [ k ] ? v : vmax [ k ] ;
+      }
+    }
+    for ( std::size_t i = nl ; i < nb ; ++i ) 
+    {
+      const double v = first [ i ] ;
+      s1   [ 0 ] += v ;
+      vmin [ 0 ]  = v < vmin [ 0 ] ? v : vmin [ 0 ] ;
+      vmax [ 0 ]  = v > vmax [ 0 ] ? v : vmax [ 0 ] ;
+    }
+    //
+    long double sum = 0  ;
+    double      mn  = vmin [ 0 ] ;
+    double      mx  = vmax [ 0 ] ;
+    for ( std::size_t k = 0 ; k < s_LANES ; ++k ) 
+    {
+      sum += s1   [ k ] ;
+      mn   = std::min ( mn , vmin [ k ] ) ;
+      mx   = std::max ( mx , vmax [ k ] ) ;
+    }
+    const double mu = std::min ( mx , std::max ( mn , double ( sum / nb ) ) ) ;
+    //
+    // (2) the second pass: the corrected sum of squared deviations 
+    double d1 [ s_LANES ] = {} ;
+    double d2 [ s_LANES ] = {} ;
+    for ( std::size_t i = 0 ; i < nl ; i += s_LANES ) 
+    {
+      for ( std::size_t k = 0 ; k < s_LANES ; ++k ) 
+      {
+        const double d = first [ i + k ] - mu ;
+        d1 [ k ] += d     ;
+        d2 [ k ] += d * d ;
+      }
+    }
+    for ( std::size_t i = nl ; i < nb ; ++i ) 
+    {
+      const double d = first [ i ] - mu ;
+      d1 [ 0 ] += d     ;
+      d2 [ 0 ] += d * d ;
+    }
+    long double c1 = 0 ;
+    long double c2 = 0 ;
+    for ( std::size_t k = 0 ; k < s_LANES ; ++k ) { c1 += d1 [ k ] ; c2 += d2 [ k ] ; }
+    //
+    // (3) fold the block into the counter 
+    StatEntity block ;
+    block.m_n   = nb ;
+    block.m_mu  = mu + c1 / nb ;
+    block.m_mu2 = std::max ( 0.0L , ( c2 - c1 * c1 / nb ) / nb ) ;
+    block.m_min = mn ;
+    block.m_max = mx ;
+    //
+    add ( block ) ;
+  }
+  //
+  return *this ;
+}
+// ============================================================================
 // comparison
 // ============================================================================
 bool Ostap::StatEntity::operator< ( const Ostap::StatEntity& right ) const
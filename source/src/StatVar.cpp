@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <set>
 #include <random>
+#include <array>
 // ============================================================================
 // ROOT
 // ============================================================================
@@ -20,7 +21,6 @@
 // Ostap
 // ============================================================================
 #include "Ostap/Formula.h"
-#include "Ostap/Iterator.h"
 #include "Ostap/Notifier.h"
 #include "Ostap/MatrixUtils.h"
 #include "Ostap/StatVar.h"
@@ -33,6 +33,8 @@
 // ============================================================================
 #include "OstapDataFrame.h"
 #include "Exception.h"
+#include "local_mt.h"
+#include "local_columns.h"
 // ============================================================================
 /** @file
  *  Implementation file for class Ostap::StatVar
@@ -60,10 +62,7 @@ namespace
                     "Invalid varset"               , 
                     "Ostap::StatVar::make_formula" ) ;
     //
-    Ostap::Utils::Iterator iter ( *aset );
-    //
-    RooAbsArg* coef = 0 ;
-    while ( ( coef = (RooAbsArg*) iter.next() ) ) { alst.add ( *coef ); }
+    alst.add ( *aset ) ;
     //
     auto result = std::make_unique<Ostap::FormulaVar> ( expression , alst , false ) ;
     Ostap::Assert ( result && result->ok()                   , 
@@ -72,6 +71,93 @@ namespace
     return result ;
   }
   // ==========================================================================
+  /** @class StatVarsWorker
+   *  helper class to process the chunk of entries for 
+   *  multithreaded Ostap::StatVar::statVarsMT
+   *  - formulas are created for per-thread copy of the tree 
+   *  - results for the chunk are stored at the position, 
+   *    defined by the chunk  index
+   */
+  class StatVarsWorker 
+  {
+  public:
+    // ========================================================================
+    typedef Ostap::StatVar::Statistics        Statistics ;
+    typedef std::unique_ptr<Ostap::Formula>   UOF        ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    StatVarsWorker
+    ( TTree*                       tree        , 
+      const Ostap::StatVar::Names& expressions , 
+      const std::string&           cuts        , 
+      std::vector<Statistics>&     results     ) 
+      : m_tree     ( tree     ) 
+      , m_results  ( &results ) 
+    {
+      m_formulas.reserve ( expressions.size() ) ;
+      for ( const auto& e : expressions ) 
+      {
+        auto p = std::make_unique<Ostap::Formula> ( e , m_tree ) ;
+        Ostap::Assert ( p && p->ok()                      , 
+                        "Invalid formula:\"" + e + "\""   , 
+                        "Ostap::StatVar::statVarsMT"      ) ;
+        m_formulas.push_back ( std::move ( p ) ) ;
+      }
+      if ( !cuts.empty() ) 
+      {
+        m_cuts = std::make_unique<Ostap::Formula> ( cuts , m_tree ) ;
+        Ostap::Assert ( m_cuts->ok()                         , 
+                        "Invalid selection:\"" + cuts + "\"" , 
+                        "Ostap::StatVar::statVarsMT"         ) ;
+      }
+      m_notifier = std::make_unique<Ostap::Utils::Notifier> 
+        ( m_formulas.begin() , m_formulas.end() , m_cuts.get() , m_tree ) ;
+    }
+    // ========================================================================
+    /// process the chunk 
+    void operator() ( const Ostap::Utils::Chunk& chunk , 
+                      const std::size_t          index ) 
+    {
+      Statistics& result = ( *m_results ) [ index ] ;
+      const std::size_t N = m_formulas.size() ;
+      for ( unsigned long entry = chunk.first ; entry < chunk.last ; ++entry )
+      {
+        //
+        long ievent = m_tree->GetEntryNumber ( entry ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        ievent      = m_tree->LoadTree ( ievent ) ;
+        if ( 0 > ievent ) { return ; }                        // RETURN
+        //
+        const double w = m_cuts ? m_cuts->evaluate() : 1.0 ;
+        if ( !w ) { continue  ; }
+        //
+        for ( std::size_t i = 0 ; i < N ; ++i ) 
+        {
+          m_formulas [ i ] ->evaluate ( m_values ) ;
+          for ( const double r : m_values ) { result [ i ].add ( r , w ) ; }
+        }
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the tree 
+    TTree*                                  m_tree     { nullptr } ; // the tree 
+    /// results (per chunk) 
+    std::vector<Statistics>*                m_results  { nullptr } ; // results 
+    /// formulas 
+    std::vector<UOF>                        m_formulas {} ; // formulas 
+    /// selection 
+    UOF                                     m_cuts     {} ; // selection 
+    /// helper vector of the results 
+    std::vector<double>                     m_values   {} ; // helper vector    
+    /// notifier (must be destroyed before formulas!)
+    std::unique_ptr<Ostap::Utils::Notifier> m_notifier {} ; // notifier 
+    // ========================================================================
+  } ;
+  // ==========================================================================
   /** get the number of equivalent entries 
    *  \f$ n_{eff} \equiv = \frac{ (\sum w)^2}{ \sum w^2} \f$
    */
@@ -190,8 +276,14 @@ namespace
     long double mom   = 0    ;
     long double sumw  = 0    ;
     bool        empty = true ;
+    //
+    // column-wise evaluation for RooDataSet 
+    const bool done = !cut_range && columns_loop 
+      ( data , { &expr } , cuts , first , last , 
+        [&mom,&sumw,&empty,center,order] ( const double* v , const double w ) 
+        { mom += w * std::pow ( v [ 0 ] - center , order ) ; sumw += w ; empty = false ; } ) ;
     //  
-    for ( unsigned long entry = first ; entry < last ; ++entry )
+    for ( unsigned long entry = first ; !done && entry < last ; ++entry )
     {
       const RooArgSet* vars = data.get( entry ) ;
       if ( nullptr == vars )                              { break    ; } // BREAK 
@@ -681,6 +773,31 @@ namespace
     return Ostap::StatVar::Quantiles ( std::vector<double>( qs.begin (), qs.end () )  , num ) ;
   }
   // ==========================================================================
+  /** pick the (exact) quantiles from the collected values
+   *  @param values    (UPDATE) the values (reordered)
+   *  @param quantiles (INPUT)  the ordered quantiles 0 < q < 1 
+   */
+  Ostap::StatVar::Quantiles 
+  _pick_quantiles_
+  ( std::vector<double>&    values    ,
+    const std::set<double>& quantiles ) 
+  {
+    std::vector<double> result ; result.reserve ( quantiles.size() ) ;
+    if ( values.empty () ) 
+    { return Ostap::StatVar::Quantiles ( std::vector<double> ( quantiles.size () , 0.0 ) , 0 ) ; }
+    //
+    std::vector<double>::iterator start = values.begin() ;
+    for ( const double q : quantiles )
+    {
+      const unsigned long current = values.size() * q ;
+      std::nth_element  ( start , values.begin () + current , values.end () ) ;
+      start = values.begin() + current ;
+      result.push_back ( *start ) ;
+    }
+    //
+    return Ostap::StatVar::Quantiles ( result , values.size () ) ; 
+  }
+  // ==========================================================================
   /*   get quantile of the distribution  
    *   @param tree  (INPUT) the input tree 
    *   @param q     (INPUT) quantile value   0 < q < 1  
@@ -705,8 +822,16 @@ namespace
     //
     const bool  weighted = data.isWeighted () ;
     //
+    typedef std::vector<double> VALUES ;
+    VALUES values{} ;
+    //
+    // column-wise evaluation for RooDataSet (single pass)
+    const bool done = !cut_range && columns_loop 
+      ( data , { &var } , cuts , first , the_last , 
+        [&values] ( const double* v , const double /* w */ ) { values.push_back ( v [ 0 ] ) ; } ) ;
+    //
     unsigned long num = 0 ;
-    for ( unsigned long entry = first ; entry < the_last ; ++entry )
+    for ( unsigned long entry = first ; !done && entry < the_last ; ++entry )
     {
       const RooArgSet* vars = data.get( entry ) ;
       if ( nullptr == vars )                              { break    ; } // BREAK 
@@ -725,10 +850,9 @@ namespace
       ++num ;
     }
     //
-    typedef std::vector<double> VALUES ;
-    VALUES values{} ; values.reserve ( num ) ;
+    if ( !done ) { values.reserve ( num ) ; }
     //
-    for ( unsigned long entry = first ; entry < the_last ; ++entry )
+    for ( unsigned long entry = first ; !done && entry < the_last ; ++entry )
     {
       const RooArgSet* vars = data.get( entry ) ;
       if ( nullptr == vars )                              { break    ; } // BREAK 
@@ -747,18 +871,7 @@ namespace
       values.push_back ( var.getVal() ) ;
     }
     //
-    std::vector<double> result ; result.reserve ( quantiles.size() ) ;
-    //
-    VALUES::iterator start = values.begin() ;
-    for ( const double q : quantiles )
-    {
-      const unsigned long current = values.size() * q ;
-      std::nth_element  ( start , values.begin () + current , values.end () ) ;
-      start = values.begin() + current ;
-      result.push_back ( *start ) ;
-    }
-    //
-    return Ostap::StatVar::Quantiles ( result , values.size () ) ; 
+    return _pick_quantiles_ ( values , quantiles ) ;
   }
   // ==========================================================================
   /*   get (Appeoximate) quantile of the distribution using  P^2 algorithm  
@@ -788,7 +901,14 @@ namespace
     std::vector<Ostap::Math::GSL::P2Quantile> qs ( quantiles.begin() , quantiles.end() ) ;
     //
     unsigned long num = 0 ;
-    for ( unsigned long entry = first ; entry < the_last ; ++entry )
+    //
+    // column-wise evaluation for RooDataSet 
+    const bool done = !cut_range && columns_loop 
+      ( data , { &var } , cuts , first , the_last , 
+        [&qs,&num] ( const double* v , const double /* w */ ) 
+        { for ( auto& q : qs ) { q.add ( v [ 0 ] ) ; } ++num ; } ) ;
+    //
+    for ( unsigned long entry = first ; !done && entry < the_last ; ++entry )
     {
       const RooArgSet* vars = data.get( entry ) ;
       if ( nullptr == vars )                              { break    ; } // BREAK 
@@ -1357,6 +1477,88 @@ unsigned long Ostap::StatVar::statVars
   return statVars ( tree , result , expressions , _cuts , first , last ) ;
 }
 // ============================================================================
+/*  build statistic for the <code>expression</code> using several threads
+ *  @param tree       (INPUT) the tree 
+ *  @param expression (INPUT) the expression
+ *  @param cuts       (INPUT) the selection criteria 
+ *  @param nthreads   (INPUT) number of threads 
+ *  @param first      (INPUT) the first entry 
+ *  @param last       (INPUT) the last entry
+ *  @see Ostap::StatVar::statVar
+ *  @date   2023-01-12
+ */
+// ============================================================================
+Ostap::StatVar::Statistic
+Ostap::StatVar::statVarMT
+( TTree*              tree       ,
+  const std::string&  expression ,
+  const std::string&  cuts       ,
+  const unsigned int  nthreads   , 
+  const unsigned long first      ,
+  const unsigned long last       )
+{
+  Statistics result ;
+  statVarsMT ( tree , result , Names ( 1 , expression ) , cuts , nthreads , first , last ) ;
+  return result.empty() ? Statistic () : result.front () ;
+}
+// ============================================================================
+/*  build statistic for the <code>expressions</code> using several threads
+ *  @param tree        (INPUT)  the tree 
+ *  @param result      (UPDATE) the output statistics for specified expressions 
+ *  @param expressions (INPUT)  the list of  expressions
+ *  @param cuts        (INPUT)  the selection criteria 
+ *  @param nthreads    (INPUT)  number of threads
+ *  @param first       (INPUT)  the first entry to process 
+ *  @param last        (INPUT)  the last entry to process (not including!)
+ *  @return number of processed entries 
+ *  @see Ostap::StatVar::statVars
+ *  @date   2023-01-12
+ */
+// ============================================================================
+unsigned long Ostap::StatVar::statVarsMT
+( TTree*                                  tree        ,  
+  std::vector<Ostap::StatVar::Statistic>& result      ,  
+  const Ostap::StatVar::Names&            expressions ,
+  const std::string&                      cuts        ,
+  const unsigned int                      nthreads    , 
+  const unsigned long                     first       ,
+  const unsigned long                     last        ) 
+{
+  //
+  const unsigned int nt = Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) ) 
+  { return statVars ( tree , result , expressions , cuts , first , last ) ; }
+  //
+  const unsigned int N = expressions.size() ;
+  //
+  result.resize ( N ) ; 
+  for ( auto& r : result ) { r.reset () ; }
+  //
+  if ( 0 == tree || last <= first ) { return 0 ; }  // RETURN
+  if ( expressions.empty()        ) { return 0 ; }  // RETURN  
+  //
+  // validate the expressions and selection using the original tree 
+  if ( !cuts.empty() && !Ostap::Formula ( cuts , tree ).ok() ) { return 0 ; } 
+  for ( const auto& e : expressions ) 
+  { if ( !Ostap::Formula ( e , tree ).ok() ) { return 0 ; } }
+  //
+  // split the range of entries into chunks (a few chunks per thread) 
+  const Ostap::Utils::Chunks chunks = Ostap::Utils::clusters ( tree , first , last , 4 * nt ) ;
+  //
+  std::vector<Statistics> partial ( chunks.size () , Statistics ( N ) ) ;
+  //
+  Ostap::Utils::process_chunks 
+    ( tree , chunks , nt , 
+      [&expressions,&cuts,&partial] ( TTree* t ) 
+      { return StatVarsWorker ( t , expressions , cuts , partial ) ; } ) ;
+  //
+  // merge partial results in the order of chunks 
+  for ( const auto& p : partial ) 
+  { for ( unsigned int i = 0 ; i < N ; ++i ) { result [ i ] += p [ i ] ; } }
+  //
+  return result [ 0 ] .nEntries () ;
+}
+// ============================================================================
 /*  calculate the covariance of two expressions
  *  @param tree  (INPUT)  the input tree
  *  @param exp1  (INPUT)  the first  expresiion
@@ -1568,6 +1770,244 @@ Ostap::StatVar::statCov
                    first , last    ) ;
 }
 // ============================================================================
+/*  calculate the statistics and covariances for several expressions 
+ *  in a single pass over the tree
+ *  @param tree        (INPUT)  the input tree 
+ *  @param expressions (INPUT)  the list of expressions 
+ *  @param cuts        (INPUT)  the selection criteria (used as weight) 
+ *  @param stats       (UPDATE) the statistics for the expressions 
+ *  @param cov2        (UPDATE) the packed covariance matrix 
+ *  @param first       (INPUT)  the first entry to process 
+ *  @param last        (INPUT)  the last entry to process (not including!)
+ *  @return number of processed events 
+ *  @date   2023-01-16
+ */
+// ============================================================================
+unsigned long
+Ostap::StatVar::statCov
+( TTree*                       tree        ,
+  const Ostap::StatVar::Names& expressions , 
+  const std::string&           cuts        ,
+  Ostap::StatVar::Statistics&  stats       , 
+  std::vector<double>&         cov2        , 
+  const unsigned long          first       ,
+  const unsigned long          last        ) 
+{
+  //
+  const unsigned int N = expressions.size() ;
+  //
+  stats.resize ( N ) ;
+  for ( auto& s : stats ) { s.reset () ; }
+  cov2 .assign ( N * ( N + 1 ) / 2 , 0.0 ) ;
+  //
+  if ( 0 == tree || last <= first ) { return 0 ; }              // RETURN
+  if ( expressions.empty()        ) { return 0 ; }              // RETURN  
+  //
+  typedef std::unique_ptr<Ostap::Formula> UOF ;
+  std::vector<UOF> formulas ; formulas.reserve ( N ) ;
+  for ( const auto& e : expressions  ) 
+  {
+    auto p = std::make_unique<Ostap::Formula>( e , tree ) ;
+    if ( !p || !p->ok() ) { return 0 ; }                        // RETURN 
+    formulas.push_back ( std::move ( p ) ) ;
+  }
+  //
+  UOF selection {} ;
+  if ( !cuts.empty() ) 
+  {
+    selection = std::make_unique<Ostap::Formula> ( cuts , tree ) ;
+    if ( !selection->ok() ) { return 0 ; }                      // RETURN
+  }
+  //
+  Ostap::Utils::Notifier notify ( formulas.begin() , formulas.end() , selection.get() , tree ) ;
+  //
+  const unsigned long nEntries =
+    std::min ( last , (unsigned long) tree->GetEntries() ) ;
+  //
+  std::vector<long double> sums   ( N * ( N + 1 ) / 2 , 0.0L ) ;
+  std::vector<double>      values ( N , 0.0 ) ;
+  std::vector<double>      results {} ;
+  //
+  for ( unsigned long entry = first ; entry < nEntries ; ++entry )
+  {
+    //
+    long ievent = tree->GetEntryNumber ( entry ) ;
+    if ( 0 > ievent ) { break ; }                              // BREAK 
+    //
+    ievent      = tree->LoadTree ( ievent ) ;
+    if ( 0 > ievent ) { break ; }                              // BREAK
+    //
+    // evaluate the selection only once 
+    const double w = selection ? selection->evaluate() : 1.0 ;
+    if ( !w ) { continue ; }                                   // ATTENTION
+    //
+    // evaluate each expression only once 
+    bool valid = true ;
+    for ( unsigned int i = 0 ; i < N && valid ; ++i ) 
+    {
+      formulas [ i ] ->evaluate ( results ) ;
+      if ( results.empty() ) { valid = false ; }
+      else                   { values [ i ] = results.front () ; }
+    }
+    if ( !valid ) { continue ; }                               // CONTINUE 
+    //
+    for ( unsigned int i = 0 ; i < N ; ++i ) 
+    {
+      const long double vi = values [ i ] ;
+      stats [ i ].add ( vi , w ) ;
+      const unsigned int ii = i * ( i + 1 ) / 2 ; 
+      for ( unsigned int j = 0 ; j <= i ; ++j ) 
+      { sums [ ii + j ] += w * vi * values [ j ] ; }
+    }
+  }
+  //
+  if ( 0 == stats[0].nEntries() || 0 == stats[0].nEff () ) { return 0 ; }
+  //
+  const long double sumw = stats[0].weights().sum() ;
+  for ( unsigned int i = 0 ; i < N ; ++i ) 
+  {
+    const long double mi = stats [ i ].mean() ;
+    const unsigned int ii = i * ( i + 1 ) / 2 ; 
+    for ( unsigned int j = 0 ; j <= i ; ++j ) 
+    { cov2 [ ii + j ] = sums [ ii + j ] / sumw - mi * stats [ j ].mean() ; }
+  }
+  //
+  return stats[0].nEntries() ;
+}
+// ============================================================================
+/*  calculate the statistics and covariances for several expressions 
+ *  in a single pass over the tree
+ *  @param tree        (INPUT)  the input tree 
+ *  @param expressions (INPUT)  the list of expressions 
+ *  @param stats       (UPDATE) the statistics for the expressions 
+ *  @param cov2        (UPDATE) the packed covariance matrix 
+ *  @param first       (INPUT)  the first entry to process 
+ *  @param last        (INPUT)  the last entry to process (not including!)
+ *  @return number of processed events 
+ *  @date   2023-01-16
+ */
+// ============================================================================
+unsigned long
+Ostap::StatVar::statCov
+( TTree*                       tree        ,
+  const Ostap::StatVar::Names& expressions , 
+  Ostap::StatVar::Statistics&  stats       , 
+  std::vector<double>&         cov2        , 
+  const unsigned long          first       ,
+  const unsigned long          last        ) 
+{ return statCov ( tree , expressions , std::string() , stats , cov2 , first , last ) ; }
+// ============================================================================
+/*  calculate the statistics and covariances for several expressions 
+ *  in a single pass over the tree
+ *  @param tree        (INPUT)  the input tree 
+ *  @param expressions (INPUT)  the list of expressions 
+ *  @param cuts        (INPUT)  the selection criteria (used as weight) 
+ *  @param stats       (UPDATE) the statistics for the expressions 
+ *  @param cov2        (UPDATE) the packed covariance matrix 
+ *  @param first       (INPUT)  the first entry to process 
+ *  @param last        (INPUT)  the last entry to process (not including!)
+ *  @return number of processed events 
+ *  @date   2023-01-16
+ */
+// ============================================================================
+unsigned long
+Ostap::StatVar::statCov
+( TTree*                       tree        ,
+  const Ostap::StatVar::Names& expressions , 
+  const TCut&                  cuts        , 
+  Ostap::StatVar::Statistics&  stats       , 
+  std::vector<double>&         cov2        , 
+  const unsigned long          first       ,
+  const unsigned long          last        ) 
+{
+  const std::string _cuts = cuts.GetTitle() ;
+  return statCov ( tree , expressions , _cuts , stats , cov2 , first , last ) ; 
+}
+// ============================================================================
+/*  calculate the statistics and covariances for several expressions 
+ *  in a single pass over the tree using the mergeable counter
+ *  @param tree        (INPUT)  the input tree 
+ *  @param expressions (INPUT)  the list of expressions 
+ *  @param cuts        (INPUT)  the selection criteria (used as weight) 
+ *  @param result      (UPDATE) the counter 
+ *  @param first       (INPUT)  the first entry to process 
+ *  @param last        (INPUT)  the last entry to process (not including!)
+ *  @return number of processed events 
+ *  @see Ostap::Math::Covariances
+ *  @date   2026-10-15
+ */
+// ============================================================================
+unsigned long
+Ostap::StatVar::statCov
+( TTree*                       tree        ,
+  const Ostap::StatVar::Names& expressions , 
+  const std::string&           cuts        ,
+  Ostap::Math::Covariances&    result      , 
+  const unsigned long          first       ,
+  const unsigned long          last        ) 
+{
+  //
+  const unsigned int N = expressions.size() ;
+  result = Ostap::Math::Covariances ( N ) ;
+  //
+  if ( 0 == tree || last <= first ) { return 0 ; }              // RETURN
+  if ( expressions.empty()        ) { return 0 ; }              // RETURN  
+  //
+  typedef std::unique_ptr<Ostap::Formula> UOF ;
+  std::vector<UOF> formulas ; formulas.reserve ( N ) ;
+  for ( const auto& e : expressions  ) 
+  {
+    auto p = std::make_unique<Ostap::Formula>( e , tree ) ;
+    if ( !p || !p->ok() ) { return 0 ; }                        // RETURN 
+    formulas.push_back ( std::move ( p ) ) ;
+  }
+  //
+  UOF selection {} ;
+  if ( !cuts.empty() ) 
+  {
+    selection = std::make_unique<Ostap::Formula> ( cuts , tree ) ;
+    if ( !selection->ok() ) { return 0 ; }                      // RETURN
+  }
+  //
+  Ostap::Utils::Notifier notify ( formulas.begin() , formulas.end() , selection.get() , tree ) ;
+  //
+  const unsigned long nEntries =
+    std::min ( last , (unsigned long) tree->GetEntries() ) ;
+  //
+  Ostap::Math::CovariancesBuffer block ( N ) ;
+  std::vector<double> values ( N , 0.0 ) ;
+  std::vector<double> results {} ;
+  //
+  for ( unsigned long entry = first ; entry < nEntries ; ++entry )
+  {
+    //
+    long ievent = tree->GetEntryNumber ( entry ) ;
+    if ( 0 > ievent ) { break ; }                              // BREAK 
+    //
+    ievent      = tree->LoadTree ( ievent ) ;
+    if ( 0 > ievent ) { break ; }                              // BREAK
+    //
+    // evaluate the selection only once 
+    const double w = selection ? selection->evaluate() : 1.0 ;
+    if ( !w ) { continue ; }                                   // ATTENTION
+    //
+    // evaluate each expression only once 
+    bool valid = true ;
+    for ( unsigned int i = 0 ; i < N && valid ; ++i ) 
+    {
+      formulas [ i ] ->evaluate ( results ) ;
+      if ( results.empty() ) { valid = false ; }
+      else                   { values [ i ] = results.front () ; }
+    }
+    if ( !valid ) { continue ; }                               // CONTINUE 
+    //
+    block.add ( values.data () , w ) ;
+  }
+  //
+  result = block.flush () ;
+  return result.n () ;
+}
+// ============================================================================
 
 // ============================================================================
 Ostap::StatVar::Statistic
@@ -1615,6 +2055,12 @@ Ostap::StatVar::statVar
   //
   const unsigned long the_last  = std::min ( last , (unsigned long) data->numEntries() ) ;
   //
+  // column-wise evaluation for RooDataSet 
+  if ( !cutrange && columns_loop 
+       ( *data , { formula.get() } , selection.get() , first , the_last , 
+         [&result] ( const double* v , const double w ) { result.add ( v [ 0 ] , w ) ; } ) ) 
+  { return result ; }                                           // RETURN 
+  //
   // start the loop
   for ( unsigned long entry = first ; entry < the_last ; ++entry )
   {
@@ -1743,6 +2189,19 @@ Ostap::StatVar::statVars
   //
   const unsigned long the_last  = std::min ( last , (unsigned long) data->numEntries() ) ;
   //
+  // column-wise evaluation for RooDataSet 
+  if ( !cutrange ) 
+  {
+    std::vector<const RooAbsReal*> exprs ( formulas.size () , nullptr ) ;
+    std::transform ( formulas.begin () , formulas.end () , exprs.begin () , 
+                     [] ( const UOF& f ) { return f.get () ; } ) ;
+    if ( columns_loop 
+         ( *data , exprs , selection.get() , first , the_last , 
+           [&result,N] ( const double* v , const double w )
+           { for ( unsigned int i = 0 ; i < N ; ++i ) { result [ i ].add ( v [ i ] , w ) ; } } ) ) 
+    { return result.empty() ? 0 : result[0].nEntries() ; }      // RETURN 
+  }
+  //
   // start the loop
   for ( unsigned long entry = first ; entry < the_last ; ++entry )
   {
@@ -1812,7 +2271,19 @@ Ostap::StatVar::statCov
   //
   const unsigned long nEntries = std::min ( last , (unsigned long) data->numEntries() ) ;
   //
-  for ( unsigned long entry = first ; entry < nEntries ; ++entry )
+  // column-wise evaluation for RooDataSet 
+  const bool done = !cutrange && columns_loop 
+    ( *data , { formula1.get() , formula2.get() } , nullptr , first , nEntries , 
+      [&stat1,&stat2,&cov2] ( const double* v , const double w ) 
+      {
+        stat1.add ( v [ 0 ] , w ) ;
+        stat2.add ( v [ 1 ] , w ) ;
+        cov2 ( 0 , 0 ) += w * v [ 0 ] * v [ 0 ] ;
+        cov2 ( 0 , 1 ) += w * v [ 0 ] * v [ 1 ] ;
+        cov2 ( 1 , 1 ) += w * v [ 1 ] * v [ 1 ] ;
+      } ) ;
+  //
+  for ( unsigned long entry = first ; !done && entry < nEntries ; ++entry )
   {
     //
     const RooArgSet* vars = data->get( entry ) ;
@@ -1892,7 +2363,19 @@ Ostap::StatVar::statCov
  //
   const unsigned long nEntries = std::min ( last , (unsigned long) data->numEntries() ) ;
   //
-  for ( unsigned long entry = first ; entry < nEntries ; ++entry )
+  // column-wise evaluation for RooDataSet 
+  const bool done = !cutrange && columns_loop 
+    ( *data , { formula1.get() , formula2.get() } , selection.get() , first , nEntries , 
+      [&stat1,&stat2,&cov2] ( const double* v , const double w ) 
+      {
+        stat1.add ( v [ 0 ] , w ) ;
+        stat2.add ( v [ 1 ] , w ) ;
+        cov2 ( 0 , 0 ) += w * v [ 0 ] * v [ 0 ] ;
+        cov2 ( 0 , 1 ) += w * v [ 0 ] * v [ 1 ] ;
+        cov2 ( 1 , 1 ) += w * v [ 1 ] * v [ 1 ] ;
+      } ) ;
+  //
+  for ( unsigned long entry = first ; !done && entry < nEntries ; ++entry )
   {
     //
     const RooArgSet* vars = data->get( entry ) ;
@@ -2496,7 +2979,14 @@ double Ostap::StatVar::nEff
   long double sumw  = 0    ;
   long double sumw2 = 0    ;
   bool        empty = true ; //  empty  dataset (after cuts&selection) ? 
-  for ( unsigned long entry = first ; entry < the_last ; ++entry )
+  //
+  // column-wise evaluation for RooDataSet 
+  const bool done = !cutrange && columns_loop 
+    ( data , {} , cut.get() , first , the_last , 
+      [&sumw,&sumw2,&empty] ( const double* /* v */ , const double w ) 
+      { sumw += w ; sumw2 += w * w ; empty = false ; } ) ;
+  //
+  for ( unsigned long entry = first ; !done && entry < the_last ; ++entry )
   {
     const RooArgSet* vars = data.get( entry ) ;
     if ( nullptr == vars )                            { break    ; } // BREAK 
@@ -2601,7 +3091,20 @@ Ostap::StatVar::moment
   long double c2    = 0 ;
   //
   bool        empty = true ;
-  for ( unsigned long entry = first ; entry < the_last ; ++entry )
+  //
+  // column-wise evaluation for RooDataSet 
+  const bool done = !cutrange && columns_loop 
+    ( data , { expression.get() } , cut.get() , first , the_last , 
+      [&mom,&sumw,&sumw2,&c2,&empty,order] ( const double* v , const double w ) 
+      {
+        mom   += w * std::pow ( v [ 0 ] , order     ) ;
+        sumw  += w     ;
+        sumw2 += w * w ;
+        c2    += w * std::pow ( v [ 0 ] , 2 * order ) ;
+        empty  = false ;
+      } ) ;
+  //
+  for ( unsigned long entry = first ; !done && entry < the_last ; ++entry )
   {
     const RooArgSet* vars = data.get( entry ) ;
     if ( nullptr == vars )                            { break    ; } // BREAK 
@@ -4063,6 +4566,165 @@ Ostap::StatVar::p2interval
   return QInterval ( Interval ( result.quantiles[0] , result.quantiles[1] ) , result.nevents ) ;
 }
 // ============================================================================
+/*  fill the mergeable quantile sketch (t-digest) for the distribution
+ *   @param tree   (INPUT)  the input tree
+ *   @param digest (UPDATE) the sketch to be updated
+ *   @param expr   (INPUT)  the expression
+ *   @param cuts   (INPUT)  selection cuts
+ *   @param first  (INPUT)  the first  event to process
+ *   @param last   (INPUT)  the last event to  process
+ *   @return number of added entries
+ */
+// ============================================================================
+unsigned long
+Ostap::StatVar::digest
+( TTree&                tree   ,
+  Ostap::Math::TDigest& digest ,
+  const std::string&    expr   ,
+  const std::string&    cuts   ,
+  const unsigned long   first  ,
+  const unsigned long   last   )
+{
+  Ostap::Formula var ( expr , &tree ) ;
+  Ostap::Assert ( var.ok()                              ,
+                  "Invalid expression:\"" + expr + "\"" ,
+                  "Ostap::StatVar::digest"              ) ;
+  //
+  std::unique_ptr<Ostap::Formula> cut { nullptr } ;
+  if  ( !cuts.empty() )
+  {
+    cut = std::make_unique<Ostap::Formula>( "", cuts , &tree ) ;
+    Ostap::Assert ( cut && cut->ok()               ,
+                    "Invalid cut:\"" + cuts + "\"" ,
+                    "Ostap::StatVar::digest"       ) ;
+  }
+  //
+  const unsigned long the_last = std::min ( last , (unsigned long) tree.GetEntries() ) ;
+  //
+  Ostap::Utils::Notifier notify ( &tree , &var , cut.get() ) ;
+  //
+  unsigned long num = 0  ;
+  std::vector<double> results {} ;
+  for ( unsigned long entry = first ; entry < the_last ; ++entry )
+  {
+    long ievent = tree.GetEntryNumber ( entry ) ;
+    if ( 0 > ievent ) { break ; }                        // BREAK
+    //
+    ievent      = tree.LoadTree ( ievent ) ;
+    if ( 0 > ievent ) { break ; }                        // BREAK
+    //
+    const long double w = cut ? cut->evaluate() : 1.0L ;
+    if ( !w  ) { continue ; }                            // CONTINUE
+    //
+    var.evaluate  ( results ) ;
+    digest.add ( results.begin() , results.end () ) ;
+    num += results.size() ;
+  }
+  //
+  return num ;
+}
+// ============================================================================
+/*  fill the mergeable quantile sketch (t-digest) for the distribution
+ *   @param data      (INPUT)  the input data
+ *   @param digest    (UPDATE) the sketch to be updated
+ *   @param expr      (INPUT)  the expression
+ *   @param cuts      (INPUT)  selection cuts
+ *   @param cut_range (INPUT)  cut range
+ *   @param first     (INPUT)  the first  event to process
+ *   @param last      (INPUT)  the last event to  process
+ *   @return number of added entries
+ */
+// ============================================================================
+unsigned long
+Ostap::StatVar::digest
+( const RooAbsData&     data      ,
+  Ostap::Math::TDigest& digest    ,
+  const std::string&    expr      ,
+  const std::string&    cuts      ,
+  const std::string&    cut_range ,
+  const unsigned long   first     ,
+  const unsigned long   last      )
+{
+  const unsigned long num_entries = data.numEntries() ;
+  const unsigned long the_last    = std::min ( num_entries , last ) ;
+  if ( the_last <= first ) { return  0 ; }    // RETURN
+  //
+  const char* cutrange  = cut_range.empty() ?  nullptr : cut_range.c_str() ;
+  //
+  const std::unique_ptr<Ostap::FormulaVar> expression { make_formula ( expr , data        ) } ;
+  const std::unique_ptr<Ostap::FormulaVar> cut        { make_formula ( cuts , data , true ) } ;
+  //
+  const bool  weighted = data.isWeighted () ;
+  //
+  unsigned long num = 0 ;
+  for ( unsigned long entry = first ; entry < the_last ; ++entry )
+  {
+    const RooArgSet* vars = data.get( entry ) ;
+    if ( nullptr == vars )                             { break    ; } // BREAK
+    //
+    if ( cutrange && !vars->allInRange ( cutrange ) ) { continue ; } // CONTINUE
+    // apply cuts:
+    const long double wc = cut ? cut -> getVal() : 1.0L ;
+    if ( !wc ) { continue ; }                                         // CONTINUE
+    // apply weight:
+    const long double wd = weighted  ? data.weight()   : 1.0L ;
+    if ( !wd ) { continue ; }                                         // CONTINUE
+    //
+    digest.add ( expression->getVal() ) ;
+    ++num ;
+  }
+  //
+  return num ;
+}
+// ============================================================================
+/*  fill the mergeable quantile sketch (t-digest) for the distribution
+ *   @param frame  (INPUT)  the input frame
+ *   @param digest (UPDATE) the sketch to be updated
+ *   @param expr   (INPUT)  the expression
+ *   @param cuts   (INPUT)  selection cuts
+ *   @return number of added entries
+ */
+// ============================================================================
+unsigned long
+Ostap::StatVar::digest
+( Ostap::DataFrame      frame  ,
+  Ostap::Math::TDigest& digest ,
+  const std::string&    expr   ,
+  const std::string&    cuts   )
+{
+  const bool no_cuts = trivial ( cuts ) ;
+  //
+  const std::string var   = Ostap::tmp_name ( "v_"   , expr ) ;
+  const std::string bcut  = Ostap::tmp_name ( "b_"   , cuts ) ;
+  // decorate the frame
+  auto t = frame
+    .Define   ( bcut    , no_cuts ? "true" : "(bool) ( " + cuts + " ) ;" )
+    .Filter   ( bcut    )
+    .Define   ( var     , "1.0*(" + expr + ")" ) ;
+  //
+  const unsigned int nSlots =
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
+  ROOT::GetThreadPoolSize     () ;
+#else
+  ROOT::GetImplicitMTPoolSize () ;
+#endif
+  //
+  // per-slot sketches, merged at the end
+  std::vector<Ostap::Math::TDigest> _digests
+    ( nSlots ? nSlots : 1 , Ostap::Math::TDigest ( digest.compression () ) ) ;
+  std::vector<unsigned long>        _nums    ( _digests.size () , 0 ) ;
+  //
+  auto fun = [&_digests,&_nums] ( unsigned int slot , double v )
+    { _digests [ slot ].add ( v ) ; ++_nums [ slot ] ; } ;
+  t.ForeachSlot ( fun ,  { var } ) ;
+  //
+  unsigned long num = 0 ;
+  for ( std::size_t i = 0 ; i < _digests.size () ; ++i )
+  { digest += _digests [ i ] ; num += _nums [ i ] ; }
+  //
+  return num ;
+}
+// ============================================================================
 /** get variables from dataset in form of the table 
  *  @param data input dataset
  *  @param vars list of variables
@@ -4257,6 +4919,458 @@ Ostap::StatVar::get_table
   }
   return NN ;
 }
+// ============================================================================
+/*  build statistic for the <code>expression</code> using several threads
+ *  @param data       (INPUT) the data 
+ *  @param expression (INPUT) the expression
+ *  @param cuts       (INPUT) the selection criteria/weight
+ *  @param nthreads   (INPUT) number of threads
+ *  @param first      (INPUT) the first entry 
+ *  @param last       (INPUT) the last entry
+ *  @see Ostap::StatVar::statVar
+ *  @date   2023-03-23
+ */
+// ============================================================================
+Ostap::StatVar::Statistic
+Ostap::StatVar::statVarMT
+( const RooAbsData*   data       ,
+  const std::string&  expression ,
+  const std::string&  cuts       ,
+  const unsigned int  nthreads   ,
+  const unsigned long first      ,
+  const unsigned long last       ) 
+{
+  std::vector<Statistic> result ;
+  statVarsMT ( data , result , Names ( 1 , expression ) , cuts , nthreads , first , last ) ;
+  return result.empty() ? Statistic () : result.front () ;
+}
+// ============================================================================
+/*  build statistic for the <code>expressions</code> using several threads
+ *  @param data        (INPUT)  the data 
+ *  @param result      (UPDATE) the output statistics for specified expressions 
+ *  @param expressions (INPUT)  the list of  expressions
+ *  @param cuts        (INPUT)  the selection criteria/weight 
+ *  @param nthreads    (INPUT)  number of threads
+ *  @param first       (INPUT)  the first entry to process 
+ *  @param last        (INPUT)  the last entry to process (not including!)
+ *  @return number of processed entries 
+ *  @see Ostap::StatVar::statVars
+ *  @date   2023-03-23
+ */
+// ============================================================================
+unsigned long Ostap::StatVar::statVarsMT
+( const RooAbsData*                       data        ,  
+  std::vector<Ostap::StatVar::Statistic>& result      ,  
+  const Ostap::StatVar::Names&            expressions ,
+  const std::string&                      cuts        ,
+  const unsigned int                      nthreads    , 
+  const unsigned long                     first       ,
+  const unsigned long                     last        ) 
+{
+  //
+  const unsigned int nt = Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt || nullptr == data ) 
+  { return statVars ( data , result , expressions , cuts , std::string () , first , last ) ; }
+  //
+  const unsigned int N = expressions.size() ;
+  //
+  result.resize ( N ) ; 
+  for ( auto& r : result ) { r.reset () ; }
+  //
+  if ( expressions.empty() || last <= first ) { return 0 ; }  // RETURN  
+  //
+  // validate the expressions and selection using the original data 
+  make_formula ( cuts , *data , true ) ;
+  for ( const auto& e : expressions ) { make_formula ( e , *data ) ; }
+  //
+  std::vector<Statistics> partial ;
+  const bool done = columns_loop_mt 
+    ( *data , expressions , cuts , first , last , nt , Statistics ( N ) , partial , 
+      [N] ( Statistics& r , const double* v , const double w ) 
+      { for ( unsigned int i = 0 ; i < N ; ++i ) { r [ i ].add ( v [ i ] , w ) ; } } ) ;
+  if ( !done ) 
+  { return statVars ( data , result , expressions , cuts , std::string () , first , last ) ; }
+  //
+  // merge partial results in the order of chunks 
+  for ( const auto& p : partial ) 
+  { for ( unsigned int i = 0 ; i < N ; ++i ) { result [ i ] += p [ i ] ; } }
+  //
+  return result [ 0 ] .nEntries () ;
+}
+// ============================================================================
+/*  calculate the covariance of two expressions using several threads 
+ *  @param data     (INPUT)  the input data
+ *  @param exp1     (INPUT)  the first  expresiion
+ *  @param exp2     (INPUT)  the second expresiion
+ *  @param cuts     (INPUT)  the selection criteria/weight 
+ *  @param stat1    (UPDATE) the statistic for the first  expression
+ *  @param stat2    (UPDATE) the statistic for the second expression
+ *  @param cov2     (UPDATE) the covariance matrix 
+ *  @param nthreads (INPUT)  number of threads
+ *  @param first    (INPUT)  the first entry to process 
+ *  @param last     (INPUT)  the last entry to process (not including!)
+ *  @return number of processed events 
+ *  @see Ostap::StatVar::statCov
+ *  @date   2023-03-23
+ */
+// ============================================================================
+unsigned long
+Ostap::StatVar::statCovMT
+( const RooAbsData*          data     ,
+  const std::string&         exp1     ,
+  const std::string&         exp2     ,
+  const std::string&         cuts     ,
+  Ostap::StatVar::Statistic& stat1    ,
+  Ostap::StatVar::Statistic& stat2    ,
+  Ostap::SymMatrix2x2&       cov2     ,
+  const unsigned int         nthreads , 
+  const unsigned long        first    ,
+  const unsigned long        last     )
+{
+  //
+  const unsigned int nt = Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt || nullptr == data ) 
+  { return statCov ( data , exp1 , exp2 , cuts , stat1 , stat2 , cov2 , "" , first , last ) ; }
+  //
+  stat1.reset () ;
+  stat2.reset () ;
+  Ostap::Math::setToScalar ( cov2 , 0.0 ) ;
+  //
+  if ( last <= first ) { return 0 ; }                              // RETURN
+  //
+  // validate the expressions and selection using the original data 
+  make_formula ( exp1 , *data        ) ;
+  make_formula ( exp2 , *data        ) ;
+  make_formula ( cuts , *data , true ) ;
+  //
+  /// the partial result
+  struct Partial 
+  {
+    Statistic           stat1 {} ;
+    Statistic           stat2 {} ;
+    Ostap::SymMatrix2x2 cov2  {} ;
+  } ;
+  //
+  std::vector<Partial> partial ;
+  const bool done = columns_loop_mt 
+    ( *data , { exp1 , exp2 } , cuts , first , last , nt , Partial () , partial , 
+      [] ( Partial& r , const double* v , const double w ) 
+      {
+        r.stat1.add ( v [ 0 ] , w ) ;
+        r.stat2.add ( v [ 1 ] , w ) ;
+        r.cov2 ( 0 , 0 ) += w * v [ 0 ] * v [ 0 ] ;
+        r.cov2 ( 0 , 1 ) += w * v [ 0 ] * v [ 1 ] ;
+        r.cov2 ( 1 , 1 ) += w * v [ 1 ] * v [ 1 ] ;
+      } ) ;
+  if ( !done ) 
+  { return statCov ( data , exp1 , exp2 , cuts , stat1 , stat2 , cov2 , "" , first , last ) ; }
+  //
+  // merge partial results in the order of chunks 
+  for ( const auto& p : partial ) 
+  {
+    stat1 += p.stat1 ;
+    stat2 += p.stat2 ;
+    cov2  += p.cov2  ;
+  }
+  //
+  if ( 0 == stat1.nEntries() || 0 == stat1.nEff () ) { return 0 ; }
+  //
+  cov2 /= stat1.weights().sum()  ;
+  //
+  const double v1_mean = stat1.mean() ;
+  const double v2_mean = stat2.mean() ;
+  //
+  cov2 ( 0 , 0 ) -= v1_mean * v1_mean ;
+  cov2 ( 0 , 1 ) -= v1_mean * v2_mean ;
+  cov2 ( 1 , 1 ) -= v2_mean * v2_mean ;
+  //
+  return stat1.nEntries() ;
+}
+// ============================================================================
+/*  calculate the statistics and covariances for several expressions 
+ *  using several threads
+ *  @param data        (INPUT)  the input data
+ *  @param expressions (INPUT)  the list of expressions 
+ *  @param cuts        (INPUT)  the selection criteria/weight 
+ *  @param result      (UPDATE) the counter 
+ *  @param nthreads    (INPUT)  number of threads
+ *  @param first       (INPUT)  the first entry to process 
+ *  @param last        (INPUT)  the last entry to process (not including!)
+ *  @return number of processed events 
+ *  @see Ostap::Math::Covariances
+ *  @date   2026-10-15
+ */
+// ============================================================================
+unsigned long
+Ostap::StatVar::statCovMT
+( const RooAbsData*            data        ,
+  const Ostap::StatVar::Names& expressions ,
+  const std::string&           cuts        ,
+  Ostap::Math::Covariances&    result      ,
+  const unsigned int           nthreads    , 
+  const unsigned long          first       ,
+  const unsigned long          last        )
+{
+  //
+  const unsigned int N = expressions.size() ;
+  result = Ostap::Math::Covariances ( N ) ;
+  //
+  if ( nullptr == data || expressions.empty() || last <= first ) { return 0 ; } // RETURN  
+  //
+  // validate the expressions and selection using the original data 
+  const std::unique_ptr<Ostap::FormulaVar> selection { make_formula ( cuts , *data , true ) } ;
+  typedef std::unique_ptr<Ostap::FormulaVar> UOF ;
+  std::vector<UOF> formulas ; formulas.reserve ( N ) ;
+  for ( const auto& e : expressions ) { formulas.push_back ( make_formula ( e , *data ) ) ; }
+  //
+  const unsigned int nt = Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 < nt ) 
+  {
+    std::vector<Ostap::Math::CovariancesBuffer> partial ;
+    const bool done = columns_loop_mt 
+      ( *data , expressions , cuts , first , last , nt , 
+        Ostap::Math::CovariancesBuffer ( N ) , partial , 
+        [] ( Ostap::Math::CovariancesBuffer& r , const double* v , const double w ) 
+        { r.add ( v , w ) ; } ) ;
+    if ( done ) 
+    {
+      // merge partial results in the order of chunks 
+      for ( auto& p : partial ) { result += p.flush () ; }
+      return result.n () ;                                      // RETURN 
+    }
+  }
+  //
+  // sequential processing 
+  const unsigned long the_last  = std::min ( last , (unsigned long) data->numEntries() ) ;
+  const bool          weighted  = data->isWeighted() ;
+  //
+  Ostap::Math::CovariancesBuffer block ( N ) ;
+  std::vector<const RooAbsReal*> exprs ( N , nullptr ) ;
+  std::transform ( formulas.begin () , formulas.end () , exprs.begin () , 
+                   [] ( const UOF& f ) { return f.get () ; } ) ;
+  if ( !columns_loop 
+       ( *data , exprs , selection.get() , first , the_last , 
+         [&block] ( const double* v , const double w ) { block.add ( v , w ) ; } ) ) 
+  {
+    std::vector<double> values ( N , 0.0 ) ;
+    for ( unsigned long entry = first ; entry < the_last ; ++entry )
+    {
+      const RooArgSet* vars = data->get( entry ) ;
+      if ( nullptr == vars  ) { break    ; }                    // BREAK
+      //
+      const double wc = selection ? selection -> getVal() : 1.0 ;
+      if ( !wc ) { continue ; }                                 // CONTINUE  
+      const double wd = weighted  ? data->weight()        : 1.0 ;
+      if ( !wd ) { continue ; }                                 // CONTINUE    
+      //
+      for ( unsigned int i = 0 ; i < N ; ++i ) { values [ i ] = formulas [ i ]->getVal () ; }
+      block.add ( values.data () , wd * wc ) ;
+    }
+  }
+  //
+  result = block.flush () ;
+  return result.n () ;
+}
+// ============================================================================
+/*  get the number of equivalent entries using several threads 
+ *  \f$ n_{eff} \equiv = \frac{ (\sum w)^2}{ \sum w^2} \f$
+ *  @param data     (INPUT) the data 
+ *  @param cuts     (INPUT) selection criteria/weight  
+ *  @param nthreads (INPUT) number of threads
+ *  @param first    (INPUT) the first  event to process 
+ *  @param last     (INPUT) the last event to  process
+ *  @return number of equivalent entries 
+ *  @see Ostap::StatVar::nEff
+ *  @date   2023-03-23
+ */
+// ============================================================================
+double Ostap::StatVar::nEffMT 
+( const RooAbsData&    data     , 
+  const std::string&   cuts     , 
+  const unsigned int   nthreads , 
+  const unsigned long  first    ,
+  const unsigned long  last     )
+{
+  //
+  const unsigned int nt = Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt || ( cuts.empty () && !data.isWeighted () ) ) 
+  { return nEff ( data , cuts , "" , first , last ) ; }
+  //
+  // validate the selection using the original data 
+  make_formula ( cuts , data , true ) ;
+  //
+  typedef std::array<long double,2> SUMS ; // sum of weights & sum of weights^2 
+  std::vector<SUMS> partial ;
+  const bool done = columns_loop_mt 
+    ( data , {} , cuts , first , last , nt , SUMS { { 0 , 0 } } , partial , 
+      [] ( SUMS& r , const double* /* v */ , const double w ) 
+      { r [ 0 ] += w ; r [ 1 ] += w * w ; } ) ;
+  if ( !done ) { return nEff ( data , cuts , "" , first , last ) ; }
+  //
+  // merge partial results in the order of chunks 
+  long double sumw  = 0 ;
+  long double sumw2 = 0 ;
+  for ( const auto& p : partial ) { sumw += p [ 0 ] ; sumw2 += p [ 1 ] ; }
+  //
+  return 0 == sumw2 ? 0.0 : sumw * sumw / sumw2 ;
+}
+// ============================================================================
+/*  calculate the moment of order "order" using several threads 
+ *  @param  data     (INPUT) input data
+ *  @param  order    (INPUT) the order 
+ *  @param  expr     (INPUT) expression  (must  be valid TFormula!)
+ *  @param  cuts     (INPUT) cuts 
+ *  @param  nthreads (INPUT) number of threads
+ *  @param  first    (INPUT) the first  event to process 
+ *  @param  last     (INPUT) the last event to  process
+ *  @return the moment 
+ *  @see Ostap::StatVar::moment
+ *  @date   2023-03-23
+ */ 
+// ============================================================================
+Ostap::Math::ValueWithError 
+Ostap::StatVar::momentMT
+( const  RooAbsData&   data     ,  
+  const unsigned short order    ,
+  const std::string&   expr     , 
+  const std::string&   cuts     , 
+  const unsigned int   nthreads , 
+  const unsigned long  first    ,
+  const unsigned long  last     )
+{
+  if ( 0 == order )        { return  1 ; }    // RETURN
+  //
+  const unsigned int nt = Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt ) { return moment ( data , order , expr , cuts , "" , first , last ) ; }
+  //
+  // validate the expression and selection using the original data 
+  make_formula ( expr , data        ) ;
+  make_formula ( cuts , data , true ) ;
+  //
+  typedef std::array<long double,4> SUMS ; // moment, sumw, sumw2 and the moment of "2*order" 
+  std::vector<SUMS> partial ;
+  const bool done = columns_loop_mt 
+    ( data , { expr } , cuts , first , last , nt , SUMS { { 0 , 0 , 0 , 0 } } , partial , 
+      [order] ( SUMS& r , const double* v , const double w ) 
+      {
+        r [ 0 ] += w * std::pow ( v [ 0 ] , order     ) ;
+        r [ 1 ] += w     ;
+        r [ 2 ] += w * w ;
+        r [ 3 ] += w * std::pow ( v [ 0 ] , 2 * order ) ;
+      } ) ;
+  if ( !done ) { return moment ( data , order , expr , cuts , "" , first , last ) ; }
+  //
+  // merge partial results in the order of chunks 
+  long double mom   = 0 ;
+  long double sumw  = 0 ;
+  long double sumw2 = 0 ;
+  long double c2    = 0 ;
+  for ( const auto& p : partial ) 
+  { mom += p [ 0 ] ; sumw += p [ 1 ] ; sumw2 += p [ 2 ] ; c2 += p [ 3 ] ; }
+  //
+  if ( 0 == sumw2 ) { return 0 ; }  //  RETURN 
+  //
+  const long double v = mom / sumw ;
+  //
+  c2 /= sumw  ; // the moment of "2*order"
+  c2 -= v * v ; // m(2*order) - m(order)**2
+  //
+  const long double n = sumw * sumw / sumw2 ;
+  c2 /= n     ; // 
+  //
+  return Ostap::Math::ValueWithError ( v , c2 ) ;            // RETURN
+}
+// ============================================================================
+/*  get (exact) quantiles of the distribution using several threads 
+ *  @param data      (INPUT) the input data
+ *  @param quantiles (INPUT) quantile values 0 < q < 1  
+ *  @param expr      (INPUT) the expression 
+ *  @param cuts      (INPUT) selection cuts 
+ *  @param nthreads  (INPUT) number of threads
+ *  @param first     (INPUT) the first  event to process 
+ *  @param last      (INPUT) the last event to  process
+ *  @return the quantile values 
+ *  @see Ostap::StatVar::quantiles
+ *  @date   2023-03-23
+ */
+// ============================================================================
+Ostap::StatVar::Quantiles
+Ostap::StatVar::quantilesMT
+( const RooAbsData&          data      ,
+  const std::vector<double>& quantiles , 
+  const std::string&         expr      , 
+  const std::string&         cuts      , 
+  const unsigned int         nthreads  , 
+  const unsigned long        first     ,
+  const unsigned long        last      )
+{
+  const unsigned int nt = Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt ) { return Ostap::StatVar::quantiles ( data , quantiles , expr , cuts , "" , first , last ) ; }
+  //
+  std::set<double> qs ;
+  for ( double v : quantiles ) { qs.insert( v ) ; }
+  Ostap::Assert (  !qs.empty()                   , 
+                   "Invalid quantiles"           ,
+                   "Ostap::StatVar::quantilesMT" ) ;
+  Ostap::Assert ( 0 < *qs. begin ()              ,  
+                  "Invalid quantile"             ,
+                  "Ostap::StatVar::quantilesMT"  ) ;
+  Ostap::Assert ( 1 > *qs.rbegin ()              ,  
+                  "Invalid quantile"             ,
+                  "Ostap::StatVar::quantilesMT"  ) ;
+  //
+  const unsigned long num_entries = data.numEntries() ;
+  const unsigned long the_last    = std::min ( num_entries , last ) ;
+  if ( the_last <= first ) { return std::vector<double>() ; }    // RETURN
+  //
+  // validate the expression and selection using the original data 
+  make_formula ( expr , data        ) ;
+  make_formula ( cuts , data , true ) ;
+  //
+  typedef std::vector<double> VALUES ;
+  std::vector<VALUES> partial ;
+  const bool done = columns_loop_mt 
+    ( data , { expr } , cuts , first , the_last , nt , VALUES () , partial , 
+      [] ( VALUES& r , const double* v , const double /* w */ ) { r.push_back ( v [ 0 ] ) ; } ) ;
+  if ( !done ) { return Ostap::StatVar::quantiles ( data , quantiles , expr , cuts , "" , first , last ) ; }
+  //
+  // merge partial results in the order of chunks 
+  std::size_t num = 0 ;
+  for ( const auto& p : partial ) { num += p.size () ; }
+  VALUES values ; values.reserve ( num ) ;
+  for ( auto& p : partial ) 
+  {
+    values.insert ( values.end () , p.begin () , p.end () ) ;
+    VALUES ().swap ( p ) ;
+  }
+  //
+  return _pick_quantiles_ ( values , qs ) ;
+}
+// ============================================================================
+/*  get (exact) quantile of the distribution using several threads 
+ *  @see Ostap::StatVar::quantilesMT
+ *  @date   2023-03-23
+ */
+// ============================================================================
+Ostap::StatVar::Quantile
+Ostap::StatVar::quantileMT
+( const RooAbsData&   data     ,
+  const double        q        , //  0<q<1 
+  const std::string&  expr     , 
+  const std::string&  cuts     , 
+  const unsigned int  nthreads , 
+  const unsigned long first    ,
+  const unsigned long last     )
+{
+  Ostap::Assert ( 0 < q && q < 1               , 
+                  "Invalid quantile"           ,
+                  "Ostap::StatVar::quantileMT" ) ;
+  //
+  const Quantiles result = quantilesMT 
+    ( data , std::vector<double> ( 1 , q ) , expr , cuts , nthreads , first , last ) ;
+  //
+  return result.quantiles.empty () ? Quantile () : Quantile ( result.quantiles [ 0 ] , result.nevents ) ;
+}
 
 
 
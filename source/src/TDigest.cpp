@@ -0,0 +1,324 @@
+// ============================================================================
+// Include files
+// ============================================================================
+//  STD&STL
+// ============================================================================
+#include <cmath>
+#include <utility>
+#include <algorithm>
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/TDigest.h"
+// ============================================================================
+// local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Math::TDigest
+ *  @date 2023-03-20
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_COMPRESSION = 810 ,
+    INVALID_WEIGHT      = 811 ,
+    INVALID_CENTROIDS   = 812 ,
+  } ;
+  // ==========================================================================
+  /// the minimal compression parameter
+  const unsigned int s_MIN_COMPRESSION = 20 ;
+  /// the size of buffer (in units of compression parameter)
+  const unsigned int s_BUFFER          =  5 ;
+  // ==========================================================================
+  /// linear interpolation between two points
+  inline double _interpolate_
+  ( const double x1 , const double y1 ,
+    const double x2 , const double y2 ,
+    const double x  )
+  {
+    if ( x2 <= x1 ) { return 0.5 * ( y1 + y2 ) ; }
+    const double r = ( x - x1 ) / ( x2 - x1 ) ;
+    return y1 + r * ( y2 - y1 ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+/*  constructor from the compression parameter
+ *  @param compression the compression parameter \f$ 20 \le \delta \f$
+ */
+// ============================================================================
+Ostap::Math::TDigest::TDigest
+( const unsigned int compression )
+  : m_compression ( compression )
+{
+  Ostap::Assert ( s_MIN_COMPRESSION <= m_compression   ,
+                  "Invalid compression parameter"      ,
+                  "Ostap::Math::TDigest"               , INVALID_COMPRESSION ) ;
+  m_buffer.reserve ( s_BUFFER * m_compression ) ;
+}
+// ============================================================================
+/*  full constructor (e.g. for deserialization)
+ *  @param compression the compression parameter
+ *  @param means       the means of centroids
+ *  @param weights     the weights of centroids
+ *  @param n           number of added points
+ *  @param xmin        the minimal value
+ *  @param xmax        the maximal value
+ */
+// ============================================================================
+Ostap::Math::TDigest::TDigest
+( const unsigned int         compression ,
+  const std::vector<double>& means       ,
+  const std::vector<double>& weights     ,
+  const unsigned long        n           ,
+  const double               xmin        ,
+  const double               xmax        )
+  : TDigest ( compression )
+{
+  Ostap::Assert ( means.size () == weights.size ()     ,
+                  "Invalid centroids"                  ,
+                  "Ostap::Math::TDigest"               , INVALID_CENTROIDS ) ;
+  //
+  for ( std::size_t i = 0 ; i < means.size () ; ++i )
+  {
+    Ostap::Assert ( 0 <= weights [ i ]                 ,
+                    "Invalid weight of centroid"       ,
+                    "Ostap::Math::TDigest"             , INVALID_WEIGHT ) ;
+    if ( 0 == weights [ i ] ) { continue ; }
+    m_buffer.emplace_back ( means [ i ] , weights [ i ] ) ;
+    m_sumw += weights [ i ] ;
+  }
+  //
+  m_n   = n ;
+  m_min = std::min ( xmin , xmax ) ;
+  m_max = std::max ( xmin , xmax ) ;
+  //
+  compress () ;
+}
+// ============================================================================
+/*  add the (weighted) point
+ *  @param x the value
+ *  @param w the weight
+ */
+// ============================================================================
+Ostap::Math::TDigest&
+Ostap::Math::TDigest::add
+( const double x ,
+  const double w )
+{
+  Ostap::Assert ( 0 <= w                               ,
+                  "Negative weights are not allowed"   ,
+                  "Ostap::Math::TDigest"               , INVALID_WEIGHT ) ;
+  if ( 0 == w ) { return *this ; }                                // RETURN
+  //
+  if ( 0 == m_n ) { m_min = x ; m_max = x ; }
+  else            { m_min = std::min ( m_min , x ) ; m_max = std::max ( m_max , x ) ; }
+  //
+  ++m_n ;
+  m_sumw += w ;
+  m_buffer.emplace_back ( x , w ) ;
+  //
+  if ( s_BUFFER * m_compression <= m_buffer.size () ) { compress () ; }
+  //
+  return *this ;
+}
+// ============================================================================
+// merge with other sketch
+// ============================================================================
+Ostap::Math::TDigest&
+Ostap::Math::TDigest::add
+( const Ostap::Math::TDigest& right )
+{
+  if ( right.empty () ) { return *this ; }                        // RETURN
+  if ( &right == this )
+  {
+    const TDigest copy { right } ;
+    return add ( copy ) ;
+  }
+  //
+  if ( 0 == m_n ) { m_min = right.m_min ; m_max = right.m_max ; }
+  else
+  {
+    m_min = std::min ( m_min , right.m_min ) ;
+    m_max = std::max ( m_max , right.m_max ) ;
+  }
+  //
+  m_n    += right.m_n    ;
+  m_sumw += right.m_sumw ;
+  //
+  for ( std::size_t i = 0 ; i < right.m_means.size () ; ++i )
+  { m_buffer.emplace_back ( right.m_means [ i ] , right.m_weights [ i ] ) ; }
+  m_buffer.insert ( m_buffer.end () , right.m_buffer.begin () , right.m_buffer.end () ) ;
+  //
+  compress () ;
+  return *this ;
+}
+// ============================================================================
+// merge the buffered points with the centroids
+// ============================================================================
+void Ostap::Math::TDigest::compress () const
+{
+  if ( m_buffer.empty () ) { return ; }                           // RETURN
+  //
+  // (1) collect all points: the existing centroids & the buffer
+  std::vector<std::pair<double,double> > points ;
+  points.reserve ( m_means.size () + m_buffer.size () ) ;
+  for ( std::size_t i = 0 ; i < m_means.size () ; ++i )
+  { points.emplace_back ( m_means [ i ] , m_weights [ i ] ) ; }
+  points.insert ( points.end () , m_buffer.begin () , m_buffer.end () ) ;
+  m_buffer.clear () ;
+  //
+  std::sort ( points.begin () , points.end () ,
+              [] ( const std::pair<double,double>& a ,
+                   const std::pair<double,double>& b ) { return a.first < b.first ; } ) ;
+  //
+  double W = 0 ;
+  for ( const auto& p : points ) { W += p.second ; }
+  //
+  // (2) the scale function k1
+  const double norm = m_compression / ( 2 * M_PI ) ;
+  auto kscale = [norm] ( const double q ) -> double
+    { return norm * std::asin ( 2 * std::min ( 1.0 , std::max ( 0.0 , q ) ) - 1 ) ; } ;
+  //
+  // (3) the single merging pass
+  m_means  .clear () ;
+  m_weights.clear () ;
+  //
+  double wsofar = 0 ;
+  double klow   = kscale ( 0 ) ;
+  double cm     = points.front ().first  ;
+  double cw     = points.front ().second ;
+  for ( std::size_t i = 1 ; i < points.size () ; ++i )
+  {
+    const double x = points [ i ].first  ;
+    const double w = points [ i ].second ;
+    if ( kscale ( ( wsofar + cw + w ) / W ) - klow <= 1 )
+    {
+      cw += w ;
+      cm += w * ( x - cm ) / cw ;
+    }
+    else
+    {
+      m_means  .push_back ( cm ) ;
+      m_weights.push_back ( cw ) ;
+      wsofar += cw ;
+      klow    = kscale ( wsofar / W ) ;
+      cm      = x ;
+      cw      = w ;
+    }
+  }
+  m_means  .push_back ( cm ) ;
+  m_weights.push_back ( cw ) ;
+}
+// ============================================================================
+// number of centroids
+// ============================================================================
+std::size_t Ostap::Math::TDigest::size () const
+{
+  compress () ;
+  return m_means.size () ;
+}
+// ============================================================================
+/*  get the quantile
+ *  The piecewise linear interpolation between the centres of centroids
+ *  (and the minimal/maximal values) is used
+ *  @param p the probability \f$ 0 \le p \le 1 \f$
+ *  @return the quantile value
+ */
+// ============================================================================
+double Ostap::Math::TDigest::quantile ( const double p ) const
+{
+  if ( empty () ) { return 0     ; }
+  if ( p <= 0   ) { return m_min ; }
+  if ( p >= 1   ) { return m_max ; }
+  //
+  compress () ;
+  //
+  const double t   = p * m_sumw ;
+  double       pos = 0     ;
+  double       x   = m_min ;
+  double       cum = 0     ;
+  for ( std::size_t i = 0 ; i < m_means.size () ; ++i )
+  {
+    const double center = cum + 0.5 * m_weights [ i ] ;
+    if ( t < center ) { return _interpolate_ ( pos , x , center , m_means [ i ] , t ) ; }
+    pos  = center ;
+    x    = m_means   [ i ] ;
+    cum += m_weights [ i ] ;
+  }
+  return _interpolate_ ( pos , x , m_sumw , m_max , t ) ;
+}
+// ============================================================================
+// get several quantiles
+// ============================================================================
+std::vector<double>
+Ostap::Math::TDigest::quantiles
+( const std::vector<double>& ps ) const
+{
+  std::vector<double> result ; result.reserve ( ps.size () ) ;
+  for ( const double p : ps ) { result.push_back ( quantile ( p ) ) ; }
+  return result ;
+}
+// ============================================================================
+/*  get the cumulative distribution function
+ *  @param x the value
+ *  @return the fraction of weight below x
+ */
+// ============================================================================
+double Ostap::Math::TDigest::cdf ( const double x ) const
+{
+  if ( empty ()    ) { return 0 ; }
+  if ( x <  m_min  ) { return 0 ; }
+  if ( x >= m_max  ) { return 1 ; }
+  //
+  compress () ;
+  //
+  double pos = 0     ;
+  double xl  = m_min ;
+  double cum = 0     ;
+  for ( std::size_t i = 0 ; i < m_means.size () ; ++i )
+  {
+    const double center = cum + 0.5 * m_weights [ i ] ;
+    if ( x < m_means [ i ] )
+    { return _interpolate_ ( xl , pos , m_means [ i ] , center , x ) / m_sumw ; }
+    pos  = center ;
+    xl   = m_means   [ i ] ;
+    cum += m_weights [ i ] ;
+  }
+  return _interpolate_ ( xl , pos , m_max , m_sumw , x ) / m_sumw ;
+}
+// ============================================================================
+// reset the sketch
+// ============================================================================
+void Ostap::Math::TDigest::reset ()
+{
+  m_n    = 0 ;
+  m_sumw = 0 ;
+  m_min  = 0 ;
+  m_max  = 0 ;
+  m_means  .clear () ;
+  m_weights.clear () ;
+  m_buffer .clear () ;
+}
+// ============================================================================
+// swap two sketches
+// ============================================================================
+void Ostap::Math::TDigest::swap ( Ostap::Math::TDigest& right )
+{
+  std::swap ( m_compression , right.m_compression ) ;
+  std::swap ( m_n           , right.m_n           ) ;
+  std::swap ( m_sumw        , right.m_sumw        ) ;
+  std::swap ( m_min         , right.m_min         ) ;
+  std::swap ( m_max         , right.m_max         ) ;
+  std::swap ( m_means       , right.m_means       ) ;
+  std::swap ( m_weights     , right.m_weights     ) ;
+  std::swap ( m_buffer      , right.m_buffer      ) ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
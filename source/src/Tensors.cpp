@@ -11,8 +11,152 @@
  *  @date 2008-07-26
  */
 // ============================================================================
-
-
+namespace
+{
+  // ==========================================================================
+  /// get the covariant components (x,y,z,e) of the i-th vector
+  inline void _lower
+  ( const Ostap::Math::Tensors::Vectors& v ,
+    const std::size_t                    i ,
+    double*                              r )
+  {
+    r [ 0 ] = -v.px [ i ] ;
+    r [ 1 ] = -v.py [ i ] ;
+    r [ 2 ] = -v.pz [ i ] ;
+    r [ 3 ] =  v.e  [ i ] ;
+  }
+  // ==========================================================================
+  /// the scalar product of the i-th vectors
+  inline double _dot
+  ( const Ostap::Math::Tensors::Vectors& a ,
+    const Ostap::Math::Tensors::Vectors& b ,
+    const std::size_t                    i )
+  {
+    return a.e  [ i ] * b.e  [ i ]
+      -    a.px [ i ] * b.px [ i ]
+      -    a.py [ i ] * b.py [ i ]
+      -    a.pz [ i ] * b.pz [ i ] ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// batched metric contraction for N pairs of 4-vectors
+// ============================================================================
+void Ostap::Math::Tensors::G::dot
+( const std::size_t n      ,
+  const Vectors&    a      ,
+  const Vectors&    b      ,
+  double*           result )
+{
+  for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = _dot ( a , b , i ) ; }
+}
+// ============================================================================
+// batched e*v1*v2*v3 product (4-normal) for N triplets of vectors
+// ============================================================================
+void Ostap::Math::Tensors::Epsilon::epsilon
+( const std::size_t n      ,
+  const Vectors&    v1     ,
+  const Vectors&    v2     ,
+  const Vectors&    v3     ,
+  const OutVectors& result )
+{
+  double a [ 4 ] , b [ 4 ] , c [ 4 ] ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    _lower ( v1 , i , a ) ;
+    _lower ( v2 , i , b ) ;
+    _lower ( v3 , i , c ) ;
+    result.px [ i ] = detail::_e_1<X> ( a , b , c ) ;
+    result.py [ i ] = detail::_e_1<Y> ( a , b , c ) ;
+    result.pz [ i ] = detail::_e_1<Z> ( a , b , c ) ;
+    result.e  [ i ] = detail::_e_1<E> ( a , b , c ) ;
+  }
+}
+// ============================================================================
+// batched e*v1*v2*v3*v4 product for N quartets of vectors
+// ============================================================================
+void Ostap::Math::Tensors::Epsilon::epsilon
+( const std::size_t n      ,
+  const Vectors&    v1     ,
+  const Vectors&    v2     ,
+  const Vectors&    v3     ,
+  const Vectors&    v4     ,
+  double*           result )
+{
+  double a [ 4 ] , b [ 4 ] , c [ 4 ] , d [ 4 ] ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    _lower ( v1 , i , a ) ;
+    _lower ( v2 , i , b ) ;
+    _lower ( v3 , i , c ) ;
+    _lower ( v4 , i , d ) ;
+    // expansion over the first vector
+    result [ i ] =
+      a [ 0 ] * detail::_e_1<X> ( b , c , d ) +
+      a [ 1 ] * detail::_e_1<Y> ( b , c , d ) +
+      a [ 2 ] * detail::_e_1<Z> ( b , c , d ) +
+      a [ 3 ] * detail::_e_1<E> ( b , c , d ) ;
+  }
+}
+// ============================================================================
+// batched tensor product (e*a1*a2*a3)*(e*b1*b2*b3) for N sextets of vectors
+// ============================================================================
+void Ostap::Math::Tensors::Epsilon::epsilon
+( const std::size_t n      ,
+  const Vectors&    a1     ,
+  const Vectors&    a2     ,
+  const Vectors&    a3     ,
+  const Vectors&    b1     ,
+  const Vectors&    b2     ,
+  const Vectors&    b3     ,
+  double*           result )
+{
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double a1b1 = _dot ( a1 , b1 , i ) ;
+    const double a1b2 = _dot ( a1 , b2 , i ) ;
+    const double a1b3 = _dot ( a1 , b3 , i ) ;
+    //
+    const double a2b1 = _dot ( a2 , b1 , i ) ;
+    const double a2b2 = _dot ( a2 , b2 , i ) ;
+    const double a2b3 = _dot ( a2 , b3 , i ) ;
+    //
+    const double a3b1 = _dot ( a3 , b1 , i ) ;
+    const double a3b2 = _dot ( a3 , b2 , i ) ;
+    const double a3b3 = _dot ( a3 , b3 , i ) ;
+    //
+    result [ i ] =
+      a1b1 * ( a2b3 * a3b2 - a2b2 * a3b3 ) +
+      a1b2 * ( a2b1 * a3b3 - a2b3 * a3b1 ) +
+      a1b3 * ( a2b2 * a3b1 - a2b1 * a3b2 ) ;
+  }
+}
+// ============================================================================
+// batched magnitude of the "4-normal" for N triplets of vectors
+// ============================================================================
+void Ostap::Math::Tensors::Epsilon::mag2
+( const std::size_t n      ,
+  const Vectors&    a      ,
+  const Vectors&    b      ,
+  const Vectors&    c      ,
+  double*           result )
+{
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double a2 = _dot ( a , a , i ) ;
+    const double b2 = _dot ( b , b , i ) ;
+    const double c2 = _dot ( c , c , i ) ;
+    const double ab = _dot ( a , b , i ) ;
+    const double ac = _dot ( a , c , i ) ;
+    const double bc = _dot ( b , c , i ) ;
+    //
+    result [ i ] = ab * ab * c2
+      +            ac * ac * b2
+      +            bc * bc * a2
+      -            a2 * b2 * c2
+      -            ab * bc * ac * 2 ;
+  }
+}
 // ============================================================================
 // The END
 // ============================================================================
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <climits>
 #include <tuple>
+#include <memory>
 // ============================================================================
 // Ostap
 // ============================================================================
@@ -19,6 +20,7 @@
 // TMVA
 // ============================================================================
 #include "TMVA/Reader.h"
+#include "TMVA/MethodBase.h"
 // ============================================================================
 // ROOT
 // ============================================================================
@@ -33,6 +35,11 @@
 #include "RooArgList.h"
 #include "RooDataSet.h"
 // ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+// ============================================================================
 namespace
 {
   // ===========================================================================
@@ -660,9 +667,288 @@ Ostap::StatusCode Ostap::TMVA::addChoppingResponse
                                    suffix        ,
                                    aux           );
 }
-
-
-
+// ============================================================================
+namespace 
+{
+  // ==========================================================================
+  /// invalid chopping category (used to break the multithreaded processing)
+  struct InvalidCategory {} ;
+  // ==========================================================================
+  /** @class ResponseWorker
+   *  Thread-local worker for the multithreaded TMVA/chopping response:
+   *  own set of readers (one per category) for the thread copy of the tree.
+   *  For each chunk it fills the column buffer: the responses of all
+   *  methods and, for chopping, the category index as the last column 
+   *  @see Ostap::TMVA::addResponseMT
+   *  @see Ostap::TMVA::addChoppingResponseMT
+   *  @see Ostap::Utils::process_ordered 
+   */
+  class ResponseWorker 
+  {
+  public:
+    // ========================================================================
+    ResponseWorker 
+    ( TTree*                   tree         , 
+      const std::string&       chopping     , // empty for the plain response 
+      const Ostap::TMVA::MAP&  inputs       , 
+      const Ostap::TMVA::MAPS& weight_files , 
+      const std::string&       options      , 
+      const double             aux          ) 
+      : m_tree ( tree ) 
+      , m_aux  ( aux  ) 
+    {
+      m_readers.reserve ( weight_files.size () ) ;
+      for ( const auto& wfs : weight_files ) { m_readers.emplace_back ( tree , inputs , wfs ) ; }
+      //
+      bool first = true ;
+      for ( auto& r : m_readers ) 
+      {
+        const Ostap::StatusCode sc = r.build ( first ? options : "" ) ;
+        Ostap::Assert ( sc.isSuccess ()                 , 
+                        "Cannot build TMVA reader"      , 
+                        "Ostap::TMVA::ResponseWorker"   , sc ) ;
+        first = false ;
+        //
+        // resolve the methods once 
+        std::vector<METHOD> methods ;
+        for ( const auto& m : r.methods () ) 
+        {
+          ::TMVA::MethodBase* mb = dynamic_cast< ::TMVA::MethodBase*> ( r.reader()->FindMVA ( m ) ) ;
+          // for categories use the "standard" evaluation 
+          if ( mb && ::TMVA::Types::kCategory == mb->GetMethodType () ) { mb = nullptr ; }
+          methods.emplace_back ( m , mb ) ;
+        }
+        m_methods.push_back ( methods ) ;
+      }
+      //
+      if ( !chopping.empty () ) 
+      {
+        m_chopping = std::make_unique<Ostap::Formula> ( chopping , chopping , tree ) ;
+        Ostap::Assert ( m_chopping->ok ()                      , 
+                        "Invalid chopping:\"" + chopping + "\"" , 
+                        "Ostap::TMVA::ResponseWorker"          , 
+                        Ostap::StatusCode ( Ostap::TMVA::InvalidChoppingFormula ) ) ;
+      }
+      //
+      m_notifier = std::make_unique<Ostap::Utils::Notifier> ( tree , m_chopping.get () ) ;
+      for ( auto& r : m_readers ) 
+      { for ( auto& e : r.variables () ) { m_notifier->add ( std::get<1> ( e ) ) ; } }
+    }
+    // ========================================================================
+    void operator() ( const Ostap::Utils::Chunk& chunk , 
+                      std::vector<double>&       data  ) 
+    {
+      const std::size_t M    = m_methods.front().size () ;
+      const std::size_t size = chunk.size () ;
+      const std::size_t NR   = m_readers.size () ;
+      data.assign ( ( m_chopping ? M + 1 : M ) * size , 0.0 ) ;
+      //
+      for ( std::size_t i = 0 ; i < size ; ++i ) 
+      {
+        Long64_t ievent = m_tree->GetEntryNumber ( chunk.first + i ) ;
+        Ostap::Assert ( 0 <= ievent , "Invalid entry" , "Ostap::TMVA::ResponseWorker" ) ;
+        ievent          = m_tree->LoadTree       ( ievent ) ;
+        Ostap::Assert ( 0 <= ievent , "Invalid entry" , "Ostap::TMVA::ResponseWorker" ) ;
+        //
+        std::size_t index = 0 ;
+        if ( m_chopping ) 
+        {
+          const double chopval = m_chopping->evaluate () ;
+          if ( !Ostap::Math::islong ( chopval ) ) { throw InvalidCategory () ; }
+          const long choplong = std::lround ( chopval ) ;
+          index = choplong % (unsigned int) NR ;
+          data [ M * size + i ] = index ;
+        }
+        //
+        // prepare TMVA input 
+        READER2& reader = m_readers [ index ] ;
+        for ( auto& e : reader.variables() ) 
+        { std::get<2> ( e ) = std::get<1> ( e )->evaluate () ; }
+        //
+        // evaluate TMVA 
+        const std::vector<METHOD>& methods = m_methods [ index ] ;
+        for ( std::size_t k = 0 ; k < M ; ++k ) 
+        {
+          const METHOD& m = methods [ k ] ;
+          data [ k * size + i ] = m.second ? 
+            reader.reader()->EvaluateMVA ( m.second        , m_aux ) : 
+            reader.reader()->EvaluateMVA ( m.first.c_str() , m_aux ) ;
+        }
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    typedef std::pair<std::string,::TMVA::MethodBase*> METHOD ;
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the tree (thread copy)
+    TTree*                                  m_tree     { nullptr } ;
+    /// aux-parameter for TMVA 
+    double                                  m_aux      { 0.9     } ;
+    /// readers 
+    READERS2                                m_readers  {} ;
+    /// resolved methods for each reader 
+    std::vector<std::vector<METHOD> >       m_methods  {} ;
+    /// chopping variable 
+    std::unique_ptr<Ostap::Formula>         m_chopping {} ;
+    /// notifier (destroyed first)
+    std::unique_ptr<Ostap::Utils::Notifier> m_notifier {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /// split the tree into chunks for multithreaded processing
+  Ostap::Utils::Chunks _chunks_ ( TTree* tree , const unsigned int nt ) 
+  {
+    // aligned with the clusters, at most 1M entries per chunk 
+    const unsigned long nentries = tree->GetEntries () ;
+    const unsigned int  nchunks  = std::max ( 4 * nt , (unsigned int) ( nentries >> 20 ) + 1 ) ;
+    return Ostap::Utils::clusters ( tree , 0 , nentries , nchunks ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+/*  Add TMVA response to TTree using several threads 
+ *  @see Ostap::TMVA::addResponse
+ *  @param nthreads     (INPUT) number of threads
+ *  @date 2023-01-29
+ */ 
+// ============================================================================
+Ostap::StatusCode Ostap::TMVA::addResponseMT
+( TTree*                  tree          ,
+  const Ostap::TMVA::MAP& inputs        , 
+  const Ostap::TMVA::MAP& weight_files  ,
+  const std::string&      options       ,
+  const std::string&      prefix        , 
+  const std::string&      suffix        , 
+  const double            aux           , 
+  const unsigned int      nthreads      ) 
+{
+  if ( nullptr == tree ) { return InvalidTree ; }
+  //
+  const unsigned int nt = Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) ) 
+  { return addResponse ( tree , inputs , weight_files , options , prefix , suffix , aux ) ; }
+  //
+  // validate the configuration using the original tree 
+  std::vector<std::string> methods ;
+  {
+    READER2 reader  ( tree , inputs , weight_files ) ;
+    Ostap::StatusCode sc =  reader.build ( options ) ;
+    if ( sc.isFailure() ) { return sc ; }
+    methods = reader.methods () ;
+  }
+  //
+  if ( 0 == tree->GetEntries () || methods.empty () ) { return Ostap::StatusCode::SUCCESS ; }
+  //
+  const std::size_t   M = methods.size () ;
+  std::vector<double>   values    ( M , 0.0 ) ;
+  std::vector<TBranch*> branches  ( M ) ;
+  for ( std::size_t k = 0 ; k < M ; ++k ) 
+  {
+    const std::string bname = prefix + methods [ k ] + suffix ;
+    branches [ k ] = tree->Branch ( bname.c_str() , &values [ k ] , ( bname + "/D" ).c_str() ) ;
+    if ( !branches [ k ] ) { return InvalidBranch ; }
+  }
+  //
+  const MAPS wfs { weight_files } ;
+  Ostap::Utils::process_ordered 
+    ( tree , _chunks_ ( tree , nt ) , nt , 
+      [&] ( TTree* t ) { return ResponseWorker ( t , "" , inputs , wfs , options , aux ) ; } , 
+      [&] ( const Ostap::Utils::Chunk& chunk , const std::vector<double>& data ) 
+      {
+        const std::size_t size = chunk.size () ;
+        for ( std::size_t i = 0 ; i < size ; ++i ) 
+        {
+          for ( std::size_t k = 0 ; k < M ; ++k ) { values   [ k ] = data [ k * size + i ] ; }
+          for ( std::size_t k = 0 ; k < M ; ++k ) { branches [ k ] -> Fill () ; }
+        }
+      } ) ;
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+/*  Add TMVA/Chopping response to TTree using several threads 
+ *  @see Ostap::TMVA::addChoppingResponse
+ *  @param nthreads     (INPUT) number of threads
+ *  @date 2023-01-29
+ */ 
+// ============================================================================
+Ostap::StatusCode Ostap::TMVA::addChoppingResponseMT
+( TTree*                   tree          ,
+  const std::string&       chopping      , // category function 
+  const std::string&       category_name , // category variable 
+  const unsigned short     N             , // number of categories 
+  const Ostap::TMVA::MAP&  inputs        , // mapping of input variables 
+  const Ostap::TMVA::MAPS& weight_files  ,
+  const std::string&       options       ,
+  const std::string&       prefix        , 
+  const std::string&       suffix        ,
+  const double             aux           , 
+  const unsigned int       nthreads      ) 
+{
+  if ( nullptr == tree ) { return InvalidTree ; }
+  // ==========================================================================
+  if  ( 0 == N || N != weight_files.size() ) { return InvalidChoppingWeightFiles ; }
+  // ==========================================================================
+  const unsigned int nt = Ostap::Utils::nThreads ( nthreads ) ;
+  if ( 1 == nt || !Ostap::Utils::parallelizable ( tree ) ) 
+  { return addChoppingResponse ( tree , chopping , category_name , N , 
+                                 inputs , weight_files , options , prefix , suffix , aux ) ; }
+  //
+  // validate the configuration using the original tree 
+  if ( !Ostap::Formula ( chopping , chopping , tree ).ok() ) { return InvalidFormula ; }
+  std::vector<std::string> methods ;
+  {
+    bool first = true ;
+    for ( const auto& wfs : weight_files )
+    {
+      READER2 reader ( tree , inputs , wfs ) ;
+      Ostap::StatusCode sc =  reader.build ( first ? options : "" ) ;
+      if ( sc.isFailure() ) { return sc ; }
+      if ( first ) { methods = reader.methods () ; }
+      first = false ;
+    }
+  }
+  //
+  if ( 0 == tree->GetEntries () ) { return Ostap::StatusCode::SUCCESS ; }
+  //
+  const std::size_t   M = methods.size () ;
+  std::vector<double>   values    ( M , 0.0 ) ;
+  std::vector<TBranch*> branches  ( M ) ;
+  for ( std::size_t k = 0 ; k < M ; ++k ) 
+  {
+    const std::string bname = prefix + methods [ k ] + suffix ;
+    branches [ k ] = tree->Branch ( bname.c_str() , &values [ k ] , ( bname + "/D" ).c_str() ) ;
+    if ( !branches [ k ] ) { return InvalidBranch ; }
+  }
+  // category in Tree:
+  UInt_t   i_category = 0 ;
+  TBranch* bcat = tree->Branch ( category_name.c_str() , &i_category , ( category_name + "/i" ).c_str() ) ;
+  if ( !bcat ) { return InvalidBranch ; } 
+  //
+  try 
+  {
+    Ostap::Utils::process_ordered 
+      ( tree , _chunks_ ( tree , nt ) , nt , 
+        [&] ( TTree* t ) { return ResponseWorker ( t , chopping , inputs , weight_files , options , aux ) ; } , 
+        [&] ( const Ostap::Utils::Chunk& chunk , const std::vector<double>& data ) 
+        {
+          const std::size_t size = chunk.size () ;
+          for ( std::size_t i = 0 ; i < size ; ++i ) 
+          {
+            i_category = UInt_t ( data [ M * size + i ] ) ;
+            bcat -> Fill () ;
+            for ( std::size_t k = 0 ; k < M ; ++k ) { values   [ k ] = data [ k * size + i ] ; }
+            for ( std::size_t k = 0 ; k < M ; ++k ) { branches [ k ] -> Fill () ; }
+          }
+        } ) ;
+  }
+  catch ( const InvalidCategory& ) { return InvalidChoppingCategory ; }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
 // ============================================================================
 //                                                                      The END 
 // ============================================================================
@@ -0,0 +1,349 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <algorithm>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TTree.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Math.h"
+#include "Ostap/Formula.h"
+#include "Ostap/Notifier.h"
+#include "Ostap/TmvaForest.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for classes Ostap::TMVA::Forest
+ *  and Ostap::TMVA::ForestResponse
+ *  @date 2026-10-15
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  enum {
+    INVALID_FOREST   = 894 ,
+    INVALID_FORMULA  = 895 ,
+    INVALID_CHOPPING = 896 ,
+  } ;
+  // ==========================================================================
+}
+// ============================================================================
+/* constructor from the flattened node arrays
+ *  @param nvars    number of input variables
+ *  @param var      index of the variable for each node (negative for leaves)
+ *  @param cut      the cut value for each node
+ *  @param left     index of the left  daughter for each node
+ *  @param right    index of the right daughter for each node
+ *  @param value    the leaf value for each node
+ *  @param roots    indices of the root nodes of the trees
+ *  @param weights  boost weights of the trees
+ *  @param gradient gradient boosting?
+ */
+// ============================================================================
+Ostap::TMVA::Forest::Forest
+( const unsigned short        nvars    ,
+  const std::vector<int>&     var      ,
+  const std::vector<double>&  cut      ,
+  const std::vector<int>&     left     ,
+  const std::vector<int>&     right    ,
+  const std::vector<double>&  value    ,
+  const std::vector<int>&     roots    ,
+  const std::vector<double>&  weights  ,
+  const bool                  gradient )
+  : m_nvars    ( nvars    )
+  , m_nodes    (          )
+  , m_roots    ( roots    )
+  , m_weights  ( weights  )
+  , m_norm     ( 0        )
+  , m_gradient ( gradient )
+{
+  const std::size_t N = var.size () ;
+  Ostap::Assert ( N == cut.size () && N == left.size () && N == right.size () && N == value.size () ,
+                  "Inconsistent sizes of node arrays" ,
+                  "Ostap::TMVA::Forest"               ,
+                  INVALID_FOREST ) ;
+  Ostap::Assert ( m_roots.size () == m_weights.size () ,
+                  "Inconsistent number of trees"       ,
+                  "Ostap::TMVA::Forest"                ,
+                  INVALID_FOREST ) ;
+  //
+  const int NN = N ;
+  m_nodes.reserve ( N ) ;
+  for ( std::size_t i = 0 ; i < N ; ++i )
+  {
+    const bool leaf = var [ i ] < 0 ;
+    Ostap::Assert ( leaf || ( var [ i ] < nvars &&
+                              0 <= left  [ i ] && left  [ i ] < NN &&
+                              0 <= right [ i ] && right [ i ] < NN ) ,
+                    "Invalid node #" + std::to_string ( i ) ,
+                    "Ostap::TMVA::Forest"                   ,
+                    INVALID_FOREST ) ;
+    Node node ;
+    node.cut        = cut   [ i ] ;
+    node.var        = leaf ? -1 : var   [ i ] ;
+    node.next [ 0 ] = leaf ? -1 : left  [ i ] ;
+    node.next [ 1 ] = leaf ? -1 : right [ i ] ;
+    node.value      = value [ i ] ;
+    m_nodes.push_back ( node ) ;
+  }
+  //
+  for ( const int r : m_roots )
+  {
+    Ostap::Assert ( 0 <= r && r < NN         ,
+                    "Invalid root node"      ,
+                    "Ostap::TMVA::Forest"    ,
+                    INVALID_FOREST ) ;
+  }
+  //
+  for ( const double w : m_weights ) { m_norm += w ; }
+}
+// ============================================================================
+// the response from the float inputs
+// ============================================================================
+double Ostap::TMVA::Forest::response ( const float* x ) const
+{
+  const Node* nodes = m_nodes.data () ;
+  //
+  if ( m_gradient )
+  {
+    double sum = 0 ;
+    for ( const int root : m_roots )
+    {
+      const Node* node = nodes + root ;
+      while ( 0 <= node->var ) { node = nodes + node->next [ x [ node->var ] >= node->cut ] ; }
+      sum += node->value ;
+    }
+    return 2.0 / ( 1.0 + std::exp ( -2.0 * sum ) ) - 1.0 ;
+  }
+  //
+  if ( m_norm <= 0 ) { return 0 ; }
+  //
+  double sum = 0 ;
+  const std::size_t ntrees = m_roots.size () ;
+  for ( std::size_t i = 0 ; i < ntrees ; ++i )
+  {
+    const Node* node = nodes + m_roots [ i ] ;
+    while ( 0 <= node->var ) { node = nodes + node->next [ x [ node->var ] >= node->cut ] ; }
+    sum += m_weights [ i ] * node->value ;
+  }
+  return sum / m_norm ;
+}
+// ============================================================================
+// evaluate the response for the input vector (at least nvars elements)
+// ============================================================================
+double Ostap::TMVA::Forest::evaluate ( const double* x ) const
+{
+  // avoid the allocation for the typical number of variables
+  if ( m_nvars <= 64 )
+  {
+    float xf [ 64 ] ;
+    std::copy ( x , x + m_nvars , xf ) ;
+    return response ( xf ) ;
+  }
+  std::vector<float> xf ( x , x + m_nvars ) ;
+  return response ( xf.data () ) ;
+}
+// ============================================================================
+// evaluate the response for the input vector
+// ============================================================================
+double Ostap::TMVA::Forest::operator () ( const std::vector<double>& x ) const
+{
+  Ostap::Assert ( m_nvars <= x.size ()           ,
+                  "Invalid size of input vector" ,
+                  "Ostap::TMVA::Forest"          ,
+                  INVALID_FOREST ) ;
+  return evaluate ( x.data () ) ;
+}
+// ============================================================================
+/*  evaluate the responses for the batch of inputs
+ *  @param n      number of input vectors
+ *  @param x      the row-major array of <code>n*nvars</code> input values
+ *  @param result the output array (at least <code>n</code> elements)
+ */
+// ============================================================================
+void Ostap::TMVA::Forest::evaluate
+( const std::size_t n      ,
+  const double*     x      ,
+  double*           result ) const
+{
+  if ( 0 == n || nullptr == x || nullptr == result ) { return ; }
+  std::vector<float> xf ( x , x + n * m_nvars ) ;
+  const float* row = xf.data () ;
+  for ( std::size_t i = 0 ; i < n ; ++i , row += m_nvars ) { result [ i ] = response ( row ) ; }
+}
+// ============================================================================
+/* constructor
+ *  @param forest the compiled forest
+ *  @param inputs the formulas for the input variables
+ *  @param tree   the tree
+ */
+// ============================================================================
+Ostap::TMVA::ForestResponse::ForestResponse
+( const Ostap::TMVA::Forest&      forest ,
+  const std::vector<std::string>& inputs ,
+  const TTree*                    tree   )
+  : ForestResponse ( std::vector<Forest> ( 1 , forest ) , "" , inputs , tree )
+{}
+// ============================================================================
+/* constructor for the ``chopping''
+ *  @param forests  the compiled forests for the categories
+ *  @param chopping the chopping expression
+ *  @param inputs   the formulas for the input variables
+ *  @param tree     the tree
+ */
+// ============================================================================
+Ostap::TMVA::ForestResponse::ForestResponse
+( const std::vector<Ostap::TMVA::Forest>& forests  ,
+  const std::string&                      chopping ,
+  const std::vector<std::string>&         inputs   ,
+  const TTree*                            tree     )
+  : Ostap::IFuncTree ()
+  , m_forests  ( forests  )
+  , m_chopping ( chopping )
+  , m_inputs   ( inputs   )
+  , m_tree     ( nullptr  )
+  , m_formulas (          )
+  , m_chopper  (          )
+  , m_x        ( inputs.size () , 0.0 )
+{
+  Ostap::Assert ( !m_forests.empty ()                         ,
+                  "No forests are specified"                  ,
+                  "Ostap::TMVA::ForestResponse"               ,
+                  INVALID_FOREST ) ;
+  Ostap::Assert ( 1 == m_forests.size () || !m_chopping.empty () ,
+                  "Chopping expression is not specified"         ,
+                  "Ostap::TMVA::ForestResponse"                  ,
+                  INVALID_CHOPPING ) ;
+  for ( const auto& f : m_forests )
+  {
+    Ostap::Assert ( f.nvars () == m_inputs.size ()            ,
+                    "Mismatch in number of input variables"   ,
+                    "Ostap::TMVA::ForestResponse"             ,
+                    INVALID_FOREST ) ;
+  }
+  if ( nullptr != tree ) { make_formulas ( tree ) ; }
+}
+// ============================================================================
+// copy constructor
+// ============================================================================
+Ostap::TMVA::ForestResponse::ForestResponse
+( const Ostap::TMVA::ForestResponse& right )
+  : Ostap::IFuncTree ( right            )
+  , m_forests        ( right.m_forests  )
+  , m_chopping       ( right.m_chopping )
+  , m_inputs         ( right.m_inputs   )
+  , m_tree           ( nullptr          ) // ATTENTION!
+  , m_formulas       (                  ) // ATTENTION!
+  , m_chopper        (                  ) // ATTENTION!
+  , m_x              ( right.m_x        )
+{}
+// ============================================================================
+// destructor
+// ============================================================================
+Ostap::TMVA::ForestResponse::~ForestResponse(){}
+// ============================================================================
+// prepare formulas for the tree
+// ============================================================================
+void Ostap::TMVA::ForestResponse::make_formulas ( const TTree* tree ) const
+{
+  m_tree = tree ;
+  m_formulas.clear () ;
+  m_chopper.reset  () ;
+  //
+  TTree* t = const_cast<TTree*> ( tree ) ;
+  for ( const auto& input : m_inputs )
+  {
+    auto f = std::make_unique<Ostap::Formula> ( input , t ) ;
+    Ostap::Assert ( f && f->ok ()                             ,
+                    "Invalid input formula \"" + input + "\"" ,
+                    "Ostap::TMVA::ForestResponse"             ,
+                    INVALID_FORMULA ) ;
+    m_formulas.push_back ( std::move ( f ) ) ;
+  }
+  //
+  if ( !m_chopping.empty () )
+  {
+    m_chopper = std::make_unique<Ostap::Formula> ( m_chopping , t ) ;
+    Ostap::Assert ( m_chopper && m_chopper->ok ()                       ,
+                    "Invalid chopping formula \"" + m_chopping + "\""   ,
+                    "Ostap::TMVA::ForestResponse"                       ,
+                    INVALID_CHOPPING ) ;
+  }
+}
+// ============================================================================
+// evaluate the response for the current entry
+// ============================================================================
+double Ostap::TMVA::ForestResponse::evaluate () const
+{
+  const std::size_t nv = m_formulas.size () ;
+  for ( std::size_t i = 0 ; i < nv ; ++i ) { m_x [ i ] = m_formulas [ i ]->evaluate () ; }
+  //
+  if ( !m_chopper ) { return m_forests.front ().evaluate ( m_x.data () ) ; }
+  //
+  const double chopval = m_chopper->evaluate () ;
+  Ostap::Assert ( Ostap::Math::islong ( chopval )          ,
+                  "Invalid chopping category"              ,
+                  "Ostap::TMVA::ForestResponse"            ,
+                  INVALID_CHOPPING ) ;
+  const long         choplong = std::lround ( chopval ) ;
+  const unsigned int N        = m_forests.size () ;
+  const unsigned int index    = choplong % N ;
+  return m_forests [ index ].evaluate ( m_x.data () ) ;
+}
+// ============================================================================
+// evaluate the response for TTree
+// ============================================================================
+double Ostap::TMVA::ForestResponse::operator() ( const TTree* tree ) const
+{
+  if ( nullptr != tree && ( tree != m_tree || m_formulas.empty () ) ) { make_formulas ( tree ) ; }
+  Ostap::Assert ( nullptr != m_tree                     ,
+                  "Invalid tree"                        ,
+                  "Ostap::TMVA::ForestResponse"         ,
+                  INVALID_FORMULA ) ;
+  return evaluate () ;
+}
+// ============================================================================
+/*  evaluate the response for the block of entries [first,last)
+ *  the formulas are prepared only once
+ *  @see Ostap::IFuncTree::evaluate_range
+ */
+// ============================================================================
+unsigned long Ostap::TMVA::ForestResponse::evaluate_range
+( const TTree*        tree   ,
+  const unsigned long first  ,
+  const unsigned long last   ,
+  double*             result ) const
+{
+  if ( nullptr == tree || nullptr == result ) { return 0 ; }
+  TTree* t = const_cast<TTree*> ( tree ) ;
+  const unsigned long the_last =
+    std::min ( last , static_cast<unsigned long> ( t->GetEntries () ) ) ;
+  if ( the_last <= first ) { return 0 ; }
+  //
+  if ( tree != m_tree || m_formulas.empty () ) { make_formulas ( tree ) ; }
+  //
+  // track the files of the chain
+  Ostap::Utils::Notifier notifier ( m_formulas.begin () , m_formulas.end () , m_chopper.get () , t ) ;
+  //
+  unsigned long n = 0 ;
+  for ( unsigned long entry = first ; entry < the_last ; ++entry , ++n )
+  {
+    if ( t->LoadTree ( entry ) < 0 ) { break ; }
+    result [ n ] = evaluate () ;
+  }
+  return n ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
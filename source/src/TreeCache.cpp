@@ -0,0 +1,222 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <atomic>
+#include <cstdlib>
+#include <algorithm>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TEnv.h"
+#include "TUrl.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TChain.h"
+#include "TLeaf.h"
+#include "TBranch.h"
+#include "TObjArray.h"
+#include "TTreeFormula.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/TreeCache.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Utils::TreeCache
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-03-12
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// get the boolean flag from the environment variable
+  bool env_flag ( const char* name , const bool default_value )
+  {
+    const char* env = std::getenv ( name ) ;
+    if ( nullptr == env ) { return default_value ; }
+    const std::string value { env } ;
+    return !value.empty() && value != "0" && value != "no" && value != "off" && value != "false" ;
+  }
+  // ==========================================================================
+  /// configure TTreeCache for the loops?
+  std::atomic<bool>  s_enabled { env_flag ( "OSTAP_TREE_CACHE"     , true  ) } ;
+  /// asynchronous prefetching?
+  std::atomic<bool>  s_async   { env_flag ( "OSTAP_ASYNC_PREFETCH" , false ) } ;
+  // ==========================================================================
+  /// minimal cache size
+  const Long64_t s_MIN_SIZE =   1 * 1024 * 1024 ;
+  /// maximal cache size
+  const Long64_t s_MAX_SIZE = 256 * 1024 * 1024 ;
+  // ==========================================================================
+  /** get the cache size: two clusters of the branches used
+   *  (the current one and the prefetched next one)
+   */
+  Long64_t cache_size
+  ( TTree*                       tree     ,
+    const std::set<std::string>& branches )
+  {
+    TTree* t = tree->GetTree () ;
+    if ( nullptr == t ) { return 0 ; }
+    //
+    const Long64_t nentries = t->GetEntries () ;
+    if ( nentries <= 0 ) { return 0 ; }
+    //
+    double bytes = 0 ;
+    for ( const std::string& name : branches )
+    {
+      TBranch* b = t->GetBranch ( name.c_str() ) ;
+      if ( nullptr != b ) { bytes += b->GetZipBytes ( "*" ) ; }
+    }
+    //
+    TTree::TClusterIterator it = t->GetClusterIterator ( 0 ) ;
+    it.Next () ;
+    const Long64_t csize = std::max ( it.GetNextEntry () - it.GetStartEntry () , Long64_t ( 1 ) ) ;
+    //
+    // two clusters and 10% for the baskets overhead
+    const Long64_t size = static_cast<Long64_t> ( 2.2 * bytes * std::min ( csize , nentries ) / nentries ) ;
+    return std::min ( std::max ( size , s_MIN_SIZE ) , s_MAX_SIZE ) ;
+  }
+  // ==========================================================================
+  /// collect the branches from the object
+  void collect_
+  ( const TObject*         object   ,
+    std::set<std::string>& branches )
+  {
+    if ( nullptr == object ) { return ; }
+    const TTreeFormula* formula = dynamic_cast<const TTreeFormula*> ( object ) ;
+    if ( nullptr != formula ) { Ostap::Utils::TreeCache::collect ( formula , branches ) ; }
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor from the tree and the objects
+// ============================================================================
+Ostap::Utils::TreeCache::TreeCache
+( TTree*                             tree    ,
+  const std::vector<const TObject*>& objects ,
+  const bool                         nested  )
+  : m_tree ( tree )
+{
+  if ( nullptr == m_tree || !enabled () ) { return ; }
+  //
+  for ( const TObject* o : objects ) { collect_ ( o , m_branches ) ; }
+  if ( m_branches.empty () ) { return ; }
+  //
+  // in-memory trees do not need the cache
+  if ( nullptr == m_tree->GetCurrentFile () ) { return ; }
+  //
+  if ( nested )
+  {
+    // the cache is already configured: add the branches only
+    for ( const std::string& name : m_branches )
+    { m_tree->AddBranchToCache ( name.c_str () , kTRUE ) ; }
+    return ;
+  }
+  //
+  m_size = cache_size ( m_tree , m_branches ) ;
+  if ( m_size <= 0 ) { return ; }
+  //
+  m_old  = m_tree->GetCacheSize () ;
+  //
+  // (re)create the cache, the asynchronous prefetching is defined at creation
+  const bool prefetch = async () ;
+  const int  old_env  = gEnv->GetValue ( "TFile.AsyncPrefetching" , 0 ) ;
+  if ( prefetch ) { gEnv->SetValue ( "TFile.AsyncPrefetching" , 1 ) ; }
+  m_tree->SetCacheSize ( 0      ) ;
+  m_tree->SetCacheSize ( m_size ) ;
+  if ( prefetch ) { gEnv->SetValue ( "TFile.AsyncPrefetching" , old_env ) ; }
+  //
+  for ( const std::string& name : m_branches )
+  { m_tree->AddBranchToCache ( name.c_str () , kTRUE ) ; }
+  m_tree->StopCacheLearningPhase () ;
+  //
+  m_ok = true ;
+  //
+  notify () ;
+}
+// ============================================================================
+// destructor: reset the cache
+// ============================================================================
+Ostap::Utils::TreeCache::~TreeCache ()
+{
+  if ( !m_ok || nullptr == m_tree ) { return ; }
+  // recreate the cache in the learning mode
+  m_tree->SetCacheSize ( 0 ) ;
+  m_tree->SetCacheSize ( 0 < m_old ? m_old : -1 ) ;
+}
+// ============================================================================
+// new tree in chain: open the next (remote) file asynchronously
+// ============================================================================
+void Ostap::Utils::TreeCache::notify ()
+{
+  if ( !m_ok || !async () ) { return ; }
+  //
+  TChain* chain = dynamic_cast<TChain*> ( m_tree ) ;
+  if ( nullptr == chain ) { return ; }
+  //
+  const int next = chain->GetTreeNumber () + 1 ;
+  if ( next <= m_next ) { return ; }                        // already requested
+  //
+  const TObjArray* files = chain->GetListOfFiles () ;
+  if ( nullptr == files || files->GetEntriesFast () <= next ) { return ; }
+  //
+  const TObject* element = files->At ( next ) ;
+  if ( nullptr == element ) { return ; }
+  //
+  m_next = next ;
+  //
+  // local files are not prefetched
+  const TUrl url ( element->GetTitle () , kTRUE ) ;
+  const std::string protocol = url.GetProtocol () ;
+  if ( protocol.empty () || "file" == protocol ) { return ; }
+  //
+  TFile::AsyncOpen ( element->GetTitle () ) ;
+}
+// ============================================================================
+// configure TTreeCache for the loops?
+// ============================================================================
+bool Ostap::Utils::TreeCache::enabled    () { return s_enabled ; }
+// ============================================================================
+// configure TTreeCache for the loops?
+// ============================================================================
+void Ostap::Utils::TreeCache::setEnabled ( const bool value ) { s_enabled = value ; }
+// ============================================================================
+// asynchronous prefetching?
+// ============================================================================
+bool Ostap::Utils::TreeCache::async      () { return s_async   ; }
+// ============================================================================
+// asynchronous prefetching?
+// ============================================================================
+void Ostap::Utils::TreeCache::setAsync   ( const bool value ) { s_async   = value ; }
+// ============================================================================
+/*  collect the names of branches, used by the formula
+ *  @param formula  the formula
+ *  @param branches (UPDATE) the names of branches
+ *  @return number of added branches
+ */
+// ============================================================================
+std::size_t Ostap::Utils::TreeCache::collect
+( const TTreeFormula*    formula  ,
+  std::set<std::string>& branches )
+{
+  if ( nullptr == formula ) { return 0 ; }
+  const std::size_t size = branches.size () ;
+  //
+  const Int_t ncodes = formula->GetNcodes () ;
+  for ( Int_t i = 0 ; i < ncodes ; ++i )
+  {
+    const TLeaf* leaf = formula->GetLeaf ( i ) ;
+    if ( nullptr == leaf ) { continue ; }
+    const TBranch* branch = leaf->GetBranch () ;
+    if ( nullptr == branch ) { continue ; }
+    branches.insert ( branch->GetName () ) ;
+  }
+  //
+  return branches.size () - size ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
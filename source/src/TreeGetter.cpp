@@ -1,5 +1,9 @@
 // Include files 
 // ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+// ============================================================================
 // ROOT 
 // ============================================================================
 #include "TTree.h"
@@ -26,6 +30,7 @@ namespace
     CANNOT_CREATE_BRANCH  = 751 , 
     CANNOT_CREATE_FORMULA = 752 , 
     CANNOT_READ_TREE      = 753 , 
+    INVALID_BUFFER        = 754 , 
   };
   // ==========================================================================
 }
@@ -116,6 +121,8 @@ Ostap::Trees::Getter::Getter
     m_formulas.push_back ( std::move ( p ) ) ;  
     m_notifier->add ( m_formulas.back().get() ) ;
   }
+  // configure the cache for the formulas 
+  m_notifier->cache () ;
   // ==========================================================================
 }
 // ============================================================================
@@ -144,10 +151,60 @@ Ostap::Trees::Getter::eval ( std::vector<double>& result ) const
   // 
   return Ostap::StatusCode::SUCCESS ;
 }
-
-
-
-
+// ============================================================================
+// get the results for the range of entries 
+// ============================================================================
+Ostap::StatusCode 
+Ostap::Trees::Getter::eval_range 
+( const unsigned long first    , 
+  const unsigned long last     , 
+  double*             buffer   , 
+  const unsigned long size     , 
+  const bool          rowmajor ) const 
+{
+  if ( m_tree == nullptr ) { return INVALID_TREE ; }
+  //
+  const unsigned long nentries = m_tree->GetEntries () ;
+  const unsigned long the_last = std::min ( last , nentries ) ;
+  if ( the_last <= first ) { return Ostap::StatusCode::SUCCESS ; }
+  //
+  const unsigned long nrows = the_last - first     ;
+  const unsigned long ncols = m_formulas.size ()   ;
+  if ( nullptr == buffer || size < nrows * ncols ) { return INVALID_BUFFER ; }
+  //
+  for ( unsigned long i = 0 ; i < nrows ; ++i ) 
+  {
+    const Long64_t ievent = m_tree->GetEntryNumber ( first + i ) ;
+    if ( ievent < 0 ) { return CANNOT_READ_TREE ; }
+    /// the notifier takes care about the formulas for the new tree in chain  
+    if ( m_tree->LoadTree ( ievent ) < 0 ) { return CANNOT_READ_TREE ; }
+    //
+    for ( unsigned long j = 0 ; j < ncols ; ++j ) 
+    { buffer [ rowmajor ? i * ncols + j : j * nrows + i ] = m_formulas [ j ]->evaluate () ; }
+  }
+  //
+  return Ostap::StatusCode::SUCCESS ;
+}
+// ============================================================================
+// get the results for the range of entries 
+// ============================================================================
+Ostap::StatusCode 
+Ostap::Trees::Getter::eval_range 
+( const unsigned long  first    , 
+  const unsigned long  last     , 
+  std::vector<double>& result   , 
+  const bool           rowmajor ) const 
+{
+  result.clear() ;
+  if ( m_tree == nullptr ) { return INVALID_TREE ; }
+  //
+  const unsigned long nentries = m_tree->GetEntries () ;
+  const unsigned long the_last = std::min ( last , nentries ) ;
+  if ( the_last <= first ) { return Ostap::StatusCode::SUCCESS ; }
+  //
+  result.resize ( ( the_last - first ) * m_formulas.size () ) ;
+  return eval_range ( first , the_last , result.data () , result.size () , rowmajor ) ;
+}
 // ============================================================================
 //                                                                      The END 
 // ============================================================================
@@ -9,10 +9,11 @@
 #include <algorithm>
 #include <numeric>
 #include <memory>
+#include <thread>
+#include <atomic>
 // ============================================================================
 // ROOT & RooFit 
 // ============================================================================
-#include "TIterator.h"
 #include "TCanvas.h"
 #include "TAxis.h"
 #include "TMath.h"
@@ -28,7 +29,11 @@
 // ============================================================================
 #include "Ostap/Power.h"
 #include "Ostap/UStat.h"
-#include "Ostap/Iterator.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "local_mt.h"
+#include "local_snapshot.h"
 // ============================================================================
 /** @file
  *  Implementation file for class Analysis::UStat
@@ -40,27 +45,146 @@
 namespace 
 {
   // ==========================================================================
-  double getDistance ( const RooArgSet* x , 
-                       const RooArgSet* y )
+  /** @class KDTree 
+   *  Simple static k-d tree for the nearest-neighbour search.
+   *  The tree is implicit: for the range of indices <code>[lo,hi)</code> 
+   *  the median point is placed at <code>mid=(lo+hi)/2</code>, 
+   *  the points with smaller(larger) coordinate along the 
+   *  split dimension are placed at <code>[lo,mid)</code> 
+   *  (<code>[mid+1,hi)</code>)
+   */
+  class KDTree 
   {
-    if ( 0 == x || 0 == y ) { return -1 ; } // RETURN 
-    //
-    double result = 0.;
-    //
-    Ostap::Utils::Iterator xIter ( *x ) ;
-    Ostap::Utils::Iterator yIter ( *y ) ;
-    //
-    RooRealVar* xVar = 0 ;
-    RooRealVar* yVar = 0 ;
-    while ( ( xVar = (RooRealVar*)xIter -> Next() ) && 
-            ( yVar = (RooRealVar*)yIter -> Next() )    ) 
+  public:
+    // ========================================================================
+    /// the size of leaves 
+    enum { LEAF = 16 } ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    /** constructor 
+     *  @param points (INPUT) the points, stored row-wise 
+     *  @param dim    (INPUT) dimension 
+     */
+    KDTree ( const std::vector<double>& points , 
+             const unsigned int         dim    ) 
+      : m_points ( points ) 
+      , m_dim    ( dim    ) 
+      , m_index  ( 0 < dim ? points.size () / dim : 0 ) 
+      , m_split  ( m_index.size () , 0 ) 
     {
-      const double val  = xVar->getVal() - yVar->getVal() ;
-      result           += val*val ;
+      std::iota ( m_index.begin () , m_index.end () , 0 ) ;
+      build ( 0 , m_index.size () ) ;
     }
-    //
-    return std::sqrt ( result ) ;
-  }
+    // ========================================================================
+  public:
+    // ========================================================================
+    /** get the distance to the nearest neighbour for the given point 
+     *  @param i (INPUT) index of the point 
+     *  @return the distance to the nearest point (excluding point itself)
+     */
+    double nearest ( const std::size_t i ) const 
+    {
+      double best2 = 1.e+200 ;
+      search ( 0 , m_index.size () , i , point ( i ) , best2 ) ;
+      return std::sqrt ( best2 ) ;
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// get the point 
+    inline const double* point ( const std::size_t i ) const 
+    { return m_points.data () + i * m_dim ; }
+    // ========================================================================
+    /// squared distance between two points 
+    inline double dist2 ( const double* a , const double* b ) const 
+    {
+      double result = 0 ;
+      for ( unsigned int k = 0 ; k < m_dim ; ++k ) 
+      { const double d = a [ k ] - b [ k ] ; result += d * d ; }
+      return result ;
+    }
+    // ========================================================================
+    /// build the tree for the range [lo,hi)
+    void build ( const std::size_t lo , const std::size_t hi ) 
+    {
+      if ( hi <= lo + LEAF ) { return ; }
+      // split along the dimension with the largest spread 
+      unsigned int split  = 0 ;
+      double       spread = -1 ;
+      for ( unsigned int k = 0 ; k < m_dim ; ++k ) 
+      {
+        double vmin = point ( m_index [ lo ] ) [ k ] ;
+        double vmax = vmin ;
+        for ( std::size_t j = lo + 1 ; j < hi ; ++j ) 
+        {
+          const double v = point ( m_index [ j ] ) [ k ] ;
+          vmin = std::min ( vmin , v ) ;
+          vmax = std::max ( vmax , v ) ;
+        }
+        if ( spread < vmax - vmin ) { spread = vmax - vmin ; split = k ; }
+      }
+      //
+      const std::size_t mid = ( lo + hi ) / 2 ;
+      std::nth_element 
+        ( m_index.begin () + lo  , 
+          m_index.begin () + mid , 
+          m_index.begin () + hi  , 
+          [this,split] ( const std::size_t a , const std::size_t b ) 
+          { return point ( a ) [ split ] < point ( b ) [ split ] ; } ) ;
+      m_split [ mid ] = split ;
+      //
+      build ( lo      , mid ) ;
+      build ( mid + 1 , hi  ) ;
+    }
+    // ========================================================================
+    /// search for the nearest neighbour in the range [lo,hi)
+    void search ( const std::size_t lo    , 
+                  const std::size_t hi    , 
+                  const std::size_t self  , 
+                  const double*     q     , 
+                  double&           best2 ) const 
+    {
+      if ( hi <= lo + LEAF ) 
+      {
+        for ( std::size_t j = lo ; j < hi ; ++j ) 
+        {
+          const std::size_t k = m_index [ j ] ;
+          if ( k == self ) { continue ; }
+          best2 = std::min ( best2 , dist2 ( q , point ( k ) ) ) ;
+        }
+        return ;
+      }
+      //
+      const std::size_t mid = ( lo + hi ) / 2 ;
+      const std::size_t k   = m_index [ mid ] ;
+      if ( k != self ) { best2 = std::min ( best2 , dist2 ( q , point ( k ) ) ) ; }
+      //
+      const double diff = q [ m_split [ mid ] ] - point ( k ) [ m_split [ mid ] ] ;
+      if ( diff < 0 ) 
+      {
+        search ( lo , mid , self , q , best2 ) ;
+        if ( diff * diff < best2 ) { search ( mid + 1 , hi  , self , q , best2 ) ; }
+      }
+      else 
+      {
+        search ( mid + 1 , hi  , self , q , best2 ) ;
+        if ( diff * diff < best2 ) { search ( lo       , mid , self , q , best2 ) ; }
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the points 
+    const std::vector<double>&  m_points ; // the points 
+    /// dimension 
+    unsigned int                m_dim    ; // dimension 
+    /// permutation of points 
+    std::vector<std::size_t>    m_index  ; // permutation of points 
+    /// split dimensions 
+    std::vector<unsigned short> m_split  ; // split dimensions 
+    // ========================================================================
+  } ;
   // ==========================================================================
   /// get the volume of n-ball with unit radius 
   double nBallVolume ( const unsigned int n )
@@ -75,19 +199,24 @@ namespace
 } //                                                 end of anonymous namespace  
 // ============================================================================
 /*  calculate U-statistics 
- *  @param pdf   (input) PDF
- *  @param data  (input) data 
- *  @param hist  (update) the histogram with U-statistics 
- *  @param args  (input)  the arguments
- *  @param tStat (output,optional) value for T-statistics 
+ *  - the data are copied once into the contiguous array 
+ *  - the distances to the nearest neighbours are calculated 
+ *    using k-d tree, in parallel 
+ *  @param pdf      (input) PDF
+ *  @param data     (input) data 
+ *  @param hist     (update) the histogram with U-statistics 
+ *  @param args     (input)  the arguments
+ *  @param tStat    (output,optional) value for T-statistics 
+ *  @param nthreads (input)  number of threads 
  */
 // ============================================================================
 Ostap::StatusCode Ostap::UStat::calculate
-( const RooAbsPdf&  pdf   , 
-  const RooDataSet& data  ,  
-  TH1&              hist  ,
-  double&           tStat ,
-  RooArgSet*        args  ) 
+( const RooAbsPdf&   pdf      , 
+  const RooDataSet&  data     ,  
+  TH1&               hist     ,
+  double&            tStat    ,
+  RooArgSet*         args     , 
+  const unsigned int nthreads ) 
 {
   //
   if ( 0 == args ) { args = pdf.getObservables ( data ) ; }
@@ -97,68 +226,76 @@ Ostap::StatusCode Ostap::UStat::calculate
   if ( 1 > dim   ) { return Ostap::StatusCode( InvalidDims ) ; }
   const double volume = nBallVolume ( dim ) ;
   //
-  typedef std::vector<double> TStat ;
-  TStat tstat ;
-  //
-  const RooDataSet*  cloned = (RooDataSet*)data.Clone() ;
-  //
   const unsigned int num    = data.numEntries () ;
   //
-  const RooArgSet * event_x = 0 ;
-  const RooArgSet * event_y = 0 ;
+  // 1. the variables in dataset and the variables for PDF  
+  const RooArgSet* row = data.get () ;
+  if ( 0 == row || 0 == row->getSize() ) { return Ostap::StatusCode ( InvalidItem1 ) ; }
+  //
+  std::vector<RooRealVar*> pvars ;
+  for ( RooAbsArg* arg : *args ) 
+  {
+    RooRealVar* pv = dynamic_cast<RooRealVar*> ( arg ) ;
+    if ( 0 == pv ) { return Ostap::StatusCode ( InvalidItem2 ) ; }  // RETURN 
+    pvars.push_back ( pv ) ;
+  }
+  ValueSnapshot snapshot ( data , pvars ) ;
+  if ( !snapshot.ok () ) { return Ostap::StatusCode ( InvalidItem2 ) ; }  // RETURN 
   //
+  // 2. copy data into contiguous array and evaluate PDF 
+  std::vector<double> points ( std::size_t ( num ) * dim ) ;
+  std::vector<double> pdfs   ( num ) ;
   for ( unsigned int i = 0 ; i < num ; ++i ) 
   {
-    //
-    // 1. Get "Event"
-    event_x = data . get(i) ;      
-    if ( 0 == event_x || 0 == event_x->getSize() ) 
-    { return Ostap::StatusCode ( InvalidItem1 ) ; }             // RETURN 
-    //
-    std::unique_ptr<RooArgSet> event_i ( ( RooArgSet*)event_x->selectCommon( *args ) ) ;
-    if ( !event_i || 0 == event_i->getSize() ) 
-    { return Ostap::StatusCode ( InvalidItem2 ) ; }             // RETURN 
-    //
-    // 2.Evaluate PDF 
-    Ostap::Utils::Iterator iter  ( *args ) ;
-    RooRealVar * var = 0 ;
-    while ( (var = (RooRealVar*)iter->Next() ) ) 
-    { var->setVal( event_i->getRealValue( var->GetName() ) ); }
-    //
-    const double pdfValue = pdf . getVal( args ) ;
-    //
-    double min_distance  = 1.e+100 ;
-    for ( unsigned int j = 0 ; j < num ; ++j ) 
+    const double* values = snapshot.load ( i ) ;
+    if ( 0 == values ) { return Ostap::StatusCode ( InvalidItem1 ) ; } // RETURN 
+    double* p = points.data () + std::size_t ( i ) * dim ;
+    for ( unsigned int k = 0 ; k < dim ; ++k ) 
     {
-      if ( i == j ) { continue ; }
-      //
-      event_y = cloned->get(j) ;      
-      if ( 0 == event_y || 0 == event_y->getSize() ) 
-      { return Ostap::StatusCode ( InvalidItem1 ) ; }            // RETURN 
-      //
-      std::unique_ptr<RooArgSet> event_j ( ( RooArgSet*)event_y->selectCommon( *args ) ) ;
-      if ( !event_j || 0 == event_j->getSize() )  
-      { return Ostap::StatusCode ( InvalidItem2 ) ; }            // RETURN 
-      //
-      const double distance = getDistance ( event_i.get() , event_j.get() ) ;
-      if ( 0 > distance ) { return Ostap::StatusCode( InvalidDist ) ; }  // RETURN 
-      //
-      if ( 0 == j || distance < min_distance ) 
-      { min_distance = distance  ; }
-      //
+      p [ k ] = values [ k ] ;
+      pvars [ k ] ->setVal ( p [ k ] ) ;
     }
-    //
+    pdfs [ i ] = pdf . getVal( args ) ;
+  }
+  //
+  // 3. the nearest neighbours: k-d tree, queries are made in parallel 
+  const KDTree tree ( points , dim ) ;
+  std::vector<double> distances ( num , 1.e+100 ) ;
+  //
+  const unsigned int  CHUNK = 1024 ;
+  const unsigned int  nt    = std::min 
+    ( Ostap::Utils::nThreads ( nthreads ) , ( num + CHUNK - 1 ) / CHUNK ) ;
+  std::atomic<unsigned int> next { 0 } ;
+  auto task = [&]() 
+    {
+      for ( unsigned int i0 = CHUNK * next++ ; i0 < num ; i0 = CHUNK * next++ ) 
+      {
+        const unsigned int i1 = std::min ( num , i0 + CHUNK ) ;
+        for ( unsigned int i = i0 ; i < i1 ; ++i ) { distances [ i ] = tree.nearest ( i ) ; }
+      }
+    } ;
+  if ( nt <= 1 ) { task () ; }
+  else 
+  {
+    std::vector<std::thread> threads ; threads.reserve ( nt ) ;
+    for ( unsigned int t = 0 ; t < nt ; ++t ) { threads.emplace_back ( task ) ; }
+    for ( auto& t : threads ) { t.join () ; }
+  }
+  //
+  // 4. U-statistics 
+  typedef std::vector<double> TStat ;
+  TStat tstat ; tstat.reserve ( num ) ;
+  for ( unsigned int i = 0 ; i < num ; ++i ) 
+  {
     // volume of n-ball: 
-    const double val1 = volume * Ostap::Math::POW ( min_distance , dim ) ;
+    const double val1 = volume * Ostap::Math::POW ( distances [ i ] , dim ) ;
     //
-    const double value = std::exp ( -val1 * num * pdfValue ) ;
+    const double value = std::exp ( -val1 * num * pdfs [ i ] ) ;
     //
     hist.Fill ( value ) ;
     //
     tstat.push_back ( value ) ; 
-    //
-  } 
-  delete cloned ;
+  }
   //
   // calculate T-statistics
   //
@@ -0,0 +1,325 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <filesystem>
+#include <system_error>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TFile.h"
+#include "TTree.h"
+#include "TH1.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/AddBranch.h"
+#include "Ostap/UpdateFiles.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+// ============================================================================
+/** @file
+ *  Implementation file for functions from file Ostap/UpdateFiles.h
+ *  @see Ostap::Trees::update_files
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  namespace fs = std::filesystem ;
+  // ==========================================================================
+  /// is it the local file ?
+  bool local_file ( const std::string& name )
+  {
+    if ( std::string::npos != name.find ( "://" ) ) { return false ; }
+    std::error_code ec ;
+    return fs::is_regular_file ( fs::path ( name ) , ec ) ;
+  }
+  // ==========================================================================
+  /** update the tree in one file
+   *  @return number of entries in the tree (or -1 for failure)
+   */
+  long long update_one
+  ( const std::string&                fname  ,
+    const std::string&                tname  ,
+    const std::size_t                 index  ,
+    const Ostap::Trees::TREEUPDATE&   update ,
+    const bool                        atomic )
+  {
+    // update the temporary copy of the local file ?
+    const bool        copy   = atomic && local_file ( fname ) ;
+    const std::string target = copy ? fname + ".ostap-update" : fname ;
+    std::error_code   ec     ;
+    if ( copy && !fs::copy_file ( fname , target , fs::copy_options::overwrite_existing , ec ) )
+    { return -1 ; }                                                       // RETURN
+    //
+    long long entries = -1 ;
+    {
+      std::unique_ptr<TFile> file ( TFile::Open ( target.c_str () , "UPDATE" ) ) ;
+      if ( file && !file->IsZombie () && file->IsWritable () )
+      {
+        TTree* tree = nullptr ;
+        file->GetObject ( tname.c_str () , tree ) ;
+        if ( nullptr != tree && update ( tree , index ).isSuccess () )
+        {
+          entries = tree->GetEntries () ;
+          file->Write ( "" , TObject::kOverwrite ) ;
+        }
+        file->Close () ;
+      }
+    }
+    //
+    if ( copy )
+    {
+      // atomic finalization: replace the original file
+      if ( 0 <= entries ) { fs::rename ( target , fname , ec ) ; if ( ec ) { entries = -1 ; } }
+      if ( entries < 0  ) { fs::remove ( target , ec ) ; }
+    }
+    return entries ;
+  }
+  // ==========================================================================
+  /// number of entries in the trees
+  std::vector<unsigned long> tree_entries
+  ( const std::vector<std::string>& files ,
+    const std::string&              tname )
+  {
+    std::vector<unsigned long> result ( files.size () , 0 ) ;
+    for ( std::size_t i = 0 ; i < files.size () ; ++i )
+    {
+      std::unique_ptr<TFile> file ( TFile::Open ( files [ i ].c_str () , "READ" ) ) ;
+      Ostap::Assert ( file && !file->IsZombie () ,
+                      "Cannot open file " + files [ i ] ,
+                      "Ostap::Trees::add_branch_files" ) ;
+      TTree* tree = nullptr ;
+      file->GetObject ( tname.c_str () , tree ) ;
+      Ostap::Assert ( nullptr != tree ,
+                      "No tree " + tname + " in file " + files [ i ] ,
+                      "Ostap::Trees::add_branch_files" ) ;
+      result [ i ] = tree->GetEntries () ;
+    }
+    return result ;
+  }
+  // ==========================================================================
+#if ROOT_VERSION(6,24,0)<=ROOT_VERSION_CODE
+  // ==========================================================================
+  /// copy data from the buffer into new branch in all files
+  template <class DATA>
+  Ostap::Trees::UpdateStat _add_branch_files_
+  ( const std::vector<std::string>&          files    ,
+    const std::string&                       tname    ,
+    const std::string&                       name     ,
+    const DATA*                              data     ,
+    const unsigned long                      size     ,
+    const DATA                               value    ,
+    const unsigned int                       nthreads ,
+    const bool                               atomic   )
+  {
+    Ostap::Assert ( nullptr != data || 0 == size ,
+                    "Invalid buffer"             ,
+                    "Ostap::Trees::add_branch_files" ) ;
+    //
+    // the offsets of the files in the buffer
+    const std::vector<unsigned long> entries = tree_entries ( files , tname ) ;
+    std::vector<unsigned long> offsets ( files.size () , 0 ) ;
+    for ( std::size_t i = 1 ; i < files.size () ; ++i )
+    { offsets [ i ] = offsets [ i - 1 ] + entries [ i - 1 ] ; }
+    //
+    return Ostap::Trees::update_files
+      ( files , tname ,
+        [&] ( TTree* tree , const std::size_t index ) -> Ostap::StatusCode
+        {
+          const unsigned long start  = std::min ( offsets [ index ] , size ) ;
+          const DATA*         buffer = nullptr != data ? data + start : &value ;
+          return Ostap::Trees::add_branch ( tree , name , buffer , size - start , value ) ;
+        } , nthreads , atomic ) ;
+  }
+  // ==========================================================================
+#endif
+  // ==========================================================================
+}
+// ============================================================================
+/*  update the trees with the given name in all files
+ *  @param files    the files
+ *  @param tree     the name of the tree (including the directory)
+ *  @param update   the function to update the tree
+ *  @param nthreads number of threads
+ *  @param atomic   update the local files via the temporary copy
+ *  @return statistics of the update
+ */
+// ============================================================================
+Ostap::Trees::UpdateStat
+Ostap::Trees::update_files
+( const std::vector<std::string>& files    ,
+  const std::string&              tree     ,
+  Ostap::Trees::TREEUPDATE        update   ,
+  const unsigned int              nthreads ,
+  const bool                      atomic   )
+{
+  UpdateStat stat {} ;
+  const std::size_t N = files.size () ;
+  if ( 0 == N ) { return stat ; }                                         // RETURN
+  //
+  const auto start = std::chrono::steady_clock::now () ;
+  //
+  std::atomic<unsigned long> nfiles   { 0 } ;
+  std::atomic<unsigned long> nfailed  { 0 } ;
+  std::atomic<unsigned long> nentries { 0 } ;
+  auto one = [&] ( const std::size_t i )
+    {
+      const long long n = update_one ( files [ i ] , tree , i , update , atomic ) ;
+      if ( 0 <= n ) { ++nfiles ; nentries += n ; }
+      else          { ++nfailed ; }
+    } ;
+  //
+  const unsigned int nt = std::min<std::size_t>
+    ( N , 1 == nthreads ? 1u : Ostap::Utils::nThreads ( nthreads ) ) ;
+  if ( nt <= 1 ) { for ( std::size_t i = 0 ; i < N ; ++i ) { one ( i ) ; } }
+  else
+  {
+    Ostap::Utils::thread_safety () ;
+    std::atomic<std::size_t> next { 0 } ;
+    Ostap::Utils::WorkerPool pool ( nt ) ;
+    pool.run ( [&] ( const unsigned int /* index */ )
+      { for ( std::size_t i = next++ ; i < N ; i = next++ ) { one ( i ) ; } } ) ;
+  }
+  //
+  stat.files   = nfiles   ;
+  stat.failed  = nfailed  ;
+  stat.entries = nentries ;
+  stat.seconds = std::chrono::duration<double> ( std::chrono::steady_clock::now () - start ).count () ;
+  return stat ;
+}
+// ============================================================================
+/*  add new branches to the trees in all files
+ *  @param files    the files
+ *  @param tree     the name of the tree (including the directory)
+ *  @param branches the map name->formula
+ *  @param nthreads number of threads
+ *  @param atomic   update the local files via the temporary copy
+ *  @return statistics of the update
+ */
+// ============================================================================
+Ostap::Trees::UpdateStat
+Ostap::Trees::add_branch_files
+( const std::vector<std::string>&          files    ,
+  const std::string&                       tree     ,
+  const std::map<std::string,std::string>& branches ,
+  const unsigned int                       nthreads ,
+  const bool                               atomic   )
+{
+  return update_files
+    ( files , tree ,
+      [&branches] ( TTree* t , const std::size_t /* index */ ) -> Ostap::StatusCode
+      { return add_branch ( t , branches ) ; } , nthreads , atomic ) ;
+}
+// ============================================================================
+/*  add new branches to the trees in all files
+ *  @param files    the files
+ *  @param tree     the name of the tree (including the directory)
+ *  @param branches the map name->function
+ *  @param atomic   update the local files via the temporary copy
+ *  @return statistics of the update
+ */
+// ============================================================================
+Ostap::Trees::UpdateStat
+Ostap::Trees::add_branch_files
+( const std::vector<std::string>&          files    ,
+  const std::string&                       tree     ,
+  const Ostap::Trees::FUNCTREEMAP&         branches ,
+  const bool                               atomic   )
+{
+  return update_files
+    ( files , tree ,
+      [&branches] ( TTree* t , const std::size_t /* index */ ) -> Ostap::StatusCode
+      { return add_branch ( t , branches ) ; } , 1 , atomic ) ;
+}
+// ============================================================================
+/*  add new branch to the trees in all files, sampling it from the histogram
+ *  @param files    the files
+ *  @param tree     the name of the tree (including the directory)
+ *  @param name     the name of new branch
+ *  @param histo    the histogram to be sampled
+ *  @param atomic   update the local files via the temporary copy
+ *  @return statistics of the update
+ */
+// ============================================================================
+Ostap::Trees::UpdateStat
+Ostap::Trees::add_branch_files
+( const std::vector<std::string>&          files    ,
+  const std::string&                       tree     ,
+  const std::string&                       name     ,
+  const TH1&                               histo    ,
+  const bool                               atomic   )
+{
+  return update_files
+    ( files , tree ,
+      [&name,&histo] ( TTree* t , const std::size_t /* index */ ) -> Ostap::StatusCode
+      { return add_branch ( t , name , histo ) ; } , 1 , atomic ) ;
+}
+// ============================================================================
+#if ROOT_VERSION(6,24,0)<=ROOT_VERSION_CODE
+// ============================================================================
+// copy data from the buffer into new branch in all files
+// ============================================================================
+Ostap::Trees::UpdateStat
+Ostap::Trees::add_branch_files
+( const std::vector<std::string>&          files    ,
+  const std::string&                       tree     ,
+  const std::string&                       name     ,
+  const double*                            data     ,
+  const unsigned long                      size     ,
+  const double                             value    ,
+  const unsigned int                       nthreads ,
+  const bool                               atomic   )
+{ return _add_branch_files_ ( files , tree , name , data , size , value , nthreads , atomic ) ; }
+// ============================================================================
+Ostap::Trees::UpdateStat
+Ostap::Trees::add_branch_files
+( const std::vector<std::string>&          files    ,
+  const std::string&                       tree     ,
+  const std::string&                       name     ,
+  const float*                             data     ,
+  const unsigned long                      size     ,
+  const float                              value    ,
+  const unsigned int                       nthreads ,
+  const bool                               atomic   )
+{ return _add_branch_files_ ( files , tree , name , data , size , value , nthreads , atomic ) ; }
+// ============================================================================
+Ostap::Trees::UpdateStat
+Ostap::Trees::add_branch_files
+( const std::vector<std::string>&          files    ,
+  const std::string&                       tree     ,
+  const std::string&                       name     ,
+  const int*                               data     ,
+  const unsigned long                      size     ,
+  const int                                value    ,
+  const unsigned int                       nthreads ,
+  const bool                               atomic   )
+{ return _add_branch_files_ ( files , tree , name , data , size , value , nthreads , atomic ) ; }
+// ============================================================================
+Ostap::Trees::UpdateStat
+Ostap::Trees::add_branch_files
+( const std::vector<std::string>&          files    ,
+  const std::string&                       tree     ,
+  const std::string&                       name     ,
+  const long*                              data     ,
+  const unsigned long                      size     ,
+  const long                               value    ,
+  const unsigned int                       nthreads ,
+  const bool                               atomic   )
+{ return _add_branch_files_ ( files , tree , name , data , size , value , nthreads , atomic ) ; }
+// ============================================================================
+#endif
+// ============================================================================
+//                                                                      The END
+// ============================================================================
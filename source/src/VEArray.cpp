@@ -0,0 +1,595 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <algorithm>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "TH1.h"
+#include "TArrayD.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/VEArray.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file
+ *  Implementation file for class Ostap::Math::VEArray
+ *  @see Ostap::Math::VEArray
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2023-02-01
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /// positive part of the covariance
+  inline double _pos ( const double c ) { return 0 < c ? c : 0.0 ; }
+  // ==========================================================================
+  /// check the sizes of two arrays
+  inline void _check
+  ( const Ostap::Math::VEArray& a ,
+    const Ostap::Math::VEArray& b ,
+    const char*                 tag )
+  {
+    Ostap::Assert ( a.size () == b.size ()      ,
+                    "Mismatch in array sizes"   ,
+                    std::string ( "Ostap::Math::VEArray::" ) + tag ) ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// constructor: n identical elements
+// ============================================================================
+Ostap::Math::VEArray::VEArray
+( const std::size_t n     ,
+  const double      value ,
+  const double      cov2  )
+  : m_values ( n , value )
+  , m_cov2s  ( n , cov2  )
+{}
+// ============================================================================
+// constructor from the values and (optional) squared uncertainties
+// ============================================================================
+Ostap::Math::VEArray::VEArray
+( const Data& values ,
+  const Data& cov2s  )
+  : m_values ( values )
+  , m_cov2s  ( cov2s  )
+{
+  Ostap::Assert ( m_cov2s.empty () || m_cov2s.size () == m_values.size () ,
+                  "Mismatch in sizes of values and covariances"             ,
+                  "Ostap::Math::VEArray"                                    ) ;
+  m_cov2s.resize ( m_values.size () , 0.0 ) ;
+}
+// ============================================================================
+// constructor from the values and squared uncertainties
+// ============================================================================
+Ostap::Math::VEArray::VEArray
+( const double*     values ,
+  const double*     cov2s  ,
+  const std::size_t n      )
+  : m_values ( n , 0.0 )
+  , m_cov2s  ( n , 0.0 )
+{
+  if ( nullptr != values && n ) { std::copy ( values , values + n , m_values.begin () ) ; }
+  if ( nullptr != cov2s  && n ) { std::copy ( cov2s  , cov2s  + n , m_cov2s .begin () ) ; }
+}
+// ============================================================================
+// constructor from the vector of values with errors
+// ============================================================================
+Ostap::Math::VEArray::VEArray
+( const Ostap::Math::ValueWithError::Vector& vct )
+  : m_values ( vct.size () )
+  , m_cov2s  ( vct.size () )
+{
+  const std::size_t n = vct.size () ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    m_values [ i ] = vct [ i ].value () ;
+    m_cov2s  [ i ] = vct [ i ].cov2  () ;
+  }
+}
+// ============================================================================
+// constructor from the histogram
+// ============================================================================
+Ostap::Math::VEArray::VEArray
+( const TH1& histo )
+  : m_values ( histo.GetNcells () )
+  , m_cov2s  ( histo.GetNcells () )
+{
+  const std::size_t n     = m_values.size () ;
+  // double-precision histograms: use the underlying arrays directly
+  const TArrayD*    a     = dynamic_cast<const TArrayD*> ( &histo ) ;
+  const TArrayD*    sumw2 = histo.GetSumw2 () ;
+  //
+  if ( nullptr != a && n == static_cast<std::size_t> ( a->GetSize () ) )
+  { std::copy ( a->GetArray () , a->GetArray () + n , m_values.begin () ) ; }
+  else
+  { for ( std::size_t i = 0 ; i < n ; ++i ) { m_values [ i ] = histo.GetBinContent ( i ) ; } }
+  //
+  if ( nullptr != sumw2 && n == static_cast<std::size_t> ( sumw2->GetSize () ) )
+  { std::copy ( sumw2->GetArray () , sumw2->GetArray () + n , m_cov2s.begin () ) ; }
+  else
+  {
+    for ( std::size_t i = 0 ; i < n ; ++i )
+    {
+      const double e = histo.GetBinError ( i ) ;
+      m_cov2s [ i ] = e * e ;
+    }
+  }
+}
+// ============================================================================
+// get the element with the check of index
+// ============================================================================
+Ostap::Math::ValueWithError
+Ostap::Math::VEArray::at ( const std::size_t i ) const
+{
+  Ostap::Assert ( i < size ()              ,
+                  "Index is out of range"  ,
+                  "Ostap::Math::VEArray"   ) ;
+  return (*this)[ i ] ;
+}
+// ============================================================================
+// resize the array
+// ============================================================================
+void Ostap::Math::VEArray::resize ( const std::size_t n )
+{
+  m_values.resize ( n , 0.0 ) ;
+  m_cov2s .resize ( n , 0.0 ) ;
+}
+// ============================================================================
+// convert to the vector of values with errors
+// ============================================================================
+Ostap::Math::ValueWithError::Vector
+Ostap::Math::VEArray::vector () const
+{
+  const std::size_t n = size () ;
+  ValueWithError::Vector result ( n ) ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  { result [ i ] = ValueWithError ( m_values [ i ] , m_cov2s [ i ] ) ; }
+  return result ;
+}
+// ============================================================================
+// put the content to the histogram
+// ============================================================================
+void Ostap::Math::VEArray::to_histo ( TH1& histo ) const
+{
+  const std::size_t n = size () ;
+  Ostap::Assert ( n == static_cast<std::size_t> ( histo.GetNcells () ) ,
+                  "Mismatch in array size and number of histogram cells" ,
+                  "Ostap::Math::VEArray::to_histo" ) ;
+  //
+  if ( nullptr == histo.GetSumw2 () || 0 == histo.GetSumw2N () ) { histo.Sumw2 () ; }
+  //
+  TArrayD*  a     = dynamic_cast<TArrayD*> ( &histo ) ;
+  TArrayD*  sumw2 = histo.GetSumw2 () ;
+  //
+  if ( nullptr != a && n == static_cast<std::size_t> ( a->GetSize () ) )
+  { std::copy ( m_values.begin () , m_values.end () , a->GetArray () ) ; }
+  else
+  { for ( std::size_t i = 0 ; i < n ; ++i ) { histo.SetBinContent ( i , m_values [ i ] ) ; } }
+  //
+  if ( nullptr != sumw2 && n == static_cast<std::size_t> ( sumw2->GetSize () ) )
+  {
+    double* s = sumw2->GetArray () ;
+    for ( std::size_t i = 0 ; i < n ; ++i ) { s [ i ] = _pos ( m_cov2s [ i ] ) ; }
+  }
+  else
+  { for ( std::size_t i = 0 ; i < n ; ++i ) { histo.SetBinError ( i , std::sqrt ( _pos ( m_cov2s [ i ] ) ) ) ; } }
+  //
+  histo.SetEntries ( histo.GetEffectiveEntries () ) ;
+}
+// ============================================================================
+// sum of all elements
+// ============================================================================
+Ostap::Math::ValueWithError
+Ostap::Math::VEArray::sum () const
+{
+  const std::size_t n = size () ;
+  double v = 0 ;
+  double c = 0 ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    v +=        m_values [ i ]   ;
+    c += _pos ( m_cov2s  [ i ] ) ;
+  }
+  return ValueWithError ( v , c ) ;
+}
+// ============================================================================
+// arithmetic mean of all elements: sum/n
+// ============================================================================
+Ostap::Math::ValueWithError
+Ostap::Math::VEArray::mean () const
+{
+  if ( empty () ) { return ValueWithError () ; }
+  return sum () / double ( size () ) ;
+}
+// ============================================================================
+// weighted average of all elements
+// ============================================================================
+Ostap::Math::ValueWithError
+Ostap::Math::VEArray::weighted_average () const
+{
+  const std::size_t n = size () ;
+  double sw  = 0 ;
+  double swv = 0 ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double c = m_cov2s [ i ] ;
+    const double w = 0 < c ? 1.0 / c : 0.0 ;
+    sw  += w ;
+    swv += w * m_values [ i ] ;
+  }
+  //
+  if ( 0 < sw ) { return ValueWithError ( swv / sw , 1.0 / sw ) ; }
+  //
+  // no elements with positive covariances: plain mean of values
+  if ( empty () ) { return ValueWithError () ; }
+  double sv = 0 ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) { sv += m_values [ i ] ; }
+  return ValueWithError ( sv / n , 0.0 ) ;
+}
+// ============================================================================
+// element-wise operations with arrays
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator+= ( const Ostap::Math::VEArray& right )
+{
+  if ( &right == this ) { return (*this) *= 2.0 ; }
+  _check ( *this , right , "operator+=" ) ;
+  const std::size_t n  = size () ;
+  double*       v  = m_values.data () ;
+  double*       c  = m_cov2s .data () ;
+  const double* rv = right.m_values.data () ;
+  const double* rc = right.m_cov2s .data () ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    v [ i ] += rv [ i ] ;
+    c [ i ] += _pos ( rc [ i ] ) ;
+  }
+  return *this ;
+}
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator-= ( const Ostap::Math::VEArray& right )
+{
+  if ( &right == this )
+  {
+    std::fill ( m_values.begin () , m_values.end () , 0.0 ) ;
+    std::fill ( m_cov2s .begin () , m_cov2s .end () , 0.0 ) ;
+    return *this ;
+  }
+  _check ( *this , right , "operator-=" ) ;
+  const std::size_t n  = size () ;
+  double*       v  = m_values.data () ;
+  double*       c  = m_cov2s .data () ;
+  const double* rv = right.m_values.data () ;
+  const double* rc = right.m_cov2s .data () ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    v [ i ] -= rv [ i ] ;
+    c [ i ] += _pos ( rc [ i ] ) ;
+  }
+  return *this ;
+}
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator*= ( const Ostap::Math::VEArray& right )
+{
+  const std::size_t n  = size () ;
+  double*       v  = m_values.data () ;
+  double*       c  = m_cov2s .data () ;
+  if ( &right == this )
+  {
+    for ( std::size_t i = 0 ; i < n ; ++i )
+    {
+      const double a2 = v [ i ] * v [ i ] ;
+      v [ i ]  = a2 ;
+      c [ i ] *= 4 * a2 ;
+    }
+    return *this ;
+  }
+  _check ( *this , right , "operator*=" ) ;
+  const double* rv = right.m_values.data () ;
+  const double* rc = right.m_cov2s .data () ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double a = v  [ i ] ;
+    const double b = rv [ i ] ;
+    c [ i ] = c [ i ] * b * b + _pos ( rc [ i ] ) * a * a ;
+    v [ i ] = a * b ;
+  }
+  return *this ;
+}
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator/= ( const Ostap::Math::VEArray& right )
+{
+  if ( &right == this )
+  {
+    std::fill ( m_values.begin () , m_values.end () , 1.0 ) ;
+    std::fill ( m_cov2s .begin () , m_cov2s .end () , 0.0 ) ;
+    return *this ;
+  }
+  _check ( *this , right , "operator/=" ) ;
+  const std::size_t n  = size () ;
+  double*       v  = m_values.data () ;
+  double*       c  = m_cov2s .data () ;
+  const double* rv = right.m_values.data () ;
+  const double* rc = right.m_cov2s .data () ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double r  = v [ i ] / rv [ i ] ;
+    const double b2 = rv [ i ] * rv [ i ] ;
+    c [ i ] = ( c [ i ] + _pos ( rc [ i ] ) * r * r ) / b2 ;
+    v [ i ] = r ;
+  }
+  return *this ;
+}
+// ============================================================================
+// element-wise operations with the value
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator+= ( const Ostap::Math::ValueWithError& right )
+{
+  const double rv = right.value ()        ;
+  const double rc = _pos ( right.cov2 () ) ;
+  const std::size_t n  = size () ;
+  double*       v  = m_values.data () ;
+  double*       c  = m_cov2s .data () ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) { v [ i ] += rv ; c [ i ] += rc ; }
+  return *this ;
+}
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator-= ( const Ostap::Math::ValueWithError& right )
+{
+  const double rv = right.value ()        ;
+  const double rc = _pos ( right.cov2 () ) ;
+  const std::size_t n  = size () ;
+  double*       v  = m_values.data () ;
+  double*       c  = m_cov2s .data () ;
+  for ( std::size_t i = 0 ; i < n ; ++i ) { v [ i ] -= rv ; c [ i ] += rc ; }
+  return *this ;
+}
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator*= ( const Ostap::Math::ValueWithError& right )
+{
+  const double b  = right.value ()        ;
+  const double b2 = b * b                 ;
+  const double rc = _pos ( right.cov2 () ) ;
+  const std::size_t n  = size () ;
+  double*       v  = m_values.data () ;
+  double*       c  = m_cov2s .data () ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double a = v [ i ] ;
+    c [ i ] = c [ i ] * b2 + rc * a * a ;
+    v [ i ] = a * b ;
+  }
+  return *this ;
+}
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator/= ( const Ostap::Math::ValueWithError& right )
+{
+  const double b  = right.value ()        ;
+  const double b2 = b * b                 ;
+  const double rc = _pos ( right.cov2 () ) ;
+  const std::size_t n  = size () ;
+  double*       v  = m_values.data () ;
+  double*       c  = m_cov2s .data () ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double r = v [ i ] / b ;
+    c [ i ] = ( c [ i ] + rc * r * r ) / b2 ;
+    v [ i ] = r ;
+  }
+  return *this ;
+}
+// ============================================================================
+// element-wise operations with the constant
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator+= ( const double right )
+{
+  for ( double& v : m_values ) { v += right ; }
+  return *this ;
+}
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator-= ( const double right )
+{
+  for ( double& v : m_values ) { v -= right ; }
+  return *this ;
+}
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator*= ( const double right )
+{
+  const double r2 = right * right ;
+  for ( double& v : m_values ) { v *= right ; }
+  for ( double& c : m_cov2s  ) { c *= r2    ; }
+  return *this ;
+}
+// ============================================================================
+Ostap::Math::VEArray&
+Ostap::Math::VEArray::operator/= ( const double right )
+{
+  const double r2 = right * right ;
+  for ( double& v : m_values ) { v /= right ; }
+  for ( double& c : m_cov2s  ) { c /= r2    ; }
+  return *this ;
+}
+// ============================================================================
+// unary minus
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::VEArray::operator- () const
+{
+  VEArray result ( *this ) ;
+  for ( double& v : result.m_values ) { v = -v ; }
+  return result ;
+}
+// ============================================================================
+// helper functions for python
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__add__ ( const Ostap::Math::VEArray&        right ) const
+{ VEArray r ( *this ) ; r += right ; return r ; }
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__add__ ( const Ostap::Math::ValueWithError& right ) const
+{ VEArray r ( *this ) ; r += right ; return r ; }
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__add__ ( const double                       right ) const
+{ VEArray r ( *this ) ; r += right ; return r ; }
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__sub__ ( const Ostap::Math::VEArray&        right ) const
+{ VEArray r ( *this ) ; r -= right ; return r ; }
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__sub__ ( const Ostap::Math::ValueWithError& right ) const
+{ VEArray r ( *this ) ; r -= right ; return r ; }
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__sub__ ( const double                       right ) const
+{ VEArray r ( *this ) ; r -= right ; return r ; }
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__mul__ ( const Ostap::Math::VEArray&        right ) const
+{ VEArray r ( *this ) ; r *= right ; return r ; }
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__mul__ ( const Ostap::Math::ValueWithError& right ) const
+{ VEArray r ( *this ) ; r *= right ; return r ; }
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__mul__ ( const double                       right ) const
+{ VEArray r ( *this ) ; r *= right ; return r ; }
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__truediv__ ( const Ostap::Math::VEArray&        right ) const
+{ VEArray r ( *this ) ; r /= right ; return r ; }
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__truediv__ ( const Ostap::Math::ValueWithError& right ) const
+{ VEArray r ( *this ) ; r /= right ; return r ; }
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__truediv__ ( const double                       right ) const
+{ VEArray r ( *this ) ; r /= right ; return r ; }
+// ============================================================================
+// right - this
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__rsub__ ( const Ostap::Math::ValueWithError& right ) const
+{
+  VEArray r ( -(*this) ) ;
+  r += right ;
+  return r ;
+}
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__rsub__ ( const double right ) const
+{
+  VEArray r ( -(*this) ) ;
+  r += right ;
+  return r ;
+}
+// ============================================================================
+// right / this
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__rtruediv__ ( const Ostap::Math::ValueWithError& right ) const
+{
+  const double a  = right.value ()        ;
+  const double a2 = a * a                 ;
+  const double ac = _pos ( right.cov2 () ) ;
+  const std::size_t n = size () ;
+  VEArray r ( n ) ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double b  = m_values [ i ] ;
+    const double b2 = b * b ;
+    r.m_values [ i ] = a / b ;
+    r.m_cov2s  [ i ] = ( ac + _pos ( m_cov2s [ i ] ) * a2 / b2 ) / b2 ;
+  }
+  return r ;
+}
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::VEArray::__rtruediv__ ( const double right ) const
+{ return __rtruediv__ ( ValueWithError ( right , 0.0 ) ) ; }
+// ============================================================================
+// element-wise exponent
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::exp ( const Ostap::Math::VEArray& a )
+{
+  const std::size_t n = a.size () ;
+  VEArray r ( n ) ;
+  const double* av = a.values_data () ;
+  const double* ac = a.cov2s_data  () ;
+  double*       rv = r.values_data () ;
+  double*       rc = r.cov2s_data  () ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double v = std::exp ( av [ i ] ) ;
+    rv [ i ] = v ;
+    rc [ i ] = v * v * _pos ( ac [ i ] ) ;
+  }
+  return r ;
+}
+// ============================================================================
+// element-wise natural logarithm
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::log ( const Ostap::Math::VEArray& a )
+{
+  const std::size_t n = a.size () ;
+  VEArray r ( n ) ;
+  const double* av = a.values_data () ;
+  const double* ac = a.cov2s_data  () ;
+  double*       rv = r.values_data () ;
+  double*       rc = r.cov2s_data  () ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double c = _pos ( ac [ i ] ) ;
+    rv [ i ] = std::log ( av [ i ] ) ;
+    rc [ i ] = 0 < c ? c / ( av [ i ] * av [ i ] ) : 0.0 ;
+  }
+  return r ;
+}
+// ============================================================================
+// element-wise power
+// ============================================================================
+Ostap::Math::VEArray
+Ostap::Math::pow ( const Ostap::Math::VEArray& a , const double b )
+{
+  if      ( 0 == b ) { return VEArray ( a.size () , 1.0 , 0.0 ) ; }
+  else if ( 1 == b ) { return a ; }
+  //
+  const std::size_t n = a.size () ;
+  VEArray r ( n ) ;
+  const double* av = a.values_data () ;
+  const double* ac = a.cov2s_data  () ;
+  double*       rv = r.values_data () ;
+  double*       rc = r.cov2s_data  () ;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    const double c  = _pos ( ac [ i ] ) ;
+    rv [ i ] = std::pow ( av [ i ] , b ) ;
+    if ( 0 < c )
+    {
+      const double e1 = b * std::pow ( av [ i ] , b - 1 ) ;
+      rc [ i ] = e1 * e1 * c ;
+    }
+  }
+  return r ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
@@ -193,7 +193,7 @@ double Ostap::Math::Vector3DWithError::chi2
   Ostap::Math::geo2LA ( vector3d() , vct ) ;
   vct -= right.value() ;
   //
-  return ROOT::Math::Similarity ( vct , s_cov2 ) ;
+  return Ostap::Math::similarity ( s_cov2 , vct ) ;
 }
 
 // ============================================================================
@@ -212,7 +212,7 @@ double Ostap::Math::Vector3DWithError::chi2
   Ostap::Math::geo2LA ( vector3d() , vct ) ;
   vct -= right ;
   //
-  return ROOT::Math::Similarity ( vct , s_cov2 ) ;
+  return Ostap::Math::similarity ( s_cov2 , vct ) ;
 }
 
 // ============================================================================
@@ -5,6 +5,7 @@
 // =============================================================================
 #include <cmath>
 #include <array>
+#include <algorithm>
 // =============================================================================
 // Ostap
 // ============================================================================
@@ -56,6 +57,33 @@ double Ostap::Math::Voigt::operator() ( const double x ) const
     ( std::complex<double> ( x - m_m0 , m_gamma ) * s1 ).real() * s2 ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::Voigt::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  //
+  const double s1 = 1 / ( m_sigma * s_SQRT2   ) ;
+  const double s2 = 1 / ( m_sigma * s_SQRT2PI ) ;
+  const double y  = m_gamma * s1 ;
+  //
+  // process the points in chunks 
+  static const std::size_t CHUNK = 256 ;
+  std::array<std::complex<double>,CHUNK> z ;
+  std::array<std::complex<double>,CHUNK> w ;
+  for ( std::size_t i0 = 0 ; i0 < n ; i0 += CHUNK ) 
+  {
+    const std::size_t m = std::min ( CHUNK , n - i0 ) ;
+    for ( std::size_t i = 0 ; i < m ; ++i ) 
+    { z [ i ] = std::complex<double> ( ( x [ i0 + i ] - m_m0 ) * s1 , y ) ; }
+    Ostap::Math::faddeeva_w ( m , z.data () , w.data () ) ;
+    for ( std::size_t i = 0 ; i < m ; ++i ) 
+    { result [ i0 + i ] = w [ i ].real () * s2 ; }
+  }
+}
+// ============================================================================
 // get the integral between low and high limits
 // ============================================================================
 double  Ostap::Math::Voigt::integral
@@ -352,6 +380,42 @@ double Ostap::Math::PseudoVoigt::operator() ( const double x ) const
       f_sech2      ( dx , m_w[3] ) * m_eta[3]   ) / gamma_sum ;
 }
 // ============================================================================
+// evaluate the function for the array of points 
+// ============================================================================
+void Ostap::Math::PseudoVoigt::evaluate
+( const std::size_t n      , 
+  const double*     x      , 
+  double*           result ) const 
+{
+  //
+  const double gsum = fwhm_gauss() + fwhm_lorentzian() ;
+  const double igs  = 1 / gsum ;
+  //
+  // coefficients for four components 
+  const double cG  = m_eta [ 0 ] * igs / ( m_w [ 0 ] * s_SQRTPI ) ;
+  const double cL  = m_eta [ 1 ] * igs * m_w [ 1 ] / M_PI ;
+  const double cI  = m_eta [ 2 ] * igs / ( 2 * m_w [ 2 ] ) ;
+  const double cP  = m_eta [ 3 ] * igs / ( 2 * m_w [ 3 ] ) ;
+  //
+  const double iG  = 1 / m_w [ 0 ] ;
+  const double wL2 = m_w [ 1 ] * m_w [ 1 ] ;
+  const double iI  = 1 / m_w [ 2 ] ;
+  const double iP  = 1 / m_w [ 3 ] ;
+  //
+  for ( std::size_t i = 0 ; i < n ; ++i ) 
+  {
+    const double dx  = ( x [ i ] - m_m0 ) * igs ;
+    const double dx2 = dx * dx ;
+    const double tI  = dx * iI ;
+    const double s   = Ostap::Math::sech ( dx * iP ) ;
+    result [ i ] = 
+      cG * std::exp ( - dx2 * iG * iG )     + 
+      cL / ( dx2 + wL2 )                    + 
+      cI * std::pow ( 1.0 + tI * tI , -1.5 ) + 
+      cP * s * s ;
+  }
+}
+// ============================================================================
 // get the Gaussian component 
 // ============================================================================
 double Ostap::Math::PseudoVoigt::gaussian   ( const double x ) const 
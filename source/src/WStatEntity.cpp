@@ -3,6 +3,7 @@
 // ============================================================================
 // STD & STL 
 // ============================================================================
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 // ============================================================================
@@ -27,6 +28,11 @@ namespace
   // ==========================================================================
   const Ostap::Math::Zero    <double> s_zero  {} ;
   // ==========================================================================
+  /// the block size for the bulk updates 
+  const std::size_t s_BLOCK = 1024 ;
+  /// number of independent lanes 
+  const std::size_t s_LANES =    8 ;
+  // ==========================================================================
 }
 // ============================================================================
 // constructor from StatEntity of values 
@@ -38,6 +44,19 @@ Ostap::WStatEntity::WStatEntity ( const Ostap::StatEntity& values )
   , m_weights ( values.n () , 1 , 0 , 1 , 1 )  // weights are trivial 
 {}
 // ============================================================================
+// full constructor 
+// ============================================================================
+Ostap::WStatEntity::WStatEntity 
+( const double             mu      , 
+  const double             mu2     , 
+  const Ostap::StatEntity& values  , 
+  const Ostap::StatEntity& weights ) 
+  : m_mu      ( mu      ) 
+  , m_mu2     ( mu2     ) 
+  , m_values  ( values  ) 
+  , m_weights ( weights ) 
+{}
+// ============================================================================
 // update statistics 
 // ============================================================================
 Ostap::WStatEntity&
@@ -178,6 +197,118 @@ Ostap::WStatEntity::add ( const Ostap::WStatEntity& other )
   return *this ;
 }
 // ============================================================================
+/*  add the arrays of values and weights 
+ *  The arrays are processed in blocks, the block statistics are 
+ *  accumulated in several independent lanes and the block is 
+ *  folded into the counter once.
+ *  @param begin   (INPUT) begin of the sequence of values 
+ *  @param end     (INPUT) end   of the sequence of values 
+ *  @param weights (INPUT) the weights (null for unit weights)
+ *  @return self-reference 
+ */
+// ============================================================================
+Ostap::WStatEntity& 
+Ostap::WStatEntity::add 
+( const double* begin   , 
+  const double* end     , 
+  const double* weights ) 
+{
+  if ( !begin || end <= begin ) { return *this ; }               // RETURN 
+  //
+  // trivial weights 
+  if ( !weights ) 
+  {
+    Ostap::StatEntity values ;
+    values.add ( begin , end ) ;
+    return add ( WStatEntity ( values ) ) ;                     // RETURN 
+  }
+  //
+  double buffer [ s_BLOCK ] ;
+  //
+  const double* wfirst = weights ;
+  for ( const double* first = begin ; first < end ; first += s_BLOCK , wfirst += s_BLOCK ) 
+  {
+    const std::size_t nb = std::min ( s_BLOCK , std::size_t ( end - first ) ) ;
+    const std::size_t nl = nb - nb % s_LANES ;
+    //
+    // (1) the first pass: sum of weights, weighted sum and non-zero weights 
+    double      sw  [ s_LANES ] = {} ;
+    double      swx [ s_LANES ] = {} ;
+    std::size_t nz = 0 ;
+    for ( std::size_t i = 0 ; i < nl ; i += s_LANES ) 
+    {
+      for ( std::size_t k = 0 ; k < s_LANES ; ++k ) 
+      {
+        const double w = wfirst [ i + k ] ;
+        sw  [ k ] += w ;
+        swx [ k ] += w * first [ i + k ] ;
+        nz        += ( 0 != w ) ;
+      }
+    }
+    for ( std::size_t i = nl ; i < nb ; ++i ) 
+    {
+      const double w = wfirst [ i ] ;
+      sw  [ 0 ] += w ;
+      swx [ 0 ] += w * first [ i ] ;
+      nz        += ( 0 != w ) ;
+    }
+    long double W  = 0 ;
+    long double WX = 0 ;
+    for ( std::size_t k = 0 ; k < s_LANES ; ++k ) { W += sw [ k ] ; WX += swx [ k ] ; }
+    //
+    // degenerate block: use the regular updates 
+    if ( !W || !std::isfinite ( double ( W ) ) ) 
+    {
+      for ( std::size_t i = 0 ; i < nb ; ++i ) { add ( first [ i ] , wfirst [ i ] ) ; }
+      continue ;
+    }
+    //
+    const double mu = WX / W ;
+    //
+    // (2) the second pass: the corrected weighted sum of squared deviations 
+    double d1 [ s_LANES ] = {} ;
+    double d2 [ s_LANES ] = {} ;
+    for ( std::size_t i = 0 ; i < nl ; i += s_LANES ) 
+    {
+      for ( std::size_t k = 0 ; k < s_LANES ; ++k ) 
+      {
+        const double w = wfirst [ i + k ] ;
+        const double d = first  [ i + k ] - mu ;
+        d1 [ k ] += w * d     ;
+        d2 [ k ] += w * d * d ;
+      }
+    }
+    for ( std::size_t i = nl ; i < nb ; ++i ) 
+    {
+      const double w = wfirst [ i ] ;
+      const double d = first  [ i ] - mu ;
+      d1 [ 0 ] += w * d     ;
+      d2 [ 0 ] += w * d * d ;
+    }
+    long double c1 = 0 ;
+    long double c2 = 0 ;
+    for ( std::size_t k = 0 ; k < s_LANES ; ++k ) { c1 += d1 [ k ] ; c2 += d2 [ k ] ; }
+    //
+    // (3) statistics of values (with non-zero weights) and weights 
+    Ostap::StatEntity values  ;
+    if ( nz == nb ) { values.add ( first , first + nb ) ; }
+    else 
+    {
+      std::size_t j = 0 ;
+      for ( std::size_t i = 0 ; i < nb ; ++i ) 
+      { if ( wfirst [ i ] ) { buffer [ j++ ] = first [ i ] ; } }
+      values.add ( buffer , buffer + j ) ;
+    }
+    Ostap::StatEntity wstat ;
+    wstat.add ( wfirst , wfirst + nb ) ;
+    //
+    // (4) fold the block into the counter 
+    add ( WStatEntity ( mu + c1 / W , ( c2 - c1 * c1 / W ) / W , values , wstat ) ) ;
+  }
+  //
+  return *this ;
+}
+// ============================================================================
 // comparison
 // ============================================================================
 bool Ostap::WStatEntity::operator< ( const Ostap::WStatEntity& right ) const
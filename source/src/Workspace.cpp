@@ -4,6 +4,8 @@
 // STD  & STL
 // ============================================================================
 #include <utility>
+#include <vector>
+#include <iterator>
 // ============================================================================
 // GSL
 // ============================================================================
@@ -21,94 +23,133 @@
  *  Implementation file for class Ostap::Math::Workspace
  */
 // ============================================================================
-// constructor
-// ============================================================================
-Ostap::Math::WorkSpace::WorkSpace ( const std::size_t size ) 
-  : m_workspace ( nullptr )
-  , m_size      ( size )
-{}
+namespace 
+{
+  // ==========================================================================
+  /** @var s_POOLSIZE 
+   *  maximal number of free workspaces, kept in the pool (per thread)
+   */
+  const std::size_t s_POOLSIZE = 16 ;
+  // ==========================================================================
+  /** @class Pool 
+   *  thread-local pool of GSL integration workspaces 
+   */
+  class Pool 
+  {
+  public:
+    // ========================================================================
+    Pool () : m_free () {}
+    ~Pool () 
+    {
+      for ( gsl_integration_workspace* w : m_free ) 
+      { gsl_integration_workspace_free ( w ) ; }
+      m_free.clear() ;
+    }
+    // ========================================================================
+  public:
+    // ========================================================================
+    /// get the workspace with the given size from the pool (or allocate new)
+    gsl_integration_workspace* acquire ( const std::size_t size ) 
+    {
+      for ( auto it = m_free.rbegin () ; m_free.rend () != it ; ++it ) 
+      {
+        if ( size == (*it)->limit ) 
+        {
+          gsl_integration_workspace* w = *it ;
+          m_free.erase ( std::next ( it ).base () ) ;
+          return w ;
+        }
+      }
+      return gsl_integration_workspace_alloc ( size ) ;
+    }
+    // ========================================================================
+    /// return the workspace back to the pool (or release it)
+    void release ( gsl_integration_workspace* w ) 
+    {
+      if      ( nullptr == w                ) { return ; }
+      else if ( s_POOLSIZE <= m_free.size() ) 
+      {
+        // the oldest entry is released 
+        gsl_integration_workspace_free ( m_free.front () ) ;
+        m_free.erase ( m_free.begin () ) ;
+      }
+      m_free.push_back ( w ) ;
+    }
+    // ========================================================================
+    /// number of free workspaces in the pool 
+    std::size_t size () const { return m_free.size () ; }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// free workspaces 
+    std::vector<gsl_integration_workspace*> m_free ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /// get the thread-local pool 
+  Pool& pool () 
+  {
+    static thread_local Pool s_pool {} ;
+    return s_pool ;
+  }
+  // ==========================================================================
+}
 // ============================================================================
-// (fictive) copy constructor
+// borrow the workspace of the given size from the pool 
 // ============================================================================
-Ostap::Math::WorkSpace::WorkSpace
-( const Ostap::Math::WorkSpace& /* right */ )
-  : m_workspace ( nullptr )
-  , m_size      ( 0       )
+Ostap::Math::WorkSpace::Borrowed::Borrowed ( const std::size_t size ) 
+  : m_workspace ( pool().acquire ( 0 == size ? s_SIZE : size ) )
 {}
 // ============================================================================
 // move constructor
 // ============================================================================
-Ostap::Math::WorkSpace::WorkSpace
-(       Ostap::Math::WorkSpace&& right  )
-  : m_workspace ( nullptr )
-  , m_size      ( 0       )
-{ 
-  // std::swap ( m_workspace , right.m_workspace ) ; 
-  // std::swap ( m_size      , right.m_size      ) ; 
+Ostap::Math::WorkSpace::Borrowed::Borrowed
+( Ostap::Math::WorkSpace::Borrowed&& right ) 
+  : m_workspace ( right.m_workspace )
+{
+  right.m_workspace = nullptr ;
 }
 // ============================================================================
-// destructor
+// destructor: return the workspace back to the pool 
 // ============================================================================
-Ostap::Math::WorkSpace::~WorkSpace ()
+Ostap::Math::WorkSpace::Borrowed::~Borrowed()
 {
-  if ( nullptr != m_workspace )
+  if ( nullptr != m_workspace ) 
   {
     gsl_integration_workspace * _ws = (gsl_integration_workspace*) m_workspace ;
     m_workspace = nullptr ;
-    gsl_integration_workspace_free ( _ws );
+    pool().release ( _ws ) ;
   }
 }
 // ============================================================================
-// get the integration workspace
-// ============================================================================
-void* Ostap::Math::WorkSpace::workspace () const
-{
-  if ( nullptr == m_workspace ) 
-  { m_workspace = (char*) gsl_integration_workspace_alloc ( 0 == m_size ? s_SIZE : m_size ) ; }
-  return m_workspace ;
-}
-// ============================================================================
-// fictive assignement operator
+// constructor
 // ============================================================================
-Ostap::Math::WorkSpace&
-Ostap::Math::WorkSpace::operator=
-  ( const Ostap::Math::WorkSpace& /* right */ ) { return *this ; }
+Ostap::Math::WorkSpace::WorkSpace ( const std::size_t size ) 
+  : m_size      ( size )
+{}
 // ============================================================================
-// move assignement operator
+// borrow the integration workspace from the thread-local pool 
 // ============================================================================
-Ostap::Math::WorkSpace&
-Ostap::Math::WorkSpace::operator=
-(       Ostap::Math::WorkSpace&& /* right */ ) { return *this ; }
+Ostap::Math::WorkSpace::Borrowed
+Ostap::Math::WorkSpace::borrow () const 
+{ return Borrowed ( m_size ) ; }
 // ============================================================================
 // swap
 // ============================================================================
 void Ostap::Math::WorkSpace::swap ( Ostap::Math::WorkSpace& right ) 
-{ 
-  std::swap  ( m_workspace ,  right.m_workspace ) ;
-  std::swap  ( m_size      ,  right.m_size      ) ;
-}
+{ std::swap  ( m_size      ,  right.m_size      ) ; }
 // ============================================================================
 // resize the workspace 
 // ============================================================================
 std::size_t Ostap::Math::WorkSpace::resize ( const std::size_t newsize ) 
 {
-  if      ( m_size  == newsize     ) { return m_size ; }
-  else if ( nullptr != m_workspace ) 
-  {
-    //
-    // free existing workspace:
-    //
-    gsl_integration_workspace * _ws = (gsl_integration_workspace*) m_workspace ;
-    m_workspace = nullptr ;
-    gsl_integration_workspace_free ( _ws );
-  }
-  //
   m_size = newsize ;
   return m_size ;
 }
 // ============================================================================
-
-
+// number of workspaces, kept in the pool of the current thread
+// ============================================================================
+std::size_t Ostap::Math::WorkSpace::pool_size () { return pool().size() ; }
 // ============================================================================
 //  The END 
 // ============================================================================
@@ -6,9 +6,12 @@
 #include <iterator>
 #include <algorithm>
 #include <array>
+#include <vector>
 // ============================================================================
 // local
 // ============================================================================
+#include "Ostap/Arena.h"
+// ============================================================================
 #include "choose_utils.h"
 // ============================================================================
 namespace Ostap
@@ -63,6 +66,17 @@ namespace Ostap
         const unsigned int  m = M - 1 ;
         const unsigned int  n = N - 1 ;
         //
+        // pre-scale the coefficients with binomials: 
+        // the product becomes the plain convolution 
+        // c_k = 1/C(m+n,k) * sum_j [ C(m,j) a_j ] * [ C(n,k-j) b_{k-j} ] 
+        //
+        std::vector<long double> as ( M ) ;
+        std::vector<long double> bs ( N ) ;
+        for ( unsigned int j = 0 ; j < M ; ++j ) 
+        { as [ j ] = Ostap::Math::Utils::choose_long_double ( m , j ) * ( *( a_begin + j ) ) ; }
+        for ( unsigned int j = 0 ; j < N ; ++j ) 
+        { bs [ j ] = Ostap::Math::Utils::choose_long_double ( n , j ) * ( *( b_begin + j ) ) ; }
+        //
         const unsigned long K = m + n ;
         for ( unsigned long k = 0 ; k <= K ; ++k , ++output ) 
         {
@@ -72,19 +86,12 @@ namespace Ostap
           long double ck = 0 ;
           for ( unsigned int j = jmin ; j <= jmax ; ++j ) 
           {
-            const long double a  = * ( a_begin +       j   ) ;
-            const long double b  = * ( b_begin + ( k - j ) ) ;
-            const long double ab = a * b ;
-            if ( 0 != a  && 0 != b && 0 != ab && !s_zero ( ab ) ) 
-            {
-              ck += ab * 
-                Ostap::Math::Utils::choose_long_double ( m     ,     j ) * 
-                Ostap::Math::Utils::choose_long_double ( n     , k - j ) *
-                Ostap::Math::Utils::ichoose            ( m + n , k     ) ;
-            }
+            const long double a  = as [     j ] ;
+            const long double b  = bs [ k - j ] ;
+            if ( 0 != a && 0 != b ) { ck += a * b ; }
           }
           //
-          *output = ck ;
+          *output = 0 != ck ? ck * Ostap::Math::Utils::ichoose ( m + n , k ) : ck ;
         }
         return output ;
       } // 
@@ -216,7 +223,78 @@ namespace Ostap
         return casteljau ( first , second , t0 , t1 ) ;
       }
       // ======================================================================
-
+      /** evaluate all basic Bernstein polynomials of degree N at the point 
+       *  \f$ b_{i,N}(t) = C^i_N t^i (1-t)^{N-i}, 0\le i \le N \f$
+       *  using the triangular (de Casteljau-like) recurrence
+       *  \f$ b_{i,k}(t) = (1-t) b_{i,k-1}(t) + t b_{i-1,k-1}(t) \f$
+       *  @param N      (INPUT)  degree of polynomials 
+       *  @param t0     (INPUT)  the point \f$ t \f$ 
+       *  @param t1     (INPUT)  \f$ 1 - t \f$ 
+       *  @param result (UPDATE) at least N+1 elements 
+       */
+      template <class ITERATOR>
+      inline void bernstein_basis 
+      ( const unsigned short N      , 
+        const long double    t0     , 
+        const long double    t1     , 
+        ITERATOR             result ) 
+      {
+        result [ 0 ] = 1 ;
+        for ( unsigned short k = 1 ; k <= N ; ++k ) 
+        {
+          result [ k ] = t0 * result [ k - 1 ] ;
+          for ( unsigned short j = k - 1 ; 0 < j ; --j ) 
+          { result [ j ] = t1 * result [ j ] + t0 * result [ j - 1 ] ; }
+          result [ 0 ] *= t1 ;
+        }
+      }
+      // ======================================================================
+      /** @class Buffer 
+       *  Simple scratch buffer for the basic polynomials: 
+       *  it is allocated on stack for the small sizes, 
+       *  and in the per-thread arena for the (very) large sizes 
+       *  @see Ostap::Utils::Arena 
+       */
+      class Buffer 
+      {
+      public:
+        // ====================================================================
+        enum { SIZE = 64 } ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        explicit Buffer ( const std::size_t n ) 
+          : m_stack () 
+          , m_arena ( SIZE < n ? &Ostap::Utils::Arena::local () : nullptr ) 
+          , m_mark  ( m_arena  ? m_arena->mark () : Ostap::Utils::Arena::Mark () ) 
+          , m_data  ( m_arena  ? m_arena->allocate_n<double> ( n ) : m_stack.data () ) 
+        {}
+        /// constructor with the initial value 
+        Buffer ( const std::size_t n , const double value ) 
+          : Buffer ( n ) 
+        { std::fill ( m_data , m_data + n , value ) ; }
+        /// rewind the arena 
+        ~Buffer () { if ( m_arena ) { m_arena->rewind ( m_mark ) ; } }
+        /// no copy 
+        Buffer ( const Buffer& ) = delete ;
+        /// no assignement 
+        Buffer& operator= ( const Buffer& ) = delete ;
+        // ====================================================================
+      public:
+        // ====================================================================
+        inline double*       data ()       { return m_data ; }
+        inline const double* data () const { return m_data ; }
+        inline double&       operator[] ( const std::size_t i )       { return m_data [ i ] ; }
+        inline double        operator[] ( const std::size_t i ) const { return m_data [ i ] ; }
+        // ====================================================================
+      private:
+        // ====================================================================
+        std::array<double,SIZE>     m_stack ;
+        Ostap::Utils::Arena*        m_arena ;
+        Ostap::Utils::Arena::Mark   m_mark  ;
+        double*                     m_data  ;
+        // ====================================================================
+      } ;
       // ======================================================================
     } //                                The end of namespace Ostap::Math::Utils 
     // ========================================================================
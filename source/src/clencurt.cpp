@@ -0,0 +1,134 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <mutex>
+// ============================================================================
+// Local
+// ============================================================================
+#include "clencurt.h"
+#include "local_fft.h"
+// ============================================================================
+/** @file
+ *  Nested Clenshaw-Curtis points and weights for p-adaptive cubature.
+ *  Instead of the huge precomputed table, the points and weights are
+ *  calculated (in long double precision) at the first request of the
+ *  given level, and only requested levels are materialized.
+ *  @see pcubature.cpp
+ *  @date 2023-01-30
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  typedef long double            LD     ;
+  typedef std::complex<LD>       CLD    ;
+  // ==========================================================================
+  const unsigned int s_M  = clencurt_M  ;
+  const LD           s_pi = 3.141592653589793238462643383279502884L ;
+  // ==========================================================================
+  /// storage for the points, length is 2^M, allocated, but not touched
+  double* _x_ ()
+  {
+    static double* s_x = new double [ 1u << s_M ] ;
+    return s_x ;
+  }
+  // ==========================================================================
+  /// storage for the weights, length is M+2^(M+1), allocated, but not touched
+  double* _w_ ()
+  {
+    static double* s_w = new double [ s_M + ( 1u << ( s_M + 1 ) ) ] ;
+    return s_w ;
+  }
+  // ==========================================================================
+  std::once_flag s_x_flags [ clencurt_M + 1 ] ;
+  std::once_flag s_w_flags [ clencurt_M + 1 ] ;
+  // ==========================================================================
+  /** points of the level m:
+   *  - \f$ x_0 = 1 \f$ for \f$ m = 0 \f$
+   *  - \f$ x_{2^{m-1}+j} = \cos \frac{(2j+1)\pi}{2^{m+1}} \f$ for \f$ m>0 \f$
+   */
+  void _make_x_ ( const unsigned int m )
+  {
+    double* x = _x_ () ;
+    if ( 0 == m ) { x [ 0 ] = 1 ; return ; }
+    const unsigned int n     = 1u << ( m - 1 ) ;
+    const LD           scale = s_pi / ( 1u << ( m + 1 ) ) ;
+    for ( unsigned int j = 0 ; j < n ; ++j )
+    { x [ n + j ] = static_cast<double> ( std::cos ( ( 2 * j + 1 ) * scale ) ) ; }
+  }
+  // ==========================================================================
+  /** weights of the rule m with \f$ n = 2^{m+1} \f$ intervals:
+   *  \f$ w_j = \frac{c_j}{n} \left( 1 - \sum_{k=1}^{n/2}
+   *      \frac{b_k}{4k^2-1} \cos \frac{2\pi kj}{n} \right) \f$,
+   *  the sum is calculated for all j at once as DCT-I via FFT.
+   *  The layout: the central weight, followed by the weights
+   *  for the points in the order of clencurt_x
+   */
+  void _make_w_ ( const unsigned int m )
+  {
+    const std::size_t N = 1u << m ;  // n/2
+    const std::size_t n = 2 * N   ;
+    //
+    // DCT-I: S_j = sum_{k=1}^{N} a_k cos(pi k j/N) for j = 0..N
+    std::vector<CLD> y ( n , CLD ( 0 ) ) ;
+    for ( std::size_t k = 1 ; k <= N ; ++k )
+    {
+      const LD ak = ( k == N ? 1 : 2 ) / ( 4.0L * k * k - 1 ) ;
+      y [ k ] = ak ;
+      if ( k < N ) { y [ n - k ] = ak ; }
+    }
+    const LD aN = 1 / ( 4.0L * N * N - 1 ) ;
+    Ostap::Math::FFT::radix2 ( y ) ;
+    //
+    std::vector<LD> wj ( N + 1 ) ;
+    for ( std::size_t j = 0 ; j <= N ; ++j )
+    {
+      const LD Sj = 0.5L * ( y [ j ].real () + ( j % 2 ? -aN : aN ) ) ;
+      const LD cj = 0 == j ? 1 : 2 ;
+      wj [ j ] = cj * ( 1 - Sj ) / n ;
+    }
+    //
+    double* w = _w_ () + m + ( 1u << m ) - 1 ;
+    w [ 0 ] = static_cast<double> ( wj [ N ] ) ;   // the central point
+    // the edges: exact value, the sum above suffers from the cancellation 
+    w [ 1 ] = static_cast<double> ( 1 / ( LD ( n ) * n - 1 ) ) ;
+    // the points of level l correspond to j = (2i+1)*2^(m-l)
+    for ( unsigned int l = 1 ; l <= m ; ++l )
+    {
+      const std::size_t nl    = 1u << ( l - 1 ) ;
+      const std::size_t shift = 1u << ( m - l ) ;
+      for ( std::size_t i = 0 ; i < nl ; ++i )
+      { w [ 1 + nl + i ] = static_cast<double> ( wj [ ( 2 * i + 1 ) * shift ] ) ; }
+    }
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// points for all levels, only levels up to the initialized one are valid
+// ============================================================================
+const double* clencurt_xs () { return _x_ () ; }
+// ============================================================================
+// weights for all rules, only rules up to the initialized one are valid
+// ============================================================================
+const double* clencurt_ws () { return _w_ () ; }
+// ============================================================================
+// make the points and weights up to level m available (thread-safe)
+// ============================================================================
+int clencurt_init ( const unsigned int m )
+{
+  if ( s_M < m ) { return 1 ; }
+  for ( unsigned int l = 0 ; l <= m ; ++l )
+  {
+    std::call_once ( s_x_flags [ l ] , _make_x_ , l ) ;
+    std::call_once ( s_w_flags [ l ] , _make_w_ , l ) ;
+  }
+  return 0 ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
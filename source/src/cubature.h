@@ -93,6 +93,16 @@ int hcubature_v(unsigned fdim, integrand_v f, void *fdata,
 		error_norm norm,
 		double *val, double *err);
 
+/* Ostap: as hcubature_v, but the regions, selected for the subdivision
+   at each iteration, are evaluated in parallel by nthreads threads.
+   The result does not depend on the number of threads.
+   The integrand must be thread-safe. */
+int hcubature_v_mt(unsigned fdim, integrand_v f, void *fdata,
+		   unsigned dim, const double *xmin, const double *xmax, 
+		   size_t maxEval, double reqAbsError, double reqRelError, 
+		   error_norm norm,
+		   double *val, double *err, unsigned nthreads);
+
 /* adaptive integration by increasing the degree of (tensor-product
    Clenshaw-Curtis) quadrature rules ("p-adaptive"), rather than
    subdividing the domain ("h-adaptive").  Possibly better for
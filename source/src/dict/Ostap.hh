@@ -8,12 +8,19 @@
 // ============================================================================
 #include "Ostap/AddBranch.h"
 #include "Ostap/AddVars.h"
+#include "Ostap/Affinity.h"
+#include "Ostap/AmplitudeSum.h"
+#include "Ostap/Arena.h"
 #include "Ostap/BLOB.h"
 #include "Ostap/BSpline.h"
+#include "Ostap/BatchCompute.h"
 #include "Ostap/Bernstein.h"
 #include "Ostap/Bernstein1D.h"
 #include "Ostap/Bernstein2D.h"
 #include "Ostap/Bernstein3D.h"
+#include "Ostap/BinReplicas.h"
+#include "Ostap/BinStat.h"
+#include "Ostap/BinnedNLL.h"
 #include "Ostap/Binomial.h"
 #include "Ostap/BreitWigner.h"
 #include "Ostap/Bit.h"
@@ -23,17 +30,27 @@
 #include "Ostap/Choose.h"
 #include "Ostap/Clenshaw.h"
 #include "Ostap/Combine.h"
+#include "Ostap/CompactData.h"
+#include "Ostap/Covariance.h"
 #include "Ostap/Dalitz.h"
 #include "Ostap/DalitzIntegrator.h"
+#include "Ostap/DataChunks.h"
+#include "Ostap/DataColumns.h"
 #include "Ostap/DataFrameActions.h"
+#include "Ostap/DataFrameFuncs.h"
 #include "Ostap/DataFrameUtils.h"
 #include "Ostap/Digit.h"
+#include "Ostap/EfficiencyFit.h"
 #include "Ostap/EigenSystem.h"
 #include "Ostap/Error2Exception.h"
+#include "Ostap/FFTConvolution.h"
 #include "Ostap/Formula.h"
 #include "Ostap/FormulaVar.h"
 #include "Ostap/Fourier.h"
+#include "Ostap/FrozenBasis.h"
 #include "Ostap/Funcs.h"
+#include "Ostap/FusedVar.h"
+#include "Ostap/GradientNLL.h"
 #include "Ostap/GenericMatrixTypes.h"
 #include "Ostap/GenericVectorTypes.h"
 #include "Ostap/GeomFun.h"
@@ -42,38 +59,53 @@
 #include "Ostap/Hesse.h"
 #include "Ostap/HFuncs.h"
 #include "Ostap/HistoDump.h"
+#include "Ostap/HistoCompare.h"
 #include "Ostap/HistoHash.h"
 #include "Ostap/HistoInterpolation.h"
 #include "Ostap/HistoInterpolators.h"
 #include "Ostap/HistoMake.h"
+#include "Ostap/HistoParam.h"
 #include "Ostap/HistoProject.h"
 #include "Ostap/HistoStat.h"
+#include "Ostap/HistoTables.h"
 #include "Ostap/KramersKronig.h"
+#include "Ostap/IntegrationCache.h"
+#include "Ostap/Instrument.h"
 #include "Ostap/Interpolation.h"
 #include "Ostap/Interpolants.h"
+#include "Ostap/InverseCDF.h"
 #include "Ostap/Iterator.h"
 #include "Ostap/Line.h"
 #include "Ostap/LineTypes.h"
 #include "Ostap/Lomont.h"
 #include "Ostap/LorentzVectorWithError.h"
+#include "Ostap/KDE.h"
+#include "Ostap/KDEPdf.h"
+#include "Ostap/KeyIndex.h"
 #include "Ostap/Kinematics.h"
 #include "Ostap/Math.h"
 #include "Ostap/MatrixUtils.h"
 #include "Ostap/MatrixUtils2.h"
 #include "Ostap/MatrixUtilsT.h"
 #include "Ostap/MatrixTransforms.h"
+#include "Ostap/MemoryBudget.h"
 #include "Ostap/Models.h"
 #include "Ostap/Models2D.h"
 #include "Ostap/Moments.h"
 #include "Ostap/MoreMath.h"
 #include "Ostap/MoreRooFit.h"
 #include "Ostap/MoreVars.h"
+#include "Ostap/Morphing.h"
 #include "Ostap/Mute.h"
+#include "Ostap/NativeFunctions.h"
 #include "Ostap/Notifier.h"
 #include "Ostap/NSphere.h"
 #include "Ostap/NStatEntity.h"
 #include "Ostap/Parameterization.h"
+#include "Ostap/ParallelNLL.h"
 #include "Ostap/Params.h"
+#include "Ostap/PdfCurve.h"
+#include "Ostap/PdfSummary.h"
 #include "Ostap/Peaks.h"
 #include "Ostap/PDFs.h"
 #include "Ostap/PDFs2D.h"
@@ -87,6 +119,8 @@
 #include "Ostap/Power.h"
 #include "Ostap/Primitives.h"
 #include "Ostap/Printable.h"
+#include "Ostap/Progress.h"
+#include "Ostap/ProjectPlan.h"
 #include "Ostap/PyCallable.h"   
 #include "Ostap/PyFuncs.h"   
 #include "Ostap/PyPdf.h"     
@@ -96,13 +130,19 @@
 #include "Ostap/PyVar.h"     
 #include "Ostap/PyBLOB.h"
 #include "Ostap/Polarization.h"
+#include "Ostap/RandomStream.h"
+#include "Ostap/Reweighter.h"
 #include "Ostap/RootID.h"
 #include "Ostap/SFactor.h"
+#include "Ostap/Scattered.h"
+#include "Ostap/Solver1D.h"
 #include "Ostap/StatEntity.h"
 #include "Ostap/StatVar.h"
 #include "Ostap/StatusCode.h"
+#include "Ostap/SWeights.h"
 #include "Ostap/SVectorWithError.h"
 #include "Ostap/SymmetricMatrixTypes.h"
+#include "Ostap/TDigest.h"
 #include "Ostap/Tensors.h"
 #include "Ostap/Tee.h"
 #include "Ostap/ToStream.h"
@@ -110,13 +150,16 @@
 #include "Ostap/TreeGetter.h"
 #include "Ostap/TypeWrapper.h"
 #include "Ostap/Tmva.h"
+#include "Ostap/TmvaForest.h"
 #include "Ostap/Valid.h"
 #include "Ostap/ValueWithError.h"
+#include "Ostap/VEArray.h"
 #include "Ostap/Vector3DTypes.h"
 #include "Ostap/Vector3DWithError.h"
 #include "Ostap/Vector4DTypes.h"
 #include "Ostap/Voigt.h"
 #include "Ostap/UStat.h"
+#include "Ostap/UpdateFiles.h"
 #include "Ostap/WStatEntity.h"
 #include "Ostap/Workspace.h"
 // ============================================================================
@@ -105,6 +105,9 @@
 
 #include "cubature.h"
 
+/* Ostap: the worker threads for the parallel evaluation of the regions */
+#include "local_mt.h"
+
 /* error return codes */
 #define SUCCESS 0
 #define FAILURE 1
@@ -177,6 +180,99 @@ static void destroy_hypercube(hypercube *h)
      h->dim = 0;
 }
 
+/***************************************************************************/
+/* Ostap: pooled allocator for the regions.
+
+   Each region needs 2*dim doubles for the hypercube and fdim esterr
+   for the estimates; these are taken as one fixed-size chunk from
+   the large slabs, and the chunks of the destroyed regions are
+   recycled via the free list, so the cut of the region does not
+   call malloc at all (except the growth of the pool). */
+
+typedef union pool_slab_u {
+     union pool_slab_u *next;
+     double align;
+} pool_slab;
+
+typedef struct {
+     size_t chunk; /* size of one chunk in doubles */
+     size_t nnext; /* number of chunks in the next slab */
+     pool_slab *slabs; /* list of all the slabs */
+     double *free; /* list of free chunks */
+} region_pool;
+
+static region_pool pool_alloc(unsigned dim, unsigned fdim)
+{
+     region_pool p;
+     const size_t bytes = sizeof(double) * dim * 2 + sizeof(esterr) * fdim;
+     p.chunk = (bytes + sizeof(double) - 1) / sizeof(double);
+     if (p.chunk * sizeof(double) < sizeof(double *)) 
+	  p.chunk = (sizeof(double *) + sizeof(double) - 1) / sizeof(double);
+     p.nnext = 64;
+     p.slabs = NULL;
+     p.free = NULL;
+     return p;
+}
+
+static void pool_free(region_pool *p)
+{
+     while (p->slabs) {
+	  pool_slab *next = p->slabs->next;
+	  free(p->slabs);
+	  p->slabs = next;
+     }
+     p->free = NULL;
+}
+
+static double *pool_get(region_pool *p)
+{
+     double *c;
+     if (!p->free) { /* add new slab, twice larger than the previous one */
+	  size_t i;
+	  double *first;
+	  pool_slab *slab = (pool_slab *) malloc(sizeof(pool_slab) 
+						 + sizeof(double) * p->chunk * p->nnext);
+	  if (!slab) return NULL;
+	  slab->next = p->slabs;
+	  p->slabs = slab;
+	  first = (double *) (slab + 1);
+	  for (i = 0; i < p->nnext; ++i) {
+	       c = first + i * p->chunk;
+	       *(double **) c = i + 1 < p->nnext ? c + p->chunk : NULL;
+	  }
+	  p->free = first;
+	  p->nnext *= 2;
+     }
+     c = p->free;
+     p->free = *(double **) c;
+     return c;
+}
+
+static void pool_put(region_pool *p, double *c)
+{
+     if (!c) return;
+     *(double **) c = p->free;
+     p->free = c;
+}
+
+static hypercube pool_hypercube(region_pool *p, unsigned dim, 
+				const double *center, const double *halfwidth)
+{
+     unsigned i;
+     hypercube h;
+     h.dim = dim;
+     h.data = pool_get(p);
+     h.vol = 0;
+     if (h.data) {
+	  for (i = 0; i < dim; ++i) {
+	       h.data[i] = center[i];
+	       h.data[i + dim] = halfwidth[i];
+	  }
+	  h.vol = compute_vol(&h);
+     }
+     return h;
+}
+
 typedef struct {
      hypercube h;
      unsigned splitDim;
@@ -185,36 +281,38 @@ typedef struct {
      double errmax; /* max ee[k].err */
 } region;
 
-static region make_region(const hypercube *h, unsigned fdim)
+/* Ostap: the hypercube and the estimates share one chunk of the pool */
+static region make_region(const hypercube *h, unsigned fdim, region_pool *p)
 {
      region R;
-     R.h = make_hypercube(h->dim, h->data, h->data + h->dim);
+     R.h = pool_hypercube(p, h->dim, h->data, h->data + h->dim);
      R.splitDim = 0;
      R.fdim = fdim;
-     R.ee = R.h.data ? (esterr *) malloc(sizeof(esterr) * fdim) : NULL;
+     R.ee = R.h.data ? (esterr *) (R.h.data + 2 * h->dim) : NULL;
      R.errmax = HUGE_VAL;
      return R;
 }
 
-static void destroy_region(region *R)
+static void destroy_region(region *R, region_pool *p)
 {
-     destroy_hypercube(&R->h);
-     free(R->ee);
+     pool_put(p, R->h.data);
+     R->h.data = 0;
+     R->h.dim = 0;
      R->ee = 0;
 }
 
-static int cut_region(region *R, region *R2)
+static int cut_region(region *R, region *R2, region_pool *p)
 {
      unsigned d = R->splitDim, dim = R->h.dim;
      *R2 = *R;
      R->h.data[d + dim] *= 0.5;
      R->h.vol *= 0.5;
-     R2->h = make_hypercube(dim, R->h.data, R->h.data + dim);
+     R2->h = pool_hypercube(p, dim, R->h.data, R->h.data + dim);
      if (!R2->h.data) return FAILURE;
      R->h.data[d] -= R->h.data[d + dim];
      R2->h.data[d] += R->h.data[d + dim];
-     R2->ee = (esterr *) malloc(sizeof(esterr) * R2->fdim);
-     return R2->ee == NULL;
+     R2->ee = (esterr *) (R2->h.data + 2 * dim);
+     return SUCCESS;
 }
 
 struct rule_s; /* forward declaration */
@@ -293,6 +391,27 @@ static int eval_regions(unsigned nR, region *R,
      return SUCCESS;
 }
 
+/* Ostap: evaluate the regions in parallel, each thread with its own rule.
+   The estimates for the region do not depend on the other regions
+   evaluated in the same batch, therefore the result is bitwise
+   identical to the serial evaluation. The integrand must be thread-safe. */
+static int eval_regions_mt(unsigned nR, region *R, 
+			   integrand_v f, void *fdata, 
+			   rule **rules, Ostap::Utils::WorkerPool *workers)
+{
+     const unsigned nt = workers ? workers->size() : 1;
+     if (nt < 2 || nR < 2 * nt) return eval_regions(nR, R, f, fdata, rules[0]);
+     std::vector<int> status(nt, SUCCESS);
+     workers->run([&](const unsigned int k) {
+	       const unsigned first = (unsigned) (((size_t) nR * k) / nt);
+	       const unsigned last  = (unsigned) (((size_t) nR * (k + 1)) / nt);
+	       status[k] = eval_regions(last - first, R + first, f, fdata, rules[k]);
+	  });
+     for (unsigned k = 0; k < nt; ++k)
+	  if (status[k]) return FAILURE;
+     return SUCCESS;
+}
+
 /***************************************************************************/
 /* Functions to loop over points in a hypercube. */
 
@@ -901,13 +1020,14 @@ static int converged(unsigned fdim, const esterr *ee,
 
 /* adaptive integration, analogous to adaptintegrator.cpp in HIntLib */
 
-static int rulecubature(rule *r, unsigned fdim, 
+static int rulecubature(rule **rules, unsigned fdim, 
 			integrand_v f, void *fdata, 
 			const hypercube *h, 
 			size_t maxEval,
 			double reqAbsError, double reqRelError,
 			error_norm norm,
-			double *val, double *err, int parallel)
+			double *val, double *err, int parallel,
+			Ostap::Utils::WorkerPool *workers)
 {
      size_t numEval = 0;
      heap regions;
@@ -915,6 +1035,8 @@ static int rulecubature(rule *r, unsigned fdim,
      region *R = NULL; /* array of regions to evaluate */
      size_t nR_alloc = 0;
      esterr *ee = NULL;
+     rule *r = rules[0];
+     region_pool pool = pool_alloc(h->dim, fdim);
 
      if (fdim <= 1) norm = ERROR_INDIVIDUAL; /* norm is irrelevant */
      if (norm < 0 || norm > ERROR_LINF) return FAILURE; /* invalid norm */
@@ -928,7 +1050,7 @@ static int rulecubature(rule *r, unsigned fdim,
      nR_alloc = 2;
      R = (region *) malloc(sizeof(region) * nR_alloc);
      if (!R) goto bad;
-     R[0] = make_region(h, fdim);
+     R[0] = make_region(h, fdim, &pool);
      if (!R[0].ee
 	 || eval_regions(1, R, f, fdata, r)
 	 || heap_push(&regions, R[0]))
@@ -977,19 +1099,19 @@ static int rulecubature(rule *r, unsigned fdim,
 		    }
 		    R[nR] = heap_pop(&regions);
 		    for (j = 0; j < fdim; ++j) ee[j].err -= R[nR].ee[j].err;
-		    if (cut_region(R+nR, R+nR+1)) goto bad;
+		    if (cut_region(R+nR, R+nR+1, &pool)) goto bad;
 		    numEval += r->num_points * 2;
 		    nR += 2;
 		    if (converged(fdim, ee, reqAbsError, reqRelError, norm))
 			 break; /* other regions have small errs */
 	       } while (regions.n > 0 && (numEval < maxEval || !maxEval));
-	       if (eval_regions(nR, R, f, fdata, r)
+	       if (eval_regions_mt(nR, R, f, fdata, rules, workers)
 		   || heap_push_many(&regions, nR, R))
 		    goto bad;
 	  }
 	  else { /* minimize number of function evaluations */
 	       R[0] = heap_pop(&regions); /* get worst region */
-	       if (cut_region(R, R+1)
+	       if (cut_region(R, R+1, &pool)
 		   || eval_regions(2, R, f, fdata, r)
 		   || heap_push_many(&regions, 2, R))
 		    goto bad;
@@ -1004,19 +1126,21 @@ static int rulecubature(rule *r, unsigned fdim,
 	       val[j] += regions.items[i].ee[j].val;
 	       err[j] += regions.items[i].ee[j].err;
 	  }
-	  destroy_region(&regions.items[i]);
+	  destroy_region(&regions.items[i], &pool);
      }
 
      /* printf("regions.nalloc = %d\n", regions.nalloc); */
      free(ee);
      heap_free(&regions);
      free(R);
+     pool_free(&pool);
      return SUCCESS;
 
 bad:
      free(ee);
      heap_free(&regions);
      free(R);
+     pool_free(&pool);
      return FAILURE;
 }
 
@@ -1024,12 +1148,12 @@ static int cubature(unsigned fdim, integrand_v f, void *fdata,
 		    unsigned dim, const double *xmin, const double *xmax, 
 		    size_t maxEval, double reqAbsError, double reqRelError, 
 		    error_norm norm,
-		    double *val, double *err, int parallel)
+		    double *val, double *err, int parallel, 
+		    unsigned nthreads = 1)
 {
-     rule *r;
      hypercube h;
      int status;
-     unsigned i;
+     unsigned i, k;
      
      if (fdim == 0) /* nothing to do */ return SUCCESS;
      if (dim == 0) { /* trivial integration */
@@ -1037,22 +1161,30 @@ static int cubature(unsigned fdim, integrand_v f, void *fdata,
 	  for (i = 0; i < fdim; ++i) err[i] = 0;
 	  return SUCCESS;
      }
-     r = dim == 1 ? make_rule15gauss(dim, fdim)
- 	          : make_rule75genzmalik(dim, fdim);
-     if (!r) { 
-	  for (i = 0; i < fdim; ++i) {
-	       val[i] = 0;
-	       err[i] = HUGE_VAL; 
+     /* Ostap: one rule (with its own buffers) per thread */
+     if (!parallel || nthreads < 1) nthreads = 1;
+     std::vector<rule *> rules(nthreads, (rule *) NULL);
+     for (k = 0; k < nthreads; ++k) {
+	  rules[k] = dim == 1 ? make_rule15gauss(dim, fdim)
+	                      : make_rule75genzmalik(dim, fdim);
+	  if (!rules[k]) { 
+	       for (i = 0; i < nthreads; ++i) destroy_rule(rules[i]);
+	       for (i = 0; i < fdim; ++i) {
+		    val[i] = 0;
+		    err[i] = HUGE_VAL; 
+	       }
+	       return FAILURE;
 	  }
-	  return FAILURE;
      }
+     std::unique_ptr<Ostap::Utils::WorkerPool> workers;
+     if (1 < nthreads) workers.reset(new Ostap::Utils::WorkerPool(nthreads));
      h = make_hypercube_range(dim, xmin, xmax);
      status = !h.data ? FAILURE
-	  : rulecubature(r, fdim, f, fdata, &h,
+	  : rulecubature(rules.data(), fdim, f, fdata, &h,
 				maxEval, reqAbsError, reqRelError, norm,
-				val, err, parallel);
+				val, err, parallel, workers.get());
      destroy_hypercube(&h);
-     destroy_rule(r);
+     for (k = 0; k < nthreads; ++k) destroy_rule(rules[k]);
      return status;
 }
 
@@ -1066,6 +1198,16 @@ int hcubature_v(unsigned fdim, integrand_v f, void *fdata,
 		     maxEval, reqAbsError, reqRelError, norm, val, err, 1);
 }
 
+int hcubature_v_mt(unsigned fdim, integrand_v f, void *fdata, 
+                   unsigned dim, const double *xmin, const double *xmax, 
+                   size_t maxEval, double reqAbsError, double reqRelError, 
+                   error_norm norm,
+                   double *val, double *err, unsigned nthreads)
+{
+     return cubature(fdim, f, fdata, dim, xmin, xmax, 
+		     maxEval, reqAbsError, reqRelError, norm, val, err, 1, nthreads);
+}
+
 #include "vwrapper.h"
 
 int hcubature(unsigned fdim, integrand f, void *fdata, 
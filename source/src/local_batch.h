@@ -0,0 +1,575 @@
+// ============================================================================
+#ifndef LOCAL_BATCH_H 
+#define LOCAL_BATCH_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <type_traits>
+// ============================================================================
+// ROOT&RooFit
+// ============================================================================
+#include "RVersion.h"
+#include "RooAbsReal.h"
+#include "RooListProxy.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/BatchCompute.h"
+// ============================================================================
+#if   ROOT_VERSION(6,32,0) <= ROOT_VERSION_CODE
+#include "ROOT/RSpan.hxx"
+#include "RooFit/EvalContext.h"
+#elif ROOT_VERSION(6,28,0) <= ROOT_VERSION_CODE
+#include "RooSpan.h"
+#include "RooFit/Detail/DataMap.h"
+#elif ROOT_VERSION(6,24,0) <= ROOT_VERSION_CODE
+#include "RooSpan.h"
+#include "RunContext.h"
+#elif ROOT_VERSION(6,20,0) <= ROOT_VERSION_CODE
+#include "RooSpan.h"
+#endif 
+// ============================================================================
+#if OSTAP_BATCH
+// ============================================================================
+/** @file local_batch.h
+ *  Simple helper for the batch evaluation of RooFit PDFs 
+ *  via the array-evaluation of the underlying Ostap::Math objects.
+ *  - Ostap::Utils::BatchData hides the version-specific input data 
+ *  - <code>OSTAP_BATCH_IMPLEMENT(CLASS,BASE)</code> generates the 
+ *    version-specific override of <code>RooAbsReal</code> 
+ *  @see Ostap/BatchCompute.h
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2023-01-27
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class BatchData 
+     *  The version-independent access to the input data 
+     *  for the batch evaluation 
+     *  @see Ostap/BatchCompute.h
+     *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+     *  @date   2026-10-15
+     */
+    class BatchData 
+    {
+    public:
+      // ======================================================================
+#if ROOT_VERSION(6,32,0) <= ROOT_VERSION_CODE
+      // ======================================================================
+      typedef std::span<const double>      Span ;
+      // ======================================================================
+      BatchData ( RooFit::EvalContext& ctx ) : m_ctx ( ctx ) {}
+      // ======================================================================
+      /// get the values of the argument 
+      Span at ( const RooAbsArg* arg ) const { return m_ctx.at ( arg ) ; }
+      // ======================================================================
+#elif ROOT_VERSION(6,28,0) <= ROOT_VERSION_CODE
+      // ======================================================================
+      typedef RooSpan<const double>        Span ;
+      // ======================================================================
+      BatchData ( const RooFit::Detail::DataMap& data ) : m_data ( data ) {}
+      // ======================================================================
+      /// get the values of the argument 
+      Span at ( const RooAbsArg* arg ) const { return m_data.at ( arg ) ; }
+      // ======================================================================
+#elif ROOT_VERSION(6,24,0) <= ROOT_VERSION_CODE
+      // ======================================================================
+      typedef RooSpan<const double>        Span ;
+      // ======================================================================
+      BatchData ( RooBatchCompute::RunContext& ctx     , 
+                  const RooArgSet*             normSet ) 
+        : m_ctx     ( ctx     ) 
+        , m_normSet ( normSet ) 
+      {}
+      // ======================================================================
+      /// get the values of the argument 
+      Span at ( const RooAbsArg* arg ) const 
+      { return static_cast<const RooAbsReal*> ( arg ) -> getValues ( m_ctx , m_normSet ) ; }
+      // ======================================================================
+#else 
+      // ======================================================================
+      typedef RooSpan<const double>        Span ;
+      // ======================================================================
+      BatchData ( const std::size_t begin , const std::size_t size ) 
+        : m_begin   ( begin ) 
+        , m_size    ( size  ) 
+        , m_scalars () 
+      {}
+      // ======================================================================
+      /** get the values of the argument 
+       *  the empty batch means the scalar argument: 
+       *  its value is kept locally 
+       */
+      Span at ( const RooAbsArg* arg ) const 
+      {
+        const RooAbsReal* real = static_cast<const RooAbsReal*> ( arg ) ;
+        const Span span = real -> getValBatch ( m_begin , m_size ) ;
+        if ( !span.empty () ) { return span ; }
+        m_scalars.push_back ( real -> getVal () ) ;
+        const double* value = &m_scalars.back () ;
+        return Span ( value , value + 1 ) ;
+      }
+      // ======================================================================
+#endif
+      // ======================================================================
+      /// get the values of the argument 
+      Span at ( RooAbsArg* arg ) const 
+      { return at ( static_cast<const RooAbsArg*> ( arg ) ) ; }
+      // ======================================================================
+      /// get the values of the proxy 
+      template <class PROXY,
+                typename = typename std::enable_if<!std::is_pointer<PROXY>::value>::type>
+      Span at ( const PROXY& proxy ) const 
+      { return at ( static_cast<const RooAbsArg*> ( &proxy.arg () ) ) ; }
+      // ======================================================================
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,28,0)
+      // ======================================================================
+      /** number of events to be evaluated: 
+       *  the largest batch among the servers of the function 
+       */
+      std::size_t size ( const RooAbsArg& owner ) const 
+      {
+        std::size_t n = 0 ;
+        for ( const RooAbsArg* server : owner.servers () ) 
+        {
+          const RooAbsReal* real = dynamic_cast<const RooAbsReal*> ( server ) ;
+          if ( real ) { n = std::max ( n , std::size_t ( at ( real ).size () ) ) ; }
+        }
+        return n ;
+      }
+      // ======================================================================
+#endif
+      // ======================================================================
+    private:
+      // ======================================================================
+#if ROOT_VERSION(6,32,0) <= ROOT_VERSION_CODE
+      /// the evaluation context 
+      RooFit::EvalContext&           m_ctx     ; // the evaluation context 
+#elif ROOT_VERSION(6,28,0) <= ROOT_VERSION_CODE
+      /// the data map 
+      const RooFit::Detail::DataMap& m_data    ; // the data map 
+#elif ROOT_VERSION(6,24,0) <= ROOT_VERSION_CODE
+      /// the run context 
+      RooBatchCompute::RunContext&   m_ctx     ; // the run context 
+      /// the normalization set 
+      const RooArgSet*               m_normSet ; // the normalization set 
+#else
+      /// the first event 
+      std::size_t                    m_begin   ; // the first event 
+      /// number of events 
+      std::size_t                    m_size    ; // number of events 
+      /// the values of scalar arguments 
+      mutable std::deque<double>     m_scalars ; // the values of scalar arguments 
+#endif
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils 
+  // ==========================================================================
+} //                                                 The end of namespace Ostap 
+// ============================================================================
+/** @def OSTAP_BATCH_IMPLEMENT 
+ *  Implement the version-specific batch evaluation of <code>CLASS</code>
+ *  via the method <code>CLASS::computeBatch_</code>
+ *  @see OSTAP_BATCH_DECLARE 
+ */
+/** @def OSTAP_BATCH_IMPLEMENT_FALLBACK 
+ *  Implement the version-specific batch evaluation of <code>CLASS</code>
+ *  via the method <code>CLASS::computeBatch_</code>;
+ *  the batch evaluation of <code>BASE</code> is used 
+ *  when <code>CLASS::computeBatch_</code> returns <code>false</code>
+ *  @see OSTAP_BATCH_DECLARE_FALLBACK 
+ */
+// ============================================================================
+#if   ROOT_VERSION(6,32,0) <= ROOT_VERSION_CODE
+// ============================================================================
+#define OSTAP_BATCH_IMPLEMENT(CLASS,BASE)                                     \
+  void CLASS::doEval ( RooFit::EvalContext& ctx ) const                       \
+  {                                                                           \
+    Ostap::Utils::BatchData data ( ctx ) ;                                    \
+    const std::span<double> output = ctx.output () ;                          \
+    Ostap::Utils::BatchCompute::add ( output.size () ) ;                      \
+    computeBatch_ ( data , output.data () , output.size () ) ;                \
+  }
+#define OSTAP_BATCH_IMPLEMENT_FALLBACK(CLASS,BASE)                            \
+  void CLASS::doEval ( RooFit::EvalContext& ctx ) const                       \
+  {                                                                           \
+    Ostap::Utils::BatchData data ( ctx ) ;                                    \
+    const std::span<double> output = ctx.output () ;                          \
+    if ( computeBatch_ ( data , output.data () , output.size () ) )           \
+    { Ostap::Utils::BatchCompute::add ( output.size () ) ; }                  \
+    else { BASE::doEval ( ctx ) ; }                                           \
+  }
+// ============================================================================
+#elif ROOT_VERSION(6,30,0) <= ROOT_VERSION_CODE
+// ============================================================================
+#define OSTAP_BATCH_IMPLEMENT(CLASS,BASE)                                     \
+  void CLASS::computeBatch ( double*                        output  ,         \
+                             std::size_t                    nEvents ,         \
+                             RooFit::Detail::DataMap const& dataMap ) const   \
+  {                                                                           \
+    Ostap::Utils::BatchData data ( dataMap ) ;                                \
+    Ostap::Utils::BatchCompute::add ( nEvents ) ;                             \
+    computeBatch_ ( data , output , nEvents ) ;                               \
+  }
+#define OSTAP_BATCH_IMPLEMENT_FALLBACK(CLASS,BASE)                            \
+  void CLASS::computeBatch ( double*                        output  ,         \
+                             std::size_t                    nEvents ,         \
+                             RooFit::Detail::DataMap const& dataMap ) const   \
+  {                                                                           \
+    Ostap::Utils::BatchData data ( dataMap ) ;                                \
+    if ( computeBatch_ ( data , output , nEvents ) )                          \
+    { Ostap::Utils::BatchCompute::add ( nEvents ) ; }                         \
+    else { BASE::computeBatch ( output , nEvents , dataMap ) ; }              \
+  }
+// ============================================================================
+#elif ROOT_VERSION(6,28,0) <= ROOT_VERSION_CODE
+// ============================================================================
+#define OSTAP_BATCH_IMPLEMENT(CLASS,BASE)                                     \
+  void CLASS::computeBatch ( cudaStream_t*                  /* stream */ ,    \
+                             double*                        output       ,    \
+                             std::size_t                    nEvents      ,    \
+                             RooFit::Detail::DataMap const& dataMap      ) const \
+  {                                                                           \
+    Ostap::Utils::BatchData data ( dataMap ) ;                                \
+    Ostap::Utils::BatchCompute::add ( nEvents ) ;                             \
+    computeBatch_ ( data , output , nEvents ) ;                               \
+  }
+#define OSTAP_BATCH_IMPLEMENT_FALLBACK(CLASS,BASE)                            \
+  void CLASS::computeBatch ( cudaStream_t*                  stream  ,         \
+                             double*                        output  ,         \
+                             std::size_t                    nEvents ,         \
+                             RooFit::Detail::DataMap const& dataMap ) const   \
+  {                                                                           \
+    Ostap::Utils::BatchData data ( dataMap ) ;                                \
+    if ( computeBatch_ ( data , output , nEvents ) )                          \
+    { Ostap::Utils::BatchCompute::add ( nEvents ) ; }                         \
+    else { BASE::computeBatch ( stream , output , nEvents , dataMap ) ; }     \
+  }
+// ============================================================================
+#elif ROOT_VERSION(6,24,0) <= ROOT_VERSION_CODE
+// ============================================================================
+#define OSTAP_BATCH_IMPLEMENT(CLASS,BASE)                                     \
+  RooSpan<double> CLASS::evaluateSpan ( RooBatchCompute::RunContext& ctx     ,\
+                                        const RooArgSet*             normSet ) const \
+  {                                                                           \
+    Ostap::Utils::BatchData data ( ctx , normSet ) ;                          \
+    const std::size_t nEvents = data.size ( *this ) ;                         \
+    RooSpan<double>   output  = ctx.makeBatch ( this , nEvents ) ;            \
+    Ostap::Utils::BatchCompute::add ( nEvents ) ;                             \
+    computeBatch_ ( data , output.data () , nEvents ) ;                       \
+    return output ;                                                           \
+  }
+#define OSTAP_BATCH_IMPLEMENT_FALLBACK(CLASS,BASE)                            \
+  RooSpan<double> CLASS::evaluateSpan ( RooBatchCompute::RunContext& ctx     ,\
+                                        const RooArgSet*             normSet ) const \
+  {                                                                           \
+    Ostap::Utils::BatchData data ( ctx , normSet ) ;                          \
+    const std::size_t nEvents = data.size ( *this ) ;                         \
+    RooSpan<double>   output  = ctx.makeBatch ( this , nEvents ) ;            \
+    if ( !computeBatch_ ( data , output.data () , nEvents ) )                 \
+    { return BASE::evaluateSpan ( ctx , normSet ) ; }                         \
+    Ostap::Utils::BatchCompute::add ( nEvents ) ;                             \
+    return output ;                                                           \
+  }
+// ============================================================================
+#else 
+// ============================================================================
+#define OSTAP_BATCH_IMPLEMENT(CLASS,BASE)                                     \
+  RooSpan<double> CLASS::evaluateBatch ( std::size_t begin ,                  \
+                                         std::size_t size  ) const            \
+  {                                                                           \
+    Ostap::Utils::BatchData data ( begin , size ) ;                           \
+    const std::size_t nEvents = data.size ( *this ) ;                         \
+    if ( 0 == nEvents ) { return BASE::evaluateBatch ( begin , size ) ; }     \
+    RooSpan<double> output = _batchData.makeWritableBatchUnInit ( begin , nEvents ) ; \
+    Ostap::Utils::BatchCompute::add ( nEvents ) ;                             \
+    computeBatch_ ( data , output.data () , nEvents ) ;                       \
+    return output ;                                                           \
+  }
+#define OSTAP_BATCH_IMPLEMENT_FALLBACK(CLASS,BASE)                            \
+  RooSpan<double> CLASS::evaluateBatch ( std::size_t begin ,                  \
+                                         std::size_t size  ) const            \
+  {                                                                           \
+    Ostap::Utils::BatchData data ( begin , size ) ;                           \
+    const std::size_t nEvents = data.size ( *this ) ;                         \
+    if ( 0 == nEvents ) { return BASE::evaluateBatch ( begin , size ) ; }     \
+    RooSpan<double> output = _batchData.makeWritableBatchUnInit ( begin , nEvents ) ; \
+    if ( !computeBatch_ ( data , output.data () , nEvents ) )                 \
+    { return BASE::evaluateBatch ( begin , size ) ; }                         \
+    Ostap::Utils::BatchCompute::add ( nEvents ) ;                             \
+    return output ;                                                           \
+  }
+// ============================================================================
+#endif
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /** @class Batch 
+   *  Helper class for the batch evaluation:
+   *  - if all parameters are scalar, they are set only once 
+   *    and the function is evaluated for the whole array of points 
+   *  - otherwise the parameters are set event-by-event
+   *  For 2D and 3D functions the observables y and z are 
+   *  specified in constructor, and <code>evaluate2D</code>/<code>evaluate3D</code> 
+   *  methods are used 
+   */
+  class Batch
+  {
+  public:
+    // ========================================================================
+    typedef Ostap::Utils::BatchData::Span Span ;
+    // ========================================================================
+  public:
+    // ========================================================================
+    /** constructor 
+     *  @param data    (INPUT) the batch data 
+     *  @param x       (INPUT) the observable 
+     *  @param nEvents (INPUT) number of events 
+     */
+    template <class PROXY>
+    Batch ( const Ostap::Utils::BatchData& data    , 
+            const PROXY&                   x       , 
+            const std::size_t              nEvents ) 
+      : m_data   ( data          ) 
+      , m_x      ( data.at ( x ) ) 
+      , m_y      ( data.at ( x ) ) 
+      , m_z      ( data.at ( x ) ) 
+      , m_n      ( nEvents       )
+      , m_pars   () 
+      , m_values () 
+      , m_scalar ( true ) 
+    {}
+    // ========================================================================
+    /** constructor for 2D functions 
+     *  @param data    (INPUT) the batch data 
+     *  @param x       (INPUT) the first  observable 
+     *  @param y       (INPUT) the second observable 
+     *  @param nEvents (INPUT) number of events 
+     */
+    template <class PROXY>
+    Batch ( const Ostap::Utils::BatchData& data    , 
+            const PROXY&                   x       , 
+            const PROXY&                   y       , 
+            const std::size_t              nEvents ) 
+      : m_data   ( data          ) 
+      , m_x      ( data.at ( x ) ) 
+      , m_y      ( data.at ( y ) ) 
+      , m_z      ( data.at ( x ) ) 
+      , m_n      ( nEvents       )
+      , m_pars   () 
+      , m_values () 
+      , m_scalar ( true ) 
+    {}
+    // ========================================================================
+    /** constructor for 3D functions 
+     *  @param data    (INPUT) the batch data 
+     *  @param x       (INPUT) the first  observable 
+     *  @param y       (INPUT) the second observable 
+     *  @param z       (INPUT) the third  observable 
+     *  @param nEvents (INPUT) number of events 
+     */
+    template <class PROXY>
+    Batch ( const Ostap::Utils::BatchData& data    , 
+            const PROXY&                   x       , 
+            const PROXY&                   y       , 
+            const PROXY&                   z       , 
+            const std::size_t              nEvents ) 
+      : m_data   ( data          ) 
+      , m_x      ( data.at ( x ) ) 
+      , m_y      ( data.at ( y ) ) 
+      , m_z      ( data.at ( z ) ) 
+      , m_n      ( nEvents       )
+      , m_pars   () 
+      , m_values () 
+      , m_scalar ( true ) 
+    {}
+    // ========================================================================
+  public:
+    // ========================================================================
+    /// add the parameter 
+    template <class PROXY>
+    Batch& add ( const PROXY& par ) 
+    { return add_ ( m_data.at ( par ) ) ; }
+    // ========================================================================
+    /// add the list of parameters 
+    Batch& add ( const RooListProxy& lst ) 
+    {
+      const unsigned int N = lst.size() ;
+      for ( unsigned int k = 0 ; k < N ; ++k ) { add_ ( m_data.at ( &lst [ k ] ) ) ; }
+      return *this ;
+    }
+    // ========================================================================
+  public:
+    // ========================================================================
+    /** evaluate the function 
+     *  @param fun     (INPUT)  the function 
+     *  @param setpars (INPUT)  the functor that sets the parameters
+     *  @param output  (UPDATE) the output array 
+     */
+    template <class FUNCTION, class SETPARS>
+    void evaluate ( const FUNCTION& fun , SETPARS setpars , double* output ) 
+    {
+      if ( m_scalar && m_n <= m_x.size () ) 
+      {
+        set_scalar ( setpars ) ;
+        fun.evaluate ( m_n , m_x.data () , output ) ;
+        return ;                                               // RETURN 
+      }
+      //
+      for ( std::size_t i = 0 ; i < m_n ; ++i ) 
+      {
+        set_event ( setpars , i ) ;
+        output [ i ] = fun ( value ( m_x , i ) ) ;
+      }
+    }
+    // ========================================================================
+    /** evaluate 2D-function 
+     *  @param fun     (INPUT)  the function 
+     *  @param setpars (INPUT)  the functor that sets the parameters
+     *  @param output  (UPDATE) the output array 
+     */
+    template <class FUNCTION, class SETPARS>
+    void evaluate2D ( const FUNCTION& fun , SETPARS setpars , double* output ) 
+    {
+      if ( m_scalar && m_n <= m_x.size () && m_n <= m_y.size () ) 
+      {
+        set_scalar ( setpars ) ;
+        fun.evaluate ( m_n , m_x.data () , m_y.data () , output ) ;
+        return ;                                               // RETURN 
+      }
+      //
+      for ( std::size_t i = 0 ; i < m_n ; ++i ) 
+      {
+        set_event ( setpars , i ) ;
+        output [ i ] = fun ( value ( m_x , i ) , value ( m_y , i ) ) ;
+      }
+    }
+    // ========================================================================
+    /** evaluate 3D-function 
+     *  @param fun     (INPUT)  the function 
+     *  @param setpars (INPUT)  the functor that sets the parameters
+     *  @param output  (UPDATE) the output array 
+     */
+    template <class FUNCTION, class SETPARS>
+    void evaluate3D ( const FUNCTION& fun , SETPARS setpars , double* output ) 
+    {
+      if ( m_scalar && m_n <= m_x.size () && m_n <= m_y.size () && m_n <= m_z.size () ) 
+      {
+        set_scalar ( setpars ) ;
+        fun.evaluate ( m_n , m_x.data () , m_y.data () , m_z.data () , output ) ;
+        return ;                                               // RETURN 
+      }
+      //
+      for ( std::size_t i = 0 ; i < m_n ; ++i ) 
+      {
+        set_event ( setpars , i ) ;
+        output [ i ] = fun ( value ( m_x , i ) , value ( m_y , i ) , value ( m_z , i ) ) ;
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// set the scalar parameters 
+    template <class SETPARS>
+    void set_scalar ( SETPARS& setpars ) 
+    {
+      const std::size_t np = m_pars.size() ;
+      m_values.resize ( np ) ;
+      for ( std::size_t k = 0 ; k < np ; ++k ) { m_values [ k ] = m_pars [ k ][ 0 ] ; }
+      setpars ( m_values ) ;
+    }
+    // ========================================================================
+    /// set the parameters for the i-th event 
+    template <class SETPARS>
+    void set_event  ( SETPARS& setpars , const std::size_t i ) 
+    {
+      const std::size_t np = m_pars.size() ;
+      m_values.resize ( np ) ;
+      for ( std::size_t k = 0 ; k < np ; ++k ) { m_values [ k ] = value ( m_pars [ k ] , i ) ; }
+      setpars ( m_values ) ;
+    }
+    // ========================================================================
+    Batch& add_ ( const Span& span ) 
+    {
+      m_pars.push_back ( span ) ;
+      if ( 1 < span.size () ) { m_scalar = false ; }
+      return *this ;
+    }
+    // ========================================================================
+    /// get the value from span  
+    static inline double value ( const Span& span , const std::size_t i ) 
+    { return 1 < span.size () ? span [ i ] : span [ 0 ] ; }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the batch data 
+    const Ostap::Utils::BatchData& m_data   ; // the batch data 
+    /// the observable 
+    Span                           m_x      ; // the observable 
+    /// the second observable (2D and 3D)
+    Span                           m_y      ; // the second observable 
+    /// the third observable (3D)
+    Span                           m_z      ; // the third observable 
+    /// number of events
+    std::size_t                    m_n      ; // number of events 
+    /// parameters 
+    std::vector<Span>              m_pars   ; // parameters 
+    /// parameter values 
+    std::vector<double>            m_values ; // parameter values 
+    /// all parameters are scalar? 
+    bool                           m_scalar ; // all parameters are scalar?
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** @class Loop2D 
+   *  Trivial array evaluation for 2D-functions, that have only 
+   *  the scalar evaluation: still the parameters are set only once 
+   *  @see Batch::evaluate2D
+   */
+  template <class FUNCTION>
+  class Loop2D 
+  {
+  public:
+    // ========================================================================
+    Loop2D ( const FUNCTION& fun ) : m_fun ( fun ) {}
+    // ========================================================================
+    double operator() ( const double x , const double y ) const 
+    { return m_fun ( x , y ) ; }
+    // ========================================================================
+    void evaluate 
+    ( const std::size_t n      , 
+      const double*     x      , 
+      const double*     y      ,
+      double*           result ) const 
+    { for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = m_fun ( x [ i ] , y [ i ] ) ; } }
+    // ========================================================================
+  private:
+    // ========================================================================
+    const FUNCTION& m_fun ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  template <class FUNCTION>
+  inline Loop2D<FUNCTION> loop2D ( const FUNCTION& fun ) 
+  { return Loop2D<FUNCTION> ( fun ) ; }
+  // ==========================================================================
+} //                                             The end of anonymous namespace 
+// ============================================================================
+#endif
+// ============================================================================
+//                                                                      The END 
+// ============================================================================
+#endif // LOCAL_BATCH_H
+// ============================================================================
@@ -0,0 +1,576 @@
+// ============================================================================
+#ifndef LOCAL_COLUMNS_H
+#define LOCAL_COLUMNS_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <exception>
+// ============================================================================
+// ROOT&RooFit
+// ============================================================================
+#include "RVersion.h"
+#include "RooAbsData.h"
+#include "RooAbsReal.h"
+#include "RooRealVar.h"
+#include "RooArgSet.h"
+#include "RooDataSet.h"
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/FormulaVar.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+#include "local_mt.h"
+// ============================================================================
+#if ROOT_VERSION(6,26,0) <= ROOT_VERSION_CODE
+// ============================================================================
+#include "RooVectorDataStore.h"
+// ============================================================================
+#define OSTAP_DATA_COLUMNS 1
+// ============================================================================
+#endif
+// ============================================================================
+/** @file local_columns.h
+ *  Simple helpers for the column-wise ("batch") evaluation of expressions
+ *  for <code>RooDataSet</code> with <code>RooVectorDataStore</code>:
+ *  - the column arrays of the store are accessed directly,
+ *    no <code>RooAbsData::get(i)</code> for each event
+ *  - the expressions are evaluated for the chunks of events,
+ *    only the actually used variables are loaded
+ *  - trivial expressions (the variables from the dataset) are taken
+ *    from the column arrays as they are
+ *  - multithreaded processing with per-thread views: the copies of
+ *    the variables and the formulae, the shared read-only columns
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2023-03-22
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /** @class DataColumns
+   *  Read-only view of the column arrays of <code>RooVectorDataStore</code>
+   */
+  class DataColumns
+  {
+  public:
+    // ========================================================================
+    DataColumns ( const RooAbsData& data )
+      : m_data ( &data )
+    {
+#ifdef OSTAP_DATA_COLUMNS
+      //
+      if ( nullptr == dynamic_cast<const RooDataSet*>         ( &data          ) ) { return ; }
+      if ( nullptr == dynamic_cast<const RooVectorDataStore*> ( data.store ()  ) ) { return ; }
+      //
+      const RooArgSet* aset = data.get () ;
+      if ( nullptr == aset ) { return ; }
+      //
+      m_n = data.numEntries () ;
+      const auto spans = data.getBatches ( 0 , m_n ) ;
+      for ( RooAbsArg* a : *aset )
+      {
+        RooRealVar* v = dynamic_cast<RooRealVar*> ( a ) ;
+        if ( nullptr == v ) { continue ; }
+        const auto found = spans.find ( v ) ;
+        if ( spans.end () == found || found->second.size () < m_n ) { continue ; }
+        m_vars   .push_back ( v                     ) ;
+        m_columns.push_back ( found->second.data () ) ;
+      }
+      //
+      if ( data.isWeighted () )
+      {
+        const auto ws = data.getWeightBatch ( 0 , m_n ) ;
+        if ( ws.size () < m_n ) { return ; }                   // RETURN
+        m_weights = ws.data () ;
+      }
+      //
+      m_ok = true ;
+      //
+#endif
+    }
+    // ========================================================================
+  public:
+    // ========================================================================
+    /// valid view?
+    bool               ok      () const { return m_ok   ; }
+    /// the dataset
+    const RooAbsData&  data    () const { return *m_data ; }
+    /// number of entries
+    std::size_t        size    () const { return m_n     ; }
+    /// the weights (nullptr for non-weighted data)
+    const double*      weights () const { return m_weights ; }
+    /// the column for the given variable (nullptr if absent)
+    const double*      column  ( const RooAbsArg* var ) const
+    {
+      const auto found = std::find ( m_vars.begin () , m_vars.end () , var ) ;
+      return m_vars.end () == found ? nullptr : m_columns [ found - m_vars.begin () ] ;
+    }
+    /// the column for the variable with the given name (nullptr if absent)
+    const double*      column  ( const std::string& name ) const
+    {
+      for ( std::size_t i = 0 ; i < m_vars.size () ; ++i )
+      { if ( name == m_vars [ i ]->GetName () ) { return m_columns [ i ] ; } }
+      return nullptr ;
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the dataset
+    const RooAbsData*           m_data    { nullptr } ;
+    /// valid view ?
+    bool                        m_ok      { false   } ;
+    /// number of entries
+    std::size_t                 m_n       { 0       } ;
+    /// the variables
+    std::vector<RooRealVar*>    m_vars    {} ;
+    /// the columns
+    std::vector<const double*>  m_columns {} ;
+    /// the weights
+    const double*               m_weights { nullptr } ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** @class ColumnExpression
+   *  Column-wise evaluation of the expression (e.g. Ostap::FormulaVar)
+   *  - for the variable from the dataset, the column is used directly
+   *  - otherwise only the used variables are loaded from the columns,
+   *    and the expression is evaluated
+   *  - for the (rare) entries outside of the ranges of variables
+   *    the standard <code>RooAbsData::get(i)</code> is used
+   *  - for the per-thread view (<code>vars</code> are specified) the
+   *    columns are found by name for the copies of variables,
+   *    without ranges and without <code>RooAbsData::get(i)</code>
+   */
+  class ColumnExpression
+  {
+  public:
+    // ========================================================================
+    ColumnExpression
+    ( const DataColumns& columns        ,
+      const RooAbsReal&  expression     ,
+      const RooArgSet*   vars = nullptr )
+      : m_columns    ( &columns   )
+      , m_expression ( &expression )
+      , m_check      ( nullptr == vars )
+    {
+      if ( !columns.ok () ) { return ; }
+      //
+      // (1) the variable itself
+      if ( m_check ) { m_direct = columns.column ( &expression ) ; }
+      if ( m_direct ) { m_ok = true ; return ; }                 // RETURN
+      //
+      // (2) the used variables
+      const RooArgSet* aset = m_check ? columns.data ().get () : vars ;
+      if ( nullptr == aset ) { return ; }
+      std::unique_ptr<RooArgSet> used { expression.getObservables ( *aset ) } ;
+      if ( !used ) { return ; }
+      for ( RooAbsArg* a : *used )
+      {
+        const double* c = m_check ?
+          columns.column ( a ) : columns.column ( std::string ( a->GetName () ) ) ;
+        if ( nullptr == c ) { return ; }                         // RETURN
+        m_vars  .push_back ( static_cast<RooRealVar*> ( a ) ) ;
+        m_inputs.push_back ( c ) ;
+      }
+      m_ok = true ;
+    }
+    // ========================================================================
+  public:
+    // ========================================================================
+    /// valid ?
+    bool ok () const { return m_ok ; }
+    // ========================================================================
+    /** evaluate the expression for entries <code>[begin, begin+n)</code>
+     *  @param begin  the first entry
+     *  @param n      number of entries
+     *  @param output the output buffer
+     *  @param mask   if specified, only the entries with non-zero mask are evaluated
+     */
+    void evaluate
+    ( const std::size_t begin          ,
+      const std::size_t n              ,
+      double*           output         ,
+      const double*     mask = nullptr ) const
+    {
+      if ( m_direct )
+      {
+        std::copy ( m_direct + begin , m_direct + begin + n , output ) ;
+        return ;                                               // RETURN
+      }
+      //
+      const std::size_t nv = m_vars.size () ;
+      for ( std::size_t j = 0 ; j < n ; ++j )
+      {
+        if ( mask && !mask [ j ] ) { continue ; }
+        const std::size_t entry = begin + j ;
+        bool inrange = true ;
+        for ( std::size_t k = 0 ; m_check && k < nv && inrange ; ++k )
+        { inrange = m_vars [ k ]->inRange ( m_inputs [ k ] [ entry ] , nullptr ) ; }
+        //
+        if ( inrange )
+        { for ( std::size_t k = 0 ; k < nv ; ++k ) { m_vars [ k ] -> setVal ( m_inputs [ k ] [ entry ] ) ; } }
+        else { m_columns->data ().get ( entry ) ; }
+        //
+        output [ j ] = m_expression->getVal () ;
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the columns
+    const DataColumns*         m_columns    { nullptr } ;
+    /// the expression
+    const RooAbsReal*          m_expression { nullptr } ;
+    /// valid ?
+    bool                       m_ok         { false   } ;
+    /// check the ranges ? (false for the per-thread view)
+    bool                       m_check      { true    } ;
+    /// direct column
+    const double*              m_direct     { nullptr } ;
+    /// used variables
+    std::vector<RooRealVar*>   m_vars       {} ;
+    /// their columns
+    std::vector<const double*> m_inputs     {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /// size of the chunk for column-wise evaluation
+  const std::size_t s_COLUMN_CHUNK = 1024 ;
+  // ==========================================================================
+  /** @class ColumnsLoop
+   *  The column-wise evaluation of several expressions and
+   *  the (optional) selection for the chunks of entries
+   */
+  class ColumnsLoop
+  {
+  public:
+    // ========================================================================
+    /** constructor
+     *  @param columns     (INPUT) the columns
+     *  @param expressions (INPUT) the expressions
+     *  @param cuts        (INPUT) the selection/weight (could be nullptr)
+     *  @param vars        (INPUT) the variables of the per-thread view
+     */
+    ColumnsLoop
+    ( const DataColumns&                    columns           ,
+      const std::vector<const RooAbsReal*>& expressions       ,
+      const RooAbsReal*                     cuts              ,
+      const RooArgSet*                      vars    = nullptr )
+      : m_columns ( &columns )
+    {
+      if ( !columns.ok () ) { return ; }                       // RETURN
+      //
+      m_exprs.reserve ( expressions.size () ) ;
+      for ( const RooAbsReal* e : expressions )
+      {
+        if ( nullptr == e ) { return ; }                       // RETURN
+        m_exprs.emplace_back ( columns , *e , vars ) ;
+        if ( !m_exprs.back ().ok () ) { return ; }             // RETURN
+      }
+      if ( cuts )
+      {
+        m_selection.reset ( new ColumnExpression ( columns , *cuts , vars ) ) ;
+        if ( !m_selection->ok () ) { return ; }                // RETURN
+      }
+      //
+      m_wbuffer.resize ( s_COLUMN_CHUNK                  , 1.0 ) ;
+      m_vbuffer.resize ( s_COLUMN_CHUNK * m_exprs.size () , 0.0 ) ;
+      m_values .resize ( m_exprs.size ()                 , 0.0 ) ;
+      //
+      m_ok = true ;
+    }
+    // ========================================================================
+  public:
+    // ========================================================================
+    /// valid ?
+    bool ok () const { return m_ok ; }
+    // ========================================================================
+    /** process the entries <code>[first,last)</code>
+     *  @param first    (INPUT) the first entry
+     *  @param last     (INPUT) the last entry (not included)
+     *  @param callback (INPUT) the callback <code>( values , weight )</code>,
+     *                   invoked for entries with non-zero weight
+     */
+    template <class CALLBACK>
+    void run
+    ( const unsigned long first    ,
+      const unsigned long last     ,
+      CALLBACK            callback )
+    {
+      const std::size_t   N        = m_exprs.size () ;
+      const unsigned long the_last = std::min ( last , (unsigned long) m_columns->size () ) ;
+      const double*       weights  = m_columns->weights () ;
+      //
+      for ( unsigned long begin = first ; begin < the_last ; begin += s_COLUMN_CHUNK )
+      {
+        const std::size_t n = std::min ( (unsigned long) s_COLUMN_CHUNK , the_last - begin ) ;
+        //
+        // (1) cuts & weights
+        if ( m_selection ) { m_selection->evaluate ( begin , n , m_wbuffer.data () ) ; }
+        else               { std::fill ( m_wbuffer.begin () , m_wbuffer.begin () + n , 1.0 ) ; }
+        if ( weights )
+        { for ( std::size_t j = 0 ; j < n ; ++j ) { if ( m_wbuffer [ j ] ) { m_wbuffer [ j ] *= weights [ begin + j ] ; } } }
+        //
+        // (2) the expressions (only for non-zero weights)
+        for ( std::size_t i = 0 ; i < N ; ++i )
+        { m_exprs [ i ].evaluate ( begin , n , m_vbuffer.data () + i * s_COLUMN_CHUNK , m_wbuffer.data () ) ; }
+        //
+        // (3) invoke the callback
+        for ( std::size_t j = 0 ; j < n ; ++j )
+        {
+          const double w = m_wbuffer [ j ] ;
+          if ( !w ) { continue ; }
+          for ( std::size_t i = 0 ; i < N ; ++i ) { m_values [ i ] = m_vbuffer [ i * s_COLUMN_CHUNK + j ] ; }
+          callback ( m_values.data () , w ) ;
+        }
+      }
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the columns
+    const DataColumns*                m_columns   { nullptr } ;
+    /// valid ?
+    bool                              m_ok        { false   } ;
+    /// the expressions
+    std::vector<ColumnExpression>     m_exprs     {} ;
+    /// the selection
+    std::unique_ptr<ColumnExpression> m_selection {} ;
+    /// the buffer of weights
+    std::vector<double>               m_wbuffer   {} ;
+    /// the buffer of values
+    std::vector<double>               m_vbuffer   {} ;
+    /// the values for the entry
+    std::vector<double>               m_values    {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** loop over the entries <code>[first,last)</code> of the dataset
+   *  with the column-wise evaluation of expressions
+   *  @code
+   *  columns_loop ( data , { &x , &y } , cuts , first , last ,
+   *    [&] ( const double* values , const double w ) { ... } ) ;
+   *  @endcode
+   *  @param data        (INPUT) the data
+   *  @param expressions (INPUT) the expressions
+   *  @param cuts        (INPUT) the selection/weight (could be nullptr)
+   *  @param first       (INPUT) the first entry
+   *  @param last        (INPUT) the last entry (not included)
+   *  @param callback    (INPUT) the callback <code>( values , weight )</code>,
+   *                      invoked for entries with non-zero weight
+   *  @return false if the column-wise evaluation is not possible
+   *          (nothing is processed in this case)
+   */
+  template <class CALLBACK>
+  bool columns_loop
+  ( const RooAbsData&                     data        ,
+    const std::vector<const RooAbsReal*>& expressions ,
+    const RooAbsReal*                     cuts        ,
+    const unsigned long                   first       ,
+    const unsigned long                   last        ,
+    CALLBACK                              callback    )
+  {
+    const DataColumns columns ( data ) ;
+    if ( !columns.ok () ) { return false ; }                   // RETURN
+    //
+    ColumnsLoop loop ( columns , expressions , cuts ) ;
+    if ( !loop.ok () ) { return false ; }                      // RETURN
+    //
+    loop.run ( first , last , callback ) ;
+    //
+    return true ;
+  }
+  // ==========================================================================
+  /** @class DataView
+   *  The per-thread read-only view of the dataset:
+   *  - the copies of variables (without ranges)
+   *  - the formulae for the copies of variables
+   *  - the shared read-only columns of the store
+   *  The view must be created and destroyed under the initialization lock
+   *  @see Ostap::Utils::init_mutex
+   */
+  class DataView
+  {
+  public:
+    // ========================================================================
+    /** constructor
+     *  @param columns     (INPUT) the columns
+     *  @param expressions (INPUT) the expressions
+     *  @param cuts        (INPUT) the selection/weight (could be empty)
+     */
+    DataView
+    ( const DataColumns&              columns     ,
+      const std::vector<std::string>& expressions ,
+      const std::string&              cuts        )
+    {
+      if ( !columns.ok () ) { return ; }                       // RETURN
+      const RooArgSet* aset = columns.data ().get () ;
+      if ( nullptr == aset ) { return ; }                      // RETURN
+      //
+      // (1) the copies of variables
+      m_vars.reset ( static_cast<RooArgSet*> ( aset->snapshot ( false ) ) ) ;
+      if ( !m_vars ) { return ; }                              // RETURN
+      for ( RooAbsArg* a : *m_vars )
+      {
+        RooRealVar* v = dynamic_cast<RooRealVar*> ( a ) ;
+        if ( v ) { v->removeRange () ; }
+      }
+      const RooArgList alst ( *m_vars ) ;
+      //
+      // (2) the formulae
+      std::vector<const RooAbsReal*> exprs ; exprs.reserve ( expressions.size () ) ;
+      for ( const auto& e : expressions )
+      {
+        m_formulas.emplace_back ( new Ostap::FormulaVar ( e , alst , false ) ) ;
+        if ( !m_formulas.back ()->ok () ) { return ; }         // RETURN
+        exprs.push_back ( m_formulas.back ().get () ) ;
+      }
+      if ( !cuts.empty () )
+      {
+        m_cuts.reset ( new Ostap::FormulaVar ( cuts , alst , false ) ) ;
+        if ( !m_cuts->ok () ) { return ; }                     // RETURN
+      }
+      //
+      // (3) the loop
+      m_loop.reset ( new ColumnsLoop ( columns , exprs , m_cuts.get () , m_vars.get () ) ) ;
+    }
+    // ========================================================================
+  public:
+    // ========================================================================
+    /// valid ?
+    bool ok () const { return m_loop && m_loop->ok () ; }
+    // ========================================================================
+    /// process the entries <code>[first,last)</code>
+    template <class CALLBACK>
+    void run
+    ( const unsigned long first    ,
+      const unsigned long last     ,
+      CALLBACK            callback )
+    { m_loop->run ( first , last , callback ) ; }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the copies of variables
+    std::unique_ptr<RooArgSet>                       m_vars     {} ;
+    /// the formulae
+    std::vector<std::unique_ptr<Ostap::FormulaVar> > m_formulas {} ;
+    /// the selection
+    std::unique_ptr<Ostap::FormulaVar>               m_cuts     {} ;
+    /// the loop (destroyed first)
+    std::unique_ptr<ColumnsLoop>                     m_loop     {} ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** multithreaded loop over the entries <code>[first,last)</code>
+   *  of the dataset with the column-wise evaluation of expressions
+   *  - the range is split into chunks (a few chunks per thread)
+   *  - each thread processes the chunks with its own view of the data
+   *  - the result for each chunk is accumulated separately,
+   *    that allows to merge the partial results in the order of chunks
+   *  @code
+   *  std::vector<Statistic> partial ;
+   *  columns_loop_mt ( data , { "x" , "y" } , "z>0" , first , last , 8 ,
+   *    Statistic () , partial ,
+   *    [] ( Statistic& r , const double* values , const double w ) { ... } ) ;
+   *  for ( const auto& p : partial ) { result += p ; }
+   *  @endcode
+   *  @param data        (INPUT)  the data
+   *  @param expressions (INPUT)  the expressions
+   *  @param cuts        (INPUT)  the selection/weight (could be empty)
+   *  @param first       (INPUT)  the first entry
+   *  @param last        (INPUT)  the last entry (not included)
+   *  @param nthreads    (INPUT)  the number of threads
+   *  @param initial     (INPUT)  the initial value of the partial result
+   *  @param partial     (OUTPUT) the partial results (one per chunk)
+   *  @param callback    (INPUT)  the callback <code>( result , values , weight )</code>,
+   *                      invoked for entries with non-zero weight
+   *  @return false if the column-wise evaluation is not possible
+   *          (nothing is processed in this case)
+   */
+  template <class RESULT, class CALLBACK>
+  bool columns_loop_mt
+  ( const RooAbsData&               data        ,
+    const std::vector<std::string>& expressions ,
+    const std::string&              cuts        ,
+    const unsigned long             first       ,
+    const unsigned long             last        ,
+    const unsigned int              nthreads    ,
+    const RESULT&                   initial     ,
+    std::vector<RESULT>&            partial     ,
+    CALLBACK                        callback    )
+  {
+    partial.clear () ;
+    //
+    const DataColumns columns ( data ) ;
+    if ( !columns.ok () ) { return false ; }                   // RETURN
+    //
+    // check the view in the calling thread
+    {
+      std::lock_guard<std::mutex> lock ( Ostap::Utils::init_mutex () ) ;
+      const DataView view ( columns , expressions , cuts ) ;
+      if ( !view.ok () ) { return false ; }                    // RETURN
+    }
+    //
+    const unsigned long the_last = std::min ( last , (unsigned long) columns.size () ) ;
+    const Ostap::Utils::Chunks chunks =
+      Ostap::Utils::split ( first , the_last , 4 * std::max ( 1u , nthreads ) ) ;
+    if ( chunks.empty () ) { return true ; }                   // RETURN
+    //
+    partial.assign ( chunks.size () , initial ) ;
+    //
+    Ostap::Utils::thread_safety () ;
+    //
+    std::atomic<std::size_t> next { 0 } ;
+    Ostap::Utils::WorkerPool pool
+      ( std::min ( (std::size_t) std::max ( 1u , nthreads ) , chunks.size () ) ) ;
+    pool.run ( [&] ( const unsigned int /* index */ )
+      {
+        std::unique_ptr<DataView> view {} ;
+        {
+          std::lock_guard<std::mutex> lock ( Ostap::Utils::init_mutex () ) ;
+          view.reset ( new DataView ( columns , expressions , cuts ) ) ;
+        }
+        //
+        std::exception_ptr error {} ;
+        try
+        {
+          Ostap::Assert ( view->ok ()                       ,
+                          "Cannot create the view of data"  ,
+                          "columns_loop_mt"                 ) ;
+          for ( std::size_t index = next++ ; index < chunks.size () ; index = next++ )
+          {
+            RESULT& result = partial [ index ] ;
+            view->run ( chunks [ index ].first , chunks [ index ].last ,
+                        [&result,&callback] ( const double* values , const double w )
+                        { callback ( result , values , w ) ; } ) ;
+          }
+        }
+        catch ( ... ) { next = chunks.size () ; error = std::current_exception () ; }
+        //
+        {
+          std::lock_guard<std::mutex> lock ( Ostap::Utils::init_mutex () ) ;
+          view.reset () ;
+        }
+        if ( error ) { std::rethrow_exception ( error ) ; }
+      } ) ;
+    //
+    return true ;
+  }
+  // ==========================================================================
+} //                                             The end of anynymous namespace
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // LOCAL_COLUMNS_H
+// ============================================================================
@@ -0,0 +1,175 @@
+// ============================================================================
+#ifndef OSTAP_LOCAL_FFT_H
+#define OSTAP_LOCAL_FFT_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <utility>
+// ============================================================================
+/** @file
+ *  Simple (local) Fast Fourier Transform for complex arrays of any length
+ *  - radix-2 for the length that is a power of 2
+ *  - Bluestein's algorithm (via radix-2 transforms) for other lengths
+ *  @see https://en.wikipedia.org/wiki/Cooley%E2%80%93Tukey_FFT_algorithm
+ *  @see https://en.wikipedia.org/wiki/Chirp_Z-transform#Bluestein's_algorithm
+ *  @date 2023-02-01
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    namespace FFT
+    {
+      // ======================================================================
+      /// is it a power of 2 ?
+      inline bool is_pow2 ( const std::size_t n )
+      { return 0 < n && 0 == ( n & ( n - 1 ) ) ; }
+      // ======================================================================
+      /// the smallest power of 2 that is not less than n
+      inline std::size_t next_pow2 ( const std::size_t n )
+      {
+        std::size_t m = 1 ;
+        while ( m < n ) { m <<= 1 ; }
+        return m ;
+      }
+      // ======================================================================
+      /** twiddle factors for radix-2 FFT of the given size
+       *  @param n       (INPUT)  the size, power of 2
+       *  @param inverse (INPUT)  the sign of the exponent
+       *  @param tw      (OUTPUT) the twiddle factors
+       */
+      template <class T>
+      inline void twiddles
+      ( const std::size_t              n       ,
+        const bool                     inverse ,
+        std::vector<std::complex<T> >& tw      )
+      {
+        static const T s_pi = std::acos ( T ( -1 ) ) ;
+        const T sign = inverse ? 1 : -1 ;
+        tw.resize ( n / 2 ) ;
+        for ( std::size_t k = 0 ; k < n / 2 ; ++k )
+        {
+          const T phi = sign * 2 * s_pi * k / n ;
+          tw [ k ] = std::complex<T> ( std::cos ( phi ) , std::sin ( phi ) ) ;
+        }
+      }
+      // ======================================================================
+      /** in-place radix-2 FFT with precomputed twiddle factors,
+       *  the size <b>must</b> be a power of 2
+       *  @param a       (UPDATE) the array
+       *  @param tw      (INPUT)  the twiddle factors
+       *  @see Ostap::Math::FFT::twiddles
+       */
+      template <class T>
+      inline void radix2
+      ( std::vector<std::complex<T> >&       a  ,
+        const std::vector<std::complex<T> >& tw )
+      {
+        const std::size_t n = a.size () ;
+        if ( n < 2 ) { return ; }
+        // bit reversal
+        for ( std::size_t i = 1 , j = 0 ; i < n ; ++i )
+        {
+          std::size_t bit = n >> 1 ;
+          for ( ; j & bit ; bit >>= 1 ) { j ^= bit ; }
+          j ^= bit ;
+          if ( i < j ) { std::swap ( a [ i ] , a [ j ] ) ; }
+        }
+        // twiddle factors for the last stage, all other stages use the subset
+        for ( std::size_t len = 2 ; len <= n ; len <<= 1 )
+        {
+          const std::size_t half = len >> 1   ;
+          const std::size_t step = n   / len  ;
+          for ( std::size_t i = 0 ; i < n ; i += len )
+          {
+            for ( std::size_t k = 0 ; k < half ; ++k )
+            {
+              const std::complex<T> u = a [ i + k ] ;
+              const std::complex<T> v = a [ i + k + half ] * tw [ k * step ] ;
+              a [ i + k        ] = u + v ;
+              a [ i + k + half ] = u - v ;
+            }
+          }
+        }
+      }
+      // ======================================================================
+      /** in-place radix-2 FFT, the size <b>must</b> be a power of 2
+       *  \f$ y_j = \sum_k a_k e^{\mp 2\pi i jk/n} \f$
+       *  @param a       (UPDATE) the array
+       *  @param inverse (INPUT)  the sign of the exponent (no 1/n scaling!)
+       */
+      template <class T>
+      inline void radix2
+      ( std::vector<std::complex<T> >& a               ,
+        const bool                     inverse = false )
+      {
+        const std::size_t n = a.size () ;
+        if ( n < 2 ) { return ; }
+        std::vector<std::complex<T> > tw ;
+        twiddles ( n , inverse , tw ) ;
+        radix2   ( a , tw ) ;
+      }
+      // ======================================================================
+      /** in-place FFT of any size
+       *  \f$ y_j = \sum_k a_k e^{\mp 2\pi i jk/n} \f$
+       *  @param a       (UPDATE) the array
+       *  @param inverse (INPUT)  the sign of the exponent (no 1/n scaling!)
+       */
+      template <class T>
+      inline void fft
+      ( std::vector<std::complex<T> >& a               ,
+        const bool                     inverse = false )
+      {
+        const std::size_t n = a.size () ;
+        if ( n < 2       ) { return ; }
+        if ( is_pow2 ( n ) ) { return radix2 ( a , inverse ) ; }
+        //
+        // Bluestein: jk = ( j^2 + k^2 - (j-k)^2 ) / 2
+        //
+        static const T s_pi = std::acos ( T ( -1 ) ) ;
+        const T sign = inverse ? 1 : -1 ;
+        //
+        std::vector<std::complex<T> > w ( n ) ;
+        for ( std::size_t k = 0 ; k < n ; ++k )
+        {
+          // k^2 mod 2n keeps the phase accurate for large k
+          const std::size_t k2  = ( k * k ) % ( 2 * n ) ;
+          const T           phi = sign * s_pi * k2 / n ;
+          w [ k ] = std::complex<T> ( std::cos ( phi ) , std::sin ( phi ) ) ;
+        }
+        //
+        const std::size_t m = next_pow2 ( 2 * n - 1 ) ;
+        std::vector<std::complex<T> > u ( m ) ;
+        std::vector<std::complex<T> > v ( m ) ;
+        for ( std::size_t k = 0 ; k < n ; ++k ) { u [ k ] = a [ k ] * w [ k ] ; }
+        v [ 0 ] = std::conj ( w [ 0 ] ) ;
+        for ( std::size_t k = 1 ; k < n ; ++k )
+        { v [ k ] = v [ m - k ] = std::conj ( w [ k ] ) ; }
+        //
+        radix2 ( u , false ) ;
+        radix2 ( v , false ) ;
+        for ( std::size_t k = 0 ; k < m ; ++k ) { u [ k ] *= v [ k ] ; }
+        radix2 ( u , true  ) ;
+        //
+        const T scale = T ( 1 ) / m ;
+        for ( std::size_t k = 0 ; k < n ; ++k ) { a [ k ] = u [ k ] * w [ k ] * scale ; }
+      }
+      // ======================================================================
+    } //                                   The end of namespace Ostap::Math::FFT
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+#endif // OSTAP_LOCAL_FFT_H
+// ============================================================================
+//                                                                      The END
+// ============================================================================
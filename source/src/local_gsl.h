@@ -28,13 +28,36 @@ namespace
   // ==========================================================================
   typedef Ostap::Math::GSL::GSL_Error_Handler Sentry ;
   // ==========================================================================
-  /// get GSL-workspace
-  inline gsl_integration_workspace* workspace
-  ( const Ostap::Math::WorkSpace& ws )
+  /** @class BorrowedWorkSpace 
+   *  GSL-workspace, borrowed from the thread-local pool for
+   *  the duration of the full expression
+   *  @see Ostap::Math::WorkSpace::Borrowed
+   */
+  class BorrowedWorkSpace
   {
-    void* _ws =  ws.workspace() ;
-    return (gsl_integration_workspace*) _ws ;
-  }
+  public:
+    // ========================================================================
+    BorrowedWorkSpace ( const Ostap::Math::WorkSpace& ws ) 
+      : m_borrowed ( ws.borrow () ) 
+    {}
+    // ========================================================================
+    /// get GSL-workspace 
+    operator gsl_integration_workspace* () const 
+    { return (gsl_integration_workspace*) m_borrowed.workspace () ; }
+    // ========================================================================
+  private:
+    // ========================================================================
+    Ostap::Math::WorkSpace::Borrowed m_borrowed ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+  /** get GSL-workspace (borrowed from the thread-local pool) 
+   *  @attention the workspace is returned back to the pool at the end 
+   *  of the full expression, therefore it must be used only as 
+   *  the function argument and never stored! 
+   */
+  inline BorrowedWorkSpace workspace
+  ( const Ostap::Math::WorkSpace& ws ) { return BorrowedWorkSpace ( ws ) ; }
   // ==========================================================================
   // get size of GSL-workspace 
   // ==========================================================================
@@ -0,0 +1,233 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <string>
+#include <thread>
+#include <algorithm>
+// ============================================================================
+// ROOT
+// ============================================================================
+#include "RVersion.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TChain.h"
+#include "TChainElement.h"
+#include "TFile.h"
+#include "TDirectory.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "local_mt.h"
+// ============================================================================
+/** @file
+ *  Implementation file for helper utilities from the file local_mt.h
+ *  @date 2023-01-12
+ */
+// ============================================================================
+// get the number of threads to be used
+// ============================================================================
+unsigned int Ostap::Utils::nThreads ( const unsigned int nthreads )
+{
+  if ( 0 < nthreads ) { return nthreads ; }
+  //
+  if ( ROOT::IsImplicitMTEnabled () )
+  {
+    const unsigned int n =
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
+      ROOT::GetThreadPoolSize     () ;
+#else
+      ROOT::GetImplicitMTPoolSize () ;
+#endif
+    if ( 0 < n ) { return n ; }
+  }
+  //
+  return std::max ( 1u , std::thread::hardware_concurrency () ) ;
+}
+// ============================================================================
+// global mutex for the  non-thread-safe initialization
+// ============================================================================
+std::mutex& Ostap::Utils::init_mutex ()
+{
+  static std::mutex s_mutex {} ;
+  return s_mutex ;
+}
+// ============================================================================
+// enable the ROOT thread safety (once)
+// ============================================================================
+void Ostap::Utils::thread_safety ()
+{
+  static std::once_flag s_flag ;
+  std::call_once ( s_flag , [] () { ROOT::EnableThreadSafety () ; } ) ;
+}
+// ============================================================================
+/*  split the range of entries <code>[first,last)</code>
+ *  into chunks aligned with the tree clusters (baskets)
+ *  @param tree    (INPUT) the tree or chain
+ *  @param first   (INPUT) the first entry
+ *  @param last    (INPUT) the last entry (not included)
+ *  @param nchunks (INPUT) the (approximate) number of chunks
+ *  @return the list of consecutive chunks
+ */
+// ============================================================================
+Ostap::Utils::Chunks
+Ostap::Utils::clusters
+( TTree*              tree    ,
+  const unsigned long first   ,
+  const unsigned long last    ,
+  const unsigned int  nchunks )
+{
+  Chunks result {} ;
+  if ( nullptr == tree ) { return result ; }                  // RETURN
+  //
+  const unsigned long nEntries = std::min ( last , (unsigned long) tree->GetEntries () ) ;
+  if ( nEntries <= first ) { return result ; }                // RETURN
+  //
+  // (1) collect the cluster boundaries
+  std::vector<unsigned long> edges { first } ;
+  //
+  auto add_clusters = [&edges,first,nEntries] ( TTree* t , const unsigned long offset )
+    {
+      if ( nullptr == t ) { return ; }
+      const unsigned long n = t->GetEntries () ;
+      if ( offset + n <= first || nEntries <= offset ) { return ; }
+      TTree::TClusterIterator it = t->GetClusterIterator ( 0 ) ;
+      Long64_t start = 0 ;
+      while ( ( start = it () ) < (Long64_t) n )
+      {
+        const unsigned long edge = offset + it.GetNextEntry () ;
+        if ( first < edge && edge < nEntries ) { edges.push_back ( edge ) ; }
+      }
+    } ;
+  //
+  TChain* chain = dynamic_cast<TChain*> ( tree ) ;
+  if ( nullptr == chain ) { add_clusters ( tree , 0 ) ; }
+  else
+  {
+    const Long64_t  current = chain->GetReadEntry  () ;
+    const Long64_t* offsets = chain->GetTreeOffset () ;
+    const Int_t     ntrees  = chain->GetNtrees     () ;
+    for ( Int_t i = 0 ; i < ntrees ; ++i )
+    {
+      const unsigned long offset = offsets [ i ] ;
+      if ( nEntries <= offset ) { break ; }
+      if ( 0 < offset && first < offset ) { edges.push_back ( offset ) ; }
+      if ( 0 > chain->LoadTree ( offset ) ) { continue ; }
+      add_clusters ( chain->GetTree () , offset ) ;
+    }
+    if ( 0 <= current ) { chain->LoadTree ( current ) ; }
+  }
+  edges.push_back ( nEntries ) ;
+  //
+  std::sort ( edges.begin () , edges.end () ) ;
+  edges.erase ( std::unique ( edges.begin () , edges.end () ) , edges.end () ) ;
+  //
+  // (2) merge the clusters into chunks of the similar size
+  const unsigned long total = nEntries - first ;
+  const unsigned long chunk = std::max ( 1ul , total / std::max ( 1u , nchunks ) ) ;
+  //
+  unsigned long start = first ;
+  for ( std::size_t i = 1 ; i < edges.size () ; ++i )
+  {
+    const unsigned long edge = edges [ i ] ;
+    if ( edge - start < chunk && edge < nEntries ) { continue ; }
+    result.emplace_back ( start , edge ) ;
+    start = edge ;
+  }
+  //
+  return result ;
+}
+// ============================================================================
+/*  split the range of entries <code>[first,last)</code>
+ *  into <code>nchunks</code> consecutive chunks of the similar size
+ *  @param first   (INPUT) the first entry
+ *  @param last    (INPUT) the last entry (not included)
+ *  @param nchunks (INPUT) the number of chunks
+ *  @return the list of consecutive chunks
+ */
+// ============================================================================
+Ostap::Utils::Chunks
+Ostap::Utils::split
+( const unsigned long first   ,
+  const unsigned long last    ,
+  const unsigned int  nchunks )
+{
+  Chunks result {} ;
+  if ( last <= first ) { return result ; }                    // RETURN
+  //
+  const unsigned long total = last - first ;
+  const unsigned long n     = std::min ( total , (unsigned long) std::max ( 1u , nchunks ) ) ;
+  //
+  unsigned long start = first ;
+  for ( unsigned long i = 1 ; i <= n ; ++i )
+  {
+    const unsigned long edge = first + ( total * i ) / n ;
+    result.emplace_back ( start , edge ) ;
+    start = edge ;
+  }
+  //
+  return result ;
+}
+// ============================================================================
+/*  can the tree be processed in parallel?
+ *  It is possible only for the trees/chains that are read from files
+ *  @param tree (INPUT) the tree or chain
+ */
+// ============================================================================
+bool Ostap::Utils::parallelizable ( const TTree* tree )
+{
+  if ( nullptr == tree ) { return false ; }
+  const TChain* chain = dynamic_cast<const TChain*> ( tree ) ;
+  if ( nullptr != chain )
+  {
+    const TObjArray* files = chain->GetListOfFiles () ;
+    return nullptr != files && 0 < files->GetEntries () ;
+  }
+  const TDirectory* dir = tree->GetDirectory () ;
+  return nullptr != dir && nullptr != dir->GetFile () ;
+}
+// ============================================================================
+/*  create an independent copy of the tree/chain,
+ *  that can be used safely from the separate thread
+ *  The entry numbering of the copy is the same as for the original tree
+ *  @param tree (INPUT) the tree or chain
+ *  @return the independent chain (or nullptr)
+ */
+// ============================================================================
+std::unique_ptr<TTree>
+Ostap::Utils::thread_copy ( const TTree* tree )
+{
+  if ( !parallelizable ( tree ) ) { return nullptr ; }
+  //
+  const TChain* chain = dynamic_cast<const TChain*> ( tree ) ;
+  if ( nullptr != chain )
+  {
+    auto copy = std::make_unique<TChain> ( chain->GetName () , chain->GetTitle () ) ;
+    const TObjArray* files = chain->GetListOfFiles () ;
+    for ( const TObject* o : *files )
+    {
+      const TChainElement* e = dynamic_cast<const TChainElement*> ( o ) ;
+      if ( nullptr == e ) { continue ; }
+      copy->AddFile ( e->GetTitle () , e->GetEntries () , e->GetName () ) ;
+    }
+    return copy ;
+  }
+  //
+  const TDirectory* dir  = tree->GetDirectory () ;
+  const TFile*      file = dir->GetFile       () ;
+  //
+  // the path of the tree inside the file
+  std::string       path = dir->GetPath () ;
+  const std::string::size_type pos = path.find ( ":/" ) ;
+  path = std::string::npos == pos ? "" : path.substr ( pos + 2 ) ;
+  if ( !path.empty() && '/' != path.back () ) { path += '/' ; }
+  path += tree->GetName () ;
+  //
+  auto copy = std::make_unique<TChain> ( path.c_str () , tree->GetTitle () ) ;
+  copy->AddFile ( file->GetName () , tree->GetEntries () ) ;
+  return copy ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================
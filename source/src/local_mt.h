@@ -0,0 +1,720 @@
+// ============================================================================
+#ifndef LOCAL_MT_H
+#define LOCAL_MT_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+// ============================================================================
+// Forward declarations
+// ============================================================================
+class TTree ; // ROOT
+// ============================================================================
+// Ostap
+// ============================================================================
+#include "Ostap/Progress.h"
+#include "Ostap/Affinity.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "Exception.h"
+// ============================================================================
+/** @file local_mt.h
+ *  Helper utilities for in-process multi-threaded processing of TTree/TChain:
+ *  - split the entry range into chunks, aligned with the tree clusters
+ *  - create independent per-thread copies of the tree/chain
+ *  - process chunks with a fixed set of worker threads
+ *  - optional NUMA-aware placement of threads and per-node partitioning
+ *    of the chunks, see Ostap::Utils::Affinity
+ *  @date 2023-01-12
+ */
+// ============================================================================
+namespace  Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @struct Chunk
+     *  The range of entries <code>[first,last)</code> to be processed
+     */
+    struct Chunk
+    {
+      Chunk ( const unsigned long f = 0 ,
+              const unsigned long l = 0 )
+        : first ( f )
+        , last  ( l )
+      {}
+      /// number of entries in chunk
+      unsigned long size  () const { return first < last ? last - first : 0 ; }
+      // ======================================================================
+      /// the first entry
+      unsigned long first { 0 } ; // the first entry
+      /// the last entry (not included!)
+      unsigned long last  { 0 } ; // the last entry (not included!)
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /// vector of chunks
+    typedef std::vector<Chunk> Chunks ;
+    // ========================================================================
+    /** get the number of threads to be used
+     *  - if <code>nthreads</code> is positive, it is used
+     *  - otherwise the size of ROOT implicit MT pool is used (if enabled)
+     *  - otherwise the hardware concurrency is used
+     *  @param nthreads (INPUT) the requested number of threads
+     *  @return number of threads (at least one)
+     */
+    unsigned int nThreads ( const unsigned int nthreads = 0 ) ;
+    // ========================================================================
+    /** split the range of entries <code>[first,last)</code>
+     *  into chunks aligned with the tree clusters (baskets)
+     *  @param tree    (INPUT) the tree or chain
+     *  @param first   (INPUT) the first entry
+     *  @param last    (INPUT) the last entry (not included)
+     *  @param nchunks (INPUT) the (approximate) number of chunks
+     *  @return the list of consecutive chunks
+     */
+    Chunks clusters
+    ( TTree*              tree    ,
+      const unsigned long first   ,
+      const unsigned long last    ,
+      const unsigned int  nchunks ) ;
+    // ========================================================================
+    /** split the range of entries <code>[first,last)</code>
+     *  into <code>nchunks</code> consecutive chunks of the similar size
+     *  (e.g. for the in-memory data)
+     *  @param first   (INPUT) the first entry
+     *  @param last    (INPUT) the last entry (not included)
+     *  @param nchunks (INPUT) the number of chunks
+     *  @return the list of consecutive chunks
+     */
+    Chunks split
+    ( const unsigned long first   ,
+      const unsigned long last    ,
+      const unsigned int  nchunks ) ;
+    // ========================================================================
+    /** can the tree be processed in parallel?
+     *  It is possible only for the trees/chains that are read from files
+     *  @param tree (INPUT) the tree or chain
+     */
+    bool parallelizable ( const TTree* tree ) ;
+    // ========================================================================
+    /** create an independent copy of the tree/chain,
+     *  that can be used safely from the separate thread
+     *  The entry numbering of the copy is the same as for the original tree
+     *  @param tree (INPUT) the tree or chain
+     *  @return the independent chain (or nullptr)
+     */
+    std::unique_ptr<TTree> thread_copy ( const TTree* tree ) ;
+    // ========================================================================
+    /** global mutex to protect the non-thread-safe parts of
+     *  the per-thread initialization, e.g. creation of
+     *  <code>TTreeFormula</code> objects
+     */
+    std::mutex& init_mutex () ;
+    // ========================================================================
+    /// enable the ROOT thread safety (once)
+    void thread_safety () ;
+    // ========================================================================
+    /** create the progress bar for the parallel processing of chunks 
+     *  @return the progress bar or <code>nullptr</code> if not enabled 
+     *  @see Ostap::Utils::Progress::enabled 
+     */
+    inline std::unique_ptr<Progress> make_progress 
+    ( const Chunks&      chunks   , 
+      const unsigned int nthreads ) 
+    {
+      if ( !Progress::enabled () ) { return nullptr ; }
+      unsigned long long total = 0 ;
+      for ( const auto& c : chunks ) { total += c.size () ; }
+      return std::make_unique<Progress> ( total , nthreads ) ;
+    }
+    // ========================================================================
+    /** @class ChunkQueue
+     *  The common queue of chunks for the worker threads
+     *  - without NUMA-aware placement: one queue for all threads
+     *  - otherwise the chunks are partitioned into contiguous blocks,
+     *    one per node, and the thread takes the chunks from the block
+     *    of its node first, and then steals from other blocks
+     *  @see Ostap::Utils::Affinity
+     */
+    class ChunkQueue
+    {
+    public:
+      // ======================================================================
+      ChunkQueue ( const std::size_t  nchunks  ,
+                   const unsigned int nthreads )
+        : m_nchunks  ( nchunks  )
+        , m_nthreads ( nthreads )
+        , m_blocks   ( Affinity::blocks ( nchunks , nthreads ) )
+        , m_next     ( m_blocks.size () - 1 )
+      {
+        for ( std::size_t k = 0 ; k < m_next.size () ; ++k )
+        { m_next [ k ].store ( m_blocks [ k ] ) ; }
+      }
+      // ======================================================================
+      /// the next chunk for the thread (<code>nchunks</code> at the end)
+      std::size_t next ( const unsigned int ithread )
+      {
+        const std::size_t nb   = m_next.size () ;
+        const std::size_t home = 1 == nb ? 0 : Affinity::node ( ithread , m_nthreads ) ;
+        for ( std::size_t i = 0 ; i < nb ; ++i )
+        {
+          const std::size_t k = ( home + i ) % nb ;
+          if ( m_blocks [ k + 1 ] <= m_next [ k ].load ( std::memory_order_relaxed ) ) { continue ; }
+          const std::size_t c = m_next [ k ]++ ;
+          if ( c < m_blocks [ k + 1 ] ) { return c ; }                // RETURN
+        }
+        return m_nchunks ;
+      }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// number of chunks
+      std::size_t                           m_nchunks  ;
+      /// number of threads
+      unsigned int                          m_nthreads ;
+      /// the blocks (one per node)
+      std::vector<std::size_t>              m_blocks   ;
+      /// the next chunk in each block
+      std::vector<std::atomic<std::size_t>> m_next     ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** process the chunks in parallel using per-thread copies of the tree
+     *
+     *  For each thread the <code>factory</code> is invoked once
+     *  (under the initialization lock) to create the thread-local worker
+     *  (the worker must be destroyed before the tree copy),
+     *  then worker is invoked for each chunk, taken from the common queue
+     *  (partitioned per node for NUMA-aware placement):
+     *  @code
+     *  auto worker = factory ( tree_copy ) ;
+     *  worker ( chunk , index ) ; // index of the chunk
+     *  @endcode
+     *  The worker is expected to store the result of the chunk processing
+     *  at the place, identified by the chunk index, that allows
+     *  to merge the results in the deterministic order
+     *  The progress bar is shown if enabled. 
+     *  For NUMA-aware placement the thread is pinned to its node before 
+     *  the tree copy and the worker are created
+     *  @see Ostap::Utils::Progress::enabled 
+     *  @see Ostap::Utils::Affinity
+     *  @param tree     (INPUT) the tree or chain
+     *  @param chunks   (INPUT) the list of chunks
+     *  @param nthreads (INPUT) the number of threads
+     *  @param factory  (INPUT) the factory of the thread-local workers
+     */
+    template <class FACTORY>
+    void process_chunks
+    ( const TTree*       tree     ,
+      const Chunks&      chunks   ,
+      const unsigned int nthreads ,
+      FACTORY            factory  )
+    {
+      const unsigned int N = std::min ( std::size_t ( std::max ( 1u , nthreads ) ) , chunks.size () ) ;
+      if ( 0 == N ) { return ; }                                   // RETURN
+      //
+      thread_safety () ;
+      //
+      ChunkQueue                      queue  ( chunks.size () , N ) ;
+      std::vector<std::exception_ptr> errors ( N ) ;
+      std::unique_ptr<Progress>       progress = make_progress ( chunks , N ) ;
+      //
+      auto task = [&] ( const unsigned int ithread )
+        {
+          try
+          {
+            Affinity::pin ( Affinity::node ( ithread , N ) ) ;
+            std::unique_ptr<TTree> copy {} ;
+            {
+              std::lock_guard<std::mutex> lock ( init_mutex () ) ;
+              copy = thread_copy ( tree ) ;
+            }
+            Ostap::Assert ( !!copy                              ,
+                            "Cannot create the copy of the tree"    ,
+                            "Ostap::Utils::process_chunks"          ) ;
+            //
+            {
+              auto worker = [&]()
+                {
+                  std::lock_guard<std::mutex> lock ( init_mutex () ) ;
+                  return factory ( copy.get() ) ;
+                } () ;
+              //
+              for ( std::size_t index = queue.next ( ithread ) ; index < chunks.size () ; index = queue.next ( ithread ) )
+              {
+                worker ( chunks [ index ] , index ) ;
+                if ( progress ) { progress->add ( ithread , chunks [ index ].size () ) ; }
+              }
+            }
+            //
+            std::lock_guard<std::mutex> lock ( init_mutex () ) ;
+            copy.reset () ;
+          }
+          catch ( ... ) { errors [ ithread ] = std::current_exception () ; }
+        } ;
+      //
+      std::vector<std::thread> threads ; threads.reserve ( N ) ;
+      for ( unsigned int i = 0 ; i < N ; ++i ) { threads.emplace_back ( task , i ) ; }
+      for ( auto& t : threads ) { t.join () ; }
+      //
+      for ( const auto& e : errors ) { if ( e ) { std::rethrow_exception ( e ) ; } }
+    }
+    // ========================================================================
+    /** @class OrderedSlots
+     *  Helper class for the pipelined processing of chunks:
+     *  the chunks are processed by workers in parallel and 
+     *  consumed (written) by the single writer in order 
+     *  - chunk <code>c</code> uses the buffer slot <code>c % nslots</code>
+     *  - worker can start the chunk only when its slot is free, 
+     *    it limits the memory usage  
+     *  @see Ostap::Utils::process_ordered 
+     */
+    class OrderedSlots 
+    {
+    public:
+      // ======================================================================
+      OrderedSlots ( const std::size_t nchunks , 
+                     const std::size_t nslots  ) 
+        : m_nchunks ( nchunks ) 
+        , m_slots   ( std::max ( std::size_t ( 1 ) , nslots ) ) 
+        , m_ready   ( m_slots.size () , -1 ) 
+      {}
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// get the next chunk for the worker, wait for the free slot (-1 at the end)
+      long next () 
+      {
+        const std::size_t c = m_next++ ;
+        if ( m_nchunks <= c ) { return -1 ; }
+        std::unique_lock<std::mutex> lock ( m_mutex ) ;
+        m_cond.wait ( lock , [this,c] { return m_abort || c < m_written + m_slots.size () ; } ) ;
+        return m_abort ? -1 : long ( c ) ;
+      }
+      /// get the buffer for the chunk 
+      std::vector<double>& buffer ( const std::size_t c ) 
+      { return m_slots [ c % m_slots.size () ] ; }
+      /// mark the chunk as ready (worker) 
+      void ready ( const std::size_t c ) 
+      {
+        { 
+          std::lock_guard<std::mutex> lock ( m_mutex ) ; 
+          m_ready [ c % m_slots.size () ] = c ;
+        }
+        m_cond.notify_all () ;
+      }
+      /// wait for the chunk (writer) 
+      bool wait ( const std::size_t c ) 
+      {
+        std::unique_lock<std::mutex> lock ( m_mutex ) ;
+        m_cond.wait ( lock , [this,c] { return m_abort || long ( c ) == m_ready [ c % m_slots.size () ] ; } ) ;
+        return !m_abort ;
+      }
+      /// the chunk is written (writer) 
+      void written ( const std::size_t c ) 
+      {
+        {
+          std::lock_guard<std::mutex> lock ( m_mutex ) ;
+          m_written = c + 1 ;
+        }
+        m_cond.notify_all () ;
+      }
+      /// abort processing 
+      void abort () 
+      {
+        {
+          std::lock_guard<std::mutex> lock ( m_mutex ) ;
+          m_abort = true ;
+        }
+        m_cond.notify_all () ;
+      }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// number of chunks 
+      std::size_t                      m_nchunks           ; // number of chunks 
+      /// buffer slots 
+      std::vector<std::vector<double>> m_slots             ; // buffer slots 
+      /// the chunks, ready in slots 
+      std::vector<long>                m_ready             ; // ready chunks 
+      /// the next chunk to be processed 
+      std::atomic<std::size_t>         m_next    { 0     } ; // the next chunk 
+      /// number of written chunks 
+      std::size_t                      m_written { 0     } ; // written chunks 
+      /// abort flag 
+      bool                             m_abort   { false } ; // abort flag 
+      /// synchronization 
+      std::mutex                       m_mutex             ;
+      std::condition_variable          m_cond              ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** process the chunks in parallel using per-thread copies of the tree, 
+     *  and consume the results in order, in the calling thread 
+     *
+     *  For each thread the <code>factory</code> is invoked once
+     *  (under the initialization lock) to create the thread-local worker
+     *  (the worker must be destroyed before the tree copy). 
+     *  The worker fills the buffer for the chunk, and the writer 
+     *  consumes the buffers in the order of chunks:
+     *  @code
+     *  auto worker = factory ( tree_copy ) ;
+     *  worker ( chunk , buffer ) ; // fill std::vector<double> buffer 
+     *  ...
+     *  writer ( chunk , buffer ) ; // in the calling thread, in order 
+     *  @endcode
+     *  At most <code>nslots</code> (by default <code>2*nthreads</code>) 
+     *  buffers are in use, it defines the prefetch depth. 
+     *  The progress bar is shown if enabled
+     *  @see Ostap::Utils::Progress::enabled 
+     *  @param tree     (INPUT) the tree or chain
+     *  @param chunks   (INPUT) the list of chunks
+     *  @param nthreads (INPUT) the number of threads
+     *  @param factory  (INPUT) the factory of the thread-local workers
+     *  @param writer   (INPUT) the writer 
+     *  @param nslots   (INPUT) the number of buffers (0: <code>2*nthreads</code>)
+     */
+    template <class FACTORY, class WRITER>
+    void process_ordered
+    ( const TTree*       tree       ,
+      const Chunks&      chunks     ,
+      const unsigned int nthreads   ,
+      FACTORY            factory    , 
+      WRITER             writer     , 
+      const std::size_t  nslots = 0 ) 
+    {
+      const unsigned int N = std::min ( std::size_t ( std::max ( 1u , nthreads ) ) , chunks.size () ) ;
+      if ( 0 == N ) { return ; }                                   // RETURN
+      //
+      thread_safety () ;
+      //
+      OrderedSlots                    slots  ( chunks.size () , 0 < nslots ? nslots : 2 * N ) ;
+      std::vector<std::exception_ptr> errors ( N ) ;
+      std::unique_ptr<Progress>       progress = make_progress ( chunks , N ) ;
+      //
+      auto task = [&] ( const unsigned int ithread )
+        {
+          try
+          {
+            Affinity::pin ( Affinity::node ( ithread , N ) ) ;
+            std::unique_ptr<TTree> copy {} ;
+            {
+              std::lock_guard<std::mutex> lock ( init_mutex () ) ;
+              copy = thread_copy ( tree ) ;
+            }
+            Ostap::Assert ( !!copy                              ,
+                            "Cannot create the copy of the tree"    ,
+                            "Ostap::Utils::process_ordered"         ) ;
+            //
+            {
+              // the lock is declared before the worker: worker is destroyed under the lock 
+              std::unique_lock<std::mutex> lock ( init_mutex () ) ;
+              auto worker = factory ( copy.get() ) ;
+              lock.unlock () ;
+              //
+              for ( long c = slots.next () ; 0 <= c ; c = slots.next () ) 
+              {
+                worker ( chunks [ c ] , slots.buffer ( c ) ) ;
+                slots.ready ( c ) ;
+                if ( progress ) { progress->add ( ithread , chunks [ c ].size () ) ; }
+              }
+              //
+              lock.lock () ;
+            }
+            //
+            std::lock_guard<std::mutex> lock ( init_mutex () ) ;
+            copy.reset () ;
+          }
+          catch ( ... ) 
+          { 
+            errors [ ithread ] = std::current_exception () ; 
+            slots.abort () ;
+          }
+        } ;
+      //
+      std::vector<std::thread> threads ; threads.reserve ( N ) ;
+      for ( unsigned int i = 0 ; i < N ; ++i ) { threads.emplace_back ( task , i ) ; }
+      //
+      // the writer: consume the chunks in order 
+      try
+      {
+        for ( std::size_t c = 0 ; c < chunks.size () ; ++c ) 
+        {
+          if ( !slots.wait ( c ) ) { break ; }
+          writer ( chunks [ c ] , slots.buffer ( c ) ) ;
+          slots.written ( c ) ;
+        }
+      }
+      catch ( ... ) 
+      {
+        slots.abort () ;
+        for ( auto& t : threads ) { t.join () ; }
+        throw ;
+      }
+      //
+      for ( auto& t : threads ) { t.join () ; }
+      for ( const auto& e : errors ) { if ( e ) { std::rethrow_exception ( e ) ; } }
+    }
+    // ========================================================================
+    /** @class WorkerPool
+     *  Simple persistent pool of worker threads for the repeated 
+     *  in-process parallel jobs (e.g. the evaluation of NLL for each 
+     *  iteration of minimizer) without the cost of thread creation
+     *  - the job is invoked in all threads as <code>job ( index )</code>, 
+     *    where <code>index</code> is the index of thread (0 for the calling thread)
+     *  - <code>run</code> blocks until the job is finished in all threads 
+     *  - the exceptions are rethrown in the calling thread  
+     *  - for NUMA-aware placement the background threads are pinned 
+     *    to their nodes (the calling thread is not pinned)
+     *  @code
+     *  WorkerPool pool ( 4 ) ;
+     *  std::atomic<std::size_t> next { 0 } ;
+     *  pool.run ( [&] ( const unsigned int index ) 
+     *    { for ( std::size_t t = next++ ; t < ntasks ; t = next++ ) { ... } } ) ;
+     *  @endcode 
+     */
+    class WorkerPool 
+    {
+    public:
+      // ======================================================================
+      /// the job 
+      typedef std::function<void(const unsigned int)> Job ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      explicit WorkerPool ( const unsigned int nthreads ) 
+        : m_errors ( std::max ( 1u , nthreads ) ) 
+      {
+        for ( unsigned int i = 1 ; i < m_errors.size () ; ++i ) 
+        { m_threads.emplace_back ( [this,i] { loop ( i ) ; } ) ; }
+      }
+      /// destructor: stop the threads 
+      ~WorkerPool () 
+      {
+        {
+          std::lock_guard<std::mutex> lock ( m_mutex ) ;
+          m_stop = true ;
+        }
+        m_cond.notify_all () ;
+        for ( auto& t : m_threads ) { t.join () ; }
+      }
+      // ======================================================================
+      WorkerPool ( const WorkerPool& ) = delete ;
+      WorkerPool& operator= ( const WorkerPool& ) = delete ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of threads (including the calling thread)
+      unsigned int size () const { return m_errors.size () ; }
+      // ======================================================================
+      /// run the job in all threads and wait for the end 
+      void run ( const Job& job ) 
+      {
+        {
+          std::lock_guard<std::mutex> lock ( m_mutex ) ;
+          m_job     = &job ;
+          m_pending = m_threads.size () ;
+          ++m_generation ;
+        }
+        m_cond.notify_all () ;
+        //
+        try         { job ( 0 ) ; }
+        catch ( ... ) { m_errors [ 0 ] = std::current_exception () ; }
+        //
+        {
+          std::unique_lock<std::mutex> lock ( m_mutex ) ;
+          m_done.wait ( lock , [this] { return 0 == m_pending ; } ) ;
+          m_job = nullptr ;
+        }
+        //
+        std::exception_ptr error {} ;
+        for ( auto& e : m_errors ) { if ( e && !error ) { error = e ; } e = nullptr ; }
+        if ( error ) { std::rethrow_exception ( error ) ; }
+      }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the main loop for the worker thread 
+      void loop ( const unsigned int index ) 
+      {
+        Affinity::pin ( Affinity::node ( index , size () ) ) ;
+        std::size_t seen = 0 ;
+        while ( true ) 
+        {
+          const Job* job = nullptr ;
+          {
+            std::unique_lock<std::mutex> lock ( m_mutex ) ;
+            m_cond.wait ( lock , [this,seen] { return m_stop || seen != m_generation ; } ) ;
+            if ( m_stop ) { return ; }
+            seen = m_generation ;
+            job  = m_job        ;
+          }
+          //
+          try         { (*job) ( index ) ; }
+          catch ( ... ) { m_errors [ index ] = std::current_exception () ; }
+          //
+          std::lock_guard<std::mutex> lock ( m_mutex ) ;
+          if ( 0 == --m_pending ) { m_done.notify_one () ; }
+        }
+      }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the exceptions from threads 
+      std::vector<std::exception_ptr> m_errors                 ;
+      /// the background threads 
+      std::vector<std::thread>        m_threads                ;
+      /// the current job 
+      const Job*                      m_job        { nullptr } ;
+      /// the number of running background jobs 
+      std::size_t                     m_pending    { 0       } ;
+      /// the job counter 
+      std::size_t                     m_generation { 0       } ;
+      /// stop the threads? 
+      bool                            m_stop       { false   } ;
+      /// synchronization 
+      std::mutex                      m_mutex                  ;
+      std::condition_variable         m_cond                   ;
+      std::condition_variable         m_done                   ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class FirstTouch
+     *  Per-chunk objects (e.g. the private clones of histograms), 
+     *  created lazily by the thread that processes the chunk: 
+     *  for NUMA-aware placement the memory of the object is local 
+     *  for this thread (the first-touch policy of the kernel)
+     *  - each chunk is processed by exactly one thread, 
+     *    the slots are never shared 
+     *  - the objects are created under the initialization lock 
+     *  @code
+     *  FirstTouch<TH1> clones ( chunks.size () , [histo] () { return (TH1*) histo->Clone () ; } ) ;
+     *  ...
+     *  TH1* h = clones.get ( index ) ; // in the worker thread 
+     *  @endcode
+     *  @see Ostap::Utils::Affinity
+     */
+    template <class OBJECT>
+    class FirstTouch 
+    {
+    public:
+      // ======================================================================
+      /// the factory of the objects 
+      typedef std::function<OBJECT*()> Factory ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      FirstTouch ( const std::size_t n       , 
+                   Factory           factory ) 
+        : m_factory ( std::move ( factory ) ) 
+        , m_objects ( n ) 
+      {}
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// get (create, if needed) the object for the chunk 
+      OBJECT* get ( const std::size_t index ) 
+      {
+        std::unique_ptr<OBJECT>& o = m_objects [ index ] ;
+        if ( !o ) 
+        {
+          std::lock_guard<std::mutex> lock ( init_mutex () ) ;
+          o.reset ( m_factory () ) ;
+        }
+        return o.get () ;
+      }
+      /// get the object for the chunk (nullptr if not created)
+      OBJECT* operator[] ( const std::size_t index ) const 
+      { return m_objects [ index ].get () ; }
+      /// number of slots 
+      std::size_t size () const { return m_objects.size () ; }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the factory 
+      Factory                              m_factory ;
+      /// the objects 
+      std::vector<std::unique_ptr<OBJECT>> m_objects ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** merge the partial results per node, in parallel 
+     *  - the chunks are partitioned in the same way as in 
+     *    Ostap::Utils::process_chunks (see Ostap::Utils::Affinity::blocks)
+     *  - the results of the block are merged into the first 
+     *    chunk of the block in the order of chunks, by the thread, 
+     *    pinned to the node: <code>merge ( head , index )</code> 
+     *  - without NUMA-aware placement or premerge nothing is done 
+     *  The caller then merges the results of the returned chunks in order, 
+     *  the final result is deterministic for the given topology 
+     *  @code
+     *  const auto heads = premerge ( chunks.size () , nt , 
+     *     [&clones] ( std::size_t to , std::size_t from ) { clones [ to ]->Add ( clones [ from ] ) ; } ) ;
+     *  for ( const auto i : heads ) { histo->Add ( clones [ i ] ) ; }
+     *  @endcode
+     *  @param nchunks  (INPUT) number of chunks 
+     *  @param nthreads (INPUT) number of threads used for processing of chunks 
+     *  @param merge    (INPUT) the merge function
+     *  @return the chunks with results to be merged by the caller 
+     */
+    template <class MERGE>
+    std::vector<std::size_t> premerge 
+    ( const std::size_t  nchunks  , 
+      const unsigned int nthreads , 
+      MERGE              merge    ) 
+    {
+      const std::vector<std::size_t> blocks = Affinity::blocks ( nchunks , nthreads ) ;
+      std::vector<std::size_t> heads ; 
+      if ( !Affinity::premerge () || blocks.size () <= 2 ) 
+      {
+        heads.reserve ( nchunks ) ;
+        for ( std::size_t i = 0 ; i < nchunks ; ++i ) { heads.push_back ( i ) ; }
+        return heads ;                                               // RETURN 
+      }
+      //
+      const std::size_t               nb = blocks.size () - 1 ;
+      std::vector<std::exception_ptr> errors  ( nb ) ;
+      std::vector<std::thread>        threads ; threads.reserve ( nb ) ;
+      for ( std::size_t k = 0 ; k < nb ; ++k ) 
+      {
+        if ( blocks [ k + 1 ] <= blocks [ k ] ) { continue ; }
+        heads.push_back ( blocks [ k ] ) ;
+        if ( blocks [ k + 1 ] == blocks [ k ] + 1 ) { continue ; }
+        threads.emplace_back ( [&blocks,&errors,&merge,k] ()
+          {
+            try 
+            {
+              Affinity::pin ( k ) ;
+              for ( std::size_t i = blocks [ k ] + 1 ; i < blocks [ k + 1 ] ; ++i ) 
+              { merge ( blocks [ k ] , i ) ; }
+            }
+            catch ( ... ) { errors [ k ] = std::current_exception () ; }
+          } ) ;
+      }
+      for ( auto& t : threads ) { t.join () ; }
+      for ( const auto& e : errors ) { if ( e ) { std::rethrow_exception ( e ) ; } }
+      //
+      return heads ;
+    }
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // LOCAL_MT_H
+// ============================================================================
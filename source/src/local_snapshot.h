@@ -0,0 +1,156 @@
+// ============================================================================
+#ifndef LOCAL_SNAPSHOT_H
+#define LOCAL_SNAPSHOT_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <vector>
+#include <string>
+#include <algorithm>
+// ============================================================================
+// ROOT&RooFit
+// ============================================================================
+#include "RooAbsData.h"
+#include "RooAbsReal.h"
+#include "RooArgSet.h"
+// ============================================================================
+// Local
+// ============================================================================
+#include "local_columns.h"
+// ============================================================================
+/** @file local_snapshot.h
+ *  Fast accessor to the values of the fixed list of variables
+ *  for the entries of <code>RooAbsData</code>
+ *  - the variables are mapped to the columns of the store
+ *    (or to the variables of the data row) once, by name
+ *  - the values for the entry are read into the dense array,
+ *    no name lookups and no iteration over <code>RooArgSet</code>
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date   2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /** @class ValueSnapshot
+   *  The dense snapshot of the values of the fixed list of variables
+   *  - for <code>RooDataSet</code> with <code>RooVectorDataStore</code>
+   *    the values are taken directly from the column arrays,
+   *    the data row (<code>RooAbsData::get()</code>) is <b>not</b> updated
+   *  - otherwise the entry is loaded via <code>RooAbsData::get(i)</code>
+   *    and the values are taken from the pre-resolved variables of the row
+   *  @code
+   *  ValueSnapshot snapshot ( data , vars ) ;
+   *  if ( !snapshot.ok () ) { ... snapshot.missing () ... }
+   *  for ( unsigned long i = 0 ; i < data.numEntries () ; ++i )
+   *  {
+   *    const double* values = snapshot.load ( i ) ;
+   *    if ( nullptr == values ) { break ; }
+   *    const double  w      = snapshot.weight () ;
+   *    ...
+   *  }
+   *  @endcode
+   */
+  class ValueSnapshot
+  {
+  public:
+    // ========================================================================
+    /** constructor
+     *  @param data (INPUT) the data
+     *  @param vars (INPUT) the variables: any sequence of pointers to
+     *                      <code>RooAbsArg</code>, e.g. <code>RooArgSet</code>
+     */
+    template <class VARIABLES>
+    ValueSnapshot
+    ( const RooAbsData& data ,
+      const VARIABLES&  vars )
+      : m_data    ( &data )
+      , m_columns (  data )
+    {
+      const RooArgSet* row = data.get () ;
+      if ( nullptr == row ) { return ; }                       // RETURN
+      //
+      for ( const RooAbsArg* a : vars )
+      {
+        if ( nullptr == a ) { return ; }                       // RETURN
+        const RooAbsReal* v = dynamic_cast<const RooAbsReal*> ( row->find ( a->GetName () ) ) ;
+        if ( nullptr == v ) { m_missing = a->GetName () ; return ; } // RETURN
+        m_row   .push_back ( v ) ;
+        m_inputs.push_back ( m_columns.ok () ? m_columns.column ( v ) : nullptr ) ;
+      }
+      //
+      m_direct = m_columns.ok () &&
+        std::none_of ( m_inputs.begin () , m_inputs.end () ,
+                       [] ( const double* c ) { return nullptr == c ; } ) ;
+      m_values.resize ( m_row.size () , 0.0 ) ;
+      m_ok = true ;
+    }
+    // ========================================================================
+  public:
+    // ========================================================================
+    /// valid snapshot?
+    bool               ok      () const { return m_ok      ; }
+    /// the values are taken directly from the columns?
+    bool               direct  () const { return m_direct  ; }
+    /// the name of the variable, missing in the data
+    const std::string& missing () const { return m_missing ; }
+    /// number of variables
+    std::size_t        size    () const { return m_values.size () ; }
+    /// the current values
+    const double*      values  () const { return m_values.data () ; }
+    /// the weight of the current entry
+    double             weight  () const { return m_weight  ; }
+    // ========================================================================
+    /** load the entry
+     *  @param entry the entry
+     *  @return the dense array of values (nullptr for invalid entry)
+     */
+    const double* load ( const std::size_t entry )
+    {
+      const std::size_t N = m_values.size () ;
+      if ( m_direct )
+      {
+        if ( m_columns.size () <= entry ) { return nullptr ; } // RETURN
+        for ( std::size_t k = 0 ; k < N ; ++k ) { m_values [ k ] = m_inputs [ k ] [ entry ] ; }
+        const double* ws = m_columns.weights () ;
+        m_weight = nullptr != ws ? ws [ entry ] : 1.0 ;
+        return m_values.data () ;                              // RETURN
+      }
+      //
+      if ( nullptr == m_data->get ( entry ) ) { return nullptr ; } // RETURN
+      for ( std::size_t k = 0 ; k < N ; ++k ) { m_values [ k ] = m_row [ k ]->getVal () ; }
+      m_weight = m_data->weight () ;
+      return m_values.data () ;
+    }
+    // ========================================================================
+  private:
+    // ========================================================================
+    /// the data
+    const RooAbsData*               m_data    { nullptr } ;
+    /// the columns of the store
+    DataColumns                     m_columns ;
+    /// valid snapshot?
+    bool                            m_ok      { false   } ;
+    /// direct access to the columns?
+    bool                            m_direct  { false   } ;
+    /// the missing variable
+    std::string                     m_missing {} ;
+    /// the variables of the data row
+    std::vector<const RooAbsReal*>  m_row     {} ;
+    /// their columns
+    std::vector<const double*>      m_inputs  {} ;
+    /// the values
+    std::vector<double>             m_values  {} ;
+    /// the current weight
+    double                          m_weight  { 1.0 } ;
+    // ========================================================================
+  } ;
+  // ==========================================================================
+} //                                             The end of anynymous namespace
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // LOCAL_SNAPSHOT_H
+// ============================================================================
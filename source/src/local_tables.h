@@ -0,0 +1,154 @@
+// ============================================================================
+#ifndef OSTAP_LOCAL_TABLES_H
+#define OSTAP_LOCAL_TABLES_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+// ============================================================================
+/** @file local_tables.h
+ *  Lazily initialized, thread-safe tables of generated numbers
+ *  (quadrature nodes & weights, roots of polynomials, ...)
+ *  - each order is calculated once, at the first request
+ *  - after the initialization, no lock is taken at the read path
+ *  @see clencurt.h
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Math
+  {
+    // ========================================================================
+    namespace Tables
+    {
+      // ======================================================================
+      /** @class OnceTable local_tables.h
+       *  The table of values, indexed by the order:
+       *  - for the order below <code>NMAX</code> the value is calculated
+       *    once under <code>std::call_once</code>; the subsequent reads
+       *    do not take any lock
+       *  - for (rare) large orders the mutex-protected map is used
+       *  @attention the table is intended to be used as static object
+       */
+      template <class VALUE, unsigned int NMAX = 1024>
+      class OnceTable
+      {
+      public:
+        // ====================================================================
+        /** get the value for the given order
+         *  @param n     the order
+         *  @param maker the function to calculate the value <code>VALUE(n)</code>
+         */
+        template <class MAKER>
+        const VALUE& get ( const unsigned int n , MAKER maker )
+        {
+          if ( n < NMAX )
+          {
+            std::call_once ( m_flags [ n ] , [this,n,&maker] ()
+                             { m_values [ n ].reset ( new VALUE ( maker ( n ) ) ) ; } ) ;
+            return *m_values [ n ] ;                                     // RETURN
+          }
+          //
+          std::lock_guard<std::mutex> lock ( m_mutex ) ;
+          auto it = m_large.find ( n ) ;
+          if ( m_large.end () != it ) { return it->second ; }               // RETURN
+          return m_large.emplace ( n , maker ( n ) ).first->second ;
+        }
+        // ====================================================================
+      private:
+        // ====================================================================
+        /// initialization flags
+        std::array<std::once_flag,NMAX>         m_flags  {} ;
+        /// the values
+        std::array<std::unique_ptr<VALUE>,NMAX> m_values {} ;
+        /// mutex for large orders
+        std::mutex                              m_mutex  {} ;
+        /// values for large orders
+        std::map<unsigned int,VALUE>            m_large  {} ;
+        // ====================================================================
+      } ;
+      // ======================================================================
+      /** make the square (row-major) matrix of the linear transformation
+       *  of the polynomial coefficients for the given degree
+       *  @param n       the degree: the matrix is \f$ (n+1)\times(n+1) \f$
+       *  @param element the function <code>element ( i , k , n )</code>
+       */
+      template <class TYPE, class ELEMENT>
+      inline std::vector<TYPE>
+      make_matrix ( const unsigned short n , ELEMENT element )
+      {
+        const unsigned int np = n + 1 ;
+        std::vector<TYPE> m ( np * np , TYPE ( 0 ) ) ;
+        for ( unsigned short i = 0 ; i < np ; ++i )
+        { for ( unsigned short k = 0 ; k < np ; ++k )
+          { m [ i * np + k ] = element ( i , k , n ) ; } }
+        return m ;
+      }
+      // ======================================================================
+      /** apply the square (row-major) matrix to the coefficients
+       *  \f$ r_i = r_i + \sum_k m_{ik} p_k \f$
+       *  @param np     the dimension of the matrix (number of coefficients)
+       *  @param m      the matrix
+       *  @param p      (INPUT)  the input  coefficients
+       *  @param r      (UPDATE) the output coefficients
+       */
+      template <class TYPE, class INPUT, class OUTPUT>
+      inline void
+      apply_matrix
+      ( const unsigned short     np ,
+        const std::vector<TYPE>& m  ,
+        INPUT                    p  ,
+        OUTPUT                   r  )
+      {
+        for ( unsigned short i = 0 ; i < np ; ++i , ++r )
+        {
+          const TYPE* row = m.data () + i * np ;
+          long double ri  = *r ;
+          for ( unsigned short k = 0 ; k < np ; ++k )
+          {
+            const long double pk = *( p + k ) ;
+            if ( 0 != pk && 0 != row [ k ] ) { ri += row [ k ] * pk ; }
+          }
+          *r = ri ;
+        }
+      }
+      // ======================================================================
+      /** @struct GaussLegendre local_tables.h
+       *  Gauss-Legendre nodes and weights at [-1,1]
+       *  the nodes (roots of Legendre polynomial) are in increasing order
+       */
+      struct GaussLegendre
+      {
+        /// nodes
+        std::vector<double> x {} ;
+        /// weights
+        std::vector<double> w {} ;
+      } ;
+      // ======================================================================
+      /// get the Gauss-Legendre nodes and weights (thread-safe)
+      const GaussLegendre&       gauss_legendre ( const unsigned short n ) ;
+      // ======================================================================
+      /// get the roots of Legendre polynomial (thread-safe)
+      inline
+      const std::vector<double>& legendre_roots ( const unsigned short n )
+      { return gauss_legendre ( n ).x ; }
+      // ======================================================================
+    } //                               The end of namespace Ostap::Math::Tables
+    // ========================================================================
+  } //                                         The end of namespace Ostap::Math
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // OSTAP_LOCAL_TABLES_H
+// ============================================================================
@@ -107,6 +107,7 @@ Ostap::Math::NSphere::NSphere
   , m_phases  ( phases         )
   , m_sin_phi ( phases.size () , 0 ) 
   , m_cos_phi ( phases.size () , 1 ) 
+  , m_prod    ( phases.size () + 1 , 1 ) 
 {
   // copy deltas 
   const unsigned int nd = deltas.size() ;
@@ -120,6 +121,8 @@ Ostap::Math::NSphere::NSphere
     m_sin_phi [i] = sincos.first ;
     m_cos_phi [i] = sincos.second ;
   }
+  //
+  update_products () ;
 }
 // ============================================================================
 /*  Standard constructor with deltas 
@@ -134,6 +137,7 @@ Ostap::Math::NSphere::NSphere
   , m_phases  ( deltas.size () , 0.0 )
   , m_sin_phi ( deltas.size () , 0.0 ) 
   , m_cos_phi ( deltas.size () , 1.0 ) 
+  , m_prod    ( deltas.size () + 1 , 1.0 ) 
 {
   for ( unsigned short  i = 0 ; i < m_phases.size() ; ++i )
   {
@@ -142,6 +146,8 @@ Ostap::Math::NSphere::NSphere
     m_sin_phi [i] = sincos.first ;
     m_cos_phi [i] = sincos.second ;
   }
+  //
+  update_products () ;
 }
 // ============================================================================
 Ostap::Math::NSphere::NSphere 
@@ -151,6 +157,7 @@ Ostap::Math::NSphere::NSphere
   , m_phases  ( phases ) 
   , m_sin_phi ( phases.size () , 0 ) 
   , m_cos_phi ( phases.size () , 1 ) 
+  , m_prod    ( phases.size () + 1 , 1 ) 
 { 
   // ==============================
   // calculate the bias (if needed) 
@@ -173,6 +180,7 @@ Ostap::Math::NSphere::NSphere
     }
   }
   //
+  update_products () ;
 }
 // ============================================================================
 // copy
@@ -183,6 +191,7 @@ Ostap::Math::NSphere::NSphere
   , m_phases   ( right.m_phases  ) 
   , m_sin_phi  ( right.m_sin_phi ) 
   , m_cos_phi  ( right.m_cos_phi ) 
+  , m_prod     ( right.m_prod    ) 
 {}
 // ============================================================================
 // move
@@ -193,6 +202,7 @@ Ostap::Math::NSphere::NSphere
   , m_phases  ( std::move ( right.m_phases  ) ) 
   , m_sin_phi ( std::move ( right.m_sin_phi ) )  
   , m_cos_phi ( std::move ( right.m_cos_phi ) ) 
+  , m_prod    ( std::move ( right.m_prod    ) ) 
 {}
 // ============================================================================
 // destructor 
@@ -206,20 +216,44 @@ bool Ostap::Math::NSphere::setPhase
   const double         value ) 
 {
   // 
+  if ( !assign_phase ( index , value ) ) { return false ; }
+  //
+  // only the products for the subsequent coordinates are affected 
+  update_products ( index ) ;
+  //
+  return true ;
+}
+// ============================================================================
+// assign the phase and its sin/cos without the update of products 
+// ============================================================================
+bool Ostap::Math::NSphere::assign_phase
+( const unsigned short index , 
+  const double         value ) 
+{
   if ( nPhi () <= index ) { return false ; } // no change in unphysical phases 
   //
   if ( s_equal ( m_phases [ index ] , value ) ) { return false ; }
   //
-  const double phase  = value + m_delta [ index ] ;
+  m_phases  [ index ] = value         ;  // attention!! original values!! 
   //
-  const std::pair<double,double> sincos = _sincos_ ( phase );
+  const std::pair<double,double> sincos = _sincos_ ( value + m_delta [ index ] ) ;
   m_sin_phi [ index ] = sincos.first  ;
   m_cos_phi [ index ] = sincos.second ;
-  m_phases  [ index ] = value         ;  // attention!! original values!! 
   //
   return true ;
 }
 // ============================================================================
+// update the partial products of sines, starting from the given phase 
+// ============================================================================
+void Ostap::Math::NSphere::update_products ( const unsigned short index ) 
+{
+  const unsigned int N = nPhi () ;
+  m_prod.resize ( N + 1 , 1.0L ) ;
+  m_prod [ 0 ] = 1 ;
+  for ( unsigned int j = index ; j < N ; ++j ) 
+  { m_prod [ j + 1 ] = m_prod [ j ] * m_sin_phi [ j ] ; }
+}
+// ============================================================================
 // copy assignement 
 // ============================================================================
 Ostap::Math::NSphere& 
@@ -231,6 +265,7 @@ Ostap::Math::NSphere::operator=( const Ostap::Math::NSphere&  right )
   m_phases    = right.m_phases  ;
   m_sin_phi   = right.m_sin_phi ;
   m_cos_phi   = right.m_cos_phi ;
+  m_prod      = right.m_prod    ;
   //
   return *this ;
 }
@@ -246,6 +281,7 @@ Ostap::Math::NSphere::operator=(       Ostap::Math::NSphere&& right )
   m_phases    = std::move ( right.m_phases  ) ;
   m_sin_phi   = std::move ( right.m_sin_phi ) ;
   m_cos_phi   = std::move ( right.m_cos_phi ) ;
+  m_prod      = std::move ( right.m_prod    ) ;
   //
   return *this ;
 }
@@ -261,6 +297,7 @@ void Ostap::Math::NSphere::swap ( Ostap::Math::NSphere& right )  // swap two sph
   std::swap ( m_phases  , right.m_phases  ) ;
   std::swap ( m_sin_phi , right.m_sin_phi ) ;
   std::swap ( m_cos_phi , right.m_cos_phi ) ;
+  std::swap ( m_prod    , right.m_prod    ) ;
 }
 // ============================================================================
 /* convert n-coordinates \f$ x_i \f$ into (n-1) phases \f$ \phi_i\f$  
@@ -27,6 +27,20 @@ namespace {
 double Ostap::Math::owen  ( const double h , const double a )
 { return ::t ( h , a ) ; }
 // ============================================================================
+/* compute Owen's T-function for the array of h-values 
+ *  @param n      (INPUT)  number of points 
+ *  @param h      (INPUT)  array of h-parameters 
+ *  @param result (UPDATE) array of results 
+ *  @param a      (INPUT)  a-parameter
+ */
+// ============================================================================
+void Ostap::Math::owen  
+( const std::size_t n      , 
+  const double*     h      , 
+  double*           result , 
+  const double      a      ) 
+{ for ( std::size_t i = 0 ; i < n ; ++i ) { result [ i ] = ::t ( h [ i ] , a ) ; } }
+// ============================================================================
 
 
 // put everything into anonymous namespace 
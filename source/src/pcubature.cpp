@@ -34,7 +34,7 @@
 #define SUCCESS 0
 #define FAILURE 1
 
-/* pre-generated Clenshaw-Curtis rules and weights */
+/* Clenshaw-Curtis rules and weights, generated on the first use of each level */
 #include "clencurt.h"
 
 /* no point in supporting very high dimensional integrals here */
@@ -102,7 +102,7 @@ static int compute_cacheval(const unsigned *m, unsigned mi,
      else {
 	  double c = (xmin[id] + xmax[id]) * 0.5;
 	  double r = (xmax[id] - xmin[id]) * 0.5;
-	  const double *x = clencurt_x 
+	  const double *x = clencurt_xs () 
 	       + ((id == mi) ? (m[id] ? (1 << (m[id] - 1)) : 0) : 0);
 	  unsigned i, nx = (id == mi ? (m[id] ? (1 << (m[id] - 1)) : 1)
 			    : (1 << (m[id])));
@@ -198,7 +198,7 @@ static unsigned eval(const unsigned *cm, unsigned cmi, double *cval,
      else {
 	  unsigned i;
 	  unsigned mid = m[id] - (id == md); /* order of C-C rule */
-	  const double *w = clencurt_w + mid + (1 << mid) - 1
+	  const double *w = clencurt_ws () + mid + (1 << mid) - 1
 	       + (id == cmi ? (cm[id] ? 1 + (1 << (cm[id]-1)) : 1) : 0);
 	  unsigned cnx = (id == cmi ? (cm[id] ? (1 << (cm[id]-1)) : 1)
 			  : (1 << (cm[id])));
@@ -337,6 +337,7 @@ int pcubature_v_buf(unsigned fdim, integrand_v f, void *fdata,
      }
 
      /* start by evaluating the m=0 cubature rule */
+     if (clencurt_init(0) != SUCCESS) goto done;
      if (add_cacheval(&vc, m, dim, fdim, f, fdata, dim, xmin, xmax, 
 		       *buf, *nbuf) != SUCCESS)
 	  goto done;
@@ -354,6 +355,7 @@ int pcubature_v_buf(unsigned fdim, integrand_v f, void *fdata,
 	  }
 	  m[mi] += 1;
 	  if (m[mi] > clencurt_M) goto done; /* FAILURE */
+	  if (clencurt_init(m[mi]) != SUCCESS) goto done; /* FAILURE */
 
 	  new_nbuf = num_cacheval(m, mi, dim);
 	  if (new_nbuf > *nbuf && *nbuf < max_nbuf) {
@@ -0,0 +1,210 @@
+// ============================================================================
+#ifndef SHARDEDCACHE_H
+#define SHARDEDCACHE_H 1
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <mutex>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+// ============================================================================
+namespace Ostap
+{
+  // ==========================================================================
+  namespace Utils
+  {
+    // ========================================================================
+    /** @class CacheBase shardedcache.h
+     *  Base class for the caches, that provides the statistics
+     *  @see Ostap::Math::IntegrationCache
+     */
+    class CacheBase
+    {
+    public:
+      // ======================================================================
+      /// destructor
+      virtual ~CacheBase () ;
+      // ======================================================================
+    public:
+      // ======================================================================
+      /// number of cache hits
+      virtual unsigned long long hits      () const = 0 ;
+      /// number of cache misses
+      virtual unsigned long long misses    () const = 0 ;
+      /// number of evicted entries
+      virtual unsigned long long evictions () const = 0 ;
+      /// number of cached entries
+      virtual std::size_t        size      () const = 0 ;
+      /// reset the counters
+      virtual void               reset_counters () = 0 ;
+      // ======================================================================
+    protected:
+      // ======================================================================
+      /// register the cache (the cache must be static!)
+      void register_cache () ;
+      // ======================================================================
+    } ;
+    // ========================================================================
+    /** @class ShardedCache shardedcache.h
+     *  Simple sharded cache with CLOCK ("second chance") eviction
+     *  - each shard has its own mutex, therefore the concurrent
+     *    access to different shards does not block
+     *  - when the shard is full, the entries are evicted one-by-one
+     *    (instead of clearing the whole cache)
+     *  - the hit/miss/eviction counters are kept per shard, under the same lock
+     *  @attention the cache is intended to be used as static object
+     */
+    template <class KEY, class VALUE, unsigned int NSHARDS = 16>
+    class ShardedCache : public CacheBase
+    {
+    public:
+      // ======================================================================
+      /** constructor
+       *  @param capacity the total capacity of the cache
+       */
+      ShardedCache ( const std::size_t capacity )
+        : m_capacity ( std::max ( std::size_t ( 1 ) , capacity / NSHARDS ) )
+        , m_shards   ()
+      { this->register_cache () ; }
+      // ======================================================================
+    public:
+      // ======================================================================
+      /** look into the cache
+       *  @param key   (INPUT)  the key
+       *  @param value (UPDATE) the value
+       *  @return true if key is found
+       */
+      bool find ( const KEY& key , VALUE& value )
+      {
+        Shard& s = shard ( key ) ;
+        std::lock_guard<std::mutex> lock ( s.mutex ) ;
+        auto it = s.index.find ( key ) ;
+        if ( s.index.end () == it ) { ++s.misses ; return false ; }
+        Entry& e = s.ring [ it->second ] ;
+        e.referenced = true ;
+        value = e.value ;
+        ++s.hits ;
+        return true ;
+      }
+      // ======================================================================
+      /** put the value into the cache
+       *  @param key   (INPUT) the key
+       *  @param value (INPUT) the value
+       */
+      void insert ( const KEY& key , const VALUE& value )
+      {
+        Shard& s = shard ( key ) ;
+        std::lock_guard<std::mutex> lock ( s.mutex ) ;
+        auto it = s.index.find ( key ) ;
+        if ( s.index.end () != it ) { s.ring [ it->second ].value = value ; return ; }
+        //
+        if ( s.ring.size () < m_capacity )
+        {
+          s.index [ key ] = s.ring.size () ;
+          s.ring.push_back ( Entry { key , value , false } ) ;
+          return ;
+        }
+        // CLOCK: give the second chance to the recently used entries
+        while ( s.ring [ s.hand ].referenced )
+        {
+          s.ring [ s.hand ].referenced = false ;
+          s.hand = ( s.hand + 1 ) % s.ring.size () ;
+        }
+        Entry& victim = s.ring [ s.hand ] ;
+        s.index.erase ( victim.key ) ;
+        victim = Entry { key , value , false } ;
+        s.index [ key ] = s.hand ;
+        s.hand = ( s.hand + 1 ) % s.ring.size () ;
+        ++s.evictions ;
+      }
+      // ======================================================================
+    public: // statistics
+      // ======================================================================
+      /// number of cache hits
+      unsigned long long hits      () const override
+      { return sum ( &Shard::hits      ) ; }
+      /// number of cache misses
+      unsigned long long misses    () const override
+      { return sum ( &Shard::misses    ) ; }
+      /// number of evicted entries
+      unsigned long long evictions () const override
+      { return sum ( &Shard::evictions ) ; }
+      /// number of cached entries
+      std::size_t        size      () const override
+      {
+        std::size_t n = 0 ;
+        for ( const auto& s : m_shards )
+        { std::lock_guard<std::mutex> lock ( s.mutex ) ; n += s.ring.size () ; }
+        return n ;
+      }
+      /// reset the counters
+      void reset_counters () override
+      {
+        for ( auto& s : m_shards )
+        {
+          std::lock_guard<std::mutex> lock ( s.mutex ) ;
+          s.hits = 0 ; s.misses = 0 ; s.evictions = 0 ;
+        }
+      }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// the cache entry
+      struct Entry
+      {
+        KEY   key                 ;
+        VALUE value               ;
+        bool  referenced          ;
+      } ;
+      // ======================================================================
+      /// the shard (padded to avoid the false sharing between shards)
+      struct Shard
+      {
+        mutable std::mutex                      mutex     {} ;
+        std::unordered_map<KEY,std::size_t>     index     {} ;
+        std::vector<Entry>                      ring      {} ;
+        std::size_t                             hand      { 0 } ;
+        unsigned long long                      hits      { 0 } ;
+        unsigned long long                      misses    { 0 } ;
+        unsigned long long                      evictions { 0 } ;
+        char                                    pad [ 64 ]  {} ;
+      } ;
+      // ======================================================================
+      /// get the shard for the given key
+      inline Shard& shard ( const KEY& key )
+      {
+        const std::size_t h = std::hash<KEY>() ( key ) ;
+        return m_shards [ ( h ^ ( h >> 17 ) ^ ( h >> 31 ) ) % NSHARDS ] ;
+      }
+      // ======================================================================
+      /// sum the counters over the shards
+      unsigned long long sum ( unsigned long long Shard::*counter ) const
+      {
+        unsigned long long n = 0 ;
+        for ( const auto& s : m_shards )
+        { std::lock_guard<std::mutex> lock ( s.mutex ) ; n += s.*counter ; }
+        return n ;
+      }
+      // ======================================================================
+    private:
+      // ======================================================================
+      /// capacity per shard
+      std::size_t                  m_capacity ; // capacity per shard
+      /// shards
+      std::array<Shard,NSHARDS>    m_shards   ; // shards
+      // ======================================================================
+    } ;
+    // ========================================================================
+  } //                                        The end of namespace Ostap::Utils
+  // ==========================================================================
+} //                                                 The end of namespace Ostap
+// ============================================================================
+//                                                                      The END
+// ============================================================================
+#endif // SHARDEDCACHE_H
+// ============================================================================
@@ -0,0 +1,82 @@
+// ============================================================================
+// Include files
+// ============================================================================
+// STD&STL
+// ============================================================================
+#include <cmath>
+// ============================================================================
+// Local
+// ============================================================================
+#include "local_tables.h"
+// ============================================================================
+/** @file
+ *  Implementation of (local) tables of generated numbers
+ *  @see local_tables.h
+ *  @author Vanya BELYAEV Ivan.Belyaev@itep.ru
+ *  @date 2026-10-15
+ */
+// ============================================================================
+namespace
+{
+  // ==========================================================================
+  /** Gauss-Legendre nodes and weights at [-1,1]
+   *  (Newton iterations for the roots of Legendre polynomial,
+   *   in long double precision)
+   *  @param n  number of points
+   */
+  Ostap::Math::Tables::GaussLegendre make_gauss_legendre ( const unsigned short n )
+  {
+    Ostap::Math::Tables::GaussLegendre result {} ;
+    result.x.assign ( n , 0.0 ) ;
+    result.w.assign ( n , 0.0 ) ;
+    //
+    // values of P_n and its derivative at z
+    auto legendre = [n] ( const long double z , long double& dp ) -> long double
+      {
+        long double p0 = 1 ;
+        long double p1 = z ;
+        for ( unsigned short k = 2 ; k <= n ; ++k )
+        {
+          const long double p2 = ( ( 2 * k - 1 ) * z * p1 - ( k - 1 ) * p0 ) / k ;
+          p0 = p1 ;
+          p1 = p2 ;
+        }
+        dp = n * ( z * p1 - p0 ) / ( z * z - 1 ) ;
+        return p1 ;
+      } ;
+    //
+    const unsigned short m = ( n + 1 ) / 2 ;
+    for ( unsigned short i = 0 ; i < m ; ++i )
+    {
+      long double z  = std::cos ( M_PIl * ( i + 0.75L ) / ( n + 0.5L ) ) ;
+      long double dp = 1 ;
+      for ( unsigned short iter = 0 ; iter < 100 ; ++iter )
+      {
+        const long double dz = legendre ( z , dp ) / dp ;
+        z -= dz ;
+        if ( std::abs ( dz ) < 1.e-19L ) { break ; }
+      }
+      // recalculate the derivative at the final point
+      legendre ( z , dp ) ;
+      const long double wi = 2 / ( ( 1 - z * z ) * dp * dp ) ;
+      result.x [ i         ] = -z ;
+      result.x [ n - 1 - i ] =  z ;
+      result.w [ i         ] = wi ;
+      result.w [ n - 1 - i ] = wi ;
+    }
+    return result ;
+  }
+  // ==========================================================================
+}
+// ============================================================================
+// get the Gauss-Legendre nodes and weights (thread-safe)
+// ============================================================================
+const Ostap::Math::Tables::GaussLegendre&
+Ostap::Math::Tables::gauss_legendre ( const unsigned short n )
+{
+  static OnceTable<GaussLegendre> s_table {} ;
+  return s_table.get ( n , make_gauss_legendre ) ;
+}
+// ============================================================================
+//                                                                      The END
+// ============================================================================